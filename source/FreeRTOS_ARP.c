@@ -62,6 +62,13 @@
  * entry is still valid and can therefore be refreshed. */
 #define arpMAX_ARP_AGE_BEFORE_NEW_ARP_REQUEST    ( 3U )
 
+/** @brief The age at which an entry is refreshed before it expires. */
+#if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+    #define arpREFRESH_AGE    ( ( uint8_t ) ipconfigARP_REFRESH_AHEAD_PERIODS )
+#else
+    #define arpREFRESH_AGE    ( ( uint8_t ) arpMAX_ARP_AGE_BEFORE_NEW_ARP_REQUEST )
+#endif
+
 /** @brief The time between gratuitous ARPs. */
 #ifndef arpGRATUITOUS_ARP_PERIOD
     #define arpGRATUITOUS_ARP_PERIOD    ( pdMS_TO_TICKS( 20000U ) )
@@ -92,6 +99,17 @@
                                         NetworkEndPoint_t * pxTargetEndPoint,
                                         uint32_t ulSenderProtocolAddress );
 
+    static void prvARPGenerateReply( ARPPacket_t * pxARPFrame,
+                                     const NetworkEndPoint_t * pxTargetEndPoint,
+                                     uint32_t ulSenderProtocolAddress );
+
+/*
+ * Send an ARP request, broadcast or to a known MAC-address.
+ */
+    static void prvOutputARPRequest( NetworkEndPoint_t * pxEndPoint,
+                                     uint32_t ulIPAddress,
+                                     const MACAddress_t * pxMACAddress );
+
 /*
  * Lookup an MAC address in the ARP cache from the IP address.
  */
@@ -115,6 +133,376 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
 /** @brief The ARP cache. */
 _static ARPCacheRow_t xARPCache[ ipconfigARP_CACHE_ENTRIES ];
 
+#if ( ipconfigARP_STATIC_ENTRIES > 0 )
+
+/** @brief The permanent entries, see FreeRTOS_AddStaticARPEntry().  A row
+ *         with IP-address zero is free. */
+    static ARPCacheRow_t xARPStaticCache[ ipconfigARP_STATIC_ENTRIES ];
+
+/*
+ * Find the row of xARPStaticCache[] that holds an IP-address.
+ */
+    static BaseType_t prvARPStaticFind( uint32_t ulIPAddress );
+#endif
+
+#if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigARP_REQUEST_LIMIT_ENTRIES > 0 ) )
+
+/** @brief An address for which a broadcast ARP request is outstanding. */
+    typedef struct xARP_REQUEST_LIMIT
+    {
+        uint32_t ulIPAddress;    /**< The address that was asked for, zero when the slot is free. */
+        TickType_t xLastRequest; /**< The time of the last request. */
+        TickType_t xInterval;    /**< The time before a new request may be sent. */
+    } ARPRequestLimit_t;
+
+/** @brief The outstanding broadcast ARP requests, see prvARPRequestAllowed(). */
+    static ARPRequestLimit_t xARPRequestLimits[ ipconfigARP_REQUEST_LIMIT_ENTRIES ];
+
+/*
+ * Check whether a broadcast ARP request for an address may be sent now.
+ */
+    static BaseType_t prvARPRequestAllowed( uint32_t ulIPAddress );
+
+/*
+ * Forget the outstanding request for an address that has been resolved.
+ */
+    static void prvARPRequestResolved( uint32_t ulIPAddress );
+#endif
+
+#if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
+
+/** @brief A link to a row of xARPCache[]: zero means "none", otherwise the
+ *         index of the row plus one, so that a zeroed index is empty. */
+    #define arpLINK_TO_ROW( usLink )    ( ( BaseType_t ) ( usLink ) - 1 )
+    #define arpROW_TO_LINK( xRow )      ( ( uint16_t ) ( ( xRow ) + 1 ) )
+
+/** @brief Mask to get a bucket number from a hash value. */
+    #define arpHASH_MASK                ( ( uint32_t ) ipconfigARP_HASH_BUCKET_COUNT - 1U )
+
+/** @brief The links that belong to one row of xARPCache[]. */
+    typedef struct xARP_INDEX_LINKS
+    {
+        uint16_t usNextIP;  /**< The next row in the same IP-address bucket. */
+        uint16_t usNextMAC; /**< The next row in the same MAC-address bucket. */
+        uint16_t usNewer;   /**< The row that was used more recently. */
+        uint16_t usOlder;   /**< The row that was used less recently, or the next free row. */
+    } ARPIndexLinks_t;
+
+/** @brief Indexes the rows of xARPCache[] that have a non-zero IP-address.
+ *         Rows that were released are kept in a free list. */
+    typedef struct xARP_INDEX
+    {
+        uint16_t usIPBuckets[ ipconfigARP_HASH_BUCKET_COUNT ];  /**< Rows hashed on the IP-address. */
+        uint16_t usMACBuckets[ ipconfigARP_HASH_BUCKET_COUNT ]; /**< Rows hashed on the MAC-address. */
+        ARPIndexLinks_t xLinks[ ipconfigARP_CACHE_ENTRIES ];    /**< The links of each row. */
+        uint16_t usNewest;                                      /**< The most recently used row. */
+        uint16_t usOldest;                                      /**< The least recently used row. */
+        uint16_t usFree;                                        /**< The first released row. */
+        uint16_t usUnused;                                      /**< The rows from this index onwards were never used. */
+    } ARPIndex_t;
+
+/** @brief The index of the ARP cache. */
+    static ARPIndex_t xARPIndex;
+
+/**
+ * @brief Calculate the bucket of an IP-address.
+ *
+ * @param[in] ulIPAddress The IP-address in network byte order.
+ *
+ * @return The bucket number.
+ */
+    static uint32_t prvARPHashIP( uint32_t ulIPAddress )
+    {
+        uint32_t ulHash = ulIPAddress ^ ( ulIPAddress >> 16 );
+
+        ulHash ^= ulHash >> 8;
+
+        return ulHash & arpHASH_MASK;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the bucket of a MAC-address. Only the last three bytes are
+ *        used, the first three bytes are often the same for all hosts.
+ *
+ * @param[in] pxMACAddress The MAC-address.
+ *
+ * @return The bucket number.
+ */
+    static uint32_t prvARPHashMAC( const MACAddress_t * pxMACAddress )
+    {
+        uint32_t ulHash = ( ( uint32_t ) pxMACAddress->ucBytes[ 3 ] << 16 ) |
+                          ( ( uint32_t ) pxMACAddress->ucBytes[ 4 ] << 8 ) |
+                          ( uint32_t ) pxMACAddress->ucBytes[ 5 ];
+
+        ulHash ^= ulHash >> 8;
+
+        return ulHash & arpHASH_MASK;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the row that holds an IP-address.
+ *
+ * @param[in] ulIPAddress The IP-address to look for.
+ *
+ * @return The index of the row, or -1 when not found.
+ */
+    static BaseType_t prvARPIndexFindIP( uint32_t ulIPAddress )
+    {
+        BaseType_t xRow = -1;
+        uint16_t usLink = xARPIndex.usIPBuckets[ prvARPHashIP( ulIPAddress ) ];
+
+        while( usLink != 0U )
+        {
+            BaseType_t x = arpLINK_TO_ROW( usLink );
+
+            if( xARPCache[ x ].ulIPAddress == ulIPAddress )
+            {
+                xRow = x;
+                break;
+            }
+
+            usLink = xARPIndex.xLinks[ x ].usNextIP;
+        }
+
+        return xRow;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_ARP_REMOVE_ENTRY != 0 ) || ( ipconfigUSE_ARP_REVERSED_LOOKUP == 1 )
+
+/**
+ * @brief Find a row that holds a MAC-address.
+ *
+ * @param[in] pxMACAddress The MAC-address to look for.
+ *
+ * @return The index of the row, or -1 when not found.
+ */
+    static BaseType_t prvARPIndexFindMAC( const MACAddress_t * pxMACAddress )
+    {
+        BaseType_t xRow = -1;
+        uint16_t usLink = xARPIndex.usMACBuckets[ prvARPHashMAC( pxMACAddress ) ];
+
+        while( usLink != 0U )
+        {
+            BaseType_t x = arpLINK_TO_ROW( usLink );
+
+            if( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 )
+            {
+                xRow = x;
+                break;
+            }
+
+            usLink = xARPIndex.xLinks[ x ].usNextMAC;
+        }
+
+        return xRow;
+    }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_ARP_REMOVE_ENTRY != 0 ) || ( ipconfigUSE_ARP_REVERSED_LOOKUP == 1 ) */
+
+/**
+ * @brief Remove a row from the chain of a bucket.
+ *
+ * @param[in,out] pusHead The first link of the chain.
+ * @param[in] xRow The row to be removed.
+ * @param[in] xUseIPChain pdTRUE for an IP-address bucket, pdFALSE for a
+ *                        MAC-address bucket.
+ */
+    static void prvARPIndexRemoveFromChain( uint16_t * pusHead,
+                                            BaseType_t xRow,
+                                            BaseType_t xUseIPChain )
+    {
+        uint16_t * pusLink = pusHead;
+
+        while( *pusLink != 0U )
+        {
+            ARPIndexLinks_t * pxLinks = &( xARPIndex.xLinks[ arpLINK_TO_ROW( *pusLink ) ] );
+            uint16_t * pusNext = ( xUseIPChain != pdFALSE ) ? &( pxLinks->usNextIP ) : &( pxLinks->usNextMAC );
+
+            if( arpLINK_TO_ROW( *pusLink ) == xRow )
+            {
+                *pusLink = *pusNext;
+                *pusNext = 0U;
+                break;
+            }
+
+            pusLink = pusNext;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a row from the LRU list.
+ *
+ * @param[in] xRow The row to be removed.
+ */
+    static void prvARPIndexRemoveFromLRU( BaseType_t xRow )
+    {
+        ARPIndexLinks_t * pxLinks = &( xARPIndex.xLinks[ xRow ] );
+
+        if( pxLinks->usNewer != 0U )
+        {
+            xARPIndex.xLinks[ arpLINK_TO_ROW( pxLinks->usNewer ) ].usOlder = pxLinks->usOlder;
+        }
+        else
+        {
+            xARPIndex.usNewest = pxLinks->usOlder;
+        }
+
+        if( pxLinks->usOlder != 0U )
+        {
+            xARPIndex.xLinks[ arpLINK_TO_ROW( pxLinks->usOlder ) ].usNewer = pxLinks->usNewer;
+        }
+        else
+        {
+            xARPIndex.usOldest = pxLinks->usNewer;
+        }
+
+        pxLinks->usNewer = 0U;
+        pxLinks->usOlder = 0U;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a row to the LRU list as the most recently used one.
+ *
+ * @param[in] xRow The row to be added, it may not be in the list.
+ */
+    static void prvARPIndexAddToLRU( BaseType_t xRow )
+    {
+        xARPIndex.xLinks[ xRow ].usNewer = 0U;
+        xARPIndex.xLinks[ xRow ].usOlder = xARPIndex.usNewest;
+
+        if( xARPIndex.usNewest != 0U )
+        {
+            xARPIndex.xLinks[ arpLINK_TO_ROW( xARPIndex.usNewest ) ].usNewer = arpROW_TO_LINK( xRow );
+        }
+        else
+        {
+            xARPIndex.usOldest = arpROW_TO_LINK( xRow );
+        }
+
+        xARPIndex.usNewest = arpROW_TO_LINK( xRow );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Make an indexed row the most recently used one.
+ *
+ * @param[in] xRow The row that was used.
+ */
+    static void prvARPIndexTouch( BaseType_t xRow )
+    {
+        if( xARPIndex.usNewest != arpROW_TO_LINK( xRow ) )
+        {
+            prvARPIndexRemoveFromLRU( xRow );
+            prvARPIndexAddToLRU( xRow );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a row to the index, after its IP- and MAC-address have been set.
+ *        Rows with IP-address zero are not indexed.
+ *
+ * @param[in] xRow The row to be added.
+ */
+    static void prvARPIndexLink( BaseType_t xRow )
+    {
+        if( xARPCache[ xRow ].ulIPAddress != 0U )
+        {
+            uint16_t * pusHead;
+
+            pusHead = &( xARPIndex.usIPBuckets[ prvARPHashIP( xARPCache[ xRow ].ulIPAddress ) ] );
+            xARPIndex.xLinks[ xRow ].usNextIP = *pusHead;
+            *pusHead = arpROW_TO_LINK( xRow );
+
+            pusHead = &( xARPIndex.usMACBuckets[ prvARPHashMAC( &( xARPCache[ xRow ].xMACAddress ) ) ] );
+            xARPIndex.xLinks[ xRow ].usNextMAC = *pusHead;
+            *pusHead = arpROW_TO_LINK( xRow );
+
+            prvARPIndexAddToLRU( xRow );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a row from the index, before its IP- or MAC-address changes.
+ *
+ * @param[in] xRow The row to be removed.
+ */
+    static void prvARPIndexUnlink( BaseType_t xRow )
+    {
+        if( xARPCache[ xRow ].ulIPAddress != 0U )
+        {
+            prvARPIndexRemoveFromChain( &( xARPIndex.usIPBuckets[ prvARPHashIP( xARPCache[ xRow ].ulIPAddress ) ] ), xRow, pdTRUE );
+            prvARPIndexRemoveFromChain( &( xARPIndex.usMACBuckets[ prvARPHashMAC( &( xARPCache[ xRow ].xMACAddress ) ) ] ), xRow, pdFALSE );
+            prvARPIndexRemoveFromLRU( xRow );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Wipe a row. When the row was in the index, it is moved to the free
+ *        list.
+ *
+ * @param[in] xRow The row to be released.
+ */
+    static void prvARPIndexRelease( BaseType_t xRow )
+    {
+        if( xARPCache[ xRow ].ulIPAddress != 0U )
+        {
+            prvARPIndexUnlink( xRow );
+            xARPIndex.xLinks[ xRow ].usOlder = xARPIndex.usFree;
+            xARPIndex.usFree = arpROW_TO_LINK( xRow );
+        }
+
+        ( void ) memset( &( xARPCache[ xRow ] ), 0, sizeof( ARPCacheRow_t ) );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get a row for a new entry: a released row, a row that was never used,
+ *        or else the least recently used row. The caller must unlink the row
+ *        before it is overwritten.
+ *
+ * @return The index of the row.
+ */
+    static BaseType_t prvARPIndexAllocate( void )
+    {
+        BaseType_t xRow;
+
+        if( xARPIndex.usFree != 0U )
+        {
+            xRow = arpLINK_TO_ROW( xARPIndex.usFree );
+            xARPIndex.usFree = xARPIndex.xLinks[ xRow ].usOlder;
+            xARPIndex.xLinks[ xRow ].usOlder = 0U;
+        }
+        else if( xARPIndex.usUnused < ( uint16_t ) ipconfigARP_CACHE_ENTRIES )
+        {
+            xRow = ( BaseType_t ) xARPIndex.usUnused;
+            xARPIndex.usUnused++;
+        }
+        else if( xARPIndex.usOldest != 0U )
+        {
+            xRow = arpLINK_TO_ROW( xARPIndex.usOldest );
+        }
+        else
+        {
+            /* All rows are taken but none is indexed, which should not
+             * happen. */
+            xRow = 0;
+        }
+
+        return xRow;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
+
 
 /*
  * IP-clash detection is currently only used internally. When DHCP doesn't respond, the
@@ -372,11 +760,7 @@ _static ARPCacheRow_t xARPCache[ ipconfigARP_CACHE_ENTRIES ];
                                           NetworkEndPoint_t * pxTargetEndPoint,
                                           uint32_t ulSenderProtocolAddress )
     {
-        ARPHeader_t * pxARPHeader = &( pxARPFrame->xARPHeader );
-/* memcpy() helper variables for MISRA Rule 21.15 compliance*/
-        const void * pvCopySource;
-        void * pvCopyDest;
-
+        const ARPHeader_t * pxARPHeader = &( pxARPFrame->xARPHeader );
 
         /* The packet contained an ARP request.  Was it for the IP
          * address of one of the end-points? */
@@ -388,6 +772,26 @@ _static ARPCacheRow_t xARPCache[ ipconfigARP_CACHE_ENTRIES ];
          * already exists. */
         vARPRefreshCacheEntry( &( pxARPHeader->xSenderHardwareAddress ), ulSenderProtocolAddress, pxTargetEndPoint );
 
+        prvARPGenerateReply( pxARPFrame, pxTargetEndPoint, ulSenderProtocolAddress );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Turn an ARP request into the reply of an end-point, in the same buffer.
+ *
+ * @param[in,out] pxARPFrame the complete ARP-frame.
+ * @param[in] pxTargetEndPoint the end-point that answers.
+ * @param[in] ulSenderProtocolAddress the IP-address of the sender of the request.
+ */
+    static void prvARPGenerateReply( ARPPacket_t * pxARPFrame,
+                                     const NetworkEndPoint_t * pxTargetEndPoint,
+                                     uint32_t ulSenderProtocolAddress )
+    {
+        ARPHeader_t * pxARPHeader = &( pxARPFrame->xARPHeader );
+/* memcpy() helper variables for MISRA Rule 21.15 compliance*/
+        const void * pvCopySource;
+        void * pvCopyDest;
+
         /* Generate a reply payload in the same buffer. */
         pxARPHeader->usOperation = ( uint16_t ) ipARP_REPLY;
 
@@ -417,6 +821,58 @@ _static ARPCacheRow_t xARPCache[ ipconfigARP_CACHE_ENTRIES ];
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_DRIVER_RESPONDER != 0 )
+
+/**
+ * @brief Called by xIPDriverRespond(), outside the IP-task: turn an ARP
+ *        request for the address of an end-point into a reply.  The ARP
+ *        cache belongs to the IP-task, the sender is not learned here.
+ *        Requests that need more than a reply, like probes, gratuitous
+ *        ARP or an address clash, are left to the IP-task.
+ *
+ * @param[in,out] pxNetworkBuffer The received frame, at least an ARPPacket_t.
+ * @param[in] pxEndPoint The up end-point of the receiving interface that owns
+ *                       the target address of the request.
+ *
+ * @return pdTRUE when the buffer now holds the reply.
+ */
+        BaseType_t xARPRespondInDriver( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                        const NetworkEndPoint_t * pxEndPoint )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            ARPPacket_t * pxARPFrame = ( ( ARPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+            const ARPHeader_t * pxARPHeader = &( pxARPFrame->xARPHeader );
+            uint32_t ulSenderProtocolAddress;
+            BaseType_t xReturn = pdFALSE;
+
+            /* The field ucSenderProtocolAddress is badly aligned. */
+            ( void ) memcpy( &( ulSenderProtocolAddress ), pxARPHeader->ucSenderProtocolAddress, sizeof( ulSenderProtocolAddress ) );
+
+            if( ( pxARPHeader->usHardwareType == ipARP_HARDWARE_TYPE_ETHERNET ) &&
+                ( pxARPHeader->usProtocolType == ipARP_PROTOCOL_TYPE ) &&
+                ( pxARPHeader->ucHardwareAddressLength == ipMAC_ADDRESS_LENGTH_BYTES ) &&
+                ( pxARPHeader->ucProtocolAddressLength == ipIP_ADDRESS_LENGTH_BYTES ) &&
+                ( pxARPHeader->usOperation == ( uint16_t ) ipARP_REQUEST ) &&
+                ( pxARPHeader->ulTargetProtocolAddress == pxEndPoint->ipv4_settings.ulIPAddress ) &&
+                ( ( pxARPHeader->xSenderHardwareAddress.ucBytes[ 0 ] & 0x01U ) == 0U ) &&
+                ( memcmp( pxARPHeader->xSenderHardwareAddress.ucBytes, pxEndPoint->xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES ) != 0 ) &&
+                ( ulSenderProtocolAddress != 0U ) &&
+                ( ulSenderProtocolAddress != pxEndPoint->ipv4_settings.ulIPAddress ) &&
+                ( ( FreeRTOS_ntohl( ulSenderProtocolAddress ) < ipFIRST_LOOPBACK_IPv4 ) ||
+                  ( FreeRTOS_ntohl( ulSenderProtocolAddress ) >= ipLAST_LOOPBACK_IPv4 ) ) )
+            {
+                iptraceSENDING_ARP_REPLY( ulSenderProtocolAddress );
+                prvARPGenerateReply( pxARPFrame, pxEndPoint, ulSenderProtocolAddress );
+                xReturn = pdTRUE;
+            }
+
+            return xReturn;
+        }
+    #endif /* ipconfigUSE_DRIVER_RESPONDER */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief A device has sent an ARP reply, process it.
  * @param[in] pxARPFrame The ARP packet received.
@@ -438,6 +894,13 @@ _static ARPCacheRow_t xARPCache[ ipconfigARP_CACHE_ENTRIES ];
             vARPRefreshCacheEntry( &( pxARPHeader->xSenderHardwareAddress ), ulSenderProtocolAddress, pxTargetEndPoint );
         }
 
+        #if ( ipconfigARP_WAITING_BUFFER_COUNT > 1 )
+        {
+            /* Pass the packets that were waiting for this address to the IP-task. */
+            vIPWaitingBuffersResolved( ulSenderProtocolAddress, NULL );
+        }
+        #endif
+
         if( ( pxARPWaitingNetworkBuffer != NULL ) &&
             ( uxIPHeaderSizePacket( pxARPWaitingNetworkBuffer ) == ipSIZE_OF_IPv4_HEADER ) )
         {
@@ -487,25 +950,45 @@ BaseType_t xIsIPInARPCache( uint32_t ulAddressToLookup )
 {
     BaseType_t x, xReturn = pdFALSE;
 
-    /* Loop through each entry in the ARP cache. */
-    for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
-    {
-        /* Does this row in the ARP cache table hold an entry for the IP address
-         * being queried? */
-        if( xARPCache[ x ].ulIPAddress == ulAddressToLookup )
+    #if ( ipconfigARP_STATIC_ENTRIES > 0 )
+        if( prvARPStaticFind( ulAddressToLookup ) >= 0 )
         {
             xReturn = pdTRUE;
+        }
+        else
+    #endif
+    #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
+    {
+        x = prvARPIndexFindIP( ulAddressToLookup );
 
-            /* A matching valid entry was found. */
-            if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+        if( ( x >= 0 ) && ( xARPCache[ x ].ucValid != ( uint8_t ) pdFALSE ) )
+        {
+            xReturn = pdTRUE;
+        }
+    }
+    #else
+    {
+        /* Loop through each entry in the ARP cache. */
+        for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+        {
+            /* Does this row in the ARP cache table hold an entry for the IP address
+             * being queried? */
+            if( xARPCache[ x ].ulIPAddress == ulAddressToLookup )
             {
-                /* This entry is waiting an ARP reply, so is not valid. */
-                xReturn = pdFALSE;
-            }
+                xReturn = pdTRUE;
 
-            break;
+                /* A matching valid entry was found. */
+                if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+                {
+                    /* This entry is waiting an ARP reply, so is not valid. */
+                    xReturn = pdFALSE;
+                }
+
+                break;
+            }
         }
     }
+    #endif /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
 
     return xReturn;
 }
@@ -633,16 +1116,42 @@ BaseType_t xCheckRequiresARPResolution( const NetworkBufferDescriptor_t * pxNetw
 
         configASSERT( pxMACAddress != NULL );
 
-        /* For each entry in the ARP cache table. */
-        for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+        #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
         {
-            if( ( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
+            x = prvARPIndexFindMAC( pxMACAddress );
+
+            if( x >= 0 )
             {
                 lResult = xARPCache[ x ].ulIPAddress;
-                ( void ) memset( &xARPCache[ x ], 0, sizeof( xARPCache[ x ] ) );
-                break;
+                prvARPIndexRelease( x );
+
+                #if ( ipHEADER_CACHE != 0 )
+                {
+                    vIPHeaderCacheInvalidate();
+                }
+                #endif
+            }
+        }
+        #else /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
+        {
+            /* For each entry in the ARP cache table. */
+            for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+            {
+                if( ( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
+                {
+                    lResult = xARPCache[ x ].ulIPAddress;
+                    ( void ) memset( &xARPCache[ x ], 0, sizeof( xARPCache[ x ] ) );
+
+                    #if ( ipHEADER_CACHE != 0 )
+                    {
+                        vIPHeaderCacheInvalidate();
+                    }
+                    #endif
+                    break;
+                }
             }
         }
+        #endif /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
 
         return lResult;
     }
@@ -664,22 +1173,37 @@ void vARPRefreshCacheEntryAge( const MACAddress_t * pxMACAddress,
 
     if( pxMACAddress != NULL )
     {
-        /* Loop through each entry in the ARP cache. */
-        for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+        #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
         {
-            /* Does this line in the cache table hold an entry for the IP
-             * address being queried? */
-            if( xARPCache[ x ].ulIPAddress == ulIPAddress )
+            x = prvARPIndexFindIP( ulIPAddress );
+
+            if( ( x >= 0 ) &&
+                ( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
             {
-                /* Does this cache entry have the same MAC address? */
-                if( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 )
+                xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
+                prvARPIndexTouch( x );
+            }
+        }
+        #else /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
+        {
+            /* Loop through each entry in the ARP cache. */
+            for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+            {
+                /* Does this line in the cache table hold an entry for the IP
+                 * address being queried? */
+                if( xARPCache[ x ].ulIPAddress == ulIPAddress )
                 {
-                    /* The IP address and the MAC matched, update this entry age. */
-                    xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
-                    break;
+                    /* Does this cache entry have the same MAC address? */
+                    if( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 )
+                    {
+                        /* The IP address and the MAC matched, update this entry age. */
+                        xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
+                        break;
+                    }
                 }
             }
         }
+        #endif /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
     }
 }
 /*-----------------------------------------------------------*/
@@ -697,6 +1221,20 @@ void vARPRefreshCacheEntry( const MACAddress_t * pxMACAddress,
                             const uint32_t ulIPAddress,
                             struct xNetworkEndPoint * pxEndPoint )
 {
+    #if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigARP_REQUEST_LIMIT_ENTRIES > 0 ) )
+        if( pxMACAddress != NULL )
+        {
+            prvARPRequestResolved( ulIPAddress );
+        }
+    #endif
+
+    #if ( ipconfigUSE_BRING_UP_TIMELINE != 0 )
+        if( pxMACAddress != NULL )
+        {
+            vBringUpEndPointMilestone( pxEndPoint, eBringUpFirstNeighbour );
+        }
+    #endif
+
     #if ( ipconfigARP_STORES_REMOTE_ADDRESSES == 0 )
         /* Only process the IP address if it is on the local network. */
         BaseType_t xAddressIsLocal = ( FreeRTOS_FindEndPointOnNetMask( ulIPAddress ) != NULL ) ? 1 : 0; /* ARP remote address. */
@@ -731,7 +1269,15 @@ void vARPRefreshCacheEntry( const MACAddress_t * pxMACAddress,
                     /* Both the MAC address as well as the IP address were found in
                      * different locations: clear the entry which matches the
                      * IP-address */
-                    ( void ) memset( &( xARPCache[ xLocation.xIpEntry ] ), 0, sizeof( ARPCacheRow_t ) );
+                    #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
+                    {
+                        prvARPIndexRelease( xLocation.xIpEntry );
+                    }
+                    #else
+                    {
+                        ( void ) memset( &( xARPCache[ xLocation.xIpEntry ] ), 0, sizeof( ARPCacheRow_t ) );
+                    }
+                    #endif
                 }
             }
             else if( xLocation.xIpEntry >= 0 )
@@ -742,8 +1288,24 @@ void vARPRefreshCacheEntry( const MACAddress_t * pxMACAddress,
             else
             {
                 /* No matching entry found. */
+                #if ( ipconfigUSE_RESOURCE_STATS != 0 )
+                {
+                    if( xARPCache[ xLocation.xUseEntry ].ucValid != ( uint8_t ) pdFALSE )
+                    {
+                        /* The cache is full, a resolved entry is pushed out. */
+                        ipRESOURCE_SHORTAGE( eShortageARPCache );
+                    }
+                }
+                #endif
             }
 
+            #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
+            {
+                /* The IP- or MAC-address of the row will change. */
+                prvARPIndexUnlink( xLocation.xUseEntry );
+            }
+            #endif
+
             /* If the entry was not found, we use the oldest entry and set the IPaddress */
             xARPCache[ xLocation.xUseEntry ].ulIPAddress = ulIPAddress;
 
@@ -766,6 +1328,19 @@ void vARPRefreshCacheEntry( const MACAddress_t * pxMACAddress,
             {
                 /* Nothing will be stored. */
             }
+
+            #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
+            {
+                prvARPIndexLink( xLocation.xUseEntry );
+            }
+            #endif
+
+            #if ( ipHEADER_CACHE != 0 )
+            {
+                /* The MAC address of an IP address may have changed. */
+                vIPHeaderCacheInvalidate();
+            }
+            #endif
         }
     }
 }
@@ -785,106 +1360,181 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
                                      CacheLocation_t * pxLocation )
 {
     BaseType_t x = 0;
-    uint8_t ucMinAgeFound = 0U;
     BaseType_t xReturn = pdFALSE;
 
     #if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 )
         BaseType_t xAddressIsLocal = ( FreeRTOS_FindEndPointOnNetMask( ulIPAddress ) != NULL ) ? 1 : 0; /* ARP remote address. */
     #endif
 
-    /* Start with the maximum possible number. */
-    ucMinAgeFound--;
-
     pxLocation->xIpEntry = -1;
     pxLocation->xMacEntry = -1;
     pxLocation->xUseEntry = 0;
 
-    /* For each entry in the ARP cache table. */
-    for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+    #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
     {
-        BaseType_t xMatchingMAC = pdFALSE;
-
-        if( pxMACAddress != NULL )
+        if( ulIPAddress == 0U )
         {
-            if( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 )
-            {
-                xMatchingMAC = pdTRUE;
-            }
+            /* An empty row has IP-address zero, it can not be stored. */
+            xReturn = pdTRUE;
         }
-
-        /* Does this line in the cache table hold an entry for the IP
-         * address being queried? */
-        if( xARPCache[ x ].ulIPAddress == ulIPAddress )
+        else
         {
-            if( pxMACAddress == NULL )
+            x = prvARPIndexFindIP( ulIPAddress );
+
+            if( x >= 0 )
             {
-                /* In case the parameter pxMACAddress is NULL, an entry will be reserved to
-                 * indicate that there is an outstanding ARP request, This entry will have
-                 * "ucValid == pdFALSE". */
                 pxLocation->xIpEntry = x;
-                break;
+
+                if( ( pxMACAddress != NULL ) &&
+                    ( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
+                {
+                    /* This function will be called for each received packet
+                     * This is by far the most common path. */
+                    xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
+                    xARPCache[ x ].ucValid = ( uint8_t ) pdTRUE;
+                    xARPCache[ x ].pxEndPoint = pxEndPoint;
+                    prvARPIndexTouch( x );
+                    /* Indicate to the caller that the entry is updated. */
+                    xReturn = pdTRUE;
+                }
             }
 
-            /* See if the MAC-address also matches. */
-            if( xMatchingMAC != pdFALSE )
+            if( ( xReturn == pdFALSE ) && ( pxMACAddress != NULL ) )
             {
-                /* This function will be called for each received packet
-                 * This is by far the most common path. */
-                xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
-                xARPCache[ x ].ucValid = ( uint8_t ) pdTRUE;
-                xARPCache[ x ].pxEndPoint = pxEndPoint;
-                /* Indicate to the caller that the entry is updated. */
-                xReturn = pdTRUE;
-                break;
+                /* Look for another row with the given MAC-address. */
+                uint16_t usLink = xARPIndex.usMACBuckets[ prvARPHashMAC( pxMACAddress ) ];
+
+                while( usLink != 0U )
+                {
+                    BaseType_t xRow = arpLINK_TO_ROW( usLink );
+
+                    if( ( xRow != pxLocation->xIpEntry ) &&
+                        ( memcmp( xARPCache[ xRow ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
+                    {
+                        #if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 )
+                        {
+                            /* The MAC address of the gateway should not be
+                             * overwritten, see below. */
+                            BaseType_t xOtherIsLocal = ( FreeRTOS_FindEndPointOnNetMask( xARPCache[ xRow ].ulIPAddress ) != NULL ) ? 1 : 0; /* ARP remote address. */
+
+                            if( xAddressIsLocal == xOtherIsLocal )
+                            {
+                                pxLocation->xMacEntry = xRow;
+                            }
+                        }
+                        #else
+                        {
+                            pxLocation->xMacEntry = xRow;
+                        }
+                        #endif
+                    }
+
+                    usLink = xARPIndex.xLinks[ xRow ].usNextMAC;
+                }
             }
 
-            /* Found an entry containing ulIPAddress, but the MAC address
-             * doesn't match.  Might be an entry with ucValid=pdFALSE, waiting
-             * for an ARP reply.  Still want to see if there is match with the
-             * given MAC address.ucBytes.  If found, either of the two entries
-             * must be cleared. */
-            pxLocation->xIpEntry = x;
+            if( ( xReturn == pdFALSE ) && ( pxLocation->xIpEntry < 0 ) && ( pxLocation->xMacEntry < 0 ) )
+            {
+                /* A new row is needed. */
+                pxLocation->xUseEntry = prvARPIndexAllocate();
+            }
         }
-        else if( xMatchingMAC != pdFALSE )
+    }
+    #else /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
+    {
+        uint8_t ucMinAgeFound = 0U;
+
+        /* Start with the maximum possible number. */
+        ucMinAgeFound--;
+
+        /* For each entry in the ARP cache table. */
+        for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
         {
-            /* Found an entry with the given MAC-address, but the IP-address
-             * is different.  Continue looping to find a possible match with
-             * ulIPAddress. */
-            #if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 )
+            BaseType_t xMatchingMAC = pdFALSE;
+
+            if( pxMACAddress != NULL )
             {
-                /* If ARP stores the MAC address of IP addresses outside the
-                 * network, than the MAC address of the gateway should not be
-                 * overwritten. */
-                BaseType_t xOtherIsLocal = ( FreeRTOS_FindEndPointOnNetMask( xARPCache[ x ].ulIPAddress ) != NULL ) ? 1 : 0; /* ARP remote address. */
+                if( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 )
+                {
+                    xMatchingMAC = pdTRUE;
+                }
+            }
 
-                if( xAddressIsLocal == xOtherIsLocal )
+            /* Does this line in the cache table hold an entry for the IP
+             * address being queried? */
+            if( xARPCache[ x ].ulIPAddress == ulIPAddress )
+            {
+                if( pxMACAddress == NULL )
                 {
-                    pxLocation->xMacEntry = x;
+                    /* In case the parameter pxMACAddress is NULL, an entry will be reserved to
+                     * indicate that there is an outstanding ARP request, This entry will have
+                     * "ucValid == pdFALSE". */
+                    pxLocation->xIpEntry = x;
+                    break;
                 }
+
+                /* See if the MAC-address also matches. */
+                if( xMatchingMAC != pdFALSE )
+                {
+                    /* This function will be called for each received packet
+                     * This is by far the most common path. */
+                    xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
+                    xARPCache[ x ].ucValid = ( uint8_t ) pdTRUE;
+                    xARPCache[ x ].pxEndPoint = pxEndPoint;
+                    /* Indicate to the caller that the entry is updated. */
+                    xReturn = pdTRUE;
+                    break;
+                }
+
+                /* Found an entry containing ulIPAddress, but the MAC address
+                 * doesn't match.  Might be an entry with ucValid=pdFALSE, waiting
+                 * for an ARP reply.  Still want to see if there is match with the
+                 * given MAC address.ucBytes.  If found, either of the two entries
+                 * must be cleared. */
+                pxLocation->xIpEntry = x;
             }
-            #else /* if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 ) */
+            else if( xMatchingMAC != pdFALSE )
             {
-                pxLocation->xMacEntry = x;
+                /* Found an entry with the given MAC-address, but the IP-address
+                 * is different.  Continue looping to find a possible match with
+                 * ulIPAddress. */
+                #if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 )
+                {
+                    /* If ARP stores the MAC address of IP addresses outside the
+                     * network, than the MAC address of the gateway should not be
+                     * overwritten. */
+                    BaseType_t xOtherIsLocal = ( FreeRTOS_FindEndPointOnNetMask( xARPCache[ x ].ulIPAddress ) != NULL ) ? 1 : 0; /* ARP remote address. */
+
+                    if( xAddressIsLocal == xOtherIsLocal )
+                    {
+                        pxLocation->xMacEntry = x;
+                    }
+                }
+                #else /* if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 ) */
+                {
+                    pxLocation->xMacEntry = x;
+                }
+                #endif /* if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 ) */
             }
-            #endif /* if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 ) */
-        }
 
-        /* _HT_
-         * Shouldn't we test for xARPCache[ x ].ucValid == pdFALSE here ? */
-        else if( xARPCache[ x ].ucAge < ucMinAgeFound )
-        {
-            /* As the table is traversed, remember the table row that
-             * contains the oldest entry (the lowest age count, as ages are
-             * decremented to zero) so the row can be re-used if this function
-             * needs to add an entry that does not already exist. */
-            ucMinAgeFound = xARPCache[ x ].ucAge;
-            pxLocation->xUseEntry = x;
-        }
-        else
-        {
-            /* Nothing happens to this cache entry for now. */
-        }
-    } /* for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ ) */
+            /* _HT_
+             * Shouldn't we test for xARPCache[ x ].ucValid == pdFALSE here ? */
+            else if( xARPCache[ x ].ucAge < ucMinAgeFound )
+            {
+                /* As the table is traversed, remember the table row that
+                 * contains the oldest entry (the lowest age count, as ages are
+                 * decremented to zero) so the row can be re-used if this function
+                 * needs to add an entry that does not already exist. */
+                ucMinAgeFound = xARPCache[ x ].ucAge;
+                pxLocation->xUseEntry = x;
+            }
+            else
+            {
+                /* Nothing happens to this cache entry for now. */
+            }
+        } /* for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ ) */
+    }
+    #endif /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
 
     return xReturn;
 }
@@ -915,25 +1565,46 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
             *( ppxInterface ) = NULL;
         }
 
-        /* Loop through each entry in the ARP cache. */
-        for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+        #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
         {
-            /* Does this row in the ARP cache table hold an entry for the MAC
-             * address being searched? */
-            if( memcmp( pxMACAddress->ucBytes, xARPCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) ) == 0 )
+            x = prvARPIndexFindMAC( pxMACAddress );
+
+            if( x >= 0 )
             {
                 *pulIPAddress = xARPCache[ x ].ulIPAddress;
 
                 if( ( ppxInterface != NULL ) &&
                     ( xARPCache[ x ].pxEndPoint != NULL ) )
                 {
-                    *( ppxInterface ) = xARPCache[ x ].pxEndPoint->pxNetworkInterface;
-                }
+                    *( ppxInterface ) = xARPCache[ x ].pxEndPoint->pxNetworkInterface;
+                }
+
+                eReturn = eARPCacheHit;
+            }
+        }
+        #else /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
+        {
+            /* Loop through each entry in the ARP cache. */
+            for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+            {
+                /* Does this row in the ARP cache table hold an entry for the MAC
+                 * address being searched? */
+                if( memcmp( pxMACAddress->ucBytes, xARPCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) ) == 0 )
+                {
+                    *pulIPAddress = xARPCache[ x ].ulIPAddress;
 
-                eReturn = eARPCacheHit;
-                break;
+                    if( ( ppxInterface != NULL ) &&
+                        ( xARPCache[ x ].pxEndPoint != NULL ) )
+                    {
+                        *( ppxInterface ) = xARPCache[ x ].pxEndPoint->pxNetworkInterface;
+                    }
+
+                    eReturn = eARPCacheHit;
+                    break;
+                }
             }
         }
+        #endif /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
 
         return eReturn;
     }
@@ -1053,18 +1724,46 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
                 else
             #endif
             {
-                /* The IP address is off the local network, so look up the
-                 * hardware address of the router, if any. */
-                *( ppxEndPoint ) = FreeRTOS_FindGateWay( ( BaseType_t ) ipTYPE_IPv4 );
+                #if ( ipconfigUSE_STATIC_ROUTES != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 )
+                    IP_Address_t xDestination;
+                    IP_Address_t xNextHop;
 
-                if( *( ppxEndPoint ) != NULL )
-                {
-                    /* 'ipv4_settings' can be accessed safely, because 'ipTYPE_IPv4' was provided. */
-                    ulAddressToLookup = ( *ppxEndPoint )->ipv4_settings.ulGatewayAddress;
-                }
-                else
+                    /* A static route takes precedence over the default gateway. */
+                    xDestination.ulIP_IPv4 = ulAddressToLookup;
+                    *( ppxEndPoint ) = FreeRTOS_FindRoute( &xDestination, ( BaseType_t ) ipTYPE_IPv4, &xNextHop );
+
+                    if( *( ppxEndPoint ) != NULL )
+                    {
+                        ulAddressToLookup = xNextHop.ulIP_IPv4;
+                    }
+                    else
+                #endif /* ( ipconfigUSE_STATIC_ROUTES != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 ) */
                 {
-                    ulAddressToLookup = 0U;
+                    /* The IP address is off the local network, so look up the
+                     * hardware address of the router, if any. */
+                    #if ( ipconfigUSE_ROUTE_ECMP != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 )
+                    {
+                        IP_Address_t xRemoteAddress;
+
+                        /* Several uplinks may have a gateway, the destination selects one. */
+                        xRemoteAddress.ulIP_IPv4 = ulAddressToLookup;
+                        *( ppxEndPoint ) = FreeRTOS_FindGateWayForDestination( &( xRemoteAddress ), ( BaseType_t ) ipTYPE_IPv4 );
+                    }
+                    #else
+                    {
+                        *( ppxEndPoint ) = FreeRTOS_FindGateWay( ( BaseType_t ) ipTYPE_IPv4 );
+                    }
+                    #endif
+
+                    if( *( ppxEndPoint ) != NULL )
+                    {
+                        /* 'ipv4_settings' can be accessed safely, because 'ipTYPE_IPv4' was provided. */
+                        ulAddressToLookup = ( *ppxEndPoint )->ipv4_settings.ulGatewayAddress;
+                    }
+                    else
+                    {
+                        ulAddressToLookup = 0U;
+                    }
                 }
             }
         }
@@ -1127,14 +1826,24 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
         BaseType_t x;
         eARPLookupResult_t eReturn = eARPCacheMiss;
 
-        /* Loop through each entry in the ARP cache. */
-        for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+        #if ( ipconfigARP_STATIC_ENTRIES > 0 )
+            x = prvARPStaticFind( ulAddressToLookup );
+
+            if( x >= 0 )
+            {
+                /* A permanent entry: no need to touch or refresh it. */
+                ( void ) memcpy( pxMACAddress->ucBytes, xARPStaticCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                *( ppxEndPoint ) = xARPStaticCache[ x ].pxEndPoint;
+                eReturn = eARPCacheHit;
+            }
+            else
+        #endif
+        #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
         {
-            /* Does this row in the ARP cache table hold an entry for the IP address
-             * being queried? */
-            if( xARPCache[ x ].ulIPAddress == ulAddressToLookup )
+            x = prvARPIndexFindIP( ulAddressToLookup );
+
+            if( x >= 0 )
             {
-                /* A matching valid entry was found. */
                 if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
                 {
                     /* This entry is waiting an ARP reply, so is not valid. */
@@ -1142,16 +1851,52 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
                 }
                 else
                 {
-                    /* A valid entry was found. */
                     ( void ) memcpy( pxMACAddress->ucBytes, xARPCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
-                    /* ppxEndPoint != NULL was tested in the only caller eARPGetCacheEntry(). */
                     *( ppxEndPoint ) = xARPCache[ x ].pxEndPoint;
+                    prvARPIndexTouch( x );
+                    #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+                    {
+                        xARPCache[ x ].ucUsed = 1U;
+                    }
+                    #endif
                     eReturn = eARPCacheHit;
                 }
+            }
+        }
+        #else /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
+        {
+            /* Loop through each entry in the ARP cache. */
+            for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+            {
+                /* Does this row in the ARP cache table hold an entry for the IP address
+                 * being queried? */
+                if( xARPCache[ x ].ulIPAddress == ulAddressToLookup )
+                {
+                    /* A matching valid entry was found. */
+                    if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+                    {
+                        /* This entry is waiting an ARP reply, so is not valid. */
+                        eReturn = eCantSendPacket;
+                    }
+                    else
+                    {
+                        /* A valid entry was found. */
+                        ( void ) memcpy( pxMACAddress->ucBytes, xARPCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                        /* ppxEndPoint != NULL was tested in the only caller eARPGetCacheEntry(). */
+                        *( ppxEndPoint ) = xARPCache[ x ].pxEndPoint;
+                        #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+                        {
+                            xARPCache[ x ].ucUsed = 1U;
+                        }
+                        #endif
+                        eReturn = eARPCacheHit;
+                    }
 
-                break;
+                    break;
+                }
             }
         }
+        #endif /* if ( ipconfigUSE_ARP_HASH_TABLE != 0 ) */
 
         return eReturn;
     }
@@ -1186,23 +1931,66 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
                 {
                     FreeRTOS_OutputARPRequest( xARPCache[ x ].ulIPAddress );
                 }
-                else if( xARPCache[ x ].ucAge <= ( uint8_t ) arpMAX_ARP_AGE_BEFORE_NEW_ARP_REQUEST )
+                else if( xARPCache[ x ].ucAge <= arpREFRESH_AGE )
                 {
-                    /* This entry will get removed soon.  See if the MAC address is
-                     * still valid to prevent this happening. */
-                    iptraceARP_TABLE_ENTRY_WILL_EXPIRE( xARPCache[ x ].ulIPAddress );
-                    FreeRTOS_OutputARPRequest( xARPCache[ x ].ulIPAddress );
+                    #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+                    {
+                        /* Only refresh the hosts that were used during the last
+                         * period, and ask them directly. Unused entries may expire. */
+                        if( xARPCache[ x ].ucUsed != 0U )
+                        {
+                            iptraceARP_TABLE_ENTRY_WILL_EXPIRE( xARPCache[ x ].ulIPAddress );
+
+                            if( xARPCache[ x ].pxEndPoint != NULL )
+                            {
+                                prvOutputARPRequest( xARPCache[ x ].pxEndPoint, xARPCache[ x ].ulIPAddress, &( xARPCache[ x ].xMACAddress ) );
+                            }
+                            else
+                            {
+                                FreeRTOS_OutputARPRequest( xARPCache[ x ].ulIPAddress );
+                            }
+                        }
+                    }
+                    #else
+                    {
+                        /* This entry will get removed soon.  See if the MAC address is
+                         * still valid to prevent this happening. */
+                        iptraceARP_TABLE_ENTRY_WILL_EXPIRE( xARPCache[ x ].ulIPAddress );
+                        FreeRTOS_OutputARPRequest( xARPCache[ x ].ulIPAddress );
+                    }
+                    #endif /* if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 ) */
                 }
                 else
                 {
                     /* The age has just ticked down, with nothing to do. */
                 }
 
+                #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+                {
+                    xARPCache[ x ].ucUsed = 0U;
+                }
+                #endif
+
                 if( xARPCache[ x ].ucAge == 0U )
                 {
                     /* The entry is no longer valid.  Wipe it out. */
                     iptraceARP_TABLE_ENTRY_EXPIRED( xARPCache[ x ].ulIPAddress );
-                    xARPCache[ x ].ulIPAddress = 0U;
+
+                    #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
+                    {
+                        prvARPIndexRelease( x );
+                    }
+                    #else
+                    {
+                        xARPCache[ x ].ulIPAddress = 0U;
+                    }
+                    #endif
+
+                    #if ( ipHEADER_CACHE != 0 )
+                    {
+                        vIPHeaderCacheInvalidate();
+                    }
+                    #endif
                 }
             }
         }
@@ -1272,11 +2060,42 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
  */
     void FreeRTOS_OutputARPRequest_Multi( NetworkEndPoint_t * pxEndPoint,
                                           uint32_t ulIPAddress )
+    {
+        prvOutputARPRequest( pxEndPoint, ulIPAddress, NULL );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create and send an ARP request packet to given IPv4 endpoint.
+ *
+ * @param[in] pxEndPoint Endpoint through which the requests should be sent.
+ * @param[in] ulIPAddress A 32-bit representation of the IP-address whose
+ *                         physical (MAC) address is required.
+ * @param[in] pxMACAddress When not NULL, the request is sent to this MAC-address
+ *                         instead of being broadcast, to refresh a known entry.
+ */
+    static void prvOutputARPRequest( NetworkEndPoint_t * pxEndPoint,
+                                     uint32_t ulIPAddress,
+                                     const MACAddress_t * pxMACAddress )
     {
         NetworkBufferDescriptor_t * pxNetworkBuffer;
+        BaseType_t xSendRequest = pdFALSE;
 
         if( ( pxEndPoint->bits.bIPv6 == pdFALSE_UNSIGNED ) &&
             ( pxEndPoint->ipv4_settings.ulIPAddress != 0U ) )
+        {
+            xSendRequest = pdTRUE;
+
+            #if ( ipconfigARP_REQUEST_LIMIT_ENTRIES > 0 )
+                /* Gratuitous ARPs and unicast polls are not limited. */
+                if( ( pxMACAddress == NULL ) && ( ulIPAddress != pxEndPoint->ipv4_settings.ulIPAddress ) )
+                {
+                    xSendRequest = prvARPRequestAllowed( ulIPAddress );
+                }
+            #endif
+        }
+
+        if( xSendRequest != pdFALSE )
         {
             /* This is called from the context of the IP event task, so a block time
              * must not be used. */
@@ -1289,6 +2108,17 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
                 pxNetworkBuffer->pxInterface = pxEndPoint->pxNetworkInterface;
                 vARPGenerateRequestPacket( pxNetworkBuffer );
 
+                if( pxMACAddress != NULL )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    ARPPacket_t * pxARPPacket = ( ( ARPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+
+                    /* A unicast poll of a known host, see RFC 1122 section 2.3.2.1. */
+                    ( void ) memcpy( pxARPPacket->xEthernetHeader.xDestinationAddress.ucBytes, pxMACAddress->ucBytes, sizeof( MACAddress_t ) );
+                }
+
                 #if ( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 )
                 {
                     if( pxNetworkBuffer->xDataLength < ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES )
@@ -1312,7 +2142,7 @@ static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
                     /* Only the IP-task is allowed to call this function directly. */
                     if( pxEndPoint->pxNetworkInterface != NULL )
                     {
-                        ( void ) pxEndPoint->pxNetworkInterface->pfOutput( pxEndPoint->pxNetworkInterface, pxNetworkBuffer, pdTRUE );
+                        ( void ) xIPInterfaceOutput( pxEndPoint->pxNetworkInterface, pxNetworkBuffer, pdTRUE );
                     }
                 }
                 else
@@ -1520,17 +2350,301 @@ void FreeRTOS_ClearARP( const struct xNetworkEndPoint * pxEndPoint )
         {
             if( xARPCache[ x ].pxEndPoint == pxEndPoint )
             {
-                ( void ) memset( &( xARPCache[ x ] ), 0, sizeof( ARPCacheRow_t ) );
+                #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
+                {
+                    prvARPIndexRelease( x );
+                }
+                #else
+                {
+                    ( void ) memset( &( xARPCache[ x ] ), 0, sizeof( ARPCacheRow_t ) );
+                }
+                #endif
             }
         }
     }
     else
     {
         ( void ) memset( xARPCache, 0, sizeof( xARPCache ) );
+
+        #if ( ipconfigUSE_ARP_HASH_TABLE != 0 )
+        {
+            ( void ) memset( &( xARPIndex ), 0, sizeof( xARPIndex ) );
+        }
+        #endif
+    }
+
+    #if ( ipHEADER_CACHE != 0 )
+    {
+        vIPHeaderCacheInvalidate();
     }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigARP_STATIC_ENTRIES > 0 )
+
+/**
+ * @brief Find a permanent entry.
+ *
+ * @param[in] ulIPAddress The IP-address to look for, not zero.
+ *
+ * @return The row in xARPStaticCache[], or -1 when not found.
+ */
+    static BaseType_t prvARPStaticFind( uint32_t ulIPAddress )
+    {
+        BaseType_t x;
+        BaseType_t xReturn = -1;
+
+        for( x = 0; x < ipconfigARP_STATIC_ENTRIES; x++ )
+        {
+            if( xARPStaticCache[ x ].ulIPAddress == ulIPAddress )
+            {
+                xReturn = x;
+                break;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a permanent IP to MAC address mapping, or change an existing
+ *        one.  The entry is found before the ARP cache, it never expires and
+ *        received ARP packets do not change it.  It may be called before
+ *        FreeRTOS_IPInit_Multi().
+ *
+ * @param[in] ulIPAddress The IP-address in network byte order, not zero.
+ * @param[in] pxMACAddress The MAC-address of the host.
+ * @param[in] pxEndPoint The end-point through which the host is reached.
+ *
+ * @return pdPASS when the entry was stored, pdFAIL when a parameter is
+ *         invalid or when all ipconfigARP_STATIC_ENTRIES rows are taken.
+ */
+    BaseType_t FreeRTOS_AddStaticARPEntry( uint32_t ulIPAddress,
+                                           const MACAddress_t * pxMACAddress,
+                                           struct xNetworkEndPoint * pxEndPoint )
+    {
+        BaseType_t xRow;
+        BaseType_t xReturn = pdFAIL;
+
+        if( ( ulIPAddress != 0U ) && ( pxMACAddress != NULL ) && ( pxEndPoint != NULL ) )
+        {
+            /* The IP-task reads the table without a lock. */
+            vTaskSuspendAll();
+            {
+                xRow = prvARPStaticFind( ulIPAddress );
+
+                if( xRow < 0 )
+                {
+                    xRow = prvARPStaticFind( 0U );
+                }
+
+                if( xRow >= 0 )
+                {
+                    ( void ) memcpy( xARPStaticCache[ xRow ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( MACAddress_t ) );
+                    xARPStaticCache[ xRow ].pxEndPoint = pxEndPoint;
+                    xARPStaticCache[ xRow ].ucValid = ( uint8_t ) pdTRUE;
+                    xARPStaticCache[ xRow ].ulIPAddress = ulIPAddress;
+
+                    #if ( ipHEADER_CACHE != 0 )
+                    {
+                        vIPHeaderCacheInvalidate();
+                    }
+                    #endif
+
+                    xReturn = pdPASS;
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a permanent entry that was added by FreeRTOS_AddStaticARPEntry().
+ *
+ * @param[in] ulIPAddress The IP-address of the entry.
+ *
+ * @return pdPASS when the entry was found and removed, otherwise pdFAIL.
+ */
+    BaseType_t FreeRTOS_RemoveStaticARPEntry( uint32_t ulIPAddress )
+    {
+        BaseType_t xRow;
+        BaseType_t xReturn = pdFAIL;
+
+        if( ulIPAddress != 0U )
+        {
+            vTaskSuspendAll();
+            {
+                xRow = prvARPStaticFind( ulIPAddress );
+
+                if( xRow >= 0 )
+                {
+                    ( void ) memset( &( xARPStaticCache[ xRow ] ), 0, sizeof( ARPCacheRow_t ) );
+
+                    #if ( ipHEADER_CACHE != 0 )
+                    {
+                        vIPHeaderCacheInvalidate();
+                    }
+                    #endif
+
+                    xReturn = pdPASS;
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigARP_STATIC_ENTRIES > 0 ) */
+
+#if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigARP_REQUEST_LIMIT_ENTRIES > 0 ) )
+
+/**
+ * @brief Check whether a broadcast ARP request for an address may be sent now.
+ *        Each request for the same address doubles the interval before the
+ *        next one, starting at ipconfigARP_REQUEST_MIN_INTERVAL_MS.  Called
+ *        by the IP-task and by xARPWaitResolution().
+ *
+ * @param[in] ulIPAddress The address that is asked for.
+ *
+ * @return pdTRUE when the request may be sent, pdFALSE when a request for the
+ *         same address was sent too recently.
+ */
+    static BaseType_t prvARPRequestAllowed( uint32_t ulIPAddress )
+    {
+        const TickType_t xMinInterval = pdMS_TO_TICKS( ipconfigARP_REQUEST_MIN_INTERVAL_MS );
+        const TickType_t xMaxInterval = pdMS_TO_TICKS( ipconfigARP_REQUEST_MAX_INTERVAL_MS );
+        TickType_t xNow = xTaskGetTickCount();
+        TickType_t xElapsed;
+        ARPRequestLimit_t * pxSlot = NULL;
+        BaseType_t xOldest = 0;
+        BaseType_t x;
+        BaseType_t xReturn = pdTRUE;
+
+        vTaskSuspendAll();
+        {
+            for( x = 0; x < ipconfigARP_REQUEST_LIMIT_ENTRIES; x++ )
+            {
+                if( xARPRequestLimits[ x ].ulIPAddress == ulIPAddress )
+                {
+                    pxSlot = &( xARPRequestLimits[ x ] );
+                    break;
+                }
+
+                if( ( xARPRequestLimits[ x ].ulIPAddress == 0U ) ||
+                    ( ( xARPRequestLimits[ xOldest ].ulIPAddress != 0U ) &&
+                      ( ( xNow - xARPRequestLimits[ x ].xLastRequest ) > ( xNow - xARPRequestLimits[ xOldest ].xLastRequest ) ) ) )
+                {
+                    xOldest = x;
+                }
+            }
+
+            if( pxSlot == NULL )
+            {
+                /* The first request for this address. */
+                pxSlot = &( xARPRequestLimits[ xOldest ] );
+                pxSlot->ulIPAddress = ulIPAddress;
+                pxSlot->xInterval = xMinInterval;
+            }
+            else
+            {
+                xElapsed = xNow - pxSlot->xLastRequest;
+
+                if( xElapsed < pxSlot->xInterval )
+                {
+                    xReturn = pdFALSE;
+                }
+                else if( xElapsed >= ( xMaxInterval * 2U ) )
+                {
+                    /* The address has not been asked for in a long time,
+                     * start the backoff again. */
+                    pxSlot->xInterval = xMinInterval;
+                }
+                else if( pxSlot->xInterval < xMaxInterval )
+                {
+                    pxSlot->xInterval = ( ( pxSlot->xInterval * 2U ) < xMaxInterval ) ? ( pxSlot->xInterval * 2U ) : xMaxInterval;
+                }
+                else
+                {
+                    /* The maximum interval has been reached. */
+                }
+            }
+
+            if( xReturn != pdFALSE )
+            {
+                pxSlot->xLastRequest = xNow;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xReturn == pdFALSE )
+        {
+            iptraceARP_REQUEST_SUPPRESSED( ulIPAddress );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Forget the outstanding request for an address, because its
+ *        MAC-address is now known.
+ *
+ * @param[in] ulIPAddress The address that has been resolved.
+ */
+    static void prvARPRequestResolved( uint32_t ulIPAddress )
+    {
+        BaseType_t x;
+
+        vTaskSuspendAll();
+        {
+            for( x = 0; x < ipconfigARP_REQUEST_LIMIT_ENTRIES; x++ )
+            {
+                if( xARPRequestLimits[ x ].ulIPAddress == ulIPAddress )
+                {
+                    xARPRequestLimits[ x ].ulIPAddress = 0U;
+                    break;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigARP_REQUEST_LIMIT_ENTRIES > 0 ) ) */
+
+#if ( ipconfigUSE_RESOURCE_STATS != 0 )
+
+/**
+ * @brief Count the rows of the ARP cache that hold an IP-address, either
+ *        resolved or waiting for a reply.
+ *
+ * @return The number of occupied rows.
+ */
+    UBaseType_t uxARPCacheRowsInUse( void )
+    {
+        BaseType_t x;
+        UBaseType_t uxCount = 0U;
+
+        for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+        {
+            if( xARPCache[ x ].ulIPAddress != 0U )
+            {
+                uxCount++;
+            }
+        }
+
+        return uxCount;
+    }
+#endif /* ( ipconfigUSE_RESOURCE_STATS != 0 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ipconfigHAS_PRINTF != 0 ) || ( ipconfigHAS_DEBUG_PRINTF != 0 )
 
     void FreeRTOS_PrintARPCache( void )
@@ -0,0 +1,397 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_Bond.c
+ * @brief Implements the bond interfaces: virtual interfaces that spread the
+ *        traffic of their end-points over several physical interfaces.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_Bond.h"
+#include "NetworkInterface.h"
+#include "NetworkBufferManagement.h"
+
+/* *INDENT-OFF* */
+#if ( ipconfigUSE_LINK_BONDING != 0 )
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the weight of a member for a flow. The member with the
+ *        highest weight sends the flow, so when a member goes down, only the
+ *        flows that it was sending move to another member.
+ *
+ * @param[in] ulFlowHash The hash of the flow, see ulNetworkFlowHash().
+ * @param[in] uxMember The position of the member in its bond.
+ *
+ * @return The weight.
+ */
+static uint32_t prvBondWeight( uint32_t ulFlowHash,
+                               UBaseType_t uxMember )
+{
+    uint32_t ulHash = ulFlowHash ^ ( ( ( uint32_t ) uxMember + 1U ) * 0x9E3779B9U );
+
+    ulHash ^= ulHash >> 16;
+    ulHash *= 0x85EBCA6BU;
+    ulHash ^= ulHash >> 13;
+    ulHash *= 0xC2B2AE35U;
+    ulHash ^= ulHash >> 16;
+
+    return ulHash;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the member that sends a frame.
+ *
+ * @param[in] pxBond The bond interface.
+ * @param[in] pxNetworkBuffer The frame.
+ *
+ * @return The member, or NULL when none of the members is up.
+ */
+static NetworkInterface_t * prvBondSelectMember( const NetworkInterface_t * pxBond,
+                                                 const NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    NetworkInterface_t * pxMember;
+    NetworkInterface_t * pxSelected = NULL;
+    uint32_t ulFlowHash = ulNetworkFlowHash( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+    uint32_t ulBest = 0U;
+    uint32_t ulWeight;
+    UBaseType_t uxMember = 0U;
+
+    for( pxMember = pxBond->pxBondFirst; pxMember != NULL; pxMember = pxMember->pxBondNext )
+    {
+        if( pxMember->bits.bInterfaceUp != pdFALSE_UNSIGNED )
+        {
+            ulWeight = prvBondWeight( ulFlowHash, uxMember );
+
+            if( ( pxSelected == NULL ) || ( ulWeight > ulBest ) )
+            {
+                pxSelected = pxMember;
+                ulBest = ulWeight;
+            }
+        }
+
+        uxMember++;
+    }
+
+    return pxSelected;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfInitialise() function of a bond interface: it is up as soon
+ *        as one of its members is up. It uses the offloads that all members
+ *        have in common.
+ *
+ * @param[in] pxInterface The bond interface.
+ *
+ * @return pdPASS when a member is up, otherwise pdFAIL.
+ */
+static BaseType_t prvBondInitialise( NetworkInterface_t * pxInterface )
+{
+    const NetworkInterface_t * pxMember;
+    BaseType_t xReturn = pdFAIL;
+
+    pxInterface->bits.bTCPSegmentationOffload = pdTRUE_UNSIGNED;
+    pxInterface->bits.bRxChecksumOffload = pdTRUE_UNSIGNED;
+    pxInterface->bits.bTxChecksumOffload = pdTRUE_UNSIGNED;
+    pxInterface->bits.bScatterGather = pdTRUE_UNSIGNED;
+    pxInterface->bits.bVLANTagOffload = pdTRUE_UNSIGNED;
+
+    for( pxMember = pxInterface->pxBondFirst; pxMember != NULL; pxMember = pxMember->pxBondNext )
+    {
+        if( pxMember->bits.bInterfaceUp != pdFALSE_UNSIGNED )
+        {
+            xReturn = pdPASS;
+        }
+
+        pxInterface->bits.bTCPSegmentationOffload &= pxMember->bits.bTCPSegmentationOffload;
+        pxInterface->bits.bRxChecksumOffload &= pxMember->bits.bRxChecksumOffload;
+        pxInterface->bits.bTxChecksumOffload &= pxMember->bits.bTxChecksumOffload;
+        pxInterface->bits.bScatterGather &= pxMember->bits.bScatterGather;
+        pxInterface->bits.bVLANTagOffload &= pxMember->bits.bVLANTagOffload;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfOutput() function of a bond interface: pass the frame to one
+ *        of the members, chosen by the flow to which the frame belongs.
+ *
+ * @param[in] pxInterface The bond interface.
+ * @param[in] pxNetworkBuffer The frame.
+ * @param[in] xReleaseAfterSend pdTRUE when the frame must be released after sending.
+ *
+ * @return The result of the driver of the member, or pdFAIL when no member is up.
+ */
+static BaseType_t prvBondOutput( NetworkInterface_t * pxInterface,
+                                 NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                 BaseType_t xReleaseAfterSend )
+{
+    NetworkInterface_t * pxMember = prvBondSelectMember( pxInterface, pxNetworkBuffer );
+    BaseType_t xReturn = pdFAIL;
+
+    if( pxMember != NULL )
+    {
+        xReturn = xIPInterfaceOutput( pxMember, pxNetworkBuffer, xReleaseAfterSend );
+    }
+    else if( xReleaseAfterSend != pdFALSE )
+    {
+        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+    }
+    else
+    {
+        /* The caller keeps the frame. */
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfGetPhyLinkStatus() function of a bond interface.
+ *
+ * @param[in] pxInterface The bond interface.
+ *
+ * @return pdTRUE when at least one of the members has a link.
+ */
+static BaseType_t prvBondGetPhyLinkStatus( NetworkInterface_t * pxInterface )
+{
+    NetworkInterface_t * pxMember;
+    BaseType_t xReturn = pdFALSE;
+
+    for( pxMember = pxInterface->pxBondFirst;
+         ( pxMember != NULL ) && ( xReturn == pdFALSE );
+         pxMember = pxMember->pxBondNext )
+    {
+        if( pxMember->pfGetPhyLinkStatus != NULL )
+        {
+            xReturn = pxMember->pfGetPhyLinkStatus( pxMember );
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfAddAllowedMAC() function of a bond interface.
+ *
+ * @param[in] pxInterface The bond interface.
+ * @param[in] pucMacAddressBytes The MAC address to be received by all members.
+ */
+static void prvBondAddAllowedMAC( NetworkInterface_t * pxInterface,
+                                  const uint8_t * pucMacAddressBytes )
+{
+    NetworkInterface_t * pxMember;
+
+    for( pxMember = pxInterface->pxBondFirst; pxMember != NULL; pxMember = pxMember->pxBondNext )
+    {
+        if( pxMember->pfAddAllowedMAC != NULL )
+        {
+            pxMember->pfAddAllowedMAC( pxMember, pucMacAddressBytes );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfRemoveAllowedMAC() function of a bond interface.
+ *
+ * @param[in] pxInterface The bond interface.
+ * @param[in] pucMacAddressBytes The MAC address that is no longer needed.
+ */
+static void prvBondRemoveAllowedMAC( NetworkInterface_t * pxInterface,
+                                     const uint8_t * pucMacAddressBytes )
+{
+    NetworkInterface_t * pxMember;
+
+    for( pxMember = pxInterface->pxBondFirst; pxMember != NULL; pxMember = pxMember->pxBondNext )
+    {
+        if( pxMember->pfRemoveAllowedMAC != NULL )
+        {
+            pxMember->pfRemoveAllowedMAC( pxMember, pucMacAddressBytes );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create a virtual interface that aggregates several physical interfaces.
+ *
+ * @param[in] pxInterface The object that will describe the bond interface.
+ *                        It must be declared static or global.
+ * @param[in] pcName The name of the interface, just for logging.
+ *
+ * @return The bond interface, as returned by FreeRTOS_AddNetworkInterface().
+ */
+NetworkInterface_t * FreeRTOS_FillBondInterface( NetworkInterface_t * pxInterface,
+                                                 const char * pcName )
+{
+    configASSERT( pxInterface != NULL );
+
+    ( void ) memset( pxInterface, 0, sizeof( *pxInterface ) );
+    pxInterface->pcName = pcName;
+    pxInterface->pfInitialise = prvBondInitialise;
+    pxInterface->pfOutput = prvBondOutput;
+    pxInterface->pfGetPhyLinkStatus = prvBondGetPhyLinkStatus;
+    pxInterface->pfAddAllowedMAC = prvBondAddAllowedMAC;
+    pxInterface->pfRemoveAllowedMAC = prvBondRemoveAllowedMAC;
+
+    return FreeRTOS_AddNetworkInterface( pxInterface );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a physical interface to a bond.
+ *
+ * @param[in] pxBond The bond interface, see FreeRTOS_FillBondInterface().
+ * @param[in] pxMember The physical interface, which has been added before
+ *                     and which has no end-points.
+ *
+ * @return pdPASS when the member was added, pdFAIL when it can not be a member.
+ */
+BaseType_t FreeRTOS_AddBondMember( NetworkInterface_t * pxBond,
+                                   NetworkInterface_t * pxMember )
+{
+    NetworkInterface_t ** ppxLast;
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT( pxBond != NULL );
+    configASSERT( pxBond->pfOutput == prvBondOutput );
+
+    if( ( pxMember != NULL ) &&
+        ( pxMember != pxBond ) &&
+        ( pxMember->pxBond == NULL ) &&
+        ( pxMember->pxBondFirst == NULL ) &&
+        ( pxMember->pxEndPoint == NULL ) )
+    {
+        ppxLast = &( pxBond->pxBondFirst );
+
+        while( *ppxLast != NULL )
+        {
+            ppxLast = &( ( *ppxLast )->pxBondNext );
+        }
+
+        pxMember->pxBond = pxBond;
+        pxMember->pxBondNext = NULL;
+        *ppxLast = pxMember;
+
+        #if ( ipconfigUSE_INTERFACE_MTU != 0 )
+        {
+            /* The bond can not send larger frames than its smallest member. */
+            if( ( pxBond->pxBondFirst == pxMember ) ||
+                ( uxInterfaceMTU( pxMember ) < uxInterfaceMTU( pxBond ) ) )
+            {
+                pxBond->uxMTU = pxMember->uxMTU;
+            }
+        }
+        #endif
+
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Assign a frame that was received by a member to its bond.
+ *
+ * @param[in] pxNetworkBuffer The frame, as received by a physical interface.
+ */
+void vBondReceive( NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    NetworkInterface_t * pxBond = pxNetworkBuffer->pxInterface->pxBond;
+
+    if( pxBond != NULL )
+    {
+        pxNetworkBuffer->pxInterface = pxBond;
+
+        if( pxNetworkBuffer->pxEndPoint == NULL )
+        {
+            /* FreeRTOS_MatchingEndpoint() looks at the end-points of the bond. */
+            pxNetworkBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxBond, pxNetworkBuffer->pucEthernetBuffer );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take a bond down when the last of its members went down.
+ *
+ * @param[in] pxMember The interface that went down.
+ */
+void vBondMemberDown( const NetworkInterface_t * pxMember )
+{
+    NetworkInterface_t * pxBond = pxMember->pxBond;
+    const NetworkInterface_t * pxOther;
+    BaseType_t xAnyUp = pdFALSE;
+
+    if( ( pxBond != NULL ) && ( pxBond->bits.bInterfaceUp != pdFALSE_UNSIGNED ) )
+    {
+        for( pxOther = pxBond->pxBondFirst; pxOther != NULL; pxOther = pxOther->pxBondNext )
+        {
+            if( ( pxOther != pxMember ) && ( pxOther->bits.bInterfaceUp != pdFALSE_UNSIGNED ) )
+            {
+                xAnyUp = pdTRUE;
+                break;
+            }
+        }
+
+        if( xAnyUp == pdFALSE )
+        {
+            /* The end-points of the bond go down, they will come up again
+             * once a member is up, see prvBondInitialise(). */
+            FreeRTOS_NetworkDown( pxBond );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* *INDENT-OFF* */
+#endif /* ( ipconfigUSE_LINK_BONDING != 0 ) */
+/* *INDENT-ON* */
@@ -135,6 +135,8 @@
     static void vHandleWaitingAcknowledge( NetworkEndPoint_t * pxEndPoint,
                                            BaseType_t xDoCheck );
 
+    static void prvHandleAcknowledge( NetworkEndPoint_t * pxEndPoint );
+
     static BaseType_t xHandleWaitingFirstDiscover( NetworkEndPoint_t * pxEndPoint );
 
     static void prvHandleWaitingeLeasedAddress( NetworkEndPoint_t * pxEndPoint );
@@ -144,6 +146,13 @@
                                       BaseType_t xExpectedMessageType );
     static BaseType_t xProcessCheckOption( ProcessSet_t * pxSet );
 
+    #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+        static BaseType_t prvStartInitReboot( NetworkEndPoint_t * pxEndPoint );
+
+        static void prvStoreLease( const NetworkEndPoint_t * pxEndPoint,
+                                   BaseType_t xValid );
+    #endif
+
 
 /*-----------------------------------------------------------*/
 
@@ -333,47 +342,60 @@
         {
             if( prvProcessDHCPReplies( dhcpMESSAGE_TYPE_OFFER, pxEndPoint ) == pdPASS )
             {
-                #if ( ipconfigUSE_DHCP_HOOK != 0 )
-                    /* Ask the user if a DHCP request is required. */
-                    #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
-                        eAnswer = xApplicationDHCPHook( eDHCPPhasePreRequest, EP_DHCPData.ulOfferedIPAddress );
-                    #else /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
-                        xIPAddress.ulIP_IPv4 = EP_DHCPData.ulOfferedIPAddress;
-                        eAnswer = xApplicationDHCPHook_Multi( eDHCPPhasePreRequest, pxEndPoint, &xIPAddress );
-                    #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
-
-                    if( eAnswer == eDHCPContinue )
-                #endif /* ipconfigUSE_DHCP_HOOK */
-                {
-                    /* An offer has been made, the user wants to continue,
-                     * generate the request. */
-                    if( prvSendDHCPRequest( pxEndPoint ) == pdPASS )
+                vBringUpEndPointMilestone( pxEndPoint, eBringUpDHCPOffer );
+
+                #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                    if( EP_DHCPData.xRapidCommitAck != pdFALSE )
                     {
-                        EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
-                        EP_DHCPData.xDHCPTxPeriod = dhcpINITIAL_DHCP_TX_PERIOD;
-                        EP_DHCPData.eDHCPState = eWaitingAcknowledge;
+                        /* The server committed the lease at once, there is no
+                         * REQUEST to send. */
+                        prvHandleAcknowledge( pxEndPoint );
                     }
                     else
+                #endif /* ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 ) */
+                {
+                    #if ( ipconfigUSE_DHCP_HOOK != 0 )
+                        /* Ask the user if a DHCP request is required. */
+                        #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
+                            eAnswer = xApplicationDHCPHook( eDHCPPhasePreRequest, EP_DHCPData.ulOfferedIPAddress );
+                        #else /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+                            xIPAddress.ulIP_IPv4 = EP_DHCPData.ulOfferedIPAddress;
+                            eAnswer = xApplicationDHCPHook_Multi( eDHCPPhasePreRequest, pxEndPoint, &xIPAddress );
+                        #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+
+                        if( eAnswer == eDHCPContinue )
+                    #endif /* ipconfigUSE_DHCP_HOOK */
                     {
-                        /* Either the creation of a message buffer failed, or sendto().
-                         * Try again in the next cycle. */
-                        FreeRTOS_debug_printf( ( "Send failed during eWaitingOffer/1.\n" ) );
-                        EP_DHCPData.eDHCPState = eSendDHCPRequest;
+                        /* An offer has been made, the user wants to continue,
+                         * generate the request. */
+                        if( prvSendDHCPRequest( pxEndPoint ) == pdPASS )
+                        {
+                            EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
+                            EP_DHCPData.xDHCPTxPeriod = dhcpINITIAL_DHCP_TX_PERIOD;
+                            EP_DHCPData.eDHCPState = eWaitingAcknowledge;
+                        }
+                        else
+                        {
+                            /* Either the creation of a message buffer failed, or sendto().
+                             * Try again in the next cycle. */
+                            FreeRTOS_debug_printf( ( "Send failed during eWaitingOffer/1.\n" ) );
+                            EP_DHCPData.eDHCPState = eSendDHCPRequest;
+                        }
                     }
-                }
 
-                #if ( ipconfigUSE_DHCP_HOOK != 0 )
-                    else
-                    {
-                        if( eAnswer == eDHCPUseDefaults )
+                    #if ( ipconfigUSE_DHCP_HOOK != 0 )
+                        else
                         {
-                            ( void ) memcpy( &( pxEndPoint->ipv4_settings ), &( pxEndPoint->ipv4_defaults ), sizeof( pxEndPoint->ipv4_settings ) );
-                        }
+                            if( eAnswer == eDHCPUseDefaults )
+                            {
+                                ( void ) memcpy( &( pxEndPoint->ipv4_settings ), &( pxEndPoint->ipv4_defaults ), sizeof( pxEndPoint->ipv4_settings ) );
+                            }
 
-                        /* The user indicates that the DHCP process does not continue. */
-                        xGivingUp = pdTRUE;
-                    }
-                #endif /* ipconfigUSE_DHCP_HOOK */
+                            /* The user indicates that the DHCP process does not continue. */
+                            xGivingUp = pdTRUE;
+                        }
+                    #endif /* ipconfigUSE_DHCP_HOOK */
+                }
             }
         }
 
@@ -449,6 +471,60 @@
     }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief An ACK was received for the IP-address in 'ulOfferedIPAddress'.  Start
+ *        using the address and set the timer to the lease timeout time.
+ * @param[in] pxEndPoint The end-point that got an IP-address from a DHCP server.
+ */
+    static void prvHandleAcknowledge( NetworkEndPoint_t * pxEndPoint )
+    {
+        FreeRTOS_debug_printf( ( "vDHCPProcess: acked %xip\n", ( unsigned int ) FreeRTOS_ntohl( EP_DHCPData.ulOfferedIPAddress ) ) );
+        vBringUpEndPointMilestone( pxEndPoint, eBringUpDHCPAck );
+
+        /* DHCP completed.  The IP address can now be used, and the
+         * timer set to the lease timeout time. */
+        EP_IPv4_SETTINGS.ulIPAddress = EP_DHCPData.ulOfferedIPAddress;
+
+        /* Setting the 'local' broadcast address, something like
+         * '192.168.1.255'. */
+        EP_IPv4_SETTINGS.ulBroadcastAddress = EP_DHCPData.ulOfferedIPAddress | ~( EP_IPv4_SETTINGS.ulNetMask );
+        EP_DHCPData.eDHCPState = eLeasedAddress;
+
+        iptraceDHCP_SUCCEEDED( EP_DHCPData.ulOfferedIPAddress );
+
+        /* DHCP failed, the default configured IP-address will be used
+         * Now call vIPNetworkUpCalls() to send the network-up event and
+         * start the ARP timer. */
+        vIPNetworkUpCalls( pxEndPoint );
+        /* Close socket to ensure packets don't queue on it. */
+        prvCloseDHCPSocket( pxEndPoint );
+
+        if( EP_DHCPData.ulLeaseTime == 0U )
+        {
+            EP_DHCPData.ulLeaseTime = dhcpDEFAULT_LEASE_TIME;
+        }
+        else if( EP_DHCPData.ulLeaseTime < dhcpMINIMUM_LEASE_TIME )
+        {
+            EP_DHCPData.ulLeaseTime = dhcpMINIMUM_LEASE_TIME;
+        }
+        else
+        {
+            /* The lease time is already valid. */
+        }
+
+        #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+        {
+            EP_DHCPData.xInitReboot = pdFALSE;
+            prvStoreLease( pxEndPoint, pdTRUE );
+        }
+        #endif
+
+        /* Check for clashes. */
+        vARPSendGratuitous();
+        vDHCP_RATimerReload( ( struct xNetworkEndPoint * ) pxEndPoint, EP_DHCPData.ulLeaseTime );
+    }
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Called by vDHCPProcessEndPoint(), this function handles the state 'eWaitingAcknowledge'.
  *        If there is a reply, it will be examined, if there is a time-out, there may be a new
@@ -469,6 +545,16 @@
                  * point of giving up - send another request. */
                 EP_DHCPData.xDHCPTxPeriod <<= 1;
 
+                #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+                    if( EP_DHCPData.xInitReboot != pdFALSE )
+                    {
+                        /* The persisted lease was not confirmed in time, do not
+                         * keep on trying but fall back to a normal DISCOVER. */
+                        FreeRTOS_debug_printf( ( "vDHCPProcess: INIT-REBOOT not answered\n" ) );
+                        EP_DHCPData.eDHCPState = eInitialWait;
+                    }
+                    else
+                #endif /* ( ipconfigUSE_DHCP_INIT_REBOOT != 0 ) */
                 if( EP_DHCPData.xDHCPTxPeriod <= ( TickType_t ) ipconfigMAXIMUM_DISCOVER_TX_PERIOD )
                 {
                     EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
@@ -494,42 +580,7 @@
         }
         else if( prvProcessDHCPReplies( dhcpMESSAGE_TYPE_ACK, pxEndPoint ) == pdPASS )
         {
-            FreeRTOS_debug_printf( ( "vDHCPProcess: acked %xip\n", ( unsigned int ) FreeRTOS_ntohl( EP_DHCPData.ulOfferedIPAddress ) ) );
-
-            /* DHCP completed.  The IP address can now be used, and the
-             * timer set to the lease timeout time. */
-            EP_IPv4_SETTINGS.ulIPAddress = EP_DHCPData.ulOfferedIPAddress;
-
-            /* Setting the 'local' broadcast address, something like
-             * '192.168.1.255'. */
-            EP_IPv4_SETTINGS.ulBroadcastAddress = EP_DHCPData.ulOfferedIPAddress | ~( EP_IPv4_SETTINGS.ulNetMask );
-            EP_DHCPData.eDHCPState = eLeasedAddress;
-
-            iptraceDHCP_SUCCEEDED( EP_DHCPData.ulOfferedIPAddress );
-
-            /* DHCP failed, the default configured IP-address will be used
-             * Now call vIPNetworkUpCalls() to send the network-up event and
-             * start the ARP timer. */
-            vIPNetworkUpCalls( pxEndPoint );
-            /* Close socket to ensure packets don't queue on it. */
-            prvCloseDHCPSocket( pxEndPoint );
-
-            if( EP_DHCPData.ulLeaseTime == 0U )
-            {
-                EP_DHCPData.ulLeaseTime = dhcpDEFAULT_LEASE_TIME;
-            }
-            else if( EP_DHCPData.ulLeaseTime < dhcpMINIMUM_LEASE_TIME )
-            {
-                EP_DHCPData.ulLeaseTime = dhcpMINIMUM_LEASE_TIME;
-            }
-            else
-            {
-                /* The lease time is already valid. */
-            }
-
-            /* Check for clashes. */
-            vARPSendGratuitous();
-            vDHCP_RATimerReload( ( struct xNetworkEndPoint * ) pxEndPoint, EP_DHCPData.ulLeaseTime );
+            prvHandleAcknowledge( pxEndPoint );
         }
         else
         {
@@ -571,6 +622,7 @@
             {
                 /* Put 'ulIPAddress' to zero to indicate that the end-point is down. */
                 EP_IPv4_SETTINGS.ulIPAddress = 0U;
+                FreeRTOS_RouteCacheInvalidate();
 
                 /* Send the first discover request. */
                 EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
@@ -675,6 +727,13 @@
         if( xReset != pdFALSE )
         {
             EP_DHCPData.eDHCPState = eInitialWait;
+
+            #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+            {
+                /* A persisted lease may be tried once after every reset. */
+                EP_DHCPData.xInitRebootTried = pdFALSE;
+            }
+            #endif
         }
 
         if( ( EP_DHCPData.eDHCPState != EP_DHCPData.eExpectedState ) && ( xReset == pdFALSE ) )
@@ -706,7 +765,27 @@
                     /* Initial state.  Create the DHCP socket, timer, etc. if they
                      * have not already been created. */
                     prvInitialiseDHCP( pxEndPoint );
-                    EP_DHCPData.eDHCPState = eWaitingSendFirstDiscover;
+
+                    #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+                        if( prvStartInitReboot( pxEndPoint ) != pdFALSE )
+                        {
+                            /* Request the persisted address directly. */
+                            EP_DHCPData.eDHCPState = eSendDHCPRequest;
+                        }
+                        else
+                    #endif
+                    {
+                        EP_DHCPData.eDHCPState = eWaitingSendFirstDiscover;
+                    }
+
+                    #if ( ipconfigUSE_FAST_BRING_UP != 0 )
+                        if( ( xReset != pdFALSE ) && ( EP_DHCPData.eDHCPState == eWaitingSendFirstDiscover ) )
+                        {
+                            /* Do not wait for the first timer period, so that
+                             * all end-points of an interface start together. */
+                            xGivingUp = xHandleWaitingFirstDiscover( pxEndPoint );
+                        }
+                    #endif
                     break;
 
                 case eWaitingSendFirstDiscover:
@@ -961,6 +1040,69 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+
+/**
+ * @brief Ask the application for a persisted lease.  If there is one, and it was
+ *        not tried since the last reset, prepare a REQUEST in the INIT-REBOOT state.
+ *
+ * @param[in] pxEndPoint The end-point that needs an IP-address.
+ *
+ * @return pdTRUE when the persisted address should be requested, pdFALSE when a
+ *         normal DISCOVER must be sent.
+ */
+        static BaseType_t prvStartInitReboot( NetworkEndPoint_t * pxEndPoint )
+        {
+            DHCPLease_t xLease;
+
+            EP_DHCPData.xInitReboot = pdFALSE;
+
+            if( EP_DHCPData.xInitRebootTried == pdFALSE )
+            {
+                EP_DHCPData.xInitRebootTried = pdTRUE;
+                ( void ) memset( &( xLease ), 0, sizeof( xLease ) );
+
+                if( ( xApplicationDHCPLeaseLoad( pxEndPoint, &( xLease ) ) != pdFALSE ) &&
+                    ( xLease.ulIPAddress != 0U ) )
+                {
+                    FreeRTOS_debug_printf( ( "prvStartInitReboot: request %xip\n", ( unsigned ) FreeRTOS_ntohl( xLease.ulIPAddress ) ) );
+                    EP_DHCPData.ulOfferedIPAddress = xLease.ulIPAddress;
+                    EP_DHCPData.xInitReboot = pdTRUE;
+                }
+            }
+
+            return EP_DHCPData.xInitReboot;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Pass the current lease to the application, so it can be requested
+ *        again after a reboot.
+ *
+ * @param[in] pxEndPoint The end-point that got, or lost, its lease.
+ * @param[in] xValid pdTRUE after an ACK, pdFALSE to forget the lease.
+ */
+        static void prvStoreLease( const NetworkEndPoint_t * pxEndPoint,
+                                   BaseType_t xValid )
+        {
+            DHCPLease_t xLease;
+
+            ( void ) memset( &( xLease ), 0, sizeof( xLease ) );
+
+            if( xValid != pdFALSE )
+            {
+                xLease.ulIPAddress = EP_DHCPData.ulOfferedIPAddress;
+                xLease.ulDHCPServerAddress = EP_DHCPData.ulDHCPServerAddress;
+                /* ulLeaseTime holds half of the lease, in ticks. */
+                xLease.ulLeaseTime = ( EP_DHCPData.ulLeaseTime / ( uint32_t ) configTICK_RATE_HZ ) * 2U;
+            }
+
+            vApplicationDHCPLeaseStore( pxEndPoint, &( xLease ) );
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_DHCP_INIT_REBOOT != 0 ) */
+
 /**
  * @brief Called by prvProcessDHCPReplies(), which walks through an array of DHCP options,
  *        this function will check a single option.
@@ -985,12 +1127,32 @@
                      * state machine is expecting. */
                     pxSet->ulProcessed++;
                 }
+
+                #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                    else if( ( xExpectedMessageType == ( BaseType_t ) dhcpMESSAGE_TYPE_OFFER ) &&
+                             ( pxSet->pucByte[ pxSet->uxIndex ] == ( uint8_t ) dhcpMESSAGE_TYPE_ACK ) )
+                    {
+                        /* The DISCOVER was answered with an ACK.  It is only
+                         * valid if the Rapid Commit option is present too. */
+                        pxSet->ulProcessed++;
+                        pxSet->xRapidAck = pdTRUE;
+                    }
+                #endif
                 else
                 {
                     if( pxSet->pucByte[ pxSet->uxIndex ] == ( uint8_t ) dhcpMESSAGE_TYPE_NACK )
                     {
                         if( xExpectedMessageType == ( BaseType_t ) dhcpMESSAGE_TYPE_ACK )
                         {
+                            #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+                                if( EP_DHCPData.xInitReboot != pdFALSE )
+                                {
+                                    /* The persisted address is not valid on this network. */
+                                    EP_DHCPData.xInitReboot = pdFALSE;
+                                    prvStoreLease( pxEndPoint, pdFALSE );
+                                }
+                            #endif
+
                             /* Start again. */
                             EP_DHCPData.eDHCPState = eInitialWait;
                         }
@@ -1081,6 +1243,16 @@
                         pxSet->ulProcessed++;
                         EP_DHCPData.ulDHCPServerAddress = pxSet->ulParameter;
                     }
+
+                    #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+                        else if( EP_DHCPData.xInitReboot != pdFALSE )
+                        {
+                            /* INIT-REBOOT did not name a server, any server may
+                             * confirm the lease. */
+                            pxSet->ulProcessed++;
+                            EP_DHCPData.ulDHCPServerAddress = pxSet->ulParameter;
+                        }
+                    #endif
                     else
                     {
                         /* The ack must come from the expected server. */
@@ -1093,6 +1265,12 @@
 
                 break;
 
+            #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                case dhcpIPv4_RAPID_COMMIT_OPTION_CODE:
+                    pxSet->xRapidCommit = pdTRUE;
+                    break;
+            #endif
+
             case dhcpIPv4_LEASE_TIME_OPTION_CODE:
 
                 if( pxSet->uxLength == sizeof( EP_DHCPData.ulLeaseTime ) )
@@ -1318,6 +1496,14 @@
 
                         if( xResult != 0 )
                         {
+                            #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                                if( ( xResult > 0 ) && ( xSet.ucOptionCode == ( uint8_t ) dhcpIPv4_RAPID_COMMIT_OPTION_CODE ) )
+                                {
+                                    /* Rapid Commit has no value, its zero length
+                                     * does not end the options. */
+                                }
+                                else
+                            #endif
                             if( ( xSet.uxLength == 0U ) || ( xResult < 0 ) )
                             {
                                 break;
@@ -1327,9 +1513,24 @@
                         }
                     }
 
+                    #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                        if( ( xSet.xRapidAck != pdFALSE ) && ( xSet.xRapidCommit == pdFALSE ) )
+                        {
+                            /* RFC 4039: an ACK to a DISCOVER without Rapid Commit
+                             * must be ignored. */
+                            xSet.ulProcessed = 0U;
+                        }
+                    #endif
+
                     /* Were all the mandatory options received? */
                     if( xSet.ulProcessed >= ulMandatoryOptions )
                     {
+                        #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                        {
+                            EP_DHCPData.xRapidCommitAck = xSet.xRapidAck;
+                        }
+                        #endif
+
                         /* HT:endian: used to be network order */
                         EP_DHCPData.ulOfferedIPAddress = pxDHCPMessage->ulYourIPAddress_yiaddr;
                         FreeRTOS_printf( ( "vDHCPProcess: offer %xip for MAC address %02x-%02x\n",
@@ -1501,16 +1702,35 @@
             dhcpIPv4_SERVER_IP_ADDRESS_OPTION_CODE,  4, 0, 0, 0, 0,               /* The IP address of the DHCP server. */
             dhcpOPTION_END_BYTE
         };
+        const uint8_t * pucOptions = ucDHCPRequestOptions;
         size_t uxOptionsLength = sizeof( ucDHCPRequestOptions );
         /* memcpy() helper variables for MISRA Rule 21.15 compliance*/
         const void * pvCopySource;
         void * pvCopyDest;
 
+        #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+            /* In INIT-REBOOT, the server identifier must not be filled in. */
+            static const uint8_t ucDHCPInitRebootOptions[] =
+            {
+                /* Same layout as ucDHCPRequestOptions, without the server. */
+                dhcpIPv4_MESSAGE_TYPE_OPTION_CODE,       1, dhcpMESSAGE_TYPE_REQUEST, /* Message type option. */
+                dhcpIPv4_CLIENT_IDENTIFIER_OPTION_CODE,  7, 1, 0, 0, 0, 0, 0, 0,      /* Client identifier. */
+                dhcpIPv4_REQUEST_IP_ADDRESS_OPTION_CODE, 4, 0, 0, 0, 0,               /* The IP address being requested. */
+                dhcpOPTION_END_BYTE
+            };
+
+            if( EP_DHCPData.xInitReboot != pdFALSE )
+            {
+                pucOptions = ucDHCPInitRebootOptions;
+                uxOptionsLength = sizeof( ucDHCPInitRebootOptions );
+            }
+        #endif /* ( ipconfigUSE_DHCP_INIT_REBOOT != 0 ) */
+
         /* MISRA doesn't like uninitialised structs. */
         ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
         pucUDPPayloadBuffer = prvCreatePartDHCPMessage( &xAddress,
                                                         ( BaseType_t ) dhcpREQUEST_OPCODE,
-                                                        ucDHCPRequestOptions,
+                                                        pucOptions,
                                                         &( uxOptionsLength ),
                                                         pxEndPoint );
 
@@ -1527,10 +1747,13 @@
             pvCopyDest = &pucUDPPayloadBuffer[ dhcpFIRST_OPTION_BYTE_OFFSET + dhcpREQUESTED_IP_ADDRESS_OFFSET ];
             ( void ) memcpy( pvCopyDest, pvCopySource, sizeof( EP_DHCPData.ulOfferedIPAddress ) );
 
-            /* Copy in the address of the DHCP server being used. */
-            pvCopySource = &EP_DHCPData.ulDHCPServerAddress;
-            pvCopyDest = &pucUDPPayloadBuffer[ dhcpFIRST_OPTION_BYTE_OFFSET + dhcpDHCP_SERVER_IP_ADDRESS_OFFSET ];
-            ( void ) memcpy( pvCopyDest, pvCopySource, sizeof( EP_DHCPData.ulDHCPServerAddress ) );
+            if( pucOptions == ucDHCPRequestOptions )
+            {
+                /* Copy in the address of the DHCP server being used. */
+                pvCopySource = &EP_DHCPData.ulDHCPServerAddress;
+                pvCopyDest = &pucUDPPayloadBuffer[ dhcpFIRST_OPTION_BYTE_OFFSET + dhcpDHCP_SERVER_IP_ADDRESS_OFFSET ];
+                ( void ) memcpy( pvCopyDest, pvCopySource, sizeof( EP_DHCPData.ulDHCPServerAddress ) );
+            }
 
             FreeRTOS_debug_printf( ( "vDHCPProcess: reply %xip\n", ( unsigned ) FreeRTOS_ntohl( EP_DHCPData.ulOfferedIPAddress ) ) );
             iptraceSENDING_DHCP_REQUEST();
@@ -1572,6 +1795,9 @@
             dhcpIPv4_CLIENT_IDENTIFIER_OPTION_CODE,  7, 1,                                0,                            0, 0, 0, 0, 0,                    /* Client identifier. */
             dhcpIPv4_REQUEST_IP_ADDRESS_OPTION_CODE, 4, 0,                                0,                            0, 0,                             /* The IP address being requested. */
             dhcpIPv4_PARAMETER_REQUEST_OPTION_CODE,  3, dhcpIPv4_SUBNET_MASK_OPTION_CODE, dhcpIPv4_GATEWAY_OPTION_CODE, dhcpIPv4_DNS_SERVER_OPTIONS_CODE, /* Parameter request option. */
+            #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                dhcpIPv4_RAPID_COMMIT_OPTION_CODE, 0,                                                                                                     /* Rapid commit, RFC 4039. */
+            #endif
             dhcpOPTION_END_BYTE
         };
         size_t uxOptionsLength = sizeof( ucDHCPDiscoverOptions );
@@ -1630,6 +1856,7 @@
             }
             else
             {
+                vBringUpEndPointMilestone( pxEndPoint, eBringUpDHCPRequest );
                 xResult = pdTRUE;
             }
         }
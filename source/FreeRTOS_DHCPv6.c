@@ -492,6 +492,7 @@ static void vDHCPv6ProcessEndPoint_HandleReply( NetworkEndPoint_t * pxEndPoint,
     size_t uxDNSIndex;
 
     FreeRTOS_printf( ( "vDHCPProcess: acked %xip\n", ( unsigned ) FreeRTOS_ntohl( EP_DHCPData.ulOfferedIPAddress ) ) );
+    vBringUpEndPointMilestone( pxEndPoint, eBringUpDHCPAck );
 
     /* DHCP completed.  The IP address can now be used, and the
      * timer set to the lease timeout time. */
@@ -552,6 +553,8 @@ static BaseType_t xDHCPv6ProcessEndPoint_HandleAdvertise( NetworkEndPoint_t * px
         eDHCPCallbackAnswer_t eAnswer;
     #endif /* ( ipconfigUSE_DHCP_HOOK != 0 ) && ( ipconfigIPv4_BACKWARD_COMPATIBLE != 1 ) */
 
+    vBringUpEndPointMilestone( pxEndPoint, eBringUpDHCPOffer );
+
     #if ( ipconfigUSE_DHCP_HOOK != 0 ) && ( ipconfigIPv4_BACKWARD_COMPATIBLE != 1 )
         /* Ask the user if a DHCP request is required. */
         eAnswer = xApplicationDHCPHook_Multi( eDHCPPhasePreRequest, pxEndPoint, &( pxDHCPMessage->xIPAddress ) );
@@ -663,6 +666,15 @@ static BaseType_t xDHCPv6ProcessEndPoint_HandleState( NetworkEndPoint_t * pxEndP
                 xGivingUp = xDHCPv6ProcessEndPoint_HandleAdvertise( pxEndPoint, pxDHCPMessage );
             }
 
+            #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                /* With Rapid Commit, the server may answer the Solicit with a Reply. */
+                else if( ( pxDHCPMessage->uxMessageType == DHCPv6_message_Type_Reply ) &&
+                         ( pxDHCPMessage->ucRapidCommit != 0U ) )
+                {
+                    vDHCPv6ProcessEndPoint_HandleReply( pxEndPoint, pxDHCPMessage );
+                }
+            #endif
+
             /* Is it time to send another Discover? */
             else if( ( xTaskGetTickCount() - EP_DHCPData.xDHCPTxTime ) > EP_DHCPData.xDHCPTxPeriod )
             {
@@ -800,6 +812,15 @@ static void vDHCPv6ProcessEndPoint( BaseType_t xReset,
 
         xGivingUp = xDHCPv6ProcessEndPoint_HandleState( pxEndPoint, pxDHCPMessage );
 
+        #if ( ipconfigUSE_FAST_BRING_UP != 0 )
+            if( ( xReset != pdFALSE ) && ( xGivingUp == pdFALSE ) && ( EP_DHCPData.eDHCPState == eWaitingSendFirstDiscover ) )
+            {
+                /* Send the first SOLICIT without waiting for the first timer
+                 * period, so that all end-points of an interface start together. */
+                xGivingUp = xDHCPv6ProcessEndPoint_HandleState( pxEndPoint, pxDHCPMessage );
+            }
+        #endif
+
         if( xGivingUp != pdFALSE )
         {
             FreeRTOS_debug_printf( ( "vDHCPv6ProcessEndPoint: Giving up\n" ) );
@@ -990,6 +1011,7 @@ static void prvSendDHCPMessage( NetworkEndPoint_t * pxEndPoint )
             {
                 case eWaitingSendFirstDiscover:
                     ucMessageType = DHCPv6_message_Type_Solicit;
+                    vBringUpEndPointMilestone( pxEndPoint, eBringUpDHCPRequest );
                     break;
 
                 case eWaitingOffer:
@@ -1051,6 +1073,15 @@ static void prvSendDHCPMessage( NetworkEndPoint_t * pxEndPoint )
                     vBitConfig_write_16( &( xMessage ), DHCP6_OPTION_REQUEST_DOMAIN_SEARCH_LIST ); /* usOption_2;	00 18 : Domain search list. */
                 }
 
+                #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                    if( EP_DHCPData.eDHCPState == eWaitingSendFirstDiscover )
+                    {
+                        /* DHCPv6_Option_Rapid_Commit */
+                        vBitConfig_write_16( &( xMessage ), DHCPv6_Option_Rapid_Commit ); /* usOption;	Option is 14 */
+                        vBitConfig_write_16( &( xMessage ), 0U );                         /* usLength;	length is 0 */
+                    }
+                #endif
+
                 /* DHCPv6_Option_Elapsed_Time */
                 vBitConfig_write_16( &( xMessage ), DHCPv6_Option_Elapsed_Time );                                        /* usOption;	Option is 8 * / */
                 vBitConfig_write_16( &( xMessage ), 2U );                                                                /* usLength;	length is 2 * / */
@@ -1381,6 +1412,13 @@ static BaseType_t prvDHCPv6_handleOption( struct xNetworkEndPoint * pxEndPoint,
                 ( void ) xBitConfig_read_uc( pxMessage, NULL, pxSet->uxOptionLength );
                 break;
 
+            #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+                case DHCPv6_Option_Rapid_Commit:
+                    pxDHCPMessage->ucRapidCommit = 1U;
+                    ( void ) xBitConfig_read_uc( pxMessage, NULL, pxSet->uxOptionLength );
+                    break;
+            #endif
+
             case DHCPv6_Option_NonTemporaryAddress:
             case DHCPv6_Option_IA_for_Prefix_Delegation:
 
@@ -137,6 +137,76 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
                                       struct freertos_addrinfo ** ppxAddressInfo,
                                       BaseType_t xFamily );
 
+    #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+
+/*
+ * Check if the DNS cache remembers that a name does not resolve.
+ */
+        static BaseType_t prvIsNegativelyCached( const char * pcHostName,
+                                                 BaseType_t xFamily );
+    #endif
+
+    #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+
+/*
+ * Send a question in the background to refresh a popular cached name.
+ */
+        static void prvRefreshCacheEntry( const char * pcHostName,
+                                          BaseType_t xFamily );
+
+/*
+ * Called when a background refresh was answered, or when it timed out.
+ */
+        static void prvOnRefreshDone( const char * pcName,
+                                      void * pvSearchID,
+                                      struct freertos_addrinfo * pxAddressInfo );
+    #endif
+
+    #if ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 )
+
+/*
+ * Send both an A and an AAAA question and collect the answers.
+ */
+        static uint32_t prvGetHostByNameOp_Both( const char * pcHostName,
+                                                 TickType_t uxIdentifier,
+                                                 Socket_t xDNSSocket,
+                                                 struct freertos_addrinfo ** ppxAddressInfo,
+                                                 const struct freertos_sockaddr * pxAddress,
+                                                 NetworkEndPoint_t * pxEndPoint,
+                                                 TickType_t uxReadTimeOut_ticks );
+
+/*
+ * Append the list pxTail to the end of the list in *ppxHead.
+ */
+        static void prvAppendAddressInfo( struct freertos_addrinfo ** ppxHead,
+                                          struct freertos_addrinfo * pxTail );
+
+        #if ( ipconfigUSE_DNS_CACHE == 1 )
+
+/*
+ * Look up both IPv6 and IPv4 addresses of a host in the DNS cache.
+ */
+            static uint32_t prvPrepare_CacheLookupBoth( const char * pcHostName,
+                                                        struct freertos_addrinfo ** ppxAddressInfo );
+        #endif
+    #endif /* ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 ) */
+
+    #if ( ipconfigDNS_PARALLEL_SERVERS > 1 )
+
+/*
+ * Send a question to the fastest DNS servers of an end-point at the same time,
+ * and use the first valid answer.
+ */
+        static uint32_t prvGetHostByNameOp_Parallel( const char * pcHostName,
+                                                     TickType_t uxIdentifier,
+                                                     Socket_t xDNSSocket,
+                                                     struct freertos_addrinfo ** ppxAddressInfo,
+                                                     BaseType_t xFamily,
+                                                     const struct freertos_sockaddr * pxAddress,
+                                                     NetworkEndPoint_t * pxEndPoint,
+                                                     TickType_t uxReadTimeOut_ticks );
+    #endif
+
 /*-----------------------------------------------------------*/
 
 /** @brief This global variable is being used to indicate to the driver which IP type
@@ -383,6 +453,24 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
                     {
                         xFamily = FREERTOS_AF_INET6;
                     }
+
+                    #if ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 )
+                        else if( pxHints->ai_family == FREERTOS_AF_UNSPEC )
+                        {
+                            #if ( ipconfigDNS_USE_CALLBACKS == 1 )
+                                if( pCallback != NULL )
+                                {
+                                    /* An asynchronous look-up can only ask for one type of record. */
+                                    xReturn = -pdFREERTOS_ERRNO_EINVAL;
+                                }
+                                else
+                            #endif
+                            {
+                                /* Ask for both A and AAAA records. */
+                                xFamily = FREERTOS_AF_UNSPEC;
+                            }
+                        }
+                    #endif /* ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 ) */
                     else if( pxHints->ai_family != FREERTOS_AF_INET4 )
                     {
                         xReturn = -pdFREERTOS_ERRNO_EINVAL;
@@ -592,6 +680,9 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
             BaseType_t xReturnSetCallback = pdPASS;
         #endif
 
+        /* Becomes pdTRUE when the name is known not to resolve. */
+        BaseType_t xIsNegative = pdFALSE;
+
         #if ( ipconfigUSE_DNS_CACHE != 0 )
             BaseType_t xLengthOk = pdFALSE;
         #endif
@@ -625,7 +716,21 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
              * and return. */
             #if ( ipconfigINCLUDE_FULL_INET_ADDR == 1 )
             {
-                ulIPAddress = prvPrepare_ReadIPAddress( pcHostName, xFamily, ppxAddressInfo );
+                #if ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 )
+                    if( xFamily == FREERTOS_AF_UNSPEC )
+                    {
+                        ulIPAddress = prvPrepare_ReadIPAddress( pcHostName, FREERTOS_AF_INET4, ppxAddressInfo );
+
+                        if( ulIPAddress == 0U )
+                        {
+                            ulIPAddress = prvPrepare_ReadIPAddress( pcHostName, FREERTOS_AF_INET6, ppxAddressInfo );
+                        }
+                    }
+                    else
+                #endif /* ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 ) */
+                {
+                    ulIPAddress = prvPrepare_ReadIPAddress( pcHostName, xFamily, ppxAddressInfo );
+                }
             }
             #endif /* ipconfigINCLUDE_FULL_INET_ADDR == 1 */
 
@@ -635,7 +740,16 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
                 /* Check the cache before issuing another DNS request. */
                 if( ulIPAddress == 0U )
                 {
-                    ulIPAddress = Prepare_CacheLookup( pcHostName, xFamily, ppxAddressInfo );
+                    #if ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 )
+                        if( xFamily == FREERTOS_AF_UNSPEC )
+                        {
+                            ulIPAddress = prvPrepare_CacheLookupBoth( pcHostName, ppxAddressInfo );
+                        }
+                        else
+                    #endif
+                    {
+                        ulIPAddress = Prepare_CacheLookup( pcHostName, xFamily, ppxAddressInfo );
+                    }
 
                     if( ulIPAddress != 0UL )
                     {
@@ -650,12 +764,28 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
                         {
                             FreeRTOS_printf( ( "prvPrepareLookup: found '%s' in cache: %xip\n", pcHostName, ( unsigned ) ulIPAddress ) );
                         }
+
+                        #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+                        {
+                            /* Refresh the name before it expires, if it is popular. */
+                            prvRefreshCacheEntry( pcHostName, xFamily );
+                        }
+                        #endif
                     }
                 }
             #endif /* ipconfigUSE_DNS_CACHE == 1 */
 
+            #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+                if( ( ulIPAddress == 0U ) && ( prvIsNegativelyCached( pcHostName, xFamily ) != pdFALSE ) )
+                {
+                    /* Do not bother the DNS server again. */
+                    FreeRTOS_printf( ( "prvPrepareLookup: '%s' does not resolve (cached)\n", pcHostName ) );
+                    xIsNegative = pdTRUE;
+                }
+            #endif
+
             /* Generate a unique identifier. */
-            if( ulIPAddress == 0U )
+            if( ( ulIPAddress == 0U ) && ( xIsNegative == pdFALSE ) )
             {
                 uint32_t ulNumber;
 
@@ -670,8 +800,13 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
                 {
                     if( ulIPAddress == 0U )
                     {
+                        if( xIsNegative != pdFALSE )
+                        {
+                            /* The name does not resolve, do the call-back now. */
+                            pCallbackFunction( pcHostName, pvSearchID, NULL );
+                        }
                         /* The user has provided a callback function, so do not block on recvfrom() */
-                        if( xHasRandom != pdFALSE )
+                        else if( xHasRandom != pdFALSE )
                         {
                             uxReadTimeOut_ticks = 0U;
                             xReturnSetCallback = xDNSSetCallBack( pcHostName,
@@ -711,6 +846,105 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+
+/**
+ * @brief Check if the DNS cache remembers that a name does not resolve.
+ * @param[in] pcHostName The name to be looked up.
+ * @param[in] xFamily FREERTOS_AF_INET4, FREERTOS_AF_INET6, or FREERTOS_AF_UNSPEC
+ *                    in which case both types must be known not to resolve.
+ * @return pdTRUE when the name is known not to resolve.
+ */
+        static BaseType_t prvIsNegativelyCached( const char * pcHostName,
+                                                 BaseType_t xFamily )
+        {
+            BaseType_t xReturn = pdTRUE;
+
+            if( ( xFamily != FREERTOS_AF_INET6 ) && ( xDNSNegativeCacheLookup( pcHostName, pdFALSE ) == pdFALSE ) )
+            {
+                xReturn = pdFALSE;
+            }
+
+            if( ( xFamily != FREERTOS_AF_INET4 ) && ( xDNSNegativeCacheLookup( pcHostName, pdTRUE ) == pdFALSE ) )
+            {
+                xReturn = pdFALSE;
+            }
+
+            return xReturn;
+        }
+    #endif /* ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 ) */
+    /*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+
+/**
+ * @brief Called when a background refresh was answered, or when it timed out.
+ *        An answer has already been stored in the DNS cache by the parser.
+ *
+ * @param[in] pcName The name that was refreshed.
+ * @param[in] pvSearchID Not used.
+ * @param[in] pxAddressInfo The addresses found, or NULL after a timeout.
+ */
+        static void prvOnRefreshDone( const char * pcName,
+                                      void * pvSearchID,
+                                      struct freertos_addrinfo * pxAddressInfo )
+        {
+            ( void ) pcName;
+            ( void ) pvSearchID;
+            ( void ) pxAddressInfo;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Send a question in the background for a popular name that is about
+ *        to expire, or that has expired but is still used. The answer is
+ *        handled asynchronously, like for FreeRTOS_gethostbyname_a().
+ *
+ * @param[in] pcHostName The name that was found in the DNS cache.
+ * @param[in] xFamily FREERTOS_AF_INET4, FREERTOS_AF_INET6, or FREERTOS_AF_UNSPEC
+ *                    to check both the A and the AAAA entry.
+ */
+        static void prvRefreshCacheEntry( const char * pcHostName,
+                                          BaseType_t xFamily )
+        {
+            BaseType_t xIndex;
+
+            for( xIndex = 0; xIndex < 2; xIndex++ )
+            {
+                BaseType_t xIsIPv6 = ( xIndex == 0 ) ? pdFALSE : pdTRUE;
+                BaseType_t xOneFamily = ( xIsIPv6 != pdFALSE ) ? FREERTOS_AF_INET6 : FREERTOS_AF_INET4;
+                uint32_t ulNumber;
+
+                if( ( ( xFamily == FREERTOS_AF_UNSPEC ) || ( xFamily == xOneFamily ) ) &&
+                    ( xDNSCacheClaimRefresh( pcHostName, xIsIPv6 ) != pdFALSE ) &&
+                    ( xApplicationGetRandomNumber( &( ulNumber ) ) != pdFALSE ) )
+                {
+                    /* DNS identifiers are 16-bit. */
+                    TickType_t uxIdentifier = ( TickType_t ) ( ulNumber & 0xffffU );
+
+                    if( xDNSSetCallBack( pcHostName,
+                                         NULL,
+                                         prvOnRefreshDone,
+                                         ( TickType_t ) ( dnsCACHE_REFRESH_TIMEOUT_SECONDS * 1000U ),
+                                         uxIdentifier,
+                                         xIsIPv6 ) == pdPASS )
+                    {
+                        struct freertos_addrinfo * pxAddressInfo = NULL;
+
+                        FreeRTOS_printf( ( "prvRefreshCacheEntry: refreshing '%s'\n", pcHostName ) );
+                        ( void ) prvGetHostByName( pcHostName, uxIdentifier, 0U, &( pxAddressInfo ), xOneFamily );
+
+                        if( pxAddressInfo != NULL )
+                        {
+                            FreeRTOS_freeaddrinfo( pxAddressInfo );
+                        }
+                    }
+                }
+            }
+        }
+    #endif /* ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 ) */
+    /*-----------------------------------------------------------*/
+
     #if ( ipconfigUSE_IPv6 != 0 )
 
 /**
@@ -1264,6 +1498,35 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
                     }
                 }
 
+                #if ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 )
+                    if( xFamily == FREERTOS_AF_UNSPEC )
+                    {
+                        ulIPAddress = prvGetHostByNameOp_Both( pcHostName,
+                                                               uxIdentifier,
+                                                               xDNSSocket,
+                                                               ppxAddressInfo,
+                                                               &( xAddress ),
+                                                               pxEndPoint,
+                                                               uxReadTimeOut_ticks );
+                        break;
+                    }
+                #endif /* ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 ) */
+
+                #if ( ipconfigDNS_PARALLEL_SERVERS > 1 )
+                    if( ( uxReadTimeOut_ticks > 0U ) && ( xAddress.sin_port == dnsDNS_PORT ) )
+                    {
+                        ulIPAddress = prvGetHostByNameOp_Parallel( pcHostName,
+                                                                   uxIdentifier,
+                                                                   xDNSSocket,
+                                                                   ppxAddressInfo,
+                                                                   xFamily,
+                                                                   &( xAddress ),
+                                                                   pxEndPoint,
+                                                                   uxReadTimeOut_ticks );
+                        break;
+                    }
+                #endif /* ( ipconfigDNS_PARALLEL_SERVERS > 1 ) */
+
                 xReturn = prvSendBuffer( pcHostName,
                                          uxIdentifier,
                                          xDNSSocket,
@@ -1374,127 +1637,661 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
             { /* ip found, no need to retry */
                 break;
             }
+
+            #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+                if( prvIsNegativelyCached( pcHostName, xFamily ) != pdFALSE )
+                {
+                    /* The server said that the name does not exist, no need to retry. */
+                    break;
+                }
+            #endif
         }
 
         return ulIPAddress;
     }
+/*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 )
 
 /**
- * @brief Prepare and send a message to a DNS server.  'uxReadTimeOut_ticks' will be passed as
- *        zero, in case the user has supplied a call-back function.
- *
- * @param[in] pcHostName The hostname for which an IP address is required.
- * @param[in] uxIdentifier Identifier to match sent and received packets
- * @param[in] uxReadTimeOut_ticks The timeout in ticks for waiting. In case the user has supplied
- *                                 a call-back function, this value should be zero.
- * @param[in,out] ppxAddressInfo A pointer to a pointer where the find results
- *                will be stored.
- * @param[in] xFamily Either FREERTOS_AF_INET4 or FREERTOS_AF_INET6.
- * @return The IPv4 IP address for the hostname being queried. It will be zero if there is no reply.
+ * @brief Append a list of addresses to the end of another list.
+ * @param[in,out] ppxHead The list that will be extended, may point to NULL.
+ * @param[in] pxTail The list that will be appended, may be NULL.
  */
-    static uint32_t prvGetHostByName( const char * pcHostName,
-                                      TickType_t uxIdentifier,
-                                      TickType_t uxReadTimeOut_ticks,
-                                      struct freertos_addrinfo ** ppxAddressInfo,
-                                      BaseType_t xFamily )
-    {
-        Socket_t xDNSSocket;
-        uint32_t ulIPAddress = 0U;
+        static void prvAppendAddressInfo( struct freertos_addrinfo ** ppxHead,
+                                          struct freertos_addrinfo * pxTail )
+        {
+            struct freertos_addrinfo ** ppxLast = ppxHead;
 
+            while( *( ppxLast ) != NULL )
+            {
+                ppxLast = &( ( *( ppxLast ) )->ai_next );
+            }
 
-        xDNSSocket = DNS_CreateSocket( uxReadTimeOut_ticks );
+            *( ppxLast ) = pxTail;
+        }
+/*-----------------------------------------------------------*/
 
-        if( xDNSSocket != NULL )
+/**
+ * @brief Send an AAAA and an A question at the same time, and collect the answers.
+ *        The AAAA question uses the identifier 'uxIdentifier + 1'. Once the first
+ *        answer has arrived, the other one is waited for during at most the
+ *        "Resolution Delay" of RFC 8305.
+ * @param[in] pcHostName The hostname to be looked up.
+ * @param[in] uxIdentifier Identifier of the A question.
+ * @param[in] xDNSSocket A bound socket.
+ * @param[in,out] ppxAddressInfo A pointer to a pointer where the find results
+ *                will be stored: the IPv6 addresses first.
+ * @param[in] pxAddress The address of the DNS server.
+ * @param[in] pxEndPoint The end-point that owns the DNS server address.
+ * @param[in] uxReadTimeOut_ticks The time to wait for the first answer.
+ * @return An IPv4 address, or 1 if only IPv6 addresses were found, or zero
+ *         when no answer was received.
+ */
+        static uint32_t prvGetHostByNameOp_Both( const char * pcHostName,
+                                                 TickType_t uxIdentifier,
+                                                 Socket_t xDNSSocket,
+                                                 struct freertos_addrinfo ** ppxAddressInfo,
+                                                 const struct freertos_sockaddr * pxAddress,
+                                                 NetworkEndPoint_t * pxEndPoint,
+                                                 TickType_t uxReadTimeOut_ticks )
         {
-            if( uxReadTimeOut_ticks == 0U )
+            uint32_t ulIPAddress = 0U;
+            uint32_t ulResult;
+            TickType_t uxIdentifier6 = ( uxIdentifier + 1U ) & 0xffffU;
+            TickType_t uxResolutionDelay = pdMS_TO_TICKS( 50U );
+            struct freertos_addrinfo * pxList6 = NULL;
+            struct freertos_addrinfo * pxList4 = NULL;
+            struct freertos_addrinfo * pxNew;
+            struct freertos_sockaddr xRecvAddress;
+            DNSBuffer_t xReceiveBuffer;
+            BaseType_t xQuestions = 0;
+            BaseType_t xReplies;
+            BaseType_t xBytes;
+
+            if( prvSendBuffer( pcHostName, uxIdentifier6, xDNSSocket, FREERTOS_AF_INET6, pxAddress ) != pdFAIL )
             {
-                /* xRetryIndex is negative to tell that the socket is non-blocking. */
-                ulIPAddress = prvGetHostByNameOp( pcHostName,
-                                                  uxIdentifier,
-                                                  xDNSSocket,
-                                                  ppxAddressInfo,
-                                                  xFamily,
-                                                  uxReadTimeOut_ticks );
+                xQuestions++;
             }
-            else
+
+            if( prvSendBuffer( pcHostName, uxIdentifier, xDNSSocket, FREERTOS_AF_INET4, pxAddress ) != pdFAIL )
             {
-                ulIPAddress = prvGetHostByNameOp_WithRetry( pcHostName,
-                                                            uxIdentifier,
-                                                            xDNSSocket,
-                                                            ppxAddressInfo,
-                                                            xFamily,
-                                                            uxReadTimeOut_ticks );
+                xQuestions++;
             }
 
-            /* Finished with the socket. */
-            DNS_CloseSocket( xDNSSocket );
-        }
+            if( uxResolutionDelay == 0U )
+            {
+                uxResolutionDelay = 1U;
+            }
 
-        return ulIPAddress;
-    }
-    /*-----------------------------------------------------------*/
+            for( xReplies = 0; xReplies < xQuestions; xReplies++ )
+            {
+                ( void ) memset( &( xReceiveBuffer ), 0, sizeof( xReceiveBuffer ) );
+                xBytes = DNS_ReadReply( xDNSSocket, &xRecvAddress, &xReceiveBuffer );
 
-/**
- * @brief Create the DNS message in the zero copy buffer passed in the first parameter.
- * @param[in,out] pucUDPPayloadBuffer The zero copy buffer where the DNS message will be created.
- * @param[in] pcHostName Hostname to be looked up.
- * @param[in] uxIdentifier Identifier to match sent and received packets
- * @param[in] uxHostType dnsTYPE_A_HOST ( IPv4 ) or dnsTYPE_AAAA_HOST ( IPv6 ).
- * @return Total size of the generated message, which is the space from the last written byte
- *         to the beginning of the buffer.
- */
-    static size_t prvCreateDNSMessage( uint8_t * pucUDPPayloadBuffer,
-                                       const char * pcHostName,
-                                       TickType_t uxIdentifier,
-                                       UBaseType_t uxHostType )
-    {
-        DNSMessage_t * pxDNSMessageHeader;
-        size_t uxStart, uxIndex;
-        DNSTail_t const * pxTail;
-        static const DNSMessage_t xDefaultPartDNSHeader =
-        {
-            0,                 /* The identifier will be overwritten. */
-            dnsOUTGOING_FLAGS, /* Flags set for standard query. */
-            dnsONE_QUESTION,   /* One question is being asked. */
-            0,                 /* No replies are included. */
-            0,                 /* No authorities. */
-            0                  /* No additional authorities. */
-        };
+                if( ( xReplies == 0 ) && ( ( xBytes == -pdFREERTOS_ERRNO_EWOULDBLOCK ) || ( xBytes == 0 ) ) )
+                {
+                    /* Neither question was answered, next time try with a different DNS. */
+                    if( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
+                    {
+                        prvIncreaseDNS6Index( pxEndPoint );
+                    }
+                    else
+                    {
+                        prvIncreaseDNS4Index( pxEndPoint );
+                    }
+                }
 
-        /* memcpy() helper variables for MISRA Rule 21.15 compliance*/
-        const void * pvCopySource;
-        void * pvCopyDest;
+                if( xReceiveBuffer.pucPayloadBuffer != NULL )
+                {
+                    if( xBytes > 0 )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        const DNSMessage_t * pxDNSMessageHeader = ( const DNSMessage_t * ) xReceiveBuffer.pucPayloadBuffer;
+                        TickType_t uxExpected = uxIdentifier;
 
-        ( void ) uxHostType;
+                        if( ( TickType_t ) pxDNSMessageHeader->usIdentifier == uxIdentifier6 )
+                        {
+                            uxExpected = uxIdentifier6;
+                        }
 
-        /* Copy in the const part of the header. Intentionally using different
-         * pointers with memcpy() to put the information in to correct place. */
+                        xReceiveBuffer.uxPayloadLength = ( size_t ) xBytes;
+                        pxNew = NULL;
 
-        /*
-         * Use helper variables for memcpy() to remain
-         * compliant with MISRA Rule 21.15.  These should be
-         * optimized away.
-         */
-        pvCopySource = &xDefaultPartDNSHeader;
-        pvCopyDest = pucUDPPayloadBuffer;
-        ( void ) memcpy( pvCopyDest, pvCopySource, sizeof( xDefaultPartDNSHeader ) );
+                        /* MISRA Ref 4.14.2 [The validity of values received from external sources]. */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-414. */
+                        /* coverity[misra_c_2012_directive_4_14_violation] */
+                        ulResult = prvDNSReply( &xReceiveBuffer, &( pxNew ), uxExpected, xRecvAddress.sin_port );
 
-        /* Write in a unique identifier. Cast the Payload Buffer to DNSMessage_t
-         * to easily access fields of the DNS Message. */
+                        if( ( ulResult != 0U ) && ( ( ulIPAddress == 0U ) || ( ulIPAddress == 1U ) ) )
+                        {
+                            /* Prefer to return an IPv4 address over the IPv6 indicator. */
+                            ulIPAddress = ulResult;
+                        }
 
-        /* MISRA Ref 11.3.1 [Misaligned access] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-        /* coverity[misra_c_2012_rule_11_3_violation] */
-        pxDNSMessageHeader = ( ( DNSMessage_t * ) pucUDPPayloadBuffer );
-        pxDNSMessageHeader->usIdentifier = ( uint16_t ) uxIdentifier;
+                        if( pxNew != NULL )
+                        {
+                            if( pxNew->ai_family == FREERTOS_AF_INET6 )
+                            {
+                                prvAppendAddressInfo( &( pxList6 ), pxNew );
+                            }
+                            else
+                            {
+                                prvAppendAddressInfo( &( pxList4 ), pxNew );
+                            }
+                        }
+                    }
 
-        /* Create the resource record at the end of the header.  First
-         * find the end of the header. */
-        uxStart = sizeof( xDefaultPartDNSHeader );
+                    FreeRTOS_ReleaseUDPPayloadBuffer( xReceiveBuffer.pucPayloadBuffer );
+                }
 
-        /* Leave a gap for the first length byte. */
-        uxIndex = uxStart + 1U;
+                if( xBytes <= 0 )
+                {
+                    break;
+                }
+
+                if( xReplies == 0 )
+                {
+                    /* Wait shortly for the other answer. */
+                    ( void ) FreeRTOS_setsockopt( xDNSSocket, 0, FREERTOS_SO_RCVTIMEO, &( uxResolutionDelay ), sizeof( TickType_t ) );
+                }
+            }
+
+            if( xReplies > 0 )
+            {
+                /* The socket may be used for a retry. */
+                ( void ) FreeRTOS_setsockopt( xDNSSocket, 0, FREERTOS_SO_RCVTIMEO, &( uxReadTimeOut_ticks ), sizeof( TickType_t ) );
+            }
+
+            prvAppendAddressInfo( &( pxList6 ), pxList4 );
+
+            if( ppxAddressInfo != NULL )
+            {
+                *( ppxAddressInfo ) = pxList6;
+            }
+            else if( pxList6 != NULL )
+            {
+                FreeRTOS_freeaddrinfo( pxList6 );
+            }
+            else
+            {
+                /* No addresses were found. */
+            }
+
+            return ulIPAddress;
+        }
+/*-----------------------------------------------------------*/
+
+        #if ( ipconfigUSE_DNS_CACHE == 1 )
+
+/**
+ * @brief Look up both the IPv6 and the IPv4 addresses of a host in the DNS cache.
+ * @param[in] pcHostName The hostname to be looked up.
+ * @param[in,out] ppxAddressInfo A pointer to a pointer where the find results
+ *                will be stored: the IPv6 addresses first.
+ * @return An IPv4 address, or 1 if only IPv6 addresses were found, or zero
+ *         when the name is not cached.
+ */
+            static uint32_t prvPrepare_CacheLookupBoth( const char * pcHostName,
+                                                        struct freertos_addrinfo ** ppxAddressInfo )
+            {
+                struct freertos_addrinfo * pxList6 = NULL;
+                struct freertos_addrinfo * pxList4 = NULL;
+                uint32_t ulIPAddress;
+                uint32_t ulFound6;
+
+                ulFound6 = Prepare_CacheLookup( pcHostName, FREERTOS_AF_INET6, &( pxList6 ) );
+                ulIPAddress = Prepare_CacheLookup( pcHostName, FREERTOS_AF_INET4, &( pxList4 ) );
+
+                if( ulIPAddress == 0U )
+                {
+                    ulIPAddress = ulFound6;
+                }
+
+                prvAppendAddressInfo( &( pxList6 ), pxList4 );
+
+                if( ppxAddressInfo != NULL )
+                {
+                    *( ppxAddressInfo ) = pxList6;
+                }
+                else if( pxList6 != NULL )
+                {
+                    FreeRTOS_freeaddrinfo( pxList6 );
+                }
+                else
+                {
+                    /* The name is not cached. */
+                }
+
+                return ulIPAddress;
+            }
+        #endif /* ( ipconfigUSE_DNS_CACHE == 1 ) */
+    #endif /* ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigDNS_PARALLEL_SERVERS > 1 )
+
+/**
+ * @brief Get the round-trip times and the number of a DNS server of an end-point.
+ * @param[in] pxEndPoint The end-point.
+ * @param[in] ucFamily FREERTOS_AF_INET or FREERTOS_AF_INET6.
+ * @param[in] uxIndex The index of the DNS server.
+ * @param[out] pxAddress When not NULL, the address of the server is written here.
+ * @param[out] ppulRTT The round-trip time field of the server.
+ * @return pdTRUE when the server address is in use.
+ */
+        static BaseType_t prvDNSServerAt( NetworkEndPoint_t * pxEndPoint,
+                                          uint8_t ucFamily,
+                                          size_t uxIndex,
+                                          struct freertos_sockaddr * pxAddress,
+                                          uint32_t ** ppulRTT )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( ucFamily == ( uint8_t ) FREERTOS_AF_INET6 )
+                {
+                    const uint8_t * pucBytes = pxEndPoint->ipv6_settings.xDNSServerAddresses[ uxIndex ].ucBytes;
+
+                    /* The same test as in prvFillSockAddress(). */
+                    if( ( pucBytes[ 0 ] != 0U ) && ( pucBytes[ 1 ] != 0U ) )
+                    {
+                        if( pxAddress != NULL )
+                        {
+                            ( void ) memcpy( pxAddress->sin_address.xIP_IPv6.ucBytes, pucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                        }
+
+                        xReturn = pdTRUE;
+                    }
+
+                    *( ppulRTT ) = &( pxEndPoint->ipv6_settings.ulDNSServerRTT[ uxIndex ] );
+                }
+                else
+            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                {
+                    uint32_t ulIPAddress = pxEndPoint->ipv4_settings.ulDNSServerAddresses[ uxIndex ];
+
+                    if( ( ulIPAddress != 0U ) && ( ulIPAddress != ipBROADCAST_IP_ADDRESS ) )
+                    {
+                        if( pxAddress != NULL )
+                        {
+                            pxAddress->sin_address.ulIP_IPv4 = ulIPAddress;
+                        }
+
+                        xReturn = pdTRUE;
+                    }
+
+                    *( ppulRTT ) = &( pxEndPoint->ipv4_settings.ulDNSServerRTT[ uxIndex ] );
+                }
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send a question to the fastest DNS servers of an end-point at the same
+ *        time, at most ipconfigDNS_PARALLEL_SERVERS of them. The first valid
+ *        answer is used, and the round-trip time of the server that gave it
+ *        is updated.
+ * @param[in] pcHostName The hostname to be looked up.
+ * @param[in] uxIdentifier Identifier of the question, the same for all servers.
+ * @param[in] xDNSSocket A bound socket.
+ * @param[in,out] ppxAddressInfo A pointer to a pointer where the find results
+ *                will be stored.
+ * @param[in] xFamily Either FREERTOS_AF_INET4 or FREERTOS_AF_INET6.
+ * @param[in] pxAddress The address as filled in by prvFillSockAddress().
+ * @param[in] pxEndPoint The end-point that owns the DNS server addresses.
+ * @param[in] uxReadTimeOut_ticks The time to wait for an answer.
+ * @return The IP address found, or zero when there was no valid answer.
+ */
+        static uint32_t prvGetHostByNameOp_Parallel( const char * pcHostName,
+                                                     TickType_t uxIdentifier,
+                                                     Socket_t xDNSSocket,
+                                                     struct freertos_addrinfo ** ppxAddressInfo,
+                                                     BaseType_t xFamily,
+                                                     const struct freertos_sockaddr * pxAddress,
+                                                     NetworkEndPoint_t * pxEndPoint,
+                                                     TickType_t uxReadTimeOut_ticks )
+        {
+            uint32_t ulIPAddress = 0U;
+            uint8_t ucServers[ ipconfigENDPOINT_DNS_ADDRESS_COUNT ];
+            uint8_t ucAsked[ ipconfigENDPOINT_DNS_ADDRESS_COUNT ];
+            struct freertos_sockaddr xServer;
+            struct freertos_sockaddr xRecvAddress;
+            DNSBuffer_t xReceiveBuffer;
+            uint32_t * pulRTT;
+            uint32_t * pulOtherRTT;
+            TickType_t uxSentTime;
+            size_t uxServers = 0U;
+            size_t uxAsked = 0U;
+            size_t uxIndex;
+            size_t uxPosition;
+            BaseType_t xReplies;
+            BaseType_t xBytes;
+
+            /* Make a list of the servers in use, sorted on their round-trip time.
+             * A stable insertion sort, so equal servers keep their order. */
+            for( uxIndex = 0U; uxIndex < ( size_t ) ipconfigENDPOINT_DNS_ADDRESS_COUNT; uxIndex++ )
+            {
+                if( prvDNSServerAt( pxEndPoint, pxAddress->sin_family, uxIndex, NULL, &( pulRTT ) ) != pdFALSE )
+                {
+                    for( uxPosition = uxServers; uxPosition > 0U; uxPosition-- )
+                    {
+                        ( void ) prvDNSServerAt( pxEndPoint, pxAddress->sin_family, ucServers[ uxPosition - 1U ], NULL, &( pulOtherRTT ) );
+
+                        if( *( pulOtherRTT ) <= *( pulRTT ) )
+                        {
+                            break;
+                        }
+
+                        ucServers[ uxPosition ] = ucServers[ uxPosition - 1U ];
+                    }
+
+                    ucServers[ uxPosition ] = ( uint8_t ) uxIndex;
+                    uxServers++;
+                }
+            }
+
+            uxSentTime = xTaskGetTickCount();
+
+            for( uxIndex = 0U; ( uxIndex < uxServers ) && ( uxAsked < ( size_t ) ipconfigDNS_PARALLEL_SERVERS ); uxIndex++ )
+            {
+                ( void ) memcpy( &( xServer ), pxAddress, sizeof( xServer ) );
+                ( void ) prvDNSServerAt( pxEndPoint, pxAddress->sin_family, ucServers[ uxIndex ], &( xServer ), &( pulRTT ) );
+
+                if( prvSendBuffer( pcHostName, uxIdentifier, xDNSSocket, xFamily, &( xServer ) ) != pdFAIL )
+                {
+                    ucAsked[ uxAsked ] = ucServers[ uxIndex ];
+                    uxAsked++;
+                }
+            }
+
+            for( xReplies = 0; xReplies < ( BaseType_t ) uxAsked; xReplies++ )
+            {
+                struct freertos_addrinfo * pxNew = NULL;
+                uint32_t ulResult = 0U;
+
+                ( void ) memset( &( xReceiveBuffer ), 0, sizeof( xReceiveBuffer ) );
+                xBytes = DNS_ReadReply( xDNSSocket, &( xRecvAddress ), &( xReceiveBuffer ) );
+
+                if( xReceiveBuffer.pucPayloadBuffer != NULL )
+                {
+                    if( xBytes > 0 )
+                    {
+                        xReceiveBuffer.uxPayloadLength = ( size_t ) xBytes;
+
+                        /* MISRA Ref 4.14.2 [The validity of values received from external sources]. */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-414. */
+                        /* coverity[misra_c_2012_directive_4_14_violation] */
+                        ulResult = prvDNSReply( &xReceiveBuffer, &( pxNew ), uxIdentifier, xRecvAddress.sin_port );
+                    }
+
+                    FreeRTOS_ReleaseUDPPayloadBuffer( xReceiveBuffer.pucPayloadBuffer );
+                }
+
+                if( xBytes <= 0 )
+                {
+                    break;
+                }
+
+                /* Find out which server has answered, and update its round-trip time. */
+                for( uxIndex = 0U; uxIndex < uxAsked; uxIndex++ )
+                {
+                    BaseType_t xSameServer;
+
+                    ( void ) prvDNSServerAt( pxEndPoint, pxAddress->sin_family, ucAsked[ uxIndex ], &( xServer ), &( pulRTT ) );
+
+                    #if ( ipconfigUSE_IPv6 != 0 )
+                        if( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
+                        {
+                            xSameServer = ( memcmp( xServer.sin_address.xIP_IPv6.ucBytes, xRecvAddress.sin_address.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) ? pdTRUE : pdFALSE;
+                        }
+                        else
+                    #endif
+                    {
+                        xSameServer = ( xServer.sin_address.ulIP_IPv4 == xRecvAddress.sin_address.ulIP_IPv4 ) ? pdTRUE : pdFALSE;
+                    }
+
+                    if( xSameServer != pdFALSE )
+                    {
+                        uint32_t ulRTT = ( uint32_t ) ( ( xTaskGetTickCount() - uxSentTime ) * portTICK_PERIOD_MS ) + 1U;
+
+                        /* Smooth with a factor 1/8, like the TCP round-trip time. */
+                        if( *( pulRTT ) == 0U )
+                        {
+                            *( pulRTT ) = ulRTT;
+                        }
+                        else
+                        {
+                            *( pulRTT ) = ( ( 7U * *( pulRTT ) ) + ulRTT ) / 8U;
+                        }
+
+                        if( ulResult != 0U )
+                        {
+                            /* Also a look-up with a single server should use this one. */
+                            if( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
+                            {
+                                #if ( ipconfigUSE_IPv6 != 0 )
+                                    pxEndPoint->ipv6_settings.ucDNSIndex = ucAsked[ uxIndex ];
+                                #endif
+                            }
+                            else
+                            {
+                                #if ( ipconfigUSE_IPv4 != 0 )
+                                    pxEndPoint->ipv4_settings.ucDNSIndex = ucAsked[ uxIndex ];
+                                #endif
+                            }
+                        }
+
+                        break;
+                    }
+                }
+
+                if( ulResult != 0U )
+                {
+                    ulIPAddress = ulResult;
+
+                    if( ppxAddressInfo != NULL )
+                    {
+                        *( ppxAddressInfo ) = pxNew;
+                        pxNew = NULL;
+                    }
+                }
+
+                if( pxNew != NULL )
+                {
+                    FreeRTOS_freeaddrinfo( pxNew );
+                }
+
+                if( ulIPAddress != 0U )
+                {
+                    break;
+                }
+            }
+
+            if( xReplies == 0 )
+            {
+                /* No server answered at all, move them to the end of the list. */
+                uint32_t ulTimeout = ( uint32_t ) ( uxReadTimeOut_ticks * portTICK_PERIOD_MS ) + 1U;
+
+                for( uxIndex = 0U; uxIndex < uxAsked; uxIndex++ )
+                {
+                    ( void ) prvDNSServerAt( pxEndPoint, pxAddress->sin_family, ucAsked[ uxIndex ], NULL, &( pulRTT ) );
+
+                    if( *( pulRTT ) < ulTimeout )
+                    {
+                        *( pulRTT ) = ulTimeout;
+                    }
+                }
+            }
+
+            return ulIPAddress;
+        }
+    #endif /* ( ipconfigDNS_PARALLEL_SERVERS > 1 ) */
+/*-----------------------------------------------------------*/
+
+
+/**
+ * @brief Prepare and send a message to a DNS server.  'uxReadTimeOut_ticks' will be passed as
+ *        zero, in case the user has supplied a call-back function.
+ *
+ * @param[in] pcHostName The hostname for which an IP address is required.
+ * @param[in] uxIdentifier Identifier to match sent and received packets
+ * @param[in] uxReadTimeOut_ticks The timeout in ticks for waiting. In case the user has supplied
+ *                                 a call-back function, this value should be zero.
+ * @param[in,out] ppxAddressInfo A pointer to a pointer where the find results
+ *                will be stored.
+ * @param[in] xFamily Either FREERTOS_AF_INET4 or FREERTOS_AF_INET6.
+ * @return The IPv4 IP address for the hostname being queried. It will be zero if there is no reply.
+ */
+    static uint32_t prvGetHostByName( const char * pcHostName,
+                                      TickType_t uxIdentifier,
+                                      TickType_t uxReadTimeOut_ticks,
+                                      struct freertos_addrinfo ** ppxAddressInfo,
+                                      BaseType_t xFamily )
+    {
+        Socket_t xDNSSocket = NULL;
+        uint32_t ulIPAddress = 0U;
+        BaseType_t xIsShared = pdFALSE;
+
+        #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+        {
+            const char * pcDot = strchr( pcHostName, ( int32_t ) '.' );
+
+            /* Asynchronous look-ups of public names share one socket.
+             * mDNS and LLMNR look-ups keep using a socket of their own. */
+            if( ( uxReadTimeOut_ticks == 0U ) && ( pcDot != NULL ) && ( strcmp( pcDot, ".local" ) != 0 ) )
+            {
+                xDNSSocket = DNS_GetSharedSocket();
+
+                if( xDNSSocket != NULL )
+                {
+                    xIsShared = pdTRUE;
+                }
+            }
+        }
+        #endif /* ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 ) */
+
+        if( xDNSSocket == NULL )
+        {
+            xDNSSocket = DNS_CreateSocket( uxReadTimeOut_ticks );
+        }
+
+        if( xDNSSocket != NULL )
+        {
+            if( uxReadTimeOut_ticks == 0U )
+            {
+                /* xRetryIndex is negative to tell that the socket is non-blocking. */
+                ulIPAddress = prvGetHostByNameOp( pcHostName,
+                                                  uxIdentifier,
+                                                  xDNSSocket,
+                                                  ppxAddressInfo,
+                                                  xFamily,
+                                                  uxReadTimeOut_ticks );
+            }
+            else
+            {
+                ulIPAddress = prvGetHostByNameOp_WithRetry( pcHostName,
+                                                            uxIdentifier,
+                                                            xDNSSocket,
+                                                            ppxAddressInfo,
+                                                            xFamily,
+                                                            uxReadTimeOut_ticks );
+
+                #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+                    if( ( ulIPAddress == 0U ) && ( prvIsNegativelyCached( pcHostName, xFamily ) == pdFALSE ) )
+                    {
+                        /* No answer at all, do not try again for a while. */
+                        if( xFamily != FREERTOS_AF_INET6 )
+                        {
+                            vDNSNegativeCacheAdd( pcHostName, pdFALSE, ipconfigDNS_NEGATIVE_CACHE_TTL );
+                        }
+
+                        if( xFamily != FREERTOS_AF_INET4 )
+                        {
+                            vDNSNegativeCacheAdd( pcHostName, pdTRUE, ipconfigDNS_NEGATIVE_CACHE_TTL );
+                        }
+                    }
+                #endif /* ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 ) */
+            }
+
+            if( xIsShared == pdFALSE )
+            {
+                /* Finished with the socket. */
+                DNS_CloseSocket( xDNSSocket );
+            }
+        }
+
+        return ulIPAddress;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Create the DNS message in the zero copy buffer passed in the first parameter.
+ * @param[in,out] pucUDPPayloadBuffer The zero copy buffer where the DNS message will be created.
+ * @param[in] pcHostName Hostname to be looked up.
+ * @param[in] uxIdentifier Identifier to match sent and received packets
+ * @param[in] uxHostType dnsTYPE_A_HOST ( IPv4 ) or dnsTYPE_AAAA_HOST ( IPv6 ).
+ * @return Total size of the generated message, which is the space from the last written byte
+ *         to the beginning of the buffer.
+ */
+    static size_t prvCreateDNSMessage( uint8_t * pucUDPPayloadBuffer,
+                                       const char * pcHostName,
+                                       TickType_t uxIdentifier,
+                                       UBaseType_t uxHostType )
+    {
+        DNSMessage_t * pxDNSMessageHeader;
+        size_t uxStart, uxIndex;
+        DNSTail_t const * pxTail;
+        static const DNSMessage_t xDefaultPartDNSHeader =
+        {
+            0,                 /* The identifier will be overwritten. */
+            dnsOUTGOING_FLAGS, /* Flags set for standard query. */
+            dnsONE_QUESTION,   /* One question is being asked. */
+            0,                 /* No replies are included. */
+            0,                 /* No authorities. */
+            0                  /* No additional authorities. */
+        };
+
+        /* memcpy() helper variables for MISRA Rule 21.15 compliance*/
+        const void * pvCopySource;
+        void * pvCopyDest;
+
+        ( void ) uxHostType;
+
+        /* Copy in the const part of the header. Intentionally using different
+         * pointers with memcpy() to put the information in to correct place. */
+
+        /*
+         * Use helper variables for memcpy() to remain
+         * compliant with MISRA Rule 21.15.  These should be
+         * optimized away.
+         */
+        pvCopySource = &xDefaultPartDNSHeader;
+        pvCopyDest = pucUDPPayloadBuffer;
+        ( void ) memcpy( pvCopyDest, pvCopySource, sizeof( xDefaultPartDNSHeader ) );
+
+        /* Write in a unique identifier. Cast the Payload Buffer to DNSMessage_t
+         * to easily access fields of the DNS Message. */
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        pxDNSMessageHeader = ( ( DNSMessage_t * ) pucUDPPayloadBuffer );
+        pxDNSMessageHeader->usIdentifier = ( uint16_t ) uxIdentifier;
+
+        /* Create the resource record at the end of the header.  First
+         * find the end of the header. */
+        uxStart = sizeof( xDefaultPartDNSHeader );
+
+        /* Leave a gap for the first length byte. */
+        uxIndex = uxStart + 1U;
 
         /* Copy in the host name. */
         ( void ) strncpy( ( char * ) &( pucUDPPayloadBuffer[ uxIndex ] ), pcHostName, strlen( pcHostName ) + 1U );
@@ -1576,12 +2373,17 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
                 struct freertos_addrinfo * pxAddressInfo = NULL;
                 pucPayLoadBuffer = &( pxNetworkBuffer->pucEthernetBuffer[ uxUDPPacketSize ] );
 
-                /* The parameter pdFALSE indicates that the reply was not expected. */
-                ( void ) DNS_ParseDNSReply( pucPayLoadBuffer,
-                                            uxPayloadSize,
-                                            &( pxAddressInfo ),
-                                            pdFALSE,
-                                            FreeRTOS_ntohs( pxNetworkBuffer->usPort ) );
+                #if ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 )
+                    if( DNS_AnswerFromTemplate( pucPayLoadBuffer, uxPayloadSize, FreeRTOS_ntohs( pxNetworkBuffer->usPort ) ) == pdFALSE )
+                #endif
+                {
+                    /* The parameter pdFALSE indicates that the reply was not expected. */
+                    ( void ) DNS_ParseDNSReply( pucPayLoadBuffer,
+                                                uxPayloadSize,
+                                                &( pxAddressInfo ),
+                                                pdFALSE,
+                                                FreeRTOS_ntohs( pxNetworkBuffer->usPort ) );
+                }
 
                 if( pxAddressInfo != NULL )
                 {
@@ -1614,9 +2416,16 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
             /* Check for minimum buffer size. */
             if( pxNetworkBuffer->xDataLength >= uxBytesNeeded )
             {
-                DNS_TreatNBNS( pucUDPPayloadBuffer,
-                               pxNetworkBuffer->xDataLength,
-                               pxUDPPacket->xIPHeader.ulSourceIPAddress );
+                #if ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 )
+                    if( DNS_AnswerFromTemplate( pucUDPPayloadBuffer,
+                                                pxNetworkBuffer->xDataLength - sizeof( *pxUDPPacket ),
+                                                ipNBNS_PORT ) == pdFALSE )
+                #endif
+                {
+                    DNS_TreatNBNS( pucUDPPayloadBuffer,
+                                   pxNetworkBuffer->xDataLength,
+                                   pxUDPPacket->xIPHeader.ulSourceIPAddress );
+                }
             }
 
             /* The packet was not consumed. */
@@ -1663,6 +2472,299 @@ const IPv6_Address_t ipMDNS_IP_ADDR_IPv6 =
 
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 ) && ( ipconfigUSE_TCP == 1 )
+
+/** @brief The maximum number of connection attempts that are running at the same time. */
+        #define dnsHAPPY_EYEBALLS_MAX_ATTEMPTS    4
+
+/**
+ * @brief Find the next address of a given family in a list of addresses.
+ * @param[in] pxAddress The first entry to be inspected, may be NULL.
+ * @param[in] xFamily FREERTOS_AF_INET4 or FREERTOS_AF_INET6.
+ * @return The entry found, or NULL.
+ */
+        static const struct freertos_addrinfo * prvNextOfFamily( const struct freertos_addrinfo * pxAddress,
+                                                                  BaseType_t xFamily )
+        {
+            const struct freertos_addrinfo * pxEntry = pxAddress;
+
+            while( ( pxEntry != NULL ) && ( pxEntry->ai_family != xFamily ) )
+            {
+                pxEntry = pxEntry->ai_next;
+            }
+
+            return pxEntry;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create a TCP socket and start a non-blocking connect to an address.
+ * @param[in] pxAddress The address to connect to.
+ * @param[in] usPort The port number in host-endian notation.
+ * @return The socket, or FREERTOS_INVALID_SOCKET if the attempt could not be started.
+ */
+        static Socket_t prvHappyEyeballsStart( const struct freertos_addrinfo * pxAddress,
+                                               uint16_t usPort )
+        {
+            Socket_t xSocket;
+            struct freertos_sockaddr xAddress;
+            TickType_t uxNoWait = 0U;
+            BaseType_t xResult;
+
+            xSocket = FreeRTOS_socket( pxAddress->ai_family, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+
+            if( xSocket != FREERTOS_INVALID_SOCKET )
+            {
+                ( void ) memcpy( &( xAddress ), pxAddress->ai_addr, sizeof( xAddress ) );
+                xAddress.sin_len = ( uint8_t ) sizeof( xAddress );
+                xAddress.sin_family = ( uint8_t ) pxAddress->ai_family;
+                xAddress.sin_port = FreeRTOS_htons( usPort );
+
+                /* FreeRTOS_connect() returns immediately when the receive timeout is zero. */
+                ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &( uxNoWait ), sizeof( TickType_t ) );
+
+                xResult = FreeRTOS_connect( xSocket, &( xAddress ), sizeof( xAddress ) );
+
+                if( ( xResult != 0 ) && ( xResult != -pdFREERTOS_ERRNO_EWOULDBLOCK ) )
+                {
+                    ( void ) FreeRTOS_closesocket( xSocket );
+                    xSocket = FREERTOS_INVALID_SOCKET;
+                }
+            }
+
+            return xSocket;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Connect to a host that may have several addresses, as described in
+ *        RFC 8305 "Happy Eyeballs". The IPv6 and IPv4 addresses are tried
+ *        alternately, starting with IPv6. A next attempt is started when the
+ *        previous one has not succeeded within ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS,
+ *        or as soon as it fails. The first socket that gets connected wins, the
+ *        other attempts are aborted.
+ *        With ipconfigSUPPORT_SELECT_FUNCTION, the attempts are waited for with
+ *        FreeRTOS_select(), otherwise their status is polled every clock tick.
+ * @param[in] pxAddressList A list as returned by FreeRTOS_getaddrinfo().
+ * @param[in] usPort The port number to connect to, in host-endian notation.
+ * @param[in] uxTimeout The maximum time to wait for a connection, in ticks.
+ * @return A connected socket, or FREERTOS_INVALID_SOCKET when no connection
+ *         could be made in time. The socket has the default receive timeout.
+ */
+        Socket_t FreeRTOS_connect_happy_eyeballs( const struct freertos_addrinfo * pxAddressList,
+                                                  uint16_t usPort,
+                                                  TickType_t uxTimeout )
+        {
+            Socket_t xSockets[ dnsHAPPY_EYEBALLS_MAX_ATTEMPTS ];
+            Socket_t xWinner = FREERTOS_INVALID_SOCKET;
+            const struct freertos_addrinfo * pxNext6 = prvNextOfFamily( pxAddressList, FREERTOS_AF_INET6 );
+            const struct freertos_addrinfo * pxNext4 = prvNextOfFamily( pxAddressList, FREERTOS_AF_INET4 );
+            const struct freertos_addrinfo * pxAddress;
+            BaseType_t xPreferIPv6 = pdTRUE;
+            BaseType_t xStartNext = pdTRUE;
+            BaseType_t xActive = 0;
+            BaseType_t xIndex;
+            BaseType_t xState;
+            TickType_t uxRemaining = uxTimeout;
+            TickType_t uxAttemptDelay = 0U;
+            TickType_t uxDefaultTimeout = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
+            TimeOut_t xTimeOut;
+            TimeOut_t xAttemptTimeOut;
+
+            #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+                /* When the set can not be created, the attempts are polled. */
+                SocketSet_t xSocketSet = FreeRTOS_CreateSocketSet();
+                TickType_t uxWait;
+            #endif
+
+            for( xIndex = 0; xIndex < dnsHAPPY_EYEBALLS_MAX_ATTEMPTS; xIndex++ )
+            {
+                xSockets[ xIndex ] = FREERTOS_INVALID_SOCKET;
+            }
+
+            vTaskSetTimeOutState( &( xTimeOut ) );
+            vTaskSetTimeOutState( &( xAttemptTimeOut ) );
+
+            for( ; ; )
+            {
+                if( ( xStartNext != pdFALSE ) && ( xActive < dnsHAPPY_EYEBALLS_MAX_ATTEMPTS ) )
+                {
+                    /* Take the next address, alternating between the families. */
+                    if( ( pxNext6 != NULL ) && ( ( xPreferIPv6 != pdFALSE ) || ( pxNext4 == NULL ) ) )
+                    {
+                        pxAddress = pxNext6;
+                        pxNext6 = prvNextOfFamily( pxNext6->ai_next, FREERTOS_AF_INET6 );
+                        xPreferIPv6 = pdFALSE;
+                    }
+                    else
+                    {
+                        pxAddress = pxNext4;
+
+                        if( pxNext4 != NULL )
+                        {
+                            pxNext4 = prvNextOfFamily( pxNext4->ai_next, FREERTOS_AF_INET4 );
+                        }
+
+                        xPreferIPv6 = pdTRUE;
+                    }
+
+                    xStartNext = pdFALSE;
+
+                    if( pxAddress != NULL )
+                    {
+                        for( xIndex = 0; xIndex < dnsHAPPY_EYEBALLS_MAX_ATTEMPTS; xIndex++ )
+                        {
+                            if( xSockets[ xIndex ] == FREERTOS_INVALID_SOCKET )
+                            {
+                                break;
+                            }
+                        }
+
+                        xSockets[ xIndex ] = prvHappyEyeballsStart( pxAddress, usPort );
+
+                        if( xSockets[ xIndex ] != FREERTOS_INVALID_SOCKET )
+                        {
+                            #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+                                if( xSocketSet != NULL )
+                                {
+                                    /* WRITE is signalled when connected, EXCEPT when closed. */
+                                    FreeRTOS_FD_SET( xSockets[ xIndex ], xSocketSet, ( EventBits_t ) eSELECT_WRITE | ( EventBits_t ) eSELECT_EXCEPT );
+                                }
+                            #endif
+
+                            xActive++;
+                            uxAttemptDelay = pdMS_TO_TICKS( ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS );
+                            vTaskSetTimeOutState( &( xAttemptTimeOut ) );
+                        }
+                        else
+                        {
+                            /* Try the next address right away. */
+                            xStartNext = pdTRUE;
+                        }
+                    }
+                }
+
+                for( xIndex = 0; xIndex < dnsHAPPY_EYEBALLS_MAX_ATTEMPTS; xIndex++ )
+                {
+                    if( xSockets[ xIndex ] != FREERTOS_INVALID_SOCKET )
+                    {
+                        xState = FreeRTOS_connstatus( xSockets[ xIndex ] );
+
+                        if( FreeRTOS_issocketconnected( xSockets[ xIndex ] ) == pdTRUE )
+                        {
+                            xWinner = xSockets[ xIndex ];
+                            xSockets[ xIndex ] = FREERTOS_INVALID_SOCKET;
+                            break;
+                        }
+
+                        if( ( xState == ( BaseType_t ) eCLOSED ) || ( xState >= ( BaseType_t ) eCLOSE_WAIT ) )
+                        {
+                            /* This attempt failed, do not wait for the attempt delay. */
+                            #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+                                if( xSocketSet != NULL )
+                                {
+                                    FreeRTOS_FD_CLR( xSockets[ xIndex ], xSocketSet, ( EventBits_t ) eSELECT_ALL );
+                                }
+                            #endif
+
+                            ( void ) FreeRTOS_closesocket( xSockets[ xIndex ] );
+                            xSockets[ xIndex ] = FREERTOS_INVALID_SOCKET;
+                            xActive--;
+                            xStartNext = pdTRUE;
+                        }
+                    }
+                }
+
+                if( xWinner != FREERTOS_INVALID_SOCKET )
+                {
+                    break;
+                }
+
+                if( ( xActive == 0 ) && ( xStartNext == pdFALSE ) )
+                {
+                    /* All addresses have been tried. */
+                    break;
+                }
+
+                if( ( xStartNext == pdFALSE ) && ( xActive > 0 ) && ( xActive < dnsHAPPY_EYEBALLS_MAX_ATTEMPTS ) &&
+                    ( ( pxNext6 != NULL ) || ( pxNext4 != NULL ) ) &&
+                    ( xTaskCheckForTimeOut( &( xAttemptTimeOut ), &( uxAttemptDelay ) ) != pdFALSE ) )
+                {
+                    xStartNext = pdTRUE;
+                }
+
+                if( xTaskCheckForTimeOut( &( xTimeOut ), &( uxRemaining ) ) != pdFALSE )
+                {
+                    break;
+                }
+
+                if( xStartNext == pdFALSE )
+                {
+                    #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+                        if( xSocketSet != NULL )
+                        {
+                            /* Sleep until an attempt connects or fails, the next
+                             * attempt is due, or the time is up. */
+                            uxWait = uxRemaining;
+
+                            if( ( xActive < dnsHAPPY_EYEBALLS_MAX_ATTEMPTS ) &&
+                                ( ( pxNext6 != NULL ) || ( pxNext4 != NULL ) ) &&
+                                ( uxAttemptDelay < uxWait ) )
+                            {
+                                uxWait = uxAttemptDelay;
+                            }
+
+                            ( void ) FreeRTOS_select( xSocketSet, uxWait );
+                        }
+                        else
+                    #endif /* ( ipconfigSUPPORT_SELECT_FUNCTION == 1 ) */
+                    {
+                        vTaskDelay( 1U );
+                    }
+                }
+            }
+
+            for( xIndex = 0; xIndex < dnsHAPPY_EYEBALLS_MAX_ATTEMPTS; xIndex++ )
+            {
+                if( xSockets[ xIndex ] != FREERTOS_INVALID_SOCKET )
+                {
+                    #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+                        if( xSocketSet != NULL )
+                        {
+                            FreeRTOS_FD_CLR( xSockets[ xIndex ], xSocketSet, ( EventBits_t ) eSELECT_ALL );
+                        }
+                    #endif
+
+                    ( void ) FreeRTOS_closesocket( xSockets[ xIndex ] );
+                }
+            }
+
+            if( xWinner != FREERTOS_INVALID_SOCKET )
+            {
+                #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+                    if( xSocketSet != NULL )
+                    {
+                        /* The winner must not refer to the set after it is deleted. */
+                        FreeRTOS_FD_CLR( xWinner, xSocketSet, ( EventBits_t ) eSELECT_ALL );
+                    }
+                #endif
+
+                ( void ) FreeRTOS_setsockopt( xWinner, 0, FREERTOS_SO_RCVTIMEO, &( uxDefaultTimeout ), sizeof( TickType_t ) );
+            }
+
+            #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+                if( xSocketSet != NULL )
+                {
+                    FreeRTOS_DeleteSocketSet( xSocketSet );
+                }
+            #endif
+
+            return xWinner;
+        }
+
+    #endif /* ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 ) && ( ipconfigUSE_TCP == 1 ) */
+/*-----------------------------------------------------------*/
+
 #endif /* ipconfigUSE_DNS != 0 */
 
 /*-----------------------------------------------------------*/
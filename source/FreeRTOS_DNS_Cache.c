@@ -53,11 +53,106 @@
  */
     static DNSCacheRow_t xDNSCache[ ipconfigDNS_CACHE_ENTRIES ];
 
+    #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+
+/** @brief The header of a name in xDNSNamePool[], the name is stored in the
+ *         units that follow it. A unit has the size of the header. */
+        typedef struct xDNS_NAME_HEADER
+        {
+            uint32_t ulHash;       /**< The hash of the name, compared before the name itself. */
+            uint16_t usUnits;      /**< The number of units taken, including the header. */
+            uint16_t usReferences; /**< The number of rows that use the name, zero for free space. */
+        } DNSNameHeader_t;
+
+/** @brief The number of units in xDNSNamePool[]. */
+        #define dnsNAME_POOL_UNITS    ( ( UBaseType_t ) ipconfigDNS_CACHE_NAME_POOL_SIZE / ( UBaseType_t ) sizeof( DNSNameHeader_t ) )
+
+/** @brief The host names of the rows of xDNSCache[]. A row refers to the unit
+ *         that follows the header of its name, so that zero means "no name". */
+        static DNSNameHeader_t xDNSNamePool[ dnsNAME_POOL_UNITS ];
+
+/** @brief The units from this index onwards are not used. */
+        static UBaseType_t uxDNSNamePoolEnd = 0U;
+
+        #define dnsROW_NAME( pxRow )      prvDNSName( ( pxRow )->usName )
+        #define dnsROW_IN_USE( pxRow )    ( ( ( pxRow )->usName != 0U ) ? pdTRUE : pdFALSE )
+
+/** Get the name that a row refers to. */
+        static const char * prvDNSName( uint16_t usName );
+
+/** Store a name in the pool, or add a reference to it. */
+        static uint16_t prvDNSNameIntern( const char * pcName );
+
+/** Drop a reference to a name, the space is freed with the last reference. */
+        static void prvDNSNameRelease( uint16_t usName );
+    #else /* if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 ) */
+        #define dnsROW_NAME( pxRow )      ( ( pxRow )->pcName )
+        #define dnsROW_IN_USE( pxRow )    ( ( ( pxRow )->pcName[ 0 ] != ( char ) 0 ) ? pdTRUE : pdFALSE )
+    #endif /* if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 ) */
+
+    #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+
+/** @brief A link to a row of xDNSCache[]: zero means "none", otherwise the
+ *         index of the row plus one, so that a zeroed index is empty. */
+        #define dnsLINK_TO_ROW( usLink )    ( ( UBaseType_t ) ( usLink ) - 1U )
+        #define dnsROW_TO_LINK( uxRow )     ( ( uint16_t ) ( ( uxRow ) + 1U ) )
+
+/** @brief Mask to get a bucket number from a hash value. */
+        #define dnsHASH_MASK                ( ( uint32_t ) ipconfigDNS_CACHE_HASH_BUCKET_COUNT - 1U )
+
+/** @brief The links that belong to one row of xDNSCache[]. */
+        typedef struct xDNS_INDEX_LINKS
+        {
+            uint16_t usNext;         /**< The next row in the same bucket. */
+            uint16_t usNewer;        /**< The row that was used more recently. */
+            uint16_t usOlder;        /**< The row that was used less recently, or the next free row. */
+            uint16_t usHeapPosition; /**< The position of the row in usHeap[]. */
+        } DNSIndexLinks_t;
+
+/** @brief Indexes the valid rows of xDNSCache[]. Rows that were released are
+ *         kept in a free list. */
+        typedef struct xDNS_INDEX
+        {
+            uint16_t usBuckets[ ipconfigDNS_CACHE_HASH_BUCKET_COUNT ]; /**< Rows hashed on the host name. */
+            DNSIndexLinks_t xLinks[ ipconfigDNS_CACHE_ENTRIES ];       /**< The links of each row. */
+            uint16_t usHeap[ ipconfigDNS_CACHE_ENTRIES ];              /**< The valid rows as a binary min-heap, ordered on the time their TTL runs out. */
+            uint16_t usHeapCount;                                      /**< The number of rows in usHeap[]. */
+            uint16_t usNewest;                                         /**< The most recently used row. */
+            uint16_t usOldest;                                         /**< The least recently used row. */
+            uint16_t usFree;                                           /**< The first released row. */
+            uint16_t usUnused;                                         /**< The rows from this index onwards were never used. */
+        } DNSIndex_t;
+
+/** @brief The index of the DNS cache. */
+        static DNSIndex_t xDNSIndex;
+    #else /* if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 ) */
+
 /*!
  * @brief indicates the index of a free entry in the cache structure
  *        \a  DNSCacheRow_t
  */
-    static UBaseType_t uxFreeEntry = 0U;
+        static UBaseType_t uxFreeEntry = 0U;
+    #endif /* if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 ) */
+
+    #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+
+/** @brief A name that could not be resolved. An empty pcName marks a free row. */
+        typedef struct xDNS_NEGATIVE_ROW
+        {
+            char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ]; /**< The name of the host. */
+            BaseType_t xIsIPv6;                           /**< pdTRUE when the AAAA look-up failed, pdFALSE for A. */
+            uint32_t ulTimeWhenAddedInSeconds;            /**< The time at which the entry was added. */
+            uint32_t ulTTL;                               /**< Time-to-Live in seconds, host-endian. */
+        } DNSNegativeRow_t;
+
+/** @brief The names that are known not to resolve. */
+        static DNSNegativeRow_t xDNSNegativeCache[ ipconfigDNS_NEGATIVE_CACHE_ENTRIES ];
+
+/** Find a valid negative entry, releasing the expired rows on the way. */
+        static UBaseType_t prvNegativeCacheFind( const char * pcName,
+                                                 BaseType_t xIsIPv6,
+                                                 uint32_t ulCurrentTimeSeconds );
+    #endif /* ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 ) */
 
 /** returns the index of the hostname entry in the dns cache. */
     static BaseType_t prvFindEntryIndex( const char * pcName,
@@ -82,12 +177,502 @@
                                      const IPv46_Address_t * pxIP,
                                      uint32_t ulCurrentTimeSeconds );
 
-/** Copy DNS cache entries at xIndex to a linked struct addrinfo. */
-    static void prvReadDNSCache( BaseType_t uxIndex,
-                                 struct freertos_addrinfo ** ppxAddressInfo );
+/** Copy DNS cache entries at xIndex to a linked struct addrinfo. */
+    static void prvReadDNSCache( BaseType_t uxIndex,
+                                 struct freertos_addrinfo ** ppxAddressInfo );
+
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 ) || ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 ) )
+
+/**
+ * @brief Calculate the hash of a host name (FNV-1a).
+ *
+ * @param[in] pcName The host name.
+ *
+ * @return The hash, of which dnsHASH_MASK selects the bucket.
+ */
+        static uint32_t prvDNSHashName( const char * pcName )
+        {
+            uint32_t ulHash = 2166136261U;
+            const char * pcChar;
+
+            for( pcChar = pcName; *pcChar != ( char ) 0; pcChar++ )
+            {
+                ulHash ^= ( uint32_t ) ( uint8_t ) *pcChar;
+                ulHash *= 16777619U;
+            }
+
+            return ulHash ^ ( ulHash >> 16 );
+        }
+    #endif /* ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 ) || ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+
+/**
+ * @brief Get the name that a row refers to.
+ *
+ * @param[in] usName The reference to the name, not zero.
+ *
+ * @return The host name.
+ */
+        static const char * prvDNSName( uint16_t usName )
+        {
+            return ( const char * ) &( xDNSNamePool[ usName ] );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a name in the pool. When the name is present already, only its
+ *        number of references is incremented.
+ *
+ * @param[in] pcName The host name.
+ *
+ * @return The reference to the name, or zero when the pool is full.
+ */
+        static uint16_t prvDNSNameIntern( const char * pcName )
+        {
+            uint32_t ulHash = prvDNSHashName( pcName );
+            size_t uxLength = strlen( pcName );
+            /* The header and the name with its terminator, rounded up. */
+            UBaseType_t uxUnits = 1U + ( ( UBaseType_t ) ( uxLength + sizeof( DNSNameHeader_t ) ) / ( UBaseType_t ) sizeof( DNSNameHeader_t ) );
+            UBaseType_t uxFree = dnsNAME_POOL_UNITS;
+            UBaseType_t uxUnit = 0U;
+            uint16_t usReturn = 0U;
+
+            while( uxUnit < uxDNSNamePoolEnd )
+            {
+                DNSNameHeader_t * pxHeader = &( xDNSNamePool[ uxUnit ] );
+
+                if( pxHeader->usReferences != 0U )
+                {
+                    if( ( pxHeader->ulHash == ulHash ) &&
+                        ( strcmp( prvDNSName( ( uint16_t ) ( uxUnit + 1U ) ), pcName ) == 0 ) )
+                    {
+                        pxHeader->usReferences++;
+                        usReturn = ( uint16_t ) ( uxUnit + 1U );
+                        break;
+                    }
+                }
+                else if( ( uxFree == dnsNAME_POOL_UNITS ) && ( ( UBaseType_t ) pxHeader->usUnits >= uxUnits ) )
+                {
+                    /* The first free space that is large enough. */
+                    uxFree = uxUnit;
+                }
+                else
+                {
+                    /* Free space that is too small, or not the first one. */
+                }
+
+                uxUnit += ( UBaseType_t ) pxHeader->usUnits;
+            }
+
+            if( usReturn == 0U )
+            {
+                if( uxFree != dnsNAME_POOL_UNITS )
+                {
+                    if( ( UBaseType_t ) xDNSNamePool[ uxFree ].usUnits > uxUnits )
+                    {
+                        /* Split off the rest of the free space. */
+                        xDNSNamePool[ uxFree + uxUnits ].usUnits = ( uint16_t ) ( ( UBaseType_t ) xDNSNamePool[ uxFree ].usUnits - uxUnits );
+                        xDNSNamePool[ uxFree + uxUnits ].usReferences = 0U;
+                    }
+                }
+                else if( ( uxDNSNamePoolEnd + uxUnits ) <= dnsNAME_POOL_UNITS )
+                {
+                    uxFree = uxDNSNamePoolEnd;
+                    uxDNSNamePoolEnd += uxUnits;
+                }
+                else
+                {
+                    /* The pool is full. */
+                }
+
+                if( uxFree != dnsNAME_POOL_UNITS )
+                {
+                    xDNSNamePool[ uxFree ].ulHash = ulHash;
+                    xDNSNamePool[ uxFree ].usUnits = ( uint16_t ) uxUnits;
+                    xDNSNamePool[ uxFree ].usReferences = 1U;
+                    ( void ) memcpy( &( xDNSNamePool[ uxFree + 1U ] ), pcName, uxLength + 1U );
+                    usReturn = ( uint16_t ) ( uxFree + 1U );
+                }
+            }
+
+            return usReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Drop a reference to a name. When it was the last one, the space is
+ *        merged with the free space that follows it.  Free space at the end of
+ *        the pool is given back.
+ *
+ * @param[in] usName The reference to the name, or zero for none.
+ */
+        static void prvDNSNameRelease( uint16_t usName )
+        {
+            UBaseType_t uxUnit = 0U;
+            UBaseType_t uxNext;
+
+            if( usName != 0U )
+            {
+                xDNSNamePool[ usName - 1U ].usReferences--;
+
+                if( xDNSNamePool[ usName - 1U ].usReferences == 0U )
+                {
+                    while( uxUnit < uxDNSNamePoolEnd )
+                    {
+                        DNSNameHeader_t * pxHeader = &( xDNSNamePool[ uxUnit ] );
+
+                        uxNext = uxUnit + ( UBaseType_t ) pxHeader->usUnits;
+
+                        if( pxHeader->usReferences == 0U )
+                        {
+                            while( ( uxNext < uxDNSNamePoolEnd ) && ( xDNSNamePool[ uxNext ].usReferences == 0U ) )
+                            {
+                                pxHeader->usUnits += xDNSNamePool[ uxNext ].usUnits;
+                                uxNext = uxUnit + ( UBaseType_t ) pxHeader->usUnits;
+                            }
+
+                            if( uxNext >= uxDNSNamePoolEnd )
+                            {
+                                uxDNSNamePoolEnd = uxUnit;
+                            }
+                        }
+
+                        uxUnit = uxNext;
+                    }
+                }
+            }
+        }
+    #endif /* ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+
+/**
+ * @brief Check if the TTL of one row runs out before that of another row.
+ *
+ * @param[in] usLeft The first row, as a link.
+ * @param[in] usRight The second row, as a link.
+ *
+ * @return pdTRUE when 'usLeft' expires first.
+ */
+        static BaseType_t prvDNSHeapBefore( uint16_t usLeft,
+                                            uint16_t usRight )
+        {
+            const DNSCacheRow_t * pxLeft = &( xDNSCache[ dnsLINK_TO_ROW( usLeft ) ] );
+            const DNSCacheRow_t * pxRight = &( xDNSCache[ dnsLINK_TO_ROW( usRight ) ] );
+            uint32_t ulLeft = pxLeft->ulTimeWhenAddedInSeconds + FreeRTOS_ntohl( pxLeft->ulTTL );
+            uint32_t ulRight = pxRight->ulTimeWhenAddedInSeconds + FreeRTOS_ntohl( pxRight->ulTTL );
+
+            /* Compare the difference, which also works when the seconds wrap around. */
+            return ( ( int32_t ) ( ulLeft - ulRight ) < 0 ) ? pdTRUE : pdFALSE;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a row at a position of the heap.
+ *
+ * @param[in] uxPosition The position in usHeap[].
+ * @param[in] usLink The row, as a link.
+ */
+        static void prvDNSHeapSet( UBaseType_t uxPosition,
+                                   uint16_t usLink )
+        {
+            xDNSIndex.usHeap[ uxPosition ] = usLink;
+            xDNSIndex.xLinks[ dnsLINK_TO_ROW( usLink ) ].usHeapPosition = ( uint16_t ) uxPosition;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Restore the heap order after the expiry time of the row at a position
+ *        has changed.
+ *
+ * @param[in] uxStart The position in usHeap[].
+ */
+        static void prvDNSHeapFix( UBaseType_t uxStart )
+        {
+            UBaseType_t uxPosition = uxStart;
+            uint16_t usLink = xDNSIndex.usHeap[ uxPosition ];
+
+            /* Move up while the parent expires later. */
+            while( uxPosition > 0U )
+            {
+                UBaseType_t uxParent = ( uxPosition - 1U ) / 2U;
+
+                if( prvDNSHeapBefore( usLink, xDNSIndex.usHeap[ uxParent ] ) == pdFALSE )
+                {
+                    break;
+                }
+
+                prvDNSHeapSet( uxPosition, xDNSIndex.usHeap[ uxParent ] );
+                uxPosition = uxParent;
+            }
+
+            /* Move down while a child expires earlier. */
+            for( ; ; )
+            {
+                UBaseType_t uxChild = ( 2U * uxPosition ) + 1U;
+
+                if( uxChild >= ( UBaseType_t ) xDNSIndex.usHeapCount )
+                {
+                    break;
+                }
+
+                if( ( ( uxChild + 1U ) < ( UBaseType_t ) xDNSIndex.usHeapCount ) &&
+                    ( prvDNSHeapBefore( xDNSIndex.usHeap[ uxChild + 1U ], xDNSIndex.usHeap[ uxChild ] ) != pdFALSE ) )
+                {
+                    uxChild++;
+                }
+
+                if( prvDNSHeapBefore( xDNSIndex.usHeap[ uxChild ], usLink ) == pdFALSE )
+                {
+                    break;
+                }
+
+                prvDNSHeapSet( uxPosition, xDNSIndex.usHeap[ uxChild ] );
+                uxPosition = uxChild;
+            }
+
+            prvDNSHeapSet( uxPosition, usLink );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a row from the LRU list.
+ *
+ * @param[in] uxRow The row to be removed.
+ */
+        static void prvDNSIndexRemoveFromLRU( UBaseType_t uxRow )
+        {
+            DNSIndexLinks_t * pxLinks = &( xDNSIndex.xLinks[ uxRow ] );
+
+            if( pxLinks->usNewer != 0U )
+            {
+                xDNSIndex.xLinks[ dnsLINK_TO_ROW( pxLinks->usNewer ) ].usOlder = pxLinks->usOlder;
+            }
+            else
+            {
+                xDNSIndex.usNewest = pxLinks->usOlder;
+            }
+
+            if( pxLinks->usOlder != 0U )
+            {
+                xDNSIndex.xLinks[ dnsLINK_TO_ROW( pxLinks->usOlder ) ].usNewer = pxLinks->usNewer;
+            }
+            else
+            {
+                xDNSIndex.usOldest = pxLinks->usNewer;
+            }
+
+            pxLinks->usNewer = 0U;
+            pxLinks->usOlder = 0U;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a row to the LRU list as the most recently used one.
+ *
+ * @param[in] uxRow The row to be added, it may not be in the list.
+ */
+        static void prvDNSIndexAddToLRU( UBaseType_t uxRow )
+        {
+            xDNSIndex.xLinks[ uxRow ].usNewer = 0U;
+            xDNSIndex.xLinks[ uxRow ].usOlder = xDNSIndex.usNewest;
+
+            if( xDNSIndex.usNewest != 0U )
+            {
+                xDNSIndex.xLinks[ dnsLINK_TO_ROW( xDNSIndex.usNewest ) ].usNewer = dnsROW_TO_LINK( uxRow );
+            }
+            else
+            {
+                xDNSIndex.usOldest = dnsROW_TO_LINK( uxRow );
+            }
+
+            xDNSIndex.usNewest = dnsROW_TO_LINK( uxRow );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Make an indexed row the most recently used one.
+ *
+ * @param[in] uxRow The row that was used.
+ */
+        static void prvDNSIndexTouch( UBaseType_t uxRow )
+        {
+            if( xDNSIndex.usNewest != dnsROW_TO_LINK( uxRow ) )
+            {
+                prvDNSIndexRemoveFromLRU( uxRow );
+                prvDNSIndexAddToLRU( uxRow );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a row to the index, after its name, TTL and time have been set.
+ *
+ * @param[in] uxRow The row to be added.
+ */
+        static void prvDNSIndexLink( UBaseType_t uxRow )
+        {
+            uint16_t * pusHead = &( xDNSIndex.usBuckets[ xDNSCache[ uxRow ].ulNameHash & dnsHASH_MASK ] );
+
+            xDNSIndex.xLinks[ uxRow ].usNext = *pusHead;
+            *pusHead = dnsROW_TO_LINK( uxRow );
+
+            prvDNSIndexAddToLRU( uxRow );
+
+            xDNSIndex.usHeap[ xDNSIndex.usHeapCount ] = dnsROW_TO_LINK( uxRow );
+            xDNSIndex.usHeapCount++;
+            prvDNSHeapFix( ( UBaseType_t ) xDNSIndex.usHeapCount - 1U );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a row from the index.
+ *
+ * @param[in] uxRow The row to be removed.
+ */
+        static void prvDNSIndexUnlink( UBaseType_t uxRow )
+        {
+            uint16_t * pusLink = &( xDNSIndex.usBuckets[ xDNSCache[ uxRow ].ulNameHash & dnsHASH_MASK ] );
+            UBaseType_t uxPosition = xDNSIndex.xLinks[ uxRow ].usHeapPosition;
+
+            while( *pusLink != 0U )
+            {
+                uint16_t * pusNext = &( xDNSIndex.xLinks[ dnsLINK_TO_ROW( *pusLink ) ].usNext );
+
+                if( dnsLINK_TO_ROW( *pusLink ) == uxRow )
+                {
+                    *pusLink = *pusNext;
+                    *pusNext = 0U;
+                    break;
+                }
+
+                pusLink = pusNext;
+            }
+
+            prvDNSIndexRemoveFromLRU( uxRow );
+
+            /* Fill the hole in the heap with its last row. */
+            xDNSIndex.usHeapCount--;
+
+            if( uxPosition < ( UBaseType_t ) xDNSIndex.usHeapCount )
+            {
+                prvDNSHeapSet( uxPosition, xDNSIndex.usHeap[ xDNSIndex.usHeapCount ] );
+                prvDNSHeapFix( uxPosition );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Wipe a valid row and move it to the free list.
+ *
+ * @param[in] uxRow The row to be released.
+ */
+        static void prvDNSIndexRelease( UBaseType_t uxRow )
+        {
+            prvDNSIndexUnlink( uxRow );
+            xDNSIndex.xLinks[ uxRow ].usOlder = xDNSIndex.usFree;
+            xDNSIndex.usFree = dnsROW_TO_LINK( uxRow );
+
+            #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+            {
+                prvDNSNameRelease( xDNSCache[ uxRow ].usName );
+            }
+            #endif
+
+            ( void ) memset( &( xDNSCache[ uxRow ] ), 0, sizeof( xDNSCache[ uxRow ] ) );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the valid row that holds a host name of a given type.
+ *
+ * @param[in] pcName The host name to look for.
+ * @param[in] xIs_IPv6 pdTRUE when looking for IPv6 addresses.
+ *
+ * @return The index of the row, or ipconfigDNS_CACHE_ENTRIES when not found.
+ */
+        static UBaseType_t prvDNSIndexFind( const char * pcName,
+                                            BaseType_t xIs_IPv6 )
+        {
+            UBaseType_t uxRow = ipconfigDNS_CACHE_ENTRIES;
+            uint32_t ulHash = prvDNSHashName( pcName );
+            uint16_t usLink = xDNSIndex.usBuckets[ ulHash & dnsHASH_MASK ];
+
+            while( usLink != 0U )
+            {
+                const DNSCacheRow_t * pxRow = &( xDNSCache[ dnsLINK_TO_ROW( usLink ) ] );
+
+                if( ( pxRow->ulNameHash == ulHash ) &&
+                    ( pxRow->xAddresses[ 0 ].xIs_IPv6 == xIs_IPv6 ) &&
+                    ( strcmp( dnsROW_NAME( pxRow ), pcName ) == 0 ) )
+                {
+                    uxRow = dnsLINK_TO_ROW( usLink );
+                    break;
+                }
+
+                usLink = xDNSIndex.xLinks[ dnsLINK_TO_ROW( usLink ) ].usNext;
+            }
+
+            return uxRow;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get a row for a new host name. Rows whose TTL ran out are released
+ *        first. Then a released row is used, or a row that was never used, or
+ *        else the least recently used row, which is unlinked.
+ *
+ * @param[in] ulCurrentTimeSeconds The current time.
+ *
+ * @return The index of the row.
+ */
+        static UBaseType_t prvDNSIndexAllocate( uint32_t ulCurrentTimeSeconds )
+        {
+            UBaseType_t uxRow;
+
+            /* The row at the top of the heap expires first. */
+            while( xDNSIndex.usHeapCount > 0U )
+            {
+                const DNSCacheRow_t * pxRow = &( xDNSCache[ dnsLINK_TO_ROW( xDNSIndex.usHeap[ 0 ] ) ] );
+
+                if( ( ulCurrentTimeSeconds - pxRow->ulTimeWhenAddedInSeconds ) < FreeRTOS_ntohl( pxRow->ulTTL ) )
+                {
+                    break;
+                }
+
+                prvDNSIndexRelease( dnsLINK_TO_ROW( xDNSIndex.usHeap[ 0 ] ) );
+            }
+
+            if( xDNSIndex.usFree != 0U )
+            {
+                uxRow = dnsLINK_TO_ROW( xDNSIndex.usFree );
+                xDNSIndex.usFree = xDNSIndex.xLinks[ uxRow ].usOlder;
+                xDNSIndex.xLinks[ uxRow ].usOlder = 0U;
+            }
+            else if( xDNSIndex.usUnused < ( uint16_t ) ipconfigDNS_CACHE_ENTRIES )
+            {
+                uxRow = ( UBaseType_t ) xDNSIndex.usUnused;
+                xDNSIndex.usUnused++;
+            }
+            else
+            {
+                /* All rows are valid, replace the least recently used one. */
+                uxRow = dnsLINK_TO_ROW( xDNSIndex.usOldest );
+                prvDNSIndexUnlink( uxRow );
+                ipRESOURCE_SHORTAGE( eShortageDNSCache );
+            }
 
+            return uxRow;
+        }
 /*-----------------------------------------------------------*/
 
+    #endif /* ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 ) */
+
     #if ( ipconfigUSE_IPv4 != 0 )
 
 /**
@@ -183,9 +768,55 @@
     void FreeRTOS_dnsclear( void )
     {
         ( void ) memset( xDNSCache, 0x0, sizeof( xDNSCache ) );
-        uxFreeEntry = 0U;
+
+        #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+        {
+            ( void ) memset( xDNSNamePool, 0, sizeof( xDNSNamePool ) );
+            uxDNSNamePoolEnd = 0U;
+        }
+        #endif
+
+        #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+        {
+            ( void ) memset( &xDNSIndex, 0, sizeof( xDNSIndex ) );
+        }
+        #else
+        {
+            uxFreeEntry = 0U;
+        }
+        #endif
+
+        #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+        {
+            ( void ) memset( xDNSNegativeCache, 0, sizeof( xDNSNegativeCache ) );
+        }
+        #endif
     }
 
+    #if ( ipconfigUSE_RESOURCE_STATS != 0 )
+
+/**
+ * @brief Count the rows of the DNS cache that hold a host name.
+ *
+ * @return The number of occupied rows.
+ */
+        UBaseType_t uxDNSCacheRowsInUse( void )
+        {
+            UBaseType_t uxIndex;
+            UBaseType_t uxCount = 0U;
+
+            for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigDNS_CACHE_ENTRIES; uxIndex++ )
+            {
+                if( dnsROW_IN_USE( &( xDNSCache[ uxIndex ] ) ) != pdFALSE )
+                {
+                    uxCount++;
+                }
+            }
+
+            return uxCount;
+        }
+    #endif /* ( ipconfigUSE_RESOURCE_STATS != 0 ) */
+
 /**
  * @brief process a DNS Cache request (get, update, or insert)
  *
@@ -260,6 +891,19 @@
             }
         }
 
+        #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+            if( xLookUp == pdFALSE )
+            {
+                UBaseType_t uxNegative = prvNegativeCacheFind( pcName, pxIP->xIs_IPv6, ulCurrentTimeSeconds );
+
+                if( uxNegative < ( UBaseType_t ) ipconfigDNS_NEGATIVE_CACHE_ENTRIES )
+                {
+                    /* The name resolves now. */
+                    xDNSNegativeCache[ uxNegative ].pcName[ 0 ] = ( char ) 0;
+                }
+            }
+        #endif /* ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 ) */
+
         #if ( ipconfigHAS_DEBUG_PRINTF != 0 )
             if( ( xLookUp == pdFALSE ) || ( pxIP->xIPAddress.ulIP_IPv4 != 0U ) )
             {
@@ -317,25 +961,52 @@
         BaseType_t xReturn = pdFALSE;
         UBaseType_t uxIndex;
 
-        /* For each entry in the DNS cache table. */
-        for( uxIndex = 0; uxIndex < ipconfigDNS_CACHE_ENTRIES; uxIndex++ )
+        #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
         {
-            if( xDNSCache[ uxIndex ].pcName[ 0 ] == ( char ) 0 )
-            { /* empty slot */
-                continue;
+            uxIndex = prvDNSIndexFind( pcName, pxIP->xIs_IPv6 );
+
+            if( uxIndex < ( UBaseType_t ) ipconfigDNS_CACHE_ENTRIES )
+            {
+                xReturn = pdTRUE;
+                *uxResult = uxIndex;
             }
+        }
+        #else /* if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 ) */
+        {
+            #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+                uint32_t ulHash = prvDNSHashName( pcName );
+            #endif
+
+            /* For each entry in the DNS cache table. */
+            for( uxIndex = 0; uxIndex < ipconfigDNS_CACHE_ENTRIES; uxIndex++ )
+            {
+                if( dnsROW_IN_USE( &( xDNSCache[ uxIndex ] ) ) == pdFALSE )
+                { /* empty slot */
+                    continue;
+                }
 
-            if( strcmp( xDNSCache[ uxIndex ].pcName, pcName ) == 0 )
-            { /* hostname found */
-                /* IPv6 is enabled, See if the cache entry has the correct type. */
-                if( pxIP->xIs_IPv6 == xDNSCache[ uxIndex ].xAddresses[ 0 ].xIs_IPv6 )
+                #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
                 {
-                    xReturn = pdTRUE;
-                    *uxResult = uxIndex;
-                    break;
+                    if( xDNSNamePool[ xDNSCache[ uxIndex ].usName - 1U ].ulHash != ulHash )
+                    { /* another name */
+                        continue;
+                    }
+                }
+                #endif
+
+                if( strcmp( dnsROW_NAME( &( xDNSCache[ uxIndex ] ) ), pcName ) == 0 )
+                { /* hostname found */
+                    /* IPv6 is enabled, See if the cache entry has the correct type. */
+                    if( pxIP->xIs_IPv6 == xDNSCache[ uxIndex ].xAddresses[ 0 ].xIs_IPv6 )
+                    {
+                        xReturn = pdTRUE;
+                        *uxResult = uxIndex;
+                        break;
+                    }
                 }
             }
         }
+        #endif /* if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 ) */
 
         return xReturn;
     }
@@ -360,10 +1031,23 @@
         BaseType_t isRead;
         uint32_t ulIPAddressIndex = 0;
         uint32_t ulAge = ulCurrentTimeSeconds - xDNSCache[ uxIndex ].ulTimeWhenAddedInSeconds;
+        /* The field ulTTL was stored as network-endian. */
+        uint32_t ulTTL = FreeRTOS_ntohl( xDNSCache[ uxIndex ].ulTTL );
+        BaseType_t xUsable = ( ulAge < ulTTL ) ? pdTRUE : pdFALSE;
+
+        #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+            if( ( xUsable == pdFALSE ) &&
+                ( xDNSCache[ uxIndex ].ucHits >= ( uint8_t ) ipconfigDNS_CACHE_PREFETCH_MIN_HITS ) &&
+                ( ( ulAge - ulTTL ) < ( uint32_t ) ipconfigDNS_CACHE_STALE_SECONDS ) )
+            {
+                /* A popular entry that has just expired. It may be used while
+                 * it is being refreshed. */
+                xUsable = pdTRUE;
+            }
+        #endif
 
-        /* Confirm that the record is still fresh.
-         * The field ulTTL was stored as network-endian. */
-        if( ulAge < FreeRTOS_ntohl( xDNSCache[ uxIndex ].ulTTL ) )
+        /* Confirm that the record is still fresh. */
+        if( xUsable != pdFALSE )
         {
             #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
                 uint8_t ucIndex;
@@ -384,6 +1068,19 @@
             ( void ) memcpy( pxIP, &( xDNSCache[ uxIndex ].xAddresses[ ulIPAddressIndex ] ), sizeof( *pxIP ) );
             isRead = pdTRUE;
 
+            #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+                if( xDNSCache[ uxIndex ].ucHits < 0xffU )
+                {
+                    xDNSCache[ uxIndex ].ucHits++;
+                }
+            #endif
+
+            #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+            {
+                prvDNSIndexTouch( uxIndex );
+            }
+            #endif
+
             if( ppxAddressInfo != NULL )
             {
                 /* Copy all entries from position 'uxIndex' to a linked struct addrinfo. */
@@ -393,7 +1090,20 @@
         else
         {
             /* Age out the old cached record. */
-            xDNSCache[ uxIndex ].pcName[ 0 ] = ( char ) 0;
+            #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+            {
+                prvDNSIndexRelease( uxIndex );
+            }
+            #elif ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+            {
+                prvDNSNameRelease( xDNSCache[ uxIndex ].usName );
+                xDNSCache[ uxIndex ].usName = 0U;
+            }
+            #else
+            {
+                xDNSCache[ uxIndex ].pcName[ 0 ] = ( char ) 0;
+            }
+            #endif
             isRead = pdFALSE;
         }
 
@@ -416,6 +1126,19 @@
     {
         uint32_t ulIPAddressIndex = 0;
 
+        #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+            if( xDNSCache[ uxIndex ].ucRefreshing != 0U )
+            {
+                /* The first answer to a refresh, forget the old addresses. */
+                xDNSCache[ uxIndex ].ucRefreshing = 0U;
+                #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
+                    xDNSCache[ uxIndex ].ucNumIPAddresses = 0U;
+                #endif
+            }
+
+            xDNSCache[ uxIndex ].ucHits = 0U;
+        #endif /* ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 ) */
+
         #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
             if( xDNSCache[ uxIndex ].ucNumIPAddresses <
                 ( uint8_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY )
@@ -429,6 +1152,14 @@
         ( void ) memcpy( &( xDNSCache[ uxIndex ].xAddresses[ ulIPAddressIndex ] ), pxIP, sizeof( *pxIP ) );
         xDNSCache[ uxIndex ].ulTTL = ulTTL;
         xDNSCache[ uxIndex ].ulTimeWhenAddedInSeconds = ulCurrentTimeSeconds;
+
+        #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+        {
+            /* The TTL runs out at a different moment now. */
+            prvDNSHeapFix( xDNSIndex.xLinks[ uxIndex ].usHeapPosition );
+            prvDNSIndexTouch( uxIndex );
+        }
+        #endif
     }
 /*-----------------------------------------------------------*/
 
@@ -445,30 +1176,114 @@
                                      const IPv46_Address_t * pxIP,
                                      uint32_t ulCurrentTimeSeconds )
     {
+        UBaseType_t uxEntry;
+        BaseType_t xHasName = pdTRUE;
+
         /* Add or update the item. */
         if( strlen( pcName ) < ( size_t ) ipconfigDNS_CACHE_NAME_LENGTH )
         {
-            ( void ) strncpy( xDNSCache[ uxFreeEntry ].pcName, pcName, strlen( pcName ) );
-            ( void ) memcpy( &( xDNSCache[ uxFreeEntry ].xAddresses[ 0 ] ), pxIP, sizeof( *pxIP ) );
+            #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+            {
+                uxEntry = prvDNSIndexAllocate( ulCurrentTimeSeconds );
+
+                #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+                {
+                    /* The least recently used row may be replaced. */
+                    prvDNSNameRelease( xDNSCache[ uxEntry ].usName );
+                }
+                #endif
+
+                ( void ) memset( &( xDNSCache[ uxEntry ] ), 0, sizeof( xDNSCache[ uxEntry ] ) );
+                xDNSCache[ uxEntry ].ulNameHash = prvDNSHashName( pcName );
+            }
+            #else
+            {
+                uxEntry = uxFreeEntry;
+
+                #if ( ipconfigUSE_RESOURCE_STATS != 0 )
+                {
+                    if( ( dnsROW_IN_USE( &( xDNSCache[ uxEntry ] ) ) != pdFALSE ) &&
+                        ( ( ulCurrentTimeSeconds - xDNSCache[ uxEntry ].ulTimeWhenAddedInSeconds ) < FreeRTOS_ntohl( xDNSCache[ uxEntry ].ulTTL ) ) )
+                    {
+                        /* An entry that has not expired yet is overwritten. */
+                        ipRESOURCE_SHORTAGE( eShortageDNSCache );
+                    }
+                }
+                #endif
+
+                #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+                {
+                    prvDNSNameRelease( xDNSCache[ uxEntry ].usName );
+                    xDNSCache[ uxEntry ].usName = 0U;
+                }
+                #endif
+            }
+            #endif /* if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 ) */
+
+            #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+            {
+                xDNSCache[ uxEntry ].usName = prvDNSNameIntern( pcName );
+
+                if( xDNSCache[ uxEntry ].usName == 0U )
+                {
+                    /* The name pool is full, the row stays free. */
+                    xHasName = pdFALSE;
+                    ipRESOURCE_SHORTAGE( eShortageDNSCache );
+
+                    #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+                    {
+                        xDNSIndex.xLinks[ uxEntry ].usOlder = xDNSIndex.usFree;
+                        xDNSIndex.usFree = dnsROW_TO_LINK( uxEntry );
+                    }
+                    #endif
+                }
+            }
+            #else
+            {
+                ( void ) strncpy( xDNSCache[ uxEntry ].pcName, pcName, strlen( pcName ) );
+            }
+            #endif /* if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 ) */
+        }
+        else
+        {
+            xHasName = pdFALSE;
+        }
+
+        if( xHasName != pdFALSE )
+        {
+            ( void ) memcpy( &( xDNSCache[ uxEntry ].xAddresses[ 0 ] ), pxIP, sizeof( *pxIP ) );
 
-            xDNSCache[ uxFreeEntry ].ulTTL = ulTTL;
-            xDNSCache[ uxFreeEntry ].ulTimeWhenAddedInSeconds = ulCurrentTimeSeconds;
+            xDNSCache[ uxEntry ].ulTTL = ulTTL;
+            xDNSCache[ uxEntry ].ulTimeWhenAddedInSeconds = ulCurrentTimeSeconds;
+            #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+                xDNSCache[ uxEntry ].ucHits = 0U;
+                xDNSCache[ uxEntry ].ucRefreshing = 0U;
+            #endif
             #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
-                xDNSCache[ uxFreeEntry ].ucNumIPAddresses = 1;
-                xDNSCache[ uxFreeEntry ].ucCurrentIPAddress = 0;
+                xDNSCache[ uxEntry ].ucNumIPAddresses = 1;
+                xDNSCache[ uxEntry ].ucCurrentIPAddress = 0;
 
                 /* Initialize all remaining IP addresses in this entry to 0 */
-                ( void ) memset( &xDNSCache[ uxFreeEntry ].xAddresses[ 1 ],
+                ( void ) memset( &xDNSCache[ uxEntry ].xAddresses[ 1 ],
                                  0,
-                                 sizeof( xDNSCache[ uxFreeEntry ].xAddresses[ 1 ] ) *
+                                 sizeof( xDNSCache[ uxEntry ].xAddresses[ 1 ] ) *
                                  ( ( uint32_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY - 1U ) );
             #endif
-            uxFreeEntry++;
 
-            if( uxFreeEntry == ipconfigDNS_CACHE_ENTRIES )
+            #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+            {
+                prvDNSIndexLink( uxEntry );
+            }
+            #else
             {
-                uxFreeEntry = 0;
+                uxFreeEntry++;
+
+                if( uxFreeEntry == ipconfigDNS_CACHE_ENTRIES )
+                {
+                    uxFreeEntry = 0;
+                }
             }
+            #endif
         }
     }
 /*-----------------------------------------------------------*/
@@ -507,14 +1322,14 @@
                     case pdFALSE:
                        {
                            const uint8_t * ucBytes = ( const uint8_t * ) &( pxAddresses->xIPAddress.ulIP_IPv4 );
-                           pxNewAddress = pxNew_AddrInfo( xDNSCache[ uxIndex ].pcName, FREERTOS_AF_INET4, ucBytes );
+                           pxNewAddress = pxNew_AddrInfo( dnsROW_NAME( &( xDNSCache[ uxIndex ] ) ), FREERTOS_AF_INET4, ucBytes );
                        }
                        break;
                 #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
                 #if ( ipconfigUSE_IPv6 != 0 )
                     case pdTRUE:
-                        pxNewAddress = pxNew_AddrInfo( xDNSCache[ uxIndex ].pcName, FREERTOS_AF_INET6, pxAddresses->xIPAddress.xIP_IPv6.ucBytes );
+                        pxNewAddress = pxNew_AddrInfo( dnsROW_NAME( &( xDNSCache[ uxIndex ] ) ), FREERTOS_AF_INET6, pxAddresses->xIPAddress.xIP_IPv6.ucBytes );
                         break;
                 #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
@@ -629,11 +1444,11 @@
             {
                 const DNSCacheRow_t * pxRow = &( xDNSCache[ xEntry ] );
 
-                if( pxRow->pcName[ 0 ] != ( char ) 0 )
+                if( dnsROW_IN_USE( pxRow ) != pdFALSE )
                 {
                     FreeRTOS_printf( ( "Entry %2u: %s use %u/%u\n",
                                        ( unsigned ) xEntry,
-                                       pxRow->pcName,
+                                       dnsROW_NAME( pxRow ),
                                        ( unsigned ) pxRow->ucCurrentIPAddress,
                                        ( unsigned ) pxRow->ucNumIPAddresses ) );
 
@@ -679,4 +1494,317 @@
     #endif /* if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 ) */
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+
+/**
+ * @brief Get the current time in seconds, as used by the DNS cache.
+ */
+        static uint32_t prvNegativeCacheTime( void )
+        {
+            TickType_t xCurrentTickCount = xTaskGetTickCount();
+
+            return ( uint32_t ) ( ( xCurrentTickCount / portTICK_PERIOD_MS ) / 1000U );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find a negative entry for a name. Rows whose TTL has run out are
+ *        released.
+ * @param[in] pcName The name of the host.
+ * @param[in] xIsIPv6 pdTRUE for an AAAA look-up, pdFALSE for an A look-up.
+ * @param[in] ulCurrentTimeSeconds The current time in seconds.
+ * @return The index of the row, or ipconfigDNS_NEGATIVE_CACHE_ENTRIES when
+ *         the name is not present.
+ */
+        static UBaseType_t prvNegativeCacheFind( const char * pcName,
+                                                 BaseType_t xIsIPv6,
+                                                 uint32_t ulCurrentTimeSeconds )
+        {
+            UBaseType_t uxIndex;
+            UBaseType_t uxResult = ( UBaseType_t ) ipconfigDNS_NEGATIVE_CACHE_ENTRIES;
+
+            for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigDNS_NEGATIVE_CACHE_ENTRIES; uxIndex++ )
+            {
+                DNSNegativeRow_t * pxRow = &( xDNSNegativeCache[ uxIndex ] );
+
+                if( pxRow->pcName[ 0 ] == ( char ) 0 )
+                {
+                    continue;
+                }
+
+                if( ( ulCurrentTimeSeconds - pxRow->ulTimeWhenAddedInSeconds ) >= pxRow->ulTTL )
+                {
+                    /* Age out the old entry. */
+                    pxRow->pcName[ 0 ] = ( char ) 0;
+                }
+                else if( ( pxRow->xIsIPv6 == xIsIPv6 ) && ( strcmp( pxRow->pcName, pcName ) == 0 ) )
+                {
+                    uxResult = uxIndex;
+                }
+                else
+                {
+                    /* Another name. */
+                }
+            }
+
+            return uxResult;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remember that a name could not be resolved.
+ * @param[in] pcName The name of the host.
+ * @param[in] xIsIPv6 pdTRUE when the AAAA look-up failed, pdFALSE for A.
+ * @param[in] ulTTL The number of seconds that the entry remains valid.
+ */
+        void vDNSNegativeCacheAdd( const char * pcName,
+                                   BaseType_t xIsIPv6,
+                                   uint32_t ulTTL )
+        {
+            uint32_t ulCurrentTimeSeconds = prvNegativeCacheTime();
+            UBaseType_t uxIndex;
+            UBaseType_t uxEntry;
+            uint32_t ulLeast = 0xffffffffU;
+
+            if( ( ulTTL != 0U ) && ( strlen( pcName ) < ( size_t ) ipconfigDNS_CACHE_NAME_LENGTH ) )
+            {
+                uxEntry = prvNegativeCacheFind( pcName, xIsIPv6, ulCurrentTimeSeconds );
+
+                if( uxEntry >= ( UBaseType_t ) ipconfigDNS_NEGATIVE_CACHE_ENTRIES )
+                {
+                    /* Take a free row, or else the row that will expire first. */
+                    for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigDNS_NEGATIVE_CACHE_ENTRIES; uxIndex++ )
+                    {
+                        const DNSNegativeRow_t * pxRow = &( xDNSNegativeCache[ uxIndex ] );
+                        uint32_t ulLeft = 0U;
+
+                        if( pxRow->pcName[ 0 ] != ( char ) 0 )
+                        {
+                            ulLeft = pxRow->ulTTL - ( ulCurrentTimeSeconds - pxRow->ulTimeWhenAddedInSeconds );
+                        }
+
+                        if( ulLeft < ulLeast )
+                        {
+                            ulLeast = ulLeft;
+                            uxEntry = uxIndex;
+                        }
+                    }
+                }
+
+                ( void ) strncpy( xDNSNegativeCache[ uxEntry ].pcName, pcName, sizeof( xDNSNegativeCache[ uxEntry ].pcName ) - 1U );
+                xDNSNegativeCache[ uxEntry ].pcName[ sizeof( xDNSNegativeCache[ uxEntry ].pcName ) - 1U ] = ( char ) 0;
+                xDNSNegativeCache[ uxEntry ].xIsIPv6 = xIsIPv6;
+                xDNSNegativeCache[ uxEntry ].ulTimeWhenAddedInSeconds = ulCurrentTimeSeconds;
+                xDNSNegativeCache[ uxEntry ].ulTTL = ulTTL;
+
+                FreeRTOS_debug_printf( ( "vDNSNegativeCacheAdd: '%s' (%s) does not resolve for %u seconds\n",
+                                         pcName,
+                                         ( xIsIPv6 != pdFALSE ) ? "AAAA" : "A",
+                                         ( unsigned ) ulTTL ) );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a name is known not to resolve.
+ * @param[in] pcName The name of the host.
+ * @param[in] xIsIPv6 pdTRUE for an AAAA look-up, pdFALSE for an A look-up.
+ * @return pdTRUE when a valid negative entry exists, otherwise pdFALSE.
+ */
+        BaseType_t xDNSNegativeCacheLookup( const char * pcName,
+                                            BaseType_t xIsIPv6 )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            if( prvNegativeCacheFind( pcName, xIsIPv6, prvNegativeCacheTime() ) < ( UBaseType_t ) ipconfigDNS_NEGATIVE_CACHE_ENTRIES )
+            {
+                xReturn = pdTRUE;
+            }
+
+            return xReturn;
+        }
+    #endif /* ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+
+/**
+ * @brief Check whether a cache entry should be refreshed now. That is the case
+ *        when the entry is popular and about to expire, or when it has expired
+ *        but is still used. Only one refresh is outstanding at a time.
+ *
+ * @param[in] pcName The host name.
+ * @param[in] xIsIPv6 pdTRUE for the AAAA entry, pdFALSE for the A entry.
+ *
+ * @return pdTRUE when the caller must send a question for the name.
+ */
+        BaseType_t xDNSCacheClaimRefresh( const char * pcName,
+                                          BaseType_t xIsIPv6 )
+        {
+            BaseType_t xReturn = pdFALSE;
+            UBaseType_t uxIndex;
+            IPv46_Address_t xIP;
+            uint32_t ulCurrentTimeSeconds = ( uint32_t ) ( ( xTaskGetTickCount() / portTICK_PERIOD_MS ) / 1000U );
+
+            xIP.xIs_IPv6 = xIsIPv6;
+
+            if( prvFindEntryIndex( pcName, &( xIP ), &( uxIndex ) ) == pdTRUE )
+            {
+                DNSCacheRow_t * pxRow = &( xDNSCache[ uxIndex ] );
+                uint32_t ulAge = ulCurrentTimeSeconds - pxRow->ulTimeWhenAddedInSeconds;
+                uint32_t ulTTL = FreeRTOS_ntohl( pxRow->ulTTL );
+
+                if( ( pxRow->ucHits >= ( uint8_t ) ipconfigDNS_CACHE_PREFETCH_MIN_HITS ) &&
+                    ( ( ulAge + ( uint32_t ) ipconfigDNS_CACHE_PREFETCH_SECONDS ) >= ulTTL ) )
+                {
+                    if( ( pxRow->ucRefreshing == 0U ) ||
+                        ( ( ulCurrentTimeSeconds - pxRow->ulRefreshStarted ) >= dnsCACHE_REFRESH_TIMEOUT_SECONDS ) )
+                    {
+                        pxRow->ucRefreshing = 1U;
+                        pxRow->ulRefreshStarted = ulCurrentTimeSeconds;
+                        xReturn = pdTRUE;
+                    }
+                }
+            }
+
+            return xReturn;
+        }
+    #endif /* ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_DNS_CACHE_PERSISTENCE != 0 )
+
+/**
+ * @brief Pass the valid entries of the DNS cache to the application, which
+ *        writes them to non-volatile storage. The remaining time-to-live of
+ *        each entry is turned into an absolute time of expiry.
+ *
+ * @return The value returned by xApplicationDNSCacheStore(), or pdFAIL when
+ *         there was not enough memory.
+ */
+        BaseType_t FreeRTOS_dnsCacheSave( void )
+        {
+            DNSCacheRecord_t * pxRecords;
+            BaseType_t xReturn = pdFAIL;
+            size_t uxCount = 0U;
+            UBaseType_t uxIndex;
+            uint32_t ulCurrentTimeSeconds;
+            uint32_t ulWallClock = ulApplicationTimeHook();
+
+            /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
+            /* coverity[misra_c_2012_directive_4_12_violation] */
+            pxRecords = ( ( DNSCacheRecord_t * ) pvPortMalloc( sizeof( *pxRecords ) * ( size_t ) ipconfigDNS_CACHE_ENTRIES ) );
+
+            if( pxRecords != NULL )
+            {
+                /* The cache is also used by the tasks that call
+                 * FreeRTOS_gethostbyname(). */
+                vTaskSuspendAll();
+                {
+                    ulCurrentTimeSeconds = ( uint32_t ) ( ( xTaskGetTickCount() / portTICK_PERIOD_MS ) / 1000U );
+
+                    for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigDNS_CACHE_ENTRIES; uxIndex++ )
+                    {
+                        const DNSCacheRow_t * pxRow = &( xDNSCache[ uxIndex ] );
+                        uint32_t ulAge = ulCurrentTimeSeconds - pxRow->ulTimeWhenAddedInSeconds;
+                        uint32_t ulTTL = FreeRTOS_ntohl( pxRow->ulTTL );
+
+                        if( ( dnsROW_IN_USE( pxRow ) != pdFALSE ) && ( ulAge < ulTTL ) )
+                        {
+                            DNSCacheRecord_t * pxRecord = &( pxRecords[ uxCount ] );
+
+                            ( void ) memset( pxRecord, 0, sizeof( *pxRecord ) );
+                            ( void ) strncpy( pxRecord->pcName, dnsROW_NAME( pxRow ), sizeof( pxRecord->pcName ) - 1U );
+                            ( void ) memcpy( pxRecord->xAddresses, pxRow->xAddresses, sizeof( pxRecord->xAddresses ) );
+                            pxRecord->ulExpiryTime = ulWallClock + ( ulTTL - ulAge );
+
+                            #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
+                                pxRecord->ucNumIPAddresses = pxRow->ucNumIPAddresses;
+                            #else
+                                pxRecord->ucNumIPAddresses = 1U;
+                            #endif
+
+                            uxCount++;
+                        }
+                    }
+                }
+                ( void ) xTaskResumeAll();
+
+                xReturn = xApplicationDNSCacheStore( pxRecords, uxCount );
+
+                FreeRTOS_debug_printf( ( "FreeRTOS_dnsCacheSave: %u entries, result %d\n",
+                                         ( unsigned ) uxCount,
+                                         ( int ) xReturn ) );
+
+                vPortFree( pxRecords );
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Put the entries that the application kept in non-volatile storage
+ *        back in the DNS cache, with the time that they have left to live.
+ *        Called by the IP-task after the cache was cleared.
+ */
+        void vDNSCacheRestore( void )
+        {
+            DNSCacheRecord_t * pxRecords;
+            size_t uxCount;
+            size_t uxRecord;
+            size_t uxAddress;
+            size_t uxRestored = 0U;
+            uint32_t ulWallClock;
+
+            /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
+            /* coverity[misra_c_2012_directive_4_12_violation] */
+            pxRecords = ( ( DNSCacheRecord_t * ) pvPortMalloc( sizeof( *pxRecords ) * ( size_t ) ipconfigDNS_CACHE_ENTRIES ) );
+
+            if( pxRecords != NULL )
+            {
+                uxCount = uxApplicationDNSCacheLoad( pxRecords, ( size_t ) ipconfigDNS_CACHE_ENTRIES );
+                ulWallClock = ulApplicationTimeHook();
+
+                for( uxRecord = 0U; ( uxRecord < uxCount ) && ( uxRecord < ( size_t ) ipconfigDNS_CACHE_ENTRIES ); uxRecord++ )
+                {
+                    DNSCacheRecord_t * pxRecord = &( pxRecords[ uxRecord ] );
+                    size_t uxNumAddresses = ( size_t ) pxRecord->ucNumIPAddresses;
+
+                    /* Do not trust the storage: the name must be terminated. */
+                    pxRecord->pcName[ sizeof( pxRecord->pcName ) - 1U ] = ( char ) 0;
+
+                    if( uxNumAddresses > ( size_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY )
+                    {
+                        uxNumAddresses = ( size_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY;
+                    }
+
+                    /* The comparison is made this way to survive a wrap-around of the time. */
+                    if( ( pxRecord->pcName[ 0 ] != ( char ) 0 ) &&
+                        ( ( int32_t ) ( pxRecord->ulExpiryTime - ulWallClock ) > 0 ) )
+                    {
+                        uint32_t ulTTL = FreeRTOS_htonl( pxRecord->ulExpiryTime - ulWallClock );
+
+                        for( uxAddress = 0U; uxAddress < uxNumAddresses; uxAddress++ )
+                        {
+                            /* The first address inserts the entry, the others are added to it. */
+                            ( void ) FreeRTOS_ProcessDNSCache( pxRecord->pcName, &( pxRecord->xAddresses[ uxAddress ] ), ulTTL, pdFALSE, NULL );
+                        }
+
+                        uxRestored++;
+                    }
+                }
+
+                FreeRTOS_printf( ( "vDNSCacheRestore: %u of %u entries are still valid\n",
+                                   ( unsigned ) uxRestored,
+                                   ( unsigned ) uxCount ) );
+
+                vPortFree( pxRecords );
+            }
+        }
+    #endif /* ( ipconfigUSE_DNS_CACHE_PERSISTENCE != 0 ) */
+/*-----------------------------------------------------------*/
+
 #endif /* if ( ( ipconfigUSE_DNS != 0 ) && ( ipconfigUSE_DNS_CACHE == 1 ) ) */
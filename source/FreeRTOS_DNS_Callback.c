@@ -35,6 +35,7 @@
 #include "FreeRTOS_IP.h"
 #include "FreeRTOS_IP_Private.h"
 #include "FreeRTOS_DNS_Globals.h"
+#include "FreeRTOS_DNS_Parser.h"
 #include "FreeRTOS_IP_Timers.h"
 
 #if ( ( ipconfigDNS_USE_CALLBACKS == 1 ) && ( ipconfigUSE_DNS != 0 ) )
@@ -44,6 +45,125 @@
  */
     static List_t xCallbackList;
 
+    #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+
+/** @brief Get the bucket of a transaction ID. */
+        #define dnsCALLBACK_BUCKET( uxIdentifier )    ( ( size_t ) ( uxIdentifier ) & ( ( size_t ) ipconfigDNS_ASYNC_TABLE_SIZE - 1U ) )
+
+/**
+ * @brief The entries of xCallbackList, hashed on their transaction ID.
+ */
+        static DNSCallback_t * pxCallbackTable[ ipconfigDNS_ASYNC_TABLE_SIZE ];
+    #endif
+
+/**
+ * @brief Remove an entry from xCallbackList, and from the hash table if in use.
+ *        Must be called while the scheduler is suspended.
+ *
+ * @param[in] pxCallback The entry to be removed.
+ */
+    static void prvRemoveCallback( DNSCallback_t * pxCallback )
+    {
+        ( void ) uxListRemove( &( pxCallback->xListItem ) );
+
+        #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+        {
+            DNSCallback_t ** ppxEntry = &( pxCallbackTable[ dnsCALLBACK_BUCKET( listGET_LIST_ITEM_VALUE( &( pxCallback->xListItem ) ) ) ] );
+
+            while( *( ppxEntry ) != NULL )
+            {
+                if( *( ppxEntry ) == pxCallback )
+                {
+                    *( ppxEntry ) = pxCallback->pxNextInBucket;
+                    break;
+                }
+
+                ppxEntry = &( ( *( ppxEntry ) )->pxNextInBucket );
+            }
+        }
+        #endif /* ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 ) */
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the outstanding look-up that a DNS reply belongs to. A DNS reply
+ *        is matched on its transaction ID, an mDNS reply on the name.
+ *        Must be called while the scheduler is suspended.
+ *
+ * @param[in] pxSet a set of variables that are shared among the helper functions.
+ *
+ * @return The matching entry, or NULL when there is none.
+ */
+    static DNSCallback_t * prvFindCallback( const ParseSet_t * pxSet )
+    {
+        DNSCallback_t * pxFound = NULL;
+        const ListItem_t * pxIterator;
+        const ListItem_t * xEnd = listGET_END_MARKER( &xCallbackList );
+        TickType_t uxIdentifier = ( TickType_t ) pxSet->pxDNSMessageHeader->usIdentifier;
+        BaseType_t xUseList = pdTRUE;
+
+        #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+        {
+            #if ( ipconfigUSE_MDNS == 1 )
+                /* mDNS replies are matched on the name, search the list. */
+                if( pxSet->usPortNumber != FreeRTOS_htons( ipMDNS_PORT ) )
+            #endif
+            {
+                /* Only the entries with the same hash need to be inspected. */
+                for( pxFound = pxCallbackTable[ dnsCALLBACK_BUCKET( uxIdentifier ) ];
+                     pxFound != NULL;
+                     pxFound = pxFound->pxNextInBucket )
+                {
+                    if( listGET_LIST_ITEM_VALUE( &( pxFound->xListItem ) ) == uxIdentifier )
+                    {
+                        break;
+                    }
+                }
+
+                xUseList = pdFALSE;
+            }
+        }
+        #endif /* ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 ) */
+
+        for( pxIterator = ( const ListItem_t * ) listGET_NEXT( xEnd );
+             ( xUseList != pdFALSE ) && ( pxIterator != ( const ListItem_t * ) xEnd );
+             pxIterator = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+        {
+            BaseType_t xMatching;
+            DNSCallback_t * pxCallback = ( ( DNSCallback_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+            #if ( ipconfigUSE_MDNS == 1 )
+                /* mDNS port 5353. */
+                if( pxSet->usPortNumber == FreeRTOS_htons( ipMDNS_PORT ) )
+                {
+                    /* In mDNS, the query ID field is ignored and the
+                     * hostname will be compared with outstanding requests. */
+                    #if ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 )
+                        /* The first name in the message is compared where it is. */
+                        xMatching = DNS_NameEquals( pxSet->pucUDPPayloadBuffer,
+                                                    pxSet->uxBufferLength,
+                                                    sizeof( DNSMessage_t ),
+                                                    pxCallback->pcName );
+                    #else
+                        xMatching = ( strcasecmp( pxCallback->pcName, pxSet->pcName ) == 0 ) ? pdTRUE : pdFALSE;
+                    #endif
+                }
+                else
+            #endif /* if ( ipconfigUSE_MDNS == 1 ) */
+            {
+                xMatching = ( listGET_LIST_ITEM_VALUE( pxIterator ) == uxIdentifier ) ? pdTRUE : pdFALSE;
+            }
+
+            if( xMatching == pdTRUE )
+            {
+                pxFound = pxCallback;
+                break;
+            }
+        }
+
+        return pxFound;
+    }
+/*-----------------------------------------------------------*/
+
 /**
  * @brief A DNS reply was received, see if there is any matching entry and
  *        call the handler.
@@ -57,9 +177,6 @@
                                struct freertos_addrinfo * pxAddress )
     {
         BaseType_t xResult = pdFALSE;
-        const ListItem_t * pxIterator;
-        const ListItem_t * xEnd = listGET_END_MARKER( &xCallbackList );
-        TickType_t uxIdentifier = ( TickType_t ) pxSet->pxDNSMessageHeader->usIdentifier;
 
         /* While iterating through the list, the scheduler is suspended.
          * Remember which function shall be called once the scheduler is
@@ -69,43 +186,22 @@
 
         vTaskSuspendAll();
         {
-            for( pxIterator = ( const ListItem_t * ) listGET_NEXT( xEnd );
-                 pxIterator != ( const ListItem_t * ) xEnd;
-                 pxIterator = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+            DNSCallback_t * pxFound = prvFindCallback( pxSet );
+
+            if( pxFound != NULL )
             {
-                BaseType_t xMatching;
-                DNSCallback_t * pxCallback = ( ( DNSCallback_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
-                #if ( ipconfigUSE_MDNS == 1 )
-                    /* mDNS port 5353. */
-                    if( pxSet->usPortNumber == FreeRTOS_htons( ipMDNS_PORT ) )
-                    {
-                        /* In mDNS, the query ID field is ignored and the
-                         * hostname will be compared with outstanding requests. */
+                pvSearchID = pxFound->pvSearchID;
+                pCallbackFunction = pxFound->pCallbackFunction;
+                prvRemoveCallback( pxFound );
+                vPortFree( pxFound );
 
-                        xMatching = ( strcasecmp( pxCallback->pcName, pxSet->pcName ) == 0 ) ? pdTRUE : pdFALSE;
-                    }
-                    else
-                #endif /* if ( ipconfigUSE_MDNS == 1 ) */
+                if( listLIST_IS_EMPTY( &xCallbackList ) != pdFALSE )
                 {
-                    xMatching = ( listGET_LIST_ITEM_VALUE( pxIterator ) == uxIdentifier ) ? pdTRUE : pdFALSE;
+                    /* The list of outstanding requests is empty. No need for periodic polling. */
+                    vIPSetDNSTimerEnableState( pdFALSE );
                 }
 
-                if( xMatching == pdTRUE )
-                {
-                    pvSearchID = pxCallback->pvSearchID;
-                    pCallbackFunction = pxCallback->pCallbackFunction;
-                    ( void ) uxListRemove( &pxCallback->xListItem );
-                    vPortFree( pxCallback );
-
-                    if( listLIST_IS_EMPTY( &xCallbackList ) != pdFALSE )
-                    {
-                        /* The list of outstanding requests is empty. No need for periodic polling. */
-                        vIPSetDNSTimerEnableState( pdFALSE );
-                    }
-
-                    xResult = pdTRUE;
-                    break;
-                }
+                xResult = pdTRUE;
             }
         }
         ( void ) xTaskResumeAll();
@@ -117,6 +213,35 @@
 
         return xResult;
     }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 )
+
+/**
+ * @brief Check if a DNS reply that was not expected belongs to an outstanding
+ *        asynchronous look-up. The reply has not been decoded yet.
+ *
+ * @param[in] pxSet a set of variables that are shared among the helper functions.
+ *
+ * @return pdTRUE when somebody is waiting for the reply.
+ */
+        BaseType_t xDNSCallbackIsPending( const ParseSet_t * pxSet )
+        {
+            BaseType_t xResult = pdFALSE;
+
+            vTaskSuspendAll();
+            {
+                if( prvFindCallback( pxSet ) != NULL )
+                {
+                    xResult = pdTRUE;
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            return xResult;
+        }
+    #endif /* ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 ) */
+/*-----------------------------------------------------------*/
 
 /**
  * @brief FreeRTOS_gethostbyname_a() was called along with callback parameters.
@@ -167,6 +292,15 @@
             vTaskSuspendAll();
             {
                 vListInsertEnd( &xCallbackList, &pxCallback->xListItem );
+
+                #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+                {
+                    size_t uxBucket = dnsCALLBACK_BUCKET( uxIdentifier );
+
+                    pxCallback->pxNextInBucket = pxCallbackTable[ uxBucket ];
+                    pxCallbackTable[ uxBucket ] = pxCallback;
+                }
+                #endif
             }
             ( void ) xTaskResumeAll();
         }
@@ -215,14 +349,14 @@
 
                 if( ( pvSearchID != NULL ) && ( pvSearchID == pxCallback->pvSearchID ) )
                 {
-                    ( void ) uxListRemove( &( pxCallback->xListItem ) );
+                    prvRemoveCallback( pxCallback );
                     vPortFree( pxCallback );
                 }
                 else if( xTaskCheckForTimeOut( &pxCallback->uxTimeoutState, &( pxCallback->uxRemainingTime ) ) != pdFALSE )
                 {
                     /* A time-out occurred in the asynchronous search.
                      * Remove it from xCallbackList. */
-                    ( void ) uxListRemove( &( pxCallback->xListItem ) );
+                    prvRemoveCallback( pxCallback );
 
                     /* Insert it in a temporary list. The function will be called
                      * once the scheduler is resumed. */
@@ -280,5 +414,11 @@
     void vDNSCallbackInitialise()
     {
         vListInitialise( &xCallbackList );
+
+        #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+        {
+            ( void ) memset( pxCallbackTable, 0, sizeof( pxCallbackTable ) );
+        }
+        #endif
     }
 #endif /* if ( ipconfigDNS_USE_CALLBACKS == 1 ) */
@@ -34,9 +34,28 @@
 #include "FreeRTOS.h"
 
 #include "FreeRTOS_DNS_Networking.h"
+#include "FreeRTOS_DNS_Parser.h"
 
 #if ( ipconfigUSE_DNS != 0 )
 
+    #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+
+/** @brief The socket that is shared by all asynchronous look-ups. */
+        static Socket_t xSharedDNSSocket = NULL;
+
+/** @brief pdTRUE while a task is creating xSharedDNSSocket. */
+        static BaseType_t xSharedDNSSocketBusy = pdFALSE;
+
+/*
+ * Called from the IP-task when a reply is received on the shared socket.
+ */
+        static BaseType_t prvOnSharedDNSReceive( Socket_t xSocket,
+                                                 void * pvData,
+                                                 size_t uxLength,
+                                                 const struct freertos_sockaddr * pxFrom,
+                                                 const struct freertos_sockaddr * pxDest );
+    #endif
+
 /**
  * @brief Bind the socket to a port number.
  * @param[in] xSocket the socket that must be bound.
@@ -161,6 +180,118 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+
+/**
+ * @brief Handle a reply that was received on the shared DNS socket. The
+ *        reply is matched against the outstanding look-ups by its
+ *        transaction ID, and the user's call-back is called.
+ *
+ * @param[in] xSocket The shared DNS socket.
+ * @param[in] pvData The UDP payload.
+ * @param[in] uxLength The length of the UDP payload.
+ * @param[in] pxFrom The address of the DNS server.
+ * @param[in] pxDest The local address.
+ *
+ * @return Always 1: the packet has been consumed.
+ */
+        static BaseType_t prvOnSharedDNSReceive( Socket_t xSocket,
+                                                 void * pvData,
+                                                 size_t uxLength,
+                                                 const struct freertos_sockaddr * pxFrom,
+                                                 const struct freertos_sockaddr * pxDest )
+        {
+            struct freertos_addrinfo * pxAddressInfo = NULL;
+
+            ( void ) xSocket;
+            ( void ) pxDest;
+
+            if( uxLength >= sizeof( DNSMessage_t ) )
+            {
+                /* MISRA Ref 4.14.2 [The validity of values received from external sources]. */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-414. */
+                /* coverity[misra_c_2012_directive_4_14_violation] */
+                ( void ) DNS_ParseDNSReply( ( uint8_t * ) pvData,
+                                            uxLength,
+                                            &( pxAddressInfo ),
+                                            pdFALSE,
+                                            FreeRTOS_ntohs( pxFrom->sin_port ) );
+
+                if( pxAddressInfo != NULL )
+                {
+                    FreeRTOS_freeaddrinfo( pxAddressInfo );
+                }
+            }
+
+            return 1;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the socket that is shared by all asynchronous look-ups. It is
+ *        created and bound to a random port the first time it is needed.
+ *        All replies are handled in the IP-task by prvOnSharedDNSReceive().
+ *
+ * @return The shared socket, or NULL when it is not available. In that case
+ *         the caller shall use a socket of its own.
+ */
+        Socket_t DNS_GetSharedSocket( void )
+        {
+            Socket_t xSocket = NULL;
+            BaseType_t xMustCreate = pdFALSE;
+
+            taskENTER_CRITICAL();
+            {
+                if( xSharedDNSSocket != NULL )
+                {
+                    xSocket = xSharedDNSSocket;
+                }
+                else if( xSharedDNSSocketBusy == pdFALSE )
+                {
+                    /* Only one task creates the socket. */
+                    xSharedDNSSocketBusy = pdTRUE;
+                    xMustCreate = pdTRUE;
+                }
+                else
+                {
+                    /* Another task is creating it, use a private socket. */
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xMustCreate != pdFALSE )
+            {
+                F_TCP_UDP_Handler_t xHandler;
+
+                xSocket = DNS_CreateSocket( 0U );
+
+                if( xSocket != NULL )
+                {
+                    ( void ) memset( &( xHandler ), 0, sizeof( xHandler ) );
+                    xHandler.pxOnUDPReceive = prvOnSharedDNSReceive;
+                    ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_UDP_RECV_HANDLER, &( xHandler ), sizeof( xHandler ) );
+
+                    if( DNS_BindSocket( xSocket, 0U ) != 0 )
+                    {
+                        FreeRTOS_printf( ( "DNS_GetSharedSocket: bind failed\n" ) );
+                        DNS_CloseSocket( xSocket );
+                        xSocket = NULL;
+                    }
+                }
+
+                taskENTER_CRITICAL();
+                {
+                    xSharedDNSSocket = xSocket;
+                    xSharedDNSSocketBusy = pdFALSE;
+                }
+                taskEXIT_CRITICAL();
+            }
+
+            return xSocket;
+        }
+/*-----------------------------------------------------------*/
+    #endif /* ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 ) */
+
 /**
  * @brief perform a DNS network close
  * @param xDNSSocket the DNS socket to close
@@ -233,6 +233,335 @@
         return uxIndex;
     }
 
+    #if ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 )
+
+/** @brief The number of compression pointers that may be followed in one name. */
+        #define dnsMAX_NAME_POINTERS    16U
+
+/**
+ * @brief Get the lower-case version of an ASCII character.
+ *
+ * @param[in] ucChar The character.
+ *
+ * @return The character, with 'A' to 'Z' translated to 'a' to 'z'.
+ */
+        static uint8_t prvLowerCase( uint8_t ucChar )
+        {
+            uint8_t ucReturn = ucChar;
+
+            if( ( ucChar >= ( uint8_t ) 'A' ) && ( ucChar <= ( uint8_t ) 'Z' ) )
+            {
+                ucReturn = ( uint8_t ) ( ucChar + ( ( uint8_t ) 'a' - ( uint8_t ) 'A' ) );
+            }
+
+            return ucReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the length byte of the next label of a name, following
+ *        compression pointers.
+ *
+ * @param[in] pucBuffer The DNS message.
+ * @param[in] uxBufferLength The length of the DNS message.
+ * @param[in] uxOffset The offset of a label, or of a compression pointer.
+ * @param[in,out] puxPointers The number of pointers followed so far.
+ *
+ * @return The offset of a label whose length byte and characters are all
+ *         within the message, or uxBufferLength in case of an error.
+ */
+        static size_t prvNextLabel( const uint8_t * pucBuffer,
+                                    size_t uxBufferLength,
+                                    size_t uxOffset,
+                                    size_t * puxPointers )
+        {
+            size_t uxIndex = uxOffset;
+
+            while( uxIndex < uxBufferLength )
+            {
+                if( ( pucBuffer[ uxIndex ] & dnsNAME_IS_OFFSET ) == dnsNAME_IS_OFFSET )
+                {
+                    if( ( ( uxIndex + 1U ) >= uxBufferLength ) || ( *( puxPointers ) >= dnsMAX_NAME_POINTERS ) )
+                    {
+                        uxIndex = uxBufferLength;
+                    }
+                    else
+                    {
+                        *( puxPointers ) += 1U;
+                        uxIndex = ( ( ( size_t ) pucBuffer[ uxIndex ] & 0x3FU ) << 8 ) | ( size_t ) pucBuffer[ uxIndex + 1U ];
+                    }
+                }
+                else
+                {
+                    if( ( ( pucBuffer[ uxIndex ] & dnsNAME_IS_OFFSET ) != 0U ) ||
+                        ( ( uxIndex + 1U + ( size_t ) pucBuffer[ uxIndex ] ) > uxBufferLength ) )
+                    {
+                        /* A reserved label type, or a label that is truncated. */
+                        uxIndex = uxBufferLength;
+                    }
+
+                    break;
+                }
+            }
+
+            return uxIndex;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Compare a name in a DNS message with a string, without copying it.
+ *        Compression pointers are followed, the comparison is case-insensitive.
+ *
+ * @param[in] pucBuffer The DNS message.
+ * @param[in] uxBufferLength The length of the DNS message.
+ * @param[in] uxOffset The offset of the name in the message.
+ * @param[in] pcName A name like "www.freertos.org".
+ *
+ * @return pdTRUE when the names are equal.
+ */
+        BaseType_t DNS_NameEquals( const uint8_t * pucBuffer,
+                                   size_t uxBufferLength,
+                                   size_t uxOffset,
+                                   const char * pcName )
+        {
+            BaseType_t xReturn = pdFALSE;
+            size_t uxPointers = 0U;
+            size_t uxIndex = uxOffset;
+            size_t uxNameIndex = 0U;
+
+            for( ; ; )
+            {
+                size_t uxCount;
+
+                uxIndex = prvNextLabel( pucBuffer, uxBufferLength, uxIndex, &( uxPointers ) );
+
+                if( uxIndex >= uxBufferLength )
+                {
+                    break;
+                }
+
+                uxCount = ( size_t ) pucBuffer[ uxIndex ];
+
+                if( uxCount == 0U )
+                {
+                    /* The end of the name, the string must end as well. */
+                    xReturn = ( pcName[ uxNameIndex ] == '\0' ) ? pdTRUE : pdFALSE;
+                    break;
+                }
+
+                if( uxNameIndex != 0U )
+                {
+                    if( pcName[ uxNameIndex ] != '.' )
+                    {
+                        break;
+                    }
+
+                    uxNameIndex++;
+                }
+
+                uxIndex++;
+
+                while( uxCount > 0U )
+                {
+                    /* The terminating null of pcName never matches a valid character. */
+                    if( ( pcName[ uxNameIndex ] == '\0' ) ||
+                        ( prvLowerCase( pucBuffer[ uxIndex ] ) != prvLowerCase( ( uint8_t ) pcName[ uxNameIndex ] ) ) )
+                    {
+                        break;
+                    }
+
+                    uxNameIndex++;
+                    uxIndex++;
+                    uxCount--;
+                }
+
+                if( uxCount != 0U )
+                {
+                    break;
+                }
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Compare two names in a DNS message, without copying them.
+ *        Compression pointers are followed, the comparison is case-insensitive.
+ *
+ * @param[in] pucBuffer The DNS message.
+ * @param[in] uxBufferLength The length of the DNS message.
+ * @param[in] uxOffset1 The offset of the first name.
+ * @param[in] uxOffset2 The offset of the second name.
+ *
+ * @return pdTRUE when the names are equal.
+ */
+        static BaseType_t prvNamesEqual( const uint8_t * pucBuffer,
+                                         size_t uxBufferLength,
+                                         size_t uxOffset1,
+                                         size_t uxOffset2 )
+        {
+            BaseType_t xReturn = pdFALSE;
+            size_t uxPointers1 = 0U;
+            size_t uxPointers2 = 0U;
+            size_t uxIndex1 = uxOffset1;
+            size_t uxIndex2 = uxOffset2;
+
+            for( ; ; )
+            {
+                size_t uxCount;
+
+                uxIndex1 = prvNextLabel( pucBuffer, uxBufferLength, uxIndex1, &( uxPointers1 ) );
+                uxIndex2 = prvNextLabel( pucBuffer, uxBufferLength, uxIndex2, &( uxPointers2 ) );
+
+                if( ( uxIndex1 >= uxBufferLength ) || ( uxIndex2 >= uxBufferLength ) )
+                {
+                    break;
+                }
+
+                if( uxIndex1 == uxIndex2 )
+                {
+                    /* Both names continue with the same bytes. */
+                    xReturn = pdTRUE;
+                    break;
+                }
+
+                uxCount = ( size_t ) pucBuffer[ uxIndex1 ];
+
+                if( uxCount != ( size_t ) pucBuffer[ uxIndex2 ] )
+                {
+                    break;
+                }
+
+                if( uxCount == 0U )
+                {
+                    xReturn = pdTRUE;
+                    break;
+                }
+
+                uxIndex1++;
+                uxIndex2++;
+
+                while( uxCount > 0U )
+                {
+                    if( prvLowerCase( pucBuffer[ uxIndex1 ] ) != prvLowerCase( pucBuffer[ uxIndex2 ] ) )
+                    {
+                        break;
+                    }
+
+                    uxIndex1++;
+                    uxIndex2++;
+                    uxCount--;
+                }
+
+                if( uxCount != 0U )
+                {
+                    break;
+                }
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a reply that was not expected is still of any use, i.e. if
+ *        an asynchronous look-up is waiting for it.
+ *
+ * @param[in] pxSet a set of variables that are shared among the helper functions.
+ *
+ * @return pdTRUE when the reply must be decoded.
+ */
+        static BaseType_t prvReplyIsWanted( const ParseSet_t * pxSet )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            #if ( ipconfigDNS_USE_CALLBACKS == 1 )
+            {
+                xReturn = xDNSCallbackIsPending( pxSet );
+            }
+            #else
+            {
+                ( void ) pxSet;
+            }
+            #endif
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+    #endif /* ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 ) */
+
+    #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+
+/**
+ * @brief Find the time-to-live of a negative answer, as described in RFC 2308:
+ *        the smaller of the TTL and the MINIMUM field of the SOA record in the
+ *        authority section.
+ *
+ * @param[in] pxSet a set of variables that are shared among the helper functions.
+ *                  pucByte must point to the first answer record.
+ *
+ * @return The number of seconds that the negative answer may be cached.
+ */
+        static uint32_t prvReadNegativeTTL( const ParseSet_t * pxSet )
+        {
+            const uint8_t * pucByte = pxSet->pucByte;
+            size_t uxRemaining = pxSet->uxSourceBytesRemaining;
+            size_t uxResult;
+            size_t uxDataLength;
+            uint32_t ulTTL = ipconfigDNS_NEGATIVE_CACHE_TTL;
+            uint32_t ulMinimum;
+            uint16_t usRecords = ( uint16_t ) ( pxSet->usAnswers + FreeRTOS_ntohs( pxSet->pxDNSMessageHeader->usAuthorityRRs ) );
+            uint16_t x;
+
+            for( x = 0U; x < usRecords; x++ )
+            {
+                uxResult = DNS_SkipNameField( pucByte, uxRemaining );
+
+                /* Check for a malformed record. */
+                if( ( uxResult == 0U ) || ( ( uxRemaining - uxResult ) < sizeof( DNSAnswerRecord_t ) ) )
+                {
+                    break;
+                }
+
+                pucByte = &( pucByte[ uxResult ] );
+                uxRemaining -= uxResult;
+                uxDataLength = ( size_t ) usChar2u16( &( pucByte[ 8 ] ) );
+
+                if( ( uxRemaining - sizeof( DNSAnswerRecord_t ) ) < uxDataLength )
+                {
+                    break;
+                }
+
+                /* An SOA record has two names followed by 5 32-bit fields, the last one is MINIMUM. */
+                if( ( x >= pxSet->usAnswers ) &&
+                    ( usChar2u16( pucByte ) == dnsTYPE_SOA ) &&
+                    ( uxDataLength >= ( 2U + ( 5U * sizeof( uint32_t ) ) ) ) )
+                {
+                    ulTTL = ulChar2u32( &( pucByte[ 4 ] ) );
+                    ulMinimum = ulChar2u32( &( pucByte[ sizeof( DNSAnswerRecord_t ) + uxDataLength - sizeof( uint32_t ) ] ) );
+
+                    if( ulMinimum < ulTTL )
+                    {
+                        ulTTL = ulMinimum;
+                    }
+
+                    if( ulTTL > ipconfigDNS_NEGATIVE_CACHE_MAX_TTL )
+                    {
+                        ulTTL = ipconfigDNS_NEGATIVE_CACHE_MAX_TTL;
+                    }
+
+                    break;
+                }
+
+                pucByte = &( pucByte[ sizeof( DNSAnswerRecord_t ) + uxDataLength ] );
+                uxRemaining -= sizeof( DNSAnswerRecord_t ) + uxDataLength;
+            }
+
+            return ulTTL;
+        }
+    #endif /* ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 ) */
+
 /**
  * @brief Process a response packet from a DNS server, or an LLMNR reply.
  *
@@ -297,6 +626,11 @@
                 size_t uxResult;
                 BaseType_t xIsResponse = pdFALSE;
 
+                #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+                    BaseType_t xIsNegative = pdFALSE;
+                    uint16_t usQuestionType = 0U;
+                #endif
+
                 /* Start at the first byte after the header. */
                 xSet.pucUDPPayloadBuffer = pucUDPPayloadBuffer;
                 /* Skip 12-byte header. */
@@ -312,11 +646,29 @@
                 {
                     xIsResponse = pdTRUE;
 
+                    #if ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 )
+                        if( ( xExpected == pdFALSE ) && ( prvReplyIsWanted( &( xSet ) ) == pdFALSE ) )
+                        {
+                            /* Nobody is waiting for this answer, there is no need to decode it. */
+                            break;
+                        }
+                    #endif
+
                     if( xSet.usAnswers == 0U )
                     {
-                        /* This is a response that does not include answers. */
-                        xReturn = pdFALSE;
-                        break;
+                        #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+                            if( ( xSet.xDoStore != pdFALSE ) && ( xSet.usQuestions != 0U ) )
+                            {
+                                /* The name exists, but not with the requested type. */
+                                xIsNegative = pdTRUE;
+                            }
+                            else
+                        #endif
+                        {
+                            /* This is a response that does not include answers. */
+                            xReturn = pdFALSE;
+                            break;
+                        }
                     }
 
                     if( xSet.usQuestions == 0U )
@@ -334,6 +686,17 @@
                         #endif
                     }
                 }
+
+                #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+                    else if( ( ( xSet.pxDNSMessageHeader->usFlags & dnsRX_FLAGS_MASK ) == dnsNXDOMAIN_RX_FLAGS ) &&
+                             ( xSet.xDoStore != pdFALSE ) &&
+                             ( xSet.usQuestions != 0U ) )
+                    {
+                        /* The name does not exist. */
+                        xIsResponse = pdTRUE;
+                        xIsNegative = pdTRUE;
+                    }
+                #endif /* ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 ) */
                 else
                 {
                     if( xSet.usQuestions == 0U )
@@ -384,6 +747,13 @@
                     /* Check the remaining buffer size. */
                     if( xSet.uxSourceBytesRemaining >= sizeof( uint32_t ) )
                     {
+                        #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+                            if( x == 0U )
+                            {
+                                usQuestionType = usChar2u16( xSet.pucByte );
+                            }
+                        #endif
+
                         #if ( ( ipconfigUSE_LLMNR == 1 ) || ( ipconfigUSE_MDNS == 1 ) )
                         {
                             /* usChar2u16 returns value in host endianness. */
@@ -411,8 +781,21 @@
 
                 if( xIsResponse == pdTRUE )
                 {
-                    /* Search through the answer records. */
-                    ulIPAddress = parseDNSAnswer( &( xSet ), ppxAddressInfo, &uxBytesRead );
+                    #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+                        if( xIsNegative != pdFALSE )
+                        {
+                            /* Remember that the name does not resolve, so the
+                             * server will not be asked again for a while. */
+                            vDNSNegativeCacheAdd( xSet.pcName,
+                                                  ( usQuestionType == dnsTYPE_AAAA_HOST ) ? pdTRUE : pdFALSE,
+                                                  prvReadNegativeTTL( &( xSet ) ) );
+                        }
+                        else
+                    #endif /* ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 ) */
+                    {
+                        /* Search through the answer records. */
+                        ulIPAddress = parseDNSAnswer( &( xSet ), ppxAddressInfo, &uxBytesRead );
+                    }
                 }
 
                 #if ( ( ipconfigUSE_LLMNR == 1 ) || ( ipconfigUSE_MDNS == 1 ) )
@@ -485,7 +868,24 @@
                             uint8_t * pucNewBuffer = NULL;
                             size_t uxExtraLength;
 
-                            if( xBufferAllocFixedSize == pdFALSE )
+                            #if ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 )
+                                /* Only a query that holds a single question and nothing else
+                                 * can be answered from a template. Check it before the header
+                                 * is turned into a reply. */
+                                BaseType_t xStoreTemplate = pdFALSE;
+                                size_t uxQuestionLength = ( size_t ) ( xSet.pucByte - pucUDPPayloadBuffer ) - sizeof( DNSMessage_t );
+
+                                if( ( xSet.usQuestions == 1U ) &&
+                                    ( xSet.usAnswers == 0U ) &&
+                                    ( xSet.pxDNSMessageHeader->usAuthorityRRs == 0U ) &&
+                                    ( xSet.pxDNSMessageHeader->usAdditionalRRs == 0U ) &&
+                                    ( xSet.uxSourceBytesRemaining == 0U ) )
+                                {
+                                    xStoreTemplate = pdTRUE;
+                                }
+                            #endif /* ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 ) */
+
+                            if( xIsFixedSizeNetworkBuffer( pxNetworkBuffer ) == pdFALSE )
                             {
                                 size_t uxDataLength = uxBufferLength +
                                                       sizeof( UDPHeader_t ) +
@@ -578,6 +978,13 @@
                                     usLength = ( int16_t ) ( sizeof( *pxAnswer ) + uxDistance );
                                 }
 
+                                #if ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 )
+                                    if( xStoreTemplate != pdFALSE )
+                                    {
+                                        DNS_AnswerTemplateStore( pxEndPoint, xSet.usPortNumber, pucNewBuffer, ( size_t ) usLength, uxQuestionLength );
+                                    }
+                                #endif
+
                                 prepareReplyDNSMessage( pxNetworkBuffer, usLength );
                                 /* This function will fill in the eth addresses and send the packet */
                                 vReturnEthernetFrame( pxNetworkBuffer, pdFALSE );
@@ -637,9 +1044,22 @@
 
         struct freertos_addrinfo * pxNewAddress = NULL;
 
+        #if ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 )
+            /* The name that the answers must be about: the first question or,
+             * in an mDNS announcement, the first answer. It changes when a
+             * CNAME record is found. */
+            size_t uxTargetOffset = sizeof( DNSMessage_t );
+        #endif
+
         for( x = 0U; x < pxSet->usAnswers; x++ )
         {
             BaseType_t xDoAccept = pdFALSE;
+            /* Becomes pdFALSE when the record is about another name. */
+            BaseType_t xRelevant = pdTRUE;
+
+            #if ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 )
+                size_t uxOwnerOffset = ( size_t ) ( pxSet->pucByte - pxSet->pucUDPPayloadBuffer );
+            #endif
 
             if( pxSet->usNumARecordsStored >= usCount )
             {
@@ -675,7 +1095,31 @@
 
             pxSet->usType = usChar2u16( pxSet->pucByte );
 
-            if( pxSet->usType == ( uint16_t ) dnsTYPE_AAAA_HOST )
+            #if ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 )
+            {
+                /* Compare the names where they are, instead of decoding them. */
+                if( prvNamesEqual( pxSet->pucUDPPayloadBuffer, pxSet->uxBufferLength, uxOwnerOffset, uxTargetOffset ) == pdFALSE )
+                {
+                    xRelevant = pdFALSE;
+                }
+                else if( ( pxSet->usType == ( uint16_t ) dnsTYPE_CNAME ) &&
+                         ( pxSet->uxSourceBytesRemaining > sizeof( DNSAnswerRecord_t ) ) )
+                {
+                    /* An alias: the next answers are about the canonical name. */
+                    uxTargetOffset = ( size_t ) ( pxSet->pucByte - pxSet->pucUDPPayloadBuffer ) + sizeof( DNSAnswerRecord_t );
+                }
+                else
+                {
+                    /* A record about the name that was asked for. */
+                }
+            }
+            #endif /* ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 ) */
+
+            if( xRelevant == pdFALSE )
+            {
+                /* Only jump over the record below. */
+            }
+            else if( pxSet->usType == ( uint16_t ) dnsTYPE_AAAA_HOST )
             {
                 pxSet->uxAddressLength = ipSIZE_OF_IPv6_ADDRESS;
 
@@ -1014,6 +1458,317 @@
 
     #endif /* ( ipconfigUSE_MDNS == 1 ) || ( ipconfigUSE_LLMNR == 1 ) || ( ipconfigUSE_NBNS == 1 ) */
 
+    #if ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 )
+
+/* The QR bit and the opcode in the flags of a DNS, LLMNR or NBNS header, in
+ * host endianness. */
+        #define dnsTEMPLATE_FLAGS_RESPONSE       0x8000U
+        #define dnsTEMPLATE_FLAGS_OPCODE_MASK    0x7800U
+
+/** @brief A reply that was sent by the LLMNR, mDNS or NBNS responder. */
+        typedef struct xDNS_ANSWER_TEMPLATE
+        {
+            const NetworkEndPoint_t * pxEndPoint;                /**< The end-point that answered, NULL when the template is free. */
+            #if ( ipconfigUSE_IPv4 != 0 )
+                uint32_t ulIPAddress;                            /**< The IPv4 address of the end-point when the reply was made. */
+            #endif
+            #if ( ipconfigUSE_IPv6 != 0 )
+                IPv6_Address_t xIPv6Address;                     /**< The IPv6 address of the end-point when the reply was made. */
+            #endif
+            uint16_t usPort;                                     /**< The port number, it tells the protocol. */
+            uint16_t usQuestionLength;                           /**< The length of the question that follows the header. */
+            uint16_t usReplyLength;                              /**< The number of bytes in 'ucReply'. */
+            uint8_t ucReply[ ipconfigDNS_ANSWER_TEMPLATE_SIZE ]; /**< The UDP payload of the reply. */
+        } DNSAnswerTemplate_t;
+
+/** @brief The reply templates, only accessed from the IP-task. */
+        static DNSAnswerTemplate_t xAnswerTemplates[ ipconfigDNS_ANSWER_TEMPLATE_COUNT ];
+
+/** @brief The template that will be replaced next. */
+        static size_t uxNextAnswerTemplate = 0U;
+
+/** @brief Set by FreeRTOS_DNSAnswerTemplatesClear(), the IP-task empties the table. */
+        static volatile BaseType_t xAnswerTemplatesStale = pdFALSE;
+
+/**
+ * @brief Empty the template table when the application has asked for it.
+ *        Only called from the IP-task, so the table needs no locking.
+ */
+        static void prvAnswerTemplatesCheckStale( void )
+        {
+            size_t uxIndex;
+
+            if( xAnswerTemplatesStale != pdFALSE )
+            {
+                xAnswerTemplatesStale = pdFALSE;
+
+                for( uxIndex = 0U; uxIndex < ( size_t ) ipconfigDNS_ANSWER_TEMPLATE_COUNT; uxIndex++ )
+                {
+                    xAnswerTemplates[ uxIndex ].pxEndPoint = NULL;
+                }
+            }
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the template that answers a question.
+ *
+ * @param[in] pxEndPoint The end-point on which the question was received.
+ * @param[in] usPort The port number that identifies the protocol.
+ * @param[in] pucQuestion The question, the bytes following the DNS header.
+ * @param[in] uxQuestionLength The length of the question.
+ *
+ * @return The template, or NULL when there is none.
+ */
+        static DNSAnswerTemplate_t * prvAnswerTemplateFind( const NetworkEndPoint_t * pxEndPoint,
+                                                            uint16_t usPort,
+                                                            const uint8_t * pucQuestion,
+                                                            size_t uxQuestionLength )
+        {
+            DNSAnswerTemplate_t * pxReturn = NULL;
+            size_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < ( size_t ) ipconfigDNS_ANSWER_TEMPLATE_COUNT; uxIndex++ )
+            {
+                DNSAnswerTemplate_t * pxTemplate = &( xAnswerTemplates[ uxIndex ] );
+
+                if( ( pxTemplate->pxEndPoint == pxEndPoint ) &&
+                    ( pxTemplate->usPort == usPort ) &&
+                    ( ( size_t ) pxTemplate->usQuestionLength == uxQuestionLength ) &&
+                    ( memcmp( &( pxTemplate->ucReply[ sizeof( DNSMessage_t ) ] ), pucQuestion, uxQuestionLength ) == 0 ) )
+                {
+                    pxReturn = pxTemplate;
+                    break;
+                }
+            }
+
+            return pxReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Check that the address of the end-point has not changed since the
+ *        template was made.
+ *
+ * @param[in] pxTemplate The template, its end-point is still in use.
+ *
+ * @return pdTRUE when the template may be sent.
+ */
+        static BaseType_t prvAnswerTemplateIsCurrent( const DNSAnswerTemplate_t * pxTemplate )
+        {
+            BaseType_t xReturn = pdTRUE;
+
+            #if ( ipconfigUSE_IPv4 != 0 )
+                if( pxTemplate->ulIPAddress != pxTemplate->pxEndPoint->ipv4_settings.ulIPAddress )
+                {
+                    xReturn = pdFALSE;
+                }
+            #endif
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( memcmp( pxTemplate->xIPv6Address.ucBytes, pxTemplate->pxEndPoint->ipv6_settings.xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) != 0 )
+                {
+                    xReturn = pdFALSE;
+                }
+            #endif
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Keep a copy of a reply, so the same question can be answered without
+ *        decoding it again. Replies that do not fit in a template are not kept.
+ *
+ * @param[in] pxEndPoint The end-point that answered.
+ * @param[in] usPort The port number that identifies the protocol.
+ * @param[in] pucReply The UDP payload of the reply.
+ * @param[in] uxReplyLength The length of the reply.
+ * @param[in] uxQuestionLength The number of bytes after the header that must
+ *                             be equal in a query that gets this reply.
+ */
+        void DNS_AnswerTemplateStore( const NetworkEndPoint_t * pxEndPoint,
+                                      uint16_t usPort,
+                                      const uint8_t * pucReply,
+                                      size_t uxReplyLength,
+                                      size_t uxQuestionLength )
+        {
+            DNSAnswerTemplate_t * pxTemplate;
+
+            prvAnswerTemplatesCheckStale();
+
+            if( ( pxEndPoint != NULL ) &&
+                ( uxReplyLength <= sizeof( xAnswerTemplates[ 0 ].ucReply ) ) &&
+                ( ( sizeof( DNSMessage_t ) + uxQuestionLength ) <= uxReplyLength ) )
+            {
+                pxTemplate = prvAnswerTemplateFind( pxEndPoint, usPort, &( pucReply[ sizeof( DNSMessage_t ) ] ), uxQuestionLength );
+
+                if( pxTemplate == NULL )
+                {
+                    pxTemplate = &( xAnswerTemplates[ uxNextAnswerTemplate ] );
+                    uxNextAnswerTemplate = ( uxNextAnswerTemplate + 1U ) % ( size_t ) ipconfigDNS_ANSWER_TEMPLATE_COUNT;
+                }
+
+                pxTemplate->pxEndPoint = pxEndPoint;
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    pxTemplate->ulIPAddress = pxEndPoint->ipv4_settings.ulIPAddress;
+                #endif
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    ( void ) memcpy( pxTemplate->xIPv6Address.ucBytes, pxEndPoint->ipv6_settings.xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                #endif
+                pxTemplate->usPort = usPort;
+                pxTemplate->usQuestionLength = ( uint16_t ) uxQuestionLength;
+                pxTemplate->usReplyLength = ( uint16_t ) uxReplyLength;
+                ( void ) memcpy( pxTemplate->ucReply, pucReply, uxReplyLength );
+            }
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Answer an LLMNR, mDNS or NBNS query from a template, if there is one
+ *        for its question. Only the transaction ID of the query is kept, the
+ *        rest of the payload is copied from the template.
+ *
+ * @param[in] pucUDPPayloadBuffer The UDP payload of the query.
+ * @param[in] uxBufferLength The length of the UDP payload.
+ * @param[in] usPort The port number that identifies the protocol.
+ *
+ * @return pdTRUE when a reply was sent, pdFALSE when the query must be handled
+ *         as usual.
+ */
+        BaseType_t DNS_AnswerFromTemplate( uint8_t * pucUDPPayloadBuffer,
+                                           size_t uxBufferLength,
+                                           uint16_t usPort )
+        {
+            BaseType_t xReturn = pdFALSE;
+            NetworkBufferDescriptor_t * pxNetworkBuffer;
+            NetworkBufferDescriptor_t * pxReplyBuffer;
+            NetworkBufferDescriptor_t * pxNewBuffer = NULL;
+            const DNSAnswerTemplate_t * pxTemplate;
+            size_t uxQuestionLength;
+            size_t uxUDPOffset;
+            uint16_t usFlags;
+
+            prvAnswerTemplatesCheckStale();
+
+            /* Introduce a do {} while (0) loop to allow the use of breaks. */
+            do
+            {
+                if( uxBufferLength <= sizeof( DNSMessage_t ) )
+                {
+                    break;
+                }
+
+                usFlags = usChar2u16( &( pucUDPPayloadBuffer[ offsetof( DNSMessage_t, usFlags ) ] ) );
+
+                if( ( usFlags & ( dnsTEMPLATE_FLAGS_RESPONSE | dnsTEMPLATE_FLAGS_OPCODE_MASK ) ) != 0U )
+                {
+                    /* Not a standard query. */
+                    break;
+                }
+
+                #if ( ipconfigUSE_NBNS == 1 )
+                    if( usPort == ipNBNS_PORT )
+                    {
+                        /* The question is the encoded name, which has a fixed length. */
+                        if( ( uxBufferLength < sizeof( NBNSRequest_t ) ) ||
+                            ( usChar2u16( &( pucUDPPayloadBuffer[ offsetof( NBNSRequest_t, usType ) ] ) ) != dnsNBNS_TYPE_NET_BIOS ) )
+                        {
+                            break;
+                        }
+
+                        uxQuestionLength = offsetof( NBNSRequest_t, usType ) - sizeof( DNSMessage_t );
+                    }
+                    else
+                #endif /* ( ipconfigUSE_NBNS == 1 ) */
+                {
+                    /* A single question and nothing else. */
+                    if( ( usChar2u16( &( pucUDPPayloadBuffer[ offsetof( DNSMessage_t, usQuestions ) ] ) ) != 1U ) ||
+                        ( usChar2u16( &( pucUDPPayloadBuffer[ offsetof( DNSMessage_t, usAnswers ) ] ) ) != 0U ) ||
+                        ( usChar2u16( &( pucUDPPayloadBuffer[ offsetof( DNSMessage_t, usAuthorityRRs ) ] ) ) != 0U ) ||
+                        ( usChar2u16( &( pucUDPPayloadBuffer[ offsetof( DNSMessage_t, usAdditionalRRs ) ] ) ) != 0U ) )
+                    {
+                        break;
+                    }
+
+                    uxQuestionLength = uxBufferLength - sizeof( DNSMessage_t );
+                }
+
+                pxNetworkBuffer = pxUDPPayloadBuffer_to_NetworkBuffer( pucUDPPayloadBuffer );
+
+                if( ( pxNetworkBuffer == NULL ) || ( pxNetworkBuffer->pxEndPoint == NULL ) )
+                {
+                    break;
+                }
+
+                pxTemplate = prvAnswerTemplateFind( pxNetworkBuffer->pxEndPoint,
+                                                    usPort,
+                                                    &( pucUDPPayloadBuffer[ sizeof( DNSMessage_t ) ] ),
+                                                    uxQuestionLength );
+
+                if( ( pxTemplate == NULL ) || ( prvAnswerTemplateIsCurrent( pxTemplate ) == pdFALSE ) )
+                {
+                    /* The template will be replaced when the query has been answered. */
+                    break;
+                }
+
+                uxUDPOffset = ( size_t ) ( pucUDPPayloadBuffer - pxNetworkBuffer->pucEthernetBuffer );
+
+                if( xIsFixedSizeNetworkBuffer( pxNetworkBuffer ) == pdFALSE )
+                {
+                    /* The reply is longer than the query, get a bigger buffer. */
+                    pxNewBuffer = pxDuplicateNetworkBufferWithDescriptor( pxNetworkBuffer,
+                                                                          uxUDPOffset + pxTemplate->usReplyLength );
+
+                    if( pxNewBuffer == NULL )
+                    {
+                        break;
+                    }
+
+                    pxReplyBuffer = pxNewBuffer;
+                }
+                else
+                {
+                    /* BufferAllocation_1.c is used, the Network Buffers can contain at least
+                     * ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER. */
+                    configASSERT( ( uxUDPOffset + pxTemplate->usReplyLength ) < ( ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ) );
+                    pxReplyBuffer = pxNetworkBuffer;
+                }
+
+                /* Leave the transaction ID of the query in place, and copy the rest. */
+                ( void ) memcpy( &( pxReplyBuffer->pucEthernetBuffer[ uxUDPOffset + sizeof( uint16_t ) ] ),
+                                 &( pxTemplate->ucReply[ sizeof( uint16_t ) ] ),
+                                 ( size_t ) pxTemplate->usReplyLength - sizeof( uint16_t ) );
+
+                prepareReplyDNSMessage( pxReplyBuffer, ( BaseType_t ) pxTemplate->usReplyLength );
+
+                /* This function will fill in the eth addresses and send the packet */
+                vReturnEthernetFrame( pxReplyBuffer, pdFALSE );
+
+                if( pxNewBuffer != NULL )
+                {
+                    vReleaseNetworkBufferAndDescriptor( pxNewBuffer );
+                }
+
+                xReturn = pdTRUE;
+            } while( ipFALSE_BOOL );
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Forget all reply templates. The table is emptied by the IP-task
+ *        before it is used again.
+ */
+        void FreeRTOS_DNSAnswerTemplatesClear( void )
+        {
+            xAnswerTemplatesStale = pdTRUE;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 ) */
+
     #if ( ipconfigUSE_NBNS == 1 )
 
 /**
@@ -1186,7 +1941,7 @@
                  * that were already present. */
                 uxSizeNeeded = pxNetworkBuffer->xDataLength + sizeof( NBNSAnswer_t ) - 2 * sizeof( uint16_t );
 
-                if( xBufferAllocFixedSize == pdFALSE )
+                if( xIsFixedSizeNetworkBuffer( pxNetworkBuffer ) == pdFALSE )
                 {
                     /* We're linked with BufferAllocation_2.c
                      * pxResizeNetworkBufferWithDescriptor() will malloc a new bigger buffer,
@@ -1235,6 +1990,17 @@
 
                 usLength = ( uint16_t ) ( sizeof( NBNSAnswer_t ) + ( size_t ) offsetof( NBNSRequest_t, usType ) );
 
+                #if ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 )
+                {
+                    /* The encoded name is the question, the type has been checked already. */
+                    DNS_AnswerTemplateStore( pxNetworkBuffer->pxEndPoint,
+                                             ipNBNS_PORT,
+                                             pucUDPPayloadBuffer,
+                                             ( size_t ) usLength,
+                                             offsetof( NBNSRequest_t, usType ) - sizeof( DNSMessage_t ) );
+                }
+                #endif
+
                 prepareReplyDNSMessage( pxNetworkBuffer, ( BaseType_t ) usLength );
 
                 /* This function will fill in the eth addresses and send the packet */
@@ -44,6 +44,7 @@
 /* FreeRTOS+TCP includes. */
 #include "FreeRTOS_IP.h"
 #include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_IP_Utils.h"
 #include "FreeRTOS_ICMP.h"
 #include "FreeRTOS_Sockets.h"
 #include "FreeRTOS_ARP.h"
@@ -58,9 +59,17 @@
  */
 #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 )
     static eFrameProcessingResult_t prvProcessICMPEchoRequest( ICMPPacket_t * const pxICMPPacket,
-                                                               const NetworkBufferDescriptor_t * const pxNetworkBuffer );
+                                                               NetworkBufferDescriptor_t * const pxNetworkBuffer );
 #endif /* ipconfigREPLY_TO_INCOMING_PINGS */
 
+/*
+ * Returns pdTRUE when the checksums of a received ping request are known to be
+ * correct, so the checksum of the reply may be derived from it.
+ */
+#if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) && ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+    static BaseType_t prvICMPChecksumVerified( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif
+
 /*
  * Processes incoming ping replies.  The application callback function
  * vApplicationPingReplyHook() is called with the results.
@@ -69,7 +78,7 @@
     static void prvProcessICMPEchoReply( ICMPPacket_t * const pxICMPPacket );
 #endif /* ipconfigSUPPORT_OUTGOING_PINGS */
 
-#if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 )
+#if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) || ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
 
 /**
  * @brief Process an ICMP packet. Only echo requests and echo replies are recognised and handled.
@@ -80,7 +89,7 @@
  * @return eReleaseBuffer when the message buffer should be released, or eReturnEthernetFrame
  *                        when the packet should be returned.
  */
-    eFrameProcessingResult_t ProcessICMPPacket( const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    eFrameProcessingResult_t ProcessICMPPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer )
     {
         eFrameProcessingResult_t eReturn = eReleaseBuffer;
 
@@ -103,7 +112,21 @@
                 case ipICMP_ECHO_REQUEST:
                     #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 )
                     {
-                        eReturn = prvProcessICMPEchoRequest( pxICMPPacket, pxNetworkBuffer );
+                        #if ( ipconfigUSE_ICMP_RATE_LIMIT != 0 )
+                            IP_Address_t xSource;
+
+                            ( void ) memset( &( xSource ), 0, sizeof( xSource ) );
+                            xSource.ulIP_IPv4 = pxICMPPacket->xIPHeader.ulSourceIPAddress;
+
+                            if( xICMPRateLimitCheck( eICMPRateEchoReply, &( xSource ) ) == pdFALSE )
+                            {
+                                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropRateLimited );
+                            }
+                            else
+                        #endif /* ( ipconfigUSE_ICMP_RATE_LIMIT != 0 ) */
+                        {
+                            eReturn = prvProcessICMPEchoRequest( pxICMPPacket, pxNetworkBuffer );
+                        }
                     }
                     #endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) */
                     break;
@@ -116,6 +139,22 @@
                     #endif /* ipconfigSUPPORT_OUTGOING_PINGS */
                     break;
 
+                #if ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
+                    case ipICMP_DEST_UNREACHABLE:
+
+                        if( pxICMPPacket->xICMPHeader.ucTypeOfService == ipICMP_CODE_FRAGMENTATION_NEEDED )
+                        {
+                            /* The next-hop MTU is stored in the second half of the
+                             * otherwise unused field ( RFC 1191 ), it is followed by
+                             * the IP header of the packet that was too big. */
+                            vTCPPathMTUReport( pdFALSE,
+                                               &( pxNetworkBuffer->pucEthernetBuffer[ sizeof( ICMPPacket_t ) ] ),
+                                               pxNetworkBuffer->xDataLength - sizeof( ICMPPacket_t ),
+                                               ( uint32_t ) FreeRTOS_ntohs( pxICMPPacket->xICMPHeader.usSequenceNumber ) );
+                        }
+                        break;
+                #endif /* ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 ) */
+
                 default:
                     /* Only ICMP echo packets are handled. */
                     break;
@@ -125,7 +164,7 @@
         return eReturn;
     }
 
-#endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) */
+#endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) || ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 ) */
 /*-----------------------------------------------------------*/
 
 #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 )
@@ -138,11 +177,13 @@
  * @returns Function returns eReturnEthernetFrame.
  */
     static eFrameProcessingResult_t prvProcessICMPEchoRequest( ICMPPacket_t * const pxICMPPacket,
-                                                               const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+                                                               NetworkBufferDescriptor_t * const pxNetworkBuffer )
     {
         ICMPHeader_t * pxICMPHeader;
         IPHeader_t * pxIPHeader;
         uint32_t ulIPAddress;
+        uint16_t usOldTypeAndCode;
+        uint16_t usNewTypeAndCode;
 
         pxICMPHeader = &( pxICMPPacket->xICMPHeader );
         pxIPHeader = &( pxICMPPacket->xIPHeader );
@@ -154,7 +195,9 @@
          * returned even if the checksum is incorrect so the other end can
          * tell that the ping was received - even if the ping reply contains
          * invalid data. */
+        ( void ) memcpy( &usOldTypeAndCode, &( pxICMPHeader->ucTypeOfMessage ), sizeof( usOldTypeAndCode ) );
         pxICMPHeader->ucTypeOfMessage = ( uint8_t ) ipICMP_ECHO_REPLY;
+        ( void ) memcpy( &usNewTypeAndCode, &( pxICMPHeader->ucTypeOfMessage ), sizeof( usNewTypeAndCode ) );
         ulIPAddress = pxIPHeader->ulDestinationIPAddress;
         pxIPHeader->ulDestinationIPAddress = pxIPHeader->ulSourceIPAddress;
         pxIPHeader->ulSourceIPAddress = ulIPAddress;
@@ -172,18 +215,40 @@
 
         #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
         {
-            /* calculate the IP header checksum, in case the driver won't do that. */
-            pxIPHeader->usHeaderChecksum = 0x00U;
-            pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderSizePacket( pxNetworkBuffer ) );
-            pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
-
-            /* calculate the ICMP checksum for an outgoing packet. */
-            ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxICMPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+            if( ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) != pdFALSE )
+            {
+                /* calculate the IP header checksum, in case the driver won't do that. */
+                pxIPHeader->usHeaderChecksum = 0x00U;
+                pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderSizePacket( pxNetworkBuffer ) );
+                pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+
+                if( prvICMPChecksumVerified( pxNetworkBuffer ) != pdFALSE )
+                {
+                    /* Only the type of the ICMP message has changed, an
+                     * incremental update saves a pass over the echo data. */
+                    pxICMPHeader->usChecksum = usIncrementalChecksum( pxICMPHeader->usChecksum, usOldTypeAndCode, usNewTypeAndCode );
+                }
+                else
+                {
+                    /* An incremental update would carry an error in the
+                     * checksum of the request over to the reply. */
+                    ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxICMPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                }
+            }
+            else
+            {
+                /* The driver inserts the checksums, many EMAC peripherals need
+                 * nulled fields for that. */
+                pxIPHeader->usHeaderChecksum = 0U;
+                pxICMPHeader->usChecksum = 0U;
+            }
         }
         #else
         {
             /* Just to prevent compiler warnings about unused parameters. */
             ( void ) pxNetworkBuffer;
+            ( void ) usOldTypeAndCode;
+            ( void ) usNewTypeAndCode;
 
             /* Many EMAC peripherals will only calculate the ICMP checksum
              * correctly if the field is nulled beforehand. */
@@ -193,6 +258,124 @@
 
         return eReturnEthernetFrame;
     }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+
+/**
+ * @brief Check if the checksums of a received ping request are known to be
+ *        correct: either they were checked in software before the request
+ *        was handled, or the driver has marked the buffer as verified.
+ *
+ * @param[in] pxNetworkBuffer The network buffer containing the request.
+ *
+ * @return pdTRUE when the checksums are known to be correct, otherwise pdFALSE.
+ */
+        static BaseType_t prvICMPChecksumVerified( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            #if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 )
+            {
+                if( ipRX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            #endif
+
+            #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            {
+                if( ( pxNetworkBuffer->ucChecksumFlags & ipBUFFER_CHECKSUM_VERIFIED ) != 0U )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            #endif
+
+            /* Avoid a warning about an unused parameter. */
+            ( void ) pxNetworkBuffer;
+
+            return xReturn;
+        }
+    #endif /* ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_DRIVER_RESPONDER != 0 )
+
+/**
+ * @brief Called by xIPDriverRespond(), outside the IP-task: turn a plain ICMP
+ *        echo request to the address of an end-point into a reply.  Anything
+ *        unusual, like IP options, fragments or odd source addresses, is left
+ *        to the IP-task.
+ *
+ * @param[in,out] pxNetworkBuffer The received frame, addressed to the MAC
+ *                                address of 'pxEndPoint'.
+ * @param[in] pxEndPoint The up end-point of the receiving interface.
+ *
+ * @return pdTRUE when the buffer now holds the reply.
+ */
+        BaseType_t xICMPRespondInDriver( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                         const NetworkEndPoint_t * pxEndPoint )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            /* A rate limit belongs to the IP-task. */
+            #if ( ipconfigUSE_ICMP_RATE_LIMIT == 0 )
+            {
+                if( pxNetworkBuffer->xDataLength >= sizeof( ICMPPacket_t ) )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    ICMPPacket_t * pxICMPPacket = ( ( ICMPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+                    const IPHeader_t * pxIPHeader = &( pxICMPPacket->xIPHeader );
+                    uint32_t ulSource = pxIPHeader->ulSourceIPAddress;
+                    size_t uxLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usLength );
+
+                    if( ( pxIPHeader->ucVersionHeaderLength == ipIPV4_VERSION_HEADER_LENGTH_MIN ) &&
+                        ( pxIPHeader->ucProtocol == ( uint8_t ) ipPROTOCOL_ICMP ) &&
+                        ( ( pxIPHeader->usFragmentOffset & ( ipFRAGMENT_OFFSET_BIT_MASK | ipFRAGMENT_FLAGS_MORE_FRAGMENTS ) ) == 0U ) &&
+                        ( pxIPHeader->ulDestinationIPAddress == pxEndPoint->ipv4_settings.ulIPAddress ) &&
+                        ( pxICMPPacket->xICMPHeader.ucTypeOfMessage == ipICMP_ECHO_REQUEST ) &&
+                        ( uxLength >= ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_ICMPv4_HEADER ) ) &&
+                        ( ( uxLength + ipSIZE_OF_ETH_HEADER ) <= pxNetworkBuffer->xDataLength ) &&
+                        ( ulSource != 0U ) &&
+                        ( ulSource != pxEndPoint->ipv4_settings.ulBroadcastAddress ) &&
+                        ( xIsIPv4Multicast( ulSource ) == pdFALSE ) &&
+                        ( xIsIPv4Loopback( ulSource ) == pdFALSE ) )
+                    {
+                        /* Drop the padding of a short frame. */
+                        pxNetworkBuffer->xDataLength = uxLength + ipSIZE_OF_ETH_HEADER;
+                        xReturn = pdTRUE;
+
+                        #if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 )
+                            if( ( ipRX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) != pdFALSE ) &&
+                                ( ( usGenerateChecksum( 0U, ( const uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER ) != ipCORRECT_CRC ) ||
+                                  ( usGenerateProtocolChecksum( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, pdFALSE ) != ipCORRECT_CRC ) ) )
+                            {
+                                /* Let the IP-task count the bad checksum. */
+                                xReturn = pdFALSE;
+                            }
+                        #endif
+                    }
+
+                    if( xReturn != pdFALSE )
+                    {
+                        ( void ) prvProcessICMPEchoRequest( pxICMPPacket, pxNetworkBuffer );
+                    }
+                }
+            }
+            #else /* if ( ipconfigUSE_ICMP_RATE_LIMIT == 0 ) */
+            {
+                ( void ) pxNetworkBuffer;
+                ( void ) pxEndPoint;
+            }
+            #endif /* if ( ipconfigUSE_ICMP_RATE_LIMIT == 0 ) */
+
+            return xReturn;
+        }
+    #endif /* ipconfigUSE_DRIVER_RESPONDER */
 
 #endif /* ipconfigREPLY_TO_INCOMING_PINGS == 1 */
 /*-----------------------------------------------------------*/
@@ -0,0 +1,1002 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_IGMP.c
+ * @brief Implements multicast group membership for the FreeRTOS+TCP network stack:
+ *        a reference counted table of joined groups, the programming of the
+ *        MAC filters of the network interfaces, and IGMPv2 / MLDv1 reports.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_IGMP.h"
+#include "NetworkInterface.h"
+#include "NetworkBufferManagement.h"
+
+#if ( ipconfigUSE_IPv4 != 0 )
+    #include "FreeRTOS_IPv4_Utils.h"
+#endif
+#if ( ipconfigUSE_IPv6 != 0 )
+    #include "FreeRTOS_IPv6_Utils.h"
+#endif
+
+/* *INDENT-OFF* */
+#if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+/* *INDENT-ON* */
+
+/** @brief The size of an IPv4 header with the 4-byte Router Alert option. */
+#define igmpIP_HEADER_LENGTH       ( ipSIZE_OF_IPv4_HEADER + 4U )
+
+/** @brief The size of the IPv6 hop-by-hop header that carries the Router Alert option. */
+#define mldHOP_BY_HOP_LENGTH       ( 8U )
+
+#if ( ipconfigUSE_IPv4 != 0 )
+
+/** @brief The IPv4 Router Alert option ( RFC 2113 ), as required by RFC 2236. */
+    static const uint8_t ucIGMPRouterAlert[ 4 ] = { 0x94U, 0x04U, 0x00U, 0x00U };
+#endif
+
+#if ( ipconfigUSE_IPv6 != 0 )
+
+/** @brief The IPv6 address ff02::2, where MLD done messages are sent to. */
+    static const uint8_t ucMLDAllRoutersIP[ ipSIZE_OF_IPv6_ADDRESS ] = { 0xffU, 0x02U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0x02U };
+#endif
+
+/** @brief An entry in the table of joined multicast groups. */
+typedef struct xMULTICAST_GROUP
+{
+    IP_Address_t xGroupAddress;       /**< The multicast address of the group. */
+    NetworkInterface_t * pxInterface; /**< The interface on which the group is joined. */
+    UBaseType_t uxUsers;              /**< The number of sockets that have joined the group. */
+    struct
+    {
+        uint32_t
+            bInUse : 1,         /**< The entry describes a group. It stays in use until the IP-task has left the group. */
+            bIPv6 : 1,          /**< The group is an IPv6 group, handled with MLD. */
+            bFilterSet : 1,     /**< The MAC address of the group has been passed to pfAddAllowedMAC(). */
+            bReportPending : 1, /**< A membership report must be sent as soon as an end-point is up. */
+            bReported : 1;      /**< A report has been sent, so leaving the group must be announced. */
+    } bits;
+} MulticastGroup_t;
+
+/** @brief The joined multicast groups. The bit numbers in 'ulMulticastGroups'
+ * of a UDP socket refer to the entries of this table.  User tasks and the IP-task
+ * access it while the scheduler is suspended. */
+static MulticastGroup_t xMulticastGroups[ ipconfigMULTICAST_GROUP_COUNT ];
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check the parameter of FREERTOS_SO_IP_ADD_MEMBERSHIP or
+ *        FREERTOS_SO_IP_DROP_MEMBERSHIP.
+ *
+ * @param[in] pxRequest The request passed to FreeRTOS_setsockopt().
+ * @param[out] pxIsIPv6 pdTRUE when the group is an IPv6 group.
+ * @param[out] ppxInterface The interface on which the group is joined.
+ *
+ * @return 0 when the request is valid, or a negative errno value.
+ */
+static BaseType_t prvCheckRequest( const FreeRTOS_MulticastRequest_t * pxRequest,
+                                   BaseType_t * pxIsIPv6,
+                                   NetworkInterface_t ** ppxInterface )
+{
+    BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+    if( pxRequest != NULL )
+    {
+        switch( pxRequest->xGroup.sin_family )
+        {
+            #if ( ipconfigUSE_IPv4 != 0 )
+                case FREERTOS_AF_INET4:
+
+                    if( xIsIPv4Multicast( pxRequest->xGroup.sin_address.ulIP_IPv4 ) == pdTRUE )
+                    {
+                        *pxIsIPv6 = pdFALSE;
+                        xReturn = 0;
+                    }
+                    break;
+            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                case FREERTOS_AF_INET6:
+
+                    if( pxRequest->xGroup.sin_address.xIP_IPv6.ucBytes[ 0 ] == 0xffU )
+                    {
+                        *pxIsIPv6 = pdTRUE;
+                        xReturn = 0;
+                    }
+                    break;
+            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+            default:
+                xReturn = -pdFREERTOS_ERRNO_EAFNOSUPPORT;
+                break;
+        }
+    }
+
+    if( xReturn == 0 )
+    {
+        *ppxInterface = pxRequest->pxInterface;
+
+        if( *ppxInterface == NULL )
+        {
+            *ppxInterface = FreeRTOS_FirstNetworkInterface();
+        }
+
+        if( *ppxInterface == NULL )
+        {
+            xReturn = -pdFREERTOS_ERRNO_EADDRNOTAVAIL;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Look up a group in the table.  Must be called while the scheduler
+ *        is suspended.
+ *
+ * @param[in] pxAddress The address of the group.
+ * @param[in] xIsIPv6 pdTRUE when it is an IPv6 group.
+ * @param[in] pxInterface The interface on which the group is joined.
+ * @param[out] pxFreeIndex When not NULL, receives the index of a free entry, or -1.
+ *
+ * @return The index of the entry, or -1 when the group is not joined.
+ */
+static BaseType_t prvFindGroup( const IP_Address_t * pxAddress,
+                                BaseType_t xIsIPv6,
+                                const NetworkInterface_t * pxInterface,
+                                BaseType_t * pxFreeIndex )
+{
+    BaseType_t xIndex;
+    BaseType_t xFound = -1;
+    const MulticastGroup_t * pxGroup;
+
+    if( pxFreeIndex != NULL )
+    {
+        *pxFreeIndex = -1;
+    }
+
+    for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_GROUP_COUNT; xIndex++ )
+    {
+        pxGroup = &( xMulticastGroups[ xIndex ] );
+
+        if( pxGroup->bits.bInUse == pdFALSE_UNSIGNED )
+        {
+            if( ( pxFreeIndex != NULL ) && ( *pxFreeIndex < 0 ) )
+            {
+                *pxFreeIndex = xIndex;
+            }
+        }
+        else if( ( pxGroup->pxInterface == pxInterface ) &&
+                 ( pxGroup->bits.bIPv6 == ( ( xIsIPv6 != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED ) ) )
+        {
+            if( xIsIPv6 != pdFALSE )
+            {
+                if( memcmp( pxGroup->xGroupAddress.xIP_IPv6.ucBytes, pxAddress->xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                {
+                    xFound = xIndex;
+                }
+            }
+            else if( pxGroup->xGroupAddress.ulIP_IPv4 == pxAddress->ulIP_IPv4 )
+            {
+                xFound = xIndex;
+            }
+            else
+            {
+                /* Another group. */
+            }
+        }
+        else
+        {
+            /* Another interface or another family. */
+        }
+
+        if( xFound >= 0 )
+        {
+            break;
+        }
+    }
+
+    return xFound;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Let the IP-task apply the changes that were made to the group table.
+ */
+static void prvMulticastNotify( void )
+{
+    if( xIsCallingFromIPTask() != pdFALSE )
+    {
+        vMulticastHandleEvent();
+    }
+    else
+    {
+        IPStackEvent_t xEvent = { eMulticastGroupEvent, NULL };
+
+        /* When the IP-task is not running yet, the changes will be applied
+         * as soon as an interface comes up. */
+        ( void ) xSendEventStructToIPTask( &xEvent, ( TickType_t ) portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Join a multicast group on behalf of a UDP socket.
+ *
+ * @param[in] pxSocket The UDP socket.
+ * @param[in] pxRequest The group and the interface.
+ *
+ * @return 0 when the group was joined, or a negative errno value.
+ */
+BaseType_t xMulticastGroupJoin( FreeRTOS_Socket_t * pxSocket,
+                                const FreeRTOS_MulticastRequest_t * pxRequest )
+{
+    BaseType_t xReturn;
+    BaseType_t xIsIPv6 = pdFALSE;
+    NetworkInterface_t * pxInterface = NULL;
+    BaseType_t xIndex;
+    BaseType_t xFreeIndex;
+    BaseType_t xNotify = pdFALSE;
+    MulticastGroup_t * pxGroup;
+
+    xReturn = prvCheckRequest( pxRequest, &xIsIPv6, &pxInterface );
+
+    if( xReturn == 0 )
+    {
+        vTaskSuspendAll();
+        {
+            xIndex = prvFindGroup( &( pxRequest->xGroup.sin_address ), xIsIPv6, pxInterface, &xFreeIndex );
+
+            if( xIndex < 0 )
+            {
+                if( xFreeIndex >= 0 )
+                {
+                    xIndex = xFreeIndex;
+                    pxGroup = &( xMulticastGroups[ xIndex ] );
+                    ( void ) memset( pxGroup, 0, sizeof( *pxGroup ) );
+                    ( void ) memcpy( &( pxGroup->xGroupAddress ), &( pxRequest->xGroup.sin_address ), sizeof( pxGroup->xGroupAddress ) );
+                    pxGroup->pxInterface = pxInterface;
+                    pxGroup->bits.bInUse = pdTRUE_UNSIGNED;
+                    pxGroup->bits.bIPv6 = ( xIsIPv6 != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+                    pxGroup->bits.bReportPending = pdTRUE_UNSIGNED;
+                }
+                else
+                {
+                    xReturn = -pdFREERTOS_ERRNO_ENOBUFS;
+                }
+            }
+            else if( ( pxSocket->u.xUDP.ulMulticastGroups & ( 1UL << ( uint32_t ) xIndex ) ) != 0U )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EADDRINUSE;
+            }
+            else
+            {
+                /* The group is already known. */
+            }
+
+            if( xReturn == 0 )
+            {
+                pxGroup = &( xMulticastGroups[ xIndex ] );
+                pxSocket->u.xUDP.ulMulticastGroups |= ( 1UL << ( uint32_t ) xIndex );
+                pxGroup->uxUsers++;
+
+                if( pxGroup->uxUsers == 1U )
+                {
+                    xNotify = pdTRUE;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xNotify != pdFALSE )
+        {
+            prvMulticastNotify();
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Leave a multicast group on behalf of a UDP socket.
+ *
+ * @param[in] pxSocket The UDP socket.
+ * @param[in] pxRequest The group and the interface.
+ *
+ * @return 0 when the group was left, or a negative errno value.
+ */
+BaseType_t xMulticastGroupLeave( FreeRTOS_Socket_t * pxSocket,
+                                 const FreeRTOS_MulticastRequest_t * pxRequest )
+{
+    BaseType_t xReturn;
+    BaseType_t xIsIPv6 = pdFALSE;
+    NetworkInterface_t * pxInterface = NULL;
+    BaseType_t xIndex;
+    BaseType_t xNotify = pdFALSE;
+
+    xReturn = prvCheckRequest( pxRequest, &xIsIPv6, &pxInterface );
+
+    if( xReturn == 0 )
+    {
+        vTaskSuspendAll();
+        {
+            xIndex = prvFindGroup( &( pxRequest->xGroup.sin_address ), xIsIPv6, pxInterface, NULL );
+
+            if( ( xIndex < 0 ) ||
+                ( ( pxSocket->u.xUDP.ulMulticastGroups & ( 1UL << ( uint32_t ) xIndex ) ) == 0U ) )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EADDRNOTAVAIL;
+            }
+            else
+            {
+                pxSocket->u.xUDP.ulMulticastGroups &= ~( 1UL << ( uint32_t ) xIndex );
+                xMulticastGroups[ xIndex ].uxUsers--;
+
+                if( xMulticastGroups[ xIndex ].uxUsers == 0U )
+                {
+                    xNotify = pdTRUE;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xNotify != pdFALSE )
+        {
+            prvMulticastNotify();
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Drop all memberships of a UDP socket that is being closed.
+ *
+ * @param[in] pxSocket The socket.
+ */
+void vMulticastSocketClose( FreeRTOS_Socket_t * pxSocket )
+{
+    BaseType_t xIndex;
+    BaseType_t xNotify = pdFALSE;
+
+    if( pxSocket->u.xUDP.ulMulticastGroups != 0U )
+    {
+        vTaskSuspendAll();
+        {
+            for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_GROUP_COUNT; xIndex++ )
+            {
+                if( ( pxSocket->u.xUDP.ulMulticastGroups & ( 1UL << ( uint32_t ) xIndex ) ) != 0U )
+                {
+                    xMulticastGroups[ xIndex ].uxUsers--;
+
+                    if( xMulticastGroups[ xIndex ].uxUsers == 0U )
+                    {
+                        xNotify = pdTRUE;
+                    }
+                }
+            }
+
+            pxSocket->u.xUDP.ulMulticastGroups = 0U;
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xNotify != pdFALSE )
+        {
+            prvMulticastNotify();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the end-point that sends the reports of a group.
+ *
+ * @param[in] pxInterface The interface of the group.
+ * @param[in] xIsIPv6 pdTRUE for an IPv6 group.
+ *
+ * @return An end-point that is up, or NULL.  For IPv6, an end-point with a
+ *         link-local address is preferred, as required by MLD.
+ */
+static NetworkEndPoint_t * prvGroupEndPoint( const NetworkInterface_t * pxInterface,
+                                             BaseType_t xIsIPv6 )
+{
+    NetworkEndPoint_t * pxEndPoint;
+    NetworkEndPoint_t * pxFound = NULL;
+
+    for( pxEndPoint = FreeRTOS_FirstEndPoint( pxInterface );
+         pxEndPoint != NULL;
+         pxEndPoint = FreeRTOS_NextEndPoint( pxInterface, pxEndPoint ) )
+    {
+        if( ( pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED ) &&
+            ( pxEndPoint->bits.bIPv6 == ( ( xIsIPv6 != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED ) ) )
+        {
+            if( pxFound == NULL )
+            {
+                pxFound = pxEndPoint;
+            }
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( ( xIsIPv6 != pdFALSE ) &&
+                    ( xIPv6_GetIPType( &( pxEndPoint->ipv6_settings.xIPAddress ) ) == eIPv6_LinkLocal ) )
+                {
+                    pxFound = pxEndPoint;
+                    break;
+                }
+            #endif
+
+            if( xIsIPv6 == pdFALSE )
+            {
+                break;
+            }
+        }
+    }
+
+    return pxFound;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the multicast MAC address of a group.
+ *
+ * @param[in] pxGroup The group.
+ * @param[out] pxMACAddress The MAC address.
+ */
+static void prvGroupMACAddress( const MulticastGroup_t * pxGroup,
+                                MACAddress_t * pxMACAddress )
+{
+    if( pxGroup->bits.bIPv6 != pdFALSE_UNSIGNED )
+    {
+        #if ( ipconfigUSE_IPv6 != 0 )
+            vSetMultiCastIPv6MacAddress( &( pxGroup->xGroupAddress.xIP_IPv6 ), pxMACAddress );
+        #endif
+    }
+    else
+    {
+        #if ( ipconfigUSE_IPv4 != 0 )
+            vSetMultiCastIPv4MacAddress( pxGroup->xGroupAddress.ulIP_IPv4, pxMACAddress );
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_IPv4 != 0 )
+
+/**
+ * @brief Send an IGMPv2 membership report or leave message.
+ *
+ * @param[in] pxEndPoint The end-point that sends the message.
+ * @param[in] ucType igmpV2_MEMBERSHIP_REPORT or igmpV2_LEAVE_GROUP.
+ * @param[in] ulGroupAddress The group, in network byte order.
+ */
+    static void prvSendIGMPMessage( NetworkEndPoint_t * pxEndPoint,
+                                    uint8_t ucType,
+                                    uint32_t ulGroupAddress )
+    {
+        NetworkBufferDescriptor_t * pxNetworkBuffer;
+        NetworkInterface_t * pxInterface = pxEndPoint->pxNetworkInterface;
+        EthernetHeader_t * pxEthernetHeader;
+        IPHeader_t * pxIPHeader;
+        IGMPHeader_t * pxIGMPHeader;
+        uint32_t ulDestination;
+        uint16_t usSum;
+        const size_t uxPacketSize = ipSIZE_OF_ETH_HEADER + igmpIP_HEADER_LENGTH + sizeof( IGMPHeader_t );
+
+        /* This is called from the IP-task, which must not block. */
+        pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxPacketSize, 0U );
+
+        if( pxNetworkBuffer != NULL )
+        {
+            /* A leave message goes to all routers, a report to the group itself. */
+            ulDestination = ( ucType == igmpV2_LEAVE_GROUP ) ? FreeRTOS_inet_addr_quick( 224U, 0U, 0U, 2U ) : ulGroupAddress;
+
+            ( void ) memset( pxNetworkBuffer->pucEthernetBuffer, 0, uxPacketSize );
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxEthernetHeader = ( ( EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxIPHeader = ( ( IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxIGMPHeader = ( ( IGMPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + igmpIP_HEADER_LENGTH ] ) );
+
+            vSetMultiCastIPv4MacAddress( ulDestination, &( pxEthernetHeader->xDestinationAddress ) );
+            ( void ) memcpy( pxEthernetHeader->xSourceAddress.ucBytes, pxEndPoint->xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+            pxEthernetHeader->usFrameType = ipIPv4_FRAME_TYPE;
+
+            /* An IP-header of 6 words, the last one being the Router Alert option.
+             * IGMP messages never leave the local network: TTL is 1. */
+            pxIPHeader->ucVersionHeaderLength = ( uint8_t ) ( 0x40U | ( igmpIP_HEADER_LENGTH >> 2 ) );
+            pxIPHeader->usLength = FreeRTOS_htons( igmpIP_HEADER_LENGTH + sizeof( IGMPHeader_t ) );
+            pxIPHeader->usIdentification = FreeRTOS_htons( usPacketIdentifier );
+            usPacketIdentifier++;
+            pxIPHeader->ucTimeToLive = 1U;
+            pxIPHeader->ucProtocol = ( uint8_t ) ipPROTOCOL_IGMP;
+            pxIPHeader->ulSourceIPAddress = pxEndPoint->ipv4_settings.ulIPAddress;
+            pxIPHeader->ulDestinationIPAddress = ulDestination;
+            ( void ) memcpy( &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER ] ), ucIGMPRouterAlert, sizeof( ucIGMPRouterAlert ) );
+
+            pxIGMPHeader->ucTypeOfMessage = ucType;
+            pxIGMPHeader->ulGroupAddress = ulGroupAddress;
+
+            /* The driver is not expected to calculate the IGMP checksum. */
+            usSum = usGenerateChecksum( 0U, ( const uint8_t * ) pxIGMPHeader, sizeof( IGMPHeader_t ) );
+            pxIGMPHeader->usChecksum = ( uint16_t ) ~FreeRTOS_htons( usSum );
+
+            #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+            {
+                usSum = usGenerateChecksum( 0U, ( const uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), igmpIP_HEADER_LENGTH );
+                pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( usSum );
+            }
+            #endif
+
+            pxNetworkBuffer->xDataLength = uxPacketSize;
+            pxNetworkBuffer->pxEndPoint = pxEndPoint;
+            pxNetworkBuffer->pxInterface = pxInterface;
+
+            iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+            ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+        }
+    }
+#endif /* ( ipconfigUSE_IPv4 != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_IPv6 != 0 )
+
+/**
+ * @brief Send an MLDv1 listener report or done message.
+ *
+ * @param[in] pxEndPoint The end-point that sends the message.
+ * @param[in] ucType ipICMP_MULTICAST_LISTENER_REPORT_IPv6 or ipICMP_MULTICAST_LISTENER_DONE_IPv6.
+ * @param[in] pxGroupAddress The group.
+ */
+    static void prvSendMLDMessage( NetworkEndPoint_t * pxEndPoint,
+                                   uint8_t ucType,
+                                   const IPv6_Address_t * pxGroupAddress )
+    {
+        NetworkBufferDescriptor_t * pxNetworkBuffer;
+        NetworkInterface_t * pxInterface = pxEndPoint->pxNetworkInterface;
+        EthernetHeader_t * pxEthernetHeader;
+        IPHeader_IPv6_t * pxIPHeader;
+        uint8_t * pucHopByHop;
+        MLDHeader_t * pxMLDHeader;
+        uint16_t usSum;
+        /* The upper-layer length and the next header of the pseudo header. */
+        const uint8_t ucPseudoHeader[ 8 ] = { 0U, 0U, 0U, ( uint8_t ) sizeof( MLDHeader_t ), 0U, 0U, 0U, ( uint8_t ) ipPROTOCOL_ICMP_IPv6 };
+        const size_t uxPacketSize = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + mldHOP_BY_HOP_LENGTH + sizeof( MLDHeader_t );
+
+        /* This is called from the IP-task, which must not block. */
+        pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxPacketSize, 0U );
+
+        if( pxNetworkBuffer != NULL )
+        {
+            ( void ) memset( pxNetworkBuffer->pucEthernetBuffer, 0, uxPacketSize );
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxEthernetHeader = ( ( EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxIPHeader = ( ( IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+            pucHopByHop = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ] );
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxMLDHeader = ( ( MLDHeader_t * ) &( pucHopByHop[ mldHOP_BY_HOP_LENGTH ] ) );
+
+            /* A done message goes to all routers, a report to the group itself. */
+            if( ucType == ipICMP_MULTICAST_LISTENER_DONE_IPv6 )
+            {
+                ( void ) memcpy( pxIPHeader->xDestinationAddress.ucBytes, ucMLDAllRoutersIP, ipSIZE_OF_IPv6_ADDRESS );
+            }
+            else
+            {
+                ( void ) memcpy( pxIPHeader->xDestinationAddress.ucBytes, pxGroupAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+            }
+
+            vSetMultiCastIPv6MacAddress( &( pxIPHeader->xDestinationAddress ), &( pxEthernetHeader->xDestinationAddress ) );
+            ( void ) memcpy( pxEthernetHeader->xSourceAddress.ucBytes, pxEndPoint->xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+            pxEthernetHeader->usFrameType = ipIPv6_FRAME_TYPE;
+
+            pxIPHeader->ucVersionTrafficClass = 0x60U;
+            pxIPHeader->usPayloadLength = FreeRTOS_htons( mldHOP_BY_HOP_LENGTH + sizeof( MLDHeader_t ) );
+            pxIPHeader->ucNextHeader = ( uint8_t ) ipIPv6_EXT_HEADER_HOP_BY_HOP;
+            pxIPHeader->ucHopLimit = 1U;
+            ( void ) memcpy( pxIPHeader->xSourceAddress.ucBytes, pxEndPoint->ipv6_settings.xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+            /* Hop-by-hop header: the Router Alert option ( RFC 2711 ) with value 0 ( MLD ),
+             * followed by a 2-byte PadN option. */
+            pucHopByHop[ 0 ] = ( uint8_t ) ipPROTOCOL_ICMP_IPv6;
+            pucHopByHop[ 2 ] = 0x05U;
+            pucHopByHop[ 3 ] = 0x02U;
+            pucHopByHop[ 6 ] = 0x01U;
+
+            pxMLDHeader->ucTypeOfMessage = ucType;
+            ( void ) memcpy( pxMLDHeader->xGroupAddress.ucBytes, pxGroupAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+            /* usGenerateProtocolChecksum() does not skip the hop-by-hop header,
+             * so the ICMPv6 checksum is calculated here. */
+            usSum = usGenerateChecksum( 0U, pxIPHeader->xSourceAddress.ucBytes, 2U * ipSIZE_OF_IPv6_ADDRESS );
+            usSum = usGenerateChecksum( usSum, ucPseudoHeader, sizeof( ucPseudoHeader ) );
+            usSum = usGenerateChecksum( usSum, ( const uint8_t * ) pxMLDHeader, sizeof( MLDHeader_t ) );
+            pxMLDHeader->usChecksum = ( uint16_t ) ~FreeRTOS_htons( usSum );
+
+            pxNetworkBuffer->xDataLength = uxPacketSize;
+            pxNetworkBuffer->pxEndPoint = pxEndPoint;
+            pxNetworkBuffer->pxInterface = pxInterface;
+
+            iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+            ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+        }
+    }
+#endif /* ( ipconfigUSE_IPv6 != 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send a report or a leave message for a group.
+ *
+ * @param[in] pxGroup A copy of the table entry of the group.
+ * @param[in] xJoin pdTRUE for a report, pdFALSE for a leave message.
+ *
+ * @return pdTRUE when an end-point was available to send the message.
+ */
+static BaseType_t prvSendGroupMessage( const MulticastGroup_t * pxGroup,
+                                       BaseType_t xJoin )
+{
+    NetworkEndPoint_t * pxEndPoint;
+    BaseType_t xIsIPv6 = ( pxGroup->bits.bIPv6 != pdFALSE_UNSIGNED ) ? pdTRUE : pdFALSE;
+
+    pxEndPoint = prvGroupEndPoint( pxGroup->pxInterface, xIsIPv6 );
+
+    if( pxEndPoint != NULL )
+    {
+        if( xIsIPv6 != pdFALSE )
+        {
+            #if ( ipconfigUSE_IPv6 != 0 )
+                prvSendMLDMessage( pxEndPoint,
+                                   ( xJoin != pdFALSE ) ? ipICMP_MULTICAST_LISTENER_REPORT_IPv6 : ipICMP_MULTICAST_LISTENER_DONE_IPv6,
+                                   &( pxGroup->xGroupAddress.xIP_IPv6 ) );
+            #endif
+        }
+        else
+        {
+            #if ( ipconfigUSE_IPv4 != 0 )
+                prvSendIGMPMessage( pxEndPoint,
+                                    ( xJoin != pdFALSE ) ? igmpV2_MEMBERSHIP_REPORT : igmpV2_LEAVE_GROUP,
+                                    pxGroup->xGroupAddress.ulIP_IPv4 );
+            #endif
+        }
+    }
+
+    return ( pxEndPoint != NULL ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task after the group table has changed, or after
+ *        an interface or end-point came up.  Programs the MAC filters of
+ *        new groups, sends pending reports, and leaves the groups that have
+ *        no users any more.
+ */
+void vMulticastHandleEvent( void )
+{
+    BaseType_t xIndex;
+    MulticastGroup_t xCopy;
+    MulticastGroup_t * pxGroup;
+    BaseType_t xAddFilter;
+    BaseType_t xRemoveFilter;
+    BaseType_t xSendReport;
+    BaseType_t xSendLeave;
+    MACAddress_t xMACAddress;
+
+    for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_GROUP_COUNT; xIndex++ )
+    {
+        pxGroup = &( xMulticastGroups[ xIndex ] );
+        xAddFilter = pdFALSE;
+        xRemoveFilter = pdFALSE;
+        xSendReport = pdFALSE;
+        xSendLeave = pdFALSE;
+
+        /* Decide under a suspended scheduler, and do the work afterwards. */
+        vTaskSuspendAll();
+        {
+            xCopy = *pxGroup;
+
+            if( pxGroup->bits.bInUse == pdFALSE_UNSIGNED )
+            {
+                /* Free entry. */
+            }
+            else if( pxGroup->uxUsers == 0U )
+            {
+                /* The last socket has left the group. */
+                xRemoveFilter = ( pxGroup->bits.bFilterSet != pdFALSE_UNSIGNED ) ? pdTRUE : pdFALSE;
+                xSendLeave = ( pxGroup->bits.bReported != pdFALSE_UNSIGNED ) ? pdTRUE : pdFALSE;
+                pxGroup->bits.bInUse = pdFALSE_UNSIGNED;
+            }
+            else
+            {
+                if( ( pxGroup->bits.bFilterSet == pdFALSE_UNSIGNED ) &&
+                    ( pxGroup->pxInterface->bits.bInterfaceUp != pdFALSE_UNSIGNED ) )
+                {
+                    xAddFilter = pdTRUE;
+                    pxGroup->bits.bFilterSet = pdTRUE_UNSIGNED;
+                }
+
+                if( pxGroup->bits.bReportPending != pdFALSE_UNSIGNED )
+                {
+                    xSendReport = pdTRUE;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( ( xAddFilter != pdFALSE ) || ( xRemoveFilter != pdFALSE ) )
+        {
+            prvGroupMACAddress( &xCopy, &xMACAddress );
+
+            if( xAddFilter != pdFALSE )
+            {
+                vNetworkInterfaceAddAllowedMAC( xCopy.pxInterface, xMACAddress.ucBytes );
+            }
+            else
+            {
+                vNetworkInterfaceRemoveAllowedMAC( xCopy.pxInterface, xMACAddress.ucBytes );
+            }
+        }
+
+        if( xSendLeave != pdFALSE )
+        {
+            ( void ) prvSendGroupMessage( &xCopy, pdFALSE );
+        }
+
+        if( xSendReport != pdFALSE )
+        {
+            if( prvSendGroupMessage( &xCopy, pdTRUE ) != pdFALSE )
+            {
+                vTaskSuspendAll();
+                {
+                    pxGroup->bits.bReportPending = pdFALSE_UNSIGNED;
+                    pxGroup->bits.bReported = pdTRUE_UNSIGNED;
+                }
+                ( void ) xTaskResumeAll();
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief An interface goes down and will be re-initialised: remove the MAC
+ *        filters of its groups, and announce the groups again later.
+ *
+ * @param[in] pxInterface The interface.
+ */
+void vMulticastInterfaceDown( struct xNetworkInterface * pxInterface )
+{
+    BaseType_t xIndex;
+    MulticastGroup_t xCopy;
+    MulticastGroup_t * pxGroup;
+    BaseType_t xRemoveFilter;
+    MACAddress_t xMACAddress;
+
+    for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_GROUP_COUNT; xIndex++ )
+    {
+        pxGroup = &( xMulticastGroups[ xIndex ] );
+        xRemoveFilter = pdFALSE;
+
+        vTaskSuspendAll();
+        {
+            xCopy = *pxGroup;
+
+            if( ( pxGroup->bits.bInUse != pdFALSE_UNSIGNED ) && ( pxGroup->pxInterface == pxInterface ) )
+            {
+                xRemoveFilter = ( pxGroup->bits.bFilterSet != pdFALSE_UNSIGNED ) ? pdTRUE : pdFALSE;
+                pxGroup->bits.bFilterSet = pdFALSE_UNSIGNED;
+                pxGroup->bits.bReported = pdFALSE_UNSIGNED;
+
+                if( pxGroup->uxUsers == 0U )
+                {
+                    /* Nothing to announce on a network that is down. */
+                    pxGroup->bits.bInUse = pdFALSE_UNSIGNED;
+                }
+                else
+                {
+                    pxGroup->bits.bReportPending = pdTRUE_UNSIGNED;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xRemoveFilter != pdFALSE )
+        {
+            prvGroupMACAddress( &xCopy, &xMACAddress );
+            vNetworkInterfaceRemoveAllowedMAC( pxInterface, xMACAddress.ucBytes );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Mark the groups of an interface and family as to be reported, and
+ *        send the reports.
+ *
+ * @param[in] pxInterface The interface.
+ * @param[in] xIsIPv6 pdTRUE for the IPv6 groups, pdFALSE for the IPv4 groups.
+ * @param[in] pxAddress A group address, or NULL for all groups.
+ */
+static void prvMulticastReportGroups( const NetworkInterface_t * pxInterface,
+                                      BaseType_t xIsIPv6,
+                                      const IP_Address_t * pxAddress )
+{
+    BaseType_t xIndex;
+    MulticastGroup_t * pxGroup;
+
+    vTaskSuspendAll();
+    {
+        if( pxAddress != NULL )
+        {
+            xIndex = prvFindGroup( pxAddress, xIsIPv6, pxInterface, NULL );
+
+            if( xIndex >= 0 )
+            {
+                xMulticastGroups[ xIndex ].bits.bReportPending = pdTRUE_UNSIGNED;
+            }
+        }
+        else
+        {
+            for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_GROUP_COUNT; xIndex++ )
+            {
+                pxGroup = &( xMulticastGroups[ xIndex ] );
+
+                if( ( pxGroup->bits.bInUse != pdFALSE_UNSIGNED ) &&
+                    ( pxGroup->pxInterface == pxInterface ) &&
+                    ( pxGroup->bits.bIPv6 == ( ( xIsIPv6 != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED ) ) )
+                {
+                    pxGroup->bits.bReportPending = pdTRUE_UNSIGNED;
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    vMulticastHandleEvent();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief An end-point came up: send unsolicited reports for the groups of its
+ *        interface and family.
+ *
+ * @param[in] pxEndPoint The end-point.
+ */
+void vMulticastEndPointUp( const struct xNetworkEndPoint * pxEndPoint )
+{
+    prvMulticastReportGroups( pxEndPoint->pxNetworkInterface,
+                              ( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED ) ? pdTRUE : pdFALSE,
+                              NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_IPv4 != 0 )
+
+/**
+ * @brief Process a received IGMP packet.  A membership query is answered
+ *        by reporting the matching groups.
+ *
+ * @param[in] pxNetworkBuffer The network buffer containing the IGMP packet.
+ *
+ * @return eReleaseBuffer, always.
+ */
+    eFrameProcessingResult_t eProcessIGMPPacket( const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        size_t uxIPHeaderLength = uxIPHeaderSizePacket( pxNetworkBuffer );
+        size_t uxIGMPLength;
+        const IGMPHeader_t * pxIGMPHeader;
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+        IP_Address_t xGroup;
+
+        uxIGMPLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usLength );
+
+        if( ( uxIGMPLength >= ( uxIPHeaderLength + sizeof( IGMPHeader_t ) ) ) &&
+            ( pxNetworkBuffer->xDataLength >= ( ipSIZE_OF_ETH_HEADER + uxIGMPLength ) ) )
+        {
+            uxIGMPLength -= uxIPHeaderLength;
+
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxIGMPHeader = ( ( const IGMPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderLength ] ) );
+
+            if( ( pxIGMPHeader->ucTypeOfMessage == igmpMEMBERSHIP_QUERY ) &&
+                ( usGenerateChecksum( 0U, ( const uint8_t * ) pxIGMPHeader, uxIGMPLength ) == ipCORRECT_CRC ) )
+            {
+                /* A general query has a zero group address. */
+                xGroup.ulIP_IPv4 = pxIGMPHeader->ulGroupAddress;
+                prvMulticastReportGroups( pxNetworkBuffer->pxEndPoint->pxNetworkInterface,
+                                          pdFALSE,
+                                          ( xGroup.ulIP_IPv4 != 0U ) ? &xGroup : NULL );
+            }
+        }
+
+        return eReleaseBuffer;
+    }
+#endif /* ( ipconfigUSE_IPv4 != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_IPv6 != 0 )
+
+/**
+ * @brief Process a received MLD query by reporting the matching groups.
+ *
+ * @param[in] pxNetworkBuffer The network buffer containing the ICMPv6 packet,
+ *                            of which the extension headers have been removed.
+ */
+    void vProcessMLDQuery( const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        const MLDHeader_t * pxMLDHeader;
+        IP_Address_t xGroup;
+        static const uint8_t ucUnspecified[ ipSIZE_OF_IPv6_ADDRESS ] = { 0U };
+
+        if( pxNetworkBuffer->xDataLength >= ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + sizeof( MLDHeader_t ) ) )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxMLDHeader = ( ( const MLDHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ] ) );
+            ( void ) memcpy( xGroup.xIP_IPv6.ucBytes, pxMLDHeader->xGroupAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+            /* A general query has the unspecified address as group. */
+            prvMulticastReportGroups( pxNetworkBuffer->pxEndPoint->pxNetworkInterface,
+                                      pdTRUE,
+                                      ( memcmp( xGroup.xIP_IPv6.ucBytes, ucUnspecified, ipSIZE_OF_IPv6_ADDRESS ) != 0 ) ? &xGroup : NULL );
+        }
+    }
+#endif /* ( ipconfigUSE_IPv6 != 0 ) */
+/*-----------------------------------------------------------*/
+
+/* *INDENT-OFF* */
+#endif /* ( ipconfigSUPPORT_IP_MULTICAST != 0 ) */
+/* *INDENT-ON* */
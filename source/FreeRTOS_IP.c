@@ -59,6 +59,12 @@
 #include "FreeRTOS_DNS.h"
 #include "FreeRTOS_Routing.h"
 #include "FreeRTOS_ND.h"
+#include "FreeRTOS_IGMP.h"
+#include "FreeRTOS_IP_Fragment.h"
+#include "FreeRTOS_VLAN.h"
+#include "FreeRTOS_Bond.h"
+#include "FreeRTOS_NetEm.h"
+#include "FreeRTOS_PacketFilter.h"
 
 /** @brief Time delay between repeated attempts to initialise the network hardware. */
 #ifndef ipINITIALISATION_RETRY_DELAY
@@ -109,16 +115,43 @@ static void prvIPTask_CheckPendingEvents( void );
 /** @brief The pointer to buffer with packet waiting for ARP resolution. */
 NetworkBufferDescriptor_t * pxARPWaitingNetworkBuffer = NULL;
 
+#if ( ipconfigARP_WAITING_BUFFER_COUNT > 1 )
+
+/** @brief A received packet waiting for the resolution of its source address. */
+    typedef struct xWAITING_BUFFER
+    {
+        NetworkBufferDescriptor_t * pxBuffer; /**< The packet. */
+        TickType_t xTimeQueued;               /**< The time at which it was set aside. */
+    } WaitingBuffer_t;
+
+/** @brief The packets waiting for ARP or ND resolution, oldest first. */
+    static WaitingBuffer_t xWaitingBuffers[ ipconfigARP_WAITING_BUFFER_COUNT ];
+
+/** @brief The number of valid entries in xWaitingBuffers[]. */
+    static size_t uxWaitingBufferCount = 0U;
+
+#endif /* ( ipconfigARP_WAITING_BUFFER_COUNT > 1 ) */
+
 /*-----------------------------------------------------------*/
 
-static void prvProcessIPEventsAndTimers( void );
+#if ( ipconfigIP_RUN_TO_COMPLETION == 0 )
+    static void prvProcessIPEventsAndTimers( void );
+#endif
+
+/*
+ * Handle one event that was received from 'xNetworkEventQueue'.
+ */
+static void prvProcessIPEvent( const IPStackEvent_t * pxReceivedEvent );
+
+#if ( ipconfigIP_RUN_TO_COMPLETION == 0 )
 
 /*
  * The main TCP/IP stack processing task.  This task receives commands/events
  * from the network hardware drivers and tasks that are using sockets.  It also
  * maintains a set of protocol timers.
  */
-static void prvIPTask( void * pvParameters );
+    static void prvIPTask( void * pvParameters );
+#endif
 
 /*
  * Called when new data is available from the network interface.
@@ -152,17 +185,119 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
  */
 static void prvHandleEthernetPacket( NetworkBufferDescriptor_t * pxBuffer );
 
+#if ( ipconfigUSE_NETWORK_RX_RING != 0 )
+
+/*
+ * Take all received network buffers from the receive ring of an interface
+ * and pass them to prvHandleEthernetPacket().
+ */
+    static void prvDrainNetworkRxRing( NetworkInterface_t * pxInterface );
+#endif
+
+#if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+
+/*
+ * Top up the reserves of empty network buffers of all interfaces.
+ */
+    static void prvRefillNetworkBufferReserves( void );
+#endif
+
+#if ( ( ipconfigUSE_NETWORK_RX_RING != 0 ) || ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 ) )
+
+/* Make sure that the contents of a ring slot are visible to the other task
+ * before the index that publishes it.  The single-producer/single-consumer
+ * rings do not need a critical section, only this ordering. */
+    #ifdef portMEMORY_BARRIER
+        #define ipRX_RING_BARRIER()    portMEMORY_BARRIER()
+    #else
+        #define ipRX_RING_BARRIER()    do {} while( ipFALSE_BOOL )
+    #endif
+#endif
+
+#if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+
+/*
+ * Call the pfPoll() function of an interface, and schedule another poll
+ * when it used up its budget.
+ */
+    static void prvPollNetworkInterface( NetworkInterface_t * pxInterface );
+#endif
+
+#if ( ipconfigUSE_IP_EVENT_PRIORITY != 0 )
+
+/*
+ * Send an event to 'xNetworkControlQueue' when it is a control event and
+ * there is space, otherwise to 'xNetworkEventQueue'.
+ */
+    static BaseType_t prvSendEventToQueue( const IPStackEvent_t * pxEvent,
+                                           TickType_t uxTimeout );
+
+/*
+ * Handle the events that are waiting in 'xNetworkControlQueue'.
+ */
+    static BaseType_t prvProcessControlEvents( void );
+#elif ( ipconfigIP_RUN_TO_COMPLETION != 0 )
+
+/*
+ * Handle an event in the calling task, or defer it when the calling task is
+ * running the stack already.
+ */
+    static BaseType_t prvRunEventToCompletion( const IPStackEvent_t * pxEvent,
+                                               TickType_t uxTimeout );
+
+/*
+ * Take the stack mutex, and initialise the stack when it is run for the
+ * first time.
+ */
+    static BaseType_t prvIPStackTake( TickType_t uxTimeout );
+
+/*
+ * Handle the deferred and the pending events, then give the stack mutex.
+ */
+    static void prvIPStackRelease( void );
+
+/*
+ * Handle the events that were sent while the stack was running.
+ */
+    static void prvProcessDeferredEvents( void );
+
+    #define prvSendEventToQueue( pxEvent, uxTimeout )    prvRunEventToCompletion( ( pxEvent ), ( uxTimeout ) )
+#else
+    #define prvSendEventToQueue( pxEvent, uxTimeout )    xQueueSendToBack( xNetworkEventQueue, ( pxEvent ), ( uxTimeout ) )
+#endif
+
 /* Handle the 'eNetworkTxEvent': forward a packet from an application to the NIC. */
 static void prvForwardTxPacket( NetworkBufferDescriptor_t * pxNetworkBuffer,
                                 BaseType_t xReleaseAfterSend );
 
 static eFrameProcessingResult_t prvProcessUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+#if ( ipconfigUSE_IP_TASK_STATS != 0 )
+
+/*
+ * Record the queue latency of an event that was just taken from
+ * 'xNetworkEventQueue', and the number of events that were waiting.
+ */
+    static void prvIPTaskStatsReceived( const IPStackEvent_t * pxEvent,
+                                        uint32_t ulNow );
+
+/*
+ * Add the time elapsed since 'ulStartTime' to a group of statistics.
+ */
+    static void prvIPTaskStatsAddTime( IPTaskEventStats_t * pxStats,
+                                       uint32_t ulStartTime );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /** @brief The queue used to pass events into the IP-task for processing. */
 QueueHandle_t xNetworkEventQueue = NULL;
 
+#if ( ipconfigUSE_IP_EVENT_PRIORITY != 0 )
+    /** @brief The queue of control events, see ipconfigUSE_IP_EVENT_PRIORITY. */
+    static QueueHandle_t xNetworkControlQueue = NULL;
+#endif
+
 /** @brief The IP packet ID. */
 uint16_t usPacketIdentifier = 0U;
 
@@ -175,6 +310,31 @@ const MACAddress_t xBroadcastMACAddress = { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
  * full. */
 static volatile BaseType_t xNetworkDownEventPending = pdFALSE;
 
+/** @brief Events without a payload of which one copy in the queue has the same
+ * effect as many: the IP-task only has to be woken up once. */
+#define ipEVENT_IS_COALESCED( eEvent ) \
+    ( ( ( eEvent ) == eTCPTimerEvent ) || ( ( eEvent ) == eARPTimerEvent ) )
+
+/** @brief Bit ( 1 << eEventType ) is set while such an event is waiting in the
+ * queue, further events of the same type are not posted until the IP-task has
+ * taken the first one. */
+static volatile uint32_t ulIPEventPendingBits = 0U;
+
+#if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+
+/** @brief Set when a poll request could not be posted to the network event
+ * queue, prvIPTask_CheckPendingEvents() will then look at all interfaces. */
+    static volatile BaseType_t xNetworkPollPending = pdFALSE;
+#endif
+
+#if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
+/** @brief Set when a transmit-ready notification could not be posted to the
+ * network event queue, prvIPTask_CheckPendingEvents() will then look at all
+ * interfaces. */
+    static volatile BaseType_t xNetworkTxReadyPending = pdFALSE;
+#endif
+
 /** @brief Stores the handle of the task that handles the stack.  The handle is used
  * (indirectly) by some utility function to determine if the utility function is
  * being called by a task (in which case it is ok to block) or by the IP task
@@ -185,13 +345,38 @@ static TaskHandle_t xIPTaskHandle = NULL;
 /** @brief Set to pdTRUE when the IP task is ready to start processing packets. */
 static BaseType_t xIPTaskInitialised = pdFALSE;
 
+#if ( ipconfigIP_RUN_TO_COMPLETION != 0 )
+    /** @brief Only the task that holds this mutex runs the stack, its handle
+     * is stored in 'xIPTaskHandle'. See ipconfigIP_RUN_TO_COMPLETION. */
+    static SemaphoreHandle_t xIPStackMutex = NULL;
+
+    /** @brief Events that were sent by the task that runs the stack, they are
+     * handled before the mutex is given. Only accessed by the mutex holder. */
+    static IPStackEvent_t xDeferredEvents[ ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS ];
+
+    /** @brief The index of the oldest entry in xDeferredEvents[]. */
+    static size_t uxDeferredHead = 0U;
+
+    /** @brief The number of valid entries in xDeferredEvents[]. */
+    static size_t uxDeferredCount = 0U;
+#endif
+
 #if ( ipconfigCHECK_IP_QUEUE_SPACE != 0 )
     /** @brief Keep track of the lowest amount of space in 'xNetworkEventQueue'. */
     static UBaseType_t uxQueueMinimumSpace = ipconfigEVENT_QUEUE_LENGTH;
 #endif
 
+#if ( ipconfigUSE_IP_TASK_STATS != 0 )
+    /** @brief The load and latency statistics of the IP-task, only written by the IP-task. */
+    static IPTaskStats_t xIPTaskStats;
+
+    STATIC_ASSERT( ipIP_TASK_STATS_EVENT_TYPES == ( ( size_t ) eNetworkTxReadyEvent + 2U ) );
+#endif
+
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIP_RUN_TO_COMPLETION == 0 )
+
 /* Coverity wants to make pvParameters const, which would make it incompatible. Leave the
  * function signature as is. */
 
@@ -233,18 +418,57 @@ static void prvProcessIPEventsAndTimers( void )
 {
     IPStackEvent_t xReceivedEvent;
     TickType_t xNextIPSleep;
-    FreeRTOS_Socket_t * pxSocket;
-    struct freertos_sockaddr xAddress;
+    BaseType_t xHandleMore;
+
+    #if ( ipconfigIP_TASK_EVENT_BURST_LENGTH > 1 )
+        size_t uxEventCount = 0U;
+    #endif
+    #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+        uint32_t ulStartTime;
+    #endif
 
     ipconfigWATCHDOG_TIMER();
 
+    #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+        ulStartTime = ipconfigIP_TASK_STATS_TIME();
+    #endif
+
     /* Check the ARP, DHCP and TCP timers to see if there is any periodic
      * or timeout processing to perform. */
     vCheckNetworkTimers();
 
+    #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+        prvIPTaskStatsAddTime( &( xIPTaskStats.xTimers ), ulStartTime );
+    #endif
+
+    #if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+    {
+        /* Replace the buffers that the drivers took in their interrupt
+         * handlers. */
+        prvRefillNetworkBufferReserves();
+    }
+    #endif
+
+    #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+    {
+        /* Do not keep the frames of the timers while sleeping. */
+        vIPTxQueueFlush();
+    }
+    #endif
+
     /* Calculate the acceptable maximum sleep time. */
     xNextIPSleep = xCalculateSleepTime();
 
+    #if ( ipconfigUSE_IP_EVENT_PRIORITY != 0 )
+    {
+        if( uxQueueMessagesWaiting( xNetworkControlQueue ) != 0U )
+        {
+            /* Control events are waiting, do not sleep. */
+            xNextIPSleep = ( TickType_t ) 0U;
+        }
+    }
+    #endif
+
     /* Wait until there is something to do. If the following call exits
      * due to a time out rather than a message being received, set a
      * 'NoEvent' value. */
@@ -253,29 +477,125 @@ static void prvProcessIPEventsAndTimers( void )
         xReceivedEvent.eEventType = eNoEvent;
     }
 
-    #if ( ipconfigCHECK_IP_QUEUE_SPACE != 0 )
+    do
     {
-        if( xReceivedEvent.eEventType != eNoEvent )
+        #if ( ipconfigUSE_IP_EVENT_PRIORITY != 0 )
+        {
+            /* The control events go before the packet that was received. */
+            if( prvProcessControlEvents() != pdFALSE )
+            {
+                #if ( ipconfigIP_TASK_EVENT_BURST_LENGTH > 1 )
+                    /* A control event may have expired a timer, check the
+                     * timers before handling more packets. */
+                    uxEventCount = ( size_t ) ipconfigIP_TASK_EVENT_BURST_LENGTH;
+                #endif
+            }
+        }
+        #endif
+
+        #if ( ipconfigCHECK_IP_QUEUE_SPACE != 0 )
+        {
+            if( xReceivedEvent.eEventType != eNoEvent )
+            {
+                UBaseType_t uxCount;
+
+                uxCount = uxQueueSpacesAvailable( xNetworkEventQueue );
+
+                if( uxQueueMinimumSpace > uxCount )
+                {
+                    uxQueueMinimumSpace = uxCount;
+                }
+            }
+        }
+        #endif /* ipconfigCHECK_IP_QUEUE_SPACE */
+
+        #if ( ipconfigUSE_RESOURCE_STATS != 0 )
+        {
+            if( xReceivedEvent.eEventType != eNoEvent )
+            {
+                /* The event that was just taken was waiting as well. */
+                vIPResourceStatsEventQueue( ( size_t ) uxQueueMessagesWaiting( xNetworkEventQueue ) + 1U );
+            }
+        }
+        #endif
+
+        #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+        {
+            ulStartTime = ipconfigIP_TASK_STATS_TIME();
+            prvIPTaskStatsReceived( &xReceivedEvent, ulStartTime );
+        }
+        #endif
+
+        iptraceNETWORK_EVENT_RECEIVED( xReceivedEvent.eEventType );
+
+        prvProcessIPEvent( &xReceivedEvent );
+
+        #if ( ipconfigUSE_IP_TASK_STATS != 0 )
         {
-            UBaseType_t uxCount;
+            /* eNoEvent is -1, it is counted in the first entry. */
+            prvIPTaskStatsAddTime( &( xIPTaskStats.xEvents[ ( size_t ) ( ( BaseType_t ) xReceivedEvent.eEventType + 1 ) ] ), ulStartTime );
+        }
+        #endif
+
+        xHandleMore = pdFALSE;
 
-            uxCount = uxQueueSpacesAvailable( xNetworkEventQueue );
+        #if ( ipconfigIP_TASK_EVENT_BURST_LENGTH > 1 )
+        {
+            /* As long as there are more events waiting, handle them now
+             * without going through the timer checks for every single one. */
+            uxEventCount++;
 
-            if( uxQueueMinimumSpace > uxCount )
+            if( ( xReceivedEvent.eEventType != eNoEvent ) &&
+                ( uxEventCount < ( size_t ) ipconfigIP_TASK_EVENT_BURST_LENGTH ) )
             {
-                uxQueueMinimumSpace = uxCount;
+                if( xQueueReceive( xNetworkEventQueue, ( void * ) &xReceivedEvent, ( TickType_t ) 0U ) != pdFALSE )
+                {
+                    xHandleMore = pdTRUE;
+                }
             }
         }
+        #endif /* ( ipconfigIP_TASK_EVENT_BURST_LENGTH > 1 ) */
+    } while( xHandleMore != pdFALSE );
+
+    prvIPTask_CheckPendingEvents();
+
+    #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+    {
+        /* The burst is over, send the frames it produced, the highest
+         * priority class first. */
+        vIPTxQueueFlush();
     }
-    #endif /* ipconfigCHECK_IP_QUEUE_SPACE */
+    #endif
+}
+
+#endif /* ( ipconfigIP_RUN_TO_COMPLETION == 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Handle a single event that was taken from 'xNetworkEventQueue'.
+ *
+ * @param[in] pxReceivedEvent The event to be handled.
+ */
+static void prvProcessIPEvent( const IPStackEvent_t * pxReceivedEvent )
+{
+    FreeRTOS_Socket_t * pxSocket;
+    struct freertos_sockaddr xAddress;
 
-    iptraceNETWORK_EVENT_RECEIVED( xReceivedEvent.eEventType );
+    if( ipEVENT_IS_COALESCED( pxReceivedEvent->eEventType ) )
+    {
+        /* From now on, a new event of this type must be posted again. */
+        taskENTER_CRITICAL();
+        {
+            ulIPEventPendingBits &= ~( ( uint32_t ) 1U << ( uint32_t ) pxReceivedEvent->eEventType );
+        }
+        taskEXIT_CRITICAL();
+    }
 
-    switch( xReceivedEvent.eEventType )
+    switch( pxReceivedEvent->eEventType )
     {
         case eNetworkDownEvent:
             /* Attempt to establish a connection. */
-            prvProcessNetworkDownEvent( ( ( NetworkInterface_t * ) xReceivedEvent.pvData ) );
+            prvProcessNetworkDownEvent( ( ( NetworkInterface_t * ) pxReceivedEvent->pvData ) );
             break;
 
         case eNetworkRxEvent:
@@ -283,14 +603,38 @@ static void prvProcessIPEventsAndTimers( void )
             /* The network hardware driver has received a new packet.  A
              * pointer to the received buffer is located in the pvData member
              * of the received event structure. */
-            prvHandleEthernetPacket( ( NetworkBufferDescriptor_t * ) xReceivedEvent.pvData );
+            prvHandleEthernetPacket( ( NetworkBufferDescriptor_t * ) pxReceivedEvent->pvData );
+
+            #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_RX_COALESCE != 0 ) )
+            {
+                /* The burst has been handled, process the TCP segments that
+                 * were held for merging. */
+                vTCPRxCoalesceFlush();
+            }
+            #endif
+            break;
+
+        case eNetworkRxRingEvent:
+            #if ( ipconfigUSE_NETWORK_RX_RING != 0 )
+            {
+                /* A driver has stored one or more buffers in the receive
+                 * ring of the interface in pvData. */
+                prvDrainNetworkRxRing( ( NetworkInterface_t * ) pxReceivedEvent->pvData );
+
+                #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_RX_COALESCE != 0 ) )
+                {
+                    vTCPRxCoalesceFlush();
+                }
+                #endif
+            }
+            #endif
             break;
 
         case eNetworkTxEvent:
 
             /* Send a network packet. The ownership will  be transferred to
              * the driver, which will release it after delivery. */
-            prvForwardTxPacket( ( ( NetworkBufferDescriptor_t * ) xReceivedEvent.pvData ), pdTRUE );
+            prvForwardTxPacket( ( ( NetworkBufferDescriptor_t * ) pxReceivedEvent->pvData ), pdTRUE );
             break;
 
         case eARPTimerEvent:
@@ -312,7 +656,7 @@ static void prvProcessIPEventsAndTimers( void )
              * usLocalPort. vSocketBind() will actually bind the socket and the
              * API will unblock as soon as the eSOCKET_BOUND event is
              * triggered. */
-            pxSocket = ( ( FreeRTOS_Socket_t * ) xReceivedEvent.pvData );
+            pxSocket = ( ( FreeRTOS_Socket_t * ) pxReceivedEvent->pvData );
             xAddress.sin_len = ( uint8_t ) sizeof( xAddress );
 
             switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE */
@@ -358,7 +702,7 @@ static void prvProcessIPEventsAndTimers( void )
              * IP-task to actually close a socket. This is handled in
              * vSocketClose().  As the socket gets closed, there is no way to
              * report back to the API, so the API won't wait for the result */
-            ( void ) vSocketClose( ( ( FreeRTOS_Socket_t * ) xReceivedEvent.pvData ) );
+            ( void ) vSocketClose( ( ( FreeRTOS_Socket_t * ) pxReceivedEvent->pvData ) );
             break;
 
         case eStackTxEvent:
@@ -366,11 +710,94 @@ static void prvProcessIPEventsAndTimers( void )
             /* The network stack has generated a packet to send.  A
              * pointer to the generated buffer is located in the pvData
              * member of the received event structure. */
-            vProcessGeneratedUDPPacket( ( NetworkBufferDescriptor_t * ) xReceivedEvent.pvData );
+            vProcessGeneratedUDPPacket( ( NetworkBufferDescriptor_t * ) pxReceivedEvent->pvData );
+            break;
+
+        case eStackTxBatchEvent:
+
+            /* FreeRTOS_sendmmsg() or a segmented FreeRTOS_sendto() has
+             * generated a chain of packets to send, linked through
+             * 'pxNextBuffer'. */
+            #if ( ipconfigSUPPORT_SENDMMSG != 0 )
+            {
+                NetworkBufferDescriptor_t * pxBuffer = ( NetworkBufferDescriptor_t * ) pxReceivedEvent->pvData;
+                NetworkBufferDescriptor_t * pxNextBuffer;
+
+                while( pxBuffer != NULL )
+                {
+                    pxNextBuffer = pxBuffer->pxNextBuffer;
+                    pxBuffer->pxNextBuffer = NULL;
+                    vProcessGeneratedUDPPacket( pxBuffer );
+                    pxBuffer = pxNextBuffer;
+                }
+            }
+            #endif /* ( ipconfigSUPPORT_SENDMMSG != 0 ) */
+            break;
+
+        case eStackTxReadyEvent:
+
+            /* A connected UDP socket has filled in all headers of the
+             * packet in pvData, see xUDPConnectFillHeader(). */
+            #if ( ipconfigUSE_UDP_CONNECT != 0 )
+            {
+                vUDPConnectOutput( ( NetworkBufferDescriptor_t * ) pxReceivedEvent->pvData );
+            }
+            #endif
+            break;
+
+        case eNetworkPollEvent:
+            #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+            {
+                /* The interface in pvData has received frames, and its
+                 * RX interrupt is masked until it has been polled empty. */
+                prvPollNetworkInterface( ( NetworkInterface_t * ) pxReceivedEvent->pvData );
+
+                #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_RX_COALESCE != 0 ) )
+                {
+                    vTCPRxCoalesceFlush();
+                }
+                #endif
+            }
+            #endif
+            break;
+
+        case eNetworkTxReadyEvent:
+
+            /* The driver of the interface in pvData has room in its
+             * transmit ring again. */
+            #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+            {
+                NetworkInterface_t * pxInterface = ( NetworkInterface_t * ) pxReceivedEvent->pvData;
+
+                pxInterface->xTxReadyPending = pdFALSE;
+                vIPInterfaceTxReady( pxInterface );
+            }
+            #endif
+            break;
+
+        case eSocketAsyncEvent:
+
+            /* An asynchronous ring has new requests, or one of its sockets
+             * had an event. */
+            #if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+            {
+                vSocketAsyncProcess( ( SocketAsyncRing_t * ) pxReceivedEvent->pvData );
+            }
+            #endif
+            break;
+
+        case eMulticastGroupEvent:
+
+            /* A socket has joined or left a multicast group. */
+            #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+            {
+                vMulticastHandleEvent();
+            }
+            #endif
             break;
 
         case eDHCPEvent:
-            prvCallDHCP_RA_Handler( ( ( NetworkEndPoint_t * ) xReceivedEvent.pvData ) );
+            prvCallDHCP_RA_Handler( ( ( NetworkEndPoint_t * ) pxReceivedEvent->pvData ) );
             break;
 
         case eSocketSelectEvent:
@@ -381,13 +808,13 @@ static void prvProcessIPEventsAndTimers( void )
             #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
             #if ( ipconfigSELECT_USES_NOTIFY != 0 )
                 {
-                    SocketSelectMessage_t * pxMessage = ( ( SocketSelectMessage_t * ) xReceivedEvent.pvData );
+                    SocketSelectMessage_t * pxMessage = ( ( SocketSelectMessage_t * ) pxReceivedEvent->pvData );
                     vSocketSelect( pxMessage->pxSocketSet );
                     ( void ) xTaskNotifyGive( pxMessage->xTaskhandle );
                 }
             #else
                 {
-                    vSocketSelect( ( ( SocketSelect_t * ) xReceivedEvent.pvData ) );
+                    vSocketSelect( ( ( SocketSelect_t * ) pxReceivedEvent->pvData ) );
                 }
             #endif /* ( ipconfigSELECT_USES_NOTIFY != 0 ) */
             #endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
@@ -398,7 +825,7 @@ static void prvProcessIPEventsAndTimers( void )
 
                 /* Some task wants to signal the user of this socket in
                  * order to interrupt a call to recv() or a call to select(). */
-                ( void ) FreeRTOS_SignalSocket( ( Socket_t ) xReceivedEvent.pvData );
+                ( void ) FreeRTOS_SignalSocket( ( Socket_t ) pxReceivedEvent->pvData );
             #endif /* ipconfigSUPPORT_SIGNALS */
             break;
 
@@ -417,7 +844,7 @@ static void prvProcessIPEventsAndTimers( void )
              * check if the listening socket (communicated in pvData) actually
              * received a new connection. */
             #if ( ipconfigUSE_TCP == 1 )
-                pxSocket = ( ( FreeRTOS_Socket_t * ) xReceivedEvent.pvData );
+                pxSocket = ( ( FreeRTOS_Socket_t * ) pxReceivedEvent->pvData );
 
                 if( xTCPCheckNewClient( pxSocket ) != pdFALSE )
                 {
@@ -439,7 +866,17 @@ static void prvProcessIPEventsAndTimers( void )
         case eSocketSetDeleteEvent:
             #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
             {
-                SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) ( xReceivedEvent.pvData );
+                SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) ( pxReceivedEvent->pvData );
+
+                #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+                {
+                    /* Unlink the sockets that are still waiting to be reported. */
+                    while( listCURRENT_LIST_LENGTH( &( pxSocketSet->xReadyList ) ) > 0U )
+                    {
+                        ( void ) uxListRemove( listGET_HEAD_ENTRY( &( pxSocketSet->xReadyList ) ) );
+                    }
+                }
+                #endif
 
                 iptraceMEM_STATS_DELETE( pxSocketSet );
                 vEventGroupDelete( pxSocketSet->xSelectGroup );
@@ -456,8 +893,6 @@ static void prvProcessIPEventsAndTimers( void )
             /* Should not get here. */
             break;
     }
-
-    prvIPTask_CheckPendingEvents();
 }
 
 /*-----------------------------------------------------------*/
@@ -473,6 +908,13 @@ static void prvIPTask_Initialise( void )
     /* A possibility to set some additional task properties. */
     iptraceIP_TASK_STARTING();
 
+    #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+    {
+        /* The measurement period starts with the IP-task. */
+        xIPTaskStats.ulStartTime = ipconfigIP_TASK_STATS_TIME();
+    }
+    #endif
+
     /* Generate a dummy message to say that the network connection has gone
      * down.  This will cause this task to initialise the network interface.  After
      * this it is the responsibility of the network interface hardware driver to
@@ -508,6 +950,13 @@ static void prvIPTask_Initialise( void )
     {
         /* Clear the DNS cache once only. */
         FreeRTOS_dnsclear();
+
+        #if ( ipconfigUSE_DNS_CACHE_PERSISTENCE != 0 )
+        {
+            /* Warm up the cache with the entries kept before the reboot. */
+            vDNSCacheRestore();
+        }
+        #endif
     }
     #endif /* ( ( ipconfigUSE_DNS_CACHE != 0 ) && ( ipconfigUSE_DNS != 0 ) ) */
 
@@ -543,6 +992,49 @@ static void prvIPTask_CheckPendingEvents( void )
             }
         }
     }
+
+    #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+    {
+        if( xNetworkPollPending != pdFALSE )
+        {
+            /* A poll request could not be posted, the interface will not
+             * send another one because its RX interrupt is masked. */
+            xNetworkPollPending = pdFALSE;
+
+            for( pxInterface = FreeRTOS_FirstNetworkInterface();
+                 pxInterface != NULL;
+                 pxInterface = FreeRTOS_NextNetworkInterface( pxInterface ) )
+            {
+                if( pxInterface->xPollPending != pdFALSE )
+                {
+                    prvPollNetworkInterface( pxInterface );
+                }
+            }
+        }
+    }
+    #endif /* ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 ) */
+
+    #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+    {
+        if( xNetworkTxReadyPending != pdFALSE )
+        {
+            /* A transmit-ready notification could not be posted, the driver
+             * will not send another one. */
+            xNetworkTxReadyPending = pdFALSE;
+
+            for( pxInterface = FreeRTOS_FirstNetworkInterface();
+                 pxInterface != NULL;
+                 pxInterface = FreeRTOS_NextNetworkInterface( pxInterface ) )
+            {
+                if( pxInterface->xTxReadyPending != pdFALSE )
+                {
+                    pxInterface->xTxReadyPending = pdFALSE;
+                    vIPInterfaceTxReady( pxInterface );
+                }
+            }
+        }
+    }
+    #endif /* ( ipconfigUSE_TX_BACKPRESSURE != 0 ) */
 }
 
 /*-----------------------------------------------------------*/
@@ -625,18 +1117,54 @@ void vIPNetworkUpCalls( struct xNetworkEndPoint * pxEndPoint )
     }
 
     pxEndPoint->bits.bEndPointUp = pdTRUE_UNSIGNED;
+    vBringUpEndPointMilestone( pxEndPoint, eBringUpNetworkUp );
 
-    #if ( ipconfigUSE_NETWORK_EVENT_HOOK == 1 )
-    #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
-        {
-            vApplicationIPNetworkEventHook( eNetworkUp );
-        }
-    #else
-        {
-            vApplicationIPNetworkEventHook_Multi( eNetworkUp, pxEndPoint );
-        }
+    #if ( ipHEADER_CACHE != 0 )
+    {
+        /* The address of the end-point may have changed. */
+        vIPHeaderCacheInvalidate();
+    }
     #endif
-    #endif /* ipconfigUSE_NETWORK_EVENT_HOOK */
+
+    /* Routes may go through the end-point that just came up. */
+    FreeRTOS_RouteCacheInvalidate();
+
+    #if ( ipconfigUSE_FAST_BRING_UP != 0 )
+    {
+        NetworkInterface_t * pxInterface = pxEndPoint->pxNetworkInterface;
+
+        if( ( pxInterface != NULL ) &&
+            ( pxInterface->bits.bBringingUp != pdFALSE_UNSIGNED ) &&
+            ( FreeRTOS_AllEndPointsUp( pxInterface ) != pdFALSE ) )
+        {
+            pxInterface->bits.bBringingUp = pdFALSE_UNSIGNED;
+            pxInterface->xTimeToReady = xTaskGetTickCount() - pxInterface->xBringUpTime;
+            FreeRTOS_printf( ( "vIPNetworkUpCalls: %s ready after %lu ticks\n",
+                               ( pxInterface->pcName != NULL ) ? pxInterface->pcName : "interface",
+                               ( unsigned long ) pxInterface->xTimeToReady ) );
+            iptraceINTERFACE_READY( pxInterface, pxInterface->xTimeToReady );
+        }
+    }
+    #endif
+
+    #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+    {
+        /* Announce the joined multicast groups on the new end-point. */
+        vMulticastEndPointUp( pxEndPoint );
+    }
+    #endif
+
+    #if ( ipconfigUSE_NETWORK_EVENT_HOOK == 1 )
+    #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
+        {
+            vApplicationIPNetworkEventHook( eNetworkUp );
+        }
+    #else
+        {
+            vApplicationIPNetworkEventHook_Multi( eNetworkUp, pxEndPoint );
+        }
+    #endif
+    #endif /* ipconfigUSE_NETWORK_EVENT_HOOK */
 
     #if ( ipconfigDNS_USE_CALLBACKS != 0 )
     {
@@ -660,41 +1188,26 @@ void vIPNetworkUpCalls( struct xNetworkEndPoint * pxEndPoint )
  */
 static void prvHandleEthernetPacket( NetworkBufferDescriptor_t * pxBuffer )
 {
-    #if ( ipconfigUSE_LINKED_RX_MESSAGES == 0 )
-    {
-        /* When ipconfigUSE_LINKED_RX_MESSAGES is set to 0 then only one
-         * buffer will be sent at a time.  This is the default way for +TCP to pass
-         * messages from the MAC to the TCP/IP stack. */
-        if( pxBuffer != NULL )
-        {
-            prvProcessEthernetPacket( pxBuffer );
-        }
-    }
-    #else /* ipconfigUSE_LINKED_RX_MESSAGES */
-    {
-        NetworkBufferDescriptor_t * pxNextBuffer;
+    NetworkBufferDescriptor_t * pxNextBuffer;
 
-        /* An optimisation that is useful when there is high network traffic.
-         * Instead of passing received packets into the IP task one at a time the
-         * network interface can chain received packets together and pass them into
-         * the IP task in one go.  The packets are chained using the pxNextBuffer
-         * member.  The loop below walks through the chain processing each packet
-         * in the chain in turn. */
+    /* Instead of passing received packets into the IP task one at a time the
+     * network interface may chain received packets together and pass them into
+     * the IP task in one go, see xSendRxBurstToIPTask().  The packets are chained
+     * using the pxNextBuffer member.  A single packet has a NULL pxNextBuffer.
+     * The loop below walks through the chain processing each packet in turn. */
 
-        /* While there is another packet in the chain. */
-        while( pxBuffer != NULL )
-        {
-            /* Store a pointer to the buffer after pxBuffer for use later on. */
-            pxNextBuffer = pxBuffer->pxNextBuffer;
+    /* While there is another packet in the chain. */
+    while( pxBuffer != NULL )
+    {
+        /* Store a pointer to the buffer after pxBuffer for use later on. */
+        pxNextBuffer = pxBuffer->pxNextBuffer;
 
-            /* Make it NULL to avoid using it later on. */
-            pxBuffer->pxNextBuffer = NULL;
+        /* Make it NULL to avoid using it later on. */
+        pxBuffer->pxNextBuffer = NULL;
 
-            prvProcessEthernetPacket( pxBuffer );
-            pxBuffer = pxNextBuffer;
-        }
+        prvProcessEthernetPacket( pxBuffer );
+        pxBuffer = pxNextBuffer;
     }
-    #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
 }
 /*-----------------------------------------------------------*/
 
@@ -711,7 +1224,7 @@ static void prvForwardTxPacket( NetworkBufferDescriptor_t * pxNetworkBuffer,
 
     if( pxNetworkBuffer->pxInterface != NULL )
     {
-        ( void ) pxNetworkBuffer->pxInterface->pfOutput( pxNetworkBuffer->pxInterface, pxNetworkBuffer, xReleaseAfterSend );
+        ( void ) xIPInterfaceOutput( pxNetworkBuffer->pxInterface, pxNetworkBuffer, xReleaseAfterSend );
     }
 }
 /*-----------------------------------------------------------*/
@@ -766,20 +1279,33 @@ BaseType_t FreeRTOS_NetworkDownFromISR( struct xNetworkInterface * pxNetworkInte
 
     xNetworkDownEvent.eEventType = eNetworkDownEvent;
     xNetworkDownEvent.pvData = pxNetworkInterface;
+    ipSTAMP_IP_TASK_EVENT( xNetworkDownEvent );
 
-    /* Simply send the network task the appropriate event. */
-    if( xQueueSendToBackFromISR( xNetworkEventQueue, &xNetworkDownEvent, &xHigherPriorityTaskWoken ) != pdPASS )
+    #if ( ipconfigIP_RUN_TO_COMPLETION != 0 )
     {
-        /* Could not send the message, so it is still pending. */
+        /* There is no queue, the next task that runs the stack will handle
+         * the pending event. */
+        ( void ) xNetworkDownEvent;
         pxNetworkInterface->bits.bCallDownEvent = pdTRUE;
         xNetworkDownEventPending = pdTRUE;
     }
-    else
+    #else
     {
-        /* Message was sent so it is not pending. */
-        pxNetworkInterface->bits.bCallDownEvent = pdFALSE;
-        xNetworkDownEventPending = pdFALSE;
+        /* Simply send the network task the appropriate event. */
+        if( xQueueSendToBackFromISR( xNetworkEventQueue, &xNetworkDownEvent, &xHigherPriorityTaskWoken ) != pdPASS )
+        {
+            /* Could not send the message, so it is still pending. */
+            pxNetworkInterface->bits.bCallDownEvent = pdTRUE;
+            xNetworkDownEventPending = pdTRUE;
+        }
+        else
+        {
+            /* Message was sent so it is not pending. */
+            pxNetworkInterface->bits.bCallDownEvent = pdFALSE;
+            xNetworkDownEventPending = pdFALSE;
+        }
     }
+    #endif /* if ( ipconfigIP_RUN_TO_COMPLETION != 0 ) */
 
     iptraceNETWORK_DOWN();
 
@@ -787,6 +1313,24 @@ BaseType_t FreeRTOS_NetworkDownFromISR( struct xNetworkInterface * pxNetworkInte
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief A driver that could not be initialised because e.g. its PHY was still
+ *        negotiating, tells that it is ready.  Instead of waiting for the
+ *        next retry of all interfaces that are down, this interface will be
+ *        initialised again at once.  Each interface comes up on its own.
+ *
+ * @param[in] pxNetworkInterface The interface that is ready.
+ */
+void FreeRTOS_NetworkInterfaceReady( struct xNetworkInterface * pxNetworkInterface )
+{
+    if( pxNetworkInterface->bits.bInterfaceUp == pdFALSE_UNSIGNED )
+    {
+        /* A network-down event makes the IP-task call pfInitialise(). */
+        FreeRTOS_NetworkDown( pxNetworkInterface );
+    }
+}
+/*-----------------------------------------------------------*/
+
 #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
 
 /**
@@ -865,7 +1409,7 @@ void * FreeRTOS_GetUDPPayloadBuffer_Multi( size_t uxRequestedSizeBytes,
     if( uxPayloadOffset != 0U )
     {
         /* Obtain a network buffer with the required amount of storage. */
-        pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxPayloadOffset + uxRequestedSizeBytes, uxBlockTime );
+        pxNetworkBuffer = pxGetBulkNetworkBufferWithDescriptor( uxPayloadOffset + uxRequestedSizeBytes, uxBlockTime );
 
         if( pxNetworkBuffer != NULL )
         {
@@ -940,85 +1484,171 @@ BaseType_t FreeRTOS_IPInit_Multi( void )
     /* There must be at least one interface and one end-point. */
     configASSERT( FreeRTOS_FirstNetworkInterface() != NULL );
 
+    #if ( ipconfigUSE_BRING_UP_TIMELINE != 0 )
+    {
+        NetworkInterface_t * pxInterface;
+
+        for( pxInterface = FreeRTOS_FirstNetworkInterface();
+             pxInterface != NULL;
+             pxInterface = FreeRTOS_NextNetworkInterface( pxInterface ) )
+        {
+            vBringUpInterfaceMilestone( pxInterface, eBringUpIPInit );
+        }
+    }
+    #endif
+
     /* Check that the configuration values are correct and that the IP-task has not
      * already been initialized. */
     vPreCheckConfigs();
 
-    /* Attempt to create the queue used to communicate with the IP task. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    #if ( ipconfigIP_RUN_TO_COMPLETION != 0 )
     {
-        static StaticQueue_t xNetworkEventStaticQueue;
-        static uint8_t ucNetworkEventQueueStorageArea[ ipconfigEVENT_QUEUE_LENGTH * sizeof( IPStackEvent_t ) ];
-        xNetworkEventQueue = xQueueCreateStatic( ipconfigEVENT_QUEUE_LENGTH,
-                                                 sizeof( IPStackEvent_t ),
-                                                 ucNetworkEventQueueStorageArea,
-                                                 &xNetworkEventStaticQueue );
+        /* There is no IP-task and no queue: the tasks that send events take
+         * turns to run the stack. */
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            static StaticSemaphore_t xIPStackMutexBuffer;
+            xIPStackMutex = xSemaphoreCreateMutexStatic( &xIPStackMutexBuffer );
+        }
+        #else
+        {
+            xIPStackMutex = xSemaphoreCreateMutex();
+            configASSERT( xIPStackMutex != NULL );
+        }
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+        if( xIPStackMutex == NULL )
+        {
+            FreeRTOS_debug_printf( ( "FreeRTOS_IPInit_Multi: Stack mutex could not be created\n" ) );
+        }
+        else if( xNetworkBuffersInitialise() == pdPASS )
+        {
+            /* Prepare the sockets interface. The stack will be initialised
+             * by the first task that runs it. */
+            vNetworkSocketsInit();
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            FreeRTOS_debug_printf( ( "FreeRTOS_IPInit_Multi: xNetworkBuffersInitialise() failed\n" ) );
+
+            vSemaphoreDelete( xIPStackMutex );
+            xIPStackMutex = NULL;
+        }
     }
-    #else
+    #else /* if ( ipconfigIP_RUN_TO_COMPLETION != 0 ) */
     {
-        xNetworkEventQueue = xQueueCreate( ipconfigEVENT_QUEUE_LENGTH, sizeof( IPStackEvent_t ) );
-        configASSERT( xNetworkEventQueue != NULL );
-    }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
+        /* Attempt to create the queue used to communicate with the IP task. */
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            static StaticQueue_t xNetworkEventStaticQueue;
+            static uint8_t ucNetworkEventQueueStorageArea[ ipconfigEVENT_QUEUE_LENGTH * sizeof( IPStackEvent_t ) ];
+            xNetworkEventQueue = xQueueCreateStatic( ipconfigEVENT_QUEUE_LENGTH,
+                                                     sizeof( IPStackEvent_t ),
+                                                     ucNetworkEventQueueStorageArea,
+                                                     &xNetworkEventStaticQueue );
+        }
+        #else
+        {
+            xNetworkEventQueue = xQueueCreate( ipconfigEVENT_QUEUE_LENGTH, sizeof( IPStackEvent_t ) );
+            configASSERT( xNetworkEventQueue != NULL );
+        }
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
 
-    if( xNetworkEventQueue != NULL )
-    {
-        #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        #if ( ipconfigUSE_IP_EVENT_PRIORITY != 0 )
         {
-            /* A queue registry is normally used to assist a kernel aware
-             * debugger.  If one is in use then it will be helpful for the debugger
-             * to show information about the network event queue. */
-            vQueueAddToRegistry( xNetworkEventQueue, "NetEvnt" );
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                static StaticQueue_t xNetworkControlStaticQueue;
+                static uint8_t ucNetworkControlQueueStorageArea[ ipconfigEVENT_CONTROL_QUEUE_LENGTH * sizeof( IPStackEvent_t ) ];
+                xNetworkControlQueue = xQueueCreateStatic( ipconfigEVENT_CONTROL_QUEUE_LENGTH,
+                                                           sizeof( IPStackEvent_t ),
+                                                           ucNetworkControlQueueStorageArea,
+                                                           &xNetworkControlStaticQueue );
+            }
+            #else
+            {
+                xNetworkControlQueue = xQueueCreate( ipconfigEVENT_CONTROL_QUEUE_LENGTH, sizeof( IPStackEvent_t ) );
+                configASSERT( xNetworkControlQueue != NULL );
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            if( ( xNetworkControlQueue == NULL ) && ( xNetworkEventQueue != NULL ) )
+            {
+                /* Without both queues, the IP-task can not run. */
+                vQueueDelete( xNetworkEventQueue );
+                xNetworkEventQueue = NULL;
+            }
         }
-        #endif /* configQUEUE_REGISTRY_SIZE */
+        #endif /* ( ipconfigUSE_IP_EVENT_PRIORITY != 0 ) */
 
-        if( xNetworkBuffersInitialise() == pdPASS )
+        if( xNetworkEventQueue != NULL )
         {
-            /* Prepare the sockets interface. */
-            vNetworkSocketsInit();
+            #if ( configQUEUE_REGISTRY_SIZE > 0 )
+            {
+                /* A queue registry is normally used to assist a kernel aware
+                 * debugger.  If one is in use then it will be helpful for the debugger
+                 * to show information about the network event queue. */
+                vQueueAddToRegistry( xNetworkEventQueue, "NetEvnt" );
+            }
+            #endif /* configQUEUE_REGISTRY_SIZE */
 
-            /* Create the task that processes Ethernet and stack events. */
-            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            if( xNetworkBuffersInitialise() == pdPASS )
             {
-                static StaticTask_t xIPTaskBuffer;
-                static StackType_t xIPTaskStack[ ipconfigIP_TASK_STACK_SIZE_WORDS ];
-                xIPTaskHandle = xTaskCreateStatic( prvIPTask,
-                                                   "IP-Task",
-                                                   ipconfigIP_TASK_STACK_SIZE_WORDS,
-                                                   NULL,
-                                                   ipconfigIP_TASK_PRIORITY,
-                                                   xIPTaskStack,
-                                                   &xIPTaskBuffer );
-
-                if( xIPTaskHandle != NULL )
+                /* Prepare the sockets interface. */
+                vNetworkSocketsInit();
+
+                /* Create the task that processes Ethernet and stack events. */
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    static StaticTask_t xIPTaskBuffer;
+                    static StackType_t xIPTaskStack[ ipconfigIP_TASK_STACK_SIZE_WORDS ];
+                    xIPTaskHandle = xTaskCreateStatic( prvIPTask,
+                                                       "IP-Task",
+                                                       ipconfigIP_TASK_STACK_SIZE_WORDS,
+                                                       NULL,
+                                                       ipconfigIP_TASK_PRIORITY,
+                                                       xIPTaskStack,
+                                                       &xIPTaskBuffer );
+
+                    if( xIPTaskHandle != NULL )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                }
+                #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
                 {
-                    xReturn = pdTRUE;
+                    xReturn = xTaskCreate( prvIPTask,
+                                           "IP-task",
+                                           ipconfigIP_TASK_STACK_SIZE_WORDS,
+                                           NULL,
+                                           ipconfigIP_TASK_PRIORITY,
+                                           &( xIPTaskHandle ) );
                 }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
             }
-            #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+            else
             {
-                xReturn = xTaskCreate( prvIPTask,
-                                       "IP-task",
-                                       ipconfigIP_TASK_STACK_SIZE_WORDS,
-                                       NULL,
-                                       ipconfigIP_TASK_PRIORITY,
-                                       &( xIPTaskHandle ) );
+                FreeRTOS_debug_printf( ( "FreeRTOS_IPInit_Multi: xNetworkBuffersInitialise() failed\n" ) );
+
+                /* Clean up. */
+                vQueueDelete( xNetworkEventQueue );
+                xNetworkEventQueue = NULL;
+
+                #if ( ipconfigUSE_IP_EVENT_PRIORITY != 0 )
+                {
+                    vQueueDelete( xNetworkControlQueue );
+                    xNetworkControlQueue = NULL;
+                }
+                #endif
             }
-            #endif /* configSUPPORT_STATIC_ALLOCATION */
         }
         else
         {
-            FreeRTOS_debug_printf( ( "FreeRTOS_IPInit_Multi: xNetworkBuffersInitialise() failed\n" ) );
-
-            /* Clean up. */
-            vQueueDelete( xNetworkEventQueue );
-            xNetworkEventQueue = NULL;
+            FreeRTOS_debug_printf( ( "FreeRTOS_IPInit_Multi: Network event queue could not be created\n" ) );
         }
     }
-    else
-    {
-        FreeRTOS_debug_printf( ( "FreeRTOS_IPInit_Multi: Network event queue could not be created\n" ) );
-    }
+    #endif /* if ( ipconfigIP_RUN_TO_COMPLETION != 0 ) */
 
     return xReturn;
 }
@@ -1039,6 +1669,40 @@ void FreeRTOS_ReleaseUDPPayloadBuffer( void const * pvBuffer )
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+
+/**
+ * @brief Get the time at which a UDP payload arrived, as it was recorded by
+ *        the driver.
+ *
+ * @param[in] pvBuffer The payload, as returned by FreeRTOS_recvfrom() when
+ *                     FREERTOS_ZERO_COPY is used.
+ * @param[out] pxTimestamp The time of reception.
+ *
+ * @return pdPASS when the driver has recorded the time, otherwise pdFAIL.
+ */
+    BaseType_t FreeRTOS_GetUDPPayloadTimestamp( void const * pvBuffer,
+                                                NetworkTimestamp_t * pxTimestamp )
+    {
+        const NetworkBufferDescriptor_t * pxBuffer;
+        BaseType_t xReturn = pdFAIL;
+
+        pxBuffer = pxUDPPayloadBuffer_to_NetworkBuffer( pvBuffer );
+        configASSERT( pxBuffer != NULL );
+
+        *pxTimestamp = pxBuffer->xTimestamp;
+
+        if( ( pxTimestamp->ulSeconds != 0U ) || ( pxTimestamp->ulNanoseconds != 0U ) )
+        {
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ipconfigUSE_NETWORK_TIMESTAMPS != 0 */
+/*-----------------------------------------------------------*/
+
 #if ( ipconfigUSE_IPv4 != 0 )
 
 /**
@@ -1159,6 +1823,8 @@ void FreeRTOS_ReleaseUDPPayloadBuffer( void const * pvBuffer )
             {
                 pxEndPoint->ipv4_settings.ulDNSServerAddresses[ 0 ] = *pulDNSServerAddress;
             }
+
+            FreeRTOS_RouteCacheInvalidate();
         }
     }
 /*-----------------------------------------------------------*/
@@ -1216,7 +1882,13 @@ void FreeRTOS_ReleaseUDPPayloadBuffer( void const * pvBuffer )
         BaseType_t xByteCountReleased;
         BaseType_t xReturn = pdFAIL;
         uint8_t * pucData;
-        size_t uxBytesAvailable = uxStreamBufferGetPtr( xSocket->u.xTCP.rxStream, &( pucData ) );
+
+        #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+            /* The data may be located in a network buffer kept by the socket. */
+            size_t uxBytesAvailable = uxTCPRxBufferGetPtr( xSocket, &( pucData ) );
+        #else
+            size_t uxBytesAvailable = uxStreamBufferGetPtr( xSocket->u.xTCP.rxStream, &( pucData ) );
+        #endif
 
         /* Make sure the pointer is correct. */
         configASSERT( pucData == ( uint8_t * ) pvBuffer );
@@ -1374,6 +2046,7 @@ BaseType_t xSendEventStructToIPTask( const IPStackEvent_t * pxEvent,
 {
     BaseType_t xReturn, xSendMessage;
     TickType_t uxUseTimeout = uxTimeout;
+    uint32_t ulPendingBit = 0U;
 
     if( ( xIPIsNetworkTaskReady() == pdFALSE ) && ( pxEvent->eEventType != eNetworkDownEvent ) )
     {
@@ -1404,6 +2077,26 @@ BaseType_t xSendEventStructToIPTask( const IPStackEvent_t * pxEvent,
         }
         #endif /* ipconfigUSE_TCP */
 
+        if( ( xSendMessage != pdFALSE ) && ( pxEvent->pvData == NULL ) && ipEVENT_IS_COALESCED( pxEvent->eEventType ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                ulPendingBit = ( uint32_t ) 1U << ( uint32_t ) pxEvent->eEventType;
+
+                if( ( ulIPEventPendingBits & ulPendingBit ) != 0U )
+                {
+                    /* The same event is still in the queue. */
+                    xSendMessage = pdFALSE;
+                    ulPendingBit = 0U;
+                }
+                else
+                {
+                    ulIPEventPendingBits |= ulPendingBit;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
         if( xSendMessage != pdFALSE )
         {
             /* The IP task cannot block itself while waiting for itself to
@@ -1413,13 +2106,44 @@ BaseType_t xSendEventStructToIPTask( const IPStackEvent_t * pxEvent,
                 uxUseTimeout = ( TickType_t ) 0;
             }
 
-            xReturn = xQueueSendToBack( xNetworkEventQueue, pxEvent, uxUseTimeout );
+            #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+            {
+                IPStackEvent_t xStampedEvent = *pxEvent;
+
+                ipSTAMP_IP_TASK_EVENT( xStampedEvent );
+                xReturn = prvSendEventToQueue( &xStampedEvent, uxUseTimeout );
+            }
+            #else
+                xReturn = prvSendEventToQueue( pxEvent, uxUseTimeout );
+            #endif
 
             if( xReturn == pdFAIL )
             {
+                if( ulPendingBit != 0U )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        ulIPEventPendingBits &= ~ulPendingBit;
+                    }
+                    taskEXIT_CRITICAL();
+                }
+
                 /* A message should have been sent to the IP task, but wasn't. */
                 FreeRTOS_debug_printf( ( "xSendEventStructToIPTask: CAN NOT ADD %d\n", pxEvent->eEventType ) );
                 iptraceSTACK_TX_EVENT_LOST( pxEvent->eEventType );
+                ipRESOURCE_SHORTAGE( eShortageEventQueue );
+
+                #if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+                    if( pxEvent->eEventType == eNetworkRxEvent )
+                    {
+                        const NetworkBufferDescriptor_t * pxBuffer = ( const NetworkBufferDescriptor_t * ) pxEvent->pvData;
+
+                        if( ( pxBuffer != NULL ) && ( pxBuffer->pxInterface != NULL ) )
+                        {
+                            ipCOUNT_RX_QUEUE_FULL( pxBuffer->pxInterface );
+                        }
+                    }
+                #endif
             }
         }
         else
@@ -1434,85 +2158,986 @@ BaseType_t xSendEventStructToIPTask( const IPStackEvent_t * pxEvent,
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_IP_EVENT_PRIORITY != 0 )
+
 /**
- * @brief Decide whether this packet should be processed or not based on the IP address in the packet.
+ * @brief Send an event to the IP-task.  A control event goes to
+ *        'xNetworkControlQueue', unless that queue is full.  All other events
+ *        go to 'xNetworkEventQueue'.
  *
- * @param[in] pucEthernetBuffer The ethernet packet under consideration.
+ * @param[in] pxEvent The event to be sent.
+ * @param[in] uxTimeout Timeout for waiting in case 'xNetworkEventQueue' is full.
  *
- * @return Enum saying whether to release or to process the packet.
+ * @return pdPASS if the event was queued, otherwise pdFAIL.
  */
-eFrameProcessingResult_t eConsiderFrameForProcessing( const uint8_t * const pucEthernetBuffer )
-{
-    eFrameProcessingResult_t eReturn = eReleaseBuffer;
-
-    do
+    static BaseType_t prvSendEventToQueue( const IPStackEvent_t * pxEvent,
+                                           TickType_t uxTimeout )
     {
-        const EthernetHeader_t * pxEthernetHeader = NULL;
-        const NetworkEndPoint_t * pxEndPoint = NULL;
-        uint16_t usFrameType;
+        BaseType_t xReturn = pdFAIL;
 
-        /* First, check the packet buffer is non-null. */
-        if( pucEthernetBuffer == NULL )
+        switch( pxEvent->eEventType )
         {
-            /* The packet buffer was null - release it. */
-            break;
-        }
+            case eNetworkRxEvent:
+            case eNetworkTxEvent:
+            case eStackTxEvent:
+            case eNetworkRxRingEvent:
+            case eStackTxBatchEvent:
+            case eStackTxReadyEvent:
+            case eNetworkPollEvent:
+            case eNetworkTxReadyEvent:
+                /* These events carry network packets. */
+                break;
 
-        /* Map the buffer onto Ethernet Header struct for easy access to fields. */
-        /* MISRA Ref 11.3.1 [Misaligned access] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-        /* coverity[misra_c_2012_rule_11_3_violation] */
-        pxEthernetHeader = ( ( const EthernetHeader_t * ) pucEthernetBuffer );
-        usFrameType = pxEthernetHeader->usFrameType;
+            default:
+                xReturn = xQueueSendToBack( xNetworkControlQueue, pxEvent, ( TickType_t ) 0U );
+
+                if( ( xReturn != pdFAIL ) &&
+                    ( xIsCallingFromIPTask() == pdFALSE ) &&
+                    ( uxQueueMessagesWaiting( xNetworkEventQueue ) == 0U ) )
+                {
+                    /* The IP-task may be sleeping on 'xNetworkEventQueue'.
+                     * If the wake-up event can not be queued, the IP-task is
+                     * awake anyway. */
+                    IPStackEvent_t xWakeUpEvent;
+
+                    xWakeUpEvent.eEventType = eNoEvent;
+                    xWakeUpEvent.pvData = NULL;
+                    ( void ) xQueueSendToBack( xNetworkEventQueue, &xWakeUpEvent, ( TickType_t ) 0U );
+                }
 
-        /* Second, filter based on ethernet frame type. */
-        /* The frame type field in the Ethernet header must have a value greater than 0x0600. */
-        if( ipIS_ETHERNET_FRAME_TYPE_INVALID( FreeRTOS_ntohs( usFrameType ) ) )
-        {
-            /* The packet was not an Ethernet II frame */
-            #if ipconfigIS_ENABLED( ipconfigFILTER_OUT_NON_ETHERNET_II_FRAMES )
-                /* filtering is enabled - release it. */
                 break;
-            #else
-                /* filtering is disabled - continue filter checks. */
-            #endif
         }
-        else if( usFrameType == ipARP_FRAME_TYPE )
+
+        if( xReturn == pdFAIL )
         {
-            /* The frame is an ARP type */
-            #if ipconfigIS_DISABLED( ipconfigUSE_IPv4 )
-                /* IPv4 is disabled - release it. */
-                break;
-            #else
-                /*  IPv4 is enabled - Continue filter checks. */
-            #endif
+            xReturn = xQueueSendToBack( xNetworkEventQueue, pxEvent, uxTimeout );
         }
-        else if( usFrameType == ipIPv4_FRAME_TYPE )
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Handle the events that are waiting in 'xNetworkControlQueue'.  At
+ *        most ipconfigEVENT_CONTROL_QUEUE_LENGTH events are handled, so that
+ *        a task that keeps on sending them can not starve the packets.
+ *
+ * @return pdTRUE when at least one event was handled, otherwise pdFALSE.
+ */
+    static BaseType_t prvProcessControlEvents( void )
+    {
+        IPStackEvent_t xControlEvent;
+        size_t uxCount;
+        BaseType_t xHandled = pdFALSE;
+
+        #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+            uint32_t ulStartTime;
+        #endif
+
+        for( uxCount = 0U; uxCount < ( size_t ) ipconfigEVENT_CONTROL_QUEUE_LENGTH; uxCount++ )
         {
-            /* The frame is an IPv4 type */
-            #if ipconfigIS_DISABLED( ipconfigUSE_IPv4 )
-                /* IPv4 is disabled - release it. */
+            if( xQueueReceive( xNetworkControlQueue, ( void * ) &xControlEvent, ( TickType_t ) 0U ) == pdFALSE )
+            {
                 break;
-            #else
-                /* IPv4 is enabled - Continue filter checks. */
+            }
+
+            #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+            {
+                ulStartTime = ipconfigIP_TASK_STATS_TIME();
+                prvIPTaskStatsReceived( &xControlEvent, ulStartTime );
+            }
             #endif
-        }
-        else if( usFrameType == ipIPv6_FRAME_TYPE )
-        {
-            /* The frame is an IPv6 type */
-            #if ipconfigIS_DISABLED( ipconfigUSE_IPv6 )
-                /* IPv6 is disabled - release it. */
-                break;
-            #else
-                /* IPv6 is enabled - Continue filter checks. */
+
+            iptraceNETWORK_EVENT_RECEIVED( xControlEvent.eEventType );
+
+            prvProcessIPEvent( &xControlEvent );
+
+            #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+            {
+                prvIPTaskStatsAddTime( &( xIPTaskStats.xEvents[ ( size_t ) ( ( BaseType_t ) xControlEvent.eEventType + 1 ) ] ), ulStartTime );
+            }
             #endif
+
+            xHandled = pdTRUE;
         }
-        else
-        {
-            /* The frame is an unsupported Ethernet II type */
-            #if ipconfigIS_ENABLED( ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES )
 
-                /* Processing custom Ethernet frames is enabled. No need for any further testing.
+        return xHandled;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_IP_EVENT_PRIORITY != 0 ) */
+
+#if ( ipconfigIP_RUN_TO_COMPLETION != 0 )
+
+/**
+ * @brief Handle an event in the calling task. When the calling task is
+ *        running the stack already, e.g. in a UDP receive handler, the event
+ *        is stored and handled before the stack is released.
+ *
+ * @param[in] pxEvent The event to be handled.
+ * @param[in] uxTimeout Time to wait while another task is running the stack.
+ *
+ * @return pdPASS if the event was handled or stored, otherwise pdFAIL.
+ */
+    static BaseType_t prvRunEventToCompletion( const IPStackEvent_t * pxEvent,
+                                               TickType_t uxTimeout )
+    {
+        BaseType_t xReturn = pdFAIL;
+        size_t uxIndex;
+
+        /* Before the scheduler runs, the current task handle is NULL as well. */
+        if( ( xIPTaskHandle != NULL ) && ( xIsCallingFromIPTask() == pdTRUE ) )
+        {
+            if( uxDeferredCount < ( size_t ) ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS )
+            {
+                uxIndex = ( uxDeferredHead + uxDeferredCount ) % ( size_t ) ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS;
+                xDeferredEvents[ uxIndex ] = *pxEvent;
+                uxDeferredCount++;
+                xReturn = pdPASS;
+            }
+        }
+        else if( prvIPStackTake( uxTimeout ) == pdPASS )
+        {
+            iptraceNETWORK_EVENT_RECEIVED( pxEvent->eEventType );
+
+            prvProcessIPEvent( pxEvent );
+
+            prvIPStackRelease();
+            xReturn = pdPASS;
+        }
+        else
+        {
+            /* Another task was running the stack for longer than 'uxTimeout'. */
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take the stack mutex. The stack is initialised by the first task
+ *        that takes it.
+ *
+ * @param[in] uxTimeout Time to wait while another task is running the stack.
+ *
+ * @return pdPASS if the calling task may run the stack, otherwise pdFAIL.
+ */
+    static BaseType_t prvIPStackTake( TickType_t uxTimeout )
+    {
+        BaseType_t xReturn = pdFAIL;
+
+        if( ( xIPStackMutex != NULL ) && ( xSemaphoreTake( xIPStackMutex, uxTimeout ) == pdPASS ) )
+        {
+            /* From now on, xIsCallingFromIPTask() returns pdTRUE in this task. */
+            xIPTaskHandle = xTaskGetCurrentTaskHandle();
+
+            if( xIPTaskInitialised == pdFALSE )
+            {
+                prvIPTask_Initialise();
+            }
+
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Handle the events that were sent while the stack was running, until
+ *        none are left: handling an event may send new ones.
+ */
+    static void prvProcessDeferredEvents( void )
+    {
+        IPStackEvent_t xEvent;
+
+        do
+        {
+            while( uxDeferredCount > 0U )
+            {
+                xEvent = xDeferredEvents[ uxDeferredHead ];
+                uxDeferredHead = ( uxDeferredHead + 1U ) % ( size_t ) ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS;
+                uxDeferredCount--;
+
+                iptraceNETWORK_EVENT_RECEIVED( xEvent.eEventType );
+
+                prvProcessIPEvent( &xEvent );
+            }
+
+            /* Network-down and poll requests from interrupts. */
+            prvIPTask_CheckPendingEvents();
+        } while( uxDeferredCount > 0U );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Finish the work of the calling task and give the stack mutex.
+ */
+    static void prvIPStackRelease( void )
+    {
+        prvProcessDeferredEvents();
+
+        #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+        {
+            vIPTxQueueFlush();
+        }
+        #endif
+
+        xIPTaskHandle = NULL;
+        ( void ) xSemaphoreGive( xIPStackMutex );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Drive the network timers when there is no IP-task, see
+ *        ipconfigIP_RUN_TO_COMPLETION. The first call initialises the stack.
+ *        This function may block while another task is running the stack.
+ *
+ * @return The time until the next timer expires: the longest time that the
+ *         application may wait before calling this function again.
+ */
+    TickType_t FreeRTOS_IPProcessTimers( void )
+    {
+        TickType_t xNextIPSleep = ( TickType_t ) ipconfigMAX_IP_TASK_SLEEP_TIME;
+
+        if( prvIPStackTake( portMAX_DELAY ) == pdPASS )
+        {
+            ipconfigWATCHDOG_TIMER();
+
+            /* Check the ARP and DHCP timers to see if there is any periodic
+             * or timeout processing to perform. */
+            vCheckNetworkTimers();
+
+            #if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+            {
+                prvRefillNetworkBufferReserves();
+            }
+            #endif
+
+            /* The timers may have sent events, which can reload timers. */
+            prvProcessDeferredEvents();
+
+            xNextIPSleep = xCalculateSleepTime();
+
+            prvIPStackRelease();
+        }
+
+        return xNextIPSleep;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigIP_RUN_TO_COMPLETION != 0 ) */
+
+/**
+ * @brief Called by a driver when it drops a received frame, e.g. because it
+ *        could not get a network buffer to replace the one holding the frame.
+ *
+ * @param[in] pxInterface The interface that received the frame.
+ * @param[in] eReason Why the frame was dropped.
+ */
+void vNetworkInterfaceRxDropped( struct xNetworkInterface * pxInterface,
+                                 eNetworkDropReason_t eReason )
+{
+    iptraceETHERNET_RX_EVENT_LOST();
+
+    if( pxInterface != NULL )
+    {
+        ipCOUNT_RX_DROP( pxInterface, eReason );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release the network buffers of a burst that could not be passed to
+ *        the IP-task.
+ *
+ * @param[in] ppxBuffers The array of network buffers.
+ * @param[in] uxFirst The index of the first buffer to be released.
+ * @param[in] uxCount The total number of buffers in the array.
+ */
+static void prvReleaseRxBurst( NetworkBufferDescriptor_t * const * ppxBuffers,
+                               size_t uxFirst,
+                               size_t uxCount )
+{
+    size_t uxIndex;
+
+    for( uxIndex = uxFirst; uxIndex < uxCount; uxIndex++ )
+    {
+        vReleaseNetworkBufferAndDescriptor( ppxBuffers[ uxIndex ] );
+        iptraceETHERNET_RX_EVENT_LOST();
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Pass a burst of received frames to the IP-task. Network interfaces
+ *        may call this function in stead of sending an eNetworkRxEvent for
+ *        every frame.
+ *
+ *        The buffers will be chained through 'pxNextBuffer' and the whole
+ *        burst is posted as a single eNetworkRxEvent.  When
+ *        ipconfigUSE_NETWORK_RX_RING is enabled, the buffers are stored in
+ *        the receive ring of their interface instead.
+ *
+ *        Buffers that could not be passed to the IP-task will be released
+ *        by this function, the caller must not access them anymore.
+ *
+ * @param[in] ppxBuffers An array of network buffers holding received frames.
+ *                       The members 'xDataLength' and 'pxInterface' must
+ *                       have been set.
+ * @param[in] uxCount The number of buffers in the array.
+ * @param[in] uxTimeout Timeout for waiting in case the queue is full. 0 for
+ *                      non-blocking calls.
+ *
+ * @return pdPASS if all buffers were passed to the IP-task, otherwise pdFAIL.
+ */
+BaseType_t xSendRxBurstToIPTask( NetworkBufferDescriptor_t * const * ppxBuffers,
+                                 size_t uxCount,
+                                 TickType_t uxTimeout )
+{
+    IPStackEvent_t xRxEvent;
+    BaseType_t xReturn = pdPASS;
+    size_t uxIndex;
+
+    xRxEvent.eEventType = eNetworkRxEvent;
+
+    #if ( ipconfigUSE_NETWORK_RX_RING != 0 )
+    {
+        /* The buffers are stored in the receive ring of their interface,
+         * only the first one will wake up the IP-task. */
+        ( void ) xRxEvent;
+        ( void ) uxTimeout;
+
+        for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+        {
+            if( xNetworkRxRingPush( ppxBuffers[ uxIndex ]->pxInterface, ppxBuffers[ uxIndex ] ) != pdPASS )
+            {
+                vReleaseNetworkBufferAndDescriptor( ppxBuffers[ uxIndex ] );
+                iptraceETHERNET_RX_EVENT_LOST();
+                xReturn = pdFAIL;
+            }
+        }
+    }
+    #else /* if ( ipconfigUSE_NETWORK_RX_RING != 0 ) */
+    {
+        if( uxCount > 0U )
+        {
+            /* Link the buffers together so that the IP-task can walk
+             * through the chain in prvHandleEthernetPacket(). */
+            for( uxIndex = 0U; uxIndex < ( uxCount - 1U ); uxIndex++ )
+            {
+                ppxBuffers[ uxIndex ]->pxNextBuffer = ppxBuffers[ uxIndex + 1U ];
+            }
+
+            ppxBuffers[ uxCount - 1U ]->pxNextBuffer = NULL;
+
+            xRxEvent.pvData = ( void * ) ppxBuffers[ 0 ];
+
+            if( xSendEventStructToIPTask( &xRxEvent, uxTimeout ) != pdPASS )
+            {
+                prvReleaseRxBurst( ppxBuffers, 0U, uxCount );
+                xReturn = pdFAIL;
+            }
+        }
+    }
+    #endif /* if ( ipconfigUSE_NETWORK_RX_RING != 0 ) */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_NETWORK_RX_RING != 0 )
+
+/**
+ * @brief Store a received network buffer in the receive ring of an interface.
+ *        Only the task that runs the driver of the interface may call this
+ *        function.  The IP-task is only woken up when it is not already busy
+ *        with the ring, so a burst of frames costs a single queue message.
+ *
+ * @param[in] pxInterface The interface that received the frame.
+ * @param[in] pxBuffer The network buffer holding the frame.  When pdPASS is
+ *                     returned, the buffer is owned by the IP-task.
+ *
+ * @return pdPASS when the buffer was stored, pdFAIL when the ring is full.
+ *         In the latter case, the caller is still the owner of the buffer.
+ */
+    BaseType_t xNetworkRxRingPush( NetworkInterface_t * pxInterface,
+                                   NetworkBufferDescriptor_t * pxBuffer )
+    {
+        NetworkRxRing_t * pxRing = &( pxInterface->xRxRing );
+        size_t uxHead = pxRing->uxHead;
+        BaseType_t xReturn = pdFAIL;
+        IPStackEvent_t xRxEvent;
+
+        if( ( uxHead - pxRing->uxTail ) < ( size_t ) ipconfigNETWORK_RX_RING_LENGTH )
+        {
+            pxRing->pxBuffers[ uxHead & ( ( size_t ) ipconfigNETWORK_RX_RING_LENGTH - 1U ) ] = pxBuffer;
+            ipRX_RING_BARRIER();
+            pxRing->uxHead = uxHead + 1U;
+            ipRX_RING_BARRIER();
+            xReturn = pdPASS;
+
+            if( pxRing->xEventPending == pdFALSE )
+            {
+                pxRing->xEventPending = pdTRUE;
+
+                xRxEvent.eEventType = eNetworkRxRingEvent;
+                xRxEvent.pvData = ( void * ) pxInterface;
+
+                if( xSendEventStructToIPTask( &xRxEvent, 0U ) != pdPASS )
+                {
+                    /* The buffer stays in the ring, it will be handled
+                     * together with the next frame that gets a message
+                     * through. */
+                    pxRing->xEventPending = pdFALSE;
+                    iptraceETHERNET_RX_EVENT_LOST();
+                }
+            }
+        }
+        else
+        {
+            ipCOUNT_RX_QUEUE_FULL( pxInterface );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called from the IP-task: take all buffers from the receive ring of
+ *        an interface and process them.
+ *
+ * @param[in] pxInterface The interface whose ring has buffers.
+ */
+    static void prvDrainNetworkRxRing( NetworkInterface_t * pxInterface )
+    {
+        NetworkRxRing_t * pxRing = &( pxInterface->xRxRing );
+        NetworkBufferDescriptor_t * pxBuffer;
+        size_t uxTail = pxRing->uxTail;
+
+        for( ; ; )
+        {
+            while( uxTail != pxRing->uxHead )
+            {
+                ipRX_RING_BARRIER();
+                pxBuffer = pxRing->pxBuffers[ uxTail & ( ( size_t ) ipconfigNETWORK_RX_RING_LENGTH - 1U ) ];
+                uxTail++;
+                ipRX_RING_BARRIER();
+                pxRing->uxTail = uxTail;
+
+                prvHandleEthernetPacket( pxBuffer );
+            }
+
+            /* Allow the driver to send a new message, and look once more
+             * at the ring to catch a buffer that was stored while the flag
+             * was still set. */
+            pxRing->xEventPending = pdFALSE;
+            ipRX_RING_BARRIER();
+
+            if( uxTail == pxRing->uxHead )
+            {
+                break;
+            }
+
+            pxRing->xEventPending = pdTRUE;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_NETWORK_RX_RING != 0 */
+
+#if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+
+/**
+ * @brief Take an empty network buffer from the reserve of an interface.  No
+ *        lock is taken and the time is bounded, so an interrupt handler can
+ *        use it to refill its DMA receive descriptors.  The reserve has a
+ *        single consumer: per interface, only one context may call this
+ *        function.
+ *
+ * @param[in] pxInterface The interface that needs a buffer.
+ *
+ * @return A network buffer of ipTOTAL_ETHERNET_FRAME_SIZE bytes, or NULL when
+ *         the reserve is empty.
+ */
+    NetworkBufferDescriptor_t * pxNetworkBufferGetFromReserveISR( NetworkInterface_t * pxInterface )
+    {
+        NetworkBufferReserve_t * pxReserve = &( pxInterface->xRxReserve );
+        NetworkBufferDescriptor_t * pxBuffer = NULL;
+        size_t uxTail = pxReserve->uxTail;
+
+        if( uxTail != pxReserve->uxHead )
+        {
+            ipRX_RING_BARRIER();
+            pxBuffer = pxReserve->pxBuffers[ uxTail & ( ( size_t ) ipconfigNETWORK_BUFFER_RX_RESERVE - 1U ) ];
+            ipRX_RING_BARRIER();
+            pxReserve->uxTail = uxTail + 1U;
+        }
+
+        return pxBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called from the IP-task: fill the buffer reserve of every interface.
+ *        The allocation does not block, when the pool is exhausted, the
+ *        reserves will be topped up the next time.
+ */
+    static void prvRefillNetworkBufferReserves( void )
+    {
+        NetworkInterface_t * pxInterface;
+        NetworkBufferReserve_t * pxReserve;
+        NetworkBufferDescriptor_t * pxBuffer;
+        size_t uxHead;
+
+        for( pxInterface = FreeRTOS_FirstNetworkInterface();
+             pxInterface != NULL;
+             pxInterface = FreeRTOS_NextNetworkInterface( pxInterface ) )
+        {
+            pxReserve = &( pxInterface->xRxReserve );
+            uxHead = pxReserve->uxHead;
+
+            while( ( uxHead - pxReserve->uxTail ) < ( size_t ) ipconfigNETWORK_BUFFER_RX_RESERVE )
+            {
+                pxBuffer = pxGetNetworkBufferWithDescriptor( ( size_t ) ipTOTAL_ETHERNET_FRAME_SIZE, 0U );
+
+                if( pxBuffer == NULL )
+                {
+                    break;
+                }
+
+                pxBuffer->pxInterface = pxInterface;
+                pxReserve->pxBuffers[ uxHead & ( ( size_t ) ipconfigNETWORK_BUFFER_RX_RESERVE - 1U ) ] = pxBuffer;
+                uxHead++;
+                ipRX_RING_BARRIER();
+                pxReserve->uxHead = uxHead;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigNETWORK_BUFFER_RX_RESERVE != 0 */
+
+#if ( ( ipconfigUSE_DRIVER_RESPONDER != 0 ) && ( ipconfigUSE_IPv4 != 0 ) )
+
+/**
+ * @brief Called by a driver for a received frame, before passing it to the
+ *        IP-task: answer ARP requests and ICMP echo requests for the end-points
+ *        of the interface directly, so the IP-task does not have to wake up.
+ *        It must be called from a task, e.g. the deferred handler of the
+ *        driver, and not from an interrupt.  The ARP cache is not updated.
+ *
+ * @param[in] pxNetworkBuffer The received frame, 'pxInterface' must be set.
+ *
+ * @return pdTRUE when the frame was turned into a reply and passed to the
+ *         driver, the buffer does not belong to the caller anymore.  pdFALSE
+ *         when the frame must be sent to the IP-task as usual.
+ */
+    BaseType_t xIPDriverRespond( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkInterface_t * pxInterface = pxNetworkBuffer->pxInterface;
+        NetworkEndPoint_t * pxEndPoint = NULL;
+        BaseType_t xReturn = pdFALSE;
+        uint32_t ulTargetAddress = 0U;
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        EthernetHeader_t * pxEthernetHeader = ( ( EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+
+        do
+        {
+            if( ( pxInterface == NULL ) ||
+                ( xIPIsNetworkTaskReady() == pdFALSE ) ||
+                ( pxNetworkBuffer->xDataLength < sizeof( ARPPacket_t ) ) )
+            {
+                break;
+            }
+
+            #if ( ipconfigUSE_NETWORK_EMULATION != 0 )
+                /* The emulator must see every frame. */
+                if( xNetEmAttached( pxInterface ) != pdFALSE )
+                {
+                    break;
+                }
+            #endif
+
+            #if ( ipconfigUSE_PACKET_FILTER != 0 )
+                /* The program can be run outside the IP-task, see
+                 * FreeRTOS_SetPacketFilter().  A rejected frame is dropped
+                 * and counted by the IP-task. */
+                if( xPacketFilterAccepts( pxNetworkBuffer ) == pdFALSE )
+                {
+                    break;
+                }
+            #endif
+
+            /* Find the target address, the frame type is checked before the
+             * length, so every case has read at least an ARPPacket_t. */
+            if( pxEthernetHeader->usFrameType == ipARP_FRAME_TYPE )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                ulTargetAddress = ( ( const ARPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer )->xARPHeader.ulTargetProtocolAddress;
+            }
+
+            #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 )
+                else if( ( pxEthernetHeader->usFrameType == ipIPv4_FRAME_TYPE ) &&
+                         ( pxNetworkBuffer->xDataLength >= sizeof( ICMPPacket_t ) ) )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    ulTargetAddress = ( ( const IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer )->xIPHeader.ulDestinationIPAddress;
+                }
+            #endif
+            else
+            {
+                break;
+            }
+
+            for( pxEndPoint = FreeRTOS_FirstEndPoint( pxInterface );
+                 pxEndPoint != NULL;
+                 pxEndPoint = FreeRTOS_NextEndPoint( pxInterface, pxEndPoint ) )
+            {
+                if( ( ENDPOINT_IS_IPv4( pxEndPoint ) ) &&
+                    ( pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED ) &&
+                    ( pxEndPoint->ipv4_settings.ulIPAddress != 0U ) &&
+                    ( pxEndPoint->ipv4_settings.ulIPAddress == ulTargetAddress ) )
+                {
+                    break;
+                }
+            }
+
+            if( pxEndPoint == NULL )
+            {
+                break;
+            }
+
+            if( pxEthernetHeader->usFrameType == ipARP_FRAME_TYPE )
+            {
+                xReturn = xARPRespondInDriver( pxNetworkBuffer, pxEndPoint );
+            }
+
+            #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 )
+                /* Only a ping to the unicast address of the end-point. */
+                else if( memcmp( pxEthernetHeader->xDestinationAddress.ucBytes, pxEndPoint->xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES ) == 0 )
+                {
+                    xReturn = xICMPRespondInDriver( pxNetworkBuffer, pxEndPoint );
+                }
+            #endif
+            else
+            {
+                /* A multicast or broadcast ping. */
+            }
+        } while( ipFALSE_BOOL );
+
+        if( xReturn != pdFALSE )
+        {
+            /* Return the frame to its sender. */
+            pxNetworkBuffer->pxEndPoint = pxEndPoint;
+            ( void ) memcpy( pxEthernetHeader->xDestinationAddress.ucBytes, pxEthernetHeader->xSourceAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+            ( void ) memcpy( pxEthernetHeader->xSourceAddress.ucBytes, pxEndPoint->xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+
+            #if ( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 )
+                if( pxNetworkBuffer->xDataLength < ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES )
+                {
+                    ( void ) memset( &( pxNetworkBuffer->pucEthernetBuffer[ pxNetworkBuffer->xDataLength ] ), 0, ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES - pxNetworkBuffer->xDataLength );
+                    pxNetworkBuffer->xDataLength = ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES;
+                }
+            #endif
+
+            iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+            ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_DRIVER_RESPONDER != 0 ) && ( ipconfigUSE_IPv4 != 0 ) */
+
+#if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+
+/**
+ * @brief Ask the IP-task to call the pfPoll() function of an interface.
+ *        Call this from a task, use FreeRTOS_NetworkInterfacePollFromISR()
+ *        from an ISR.
+ *
+ * @param[in] pxInterface The interface that has received frames.
+ */
+    void FreeRTOS_NetworkInterfacePoll( NetworkInterface_t * pxInterface )
+    {
+        IPStackEvent_t xPollEvent;
+
+        if( pxInterface->xPollPending == pdFALSE )
+        {
+            pxInterface->xPollPending = pdTRUE;
+
+            xPollEvent.eEventType = eNetworkPollEvent;
+            xPollEvent.pvData = ( void * ) pxInterface;
+
+            if( xSendEventStructToIPTask( &xPollEvent, 0U ) != pdPASS )
+            {
+                /* The queue is full, so the IP-task is busy and it will
+                 * find the request in prvIPTask_CheckPendingEvents(). */
+                xNetworkPollPending = pdTRUE;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Ask the IP-task to call the pfPoll() function of an interface.
+ *        This version is to be called from an ISR.
+ *
+ * @param[in] pxInterface The interface that has received frames.
+ *
+ * @return pdTRUE when a context switch should be performed before the
+ *         interrupt is exited, otherwise pdFALSE.
+ */
+    BaseType_t FreeRTOS_NetworkInterfacePollFromISR( NetworkInterface_t * pxInterface )
+    {
+        IPStackEvent_t xPollEvent;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        if( pxInterface->xPollPending == pdFALSE )
+        {
+            pxInterface->xPollPending = pdTRUE;
+
+            xPollEvent.eEventType = eNetworkPollEvent;
+            xPollEvent.pvData = ( void * ) pxInterface;
+            ipSTAMP_IP_TASK_EVENT( xPollEvent );
+
+            #if ( ipconfigIP_RUN_TO_COMPLETION != 0 )
+            {
+                /* There is no queue, the next task that runs the stack will
+                 * poll the interface. */
+                ( void ) xPollEvent;
+                xNetworkPollPending = pdTRUE;
+            }
+            #else
+            {
+                if( xQueueSendToBackFromISR( xNetworkEventQueue, &xPollEvent, &xHigherPriorityTaskWoken ) != pdPASS )
+                {
+                    xNetworkPollPending = pdTRUE;
+                }
+            }
+            #endif
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called from within pfPoll(): process a received frame, or a chain
+ *        of frames linked through 'pxNextBuffer'.
+ *
+ * @param[in] pxBuffer The network buffer, it is now owned by the IP-task.
+ */
+    void vNetworkInterfacePollInput( NetworkBufferDescriptor_t * pxBuffer )
+    {
+        prvHandleEthernetPacket( pxBuffer );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Let an interface hand over at most ipconfigNETWORK_INTERFACE_POLL_BUDGET
+ *        received frames.  When the budget was used up, the interface will be
+ *        polled again after the events that are waiting in the queue.
+ *
+ * @param[in] pxInterface The interface to be polled.
+ */
+    static void prvPollNetworkInterface( NetworkInterface_t * pxInterface )
+    {
+        IPStackEvent_t xPollEvent;
+        BaseType_t xHandled;
+
+        /* Clear the flag before polling: a request made while pfPoll()
+         * enables the RX interrupt again will then not get lost. */
+        pxInterface->xPollPending = pdFALSE;
+
+        if( pxInterface->pfPoll != NULL )
+        {
+            xHandled = pxInterface->pfPoll( pxInterface, ( BaseType_t ) ipconfigNETWORK_INTERFACE_POLL_BUDGET );
+
+            if( ( xHandled >= ( BaseType_t ) ipconfigNETWORK_INTERFACE_POLL_BUDGET ) &&
+                ( pxInterface->xPollPending == pdFALSE ) )
+            {
+                /* More frames may be waiting.  Go to the back of the queue
+                 * so that other events get a chance. */
+                pxInterface->xPollPending = pdTRUE;
+
+                xPollEvent.eEventType = eNetworkPollEvent;
+                xPollEvent.pvData = ( void * ) pxInterface;
+
+                if( xSendEventStructToIPTask( &xPollEvent, 0U ) != pdPASS )
+                {
+                    xNetworkPollPending = pdTRUE;
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_NETWORK_INTERFACE_POLL != 0 */
+
+#if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
+/**
+ * @brief Tell the IP-task that the transmit ring of an interface has room
+ *        again, after pfOutput() returned ipTX_BUSY.  Call this from a task,
+ *        use FreeRTOS_NetworkInterfaceTxReadyFromISR() from an ISR.
+ *
+ * @param[in] pxInterface The interface that can send again.
+ */
+    void FreeRTOS_NetworkInterfaceTxReady( NetworkInterface_t * pxInterface )
+    {
+        IPStackEvent_t xReadyEvent;
+
+        if( pxInterface->xTxReadyPending == pdFALSE )
+        {
+            pxInterface->xTxReadyPending = pdTRUE;
+
+            xReadyEvent.eEventType = eNetworkTxReadyEvent;
+            xReadyEvent.pvData = ( void * ) pxInterface;
+
+            if( xSendEventStructToIPTask( &xReadyEvent, 0U ) != pdPASS )
+            {
+                /* The queue is full, so the IP-task is busy and it will
+                 * find the notification in prvIPTask_CheckPendingEvents(). */
+                xNetworkTxReadyPending = pdTRUE;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tell the IP-task that the transmit ring of an interface has room
+ *        again.  This version is to be called from an ISR.
+ *
+ * @param[in] pxInterface The interface that can send again.
+ *
+ * @return pdTRUE when a context switch should be performed before the
+ *         interrupt is exited, otherwise pdFALSE.
+ */
+    BaseType_t FreeRTOS_NetworkInterfaceTxReadyFromISR( NetworkInterface_t * pxInterface )
+    {
+        IPStackEvent_t xReadyEvent;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        if( pxInterface->xTxReadyPending == pdFALSE )
+        {
+            pxInterface->xTxReadyPending = pdTRUE;
+
+            xReadyEvent.eEventType = eNetworkTxReadyEvent;
+            xReadyEvent.pvData = ( void * ) pxInterface;
+            ipSTAMP_IP_TASK_EVENT( xReadyEvent );
+
+            #if ( ipconfigIP_RUN_TO_COMPLETION != 0 )
+            {
+                /* There is no queue, the next task that runs the stack will
+                 * handle the notification. */
+                ( void ) xReadyEvent;
+                xNetworkTxReadyPending = pdTRUE;
+            }
+            #else
+            {
+                if( xQueueSendToBackFromISR( xNetworkEventQueue, &xReadyEvent, &xHigherPriorityTaskWoken ) != pdPASS )
+                {
+                    xNetworkTxReadyPending = pdTRUE;
+                }
+            }
+            #endif
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TX_BACKPRESSURE != 0 */
+
+/**
+ * @brief Decide whether this packet should be processed or not based on the IP address in the packet.
+ *
+ * @param[in] pucEthernetBuffer The ethernet packet under consideration.
+ *
+ * @return Enum saying whether to release or to process the packet.
+ */
+eFrameProcessingResult_t eConsiderFrameForProcessing( const uint8_t * const pucEthernetBuffer )
+{
+    eFrameProcessingResult_t eReturn = eReleaseBuffer;
+
+    do
+    {
+        const EthernetHeader_t * pxEthernetHeader = NULL;
+        const NetworkEndPoint_t * pxEndPoint = NULL;
+        uint16_t usFrameType;
+
+        /* First, check the packet buffer is non-null. */
+        if( pucEthernetBuffer == NULL )
+        {
+            /* The packet buffer was null - release it. */
+            break;
+        }
+
+        /* Map the buffer onto Ethernet Header struct for easy access to fields. */
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        pxEthernetHeader = ( ( const EthernetHeader_t * ) pucEthernetBuffer );
+        usFrameType = pxEthernetHeader->usFrameType;
+
+        /* Second, filter based on ethernet frame type. */
+        /* The frame type field in the Ethernet header must have a value greater than 0x0600. */
+        if( ipIS_ETHERNET_FRAME_TYPE_INVALID( FreeRTOS_ntohs( usFrameType ) ) )
+        {
+            /* The packet was not an Ethernet II frame */
+            #if ipconfigIS_ENABLED( ipconfigFILTER_OUT_NON_ETHERNET_II_FRAMES )
+                /* filtering is enabled - release it. */
+                break;
+            #else
+                /* filtering is disabled - continue filter checks. */
+            #endif
+        }
+        else if( usFrameType == ipARP_FRAME_TYPE )
+        {
+            /* The frame is an ARP type */
+            #if ipconfigIS_DISABLED( ipconfigUSE_IPv4 )
+                /* IPv4 is disabled - release it. */
+                break;
+            #else
+                /*  IPv4 is enabled - Continue filter checks. */
+            #endif
+        }
+        else if( usFrameType == ipIPv4_FRAME_TYPE )
+        {
+            /* The frame is an IPv4 type */
+            #if ipconfigIS_DISABLED( ipconfigUSE_IPv4 )
+                /* IPv4 is disabled - release it. */
+                break;
+            #else
+                /* IPv4 is enabled - Continue filter checks. */
+            #endif
+        }
+        else if( usFrameType == ipIPv6_FRAME_TYPE )
+        {
+            /* The frame is an IPv6 type */
+            #if ipconfigIS_DISABLED( ipconfigUSE_IPv6 )
+                /* IPv6 is disabled - release it. */
+                break;
+            #else
+                /* IPv6 is enabled - Continue filter checks. */
+            #endif
+        }
+        else
+        {
+            /* The frame is an unsupported Ethernet II type */
+            #if ipconfigIS_ENABLED( ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES )
+
+                /* Processing custom Ethernet frames is enabled. No need for any further testing.
                  * Accept the frame whether it's a unicast, multicast, or broadcast. */
                 eReturn = eProcessBuffer;
             #endif
@@ -1626,6 +3251,35 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
          * it is safe to break out of the do{}while() and let the second half of this
          * function handle the releasing of pxNetworkBuffer */
 
+        #if ( ipconfigUSE_NETWORK_EMULATION != 0 )
+            /* An emulator may hold the frame for a while, it will come back
+             * here when it is due. */
+            if( ( pxNetworkBuffer->pxInterface != NULL ) &&
+                ( xNetEmReceive( pxNetworkBuffer ) == pdFALSE ) )
+            {
+                eReturned = eFrameConsumed;
+                break;
+            }
+        #endif
+
+        #if ( ipconfigUSE_LINK_BONDING != 0 )
+            /* A frame received by a member of a bond belongs to the bond. */
+            if( pxNetworkBuffer->pxInterface != NULL )
+            {
+                vBondReceive( pxNetworkBuffer );
+            }
+        #endif
+
+        #if ( ipconfigUSE_VLAN != 0 )
+            /* Assign a tagged frame to its VLAN interface before anything else
+             * looks at it. This also finds the end-point on that interface. */
+            if( ( pxNetworkBuffer->pxInterface != NULL ) &&
+                ( xVLANReceive( pxNetworkBuffer ) == pdFALSE ) )
+            {
+                break;
+            }
+        #endif
+
         if( ( pxNetworkBuffer->pxInterface == NULL ) || ( pxNetworkBuffer->pxEndPoint == NULL ) )
         {
             break;
@@ -1641,13 +3295,25 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
          * None of the above need to be checked again in code that handles incoming packets. */
 
         iptraceNETWORK_INTERFACE_INPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+        ipCOUNT_RX( pxNetworkBuffer->pxInterface, xTotal, pxNetworkBuffer->xDataLength );
 
         /* Interpret the Ethernet frame. */
         if( pxNetworkBuffer->xDataLength < sizeof( EthernetHeader_t ) )
         {
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
             break;
         }
 
+        #if ( ipconfigUSE_PACKET_FILTER != 0 )
+            /* Run the rules of FreeRTOS_SetPacketFilter() before any
+             * other check. */
+            if( xPacketFilterAccepts( pxNetworkBuffer ) == pdFALSE )
+            {
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropFiltered );
+                break;
+            }
+        #endif
+
         /* Map the buffer onto the Ethernet Header struct for easy access to the fields. */
 
         /* MISRA Ref 11.3.1 [Misaligned access] */
@@ -1655,10 +3321,25 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
         /* coverity[misra_c_2012_rule_11_3_violation] */
         pxEthernetHeader = ( ( const EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
 
-        /* The condition "eReturned == eProcessBuffer" must be true. */
-        #if ( ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES == 0 )
-            if( eConsiderFrameForProcessing( pxNetworkBuffer->pucEthernetBuffer ) == eProcessBuffer )
+        /* Drop the frames that eConsiderFrameForProcessing() does not want. */
+        #if ( ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES == 0 )
+            #if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+                /* The filter of the interface rejects most unwanted frames
+                 * with a few loads. */
+                if( xMACFilterAccepts( pxNetworkBuffer->pxInterface, &( pxEthernetHeader->xDestinationAddress ) ) == pdFALSE )
+                {
+                    ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropFiltered );
+                    break;
+                }
+            #endif
+
+            if( eConsiderFrameForProcessing( pxNetworkBuffer->pucEthernetBuffer ) != eProcessBuffer )
+            {
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropFiltered );
+                break;
+            }
         #endif
+
         {
             /* Interpret the received Ethernet packet. */
             switch( pxEthernetHeader->usFrameType )
@@ -1666,6 +3347,8 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
                 #if ( ipconfigUSE_IPv4 != 0 )
                     case ipARP_FRAME_TYPE:
 
+                        ipCOUNT_RX( pxNetworkBuffer->pxInterface, xProtocols[ eCounterARP ], pxNetworkBuffer->xDataLength );
+
                         /* The Ethernet frame contains an ARP packet. */
                         if( pxNetworkBuffer->xDataLength >= sizeof( ARPPacket_t ) )
                         {
@@ -1676,6 +3359,7 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
                         }
                         else
                         {
+                            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
                             eReturned = eReleaseBuffer;
                         }
                         break;
@@ -1687,6 +3371,15 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
                     /* The Ethernet frame contains an IP packet. */
                     if( pxNetworkBuffer->xDataLength >= sizeof( IPPacket_t ) )
                     {
+                        ipASSERT_IP_HEADER_ALIGNED( pxNetworkBuffer->pucEthernetBuffer );
+
+                        #if ( ipconfigUSE_PACKET_METADATA != 0 )
+                        {
+                            /* Find the headers once for all later stages. */
+                            vPacketMetadataParse( pxNetworkBuffer );
+                        }
+                        #endif
+
                         /* MISRA Ref 11.3.1 [Misaligned access] */
                         /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
                         /* coverity[misra_c_2012_rule_11_3_violation] */
@@ -1694,6 +3387,7 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
                     }
                     else
                     {
+                        ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
                         eReturned = eReleaseBuffer;
                     }
 
@@ -1705,6 +3399,7 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
                         eReturned = eApplicationProcessCustomFrameHook( pxNetworkBuffer );
                     #else
                         /* No other packet types are handled.  Nothing to do. */
+                        ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropUnsupported );
                         eReturned = eReleaseBuffer;
                     #endif
                     break;
@@ -1734,16 +3429,24 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
 
         case eWaitingARPResolution:
 
-            if( pxARPWaitingNetworkBuffer == NULL )
-            {
-                pxARPWaitingNetworkBuffer = pxNetworkBuffer;
-                vIPTimerStartARPResolution( ipARP_RESOLUTION_MAX_DELAY );
+            #if ( ipconfigARP_WAITING_BUFFER_COUNT > 1 )
+                if( xIPWaitingBufferAdd( pxNetworkBuffer ) == pdPASS )
+                {
+                    iptraceDELAYED_ARP_REQUEST_STARTED();
+                }
+            #else
+                if( pxARPWaitingNetworkBuffer == NULL )
+                {
+                    pxARPWaitingNetworkBuffer = pxNetworkBuffer;
+                    vIPTimerStartARPResolution( ipARP_RESOLUTION_MAX_DELAY );
 
-                iptraceDELAYED_ARP_REQUEST_STARTED();
-            }
+                    iptraceDELAYED_ARP_REQUEST_STARTED();
+                }
+            #endif /* if ( ipconfigARP_WAITING_BUFFER_COUNT > 1 ) */
             else
             {
                 /* We are already waiting on one ARP resolution. This frame will be dropped. */
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropARPPending );
                 vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
 
                 iptraceDELAYED_ARP_BUFFER_FULL();
@@ -1764,6 +3467,226 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigARP_WAITING_BUFFER_COUNT > 1 )
+
+/**
+ * @brief Check if a waiting packet was sent from a given address.
+ *
+ * @param[in] pxNetworkBuffer The waiting packet.
+ * @param[in] ulIPv4Address The IPv4 address, used when pxIPv6Address is NULL.
+ * @param[in] pxIPv6Address The IPv6 address, or NULL.
+ *
+ * @return pdTRUE when the source address of the packet matches.
+ */
+    static BaseType_t prvWaitingBufferFrom( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                            uint32_t ulIPv4Address,
+                                            const IPv6_Address_t * pxIPv6Address )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxIPv6Address != NULL )
+        {
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( uxIPHeaderSizePacket( pxNetworkBuffer ) == ipSIZE_OF_IPv6_HEADER )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    const IPPacket_IPv6_t * pxIPPacket = ( ( const IPPacket_IPv6_t * ) pxNetworkBuffer->pucEthernetBuffer );
+
+                    if( memcmp( pxIPv6Address->ucBytes, pxIPPacket->xIPHeader.xSourceAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                }
+            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        }
+        else
+        {
+            #if ( ipconfigUSE_IPv4 != 0 )
+                if( uxIPHeaderSizePacket( pxNetworkBuffer ) == ipSIZE_OF_IPv4_HEADER )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    const IPPacket_t * pxIPPacket = ( ( const IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+
+                    if( pxIPPacket->xIPHeader.ulSourceIPAddress == ulIPv4Address )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                }
+            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove an entry from xWaitingBuffers[], keeping the order of the
+ *        others.
+ *
+ * @param[in] uxIndex The entry to be removed.
+ */
+    static void prvWaitingBufferRemove( size_t uxIndex )
+    {
+        size_t uxNext;
+
+        for( uxNext = uxIndex + 1U; uxNext < uxWaitingBufferCount; uxNext++ )
+        {
+            xWaitingBuffers[ uxNext - 1U ] = xWaitingBuffers[ uxNext ];
+        }
+
+        uxWaitingBufferCount--;
+        xWaitingBuffers[ uxWaitingBufferCount ].pxBuffer = NULL;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Set a received packet aside until the address of its sender has been
+ *        resolved.
+ *
+ * @param[in] pxNetworkBuffer The packet.
+ *
+ * @return pdPASS when the packet was stored, pdFAIL when there is no space for
+ *         it, the caller must release it.
+ */
+    BaseType_t xIPWaitingBufferAdd( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xReturn = pdFAIL;
+        const IPv6_Address_t * pxIPv6Address = NULL;
+        uint32_t ulIPv4Address = 0U;
+        size_t uxIndex;
+        size_t uxFromSender = 0U;
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            if( uxIPHeaderSizePacket( pxNetworkBuffer ) == ipSIZE_OF_IPv6_HEADER )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxIPv6Address = &( ( ( const IPPacket_IPv6_t * ) pxNetworkBuffer->pucEthernetBuffer )->xIPHeader.xSourceAddress );
+            }
+            else
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        {
+            #if ( ipconfigUSE_IPv4 != 0 )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                ulIPv4Address = ( ( const IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer )->xIPHeader.ulSourceIPAddress;
+            }
+            #endif
+        }
+
+        for( uxIndex = 0U; uxIndex < uxWaitingBufferCount; uxIndex++ )
+        {
+            if( prvWaitingBufferFrom( xWaitingBuffers[ uxIndex ].pxBuffer, ulIPv4Address, pxIPv6Address ) != pdFALSE )
+            {
+                uxFromSender++;
+            }
+        }
+
+        if( ( uxWaitingBufferCount < ( size_t ) ipconfigARP_WAITING_BUFFER_COUNT ) &&
+            ( uxFromSender < ( size_t ) ipconfigARP_WAITING_BUFFERS_PER_ADDRESS ) )
+        {
+            xWaitingBuffers[ uxWaitingBufferCount ].pxBuffer = pxNetworkBuffer;
+            xWaitingBuffers[ uxWaitingBufferCount ].xTimeQueued = xTaskGetTickCount();
+            uxWaitingBufferCount++;
+
+            if( uxWaitingBufferCount == 1U )
+            {
+                vIPTimerStartARPResolution( ipARP_RESOLUTION_MAX_DELAY );
+            }
+
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The address of a sender has been resolved: pass all packets that
+ *        were set aside for it to the IP-task again, in the order in which
+ *        they were received.
+ *
+ * @param[in] ulIPv4Address The IPv4 address, used when pxIPv6Address is NULL.
+ * @param[in] pxIPv6Address The IPv6 address, or NULL.
+ */
+    void vIPWaitingBuffersResolved( uint32_t ulIPv4Address,
+                                    const IPv6_Address_t * pxIPv6Address )
+    {
+        size_t uxIndex = 0U;
+
+        while( uxIndex < uxWaitingBufferCount )
+        {
+            NetworkBufferDescriptor_t * pxBuffer = xWaitingBuffers[ uxIndex ].pxBuffer;
+
+            if( prvWaitingBufferFrom( pxBuffer, ulIPv4Address, pxIPv6Address ) != pdFALSE )
+            {
+                IPStackEvent_t xEventMessage;
+                const TickType_t xDontBlock = ( TickType_t ) 0;
+
+                prvWaitingBufferRemove( uxIndex );
+
+                xEventMessage.eEventType = eNetworkRxEvent;
+                xEventMessage.pvData = ( void * ) pxBuffer;
+
+                if( xSendEventStructToIPTask( &xEventMessage, xDontBlock ) != pdPASS )
+                {
+                    /* Failed to send the message, so release the network buffer. */
+                    vReleaseNetworkBufferAndDescriptor( pxBuffer );
+                }
+
+                iptrace_DELAYED_ARP_REQUEST_REPLIED();
+            }
+            else
+            {
+                uxIndex++;
+            }
+        }
+
+        if( uxWaitingBufferCount == 0U )
+        {
+            vIPSetARPResolutionTimerEnableState( pdFALSE );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called when the ARP resolution timer expires: drop the packets that
+ *        have waited ipARP_RESOLUTION_MAX_DELAY ticks, and restart the timer
+ *        for the oldest of the remaining packets.
+ */
+    void vIPWaitingBuffersCheckTimeout( void )
+    {
+        TickType_t xNow = xTaskGetTickCount();
+
+        while( ( uxWaitingBufferCount > 0U ) &&
+               ( ( xNow - xWaitingBuffers[ 0 ].xTimeQueued ) >= ipARP_RESOLUTION_MAX_DELAY ) )
+        {
+            vReleaseNetworkBufferAndDescriptor( xWaitingBuffers[ 0 ].pxBuffer );
+            prvWaitingBufferRemove( 0U );
+
+            iptraceDELAYED_ARP_TIMER_EXPIRED();
+        }
+
+        if( uxWaitingBufferCount > 0U )
+        {
+            vIPTimerStartARPResolution( ipARP_RESOLUTION_MAX_DELAY - ( xNow - xWaitingBuffers[ 0 ].xTimeQueued ) );
+        }
+        else
+        {
+            vIPSetARPResolutionTimerEnableState( pdFALSE );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigARP_WAITING_BUFFER_COUNT > 1 ) */
+
 /**
  * @brief Check the sizes of the UDP packet and forward it to the UDP module
  *        ( xProcessReceivedUDPPacket() )
@@ -1897,9 +3820,12 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
         #if ( ipconfigUSE_IPv6 != 0 )
             case ipIPv6_FRAME_TYPE:
 
+                ipCOUNT_RX( pxNetworkBuffer->pxInterface, xProtocols[ eCounterIPv6 ], pxNetworkBuffer->xDataLength );
+
                 if( pxNetworkBuffer->xDataLength < sizeof( IPPacket_IPv6_t ) )
                 {
                     /* The packet size is less than minimum IPv6 packet. */
+                    ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
                     eReturn = eReleaseBuffer;
                 }
                 else
@@ -1911,10 +3837,22 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
 
                     uxHeaderLength = ipSIZE_OF_IPv6_HEADER;
                     ucProtocol = pxIPHeader_IPv6->ucNextHeader;
-                    /* MISRA Ref 11.3.1 [Misaligned access] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-                    /* coverity[misra_c_2012_rule_11_3_violation] */
-                    eReturn = prvAllowIPPacketIPv6( ( ( const IPHeader_IPv6_t * ) &( pxIPPacket->xIPHeader ) ), pxNetworkBuffer, uxHeaderLength );
+
+                    #if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+                        if( ucProtocol == ipIPv6_EXT_HEADER_FRAGMENT_HEADER )
+                        {
+                            /* The fragment is stored, the complete datagram will be
+                             * passed to the IP-task once all fragments have arrived. */
+                            eReturn = eIPv6Reassemble( pxNetworkBuffer );
+                        }
+                        else
+                    #endif
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        eReturn = prvAllowIPPacketIPv6( ( ( const IPHeader_IPv6_t * ) &( pxIPPacket->xIPHeader ) ), pxNetworkBuffer, uxHeaderLength );
+                    }
 
                     /* The IP-header type is copied to a special reserved location a few bytes before the message
                      * starts. In the case of IPv6, this value is never actually used and the line below can safely be removed
@@ -1934,17 +3872,44 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
                     * length in multiples of 4. */
                    uxHeaderLength = ( size_t ) ( ( uxLength & 0x0FU ) << 2 );
 
+                   ipCOUNT_RX( pxNetworkBuffer->pxInterface, xProtocols[ eCounterIPv4 ], pxNetworkBuffer->xDataLength );
+
                    if( ( uxHeaderLength > ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) ) ||
                        ( uxHeaderLength < ipSIZE_OF_IPv4_HEADER ) )
                    {
+                       ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
                        eReturn = eReleaseBuffer;
                    }
                    else
                    {
                        ucProtocol = pxIPPacket->xIPHeader.ucProtocol;
-                       /* Check if the IP headers are acceptable and if it has our destination. */
-                       eReturn = prvAllowIPPacketIPv4( pxIPPacket, pxNetworkBuffer, uxHeaderLength );
 
+                       #if ( ipconfigUSE_IP_FORWARDING != 0 )
+                           /* A packet for another host is forwarded as it is, fragments
+                            * included. */
+                           eReturn = eIPv4ForwardPacket( pxNetworkBuffer, uxHeaderLength );
+
+                           if( eReturn != eProcessBuffer )
+                           {
+                               /* The packet was forwarded or dropped. */
+                           }
+                           else
+                       #endif
+                       #if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+                           if( ( pxIPHeader->usFragmentOffset & ( ipFRAGMENT_OFFSET_BIT_MASK | ipFRAGMENT_FLAGS_MORE_FRAGMENTS ) ) != 0U )
+                           {
+                               /* The fragment is stored, the complete datagram will be
+                                * passed to the IP-task once all fragments have arrived. */
+                               eReturn = eIPv4Reassemble( pxNetworkBuffer, uxHeaderLength );
+                           }
+                           else
+                       #endif
+                       {
+                           /* Check if the IP headers are acceptable and if it has our destination. */
+                           eReturn = prvAllowIPPacketIPv4( pxIPPacket, pxNetworkBuffer, uxHeaderLength );
+                       }
+
+                       if( eReturn != eFrameConsumed )
                        {
                            /* The IP-header type is copied to a special reserved location a few bytes before the
                             * messages starts.  It might be needed later on when a UDP-payload
@@ -1958,6 +3923,7 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
         #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
         default:
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropUnsupported );
             eReturn = eReleaseBuffer;
             FreeRTOS_debug_printf( ( "prvProcessIPPacket: Undefined Frame Type \n" ) );
             /* MISRA 16.4 Compliance */
@@ -1982,6 +3948,13 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
                         /* The size of the IP-header is larger than 20 bytes.
                          * The extra space is used for IP-options. */
                         eReturn = prvCheckIP4HeaderOptions( pxNetworkBuffer );
+
+                        #if ( ipconfigUSE_PACKET_METADATA != 0 )
+                        {
+                            /* The options may have been removed. */
+                            vPacketMetadataParse( pxNetworkBuffer );
+                        }
+                        #endif
                     }
                     break;
             #endif /* ( ipconfigUSE_IPv4 != 0 ) */
@@ -1989,7 +3962,11 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
             #if ( ipconfigUSE_IPv6 != 0 )
                 case ipIPv6_FRAME_TYPE:
 
-                    if( xGetExtensionOrder( ucProtocol, 0U ) > 0 )
+                    if( ipIPv6_IS_UPPER_LAYER_PROTOCOL( ucProtocol ) )
+                    {
+                        /* The common case: no extension headers. */
+                    }
+                    else if( xGetExtensionOrder( ucProtocol, 0U ) > 0 )
                     {
                         eReturn = eHandleIPv6ExtensionHeaders( pxNetworkBuffer, pdTRUE );
 
@@ -1997,6 +3974,13 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
                         {
                             /* Ignore warning for `pxIPHeader_IPv6`. */
                             ucProtocol = pxIPHeader_IPv6->ucNextHeader;
+
+                            #if ( ipconfigUSE_PACKET_METADATA != 0 )
+                            {
+                                /* The extension headers have been removed. */
+                                vPacketMetadataParse( pxNetworkBuffer );
+                            }
+                            #endif
                         }
                     }
                     break;
@@ -2061,21 +4045,31 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
                     #if ( ipconfigUSE_IPv4 != 0 )
                         case ipPROTOCOL_ICMP:
 
+                            ipCOUNT_RX( pxNetworkBuffer->pxInterface, xProtocols[ eCounterICMP ], pxNetworkBuffer->xDataLength );
+
                             /* The IP packet contained an ICMP frame.  Don't bother checking
                              * the ICMP checksum, as if it is wrong then the wrong data will
                              * also be returned, and the source of the ping will know something
                              * went wrong because it will not be able to validate what it
                              * receives. */
-                            #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 )
+                            #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) || ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
                             {
                                 eReturn = ProcessICMPPacket( pxNetworkBuffer );
                             }
-                            #endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) */
+                            #endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) || ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 ) */
                             break;
                     #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
+                    #if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigSUPPORT_IP_MULTICAST != 0 ) )
+                        case ipPROTOCOL_IGMP:
+                            /* The IP packet contained an IGMP message. */
+                            eReturn = eProcessIGMPPacket( pxNetworkBuffer );
+                            break;
+                    #endif /* ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigSUPPORT_IP_MULTICAST != 0 ) ) */
+
                     #if ( ipconfigUSE_IPv6 != 0 )
                         case ipPROTOCOL_ICMP_IPv6:
+                            ipCOUNT_RX( pxNetworkBuffer->pxInterface, xProtocols[ eCounterICMP ], pxNetworkBuffer->xDataLength );
                             eReturn = prvProcessICMPMessage_IPv6( pxNetworkBuffer );
                             break;
                     #endif /* ( ipconfigUSE_IPv6 != 0 ) */
@@ -2083,12 +4077,25 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
                     case ipPROTOCOL_UDP:
                         /* The IP packet contained a UDP frame. */
 
+                        ipCOUNT_RX( pxNetworkBuffer->pxInterface, xProtocols[ eCounterUDP ], pxNetworkBuffer->xDataLength );
                         eReturn = prvProcessUDPPacket( pxNetworkBuffer );
                         break;
 
                         #if ipconfigUSE_TCP == 1
                             case ipPROTOCOL_TCP:
 
+                                ipCOUNT_RX( pxNetworkBuffer->pxInterface, xProtocols[ eCounterTCP ], pxNetworkBuffer->xDataLength );
+
+                                #if ( ipconfigUSE_TCP_RX_COALESCE != 0 )
+                                    if( xTCPRxCoalesce( pxNetworkBuffer ) == pdPASS )
+                                    {
+                                        /* The segment is held, to be merged with the
+                                         * next segments of the same burst. */
+                                        eReturn = eFrameConsumed;
+                                    }
+                                    else
+                                #endif
+
                                 if( xProcessReceivedTCPPacket( pxNetworkBuffer ) == pdPASS )
                                 {
                                     eReturn = eFrameConsumed;
@@ -2097,6 +4104,7 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
                         #endif /* if ipconfigUSE_TCP == 1 */
                     default:
                         /* Not a supported frame type. */
+                        ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropUnsupported );
                         eReturn = eReleaseBuffer;
                         break;
                 }
@@ -2143,7 +4151,16 @@ void vReturnEthernetFrame( NetworkBufferDescriptor_t * pxNetworkBuffer,
     }
     #endif /* if( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 ) */
 
-    #if ( ipconfigZERO_COPY_TX_DRIVER != 0 )
+    #if ( ( ipconfigZERO_COPY_TX_DRIVER != 0 ) && ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 ) )
+        if( xReleaseAfterSend == pdFALSE )
+        {
+            /* The caller only releases the buffer after this call, so the
+             * driver can own it as well, no copy is needed. */
+            pxNewBuffer = pxNetworkBufferAddReference( pxNetworkBuffer );
+            xReleaseAfterSend = pdTRUE;
+            pxNetworkBuffer = pxNewBuffer;
+        }
+    #elif ( ipconfigZERO_COPY_TX_DRIVER != 0 )
         if( xReleaseAfterSend == pdFALSE )
         {
             pxNewBuffer = pxDuplicateNetworkBufferWithDescriptor( pxNetworkBuffer, pxNetworkBuffer->xDataLength );
@@ -2256,7 +4273,7 @@ void vReturnEthernetFrame( NetworkBufferDescriptor_t * pxNetworkBuffer,
             if( xIsCallingFromIPTask() == pdTRUE )
             {
                 iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
-                ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, xReleaseAfterSend );
+                ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, xReleaseAfterSend );
             }
             else if( xReleaseAfterSend != pdFALSE )
             {
@@ -2352,6 +4369,7 @@ void vReturnEthernetFrame( NetworkBufferDescriptor_t * pxNetworkBuffer,
         if( pxEndPoint != NULL )
         {
             pxEndPoint->ipv4_settings.ulIPAddress = ulIPAddress;
+            FreeRTOS_RouteCacheInvalidate();
         }
     }
 /*-----------------------------------------------------------*/
@@ -2427,6 +4445,12 @@ void vReturnEthernetFrame( NetworkBufferDescriptor_t * pxNetworkBuffer,
         {
             /* Copy the MAC address at the start of the default packet header fragment. */
             ( void ) memcpy( pxEndPoint->xMACAddress.ucBytes, ( const void * ) ucMACAddress, ( size_t ) ipMAC_ADDRESS_LENGTH_BYTES );
+
+            #if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+            {
+                vMACFilterUpdateEndPoints( pxEndPoint->pxNetworkInterface );
+            }
+            #endif
         }
     }
 /*-----------------------------------------------------------*/
@@ -2463,6 +4487,7 @@ void vReturnEthernetFrame( NetworkBufferDescriptor_t * pxNetworkBuffer,
         if( pxEndPoint != NULL )
         {
             pxEndPoint->ipv4_settings.ulNetMask = ulNetmask;
+            FreeRTOS_RouteCacheInvalidate();
         }
     }
 /*-----------------------------------------------------------*/
@@ -2479,6 +4504,7 @@ void vReturnEthernetFrame( NetworkBufferDescriptor_t * pxNetworkBuffer,
         if( pxEndPoint != NULL )
         {
             pxEndPoint->ipv4_settings.ulGatewayAddress = ulGatewayAddress;
+            FreeRTOS_RouteCacheInvalidate();
         }
     }
 /*-----------------------------------------------------------*/
@@ -2590,53 +4616,156 @@ BaseType_t FreeRTOS_AllEndPointsUp( const struct xNetworkInterface * pxInterface
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_IP_TASK_STATS != 0 )
+
 /**
- * @brief Get the size of the IP-header, by checking the type of the network buffer.
- * @param[in] pxNetworkBuffer The network buffer.
- * @return The size of the corresponding IP-header.
+ * @brief Record how long an event waited in 'xNetworkEventQueue', and the
+ *        number of events that were waiting when it was taken.
+ *
+ * @param[in] pxEvent The event that was just taken from the queue.
+ * @param[in] ulNow The current value of ipconfigIP_TASK_STATS_TIME().
  */
-size_t uxIPHeaderSizePacket( const NetworkBufferDescriptor_t * pxNetworkBuffer )
-{
-    size_t uxResult;
-    /* Map the buffer onto Ethernet Header struct for easy access to fields. */
-    /* MISRA Ref 11.3.1 [Misaligned access] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-    /* coverity[misra_c_2012_rule_11_3_violation] */
-    const EthernetHeader_t * pxHeader = ( ( const EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
-
-    if( pxHeader->usFrameType == ( uint16_t ) ipIPv6_FRAME_TYPE )
+    static void prvIPTaskStatsReceived( const IPStackEvent_t * pxEvent,
+                                        uint32_t ulNow )
     {
-        uxResult = ipSIZE_OF_IPv6_HEADER;
+        if( pxEvent->eEventType != eNoEvent )
+        {
+            uint32_t ulLatency = ulNow - pxEvent->ulEnqueueTime;
+            UBaseType_t uxWaiting = uxQueueMessagesWaiting( xNetworkEventQueue ) + 1U;
+            size_t uxBucket = 0U;
+
+            /* Bucket N counts the latencies from 2^(N-1) up to 2^N. */
+            while( ( ( ulLatency >> uxBucket ) != 0U ) &&
+                   ( uxBucket < ( ( size_t ) ipconfigIP_TASK_STATS_LATENCY_BUCKETS - 1U ) ) )
+            {
+                uxBucket++;
+            }
+
+            xIPTaskStats.ulLatency[ uxBucket ]++;
+
+            if( xIPTaskStats.ulMaxLatency < ulLatency )
+            {
+                xIPTaskStats.ulMaxLatency = ulLatency;
+            }
+
+            if( xIPTaskStats.uxQueueHighWater < uxWaiting )
+            {
+                xIPTaskStats.uxQueueHighWater = uxWaiting;
+            }
+        }
     }
-    else
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add the time that has elapsed since 'ulStartTime' to a group of
+ *        statistics, and to the total busy time of the IP-task.
+ *
+ * @param[in] pxStats The statistics of an event type, or of the timers.
+ * @param[in] ulStartTime The value of ipconfigIP_TASK_STATS_TIME() when the work started.
+ */
+    static void prvIPTaskStatsAddTime( IPTaskEventStats_t * pxStats,
+                                       uint32_t ulStartTime )
     {
-        uxResult = ipSIZE_OF_IPv4_HEADER;
-    }
+        uint32_t ulTime = ipconfigIP_TASK_STATS_TIME() - ulStartTime;
 
-    return uxResult;
-}
+        pxStats->ulCount++;
+        pxStats->ullTotalTime += ulTime;
+
+        if( pxStats->ulMaxTime < ulTime )
+        {
+            pxStats->ulMaxTime = ulTime;
+        }
+
+        xIPTaskStats.ullBusyTime += ulTime;
+    }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Get the size of the IP-header, by checking if the socket bIsIPv6 set.
- * @param[in] pxSocket The socket.
- * @return The size of the corresponding IP-header.
+ * @brief Get a copy of the load and latency statistics of the IP-task.
+ *        The load is 'ullBusyTime' divided by the time that has passed
+ *        since 'ulStartTime'.
+ *
+ * @param[out] pxStats Where the statistics will be copied to.
  */
-size_t uxIPHeaderSizeSocket( const FreeRTOS_Socket_t * pxSocket )
-{
-    size_t uxResult;
+    void FreeRTOS_GetIPTaskStats( IPTaskStats_t * pxStats )
+    {
+        configASSERT( pxStats != NULL );
+
+        /* The IP-task cannot run while the copy is being made. */
+        taskENTER_CRITICAL();
+        {
+            ( void ) memcpy( pxStats, &( xIPTaskStats ), sizeof( *pxStats ) );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
 
-    if( ( pxSocket != NULL ) && ( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED ) )
+/**
+ * @brief Clear the load and latency statistics of the IP-task, and start a
+ *        new measurement period.
+ */
+    void FreeRTOS_ClearIPTaskStats( void )
     {
-        uxResult = ipSIZE_OF_IPv6_HEADER;
+        taskENTER_CRITICAL();
+        {
+            ( void ) memset( &( xIPTaskStats ), 0, sizeof( xIPTaskStats ) );
+            xIPTaskStats.ulStartTime = ipconfigIP_TASK_STATS_TIME();
+        }
+        taskEXIT_CRITICAL();
     }
-    else
+#endif /* ( ipconfigUSE_IP_TASK_STATS != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 != 0 )
+
+    /**
+     * @brief Get the size of the IP-header, by checking the type of the network buffer.
+     * @param[in] pxNetworkBuffer The network buffer.
+     * @return The size of the corresponding IP-header.
+     */
+    size_t uxIPHeaderSizePacket( const NetworkBufferDescriptor_t * pxNetworkBuffer )
     {
-        uxResult = ipSIZE_OF_IPv4_HEADER;
+        size_t uxResult;
+        /* Map the buffer onto Ethernet Header struct for easy access to fields. */
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const EthernetHeader_t * pxHeader = ( ( const EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+
+        if( pxHeader->usFrameType == ( uint16_t ) ipIPv6_FRAME_TYPE )
+        {
+            uxResult = ipSIZE_OF_IPv6_HEADER;
+        }
+        else
+        {
+            uxResult = ipSIZE_OF_IPv4_HEADER;
+        }
+
+        return uxResult;
     }
+    /*-----------------------------------------------------------*/
+
+    /**
+     * @brief Get the size of the IP-header, by checking if the socket bIsIPv6 set.
+     * @param[in] pxSocket The socket.
+     * @return The size of the corresponding IP-header.
+     */
+    size_t uxIPHeaderSizeSocket( const FreeRTOS_Socket_t * pxSocket )
+    {
+        size_t uxResult;
 
-    return uxResult;
-}
+        if( ( pxSocket != NULL ) && ( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED ) )
+        {
+            uxResult = ipSIZE_OF_IPv6_HEADER;
+        }
+        else
+        {
+            uxResult = ipSIZE_OF_IPv4_HEADER;
+        }
+
+        return uxResult;
+    }
+#endif /* ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 != 0 ) */
 /*-----------------------------------------------------------*/
 
 /* Provide access to private members for verification. */
@@ -0,0 +1,865 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_IP_Fragment.c
+ * @brief Implements the reassembly of received IPv4 and IPv6 fragments, and
+ *        the fragmentation of outgoing datagrams that are larger than the MTU
+ *        of the interface.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_IP_Fragment.h"
+#include "NetworkInterface.h"
+#include "NetworkBufferManagement.h"
+
+/* *INDENT-OFF* */
+#if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+/* *INDENT-ON* */
+
+/** @brief The number of bytes needed to keep one bit for every 8-byte block of a datagram. */
+#define ipREASSEMBLY_MAP_BYTES    ( ( ( ipconfigIP_FRAGMENTATION_MAX_SIZE / ipFRAGMENT_BLOCK_SIZE ) / 8U ) + 1U )
+
+/** @brief The properties of a received fragment. */
+typedef struct xIP_FRAGMENT
+{
+    IP_Address_t xSourceAddress;      /**< The sender of the datagram. */
+    IP_Address_t xDestinationAddress; /**< The destination of the datagram. */
+    uint32_t ulIdentification;        /**< The identification field, in network order. */
+    uint8_t ucProtocol;               /**< The protocol, or for IPv6 the header that follows the fragment header. */
+    uint8_t ucIsIPv6;                 /**< pdTRUE_UNSIGNED for an IPv6 fragment. */
+    size_t uxHeaderLength;            /**< The size of the Ethernet and IP headers of the reassembled datagram. */
+    const uint8_t * pucPayload;       /**< The data carried by this fragment. */
+    size_t uxOffset;                  /**< The position of the data within the payload of the datagram. */
+    size_t uxLength;                  /**< The number of bytes in 'pucPayload'. */
+    BaseType_t xMoreFragments;        /**< pdFALSE for the last fragment of the datagram. */
+} IPFragment_t;
+
+/** @brief A datagram of which not all fragments have been received. */
+typedef struct xIP_REASSEMBLY
+{
+    NetworkBufferDescriptor_t * pxBuffer;       /**< Receives the headers and the payload, NULL when the entry is free. */
+    TickType_t xStartTime;                      /**< The time at which the first fragment arrived. */
+    IP_Address_t xSourceAddress;                /**< The sender of the datagram. */
+    IP_Address_t xDestinationAddress;           /**< The destination of the datagram. */
+    uint32_t ulIdentification;                  /**< The identification field, in network order. */
+    size_t uxHeaderLength;                      /**< The size of the Ethernet and IP headers in front of the payload. */
+    size_t uxPayloadLength;                     /**< The size of the payload, zero while the last fragment is missing. */
+    size_t uxHighestEnd;                        /**< The end of the fragment with the highest offset received. */
+    size_t uxReceived;                          /**< The number of payload bytes received. */
+    uint8_t ucProtocol;                         /**< The protocol, or for IPv6 the header that follows the fragment header. */
+    uint8_t ucIsIPv6;                           /**< pdTRUE_UNSIGNED for an IPv6 datagram. */
+    uint8_t ucBlocks[ ipREASSEMBLY_MAP_BYTES ]; /**< One bit for every 8-byte block of the payload that was received. */
+} IPReassembly_t;
+
+/** @brief The datagrams under reassembly. Only the IP-task accesses this table. */
+static IPReassembly_t xReassembly[ ipconfigIP_REASSEMBLY_MAX_DATAGRAMS ];
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the largest datagram, IP header included, that can be reassembled.
+ *
+ * @return The size in bytes.
+ */
+static size_t prvReassemblyMaxSize( void )
+{
+    size_t uxSize = ipMAX_IP_PACKET_SIZE;
+
+    if( xBufferAllocFixedSize != pdFALSE )
+    {
+        /* Fixed size network buffers can not hold more than the MTU. */
+        uxSize = ipconfigNETWORK_MTU;
+    }
+
+    return uxSize;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Drop a datagram under reassembly.
+ *
+ * @param[in] pxEntry The entry to be freed.
+ */
+static void prvReassemblyFree( IPReassembly_t * pxEntry )
+{
+    if( pxEntry->pxBuffer != NULL )
+    {
+        vReleaseNetworkBufferAndDescriptor( pxEntry->pxBuffer );
+        pxEntry->pxBuffer = NULL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the datagram to which a fragment belongs.
+ *
+ * @param[in] pxFragment The received fragment.
+ *
+ * @return The entry of the datagram, or NULL when it is not under reassembly.
+ */
+static IPReassembly_t * prvReassemblyFind( const IPFragment_t * pxFragment )
+{
+    IPReassembly_t * pxReturn = NULL;
+    BaseType_t xIndex;
+
+    for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigIP_REASSEMBLY_MAX_DATAGRAMS; xIndex++ )
+    {
+        IPReassembly_t * pxEntry = &( xReassembly[ xIndex ] );
+
+        if( ( pxEntry->pxBuffer == NULL ) ||
+            ( pxEntry->ucIsIPv6 != pxFragment->ucIsIPv6 ) ||
+            ( pxEntry->ulIdentification != pxFragment->ulIdentification ) )
+        {
+            continue;
+        }
+
+        if( pxFragment->ucIsIPv6 != pdFALSE_UNSIGNED )
+        {
+            if( ( memcmp( pxEntry->xSourceAddress.xIP_IPv6.ucBytes, pxFragment->xSourceAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) &&
+                ( memcmp( pxEntry->xDestinationAddress.xIP_IPv6.ucBytes, pxFragment->xDestinationAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) )
+            {
+                pxReturn = pxEntry;
+            }
+        }
+        else if( ( pxEntry->xSourceAddress.ulIP_IPv4 == pxFragment->xSourceAddress.ulIP_IPv4 ) &&
+                 ( pxEntry->xDestinationAddress.ulIP_IPv4 == pxFragment->xDestinationAddress.ulIP_IPv4 ) &&
+                 ( pxEntry->ucProtocol == pxFragment->ucProtocol ) )
+        {
+            pxReturn = pxEntry;
+        }
+        else
+        {
+            /* Another datagram. */
+        }
+
+        if( pxReturn != NULL )
+        {
+            break;
+        }
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start the reassembly of a new datagram.
+ *
+ * @param[in] pxFragment The first fragment that was received.
+ * @param[in] uxMaxPayload The largest payload that the datagram may have.
+ *
+ * @return The new entry, or NULL when all entries are in use or when no
+ *         network buffer is available.
+ */
+static IPReassembly_t * prvReassemblyNew( const IPFragment_t * pxFragment,
+                                          size_t uxMaxPayload )
+{
+    IPReassembly_t * pxReturn = NULL;
+    BaseType_t xIndex;
+
+    for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigIP_REASSEMBLY_MAX_DATAGRAMS; xIndex++ )
+    {
+        if( xReassembly[ xIndex ].pxBuffer == NULL )
+        {
+            pxReturn = &( xReassembly[ xIndex ] );
+            break;
+        }
+    }
+
+    if( pxReturn != NULL )
+    {
+        pxReturn->pxBuffer = pxGetNetworkBufferWithDescriptor( pxFragment->uxHeaderLength + uxMaxPayload, 0U );
+
+        if( pxReturn->pxBuffer == NULL )
+        {
+            pxReturn = NULL;
+        }
+        else
+        {
+            pxReturn->xStartTime = xTaskGetTickCount();
+            ( void ) memcpy( &( pxReturn->xSourceAddress ), &( pxFragment->xSourceAddress ), sizeof( pxReturn->xSourceAddress ) );
+            ( void ) memcpy( &( pxReturn->xDestinationAddress ), &( pxFragment->xDestinationAddress ), sizeof( pxReturn->xDestinationAddress ) );
+            pxReturn->ulIdentification = pxFragment->ulIdentification;
+            pxReturn->uxHeaderLength = pxFragment->uxHeaderLength;
+            pxReturn->uxPayloadLength = 0U;
+            pxReturn->uxHighestEnd = 0U;
+            pxReturn->uxReceived = 0U;
+            pxReturn->ucProtocol = pxFragment->ucProtocol;
+            pxReturn->ucIsIPv6 = pxFragment->ucIsIPv6;
+            ( void ) memset( pxReturn->ucBlocks, 0, sizeof( pxReturn->ucBlocks ) );
+        }
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Mark the 8-byte blocks of a fragment as received.
+ *
+ * @param[in] pxEntry The datagram under reassembly.
+ * @param[in] pxFragment The received fragment.
+ *
+ * @return 1 when the blocks are new, 0 for a duplicate fragment, and -1 when
+ *         the fragment overlaps with data that was received before.
+ */
+static BaseType_t prvReassemblyMark( IPReassembly_t * pxEntry,
+                                     const IPFragment_t * pxFragment )
+{
+    size_t uxFirst = pxFragment->uxOffset / ipFRAGMENT_BLOCK_SIZE;
+    size_t uxLast = ( ( pxFragment->uxOffset + pxFragment->uxLength ) + ( ipFRAGMENT_BLOCK_SIZE - 1U ) ) / ipFRAGMENT_BLOCK_SIZE;
+    size_t uxBlock;
+    size_t uxSeen = 0U;
+    BaseType_t xReturn;
+
+    for( uxBlock = uxFirst; uxBlock < uxLast; uxBlock++ )
+    {
+        if( ( pxEntry->ucBlocks[ uxBlock / 8U ] & ( uint8_t ) ( 1U << ( uxBlock % 8U ) ) ) != 0U )
+        {
+            uxSeen++;
+        }
+    }
+
+    if( uxSeen == 0U )
+    {
+        for( uxBlock = uxFirst; uxBlock < uxLast; uxBlock++ )
+        {
+            pxEntry->ucBlocks[ uxBlock / 8U ] |= ( uint8_t ) ( 1U << ( uxBlock % 8U ) );
+        }
+
+        xReturn = 1;
+    }
+    else if( uxSeen == ( uxLast - uxFirst ) )
+    {
+        xReturn = 0;
+    }
+    else
+    {
+        xReturn = -1;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Pass a complete datagram to the IP-task.
+ *
+ * @param[in] pxEntry The datagram of which all fragments have been received.
+ * @param[in] pxNetworkBuffer The last fragment that was received.
+ */
+static void prvReassemblyDone( IPReassembly_t * pxEntry,
+                               const NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    NetworkBufferDescriptor_t * pxBuffer = pxEntry->pxBuffer;
+    IPStackEvent_t xEventMessage;
+    const TickType_t xDontBlock = ( TickType_t ) 0;
+
+    /* The entry is free again, the buffer will be processed as a new packet. */
+    pxEntry->pxBuffer = NULL;
+
+    pxBuffer->xDataLength = pxEntry->uxHeaderLength + pxEntry->uxPayloadLength;
+    pxBuffer->pxInterface = pxNetworkBuffer->pxInterface;
+    pxBuffer->pxEndPoint = pxNetworkBuffer->pxEndPoint;
+
+    pxBuffer->pxNextBuffer = NULL;
+
+    if( pxEntry->ucIsIPv6 != pdFALSE_UNSIGNED )
+    {
+        #if ( ipconfigUSE_IPv6 != 0 )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( IPHeader_IPv6_t * ) &( pxBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+            /* The fragment header is not part of the reassembled datagram. */
+            pxIPHeader_IPv6->ucNextHeader = pxEntry->ucProtocol;
+            pxIPHeader_IPv6->usPayloadLength = FreeRTOS_htons( ( uint16_t ) pxEntry->uxPayloadLength );
+        }
+        #endif
+    }
+    else
+    {
+        #if ( ipconfigUSE_IPv4 != 0 )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            IPHeader_t * pxIPHeader = ( ( IPHeader_t * ) &( pxBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+            /* IP-options of the first fragment are not kept. */
+            pxIPHeader->ucVersionHeaderLength = ipIPV4_VERSION_HEADER_LENGTH_MIN;
+            pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( ipSIZE_OF_IPv4_HEADER + pxEntry->uxPayloadLength ) );
+            pxIPHeader->usFragmentOffset = 0U;
+            pxIPHeader->usHeaderChecksum = 0U;
+            pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER );
+            pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+        }
+        #endif
+    }
+
+    xEventMessage.eEventType = eNetworkRxEvent;
+    xEventMessage.pvData = ( void * ) pxBuffer;
+
+    if( xSendEventStructToIPTask( &xEventMessage, xDontBlock ) != pdPASS )
+    {
+        /* Failed to send the message, so release the network buffer. */
+        vReleaseNetworkBufferAndDescriptor( pxBuffer );
+        iptraceETHERNET_RX_EVENT_LOST();
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store the data of a fragment in its datagram.
+ *
+ * @param[in] pxNetworkBuffer The packet that contains the fragment.
+ * @param[in] pxFragment The properties of the fragment.
+ */
+static void prvReassembleFragment( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                   const IPFragment_t * pxFragment )
+{
+    IPReassembly_t * pxEntry;
+    size_t uxMaxPayload = prvReassemblyMaxSize() - ( pxFragment->uxHeaderLength - ipSIZE_OF_ETH_HEADER );
+    size_t uxEnd = pxFragment->uxOffset + pxFragment->uxLength;
+    BaseType_t xMark;
+
+    /* Make room for new datagrams. */
+    vIPReassemblyCheckTimeout();
+
+    pxEntry = prvReassemblyFind( pxFragment );
+
+    do
+    {
+        if( ( pxFragment->xMoreFragments != pdFALSE ) &&
+            ( ( pxFragment->uxLength == 0U ) || ( ( pxFragment->uxLength % ipFRAGMENT_BLOCK_SIZE ) != 0U ) ) )
+        {
+            /* All but the last fragment carry a multiple of 8 bytes. */
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
+            break;
+        }
+
+        if( uxEnd > uxMaxPayload )
+        {
+            /* The datagram is larger than the reassembly allows. */
+            if( pxEntry != NULL )
+            {
+                prvReassemblyFree( pxEntry );
+            }
+
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropFiltered );
+            break;
+        }
+
+        if( pxEntry == NULL )
+        {
+            pxEntry = prvReassemblyNew( pxFragment, uxMaxPayload );
+
+            if( pxEntry == NULL )
+            {
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropNoBuffer );
+                break;
+            }
+        }
+
+        xMark = prvReassemblyMark( pxEntry, pxFragment );
+
+        if( xMark == 0 )
+        {
+            /* A duplicate of a fragment that was received before. */
+            break;
+        }
+
+        if( ( xMark < 0 ) ||
+            ( ( pxEntry->uxPayloadLength != 0U ) && ( uxEnd > pxEntry->uxPayloadLength ) ) ||
+            ( ( pxFragment->xMoreFragments == pdFALSE ) && ( ( pxEntry->uxPayloadLength != 0U ) || ( pxEntry->uxHighestEnd > uxEnd ) ) ) )
+        {
+            /* Overlapping or inconsistent fragments: drop the whole datagram,
+             * as recommended by RFC 5722. */
+            prvReassemblyFree( pxEntry );
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
+            break;
+        }
+
+        ( void ) memcpy( &( pxEntry->pxBuffer->pucEthernetBuffer[ pxEntry->uxHeaderLength + pxFragment->uxOffset ] ),
+                         pxFragment->pucPayload,
+                         pxFragment->uxLength );
+        pxEntry->uxReceived += pxFragment->uxLength;
+        pxEntry->uxHighestEnd = FreeRTOS_max_size_t( pxEntry->uxHighestEnd, uxEnd );
+
+        if( pxFragment->uxOffset == 0U )
+        {
+            /* The headers of the datagram are taken from its first fragment. */
+            ( void ) memcpy( pxEntry->pxBuffer->pucEthernetBuffer, pxNetworkBuffer->pucEthernetBuffer, pxEntry->uxHeaderLength );
+            pxEntry->ucProtocol = pxFragment->ucProtocol;
+        }
+
+        if( pxFragment->xMoreFragments == pdFALSE )
+        {
+            pxEntry->uxPayloadLength = uxEnd;
+        }
+
+        if( ( pxEntry->uxPayloadLength != 0U ) && ( pxEntry->uxReceived == pxEntry->uxPayloadLength ) )
+        {
+            prvReassemblyDone( pxEntry, pxNetworkBuffer );
+        }
+    } while( ipFALSE_BOOL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_IPv4 != 0 )
+
+/**
+ * @brief Store a received IPv4 fragment. The fragment is copied, so the
+ *        network buffer can be released by the caller.
+ *
+ * @param[in] pxNetworkBuffer The packet with a non-zero fragment offset or
+ *                            with the "more fragments" flag set.
+ * @param[in] uxIPHeaderLength The length of the IP-header, options included.
+ *
+ * @return Always eReleaseBuffer.
+ */
+    eFrameProcessingResult_t eIPv4Reassemble( const NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                              size_t uxIPHeaderLength )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+        size_t uxLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usLength );
+        uint32_t ulDestination = pxIPHeader->ulDestinationIPAddress;
+        IPFragment_t xFragment;
+
+        if( ( uxLength <= uxIPHeaderLength ) ||
+            ( uxLength > ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) ) ||
+            ( usGenerateChecksum( 0U, ( const uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderLength ) != ipCORRECT_CRC ) )
+        {
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
+        }
+        else if( ( FreeRTOS_FindEndPointOnIP_IPv4( ulDestination ) == NULL ) &&
+                 ( xIsIPv4Multicast( ulDestination ) == pdFALSE ) &&
+                 ( ( FreeRTOS_ntohl( ulDestination ) & 0xffU ) != 0xffU ) )
+        {
+            /* The datagram is not for this host. */
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropFiltered );
+        }
+        else
+        {
+            ( void ) memset( &( xFragment ), 0, sizeof( xFragment ) );
+            xFragment.xSourceAddress.ulIP_IPv4 = pxIPHeader->ulSourceIPAddress;
+            xFragment.xDestinationAddress.ulIP_IPv4 = ulDestination;
+            xFragment.ulIdentification = ( uint32_t ) pxIPHeader->usIdentification;
+            xFragment.ucProtocol = pxIPHeader->ucProtocol;
+            xFragment.ucIsIPv6 = pdFALSE_UNSIGNED;
+            xFragment.uxHeaderLength = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER;
+            xFragment.pucPayload = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderLength ] );
+            xFragment.uxOffset = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usFragmentOffset & ipFRAGMENT_OFFSET_BIT_MASK ) * ipFRAGMENT_BLOCK_SIZE;
+            xFragment.uxLength = uxLength - uxIPHeaderLength;
+            xFragment.xMoreFragments = ( ( pxIPHeader->usFragmentOffset & ipFRAGMENT_FLAGS_MORE_FRAGMENTS ) != 0U ) ? pdTRUE : pdFALSE;
+
+            prvReassembleFragment( pxNetworkBuffer, &( xFragment ) );
+        }
+
+        return eReleaseBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+#if ( ipconfigUSE_IPv6 != 0 )
+
+/**
+ * @brief Store a received IPv6 fragment, of which the fragment header follows
+ *        the IPv6 header directly. The fragment is copied, so the network
+ *        buffer can be released by the caller.
+ *
+ * @param[in] pxNetworkBuffer The packet with the fragment header.
+ *
+ * @return Always eReleaseBuffer.
+ */
+    eFrameProcessingResult_t eIPv6Reassemble( const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPv6FragmentHeader_t * pxFragmentHeader = ( ( const IPv6FragmentHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ] ) );
+        size_t uxPayloadLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader_IPv6->usPayloadLength );
+        uint16_t usOffset;
+        IPFragment_t xFragment;
+
+        if( ( uxPayloadLength <= sizeof( IPv6FragmentHeader_t ) ) ||
+            ( uxPayloadLength > ( pxNetworkBuffer->xDataLength - ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ) ) ) )
+        {
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
+        }
+        else if( ( FreeRTOS_FindEndPointOnIP_IPv6( &( pxIPHeader_IPv6->xDestinationAddress ) ) == NULL ) &&
+                 ( xIsIPv6AllowedMulticast( &( pxIPHeader_IPv6->xDestinationAddress ) ) == pdFALSE ) )
+        {
+            /* The datagram is not for this host. */
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropFiltered );
+        }
+        else
+        {
+            usOffset = FreeRTOS_ntohs( pxFragmentHeader->usFragmentOffset );
+
+            ( void ) memset( &( xFragment ), 0, sizeof( xFragment ) );
+            ( void ) memcpy( xFragment.xSourceAddress.xIP_IPv6.ucBytes, pxIPHeader_IPv6->xSourceAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+            ( void ) memcpy( xFragment.xDestinationAddress.xIP_IPv6.ucBytes, pxIPHeader_IPv6->xDestinationAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+            xFragment.ulIdentification = pxFragmentHeader->ulIdentification;
+            xFragment.ucProtocol = pxFragmentHeader->ucNextHeader;
+            xFragment.ucIsIPv6 = pdTRUE_UNSIGNED;
+            xFragment.uxHeaderLength = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER;
+            xFragment.pucPayload = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + sizeof( IPv6FragmentHeader_t ) ] );
+            xFragment.uxOffset = ( size_t ) ( usOffset & ipIPv6_FRAGMENT_OFFSET_MASK );
+            xFragment.uxLength = uxPayloadLength - sizeof( IPv6FragmentHeader_t );
+            xFragment.xMoreFragments = ( ( usOffset & ipIPv6_FRAGMENT_MORE ) != 0U ) ? pdTRUE : pdFALSE;
+
+            prvReassembleFragment( pxNetworkBuffer, &( xFragment ) );
+        }
+
+        return eReleaseBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+/**
+ * @brief Drop the datagrams of which the missing fragments did not arrive
+ *        within ipconfigIP_REASSEMBLY_TIMEOUT_MS.
+ */
+void vIPReassemblyCheckTimeout( void )
+{
+    const TickType_t xTimeout = pdMS_TO_TICKS( ipconfigIP_REASSEMBLY_TIMEOUT_MS );
+    TickType_t xNow = xTaskGetTickCount();
+    BaseType_t xIndex;
+
+    for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigIP_REASSEMBLY_MAX_DATAGRAMS; xIndex++ )
+    {
+        if( ( xReassembly[ xIndex ].pxBuffer != NULL ) &&
+            ( ( xNow - xReassembly[ xIndex ].xStartTime ) >= xTimeout ) )
+        {
+            FreeRTOS_debug_printf( ( "vIPReassemblyCheckTimeout: dropped datagram with %u bytes received\n",
+                                     ( unsigned ) xReassembly[ xIndex ].uxReceived ) );
+            prvReassemblyFree( &( xReassembly[ xIndex ] ) );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create one fragment of a datagram.
+ *
+ * @param[in] pxDatagram The complete datagram.
+ * @param[in] uxHeaderLength The number of header bytes that are copied from the datagram.
+ * @param[in] uxGap The number of bytes left free after the headers, for an IPv6 fragment header.
+ * @param[in] uxOffset The offset of the fragment within the payload of the datagram.
+ * @param[in] uxLength The number of payload bytes in the fragment.
+ *
+ * @return The new packet, or NULL when no network buffer is available.
+ */
+static NetworkBufferDescriptor_t * prvFragmentCreate( const NetworkBufferDescriptor_t * pxDatagram,
+                                                      size_t uxHeaderLength,
+                                                      size_t uxGap,
+                                                      size_t uxOffset,
+                                                      size_t uxLength )
+{
+    NetworkBufferDescriptor_t * pxFragment = pxGetNetworkBufferWithDescriptor( uxHeaderLength + uxGap + uxLength, 0U );
+
+    if( pxFragment != NULL )
+    {
+        ( void ) memcpy( pxFragment->pucEthernetBuffer, pxDatagram->pucEthernetBuffer, uxHeaderLength );
+        ( void ) memcpy( &( pxFragment->pucEthernetBuffer[ uxHeaderLength + uxGap ] ),
+                         &( pxDatagram->pucEthernetBuffer[ uxHeaderLength + uxOffset ] ),
+                         uxLength );
+        pxFragment->xDataLength = uxHeaderLength + uxGap + uxLength;
+        pxFragment->pxEndPoint = pxDatagram->pxEndPoint;
+        pxFragment->pxInterface = pxDatagram->pxInterface;
+    }
+
+    return pxFragment;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Pass a fragment to the driver.
+ *
+ * @param[in] pxInterface The interface through which the fragment is sent.
+ * @param[in] pxFragment The fragment, which will be released by the driver.
+ */
+static void prvFragmentSend( NetworkInterface_t * pxInterface,
+                             NetworkBufferDescriptor_t * pxFragment )
+{
+    #if ( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 )
+    {
+        if( pxFragment->xDataLength < ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES )
+        {
+            ( void ) memset( &( pxFragment->pucEthernetBuffer[ pxFragment->xDataLength ] ), 0, ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES - pxFragment->xDataLength );
+            pxFragment->xDataLength = ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES;
+        }
+    }
+    #endif
+
+    iptraceNETWORK_INTERFACE_OUTPUT( pxFragment->xDataLength, pxFragment->pucEthernetBuffer );
+    ( void ) xIPInterfaceOutput( pxInterface, pxFragment, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_IPv4 != 0 )
+
+/**
+ * @brief Send an IPv4 datagram in fragments.
+ *
+ * @param[in] pxInterface The interface through which the datagram is sent.
+ * @param[in] pxDatagram The complete datagram.
+ * @param[in] uxMTU The MTU of the interface.
+ */
+    static void prvFragmentOutputIPv4( NetworkInterface_t * pxInterface,
+                                       const NetworkBufferDescriptor_t * pxDatagram,
+                                       size_t uxMTU )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPHeader_t * pxDatagramHeader = ( ( const IPHeader_t * ) &( pxDatagram->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+        size_t uxIPHeaderLength = ( size_t ) ( ( pxDatagramHeader->ucVersionHeaderLength & 0x0FU ) << 2 );
+        size_t uxHeaderLength = ipSIZE_OF_ETH_HEADER + uxIPHeaderLength;
+        size_t uxPayloadLength = pxDatagram->xDataLength - uxHeaderLength;
+        /* All but the last fragment carry a multiple of 8 bytes. */
+        size_t uxMaxLength = ( ( uxMTU - uxIPHeaderLength ) / ipFRAGMENT_BLOCK_SIZE ) * ipFRAGMENT_BLOCK_SIZE;
+        size_t uxOffset;
+        size_t uxLength;
+        NetworkBufferDescriptor_t * pxFragment;
+        IPHeader_t * pxIPHeader;
+
+        if( ( pxDatagramHeader->usFragmentOffset & ipFRAGMENT_FLAGS_DONT_FRAGMENT ) != 0U )
+        {
+            /* The datagram may not be fragmented. */
+            iptraceSENDTO_DATA_TOO_LONG();
+        }
+        else
+        {
+            for( uxOffset = 0U; uxOffset < uxPayloadLength; uxOffset += uxLength )
+            {
+                uxLength = FreeRTOS_min_size_t( uxMaxLength, uxPayloadLength - uxOffset );
+                pxFragment = prvFragmentCreate( pxDatagram, uxHeaderLength, 0U, uxOffset, uxLength );
+
+                if( pxFragment == NULL )
+                {
+                    /* The receiver will drop the datagram after a time-out. */
+                    break;
+                }
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxIPHeader = ( ( IPHeader_t * ) &( pxFragment->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+                pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( uxIPHeaderLength + uxLength ) );
+                pxIPHeader->usFragmentOffset = FreeRTOS_htons( ( uint16_t ) ( uxOffset / ipFRAGMENT_BLOCK_SIZE ) );
+
+                if( ( uxOffset + uxLength ) < uxPayloadLength )
+                {
+                    pxIPHeader->usFragmentOffset |= ipFRAGMENT_FLAGS_MORE_FRAGMENTS;
+                }
+
+                pxIPHeader->usHeaderChecksum = 0U;
+                pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderLength );
+                pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+
+                prvFragmentSend( pxInterface, pxFragment );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+#if ( ipconfigUSE_IPv6 != 0 )
+
+/**
+ * @brief Send an IPv6 datagram in fragments, each with a fragment header
+ *        after the IPv6 header.
+ *
+ * @param[in] pxInterface The interface through which the datagram is sent.
+ * @param[in] pxDatagram The complete datagram.
+ * @param[in] uxMTU The MTU of the interface.
+ */
+    static void prvFragmentOutputIPv6( NetworkInterface_t * pxInterface,
+                                       const NetworkBufferDescriptor_t * pxDatagram,
+                                       size_t uxMTU )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPHeader_IPv6_t * pxDatagramHeader = ( ( const IPHeader_IPv6_t * ) &( pxDatagram->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+        const size_t uxHeaderLength = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER;
+        size_t uxPayloadLength = pxDatagram->xDataLength - uxHeaderLength;
+        /* All but the last fragment carry a multiple of 8 bytes. */
+        size_t uxMaxLength = ( ( uxMTU - ( ipSIZE_OF_IPv6_HEADER + sizeof( IPv6FragmentHeader_t ) ) ) / ipFRAGMENT_BLOCK_SIZE ) * ipFRAGMENT_BLOCK_SIZE;
+        size_t uxOffset;
+        size_t uxLength;
+        uint32_t ulIdentification = 0U;
+        uint16_t usOffset;
+        NetworkBufferDescriptor_t * pxFragment;
+        IPHeader_IPv6_t * pxIPHeader_IPv6;
+        IPv6FragmentHeader_t * pxFragmentHeader;
+
+        /* An identification that is hard to predict, see RFC 7739. */
+        ( void ) xApplicationGetRandomNumber( &( ulIdentification ) );
+
+        for( uxOffset = 0U; uxOffset < uxPayloadLength; uxOffset += uxLength )
+        {
+            uxLength = FreeRTOS_min_size_t( uxMaxLength, uxPayloadLength - uxOffset );
+            pxFragment = prvFragmentCreate( pxDatagram, uxHeaderLength, sizeof( IPv6FragmentHeader_t ), uxOffset, uxLength );
+
+            if( pxFragment == NULL )
+            {
+                /* The receiver will drop the datagram after a time-out. */
+                break;
+            }
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxIPHeader_IPv6 = ( ( IPHeader_IPv6_t * ) &( pxFragment->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxFragmentHeader = ( ( IPv6FragmentHeader_t * ) &( pxFragment->pucEthernetBuffer[ uxHeaderLength ] ) );
+
+            pxIPHeader_IPv6->ucNextHeader = ipIPv6_EXT_HEADER_FRAGMENT_HEADER;
+            pxIPHeader_IPv6->usPayloadLength = FreeRTOS_htons( ( uint16_t ) ( sizeof( IPv6FragmentHeader_t ) + uxLength ) );
+
+            usOffset = ( uint16_t ) uxOffset;
+
+            if( ( uxOffset + uxLength ) < uxPayloadLength )
+            {
+                usOffset |= ipIPv6_FRAGMENT_MORE;
+            }
+
+            pxFragmentHeader->ucNextHeader = pxDatagramHeader->ucNextHeader;
+            pxFragmentHeader->ucReserved = 0U;
+            pxFragmentHeader->usFragmentOffset = FreeRTOS_htons( usOffset );
+            pxFragmentHeader->ulIdentification = ulIdentification;
+
+            prvFragmentSend( pxInterface, pxFragment );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+/**
+ * @brief Send a datagram that is larger than the MTU of the interface in
+ *        fragments. Called by the IP-task for UDP and ICMP packets of which
+ *        the headers are complete.
+ *
+ * @param[in] pxInterface The interface through which the datagram is sent.
+ * @param[in] pxNetworkBuffer The datagram, which will be released.
+ * @param[in] uxMTU The MTU of the interface.
+ */
+void vIPFragmentOutput( NetworkInterface_t * pxInterface,
+                        NetworkBufferDescriptor_t * pxNetworkBuffer,
+                        size_t uxMTU )
+{
+    NetworkBufferDescriptor_t * pxDatagram = pxNetworkBuffer;
+
+    #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+    {
+        if( pxNetworkBuffer->pxSegments != NULL )
+        {
+            /* The payload must be contiguous to be split. */
+            pxDatagram = pxNetworkBufferLinearise( pxNetworkBuffer );
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+    }
+    #endif
+
+    if( pxDatagram != NULL )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const EthernetHeader_t * pxEthernetHeader = ( ( const EthernetHeader_t * ) pxDatagram->pucEthernetBuffer );
+
+        #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+            if( ipTX_CHECKSUM_IN_SOFTWARE( pxDatagram ) == pdFALSE )
+        #endif
+        {
+            /* The hardware can not insert the checksum of a datagram that is
+             * sent in fragments. */
+            ( void ) usGenerateProtocolChecksum( pxDatagram->pucEthernetBuffer, pxDatagram->xDataLength, pdTRUE );
+        }
+
+        switch( pxEthernetHeader->usFrameType )
+        {
+            #if ( ipconfigUSE_IPv4 != 0 )
+                case ipIPv4_FRAME_TYPE:
+                    prvFragmentOutputIPv4( pxInterface, pxDatagram, uxMTU );
+                    break;
+            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                case ipIPv6_FRAME_TYPE:
+                    prvFragmentOutputIPv6( pxInterface, pxDatagram, uxMTU );
+                    break;
+            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+            default:
+                /* MISRA 16.4 Compliance */
+                break;
+        }
+
+        vReleaseNetworkBufferAndDescriptor( pxDatagram );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* *INDENT-OFF* */
+#endif /* ( ipconfigUSE_IP_FRAGMENTATION != 0 ) */
+/* *INDENT-ON* */
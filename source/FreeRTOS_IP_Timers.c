@@ -55,6 +55,7 @@
 #include "NetworkBufferManagement.h"
 #include "FreeRTOS_Routing.h"
 #include "FreeRTOS_DNS.h"
+#include "FreeRTOS_IP_Fragment.h"
 /*-----------------------------------------------------------*/
 
 /** @brief 'xAllNetworksUp' becomes pdTRUE when all network interfaces are initialised
@@ -119,8 +120,182 @@ static IPTimer_t xARPTimer;
 static IPTimer_t xNetworkTimer;
 struct xNetworkEndpoint;
 
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_TIMER_WHEEL != 0 ) )
+
+    #ifndef ipTCP_TIMER_PERIOD_MS
+        #define ipTCP_TIMER_PERIOD_MS    ( 1000U )
+    #endif
+
+/** @brief Each level of the TCP timer wheel has 16 slots. */
+    #define ipTCP_WHEEL_BITS      ( 4U )
+    #define ipTCP_WHEEL_SLOTS     ( 1U << ipTCP_WHEEL_BITS )
+    #define ipTCP_WHEEL_MASK      ( ( TickType_t ) ipTCP_WHEEL_SLOTS - 1U )
+
+/** @brief A slot of level 0 covers one clock tick, a slot of level 1 covers
+ *         16 ticks, etc. Four levels cover the full range of 'usTimeout'. */
+    #define ipTCP_WHEEL_LEVELS    ( 4U )
+    #define ipTCP_WHEEL_SPAN      ( ( TickType_t ) 1U << ( ipTCP_WHEEL_BITS * ipTCP_WHEEL_LEVELS ) )
+
+/** @brief pdTRUE when tick count 'xA' lies before tick count 'xB'. */
+    #define ipTCP_WHEEL_IS_BEFORE( xA, xB ) \
+    ( ( ( TickType_t ) ( ( xA ) - ( xB ) ) ) > ( ( ( TickType_t ) ~( ( TickType_t ) 0U ) ) >> 1 ) )
+
+/** @brief The slots of the TCP timer wheel. Each slot holds the sockets whose
+ *         'usTimeout' expires within the period covered by that slot. */
+    static List_t xTCPTimerWheel[ ipTCP_WHEEL_LEVELS ][ ipTCP_WHEEL_SLOTS ];
+
+/** @brief The TCP sockets that have events for their owner. The owners will
+ *         be woken up just before the IP-task goes asleep. */
+    static List_t xTCPWakeUpList;
+
+/** @brief The first clock tick of which the level-0 slot has not been handled yet. */
+    static TickType_t xTCPWheelTime;
+
+/** @brief The number of sockets stored in the TCP timer wheel. */
+    static UBaseType_t uxTCPWheelCount;
+
+/** @brief The TCP sockets whose 'usTimeout' was changed by a user task. The
+ *         IP-task reschedules them in xTCPTimerWheelCheck(). This list is
+ *         accessed by several tasks, always within a critical section. */
+    static List_t xTCPRescheduleList;
+
+/*
+ * Store a socket in the slot that belongs to its expiry time.
+ */
+    static void prvTCPTimerWheelPlace( ListItem_t * pxItem );
+
+/*
+ * Redistribute the slots of the higher levels that are now due.
+ */
+    static void prvTCPTimerWheelCascade( void );
+
+/*
+ * Return the number of clock ticks until the first expiry time in the wheel.
+ */
+    static TickType_t prvTCPTimerWheelNext( TickType_t xNow,
+                                            TickType_t xMaximum );
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_TIMER_WHEEL != 0 ) */
+
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_TICKLESS_IP_TASK != 0 )
+
+/**
+ * @brief Take the remaining time of an active IP timer into account.
+ *
+ * @param[in] pxTimer The IP timer.
+ * @param[in,out] pxEarliest The shortest remaining time found so far.
+ * @param[in,out] pxLatest The longest remaining time found so far that is not
+ *                         later than xWindowEnd.
+ * @param[in] xWindowEnd See pxLatest.
+ */
+    static void prvSleepTimeAddTimer( const IPTimer_t * pxTimer,
+                                      TickType_t * pxEarliest,
+                                      TickType_t * pxLatest,
+                                      TickType_t xWindowEnd )
+    {
+        TickType_t xRemaining;
+
+        if( pxTimer->bActive != pdFALSE_UNSIGNED )
+        {
+            if( pxTimer->bExpired != pdFALSE_UNSIGNED )
+            {
+                xRemaining = 0U;
+            }
+            else
+            {
+                /* vCheckNetworkTimers() has just updated 'ulRemainingTime'. */
+                xRemaining = pxTimer->ulRemainingTime;
+            }
+
+            if( xRemaining < *pxEarliest )
+            {
+                *pxEarliest = xRemaining;
+            }
+
+            if( ( xRemaining <= xWindowEnd ) && ( xRemaining > *pxLatest ) )
+            {
+                *pxLatest = xRemaining;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Go through all IP timers, see prvSleepTimeAddTimer().
+ *
+ * @param[in,out] pxEarliest The shortest remaining time.
+ * @param[in,out] pxLatest The longest remaining time not later than xWindowEnd.
+ * @param[in] xWindowEnd See pxLatest.
+ */
+    static void prvSleepTimeAddTimers( TickType_t * pxEarliest,
+                                       TickType_t * pxLatest,
+                                       TickType_t xWindowEnd )
+    {
+        prvSleepTimeAddTimer( &xARPTimer, pxEarliest, pxLatest, xWindowEnd );
+        prvSleepTimeAddTimer( &xARPResolutionTimer, pxEarliest, pxLatest, xWindowEnd );
+
+        if( xAllNetworksUp == pdFALSE )
+        {
+            prvSleepTimeAddTimer( &xNetworkTimer, pxEarliest, pxLatest, xWindowEnd );
+        }
+
+        #if ( ipconfigUSE_DHCP == 1 ) || ( ipconfigUSE_RA == 1 )
+        {
+            const NetworkEndPoint_t * pxEndPoint;
+
+            for( pxEndPoint = pxNetworkEndPoints; pxEndPoint != NULL; pxEndPoint = pxEndPoint->pxNext )
+            {
+                prvSleepTimeAddTimer( &( pxEndPoint->xDHCP_RATimer ), pxEarliest, pxLatest, xWindowEnd );
+            }
+        }
+        #endif
+
+        #if ( ipconfigUSE_TCP == 1 )
+            prvSleepTimeAddTimer( &xTCPTimer, pxEarliest, pxLatest, xWindowEnd );
+        #endif
+
+        #if ( ipconfigDNS_USE_CALLBACKS != 0 )
+            prvSleepTimeAddTimer( &xDNSTimer, pxEarliest, pxLatest, xWindowEnd );
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the time until the IP task has real work to do. Timers
+ *        that expire shortly after the first one are handled in the same
+ *        wake-up, so the first one may be delayed by up to
+ *        ipconfigIP_TASK_TIMER_SLACK_MS.
+ *
+ * @return The sleep time, at most ipconfigMAX_IP_TASK_SLEEP_TIME.
+ */
+    TickType_t xCalculateSleepTime( void )
+    {
+        TickType_t xEarliest = ipconfigMAX_IP_TASK_SLEEP_TIME;
+        TickType_t xLatest = 0U;
+        TickType_t xWindowEnd;
+
+        prvSleepTimeAddTimers( &xEarliest, &xLatest, 0U );
+
+        if( xEarliest < ipconfigMAX_IP_TASK_SLEEP_TIME )
+        {
+            xWindowEnd = xEarliest + pdMS_TO_TICKS( ipconfigIP_TASK_TIMER_SLACK_MS );
+
+            if( ( xWindowEnd < xEarliest ) || ( xWindowEnd > ipconfigMAX_IP_TASK_SLEEP_TIME ) )
+            {
+                xWindowEnd = ipconfigMAX_IP_TASK_SLEEP_TIME;
+            }
+
+            xLatest = xEarliest;
+            prvSleepTimeAddTimers( &xEarliest, &xLatest, xWindowEnd );
+            xEarliest = xLatest;
+        }
+
+        return xEarliest;
+    }
+
+#else /* if ( ipconfigUSE_TICKLESS_IP_TASK != 0 ) */
+
 /**
  * @brief Calculate the maximum sleep time remaining. It will go through all
  *        timers to see which timer will expire first. That will be the amount
@@ -190,6 +365,7 @@ TickType_t xCalculateSleepTime( void )
 
     return uxMaximumSleepTime;
 }
+#endif /* if ( ipconfigUSE_TICKLESS_IP_TASK != 0 ) */
 /*-----------------------------------------------------------*/
 
 /**
@@ -213,6 +389,13 @@ void vCheckNetworkTimers( void )
     /* Is the ARP resolution timer expired? */
     if( prvIPTimerCheck( &xARPResolutionTimer ) != pdFALSE )
     {
+        #if ( ipconfigARP_WAITING_BUFFER_COUNT > 1 )
+        {
+            /* Drop the packets that have waited too long. */
+            vIPWaitingBuffersCheckTimeout();
+        }
+        #endif
+
         if( pxARPWaitingNetworkBuffer != NULL )
         {
             /* Disable the ARP resolution timer. */
@@ -229,6 +412,13 @@ void vCheckNetworkTimers( void )
         }
     }
 
+    #if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+    {
+        /* Drop the datagrams of which fragments are missing for too long. */
+        vIPReassemblyCheckTimeout();
+    }
+    #endif
+
     #if ( ipconfigUSE_DHCP == 1 ) || ( ipconfigUSE_RA == 1 )
     {
         /* Is it time for DHCP processing? */
@@ -299,7 +489,11 @@ void vCheckNetworkTimers( void )
         {
             /* Attend to the sockets, returning the period after which the
              * check must be repeated. */
-            xNextTime = xTCPTimerCheck( xWillSleep );
+            #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
+                xNextTime = xTCPTimerWheelCheck( xWillSleep );
+            #else
+                xNextTime = xTCPTimerCheck( xWillSleep );
+            #endif
             prvIPTimerStart( &xTCPTimer, xNextTime );
         }
     }
@@ -612,3 +806,376 @@ void vSetAllNetworksUp( BaseType_t xIsAllNetworksUp )
 {
     xAllNetworksUp = xIsAllNetworksUp;
 }
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_TIMER_WHEEL != 0 ) )
+
+/**
+ * @brief Initialise the TCP timer wheel. Called from vNetworkSocketsInit().
+ */
+    void vTCPTimerWheelInit( void )
+    {
+        UBaseType_t uxLevel;
+        UBaseType_t uxSlot;
+
+        for( uxLevel = 0U; uxLevel < ipTCP_WHEEL_LEVELS; uxLevel++ )
+        {
+            for( uxSlot = 0U; uxSlot < ipTCP_WHEEL_SLOTS; uxSlot++ )
+            {
+                vListInitialise( &( xTCPTimerWheel[ uxLevel ][ uxSlot ] ) );
+            }
+        }
+
+        vListInitialise( &xTCPWakeUpList );
+        vListInitialise( &xTCPRescheduleList );
+        xTCPWheelTime = xTaskGetTickCount();
+        uxTCPWheelCount = 0U;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a list item in the slot that belongs to its expiry time. The
+ *        further away the expiry time, the higher the level of the slot.
+ *
+ * @param[in] pxItem The 'xTimerListItem' of a socket, its value holds the
+ *                   expiry time.
+ */
+    static void prvTCPTimerWheelPlace( ListItem_t * pxItem )
+    {
+        TickType_t xExpiry = listGET_LIST_ITEM_VALUE( pxItem );
+        TickType_t xDelta;
+        UBaseType_t uxLevel = 0U;
+
+        if( ipTCP_WHEEL_IS_BEFORE( xExpiry, xTCPWheelTime ) )
+        {
+            /* Already expired, handle it in the next slot. */
+            xExpiry = xTCPWheelTime;
+        }
+
+        xDelta = xExpiry - xTCPWheelTime;
+
+        if( xDelta >= ipTCP_WHEEL_SPAN )
+        {
+            /* Too far away, the socket will be placed again later. */
+            xExpiry = xTCPWheelTime + ( ipTCP_WHEEL_SPAN - 1U );
+            xDelta = ipTCP_WHEEL_SPAN - 1U;
+        }
+
+        while( ( uxLevel < ( ipTCP_WHEEL_LEVELS - 1U ) ) &&
+               ( xDelta >= ( ( TickType_t ) 1U << ( ( uxLevel + 1U ) * ipTCP_WHEEL_BITS ) ) ) )
+        {
+            uxLevel++;
+        }
+
+        vListInsertEnd( &( xTCPTimerWheel[ uxLevel ][ ( xExpiry >> ( uxLevel * ipTCP_WHEEL_BITS ) ) & ipTCP_WHEEL_MASK ] ), pxItem );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called when the level-0 slots have wrapped around: the sockets in
+ *        the slot of level 1 that has become current are moved to a lower
+ *        level. The same is done for the higher levels when they wrap.
+ */
+    static void prvTCPTimerWheelCascade( void )
+    {
+        UBaseType_t uxLevel;
+
+        for( uxLevel = 1U; uxLevel < ipTCP_WHEEL_LEVELS; uxLevel++ )
+        {
+            TickType_t xIndex = ( xTCPWheelTime >> ( uxLevel * ipTCP_WHEEL_BITS ) ) & ipTCP_WHEEL_MASK;
+            List_t * pxSlot = &( xTCPTimerWheel[ uxLevel ][ xIndex ] );
+
+            while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                ListItem_t * pxItem = listGET_HEAD_ENTRY( pxSlot );
+
+                ( void ) uxListRemove( pxItem );
+                prvTCPTimerWheelPlace( pxItem );
+            }
+
+            if( xIndex != 0U )
+            {
+                /* This level did not wrap, so the higher levels did not
+                 * advance. */
+                break;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the number of clock ticks until the first socket in the wheel
+ *        expires. Only the first non-empty slot of each level is inspected.
+ *
+ * @param[in] xNow The current tick count.
+ * @param[in] xMaximum The value to return when there is no earlier expiry.
+ *
+ * @return The number of clock ticks until the first expiry, at most xMaximum.
+ */
+    static TickType_t prvTCPTimerWheelNext( TickType_t xNow,
+                                            TickType_t xMaximum )
+    {
+        TickType_t xShortest = xMaximum;
+        UBaseType_t uxLevel;
+
+        for( uxLevel = 0U; ( uxLevel < ipTCP_WHEEL_LEVELS ) && ( uxTCPWheelCount > 0U ); uxLevel++ )
+        {
+            /* For level 0 the current slot is the first one to expire. For the
+             * higher levels, the current slot is only due after a complete
+             * revolution, so start looking in the next slot. */
+            TickType_t xFirst = ( xTCPWheelTime >> ( uxLevel * ipTCP_WHEEL_BITS ) ) + ( ( uxLevel == 0U ) ? 0U : 1U );
+            UBaseType_t uxCount;
+
+            for( uxCount = 0U; uxCount < ipTCP_WHEEL_SLOTS; uxCount++ )
+            {
+                const List_t * pxSlot = &( xTCPTimerWheel[ uxLevel ][ ( xFirst + uxCount ) & ipTCP_WHEEL_MASK ] );
+
+                if( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                {
+                    const ListItem_t * pxEnd = listGET_END_MARKER( pxSlot );
+                    const ListItem_t * pxIterator;
+
+                    for( pxIterator = listGET_NEXT( pxEnd );
+                         pxIterator != pxEnd;
+                         pxIterator = listGET_NEXT( pxIterator ) )
+                    {
+                        TickType_t xExpiry = listGET_LIST_ITEM_VALUE( pxIterator );
+                        TickType_t xRemaining = 0U;
+
+                        if( ipTCP_WHEEL_IS_BEFORE( xNow, xExpiry ) )
+                        {
+                            xRemaining = xExpiry - xNow;
+                        }
+
+                        if( xRemaining < xShortest )
+                        {
+                            xShortest = xRemaining;
+                        }
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        return xShortest;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Put a TCP socket in the timer wheel according to its 'usTimeout', or
+ *        take it out when 'usTimeout' is zero. When the timeout did not change
+ *        since the last call, the expiry time is kept. A socket that has
+ *        events for its owner is also added to the wake-up list.
+ *
+ * @param[in] pxSocket The TCP socket.
+ */
+    void vTCPTimerWheelSchedule( FreeRTOS_Socket_t * pxSocket )
+    {
+        /* Only the IP-task may access the wheel. Changes made by other tasks
+         * are passed on by vTCPTimerWheelRequest(). */
+        if( xIsCallingFromIPTask() != pdFALSE )
+        {
+            ListItem_t * pxItem = &( pxSocket->u.xTCP.xTimerListItem );
+            BaseType_t xIsScheduled = ( listLIST_ITEM_CONTAINER( pxItem ) != NULL ) ? pdTRUE : pdFALSE;
+
+            if( pxSocket->u.xTCP.usTimeout == 0U )
+            {
+                if( xIsScheduled != pdFALSE )
+                {
+                    ( void ) uxListRemove( pxItem );
+                    uxTCPWheelCount--;
+                }
+            }
+            else if( ( xIsScheduled == pdFALSE ) ||
+                     ( pxSocket->u.xTCP.usTimeout != pxSocket->u.xTCP.usTimeoutScheduled ) )
+            {
+                if( xIsScheduled != pdFALSE )
+                {
+                    ( void ) uxListRemove( pxItem );
+                }
+                else
+                {
+                    uxTCPWheelCount++;
+                }
+
+                listSET_LIST_ITEM_VALUE( pxItem, xTaskGetTickCount() + ( TickType_t ) pxSocket->u.xTCP.usTimeout );
+                pxSocket->u.xTCP.usTimeoutScheduled = pxSocket->u.xTCP.usTimeout;
+                prvTCPTimerWheelPlace( pxItem );
+            }
+            else
+            {
+                /* The timeout has not changed, keep the expiry time. */
+            }
+
+            if( ( pxSocket->xEventBits != 0U ) &&
+                ( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xWakeUpListItem ) ) == NULL ) )
+            {
+                vListInsertEnd( &xTCPWakeUpList, &( pxSocket->u.xTCP.xWakeUpListItem ) );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Ask the IP-task to reschedule a TCP socket, after its 'usTimeout' was
+ *        changed. Called just before an eTCPTimerEvent is sent. Only the
+ *        sockets that were requested are rescheduled, see
+ *        xTCPTimerWheelCheck().
+ *
+ * @param[in] pxSocket The TCP socket.
+ */
+    void vTCPTimerWheelRequest( FreeRTOS_Socket_t * pxSocket )
+    {
+        if( xIsCallingFromIPTask() != pdFALSE )
+        {
+            vTCPTimerWheelSchedule( pxSocket );
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xRescheduleListItem ) ) == NULL )
+                {
+                    vListInsertEnd( &xTCPRescheduleList, &( pxSocket->u.xTCP.xRescheduleListItem ) );
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take a TCP socket out of the timer wheel and out of the wake-up list.
+ *        Called when the socket is closed.
+ *
+ * @param[in] pxSocket The TCP socket.
+ */
+    void vTCPTimerWheelRemove( FreeRTOS_Socket_t * pxSocket )
+    {
+        if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xTimerListItem ) ) != NULL )
+        {
+            ( void ) uxListRemove( &( pxSocket->u.xTCP.xTimerListItem ) );
+            uxTCPWheelCount--;
+        }
+
+        if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xWakeUpListItem ) ) != NULL )
+        {
+            ( void ) uxListRemove( &( pxSocket->u.xTCP.xWakeUpListItem ) );
+        }
+
+        taskENTER_CRITICAL();
+        {
+            if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xRescheduleListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxSocket->u.xTCP.xRescheduleListItem ) );
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The replacement of xTCPTimerCheck(): handle the TCP sockets whose
+ *        timeout has expired, and wake up the owners of sockets that have
+ *        events.
+ *
+ * @param[in] xWillSleep Whether the calling task is going to sleep.
+ *
+ * @return Minimum amount of time before the timer shall expire.
+ */
+    TickType_t xTCPTimerWheelCheck( BaseType_t xWillSleep )
+    {
+        TickType_t xNow = xTaskGetTickCount();
+        #if ( ipconfigUSE_TICKLESS_IP_TASK != 0 )
+            /* A socket without a pending timeout does not need the IP task. */
+            TickType_t xShortest = ipconfigMAX_IP_TASK_SLEEP_TIME;
+        #else
+            TickType_t xShortest = pdMS_TO_TICKS( ( TickType_t ) ipTCP_TIMER_PERIOD_MS );
+        #endif
+
+        /* Only the IP-task removes sockets from xTCPRescheduleList, so it
+         * can not become empty while it is being emptied. */
+        while( listLIST_IS_EMPTY( &xTCPRescheduleList ) == pdFALSE )
+        {
+            FreeRTOS_Socket_t * pxSocket;
+
+            taskENTER_CRITICAL();
+            {
+                pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xTCPRescheduleList ) );
+                ( void ) uxListRemove( &( pxSocket->u.xTCP.xRescheduleListItem ) );
+            }
+            taskEXIT_CRITICAL();
+
+            vTCPTimerWheelSchedule( pxSocket );
+        }
+
+        if( uxTCPWheelCount == 0U )
+        {
+            /* Nothing is scheduled, no need to visit the empty slots. */
+            xTCPWheelTime = xNow + 1U;
+        }
+
+        while( ipTCP_WHEEL_IS_BEFORE( xNow, xTCPWheelTime ) == pdFALSE )
+        {
+            List_t * pxSlot;
+
+            if( ( xTCPWheelTime & ipTCP_WHEEL_MASK ) == 0U )
+            {
+                prvTCPTimerWheelCascade();
+            }
+
+            pxSlot = &( xTCPTimerWheel[ 0 ][ xTCPWheelTime & ipTCP_WHEEL_MASK ] );
+
+            while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ) );
+
+                ( void ) uxListRemove( &( pxSocket->u.xTCP.xTimerListItem ) );
+                uxTCPWheelCount--;
+                pxSocket->u.xTCP.usTimeout = 0U;
+
+                /* Within this function, the socket might want to send a delayed
+                 * ack or send out data or whatever it needs to do. A negative
+                 * result means that the socket was deleted. */
+                if( xTCPSocketCheck( pxSocket ) >= 0 )
+                {
+                    vTCPTimerWheelSchedule( pxSocket );
+                }
+            }
+
+            xTCPWheelTime++;
+        }
+
+        /* In xEventBits the driver may indicate that the socket has important
+         * events for the user.  These are only done just before the IP-task
+         * goes to sleep. */
+        if( listLIST_IS_EMPTY( &xTCPWakeUpList ) == pdFALSE )
+        {
+            if( xWillSleep != pdFALSE )
+            {
+                while( listLIST_IS_EMPTY( &xTCPWakeUpList ) == pdFALSE )
+                {
+                    FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xTCPWakeUpList ) );
+
+                    ( void ) uxListRemove( &( pxSocket->u.xTCP.xWakeUpListItem ) );
+
+                    if( pxSocket->xEventBits != 0U )
+                    {
+                        vSocketWakeUpUser( pxSocket );
+                    }
+                }
+            }
+            else
+            {
+                /* Make sure this will be called again to wake-up the sockets'
+                 * owners. */
+                xShortest = ( TickType_t ) 0;
+            }
+        }
+
+        return prvTCPTimerWheelNext( xNow, xShortest );
+    }
+
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_TIMER_WHEEL != 0 ) */
+/*-----------------------------------------------------------*/
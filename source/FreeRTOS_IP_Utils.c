@@ -55,6 +55,8 @@
 #include "FreeRTOS_DNS.h"
 #include "FreeRTOS_Routing.h"
 #include "FreeRTOS_ND.h"
+#include "FreeRTOS_IGMP.h"
+#include "FreeRTOS_Bond.h"
 /*-----------------------------------------------------------*/
 
 /* Used to ensure the structure packing is having the desired effect.  The
@@ -137,6 +139,19 @@ static void prvSetChecksumInPacket( const struct xPacketSummary * pxSet,
 
 static uint16_t prvGetChecksumFromPacket( const struct xPacketSummary * pxSet );
 
+static uint16_t prvGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
+                                             size_t uxBufferLength,
+                                             BaseType_t xOutgoingPacket,
+                                             size_t uxPayloadSumLength,
+                                             uint16_t usPayloadSum,
+                                             const PacketMetadata_t * pxMetadata );
+
+#if ( ipconfigUSE_PACKET_METADATA != 0 )
+    static void prvChecksumMetadataChecks( uint8_t * pucEthernetBuffer,
+                                           const PacketMetadata_t * pxMetadata,
+                                           struct xPacketSummary * pxSet );
+#endif
+
 /**
  * @brief Set checksum in the packet
  *
@@ -285,6 +300,13 @@ NetworkBufferDescriptor_t * pxDuplicateNetworkBufferWithDescriptor( const Networ
         pxNewBuffer->pxEndPoint = pxNetworkBuffer->pxEndPoint;
         ( void ) memcpy( pxNewBuffer->pucEthernetBuffer, pxNetworkBuffer->pucEthernetBuffer, uxLengthToCopy );
 
+        #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+        {
+            pxNewBuffer->xTimestamp = pxNetworkBuffer->xTimestamp;
+            pxNewBuffer->ucTxTimestamp = pxNetworkBuffer->ucTxTimestamp;
+        }
+        #endif
+
         #if ( ipconfigUSE_IPv6 != 0 )
             if( uxIPHeaderSizePacket( pxNewBuffer ) == ipSIZE_OF_IPv6_HEADER )
             {
@@ -498,8 +520,9 @@ static BaseType_t prvChecksumProtocolMTUCheck( struct xPacketSummary * pxSet )
     /* Here, 'pxSet->usProtocolBytes' contains the size of the protocol data
      * ( headers and payload ). */
 
-    /* The Ethernet header is excluded from the MTU. */
-    uint32_t ulMaxLength = ipconfigNETWORK_MTU;
+    /* The Ethernet header is excluded from the MTU. A reassembled datagram
+     * may be larger than the MTU. */
+    uint32_t ulMaxLength = ( uint32_t ) ipMAX_IP_PACKET_SIZE;
 
     ulMaxLength -= ( uint32_t ) pxSet->uxIPHeaderLength;
 
@@ -524,6 +547,21 @@ static BaseType_t prvChecksumProtocolMTUCheck( struct xPacketSummary * pxSet )
 }
 /*-----------------------------------------------------------*/
 
+/** @brief Add the sum of a payload that was already summed to the checksum
+ *         accumulator.  The payload will not be read again.
+ * @param[in] pxSet A struct describing this packet.
+ */
+static void prvChecksumAddPayloadSum( struct xPacketSummary * pxSet )
+{
+    uint32_t ulSum;
+
+    configASSERT( pxSet->uxPayloadSumLength <= ( ( size_t ) pxSet->usProtocolBytes - pxSet->uxProtocolHeaderLength ) );
+
+    ulSum = ( uint32_t ) pxSet->usChecksum + ( uint32_t ) pxSet->usPayloadSum;
+    pxSet->usChecksum = ( uint16_t ) ( ( ulSum & 0xFFFFU ) + ( ulSum >> 16 ) );
+}
+/*-----------------------------------------------------------*/
+
 /** @brief Do the actual checksum calculations, both the pseudo header, and the payload.
  * @param[in] xOutgoingPacket pdTRUE when the packet is to be sent.
  * @param[in] pucEthernetBuffer The buffer containing the packet.
@@ -584,10 +622,11 @@ static void prvChecksumProtocolCalculate( BaseType_t xOutgoingPacket,
             #if ( ipconfigUSE_IPv6 != 0 )
                 case pdTRUE:
                     /* The CRC of the IPv6 pseudo-header has already been calculated. */
+                    prvChecksumAddPayloadSum( pxSet );
                     pxSet->usChecksum = ( uint16_t )
                                         ( ~usGenerateChecksum( pxSet->usChecksum,
                                                                ( uint8_t * ) &( pxSet->pxProtocolHeaders->xUDPHeader.usSourcePort ),
-                                                               ( size_t ) ( pxSet->usProtocolBytes ) ) );
+                                                               ( size_t ) ( pxSet->usProtocolBytes ) - pxSet->uxPayloadSumLength ) );
                     break;
             #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
@@ -601,12 +640,13 @@ static void prvChecksumProtocolCalculate( BaseType_t xOutgoingPacket,
                        /* For UDP and TCP, sum the pseudo header, i.e. IP protocol + length
                         * fields */
                        pxSet->usChecksum = ( uint16_t ) ( pxSet->usProtocolBytes + ( ( uint16_t ) pxSet->ucProtocol ) );
+                       prvChecksumAddPayloadSum( pxSet );
 
                        /* And then continue at the IPv4 source and destination addresses. */
                        pxSet->usChecksum = ( uint16_t )
                                            ( ~usGenerateChecksum( pxSet->usChecksum,
                                                                   ( const uint8_t * ) &( pxSet->pxIPPacket->xIPHeader.ulSourceIPAddress ),
-                                                                  ulByteCount ) );
+                                                                  ( size_t ) ulByteCount - pxSet->uxPayloadSumLength ) );
                    }
                    break;
             #endif /* ( ipconfigUSE_IPv4 != 0 ) */
@@ -825,6 +865,46 @@ void prvProcessNetworkDownEvent( struct xNetworkInterface * pxInterface )
     /* Stop the ARP timer while there is no network. */
     vIPSetARPTimerEnableState( pdFALSE );
 
+    #if ( ipconfigUSE_LINK_BONDING != 0 )
+    {
+        /* A bond goes down together with its last member. */
+        vBondMemberDown( pxInterface );
+    }
+    #endif
+
+    #if ( ipHEADER_CACHE != 0 )
+    {
+        vIPHeaderCacheInvalidate();
+    }
+    #endif
+
+    /* Forget routes that went through the end-points of this interface. */
+    FreeRTOS_RouteCacheInvalidate();
+
+    #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+    {
+        /* The driver will not report room in a ring that it is going to
+         * reset.  Drop the held frame and let the paused TCP sockets
+         * continue. */
+        if( pxInterface->xTxBusy != pdFALSE )
+        {
+            if( pxInterface->pxTxHeld != NULL )
+            {
+                vReleaseNetworkBufferAndDescriptor( pxInterface->pxTxHeld );
+                pxInterface->pxTxHeld = NULL;
+            }
+
+            pxInterface->xTxBusy = pdFALSE;
+
+            #if ( ipconfigUSE_TCP == 1 )
+            {
+                vTCPResumeTxPaused();
+            }
+            #endif
+        }
+    }
+    #endif
+
     /* The first network down event is generated by the IP stack itself to
      * initialise the network hardware, so do not call the network down event
      * the first time through. */
@@ -897,13 +977,37 @@ void prvProcessNetworkDownEvent( struct xNetworkInterface * pxInterface )
         #endif /* ( (ipconfigUSE_RA != 0) && ( ipconfigUSE_IPv6 != 0 )) */
     }
 
+    #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+    {
+        /* The MAC filters of the joined groups will be set again once the
+         * interface has been initialised. */
+        vMulticastInterfaceDown( pxInterface );
+    }
+    #endif
+
     /* The network has been disconnected (or is being initialised for the first
      * time).  Perform whatever hardware processing is necessary to bring it up
      * again, or wait for it to be available again.  This is hardware dependent. */
+    vBringUpInterfaceMilestone( pxInterface, eBringUpInitialiseStart );
 
     if( pxInterface->pfInitialise( pxInterface ) == pdPASS )
     {
         pxInterface->bits.bInterfaceUp = pdTRUE_UNSIGNED;
+        vBringUpInterfaceMilestone( pxInterface, eBringUpInitialiseDone );
+
+        #if ( ipconfigUSE_FAST_BRING_UP != 0 )
+        {
+            /* Measure the time until all end-points are up, see vIPNetworkUpCalls(). */
+            pxInterface->xBringUpTime = xTaskGetTickCount();
+            pxInterface->bits.bBringingUp = pdTRUE_UNSIGNED;
+        }
+        #endif
+
+        #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+        {
+            vMulticastHandleEvent();
+        }
+        #endif
         /* Set remaining time to 0 so it will become active immediately. */
 
         /* The network is not up until DHCP has completed.
@@ -977,6 +1081,204 @@ void prvProcessNetworkDownEvent( struct xNetworkInterface * pxInterface )
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_ICMP_RATE_LIMIT != 0 )
+
+/** @brief A token bucket.  One message costs configTICK_RATE_HZ tokens, the
+ *         bucket gains 'rate' tokens per clock tick. */
+    typedef struct xICMP_TOKEN_BUCKET
+    {
+        TickType_t xLastUpdate; /**< The time at which ulTokens was last updated. */
+        uint32_t ulTokens;      /**< The number of tokens in the bucket. */
+    } ICMPTokenBucket_t;
+
+/** @brief The bucket of one source address and one message type. */
+    typedef struct xICMP_SOURCE_BUCKET
+    {
+        IP_Address_t xSource;      /**< The address of the host. */
+        eICMPRateType_t eType;     /**< The message type. */
+        BaseType_t xInUse;         /**< pdTRUE when the slot has an owner. */
+        ICMPTokenBucket_t xBucket; /**< The bucket. */
+    } ICMPSourceBucket_t;
+
+/** @brief The global buckets, one for each message type. */
+    static ICMPTokenBucket_t xICMPGlobalBuckets[ eICMPRateTypeMax ];
+
+/** @brief pdTRUE once xICMPGlobalBuckets[] has been filled. */
+    static BaseType_t xICMPGlobalBucketsReady = pdFALSE;
+
+    #if ( ipconfigICMP_RATE_LIMIT_PER_SOURCE > 0 )
+/** @brief The buckets of the sources that were seen most recently. */
+        static ICMPSourceBucket_t xICMPSourceBuckets[ ipconfigICMP_RATE_LIMIT_SOURCES ];
+    #endif
+
+/**
+ * @brief Take one message worth of tokens from a bucket, after adding the
+ *        tokens that were earned since the last call.
+ *
+ * @param[in] pxBucket The bucket.
+ * @param[in] xNow The current tick count.
+ * @param[in] ulRate The number of messages allowed per second.
+ * @param[in] ulBurst The number of messages that fit in the bucket.
+ *
+ * @return pdTRUE when the message may be sent.
+ */
+    static BaseType_t prvICMPTokenBucketTake( ICMPTokenBucket_t * pxBucket,
+                                              TickType_t xNow,
+                                              uint32_t ulRate,
+                                              uint32_t ulBurst )
+    {
+        const uint32_t ulCost = ( uint32_t ) configTICK_RATE_HZ;
+        const uint32_t ulDepth = ulBurst * ulCost;
+        TickType_t xElapsed = xNow - pxBucket->xLastUpdate;
+        BaseType_t xReturn = pdFALSE;
+
+        pxBucket->xLastUpdate = xNow;
+
+        if( xElapsed >= ( ( TickType_t ) ulDepth / ( TickType_t ) ulRate ) )
+        {
+            /* Idle long enough to fill the bucket, avoid an overflow. */
+            pxBucket->ulTokens = ulDepth;
+        }
+        else
+        {
+            pxBucket->ulTokens += ( uint32_t ) xElapsed * ulRate;
+
+            if( pxBucket->ulTokens > ulDepth )
+            {
+                pxBucket->ulTokens = ulDepth;
+            }
+        }
+
+        if( pxBucket->ulTokens >= ulCost )
+        {
+            pxBucket->ulTokens -= ulCost;
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigICMP_RATE_LIMIT_PER_SOURCE > 0 )
+
+/**
+ * @brief Find the bucket of a source, or give the least recently used one
+ *        to it.
+ *
+ * @param[in] eType The message type.
+ * @param[in] pxSource The address of the host.
+ * @param[in] xNow The current tick count.
+ *
+ * @return The bucket of the source.
+ */
+        static ICMPTokenBucket_t * prvICMPSourceBucket( eICMPRateType_t eType,
+                                                        const IP_Address_t * pxSource,
+                                                        TickType_t xNow )
+        {
+            ICMPSourceBucket_t * pxSlot = NULL;
+            BaseType_t xOldest = 0;
+            BaseType_t x;
+
+            for( x = 0; x < ( BaseType_t ) ipconfigICMP_RATE_LIMIT_SOURCES; x++ )
+            {
+                if( xICMPSourceBuckets[ x ].xInUse == pdFALSE )
+                {
+                    xOldest = x;
+                }
+                else if( ( xICMPSourceBuckets[ x ].eType == eType ) &&
+                         ( memcmp( &( xICMPSourceBuckets[ x ].xSource ), pxSource, sizeof( *pxSource ) ) == 0 ) )
+                {
+                    pxSlot = &( xICMPSourceBuckets[ x ] );
+                    break;
+                }
+                else if( ( xICMPSourceBuckets[ xOldest ].xInUse != pdFALSE ) &&
+                         ( ( xNow - xICMPSourceBuckets[ x ].xBucket.xLastUpdate ) > ( xNow - xICMPSourceBuckets[ xOldest ].xBucket.xLastUpdate ) ) )
+                {
+                    xOldest = x;
+                }
+                else
+                {
+                    /* Keep looking. */
+                }
+            }
+
+            if( pxSlot == NULL )
+            {
+                /* A new source starts with a full bucket. */
+                pxSlot = &( xICMPSourceBuckets[ xOldest ] );
+                ( void ) memcpy( &( pxSlot->xSource ), pxSource, sizeof( pxSlot->xSource ) );
+                pxSlot->eType = eType;
+                pxSlot->xInUse = pdTRUE;
+                pxSlot->xBucket.xLastUpdate = xNow;
+                pxSlot->xBucket.ulTokens = ( uint32_t ) ipconfigICMP_RATE_LIMIT_BURST * ( uint32_t ) configTICK_RATE_HZ;
+            }
+
+            return &( pxSlot->xBucket );
+        }
+    #endif /* ( ipconfigICMP_RATE_LIMIT_PER_SOURCE > 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check whether an ICMP message may be sent in reply to a host, see
+ *        ipconfigUSE_ICMP_RATE_LIMIT.  Only called from the IP-task.
+ *
+ * @param[in] eType The type of the message that would be sent.
+ * @param[in] pxSource The host that would receive it. The unused bytes
+ *                     must be zero.
+ *
+ * @return pdTRUE when the message may be sent, pdFALSE when it must be
+ *         suppressed.
+ */
+    BaseType_t xICMPRateLimitCheck( eICMPRateType_t eType,
+                                    const IP_Address_t * pxSource )
+    {
+        TickType_t xNow = xTaskGetTickCount();
+        BaseType_t xReturn = pdTRUE;
+        BaseType_t x;
+
+        if( xICMPGlobalBucketsReady == pdFALSE )
+        {
+            for( x = 0; x < ( BaseType_t ) eICMPRateTypeMax; x++ )
+            {
+                xICMPGlobalBuckets[ x ].xLastUpdate = xNow;
+                xICMPGlobalBuckets[ x ].ulTokens = ( uint32_t ) ipconfigICMP_RATE_LIMIT_PER_SECOND * ( uint32_t ) configTICK_RATE_HZ;
+            }
+
+            xICMPGlobalBucketsReady = pdTRUE;
+        }
+
+        #if ( ipconfigICMP_RATE_LIMIT_PER_SOURCE > 0 )
+        {
+            xReturn = prvICMPTokenBucketTake( prvICMPSourceBucket( eType, pxSource, xNow ),
+                                              xNow,
+                                              ( uint32_t ) ipconfigICMP_RATE_LIMIT_PER_SOURCE,
+                                              ( uint32_t ) ipconfigICMP_RATE_LIMIT_BURST );
+        }
+        #else
+        {
+            ( void ) pxSource;
+        }
+        #endif
+
+        if( xReturn != pdFALSE )
+        {
+            xReturn = prvICMPTokenBucketTake( &( xICMPGlobalBuckets[ eType ] ),
+                                              xNow,
+                                              ( uint32_t ) ipconfigICMP_RATE_LIMIT_PER_SECOND,
+                                              ( uint32_t ) ipconfigICMP_RATE_LIMIT_PER_SECOND );
+        }
+
+        if( xReturn == pdFALSE )
+        {
+            iptraceICMP_RATE_LIMITED( eType );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_ICMP_RATE_LIMIT != 0 ) */
+
 /**
  * @brief Check the values of configuration options and assert on it. Also verify that the IP-task
  *        has not already been initialized.
@@ -1073,12 +1375,228 @@ void vPreCheckConfigs( void )
 uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
                                      size_t uxBufferLength,
                                      BaseType_t xOutgoingPacket )
+{
+    return prvGenerateProtocolChecksum( pucEthernetBuffer, uxBufferLength, xOutgoingPacket, 0U, 0U, NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_PACKET_METADATA != 0 )
+
+/**
+ * @brief Parse the IP-header of a received packet and store the offsets of
+ *        the headers in 'xMetadata'. The fields are only marked valid when
+ *        the length fields agree with the size of the frame.
+ *
+ * @param[in] pxNetworkBuffer The network buffer holding the received packet.
+ */
+    void vPacketMetadataParse( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        PacketMetadata_t * pxMetadata = &( pxNetworkBuffer->xMetadata );
+        const uint8_t * pucEthernetBuffer = pxNetworkBuffer->pucEthernetBuffer;
+        size_t uxBufferLength = pxNetworkBuffer->xDataLength;
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const EthernetHeader_t * pxEthernetHeader = ( ( const EthernetHeader_t * ) pucEthernetBuffer );
+
+        ( void ) memset( pxMetadata, 0, sizeof( *pxMetadata ) );
+
+        switch( pxEthernetHeader->usFrameType )
+        {
+            #if ( ipconfigUSE_IPv4 != 0 )
+                case ipIPv4_FRAME_TYPE:
+
+                    if( uxBufferLength >= sizeof( IPPacket_t ) )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+                        size_t uxHeaderLength = ( ( size_t ) pxIPHeader->ucVersionHeaderLength & 0x0FU ) << 2;
+                        size_t uxTotalLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usLength );
+
+                        if( ( uxHeaderLength >= ipSIZE_OF_IPv4_HEADER ) &&
+                            ( uxTotalLength >= uxHeaderLength ) &&
+                            ( ( ipSIZE_OF_ETH_HEADER + uxTotalLength ) <= uxBufferLength ) )
+                        {
+                            pxMetadata->usL3Offset = ( uint16_t ) ipSIZE_OF_ETH_HEADER;
+                            pxMetadata->usL4Offset = ( uint16_t ) ( ipSIZE_OF_ETH_HEADER + uxHeaderLength );
+                            pxMetadata->usL4Length = ( uint16_t ) ( uxTotalLength - uxHeaderLength );
+                            pxMetadata->ucProtocol = pxIPHeader->ucProtocol;
+                            pxMetadata->ucValid = pdTRUE_UNSIGNED;
+                        }
+                    }
+
+                    break;
+            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                case ipIPv6_FRAME_TYPE:
+
+                    if( uxBufferLength >= sizeof( IPPacket_IPv6_t ) )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        const IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+                        size_t uxPayloadLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader_IPv6->usPayloadLength );
+                        uint8_t ucProtocol = pxIPHeader_IPv6->ucNextHeader;
+                        size_t uxExtensionHeaderLength = 0U;
+
+                        if( ipIPv6_IS_UPPER_LAYER_PROTOCOL( ucProtocol ) == pdFALSE )
+                        {
+                            /* Walk the extension headers once. */
+                            uxExtensionHeaderLength = usGetExtensionHeaderLength( pucEthernetBuffer, uxBufferLength, &( ucProtocol ) );
+                        }
+
+                        if( ( uxExtensionHeaderLength <= uxPayloadLength ) &&
+                            ( ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + uxPayloadLength ) <= uxBufferLength ) )
+                        {
+                            pxMetadata->usL3Offset = ( uint16_t ) ipSIZE_OF_ETH_HEADER;
+                            pxMetadata->usL4Offset = ( uint16_t ) ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + uxExtensionHeaderLength );
+                            pxMetadata->usL4Length = ( uint16_t ) ( uxPayloadLength - uxExtensionHeaderLength );
+                            pxMetadata->ucProtocol = ucProtocol;
+                            pxMetadata->ucIsIPv6 = pdTRUE_UNSIGNED;
+                            pxMetadata->ucValid = pdTRUE_UNSIGNED;
+                        }
+                    }
+
+                    break;
+            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+            default:
+                /* Not an IP packet, there is nothing to describe. */
+                break;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check the protocol checksum of a received packet. When the packet
+ *        has valid metadata, the IP-header is not parsed again.
+ *
+ * @param[in] pxNetworkBuffer The network buffer holding the received packet.
+ *
+ * @return See usGenerateProtocolChecksum().
+ */
+    uint16_t usGenerateProtocolChecksumPacket( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        const PacketMetadata_t * pxMetadata = NULL;
+
+        if( pxNetworkBuffer->xMetadata.ucValid != pdFALSE_UNSIGNED )
+        {
+            pxMetadata = &( pxNetworkBuffer->xMetadata );
+        }
+
+        return prvGenerateProtocolChecksum( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, pdFALSE, 0U, 0U, pxMetadata );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fill in the IP-level fields of 'pxSet' from the metadata of a
+ *        received packet, as prvChecksumIPv4Checks() and prvChecksumIPv6Checks()
+ *        would do.
+ *
+ * @param[in] pucEthernetBuffer The buffer containing the packet.
+ * @param[in] pxMetadata The header offsets, found by vPacketMetadataParse().
+ * @param[in] pxSet A struct describing this packet.
+ */
+    static void prvChecksumMetadataChecks( uint8_t * pucEthernetBuffer,
+                                           const PacketMetadata_t * pxMetadata,
+                                           struct xPacketSummary * pxSet )
+    {
+        size_t uxL3Length = ( size_t ) pxMetadata->usL4Offset - ( size_t ) pxMetadata->usL3Offset;
+
+        pxSet->ucProtocol = pxMetadata->ucProtocol;
+        pxSet->usProtocolBytes = pxMetadata->usL4Length;
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        pxSet->pxProtocolHeaders = ( ( ProtocolHeaders_t * ) &( pucEthernetBuffer[ pxMetadata->usL4Offset ] ) );
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            if( pxMetadata->ucIsIPv6 != pdFALSE_UNSIGNED )
+            {
+                pxSet->xIsIPv6 = pdTRUE;
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxSet->pxIPPacket_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pucEthernetBuffer[ pxMetadata->usL3Offset ] ) );
+                /* Extension headers are part of the payload, not of the IP-header. */
+                pxSet->uxIPHeaderLength = ipSIZE_OF_IPv6_HEADER;
+                pxSet->usPayloadLength = ( uint16_t ) ( pxMetadata->usL4Length + ( uxL3Length - ipSIZE_OF_IPv6_HEADER ) );
+            }
+            else
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        {
+            pxSet->xIsIPv6 = pdFALSE;
+            pxSet->uxIPHeaderLength = uxL3Length;
+            /* For IPv4, the length of the IP-header is included. */
+            pxSet->usPayloadLength = ( uint16_t ) ( pxMetadata->usL4Length + uxL3Length );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_PACKET_METADATA != 0 ) */
+
+#if ( ipconfigTCP_TX_COPY_CHECKSUM != 0 )
+
+/**
+ * @brief Set the protocol checksum of an outgoing UDP or TCP packet, of which the
+ *        payload has already been summed, e.g. while it was copied into the packet.
+ *
+ * @param[in] pucEthernetBuffer The Ethernet buffer for which the checksum is to be calculated.
+ * @param[in] uxBufferLength The number of bytes written in the packet buffer.
+ * @param[in] uxPayloadLength The number of bytes at the end of the packet that were summed.
+ * @param[in] usPayloadSum The one's complement sum of those bytes, as returned by
+ *                         uxStreamBufferGetWithChecksum().
+ *
+ * @return Either ipINVALID_LENGTH, ipUNHANDLED_PROTOCOL, or ipCORRECT_CRC.
+ */
+    uint16_t usGenerateProtocolChecksumWithPayloadSum( uint8_t * pucEthernetBuffer,
+                                                       size_t uxBufferLength,
+                                                       size_t uxPayloadLength,
+                                                       uint16_t usPayloadSum )
+    {
+        return prvGenerateProtocolChecksum( pucEthernetBuffer, uxBufferLength, pdTRUE, uxPayloadLength, usPayloadSum, NULL );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigTCP_TX_COPY_CHECKSUM != 0 */
+
+/**
+ * @brief Worker for usGenerateProtocolChecksum().
+ *
+ * @param[in] pucEthernetBuffer The Ethernet buffer for which the checksum is to be calculated
+ *                               or checked.
+ * @param[in] uxBufferLength the total number of bytes received, or the number of bytes written
+ *                            in the packet buffer.
+ * @param[in] xOutgoingPacket Whether this is an outgoing packet or not.
+ * @param[in] uxPayloadSumLength The number of trailing bytes that are included in
+ *                                'usPayloadSum', normally zero.
+ * @param[in] usPayloadSum The sum of those bytes.
+ * @param[in] pxMetadata The header offsets of a received packet, or NULL when
+ *                       the IP-header must be parsed.
+ *
+ * @return See usGenerateProtocolChecksum().
+ */
+static uint16_t prvGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
+                                             size_t uxBufferLength,
+                                             BaseType_t xOutgoingPacket,
+                                             size_t uxPayloadSumLength,
+                                             uint16_t usPayloadSum,
+                                             const PacketMetadata_t * pxMetadata )
 {
     struct xPacketSummary xSet;
 
     DEBUG_DECLARE_TRACE_VARIABLE( BaseType_t, xLocation, 0 );
 
     ( void ) memset( &( xSet ), 0, sizeof( xSet ) );
+    xSet.uxPayloadSumLength = uxPayloadSumLength;
+    xSet.usPayloadSum = usPayloadSum;
 
     #if ( ipconfigHAS_DEBUG_PRINTF != 0 )
     {
@@ -1101,33 +1619,45 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
         /* coverity[misra_c_2012_rule_11_3_violation] */
         xSet.pxIPPacket = ( ( const IPPacket_t * ) pucEthernetBuffer );
 
-        switch( xSet.pxIPPacket->xEthernetHeader.usFrameType ) /* LCOV_EXCL_BR_LINE */
+        #if ( ipconfigUSE_PACKET_METADATA != 0 )
+            if( pxMetadata != NULL )
+            {
+                /* The IP-header was parsed and checked when the packet was received. */
+                prvChecksumMetadataChecks( pucEthernetBuffer, pxMetadata, &( xSet ) );
+            }
+            else
+        #else
+            ( void ) pxMetadata;
+        #endif /* ( ipconfigUSE_PACKET_METADATA != 0 ) */
         {
-            #if ( ipconfigUSE_IPv4 != 0 )
-                case ipIPv4_FRAME_TYPE:
-                    xResult = prvChecksumIPv4Checks( pucEthernetBuffer, uxBufferLength, &( xSet ) );
+            switch( xSet.pxIPPacket->xEthernetHeader.usFrameType ) /* LCOV_EXCL_BR_LINE */
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    case ipIPv4_FRAME_TYPE:
+                        xResult = prvChecksumIPv4Checks( pucEthernetBuffer, uxBufferLength, &( xSet ) );
 
-                    break;
-            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+                        break;
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
-            #if ( ipconfigUSE_IPv6 != 0 )
-                case ipIPv6_FRAME_TYPE:
-                    /* MISRA Ref 11.3.1 [Misaligned access] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-                    /* coverity[misra_c_2012_rule_11_3_violation] */
-                    xSet.pxIPPacket_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    case ipIPv6_FRAME_TYPE:
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        xSet.pxIPPacket_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
 
-                    xResult = prvChecksumIPv6Checks( pucEthernetBuffer, uxBufferLength, &( xSet ) );
-                    break;
-            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+                        xResult = prvChecksumIPv6Checks( pucEthernetBuffer, uxBufferLength, &( xSet ) );
+                        break;
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
-            default:
-                /* MISRA 16.4 Compliance */
-                FreeRTOS_debug_printf( ( "usGenerateProtocolChecksum: Undefined usFrameType %d\n", xSet.pxIPPacket->xEthernetHeader.usFrameType ) );
+                default:
+                    /* MISRA 16.4 Compliance */
+                    FreeRTOS_debug_printf( ( "usGenerateProtocolChecksum: Undefined usFrameType %d\n", xSet.pxIPPacket->xEthernetHeader.usFrameType ) );
 
-                xSet.usChecksum = ipINVALID_LENGTH;
-                xResult = 1;
-                break;
+                    xSet.usChecksum = ipINVALID_LENGTH;
+                    xResult = 1;
+                    break;
+            }
         }
 
         if( xResult != 0 )
@@ -1258,12 +1788,14 @@ uint16_t usGenerateChecksum( uint16_t usSum,
 {
 /* MISRA/PC-lint doesn't like the use of unions. Here, they are a great
  * aid though to optimise the calculations. */
-    xUnion32_t xSum2;
+    #if ( ipconfigUSE_CHECKSUM_KERNEL == 0 )
+        xUnion32_t xSum2;
+        uint32_t ulCarry = 0U;
+    #endif
     xUnion32_t xSum;
     xUnion32_t xTerm;
     xUnionPtr_t xSource;
     uintptr_t uxAlignBits;
-    uint32_t ulCarry = 0U;
     uint16_t usTemp;
     size_t uxDataLengthBytes = uxByteCount;
     size_t uxSize;
@@ -1315,63 +1847,83 @@ uint16_t usGenerateChecksum( uint16_t usSum,
 
     /* Word (32-bit) aligned, do the most part. */
 
-    uxSize = ( size_t ) ( ( uxDataLengthBytes / 4U ) * 4U );
-
-    if( uxSize >= ( 3U * sizeof( uint32_t ) ) )
+    #if ( ipconfigUSE_CHECKSUM_KERNEL != 0 )
     {
-        uxSize -= ( 3U * sizeof( uint32_t ) );
-    }
-    else
-    {
-        uxSize = 0U;
-    }
+        /* Let the architecture-specific kernel add all 32-bit words. */
+        uxSize = uxDataLengthBytes / 4U;
 
-    /* In this loop, four 32-bit additions will be done, in total 16 bytes.
-     * Indexing with constants (0,1,2,3) gives faster code than using
-     * post-increments. */
-    for( ulX = 0U; ulX < uxSize; ulX += 4U * sizeof( uint32_t ) )
-    {
-        /* Use a secondary Sum2, just to see if the addition produced an
-         * overflow. */
-        xSum2.u32 = xSum.u32 + xSource.u32ptr[ 0 ];
-
-        if( xSum2.u32 < xSum.u32 )
+        if( uxSize > 0U )
         {
-            ulCarry++;
+            xSum.u32 = ulChecksumKernel( xSum.u32, xSource.u32ptr, uxSize );
+            xSource.u32ptr = &( xSource.u32ptr[ uxSize ] );
         }
 
-        /* Now add the secondary sum to the major sum, and remember if there was
-         * a carry. */
-        xSum.u32 = xSum2.u32 + xSource.u32ptr[ 1 ];
+        /* Fold the carries into the lower 16 bits. */
+        xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+
+        uxDataLengthBytes %= 4U;
+    }
+    #else /* if ( ipconfigUSE_CHECKSUM_KERNEL != 0 ) */
+    {
+        uxSize = ( size_t ) ( ( uxDataLengthBytes / 4U ) * 4U );
 
-        if( xSum2.u32 > xSum.u32 )
+        if( uxSize >= ( 3U * sizeof( uint32_t ) ) )
         {
-            ulCarry++;
+            uxSize -= ( 3U * sizeof( uint32_t ) );
         }
-
-        /* And do the same trick once again for indexes 2 and 3 */
-        xSum2.u32 = xSum.u32 + xSource.u32ptr[ 2 ];
-
-        if( xSum2.u32 < xSum.u32 )
+        else
         {
-            ulCarry++;
+            uxSize = 0U;
         }
 
-        xSum.u32 = xSum2.u32 + xSource.u32ptr[ 3 ];
-
-        if( xSum2.u32 > xSum.u32 )
+        /* In this loop, four 32-bit additions will be done, in total 16 bytes.
+         * Indexing with constants (0,1,2,3) gives faster code than using
+         * post-increments. */
+        for( ulX = 0U; ulX < uxSize; ulX += 4U * sizeof( uint32_t ) )
         {
-            ulCarry++;
-        }
+            /* Use a secondary Sum2, just to see if the addition produced an
+             * overflow. */
+            xSum2.u32 = xSum.u32 + xSource.u32ptr[ 0 ];
 
-        /* And finally advance the pointer 4 * 4 = 16 bytes. */
-        xSource.u32ptr = &( xSource.u32ptr[ 4 ] );
-    }
+            if( xSum2.u32 < xSum.u32 )
+            {
+                ulCarry++;
+            }
+
+            /* Now add the secondary sum to the major sum, and remember if there was
+             * a carry. */
+            xSum.u32 = xSum2.u32 + xSource.u32ptr[ 1 ];
+
+            if( xSum2.u32 > xSum.u32 )
+            {
+                ulCarry++;
+            }
+
+            /* And do the same trick once again for indexes 2 and 3 */
+            xSum2.u32 = xSum.u32 + xSource.u32ptr[ 2 ];
+
+            if( xSum2.u32 < xSum.u32 )
+            {
+                ulCarry++;
+            }
+
+            xSum.u32 = xSum2.u32 + xSource.u32ptr[ 3 ];
+
+            if( xSum2.u32 > xSum.u32 )
+            {
+                ulCarry++;
+            }
+
+            /* And finally advance the pointer 4 * 4 = 16 bytes. */
+            xSource.u32ptr = &( xSource.u32ptr[ 4 ] );
+        }
 
-    /* Now add all carries. */
-    xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ] + ulCarry;
+        /* Now add all carries. */
+        xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ] + ulCarry;
 
-    uxDataLengthBytes %= 16U;
+        uxDataLengthBytes %= 16U;
+    }
+    #endif /* if ( ipconfigUSE_CHECKSUM_KERNEL != 0 ) */
 
     /* Half-word aligned. */
     uxSize = ( ( uxDataLengthBytes & ~( ( size_t ) 1U ) ) );
@@ -1421,6 +1973,455 @@ uint16_t usGenerateChecksum( uint16_t usSum,
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Update a checksum after one 16-bit word of the checksummed data has
+ *        changed, as described in RFC 1624, equation 3:
+ *        HC' = ~( ~HC + ~m + m' ).
+ *        One's complement arithmetic does not depend on the byte order, so
+ *        the values can be passed as they are stored in the packet.
+ *
+ * @param[in] usChecksum The checksum field as found in the packet.
+ * @param[in] usOldWord The old value of the word that has changed.
+ * @param[in] usNewWord The new value of that word.
+ *
+ * @return The new value for the checksum field.
+ */
+uint16_t usIncrementalChecksum( uint16_t usChecksum,
+                                uint16_t usOldWord,
+                                uint16_t usNewWord )
+{
+    uint32_t ulSum;
+
+    ulSum = ( uint32_t ) ( ( uint16_t ) ~usChecksum ) +
+            ( uint32_t ) ( ( uint16_t ) ~usOldWord ) +
+            ( uint32_t ) usNewWord;
+
+    /* Fold the carries. */
+    ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+    ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+
+    return ( uint16_t ) ~ulSum;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipHEADER_CACHE != 0 )
+
+/** @brief Incremented each time the ARP or ND cache changes, or an end-point
+ *         goes up or down. */
+    volatile uint32_t ulIPHeaderCacheGeneration = 0U;
+
+/**
+ * @brief Drop the headers kept by connected UDP sockets and the ACK templates
+ *        of TCP sockets. Called by the IP-task when the ARP or ND cache
+ *        changes, or when an end-point goes up or down.
+ */
+    void vIPHeaderCacheInvalidate( void )
+    {
+        ulIPHeaderCacheGeneration++;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipHEADER_CACHE != 0 */
+
+#if ( ipconfigUSE_RESOURCE_STATS != 0 )
+
+/** @brief The resources that are counted by vIPResourceStatsHeap(). */
+    static IPResourceUsage_t xSocketUsage;
+    static IPResourceUsage_t xStreamUsage;
+    static IPResourceUsage_t xStackHeapUsage;
+
+/** @brief The occupation of the caches, as seen by FreeRTOS_GetResourceStats(). */
+    static IPResourceUsage_t xARPCacheUsage;
+    static IPResourceUsage_t xNDCacheUsage;
+    static IPResourceUsage_t xDNSCacheUsage;
+
+/** @brief The messages waiting in 'xNetworkEventQueue', only written by the IP-task. */
+    static IPResourceUsage_t xEventQueueUsage;
+
+/** @brief The number of times that each resource ran out, see vIPResourceStatsShortage(). */
+    static uint32_t ulResourceShortages[ eShortageMax ];
+
+/**
+ * @brief Add or subtract an amount from the use of a resource, and update its peak.
+ *
+ * @param[in] pxUsage The resource.
+ * @param[in] xAllocated pdTRUE when the amount was allocated, pdFALSE when it was released.
+ * @param[in] uxAmount The amount.
+ */
+    static void prvResourceCount( IPResourceUsage_t * pxUsage,
+                                  BaseType_t xAllocated,
+                                  size_t uxAmount )
+    {
+        if( xAllocated != pdFALSE )
+        {
+            pxUsage->uxUsed += uxAmount;
+        }
+        else if( pxUsage->uxUsed >= uxAmount )
+        {
+            pxUsage->uxUsed -= uxAmount;
+        }
+        else
+        {
+            /* Released before the statistics were enabled, should not happen. */
+            pxUsage->uxUsed = 0U;
+        }
+
+        if( pxUsage->uxPeak < pxUsage->uxUsed )
+        {
+            pxUsage->uxPeak = pxUsage->uxUsed;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Count an allocation or a release of heap by the stack.
+ *
+ * @param[in] eResource The kind of object that was allocated or released.
+ * @param[in] xAllocated pdTRUE when the object was allocated, pdFALSE when it was released.
+ * @param[in] uxBytes The size of the object.
+ */
+    void vIPResourceStatsHeap( eIPResource_t eResource,
+                               BaseType_t xAllocated,
+                               size_t uxBytes )
+    {
+        /* Sockets and streams are created and released by the API as well as
+         * by the IP-task. */
+        taskENTER_CRITICAL();
+        {
+            if( eResource == eResourceSocket )
+            {
+                prvResourceCount( &( xSocketUsage ), xAllocated, 1U );
+            }
+            else if( eResource == eResourceStream )
+            {
+                prvResourceCount( &( xStreamUsage ), xAllocated, uxBytes );
+            }
+            else
+            {
+                /* Only counted as heap. */
+            }
+
+            prvResourceCount( &( xStackHeapUsage ), xAllocated, uxBytes );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Count that a resource ran out.
+ *
+ * @param[in] eResource The resource.
+ */
+    void vIPResourceStatsShortage( eIPShortage_t eResource )
+    {
+        /* Network buffers are obtained by drivers and by the API as well. */
+        taskENTER_CRITICAL();
+        {
+            ulResourceShortages[ eResource ]++;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Update the peak of the event queue, called by the IP-task for
+ *        every event that it takes from the queue.
+ *
+ * @param[in] uxWaiting The number of events that were waiting, including the
+ *                      event that was just taken.
+ */
+    void vIPResourceStatsEventQueue( size_t uxWaiting )
+    {
+        xEventQueueUsage.uxUsed = uxWaiting;
+
+        if( xEventQueueUsage.uxPeak < uxWaiting )
+        {
+            xEventQueueUsage.uxPeak = uxWaiting;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Count the occupied rows of the caches, and update their peaks.
+ *        Must be called while the scheduler is suspended.
+ *
+ * @param[in] xResetPeak When true, the peaks are set to the current occupation.
+ */
+    static void prvResourceScanCaches( BaseType_t xResetPeak )
+    {
+        xARPCacheUsage.uxTotal = ( size_t ) ipconfigARP_CACHE_ENTRIES;
+        xARPCacheUsage.uxUsed = ( size_t ) uxARPCacheRowsInUse();
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+        {
+            xNDCacheUsage.uxTotal = ( size_t ) ipconfigND_CACHE_ENTRIES;
+            xNDCacheUsage.uxUsed = ( size_t ) uxNDCacheRowsInUse();
+        }
+        #endif
+
+        #if ( ( ipconfigUSE_DNS != 0 ) && ( ipconfigUSE_DNS_CACHE == 1 ) )
+        {
+            xDNSCacheUsage.uxTotal = ( size_t ) ipconfigDNS_CACHE_ENTRIES;
+            xDNSCacheUsage.uxUsed = ( size_t ) uxDNSCacheRowsInUse();
+        }
+        #endif
+
+        if( xResetPeak != pdFALSE )
+        {
+            xARPCacheUsage.uxPeak = 0U;
+            xNDCacheUsage.uxPeak = 0U;
+            xDNSCacheUsage.uxPeak = 0U;
+        }
+
+        prvResourceCount( &( xARPCacheUsage ), pdTRUE, 0U );
+        prvResourceCount( &( xNDCacheUsage ), pdTRUE, 0U );
+        prvResourceCount( &( xDNSCacheUsage ), pdTRUE, 0U );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the current and the peak use of the resources of the stack.
+ *        The peak of the network buffers is the low-water mark of the
+ *        buffer allocator, it is not reset by FreeRTOS_ClearResourceStats().
+ *        The peaks of the caches are the highest occupation seen by this
+ *        function.
+ *
+ * @param[out] pxStats Where the statistics will be written.
+ */
+    void FreeRTOS_GetResourceStats( IPResourceStats_t * pxStats )
+    {
+        const size_t uxBuffers = ( size_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS;
+
+        configASSERT( pxStats != NULL );
+
+        ( void ) memset( pxStats, 0, sizeof( *pxStats ) );
+
+        pxStats->xNetworkBuffers.uxTotal = uxBuffers;
+        pxStats->xNetworkBuffers.uxUsed = uxBuffers - ( size_t ) uxGetNumberOfFreeNetworkBuffers();
+        pxStats->xNetworkBuffers.uxPeak = uxBuffers - ( size_t ) uxGetMinimumFreeNetworkBuffers();
+
+        /* The IP-task cannot change the caches and the segment pool while
+         * they are being inspected. */
+        vTaskSuspendAll();
+        {
+            prvResourceScanCaches( pdFALSE );
+
+            #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_WIN == 1 ) )
+            {
+                vTCPWindowGetSegmentUsage( &( pxStats->xTCPSegments ), pdFALSE );
+            }
+            #endif
+
+            pxStats->xSockets = xSocketUsage;
+            pxStats->xStreamBytes = xStreamUsage;
+            pxStats->xStackHeap = xStackHeapUsage;
+            pxStats->xARPCache = xARPCacheUsage;
+            pxStats->xNDCache = xNDCacheUsage;
+            pxStats->xDNSCache = xDNSCacheUsage;
+            pxStats->xEventQueue = xEventQueueUsage;
+            pxStats->xEventQueue.uxTotal = ( size_t ) ipconfigEVENT_QUEUE_LENGTH;
+
+            if( xNetworkEventQueue != NULL )
+            {
+                pxStats->xEventQueue.uxUsed = ( size_t ) uxQueueMessagesWaiting( xNetworkEventQueue );
+            }
+
+            taskENTER_CRITICAL();
+            {
+                pxStats->xNetworkBuffers.ulShortages = ulResourceShortages[ eShortageNetworkBuffers ];
+                pxStats->xEventQueue.ulShortages = ulResourceShortages[ eShortageEventQueue ];
+                pxStats->xTCPSegments.ulShortages = ulResourceShortages[ eShortageTCPSegments ];
+                pxStats->xARPCache.ulShortages = ulResourceShortages[ eShortageARPCache ];
+                pxStats->xDNSCache.ulShortages = ulResourceShortages[ eShortageDNSCache ];
+            }
+            taskEXIT_CRITICAL();
+        }
+        ( void ) xTaskResumeAll();
+
+        pxStats->uxHeapFree = xPortGetFreeHeapSize();
+        pxStats->uxHeapMinimumEverFree = xPortGetMinimumEverFreeHeapSize();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Set the peaks of the resource statistics to the current use, e.g.
+ *        at the start of a test run.
+ */
+    void FreeRTOS_ClearResourceStats( void )
+    {
+        vTaskSuspendAll();
+        {
+            prvResourceScanCaches( pdTRUE );
+
+            #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_WIN == 1 ) )
+            {
+                IPResourceUsage_t xSegments;
+
+                vTCPWindowGetSegmentUsage( &( xSegments ), pdTRUE );
+            }
+            #endif
+
+            xSocketUsage.uxPeak = xSocketUsage.uxUsed;
+            xStreamUsage.uxPeak = xStreamUsage.uxUsed;
+            xStackHeapUsage.uxPeak = xStackHeapUsage.uxUsed;
+            xEventQueueUsage.uxPeak = xEventQueueUsage.uxUsed;
+
+            taskENTER_CRITICAL();
+            {
+                ( void ) memset( ulResourceShortages, 0, sizeof( ulResourceShortages ) );
+            }
+            taskEXIT_CRITICAL();
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the recommended size of a resource.  A resource that ran out
+ *        grows by half, otherwise its peak use plus a margin is taken.
+ *
+ * @param[in] pxUsage The use of the resource.
+ *
+ * @return The recommended size, at least 1.
+ */
+    static size_t prvRecommendSize( const IPResourceUsage_t * pxUsage )
+    {
+        size_t uxSize;
+
+        if( pxUsage->ulShortages != 0U )
+        {
+            /* The real demand is not known. */
+            uxSize = pxUsage->uxTotal + ( ( pxUsage->uxTotal + 1U ) / 2U );
+        }
+        else
+        {
+            uxSize = pxUsage->uxPeak + ( ( ( pxUsage->uxPeak * ( size_t ) ipconfigRESOURCE_STATS_HEADROOM ) + 99U ) / 100U );
+        }
+
+        if( uxSize == 0U )
+        {
+            uxSize = 1U;
+        }
+
+        return uxSize;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Append one recommended setting to the text of
+ *        FreeRTOS_GetRecommendedConfig().
+ *
+ * @param[in] pcBuffer The buffer for the text.
+ * @param[in] uxBufferLength The size of the buffer.
+ * @param[in] uxOffset The length of the text so far.
+ * @param[in] pcName The name of the configuration macro.
+ * @param[in] uxSize The recommended value.
+ * @param[in] pxUsage The observed use of the resource.
+ *
+ * @return The length of the text, which is truncated when the buffer is full.
+ */
+    static size_t prvAppendRecommendation( char * pcBuffer,
+                                           size_t uxBufferLength,
+                                           size_t uxOffset,
+                                           const char * pcName,
+                                           size_t uxSize,
+                                           const IPResourceUsage_t * pxUsage )
+    {
+        size_t uxLength = uxOffset;
+        int iResult;
+
+        if( uxOffset < uxBufferLength )
+        {
+            /* MISRA Ref 21.6.1 [snprintf and logging] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-216 */
+            /* coverity[misra_c_2012_rule_21_6_violation] */
+            iResult = snprintf( &( pcBuffer[ uxOffset ] ), uxBufferLength - uxOffset,
+                                "#define %-40s %lu /* peak %lu of %lu, %lu shortages */\n",
+                                pcName,
+                                ( unsigned long ) uxSize,
+                                ( unsigned long ) pxUsage->uxPeak,
+                                ( unsigned long ) pxUsage->uxTotal,
+                                ( unsigned long ) pxUsage->ulShortages );
+
+            if( iResult > 0 )
+            {
+                uxLength += ( size_t ) iResult;
+            }
+
+            if( uxLength >= uxBufferLength )
+            {
+                /* The text was truncated. */
+                uxLength = uxBufferLength - 1U;
+            }
+        }
+
+        return uxLength;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write the sizes of the resources that fit the observed workload as a
+ *        FreeRTOSIPConfig.h fragment, e.g. at the end of a test run. The
+ *        peaks of the caches are sampled when the statistics are read, so
+ *        call FreeRTOS_GetResourceStats() now and then during the run; their
+ *        shortages are counted when an entry is pushed out.
+ *
+ * @param[out] pcBuffer The buffer for the text, which is always terminated.
+ * @param[in] uxBufferLength The size of the buffer.
+ *
+ * @return The length of the text, excluding the terminating null.
+ */
+    size_t FreeRTOS_GetRecommendedConfig( char * pcBuffer,
+                                          size_t uxBufferLength )
+    {
+        IPResourceStats_t xStats;
+        size_t uxLength = 0U;
+        size_t uxBuffers;
+        size_t uxQueueLength;
+
+        if( ( pcBuffer != NULL ) && ( uxBufferLength > 0U ) )
+        {
+            pcBuffer[ 0 ] = '\0';
+            FreeRTOS_GetResourceStats( &( xStats ) );
+
+            uxBuffers = prvRecommendSize( &( xStats.xNetworkBuffers ) );
+            uxLength = prvAppendRecommendation( pcBuffer, uxBufferLength, uxLength, "ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS", uxBuffers, &( xStats.xNetworkBuffers ) );
+
+            /* FreeRTOSIPConfigDefaults.h demands some more events than buffers. */
+            uxQueueLength = prvRecommendSize( &( xStats.xEventQueue ) );
+
+            if( uxQueueLength < ( uxBuffers + 5U ) )
+            {
+                uxQueueLength = uxBuffers + 5U;
+            }
+
+            uxLength = prvAppendRecommendation( pcBuffer, uxBufferLength, uxLength, "ipconfigEVENT_QUEUE_LENGTH", uxQueueLength, &( xStats.xEventQueue ) );
+
+            #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_WIN == 1 ) )
+            {
+                uxLength = prvAppendRecommendation( pcBuffer, uxBufferLength, uxLength, "ipconfigTCP_WIN_SEG_COUNT", prvRecommendSize( &( xStats.xTCPSegments ) ), &( xStats.xTCPSegments ) );
+            }
+            #endif
+
+            #if ( ipconfigUSE_IPv4 != 0 )
+            {
+                uxLength = prvAppendRecommendation( pcBuffer, uxBufferLength, uxLength, "ipconfigARP_CACHE_ENTRIES", prvRecommendSize( &( xStats.xARPCache ) ), &( xStats.xARPCache ) );
+            }
+            #endif
+
+            #if ( ( ipconfigUSE_DNS != 0 ) && ( ipconfigUSE_DNS_CACHE == 1 ) )
+            {
+                uxLength = prvAppendRecommendation( pcBuffer, uxBufferLength, uxLength, "ipconfigDNS_CACHE_ENTRIES", prvRecommendSize( &( xStats.xDNSCache ) ), &( xStats.xDNSCache ) );
+            }
+            #endif
+        }
+
+        return uxLength;
+    }
+
+#endif /* ( ipconfigUSE_RESOURCE_STATS != 0 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ipconfigHAS_PRINTF != 0 )
 
     #ifndef ipMONITOR_MAX_HEAP
@@ -1787,3 +2788,830 @@ uint16_t usChar2u16( const uint8_t * pucPtr )
     /*-----------------------------------------------------------*/
 
 #endif /* ( ipconfigUSE_DHCPv6 == 1 ) || ( ipconfigUSE_DHCP == 1 ) */
+
+#if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+
+/**
+ * @brief Count an outgoing packet in the TX counters of an interface, in
+ *        total and for its protocols.
+ *
+ * @param[in] pxInterface The interface that will send the packet.
+ * @param[in] pxNetworkBuffer The packet.
+ */
+    static void prvCountTxPacket( NetworkInterface_t * pxInterface,
+                                  const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const EthernetHeader_t * pxEthernetHeader = ( ( const EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+        uint8_t ucProtocol = 0U;
+
+        #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+            size_t uxLength = uxNetworkBufferFrameLength( pxNetworkBuffer );
+        #else
+            size_t uxLength = pxNetworkBuffer->xDataLength;
+        #endif
+
+        ipCOUNT_TX( pxInterface, xTotal, uxLength );
+
+        switch( pxEthernetHeader->usFrameType )
+        {
+            case ipARP_FRAME_TYPE:
+                ipCOUNT_TX( pxInterface, xProtocols[ eCounterARP ], uxLength );
+                break;
+
+            case ipIPv4_FRAME_TYPE:
+                ipCOUNT_TX( pxInterface, xProtocols[ eCounterIPv4 ], uxLength );
+                ucProtocol = pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + offsetof( IPHeader_t, ucProtocol ) ];
+                break;
+
+            case ipIPv6_FRAME_TYPE:
+                ipCOUNT_TX( pxInterface, xProtocols[ eCounterIPv6 ], uxLength );
+                ucProtocol = pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + offsetof( IPHeader_IPv6_t, ucNextHeader ) ];
+                break;
+
+            default:
+                /* MISRA 16.4 Compliance */
+                break;
+        }
+
+        switch( ucProtocol )
+        {
+            case ipPROTOCOL_ICMP:
+            case ipPROTOCOL_ICMP_IPv6:
+                ipCOUNT_TX( pxInterface, xProtocols[ eCounterICMP ], uxLength );
+                break;
+
+            case ipPROTOCOL_UDP:
+                ipCOUNT_TX( pxInterface, xProtocols[ eCounterUDP ], uxLength );
+                break;
+
+            case ipPROTOCOL_TCP:
+                ipCOUNT_TX( pxInterface, xProtocols[ eCounterTCP ], uxLength );
+                break;
+
+            default:
+                /* MISRA 16.4 Compliance */
+                break;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_NETWORK_COUNTERS */
+
+#if ( ipconfigUSE_UDP_DIRECT_TX != 0 ) || ( ipconfigUSE_SCATTER_GATHER != 0 ) || ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 ) || ( ipconfigUSE_NETWORK_COUNTERS != 0 ) || ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 ) || ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
+    #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
+/**
+ * @brief The driver of an interface has no room for a frame.  Hold on to the
+ *        frame when it is the first one, it will be sent by
+ *        vIPInterfaceTxReady().  Later frames are dropped.
+ *
+ * @param[in] pxInterface The busy interface.
+ * @param[in] pxNetworkBuffer The frame that was refused.
+ * @param[in] xReleaseAfterSend pdTRUE when the frame belongs to the driver.
+ *
+ * @return pdPASS when the frame is held, ipTX_BUSY when the caller still owns
+ *         it, or pdFAIL when it was dropped.
+ */
+        static BaseType_t prvInterfaceTxBusy( NetworkInterface_t * pxInterface,
+                                              NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                              BaseType_t xReleaseAfterSend )
+        {
+            BaseType_t xReturn;
+
+            pxInterface->xTxBusy = pdTRUE;
+
+            if( xReleaseAfterSend == pdFALSE )
+            {
+                /* The caller keeps its buffer. */
+                xReturn = ipTX_BUSY;
+            }
+            else if( pxInterface->pxTxHeld == NULL )
+            {
+                pxInterface->pxTxHeld = pxNetworkBuffer;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+                xReturn = pdFAIL;
+
+                #if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+                {
+                    pxInterface->xCounters.ulTxErrors++;
+                }
+                #endif
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TX_BACKPRESSURE */
+
+/**
+ * @brief Call the output function of an interface, and count the packet when
+ *        ipconfigUSE_NETWORK_COUNTERS is enabled.
+ *
+ * @param[in] pxInterface The interface that will send the packet.
+ * @param[in] pxNetworkBuffer The packet.
+ * @param[in] xReleaseAfterSend pdTRUE when the driver must release the buffer.
+ *
+ * @return The value returned by pfOutput().
+ */
+    static BaseType_t prvInterfaceOutput( NetworkInterface_t * pxInterface,
+                                          NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                          BaseType_t xReleaseAfterSend )
+    {
+        BaseType_t xReturn;
+
+        #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+            if( pxInterface->xTxBusy != pdFALSE )
+            {
+                /* Do not bother the driver until it has room again. */
+                xReturn = ipTX_BUSY;
+            }
+            else
+        #endif /* ipconfigUSE_TX_BACKPRESSURE */
+        {
+            #if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+            {
+                /* Count before sending, the driver may release the buffer. */
+                prvCountTxPacket( pxInterface, pxNetworkBuffer );
+            }
+            #endif
+
+            xReturn = pxInterface->pfOutput( pxInterface, pxNetworkBuffer, xReleaseAfterSend );
+
+            #if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+            {
+                if( xReturn == pdFAIL )
+                {
+                    pxInterface->xCounters.ulTxErrors++;
+                }
+            }
+            #endif
+        }
+
+        #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+        {
+            if( xReturn == ipTX_BUSY )
+            {
+                xReturn = prvInterfaceTxBusy( pxInterface, pxNetworkBuffer, xReleaseAfterSend );
+            }
+        }
+        #endif
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Call prvInterfaceOutput() while holding the interface mutex, when
+ *        the interface has one.
+ *
+ * @param[in] pxInterface The interface that will send the packet.
+ * @param[in] pxNetworkBuffer The packet, it is not segmented.
+ * @param[in] xReleaseAfterSend pdTRUE when the driver must release the buffer.
+ *
+ * @return The value returned by pfOutput().
+ */
+    static BaseType_t prvInterfaceSend( NetworkInterface_t * pxInterface,
+                                        NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                        BaseType_t xReleaseAfterSend )
+    {
+        BaseType_t xReturn;
+
+        #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+            if( pxInterface->xTxMutex != NULL )
+            {
+                ( void ) xSemaphoreTake( pxInterface->xTxMutex, portMAX_DELAY );
+                xReturn = prvInterfaceOutput( pxInterface, pxNetworkBuffer, xReleaseAfterSend );
+                ( void ) xSemaphoreGive( pxInterface->xTxMutex );
+            }
+            else
+        #endif /* ipconfigUSE_UDP_DIRECT_TX */
+        {
+            xReturn = prvInterfaceOutput( pxInterface, pxNetworkBuffer, xReleaseAfterSend );
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+
+/**
+ * @brief A frame that waits in a transmit priority queue.
+ */
+        typedef struct xTX_QUEUE_ITEM
+        {
+            NetworkInterface_t * pxInterface;     /**< The interface that will send the frame. */
+            NetworkBufferDescriptor_t * pxBuffer; /**< The frame, it will be released by the driver. */
+        } TxQueueItem_t;
+
+/** @brief One FIFO for each priority class, only accessed by the IP-task. */
+        static TxQueueItem_t xTxQueue[ ipconfigTX_PRIORITY_CLASSES ][ ipconfigTX_PRIORITY_QUEUE_LENGTH ];
+
+/** @brief The number of frames in each of the FIFO's. */
+        static UBaseType_t uxTxQueueCount[ ipconfigTX_PRIORITY_CLASSES ];
+
+/**
+ * @brief Find the priority class of an outgoing frame, from the DSCP in its
+ *        IP header.  ARP and other non-IP frames get the highest class.
+ *
+ * @param[in] pxNetworkBuffer The frame.
+ *
+ * @return The class, 0 is the lowest, ipconfigTX_PRIORITY_CLASSES - 1 the
+ *         highest.
+ */
+        UBaseType_t uxIPTxPriorityClass( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            UBaseType_t uxClass = ( UBaseType_t ) ipconfigTX_PRIORITY_CLASSES - 1U;
+            size_t uxOffset = ipSIZE_OF_ETH_HEADER;
+            uint16_t usFrameType;
+            uint8_t ucTrafficClass = 0U;
+            BaseType_t xIsIP = pdTRUE;
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            usFrameType = ( ( const EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer )->usFrameType;
+
+            #if ( ipconfigUSE_VLAN != 0 )
+                if( usFrameType == ipVLAN_FRAME_TYPE )
+                {
+                    /* A tag was inserted already, the frame type follows it. */
+                    ( void ) memcpy( &( usFrameType ), &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + 2U ] ), sizeof( usFrameType ) );
+                    uxOffset += 4U;
+                }
+            #endif
+
+            if( pxNetworkBuffer->xDataLength < ( uxOffset + 2U ) )
+            {
+                xIsIP = pdFALSE;
+            }
+            else if( usFrameType == ipIPv4_FRAME_TYPE )
+            {
+                ucTrafficClass = pxNetworkBuffer->pucEthernetBuffer[ uxOffset + 1U ];
+            }
+            else if( usFrameType == ipIPv6_FRAME_TYPE )
+            {
+                ucTrafficClass = ( uint8_t ) ( ( ( uint32_t ) pxNetworkBuffer->pucEthernetBuffer[ uxOffset ] << 4 ) |
+                                               ( ( uint32_t ) pxNetworkBuffer->pucEthernetBuffer[ uxOffset + 1U ] >> 4 ) );
+            }
+            else
+            {
+                xIsIP = pdFALSE;
+            }
+
+            if( xIsIP != pdFALSE )
+            {
+                /* Use the 3 class-selector bits of the DSCP. */
+                uxClass = ( ( ( UBaseType_t ) ucTrafficClass >> ( ipDSCP_SHIFT + 3U ) ) * ( UBaseType_t ) ipconfigTX_PRIORITY_CLASSES ) / 8U;
+            }
+
+            return uxClass;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Queue a frame in the FIFO of its priority class.  When that FIFO is
+ *        full, all queued frames are sent first.
+ *
+ * @param[in] pxInterface The interface that will send the frame.
+ * @param[in] pxNetworkBuffer The frame, it will be released by the driver.
+ */
+        static void prvTxQueueAdd( NetworkInterface_t * pxInterface,
+                                   NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            UBaseType_t uxClass = uxIPTxPriorityClass( pxNetworkBuffer );
+
+            if( uxTxQueueCount[ uxClass ] >= ( UBaseType_t ) ipconfigTX_PRIORITY_QUEUE_LENGTH )
+            {
+                vIPTxQueueFlush();
+            }
+
+            xTxQueue[ uxClass ][ uxTxQueueCount[ uxClass ] ].pxInterface = pxInterface;
+            xTxQueue[ uxClass ][ uxTxQueueCount[ uxClass ] ].pxBuffer = pxNetworkBuffer;
+            uxTxQueueCount[ uxClass ]++;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Pass all frames in the transmit priority queues to their drivers,
+ *        the highest class first.  Only to be called by the IP-task.
+ */
+        void vIPTxQueueFlush( void )
+        {
+            UBaseType_t uxClass = ( UBaseType_t ) ipconfigTX_PRIORITY_CLASSES;
+            UBaseType_t uxIndex;
+
+            while( uxClass > 0U )
+            {
+                uxClass--;
+
+                for( uxIndex = 0U; uxIndex < uxTxQueueCount[ uxClass ]; uxIndex++ )
+                {
+                    ( void ) prvInterfaceSend( xTxQueue[ uxClass ][ uxIndex ].pxInterface,
+                                               xTxQueue[ uxClass ][ uxIndex ].pxBuffer,
+                                               pdTRUE );
+                }
+
+                uxTxQueueCount[ uxClass ] = 0U;
+            }
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 ) */
+
+/**
+ * @brief Pass a packet to the driver of an interface. The interface mutex is
+ *        held during the call, because connected UDP sockets may call
+ *        pfOutput() from another task than the IP-task. A packet with
+ *        segments is copied into a single buffer first, unless the driver
+ *        can send segments.
+ *
+ * @param[in] pxInterface The interface that will send the packet.
+ * @param[in] pxNetworkBuffer The packet.
+ * @param[in] xReleaseAfterSend pdTRUE when the driver must release the buffer.
+ *
+ * @return The value returned by pfOutput(), or pdFAIL when the packet could
+ *         not be copied.
+ */
+    BaseType_t xIPInterfaceOutput( NetworkInterface_t * pxInterface,
+                                   NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                   BaseType_t xReleaseAfterSend )
+    {
+        BaseType_t xReturn = pdFAIL;
+        NetworkBufferDescriptor_t * pxBuffer = pxNetworkBuffer;
+        BaseType_t xRelease = xReleaseAfterSend;
+
+        #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+        {
+            if( ( pxNetworkBuffer->pxSegments != NULL ) &&
+                ( pxInterface->bits.bScatterGather == pdFALSE_UNSIGNED ) )
+            {
+                pxBuffer = pxNetworkBufferLinearise( pxNetworkBuffer );
+
+                if( xReleaseAfterSend != pdFALSE )
+                {
+                    vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+                }
+
+                /* The copy belongs to the driver. */
+                xRelease = pdTRUE;
+            }
+        }
+        #endif /* ipconfigUSE_SCATTER_GATHER */
+
+        if( pxBuffer != NULL )
+        {
+            #if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 )
+            {
+                /* The stack has written the frame, it must be cleaned
+                 * before the DMA reads it. */
+                pxBuffer->xCacheCleanNeeded = pdTRUE;
+            }
+            #endif
+
+            #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+                if( ( xRelease != pdFALSE ) && ( xIsCallingFromIPTask() != pdFALSE ) )
+                {
+                    /* The driver will see it when the IP-task runs out of work. */
+                    prvTxQueueAdd( pxInterface, pxBuffer );
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    if( xIsCallingFromIPTask() != pdFALSE )
+                    {
+                        /* Keep the order of the frames that were queued. */
+                        vIPTxQueueFlush();
+                    }
+
+                    xReturn = prvInterfaceSend( pxInterface, pxBuffer, xRelease );
+                }
+            #else /* if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 ) */
+                xReturn = prvInterfaceSend( pxInterface, pxBuffer, xRelease );
+            #endif /* if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 ) */
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
+/**
+ * @brief The driver of an interface has room again: send the frame that was
+ *        held back, and let the paused TCP sockets continue.  Only to be
+ *        called by the IP-task.
+ *
+ * @param[in] pxInterface The interface that called FreeRTOS_NetworkInterfaceTxReady().
+ */
+        void vIPInterfaceTxReady( NetworkInterface_t * pxInterface )
+        {
+            NetworkBufferDescriptor_t * pxHeld;
+
+            #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+            {
+                if( pxInterface->xTxMutex != NULL )
+                {
+                    ( void ) xSemaphoreTake( pxInterface->xTxMutex, portMAX_DELAY );
+                }
+            }
+            #endif
+
+            pxInterface->xTxBusy = pdFALSE;
+            pxHeld = pxInterface->pxTxHeld;
+            pxInterface->pxTxHeld = NULL;
+
+            if( pxHeld != NULL )
+            {
+                /* This frame was refused first, so it goes out first.  It
+                 * may be held again when the ring filled up meanwhile. */
+                ( void ) prvInterfaceOutput( pxInterface, pxHeld, pdTRUE );
+            }
+
+            #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+            {
+                if( pxInterface->xTxMutex != NULL )
+                {
+                    ( void ) xSemaphoreGive( pxInterface->xTxMutex );
+                }
+            }
+            #endif
+
+            #if ( ipconfigUSE_TCP == 1 )
+            {
+                if( pxInterface->xTxBusy == pdFALSE )
+                {
+                    vTCPResumeTxPaused();
+                }
+            }
+            #endif
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TX_BACKPRESSURE */
+
+#endif /* ( ipconfigUSE_UDP_DIRECT_TX != 0 ) || ( ipconfigUSE_SCATTER_GATHER != 0 ) || ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 ) || ( ipconfigUSE_NETWORK_COUNTERS != 0 ) || ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 ) || ( ipconfigUSE_TX_BACKPRESSURE != 0 ) */
+
+#if ( ipconfigUSE_SCATTER_GATHER != 0 )
+
+/**
+ * @brief Add a segment to the end of the frame in a network buffer.
+ *
+ * @param[in] pxNetworkBuffer The network buffer.
+ * @param[in] pxSegment The segment, its 'pxNext' field will be cleared.
+ */
+    void vNetworkBufferAppendSegment( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                      NetworkBufferSegment_t * pxSegment )
+    {
+        NetworkBufferSegment_t ** ppxLast = &( pxNetworkBuffer->pxSegments );
+
+        while( *ppxLast != NULL )
+        {
+            ppxLast = &( ( *ppxLast )->pxNext );
+        }
+
+        pxSegment->pxNext = NULL;
+        *ppxLast = pxSegment;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the length of a frame: the bytes in 'pucEthernetBuffer' plus
+ *        the lengths of all segments.
+ *
+ * @param[in] pxNetworkBuffer The network buffer.
+ *
+ * @return The length of the frame in bytes.
+ */
+    size_t uxNetworkBufferFrameLength( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        size_t uxLength = pxNetworkBuffer->xDataLength;
+        const NetworkBufferSegment_t * pxSegment;
+
+        for( pxSegment = pxNetworkBuffer->pxSegments; pxSegment != NULL; pxSegment = pxSegment->pxNext )
+        {
+            uxLength += pxSegment->uxLength;
+        }
+
+        return uxLength;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Copy a frame with segments into a new network buffer, for a driver
+ *        that can only send contiguous frames. The original buffer and its
+ *        segments are not changed.
+ *
+ * @param[in] pxNetworkBuffer The network buffer with segments.
+ *
+ * @return The new network buffer, or NULL when no buffer was available.
+ */
+    NetworkBufferDescriptor_t * pxNetworkBufferLinearise( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkBufferDescriptor_t * pxNewBuffer;
+        const NetworkBufferSegment_t * pxSegment;
+        size_t uxOffset = pxNetworkBuffer->xDataLength;
+
+        pxNewBuffer = pxDuplicateNetworkBufferWithDescriptor( pxNetworkBuffer, uxNetworkBufferFrameLength( pxNetworkBuffer ) );
+
+        if( pxNewBuffer != NULL )
+        {
+            for( pxSegment = pxNetworkBuffer->pxSegments; pxSegment != NULL; pxSegment = pxSegment->pxNext )
+            {
+                ( void ) memcpy( &( pxNewBuffer->pucEthernetBuffer[ uxOffset ] ), pxSegment->pucData, pxSegment->uxLength );
+                uxOffset += pxSegment->uxLength;
+            }
+        }
+        else
+        {
+            FreeRTOS_debug_printf( ( "pxNetworkBufferLinearise: no buffer for %u bytes\n",
+                                     ( unsigned ) uxNetworkBufferFrameLength( pxNetworkBuffer ) ) );
+        }
+
+        return pxNewBuffer;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Hand back the segments of a network buffer by calling their release
+ *        functions. Called by vReleaseNetworkBufferAndDescriptor(), so it may
+ *        run in the context of the network driver.
+ *
+ * @param[in] pxNetworkBuffer The network buffer that is being released.
+ */
+    void vNetworkBufferReleaseSegments( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkBufferSegment_t * pxSegment = pxNetworkBuffer->pxSegments;
+
+        pxNetworkBuffer->pxSegments = NULL;
+
+        while( pxSegment != NULL )
+        {
+            /* Read the link before the segment is handed back. */
+            NetworkBufferSegment_t * pxNext = pxSegment->pxNext;
+
+            if( pxSegment->pfRelease != NULL )
+            {
+                pxSegment->pfRelease( pxSegment );
+            }
+
+            pxSegment = pxNext;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_SCATTER_GATHER != 0 ) */
+
+#if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+
+/**
+ * @brief Add an owner to a network buffer. Every owner releases the buffer
+ *        with vReleaseNetworkBufferAndDescriptor(). As long as there is more
+ *        than one owner, the contents must not be changed.
+ *
+ * @param[in] pxNetworkBuffer The network buffer to be shared.
+ *
+ * @return The same network buffer.
+ */
+    NetworkBufferDescriptor_t * pxNetworkBufferAddReference( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        taskENTER_CRITICAL();
+        {
+            pxNetworkBuffer->uxExtraReferences++;
+        }
+        taskEXIT_CRITICAL();
+
+        return pxNetworkBuffer;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove an owner from a network buffer. Called by
+ *        vReleaseNetworkBufferAndDescriptor().
+ *
+ * @param[in] pxNetworkBuffer The network buffer that is being released.
+ *
+ * @return pdTRUE when the caller was the last owner, and the buffer must be
+ *         returned to the pool, otherwise pdFALSE.
+ */
+    BaseType_t xNetworkBufferDropReference( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xLastReference = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            if( pxNetworkBuffer->uxExtraReferences == 0U )
+            {
+                xLastReference = pdTRUE;
+            }
+            else
+            {
+                pxNetworkBuffer->uxExtraReferences--;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xLastReference;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove an owner from a network buffer, from within an ISR.
+ *
+ * @param[in] pxNetworkBuffer The network buffer that is being released.
+ *
+ * @return pdTRUE when the caller was the last owner, otherwise pdFALSE.
+ */
+    BaseType_t xNetworkBufferDropReferenceFromISR( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xLastReference = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( pxNetworkBuffer->uxExtraReferences == 0U )
+            {
+                xLastReference = pdTRUE;
+            }
+            else
+            {
+                pxNetworkBuffer->uxExtraReferences--;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return xLastReference;
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 ) */
+
+#if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 )
+
+/**
+ * @brief Lay out a pool of network buffers in cached memory, so that every
+ *        buffer starts on a cache line and no two buffers share a line.
+ *        Called from vNetworkInterfaceAllocateRAMToBuffers().
+ *
+ * @param[in] pxNetworkBuffers The descriptors of BufferAllocation_1.c.
+ * @param[in] pucRAM Memory that is aligned to a cache line, and holds
+ *                   ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS times
+ *                   ipNETWORK_BUFFER_CACHE_ALIGN( uxBufferSize ) bytes.
+ * @param[in] uxBufferSize The size of a buffer, including ipBUFFER_PADDING.
+ */
+    void vNetworkBuffersAssignCacheAligned( NetworkBufferDescriptor_t pxNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ],
+                                            uint8_t * pucRAM,
+                                            size_t uxBufferSize )
+    {
+        uint8_t * pucBlock = pucRAM;
+        size_t uxStride = ipNETWORK_BUFFER_CACHE_ALIGN( uxBufferSize );
+        size_t uxIndex;
+
+        configASSERT( ( void_ptr_to_uintptr( pucRAM ) & ( ( uintptr_t ) ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE - 1U ) ) == 0U );
+        configASSERT( uxBufferSize > ipBUFFER_PADDING );
+
+        for( uxIndex = 0U; uxIndex < ( size_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS; uxIndex++ )
+        {
+            /* The padding holds a pointer back to the descriptor. */
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            *( ( NetworkBufferDescriptor_t ** ) pucBlock ) = &( pxNetworkBuffers[ uxIndex ] );
+            pxNetworkBuffers[ uxIndex ].pucEthernetBuffer = &( pucBlock[ ipBUFFER_PADDING ] );
+            pxNetworkBuffers[ uxIndex ].xCacheCleanNeeded = pdFALSE;
+
+            pucBlock = &( pucBlock[ uxStride ] );
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Clean the data cache of a frame before the DMA reads it. Nothing
+ *        is done when the frame has been cleaned since the stack passed the
+ *        buffer to the driver, e.g. when the driver sends it again.
+ *
+ * @param[in] pxNetworkBuffer The buffer that is about to be sent.
+ */
+    void vNetworkBufferCacheClean( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        uint8_t * pucFrame = pxNetworkBuffer->pucEthernetBuffer;
+        size_t uxHead;
+
+        if( pxNetworkBuffer->xCacheCleanNeeded != pdFALSE )
+        {
+            /* The buffer owns the whole cache lines around the frame. */
+            uxHead = ( size_t ) ( void_ptr_to_uintptr( pucFrame ) & ( ( uintptr_t ) ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE - 1U ) );
+
+            /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+            /* coverity[misra_c_2012_rule_18_4_violation] */
+            ipconfigDCACHE_CLEAN( pucFrame - uxHead, ipNETWORK_BUFFER_CACHE_ALIGN( uxHead + pxNetworkBuffer->xDataLength ) );
+            pxNetworkBuffer->xCacheCleanNeeded = pdFALSE;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Invalidate the data cache of a frame. Called before a buffer is
+ *        given to the DMA for reception, and again before the CPU reads the
+ *        received packet.
+ *
+ * @param[in] pxNetworkBuffer The buffer that receives a packet.
+ * @param[in] uxLength The number of bytes that the DMA may write.
+ */
+    void vNetworkBufferCacheInvalidate( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                        size_t uxLength )
+    {
+        uint8_t * pucFrame = pxNetworkBuffer->pucEthernetBuffer;
+        size_t uxHead = ( size_t ) ( void_ptr_to_uintptr( pucFrame ) & ( ( uintptr_t ) ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE - 1U ) );
+
+        /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+        /* coverity[misra_c_2012_rule_18_4_violation] */
+        ipconfigDCACHE_INVALIDATE( pucFrame - uxHead, ipNETWORK_BUFFER_CACHE_ALIGN( uxHead + uxLength ) );
+
+        /* Data that the CPU wrote earlier is gone. */
+        pxNetworkBuffer->xCacheCleanNeeded = pdFALSE;
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 ) */
+
+#if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+
+/**
+ * @brief Check whether the checksums of a received packet must be verified
+ *        in software.
+ *
+ * @param[in] pxNetworkBuffer The received packet.
+ *
+ * @return pdFALSE when the driver has set ipBUFFER_CHECKSUM_VERIFIED, or when
+ *         the interface verifies all checksums, otherwise pdTRUE.
+ */
+    BaseType_t xIPRxChecksumInSoftware( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xReturn = pdTRUE;
+
+        if( ( pxNetworkBuffer->ucChecksumFlags & ipBUFFER_CHECKSUM_VERIFIED ) != 0U )
+        {
+            xReturn = pdFALSE;
+        }
+        else if( ( pxNetworkBuffer->pxInterface != NULL ) &&
+                 ( pxNetworkBuffer->pxInterface->bits.bRxChecksumOffload != pdFALSE_UNSIGNED ) )
+        {
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            /* The checksums have not been checked yet. */
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Check whether the checksums of an outgoing packet must be calculated
+ *        in software. If not, ipBUFFER_CHECKSUM_NEEDED is set in the buffer,
+ *        so the driver knows that the hardware must insert them.
+ *
+ * @param[in] pxNetworkBuffer The packet, its end-point must be known.
+ *
+ * @return pdFALSE when the interface of the end-point inserts the checksums,
+ *         otherwise pdTRUE.
+ */
+    BaseType_t xIPTxChecksumInSoftware( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xReturn = pdTRUE;
+        const NetworkInterface_t * pxInterface = NULL;
+
+        if( pxNetworkBuffer->pxEndPoint != NULL )
+        {
+            pxInterface = pxNetworkBuffer->pxEndPoint->pxNetworkInterface;
+        }
+
+        if( ( pxInterface != NULL ) && ( pxInterface->bits.bTxChecksumOffload != pdFALSE_UNSIGNED ) )
+        {
+            pxNetworkBuffer->ucChecksumFlags |= ( uint8_t ) ipBUFFER_CHECKSUM_NEEDED;
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            pxNetworkBuffer->ucChecksumFlags &= ( uint8_t ) ~ipBUFFER_CHECKSUM_NEEDED;
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) */
@@ -41,6 +41,8 @@
 /* FreeRTOS+TCP includes. */
 #include "FreeRTOS_IP.h"
 #include "FreeRTOS_IPv4.h"
+#include "FreeRTOS_ARP.h"
+#include "FreeRTOS_NAPT.h"
 
 /* IPv4 multi-cast addresses range from 224.0.0.0.0 to 240.0.0.0. */
 #define ipFIRST_MULTI_CAST_IPv4    0xE0000000U          /**< Lower bound of the IPv4 multicast address. */
@@ -51,14 +53,18 @@
     #if( ipconfigUSE_IPv4 != 0 )
 /* *INDENT-ON* */
 
-#if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 )
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) )
     /* Check IPv4 packet length. */
     static BaseType_t xCheckIPv4SizeFields( const void * const pvEthernetBuffer,
                                             size_t uxBufferLength );
-#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
 
+    /* Check a packet of which the checksums have been verified by the driver. */
+    static eFrameProcessingResult_t prvAllowVerifiedIPv4( const IPPacket_t * const pxIPPacket,
+                                                          const NetworkBufferDescriptor_t * const pxNetworkBuffer );
+#endif /* ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) ) */
 
-#if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 )
+
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) )
 
 /**
  * @brief Check IPv4 packet length.
@@ -161,7 +167,7 @@
             uxLength -= ( ( uint16_t ) uxIPHeaderLength ); /* normally, minus 20. */
 
             if( ( uxLength < ( ( size_t ) sizeof( UDPHeader_t ) ) ) ||
-                ( uxLength > ( ( size_t ) ipconfigNETWORK_MTU - ( size_t ) uxIPHeaderLength ) ) )
+                ( uxLength > ( ipMAX_IP_PACKET_SIZE - ( size_t ) uxIPHeaderLength ) ) )
             {
                 /* For incoming packets, the length is out of bound: either
                  * too short or too long. For outgoing packets, there is a
@@ -182,7 +188,86 @@
         return xResult;
     }
 
-#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check a packet of which the IP and protocol checksums have been
+ *        verified by the network interface. Only the length fields are
+ *        checked, and UDP packets without a checksum are dropped, unless
+ *        ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS is enabled.
+ *
+ * @param[in] pxIPPacket The IP packet.
+ * @param[in] pxNetworkBuffer The network buffer that contains the packet.
+ *
+ * @return eProcessBuffer when the packet may be processed, otherwise
+ *         eReleaseBuffer.
+ */
+    static eFrameProcessingResult_t prvAllowVerifiedIPv4( const IPPacket_t * const pxIPPacket,
+                                                          const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        eFrameProcessingResult_t eReturn = eProcessBuffer;
+
+        if( xCheckIPv4SizeFields( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength ) != pdPASS )
+        {
+            /* Some of the length checks were not successful. */
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
+            eReturn = eReleaseBuffer;
+        }
+
+        #if ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 )
+        {
+            /* Check if this is a UDP packet without a checksum. */
+            if( eReturn == eProcessBuffer )
+            {
+                uint8_t ucProtocol;
+                const ProtocolHeaders_t * pxProtocolHeaders;
+
+                /* ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS is defined as 0,
+                 * and so UDP packets carrying a protocol checksum of 0, will
+                 * be dropped. */
+                ucProtocol = pxIPPacket->xIPHeader.ucProtocol;
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxProtocolHeaders = ( ( ProtocolHeaders_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ( size_t ) ipSIZE_OF_IPv4_HEADER ] ) );
+
+                /* Identify the next protocol. */
+                if( ucProtocol == ( uint8_t ) ipPROTOCOL_UDP )
+                {
+                    if( pxProtocolHeaders->xUDPHeader.usChecksum == ( uint16_t ) 0U )
+                    {
+                        #if ( ipconfigHAS_PRINTF != 0 )
+                        {
+                            static BaseType_t xCount = 0;
+
+                            /* Exclude this from branch coverage as this is only used for debugging. */
+                            if( xCount < 5 ) /* LCOV_EXCL_BR_LINE */
+                            {
+                                FreeRTOS_printf( ( "prvAllowIPPacket: UDP packet from %xip without CRC dropped\n",
+                                                   FreeRTOS_ntohl( pxIPPacket->xIPHeader.ulSourceIPAddress ) ) );
+                                xCount++;
+                            }
+                        }
+                        #endif /* ( ipconfigHAS_PRINTF != 0 ) */
+
+                        /* Protocol checksum not accepted. */
+                        ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropChecksum );
+                        eReturn = eReleaseBuffer;
+                    }
+                }
+            }
+        }
+        #else /* if ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 ) */
+        {
+            /* to avoid warning unused parameters */
+            ( void ) pxIPPacket;
+        }
+        #endif /* ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 ) */
+
+        return eReturn;
+    }
+
+#endif /* ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) ) */
 /*-----------------------------------------------------------*/
 
 /**
@@ -272,7 +357,10 @@ enum eFrameProcessingResult prvAllowIPPacketIPv4( const struct xIP_PACKET * cons
     eFrameProcessingResult_t eReturn = eProcessBuffer;
 
     #if ( ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 0 ) || ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 ) )
-        const IPHeader_t * pxIPHeader = &( pxIPPacket->xIPHeader );
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPHeaderView_t * pxIPHeader = ( ( const IPHeaderView_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
     #else
 
         /* or else, the parameter won't be used and the function will be optimised
@@ -361,6 +449,11 @@ enum eFrameProcessingResult prvAllowIPPacketIPv4( const struct xIP_PACKET * cons
             /* Packet is not fragmented, destination is this device, source IP and MAC
              * addresses are correct. */
         }
+
+        if( eReturn == eReleaseBuffer )
+        {
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropFiltered );
+        }
     }
     #endif /* ipconfigETHERNET_DRIVER_FILTERS_PACKETS */
 
@@ -372,8 +465,17 @@ enum eFrameProcessingResult prvAllowIPPacketIPv4( const struct xIP_PACKET * cons
         {
             const NetworkEndPoint_t * pxEndPoint = FreeRTOS_FindEndPointOnMAC( &( pxIPPacket->xEthernetHeader.xSourceAddress ), NULL );
 
+            if( ipRX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) == pdFALSE )
+            {
+                #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+                {
+                    /* The interface or the driver has verified the checksums. */
+                    eReturn = prvAllowVerifiedIPv4( pxIPPacket, pxNetworkBuffer );
+                }
+                #endif
+            }
             /* Do not check the checksum of loop-back messages. */
-            if( pxEndPoint == NULL )
+            else if( pxEndPoint == NULL )
             {
                 /* Is the IP header checksum correct?
                  *
@@ -386,12 +488,14 @@ enum eFrameProcessingResult prvAllowIPPacketIPv4( const struct xIP_PACKET * cons
                 if( usGenerateChecksum( 0U, ( const uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ( size_t ) uxHeaderLength ) != ipCORRECT_CRC )
                 {
                     /* Check sum in IP-header not correct. */
+                    ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropChecksum );
                     eReturn = eReleaseBuffer;
                 }
                 /* Is the upper-layer checksum (TCP/UDP/ICMP) correct? */
-                else if( usGenerateProtocolChecksum( ( uint8_t * ) ( pxNetworkBuffer->pucEthernetBuffer ), pxNetworkBuffer->xDataLength, pdFALSE ) != ipCORRECT_CRC )
+                else if( ipRX_PROTOCOL_CHECKSUM( pxNetworkBuffer ) != ipCORRECT_CRC )
                 {
                     /* Protocol checksum not accepted. */
+                    ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropChecksum );
                     eReturn = eReleaseBuffer;
                 }
                 else
@@ -405,59 +509,10 @@ enum eFrameProcessingResult prvAllowIPPacketIPv4( const struct xIP_PACKET * cons
     {
         if( eReturn == eProcessBuffer )
         {
-            if( xCheckIPv4SizeFields( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength ) != pdPASS )
-            {
-                /* Some of the length checks were not successful. */
-                eReturn = eReleaseBuffer;
-            }
-        }
-
-        #if ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 )
-        {
-            /* Check if this is a UDP packet without a checksum. */
-            if( eReturn == eProcessBuffer )
-            {
-                uint8_t ucProtocol;
-                const ProtocolHeaders_t * pxProtocolHeaders;
-
-                /* ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS is defined as 0,
-                 * and so UDP packets carrying a protocol checksum of 0, will
-                 * be dropped. */
-                ucProtocol = pxIPPacket->xIPHeader.ucProtocol;
-                /* MISRA Ref 11.3.1 [Misaligned access] */
-                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-                /* coverity[misra_c_2012_rule_11_3_violation] */
-                pxProtocolHeaders = ( ( ProtocolHeaders_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ( size_t ) ipSIZE_OF_IPv4_HEADER ] ) );
-
-                /* Identify the next protocol. */
-                if( ucProtocol == ( uint8_t ) ipPROTOCOL_UDP )
-                {
-                    if( pxProtocolHeaders->xUDPHeader.usChecksum == ( uint16_t ) 0U )
-                    {
-                        #if ( ipconfigHAS_PRINTF != 0 )
-                        {
-                            static BaseType_t xCount = 0;
-
-                            /* Exclude this from branch coverage as this is only used for debugging. */
-                            if( xCount < 5 ) /* LCOV_EXCL_BR_LINE */
-                            {
-                                FreeRTOS_printf( ( "prvAllowIPPacket: UDP packet from %xip without CRC dropped\n",
-                                                   FreeRTOS_ntohl( pxIPPacket->xIPHeader.ulSourceIPAddress ) ) );
-                                xCount++;
-                            }
-                        }
-                        #endif /* ( ipconfigHAS_PRINTF != 0 ) */
-
-                        /* Protocol checksum not accepted. */
-                        eReturn = eReleaseBuffer;
-                    }
-                }
-            }
+            eReturn = prvAllowVerifiedIPv4( pxIPPacket, pxNetworkBuffer );
         }
-        #endif /* ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 ) */
 
         /* to avoid warning unused parameters */
-        ( void ) pxNetworkBuffer;
         ( void ) uxHeaderLength;
     }
     #endif /* ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 */
@@ -528,6 +583,183 @@ enum eFrameProcessingResult prvCheckIP4HeaderOptions( struct xNETWORK_BUFFER * c
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_IP_FORWARDING != 0 )
+
+/**
+ * @brief Check if a packet is sent to this host as a router: it is addressed
+ *        to the MAC address of an end-point, but not to any of its IP-addresses.
+ *
+ * @param[in] pxNetworkBuffer The received packet.
+ *
+ * @return pdTRUE when the packet must be forwarded.
+ */
+    static BaseType_t prvIPv4MustForward( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPPacket_t * pxIPPacket = ( ( const IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+        uint32_t ulDestination = pxIPPacket->xIPHeader.ulDestinationIPAddress;
+        const NetworkEndPoint_t * pxEndPoint = pxNetworkBuffer->pxEndPoint;
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pxEndPoint->bits.bIPv6 == pdFALSE_UNSIGNED ) &&
+            ( pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED ) &&
+            ( ulDestination != 0U ) &&
+            ( ulDestination != ipBROADCAST_IP_ADDRESS ) &&
+            ( ( FreeRTOS_ntohl( ulDestination ) & 0xffU ) != 0xffU ) &&
+            ( xIsIPv4Multicast( ulDestination ) == pdFALSE ) &&
+            ( xIsIPv4Loopback( ulDestination ) == pdFALSE ) &&
+            ( FreeRTOS_FindEndPointOnIP_IPv4( ulDestination ) == NULL ) &&
+            ( FreeRTOS_FindEndPointOnMAC( &( pxIPPacket->xEthernetHeader.xDestinationAddress ), pxNetworkBuffer->pxInterface ) != NULL ) )
+        {
+            /* The directed broadcast of a connected network is not forwarded. */
+            pxEndPoint = FreeRTOS_FindEndPointOnNetMask( ulDestination );
+
+            if( ( pxEndPoint == NULL ) || ( pxEndPoint->ipv4_settings.ulBroadcastAddress != ulDestination ) )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Forward an IPv4 packet that is not addressed to this host, see
+ *        ipconfigUSE_IP_FORWARDING.
+ *
+ * @param[in] pxNetworkBuffer The received packet.
+ * @param[in] uxHeaderLength The length of the IP-header, including options.
+ *
+ * @return eProcessBuffer when the packet is for this host, eFrameConsumed when
+ *         it was passed to the outgoing interface, or else eReleaseBuffer.
+ */
+    enum eFrameProcessingResult eIPv4ForwardPacket( struct xNETWORK_BUFFER * const pxNetworkBuffer,
+                                                    UBaseType_t uxHeaderLength )
+    {
+        eFrameProcessingResult_t eReturn = eProcessBuffer;
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        IPPacket_t * pxIPPacket = ( ( IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+        IPHeader_t * pxIPHeader = &( pxIPPacket->xIPHeader );
+        NetworkEndPoint_t * pxEndPoint = NULL;
+        MACAddress_t xMACAddress;
+        eARPLookupResult_t eResult;
+        uint32_t ulNextHop;
+        uint32_t ulSource;
+        size_t uxLength;
+        uint16_t usOldWord;
+
+        #if ( ipconfigUSE_NAPT != 0 )
+        {
+            /* A reply to a translated connection gets the address of the
+             * inside host, and will be forwarded to it. */
+            vNAPTInbound( pxNetworkBuffer, uxHeaderLength );
+        }
+        #endif
+
+        if( prvIPv4MustForward( pxNetworkBuffer ) != pdFALSE )
+        {
+            eReturn = eReleaseBuffer;
+            uxLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usLength );
+            ulSource = pxIPHeader->ulSourceIPAddress;
+
+            if( ( uxLength < ( size_t ) uxHeaderLength ) ||
+                ( ( uxLength + ipSIZE_OF_ETH_HEADER ) > pxNetworkBuffer->xDataLength ) )
+            {
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
+            }
+
+            #if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 )
+                else if( usGenerateChecksum( 0U, ( const uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ( size_t ) uxHeaderLength ) != ipCORRECT_CRC )
+                {
+                    ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropChecksum );
+                }
+            #endif
+            else if( ( ulSource == 0U ) ||
+                     ( ( FreeRTOS_ntohl( ulSource ) & 0xffU ) == 0xffU ) ||
+                     ( xIsIPv4Multicast( ulSource ) != pdFALSE ) ||
+                     ( xIsIPv4Loopback( ulSource ) != pdFALSE ) ||
+                     ( FreeRTOS_FindEndPointOnIP_IPv4( ulSource ) != NULL ) )
+            {
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropFiltered );
+            }
+            else if( pxIPHeader->ucTimeToLive <= 1U )
+            {
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropNoRoute );
+            }
+            else
+            {
+                /* Find the outgoing end-point and the MAC address of the next hop. */
+                ulNextHop = pxIPHeader->ulDestinationIPAddress;
+                eResult = eARPGetCacheEntry( &( ulNextHop ), &( xMACAddress ), &( pxEndPoint ) );
+
+                if( eResult == eARPCacheMiss )
+                {
+                    /* 'ulNextHop' may have become the address of a gateway. Ask
+                     * for its MAC address, the sender will retransmit. */
+                    pxEndPoint = FreeRTOS_FindEndPointOnNetMask( ulNextHop );
+
+                    if( pxEndPoint != NULL )
+                    {
+                        vARPRefreshCacheEntry( NULL, ulNextHop, NULL );
+                        FreeRTOS_OutputARPRequest_Multi( pxEndPoint, ulNextHop );
+                    }
+                }
+                else if( ( eResult == eARPCacheHit ) &&
+                         ( pxEndPoint != NULL ) &&
+                         ( pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED ) &&
+                         ( uxLength <= uxInterfaceMTU( pxEndPoint->pxNetworkInterface ) ) )
+                {
+                    #if ( ipconfigUSE_NAPT != 0 )
+                        /* Packets to the public side get the public address. */
+                        if( xNAPTOutbound( pxNetworkBuffer, uxHeaderLength, pxEndPoint ) == pdFALSE )
+                        {
+                            /* No translation is possible, or the table is full. */
+                        }
+                        else
+                    #endif
+                    {
+                        /* TTL and protocol share a 16-bit word of the IP-header. */
+                        usOldWord = ( uint16_t ) ( ( ( uint16_t ) pxIPHeader->ucTimeToLive << 8 ) | ( uint16_t ) pxIPHeader->ucProtocol );
+                        pxIPHeader->ucTimeToLive--;
+                        pxIPHeader->usHeaderChecksum = usIncrementalChecksum( pxIPHeader->usHeaderChecksum,
+                                                                              FreeRTOS_htons( usOldWord ),
+                                                                              FreeRTOS_htons( ( uint16_t ) ( usOldWord - 0x0100U ) ) );
+
+                        ( void ) memcpy( pxIPPacket->xEthernetHeader.xDestinationAddress.ucBytes, xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+                        ( void ) memcpy( pxIPPacket->xEthernetHeader.xSourceAddress.ucBytes, pxEndPoint->xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+
+                        /* Drop the Ethernet padding, if any. */
+                        pxNetworkBuffer->xDataLength = uxLength + ipSIZE_OF_ETH_HEADER;
+                        pxNetworkBuffer->pxEndPoint = pxEndPoint;
+                        pxNetworkBuffer->pxInterface = pxEndPoint->pxNetworkInterface;
+
+                        ( void ) xIPInterfaceOutput( pxEndPoint->pxNetworkInterface, pxNetworkBuffer, pdTRUE );
+                        eReturn = eFrameConsumed;
+                    }
+                }
+                else
+                {
+                    /* No route, or the packet would need fragmentation. */
+                }
+
+                if( eReturn != eFrameConsumed )
+                {
+                    ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropNoRoute );
+                }
+            }
+        }
+
+        return eReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_IP_FORWARDING != 0 ) */
+
 /* *INDENT-OFF* */
     #endif /* ipconfigUSE_IPv4 != 0 ) */
 /* *INDENT-ON* */
@@ -67,18 +67,18 @@ const struct xIPv6_Address FreeRTOS_in6addr_any = { 0 };
 /* coverity[misra_c_2012_rule_8_9_violation] */
 const struct xIPv6_Address FreeRTOS_in6addr_loopback = { { 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U } };
 
-#if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 )
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) )
     /* Check IPv6 packet length. */
     static BaseType_t xCheckIPv6SizeFields( const void * const pvEthernetBuffer,
                                             size_t uxBufferLength );
-#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
+#endif /* ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) ) */
 
-#if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 )
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) )
     /* Check if ucNextHeader is an extension header. */
     static BaseType_t xIsExtHeader( uint8_t ucNextHeader );
-#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
+#endif /* ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) ) */
 
-#if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 )
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) )
 
 /**
  * @brief Check IPv6 packet length.
@@ -226,11 +226,11 @@ const struct xIPv6_Address FreeRTOS_in6addr_loopback = { { 0U, 0U, 0U, 0U, 0U, 0
     }
 
 
-#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
+#endif /* ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) ) */
 /*-----------------------------------------------------------*/
 
 
-#if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 )
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) )
 
 /**
  * @brief Check if ucNextHeader is an extension header.
@@ -259,7 +259,7 @@ const struct xIPv6_Address FreeRTOS_in6addr_loopback = { { 0U, 0U, 0U, 0U, 0U, 0
     }
 
 
-#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
+#endif /* ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) ) */
 /*-----------------------------------------------------------*/
 
 /**
@@ -526,6 +526,7 @@ eFrameProcessingResult_t prvAllowIPPacketIPv6( const IPHeader_IPv6_t * const pxI
         {
             /* Packet is not for this node, or the network is still not up,
              * release it */
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropFiltered );
             eReturn = eReleaseBuffer;
             FreeRTOS_printf( ( "prvAllowIPPacketIPv6: drop %pip (from %pip)\n", pxDestinationIPAddress->ucBytes, pxIPv6Header->xSourceAddress.ucBytes ) );
         }
@@ -550,14 +551,29 @@ eFrameProcessingResult_t prvAllowIPPacketIPv6( const IPHeader_IPv6_t * const pxI
             const IPPacket_t * pxIPPacket = ( ( const IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
             const NetworkEndPoint_t * pxEndPoint = FreeRTOS_FindEndPointOnMAC( &( pxIPPacket->xEthernetHeader.xSourceAddress ), NULL );
 
+            if( ipRX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) == pdFALSE )
+            {
+                #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+                {
+                    /* The interface or the driver has verified the checksum,
+                     * only check the length fields. */
+                    if( xCheckIPv6SizeFields( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength ) != pdPASS )
+                    {
+                        ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
+                        eReturn = eReleaseBuffer;
+                    }
+                }
+                #endif
+            }
             /* IPv6 does not have a separate checksum in the IP-header */
             /* Is the upper-layer checksum (TCP/UDP/ICMP) correct? */
             /* Do not check the checksum of loop-back messages. */
-            if( pxEndPoint == NULL )
+            else if( pxEndPoint == NULL )
             {
-                if( usGenerateProtocolChecksum( ( uint8_t * ) ( pxNetworkBuffer->pucEthernetBuffer ), pxNetworkBuffer->xDataLength, pdFALSE ) != ipCORRECT_CRC )
+                if( ipRX_PROTOCOL_CHECKSUM( pxNetworkBuffer ) != ipCORRECT_CRC )
                 {
                     /* Protocol checksum not accepted. */
+                    ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropChecksum );
                     eReturn = eReleaseBuffer;
                 }
             }
@@ -570,6 +586,7 @@ eFrameProcessingResult_t prvAllowIPPacketIPv6( const IPHeader_IPv6_t * const pxI
             if( xCheckIPv6SizeFields( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength ) != pdPASS )
             {
                 /* Some of the length checks were not successful. */
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
                 eReturn = eReleaseBuffer;
             }
         }
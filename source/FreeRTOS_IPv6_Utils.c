@@ -205,7 +205,13 @@ size_t usGetExtensionHeaderLength( const uint8_t * pucEthernetBuffer,
         ucCurrentHeader = pxIPPacket_IPv6->xIPHeader.ucNextHeader;
 
         /* Check if packet has extension header. */
-        if( xGetExtensionOrder( ucCurrentHeader, 0U ) > 0 )
+        if( ipIPv6_IS_UPPER_LAYER_PROTOCOL( ucCurrentHeader ) )
+        {
+            /* The common case, no need to look further. */
+            *pucProtocol = ucCurrentHeader;
+            uxReturn = 0;
+        }
+        else if( xGetExtensionOrder( ucCurrentHeader, 0U ) > 0 )
         {
             while( ( uxIndex + 8U ) < uxBufferLength )
             {
@@ -336,17 +342,11 @@ void vManageSolicitedNodeAddress( const struct xNetworkEndPoint * pxEndPoint,
         /* Update the network driver filter */
         if( xNetworkGoingUp == pdTRUE )
         {
-            if( pxEndPoint->pxNetworkInterface->pfAddAllowedMAC != NULL )
-            {
-                pxEndPoint->pxNetworkInterface->pfAddAllowedMAC( pxEndPoint->pxNetworkInterface, xMACAddress.ucBytes );
-            }
+            vNetworkInterfaceAddAllowedMAC( pxEndPoint->pxNetworkInterface, xMACAddress.ucBytes );
         }
         else
         {
-            if( pxEndPoint->pxNetworkInterface->pfRemoveAllowedMAC != NULL )
-            {
-                pxEndPoint->pxNetworkInterface->pfRemoveAllowedMAC( pxEndPoint->pxNetworkInterface, xMACAddress.ucBytes );
-            }
+            vNetworkInterfaceRemoveAllowedMAC( pxEndPoint->pxNetworkInterface, xMACAddress.ucBytes );
         }
     } while( pdFALSE );
 }
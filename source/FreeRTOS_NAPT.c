@@ -0,0 +1,666 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_NAPT.c
+ * @brief Implements the network address and port translation ( NAPT ) of
+ *        forwarded IPv4 packets: hosts on the inside networks share the
+ *        address of one outside end-point.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_ICMP.h"
+#include "FreeRTOS_TCP_IP.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_NAPT.h"
+
+/* *INDENT-OFF* */
+#if ( ipconfigUSE_NAPT != 0 )
+/* *INDENT-ON* */
+
+/** @brief The outside port of entry N is ipNAPT_FIRST_PORT + N. The range
+ *         stays below the ports that sockets bind to automatically. */
+#define ipNAPT_FIRST_PORT                ( ( uint16_t ) 0x8000U )
+
+/** @brief Marks the end of a list of entries. */
+#define ipNAPT_NONE                      ( ( uint16_t ) 0xFFFFU )
+
+/** @brief The number of slots of the timer wheel, a power of 2. */
+#define ipNAPT_WHEEL_SLOTS               64U
+
+/** @brief The time that one slot of the timer wheel represents. */
+#define ipNAPT_WHEEL_TICKS               pdMS_TO_TICKS( 1000U )
+
+/** @brief The lifetime of a TCP mapping after a FIN or RST was seen, the
+ *         "transitory" timeout of RFC 5382. */
+#define ipNAPT_TCP_TRANSITORY_SECONDS    240U
+
+/** @brief Flag of an entry: the TCP connection is closing. */
+#define ipNAPT_FLAG_CLOSING              ( ( uint8_t ) 0x01U )
+
+/**
+ * @brief A translation of one connection.
+ */
+typedef struct xNAPT_ENTRY
+{
+    uint32_t ulInsideAddress; /**< The address of the inside host, network order. */
+    uint32_t ulRemoteAddress; /**< The address of the remote host, network order. */
+    uint32_t ulExpiry;        /**< The wheel time at which the entry expires. */
+    uint16_t usInsidePort;    /**< The port, or the ICMP identifier, of the inside host, network order. */
+    uint16_t usRemotePort;    /**< The port of the remote host, zero for ICMP, network order. */
+    uint16_t usHashNext;      /**< The next entry in the same hash bucket, or in the free list. */
+    uint16_t usWheelNext;     /**< The next entry in the same slot of the timer wheel. */
+    uint8_t ucProtocol;       /**< The IP protocol, zero when the entry is free. */
+    uint8_t ucFlags;          /**< ipNAPT_FLAG_CLOSING. */
+} NAPTEntry_t;
+
+/** @brief The translations, entry N uses the outside port ipNAPT_FIRST_PORT + N. */
+static NAPTEntry_t xNAPTEntries[ ipconfigNAPT_ENTRIES ];
+
+/** @brief The hash buckets for the outbound lookup. */
+static uint16_t usNAPTBuckets[ ipconfigNAPT_ENTRIES ];
+
+/** @brief The slots of the timer wheel, each a list of entries. */
+static uint16_t usNAPTWheel[ ipNAPT_WHEEL_SLOTS ];
+
+/** @brief The list of free entries. */
+static uint16_t usNAPTFree = ipNAPT_NONE;
+
+/** @brief The end-point whose address is shared, NULL when NAPT is not active. */
+static NetworkEndPoint_t * pxNAPTEndPoint = NULL;
+
+/** @brief The current time of the timer wheel, in slots. */
+static uint32_t ulNAPTNow = 0U;
+
+/** @brief The tick count at which 'ulNAPTNow' was last advanced. */
+static TickType_t xNAPTLastTick = 0U;
+
+/** @brief pdTRUE once the free list and the timer wheel have been set up. */
+static BaseType_t xNAPTInitialised = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the bucket of an outbound connection.
+ *
+ * @param[in] ucProtocol The IP protocol.
+ * @param[in] ulInsideAddress The address of the inside host.
+ * @param[in] usInsidePort The port of the inside host.
+ * @param[in] ulRemoteAddress The address of the remote host.
+ * @param[in] usRemotePort The port of the remote host.
+ *
+ * @return An index in usNAPTBuckets[].
+ */
+static size_t prvNAPTHash( uint8_t ucProtocol,
+                           uint32_t ulInsideAddress,
+                           uint16_t usInsidePort,
+                           uint32_t ulRemoteAddress,
+                           uint16_t usRemotePort )
+{
+    uint32_t ulHash = ulInsideAddress ^ ( ulRemoteAddress * 0x9E3779B1U );
+
+    ulHash ^= ( ( ( uint32_t ) usInsidePort << 16 ) | ( uint32_t ) usRemotePort ) + ( uint32_t ) ucProtocol;
+    ulHash ^= ulHash >> 16;
+    ulHash *= 0x85EBCA6BU;
+    ulHash ^= ulHash >> 13;
+
+    return ( size_t ) ( ulHash % ( uint32_t ) ipconfigNAPT_ENTRIES );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Put all entries in the free list, the first time NAPT is used.
+ */
+static void prvNAPTInitialise( void )
+{
+    size_t uxIndex;
+
+    for( uxIndex = 0U; uxIndex < ( size_t ) ipconfigNAPT_ENTRIES; uxIndex++ )
+    {
+        xNAPTEntries[ uxIndex ].ucProtocol = 0U;
+        xNAPTEntries[ uxIndex ].usHashNext = ( uxIndex + 1U < ( size_t ) ipconfigNAPT_ENTRIES ) ? ( uint16_t ) ( uxIndex + 1U ) : ipNAPT_NONE;
+        usNAPTBuckets[ uxIndex ] = ipNAPT_NONE;
+    }
+
+    for( uxIndex = 0U; uxIndex < ipNAPT_WHEEL_SLOTS; uxIndex++ )
+    {
+        usNAPTWheel[ uxIndex ] = ipNAPT_NONE;
+    }
+
+    usNAPTFree = 0U;
+    xNAPTLastTick = xTaskGetTickCount();
+    xNAPTInitialised = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove an entry from its hash bucket and add it to the free list.
+ *
+ * @param[in] usIndex The entry.
+ */
+static void prvNAPTRelease( uint16_t usIndex )
+{
+    NAPTEntry_t * pxEntry = &( xNAPTEntries[ usIndex ] );
+    uint16_t * pusLink = &( usNAPTBuckets[ prvNAPTHash( pxEntry->ucProtocol,
+                                                         pxEntry->ulInsideAddress,
+                                                         pxEntry->usInsidePort,
+                                                         pxEntry->ulRemoteAddress,
+                                                         pxEntry->usRemotePort ) ] );
+
+    while( *pusLink != ipNAPT_NONE )
+    {
+        if( *pusLink == usIndex )
+        {
+            *pusLink = pxEntry->usHashNext;
+            break;
+        }
+
+        pusLink = &( xNAPTEntries[ *pusLink ].usHashNext );
+    }
+
+    pxEntry->ucProtocol = 0U;
+    pxEntry->usHashNext = usNAPTFree;
+    usNAPTFree = usIndex;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Advance the timer wheel to the current time. Every slot that passes
+ *        releases its expired entries. An entry that was refreshed since it
+ *        was filed moves to the slot of its new expiry time.
+ */
+static void prvNAPTAdvance( void )
+{
+    TickType_t xElapsed = xTaskGetTickCount() - xNAPTLastTick;
+    uint32_t ulSlots = ( uint32_t ) ( xElapsed / ipNAPT_WHEEL_TICKS );
+    uint32_t ulCount;
+    uint32_t ulSlot;
+    uint16_t * pusLink;
+    uint16_t usIndex;
+    NAPTEntry_t * pxEntry;
+
+    xNAPTLastTick += ( TickType_t ) ( ulSlots * ipNAPT_WHEEL_TICKS );
+
+    /* Visiting each slot once is enough, whatever time has passed. */
+    ulCount = FreeRTOS_min_uint32( ulSlots, ipNAPT_WHEEL_SLOTS );
+    ulSlot = ulNAPTNow;
+    ulNAPTNow += ulSlots;
+
+    while( ulCount > 0U )
+    {
+        ulCount--;
+        ulSlot++;
+        pusLink = &( usNAPTWheel[ ulSlot % ipNAPT_WHEEL_SLOTS ] );
+
+        while( *pusLink != ipNAPT_NONE )
+        {
+            usIndex = *pusLink;
+            pxEntry = &( xNAPTEntries[ usIndex ] );
+
+            if( ( int32_t ) ( pxEntry->ulExpiry - ulNAPTNow ) <= 0 )
+            {
+                *pusLink = pxEntry->usWheelNext;
+                prvNAPTRelease( usIndex );
+            }
+            else if( ( pxEntry->ulExpiry % ipNAPT_WHEEL_SLOTS ) != ( ulSlot % ipNAPT_WHEEL_SLOTS ) )
+            {
+                /* Refreshed: move it to the slot of its expiry time. */
+                *pusLink = pxEntry->usWheelNext;
+                pxEntry->usWheelNext = usNAPTWheel[ pxEntry->ulExpiry % ipNAPT_WHEEL_SLOTS ];
+                usNAPTWheel[ pxEntry->ulExpiry % ipNAPT_WHEEL_SLOTS ] = usIndex;
+            }
+            else
+            {
+                pusLink = &( pxEntry->usWheelNext );
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Extend the lifetime of an entry after it has seen a packet.
+ *
+ * @param[in] pxEntry The entry.
+ * @param[in] ucTCPFlags The flags of a TCP packet, otherwise zero.
+ */
+static void prvNAPTRefresh( NAPTEntry_t * pxEntry,
+                            uint8_t ucTCPFlags )
+{
+    uint32_t ulSeconds = ipconfigNAPT_UDP_TIMEOUT_SECONDS;
+
+    if( pxEntry->ucProtocol == ( uint8_t ) ipPROTOCOL_TCP )
+    {
+        if( ( ucTCPFlags & ( tcpTCP_FLAG_FIN | tcpTCP_FLAG_RST ) ) != 0U )
+        {
+            pxEntry->ucFlags |= ipNAPT_FLAG_CLOSING;
+        }
+        else if( ( ucTCPFlags & ( tcpTCP_FLAG_SYN | tcpTCP_FLAG_ACK ) ) == tcpTCP_FLAG_SYN )
+        {
+            /* A new connection re-uses the mapping. */
+            pxEntry->ucFlags &= ( uint8_t ) ~ipNAPT_FLAG_CLOSING;
+        }
+        else
+        {
+            /* No change. */
+        }
+
+        ulSeconds = ( ( pxEntry->ucFlags & ipNAPT_FLAG_CLOSING ) != 0U ) ? ipNAPT_TCP_TRANSITORY_SECONDS : ipconfigNAPT_TCP_TIMEOUT_SECONDS;
+    }
+
+    pxEntry->ulExpiry = ulNAPTNow + ulSeconds;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Replace an IPv4 address that is covered by a checksum.
+ *
+ * @param[in] usChecksum The checksum, as stored in the packet.
+ * @param[in] ulOld The old address, network order.
+ * @param[in] ulNew The new address, network order.
+ *
+ * @return The new checksum.
+ */
+static uint16_t prvNAPTChecksumAddress( uint16_t usChecksum,
+                                        uint32_t ulOld,
+                                        uint32_t ulNew )
+{
+    uint16_t usResult = usIncrementalChecksum( usChecksum, ( uint16_t ) ( ulOld & 0xFFFFU ), ( uint16_t ) ( ulNew & 0xFFFFU ) );
+
+    return usIncrementalChecksum( usResult, ( uint16_t ) ( ulOld >> 16 ), ( uint16_t ) ( ulNew >> 16 ) );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Replace the source or destination address and port of a packet, and
+ *        adjust the checksums.
+ *
+ * @param[in] pxNetworkBuffer The packet.
+ * @param[in] uxHeaderLength The length of the IP-header.
+ * @param[in] xSource pdTRUE to replace the source, pdFALSE for the destination.
+ * @param[in] ulAddress The new address, network order.
+ * @param[in] usPort The new port or ICMP identifier, network order.
+ */
+static void prvNAPTRewrite( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                            UBaseType_t uxHeaderLength,
+                            BaseType_t xSource,
+                            uint32_t ulAddress,
+                            uint16_t usPort )
+{
+    /* MISRA Ref 11.3.1 [Misaligned access] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+    /* coverity[misra_c_2012_rule_11_3_violation] */
+    IPHeader_t * pxIPHeader = ( ( IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+    /* MISRA Ref 11.3.1 [Misaligned access] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+    /* coverity[misra_c_2012_rule_11_3_violation] */
+    ProtocolHeaders_t * pxProtocolHeaders = ( ( ProtocolHeaders_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ( size_t ) uxHeaderLength ] ) );
+    uint32_t ulOldAddress = ( xSource != pdFALSE ) ? pxIPHeader->ulSourceIPAddress : pxIPHeader->ulDestinationIPAddress;
+    uint16_t usOldPort;
+
+    pxIPHeader->usHeaderChecksum = prvNAPTChecksumAddress( pxIPHeader->usHeaderChecksum, ulOldAddress, ulAddress );
+
+    if( xSource != pdFALSE )
+    {
+        pxIPHeader->ulSourceIPAddress = ulAddress;
+    }
+    else
+    {
+        pxIPHeader->ulDestinationIPAddress = ulAddress;
+    }
+
+    switch( pxIPHeader->ucProtocol )
+    {
+        case ipPROTOCOL_TCP:
+            usOldPort = ( xSource != pdFALSE ) ? pxProtocolHeaders->xTCPHeader.usSourcePort : pxProtocolHeaders->xTCPHeader.usDestinationPort;
+            pxProtocolHeaders->xTCPHeader.usChecksum = prvNAPTChecksumAddress( pxProtocolHeaders->xTCPHeader.usChecksum, ulOldAddress, ulAddress );
+            pxProtocolHeaders->xTCPHeader.usChecksum = usIncrementalChecksum( pxProtocolHeaders->xTCPHeader.usChecksum, usOldPort, usPort );
+
+            if( xSource != pdFALSE )
+            {
+                pxProtocolHeaders->xTCPHeader.usSourcePort = usPort;
+            }
+            else
+            {
+                pxProtocolHeaders->xTCPHeader.usDestinationPort = usPort;
+            }
+
+            break;
+
+        case ipPROTOCOL_UDP:
+            usOldPort = ( xSource != pdFALSE ) ? pxProtocolHeaders->xUDPHeader.usSourcePort : pxProtocolHeaders->xUDPHeader.usDestinationPort;
+
+            /* A zero UDP checksum means that there is none. */
+            if( pxProtocolHeaders->xUDPHeader.usChecksum != 0U )
+            {
+                pxProtocolHeaders->xUDPHeader.usChecksum = prvNAPTChecksumAddress( pxProtocolHeaders->xUDPHeader.usChecksum, ulOldAddress, ulAddress );
+                pxProtocolHeaders->xUDPHeader.usChecksum = usIncrementalChecksum( pxProtocolHeaders->xUDPHeader.usChecksum, usOldPort, usPort );
+
+                if( pxProtocolHeaders->xUDPHeader.usChecksum == 0U )
+                {
+                    pxProtocolHeaders->xUDPHeader.usChecksum = 0xFFFFU;
+                }
+            }
+
+            if( xSource != pdFALSE )
+            {
+                pxProtocolHeaders->xUDPHeader.usSourcePort = usPort;
+            }
+            else
+            {
+                pxProtocolHeaders->xUDPHeader.usDestinationPort = usPort;
+            }
+
+            break;
+
+        default:
+            /* ICMP has no pseudo header, only the identifier changes. */
+            pxProtocolHeaders->xICMPHeader.usChecksum = usIncrementalChecksum( pxProtocolHeaders->xICMPHeader.usChecksum,
+                                                                               pxProtocolHeaders->xICMPHeader.usIdentifier,
+                                                                               usPort );
+            pxProtocolHeaders->xICMPHeader.usIdentifier = usPort;
+            break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if the protocol header of an IPv4 packet can be translated.
+ *
+ * @param[in] pxNetworkBuffer The packet.
+ * @param[in] uxHeaderLength The length of the IP-header.
+ * @param[in] ucEchoType The ICMP type that can be translated.
+ *
+ * @return pdTRUE when the packet is not a fragment, and it is a TCP or UDP
+ *         packet, or an ICMP message of type 'ucEchoType'.
+ */
+static BaseType_t prvNAPTCanTranslate( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                       UBaseType_t uxHeaderLength,
+                                       uint8_t ucEchoType )
+{
+    /* MISRA Ref 11.3.1 [Misaligned access] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+    /* coverity[misra_c_2012_rule_11_3_violation] */
+    const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+    size_t uxOffset = ipSIZE_OF_ETH_HEADER + ( size_t ) uxHeaderLength;
+    size_t uxMinimum = 0U;
+    BaseType_t xReturn = pdFALSE;
+
+    switch( pxIPHeader->ucProtocol )
+    {
+        case ipPROTOCOL_TCP:
+            uxMinimum = ipSIZE_OF_TCP_HEADER;
+            break;
+
+        case ipPROTOCOL_UDP:
+            uxMinimum = ipSIZE_OF_UDP_HEADER;
+            break;
+
+        case ipPROTOCOL_ICMP:
+
+            if( ( pxNetworkBuffer->xDataLength >= ( uxOffset + ipSIZE_OF_ICMPv4_HEADER ) ) &&
+                ( pxNetworkBuffer->pucEthernetBuffer[ uxOffset ] == ucEchoType ) )
+            {
+                uxMinimum = ipSIZE_OF_ICMPv4_HEADER;
+            }
+
+            break;
+
+        default:
+            /* Other protocols have no ports. */
+            break;
+    }
+
+    if( ( uxMinimum != 0U ) &&
+        ( pxNetworkBuffer->xDataLength >= ( uxOffset + uxMinimum ) ) &&
+        ( ( pxIPHeader->usFragmentOffset & ( ipFRAGMENT_OFFSET_BIT_MASK | ipFRAGMENT_FLAGS_MORE_FRAGMENTS ) ) == 0U ) )
+    {
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Set the end-point whose address is shared by the inside hosts.
+ *
+ * @param[in] pxEndPoint An IPv4 end-point, or NULL to stop translating.
+ */
+void FreeRTOS_SetNAPTEndPoint( NetworkEndPoint_t * pxEndPoint )
+{
+    configASSERT( ( pxEndPoint == NULL ) || ( pxEndPoint->bits.bIPv6 == pdFALSE_UNSIGNED ) );
+
+    if( xNAPTInitialised == pdFALSE )
+    {
+        prvNAPTInitialise();
+    }
+
+    pxNAPTEndPoint = pxEndPoint;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Translate a reply to a connection back to the inside host.
+ *
+ * @param[in] pxNetworkBuffer The received IPv4 packet.
+ * @param[in] uxHeaderLength The length of the IP-header.
+ */
+void vNAPTInbound( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                   UBaseType_t uxHeaderLength )
+{
+    /* MISRA Ref 11.3.1 [Misaligned access] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+    /* coverity[misra_c_2012_rule_11_3_violation] */
+    const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+    /* MISRA Ref 11.3.1 [Misaligned access] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+    /* coverity[misra_c_2012_rule_11_3_violation] */
+    const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ( size_t ) uxHeaderLength ] ) );
+    NAPTEntry_t * pxEntry;
+    uint16_t usPort;
+    uint16_t usRemotePort = 0U;
+    uint8_t ucTCPFlags = 0U;
+    size_t uxIndex;
+
+    if( ( pxNAPTEndPoint != NULL ) &&
+        ( pxIPHeader->ulDestinationIPAddress == pxNAPTEndPoint->ipv4_settings.ulIPAddress ) &&
+        ( prvNAPTCanTranslate( pxNetworkBuffer, uxHeaderLength, ipICMP_ECHO_REPLY ) != pdFALSE ) )
+    {
+        prvNAPTAdvance();
+
+        switch( pxIPHeader->ucProtocol )
+        {
+            case ipPROTOCOL_TCP:
+                usPort = pxProtocolHeaders->xTCPHeader.usDestinationPort;
+                usRemotePort = pxProtocolHeaders->xTCPHeader.usSourcePort;
+                ucTCPFlags = pxProtocolHeaders->xTCPHeader.ucTCPFlags;
+                break;
+
+            case ipPROTOCOL_UDP:
+                usPort = pxProtocolHeaders->xUDPHeader.usDestinationPort;
+                usRemotePort = pxProtocolHeaders->xUDPHeader.usSourcePort;
+                break;
+
+            default:
+                usPort = pxProtocolHeaders->xICMPHeader.usIdentifier;
+                break;
+        }
+
+        /* The outside port is the index of the entry. */
+        uxIndex = ( size_t ) ( uint16_t ) ( FreeRTOS_ntohs( usPort ) - ipNAPT_FIRST_PORT );
+
+        if( uxIndex < ( size_t ) ipconfigNAPT_ENTRIES )
+        {
+            pxEntry = &( xNAPTEntries[ uxIndex ] );
+
+            if( ( pxEntry->ucProtocol == pxIPHeader->ucProtocol ) &&
+                ( pxEntry->ulRemoteAddress == pxIPHeader->ulSourceIPAddress ) &&
+                ( pxEntry->usRemotePort == usRemotePort ) )
+            {
+                prvNAPTRefresh( pxEntry, ucTCPFlags );
+                prvNAPTRewrite( pxNetworkBuffer, uxHeaderLength, pdFALSE, pxEntry->ulInsideAddress, pxEntry->usInsidePort );
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Give a packet that leaves through the NAPT end-point the public
+ *        address, and a port that identifies its connection.
+ *
+ * @param[in] pxNetworkBuffer The packet, its end-point is the receiving one.
+ * @param[in] uxHeaderLength The length of the IP-header.
+ * @param[in] pxEndPoint The end-point through which the packet will leave.
+ *
+ * @return pdFALSE when the packet must be dropped, otherwise pdTRUE.
+ */
+BaseType_t xNAPTOutbound( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                          UBaseType_t uxHeaderLength,
+                          const NetworkEndPoint_t * pxEndPoint )
+{
+    /* MISRA Ref 11.3.1 [Misaligned access] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+    /* coverity[misra_c_2012_rule_11_3_violation] */
+    const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+    /* MISRA Ref 11.3.1 [Misaligned access] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+    /* coverity[misra_c_2012_rule_11_3_violation] */
+    const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ( size_t ) uxHeaderLength ] ) );
+    NAPTEntry_t * pxEntry = NULL;
+    uint16_t usInsidePort;
+    uint16_t usRemotePort = 0U;
+    uint16_t usIndex;
+    uint8_t ucTCPFlags = 0U;
+    size_t uxBucket;
+    BaseType_t xReturn = pdTRUE;
+
+    if( ( pxNAPTEndPoint != NULL ) &&
+        ( pxEndPoint == pxNAPTEndPoint ) &&
+        ( pxNetworkBuffer->pxEndPoint != pxNAPTEndPoint ) )
+    {
+        xReturn = pdFALSE;
+
+        if( prvNAPTCanTranslate( pxNetworkBuffer, uxHeaderLength, ipICMP_ECHO_REQUEST ) != pdFALSE )
+        {
+            prvNAPTAdvance();
+
+            switch( pxIPHeader->ucProtocol )
+            {
+                case ipPROTOCOL_TCP:
+                    usInsidePort = pxProtocolHeaders->xTCPHeader.usSourcePort;
+                    usRemotePort = pxProtocolHeaders->xTCPHeader.usDestinationPort;
+                    ucTCPFlags = pxProtocolHeaders->xTCPHeader.ucTCPFlags;
+                    break;
+
+                case ipPROTOCOL_UDP:
+                    usInsidePort = pxProtocolHeaders->xUDPHeader.usSourcePort;
+                    usRemotePort = pxProtocolHeaders->xUDPHeader.usDestinationPort;
+                    break;
+
+                default:
+                    usInsidePort = pxProtocolHeaders->xICMPHeader.usIdentifier;
+                    break;
+            }
+
+            uxBucket = prvNAPTHash( pxIPHeader->ucProtocol, pxIPHeader->ulSourceIPAddress, usInsidePort,
+                                    pxIPHeader->ulDestinationIPAddress, usRemotePort );
+
+            for( usIndex = usNAPTBuckets[ uxBucket ]; usIndex != ipNAPT_NONE; usIndex = xNAPTEntries[ usIndex ].usHashNext )
+            {
+                pxEntry = &( xNAPTEntries[ usIndex ] );
+
+                if( ( pxEntry->ucProtocol == pxIPHeader->ucProtocol ) &&
+                    ( pxEntry->ulInsideAddress == pxIPHeader->ulSourceIPAddress ) &&
+                    ( pxEntry->usInsidePort == usInsidePort ) &&
+                    ( pxEntry->ulRemoteAddress == pxIPHeader->ulDestinationIPAddress ) &&
+                    ( pxEntry->usRemotePort == usRemotePort ) )
+                {
+                    break;
+                }
+            }
+
+            if( ( usIndex == ipNAPT_NONE ) && ( usNAPTFree != ipNAPT_NONE ) )
+            {
+                /* A new connection: take a free entry. */
+                usIndex = usNAPTFree;
+                pxEntry = &( xNAPTEntries[ usIndex ] );
+                usNAPTFree = pxEntry->usHashNext;
+
+                pxEntry->ucProtocol = pxIPHeader->ucProtocol;
+                pxEntry->ucFlags = 0U;
+                pxEntry->ulInsideAddress = pxIPHeader->ulSourceIPAddress;
+                pxEntry->usInsidePort = usInsidePort;
+                pxEntry->ulRemoteAddress = pxIPHeader->ulDestinationIPAddress;
+                pxEntry->usRemotePort = usRemotePort;
+                pxEntry->usHashNext = usNAPTBuckets[ uxBucket ];
+                usNAPTBuckets[ uxBucket ] = usIndex;
+
+                prvNAPTRefresh( pxEntry, ucTCPFlags );
+                pxEntry->usWheelNext = usNAPTWheel[ pxEntry->ulExpiry % ipNAPT_WHEEL_SLOTS ];
+                usNAPTWheel[ pxEntry->ulExpiry % ipNAPT_WHEEL_SLOTS ] = usIndex;
+            }
+            else if( usIndex != ipNAPT_NONE )
+            {
+                prvNAPTRefresh( pxEntry, ucTCPFlags );
+            }
+            else
+            {
+                /* The table is full. */
+            }
+
+            if( usIndex != ipNAPT_NONE )
+            {
+                prvNAPTRewrite( pxNetworkBuffer, uxHeaderLength, pdTRUE, pxNAPTEndPoint->ipv4_settings.ulIPAddress,
+                                FreeRTOS_htons( ( uint16_t ) ( ipNAPT_FIRST_PORT + usIndex ) ) );
+                xReturn = pdTRUE;
+            }
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/* *INDENT-OFF* */
+#endif /* ( ipconfigUSE_NAPT != 0 ) */
+/* *INDENT-ON* */
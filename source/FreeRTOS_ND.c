@@ -41,11 +41,13 @@
 #include "FreeRTOS_IP.h"
 #include "FreeRTOS_Sockets.h"
 #include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_IP_Utils.h"
 #include "FreeRTOS_ARP.h"
 #include "FreeRTOS_UDP_IP.h"
 #include "FreeRTOS_Routing.h"
 #include "FreeRTOS_ND.h"
 #include "FreeRTOS_IP_Timers.h"
+#include "FreeRTOS_IGMP.h"
 
 #if ( ipconfigUSE_LLMNR == 1 )
     #include "FreeRTOS_DNS.h"
@@ -73,6 +75,13 @@
  */
     #define ndMAX_CACHE_AGE_BEFORE_NEW_ND_SOLICITATION    ( 3U )
 
+/** @brief The age at which an entry is refreshed before it expires. */
+    #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+        #define ndREFRESH_AGE                             ( ( uint8_t ) ipconfigARP_REFRESH_AHEAD_PERIODS )
+    #else
+        #define ndREFRESH_AGE                             ( ( uint8_t ) ndMAX_CACHE_AGE_BEFORE_NEW_ND_SOLICITATION )
+    #endif
+
 /** @brief All nodes on the local network segment: IP address. */
     const uint8_t pcLOCAL_ALL_NODES_MULTICAST_IP[ ipSIZE_OF_IPv6_ADDRESS ] = { 0xffU, 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x01U }; /* ff02::1 */
 /** @brief All nodes on the local network segment: MAC address. */
@@ -95,9 +104,72 @@
 /** @brief Find the first end-point of type IPv6. */
     static NetworkEndPoint_t * pxFindLocalEndpoint( void );
 
+/** @brief Send a neighbour solicitation, to the solicited-node multicast address
+ *         or directly to a known MAC-address. */
+    static void prvNDSendSolicitation( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                       const IPv6_Address_t * pxIPAddress,
+                                       const MACAddress_t * pxMACAddress );
+
 /** @brief The ND cache. */
     static NDCacheRow_t xNDCache[ ipconfigND_CACHE_ENTRIES ];
 
+    #if ( ipconfigND_STATIC_ENTRIES > 0 )
+
+/** @brief The permanent entries, see FreeRTOS_AddStaticNDEntry().  A row is
+ *         in use when ucValid is pdTRUE. */
+        static NDCacheRow_t xNDStaticCache[ ipconfigND_STATIC_ENTRIES ];
+
+/** @brief Find the row of xNDStaticCache[] that holds an IPv6 address. */
+        static BaseType_t prvNDStaticFind( const IPv6_Address_t * pxIPAddress );
+    #endif
+
+    #if ( ipconfigUSE_ND_HASH_TABLE != 0 )
+
+/** @brief The number of ageing periods that an entry stays REACHABLE. The
+ *         RFC 4861 REACHABLE_TIME of 30 seconds is 3 periods of 10 seconds. */
+        #define ndREACHABLE_TIME_PERIODS       ( 3U )
+
+/** @brief The number of ageing periods in the DELAY state, RFC 4861
+ *         DELAY_FIRST_PROBE_TIME rounded up to one period. */
+        #define ndDELAY_FIRST_PROBE_PERIODS    ( 1U )
+
+/** @brief The number of unicast solicitations sent in the PROBE state,
+ *         RFC 4861 MAX_UNICAST_SOLICIT. */
+        #define ndMAX_UNICAST_SOLICIT          ( 3U )
+
+/** @brief A link to a row of xNDCache[]: zero means "none", otherwise the
+ *         index of the row plus one, so that a zeroed index is empty. */
+        #define ndLINK_TO_ROW( usLink )        ( ( BaseType_t ) ( usLink ) - 1 )
+        #define ndROW_TO_LINK( xRow )          ( ( uint16_t ) ( ( xRow ) + 1 ) )
+
+/** @brief Mask to get a bucket number from a hash value. */
+        #define ndHASH_MASK                    ( ( uint32_t ) ipconfigND_HASH_BUCKET_COUNT - 1U )
+
+/** @brief The links that belong to one row of xNDCache[]. */
+        typedef struct xND_INDEX_LINKS
+        {
+            uint16_t usNext;  /**< The next row in the same bucket. */
+            uint16_t usNewer; /**< The row that was used more recently. */
+            uint16_t usOlder; /**< The row that was used less recently, or the next free row. */
+        } NDIndexLinks_t;
+
+/** @brief Indexes the valid rows of xNDCache[]. Rows that were released are
+ *         kept in a free list. */
+        typedef struct xND_INDEX
+        {
+            uint16_t usBuckets[ ipconfigND_HASH_BUCKET_COUNT ]; /**< Rows hashed on the IP-address. */
+            NDIndexLinks_t xLinks[ ipconfigND_CACHE_ENTRIES ];  /**< The links of each row. */
+            uint16_t usNewest;                                  /**< The most recently used row. */
+            uint16_t usOldest;                                  /**< The least recently used row. */
+            uint16_t usFree;                                    /**< The first released row. */
+            uint16_t usUnused;                                  /**< The rows from this index onwards were never used. */
+        } NDIndex_t;
+
+/** @brief The index of the ND cache. */
+        static NDIndex_t xNDIndex;
+
+    #endif /* ( ipconfigUSE_ND_HASH_TABLE != 0 ) */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -107,6 +179,226 @@
  *  ff02::a: All EIGRP (IPv6) routers
  */
 
+    #if ( ipconfigUSE_ND_HASH_TABLE != 0 )
+
+/**
+ * @brief Calculate the bucket of an IPv6 address.
+ *
+ * @param[in] pxIPAddress The IPv6 address.
+ *
+ * @return The bucket number.
+ */
+        static uint32_t prvNDHashIP( const IPv6_Address_t * pxIPAddress )
+        {
+            uint32_t ulHash = 0U;
+            size_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < ( size_t ) ipSIZE_OF_IPv6_ADDRESS; uxIndex++ )
+            {
+                ulHash = ( ( ulHash << 5 ) | ( ulHash >> 27 ) ) ^ ( uint32_t ) pxIPAddress->ucBytes[ uxIndex ];
+            }
+
+            ulHash ^= ulHash >> 16;
+            ulHash ^= ulHash >> 8;
+
+            return ulHash & ndHASH_MASK;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the valid row that holds an IPv6 address.
+ *
+ * @param[in] pxIPAddress The IPv6 address to look for.
+ *
+ * @return The index of the row, or -1 when not found.
+ */
+        static BaseType_t prvNDIndexFind( const IPv6_Address_t * pxIPAddress )
+        {
+            BaseType_t xRow = -1;
+            uint16_t usLink = xNDIndex.usBuckets[ prvNDHashIP( pxIPAddress ) ];
+
+            while( usLink != 0U )
+            {
+                BaseType_t x = ndLINK_TO_ROW( usLink );
+
+                if( memcmp( xNDCache[ x ].xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                {
+                    xRow = x;
+                    break;
+                }
+
+                usLink = xNDIndex.xLinks[ x ].usNext;
+            }
+
+            return xRow;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a row from the LRU list.
+ *
+ * @param[in] xRow The row to be removed.
+ */
+        static void prvNDIndexRemoveFromLRU( BaseType_t xRow )
+        {
+            NDIndexLinks_t * pxLinks = &( xNDIndex.xLinks[ xRow ] );
+
+            if( pxLinks->usNewer != 0U )
+            {
+                xNDIndex.xLinks[ ndLINK_TO_ROW( pxLinks->usNewer ) ].usOlder = pxLinks->usOlder;
+            }
+            else
+            {
+                xNDIndex.usNewest = pxLinks->usOlder;
+            }
+
+            if( pxLinks->usOlder != 0U )
+            {
+                xNDIndex.xLinks[ ndLINK_TO_ROW( pxLinks->usOlder ) ].usNewer = pxLinks->usNewer;
+            }
+            else
+            {
+                xNDIndex.usOldest = pxLinks->usNewer;
+            }
+
+            pxLinks->usNewer = 0U;
+            pxLinks->usOlder = 0U;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a row to the LRU list as the most recently used one.
+ *
+ * @param[in] xRow The row to be added, it may not be in the list.
+ */
+        static void prvNDIndexAddToLRU( BaseType_t xRow )
+        {
+            xNDIndex.xLinks[ xRow ].usNewer = 0U;
+            xNDIndex.xLinks[ xRow ].usOlder = xNDIndex.usNewest;
+
+            if( xNDIndex.usNewest != 0U )
+            {
+                xNDIndex.xLinks[ ndLINK_TO_ROW( xNDIndex.usNewest ) ].usNewer = ndROW_TO_LINK( xRow );
+            }
+            else
+            {
+                xNDIndex.usOldest = ndROW_TO_LINK( xRow );
+            }
+
+            xNDIndex.usNewest = ndROW_TO_LINK( xRow );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Make an indexed row the most recently used one.
+ *
+ * @param[in] xRow The row that was used.
+ */
+        static void prvNDIndexTouch( BaseType_t xRow )
+        {
+            if( xNDIndex.usNewest != ndROW_TO_LINK( xRow ) )
+            {
+                prvNDIndexRemoveFromLRU( xRow );
+                prvNDIndexAddToLRU( xRow );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a valid row to the index, after its IP-address has been set.
+ *
+ * @param[in] xRow The row to be added.
+ */
+        static void prvNDIndexLink( BaseType_t xRow )
+        {
+            uint16_t * pusHead = &( xNDIndex.usBuckets[ prvNDHashIP( &( xNDCache[ xRow ].xIPAddress ) ) ] );
+
+            xNDIndex.xLinks[ xRow ].usNext = *pusHead;
+            *pusHead = ndROW_TO_LINK( xRow );
+
+            prvNDIndexAddToLRU( xRow );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a valid row from the index, before its IP-address changes.
+ *
+ * @param[in] xRow The row to be removed.
+ */
+        static void prvNDIndexUnlink( BaseType_t xRow )
+        {
+            uint16_t * pusLink = &( xNDIndex.usBuckets[ prvNDHashIP( &( xNDCache[ xRow ].xIPAddress ) ) ] );
+
+            while( *pusLink != 0U )
+            {
+                uint16_t * pusNext = &( xNDIndex.xLinks[ ndLINK_TO_ROW( *pusLink ) ].usNext );
+
+                if( ndLINK_TO_ROW( *pusLink ) == xRow )
+                {
+                    *pusLink = *pusNext;
+                    *pusNext = 0U;
+                    break;
+                }
+
+                pusLink = pusNext;
+            }
+
+            prvNDIndexRemoveFromLRU( xRow );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Wipe a row. When the row was valid, it is moved to the free list.
+ *
+ * @param[in] xRow The row to be released.
+ */
+        static void prvNDIndexRelease( BaseType_t xRow )
+        {
+            if( xNDCache[ xRow ].ucValid != ( uint8_t ) pdFALSE )
+            {
+                prvNDIndexUnlink( xRow );
+                xNDIndex.xLinks[ xRow ].usOlder = xNDIndex.usFree;
+                xNDIndex.usFree = ndROW_TO_LINK( xRow );
+            }
+
+            ( void ) memset( &( xNDCache[ xRow ] ), 0, sizeof( NDCacheRow_t ) );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get a row for a new entry: a released row, a row that was never used,
+ *        or else the least recently used row, which is unlinked.
+ *
+ * @return The index of the row.
+ */
+        static BaseType_t prvNDIndexAllocate( void )
+        {
+            BaseType_t xRow;
+
+            if( xNDIndex.usFree != 0U )
+            {
+                xRow = ndLINK_TO_ROW( xNDIndex.usFree );
+                xNDIndex.usFree = xNDIndex.xLinks[ xRow ].usOlder;
+                xNDIndex.xLinks[ xRow ].usOlder = 0U;
+            }
+            else if( xNDIndex.usUnused < ( uint16_t ) ipconfigND_CACHE_ENTRIES )
+            {
+                xRow = ( BaseType_t ) xNDIndex.usUnused;
+                xNDIndex.usUnused++;
+            }
+            else
+            {
+                /* All rows are valid, replace the least recently used one. */
+                xRow = ndLINK_TO_ROW( xNDIndex.usOldest );
+                prvNDIndexUnlink( xRow );
+            }
+
+            return xRow;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_ND_HASH_TABLE != 0 ) */
+
 /**
  * @brief Find the first end-point of type IPv6.
  *
@@ -241,23 +533,55 @@
                 }
                 else
                 {
-                    pxEndPoint = FreeRTOS_FindGateWay( ( BaseType_t ) ipTYPE_IPv6 );
+                    #if ( ipconfigUSE_STATIC_ROUTES != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 )
+                        IP_Address_t xDestination;
+                        IP_Address_t xNextHop;
 
-                    if( pxEndPoint != NULL )
-                    {
-                        ( void ) memcpy( pxIPAddress->ucBytes, pxEndPoint->ipv6_settings.xGatewayAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
-                        FreeRTOS_printf( ( "eNDGetCacheEntry: Using gw %pip\n", ( void * ) pxIPAddress->ucBytes ) );
-                        FreeRTOS_printf( ( "eNDGetCacheEntry: From addr %pip\n", ( void * ) pxEndPoint->ipv6_settings.xIPAddress.ucBytes ) );
+                        /* A static route takes precedence over the default gateway. */
+                        ( void ) memcpy( xDestination.xIP_IPv6.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                        pxEndPoint = FreeRTOS_FindRoute( &xDestination, ( BaseType_t ) ipTYPE_IPv6, &xNextHop );
+
+                        if( pxEndPoint != NULL )
+                        {
+                            ( void ) memcpy( pxIPAddress->ucBytes, xNextHop.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                            FreeRTOS_printf( ( "eNDGetCacheEntry: Using route via %pip\n", ( void * ) pxIPAddress->ucBytes ) );
 
-                        /* See if the gateway has an entry in the cache. */
-                        eReturn = prvNDCacheLookup( pxIPAddress, pxMACAddress, ppxEndPoint );
+                            eReturn = prvNDCacheLookup( pxIPAddress, pxMACAddress, ppxEndPoint );
+                            *( ppxEndPoint ) = pxEndPoint;
+                        }
+                        else
+                    #endif /* ( ipconfigUSE_STATIC_ROUTES != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 ) */
+                    {
+                        #if ( ipconfigUSE_ROUTE_ECMP != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 )
+                        {
+                            IP_Address_t xRemoteAddress;
 
-                        if( *ppxEndPoint != NULL )
+                            /* Several uplinks may have a gateway, the destination selects one. */
+                            ( void ) memcpy( xRemoteAddress.xIP_IPv6.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                            pxEndPoint = FreeRTOS_FindGateWayForDestination( &( xRemoteAddress ), ( BaseType_t ) ipTYPE_IPv6 );
+                        }
+                        #else
                         {
-                            FreeRTOS_printf( ( "eNDGetCacheEntry: found end-point %pip\n", ( void * ) ( *ppxEndPoint )->ipv6_settings.xIPAddress.ucBytes ) );
+                            pxEndPoint = FreeRTOS_FindGateWay( ( BaseType_t ) ipTYPE_IPv6 );
                         }
+                        #endif
+
+                        if( pxEndPoint != NULL )
+                        {
+                            ( void ) memcpy( pxIPAddress->ucBytes, pxEndPoint->ipv6_settings.xGatewayAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                            FreeRTOS_printf( ( "eNDGetCacheEntry: Using gw %pip\n", ( void * ) pxIPAddress->ucBytes ) );
+                            FreeRTOS_printf( ( "eNDGetCacheEntry: From addr %pip\n", ( void * ) pxEndPoint->ipv6_settings.xIPAddress.ucBytes ) );
 
-                        *( ppxEndPoint ) = pxEndPoint;
+                            /* See if the gateway has an entry in the cache. */
+                            eReturn = prvNDCacheLookup( pxIPAddress, pxMACAddress, ppxEndPoint );
+
+                            if( *ppxEndPoint != NULL )
+                            {
+                                FreeRTOS_printf( ( "eNDGetCacheEntry: found end-point %pip\n", ( void * ) ( *ppxEndPoint )->ipv6_settings.xIPAddress.ucBytes ) );
+                            }
+
+                            *( ppxEndPoint ) = pxEndPoint;
+                        }
                     }
                 }
             }
@@ -280,59 +604,91 @@
                                const IPv6_Address_t * pxIPAddress,
                                NetworkEndPoint_t * pxEndPoint )
     {
-        BaseType_t x;
-        BaseType_t xFreeEntry = -1, xEntryFound = -1;
-        uint16_t xOldestValue = ipconfigMAX_ARP_AGE + 1;
-        BaseType_t xOldestEntry = 0;
+        BaseType_t xEntryFound = -1;
 
-        /* For each entry in the ND cache table. */
-        for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
+        vBringUpEndPointMilestone( pxEndPoint, eBringUpFirstNeighbour );
+
+        #if ( ipconfigUSE_ND_HASH_TABLE != 0 )
         {
-            if( xNDCache[ x ].ucValid == ( uint8_t ) pdFALSE )
-            {
-                if( xFreeEntry == -1 )
-                {
-                    xFreeEntry = x;
-                }
-            }
-            else if( memcmp( xNDCache[ x ].xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+            xEntryFound = prvNDIndexFind( pxIPAddress );
+
+            if( xEntryFound >= 0 )
             {
-                xEntryFound = x;
-                break;
+                prvNDIndexTouch( xEntryFound );
             }
             else
             {
-                /* Entry is valid but the IP-address doesn't match. */
-
-                /* Keep track of the oldest entry in case we need to overwrite it. The problem we are trying to avoid is
-                 * that there may be a queued packet in pxARPWaitingNetworkBuffer and we may have just received the
-                 * neighbor advertisement needed for that packet. If we don't store this network advertisement in cache,
-                 * the parting of the frame from pxARPWaitingNetworkBuffer will cause the sending of neighbor solicitation
-                 * and stores the frame in pxARPWaitingNetworkBuffer. This becomes a vicious circle with thousands of
-                 * neighbor solicitation/advertisement packets going back and forth because the ND cache is full.
-                 * Overwriting the oldest cache entry is not a fool-proof solution, but it's something. */
-                if( xNDCache[ x ].ucAge < xOldestValue )
+                if( ( xNDIndex.usFree == 0U ) && ( xNDIndex.usUnused >= ( uint16_t ) ipconfigND_CACHE_ENTRIES ) )
                 {
-                    xOldestValue = xNDCache[ x ].ucAge;
-                    xOldestEntry = x;
+                    FreeRTOS_printf( ( "vNDRefreshCacheEntry: Cache FULL! Overwriting least recently used entry with %02X-%02X-%02X-%02X-%02X-%02X\n", pxMACAddress->ucBytes[ 0 ], pxMACAddress->ucBytes[ 1 ], pxMACAddress->ucBytes[ 2 ], pxMACAddress->ucBytes[ 3 ], pxMACAddress->ucBytes[ 4 ], pxMACAddress->ucBytes[ 5 ] ) );
                 }
+
+                xEntryFound = prvNDIndexAllocate();
+                ( void ) memcpy( xNDCache[ xEntryFound ].xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                prvNDIndexLink( xEntryFound );
             }
-        }
 
-        if( xEntryFound < 0 )
+            /* The neighbour has just been heard from, so it is reachable. */
+            xNDCache[ xEntryFound ].ucState = ( uint8_t ) eNDStateReachable;
+            xNDCache[ xEntryFound ].ucStateTimer = ( uint8_t ) ndREACHABLE_TIME_PERIODS;
+        }
+        #else /* if ( ipconfigUSE_ND_HASH_TABLE != 0 ) */
         {
-            /* The IP-address was not found, use the first free location. */
-            if( xFreeEntry >= 0 )
+            BaseType_t x;
+            BaseType_t xFreeEntry = -1;
+            uint16_t xOldestValue = ipconfigMAX_ARP_AGE + 1;
+            BaseType_t xOldestEntry = 0;
+
+            /* For each entry in the ND cache table. */
+            for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
             {
-                xEntryFound = xFreeEntry;
+                if( xNDCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+                {
+                    if( xFreeEntry == -1 )
+                    {
+                        xFreeEntry = x;
+                    }
+                }
+                else if( memcmp( xNDCache[ x ].xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                {
+                    xEntryFound = x;
+                    break;
+                }
+                else
+                {
+                    /* Entry is valid but the IP-address doesn't match. */
+
+                    /* Keep track of the oldest entry in case we need to overwrite it. The problem we are trying to avoid is
+                     * that there may be a queued packet in pxARPWaitingNetworkBuffer and we may have just received the
+                     * neighbor advertisement needed for that packet. If we don't store this network advertisement in cache,
+                     * the parting of the frame from pxARPWaitingNetworkBuffer will cause the sending of neighbor solicitation
+                     * and stores the frame in pxARPWaitingNetworkBuffer. This becomes a vicious circle with thousands of
+                     * neighbor solicitation/advertisement packets going back and forth because the ND cache is full.
+                     * Overwriting the oldest cache entry is not a fool-proof solution, but it's something. */
+                    if( xNDCache[ x ].ucAge < xOldestValue )
+                    {
+                        xOldestValue = xNDCache[ x ].ucAge;
+                        xOldestEntry = x;
+                    }
+                }
             }
-            else
+
+            if( xEntryFound < 0 )
             {
-                /* No free location. Overwrite the oldest. */
-                xEntryFound = xOldestEntry;
-                FreeRTOS_printf( ( "vNDRefreshCacheEntry: Cache FULL! Overwriting oldest entry %i with %02X-%02X-%02X-%02X-%02X-%02X\n", ( int ) xEntryFound, pxMACAddress->ucBytes[ 0 ], pxMACAddress->ucBytes[ 1 ], pxMACAddress->ucBytes[ 2 ], pxMACAddress->ucBytes[ 3 ], pxMACAddress->ucBytes[ 4 ], pxMACAddress->ucBytes[ 5 ] ) );
+                /* The IP-address was not found, use the first free location. */
+                if( xFreeEntry >= 0 )
+                {
+                    xEntryFound = xFreeEntry;
+                }
+                else
+                {
+                    /* No free location. Overwrite the oldest. */
+                    xEntryFound = xOldestEntry;
+                    FreeRTOS_printf( ( "vNDRefreshCacheEntry: Cache FULL! Overwriting oldest entry %i with %02X-%02X-%02X-%02X-%02X-%02X\n", ( int ) xEntryFound, pxMACAddress->ucBytes[ 0 ], pxMACAddress->ucBytes[ 1 ], pxMACAddress->ucBytes[ 2 ], pxMACAddress->ucBytes[ 3 ], pxMACAddress->ucBytes[ 4 ], pxMACAddress->ucBytes[ 5 ] ) );
+                }
             }
         }
+        #endif /* if ( ipconfigUSE_ND_HASH_TABLE != 0 ) */
 
         /* At this point, xEntryFound is always a valid index. */
         /* Copy the IP-address. */
@@ -342,9 +698,113 @@
         xNDCache[ xEntryFound ].pxEndPoint = pxEndPoint;
         xNDCache[ xEntryFound ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
         xNDCache[ xEntryFound ].ucValid = ( uint8_t ) pdTRUE;
+
+        #if ( ipHEADER_CACHE != 0 )
+        {
+            vIPHeaderCacheInvalidate();
+        }
+        #endif
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_ND_HASH_TABLE != 0 )
+
+/**
+ * @brief Send a unicast neighbour solicitation for an entry in the ND cache.
+ *
+ * @param[in] x The index of the entry.
+ */
+        static void prvNDProbeEntry( BaseType_t x )
+        {
+            size_t uxNeededSize = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + sizeof( ICMPHeader_IPv6_t );
+            NetworkBufferDescriptor_t * pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxNeededSize, 0U );
+
+            if( pxNetworkBuffer != NULL )
+            {
+                pxNetworkBuffer->pxEndPoint = xNDCache[ x ].pxEndPoint;
+                prvNDSendSolicitation( pxNetworkBuffer, &( xNDCache[ x ].xIPAddress ), &( xNDCache[ x ].xMACAddress ) );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Age a valid entry of the ND cache by one period and move it through
+ *        the reachability states of RFC 4861. The entry is deleted when its
+ *        age reaches zero, or when the neighbour did not answer the probes.
+ *
+ * @param[in] x The index of the entry.
+ */
+        static void prvNDAgeEntry( BaseType_t x )
+        {
+            BaseType_t xDelete = pdFALSE;
+
+            ( xNDCache[ x ].ucAge )--;
+
+            if( xNDCache[ x ].ucStateTimer > 0U )
+            {
+                ( xNDCache[ x ].ucStateTimer )--;
+            }
+
+            switch( xNDCache[ x ].ucState )
+            {
+                case eNDStateReachable:
+
+                    if( xNDCache[ x ].ucStateTimer == 0U )
+                    {
+                        xNDCache[ x ].ucState = ( uint8_t ) eNDStateStale;
+                    }
+
+                    break;
+
+                case eNDStateDelay:
+
+                    if( xNDCache[ x ].ucStateTimer == 0U )
+                    {
+                        /* Not confirmed in time, start probing the neighbour. */
+                        iptraceND_TABLE_ENTRY_WILL_EXPIRE( xNDCache[ x ].xIPAddress );
+                        xNDCache[ x ].ucState = ( uint8_t ) eNDStateProbe;
+                        xNDCache[ x ].ucStateTimer = ( uint8_t ) ndMAX_UNICAST_SOLICIT;
+                        prvNDProbeEntry( x );
+                    }
+
+                    break;
+
+                case eNDStateProbe:
+
+                    if( xNDCache[ x ].ucStateTimer == 0U )
+                    {
+                        /* The neighbour did not answer any of the probes. */
+                        xDelete = pdTRUE;
+                    }
+                    else
+                    {
+                        prvNDProbeEntry( x );
+                    }
+
+                    break;
+
+                default:
+                    /* A stale entry stays until it is used or gets too old. */
+                    break;
+            }
+
+            if( ( xNDCache[ x ].ucAge == 0U ) || ( xDelete != pdFALSE ) )
+            {
+                /* The entry is no longer valid.  Wipe it out. */
+                iptraceND_TABLE_ENTRY_EXPIRED( xNDCache[ x ].xIPAddress );
+                prvNDIndexRelease( x );
+
+                #if ( ipHEADER_CACHE != 0 )
+                {
+                    vIPHeaderCacheInvalidate();
+                }
+                #endif
+            }
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_ND_HASH_TABLE != 0 ) */
+
 /**
  * @brief Reduce the age counter in each entry within the ND cache.  An entry is no
  * longer considered valid and is deleted if its age reaches zero.
@@ -354,10 +814,23 @@
     {
         BaseType_t x;
 
+        #if ( ipconfigUSE_ND_HASH_TABLE != 0 )
+        {
+            /* Loop through the rows that were ever used. */
+            for( x = 0; x < ( BaseType_t ) xNDIndex.usUnused; x++ )
+            {
+                if( xNDCache[ x ].ucValid != ( uint8_t ) pdFALSE )
+                {
+                    prvNDAgeEntry( x );
+                }
+            }
+        }
+        #else /* if ( ipconfigUSE_ND_HASH_TABLE != 0 ) */
         /* Loop through each entry in the ND cache. */
         for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
         {
             BaseType_t xDoSolicitate = pdFALSE;
+            const MACAddress_t * pxUnicastMAC = NULL;
 
             /* If the entry is valid (its age is greater than zero). */
             if( xNDCache[ x ].ucAge > 0U )
@@ -371,6 +844,12 @@
                     /* The entry is no longer valid.  Wipe it out. */
                     iptraceND_TABLE_ENTRY_EXPIRED( xNDCache[ x ].xIPAddress );
                     ( void ) memset( &( xNDCache[ x ] ), 0, sizeof( xNDCache[ x ] ) );
+
+                    #if ( ipHEADER_CACHE != 0 )
+                    {
+                        vIPHeaderCacheInvalidate();
+                    }
+                    #endif
                 }
                 else
                 {
@@ -380,18 +859,40 @@
                     {
                         xDoSolicitate = pdTRUE;
                     }
-                    else if( xNDCache[ x ].ucAge <= ( uint8_t ) ndMAX_CACHE_AGE_BEFORE_NEW_ND_SOLICITATION )
+                    else if( xNDCache[ x ].ucAge <= ndREFRESH_AGE )
                     {
-                        /* This entry will get removed soon.  See if the MAC address is
-                         * still valid to prevent this happening. */
-                        iptraceND_TABLE_ENTRY_WILL_EXPIRE( xNDCache[ x ].xIPAddress );
-                        xDoSolicitate = pdTRUE;
+                        #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+                        {
+                            /* Only refresh the neighbours that were used during the
+                             * last period, and ask them directly. Unused entries
+                             * may expire. */
+                            if( xNDCache[ x ].ucUsed != 0U )
+                            {
+                                iptraceND_TABLE_ENTRY_WILL_EXPIRE( xNDCache[ x ].xIPAddress );
+                                xDoSolicitate = pdTRUE;
+                                pxUnicastMAC = &( xNDCache[ x ].xMACAddress );
+                            }
+                        }
+                        #else
+                        {
+                            /* This entry will get removed soon.  See if the MAC address is
+                             * still valid to prevent this happening. */
+                            iptraceND_TABLE_ENTRY_WILL_EXPIRE( xNDCache[ x ].xIPAddress );
+                            xDoSolicitate = pdTRUE;
+                        }
+                        #endif /* if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 ) */
                     }
                     else
                     {
                         /* The age has just ticked down, with nothing to do. */
                     }
 
+                    #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+                    {
+                        xNDCache[ x ].ucUsed = 0U;
+                    }
+                    #endif
+
                     if( xDoSolicitate != pdFALSE )
                     {
                         size_t uxNeededSize;
@@ -404,12 +905,13 @@
                         {
                             pxNetworkBuffer->pxEndPoint = xNDCache[ x ].pxEndPoint;
                             /* _HT_ From here I am suspecting a network buffer leak */
-                            vNDSendNeighbourSolicitation( pxNetworkBuffer, &( xNDCache[ x ].xIPAddress ) );
+                            prvNDSendSolicitation( pxNetworkBuffer, &( xNDCache[ x ].xIPAddress ), pxUnicastMAC );
                         }
                     }
                 }
             }
         }
+        #endif /* if ( ipconfigUSE_ND_HASH_TABLE != 0 ) */
     }
 /*-----------------------------------------------------------*/
 
@@ -419,9 +921,174 @@
     void FreeRTOS_ClearND( void )
     {
         ( void ) memset( xNDCache, 0, sizeof( xNDCache ) );
+
+        #if ( ipconfigUSE_ND_HASH_TABLE != 0 )
+        {
+            ( void ) memset( &( xNDIndex ), 0, sizeof( xNDIndex ) );
+        }
+        #endif
+
+        #if ( ipHEADER_CACHE != 0 )
+        {
+            vIPHeaderCacheInvalidate();
+        }
+        #endif
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigND_STATIC_ENTRIES > 0 )
+
+/**
+ * @brief Find a permanent entry.
+ *
+ * @param[in] pxIPAddress The IPv6 address to look for.
+ *
+ * @return The row in xNDStaticCache[], or -1 when not found.
+ */
+        static BaseType_t prvNDStaticFind( const IPv6_Address_t * pxIPAddress )
+        {
+            BaseType_t x;
+            BaseType_t xReturn = -1;
+
+            for( x = 0; x < ipconfigND_STATIC_ENTRIES; x++ )
+            {
+                if( ( xNDStaticCache[ x ].ucValid != ( uint8_t ) pdFALSE ) &&
+                    ( memcmp( xNDStaticCache[ x ].xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) )
+                {
+                    xReturn = x;
+                    break;
+                }
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a permanent IPv6 to MAC address mapping, or change an existing
+ *        one.  The entry is found before the ND cache, it never expires and
+ *        received advertisements do not change it.  It may be called before
+ *        FreeRTOS_IPInit_Multi().
+ *
+ * @param[in] pxIPAddress The IPv6 address of the host.
+ * @param[in] pxMACAddress The MAC-address of the host.
+ * @param[in] pxEndPoint The end-point through which the host is reached.
+ *
+ * @return pdPASS when the entry was stored, pdFAIL when a parameter is
+ *         invalid or when all ipconfigND_STATIC_ENTRIES rows are taken.
+ */
+        BaseType_t FreeRTOS_AddStaticNDEntry( const IPv6_Address_t * pxIPAddress,
+                                              const MACAddress_t * pxMACAddress,
+                                              struct xNetworkEndPoint * pxEndPoint )
+        {
+            BaseType_t x;
+            BaseType_t xRow;
+            BaseType_t xReturn = pdFAIL;
+
+            if( ( pxIPAddress != NULL ) && ( pxMACAddress != NULL ) && ( pxEndPoint != NULL ) )
+            {
+                /* The IP-task reads the table without a lock. */
+                vTaskSuspendAll();
+                {
+                    xRow = prvNDStaticFind( pxIPAddress );
+
+                    for( x = 0; ( xRow < 0 ) && ( x < ipconfigND_STATIC_ENTRIES ); x++ )
+                    {
+                        if( xNDStaticCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+                        {
+                            xRow = x;
+                        }
+                    }
+
+                    if( xRow >= 0 )
+                    {
+                        ( void ) memcpy( xNDStaticCache[ xRow ].xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                        ( void ) memcpy( xNDStaticCache[ xRow ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( MACAddress_t ) );
+                        xNDStaticCache[ xRow ].pxEndPoint = pxEndPoint;
+                        xNDStaticCache[ xRow ].ucValid = ( uint8_t ) pdTRUE;
+
+                        #if ( ipHEADER_CACHE != 0 )
+                        {
+                            vIPHeaderCacheInvalidate();
+                        }
+                        #endif
+
+                        xReturn = pdPASS;
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a permanent entry that was added by FreeRTOS_AddStaticNDEntry().
+ *
+ * @param[in] pxIPAddress The IPv6 address of the entry.
+ *
+ * @return pdPASS when the entry was found and removed, otherwise pdFAIL.
+ */
+        BaseType_t FreeRTOS_RemoveStaticNDEntry( const IPv6_Address_t * pxIPAddress )
+        {
+            BaseType_t xRow;
+            BaseType_t xReturn = pdFAIL;
+
+            if( pxIPAddress != NULL )
+            {
+                vTaskSuspendAll();
+                {
+                    xRow = prvNDStaticFind( pxIPAddress );
+
+                    if( xRow >= 0 )
+                    {
+                        ( void ) memset( &( xNDStaticCache[ xRow ] ), 0, sizeof( NDCacheRow_t ) );
+
+                        #if ( ipHEADER_CACHE != 0 )
+                        {
+                            vIPHeaderCacheInvalidate();
+                        }
+                        #endif
+
+                        xReturn = pdPASS;
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigND_STATIC_ENTRIES > 0 ) */
+
+    #if ( ipconfigUSE_RESOURCE_STATS != 0 )
+
+/**
+ * @brief Count the rows of the ND cache that hold an IP-address, either
+ *        resolved or waiting for a reply.
+ *
+ * @return The number of occupied rows.
+ */
+        UBaseType_t uxNDCacheRowsInUse( void )
+        {
+            BaseType_t x;
+            UBaseType_t uxCount = 0U;
+
+            for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
+            {
+                if( memcmp( xNDCache[ x ].xIPAddress.ucBytes, FreeRTOS_in6addr_any.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) != 0 )
+                {
+                    uxCount++;
+                }
+            }
+
+            return uxCount;
+        }
+    #endif /* ( ipconfigUSE_RESOURCE_STATS != 0 ) */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Look-up an IPv6 address in the cache.
  *
@@ -438,14 +1105,27 @@
         BaseType_t x;
         eARPLookupResult_t eReturn = eARPCacheMiss;
 
-        /* For each entry in the ND cache table. */
-        for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
-        {
-            if( xNDCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+        #if ( ipconfigND_STATIC_ENTRIES > 0 )
+            x = prvNDStaticFind( pxAddressToLookup );
+
+            if( x >= 0 )
             {
-                /* Skip invalid entries. */
+                /* A permanent entry: no need to touch or refresh it. */
+                ( void ) memcpy( pxMACAddress->ucBytes, xNDStaticCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                eReturn = eARPCacheHit;
+
+                if( ppxEndPoint != NULL )
+                {
+                    *ppxEndPoint = xNDStaticCache[ x ].pxEndPoint;
+                }
             }
-            else if( memcmp( xNDCache[ x ].xIPAddress.ucBytes, pxAddressToLookup->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+            else
+        #endif
+        #if ( ipconfigUSE_ND_HASH_TABLE != 0 )
+        {
+            x = prvNDIndexFind( pxAddressToLookup );
+
+            if( x >= 0 )
             {
                 ( void ) memcpy( pxMACAddress->ucBytes, xNDCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
                 eReturn = eARPCacheHit;
@@ -455,22 +1135,60 @@
                     *ppxEndPoint = xNDCache[ x ].pxEndPoint;
                 }
 
-                FreeRTOS_debug_printf( ( "prvCacheLookup6[ %d ] %pip with %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                         ( int ) x,
-                                         ( void * ) pxAddressToLookup->ucBytes,
-                                         pxMACAddress->ucBytes[ 0 ],
-                                         pxMACAddress->ucBytes[ 1 ],
-                                         pxMACAddress->ucBytes[ 2 ],
-                                         pxMACAddress->ucBytes[ 3 ],
-                                         pxMACAddress->ucBytes[ 4 ],
-                                         pxMACAddress->ucBytes[ 5 ] ) );
-                break;
+                prvNDIndexTouch( x );
+
+                if( xNDCache[ x ].ucState == ( uint8_t ) eNDStateStale )
+                {
+                    /* A stale entry is being used: give upper layers a moment to
+                     * confirm reachability before probing the neighbour. */
+                    xNDCache[ x ].ucState = ( uint8_t ) eNDStateDelay;
+                    xNDCache[ x ].ucStateTimer = ( uint8_t ) ndDELAY_FIRST_PROBE_PERIODS;
+                }
             }
-            else
+        }
+        #else /* if ( ipconfigUSE_ND_HASH_TABLE != 0 ) */
+        {
+            /* For each entry in the ND cache table. */
+            for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
             {
-                /* Entry is valid but the MAC-address doesn't match. */
+                if( xNDCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+                {
+                    /* Skip invalid entries. */
+                }
+                else if( memcmp( xNDCache[ x ].xIPAddress.ucBytes, pxAddressToLookup->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                {
+                    ( void ) memcpy( pxMACAddress->ucBytes, xNDCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                    eReturn = eARPCacheHit;
+
+                    #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+                    {
+                        xNDCache[ x ].ucUsed = 1U;
+                    }
+                    #endif
+
+                    if( ppxEndPoint != NULL )
+                    {
+                        *ppxEndPoint = xNDCache[ x ].pxEndPoint;
+                    }
+
+                    FreeRTOS_debug_printf( ( "prvCacheLookup6[ %d ] %pip with %02x:%02x:%02x:%02x:%02x:%02x\n",
+                                             ( int ) x,
+                                             ( void * ) pxAddressToLookup->ucBytes,
+                                             pxMACAddress->ucBytes[ 0 ],
+                                             pxMACAddress->ucBytes[ 1 ],
+                                             pxMACAddress->ucBytes[ 2 ],
+                                             pxMACAddress->ucBytes[ 3 ],
+                                             pxMACAddress->ucBytes[ 4 ],
+                                             pxMACAddress->ucBytes[ 5 ] ) );
+                    break;
+                }
+                else
+                {
+                    /* Entry is valid but the MAC-address doesn't match. */
+                }
             }
         }
+        #endif /* if ( ipconfigUSE_ND_HASH_TABLE != 0 ) */
 
         if( eReturn == eARPCacheMiss )
         {
@@ -580,6 +1298,24 @@
 
     void vNDSendNeighbourSolicitation( NetworkBufferDescriptor_t * pxNetworkBuffer,
                                        const IPv6_Address_t * pxIPAddress )
+    {
+        prvNDSendSolicitation( pxNetworkBuffer, pxIPAddress, NULL );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send a neighbour solicitation for an IPv6 address.
+ *
+ * @param[in] pxNetworkBuffer The network buffer in which the message shall be stored.
+ * @param[in] pxIPAddress The IPv6 address that is asked to send a Neighbour Advertisement.
+ * @param[in] pxMACAddress When not NULL, the solicitation is sent directly to this
+ *                         MAC-address and IPv6 address, as when probing a known
+ *                         neighbour. Otherwise it goes to the solicited-node
+ *                         multicast address.
+ */
+    static void prvNDSendSolicitation( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                       const IPv6_Address_t * pxIPAddress,
+                                       const MACAddress_t * pxMACAddress )
     {
         ICMPPacket_IPv6_t * pxICMPPacket;
         ICMPHeader_IPv6_t * pxICMPHeader_IPv6;
@@ -614,13 +1350,21 @@
 
                 pxDescriptor->xDataLength = uxNeededSize;
 
-                /* Set the multi-cast MAC-address. */
-                xMultiCastMacAddress.ucBytes[ 0 ] = 0x33U;
-                xMultiCastMacAddress.ucBytes[ 1 ] = 0x33U;
-                xMultiCastMacAddress.ucBytes[ 2 ] = 0xffU;
-                xMultiCastMacAddress.ucBytes[ 3 ] = pxIPAddress->ucBytes[ 13 ];
-                xMultiCastMacAddress.ucBytes[ 4 ] = pxIPAddress->ucBytes[ 14 ];
-                xMultiCastMacAddress.ucBytes[ 5 ] = pxIPAddress->ucBytes[ 15 ];
+                if( pxMACAddress != NULL )
+                {
+                    /* A unicast probe of a known neighbour. */
+                    ( void ) memcpy( xMultiCastMacAddress.ucBytes, pxMACAddress->ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+                }
+                else
+                {
+                    /* Set the multi-cast MAC-address. */
+                    xMultiCastMacAddress.ucBytes[ 0 ] = 0x33U;
+                    xMultiCastMacAddress.ucBytes[ 1 ] = 0x33U;
+                    xMultiCastMacAddress.ucBytes[ 2 ] = 0xffU;
+                    xMultiCastMacAddress.ucBytes[ 3 ] = pxIPAddress->ucBytes[ 13 ];
+                    xMultiCastMacAddress.ucBytes[ 4 ] = pxIPAddress->ucBytes[ 14 ];
+                    xMultiCastMacAddress.ucBytes[ 5 ] = pxIPAddress->ucBytes[ 15 ];
+                }
 
                 /* Set Ethernet header. Source and Destination will be swapped. */
                 ( void ) memcpy( pxICMPPacket->xEthernetHeader.xSourceAddress.ucBytes, xMultiCastMacAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
@@ -638,15 +1382,22 @@
                 /* Source address */
                 ( void ) memcpy( pxICMPPacket->xIPHeader.xSourceAddress.ucBytes, pxEndPoint->ipv6_settings.xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
 
-                /*ff02::1:ff5a:afe7 */
-                ( void ) memset( xTargetIPAddress.ucBytes, 0, sizeof( xTargetIPAddress.ucBytes ) );
-                xTargetIPAddress.ucBytes[ 0 ] = 0xff;
-                xTargetIPAddress.ucBytes[ 1 ] = 0x02;
-                xTargetIPAddress.ucBytes[ 11 ] = 0x01;
-                xTargetIPAddress.ucBytes[ 12 ] = 0xff;
-                xTargetIPAddress.ucBytes[ 13 ] = pxIPAddress->ucBytes[ 13 ];
-                xTargetIPAddress.ucBytes[ 14 ] = pxIPAddress->ucBytes[ 14 ];
-                xTargetIPAddress.ucBytes[ 15 ] = pxIPAddress->ucBytes[ 15 ];
+                if( pxMACAddress != NULL )
+                {
+                    ( void ) memcpy( xTargetIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                }
+                else
+                {
+                    /*ff02::1:ff5a:afe7 */
+                    ( void ) memset( xTargetIPAddress.ucBytes, 0, sizeof( xTargetIPAddress.ucBytes ) );
+                    xTargetIPAddress.ucBytes[ 0 ] = 0xff;
+                    xTargetIPAddress.ucBytes[ 1 ] = 0x02;
+                    xTargetIPAddress.ucBytes[ 11 ] = 0x01;
+                    xTargetIPAddress.ucBytes[ 12 ] = 0xff;
+                    xTargetIPAddress.ucBytes[ 13 ] = pxIPAddress->ucBytes[ 13 ];
+                    xTargetIPAddress.ucBytes[ 14 ] = pxIPAddress->ucBytes[ 14 ];
+                    xTargetIPAddress.ucBytes[ 15 ] = pxIPAddress->ucBytes[ 15 ];
+                }
                 ( void ) memcpy( pxICMPPacket->xIPHeader.xDestinationAddress.ucBytes, xTargetIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
 
                 /* Set ICMP header. */
@@ -984,8 +1735,28 @@
         {
             switch( pxICMPHeader_IPv6->ucTypeOfMessage )
             {
+                #if ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
+                    case ipICMP_PACKET_TOO_BIG_IPv6:
+                       {
+                           /* The MTU takes the place of 'ulReserved', it is followed by
+                            * the IPv6 header of the packet that was too big. */
+                           size_t uxQuotedOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + 8U;
+
+                           if( pxNetworkBuffer->xDataLength > uxQuotedOffset )
+                           {
+                               vTCPPathMTUReport( pdTRUE,
+                                                  &( pxNetworkBuffer->pucEthernetBuffer[ uxQuotedOffset ] ),
+                                                  pxNetworkBuffer->xDataLength - uxQuotedOffset,
+                                                  FreeRTOS_ntohl( pxICMPHeader_IPv6->ulReserved ) );
+                           }
+                       }
+                       break;
+                #endif /* ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 ) */
+
                 case ipICMP_DEST_UNREACHABLE_IPv6:
-                case ipICMP_PACKET_TOO_BIG_IPv6:
+                #if ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY == 0 )
+                    case ipICMP_PACKET_TOO_BIG_IPv6:
+                #endif
                 case ipICMP_TIME_EXCEEDED_IPv6:
                 case ipICMP_PARAMETER_PROBLEM_IPv6:
                     /* These message types are not implemented. They are logged here above. */
@@ -1007,6 +1778,21 @@
                            break;
                        }
 
+                       #if ( ipconfigUSE_ICMP_RATE_LIMIT != 0 )
+                       {
+                           IP_Address_t xSource;
+
+                           ( void ) memset( &( xSource ), 0, sizeof( xSource ) );
+                           ( void ) memcpy( xSource.xIP_IPv6.ucBytes, pxICMPPacket->xIPHeader.xSourceAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+                           if( xICMPRateLimitCheck( eICMPRateEchoReply_IPv6, &( xSource ) ) == pdFALSE )
+                           {
+                               ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropRateLimited );
+                               break;
+                           }
+                       }
+                       #endif /* ( ipconfigUSE_ICMP_RATE_LIMIT != 0 ) */
+
                        pxICMPHeader_IPv6->ucTypeOfMessage = ipICMP_PING_REPLY_IPv6;
 
                        /* MISRA Ref 4.14.1 [The validity of values received from external sources]. */
@@ -1085,11 +1871,35 @@
                                           ( void * ) pxNetworkBuffer->pxEndPoint->ipv6_settings.xIPAddress.ucBytes,
                                           ( xCompare == 0 ) ? "Reply" : "Ignore" ) );
 
+                       #if ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 )
+                       {
+                           /* See if another device is doing DAD for an address that is being tested. */
+                           vReceiveNS( pxNetworkBuffer );
+
+                           if( ( pxTargetedEndPoint->xRAData.bits.bOptimistic != pdFALSE_UNSIGNED ) &&
+                               ( memcmp( pxICMPPacket->xIPHeader.xSourceAddress.ucBytes, FreeRTOS_in6addr_any.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) )
+                           {
+                               /* RFC 4429: do not defend an optimistic address. */
+                               xCompare = 1;
+                           }
+                       }
+                       #endif
+
                        if( xCompare == 0 )
                        {
                            pxICMPHeader_IPv6->ucTypeOfMessage = ipICMP_NEIGHBOR_ADVERTISEMENT_IPv6;
                            pxICMPHeader_IPv6->ucTypeOfService = 0U;
                            pxICMPHeader_IPv6->ulReserved = ndICMPv6_FLAG_SOLICITED | ndICMPv6_FLAG_UPDATE;
+
+                           #if ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 )
+                               if( pxTargetedEndPoint->xRAData.bits.bOptimistic != pdFALSE_UNSIGNED )
+                               {
+                                   /* RFC 4429: an optimistic address may not override the
+                                    * cache entries of other devices. */
+                                   pxICMPHeader_IPv6->ulReserved = ndICMPv6_FLAG_SOLICITED;
+                               }
+                           #endif
+
                            pxICMPHeader_IPv6->ulReserved = FreeRTOS_htonl( pxICMPHeader_IPv6->ulReserved );
 
                            /* Type of option. */
@@ -1121,6 +1931,12 @@
                         vReceiveNA( pxNetworkBuffer );
                     #endif
 
+                    #if ( ipconfigARP_WAITING_BUFFER_COUNT > 1 )
+                    {
+                        vIPWaitingBuffersResolved( 0U, &( pxICMPHeader_IPv6->xIPv6Address ) );
+                    }
+                    #endif
+
                     if( ( pxARPWaitingNetworkBuffer != NULL ) &&
                         ( uxIPHeaderSizePacket( pxARPWaitingNetworkBuffer ) == ipSIZE_OF_IPv6_HEADER ) )
                     {
@@ -1132,6 +1948,12 @@
                 case ipICMP_ROUTER_SOLICITATION_IPv6:
                     break;
 
+                    #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+                        case ipICMP_MULTICAST_LISTENER_QUERY_IPv6:
+                            vProcessMLDQuery( pxNetworkBuffer );
+                            break;
+                    #endif /* ( ipconfigSUPPORT_IP_MULTICAST != 0 ) */
+
                     #if ( ipconfigUSE_RA != 0 )
                         case ipICMP_ROUTER_ADVERTISEMENT_IPv6:
                             vReceiveRA( pxNetworkBuffer );
@@ -1232,7 +2054,7 @@
             #endif
 
             /* Set the parameter 'bReleaseAfterSend'. */
-            ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+            ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, pdTRUE );
         }
     }
 /*-----------------------------------------------------------*/
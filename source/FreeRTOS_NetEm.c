@@ -0,0 +1,654 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_NetEm.c
+ * @brief Implements the network emulator: it holds the frames of an interface
+ *        for a while to impose delay, jitter, a limited bandwidth, loss,
+ *        duplication and reordering, in order to test the TCP stack under
+ *        reproducible conditions.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_NetEm.h"
+#include "NetworkInterface.h"
+#include "NetworkBufferManagement.h"
+
+/* *INDENT-OFF* */
+#if ( ipconfigUSE_NETWORK_EMULATION != 0 )
+/* *INDENT-ON* */
+
+/** @brief The chances are expressed in parts per million. */
+#define ipNETEM_PPM_RANGE    ( 1000000U )
+
+/** @brief pdTRUE when tick count 'xA' lies before tick count 'xB'. */
+#define ipNETEM_IS_BEFORE( xA, xB ) \
+    ( ( ( TickType_t ) ( ( xA ) - ( xB ) ) ) > ( ( ( TickType_t ) ~( ( TickType_t ) 0U ) ) >> 1 ) )
+
+/** @brief The emulators that have been attached. */
+static NetEm_t * pxNetEmList = NULL;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the emulator that is attached to an interface.
+ *
+ * @param[in] pxInterface The interface.
+ *
+ * @return The emulator, or NULL when the interface has none.
+ */
+static NetEm_t * prvNetEmFind( const NetworkInterface_t * pxInterface )
+{
+    NetEm_t * pxNetEm;
+
+    for( pxNetEm = pxNetEmList; pxNetEm != NULL; pxNetEm = pxNetEm->pxNext )
+    {
+        if( pxNetEm->pxInterface == pxInterface )
+        {
+            break;
+        }
+    }
+
+    return pxNetEm;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A xorshift generator, so that a given seed always leads to the same
+ *        decisions.
+ *
+ * @param[in] pxNetEm The emulator.
+ *
+ * @return The next pseudo-random number.
+ */
+static uint32_t prvNetEmRandom( NetEm_t * pxNetEm )
+{
+    uint32_t ulValue = pxNetEm->ulRandom;
+
+    ulValue ^= ulValue << 13;
+    ulValue ^= ulValue >> 17;
+    ulValue ^= ulValue << 5;
+    pxNetEm->ulRandom = ulValue;
+
+    return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Make a random decision.
+ *
+ * @param[in] pxNetEm The emulator.
+ * @param[in] ulPPM The chance in parts per million.
+ *
+ * @return pdTRUE with a chance of ulPPM.
+ */
+static BaseType_t prvNetEmChance( NetEm_t * pxNetEm,
+                                  uint32_t ulPPM )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    if( ulPPM != 0U )
+    {
+        if( ( prvNetEmRandom( pxNetEm ) % ipNETEM_PPM_RANGE ) < ulPPM )
+        {
+            xReturn = pdTRUE;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a direction has any impairment.
+ *
+ * @param[in] pxDirection The direction.
+ *
+ * @return pdTRUE when its frames can pass without being queued.
+ */
+static BaseType_t prvNetEmIsTransparent( const NetEmDirection_t * pxDirection )
+{
+    const NetEmParameters_t * pxParameters = &( pxDirection->xParameters );
+    BaseType_t xReturn = pdFALSE;
+
+    if( ( pxParameters->ulDelayMs == 0U ) &&
+        ( pxParameters->ulJitterMs == 0U ) &&
+        ( pxParameters->ulBytesPerSecond == 0U ) &&
+        ( pxParameters->ulLossPPM == 0U ) &&
+        ( pxParameters->ulDuplicatePPM == 0U ) &&
+        ( pxParameters->ulReorderPPM == 0U ) )
+    {
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate when a frame will leave the emulated link. The frame
+ *        first waits until the link has sent the frames before it, then it
+ *        takes the time to send its own bytes, plus the delay and the jitter.
+ *        Must be called with the scheduler suspended.
+ *
+ * @param[in] pxNetEm The emulator.
+ * @param[in] pxDirection The direction of the frame.
+ * @param[in] xLength The length of the frame.
+ *
+ * @return The due time of the frame.
+ */
+static TickType_t prvNetEmDueTime( NetEm_t * pxNetEm,
+                                   NetEmDirection_t * pxDirection,
+                                   size_t xLength )
+{
+    const NetEmParameters_t * pxParameters = &( pxDirection->xParameters );
+    TickType_t xNow = xTaskGetTickCount();
+    TickType_t xDueTime = xNow;
+    uint32_t ulBacklog;
+
+    if( pxParameters->ulBytesPerSecond != 0U )
+    {
+        if( ipNETEM_IS_BEFORE( pxDirection->xLinkFreeTime, xNow ) )
+        {
+            /* The link was idle. */
+            pxDirection->xLinkFreeTime = xNow;
+            pxDirection->ulRateRemainder = 0U;
+        }
+
+        /* Keep the fraction of a clock tick, or small frames on a fast link
+         * would not take any time at all. */
+        ulBacklog = ( ( uint32_t ) xLength * ( uint32_t ) configTICK_RATE_HZ ) + pxDirection->ulRateRemainder;
+        pxDirection->xLinkFreeTime += ( TickType_t ) ( ulBacklog / pxParameters->ulBytesPerSecond );
+        pxDirection->ulRateRemainder = ulBacklog % pxParameters->ulBytesPerSecond;
+        xDueTime = pxDirection->xLinkFreeTime;
+    }
+
+    if( prvNetEmChance( pxNetEm, pxParameters->ulReorderPPM ) != pdFALSE )
+    {
+        /* Let this frame overtake all frames that are queued. */
+        pxDirection->ulReordered++;
+        xDueTime = xNow;
+    }
+    else
+    {
+        xDueTime += pdMS_TO_TICKS( pxParameters->ulDelayMs );
+
+        if( pxParameters->ulJitterMs != 0U )
+        {
+            xDueTime += pdMS_TO_TICKS( prvNetEmRandom( pxNetEm ) % ( pxParameters->ulJitterMs + 1U ) );
+        }
+    }
+
+    return xDueTime;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a frame in the queue, after all frames that are due earlier or
+ *        at the same time.
+ *
+ * @param[in] pxNetEm The emulator.
+ * @param[in] pxDirection The direction of the frame.
+ * @param[in] pxBuffer The frame, which is owned by the emulator now.
+ * @param[in] xOutgoing pdTRUE for a frame to be sent.
+ */
+static void prvNetEmEnqueue( NetEm_t * pxNetEm,
+                             NetEmDirection_t * pxDirection,
+                             NetworkBufferDescriptor_t * pxBuffer,
+                             BaseType_t xOutgoing )
+{
+    NetworkBufferDescriptor_t * pxDropped = NULL;
+    TickType_t xDueTime;
+    UBaseType_t uxIndex;
+    BaseType_t xNewHead = pdFALSE;
+
+    vTaskSuspendAll();
+    {
+        if( pxNetEm->uxCount >= ( UBaseType_t ) ipconfigNETWORK_EMULATION_QUEUE_LENGTH )
+        {
+            /* The queue of the emulated link is full: a tail drop. */
+            pxDirection->ulOverflows++;
+            pxDropped = pxBuffer;
+        }
+        else
+        {
+            xDueTime = prvNetEmDueTime( pxNetEm, pxDirection, pxBuffer->xDataLength );
+
+            uxIndex = pxNetEm->uxCount;
+
+            while( ( uxIndex > 0U ) && ipNETEM_IS_BEFORE( xDueTime, pxNetEm->xQueue[ uxIndex - 1U ].xDueTime ) )
+            {
+                uxIndex--;
+            }
+
+            ( void ) memmove( &( pxNetEm->xQueue[ uxIndex + 1U ] ),
+                              &( pxNetEm->xQueue[ uxIndex ] ),
+                              ( pxNetEm->uxCount - uxIndex ) * sizeof( pxNetEm->xQueue[ 0 ] ) );
+            pxNetEm->xQueue[ uxIndex ].pxBuffer = pxBuffer;
+            pxNetEm->xQueue[ uxIndex ].xDueTime = xDueTime;
+            pxNetEm->xQueue[ uxIndex ].xOutgoing = xOutgoing;
+            pxNetEm->uxCount++;
+
+            if( uxIndex == 0U )
+            {
+                xNewHead = pdTRUE;
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    if( pxDropped != NULL )
+    {
+        vReleaseNetworkBufferAndDescriptor( pxDropped );
+    }
+
+    if( xNewHead != pdFALSE )
+    {
+        /* The task must wait for an earlier time now. */
+        ( void ) xTaskNotifyGive( pxNetEm->xTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Apply loss and duplication to a frame and queue what remains.
+ *
+ * @param[in] pxNetEm The emulator.
+ * @param[in] pxDirection The direction of the frame.
+ * @param[in] pxBuffer The frame, which is owned by the emulator now.
+ * @param[in] xOutgoing pdTRUE for a frame to be sent.
+ */
+static void prvNetEmImpair( NetEm_t * pxNetEm,
+                            NetEmDirection_t * pxDirection,
+                            NetworkBufferDescriptor_t * pxBuffer,
+                            BaseType_t xOutgoing )
+{
+    NetworkBufferDescriptor_t * pxCopy = NULL;
+    BaseType_t xLost;
+    BaseType_t xDuplicate;
+
+    /* The random generator is shared by the IP-task and the tasks that send. */
+    vTaskSuspendAll();
+    {
+        xLost = prvNetEmChance( pxNetEm, pxDirection->xParameters.ulLossPPM );
+        xDuplicate = prvNetEmChance( pxNetEm, pxDirection->xParameters.ulDuplicatePPM );
+
+        if( xLost != pdFALSE )
+        {
+            pxDirection->ulLost++;
+        }
+        else if( xDuplicate != pdFALSE )
+        {
+            pxDirection->ulDuplicated++;
+        }
+        else
+        {
+            /* Deliver the frame once. */
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    if( xLost != pdFALSE )
+    {
+        vReleaseNetworkBufferAndDescriptor( pxBuffer );
+    }
+    else
+    {
+        if( xDuplicate != pdFALSE )
+        {
+            pxCopy = pxDuplicateNetworkBufferWithDescriptor( pxBuffer, pxBuffer->xDataLength );
+        }
+
+        prvNetEmEnqueue( pxNetEm, pxDirection, pxBuffer, xOutgoing );
+
+        if( pxCopy != NULL )
+        {
+            prvNetEmEnqueue( pxNetEm, pxDirection, pxCopy, xOutgoing );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Replaces the pfOutput() function of the interface.
+ *
+ * @param[in] pxInterface The interface.
+ * @param[in] pxBuffer The frame to be sent.
+ * @param[in] xReleaseAfterSend pdTRUE when the buffer is handed over.
+ *
+ * @return pdPASS when the frame was queued, sent, or lost on purpose.
+ */
+static BaseType_t prvNetEmOutput( NetworkInterface_t * pxInterface,
+                                  NetworkBufferDescriptor_t * const pxBuffer,
+                                  BaseType_t xReleaseAfterSend )
+{
+    NetEm_t * pxNetEm = prvNetEmFind( pxInterface );
+    NetworkBufferDescriptor_t * pxOwned = pxBuffer;
+    BaseType_t xReturn = pdPASS;
+
+    configASSERT( pxNetEm != NULL );
+
+    if( prvNetEmIsTransparent( &( pxNetEm->xTx ) ) != pdFALSE )
+    {
+        xReturn = pxNetEm->pfOutput( pxInterface, pxBuffer, xReleaseAfterSend );
+    }
+    else
+    {
+        if( xReleaseAfterSend == pdFALSE )
+        {
+            /* The caller keeps its buffer, queue a copy. */
+            pxOwned = pxDuplicateNetworkBufferWithDescriptor( pxBuffer, pxBuffer->xDataLength );
+        }
+
+        if( pxOwned != NULL )
+        {
+            prvNetEmImpair( pxNetEm, &( pxNetEm->xTx ), pxOwned, pdTRUE );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Replaces the pfPoll() function of the interface. Delivers the
+ *        frames that are due and then calls the original pfPoll(), if any.
+ *
+ * @param[in] pxInterface The interface.
+ * @param[in] xBudget The maximum number of frames the original pfPoll() may handle.
+ *
+ * @return The value returned by the original pfPoll(), or zero.
+ */
+static BaseType_t prvNetEmPoll( NetworkInterface_t * pxInterface,
+                                BaseType_t xBudget )
+{
+    NetEm_t * pxNetEm = prvNetEmFind( pxInterface );
+    NetworkBufferDescriptor_t * pxBuffer;
+    BaseType_t xOutgoing = pdFALSE;
+    TickType_t xNow = xTaskGetTickCount();
+    BaseType_t xReturn = 0;
+
+    configASSERT( pxNetEm != NULL );
+
+    for( ; ; )
+    {
+        pxBuffer = NULL;
+
+        vTaskSuspendAll();
+        {
+            if( ( pxNetEm->uxCount > 0U ) &&
+                ( ipNETEM_IS_BEFORE( xNow, pxNetEm->xQueue[ 0 ].xDueTime ) == pdFALSE ) )
+            {
+                pxBuffer = pxNetEm->xQueue[ 0 ].pxBuffer;
+                xOutgoing = pxNetEm->xQueue[ 0 ].xOutgoing;
+                pxNetEm->uxCount--;
+                ( void ) memmove( &( pxNetEm->xQueue[ 0 ] ),
+                                  &( pxNetEm->xQueue[ 1 ] ),
+                                  pxNetEm->uxCount * sizeof( pxNetEm->xQueue[ 0 ] ) );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( pxBuffer == NULL )
+        {
+            break;
+        }
+
+        if( xOutgoing != pdFALSE )
+        {
+            pxNetEm->xTx.ulPassed++;
+            ( void ) pxNetEm->pfOutput( pxInterface, pxBuffer, pdTRUE );
+        }
+        else
+        {
+            pxNetEm->xRx.ulPassed++;
+
+            /* Let xNetEmReceive() pass the frame this time. */
+            pxNetEm->xReleasing = pdTRUE;
+            vNetworkInterfacePollInput( pxBuffer );
+            pxNetEm->xReleasing = pdFALSE;
+        }
+    }
+
+    /* Let the task wait for the next due time. */
+    ( void ) xTaskNotifyGive( pxNetEm->xTask );
+
+    if( pxNetEm->pfPoll != NULL )
+    {
+        xReturn = pxNetEm->pfPoll( pxInterface, xBudget );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The task of an emulator. It sleeps until the first frame in the
+ *        queue is due, and then lets the IP-task call prvNetEmPoll(). The
+ *        drivers expect their output function to be called by the IP-task.
+ *
+ * @param[in] pvParameters The emulator.
+ */
+static void prvNetEmTask( void * pvParameters )
+{
+    NetEm_t * pxNetEm = ( NetEm_t * ) pvParameters;
+    TickType_t xNow;
+    TickType_t xSleepTime;
+
+    for( ; ; )
+    {
+        vTaskSuspendAll();
+        {
+            xNow = xTaskGetTickCount();
+
+            if( pxNetEm->uxCount == 0U )
+            {
+                xSleepTime = portMAX_DELAY;
+            }
+            else if( ipNETEM_IS_BEFORE( xNow, pxNetEm->xQueue[ 0 ].xDueTime ) )
+            {
+                xSleepTime = pxNetEm->xQueue[ 0 ].xDueTime - xNow;
+            }
+            else
+            {
+                xSleepTime = 0U;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xSleepTime == 0U )
+        {
+            /* prvNetEmPoll() will wake up this task when it has run. */
+            FreeRTOS_NetworkInterfacePoll( pxNetEm->pxInterface );
+            xSleepTime = portMAX_DELAY;
+        }
+
+        ( void ) ulTaskNotifyTake( pdTRUE, xSleepTime );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Attach an emulator to an interface, see FreeRTOS_NetEm.h.
+ *
+ * @param[in] pxNetEm The emulator object, which must remain to exist.
+ * @param[in] pxInterface The interface of which the traffic will be impaired.
+ * @param[in] ulSeed The seed of the pseudo-random decisions.
+ *
+ * @return pdPASS when the emulator was attached.
+ */
+BaseType_t FreeRTOS_NetEmAttach( NetEm_t * pxNetEm,
+                                 NetworkInterface_t * pxInterface,
+                                 uint32_t ulSeed )
+{
+    BaseType_t xReturn = pdFAIL;
+
+    if( ( pxNetEm != NULL ) &&
+        ( pxInterface != NULL ) &&
+        ( pxInterface->pfOutput != NULL ) &&
+        ( prvNetEmFind( pxInterface ) == NULL ) )
+    {
+        ( void ) memset( pxNetEm, 0, sizeof( *pxNetEm ) );
+
+        pxNetEm->pxInterface = pxInterface;
+        pxNetEm->pfOutput = pxInterface->pfOutput;
+        pxNetEm->pfPoll = pxInterface->pfPoll;
+
+        /* A xorshift generator would get stuck at zero. */
+        pxNetEm->ulRandom = ( ulSeed != 0U ) ? ulSeed : 0x2545F491U;
+
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            pxNetEm->xTask = xTaskCreateStatic( prvNetEmTask,
+                                                "NetEm",
+                                                configMINIMAL_STACK_SIZE,
+                                                ( void * ) pxNetEm,
+                                                ipconfigIP_TASK_PRIORITY,
+                                                pxNetEm->xTaskStack,
+                                                &( pxNetEm->xTaskBuffer ) );
+
+            if( pxNetEm->xTask != NULL )
+            {
+                xReturn = pdPASS;
+            }
+        }
+        #else
+        {
+            xReturn = xTaskCreate( prvNetEmTask,
+                                   "NetEm",
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) pxNetEm,
+                                   ipconfigIP_TASK_PRIORITY,
+                                   &( pxNetEm->xTask ) );
+        }
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+        if( xReturn == pdPASS )
+        {
+            vTaskSuspendAll();
+            {
+                pxNetEm->pxNext = pxNetEmList;
+                pxNetEmList = pxNetEm;
+                pxInterface->pfOutput = prvNetEmOutput;
+                pxInterface->pfPoll = prvNetEmPoll;
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Change the impairments of an emulator, see FreeRTOS_NetEm.h.
+ *
+ * @param[in] pxNetEm The emulator.
+ * @param[in] pxTx The impairments of outgoing frames, or NULL for none.
+ * @param[in] pxRx The impairments of incoming frames, or NULL for none.
+ */
+void FreeRTOS_NetEmSetParameters( NetEm_t * pxNetEm,
+                                  const NetEmParameters_t * pxTx,
+                                  const NetEmParameters_t * pxRx )
+{
+    vTaskSuspendAll();
+    {
+        ( void ) memset( &( pxNetEm->xTx.xParameters ), 0, sizeof( pxNetEm->xTx.xParameters ) );
+        ( void ) memset( &( pxNetEm->xRx.xParameters ), 0, sizeof( pxNetEm->xRx.xParameters ) );
+
+        if( pxTx != NULL )
+        {
+            ( void ) memcpy( &( pxNetEm->xTx.xParameters ), pxTx, sizeof( pxNetEm->xTx.xParameters ) );
+        }
+
+        if( pxRx != NULL )
+        {
+            ( void ) memcpy( &( pxNetEm->xRx.xParameters ), pxRx, sizeof( pxNetEm->xRx.xParameters ) );
+        }
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task for every received frame, see FreeRTOS_NetEm.h.
+ *
+ * @param[in] pxNetworkBuffer The received frame.
+ *
+ * @return pdFALSE when the emulator has taken the frame.
+ */
+BaseType_t xNetEmReceive( NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    NetEm_t * pxNetEm = prvNetEmFind( pxNetworkBuffer->pxInterface );
+    BaseType_t xReturn = pdTRUE;
+
+    if( ( pxNetEm != NULL ) &&
+        ( pxNetEm->xReleasing == pdFALSE ) &&
+        ( prvNetEmIsTransparent( &( pxNetEm->xRx ) ) == pdFALSE ) )
+    {
+        prvNetEmImpair( pxNetEm, &( pxNetEm->xRx ), pxNetworkBuffer, pdFALSE );
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check whether an emulator is attached to an interface.
+ *
+ * @param[in] pxInterface The interface.
+ *
+ * @return pdTRUE when an emulator is attached.
+ */
+BaseType_t xNetEmAttached( const NetworkInterface_t * pxInterface )
+{
+    return ( prvNetEmFind( pxInterface ) != NULL ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+/* *INDENT-OFF* */
+#endif /* ( ipconfigUSE_NETWORK_EMULATION != 0 ) */
+/* *INDENT-ON* */
@@ -0,0 +1,499 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_PacketFilter.c
+ * @brief Implements a rule-based filter of received frames.  The rules are
+ *        compiled to a small program that is run by the IP-task, or that is
+ *        passed to drivers that can filter in hardware.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_IPv6.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_PacketFilter.h"
+
+/* *INDENT-OFF* */
+#if ( ipconfigUSE_PACKET_FILTER != 0 )
+/* *INDENT-ON* */
+
+/** @brief The Ethernet types that a rule must have to match a protocol, in
+ *         host-endian order. */
+#define ipFILTER_TYPE_IPv4                0x0800U
+#define ipFILTER_TYPE_IPv6                0x86DDU
+
+/** @brief The offsets of the fields that the rules look at. */
+#define ipFILTER_OFFSET_FRAME_TYPE        ( 2U * ipMAC_ADDRESS_LENGTH_BYTES )
+#define ipFILTER_OFFSET_IPv4_FRAGMENT     ( ipSIZE_OF_ETH_HEADER + 6U )
+#define ipFILTER_OFFSET_IPv4_PROTOCOL     ( ipSIZE_OF_ETH_HEADER + 9U )
+#define ipFILTER_OFFSET_IPv6_NEXT_HEADER  ( ipSIZE_OF_ETH_HEADER + 6U )
+#define ipFILTER_OFFSET_IPv6_PAYLOAD      ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER )
+
+/** @brief The fragment offset of an IPv4 header, in host-endian order.  A
+ *         fragment other than the first one has no UDP or TCP header. */
+#define ipFILTER_FRAGMENT_OFFSET_MASK     0x1FFFU
+
+/** @brief The group bit of the first byte of a MAC address. */
+#define ipFILTER_GROUP_ADDRESS_BIT        0x01U
+
+/** @brief Marks a jump to the next rule while a rule is being compiled. */
+#define ipFILTER_NEXT_RULE                0xFFU
+
+/*-----------------------------------------------------------*/
+
+/** @brief The installed program, see FreeRTOS_SetPacketFilter(). */
+static PacketFilterInstruction_t xFilterProgram[ ipconfigPACKET_FILTER_MAX_INSTRUCTIONS ];
+
+/** @brief The number of instructions in xFilterProgram[], zero when no filter
+ *         is installed. */
+static volatile size_t uxFilterLength = 0U;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check a rule and return the number of instructions it compiles to.
+ *
+ * @param[in] pxRule The rule.
+ *
+ * @return The number of instructions, or zero when the rule is invalid.
+ */
+static size_t prvRuleLength( const PacketFilterRule_t * pxRule )
+{
+    size_t uxLength = 1U;
+    BaseType_t xValid = pdTRUE;
+
+    if( pxRule->eDestination != eFilterAnyDestination )
+    {
+        uxLength += 2U;
+    }
+
+    if( pxRule->usFrameType != 0U )
+    {
+        uxLength += 2U;
+    }
+
+    if( pxRule->ucProtocol != 0U )
+    {
+        if( ( pxRule->usFrameType != ipFILTER_TYPE_IPv4 ) && ( pxRule->usFrameType != ipFILTER_TYPE_IPv6 ) )
+        {
+            xValid = pdFALSE;
+        }
+
+        uxLength += 2U;
+    }
+
+    if( ( pxRule->usSourcePort != 0U ) || ( pxRule->usDestinationPort != 0U ) )
+    {
+        if( ( pxRule->ucProtocol != ipPROTOCOL_UDP ) && ( pxRule->ucProtocol != ipPROTOCOL_TCP ) )
+        {
+            xValid = pdFALSE;
+        }
+
+        if( pxRule->usFrameType == ipFILTER_TYPE_IPv4 )
+        {
+            /* Skip the fragments without a header, and find the header. */
+            uxLength += 3U;
+        }
+
+        if( pxRule->usSourcePort != 0U )
+        {
+            uxLength += 2U;
+        }
+
+        if( pxRule->usDestinationPort != 0U )
+        {
+            uxLength += 2U;
+        }
+    }
+
+    if( xValid == pdFALSE )
+    {
+        uxLength = 0U;
+    }
+
+    return uxLength;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add an instruction to xFilterProgram[].
+ *
+ * @param[in,out] puxIndex The index of the instruction, it will be incremented.
+ * @param[in] ucOpcode The ePacketFilterOpcode_t.
+ * @param[in] ucJumpTrue The instructions to skip when a condition is true.
+ * @param[in] ucJumpFalse The instructions to skip when a condition is false.
+ * @param[in] ulValue The offset, constant or return value.
+ */
+static void prvEmit( size_t * puxIndex,
+                     uint8_t ucOpcode,
+                     uint8_t ucJumpTrue,
+                     uint8_t ucJumpFalse,
+                     uint32_t ulValue )
+{
+    PacketFilterInstruction_t * pxInstruction = &( xFilterProgram[ *puxIndex ] );
+
+    pxInstruction->ucOpcode = ucOpcode;
+    pxInstruction->ucJumpTrue = ucJumpTrue;
+    pxInstruction->ucJumpFalse = ucJumpFalse;
+    pxInstruction->ucReserved = 0U;
+    pxInstruction->ulValue = ulValue;
+    *puxIndex = *puxIndex + 1U;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Compile a rule that was checked by prvRuleLength().  Every compare
+ *        that fails jumps to the first instruction of the next rule.
+ *
+ * @param[in] pxRule The rule.
+ * @param[in] uxStart The index of its first instruction.
+ *
+ * @return The index that follows the last instruction of the rule.
+ */
+static size_t prvCompileRule( const PacketFilterRule_t * pxRule,
+                              size_t uxStart )
+{
+    size_t uxIndex = uxStart;
+    size_t uxCheck;
+    uint8_t ucLoad;
+    uint32_t ulPayload;
+
+    if( pxRule->eDestination == eFilterGroupDestination )
+    {
+        prvEmit( &uxIndex, ( uint8_t ) ePacketFilterLoadByte, 0U, 0U, 0U );
+        prvEmit( &uxIndex, ( uint8_t ) ePacketFilterJumpSet, 0U, ipFILTER_NEXT_RULE, ipFILTER_GROUP_ADDRESS_BIT );
+    }
+    else if( pxRule->eDestination == eFilterUnicastDestination )
+    {
+        prvEmit( &uxIndex, ( uint8_t ) ePacketFilterLoadByte, 0U, 0U, 0U );
+        prvEmit( &uxIndex, ( uint8_t ) ePacketFilterJumpSet, ipFILTER_NEXT_RULE, 0U, ipFILTER_GROUP_ADDRESS_BIT );
+    }
+    else
+    {
+        /* Any destination. */
+    }
+
+    if( pxRule->usFrameType != 0U )
+    {
+        prvEmit( &uxIndex, ( uint8_t ) ePacketFilterLoadHalf, 0U, 0U, ipFILTER_OFFSET_FRAME_TYPE );
+        prvEmit( &uxIndex, ( uint8_t ) ePacketFilterJumpEqual, 0U, ipFILTER_NEXT_RULE, pxRule->usFrameType );
+    }
+
+    if( pxRule->ucProtocol != 0U )
+    {
+        prvEmit( &uxIndex, ( uint8_t ) ePacketFilterLoadByte, 0U, 0U,
+                 ( pxRule->usFrameType == ipFILTER_TYPE_IPv4 ) ? ipFILTER_OFFSET_IPv4_PROTOCOL : ipFILTER_OFFSET_IPv6_NEXT_HEADER );
+        prvEmit( &uxIndex, ( uint8_t ) ePacketFilterJumpEqual, 0U, ipFILTER_NEXT_RULE, pxRule->ucProtocol );
+    }
+
+    if( ( pxRule->usSourcePort != 0U ) || ( pxRule->usDestinationPort != 0U ) )
+    {
+        if( pxRule->usFrameType == ipFILTER_TYPE_IPv4 )
+        {
+            prvEmit( &uxIndex, ( uint8_t ) ePacketFilterLoadHalf, 0U, 0U, ipFILTER_OFFSET_IPv4_FRAGMENT );
+            prvEmit( &uxIndex, ( uint8_t ) ePacketFilterJumpSet, ipFILTER_NEXT_RULE, 0U, ipFILTER_FRAGMENT_OFFSET_MASK );
+            prvEmit( &uxIndex, ( uint8_t ) ePacketFilterLoadIPv4Length, 0U, 0U, ipSIZE_OF_ETH_HEADER );
+            ucLoad = ( uint8_t ) ePacketFilterLoadHalfIndexed;
+            ulPayload = ipSIZE_OF_ETH_HEADER;
+        }
+        else
+        {
+            /* Extension headers are not followed: a frame that has them
+             * does not match. */
+            ucLoad = ( uint8_t ) ePacketFilterLoadHalf;
+            ulPayload = ipFILTER_OFFSET_IPv6_PAYLOAD;
+        }
+
+        /* The source port is followed by the destination port. */
+        if( pxRule->usSourcePort != 0U )
+        {
+            prvEmit( &uxIndex, ucLoad, 0U, 0U, ulPayload );
+            prvEmit( &uxIndex, ( uint8_t ) ePacketFilterJumpEqual, 0U, ipFILTER_NEXT_RULE, pxRule->usSourcePort );
+        }
+
+        if( pxRule->usDestinationPort != 0U )
+        {
+            prvEmit( &uxIndex, ucLoad, 0U, 0U, ulPayload + 2U );
+            prvEmit( &uxIndex, ( uint8_t ) ePacketFilterJumpEqual, 0U, ipFILTER_NEXT_RULE, pxRule->usDestinationPort );
+        }
+    }
+
+    prvEmit( &uxIndex, ( uint8_t ) ePacketFilterReturn, 0U, 0U,
+             ( pxRule->eAction == eFilterAccept ) ? ( uint32_t ) pdTRUE : ( uint32_t ) pdFALSE );
+
+    /* Now that the length is known, resolve the jumps to the next rule. */
+    for( uxCheck = uxStart; uxCheck < uxIndex; uxCheck++ )
+    {
+        uint8_t ucSkip = ( uint8_t ) ( uxIndex - ( uxCheck + 1U ) );
+
+        if( xFilterProgram[ uxCheck ].ucJumpTrue == ipFILTER_NEXT_RULE )
+        {
+            xFilterProgram[ uxCheck ].ucJumpTrue = ucSkip;
+        }
+
+        if( xFilterProgram[ uxCheck ].ucJumpFalse == ipFILTER_NEXT_RULE )
+        {
+            xFilterProgram[ uxCheck ].ucJumpFalse = ucSkip;
+        }
+    }
+
+    return uxIndex;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Compile the rules and install them as the packet filter.
+ *
+ * @param[in] pxRules The rules, the first one that matches decides.
+ * @param[in] uxRuleCount The number of rules, zero to remove the filter.
+ *
+ * @return pdPASS when the filter was installed, pdFAIL when a rule is invalid
+ *         or when the program would be too long.
+ */
+BaseType_t FreeRTOS_SetPacketFilter( const PacketFilterRule_t * pxRules,
+                                     size_t uxRuleCount )
+{
+    BaseType_t xReturn = pdPASS;
+    size_t uxLength = 0U;
+    size_t uxRule;
+    NetworkInterface_t * pxInterface;
+
+    if( ( pxRules == NULL ) && ( uxRuleCount != 0U ) )
+    {
+        xReturn = pdFAIL;
+    }
+    else if( uxRuleCount != 0U )
+    {
+        /* The default action: accept. */
+        uxLength = 1U;
+
+        for( uxRule = 0U; uxRule < uxRuleCount; uxRule++ )
+        {
+            size_t uxRuleLength = prvRuleLength( &( pxRules[ uxRule ] ) );
+
+            if( uxRuleLength == 0U )
+            {
+                FreeRTOS_printf( ( "FreeRTOS_SetPacketFilter: rule %u is invalid\n", ( unsigned ) uxRule ) );
+                xReturn = pdFAIL;
+                break;
+            }
+
+            uxLength += uxRuleLength;
+        }
+
+        if( ( xReturn == pdPASS ) && ( uxLength > ipconfigPACKET_FILTER_MAX_INSTRUCTIONS ) )
+        {
+            FreeRTOS_printf( ( "FreeRTOS_SetPacketFilter: %u instructions needed\n", ( unsigned ) uxLength ) );
+            xReturn = pdFAIL;
+        }
+    }
+    else
+    {
+        /* Remove the filter. */
+    }
+
+    if( xReturn == pdPASS )
+    {
+        size_t uxIndex = 0U;
+
+        /* The IP-task may be running the old program.  Forward jumps and
+         * the bound checks in xPacketFilterRun() keep it safe while the
+         * program is replaced. */
+        vTaskSuspendAll();
+        {
+            uxFilterLength = 0U;
+
+            for( uxRule = 0U; uxRule < uxRuleCount; uxRule++ )
+            {
+                uxIndex = prvCompileRule( &( pxRules[ uxRule ] ), uxIndex );
+            }
+
+            if( uxRuleCount != 0U )
+            {
+                prvEmit( &uxIndex, ( uint8_t ) ePacketFilterReturn, 0U, 0U, ( uint32_t ) pdTRUE );
+            }
+
+            uxFilterLength = uxIndex;
+        }
+        ( void ) xTaskResumeAll();
+
+        /* Offer the program to the drivers that can filter in hardware. */
+        for( pxInterface = FreeRTOS_FirstNetworkInterface();
+             pxInterface != NULL;
+             pxInterface = FreeRTOS_NextNetworkInterface( pxInterface ) )
+        {
+            BaseType_t xOffload = pdFALSE;
+
+            if( pxInterface->pfSetPacketFilter != NULL )
+            {
+                xOffload = ( pxInterface->pfSetPacketFilter( pxInterface, xFilterProgram, uxIndex ) == pdPASS ) ? pdTRUE : pdFALSE;
+            }
+
+            pxInterface->bits.bPacketFilterOffload = ( xOffload != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run a packet filter program over a frame.
+ *
+ * @param[in] pxProgram The instructions.
+ * @param[in] uxLength The number of instructions.
+ * @param[in] pucFrame The frame, starting with the Ethernet header.
+ * @param[in] uxFrameLength The length of the frame.
+ *
+ * @return pdFALSE when the frame must be dropped, otherwise pdTRUE.
+ */
+BaseType_t xPacketFilterRun( const PacketFilterInstruction_t * pxProgram,
+                             size_t uxLength,
+                             const uint8_t * pucFrame,
+                             size_t uxFrameLength )
+{
+    BaseType_t xReturn = pdTRUE;
+    BaseType_t xDone = pdFALSE;
+    size_t uxPC = 0U;
+    uint32_t ulA = 0U;
+    size_t uxX = 0U;
+
+    while( ( xDone == pdFALSE ) && ( uxPC < uxLength ) )
+    {
+        const PacketFilterInstruction_t * pxInstruction = &( pxProgram[ uxPC ] );
+        size_t uxOffset = ( size_t ) pxInstruction->ulValue;
+        BaseType_t xCondition = pdFALSE;
+
+        uxPC++;
+
+        switch( pxInstruction->ucOpcode )
+        {
+            case ePacketFilterLoadHalfIndexed:
+            case ePacketFilterLoadHalf:
+
+                if( pxInstruction->ucOpcode == ( uint8_t ) ePacketFilterLoadHalfIndexed )
+                {
+                    uxOffset += uxX;
+                }
+
+                if( ( uxOffset + 2U ) > uxFrameLength )
+                {
+                    /* Too short: let the stack decide. */
+                    xDone = pdTRUE;
+                }
+                else
+                {
+                    ulA = ( ( ( uint32_t ) pucFrame[ uxOffset ] ) << 8 ) | ( ( uint32_t ) pucFrame[ uxOffset + 1U ] );
+                }
+
+                break;
+
+            case ePacketFilterLoadByte:
+            case ePacketFilterLoadIPv4Length:
+
+                if( uxOffset >= uxFrameLength )
+                {
+                    xDone = pdTRUE;
+                }
+                else if( pxInstruction->ucOpcode == ( uint8_t ) ePacketFilterLoadByte )
+                {
+                    ulA = ( uint32_t ) pucFrame[ uxOffset ];
+                }
+                else
+                {
+                    uxX = ( ( size_t ) pucFrame[ uxOffset ] & 0x0FU ) * 4U;
+                }
+
+                break;
+
+            case ePacketFilterJumpEqual:
+            case ePacketFilterJumpSet:
+
+                if( pxInstruction->ucOpcode == ( uint8_t ) ePacketFilterJumpEqual )
+                {
+                    xCondition = ( ulA == pxInstruction->ulValue ) ? pdTRUE : pdFALSE;
+                }
+                else
+                {
+                    xCondition = ( ( ulA & pxInstruction->ulValue ) != 0U ) ? pdTRUE : pdFALSE;
+                }
+
+                uxPC += ( xCondition != pdFALSE ) ? ( size_t ) pxInstruction->ucJumpTrue : ( size_t ) pxInstruction->ucJumpFalse;
+                break;
+
+            case ePacketFilterReturn:
+                xReturn = ( pxInstruction->ulValue != 0U ) ? pdTRUE : pdFALSE;
+                xDone = pdTRUE;
+                break;
+
+            default:
+                /* An unknown instruction: accept. */
+                xDone = pdTRUE;
+                break;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run the installed packet filter over a received frame.
+ *
+ * @param[in] pxNetworkBuffer The received frame, with a valid pxInterface.
+ *
+ * @return pdFALSE when the frame must be dropped, otherwise pdTRUE.
+ */
+BaseType_t xPacketFilterAccepts( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    BaseType_t xReturn = pdTRUE;
+
+    if( ( uxFilterLength != 0U ) &&
+        ( pxNetworkBuffer->pxInterface->bits.bPacketFilterOffload == pdFALSE_UNSIGNED ) )
+    {
+        xReturn = xPacketFilterRun( xFilterProgram, uxFilterLength,
+                                    pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/* *INDENT-OFF* */
+#endif /* ( ipconfigUSE_PACKET_FILTER != 0 ) */
+/* *INDENT-ON* */
@@ -260,6 +260,46 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 )
+
+/**
+ * @brief Receive a NS ( Neighbour Solicitation ) message.  When it is sent from
+ *        the unspecified address, another device is doing DAD for the target
+ *        address.  If that is the address being tested, it is a duplicate.
+ *
+ * @param[in] pxNetworkBuffer The buffer that contains the message.
+ */
+        void vReceiveNS( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            const NetworkInterface_t * pxInterface = pxNetworkBuffer->pxInterface;
+            NetworkEndPoint_t * pxPoint;
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ICMPPacket_IPv6_t * pxICMPPacket = ( ( const ICMPPacket_IPv6_t * ) pxNetworkBuffer->pucEthernetBuffer );
+            const ICMPHeader_IPv6_t * pxICMPHeader_IPv6 = ( ( const ICMPHeader_IPv6_t * ) &( pxICMPPacket->xICMPHeaderIPv6 ) );
+
+            if( memcmp( pxICMPPacket->xIPHeader.xSourceAddress.ucBytes, FreeRTOS_in6addr_any.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+            {
+                for( pxPoint = FreeRTOS_FirstEndPoint( pxInterface );
+                     pxPoint != NULL;
+                     pxPoint = FreeRTOS_NextEndPoint( pxInterface, pxPoint ) )
+                {
+                    if( ( pxPoint->bits.bWantRA != pdFALSE_UNSIGNED ) &&
+                        ( pxPoint->xRAData.eRAState == eRAStateIPWait ) &&
+                        ( memcmp( pxPoint->ipv6_settings.xIPAddress.ucBytes, pxICMPHeader_IPv6->xIPv6Address.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) )
+                    {
+                        pxPoint->xRAData.bits.bIPAddressInUse = pdTRUE_UNSIGNED;
+                        vDHCP_RATimerReload( pxPoint, 100U );
+                    }
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 ) */
+
 /**
  * @brief Read a received RA reply and return the prefix option from the packet.
  *
@@ -407,8 +447,10 @@
                             pxEndPoint->ipv6_settings.uxPrefixLength = pxPrefixOption->ucPrefixLength;
                             ( void ) memcpy( pxEndPoint->ipv6_settings.xPrefix.ucBytes, pxPrefixOption->ucPrefix, ipSIZE_OF_IPv6_ADDRESS );
                             ( void ) memcpy( pxEndPoint->ipv6_settings.xGatewayAddress.ucBytes, pxICMPPacket->xIPHeader.xSourceAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                            FreeRTOS_RouteCacheInvalidate();
 
                             pxEndPoint->xRAData.bits.bRouterReplied = pdTRUE_UNSIGNED;
+                            vBringUpEndPointMilestone( pxEndPoint, eBringUpRAAdvert );
                             pxEndPoint->xRAData.uxRetryCount = 0U;
                             pxEndPoint->xRAData.ulPreferredLifeTime = FreeRTOS_ntohl( pxPrefixOption->ulPreferredLifeTime );
                             /* Force taking a new random IP-address. */
@@ -475,6 +517,18 @@
                 pxEndPoint->xRAData.uxRetryCount = 0U;
                 pxEndPoint->xRAData.eRAState = eRAStateIPTest;
                 uxNewReloadTime = pdMS_TO_TICKS( ipconfigRA_IP_TEST_TIME_OUT_MSEC );
+
+                #if ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 )
+                    if( pxEndPoint->xRAData.bits.bOptimistic != pdFALSE_UNSIGNED )
+                    {
+                        /* The optimistic address was already in use, stop
+                         * using it.  The next address will go up again. */
+                        FreeRTOS_printf( ( "RA: optimistic address %pip is a duplicate\n", ( void * ) pxEndPoint->ipv6_settings.xIPAddress.ucBytes ) );
+                        pxEndPoint->xRAData.bits.bOptimistic = pdFALSE_UNSIGNED;
+                        pxEndPoint->bits.bEndPointUp = pdFALSE_UNSIGNED;
+                        FreeRTOS_RouteCacheInvalidate();
+                    }
+                #endif
             }
             else if( pxEndPoint->xRAData.uxRetryCount < ( UBaseType_t ) ipconfigRA_IP_TEST_COUNT )
             {
@@ -486,6 +540,8 @@
             else
             {
                 /* Now it is assumed that there is no other device using the same IP-address. */
+                vBringUpEndPointMilestone( pxEndPoint, eBringUpDADDone );
+
                 if( pxEndPoint->xRAData.bits.bRouterReplied != pdFALSE_UNSIGNED )
                 {
                     /* Obtained configuration from a router. */
@@ -508,9 +564,20 @@
                     uxNewReloadTime = 0U;
                 }
 
-                /* Now call vIPNetworkUpCalls() to send the network-up event and
-                 * start the ARP timer. */
-                vIPNetworkUpCalls( pxEndPoint );
+                #if ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 )
+                    if( pxEndPoint->xRAData.bits.bOptimistic != pdFALSE_UNSIGNED )
+                    {
+                        /* The end-point went up when the test started, the
+                         * address is not optimistic anymore. */
+                        pxEndPoint->xRAData.bits.bOptimistic = pdFALSE_UNSIGNED;
+                    }
+                    else
+                #endif
+                {
+                    /* Now call vIPNetworkUpCalls() to send the network-up event and
+                     * start the ARP timer. */
+                    vIPNetworkUpCalls( pxEndPoint );
+                }
             }
         }
         else
@@ -555,6 +622,7 @@
                    {
                        pxNetworkBuffer->pxEndPoint = pxEndPoint;
                        vNDSendRouterSolicitation( pxNetworkBuffer, &( xIPAddress ) );
+                       vBringUpEndPointMilestone( pxEndPoint, eBringUpRASolicit );
                    }
 
                    FreeRTOS_printf( ( "vRAProcess: Router Solicitation, attempt %lu/%u\n",
@@ -590,10 +658,20 @@
                    {
                        pxNetworkBuffer->pxEndPoint = pxEndPoint;
                        vNDSendNeighbourSolicitation( pxNetworkBuffer, &( pxEndPoint->ipv6_settings.xIPAddress ) );
+                       vBringUpEndPointMilestone( pxEndPoint, eBringUpDADStart );
                    }
 
                    uxNewReloadTime = pdMS_TO_TICKS( 1000U );
                    pxEndPoint->xRAData.eRAState = eRAStateIPWait;
+
+                   #if ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 )
+                       if( pxEndPoint->bits.bEndPointUp == pdFALSE_UNSIGNED )
+                       {
+                           /* RFC 4429: use the address while it is being tested. */
+                           pxEndPoint->xRAData.bits.bOptimistic = pdTRUE_UNSIGNED;
+                           vIPNetworkUpCalls( pxEndPoint );
+                       }
+                   #endif
                }
                break;
 
@@ -629,6 +707,12 @@
     {
         pxEndPoint->xRAData.uxRetryCount = 0U;
         pxEndPoint->xRAData.eRAState = eRAStateApply;
+
+        #if ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 )
+        {
+            pxEndPoint->xRAData.bits.bOptimistic = pdFALSE_UNSIGNED;
+        }
+        #endif
     }
 
 /**
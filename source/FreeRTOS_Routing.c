@@ -44,10 +44,19 @@
 #include "FreeRTOS_UDP_IP.h"
 #include "FreeRTOS_DHCP.h"
 #include "NetworkBufferManagement.h"
-#if ( ipconfigUSE_LLMNR == 1 )
+#if ( ipconfigUSE_LLMNR == 1 ) || ( ipconfigUSE_MDNS == 1 )
     #include "FreeRTOS_DNS.h"
-#endif /* ipconfigUSE_LLMNR */
+#endif /* ( ipconfigUSE_LLMNR == 1 ) || ( ipconfigUSE_MDNS == 1 ) */
 #include "FreeRTOS_Routing.h"
+#include "FreeRTOS_VLAN.h"
+
+#if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+
+/*
+ * Clear the MAC address filter of a new interface.
+ */
+    static void prvMACFilterInit( NetworkInterface_t * pxInterface );
+#endif
 
 /** @brief A list of all network end-points.  Each element has a next pointer. */
 struct xNetworkEndPoint * pxNetworkEndPoints = NULL;
@@ -140,6 +149,272 @@ struct xIPv6_Couple
 
 #if ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 )
 
+    #if ( ipconfigUSE_ROUTE_CACHE != 0 )
+
+/** @brief Mask to get a slot number from a hash value. */
+        #define routeCACHE_MASK    ( ( uint32_t ) ipconfigROUTE_CACHE_ENTRIES - 1U )
+
+/** @brief One slot of the route cache. */
+        typedef struct xROUTE_CACHE_ENTRY
+        {
+            uint32_t ulDestination;         /**< The IPv4 destination address. */
+            NetworkEndPoint_t * pxEndPoint; /**< The end-point on the same network, or NULL when the gateway must be used. */
+            uint32_t ulGeneration;          /**< The value of ulRouteCacheGeneration when the slot was filled. */
+        } RouteCacheEntry_t;
+
+/** @brief Incremented each time the end-points change, which invalidates all cached
+ *         results at once. Zero is never used, so that empty slots are invalid. */
+        static uint32_t ulRouteCacheGeneration = 1U;
+
+/** @brief The cached results of FreeRTOS_FindEndPointOnNetMask(). */
+        static RouteCacheEntry_t xRouteCache[ ipconfigROUTE_CACHE_ENTRIES ];
+
+/** @brief The cached results of FreeRTOS_FindGateWay(), for IPv4 and IPv6. */
+        static NetworkEndPoint_t * pxGatewayCache[ 2 ];
+
+/** @brief The generation of the entries in pxGatewayCache[]. */
+        static uint32_t ulGatewayCacheGeneration[ 2 ];
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+
+/** @brief One slot of the IPv6 address and prefix indexes. */
+            typedef struct xROUTE_CACHE_ENTRY_IPv6
+            {
+                IPv6_Address_t xAddress;        /**< The IPv6 address that was looked up. */
+                NetworkEndPoint_t * pxEndPoint; /**< The end-point that was found, or NULL. */
+                uint32_t ulGeneration;          /**< The value of ulRouteCacheGeneration when the slot was filled. */
+            } RouteCacheEntry_IPv6_t;
+
+/** @brief The end-points found by prvLocalIPv6CacheLookup(), indexed by their own address. */
+            static RouteCacheEntry_IPv6_t xLocalIPv6Cache[ ipconfigROUTE_CACHE_ENTRIES ];
+
+/** @brief The cached results of FreeRTOS_FindEndPointOnNetMask_IPv6(). */
+            static RouteCacheEntry_IPv6_t xRouteCache_IPv6[ ipconfigROUTE_CACHE_ENTRIES ];
+        #endif
+
+/**
+ * @brief Invalidate all cached routes. Called when end-points are added, go up
+ *        or down, or when their addressing changes.
+ */
+        void FreeRTOS_RouteCacheInvalidate( void )
+        {
+            taskENTER_CRITICAL();
+            {
+                ulRouteCacheGeneration++;
+
+                if( ulRouteCacheGeneration == 0U )
+                {
+                    /* Wrapped around, make sure that no old slot becomes valid again. */
+                    ( void ) memset( xRouteCache, 0, sizeof( xRouteCache ) );
+                    ( void ) memset( ulGatewayCacheGeneration, 0, sizeof( ulGatewayCacheGeneration ) );
+                    #if ( ipconfigUSE_IPv6 != 0 )
+                        ( void ) memset( xLocalIPv6Cache, 0, sizeof( xLocalIPv6Cache ) );
+                        ( void ) memset( xRouteCache_IPv6, 0, sizeof( xRouteCache_IPv6 ) );
+                    #endif
+                    ulRouteCacheGeneration = 1U;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find an end-point on the same network as an IPv4 address, using the
+ *        route cache.
+ *
+ * @param[in] ulIPAddress The IP-address for which an end-point is looked-up.
+ *
+ * @return An end-point that has the same network mask as the given IP-address,
+ *         or NULL.
+ */
+        static NetworkEndPoint_t * prvRouteCacheLookup( uint32_t ulIPAddress )
+        {
+            uint32_t ulHash = ulIPAddress ^ ( ulIPAddress >> 16 );
+            RouteCacheEntry_t * pxEntry;
+            NetworkEndPoint_t * pxEndPoint = NULL;
+            BaseType_t xFound = pdFALSE;
+            uint32_t ulGeneration;
+
+            ulHash ^= ulHash >> 8;
+            pxEntry = &( xRouteCache[ ulHash & routeCACHE_MASK ] );
+
+            taskENTER_CRITICAL();
+            {
+                ulGeneration = ulRouteCacheGeneration;
+
+                if( ( pxEntry->ulGeneration == ulGeneration ) && ( pxEntry->ulDestination == ulIPAddress ) )
+                {
+                    pxEndPoint = pxEntry->pxEndPoint;
+                    xFound = pdTRUE;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xFound == pdFALSE )
+            {
+                pxEndPoint = FreeRTOS_InterfaceEndPointOnNetMask( NULL, ulIPAddress );
+
+                taskENTER_CRITICAL();
+                {
+                    /* When the end-points changed in the mean time, the old
+                     * generation makes sure that this slot will not be used. */
+                    pxEntry->ulDestination = ulIPAddress;
+                    pxEntry->pxEndPoint = pxEndPoint;
+                    pxEntry->ulGeneration = ulGeneration;
+                }
+                taskEXIT_CRITICAL();
+            }
+
+            return pxEndPoint;
+        }
+/*-----------------------------------------------------------*/
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+
+/**
+ * @brief Get the slot of an IPv6 address in one of the IPv6 indexes.
+ *
+ * @param[in] pxTable The index, either xLocalIPv6Cache or xRouteCache_IPv6.
+ * @param[in] pxIPAddress The IPv6 address.
+ *
+ * @return The slot in which pxIPAddress may be stored.
+ */
+            static RouteCacheEntry_IPv6_t * prvRouteCacheSlot_IPv6( RouteCacheEntry_IPv6_t * pxTable,
+                                                                    const IPv6_Address_t * pxIPAddress )
+            {
+                uint32_t ulWords[ 4 ];
+                uint32_t ulHash;
+
+                ( void ) memcpy( ulWords, pxIPAddress->ucBytes, sizeof( ulWords ) );
+                ulHash = ulWords[ 0 ] ^ ulWords[ 1 ] ^ ulWords[ 2 ] ^ ulWords[ 3 ];
+                ulHash ^= ulHash >> 16;
+                ulHash ^= ulHash >> 8;
+
+                return &( pxTable[ ulHash & routeCACHE_MASK ] );
+            }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the IPv6 end-point whose address equals the destination address
+ *        of a received packet, using an index that is filled on demand.
+ *
+ * @param[in] pxInterface The interface that received the packet, or NULL.
+ * @param[in] pxIPAddress The destination address.
+ *
+ * @return The end-point that owns the address, or NULL.
+ */
+            static NetworkEndPoint_t * prvLocalIPv6CacheLookup( const NetworkInterface_t * pxInterface,
+                                                                const IPv6_Address_t * pxIPAddress )
+            {
+                RouteCacheEntry_IPv6_t * pxEntry = prvRouteCacheSlot_IPv6( xLocalIPv6Cache, pxIPAddress );
+                NetworkEndPoint_t * pxEndPoint = NULL;
+                BaseType_t xFound = pdFALSE;
+                uint32_t ulGeneration;
+
+                taskENTER_CRITICAL();
+                {
+                    ulGeneration = ulRouteCacheGeneration;
+
+                    if( ( pxEntry->ulGeneration == ulGeneration ) &&
+                        ( memcmp( pxEntry->xAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) )
+                    {
+                        pxEndPoint = pxEntry->pxEndPoint;
+                        xFound = pdTRUE;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( ( xFound != pdFALSE ) &&
+                    ( memcmp( pxEndPoint->ipv6_settings.xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) != 0 ) )
+                {
+                    /* SLAAC or DHCPv6 gave the end-point another address. */
+                    xFound = pdFALSE;
+                }
+
+                if( xFound == pdFALSE )
+                {
+                    for( pxEndPoint = FreeRTOS_FirstEndPoint( NULL );
+                         pxEndPoint != NULL;
+                         pxEndPoint = FreeRTOS_NextEndPoint( NULL, pxEndPoint ) )
+                    {
+                        if( ( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED ) &&
+                            ( memcmp( pxEndPoint->ipv6_settings.xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) )
+                        {
+                            break;
+                        }
+                    }
+
+                    if( pxEndPoint != NULL )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            ( void ) memcpy( pxEntry->xAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                            pxEntry->pxEndPoint = pxEndPoint;
+                            pxEntry->ulGeneration = ulGeneration;
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                }
+
+                if( ( pxEndPoint != NULL ) && ( pxInterface != NULL ) && ( pxEndPoint->pxNetworkInterface != pxInterface ) )
+                {
+                    /* The address belongs to another interface. */
+                    pxEndPoint = NULL;
+                }
+
+                return pxEndPoint;
+            }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find an end-point on the same network as an IPv6 address, using the
+ *        IPv6 prefix index.
+ *
+ * @param[in] pxIPAddress The IPv6 address for which an end-point is looked-up.
+ *
+ * @return An end-point whose prefix covers the given address, or NULL.
+ */
+            static NetworkEndPoint_t * prvRouteCacheLookup_IPv6( const IPv6_Address_t * pxIPAddress )
+            {
+                RouteCacheEntry_IPv6_t * pxEntry = prvRouteCacheSlot_IPv6( xRouteCache_IPv6, pxIPAddress );
+                NetworkEndPoint_t * pxEndPoint = NULL;
+                BaseType_t xFound = pdFALSE;
+                uint32_t ulGeneration;
+
+                taskENTER_CRITICAL();
+                {
+                    ulGeneration = ulRouteCacheGeneration;
+
+                    if( ( pxEntry->ulGeneration == ulGeneration ) &&
+                        ( memcmp( pxEntry->xAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) )
+                    {
+                        pxEndPoint = pxEntry->pxEndPoint;
+                        xFound = pdTRUE;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( xFound == pdFALSE )
+                {
+                    pxEndPoint = FreeRTOS_InterfaceEPInSameSubnet_IPv6( NULL, pxIPAddress );
+
+                    taskENTER_CRITICAL();
+                    {
+                        ( void ) memcpy( pxEntry->xAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                        pxEntry->pxEndPoint = pxEndPoint;
+                        pxEntry->ulGeneration = ulGeneration;
+                    }
+                    taskEXIT_CRITICAL();
+                }
+
+                return pxEndPoint;
+            }
+/*-----------------------------------------------------------*/
+
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+    #endif /* ( ipconfigUSE_ROUTE_CACHE != 0 ) */
+
 /**
  * @brief Add a network interface to the list of interfaces.  Check if the interface was
  *        already added in an earlier call.
@@ -154,6 +429,53 @@ struct xIPv6_Couple
 
         if( pxInterface != NULL )
         {
+            #if ( ipconfigUSE_NETWORK_RX_RING != 0 )
+            {
+                /* Interfaces are added before the IP-task runs, the receive
+                 * ring is still empty. */
+                ( void ) memset( &( pxInterface->xRxRing ), 0, sizeof( pxInterface->xRxRing ) );
+            }
+            #endif
+
+            #if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+            {
+                /* The IP-task will fill the reserve. */
+                ( void ) memset( &( pxInterface->xRxReserve ), 0, sizeof( pxInterface->xRxReserve ) );
+            }
+            #endif
+
+            #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+            {
+                pxInterface->xPollPending = pdFALSE;
+            }
+            #endif
+
+            #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+            {
+                pxInterface->pxTxHeld = NULL;
+                pxInterface->xTxBusy = pdFALSE;
+                pxInterface->xTxReadyPending = pdFALSE;
+            }
+            #endif
+
+            #if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+            {
+                /* The end-points will add their MAC addresses. */
+                prvMACFilterInit( pxInterface );
+            }
+            #endif
+
+            #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+            {
+                if( pxInterface->xTxMutex == NULL )
+                {
+                    /* When the mutex can not be created, all packets are sent
+                     * by the IP-task. */
+                    pxInterface->xTxMutex = xSemaphoreCreateMutex();
+                }
+            }
+            #endif
+
             if( pxNetworkInterfaces == NULL )
             {
                 /* No other interfaces are set yet, so this is the first in the list. */
@@ -299,6 +621,14 @@ struct xIPv6_Couple
             }
         #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
+        FreeRTOS_RouteCacheInvalidate();
+
+        #if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+        {
+            vMACFilterUpdateEndPoints( pxInterface );
+        }
+        #endif
+
         return pxEndPoint;
     }
 /*-----------------------------------------------------------*/
@@ -416,7 +746,26 @@ struct xIPv6_Couple
  */
         NetworkEndPoint_t * FreeRTOS_FindEndPointOnIP_IPv6( const IPv6_Address_t * pxIPAddress )
         {
-            return FreeRTOS_InterfaceEPInSameSubnet_IPv6( NULL, pxIPAddress );
+            NetworkEndPoint_t * pxEndPoint;
+
+            #if ( ipconfigUSE_ROUTE_CACHE != 0 )
+            {
+                /* The end-point that owns the address is preferred over
+                 * another end-point on the same prefix. */
+                pxEndPoint = prvLocalIPv6CacheLookup( NULL, pxIPAddress );
+
+                if( pxEndPoint == NULL )
+                {
+                    pxEndPoint = prvRouteCacheLookup_IPv6( pxIPAddress );
+                }
+            }
+            #else
+            {
+                pxEndPoint = FreeRTOS_InterfaceEPInSameSubnet_IPv6( NULL, pxIPAddress );
+            }
+            #endif
+
+            return pxEndPoint;
         }
     #endif /* ipconfigUSE_IPv6 */
 /*-----------------------------------------------------------*/
@@ -472,7 +821,19 @@ struct xIPv6_Couple
  */
     NetworkEndPoint_t * FreeRTOS_FindEndPointOnNetMask( uint32_t ulIPAddress )
     {
-        return FreeRTOS_InterfaceEndPointOnNetMask( NULL, ulIPAddress );
+        NetworkEndPoint_t * pxEndPoint;
+
+        #if ( ipconfigUSE_ROUTE_CACHE != 0 )
+        {
+            pxEndPoint = prvRouteCacheLookup( ulIPAddress );
+        }
+        #else
+        {
+            pxEndPoint = FreeRTOS_InterfaceEndPointOnNetMask( NULL, ulIPAddress );
+        }
+        #endif
+
+        return pxEndPoint;
     }
 /*-----------------------------------------------------------*/
 
@@ -649,7 +1010,19 @@ struct xIPv6_Couple
  */
         NetworkEndPoint_t * FreeRTOS_FindEndPointOnNetMask_IPv6( const IPv6_Address_t * pxIPv6Address )
         {
-            return FreeRTOS_InterfaceEPInSameSubnet_IPv6( NULL, pxIPv6Address );
+            NetworkEndPoint_t * pxEndPoint;
+
+            #if ( ipconfigUSE_ROUTE_CACHE != 0 )
+            {
+                pxEndPoint = prvRouteCacheLookup_IPv6( pxIPv6Address );
+            }
+            #else
+            {
+                pxEndPoint = FreeRTOS_InterfaceEPInSameSubnet_IPv6( NULL, pxIPv6Address );
+            }
+            #endif
+
+            return pxEndPoint;
         }
     #endif /* ipconfigUSE_IPv6 */
 /*-----------------------------------------------------------*/
@@ -846,6 +1219,7 @@ struct xIPv6_Couple
                                                    const uint8_t * pucEthernetBuffer )
     {
         NetworkEndPoint_t * pxEndPoint = NULL;
+        const NetworkInterface_t * pxInterface = pxNetworkInterface;
         /* MISRA Ref 11.3.1 [Misaligned access] */
         /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
         /* coverity[misra_c_2012_rule_11_3_violation] */
@@ -860,6 +1234,14 @@ struct xIPv6_Couple
 
         configASSERT( pucEthernetBuffer != NULL );
 
+        #if ( ipconfigUSE_LINK_BONDING != 0 )
+            if( ( pxInterface != NULL ) && ( pxInterface->pxBond != NULL ) )
+            {
+                /* The end-points of a bond member belong to the bond. */
+                pxInterface = pxInterface->pxBond;
+            }
+        #endif
+
         /* Check if 'pucEthernetBuffer()' has the expected alignment,
          * which is 32-bits + 2. */
         #ifndef _lint
@@ -954,16 +1336,41 @@ struct xIPv6_Couple
                     break;
             }
 
+            #if ( ( ipconfigUSE_ROUTE_CACHE != 0 ) && ( ipconfigUSE_IPv6 != 0 ) )
+                if( ( xDoProcessPacket == pdTRUE ) && ( usFrameType == ipIPv6_FRAME_TYPE ) )
+                {
+                    /* A packet for one of the unicast addresses does not need the
+                     * scoring in pxEasyFit(). */
+                    pxEndPoint = prvLocalIPv6CacheLookup( pxInterface, &( xIPAddressTo.xIP_IPv6 ) );
+
+                    if( pxEndPoint != NULL )
+                    {
+                        xDoProcessPacket = pdFALSE;
+                    }
+                }
+            #endif
+
             if( xDoProcessPacket == pdTRUE )
             {
                 ( void ) memcpy( xMACAddress.ucBytes, pxPacket->xUDPPacket.xEthernetHeader.xDestinationAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
-                pxEndPoint = pxEasyFit( pxNetworkInterface,
+                pxEndPoint = pxEasyFit( pxInterface,
                                         usFrameType,
                                         &xIPAddressFrom,
                                         &xIPAddressTo,
                                         &xMACAddress );
             }
         }
+
+        #if ( ipconfigUSE_VLAN != 0 )
+            if( pxEndPoint == NULL )
+            {
+                /* The frame may belong to a VLAN of this interface. Let it
+                 * pass, the IP-task will look for the end-point again once it
+                 * knows the VLAN, see xVLANReceive(). */
+                pxEndPoint = pxVLANAnyEndPoint( pxInterface );
+            }
+        #endif
+
         return pxEndPoint;
     }
 /*-----------------------------------------------------------*/
@@ -979,6 +1386,23 @@ struct xIPv6_Couple
     {
         NetworkEndPoint_t * pxEndPoint = pxNetworkEndPoints;
 
+        #if ( ipconfigUSE_ROUTE_CACHE != 0 )
+            size_t uxSlot = ( xIPType == ( BaseType_t ) ipTYPE_IPv6 ) ? 1U : 0U;
+            uint32_t ulGeneration;
+
+            taskENTER_CRITICAL();
+            {
+                ulGeneration = ulRouteCacheGeneration;
+
+                if( ulGatewayCacheGeneration[ uxSlot ] == ulGeneration )
+                {
+                    /* Skip the loop below. */
+                    pxEndPoint = NULL;
+                }
+            }
+            taskEXIT_CRITICAL();
+        #endif /* if ( ipconfigUSE_ROUTE_CACHE != 0 ) */
+
         while( pxEndPoint != NULL )
         {
             #if ( ipconfigUSE_IPv6 == 0 )
@@ -1016,495 +1440,1992 @@ struct xIPv6_Couple
             pxEndPoint = pxEndPoint->pxNext;
         }
 
+        #if ( ipconfigUSE_ROUTE_CACHE != 0 )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( ulGatewayCacheGeneration[ uxSlot ] == ulGeneration )
+                {
+                    pxEndPoint = pxGatewayCache[ uxSlot ];
+                }
+                else
+                {
+                    pxGatewayCache[ uxSlot ] = pxEndPoint;
+                    ulGatewayCacheGeneration[ uxSlot ] = ulGeneration;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        #endif /* if ( ipconfigUSE_ROUTE_CACHE != 0 ) */
+
         return pxEndPoint;
     }
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_IPv6 != 0 )
-
-/* Get the first end-point belonging to a given interface.
- * When pxInterface is NULL, the very first end-point will be returned. */
+    #if ( ipconfigUSE_ROUTE_ECMP != 0 )
 
 /**
- * @brief Find the first IPv6 end-point.
+ * @brief Calculate the weight of a path for a destination.  The path with the
+ *        highest weight is used ( rendezvous hashing ), so when a path goes
+ *        down, only the destinations that used it will move.
  *
- * @param[in] pxInterface Either NULL ( don't care ), or a specific interface.
+ * @param[in] pxDestination The destination address.
+ * @param[in] xIPType ipTYPE_IPv4 or ipTYPE_IPv6.
+ * @param[in] pxPath The route or end-point that identifies the path.
  *
- * @return The end-point found, or NULL when there are no end-points at all.
+ * @return The weight of the path.
  */
-        NetworkEndPoint_t * FreeRTOS_FirstEndPoint_IPv6( const NetworkInterface_t * pxInterface )
+        static uint32_t prvRoutePathWeight( const IP_Address_t * pxDestination,
+                                            BaseType_t xIPType,
+                                            const void * pxPath )
         {
-            NetworkEndPoint_t * pxEndPoint = pxNetworkEndPoints;
+            const uint8_t * pucBytes;
+            size_t uxLength;
+            size_t uxIndex;
+            uint32_t ulHash = 2166136261U ^ ( uint32_t ) ( ( uintptr_t ) pxPath );
 
-            while( pxEndPoint != NULL )
+            if( xIPType == ( BaseType_t ) ipTYPE_IPv6 )
             {
-                if( ( ( pxInterface == NULL ) || ( pxEndPoint->pxNetworkInterface == pxInterface ) ) && ( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED ) )
-                {
-                    break;
-                }
+                pucBytes = pxDestination->xIP_IPv6.ucBytes;
+                uxLength = ipSIZE_OF_IPv6_ADDRESS;
+            }
+            else
+            {
+                pucBytes = ( const uint8_t * ) &( pxDestination->ulIP_IPv4 );
+                uxLength = ipSIZE_OF_IPv4_ADDRESS;
+            }
 
-                pxEndPoint = pxEndPoint->pxNext;
+            /* FNV-1a over the address, followed by a final mix so that
+             * neighbouring addresses get unrelated weights. */
+            for( uxIndex = 0U; uxIndex < uxLength; uxIndex++ )
+            {
+                ulHash = ( ulHash ^ ( uint32_t ) pucBytes[ uxIndex ] ) * 16777619U;
             }
 
-            return pxEndPoint;
+            ulHash ^= ulHash >> 16;
+            ulHash *= 0x85ebca6bU;
+            ulHash ^= ulHash >> 13;
+            ulHash *= 0xc2b2ae35U;
+            ulHash ^= ulHash >> 16;
+
+            return ulHash;
         }
-    #endif /* ipconfigUSE_IPv6 */
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Get the end-point that is bound to a socket.
+ * @brief Check if an end-point is up and has a gateway of a certain type.
  *
- * @param[in] xSocket The socket of interest.
+ * @param[in] pxEndPoint The end-point to check.
+ * @param[in] xIPType ipTYPE_IPv4 or ipTYPE_IPv6.
  *
- * @return An end-point or NULL in case the socket is not bound to an end-point.
+ * @return pdTRUE when the end-point can be used to reach a gateway.
  */
-    NetworkEndPoint_t * pxGetSocketEndpoint( ConstSocket_t xSocket )
-    {
-        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        NetworkEndPoint_t * pxResult;
-
-        if( pxSocket != NULL )
-        {
-            pxResult = pxSocket->pxEndPoint;
-        }
-        else
+        static BaseType_t prvEndPointIsUplink( const NetworkEndPoint_t * pxEndPoint,
+                                               BaseType_t xIPType )
         {
-            pxResult = NULL;
-        }
+            BaseType_t xReturn = pdFALSE;
 
-        return pxResult;
-    }
-/*-----------------------------------------------------------*/
+            if( pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED )
+            {
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    if( ( xIPType == ( BaseType_t ) ipTYPE_IPv6 ) && ( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED ) )
+                    {
+                        if( memcmp( FreeRTOS_in6addr_any.ucBytes, pxEndPoint->ipv6_settings.xGatewayAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) != 0 )
+                        {
+                            xReturn = pdTRUE;
+                        }
+                    }
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
-/**
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    if( ( xIPType == ( BaseType_t ) ipTYPE_IPv4 ) && ( pxEndPoint->bits.bIPv6 == pdFALSE_UNSIGNED ) )
+                    {
+                        if( pxEndPoint->ipv4_settings.ulGatewayAddress != 0U )
+                        {
+                            xReturn = pdTRUE;
+                        }
+                    }
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the end-point with a gateway that leads to a destination. When
+ *        several end-points that are up have a gateway, the destination
+ *        address selects one of them.
+ *
+ * @param[in] pxDestination The destination address.
+ * @param[in] xIPType The type of Gateway to look for ( ipTYPE_IPv4 or ipTYPE_IPv6 ).
+ *
+ * @return The end-point that will lead to the gateway, or NULL when no gateway was found.
+ */
+        NetworkEndPoint_t * FreeRTOS_FindGateWayForDestination( const IP_Address_t * pxDestination,
+                                                                BaseType_t xIPType )
+        {
+            NetworkEndPoint_t * pxEndPoint;
+            NetworkEndPoint_t * pxBest = NULL;
+            uint32_t ulBestWeight = 0U;
+
+            for( pxEndPoint = pxNetworkEndPoints; pxEndPoint != NULL; pxEndPoint = pxEndPoint->pxNext )
+            {
+                if( prvEndPointIsUplink( pxEndPoint, xIPType ) != pdFALSE )
+                {
+                    uint32_t ulWeight = prvRoutePathWeight( pxDestination, xIPType, pxEndPoint );
+
+                    if( ( pxBest == NULL ) || ( ulWeight > ulBestWeight ) )
+                    {
+                        pxBest = pxEndPoint;
+                        ulBestWeight = ulWeight;
+                    }
+                }
+            }
+
+            if( pxBest == NULL )
+            {
+                /* No uplink is up, use the first end-point with a gateway. */
+                pxBest = FreeRTOS_FindGateWay( xIPType );
+            }
+
+            return pxBest;
+        }
+/*-----------------------------------------------------------*/
+    #endif /* ( ipconfigUSE_ROUTE_ECMP != 0 ) */
+
+    #if ( ipconfigUSE_IPv6 != 0 )
+
+/* Get the first end-point belonging to a given interface.
+ * When pxInterface is NULL, the very first end-point will be returned. */
+
+/**
+ * @brief Find the first IPv6 end-point.
+ *
+ * @param[in] pxInterface Either NULL ( don't care ), or a specific interface.
+ *
+ * @return The end-point found, or NULL when there are no end-points at all.
+ */
+        NetworkEndPoint_t * FreeRTOS_FirstEndPoint_IPv6( const NetworkInterface_t * pxInterface )
+        {
+            NetworkEndPoint_t * pxEndPoint = pxNetworkEndPoints;
+
+            while( pxEndPoint != NULL )
+            {
+                if( ( ( pxInterface == NULL ) || ( pxEndPoint->pxNetworkInterface == pxInterface ) ) && ( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED ) )
+                {
+                    break;
+                }
+
+                pxEndPoint = pxEndPoint->pxNext;
+            }
+
+            return pxEndPoint;
+        }
+    #endif /* ipconfigUSE_IPv6 */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the end-point that is bound to a socket.
+ *
+ * @param[in] xSocket The socket of interest.
+ *
+ * @return An end-point or NULL in case the socket is not bound to an end-point.
+ */
+    NetworkEndPoint_t * pxGetSocketEndpoint( ConstSocket_t xSocket )
+    {
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        NetworkEndPoint_t * pxResult;
+
+        if( pxSocket != NULL )
+        {
+            pxResult = pxSocket->pxEndPoint;
+        }
+        else
+        {
+            pxResult = NULL;
+        }
+
+        return pxResult;
+    }
+/*-----------------------------------------------------------*/
+
+/**
  * @brief Assign an end-point to a socket.
  *
- * @param[in] xSocket The socket to which an end-point will be assigned.
- * @param[in] pxEndPoint The end-point to be assigned.
+ * @param[in] xSocket The socket to which an end-point will be assigned.
+ * @param[in] pxEndPoint The end-point to be assigned.
+ */
+    void vSetSocketEndpoint( Socket_t xSocket,
+                             NetworkEndPoint_t * pxEndPoint )
+    {
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+
+        if( pxSocket != NULL )
+        {
+            pxSocket->pxEndPoint = pxEndPoint;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_STATIC_ROUTES != 0 )
+
+/** @brief The number of nodes in the route trie. A path-compressed trie with N
+ *         prefixes never needs more than 2 * N - 1 nodes. */
+        #define routeNODE_COUNT    ( 2U * ( size_t ) ipconfigMAX_STATIC_ROUTES )
+
+/** @brief A static route, as added by FreeRTOS_AddRoute(). */
+        typedef struct xSTATIC_ROUTE
+        {
+            uint8_t ucPrefix[ ipSIZE_OF_IPv6_ADDRESS ]; /**< The network prefix in network byte order, host bits cleared. */
+            IP_Address_t xGateway;                      /**< The next hop, ignored when ucOnLink is set. */
+            NetworkEndPoint_t * pxEndPoint;             /**< The end-point to send from, or NULL when this row is free. */
+            struct xSTATIC_ROUTE * pxNext;              /**< The next route for the same prefix, with an equal or higher metric. */
+            uint8_t ucPrefixLength;                     /**< The number of significant bits in ucPrefix. */
+            uint8_t ucMetric;                           /**< Routes with a lower metric are preferred. */
+            uint8_t ucFamily;                           /**< 0 for IPv4, 1 for IPv6. */
+            uint8_t ucOnLink;                           /**< pdTRUE_UNSIGNED when the destination is on the link, without a gateway. */
+        } StaticRoute_t;
+
+/** @brief A node of the route trie. Nodes without routes only exist to branch. */
+        typedef struct xROUTE_NODE
+        {
+            uint8_t ucKey[ ipSIZE_OF_IPv6_ADDRESS ]; /**< The prefix of this node, bits beyond ucBits are cleared. */
+            StaticRoute_t * pxRoutes;                /**< The routes for exactly this prefix, sorted on metric. */
+            uint16_t usChild[ 2 ];                   /**< The index + 1 of the children for bit value 0 and 1, or 0. */
+            uint8_t ucBits;                          /**< The length of the prefix of this node. */
+        } RouteNode_t;
+
+/** @brief The static routes. */
+        static StaticRoute_t xStaticRoutes[ ipconfigMAX_STATIC_ROUTES ];
+
+/** @brief The storage for the trie nodes, handed out in order by prvRouteNodeNew(). */
+        static RouteNode_t xRouteNodes[ routeNODE_COUNT ];
+
+/** @brief The number of nodes in use in xRouteNodes[]. */
+        static size_t uxRouteNodeCount = 0U;
+
+/** @brief The index + 1 of the root node for IPv4 and IPv6, or 0 when there are no routes. */
+        static uint16_t usRouteRoot[ 2 ] = { 0U, 0U };
+
+/**
+ * @brief Get the value of one bit of an address.
+ *
+ * @param[in] pucKey The address in network byte order.
+ * @param[in] uxBit The bit number, where 0 is the most significant bit.
+ *
+ * @return 0 or 1.
+ */
+        static size_t prvRouteBit( const uint8_t * pucKey,
+                                   size_t uxBit )
+        {
+            return ( ( size_t ) pucKey[ uxBit >> 3 ] >> ( 7U - ( uxBit & 7U ) ) ) & 1U;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Clear the bits of an address that follow its prefix.
+ *
+ * @param[in,out] pucKey The address, ipSIZE_OF_IPv6_ADDRESS bytes long.
+ * @param[in] uxBits The length of the prefix.
+ */
+        static void prvRouteMask( uint8_t * pucKey,
+                                  size_t uxBits )
+        {
+            size_t uxIndex = uxBits >> 3;
+
+            if( ( uxBits & 7U ) != 0U )
+            {
+                pucKey[ uxIndex ] &= ( uint8_t ) ( 0xffU << ( 8U - ( uxBits & 7U ) ) );
+                uxIndex++;
+            }
+
+            if( uxIndex < ipSIZE_OF_IPv6_ADDRESS )
+            {
+                ( void ) memset( &( pucKey[ uxIndex ] ), 0, ipSIZE_OF_IPv6_ADDRESS - uxIndex );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Count the number of leading bits that two addresses have in common.
+ *
+ * @param[in] pucLeft The first address.
+ * @param[in] pucRight The second address.
+ * @param[in] uxMaxBits Stop comparing after this many bits.
+ *
+ * @return The length of the common prefix, at most uxMaxBits.
+ */
+        static size_t prvRouteCommonBits( const uint8_t * pucLeft,
+                                          const uint8_t * pucRight,
+                                          size_t uxMaxBits )
+        {
+            size_t uxBits = 0U;
+
+            /* Whole bytes first. */
+            while( ( uxBits < uxMaxBits ) && ( pucLeft[ uxBits >> 3 ] == pucRight[ uxBits >> 3 ] ) )
+            {
+                uxBits += 8U;
+            }
+
+            while( ( uxBits < uxMaxBits ) && ( prvRouteBit( pucLeft, uxBits ) == prvRouteBit( pucRight, uxBits ) ) )
+            {
+                uxBits++;
+            }
+
+            if( uxBits > uxMaxBits )
+            {
+                uxBits = uxMaxBits;
+            }
+
+            return uxBits;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take a node from xRouteNodes[].
+ *
+ * @param[in] pucKey The prefix of the new node.
+ * @param[in] uxBits The length of the prefix.
+ * @param[in] pxRoute The route for this prefix, or NULL for a branch node.
+ *
+ * @return The index + 1 of the new node.
+ */
+        static uint16_t prvRouteNodeNew( const uint8_t * pucKey,
+                                         size_t uxBits,
+                                         StaticRoute_t * pxRoute )
+        {
+            RouteNode_t * pxNode;
+
+            /* The bound on the number of nodes makes this impossible. */
+            configASSERT( uxRouteNodeCount < routeNODE_COUNT );
+
+            pxNode = &( xRouteNodes[ uxRouteNodeCount ] );
+            uxRouteNodeCount++;
+
+            ( void ) memcpy( pxNode->ucKey, pucKey, sizeof( pxNode->ucKey ) );
+            prvRouteMask( pxNode->ucKey, uxBits );
+
+            pxNode->usChild[ 0 ] = 0U;
+            pxNode->usChild[ 1 ] = 0U;
+            pxNode->ucBits = ( uint8_t ) uxBits;
+            pxNode->pxRoutes = pxRoute;
+
+            return ( uint16_t ) uxRouteNodeCount;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a route to the trie of its address family.
+ *
+ * @param[in] pxRoute The route, its prefix has been masked already.
+ */
+        static void prvRouteTrieInsert( StaticRoute_t * pxRoute )
+        {
+            uint16_t * pusLink = &( usRouteRoot[ pxRoute->ucFamily ] );
+            size_t uxLength = pxRoute->ucPrefixLength;
+            BaseType_t xDone = pdFALSE;
+
+            pxRoute->pxNext = NULL;
+
+            while( xDone == pdFALSE )
+            {
+                RouteNode_t * pxNode;
+                size_t uxCommon;
+
+                if( *pusLink == 0U )
+                {
+                    *pusLink = prvRouteNodeNew( pxRoute->ucPrefix, uxLength, pxRoute );
+                    xDone = pdTRUE;
+                    continue;
+                }
+
+                pxNode = &( xRouteNodes[ *pusLink - 1U ] );
+                uxCommon = prvRouteCommonBits( pxNode->ucKey, pxRoute->ucPrefix, FreeRTOS_min_size_t( pxNode->ucBits, uxLength ) );
+
+                if( uxCommon == pxNode->ucBits )
+                {
+                    if( uxLength == pxNode->ucBits )
+                    {
+                        /* Same prefix: add it to the list, ordered on metric. */
+                        StaticRoute_t ** ppxRoute = &( pxNode->pxRoutes );
+
+                        while( ( *ppxRoute != NULL ) && ( ( *ppxRoute )->ucMetric <= pxRoute->ucMetric ) )
+                        {
+                            ppxRoute = &( ( *ppxRoute )->pxNext );
+                        }
+
+                        pxRoute->pxNext = *ppxRoute;
+                        *ppxRoute = pxRoute;
+                        xDone = pdTRUE;
+                    }
+                    else
+                    {
+                        /* The node is a shorter prefix of the route, descend. */
+                        pusLink = &( pxNode->usChild[ prvRouteBit( pxRoute->ucPrefix, pxNode->ucBits ) ] );
+                    }
+                }
+                else if( uxCommon == uxLength )
+                {
+                    /* The route is a shorter prefix of the node, insert it above the node. */
+                    uint16_t usNew = prvRouteNodeNew( pxRoute->ucPrefix, uxLength, pxRoute );
+
+                    xRouteNodes[ usNew - 1U ].usChild[ prvRouteBit( pxNode->ucKey, uxLength ) ] = *pusLink;
+                    *pusLink = usNew;
+                    xDone = pdTRUE;
+                }
+                else
+                {
+                    /* The two differ after 'uxCommon' bits, add a branch node. */
+                    uint16_t usBranch = prvRouteNodeNew( pxRoute->ucPrefix, uxCommon, NULL );
+                    uint16_t usLeaf = prvRouteNodeNew( pxRoute->ucPrefix, uxLength, pxRoute );
+
+                    xRouteNodes[ usBranch - 1U ].usChild[ prvRouteBit( pxNode->ucKey, uxCommon ) ] = *pusLink;
+                    xRouteNodes[ usBranch - 1U ].usChild[ prvRouteBit( pxRoute->ucPrefix, uxCommon ) ] = usLeaf;
+                    *pusLink = usBranch;
+                    xDone = pdTRUE;
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Build the tries again from xStaticRoutes[], after a route was removed.
+ */
+        static void prvRouteTrieRebuild( void )
+        {
+            size_t uxIndex;
+
+            uxRouteNodeCount = 0U;
+            usRouteRoot[ 0 ] = 0U;
+            usRouteRoot[ 1 ] = 0U;
+
+            for( uxIndex = 0U; uxIndex < ( size_t ) ipconfigMAX_STATIC_ROUTES; uxIndex++ )
+            {
+                if( xStaticRoutes[ uxIndex ].pxEndPoint != NULL )
+                {
+                    prvRouteTrieInsert( &( xStaticRoutes[ uxIndex ] ) );
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Translate the parameters of FreeRTOS_AddRoute() and FreeRTOS_RemoveRoute()
+ *        to a route with a masked prefix.
+ *
+ * @param[out] pxRoute The route to be filled in.
+ * @param[in] pxPrefix The network prefix.
+ * @param[in] uxPrefixLength The number of significant bits in the prefix.
+ * @param[in] pxGateway The next hop, or NULL when the prefix is on the link.
+ * @param[in] pxEndPoint The end-point, its type determines the address family.
+ *
+ * @return pdPASS when the parameters are valid, otherwise pdFAIL.
+ */
+        static BaseType_t prvRouteFill( StaticRoute_t * pxRoute,
+                                        const IP_Address_t * pxPrefix,
+                                        size_t uxPrefixLength,
+                                        const IP_Address_t * pxGateway,
+                                        NetworkEndPoint_t * pxEndPoint )
+        {
+            BaseType_t xResult = pdFAIL;
+
+            ( void ) memset( pxRoute, 0, sizeof( *pxRoute ) );
+
+            if( ( pxPrefix != NULL ) && ( pxEndPoint != NULL ) )
+            {
+                if( ENDPOINT_IS_IPv6( pxEndPoint ) )
+                {
+                    #if ( ipconfigUSE_IPv6 != 0 )
+                        if( uxPrefixLength <= ( 8U * ipSIZE_OF_IPv6_ADDRESS ) )
+                        {
+                            ( void ) memcpy( pxRoute->ucPrefix, pxPrefix->xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                            pxRoute->ucFamily = 1U;
+                            pxRoute->ucOnLink = ( ( pxGateway == NULL ) ||
+                                                  ( memcmp( pxGateway->xIP_IPv6.ucBytes, FreeRTOS_in6addr_any.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+                            xResult = pdPASS;
+                        }
+                    #endif
+                }
+                else
+                {
+                    if( uxPrefixLength <= ( 8U * ipSIZE_OF_IPv4_ADDRESS ) )
+                    {
+                        ( void ) memcpy( pxRoute->ucPrefix, &( pxPrefix->ulIP_IPv4 ), ipSIZE_OF_IPv4_ADDRESS );
+                        pxRoute->ucFamily = 0U;
+                        pxRoute->ucOnLink = ( ( pxGateway == NULL ) || ( pxGateway->ulIP_IPv4 == 0U ) ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+                        xResult = pdPASS;
+                    }
+                }
+            }
+
+            if( xResult == pdPASS )
+            {
+                /* Clear the host bits, so that equal prefixes compare equal. */
+                prvRouteMask( pxRoute->ucPrefix, uxPrefixLength );
+                pxRoute->ucPrefixLength = ( uint8_t ) uxPrefixLength;
+                pxRoute->pxEndPoint = pxEndPoint;
+
+                if( ( pxRoute->ucOnLink == pdFALSE_UNSIGNED ) && ( pxGateway != NULL ) )
+                {
+                    ( void ) memcpy( &( pxRoute->xGateway ), pxGateway, sizeof( pxRoute->xGateway ) );
+                }
+            }
+
+            return xResult;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a static route.
+ *
+ * @param[in] pxPrefix The destination network.
+ * @param[in] uxPrefixLength The number of significant bits in 'pxPrefix'.
+ * @param[in] pxGateway The next hop, or NULL (or a zero address) when the
+ *                      network is directly reachable on the link.
+ * @param[in] pxEndPoint The end-point through which the network is reached. Its
+ *                       type determines whether this is an IPv4 or IPv6 route.
+ * @param[in] ucMetric When several routes exist for the same prefix, the one
+ *                     with the lowest metric whose end-point is up is used.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EINVAL for invalid parameters,
+ *         -pdFREERTOS_ERRNO_EEXIST when the route exists already, or
+ *         -pdFREERTOS_ERRNO_ENOSPC when ipconfigMAX_STATIC_ROUTES routes exist.
+ */
+        BaseType_t FreeRTOS_AddRoute( const IP_Address_t * pxPrefix,
+                                      size_t uxPrefixLength,
+                                      const IP_Address_t * pxGateway,
+                                      NetworkEndPoint_t * pxEndPoint,
+                                      uint8_t ucMetric )
+        {
+            StaticRoute_t xRoute;
+            StaticRoute_t * pxFree = NULL;
+            BaseType_t xResult = 0;
+            size_t uxIndex;
+
+            if( prvRouteFill( &xRoute, pxPrefix, uxPrefixLength, pxGateway, pxEndPoint ) == pdFAIL )
+            {
+                xResult = -pdFREERTOS_ERRNO_EINVAL;
+            }
+            else
+            {
+                xRoute.ucMetric = ucMetric;
+
+                vTaskSuspendAll();
+                {
+                    for( uxIndex = 0U; uxIndex < ( size_t ) ipconfigMAX_STATIC_ROUTES; uxIndex++ )
+                    {
+                        const StaticRoute_t * pxRoute = &( xStaticRoutes[ uxIndex ] );
+
+                        if( pxRoute->pxEndPoint == NULL )
+                        {
+                            if( pxFree == NULL )
+                            {
+                                pxFree = &( xStaticRoutes[ uxIndex ] );
+                            }
+                        }
+                        else if( ( pxRoute->pxEndPoint == pxEndPoint ) &&
+                                 ( pxRoute->ucPrefixLength == xRoute.ucPrefixLength ) &&
+                                 ( memcmp( pxRoute->ucPrefix, xRoute.ucPrefix, sizeof( xRoute.ucPrefix ) ) == 0 ) &&
+                                 ( memcmp( &( pxRoute->xGateway ), &( xRoute.xGateway ), sizeof( xRoute.xGateway ) ) == 0 ) )
+                        {
+                            xResult = -pdFREERTOS_ERRNO_EEXIST;
+                            break;
+                        }
+                        else
+                        {
+                            /* A route in use for another destination. */
+                        }
+                    }
+
+                    if( xResult == 0 )
+                    {
+                        if( pxFree == NULL )
+                        {
+                            xResult = -pdFREERTOS_ERRNO_ENOSPC;
+                        }
+                        else
+                        {
+                            ( void ) memcpy( pxFree, &xRoute, sizeof( *pxFree ) );
+                            prvRouteTrieInsert( pxFree );
+                        }
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+
+            return xResult;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a static route that was added with FreeRTOS_AddRoute().
+ *
+ * @param[in] pxPrefix The destination network.
+ * @param[in] uxPrefixLength The number of significant bits in 'pxPrefix'.
+ * @param[in] pxGateway The next hop, or NULL for an on-link route.
+ * @param[in] pxEndPoint The end-point of the route.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EINVAL for invalid parameters, or
+ *         -pdFREERTOS_ERRNO_ENOENT when no such route exists.
+ */
+        BaseType_t FreeRTOS_RemoveRoute( const IP_Address_t * pxPrefix,
+                                         size_t uxPrefixLength,
+                                         const IP_Address_t * pxGateway,
+                                         NetworkEndPoint_t * pxEndPoint )
+        {
+            StaticRoute_t xRoute;
+            BaseType_t xResult = -pdFREERTOS_ERRNO_ENOENT;
+            size_t uxIndex;
+
+            if( prvRouteFill( &xRoute, pxPrefix, uxPrefixLength, pxGateway, pxEndPoint ) == pdFAIL )
+            {
+                xResult = -pdFREERTOS_ERRNO_EINVAL;
+            }
+            else
+            {
+                vTaskSuspendAll();
+                {
+                    for( uxIndex = 0U; uxIndex < ( size_t ) ipconfigMAX_STATIC_ROUTES; uxIndex++ )
+                    {
+                        StaticRoute_t * pxRoute = &( xStaticRoutes[ uxIndex ] );
+
+                        if( ( pxRoute->pxEndPoint == pxEndPoint ) &&
+                            ( pxRoute->ucPrefixLength == xRoute.ucPrefixLength ) &&
+                            ( memcmp( pxRoute->ucPrefix, xRoute.ucPrefix, sizeof( xRoute.ucPrefix ) ) == 0 ) &&
+                            ( memcmp( &( pxRoute->xGateway ), &( xRoute.xGateway ), sizeof( xRoute.xGateway ) ) == 0 ) )
+                        {
+                            pxRoute->pxEndPoint = NULL;
+                            xResult = 0;
+                            break;
+                        }
+                    }
+
+                    if( xResult == 0 )
+                    {
+                        /* Nodes are not reused individually, simply build the tries again. */
+                        prvRouteTrieRebuild();
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+
+            return xResult;
+        }
+/*-----------------------------------------------------------*/
+
+        #if ( ipconfigUSE_ROUTE_ECMP != 0 )
+
+/**
+ * @brief Choose between the routes for one prefix that have the same, lowest
+ *        metric, and whose end-points are up.
+ *
+ * @param[in] pxFirst The first route that is up, the list is sorted on metric.
+ * @param[in] pxDestination The destination address.
+ * @param[in] xIPType ipTYPE_IPv4 or ipTYPE_IPv6.
+ *
+ * @return The route to use.
+ */
+            static const StaticRoute_t * prvRouteSelectECMP( const StaticRoute_t * pxFirst,
+                                                             const IP_Address_t * pxDestination,
+                                                             BaseType_t xIPType )
+            {
+                const StaticRoute_t * pxBest = pxFirst;
+                const StaticRoute_t * pxRoute;
+                uint32_t ulBestWeight = prvRoutePathWeight( pxDestination, xIPType, pxFirst );
+
+                for( pxRoute = pxFirst->pxNext;
+                     ( pxRoute != NULL ) && ( pxRoute->ucMetric == pxFirst->ucMetric );
+                     pxRoute = pxRoute->pxNext )
+                {
+                    if( pxRoute->pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED )
+                    {
+                        uint32_t ulWeight = prvRoutePathWeight( pxDestination, xIPType, pxRoute );
+
+                        if( ulWeight > ulBestWeight )
+                        {
+                            pxBest = pxRoute;
+                            ulBestWeight = ulWeight;
+                        }
+                    }
+                }
+
+                return pxBest;
+            }
+/*-----------------------------------------------------------*/
+        #endif /* ( ipconfigUSE_ROUTE_ECMP != 0 ) */
+
+/**
+ * @brief Find the static route with the longest prefix that matches a destination.
+ *
+ * @param[in] pxDestination The destination address.
+ * @param[in] xIPType ipTYPE_IPv4 or ipTYPE_IPv6.
+ * @param[out] pxNextHop The address to resolve at layer 2: either the gateway of the
+ *                       route, or the destination itself for an on-link route.
+ *
+ * @return The end-point to send from, or NULL when no usable route matches.
+ */
+        NetworkEndPoint_t * FreeRTOS_FindRoute( const IP_Address_t * pxDestination,
+                                                BaseType_t xIPType,
+                                                IP_Address_t * pxNextHop )
+        {
+            uint8_t ucAddress[ ipSIZE_OF_IPv6_ADDRESS ];
+            const StaticRoute_t * pxBest = NULL;
+            NetworkEndPoint_t * pxEndPoint = NULL;
+            size_t uxMaxBits;
+            size_t uxFamily;
+            uint16_t usNode;
+
+            ( void ) memset( ucAddress, 0, sizeof( ucAddress ) );
+
+            if( xIPType == ( BaseType_t ) ipTYPE_IPv6 )
+            {
+                ( void ) memcpy( ucAddress, pxDestination->xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                uxMaxBits = 8U * ipSIZE_OF_IPv6_ADDRESS;
+                uxFamily = 1U;
+            }
+            else
+            {
+                ( void ) memcpy( ucAddress, &( pxDestination->ulIP_IPv4 ), ipSIZE_OF_IPv4_ADDRESS );
+                uxMaxBits = 8U * ipSIZE_OF_IPv4_ADDRESS;
+                uxFamily = 0U;
+            }
+
+            vTaskSuspendAll();
+            {
+                usNode = usRouteRoot[ uxFamily ];
+
+                /* Walk down while the nodes match, the last usable route seen is the longest match. */
+                while( usNode != 0U )
+                {
+                    const RouteNode_t * pxNode = &( xRouteNodes[ usNode - 1U ] );
+                    const StaticRoute_t * pxRoute;
+
+                    if( prvRouteCommonBits( pxNode->ucKey, ucAddress, pxNode->ucBits ) < pxNode->ucBits )
+                    {
+                        break;
+                    }
+
+                    for( pxRoute = pxNode->pxRoutes; pxRoute != NULL; pxRoute = pxRoute->pxNext )
+                    {
+                        if( pxRoute->pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED )
+                        {
+                            pxBest = pxRoute;
+                            break;
+                        }
+                    }
+
+                    #if ( ipconfigUSE_ROUTE_ECMP != 0 )
+                        if( ( pxRoute != NULL ) && ( pxRoute->pxNext != NULL ) )
+                        {
+                            /* Spread the destinations over the routes with the
+                             * same metric. */
+                            pxBest = prvRouteSelectECMP( pxRoute, pxDestination, xIPType );
+                        }
+                    #endif
+
+                    if( pxNode->ucBits >= uxMaxBits )
+                    {
+                        break;
+                    }
+
+                    usNode = pxNode->usChild[ prvRouteBit( ucAddress, pxNode->ucBits ) ];
+                }
+
+                if( pxBest != NULL )
+                {
+                    pxEndPoint = pxBest->pxEndPoint;
+
+                    if( pxBest->ucOnLink != pdFALSE_UNSIGNED )
+                    {
+                        ( void ) memcpy( pxNextHop, pxDestination, sizeof( *pxNextHop ) );
+                    }
+                    else
+                    {
+                        ( void ) memcpy( pxNextHop, &( pxBest->xGateway ), sizeof( *pxNextHop ) );
+                    }
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            return pxEndPoint;
+        }
+/*-----------------------------------------------------------*/
+    #endif /* ( ipconfigUSE_STATIC_ROUTES != 0 ) */
+
+#else /* ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 ) */
+
+/* Here below the most important function of FreeRTOS_Routing.c in a short
+ * version: it is assumed that only 1 interface and 1 end-point will be created.
+ * The reason for this is downward compatibility with the earlier release of
+ * FreeRTOS+TCP, which had a single network interface only. */
+
+/**
+ * @brief Add a network interface to the list of interfaces.  Check if this will be
+ *        first and only interface ( ipconfigCOMPATIBLE_WITH_SINGLE = 1 ).
+ *
+ * @param[in] pxInterface The address of the new interface.
+ *
+ * @return The value of the parameter 'pxInterface'.
+ */
+    NetworkInterface_t * FreeRTOS_AddNetworkInterface( NetworkInterface_t * pxInterface )
+    {
+        configASSERT( pxNetworkInterfaces == NULL );
+        #if ( ipconfigUSE_NETWORK_RX_RING != 0 )
+        {
+            ( void ) memset( &( pxInterface->xRxRing ), 0, sizeof( pxInterface->xRxRing ) );
+        }
+        #endif
+        #if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+        {
+            ( void ) memset( &( pxInterface->xRxReserve ), 0, sizeof( pxInterface->xRxReserve ) );
+        }
+        #endif
+        #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+        {
+            pxInterface->xPollPending = pdFALSE;
+        }
+        #endif
+        #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+        {
+            pxInterface->pxTxHeld = NULL;
+            pxInterface->xTxBusy = pdFALSE;
+            pxInterface->xTxReadyPending = pdFALSE;
+        }
+        #endif
+        #if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+        {
+            prvMACFilterInit( pxInterface );
+        }
+        #endif
+        #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+        {
+            if( pxInterface->xTxMutex == NULL )
+            {
+                pxInterface->xTxMutex = xSemaphoreCreateMutex();
+            }
+        }
+        #endif
+        pxNetworkInterfaces = pxInterface;
+        return pxInterface;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief And an end-point to an interface.  Note that when ipconfigCOMPATIBLE_WITH_SINGLE
+ *        is defined, only one interface is allowed, which will have one end-point only.
+ *
+ * @param[in] pxInterface The interface to which the end-point is assigned.
+ * @param[in] pxEndPoint The end-point to be assigned to the above interface.
+ *
+ * @return The value of the parameter 'pxEndPoint'.
+ */
+    static NetworkEndPoint_t * FreeRTOS_AddEndPoint( NetworkInterface_t * pxInterface,
+                                                     NetworkEndPoint_t * pxEndPoint )
+    {
+        /* This code is in backward-compatibility mode.
+         * Only one end-point is allowed, make sure that
+         * no end-point has been defined yet. */
+        configASSERT( pxNetworkEndPoints == NULL );
+
+        /* This end point will go to the end of the list, so there is no pxNext
+         * yet. */
+        pxEndPoint->pxNext = NULL;
+
+        /* Double link between the NetworkInterface_t that is using the addressing
+         * defined by this NetworkEndPoint_t structure. */
+        pxEndPoint->pxNetworkInterface = pxInterface;
+
+        pxInterface->pxEndPoint = pxEndPoint;
+
+        /* No other end points are defined yet - so this is the first in the
+         * list. */
+        pxNetworkEndPoints = pxEndPoint;
+
+        #if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+        {
+            vMACFilterUpdateEndPoints( pxInterface );
+        }
+        #endif
+
+        return pxEndPoint;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the end-point which has a given IPv4 address.
+ *
+ * @param[in] ulIPAddress The IP-address of interest, or 0 if any IPv4 end-point may be returned.
+ *
+ * @return The end-point found or NULL.
+ */
+    NetworkEndPoint_t * FreeRTOS_FindEndPointOnIP_IPv4( uint32_t ulIPAddress )
+    {
+        NetworkEndPoint_t * pxResult = NULL;
+
+        ( void ) ulIPAddress;
+
+        if( ( ulIPAddress == 0U ) || ( pxNetworkEndPoints->ipv4_settings.ulIPAddress == ulIPAddress ) )
+        {
+            pxResult = pxNetworkEndPoints;
+        }
+
+        return pxResult;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the end-point that has a certain MAC-address.
+ *
+ * @param[in] pxMACAddress The Ethernet packet.
+ * @param[in] pxInterface The interface on which the packet was received, or NULL when unknown.
+ *
+ * @return The end-point that has the given MAC-address.
+ */
+    NetworkEndPoint_t * FreeRTOS_FindEndPointOnMAC( const MACAddress_t * pxMACAddress,
+                                                    const NetworkInterface_t * pxInterface )
+    {
+        NetworkEndPoint_t * pxResult = NULL;
+
+        ( void ) pxMACAddress;
+        ( void ) pxInterface;
+
+        if( ( pxMACAddress != NULL ) && ( memcmp( pxNetworkEndPoints->xMACAddress.ucBytes, pxMACAddress->ucBytes, ipMAC_ADDRESS_LENGTH_BYTES ) == 0 ) )
+        {
+            pxResult = pxNetworkEndPoints;
+        }
+
+        return pxResult;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find an end-point that handles a given IPv4-address.
+ *
+ * @param[in] ulIPAddress The IP-address for which an end-point is looked-up.
+ *
+ * @return An end-point that has the same network mask as the given IP-address.
+ */
+    NetworkEndPoint_t * FreeRTOS_FindEndPointOnNetMask( uint32_t ulIPAddress )
+    {
+        return FreeRTOS_InterfaceEndPointOnNetMask( NULL, ulIPAddress );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find an end-point that defines a gateway of a certain type ( IPv4 or IPv6 ).
+ *
+ * @param[in] xIPType The type of Gateway to look for ( ipTYPE_IPv4 or ipTYPE_IPv6 ).
+ *
+ * @return The end-point that will lead to the gateway, or NULL when no gateway was found.
+ */
+    NetworkEndPoint_t * FreeRTOS_FindGateWay( BaseType_t xIPType )
+    {
+        NetworkEndPoint_t * pxReturn = NULL;
+
+        ( void ) xIPType;
+
+        if( pxNetworkEndPoints != NULL )
+        {
+            if( pxNetworkEndPoints->ipv4_settings.ulGatewayAddress != 0U )
+            {
+                pxReturn = pxNetworkEndPoints;
+            }
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the first end-point bound to a given interface.
+ *
+ * @param[in] pxInterface The interface whose first end-point will be returned.
+ *
+ * @return The first end-point that is found to the interface, or NULL when the
+ *         interface doesn't have any end-point yet.
+ */
+    NetworkEndPoint_t * FreeRTOS_FirstEndPoint( const NetworkInterface_t * pxInterface )
+    {
+        ( void ) pxInterface;
+
+        /* ipconfigCOMPATIBLE_WITH_SINGLE is defined and this is the simplified version:
+         * only one interface and one end-point is defined. */
+        return pxNetworkEndPoints;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the first Network Interface, or NULL if none has been added.
+ *
+ * @return The first interface, or NULL if none has been added
+ */
+    NetworkInterface_t * FreeRTOS_FirstNetworkInterface( void )
+    {
+        /* ipconfigCOMPATIBLE_WITH_SINGLE is defined: only one interface and
+         * one end-point is defined. */
+        return pxNetworkInterfaces;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find an end-point that handles a given IPv4-address.
+ *
+ * @param[in] pxInterface Ignored in this simplified version.
+ * @param[in] ulIPAddress The IP-address for which an end-point is looked-up.
+ *
+ * @return An end-point that has the same network mask as the given IP-address.
+ */
+    NetworkEndPoint_t * FreeRTOS_InterfaceEndPointOnNetMask( const NetworkInterface_t * pxInterface,
+                                                             uint32_t ulIPAddress )
+    {
+        NetworkEndPoint_t * pxResult = NULL;
+
+        ( void ) pxInterface;
+
+        if( ( ( ulIPAddress ^ pxNetworkEndPoints->ipv4_settings.ulIPAddress ) & pxNetworkEndPoints->ipv4_settings.ulNetMask ) == 0U )
+        {
+            pxResult = pxNetworkEndPoints;
+        }
+
+        return pxResult;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find out the best matching end-point given an incoming Ethernet packet.
+ *
+ * @param[in] pxNetworkInterface The interface on which the packet was received.
+ * @param[in] pucEthernetBuffer The Ethernet packet that was just received.
+ *
+ * @return The end-point that should handle the incoming Ethernet packet.
+ */
+    NetworkEndPoint_t * FreeRTOS_MatchingEndpoint( const NetworkInterface_t * pxNetworkInterface,
+                                                   const uint8_t * pucEthernetBuffer )
+    {
+        ( void ) pxNetworkInterface;
+        ( void ) pucEthernetBuffer;
+
+        /* ipconfigCOMPATIBLE_WITH_SINGLE is defined: only one interface and
+         * one end-point is defined. */
+        return pxNetworkEndPoints;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the next end-point.  As this is the simplified version, it will always
+ *        return NULL.
+ *
+ * @param[in] pxInterface An interface of interest, or NULL when iterating through all
+ *                         end-points.
+ * @param[in] pxEndPoint This is the current end-point.
+ *
+ * @return NULL because ipconfigCOMPATIBLE_WITH_SINGLE is defined.
+ */
+    NetworkEndPoint_t * FreeRTOS_NextEndPoint( const NetworkInterface_t * pxInterface,
+                                               NetworkEndPoint_t * pxEndPoint )
+    {
+        ( void ) pxInterface;
+        ( void ) pxEndPoint;
+
+        return NULL;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the next interface.
+ *
+ * @return NULL because ipconfigCOMPATIBLE_WITH_SINGLE is defined.
+ */
+    NetworkInterface_t * FreeRTOS_NextNetworkInterface( const NetworkInterface_t * pxInterface )
+    {
+        ( void ) pxInterface;
+
+        return NULL;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_IPv6 != 0 )
+        NetworkEndPoint_t * FreeRTOS_FindEndPointOnIP_IPv6( const IPv6_Address_t * pxIPAddress )
+        {
+            ( void ) pxIPAddress;
+            return pxNetworkEndPoints;
+        }
+
+/*-----------------------------------------------------------*/
+
+        NetworkEndPoint_t * FreeRTOS_FindEndPointOnNetMask_IPv6( const IPv6_Address_t * pxIPv6Address )
+        {
+            ( void ) pxIPv6Address;
+            return pxNetworkEndPoints;
+        }
+
+/*-----------------------------------------------------------*/
+
+        NetworkEndPoint_t * FreeRTOS_FirstEndPoint_IPv6( const NetworkInterface_t * pxInterface )
+        {
+            ( void ) pxInterface;
+            return pxNetworkEndPoints;
+        }
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief If the device endpoint is in the same subnet as the given IP address, return the
+ * endpoint. Otherwise, return NULL.
+ *
+ * @param[in] pxInterface Ignored in this simplified version for single endpoint.
+ * @param[in] ulIPAddress The IP-address for which an end-point is looked-up.
+ *
+ * @return An end-point that is in the same subnet as the given IP-address.
+ */
+        NetworkEndPoint_t * FreeRTOS_InterfaceEPInSameSubnet_IPv6( const NetworkInterface_t * pxInterface,
+                                                                   const IPv6_Address_t * pxIPAddress )
+        {
+            NetworkEndPoint_t * pxResult = NULL;
+
+            ( void ) pxInterface;
+
+            if( xCompareIPv6_Address( &( pxNetworkEndPoints->ipv6_settings.xIPAddress ), pxIPAddress, pxNetworkEndPoints->ipv6_settings.uxPrefixLength ) == 0 )
+            {
+                pxResult = pxNetworkEndPoints;
+            }
+
+            return pxResult;
+        }
+    #endif /* if ( ipconfigUSE_IPv6 != 0 ) */
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 ) */
+
+/**
+ * @brief Returns the IP type of the given IPv6 address.
+ *
+ * @param[in] pxAddress The IPv6 address whose type needs to be returned.
+ * @returns The IP type of the given address.
+ */
+#if ( ipconfigUSE_IPv6 != 0 )
+    IPv6_Type_t xIPv6_GetIPType( const IPv6_Address_t * pxAddress )
+    {
+        IPv6_Type_t eResult = eIPv6_Unknown;
+        BaseType_t xIndex;
+        static const struct xIPv6_Couple xIPCouples[] =
+        {
+            /*    IP-type          Mask     Value */
+            { eIPv6_Global,    0xE000U, 0x2000U }, /* 001 */
+            { eIPv6_LinkLocal, 0xFFC0U, 0xFE80U }, /* 1111 1110 10 */
+            { eIPv6_SiteLocal, 0xFFC0U, 0xFEC0U }, /* 1111 1110 11 */
+            { eIPv6_Multicast, 0xFF00U, 0xFF00U }, /* 1111 1111 */
+            { eIPv6_Loopback,  0xFFFFU, 0x0000U }, /* 0000 0000 ::1 */
+        };
+
+        if( pxAddress != NULL )
+        {
+            for( xIndex = 0; xIndex < ARRAY_SIZE_X( xIPCouples ); xIndex++ )
+            {
+                uint16_t usAddress =
+                    ( uint16_t ) ( ( ( ( uint16_t ) pxAddress->ucBytes[ 0 ] ) << 8 ) |
+                                   ( ( uint16_t ) pxAddress->ucBytes[ 1 ] ) );
+
+                if( xIPCouples[ xIndex ].eType == eIPv6_Loopback )
+                {
+                    if( xIsIPv6Loopback( pxAddress ) != pdFALSE )
+                    {
+                        eResult = eIPv6_Loopback;
+                        break;
+                    }
+                }
+
+                if( ( usAddress & xIPCouples[ xIndex ].usMask ) == xIPCouples[ xIndex ].usExpected )
+                {
+                    eResult = xIPCouples[ xIndex ].eType;
+                    break;
+                }
+            }
+        }
+
+        return eResult;
+    }
+#endif /* if ( ipconfigUSE_IPv6 != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigHAS_PRINTF != 0 ) || ( ipconfigHAS_DEBUG_PRINTF != 0 ) )
+
+/**
+ * @brief Returns the string representation of the IP address of the end point.
+ *
+ * @param[in] pxEndPoint End point for which IP address needs to be returned.
+ * @param[in] pcBuffer A char buffer of required size to which the string will be written.
+ * @param[in] uxSize Size of the char buffer - pcBuffer.
+ *
+ * @returns The pointer to the char buffer that contains the string representation of the end point IP address.
+ *          The string will be "NULL" if the end point pointer is NULL.
  */
-    void vSetSocketEndpoint( Socket_t xSocket,
-                             NetworkEndPoint_t * pxEndPoint )
+    const char * pcEndpointName( const NetworkEndPoint_t * pxEndPoint,
+                                 char * pcBuffer,
+                                 size_t uxSize )
     {
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-
-        if( pxSocket != NULL )
+        if( pxEndPoint == NULL )
         {
-            pxSocket->pxEndPoint = pxEndPoint;
+            /* MISRA Ref 21.6.1 [snprintf and logging] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-216 */
+            /* coverity[misra_c_2012_rule_21_6_violation] */
+            ( void ) snprintf( pcBuffer, uxSize, "NULL" );
+        }
+        else
+        {
+            switch( pxEndPoint->bits.bIPv6 ) /* LCOV_EXCL_BR_LINE */
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    case pdFALSE_UNSIGNED:
+                        ( void ) FreeRTOS_inet_ntop( FREERTOS_AF_INET4,
+                                                     ( const void * ) &( pxEndPoint->ipv4_settings.ulIPAddress ),
+                                                     pcBuffer,
+                                                     ( socklen_t ) uxSize );
+                        break;
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    case pdTRUE_UNSIGNED:
+                        ( void ) FreeRTOS_inet_ntop( FREERTOS_AF_INET6,
+                                                     pxEndPoint->ipv6_settings.xIPAddress.ucBytes,
+                                                     pcBuffer,
+                                                     ( socklen_t ) uxSize );
+                        break;
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                default:
+                    /* MISRA 16.4 Compliance */
+                    /* MISRA Ref 21.6.1 [snprintf and logging] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-216 */
+                    /* coverity[misra_c_2012_rule_21_6_violation] */
+                    ( void ) snprintf( pcBuffer, uxSize, "NULL" );
+                    break;
+            }
         }
+
+        return pcBuffer;
     }
 /*-----------------------------------------------------------*/
+#endif /* ( ( ipconfigHAS_PRINTF != 0 ) || ( ipconfigHAS_DEBUG_PRINTF != 0 ) ) */
 
-#else /* ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 ) */
-
-/* Here below the most important function of FreeRTOS_Routing.c in a short
- * version: it is assumed that only 1 interface and 1 end-point will be created.
- * The reason for this is downward compatibility with the earlier release of
- * FreeRTOS+TCP, which had a single network interface only. */
+#if ( ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 ) || ( ipconfigUSE_LINK_BONDING != 0 ) )
 
 /**
- * @brief Add a network interface to the list of interfaces.  Check if this will be
- *        first and only interface ( ipconfigCOMPATIBLE_WITH_SINGLE = 1 ).
+ * @brief Calculate a hash of the IP addresses, the protocol and the ports of
+ *        an Ethernet frame.  The addresses and the ports are combined with an
+ *        XOR, so both directions of a connection get the same hash.  Fragments
+ *        are hashed on their addresses only, so that they all stay together.
  *
- * @param[in] pxInterface The address of the new interface.
+ * @param[in] pucEthernetBuffer The Ethernet frame.
+ * @param[in] uxLength The number of valid bytes in the frame.
  *
- * @return The value of the parameter 'pxInterface'.
+ * @return The hash, or zero for frames that are neither IPv4 nor IPv6.
  */
-    NetworkInterface_t * FreeRTOS_AddNetworkInterface( NetworkInterface_t * pxInterface )
+    uint32_t ulNetworkFlowHash( const uint8_t * pucEthernetBuffer,
+                                size_t uxLength )
     {
-        configASSERT( pxNetworkInterfaces == NULL );
-        pxNetworkInterfaces = pxInterface;
-        return pxInterface;
+        const EthernetHeader_t * pxEthernetHeader = ( const EthernetHeader_t * ) pucEthernetBuffer;
+        const ProtocolHeaders_t * pxProtocolHeaders;
+        uint32_t ulHash = 0U;
+        size_t uxHeaderLength = 0U;
+        uint8_t ucProtocol = 0U;
+        BaseType_t xHasPorts = pdFALSE;
+
+        if( uxLength >= sizeof( EthernetHeader_t ) )
+        {
+            if( pxEthernetHeader->usFrameType == ipIPv4_FRAME_TYPE )
+            {
+                if( uxLength >= ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER ) )
+                {
+                    const IPHeader_t * pxIPHeader = &( ( ( const IPPacket_t * ) pucEthernetBuffer )->xIPHeader );
+
+                    ulHash = pxIPHeader->ulSourceIPAddress ^ pxIPHeader->ulDestinationIPAddress;
+                    ucProtocol = pxIPHeader->ucProtocol;
+                    uxHeaderLength = ( ( size_t ) pxIPHeader->ucVersionHeaderLength & 0x0FU ) << 2;
+
+                    if( ( pxIPHeader->usFragmentOffset & ( ipFRAGMENT_OFFSET_BIT_MASK | ipFRAGMENT_FLAGS_MORE_FRAGMENTS ) ) == 0U )
+                    {
+                        xHasPorts = pdTRUE;
+                    }
+                }
+            }
+            else if( pxEthernetHeader->usFrameType == ipIPv6_FRAME_TYPE )
+            {
+                if( uxLength >= ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ) )
+                {
+                    const IPHeader_IPv6_t * pxIPHeader = &( ( ( const IPPacket_IPv6_t * ) pucEthernetBuffer )->xIPHeader );
+                    size_t uxIndex;
+
+                    for( uxIndex = 0U; uxIndex < ipSIZE_OF_IPv6_ADDRESS; uxIndex++ )
+                    {
+                        ulHash ^= ( ( uint32_t ) ( pxIPHeader->xSourceAddress.ucBytes[ uxIndex ] ^
+                                                   pxIPHeader->xDestinationAddress.ucBytes[ uxIndex ] ) ) << ( ( uxIndex & 3U ) * 8U );
+                    }
+
+                    /* Extension headers are not followed, only a TCP or
+                     * UDP header directly after the IPv6 header is used. */
+                    ucProtocol = pxIPHeader->ucNextHeader;
+                    uxHeaderLength = ipSIZE_OF_IPv6_HEADER;
+                    xHasPorts = pdTRUE;
+                }
+            }
+            else
+            {
+                /* Not an IP frame, all of these go to the same queue. */
+            }
+        }
+
+        if( ( xHasPorts != pdFALSE ) &&
+            ( ( ucProtocol == ( uint8_t ) ipPROTOCOL_TCP ) || ( ucProtocol == ( uint8_t ) ipPROTOCOL_UDP ) ) &&
+            ( uxLength >= ( ipSIZE_OF_ETH_HEADER + uxHeaderLength + 4U ) ) )
+        {
+            /* The ports are at the same place in a TCP and a UDP header. */
+            pxProtocolHeaders = ( const ProtocolHeaders_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxHeaderLength ] );
+            ulHash ^= ( uint32_t ) ( pxProtocolHeaders->xUDPHeader.usSourcePort ^ pxProtocolHeaders->xUDPHeader.usDestinationPort );
+        }
+
+        ulHash ^= ucProtocol;
+
+        /* Mix all bits, so that the lower bits can be used as a queue index. */
+        ulHash ^= ulHash >> 16;
+        ulHash *= 0x85EBCA6BU;
+        ulHash ^= ulHash >> 13;
+        ulHash *= 0xC2B2AE35U;
+        ulHash ^= ulHash >> 16;
+
+        return ulHash;
     }
 /*-----------------------------------------------------------*/
 
+#endif /* ( ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 ) || ( ipconfigUSE_LINK_BONDING != 0 ) ) */
+
+#if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+
 /**
- * @brief And an end-point to an interface.  Note that when ipconfigCOMPATIBLE_WITH_SINGLE
- *        is defined, only one interface is allowed, which will have one end-point only.
+ * @brief Find the TX queue through which a packet will be sent.  Use the
+ *        pfSelectQueue() policy of the interface when it has one, otherwise
+ *        the priority class of the packet when ipconfigUSE_TX_PRIORITY_QUEUES
+ *        is enabled, or else the flow hash of the packet.
  *
- * @param[in] pxInterface The interface to which the end-point is assigned.
- * @param[in] pxEndPoint The end-point to be assigned to the above interface.
+ * @param[in] pxInterface The interface that will send the packet.
+ * @param[in] pxNetworkBuffer The packet.
  *
- * @return The value of the parameter 'pxEndPoint'.
+ * @return An index smaller than 'pxInterface->uxQueueCount', or zero when the
+ *         interface has a single queue.
  */
-    static NetworkEndPoint_t * FreeRTOS_AddEndPoint( NetworkInterface_t * pxInterface,
-                                                     NetworkEndPoint_t * pxEndPoint )
+    UBaseType_t uxNetworkInterfaceSelectQueue( NetworkInterface_t * pxInterface,
+                                               const NetworkBufferDescriptor_t * pxNetworkBuffer )
     {
-        /* This code is in backward-compatibility mode.
-         * Only one end-point is allowed, make sure that
-         * no end-point has been defined yet. */
-        configASSERT( pxNetworkEndPoints == NULL );
+        UBaseType_t uxQueue = 0U;
 
-        /* This end point will go to the end of the list, so there is no pxNext
-         * yet. */
-        pxEndPoint->pxNext = NULL;
+        if( pxInterface->uxQueueCount > 1U )
+        {
+            if( pxInterface->pfSelectQueue != NULL )
+            {
+                uxQueue = pxInterface->pfSelectQueue( pxInterface, pxNetworkBuffer );
+            }
+            else
+            {
+                #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+                    /* Higher priority classes use higher queue numbers.  All
+                     * frames of one class share a queue, so a flow is never
+                     * reordered. */
+                    uxQueue = ( uxIPTxPriorityClass( pxNetworkBuffer ) * pxInterface->uxQueueCount ) /
+                              ( UBaseType_t ) ipconfigTX_PRIORITY_CLASSES;
+                #else
+                    uxQueue = ( UBaseType_t ) ( ulNetworkFlowHash( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength ) %
+                                                ( uint32_t ) pxInterface->uxQueueCount );
+                #endif
+            }
 
-        /* Double link between the NetworkInterface_t that is using the addressing
-         * defined by this NetworkEndPoint_t structure. */
-        pxEndPoint->pxNetworkInterface = pxInterface;
+            if( uxQueue >= pxInterface->uxQueueCount )
+            {
+                uxQueue = 0U;
+            }
+        }
 
-        pxInterface->pxEndPoint = pxEndPoint;
+        return uxQueue;
+    }
+/*-----------------------------------------------------------*/
 
-        /* No other end points are defined yet - so this is the first in the
-         * list. */
-        pxNetworkEndPoints = pxEndPoint;
+#endif /* ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 ) */
 
-        return pxEndPoint;
+#if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+
+/**
+ * @brief Copy the counters of an interface. The IP-task and the drivers
+ *        update the counters without a lock, so the copy is repeated until
+ *        two copies in a row are the same. That way a 64-bit byte count is
+ *        never read half-way an update.
+ *
+ * @param[in] pxInterface The interface.
+ * @param[out] pxCounters Where the copy is stored.
+ */
+    static void prvCopyNetworkCounters( const NetworkInterface_t * pxInterface,
+                                        NetworkCounters_t * pxCounters )
+    {
+        NetworkCounters_t xCheck;
+
+        ( void ) memcpy( pxCounters, &( pxInterface->xCounters ), sizeof( *pxCounters ) );
+
+        for( ; ; )
+        {
+            ( void ) memcpy( &xCheck, &( pxInterface->xCounters ), sizeof( xCheck ) );
+
+            if( memcmp( &xCheck, pxCounters, sizeof( xCheck ) ) == 0 )
+            {
+                break;
+            }
+
+            ( void ) memcpy( pxCounters, &xCheck, sizeof( *pxCounters ) );
+        }
     }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Find the end-point which has a given IPv4 address.
- *
- * @param[in] ulIPAddress The IP-address of interest, or 0 if any IPv4 end-point may be returned.
+ * @brief Add packet and byte counts to a running total.
  *
- * @return The end-point found or NULL.
+ * @param[in,out] pxTotal The total.
+ * @param[in] pxCounters The counts to be added.
  */
-    NetworkEndPoint_t * FreeRTOS_FindEndPointOnIP_IPv4( uint32_t ulIPAddress )
+    static void prvAddTrafficCounters( NetworkTrafficCounters_t * pxTotal,
+                                       const NetworkTrafficCounters_t * pxCounters )
     {
-        NetworkEndPoint_t * pxResult = NULL;
+        pxTotal->ulRxPackets += pxCounters->ulRxPackets;
+        pxTotal->ulTxPackets += pxCounters->ulTxPackets;
+        pxTotal->ullRxBytes += pxCounters->ullRxBytes;
+        pxTotal->ullTxBytes += pxCounters->ullTxBytes;
+    }
+/*-----------------------------------------------------------*/
 
-        ( void ) ulIPAddress;
+/**
+ * @brief Get a snapshot of the counters of a network interface, see
+ *        ipconfigUSE_NETWORK_COUNTERS. May be called from any task.
+ *
+ * @param[in] pxInterface The interface, or NULL to get the sum of the
+ *                        counters of all interfaces.
+ * @param[out] pxCounters Where the counters will be stored.
+ */
+    void FreeRTOS_GetNetworkCounters( const NetworkInterface_t * pxInterface,
+                                      NetworkCounters_t * pxCounters )
+    {
+        const NetworkInterface_t * pxIterator;
+        NetworkCounters_t xCounters;
+        BaseType_t xIndex;
 
-        if( ( ulIPAddress == 0U ) || ( pxNetworkEndPoints->ipv4_settings.ulIPAddress == ulIPAddress ) )
+        if( pxInterface != NULL )
         {
-            pxResult = pxNetworkEndPoints;
+            prvCopyNetworkCounters( pxInterface, pxCounters );
         }
+        else
+        {
+            ( void ) memset( pxCounters, 0, sizeof( *pxCounters ) );
 
-        return pxResult;
+            for( pxIterator = FreeRTOS_FirstNetworkInterface();
+                 pxIterator != NULL;
+                 pxIterator = FreeRTOS_NextNetworkInterface( pxIterator ) )
+            {
+                prvCopyNetworkCounters( pxIterator, &xCounters );
+
+                prvAddTrafficCounters( &( pxCounters->xTotal ), &( xCounters.xTotal ) );
+
+                for( xIndex = 0; xIndex < ( BaseType_t ) eCounterProtocolMax; xIndex++ )
+                {
+                    prvAddTrafficCounters( &( pxCounters->xProtocols[ xIndex ] ), &( xCounters.xProtocols[ xIndex ] ) );
+                }
+
+                for( xIndex = 0; xIndex < ( BaseType_t ) eDropReasonMax; xIndex++ )
+                {
+                    pxCounters->ulRxDropped[ xIndex ] += xCounters.ulRxDropped[ xIndex ];
+                }
+
+                pxCounters->ulRxQueueFull += xCounters.ulRxQueueFull;
+                pxCounters->ulTxErrors += xCounters.ulTxErrors;
+            }
+        }
     }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Find the end-point that has a certain MAC-address.
+ * @brief Reset the counters of a network interface to zero. An update that
+ *        is busy at the same moment may still be counted.
  *
- * @param[in] pxMACAddress The Ethernet packet.
- * @param[in] pxInterface The interface on which the packet was received, or NULL when unknown.
- *
- * @return The end-point that has the given MAC-address.
+ * @param[in] pxInterface The interface, or NULL to reset all interfaces.
  */
-    NetworkEndPoint_t * FreeRTOS_FindEndPointOnMAC( const MACAddress_t * pxMACAddress,
-                                                    const NetworkInterface_t * pxInterface )
+    void FreeRTOS_ClearNetworkCounters( NetworkInterface_t * pxInterface )
     {
-        NetworkEndPoint_t * pxResult = NULL;
-
-        ( void ) pxMACAddress;
-        ( void ) pxInterface;
+        NetworkInterface_t * pxIterator;
 
-        if( ( pxMACAddress != NULL ) && ( memcmp( pxNetworkEndPoints->xMACAddress.ucBytes, pxMACAddress->ucBytes, ipMAC_ADDRESS_LENGTH_BYTES ) == 0 ) )
+        for( pxIterator = FreeRTOS_FirstNetworkInterface();
+             pxIterator != NULL;
+             pxIterator = FreeRTOS_NextNetworkInterface( pxIterator ) )
         {
-            pxResult = pxNetworkEndPoints;
+            if( ( pxInterface == NULL ) || ( pxInterface == pxIterator ) )
+            {
+                taskENTER_CRITICAL();
+                {
+                    ( void ) memset( &( pxIterator->xCounters ), 0, sizeof( pxIterator->xCounters ) );
+                }
+                taskEXIT_CRITICAL();
+            }
         }
+    }
+/*-----------------------------------------------------------*/
 
-        return pxResult;
+#endif /* ( ipconfigUSE_NETWORK_COUNTERS != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_BRING_UP_TIMELINE != 0 )
+
+/**
+ * @brief Record the first time that a milestone was passed.
+ *
+ * @param[in,out] pxTimeline The timeline of an interface or an end-point.
+ * @param[in] eMilestone The milestone.
+ */
+    static void prvBringUpMilestone( BringUpTimeline_t * pxTimeline,
+                                     eBringUpMilestone_t eMilestone )
+    {
+        uint32_t ulBit = ( ( uint32_t ) 1U ) << ( uint32_t ) eMilestone;
+
+        /* Most calls come after the milestone was passed, e.g. for every ARP
+         * packet, so check without a lock first. */
+        if( ( pxTimeline->ulPassed & ulBit ) == 0U )
+        {
+            uint32_t ulTime = ipconfigBRING_UP_TIMELINE_TIME();
+
+            taskENTER_CRITICAL();
+            {
+                if( ( pxTimeline->ulPassed & ulBit ) == 0U )
+                {
+                    pxTimeline->ulTime[ eMilestone ] = ulTime;
+                    pxTimeline->ulPassed |= ulBit;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
     }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Find an end-point that handles a given IPv4-address.
+ * @brief Record that an interface passed a milestone of its bring-up, see
+ *        ipconfigUSE_BRING_UP_TIMELINE.  Drivers may report eBringUpLinkUp.
  *
- * @param[in] ulIPAddress The IP-address for which an end-point is looked-up.
+ * @param[in] pxInterface The interface.
+ * @param[in] eMilestone The milestone.
+ */
+    void vBringUpInterfaceMilestone( NetworkInterface_t * pxInterface,
+                                     eBringUpMilestone_t eMilestone )
+    {
+        if( ( pxInterface != NULL ) && ( eMilestone < eBringUpMilestoneMax ) )
+        {
+            if( eMilestone == eBringUpInitialiseStart )
+            {
+                /* Only the IP-task calls pfInitialise(). */
+                pxInterface->xTimeline.ulInitialiseCalls++;
+            }
+
+            prvBringUpMilestone( &( pxInterface->xTimeline ), eMilestone );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Record that an end-point passed a milestone of its bring-up, see
+ *        ipconfigUSE_BRING_UP_TIMELINE.
  *
- * @return An end-point that has the same network mask as the given IP-address.
+ * @param[in] pxEndPoint The end-point.
+ * @param[in] eMilestone The milestone.
  */
-    NetworkEndPoint_t * FreeRTOS_FindEndPointOnNetMask( uint32_t ulIPAddress )
+    void vBringUpEndPointMilestone( NetworkEndPoint_t * pxEndPoint,
+                                    eBringUpMilestone_t eMilestone )
     {
-        return FreeRTOS_InterfaceEndPointOnNetMask( NULL, ulIPAddress );
+        if( ( pxEndPoint != NULL ) && ( eMilestone < eBringUpMilestoneMax ) )
+        {
+            prvBringUpMilestone( &( pxEndPoint->xTimeline ), eMilestone );
+        }
     }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Find an end-point that defines a gateway of a certain type ( IPv4 or IPv6 ).
+ * @brief Get a copy of the bring-up timeline of an interface.  May be called
+ *        from any task.
  *
- * @param[in] xIPType The type of Gateway to look for ( ipTYPE_IPv4 or ipTYPE_IPv6 ).
+ * @param[in] pxInterface The interface.
+ * @param[out] pxTimeline Where the timeline will be stored.
+ */
+    void FreeRTOS_GetInterfaceTimeline( const NetworkInterface_t * pxInterface,
+                                        BringUpTimeline_t * pxTimeline )
+    {
+        taskENTER_CRITICAL();
+        {
+            ( void ) memcpy( pxTimeline, &( pxInterface->xTimeline ), sizeof( *pxTimeline ) );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get a copy of the bring-up timeline of an end-point.  May be called
+ *        from any task.
  *
- * @return The end-point that will lead to the gateway, or NULL when no gateway was found.
+ * @param[in] pxEndPoint The end-point.
+ * @param[out] pxTimeline Where the timeline will be stored.
  */
-    NetworkEndPoint_t * FreeRTOS_FindGateWay( BaseType_t xIPType )
+    void FreeRTOS_GetEndPointTimeline( const NetworkEndPoint_t * pxEndPoint,
+                                       BringUpTimeline_t * pxTimeline )
     {
-        NetworkEndPoint_t * pxReturn = NULL;
+        taskENTER_CRITICAL();
+        {
+            ( void ) memcpy( pxTimeline, &( pxEndPoint->xTimeline ), sizeof( *pxTimeline ) );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
 
-        ( void ) xIPType;
+/**
+ * @brief Forget the milestones of all interfaces and end-points, so that the
+ *        next bring-up will be recorded.
+ */
+    void FreeRTOS_ClearBringUpTimelines( void )
+    {
+        NetworkInterface_t * pxInterface;
+        NetworkEndPoint_t * pxEndPoint;
 
-        if( pxNetworkEndPoints != NULL )
+        for( pxInterface = FreeRTOS_FirstNetworkInterface();
+             pxInterface != NULL;
+             pxInterface = FreeRTOS_NextNetworkInterface( pxInterface ) )
         {
-            if( pxNetworkEndPoints->ipv4_settings.ulGatewayAddress != 0U )
+            taskENTER_CRITICAL();
             {
-                pxReturn = pxNetworkEndPoints;
+                ( void ) memset( &( pxInterface->xTimeline ), 0, sizeof( pxInterface->xTimeline ) );
             }
+            taskEXIT_CRITICAL();
         }
 
-        return pxReturn;
+        for( pxEndPoint = FreeRTOS_FirstEndPoint( NULL );
+             pxEndPoint != NULL;
+             pxEndPoint = FreeRTOS_NextEndPoint( NULL, pxEndPoint ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                ( void ) memset( &( pxEndPoint->xTimeline ), 0, sizeof( pxEndPoint->xTimeline ) );
+            }
+            taskEXIT_CRITICAL();
+        }
     }
 /*-----------------------------------------------------------*/
 
+#endif /* ( ipconfigUSE_BRING_UP_TIMELINE != 0 ) */
+
+#if ( ipconfigUSE_INTERFACE_MTU != 0 )
+
 /**
- * @brief Find the first end-point bound to a given interface.
+ * @brief Get the MTU of a network interface, see ipconfigUSE_INTERFACE_MTU.
  *
- * @param[in] pxInterface The interface whose first end-point will be returned.
+ * @param[in] pxInterface The interface, may be NULL.
  *
- * @return The first end-point that is found to the interface, or NULL when the
- *         interface doesn't have any end-point yet.
+ * @return The MTU of the interface, or ipconfigNETWORK_MTU when the interface
+ *         is unknown or has no MTU of its own.
  */
-    NetworkEndPoint_t * FreeRTOS_FirstEndPoint( const NetworkInterface_t * pxInterface )
+    size_t uxInterfaceMTU( const NetworkInterface_t * pxInterface )
     {
-        ( void ) pxInterface;
+        size_t uxMTU = ipconfigNETWORK_MTU;
 
-        /* ipconfigCOMPATIBLE_WITH_SINGLE is defined and this is the simplified version:
-         * only one interface and one end-point is defined. */
-        return pxNetworkEndPoints;
+        /* The network buffers can not hold more than ipconfigNETWORK_MTU. */
+        if( ( pxInterface != NULL ) && ( pxInterface->uxMTU != 0U ) && ( pxInterface->uxMTU < uxMTU ) )
+        {
+            uxMTU = pxInterface->uxMTU;
+        }
+
+        return uxMTU;
     }
 /*-----------------------------------------------------------*/
 
+#endif /* ( ipconfigUSE_INTERFACE_MTU != 0 ) */
+
+#if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+
 /**
- * @brief Get the first Network Interface, or NULL if none has been added.
+ * @brief Get the link speed of a network interface, see
+ *        ipconfigUSE_TCP_LINK_SPEED_SIZING.
  *
- * @return The first interface, or NULL if none has been added
+ * @param[in] pxInterface The interface, may be NULL.
+ *
+ * @return The speed in Mbit/s, or zero when the interface is unknown or its
+ *         driver did not report a speed.  A VLAN interface reports the speed
+ *         of its physical interface.
  */
-    NetworkInterface_t * FreeRTOS_FirstNetworkInterface( void )
+    uint32_t ulInterfaceLinkSpeed( const NetworkInterface_t * pxInterface )
     {
-        /* ipconfigCOMPATIBLE_WITH_SINGLE is defined: only one interface and
-         * one end-point is defined. */
-        return pxNetworkInterfaces;
+        const NetworkInterface_t * pxPhysical = pxInterface;
+        uint32_t ulSpeed = 0U;
+
+        if( pxPhysical != NULL )
+        {
+            #if ( ipconfigUSE_VLAN != 0 )
+            {
+                if( pxPhysical->pxVLANParent != NULL )
+                {
+                    pxPhysical = pxPhysical->pxVLANParent;
+                }
+            }
+            #endif
+
+            ulSpeed = pxPhysical->ulLinkSpeed;
+        }
+
+        return ulSpeed;
     }
 /*-----------------------------------------------------------*/
 
+#endif /* ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 ) */
+
+#if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+
 /**
- * @brief Find an end-point that handles a given IPv4-address.
+ * @brief Find the bucket of a MAC address in the hash of a MACFilter_t.
  *
- * @param[in] pxInterface Ignored in this simplified version.
- * @param[in] ulIPAddress The IP-address for which an end-point is looked-up.
+ * @param[in] pucMACAddress The MAC address.
  *
- * @return An end-point that has the same network mask as the given IP-address.
+ * @return A bucket number smaller than ipMAC_FILTER_HASH_BUCKETS.
  */
-    NetworkEndPoint_t * FreeRTOS_InterfaceEndPointOnNetMask( const NetworkInterface_t * pxInterface,
-                                                             uint32_t ulIPAddress )
+    static size_t prvMACFilterHash( const uint8_t * pucMACAddress )
     {
-        NetworkEndPoint_t * pxResult = NULL;
+        uint32_t ulHash = 0U;
+        size_t uxIndex;
 
-        ( void ) pxInterface;
-
-        if( ( ( ulIPAddress ^ pxNetworkEndPoints->ipv4_settings.ulIPAddress ) & pxNetworkEndPoints->ipv4_settings.ulNetMask ) == 0U )
+        for( uxIndex = 0U; uxIndex < ( size_t ) ipMAC_ADDRESS_LENGTH_BYTES; uxIndex++ )
         {
-            pxResult = pxNetworkEndPoints;
+            ulHash = ( ulHash * 31U ) + ( uint32_t ) pucMACAddress[ uxIndex ];
         }
 
-        return pxResult;
+        return ( size_t ) ( ulHash % ipMAC_FILTER_HASH_BUCKETS );
     }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Find out the best matching end-point given an incoming Ethernet packet.
- *
- * @param[in] pxNetworkInterface The interface on which the packet was received.
- * @param[in] pucEthernetBuffer The Ethernet packet that was just received.
+ * @brief Add a MAC address to the hash of an interface, without telling the
+ *        driver.
  *
- * @return The end-point that should handle the incoming Ethernet packet.
+ * @param[in] pxInterface The interface.
+ * @param[in] pucMACAddress The MAC address.
  */
-    NetworkEndPoint_t * FreeRTOS_MatchingEndpoint( const NetworkInterface_t * pxNetworkInterface,
-                                                   const uint8_t * pucEthernetBuffer )
+    static void prvMACFilterHashAdd( NetworkInterface_t * pxInterface,
+                                     const uint8_t * pucMACAddress )
     {
-        ( void ) pxNetworkInterface;
-        ( void ) pucEthernetBuffer;
+        MACFilter_t * pxFilter = &( pxInterface->xMACFilter );
+        size_t uxBucket = prvMACFilterHash( pucMACAddress );
 
-        /* ipconfigCOMPATIBLE_WITH_SINGLE is defined: only one interface and
-         * one end-point is defined. */
-        return pxNetworkEndPoints;
+        if( pxFilter->usHashUsers[ uxBucket ] < 0xFFFFU )
+        {
+            pxFilter->usHashUsers[ uxBucket ]++;
+        }
+
+        pxFilter->ulHashBits[ uxBucket / 32U ] |= ( 1UL << ( uxBucket % 32U ) );
     }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Get the next end-point.  As this is the simplified version, it will always
- *        return NULL.
- *
- * @param[in] pxInterface An interface of interest, or NULL when iterating through all
- *                         end-points.
- * @param[in] pxEndPoint This is the current end-point.
+ * @brief Clear the filter of a new interface, and let it accept the
+ *        multicast groups that the stack uses without registering them.
  *
- * @return NULL because ipconfigCOMPATIBLE_WITH_SINGLE is defined.
+ * @param[in] pxInterface The interface.
  */
-    NetworkEndPoint_t * FreeRTOS_NextEndPoint( const NetworkInterface_t * pxInterface,
-                                               NetworkEndPoint_t * pxEndPoint )
+    static void prvMACFilterInit( NetworkInterface_t * pxInterface )
     {
-        ( void ) pxInterface;
-        ( void ) pxEndPoint;
+        ( void ) memset( &( pxInterface->xMACFilter ), 0, sizeof( pxInterface->xMACFilter ) );
 
-        return NULL;
+        #if ( ipconfigUSE_IPv4 != 0 )
+        {
+            /* 224.0.0.1, the group of IGMP queries. */
+            static const uint8_t ucAllHosts[ ipMAC_ADDRESS_LENGTH_BYTES ] = { 0x01U, 0x00U, 0x5EU, 0x00U, 0x00U, 0x01U };
+
+            prvMACFilterHashAdd( pxInterface, ucAllHosts );
+
+            #if ( ipconfigUSE_LLMNR == 1 )
+                prvMACFilterHashAdd( pxInterface, xLLMNR_MacAddress.ucBytes );
+            #endif
+            #if ( ipconfigUSE_MDNS == 1 )
+                prvMACFilterHashAdd( pxInterface, xMDNS_MacAddress.ucBytes );
+            #endif
+        }
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+        {
+            /* ff02::1, the group of router advertisements and MLD queries. */
+            static const uint8_t ucAllNodes[ ipMAC_ADDRESS_LENGTH_BYTES ] = { 0x33U, 0x33U, 0x00U, 0x00U, 0x00U, 0x01U };
+
+            prvMACFilterHashAdd( pxInterface, ucAllNodes );
+
+            #if ( ipconfigUSE_LLMNR == 1 )
+                prvMACFilterHashAdd( pxInterface, xLLMNR_MacAddressIPv6.ucBytes );
+            #endif
+            #if ( ipconfigUSE_MDNS == 1 )
+                prvMACFilterHashAdd( pxInterface, xMDNS_MacAddressIPv6.ucBytes );
+            #endif
+        }
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
     }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Get the next interface.
+ * @brief Copy the unicast MAC addresses of the end-points of an interface to
+ *        the table of exact matches of its filter.  To be called when an
+ *        end-point is added, or when its MAC address changes.
  *
- * @return NULL because ipconfigCOMPATIBLE_WITH_SINGLE is defined.
+ * @param[in] pxInterface The interface.
  */
-    NetworkInterface_t * FreeRTOS_NextNetworkInterface( const NetworkInterface_t * pxInterface )
+    void vMACFilterUpdateEndPoints( NetworkInterface_t * pxInterface )
     {
-        ( void ) pxInterface;
+        MACFilter_t * pxFilter = &( pxInterface->xMACFilter );
+        NetworkEndPoint_t * pxEndPoint;
+        UBaseType_t uxIndex;
 
-        return NULL;
-    }
-/*-----------------------------------------------------------*/
+        pxFilter->uxExactCount = 0U;
+        pxFilter->xExactOverflow = pdFALSE;
 
-    #if ( ipconfigUSE_IPv6 != 0 )
-        NetworkEndPoint_t * FreeRTOS_FindEndPointOnIP_IPv6( const IPv6_Address_t * pxIPAddress )
+        for( pxEndPoint = FreeRTOS_FirstEndPoint( pxInterface );
+             pxEndPoint != NULL;
+             pxEndPoint = FreeRTOS_NextEndPoint( pxInterface, pxEndPoint ) )
         {
-            ( void ) pxIPAddress;
-            return pxNetworkEndPoints;
-        }
-
-/*-----------------------------------------------------------*/
+            for( uxIndex = 0U; uxIndex < pxFilter->uxExactCount; uxIndex++ )
+            {
+                if( memcmp( pxFilter->xExact[ uxIndex ].ucBytes, pxEndPoint->xMACAddress.ucBytes, sizeof( MACAddress_t ) ) == 0 )
+                {
+                    break;
+                }
+            }
 
-        NetworkEndPoint_t * FreeRTOS_FindEndPointOnNetMask_IPv6( const IPv6_Address_t * pxIPv6Address )
-        {
-            ( void ) pxIPv6Address;
-            return pxNetworkEndPoints;
+            if( uxIndex < pxFilter->uxExactCount )
+            {
+                /* End-points often share a MAC address. */
+            }
+            else if( pxFilter->uxExactCount < ( UBaseType_t ) ipconfigMAC_FILTER_EXACT_ENTRIES )
+            {
+                ( void ) memcpy( pxFilter->xExact[ pxFilter->uxExactCount ].ucBytes, pxEndPoint->xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                pxFilter->uxExactCount++;
+            }
+            else
+            {
+                pxFilter->xExactOverflow = pdTRUE;
+            }
         }
-
+    }
 /*-----------------------------------------------------------*/
 
-        NetworkEndPoint_t * FreeRTOS_FirstEndPoint_IPv6( const NetworkInterface_t * pxInterface )
+/**
+ * @brief Let an interface receive frames sent to a MAC address: update its
+ *        software filter, and call the pfAddAllowedMAC() function of its
+ *        driver.  Every call must be undone by one call to
+ *        vNetworkInterfaceRemoveAllowedMAC().
+ *
+ * @param[in] pxInterface The interface.
+ * @param[in] pucMACAddress The MAC address, mostly a multicast address.
+ */
+    void vNetworkInterfaceAddAllowedMAC( NetworkInterface_t * pxInterface,
+                                         const uint8_t * pucMACAddress )
+    {
+        prvMACFilterHashAdd( pxInterface, pucMACAddress );
+
+        if( pxInterface->pfAddAllowedMAC != NULL )
         {
-            ( void ) pxInterface;
-            return pxNetworkEndPoints;
+            pxInterface->pfAddAllowedMAC( pxInterface, pucMACAddress );
         }
-
+    }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief If the device endpoint is in the same subnet as the given IP address, return the
- * endpoint. Otherwise, return NULL.
- *
- * @param[in] pxInterface Ignored in this simplified version for single endpoint.
- * @param[in] ulIPAddress The IP-address for which an end-point is looked-up.
+ * @brief Undo one call to vNetworkInterfaceAddAllowedMAC().  The hash bucket
+ *        of the address is cleared when no other address uses it.
  *
- * @return An end-point that is in the same subnet as the given IP-address.
+ * @param[in] pxInterface The interface.
+ * @param[in] pucMACAddress The MAC address.
  */
-        NetworkEndPoint_t * FreeRTOS_InterfaceEPInSameSubnet_IPv6( const NetworkInterface_t * pxInterface,
-                                                                   const IPv6_Address_t * pxIPAddress )
-        {
-            NetworkEndPoint_t * pxResult = NULL;
+    void vNetworkInterfaceRemoveAllowedMAC( NetworkInterface_t * pxInterface,
+                                            const uint8_t * pucMACAddress )
+    {
+        MACFilter_t * pxFilter = &( pxInterface->xMACFilter );
+        size_t uxBucket = prvMACFilterHash( pucMACAddress );
 
-            ( void ) pxInterface;
+        if( ( pxFilter->usHashUsers[ uxBucket ] > 0U ) &&
+            ( pxFilter->usHashUsers[ uxBucket ] < 0xFFFFU ) )
+        {
+            pxFilter->usHashUsers[ uxBucket ]--;
 
-            if( xCompareIPv6_Address( &( pxNetworkEndPoints->ipv6_settings.xIPAddress ), pxIPAddress, pxNetworkEndPoints->ipv6_settings.uxPrefixLength ) == 0 )
+            if( pxFilter->usHashUsers[ uxBucket ] == 0U )
             {
-                pxResult = pxNetworkEndPoints;
+                pxFilter->ulHashBits[ uxBucket / 32U ] &= ~( 1UL << ( uxBucket % 32U ) );
             }
+        }
 
-            return pxResult;
+        if( pxInterface->pfRemoveAllowedMAC != NULL )
+        {
+            pxInterface->pfRemoveAllowedMAC( pxInterface, pucMACAddress );
         }
-    #endif /* if ( ipconfigUSE_IPv6 != 0 ) */
+    }
 /*-----------------------------------------------------------*/
 
-#endif /* ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 ) */
-
 /**
- * @brief Returns the IP type of the given IPv6 address.
+ * @brief Check the destination address of a received frame against the
+ *        software filter of the interface that received it.
  *
- * @param[in] pxAddress The IPv6 address whose type needs to be returned.
- * @returns The IP type of the given address.
+ * @param[in] pxInterface The interface.
+ * @param[in] pxMACAddress The destination MAC address of the frame.
+ *
+ * @return pdTRUE when the address is one of the end-points, the broadcast
+ *         address, or when its hash bucket is in use.  Otherwise pdFALSE.
  */
-#if ( ipconfigUSE_IPv6 != 0 )
-    IPv6_Type_t xIPv6_GetIPType( const IPv6_Address_t * pxAddress )
+    BaseType_t xMACFilterAccepts( const NetworkInterface_t * pxInterface,
+                                  const MACAddress_t * pxMACAddress )
     {
-        IPv6_Type_t eResult = eIPv6_Unknown;
-        BaseType_t xIndex;
-        static const struct xIPv6_Couple xIPCouples[] =
-        {
-            /*    IP-type          Mask     Value */
-            { eIPv6_Global,    0xE000U, 0x2000U }, /* 001 */
-            { eIPv6_LinkLocal, 0xFFC0U, 0xFE80U }, /* 1111 1110 10 */
-            { eIPv6_SiteLocal, 0xFFC0U, 0xFEC0U }, /* 1111 1110 11 */
-            { eIPv6_Multicast, 0xFF00U, 0xFF00U }, /* 1111 1111 */
-            { eIPv6_Loopback,  0xFFFFU, 0x0000U }, /* 0000 0000 ::1 */
-        };
+        const MACFilter_t * pxFilter = &( pxInterface->xMACFilter );
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxIndex;
+        size_t uxBucket;
 
-        if( pxAddress != NULL )
+        if( ( pxMACAddress->ucBytes[ 0 ] & 0x01U ) == 0U )
         {
-            for( xIndex = 0; xIndex < ARRAY_SIZE_X( xIPCouples ); xIndex++ )
+            /* A unicast address. */
+            if( pxFilter->xExactOverflow != pdFALSE )
             {
-                uint16_t usAddress =
-                    ( uint16_t ) ( ( ( ( uint16_t ) pxAddress->ucBytes[ 0 ] ) << 8 ) |
-                                   ( ( uint16_t ) pxAddress->ucBytes[ 1 ] ) );
-
-                if( xIPCouples[ xIndex ].eType == eIPv6_Loopback )
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                for( uxIndex = 0U; uxIndex < pxFilter->uxExactCount; uxIndex++ )
                 {
-                    if( xIsIPv6Loopback( pxAddress ) != pdFALSE )
+                    if( memcmp( pxFilter->xExact[ uxIndex ].ucBytes, pxMACAddress->ucBytes, sizeof( MACAddress_t ) ) == 0 )
                     {
-                        eResult = eIPv6_Loopback;
+                        xReturn = pdTRUE;
                         break;
                     }
                 }
-
-                if( ( usAddress & xIPCouples[ xIndex ].usMask ) == xIPCouples[ xIndex ].usExpected )
-                {
-                    eResult = xIPCouples[ xIndex ].eType;
-                    break;
-                }
             }
         }
-
-        return eResult;
-    }
-#endif /* if ( ipconfigUSE_IPv6 != 0 ) */
-/*-----------------------------------------------------------*/
-
-#if ( ( ipconfigHAS_PRINTF != 0 ) || ( ipconfigHAS_DEBUG_PRINTF != 0 ) )
-
-/**
- * @brief Returns the string representation of the IP address of the end point.
- *
- * @param[in] pxEndPoint End point for which IP address needs to be returned.
- * @param[in] pcBuffer A char buffer of required size to which the string will be written.
- * @param[in] uxSize Size of the char buffer - pcBuffer.
- *
- * @returns The pointer to the char buffer that contains the string representation of the end point IP address.
- *          The string will be "NULL" if the end point pointer is NULL.
- */
-    const char * pcEndpointName( const NetworkEndPoint_t * pxEndPoint,
-                                 char * pcBuffer,
-                                 size_t uxSize )
-    {
-        if( pxEndPoint == NULL )
+        else if( memcmp( xBroadcastMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( MACAddress_t ) ) == 0 )
         {
-            /* MISRA Ref 21.6.1 [snprintf and logging] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-216 */
-            /* coverity[misra_c_2012_rule_21_6_violation] */
-            ( void ) snprintf( pcBuffer, uxSize, "NULL" );
+            xReturn = pdTRUE;
         }
         else
         {
-            switch( pxEndPoint->bits.bIPv6 ) /* LCOV_EXCL_BR_LINE */
-            {
-                #if ( ipconfigUSE_IPv4 != 0 )
-                    case pdFALSE_UNSIGNED:
-                        ( void ) FreeRTOS_inet_ntop( FREERTOS_AF_INET4,
-                                                     ( const void * ) &( pxEndPoint->ipv4_settings.ulIPAddress ),
-                                                     pcBuffer,
-                                                     ( socklen_t ) uxSize );
-                        break;
-                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+            /* A multicast address, only the hash will tell. */
+        }
 
-                #if ( ipconfigUSE_IPv6 != 0 )
-                    case pdTRUE_UNSIGNED:
-                        ( void ) FreeRTOS_inet_ntop( FREERTOS_AF_INET6,
-                                                     pxEndPoint->ipv6_settings.xIPAddress.ucBytes,
-                                                     pcBuffer,
-                                                     ( socklen_t ) uxSize );
-                        break;
-                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        if( xReturn == pdFALSE )
+        {
+            uxBucket = prvMACFilterHash( pxMACAddress->ucBytes );
 
-                default:
-                    /* MISRA 16.4 Compliance */
-                    /* MISRA Ref 21.6.1 [snprintf and logging] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-216 */
-                    /* coverity[misra_c_2012_rule_21_6_violation] */
-                    ( void ) snprintf( pcBuffer, uxSize, "NULL" );
-                    break;
+            if( ( pxFilter->ulHashBits[ uxBucket / 32U ] & ( 1UL << ( uxBucket % 32U ) ) ) != 0U )
+            {
+                xReturn = pdTRUE;
             }
         }
 
-        return pcBuffer;
+        return xReturn;
     }
 /*-----------------------------------------------------------*/
-#endif /* ( ( ipconfigHAS_PRINTF != 0 ) || ( ipconfigHAS_DEBUG_PRINTF != 0 ) ) */
+
+#endif /* ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 ) */
@@ -52,6 +52,7 @@
 #include "FreeRTOS_DNS.h"
 #include "NetworkBufferManagement.h"
 #include "FreeRTOS_Routing.h"
+#include "FreeRTOS_IGMP.h"
 
 #if ( ipconfigUSE_TCP_MEM_STATS != 0 )
     #include "tcp_mem_stats.h"
@@ -69,6 +70,14 @@
  */
 #define socketSOCKET_IS_BOUND( pxSocket )            ( listLIST_ITEM_CONTAINER( &( pxSocket )->xBoundSocketListItem ) != NULL )
 
+/** @brief Non-zero when tasks other than the IP-task access the lists of bound
+ *         sockets. The lists must then be changed with the scheduler suspended.
+ */
+#define socketLOCK_BOUND_LISTS                            \
+    ( ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 ) || \
+      ( ipconfigSELECT_LOCAL_EVALUATION == 1 ) ||         \
+      ( ipconfigUDP_DIRECT_BIND == 1 ) )
+
 /** @brief If FreeRTOS_sendto() is called on a socket that is not bound to a port
  *         number then, depending on the FreeRTOSIPConfig.h settings, it might be
  *         that a port number is automatically generated for the socket.
@@ -90,6 +99,14 @@
 /** @brief A block time of 0 simply means "don't block". */
 #define socketDONT_BLOCK                         ( ( TickType_t ) 0 )
 
+/** @brief The memory that a socket uses for its event group, for the resource
+ *         and memory statistics. */
+#if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+    #define socketEVENT_GROUP_SIZE    sizeof( StaticEventGroup_t )
+#else
+    #define socketEVENT_GROUP_SIZE    ( ( size_t ) 0U )
+#endif
+
 /** @brief TCP timer period in milliseconds. */
 #if ( ( ipconfigUSE_TCP == 1 ) && !defined( ipTCP_TIMER_PERIOD_MS ) )
     #define ipTCP_TIMER_PERIOD_MS    ( 1000U )
@@ -100,6 +117,20 @@
 #define sock80_PERCENT     80U         /**< 80% of the defined limit. */
 #define sock100_PERCENT    100U        /**< 100% of the defined limit. */
 
+#if ( ( ipconfigUSE_TCP_AUTO_TUNING != 0 ) || ( ipconfigTCP_STREAM_RELEASE_TIME != 0 ) )
+
+/** @brief An API function starts or stops using a stream of a socket.  The
+ *         IP-task does not replace or release a stream that is being used. */
+    #define sockSTREAM_ENTER( ucUsers )    ( ( ucUsers )++ )
+    #define sockSTREAM_LEAVE( ucUsers )    ( ( ucUsers )-- )
+#else
+    #define sockSTREAM_ENTER( ucUsers )    do {} while( ipFALSE_BOOL )
+    #define sockSTREAM_LEAVE( ucUsers )    do {} while( ipFALSE_BOOL )
+#endif
+
+/** @brief The number of bytes that a stream buffer takes from the heap. */
+#define sockSTREAM_HEAP_SIZE( pxStream )    ( ( sizeof( *( pxStream ) ) - sizeof( ( pxStream )->ucArray ) ) + ( pxStream )->LENGTH )
+
 #if ( ( ipconfigHAS_DEBUG_PRINTF != 0 ) || ( ipconfigHAS_PRINTF != 0 ) )
 
 /**
@@ -124,6 +155,78 @@ static uint16_t prvGetPrivatePortNumber( BaseType_t xProtocol );
 static const ListItem_t * pxListFindListItemWithValue( const List_t * pxList,
                                                        TickType_t xWantedItemValue );
 
+#if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+
+/*
+ * Mix the port numbers and the remote address into a hash value.
+ */
+    static uint32_t prvSocketHashKey( uint32_t ulLocalPort,
+                                      uint32_t ulRemotePort,
+                                      uint32_t ulRemoteIP );
+
+/*
+ * Return the hash bucket to which a bound socket belongs.
+ */
+    static List_t * prvSocketHashBucket( const FreeRTOS_Socket_t * pxSocket );
+
+/*
+ * Add a socket to, or remove it from its hash bucket.
+ */
+    static void prvSocketHashInsert( FreeRTOS_Socket_t * pxSocket );
+    static void prvSocketHashRemove( FreeRTOS_Socket_t * pxSocket );
+
+/*
+ * Find the bound UDP socket with the given port number, using the hash table.
+ * Returns the 'xBoundSocketListItem' of the socket, like
+ * pxListFindListItemWithValue() does.
+ */
+    static const ListItem_t * prvUDPSocketHashFind( TickType_t xWantedItemValue );
+
+    #if ( ipconfigUSE_TCP == 1 )
+
+/*
+ * Find a TCP socket using the hash table: first an exact match on the
+ * 4-tuple, then a socket that listens to the local port.
+ */
+        static FreeRTOS_Socket_t * prvTCPSocketHashFind( UBaseType_t uxLocalPort,
+                                                         const IPv46_Address_t * pxRemoteIP,
+                                                         UBaseType_t uxRemotePort );
+    #endif /* ipconfigUSE_TCP == 1 */
+#endif /* ipconfigUSE_SOCKET_HASH_LOOKUP != 0 */
+
+#if ( ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) )
+
+/*
+ * Return pdTRUE when the socket has set FREERTOS_SO_REUSEPORT.
+ */
+    static BaseType_t prvSocketSharesPort( const FreeRTOS_Socket_t * pxSocket );
+
+/*
+ * Mix the address and port of a peer into a value that selects one of the
+ * sockets sharing a port.
+ */
+    static uint32_t prvSocketReusePortHash( const IP_Address_t * pxAddress,
+                                            BaseType_t xIsIPv6,
+                                            uint16_t usPort );
+#endif /* ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) */
+
+#if ( ipconfigUSE_TCP_REUSEPORT != 0 )
+
+/*
+ * Check if a socket listens to a shared port and accepts the peer.
+ */
+    static BaseType_t prvTCPReusePortCandidate( const FreeRTOS_Socket_t * pxCandidate,
+                                                uint16_t usLocalPort,
+                                                const IPv46_Address_t * pxRemoteIP );
+
+/*
+ * Choose one of the listening sockets that share the port of 'pxSocket'.
+ */
+    static FreeRTOS_Socket_t * prvTCPSocketSelectReusePort( FreeRTOS_Socket_t * pxSocket,
+                                                            const IPv46_Address_t * pxRemoteIP,
+                                                            UBaseType_t uxRemotePort );
+#endif
+
 /*
  * Return pdTRUE only if pxSocket is valid and bound, as far as can be
  * determined.
@@ -132,6 +235,29 @@ static BaseType_t prvValidSocket( const FreeRTOS_Socket_t * pxSocket,
                                   BaseType_t xProtocol,
                                   BaseType_t xIsBound );
 
+#if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+
+/*
+ * Report an IPv4 address to a dual-stack socket as an IPv4-mapped IPv6
+ * address, and translate an IPv4-mapped destination back to IPv4.
+ */
+    static void prvSocketMapAddress( const FreeRTOS_Socket_t * pxSocket,
+                                     struct freertos_sockaddr * pxAddress );
+
+    static BaseType_t prvSocketUnmapAddress( const FreeRTOS_Socket_t * pxSocket,
+                                             const struct freertos_sockaddr * pxAddress,
+                                             struct freertos_sockaddr * pxIPv4Address );
+
+    #if ( ipconfigUSE_TCP == 1 )
+
+/*
+ * Check if a listening socket accepts a connection from the given peer.
+ */
+        static BaseType_t prvSocketListenAccepts( const FreeRTOS_Socket_t * pxSocket,
+                                                  const IPv46_Address_t * pxRemoteIP );
+    #endif
+#endif /* ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 ) */
+
 #if ( ipconfigUSE_TCP == 1 )
 
 /*
@@ -152,11 +278,56 @@ static BaseType_t prvDetermineSocketSize( BaseType_t xDomain,
                                           BaseType_t xProtocol,
                                           size_t * pxSocketSize );
 
+/*
+ * Create a socket, either in heap memory, or in the memory of the application
+ * when 'pxSocketBuffer' is not NULL.
+ */
+static Socket_t prvSocketCreate( BaseType_t xDomain,
+                                 BaseType_t xType,
+                                 BaseType_t xProtocol,
+                                 StaticSocket_t * pxSocketBuffer );
+
+#if ( ( ipconfigSUPPORT_STATIC_SOCKETS != 0 ) && ( ipconfigUSE_TCP == 1 ) )
+
+/*
+ * Prepare stream storage of the application, and return the number of bytes
+ * that the stream can hold, or zero when the storage can not be used.
+ */
+    static size_t prvStaticStreamPrepare( uint8_t * pucStorage,
+                                          size_t uxStorageSize );
+
+/*
+ * Check if a stream of a socket lives in memory of the application.
+ */
+    static BaseType_t prvTCPStreamIsStatic( const FreeRTOS_Socket_t * pxSocket,
+                                            const StreamBuffer_t * pxStream );
+#else
+    #define prvTCPStreamIsStatic( pxSocket, pxStream )    ( pdFALSE )
+#endif /* ( ipconfigSUPPORT_STATIC_SOCKETS != 0 ) && ( ipconfigUSE_TCP == 1 ) */
+
+static BaseType_t prvSocketPortInUse( const FreeRTOS_Socket_t * pxSocket,
+                                      const List_t * pxSocketList,
+                                      uint16_t usPort );
+
 static BaseType_t prvSocketBindAdd( FreeRTOS_Socket_t * pxSocket,
                                     const struct freertos_sockaddr * pxAddress,
                                     List_t * pxSocketList,
                                     BaseType_t xInternal );
 
+#if ( ipconfigUDP_DIRECT_BIND == 1 )
+
+/** @brief Bind a UDP socket from the calling task, without involving the IP-task. */
+    static BaseType_t prvSocketBindDirect( FreeRTOS_Socket_t * pxSocket,
+                                           struct freertos_sockaddr const * pxAddress );
+#endif
+
+#if ( ipconfigUSE_SOCKET_BUSY_POLL != 0 )
+/** @brief Spin until one of the events is set, before blocking on them. */
+    static void prvSocketBusyPoll( const FreeRTOS_Socket_t * pxSocket,
+                                   EventBits_t xWaitBits,
+                                   TickType_t xMaxTime );
+#endif
+
 static NetworkBufferDescriptor_t * prvRecvFromWaitForPacket( FreeRTOS_Socket_t const * pxSocket,
                                                              BaseType_t xFlags,
                                                              EventBits_t * pxEventBits );
@@ -169,6 +340,16 @@ static int32_t prvSendUDPPacket( const FreeRTOS_Socket_t * pxSocket,
                                  TickType_t xTicksToWait,
                                  size_t uxPayloadOffset );
 
+static void prvPrepareUDPPacket( const FreeRTOS_Socket_t * pxSocket,
+                                 NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                 size_t uxTotalDataLength,
+                                 const struct freertos_sockaddr * pxDestinationAddress,
+                                 size_t uxPayloadOffset );
+
+static size_t prvUDPPayloadOffset( const FreeRTOS_Socket_t * pxSocket,
+                                   uint8_t ucFamily,
+                                   size_t * puxMaxPayloadLength );
+
 #if ( ipconfigUSE_TCP == 1 )
     static FreeRTOS_Socket_t * prvAcceptWaitClient( FreeRTOS_Socket_t * pxParentSocket,
                                                     struct freertos_sockaddr * pxAddress,
@@ -210,8 +391,24 @@ static int32_t prvSendUDPPacket( const FreeRTOS_Socket_t * pxSocket,
  */
     static BaseType_t prvTCPConnectStart( FreeRTOS_Socket_t * pxSocket,
                                           struct freertos_sockaddr const * pxAddress );
+
+/*
+ * Called from FreeRTOS_connect() for a TCP socket: start connecting and wait
+ * for the result.
+ */
+    static BaseType_t prvTCPConnect( FreeRTOS_Socket_t * pxSocket,
+                                     const struct freertos_sockaddr * pxAddress );
 #endif /* ipconfigUSE_TCP */
 
+#if ( ipconfigUSE_UDP_CONNECT != 0 )
+
+/*
+ * Called from FreeRTOS_connect() for a UDP socket: store the peer address.
+ */
+    static BaseType_t prvUDPConnect( FreeRTOS_Socket_t * pxSocket,
+                                     const struct freertos_sockaddr * pxAddress );
+#endif /* ipconfigUSE_UDP_CONNECT */
+
 #if ( ipconfigUSE_TCP == 1 )
 
 /*
@@ -233,13 +430,29 @@ static BaseType_t prvMakeSureSocketIsBound( FreeRTOS_Socket_t * pxSocket );
 
 #endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
 
+#if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+
+/* Record events of a socket and put it in the ready list of its socket set. */
+    static void prvSelectReadyListAdd( FreeRTOS_Socket_t * pxSocket,
+                                       EventBits_t xSelectBits );
+
+/* Take a socket out of the ready list of its socket set. */
+    static void prvSelectReadyListRemove( FreeRTOS_Socket_t * pxSocket );
+
+#endif /* ipconfigSUPPORT_SELECT_READY_LIST == 1 */
+
 #if ( ipconfigUSE_TCP == 1 )
 
 /** @brief This routine will wait for data to arrive in the stream buffer.
  */
-    static BaseType_t prvRecvWait( const FreeRTOS_Socket_t * pxSocket,
+    static BaseType_t prvRecvWait( FreeRTOS_Socket_t * pxSocket,
                                    EventBits_t * pxEventBits,
-                                   BaseType_t xFlags );
+                                   BaseType_t xFlags,
+                                   BaseType_t xRecord );
+
+/** @brief Return the number of bytes that prvRecvWait() waits for. */
+    static BaseType_t prvRecvAvailable( FreeRTOS_Socket_t * pxSocket,
+                                        BaseType_t xRecord );
 #endif /* ( ipconfigUSE_TCP == 1 ) */
 
 #if ( ipconfigUSE_TCP == 1 )
@@ -282,6 +495,15 @@ static BaseType_t prvMakeSureSocketIsBound( FreeRTOS_Socket_t * pxSocket );
                                               const void * pvOptionValue );
 #endif /* ( ipconfigUSE_TCP != 0 ) */
 
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_TCP_CONGESTION.
+ */
+    static BaseType_t prvSetOptionCongestionControl( FreeRTOS_Socket_t * pxSocket,
+                                                     const void * pvOptionValue );
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) */
+
 #if ( ipconfigUSE_TCP != 0 )
 
 /**
@@ -307,8 +529,173 @@ static BaseType_t prvMakeSureSocketIsBound( FreeRTOS_Socket_t * pxSocket );
     static BaseType_t prvSetOptionStopRX( FreeRTOS_Socket_t * pxSocket,
                                           const void * pvOptionValue );
 
+/** @brief Handle the socket option FREERTOS_SO_TCP_CORK. */
+    static BaseType_t prvSetOptionCork( FreeRTOS_Socket_t * pxSocket,
+                                        const void * pvOptionValue );
+
 #endif /* ( ipconfigUSE_TCP != 0 ) */
 
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_RX_BUFFER_COUNT != 0 ) )
+
+/** @brief Handle the socket option FREERTOS_SO_RX_BUFFER_CHAIN. */
+    static BaseType_t prvSetOptionRxBufferChain( FreeRTOS_Socket_t * pxSocket,
+                                                 const void * pvOptionValue );
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_RX_BUFFER_COUNT != 0 ) */
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_LISTEN_POOL_SIZE != 0 ) )
+
+/** @brief Handle the socket option FREERTOS_SO_LISTEN_POOL. */
+    static BaseType_t prvSetOptionListenPool( FreeRTOS_Socket_t * pxSocket,
+                                              const void * pvOptionValue );
+
+/** @brief Create child sockets until the pool of a listening socket is full. */
+    static void prvTCPListenPoolFill( FreeRTOS_Socket_t * pxSocket );
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_LISTEN_POOL_SIZE != 0 ) */
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_PACING != 0 ) )
+
+/** @brief Handle the socket option FREERTOS_SO_TCP_PACING. */
+    static BaseType_t prvSetOptionPacing( FreeRTOS_Socket_t * pxSocket,
+                                          const void * pvOptionValue );
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_PACING != 0 ) */
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_ACK_POLICY != 0 ) )
+
+/** @brief Handle the socket option FREERTOS_SO_TCP_ACK_POLICY. */
+    static BaseType_t prvSetOptionAckPolicy( FreeRTOS_Socket_t * pxSocket,
+                                             const void * pvOptionValue );
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_ACK_POLICY != 0 ) */
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_SPLICE != 0 ) )
+
+/** @brief Handle the socket option FREERTOS_SO_TCP_SPLICE. */
+    static BaseType_t prvSetOptionSplice( FreeRTOS_Socket_t * pxSocket,
+                                          const void * pvOptionValue );
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_SPLICE != 0 ) */
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_RECORD_FRAMING != 0 ) )
+
+/** @brief Handle the socket option FREERTOS_SO_TCP_RECORD. */
+    static BaseType_t prvSetOptionRecordFraming( FreeRTOS_Socket_t * pxSocket,
+                                                 const void * pvOptionValue );
+
+/** @brief Return the length of the complete record at the start of the RX stream. */
+    static BaseType_t prvTCPRecordAvailable( FreeRTOS_Socket_t * pxSocket );
+
+/** @brief With record framing, the reader is only woken up for a complete
+ * record. */
+    #define sockRECORD_READABLE( pxSocket )                                  \
+    ( ( ( pxSocket )->u.xTCP.xRecordFraming.ucLengthSize == 0U ) ||          \
+      ( prvTCPRecordAvailable( pxSocket ) != 0 ) )
+#else
+    #define sockRECORD_READABLE( pxSocket )    ( pdTRUE )
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_RECORD_FRAMING != 0 ) */
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_FAST_OPEN != 0 ) )
+
+/** @brief Handle the socket option FREERTOS_SO_TCP_FASTOPEN. */
+    static BaseType_t prvSetOptionFastOpen( FreeRTOS_Socket_t * pxSocket,
+                                            const void * pvOptionValue );
+
+/** @brief A Fast Open client may queue data before it connects, the data is
+ * sent along with the SYN. */
+    #define sockFAST_OPEN_MAY_QUEUE( pxSocket )                               \
+    ( ( ( pxSocket )->u.xTCP.bits.bFastOpen != pdFALSE_UNSIGNED ) &&          \
+      ( ( pxSocket )->u.xTCP.eTCPState == eCLOSED ) &&                        \
+      ( ( pxSocket )->u.xTCP.usRemotePort == 0U ) )
+#else
+    #define sockFAST_OPEN_MAY_QUEUE( pxSocket )    ( pdFALSE )
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_FAST_OPEN != 0 ) */
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_AUTO_TUNING != 0 ) )
+
+/** @brief Switch off auto-tuning for a socket. */
+    static void prvTCPAutoTuneDisable( FreeRTOS_Socket_t * pxSocket );
+
+/** @brief Give back the memory that auto-tuning added to the streams of a socket. */
+    static void prvTCPAutoTuneRelease( FreeRTOS_Socket_t * pxSocket );
+
+/** @brief The number of bytes that auto-tuning has added to the streams of all
+ *         TCP sockets, at most ipconfigTCP_AUTO_TUNING_BUDGET.  Only accessed
+ *         by the IP-task. */
+    static size_t uxTCPAutoTuneTotal = 0U;
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_AUTO_TUNING != 0 ) */
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_STREAM_RELEASE_TIME != 0 ) )
+
+/** @brief Take a stream buffer with the given length from the pool. */
+    static StreamBuffer_t * prvTCPStreamPoolTake( size_t uxLength );
+
+/** @brief Keep a stream buffer that is not used any more in the pool. */
+    static BaseType_t prvTCPStreamPoolPut( StreamBuffer_t * pxStream );
+
+/** @brief Create a TX stream that was released while an API function wants to use it. */
+    static BaseType_t prvTCPRestoreTxStream( FreeRTOS_Socket_t * pxSocket );
+
+/** @brief The application uses the TX stream directly, do not release it. */
+    static void prvTCPKeepTxStream( FreeRTOS_Socket_t * pxSocket );
+
+/** @brief A stream buffer that was released by an idle or a closed socket. */
+    typedef struct xTCP_POOLED_STREAM
+    {
+        StreamBuffer_t * pxStream; /**< The buffer. */
+        TickType_t xReleaseTime;   /**< The time at which it was put in the pool. */
+    } TCPPooledStream_t;
+
+/** @brief The released stream buffers, the oldest ones come first. */
+    static TCPPooledStream_t xTCPStreamPool[ ipconfigTCP_STREAM_POOL_COUNT ];
+
+/** @brief The number of stream buffers in xTCPStreamPool[]. */
+    static UBaseType_t uxTCPStreamPoolCount = 0U;
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_STREAM_RELEASE_TIME != 0 ) */
+
+#if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+
+/** @brief Send an eSocketAsyncEvent for a ring, unless one is waiting already. */
+    static BaseType_t prvAsyncSendEvent( SocketAsyncRing_t * pxRing,
+                                         BaseType_t xDelete,
+                                         TickType_t uxTimeout );
+
+/** @brief Store the result of a request in the completions of a ring. */
+    static void prvAsyncAddCompletion( SocketAsyncRing_t * pxRing,
+                                       const FreeRTOS_AsyncRequest_t * pxRequest,
+                                       Socket_t xSocket,
+                                       int32_t lResult,
+                                       const struct freertos_sockaddr * pxAddress );
+
+/** @brief Complete an entry of xInFlight[] and remove it. */
+    static void prvAsyncFinish( SocketAsyncRing_t * pxRing,
+                                size_t uxIndex,
+                                Socket_t xSocket,
+                                int32_t lResult,
+                                const struct freertos_sockaddr * pxAddress );
+
+/** @brief Complete the requests that wait for a socket that is being closed. */
+    static void prvAsyncCancelSocket( FreeRTOS_Socket_t * pxSocket );
+
+/** @brief Try to carry out a request without blocking. */
+    static BaseType_t prvAsyncTry( AsyncInFlight_t * pxEntry,
+                                   int32_t * plResult,
+                                   Socket_t * pxResultSocket,
+                                   struct freertos_sockaddr * pxAddress );
+
+#endif /* ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 ) */
+
+#if ( ipconfigUSE_TCP == 1 )
+
+/** @brief Copy the statistics of a TCP connection, for FREERTOS_SO_TCP_INFO. */
+    static void prvGetOptionTCPInfo( const FreeRTOS_Socket_t * pxSocket,
+                                     TCPInfo_t * pxInfo );
+
+#endif /* ipconfigUSE_TCP == 1 */
+
 /** @brief Handle the socket options FREERTOS_SO_RCVTIMEO and
  *         FREERTOS_SO_SNDTIMEO.
  */
@@ -344,6 +731,12 @@ static int32_t prvRecvFrom_CopyPacket( uint8_t * pucEthernetBuffer,
                                        BaseType_t xFlags,
                                        int32_t lDataLength );
 
+static int32_t prvRecvFrom_ReadPacket( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                       void * pvBuffer,
+                                       size_t uxBufferLength,
+                                       BaseType_t xFlags,
+                                       struct freertos_sockaddr * pxSourceAddress );
+
 static int32_t prvSendTo_ActualSend( const FreeRTOS_Socket_t * pxSocket,
                                      const void * pvBuffer,
                                      size_t uxTotalDataLength,
@@ -387,6 +780,26 @@ List_t xBoundUDPSocketsList;
 
 #endif /* ipconfigUSE_TCP == 1 */
 
+#if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+
+/** @brief Mask to get a bucket index from a hash value. */
+    #define socketHASH_MASK    ( ( uint32_t ) ipconfigSOCKET_HASH_BUCKET_COUNT - 1U )
+
+/** @brief Hash table of the bound UDP sockets, indexed on the local port.
+ *         Maintained together with xBoundUDPSocketsList.
+ */
+    static List_t xUDPSocketHashTable[ ipconfigSOCKET_HASH_BUCKET_COUNT ];
+
+    #if ( ipconfigUSE_TCP == 1 )
+
+/** @brief Hash table of the bound TCP sockets, indexed on the local port,
+ *         the remote port and the remote IP address. Maintained together
+ *         with xBoundTCPSocketsList.
+ */
+        static List_t xTCPSocketHashTable[ ipconfigSOCKET_HASH_BUCKET_COUNT ];
+    #endif /* ipconfigUSE_TCP == 1 */
+#endif /* ipconfigUSE_SOCKET_HASH_LOOKUP != 0 */
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -428,1819 +841,7474 @@ static BaseType_t prvValidSocket( const FreeRTOS_Socket_t * pxSocket,
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+
 /**
- * @brief Initialise the bound TCP/UDP socket lists.
+ * @brief Rewrite an IPv4 address as an IPv4-mapped IPv6 address ( ::ffff:a.b.c.d )
+ *        when it is reported to an IPv6 socket that also handles IPv4, or to an
+ *        IPv4 connection that was accepted or made by such a socket.
+ *
+ * @param[in] pxSocket The socket that reports the address.
+ * @param[in,out] pxAddress The address, in network byte order.
  */
-void vNetworkSocketsInit( void )
-{
-    vListInitialise( &xBoundUDPSocketsList );
-
-    #if ( ipconfigUSE_TCP == 1 )
+    static void prvSocketMapAddress( const FreeRTOS_Socket_t * pxSocket,
+                                     struct freertos_sockaddr * pxAddress )
     {
-        vListInitialise( &xBoundTCPSocketsList );
+        uint32_t ulIPAddress;
+
+        if( ( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET ) &&
+            ( ( pxSocket->bits.bV4Mapped != pdFALSE_UNSIGNED ) ||
+              ( ( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED ) && ( pxSocket->bits.bV6Only == pdFALSE_UNSIGNED ) ) ) )
+        {
+            /* The IPv4 address shares storage with the IPv6 address. */
+            ulIPAddress = pxAddress->sin_address.ulIP_IPv4;
+
+            ( void ) memset( pxAddress->sin_address.xIP_IPv6.ucBytes, 0, sizeof( pxAddress->sin_address.xIP_IPv6.ucBytes ) );
+            pxAddress->sin_address.xIP_IPv6.ucBytes[ 10 ] = 0xffU;
+            pxAddress->sin_address.xIP_IPv6.ucBytes[ 11 ] = 0xffU;
+            ( void ) memcpy( &( pxAddress->sin_address.xIP_IPv6.ucBytes[ 12 ] ), &( ulIPAddress ), sizeof( ulIPAddress ) );
+            pxAddress->sin_family = ( uint8_t ) FREERTOS_AF_INET6;
+        }
     }
-    #endif /* ipconfigUSE_TCP == 1 */
-}
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Determine the socket size for the given protocol.
+ * @brief Translate an IPv4-mapped IPv6 address ( ::ffff:a.b.c.d ) to a plain
+ *        IPv4 address, unless the socket has the option FREERTOS_SO_IPV6_V6ONLY.
  *
- * @param[in] xDomain The domain for which the size of socket is being determined.
- * @param[in] xType Is this a datagram socket or a stream socket.
- * @param[in] xProtocol The protocol being used.
- * @param[out] pxSocketSize Pointer to a variable in which the size shall be returned
- *                           if all checks pass.
+ * @param[in] pxSocket The socket that uses the address.
+ * @param[in] pxAddress The address as passed by the application.
+ * @param[out] pxIPv4Address Receives the IPv4 address.
  *
- * @return pdPASS if socket size was determined and put in the parameter pxSocketSize
- *         correctly, else pdFAIL.
+ * @return pdTRUE when pxIPv4Address was filled in, otherwise pdFALSE.
  */
-static BaseType_t prvDetermineSocketSize( BaseType_t xDomain,
-                                          BaseType_t xType,
-                                          BaseType_t xProtocol,
-                                          size_t * pxSocketSize )
-{
-    BaseType_t xReturn = pdPASS;
-    FreeRTOS_Socket_t const * pxSocket = NULL;
-
-    /* Asserts must not appear before it has been determined that the network
-     * task is ready - otherwise the asserts will fail. */
-    if( xIPIsNetworkTaskReady() == pdFALSE )
-    {
-        xReturn = pdFAIL;
-    }
-    else
+    static BaseType_t prvSocketUnmapAddress( const FreeRTOS_Socket_t * pxSocket,
+                                             const struct freertos_sockaddr * pxAddress,
+                                             struct freertos_sockaddr * pxIPv4Address )
     {
-        /* Only Ethernet is currently supported. */
-        #if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 == 0 ) )
-        {
-            if( xDomain != FREERTOS_AF_INET )
-            {
-                xReturn = pdFAIL;
-            }
+        static const uint8_t ucMappedPrefix[ 12 ] = { 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0xffU, 0xffU };
+        BaseType_t xReturn = pdFALSE;
 
-            configASSERT( xDomain == FREERTOS_AF_INET );
-        }
-        #elif ( ( ipconfigUSE_IPv4 == 0 ) && ( ipconfigUSE_IPv6 != 0 ) )
+        if( ( pxAddress != NULL ) &&
+            ( xSocketValid( pxSocket ) != pdFALSE ) &&
+            ( pxSocket->bits.bV6Only == pdFALSE_UNSIGNED ) &&
+            ( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET6 ) &&
+            ( memcmp( pxAddress->sin_address.xIP_IPv6.ucBytes, ucMappedPrefix, sizeof( ucMappedPrefix ) ) == 0 ) )
         {
-            if( xDomain != FREERTOS_AF_INET6 )
-            {
-                xReturn = pdFAIL;
-            }
-
-            configASSERT( xDomain == FREERTOS_AF_INET6 );
+            ( void ) memcpy( pxIPv4Address, pxAddress, sizeof( *pxIPv4Address ) );
+            ( void ) memcpy( &( pxIPv4Address->sin_address.ulIP_IPv4 ), &( pxAddress->sin_address.xIP_IPv6.ucBytes[ 12 ] ), sizeof( pxIPv4Address->sin_address.ulIP_IPv4 ) );
+            pxIPv4Address->sin_family = ( uint8_t ) FREERTOS_AF_INET;
+            xReturn = pdTRUE;
         }
-        #else /* if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 == 0 ) ) */
-        {
-            if( ( xDomain != FREERTOS_AF_INET ) && ( xDomain != FREERTOS_AF_INET6 ) )
-            {
-                xReturn = pdFAIL;
-            }
 
-            configASSERT( ( xDomain == FREERTOS_AF_INET ) || ( xDomain == FREERTOS_AF_INET6 ) );
-        }
-        #endif /* if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 == 0 ) ) */
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-        /* Check if the UDP socket-list has been initialised. */
-        configASSERT( listLIST_IS_INITIALISED( &xBoundUDPSocketsList ) );
-        #if ( ipconfigUSE_TCP == 1 )
-        {
-            /* Check if the TCP socket-list has been initialised. */
-            configASSERT( listLIST_IS_INITIALISED( &xBoundTCPSocketsList ) );
-        }
-        #endif /* ipconfigUSE_TCP == 1 */
+    #if ( ipconfigUSE_TCP == 1 )
 
-        if( xProtocol == FREERTOS_IPPROTO_UDP )
+/**
+ * @brief Check if a listening socket accepts a connection from a peer:
+ *        an IPv6 socket with the option FREERTOS_SO_IPV6_V6ONLY does not
+ *        accept IPv4 peers.
+ *
+ * @param[in] pxSocket The listening socket.
+ * @param[in] pxRemoteIP The address of the peer.
+ *
+ * @return pdTRUE when the peer may connect, otherwise pdFALSE.
+ */
+        static BaseType_t prvSocketListenAccepts( const FreeRTOS_Socket_t * pxSocket,
+                                                  const IPv46_Address_t * pxRemoteIP )
         {
-            if( xType != FREERTOS_SOCK_DGRAM )
+            BaseType_t xReturn = pdTRUE;
+
+            if( ( pxSocket->bits.bV6Only != pdFALSE_UNSIGNED ) && ( pxRemoteIP->xIs_IPv6 == pdFALSE ) )
             {
-                xReturn = pdFAIL;
-                configASSERT( xReturn == pdPASS ); /* LCOV_EXCL_BR_LINE Exclude this line from branch coverage as the not-taken condition will never happen. */
+                xReturn = pdFALSE;
             }
 
-            /* In case a UDP socket is created, do not allocate space for TCP data. */
-            *pxSocketSize = ( sizeof( *pxSocket ) - sizeof( pxSocket->u ) ) + sizeof( pxSocket->u.xUDP );
+            return xReturn;
         }
+/*-----------------------------------------------------------*/
+    #endif /* ( ipconfigUSE_TCP == 1 ) */
 
-        #if ( ipconfigUSE_TCP == 1 )
-            else if( xProtocol == FREERTOS_IPPROTO_TCP )
-            {
-                if( xType != FREERTOS_SOCK_STREAM )
-                {
-                    xReturn = pdFAIL;
-                    configASSERT( xReturn == pdPASS ); /* LCOV_EXCL_BR_LINE Exclude this line from branch coverage as the not-taken condition will never happen. */
-                }
+#endif /* ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 ) */
 
-                *pxSocketSize = ( sizeof( *pxSocket ) - sizeof( pxSocket->u ) ) + sizeof( pxSocket->u.xTCP );
-            }
-        #endif /* ipconfigUSE_TCP == 1 */
-        else
+/**
+ * @brief Initialise the bound TCP/UDP socket lists.
+ */
+void vNetworkSocketsInit( void )
+{
+    vListInitialise( &xBoundUDPSocketsList );
+
+    #if ( ipconfigUSE_TCP == 1 )
+    {
+        vListInitialise( &xBoundTCPSocketsList );
+
+        #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
         {
-            xReturn = pdFAIL;
-            configASSERT( xReturn == pdPASS ); /* LCOV_EXCL_BR_LINE Exclude this line from branch coverage as the not-taken condition will never happen. */
+            vTCPTimerWheelInit();
         }
+        #endif
     }
+    #endif /* ipconfigUSE_TCP == 1 */
 
-    /* In case configASSERT() is not used */
-    ( void ) xDomain;
-    ( void ) pxSocket; /* Was only used for sizeof. */
-    return xReturn;
+    #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+    {
+        size_t uxIndex;
+
+        for( uxIndex = 0U; uxIndex < ( size_t ) ipconfigSOCKET_HASH_BUCKET_COUNT; uxIndex++ )
+        {
+            vListInitialise( &( xUDPSocketHashTable[ uxIndex ] ) );
+            #if ( ipconfigUSE_TCP == 1 )
+            {
+                vListInitialise( &( xTCPSocketHashTable[ uxIndex ] ) );
+            }
+            #endif /* ipconfigUSE_TCP == 1 */
+        }
+    }
+    #endif /* ipconfigUSE_SOCKET_HASH_LOOKUP != 0 */
 }
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
+#if ( ( ipconfigSOCKET_POOL_UDP_COUNT != 0 ) || ( ipconfigSOCKET_POOL_TCP_COUNT != 0 ) )
 
-/**
- * @brief Called by FreeRTOS_socket(), it will initialise some essential TCP
- *        fields in the socket.
- * @param[in] pxSocket the TCP socket to be initialised.
- * @param[in] uxSocketSize The calculated size of the socket, only used to
- *                          gather memory usage statistics.
- */
-    static void prvInitialiseTCPFields( FreeRTOS_Socket_t * pxSocket,
-                                        size_t uxSocketSize )
+/** @brief The number of words that hold an object of 'uxSize' bytes. */
+    #define socketPOOL_WORDS( uxSize )    ( ( ( uxSize ) + sizeof( size_t ) - 1U ) / sizeof( size_t ) )
+
+/** @brief The size of a socket object that only holds the UDP part, as in prvDetermineSocketSize(). */
+    #define socketPOOL_UDP_SIZE           ( ( sizeof( FreeRTOS_Socket_t ) - sizeof( ( ( FreeRTOS_Socket_t * ) NULL )->u ) ) + sizeof( IPUDPSocket_t ) )
+
+/** @brief A pool of socket objects of the same size. */
+    typedef struct xSOCKET_POOL
     {
-        ( void ) uxSocketSize;
-        /* Lint wants at least a comment, in case the macro is empty. */
-        iptraceMEM_STATS_CREATE( tcpSOCKET_TCP, pxSocket, uxSocketSize + sizeof( StaticEventGroup_t ) );
-        /* StreamSize is expressed in number of bytes */
-        /* Round up buffer sizes to nearest multiple of MSS */
-        pxSocket->u.xTCP.usMSS = ( uint16_t ) ipconfigTCP_MSS;
+        size_t * puxStorage;     /**< The memory of the objects. */
+        size_t uxObjectSize;     /**< The size of one object in bytes, a multiple of a word. */
+        UBaseType_t uxCount;     /**< The number of objects in the pool. */
+        UBaseType_t uxUsed;      /**< The number of objects at the start of the storage that were handed out once. */
+        UBaseType_t uxFree;      /**< The number of objects that are not in use. */
+        void * pvFreeList;       /**< The objects that were put back, linked through their first word. */
+    } SocketPool_t;
+
+    #if ( ipconfigSOCKET_POOL_UDP_COUNT != 0 )
+        /** @brief The memory of the UDP socket objects. */
+        static size_t uxSocketPoolUDPStorage[ ipconfigSOCKET_POOL_UDP_COUNT * socketPOOL_WORDS( socketPOOL_UDP_SIZE ) ];
+
+        /** @brief The pool of UDP socket objects. */
+        static SocketPool_t xSocketPoolUDP =
+        {
+            uxSocketPoolUDPStorage,
+            socketPOOL_WORDS( socketPOOL_UDP_SIZE ) * sizeof( size_t ),
+            ipconfigSOCKET_POOL_UDP_COUNT,
+            0U,
+            ipconfigSOCKET_POOL_UDP_COUNT,
+            NULL
+        };
+    #endif
 
-        #if ( ipconfigUSE_IPv6 != 0 )
-            if( pxSocket->bits.bIsIPv6 != 0U )
-            {
-                uint16_t usDifference = ipSIZE_OF_IPv6_HEADER - ipSIZE_OF_IPv4_HEADER;
+    #if ( ipconfigSOCKET_POOL_TCP_COUNT != 0 )
+        /** @brief The memory of the TCP socket objects. */
+        static size_t uxSocketPoolTCPStorage[ ipconfigSOCKET_POOL_TCP_COUNT * socketPOOL_WORDS( sizeof( FreeRTOS_Socket_t ) ) ];
 
-                /* Because ipconfigTCP_MSS is guaranteed not less than tcpMINIMUM_SEGMENT_LENGTH by FreeRTOSIPConfigDefaults.h,
-                 * it's unnecessary to check if xSocket->u.xTCP.usMSS is greater than difference. */
-                pxSocket->u.xTCP.usMSS = ( uint16_t ) ( pxSocket->u.xTCP.usMSS - usDifference );
-            }
-        #endif /* ipconfigUSE_IPv6 != 0 */
+        /** @brief The pool of TCP socket objects. */
+        static SocketPool_t xSocketPoolTCP =
+        {
+            uxSocketPoolTCPStorage,
+            socketPOOL_WORDS( sizeof( FreeRTOS_Socket_t ) ) * sizeof( size_t ),
+            ipconfigSOCKET_POOL_TCP_COUNT,
+            0U,
+            ipconfigSOCKET_POOL_TCP_COUNT,
+            NULL
+        };
+    #endif
 
-        pxSocket->u.xTCP.uxRxStreamSize = ( size_t ) ipconfigTCP_RX_BUFFER_LENGTH;
-        pxSocket->u.xTCP.uxTxStreamSize = ( size_t ) FreeRTOS_round_up( ipconfigTCP_TX_BUFFER_LENGTH, ipconfigTCP_MSS );
-        /* Use half of the buffer size of the TCP windows */
-        #if ( ipconfigUSE_TCP_WIN == 1 )
+/**
+ * @brief Take an object from a pool: a socket that was put back, or else one
+ *        that was never handed out.  Must be called with the scheduler
+ *        suspended.
+ *
+ * @param[in] pxPool The pool.
+ *
+ * @return The object, or NULL when all objects are in use.
+ */
+    static void * prvSocketPoolTake( SocketPool_t * pxPool )
+    {
+        void * pvReturn = NULL;
+
+        if( pxPool->pvFreeList != NULL )
         {
-            pxSocket->u.xTCP.uxRxWinSize = FreeRTOS_max_size_t( 1U, ( pxSocket->u.xTCP.uxRxStreamSize / 2U ) / ipconfigTCP_MSS );
-            pxSocket->u.xTCP.uxTxWinSize = FreeRTOS_max_size_t( 1U, ( pxSocket->u.xTCP.uxTxStreamSize / 2U ) / ipconfigTCP_MSS );
+            pvReturn = pxPool->pvFreeList;
+            pxPool->pvFreeList = *( ( void ** ) pvReturn );
         }
-        #else
+        else if( pxPool->uxUsed < pxPool->uxCount )
         {
-            pxSocket->u.xTCP.uxRxWinSize = 1U;
-            pxSocket->u.xTCP.uxTxWinSize = 1U;
+            pvReturn = ( void * ) &( ( ( uint8_t * ) pxPool->puxStorage )[ pxPool->uxUsed * pxPool->uxObjectSize ] );
+            pxPool->uxUsed++;
+        }
+        else
+        {
+            /* All objects are in use. */
         }
-        #endif
 
-        /* The above values are just defaults, and can be overridden by
-         * calling FreeRTOS_setsockopt().  No buffers will be allocated until a
-         * socket is connected and data is exchanged. */
+        if( pvReturn != NULL )
+        {
+            pxPool->uxFree--;
+        }
+
+        return pvReturn;
     }
-#endif /* ( ipconfigUSE_TCP == 1 ) */
 /*-----------------------------------------------------------*/
 
 /**
- * @brief allocate and initialise a socket.
+ * @brief Put an object back in its pool, if it belongs to it.  Must be
+ *        called with the scheduler suspended.
  *
- * @param[in] xDomain The domain in which the socket should be created.
- * @param[in] xType The type of the socket.
- * @param[in] xProtocol The protocol of the socket.
+ * @param[in] pxPool The pool.
+ * @param[in] pvObject The object.
  *
- * @return FREERTOS_INVALID_SOCKET if the allocation failed, or if there was
- *         a parameter error, otherwise a valid socket.
+ * @return pdTRUE when the object belongs to the pool.
  */
-Socket_t FreeRTOS_socket( BaseType_t xDomain,
-                          BaseType_t xType,
-                          BaseType_t xProtocol )
-{
-    FreeRTOS_Socket_t * pxSocket;
+    static BaseType_t prvSocketPoolGive( SocketPool_t * pxPool,
+                                         void * pvObject )
+    {
+        const uint8_t * pucStart = ( const uint8_t * ) pxPool->puxStorage;
+        const uint8_t * pucObject = ( const uint8_t * ) pvObject;
+        BaseType_t xReturn = pdFALSE;
 
-/* Note that this value will be over-written by the call to prvDetermineSocketSize. */
-    size_t uxSocketSize = 1;
-    EventGroupHandle_t xEventGroup;
-    Socket_t xReturn;
-    BaseType_t xProtocolCpy = xProtocol;
+        if( ( pucObject >= pucStart ) && ( pucObject < &( pucStart[ pxPool->uxCount * pxPool->uxObjectSize ] ) ) )
+        {
+            *( ( void ** ) pvObject ) = pxPool->pvFreeList;
+            pxPool->pvFreeList = pvObject;
+            pxPool->uxFree++;
+            xReturn = pdTRUE;
+        }
 
-    configASSERT( ( xDomain == FREERTOS_AF_INET6 ) || ( xDomain == FREERTOS_AF_INET ) );
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-    /* Introduce a do-while loop to allow use of break statements. */
-    do
+/**
+ * @brief Allocate a socket object, the allocator behind pvPortMallocSocket().
+ *        A UDP socket is taken from the UDP pool, a TCP socket from the TCP
+ *        pool.  A protocol without a pool uses the heap.
+ *
+ * @param[in] uxSize The size determined by prvDetermineSocketSize().
+ *
+ * @return The socket object, or NULL when the pool is empty.
+ */
+    void * pvSocketPoolGet( size_t uxSize )
     {
-        /* The special protocol FREERTOS_SOCK_DEPENDENT_PROTO, which is equivalent
-         * to passing 0 as defined by POSIX, indicates to the socket layer that it
-         * should pick a sensible default protocol based off the given socket type.
-         * If we can't, prvDetermineSocketSize will catch it as an invalid
-         * type/protocol combo.
-         */
-        if( xProtocol == FREERTOS_SOCK_DEPENDENT_PROTO )
-        {
-            switch( xType )
+        void * pvReturn = NULL;
+        BaseType_t xIsUDP = ( uxSize <= socketPOOL_UDP_SIZE ) ? pdTRUE : pdFALSE;
+        BaseType_t xPooled = pdFALSE;
+
+        #if ( ipconfigSOCKET_POOL_UDP_COUNT != 0 )
+            if( xIsUDP != pdFALSE )
             {
-                case FREERTOS_SOCK_DGRAM:
-                    xProtocolCpy = FREERTOS_IPPROTO_UDP;
-                    break;
+                xPooled = pdTRUE;
 
-                case FREERTOS_SOCK_STREAM:
-                    xProtocolCpy = FREERTOS_IPPROTO_TCP;
-                    break;
+                vTaskSuspendAll();
+                {
+                    pvReturn = prvSocketPoolTake( &( xSocketPoolUDP ) );
+                }
+                ( void ) xTaskResumeAll();
+            }
+        #endif
 
-                default:
+        #if ( ipconfigSOCKET_POOL_TCP_COUNT != 0 )
+            if( ( xIsUDP == pdFALSE ) && ( uxSize <= sizeof( FreeRTOS_Socket_t ) ) )
+            {
+                xPooled = pdTRUE;
 
-                    /* incorrect xType. this will be caught by
-                     * prvDetermineSocketSize.
-                     */
-                    break;
+                vTaskSuspendAll();
+                {
+                    pvReturn = prvSocketPoolTake( &( xSocketPoolTCP ) );
+                }
+                ( void ) xTaskResumeAll();
             }
-        }
+        #endif
 
-        if( prvDetermineSocketSize( xDomain, xType, xProtocolCpy, &uxSocketSize ) == pdFAIL )
+        if( xPooled == pdFALSE )
         {
-            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
-            /* coverity[misra_c_2012_rule_11_4_violation] */
-            xReturn = FREERTOS_INVALID_SOCKET;
-            break;
+            pvReturn = pvPortMalloc( uxSize );
         }
-
-        /* Allocate the structure that will hold the socket information. The
-        * size depends on the type of socket: UDP sockets need less space. A
-        * define 'pvPortMallocSocket' will used to allocate the necessary space.
-        * By default it points to the FreeRTOS function 'pvPortMalloc()'. */
-
-        /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
-        /* coverity[misra_c_2012_directive_4_12_violation] */
-        pxSocket = ( ( FreeRTOS_Socket_t * ) pvPortMallocSocket( uxSocketSize ) );
-
-        if( pxSocket == NULL )
+        else if( pvReturn == NULL )
         {
-            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
-            /* coverity[misra_c_2012_rule_11_4_violation] */
-            xReturn = FREERTOS_INVALID_SOCKET;
-            iptraceFAILED_TO_CREATE_SOCKET();
-            break;
+            FreeRTOS_debug_printf( ( "pvSocketPoolGet: no %s socket left\n", ( xIsUDP != pdFALSE ) ? "UDP" : "TCP" ) );
+        }
+        else
+        {
+            /* A socket was taken from the pool. */
         }
 
-        xEventGroup = xEventGroupCreate();
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
 
-        if( xEventGroup == NULL )
-        {
-            vPortFreeSocket( pxSocket );
+/**
+ * @brief Give back a socket object, the allocator behind vPortFreeSocket().
+ *
+ * @param[in] pvSocket The object returned by pvSocketPoolGet(), or NULL.
+ */
+    void vSocketPoolPut( void * pvSocket )
+    {
+        BaseType_t xPooled = pdFALSE;
 
-            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
-            /* coverity[misra_c_2012_rule_11_4_violation] */
-            xReturn = FREERTOS_INVALID_SOCKET;
-            iptraceFAILED_TO_CREATE_EVENT_GROUP();
-        }
-        else
+        if( pvSocket != NULL )
         {
-            /* Clear the entire space to avoid nulling individual entries. */
-            ( void ) memset( pxSocket, 0, uxSocketSize );
+            vTaskSuspendAll();
+            {
+                #if ( ipconfigSOCKET_POOL_UDP_COUNT != 0 )
+                {
+                    xPooled = prvSocketPoolGive( &( xSocketPoolUDP ), pvSocket );
+                }
+                #endif
 
-            pxSocket->xEventGroup = xEventGroup;
+                #if ( ipconfigSOCKET_POOL_TCP_COUNT != 0 )
+                {
+                    if( xPooled == pdFALSE )
+                    {
+                        xPooled = prvSocketPoolGive( &( xSocketPoolTCP ), pvSocket );
+                    }
+                }
+                #endif
+            }
+            ( void ) xTaskResumeAll();
 
-            switch( xDomain ) /* LCOV_EXCL_BR_LINE Exclude this because domain is checked at the begin of this function. */
+            if( xPooled == pdFALSE )
             {
-                #if ( ipconfigUSE_IPv6 != 0 )
-                    case FREERTOS_AF_INET6:
-                        pxSocket->bits.bIsIPv6 = pdTRUE_UNSIGNED;
-                        break;
-                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
-
-                #if ( ipconfigUSE_IPv4 != 0 )
-                    case FREERTOS_AF_INET:
-                        pxSocket->bits.bIsIPv6 = pdFALSE_UNSIGNED;
-                        break;
-                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+                vPortFree( pvSocket );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
 
-                default: /* LCOV_EXCL_LINE Exclude this because domain is checked at the begin of this function. */
-                    FreeRTOS_debug_printf( ( "FreeRTOS_socket: Undefined xDomain \n" ) );
+/**
+ * @brief Get the number of socket objects in a pool that are not in use.
+ *
+ * @param[in] xProtocol FREERTOS_IPPROTO_UDP or FREERTOS_IPPROTO_TCP.
+ *
+ * @return The number of free objects, zero for a protocol without a pool.
+ */
+    UBaseType_t uxSocketPoolGetFreeCount( BaseType_t xProtocol )
+    {
+        UBaseType_t uxReturn = 0U;
 
-                    /* MISRA 16.4 Compliance */
-                    break; /* LCOV_EXCL_LINE Exclude this because domain is checked at the begin of this function. */
+        #if ( ipconfigSOCKET_POOL_UDP_COUNT != 0 )
+            if( xProtocol == FREERTOS_IPPROTO_UDP )
+            {
+                uxReturn = xSocketPoolUDP.uxFree;
             }
+        #endif
 
-            /* Initialise the socket's members.  The semaphore will be created
-             * if the socket is bound to an address, for now the pointer to the
-             * semaphore is just set to NULL to show it has not been created. */
-            if( xProtocolCpy == FREERTOS_IPPROTO_UDP )
+        #if ( ipconfigSOCKET_POOL_TCP_COUNT != 0 )
+            if( xProtocol == FREERTOS_IPPROTO_TCP )
             {
-                iptraceMEM_STATS_CREATE( tcpSOCKET_UDP, pxSocket, uxSocketSize + sizeof( StaticEventGroup_t ) );
-
-                vListInitialise( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
-
-                #if ( ipconfigUDP_MAX_RX_PACKETS > 0U )
-                {
-                    pxSocket->u.xUDP.uxMaxPackets = ( UBaseType_t ) ipconfigUDP_MAX_RX_PACKETS;
-                }
-                #endif /* ipconfigUDP_MAX_RX_PACKETS > 0 */
+                uxReturn = xSocketPoolTCP.uxFree;
             }
+        #endif
 
-            #if ( ipconfigUSE_TCP == 1 )
-                else if( xProtocolCpy == FREERTOS_IPPROTO_TCP ) /* LCOV_EXCL_BR_LINE Exclude else case because protocol is checked in prvDetermineSocketSize */
-                {
-                    prvInitialiseTCPFields( pxSocket, uxSocketSize );
-                }
-                else
-                {
-                    /* MISRA wants to see an unconditional else clause. */
-                }
-            #endif /* ipconfigUSE_TCP == 1 */
+        ( void ) xProtocol;
 
-            vListInitialiseItem( &( pxSocket->xBoundSocketListItem ) );
-            listSET_LIST_ITEM_OWNER( &( pxSocket->xBoundSocketListItem ), ( void * ) pxSocket );
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
 
-            pxSocket->xReceiveBlockTime = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
-            pxSocket->xSendBlockTime = ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME;
-            pxSocket->ucSocketOptions = ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT;
-            pxSocket->ucProtocol = ( uint8_t ) xProtocolCpy; /* protocol: UDP or TCP */
+#endif /* ( ipconfigSOCKET_POOL_UDP_COUNT != 0 ) || ( ipconfigSOCKET_POOL_TCP_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
 
-            xReturn = pxSocket;
-        }
-    } while( ipFALSE_BOOL );
+#if ( ipconfigUSE_SOCKET_MEMORY_BUDGET != 0 )
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+/** @brief The use of the budget above which the pressure is moderate, and high. */
+    #define socketMEMORY_LOW_BYTES     ( ( size_t ) ( ( ( uint64_t ) ipconfigSOCKET_MEMORY_BUDGET * ipconfigSOCKET_MEMORY_LOW_WATERMARK ) / 100U ) )
+    #define socketMEMORY_HIGH_BYTES    ( ( size_t ) ( ( ( uint64_t ) ipconfigSOCKET_MEMORY_BUDGET * ipconfigSOCKET_MEMORY_HIGH_WATERMARK ) / 100U ) )
 
-#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+/** @brief The use of the memory budget.  These variables are only accessed
+ *         from within a critical section. */
+    static size_t uxSocketMemoryUsed = 0U;
+    static size_t uxSocketMemoryPeak = 0U;
+    static uint32_t ulSocketMemoryRefused = 0U;
+    static uint32_t ulSocketMemoryUDPDropped = 0U;
+
+/** @brief The pressure that belongs to 'uxSocketMemoryUsed'. */
+    static eSocketMemoryPressure_t eSocketMemoryCurrentPressure = eSocketMemoryNormal;
 
 /**
- * @brief Create a socket set.
+ * @brief Add or subtract bytes from the use of the budget, and find the new
+ *        pressure.  Must be called from within a critical section.
  *
- * @return The new socket set which was created, or NULL when allocation has failed.
+ * @param[in] xAllocated pdTRUE when the bytes are added, pdFALSE when they are given back.
+ * @param[in] uxBytes The number of bytes.
+ *
+ * @return pdFAIL when added bytes do not fit in the budget, otherwise pdPASS.
  */
-    SocketSet_t FreeRTOS_CreateSocketSet( void )
+    static BaseType_t prvSocketMemoryCount( BaseType_t xAllocated,
+                                            size_t uxBytes )
     {
-        SocketSelect_t * pxSocketSet;
-
-        /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
-        /* coverity[misra_c_2012_directive_4_12_violation] */
-        pxSocketSet = ( ( SocketSelect_t * ) pvPortMalloc( sizeof( *pxSocketSet ) ) );
+        BaseType_t xReturn = pdPASS;
+        eSocketMemoryPressure_t ePressure;
 
-        if( pxSocketSet != NULL )
+        if( xAllocated != pdFALSE )
         {
-            ( void ) memset( pxSocketSet, 0, sizeof( *pxSocketSet ) );
-            pxSocketSet->xSelectGroup = xEventGroupCreate();
-
-            if( pxSocketSet->xSelectGroup == NULL )
+            if( uxBytes > ( ( size_t ) ipconfigSOCKET_MEMORY_BUDGET - uxSocketMemoryUsed ) )
             {
-                vPortFree( pxSocketSet );
-                pxSocketSet = NULL;
+                xReturn = pdFAIL;
             }
             else
             {
-                /* Lint wants at least a comment, in case the macro is empty. */
-                iptraceMEM_STATS_CREATE( tcpSOCKET_SET, pxSocketSet, sizeof( *pxSocketSet ) + sizeof( StaticEventGroup_t ) );
+                uxSocketMemoryUsed += uxBytes;
+
+                if( uxSocketMemoryPeak < uxSocketMemoryUsed )
+                {
+                    uxSocketMemoryPeak = uxSocketMemoryUsed;
+                }
             }
         }
+        else
+        {
+            uxSocketMemoryUsed -= FreeRTOS_min_size_t( uxBytes, uxSocketMemoryUsed );
+        }
 
-        return ( SocketSet_t ) pxSocketSet;
-    }
+        if( uxSocketMemoryUsed > socketMEMORY_HIGH_BYTES )
+        {
+            ePressure = eSocketMemoryHigh;
+        }
+        else if( uxSocketMemoryUsed > socketMEMORY_LOW_BYTES )
+        {
+            ePressure = eSocketMemoryModerate;
+        }
+        else
+        {
+            ePressure = eSocketMemoryNormal;
+        }
 
-#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
-/*-----------------------------------------------------------*/
+        if( ePressure != eSocketMemoryCurrentPressure )
+        {
+            eSocketMemoryCurrentPressure = ePressure;
+            iptraceSOCKET_MEMORY_PRESSURE( ePressure, uxSocketMemoryUsed );
+        }
 
-#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
 /**
- * @brief Delete a given socket set.
+ * @brief Count bytes held by sockets, unless they do not fit in the budget.
  *
- * @param[in] xSocketSet The socket set being deleted.
+ * @param[in] uxBytes The number of bytes.
+ *
+ * @return pdPASS when the bytes were counted, pdFAIL when they do not fit.
  */
-    void FreeRTOS_DeleteSocketSet( SocketSet_t xSocketSet )
+    BaseType_t xSocketMemoryCharge( size_t uxBytes )
     {
-        IPStackEvent_t xCloseEvent;
+        BaseType_t xReturn;
 
+        /* Streams are created by the API as well as by the IP-task. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = prvSocketMemoryCount( pdTRUE, uxBytes );
 
-        xCloseEvent.eEventType = eSocketSetDeleteEvent;
-        xCloseEvent.pvData = ( void * ) xSocketSet;
+            if( xReturn == pdFAIL )
+            {
+                ulSocketMemoryRefused++;
+            }
+        }
+        taskEXIT_CRITICAL();
 
-        if( xSendEventStructToIPTask( &xCloseEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
+        if( xReturn == pdFAIL )
         {
-            FreeRTOS_printf( ( "FreeRTOS_DeleteSocketSet: xSendEventStructToIPTask failed\n" ) );
+            FreeRTOS_debug_printf( ( "xSocketMemoryCharge: %u bytes do not fit\n", ( unsigned ) uxBytes ) );
         }
-    }
 
-#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-
 /**
- * @brief Add a socket to a set.
+ * @brief Give back bytes that were counted with xSocketMemoryCharge().
  *
- * @param[in] xSocket The socket being added.
- * @param[in] xSocketSet The socket set being added to.
- * @param[in] xBitsToSet The event bits to set, a combination of the values defined
- *                        in 'eSelectEvent_t', for read, write, exception, etc.
+ * @param[in] uxBytes The number of bytes.
  */
-    void FreeRTOS_FD_SET( Socket_t xSocket,
-                          SocketSet_t xSocketSet,
-                          EventBits_t xBitsToSet )
+    void vSocketMemoryRelease( size_t uxBytes )
     {
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-        SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) xSocketSet;
-
-
-        configASSERT( pxSocket != NULL );
-        configASSERT( xSocketSet != NULL );
-
-        /* Make sure we're not adding bits which are reserved for internal use,
-         * such as eSELECT_CALL_IP */
-        pxSocket->xSelectBits |= xBitsToSet & ( ( EventBits_t ) eSELECT_ALL );
-
-        if( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U )
+        taskENTER_CRITICAL();
         {
-            /* Adding a socket to a socket set. */
-            pxSocket->pxSocketSet = ( SocketSelect_t * ) xSocketSet;
-
-            /* Now have the IP-task call vSocketSelect() to see if the set contains
-             * any sockets which are 'ready' and set the proper bits. */
-            prvFindSelectedSocket( pxSocketSet );
+            ( void ) prvSocketMemoryCount( pdFALSE, uxBytes );
         }
+        taskEXIT_CRITICAL();
     }
-
-#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-
 /**
- * @brief Clear select bits for a socket. If the mask becomes 0,
- *        remove the socket from the set.
+ * @brief Decide whether a packet may be queued to a UDP socket.  Above the
+ *        low watermark, only a socket without waiting packets gets one, so
+ *        that every socket can make progress.  Above the high watermark, all
+ *        packets are dropped.
  *
- * @param[in] xSocket The socket whose select bits are being cleared.
- * @param[in] xSocketSet The socket set of the socket.
- * @param[in] xBitsToClear The bits to be cleared. Every '1' means that the
- *                corresponding bit will be cleared. See 'eSelectEvent_t' for
- *                the possible values.
+ * @param[in] pxSocket The UDP socket.
+ * @param[in] uxBytes The size of the packet.
+ *
+ * @return pdPASS when the packet was counted, pdFAIL when it must be dropped.
  */
-    void FreeRTOS_FD_CLR( Socket_t xSocket,
-                          SocketSet_t xSocketSet,
-                          EventBits_t xBitsToClear )
+    BaseType_t xSocketMemoryAdmitUDP( const FreeRTOS_Socket_t * pxSocket,
+                                      size_t uxBytes )
     {
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-
-        configASSERT( pxSocket != NULL );
-        configASSERT( xSocketSet != NULL );
-
-        pxSocket->xSelectBits &= ~( xBitsToClear & ( ( EventBits_t ) eSELECT_ALL ) );
+        BaseType_t xReturn = pdFAIL;
 
-        if( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U )
+        taskENTER_CRITICAL();
         {
-            pxSocket->pxSocketSet = ( SocketSelect_t * ) xSocketSet;
-        }
-        else
-        {
-            /* disconnect it from the socket set */
-            pxSocket->pxSocketSet = NULL;
-        }
-    }
+            if( ( eSocketMemoryCurrentPressure == eSocketMemoryNormal ) ||
+                ( ( eSocketMemoryCurrentPressure == eSocketMemoryModerate ) &&
+                  ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) == 0U ) ) )
+            {
+                xReturn = prvSocketMemoryCount( pdTRUE, uxBytes );
+            }
 
+            if( xReturn == pdFAIL )
+            {
+                ulSocketMemoryUDPDropped++;
+            }
+        }
+        taskEXIT_CRITICAL();
 
-#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
-
-#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-
 /**
- * @brief Test if a socket belongs to a socket-set and if so, which event bit(s)
- *        are set.
- *
- * @param[in] xSocket The socket of interest.
- * @param[in] xSocketSet The socket set to which the socket belongs.
+ * @brief Return the pressure on the memory budget of the sockets.
  *
- * @return If the socket belongs to the socket set: the event bits, otherwise zero.
+ * @return The pressure.
  */
-    EventBits_t FreeRTOS_FD_ISSET( const ConstSocket_t xSocket,
-                                   const ConstSocketSet_t xSocketSet )
+    eSocketMemoryPressure_t FreeRTOS_GetSocketMemoryPressure( void )
     {
-        EventBits_t xReturn;
-        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-
-        configASSERT( pxSocket != NULL );
-        configASSERT( xSocketSet != NULL );
+        return eSocketMemoryCurrentPressure;
+    }
+/*-----------------------------------------------------------*/
 
-        if( xSocketSet == ( SocketSet_t ) pxSocket->pxSocketSet )
-        {
-            /* Make sure we're not adding bits which are reserved for internal
-             * use. */
-            xReturn = pxSocket->xSocketBits & ( ( EventBits_t ) eSELECT_ALL );
-        }
-        else
+/**
+ * @brief Fill in the use of the memory budget of the sockets.
+ *
+ * @param[out] pxStats Where to store the figures.
+ */
+    void FreeRTOS_GetSocketMemoryStats( SocketMemoryStats_t * pxStats )
+    {
+        if( pxStats != NULL )
         {
-            xReturn = 0;
+            taskENTER_CRITICAL();
+            {
+                pxStats->uxBudget = ( size_t ) ipconfigSOCKET_MEMORY_BUDGET;
+                pxStats->uxUsed = uxSocketMemoryUsed;
+                pxStats->uxPeak = uxSocketMemoryPeak;
+                pxStats->ePressure = eSocketMemoryCurrentPressure;
+                pxStats->ulRefused = ulSocketMemoryRefused;
+                pxStats->ulUDPDropped = ulSocketMemoryUDPDropped;
+            }
+            taskEXIT_CRITICAL();
         }
-
-        return xReturn;
     }
-
-
-#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-
 /**
- * @brief The select() statement: wait for an event to occur on any of the sockets
- *        included in a socket set and return its event bits when the event occurs.
- *
- * @param[in] xSocketSet The socket set including the sockets on which we are
- *                        waiting for an event to occur.
- * @param[in] xBlockTimeTicks Maximum time ticks to wait for an event to occur.
- *                   If the value is 'portMAX_DELAY' then the function will wait
- *                   indefinitely for an event to occur.
+ * @brief Return the number of bytes of streams and queued packets held by
+ *        a socket, as counted in the memory budget.
  *
- * @return The event bits (event flags) value for the socket set in which an
- *          event occurred. If any socket is signalled during the call, using
- *          FreeRTOS_SignalSocket() or FreeRTOS_SignalSocketFromISR(), then eSELECT_INTR
- *          is returned.
+ * @param[in] xSocket The socket.
  *
+ * @return The number of bytes, zero for an invalid socket.
  */
-    BaseType_t FreeRTOS_select( SocketSet_t xSocketSet,
-                                TickType_t xBlockTimeTicks )
+    size_t FreeRTOS_GetSocketMemory( ConstSocket_t xSocket )
     {
-        TimeOut_t xTimeOut;
-        TickType_t xRemainingTime;
-        SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) xSocketSet;
-        EventBits_t uxResult;
-
-        configASSERT( xSocketSet != NULL );
-
-        /* Only in the first round, check for non-blocking */
-        xRemainingTime = xBlockTimeTicks;
-
-        /* Fetch the current time */
-        vTaskSetTimeOutState( &xTimeOut );
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        size_t uxReturn = 0U;
+        const ListItem_t * pxIterator;
+        const ListItem_t * pxEnd;
 
-        for( ; ; )
+        if( ( pxSocket != NULL ) && ( pxSocket != FREERTOS_INVALID_SOCKET ) )
         {
-            /* Find a socket which might have triggered the bit
-             * This function might return immediately or block for a limited time */
-            uxResult = xEventGroupWaitBits( pxSocketSet->xSelectGroup, ( ( EventBits_t ) eSELECT_ALL ), pdFALSE, pdFALSE, xRemainingTime );
-
-            #if ( ipconfigSUPPORT_SIGNALS != 0 )
+            /* The IP-task may add packets or replace a stream meanwhile. */
+            vTaskSuspendAll();
             {
-                if( ( uxResult & ( ( EventBits_t ) eSELECT_INTR ) ) != 0U )
+                if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
                 {
-                    ( void ) xEventGroupClearBits( pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_INTR );
-                    FreeRTOS_debug_printf( ( "FreeRTOS_select: interrupted\n" ) );
-                    break;
-                }
-            }
-            #endif /* ipconfigSUPPORT_SIGNALS */
+                    pxEnd = listGET_END_MARKER( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
 
-            /* Have the IP-task find the socket which had an event */
-            prvFindSelectedSocket( pxSocketSet );
+                    for( pxIterator = listGET_NEXT( pxEnd );
+                         pxIterator != pxEnd;
+                         pxIterator = listGET_NEXT( pxIterator ) )
+                    {
+                        uxReturn += ( ( const NetworkBufferDescriptor_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) )->xDataLength;
+                    }
+                }
 
-            uxResult = xEventGroupGetBits( pxSocketSet->xSelectGroup );
+                #if ( ipconfigUSE_TCP == 1 )
+                    if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+                    {
+                        /* The storage of a static stream is not in the budget. */
+                        if( ( pxSocket->u.xTCP.rxStream != NULL ) &&
+                            ( prvTCPStreamIsStatic( pxSocket, pxSocket->u.xTCP.rxStream ) == pdFALSE ) )
+                        {
+                            uxReturn += sockSTREAM_HEAP_SIZE( pxSocket->u.xTCP.rxStream );
+                        }
 
-            if( uxResult != 0U )
-            {
-                break;
-            }
+                        if( ( pxSocket->u.xTCP.txStream != NULL ) &&
+                            ( prvTCPStreamIsStatic( pxSocket, pxSocket->u.xTCP.txStream ) == pdFALSE ) )
+                        {
+                            uxReturn += sockSTREAM_HEAP_SIZE( pxSocket->u.xTCP.txStream );
+                        }
 
-            /* Has the timeout been reached? */
-            if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
-            {
-                break;
+                        #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+                            if( pxSocket->u.xTCP.pxRetiredStream != NULL )
+                            {
+                                uxReturn += sockSTREAM_HEAP_SIZE( pxSocket->u.xTCP.pxRetiredStream );
+                            }
+                        #endif
+                    }
+                #endif /* ipconfigUSE_TCP */
             }
+            ( void ) xTaskResumeAll();
         }
 
-        return ( BaseType_t ) uxResult;
+        return uxReturn;
     }
 
-
-#endif /* ipconfigSUPPORT_SELECT_FUNCTION */
-/*-----------------------------------------------------------*/
-
-#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+#endif /* ipconfigUSE_SOCKET_MEMORY_BUDGET */
 
 /**
- * @brief Send a message to the IP-task to have it check all sockets belonging to
- *        'pxSocketSet'
+ * @brief Determine the socket size for the given protocol.
  *
- * @param[in] pxSocketSet The socket set being asked to check.
+ * @param[in] xDomain The domain for which the size of socket is being determined.
+ * @param[in] xType Is this a datagram socket or a stream socket.
+ * @param[in] xProtocol The protocol being used.
+ * @param[out] pxSocketSize Pointer to a variable in which the size shall be returned
+ *                           if all checks pass.
+ *
+ * @return pdPASS if socket size was determined and put in the parameter pxSocketSize
+ *         correctly, else pdFAIL.
  */
-    static void prvFindSelectedSocket( SocketSelect_t * pxSocketSet )
-    {
-        IPStackEvent_t xSelectEvent;
+static BaseType_t prvDetermineSocketSize( BaseType_t xDomain,
+                                          BaseType_t xType,
+                                          BaseType_t xProtocol,
+                                          size_t * pxSocketSize )
+{
+    BaseType_t xReturn = pdPASS;
+    FreeRTOS_Socket_t const * pxSocket = NULL;
 
-        #if ( ipconfigSELECT_USES_NOTIFY != 0 )
-            SocketSelectMessage_t xSelectMessage;
-        #endif
+    /* Asserts must not appear before it has been determined that the network
+     * task is ready - otherwise the asserts will fail. */
+    if( xIPIsNetworkTaskReady() == pdFALSE )
+    {
+        xReturn = pdFAIL;
+    }
+    else
+    {
+        /* Only Ethernet is currently supported. */
+        #if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 == 0 ) )
+        {
+            if( xDomain != FREERTOS_AF_INET )
+            {
+                xReturn = pdFAIL;
+            }
 
-        xSelectEvent.eEventType = eSocketSelectEvent;
-        #if ( ipconfigSELECT_USES_NOTIFY != 0 )
+            configASSERT( xDomain == FREERTOS_AF_INET );
+        }
+        #elif ( ( ipconfigUSE_IPv4 == 0 ) && ( ipconfigUSE_IPv6 != 0 ) )
         {
-            xSelectMessage.pxSocketSet = pxSocketSet;
-            xSelectMessage.xTaskhandle = xTaskGetCurrentTaskHandle();
-            xSelectEvent.pvData = &( xSelectMessage );
+            if( xDomain != FREERTOS_AF_INET6 )
+            {
+                xReturn = pdFAIL;
+            }
+
+            configASSERT( xDomain == FREERTOS_AF_INET6 );
         }
-        #else
+        #else /* if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 == 0 ) ) */
         {
-            xSelectEvent.pvData = pxSocketSet;
+            if( ( xDomain != FREERTOS_AF_INET ) && ( xDomain != FREERTOS_AF_INET6 ) )
+            {
+                xReturn = pdFAIL;
+            }
 
-            /* while the IP-task works on the request, the API will block on
-             * 'eSELECT_CALL_IP'.  So clear it first. */
-            ( void ) xEventGroupClearBits( pxSocketSet->xSelectGroup, ( BaseType_t ) eSELECT_CALL_IP );
+            configASSERT( ( xDomain == FREERTOS_AF_INET ) || ( xDomain == FREERTOS_AF_INET6 ) );
         }
-        #endif /* if ( ipconfigSELECT_USES_NOTIFY != 0 ) */
+        #endif /* if ( ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 == 0 ) ) */
 
-        /* Now send the socket select event */
-        if( xSendEventStructToIPTask( &xSelectEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
+        /* Check if the UDP socket-list has been initialised. */
+        configASSERT( listLIST_IS_INITIALISED( &xBoundUDPSocketsList ) );
+        #if ( ipconfigUSE_TCP == 1 )
         {
-            /* Oops, we failed to wake-up the IP task. No use to wait for it. */
-            FreeRTOS_debug_printf( ( "prvFindSelectedSocket: failed\n" ) );
+            /* Check if the TCP socket-list has been initialised. */
+            configASSERT( listLIST_IS_INITIALISED( &xBoundTCPSocketsList ) );
         }
-        else
+        #endif /* ipconfigUSE_TCP == 1 */
+
+        if( xProtocol == FREERTOS_IPPROTO_UDP )
         {
-            /* As soon as the IP-task is ready, it will set 'eSELECT_CALL_IP' to
-             * wakeup the calling API */
-            #if ( ipconfigSELECT_USES_NOTIFY != 0 )
+            if( xType != FREERTOS_SOCK_DGRAM )
             {
-                ( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+                xReturn = pdFAIL;
+                configASSERT( xReturn == pdPASS ); /* LCOV_EXCL_BR_LINE Exclude this line from branch coverage as the not-taken condition will never happen. */
             }
-            #else
+
+            /* In case a UDP socket is created, do not allocate space for TCP data. */
+            *pxSocketSize = ( sizeof( *pxSocket ) - sizeof( pxSocket->u ) ) + sizeof( pxSocket->u.xUDP );
+        }
+
+        #if ( ipconfigUSE_TCP == 1 )
+            else if( xProtocol == FREERTOS_IPPROTO_TCP )
             {
-                ( void ) xEventGroupWaitBits( pxSocketSet->xSelectGroup, ( BaseType_t ) eSELECT_CALL_IP, pdTRUE, pdFALSE, portMAX_DELAY );
+                if( xType != FREERTOS_SOCK_STREAM )
+                {
+                    xReturn = pdFAIL;
+                    configASSERT( xReturn == pdPASS ); /* LCOV_EXCL_BR_LINE Exclude this line from branch coverage as the not-taken condition will never happen. */
+                }
+
+                *pxSocketSize = ( sizeof( *pxSocket ) - sizeof( pxSocket->u ) ) + sizeof( pxSocket->u.xTCP );
             }
-            #endif
+        #endif /* ipconfigUSE_TCP == 1 */
+        else
+        {
+            xReturn = pdFAIL;
+            configASSERT( xReturn == pdPASS ); /* LCOV_EXCL_BR_LINE Exclude this line from branch coverage as the not-taken condition will never happen. */
         }
     }
 
+    /* In case configASSERT() is not used */
+    ( void ) xDomain;
+    ( void ) pxSocket; /* Was only used for sizeof. */
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
 
-#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
+/**
+ * @brief Called by FreeRTOS_socket(), it will initialise some essential TCP
+ *        fields in the socket.
+ * @param[in] pxSocket the TCP socket to be initialised.
+ * @param[in] uxSocketSize The calculated size of the socket, only used to
+ *                          gather memory usage statistics.
+ */
+    static void prvInitialiseTCPFields( FreeRTOS_Socket_t * pxSocket,
+                                        size_t uxSocketSize )
+    {
+        ( void ) uxSocketSize;
+        /* Lint wants at least a comment, in case the macro is empty. */
+        iptraceMEM_STATS_CREATE( tcpSOCKET_TCP, pxSocket, uxSocketSize + socketEVENT_GROUP_SIZE );
+        /* StreamSize is expressed in number of bytes */
+        /* Round up buffer sizes to nearest multiple of MSS */
+        pxSocket->u.xTCP.usMSS = ( uint16_t ) ipconfigTCP_MSS;
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            if( pxSocket->bits.bIsIPv6 != 0U )
+            {
+                uint16_t usDifference = ipSIZE_OF_IPv6_HEADER - ipSIZE_OF_IPv4_HEADER;
+
+                /* Because ipconfigTCP_MSS is guaranteed not less than tcpMINIMUM_SEGMENT_LENGTH by FreeRTOSIPConfigDefaults.h,
+                 * it's unnecessary to check if xSocket->u.xTCP.usMSS is greater than difference. */
+                pxSocket->u.xTCP.usMSS = ( uint16_t ) ( pxSocket->u.xTCP.usMSS - usDifference );
+            }
+        #endif /* ipconfigUSE_IPv6 != 0 */
+
+        pxSocket->u.xTCP.uxRxStreamSize = ( size_t ) ipconfigTCP_RX_BUFFER_LENGTH;
+        pxSocket->u.xTCP.uxTxStreamSize = ( size_t ) FreeRTOS_round_up( ipconfigTCP_TX_BUFFER_LENGTH, ipconfigTCP_MSS );
+        /* Use half of the buffer size of the TCP windows */
+        #if ( ipconfigUSE_TCP_WIN == 1 )
+        {
+            pxSocket->u.xTCP.uxRxWinSize = FreeRTOS_max_size_t( 1U, ( pxSocket->u.xTCP.uxRxStreamSize / 2U ) / ipconfigTCP_MSS );
+            pxSocket->u.xTCP.uxTxWinSize = FreeRTOS_max_size_t( 1U, ( pxSocket->u.xTCP.uxTxStreamSize / 2U ) / ipconfigTCP_MSS );
+        }
+        #else
+        {
+            pxSocket->u.xTCP.uxRxWinSize = 1U;
+            pxSocket->u.xTCP.uxTxWinSize = 1U;
+        }
+        #endif
+
+        /* The above values are just defaults, and can be overridden by
+         * calling FreeRTOS_setsockopt().  No buffers will be allocated until a
+         * socket is connected and data is exchanged. */
+
+        #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
+        {
+            vListInitialiseItem( &( pxSocket->u.xTCP.xTimerListItem ) );
+            listSET_LIST_ITEM_OWNER( &( pxSocket->u.xTCP.xTimerListItem ), ( void * ) pxSocket );
+            vListInitialiseItem( &( pxSocket->u.xTCP.xWakeUpListItem ) );
+            listSET_LIST_ITEM_OWNER( &( pxSocket->u.xTCP.xWakeUpListItem ), ( void * ) pxSocket );
+            vListInitialiseItem( &( pxSocket->u.xTCP.xRescheduleListItem ) );
+            listSET_LIST_ITEM_OWNER( &( pxSocket->u.xTCP.xRescheduleListItem ), ( void * ) pxSocket );
+        }
+        #endif /* ipconfigUSE_TCP_TIMER_WHEEL */
+
+        #if ( ipconfigTCP_ACCEPT_QUEUE != 0 )
+        {
+            vListInitialise( &( pxSocket->u.xTCP.xAcceptQueue ) );
+            vListInitialiseItem( &( pxSocket->u.xTCP.xAcceptListItem ) );
+            listSET_LIST_ITEM_OWNER( &( pxSocket->u.xTCP.xAcceptListItem ), ( void * ) pxSocket );
+        }
+        #endif /* ipconfigTCP_ACCEPT_QUEUE */
+    }
+#endif /* ( ipconfigUSE_TCP == 1 ) */
 /*-----------------------------------------------------------*/
 
 /**
- * @brief : called from FreeRTOS_recvfrom(). This function waits for an incoming
- *          UDP packet, or until a time-out occurs.
- * @param[in] pxSocket  The socket that receives UDP packets.
- * @param[in] xFlags  The flags as passed to FreeRTOS_recvfrom().
- * @param[in,out] pxEventBits  The last even received in this function,
- *                              either eSOCKET_INTR or eSOCKET_RECEIVE.
+ * @brief allocate and initialise a socket.
+ *
+ * @param[in] xDomain The domain in which the socket should be created.
+ * @param[in] xType The type of the socket.
+ * @param[in] xProtocol The protocol of the socket.
+ *
+ * @return FREERTOS_INVALID_SOCKET if the allocation failed, or if there was
+ *         a parameter error, otherwise a valid socket.
  */
-static NetworkBufferDescriptor_t * prvRecvFromWaitForPacket( FreeRTOS_Socket_t const * pxSocket,
-                                                             BaseType_t xFlags,
-                                                             EventBits_t * pxEventBits )
+Socket_t FreeRTOS_socket( BaseType_t xDomain,
+                          BaseType_t xType,
+                          BaseType_t xProtocol )
 {
-    BaseType_t xTimed = pdFALSE;
-    TickType_t xRemainingTime = pxSocket->xReceiveBlockTime;
-    BaseType_t lPacketCount;
-    TimeOut_t xTimeOut;
-    EventBits_t xEventBits = ( EventBits_t ) 0;
-    NetworkBufferDescriptor_t * pxNetworkBuffer = NULL;
+    return prvSocketCreate( xDomain, xType, xProtocol, NULL );
+}
+/*-----------------------------------------------------------*/
 
-    lPacketCount = ( BaseType_t ) listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
+#if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
 
-    while( lPacketCount == 0 )
+/**
+ * @brief Create a socket in memory provided by the application, see
+ *        xTaskCreateStatic() for the same idea.  The memory must remain
+ *        valid until the IP-task has closed the socket.
+ *
+ * @param[in] xDomain The domain in which the socket should be created.
+ * @param[in] xType The type of the socket.
+ * @param[in] xProtocol The protocol of the socket.
+ * @param[in] pxSocketBuffer The memory of the socket and its event group.
+ * @param[in] pucRxStorage Storage for the reception stream of a TCP socket,
+ *                         aligned to a size_t, or NULL to allocate it.
+ * @param[in] uxRxStorageSize The size of 'pucRxStorage' in bytes.
+ * @param[in] pucTxStorage Storage for the transmission stream of a TCP socket,
+ *                         aligned to a size_t, or NULL to allocate it.
+ * @param[in] uxTxStorageSize The size of 'pucTxStorage' in bytes.
+ *
+ * @return FREERTOS_INVALID_SOCKET in case of a parameter error, otherwise
+ *         a valid socket.
+ */
+    Socket_t FreeRTOS_socket_static( BaseType_t xDomain,
+                                     BaseType_t xType,
+                                     BaseType_t xProtocol,
+                                     StaticSocket_t * pxSocketBuffer,
+                                     uint8_t * pucRxStorage,
+                                     size_t uxRxStorageSize,
+                                     uint8_t * pucTxStorage,
+                                     size_t uxTxStorageSize )
     {
-        if( xTimed == pdFALSE )
+        Socket_t xReturn = FREERTOS_INVALID_SOCKET;
+        size_t uxRxSize = 0U;
+        size_t uxTxSize = 0U;
+        BaseType_t xValid = pdTRUE;
+
+        if( pxSocketBuffer == NULL )
         {
-            /* Check to see if the socket is non blocking on the first
-             * iteration.  */
-            if( xRemainingTime == ( TickType_t ) 0 )
+            xValid = pdFALSE;
+        }
+
+        #if ( ipconfigUSE_TCP == 1 )
+        {
+            if( pucRxStorage != NULL )
             {
-                #if ( ipconfigSUPPORT_SIGNALS != 0 )
+                uxRxSize = prvStaticStreamPrepare( pucRxStorage, uxRxStorageSize );
+
+                if( uxRxSize == 0U )
                 {
-                    /* Just check for the interrupt flag. */
-                    xEventBits = xEventGroupWaitBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_INTR,
-                                                      pdTRUE /*xClearOnExit*/, pdFALSE /*xWaitAllBits*/, socketDONT_BLOCK );
+                    xValid = pdFALSE;
                 }
-                #endif /* ipconfigSUPPORT_SIGNALS */
-                break;
             }
 
-            if( ( ( ( UBaseType_t ) xFlags ) & ( ( UBaseType_t ) FREERTOS_MSG_DONTWAIT ) ) != 0U )
+            if( pucTxStorage != NULL )
             {
-                break;
-            }
-
-            /* To ensure this part only executes once. */
-            xTimed = pdTRUE;
-
-            /* Fetch the current time. */
-            vTaskSetTimeOutState( &xTimeOut );
-        }
-
-        /* Wait for arrival of data.  While waiting, the IP-task may set the
-         * 'eSOCKET_RECEIVE' bit in 'xEventGroup', if it receives data for this
-         * socket, thus unblocking this API call. */
-        xEventBits = xEventGroupWaitBits( pxSocket->xEventGroup, ( ( EventBits_t ) eSOCKET_RECEIVE ) | ( ( EventBits_t ) eSOCKET_INTR ),
-                                          pdTRUE /*xClearOnExit*/, pdFALSE /*xWaitAllBits*/, xRemainingTime );
+                uxTxSize = prvStaticStreamPrepare( pucTxStorage, uxTxStorageSize );
 
-        #if ( ipconfigSUPPORT_SIGNALS != 0 )
-        {
-            if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
-            {
-                if( ( xEventBits & ( EventBits_t ) eSOCKET_RECEIVE ) != 0U )
+                if( uxTxSize == 0U )
                 {
-                    /* Shouldn't have cleared the eSOCKET_RECEIVE flag. */
-                    ( void ) xEventGroupSetBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_RECEIVE );
+                    xValid = pdFALSE;
                 }
-
-                break;
             }
         }
-        #else /* if ( ipconfigSUPPORT_SIGNALS != 0 ) */
+        #else
         {
-            ( void ) xEventBits;
+            ( void ) uxRxStorageSize;
+            ( void ) uxTxStorageSize;
         }
-        #endif /* ipconfigSUPPORT_SIGNALS */
-
-        lPacketCount = ( BaseType_t ) listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
+        #endif /* ipconfigUSE_TCP == 1 */
 
-        if( lPacketCount != 0 )
+        if( xValid != pdFALSE )
         {
-            break;
+            xReturn = prvSocketCreate( xDomain, xType, xProtocol, pxSocketBuffer );
         }
 
-        /* Has the timeout been reached ? */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
+        if( xReturn != FREERTOS_INVALID_SOCKET )
         {
-            break;
-        }
-    } /* while( lPacketCount == 0 ) */
-
-    if( lPacketCount > 0 )
-    {
-        vTaskSuspendAll();
-        {
-            /* The owner of the list item is the network buffer. */
-            pxNetworkBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) );
+            #if ( ipconfigUSE_TCP == 1 )
+                FreeRTOS_Socket_t * pxSocket = xReturn;
 
-            if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_MSG_PEEK ) == 0U )
-            {
-                /* Remove the network buffer from the list of buffers waiting to
-                 * be processed by the socket. */
-                ( void ) uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
-            }
-        }
-        ( void ) xTaskResumeAll();
-    }
+                if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) &&
+                    ( ( pucRxStorage != NULL ) || ( pucTxStorage != NULL ) ) )
+                {
+                    if( pucRxStorage != NULL )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        pxSocket->u.xTCP.pxStaticRxStream = ( ( StreamBuffer_t * ) pucRxStorage );
+                        pxSocket->u.xTCP.uxRxStreamSize = uxRxSize;
+                    }
 
-    *pxEventBits = xEventBits;
+                    if( pucTxStorage != NULL )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        pxSocket->u.xTCP.pxStaticTxStream = ( ( StreamBuffer_t * ) pucTxStorage );
+                        pxSocket->u.xTCP.uxTxStreamSize = uxTxSize;
+                    }
 
-    return pxNetworkBuffer;
-}
-/*-----------------------------------------------------------*/
+                    #if ( ipconfigUSE_TCP_WIN == 1 )
+                    {
+                        pxSocket->u.xTCP.uxRxWinSize = FreeRTOS_max_size_t( 1U, ( pxSocket->u.xTCP.uxRxStreamSize / 2U ) / ipconfigTCP_MSS );
+                        pxSocket->u.xTCP.uxTxWinSize = FreeRTOS_max_size_t( 1U, ( pxSocket->u.xTCP.uxTxStreamSize / 2U ) / ipconfigTCP_MSS );
+                    }
+                    #endif
 
-/**
- * @brief Called by FreeRTOS_recvfrom(). it will copy the received data
- *        or just a pointer to the received data in case of zero-copy,
- *        to the buffer provided by the caller.
- * @param[in] pucEthernetBuffer The packet that was received.
- * @param[in] pvBuffer The user-supplied buffer.
- * @param[in] uxBufferLength The size of the user-supplied buffer.
- * @param[in] xFlags Only 'FREERTOS_ZERO_COPY' will be tested.
- * @param[in] lDataLength The number of bytes in the UDP payload.
- * @return The number of bytes copied to the use buffer.
- */
-static int32_t prvRecvFrom_CopyPacket( uint8_t * pucEthernetBuffer,
-                                       void * pvBuffer,
-                                       size_t uxBufferLength,
-                                       BaseType_t xFlags,
-                                       int32_t lDataLength )
-{
-    int32_t lReturn = lDataLength;
-    const void * pvCopySource;
+                    #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+                    {
+                        /* The size of the storage is fixed. */
+                        pxSocket->u.xTCP.bits.bNoAutoTune = pdTRUE_UNSIGNED;
+                    }
+                    #endif
 
-    if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U )
-    {
-        /* The zero copy flag is not set.  Truncate the length if it won't
-         * fit in the provided buffer. */
-        if( lReturn > ( int32_t ) uxBufferLength )
-        {
-            iptraceRECVFROM_DISCARDING_BYTES( ( uxBufferLength - lReturn ) );
-            lReturn = ( int32_t ) uxBufferLength;
+                    #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+                    {
+                        pxSocket->u.xTCP.bits.bFixedSizes = pdTRUE_UNSIGNED;
+                    }
+                    #endif
+                }
+            #endif /* ipconfigUSE_TCP == 1 */
         }
 
-        /* Copy the received data into the provided buffer, then release the
-         * network buffer. */
-        pvCopySource = ( const void * ) pucEthernetBuffer;
-        ( void ) memcpy( pvBuffer, pvCopySource, ( size_t ) lReturn );
-    }
-    else
-    {
-        /* The zero copy flag was set.  pvBuffer is not a buffer into which
-         * the received data can be copied, but a pointer that must be set to
-         * point to the buffer in which the received data has already been
-         * placed. */
-        *( ( void ** ) pvBuffer ) = ( void * ) pucEthernetBuffer;
+        return xReturn;
     }
-
-    return lReturn;
-}
+#endif /* ipconfigSUPPORT_STATIC_SOCKETS */
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Receive data from a bound socket. In this library, the function
- *        can only be used with connection-less sockets (UDP). For TCP sockets,
- *        please use FreeRTOS_recv().
+ * @brief Allocate and initialise a socket, or initialise a socket in the
+ *        memory provided by the application.
  *
- * @param[in] xSocket The socket to which the data is sent i.e. the
- *                     listening socket.
- * @param[out] pvBuffer The buffer in which the data being received is to
- *                      be stored.
- * @param[in] uxBufferLength The length of the buffer.
- * @param[in] xFlags The flags to indicate preferences while calling this function.
- * @param[out] pxSourceAddress The source address from which the data is being sent.
- * @param[out] pxSourceAddressLength The length of the source address structure.
- *                  This would always be a constant - 24 (in case of no error) as
- *                  FreeRTOS+TCP makes the sizes of IPv4 and IPv6 structures equal
- *                  (24-bytes) for compatibility.
+ * @param[in] xDomain The domain in which the socket should be created.
+ * @param[in] xType The type of the socket.
+ * @param[in] xProtocol The protocol of the socket.
+ * @param[in] pxSocketBuffer The memory of a static socket, or NULL.
  *
- * @return The number of bytes received. Or else, an error code is returned. When it
- *         returns a negative value, the cause can be looked-up in 'FreeRTOS-Kernel/projdefs.h'.
+ * @return FREERTOS_INVALID_SOCKET if the allocation failed, or if there was
+ *         a parameter error, otherwise a valid socket.
  */
-int32_t FreeRTOS_recvfrom( const ConstSocket_t xSocket,
-                           void * pvBuffer,
-                           size_t uxBufferLength,
-                           BaseType_t xFlags,
-                           struct freertos_sockaddr * pxSourceAddress,
-                           socklen_t * pxSourceAddressLength )
+static Socket_t prvSocketCreate( BaseType_t xDomain,
+                                 BaseType_t xType,
+                                 BaseType_t xProtocol,
+                                 StaticSocket_t * pxSocketBuffer )
 {
-    NetworkBufferDescriptor_t * pxNetworkBuffer;
-    FreeRTOS_Socket_t const * pxSocket = xSocket;
-    int32_t lReturn = 0;
-    EventBits_t xEventBits = ( EventBits_t ) 0;
-    size_t uxPayloadOffset = 0;
-    size_t uxPayloadLength;
-    socklen_t xAddressLength;
+    FreeRTOS_Socket_t * pxSocket;
 
-    if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_UDP, pdTRUE ) == pdFALSE )
-    {
-        lReturn = -pdFREERTOS_ERRNO_EINVAL;
-    }
-    else
-    {
-        /* The function prototype is designed to maintain the expected Berkeley
-         * sockets standard, but this implementation does not use all the parameters. */
-        ( void ) pxSourceAddressLength;
+/* Note that this value will be over-written by the call to prvDetermineSocketSize. */
+    size_t uxSocketSize = 1;
+    #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+        EventGroupHandle_t xEventGroup;
+    #endif
+    Socket_t xReturn;
+    BaseType_t xProtocolCpy = xProtocol;
 
-        pxNetworkBuffer = prvRecvFromWaitForPacket( pxSocket, xFlags, &( xEventBits ) );
+    configASSERT( ( xDomain == FREERTOS_AF_INET6 ) || ( xDomain == FREERTOS_AF_INET ) );
 
-        if( pxNetworkBuffer != NULL )
+    /* Introduce a do-while loop to allow use of break statements. */
+    do
+    {
+        /* The special protocol FREERTOS_SOCK_DEPENDENT_PROTO, which is equivalent
+         * to passing 0 as defined by POSIX, indicates to the socket layer that it
+         * should pick a sensible default protocol based off the given socket type.
+         * If we can't, prvDetermineSocketSize will catch it as an invalid
+         * type/protocol combo.
+         */
+        if( xProtocol == FREERTOS_SOCK_DEPENDENT_PROTO )
         {
-            do
+            switch( xType )
             {
-                switch( uxIPHeaderSizePacket( pxNetworkBuffer ) )
-                {
-                    #if ( ipconfigUSE_IPv4 != 0 )
-                        case ipSIZE_OF_IPv4_HEADER:
-                            uxPayloadOffset = xRecv_Update_IPv4( pxNetworkBuffer, pxSourceAddress );
-                            break;
-                    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
-
-                    #if ( ipconfigUSE_IPv6 != 0 )
-                        case ipSIZE_OF_IPv6_HEADER:
-                            uxPayloadOffset = xRecv_Update_IPv6( pxNetworkBuffer, pxSourceAddress );
-                            break;
-                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
-
-                    default:
-                        /* MISRA 16.4 Compliance */
-                        lReturn = -pdFREERTOS_ERRNO_EINVAL;
-                        break;
-                }
+                case FREERTOS_SOCK_DGRAM:
+                    xProtocolCpy = FREERTOS_IPPROTO_UDP;
+                    break;
 
-                if( lReturn < 0 )
-                {
+                case FREERTOS_SOCK_STREAM:
+                    xProtocolCpy = FREERTOS_IPPROTO_TCP;
                     break;
-                }
 
-                xAddressLength = sizeof( struct freertos_sockaddr );
+                default:
 
-                if( pxSourceAddressLength != NULL )
-                {
-                    *pxSourceAddressLength = xAddressLength;
-                }
+                    /* incorrect xType. this will be caught by
+                     * prvDetermineSocketSize.
+                     */
+                    break;
+            }
+        }
 
-                /* The returned value is the length of the payload data, which is
-                 * calculated at the total packet size minus the headers.
-                 * The validity of `xDataLength` prvProcessIPPacket has been confirmed
-                 * in 'prvProcessIPPacket()'. */
-                uxPayloadLength = pxNetworkBuffer->xDataLength - uxPayloadOffset;
-                lReturn = ( int32_t ) uxPayloadLength;
+        if( prvDetermineSocketSize( xDomain, xType, xProtocolCpy, &uxSocketSize ) == pdFAIL )
+        {
+            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
+            /* coverity[misra_c_2012_rule_11_4_violation] */
+            xReturn = FREERTOS_INVALID_SOCKET;
+            break;
+        }
 
-                lReturn = prvRecvFrom_CopyPacket( &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] ), pvBuffer, uxBufferLength, xFlags, lReturn );
-            } while( ipFALSE_BOOL );
+        /* Allocate the structure that will hold the socket information. The
+        * size depends on the type of socket: UDP sockets need less space. A
+        * define 'pvPortMallocSocket' will used to allocate the necessary space.
+        * By default it points to the FreeRTOS function 'pvPortMalloc()'. */
 
-            if( ( ( ( UBaseType_t ) xFlags & ( ( ( UBaseType_t ) FREERTOS_MSG_PEEK ) | ( ( UBaseType_t ) FREERTOS_ZERO_COPY ) ) ) == 0U ) ||
-                ( lReturn < 0 ) )
+        #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+            if( pxSocketBuffer != NULL )
             {
-                vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+                pxSocket = &( pxSocketBuffer->xSocket );
             }
+            else
+        #endif
+        {
+            /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
+            /* coverity[misra_c_2012_directive_4_12_violation] */
+            pxSocket = ( ( FreeRTOS_Socket_t * ) pvPortMallocSocket( uxSocketSize ) );
         }
 
-        #if ( ipconfigSUPPORT_SIGNALS != 0 )
-            else if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
-            {
-                lReturn = -pdFREERTOS_ERRNO_EINTR;
-                iptraceRECVFROM_INTERRUPTED();
-            }
-        #endif /* ipconfigSUPPORT_SIGNALS */
-        else
+        if( pxSocket == NULL )
         {
-            lReturn = -pdFREERTOS_ERRNO_EWOULDBLOCK;
-            iptraceRECVFROM_TIMEOUT();
+            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
+            /* coverity[misra_c_2012_rule_11_4_violation] */
+            xReturn = FREERTOS_INVALID_SOCKET;
+            iptraceFAILED_TO_CREATE_SOCKET();
+            break;
         }
-    }
 
-    return lReturn;
-}
-/*-----------------------------------------------------------*/
+        #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+            #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+                if( pxSocketBuffer != NULL )
+                {
+                    xEventGroup = xEventGroupCreateStatic( &( pxSocketBuffer->xEventGroup ) );
+                }
+                else
+            #endif
+            {
+                xEventGroup = xEventGroupCreate();
+            }
 
-/**
- * @brief Check if a socket is a valid UDP socket. In case it is not
- *        yet bound, bind it to port 0 ( random port ).
- * @param[in] pxSocket The socket that must be bound to a port number.
- * @return Returns pdTRUE if the socket was already bound, or if the
- *         socket has been bound successfully.
- */
-static BaseType_t prvMakeSureSocketIsBound( FreeRTOS_Socket_t * pxSocket )
-{
-    /* Check if this is a valid UDP socket, does not have to be bound yet. */
-    BaseType_t xReturn = prvValidSocket( pxSocket, FREERTOS_IPPROTO_UDP, pdFALSE );
+            if( xEventGroup == NULL )
+            {
+                if( pxSocketBuffer == NULL )
+                {
+                    vPortFreeSocket( pxSocket );
+                }
 
-    if( ( xReturn == pdTRUE ) && ( !socketSOCKET_IS_BOUND( pxSocket ) ) )
-    {
-        /* The socket is valid but it is not yet bound. */
-        if( FreeRTOS_bind( pxSocket, NULL, 0U ) != 0 )
+                /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
+                /* coverity[misra_c_2012_rule_11_4_violation] */
+                xReturn = FREERTOS_INVALID_SOCKET;
+                iptraceFAILED_TO_CREATE_EVENT_GROUP();
+            }
+            else
+        #endif /* ipconfigSOCKET_USES_NOTIFY == 0 */
         {
-            /* The socket was not yet bound, and binding it has failed. */
-            xReturn = pdFALSE;
-        }
-    }
+            /* Clear the entire space to avoid nulling individual entries. */
+            ( void ) memset( pxSocket, 0, uxSocketSize );
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+            #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+            {
+                pxSocket->xEventGroup = xEventGroup;
+            }
+            #endif
 
+            if( pxSocketBuffer == NULL )
+            {
+                ipRESOURCE_ALLOC( eResourceSocket, uxSocketSize + socketEVENT_GROUP_SIZE );
+            }
 
-/**
- * @brief Forward a UDP packet to the IP-task, so it will be sent.
- * @param[in] pxSocket  The socket on which a packet is sent.
- * @param[in] pxNetworkBuffer  The packet to be sent.
- * @param[in] uxTotalDataLength  The total number of payload bytes in the packet.
- * @param[in] xFlags  The flag 'FREERTOS_ZERO_COPY' will be checked.
- * @param[in] pxDestinationAddress  The address of the destination.
- * @param[in] xTicksToWait  Number of ticks to wait, in case the IP-queue is full.
- * @param[in] uxPayloadOffset  The number of bytes in the packet before the payload.
- * @return The number of bytes sent on success, otherwise zero.
- */
-static int32_t prvSendUDPPacket( const FreeRTOS_Socket_t * pxSocket,
-                                 NetworkBufferDescriptor_t * pxNetworkBuffer,
-                                 size_t uxTotalDataLength,
-                                 BaseType_t xFlags,
-                                 const struct freertos_sockaddr * pxDestinationAddress,
-                                 TickType_t xTicksToWait,
-                                 size_t uxPayloadOffset )
-{
-    int32_t lReturn = 0;
-    IPStackEvent_t xStackTxEvent = { eStackTxEvent, NULL };
+            #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+            {
+                pxSocket->bits.bStaticSocket = ( pxSocketBuffer != NULL ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+            }
+            #endif
 
-    switch( pxDestinationAddress->sin_family ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is checked before calling. */
-    {
-        #if ( ipconfigUSE_IPv6 != 0 )
-            case FREERTOS_AF_INET6:
-                ( void ) xSend_UDP_Update_IPv6( pxNetworkBuffer, pxDestinationAddress );
-                break;
-        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+            switch( xDomain ) /* LCOV_EXCL_BR_LINE Exclude this because domain is checked at the begin of this function. */
+            {
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    case FREERTOS_AF_INET6:
+                        pxSocket->bits.bIsIPv6 = pdTRUE_UNSIGNED;
+                        break;
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
-        #if ( ipconfigUSE_IPv4 != 0 )
-            case FREERTOS_AF_INET4:
-                ( void ) xSend_UDP_Update_IPv4( pxNetworkBuffer, pxDestinationAddress );
-                break;
-        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    case FREERTOS_AF_INET:
+                        pxSocket->bits.bIsIPv6 = pdFALSE_UNSIGNED;
+                        break;
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
-        default:   /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
-            /* MISRA 16.4 Compliance */
-            break; /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
-    }
+                default: /* LCOV_EXCL_LINE Exclude this because domain is checked at the begin of this function. */
+                    FreeRTOS_debug_printf( ( "FreeRTOS_socket: Undefined xDomain \n" ) );
 
-    pxNetworkBuffer->xDataLength = uxTotalDataLength + uxPayloadOffset;
-    pxNetworkBuffer->usPort = pxDestinationAddress->sin_port;
-    pxNetworkBuffer->usBoundPort = ( uint16_t ) socketGET_SOCKET_PORT( pxSocket );
+                    /* MISRA 16.4 Compliance */
+                    break; /* LCOV_EXCL_LINE Exclude this because domain is checked at the begin of this function. */
+            }
 
-    /* The socket options are passed to the IP layer in the
-     * space that will eventually get used by the Ethernet header. */
-    pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_OPTIONS_OFFSET ] = pxSocket->ucSocketOptions;
+            /* Initialise the socket's members.  The semaphore will be created
+             * if the socket is bound to an address, for now the pointer to the
+             * semaphore is just set to NULL to show it has not been created. */
+            if( xProtocolCpy == FREERTOS_IPPROTO_UDP )
+            {
+                iptraceMEM_STATS_CREATE( tcpSOCKET_UDP, pxSocket, uxSocketSize + socketEVENT_GROUP_SIZE );
 
-    /* Tell the networking task that the packet needs sending. */
-    xStackTxEvent.pvData = pxNetworkBuffer;
+                vListInitialise( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
 
-    /* Ask the IP-task to send this packet */
-    if( xSendEventStructToIPTask( &xStackTxEvent, xTicksToWait ) == pdPASS )
-    {
-        /* The packet was successfully sent to the IP task. */
-        lReturn = ( int32_t ) uxTotalDataLength;
-        #if ( ipconfigUSE_CALLBACKS == 1 )
-        {
-            if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xUDP.pxHandleSent ) )
+                #if ( ipconfigUDP_MAX_RX_PACKETS > 0U )
+                {
+                    pxSocket->u.xUDP.uxMaxPackets = ( UBaseType_t ) ipconfigUDP_MAX_RX_PACKETS;
+                    pxSocket->u.xUDP.xDropOldest = pdFALSE;
+                }
+                #endif /* ipconfigUDP_MAX_RX_PACKETS > 0 */
+            }
+
+            #if ( ipconfigUSE_TCP == 1 )
+                else if( xProtocolCpy == FREERTOS_IPPROTO_TCP ) /* LCOV_EXCL_BR_LINE Exclude else case because protocol is checked in prvDetermineSocketSize */
+                {
+                    prvInitialiseTCPFields( pxSocket, uxSocketSize );
+                }
+                else
+                {
+                    /* MISRA wants to see an unconditional else clause. */
+                }
+            #endif /* ipconfigUSE_TCP == 1 */
+
+            vListInitialiseItem( &( pxSocket->xBoundSocketListItem ) );
+            listSET_LIST_ITEM_OWNER( &( pxSocket->xBoundSocketListItem ), ( void * ) pxSocket );
+
+            #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
             {
-                pxSocket->u.xUDP.pxHandleSent( ( FreeRTOS_Socket_t * ) pxSocket, uxTotalDataLength );
+                vListInitialiseItem( &( pxSocket->xHashListItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxSocket->xHashListItem ), ( void * ) pxSocket );
             }
-        }
-        #endif /* ipconfigUSE_CALLBACKS */
-    }
-    else
-    {
-        /* If the buffer was allocated in this function, release
-         * it. */
-        if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U )
-        {
-            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
-        }
+            #endif
 
-        iptraceSTACK_TX_EVENT_LOST( ipSTACK_TX_EVENT );
-    }
+            #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+            {
+                vListInitialiseItem( &( pxSocket->xReadyListItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxSocket->xReadyListItem ), ( void * ) pxSocket );
+            }
+            #endif
 
-    return lReturn;
+            pxSocket->xReceiveBlockTime = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
+            pxSocket->xSendBlockTime = ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME;
+            pxSocket->ucSocketOptions = ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT;
+            pxSocket->ucProtocol = ( uint8_t ) xProtocolCpy; /* protocol: UDP or TCP */
+
+            xReturn = pxSocket;
+        }
+    } while( ipFALSE_BOOL );
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+
 /**
- * @brief Called by FreeRTOS_sendto(), it will actually send a UDP packet.
- * @param[in] pxSocket The socket used for sending.
- * @param[in] pvBuffer The character buffer as provided by the caller.
- * @param[in] uxTotalDataLength The number of byte in the buffer.
- * @param[in] xFlags The flags that were passed to FreeRTOS_sendto()
- *                    It will test for FREERTOS_MSG_DONTWAIT and for
- *                    FREERTOS_ZERO_COPY.
- * @param[in] pxDestinationAddress The IP-address to which the packet must be sent.
- * @param[in] uxPayloadOffset The calculated UDP payload offset, which depends
- *                             on the IP type: IPv4 or IPv6.
- * @return The number of bytes stored in the socket for transmission.
+ * @brief Create a socket set.
+ *
+ * @return The new socket set which was created, or NULL when allocation has failed.
  */
-static int32_t prvSendTo_ActualSend( const FreeRTOS_Socket_t * pxSocket,
-                                     const void * pvBuffer,
-                                     size_t uxTotalDataLength,
-                                     BaseType_t xFlags,
-                                     const struct freertos_sockaddr * pxDestinationAddress,
-                                     size_t uxPayloadOffset )
-{
-    int32_t lReturn = 0;
-    TickType_t xTicksToWait = pxSocket->xSendBlockTime;
-    TimeOut_t xTimeOut;
-    NetworkBufferDescriptor_t * pxNetworkBuffer;
-
-    if( ( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_MSG_DONTWAIT ) != 0U ) ||
-        ( xIsCallingFromIPTask() != pdFALSE ) )
-    {
-        /* The caller wants a non-blocking operation. When called by the IP-task,
-         * the operation should always be non-blocking. */
-        xTicksToWait = ( TickType_t ) 0U;
-    }
-
-    if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U )
+    SocketSet_t FreeRTOS_CreateSocketSet( void )
     {
-        /* Zero copy is not set, so obtain a network buffer into
-         * which the payload will be copied. */
-        vTaskSetTimeOutState( &xTimeOut );
+        SocketSelect_t * pxSocketSet;
 
-        /* Block until a buffer becomes available, or until a
-         * timeout has been reached */
-        pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxPayloadOffset + uxTotalDataLength, xTicksToWait );
+        /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
+        /* coverity[misra_c_2012_directive_4_12_violation] */
+        pxSocketSet = ( ( SocketSelect_t * ) pvPortMalloc( sizeof( *pxSocketSet ) ) );
 
-        if( pxNetworkBuffer != NULL )
+        if( pxSocketSet != NULL )
         {
-            void * pvCopyDest = ( void * ) &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] );
-            ( void ) memcpy( pvCopyDest, pvBuffer, uxTotalDataLength );
+            ( void ) memset( pxSocketSet, 0, sizeof( *pxSocketSet ) );
+            pxSocketSet->xSelectGroup = xEventGroupCreate();
 
-            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
+            if( pxSocketSet->xSelectGroup == NULL )
             {
-                /* The entire block time has been used up. */
-                xTicksToWait = ( TickType_t ) 0;
+                vPortFree( pxSocketSet );
+                pxSocketSet = NULL;
+            }
+            else
+            {
+                #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+                {
+                    vListInitialise( &( pxSocketSet->xReadyList ) );
+                }
+                #endif
+
+                /* Lint wants at least a comment, in case the macro is empty. */
+                iptraceMEM_STATS_CREATE( tcpSOCKET_SET, pxSocketSet, sizeof( *pxSocketSet ) + sizeof( StaticEventGroup_t ) );
             }
         }
-    }
-    else
-    {
-        /* When zero copy is used, pvBuffer is a pointer to the
-         * payload of a buffer that has already been obtained from the
-         * stack.  Obtain the network buffer pointer from the buffer. */
-        pxNetworkBuffer = pxUDPPayloadBuffer_to_NetworkBuffer( pvBuffer );
-    }
 
-    if( pxNetworkBuffer != NULL )
-    {
-        pxNetworkBuffer->pxEndPoint = pxSocket->pxEndPoint;
-        lReturn = prvSendUDPPacket( pxSocket,
-                                    pxNetworkBuffer,
-                                    uxTotalDataLength,
-                                    xFlags,
-                                    pxDestinationAddress,
-                                    xTicksToWait,
-                                    uxPayloadOffset );
-    }
-    else
-    {
-        /* If errno was available, errno would be set to
-         * FREERTOS_ENOPKTS.  As it is, the function must return the
-         * number of transmitted bytes, so the calling function knows
-         * how  much data was actually sent. */
-        iptraceNO_BUFFER_FOR_SENDTO();
+        return ( SocketSet_t ) pxSocketSet;
     }
 
-    return lReturn;
-}
+#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+
 /**
- * @brief Send data to a socket. The socket must have already been created by a
- *        successful call to FreeRTOS_socket(). It works for UDP-sockets only.
- *
- * @param[in] xSocket The socket being sent to.
- * @param[in] pvBuffer Pointer to the data being sent.
- * @param[in] uxTotalDataLength Length (in bytes) of the data being sent.
- * @param[in] xFlags Flags used to communicate preferences to the function.
- *                    Possibly FREERTOS_MSG_DONTWAIT and/or FREERTOS_ZERO_COPY.
- * @param[in] pxDestinationAddress The address to which the data is to be sent.
- * @param[in] xDestinationAddressLength This parameter is present to adhere to the
- *                  Berkeley sockets standard. Else, it is not used.
+ * @brief Delete a given socket set.
  *
- * @return When positive: the total number of bytes sent, when negative an error
- *         has occurred: it can be looked-up in 'FreeRTOS-Kernel/projdefs.h'.
+ * @param[in] xSocketSet The socket set being deleted.
  */
-int32_t FreeRTOS_sendto( Socket_t xSocket,
-                         const void * pvBuffer,
-                         size_t uxTotalDataLength,
-                         BaseType_t xFlags,
-                         const struct freertos_sockaddr * pxDestinationAddress,
-                         socklen_t xDestinationAddressLength )
-{
-    int32_t lReturn = 0;
-    FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-    size_t uxMaxPayloadLength = 0;
-    size_t uxPayloadOffset = 0;
+    void FreeRTOS_DeleteSocketSet( SocketSet_t xSocketSet )
+    {
+        IPStackEvent_t xCloseEvent;
 
-    #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
-        struct freertos_sockaddr xTempDestinationAddress;
 
-        if( ( pxDestinationAddress != NULL ) && ( pxDestinationAddress->sin_family != FREERTOS_AF_INET6 ) && ( pxDestinationAddress->sin_family != FREERTOS_AF_INET ) )
+        xCloseEvent.eEventType = eSocketSetDeleteEvent;
+        xCloseEvent.pvData = ( void * ) xSocketSet;
+
+        if( xSendEventStructToIPTask( &xCloseEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
         {
-            ( void ) memcpy( &xTempDestinationAddress, pxDestinationAddress, sizeof( struct freertos_sockaddr ) );
+            FreeRTOS_printf( ( "FreeRTOS_DeleteSocketSet: xSendEventStructToIPTask failed\n" ) );
+        }
+    }
 
-            /* Default to FREERTOS_AF_INET family if either FREERTOS_AF_INET6/FREERTOS_AF_INET
-             *  is not specified in sin_family, if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled. */
-            xTempDestinationAddress.sin_family = FREERTOS_AF_INET;
-            pxDestinationAddress = &xTempDestinationAddress;
-        }
-    #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
+/*-----------------------------------------------------------*/
 
-    /* The function prototype is designed to maintain the expected Berkeley
-     * sockets standard, but this implementation does not use all the
-     * parameters. */
-    ( void ) xDestinationAddressLength;
-    configASSERT( pxDestinationAddress != NULL );
-    configASSERT( pvBuffer != NULL );
+#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
 
-    switch( pxDestinationAddress->sin_family )
+/**
+ * @brief Add a socket to a set.
+ *
+ * @param[in] xSocket The socket being added.
+ * @param[in] xSocketSet The socket set being added to.
+ * @param[in] xBitsToSet The event bits to set, a combination of the values defined
+ *                        in 'eSelectEvent_t', for read, write, exception, etc.
+ */
+    void FreeRTOS_FD_SET( Socket_t xSocket,
+                          SocketSet_t xSocketSet,
+                          EventBits_t xBitsToSet )
     {
-        #if ( ipconfigUSE_IPv6 != 0 )
-            case FREERTOS_AF_INET6:
-                uxMaxPayloadLength = ipconfigNETWORK_MTU - ( ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER );
-                uxPayloadOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER;
-                break;
-        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) xSocketSet;
 
-        #if ( ipconfigUSE_IPv4 != 0 )
-            case FREERTOS_AF_INET4:
-                uxMaxPayloadLength = ipconfigNETWORK_MTU - ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER );
-                uxPayloadOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER;
-                break;
-        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
-        default:
-            FreeRTOS_debug_printf( ( "FreeRTOS_sendto: Undefined sin_family \n" ) );
-            lReturn = -pdFREERTOS_ERRNO_EINVAL;
-            break;
-    }
+        configASSERT( pxSocket != NULL );
+        configASSERT( xSocketSet != NULL );
 
-    if( lReturn == 0 )
-    {
-        if( uxTotalDataLength <= ( size_t ) uxMaxPayloadLength )
+        /* Make sure we're not adding bits which are reserved for internal use,
+         * such as eSELECT_CALL_IP */
+        pxSocket->xSelectBits |= xBitsToSet & ( ( EventBits_t ) eSELECT_ALL );
+
+        if( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U )
         {
-            /* If the socket is not already bound to an address, bind it now.
-             * Passing NULL as the address parameter tells FreeRTOS_bind() to select
-             * the address to bind to. */
-            if( prvMakeSureSocketIsBound( pxSocket ) == pdTRUE )
-            {
-                lReturn = prvSendTo_ActualSend( pxSocket, pvBuffer, uxTotalDataLength, xFlags, pxDestinationAddress, uxPayloadOffset );
-            }
-            else
+            /* Adding a socket to a socket set. */
+            pxSocket->pxSocketSet = ( SocketSelect_t * ) xSocketSet;
+
+            /* Now have the IP-task call vSocketSelect() to see if the set contains
+             * any sockets which are 'ready' and set the proper bits. */
+            prvFindSelectedSocket( pxSocketSet );
+
+            #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
             {
-                /* No comment. */
-                iptraceSENDTO_SOCKET_NOT_BOUND();
+                /* A socket that is already readable or writable will not see
+                 * a new event for that, so report it now. */
+                prvSelectReadyListAdd( pxSocket, 0U );
             }
-        }
-        else
-        {
-            /* The data is longer than the available buffer space. */
-            iptraceSENDTO_DATA_TOO_LONG();
+            #endif
         }
     }
 
-    return lReturn;
-} /* Tested */
+#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+
 /**
- * @brief binds a socket to a local port number. If port 0 is provided,
- *        a system provided port number will be assigned. This function
- *        can be used for both UDP and TCP sockets. The actual binding
- *        will be performed by the IP-task to avoid mutual access to the
- *        bound-socket-lists (xBoundUDPSocketsList or xBoundTCPSocketsList).
- *
- * @param[in] xSocket The socket being bound.
- * @param[in] pxAddress The address struct carrying the port number to which
- *                       this socket is to be bound.
- * @param[in] xAddressLength This parameter is not used internally. The
- *                       function signature is used to adhere to standard
- *                       Berkeley sockets API.
+ * @brief Clear select bits for a socket. If the mask becomes 0,
+ *        remove the socket from the set.
  *
- * @return The return value is 0 if the bind is successful.
- *         If some error occurred, then a negative value is returned.
+ * @param[in] xSocket The socket whose select bits are being cleared.
+ * @param[in] xSocketSet The socket set of the socket.
+ * @param[in] xBitsToClear The bits to be cleared. Every '1' means that the
+ *                corresponding bit will be cleared. See 'eSelectEvent_t' for
+ *                the possible values.
  */
-BaseType_t FreeRTOS_bind( Socket_t xSocket,
-                          struct freertos_sockaddr const * pxAddress,
-                          socklen_t xAddressLength )
-{
-    IPStackEvent_t xBindEvent;
-    FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-    BaseType_t xReturn = 0;
+    void FreeRTOS_FD_CLR( Socket_t xSocket,
+                          SocketSet_t xSocketSet,
+                          EventBits_t xBitsToClear )
+    {
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
 
-    #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
-        struct freertos_sockaddr xTempAddress;
+        configASSERT( pxSocket != NULL );
+        configASSERT( xSocketSet != NULL );
 
-        if( ( pxAddress != NULL ) && ( pxAddress->sin_family != FREERTOS_AF_INET6 ) && ( pxAddress->sin_family != FREERTOS_AF_INET ) )
-        {
-            ( void ) memcpy( &xTempAddress, pxAddress, sizeof( struct freertos_sockaddr ) );
+        pxSocket->xSelectBits &= ~( xBitsToClear & ( ( EventBits_t ) eSELECT_ALL ) );
 
-            /* Default to FREERTOS_AF_INET family if either FREERTOS_AF_INET6/FREERTOS_AF_INET
-             *  is not specified in sin_family, if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled. */
-            xTempAddress.sin_family = FREERTOS_AF_INET;
-            pxAddress = &xTempAddress;
+        if( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U )
+        {
+            pxSocket->pxSocketSet = ( SocketSelect_t * ) xSocketSet;
+        }
+        else
+        {
+            /* disconnect it from the socket set */
+            #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+            {
+                prvSelectReadyListRemove( pxSocket );
+            }
+            #endif
+            pxSocket->pxSocketSet = NULL;
         }
-    #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
-
-    ( void ) xAddressLength;
-
-    configASSERT( xIsCallingFromIPTask() == pdFALSE );
-
-    if( xSocketValid( pxSocket ) == pdFALSE )
-    {
-        xReturn = -pdFREERTOS_ERRNO_EINVAL;
     }
 
-    /* Once a socket is bound to a port, it can not be bound to a different
-     * port number */
-    else if( socketSOCKET_IS_BOUND( pxSocket ) )
-    {
-        /* The socket is already bound. */
-        FreeRTOS_debug_printf( ( "vSocketBind: Socket already bound to %d\n", pxSocket->usLocalPort ) );
-        xReturn = -pdFREERTOS_ERRNO_EINVAL;
-    }
-    else
-    {
-        /* Prepare a messages to the IP-task in order to perform the binding.
-         * The desired port number will be passed in usLocalPort. */
-        xBindEvent.eEventType = eSocketBindEvent;
-        xBindEvent.pvData = xSocket;
 
-        if( pxAddress != NULL )
-        {
-            switch( pxAddress->sin_family )
-            {
-                #if ( ipconfigUSE_IPv6 != 0 )
-                    case FREERTOS_AF_INET6:
-                        ( void ) memcpy( pxSocket->xLocalAddress.xIP_IPv6.ucBytes, pxAddress->sin_address.xIP_IPv6.ucBytes, sizeof( pxSocket->xLocalAddress.xIP_IPv6.ucBytes ) );
-                        pxSocket->bits.bIsIPv6 = pdTRUE_UNSIGNED;
-                        break;
-                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
+/*-----------------------------------------------------------*/
 
-                #if ( ipconfigUSE_IPv4 != 0 )
-                    case FREERTOS_AF_INET4:
-                        pxSocket->xLocalAddress.ulIP_IPv4 = FreeRTOS_ntohl( pxAddress->sin_address.ulIP_IPv4 );
-                        pxSocket->bits.bIsIPv6 = pdFALSE_UNSIGNED;
-                        break;
-                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
-                default:
-                    FreeRTOS_debug_printf( ( "FreeRTOS_bind: Undefined sin_family \n" ) );
-                    break;
-            }
+#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
 
-            pxSocket->usLocalPort = FreeRTOS_ntohs( pxAddress->sin_port );
-        }
-        else
-        {
-            /* Caller wants to bind to a random port number. */
-            pxSocket->usLocalPort = 0U;
-            ( void ) memset( pxSocket->xLocalAddress.xIP_IPv6.ucBytes, 0, sizeof( pxSocket->xLocalAddress.xIP_IPv6.ucBytes ) );
-        }
+/**
+ * @brief Test if a socket belongs to a socket-set and if so, which event bit(s)
+ *        are set.
+ *
+ * @param[in] xSocket The socket of interest.
+ * @param[in] xSocketSet The socket set to which the socket belongs.
+ *
+ * @return If the socket belongs to the socket set: the event bits, otherwise zero.
+ */
+    EventBits_t FreeRTOS_FD_ISSET( const ConstSocket_t xSocket,
+                                   const ConstSocketSet_t xSocketSet )
+    {
+        EventBits_t xReturn;
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
 
-        /* portMAX_DELAY is used as a the time-out parameter, as binding *must*
-         * succeed before the socket can be used.  _RB_ The use of an infinite
-         * block time needs be changed as it could result in the task hanging. */
-        if( xSendEventStructToIPTask( &xBindEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
+        configASSERT( pxSocket != NULL );
+        configASSERT( xSocketSet != NULL );
+
+        if( xSocketSet == ( SocketSet_t ) pxSocket->pxSocketSet )
         {
-            /* Failed to wake-up the IP-task, no use to wait for it */
-            FreeRTOS_debug_printf( ( "FreeRTOS_bind: send event failed\n" ) );
-            xReturn = -pdFREERTOS_ERRNO_ECANCELED;
+            /* Make sure we're not adding bits which are reserved for internal
+             * use. */
+            xReturn = pxSocket->xSocketBits & ( ( EventBits_t ) eSELECT_ALL );
         }
         else
         {
-            /* The IP-task will set the 'eSOCKET_BOUND' bit when it has done its
-             * job. */
-            ( void ) xEventGroupWaitBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_BOUND, pdTRUE /*xClearOnExit*/, pdFALSE /*xWaitAllBits*/, portMAX_DELAY );
-
-            if( !socketSOCKET_IS_BOUND( pxSocket ) )
-            {
-                xReturn = -pdFREERTOS_ERRNO_EINVAL;
-            }
+            xReturn = 0;
         }
+
+        return xReturn;
     }
 
-    return xReturn;
-}
+
+#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+
 /**
- * @brief : Bind a socket to a port number.
- * @param[in] pxSocket  The socket to be bound.
- * @param[in] pxAddress  The socket will be bound to this address.
- * @param[in] pxSocketList  will either point to xBoundUDPSocketsList or
- *                           xBoundTCPSocketsList.
- * @param[in] xInternal  pdTRUE if this function is called 'internally', i.e.
- *                        by the IP-task.
+ * @brief The select() statement: wait for an event to occur on any of the sockets
+ *        included in a socket set and return its event bits when the event occurs.
+ *
+ * @param[in] xSocketSet The socket set including the sockets on which we are
+ *                        waiting for an event to occur.
+ * @param[in] xBlockTimeTicks Maximum time ticks to wait for an event to occur.
+ *                   If the value is 'portMAX_DELAY' then the function will wait
+ *                   indefinitely for an event to occur.
+ *
+ * @return The event bits (event flags) value for the socket set in which an
+ *          event occurred. If any socket is signalled during the call, using
+ *          FreeRTOS_SignalSocket() or FreeRTOS_SignalSocketFromISR(), then eSELECT_INTR
+ *          is returned.
+ *
  */
-static BaseType_t prvSocketBindAdd( FreeRTOS_Socket_t * pxSocket,
-                                    const struct freertos_sockaddr * pxAddress,
-                                    List_t * pxSocketList,
-                                    BaseType_t xInternal )
-{
-    BaseType_t xReturn = 0;
-
-    /* Check to ensure the port is not already in use.  If the bind is
-     * called internally, a port MAY be used by more than one socket. */
-    if( ( ( xInternal == pdFALSE ) || ( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP ) ) &&
-        ( pxListFindListItemWithValue( pxSocketList, ( TickType_t ) pxAddress->sin_port ) != NULL ) )
-    {
-        FreeRTOS_debug_printf( ( "vSocketBind: %sP port %d in use\n",
-                                 ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) ? "TC" : "UD",
-                                 FreeRTOS_ntohs( pxAddress->sin_port ) ) );
-        xReturn = -pdFREERTOS_ERRNO_EADDRINUSE;
-    }
-    else
+    BaseType_t FreeRTOS_select( SocketSet_t xSocketSet,
+                                TickType_t xBlockTimeTicks )
     {
-        /* Allocate the port number to the socket.
-         * This macro will set 'xBoundSocketListItem->xItemValue' */
-        socketSET_SOCKET_PORT( pxSocket, pxAddress->sin_port );
+        TimeOut_t xTimeOut;
+        TickType_t xRemainingTime;
+        SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) xSocketSet;
+        EventBits_t uxResult;
 
-        /* And also store it in a socket field 'usLocalPort' in host-byte-order,
-         * mostly used for logging and debugging purposes */
-        pxSocket->usLocalPort = FreeRTOS_ntohs( pxAddress->sin_port );
+        configASSERT( xSocketSet != NULL );
 
-        #if ( ipconfigUSE_IPv6 != 0 )
-            if( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
-            {
-                ( void ) memcpy( pxSocket->xLocalAddress.xIP_IPv6.ucBytes, pxAddress->sin_address.xIP_IPv6.ucBytes, sizeof( pxSocket->xLocalAddress.xIP_IPv6.ucBytes ) );
-            }
-            else
-        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        /* Only in the first round, check for non-blocking */
+        xRemainingTime = xBlockTimeTicks;
+
+        /* Fetch the current time */
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
         {
-            #if ( ipconfigUSE_IPv4 != 0 )
-                if( pxAddress->sin_address.ulIP_IPv4 != FREERTOS_INADDR_ANY )
+            /* Find a socket which might have triggered the bit
+             * This function might return immediately or block for a limited time */
+            uxResult = xEventGroupWaitBits( pxSocketSet->xSelectGroup, ( ( EventBits_t ) eSELECT_ALL ), pdFALSE, pdFALSE, xRemainingTime );
+
+            #if ( ipconfigSUPPORT_SIGNALS != 0 )
+            {
+                if( ( uxResult & ( ( EventBits_t ) eSELECT_INTR ) ) != 0U )
                 {
-                    pxSocket->pxEndPoint = FreeRTOS_FindEndPointOnIP_IPv4( pxAddress->sin_address.ulIP_IPv4 );
+                    ( void ) xEventGroupClearBits( pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_INTR );
+                    FreeRTOS_debug_printf( ( "FreeRTOS_select: interrupted\n" ) );
+                    break;
                 }
-                else
-            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
-            {
-                /* Place holder, do nothing, MISRA compliance */
             }
-        }
+            #endif /* ipconfigSUPPORT_SIGNALS */
 
-        #if ( ipconfigUSE_IPv4 != 0 )
-            if( pxSocket->pxEndPoint != NULL )
-            {
-                pxSocket->xLocalAddress.ulIP_IPv4 = FreeRTOS_ntohl( pxSocket->pxEndPoint->ipv4_settings.ulIPAddress );
-            }
-            else
-        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
-        #if ( ipconfigUSE_IPv6 != 0 )
-            if( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
-            {
-                /* Socket address was set, do nothing for IPv6. */
-            }
-            else
-        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
-        {
-            ( void ) memset( pxSocket->xLocalAddress.xIP_IPv6.ucBytes, 0, sizeof( pxSocket->xLocalAddress.xIP_IPv6.ucBytes ) );
-        }
+            /* Have the IP-task find the socket which had an event */
+            prvFindSelectedSocket( pxSocketSet );
 
-        /* Add the socket to the list of bound ports. */
-        {
-            /* If the network driver can iterate through 'xBoundUDPSocketsList',
-             * by calling xPortHasUDPSocket() then the IP-task must temporarily
-             * suspend the scheduler to keep the list in a consistent state. */
-            #if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
+            uxResult = xEventGroupGetBits( pxSocketSet->xSelectGroup );
+
+            if( uxResult != 0U )
             {
-                vTaskSuspendAll();
+                break;
             }
-            #endif /* ipconfigETHERNET_DRIVER_FILTERS_PACKETS */
-
-            /* Add the socket to 'xBoundUDPSocketsList' or 'xBoundTCPSocketsList' */
-            vListInsertEnd( pxSocketList, &( pxSocket->xBoundSocketListItem ) );
 
-            #if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
+            /* Has the timeout been reached? */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
             {
-                ( void ) xTaskResumeAll();
+                break;
             }
-            #endif /* ipconfigETHERNET_DRIVER_FILTERS_PACKETS */
         }
+
+        return ( BaseType_t ) uxResult;
     }
 
-    return xReturn;
-}
+
+#endif /* ipconfigSUPPORT_SELECT_FUNCTION */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+
 /**
- * @brief Internal version of bind() that should not be called directly.
- *        'xInternal' is used for TCP sockets only: it allows to have several
- *        (connected) child sockets bound to the same server port.
- *
- * @param[in] pxSocket The socket is to be bound.
- * @param[in] pxBindAddress The port to which this socket should be bound.
- * @param[in] uxAddressLength The address length.
- * @param[in] xInternal pdTRUE is calling internally, else pdFALSE.
- *
- * @return If the socket was bound to a port successfully, then a 0 is returned.
- *         Or else, an error code is returned.
+ * @brief Wait for events on the sockets of a socket set, and return the sockets
+ *        that had an event. Unlike FreeRTOS_select(), the sockets are not
+ *        scanned: each socket puts itself in the ready list of its set when an
+ *        event occurs. A socket is reported once for every event, after which
+ *        its event bits are cleared. Do not use FreeRTOS_select() and this
+ *        function on the same socket set.
+ *
+ * @param[in] xSocketSet The socket set to wait on.
+ * @param[out] pxSockets Receives the sockets that had an event.
+ * @param[out] pxEvents Receives the event bits of each returned socket,
+ *                      see 'eSelectEvent_t'. May be NULL.
+ * @param[in] xMaxSockets The number of entries in 'pxSockets' and 'pxEvents'.
+ * @param[in] xBlockTimeTicks Maximum time ticks to wait for an event.
+ *
+ * @return The number of sockets returned, zero when the time-out was reached,
+ *         or -pdFREERTOS_ERRNO_EINTR when the set was signalled.
  */
-BaseType_t vSocketBind( FreeRTOS_Socket_t * pxSocket,
-                        struct freertos_sockaddr * pxBindAddress,
-                        size_t uxAddressLength,
-                        BaseType_t xInternal )
-{
-    BaseType_t xReturn = 0; /* In Berkeley sockets, 0 means pass for bind(). */
-    List_t * pxSocketList;
-    struct freertos_sockaddr * pxAddress = pxBindAddress;
+    BaseType_t FreeRTOS_select_ready( SocketSet_t xSocketSet,
+                                      Socket_t * pxSockets,
+                                      EventBits_t * pxEvents,
+                                      BaseType_t xMaxSockets,
+                                      TickType_t xBlockTimeTicks )
+    {
+        TimeOut_t xTimeOut;
+        TickType_t xRemainingTime = xBlockTimeTicks;
+        SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) xSocketSet;
+        BaseType_t xCount = 0;
+        BaseType_t xTimedOut = pdFALSE;
+        EventBits_t uxResult;
 
-    #if ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 1 )
-        struct freertos_sockaddr xAddress;
-    #endif /* ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND */
+        configASSERT( xSocketSet != NULL );
+        configASSERT( pxSockets != NULL );
+        configASSERT( xMaxSockets > 0 );
 
-    configASSERT( xSocketValid( pxSocket ) == pdTRUE );
+        vTaskSetTimeOutState( &xTimeOut );
 
-    #if ( ipconfigUSE_TCP == 1 )
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        for( ; ; )
         {
-            pxSocketList = &xBoundTCPSocketsList;
-        }
-        else
-    #endif /* ipconfigUSE_TCP == 1 */
-    {
-        pxSocketList = &xBoundUDPSocketsList;
-    }
+            /* Clear the event bits before emptying the list: a socket that
+             * becomes ready after this point will set them again. */
+            ( void ) xEventGroupClearBits( pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_ALL & ~( ( EventBits_t ) eSELECT_INTR ) );
 
-    /* The function prototype is designed to maintain the expected Berkeley
-     * sockets standard, but this implementation does not use all the parameters. */
-    ( void ) uxAddressLength;
+            vTaskSuspendAll();
+            {
+                while( ( xCount < xMaxSockets ) && ( listCURRENT_LIST_LENGTH( &( pxSocketSet->xReadyList ) ) > 0U ) )
+                {
+                    FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocketSet->xReadyList ) ) );
 
-    #if ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 1 )
-    {
-        /* pxAddress will be NULL if sendto() was called on a socket without the
-         * socket being bound to an address. In this case, automatically allocate
-         * an address to the socket.  There is a small chance that the allocated
-         * port will already be in use - if that is the case, then the check below
-         * [pxListFindListItemWithValue()] will result in an error being returned. */
-        if( pxAddress == NULL )
-        {
-            pxAddress = &xAddress;
-            /* Clear the address: */
-            ( void ) memset( pxAddress, 0, sizeof( struct freertos_sockaddr ) );
+                    ( void ) uxListRemove( &( pxSocket->xReadyListItem ) );
 
-            if( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED )
-            {
-                pxAddress->sin_family = FREERTOS_AF_INET6;
+                    pxSockets[ xCount ] = ( Socket_t ) pxSocket;
+
+                    if( pxEvents != NULL )
+                    {
+                        pxEvents[ xCount ] = pxSocket->xSocketBits & ( ( EventBits_t ) eSELECT_ALL );
+                    }
+
+                    pxSocket->xSocketBits = 0U;
+                    xCount++;
+                }
             }
-            else
+            ( void ) xTaskResumeAll();
+
+            if( ( xCount > 0 ) || ( xTimedOut != pdFALSE ) )
             {
-                pxAddress->sin_family = FREERTOS_AF_INET;
+                break;
             }
-        }
-    }
-    #endif /* ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 1 */
 
-    /* Sockets must be bound before calling FreeRTOS_sendto() if
-    * ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND is not set to 1. */
-    configASSERT( pxAddress != NULL );
+            uxResult = xEventGroupWaitBits( pxSocketSet->xSelectGroup, ( ( EventBits_t ) eSELECT_ALL ), pdFALSE, pdFALSE, xRemainingTime );
 
-    #if ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 1 )
-        /* pxAddress is not NULL, no testing needed. */
-    #else
-        if( pxAddress != NULL )
-    #endif
-    {
-        /* Add a do-while loop to facilitate use of 'break' statements. */
-        do
-        {
-            if( pxAddress->sin_port == 0U )
+            #if ( ipconfigSUPPORT_SIGNALS != 0 )
             {
-                pxAddress->sin_port = prvGetPrivatePortNumber( ( BaseType_t ) pxSocket->ucProtocol );
-
-                if( pxAddress->sin_port == ( uint16_t ) 0U )
+                if( ( uxResult & ( ( EventBits_t ) eSELECT_INTR ) ) != 0U )
                 {
-                    xReturn = -pdFREERTOS_ERRNO_EADDRNOTAVAIL;
+                    ( void ) xEventGroupClearBits( pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_INTR );
+                    FreeRTOS_debug_printf( ( "FreeRTOS_select_ready: interrupted\n" ) );
+                    xCount = -pdFREERTOS_ERRNO_EINTR;
                     break;
                 }
             }
+            #else
+            {
+                ( void ) uxResult;
+            }
+            #endif /* ipconfigSUPPORT_SIGNALS */
 
-            /* If vSocketBind() is called from the API FreeRTOS_bind() it has been
-             * confirmed that the socket was not yet bound to a port.  If it is called
-             * from the IP-task, no such check is necessary. */
+            /* Empty the list one more time after the time-out has been reached. */
+            xTimedOut = xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime );
+        }
 
-            xReturn = prvSocketBindAdd( pxSocket, pxAddress, pxSocketList, xInternal );
-        } while( ipFALSE_BOOL );
+        return xCount;
     }
 
-    #if ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 0 )
-        else
+#endif /* ipconfigSUPPORT_SELECT_READY_LIST == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+
+/**
+ * @brief Add event bits to a socket, and put the socket in the ready list of
+ *        its socket set, unless it is there already. Called by the IP-task when
+ *        an event occurs, and by FreeRTOS_FD_SET().
+ *
+ * @param[in] pxSocket The socket that had an event.
+ * @param[in] xSelectBits The events that occurred, see 'eSelectEvent_t'.
+ */
+    static void prvSelectReadyListAdd( FreeRTOS_Socket_t * pxSocket,
+                                       EventBits_t xSelectBits )
+    {
+        /* The list is emptied by FreeRTOS_select_ready() in the user's task. */
+        vTaskSuspendAll();
         {
-            xReturn = -pdFREERTOS_ERRNO_EADDRNOTAVAIL;
-            FreeRTOS_debug_printf( ( "vSocketBind: Socket has no address.\n" ) );
+            pxSocket->xSocketBits |= xSelectBits;
+
+            if( ( pxSocket->pxSocketSet != NULL ) &&
+                ( ( pxSocket->xSocketBits & ( ( EventBits_t ) eSELECT_ALL ) ) != 0U ) &&
+                ( listLIST_ITEM_CONTAINER( &( pxSocket->xReadyListItem ) ) == NULL ) )
+            {
+                vListInsertEnd( &( pxSocket->pxSocketSet->xReadyList ), &( pxSocket->xReadyListItem ) );
+            }
         }
-    #endif
+        ( void ) xTaskResumeAll();
+    }
 
-    if( xReturn != 0 )
+#endif /* ipconfigSUPPORT_SELECT_READY_LIST == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+
+/**
+ * @brief Take a socket out of the ready list of its socket set, if it is in
+ *        there.
+ *
+ * @param[in] pxSocket The socket to be removed.
+ */
+    static void prvSelectReadyListRemove( FreeRTOS_Socket_t * pxSocket )
     {
-        iptraceBIND_FAILED( xSocket, ( FreeRTOS_ntohs( pxAddress->sin_port ) ) );
+        vTaskSuspendAll();
+        {
+            if( listLIST_ITEM_CONTAINER( &( pxSocket->xReadyListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxSocket->xReadyListItem ) );
+            }
+        }
+        ( void ) xTaskResumeAll();
     }
 
-    return xReturn;
-} /* Tested */
+#endif /* ipconfigSUPPORT_SELECT_READY_LIST == 1 */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 ) && ( ipconfigSELECT_LOCAL_EVALUATION == 1 )
+
 /**
- * @brief Close a socket and free the allocated space. In case of a TCP socket:
- *        the connection will not be closed automatically. Subsequent messages
- *        for the closed socket will be responded to with a RST. The IP-task
- *        will actually close the socket, after receiving a 'eSocketCloseEvent'
- *        message.
- *
- * @param[in] xSocket the socket being closed.
+ * @brief Check all sockets belonging to 'pxSocketSet' from the calling task.
+ *        The IP-task suspends the scheduler while it changes the lists of
+ *        bound sockets, so they can be scanned here without a round trip to
+ *        the IP-task.
  *
- * @return There are three distinct values which can be returned:
- *         0: If the xSocket is NULL/invalid.
- *         1: If the socket was successfully closed (read the brief above).
- *        -1: If the socket was valid but could not be closed because the message
- *            could not be delivered to the IP-task. Try again later.
+ * @param[in] pxSocketSet The socket set being asked to check.
  */
-BaseType_t FreeRTOS_closesocket( Socket_t xSocket )
-{
-    BaseType_t xResult;
-
-    #if ( ipconfigUSE_CALLBACKS == 1 )
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-    #endif /* ipconfigUSE_CALLBACKS == 1 */
-    IPStackEvent_t xCloseEvent;
-    xCloseEvent.eEventType = eSocketCloseEvent;
-    xCloseEvent.pvData = xSocket;
-
-    if( xSocketValid( xSocket ) == pdFALSE )
+    static void prvFindSelectedSocket( SocketSelect_t * pxSocketSet )
     {
-        xResult = 0;
+        vTaskSuspendAll();
+        {
+            vSocketSelect( pxSocketSet );
+        }
+        ( void ) xTaskResumeAll();
     }
-    else
+
+#elif ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+
+/**
+ * @brief Send a message to the IP-task to have it check all sockets belonging to
+ *        'pxSocketSet'
+ *
+ * @param[in] pxSocketSet The socket set being asked to check.
+ */
+    static void prvFindSelectedSocket( SocketSelect_t * pxSocketSet )
     {
-        #if ( ipconfigUSE_CALLBACKS == 1 )
+        IPStackEvent_t xSelectEvent;
+
+        #if ( ipconfigSELECT_USES_NOTIFY != 0 )
+            SocketSelectMessage_t xSelectMessage;
+        #endif
+
+        xSelectEvent.eEventType = eSocketSelectEvent;
+        #if ( ipconfigSELECT_USES_NOTIFY != 0 )
         {
-            #if ( ipconfigUSE_TCP == 1 )
-                if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
-                {
-                    /* Make sure that IP-task won't call the user callback's anymore */
-                    pxSocket->u.xTCP.pxHandleConnected = NULL;
-                    pxSocket->u.xTCP.pxHandleReceive = NULL;
-                    pxSocket->u.xTCP.pxHandleSent = NULL;
-                }
-                else
-            #endif /* ipconfigUSE_TCP == 1 */
+            xSelectMessage.pxSocketSet = pxSocketSet;
+            xSelectMessage.xTaskhandle = xTaskGetCurrentTaskHandle();
+            xSelectEvent.pvData = &( xSelectMessage );
+        }
+        #else
+        {
+            xSelectEvent.pvData = pxSocketSet;
 
-            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+            /* while the IP-task works on the request, the API will block on
+             * 'eSELECT_CALL_IP'.  So clear it first. */
+            ( void ) xEventGroupClearBits( pxSocketSet->xSelectGroup, ( BaseType_t ) eSELECT_CALL_IP );
+        }
+        #endif /* if ( ipconfigSELECT_USES_NOTIFY != 0 ) */
+
+        /* Now send the socket select event */
+        if( xSendEventStructToIPTask( &xSelectEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
+        {
+            /* Oops, we failed to wake-up the IP task. No use to wait for it. */
+            FreeRTOS_debug_printf( ( "prvFindSelectedSocket: failed\n" ) );
+        }
+        else
+        {
+            /* As soon as the IP-task is ready, it will set 'eSELECT_CALL_IP' to
+             * wakeup the calling API */
+            #if ( ipconfigSELECT_USES_NOTIFY != 0 )
             {
-                /* Clear the two UDP handlers. */
-                pxSocket->u.xUDP.pxHandleReceive = NULL;
-                pxSocket->u.xUDP.pxHandleSent = NULL;
+                ( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+            }
+            #else
+            {
+                ( void ) xEventGroupWaitBits( pxSocketSet->xSelectGroup, ( BaseType_t ) eSELECT_CALL_IP, pdTRUE, pdFALSE, portMAX_DELAY );
             }
+            #endif
         }
-        #endif /* ipconfigUSE_CALLBACKS == 1 */
+    }
 
-        /* Let the IP task close the socket to keep it synchronised with the
-         * packet handling. */
 
-        /* The timeout value below is only used if this function is called from
-         * a user task. If this function is called by the IP-task, it may fail
-         * to close the socket when the event queue is full.
-         * This should only happen in case of a user call-back. */
-        if( xSendEventStructToIPTask( &xCloseEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
+#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_SOCKET_BUSY_POLL != 0 )
+
+/**
+ * @brief Called by a receive function before it blocks on the event group of
+ *        a socket: spin for at most the busy-poll time of the socket, until
+ *        one of the events is set.  The events are not cleared, the caller
+ *        will find them when it waits for them.
+ *
+ * @param[in] pxSocket The socket that is waiting for data.
+ * @param[in] xWaitBits The events that the caller will wait for.
+ * @param[in] xMaxTime The receive time-out, the spinning does not last longer.
+ */
+    static void prvSocketBusyPoll( const FreeRTOS_Socket_t * pxSocket,
+                                   EventBits_t xWaitBits,
+                                   TickType_t xMaxTime )
+    {
+        TickType_t xRemainingTime = pxSocket->xBusyPollTime;
+        TimeOut_t xTimeOut;
+
+        if( xRemainingTime > xMaxTime )
         {
-            FreeRTOS_debug_printf( ( "FreeRTOS_closesocket: failed\n" ) );
-            xResult = -1;
+            xRemainingTime = xMaxTime;
         }
-        else
+
+        if( xRemainingTime != ( TickType_t ) 0U )
         {
-            xResult = 1;
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+                {
+                    NetworkInterface_t * pxInterface;
+
+                    /* Let the IP-task fetch frames from the driver now, in
+                     * stead of waiting for its RX interrupt.  A request that is
+                     * still pending is not repeated. */
+                    for( pxInterface = FreeRTOS_FirstNetworkInterface();
+                         pxInterface != NULL;
+                         pxInterface = FreeRTOS_NextNetworkInterface( pxInterface ) )
+                    {
+                        if( ( pxInterface->pfPoll != NULL ) &&
+                            ( ( pxSocket->pxEndPoint == NULL ) || ( pxSocket->pxEndPoint->pxNetworkInterface == pxInterface ) ) )
+                        {
+                            FreeRTOS_NetworkInterfacePoll( pxInterface );
+                        }
+                    }
+                }
+                #endif /* ipconfigUSE_NETWORK_INTERFACE_POLL */
+
+                if( ( xSocketEventGet( pxSocket ) & xWaitBits ) != 0U )
+                {
+                    break;
+                }
+
+                taskYIELD();
+            } while( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) == pdFALSE );
         }
     }
+/*-----------------------------------------------------------*/
 
-    return xResult;
-}
+#endif /* ipconfigUSE_SOCKET_BUSY_POLL != 0 */
 
 /**
- * @brief This is the internal version of FreeRTOS_closesocket(). It will
- *        be called by the IPtask only to avoid problems with synchronicity.
- *
- * @param[in] pxSocket The socket descriptor of the socket being closed.
- *
- * @return Returns NULL, always.
+ * @brief : called from FreeRTOS_recvfrom(). This function waits for an incoming
+ *          UDP packet, or until a time-out occurs.
+ * @param[in] pxSocket  The socket that receives UDP packets.
+ * @param[in] xFlags  The flags as passed to FreeRTOS_recvfrom().
+ * @param[in,out] pxEventBits  The last even received in this function,
+ *                              either eSOCKET_INTR or eSOCKET_RECEIVE.
  */
-/* MISRA Ref 17.2.1 [Sockets and limited recursion] */
-/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-172 */
-/* coverity[misra_c_2012_rule_17_2_violation] */
-void * vSocketClose( FreeRTOS_Socket_t * pxSocket )
+static NetworkBufferDescriptor_t * prvRecvFromWaitForPacket( FreeRTOS_Socket_t const * pxSocket,
+                                                             BaseType_t xFlags,
+                                                             EventBits_t * pxEventBits )
 {
-    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    BaseType_t xTimed = pdFALSE;
+    TickType_t xRemainingTime = pxSocket->xReceiveBlockTime;
+    BaseType_t lPacketCount;
+    TimeOut_t xTimeOut;
+    EventBits_t xEventBits = ( EventBits_t ) 0;
+    NetworkBufferDescriptor_t * pxNetworkBuffer = NULL;
 
-    #if ( ipconfigUSE_TCP == 1 )
+    lPacketCount = ( BaseType_t ) listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
+
+    while( lPacketCount == 0 )
     {
-        /* For TCP: clean up a little more. */
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        if( xTimed == pdFALSE )
         {
-            #if ( ipconfigUSE_TCP_WIN == 1 )
+            /* Check to see if the socket is non blocking on the first
+             * iteration.  */
+            if( xRemainingTime == ( TickType_t ) 0 )
             {
-                if( pxSocket->u.xTCP.pxAckMessage != NULL )
+                #if ( ipconfigSUPPORT_SIGNALS != 0 )
                 {
-                    vReleaseNetworkBufferAndDescriptor( pxSocket->u.xTCP.pxAckMessage );
+                    /* Just check for the interrupt flag. */
+                    xEventBits = xSocketEventWait( ( FreeRTOS_Socket_t * ) pxSocket, ( EventBits_t ) eSOCKET_INTR,
+                                                   pdTRUE /*xClearOnExit*/, socketDONT_BLOCK );
                 }
-
-                /* Free the resources which were claimed by the tcpWin member */
-                vTCPWindowDestroy( &pxSocket->u.xTCP.xTCPWindow );
+                #endif /* ipconfigSUPPORT_SIGNALS */
+                break;
             }
-            #endif /* ipconfigUSE_TCP_WIN */
 
-            /* Free the input and output streams */
-            if( pxSocket->u.xTCP.rxStream != NULL )
+            if( ( ( ( UBaseType_t ) xFlags ) & ( ( UBaseType_t ) FREERTOS_MSG_DONTWAIT ) ) != 0U )
             {
-                iptraceMEM_STATS_DELETE( pxSocket->u.xTCP.rxStream );
-                vPortFreeLarge( pxSocket->u.xTCP.rxStream );
+                break;
             }
 
-            if( pxSocket->u.xTCP.txStream != NULL )
+            /* To ensure this part only executes once. */
+            xTimed = pdTRUE;
+
+            /* Fetch the current time. */
+            vTaskSetTimeOutState( &xTimeOut );
+
+            #if ( ipconfigUSE_SOCKET_BUSY_POLL != 0 )
             {
-                iptraceMEM_STATS_DELETE( pxSocket->u.xTCP.txStream );
-                vPortFreeLarge( pxSocket->u.xTCP.txStream );
+                prvSocketBusyPoll( pxSocket, ( ( EventBits_t ) eSOCKET_RECEIVE ) | ( ( EventBits_t ) eSOCKET_INTR ), xRemainingTime );
             }
-
-            /* In case this is a child socket, make sure the child-count of the
-             * parent socket is decreased. */
-            prvTCPSetSocketCount( pxSocket );
+            #endif
         }
-    }
-    #endif /* ipconfigUSE_TCP == 1 */
 
-    /* Socket must be unbound first, to ensure no more packets are queued on
-     * it. */
-    if( socketSOCKET_IS_BOUND( pxSocket ) )
-    {
-        /* If the network driver can iterate through 'xBoundUDPSocketsList',
-         * by calling xPortHasUDPSocket(), then the IP-task must temporarily
-         * suspend the scheduler to keep the list in a consistent state. */
-        #if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
+        /* Wait for arrival of data.  While waiting, the IP-task may set the
+         * 'eSOCKET_RECEIVE' bit in 'xEventGroup', if it receives data for this
+         * socket, thus unblocking this API call. */
+        xEventBits = xSocketEventWait( ( FreeRTOS_Socket_t * ) pxSocket, ( ( EventBits_t ) eSOCKET_RECEIVE ) | ( ( EventBits_t ) eSOCKET_INTR ),
+                                       pdTRUE /*xClearOnExit*/, xRemainingTime );
+
+        #if ( ipconfigSUPPORT_SIGNALS != 0 )
         {
-            vTaskSuspendAll();
+            if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
+            {
+                if( ( xEventBits & ( EventBits_t ) eSOCKET_RECEIVE ) != 0U )
+                {
+                    /* Shouldn't have cleared the eSOCKET_RECEIVE flag. */
+                    vSocketEventSet( ( FreeRTOS_Socket_t * ) pxSocket, ( EventBits_t ) eSOCKET_RECEIVE );
+                }
+
+                break;
+            }
+        }
+        #else /* if ( ipconfigSUPPORT_SIGNALS != 0 ) */
+        {
+            ( void ) xEventBits;
         }
-        #endif /* ipconfigETHERNET_DRIVER_FILTERS_PACKETS */
+        #endif /* ipconfigSUPPORT_SIGNALS */
 
-        ( void ) uxListRemove( &( pxSocket->xBoundSocketListItem ) );
+        lPacketCount = ( BaseType_t ) listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
 
-        #if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
+        if( lPacketCount != 0 )
         {
-            ( void ) xTaskResumeAll();
+            break;
         }
-        #endif /* ipconfigETHERNET_DRIVER_FILTERS_PACKETS */
-    }
 
-    /* Now the socket is not bound the list of waiting packets can be
-     * drained. */
-    if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
-    {
-        while( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U )
+        /* Has the timeout been reached ? */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
         {
-            pxNetworkBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) );
-            ( void ) uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
-            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+            break;
         }
-    }
-
-    if( pxSocket->xEventGroup != NULL )
-    {
-        vEventGroupDelete( pxSocket->xEventGroup );
-    }
+    } /* while( lPacketCount == 0 ) */
 
-    #if ( ipconfigUSE_TCP == 1 ) && ( ipconfigHAS_DEBUG_PRINTF != 0 )
+    if( lPacketCount > 0 )
     {
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        vTaskSuspendAll();
         {
-            FreeRTOS_debug_printf( ( "FreeRTOS_closesocket[%s]: buffers %lu socks %lu\n",
-                                     prvSocketProps( pxSocket ),
-                                     uxGetNumberOfFreeNetworkBuffers(),
-                                     listCURRENT_LIST_LENGTH( &xBoundTCPSocketsList ) ) );
+            /* The owner of the list item is the network buffer. */
+            pxNetworkBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) );
+
+            if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_MSG_PEEK ) == 0U )
+            {
+                /* Remove the network buffer from the list of buffers waiting to
+                 * be processed by the socket. */
+                ( void ) uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
+                vSocketMemoryRelease( pxNetworkBuffer->xDataLength );
+            }
         }
+        ( void ) xTaskResumeAll();
     }
-    #endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigHAS_DEBUG_PRINTF != 0 ) */
 
-    /* And finally, after all resources have been freed, free the socket space */
-    iptraceMEM_STATS_DELETE( pxSocket );
-    vPortFreeSocket( pxSocket );
+    *pxEventBits = xEventBits;
 
-    return NULL;
-} /* Tested */
+    return pxNetworkBuffer;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by FreeRTOS_recvfrom(). it will copy the received data
+ *        or just a pointer to the received data in case of zero-copy,
+ *        to the buffer provided by the caller.
+ * @param[in] pucEthernetBuffer The packet that was received.
+ * @param[in] pvBuffer The user-supplied buffer.
+ * @param[in] uxBufferLength The size of the user-supplied buffer.
+ * @param[in] xFlags Only 'FREERTOS_ZERO_COPY' will be tested.
+ * @param[in] lDataLength The number of bytes in the UDP payload.
+ * @return The number of bytes copied to the use buffer.
+ */
+static int32_t prvRecvFrom_CopyPacket( uint8_t * pucEthernetBuffer,
+                                       void * pvBuffer,
+                                       size_t uxBufferLength,
+                                       BaseType_t xFlags,
+                                       int32_t lDataLength )
+{
+    int32_t lReturn = lDataLength;
+    const void * pvCopySource;
+
+    if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U )
+    {
+        /* The zero copy flag is not set.  Truncate the length if it won't
+         * fit in the provided buffer. */
+        if( lReturn > ( int32_t ) uxBufferLength )
+        {
+            iptraceRECVFROM_DISCARDING_BYTES( ( uxBufferLength - lReturn ) );
+            lReturn = ( int32_t ) uxBufferLength;
+        }
+
+        /* Copy the received data into the provided buffer, then release the
+         * network buffer. */
+        pvCopySource = ( const void * ) pucEthernetBuffer;
+        ( void ) memcpy( pvBuffer, pvCopySource, ( size_t ) lReturn );
+    }
+    else
+    {
+        /* The zero copy flag was set.  pvBuffer is not a buffer into which
+         * the received data can be copied, but a pointer that must be set to
+         * point to the buffer in which the received data has already been
+         * placed. */
+        *( ( void ** ) pvBuffer ) = ( void * ) pucEthernetBuffer;
+    }
+
+    return lReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by FreeRTOS_recvfrom() and FreeRTOS_recvmmsg(). It fills in
+ *        the source address and passes the UDP payload of a received packet
+ *        to the caller.
+ * @param[in] pxNetworkBuffer The packet that was received.
+ * @param[in] pvBuffer The user-supplied buffer.
+ * @param[in] uxBufferLength The size of the user-supplied buffer.
+ * @param[in] xFlags Only 'FREERTOS_ZERO_COPY' will be tested.
+ * @param[out] pxSourceAddress The source address of the packet, may be NULL.
+ * @return The number of bytes passed to the user, or -pdFREERTOS_ERRNO_EINVAL
+ *         when the packet has an unknown IP header.
+ */
+static int32_t prvRecvFrom_ReadPacket( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                       void * pvBuffer,
+                                       size_t uxBufferLength,
+                                       BaseType_t xFlags,
+                                       struct freertos_sockaddr * pxSourceAddress )
+{
+    int32_t lReturn = 0;
+    size_t uxPayloadOffset = 0;
+    size_t uxPayloadLength;
+
+    switch( uxIPHeaderSizePacket( pxNetworkBuffer ) )
+    {
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case ipSIZE_OF_IPv4_HEADER:
+                uxPayloadOffset = xRecv_Update_IPv4( pxNetworkBuffer, pxSourceAddress );
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case ipSIZE_OF_IPv6_HEADER:
+                uxPayloadOffset = xRecv_Update_IPv6( pxNetworkBuffer, pxSourceAddress );
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+        default:
+            /* MISRA 16.4 Compliance */
+            lReturn = -pdFREERTOS_ERRNO_EINVAL;
+            break;
+    }
+
+    if( lReturn == 0 )
+    {
+        /* The returned value is the length of the payload data, which is
+         * calculated at the total packet size minus the headers.
+         * The validity of `xDataLength` prvProcessIPPacket has been confirmed
+         * in 'prvProcessIPPacket()'. */
+        uxPayloadLength = pxNetworkBuffer->xDataLength - uxPayloadOffset;
+        lReturn = ( int32_t ) uxPayloadLength;
+
+        lReturn = prvRecvFrom_CopyPacket( &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] ), pvBuffer, uxBufferLength, xFlags, lReturn );
+    }
+
+    return lReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Receive data from a bound socket. In this library, the function
+ *        can only be used with connection-less sockets (UDP). For TCP sockets,
+ *        please use FreeRTOS_recv().
+ *
+ * @param[in] xSocket The socket to which the data is sent i.e. the
+ *                     listening socket.
+ * @param[out] pvBuffer The buffer in which the data being received is to
+ *                      be stored.
+ * @param[in] uxBufferLength The length of the buffer.
+ * @param[in] xFlags The flags to indicate preferences while calling this function.
+ * @param[out] pxSourceAddress The source address from which the data is being sent.
+ * @param[out] pxSourceAddressLength The length of the source address structure.
+ *                  This would always be a constant - 24 (in case of no error) as
+ *                  FreeRTOS+TCP makes the sizes of IPv4 and IPv6 structures equal
+ *                  (24-bytes) for compatibility.
+ *
+ * @return The number of bytes received. Or else, an error code is returned. When it
+ *         returns a negative value, the cause can be looked-up in 'FreeRTOS-Kernel/projdefs.h'.
+ */
+int32_t FreeRTOS_recvfrom( const ConstSocket_t xSocket,
+                           void * pvBuffer,
+                           size_t uxBufferLength,
+                           BaseType_t xFlags,
+                           struct freertos_sockaddr * pxSourceAddress,
+                           socklen_t * pxSourceAddressLength )
+{
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    FreeRTOS_Socket_t const * pxSocket = xSocket;
+    int32_t lReturn = 0;
+    EventBits_t xEventBits = ( EventBits_t ) 0;
+
+    if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_UDP, pdTRUE ) == pdFALSE )
+    {
+        lReturn = -pdFREERTOS_ERRNO_EINVAL;
+    }
+    else
+    {
+        pxNetworkBuffer = prvRecvFromWaitForPacket( pxSocket, xFlags, &( xEventBits ) );
+
+        if( pxNetworkBuffer != NULL )
+        {
+            lReturn = prvRecvFrom_ReadPacket( pxNetworkBuffer, pvBuffer, uxBufferLength, xFlags, pxSourceAddress );
+
+            #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                if( ( lReturn >= 0 ) && ( pxSourceAddress != NULL ) )
+                {
+                    prvSocketMapAddress( pxSocket, pxSourceAddress );
+                }
+            #endif
+
+            if( ( lReturn >= 0 ) && ( pxSourceAddressLength != NULL ) )
+            {
+                /* The function prototype is designed to maintain the expected
+                 * Berkeley sockets standard, the length is always the same. */
+                *pxSourceAddressLength = ( socklen_t ) sizeof( struct freertos_sockaddr );
+            }
+
+            if( ( ( ( UBaseType_t ) xFlags & ( ( ( UBaseType_t ) FREERTOS_MSG_PEEK ) | ( ( UBaseType_t ) FREERTOS_ZERO_COPY ) ) ) == 0U ) ||
+                ( lReturn < 0 ) )
+            {
+                vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+            }
+        }
+
+        #if ( ipconfigSUPPORT_SIGNALS != 0 )
+            else if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
+            {
+                lReturn = -pdFREERTOS_ERRNO_EINTR;
+                iptraceRECVFROM_INTERRUPTED();
+            }
+        #endif /* ipconfigSUPPORT_SIGNALS */
+        else
+        {
+            lReturn = -pdFREERTOS_ERRNO_EWOULDBLOCK;
+            iptraceRECVFROM_TIMEOUT();
+        }
+    }
+
+    return lReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigSUPPORT_RECVMMSG != 0 )
+
+/**
+ * @brief Receive up to 'uxMessageCount' datagrams from a UDP socket. The
+ *        call blocks, as FreeRTOS_recvfrom() does, until at least one
+ *        datagram is available. All other datagrams that are waiting are
+ *        taken from the socket within a single suspension of the scheduler.
+ *
+ * @param[in] xSocket The UDP socket.
+ * @param[in,out] pxMessages An array of message headers. pvBuffer and
+ *                           uxBufferLength are supplied by the caller,
+ *                           xSourceAddress and lLength are filled in.
+ * @param[in] uxMessageCount The number of entries in pxMessages.
+ * @param[in] xFlags FREERTOS_ZERO_COPY and FREERTOS_MSG_DONTWAIT are tested.
+ *                   With FREERTOS_ZERO_COPY, each pvBuffer is set to the
+ *                   payload, which must be released by calling
+ *                   FreeRTOS_ReleaseUDPPayloadBuffer().
+ *
+ * @return The number of datagrams that were received, or a negative
+ *         error code, like FreeRTOS_recvfrom() returns.
+ */
+    int32_t FreeRTOS_recvmmsg( const ConstSocket_t xSocket,
+                               FreeRTOS_MMsgHdr_t * pxMessages,
+                               size_t uxMessageCount,
+                               BaseType_t xFlags )
+    {
+        NetworkBufferDescriptor_t * pxNetworkBuffer;
+        FreeRTOS_Socket_t const * pxSocket = xSocket;
+        int32_t lReturn = 0;
+        int32_t lLength;
+        size_t uxCount = 0U;
+        EventBits_t xEventBits = ( EventBits_t ) 0;
+        /* Peeking is not supported, every datagram returned is consumed. */
+        BaseType_t xReadFlags = ( BaseType_t ) ( ( UBaseType_t ) xFlags & ~( ( UBaseType_t ) FREERTOS_MSG_PEEK ) );
+        List_t xBatchList;
+        const ListItem_t * pxIterator;
+        const ListItem_t * pxEnd;
+
+        if( ( prvValidSocket( pxSocket, FREERTOS_IPPROTO_UDP, pdTRUE ) == pdFALSE ) ||
+            ( pxMessages == NULL ) ||
+            ( uxMessageCount == 0U ) )
+        {
+            lReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            pxNetworkBuffer = prvRecvFromWaitForPacket( pxSocket, xReadFlags, &( xEventBits ) );
+
+            if( pxNetworkBuffer != NULL )
+            {
+                vListInitialise( &( xBatchList ) );
+                vListInsertEnd( &( xBatchList ), &( pxNetworkBuffer->xBufferListItem ) );
+
+                /* Move as many waiting packets as needed to a private list, so
+                 * that they can be copied without suspending the scheduler. */
+                vTaskSuspendAll();
+                {
+                    while( ( listCURRENT_LIST_LENGTH( &( xBatchList ) ) < ( UBaseType_t ) uxMessageCount ) &&
+                           ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
+                    {
+                        pxNetworkBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) );
+                        ( void ) uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
+                        vSocketMemoryRelease( pxNetworkBuffer->xDataLength );
+                        vListInsertEnd( &( xBatchList ), &( pxNetworkBuffer->xBufferListItem ) );
+                    }
+                }
+                ( void ) xTaskResumeAll();
+
+                pxEnd = listGET_END_MARKER( &( xBatchList ) );
+
+                while( listCURRENT_LIST_LENGTH( &( xBatchList ) ) > 0U )
+                {
+                    pxIterator = listGET_NEXT( pxEnd );
+                    pxNetworkBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                    ( void ) uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
+
+                    lLength = prvRecvFrom_ReadPacket( pxNetworkBuffer,
+                                                      pxMessages[ uxCount ].pvBuffer,
+                                                      pxMessages[ uxCount ].uxBufferLength,
+                                                      xReadFlags,
+                                                      &( pxMessages[ uxCount ].xAddress ) );
+
+                    if( lLength >= 0 )
+                    {
+                        #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                            prvSocketMapAddress( pxSocket, &( pxMessages[ uxCount ].xAddress ) );
+                        #endif
+
+                        pxMessages[ uxCount ].lLength = lLength;
+
+                        #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+                        {
+                            pxMessages[ uxCount ].xTimestamp = pxNetworkBuffer->xTimestamp;
+                        }
+                        #endif
+
+                        uxCount++;
+                    }
+                    else
+                    {
+                        /* Remember the error in case no datagram can be returned. */
+                        lReturn = lLength;
+                    }
+
+                    if( ( ( ( UBaseType_t ) xReadFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U ) ||
+                        ( lLength < 0 ) )
+                    {
+                        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+                    }
+                }
+
+                if( uxCount > 0U )
+                {
+                    lReturn = ( int32_t ) uxCount;
+                }
+            }
+
+            #if ( ipconfigSUPPORT_SIGNALS != 0 )
+                else if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
+                {
+                    lReturn = -pdFREERTOS_ERRNO_EINTR;
+                    iptraceRECVFROM_INTERRUPTED();
+                }
+            #endif /* ipconfigSUPPORT_SIGNALS */
+            else
+            {
+                lReturn = -pdFREERTOS_ERRNO_EWOULDBLOCK;
+                iptraceRECVFROM_TIMEOUT();
+            }
+        }
+
+        return lReturn;
+    }
+
+#endif /* ( ipconfigSUPPORT_RECVMMSG != 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a socket is a valid UDP socket. In case it is not
+ *        yet bound, bind it to port 0 ( random port ).
+ * @param[in] pxSocket The socket that must be bound to a port number.
+ * @return Returns pdTRUE if the socket was already bound, or if the
+ *         socket has been bound successfully.
+ */
+static BaseType_t prvMakeSureSocketIsBound( FreeRTOS_Socket_t * pxSocket )
+{
+    /* Check if this is a valid UDP socket, does not have to be bound yet. */
+    BaseType_t xReturn = prvValidSocket( pxSocket, FREERTOS_IPPROTO_UDP, pdFALSE );
+
+    if( ( xReturn == pdTRUE ) && ( !socketSOCKET_IS_BOUND( pxSocket ) ) )
+    {
+        /* The socket is valid but it is not yet bound. */
+        if( FreeRTOS_bind( pxSocket, NULL, 0U ) != 0 )
+        {
+            /* The socket was not yet bound, and binding it has failed. */
+            xReturn = pdFALSE;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+
+/**
+ * @brief Fill in the addresses, the length and the socket options of a UDP
+ *        packet that is about to be passed to the IP-task.
+ * @param[in] pxSocket  The socket on which a packet is sent.
+ * @param[in] pxNetworkBuffer  The packet to be sent.
+ * @param[in] uxTotalDataLength  The total number of payload bytes in the packet.
+ * @param[in] pxDestinationAddress  The address of the destination.
+ * @param[in] uxPayloadOffset  The number of bytes in the packet before the payload.
+ */
+static void prvPrepareUDPPacket( const FreeRTOS_Socket_t * pxSocket,
+                                 NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                 size_t uxTotalDataLength,
+                                 const struct freertos_sockaddr * pxDestinationAddress,
+                                 size_t uxPayloadOffset )
+{
+    switch( pxDestinationAddress->sin_family ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is checked before calling. */
+    {
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case FREERTOS_AF_INET6:
+                ( void ) xSend_UDP_Update_IPv6( pxNetworkBuffer, pxDestinationAddress );
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case FREERTOS_AF_INET4:
+                ( void ) xSend_UDP_Update_IPv4( pxNetworkBuffer, pxDestinationAddress );
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        default:   /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
+            /* MISRA 16.4 Compliance */
+            break; /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
+    }
+
+    pxNetworkBuffer->xDataLength = uxTotalDataLength + uxPayloadOffset;
+    pxNetworkBuffer->usPort = pxDestinationAddress->sin_port;
+    pxNetworkBuffer->usBoundPort = ( uint16_t ) socketGET_SOCKET_PORT( pxSocket );
+
+    /* The socket options are passed to the IP layer in the
+     * space that will eventually get used by the Ethernet header. */
+    pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_OPTIONS_OFFSET ] = pxSocket->ucSocketOptions;
+
+    #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+        pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_DSCP_OFFSET ] = pxSocket->ucDSCP;
+    #endif
+
+    #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+        pxNetworkBuffer->ucTxTimestamp = ( pxSocket->u.xUDP.xTimestamping != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Forward a UDP packet to the IP-task, so it will be sent.
+ * @param[in] pxSocket  The socket on which a packet is sent.
+ * @param[in] pxNetworkBuffer  The packet to be sent.
+ * @param[in] uxTotalDataLength  The total number of payload bytes in the packet.
+ * @param[in] xFlags  The flag 'FREERTOS_ZERO_COPY' will be checked.
+ * @param[in] pxDestinationAddress  The address of the destination.
+ * @param[in] xTicksToWait  Number of ticks to wait, in case the IP-queue is full.
+ * @param[in] uxPayloadOffset  The number of bytes in the packet before the payload.
+ * @return The number of bytes sent on success, otherwise zero.
+ */
+static int32_t prvSendUDPPacket( const FreeRTOS_Socket_t * pxSocket,
+                                 NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                 size_t uxTotalDataLength,
+                                 BaseType_t xFlags,
+                                 const struct freertos_sockaddr * pxDestinationAddress,
+                                 TickType_t xTicksToWait,
+                                 size_t uxPayloadOffset )
+{
+    int32_t lReturn = 0;
+    IPStackEvent_t xStackTxEvent = { eStackTxEvent, NULL };
+    BaseType_t xSent = pdFAIL;
+
+    prvPrepareUDPPacket( pxSocket, pxNetworkBuffer, uxTotalDataLength, pxDestinationAddress, uxPayloadOffset );
+
+    #if ( ipconfigUSE_UDP_CONNECT != 0 )
+    {
+        if( xUDPConnectFillHeader( pxSocket, pxNetworkBuffer ) != pdFALSE )
+        {
+            /* The packet is sent to the peer of a connected socket: the
+             * IP-task only has to pass it to the driver. */
+            xStackTxEvent.eEventType = eStackTxReadyEvent;
+
+            #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+            {
+                if( pxSocket->u.xUDP.xDirectTx != pdFALSE )
+                {
+                    /* Or pass it to the driver right now. */
+                    xSent = xUDPConnectDirectOutput( pxNetworkBuffer );
+                }
+            }
+            #endif
+        }
+    }
+    #endif
+
+    if( xSent == pdFAIL )
+    {
+        /* Tell the networking task that the packet needs sending. */
+        xStackTxEvent.pvData = pxNetworkBuffer;
+
+        /* Ask the IP-task to send this packet */
+        xSent = xSendEventStructToIPTask( &xStackTxEvent, xTicksToWait );
+    }
+
+    if( xSent == pdPASS )
+    {
+        /* The packet was successfully sent to the IP task. */
+        lReturn = ( int32_t ) uxTotalDataLength;
+        #if ( ipconfigUSE_CALLBACKS == 1 )
+        {
+            if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xUDP.pxHandleSent ) )
+            {
+                pxSocket->u.xUDP.pxHandleSent( ( FreeRTOS_Socket_t * ) pxSocket, uxTotalDataLength );
+            }
+        }
+        #endif /* ipconfigUSE_CALLBACKS */
+    }
+    else
+    {
+        /* If the buffer was allocated in this function, release
+         * it. */
+        if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U )
+        {
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+
+        iptraceSTACK_TX_EVENT_LOST( ipSTACK_TX_EVENT );
+    }
+
+    return lReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by FreeRTOS_sendto(), it will actually send a UDP packet.
+ * @param[in] pxSocket The socket used for sending.
+ * @param[in] pvBuffer The character buffer as provided by the caller.
+ * @param[in] uxTotalDataLength The number of byte in the buffer.
+ * @param[in] xFlags The flags that were passed to FreeRTOS_sendto()
+ *                    It will test for FREERTOS_MSG_DONTWAIT and for
+ *                    FREERTOS_ZERO_COPY.
+ * @param[in] pxDestinationAddress The IP-address to which the packet must be sent.
+ * @param[in] uxPayloadOffset The calculated UDP payload offset, which depends
+ *                             on the IP type: IPv4 or IPv6.
+ * @return The number of bytes stored in the socket for transmission.
+ */
+static int32_t prvSendTo_ActualSend( const FreeRTOS_Socket_t * pxSocket,
+                                     const void * pvBuffer,
+                                     size_t uxTotalDataLength,
+                                     BaseType_t xFlags,
+                                     const struct freertos_sockaddr * pxDestinationAddress,
+                                     size_t uxPayloadOffset )
+{
+    int32_t lReturn = 0;
+    TickType_t xTicksToWait = pxSocket->xSendBlockTime;
+    TimeOut_t xTimeOut;
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+
+    if( ( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_MSG_DONTWAIT ) != 0U ) ||
+        ( xIsCallingFromIPTask() != pdFALSE ) )
+    {
+        /* The caller wants a non-blocking operation. When called by the IP-task,
+         * the operation should always be non-blocking. */
+        xTicksToWait = ( TickType_t ) 0U;
+    }
+
+    if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U )
+    {
+        /* Zero copy is not set, so obtain a network buffer into
+         * which the payload will be copied. */
+        vTaskSetTimeOutState( &xTimeOut );
+
+        /* Block until a buffer becomes available, or until a
+         * timeout has been reached */
+        pxNetworkBuffer = pxGetBulkNetworkBufferWithDescriptor( uxPayloadOffset + uxTotalDataLength, xTicksToWait );
+
+        if( pxNetworkBuffer != NULL )
+        {
+            void * pvCopyDest = ( void * ) &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] );
+            ( void ) memcpy( pvCopyDest, pvBuffer, uxTotalDataLength );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
+            {
+                /* The entire block time has been used up. */
+                xTicksToWait = ( TickType_t ) 0;
+            }
+        }
+    }
+    else
+    {
+        /* When zero copy is used, pvBuffer is a pointer to the
+         * payload of a buffer that has already been obtained from the
+         * stack.  Obtain the network buffer pointer from the buffer. */
+        pxNetworkBuffer = pxUDPPayloadBuffer_to_NetworkBuffer( pvBuffer );
+    }
+
+    if( pxNetworkBuffer != NULL )
+    {
+        pxNetworkBuffer->pxEndPoint = pxSocket->pxEndPoint;
+        lReturn = prvSendUDPPacket( pxSocket,
+                                    pxNetworkBuffer,
+                                    uxTotalDataLength,
+                                    xFlags,
+                                    pxDestinationAddress,
+                                    xTicksToWait,
+                                    uxPayloadOffset );
+    }
+    else
+    {
+        /* If errno was available, errno would be set to
+         * FREERTOS_ENOPKTS.  As it is, the function must return the
+         * number of transmitted bytes, so the calling function knows
+         * how  much data was actually sent. */
+        iptraceNO_BUFFER_FOR_SENDTO();
+    }
+
+    return lReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_UDP_GSO != 0 )
+
+/**
+ * @brief Called by FreeRTOS_sendto() for a socket that has set
+ *        FREERTOS_SO_UDP_SEGMENT. The buffer is split in datagrams of
+ *        uxSegmentSize bytes, the last one may be shorter. The datagrams
+ *        are chained and passed to the IP-task as one eStackTxBatchEvent.
+ * @param[in] pxSocket The socket used for sending.
+ * @param[in] pvBuffer The character buffer as provided by the caller.
+ * @param[in] uxTotalDataLength The number of byte in the buffer.
+ * @param[in] xFlags The flags that were passed to FreeRTOS_sendto()
+ *                    It will test for FREERTOS_MSG_DONTWAIT.
+ * @param[in] pxDestinationAddress The IP-address to which the packets must be sent.
+ * @param[in] uxPayloadOffset The calculated UDP payload offset.
+ * @param[in] uxSegmentSize The number of payload bytes in each datagram.
+ * @return The number of bytes passed to the IP-task. When the network buffers
+ *         run out, only the datagrams that were filled are sent.
+ */
+    static int32_t prvSendTo_Segmented( const FreeRTOS_Socket_t * pxSocket,
+                                        const void * pvBuffer,
+                                        size_t uxTotalDataLength,
+                                        BaseType_t xFlags,
+                                        const struct freertos_sockaddr * pxDestinationAddress,
+                                        size_t uxPayloadOffset,
+                                        size_t uxSegmentSize )
+    {
+        int32_t lReturn = 0;
+        IPStackEvent_t xStackTxEvent = { eStackTxBatchEvent, NULL };
+        NetworkBufferDescriptor_t * pxFirstBuffer = NULL;
+        NetworkBufferDescriptor_t * pxLastBuffer = NULL;
+        NetworkBufferDescriptor_t * pxNetworkBuffer;
+        NetworkBufferDescriptor_t * pxNextBuffer;
+        const uint8_t * pucSource = ( const uint8_t * ) pvBuffer;
+        TickType_t xTicksToWait = pxSocket->xSendBlockTime;
+        TimeOut_t xTimeOut;
+        size_t uxOffset = 0U;
+        size_t uxLength;
+
+        if( ( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_MSG_DONTWAIT ) != 0U ) ||
+            ( xIsCallingFromIPTask() != pdFALSE ) )
+        {
+            xTicksToWait = ( TickType_t ) 0U;
+        }
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        while( uxOffset < uxTotalDataLength )
+        {
+            uxLength = FreeRTOS_min_size_t( uxSegmentSize, uxTotalDataLength - uxOffset );
+            pxNetworkBuffer = pxGetBulkNetworkBufferWithDescriptor( uxPayloadOffset + uxLength, xTicksToWait );
+
+            if( pxNetworkBuffer == NULL )
+            {
+                iptraceNO_BUFFER_FOR_SENDTO();
+                break;
+            }
+
+            ( void ) memcpy( &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] ), &( pucSource[ uxOffset ] ), uxLength );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
+            {
+                xTicksToWait = ( TickType_t ) 0;
+            }
+
+            pxNetworkBuffer->pxEndPoint = pxSocket->pxEndPoint;
+            prvPrepareUDPPacket( pxSocket, pxNetworkBuffer, uxLength, pxDestinationAddress, uxPayloadOffset );
+            pxNetworkBuffer->pxNextBuffer = NULL;
+
+            if( pxLastBuffer == NULL )
+            {
+                pxFirstBuffer = pxNetworkBuffer;
+            }
+            else
+            {
+                pxLastBuffer->pxNextBuffer = pxNetworkBuffer;
+            }
+
+            pxLastBuffer = pxNetworkBuffer;
+            uxOffset += uxLength;
+        }
+
+        if( pxFirstBuffer != NULL )
+        {
+            xStackTxEvent.pvData = pxFirstBuffer;
+
+            if( xSendEventStructToIPTask( &xStackTxEvent, xTicksToWait ) == pdPASS )
+            {
+                lReturn = ( int32_t ) uxOffset;
+
+                #if ( ipconfigUSE_CALLBACKS == 1 )
+                {
+                    if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xUDP.pxHandleSent ) )
+                    {
+                        pxSocket->u.xUDP.pxHandleSent( ( FreeRTOS_Socket_t * ) pxSocket, uxOffset );
+                    }
+                }
+                #endif /* ipconfigUSE_CALLBACKS */
+            }
+            else
+            {
+                /* Give back the buffers that were allocated here. */
+                pxNetworkBuffer = pxFirstBuffer;
+
+                while( pxNetworkBuffer != NULL )
+                {
+                    pxNextBuffer = pxNetworkBuffer->pxNextBuffer;
+                    pxNetworkBuffer->pxNextBuffer = NULL;
+                    vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+                    pxNetworkBuffer = pxNextBuffer;
+                }
+
+                iptraceSTACK_TX_EVENT_LOST( ipSTACK_TX_EVENT );
+            }
+        }
+
+        return lReturn;
+    }
+
+#endif /* ( ipconfigUSE_UDP_GSO != 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the offset of the UDP payload in a packet, and the maximum
+ *        payload length, for a given address family.
+ * @param[in] pxSocket The sending socket, its end-point may limit the MTU.
+ * @param[in] ucFamily The address family of the destination.
+ * @param[out] puxMaxPayloadLength The maximum number of payload bytes.
+ * @return The offset of the payload, or zero when the family is not supported.
+ */
+static size_t prvUDPPayloadOffset( const FreeRTOS_Socket_t * pxSocket,
+                                   uint8_t ucFamily,
+                                   size_t * puxMaxPayloadLength )
+{
+    size_t uxPayloadOffset = 0U;
+    size_t uxMTU = ipconfigNETWORK_MTU;
+
+    #if ( ipconfigUSE_INTERFACE_MTU != 0 )
+        if( pxSocket->pxEndPoint != NULL )
+        {
+            uxMTU = uxInterfaceMTU( pxSocket->pxEndPoint->pxNetworkInterface );
+        }
+    #else
+        ( void ) pxSocket;
+    #endif
+
+    #if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+        if( xBufferAllocFixedSize == pdFALSE )
+        {
+            /* Datagrams larger than the MTU are sent in fragments. */
+            uxMTU = ipconfigIP_FRAGMENTATION_MAX_SIZE;
+        }
+    #endif
+
+    switch( ucFamily )
+    {
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case FREERTOS_AF_INET6:
+                *puxMaxPayloadLength = uxMTU - ( ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER );
+                uxPayloadOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER;
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case FREERTOS_AF_INET4:
+                *puxMaxPayloadLength = uxMTU - ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER );
+                uxPayloadOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER;
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        default:
+            /* MISRA 16.4 Compliance */
+            *puxMaxPayloadLength = 0U;
+            break;
+    }
+
+    return uxPayloadOffset;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send data to a socket. The socket must have already been created by a
+ *        successful call to FreeRTOS_socket(). It works for UDP-sockets only.
+ *
+ * @param[in] xSocket The socket being sent to.
+ * @param[in] pvBuffer Pointer to the data being sent.
+ * @param[in] uxTotalDataLength Length (in bytes) of the data being sent.
+ * @param[in] xFlags Flags used to communicate preferences to the function.
+ *                    Possibly FREERTOS_MSG_DONTWAIT and/or FREERTOS_ZERO_COPY.
+ * @param[in] pxDestinationAddress The address to which the data is to be sent.
+ *                                  May be NULL for a UDP socket that was
+ *                                  connected with FreeRTOS_connect().
+ * @param[in] xDestinationAddressLength This parameter is present to adhere to the
+ *                  Berkeley sockets standard. Else, it is not used.
+ *
+ * When the socket has set FREERTOS_SO_UDP_SEGMENT, a buffer that is longer
+ * than the segment size is sent as several datagrams of that size.
+ *
+ * @return When positive: the total number of bytes sent, when negative an error
+ *         has occurred: it can be looked-up in 'FreeRTOS-Kernel/projdefs.h'.
+ */
+int32_t FreeRTOS_sendto( Socket_t xSocket,
+                         const void * pvBuffer,
+                         size_t uxTotalDataLength,
+                         BaseType_t xFlags,
+                         const struct freertos_sockaddr * pxDestinationAddress,
+                         socklen_t xDestinationAddressLength )
+{
+    int32_t lReturn = 0;
+    FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+    size_t uxMaxPayloadLength = 0;
+    size_t uxPayloadOffset = 0;
+
+    #if ( ipconfigUSE_UDP_GSO != 0 )
+        size_t uxSegmentSize = 0U;
+    #endif
+
+    #if ( ipconfigUSE_UDP_CONNECT != 0 )
+    {
+        if( ( pxDestinationAddress == NULL ) &&
+            ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP ) &&
+            ( pxSocket->u.xUDP.xConnected != pdFALSE ) )
+        {
+            /* Send to the peer that was set by FreeRTOS_connect(). */
+            pxDestinationAddress = &( pxSocket->u.xUDP.xRemoteAddress );
+        }
+    }
+    #endif
+
+    #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
+        struct freertos_sockaddr xTempDestinationAddress;
+
+        if( ( pxDestinationAddress != NULL ) && ( pxDestinationAddress->sin_family != FREERTOS_AF_INET6 ) && ( pxDestinationAddress->sin_family != FREERTOS_AF_INET ) )
+        {
+            ( void ) memcpy( &xTempDestinationAddress, pxDestinationAddress, sizeof( struct freertos_sockaddr ) );
+
+            /* Default to FREERTOS_AF_INET family if either FREERTOS_AF_INET6/FREERTOS_AF_INET
+             *  is not specified in sin_family, if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled. */
+            xTempDestinationAddress.sin_family = FREERTOS_AF_INET;
+            pxDestinationAddress = &xTempDestinationAddress;
+        }
+    #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+
+    #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+        struct freertos_sockaddr xIPv4DestinationAddress;
+
+        if( prvSocketUnmapAddress( pxSocket, pxDestinationAddress, &( xIPv4DestinationAddress ) ) != pdFALSE )
+        {
+            /* An IPv4-mapped destination is reached through IPv4. */
+            pxDestinationAddress = &( xIPv4DestinationAddress );
+        }
+    #endif /* ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 ) */
+
+    /* The function prototype is designed to maintain the expected Berkeley
+     * sockets standard, but this implementation does not use all the
+     * parameters. */
+    ( void ) xDestinationAddressLength;
+    configASSERT( pxDestinationAddress != NULL );
+    configASSERT( pvBuffer != NULL );
+
+    uxPayloadOffset = prvUDPPayloadOffset( pxSocket, pxDestinationAddress->sin_family, &( uxMaxPayloadLength ) );
+
+    if( uxPayloadOffset == 0U )
+    {
+        FreeRTOS_debug_printf( ( "FreeRTOS_sendto: Undefined sin_family \n" ) );
+        lReturn = -pdFREERTOS_ERRNO_EINVAL;
+    }
+
+    #if ( ipconfigUSE_UDP_GSO != 0 )
+    {
+        if( ( lReturn == 0 ) &&
+            ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP ) &&
+            ( pxSocket->u.xUDP.usSegmentSize != 0U ) &&
+            ( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U ) )
+        {
+            /* The data may be split in several datagrams. */
+            uxSegmentSize = FreeRTOS_min_size_t( ( size_t ) pxSocket->u.xUDP.usSegmentSize, uxMaxPayloadLength );
+            uxMaxPayloadLength = uxSegmentSize * ( size_t ) ipconfigUDP_GSO_MAX_SEGMENTS;
+        }
+    }
+    #endif /* ( ipconfigUSE_UDP_GSO != 0 ) */
+
+    if( lReturn == 0 )
+    {
+        if( uxTotalDataLength <= ( size_t ) uxMaxPayloadLength )
+        {
+            /* If the socket is not already bound to an address, bind it now.
+             * Passing NULL as the address parameter tells FreeRTOS_bind() to select
+             * the address to bind to. */
+            if( prvMakeSureSocketIsBound( pxSocket ) == pdTRUE )
+            {
+                #if ( ipconfigUSE_UDP_GSO != 0 )
+                    if( ( uxSegmentSize != 0U ) && ( uxTotalDataLength > uxSegmentSize ) )
+                    {
+                        lReturn = prvSendTo_Segmented( pxSocket, pvBuffer, uxTotalDataLength, xFlags, pxDestinationAddress, uxPayloadOffset, uxSegmentSize );
+                    }
+                    else
+                #endif
+                {
+                    lReturn = prvSendTo_ActualSend( pxSocket, pvBuffer, uxTotalDataLength, xFlags, pxDestinationAddress, uxPayloadOffset );
+                }
+            }
+            else
+            {
+                /* No comment. */
+                iptraceSENDTO_SOCKET_NOT_BOUND();
+            }
+        }
+        else
+        {
+            /* The data is longer than the available buffer space. */
+            iptraceSENDTO_DATA_TOO_LONG();
+        }
+    }
+
+    return lReturn;
+} /* Tested */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigSUPPORT_SENDMMSG != 0 )
+
+/**
+ * @brief Send several datagrams from a UDP socket. The packets are chained
+ *        through 'pxNextBuffer' and passed to the IP-task as one
+ *        eStackTxBatchEvent, which is processed in a single pass.
+ *
+ * @param[in] xSocket The UDP socket.
+ * @param[in,out] pxMessages An array of message headers. pvBuffer,
+ *                           uxBufferLength and xAddress are supplied by
+ *                           the caller, lLength is filled in.
+ * @param[in] uxMessageCount The number of entries in pxMessages.
+ * @param[in] xFlags FREERTOS_ZERO_COPY and FREERTOS_MSG_DONTWAIT are tested.
+ *
+ * @return The number of datagrams that were passed to the IP-task, counted
+ *         from the start of the array, or a negative error code. Sending
+ *         stops at the first datagram that is too long, has an unknown
+ *         address family or for which no network buffer is available.
+ *         When zero-copy is used, the buffers of the datagrams that were
+ *         not sent remain owned by the caller.
+ */
+    int32_t FreeRTOS_sendmmsg( Socket_t xSocket,
+                               FreeRTOS_MMsgHdr_t * pxMessages,
+                               size_t uxMessageCount,
+                               BaseType_t xFlags )
+    {
+        int32_t lReturn = 0;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        IPStackEvent_t xStackTxEvent = { eStackTxBatchEvent, NULL };
+        NetworkBufferDescriptor_t * pxFirstBuffer = NULL;
+        NetworkBufferDescriptor_t * pxLastBuffer = NULL;
+        NetworkBufferDescriptor_t * pxNetworkBuffer;
+        NetworkBufferDescriptor_t * pxNextBuffer;
+        struct freertos_sockaddr xDestinationAddress;
+        TickType_t xTicksToWait;
+        TimeOut_t xTimeOut;
+        size_t uxMaxPayloadLength = 0U;
+        size_t uxPayloadOffset;
+        size_t uxCount = 0U;
+        size_t uxIndex;
+
+        if( ( prvValidSocket( pxSocket, FREERTOS_IPPROTO_UDP, pdFALSE ) == pdFALSE ) ||
+            ( pxMessages == NULL ) )
+        {
+            lReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else if( prvMakeSureSocketIsBound( pxSocket ) == pdFALSE )
+        {
+            iptraceSENDTO_SOCKET_NOT_BOUND();
+        }
+        else
+        {
+            xTicksToWait = pxSocket->xSendBlockTime;
+
+            if( ( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_MSG_DONTWAIT ) != 0U ) ||
+                ( xIsCallingFromIPTask() != pdFALSE ) )
+            {
+                xTicksToWait = ( TickType_t ) 0U;
+            }
+
+            vTaskSetTimeOutState( &xTimeOut );
+
+            for( uxIndex = 0U; uxIndex < uxMessageCount; uxIndex++ )
+            {
+                pxMessages[ uxIndex ].lLength = 0;
+                ( void ) memcpy( &( xDestinationAddress ), &( pxMessages[ uxIndex ].xAddress ), sizeof( xDestinationAddress ) );
+
+                #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
+                    if( ( xDestinationAddress.sin_family != FREERTOS_AF_INET6 ) && ( xDestinationAddress.sin_family != FREERTOS_AF_INET ) )
+                    {
+                        xDestinationAddress.sin_family = FREERTOS_AF_INET;
+                    }
+                #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+
+                #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                    ( void ) prvSocketUnmapAddress( pxSocket, &( pxMessages[ uxIndex ].xAddress ), &( xDestinationAddress ) );
+                #endif
+
+                uxPayloadOffset = prvUDPPayloadOffset( pxSocket, xDestinationAddress.sin_family, &( uxMaxPayloadLength ) );
+
+                if( ( uxPayloadOffset == 0U ) || ( pxMessages[ uxIndex ].uxBufferLength > uxMaxPayloadLength ) )
+                {
+                    iptraceSENDTO_DATA_TOO_LONG();
+                    break;
+                }
+
+                if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U )
+                {
+                    pxNetworkBuffer = pxGetBulkNetworkBufferWithDescriptor( uxPayloadOffset + pxMessages[ uxIndex ].uxBufferLength, xTicksToWait );
+
+                    if( pxNetworkBuffer != NULL )
+                    {
+                        ( void ) memcpy( &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] ), pxMessages[ uxIndex ].pvBuffer, pxMessages[ uxIndex ].uxBufferLength );
+                    }
+
+                    if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
+                    {
+                        xTicksToWait = ( TickType_t ) 0;
+                    }
+                }
+                else
+                {
+                    pxNetworkBuffer = pxUDPPayloadBuffer_to_NetworkBuffer( pxMessages[ uxIndex ].pvBuffer );
+                }
+
+                if( pxNetworkBuffer == NULL )
+                {
+                    iptraceNO_BUFFER_FOR_SENDTO();
+                    break;
+                }
+
+                pxNetworkBuffer->pxEndPoint = pxSocket->pxEndPoint;
+                prvPrepareUDPPacket( pxSocket, pxNetworkBuffer, pxMessages[ uxIndex ].uxBufferLength, &( xDestinationAddress ), uxPayloadOffset );
+                pxNetworkBuffer->pxNextBuffer = NULL;
+
+                if( pxLastBuffer == NULL )
+                {
+                    pxFirstBuffer = pxNetworkBuffer;
+                }
+                else
+                {
+                    pxLastBuffer->pxNextBuffer = pxNetworkBuffer;
+                }
+
+                pxLastBuffer = pxNetworkBuffer;
+                uxCount++;
+            }
+
+            if( pxFirstBuffer != NULL )
+            {
+                xStackTxEvent.pvData = pxFirstBuffer;
+
+                if( xSendEventStructToIPTask( &xStackTxEvent, xTicksToWait ) == pdPASS )
+                {
+                    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+                    {
+                        pxMessages[ uxIndex ].lLength = ( int32_t ) pxMessages[ uxIndex ].uxBufferLength;
+
+                        #if ( ipconfigUSE_CALLBACKS == 1 )
+                        {
+                            if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xUDP.pxHandleSent ) )
+                            {
+                                pxSocket->u.xUDP.pxHandleSent( pxSocket, pxMessages[ uxIndex ].uxBufferLength );
+                            }
+                        }
+                        #endif /* ipconfigUSE_CALLBACKS */
+                    }
+
+                    lReturn = ( int32_t ) uxCount;
+                }
+                else
+                {
+                    /* Give back the buffers that were allocated here. */
+                    pxNetworkBuffer = pxFirstBuffer;
+
+                    while( pxNetworkBuffer != NULL )
+                    {
+                        pxNextBuffer = pxNetworkBuffer->pxNextBuffer;
+                        pxNetworkBuffer->pxNextBuffer = NULL;
+
+                        if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U )
+                        {
+                            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+                        }
+
+                        pxNetworkBuffer = pxNextBuffer;
+                    }
+
+                    iptraceSTACK_TX_EVENT_LOST( ipSTACK_TX_EVENT );
+                }
+            }
+        }
+
+        return lReturn;
+    }
+
+#endif /* ( ipconfigSUPPORT_SENDMMSG != 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief binds a socket to a local port number. If port 0 is provided,
+ *        a system provided port number will be assigned. This function
+ *        can be used for both UDP and TCP sockets. The actual binding
+ *        will be performed by the IP-task to avoid mutual access to the
+ *        bound-socket-lists (xBoundUDPSocketsList or xBoundTCPSocketsList).
+ *
+ * @param[in] xSocket The socket being bound.
+ * @param[in] pxAddress The address struct carrying the port number to which
+ *                       this socket is to be bound.
+ * @param[in] xAddressLength This parameter is not used internally. The
+ *                       function signature is used to adhere to standard
+ *                       Berkeley sockets API.
+ *
+ * @return The return value is 0 if the bind is successful.
+ *         If some error occurred, then a negative value is returned.
+ */
+BaseType_t FreeRTOS_bind( Socket_t xSocket,
+                          struct freertos_sockaddr const * pxAddress,
+                          socklen_t xAddressLength )
+{
+    IPStackEvent_t xBindEvent;
+    FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+    BaseType_t xReturn = 0;
+
+    #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
+        struct freertos_sockaddr xTempAddress;
+
+        if( ( pxAddress != NULL ) && ( pxAddress->sin_family != FREERTOS_AF_INET6 ) && ( pxAddress->sin_family != FREERTOS_AF_INET ) )
+        {
+            ( void ) memcpy( &xTempAddress, pxAddress, sizeof( struct freertos_sockaddr ) );
+
+            /* Default to FREERTOS_AF_INET family if either FREERTOS_AF_INET6/FREERTOS_AF_INET
+             *  is not specified in sin_family, if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled. */
+            xTempAddress.sin_family = FREERTOS_AF_INET;
+            pxAddress = &xTempAddress;
+        }
+    #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+
+    ( void ) xAddressLength;
+
+    configASSERT( xIsCallingFromIPTask() == pdFALSE );
+
+    if( xSocketValid( pxSocket ) == pdFALSE )
+    {
+        xReturn = -pdFREERTOS_ERRNO_EINVAL;
+    }
+
+    /* Once a socket is bound to a port, it can not be bound to a different
+     * port number */
+    else if( socketSOCKET_IS_BOUND( pxSocket ) )
+    {
+        /* The socket is already bound. */
+        FreeRTOS_debug_printf( ( "vSocketBind: Socket already bound to %d\n", pxSocket->usLocalPort ) );
+        xReturn = -pdFREERTOS_ERRNO_EINVAL;
+    }
+    else
+    {
+        /* Prepare a messages to the IP-task in order to perform the binding.
+         * The desired port number will be passed in usLocalPort. */
+        xBindEvent.eEventType = eSocketBindEvent;
+        xBindEvent.pvData = xSocket;
+
+        if( pxAddress != NULL )
+        {
+            switch( pxAddress->sin_family )
+            {
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    case FREERTOS_AF_INET6:
+                        ( void ) memcpy( pxSocket->xLocalAddress.xIP_IPv6.ucBytes, pxAddress->sin_address.xIP_IPv6.ucBytes, sizeof( pxSocket->xLocalAddress.xIP_IPv6.ucBytes ) );
+                        pxSocket->bits.bIsIPv6 = pdTRUE_UNSIGNED;
+                        break;
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    case FREERTOS_AF_INET4:
+                        pxSocket->xLocalAddress.ulIP_IPv4 = FreeRTOS_ntohl( pxAddress->sin_address.ulIP_IPv4 );
+                        pxSocket->bits.bIsIPv6 = pdFALSE_UNSIGNED;
+                        break;
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                default:
+                    FreeRTOS_debug_printf( ( "FreeRTOS_bind: Undefined sin_family \n" ) );
+                    break;
+            }
+
+            pxSocket->usLocalPort = FreeRTOS_ntohs( pxAddress->sin_port );
+        }
+        else
+        {
+            /* Caller wants to bind to a random port number. */
+            pxSocket->usLocalPort = 0U;
+            ( void ) memset( pxSocket->xLocalAddress.xIP_IPv6.ucBytes, 0, sizeof( pxSocket->xLocalAddress.xIP_IPv6.ucBytes ) );
+        }
+
+        #if ( ipconfigUDP_DIRECT_BIND == 1 )
+            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+            {
+                /* UDP sockets can be bound without a round trip to the IP-task. */
+                xReturn = prvSocketBindDirect( pxSocket, pxAddress );
+            }
+            else
+        #endif /* ipconfigUDP_DIRECT_BIND == 1 */
+
+        /* portMAX_DELAY is used as a the time-out parameter, as binding *must*
+         * succeed before the socket can be used.  _RB_ The use of an infinite
+         * block time needs be changed as it could result in the task hanging. */
+        if( xSendEventStructToIPTask( &xBindEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
+        {
+            /* Failed to wake-up the IP-task, no use to wait for it */
+            FreeRTOS_debug_printf( ( "FreeRTOS_bind: send event failed\n" ) );
+            xReturn = -pdFREERTOS_ERRNO_ECANCELED;
+        }
+        else
+        {
+            /* The IP-task will set the 'eSOCKET_BOUND' bit when it has done its
+             * job. */
+            ( void ) xSocketEventWait( pxSocket, ( EventBits_t ) eSOCKET_BOUND, pdTRUE /*xClearOnExit*/, portMAX_DELAY );
+
+            if( !socketSOCKET_IS_BOUND( pxSocket ) )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            }
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUDP_DIRECT_BIND == 1 )
+
+/**
+ * @brief Bind a UDP socket in the context of the calling task. The IP-task
+ *        suspends the scheduler while it changes the lists of bound sockets,
+ *        so the port can be checked and claimed here with the scheduler
+ *        suspended.
+ *
+ * @param[in] pxSocket The socket to be bound.
+ * @param[in] pxAddress The address to bind to, or NULL for any address and
+ *                      a random port number.
+ *
+ * @return 0 when the socket was bound, or else a negative errno value.
+ */
+    static BaseType_t prvSocketBindDirect( FreeRTOS_Socket_t * pxSocket,
+                                           struct freertos_sockaddr const * pxAddress )
+    {
+        struct freertos_sockaddr xAddress;
+        BaseType_t xReturn = 0;
+
+        if( pxAddress != NULL )
+        {
+            ( void ) memcpy( &( xAddress ), pxAddress, sizeof( xAddress ) );
+        }
+        else
+        {
+            ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+            xAddress.sin_family = ( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED ) ? FREERTOS_AF_INET6 : FREERTOS_AF_INET;
+        }
+
+        /* 'xLocalAddress' and 'usLocalPort' will be set again by prvSocketBindAdd(). */
+        pxSocket->usLocalPort = 0U;
+
+        if( xAddress.sin_port == 0U )
+        {
+            /* Draw the random number before the scheduler is suspended. */
+            xAddress.sin_port = prvGetPrivatePortNumber( ( BaseType_t ) FREERTOS_IPPROTO_UDP );
+
+            if( xAddress.sin_port == 0U )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EADDRNOTAVAIL;
+            }
+        }
+
+        if( xReturn == 0 )
+        {
+            vTaskSuspendAll();
+            {
+                /* Test the port first, so that prvSocketBindAdd() will not
+                 * log while the scheduler is suspended. */
+                if( prvSocketPortInUse( pxSocket, &xBoundUDPSocketsList, xAddress.sin_port ) != pdFALSE )
+                {
+                    xReturn = -pdFREERTOS_ERRNO_EADDRINUSE;
+                }
+                else
+                {
+                    xReturn = prvSocketBindAdd( pxSocket, &( xAddress ), &xBoundUDPSocketsList, pdFALSE );
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( xReturn == -pdFREERTOS_ERRNO_EADDRINUSE )
+            {
+                FreeRTOS_debug_printf( ( "FreeRTOS_bind: UDP port %d in use\n", FreeRTOS_ntohs( xAddress.sin_port ) ) );
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* ipconfigUDP_DIRECT_BIND == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) )
+
+/**
+ * @brief Check if a socket has set the option FREERTOS_SO_REUSEPORT.
+ *
+ * @param[in] pxSocket The socket to be checked.
+ *
+ * @return pdTRUE when the socket may share its port with other sockets.
+ */
+    static BaseType_t prvSocketSharesPort( const FreeRTOS_Socket_t * pxSocket )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        #if ( ipconfigUSE_UDP_REUSEPORT != 0 )
+            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+            {
+                xReturn = pxSocket->u.xUDP.xReusePort;
+            }
+        #endif
+
+        #if ( ipconfigUSE_TCP_REUSEPORT != 0 )
+            if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) &&
+                ( pxSocket->u.xTCP.bits.bReusePort != pdFALSE_UNSIGNED ) )
+            {
+                xReturn = pdTRUE;
+            }
+        #endif
+
+        return xReturn;
+    }
+
+#endif /* ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a port number is already taken by another socket.
+ * @param[in] pxSocket  The socket that is about to be bound.
+ * @param[in] pxSocketList  will either point to xBoundUDPSocketsList or
+ *                           xBoundTCPSocketsList.
+ * @param[in] usPort  The port number in network-byte-order.
+ * @return pdTRUE when the port can not be used by 'pxSocket'.
+ */
+static BaseType_t prvSocketPortInUse( const FreeRTOS_Socket_t * pxSocket,
+                                      const List_t * pxSocketList,
+                                      uint16_t usPort )
+{
+    BaseType_t xReturn = pdFALSE;
+    const ListItem_t * pxListItem = pxListFindListItemWithValue( pxSocketList, ( TickType_t ) usPort );
+
+    if( pxListItem != NULL )
+    {
+        xReturn = pdTRUE;
+
+        #if ( ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) )
+        {
+            const FreeRTOS_Socket_t * pxOwner = ( ( const FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxListItem ) );
+
+            /* A socket that does not share its port can only be bound to a free
+             * port, so checking the first socket found is enough.  The child
+             * sockets of a TCP listening socket inherit its option. */
+            if( ( prvSocketSharesPort( pxSocket ) != pdFALSE ) &&
+                ( prvSocketSharesPort( pxOwner ) != pdFALSE ) )
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        #else
+        {
+            ( void ) pxSocket;
+        }
+        #endif /* ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) */
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief : Bind a socket to a port number.
+ * @param[in] pxSocket  The socket to be bound.
+ * @param[in] pxAddress  The socket will be bound to this address.
+ * @param[in] pxSocketList  will either point to xBoundUDPSocketsList or
+ *                           xBoundTCPSocketsList.
+ * @param[in] xInternal  pdTRUE if this function is called 'internally', i.e.
+ *                        by the IP-task.
+ */
+static BaseType_t prvSocketBindAdd( FreeRTOS_Socket_t * pxSocket,
+                                    const struct freertos_sockaddr * pxAddress,
+                                    List_t * pxSocketList,
+                                    BaseType_t xInternal )
+{
+    BaseType_t xReturn = 0;
+
+    /* Check to ensure the port is not already in use.  If the bind is
+     * called internally, a port MAY be used by more than one socket. */
+    if( ( ( xInternal == pdFALSE ) || ( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP ) ) &&
+        ( prvSocketPortInUse( pxSocket, pxSocketList, pxAddress->sin_port ) != pdFALSE ) )
+    {
+        FreeRTOS_debug_printf( ( "vSocketBind: %sP port %d in use\n",
+                                 ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) ? "TC" : "UD",
+                                 FreeRTOS_ntohs( pxAddress->sin_port ) ) );
+        xReturn = -pdFREERTOS_ERRNO_EADDRINUSE;
+    }
+    else
+    {
+        /* Allocate the port number to the socket.
+         * This macro will set 'xBoundSocketListItem->xItemValue' */
+        socketSET_SOCKET_PORT( pxSocket, pxAddress->sin_port );
+
+        /* And also store it in a socket field 'usLocalPort' in host-byte-order,
+         * mostly used for logging and debugging purposes */
+        pxSocket->usLocalPort = FreeRTOS_ntohs( pxAddress->sin_port );
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            if( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
+            {
+                ( void ) memcpy( pxSocket->xLocalAddress.xIP_IPv6.ucBytes, pxAddress->sin_address.xIP_IPv6.ucBytes, sizeof( pxSocket->xLocalAddress.xIP_IPv6.ucBytes ) );
+            }
+            else
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        {
+            #if ( ipconfigUSE_IPv4 != 0 )
+                if( pxAddress->sin_address.ulIP_IPv4 != FREERTOS_INADDR_ANY )
+                {
+                    pxSocket->pxEndPoint = FreeRTOS_FindEndPointOnIP_IPv4( pxAddress->sin_address.ulIP_IPv4 );
+                }
+                else
+            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+            {
+                /* Place holder, do nothing, MISRA compliance */
+            }
+        }
+
+        #if ( ipconfigUSE_IPv4 != 0 )
+            if( pxSocket->pxEndPoint != NULL )
+            {
+                pxSocket->xLocalAddress.ulIP_IPv4 = FreeRTOS_ntohl( pxSocket->pxEndPoint->ipv4_settings.ulIPAddress );
+            }
+            else
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+        #if ( ipconfigUSE_IPv6 != 0 )
+            if( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
+            {
+                /* Socket address was set, do nothing for IPv6. */
+            }
+            else
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        {
+            ( void ) memset( pxSocket->xLocalAddress.xIP_IPv6.ucBytes, 0, sizeof( pxSocket->xLocalAddress.xIP_IPv6.ucBytes ) );
+        }
+
+        /* Add the socket to the list of bound ports. */
+        {
+            /* If the network driver can iterate through 'xBoundUDPSocketsList',
+             * by calling xPortHasUDPSocket() then the IP-task must temporarily
+             * suspend the scheduler to keep the list in a consistent state.
+             * The same holds when user tasks scan or change the lists, see
+             * socketLOCK_BOUND_LISTS. */
+            #if ( socketLOCK_BOUND_LISTS != 0 )
+            {
+                vTaskSuspendAll();
+            }
+            #endif /* socketLOCK_BOUND_LISTS */
+
+            /* Add the socket to 'xBoundUDPSocketsList' or 'xBoundTCPSocketsList' */
+            vListInsertEnd( pxSocketList, &( pxSocket->xBoundSocketListItem ) );
+
+            #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+            {
+                prvSocketHashInsert( pxSocket );
+            }
+            #endif
+
+            #if ( socketLOCK_BOUND_LISTS != 0 )
+            {
+                ( void ) xTaskResumeAll();
+            }
+            #endif /* socketLOCK_BOUND_LISTS */
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Internal version of bind() that should not be called directly.
+ *        'xInternal' is used for TCP sockets only: it allows to have several
+ *        (connected) child sockets bound to the same server port.
+ *
+ * @param[in] pxSocket The socket is to be bound.
+ * @param[in] pxBindAddress The port to which this socket should be bound.
+ * @param[in] uxAddressLength The address length.
+ * @param[in] xInternal pdTRUE is calling internally, else pdFALSE.
+ *
+ * @return If the socket was bound to a port successfully, then a 0 is returned.
+ *         Or else, an error code is returned.
+ */
+BaseType_t vSocketBind( FreeRTOS_Socket_t * pxSocket,
+                        struct freertos_sockaddr * pxBindAddress,
+                        size_t uxAddressLength,
+                        BaseType_t xInternal )
+{
+    BaseType_t xReturn = 0; /* In Berkeley sockets, 0 means pass for bind(). */
+    List_t * pxSocketList;
+    struct freertos_sockaddr * pxAddress = pxBindAddress;
+
+    #if ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 1 )
+        struct freertos_sockaddr xAddress;
+    #endif /* ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND */
+
+    configASSERT( xSocketValid( pxSocket ) == pdTRUE );
+
+    #if ( ipconfigUSE_TCP == 1 )
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            pxSocketList = &xBoundTCPSocketsList;
+        }
+        else
+    #endif /* ipconfigUSE_TCP == 1 */
+    {
+        pxSocketList = &xBoundUDPSocketsList;
+    }
+
+    /* The function prototype is designed to maintain the expected Berkeley
+     * sockets standard, but this implementation does not use all the parameters. */
+    ( void ) uxAddressLength;
+
+    #if ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 1 )
+    {
+        /* pxAddress will be NULL if sendto() was called on a socket without the
+         * socket being bound to an address. In this case, automatically allocate
+         * an address to the socket.  There is a small chance that the allocated
+         * port will already be in use - if that is the case, then the check below
+         * [pxListFindListItemWithValue()] will result in an error being returned. */
+        if( pxAddress == NULL )
+        {
+            pxAddress = &xAddress;
+            /* Clear the address: */
+            ( void ) memset( pxAddress, 0, sizeof( struct freertos_sockaddr ) );
+
+            if( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED )
+            {
+                pxAddress->sin_family = FREERTOS_AF_INET6;
+            }
+            else
+            {
+                pxAddress->sin_family = FREERTOS_AF_INET;
+            }
+        }
+    }
+    #endif /* ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 1 */
+
+    /* Sockets must be bound before calling FreeRTOS_sendto() if
+    * ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND is not set to 1. */
+    configASSERT( pxAddress != NULL );
+
+    #if ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 1 )
+        /* pxAddress is not NULL, no testing needed. */
+    #else
+        if( pxAddress != NULL )
+    #endif
+    {
+        /* Add a do-while loop to facilitate use of 'break' statements. */
+        do
+        {
+            if( pxAddress->sin_port == 0U )
+            {
+                pxAddress->sin_port = prvGetPrivatePortNumber( ( BaseType_t ) pxSocket->ucProtocol );
+
+                if( pxAddress->sin_port == ( uint16_t ) 0U )
+                {
+                    xReturn = -pdFREERTOS_ERRNO_EADDRNOTAVAIL;
+                    break;
+                }
+            }
+
+            /* If vSocketBind() is called from the API FreeRTOS_bind() it has been
+             * confirmed that the socket was not yet bound to a port.  If it is called
+             * from the IP-task, no such check is necessary. */
+
+            xReturn = prvSocketBindAdd( pxSocket, pxAddress, pxSocketList, xInternal );
+        } while( ipFALSE_BOOL );
+    }
+
+    #if ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 0 )
+        else
+        {
+            xReturn = -pdFREERTOS_ERRNO_EADDRNOTAVAIL;
+            FreeRTOS_debug_printf( ( "vSocketBind: Socket has no address.\n" ) );
+        }
+    #endif
+
+    if( xReturn != 0 )
+    {
+        iptraceBIND_FAILED( xSocket, ( FreeRTOS_ntohs( pxAddress->sin_port ) ) );
+    }
+
+    return xReturn;
+} /* Tested */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Close a socket and free the allocated space. In case of a TCP socket:
+ *        the connection will not be closed automatically. Subsequent messages
+ *        for the closed socket will be responded to with a RST. The IP-task
+ *        will actually close the socket, after receiving a 'eSocketCloseEvent'
+ *        message.
+ *
+ * @param[in] xSocket the socket being closed.
+ *
+ * @return There are three distinct values which can be returned:
+ *         0: If the xSocket is NULL/invalid.
+ *         1: If the socket was successfully closed (read the brief above).
+ *        -1: If the socket was valid but could not be closed because the message
+ *            could not be delivered to the IP-task. Try again later.
+ */
+BaseType_t FreeRTOS_closesocket( Socket_t xSocket )
+{
+    BaseType_t xResult;
+
+    #if ( ipconfigUSE_CALLBACKS == 1 )
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+    #endif /* ipconfigUSE_CALLBACKS == 1 */
+    IPStackEvent_t xCloseEvent;
+    xCloseEvent.eEventType = eSocketCloseEvent;
+    xCloseEvent.pvData = xSocket;
+
+    if( xSocketValid( xSocket ) == pdFALSE )
+    {
+        xResult = 0;
+    }
+    else
+    {
+        #if ( ipconfigUSE_CALLBACKS == 1 )
+        {
+            #if ( ipconfigUSE_TCP == 1 )
+                if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+                {
+                    /* Make sure that IP-task won't call the user callback's anymore */
+                    pxSocket->u.xTCP.pxHandleConnected = NULL;
+                    pxSocket->u.xTCP.pxHandleReceive = NULL;
+                    pxSocket->u.xTCP.pxHandleSent = NULL;
+                }
+                else
+            #endif /* ipconfigUSE_TCP == 1 */
+
+            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+            {
+                /* Clear the two UDP handlers. */
+                pxSocket->u.xUDP.pxHandleReceive = NULL;
+                pxSocket->u.xUDP.pxHandleSent = NULL;
+            }
+        }
+        #endif /* ipconfigUSE_CALLBACKS == 1 */
+
+        /* Let the IP task close the socket to keep it synchronised with the
+         * packet handling. */
+
+        /* The timeout value below is only used if this function is called from
+         * a user task. If this function is called by the IP-task, it may fail
+         * to close the socket when the event queue is full.
+         * This should only happen in case of a user call-back. */
+        if( xSendEventStructToIPTask( &xCloseEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
+        {
+            FreeRTOS_debug_printf( ( "FreeRTOS_closesocket: failed\n" ) );
+            xResult = -1;
+        }
+        else
+        {
+            xResult = 1;
+        }
+    }
+
+    return xResult;
+}
+
+/**
+ * @brief This is the internal version of FreeRTOS_closesocket(). It will
+ *        be called by the IPtask only to avoid problems with synchronicity.
+ *
+ * @param[in] pxSocket The socket descriptor of the socket being closed.
+ *
+ * @return Returns NULL, always.
+ */
+/* MISRA Ref 17.2.1 [Sockets and limited recursion] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-172 */
+/* coverity[misra_c_2012_rule_17_2_violation] */
+void * vSocketClose( FreeRTOS_Socket_t * pxSocket )
+{
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+
+    #if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+    {
+        if( pxSocket->pxAsyncRing != NULL )
+        {
+            /* The requests for this socket can not complete any more. */
+            prvAsyncCancelSocket( pxSocket );
+        }
+    }
+    #endif
+
+    #if ( ipconfigSELECT_LOCAL_EVALUATION == 1 )
+    {
+        /* FreeRTOS_select() may inspect the socket from another task, have it
+         * skip this socket before its streams are freed. */
+        pxSocket->pxSocketSet = NULL;
+    }
+    #endif
+
+    #if ( ipconfigUSE_TCP == 1 )
+    {
+        /* For TCP: clean up a little more. */
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            #if ( ipconfigTCP_LISTEN_POOL_SIZE != 0 )
+            {
+                /* The child sockets in the pool have never been bound or
+                 * used, close them together with the listening socket. */
+                while( pxSocket->u.xTCP.uxListenPoolCount > 0U )
+                {
+                    pxSocket->u.xTCP.uxListenPoolCount--;
+                    ( void ) vSocketClose( pxSocket->u.xTCP.pxListenPool[ pxSocket->u.xTCP.uxListenPoolCount ] );
+                }
+            }
+            #endif
+
+            #if ( ipconfigUSE_TCP_SPLICE != 0 )
+            {
+                /* The other sockets may not refer to this one any more. */
+                if( pxSocket->u.xTCP.pxSpliceTarget != NULL )
+                {
+                    pxSocket->u.xTCP.pxSpliceTarget->u.xTCP.pxSpliceSource = NULL;
+                }
+
+                if( pxSocket->u.xTCP.pxSpliceSource != NULL )
+                {
+                    pxSocket->u.xTCP.pxSpliceSource->u.xTCP.pxSpliceTarget = NULL;
+                }
+            }
+            #endif
+
+            #if ( ipconfigUSE_TCP_WIN == 1 )
+            {
+                if( pxSocket->u.xTCP.pxAckMessage != NULL )
+                {
+                    vReleaseNetworkBufferAndDescriptor( pxSocket->u.xTCP.pxAckMessage );
+                }
+
+                /* Free the resources which were claimed by the tcpWin member */
+                vTCPWindowDestroy( &pxSocket->u.xTCP.xTCPWindow );
+            }
+            #endif /* ipconfigUSE_TCP_WIN */
+
+            /* Free the input and output streams */
+            if( pxSocket->u.xTCP.rxStream != NULL )
+            {
+                #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+                {
+                    /* Give back the network buffers that have not been read. */
+                    vTCPRxBufferFlush( pxSocket );
+                }
+                #endif
+
+                #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+                    if( pxSocket->u.xTCP.rxStream == pxSocket->u.xTCP.pxStaticRxStream )
+                    {
+                        /* The storage belongs to the application. */
+                    }
+                    else
+                #endif
+                {
+                    vSocketMemoryRelease( sockSTREAM_HEAP_SIZE( pxSocket->u.xTCP.rxStream ) );
+
+                    #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+                        /* The next connection may use the same buffer. */
+                        if( prvTCPStreamPoolPut( pxSocket->u.xTCP.rxStream ) == pdFALSE )
+                    #endif
+                    {
+                        iptraceMEM_STATS_DELETE( pxSocket->u.xTCP.rxStream );
+                        ipRESOURCE_FREE( eResourceStream, sockSTREAM_HEAP_SIZE( pxSocket->u.xTCP.rxStream ) );
+                        vPortFreeLarge( pxSocket->u.xTCP.rxStream );
+                    }
+                }
+            }
+
+            if( pxSocket->u.xTCP.txStream != NULL )
+            {
+                #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+                {
+                    /* Tell the application that its buffers are not used any more. */
+                    vTCPTxReferenceFlush( pxSocket );
+                }
+                #endif
+
+                #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+                    if( pxSocket->u.xTCP.txStream == pxSocket->u.xTCP.pxStaticTxStream )
+                    {
+                        /* The storage belongs to the application. */
+                    }
+                    else
+                #endif
+                {
+                    vSocketMemoryRelease( sockSTREAM_HEAP_SIZE( pxSocket->u.xTCP.txStream ) );
+
+                    #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+                        /* The next connection may use the same buffer. */
+                        if( prvTCPStreamPoolPut( pxSocket->u.xTCP.txStream ) == pdFALSE )
+                    #endif
+                    {
+                        iptraceMEM_STATS_DELETE( pxSocket->u.xTCP.txStream );
+                        ipRESOURCE_FREE( eResourceStream, sockSTREAM_HEAP_SIZE( pxSocket->u.xTCP.txStream ) );
+                        vPortFreeLarge( pxSocket->u.xTCP.txStream );
+                    }
+                }
+            }
+
+            #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+            {
+                prvTCPAutoTuneRelease( pxSocket );
+            }
+            #endif
+
+            /* In case this is a child socket, make sure the child-count of the
+             * parent socket is decreased. */
+            prvTCPSetSocketCount( pxSocket );
+
+            #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
+            {
+                vTCPTimerWheelRemove( pxSocket );
+            }
+            #endif
+
+            #if ( ipconfigTCP_ACCEPT_QUEUE != 0 )
+            {
+                /* FreeRTOS_accept() reads the queues with the scheduler suspended. */
+                vTaskSuspendAll();
+                {
+                    if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xAcceptListItem ) ) != NULL )
+                    {
+                        ( void ) uxListRemove( &( pxSocket->u.xTCP.xAcceptListItem ) );
+                    }
+
+                    /* Children that were never accepted do not refer to their
+                     * parent anymore. */
+                    while( listCURRENT_LIST_LENGTH( &( pxSocket->u.xTCP.xAcceptQueue ) ) > 0U )
+                    {
+                        ( void ) uxListRemove( listGET_HEAD_ENTRY( &( pxSocket->u.xTCP.xAcceptQueue ) ) );
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+            #endif /* ipconfigTCP_ACCEPT_QUEUE */
+        }
+    }
+    #endif /* ipconfigUSE_TCP == 1 */
+
+    #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+    {
+        /* The socket set must not refer to a socket that is being freed. */
+        prvSelectReadyListRemove( pxSocket );
+    }
+    #endif
+
+    /* Socket must be unbound first, to ensure no more packets are queued on
+     * it. */
+    if( socketSOCKET_IS_BOUND( pxSocket ) )
+    {
+        /* If the network driver can iterate through 'xBoundUDPSocketsList',
+         * by calling xPortHasUDPSocket(), then the IP-task must temporarily
+         * suspend the scheduler to keep the list in a consistent state.
+         * The same holds when user tasks scan or change the lists, see
+         * socketLOCK_BOUND_LISTS. */
+        #if ( socketLOCK_BOUND_LISTS != 0 )
+        {
+            vTaskSuspendAll();
+        }
+        #endif /* socketLOCK_BOUND_LISTS */
+
+        ( void ) uxListRemove( &( pxSocket->xBoundSocketListItem ) );
+
+        #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+        {
+            prvSocketHashRemove( pxSocket );
+        }
+        #endif
+
+        #if ( socketLOCK_BOUND_LISTS != 0 )
+        {
+            ( void ) xTaskResumeAll();
+        }
+        #endif /* socketLOCK_BOUND_LISTS */
+    }
+
+    /* Now the socket is not bound the list of waiting packets can be
+     * drained. */
+    if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+    {
+        #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+        {
+            vMulticastSocketClose( pxSocket );
+        }
+        #endif
+
+        #if ( ipconfigUSE_UDP_CONNECT != 0 )
+        {
+            if( pxSocket->u.xUDP.xConnected != pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    uxUDPConnectedSockets--;
+                }
+                taskEXIT_CRITICAL();
+            }
+        }
+        #endif
+
+        while( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U )
+        {
+            pxNetworkBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) );
+            ( void ) uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
+            vSocketMemoryRelease( pxNetworkBuffer->xDataLength );
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+    }
+
+    #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+    {
+        if( pxSocket->xEventGroup != NULL )
+        {
+            vEventGroupDelete( pxSocket->xEventGroup );
+        }
+    }
+    #endif
+
+    #if ( ipconfigUSE_TCP == 1 ) && ( ipconfigHAS_DEBUG_PRINTF != 0 )
+    {
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            FreeRTOS_debug_printf( ( "FreeRTOS_closesocket[%s]: buffers %lu socks %lu\n",
+                                     prvSocketProps( pxSocket ),
+                                     uxGetNumberOfFreeNetworkBuffers(),
+                                     listCURRENT_LIST_LENGTH( &xBoundTCPSocketsList ) ) );
+        }
+    }
+    #endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigHAS_DEBUG_PRINTF != 0 ) */
+
+    #if ( ipconfigUSE_RESOURCE_STATS != 0 )
+    {
+        size_t uxSocketSize = ( sizeof( *pxSocket ) - sizeof( pxSocket->u ) ) + sizeof( pxSocket->u.xUDP );
+
+        #if ( ipconfigUSE_TCP == 1 )
+        {
+            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+            {
+                uxSocketSize = ( sizeof( *pxSocket ) - sizeof( pxSocket->u ) ) + sizeof( pxSocket->u.xTCP );
+            }
+        }
+        #endif
+
+        #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+            /* The memory of a static socket was not counted. */
+            if( pxSocket->bits.bStaticSocket == pdFALSE_UNSIGNED )
+        #endif
+        {
+            ipRESOURCE_FREE( eResourceSocket, uxSocketSize + socketEVENT_GROUP_SIZE );
+        }
+    }
+    #endif /* ( ipconfigUSE_RESOURCE_STATS != 0 ) */
+
+    /* And finally, after all resources have been freed, free the socket space */
+    iptraceMEM_STATS_DELETE( pxSocket );
+
+    #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+        if( pxSocket->bits.bStaticSocket != pdFALSE_UNSIGNED )
+        {
+            /* The memory belongs to the application. */
+        }
+        else
+    #endif
+    {
+        vPortFreeSocket( pxSocket );
+    }
+
+    return NULL;
+} /* Tested */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigHAS_DEBUG_PRINTF != 0 ) || ( ipconfigHAS_PRINTF != 0 ) )
+    const char * prvSocketProps( FreeRTOS_Socket_t * pxSocket )
+    {
+        /* For debugging purposes only: show some properties of a socket:
+         * IP-addresses and port numbers. */
+        #if ipconfigUSE_TCP == 1
+            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+            {
+                switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
+                {
+                    /* The use of snprintf() is discouraged by the MISRA rules.
+                     * This code however, is only active when logging is used. */
+
+                    /* The format '%pip' takes an string of 16 bytes as
+                     * a parameter, which is an IPv6 address.
+                     * See printf-stdarg.c */
+
+                    #if ( ipconfigUSE_IPv4 != 0 )
+                        case pdFALSE_UNSIGNED:
+                            ( void ) snprintf( pucSocketProps, sizeof( pucSocketProps ), "%xip port %u to %xip port %u",
+                                               ( unsigned ) pxSocket->xLocalAddress.ulIP_IPv4,
+                                               pxSocket->usLocalPort,
+                                               ( unsigned ) pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4,
+                                               pxSocket->u.xTCP.usRemotePort );
+                            break;
+                    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                    #if ( ipconfigUSE_IPv6 != 0 )
+                        case pdTRUE_UNSIGNED:
+                            ( void ) snprintf( pucSocketProps, sizeof( pucSocketProps ), "%pip port %u to %pip port %u",
+                                               ( void * ) pxSocket->xLocalAddress.xIP_IPv6.ucBytes,
+                                               pxSocket->usLocalPort,
+                                               ( void * ) pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes,
+                                               pxSocket->u.xTCP.usRemotePort );
+                            break;
+                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                    default:
+                        /* MISRA 16.4 Compliance */
+                        break;
+                }
+            }
+            else
+        #endif /* if ipconfigUSE_TCP == 1 */
+
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+        {
+            switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    case pdFALSE_UNSIGNED:
+                        ( void ) snprintf( pucSocketProps, sizeof( pucSocketProps ),
+                                           "%xip port %u",
+                                           ( unsigned ) pxSocket->xLocalAddress.ulIP_IPv4,
+                                           pxSocket->usLocalPort );
+                        break;
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    case pdTRUE_UNSIGNED:
+                        ( void ) snprintf( pucSocketProps, sizeof( pucSocketProps ),
+                                           "%pip port %u",
+                                           ( void * ) pxSocket->xLocalAddress.xIP_IPv6.ucBytes,
+                                           pxSocket->usLocalPort );
+                        break;
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                default:
+                    /* MISRA 16.4 Compliance */
+                    break;
+            }
+        }
+        else
+        {
+            /* Protocol not handled. */
+        }
+
+        return pucSocketProps;
+    }
+#endif /* ( ( ipconfigHAS_DEBUG_PRINTF != 0 ) || ( ipconfigHAS_PRINTF != 0 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ipconfigUSE_TCP == 1
+
+/**
+ * @brief When a child socket gets closed, make sure to update the child-count of the
+ *        parent. When a listening parent socket is closed, make sure to close also
+ *        all orphaned child-sockets.
+ *
+ * @param[in] pxSocketToDelete The socket being closed.
+ */
+    /* MISRA Ref 17.2.1 [Sockets and limited recursion] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-172 */
+    /* coverity[misra_c_2012_rule_17_2_violation] */
+    /* coverity[recursive_step] */
+    static void prvTCPSetSocketCount( FreeRTOS_Socket_t const * pxSocketToDelete )
+    {
+        const ListItem_t * pxIterator;
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+        FreeRTOS_Socket_t * pxOtherSocket;
+        uint16_t usLocalPort = pxSocketToDelete->usLocalPort;
+
+        if( pxSocketToDelete->u.xTCP.eTCPState == eTCP_LISTEN )
+        {
+            pxIterator = listGET_NEXT( pxEnd );
+
+            while( pxIterator != pxEnd )
+            {
+                pxOtherSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                /* This needs to be done here, before calling vSocketClose. */
+                pxIterator = listGET_NEXT( pxIterator );
+
+                if( ( pxOtherSocket->u.xTCP.eTCPState != eTCP_LISTEN ) &&
+                    ( pxOtherSocket->usLocalPort == usLocalPort ) &&
+                    ( ( pxOtherSocket->u.xTCP.bits.bPassQueued != pdFALSE_UNSIGNED ) ||
+                      ( pxOtherSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) ) )
+                {
+                    /* MISRA Ref 17.2.1 [Sockets and limited recursion] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-172 */
+                    /* coverity[misra_c_2012_rule_17_2_violation] */
+                    /* coverity[recursive_step] */
+                    ( void ) vSocketClose( pxOtherSocket );
+                }
+            }
+        }
+        else
+        {
+            for( pxIterator = listGET_NEXT( pxEnd );
+                 pxIterator != pxEnd;
+                 pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                pxOtherSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                if( ( pxOtherSocket->u.xTCP.eTCPState == eTCP_LISTEN ) &&
+                    ( pxOtherSocket->usLocalPort == usLocalPort ) &&
+                    ( pxOtherSocket->u.xTCP.usChildCount != 0U ) )
+                {
+                    pxOtherSocket->u.xTCP.usChildCount--;
+                    FreeRTOS_debug_printf( ( "Lost: Socket %u now has %u / %u child%s\n",
+                                             pxOtherSocket->usLocalPort,
+                                             pxOtherSocket->u.xTCP.usChildCount,
+                                             pxOtherSocket->u.xTCP.usBacklog,
+                                             ( pxOtherSocket->u.xTCP.usChildCount == 1U ) ? "" : "ren" ) );
+                    break;
+                }
+            }
+        }
+    }
+
+
+#endif /* ipconfigUSE_TCP == 1 */
+
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Set the value of receive/send buffer after some preliminary checks.
+ *
+ * @param[in] pxSocket The socket whose options are being set.
+ * @param[in] lOptionName The option name: either FREERTOS_SO_SNDBUF or
+ *                         FREERTOS_SO_SNDBUF.
+ * @param[in] pvOptionValue The value of the option being set.
+ *
+ * @return If there is no error, then 0 is returned. Or a negative errno
+ *         value is returned.
+ */
+    static BaseType_t prvSockopt_so_buffer( FreeRTOS_Socket_t * pxSocket,
+                                            int32_t lOptionName,
+                                            const void * pvOptionValue )
+    {
+        uint32_t ulNewValue;
+        BaseType_t xReturn;
+
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            FreeRTOS_debug_printf( ( "Set SO_%sBUF: wrong socket type\n",
+                                     ( lOptionName == FREERTOS_SO_SNDBUF ) ? "SND" : "RCV" ) );
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else if( ( ( lOptionName == FREERTOS_SO_SNDBUF ) && ( pxSocket->u.xTCP.txStream != NULL ) ) ||
+                 ( ( lOptionName == FREERTOS_SO_RCVBUF ) && ( pxSocket->u.xTCP.rxStream != NULL ) ) )
+        {
+            FreeRTOS_debug_printf( ( "Set SO_%sBUF: buffer already created\n",
+                                     ( lOptionName == FREERTOS_SO_SNDBUF ) ? "SND" : "RCV" ) );
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+
+        #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+            else if( ( ( lOptionName == FREERTOS_SO_SNDBUF ) && ( pxSocket->u.xTCP.pxStaticTxStream != NULL ) ) ||
+                     ( ( lOptionName == FREERTOS_SO_RCVBUF ) && ( pxSocket->u.xTCP.pxStaticRxStream != NULL ) ) )
+            {
+                /* The size follows from the storage of the application. */
+                FreeRTOS_debug_printf( ( "Set SO_%sBUF: static buffer\n",
+                                         ( lOptionName == FREERTOS_SO_SNDBUF ) ? "SND" : "RCV" ) );
+                xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            }
+        #endif /* ipconfigSUPPORT_STATIC_SOCKETS */
+        else
+        {
+            ulNewValue = *( ( const uint32_t * ) pvOptionValue );
+
+            #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+            {
+                /* The application has chosen the size of the streams. */
+                pxSocket->u.xTCP.bits.bNoAutoTune = pdTRUE_UNSIGNED;
+            }
+            #endif
+
+            #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+            {
+                pxSocket->u.xTCP.bits.bFixedSizes = pdTRUE_UNSIGNED;
+            }
+            #endif
+
+            if( lOptionName == FREERTOS_SO_SNDBUF )
+            {
+                /* Round up to nearest MSS size */
+                ulNewValue = FreeRTOS_round_up( ulNewValue, ( uint32_t ) pxSocket->u.xTCP.usMSS );
+                pxSocket->u.xTCP.uxTxStreamSize = ulNewValue;
+            }
+            else
+            {
+                pxSocket->u.xTCP.uxRxStreamSize = ulNewValue;
+            }
+
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+#endif /* ipconfigUSE_TCP == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_CALLBACKS == 1 )
+
+/**
+ * @brief Set a callback function for either a TCP or a UDP socket.
+ *        The callback function will be called on-connect, on-send
+ *        or on-receive.
+ *
+ * @param[in] pxSocket The socket whose options are being set.
+ * @param[in] lOptionName The option name like FREERTOS_SO_xxx_HANDLER.
+ * @param[in] pvOptionValue A pointer to a 'F_TCP_UDP_Handler_t',
+ *                           which defines the handler.
+ *
+ * @return If there is no error, then 0 is returned. Or a negative errno
+ *         value is returned.
+ */
+    BaseType_t prvSetOptionCallback( FreeRTOS_Socket_t * pxSocket,
+                                     int32_t lOptionName,
+                                     const void * pvOptionValue )
+    {
+        BaseType_t xReturn = 0;
+
+        #if ( ipconfigUSE_TCP == 1 )
+        {
+            UBaseType_t uxProtocol;
+
+            if( ( lOptionName == FREERTOS_SO_UDP_RECV_HANDLER ) ||
+                ( lOptionName == FREERTOS_SO_UDP_SENT_HANDLER ) )
+            {
+                uxProtocol = ( UBaseType_t ) FREERTOS_IPPROTO_UDP;
+            }
+            else
+            {
+                uxProtocol = ( UBaseType_t ) FREERTOS_IPPROTO_TCP;
+            }
+
+            if( pxSocket->ucProtocol != ( uint8_t ) uxProtocol )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            }
+        }
+        #else /* if ( ipconfigUSE_TCP == 1 ) */
+        {
+            /* No need to check if the socket has the right
+             * protocol, because only UDP sockets can be created. */
+        }
+        #endif /* ipconfigUSE_TCP */
+
+        if( xReturn == 0 )
+        {
+            switch( lOptionName ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is checked before calling. */
+            {
+                #if ipconfigUSE_TCP == 1
+                    case FREERTOS_SO_TCP_CONN_HANDLER:
+                        pxSocket->u.xTCP.pxHandleConnected = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnTCPConnected;
+                        break;
+
+                    case FREERTOS_SO_TCP_RECV_HANDLER:
+                        pxSocket->u.xTCP.pxHandleReceive = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnTCPReceive;
+                        break;
+
+                    case FREERTOS_SO_TCP_SENT_HANDLER:
+                        pxSocket->u.xTCP.pxHandleSent = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnTCPSent;
+                        break;
+                #endif /* ipconfigUSE_TCP */
+                case FREERTOS_SO_UDP_RECV_HANDLER:
+                    pxSocket->u.xUDP.pxHandleReceive = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnUDPReceive;
+                    break;
+
+                case FREERTOS_SO_UDP_SENT_HANDLER:
+                    pxSocket->u.xUDP.pxHandleSent = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnUDPSent;
+                    break;
+
+                default:                                /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
+                    xReturn = -pdFREERTOS_ERRNO_EINVAL; /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
+                    break;                              /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
+            }
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_CALLBACKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+
+/* The buffer that is offered to a reception handler.  These variables are
+ * only accessed by the IP-task. */
+    static FreeRTOS_Socket_t * pxRxBufferSocket = NULL;
+    static NetworkBufferDescriptor_t * pxRxBufferOffered = NULL;
+    static NetworkBufferDescriptor_t * pxRxBufferReply = NULL;
+    static size_t uxRxBufferReplySize = 0U;
+    static BaseType_t xRxBufferTaken = pdFALSE;
+
+/**
+ * @brief Offer a network buffer to the reception handler of a socket, which
+ *        is about to be called by the IP-task.
+ *
+ * @param[in] pxSocket The socket whose handler will be called.
+ * @param[in] pxNetworkBuffer The network buffer that holds the data.
+ * @param[in] uxReplySize The number of bytes to copy to a reply buffer,
+ *                        or zero when no reply buffer is needed.
+ */
+    void vSocketRxBufferOffer( FreeRTOS_Socket_t * pxSocket,
+                               NetworkBufferDescriptor_t * pxNetworkBuffer,
+                               size_t uxReplySize )
+    {
+        pxRxBufferSocket = pxSocket;
+        pxRxBufferOffered = pxNetworkBuffer;
+        pxRxBufferReply = NULL;
+        uxRxBufferReplySize = uxReplySize;
+        xRxBufferTaken = pdFALSE;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if the reception handler has taken the buffer that was
+ *        offered, and withdraw the offer.
+ *
+ * @param[out] ppxReplyBuffer Receives the copy of the headers, if any.
+ *
+ * @return pdTRUE when the handler has become the owner of the buffer.
+ */
+    BaseType_t xSocketRxBufferTaken( NetworkBufferDescriptor_t ** ppxReplyBuffer )
+    {
+        BaseType_t xReturn = xRxBufferTaken;
+
+        if( ppxReplyBuffer != NULL )
+        {
+            *( ppxReplyBuffer ) = pxRxBufferReply;
+        }
+
+        pxRxBufferSocket = NULL;
+        pxRxBufferOffered = NULL;
+        pxRxBufferReply = NULL;
+        uxRxBufferReplySize = 0U;
+        xRxBufferTaken = pdFALSE;
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Called from within a reception handler: take the network buffer
+ *        that holds the data passed to the handler.
+ *
+ * @param[in] xSocket The socket whose handler is being called.
+ *
+ * @return The network buffer descriptor, which must be released by the
+ *         application, or NULL when the buffer can not be handed over.
+ */
+    NetworkBufferDescriptor_t * FreeRTOS_TakeRxBuffer( Socket_t xSocket )
+    {
+        NetworkBufferDescriptor_t * pxReturn = NULL;
+
+        if( ( xIsCallingFromIPTask() != pdFALSE ) &&
+            ( xSocket == pxRxBufferSocket ) &&
+            ( pxRxBufferOffered != NULL ) &&
+            ( xRxBufferTaken == pdFALSE ) )
+        {
+            if( uxRxBufferReplySize != 0U )
+            {
+                /* The headers are still needed to send a reply. */
+                pxRxBufferReply = pxDuplicateNetworkBufferWithDescriptor( pxRxBufferOffered, uxRxBufferReplySize );
+            }
+
+            if( ( uxRxBufferReplySize == 0U ) || ( pxRxBufferReply != NULL ) )
+            {
+                pxReturn = pxRxBufferOffered;
+                xRxBufferTaken = pdTRUE;
+            }
+        }
+
+        return pxReturn;
+    }
+#endif /* ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 */
+/*-----------------------------------------------------------*/
+
+
+#if ( ipconfigUSE_TCP != 0 )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_WIN_PROPERTIES, which sets
+ *        the sizes of the TCP windows and the sizes of the stream buffers.
+ *
+ * @param[in] pxSocket The socket whose options are being set.
+ * @param[in] pvOptionValue The pointer that is passed by the application.
+ */
+    static BaseType_t prvSetOptionTCPWindows( FreeRTOS_Socket_t * pxSocket,
+                                              const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        const WinProperties_t * pxProps;
+
+        do
+        {
+            IPTCPSocket_t * pxTCP = &( pxSocket->u.xTCP );
+
+            if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+            {
+                FreeRTOS_debug_printf( ( "Set SO_WIN_PROP: wrong socket type\n" ) );
+                break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+            }
+
+            pxProps = ( const WinProperties_t * ) pvOptionValue;
+
+            /* Validity of txStream will be checked by the function below. */
+            xReturn = prvSockopt_so_buffer( pxSocket, FREERTOS_SO_SNDBUF, &( pxProps->lTxBufSize ) );
+
+            if( xReturn != 0 )
+            {
+                break; /* will return an error. */
+            }
+
+            xReturn = prvSockopt_so_buffer( pxSocket, FREERTOS_SO_RCVBUF, &( pxProps->lRxBufSize ) );
+
+            if( xReturn != 0 )
+            {
+                break; /* will return an error. */
+            }
+
+            #if ( ipconfigUSE_TCP_WIN == 1 )
+            {
+                pxTCP->uxRxWinSize = ( uint32_t ) pxProps->lRxWinSize; /* Fixed value: size of the TCP reception window */
+                pxTCP->uxTxWinSize = ( uint32_t ) pxProps->lTxWinSize; /* Fixed value: size of the TCP transmit window */
+            }
+            #else
+            {
+                pxTCP->uxRxWinSize = 1U;
+                pxTCP->uxTxWinSize = 1U;
+            }
+            #endif
+
+            /* In case the socket has already initialised its tcpWin,
+             * adapt the window size parameters */
+            if( pxTCP->xTCPWindow.u.bits.bHasInit != pdFALSE_UNSIGNED )
+            {
+                #if ( ipconfigUSE_TCP_WIN == 1 )
+                {
+                    pxTCP->xTCPWindow.xSize.ulRxWindowLength = ( uint32_t ) ( pxTCP->uxRxWinSize * pxTCP->usMSS );
+
+                    if( pxTCP->eTCPState >= eESTABLISHED )
+                    {
+                        /* The scaling factor was fixed in the SYN phase, it limits
+                         * the window that can be advertised. */
+                        uint32_t ulMaxWindow = ( uint32_t ) 0xfffcU << pxTCP->ucMyWinScaleFactor;
+
+                        pxTCP->xTCPWindow.xSize.ulRxWindowLength = FreeRTOS_min_uint32( pxTCP->xTCPWindow.xSize.ulRxWindowLength, FreeRTOS_round_down( ulMaxWindow, ( uint32_t ) pxTCP->usMSS ) );
+                    }
+                }
+                #else
+                {
+                    pxTCP->xTCPWindow.xSize.ulRxWindowLength = ( uint32_t ) ( pxTCP->uxRxWinSize * pxTCP->usMSS );
+                }
+                #endif
+                pxTCP->xTCPWindow.xSize.ulTxWindowLength = ( uint32_t ) ( pxTCP->uxTxWinSize * pxTCP->usMSS );
+            }
+        }
+        while( ipFALSE_BOOL );
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_TCP != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_TCP_CONGESTION, which selects the
+ *        congestion control algorithm of a TCP socket. The algorithm is used
+ *        by the next connection that the socket makes or accepts, so the option
+ *        should be set before calling FreeRTOS_connect() or FreeRTOS_listen().
+ *
+ * @param[in] pxSocket The socket whose options are being set.
+ * @param[in] pvOptionValue A pointer to a TCPCongestionControl_t, for instance
+ *                          &xTCPCongestionNewReno or &xTCPCongestionCubic.
+ */
+    static BaseType_t prvSetOptionCongestionControl( FreeRTOS_Socket_t * pxSocket,
+                                                     const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        const TCPCongestionControl_t * pxControl = ( const TCPCongestionControl_t * ) pvOptionValue;
+
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            FreeRTOS_debug_printf( ( "FREERTOS_SO_TCP_CONGESTION: wrong socket type\n" ) );
+        }
+        else if( ( pxControl == NULL ) ||
+                 ( pxControl->fnInit == NULL ) ||
+                 ( pxControl->fnOnAck == NULL ) ||
+                 ( pxControl->fnOnLoss == NULL ) )
+        {
+            FreeRTOS_debug_printf( ( "FREERTOS_SO_TCP_CONGESTION: bad algorithm\n" ) );
+        }
+        else
+        {
+            pxSocket->u.xTCP.pxCongestionControl = pxControl;
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP != 0 )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_SET_LOW_HIGH_WATER, which sets
+ *        the low- and the high-water values for TCP reception. Useful when
+ *        streaming music.
+ *
+ * @param[in] pxSocket The socket whose options are being set.
+ * @param[in] pvOptionValue The pointer that is passed by the application.
+ */
+    static BaseType_t prvSetOptionLowHighWater( FreeRTOS_Socket_t * pxSocket,
+                                                const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        const LowHighWater_t * pxLowHighWater = ( const LowHighWater_t * ) pvOptionValue;
+
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            /* It is not allowed to access 'pxSocket->u.xTCP'. */
+            FreeRTOS_debug_printf( ( "FREERTOS_SO_SET_LOW_HIGH_WATER: wrong socket type\n" ) );
+        }
+        else if( ( pxLowHighWater->uxLittleSpace >= pxLowHighWater->uxEnoughSpace ) ||
+                 ( pxLowHighWater->uxEnoughSpace > pxSocket->u.xTCP.uxRxStreamSize ) )
+        {
+            /* Impossible values. */
+            FreeRTOS_debug_printf( ( "FREERTOS_SO_SET_LOW_HIGH_WATER: bad values\n" ) );
+        }
+        else
+        {
+            /* Send a STOP when buffer space drops below 'uxLittleSpace' bytes. */
+            pxSocket->u.xTCP.uxLittleSpace = pxLowHighWater->uxLittleSpace;
+            /* Send a GO when buffer space grows above 'uxEnoughSpace' bytes. */
+            pxSocket->u.xTCP.uxEnoughSpace = pxLowHighWater->uxEnoughSpace;
+
+            #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+            {
+                /* The water marks only fit the current stream size. */
+                pxSocket->u.xTCP.bits.bFixedSizes = pdTRUE_UNSIGNED;
+            }
+            #endif
+
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_TCP != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP != 0 )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_SET_FULL_SIZE.
+ *        When enabled, the IP-stack will only send packets when
+ *        there are at least MSS bytes to send.
+ *
+ * @param[in] pxSocket The socket whose options are being set.
+ * @param[in] pvOptionValue The option name like FREERTOS_SO_xxx_HANDLER.
+ */
+    static BaseType_t prvSetOptionSetFullSize( FreeRTOS_Socket_t * pxSocket,
+                                               const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+            {
+                pxSocket->u.xTCP.xTCPWindow.u.bits.bSendFullSize = pdTRUE_UNSIGNED;
+            }
+            else
+            {
+                pxSocket->u.xTCP.xTCPWindow.u.bits.bSendFullSize = pdFALSE_UNSIGNED;
+            }
+
+            if( ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) &&
+                ( FreeRTOS_outstanding( pxSocket ) != 0 ) )
+            {
+                /* There might be some data in the TX-stream, less than full-size,
+                 * which equals a MSS.  Wake-up the IP-task to check this. */
+                pxSocket->u.xTCP.usTimeout = 1U;
+                vTCPTimerWheelRequest( pxSocket );
+                ( void ) xSendEventToIPTask( eTCPTimerEvent );
+            }
+
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_TCP != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP != 0 )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_STOP_RX.
+ *        Used in applications with streaming audio: tell the peer
+ *        to stop or continue sending data.
+ *
+ * @param[in] pxSocket The TCP socket used for the connection.
+ * @param[in] pvOptionValue The option name like FREERTOS_SO_xxx_HANDLER.
+ */
+    static BaseType_t prvSetOptionStopRX( FreeRTOS_Socket_t * pxSocket,
+                                          const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+            {
+                pxSocket->u.xTCP.bits.bRxStopped = pdTRUE_UNSIGNED;
+            }
+            else
+            {
+                pxSocket->u.xTCP.bits.bRxStopped = pdFALSE_UNSIGNED;
+            }
+
+            pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
+            pxSocket->u.xTCP.usTimeout = 1U; /* to set/clear bRxStopped */
+            vTCPTimerWheelRequest( pxSocket );
+            ( void ) xSendEventToIPTask( eTCPTimerEvent );
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_TCP != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP != 0 )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_TCP_CORK.  While the socket is
+ *        corked, data that does not fill a segment is held back.  When the
+ *        option is cleared, the data held is sent.  A shutdown also sends it.
+ *
+ * @param[in] pxSocket The TCP socket whose options are being set.
+ * @param[in] pvOptionValue A pointer to a BaseType_t, non-zero to cork.
+ */
+    static BaseType_t prvSetOptionCork( FreeRTOS_Socket_t * pxSocket,
+                                        const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            vTaskSuspendAll();
+            {
+                if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+                {
+                    pxSocket->u.xTCP.bits.bCork = pdTRUE_UNSIGNED;
+                }
+                else
+                {
+                    pxSocket->u.xTCP.bits.bCork = pdFALSE_UNSIGNED;
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( ( pxSocket->u.xTCP.bits.bCork == pdFALSE_UNSIGNED ) &&
+                ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) &&
+                ( FreeRTOS_outstanding( pxSocket ) != 0 ) )
+            {
+                /* Let the IP-task send the data that was held back. */
+                pxSocket->u.xTCP.usTimeout = 1U;
+                vTCPTimerWheelRequest( pxSocket );
+                ( void ) xSendEventToIPTask( eTCPTimerEvent );
+            }
+
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_TCP != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_RX_BUFFER_COUNT != 0 ) )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_RX_BUFFER_CHAIN.  When enabled,
+ *        network buffers with in-order data are kept by the socket, and their
+ *        payload is not copied into the RX stream.  The application should
+ *        read the data with FreeRTOS_recv() and the flag FREERTOS_ZERO_COPY,
+ *        and release it with FreeRTOS_ReleaseTCPPayloadBuffer().  Child
+ *        sockets inherit the option from the listening socket.
+ *
+ * @param[in] pxSocket The TCP socket whose options are being set.
+ * @param[in] pvOptionValue A pointer to a BaseType_t, non-zero to enable.
+ */
+    static BaseType_t prvSetOptionRxBufferChain( FreeRTOS_Socket_t * pxSocket,
+                                                 const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+            {
+                pxSocket->u.xTCP.bits.bRxBufferChain = pdTRUE_UNSIGNED;
+            }
+            else
+            {
+                /* Buffers that are kept already, will be released as usual. */
+                pxSocket->u.xTCP.bits.bRxBufferChain = pdFALSE_UNSIGNED;
+            }
+
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_RX_BUFFER_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_LISTEN_POOL_SIZE != 0 ) )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_LISTEN_POOL.  A listening socket
+ *        will keep the given number of child sockets ready, so that the
+ *        IP-task does not have to allocate a socket when a SYN arrives.  When
+ *        the socket is listening already, the pool is filled or reduced
+ *        immediately, otherwise FreeRTOS_listen() will fill it.
+ *
+ * @param[in] pxSocket The TCP socket whose options are being set.
+ * @param[in] pvOptionValue A pointer to a BaseType_t, the number of sockets,
+ *                          at most ipconfigTCP_LISTEN_POOL_SIZE.
+ */
+    static BaseType_t prvSetOptionListenPool( FreeRTOS_Socket_t * pxSocket,
+                                              const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        BaseType_t xCount = *( ( const BaseType_t * ) pvOptionValue );
+        FreeRTOS_Socket_t * pxChildSocket;
+
+        if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) &&
+            ( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED ) &&
+            ( xCount >= 0 ) &&
+            ( xCount <= ( BaseType_t ) ipconfigTCP_LISTEN_POOL_SIZE ) )
+        {
+            pxSocket->u.xTCP.uxListenPoolTarget = ( UBaseType_t ) xCount;
+
+            /* Give back the sockets that are not needed any more. */
+            for( ; ; )
+            {
+                pxChildSocket = NULL;
+
+                vTaskSuspendAll();
+                {
+                    if( pxSocket->u.xTCP.uxListenPoolCount > pxSocket->u.xTCP.uxListenPoolTarget )
+                    {
+                        pxSocket->u.xTCP.uxListenPoolCount--;
+                        pxChildSocket = pxSocket->u.xTCP.pxListenPool[ pxSocket->u.xTCP.uxListenPoolCount ];
+                    }
+                }
+                ( void ) xTaskResumeAll();
+
+                if( pxChildSocket == NULL )
+                {
+                    break;
+                }
+
+                ( void ) FreeRTOS_closesocket( pxChildSocket );
+            }
+
+            if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
+            {
+                prvTCPListenPoolFill( pxSocket );
+            }
+
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create child sockets until the pool of a listening socket holds the
+ *        number of sockets that was set with FREERTOS_SO_LISTEN_POOL.  This is
+ *        called from the task that owns the listening socket, so the
+ *        allocations are not done by the IP-task.  When an allocation fails,
+ *        the pool is left as it is.
+ *
+ * @param[in] pxSocket The listening socket.
+ */
+    static void prvTCPListenPoolFill( FreeRTOS_Socket_t * pxSocket )
+    {
+        BaseType_t xDomain;
+        FreeRTOS_Socket_t * pxChildSocket;
+
+        if( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED )
+        {
+            xDomain = FREERTOS_AF_INET6;
+        }
+        else
+        {
+            xDomain = FREERTOS_AF_INET;
+        }
+
+        while( pxSocket->u.xTCP.uxListenPoolCount < pxSocket->u.xTCP.uxListenPoolTarget )
+        {
+            pxChildSocket = ( FreeRTOS_Socket_t * ) FreeRTOS_socket( xDomain, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+
+            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
+            /* coverity[misra_c_2012_rule_11_4_violation] */
+            if( ( pxChildSocket == NULL ) || ( pxChildSocket == FREERTOS_INVALID_SOCKET ) )
+            {
+                break;
+            }
+
+            /* The IP-task may take a socket from the pool at any time. */
+            vTaskSuspendAll();
+            {
+                pxSocket->u.xTCP.pxListenPool[ pxSocket->u.xTCP.uxListenPoolCount ] = pxChildSocket;
+                pxSocket->u.xTCP.uxListenPoolCount++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get a new child socket for a listening socket.  A socket is taken
+ *        from the pool when it has the requested family, otherwise a new
+ *        socket is created.  Called by the IP-task.
+ *
+ * @param[in] pxSocket The listening socket.
+ * @param[in] xDomain The family of the child socket, FREERTOS_AF_INET or
+ *                    FREERTOS_AF_INET6.
+ *
+ * @return The child socket, or NULL or FREERTOS_INVALID_SOCKET when no socket
+ *         could be created.
+ */
+    FreeRTOS_Socket_t * pxTCPListenPoolTake( FreeRTOS_Socket_t * pxSocket,
+                                             BaseType_t xDomain )
+    {
+        FreeRTOS_Socket_t * pxChildSocket = NULL;
+        BaseType_t xIsIPv6 = ( xDomain == FREERTOS_AF_INET6 ) ? pdTRUE : pdFALSE;
+        BaseType_t xParentIsIPv6 = ( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED ) ? pdTRUE : pdFALSE;
+
+        /* The sockets in the pool were created with the family of the
+         * listening socket, and their MSS was set accordingly. */
+        if( xIsIPv6 == xParentIsIPv6 )
+        {
+            vTaskSuspendAll();
+            {
+                if( pxSocket->u.xTCP.uxListenPoolCount > 0U )
+                {
+                    pxSocket->u.xTCP.uxListenPoolCount--;
+                    pxChildSocket = pxSocket->u.xTCP.pxListenPool[ pxSocket->u.xTCP.uxListenPoolCount ];
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+
+        if( pxChildSocket == NULL )
+        {
+            pxChildSocket = ( FreeRTOS_Socket_t * ) FreeRTOS_socket( xDomain, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+        }
+
+        return pxChildSocket;
+    }
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigTCP_LISTEN_POOL_SIZE != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_PACING != 0 ) )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_TCP_PACING.  A paced socket
+ *        releases its segments at a steady rate, in stead of sending them
+ *        back-to-back when the window opens.  Child sockets inherit the
+ *        option from the listening socket.
+ *
+ * @param[in] pxSocket The TCP socket whose options are being set.
+ * @param[in] pvOptionValue A pointer to a uint32_t: the rate in bytes per
+ *                          second, 0 to disable pacing, or
+ *                          FREERTOS_TCP_PACING_AUTO to derive the rate from
+ *                          the congestion window and the round-trip time.
+ */
+    static BaseType_t prvSetOptionPacing( FreeRTOS_Socket_t * pxSocket,
+                                          const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            pxSocket->u.xTCP.ulPacingRate = *( ( const uint32_t * ) pvOptionValue );
+            pxSocket->u.xTCP.lPacingCredit = 0;
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_PACING != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_ACK_POLICY != 0 ) )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_TCP_ACK_POLICY, which selects
+ *        when the ACK's of received data are sent.  Child sockets inherit
+ *        the policy from the listening socket.
+ *
+ * @param[in] pxSocket The TCP socket whose options are being set.
+ * @param[in] pvOptionValue A pointer to a TCPAckPolicy_t.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EINVAL for an unknown mode, or
+ *         for FREERTOS_TCP_ACK_EVERY_N with zero segments.
+ */
+    static BaseType_t prvSetOptionAckPolicy( FreeRTOS_Socket_t * pxSocket,
+                                             const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        const TCPAckPolicy_t * pxPolicy = ( const TCPAckPolicy_t * ) pvOptionValue;
+
+        if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) &&
+            ( pxPolicy->ucMode <= ( uint8_t ) FREERTOS_TCP_ACK_ADAPTIVE ) &&
+            ( ( pxPolicy->ucMode != ( uint8_t ) FREERTOS_TCP_ACK_EVERY_N ) || ( pxPolicy->ucSegments != 0U ) ) )
+        {
+            pxSocket->u.xTCP.xAckPolicy = *pxPolicy;
+            pxSocket->u.xTCP.ucAckSegments = 0U;
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_ACK_POLICY != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_SPLICE != 0 ) )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_TCP_SPLICE.  The data received
+ *        by the socket will be moved by the IP-task to the txStream of the
+ *        target socket.  A target can have only one source, two sockets can
+ *        be spliced in both directions.
+ *
+ * @param[in] pxSocket The TCP socket whose options are being set.
+ * @param[in] pvOptionValue A pointer to a Socket_t: the target socket, or NULL
+ *                          to stop splicing.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EINVAL when either socket is not a
+ *         TCP socket, or when the target is spliced to another socket.
+ */
+    static BaseType_t prvSetOptionSplice( FreeRTOS_Socket_t * pxSocket,
+                                          const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        FreeRTOS_Socket_t * pxTarget = *( ( const Socket_t * ) pvOptionValue );
+
+        if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) &&
+            ( ( pxTarget == NULL ) ||
+              ( ( pxTarget != pxSocket ) &&
+                ( prvValidSocket( pxTarget, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdTRUE ) &&
+                ( ( pxTarget->u.xTCP.pxSpliceSource == NULL ) || ( pxTarget->u.xTCP.pxSpliceSource == pxSocket ) ) ) ) )
+        {
+            /* The IP-task must see both links, or none. */
+            vTaskSuspendAll();
+            {
+                if( pxSocket->u.xTCP.pxSpliceTarget != NULL )
+                {
+                    pxSocket->u.xTCP.pxSpliceTarget->u.xTCP.pxSpliceSource = NULL;
+                }
+
+                pxSocket->u.xTCP.pxSpliceTarget = pxTarget;
+
+                if( pxTarget != NULL )
+                {
+                    pxTarget->u.xTCP.pxSpliceSource = pxSocket;
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            /* Let the IP-task move the data that was received earlier. */
+            pxSocket->u.xTCP.usTimeout = 1U;
+            vTCPTimerWheelRequest( pxSocket );
+            ( void ) xSendEventToIPTask( eTCPTimerEvent );
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_SPLICE != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_RECORD_FRAMING != 0 ) )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_TCP_RECORD.  The reader of the
+ *        socket will only be woken up when a complete record has been
+ *        received.  The option can not be combined with
+ *        FREERTOS_SO_RX_BUFFER_CHAIN, because the record header must be
+ *        read from the RX stream.
+ *
+ * @param[in] pxSocket The TCP socket whose options are being set.
+ * @param[in] pvOptionValue A pointer to a TCPRecordFraming_t.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EINVAL when the socket is not a TCP
+ *         socket, or when the framing is not valid.
+ */
+    static BaseType_t prvSetOptionRecordFraming( FreeRTOS_Socket_t * pxSocket,
+                                                 const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        const TCPRecordFraming_t * pxFraming = ( const TCPRecordFraming_t * ) pvOptionValue;
+        uint8_t ucSize = pxFraming->ucLengthSize;
+
+        if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) &&
+            ( ( ucSize == 0U ) || ( ucSize == 1U ) || ( ucSize == 2U ) || ( ucSize == 4U ) ) )
+        {
+            xReturn = 0;
+
+            #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+                if( ( ucSize != 0U ) && ( pxSocket->u.xTCP.bits.bRxBufferChain != pdFALSE_UNSIGNED ) )
+                {
+                    xReturn = -pdFREERTOS_ERRNO_EINVAL;
+                }
+            #endif
+
+            if( xReturn == 0 )
+            {
+                /* The IP-task must not see a partial update. */
+                vTaskSuspendAll();
+                {
+                    pxSocket->u.xTCP.xRecordFraming = *pxFraming;
+                }
+                ( void ) xTaskResumeAll();
+
+                /* Data that was received earlier may hold a complete record. */
+                if( ( ucSize != 0U ) && ( prvRecvAvailable( pxSocket, pdTRUE ) != 0 ) )
+                {
+                    vSocketEventSet( pxSocket, ( EventBits_t ) eSOCKET_RECEIVE );
+                }
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if the RX stream starts with a complete record.  Called by the
+ *        IP-task when data was added, and by the reader.
+ *
+ * @param[in] pxSocket A TCP socket that uses record framing.
+ *
+ * @return The length of the record when it has been received completely, zero
+ *         when more data is needed, -pdFREERTOS_ERRNO_ENOSPC when the record
+ *         is longer than the RX stream, or -pdFREERTOS_ERRNO_EINVAL when the
+ *         length field is shorter than the header.
+ */
+    static BaseType_t prvTCPRecordAvailable( FreeRTOS_Socket_t * pxSocket )
+    {
+        BaseType_t xReturn = 0;
+        const TCPRecordFraming_t * pxFraming = &( pxSocket->u.xTCP.xRecordFraming );
+        StreamBuffer_t * pxStream = pxSocket->u.xTCP.rxStream;
+        size_t uxHeaderLength = ( size_t ) pxFraming->ucLengthOffset + ( size_t ) pxFraming->ucLengthSize;
+        size_t uxCount;
+
+        if( pxStream != NULL )
+        {
+            uxCount = uxStreamBufferGetSize( pxStream );
+
+            if( uxCount >= uxHeaderLength )
+            {
+                uint8_t ucField[ sizeof( uint32_t ) ];
+                size_t uxValue = 0U;
+                size_t uxCapacity = pxStream->LENGTH - 1U;
+                size_t uxRecordLength = 0U;
+                size_t uxIndex;
+
+                ( void ) uxStreamBufferGet( pxStream, ( size_t ) pxFraming->ucLengthOffset, ucField, ( size_t ) pxFraming->ucLengthSize, pdTRUE );
+
+                for( uxIndex = 0U; uxIndex < ( size_t ) pxFraming->ucLengthSize; uxIndex++ )
+                {
+                    if( pxFraming->ucBigEndian != 0U )
+                    {
+                        uxValue = ( uxValue << 8 ) | ( size_t ) ucField[ uxIndex ];
+                    }
+                    else
+                    {
+                        uxValue |= ( ( size_t ) ucField[ uxIndex ] ) << ( 8U * uxIndex );
+                    }
+                }
+
+                /* Apply the adjustment without overflowing. */
+                if( pxFraming->lLengthAdjust >= 0 )
+                {
+                    if( uxValue <= uxCapacity )
+                    {
+                        uxRecordLength = uxValue + ( size_t ) pxFraming->lLengthAdjust;
+                    }
+                    else
+                    {
+                        uxRecordLength = uxCapacity + 1U;
+                    }
+                }
+                else
+                {
+                    size_t uxSubtract = ( size_t ) ( -( pxFraming->lLengthAdjust + 1 ) ) + 1U;
+
+                    if( uxValue >= uxSubtract )
+                    {
+                        uxRecordLength = uxValue - uxSubtract;
+                    }
+                }
+
+                if( uxRecordLength < uxHeaderLength )
+                {
+                    xReturn = -pdFREERTOS_ERRNO_EINVAL;
+                }
+                else if( uxRecordLength > uxCapacity )
+                {
+                    /* The record would never fit, the reader must be told. */
+                    xReturn = -pdFREERTOS_ERRNO_ENOSPC;
+                }
+                else if( uxRecordLength <= uxCount )
+                {
+                    xReturn = ( BaseType_t ) uxRecordLength;
+                }
+                else
+                {
+                    /* Wait for the rest of the record. */
+                }
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_RECORD_FRAMING != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_FAST_OPEN != 0 ) )
+
+/**
+ * @brief Handle the socket option FREERTOS_SO_TCP_FASTOPEN.  A listening
+ *        socket will hand out cookies and accept data in a SYN with a valid
+ *        cookie, its child sockets inherit the option.  A client socket will
+ *        ask for a cookie, or use a cookie that it received earlier to send
+ *        data along with the SYN.
+ *
+ * @param[in] pxSocket The TCP socket whose options are being set.
+ * @param[in] pvOptionValue A pointer to a BaseType_t, non-zero to enable.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EINVAL when the socket is not a TCP
+ *         socket, or when it is not closed.
+ */
+    static BaseType_t prvSetOptionFastOpen( FreeRTOS_Socket_t * pxSocket,
+                                            const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) &&
+            ( pxSocket->u.xTCP.eTCPState == eCLOSED ) )
+        {
+            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+            {
+                pxSocket->u.xTCP.bits.bFastOpen = pdTRUE_UNSIGNED;
+            }
+            else
+            {
+                pxSocket->u.xTCP.bits.bFastOpen = pdFALSE_UNSIGNED;
+            }
+
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ipconfigUSE_TCP != 0 ) && ( ipconfigUSE_TCP_FAST_OPEN != 0 ) */
+/*-----------------------------------------------------------*/
+
+
+/**
+ * @brief Handle the socket options FREERTOS_SO_RCVTIMEO and
+ *        FREERTOS_SO_SNDTIMEO.
+ *        Used in applications with streaming audio: tell the peer
+ *        to stop or continue sending data.
+ *
+ * @param[in] pxSocket The TCP socket used for the connection.
+ * @param[in] pvOptionValue The option name like FREERTOS_SO_xxx_HANDLER.
+ * @param[in] xForSend when true, handle 'FREERTOS_SO_SNDTIMEO',
+ *            otherwise handle the option `FREERTOS_SO_RCVTIMEO`.
+ */
+static void prvSetOptionTimeout( FreeRTOS_Socket_t * pxSocket,
+                                 const void * pvOptionValue,
+                                 BaseType_t xForSend )
+{
+    TickType_t xBlockTime = *( ( const TickType_t * ) pvOptionValue );
+
+    if( xForSend == pdTRUE )
+    {
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+        {
+            /* The send time out is capped for the reason stated in the
+             * comments where ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS is defined
+             * in FreeRTOSIPConfig.h (assuming an official configuration file
+             * is being used. */
+            if( xBlockTime > ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS )
+            {
+                xBlockTime = ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS;
+            }
+        }
+        else
+        {
+            /* For TCP socket, it isn't necessary to limit the blocking time
+             * because  the FreeRTOS_send() function does not wait for a network
+             * buffer to become available. */
+        }
+
+        pxSocket->xSendBlockTime = xBlockTime;
+    }
+    else
+    {
+        pxSocket->xReceiveBlockTime = xBlockTime;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP != 0 )
+
+/**
+ * @brief Handle the socket options FREERTOS_SO_REUSE_LISTEN_SOCKET.
+ *        When set, a listening socket will turn itself into a child
+ *        socket when it receives a connection.
+ *
+ * @param[in] pxSocket The TCP socket used for the connection.
+ * @param[in] pvOptionValue The option name like FREERTOS_SO_xxx_HANDLER.
+ */
+    static BaseType_t prvSetOptionReuseListenSocket( FreeRTOS_Socket_t * pxSocket,
+                                                     const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+            {
+                pxSocket->u.xTCP.bits.bReuseSocket = pdTRUE_UNSIGNED;
+            }
+            else
+            {
+                pxSocket->u.xTCP.bits.bReuseSocket = pdFALSE_UNSIGNED;
+            }
+
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_TCP != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP != 0 )
+
+/**
+ * @brief Handle the socket options FREERTOS_SO_CLOSE_AFTER_SEND.
+ *        As soon as the last byte has been transmitted, initiate
+ *        a graceful closure of the TCP connection.
+ *
+ * @param[in] pxSocket The TCP socket used for the connection.
+ * @param[in] pvOptionValue A pointer to a binary value of size
+ *            BaseType_t.
+ */
+    static BaseType_t prvSetOptionCloseAfterSend( FreeRTOS_Socket_t * pxSocket,
+                                                  const void * pvOptionValue )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+            {
+                pxSocket->u.xTCP.bits.bCloseAfterSend = pdTRUE_UNSIGNED;
+            }
+            else
+            {
+                pxSocket->u.xTCP.bits.bCloseAfterSend = pdFALSE_UNSIGNED;
+            }
+
+            xReturn = 0;
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigUSE_TCP != 0 ) */
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS_setsockopt calls itself, but in a very limited way,
+ * only when FREERTOS_SO_WIN_PROPERTIES is being set. */
+
+/**
+ * @brief Set the socket options for the given socket.
+ *
+ * @param[in] xSocket The socket for which the options are to be set.
+ * @param[in] lLevel Not used. Parameter is used to maintain the Berkeley sockets
+ *                    standard.
+ * @param[in] lOptionName The name of the option to be set.
+ * @param[in] pvOptionValue The value of the option to be set.
+ * @param[in] uxOptionLength Not used. Parameter is used to maintain the Berkeley
+ *                            sockets standard.
+ *
+ * @return If the option can be set with the given value, then 0 is returned. Else,
+ *         an error code is returned.
+ */
+BaseType_t FreeRTOS_setsockopt( Socket_t xSocket,
+                                int32_t lLevel,
+                                int32_t lOptionName,
+                                const void * pvOptionValue,
+                                size_t uxOptionLength )
+{
+/* The standard Berkeley function returns 0 for success. */
+    BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+    FreeRTOS_Socket_t * pxSocket;
+
+    pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+
+    /* The function prototype is designed to maintain the expected Berkeley
+     * sockets standard, but this implementation does not use all the parameters. */
+    ( void ) lLevel;
+    ( void ) uxOptionLength;
+
+    if( xSocketValid( pxSocket ) == pdTRUE )
+    {
+        switch( lOptionName )
+        {
+            case FREERTOS_SO_RCVTIMEO:
+                /* Receive time out. */
+                prvSetOptionTimeout( pxSocket, pvOptionValue, pdFALSE );
+                xReturn = 0;
+                break;
+
+            case FREERTOS_SO_SNDTIMEO:
+                prvSetOptionTimeout( pxSocket, pvOptionValue, pdTRUE );
+                xReturn = 0;
+                break;
+
+                #if ( ipconfigUDP_MAX_RX_PACKETS > 0U )
+                    case FREERTOS_SO_UDP_MAX_RX_PACKETS:
+
+                        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_UDP )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        pxSocket->u.xUDP.uxMaxPackets = *( ( const UBaseType_t * ) pvOptionValue );
+                        xReturn = 0;
+                        break;
+
+                    case FREERTOS_SO_UDP_RX_DROP_OLDEST:
+
+                        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_UDP )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        pxSocket->u.xUDP.xDropOldest = ( *( ( const BaseType_t * ) pvOptionValue ) != pdFALSE ) ? pdTRUE : pdFALSE;
+                        xReturn = 0;
+                        break;
+                #endif /* ipconfigUDP_MAX_RX_PACKETS */
+
+                #if ( ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) )
+                    case FREERTOS_SO_REUSEPORT:
+
+                        if( socketSOCKET_IS_BOUND( pxSocket ) )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        #if ( ipconfigUSE_UDP_REUSEPORT != 0 )
+                            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+                            {
+                                pxSocket->u.xUDP.xReusePort = ( *( ( const BaseType_t * ) pvOptionValue ) != pdFALSE ) ? pdTRUE : pdFALSE;
+                                xReturn = 0;
+                            }
+                        #endif
+
+                        #if ( ipconfigUSE_TCP_REUSEPORT != 0 )
+                            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+                            {
+                                pxSocket->u.xTCP.bits.bReusePort = ( *( ( const BaseType_t * ) pvOptionValue ) != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+                                xReturn = 0;
+                            }
+                        #endif
+                        break;
+                #endif /* ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) */
+
+                #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                    case FREERTOS_SO_IPV6_V6ONLY:
+
+                        if( ( pxSocket->bits.bIsIPv6 == pdFALSE_UNSIGNED ) ||
+                            ( socketSOCKET_IS_BOUND( pxSocket ) ) )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        pxSocket->bits.bV6Only = ( *( ( const BaseType_t * ) pvOptionValue ) != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+                        xReturn = 0;
+                        break;
+                #endif /* ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 ) */
+
+                #if ( ipconfigUSE_SOCKET_BUSY_POLL != 0 )
+                    case FREERTOS_SO_BUSY_POLL:
+                        pxSocket->xBusyPollTime = *( ( const TickType_t * ) pvOptionValue );
+                        xReturn = 0;
+                        break;
+                #endif /* ( ipconfigUSE_SOCKET_BUSY_POLL != 0 ) */
+
+                #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+                    case FREERTOS_SO_DSCP:
+
+                        if( ( *( ( const BaseType_t * ) pvOptionValue ) < 0 ) ||
+                            ( *( ( const BaseType_t * ) pvOptionValue ) > ( BaseType_t ) ipDSCP_MAX ) )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        pxSocket->ucDSCP = ( uint8_t ) *( ( const BaseType_t * ) pvOptionValue );
+
+                        #if ( ipconfigUSE_UDP_CONNECT != 0 )
+                            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+                            {
+                                /* The cached headers still have the old DSCP. */
+                                pxSocket->u.xUDP.xHeaderValid = pdFALSE;
+                            }
+                        #endif
+
+                        xReturn = 0;
+                        break;
+                #endif /* ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 ) */
+
+                #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+                    case FREERTOS_SO_UDP_DIRECT_TX:
+
+                        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_UDP )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        pxSocket->u.xUDP.xDirectTx = ( *( ( const BaseType_t * ) pvOptionValue ) != pdFALSE ) ? pdTRUE : pdFALSE;
+                        xReturn = 0;
+                        break;
+                #endif /* ( ipconfigUSE_UDP_DIRECT_TX != 0 ) */
+
+                #if ( ipconfigUSE_UDP_GSO != 0 )
+                    case FREERTOS_SO_UDP_SEGMENT:
+
+                        if( ( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_UDP ) ||
+                            ( *( ( const BaseType_t * ) pvOptionValue ) < 0 ) ||
+                            ( *( ( const BaseType_t * ) pvOptionValue ) > ( BaseType_t ) 0xFFFF ) )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        pxSocket->u.xUDP.usSegmentSize = ( uint16_t ) *( ( const BaseType_t * ) pvOptionValue );
+                        xReturn = 0;
+                        break;
+                #endif /* ( ipconfigUSE_UDP_GSO != 0 ) */
+
+                #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+                    case FREERTOS_SO_TIMESTAMPING:
+
+                        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_UDP )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        pxSocket->u.xUDP.xTimestamping = ( *( ( const BaseType_t * ) pvOptionValue ) != pdFALSE ) ? pdTRUE : pdFALSE;
+                        xReturn = 0;
+                        break;
+                #endif /* ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 ) */
+
+                #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+                    case FREERTOS_SO_IP_ADD_MEMBERSHIP:
+                    case FREERTOS_SO_IP_DROP_MEMBERSHIP:
+
+                        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_UDP )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        if( lOptionName == FREERTOS_SO_IP_ADD_MEMBERSHIP )
+                        {
+                            xReturn = xMulticastGroupJoin( pxSocket, ( const FreeRTOS_MulticastRequest_t * ) pvOptionValue );
+                        }
+                        else
+                        {
+                            xReturn = xMulticastGroupLeave( pxSocket, ( const FreeRTOS_MulticastRequest_t * ) pvOptionValue );
+                        }
+                        break;
+                #endif /* ( ipconfigSUPPORT_IP_MULTICAST != 0 ) */
+
+                #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+                    case FREERTOS_SO_ACCOUNTING: /* Clear the traffic and time counters. */
+
+                        /* The IP-task updates the counters, do not let it run
+                         * while clearing them. */
+                        vTaskSuspendAll();
+                        {
+                            ( void ) memset( &( pxSocket->xAccounting ), 0, sizeof( pxSocket->xAccounting ) );
+                        }
+                        ( void ) xTaskResumeAll();
+
+                        xReturn = 0;
+                        break;
+                #endif /* ( ipconfigUSE_SOCKET_ACCOUNTING != 0 ) */
+
+            case FREERTOS_SO_UDPCKSUM_OUT:
+
+                /* Turn calculating of the UDP checksum on/off for this socket. If pvOptionValue
+                 * is anything else than NULL, the checksum generation will be turned on. */
+
+                if( pvOptionValue == NULL )
+                {
+                    pxSocket->ucSocketOptions &= ( ( uint8_t ) ~( ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) );
+                }
+                else
+                {
+                    pxSocket->ucSocketOptions |= ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT;
+                }
+
+                xReturn = 0;
+                break;
+
+                #if ( ipconfigUSE_CALLBACKS == 1 )
+                    #if ( ipconfigUSE_TCP == 1 )
+                        case FREERTOS_SO_TCP_CONN_HANDLER: /* Set a callback for (dis)connection events */
+                        case FREERTOS_SO_TCP_RECV_HANDLER: /* Install a callback for receiving TCP data. Supply pointer to 'F_TCP_UDP_Handler_t' (see below) */
+                        case FREERTOS_SO_TCP_SENT_HANDLER: /* Install a callback for sending TCP data. Supply pointer to 'F_TCP_UDP_Handler_t' (see below) */
+                    #endif /* ipconfigUSE_TCP */
+                    case FREERTOS_SO_UDP_RECV_HANDLER:     /* Install a callback for receiving UDP data. Supply pointer to 'F_TCP_UDP_Handler_t' (see below) */
+                    case FREERTOS_SO_UDP_SENT_HANDLER:     /* Install a callback for sending UDP data. Supply pointer to 'F_TCP_UDP_Handler_t' (see below) */
+                        xReturn = prvSetOptionCallback( pxSocket, lOptionName, pvOptionValue );
+                        break;
+                #endif /* ipconfigUSE_CALLBACKS */
+
+                #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE != 0 )
+
+                    /* Each socket has a semaphore on which the using task normally
+                     * sleeps. */
+                    case FREERTOS_SO_SET_SEMAPHORE:
+                        pxSocket->pxUserSemaphore = *( ( SemaphoreHandle_t * ) pvOptionValue );
+                        xReturn = 0;
+                        break;
+                #endif /* ipconfigSOCKET_HAS_USER_SEMAPHORE */
+
+                #if ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK != 0 )
+                    case FREERTOS_SO_WAKEUP_CALLBACK:
+
+                        /* Each socket can have a callback function that is executed
+                         * when there is an event the socket's owner might want to
+                         * process. */
+
+                        /* The type cast of the pointer expression "A" to
+                         * type "B" removes const qualifier from the pointed to type. */
+
+                        ipconfigISO_STRICTNESS_VIOLATION_START;
+
+                        /* MISRA Ref 11.8.1 [Function pointer and use of const pointer] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-118 */
+
+                        /* MISRA Ref 11.1.1 [ Conversion between pointer to
+                         * a function and another type ] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-111 */
+                        /* coverity[misra_c_2012_rule_11_8_violation] */
+                        /* coverity[misra_c_2012_rule_11_1_violation] */
+                        pxSocket->pxUserWakeCallback = ( SocketWakeupCallback_t ) pvOptionValue;
+                        ipconfigISO_STRICTNESS_VIOLATION_END;
+                        xReturn = 0;
+                        break;
+                #endif /* ipconfigSOCKET_HAS_USER_WAKE_CALLBACK */
+
+                #if ( ipconfigUSE_TCP != 0 )
+                    case FREERTOS_SO_SET_LOW_HIGH_WATER:
+                        xReturn = prvSetOptionLowHighWater( pxSocket, pvOptionValue );
+                        break;
+
+                    case FREERTOS_SO_SNDBUF: /* Set the size of the send buffer, in units of MSS (TCP only) */
+                    case FREERTOS_SO_RCVBUF: /* Set the size of the receive buffer, in units of MSS (TCP only) */
+                        xReturn = prvSockopt_so_buffer( pxSocket, lOptionName, pvOptionValue );
+                        break;
+
+                    case FREERTOS_SO_WIN_PROPERTIES: /* Set all buffer and window properties in one call, parameter is pointer to WinProperties_t */
+                        xReturn = prvSetOptionTCPWindows( pxSocket, pvOptionValue );
+                        break;
+
+                    case FREERTOS_SO_REUSE_LISTEN_SOCKET: /* If true, the server-socket will turn into a connected socket */
+                        xReturn = prvSetOptionReuseListenSocket( pxSocket, pvOptionValue );
+                        break;
+
+                    case FREERTOS_SO_CLOSE_AFTER_SEND: /* As soon as the last byte has been transmitted, finalise the connection */
+                        xReturn = prvSetOptionCloseAfterSend( pxSocket, pvOptionValue );
+                        break;
+
+                    case FREERTOS_SO_TCP_CORK: /* Hold back data that does not fill a segment. */
+                        xReturn = prvSetOptionCork( pxSocket, pvOptionValue );
+                        break;
+
+                    case FREERTOS_SO_SET_FULL_SIZE: /* Refuse to send packets smaller than MSS  */
+                        xReturn = prvSetOptionSetFullSize( pxSocket, pvOptionValue );
+                        break;
+
+                    case FREERTOS_SO_STOP_RX: /* Refuse to receive more packets. */
+                        xReturn = prvSetOptionStopRX( pxSocket, pvOptionValue );
+                        break;
+
+                    #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+                        case FREERTOS_SO_TCP_CONGESTION: /* Select the congestion control algorithm. */
+                            xReturn = prvSetOptionCongestionControl( pxSocket, pvOptionValue );
+                            break;
+                    #endif
+
+                    #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+                        case FREERTOS_SO_RX_BUFFER_CHAIN: /* Keep received network buffers, do not copy the data. */
+                            xReturn = prvSetOptionRxBufferChain( pxSocket, pvOptionValue );
+                            break;
+                    #endif
+
+                    #if ( ipconfigTCP_LISTEN_POOL_SIZE != 0 )
+                        case FREERTOS_SO_LISTEN_POOL: /* Create child sockets in advance. */
+                            xReturn = prvSetOptionListenPool( pxSocket, pvOptionValue );
+                            break;
+                    #endif
+
+                    #if ( ipconfigUSE_TCP_PACING != 0 )
+                        case FREERTOS_SO_TCP_PACING: /* Release the segments at a steady rate. */
+                            xReturn = prvSetOptionPacing( pxSocket, pvOptionValue );
+                            break;
+                    #endif
+
+                    #if ( ipconfigUSE_TCP_ACK_POLICY != 0 )
+                        case FREERTOS_SO_TCP_ACK_POLICY: /* Select when ACK's are sent. */
+                            xReturn = prvSetOptionAckPolicy( pxSocket, pvOptionValue );
+                            break;
+                    #endif
+
+                    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+                        case FREERTOS_SO_TCP_FASTOPEN: /* Use TCP Fast Open. */
+                            xReturn = prvSetOptionFastOpen( pxSocket, pvOptionValue );
+                            break;
+                    #endif
+
+                    #if ( ipconfigUSE_TCP_SPLICE != 0 )
+                        case FREERTOS_SO_TCP_SPLICE: /* Forward the received data to another socket. */
+                            xReturn = prvSetOptionSplice( pxSocket, pvOptionValue );
+                            break;
+                    #endif
+
+                    #if ( ipconfigUSE_TCP_RECORD_FRAMING != 0 )
+                        case FREERTOS_SO_TCP_RECORD: /* Only wake up the reader for complete records. */
+                            xReturn = prvSetOptionRecordFraming( pxSocket, pvOptionValue );
+                            break;
+                    #endif
+                #endif /* ipconfigUSE_TCP == 1 */
+
+            default:
+                /* No other options are handled. */
+                xReturn = -pdFREERTOS_ERRNO_ENOPROTOOPT;
+                break;
+        }
+    }
+    else
+    {
+        xReturn = -pdFREERTOS_ERRNO_EINVAL;
+    }
+
+    return xReturn;
+} /* Tested */
+
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Copy the statistics of a TCP connection, for the option
+ *        FREERTOS_SO_TCP_INFO.
+ *
+ * @param[in] pxSocket The TCP socket.
+ * @param[out] pxInfo The structure to be filled in.
+ */
+    static void prvGetOptionTCPInfo( const FreeRTOS_Socket_t * pxSocket,
+                                     TCPInfo_t * pxInfo )
+    {
+        const IPTCPSocket_t * pxTCP = &( pxSocket->u.xTCP );
+        const TCPWindow_t * pxWindow = &( pxTCP->xTCPWindow );
+
+        ( void ) memset( pxInfo, 0, sizeof( *pxInfo ) );
+
+        /* The IP-task updates these fields, take them all at the same moment. */
+        vTaskSuspendAll();
+        {
+            pxInfo->ucState = ( uint8_t ) pxTCP->eTCPState;
+            pxInfo->usMSS = pxTCP->usMSS;
+            pxInfo->ulSRTT = ( uint32_t ) pxWindow->lSRTT;
+            pxInfo->ulRTO = ulTCPWindowTxTimeout( pxWindow );
+            pxInfo->ulRxWindow = pxWindow->xSize.ulRxWindowLength;
+            pxInfo->ulTxWindow = pxWindow->xSize.ulTxWindowLength;
+            pxInfo->ulPeerWindow = pxTCP->ulWindowSize;
+            pxInfo->uxRxStreamSize = pxTCP->uxRxStreamSize;
+            pxInfo->uxTxStreamSize = pxTCP->uxTxStreamSize;
+
+            #if ( ipconfigUSE_TCP_WIN == 1 )
+            {
+                pxInfo->ulRetransmits = pxWindow->ulRetransmitCount;
+                pxInfo->ulFastRetransmits = pxWindow->ulFastRetransmitCount;
+
+                if( xSequenceGreaterThan( pxWindow->tx.ulHighestSequenceNumber, pxWindow->tx.ulCurrentSequenceNumber ) != pdFALSE )
+                {
+                    pxInfo->ulBytesInFlight = pxWindow->tx.ulHighestSequenceNumber - pxWindow->tx.ulCurrentSequenceNumber;
+                }
+
+                #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+                {
+                    pxInfo->ulCongestionWindow = pxWindow->xCongestion.ulWindow;
+                }
+                #endif
+            }
+            #elif ( ipconfigTCP_TINY_TX_SEGMENT_COUNT > 1 )
+            {
+                UBaseType_t uxCount;
+                UBaseType_t uxIndex = pxWindow->uxTxSegmentFirst;
+
+                for( uxCount = 0U; uxCount < pxWindow->uxTxSegmentCount; uxCount++ )
+                {
+                    if( pxWindow->xTxSegments[ uxIndex ].u.bits.bOutstanding != pdFALSE_UNSIGNED )
+                    {
+                        pxInfo->ulBytesInFlight += ( uint32_t ) pxWindow->xTxSegments[ uxIndex ].lDataLength;
+                    }
+
+                    uxIndex = ( uxIndex + 1U ) % ( UBaseType_t ) ipconfigTCP_TINY_TX_SEGMENT_COUNT;
+                }
+            }
+            #else /* if ( ipconfigUSE_TCP_WIN == 1 ) */
+            {
+                if( pxWindow->xTxSegment.u.bits.bOutstanding != pdFALSE_UNSIGNED )
+                {
+                    pxInfo->ulBytesInFlight = ( uint32_t ) pxWindow->xTxSegment.lDataLength;
+                }
+            }
+            #endif /* if ( ipconfigUSE_TCP_WIN == 1 ) */
+
+            if( pxTCP->rxStream != NULL )
+            {
+                pxInfo->uxRxCount = uxStreamBufferGetSize( pxTCP->rxStream );
+            }
+
+            if( pxTCP->txStream != NULL )
+            {
+                pxInfo->uxTxCount = uxStreamBufferGetSize( pxTCP->txStream );
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* ipconfigUSE_TCP == 1 */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get a socket option.
+ *
+ * @param[in] xSocket The socket whose option is requested.
+ * @param[in] lLevel Not used. Parameter is used to maintain the Berkeley sockets
+ *                   standard.
+ * @param[in] lOptionName The name of the option, FREERTOS_SO_TCP_INFO,
+ *                        FREERTOS_SO_TCP_WIN_EVENT_LOG, FREERTOS_SO_TIMESTAMP_TX
+ *                        or FREERTOS_SO_ACCOUNTING.
+ * @param[out] pvOptionValue The buffer that receives the value of the option.
+ * @param[in,out] puxOptionLength On entry the size of the buffer, on return the
+ *                                size of the value.
+ *
+ * @return If the option can be read, 0 is returned.  Otherwise a negative
+ *         error code: -pdFREERTOS_ERRNO_EINVAL for an invalid socket or a
+ *         buffer that is too small, -pdFREERTOS_ERRNO_ENOPROTOOPT for an
+ *         unknown option, -pdFREERTOS_ERRNO_EWOULDBLOCK when no transmit
+ *         time-stamp is available.
+ */
+BaseType_t FreeRTOS_getsockopt( ConstSocket_t xSocket,
+                                int32_t lLevel,
+                                int32_t lOptionName,
+                                void * pvOptionValue,
+                                size_t * puxOptionLength )
+{
+/* The standard Berkeley function returns 0 for success. */
+    BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+    const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+
+    /* The function prototype is designed to maintain the expected Berkeley
+     * sockets standard, but this implementation does not use all the parameters. */
+    ( void ) lLevel;
+
+    if( ( xSocketValid( pxSocket ) == pdTRUE ) && ( pvOptionValue != NULL ) && ( puxOptionLength != NULL ) )
+    {
+        switch( lOptionName )
+        {
+            #if ( ipconfigUSE_TCP == 1 )
+                case FREERTOS_SO_TCP_INFO: /* The statistics of a TCP connection. */
+
+                    if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) &&
+                        ( *puxOptionLength >= sizeof( TCPInfo_t ) ) )
+                    {
+                        prvGetOptionTCPInfo( pxSocket, ( TCPInfo_t * ) pvOptionValue );
+                        *puxOptionLength = sizeof( TCPInfo_t );
+                        xReturn = 0;
+                    }
+
+                    break;
+
+                #if ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 )
+                    case FREERTOS_SO_TCP_WIN_EVENT_LOG: /* The recent events of the TCP window. */
+
+                        if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) &&
+                            ( *puxOptionLength >= sizeof( TCPWinEvent_t ) ) )
+                        {
+                            size_t uxCount;
+
+                            /* The IP-task adds events, do not let it run while copying. */
+                            vTaskSuspendAll();
+                            {
+                                uxCount = uxTCPWindowGetEventLog( &( pxSocket->u.xTCP.xTCPWindow ),
+                                                                  ( TCPWinEvent_t * ) pvOptionValue,
+                                                                  *puxOptionLength / sizeof( TCPWinEvent_t ) );
+                            }
+                            ( void ) xTaskResumeAll();
+
+                            *puxOptionLength = uxCount * sizeof( TCPWinEvent_t );
+                            xReturn = 0;
+                        }
+
+                        break;
+                #endif /* ipconfigUSE_TCP_WIN_EVENT_LOG != 0 */
+            #endif /* ipconfigUSE_TCP == 1 */
+
+            #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+                case FREERTOS_SO_TIMESTAMP_TX: /* The time at which the last datagram was sent. */
+
+                    if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP ) &&
+                        ( *puxOptionLength >= sizeof( NetworkTimestamp_t ) ) )
+                    {
+                        NetworkTimestamp_t * pxTimestamp = ( NetworkTimestamp_t * ) pvOptionValue;
+
+                        /* Drivers report the time-stamps from a task, do not let
+                         * them run while copying it. */
+                        vTaskSuspendAll();
+                        {
+                            *pxTimestamp = pxSocket->u.xUDP.xTxTimestamp;
+                        }
+                        ( void ) xTaskResumeAll();
+
+                        *puxOptionLength = sizeof( NetworkTimestamp_t );
+
+                        if( ( pxTimestamp->ulSeconds == 0U ) && ( pxTimestamp->ulNanoseconds == 0U ) )
+                        {
+                            /* The driver has not reported any datagram yet. */
+                            xReturn = -pdFREERTOS_ERRNO_EWOULDBLOCK;
+                        }
+                        else
+                        {
+                            xReturn = 0;
+                        }
+                    }
+
+                    break;
+            #endif /* ipconfigUSE_NETWORK_TIMESTAMPS != 0 */
+
+            #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+                case FREERTOS_SO_ACCOUNTING: /* The traffic and IP-task time of the socket. */
+
+                    if( *puxOptionLength >= sizeof( SocketAccounting_t ) )
+                    {
+                        /* The IP-task updates the counters, do not let it run
+                         * while copying them. */
+                        vTaskSuspendAll();
+                        {
+                            *( ( SocketAccounting_t * ) pvOptionValue ) = pxSocket->xAccounting;
+                        }
+                        ( void ) xTaskResumeAll();
+
+                        *puxOptionLength = sizeof( SocketAccounting_t );
+                        xReturn = 0;
+                    }
+
+                    break;
+            #endif /* ipconfigUSE_SOCKET_ACCOUNTING != 0 */
+
+            default:
+                /* No other options are handled. */
+                xReturn = -pdFREERTOS_ERRNO_ENOPROTOOPT;
+                break;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+
+/**
+ * @brief Copy the accounting of the sockets in a bound sockets list.
+ *
+ * @param[in] pxList The list of bound TCP or UDP sockets.
+ * @param[out] pxEntries The array that receives the entries.
+ * @param[in] uxCount The number of entries already written.
+ * @param[in] uxMaxEntries The size of the array.
+ *
+ * @return The number of entries written, including the earlier ones.
+ */
+    static UBaseType_t prvGetListAccounting( const List_t * pxList,
+                                             SocketAccountingEntry_t * pxEntries,
+                                             UBaseType_t uxCount,
+                                             UBaseType_t uxMaxEntries )
+    {
+        const ListItem_t * pxEnd = listGET_END_MARKER( pxList );
+        const ListItem_t * pxIterator;
+        UBaseType_t uxIndex = uxCount;
+
+        for( pxIterator = listGET_HEAD_ENTRY( pxList );
+             ( pxIterator != pxEnd ) && ( uxIndex < uxMaxEntries );
+             pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+            SocketAccountingEntry_t * pxEntry = &( pxEntries[ uxIndex ] );
+
+            pxEntry->xSocket = ( Socket_t ) pxSocket;
+            pxEntry->ucProtocol = pxSocket->ucProtocol;
+            pxEntry->usLocalPort = pxSocket->usLocalPort;
+            pxEntry->usRemotePort = 0U;
+
+            #if ( ipconfigUSE_TCP == 1 )
+                if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+                {
+                    pxEntry->usRemotePort = pxSocket->u.xTCP.usRemotePort;
+                }
+            #endif
+
+            pxEntry->xAccounting = pxSocket->xAccounting;
+            uxIndex++;
+        }
+
+        return uxIndex;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Copy the traffic and IP-task time counters of all bound sockets,
+ *        see ipconfigUSE_SOCKET_ACCOUNTING.
+ *
+ * @param[out] pxEntries The array that receives the entries.
+ * @param[in] uxMaxEntries The number of entries in the array.
+ *
+ * @return The number of entries written.
+ */
+    UBaseType_t FreeRTOS_GetSocketAccounting( SocketAccountingEntry_t * pxEntries,
+                                              UBaseType_t uxMaxEntries )
+    {
+        UBaseType_t uxCount = 0U;
+
+        if( ( pxEntries != NULL ) && ( listLIST_IS_INITIALISED( &xBoundUDPSocketsList ) ) )
+        {
+            /* The IP-task updates the counters and the lists, do not let it
+             * run while copying them. */
+            vTaskSuspendAll();
+            {
+                #if ( ipconfigUSE_TCP == 1 )
+                {
+                    uxCount = prvGetListAccounting( &xBoundTCPSocketsList, pxEntries, uxCount, uxMaxEntries );
+                }
+                #endif
+
+                uxCount = prvGetListAccounting( &xBoundUDPSocketsList, pxEntries, uxCount, uxMaxEntries );
+            }
+            ( void ) xTaskResumeAll();
+        }
+
+        return uxCount;
+    }
+
+#endif /* ( ipconfigUSE_SOCKET_ACCOUNTING != 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find an available port number per https://tools.ietf.org/html/rfc6056.
+ *
+ * @param[in] xProtocol FREERTOS_IPPROTO_TCP/FREERTOS_IPPROTO_UDP.
+ *
+ * @return If an available protocol port is found then that port number is returned.
+ *         Or else, 0 is returned.
+ */
+static uint16_t prvGetPrivatePortNumber( BaseType_t xProtocol )
+{
+    const uint16_t usEphemeralPortCount =
+        socketAUTO_PORT_ALLOCATION_MAX_NUMBER - ( uint16_t ) ( socketAUTO_PORT_ALLOCATION_START_NUMBER - 1U );
+    uint16_t usIterations = usEphemeralPortCount;
+    uint32_t ulRandomSeed = 0;
+    uint16_t usResult = 0;
+    const List_t * pxList;
+
+    #if ipconfigUSE_TCP == 1
+        if( xProtocol == ( BaseType_t ) FREERTOS_IPPROTO_TCP )
+        {
+            pxList = &xBoundTCPSocketsList;
+        }
+        else
+    #endif
+    {
+        pxList = &xBoundUDPSocketsList;
+    }
+
+    /* Avoid compiler warnings if ipconfigUSE_TCP is not defined. */
+    ( void ) xProtocol;
+
+    /* Find the next available port using the random seed as a starting
+     * point. */
+    do
+    {
+        /* Only proceed if the random number generator succeeded. */
+        if( xApplicationGetRandomNumber( &( ulRandomSeed ) ) == pdFALSE )
+        {
+            break;
+        }
+
+        /* Map the random to a candidate port. */
+        usResult = ( uint16_t ) ( socketAUTO_PORT_ALLOCATION_START_NUMBER +
+                                  ( ( ( uint16_t ) ulRandomSeed ) % usEphemeralPortCount ) );
+
+        /* Check if there's already an open socket with the same protocol
+         * and port. */
+        if( NULL == pxListFindListItemWithValue(
+                pxList,
+                ( TickType_t ) FreeRTOS_htons( usResult ) ) )
+        {
+            usResult = FreeRTOS_htons( usResult );
+            break;
+        }
+        else
+        {
+            usResult = 0;
+        }
+
+        usIterations--;
+    }
+    while( usIterations > 0U );
+
+    return usResult;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find a list item associated with the wanted-item.
+ *
+ * @param[in] pxList The list through which the search is to be conducted.
+ * @param[in] xWantedItemValue The wanted item whose association is to be found.
+ *
+ * @return The list item holding the value being searched for. If nothing is found,
+ *         then a NULL is returned.
+ */
+static const ListItem_t * pxListFindListItemWithValue( const List_t * pxList,
+                                                       TickType_t xWantedItemValue )
+{
+    const ListItem_t * pxResult = NULL;
+
+    if( ( xIPIsNetworkTaskReady() != pdFALSE ) && ( pxList != NULL ) )
+    {
+        const ListItem_t * pxIterator;
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( pxList->xListEnd ) );
+
+        for( pxIterator = listGET_NEXT( pxEnd );
+             pxIterator != pxEnd;
+             pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            if( listGET_LIST_ITEM_VALUE( pxIterator ) == xWantedItemValue )
+            {
+                pxResult = pxIterator;
+                break;
+            }
+        }
+    }
+
+    return pxResult;
+} /* Tested */
+
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+
+/**
+ * @brief Mix the port numbers and the remote IP address into a hash value.
+ *        The lower bits of the result depend on all bits of the input.
+ *
+ * @param[in] ulLocalPort The local port number.
+ * @param[in] ulRemotePort The remote port number, or zero.
+ * @param[in] ulRemoteIP The (folded) remote IP address, or zero.
+ *
+ * @return The hash value.
+ */
+    static uint32_t prvSocketHashKey( uint32_t ulLocalPort,
+                                      uint32_t ulRemotePort,
+                                      uint32_t ulRemoteIP )
+    {
+        uint32_t ulHash = ( ( ulLocalPort & 0xffffU ) << 16 ) | ( ulRemotePort & 0xffffU );
+
+        ulHash ^= ulRemoteIP;
+        ulHash ^= ulHash >> 16;
+        ulHash *= 0x045D9F3BU;
+        ulHash ^= ulHash >> 16;
+
+        return ulHash;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Fold an IPv4 or IPv6 address into 32 bits, to be used in the hash.
+ *
+ * @param[in] xIsIPv6 pdTRUE when pxAddress holds an IPv6 address.
+ * @param[in] pxAddress The address to be folded.
+ *
+ * @return The folded address.
+ */
+        static uint32_t prvSocketHashAddress( BaseType_t xIsIPv6,
+                                              const IP_Address_t * pxAddress )
+        {
+            uint32_t ulResult;
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( xIsIPv6 != pdFALSE )
+                {
+                    uint32_t ulWord;
+                    size_t uxIndex;
+
+                    ulResult = 0U;
+
+                    for( uxIndex = 0U; uxIndex < ipSIZE_OF_IPv6_ADDRESS; uxIndex += sizeof( ulWord ) )
+                    {
+                        ( void ) memcpy( &ulWord, &( pxAddress->xIP_IPv6.ucBytes[ uxIndex ] ), sizeof( ulWord ) );
+                        ulResult ^= ulWord;
+                    }
+                }
+                else
+            #else
+                ( void ) xIsIPv6;
+            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+            {
+                ulResult = pxAddress->ulIP_IPv4;
+            }
+
+            return ulResult;
+        }
+    #endif /* ipconfigUSE_TCP == 1 */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the hash bucket of a socket. A UDP socket is hashed on its
+ *        local port. A TCP socket is hashed on its local port, remote port
+ *        and remote IP address, except a listening socket, which is hashed
+ *        on its local port only.
+ *
+ * @param[in] pxSocket The socket, which must be bound.
+ *
+ * @return The bucket to which the socket belongs.
+ */
+    static List_t * prvSocketHashBucket( const FreeRTOS_Socket_t * pxSocket )
+    {
+        uint32_t ulHash;
+        List_t * pxBucket;
+
+        #if ( ipconfigUSE_TCP == 1 )
+            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+            {
+                if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
+                {
+                    ulHash = prvSocketHashKey( ( uint32_t ) pxSocket->usLocalPort, 0U, 0U );
+                }
+                else
+                {
+                    BaseType_t xIsIPv6 = ( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED ) ? pdTRUE : pdFALSE;
+
+                    ulHash = prvSocketHashKey( ( uint32_t ) pxSocket->usLocalPort,
+                                               ( uint32_t ) pxSocket->u.xTCP.usRemotePort,
+                                               prvSocketHashAddress( xIsIPv6, &( pxSocket->u.xTCP.xRemoteIP ) ) );
+                }
+
+                pxBucket = &( xTCPSocketHashTable[ ulHash & socketHASH_MASK ] );
+            }
+            else
+        #endif /* ipconfigUSE_TCP == 1 */
+        {
+            ulHash = prvSocketHashKey( ( uint32_t ) socketGET_SOCKET_PORT( pxSocket ), 0U, 0U );
+            pxBucket = &( xUDPSocketHashTable[ ulHash & socketHASH_MASK ] );
+        }
+
+        return pxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a socket that has just been bound to its hash bucket.
+ *
+ * @param[in] pxSocket The socket.
+ */
+    static void prvSocketHashInsert( FreeRTOS_Socket_t * pxSocket )
+    {
+        vListInsertEnd( prvSocketHashBucket( pxSocket ), &( pxSocket->xHashListItem ) );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a socket from its hash bucket, if it is in one.
+ *
+ * @param[in] pxSocket The socket.
+ */
+    static void prvSocketHashRemove( FreeRTOS_Socket_t * pxSocket )
+    {
+        if( listLIST_ITEM_CONTAINER( &( pxSocket->xHashListItem ) ) != NULL )
+        {
+            ( void ) uxListRemove( &( pxSocket->xHashListItem ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the bound UDP socket with a given port number by looking in a
+ *        single hash bucket.
+ *
+ * @param[in] xWantedItemValue The port number in network-byte-order.
+ *
+ * @return The 'xBoundSocketListItem' of the socket found, or NULL.
+ */
+    static const ListItem_t * prvUDPSocketHashFind( TickType_t xWantedItemValue )
+    {
+        const ListItem_t * pxResult = NULL;
+
+        if( xIPIsNetworkTaskReady() != pdFALSE )
+        {
+            const List_t * pxBucket = &( xUDPSocketHashTable[ prvSocketHashKey( ( uint32_t ) xWantedItemValue, 0U, 0U ) & socketHASH_MASK ] );
+            const ListItem_t * pxEnd = listGET_END_MARKER( pxBucket );
+            const ListItem_t * pxIterator;
+
+            for( pxIterator = listGET_NEXT( pxEnd );
+                 pxIterator != pxEnd;
+                 pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                const FreeRTOS_Socket_t * pxSocket = ( ( const FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                if( socketGET_SOCKET_PORT( pxSocket ) == xWantedItemValue )
+                {
+                    pxResult = &( pxSocket->xBoundSocketListItem );
+                    break;
+                }
+            }
+        }
+
+        return pxResult;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Move a TCP socket to the hash bucket that belongs to its current
+ *        state, port numbers and remote address. Called by the IP-task when
+ *        the remote address of a socket has been set.
+ *
+ * @param[in] pxSocket The socket.
+ */
+        void vSocketHashUpdate( FreeRTOS_Socket_t * pxSocket )
+        {
+            if( socketSOCKET_IS_BOUND( pxSocket ) )
+            {
+                List_t * pxBucket = prvSocketHashBucket( pxSocket );
+
+                if( listLIST_ITEM_CONTAINER( &( pxSocket->xHashListItem ) ) != pxBucket )
+                {
+                    prvSocketHashRemove( pxSocket );
+                    vListInsertEnd( pxBucket, &( pxSocket->xHashListItem ) );
+                }
+            }
+        }
+    #endif /* ipconfigUSE_TCP == 1 */
+
+#endif /* ipconfigUSE_SOCKET_HASH_LOOKUP != 0 */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the UDP socket corresponding to the port number.
+ *
+ * @param[in] uxLocalPort The port whose corresponding bound UDP socket
+ *                         is to be found.
+ *
+ * @return The socket owning the port if found or else NULL.
+ */
+FreeRTOS_Socket_t * pxUDPSocketLookup( UBaseType_t uxLocalPort )
+{
+    const ListItem_t * pxListItem;
+    FreeRTOS_Socket_t * pxSocket = NULL;
+
+    /* Looking up a socket is quite simple, find a match with the local port.
+     *
+     * See if there is a list item associated with the port number on the
+     * list of bound sockets. */
+    #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+        pxListItem = prvUDPSocketHashFind( ( TickType_t ) uxLocalPort );
+    #else
+        pxListItem = pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) uxLocalPort );
+    #endif
+
+    if( pxListItem != NULL )
+    {
+        /* The owner of the list item is the socket itself. */
+        pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxListItem ) );
+        configASSERT( pxSocket != NULL );
+    }
+
+    return pxSocket;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) )
+
+/**
+ * @brief Mix the address and port of a peer into a hash value, which selects
+ *        one of the sockets that share a port.  All packets of a flow give
+ *        the same value.
+ *
+ * @param[in] pxAddress The address of the peer.
+ * @param[in] xIsIPv6 pdTRUE when 'pxAddress' holds an IPv6 address.
+ * @param[in] usPort The port number of the peer.
+ *
+ * @return The hash value.
+ */
+    static uint32_t prvSocketReusePortHash( const IP_Address_t * pxAddress,
+                                            BaseType_t xIsIPv6,
+                                            uint16_t usPort )
+    {
+        uint32_t ulHash;
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            if( xIsIPv6 != pdFALSE )
+            {
+                uint32_t ulWord;
+                size_t uxIndex;
+
+                ulHash = 0U;
+
+                for( uxIndex = 0U; uxIndex < ipSIZE_OF_IPv6_ADDRESS; uxIndex += sizeof( ulWord ) )
+                {
+                    ( void ) memcpy( &ulWord, &( pxAddress->xIP_IPv6.ucBytes[ uxIndex ] ), sizeof( ulWord ) );
+                    ulHash ^= ulWord;
+                }
+            }
+            else
+        #else
+            ( void ) xIsIPv6;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        {
+            ulHash = pxAddress->ulIP_IPv4;
+        }
+
+        ulHash ^= ( uint32_t ) usPort << 16;
+        ulHash ^= ulHash >> 16;
+        ulHash *= 0x045D9F3BU;
+        ulHash ^= ulHash >> 16;
+
+        return ulHash;
+    }
+
+#endif /* ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_UDP_REUSEPORT != 0 )
+
+/**
+ * @brief Several UDP sockets may share a port when they have all set
+ *        FREERTOS_SO_REUSEPORT. Choose one of them for a received packet,
+ *        based on a hash of its source address and source port, so that
+ *        all packets of a flow are delivered to the same socket.
+ *
+ * @param[in] pxSocket The socket returned by pxUDPSocketLookup().
+ * @param[in] pxNetworkBuffer The received packet, 'xIPAddress' and 'usPort'
+ *                            hold the source address and port.
+ * @param[in] xIsIPv6 pdTRUE when the packet is an IPv6 packet.
+ *
+ * @return The socket that will receive the packet.
+ */
+    FreeRTOS_Socket_t * pxUDPSocketSelectReusePort( FreeRTOS_Socket_t * pxSocket,
+                                                    const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                    BaseType_t xIsIPv6 )
+    {
+        FreeRTOS_Socket_t * pxResult = pxSocket;
+        TickType_t xPort = ( TickType_t ) socketGET_SOCKET_PORT( pxSocket );
+        const List_t * pxList;
+        const ListItem_t * pxEnd;
+        const ListItem_t * pxIterator;
+        const FreeRTOS_Socket_t * pxCandidate;
+        uint32_t ulHash;
+        uint32_t ulCount = 0U;
+
+        #if ( ( ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS != 0 ) && ( ipconfigUSE_IPv6 == 0 ) )
+        {
+            /* A compact descriptor only stores the IPv4 address. */
+            IP_Address_t xAddress;
+
+            xAddress.ulIP_IPv4 = pxNetworkBuffer->xIPAddress.ulIP_IPv4;
+            ulHash = prvSocketReusePortHash( &( xAddress ), xIsIPv6, pxNetworkBuffer->usPort );
+        }
+        #else
+        {
+            ulHash = prvSocketReusePortHash( &( pxNetworkBuffer->xIPAddress ), xIsIPv6, pxNetworkBuffer->usPort );
+        }
+        #endif
+
+        #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+            /* All sockets on this port are stored in the same bucket. */
+            pxList = prvSocketHashBucket( pxSocket );
+        #else
+            pxList = &xBoundUDPSocketsList;
+        #endif
+
+        pxEnd = listGET_END_MARKER( pxList );
+
+        /* First count the sockets that share the port, then take the chosen one. */
+        for( pxIterator = listGET_NEXT( pxEnd ); pxIterator != pxEnd; pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            pxCandidate = ( ( const FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+            if( socketGET_SOCKET_PORT( pxCandidate ) == xPort )
+            {
+                ulCount++;
+            }
+        }
+
+        if( ulCount > 1U )
+        {
+            ulHash %= ulCount;
+
+            for( pxIterator = listGET_NEXT( pxEnd ); pxIterator != pxEnd; pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                pxCandidate = ( ( const FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                if( socketGET_SOCKET_PORT( pxCandidate ) == xPort )
+                {
+                    if( ulHash == 0U )
+                    {
+                        pxResult = ( FreeRTOS_Socket_t * ) pxCandidate;
+                        break;
+                    }
+
+                    ulHash--;
+                }
+            }
+        }
+
+        return pxResult;
+    }
+
+#endif /* ( ipconfigUSE_UDP_REUSEPORT != 0 ) */
+/*-----------------------------------------------------------*/
+
+#define sockDIGIT_COUNT    ( 3U ) /**< Each nibble is expressed in at most 3 digits such as "192". */
+
+/**
+ * @brief Convert the 32-bit representation of the IP-address to the dotted decimal
+ *        notation after some checks.
+ *        A safe alternative is FreeRTOS_inet_ntop4().
+ *
+ * @param[in] ulIPAddress 32-bit representation of the IP-address.
+ * @param[out] pcBuffer The buffer where the dotted decimal representation will be
+ *                      stored if all checks pass. The buffer must be at least 16
+ *                      bytes long.
+ *
+ * @return The pointer returned will be same as pcBuffer and will have the address
+ *         stored in the location.
+ */
+const char * FreeRTOS_inet_ntoa( uint32_t ulIPAddress,
+                                 char * pcBuffer )
+{
+    socklen_t uxNibble;
+    socklen_t uxIndex = 0;
+    const uint8_t * pucAddress = ( const uint8_t * ) &( ulIPAddress );
+    const char * pcResult = pcBuffer;
+
+    for( uxNibble = 0; uxNibble < ipSIZE_OF_IPv4_ADDRESS; uxNibble++ )
+    {
+        uint8_t pucDigits[ sockDIGIT_COUNT ];
+        uint8_t ucValue = pucAddress[ uxNibble ];
+        socklen_t uxSource = ( socklen_t ) sockDIGIT_COUNT - ( socklen_t ) 1U;
+
+        for( ; ; )
+        {
+            pucDigits[ uxSource ] = ucValue % ( uint8_t ) 10U;
+            ucValue /= ( uint8_t ) 10U;
+
+            if( uxSource == 1U )
+            {
+                break;
+            }
+
+            uxSource--;
+        }
+
+        pucDigits[ 0 ] = ucValue;
+
+        /* Skip leading zeros. */
+        for( uxSource = 0; uxSource < ( ( socklen_t ) sockDIGIT_COUNT - ( socklen_t ) 1U ); uxSource++ )
+        {
+            if( pucDigits[ uxSource ] != 0U )
+            {
+                break;
+            }
+        }
+
+        for( ; uxSource < ( socklen_t ) sockDIGIT_COUNT; uxSource++ )
+        {
+            pcBuffer[ uxIndex ] = ( char ) ( pucDigits[ uxSource ] + ( char ) '0' );
+            uxIndex++;
+        }
+
+        if( uxNibble < ( ipSIZE_OF_IPv4_ADDRESS - 1U ) )
+        {
+            pcBuffer[ uxIndex ] = '.';
+        }
+        else
+        {
+            pcBuffer[ uxIndex ] = '\0';
+        }
+
+        uxIndex++;
+    }
+
+    return pcResult;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Convert the dotted decimal format of the IP-address to the 32-bit representation.
+ *
+ * @param[in] xAddressFamily The Address family to which the IP-address belongs to. Only
+ *                            FREERTOS_AF_INET (IPv4) is supported.
+ * @param[in] pcSource Pointer to the string holding the dotted decimal representation of
+ *                      the IP-address.
+ * @param[out] pvDestination The pointer to the address struct/variable where the converted
+ *                            IP-address will be stored. The buffer must be 4 bytes long
+ *                            in case of a IPv4 address.
+ *
+ * @return If all checks pass, then pdPASS is returned or else pdFAIL is returned.
+ */
+BaseType_t FreeRTOS_inet_pton( BaseType_t xAddressFamily,
+                               const char * pcSource,
+                               void * pvDestination )
+{
+    BaseType_t xResult;
+
+    /* Printable string to struct sockaddr. */
+    switch( xAddressFamily )
+    {
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case FREERTOS_AF_INET:
+                xResult = FreeRTOS_inet_pton4( pcSource, pvDestination );
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case FREERTOS_AF_INET6:
+                xResult = FreeRTOS_inet_pton6( pcSource, pvDestination );
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+        default:
+            xResult = -pdFREERTOS_ERRNO_EAFNOSUPPORT;
+            break;
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Convert the 32-bit representation of the IP-address to the dotted
+ *        decimal format based on the Address Family. (Only FREERTOS_AF_INET
+ *        is allowed).
+ *
+ * @param[in] xAddressFamily The address family of the IP-address.
+ * @param[in] pvSource Pointer to the 32-bit representation of IP-address.
+ * @param[out] pcDestination The pointer to the character array where the dotted
+ *                            decimal address will be stored if every check does pass.
+ * @param[in] uxSize Size of the character array. This value makes sure that the code
+ *                    doesn't write beyond it's bounds.
+ *
+ * @return If every check does pass, then the pointer to the pcDestination is returned
+ *         holding the dotted decimal format of IP-address. Else, a NULL is returned.
+ */
+const char * FreeRTOS_inet_ntop( BaseType_t xAddressFamily,
+                                 const void * pvSource,
+                                 char * pcDestination,
+                                 socklen_t uxSize )
+{
+    const char * pcResult;
+
+    /* Printable struct sockaddr to string. */
+    switch( xAddressFamily )
+    {
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case FREERTOS_AF_INET4:
+                pcResult = FreeRTOS_inet_ntop4( pvSource, pcDestination, uxSize );
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case FREERTOS_AF_INET6:
+                pcResult = FreeRTOS_inet_ntop6( pvSource, pcDestination, uxSize );
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+        default:
+            /* errno should be set to pdFREERTOS_ERRNO_EAFNOSUPPORT. */
+            pcResult = NULL;
+            break;
+    }
+
+    return pcResult;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Convert an ASCII character to its corresponding hexadecimal value.
+ *        Accepted characters are 0-9, a-f, and A-F.
+ *
+ * @param[in] cChar The character to be converted.
+ *
+ * @return The hexadecimal value, between 0 and 15.
+ *         When the character is not valid, socketINVALID_HEX_CHAR will be returned.
+ */
+
+uint8_t ucASCIIToHex( char cChar )
+{
+    char cValue = cChar;
+    uint8_t ucNew;
+
+    if( ( cValue >= '0' ) && ( cValue <= '9' ) )
+    {
+        cValue = ( char ) ( cValue - ( uint8_t ) '0' );
+        /* The value will be between 0 and 9. */
+        ucNew = ( uint8_t ) cValue;
+    }
+    else if( ( cValue >= 'a' ) && ( cValue <= 'f' ) )
+    {
+        cValue = ( char ) ( cValue - ( uint8_t ) 'a' );
+        ucNew = ( uint8_t ) cValue;
+        /* The value will be between 10 and 15. */
+        ucNew = ( uint8_t ) ( ucNew + ( uint8_t ) 10 );
+    }
+    else if( ( cValue >= 'A' ) && ( cValue <= 'F' ) )
+    {
+        cValue = ( char ) ( cValue - ( uint8_t ) 'A' );
+        ucNew = ( uint8_t ) cValue;
+        /* The value will be between 10 and 15. */
+        ucNew = ( uint8_t ) ( ucNew + ( uint8_t ) 10 );
+    }
+    else
+    {
+        /* The character does not represent a valid hex number, return 255. */
+        ucNew = ( uint8_t ) socketINVALID_HEX_CHAR;
+    }
+
+    return ucNew;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief This function converts a 48-bit MAC address to a human readable string.
+ *
+ * @param[in] pucSource A pointer to an array of 6 bytes.
+ * @param[out] pcTarget A buffer that is 18 bytes long, it will contain the resulting string.
+ * @param[in] cTen Either an 'A' or an 'a'. It determines whether the hex numbers will use
+ *                  capital or small letters.
+ * @param[in] cSeparator The separator that should appear between the bytes, either ':' or '-'.
+ */
+void FreeRTOS_EUI48_ntop( const uint8_t * pucSource,
+                          char * pcTarget,
+                          char cTen,
+                          char cSeparator )
+{
+    size_t uxIndex;
+    size_t uxNibble;
+    size_t uxTarget = 0U;
+
+    for( uxIndex = 0U; uxIndex < ipMAC_ADDRESS_LENGTH_BYTES; uxIndex++ )
+    {
+        uint8_t ucByte = pucSource[ uxIndex ];
+
+        for( uxNibble = 0; uxNibble < 2U; uxNibble++ )
+        {
+            uint8_t ucNibble;
+            char cResult;
+
+            if( uxNibble == 0U )
+            {
+                ucNibble = ucByte >> 4;
+            }
+            else
+            {
+                ucNibble = ucByte & 0x0FU;
+            }
+
+            if( ucNibble <= 0x09U )
+            {
+                cResult = '0';
+                cResult = ( char ) ( cResult + ucNibble );
+            }
+            else
+            {
+                cResult = cTen; /* Either 'a' or 'A' */
+                cResult = ( char ) ( cResult + ucNibble );
+                cResult = ( char ) ( cResult - ( uint8_t ) 10U );
+            }
+
+            pcTarget[ uxTarget ] = cResult;
+            uxTarget++;
+        }
+
+        if( uxIndex == ( ipMAC_ADDRESS_LENGTH_BYTES - 1U ) )
+        {
+            pcTarget[ uxTarget ] = ( char ) 0;
+            uxTarget++;
+        }
+        else
+        {
+            pcTarget[ uxTarget ] = cSeparator;
+            uxTarget++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief This function converts a human readable string, representing an 48-bit MAC address,
+ *        into a 6-byte address. Valid inputs are e.g. "62:48:5:83:A0:b2" and "0-12-34-fe-dc-ba".
+ *
+ * @param[in] pcSource The null terminated string to be parsed.
+ * @param[out] pucTarget A buffer that is 6 bytes long, it will contain the MAC address.
+ *
+ * @return pdTRUE in case the string got parsed correctly, otherwise pdFALSE.
+ */
+BaseType_t FreeRTOS_EUI48_pton( const char * pcSource,
+                                uint8_t * pucTarget )
+{
+    BaseType_t xResult = pdFALSE;
+    size_t uxByteNr = 0U;
+    size_t uxSourceIndex;
+    size_t uxNibbleCount = 0U;
+    size_t uxLength = strlen( pcSource );
+    uint32_t uxSum = 0U;
+    uint8_t ucHex;
+    char cChar;
+
+    /* Ignore the following line from branch coverage since the exits from this loop are
+     * covered by break statements. The loop is kept as is to future proof the code against
+     * any changes. LCOV_EXCL_BR_START */
+    for( uxSourceIndex = 0U; uxSourceIndex <= uxLength; uxSourceIndex++ )
+    /* LCOV_EXCL_BR_STOP */
+    {
+        cChar = pcSource[ uxSourceIndex ];
+        ucHex = ucASCIIToHex( cChar );
+
+        if( ucHex != socketINVALID_HEX_CHAR )
+        {
+            /* A valid nibble was found. Shift it into the accumulator. */
+            uxSum = uxSum << 4;
+
+            if( uxSum > 0xffU )
+            {
+                /* A hex value was too big. */
+                break;
+            }
+
+            uxSum |= ucHex;
+            uxNibbleCount++;
+        }
+        else
+        {
+            if( uxNibbleCount != 2U )
+            {
+                /* Each number should have 2 nibbles. */
+                break;
+            }
+
+            pucTarget[ uxByteNr ] = ( uint8_t ) uxSum;
+            uxSum = 0U;
+            uxNibbleCount = 0U;
+            uxByteNr++;
+
+            if( uxByteNr == ipMAC_ADDRESS_LENGTH_BYTES )
+            {
+                xResult = pdTRUE;
+                break;
+            }
+
+            if( ( cChar != ':' ) && ( cChar != '-' ) )
+            {
+                /* Invalid character. */
+                break;
+            }
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_IPv4 != 0 )
+
+/**
+ * @brief Convert the IP address from "w.x.y.z" (dotted decimal) format to the 32-bit format.
+ *
+ * @param[in] pcIPAddress The character string pointer holding the IP-address in the "W.X.Y.Z"
+ *                         (dotted decimal) format.
+ *
+ * @return The 32-bit representation of IP(v4) address.
+ */
+    uint32_t FreeRTOS_inet_addr( const char * pcIPAddress )
+    {
+        uint32_t ulReturn = 0U;
+
+        /* inet_pton AF_INET target is a 4-byte 'struct in_addr'. */
+        if( pdFAIL == FreeRTOS_inet_pton4( pcIPAddress, &( ulReturn ) ) )
+        {
+            /* Return 0 if translation failed. */
+            ulReturn = 0U;
+        }
+
+        return ulReturn;
+    }
+    /*-----------------------------------------------------------*/
+#endif /* ipconfigUSE_IPv4 != 0 ) */
+
+/**
+ * @brief Function to get the local address and IP port of the given socket.
+ *
+ * @param[in] xSocket Socket whose port is to be added to the pxAddress.
+ * @param[out] pxAddress Structure in which the IP address and the port number
+ *                        is returned.
+ *
+ * @return Size of the freertos_sockaddr structure.
+ */
+size_t FreeRTOS_GetLocalAddress( ConstSocket_t xSocket,
+                                 struct freertos_sockaddr * pxAddress )
+{
+    const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+
+    switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
+    {
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case pdFALSE_UNSIGNED:
+                pxAddress->sin_family = FREERTOS_AF_INET;
+                pxAddress->sin_len = ( uint8_t ) sizeof( *pxAddress );
+                /* IP address of local machine. */
+                pxAddress->sin_address.ulIP_IPv4 = FreeRTOS_htonl( pxSocket->xLocalAddress.ulIP_IPv4 );
+
+                /* Local port on this machine. */
+                pxAddress->sin_port = FreeRTOS_htons( pxSocket->usLocalPort );
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case pdTRUE_UNSIGNED:
+                pxAddress->sin_family = FREERTOS_AF_INET6;
+                /* IP address of local machine. */
+                ( void ) memcpy( pxAddress->sin_address.xIP_IPv6.ucBytes, pxSocket->xLocalAddress.xIP_IPv6.ucBytes, sizeof( pxAddress->sin_address.xIP_IPv6.ucBytes ) );
+                /* Local port on this machine. */
+                pxAddress->sin_port = FreeRTOS_htons( pxSocket->usLocalPort );
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+        default:
+            /* MISRA 16.4 Compliance */
+            break;
+    }
+
+    #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+        prvSocketMapAddress( pxSocket, pxAddress );
+    #endif
+
+    return sizeof( *pxAddress );
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigSOCKET_USES_NOTIFY != 0 )
+
+/**
+ * @brief Set event bits of a socket and notify the task that is blocked on it.
+ *        This replaces xEventGroupSetBits() when sockets do not own an event group.
+ *
+ * @param[in] pxSocket The socket whose event bits will be set.
+ * @param[in] xBitsToSet The bits to be set.
+ */
+    void vSocketEventSet( FreeRTOS_Socket_t * pxSocket,
+                          EventBits_t xBitsToSet )
+    {
+        TaskHandle_t xTask;
+
+        taskENTER_CRITICAL();
+        {
+            pxSocket->xNotifyBits |= xBitsToSet;
+            xTask = pxSocket->xNotifyTask;
+        }
+        taskEXIT_CRITICAL();
+
+        if( xTask != NULL )
+        {
+            ( void ) xTaskNotifyGiveIndexed( xTask, ipconfigSOCKET_NOTIFY_INDEX );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Wait for one or more event bits of a socket, blocking on the task
+ *        notification ipconfigSOCKET_NOTIFY_INDEX of the calling task. Only
+ *        one task can block on a socket at the same time.
+ *
+ * @param[in] pxSocket The socket to wait on.
+ * @param[in] xBitsToWaitFor The bits of interest.
+ * @param[in] xClearOnExit When pdTRUE, the bits of interest that were set will
+ *                         be cleared before returning.
+ * @param[in] xTicksToWait The maximum time to wait.
+ *
+ * @return The event bits of the socket as they were before clearing.
+ */
+    EventBits_t xSocketEventWait( FreeRTOS_Socket_t * pxSocket,
+                                  EventBits_t xBitsToWaitFor,
+                                  BaseType_t xClearOnExit,
+                                  TickType_t xTicksToWait )
+    {
+        EventBits_t xBits;
+        TimeOut_t xTimeOut;
+        TickType_t xRemainingTime = xTicksToWait;
+        TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        taskENTER_CRITICAL();
+        {
+            /* Only one task may block on a socket at a time. */
+            configASSERT( ( pxSocket->xNotifyTask == NULL ) || ( pxSocket->xNotifyTask == xCurrentTask ) );
+            pxSocket->xNotifyTask = xCurrentTask;
+        }
+        taskEXIT_CRITICAL();
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                xBits = pxSocket->xNotifyBits;
+
+                if( ( ( xBits & xBitsToWaitFor ) != 0U ) && ( xClearOnExit != pdFALSE ) )
+                {
+                    pxSocket->xNotifyBits &= ~xBitsToWaitFor;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( ( xBits & xBitsToWaitFor ) != 0U )
+            {
+                break;
+            }
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
+            {
+                break;
+            }
+
+            /* A notification that was given after an earlier wait returned
+             * only causes one more pass through this loop. */
+            ( void ) ulTaskNotifyTakeIndexed( ipconfigSOCKET_NOTIFY_INDEX, pdTRUE, xRemainingTime );
+        }
+
+        taskENTER_CRITICAL();
+        {
+            pxSocket->xNotifyTask = NULL;
+        }
+        taskEXIT_CRITICAL();
+
+        return xBits;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigSOCKET_USES_NOTIFY != 0 */
+
+/**
+ * @brief Wake up the user of the given socket through event-groups.
+ *
+ * @param[in] pxSocket The socket whose user is to be woken up.
+ */
+void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
+{
+/* _HT_ must work this out, now vSocketWakeUpUser will be called for any important
+ * event or transition */
+    #if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+    {
+        if( pxSocket->pxAsyncRing != NULL )
+        {
+            vSocketAsyncWakeUp( pxSocket );
+        }
+    }
+    #endif /* ipconfigSUPPORT_ASYNC_SOCKETS */
+
+    #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
+    {
+        if( pxSocket->pxUserSemaphore != NULL )
+        {
+            ( void ) xSemaphoreGive( pxSocket->pxUserSemaphore );
+        }
+    }
+    #endif /* ipconfigSOCKET_HAS_USER_SEMAPHORE */
+
+    #if ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK == 1 )
+    {
+        if( pxSocket->pxUserWakeCallback != NULL )
+        {
+            pxSocket->pxUserWakeCallback( pxSocket );
+        }
+    }
+    #endif /* ipconfigSOCKET_HAS_USER_WAKE_CALLBACK */
+
+    #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+    {
+        if( pxSocket->pxSocketSet != NULL )
+        {
+            EventBits_t xSelectBits = ( pxSocket->xEventBits >> SOCKET_EVENT_BIT_COUNT ) & ( ( EventBits_t ) eSELECT_ALL );
+
+            if( xSelectBits != 0U )
+            {
+                #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+                {
+                    prvSelectReadyListAdd( pxSocket, xSelectBits );
+                }
+                #else
+                {
+                    pxSocket->xSocketBits |= xSelectBits;
+                }
+                #endif
+                ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, xSelectBits );
+            }
+        }
+
+        pxSocket->xEventBits &= ( EventBits_t ) eSOCKET_ALL;
+    }
+    #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
+
+    #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+        if( ( pxSocket->xEventGroup != NULL ) && ( pxSocket->xEventBits != 0U ) )
+    #else
+        if( pxSocket->xEventBits != 0U )
+    #endif
+    {
+        vSocketEventSet( pxSocket, pxSocket->xEventBits );
+    }
+
+    pxSocket->xEventBits = 0U;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
+
+/**
+ * @brief This define makes it possible for network interfaces to inspect
+ *        UDP messages and see if there is any UDP socket bound to a given port
+ *        number.  This is probably only useful in systems with a minimum of
+ *        RAM and when lots of anonymous broadcast messages come in.
+ *
+ * @param[in] usPortNr the port number to look for.
+ *
+ * @return xFound if a socket with the port number is found.
+ */
+    BaseType_t xPortHasUDPSocket( uint16_t usPortNr )
+    {
+        BaseType_t xFound = pdFALSE;
+
+        vTaskSuspendAll();
+        {
+            #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+                if( prvUDPSocketHashFind( ( TickType_t ) usPortNr ) != NULL )
+            #else
+                if( ( pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) usPortNr ) != NULL ) )
+            #endif
+            {
+                xFound = pdTRUE;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xFound;
+    }
+
+#endif /* ipconfigETHERNET_DRIVER_FILTERS_PACKETS */
+
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Check if it makes any sense to wait for a connect event.
+ *
+ * @param[in] pxSocket The socket trying to connect.
+ *
+ * @return It may return: -EINPROGRESS, -EAGAIN, or 0 for OK.
+ */
+    static BaseType_t bMayConnect( FreeRTOS_Socket_t const * pxSocket )
+    {
+        BaseType_t xResult;
+
+        eIPTCPState_t eState = pxSocket->u.xTCP.eTCPState;
+
+        switch( eState )
+        {
+            case eCLOSED:
+            case eCLOSE_WAIT:
+                xResult = 0;
+                break;
+
+            case eCONNECT_SYN:
+                xResult = -pdFREERTOS_ERRNO_EINPROGRESS;
+                break;
+
+            case eTCP_LISTEN:
+            case eSYN_FIRST:
+            case eSYN_RECEIVED:
+            case eESTABLISHED:
+            case eFIN_WAIT_1:
+            case eFIN_WAIT_2:
+            case eCLOSING:
+            case eLAST_ACK:
+            case eTIME_WAIT:
+            default:
+                xResult = -pdFREERTOS_ERRNO_EAGAIN;
+                break;
+        }
+
+        return xResult;
+    }
+
+
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Called from #FreeRTOS_connect(): make some checks and if allowed,
+ *        send a message to the IP-task to start connecting to a remote socket.
+ *
+ * @param[in] pxSocket The socket attempting to connect to a remote port.
+ * @param[in] pxAddress The address the socket is trying to connect to.
+ *
+ * @return 0 on successful checks or a negative error code.
+ */
+    static BaseType_t prvTCPConnectStart( FreeRTOS_Socket_t * pxSocket,
+                                          struct freertos_sockaddr const * pxAddress )
+    {
+        BaseType_t xResult = 0;
+
+        if( pxAddress == NULL )
+        {
+            /* NULL address passed to the function. Invalid value. */
+            xResult = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdFALSE )
+        {
+            /* Not a valid socket or wrong type */
+            xResult = -pdFREERTOS_ERRNO_EBADF;
+        }
+        else if( FreeRTOS_issocketconnected( pxSocket ) > 0 )
+        {
+            /* The socket is already connected. */
+            xResult = -pdFREERTOS_ERRNO_EISCONN;
+        }
+        else if( !socketSOCKET_IS_BOUND( pxSocket ) )
+        {
+            /* Bind the socket to the port that the client task will send from.
+             * Non-standard, so the error returned is that returned by bind(). */
+            xResult = FreeRTOS_bind( pxSocket, NULL, 0U );
+        }
+        else
+        {
+            /* The socket is valid, not yet connected, and already bound to a port number. */
+        }
+
+        if( xResult == 0 )
+        {
+            /* Check if it makes any sense to wait for a connect event, this condition
+             * might change while sleeping, so it must be checked within each loop */
+            xResult = bMayConnect( pxSocket ); /* -EINPROGRESS, -EAGAIN, or 0 for OK */
+
+            /* Start the connect procedure, kernel will start working on it */
+            if( xResult == 0 )
+            {
+                pxSocket->u.xTCP.bits.bConnPrepared = pdFALSE;
+                pxSocket->u.xTCP.ucRepCount = 0U;
+
+                switch( pxAddress->sin_family )
+                {
+                    #if ( ipconfigUSE_IPv6 != 0 )
+                        case FREERTOS_AF_INET6:
+                            pxSocket->bits.bIsIPv6 = pdTRUE_UNSIGNED;
+                            FreeRTOS_printf( ( "FreeRTOS_connect: %u to %pip port %u\n",
+                                               pxSocket->usLocalPort, ( void * ) pxAddress->sin_address.xIP_IPv6.ucBytes,
+                                               FreeRTOS_ntohs( pxAddress->sin_port ) ) );
+                            ( void ) memcpy( pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes, pxAddress->sin_address.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                            break;
+                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                    #if ( ipconfigUSE_IPv4 != 0 )
+                        case FREERTOS_AF_INET4:
+                            pxSocket->bits.bIsIPv6 = pdFALSE_UNSIGNED;
+                            FreeRTOS_printf( ( "FreeRTOS_connect: %u to %xip:%u\n",
+                                               pxSocket->usLocalPort, ( unsigned int ) FreeRTOS_ntohl( pxAddress->sin_address.ulIP_IPv4 ), FreeRTOS_ntohs( pxAddress->sin_port ) ) );
+                            pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 = FreeRTOS_ntohl( pxAddress->sin_address.ulIP_IPv4 );
+                            break;
+                    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                    default:
+                        FreeRTOS_debug_printf( ( "FreeRTOS_connect: Undefined sin_family \n" ) );
+                        break;
+                }
+
+                /* Port on remote machine. */
+                pxSocket->u.xTCP.usRemotePort = FreeRTOS_ntohs( pxAddress->sin_port );
+
+                /* (client) internal state: socket wants to send a connect. */
+                vTCPStateChange( pxSocket, eCONNECT_SYN );
+
+                /* To start an active connect. */
+                pxSocket->u.xTCP.usTimeout = 1U;
+                vTCPTimerWheelRequest( pxSocket );
+
+                if( xSendEventToIPTask( eTCPTimerEvent ) != pdPASS )
+                {
+                    xResult = -pdFREERTOS_ERRNO_ECANCELED;
+                }
+            }
+        }
+
+        return xResult;
+    }
+
+
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-#if ( ( ipconfigHAS_DEBUG_PRINTF != 0 ) || ( ipconfigHAS_PRINTF != 0 ) )
-    const char * prvSocketProps( FreeRTOS_Socket_t * pxSocket )
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Start connecting a TCP socket and wait for the result, as long as
+ *        the receive time-out allows.
+ *
+ * @param[in] pxSocket The socket initiating the connection.
+ * @param[in] pxAddress The address of the remote socket.
+ *
+ * @return 0 is returned on a successful connection, else a negative
+ *         error code is returned.
+ */
+    static BaseType_t prvTCPConnect( FreeRTOS_Socket_t * pxSocket,
+                                     const struct freertos_sockaddr * pxAddress )
     {
-        /* For debugging purposes only: show some properties of a socket:
-         * IP-addresses and port numbers. */
-        #if ipconfigUSE_TCP == 1
-            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        TickType_t xRemainingTime;
+        BaseType_t xTimed = pdFALSE;
+        BaseType_t xResult;
+        TimeOut_t xTimeOut;
+
+        xResult = prvTCPConnectStart( pxSocket, pxAddress );
+
+        if( xResult == 0 )
+        {
+            /* And wait for the result */
+            for( ; ; )
             {
-                switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
+                EventBits_t uxEvents;
+
+                if( xTimed == pdFALSE )
                 {
-                    /* The use of snprintf() is discouraged by the MISRA rules.
-                     * This code however, is only active when logging is used. */
+                    /* Only in the first round, check for non-blocking */
+                    xRemainingTime = pxSocket->xReceiveBlockTime;
 
-                    /* The format '%pip' takes an string of 16 bytes as
-                     * a parameter, which is an IPv6 address.
-                     * See printf-stdarg.c */
+                    if( xRemainingTime == ( TickType_t ) 0 )
+                    {
+                        /* Not yet connected, correct state, non-blocking. */
+                        xResult = -pdFREERTOS_ERRNO_EWOULDBLOCK;
+                        break;
+                    }
 
-                    #if ( ipconfigUSE_IPv4 != 0 )
-                        case pdFALSE_UNSIGNED:
-                            ( void ) snprintf( pucSocketProps, sizeof( pucSocketProps ), "%xip port %u to %xip port %u",
-                                               ( unsigned ) pxSocket->xLocalAddress.ulIP_IPv4,
-                                               pxSocket->usLocalPort,
-                                               ( unsigned ) pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4,
-                                               pxSocket->u.xTCP.usRemotePort );
-                            break;
-                    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+                    /* Don't get here a second time. */
+                    xTimed = pdTRUE;
 
-                    #if ( ipconfigUSE_IPv6 != 0 )
-                        case pdTRUE_UNSIGNED:
-                            ( void ) snprintf( pucSocketProps, sizeof( pucSocketProps ), "%pip port %u to %pip port %u",
-                                               ( void * ) pxSocket->xLocalAddress.xIP_IPv6.ucBytes,
-                                               pxSocket->usLocalPort,
-                                               ( void * ) pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes,
-                                               pxSocket->u.xTCP.usRemotePort );
-                            break;
-                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+                    /* Fetch the current time */
+                    vTaskSetTimeOutState( &xTimeOut );
+                }
+
+                /* Did it get connected while sleeping ? */
+                xResult = FreeRTOS_issocketconnected( pxSocket );
+
+                /* Returns positive when connected, negative means an error */
+                if( xResult < 0 )
+                {
+                    /* Return the error */
+                    break;
+                }
+
+                if( xResult > 0 )
+                {
+                    /* Socket now connected, return a zero */
+                    xResult = 0;
+                    break;
+                }
+
+                /* Is it allowed to sleep more? */
+                if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
+                {
+                    xResult = -pdFREERTOS_ERRNO_ETIMEDOUT;
+                    break;
+                }
+
+                /* Go sleeping until we get any down-stream event */
+                uxEvents = xSocketEventWait( pxSocket,
+                                             ( EventBits_t ) eSOCKET_CONNECT | ( EventBits_t ) eSOCKET_CLOSED,
+                                             pdTRUE /*xClearOnExit*/,
+                                             xRemainingTime );
+
+                if( ( uxEvents & ( EventBits_t ) eSOCKET_CLOSED ) != 0U )
+                {
+                    xResult = -pdFREERTOS_ERRNO_ENOTCONN;
+                    FreeRTOS_debug_printf( ( "FreeRTOS_connect() stopped due to an error\n" ) );
+                    break;
+                }
+            }
+        }
+
+        return xResult;
+    }
+
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_UDP_CONNECT != 0 )
+
+/**
+ * @brief Set the peer of a UDP socket. FreeRTOS_sendto() may be called
+ *        with a NULL address afterwards, and packets sent to the peer
+ *        can use the headers that the socket keeps.
+ *
+ * @param[in] pxSocket The UDP socket.
+ * @param[in] pxAddress The address of the peer.
+ *
+ * @return 0 on success, else a negative error code.
+ */
+    static BaseType_t prvUDPConnect( FreeRTOS_Socket_t * pxSocket,
+                                     const struct freertos_sockaddr * pxAddress )
+    {
+        BaseType_t xResult = 0;
+
+        if( pxAddress == NULL )
+        {
+            xResult = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else if( ( pxAddress->sin_family != ( uint8_t ) FREERTOS_AF_INET4 ) &&
+                 ( pxAddress->sin_family != ( uint8_t ) FREERTOS_AF_INET6 ) )
+        {
+            FreeRTOS_debug_printf( ( "FreeRTOS_connect: Undefined sin_family \n" ) );
+            xResult = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else if( !socketSOCKET_IS_BOUND( pxSocket ) )
+        {
+            /* Bind to the port that the packets will be sent from. */
+            xResult = FreeRTOS_bind( pxSocket, NULL, 0U );
+        }
+        else
+        {
+            /* The socket is valid and already bound. */
+        }
+
+        if( xResult == 0 )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( pxSocket->u.xUDP.xConnected == pdFALSE )
+                {
+                    uxUDPConnectedSockets++;
+                }
+
+                ( void ) memcpy( &( pxSocket->u.xUDP.xRemoteAddress ), pxAddress, sizeof( pxSocket->u.xUDP.xRemoteAddress ) );
+                pxSocket->u.xUDP.xConnected = pdTRUE;
+                /* The headers of a previous peer can not be used. */
+                pxSocket->u.xUDP.xHeaderValid = pdFALSE;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        return xResult;
+    }
+
+#endif /* ipconfigUSE_UDP_CONNECT */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP == 1 ) || ( ipconfigUSE_UDP_CONNECT != 0 ) )
+
+/**
+ * @brief Connect to a remote port. For a UDP socket, only the peer address
+ *        is stored, see prvUDPConnect().
+ *
+ * @param[in] xClientSocket The socket initiating the connection.
+ * @param[in] pxAddress The address of the remote socket.
+ * @param[in] xAddressLength This parameter is not used. It is kept in
+ *                   the function signature to adhere to the Berkeley
+ *                   sockets standard.
+ *
+ * @return 0 is returned on a successful connection, else a negative
+ *         error code is returned.
+ */
+    BaseType_t FreeRTOS_connect( Socket_t xClientSocket,
+                                 const struct freertos_sockaddr * pxAddress,
+                                 socklen_t xAddressLength )
+    {
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xClientSocket;
+        BaseType_t xResult;
+
+        #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
+            struct freertos_sockaddr xTempAddress;
+
+            if( ( pxAddress != NULL ) && ( pxAddress->sin_family != FREERTOS_AF_INET6 ) && ( pxAddress->sin_family != FREERTOS_AF_INET ) )
+            {
+                ( void ) memcpy( &xTempAddress, pxAddress, sizeof( struct freertos_sockaddr ) );
+
+                /* Default to FREERTOS_AF_INET family if either FREERTOS_AF_INET6/FREERTOS_AF_INET
+                 *  is not specified in sin_family, if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled. */
+                xTempAddress.sin_family = FREERTOS_AF_INET;
+                pxAddress = &xTempAddress;
+            }
+        #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+
+        #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+            struct freertos_sockaddr xIPv4Address;
+
+            if( prvSocketUnmapAddress( pxSocket, pxAddress, &( xIPv4Address ) ) != pdFALSE )
+            {
+                /* Connect through IPv4, but keep reporting the peer as an
+                 * IPv4-mapped address. */
+                pxSocket->bits.bV4Mapped = pdTRUE_UNSIGNED;
+                pxAddress = &( xIPv4Address );
+            }
+        #endif /* ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 ) */
+
+        ( void ) xAddressLength;
+
+        #if ( ipconfigUSE_UDP_CONNECT != 0 )
+            if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_UDP, pdFALSE ) != pdFALSE )
+            {
+                xResult = prvUDPConnect( pxSocket, pxAddress );
+            }
+            else
+        #endif /* ipconfigUSE_UDP_CONNECT */
+        {
+            #if ( ipconfigUSE_TCP == 1 )
+            {
+                xResult = prvTCPConnect( pxSocket, pxAddress );
+            }
+            #else
+            {
+                /* Not a valid socket or wrong type. */
+                xResult = -pdFREERTOS_ERRNO_EBADF;
+            }
+            #endif
+        }
+
+        return xResult;
+    }
+
+#endif /* ( ( ipconfigUSE_TCP == 1 ) || ( ipconfigUSE_UDP_CONNECT != 0 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Check if a new connection has come in for a socket in listen mode.
+ *
+ * @param[in] pxParentSocket  The parent socket, which is in listening mode.
+ * @param[out] pxAddress  The address of the peer will be filled in 'pxAddress'.
+ * @param[in] pxAddressLength  The actual size of the space pointed to by 'pxAddress'.
+ * @return A new connected socket or NULL.
+ */
+    static FreeRTOS_Socket_t * prvAcceptWaitClient( FreeRTOS_Socket_t * pxParentSocket,
+                                                    struct freertos_sockaddr * pxAddress,
+                                                    socklen_t * pxAddressLength )
+    {
+        FreeRTOS_Socket_t * pxClientSocket = NULL;
+
+        /* Is there a new client? */
+        vTaskSuspendAll();
+        {
+            if( pxParentSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED )
+            {
+                #if ( ipconfigTCP_ACCEPT_QUEUE != 0 )
+                {
+                    /* Take the oldest connected child. */
+                    if( listCURRENT_LIST_LENGTH( &( pxParentSocket->u.xTCP.xAcceptQueue ) ) > 0U )
+                    {
+                        pxClientSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxParentSocket->u.xTCP.xAcceptQueue ) ) );
+                        ( void ) uxListRemove( &( pxClientSocket->u.xTCP.xAcceptListItem ) );
+                    }
+                }
+                #else
+                {
+                    pxClientSocket = pxParentSocket->u.xTCP.pxPeerSocket;
+                }
+                #endif /* ipconfigTCP_ACCEPT_QUEUE */
+
+                if( pxClientSocket != NULL )
+                {
+                    FreeRTOS_printf( ( "prvAcceptWaitClient: client %p parent %p\n",
+                                       ( void * ) pxClientSocket, ( void * ) pxParentSocket ) );
+                }
+            }
+            else
+            {
+                pxClientSocket = pxParentSocket;
+            }
+
+            if( pxClientSocket != NULL )
+            {
+                /* Is it still not taken ? */
+                if( pxClientSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED )
+                {
+                    if( pxParentSocket->u.xTCP.pxPeerSocket != NULL )
+                    {
+                        pxParentSocket->u.xTCP.pxPeerSocket = NULL;
+                    }
 
-                    default:
-                        /* MISRA 16.4 Compliance */
-                        break;
+                    pxClientSocket->u.xTCP.bits.bPassAccept = pdFALSE_UNSIGNED;
+                }
+                else
+                {
+                    pxClientSocket = NULL;
                 }
             }
-            else
-        #endif /* if ipconfigUSE_TCP == 1 */
+        }
+        ( void ) xTaskResumeAll();
 
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+        if( pxClientSocket != NULL )
         {
-            switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
+            if( pxAddressLength != NULL )
+            {
+                *pxAddressLength = sizeof( struct freertos_sockaddr );
+            }
+
+            switch( pxClientSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
             {
                 #if ( ipconfigUSE_IPv4 != 0 )
                     case pdFALSE_UNSIGNED:
-                        ( void ) snprintf( pucSocketProps, sizeof( pucSocketProps ),
-                                           "%xip port %u",
-                                           ( unsigned ) pxSocket->xLocalAddress.ulIP_IPv4,
-                                           pxSocket->usLocalPort );
+
+                        if( pxAddress != NULL )
+                        {
+                            pxAddress->sin_family = FREERTOS_AF_INET4;
+                            /* Copy IP-address and port number. */
+                            pxAddress->sin_address.ulIP_IPv4 = FreeRTOS_ntohl( pxClientSocket->u.xTCP.xRemoteIP.ulIP_IPv4 );
+                            pxAddress->sin_port = FreeRTOS_ntohs( pxClientSocket->u.xTCP.usRemotePort );
+                        }
                         break;
                 #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
                 #if ( ipconfigUSE_IPv6 != 0 )
                     case pdTRUE_UNSIGNED:
-                        ( void ) snprintf( pucSocketProps, sizeof( pucSocketProps ),
-                                           "%pip port %u",
-                                           ( void * ) pxSocket->xLocalAddress.xIP_IPv6.ucBytes,
-                                           pxSocket->usLocalPort );
+
+                        if( pxAddress != NULL )
+                        {
+                            pxAddress->sin_family = FREERTOS_AF_INET6;
+                            /* Copy IP-address and port number. */
+                            ( void ) memcpy( pxAddress->sin_address.xIP_IPv6.ucBytes, pxClientSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                            pxAddress->sin_port = FreeRTOS_ntohs( pxClientSocket->u.xTCP.usRemotePort );
+                        }
                         break;
                 #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
@@ -2249,3089 +8317,3811 @@ void * vSocketClose( FreeRTOS_Socket_t * pxSocket )
                     break;
             }
         }
+
+        return pxClientSocket;
+    }
+#endif /* ( ipconfigUSE_TCP == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Accept a connection on an listening socket.
+ *
+ * @param[in] xServerSocket The socket in listening mode.
+ * @param[out] pxAddress The address of the machine trying to connect to this node
+ *                        is returned in this pointer.
+ * @param[out] pxAddressLength The length of the address of the remote machine.
+ *
+ * @return FreeRTOS_accept: can return a new connected socket if the server socket
+ *         is in listen mode and receives a connection request. The new socket will
+ *         be bound already to the same port number as the listening socket.
+ */
+    Socket_t FreeRTOS_accept( Socket_t xServerSocket,
+                              struct freertos_sockaddr * pxAddress,
+                              socklen_t * pxAddressLength )
+    {
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xServerSocket;
+        FreeRTOS_Socket_t * pxClientSocket = NULL;
+        TickType_t xRemainingTime;
+        BaseType_t xTimed = pdFALSE;
+        TimeOut_t xTimeOut;
+
+        #if ( ipconfigTCP_ACCEPT_QUEUE == 0 )
+            IPStackEvent_t xAskEvent;
+        #endif
+
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
+        {
+            /* Not a valid socket or wrong type */
+
+            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
+            /* coverity[misra_c_2012_rule_11_4_violation] */
+            pxClientSocket = FREERTOS_INVALID_SOCKET;
+        }
+        else if( ( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED ) &&
+                 ( pxSocket->u.xTCP.eTCPState != eTCP_LISTEN ) )
+        {
+            /* Parent socket is not in listening mode */
+
+            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
+            /* coverity[misra_c_2012_rule_11_4_violation] */
+            pxClientSocket = FREERTOS_INVALID_SOCKET;
+        }
         else
         {
-            /* Protocol not handled. */
+            /* Loop will stop with breaks. */
+            for( ; ; )
+            {
+                pxClientSocket = prvAcceptWaitClient( pxSocket, pxAddress, pxAddressLength );
+
+                if( pxClientSocket != NULL )
+                {
+                    #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                        if( pxAddress != NULL )
+                        {
+                            prvSocketMapAddress( pxClientSocket, pxAddress );
+                        }
+                    #endif
+
+                    if( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED )
+                    {
+                        /* With ipconfigTCP_ACCEPT_QUEUE, the next connected
+                         * client, if any, is already in the accept queue. */
+                        #if ( ipconfigTCP_ACCEPT_QUEUE == 0 )
+                        {
+                            /* Ask to set an event in 'xEventGroup' as soon as a new
+                             * client gets connected for this listening socket. */
+                            xAskEvent.eEventType = eTCPAcceptEvent;
+                            xAskEvent.pvData = pxSocket;
+                            ( void ) xSendEventStructToIPTask( &xAskEvent, portMAX_DELAY );
+                        }
+                        #endif /* ipconfigTCP_ACCEPT_QUEUE */
+
+                        #if ( ipconfigTCP_LISTEN_POOL_SIZE != 0 )
+                        {
+                            /* Replace the socket that was taken from the pool. */
+                            prvTCPListenPoolFill( pxSocket );
+                        }
+                        #endif
+                    }
+
+                    break;
+                }
+
+                if( xTimed == pdFALSE )
+                {
+                    /* Only in the first round, check for non-blocking */
+                    xRemainingTime = pxSocket->xReceiveBlockTime;
+
+                    if( xRemainingTime == ( TickType_t ) 0 )
+                    {
+                        break;
+                    }
+
+                    /* Don't get here a second time */
+                    xTimed = pdTRUE;
+
+                    /* Fetch the current time */
+                    vTaskSetTimeOutState( &xTimeOut );
+                }
+
+                /* Has the timeout been reached? */
+                if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
+                {
+                    break;
+                }
+
+                /* Put the calling task to 'sleep' until a down-stream event is received. */
+                ( void ) xSocketEventWait( pxSocket,
+                                           ( EventBits_t ) eSOCKET_ACCEPT,
+                                           pdTRUE /*xClearOnExit*/,
+                                           xRemainingTime );
+            }
         }
 
-        return pucSocketProps;
+        return pxClientSocket;
     }
-#endif /* ( ( ipconfigHAS_DEBUG_PRINTF != 0 ) || ( ipconfigHAS_PRINTF != 0 ) ) */
+
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-#if ipconfigUSE_TCP == 1
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief After all checks have been done in FreeRTOS_recv()
+ *        read the data from the stream buffer.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[out] pvBuffer The buffer to store the incoming data in.
+ * @param[in] uxBufferLength The length of the buffer so that the function
+ *                            does not do out of bound access.
+ * @param[in] xFlags The flags for conveying preference. This routine
+ *                    will check for 'FREERTOS_ZERO_COPY and/or'.
+ *
+ * @return The number of bytes actually received and stored in the pvBuffer.
+ */
+    static BaseType_t prvRecvData( FreeRTOS_Socket_t * pxSocket,
+                                   void * pvBuffer,
+                                   size_t uxBufferLength,
+                                   BaseType_t xFlags )
+    {
+        BaseType_t xByteCount;
+
+        if( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_ZERO_COPY ) == 0U )
+        {
+            BaseType_t xIsPeek = ( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_MSG_PEEK ) != 0U ) ? 1L : 0L;
+
+            #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+            {
+                /* Part of the data may be stored in network buffers. */
+                xByteCount = ( BaseType_t ) uxTCPRxBufferGet( pxSocket, ( uint8_t * ) pvBuffer, uxBufferLength, xIsPeek );
+            }
+            #else
+            {
+                xByteCount = ( BaseType_t )
+                             uxStreamBufferGet( pxSocket->u.xTCP.rxStream,
+                                                0U,
+                                                ( uint8_t * ) pvBuffer,
+                                                ( size_t ) uxBufferLength,
+                                                xIsPeek );
+            }
+            #endif /* ipconfigTCP_RX_BUFFER_COUNT != 0 */
+
+            if( pxSocket->u.xTCP.bits.bLowWater != pdFALSE_UNSIGNED )
+            {
+                /* We had reached the low-water mark, now see if the flag
+                 * can be cleared */
+                size_t uxFrontSpace = uxStreamBufferFrontSpace( pxSocket->u.xTCP.rxStream );
+
+                if( uxFrontSpace >= pxSocket->u.xTCP.uxEnoughSpace )
+                {
+                    pxSocket->u.xTCP.bits.bLowWater = pdFALSE_UNSIGNED;
+                    pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
+                    pxSocket->u.xTCP.usTimeout = 1U; /* because bLowWater is cleared. */
+                    vTCPTimerWheelRequest( pxSocket );
+                    ( void ) xSendEventToIPTask( eTCPTimerEvent );
+                }
+            }
+        }
+        else
+        {
+            /* Zero-copy reception of data: pvBuffer is a pointer to a pointer. */
+            #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+            {
+                /* The application will hold a pointer into the RX stream. */
+                prvTCPAutoTuneDisable( pxSocket );
+            }
+            #endif
+
+            #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+            {
+                /* It may point into a network buffer kept by the socket. */
+                xByteCount = ( BaseType_t ) uxTCPRxBufferGetPtr( pxSocket, ( uint8_t ** ) pvBuffer );
+            }
+            #else
+            {
+                xByteCount = ( BaseType_t ) uxStreamBufferGetPtr( pxSocket->u.xTCP.rxStream, ( uint8_t ** ) pvBuffer );
+            }
+            #endif
+        }
+
+        return xByteCount;
+    }
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Return the number of bytes in the RX stream, or with record framing,
+ *        the length of the first record once it is complete.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in] xRecord pdTRUE to wait for a complete record.
+ *
+ * @return The number of bytes available, zero when there are none, or a
+ *         negative error code from prvTCPRecordAvailable().
+ */
+    static BaseType_t prvRecvAvailable( FreeRTOS_Socket_t * pxSocket,
+                                        BaseType_t xRecord )
+    {
+        BaseType_t xByteCount = 0;
+
+        sockSTREAM_ENTER( pxSocket->u.xTCP.ucRxStreamUsers );
+
+        if( pxSocket->u.xTCP.rxStream != NULL )
+        {
+            #if ( ipconfigUSE_TCP_RECORD_FRAMING != 0 )
+                if( xRecord != pdFALSE )
+                {
+                    xByteCount = prvTCPRecordAvailable( pxSocket );
+                }
+                else
+            #endif
+            {
+                ( void ) xRecord;
+                xByteCount = ( BaseType_t ) uxStreamBufferGetSize( pxSocket->u.xTCP.rxStream );
+            }
+        }
+
+        sockSTREAM_LEAVE( pxSocket->u.xTCP.ucRxStreamUsers );
+
+        return xByteCount;
+    }
+
+#endif /* ( ipconfigUSE_TCP == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief When a child socket gets closed, make sure to update the child-count of the
- *        parent. When a listening parent socket is closed, make sure to close also
- *        all orphaned child-sockets.
+ * @brief After FreeRTOS_recv() has checked the validity of the parameters,
+ *        this routine will wait for data to arrive in the stream buffer.
  *
- * @param[in] pxSocketToDelete The socket being closed.
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[out] pxEventBits A bit-mask of socket events will be set:
+ *             eSOCKET_RECEIVE, eSOCKET_CLOSED, and or eSOCKET_INTR.
+ * @param[in] xFlags flags passed by the user, only 'FREERTOS_MSG_DONTWAIT'
+ *            is checked in this function.
+ * @param[in] xRecord pdTRUE to wait for a complete record in stead of any
+ *            data, see FreeRTOS_recv_record().
  */
-    /* MISRA Ref 17.2.1 [Sockets and limited recursion] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-172 */
-    /* coverity[misra_c_2012_rule_17_2_violation] */
-    /* coverity[recursive_step] */
-    static void prvTCPSetSocketCount( FreeRTOS_Socket_t const * pxSocketToDelete )
+    static BaseType_t prvRecvWait( FreeRTOS_Socket_t * pxSocket,
+                                   EventBits_t * pxEventBits,
+                                   BaseType_t xFlags,
+                                   BaseType_t xRecord )
     {
-        const ListItem_t * pxIterator;
+        BaseType_t xByteCount;
+        TickType_t xRemainingTime;
+        BaseType_t xTimed = pdFALSE;
+        TimeOut_t xTimeOut;
+        EventBits_t xEventBits = ( EventBits_t ) 0U;
 
-        /* MISRA Ref 11.3.1 [Misaligned access] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-        /* coverity[misra_c_2012_rule_11_3_violation] */
-        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
-        FreeRTOS_Socket_t * pxOtherSocket;
-        uint16_t usLocalPort = pxSocketToDelete->usLocalPort;
+        xByteCount = prvRecvAvailable( pxSocket, xRecord );
 
-        if( pxSocketToDelete->u.xTCP.eTCPState == eTCP_LISTEN )
+        while( xByteCount == 0 )
         {
-            pxIterator = listGET_NEXT( pxEnd );
+            eIPTCPState_t eType = ( eIPTCPState_t ) pxSocket->u.xTCP.eTCPState;
 
-            while( pxIterator != pxEnd )
+            if( ( eType == eCLOSED ) ||
+                ( eType == eCLOSE_WAIT ) || /* (server + client) waiting for a connection termination request from the local user. */
+                ( eType == eCLOSING ) )     /* (server + client) waiting for a connection termination request acknowledgement from the remote TCP. */
             {
-                pxOtherSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                /* Return -ENOTCONN, unless there was a malloc failure. */
+                xByteCount = -pdFREERTOS_ERRNO_ENOTCONN;
 
-                /* This needs to be done here, before calling vSocketClose. */
-                pxIterator = listGET_NEXT( pxIterator );
+                if( pxSocket->u.xTCP.bits.bMallocError != pdFALSE_UNSIGNED )
+                {
+                    /* The no-memory error has priority above the non-connected error.
+                     * Both are fatal and will lead to closing the socket. */
+                    xByteCount = -pdFREERTOS_ERRNO_ENOMEM;
+                }
 
-                if( ( pxOtherSocket->u.xTCP.eTCPState != eTCP_LISTEN ) &&
-                    ( pxOtherSocket->usLocalPort == usLocalPort ) &&
-                    ( ( pxOtherSocket->u.xTCP.bits.bPassQueued != pdFALSE_UNSIGNED ) ||
-                      ( pxOtherSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) ) )
+                break;
+            }
+
+            if( xTimed == pdFALSE )
+            {
+                /* Only in the first round, check for non-blocking. */
+                xRemainingTime = pxSocket->xReceiveBlockTime;
+
+                if( xRemainingTime == ( TickType_t ) 0U )
                 {
-                    /* MISRA Ref 17.2.1 [Sockets and limited recursion] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-172 */
-                    /* coverity[misra_c_2012_rule_17_2_violation] */
-                    /* coverity[recursive_step] */
-                    ( void ) vSocketClose( pxOtherSocket );
+                    #if ( ipconfigSUPPORT_SIGNALS != 0 )
+                    {
+                        /* Just check for the interrupt flag. */
+                        xEventBits = xSocketEventWait( pxSocket, ( EventBits_t ) eSOCKET_INTR,
+                                                       pdTRUE /*xClearOnExit*/, socketDONT_BLOCK );
+                    }
+                    #endif /* ipconfigSUPPORT_SIGNALS */
+                    break;
+                }
+
+                if( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_MSG_DONTWAIT ) != 0U )
+                {
+                    break;
+                }
+
+                /* Don't get here a second time. */
+                xTimed = pdTRUE;
+
+                /* Fetch the current time. */
+                vTaskSetTimeOutState( &xTimeOut );
+
+                #if ( ipconfigUSE_SOCKET_BUSY_POLL != 0 )
+                {
+                    prvSocketBusyPoll( pxSocket, ( EventBits_t ) eSOCKET_RECEIVE | ( EventBits_t ) eSOCKET_CLOSED | ( EventBits_t ) eSOCKET_INTR, xRemainingTime );
                 }
+                #endif
             }
-        }
-        else
-        {
-            for( pxIterator = listGET_NEXT( pxEnd );
-                 pxIterator != pxEnd;
-                 pxIterator = listGET_NEXT( pxIterator ) )
+
+            /* Has the timeout been reached? */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
             {
-                pxOtherSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                break;
+            }
 
-                if( ( pxOtherSocket->u.xTCP.eTCPState == eTCP_LISTEN ) &&
-                    ( pxOtherSocket->usLocalPort == usLocalPort ) &&
-                    ( pxOtherSocket->u.xTCP.usChildCount != 0U ) )
+            /* Block until there is a down-stream event. */
+            xEventBits = xSocketEventWait( pxSocket,
+                                           ( EventBits_t ) eSOCKET_RECEIVE | ( EventBits_t ) eSOCKET_CLOSED | ( EventBits_t ) eSOCKET_INTR,
+                                           pdTRUE /*xClearOnExit*/, xRemainingTime );
+            #if ( ipconfigSUPPORT_SIGNALS != 0 )
+            {
+                if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
                 {
-                    pxOtherSocket->u.xTCP.usChildCount--;
-                    FreeRTOS_debug_printf( ( "Lost: Socket %u now has %u / %u child%s\n",
-                                             pxOtherSocket->usLocalPort,
-                                             pxOtherSocket->u.xTCP.usChildCount,
-                                             pxOtherSocket->u.xTCP.usBacklog,
-                                             ( pxOtherSocket->u.xTCP.usChildCount == 1U ) ? "" : "ren" ) );
                     break;
                 }
             }
-        }
-    }
+            #else
+            {
+                ( void ) xEventBits;
+            }
+            #endif /* ipconfigSUPPORT_SIGNALS */
 
+            xByteCount = prvRecvAvailable( pxSocket, xRecord );
+        } /* while( xByteCount == 0 ) */
 
-#endif /* ipconfigUSE_TCP == 1 */
+        *( pxEventBits ) = xEventBits;
 
+        return xByteCount;
+    }
 /*-----------------------------------------------------------*/
+#endif /* ( ipconfigUSE_TCP == 1 ) */
 
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Set the value of receive/send buffer after some preliminary checks.
+ * @brief Read incoming data from a TCP socket. Only after the last
+ *        byte has been read, a close error might be returned.
  *
- * @param[in] pxSocket The socket whose options are being set.
- * @param[in] lOptionName The option name: either FREERTOS_SO_SNDBUF or
- *                         FREERTOS_SO_SNDBUF.
- * @param[in] pvOptionValue The value of the option being set.
+ * @param[in] xSocket The socket owning the connection.
+ * @param[out] pvBuffer The buffer to store the incoming data in.
+ * @param[in] uxBufferLength The length of the buffer so that the function
+ *                            does not do out of bound access.
+ * @param[in] xFlags The flags for conveying preference. The values
+ *                    FREERTOS_MSG_DONTWAIT, FREERTOS_ZERO_COPY and/or
+ *                    FREERTOS_MSG_PEEK can be used.
  *
- * @return If there is no error, then 0 is returned. Or a negative errno
- *         value is returned.
+ * @return The number of bytes actually received and stored in the pvBuffer.
  */
-    static BaseType_t prvSockopt_so_buffer( FreeRTOS_Socket_t * pxSocket,
-                                            int32_t lOptionName,
-                                            const void * pvOptionValue )
+    BaseType_t FreeRTOS_recv( Socket_t xSocket,
+                              void * pvBuffer,
+                              size_t uxBufferLength,
+                              BaseType_t xFlags )
     {
-        uint32_t ulNewValue;
-        BaseType_t xReturn;
+        BaseType_t xByteCount = 0;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        EventBits_t xEventBits = ( EventBits_t ) 0U;
 
-        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        /* Check if the socket is valid, has type TCP and if it is bound to a
+         * port. */
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
         {
-            FreeRTOS_debug_printf( ( "Set SO_%sBUF: wrong socket type\n",
-                                     ( lOptionName == FREERTOS_SO_SNDBUF ) ? "SND" : "RCV" ) );
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            xByteCount = -pdFREERTOS_ERRNO_EINVAL;
         }
-        else if( ( ( lOptionName == FREERTOS_SO_SNDBUF ) && ( pxSocket->u.xTCP.txStream != NULL ) ) ||
-                 ( ( lOptionName == FREERTOS_SO_RCVBUF ) && ( pxSocket->u.xTCP.rxStream != NULL ) ) )
+        else if( ( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_ZERO_COPY ) != 0U ) &&
+                 ( pvBuffer == NULL ) )
         {
-            FreeRTOS_debug_printf( ( "Set SO_%sBUF: buffer already created\n",
-                                     ( lOptionName == FREERTOS_SO_SNDBUF ) ? "SND" : "RCV" ) );
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            /* In zero-copy mode, pvBuffer is a pointer to a pointer ( not NULL ). */
+            xByteCount = -pdFREERTOS_ERRNO_EINVAL;
         }
         else
         {
-            ulNewValue = *( ( const uint32_t * ) pvOptionValue );
+            /* The function parameters have been checked, now wait for incoming data. */
+            xByteCount = prvRecvWait( pxSocket, &( xEventBits ), xFlags, pdFALSE );
 
-            if( lOptionName == FREERTOS_SO_SNDBUF )
-            {
-                /* Round up to nearest MSS size */
-                ulNewValue = FreeRTOS_round_up( ulNewValue, ( uint32_t ) pxSocket->u.xTCP.usMSS );
-                pxSocket->u.xTCP.uxTxStreamSize = ulNewValue;
-            }
-            else
+            #if ( ipconfigSUPPORT_SIGNALS != 0 )
+                if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
+                {
+                    if( ( xEventBits & ( ( EventBits_t ) eSOCKET_RECEIVE | ( EventBits_t ) eSOCKET_CLOSED ) ) != 0U )
+                    {
+                        /* Shouldn't have cleared other flags. */
+                        xEventBits &= ~( ( EventBits_t ) eSOCKET_INTR );
+                        vSocketEventSet( pxSocket, xEventBits );
+                    }
+
+                    xByteCount = -pdFREERTOS_ERRNO_EINTR;
+                }
+                else
+            #endif /* ipconfigSUPPORT_SIGNALS */
+
+            if( xByteCount > 0 )
             {
-                pxSocket->u.xTCP.uxRxStreamSize = ulNewValue;
+                /* Get the actual data from the buffer, or in case of zero-copy,
+                 * let *pvBuffer point to the RX-stream of the socket. */
+                sockSTREAM_ENTER( pxSocket->u.xTCP.ucRxStreamUsers );
+                xByteCount = prvRecvData( pxSocket, pvBuffer, uxBufferLength, xFlags );
+                sockSTREAM_LEAVE( pxSocket->u.xTCP.ucRxStreamUsers );
             }
+        } /* prvValidSocket() */
 
-            xReturn = 0;
-        }
-
-        return xReturn;
+        return xByteCount;
     }
-#endif /* ipconfigUSE_TCP == 1 */
+
+
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_CALLBACKS == 1 )
+#if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Set a callback function for either a TCP or a UDP socket.
- *        The callback function will be called on-connect, on-send
- *        or on-receive.
+ * @brief Called from FreeRTOS_send(): some checks which will be done before
+ *        sending a TCP packed.
  *
- * @param[in] pxSocket The socket whose options are being set.
- * @param[in] lOptionName The option name like FREERTOS_SO_xxx_HANDLER.
- * @param[in] pvOptionValue A pointer to a 'F_TCP_UDP_Handler_t',
- *                           which defines the handler.
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in] uxDataLength The length of the data to be sent.
  *
- * @return If there is no error, then 0 is returned. Or a negative errno
- *         value is returned.
+ * @return 0: representing OK, else a negative error code will be returned.
  */
-    BaseType_t prvSetOptionCallback( FreeRTOS_Socket_t * pxSocket,
-                                     int32_t lOptionName,
-                                     const void * pvOptionValue )
+    static int32_t prvTCPSendCheck( FreeRTOS_Socket_t * pxSocket,
+                                    size_t uxDataLength )
     {
-        BaseType_t xReturn = 0;
+        int32_t xResult = 1;
 
-        #if ( ipconfigUSE_TCP == 1 )
+        /* Is this a socket of type TCP and is it already bound to a port number ? */
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
         {
-            UBaseType_t uxProtocol;
-
-            if( ( lOptionName == FREERTOS_SO_UDP_RECV_HANDLER ) ||
-                ( lOptionName == FREERTOS_SO_UDP_SENT_HANDLER ) )
-            {
-                uxProtocol = ( UBaseType_t ) FREERTOS_IPPROTO_UDP;
-            }
-            else
-            {
-                uxProtocol = ( UBaseType_t ) FREERTOS_IPPROTO_TCP;
-            }
-
-            if( pxSocket->ucProtocol != ( uint8_t ) uxProtocol )
-            {
-                xReturn = -pdFREERTOS_ERRNO_EINVAL;
-            }
+            xResult = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else if( pxSocket->u.xTCP.bits.bMallocError != pdFALSE_UNSIGNED )
+        {
+            xResult = -pdFREERTOS_ERRNO_ENOMEM;
         }
-        #else /* if ( ipconfigUSE_TCP == 1 ) */
+        else if( ( ( pxSocket->u.xTCP.eTCPState == eCLOSED ) && ( sockFAST_OPEN_MAY_QUEUE( pxSocket ) == pdFALSE ) ) ||
+                 ( pxSocket->u.xTCP.eTCPState == eCLOSE_WAIT ) ||
+                 ( pxSocket->u.xTCP.eTCPState == eCLOSING ) )
         {
-            /* No need to check if the socket has the right
-             * protocol, because only UDP sockets can be created. */
+            xResult = -pdFREERTOS_ERRNO_ENOTCONN;
         }
-        #endif /* ipconfigUSE_TCP */
-
-        if( xReturn == 0 )
+        else if( pxSocket->u.xTCP.bits.bFinSent != pdFALSE_UNSIGNED )
         {
-            switch( lOptionName ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is checked before calling. */
-            {
-                #if ipconfigUSE_TCP == 1
-                    case FREERTOS_SO_TCP_CONN_HANDLER:
-                        pxSocket->u.xTCP.pxHandleConnected = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnTCPConnected;
-                        break;
-
-                    case FREERTOS_SO_TCP_RECV_HANDLER:
-                        pxSocket->u.xTCP.pxHandleReceive = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnTCPReceive;
-                        break;
-
-                    case FREERTOS_SO_TCP_SENT_HANDLER:
-                        pxSocket->u.xTCP.pxHandleSent = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnTCPSent;
-                        break;
-                #endif /* ipconfigUSE_TCP */
-                case FREERTOS_SO_UDP_RECV_HANDLER:
-                    pxSocket->u.xUDP.pxHandleReceive = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnUDPReceive;
-                    break;
-
-                case FREERTOS_SO_UDP_SENT_HANDLER:
-                    pxSocket->u.xUDP.pxHandleSent = ( ( const F_TCP_UDP_Handler_t * ) pvOptionValue )->pxOnUDPSent;
-                    break;
+            /* This TCP connection is closing already, the FIN flag has been sent.
+             * Maybe it is still delivering or receiving data.
+             * Return OK in order not to get closed/deleted too quickly */
+            xResult = 0;
+        }
+        else if( uxDataLength == 0U )
+        {
+            /* send() is being called to send zero bytes */
+            xResult = 0;
+        }
+        else if( pxSocket->u.xTCP.txStream == NULL )
+        {
+            /* Create the outgoing stream only when it is needed */
+            ( void ) prvTCPCreateStream( pxSocket, pdFALSE );
 
-                default:                                /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
-                    xReturn = -pdFREERTOS_ERRNO_EINVAL; /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
-                    break;                              /* LCOV_EXCL_LINE Exclude this line because default case is checked before calling. */
+            if( pxSocket->u.xTCP.txStream == NULL )
+            {
+                xResult = -pdFREERTOS_ERRNO_ENOMEM;
             }
         }
+        else
+        {
+            /* Nothing. */
+        }
 
-        return xReturn;
+        return xResult;
     }
-#endif /* ( ipconfigUSE_CALLBACKS == 1 ) */
-/*-----------------------------------------------------------*/
 
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP != 0 )
+#if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Handle the socket option FREERTOS_SO_WIN_PROPERTIES, which sets
- *        the sizes of the TCP windows and the sizes of the stream buffers.
+ * @brief Get a direct pointer to the beginning of the circular transmit buffer.
  *
- * @param[in] pxSocket The socket whose options are being set.
- * @param[in] pvOptionValue The pointer that is passed by the application.
+ * @param[in] xSocket The socket owning the buffer.
+ *
+ * @return Address the first byte in the circular transmit buffer if all checks pass.
+ *         Or else, NULL is returned.
  */
-    static BaseType_t prvSetOptionTCPWindows( FreeRTOS_Socket_t * pxSocket,
-                                              const void * pvOptionValue )
+    uint8_t * FreeRTOS_get_tx_base( Socket_t xSocket )
     {
-        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
-        const WinProperties_t * pxProps;
+        uint8_t * pucReturn = NULL;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
 
-        do
+        /* Confirm that this is a TCP socket before dereferencing structure
+         * member pointers. */
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE )
         {
-            IPTCPSocket_t * pxTCP = &( pxSocket->u.xTCP );
-
-            if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
-            {
-                FreeRTOS_debug_printf( ( "Set SO_WIN_PROP: wrong socket type\n" ) );
-                break; /* will return -pdFREERTOS_ERRNO_EINVAL */
-            }
-
-            pxProps = ( const WinProperties_t * ) pvOptionValue;
-
-            /* Validity of txStream will be checked by the function below. */
-            xReturn = prvSockopt_so_buffer( pxSocket, FREERTOS_SO_SNDBUF, &( pxProps->lTxBufSize ) );
+            StreamBuffer_t * pxBuffer;
 
-            if( xReturn != 0 )
+            #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
             {
-                break; /* will return an error. */
+                /* The application will hold a pointer into the TX stream. */
+                prvTCPKeepTxStream( pxSocket );
             }
+            #endif
 
-            xReturn = prvSockopt_so_buffer( pxSocket, FREERTOS_SO_RCVBUF, &( pxProps->lRxBufSize ) );
+            pxBuffer = pxSocket->u.xTCP.txStream;
 
-            if( xReturn != 0 )
+            /* If the TX buffer hasn't been created yet,
+             * and if no malloc error has occurred on this socket yet. */
+            if( ( pxBuffer == NULL ) &&
+                ( pxSocket->u.xTCP.bits.bMallocError == pdFALSE_UNSIGNED ) )
             {
-                break; /* will return an error. */
+                /* Create the outgoing stream only when it is needed */
+                ( void ) prvTCPCreateStream( pxSocket, pdFALSE );
+                pxBuffer = pxSocket->u.xTCP.txStream;
             }
 
-            #if ( ipconfigUSE_TCP_WIN == 1 )
-            {
-                pxTCP->uxRxWinSize = ( uint32_t ) pxProps->lRxWinSize; /* Fixed value: size of the TCP reception window */
-                pxTCP->uxTxWinSize = ( uint32_t ) pxProps->lTxWinSize; /* Fixed value: size of the TCP transmit window */
-            }
-            #else
+            if( pxBuffer != NULL )
             {
-                pxTCP->uxRxWinSize = 1U;
-                pxTCP->uxTxWinSize = 1U;
-            }
-            #endif
+                #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+                {
+                    /* The application will hold a pointer into the TX stream. */
+                    prvTCPAutoTuneDisable( pxSocket );
+                }
+                #endif
 
-            /* In case the socket has already initialised its tcpWin,
-             * adapt the window size parameters */
-            if( pxTCP->xTCPWindow.u.bits.bHasInit != pdFALSE_UNSIGNED )
-            {
-                pxTCP->xTCPWindow.xSize.ulRxWindowLength = ( uint32_t ) ( pxTCP->uxRxWinSize * pxTCP->usMSS );
-                pxTCP->xTCPWindow.xSize.ulTxWindowLength = ( uint32_t ) ( pxTCP->uxTxWinSize * pxTCP->usMSS );
+                pucReturn = pxBuffer->ucArray;
             }
         }
-        while( ipFALSE_BOOL );
 
-        return xReturn;
+        return pucReturn;
     }
-#endif /* ( ipconfigUSE_TCP != 0 ) */
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP != 0 )
+#if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Handle the socket option FREERTOS_SO_SET_LOW_HIGH_WATER, which sets
- *        the low- and the high-water values for TCP reception. Useful when
- *        streaming music.
+ * @brief Get a direct pointer to the TX head of the circular transmit buffer.
  *
- * @param[in] pxSocket The socket whose options are being set.
- * @param[in] pvOptionValue The pointer that is passed by the application.
- */
-    static BaseType_t prvSetOptionLowHighWater( FreeRTOS_Socket_t * pxSocket,
-                                                const void * pvOptionValue )
-    {
-        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
-        const LowHighWater_t * pxLowHighWater = ( const LowHighWater_t * ) pvOptionValue;
-
-        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
-        {
-            /* It is not allowed to access 'pxSocket->u.xTCP'. */
-            FreeRTOS_debug_printf( ( "FREERTOS_SO_SET_LOW_HIGH_WATER: wrong socket type\n" ) );
-        }
-        else if( ( pxLowHighWater->uxLittleSpace >= pxLowHighWater->uxEnoughSpace ) ||
-                 ( pxLowHighWater->uxEnoughSpace > pxSocket->u.xTCP.uxRxStreamSize ) )
-        {
-            /* Impossible values. */
-            FreeRTOS_debug_printf( ( "FREERTOS_SO_SET_LOW_HIGH_WATER: bad values\n" ) );
-        }
-        else
-        {
-            /* Send a STOP when buffer space drops below 'uxLittleSpace' bytes. */
-            pxSocket->u.xTCP.uxLittleSpace = pxLowHighWater->uxLittleSpace;
-            /* Send a GO when buffer space grows above 'uxEnoughSpace' bytes. */
-            pxSocket->u.xTCP.uxEnoughSpace = pxLowHighWater->uxEnoughSpace;
-            xReturn = 0;
-        }
-
-        return xReturn;
-    }
-#endif /* ( ipconfigUSE_TCP != 0 ) */
-/*-----------------------------------------------------------*/
-
-#if ( ipconfigUSE_TCP != 0 )
-
-/**
- * @brief Handle the socket option FREERTOS_SO_SET_FULL_SIZE.
- *        When enabled, the IP-stack will only send packets when
- *        there are at least MSS bytes to send.
+ * @param[in] xSocket The socket owning the buffer.
+ * @param[in] pxLength This will contain the number of bytes that may be written.
  *
- * @param[in] pxSocket The socket whose options are being set.
- * @param[in] pvOptionValue The option name like FREERTOS_SO_xxx_HANDLER.
+ * @return Head of the circular transmit buffer if all checks pass. Or else, NULL
+ *         is returned.
  */
-    static BaseType_t prvSetOptionSetFullSize( FreeRTOS_Socket_t * pxSocket,
-                                               const void * pvOptionValue )
+    uint8_t * FreeRTOS_get_tx_head( Socket_t xSocket,
+                                    BaseType_t * pxLength )
     {
-        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        uint8_t * pucReturn = NULL;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        StreamBuffer_t * pxBuffer = NULL;
 
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        *pxLength = 0;
+
+        /* Confirm that this is a TCP socket before dereferencing structure
+         * member pointers. */
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE )
         {
-            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+            #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
             {
-                pxSocket->u.xTCP.xTCPWindow.u.bits.bSendFullSize = pdTRUE_UNSIGNED;
+                /* The application will hold a pointer into the TX stream. */
+                prvTCPKeepTxStream( pxSocket );
             }
-            else
+            #endif
+
+            pxBuffer = pxSocket->u.xTCP.txStream;
+
+            /* If the TX buffer hasn't been created yet,
+             * and if no malloc error has occurred on this socket yet. */
+            if( ( pxBuffer == NULL ) &&
+                ( pxSocket->u.xTCP.bits.bMallocError == pdFALSE_UNSIGNED ) )
             {
-                pxSocket->u.xTCP.xTCPWindow.u.bits.bSendFullSize = pdFALSE_UNSIGNED;
+                /* Create the outgoing stream only when it is needed */
+                ( void ) prvTCPCreateStream( pxSocket, pdFALSE );
+                pxBuffer = pxSocket->u.xTCP.txStream;
             }
 
-            if( ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) &&
-                ( FreeRTOS_outstanding( pxSocket ) != 0 ) )
+            if( pxBuffer != NULL )
             {
-                /* There might be some data in the TX-stream, less than full-size,
-                 * which equals a MSS.  Wake-up the IP-task to check this. */
-                pxSocket->u.xTCP.usTimeout = 1U;
-                ( void ) xSendEventToIPTask( eTCPTimerEvent );
-            }
+                size_t uxSpace = uxStreamBufferGetSpace( pxBuffer );
+                size_t uxRemain = pxBuffer->LENGTH - pxBuffer->uxHead;
 
-            xReturn = 0;
+                #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+                {
+                    /* The application will hold a pointer into the TX stream. */
+                    prvTCPAutoTuneDisable( pxSocket );
+                }
+                #endif
+
+                if( uxRemain <= uxSpace )
+                {
+                    *pxLength = ( BaseType_t ) uxRemain;
+                }
+                else
+                {
+                    *pxLength = ( BaseType_t ) uxSpace;
+                }
+
+                pucReturn = &( pxBuffer->ucArray[ pxBuffer->uxHead ] );
+            }
         }
 
-        return xReturn;
+        return pucReturn;
     }
-#endif /* ( ipconfigUSE_TCP != 0 ) */
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP != 0 )
+#if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Handle the socket option FREERTOS_SO_STOP_RX.
- *        Used in applications with streaming audio: tell the peer
- *        to stop or continue sending data.
+ * @brief Get direct pointers to all free space in the circular transmit
+ *        buffer, as at most two regions.  The second region is used when
+ *        the free space wraps around the end of the buffer.
  *
- * @param[in] pxSocket The TCP socket used for the connection.
- * @param[in] pvOptionValue The option name like FREERTOS_SO_xxx_HANDLER.
+ * @param[in] xSocket The socket owning the buffer.
+ * @param[out] pxRegions An array of two regions that will be filled in.
+ *                        Once data have been written to them, call
+ *                        FreeRTOS_send() with a NULL buffer to queue it.
+ *
+ * @return The total number of bytes that may be written, or
+ *         -pdFREERTOS_ERRNO_EINVAL when the socket is not a valid TCP socket.
  */
-    static BaseType_t prvSetOptionStopRX( FreeRTOS_Socket_t * pxSocket,
-                                          const void * pvOptionValue )
+    BaseType_t FreeRTOS_get_tx_regions( Socket_t xSocket,
+                                        struct xSTREAM_BUFFER_REGION * pxRegions )
     {
         BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        StreamBuffer_t * pxBuffer = NULL;
 
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        ( void ) memset( pxRegions, 0, 2U * sizeof( *pxRegions ) );
+
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE )
         {
-            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+            xReturn = 0;
+
+            #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
             {
-                pxSocket->u.xTCP.bits.bRxStopped = pdTRUE_UNSIGNED;
+                /* The application will hold pointers into the TX stream. */
+                prvTCPKeepTxStream( pxSocket );
             }
-            else
+            #endif
+
+            pxBuffer = pxSocket->u.xTCP.txStream;
+
+            if( ( pxBuffer == NULL ) &&
+                ( pxSocket->u.xTCP.bits.bMallocError == pdFALSE_UNSIGNED ) )
             {
-                pxSocket->u.xTCP.bits.bRxStopped = pdFALSE_UNSIGNED;
+                /* Create the outgoing stream only when it is needed */
+                ( void ) prvTCPCreateStream( pxSocket, pdFALSE );
+                pxBuffer = pxSocket->u.xTCP.txStream;
             }
 
-            pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
-            pxSocket->u.xTCP.usTimeout = 1U; /* to set/clear bRxStopped */
-            ( void ) xSendEventToIPTask( eTCPTimerEvent );
-            xReturn = 0;
+            if( pxBuffer != NULL )
+            {
+                #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+                {
+                    /* The application will hold pointers into the TX stream. */
+                    prvTCPAutoTuneDisable( pxSocket );
+                }
+                #endif
+
+                xReturn = ( BaseType_t ) uxStreamBufferGetWriteRegions( pxBuffer, pxRegions );
+            }
         }
 
         return xReturn;
     }
-#endif /* ( ipconfigUSE_TCP != 0 ) */
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Handle the socket options FREERTOS_SO_RCVTIMEO and
- *        FREERTOS_SO_SNDTIMEO.
- *        Used in applications with streaming audio: tell the peer
- *        to stop or continue sending data.
+ * @brief This internal function will try to send as many bytes as possible to a TCP-socket.
  *
- * @param[in] pxSocket The TCP socket used for the connection.
- * @param[in] pvOptionValue The option name like FREERTOS_SO_xxx_HANDLER.
- * @param[in] xForSend when true, handle 'FREERTOS_SO_SNDTIMEO',
- *            otherwise handle the option `FREERTOS_SO_RCVTIMEO`.
+ * @param[in] pxSocket  The socket owning the connection.
+ * @param[in] pvBuffer  The buffer containing the data to be sent.
+ * @param[in] uxDataLength  The number of bytes contained in the buffer.
+ * @param[in] xFlags  Only the flag 'FREERTOS_MSG_DONTWAIT' will be tested.
+ *
+ * @result The number of bytes queued for transmission.
  */
-static void prvSetOptionTimeout( FreeRTOS_Socket_t * pxSocket,
-                                 const void * pvOptionValue,
-                                 BaseType_t xForSend )
-{
-    TickType_t xBlockTime = *( ( const TickType_t * ) pvOptionValue );
-
-    if( xForSend == pdTRUE )
+    static BaseType_t prvTCPSendLoop( FreeRTOS_Socket_t * pxSocket,
+                                      const void * pvBuffer,
+                                      size_t uxDataLength,
+                                      BaseType_t xFlags )
     {
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+        /* The number of bytes sent. */
+        BaseType_t xBytesSent = 0;
+        /* xBytesLeft is the number of bytes that still must be sent. */
+        BaseType_t xBytesLeft = ( BaseType_t ) uxDataLength;
+        /* xByteCount is number of bytes that can be sent now. */
+        BaseType_t xByteCount = ( BaseType_t ) uxStreamBufferGetSpace( pxSocket->u.xTCP.txStream );
+        TickType_t xRemainingTime;
+        BaseType_t xTimed = pdFALSE;
+        TimeOut_t xTimeOut;
+        const uint8_t * pucSource = ( const uint8_t * ) pvBuffer;
+        uint32_t ulMore = ( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_MSG_MORE ) != 0U ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+
+        if( pxSocket->u.xTCP.bits.bMore != ulMore )
         {
-            /* The send time out is capped for the reason stated in the
-             * comments where ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS is defined
-             * in FreeRTOSIPConfig.h (assuming an official configuration file
-             * is being used. */
-            if( xBlockTime > ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS )
+            /* The IP-task must see the flag before it sees the new data.  The
+             * scheduler is suspended because the IP-task writes other bits. */
+            vTaskSuspendAll();
             {
-                xBlockTime = ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS;
+                pxSocket->u.xTCP.bits.bMore = ulMore;
             }
+            ( void ) xTaskResumeAll();
         }
-        else
+
+        /* While there are still bytes to be sent. */
+        while( xBytesLeft > 0 )
         {
-            /* For TCP socket, it isn't necessary to limit the blocking time
-             * because  the FreeRTOS_send() function does not wait for a network
-             * buffer to become available. */
-        }
+            /* If txStream has space. */
+            if( xByteCount > 0 )
+            {
+                BaseType_t xCloseAfterSend = pdFALSE;
 
-        pxSocket->xSendBlockTime = xBlockTime;
-    }
-    else
-    {
-        pxSocket->xReceiveBlockTime = xBlockTime;
-    }
-}
-/*-----------------------------------------------------------*/
+                /* Don't send more than necessary. */
+                if( xByteCount > xBytesLeft )
+                {
+                    xByteCount = xBytesLeft;
+                }
 
-#if ( ipconfigUSE_TCP != 0 )
+                if( ( pxSocket->u.xTCP.bits.bCloseAfterSend != pdFALSE_UNSIGNED ) &&
+                    ( xByteCount == xBytesLeft ) )
+                {
+                    xCloseAfterSend = pdTRUE;
 
-/**
- * @brief Handle the socket options FREERTOS_SO_REUSE_LISTEN_SOCKET.
- *        When set, a listening socket will turn itself into a child
- *        socket when it receives a connection.
- *
- * @param[in] pxSocket The TCP socket used for the connection.
- * @param[in] pvOptionValue The option name like FREERTOS_SO_xxx_HANDLER.
- */
-    static BaseType_t prvSetOptionReuseListenSocket( FreeRTOS_Socket_t * pxSocket,
-                                                     const void * pvOptionValue )
-    {
-        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+                    /* Now suspend the scheduler: sending the last data and
+                     * setting bCloseRequested must be done together */
+                    vTaskSuspendAll();
+                    pxSocket->u.xTCP.bits.bCloseRequested = pdTRUE_UNSIGNED;
 
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
-        {
-            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+                    /* The flag 'bCloseAfterSend' can be set before sending data
+                     * using setsockopt()
+                     *
+                     * When the last data packet is being sent out, a FIN flag will
+                     * be included to let the peer know that no more data is to be
+                     * expected.  The use of 'bCloseAfterSend' is not mandatory, it
+                     * is just a faster way of transferring files (e.g. when using
+                     * FTP). */
+                }
+
+                xByteCount = ( BaseType_t ) uxStreamBufferAdd( pxSocket->u.xTCP.txStream, 0U, pucSource, ( size_t ) xByteCount );
+
+                if( xCloseAfterSend == pdTRUE )
+                {
+                    /* Now when the IP-task transmits the data, it will also
+                     * see that bCloseRequested is true and include the FIN
+                     * flag to start closure of the connection. */
+                    ( void ) xTaskResumeAll();
+                }
+
+                /* Send a message to the IP-task so it can work on this
+                * socket.  Data is sent, let the IP-task work on it. */
+                pxSocket->u.xTCP.usTimeout = 1U;
+                vTCPTimerWheelRequest( pxSocket );
+
+                if( xIsCallingFromIPTask() == pdFALSE )
+                {
+                    /* Only send a TCP timer event when not called from the
+                     * IP-task. */
+                    ( void ) xSendEventToIPTask( eTCPTimerEvent );
+                }
+
+                xBytesLeft -= xByteCount;
+                xBytesSent += xByteCount;
+
+                if( ( xBytesLeft == 0 ) || ( pvBuffer == NULL ) )
+                {
+                    /* pvBuffer can be NULL in case TCP zero-copy transmissions are used. */
+                    break;
+                }
+
+                /* As there are still bytes left to be sent, increase the
+                 * data pointer. */
+                pucSource = &( pucSource[ xByteCount ] );
+            } /* if( xByteCount > 0 ) */
+
+            /* Not all bytes have been sent. In case the socket is marked as
+             * blocking sleep for a while. */
+            if( xTimed == pdFALSE )
             {
-                pxSocket->u.xTCP.bits.bReuseSocket = pdTRUE_UNSIGNED;
+                /* Only in the first round, check for non-blocking. */
+                xRemainingTime = pxSocket->xSendBlockTime;
+
+                if( xIsCallingFromIPTask() != pdFALSE )
+                {
+                    /* If this send function is called from within a
+                     * call-back handler it may not block, otherwise
+                     * chances would be big to get a deadlock: the IP-task
+                     * waiting for itself. */
+                    xRemainingTime = ( TickType_t ) 0U;
+                }
+
+                if( xRemainingTime == ( TickType_t ) 0U )
+                {
+                    break;
+                }
+
+                if( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_MSG_DONTWAIT ) != 0U )
+                {
+                    break;
+                }
+
+                /* Don't get here a second time. */
+                xTimed = pdTRUE;
+
+                /* Fetch the current time. */
+                vTaskSetTimeOutState( &xTimeOut );
             }
             else
             {
-                pxSocket->u.xTCP.bits.bReuseSocket = pdFALSE_UNSIGNED;
+                /* Has the timeout been reached? */
+                if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
+                {
+                    break;
+                }
             }
 
-            xReturn = 0;
-        }
+            /* Go sleeping until a SEND or a CLOSE event is received. */
+            sockSTREAM_LEAVE( pxSocket->u.xTCP.ucTxStreamUsers );
+            ( void ) xSocketEventWait( pxSocket, ( EventBits_t ) eSOCKET_SEND | ( EventBits_t ) eSOCKET_CLOSED,
+                                       pdTRUE /*xClearOnExit*/, xRemainingTime );
+            sockSTREAM_ENTER( pxSocket->u.xTCP.ucTxStreamUsers );
 
-        return xReturn;
-    }
-#endif /* ( ipconfigUSE_TCP != 0 ) */
-/*-----------------------------------------------------------*/
+            xByteCount = ( BaseType_t ) prvTCPSendCheck( pxSocket, uxDataLength );
 
-#if ( ipconfigUSE_TCP != 0 )
+            if( xByteCount < 0 )
+            {
+                /* In a meanwhile, the connection has dropped, stop iterating. */
+                break;
+            }
+
+            /* See if in a meanwhile there is space in the TX-stream. */
+            xByteCount = ( BaseType_t ) uxStreamBufferGetSpace( pxSocket->u.xTCP.txStream );
+        } /* while( xBytesLeft > 0 ) */
+
+        return xBytesSent;
+    }
 
 /**
- * @brief Handle the socket options FREERTOS_SO_CLOSE_AFTER_SEND.
- *        As soon as the last byte has been transmitted, initiate
- *        a graceful closure of the TCP connection.
+ * @brief Send data using a TCP socket. It is not necessary to have the socket
+ *        connected already. Outgoing data will be stored and delivered as soon as
+ *        the socket gets connected.
  *
- * @param[in] pxSocket The TCP socket used for the connection.
- * @param[in] pvOptionValue A pointer to a binary value of size
- *            BaseType_t.
+ * @param[in] xSocket  The socket owning the connection.
+ * @param[in] pvBuffer The buffer containing the data. The value of this pointer
+ *                      may be NULL in case zero-copy transmissions are used.
+ *                      It is used in combination with 'FreeRTOS_get_tx_head()'.
+ * @param[in] uxDataLength The length of the data to be added.
+ * @param[in] xFlags Zero, or FREERTOS_MSG_DONTWAIT and/or FREERTOS_MSG_MORE.
+ *                   With FREERTOS_MSG_MORE, data that does not fill a segment
+ *                   is held back until the next call without that flag.
+ *
+ * @return The number of bytes actually sent. Zero when nothing could be sent
+ *         or a negative error code in case an error occurred.
  */
-    static BaseType_t prvSetOptionCloseAfterSend( FreeRTOS_Socket_t * pxSocket,
-                                                  const void * pvOptionValue )
+    BaseType_t FreeRTOS_send( Socket_t xSocket,
+                              const void * pvBuffer,
+                              size_t uxDataLength,
+                              BaseType_t xFlags )
     {
-        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        BaseType_t xByteCount;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
 
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        xByteCount = ( BaseType_t ) prvTCPSendCheck( pxSocket, uxDataLength );
+
+        if( xByteCount > 0 )
         {
-            if( *( ( const BaseType_t * ) pvOptionValue ) != 0 )
+            /* The IP-task will not replace or release the TX stream while it
+             * is used, except while prvTCPSendLoop() is waiting for space. */
+            sockSTREAM_ENTER( pxSocket->u.xTCP.ucTxStreamUsers );
+
+            #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+                xByteCount = prvTCPRestoreTxStream( pxSocket );
+
+                if( xByteCount > 0 )
+            #endif
             {
-                pxSocket->u.xTCP.bits.bCloseAfterSend = pdTRUE_UNSIGNED;
+                /* prvTCPSendLoop() will try to send as many bytes as possible,
+                 * returning number of bytes that have been queued for transmission.. */
+                xByteCount = prvTCPSendLoop( pxSocket, pvBuffer, uxDataLength, xFlags );
             }
-            else
+
+            sockSTREAM_LEAVE( pxSocket->u.xTCP.ucTxStreamUsers );
+
+            if( xByteCount == 0 )
             {
-                pxSocket->u.xTCP.bits.bCloseAfterSend = pdFALSE_UNSIGNED;
-            }
+                if( pxSocket->u.xTCP.eTCPState > eESTABLISHED )
+                {
+                    xByteCount = ( BaseType_t ) -pdFREERTOS_ERRNO_ENOTCONN;
+                }
+                else
+                {
+                    if( ipconfigTCP_MAY_LOG_PORT( pxSocket->usLocalPort ) )
+                    {
+                        FreeRTOS_debug_printf( ( "FreeRTOS_send: %u -> %xip:%d: no space\n",
+                                                 pxSocket->usLocalPort,
+                                                 ( unsigned ) pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4,
+                                                 pxSocket->u.xTCP.usRemotePort ) );
+                    }
 
-            xReturn = 0;
+                    xByteCount = ( BaseType_t ) -pdFREERTOS_ERRNO_ENOSPC;
+                }
+            }
         }
 
-        return xReturn;
+        return xByteCount;
     }
-#endif /* ( ipconfigUSE_TCP != 0 ) */
+
+
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS_setsockopt calls itself, but in a very limited way,
- * only when FREERTOS_SO_WIN_PROPERTIES is being set. */
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_TX_REFERENCE_COUNT != 0 ) )
 
 /**
- * @brief Set the socket options for the given socket.
- *
- * @param[in] xSocket The socket for which the options are to be set.
- * @param[in] lLevel Not used. Parameter is used to maintain the Berkeley sockets
- *                    standard.
- * @param[in] lOptionName The name of the option to be set.
- * @param[in] pvOptionValue The value of the option to be set.
- * @param[in] uxOptionLength Not used. Parameter is used to maintain the Berkeley
- *                            sockets standard.
+ * @brief Queue a buffer for transmission, without copying it into the txStream.
+ *        The data will be copied directly from the buffer into the outgoing
+ *        packets.  The buffer must stay valid and unchanged until
+ *        'pxOnReleased' has been called from the IP-task.
  *
- * @return If the option can be set with the given value, then 0 is returned. Else,
- *         an error code is returned.
+ * @param[in] xSocket The socket owning the connection.
+ * @param[in] pvBuffer The buffer containing the data to be sent.
+ * @param[in] uxDataLength The length of the data to be sent.
+ * @param[in] pxOnReleased Will be called when the buffer is not used any more.
+ * @param[in] pvArgument Will be passed to 'pxOnReleased'.
+ *
+ * @return 'uxDataLength' when the buffer has been queued, zero in case
+ *         of an empty buffer or a FIN that was sent already, or a negative
+ *         error code.  The call does not block, -pdFREERTOS_ERRNO_ENOSPC is
+ *         returned when the txStream has too little space, or when
+ *         ipconfigTCP_TX_REFERENCE_COUNT buffers are queued already.
  */
-BaseType_t FreeRTOS_setsockopt( Socket_t xSocket,
-                                int32_t lLevel,
-                                int32_t lOptionName,
-                                const void * pvOptionValue,
-                                size_t uxOptionLength )
-{
-/* The standard Berkeley function returns 0 for success. */
-    BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
-    FreeRTOS_Socket_t * pxSocket;
-
-    pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-
-    /* The function prototype is designed to maintain the expected Berkeley
-     * sockets standard, but this implementation does not use all the parameters. */
-    ( void ) lLevel;
-    ( void ) uxOptionLength;
-
-    if( xSocketValid( pxSocket ) == pdTRUE )
+    BaseType_t FreeRTOS_send_reference( Socket_t xSocket,
+                                        const void * pvBuffer,
+                                        size_t uxDataLength,
+                                        FOnTCPReferenceReleased_t pxOnReleased,
+                                        void * pvArgument )
     {
-        switch( lOptionName )
-        {
-            case FREERTOS_SO_RCVTIMEO:
-                /* Receive time out. */
-                prvSetOptionTimeout( pxSocket, pvOptionValue, pdFALSE );
-                xReturn = 0;
-                break;
-
-            case FREERTOS_SO_SNDTIMEO:
-                prvSetOptionTimeout( pxSocket, pvOptionValue, pdTRUE );
-                xReturn = 0;
-                break;
-
-                #if ( ipconfigUDP_MAX_RX_PACKETS > 0U )
-                    case FREERTOS_SO_UDP_MAX_RX_PACKETS:
-
-                        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_UDP )
-                        {
-                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
-                        }
+        BaseType_t xResult;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        TCPTxReference_t * pxReference;
+        UBaseType_t uxIndex;
 
-                        pxSocket->u.xUDP.uxMaxPackets = *( ( const UBaseType_t * ) pvOptionValue );
-                        xReturn = 0;
-                        break;
-                #endif /* ipconfigUDP_MAX_RX_PACKETS */
+        xResult = ( BaseType_t ) prvTCPSendCheck( pxSocket, uxDataLength );
 
-            case FREERTOS_SO_UDPCKSUM_OUT:
+        if( xResult > 0 )
+        {
+            /* The IP-task will not replace or release the TX stream now. */
+            sockSTREAM_ENTER( pxSocket->u.xTCP.ucTxStreamUsers );
 
-                /* Turn calculating of the UDP checksum on/off for this socket. If pvOptionValue
-                 * is anything else than NULL, the checksum generation will be turned on. */
+            if( pvBuffer == NULL )
+            {
+                xResult = -pdFREERTOS_ERRNO_EINVAL;
+            }
 
-                if( pvOptionValue == NULL )
+            #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+                else if( prvTCPRestoreTxStream( pxSocket ) < 0 )
                 {
-                    pxSocket->ucSocketOptions &= ( ( uint8_t ) ~( ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) );
+                    xResult = -pdFREERTOS_ERRNO_ENOMEM;
                 }
-                else
+            #endif
+            else if( ( pxSocket->u.xTCP.uxTxReferenceCount >= ( UBaseType_t ) ipconfigTCP_TX_REFERENCE_COUNT ) ||
+                     ( uxStreamBufferGetSpace( pxSocket->u.xTCP.txStream ) < uxDataLength ) )
+            {
+                xResult = -pdFREERTOS_ERRNO_ENOSPC;
+            }
+            else
+            {
+                uxIndex = pxSocket->u.xTCP.uxTxReferenceFirst + pxSocket->u.xTCP.uxTxReferenceCount;
+
+                if( uxIndex >= ( UBaseType_t ) ipconfigTCP_TX_REFERENCE_COUNT )
                 {
-                    pxSocket->ucSocketOptions |= ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT;
+                    uxIndex -= ( UBaseType_t ) ipconfigTCP_TX_REFERENCE_COUNT;
                 }
 
-                xReturn = 0;
-                break;
+                pxReference = &( pxSocket->u.xTCP.xTxReferences[ uxIndex ] );
+                pxReference->pucData = ( const uint8_t * ) pvBuffer;
+                pxReference->uxLength = uxDataLength;
+                pxReference->uxAcked = 0U;
+                pxReference->uxStreamPos = pxSocket->u.xTCP.txStream->uxHead;
+                pxReference->pxOnReleased = pxOnReleased;
+                pxReference->pvArgument = pvArgument;
 
-                #if ( ipconfigUSE_CALLBACKS == 1 )
-                    #if ( ipconfigUSE_TCP == 1 )
-                        case FREERTOS_SO_TCP_CONN_HANDLER: /* Set a callback for (dis)connection events */
-                        case FREERTOS_SO_TCP_RECV_HANDLER: /* Install a callback for receiving TCP data. Supply pointer to 'F_TCP_UDP_Handler_t' (see below) */
-                        case FREERTOS_SO_TCP_SENT_HANDLER: /* Install a callback for sending TCP data. Supply pointer to 'F_TCP_UDP_Handler_t' (see below) */
-                    #endif /* ipconfigUSE_TCP */
-                    case FREERTOS_SO_UDP_RECV_HANDLER:     /* Install a callback for receiving UDP data. Supply pointer to 'F_TCP_UDP_Handler_t' (see below) */
-                    case FREERTOS_SO_UDP_SENT_HANDLER:     /* Install a callback for sending UDP data. Supply pointer to 'F_TCP_UDP_Handler_t' (see below) */
-                        xReturn = prvSetOptionCallback( pxSocket, lOptionName, pvOptionValue );
-                        break;
-                #endif /* ipconfigUSE_CALLBACKS */
+                /* The reference and the head of txStream must be updated
+                 * together.  The space is reserved, but nothing is written. */
+                vTaskSuspendAll();
+                {
+                    pxSocket->u.xTCP.uxTxReferenceCount++;
+                    ( void ) uxStreamBufferAdd( pxSocket->u.xTCP.txStream, 0U, NULL, uxDataLength );
+                }
+                ( void ) xTaskResumeAll();
 
-                #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE != 0 )
+                /* Let the IP-task work on this socket. */
+                pxSocket->u.xTCP.usTimeout = 1U;
+                vTCPTimerWheelRequest( pxSocket );
 
-                    /* Each socket has a semaphore on which the using task normally
-                     * sleeps. */
-                    case FREERTOS_SO_SET_SEMAPHORE:
-                        pxSocket->pxUserSemaphore = *( ( SemaphoreHandle_t * ) pvOptionValue );
-                        xReturn = 0;
-                        break;
-                #endif /* ipconfigSOCKET_HAS_USER_SEMAPHORE */
+                if( xIsCallingFromIPTask() == pdFALSE )
+                {
+                    ( void ) xSendEventToIPTask( eTCPTimerEvent );
+                }
 
-                #if ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK != 0 )
-                    case FREERTOS_SO_WAKEUP_CALLBACK:
+                xResult = ( BaseType_t ) uxDataLength;
+            }
 
-                        /* Each socket can have a callback function that is executed
-                         * when there is an event the socket's owner might want to
-                         * process. */
+            sockSTREAM_LEAVE( pxSocket->u.xTCP.ucTxStreamUsers );
+        }
 
-                        /* The type cast of the pointer expression "A" to
-                         * type "B" removes const qualifier from the pointed to type. */
+        return xResult;
+    }
 
-                        ipconfigISO_STRICTNESS_VIOLATION_START;
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_TX_REFERENCE_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
 
-                        /* MISRA Ref 11.8.1 [Function pointer and use of const pointer] */
-                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-118 */
+#if ( ipconfigUSE_TCP == 1 )
 
-                        /* MISRA Ref 11.1.1 [ Conversion between pointer to
-                         * a function and another type ] */
-                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-111 */
-                        /* coverity[misra_c_2012_rule_11_8_violation] */
-                        /* coverity[misra_c_2012_rule_11_1_violation] */
-                        pxSocket->pxUserWakeCallback = ( SocketWakeupCallback_t ) pvOptionValue;
-                        ipconfigISO_STRICTNESS_VIOLATION_END;
-                        xReturn = 0;
-                        break;
-                #endif /* ipconfigSOCKET_HAS_USER_WAKE_CALLBACK */
+/**
+ * @brief Request to put a socket in listen mode.
+ *
+ * @param[in] xSocket the socket to be put in listening mode.
+ * @param[in] xBacklog Maximum number of child sockets.
+ *
+ * @return 0 in case of success, or else a negative error code is
+ *         returned.
+ */
+    /* MISRA Ref 17.2.1 [Sockets and limited recursion] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-172 */
+    /* coverity[misra_c_2012_rule_17_2_violation] */
+    /* coverity[recursive_step] */
+    BaseType_t FreeRTOS_listen( Socket_t xSocket,
+                                BaseType_t xBacklog )
+    {
+        FreeRTOS_Socket_t * pxSocket;
+        BaseType_t xResult = 0;
 
-                #if ( ipconfigUSE_TCP != 0 )
-                    case FREERTOS_SO_SET_LOW_HIGH_WATER:
-                        xReturn = prvSetOptionLowHighWater( pxSocket, pvOptionValue );
-                        break;
+        pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
 
-                    case FREERTOS_SO_SNDBUF: /* Set the size of the send buffer, in units of MSS (TCP only) */
-                    case FREERTOS_SO_RCVBUF: /* Set the size of the receive buffer, in units of MSS (TCP only) */
-                        xReturn = prvSockopt_so_buffer( pxSocket, lOptionName, pvOptionValue );
-                        break;
+        /* listen() is allowed for a valid TCP socket in Closed state and already
+         * bound. */
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
+        {
+            xResult = -pdFREERTOS_ERRNO_EOPNOTSUPP;
+        }
+        else if( ( pxSocket->u.xTCP.eTCPState != eCLOSED ) && ( pxSocket->u.xTCP.eTCPState != eCLOSE_WAIT ) )
+        {
+            /* Socket is in a wrong state. */
+            xResult = -pdFREERTOS_ERRNO_EOPNOTSUPP;
+        }
+        else
+        {
+            /* Backlog is interpreted here as "the maximum number of child
+             * sockets. */
+            pxSocket->u.xTCP.usBacklog = ( uint16_t ) FreeRTOS_min_int32( ( int32_t ) 0xffff, ( int32_t ) xBacklog );
 
-                    case FREERTOS_SO_WIN_PROPERTIES: /* Set all buffer and window properties in one call, parameter is pointer to WinProperties_t */
-                        xReturn = prvSetOptionTCPWindows( pxSocket, pvOptionValue );
-                        break;
+            /* This cleaning is necessary only if a listening socket is being
+             * reused as it might have had a previous connection. */
+            if( pxSocket->u.xTCP.bits.bReuseSocket != pdFALSE_UNSIGNED )
+            {
+                if( pxSocket->u.xTCP.rxStream != NULL )
+                {
+                    #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+                    {
+                        vTCPRxBufferFlush( pxSocket );
+                    }
+                    #endif
 
-                    case FREERTOS_SO_REUSE_LISTEN_SOCKET: /* If true, the server-socket will turn into a connected socket */
-                        xReturn = prvSetOptionReuseListenSocket( pxSocket, pvOptionValue );
-                        break;
+                    vStreamBufferClear( pxSocket->u.xTCP.rxStream );
+                }
 
-                    case FREERTOS_SO_CLOSE_AFTER_SEND: /* As soon as the last byte has been transmitted, finalise the connection */
-                        xReturn = prvSetOptionCloseAfterSend( pxSocket, pvOptionValue );
-                        break;
+                if( pxSocket->u.xTCP.txStream != NULL )
+                {
+                    #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+                    {
+                        vTCPTxReferenceFlush( pxSocket );
+                    }
+                    #endif
 
-                    case FREERTOS_SO_SET_FULL_SIZE: /* Refuse to send packets smaller than MSS  */
-                        xReturn = prvSetOptionSetFullSize( pxSocket, pvOptionValue );
-                        break;
+                    vStreamBufferClear( pxSocket->u.xTCP.txStream );
+                }
 
-                    case FREERTOS_SO_STOP_RX: /* Refuse to receive more packets. */
-                        xReturn = prvSetOptionStopRX( pxSocket, pvOptionValue );
-                        break;
-                #endif /* ipconfigUSE_TCP == 1 */
+                ( void ) memset( pxSocket->u.xTCP.xPacket.u.ucLastPacket, 0, sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket ) );
+                ( void ) memset( &pxSocket->u.xTCP.xTCPWindow, 0, sizeof( pxSocket->u.xTCP.xTCPWindow ) );
+                ( void ) memset( &pxSocket->u.xTCP.bits, 0, sizeof( pxSocket->u.xTCP.bits ) );
 
-            default:
-                /* No other options are handled. */
-                xReturn = -pdFREERTOS_ERRNO_ENOPROTOOPT;
-                break;
+                /* Now set the bReuseSocket flag again, because the bits have
+                 * just been cleared. */
+                pxSocket->u.xTCP.bits.bReuseSocket = pdTRUE;
+            }
+
+            vTCPStateChange( pxSocket, eTCP_LISTEN );
+
+            #if ( ipconfigTCP_LISTEN_POOL_SIZE != 0 )
+            {
+                if( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED )
+                {
+                    prvTCPListenPoolFill( pxSocket );
+                }
+            }
+            #endif
         }
-    }
-    else
-    {
-        xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        return xResult;
     }
 
-    return xReturn;
-} /* Tested */
 
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_TCP == 1 )
+
 /**
- * @brief Find an available port number per https://tools.ietf.org/html/rfc6056.
+ * @brief Shutdown - This function will shut down the connection in both
+ *        directions. However, it will first deliver all data queued for
+ *        transmission, and also it will first wait to receive any missing
+ *        packets from the peer.
  *
- * @param[in] xProtocol FREERTOS_IPPROTO_TCP/FREERTOS_IPPROTO_UDP.
+ * @param[in] xSocket The socket owning the connection.
+ * @param[in] xHow Not used. Just present to stick to Berkeley standard.
  *
- * @return If an available protocol port is found then that port number is returned.
- *         Or else, 0 is returned.
+ * @return 0 on successful shutdown or else a negative error code.
  */
-static uint16_t prvGetPrivatePortNumber( BaseType_t xProtocol )
-{
-    const uint16_t usEphemeralPortCount =
-        socketAUTO_PORT_ALLOCATION_MAX_NUMBER - ( uint16_t ) ( socketAUTO_PORT_ALLOCATION_START_NUMBER - 1U );
-    uint16_t usIterations = usEphemeralPortCount;
-    uint32_t ulRandomSeed = 0;
-    uint16_t usResult = 0;
-    const List_t * pxList;
-
-    #if ipconfigUSE_TCP == 1
-        if( xProtocol == ( BaseType_t ) FREERTOS_IPPROTO_TCP )
-        {
-            pxList = &xBoundTCPSocketsList;
-        }
-        else
-    #endif
+    BaseType_t FreeRTOS_shutdown( Socket_t xSocket,
+                                  BaseType_t xHow )
     {
-        pxList = &xBoundUDPSocketsList;
-    }
-
-    /* Avoid compiler warnings if ipconfigUSE_TCP is not defined. */
-    ( void ) xProtocol;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        BaseType_t xResult;
 
-    /* Find the next available port using the random seed as a starting
-     * point. */
-    do
-    {
-        /* Only proceed if the random number generator succeeded. */
-        if( xApplicationGetRandomNumber( &( ulRandomSeed ) ) == pdFALSE )
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
         {
-            break;
+            /*_RB_ Is this comment correct?  The socket is not of a type that
+             * supports the listen() operation. */
+            xResult = -pdFREERTOS_ERRNO_EOPNOTSUPP;
         }
-
-        /* Map the random to a candidate port. */
-        usResult = ( uint16_t ) ( socketAUTO_PORT_ALLOCATION_START_NUMBER +
-                                  ( ( ( uint16_t ) ulRandomSeed ) % usEphemeralPortCount ) );
-
-        /* Check if there's already an open socket with the same protocol
-         * and port. */
-        if( NULL == pxListFindListItemWithValue(
-                pxList,
-                ( TickType_t ) FreeRTOS_htons( usResult ) ) )
+        else if( pxSocket->u.xTCP.eTCPState != eESTABLISHED )
         {
-            usResult = FreeRTOS_htons( usResult );
-            break;
+            /* The socket is not connected. */
+            xResult = -pdFREERTOS_ERRNO_ENOTCONN;
         }
         else
         {
-            usResult = 0;
+            pxSocket->u.xTCP.bits.bUserShutdown = pdTRUE_UNSIGNED;
+
+            /* Let the IP-task perform the shutdown of the connection. */
+            pxSocket->u.xTCP.usTimeout = 1U;
+            vTCPTimerWheelRequest( pxSocket );
+            ( void ) xSendEventToIPTask( eTCPTimerEvent );
+            xResult = 0;
         }
 
-        usIterations--;
+        ( void ) xHow;
+
+        return xResult;
     }
-    while( usIterations > 0U );
 
-    return usResult;
-}
+
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_TCP == 1 )
+
+    #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
 /**
- * @brief Find a list item associated with the wanted-item.
- *
- * @param[in] pxList The list through which the search is to be conducted.
- * @param[in] xWantedItemValue The wanted item whose association is to be found.
- *
- * @return The list item holding the value being searched for. If nothing is found,
- *         then a NULL is returned.
+ * @brief An interface has room to send again: let the TCP sockets that were
+ *        paused by ipTX_BUSY continue at the next check of the TCP timer.
+ *        Sockets of an interface that is still busy will pause again.
  */
-static const ListItem_t * pxListFindListItemWithValue( const List_t * pxList,
-                                                       TickType_t xWantedItemValue )
-{
-    const ListItem_t * pxResult = NULL;
+        void vTCPResumeTxPaused( void )
+        {
+            FreeRTOS_Socket_t * pxSocket;
+            BaseType_t xResumed = pdFALSE;
 
-    if( ( xIPIsNetworkTaskReady() != pdFALSE ) && ( pxList != NULL ) )
-    {
-        const ListItem_t * pxIterator;
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
 
-        /* MISRA Ref 11.3.1 [Misaligned access] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-        /* coverity[misra_c_2012_rule_11_3_violation] */
-        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( pxList->xListEnd ) );
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ListItem_t * pxIterator = ( const ListItem_t * ) listGET_HEAD_ENTRY( &xBoundTCPSocketsList );
 
-        for( pxIterator = listGET_NEXT( pxEnd );
-             pxIterator != pxEnd;
-             pxIterator = listGET_NEXT( pxIterator ) )
-        {
-            if( listGET_LIST_ITEM_VALUE( pxIterator ) == xWantedItemValue )
+            while( pxIterator != pxEnd )
             {
-                pxResult = pxIterator;
-                break;
+                pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                pxIterator = ( ListItem_t * ) listGET_NEXT( pxIterator );
+
+                if( pxSocket->u.xTCP.bits.bTxPaused != pdFALSE_UNSIGNED )
+                {
+                    pxSocket->u.xTCP.bits.bTxPaused = pdFALSE_UNSIGNED;
+                    pxSocket->u.xTCP.usTimeout = 1U;
+                    vTCPTimerWheelRequest( pxSocket );
+                    xResumed = pdTRUE;
+                }
             }
-        }
-    }
 
-    return pxResult;
-} /* Tested */
+            if( xResumed != pdFALSE )
+            {
+                ( void ) xSendEventToIPTask( eTCPTimerEvent );
+            }
+        }
+        /*-----------------------------------------------------------*/
 
-/*-----------------------------------------------------------*/
+    #endif /* ipconfigUSE_TX_BACKPRESSURE */
 
 /**
- * @brief Find the UDP socket corresponding to the port number.
+ * @brief A TCP timer has expired, now check all TCP sockets for:
+ *        - Active connect
+ *        - Send a delayed ACK
+ *        - Send new data
+ *        - Send a keep-alive packet
+ *        - Check for timeout (in non-connected states only)
  *
- * @param[in] uxLocalPort The port whose corresponding bound UDP socket
- *                         is to be found.
+ * @param[in] xWillSleep Whether the calling task is going to sleep.
  *
- * @return The socket owning the port if found or else NULL.
+ * @return Minimum amount of time before the timer shall expire.
  */
-FreeRTOS_Socket_t * pxUDPSocketLookup( UBaseType_t uxLocalPort )
-{
-    const ListItem_t * pxListItem;
-    FreeRTOS_Socket_t * pxSocket = NULL;
+    TickType_t xTCPTimerCheck( BaseType_t xWillSleep )
+    {
+        FreeRTOS_Socket_t * pxSocket;
+        #if ( ipconfigUSE_TICKLESS_IP_TASK != 0 )
+            /* A socket without a pending timeout does not need the IP task. */
+            TickType_t xShortest = ipconfigMAX_IP_TASK_SLEEP_TIME;
+        #else
+            TickType_t xShortest = pdMS_TO_TICKS( ( TickType_t ) ipTCP_TIMER_PERIOD_MS );
+        #endif
+        TickType_t xNow = xTaskGetTickCount();
+        static TickType_t xLastTime = 0U;
+        TickType_t xDelta = xNow - xLastTime;
 
-    /* Looking up a socket is quite simple, find a match with the local port.
-     *
-     * See if there is a list item associated with the port number on the
-     * list of bound sockets. */
-    pxListItem = pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) uxLocalPort );
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
 
-    if( pxListItem != NULL )
-    {
-        /* The owner of the list item is the socket itself. */
-        pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxListItem ) );
-        configASSERT( pxSocket != NULL );
-    }
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const ListItem_t * pxIterator = ( const ListItem_t * ) listGET_HEAD_ENTRY( &xBoundTCPSocketsList );
 
-    return pxSocket;
-}
+        xLastTime = xNow;
 
-/*-----------------------------------------------------------*/
+        if( xDelta == 0U )
+        {
+            xDelta = 1U;
+        }
 
-#define sockDIGIT_COUNT    ( 3U ) /**< Each nibble is expressed in at most 3 digits such as "192". */
+        while( pxIterator != pxEnd )
+        {
+            pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+            pxIterator = ( ListItem_t * ) listGET_NEXT( pxIterator );
 
-/**
- * @brief Convert the 32-bit representation of the IP-address to the dotted decimal
- *        notation after some checks.
- *        A safe alternative is FreeRTOS_inet_ntop4().
- *
- * @param[in] ulIPAddress 32-bit representation of the IP-address.
- * @param[out] pcBuffer The buffer where the dotted decimal representation will be
- *                      stored if all checks pass. The buffer must be at least 16
- *                      bytes long.
- *
- * @return The pointer returned will be same as pcBuffer and will have the address
- *         stored in the location.
- */
-const char * FreeRTOS_inet_ntoa( uint32_t ulIPAddress,
-                                 char * pcBuffer )
-{
-    socklen_t uxNibble;
-    socklen_t uxIndex = 0;
-    const uint8_t * pucAddress = ( const uint8_t * ) &( ulIPAddress );
-    const char * pcResult = pcBuffer;
+            /* Sockets with 'timeout == 0' do not need any regular attention. */
+            if( pxSocket->u.xTCP.usTimeout == 0U )
+            {
+                continue;
+            }
 
-    for( uxNibble = 0; uxNibble < ipSIZE_OF_IPv4_ADDRESS; uxNibble++ )
-    {
-        uint8_t pucDigits[ sockDIGIT_COUNT ];
-        uint8_t ucValue = pucAddress[ uxNibble ];
-        socklen_t uxSource = ( socklen_t ) sockDIGIT_COUNT - ( socklen_t ) 1U;
+            if( xDelta < ( TickType_t ) pxSocket->u.xTCP.usTimeout )
+            {
+                pxSocket->u.xTCP.usTimeout = ( uint16_t ) ( ( ( TickType_t ) pxSocket->u.xTCP.usTimeout ) - xDelta );
+            }
+            else
+            {
+                BaseType_t xRc;
 
-        for( ; ; )
-        {
-            pucDigits[ uxSource ] = ucValue % ( uint8_t ) 10U;
-            ucValue /= ( uint8_t ) 10U;
+                pxSocket->u.xTCP.usTimeout = 0U;
+                xRc = xTCPSocketCheck( pxSocket );
 
-            if( uxSource == 1U )
+                /* Within this function, the socket might want to send a delayed
+                 * ack or send out data or whatever it needs to do. */
+                if( xRc < 0 )
+                {
+                    /* Continue because the socket was deleted. */
+                    continue;
+                }
+            }
+
+            /* In xEventBits the driver may indicate that the socket has
+             * important events for the user.  These are only done just before the
+             * IP-task goes to sleep. */
+            if( pxSocket->xEventBits != 0U )
             {
-                break;
+                if( xWillSleep != pdFALSE )
+                {
+                    /* The IP-task is about to go to sleep, so messages can be
+                     * sent to the socket owners. */
+                    vSocketWakeUpUser( pxSocket );
+                }
+                else
+                {
+                    /* Or else make sure this will be called again to wake-up
+                     * the sockets' owner. */
+                    xShortest = ( TickType_t ) 0;
+                }
             }
 
-            uxSource--;
-        }
-
-        pucDigits[ 0 ] = ucValue;
-
-        /* Skip leading zeros. */
-        for( uxSource = 0; uxSource < ( ( socklen_t ) sockDIGIT_COUNT - ( socklen_t ) 1U ); uxSource++ )
-        {
-            if( pucDigits[ uxSource ] != 0U )
+            if( ( pxSocket->u.xTCP.usTimeout != 0U ) && ( xShortest > ( TickType_t ) pxSocket->u.xTCP.usTimeout ) )
             {
-                break;
+                xShortest = ( TickType_t ) pxSocket->u.xTCP.usTimeout;
             }
         }
 
-        for( ; uxSource < ( socklen_t ) sockDIGIT_COUNT; uxSource++ )
-        {
-            pcBuffer[ uxIndex ] = ( char ) ( pucDigits[ uxSource ] + ( char ) '0' );
-            uxIndex++;
-        }
-
-        if( uxNibble < ( ipSIZE_OF_IPv4_ADDRESS - 1U ) )
-        {
-            pcBuffer[ uxIndex ] = '.';
-        }
-        else
-        {
-            pcBuffer[ uxIndex ] = '\0';
-        }
-
-        uxIndex++;
+        return xShortest;
     }
 
-    return pcResult;
-}
+
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 ) )
+
 /**
- * @brief Convert the dotted decimal format of the IP-address to the 32-bit representation.
+ * @brief Look up a TCP socket in the hash table. A connected socket is found
+ *        in the bucket of its 4-tuple, a listening socket in the bucket of
+ *        its local port.
  *
- * @param[in] xAddressFamily The Address family to which the IP-address belongs to. Only
- *                            FREERTOS_AF_INET (IPv4) is supported.
- * @param[in] pcSource Pointer to the string holding the dotted decimal representation of
- *                      the IP-address.
- * @param[out] pvDestination The pointer to the address struct/variable where the converted
- *                            IP-address will be stored. The buffer must be 4 bytes long
- *                            in case of a IPv4 address.
+ * @param[in] uxLocalPort Local port number.
+ * @param[in] pxRemoteIP Remote (peer) IP address.
+ * @param[in] uxRemotePort Remote (peer) port.
  *
- * @return If all checks pass, then pdPASS is returned or else pdFAIL is returned.
+ * @return The socket which was found, or NULL.
  */
-BaseType_t FreeRTOS_inet_pton( BaseType_t xAddressFamily,
-                               const char * pcSource,
-                               void * pvDestination )
-{
-    BaseType_t xResult;
-
-    /* Printable string to struct sockaddr. */
-    switch( xAddressFamily )
+    static FreeRTOS_Socket_t * prvTCPSocketHashFind( UBaseType_t uxLocalPort,
+                                                     const IPv46_Address_t * pxRemoteIP,
+                                                     UBaseType_t uxRemotePort )
     {
-        #if ( ipconfigUSE_IPv4 != 0 )
-            case FREERTOS_AF_INET:
-                xResult = FreeRTOS_inet_pton4( pcSource, pvDestination );
-                break;
-        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+        FreeRTOS_Socket_t * pxResult = NULL;
+        const List_t * pxBucket;
+        const ListItem_t * pxEnd;
+        const ListItem_t * pxIterator;
+        uint32_t ulHash;
 
-        #if ( ipconfigUSE_IPv6 != 0 )
-            case FREERTOS_AF_INET6:
-                xResult = FreeRTOS_inet_pton6( pcSource, pvDestination );
-                break;
-        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        ulHash = prvSocketHashKey( ( uint32_t ) uxLocalPort,
+                                   ( uint32_t ) uxRemotePort,
+                                   prvSocketHashAddress( pxRemoteIP->xIs_IPv6, &( pxRemoteIP->xIPAddress ) ) );
+        pxBucket = &( xTCPSocketHashTable[ ulHash & socketHASH_MASK ] );
+        pxEnd = listGET_END_MARKER( pxBucket );
 
-        default:
-            xResult = -pdFREERTOS_ERRNO_EAFNOSUPPORT;
-            break;
-    }
+        for( pxIterator = listGET_NEXT( pxEnd );
+             pxIterator != pxEnd;
+             pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
 
-    return xResult;
-}
-/*-----------------------------------------------------------*/
+            if( ( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort ) &&
+                ( pxSocket->u.xTCP.eTCPState != eTCP_LISTEN ) &&
+                ( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort ) )
+            {
+                if( pxRemoteIP->xIs_IPv6 != pdFALSE )
+                {
+                    #if ( ipconfigUSE_IPv6 != 0 )
+                        pxResult = pxTCPSocketLookup_IPv6( pxSocket, pxRemoteIP );
+                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+                }
+                else if( ( pxSocket->bits.bIsIPv6 == pdFALSE_UNSIGNED ) &&
+                         ( pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 == pxRemoteIP->xIPAddress.ulIP_IPv4 ) )
+                {
+                    pxResult = pxSocket;
+                }
+                else
+                {
+                    /* This 'pxSocket' doesn't match. */
+                }
 
-/**
- * @brief Convert the 32-bit representation of the IP-address to the dotted
- *        decimal format based on the Address Family. (Only FREERTOS_AF_INET
- *        is allowed).
- *
- * @param[in] xAddressFamily The address family of the IP-address.
- * @param[in] pvSource Pointer to the 32-bit representation of IP-address.
- * @param[out] pcDestination The pointer to the character array where the dotted
- *                            decimal address will be stored if every check does pass.
- * @param[in] uxSize Size of the character array. This value makes sure that the code
- *                    doesn't write beyond it's bounds.
- *
- * @return If every check does pass, then the pointer to the pcDestination is returned
- *         holding the dotted decimal format of IP-address. Else, a NULL is returned.
- */
-const char * FreeRTOS_inet_ntop( BaseType_t xAddressFamily,
-                                 const void * pvSource,
-                                 char * pcDestination,
-                                 socklen_t uxSize )
-{
-    const char * pcResult;
+                if( pxResult != NULL )
+                {
+                    break;
+                }
+            }
+        }
 
-    /* Printable struct sockaddr to string. */
-    switch( xAddressFamily )
-    {
-        #if ( ipconfigUSE_IPv4 != 0 )
-            case FREERTOS_AF_INET4:
-                pcResult = FreeRTOS_inet_ntop4( pvSource, pcDestination, uxSize );
-                break;
-        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+        if( pxResult == NULL )
+        {
+            /* No exact match, look for a socket listening to uxLocalPort. */
+            ulHash = prvSocketHashKey( ( uint32_t ) uxLocalPort, 0U, 0U );
+            pxBucket = &( xTCPSocketHashTable[ ulHash & socketHASH_MASK ] );
+            pxEnd = listGET_END_MARKER( pxBucket );
 
-        #if ( ipconfigUSE_IPv6 != 0 )
-            case FREERTOS_AF_INET6:
-                pcResult = FreeRTOS_inet_ntop6( pvSource, pcDestination, uxSize );
-                break;
-        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+            for( pxIterator = listGET_NEXT( pxEnd );
+                 pxIterator != pxEnd;
+                 pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
 
-        default:
-            /* errno should be set to pdFREERTOS_ERRNO_EAFNOSUPPORT. */
-            pcResult = NULL;
-            break;
+                if( ( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort ) &&
+                    ( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN ) )
+                {
+                    #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                        if( prvSocketListenAccepts( pxSocket, pxRemoteIP ) == pdFALSE )
+                        {
+                            continue;
+                        }
+                    #endif
+
+                    pxResult = pxSocket;
+                    break;
+                }
+            }
+        }
+
+        return pxResult;
     }
 
-    return pcResult;
-}
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 ) */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_TCP_REUSEPORT != 0 )
+
 /**
- * @brief Convert an ASCII character to its corresponding hexadecimal value.
- *        Accepted characters are 0-9, a-f, and A-F.
+ * @brief Check if a socket is one of the listening sockets that share a port
+ *        and that accept a connection from the given peer.
  *
- * @param[in] cChar The character to be converted.
+ * @param[in] pxCandidate The socket to be checked.
+ * @param[in] usLocalPort The shared port number.
+ * @param[in] pxRemoteIP The address of the peer.
  *
- * @return The hexadecimal value, between 0 and 15.
- *         When the character is not valid, socketINVALID_HEX_CHAR will be returned.
+ * @return pdTRUE when the socket may handle the connection.
  */
-
-uint8_t ucASCIIToHex( char cChar )
-{
-    char cValue = cChar;
-    uint8_t ucNew;
-
-    if( ( cValue >= '0' ) && ( cValue <= '9' ) )
-    {
-        cValue = ( char ) ( cValue - ( uint8_t ) '0' );
-        /* The value will be between 0 and 9. */
-        ucNew = ( uint8_t ) cValue;
-    }
-    else if( ( cValue >= 'a' ) && ( cValue <= 'f' ) )
-    {
-        cValue = ( char ) ( cValue - ( uint8_t ) 'a' );
-        ucNew = ( uint8_t ) cValue;
-        /* The value will be between 10 and 15. */
-        ucNew = ( uint8_t ) ( ucNew + ( uint8_t ) 10 );
-    }
-    else if( ( cValue >= 'A' ) && ( cValue <= 'F' ) )
-    {
-        cValue = ( char ) ( cValue - ( uint8_t ) 'A' );
-        ucNew = ( uint8_t ) cValue;
-        /* The value will be between 10 and 15. */
-        ucNew = ( uint8_t ) ( ucNew + ( uint8_t ) 10 );
-    }
-    else
+    static BaseType_t prvTCPReusePortCandidate( const FreeRTOS_Socket_t * pxCandidate,
+                                                uint16_t usLocalPort,
+                                                const IPv46_Address_t * pxRemoteIP )
     {
-        /* The character does not represent a valid hex number, return 255. */
-        ucNew = ( uint8_t ) socketINVALID_HEX_CHAR;
-    }
+        BaseType_t xReturn = pdFALSE;
 
-    return ucNew;
-}
+        if( ( pxCandidate->usLocalPort == usLocalPort ) &&
+            ( pxCandidate->u.xTCP.eTCPState == eTCP_LISTEN ) &&
+            ( pxCandidate->u.xTCP.bits.bReusePort != pdFALSE_UNSIGNED ) )
+        {
+            #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                xReturn = prvSocketListenAccepts( pxCandidate, pxRemoteIP );
+            #else
+                ( void ) pxRemoteIP;
+                xReturn = pdTRUE;
+            #endif
+        }
 
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
 /**
- * @brief This function converts a 48-bit MAC address to a human readable string.
+ * @brief Several TCP sockets may listen to the same port when they have all
+ *        set FREERTOS_SO_REUSEPORT.  Choose one of them for a new connection,
+ *        based on a hash of the address and port of the peer, so that the
+ *        connections are spread over the sockets and their owners.
  *
- * @param[in] pucSource A pointer to an array of 6 bytes.
- * @param[out] pcTarget A buffer that is 18 bytes long, it will contain the resulting string.
- * @param[in] cTen Either an 'A' or an 'a'. It determines whether the hex numbers will use
- *                  capital or small letters.
- * @param[in] cSeparator The separator that should appear between the bytes, either ':' or '-'.
+ * @param[in] pxSocket The listening socket found by pxTCPSocketLookup().
+ * @param[in] pxRemoteIP The address of the peer.
+ * @param[in] uxRemotePort The port number of the peer.
+ *
+ * @return The listening socket that will handle the connection.
  */
-void FreeRTOS_EUI48_ntop( const uint8_t * pucSource,
-                          char * pcTarget,
-                          char cTen,
-                          char cSeparator )
-{
-    size_t uxIndex;
-    size_t uxNibble;
-    size_t uxTarget = 0U;
-
-    for( uxIndex = 0U; uxIndex < ipMAC_ADDRESS_LENGTH_BYTES; uxIndex++ )
+    static FreeRTOS_Socket_t * prvTCPSocketSelectReusePort( FreeRTOS_Socket_t * pxSocket,
+                                                            const IPv46_Address_t * pxRemoteIP,
+                                                            UBaseType_t uxRemotePort )
     {
-        uint8_t ucByte = pucSource[ uxIndex ];
+        FreeRTOS_Socket_t * pxResult = pxSocket;
+        FreeRTOS_Socket_t * pxCandidate;
+        uint32_t ulHash = prvSocketReusePortHash( &( pxRemoteIP->xIPAddress ), pxRemoteIP->xIs_IPv6, ( uint16_t ) uxRemotePort );
+        uint32_t ulCount = 0U;
 
-        for( uxNibble = 0; uxNibble < 2U; uxNibble++ )
-        {
-            uint8_t ucNibble;
-            char cResult;
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+        const ListItem_t * pxIterator;
 
-            if( uxNibble == 0U )
-            {
-                ucNibble = ucByte >> 4;
-            }
-            else
-            {
-                ucNibble = ucByte & 0x0FU;
-            }
+        /* This is only done for a new connection, so the list of all TCP
+         * sockets is searched: a socket that started listening may not be in
+         * the expected hash bucket yet.  First count the sockets that share
+         * the port, then take the chosen one. */
+        for( pxIterator = listGET_NEXT( pxEnd ); pxIterator != pxEnd; pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            pxCandidate = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
 
-            if( ucNibble <= 0x09U )
-            {
-                cResult = '0';
-                cResult = ( char ) ( cResult + ucNibble );
-            }
-            else
+            if( prvTCPReusePortCandidate( pxCandidate, pxSocket->usLocalPort, pxRemoteIP ) != pdFALSE )
             {
-                cResult = cTen; /* Either 'a' or 'A' */
-                cResult = ( char ) ( cResult + ucNibble );
-                cResult = ( char ) ( cResult - ( uint8_t ) 10U );
-            }
-
-            pcTarget[ uxTarget ] = cResult;
-            uxTarget++;
-        }
-
-        if( uxIndex == ( ipMAC_ADDRESS_LENGTH_BYTES - 1U ) )
-        {
-            pcTarget[ uxTarget ] = ( char ) 0;
-            uxTarget++;
+                ulCount++;
+            }
         }
-        else
+
+        if( ulCount > 1U )
         {
-            pcTarget[ uxTarget ] = cSeparator;
-            uxTarget++;
+            ulHash %= ulCount;
+
+            for( pxIterator = listGET_NEXT( pxEnd ); pxIterator != pxEnd; pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                pxCandidate = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                if( prvTCPReusePortCandidate( pxCandidate, pxSocket->usLocalPort, pxRemoteIP ) != pdFALSE )
+                {
+                    if( ulHash == 0U )
+                    {
+                        pxResult = pxCandidate;
+                        break;
+                    }
+
+                    ulHash--;
+                }
+            }
         }
+
+        return pxResult;
     }
-}
+
+#endif /* ( ipconfigUSE_TCP_REUSEPORT != 0 ) */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_TCP == 1 )
+
 /**
- * @brief This function converts a human readable string, representing an 48-bit MAC address,
- *        into a 6-byte address. Valid inputs are e.g. "62:48:5:83:A0:b2" and "0-12-34-fe-dc-ba".
+ * @brief As multiple sockets may be bound to the same local port number
+ *        looking up a socket is a little more complex: Both a local port,
+ *        and a remote port and IP address are being used to find a match.
+ *        For a socket in listening mode, the remote port and IP address
+ *        are both 0.
  *
- * @param[in] pcSource The null terminated string to be parsed.
- * @param[out] pucTarget A buffer that is 6 bytes long, it will contain the MAC address.
+ * @param[in] ulLocalIP Local IP address. Ignored for now.
+ * @param[in] uxLocalPort Local port number.
+ * @param[in] xRemoteIP Remote (peer) IP address.
+ * @param[in] uxRemotePort Remote (peer) port.
  *
- * @return pdTRUE in case the string got parsed correctly, otherwise pdFALSE.
+ * @return The socket which was found.
  */
-BaseType_t FreeRTOS_EUI48_pton( const char * pcSource,
-                                uint8_t * pucTarget )
-{
-    BaseType_t xResult = pdFALSE;
-    size_t uxByteNr = 0U;
-    size_t uxSourceIndex;
-    size_t uxNibbleCount = 0U;
-    size_t uxLength = strlen( pcSource );
-    uint32_t uxSum = 0U;
-    uint8_t ucHex;
-    char cChar;
-
-    /* Ignore the following line from branch coverage since the exits from this loop are
-     * covered by break statements. The loop is kept as is to future proof the code against
-     * any changes. LCOV_EXCL_BR_START */
-    for( uxSourceIndex = 0U; uxSourceIndex <= uxLength; uxSourceIndex++ )
-    /* LCOV_EXCL_BR_STOP */
+    FreeRTOS_Socket_t * pxTCPSocketLookup( uint32_t ulLocalIP,
+                                           UBaseType_t uxLocalPort,
+                                           IPv46_Address_t xRemoteIP,
+                                           UBaseType_t uxRemotePort )
     {
-        cChar = pcSource[ uxSourceIndex ];
-        ucHex = ucASCIIToHex( cChar );
+        const ListItem_t * pxIterator;
+        FreeRTOS_Socket_t * pxResult = NULL, * pxListenSocket = NULL;
 
-        if( ucHex != socketINVALID_HEX_CHAR )
-        {
-            /* A valid nibble was found. Shift it into the accumulator. */
-            uxSum = uxSum << 4;
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
 
-            if( uxSum > 0xffU )
-            {
-                /* A hex value was too big. */
-                break;
-            }
+        ( void ) ulLocalIP;
 
-            uxSum |= ucHex;
-            uxNibbleCount++;
-        }
-        else
+        #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+            pxResult = prvTCPSocketHashFind( uxLocalPort, &xRemoteIP, uxRemotePort );
+
+            if( pxResult == NULL )
+        #endif /* ipconfigUSE_SOCKET_HASH_LOOKUP != 0 */
         {
-            if( uxNibbleCount != 2U )
+            for( pxIterator = listGET_NEXT( pxEnd );
+                 pxIterator != pxEnd;
+                 pxIterator = listGET_NEXT( pxIterator ) )
             {
-                /* Each number should have 2 nibbles. */
-                break;
-            }
+                FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
 
-            pucTarget[ uxByteNr ] = ( uint8_t ) uxSum;
-            uxSum = 0U;
-            uxNibbleCount = 0U;
-            uxByteNr++;
+                if( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort )
+                {
+                    if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
+                    {
+                        /* If this is a socket listening to uxLocalPort, remember it
+                         * in case there is no perfect match. */
+                        #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                            if( prvSocketListenAccepts( pxSocket, &( xRemoteIP ) ) != pdFALSE )
+                        #endif
+                        {
+                            pxListenSocket = pxSocket;
+                        }
+                    }
+                    else if( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort )
+                    {
+                        if( xRemoteIP.xIs_IPv6 != pdFALSE )
+                        {
+                            #if ( ipconfigUSE_IPv6 != 0 )
+                                pxResult = pxTCPSocketLookup_IPv6( pxSocket, &xRemoteIP );
+                            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+                        }
+                        else
+                        {
+                            if( pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 == xRemoteIP.xIPAddress.ulIP_IPv4 )
+                            {
+                                /* For sockets not in listening mode, find a match with
+                                 * xLocalPort, ulRemoteIP AND xRemotePort. */
+                                pxResult = pxSocket;
+                            }
+                        }
 
-            if( uxByteNr == ipMAC_ADDRESS_LENGTH_BYTES )
-            {
-                xResult = pdTRUE;
-                break;
+                        if( pxResult != NULL )
+                        {
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        /* This 'pxSocket' doesn't match. */
+                    }
+                }
             }
 
-            if( ( cChar != ':' ) && ( cChar != '-' ) )
+            if( pxResult == NULL )
             {
-                /* Invalid character. */
-                break;
+                /* An exact match was not found, maybe a listening socket was
+                 * found. */
+                pxResult = pxListenSocket;
             }
+
+            #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+                if( pxResult != NULL )
+                {
+                    /* The socket was not in the expected hash bucket, probably
+                     * because its state changed outside the IP-task. Move it,
+                     * so that the next look-up will find it immediately. */
+                    vSocketHashUpdate( pxResult );
+                }
+            #endif /* ipconfigUSE_SOCKET_HASH_LOOKUP != 0 */
         }
+
+        #if ( ipconfigUSE_TCP_REUSEPORT != 0 )
+            if( ( pxResult != NULL ) &&
+                ( pxResult->u.xTCP.eTCPState == eTCP_LISTEN ) &&
+                ( pxResult->u.xTCP.bits.bReusePort != pdFALSE_UNSIGNED ) )
+            {
+                /* The port is shared, spread the new connections. */
+                pxResult = prvTCPSocketSelectReusePort( pxResult, &( xRemoteIP ), uxRemotePort );
+            }
+        #endif
+
+        return pxResult;
     }
 
-    return xResult;
-}
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_IPv4 != 0 )
+#if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Convert the IP address from "w.x.y.z" (dotted decimal) format to the 32-bit format.
+ * @brief For the web server: borrow the circular Rx buffer for inspection.
+ *        HTML driver wants to see if a sequence of 13/10/13/10 is available.
  *
- * @param[in] pcIPAddress The character string pointer holding the IP-address in the "W.X.Y.Z"
- *                         (dotted decimal) format.
+ * @param[in] xSocket The socket whose Rx stream is to be returned.
  *
- * @return The 32-bit representation of IP(v4) address.
+ * @return The Rx stream of the socket if all checks pass, else NULL.
  */
-    uint32_t FreeRTOS_inet_addr( const char * pcIPAddress )
+    const struct xSTREAM_BUFFER * FreeRTOS_get_rx_buf( ConstSocket_t xSocket )
     {
-        uint32_t ulReturn = 0U;
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        const struct xSTREAM_BUFFER * pxReturn = NULL;
 
-        /* inet_pton AF_INET target is a 4-byte 'struct in_addr'. */
-        if( pdFAIL == FreeRTOS_inet_pton4( pcIPAddress, &( ulReturn ) ) )
+
+        /* Confirm that this is a TCP socket before dereferencing structure
+         * member pointers. */
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE )
         {
-            /* Return 0 if translation failed. */
-            ulReturn = 0U;
+            pxReturn = pxSocket->u.xTCP.rxStream;
         }
 
-        return ulReturn;
+        return pxReturn;
     }
-    /*-----------------------------------------------------------*/
-#endif /* ipconfigUSE_IPv4 != 0 ) */
+
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Function to get the local address and IP port of the given socket.
+ * @brief Get direct pointers to all data in the circular receive buffer, as
+ *        at most two regions.  The second region is used when the data wrap
+ *        around the end of the buffer.
  *
- * @param[in] xSocket Socket whose port is to be added to the pxAddress.
- * @param[out] pxAddress Structure in which the IP address and the port number
- *                        is returned.
+ * @param[in] xSocket The socket owning the buffer.
+ * @param[out] pxRegions An array of two regions that will be filled in.
+ *                        Once the data have been used, release them by
+ *                        calling FreeRTOS_recv() with a NULL buffer.
  *
- * @return Size of the freertos_sockaddr structure.
+ * @return The total number of bytes that may be read, or
+ *         -pdFREERTOS_ERRNO_EINVAL when the socket is not a valid TCP socket.
  */
-size_t FreeRTOS_GetLocalAddress( ConstSocket_t xSocket,
-                                 struct freertos_sockaddr * pxAddress )
-{
-    const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-
-    switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
+    BaseType_t FreeRTOS_get_rx_regions( ConstSocket_t xSocket,
+                                        struct xSTREAM_BUFFER_REGION * pxRegions )
     {
-        #if ( ipconfigUSE_IPv4 != 0 )
-            case pdFALSE_UNSIGNED:
-                pxAddress->sin_family = FREERTOS_AF_INET;
-                pxAddress->sin_len = ( uint8_t ) sizeof( *pxAddress );
-                /* IP address of local machine. */
-                pxAddress->sin_address.ulIP_IPv4 = FreeRTOS_htonl( pxSocket->xLocalAddress.ulIP_IPv4 );
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
 
-                /* Local port on this machine. */
-                pxAddress->sin_port = FreeRTOS_htons( pxSocket->usLocalPort );
-                break;
-        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+        ( void ) memset( pxRegions, 0, 2U * sizeof( *pxRegions ) );
 
-        #if ( ipconfigUSE_IPv6 != 0 )
-            case pdTRUE_UNSIGNED:
-                pxAddress->sin_family = FREERTOS_AF_INET6;
-                /* IP address of local machine. */
-                ( void ) memcpy( pxAddress->sin_address.xIP_IPv6.ucBytes, pxSocket->xLocalAddress.xIP_IPv6.ucBytes, sizeof( pxAddress->sin_address.xIP_IPv6.ucBytes ) );
-                /* Local port on this machine. */
-                pxAddress->sin_port = FreeRTOS_htons( pxSocket->usLocalPort );
-                break;
-        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE )
+        {
+            xReturn = 0;
 
-        default:
-            /* MISRA 16.4 Compliance */
-            break;
-    }
+            if( pxSocket->u.xTCP.rxStream != NULL )
+            {
+                xReturn = ( BaseType_t ) uxStreamBufferGetReadRegions( pxSocket->u.xTCP.rxStream, pxRegions );
 
-    return sizeof( *pxAddress );
-}
+                #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+                {
+                    if( pxSocket->u.xTCP.uxRxBufferCount > 0U )
+                    {
+                        /* Part of the data is kept in network buffers: only
+                         * the first contiguous block can be described. */
+                        pxRegions[ 0 ].uxLength = uxTCPRxBufferGetPtr( pxSocket, &( pxRegions[ 0 ].pucData ) );
+                        pxRegions[ 1 ].pucData = NULL;
+                        pxRegions[ 1 ].uxLength = 0U;
+                        xReturn = ( BaseType_t ) pxRegions[ 0 ].uxLength;
+                    }
+                }
+                #endif /* ipconfigTCP_RX_BUFFER_COUNT != 0 */
+            }
+        }
 
+        return xReturn;
+    }
+
+#endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_RECORD_FRAMING != 0 ) )
+
 /**
- * @brief Wake up the user of the given socket through event-groups.
+ * @brief Wait for a complete record in the RX stream of a socket that uses
+ *        FREERTOS_SO_TCP_RECORD, and describe it without copying.  The second
+ *        region is used when the record wraps around the end of the buffer.
  *
- * @param[in] pxSocket The socket whose user is to be woken up.
+ * @param[in] xSocket The socket owning the connection.
+ * @param[out] pxRegions An array of two regions that will be filled in.  Once
+ *                        the record has been used, release it by calling
+ *                        FreeRTOS_recv() with a NULL buffer and the length
+ *                        of the record.
+ * @param[in] xFlags FREERTOS_MSG_DONTWAIT can be used.
+ *
+ * @return The length of the record, 0 when the time-out expired,
+ *         -pdFREERTOS_ERRNO_ENOTCONN when the connection was closed,
+ *         -pdFREERTOS_ERRNO_ENOSPC when the record is longer than the RX
+ *         stream, or -pdFREERTOS_ERRNO_EINVAL when the socket does not use
+ *         record framing or the length field is not valid.
  */
-void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
-{
-/* _HT_ must work this out, now vSocketWakeUpUser will be called for any important
- * event or transition */
-    #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
+    BaseType_t FreeRTOS_recv_record( Socket_t xSocket,
+                                     struct xSTREAM_BUFFER_REGION * pxRegions,
+                                     BaseType_t xFlags )
     {
-        if( pxSocket->pxUserSemaphore != NULL )
-        {
-            ( void ) xSemaphoreGive( pxSocket->pxUserSemaphore );
-        }
-    }
-    #endif /* ipconfigSOCKET_HAS_USER_SEMAPHORE */
+        BaseType_t xReturn;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        EventBits_t xEventBits = ( EventBits_t ) 0U;
 
-    #if ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK == 1 )
-    {
-        if( pxSocket->pxUserWakeCallback != NULL )
+        ( void ) memset( pxRegions, 0, 2U * sizeof( *pxRegions ) );
+
+        if( ( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE ) ||
+            ( pxSocket->u.xTCP.xRecordFraming.ucLengthSize == 0U ) )
         {
-            pxSocket->pxUserWakeCallback( pxSocket );
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
         }
-    }
-    #endif /* ipconfigSOCKET_HAS_USER_WAKE_CALLBACK */
-
-    #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-    {
-        if( pxSocket->pxSocketSet != NULL )
+        else
         {
-            EventBits_t xSelectBits = ( pxSocket->xEventBits >> SOCKET_EVENT_BIT_COUNT ) & ( ( EventBits_t ) eSELECT_ALL );
+            xReturn = prvRecvWait( pxSocket, &( xEventBits ), xFlags, pdTRUE );
 
-            if( xSelectBits != 0U )
+            #if ( ipconfigSUPPORT_SIGNALS != 0 )
+                if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
+                {
+                    xReturn = -pdFREERTOS_ERRNO_EINTR;
+                }
+                else
+            #endif /* ipconfigSUPPORT_SIGNALS */
+
+            if( xReturn > 0 )
             {
-                pxSocket->xSocketBits |= xSelectBits;
-                ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, xSelectBits );
+                size_t uxLength = ( size_t ) xReturn;
+
+                sockSTREAM_ENTER( pxSocket->u.xTCP.ucRxStreamUsers );
+                ( void ) uxStreamBufferGetReadRegions( pxSocket->u.xTCP.rxStream, pxRegions );
+                sockSTREAM_LEAVE( pxSocket->u.xTCP.ucRxStreamUsers );
+
+                /* Only describe the record, not the data that follows it. */
+                if( pxRegions[ 0 ].uxLength >= uxLength )
+                {
+                    pxRegions[ 0 ].uxLength = uxLength;
+                    pxRegions[ 1 ].pucData = NULL;
+                    pxRegions[ 1 ].uxLength = 0U;
+                }
+                else
+                {
+                    pxRegions[ 1 ].uxLength = uxLength - pxRegions[ 0 ].uxLength;
+                }
             }
         }
 
-        pxSocket->xEventBits &= ( EventBits_t ) eSOCKET_ALL;
-    }
-    #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
+        ( void ) xEventBits;
 
-    if( ( pxSocket->xEventGroup != NULL ) && ( pxSocket->xEventBits != 0U ) )
-    {
-        ( void ) xEventGroupSetBits( pxSocket->xEventGroup, pxSocket->xEventBits );
+        return xReturn;
     }
 
-    pxSocket->xEventBits = 0U;
-}
-
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_RECORD_FRAMING != 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
+#if ( ( ipconfigSUPPORT_STATIC_SOCKETS != 0 ) && ( ipconfigUSE_TCP == 1 ) )
 
 /**
- * @brief This define makes it possible for network interfaces to inspect
- *        UDP messages and see if there is any UDP socket bound to a given port
- *        number.  This is probably only useful in systems with a minimum of
- *        RAM and when lots of anonymous broadcast messages come in.
+ * @brief Check stream storage that is provided by the application, and find
+ *        the capacity of a stream that fits in it.
  *
- * @param[in] usPortNr the port number to look for.
+ * @param[in] pucStorage The storage, it must be aligned to a size_t.
+ * @param[in] uxStorageSize The size of the storage in bytes.
  *
- * @return xFound if a socket with the port number is found.
+ * @return The value for 'uxRxStreamSize' or 'uxTxStreamSize', or zero when
+ *         the storage is misaligned or too small.
  */
-    BaseType_t xPortHasUDPSocket( uint16_t usPortNr )
+    static size_t prvStaticStreamPrepare( uint8_t * pucStorage,
+                                          size_t uxStorageSize )
     {
-        BaseType_t xFound = pdFALSE;
+        const size_t uxHeaderSize = sizeof( StreamBuffer_t ) - sizeof( ( ( StreamBuffer_t * ) NULL )->ucArray );
+        size_t uxLength = 0U;
+        size_t uxReturn = 0U;
 
-        vTaskSuspendAll();
+        if( ( ( ( uintptr_t ) pucStorage ) & ( sizeof( size_t ) - 1U ) ) != 0U )
+        {
+            FreeRTOS_debug_printf( ( "FreeRTOS_socket_static: misaligned stream storage\n" ) );
+        }
+        else if( uxStorageSize > uxHeaderSize )
         {
-            if( ( pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) usPortNr ) != NULL ) )
+            uxLength = uxStorageSize - uxHeaderSize;
+
+            #if ( ipconfigSTREAM_BUFFER_POWER_OF_TWO != 0 )
             {
-                xFound = pdTRUE;
+                size_t uxPower = sizeof( size_t );
+
+                while( uxPower <= ( uxLength / 2U ) )
+                {
+                    uxPower <<= 1U;
+                }
+
+                uxLength = ( uxLength >= uxPower ) ? uxPower : 0U;
+            }
+            #else
+            {
+                uxLength &= ~( sizeof( size_t ) - 1U );
             }
+            #endif
+        }
+        else
+        {
+            /* Too small. */
         }
-        ( void ) xTaskResumeAll();
-
-        return xFound;
-    }
 
-#endif /* ipconfigETHERNET_DRIVER_FILTERS_PACKETS */
+        /* uxStreamBufferLength() turns this capacity into the same 'LENGTH',
+         * one element of a stream always stays unused. */
+        if( uxLength > sizeof( size_t ) )
+        {
+            uxReturn = uxLength - 1U;
+        }
 
+        return uxReturn;
+    }
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
-
 /**
- * @brief Check if it makes any sense to wait for a connect event.
+ * @brief Check if a stream of a socket lives in the storage of the application.
  *
- * @param[in] pxSocket The socket trying to connect.
+ * @param[in] pxSocket The TCP socket.
+ * @param[in] pxStream The stream.
  *
- * @return It may return: -EINPROGRESS, -EAGAIN, or 0 for OK.
+ * @return pdTRUE when the stream must not be freed or released.
  */
-    static BaseType_t bMayConnect( FreeRTOS_Socket_t const * pxSocket )
+    static BaseType_t prvTCPStreamIsStatic( const FreeRTOS_Socket_t * pxSocket,
+                                            const StreamBuffer_t * pxStream )
     {
-        BaseType_t xResult;
-
-        eIPTCPState_t eState = pxSocket->u.xTCP.eTCPState;
+        BaseType_t xReturn = pdFALSE;
 
-        switch( eState )
+        if( ( pxStream != NULL ) &&
+            ( ( pxStream == pxSocket->u.xTCP.pxStaticRxStream ) ||
+              ( pxStream == pxSocket->u.xTCP.pxStaticTxStream ) ) )
         {
-            case eCLOSED:
-            case eCLOSE_WAIT:
-                xResult = 0;
-                break;
-
-            case eCONNECT_SYN:
-                xResult = -pdFREERTOS_ERRNO_EINPROGRESS;
-                break;
-
-            case eTCP_LISTEN:
-            case eSYN_FIRST:
-            case eSYN_RECEIVED:
-            case eESTABLISHED:
-            case eFIN_WAIT_1:
-            case eFIN_WAIT_2:
-            case eCLOSING:
-            case eLAST_ACK:
-            case eTIME_WAIT:
-            default:
-                xResult = -pdFREERTOS_ERRNO_EAGAIN;
-                break;
+            xReturn = pdTRUE;
         }
 
-        return xResult;
+        return xReturn;
     }
-
-
-#endif /* ipconfigUSE_TCP */
+#endif /* ( ipconfigSUPPORT_STATIC_SOCKETS != 0 ) && ( ipconfigUSE_TCP == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Called from #FreeRTOS_connect(): make some checks and if allowed,
- *        send a message to the IP-task to start connecting to a remote socket.
+ * @brief Create the stream buffer for the given socket.
  *
- * @param[in] pxSocket The socket attempting to connect to a remote port.
- * @param[in] pxAddress The address the socket is trying to connect to.
+ * @param[in] pxSocket the socket to create the stream for.
+ * @param[in] xIsInputStream Is this input stream? pdTRUE/pdFALSE?
  *
- * @return 0 on successful checks or a negative error code.
+ * @return The stream buffer.
  */
-    static BaseType_t prvTCPConnectStart( FreeRTOS_Socket_t * pxSocket,
-                                          struct freertos_sockaddr const * pxAddress )
+    static StreamBuffer_t * prvTCPCreateStream( FreeRTOS_Socket_t * pxSocket,
+                                                BaseType_t xIsInputStream )
     {
-        BaseType_t xResult = 0;
+        StreamBuffer_t * pxBuffer;
+        size_t uxLength;
+        size_t uxSize;
 
-        if( pxAddress == NULL )
-        {
-            /* NULL address passed to the function. Invalid value. */
-            xResult = -pdFREERTOS_ERRNO_EINVAL;
-        }
-        else if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdFALSE )
-        {
-            /* Not a valid socket or wrong type */
-            xResult = -pdFREERTOS_ERRNO_EBADF;
-        }
-        else if( FreeRTOS_issocketconnected( pxSocket ) > 0 )
-        {
-            /* The socket is already connected. */
-            xResult = -pdFREERTOS_ERRNO_EISCONN;
-        }
-        else if( !socketSOCKET_IS_BOUND( pxSocket ) )
+        /* Now that a stream is created, the maximum size is fixed before
+         * creation, it could still be changed with setsockopt(). */
+        if( xIsInputStream != pdFALSE )
         {
-            /* Bind the socket to the port that the client task will send from.
-             * Non-standard, so the error returned is that returned by bind(). */
-            xResult = FreeRTOS_bind( pxSocket, NULL, 0U );
+            size_t uxLittlePerc = sock20_PERCENT;
+            size_t uxEnoughPerc = sock80_PERCENT;
+            size_t uxSegmentCount = pxSocket->u.xTCP.uxRxStreamSize / pxSocket->u.xTCP.usMSS;
+            static const struct Percent
+            {
+                size_t uxPercLittle, uxPercEnough;
+            }
+            xPercTable[] =
+            {
+                { 0U,  100U }, /* 1 segment. */
+                { 50U, 100U }, /* 2 segments. */
+                { 34U, 100U }, /* 3 segments. */
+                { 25U, 100U }, /* 4 segments. */
+            };
+
+            if( ( uxSegmentCount > 0U ) &&
+                ( uxSegmentCount <= ARRAY_USIZE( xPercTable ) ) )
+            {
+                uxLittlePerc = xPercTable[ uxSegmentCount - 1U ].uxPercLittle;
+                uxEnoughPerc = xPercTable[ uxSegmentCount - 1U ].uxPercEnough;
+            }
+
+            uxLength = pxSocket->u.xTCP.uxRxStreamSize;
+
+            if( pxSocket->u.xTCP.uxLittleSpace == 0U )
+            {
+                pxSocket->u.xTCP.uxLittleSpace = ( uxLittlePerc * pxSocket->u.xTCP.uxRxStreamSize ) / sock100_PERCENT;
+            }
+
+            if( pxSocket->u.xTCP.uxEnoughSpace == 0U )
+            {
+                pxSocket->u.xTCP.uxEnoughSpace = ( uxEnoughPerc * pxSocket->u.xTCP.uxRxStreamSize ) / sock100_PERCENT;
+            }
         }
         else
         {
-            /* The socket is valid, not yet connected, and already bound to a port number. */
+            uxLength = pxSocket->u.xTCP.uxTxStreamSize;
         }
 
-        if( xResult == 0 )
-        {
-            /* Check if it makes any sense to wait for a connect event, this condition
-             * might change while sleeping, so it must be checked within each loop */
-            xResult = bMayConnect( pxSocket ); /* -EINPROGRESS, -EAGAIN, or 0 for OK */
-
-            /* Start the connect procedure, kernel will start working on it */
-            if( xResult == 0 )
-            {
-                pxSocket->u.xTCP.bits.bConnPrepared = pdFALSE;
-                pxSocket->u.xTCP.ucRepCount = 0U;
-
-                switch( pxAddress->sin_family )
-                {
-                    #if ( ipconfigUSE_IPv6 != 0 )
-                        case FREERTOS_AF_INET6:
-                            pxSocket->bits.bIsIPv6 = pdTRUE_UNSIGNED;
-                            FreeRTOS_printf( ( "FreeRTOS_connect: %u to %pip port %u\n",
-                                               pxSocket->usLocalPort, ( void * ) pxAddress->sin_address.xIP_IPv6.ucBytes,
-                                               FreeRTOS_ntohs( pxAddress->sin_port ) ) );
-                            ( void ) memcpy( pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes, pxAddress->sin_address.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
-                            break;
-                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        /* Add an extra 4 (or 8) bytes, and make the length a multiple of
+         * sizeof( size_t ), or a power of 2. */
+        uxLength = uxStreamBufferLength( uxLength );
 
-                    #if ( ipconfigUSE_IPv4 != 0 )
-                        case FREERTOS_AF_INET4:
-                            pxSocket->bits.bIsIPv6 = pdFALSE_UNSIGNED;
-                            FreeRTOS_printf( ( "FreeRTOS_connect: %u to %xip:%u\n",
-                                               pxSocket->usLocalPort, ( unsigned int ) FreeRTOS_ntohl( pxAddress->sin_address.ulIP_IPv4 ), FreeRTOS_ntohs( pxAddress->sin_port ) ) );
-                            pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 = FreeRTOS_ntohl( pxAddress->sin_address.ulIP_IPv4 );
-                            break;
-                    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+        uxSize = ( sizeof( *pxBuffer ) + uxLength ) - sizeof( pxBuffer->ucArray );
+        pxBuffer = NULL;
 
-                    default:
-                        FreeRTOS_debug_printf( ( "FreeRTOS_connect: Undefined sin_family \n" ) );
-                        break;
-                }
+        #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+            /* The storage of the application was checked by FreeRTOS_socket_static(),
+             * it is not charged to the memory budget. */
+            pxBuffer = ( xIsInputStream != pdFALSE ) ? pxSocket->u.xTCP.pxStaticRxStream : pxSocket->u.xTCP.pxStaticTxStream;
 
-                /* Port on remote machine. */
-                pxSocket->u.xTCP.usRemotePort = FreeRTOS_ntohs( pxAddress->sin_port );
+            if( pxBuffer != NULL )
+            {
+                /* The stream is ready for use. */
+            }
+            else
+        #endif /* ipconfigSUPPORT_STATIC_SOCKETS */
 
-                /* (client) internal state: socket wants to send a connect. */
-                vTCPStateChange( pxSocket, eCONNECT_SYN );
+        /* A stream that does not fit in the memory budget is treated as a
+         * failed allocation. */
+        if( xSocketMemoryCharge( uxSize ) == pdPASS )
+        {
+            #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+                /* A buffer released by another socket avoids a heap allocation. */
+                pxBuffer = prvTCPStreamPoolTake( uxLength );
 
-                /* To start an active connect. */
-                pxSocket->u.xTCP.usTimeout = 1U;
+                if( pxBuffer == NULL )
+            #endif
+            {
+                /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
+                /* coverity[misra_c_2012_directive_4_12_violation] */
+                pxBuffer = ( ( StreamBuffer_t * ) pvPortMallocLarge( uxSize ) );
 
-                if( xSendEventToIPTask( eTCPTimerEvent ) != pdPASS )
+                if( pxBuffer != NULL )
                 {
-                    xResult = -pdFREERTOS_ERRNO_ECANCELED;
+                    ipRESOURCE_ALLOC( eResourceStream, uxSize );
                 }
             }
-        }
-
-        return xResult;
-    }
 
+            if( pxBuffer == NULL )
+            {
+                vSocketMemoryRelease( uxSize );
+            }
+        }
 
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
-
-#if ( ipconfigUSE_TCP == 1 )
-
-/**
- * @brief Connect to a remote port.
- *
- * @param[in] xClientSocket The socket initiating the connection.
- * @param[in] pxAddress The address of the remote socket.
- * @param[in] xAddressLength This parameter is not used. It is kept in
- *                   the function signature to adhere to the Berkeley
- *                   sockets standard.
- *
- * @return 0 is returned on a successful connection, else a negative
- *         error code is returned.
- */
-    BaseType_t FreeRTOS_connect( Socket_t xClientSocket,
-                                 const struct freertos_sockaddr * pxAddress,
-                                 socklen_t xAddressLength )
-    {
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xClientSocket;
-        TickType_t xRemainingTime;
-        BaseType_t xTimed = pdFALSE;
-        BaseType_t xResult = -pdFREERTOS_ERRNO_EINVAL;
-        TimeOut_t xTimeOut;
-
-        #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
-            struct freertos_sockaddr xTempAddress;
+        if( pxBuffer == NULL )
+        {
+            FreeRTOS_debug_printf( ( "prvTCPCreateStream: malloc failed\n" ) );
+            pxSocket->u.xTCP.bits.bMallocError = pdTRUE_UNSIGNED;
+            vTCPStateChange( pxSocket, eCLOSE_WAIT );
+        }
+        else
+        {
+            /* Clear the markers of the stream */
+            ( void ) memset( pxBuffer, 0, sizeof( *pxBuffer ) - sizeof( pxBuffer->ucArray ) );
+            pxBuffer->LENGTH = ( size_t ) uxLength;
 
-            if( ( pxAddress != NULL ) && ( pxAddress->sin_family != FREERTOS_AF_INET6 ) && ( pxAddress->sin_family != FREERTOS_AF_INET ) )
+            if( xTCPWindowLoggingLevel != 0 )
             {
-                ( void ) memcpy( &xTempAddress, pxAddress, sizeof( struct freertos_sockaddr ) );
+                FreeRTOS_debug_printf( ( "prvTCPCreateStream: %cxStream created %u bytes (total %u)\n", ( xIsInputStream != 0 ) ? 'R' : 'T', ( unsigned ) uxLength, ( unsigned ) uxSize ) );
+            }
 
-                /* Default to FREERTOS_AF_INET family if either FREERTOS_AF_INET6/FREERTOS_AF_INET
-                 *  is not specified in sin_family, if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled. */
-                xTempAddress.sin_family = FREERTOS_AF_INET;
-                pxAddress = &xTempAddress;
+            if( xIsInputStream != 0 )
+            {
+                iptraceMEM_STATS_CREATE( tcpRX_STREAM_BUFFER, pxBuffer, uxSize );
+                pxSocket->u.xTCP.rxStream = pxBuffer;
             }
-        #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+            else
+            {
+                iptraceMEM_STATS_CREATE( tcpTX_STREAM_BUFFER, pxBuffer, uxSize );
+                pxSocket->u.xTCP.txStream = pxBuffer;
+            }
+        }
 
-        ( void ) xAddressLength;
+        return pxBuffer;
+    }
 
-        xResult = prvTCPConnectStart( pxSocket, pxAddress );
 
-        if( xResult == 0 )
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_AUTO_TUNING != 0 ) )
+
+/**
+ * @brief Switch off auto-tuning for a socket, because the application has
+ *        fixed the size of its streams, or because it will hold pointers
+ *        into a stream.  May be called from any task.
+ *
+ * @param[in] pxSocket The socket.
+ */
+    static void prvTCPAutoTuneDisable( FreeRTOS_Socket_t * pxSocket )
+    {
+        if( pxSocket->u.xTCP.bits.bNoAutoTune == pdFALSE_UNSIGNED )
         {
-            /* And wait for the result */
-            for( ; ; )
+            /* The IP-task writes other bits of the same word. */
+            vTaskSuspendAll();
             {
-                EventBits_t uxEvents;
+                pxSocket->u.xTCP.bits.bNoAutoTune = pdTRUE_UNSIGNED;
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+    /*-----------------------------------------------------------*/
 
-                if( xTimed == pdFALSE )
-                {
-                    /* Only in the first round, check for non-blocking */
-                    xRemainingTime = pxSocket->xReceiveBlockTime;
+/**
+ * @brief Give a stream of a socket a new length.  The contents and the markers
+ *        are kept at the same offsets, so the stream positions that are held by
+ *        the sliding window, the TX references and the RX buffers remain valid.
+ *        That is only possible when the data in the stream has not wrapped
+ *        around, and when all markers fit in the new length.  Called by the
+ *        IP-task, while no API function is accessing the stream.
+ *
+ * @param[in] pxSocket The socket owning the stream.
+ * @param[in] xIsInputStream pdTRUE for the RX stream, pdFALSE for the TX stream.
+ * @param[in] uxStreamSize The new size of the stream.
+ *
+ * @return pdTRUE when the stream has been replaced.
+ */
+    static BaseType_t prvTCPResizeStream( FreeRTOS_Socket_t * pxSocket,
+                                          BaseType_t xIsInputStream,
+                                          size_t uxStreamSize )
+    {
+        StreamBuffer_t * pxOldBuffer = ( xIsInputStream != pdFALSE ) ? pxSocket->u.xTCP.rxStream : pxSocket->u.xTCP.txStream;
+        StreamBuffer_t * pxNewBuffer = NULL;
+        BaseType_t xResult = pdFALSE;
+        size_t uxLength;
+        size_t uxSize;
+        BaseType_t xLinear;
 
-                    if( xRemainingTime == ( TickType_t ) 0 )
-                    {
-                        /* Not yet connected, correct state, non-blocking. */
-                        xResult = -pdFREERTOS_ERRNO_EWOULDBLOCK;
-                        break;
-                    }
+        /* Use the same length and rounding as prvTCPCreateStream(). */
+        uxLength = uxStreamBufferLength( uxStreamSize );
+        uxSize = ( sizeof( *pxNewBuffer ) + uxLength ) - sizeof( pxNewBuffer->ucArray );
 
-                    /* Don't get here a second time. */
-                    xTimed = pdTRUE;
+        /* The data is stored from uxTail up to uxFront.  The TX stream also
+         * uses uxMid, which lies between uxTail and uxHead.  The RX stream does
+         * not use uxMid, it stays zero. */
+        xLinear = ( ( pxOldBuffer->uxTail <= pxOldBuffer->uxHead ) &&
+                    ( pxOldBuffer->uxHead <= pxOldBuffer->uxFront ) &&
+                    ( pxOldBuffer->uxFront < uxLength ) ) ? pdTRUE : pdFALSE;
 
-                    /* Fetch the current time */
-                    vTaskSetTimeOutState( &xTimeOut );
-                }
+        if( ( xIsInputStream == pdFALSE ) &&
+            ( ( pxOldBuffer->uxMid < pxOldBuffer->uxTail ) || ( pxOldBuffer->uxMid > pxOldBuffer->uxHead ) ) )
+        {
+            xLinear = pdFALSE;
+        }
 
-                /* Did it get connected while sleeping ? */
-                xResult = FreeRTOS_issocketconnected( pxSocket );
+        if( ( xLinear != pdFALSE ) && ( pxSocket->u.xTCP.pxRetiredStream == NULL ) &&
+            ( xSocketMemoryCharge( uxSize ) == pdPASS ) )
+        {
+            /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
+            /* coverity[misra_c_2012_directive_4_12_violation] */
+            pxNewBuffer = ( ( StreamBuffer_t * ) pvPortMallocLarge( uxSize ) );
 
-                /* Returns positive when connected, negative means an error */
-                if( xResult < 0 )
-                {
-                    /* Return the error */
-                    break;
-                }
+            if( pxNewBuffer != NULL )
+            {
+                ipRESOURCE_ALLOC( eResourceStream, uxSize );
+            }
+            else
+            {
+                vSocketMemoryRelease( uxSize );
+            }
+        }
 
-                if( xResult > 0 )
-                {
-                    /* Socket now connected, return a zero */
-                    xResult = 0;
-                    break;
-                }
+        if( pxNewBuffer != NULL )
+        {
+            ( void ) memcpy( pxNewBuffer, pxOldBuffer, sizeof( *pxNewBuffer ) - sizeof( pxNewBuffer->ucArray ) );
+            pxNewBuffer->LENGTH = uxLength;
+            ( void ) memcpy( &( pxNewBuffer->ucArray[ pxOldBuffer->uxTail ] ),
+                             &( pxOldBuffer->ucArray[ pxOldBuffer->uxTail ] ),
+                             pxOldBuffer->uxFront - pxOldBuffer->uxTail );
 
-                /* Is it allowed to sleep more? */
-                if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
-                {
-                    xResult = -pdFREERTOS_ERRNO_ETIMEDOUT;
-                    break;
-                }
+            /* An API function that has just read the stream pointer may still be
+             * looking at the markers of the old stream, so it is freed later. */
+            pxSocket->u.xTCP.pxRetiredStream = pxOldBuffer;
 
-                /* Go sleeping until we get any down-stream event */
-                uxEvents = xEventGroupWaitBits( pxSocket->xEventGroup,
-                                                ( EventBits_t ) eSOCKET_CONNECT | ( EventBits_t ) eSOCKET_CLOSED,
-                                                pdTRUE /*xClearOnExit*/,
-                                                pdFALSE /*xWaitAllBits*/,
-                                                xRemainingTime );
+            if( xIsInputStream != pdFALSE )
+            {
+                iptraceMEM_STATS_CREATE( tcpRX_STREAM_BUFFER, pxNewBuffer, uxSize );
+                pxSocket->u.xTCP.rxStream = pxNewBuffer;
+                pxSocket->u.xTCP.uxRxStreamSize = uxStreamSize;
+            }
+            else
+            {
+                iptraceMEM_STATS_CREATE( tcpTX_STREAM_BUFFER, pxNewBuffer, uxSize );
+                pxSocket->u.xTCP.txStream = pxNewBuffer;
+                pxSocket->u.xTCP.uxTxStreamSize = uxStreamSize;
+            }
 
-                if( ( uxEvents & ( EventBits_t ) eSOCKET_CLOSED ) != 0U )
-                {
-                    xResult = -pdFREERTOS_ERRNO_ENOTCONN;
-                    FreeRTOS_debug_printf( ( "FreeRTOS_connect() stopped due to an error\n" ) );
-                    break;
-                }
+            if( xTCPWindowLoggingLevel != 0 )
+            {
+                FreeRTOS_debug_printf( ( "prvTCPResizeStream: %cxStream resized to %u bytes\n", ( xIsInputStream != 0 ) ? 'R' : 'T', ( unsigned ) uxLength ) );
             }
+
+            xResult = pdTRUE;
         }
 
         return xResult;
     }
-
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
-
-#if ( ipconfigUSE_TCP == 1 )
+    /*-----------------------------------------------------------*/
 
 /**
- * @brief Check if a new connection has come in for a socket in listen mode.
+ * @brief Decide on the new size of a stream, after measuring how many bytes
+ *        were transferred in one round-trip, and apply it.
  *
- * @param[in] pxParentSocket  The parent socket, which is in listening mode.
- * @param[out] pxAddress  The address of the peer will be filled in 'pxAddress'.
- * @param[in] pxAddressLength  The actual size of the space pointed to by 'pxAddress'.
- * @return A new connected socket or NULL.
+ * @param[in] pxSocket The socket owning the stream.
+ * @param[in] xIsInputStream pdTRUE for the RX stream, pdFALSE for the TX stream.
+ * @param[in] ulCount The number of bytes transferred in one round-trip.
  */
-    static FreeRTOS_Socket_t * prvAcceptWaitClient( FreeRTOS_Socket_t * pxParentSocket,
-                                                    struct freertos_sockaddr * pxAddress,
-                                                    socklen_t * pxAddressLength )
+    static void prvTCPAutoTuneStream( FreeRTOS_Socket_t * pxSocket,
+                                      BaseType_t xIsInputStream,
+                                      uint32_t ulCount )
     {
-        FreeRTOS_Socket_t * pxClientSocket = NULL;
+        IPTCPSocket_t * pxTCP = &( pxSocket->u.xTCP );
+        uint32_t ulMSS = ( uint32_t ) pxTCP->usMSS;
+        size_t uxSize = ( xIsInputStream != pdFALSE ) ? pxTCP->uxRxStreamSize : pxTCP->uxTxStreamSize;
+        size_t uxBase = ( xIsInputStream != pdFALSE ) ? pxTCP->uxRxStreamBase : pxTCP->uxTxStreamBase;
+        uint32_t ulWindow = ( xIsInputStream != pdFALSE ) ? pxTCP->xTCPWindow.xSize.ulRxWindowLength : pxTCP->xTCPWindow.xSize.ulTxWindowLength;
+        /* The window should hold twice the amount of one round-trip, and the
+         * stream holds two windows. */
+        size_t uxNewSize = ( size_t ) FreeRTOS_round_up( ulCount, ulMSS ) * 4U;
+        size_t uxMaxSize = ( size_t ) FreeRTOS_round_down( ( uint32_t ) ipconfigTCP_AUTO_TUNING_MAX_LENGTH, ulMSS );
+        size_t uxWinSize;
 
-        /* Is there a new client? */
-        vTaskSuspendAll();
+        if( uxBase == 0U )
         {
-            if( pxParentSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED )
+            uxBase = uxSize;
+        }
+
+        if( ( ulCount * 2U ) >= ulWindow )
+        {
+            /* At least half of the window was transferred: the window limits
+             * the throughput.  Grow, within the limits. */
+            uxNewSize = FreeRTOS_min_size_t( uxNewSize, uxMaxSize );
+
+            if( uxNewSize > uxSize )
             {
-                pxClientSocket = pxParentSocket->u.xTCP.pxPeerSocket;
+                size_t uxAvailable = ( size_t ) ipconfigTCP_AUTO_TUNING_BUDGET - uxTCPAutoTuneTotal;
 
-                if( pxClientSocket != NULL )
+                if( ( uxNewSize - uxSize ) > uxAvailable )
                 {
-                    FreeRTOS_printf( ( "prvAcceptWaitClient: client %p parent %p\n",
-                                       ( void * ) pxClientSocket, ( void * ) pxParentSocket ) );
+                    uxNewSize = uxSize + ( size_t ) FreeRTOS_round_down( ( uint32_t ) uxAvailable, ulMSS );
                 }
             }
             else
             {
-                pxClientSocket = pxParentSocket;
+                uxNewSize = uxSize;
             }
+        }
+        else if( ( xIsInputStream == pdFALSE ) && ( ( ulCount * 4U ) < ulWindow ) && ( uxSize > uxBase ) )
+        {
+            /* A grown TX stream is not used any more.  A RX stream does not
+             * shrink, because the window that was advertised may not shrink. */
+            uxNewSize = FreeRTOS_max_size_t( uxNewSize, uxBase );
+        }
+        else
+        {
+            uxNewSize = uxSize;
+        }
 
-            if( pxClientSocket != NULL )
+        if( ( uxNewSize != uxSize ) && ( prvTCPResizeStream( pxSocket, xIsInputStream, uxNewSize ) != pdFALSE ) )
+        {
+            /* Keep track of the memory that was added to the streams. */
+            uxTCPAutoTuneTotal = ( uxTCPAutoTuneTotal + uxNewSize ) - uxSize;
+
+            /* Use half of the stream for the window, as FreeRTOS_socket() does. */
+            uxWinSize = FreeRTOS_max_size_t( 1U, ( uxNewSize / 2U ) / ( size_t ) ulMSS );
+
+            if( xIsInputStream != pdFALSE )
             {
-                /* Is it still not taken ? */
-                if( pxClientSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED )
-                {
-                    if( pxParentSocket->u.xTCP.pxPeerSocket != NULL )
-                    {
-                        pxParentSocket->u.xTCP.pxPeerSocket = NULL;
-                    }
+                /* The advertised window can not exceed what the scaling factor
+                 * allows. */
+                uint32_t ulMaxWindow = ( uint32_t ) 0xfffcU << pxTCP->ucMyWinScaleFactor;
 
-                    pxClientSocket->u.xTCP.bits.bPassAccept = pdFALSE_UNSIGNED;
+                pxTCP->uxRxStreamBase = uxBase;
+                pxTCP->uxRxWinSize = uxWinSize;
+                pxTCP->xTCPWindow.xSize.ulRxWindowLength = FreeRTOS_min_uint32( ( uint32_t ) ( uxWinSize * ulMSS ), FreeRTOS_round_down( ulMaxWindow, ulMSS ) );
+                pxTCP->bits.bWinChange = pdTRUE_UNSIGNED;
+            }
+            else
+            {
+                /* ulTCPWindowTxGet() makes the TX window smaller after repeated
+                 * retransmissions, respect that when growing. */
+                if( ulWindow == ( uint32_t ) ( pxTCP->uxTxWinSize * ulMSS ) )
+                {
+                    pxTCP->xTCPWindow.xSize.ulTxWindowLength = ( uint32_t ) ( uxWinSize * ulMSS );
                 }
                 else
                 {
-                    pxClientSocket = NULL;
+                    pxTCP->xTCPWindow.xSize.ulTxWindowLength = FreeRTOS_min_uint32( ulWindow, ( uint32_t ) ( uxWinSize * ulMSS ) );
                 }
+
+                pxTCP->uxTxStreamBase = uxBase;
+                pxTCP->uxTxWinSize = uxWinSize;
             }
         }
-        ( void ) xTaskResumeAll();
+    }
+    /*-----------------------------------------------------------*/
 
-        if( pxClientSocket != NULL )
+/**
+ * @brief Measure the number of bytes that a connection transfers in each
+ *        direction during one smoothed round-trip time, and let the streams
+ *        grow or shrink accordingly.  Called by the IP-task after a TCP
+ *        packet was processed.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ */
+    void vTCPAutoTuneCheck( FreeRTOS_Socket_t * pxSocket )
+    {
+        IPTCPSocket_t * pxTCP = &( pxSocket->u.xTCP );
+        TickType_t xNow = xTaskGetTickCount();
+        TickType_t xPeriod = pdMS_TO_TICKS( ( uint32_t ) pxTCP->xTCPWindow.lSRTT );
+        TickType_t xElapsed = xNow - pxTCP->xTuneTime;
+        uint32_t ulRxCount;
+        uint32_t ulTxCount;
+
+        if( xPeriod == 0U )
         {
-            if( pxAddressLength != NULL )
-            {
-                *pxAddressLength = sizeof( struct freertos_sockaddr );
-            }
+            xPeriod = 1U;
+        }
 
-            switch( pxClientSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
+        if( ( pxTCP->bits.bNoAutoTune != pdFALSE_UNSIGNED ) ||
+            ( pxTCP->eTCPState != eESTABLISHED ) ||
+            ( pxTCP->usMSS == 0U ) )
+        {
+            /* Not tuned, or not transferring data. */
+        }
+        else if( pxTCP->bits.bAutoTuneInit == pdFALSE_UNSIGNED )
+        {
+            pxTCP->bits.bAutoTuneInit = pdTRUE_UNSIGNED;
+            pxTCP->ulTuneRxSequence = pxTCP->xTCPWindow.rx.ulCurrentSequenceNumber;
+            pxTCP->ulTuneTxSequence = pxTCP->xTCPWindow.tx.ulCurrentSequenceNumber;
+            pxTCP->xTuneTime = xNow;
+        }
+        else if( xElapsed >= xPeriod )
+        {
+            /* One measurement later, nobody can be using a replaced stream. */
+            if( pxTCP->pxRetiredStream != NULL )
             {
-                #if ( ipconfigUSE_IPv4 != 0 )
-                    case pdFALSE_UNSIGNED:
-
-                        if( pxAddress != NULL )
-                        {
-                            pxAddress->sin_family = FREERTOS_AF_INET4;
-                            /* Copy IP-address and port number. */
-                            pxAddress->sin_address.ulIP_IPv4 = FreeRTOS_ntohl( pxClientSocket->u.xTCP.xRemoteIP.ulIP_IPv4 );
-                            pxAddress->sin_port = FreeRTOS_ntohs( pxClientSocket->u.xTCP.usRemotePort );
-                        }
-                        break;
-                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+                iptraceMEM_STATS_DELETE( pxTCP->pxRetiredStream );
+                ipRESOURCE_FREE( eResourceStream, sockSTREAM_HEAP_SIZE( pxTCP->pxRetiredStream ) );
+                vSocketMemoryRelease( sockSTREAM_HEAP_SIZE( pxTCP->pxRetiredStream ) );
+                vPortFreeLarge( pxTCP->pxRetiredStream );
+                pxTCP->pxRetiredStream = NULL;
+            }
 
-                #if ( ipconfigUSE_IPv6 != 0 )
-                    case pdTRUE_UNSIGNED:
+            /* The number of bytes that were delivered in order to the RX
+             * stream, and the number of bytes that were acknowledged by the
+             * peer, converted to one round-trip. */
+            ulRxCount = pxTCP->xTCPWindow.rx.ulCurrentSequenceNumber - pxTCP->ulTuneRxSequence;
+            ulTxCount = pxTCP->xTCPWindow.tx.ulCurrentSequenceNumber - pxTCP->ulTuneTxSequence;
+            ulRxCount = ( uint32_t ) ( ( ( uint64_t ) ulRxCount * xPeriod ) / xElapsed );
+            ulTxCount = ( uint32_t ) ( ( ( uint64_t ) ulTxCount * xPeriod ) / xElapsed );
 
-                        if( pxAddress != NULL )
-                        {
-                            pxAddress->sin_family = FREERTOS_AF_INET6;
-                            /* Copy IP-address and port number. */
-                            ( void ) memcpy( pxAddress->sin_address.xIP_IPv6.ucBytes, pxClientSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
-                            pxAddress->sin_port = FreeRTOS_ntohs( pxClientSocket->u.xTCP.usRemotePort );
-                        }
-                        break;
-                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+            /* A stream is not resized while an API function is using it. */
+            if( ( pxTCP->rxStream != NULL ) && ( pxTCP->ucRxStreamUsers == 0U ) )
+            {
+                prvTCPAutoTuneStream( pxSocket, pdTRUE, ulRxCount );
+            }
 
-                default:
-                    /* MISRA 16.4 Compliance */
-                    break;
+            if( ( pxTCP->txStream != NULL ) && ( pxTCP->ucTxStreamUsers == 0U ) )
+            {
+                prvTCPAutoTuneStream( pxSocket, pdFALSE, ulTxCount );
             }
-        }
 
-        return pxClientSocket;
+            pxTCP->ulTuneRxSequence = pxTCP->xTCPWindow.rx.ulCurrentSequenceNumber;
+            pxTCP->ulTuneTxSequence = pxTCP->xTCPWindow.tx.ulCurrentSequenceNumber;
+            pxTCP->xTuneTime = xNow;
+        }
+        else
+        {
+            /* Wait for the end of the measurement. */
+        }
     }
-#endif /* ( ipconfigUSE_TCP == 1 ) */
-/*-----------------------------------------------------------*/
-
-#if ( ipconfigUSE_TCP == 1 )
+    /*-----------------------------------------------------------*/
 
 /**
- * @brief Accept a connection on an listening socket.
- *
- * @param[in] xServerSocket The socket in listening mode.
- * @param[out] pxAddress The address of the machine trying to connect to this node
- *                        is returned in this pointer.
- * @param[out] pxAddressLength The length of the address of the remote machine.
+ * @brief Give back the memory that auto-tuning added to the streams of a
+ *        socket that is being closed.
  *
- * @return FreeRTOS_accept: can return a new connected socket if the server socket
- *         is in listen mode and receives a connection request. The new socket will
- *         be bound already to the same port number as the listening socket.
+ * @param[in] pxSocket The socket being closed.
  */
-    Socket_t FreeRTOS_accept( Socket_t xServerSocket,
-                              struct freertos_sockaddr * pxAddress,
-                              socklen_t * pxAddressLength )
+    static void prvTCPAutoTuneRelease( FreeRTOS_Socket_t * pxSocket )
     {
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xServerSocket;
-        FreeRTOS_Socket_t * pxClientSocket = NULL;
-        TickType_t xRemainingTime;
-        BaseType_t xTimed = pdFALSE;
-        TimeOut_t xTimeOut;
-        IPStackEvent_t xAskEvent;
+        IPTCPSocket_t * pxTCP = &( pxSocket->u.xTCP );
 
-        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
+        if( pxTCP->uxRxStreamBase != 0U )
         {
-            /* Not a valid socket or wrong type */
-
-            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
-            /* coverity[misra_c_2012_rule_11_4_violation] */
-            pxClientSocket = FREERTOS_INVALID_SOCKET;
+            uxTCPAutoTuneTotal -= pxTCP->uxRxStreamSize - pxTCP->uxRxStreamBase;
         }
-        else if( ( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED ) &&
-                 ( pxSocket->u.xTCP.eTCPState != eTCP_LISTEN ) )
-        {
-            /* Parent socket is not in listening mode */
 
-            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
-            /* coverity[misra_c_2012_rule_11_4_violation] */
-            pxClientSocket = FREERTOS_INVALID_SOCKET;
+        if( pxTCP->uxTxStreamBase != 0U )
+        {
+            uxTCPAutoTuneTotal -= pxTCP->uxTxStreamSize - pxTCP->uxTxStreamBase;
         }
-        else
+
+        if( pxTCP->pxRetiredStream != NULL )
         {
-            /* Loop will stop with breaks. */
-            for( ; ; )
-            {
-                pxClientSocket = prvAcceptWaitClient( pxSocket, pxAddress, pxAddressLength );
+            iptraceMEM_STATS_DELETE( pxTCP->pxRetiredStream );
+            ipRESOURCE_FREE( eResourceStream, sockSTREAM_HEAP_SIZE( pxTCP->pxRetiredStream ) );
+            vSocketMemoryRelease( sockSTREAM_HEAP_SIZE( pxTCP->pxRetiredStream ) );
+            vPortFreeLarge( pxTCP->pxRetiredStream );
+            pxTCP->pxRetiredStream = NULL;
+        }
+    }
 
-                if( pxClientSocket != NULL )
-                {
-                    if( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED )
-                    {
-                        /* Ask to set an event in 'xEventGroup' as soon as a new
-                         * client gets connected for this listening socket. */
-                        xAskEvent.eEventType = eTCPAcceptEvent;
-                        xAskEvent.pvData = pxSocket;
-                        ( void ) xSendEventStructToIPTask( &xAskEvent, portMAX_DELAY );
-                    }
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_AUTO_TUNING != 0 ) */
+/*-----------------------------------------------------------*/
 
-                    break;
-                }
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_STREAM_RELEASE_TIME != 0 ) )
 
-                if( xTimed == pdFALSE )
+/**
+ * @brief Take a stream buffer from the pool of released buffers.
+ *
+ * @param[in] uxLength The length of the buffer's array.
+ *
+ * @return A buffer with the requested length, or NULL when the pool has none.
+ */
+    static StreamBuffer_t * prvTCPStreamPoolTake( size_t uxLength )
+    {
+        StreamBuffer_t * pxReturn = NULL;
+        UBaseType_t uxIndex;
+
+        /* An API function may create a stream while the IP-task fills the pool. */
+        vTaskSuspendAll();
+        {
+            /* Take the most recently released buffer, the oldest ones are
+             * the first to go back to the heap. */
+            for( uxIndex = uxTCPStreamPoolCount; uxIndex > 0U; uxIndex-- )
+            {
+                if( xTCPStreamPool[ uxIndex - 1U ].pxStream->LENGTH == uxLength )
                 {
-                    /* Only in the first round, check for non-blocking */
-                    xRemainingTime = pxSocket->xReceiveBlockTime;
+                    pxReturn = xTCPStreamPool[ uxIndex - 1U ].pxStream;
 
-                    if( xRemainingTime == ( TickType_t ) 0 )
+                    for( ; uxIndex < uxTCPStreamPoolCount; uxIndex++ )
                     {
-                        break;
+                        xTCPStreamPool[ uxIndex - 1U ] = xTCPStreamPool[ uxIndex ];
                     }
 
-                    /* Don't get here a second time */
-                    xTimed = pdTRUE;
-
-                    /* Fetch the current time */
-                    vTaskSetTimeOutState( &xTimeOut );
-                }
-
-                /* Has the timeout been reached? */
-                if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
-                {
+                    uxTCPStreamPoolCount--;
                     break;
                 }
-
-                /* Put the calling task to 'sleep' until a down-stream event is received. */
-                ( void ) xEventGroupWaitBits( pxSocket->xEventGroup,
-                                              ( EventBits_t ) eSOCKET_ACCEPT,
-                                              pdTRUE /*xClearOnExit*/,
-                                              pdFALSE /*xWaitAllBits*/,
-                                              xRemainingTime );
             }
         }
+        ( void ) xTaskResumeAll();
 
-        return pxClientSocket;
+        return pxReturn;
     }
-
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
-
-#if ( ipconfigUSE_TCP == 1 )
+    /*-----------------------------------------------------------*/
 
 /**
- * @brief After all checks have been done in FreeRTOS_recv()
- *        read the data from the stream buffer.
+ * @brief Put a stream buffer that is not used any more in the pool.
  *
- * @param[in] pxSocket The socket owning the connection.
- * @param[out] pvBuffer The buffer to store the incoming data in.
- * @param[in] uxBufferLength The length of the buffer so that the function
- *                            does not do out of bound access.
- * @param[in] xFlags The flags for conveying preference. This routine
- *                    will check for 'FREERTOS_ZERO_COPY and/or'.
+ * @param[in] pxStream The buffer.
  *
- * @return The number of bytes actually received and stored in the pvBuffer.
+ * @return pdTRUE when the buffer is kept, pdFALSE when the pool is full.
  */
-    static BaseType_t prvRecvData( FreeRTOS_Socket_t * pxSocket,
-                                   void * pvBuffer,
-                                   size_t uxBufferLength,
-                                   BaseType_t xFlags )
+    static BaseType_t prvTCPStreamPoolPut( StreamBuffer_t * pxStream )
     {
-        BaseType_t xByteCount;
+        BaseType_t xReturn = pdFALSE;
 
-        if( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_ZERO_COPY ) == 0U )
+        vTaskSuspendAll();
         {
-            BaseType_t xIsPeek = ( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_MSG_PEEK ) != 0U ) ? 1L : 0L;
-
-            xByteCount = ( BaseType_t )
-                         uxStreamBufferGet( pxSocket->u.xTCP.rxStream,
-                                            0U,
-                                            ( uint8_t * ) pvBuffer,
-                                            ( size_t ) uxBufferLength,
-                                            xIsPeek );
-
-            if( pxSocket->u.xTCP.bits.bLowWater != pdFALSE_UNSIGNED )
+            if( uxTCPStreamPoolCount < ( UBaseType_t ) ipconfigTCP_STREAM_POOL_COUNT )
             {
-                /* We had reached the low-water mark, now see if the flag
-                 * can be cleared */
-                size_t uxFrontSpace = uxStreamBufferFrontSpace( pxSocket->u.xTCP.rxStream );
-
-                if( uxFrontSpace >= pxSocket->u.xTCP.uxEnoughSpace )
-                {
-                    pxSocket->u.xTCP.bits.bLowWater = pdFALSE_UNSIGNED;
-                    pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
-                    pxSocket->u.xTCP.usTimeout = 1U; /* because bLowWater is cleared. */
-                    ( void ) xSendEventToIPTask( eTCPTimerEvent );
-                }
+                xTCPStreamPool[ uxTCPStreamPoolCount ].pxStream = pxStream;
+                xTCPStreamPool[ uxTCPStreamPoolCount ].xReleaseTime = xTaskGetTickCount();
+                uxTCPStreamPoolCount++;
+                xReturn = pdTRUE;
             }
         }
-        else
+        ( void ) xTaskResumeAll();
+
+        if( xReturn != pdFALSE )
         {
-            /* Zero-copy reception of data: pvBuffer is a pointer to a pointer. */
-            xByteCount = ( BaseType_t ) uxStreamBufferGetPtr( pxSocket->u.xTCP.rxStream, ( uint8_t ** ) pvBuffer );
+            iptraceMEM_STATS_DELETE( pxStream );
         }
 
-        return xByteCount;
+        return xReturn;
     }
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
-
-#if ( ipconfigUSE_TCP == 1 )
+    /*-----------------------------------------------------------*/
 
 /**
- * @brief After FreeRTOS_recv() has checked the validity of the parameters,
- *        this routine will wait for data to arrive in the stream buffer.
+ * @brief The IP-task may release an idle TX stream between the checks of
+ *        prvTCPSendCheck() and the moment that an API function increments
+ *        ucTxStreamUsers.  Create the stream again in that case.
  *
- * @param[in] pxSocket The socket owning the connection.
- * @param[out] pxEventBits A bit-mask of socket events will be set:
- *             eSOCKET_RECEIVE, eSOCKET_CLOSED, and or eSOCKET_INTR.
- * @param[in] xFlags flags passed by the user, only 'FREERTOS_MSG_DONTWAIT'
- *            is checked in this function.
+ * @param[in] pxSocket The socket, its TX stream is marked as being used.
+ *
+ * @return 1 when the socket has a TX stream, or -pdFREERTOS_ERRNO_ENOMEM.
  */
-    static BaseType_t prvRecvWait( const FreeRTOS_Socket_t * pxSocket,
-                                   EventBits_t * pxEventBits,
-                                   BaseType_t xFlags )
+    static BaseType_t prvTCPRestoreTxStream( FreeRTOS_Socket_t * pxSocket )
     {
-        BaseType_t xByteCount = 0;
-        TickType_t xRemainingTime;
-        BaseType_t xTimed = pdFALSE;
-        TimeOut_t xTimeOut;
-        EventBits_t xEventBits = ( EventBits_t ) 0U;
-
-        if( pxSocket->u.xTCP.rxStream != NULL )
-        {
-            xByteCount = ( BaseType_t ) uxStreamBufferGetSize( pxSocket->u.xTCP.rxStream );
-        }
+        BaseType_t xReturn = 1;
 
-        while( xByteCount == 0 )
+        if( pxSocket->u.xTCP.txStream == NULL )
         {
-            eIPTCPState_t eType = ( eIPTCPState_t ) pxSocket->u.xTCP.eTCPState;
+            ( void ) prvTCPCreateStream( pxSocket, pdFALSE );
 
-            if( ( eType == eCLOSED ) ||
-                ( eType == eCLOSE_WAIT ) || /* (server + client) waiting for a connection termination request from the local user. */
-                ( eType == eCLOSING ) )     /* (server + client) waiting for a connection termination request acknowledgement from the remote TCP. */
+            if( pxSocket->u.xTCP.txStream == NULL )
             {
-                /* Return -ENOTCONN, unless there was a malloc failure. */
-                xByteCount = -pdFREERTOS_ERRNO_ENOTCONN;
-
-                if( pxSocket->u.xTCP.bits.bMallocError != pdFALSE_UNSIGNED )
-                {
-                    /* The no-memory error has priority above the non-connected error.
-                     * Both are fatal and will lead to closing the socket. */
-                    xByteCount = -pdFREERTOS_ERRNO_ENOMEM;
-                }
-
-                break;
+                xReturn = -pdFREERTOS_ERRNO_ENOMEM;
             }
+        }
 
-            if( xTimed == pdFALSE )
-            {
-                /* Only in the first round, check for non-blocking. */
-                xRemainingTime = pxSocket->xReceiveBlockTime;
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
 
-                if( xRemainingTime == ( TickType_t ) 0U )
-                {
-                    #if ( ipconfigSUPPORT_SIGNALS != 0 )
-                    {
-                        /* Just check for the interrupt flag. */
-                        xEventBits = xEventGroupWaitBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_INTR,
-                                                          pdTRUE /*xClearOnExit*/, pdFALSE /*xWaitAllBits*/, socketDONT_BLOCK );
-                    }
-                    #endif /* ipconfigSUPPORT_SIGNALS */
-                    break;
-                }
+/**
+ * @brief The application uses the TX stream directly through
+ *        FreeRTOS_get_tx_head() or FreeRTOS_get_tx_base(), so the IP-task
+ *        will not release it when it is idle.
+ *
+ * @param[in] pxSocket The socket.
+ */
+    static void prvTCPKeepTxStream( FreeRTOS_Socket_t * pxSocket )
+    {
+        if( pxSocket->u.xTCP.bits.bKeepTxStream == pdFALSE_UNSIGNED )
+        {
+            /* The IP-task writes other bits of the same word. */
+            vTaskSuspendAll();
+            {
+                pxSocket->u.xTCP.bits.bKeepTxStream = pdTRUE_UNSIGNED;
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+    /*-----------------------------------------------------------*/
 
-                if( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_MSG_DONTWAIT ) != 0U )
-                {
-                    break;
-                }
+/**
+ * @brief Check whether a stream of a socket is empty and not in use.
+ *
+ * @param[in] pxSocket The socket owning the stream.
+ * @param[in] xIsInputStream pdTRUE for the RX stream, pdFALSE for the TX stream.
+ *
+ * @return pdTRUE when the stream may be released once it stayed idle.
+ */
+    static BaseType_t prvTCPStreamIsIdle( const FreeRTOS_Socket_t * pxSocket,
+                                          BaseType_t xIsInputStream )
+    {
+        const IPTCPSocket_t * pxTCP = &( pxSocket->u.xTCP );
+        const StreamBuffer_t * pxStream;
+        BaseType_t xReturn = pdFALSE;
 
-                /* Don't get here a second time. */
-                xTimed = pdTRUE;
+        if( xIsInputStream != pdFALSE )
+        {
+            pxStream = pxTCP->rxStream;
 
-                /* Fetch the current time. */
-                vTaskSetTimeOutState( &xTimeOut );
+            /* An out-of-order segment is stored beyond uxHead, up to uxFront. */
+            if( ( pxStream != NULL ) &&
+                ( pxTCP->ucRxStreamUsers == 0U ) &&
+                ( pxTCP->bits.bRxBufferChain == pdFALSE_UNSIGNED ) &&
+                ( pxStream->uxTail == pxStream->uxHead ) &&
+                ( pxStream->uxFront == pxStream->uxHead ) )
+            {
+                xReturn = pdTRUE;
             }
+        }
+        else
+        {
+            pxStream = pxTCP->txStream;
 
-            /* Has the timeout been reached? */
-            if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
+            /* All data must be sent and acknowledged. */
+            if( ( pxStream != NULL ) &&
+                ( pxTCP->ucTxStreamUsers == 0U ) &&
+                ( pxTCP->bits.bKeepTxStream == pdFALSE_UNSIGNED ) &&
+                ( pxStream->uxTail == pxStream->uxHead ) &&
+                ( pxStream->uxMid == pxStream->uxHead ) &&
+                ( pxStream->uxFront == pxStream->uxHead ) )
             {
-                break;
+                xReturn = pdTRUE;
             }
 
-            /* Block until there is a down-stream event. */
-            xEventBits = xEventGroupWaitBits( pxSocket->xEventGroup,
-                                              ( EventBits_t ) eSOCKET_RECEIVE | ( EventBits_t ) eSOCKET_CLOSED | ( EventBits_t ) eSOCKET_INTR,
-                                              pdTRUE /*xClearOnExit*/, pdFALSE /*xWaitAllBits*/, xRemainingTime );
-            #if ( ipconfigSUPPORT_SIGNALS != 0 )
+            #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
             {
-                if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
+                if( pxTCP->uxTxReferenceCount != 0U )
                 {
-                    break;
+                    xReturn = pdFALSE;
                 }
             }
-            #else
-            {
-                ( void ) xEventBits;
-            }
-            #endif /* ipconfigSUPPORT_SIGNALS */
+            #endif
+        }
 
-            if( pxSocket->u.xTCP.rxStream != NULL )
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Release the RX or the TX stream of a socket, when it has been idle
+ *        for ipconfigTCP_STREAM_RELEASE_TIME seconds.
+ *
+ * @param[in] pxSocket The socket owning the stream.
+ * @param[in] xIsInputStream pdTRUE for the RX stream, pdFALSE for the TX stream.
+ * @param[in] xNow The current time.
+ */
+    static void prvTCPStreamIdleRelease( FreeRTOS_Socket_t * pxSocket,
+                                         BaseType_t xIsInputStream,
+                                         TickType_t xNow )
+    {
+        IPTCPSocket_t * pxTCP = &( pxSocket->u.xTCP );
+        const TickType_t xReleaseTime = pdMS_TO_TICKS( ipconfigTCP_STREAM_RELEASE_TIME * 1000U );
+        TickType_t * pxIdleTime = ( xIsInputStream != pdFALSE ) ? &( pxTCP->xRxStreamIdleTime ) : &( pxTCP->xTxStreamIdleTime );
+        StreamBuffer_t ** ppxStream = ( xIsInputStream != pdFALSE ) ? &( pxTCP->rxStream ) : &( pxTCP->txStream );
+        BaseType_t xWasIdle = ( xIsInputStream != pdFALSE ) ? ( BaseType_t ) pxTCP->bits.bRxStreamIdle : ( BaseType_t ) pxTCP->bits.bTxStreamIdle;
+        BaseType_t xIsIdle;
+        StreamBuffer_t * pxReleased = NULL;
+
+        /* An API function in another task must see either the stream, or
+         * NULL, while it increments the users counter. */
+        vTaskSuspendAll();
+        {
+            xIsIdle = prvTCPStreamIsIdle( pxSocket, xIsInputStream );
+
+            /* The storage of a static stream is never released. */
+            if( ( xIsIdle != pdFALSE ) &&
+                ( xWasIdle != pdFALSE ) &&
+                ( prvTCPStreamIsStatic( pxSocket, *ppxStream ) == pdFALSE ) &&
+                ( ( xNow - *pxIdleTime ) >= xReleaseTime ) &&
+                ( uxTCPStreamPoolCount < ( UBaseType_t ) ipconfigTCP_STREAM_POOL_COUNT ) )
             {
-                xByteCount = ( BaseType_t ) uxStreamBufferGetSize( pxSocket->u.xTCP.rxStream );
+                pxReleased = *ppxStream;
+                *ppxStream = NULL;
+                xIsIdle = pdFALSE;
             }
-        } /* while( xByteCount == 0 ) */
+        }
+        ( void ) xTaskResumeAll();
 
-        *( pxEventBits ) = xEventBits;
+        if( pxReleased != NULL )
+        {
+            /* Only the IP-task fills the pool, so there is still space.  The
+             * stream size is kept, the stream will be created again with the
+             * same length. */
+            ( void ) prvTCPStreamPoolPut( pxReleased );
+            FreeRTOS_debug_printf( ( "vTCPStreamIdleCheck: %u: %cxStream released\n",
+                                     pxSocket->usLocalPort,
+                                     ( xIsInputStream != pdFALSE ) ? 'R' : 'T' ) );
+        }
+        else if( ( xIsIdle != pdFALSE ) && ( xWasIdle == pdFALSE ) )
+        {
+            /* The stream became idle now. */
+            *pxIdleTime = xNow;
+        }
+        else
+        {
+            /* Nothing changed, or the stream is in use. */
+        }
 
-        return xByteCount;
+        if( xIsInputStream != pdFALSE )
+        {
+            pxTCP->bits.bRxStreamIdle = ( xIsIdle != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+        }
+        else
+        {
+            pxTCP->bits.bTxStreamIdle = ( xIsIdle != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+        }
     }
-/*-----------------------------------------------------------*/
-#endif /* ( ipconfigUSE_TCP == 1 ) */
-
-#if ( ipconfigUSE_TCP == 1 )
+    /*-----------------------------------------------------------*/
 
 /**
- * @brief Read incoming data from a TCP socket. Only after the last
- *        byte has been read, a close error might be returned.
- *
- * @param[in] xSocket The socket owning the connection.
- * @param[out] pvBuffer The buffer to store the incoming data in.
- * @param[in] uxBufferLength The length of the buffer so that the function
- *                            does not do out of bound access.
- * @param[in] xFlags The flags for conveying preference. The values
- *                    FREERTOS_MSG_DONTWAIT, FREERTOS_ZERO_COPY and/or
- *                    FREERTOS_MSG_PEEK can be used.
+ * @brief Release the streams of an established connection that have been
+ *        empty for ipconfigTCP_STREAM_RELEASE_TIME seconds, and give back
+ *        to the heap the buffers that stayed in the pool for that time.
+ *        Called by the IP-task when it has handled a TCP socket.
  *
- * @return The number of bytes actually received and stored in the pvBuffer.
+ * @param[in] pxSocket The socket.
  */
-    BaseType_t FreeRTOS_recv( Socket_t xSocket,
-                              void * pvBuffer,
-                              size_t uxBufferLength,
-                              BaseType_t xFlags )
+    void vTCPStreamIdleCheck( FreeRTOS_Socket_t * pxSocket )
     {
-        BaseType_t xByteCount = 0;
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-        EventBits_t xEventBits = ( EventBits_t ) 0U;
-
-        /* Check if the socket is valid, has type TCP and if it is bound to a
-         * port. */
-        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
-        {
-            xByteCount = -pdFREERTOS_ERRNO_EINVAL;
-        }
-        else if( ( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_ZERO_COPY ) != 0U ) &&
-                 ( pvBuffer == NULL ) )
+        const TickType_t xReleaseTime = pdMS_TO_TICKS( ipconfigTCP_STREAM_RELEASE_TIME * 1000U );
+        TickType_t xNow = xTaskGetTickCount();
+        StreamBuffer_t * pxFreed;
+
+        if( pxSocket->u.xTCP.eTCPState == eESTABLISHED )
         {
-            /* In zero-copy mode, pvBuffer is a pointer to a pointer ( not NULL ). */
-            xByteCount = -pdFREERTOS_ERRNO_EINVAL;
+            prvTCPStreamIdleRelease( pxSocket, pdTRUE, xNow );
+            prvTCPStreamIdleRelease( pxSocket, pdFALSE, xNow );
         }
-        else
+
+        /* A buffer that stayed in the pool for that long is not needed, and
+         * no API function can still be looking at it. */
+        do
         {
-            /* The function parameters have been checked, now wait for incoming data. */
-            xByteCount = prvRecvWait( pxSocket, &( xEventBits ), xFlags );
+            pxFreed = NULL;
 
-            #if ( ipconfigSUPPORT_SIGNALS != 0 )
-                if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
+            vTaskSuspendAll();
+            {
+                if( ( uxTCPStreamPoolCount > 0U ) &&
+                    ( ( xNow - xTCPStreamPool[ 0 ].xReleaseTime ) >= xReleaseTime ) )
                 {
-                    if( ( xEventBits & ( ( EventBits_t ) eSOCKET_RECEIVE | ( EventBits_t ) eSOCKET_CLOSED ) ) != 0U )
+                    UBaseType_t uxIndex;
+
+                    pxFreed = xTCPStreamPool[ 0 ].pxStream;
+
+                    for( uxIndex = 1U; uxIndex < uxTCPStreamPoolCount; uxIndex++ )
                     {
-                        /* Shouldn't have cleared other flags. */
-                        xEventBits &= ~( ( EventBits_t ) eSOCKET_INTR );
-                        ( void ) xEventGroupSetBits( pxSocket->xEventGroup, xEventBits );
+                        xTCPStreamPool[ uxIndex - 1U ] = xTCPStreamPool[ uxIndex ];
                     }
 
-                    xByteCount = -pdFREERTOS_ERRNO_EINTR;
+                    uxTCPStreamPoolCount--;
                 }
-                else
-            #endif /* ipconfigSUPPORT_SIGNALS */
+            }
+            ( void ) xTaskResumeAll();
 
-            if( xByteCount > 0 )
+            if( pxFreed != NULL )
             {
-                /* Get the actual data from the buffer, or in case of zero-copy,
-                 * let *pvBuffer point to the RX-stream of the socket. */
-                xByteCount = prvRecvData( pxSocket, pvBuffer, uxBufferLength, xFlags );
+                ipRESOURCE_FREE( eResourceStream, sockSTREAM_HEAP_SIZE( pxFreed ) );
+                vPortFreeLarge( pxFreed );
             }
-        } /* prvValidSocket() */
-
-        return xByteCount;
+        } while( pxFreed != NULL );
     }
 
-
-#endif /* ipconfigUSE_TCP */
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_STREAM_RELEASE_TIME != 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
+#if ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_CALLBACKS == 1 )
 
 /**
- * @brief Called from FreeRTOS_send(): some checks which will be done before
- *        sending a TCP packed.
- *
- * @param[in] pxSocket The socket owning the connection.
- * @param[in] uxDataLength The length of the data to be sent.
- *
- * @return 0: representing OK, else a negative error code will be returned.
+ * @brief The application can attach callback functions to a socket. In this function,
+ *        called by lTCPAddRxdata(), the TCP reception handler will be called.
+ * @param[in] pxSocket The socket which has received TCP data.
+ * @param[in] pcData The actual data received.
+ * @param[in] ulByteCount The number of bytes that were received.
  */
-    static int32_t prvTCPSendCheck( FreeRTOS_Socket_t * pxSocket,
-                                    size_t uxDataLength )
+    static void vTCPAddRxdata_Callback( FreeRTOS_Socket_t * pxSocket,
+                                        const uint8_t * pcData,
+                                        uint32_t ulByteCount )
     {
-        int32_t xResult = 1;
+        const uint8_t * pucBuffer = pcData;
 
-        /* Is this a socket of type TCP and is it already bound to a port number ? */
-        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
-        {
-            xResult = -pdFREERTOS_ERRNO_EINVAL;
-        }
-        else if( pxSocket->u.xTCP.bits.bMallocError != pdFALSE_UNSIGNED )
-        {
-            xResult = -pdFREERTOS_ERRNO_ENOMEM;
-        }
-        else if( ( pxSocket->u.xTCP.eTCPState == eCLOSED ) ||
-                 ( pxSocket->u.xTCP.eTCPState == eCLOSE_WAIT ) ||
-                 ( pxSocket->u.xTCP.eTCPState == eCLOSING ) )
-        {
-            xResult = -pdFREERTOS_ERRNO_ENOTCONN;
-        }
-        else if( pxSocket->u.xTCP.bits.bFinSent != pdFALSE_UNSIGNED )
-        {
-            /* This TCP connection is closing already, the FIN flag has been sent.
-             * Maybe it is still delivering or receiving data.
-             * Return OK in order not to get closed/deleted too quickly */
-            xResult = 0;
-        }
-        else if( uxDataLength == 0U )
-        {
-            /* send() is being called to send zero bytes */
-            xResult = 0;
-        }
-        else if( pxSocket->u.xTCP.txStream == NULL )
+        /* The socket owner has installed an OnReceive handler. Pass the
+         * Rx data, without copying from the rxStream, to the user. */
+        for( ; ; )
         {
-            /* Create the outgoing stream only when it is needed */
-            ( void ) prvTCPCreateStream( pxSocket, pdFALSE );
+            uint8_t * ucReadPtr = NULL;
+            uint32_t ulCount;
 
-            if( pxSocket->u.xTCP.txStream == NULL )
+            if( pucBuffer != NULL )
             {
-                xResult = -pdFREERTOS_ERRNO_ENOMEM;
+                ucReadPtr = ( uint8_t * ) pucBuffer;
+                ulCount = ulByteCount;
+                pucBuffer = NULL;
+            }
+            else
+            {
+                ulCount = ( uint32_t ) uxStreamBufferGetPtr( pxSocket->u.xTCP.rxStream, &( ucReadPtr ) );
             }
-        }
-        else
-        {
-            /* Nothing. */
-        }
 
-        return xResult;
-    }
+            if( ulCount == 0U )
+            {
+                break;
+            }
 
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
+            /* For advanced users only: here a pointer to the RX-stream of a socket
+             * is passed to an application hook. */
+            ( void ) pxSocket->u.xTCP.pxHandleReceive( pxSocket, ucReadPtr, ( size_t ) ulCount );
+            /* Forward the tail in the RX stream. */
+            ( void ) uxStreamBufferGet( pxSocket->u.xTCP.rxStream, 0U, NULL, ( size_t ) ulCount, pdFALSE );
+        }
+    }
+#endif /* #if ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_CALLBACKS == 1 ) */
 
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Get a direct pointer to the beginning of the circular transmit buffer.
- *
- * @param[in] xSocket The socket owning the buffer.
- *
- * @return Address the first byte in the circular transmit buffer if all checks pass.
- *         Or else, NULL is returned.
+ * @brief Called by lTCPAddRxdata(), the received data has just been added to the
+ *        RX-stream. When the space is dropped below a threshold, it may set the
+ *        bit field 'bLowWater'. Also the socket's events bits for READ will be set.
+ * @param[in] pxSocket the socket that has received new data.
  */
-    uint8_t * FreeRTOS_get_tx_base( Socket_t xSocket )
+    static void vTCPAddRxdata_Stored( FreeRTOS_Socket_t * pxSocket )
     {
-        uint8_t * pucReturn = NULL;
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-
-        /* Confirm that this is a TCP socket before dereferencing structure
-         * member pointers. */
-        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE )
+        /* See if running out of space. */
+        if( pxSocket->u.xTCP.bits.bLowWater == pdFALSE_UNSIGNED )
         {
-            StreamBuffer_t * pxBuffer = pxSocket->u.xTCP.txStream;
+            size_t uxFrontSpace = uxStreamBufferFrontSpace( pxSocket->u.xTCP.rxStream );
 
-            /* If the TX buffer hasn't been created yet,
-             * and if no malloc error has occurred on this socket yet. */
-            if( ( pxBuffer == NULL ) &&
-                ( pxSocket->u.xTCP.bits.bMallocError == pdFALSE_UNSIGNED ) )
+            if( uxFrontSpace <= pxSocket->u.xTCP.uxLittleSpace )
             {
-                /* Create the outgoing stream only when it is needed */
-                ( void ) prvTCPCreateStream( pxSocket, pdFALSE );
-                pxBuffer = pxSocket->u.xTCP.txStream;
+                pxSocket->u.xTCP.bits.bLowWater = pdTRUE_UNSIGNED;
+                pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
+
+                /* bLowWater was reached, send the changed window size. */
+                pxSocket->u.xTCP.usTimeout = 1U;
+                vTCPTimerWheelRequest( pxSocket );
+                ( void ) xSendEventToIPTask( eTCPTimerEvent );
             }
+        }
 
-            if( pxBuffer != NULL )
+        /* New incoming data is available, wake up the user.   User's
+         * semaphores will be set just before the IP-task goes asleep. */
+        if( sockRECORD_READABLE( pxSocket ) )
+        {
+            pxSocket->xEventBits |= ( EventBits_t ) eSOCKET_RECEIVE;
+
+            #if ipconfigSUPPORT_SELECT_FUNCTION == 1
             {
-                pucReturn = pxBuffer->ucArray;
+                if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != 0U )
+                {
+                    pxSocket->xEventBits |= ( ( ( EventBits_t ) eSELECT_READ ) << SOCKET_EVENT_BIT_COUNT );
+                }
             }
+            #endif
         }
-
-        return pucReturn;
     }
 #endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
 
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Get a direct pointer to the TX head of the circular transmit buffer.
+ * @brief Add data to the RxStream. When uxOffset > 0, data has come in out-of-order
+ *        and will be put in front of the head so it can not be popped by the user.
  *
- * @param[in] xSocket The socket owning the buffer.
- * @param[in] pxLength This will contain the number of bytes that may be written.
+ * @param[in] pxSocket The socket to whose RxStream data is to be added.
+ * @param[in] uxOffset Offset of the packet.
+ * @param[in] pcData The data to be added to the RxStream.
+ * @param[in] ulByteCount Number of bytes in the data.
  *
- * @return Head of the circular transmit buffer if all checks pass. Or else, NULL
- *         is returned.
+ * @return The number of bytes actually added to the RxStream. Or else, a negative
+ *         error code is returned.
  */
-    uint8_t * FreeRTOS_get_tx_head( Socket_t xSocket,
-                                    BaseType_t * pxLength )
+    int32_t lTCPAddRxdata( FreeRTOS_Socket_t * pxSocket,
+                           size_t uxOffset,
+                           const uint8_t * pcData,
+                           uint32_t ulByteCount )
     {
-        uint8_t * pucReturn = NULL;
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-        StreamBuffer_t * pxBuffer = NULL;
+        StreamBuffer_t * pxStream = pxSocket->u.xTCP.rxStream;
+        int32_t xResult = 0;
 
-        *pxLength = 0;
+        #if ( ipconfigUSE_CALLBACKS == 1 )
+            BaseType_t bHasHandler = ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xTCP.pxHandleReceive ) ? pdTRUE : pdFALSE;
+            const uint8_t * pucBuffer = NULL;
+        #endif /* ipconfigUSE_CALLBACKS */
 
-        /* Confirm that this is a TCP socket before dereferencing structure
-         * member pointers. */
-        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE )
+        #if ( ( ipconfigUSE_CALLBACKS == 1 ) && ( ipconfigUSE_TCP_SPLICE != 0 ) )
         {
-            pxBuffer = pxSocket->u.xTCP.txStream;
+            if( pxSocket->u.xTCP.pxSpliceTarget != NULL )
+            {
+                /* Spliced data must be stored, it is not passed to the handler. */
+                bHasHandler = pdFALSE;
+            }
+        }
+        #endif
 
-            /* If the TX buffer hasn't been created yet,
-             * and if no malloc error has occurred on this socket yet. */
-            if( ( pxBuffer == NULL ) &&
-                ( pxSocket->u.xTCP.bits.bMallocError == pdFALSE_UNSIGNED ) )
+        /* int32_t uxStreamBufferAdd( pxBuffer, uxOffset, pucData, aCount )
+         * if( pucData != NULL ) copy data the the buffer
+         * if( pucData == NULL ) no copying, just advance rxHead
+         * if( uxOffset != 0 ) Just store data which has come out-of-order
+         * if( uxOffset == 0 ) Also advance rxHead */
+        if( pxStream == NULL )
+        {
+            pxStream = prvTCPCreateStream( pxSocket, pdTRUE );
+
+            if( pxStream == NULL )
             {
-                /* Create the outgoing stream only when it is needed */
-                ( void ) prvTCPCreateStream( pxSocket, pdFALSE );
-                pxBuffer = pxSocket->u.xTCP.txStream;
+                xResult = -1;
             }
+        }
 
-            if( pxBuffer != NULL )
+        if( xResult >= 0 )
+        {
+            #if ( ipconfigUSE_CALLBACKS == 1 )
             {
-                size_t uxSpace = uxStreamBufferGetSpace( pxBuffer );
-                size_t uxRemain = pxBuffer->LENGTH - pxBuffer->uxHead;
+                if( ( bHasHandler != pdFALSE ) && ( uxStreamBufferGetSize( pxStream ) == 0U ) && ( uxOffset == 0U ) && ( pcData != NULL ) )
+                {
+                    /* Data can be passed directly to the user because there is
+                     * no data in the RX-stream, it the new data must be stored
+                     * at offset zero, and a buffer 'pcData' is provided.
+                     */
+                    pucBuffer = pcData;
 
-                if( uxRemain <= uxSpace )
+                    /* Zero-copy for call-back: no need to add the bytes to the
+                     * stream, only the pointer will be advanced by uxStreamBufferAdd(). */
+                    pcData = NULL;
+                }
+            }
+            #endif /* ipconfigUSE_CALLBACKS */
+
+            xResult = ( int32_t ) uxStreamBufferAdd( pxStream, uxOffset, pcData, ( size_t ) ulByteCount );
+
+            #if ( ipconfigHAS_DEBUG_PRINTF != 0 )
+            {
+                if( xResult != ( int32_t ) ulByteCount )
                 {
-                    *pxLength = ( BaseType_t ) uxRemain;
+                    FreeRTOS_debug_printf( ( "lTCPAddRxdata: at %u: %d/%u bytes (tail %u head %u space %u front %u)\n",
+                                             ( unsigned int ) uxOffset,
+                                             ( int ) xResult,
+                                             ( unsigned int ) ulByteCount,
+                                             ( unsigned int ) pxStream->uxTail,
+                                             ( unsigned int ) pxStream->uxHead,
+                                             ( unsigned int ) uxStreamBufferFrontSpace( pxStream ),
+                                             ( unsigned int ) pxStream->uxFront ) );
                 }
-                else
+            }
+            #endif /* ipconfigHAS_DEBUG_PRINTF */
+
+            if( uxOffset == 0U )
+            {
+                /* Data is being added to rxStream at the head (offs = 0) */
+                #if ( ipconfigUSE_TCP_SPLICE != 0 )
+                    if( pxSocket->u.xTCP.pxSpliceTarget != NULL )
+                    {
+                        vTCPSpliceTransfer( pxSocket );
+                    }
+                    else
+                #endif /* ipconfigUSE_TCP_SPLICE */
+                #if ( ipconfigUSE_CALLBACKS == 1 )
+                    if( bHasHandler != pdFALSE )
+                    {
+                        vTCPAddRxdata_Callback( pxSocket, pucBuffer, ulByteCount );
+                    }
+                    else
+                #endif /* ipconfigUSE_CALLBACKS */
                 {
-                    *pxLength = ( BaseType_t ) uxSpace;
+                    vTCPAddRxdata_Stored( pxSocket );
                 }
-
-                pucReturn = &( pxBuffer->ucArray[ pxBuffer->uxHead ] );
             }
         }
 
-        return pucReturn;
+        return xResult;
     }
+
+
 #endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_SPLICE != 0 ) )
 
 /**
- * @brief This internal function will try to send as many bytes as possible to a TCP-socket.
- *
- * @param[in] pxSocket  The socket owning the connection.
- * @param[in] pvBuffer  The buffer containing the data to be sent.
- * @param[in] uxDataLength  The number of bytes contained in the buffer.
- * @param[in] xFlags  Only the flag 'FREERTOS_MSG_DONTWAIT' will be tested.
+ * @brief Move the received data of a spliced socket to the txStream of its
+ *        target.  The data is copied once, from rxStream or from a network
+ *        buffer kept by the socket.  The bytes that do not fit stay in
+ *        rxStream, so the reception window of the source follows the space
+ *        in the txStream of the target.
  *
- * @result The number of bytes queued for transmission.
+ * @param[in] pxSource The socket whose received data is moved.
  */
-    static BaseType_t prvTCPSendLoop( FreeRTOS_Socket_t * pxSocket,
-                                      const void * pvBuffer,
-                                      size_t uxDataLength,
-                                      BaseType_t xFlags )
+    void vTCPSpliceTransfer( FreeRTOS_Socket_t * pxSource )
     {
-        /* The number of bytes sent. */
-        BaseType_t xBytesSent = 0;
-        /* xBytesLeft is the number of bytes that still must be sent. */
-        BaseType_t xBytesLeft = ( BaseType_t ) uxDataLength;
-        /* xByteCount is number of bytes that can be sent now. */
-        BaseType_t xByteCount = ( BaseType_t ) uxStreamBufferGetSpace( pxSocket->u.xTCP.txStream );
-        TickType_t xRemainingTime;
-        BaseType_t xTimed = pdFALSE;
-        TimeOut_t xTimeOut;
-        const uint8_t * pucSource = ( const uint8_t * ) pvBuffer;
+        FreeRTOS_Socket_t * pxTarget = pxSource->u.xTCP.pxSpliceTarget;
+        StreamBuffer_t * pxRxStream = pxSource->u.xTCP.rxStream;
+        size_t uxMoved = 0U;
+        size_t uxSpace;
+        size_t uxCount;
+        size_t uxFrontSpace;
+        uint8_t * pucData;
+        BaseType_t xWinChange = pdFALSE;
 
-        /* While there are still bytes to be sent. */
-        while( xBytesLeft > 0 )
+        if( ( pxTarget != NULL ) &&
+            ( pxRxStream != NULL ) &&
+            ( ( pxTarget->u.xTCP.eTCPState == eESTABLISHED ) || ( pxTarget->u.xTCP.eTCPState == eCLOSE_WAIT ) ) )
         {
-            /* If txStream has space. */
-            if( xByteCount > 0 )
+            if( pxTarget->u.xTCP.txStream == NULL )
             {
-                BaseType_t xCloseAfterSend = pdFALSE;
-
-                /* Don't send more than necessary. */
-                if( xByteCount > xBytesLeft )
-                {
-                    xByteCount = xBytesLeft;
-                }
-
-                if( ( pxSocket->u.xTCP.bits.bCloseAfterSend != pdFALSE_UNSIGNED ) &&
-                    ( xByteCount == xBytesLeft ) )
-                {
-                    xCloseAfterSend = pdTRUE;
-
-                    /* Now suspend the scheduler: sending the last data and
-                     * setting bCloseRequested must be done together */
-                    vTaskSuspendAll();
-                    pxSocket->u.xTCP.bits.bCloseRequested = pdTRUE_UNSIGNED;
-
-                    /* The flag 'bCloseAfterSend' can be set before sending data
-                     * using setsockopt()
-                     *
-                     * When the last data packet is being sent out, a FIN flag will
-                     * be included to let the peer know that no more data is to be
-                     * expected.  The use of 'bCloseAfterSend' is not mandatory, it
-                     * is just a faster way of transferring files (e.g. when using
-                     * FTP). */
-                }
+                ( void ) prvTCPCreateStream( pxTarget, pdFALSE );
+            }
 
-                xByteCount = ( BaseType_t ) uxStreamBufferAdd( pxSocket->u.xTCP.txStream, 0U, pucSource, ( size_t ) xByteCount );
+            if( pxTarget->u.xTCP.txStream != NULL )
+            {
+                uxSpace = uxStreamBufferGetSpace( pxTarget->u.xTCP.txStream );
 
-                if( xCloseAfterSend == pdTRUE )
+                while( uxSpace > 0U )
                 {
-                    /* Now when the IP-task transmits the data, it will also
-                     * see that bCloseRequested is true and include the FIN
-                     * flag to start closure of the connection. */
-                    ( void ) xTaskResumeAll();
-                }
-
-                /* Send a message to the IP-task so it can work on this
-                * socket.  Data is sent, let the IP-task work on it. */
-                pxSocket->u.xTCP.usTimeout = 1U;
+                    /* Take the data in contiguous blocks. */
+                    #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+                        uxCount = uxTCPRxBufferGetPtr( pxSource, &( pucData ) );
+                    #else
+                        uxCount = uxStreamBufferGetPtr( pxRxStream, &( pucData ) );
+                    #endif
+
+                    if( uxCount == 0U )
+                    {
+                        break;
+                    }
 
-                if( xIsCallingFromIPTask() == pdFALSE )
-                {
-                    /* Only send a TCP timer event when not called from the
-                     * IP-task. */
-                    ( void ) xSendEventToIPTask( eTCPTimerEvent );
-                }
+                    uxCount = uxStreamBufferAdd( pxTarget->u.xTCP.txStream, 0U, pucData, FreeRTOS_min_size_t( uxCount, uxSpace ) );
 
-                xBytesLeft -= xByteCount;
-                xBytesSent += xByteCount;
+                    #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+                        ( void ) uxTCPRxBufferGet( pxSource, NULL, uxCount, pdFALSE );
+                    #else
+                        ( void ) uxStreamBufferGet( pxRxStream, 0U, NULL, uxCount, pdFALSE );
+                    #endif
 
-                if( ( xBytesLeft == 0 ) || ( pvBuffer == NULL ) )
-                {
-                    /* pvBuffer can be NULL in case TCP zero-copy transmissions are used. */
-                    break;
+                    uxSpace -= uxCount;
+                    uxMoved += uxCount;
                 }
+            }
 
-                /* As there are still bytes left to be sent, increase the
-                 * data pointer. */
-                pucSource = &( pucSource[ xByteCount ] );
-            } /* if( xByteCount > 0 ) */
-
-            /* Not all bytes have been sent. In case the socket is marked as
-             * blocking sleep for a while. */
-            if( xTimed == pdFALSE )
+            if( uxMoved > 0U )
             {
-                /* Only in the first round, check for non-blocking. */
-                xRemainingTime = pxSocket->xSendBlockTime;
+                /* Let the target send the data. */
+                pxTarget->u.xTCP.usTimeout = 1U;
 
-                if( xIsCallingFromIPTask() != pdFALSE )
+                #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
                 {
-                    /* If this send function is called from within a
-                     * call-back handler it may not block, otherwise
-                     * chances would be big to get a deadlock: the IP-task
-                     * waiting for itself. */
-                    xRemainingTime = ( TickType_t ) 0U;
+                    vTCPTimerWheelSchedule( pxTarget );
                 }
+                #endif
+            }
 
-                if( xRemainingTime == ( TickType_t ) 0U )
-                {
-                    break;
-                }
+            /* Do what FreeRTOS_recv() and vTCPAddRxdata_Stored() do with the
+             * low-water mark: announce the window when it changes a lot. */
+            uxFrontSpace = uxStreamBufferFrontSpace( pxRxStream );
 
-                if( ( ( uint32_t ) xFlags & ( uint32_t ) FREERTOS_MSG_DONTWAIT ) != 0U )
+            if( pxSource->u.xTCP.bits.bLowWater == pdFALSE_UNSIGNED )
+            {
+                if( uxFrontSpace <= pxSource->u.xTCP.uxLittleSpace )
                 {
-                    break;
+                    pxSource->u.xTCP.bits.bLowWater = pdTRUE_UNSIGNED;
+                    xWinChange = pdTRUE;
                 }
-
-                /* Don't get here a second time. */
-                xTimed = pdTRUE;
-
-                /* Fetch the current time. */
-                vTaskSetTimeOutState( &xTimeOut );
             }
-            else
+            else if( uxFrontSpace >= pxSource->u.xTCP.uxEnoughSpace )
             {
-                /* Has the timeout been reached? */
-                if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
-                {
-                    break;
-                }
+                pxSource->u.xTCP.bits.bLowWater = pdFALSE_UNSIGNED;
+                xWinChange = pdTRUE;
             }
-
-            /* Go sleeping until a SEND or a CLOSE event is received. */
-            ( void ) xEventGroupWaitBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_SEND | ( EventBits_t ) eSOCKET_CLOSED,
-                                          pdTRUE /*xClearOnExit*/, pdFALSE /*xWaitAllBits*/, xRemainingTime );
-
-            xByteCount = ( BaseType_t ) prvTCPSendCheck( pxSocket, uxDataLength );
-
-            if( xByteCount < 0 )
+            else
             {
-                /* In a meanwhile, the connection has dropped, stop iterating. */
-                break;
+                /* The window has not changed enough. */
             }
 
-            /* See if in a meanwhile there is space in the TX-stream. */
-            xByteCount = ( BaseType_t ) uxStreamBufferGetSpace( pxSocket->u.xTCP.txStream );
-        } /* while( xBytesLeft > 0 ) */
-
-        return xBytesSent;
-    }
-
-/**
- * @brief Send data using a TCP socket. It is not necessary to have the socket
- *        connected already. Outgoing data will be stored and delivered as soon as
- *        the socket gets connected.
- *
- * @param[in] xSocket  The socket owning the connection.
- * @param[in] pvBuffer The buffer containing the data. The value of this pointer
- *                      may be NULL in case zero-copy transmissions are used.
- *                      It is used in combination with 'FreeRTOS_get_tx_head()'.
- * @param[in] uxDataLength The length of the data to be added.
- * @param[in] xFlags This parameter is not used. (zero or FREERTOS_MSG_DONTWAIT).
- *
- * @return The number of bytes actually sent. Zero when nothing could be sent
- *         or a negative error code in case an error occurred.
- */
-    BaseType_t FreeRTOS_send( Socket_t xSocket,
-                              const void * pvBuffer,
-                              size_t uxDataLength,
-                              BaseType_t xFlags )
-    {
-        BaseType_t xByteCount;
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-
-        xByteCount = ( BaseType_t ) prvTCPSendCheck( pxSocket, uxDataLength );
-
-        if( xByteCount > 0 )
-        {
-            /* prvTCPSendLoop() will try to send as many bytes as possible,
-             * returning number of bytes that have been queued for transmission.. */
-            xByteCount = prvTCPSendLoop( pxSocket, pvBuffer, uxDataLength, xFlags );
-
-            if( xByteCount == 0 )
+            if( xWinChange != pdFALSE )
             {
-                if( pxSocket->u.xTCP.eTCPState > eESTABLISHED )
-                {
-                    xByteCount = ( BaseType_t ) -pdFREERTOS_ERRNO_ENOTCONN;
-                }
-                else
-                {
-                    if( ipconfigTCP_MAY_LOG_PORT( pxSocket->usLocalPort ) )
-                    {
-                        FreeRTOS_debug_printf( ( "FreeRTOS_send: %u -> %xip:%d: no space\n",
-                                                 pxSocket->usLocalPort,
-                                                 ( unsigned ) pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4,
-                                                 pxSocket->u.xTCP.usRemotePort ) );
-                    }
+                pxSource->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
+                pxSource->u.xTCP.usTimeout = 1U;
 
-                    xByteCount = ( BaseType_t ) -pdFREERTOS_ERRNO_ENOSPC;
+                #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
+                {
+                    vTCPTimerWheelSchedule( pxSource );
                 }
+                #endif
             }
         }
-
-        return xByteCount;
     }
 
-
-#endif /* ipconfigUSE_TCP */
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_SPLICE != 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_TX_REFERENCE_COUNT != 0 ) )
 
 /**
- * @brief Request to put a socket in listen mode.
+ * @brief Read data from the txStream in 'peek' mode.  The parts that belong to
+ *        a buffer queued by FreeRTOS_send_reference() are copied from that
+ *        buffer, the other parts from txStream.
  *
- * @param[in] xSocket the socket to be put in listening mode.
- * @param[in] xBacklog Maximum number of child sockets.
+ * @param[in] pxSocket The socket owning the txStream.
+ * @param[in] uxOffset The offset from the tail of txStream.
+ * @param[out] pucData Where the data must be copied to.
+ * @param[in] uxMaxCount The number of bytes to copy.
  *
- * @return 0 in case of success, or else a negative error code is
- *         returned.
+ * @return The number of bytes copied.
  */
-    /* MISRA Ref 17.2.1 [Sockets and limited recursion] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-172 */
-    /* coverity[misra_c_2012_rule_17_2_violation] */
-    /* coverity[recursive_step] */
-    BaseType_t FreeRTOS_listen( Socket_t xSocket,
-                                BaseType_t xBacklog )
+    size_t uxTCPTxReferenceGet( const FreeRTOS_Socket_t * pxSocket,
+                                size_t uxOffset,
+                                uint8_t * pucData,
+                                size_t uxMaxCount )
     {
-        FreeRTOS_Socket_t * pxSocket;
-        BaseType_t xResult = 0;
+        const StreamBuffer_t * pxStream = pxSocket->u.xTCP.txStream;
+        const TCPTxReference_t * pxReference;
+        UBaseType_t uxIndex = pxSocket->u.xTCP.uxTxReferenceFirst;
+        UBaseType_t uxLeft = pxSocket->u.xTCP.uxTxReferenceCount;
+        size_t uxCount = FreeRTOS_min_size_t( uxMaxCount, uxStreamBufferGetSize( pxStream ) - FreeRTOS_min_size_t( uxOffset, uxStreamBufferGetSize( pxStream ) ) );
+        size_t uxDone = 0U;
+        size_t uxStart;
+        size_t uxEnd;
+        size_t uxPart;
 
-        pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-
-        /* listen() is allowed for a valid TCP socket in Closed state and already
-         * bound. */
-        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
-        {
-            xResult = -pdFREERTOS_ERRNO_EOPNOTSUPP;
-        }
-        else if( ( pxSocket->u.xTCP.eTCPState != eCLOSED ) && ( pxSocket->u.xTCP.eTCPState != eCLOSE_WAIT ) )
-        {
-            /* Socket is in a wrong state. */
-            xResult = -pdFREERTOS_ERRNO_EOPNOTSUPP;
-        }
-        else
+        while( ( uxLeft > 0U ) && ( uxDone < uxCount ) )
         {
-            /* Backlog is interpreted here as "the maximum number of child
-             * sockets. */
-            pxSocket->u.xTCP.usBacklog = ( uint16_t ) FreeRTOS_min_int32( ( int32_t ) 0xffff, ( int32_t ) xBacklog );
+            pxReference = &( pxSocket->u.xTCP.xTxReferences[ uxIndex ] );
 
-            /* This cleaning is necessary only if a listening socket is being
-             * reused as it might have had a previous connection. */
-            if( pxSocket->u.xTCP.bits.bReuseSocket != pdFALSE_UNSIGNED )
+            /* The part of the buffer that is not acknowledged yet starts at
+             * the tail of txStream or after it. */
+            uxStart = pxReference->uxStreamPos + pxReference->uxAcked;
+
+            if( uxStart >= pxStream->LENGTH )
             {
-                if( pxSocket->u.xTCP.rxStream != NULL )
-                {
-                    vStreamBufferClear( pxSocket->u.xTCP.rxStream );
-                }
+                uxStart -= pxStream->LENGTH;
+            }
 
-                if( pxSocket->u.xTCP.txStream != NULL )
+            uxStart = uxStreamBufferDistance( pxStream, pxStream->uxTail, uxStart );
+            uxEnd = uxStart + ( pxReference->uxLength - pxReference->uxAcked );
+
+            if( uxStart >= ( uxOffset + uxCount ) )
+            {
+                /* This buffer and the ones after it come later. */
+                break;
+            }
+
+            if( uxEnd > ( uxOffset + uxDone ) )
+            {
+                if( uxStart > ( uxOffset + uxDone ) )
                 {
-                    vStreamBufferClear( pxSocket->u.xTCP.txStream );
+                    /* Data in front of the buffer was written to txStream. */
+                    uxPart = uxStart - ( uxOffset + uxDone );
+                    uxDone += uxStreamBufferGet( pxSocket->u.xTCP.txStream, uxOffset + uxDone, &( pucData[ uxDone ] ), uxPart, pdTRUE );
                 }
 
-                ( void ) memset( pxSocket->u.xTCP.xPacket.u.ucLastPacket, 0, sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket ) );
-                ( void ) memset( &pxSocket->u.xTCP.xTCPWindow, 0, sizeof( pxSocket->u.xTCP.xTCPWindow ) );
-                ( void ) memset( &pxSocket->u.xTCP.bits, 0, sizeof( pxSocket->u.xTCP.bits ) );
+                uxPart = FreeRTOS_min_size_t( uxEnd, uxOffset + uxCount ) - ( uxOffset + uxDone );
+                ( void ) memcpy( &( pucData[ uxDone ] ),
+                                 &( pxReference->pucData[ pxReference->uxAcked + ( ( uxOffset + uxDone ) - uxStart ) ] ),
+                                 uxPart );
+                uxDone += uxPart;
+            }
+
+            uxIndex++;
 
-                /* Now set the bReuseSocket flag again, because the bits have
-                 * just been cleared. */
-                pxSocket->u.xTCP.bits.bReuseSocket = pdTRUE;
+            if( uxIndex >= ( UBaseType_t ) ipconfigTCP_TX_REFERENCE_COUNT )
+            {
+                uxIndex = 0U;
             }
 
-            vTCPStateChange( pxSocket, eTCP_LISTEN );
+            uxLeft--;
         }
 
-        return xResult;
-    }
-
+        if( uxDone < uxCount )
+        {
+            /* The remaining data was written to txStream. */
+            uxDone += uxStreamBufferGet( pxSocket->u.xTCP.txStream, uxOffset + uxDone, &( pucData[ uxDone ] ), uxCount - uxDone, pdTRUE );
+        }
 
-#endif /* ipconfigUSE_TCP */
+        return uxDone;
+    }
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
-
 /**
- * @brief Shutdown - This function will shut down the connection in both
- *        directions. However, it will first deliver all data queued for
- *        transmission, and also it will first wait to receive any missing
- *        packets from the peer.
- *
- * @param[in] xSocket The socket owning the connection.
- * @param[in] xHow Not used. Just present to stick to Berkeley standard.
+ * @brief Release the oldest buffer that was queued by FreeRTOS_send_reference().
  *
- * @return 0 on successful shutdown or else a negative error code.
+ * @param[in] pxSocket The socket owning the buffer.
+ * @param[in] xDelivered pdTRUE when all data of the buffer were acknowledged.
  */
-    BaseType_t FreeRTOS_shutdown( Socket_t xSocket,
-                                  BaseType_t xHow )
+    static void prvTCPTxReferenceRelease( FreeRTOS_Socket_t * pxSocket,
+                                          BaseType_t xDelivered )
     {
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xResult;
+        const TCPTxReference_t * pxReference = &( pxSocket->u.xTCP.xTxReferences[ pxSocket->u.xTCP.uxTxReferenceFirst ] );
+        const uint8_t * pucData = pxReference->pucData;
+        size_t uxLength = pxReference->uxLength;
+        FOnTCPReferenceReleased_t pxOnReleased = pxReference->pxOnReleased;
+        void * pvArgument = pxReference->pvArgument;
 
-        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdTRUE ) == pdFALSE )
+        /* Remove it before calling the application, which may queue a new
+         * buffer from within the call-back. */
+        pxSocket->u.xTCP.uxTxReferenceFirst++;
+
+        if( pxSocket->u.xTCP.uxTxReferenceFirst >= ( UBaseType_t ) ipconfigTCP_TX_REFERENCE_COUNT )
         {
-            /*_RB_ Is this comment correct?  The socket is not of a type that
-             * supports the listen() operation. */
-            xResult = -pdFREERTOS_ERRNO_EOPNOTSUPP;
+            pxSocket->u.xTCP.uxTxReferenceFirst = 0U;
         }
-        else if( pxSocket->u.xTCP.eTCPState != eESTABLISHED )
+
+        pxSocket->u.xTCP.uxTxReferenceCount--;
+
+        if( pxOnReleased != NULL )
         {
-            /* The socket is not connected. */
-            xResult = -pdFREERTOS_ERRNO_ENOTCONN;
+            pxOnReleased( ( Socket_t ) pxSocket, ( const void * ) pucData, uxLength, xDelivered, pvArgument );
         }
-        else
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Bytes at the tail of txStream have been acknowledged. Release the
+ *        buffers of which all data have been delivered now.
+ *
+ * @param[in] pxSocket The socket owning the txStream.
+ * @param[in] uxCount The number of bytes acknowledged.
+ */
+    void vTCPTxReferenceAcked( FreeRTOS_Socket_t * pxSocket,
+                               size_t uxCount )
+    {
+        const StreamBuffer_t * pxStream = pxSocket->u.xTCP.txStream;
+        TCPTxReference_t * pxReference;
+        size_t uxLeft = uxCount;
+        size_t uxTail = pxStream->uxTail;
+        size_t uxStart;
+        size_t uxGap;
+        size_t uxPart;
+
+        while( ( uxLeft > 0U ) && ( pxSocket->u.xTCP.uxTxReferenceCount > 0U ) )
         {
-            pxSocket->u.xTCP.bits.bUserShutdown = pdTRUE_UNSIGNED;
+            pxReference = &( pxSocket->u.xTCP.xTxReferences[ pxSocket->u.xTCP.uxTxReferenceFirst ] );
 
-            /* Let the IP-task perform the shutdown of the connection. */
-            pxSocket->u.xTCP.usTimeout = 1U;
-            ( void ) xSendEventToIPTask( eTCPTimerEvent );
-            xResult = 0;
-        }
+            uxStart = pxReference->uxStreamPos + pxReference->uxAcked;
 
-        ( void ) xHow;
+            if( uxStart >= pxStream->LENGTH )
+            {
+                uxStart -= pxStream->LENGTH;
+            }
 
-        return xResult;
+            /* Skip the bytes in front of the buffer, that were written to
+             * txStream. */
+            uxGap = uxStreamBufferDistance( pxStream, uxTail, uxStart );
+
+            if( uxGap >= uxLeft )
+            {
+                break;
+            }
+
+            uxLeft -= uxGap;
+            uxPart = FreeRTOS_min_size_t( uxLeft, pxReference->uxLength - pxReference->uxAcked );
+            pxReference->uxAcked += uxPart;
+            uxLeft -= uxPart;
+
+            uxTail = uxStart + uxPart;
+
+            if( uxTail >= pxStream->LENGTH )
+            {
+                uxTail -= pxStream->LENGTH;
+            }
+
+            if( pxReference->uxAcked == pxReference->uxLength )
+            {
+                prvTCPTxReferenceRelease( pxSocket, pdTRUE );
+            }
+        }
     }
+/*-----------------------------------------------------------*/
 
+/**
+ * @brief Release all buffers queued by FreeRTOS_send_reference(), because
+ *        the socket is closed or reused.
+ *
+ * @param[in] pxSocket The socket owning the buffers.
+ */
+    void vTCPTxReferenceFlush( FreeRTOS_Socket_t * pxSocket )
+    {
+        while( pxSocket->u.xTCP.uxTxReferenceCount > 0U )
+        {
+            prvTCPTxReferenceRelease( pxSocket, pdFALSE );
+        }
+    }
 
-#endif /* ipconfigUSE_TCP */
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_TX_REFERENCE_COUNT != 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
+#if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_RX_BUFFER_COUNT != 0 ) )
 
 /**
- * @brief A TCP timer has expired, now check all TCP sockets for:
- *        - Active connect
- *        - Send a delayed ACK
- *        - Send new data
- *        - Send a keep-alive packet
- *        - Check for timeout (in non-connected states only)
+ * @brief Called from the IP-task for in-order data.  When the socket is in
+ *        buffer-chain mode, it keeps the network buffer, and the space for the
+ *        data in rxStream is reserved without writing it.
  *
- * @param[in] xWillSleep Whether the calling task is going to sleep.
+ * @param[in] pxSocket The socket that received the data.
+ * @param[in] pxNetworkBuffer The network buffer holding the data.
+ * @param[in] pucData The first byte of the data within the network buffer.
+ * @param[in] ulByteCount The number of bytes.
  *
- * @return Minimum amount of time before the timer shall expire.
+ * @return pdTRUE when the socket has become the owner of the network buffer.
+ *         pdFALSE when the data must be copied to rxStream as usual.
  */
-    TickType_t xTCPTimerCheck( BaseType_t xWillSleep )
+    BaseType_t xTCPRxBufferAdd( FreeRTOS_Socket_t * pxSocket,
+                                NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                uint8_t * pucData,
+                                uint32_t ulByteCount )
     {
-        FreeRTOS_Socket_t * pxSocket;
-        TickType_t xShortest = pdMS_TO_TICKS( ( TickType_t ) ipTCP_TIMER_PERIOD_MS );
-        TickType_t xNow = xTaskGetTickCount();
-        static TickType_t xLastTime = 0U;
-        TickType_t xDelta = xNow - xLastTime;
-
-        /* MISRA Ref 11.3.1 [Misaligned access] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-        /* coverity[misra_c_2012_rule_11_3_violation] */
-        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+        StreamBuffer_t * pxStream = pxSocket->u.xTCP.rxStream;
+        TCPRxBuffer_t * pxRxBuffer;
+        UBaseType_t uxIndex;
+        BaseType_t xReturn = pdFALSE;
+        BaseType_t xMayKeep = pdTRUE;
 
-        /* MISRA Ref 11.3.1 [Misaligned access] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-        /* coverity[misra_c_2012_rule_11_3_violation] */
-        const ListItem_t * pxIterator = ( const ListItem_t * ) listGET_HEAD_ENTRY( &xBoundTCPSocketsList );
+        #if ( ipconfigUSE_CALLBACKS == 1 )
+        {
+            /* An OnReceive handler gets a pointer to the data already. */
+            if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xTCP.pxHandleReceive ) )
+            {
+                xMayKeep = pdFALSE;
+            }
+        }
+        #endif
 
-        xLastTime = xNow;
+        if( ( pxSocket->u.xTCP.bits.bRxBufferChain == pdFALSE_UNSIGNED ) ||
+            ( pxSocket->u.xTCP.uxRxBufferCount >= ( UBaseType_t ) ipconfigTCP_RX_BUFFER_COUNT ) )
+        {
+            xMayKeep = pdFALSE;
+        }
 
-        if( xDelta == 0U )
+        if( ( xMayKeep != pdFALSE ) && ( pxStream == NULL ) )
         {
-            xDelta = 1U;
+            pxStream = prvTCPCreateStream( pxSocket, pdTRUE );
         }
 
-        while( pxIterator != pxEnd )
+        if( ( xMayKeep != pdFALSE ) &&
+            ( pxStream != NULL ) &&
+            ( uxStreamBufferGetSpace( pxStream ) >= ( size_t ) ulByteCount ) )
         {
-            pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
-            pxIterator = ( ListItem_t * ) listGET_NEXT( pxIterator );
+            uxIndex = pxSocket->u.xTCP.uxRxBufferFirst + pxSocket->u.xTCP.uxRxBufferCount;
 
-            /* Sockets with 'timeout == 0' do not need any regular attention. */
-            if( pxSocket->u.xTCP.usTimeout == 0U )
+            if( uxIndex >= ( UBaseType_t ) ipconfigTCP_RX_BUFFER_COUNT )
             {
-                continue;
+                uxIndex -= ( UBaseType_t ) ipconfigTCP_RX_BUFFER_COUNT;
             }
 
-            if( xDelta < ( TickType_t ) pxSocket->u.xTCP.usTimeout )
+            pxRxBuffer = &( pxSocket->u.xTCP.xRxBuffers[ uxIndex ] );
+            pxRxBuffer->pxBuffer = pxNetworkBuffer;
+            pxRxBuffer->pucData = pucData;
+            pxRxBuffer->uxLength = ( size_t ) ulByteCount;
+            pxRxBuffer->uxConsumed = 0U;
+            pxRxBuffer->uxStreamPos = pxStream->uxHead;
+
+            /* The reader may release a buffer at the same time. */
+            vTaskSuspendAll();
             {
-                pxSocket->u.xTCP.usTimeout = ( uint16_t ) ( ( ( TickType_t ) pxSocket->u.xTCP.usTimeout ) - xDelta );
+                pxSocket->u.xTCP.uxRxBufferCount++;
             }
-            else
-            {
-                BaseType_t xRc;
+            ( void ) xTaskResumeAll();
 
-                pxSocket->u.xTCP.usTimeout = 0U;
-                xRc = xTCPSocketCheck( pxSocket );
+            /* Only now advance the head of rxStream, which makes the data
+             * visible to the reader. */
+            ( void ) lTCPAddRxdata( pxSocket, 0U, NULL, ulByteCount );
 
-                /* Within this function, the socket might want to send a delayed
-                 * ack or send out data or whatever it needs to do. */
-                if( xRc < 0 )
-                {
-                    /* Continue because the socket was deleted. */
-                    continue;
-                }
-            }
+            xReturn = pdTRUE;
+        }
 
-            /* In xEventBits the driver may indicate that the socket has
-             * important events for the user.  These are only done just before the
-             * IP-task goes to sleep. */
-            if( pxSocket->xEventBits != 0U )
-            {
-                if( xWillSleep != pdFALSE )
-                {
-                    /* The IP-task is about to go to sleep, so messages can be
-                     * sent to the socket owners. */
-                    vSocketWakeUpUser( pxSocket );
-                }
-                else
-                {
-                    /* Or else make sure this will be called again to wake-up
-                     * the sockets' owner. */
-                    xShortest = ( TickType_t ) 0;
-                }
-            }
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-            if( ( pxSocket->u.xTCP.usTimeout != 0U ) && ( xShortest > ( TickType_t ) pxSocket->u.xTCP.usTimeout ) )
+/**
+ * @brief Release the oldest network buffer kept by a socket.
+ *
+ * @param[in] pxSocket The socket owning the buffer.
+ */
+    static void prvTCPRxBufferRelease( FreeRTOS_Socket_t * pxSocket )
+    {
+        NetworkBufferDescriptor_t * pxNetworkBuffer = pxSocket->u.xTCP.xRxBuffers[ pxSocket->u.xTCP.uxRxBufferFirst ].pxBuffer;
+
+        /* The IP-task may add a buffer at the same time. */
+        vTaskSuspendAll();
+        {
+            pxSocket->u.xTCP.uxRxBufferFirst++;
+
+            if( pxSocket->u.xTCP.uxRxBufferFirst >= ( UBaseType_t ) ipconfigTCP_RX_BUFFER_COUNT )
             {
-                xShortest = ( TickType_t ) pxSocket->u.xTCP.usTimeout;
+                pxSocket->u.xTCP.uxRxBufferFirst = 0U;
             }
+
+            pxSocket->u.xTCP.uxRxBufferCount--;
         }
+        ( void ) xTaskResumeAll();
 
-        return xShortest;
+        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
     }
+/*-----------------------------------------------------------*/
 
+/**
+ * @brief Get the distance from the tail of rxStream to the first unread byte
+ *        of a network buffer.
+ *
+ * @param[in] pxStream The rxStream of the socket.
+ * @param[in] pxRxBuffer The network buffer kept by the socket.
+ *
+ * @return The distance in bytes.
+ */
+    static size_t prvTCPRxBufferStart( const StreamBuffer_t * pxStream,
+                                       const TCPRxBuffer_t * pxRxBuffer )
+    {
+        size_t uxStart = pxRxBuffer->uxStreamPos + pxRxBuffer->uxConsumed;
 
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
+        if( uxStart >= pxStream->LENGTH )
+        {
+            uxStart -= pxStream->LENGTH;
+        }
 
-#if ( ipconfigUSE_TCP == 1 )
+        return uxStreamBufferDistance( pxStream, pxStream->uxTail, uxStart );
+    }
+/*-----------------------------------------------------------*/
 
 /**
- * @brief As multiple sockets may be bound to the same local port number
- *        looking up a socket is a little more complex: Both a local port,
- *        and a remote port and IP address are being used to find a match.
- *        For a socket in listening mode, the remote port and IP address
- *        are both 0.
+ * @brief Read data from the tail of rxStream.  The parts that are stored in
+ *        network buffers are copied from those buffers, the other parts from
+ *        rxStream.
  *
- * @param[in] ulLocalIP Local IP address. Ignored for now.
- * @param[in] uxLocalPort Local port number.
- * @param[in] xRemoteIP Remote (peer) IP address.
- * @param[in] uxRemotePort Remote (peer) port.
+ * @param[in] pxSocket The socket owning the rxStream.
+ * @param[out] pucData Where the data must be copied to, or NULL to skip the data.
+ * @param[in] uxMaxCount The maximum number of bytes to read.
+ * @param[in] xPeek When true, the data will not be removed from rxStream.
  *
- * @return The socket which was found.
+ * @return The number of bytes read.
  */
-    FreeRTOS_Socket_t * pxTCPSocketLookup( uint32_t ulLocalIP,
-                                           UBaseType_t uxLocalPort,
-                                           IPv46_Address_t xRemoteIP,
-                                           UBaseType_t uxRemotePort )
+    size_t uxTCPRxBufferGet( FreeRTOS_Socket_t * pxSocket,
+                             uint8_t * pucData,
+                             size_t uxMaxCount,
+                             BaseType_t xPeek )
     {
-        const ListItem_t * pxIterator;
-        FreeRTOS_Socket_t * pxResult = NULL, * pxListenSocket = NULL;
+        StreamBuffer_t * pxStream = pxSocket->u.xTCP.rxStream;
+        /* Get the size before looking at the buffers: a buffer is counted
+         * before its data becomes visible in rxStream. */
+        size_t uxCount = FreeRTOS_min_size_t( uxMaxCount, uxStreamBufferGetSize( pxStream ) );
+        UBaseType_t uxIndex = pxSocket->u.xTCP.uxRxBufferFirst;
+        UBaseType_t uxLeft = pxSocket->u.xTCP.uxRxBufferCount;
+        const TCPRxBuffer_t * pxRxBuffer;
+        TCPRxBuffer_t * pxFirst;
+        size_t uxDone = 0U;
+        size_t uxStart;
+        size_t uxPart;
 
-        /* MISRA Ref 11.3.1 [Misaligned access] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-        /* coverity[misra_c_2012_rule_11_3_violation] */
-        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+        while( ( uxLeft > 0U ) && ( uxDone < uxCount ) )
+        {
+            pxRxBuffer = &( pxSocket->u.xTCP.xRxBuffers[ uxIndex ] );
+            uxStart = prvTCPRxBufferStart( pxStream, pxRxBuffer );
 
-        ( void ) ulLocalIP;
+            if( uxStart >= uxCount )
+            {
+                /* This buffer and the ones after it come later. */
+                break;
+            }
 
-        for( pxIterator = listGET_NEXT( pxEnd );
-             pxIterator != pxEnd;
-             pxIterator = listGET_NEXT( pxIterator ) )
+            if( uxStart > uxDone )
+            {
+                /* Data in front of the buffer was written to rxStream. */
+                uxDone += uxStreamBufferGet( pxStream, uxDone, ( pucData != NULL ) ? &( pucData[ uxDone ] ) : NULL, uxStart - uxDone, pdTRUE );
+            }
+
+            uxPart = FreeRTOS_min_size_t( uxStart + ( pxRxBuffer->uxLength - pxRxBuffer->uxConsumed ), uxCount ) - uxDone;
+
+            if( pucData != NULL )
+            {
+                ( void ) memcpy( &( pucData[ uxDone ] ),
+                                 &( pxRxBuffer->pucData[ pxRxBuffer->uxConsumed + ( uxDone - uxStart ) ] ),
+                                 uxPart );
+            }
+
+            uxDone += uxPart;
+            uxIndex++;
+
+            if( uxIndex >= ( UBaseType_t ) ipconfigTCP_RX_BUFFER_COUNT )
+            {
+                uxIndex = 0U;
+            }
+
+            uxLeft--;
+        }
+
+        if( uxDone < uxCount )
         {
-            FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+            /* The remaining data was written to rxStream. */
+            uxDone += uxStreamBufferGet( pxStream, uxDone, ( pucData != NULL ) ? &( pucData[ uxDone ] ) : NULL, uxCount - uxDone, pdTRUE );
+        }
 
-            if( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort )
+        if( xPeek == pdFALSE )
+        {
+            /* Account for the bytes read from network buffers, while the tail
+             * of rxStream has not moved yet. */
+            while( pxSocket->u.xTCP.uxRxBufferCount > 0U )
             {
-                if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
+                pxFirst = &( pxSocket->u.xTCP.xRxBuffers[ pxSocket->u.xTCP.uxRxBufferFirst ] );
+                uxStart = prvTCPRxBufferStart( pxStream, pxFirst );
+
+                if( uxStart >= uxDone )
                 {
-                    /* If this is a socket listening to uxLocalPort, remember it
-                     * in case there is no perfect match. */
-                    pxListenSocket = pxSocket;
+                    break;
                 }
-                else if( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort )
-                {
-                    if( xRemoteIP.xIs_IPv6 != pdFALSE )
-                    {
-                        #if ( ipconfigUSE_IPv6 != 0 )
-                            pxResult = pxTCPSocketLookup_IPv6( pxSocket, &xRemoteIP );
-                        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
-                    }
-                    else
-                    {
-                        if( pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 == xRemoteIP.xIPAddress.ulIP_IPv4 )
-                        {
-                            /* For sockets not in listening mode, find a match with
-                             * xLocalPort, ulRemoteIP AND xRemotePort. */
-                            pxResult = pxSocket;
-                        }
-                    }
 
-                    if( pxResult != NULL )
-                    {
-                        break;
-                    }
-                }
-                else
+                pxFirst->uxConsumed += FreeRTOS_min_size_t( uxDone - uxStart, pxFirst->uxLength - pxFirst->uxConsumed );
+
+                if( pxFirst->uxConsumed < pxFirst->uxLength )
                 {
-                    /* This 'pxSocket' doesn't match. */
+                    break;
                 }
+
+                prvTCPRxBufferRelease( pxSocket );
             }
+
+            ( void ) uxStreamBufferGet( pxStream, 0U, NULL, uxDone, pdFALSE );
         }
 
-        if( pxResult == NULL )
+        return uxDone;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get a pointer to the first block of contiguous data at the tail of
+ *        rxStream.  The block may be located in a network buffer.
+ *
+ * @param[in] pxSocket The socket owning the rxStream.
+ * @param[out] ppucData Will point to the first byte of the block.
+ *
+ * @return The number of bytes in the block.
+ */
+    size_t uxTCPRxBufferGetPtr( const FreeRTOS_Socket_t * pxSocket,
+                                uint8_t ** ppucData )
+    {
+        StreamBuffer_t * pxStream = pxSocket->u.xTCP.rxStream;
+        size_t uxCount = uxStreamBufferGetPtr( pxStream, ppucData );
+        const TCPRxBuffer_t * pxRxBuffer;
+        size_t uxStart;
+
+        if( ( uxCount > 0U ) && ( pxSocket->u.xTCP.uxRxBufferCount > 0U ) )
         {
-            /* An exact match was not found, maybe a listening socket was
-             * found. */
-            pxResult = pxListenSocket;
+            pxRxBuffer = &( pxSocket->u.xTCP.xRxBuffers[ pxSocket->u.xTCP.uxRxBufferFirst ] );
+            uxStart = prvTCPRxBufferStart( pxStream, pxRxBuffer );
+
+            if( uxStart == 0U )
+            {
+                *( ppucData ) = &( pxRxBuffer->pucData[ pxRxBuffer->uxConsumed ] );
+                uxCount = pxRxBuffer->uxLength - pxRxBuffer->uxConsumed;
+            }
+            else if( uxStart < uxCount )
+            {
+                /* Stop in front of the network buffer. */
+                uxCount = uxStart;
+            }
+            else
+            {
+                /* The network buffer comes later. */
+            }
         }
 
-        return pxResult;
+        return uxCount;
     }
+/*-----------------------------------------------------------*/
 
-#endif /* ipconfigUSE_TCP */
+/**
+ * @brief Release all network buffers kept by a socket, because it is closed
+ *        or reused.
+ *
+ * @param[in] pxSocket The socket owning the buffers.
+ */
+    void vTCPRxBufferFlush( FreeRTOS_Socket_t * pxSocket )
+    {
+        while( pxSocket->u.xTCP.uxRxBufferCount > 0U )
+        {
+            prvTCPRxBufferRelease( pxSocket );
+        }
+    }
+
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_RX_BUFFER_COUNT != 0 ) */
 /*-----------------------------------------------------------*/
 
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief For the web server: borrow the circular Rx buffer for inspection.
- *        HTML driver wants to see if a sequence of 13/10/13/10 is available.
+ * @brief Function to get the remote IP-address and port number.
  *
- * @param[in] xSocket The socket whose Rx stream is to be returned.
+ * @param[in] xSocket Socket owning the connection.
+ * @param[out] pxAddress The address pointer to which the address
+ *                        is to be added.
  *
- * @return The Rx stream of the socket if all checks pass, else NULL.
+ * @return The size of the address being returned. Or else a negative
+ *         error code will be returned.
  */
-    const struct xSTREAM_BUFFER * FreeRTOS_get_rx_buf( ConstSocket_t xSocket )
+
+/* Function to get the remote address and IP port */
+    BaseType_t FreeRTOS_GetRemoteAddress( ConstSocket_t xSocket,
+                                          struct freertos_sockaddr * pxAddress )
     {
         const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        const struct xSTREAM_BUFFER * pxReturn = NULL;
-
+        BaseType_t xResult;
 
-        /* Confirm that this is a TCP socket before dereferencing structure
-         * member pointers. */
-        if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE )
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
         {
-            pxReturn = pxSocket->u.xTCP.rxStream;
+            xResult = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            /* BSD style sockets communicate IP and port addresses in network
+             * byte order.
+             * IP address of remote machine. */
+            switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    case pdFALSE_UNSIGNED:
+                        pxAddress->sin_len = ( uint8_t ) sizeof( *pxAddress );
+                        pxAddress->sin_family = FREERTOS_AF_INET;
+
+                        /* IP address of remote machine. */
+                        pxAddress->sin_address.ulIP_IPv4 = FreeRTOS_htonl( pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 );
+
+                        /* Port on remote machine. */
+                        pxAddress->sin_port = FreeRTOS_htons( pxSocket->u.xTCP.usRemotePort );
+                        break;
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    case pdTRUE_UNSIGNED:
+                        pxAddress->sin_family = FREERTOS_AF_INET6;
+
+                        /* IP address of remote machine. */
+                        ( void ) memcpy( pxAddress->sin_address.xIP_IPv6.ucBytes, pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes, sizeof( pxAddress->sin_address.xIP_IPv6.ucBytes ) );
+
+                        /* Port of remote machine. */
+                        pxAddress->sin_port = FreeRTOS_htons( pxSocket->u.xTCP.usRemotePort );
+                        break;
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                default:
+                    /* MISRA 16.4 Compliance */
+                    break;
+            }
+
+            #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                prvSocketMapAddress( pxSocket, pxAddress );
+            #endif
+
+            xResult = ( BaseType_t ) sizeof( *pxAddress );
         }
 
-        return pxReturn;
+        return xResult;
     }
 
+
 #endif /* ipconfigUSE_TCP */
+
+
 /*-----------------------------------------------------------*/
 
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Create the stream buffer for the given socket.
+ * @brief Check the number of bytes that may be added to txStream.
  *
- * @param[in] pxSocket the socket to create the stream for.
- * @param[in] xIsInputStream Is this input stream? pdTRUE/pdFALSE?
+ * @param[in] xSocket The socket to be checked.
  *
- * @return The stream buffer.
+ * @return the number of bytes that may be added to txStream or
+ *         else a negative error code.
  */
-    static StreamBuffer_t * prvTCPCreateStream( FreeRTOS_Socket_t * pxSocket,
-                                                BaseType_t xIsInputStream )
+    BaseType_t FreeRTOS_maywrite( ConstSocket_t xSocket )
     {
-        StreamBuffer_t * pxBuffer;
-        size_t uxLength;
-        size_t uxSize;
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        BaseType_t xResult = 0;
 
-        /* Now that a stream is created, the maximum size is fixed before
-         * creation, it could still be changed with setsockopt(). */
-        if( xIsInputStream != pdFALSE )
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
         {
-            size_t uxLittlePerc = sock20_PERCENT;
-            size_t uxEnoughPerc = sock80_PERCENT;
-            size_t uxSegmentCount = pxSocket->u.xTCP.uxRxStreamSize / pxSocket->u.xTCP.usMSS;
-            static const struct Percent
-            {
-                size_t uxPercLittle, uxPercEnough;
-            }
-            xPercTable[] =
-            {
-                { 0U,  100U }, /* 1 segment. */
-                { 50U, 100U }, /* 2 segments. */
-                { 34U, 100U }, /* 3 segments. */
-                { 25U, 100U }, /* 4 segments. */
-            };
-
-            if( ( uxSegmentCount > 0U ) &&
-                ( uxSegmentCount <= ARRAY_USIZE( xPercTable ) ) )
+            xResult = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else if( pxSocket->u.xTCP.eTCPState != eESTABLISHED )
+        {
+            if( ( pxSocket->u.xTCP.eTCPState < eCONNECT_SYN ) || ( pxSocket->u.xTCP.eTCPState > eESTABLISHED ) )
             {
-                uxLittlePerc = xPercTable[ uxSegmentCount - 1U ].uxPercLittle;
-                uxEnoughPerc = xPercTable[ uxSegmentCount - 1U ].uxPercEnough;
+                xResult = -1;
             }
+        }
+        else
+        {
+            /* Read the pointer once, the IP-task may release an idle stream. */
+            const StreamBuffer_t * pxStream = pxSocket->u.xTCP.txStream;
 
-            uxLength = pxSocket->u.xTCP.uxRxStreamSize;
-
-            if( pxSocket->u.xTCP.uxLittleSpace == 0U )
+            if( pxStream == NULL )
             {
-                pxSocket->u.xTCP.uxLittleSpace = ( uxLittlePerc * pxSocket->u.xTCP.uxRxStreamSize ) / sock100_PERCENT;
+                xResult = ( BaseType_t ) pxSocket->u.xTCP.uxTxStreamSize;
             }
-
-            if( pxSocket->u.xTCP.uxEnoughSpace == 0U )
+            else
             {
-                pxSocket->u.xTCP.uxEnoughSpace = ( uxEnoughPerc * pxSocket->u.xTCP.uxRxStreamSize ) / sock100_PERCENT;
+                xResult = ( BaseType_t ) uxStreamBufferGetSpace( pxStream );
             }
         }
-        else
-        {
-            uxLength = pxSocket->u.xTCP.uxTxStreamSize;
-        }
 
-        /* Add an extra 4 (or 8) bytes. */
-        uxLength += sizeof( size_t );
+        return xResult;
+    }
 
-        /* And make the length a multiple of sizeof( size_t ). */
-        uxLength &= ~( sizeof( size_t ) - 1U );
 
-        uxSize = ( sizeof( *pxBuffer ) + uxLength ) - sizeof( pxBuffer->ucArray );
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
 
-        /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
-        /* coverity[misra_c_2012_directive_4_12_violation] */
-        pxBuffer = ( ( StreamBuffer_t * ) pvPortMallocLarge( uxSize ) );
+#if ( ipconfigUSE_TCP == 1 )
 
-        if( pxBuffer == NULL )
+/**
+ * @brief Get the number of bytes that can be written in the Tx buffer
+ *        of the given socket.
+ *
+ * @param[in] xSocket the socket to be checked.
+ *
+ * @return The bytes that can be written. Or else an error code.
+ */
+    BaseType_t FreeRTOS_tx_space( ConstSocket_t xSocket )
+    {
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        BaseType_t xReturn;
+
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
         {
-            FreeRTOS_debug_printf( ( "prvTCPCreateStream: malloc failed\n" ) );
-            pxSocket->u.xTCP.bits.bMallocError = pdTRUE_UNSIGNED;
-            vTCPStateChange( pxSocket, eCLOSE_WAIT );
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
         }
         else
         {
-            /* Clear the markers of the stream */
-            ( void ) memset( pxBuffer, 0, sizeof( *pxBuffer ) - sizeof( pxBuffer->ucArray ) );
-            pxBuffer->LENGTH = ( size_t ) uxLength;
-
-            if( xTCPWindowLoggingLevel != 0 )
-            {
-                FreeRTOS_debug_printf( ( "prvTCPCreateStream: %cxStream created %u bytes (total %u)\n", ( xIsInputStream != 0 ) ? 'R' : 'T', ( unsigned ) uxLength, ( unsigned ) uxSize ) );
-            }
+            const StreamBuffer_t * pxStream = pxSocket->u.xTCP.txStream;
 
-            if( xIsInputStream != 0 )
+            if( pxStream != NULL )
             {
-                iptraceMEM_STATS_CREATE( tcpRX_STREAM_BUFFER, pxBuffer, uxSize );
-                pxSocket->u.xTCP.rxStream = pxBuffer;
+                xReturn = ( BaseType_t ) uxStreamBufferGetSpace( pxStream );
             }
             else
             {
-                iptraceMEM_STATS_CREATE( tcpTX_STREAM_BUFFER, pxBuffer, uxSize );
-                pxSocket->u.xTCP.txStream = pxBuffer;
+                xReturn = ( BaseType_t ) pxSocket->u.xTCP.uxTxStreamSize;
             }
         }
 
-        return pxBuffer;
+        return xReturn;
     }
 
 
 #endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_CALLBACKS == 1 )
+#if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief The application can attach callback functions to a socket. In this function,
- *        called by lTCPAddRxdata(), the TCP reception handler will be called.
- * @param[in] pxSocket The socket which has received TCP data.
- * @param[in] pcData The actual data received.
- * @param[in] ulByteCount The number of bytes that were received.
+ * @brief Returns the number of bytes stored in the Tx buffer.
+ *
+ * @param[in] xSocket The socket to be checked.
+ *
+ * @return The number of bytes stored in the Tx buffer of the socket.
+ *         Or an error code.
  */
-    static void vTCPAddRxdata_Callback( FreeRTOS_Socket_t * pxSocket,
-                                        const uint8_t * pcData,
-                                        uint32_t ulByteCount )
+    BaseType_t FreeRTOS_tx_size( ConstSocket_t xSocket )
     {
-        const uint8_t * pucBuffer = pcData;
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        BaseType_t xReturn;
 
-        /* The socket owner has installed an OnReceive handler. Pass the
-         * Rx data, without copying from the rxStream, to the user. */
-        for( ; ; )
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
         {
-            uint8_t * ucReadPtr = NULL;
-            uint32_t ulCount;
-
-            if( pucBuffer != NULL )
-            {
-                ucReadPtr = ( uint8_t * ) pucBuffer;
-                ulCount = ulByteCount;
-                pucBuffer = NULL;
-            }
-            else
-            {
-                ulCount = ( uint32_t ) uxStreamBufferGetPtr( pxSocket->u.xTCP.rxStream, &( ucReadPtr ) );
-            }
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            const StreamBuffer_t * pxStream = pxSocket->u.xTCP.txStream;
 
-            if( ulCount == 0U )
+            if( pxStream != NULL )
             {
-                break;
-            }
-
-            /* For advanced users only: here a pointer to the RX-stream of a socket
-             * is passed to an application hook. */
-            ( void ) pxSocket->u.xTCP.pxHandleReceive( pxSocket, ucReadPtr, ( size_t ) ulCount );
-            /* Forward the tail in the RX stream. */
-            ( void ) uxStreamBufferGet( pxSocket->u.xTCP.rxStream, 0U, NULL, ( size_t ) ulCount, pdFALSE );
+                xReturn = ( BaseType_t ) uxStreamBufferGetSize( pxStream );
+            }
+            else
+            {
+                xReturn = 0;
+            }
         }
+
+        return xReturn;
     }
-#endif /* #if ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_CALLBACKS == 1 ) */
+
+
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
 
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Called by lTCPAddRxdata(), the received data has just been added to the
- *        RX-stream. When the space is dropped below a threshold, it may set the
- *        bit field 'bLowWater'. Also the socket's events bits for READ will be set.
- * @param[in] pxSocket the socket that has received new data.
+ * @brief Is the socket connected.
+ *
+ * @param[in] xSocket The socket being checked.
+ *
+ * @return pdTRUE if TCP socket is connected.
  */
-    static void vTCPAddRxdata_Stored( FreeRTOS_Socket_t * pxSocket )
+    BaseType_t FreeRTOS_issocketconnected( ConstSocket_t xSocket )
     {
-        /* See if running out of space. */
-        if( pxSocket->u.xTCP.bits.bLowWater == pdFALSE_UNSIGNED )
-        {
-            size_t uxFrontSpace = uxStreamBufferFrontSpace( pxSocket->u.xTCP.rxStream );
-
-            if( uxFrontSpace <= pxSocket->u.xTCP.uxLittleSpace )
-            {
-                pxSocket->u.xTCP.bits.bLowWater = pdTRUE_UNSIGNED;
-                pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        BaseType_t xReturn = pdFALSE;
 
-                /* bLowWater was reached, send the changed window size. */
-                pxSocket->u.xTCP.usTimeout = 1U;
-                ( void ) xSendEventToIPTask( eTCPTimerEvent );
-            }
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
         }
-
-        /* New incoming data is available, wake up the user.   User's
-         * semaphores will be set just before the IP-task goes asleep. */
-        pxSocket->xEventBits |= ( EventBits_t ) eSOCKET_RECEIVE;
-
-        #if ipconfigSUPPORT_SELECT_FUNCTION == 1
+        else
         {
-            if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != 0U )
+            if( pxSocket->u.xTCP.eTCPState >= eESTABLISHED )
             {
-                pxSocket->xEventBits |= ( ( ( EventBits_t ) eSELECT_READ ) << SOCKET_EVENT_BIT_COUNT );
+                if( pxSocket->u.xTCP.eTCPState < eCLOSE_WAIT )
+                {
+                    xReturn = pdTRUE;
+                }
             }
         }
-        #endif
+
+        return xReturn;
     }
+
+
 #endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
 
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Add data to the RxStream. When uxOffset > 0, data has come in out-of-order
- *        and will be put in front of the head so it can not be popped by the user.
+ * @brief Get the actual value of Maximum Segment Size ( MSS ) being used.
  *
- * @param[in] pxSocket The socket to whose RxStream data is to be added.
- * @param[in] uxOffset Offset of the packet.
- * @param[in] pcData The data to be added to the RxStream.
- * @param[in] ulByteCount Number of bytes in the data.
+ * @param[in] xSocket The socket whose MSS is to be returned.
  *
- * @return The number of bytes actually added to the RxStream. Or else, a negative
- *         error code is returned.
+ * @return the actual size of MSS being used or an error code.
  */
-    int32_t lTCPAddRxdata( FreeRTOS_Socket_t * pxSocket,
-                           size_t uxOffset,
-                           const uint8_t * pcData,
-                           uint32_t ulByteCount )
+    BaseType_t FreeRTOS_mss( ConstSocket_t xSocket )
     {
-        StreamBuffer_t * pxStream = pxSocket->u.xTCP.rxStream;
-        int32_t xResult = 0;
-
-        #if ( ipconfigUSE_CALLBACKS == 1 )
-            BaseType_t bHasHandler = ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xTCP.pxHandleReceive ) ? pdTRUE : pdFALSE;
-            const uint8_t * pucBuffer = NULL;
-        #endif /* ipconfigUSE_CALLBACKS */
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        BaseType_t xReturn;
 
-        /* int32_t uxStreamBufferAdd( pxBuffer, uxOffset, pucData, aCount )
-         * if( pucData != NULL ) copy data the the buffer
-         * if( pucData == NULL ) no copying, just advance rxHead
-         * if( uxOffset != 0 ) Just store data which has come out-of-order
-         * if( uxOffset == 0 ) Also advance rxHead */
-        if( pxStream == NULL )
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
         {
-            pxStream = prvTCPCreateStream( pxSocket, pdTRUE );
-
-            if( pxStream == NULL )
-            {
-                xResult = -1;
-            }
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
         }
-
-        if( xResult >= 0 )
+        else
         {
-            #if ( ipconfigUSE_CALLBACKS == 1 )
-            {
-                if( ( bHasHandler != pdFALSE ) && ( uxStreamBufferGetSize( pxStream ) == 0U ) && ( uxOffset == 0U ) && ( pcData != NULL ) )
-                {
-                    /* Data can be passed directly to the user because there is
-                     * no data in the RX-stream, it the new data must be stored
-                     * at offset zero, and a buffer 'pcData' is provided.
-                     */
-                    pucBuffer = pcData;
+            /* usMSS is declared as uint16_t to save space.  FreeRTOS_mss()
+             * will often be used in signed native-size expressions cast it to
+             * BaseType_t. */
+            xReturn = ( BaseType_t ) ( pxSocket->u.xTCP.usMSS );
+        }
 
-                    /* Zero-copy for call-back: no need to add the bytes to the
-                     * stream, only the pointer will be advanced by uxStreamBufferAdd(). */
-                    pcData = NULL;
-                }
-            }
-            #endif /* ipconfigUSE_CALLBACKS */
+        return xReturn;
+    }
 
-            xResult = ( int32_t ) uxStreamBufferAdd( pxStream, uxOffset, pcData, ( size_t ) ulByteCount );
 
-            #if ( ipconfigHAS_DEBUG_PRINTF != 0 )
-            {
-                if( xResult != ( int32_t ) ulByteCount )
-                {
-                    FreeRTOS_debug_printf( ( "lTCPAddRxdata: at %u: %d/%u bytes (tail %u head %u space %u front %u)\n",
-                                             ( unsigned int ) uxOffset,
-                                             ( int ) xResult,
-                                             ( unsigned int ) ulByteCount,
-                                             ( unsigned int ) pxStream->uxTail,
-                                             ( unsigned int ) pxStream->uxHead,
-                                             ( unsigned int ) uxStreamBufferFrontSpace( pxStream ),
-                                             ( unsigned int ) pxStream->uxFront ) );
-                }
-            }
-            #endif /* ipconfigHAS_DEBUG_PRINTF */
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
 
-            if( uxOffset == 0U )
-            {
-                /* Data is being added to rxStream at the head (offs = 0) */
-                #if ( ipconfigUSE_CALLBACKS == 1 )
-                    if( bHasHandler != pdFALSE )
-                    {
-                        vTCPAddRxdata_Callback( pxSocket, pucBuffer, ulByteCount );
-                    }
-                    else
-                #endif /* ipconfigUSE_CALLBACKS */
-                {
-                    vTCPAddRxdata_Stored( pxSocket );
-                }
-            }
+#if ( ipconfigUSE_TCP == 1 )
+
+/**
+ * @brief Get the connection status. The values correspond to the members
+ *        of the enum 'eIPTCPState_t'.
+ *
+ * @param[in] xSocket Socket to get the connection status from.
+ *
+ * @return The connection status or an error code.
+ *
+ * @note For internal use only.
+ */
+    BaseType_t FreeRTOS_connstatus( ConstSocket_t xSocket )
+    {
+        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        BaseType_t xReturn;
+
+        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        {
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            /* Cast it to BaseType_t. */
+            xReturn = ( BaseType_t ) ( pxSocket->u.xTCP.eTCPState );
         }
 
-        return xResult;
+        return xReturn;
     }
 
 
@@ -5341,909 +12131,1365 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Function to get the remote IP-address and port number.
+ * @brief Returns the number of bytes which can be read from the RX stream buffer.
  *
- * @param[in] xSocket Socket owning the connection.
- * @param[out] pxAddress The address pointer to which the address
- *                        is to be added.
+ * @param[in] xSocket the socket to get the number of bytes from.
  *
- * @return The size of the address being returned. Or else a negative
- *         error code will be returned.
+ * @return Returns the number of bytes which can be read. Or an error
+ *         code is returned.
  */
-
-/* Function to get the remote address and IP port */
-    BaseType_t FreeRTOS_GetRemoteAddress( ConstSocket_t xSocket,
-                                          struct freertos_sockaddr * pxAddress )
+    BaseType_t FreeRTOS_rx_size( ConstSocket_t xSocket )
     {
         const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xResult;
+        BaseType_t xReturn;
 
         if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
         {
-            xResult = -pdFREERTOS_ERRNO_EINVAL;
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
         }
         else
         {
-            /* BSD style sockets communicate IP and port addresses in network
-             * byte order.
-             * IP address of remote machine. */
-            switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
-            {
-                #if ( ipconfigUSE_IPv4 != 0 )
-                    case pdFALSE_UNSIGNED:
-                        pxAddress->sin_len = ( uint8_t ) sizeof( *pxAddress );
-                        pxAddress->sin_family = FREERTOS_AF_INET;
+            const StreamBuffer_t * pxStream = pxSocket->u.xTCP.rxStream;
 
-                        /* IP address of remote machine. */
-                        pxAddress->sin_address.ulIP_IPv4 = FreeRTOS_htonl( pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 );
-
-                        /* Port on remote machine. */
-                        pxAddress->sin_port = FreeRTOS_htons( pxSocket->u.xTCP.usRemotePort );
-                        break;
-                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+            if( pxStream != NULL )
+            {
+                xReturn = ( BaseType_t ) uxStreamBufferGetSize( pxStream );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+        }
 
-                #if ( ipconfigUSE_IPv6 != 0 )
-                    case pdTRUE_UNSIGNED:
-                        pxAddress->sin_family = FREERTOS_AF_INET6;
+        return xReturn;
+    }
 
-                        /* IP address of remote machine. */
-                        ( void ) memcpy( pxAddress->sin_address.xIP_IPv6.ucBytes, pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes, sizeof( pxAddress->sin_address.xIP_IPv6.ucBytes ) );
 
-                        /* Port of remote machine. */
-                        pxAddress->sin_port = FreeRTOS_htons( pxSocket->u.xTCP.usRemotePort );
-                        break;
-                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
 
-                default:
-                    /* MISRA 16.4 Compliance */
-                    break;
-            }
+/**
+ * @brief Check whether a given socket is valid or not. Validity is defined
+ *        as the socket not being NULL and not being Invalid.
+ * @param[in] xSocket The socket to be checked.
+ * @return pdTRUE if the socket is valid, else pdFALSE.
+ *
+ */
+BaseType_t xSocketValid( const ConstSocket_t xSocket )
+{
+    BaseType_t xReturnValue = pdFALSE;
 
-            xResult = ( BaseType_t ) sizeof( *pxAddress );
-        }
+    /*
+     * There are two values which can indicate an invalid socket:
+     * FREERTOS_INVALID_SOCKET and NULL.  In order to compare against
+     * both values, the code cannot be compliant with rule 11.4,
+     * hence the Coverity suppression statement below.
+     */
 
-        return xResult;
+    /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
+    /* coverity[misra_c_2012_rule_11_4_violation] */
+    if( ( xSocket != FREERTOS_INVALID_SOCKET ) && ( xSocket != NULL ) )
+    {
+        xReturnValue = pdTRUE;
     }
 
-
-#endif /* ipconfigUSE_TCP */
-
-
+    return xReturnValue;
+}
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
+#if 0
 
 /**
- * @brief Check the number of bytes that may be added to txStream.
+ * @brief Returns the number of packets that are stored in a UDP socket.
  *
- * @param[in] xSocket The socket to be checked.
+ * @param[in] xSocket the socket to get the number of bytes from.
  *
- * @return the number of bytes that may be added to txStream or
- *         else a negative error code.
+ * @return Returns the number of packets that are stored.  Use FreeRTOS_recvfrom()
+ *         to retrieve those packets.
  */
-    BaseType_t FreeRTOS_maywrite( ConstSocket_t xSocket )
+    BaseType_t FreeRTOS_udp_rx_size( Socket_t xSocket )
     {
+        BaseType_t xReturn = 0;
         const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xResult = 0;
 
-        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
-        {
-            xResult = -pdFREERTOS_ERRNO_EINVAL;
-        }
-        else if( pxSocket->u.xTCP.eTCPState != eESTABLISHED )
-        {
-            if( ( pxSocket->u.xTCP.eTCPState < eCONNECT_SYN ) || ( pxSocket->u.xTCP.eTCPState > eESTABLISHED ) )
-            {
-                xResult = -1;
-            }
-        }
-        else if( pxSocket->u.xTCP.txStream == NULL )
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
         {
-            xResult = ( BaseType_t ) pxSocket->u.xTCP.uxTxStreamSize;
+            xReturn = ( BaseType_t ) listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
         }
         else
         {
-            xResult = ( BaseType_t ) uxStreamBufferGetSpace( pxSocket->u.xTCP.txStream );
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
         }
 
-        return xResult;
+        return xReturn;
     }
+#endif /* 0 */
+
+#if ( ipconfigUSE_TCP == 1 )
 
+/**
+ * @brief Get the net status. The IP-task will print a summary of all sockets and
+ *        their connections.
+ */
+    void FreeRTOS_netstat( void )
+    {
+        IPStackEvent_t xAskEvent;
+
+        /* Ask the IP-task to call vTCPNetStat()
+         * to avoid accessing xBoundTCPSocketsList
+         */
+        xAskEvent.eEventType = eTCPNetStat;
+        xAskEvent.pvData = ( void * ) NULL;
+        ( void ) xSendEventStructToIPTask( &xAskEvent, pdMS_TO_TICKS( 1000U ) );
+    }
 
 #endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
+/**
+ * @brief Set the value of the SocketID of a socket.
+ * @param[in] xSocket The socket whose ID should be set.
+ * @param[in] pvSocketID The new value for the SocketID.
+ * @return Zero if the socket was valid, otherwise -EINVAL.
+ */
+BaseType_t xSocketSetSocketID( const Socket_t xSocket,
+                               void * pvSocketID )
+{
+    FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+    BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+    if( xSocketValid( pxSocket ) == pdTRUE )
+    {
+        xReturn = 0;
+        pxSocket->pvSocketID = pvSocketID;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
 
 /**
- * @brief Get the number of bytes that can be written in the Tx buffer
- *        of the given socket.
+ * @brief Retrieve the SocketID that is associated with a socket.
+ * @param[in] xSocket The socket whose ID should be returned.
+ * @return The current value of pvSocketID, or NULL in case
+ *         the socket pointer is not valid or when the ID was not
+ *         yet set.
+ */
+void * pvSocketGetSocketID( const ConstSocket_t xSocket )
+{
+    const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+    void * pvReturn = NULL;
+
+    if( xSocketValid( pxSocket ) == pdTRUE )
+    {
+        pvReturn = pxSocket->pvSocketID;
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the version of IP: either 'ipTYPE_IPv4' or 'ipTYPE_IPv6'.
  *
- * @param[in] xSocket the socket to be checked.
+ * @param[in] xSocket  The socket to be checked.
  *
- * @return The bytes that can be written. Or else an error code.
+ * @return Either ipTYPE_IPv4 or ipTYPE_IPv6.
  */
-    BaseType_t FreeRTOS_tx_space( ConstSocket_t xSocket )
+BaseType_t FreeRTOS_GetIPType( ConstSocket_t xSocket )
+{
+    const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+    BaseType_t xResult = ( BaseType_t ) ipTYPE_IPv4;
+
+    switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
     {
-        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xReturn;
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case pdFALSE_UNSIGNED:
+                xResult = ( BaseType_t ) ipTYPE_IPv4;
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
-        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case pdTRUE_UNSIGNED:
+                xResult = ( BaseType_t ) ipTYPE_IPv6;
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+        default:
+            /* MISRA 16.4 Compliance */
+            break;
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigHAS_PRINTF != 0 ) && ( ipconfigUSE_TCP == 1 ) )
+
+/**
+ * @brief A helper function of vTCPNetStat(), see below.
+ *
+ * @param[in] pxSocket The socket that needs logging.
+ */
+    static void vTCPNetStat_TCPSocket( const FreeRTOS_Socket_t * pxSocket )
+    {
+        char pcRemoteIp[ 40 ];
+        int xIPWidth = 32;
+
+        #if ( ipconfigTCP_KEEP_ALIVE == 1 )
+            TickType_t age = xTaskGetTickCount() - pxSocket->u.xTCP.xLastAliveTime;
+        #else
+            TickType_t age = 0U;
+        #endif
+
+        char ucChildText[ 16 ] = "";
+
+        if( pxSocket->u.xTCP.eTCPState == ( uint8_t ) eTCP_LISTEN )
         {
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            /* Using function "snprintf". */
+            const int32_t copied_len = snprintf( ucChildText, sizeof( ucChildText ), " %d/%d",
+                                                 pxSocket->u.xTCP.usChildCount,
+                                                 pxSocket->u.xTCP.usBacklog );
+            ( void ) copied_len;
+            /* These should never evaluate to false since the buffers are both shorter than 5-6 characters (<=65535) */
+            configASSERT( copied_len >= 0 );                                /* LCOV_EXCL_BR_LINE the 'taken' branch will never execute. See the above comment. */
+            configASSERT( copied_len < ( int32_t ) sizeof( ucChildText ) ); /* LCOV_EXCL_BR_LINE the 'taken' branch will never execute. See the above comment. */
         }
-        else
+
+        if( age > 999999U )
         {
-            if( pxSocket->u.xTCP.txStream != NULL )
-            {
-                xReturn = ( BaseType_t ) uxStreamBufferGetSpace( pxSocket->u.xTCP.txStream );
-            }
-            else
-            {
-                xReturn = ( BaseType_t ) pxSocket->u.xTCP.uxTxStreamSize;
-            }
+            age = 999999U;
         }
 
-        return xReturn;
-    }
+        switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
+        {
+            #if ( ipconfigUSE_IPv4 != 0 )
+                case pdFALSE_UNSIGNED:
+                    ( void ) snprintf( pcRemoteIp, sizeof( pcRemoteIp ), "%xip", ( unsigned ) pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 );
+                    break;
+            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
+            #if ( ipconfigUSE_IPv6 != 0 )
+                case pdTRUE_UNSIGNED:
+                    ( void ) snprintf( pcRemoteIp,
+                                       sizeof( pcRemoteIp ),
+                                       "%pip", ( void * ) pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes );
+                    break;
+            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
+            default:
+                /* MISRA 16.4 Compliance */
+                break;
+        }
 
-#if ( ipconfigUSE_TCP == 1 )
+        FreeRTOS_printf( ( "TCP %5d %-*s:%5d %d/%d %-13.13s %6u %6u%s\n",
+                           pxSocket->usLocalPort,         /* Local port on this machine */
+                           xIPWidth,
+                           pcRemoteIp,                    /* IP address of remote machine */
+                           pxSocket->u.xTCP.usRemotePort, /* Port on remote machine */
+                           ( pxSocket->u.xTCP.rxStream != NULL ) ? 1 : 0,
+                           ( pxSocket->u.xTCP.txStream != NULL ) ? 1 : 0,
+                           FreeRTOS_GetTCPStateName( pxSocket->u.xTCP.eTCPState ),
+                           ( unsigned ) ( ( age > 999999U ) ? 999999U : age ), /* Format 'age' for printing */
+                           pxSocket->u.xTCP.usTimeout,
+                           ucChildText ) );
+    }
+
+#endif /* ( ( ipconfigHAS_PRINTF != 0 ) && ( ipconfigUSE_TCP == 1 ) ) */
+
+#if ( ( ipconfigHAS_PRINTF != 0 ) && ( ipconfigUSE_TCP == 1 ) )
 
 /**
- * @brief Returns the number of bytes stored in the Tx buffer.
- *
- * @param[in] xSocket The socket to be checked.
- *
- * @return The number of bytes stored in the Tx buffer of the socket.
- *         Or an error code.
+ * @brief Print a summary of all sockets and their connections.
  */
-    BaseType_t FreeRTOS_tx_size( ConstSocket_t xSocket )
+    void vTCPNetStat( void )
     {
-        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xReturn;
+        /* Show a simple listing of all created sockets and their connections */
+        const ListItem_t * pxIterator;
+        BaseType_t count = 0;
+        size_t uxMinimum = uxGetMinimumFreeNetworkBuffers();
+        size_t uxCurrent = uxGetNumberOfFreeNetworkBuffers();
 
-        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+        if( !listLIST_IS_INITIALISED( &xBoundTCPSocketsList ) )
         {
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            FreeRTOS_printf( ( "PLUS-TCP not initialized\n" ) );
         }
         else
         {
-            if( pxSocket->u.xTCP.txStream != NULL )
+            /* Casting a "MiniListItem_t" to a "ListItem_t".
+             * This is safe because only its address is being accessed, not its fields. */
+            const ListItem_t * pxEndTCP = listGET_END_MARKER( &xBoundTCPSocketsList );
+            const ListItem_t * pxEndUDP = listGET_END_MARKER( &xBoundUDPSocketsList );
+
+            FreeRTOS_printf( ( "Prot Port IP-Remote       : Port  R/T Status       Alive  tmout Child\n" ) );
+
+            for( pxIterator = listGET_HEAD_ENTRY( &xBoundTCPSocketsList );
+                 pxIterator != pxEndTCP;
+                 pxIterator = listGET_NEXT( pxIterator ) )
             {
-                xReturn = ( BaseType_t ) uxStreamBufferGetSize( pxSocket->u.xTCP.txStream );
+                const FreeRTOS_Socket_t * pxSocket = ( ( const FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                vTCPNetStat_TCPSocket( pxSocket );
+                count++;
             }
-            else
+
+            for( pxIterator = listGET_HEAD_ENTRY( &xBoundUDPSocketsList );
+                 pxIterator != pxEndUDP;
+                 pxIterator = listGET_NEXT( pxIterator ) )
             {
-                xReturn = 0;
+                /* Local port on this machine */
+                FreeRTOS_printf( ( "UDP Port %5u\n",
+                                   FreeRTOS_ntohs( listGET_LIST_ITEM_VALUE( pxIterator ) ) ) );
+                count++;
             }
-        }
 
-        return xReturn;
+            FreeRTOS_printf( ( "FreeRTOS_netstat: %d sockets %u < %u < %u buffers free\n",
+                               ( int ) count,
+                               ( unsigned ) uxMinimum,
+                               ( unsigned ) uxCurrent,
+                               ( unsigned ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ) );
+        }
     }
 
-
-#endif /* ipconfigUSE_TCP */
+#endif /* ( ( ipconfigHAS_PRINTF != 0 ) && ( ipconfigUSE_TCP == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigUSE_TCP == 1 )
+#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+
+    #if ( ipconfigUSE_TCP == 1 )
 
 /**
- * @brief Is the socket connected.
- *
- * @param[in] xSocket The socket being checked.
+ * @brief This internal function will check if a given TCP
+ *        socket has had any select event, either READ, WRITE,
+ *        or EXCEPT.
  *
- * @return pdTRUE if TCP socket is connected.
+ * @param[in] pxSocket The socket which needs to be checked.
+ * @return An event mask of events that are active for this socket.
  */
-    BaseType_t FreeRTOS_issocketconnected( ConstSocket_t xSocket )
-    {
-        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xReturn = pdFALSE;
-
-        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
-        {
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
-        }
-        else
+        static EventBits_t vSocketSelectTCP( FreeRTOS_Socket_t * pxSocket )
         {
-            if( pxSocket->u.xTCP.eTCPState >= eESTABLISHED )
+            /* Check if the TCP socket has already been accepted by
+             * the owner.  If not, it is useless to return it from a
+             * select(). */
+            BaseType_t bAccepted = pdFALSE;
+            EventBits_t xSocketBits = 0U;
+
+            if( pxSocket->u.xTCP.bits.bPassQueued == pdFALSE_UNSIGNED )
             {
-                if( pxSocket->u.xTCP.eTCPState < eCLOSE_WAIT )
+                if( pxSocket->u.xTCP.bits.bPassAccept == pdFALSE_UNSIGNED )
                 {
-                    xReturn = pdTRUE;
+                    bAccepted = pdTRUE;
                 }
             }
-        }
 
-        return xReturn;
-    }
+            /* Is the set owner interested in READ events? */
+            if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != ( EventBits_t ) 0U )
+            {
+                if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
+                {
+                    #if ( ipconfigTCP_ACCEPT_QUEUE != 0 )
+                        if( listCURRENT_LIST_LENGTH( &( pxSocket->u.xTCP.xAcceptQueue ) ) > 0U )
+                    #else
+                        if( ( pxSocket->u.xTCP.pxPeerSocket != NULL ) && ( pxSocket->u.xTCP.pxPeerSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) )
+                    #endif
+                    {
+                        xSocketBits |= ( EventBits_t ) eSELECT_READ;
+                    }
+                }
+                else if( ( pxSocket->u.xTCP.bits.bReuseSocket != pdFALSE_UNSIGNED ) && ( pxSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) )
+                {
+                    /* This socket has the re-use flag. After connecting it turns into
+                     * a connected socket. Set the READ event, so that accept() will be called. */
+                    xSocketBits |= ( EventBits_t ) eSELECT_READ;
+                }
+                else if( ( bAccepted != 0 ) && ( FreeRTOS_recvcount( pxSocket ) > 0 ) && sockRECORD_READABLE( pxSocket ) )
+                {
+                    xSocketBits |= ( EventBits_t ) eSELECT_READ;
+                }
+                else
+                {
+                    /* Nothing. */
+                }
+            }
 
+            /* Is the set owner interested in EXCEPTION events? */
+            if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_EXCEPT ) != 0U )
+            {
+                if( ( pxSocket->u.xTCP.eTCPState == eCLOSE_WAIT ) || ( pxSocket->u.xTCP.eTCPState == eCLOSED ) )
+                {
+                    xSocketBits |= ( EventBits_t ) eSELECT_EXCEPT;
+                }
+            }
 
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
+            /* Is the set owner interested in WRITE events? */
+            if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_WRITE ) != 0U )
+            {
+                BaseType_t bMatch = pdFALSE;
 
-#if ( ipconfigUSE_TCP == 1 )
+                if( bAccepted != 0 )
+                {
+                    if( FreeRTOS_tx_space( pxSocket ) > 0 )
+                    {
+                        bMatch = pdTRUE;
+                    }
+                }
+
+                if( bMatch == pdFALSE )
+                {
+                    if( ( pxSocket->u.xTCP.bits.bConnPrepared != pdFALSE_UNSIGNED ) &&
+                        ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) &&
+                        ( pxSocket->u.xTCP.bits.bConnPassed == pdFALSE_UNSIGNED ) )
+                    {
+                        pxSocket->u.xTCP.bits.bConnPassed = pdTRUE_UNSIGNED;
+                        bMatch = pdTRUE;
+                    }
+                }
+
+                if( bMatch != pdFALSE )
+                {
+                    xSocketBits |= ( EventBits_t ) eSELECT_WRITE;
+                }
+            }
+
+            return xSocketBits;
+        }
+
+    #endif /* ( ipconfigUSE_TCP == 1 ) */
 
 /**
- * @brief Get the actual value of Maximum Segment Size ( MSS ) being used.
- *
- * @param[in] xSocket The socket whose MSS is to be returned.
+ * @brief This internal non-blocking function will check all sockets that belong
+ *        to a select set.  The events bits of each socket will be updated, and it
+ *        will check if an ongoing select() call must be interrupted because of an
+ *        event has occurred.
  *
- * @return the actual size of MSS being used or an error code.
+ * @param[in] pxSocketSet The socket-set which is to be waited on for change.
  */
-    BaseType_t FreeRTOS_mss( ConstSocket_t xSocket )
+    void vSocketSelect( const SocketSelect_t * pxSocketSet )
     {
-        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xReturn;
+        BaseType_t xRound;
+        EventBits_t xSocketBits, xBitsToClear;
 
-        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
-        {
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
-        }
-        else
-        {
-            /* usMSS is declared as uint16_t to save space.  FreeRTOS_mss()
-             * will often be used in signed native-size expressions cast it to
-             * BaseType_t. */
-            xReturn = ( BaseType_t ) ( pxSocket->u.xTCP.usMSS );
-        }
+        #if ipconfigUSE_TCP == 1
+            BaseType_t xLastRound = 1;
+        #else
+            BaseType_t xLastRound = 0;
+        #endif
 
-        return xReturn;
-    }
+        /* These flags will be switched on after checking the socket status. */
+        EventBits_t xGroupBits = 0;
 
+        for( xRound = 0; xRound <= xLastRound; xRound++ )
+        {
+            const ListItem_t * pxIterator;
+            const ListItem_t * pxEnd;
 
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
+            if( xRound == 0 )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxEnd = ( ( const ListItem_t * ) &( xBoundUDPSocketsList.xListEnd ) );
+            }
 
-#if ( ipconfigUSE_TCP == 1 )
+            #if ipconfigUSE_TCP == 1
+                else
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+                }
+            #endif /* ipconfigUSE_TCP == 1 */
 
-/**
- * @brief Get the connection status. The values correspond to the members
- *        of the enum 'eIPTCPState_t'.
- *
- * @param[in] xSocket Socket to get the connection status from.
- *
- * @return The connection status or an error code.
- *
- * @note For internal use only.
- */
-    BaseType_t FreeRTOS_connstatus( ConstSocket_t xSocket )
-    {
-        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xReturn;
+            for( pxIterator = listGET_NEXT( pxEnd );
+                 pxIterator != pxEnd;
+                 pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
 
-        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
-        {
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
-        }
-        else
-        {
-            /* Cast it to BaseType_t. */
-            xReturn = ( BaseType_t ) ( pxSocket->u.xTCP.eTCPState );
-        }
+                if( pxSocket->pxSocketSet != pxSocketSet )
+                {
+                    /* Socket does not belong to this select group. */
+                    continue;
+                }
 
-        return xReturn;
-    }
+                xSocketBits = 0;
 
+                #if ( ipconfigUSE_TCP == 1 )
+                    if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+                    {
+                        xSocketBits |= vSocketSelectTCP( pxSocket );
+                    }
+                    else
+                #endif /* ipconfigUSE_TCP == 1 */
+                {
+                    /* Select events for UDP are simpler. */
+                    if( ( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != 0U ) &&
+                        ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
+                    {
+                        xSocketBits |= ( EventBits_t ) eSELECT_READ;
+                    }
 
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
+                    /* The WRITE and EXCEPT bits are not used for UDP */
+                } /* if( pxSocket->ucProtocol == FREERTOS_IPPROTO_TCP ) */
 
-#if ( ipconfigUSE_TCP == 1 )
+                /* Each socket keeps its own event flags, which are looked-up
+                 * by FreeRTOS_FD_ISSSET() */
+                pxSocket->xSocketBits = xSocketBits;
 
-/**
- * @brief Returns the number of bytes which can be read from the RX stream buffer.
- *
- * @param[in] xSocket the socket to get the number of bytes from.
- *
- * @return Returns the number of bytes which can be read. Or an error
- *         code is returned.
- */
-    BaseType_t FreeRTOS_rx_size( ConstSocket_t xSocket )
-    {
-        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xReturn;
+                /* The ORed value will be used to set the bits in the event
+                 * group. */
+                xGroupBits |= xSocketBits;
+            } /* for( pxIterator ... ) */
+        }     /* for( xRound = 0; xRound <= xLastRound; xRound++ ) */
 
-        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
-        {
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
-        }
-        else if( pxSocket->u.xTCP.rxStream != NULL )
+        xBitsToClear = xEventGroupGetBits( pxSocketSet->xSelectGroup );
+
+        /* Now set the necessary bits. */
+        xBitsToClear = ( xBitsToClear & ~xGroupBits ) & ( ( EventBits_t ) eSELECT_ALL );
+
+        #if ( ipconfigSUPPORT_SIGNALS != 0 )
         {
-            xReturn = ( BaseType_t ) uxStreamBufferGetSize( pxSocket->u.xTCP.rxStream );
+            /* Maybe the socketset was signalled, but don't
+             * clear the 'eSELECT_INTR' bit here, as it will be used
+             * and cleared in FreeRTOS_select(). */
+            xBitsToClear &= ~( ( EventBits_t ) eSELECT_INTR );
         }
-        else
+        #endif /* ipconfigSUPPORT_SIGNALS */
+
+        if( xBitsToClear != 0U )
         {
-            xReturn = 0;
+            ( void ) xEventGroupClearBits( pxSocketSet->xSelectGroup, xBitsToClear );
         }
 
-        return xReturn;
+        /* Now include eSELECT_CALL_IP to wakeup the caller. */
+        ( void ) xEventGroupSetBits( pxSocketSet->xSelectGroup, xGroupBits | ( EventBits_t ) eSELECT_CALL_IP );
     }
 
 
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
-
-/**
- * @brief Check whether a given socket is valid or not. Validity is defined
- *        as the socket not being NULL and not being Invalid.
- * @param[in] xSocket The socket to be checked.
- * @return pdTRUE if the socket is valid, else pdFALSE.
- *
- */
-BaseType_t xSocketValid( const ConstSocket_t xSocket )
-{
-    BaseType_t xReturnValue = pdFALSE;
-
-    /*
-     * There are two values which can indicate an invalid socket:
-     * FREERTOS_INVALID_SOCKET and NULL.  In order to compare against
-     * both values, the code cannot be compliant with rule 11.4,
-     * hence the Coverity suppression statement below.
-     */
-
-    /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
-    /* coverity[misra_c_2012_rule_11_4_violation] */
-    if( ( xSocket != FREERTOS_INVALID_SOCKET ) && ( xSocket != NULL ) )
-    {
-        xReturnValue = pdTRUE;
-    }
-
-    return xReturnValue;
-}
+#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
 /*-----------------------------------------------------------*/
 
-#if 0
+#if ( ipconfigSUPPORT_SIGNALS != 0 )
 
 /**
- * @brief Returns the number of packets that are stored in a UDP socket.
+ * @brief Send a signal to the task which reads from this socket.
+ *        The socket will receive an event of the type 'eSOCKET_INTR'.
+ *        Any ongoing blocking API ( e.g. FreeRTOS_recv() ) will be terminated
+ *        and return the value -pdFREERTOS_ERRNO_EINTR ( -4 ).
  *
- * @param[in] xSocket the socket to get the number of bytes from.
+ * @param[in] xSocket The socket that will be signalled.
  *
- * @return Returns the number of packets that are stored.  Use FreeRTOS_recvfrom()
- *         to retrieve those packets.
+ * @return If xSocket is an invalid socket (NULL) or if the socket set is invalid (NULL)
+ *         and/or if event group is invalid/not created, then, -pdFREERTOS_ERRNO_EINVAL
+ *         is returned. On successful sending of a signal, 0 is returned.
  */
-    BaseType_t FreeRTOS_udp_rx_size( Socket_t xSocket )
+    BaseType_t FreeRTOS_SignalSocket( Socket_t xSocket )
     {
-        BaseType_t xReturn = 0;
-        const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        BaseType_t xReturn;
 
-        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+        if( pxSocket == NULL )
         {
-            xReturn = ( BaseType_t ) listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
         }
         else
+        #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+            if( ( pxSocket->pxSocketSet != NULL ) && ( pxSocket->pxSocketSet->xSelectGroup != NULL ) )
+            {
+                ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_INTR );
+                xReturn = 0;
+            }
+            else
+        #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
+        #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+            if( pxSocket->xEventGroup == NULL )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            }
+            else
+        #endif
         {
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            vSocketEventSet( pxSocket, ( EventBits_t ) eSOCKET_INTR );
+            xReturn = 0;
         }
 
         return xReturn;
     }
-#endif /* 0 */
-
-#if ( ipconfigUSE_TCP == 1 )
-
-/**
- * @brief Get the net status. The IP-task will print a summary of all sockets and
- *        their connections.
- */
-    void FreeRTOS_netstat( void )
-    {
-        IPStackEvent_t xAskEvent;
-
-        /* Ask the IP-task to call vTCPNetStat()
-         * to avoid accessing xBoundTCPSocketsList
-         */
-        xAskEvent.eEventType = eTCPNetStat;
-        xAskEvent.pvData = ( void * ) NULL;
-        ( void ) xSendEventStructToIPTask( &xAskEvent, pdMS_TO_TICKS( 1000U ) );
-    }
-
-#endif /* ipconfigUSE_TCP */
-/*-----------------------------------------------------------*/
-
-/**
- * @brief Set the value of the SocketID of a socket.
- * @param[in] xSocket The socket whose ID should be set.
- * @param[in] pvSocketID The new value for the SocketID.
- * @return Zero if the socket was valid, otherwise -EINVAL.
- */
-BaseType_t xSocketSetSocketID( const Socket_t xSocket,
-                               void * pvSocketID )
-{
-    FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-    BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
-
-    if( xSocketValid( pxSocket ) == pdTRUE )
-    {
-        xReturn = 0;
-        pxSocket->pvSocketID = pvSocketID;
-    }
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-/**
- * @brief Retrieve the SocketID that is associated with a socket.
- * @param[in] xSocket The socket whose ID should be returned.
- * @return The current value of pvSocketID, or NULL in case
- *         the socket pointer is not valid or when the ID was not
- *         yet set.
- */
-void * pvSocketGetSocketID( const ConstSocket_t xSocket )
-{
-    const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-    void * pvReturn = NULL;
-
-    if( xSocketValid( pxSocket ) == pdTRUE )
-    {
-        pvReturn = pxSocket->pvSocketID;
-    }
-
-    return pvReturn;
-}
-/*-----------------------------------------------------------*/
-
-/**
- * @brief Get the version of IP: either 'ipTYPE_IPv4' or 'ipTYPE_IPv6'.
- *
- * @param[in] xSocket  The socket to be checked.
- *
- * @return Either ipTYPE_IPv4 or ipTYPE_IPv6.
- */
-BaseType_t FreeRTOS_GetIPType( ConstSocket_t xSocket )
-{
-    const FreeRTOS_Socket_t * pxSocket = ( const FreeRTOS_Socket_t * ) xSocket;
-    BaseType_t xResult = ( BaseType_t ) ipTYPE_IPv4;
-
-    switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
-    {
-        #if ( ipconfigUSE_IPv4 != 0 )
-            case pdFALSE_UNSIGNED:
-                xResult = ( BaseType_t ) ipTYPE_IPv4;
-                break;
-        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
-
-        #if ( ipconfigUSE_IPv6 != 0 )
-            case pdTRUE_UNSIGNED:
-                xResult = ( BaseType_t ) ipTYPE_IPv6;
-                break;
-        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
-
-        default:
-            /* MISRA 16.4 Compliance */
-            break;
-    }
 
-    return xResult;
-}
+#endif /* ipconfigSUPPORT_SIGNALS */
 /*-----------------------------------------------------------*/
 
-#if ( ( ipconfigHAS_PRINTF != 0 ) && ( ipconfigUSE_TCP == 1 ) )
+#if ( ipconfigSUPPORT_SIGNALS != 0 )
 
 /**
- * @brief A helper function of vTCPNetStat(), see below.
+ * @brief The same as 'FreeRTOS_SignalSocket()', except that this function should
+ *        be called from an ISR context.
  *
- * @param[in] pxSocket The socket that needs logging.
+ * @param[in] xSocket The socket that will be signalled.
+ * @param[in,out] pxHigherPriorityTaskWoken will be set to non-zero in case a higher-
+ *                priority task has become runnable.
  */
-    static void vTCPNetStat_TCPSocket( const FreeRTOS_Socket_t * pxSocket )
+    BaseType_t FreeRTOS_SignalSocketFromISR( Socket_t xSocket,
+                                             BaseType_t * pxHigherPriorityTaskWoken )
     {
-        char pcRemoteIp[ 40 ];
-        int xIPWidth = 32;
-
-        #if ( ipconfigTCP_KEEP_ALIVE == 1 )
-            TickType_t age = xTaskGetTickCount() - pxSocket->u.xTCP.xLastAliveTime;
-        #else
-            TickType_t age = 0U;
-        #endif
-
-        char ucChildText[ 16 ] = "";
-
-        if( pxSocket->u.xTCP.eTCPState == ( uint8_t ) eTCP_LISTEN )
-        {
-            /* Using function "snprintf". */
-            const int32_t copied_len = snprintf( ucChildText, sizeof( ucChildText ), " %d/%d",
-                                                 pxSocket->u.xTCP.usChildCount,
-                                                 pxSocket->u.xTCP.usBacklog );
-            ( void ) copied_len;
-            /* These should never evaluate to false since the buffers are both shorter than 5-6 characters (<=65535) */
-            configASSERT( copied_len >= 0 );                                /* LCOV_EXCL_BR_LINE the 'taken' branch will never execute. See the above comment. */
-            configASSERT( copied_len < ( int32_t ) sizeof( ucChildText ) ); /* LCOV_EXCL_BR_LINE the 'taken' branch will never execute. See the above comment. */
-        }
-
-        if( age > 999999U )
-        {
-            age = 999999U;
-        }
-
-        switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is not counted. */
-        {
-            #if ( ipconfigUSE_IPv4 != 0 )
-                case pdFALSE_UNSIGNED:
-                    ( void ) snprintf( pcRemoteIp, sizeof( pcRemoteIp ), "%xip", ( unsigned ) pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 );
-                    break;
-            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
-
-            #if ( ipconfigUSE_IPv6 != 0 )
-                case pdTRUE_UNSIGNED:
-                    ( void ) snprintf( pcRemoteIp,
-                                       sizeof( pcRemoteIp ),
-                                       "%pip", ( void * ) pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes );
-                    break;
-            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        BaseType_t xReturn;
+        IPStackEvent_t xEvent;
 
-            default:
-                /* MISRA 16.4 Compliance */
-                break;
-        }
+        configASSERT( pxSocket != NULL );
+        configASSERT( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP );
+        #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+            configASSERT( pxSocket->xEventGroup != NULL );
+        #endif
 
-        FreeRTOS_printf( ( "TCP %5d %-*s:%5d %d/%d %-13.13s %6u %6u%s\n",
-                           pxSocket->usLocalPort,         /* Local port on this machine */
-                           xIPWidth,
-                           pcRemoteIp,                    /* IP address of remote machine */
-                           pxSocket->u.xTCP.usRemotePort, /* Port on remote machine */
-                           ( pxSocket->u.xTCP.rxStream != NULL ) ? 1 : 0,
-                           ( pxSocket->u.xTCP.txStream != NULL ) ? 1 : 0,
-                           FreeRTOS_GetTCPStateName( pxSocket->u.xTCP.eTCPState ),
-                           ( unsigned ) ( ( age > 999999U ) ? 999999U : age ), /* Format 'age' for printing */
-                           pxSocket->u.xTCP.usTimeout,
-                           ucChildText ) );
+        xEvent.eEventType = eSocketSignalEvent;
+        xEvent.pvData = pxSocket;
+        ipSTAMP_IP_TASK_EVENT( xEvent );
+
+        /* The IP-task will call FreeRTOS_SignalSocket for this socket. */
+        xReturn = xQueueSendToBackFromISR( xNetworkEventQueue, &xEvent, pxHigherPriorityTaskWoken );
+
+        return xReturn;
     }
 
-#endif /* ( ( ipconfigHAS_PRINTF != 0 ) && ( ipconfigUSE_TCP == 1 ) ) */
+#endif /* ipconfigSUPPORT_SIGNALS */
+/*-----------------------------------------------------------*/
 
-#if ( ( ipconfigHAS_PRINTF != 0 ) && ( ipconfigUSE_TCP == 1 ) )
+#if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+
+/** @brief The bit in 'xCompletionGroup' that is set when completions were added. */
+    #define socketASYNC_COMPLETED    ( ( EventBits_t ) 0x01U )
 
 /**
- * @brief Print a summary of all sockets and their connections.
+ * @brief Create a ring for asynchronous socket operations.
+ *
+ * @return The new ring, or NULL when there was not enough memory.
  */
-    void vTCPNetStat( void )
+    AsyncRing_t FreeRTOS_CreateAsyncRing( void )
     {
-        /* Show a simple listing of all created sockets and their connections */
-        const ListItem_t * pxIterator;
-        BaseType_t count = 0;
-        size_t uxMinimum = uxGetMinimumFreeNetworkBuffers();
-        size_t uxCurrent = uxGetNumberOfFreeNetworkBuffers();
+        SocketAsyncRing_t * pxRing;
 
-        if( !listLIST_IS_INITIALISED( &xBoundTCPSocketsList ) )
-        {
-            FreeRTOS_printf( ( "PLUS-TCP not initialized\n" ) );
-        }
-        else
-        {
-            /* Casting a "MiniListItem_t" to a "ListItem_t".
-             * This is safe because only its address is being accessed, not its fields. */
-            const ListItem_t * pxEndTCP = listGET_END_MARKER( &xBoundTCPSocketsList );
-            const ListItem_t * pxEndUDP = listGET_END_MARKER( &xBoundUDPSocketsList );
+        /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
+        /* coverity[misra_c_2012_directive_4_12_violation] */
+        pxRing = ( ( SocketAsyncRing_t * ) pvPortMalloc( sizeof( *pxRing ) ) );
 
-            FreeRTOS_printf( ( "Prot Port IP-Remote       : Port  R/T Status       Alive  tmout Child\n" ) );
+        if( pxRing != NULL )
+        {
+            ( void ) memset( pxRing, 0, sizeof( *pxRing ) );
+            pxRing->xCompletionGroup = xEventGroupCreate();
 
-            for( pxIterator = listGET_HEAD_ENTRY( &xBoundTCPSocketsList );
-                 pxIterator != pxEndTCP;
-                 pxIterator = listGET_NEXT( pxIterator ) )
+            if( pxRing->xCompletionGroup == NULL )
             {
-                const FreeRTOS_Socket_t * pxSocket = ( ( const FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
-                vTCPNetStat_TCPSocket( pxSocket );
-                count++;
+                vPortFree( pxRing );
+                pxRing = NULL;
             }
+        }
 
-            for( pxIterator = listGET_HEAD_ENTRY( &xBoundUDPSocketsList );
-                 pxIterator != pxEndUDP;
-                 pxIterator = listGET_NEXT( pxIterator ) )
+        return ( AsyncRing_t ) pxRing;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Delete a ring.  The IP-task will drop the requests that are still
+ *        in flight and free the ring.  Completions that were not yet
+ *        collected are lost.
+ *
+ * @param[in] xRing The ring to be deleted.
+ */
+    void FreeRTOS_DeleteAsyncRing( AsyncRing_t xRing )
+    {
+        SocketAsyncRing_t * pxRing = ( SocketAsyncRing_t * ) xRing;
+
+        if( pxRing != NULL )
+        {
+            if( prvAsyncSendEvent( pxRing, pdTRUE, portMAX_DELAY ) != pdPASS )
             {
-                /* Local port on this machine */
-                FreeRTOS_printf( ( "UDP Port %5u\n",
-                                   FreeRTOS_ntohs( listGET_LIST_ITEM_VALUE( pxIterator ) ) ) );
-                count++;
+                FreeRTOS_printf( ( "FreeRTOS_DeleteAsyncRing: xSendEventStructToIPTask failed\n" ) );
             }
-
-            FreeRTOS_printf( ( "FreeRTOS_netstat: %d sockets %u < %u < %u buffers free\n",
-                               ( int ) count,
-                               ( unsigned ) uxMinimum,
-                               ( unsigned ) uxCurrent,
-                               ( unsigned ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ) );
         }
     }
-
-#endif /* ( ( ipconfigHAS_PRINTF != 0 ) && ( ipconfigUSE_TCP == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-
-    #if ( ipconfigUSE_TCP == 1 )
-
 /**
- * @brief This internal function will check if a given TCP
- *        socket has had any select event, either READ, WRITE,
- *        or EXCEPT.
+ * @brief Submit requests to a ring.  The call does not block: the requests
+ *        are carried out by the IP-task, and their results are collected
+ *        with FreeRTOS_AsyncComplete().
  *
- * @param[in] pxSocket The socket which needs to be checked.
- * @return An event mask of events that are active for this socket.
+ * @param[in] xRing The ring.
+ * @param[in] pxRequests The requests to be submitted.
+ * @param[in] xCount The number of requests in pxRequests.
+ *
+ * @return The number of requests accepted.  This is less than xCount when
+ *         ipconfigASYNC_RING_LENGTH results have not been collected yet.
  */
-        static EventBits_t vSocketSelectTCP( FreeRTOS_Socket_t * pxSocket )
+    BaseType_t FreeRTOS_AsyncSubmit( AsyncRing_t xRing,
+                                     const FreeRTOS_AsyncRequest_t * pxRequests,
+                                     BaseType_t xCount )
+    {
+        SocketAsyncRing_t * pxRing = ( SocketAsyncRing_t * ) xRing;
+        BaseType_t xAccepted = 0;
+        size_t uxHead;
+
+        #if ( ipconfigUSE_TCP == 1 )
+            FreeRTOS_Socket_t * pxSocket;
+        #endif
+
+        /* The IP-task can not wait for itself. */
+        configASSERT( xIsCallingFromIPTask() == pdFALSE );
+
+        if( ( pxRing != NULL ) && ( pxRequests != NULL ) )
         {
-            /* Check if the TCP socket has already been accepted by
-             * the owner.  If not, it is useless to return it from a
-             * select(). */
-            BaseType_t bAccepted = pdFALSE;
-            EventBits_t xSocketBits = 0U;
+            uxHead = pxRing->uxSubmitHead;
 
-            if( pxSocket->u.xTCP.bits.bPassQueued == pdFALSE_UNSIGNED )
+            /* As long as a result can be stored, accept the request. */
+            while( ( xAccepted < xCount ) && ( pxRing->uxOutstanding < ( size_t ) ipconfigASYNC_RING_LENGTH ) )
             {
-                if( pxSocket->u.xTCP.bits.bPassAccept == pdFALSE_UNSIGNED )
+                #if ( ipconfigUSE_TCP == 1 )
                 {
-                    bAccepted = pdTRUE;
-                }
-            }
+                    pxSocket = ( FreeRTOS_Socket_t * ) pxRequests[ xAccepted ].xSocket;
 
-            /* Is the set owner interested in READ events? */
-            if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != ( EventBits_t ) 0U )
-            {
-                if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
-                {
-                    if( ( pxSocket->u.xTCP.pxPeerSocket != NULL ) && ( pxSocket->u.xTCP.pxPeerSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) )
+                    if( ( pxRequests[ xAccepted ].eOperation == eAsyncConnect ) &&
+                        ( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE ) &&
+                        ( !socketSOCKET_IS_BOUND( pxSocket ) ) )
                     {
-                        xSocketBits |= ( EventBits_t ) eSELECT_READ;
+                        /* FreeRTOS_bind() must not be called by the IP-task,
+                         * bind the socket here like FreeRTOS_connect() would. */
+                        ( void ) FreeRTOS_bind( pxSocket, NULL, 0U );
                     }
                 }
-                else if( ( pxSocket->u.xTCP.bits.bReuseSocket != pdFALSE_UNSIGNED ) && ( pxSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) )
-                {
-                    /* This socket has the re-use flag. After connecting it turns into
-                     * a connected socket. Set the READ event, so that accept() will be called. */
-                    xSocketBits |= ( EventBits_t ) eSELECT_READ;
-                }
-                else if( ( bAccepted != 0 ) && ( FreeRTOS_recvcount( pxSocket ) > 0 ) )
-                {
-                    xSocketBits |= ( EventBits_t ) eSELECT_READ;
-                }
-                else
-                {
-                    /* Nothing. */
-                }
+                #endif /* ipconfigUSE_TCP */
+
+                ( void ) memcpy( &( pxRing->xSubmissions[ uxHead % ( size_t ) ipconfigASYNC_RING_LENGTH ] ),
+                                 &( pxRequests[ xAccepted ] ),
+                                 sizeof( pxRing->xSubmissions[ 0 ] ) );
+                uxHead++;
+                pxRing->uxOutstanding++;
+                xAccepted++;
             }
 
-            /* Is the set owner interested in EXCEPTION events? */
-            if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_EXCEPT ) != 0U )
+            if( xAccepted > 0 )
             {
-                if( ( pxSocket->u.xTCP.eTCPState == eCLOSE_WAIT ) || ( pxSocket->u.xTCP.eTCPState == eCLOSED ) )
+                taskENTER_CRITICAL();
                 {
-                    xSocketBits |= ( EventBits_t ) eSELECT_EXCEPT;
+                    pxRing->uxSubmitHead = uxHead;
                 }
+                taskEXIT_CRITICAL();
+
+                ( void ) prvAsyncSendEvent( pxRing, pdFALSE, portMAX_DELAY );
             }
+        }
 
-            /* Is the set owner interested in WRITE events? */
-            if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_WRITE ) != 0U )
+        return xAccepted;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Collect the results of the requests that have completed.
+ *
+ * @param[in] xRing The ring.
+ * @param[out] pxCompletions Where the results will be stored.
+ * @param[in] xMaxCount The number of entries in pxCompletions.
+ * @param[in] xBlockTimeTicks The maximum time to wait for the first result.
+ *
+ * @return The number of results stored in pxCompletions.
+ */
+    BaseType_t FreeRTOS_AsyncComplete( AsyncRing_t xRing,
+                                       FreeRTOS_AsyncCompletion_t * pxCompletions,
+                                       BaseType_t xMaxCount,
+                                       TickType_t xBlockTimeTicks )
+    {
+        SocketAsyncRing_t * pxRing = ( SocketAsyncRing_t * ) xRing;
+        BaseType_t xCollected = 0;
+        TickType_t xRemainingTime = xBlockTimeTicks;
+        TimeOut_t xTimeOut;
+        size_t uxTail;
+
+        if( ( pxRing != NULL ) && ( pxCompletions != NULL ) && ( xMaxCount > 0 ) )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            for( ; ; )
             {
-                BaseType_t bMatch = pdFALSE;
+                /* Clear the bit before looking, so a completion that is added
+                 * in the mean time will not be missed. */
+                ( void ) xEventGroupClearBits( pxRing->xCompletionGroup, socketASYNC_COMPLETED );
 
-                if( bAccepted != 0 )
+                uxTail = pxRing->uxCompleteTail;
+
+                while( ( xCollected < xMaxCount ) && ( uxTail != pxRing->uxCompleteHead ) )
                 {
-                    if( FreeRTOS_tx_space( pxSocket ) > 0 )
-                    {
-                        bMatch = pdTRUE;
-                    }
+                    ( void ) memcpy( &( pxCompletions[ xCollected ] ),
+                                     &( pxRing->xCompletions[ uxTail % ( size_t ) ipconfigASYNC_RING_LENGTH ] ),
+                                     sizeof( pxCompletions[ 0 ] ) );
+                    uxTail++;
+                    xCollected++;
                 }
 
-                if( bMatch == pdFALSE )
+                if( xCollected > 0 )
                 {
-                    if( ( pxSocket->u.xTCP.bits.bConnPrepared != pdFALSE_UNSIGNED ) &&
-                        ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) &&
-                        ( pxSocket->u.xTCP.bits.bConnPassed == pdFALSE_UNSIGNED ) )
+                    taskENTER_CRITICAL();
                     {
-                        pxSocket->u.xTCP.bits.bConnPassed = pdTRUE_UNSIGNED;
-                        bMatch = pdTRUE;
+                        pxRing->uxCompleteTail = uxTail;
                     }
+                    taskEXIT_CRITICAL();
+
+                    pxRing->uxOutstanding -= ( size_t ) xCollected;
+                    break;
                 }
 
-                if( bMatch != pdFALSE )
+                if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
                 {
-                    xSocketBits |= ( EventBits_t ) eSELECT_WRITE;
+                    break;
+                }
+
+                ( void ) xEventGroupWaitBits( pxRing->xCompletionGroup, socketASYNC_COMPLETED, pdFALSE, pdFALSE, xRemainingTime );
+            }
+        }
+
+        return xCollected;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send an eSocketAsyncEvent for a ring, unless one is waiting already.
+ *
+ * @param[in] pxRing The ring.
+ * @param[in] xDelete pdTRUE when the ring must be deleted.
+ * @param[in] uxTimeout The maximum time to wait for space in the event queue.
+ *
+ * @return pdPASS when the IP-task will look at the ring.
+ */
+    static BaseType_t prvAsyncSendEvent( SocketAsyncRing_t * pxRing,
+                                         BaseType_t xDelete,
+                                         TickType_t uxTimeout )
+    {
+        IPStackEvent_t xEvent;
+        BaseType_t xMustSend = pdFALSE;
+        BaseType_t xReturn = pdPASS;
+
+        taskENTER_CRITICAL();
+        {
+            if( xDelete != pdFALSE )
+            {
+                pxRing->xDeleteRequested = pdTRUE;
+            }
+
+            if( pxRing->uxEventsQueued == 0U )
+            {
+                pxRing->uxEventsQueued++;
+                xMustSend = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xMustSend != pdFALSE )
+        {
+            xEvent.eEventType = eSocketAsyncEvent;
+            xEvent.pvData = pxRing;
+            xReturn = xSendEventStructToIPTask( &xEvent, uxTimeout );
+
+            if( xReturn != pdPASS )
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxRing->uxEventsQueued--;
                 }
+                taskEXIT_CRITICAL();
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task when an attached socket has an event, the
+ *        requests that wait for it will be looked at again.
+ *
+ * @param[in] pxSocket The socket.
+ */
+    void vSocketAsyncWakeUp( const FreeRTOS_Socket_t * pxSocket )
+    {
+        /* Called from the IP-task, which can not wait for its own queue. */
+        ( void ) prvAsyncSendEvent( pxSocket->pxAsyncRing, pdFALSE, 0U );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store the result of a request in the completions of a ring.
+ *        There is always space, as the number of outstanding requests is
+ *        limited to ipconfigASYNC_RING_LENGTH.
+ *
+ * @param[in] pxRing The ring.
+ * @param[in] pxRequest The request that completed.
+ * @param[in] xSocket The socket of the result, a new socket for eAsyncAccept.
+ * @param[in] lResult The result.
+ * @param[in] pxAddress The address of the peer, or NULL.
+ */
+    static void prvAsyncAddCompletion( SocketAsyncRing_t * pxRing,
+                                       const FreeRTOS_AsyncRequest_t * pxRequest,
+                                       Socket_t xSocket,
+                                       int32_t lResult,
+                                       const struct freertos_sockaddr * pxAddress )
+    {
+        FreeRTOS_AsyncCompletion_t * pxCompletion;
+
+        pxCompletion = &( pxRing->xCompletions[ pxRing->uxCompleteHead % ( size_t ) ipconfigASYNC_RING_LENGTH ] );
+
+        pxCompletion->pvUserData = pxRequest->pvUserData;
+        pxCompletion->eOperation = pxRequest->eOperation;
+        pxCompletion->xSocket = xSocket;
+        pxCompletion->lResult = lResult;
+
+        if( pxAddress != NULL )
+        {
+            ( void ) memcpy( &( pxCompletion->xAddress ), pxAddress, sizeof( pxCompletion->xAddress ) );
+        }
+        else
+        {
+            ( void ) memset( &( pxCompletion->xAddress ), 0, sizeof( pxCompletion->xAddress ) );
+        }
+
+        taskENTER_CRITICAL();
+        {
+            pxRing->uxCompleteHead++;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Complete an entry of xInFlight[] and remove it.  The socket is
+ *        detached from the ring when no other entry refers to it.
+ *
+ * @param[in] pxRing The ring.
+ * @param[in] uxIndex The index of the entry in xInFlight[].
+ * @param[in] xSocket The socket of the result.
+ * @param[in] lResult The result.
+ * @param[in] pxAddress The address of the peer, or NULL.
+ */
+    static void prvAsyncFinish( SocketAsyncRing_t * pxRing,
+                                size_t uxIndex,
+                                Socket_t xSocket,
+                                int32_t lResult,
+                                const struct freertos_sockaddr * pxAddress )
+    {
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) pxRing->xInFlight[ uxIndex ].xRequest.xSocket;
+        size_t uxOther;
+        BaseType_t xInUse = pdFALSE;
+
+        prvAsyncAddCompletion( pxRing, &( pxRing->xInFlight[ uxIndex ].xRequest ), xSocket, lResult, pxAddress );
+
+        /* Keep the order of the remaining entries. */
+        for( uxOther = uxIndex + 1U; uxOther < pxRing->uxInFlightCount; uxOther++ )
+        {
+            ( void ) memcpy( &( pxRing->xInFlight[ uxOther - 1U ] ), &( pxRing->xInFlight[ uxOther ] ), sizeof( pxRing->xInFlight[ 0 ] ) );
+        }
+
+        pxRing->uxInFlightCount--;
+
+        for( uxOther = 0U; uxOther < pxRing->uxInFlightCount; uxOther++ )
+        {
+            if( pxRing->xInFlight[ uxOther ].xRequest.xSocket == ( Socket_t ) pxSocket )
+            {
+                xInUse = pdTRUE;
+                break;
             }
+        }
+
+        if( xInUse == pdFALSE )
+        {
+            pxSocket->pxAsyncRing = NULL;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by vSocketClose(): complete the requests that still wait
+ *        for the socket with -pdFREERTOS_ERRNO_ECANCELED.
+ *
+ * @param[in] pxSocket The socket that is being closed.
+ */
+    static void prvAsyncCancelSocket( FreeRTOS_Socket_t * pxSocket )
+    {
+        SocketAsyncRing_t * pxRing = pxSocket->pxAsyncRing;
+        size_t uxIndex = 0U;
+        BaseType_t xCompleted = pdFALSE;
 
-            return xSocketBits;
+        while( uxIndex < pxRing->uxInFlightCount )
+        {
+            if( pxRing->xInFlight[ uxIndex ].xRequest.xSocket == ( Socket_t ) pxSocket )
+            {
+                /* The entry is removed, the next one moves to uxIndex. */
+                prvAsyncFinish( pxRing, uxIndex, ( Socket_t ) pxSocket, -pdFREERTOS_ERRNO_ECANCELED, NULL );
+                xCompleted = pdTRUE;
+            }
+            else
+            {
+                uxIndex++;
+            }
         }
 
-    #endif /* ( ipconfigUSE_TCP == 1 ) */
+        pxSocket->pxAsyncRing = NULL;
+
+        if( xCompleted != pdFALSE )
+        {
+            ( void ) xEventGroupSetBits( pxRing->xCompletionGroup, socketASYNC_COMPLETED );
+        }
+    }
+/*-----------------------------------------------------------*/
 
 /**
- * @brief This internal non-blocking function will check all sockets that belong
- *        to a select set.  The events bits of each socket will be updated, and it
- *        will check if an ongoing select() call must be interrupted because of an
- *        event has occurred.
+ * @brief Try to carry out a request without blocking.
  *
- * @param[in] pxSocketSet The socket-set which is to be waited on for change.
+ * @param[in] pxEntry The request.
+ * @param[out] plResult The result, when the request is done.
+ * @param[out] pxResultSocket The socket of the result, when the request is done.
+ * @param[out] pxAddress The address of the peer, when the request is done.
+ *
+ * @return pdTRUE when the request is done, pdFALSE when it must wait for an
+ *         event of its socket.
  */
-    void vSocketSelect( const SocketSelect_t * pxSocketSet )
+    static BaseType_t prvAsyncTry( AsyncInFlight_t * pxEntry,
+                                   int32_t * plResult,
+                                   Socket_t * pxResultSocket,
+                                   struct freertos_sockaddr * pxAddress )
     {
-        BaseType_t xRound;
-        EventBits_t xSocketBits, xBitsToClear;
-
-        #if ipconfigUSE_TCP == 1
-            BaseType_t xLastRound = 1;
-        #else
-            BaseType_t xLastRound = 0;
-        #endif
+        FreeRTOS_AsyncRequest_t * pxRequest = &( pxEntry->xRequest );
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) pxRequest->xSocket;
+        BaseType_t xDone = pdTRUE;
+        int32_t lResult = -pdFREERTOS_ERRNO_EOPNOTSUPP;
+        socklen_t uxAddressLength = ( socklen_t ) sizeof( *pxAddress );
 
-        /* These flags will be switched on after checking the socket status. */
-        EventBits_t xGroupBits = 0;
+        *pxResultSocket = pxRequest->xSocket;
+        ( void ) memset( pxAddress, 0, sizeof( *pxAddress ) );
 
-        for( xRound = 0; xRound <= xLastRound; xRound++ )
+        if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
         {
-            const ListItem_t * pxIterator;
-            const ListItem_t * pxEnd;
-
-            if( xRound == 0 )
+            if( pxRequest->eOperation == eAsyncSend )
             {
-                /* MISRA Ref 11.3.1 [Misaligned access] */
-                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-                /* coverity[misra_c_2012_rule_11_3_violation] */
-                pxEnd = ( ( const ListItem_t * ) &( xBoundUDPSocketsList.xListEnd ) );
+                lResult = FreeRTOS_sendto( pxRequest->xSocket, pxRequest->pvBuffer, pxRequest->uxLength, FREERTOS_MSG_DONTWAIT,
+                                           &( pxRequest->xAddress ), ( socklen_t ) sizeof( pxRequest->xAddress ) );
             }
+            else if( pxRequest->eOperation == eAsyncRecv )
+            {
+                lResult = FreeRTOS_recvfrom( pxRequest->xSocket, pxRequest->pvBuffer, pxRequest->uxLength, FREERTOS_MSG_DONTWAIT,
+                                             pxAddress, &( uxAddressLength ) );
 
-            #if ipconfigUSE_TCP == 1
-                else
+                if( lResult == -pdFREERTOS_ERRNO_EWOULDBLOCK )
                 {
-                    /* MISRA Ref 11.3.1 [Misaligned access] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-                    /* coverity[misra_c_2012_rule_11_3_violation] */
-                    pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+                    xDone = pdFALSE;
                 }
-            #endif /* ipconfigUSE_TCP == 1 */
+            }
+            else
+            {
+                /* eAsyncConnect and eAsyncAccept are for TCP only. */
+            }
+        }
 
-            for( pxIterator = listGET_NEXT( pxEnd );
-                 pxIterator != pxEnd;
-                 pxIterator = listGET_NEXT( pxIterator ) )
+        #if ( ipconfigUSE_TCP == 1 )
+            else
             {
-                FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                FreeRTOS_Socket_t * pxClientSocket;
+                BaseType_t xResult;
 
-                if( pxSocket->pxSocketSet != pxSocketSet )
+                switch( pxRequest->eOperation )
                 {
-                    /* Socket does not belong to this select group. */
-                    continue;
-                }
+                    case eAsyncConnect:
 
-                xSocketBits = 0;
+                        if( pxEntry->xStarted == pdFALSE )
+                        {
+                            if( !socketSOCKET_IS_BOUND( pxSocket ) )
+                            {
+                                /* FreeRTOS_AsyncSubmit() failed to bind it. */
+                                lResult = -pdFREERTOS_ERRNO_EINVAL;
+                            }
+                            else
+                            {
+                                lResult = ( int32_t ) prvTCPConnectStart( pxSocket, &( pxRequest->xAddress ) );
+
+                                if( lResult == 0 )
+                                {
+                                    pxEntry->xStarted = pdTRUE;
+                                    xDone = pdFALSE;
+                                }
+                            }
+                        }
+                        else if( FreeRTOS_issocketconnected( pxSocket ) > 0 )
+                        {
+                            lResult = 0;
+                        }
+                        else if( ( pxSocket->u.xTCP.eTCPState == eCLOSED ) ||
+                                 ( pxSocket->u.xTCP.eTCPState >= eCLOSE_WAIT ) )
+                        {
+                            /* The connection was refused or timed out. */
+                            lResult = -pdFREERTOS_ERRNO_ENOTCONN;
+                        }
+                        else
+                        {
+                            xDone = pdFALSE;
+                        }
 
-                #if ( ipconfigUSE_TCP == 1 )
-                    if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
-                    {
-                        xSocketBits |= vSocketSelectTCP( pxSocket );
-                    }
-                    else
-                #endif /* ipconfigUSE_TCP == 1 */
-                {
-                    /* Select events for UDP are simpler. */
-                    if( ( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != 0U ) &&
-                        ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
-                    {
-                        xSocketBits |= ( EventBits_t ) eSELECT_READ;
-                    }
+                        break;
 
-                    /* The WRITE and EXCEPT bits are not used for UDP */
-                } /* if( pxSocket->ucProtocol == FREERTOS_IPPROTO_TCP ) */
+                    case eAsyncAccept:
 
-                /* Each socket keeps its own event flags, which are looked-up
-                 * by FreeRTOS_FD_ISSSET() */
-                pxSocket->xSocketBits = xSocketBits;
+                        if( ( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED ) &&
+                            ( pxSocket->u.xTCP.eTCPState != eTCP_LISTEN ) )
+                        {
+                            /* Parent socket is not in listening mode */
+                            lResult = -pdFREERTOS_ERRNO_EINVAL;
+                        }
+                        else
+                        {
+                            pxClientSocket = prvAcceptWaitClient( pxSocket, pxAddress, NULL );
+
+                            if( pxClientSocket == NULL )
+                            {
+                                xDone = pdFALSE;
+                            }
+                            else
+                            {
+                                #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+                                {
+                                    prvSocketMapAddress( pxClientSocket, pxAddress );
+                                }
+                                #endif
+
+                                #if ( ipconfigTCP_ACCEPT_QUEUE == 0 )
+                                {
+                                    if( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED )
+                                    {
+                                        /* What eTCPAcceptEvent would do for FreeRTOS_accept(). */
+                                        ( void ) xTCPCheckNewClient( pxSocket );
+                                    }
+                                }
+                                #endif
+
+                                /* The listen pool is not refilled here: creating
+                                 * sockets is not allowed in the IP-task. */
+                                *pxResultSocket = ( Socket_t ) pxClientSocket;
+                                lResult = 0;
+                            }
+                        }
 
-                /* The ORed value will be used to set the bits in the event
-                 * group. */
-                xGroupBits |= xSocketBits;
-            } /* for( pxIterator ... ) */
-        }     /* for( xRound = 0; xRound <= xLastRound; xRound++ ) */
+                        break;
 
-        xBitsToClear = xEventGroupGetBits( pxSocketSet->xSelectGroup );
+                    case eAsyncSend:
+                        xResult = FreeRTOS_send( pxRequest->xSocket,
+                                                 &( ( ( const uint8_t * ) pxRequest->pvBuffer )[ pxEntry->uxDone ] ),
+                                                 pxRequest->uxLength - pxEntry->uxDone,
+                                                 FREERTOS_MSG_DONTWAIT );
 
-        /* Now set the necessary bits. */
-        xBitsToClear = ( xBitsToClear & ~xGroupBits ) & ( ( EventBits_t ) eSELECT_ALL );
+                        if( xResult > 0 )
+                        {
+                            pxEntry->uxDone += ( size_t ) xResult;
 
-        #if ( ipconfigSUPPORT_SIGNALS != 0 )
-        {
-            /* Maybe the socketset was signalled, but don't
-             * clear the 'eSELECT_INTR' bit here, as it will be used
-             * and cleared in FreeRTOS_select(). */
-            xBitsToClear &= ~( ( EventBits_t ) eSELECT_INTR );
-        }
-        #endif /* ipconfigSUPPORT_SIGNALS */
+                            /* FreeRTOS_send() does not do this when called by the IP-task. */
+                            ( void ) xSendEventToIPTask( eTCPTimerEvent );
+                        }
 
-        if( xBitsToClear != 0U )
-        {
-            ( void ) xEventGroupClearBits( pxSocketSet->xSelectGroup, xBitsToClear );
-        }
+                        if( ( xResult > 0 ) && ( pxEntry->uxDone < pxRequest->uxLength ) )
+                        {
+                            xDone = pdFALSE;
+                        }
+                        else if( xResult == -pdFREERTOS_ERRNO_ENOSPC )
+                        {
+                            /* Wait for space in the transmission stream. */
+                            xDone = pdFALSE;
+                        }
+                        else if( pxEntry->uxDone > 0U )
+                        {
+                            lResult = ( int32_t ) pxEntry->uxDone;
+                        }
+                        else
+                        {
+                            lResult = ( int32_t ) xResult;
+                        }
 
-        /* Now include eSELECT_CALL_IP to wakeup the caller. */
-        ( void ) xEventGroupSetBits( pxSocketSet->xSelectGroup, xGroupBits | ( EventBits_t ) eSELECT_CALL_IP );
-    }
+                        break;
 
+                    case eAsyncRecv:
+                        lResult = ( int32_t ) FreeRTOS_recv( pxRequest->xSocket, pxRequest->pvBuffer, pxRequest->uxLength, FREERTOS_MSG_DONTWAIT );
 
-#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
-/*-----------------------------------------------------------*/
+                        if( lResult == 0 )
+                        {
+                            xDone = pdFALSE;
+                        }
 
-#if ( ipconfigSUPPORT_SIGNALS != 0 )
+                        break;
+
+                    default:
+                        /* Not expected, eAsyncClose is handled by the caller. */
+                        break;
+                }
+            }
+        #endif /* ipconfigUSE_TCP */
+
+        *plResult = lResult;
+
+        return xDone;
+    }
+/*-----------------------------------------------------------*/
 
 /**
- * @brief Send a signal to the task which reads from this socket.
- *        The socket will receive an event of the type 'eSOCKET_INTR'.
- *        Any ongoing blocking API ( e.g. FreeRTOS_recv() ) will be terminated
- *        and return the value -pdFREERTOS_ERRNO_EINTR ( -4 ).
- *
- * @param[in] xSocket The socket that will be signalled.
+ * @brief Called by the IP-task for an eSocketAsyncEvent: take the new
+ *        submissions and try all requests that are in flight.  Requests on
+ *        the same socket are carried out in the order of submission when
+ *        they are of the same kind, an eAsyncClose waits for all earlier
+ *        requests on its socket.
  *
- * @return If xSocket is an invalid socket (NULL) or if the socket set is invalid (NULL)
- *         and/or if event group is invalid/not created, then, -pdFREERTOS_ERRNO_EINVAL
- *         is returned. On successful sending of a signal, 0 is returned.
+ * @param[in] pxRing The ring.
  */
-    BaseType_t FreeRTOS_SignalSocket( Socket_t xSocket )
+    void vSocketAsyncProcess( SocketAsyncRing_t * pxRing )
     {
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xReturn;
+        AsyncInFlight_t * pxEntry;
+        FreeRTOS_Socket_t * pxSocket;
+        struct freertos_sockaddr xAddress;
+        Socket_t xResultSocket;
+        int32_t lResult;
+        size_t uxIndex;
+        size_t uxEarlier;
+        size_t uxHead;
+        size_t uxTail;
+        size_t uxCompleteHead = pxRing->uxCompleteHead;
+        BaseType_t xDelete;
+        BaseType_t xMustWait;
+        BaseType_t xFreeRing = pdFALSE;
 
-        if( pxSocket == NULL )
+        taskENTER_CRITICAL();
         {
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            pxRing->uxEventsQueued--;
+            xDelete = pxRing->xDeleteRequested;
+            uxHead = pxRing->uxSubmitHead;
         }
-        else
-        #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-            if( ( pxSocket->pxSocketSet != NULL ) && ( pxSocket->pxSocketSet->xSelectGroup != NULL ) )
+        taskEXIT_CRITICAL();
+
+        if( xDelete == pdFALSE )
+        {
+            /* Take the new submissions. */
+            for( uxTail = pxRing->uxSubmitTail; uxTail != uxHead; uxTail++ )
             {
-                ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_INTR );
-                xReturn = 0;
+                const FreeRTOS_AsyncRequest_t * pxRequest = &( pxRing->xSubmissions[ uxTail % ( size_t ) ipconfigASYNC_RING_LENGTH ] );
+
+                pxSocket = ( FreeRTOS_Socket_t * ) pxRequest->xSocket;
+
+                if( xSocketValid( pxRequest->xSocket ) == pdFALSE )
+                {
+                    prvAsyncAddCompletion( pxRing, pxRequest, pxRequest->xSocket, -pdFREERTOS_ERRNO_EBADF, NULL );
+                }
+                else if( ( pxSocket->pxAsyncRing != NULL ) && ( pxSocket->pxAsyncRing != pxRing ) )
+                {
+                    /* A socket can only be used by one ring at a time. */
+                    prvAsyncAddCompletion( pxRing, pxRequest, pxRequest->xSocket, -pdFREERTOS_ERRNO_EBUSY, NULL );
+                }
+                else
+                {
+                    pxSocket->pxAsyncRing = pxRing;
+                    pxEntry = &( pxRing->xInFlight[ pxRing->uxInFlightCount ] );
+                    ( void ) memcpy( &( pxEntry->xRequest ), pxRequest, sizeof( pxEntry->xRequest ) );
+                    pxEntry->uxDone = 0U;
+                    pxEntry->xStarted = pdFALSE;
+                    pxRing->uxInFlightCount++;
+                }
             }
-            else
-        #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
-        if( pxSocket->xEventGroup != NULL )
-        {
-            ( void ) xEventGroupSetBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_INTR );
-            xReturn = 0;
-        }
-        else
-        {
-            xReturn = -pdFREERTOS_ERRNO_EINVAL;
-        }
 
-        return xReturn;
-    }
+            pxRing->uxSubmitTail = uxHead;
 
-#endif /* ipconfigSUPPORT_SIGNALS */
-/*-----------------------------------------------------------*/
+            /* Try the requests in flight, oldest first. */
+            uxIndex = 0U;
 
-#if ( ipconfigSUPPORT_SIGNALS != 0 )
+            while( uxIndex < pxRing->uxInFlightCount )
+            {
+                pxEntry = &( pxRing->xInFlight[ uxIndex ] );
+                pxSocket = ( FreeRTOS_Socket_t * ) pxEntry->xRequest.xSocket;
+                xMustWait = pdFALSE;
 
-/**
- * @brief The same as 'FreeRTOS_SignalSocket()', except that this function should
- *        be called from an ISR context.
- *
- * @param[in] xSocket The socket that will be signalled.
- * @param[in,out] pxHigherPriorityTaskWoken will be set to non-zero in case a higher-
- *                priority task has become runnable.
- */
-    BaseType_t FreeRTOS_SignalSocketFromISR( Socket_t xSocket,
-                                             BaseType_t * pxHigherPriorityTaskWoken )
-    {
-        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
-        BaseType_t xReturn;
-        IPStackEvent_t xEvent;
+                for( uxEarlier = 0U; uxEarlier < uxIndex; uxEarlier++ )
+                {
+                    const FreeRTOS_AsyncRequest_t * pxEarlier = &( pxRing->xInFlight[ uxEarlier ].xRequest );
 
-        configASSERT( pxSocket != NULL );
-        configASSERT( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP );
-        configASSERT( pxSocket->xEventGroup != NULL );
+                    if( ( pxEarlier->xSocket == pxEntry->xRequest.xSocket ) &&
+                        ( ( pxEarlier->eOperation == pxEntry->xRequest.eOperation ) ||
+                          ( pxEarlier->eOperation == eAsyncClose ) ||
+                          ( pxEntry->xRequest.eOperation == eAsyncClose ) ) )
+                    {
+                        xMustWait = pdTRUE;
+                        break;
+                    }
+                }
 
-        xEvent.eEventType = eSocketSignalEvent;
-        xEvent.pvData = pxSocket;
+                if( xMustWait != pdFALSE )
+                {
+                    uxIndex++;
+                }
+                else if( pxEntry->xRequest.eOperation == eAsyncClose )
+                {
+                    /* The requests that were submitted later for the same
+                     * socket will be cancelled by vSocketClose(). */
+                    prvAsyncFinish( pxRing, uxIndex, ( Socket_t ) pxSocket, 0, NULL );
+                    ( void ) vSocketClose( pxSocket );
 
-        /* The IP-task will call FreeRTOS_SignalSocket for this socket. */
-        xReturn = xQueueSendToBackFromISR( xNetworkEventQueue, &xEvent, pxHigherPriorityTaskWoken );
+                    /* The list may have changed, start again. */
+                    uxIndex = 0U;
+                }
+                else if( prvAsyncTry( pxEntry, &( lResult ), &( xResultSocket ), &( xAddress ) ) != pdFALSE )
+                {
+                    if( ( pxEntry->xRequest.eOperation == eAsyncRecv ) || ( pxEntry->xRequest.eOperation == eAsyncAccept ) )
+                    {
+                        prvAsyncFinish( pxRing, uxIndex, xResultSocket, lResult, &( xAddress ) );
+                    }
+                    else
+                    {
+                        prvAsyncFinish( pxRing, uxIndex, xResultSocket, lResult, NULL );
+                    }
+                }
+                else
+                {
+                    uxIndex++;
+                }
+            }
+        }
+        else
+        {
+            /* Drop all requests, the results can not be delivered any more. */
+            for( uxIndex = 0U; uxIndex < pxRing->uxInFlightCount; uxIndex++ )
+            {
+                pxSocket = ( FreeRTOS_Socket_t * ) pxRing->xInFlight[ uxIndex ].xRequest.xSocket;
+                pxSocket->pxAsyncRing = NULL;
+            }
 
-        return xReturn;
+            pxRing->uxInFlightCount = 0U;
+        }
+
+        taskENTER_CRITICAL();
+        {
+            /* Free the ring only when no event refers to it any more. */
+            if( ( pxRing->xDeleteRequested != pdFALSE ) && ( pxRing->uxEventsQueued == 0U ) )
+            {
+                xFreeRing = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xFreeRing != pdFALSE )
+        {
+            vEventGroupDelete( pxRing->xCompletionGroup );
+            vPortFree( pxRing );
+        }
+        else if( pxRing->uxCompleteHead != uxCompleteHead )
+        {
+            ( void ) xEventGroupSetBits( pxRing->xCompletionGroup, socketASYNC_COMPLETED );
+        }
+        else
+        {
+            /* Nothing completed. */
+        }
     }
 
-#endif /* ipconfigSUPPORT_SIGNALS */
+#endif /* ipconfigSUPPORT_ASYNC_SOCKETS */
 /*-----------------------------------------------------------*/
 
 #if 0
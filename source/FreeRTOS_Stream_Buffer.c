@@ -41,6 +41,23 @@
 /* FreeRTOS+TCP includes. */
 #include "FreeRTOS_IP.h"
 
+/* Order the accesses to the data and to the indexes of a stream buffer, see
+ * ipconfigSTREAM_BUFFER_LOCK_FREE. */
+#if defined( ipconfigSTREAM_BUFFER_MEMORY_BARRIER )
+    #define sbMEMORY_BARRIER()    ipconfigSTREAM_BUFFER_MEMORY_BARRIER()
+#elif defined( portMEMORY_BARRIER )
+    #define sbMEMORY_BARRIER()    portMEMORY_BARRIER()
+#else
+    #define sbMEMORY_BARRIER()    do {} while( ipFALSE_BOOL )
+#endif
+
+/* Wrap an index that may have passed the end of the buffer, but not by more
+ * than 'uxLength', see ipconfigSTREAM_BUFFER_POWER_OF_TWO. */
+#if ( ipconfigSTREAM_BUFFER_POWER_OF_TWO != 0 )
+    #define sbWRAP_INDEX( uxIndex, uxLength )    ( ( uxIndex ) & ( ( uxLength ) - 1U ) )
+#else
+    #define sbWRAP_INDEX( uxIndex, uxLength )    ( ( ( uxIndex ) >= ( uxLength ) ) ? ( ( uxIndex ) - ( uxLength ) ) : ( uxIndex ) )
+#endif
 
 /**
  * @brief Get the space between lower and upper value provided to the function.
@@ -57,10 +74,7 @@ size_t uxStreamBufferSpace( const StreamBuffer_t * const pxBuffer,
     const size_t uxLength = pxBuffer->LENGTH;
     size_t uxCount = uxLength + uxUpper - uxLower - 1U;
 
-    if( uxCount >= uxLength )
-    {
-        uxCount -= uxLength;
-    }
+    uxCount = sbWRAP_INDEX( uxCount, uxLength );
 
     return uxCount;
 }
@@ -80,10 +94,7 @@ size_t uxStreamBufferDistance( const StreamBuffer_t * const pxBuffer,
     const size_t uxLength = pxBuffer->LENGTH;
     size_t uxCount = uxLength + uxUpper - uxLower;
 
-    if( uxCount >= uxLength )
-    {
-        uxCount -= uxLength;
-    }
+    uxCount = sbWRAP_INDEX( uxCount, uxLength );
 
     return uxCount;
 }
@@ -139,6 +150,39 @@ size_t uxStreamBufferMidSpace( const StreamBuffer_t * const pxBuffer )
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Get the length of a stream buffer that can store at least a given
+ *        number of bytes.  With ipconfigSTREAM_BUFFER_POWER_OF_TWO, the
+ *        length is a power of 2.
+ * @param[in] uxCapacity The number of bytes that must fit in the buffer.
+ * @return The value for 'LENGTH', which is also the size of 'ucArray'.
+ */
+size_t uxStreamBufferLength( size_t uxCapacity )
+{
+    size_t uxLength;
+
+    #if ( ipconfigSTREAM_BUFFER_POWER_OF_TWO != 0 )
+    {
+        /* One element always stays unused. */
+        uxLength = sizeof( size_t );
+
+        while( uxLength <= uxCapacity )
+        {
+            uxLength <<= 1U;
+        }
+    }
+    #else
+    {
+        /* Add an extra 4 (or 8) bytes, and make the length a multiple of
+         * sizeof( size_t ). */
+        uxLength = ( uxCapacity + sizeof( size_t ) ) & ~( sizeof( size_t ) - 1U );
+    }
+    #endif
+
+    return uxLength;
+}
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Clear the stream buffer.
  * @param[in] pxBuffer The circular stream buffer.
@@ -175,10 +219,7 @@ void vStreamBufferMoveMid( StreamBuffer_t * const pxBuffer,
 
     uxMid += uxMoveCount;
 
-    if( uxMid >= uxLength )
-    {
-        uxMid -= uxLength;
-    }
+    uxMid = sbWRAP_INDEX( uxMid, uxLength );
 
     pxBuffer->uxMid = uxMid;
 }
@@ -235,6 +276,93 @@ size_t uxStreamBufferGetPtr( StreamBuffer_t * const pxBuffer,
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Describe a span of the circular buffer as at most two regions, the
+ *        second one starting at the beginning of 'ucArray'.
+ *
+ * @param[in] pxBuffer The circular stream buffer.
+ * @param[in] uxStart The index of the first byte of the span.
+ * @param[in] uxCount The number of bytes in the span.
+ * @param[out] pxRegions The two regions to be filled in.  An unused region
+ *                        gets a NULL pointer and a length of zero.
+ *
+ * @return The number of bytes in the span, i.e. 'uxCount'.
+ */
+static size_t prvStreamBufferGetRegions( StreamBuffer_t * const pxBuffer,
+                                         size_t uxStart,
+                                         size_t uxCount,
+                                         StreamBufferRegion_t pxRegions[ 2 ] )
+{
+    const size_t uxFirst = FreeRTOS_min_size_t( uxCount, pxBuffer->LENGTH - uxStart );
+
+    pxRegions[ 0 ].pucData = &( pxBuffer->ucArray[ uxStart ] );
+    pxRegions[ 0 ].uxLength = uxFirst;
+
+    if( uxFirst < uxCount )
+    {
+        pxRegions[ 1 ].pucData = pxBuffer->ucArray;
+        pxRegions[ 1 ].uxLength = uxCount - uxFirst;
+    }
+    else
+    {
+        pxRegions[ 1 ].pucData = NULL;
+        pxRegions[ 1 ].uxLength = 0U;
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get all data that can be read, as at most two regions.  Unlike
+ *        uxStreamBufferGetPtr(), the part that wraps around to the start of
+ *        the buffer is included, so that a single scatter-gather operation
+ *        can read all of it.
+ *
+ * @param[in] pxBuffer The circular stream buffer.
+ * @param[out] pxRegions The two regions to be filled in.  The data must be
+ *                        released later by calling uxStreamBufferGet() with
+ *                        a NULL pointer.
+ *
+ * @return The total number of bytes in both regions.
+ */
+size_t uxStreamBufferGetReadRegions( StreamBuffer_t * const pxBuffer,
+                                     StreamBufferRegion_t pxRegions[ 2 ] )
+{
+    const size_t uxNextTail = pxBuffer->uxTail;
+    const size_t uxSize = uxStreamBufferGetSize( pxBuffer );
+
+    /* The data must not be read before the head that announced it. */
+    sbMEMORY_BARRIER();
+
+    return prvStreamBufferGetRegions( pxBuffer, uxNextTail, uxSize, pxRegions );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get all space that can be written, as at most two regions, starting
+ *        at the head of the buffer.
+ *
+ * @param[in] pxBuffer The circular stream buffer.
+ * @param[out] pxRegions The two regions to be filled in.  Once the data have
+ *                        been written, the head must be advanced by calling
+ *                        uxStreamBufferAdd() with a NULL pointer.
+ *
+ * @return The total number of bytes in both regions.
+ */
+size_t uxStreamBufferGetWriteRegions( StreamBuffer_t * const pxBuffer,
+                                      StreamBufferRegion_t pxRegions[ 2 ] )
+{
+    const size_t uxHead = pxBuffer->uxHead;
+    const size_t uxSpace = uxStreamBufferGetSpace( pxBuffer );
+
+    /* The space must not be written before the tail that released it. */
+    sbMEMORY_BARRIER();
+
+    return prvStreamBufferGetRegions( pxBuffer, uxHead, uxSpace, pxRegions );
+}
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Adds data to a stream buffer.
  *
@@ -274,15 +402,15 @@ size_t uxStreamBufferAdd( StreamBuffer_t * const pxBuffer,
         const size_t uxLength = pxBuffer->LENGTH;
         size_t uxNextHead = pxBuffer->uxHead;
 
+        /* The reader is done with the space up to the tail that was read. */
+        sbMEMORY_BARRIER();
+
         if( uxOffset != 0U )
         {
             /* ( uxOffset > 0 ) means: write in front if the uxHead marker */
             uxNextHead += uxOffset;
 
-            if( uxNextHead >= uxLength )
-            {
-                uxNextHead -= uxLength;
-            }
+            uxNextHead = sbWRAP_INDEX( uxNextHead, uxLength );
         }
 
         if( pucData != NULL )
@@ -305,19 +433,21 @@ size_t uxStreamBufferAdd( StreamBuffer_t * const pxBuffer,
             }
         }
 
+        /* The data must be visible before the new head is. */
+        sbMEMORY_BARRIER();
+
         /* The below update to the stream buffer members must happen
-         * atomically. */
-        vTaskSuspendAll();
+         * atomically, unless the indexes are only ordered. */
+        #if ( ipconfigSTREAM_BUFFER_LOCK_FREE == 0 )
+            vTaskSuspendAll();
+        #endif
         {
             if( uxOffset == 0U )
             {
                 /* ( uxOffset == 0 ) means: write at uxHead position */
                 uxNextHead += uxCount;
 
-                if( uxNextHead >= uxLength )
-                {
-                    uxNextHead -= uxLength;
-                }
+                uxNextHead = sbWRAP_INDEX( uxNextHead, uxLength );
 
                 pxBuffer->uxHead = uxNextHead;
             }
@@ -328,7 +458,9 @@ size_t uxStreamBufferAdd( StreamBuffer_t * const pxBuffer,
                 pxBuffer->uxFront = uxNextHead;
             }
         }
-        ( void ) xTaskResumeAll();
+        #if ( ipconfigSTREAM_BUFFER_LOCK_FREE == 0 )
+            ( void ) xTaskResumeAll();
+        #endif
     }
 
     return uxCount;
@@ -336,22 +468,82 @@ size_t uxStreamBufferAdd( StreamBuffer_t * const pxBuffer,
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Read bytes from stream buffer.
+ * @brief Copy bytes while calculating their one's complement sum.  The sum is
+ *        that of 16-bit big-endian words, as used by usGenerateChecksum().
+ *
+ * @param[out] pucDestination Where the bytes are copied to.
+ * @param[in] pucSource Where the bytes are copied from.
+ * @param[in] uxByteCount The number of bytes to copy.
+ * @param[in] uxPosition The position of the first byte within the summed data,
+ *                       only its parity is relevant.
+ *
+ * @return The sum, folded to 16 bits.
+ */
+static uint32_t prvCopyWithChecksum( uint8_t * pucDestination,
+                                     const uint8_t * pucSource,
+                                     size_t uxByteCount,
+                                     size_t uxPosition )
+{
+    uint32_t ulSum = 0U;
+    size_t uxIndex = 0U;
+
+    if( ( ( uxPosition & 1U ) != 0U ) && ( uxByteCount > 0U ) )
+    {
+        /* The first byte is the low byte of a word. */
+        pucDestination[ 0 ] = pucSource[ 0 ];
+        ulSum = ( uint32_t ) pucSource[ 0 ];
+        uxIndex = 1U;
+    }
+
+    while( ( uxIndex + 1U ) < uxByteCount )
+    {
+        uint8_t ucHigh = pucSource[ uxIndex ];
+        uint8_t ucLow = pucSource[ uxIndex + 1U ];
+
+        pucDestination[ uxIndex ] = ucHigh;
+        pucDestination[ uxIndex + 1U ] = ucLow;
+        ulSum += ( ( uint32_t ) ucHigh << 8 ) | ( uint32_t ) ucLow;
+
+        if( ulSum >= 0x80000000U )
+        {
+            ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+        }
+
+        uxIndex += 2U;
+    }
+
+    if( uxIndex < uxByteCount )
+    {
+        /* A last byte is the high byte of a word. */
+        pucDestination[ uxIndex ] = pucSource[ uxIndex ];
+        ulSum += ( uint32_t ) pucSource[ uxIndex ] << 8;
+    }
+
+    ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+    ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+
+    return ulSum;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Read bytes from a stream buffer, optionally calculating their sum.
  *
  * @param[in] pxBuffer The buffer from which the bytes will be read.
- * @param[in] uxOffset can be used to read data located at a certain offset from 'lTail'.
- * @param[in,out] pucData If 'pucData' equals NULL, the function is called to advance 'lTail' only.
+ * @param[in] uxOffset Offset from 'lTail'.
+ * @param[in,out] pucData Where to copy the data to, or NULL.
  * @param[in] uxMaxCount The number of bytes to read.
- * @param[in] xPeek if 'xPeek' is pdTRUE, or if 'uxOffset' is non-zero, the 'lTail' pointer will
- *                   not be advanced.
+ * @param[in] xPeek pdTRUE when 'lTail' must not be advanced.
+ * @param[out] pusSum When not NULL, the one's complement sum of the bytes read.
  *
  * @return The count of the bytes read.
  */
-size_t uxStreamBufferGet( StreamBuffer_t * const pxBuffer,
-                          size_t uxOffset,
-                          uint8_t * const pucData,
-                          size_t uxMaxCount,
-                          BaseType_t xPeek )
+static size_t prvStreamBufferGet( StreamBuffer_t * const pxBuffer,
+                                  size_t uxOffset,
+                                  uint8_t * const pucData,
+                                  size_t uxMaxCount,
+                                  BaseType_t xPeek,
+                                  uint16_t * pusSum )
 {
     size_t uxCount;
 
@@ -375,14 +567,14 @@ size_t uxStreamBufferGet( StreamBuffer_t * const pxBuffer,
         const size_t uxLength = pxBuffer->LENGTH;
         size_t uxNextTail = pxBuffer->uxTail;
 
+        /* The data up to the head that was read is visible. */
+        sbMEMORY_BARRIER();
+
         if( uxOffset != 0U )
         {
             uxNextTail += uxOffset;
 
-            if( uxNextTail >= uxLength )
-            {
-                uxNextTail -= uxLength;
-            }
+            uxNextTail = sbWRAP_INDEX( uxNextTail, uxLength );
         }
 
         if( pucData != NULL )
@@ -394,14 +586,31 @@ size_t uxStreamBufferGet( StreamBuffer_t * const pxBuffer,
 
             /* Obtain the number of bytes it is possible to obtain in the first
              * read. */
-            ( void ) memcpy( pucData, &( pxBuffer->ucArray[ uxNextTail ] ), uxFirst );
+            if( pusSum == NULL )
+            {
+                ( void ) memcpy( pucData, &( pxBuffer->ucArray[ uxNextTail ] ), uxFirst );
 
-            /* If the total number of wanted bytes is greater than the number
-             * that could be read in the first read... */
-            if( uxCount > uxFirst )
+                /* If the total number of wanted bytes is greater than the number
+                 * that could be read in the first read... */
+                if( uxCount > uxFirst )
+                {
+                    /* ...then read the remaining bytes from the start of the buffer. */
+                    ( void ) memcpy( &( pucData[ uxFirst ] ), pxBuffer->ucArray, uxCount - uxFirst );
+                }
+            }
+            else
             {
-                /* ...then read the remaining bytes from the start of the buffer. */
-                ( void ) memcpy( &( pucData[ uxFirst ] ), pxBuffer->ucArray, uxCount - uxFirst );
+                uint32_t ulSum;
+
+                ulSum = prvCopyWithChecksum( pucData, &( pxBuffer->ucArray[ uxNextTail ] ), uxFirst, 0U );
+
+                if( uxCount > uxFirst )
+                {
+                    ulSum += prvCopyWithChecksum( &( pucData[ uxFirst ] ), pxBuffer->ucArray, uxCount - uxFirst, uxFirst );
+                }
+
+                ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+                *( pusSum ) = ( uint16_t ) ulSum;
             }
         }
 
@@ -411,11 +620,10 @@ size_t uxStreamBufferGet( StreamBuffer_t * const pxBuffer,
              * the buffer. */
             uxNextTail += uxCount;
 
-            if( uxNextTail >= uxLength )
-            {
-                uxNextTail -= uxLength;
-            }
+            uxNextTail = sbWRAP_INDEX( uxNextTail, uxLength );
 
+            /* Finish reading the data before the space is handed back. */
+            sbMEMORY_BARRIER();
             pxBuffer->uxTail = uxNextTail;
         }
     }
@@ -423,3 +631,184 @@ size_t uxStreamBufferGet( StreamBuffer_t * const pxBuffer,
     return uxCount;
 }
 /*-----------------------------------------------------------*/
+
+/**
+ * @brief Read bytes from stream buffer.
+ *
+ * @param[in] pxBuffer The buffer from which the bytes will be read.
+ * @param[in] uxOffset can be used to read data located at a certain offset from 'lTail'.
+ * @param[in,out] pucData If 'pucData' equals NULL, the function is called to advance 'lTail' only.
+ * @param[in] uxMaxCount The number of bytes to read.
+ * @param[in] xPeek if 'xPeek' is pdTRUE, or if 'uxOffset' is non-zero, the 'lTail' pointer will
+ *                   not be advanced.
+ *
+ * @return The count of the bytes read.
+ */
+size_t uxStreamBufferGet( StreamBuffer_t * const pxBuffer,
+                          size_t uxOffset,
+                          uint8_t * const pucData,
+                          size_t uxMaxCount,
+                          BaseType_t xPeek )
+{
+    return prvStreamBufferGet( pxBuffer, uxOffset, pucData, uxMaxCount, xPeek, NULL );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Read bytes from stream buffer, and calculate the one's complement sum
+ *        of the bytes copied.  The partial sum can be used to finish e.g. a
+ *        TCP checksum without reading the data again.
+ *
+ * @param[in] pxBuffer The buffer from which the bytes will be read.
+ * @param[in] uxOffset can be used to read data located at a certain offset from 'lTail'.
+ * @param[in,out] pucData Where to copy the data to.  When NULL, no sum is calculated.
+ * @param[in] uxMaxCount The number of bytes to read.
+ * @param[in] xPeek if 'xPeek' is pdTRUE, or if 'uxOffset' is non-zero, the 'lTail' pointer will
+ *                   not be advanced.
+ * @param[out] pusSum The sum of the bytes copied, as 16-bit big-endian words
+ *                    starting at 'pucData'.  Zero when nothing was copied.
+ *
+ * @return The count of the bytes read.
+ */
+size_t uxStreamBufferGetWithChecksum( StreamBuffer_t * const pxBuffer,
+                                      size_t uxOffset,
+                                      uint8_t * const pucData,
+                                      size_t uxMaxCount,
+                                      BaseType_t xPeek,
+                                      uint16_t * pusSum )
+{
+    *( pusSum ) = 0U;
+
+    return prvStreamBufferGet( pxBuffer, uxOffset, pucData, uxMaxCount, xPeek, pusSum );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigTCP_BUFFER_ARENA_SIZE != 0 )
+
+/** @brief The header in front of each block of the arena. */
+    typedef struct xTCP_ARENA_BLOCK
+    {
+        size_t uxClass;                   /**< The size class of the block. */
+        struct xTCP_ARENA_BLOCK * pxNext; /**< The next free block of the same class. */
+    } TCPArenaBlock_t;
+
+/** @brief The memory of the arena, as words to get the alignment of a pointer. */
+    static size_t uxTCPArena[ ( ( size_t ) ipconfigTCP_BUFFER_ARENA_SIZE + sizeof( size_t ) - 1U ) / sizeof( size_t ) ];
+
+/** @brief The number of bytes at the start of uxTCPArena[] that were divided in blocks. */
+    static size_t uxTCPArenaUsed = 0U;
+
+/** @brief The number of bytes that are not allocated, either never used or in a free list. */
+    static size_t uxTCPArenaFree = sizeof( uxTCPArena );
+
+/** @brief The blocks that were freed, one list per size class. */
+    static TCPArenaBlock_t * pxTCPArenaFreeList[ ipconfigTCP_BUFFER_ARENA_CLASS_COUNT ];
+
+/**
+ * @brief Allocate a TCP stream buffer or a segment descriptor array from the
+ *        arena.  The block of the smallest size class that can hold the
+ *        header plus 'uxSize' bytes is taken from its free list, or else it
+ *        is divided from the unused part of the arena.
+ *
+ * @param[in] uxSize The number of bytes needed.
+ *
+ * @return The allocated memory, or NULL when the arena has no block for it.
+ */
+    void * pvTCPArenaMalloc( size_t uxSize )
+    {
+        void * pvReturn = NULL;
+        size_t uxNeeded = uxSize + sizeof( TCPArenaBlock_t );
+        size_t uxBlockSize = ( size_t ) ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE;
+        size_t uxClass = 0U;
+        TCPArenaBlock_t * pxBlock = NULL;
+
+        while( ( uxBlockSize < uxNeeded ) && ( uxClass < ( size_t ) ipconfigTCP_BUFFER_ARENA_CLASS_COUNT ) )
+        {
+            uxBlockSize <<= 1;
+            uxClass++;
+        }
+
+        if( ( uxClass < ( size_t ) ipconfigTCP_BUFFER_ARENA_CLASS_COUNT ) && ( uxNeeded > uxSize ) )
+        {
+            /* Both the IP-task and the API functions allocate streams. */
+            vTaskSuspendAll();
+            {
+                if( pxTCPArenaFreeList[ uxClass ] != NULL )
+                {
+                    pxBlock = pxTCPArenaFreeList[ uxClass ];
+                    pxTCPArenaFreeList[ uxClass ] = pxBlock->pxNext;
+                }
+                else if( ( sizeof( uxTCPArena ) - uxTCPArenaUsed ) >= uxBlockSize )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxBlock = ( ( TCPArenaBlock_t * ) &( ( ( uint8_t * ) uxTCPArena )[ uxTCPArenaUsed ] ) );
+                    uxTCPArenaUsed += uxBlockSize;
+                }
+                else
+                {
+                    /* The arena is exhausted for this size class. */
+                }
+
+                if( pxBlock != NULL )
+                {
+                    pxBlock->uxClass = uxClass;
+                    pxBlock->pxNext = NULL;
+                    uxTCPArenaFree -= uxBlockSize;
+                    pvReturn = ( void * ) &( pxBlock[ 1 ] );
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+
+        if( pvReturn == NULL )
+        {
+            FreeRTOS_debug_printf( ( "pvTCPArenaMalloc: no block for %u bytes (free %u)\n",
+                                     ( unsigned ) uxSize,
+                                     ( unsigned ) uxTCPArenaFree ) );
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Give back a block that was allocated with pvTCPArenaMalloc().  It is
+ *        kept in the free list of its size class.
+ *
+ * @param[in] pvBuffer The memory returned by pvTCPArenaMalloc(), or NULL.
+ */
+    void vTCPArenaFree( void * pvBuffer )
+    {
+        if( pvBuffer != NULL )
+        {
+            /* The header is stored in front of the memory given out. */
+            TCPArenaBlock_t * pxBlock = ( ( TCPArenaBlock_t * ) pvBuffer ) - 1;
+
+            configASSERT( pxBlock->uxClass < ( size_t ) ipconfigTCP_BUFFER_ARENA_CLASS_COUNT );
+
+            vTaskSuspendAll();
+            {
+                pxBlock->pxNext = pxTCPArenaFreeList[ pxBlock->uxClass ];
+                pxTCPArenaFreeList[ pxBlock->uxClass ] = pxBlock;
+                uxTCPArenaFree += ( ( size_t ) ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE ) << pxBlock->uxClass;
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the number of bytes of the arena that are not allocated.  Note
+ *        that a free block can only be reused for its own size class.
+ *
+ * @return The number of bytes that are not allocated.
+ */
+    size_t uxTCPArenaGetFreeSize( void )
+    {
+        return uxTCPArenaFree;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigTCP_BUFFER_ARENA_SIZE != 0 */
@@ -88,6 +88,41 @@
     /* coverity[misra_c_2012_rule_8_9_violation] */
     _static FreeRTOS_Socket_t * xSocketToListen = NULL;
 
+    #if ( ipconfigUSE_TCP_RX_COALESCE != 0 )
+
+/** @brief The received segments that are being merged by the receive coalescing.
+ *         They all belong to the same connection and have contiguous sequence
+ *         numbers. These variables can be accessed by the IP task only.
+ */
+        /* MISRA Ref 8.9.1 [File scoped variables] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-89 */
+        /* coverity[misra_c_2012_rule_8_9_violation] */
+        static NetworkBufferDescriptor_t * pxCoalesceSegments[ tcpRX_COALESCE_MAX_SEGMENTS ];
+        static size_t uxCoalesceCount = 0U;          /**< The number of segments in pxCoalesceSegments[]. */
+        static size_t uxCoalescePayloadLength = 0U;  /**< The total amount of payload held. */
+        static uint32_t ulCoalesceNextSequence = 0U; /**< The sequence number expected in the next segment. */
+    #endif /* ipconfigUSE_TCP_RX_COALESCE != 0 */
+
+    #if ( ipconfigTCP_TIME_WAIT_COUNT != 0 )
+
+/** @brief A connection whose FIN exchange has completed. */
+        typedef struct xTCP_TIME_WAIT
+        {
+            IPv46_Address_t xRemoteIP;   /**< The IP address of the peer. */
+            uint16_t usLocalPort;        /**< The local port number, zero when the record is free. */
+            uint16_t usRemotePort;       /**< The port number of the peer. */
+            uint32_t ulRxSequenceNumber; /**< The sequence number that follows the FIN of the peer. */
+            uint32_t ulTxSequenceNumber; /**< The sequence number that follows our FIN. */
+            TickType_t xStartTime;       /**< The time at which the record was made. */
+        } TCPTimeWait_t;
+
+/** @brief The connections in TIME_WAIT, accessed by the IP task only. */
+        /* MISRA Ref 8.9.1 [File scoped variables] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-89 */
+        /* coverity[misra_c_2012_rule_8_9_violation] */
+        static TCPTimeWait_t xTimeWaitTable[ ipconfigTCP_TIME_WAIT_COUNT ];
+    #endif /* ipconfigTCP_TIME_WAIT_COUNT != 0 */
+
     #if ( ipconfigHAS_DEBUG_PRINTF != 0 )
 
 /*
@@ -98,6 +133,47 @@
 
     static IPv46_Address_t xGetSourceAddrFromBuffer( const uint8_t * const pucEthernetBuffer );
 
+    #if ( ( ipconfigUSE_TCP_TIMER_WHEEL != 0 ) && ( ( ipconfigTCP_KEEP_ALIVE == 1 ) || ( ipconfigTCP_HANG_PROTECTION == 1 ) ) )
+
+/*
+ * Get the time until the next keep-alive or hang-protection deadline of a
+ * socket that has nothing to send.
+ */
+        static uint32_t prvTCPIdleTimeout( const FreeRTOS_Socket_t * pxSocket );
+    #endif
+
+    #if ( ipconfigUSE_TCP_RX_COALESCE != 0 )
+
+/*
+ * Get the length of the TCP payload and of all headers of a received packet.
+ */
+        static size_t prvTCPCoalescePayloadLength( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                   size_t * puxHeaderLength );
+
+/*
+ * Check if a received packet belongs to the same flow as the first segment
+ * held, with the same acknowledgement, window and options.
+ */
+        static BaseType_t prvTCPCoalesceSameFlow( const NetworkBufferDescriptor_t * pxFirst,
+                                                  const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Copy the segments held into a single new network buffer.
+ */
+        static NetworkBufferDescriptor_t * prvTCPCoalesceMerge( void );
+    #endif /* ipconfigUSE_TCP_RX_COALESCE != 0 */
+
+    #if ( ipconfigTCP_TIME_WAIT_COUNT != 0 )
+
+/*
+ * Answer a packet that belongs to a connection in TIME_WAIT.
+ */
+        static BaseType_t prvTCPTimeWaitReply( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                               uint16_t usLocalPort,
+                                               const IPv46_Address_t * pxRemoteIP,
+                                               uint16_t usRemotePort );
+    #endif /* ipconfigTCP_TIME_WAIT_COUNT != 0 */
+
 /*-----------------------------------------------------------*/
 
 
@@ -156,6 +232,26 @@
         BaseType_t xResult = 0;
         BaseType_t xReady = pdFALSE;
 
+        #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+            uint32_t ulAccountingStart = ipconfigSOCKET_ACCOUNTING_TIME();
+        #endif
+
+        #if ( ipconfigUSE_TCP_SPLICE != 0 )
+        {
+            /* Move the data that did not fit when it was received, or that
+             * was received before the sockets were spliced. */
+            if( pxSocket->u.xTCP.pxSpliceTarget != NULL )
+            {
+                vTCPSpliceTransfer( pxSocket );
+            }
+
+            if( pxSocket->u.xTCP.pxSpliceSource != NULL )
+            {
+                vTCPSpliceTransfer( pxSocket->u.xTCP.pxSpliceSource );
+            }
+        }
+        #endif
+
         if( ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) && ( pxSocket->u.xTCP.txStream != NULL ) )
         {
             /* The API FreeRTOS_send() might have added data to the TX stream.  Add
@@ -188,6 +284,13 @@
 
                         prvTCPReturnPacket( pxSocket, pxSocket->u.xTCP.pxAckMessage, ( uint32_t ) ( uxIPHeaderSizeSocket( pxSocket ) + ipSIZE_OF_TCP_HEADER ), ipconfigZERO_COPY_TX_DRIVER );
 
+                        #if ( ipconfigUSE_TCP_ACK_POLICY != 0 )
+                        {
+                            /* The count of FREERTOS_TCP_ACK_EVERY_N starts again. */
+                            pxSocket->u.xTCP.ucAckSegments = 0U;
+                        }
+                        #endif
+
                         #if ( ipconfigZERO_COPY_TX_DRIVER != 0 )
                         {
                             /* The ownership has been passed to the SEND routine,
@@ -219,13 +322,34 @@
         }
         #endif /* ipconfigUSE_TCP_WIN */
 
+        #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+        {
+            /* Give back the streams that stayed empty for a while. */
+            vTCPStreamIdleCheck( pxSocket );
+        }
+        #endif
+
         if( xReady == pdFALSE )
         {
             /* The second task of this regular socket check is sending out data. */
             if( ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) ||
                 ( pxSocket->u.xTCP.eTCPState == eCONNECT_SYN ) )
             {
+                #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+                    const uint32_t ulSendStart = ipconfigSOCKET_ACCOUNTING_TIME();
+                #endif
+
                 ( void ) prvTCPSendPacket( pxSocket );
+
+                #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+                {
+                    const uint32_t ulSendTime = ipconfigSOCKET_ACCOUNTING_TIME() - ulSendStart;
+
+                    pxSocket->xAccounting.ullTxTime += ( uint64_t ) ulSendTime;
+                    /* Leave the transmission out of the timer work. */
+                    ulAccountingStart += ulSendTime;
+                }
+                #endif
             }
 
             /* Set the time-out for the next wakeup for this socket. */
@@ -240,6 +364,8 @@
             #endif
         }
 
+        ipACCOUNT_SOCKET_TIME( pxSocket, ullTimerTime, ulAccountingStart );
+
         return xResult;
     }
     /*-----------------------------------------------------------*/
@@ -330,6 +456,14 @@
             FreeRTOS_Socket_t * xConnected = NULL;
         #endif
 
+        #if ( ipconfigUSE_TCP_ACK_TEMPLATE != 0 )
+        {
+            /* The ACK template is only used in the established state, it
+             * will be filled again by the first packet sent after entering it. */
+            pxSocket->u.xTCP.xAckTemplate.xValid = pdFALSE;
+        }
+        #endif
+
         if( ( ( xPreviousState == eCONNECT_SYN ) ||
               ( xPreviousState == eSYN_FIRST ) ||
               ( xPreviousState == eSYN_RECEIVED ) ) &&
@@ -381,6 +515,18 @@
                             xParent->u.xTCP.pxPeerSocket = pxSocket;
                         }
 
+                        #if ( ipconfigTCP_ACCEPT_QUEUE != 0 )
+                        {
+                            /* FreeRTOS_accept() takes the children from the
+                             * queue with the scheduler suspended. */
+                            vTaskSuspendAll();
+                            {
+                                vListInsertEnd( &( xParent->u.xTCP.xAcceptQueue ), &( pxSocket->u.xTCP.xAcceptListItem ) );
+                            }
+                            ( void ) xTaskResumeAll();
+                        }
+                        #endif /* ipconfigTCP_ACCEPT_QUEUE */
+
                         xParent->xEventBits |= ( EventBits_t ) eSOCKET_ACCEPT;
 
                         #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
@@ -511,6 +657,15 @@
                         xHasCleared = vTCPRemoveTCPChild( pxSocket );
                         ( void ) xHasCleared;
 
+                        #if ( ipconfigTCP_ACCEPT_QUEUE != 0 )
+                        {
+                            if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xAcceptListItem ) ) != NULL )
+                            {
+                                ( void ) uxListRemove( &( pxSocket->u.xTCP.xAcceptListItem ) );
+                            }
+                        }
+                        #endif /* ipconfigTCP_ACCEPT_QUEUE */
+
                         pxSocket->u.xTCP.bits.bPassQueued = pdFALSE_UNSIGNED;
                         pxSocket->u.xTCP.bits.bPassAccept = pdFALSE_UNSIGNED;
                         configASSERT( xIsCallingFromIPTask() != pdFALSE );
@@ -607,10 +762,83 @@
         {
             vSocketWakeUpUser( xParent );
         }
+
+        #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
+        {
+            /* The state change may have cleared 'usTimeout'. */
+            vTCPTimerWheelSchedule( pxSocket );
+        }
+        #endif
     }
     /*-----------------------------------------------------------*/
 
 
+    #if ( ( ipconfigUSE_TCP_TIMER_WHEEL != 0 ) && ( ( ipconfigTCP_KEEP_ALIVE == 1 ) || ( ipconfigTCP_HANG_PROTECTION == 1 ) ) )
+
+/**
+ * @brief A socket that has nothing to send only needs attention when it must
+ *        send a keep-alive message, or when hang-protection must close it.
+ *        Return the time until the first of those deadlines, so the timer
+ *        wheel visits the socket when it expires, and not periodically.
+ *
+ * @param[in] pxSocket The socket, which has no data in its TX window or stream.
+ *
+ * @return The delay in ms, or tcpMAXIMUM_TCP_WAKEUP_TIME_MS when the socket has
+ *         no deadline.
+ */
+        static uint32_t prvTCPIdleTimeout( const FreeRTOS_Socket_t * pxSocket )
+        {
+            /* The longest delay that still fits in 'usTimeout'. */
+            const uint32_t ulMaxDelayMs = ( ( uint32_t ) 0xFFFFU * 1000U ) / ( uint32_t ) configTICK_RATE_HZ;
+            TickType_t xNow = xTaskGetTickCount();
+            TickType_t xDelay = portMAX_DELAY;
+            eIPTCPState_t eState = ( eIPTCPState_t ) pxSocket->u.xTCP.eTCPState;
+            uint32_t ulDelayMs = tcpMAXIMUM_TCP_WAKEUP_TIME_MS;
+
+            #if ( ipconfigTCP_KEEP_ALIVE == 1 )
+            {
+                if( eState == eESTABLISHED )
+                {
+                    TickType_t xAge = xNow - pxSocket->u.xTCP.xLastAliveTime;
+                    TickType_t xMax = ( TickType_t ) ipconfigTCP_KEEP_ALIVE_INTERVAL * ( TickType_t ) configTICK_RATE_HZ;
+
+                    if( pxSocket->u.xTCP.ucKeepRepCount != 0U )
+                    {
+                        xMax = 3U * configTICK_RATE_HZ;
+                    }
+
+                    /* A keep-alive is sent as soon as the age exceeds xMax. */
+                    xDelay = ( xAge > xMax ) ? 0U : ( ( xMax - xAge ) + 1U );
+                }
+            }
+            #endif /* ipconfigTCP_KEEP_ALIVE */
+
+            #if ( ipconfigTCP_HANG_PROTECTION == 1 )
+            {
+                /* The states that are protected in prvTCPStatusAgeCheck(). */
+                if( ( eState != eESTABLISHED ) && ( eState != eCLOSED ) &&
+                    ( eState != eTCP_LISTEN ) && ( eState != eCLOSE_WAIT ) )
+                {
+                    TickType_t xAge = xNow - pxSocket->u.xTCP.xLastActTime;
+                    TickType_t xMax = ( TickType_t ) ipconfigTCP_HANG_PROTECTION_TIME * ( TickType_t ) configTICK_RATE_HZ;
+
+                    xDelay = ( xAge > xMax ) ? 0U : ( ( xMax - xAge ) + 1U );
+                }
+            }
+            #endif /* ipconfigTCP_HANG_PROTECTION */
+
+            if( xDelay != portMAX_DELAY )
+            {
+                /* Round up to whole milliseconds. */
+                ulDelayMs = ( uint32_t ) ( ( ( ( uint64_t ) xDelay * 1000U ) + ( ( uint64_t ) configTICK_RATE_HZ - 1U ) ) / ( uint64_t ) configTICK_RATE_HZ );
+                ulDelayMs = FreeRTOS_max_uint32( 1U, FreeRTOS_min_uint32( ulDelayMs, ulMaxDelayMs ) );
+            }
+
+            return ulDelayMs;
+        }
+        /*-----------------------------------------------------------*/
+    #endif /* ( ipconfigUSE_TCP_TIMER_WHEEL != 0 ) && ( ( ipconfigTCP_KEEP_ALIVE == 1 ) || ( ipconfigTCP_HANG_PROTECTION == 1 ) ) */
+
 /**
  * @brief Calculate after how much time this socket needs to be checked again.
  *
@@ -661,6 +889,16 @@
             /* Let the sliding window mechanism decide what time-out is appropriate. */
             BaseType_t xResult = xTCPWindowTxHasData( &pxSocket->u.xTCP.xTCPWindow, pxSocket->u.xTCP.ulWindowSize, &ulDelayMs );
 
+            #if ( ipconfigUSE_TCP_PACING != 0 )
+            {
+                if( ( xResult != ( BaseType_t ) 0 ) && ( ulDelayMs == 0U ) )
+                {
+                    /* Data may be sent now, unless the pacing holds it back. */
+                    ulDelayMs = FreeRTOS_min_uint32( ulTCPPacingDelay( pxSocket ), ( uint32_t ) tcpMAXIMUM_TCP_WAKEUP_TIME_MS );
+                }
+            }
+            #endif
+
             if( ulDelayMs == 0U )
             {
                 if( xResult != ( BaseType_t ) 0 )
@@ -670,6 +908,17 @@
                 else
                 {
                     ulDelayMs = tcpMAXIMUM_TCP_WAKEUP_TIME_MS;
+
+                    #if ( ( ipconfigUSE_TCP_TIMER_WHEEL != 0 ) && ( ( ipconfigTCP_KEEP_ALIVE == 1 ) || ( ipconfigTCP_HANG_PROTECTION == 1 ) ) )
+                    {
+                        if( ( xTCPWindowTxDone( &( pxSocket->u.xTCP.xTCPWindow ) ) != pdFALSE ) &&
+                            ( ( pxSocket->u.xTCP.txStream == NULL ) || ( uxStreamBufferMidSpace( pxSocket->u.xTCP.txStream ) == 0U ) ) )
+                        {
+                            /* The socket is idle, only visit it when a deadline expires. */
+                            ulDelayMs = prvTCPIdleTimeout( pxSocket );
+                        }
+                    }
+                    #endif
                 }
             }
             else
@@ -756,15 +1005,39 @@
         NetworkBufferDescriptor_t * pxNetworkBuffer;
         size_t uxIPHeaderOffset;
 
+        #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+            const uint32_t ulAccountingStart = ipconfigSOCKET_ACCOUNTING_TIME();
+            size_t uxAccountingLength;
+        #endif
+
         configASSERT( pxDescriptor != NULL );
         configASSERT( pxDescriptor->pucEthernetBuffer != NULL );
 
         pxNetworkBuffer = pxDescriptor;
-        uxIPHeaderOffset = ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer );
+
+        #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+        {
+            /* The buffer may be re-used or released before the packet is
+             * accounted to the socket. */
+            uxAccountingLength = pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER;
+        }
+        #endif
+        #if ( ipconfigUSE_PACKET_METADATA != 0 )
+            if( pxNetworkBuffer->xMetadata.ucValid != pdFALSE_UNSIGNED )
+            {
+                /* Found once by vPacketMetadataParse(). */
+                uxIPHeaderOffset = ( size_t ) pxNetworkBuffer->xMetadata.usL4Offset;
+            }
+            else
+        #endif
+        {
+            uxIPHeaderOffset = ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer );
+        }
 
         /* Check for a minimum packet size. */
         if( pxNetworkBuffer->xDataLength < ( uxIPHeaderOffset + ipSIZE_OF_TCP_HEADER ) )
         {
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropMalformed );
             xResult = pdFAIL;
         }
         else
@@ -772,8 +1045,8 @@
             /* MISRA Ref 11.3.1 [Misaligned access] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
             /* coverity[misra_c_2012_rule_11_3_violation] */
-            const TCPHeader_t * pxTCPHeader = ( ( const TCPHeader_t * )
-                                                &( pxNetworkBuffer->pucEthernetBuffer[ uxIPHeaderOffset ] ) );
+            const TCPHeaderView_t * pxTCPHeader = ( ( const TCPHeaderView_t * )
+                                                    &( pxNetworkBuffer->pucEthernetBuffer[ uxIPHeaderOffset ] ) );
 
             const uint16_t ucTCPFlags = pxTCPHeader->ucTCPFlags;
             const uint16_t usLocalPort = FreeRTOS_htons( pxTCPHeader->usDestinationPort );
@@ -792,6 +1065,7 @@
                  * eTIME_WAIT. */
 
                 FreeRTOS_debug_printf( ( "TCP: No active socket on port %d (%d)\n", usLocalPort, usRemotePort ) );
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropNoSocket );
 
                 /* Send a RST to all packets that can not be handled.  As a result
                  * the other party will get a ECONN error.  There are two exceptions:
@@ -802,7 +1076,19 @@
                 if( ( ( ucTCPFlags & tcpTCP_FLAG_CTRL ) != tcpTCP_FLAG_ACK ) &&
                     ( ( ucTCPFlags & tcpTCP_FLAG_RST ) == 0U ) )
                 {
-                    ( void ) prvTCPSendReset( pxNetworkBuffer );
+                    BaseType_t xAnswered = pdFALSE;
+
+                    #if ( ipconfigTCP_TIME_WAIT_COUNT != 0 )
+                    {
+                        /* A connection in TIME_WAIT repeats its last ACK. */
+                        xAnswered = prvTCPTimeWaitReply( pxNetworkBuffer, usLocalPort, &( xRemoteIP ), usRemotePort );
+                    }
+                    #endif
+
+                    if( xAnswered == pdFALSE )
+                    {
+                        ( void ) prvTCPSendReset( pxNetworkBuffer );
+                    }
                 }
 
                 /* The packet can't be handled. */
@@ -818,22 +1104,42 @@
                      * has set the SYN flag. */
                     if( ( ucTCPFlags & tcpTCP_FLAG_CTRL ) != tcpTCP_FLAG_SYN )
                     {
-                        /* What happens: maybe after a reboot, a client doesn't know the
-                         * connection had gone.  Send a RST in order to get a new connect
-                         * request. */
-                        #if ( ipconfigHAS_DEBUG_PRINTF == 1 )
+                        FreeRTOS_Socket_t * pxChildSocket = NULL;
+
+                        #if ( ipconfigUSE_TCP_SYN_COOKIES != 0 )
                         {
-                            FreeRTOS_debug_printf( ( "TCP: Server can't handle flags: %s from %u to port %u\n",
-                                                     prvTCPFlagMeaning( ( UBaseType_t ) ucTCPFlags ), usRemotePort, usLocalPort ) );
+                            /* This may be the last ACK of a hand-shake that was
+                             * answered with a SYN cookie. */
+                            if( ( ucTCPFlags & ( tcpTCP_FLAG_SYN | tcpTCP_FLAG_RST | tcpTCP_FLAG_FIN | tcpTCP_FLAG_ACK ) ) == tcpTCP_FLAG_ACK )
+                            {
+                                pxChildSocket = prvHandleSynCookie( pxSocket, pxNetworkBuffer );
+                            }
                         }
-                        #endif /* ipconfigHAS_DEBUG_PRINTF */
+                        #endif
 
-                        if( ( ucTCPFlags & tcpTCP_FLAG_RST ) == 0U )
+                        if( pxChildSocket != NULL )
                         {
-                            ( void ) prvTCPSendReset( pxNetworkBuffer );
+                            pxSocket = pxChildSocket;
                         }
+                        else
+                        {
+                            /* What happens: maybe after a reboot, a client doesn't know the
+                             * connection had gone.  Send a RST in order to get a new connect
+                             * request. */
+                            #if ( ipconfigHAS_DEBUG_PRINTF == 1 )
+                            {
+                                FreeRTOS_debug_printf( ( "TCP: Server can't handle flags: %s from %u to port %u\n",
+                                                         prvTCPFlagMeaning( ( UBaseType_t ) ucTCPFlags ), usRemotePort, usLocalPort ) );
+                            }
+                            #endif /* ipconfigHAS_DEBUG_PRINTF */
 
-                        xResult = pdFAIL;
+                            if( ( ucTCPFlags & tcpTCP_FLAG_RST ) == 0U )
+                            {
+                                ( void ) prvTCPSendReset( pxNetworkBuffer );
+                            }
+
+                            xResult = pdFAIL;
+                        }
                     }
                     else
                     {
@@ -921,6 +1227,12 @@
             if( xResult != pdFAIL )
             {
                 uint16_t usWindow;
+                BaseType_t xPredicted = pdFALSE;
+                BaseType_t xSendResult;
+
+                #if ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 )
+                    uint32_t ulPreviousWindow;
+                #endif
 
                 /* pxSocket is not NULL when xResult != pdFAIL. */
                 configASSERT( pxSocket != NULL ); /* LCOV_EXCL_LINE ,this branch will not be hit*/
@@ -936,13 +1248,43 @@
 
                 /* When there are no TCP options, the TCP offset equals 20 bytes, which is stored as
                  * the number 5 (words) in the higher nibble of the TCP-offset byte. */
-                if( ( pxTCPHeader->ucTCPOffset & tcpTCP_OFFSET_LENGTH_BITS ) > tcpTCP_OFFSET_STANDARD_LENGTH )
+                #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+                {
+                    /* Forget the time-stamps of the previous segment. */
+                    pxSocket->u.xTCP.bits.bTimeStampSeen = pdFALSE_UNSIGNED;
+                    pxSocket->u.xTCP.xTCPWindow.u.bits.bTimeStampEcho = pdFALSE_UNSIGNED;
+                }
+                #endif
+
+                #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+                {
+                    /* Forget the Fast Open option of the previous segment. */
+                    pxSocket->u.xTCP.bits.bFastOpenSeen = pdFALSE_UNSIGNED;
+                }
+                #endif
+
+                #if ( ipconfigUSE_TCP_HEADER_PREDICTION != 0 )
+                {
+                    /* The common case of in-order data or an ACK doesn't need
+                     * the option parser. */
+                    xPredicted = prvTCPHeaderPrediction( pxSocket, pxNetworkBuffer );
+                }
+                #endif
+
+                if( ( xPredicted == pdFALSE ) &&
+                    ( ( pxTCPHeader->ucTCPOffset & tcpTCP_OFFSET_LENGTH_BITS ) > tcpTCP_OFFSET_STANDARD_LENGTH ) )
                 {
                     xResult = prvCheckOptions( pxSocket, pxNetworkBuffer );
                 }
 
                 if( xResult != pdFAIL )
                 {
+                    #if ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 )
+                    {
+                        ulPreviousWindow = pxSocket->u.xTCP.ulWindowSize;
+                    }
+                    #endif
+
                     usWindow = FreeRTOS_ntohs( pxTCPHeader->usWindow );
                     pxSocket->u.xTCP.ulWindowSize = ( uint32_t ) usWindow;
                     #if ( ipconfigUSE_TCP_WIN == 1 )
@@ -957,9 +1299,30 @@
                     }
                     #endif /* ipconfigUSE_TCP_WIN */
 
+                    #if ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 )
+                    {
+                        if( pxSocket->u.xTCP.ulWindowSize != ulPreviousWindow )
+                        {
+                            tcpwinLOG_EVENT( &( pxSocket->u.xTCP.xTCPWindow ), eTCPWinEventWindow,
+                                             FreeRTOS_ntohl( pxTCPHeader->ulAckNr ), pxSocket->u.xTCP.ulWindowSize, 0U );
+                        }
+                    }
+                    #endif
+
                     /* In prvTCPHandleState() the incoming messages will be handled
                      * depending on the current state of the connection. */
-                    if( prvTCPHandleState( pxSocket, &pxNetworkBuffer ) > 0 )
+                    #if ( ipconfigUSE_TCP_HEADER_PREDICTION != 0 )
+                        if( xPredicted != pdFALSE )
+                        {
+                            xSendResult = prvTCPHandlePredicted( pxSocket, &pxNetworkBuffer );
+                        }
+                        else
+                    #endif
+                    {
+                        xSendResult = prvTCPHandleState( pxSocket, &pxNetworkBuffer );
+                    }
+
+                    if( xSendResult > 0 )
                     {
                         /* prvTCPHandleState() has sent a message, see if there are more to
                          * be transmitted. */
@@ -982,9 +1345,50 @@
                         #endif
                     }
 
+                    #if ( ipconfigUSE_TCP_SPLICE != 0 )
+                    {
+                        if( pxSocket->u.xTCP.pxSpliceSource != NULL )
+                        {
+                            /* Acknowledged data has made space in txStream,
+                             * take more data from the source. */
+                            vTCPSpliceTransfer( pxSocket->u.xTCP.pxSpliceSource );
+                        }
+                    }
+                    #endif
+
+                    #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+                    {
+                        /* See if the streams should grow or shrink. */
+                        vTCPAutoTuneCheck( pxSocket );
+                    }
+                    #endif
+
+                    #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+                    {
+                        /* A stream that was found empty must stay empty for a
+                         * while before it is released. */
+                        vTCPStreamIdleCheck( pxSocket );
+                    }
+                    #endif
+
                     /* And finally, calculate when this socket wants to be woken up. */
                     ( void ) prvTCPNextTimeout( pxSocket );
+
+                    #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
+                    {
+                        vTCPTimerWheelSchedule( pxSocket );
+                    }
+                    #endif
+                }
+
+                #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+                {
+                    /* The time includes the replies sent while handling the
+                     * packet, their bytes are counted by prvTCPReturnPacket(). */
+                    ipACCOUNT_SOCKET_RX( pxSocket, uxAccountingLength );
+                    ipACCOUNT_SOCKET_TIME( pxSocket, ullRxTime, ulAccountingStart );
                 }
+                #endif
             }
         }
 
@@ -993,6 +1397,468 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigTCP_TIME_WAIT_COUNT != 0 )
+
+/**
+ * @brief Check if a record in the TIME_WAIT table belongs to a connection.
+ *
+ * @param[in] pxRecord The record to check.
+ * @param[in] usLocalPort The local port number.
+ * @param[in] pxRemoteIP The IP address of the peer.
+ * @param[in] usRemotePort The port number of the peer.
+ *
+ * @return pdTRUE when the record matches.
+ */
+        static BaseType_t prvTCPTimeWaitMatch( const TCPTimeWait_t * pxRecord,
+                                               uint16_t usLocalPort,
+                                               const IPv46_Address_t * pxRemoteIP,
+                                               uint16_t usRemotePort )
+        {
+            BaseType_t xResult = pdFALSE;
+
+            if( ( pxRecord->usLocalPort == usLocalPort ) &&
+                ( pxRecord->usRemotePort == usRemotePort ) &&
+                ( pxRecord->xRemoteIP.xIs_IPv6 == pxRemoteIP->xIs_IPv6 ) )
+            {
+                if( pxRemoteIP->xIs_IPv6 != pdFALSE )
+                {
+                    if( memcmp( pxRecord->xRemoteIP.xIPAddress.xIP_IPv6.ucBytes, pxRemoteIP->xIPAddress.xIP_IPv6.ucBytes, sizeof( IPv6_Address_t ) ) == 0 )
+                    {
+                        xResult = pdTRUE;
+                    }
+                }
+                else if( pxRecord->xRemoteIP.xIPAddress.ulIP_IPv4 == pxRemoteIP->xIPAddress.ulIP_IPv4 )
+                {
+                    xResult = pdTRUE;
+                }
+                else
+                {
+                    /* A different peer. */
+                }
+            }
+
+            return xResult;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Remember a connection whose FIN exchange has completed.  The record
+ *        replaces an earlier record of the same connection, a free or an
+ *        expired record, or else the oldest record.
+ *
+ * @param[in] pxSocket The socket that moves to eCLOSE_WAIT.
+ */
+        void vTCPTimeWaitAdd( const FreeRTOS_Socket_t * pxSocket )
+        {
+            TickType_t xNow = xTaskGetTickCount();
+            TickType_t xMaxAge = ( TickType_t ) ipconfigTCP_TIME_WAIT_TIME * ( TickType_t ) configTICK_RATE_HZ;
+            TickType_t xOldestAge = 0U;
+            TCPTimeWait_t * pxRecord = &( xTimeWaitTable[ 0 ] );
+            IPv46_Address_t xRemoteIP;
+            UBaseType_t uxIndex;
+
+            ( void ) memset( &( xRemoteIP ), 0, sizeof( xRemoteIP ) );
+
+            if( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED )
+            {
+                xRemoteIP.xIs_IPv6 = pdTRUE;
+                ( void ) memcpy( xRemoteIP.xIPAddress.xIP_IPv6.ucBytes, pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes, sizeof( IPv6_Address_t ) );
+            }
+            else
+            {
+                xRemoteIP.xIs_IPv6 = pdFALSE;
+                xRemoteIP.xIPAddress.ulIP_IPv4 = pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4;
+            }
+
+            for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigTCP_TIME_WAIT_COUNT; uxIndex++ )
+            {
+                TCPTimeWait_t * pxCandidate = &( xTimeWaitTable[ uxIndex ] );
+                TickType_t xAge = xNow - pxCandidate->xStartTime;
+
+                if( prvTCPTimeWaitMatch( pxCandidate, pxSocket->usLocalPort, &( xRemoteIP ), pxSocket->u.xTCP.usRemotePort ) != pdFALSE )
+                {
+                    pxRecord = pxCandidate;
+                    break;
+                }
+
+                if( ( pxCandidate->usLocalPort == 0U ) || ( xAge > xMaxAge ) )
+                {
+                    /* Free or expired, take it unless a match is found. */
+                    xAge = portMAX_DELAY;
+                }
+
+                if( xAge > xOldestAge )
+                {
+                    xOldestAge = xAge;
+                    pxRecord = pxCandidate;
+                }
+            }
+
+            pxRecord->xRemoteIP = xRemoteIP;
+            pxRecord->usLocalPort = pxSocket->usLocalPort;
+            pxRecord->usRemotePort = pxSocket->u.xTCP.usRemotePort;
+            pxRecord->ulRxSequenceNumber = pxSocket->u.xTCP.xTCPWindow.rx.ulCurrentSequenceNumber;
+            pxRecord->ulTxSequenceNumber = pxSocket->u.xTCP.xTCPWindow.tx.ulCurrentSequenceNumber;
+            pxRecord->xStartTime = xNow;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Answer a packet that belongs to a connection in TIME_WAIT.  A
+ *        repeated FIN, or any other packet except a SYN, gets the ACK that
+ *        closed the connection.  A SYN removes the record, it is answered as
+ *        usual.
+ *
+ * @param[in] pxNetworkBuffer The network buffer that holds the packet.
+ * @param[in] usLocalPort The local port number.
+ * @param[in] pxRemoteIP The IP address of the peer.
+ * @param[in] usRemotePort The port number of the peer.
+ *
+ * @return pdTRUE when the packet has been answered, pdFALSE when the packet
+ *         does not belong to a connection in TIME_WAIT.
+ */
+        static BaseType_t prvTCPTimeWaitReply( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                               uint16_t usLocalPort,
+                                               const IPv46_Address_t * pxRemoteIP,
+                                               uint16_t usRemotePort )
+        {
+            BaseType_t xResult = pdFALSE;
+            TickType_t xMaxAge = ( TickType_t ) ipconfigTCP_TIME_WAIT_TIME * ( TickType_t ) configTICK_RATE_HZ;
+            UBaseType_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigTCP_TIME_WAIT_COUNT; uxIndex++ )
+            {
+                TCPTimeWait_t * pxRecord = &( xTimeWaitTable[ uxIndex ] );
+
+                if( ( pxRecord->usLocalPort != 0U ) &&
+                    ( prvTCPTimeWaitMatch( pxRecord, usLocalPort, pxRemoteIP, usRemotePort ) != pdFALSE ) )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    TCPHeader_t * pxTCPHeader = ( ( TCPHeader_t * )
+                                                  &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer ) ] ) );
+
+                    if( ( ( xTaskGetTickCount() - pxRecord->xStartTime ) > xMaxAge ) ||
+                        ( ( pxTCPHeader->ucTCPFlags & tcpTCP_FLAG_SYN ) != 0U ) )
+                    {
+                        /* The record expired, or the peer starts a new connection. */
+                        pxRecord->usLocalPort = 0U;
+                    }
+                    else
+                    {
+                        /* The reply swaps the sequence and the acknowledgement
+                         * numbers of the packet. */
+                        pxTCPHeader->ulSequenceNumber = FreeRTOS_htonl( pxRecord->ulRxSequenceNumber );
+                        pxTCPHeader->ulAckNr = FreeRTOS_htonl( pxRecord->ulTxSequenceNumber );
+                        ( void ) prvTCPSendChallengeAck( pxNetworkBuffer );
+                        xResult = pdTRUE;
+                    }
+
+                    break;
+                }
+            }
+
+            return xResult;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigTCP_TIME_WAIT_COUNT != 0 */
+
+    #if ( ipconfigUSE_TCP_RX_COALESCE != 0 )
+
+/**
+ * @brief Get the length of the TCP payload of a received packet, as given by
+ *        the length field of the IP header.
+ *
+ * @param[in] pxNetworkBuffer The network buffer holding the TCP packet.
+ * @param[out] puxHeaderLength The length of the Ethernet, IP and TCP headers.
+ *
+ * @return The number of bytes of TCP payload, or zero if the packet is too
+ *         short to hold its headers.
+ */
+        static size_t prvTCPCoalescePayloadLength( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                   size_t * puxHeaderLength )
+        {
+            const size_t uxIPHeaderLength = uxIPHeaderSizePacket( pxNetworkBuffer );
+            size_t uxHeaderLength = ipSIZE_OF_ETH_HEADER + uxIPHeaderLength + ipSIZE_OF_TCP_HEADER;
+            size_t uxIPLength;
+            size_t uxPayloadLength = 0U;
+
+            if( pxNetworkBuffer->xDataLength >= uxHeaderLength )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * )
+                                                                &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderLength ] ) );
+                uint8_t ucIntermediateResult = ( pxProtocolHeaders->xTCPHeader.ucTCPOffset & tcpVALID_BITS_IN_TCP_OFFSET_BYTE ) >> 2;
+
+                uxHeaderLength = ipSIZE_OF_ETH_HEADER + uxIPHeaderLength + ( size_t ) ucIntermediateResult;
+
+                if( uxIPHeaderLength == ipSIZE_OF_IPv6_HEADER )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    const IPHeader_IPv6_t * pxIPHeader = ( ( const IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                    uxIPLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usPayloadLength ) + ipSIZE_OF_IPv6_HEADER;
+                }
+                else
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                    uxIPLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usLength );
+                }
+
+                /* Padding bytes at the end of the frame are not part of the payload. */
+                if( ( ucIntermediateResult >= ipSIZE_OF_TCP_HEADER ) &&
+                    ( ( ipSIZE_OF_ETH_HEADER + uxIPLength ) > uxHeaderLength ) &&
+                    ( ( ipSIZE_OF_ETH_HEADER + uxIPLength ) <= pxNetworkBuffer->xDataLength ) )
+                {
+                    uxPayloadLength = ( ipSIZE_OF_ETH_HEADER + uxIPLength ) - uxHeaderLength;
+                }
+            }
+
+            *puxHeaderLength = uxHeaderLength;
+
+            return uxPayloadLength;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a received packet can be appended to the first segment held
+ *        by the receive coalescing: it must have the same addresses and ports,
+ *        and the same acknowledgement number, window size and TCP options.
+ *
+ * @param[in] pxFirst The first segment held.
+ * @param[in] pxNetworkBuffer The packet that was received.
+ *
+ * @return pdTRUE when the packet belongs to the same flow, otherwise pdFALSE.
+ */
+        static BaseType_t prvTCPCoalesceSameFlow( const NetworkBufferDescriptor_t * pxFirst,
+                                                  const NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            BaseType_t xResult = pdFALSE;
+            const size_t uxIPHeaderLength = uxIPHeaderSizePacket( pxFirst );
+            const uint8_t * pucFirst = pxFirst->pucEthernetBuffer;
+            const uint8_t * pucPacket = pxNetworkBuffer->pucEthernetBuffer;
+            /* The source and destination address are at the end of the IPv4 header,
+             * and follow the first 8 bytes of the IPv6 header. */
+            const size_t uxAddressOffset = ( uxIPHeaderLength == ipSIZE_OF_IPv6_HEADER ) ? 8U : 12U;
+            const size_t uxTCPOffset = ipSIZE_OF_ETH_HEADER + uxIPHeaderLength;
+            const size_t uxTCPHeaderLength = ( size_t ) ( ( pucFirst[ uxTCPOffset + 12U ] & tcpVALID_BITS_IN_TCP_OFFSET_BYTE ) >> 2 );
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            if( ( ( ( const EthernetHeader_t * ) pucFirst )->usFrameType == ( ( const EthernetHeader_t * ) pucPacket )->usFrameType ) &&
+                ( pxFirst->pxEndPoint == pxNetworkBuffer->pxEndPoint ) &&
+                ( uxIPHeaderSizePacket( pxNetworkBuffer ) == uxIPHeaderLength ) )
+            {
+                /* Compare the IP addresses, the ports, the acknowledgement number
+                 * together with the TCP offset, the window size and the options. */
+                if( ( memcmp( &( pucFirst[ ipSIZE_OF_ETH_HEADER + uxAddressOffset ] ),
+                              &( pucPacket[ ipSIZE_OF_ETH_HEADER + uxAddressOffset ] ),
+                              uxIPHeaderLength - uxAddressOffset ) == 0 ) &&
+                    ( memcmp( &( pucFirst[ uxTCPOffset ] ), &( pucPacket[ uxTCPOffset ] ), 4U ) == 0 ) &&
+                    ( memcmp( &( pucFirst[ uxTCPOffset + 8U ] ), &( pucPacket[ uxTCPOffset + 8U ] ), 5U ) == 0 ) &&
+                    ( memcmp( &( pucFirst[ uxTCPOffset + 14U ] ), &( pucPacket[ uxTCPOffset + 14U ] ), 2U ) == 0 ) &&
+                    ( memcmp( &( pucFirst[ uxTCPOffset + ipSIZE_OF_TCP_HEADER ] ),
+                              &( pucPacket[ uxTCPOffset + ipSIZE_OF_TCP_HEADER ] ),
+                              uxTCPHeaderLength - ipSIZE_OF_TCP_HEADER ) == 0 ) )
+                {
+                    xResult = pdTRUE;
+                }
+            }
+
+            return xResult;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Copy the headers of the first segment held and the payload of all
+ *        segments held into a new network buffer, and release the segments.
+ *
+ * @return The new network buffer, or NULL when it could not be allocated. In
+ *         that case the segments held are left untouched.
+ */
+        static NetworkBufferDescriptor_t * prvTCPCoalesceMerge( void )
+        {
+            const NetworkBufferDescriptor_t * pxFirst = pxCoalesceSegments[ 0 ];
+            NetworkBufferDescriptor_t * pxMerged;
+            size_t uxHeaderLength;
+            size_t uxSegmentHeaderLength;
+            size_t uxPayloadLength;
+            size_t uxOffset;
+            size_t uxIndex;
+            uint8_t ucTCPFlags = 0U;
+
+            ( void ) prvTCPCoalescePayloadLength( pxFirst, &uxHeaderLength );
+
+            pxMerged = pxGetNetworkBufferWithDescriptor( uxHeaderLength + uxCoalescePayloadLength, 0U );
+
+            if( pxMerged != NULL )
+            {
+                const size_t uxIPHeaderLength = uxIPHeaderSizePacket( pxFirst );
+
+                ( void ) memcpy( pxMerged->pucEthernetBuffer, pxFirst->pucEthernetBuffer, uxHeaderLength );
+                pxMerged->pxInterface = pxFirst->pxInterface;
+                pxMerged->pxEndPoint = pxFirst->pxEndPoint;
+                uxOffset = uxHeaderLength;
+
+                for( uxIndex = 0U; uxIndex < uxCoalesceCount; uxIndex++ )
+                {
+                    NetworkBufferDescriptor_t * pxSegment = pxCoalesceSegments[ uxIndex ];
+
+                    uxPayloadLength = prvTCPCoalescePayloadLength( pxSegment, &uxSegmentHeaderLength );
+                    ( void ) memcpy( &( pxMerged->pucEthernetBuffer[ uxOffset ] ),
+                                     &( pxSegment->pucEthernetBuffer[ uxSegmentHeaderLength ] ),
+                                     uxPayloadLength );
+                    uxOffset += uxPayloadLength;
+
+                    /* A PSH flag in any of the segments is passed on. */
+                    ucTCPFlags |= pxSegment->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderLength + ipTCP_FLAGS_OFFSET ];
+
+                    vReleaseNetworkBufferAndDescriptor( pxSegment );
+                    pxCoalesceSegments[ uxIndex ] = NULL;
+                }
+
+                pxMerged->xDataLength = uxOffset;
+                pxMerged->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderLength + ipTCP_FLAGS_OFFSET ] = ucTCPFlags;
+
+                /* Only the length field of the IP header is updated, the checksums
+                 * of the segments have been verified already. */
+                if( uxIPHeaderLength == ipSIZE_OF_IPv6_HEADER )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    IPHeader_IPv6_t * pxIPHeader = ( ( IPHeader_IPv6_t * ) &( pxMerged->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                    pxIPHeader->usPayloadLength = FreeRTOS_htons( ( uint16_t ) ( uxOffset - ipSIZE_OF_ETH_HEADER - ipSIZE_OF_IPv6_HEADER ) );
+                }
+                else
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    IPHeader_t * pxIPHeader = ( ( IPHeader_t * ) &( pxMerged->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                    pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( uxOffset - ipSIZE_OF_ETH_HEADER ) );
+                }
+            }
+
+            return pxMerged;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Offer a received and verified TCP packet to the receive coalescing.
+ *        Data segments with only the ACK and PSH flags are held, and merged
+ *        with the next segments of the same flow. Any other packet causes a
+ *        flush of the segments held, so that the order of processing is kept.
+ *
+ * @param[in] pxNetworkBuffer The network buffer holding the TCP packet.
+ *
+ * @return pdPASS when the packet is held, it may not be accessed anymore by the
+ *         caller. pdFAIL when the packet must be passed to
+ *         xProcessReceivedTCPPacket() as usual.
+ */
+        BaseType_t xTCPRxCoalesce( NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            BaseType_t xResult = pdFAIL;
+            size_t uxHeaderLength;
+            const size_t uxPayloadLength = prvTCPCoalescePayloadLength( pxNetworkBuffer, &uxHeaderLength );
+
+            /* Merging needs a larger network buffer. */
+            if( ( xBufferAllocFixedSize == pdFALSE ) &&
+                ( uxPayloadLength > 0U ) &&
+                ( uxPayloadLength <= ( size_t ) ipconfigTCP_RX_COALESCE_MAX_SIZE ) )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                const TCPHeader_t * pxTCPHeader = ( ( const TCPHeader_t * )
+                                                    &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer ) ] ) );
+                const uint32_t ulSequenceNumber = FreeRTOS_ntohl( pxTCPHeader->ulSequenceNumber );
+
+                if( ( pxTCPHeader->ucTCPFlags & ( uint8_t ) ~tcpTCP_FLAG_PSH ) == tcpTCP_FLAG_ACK )
+                {
+                    if( ( uxCoalesceCount == 0U ) ||
+                        ( uxCoalesceCount >= tcpRX_COALESCE_MAX_SEGMENTS ) ||
+                        ( ulSequenceNumber != ulCoalesceNextSequence ) ||
+                        ( ( uxCoalescePayloadLength + uxPayloadLength ) > ( size_t ) ipconfigTCP_RX_COALESCE_MAX_SIZE ) ||
+                        ( prvTCPCoalesceSameFlow( pxCoalesceSegments[ 0 ], pxNetworkBuffer ) == pdFALSE ) )
+                    {
+                        vTCPRxCoalesceFlush();
+                    }
+
+                    pxCoalesceSegments[ uxCoalesceCount ] = pxNetworkBuffer;
+                    uxCoalesceCount++;
+                    uxCoalescePayloadLength += uxPayloadLength;
+                    ulCoalesceNextSequence = ulSequenceNumber + ( uint32_t ) uxPayloadLength;
+                    xResult = pdPASS;
+                }
+            }
+
+            if( xResult == pdFAIL )
+            {
+                /* A packet of this connection may be held: keep the order. */
+                vTCPRxCoalesceFlush();
+            }
+
+            return xResult;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Pass the segments held by the receive coalescing to
+ *        xProcessReceivedTCPPacket(). When there is more than one, they are
+ *        merged into a single segment. If no buffer is available for that,
+ *        they are processed one by one.
+ */
+        void vTCPRxCoalesceFlush( void )
+        {
+            NetworkBufferDescriptor_t * pxMerged = NULL;
+            size_t uxIndex;
+
+            if( uxCoalesceCount > 1U )
+            {
+                pxMerged = prvTCPCoalesceMerge();
+            }
+
+            if( pxMerged != NULL )
+            {
+                if( xProcessReceivedTCPPacket( pxMerged ) != pdPASS )
+                {
+                    vReleaseNetworkBufferAndDescriptor( pxMerged );
+                }
+            }
+            else
+            {
+                for( uxIndex = 0U; uxIndex < uxCoalesceCount; uxIndex++ )
+                {
+                    if( xProcessReceivedTCPPacket( pxCoalesceSegments[ uxIndex ] ) != pdPASS )
+                    {
+                        vReleaseNetworkBufferAndDescriptor( pxCoalesceSegments[ uxIndex ] );
+                    }
+
+                    pxCoalesceSegments[ uxIndex ] = NULL;
+                }
+            }
+
+            uxCoalesceCount = 0U;
+            uxCoalescePayloadLength = 0U;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_RX_COALESCE != 0 */
+
 
 /**
  * @brief In the API accept(), the user asks is there is a new client? As API's can
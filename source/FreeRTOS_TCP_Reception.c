@@ -68,6 +68,16 @@
                                                   FreeRTOS_Socket_t * const pxSocket,
                                                   BaseType_t xHasSYNFlag );
 
+    #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+
+/*
+ * Handle the time-stamps option of a received segment: negotiation, PAWS and
+ * the time-stamp that will be echoed.
+ */
+        static BaseType_t prvCheckTimeStamps( FreeRTOS_Socket_t * pxSocket,
+                                              const TCPHeader_t * pxTCPHeader );
+    #endif
+
     #if ( ipconfigUSE_TCP_WIN == 1 )
 
 /*
@@ -168,6 +178,15 @@
                         uxOptionsLength -= ( size_t ) lResult;
                         pucPtr = &( pucPtr[ lResult ] );
                     }
+
+                    #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+                    {
+                        if( xReturn != pdFAIL )
+                        {
+                            xReturn = prvCheckTimeStamps( pxSocket, pxTCPHeader );
+                        }
+                    }
+                    #endif
                 }
             }
         }
@@ -176,6 +195,167 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_HEADER_PREDICTION != 0 )
+
+/**
+ * @brief Header prediction: check if a received segment is exactly what an
+ *        established connection expects next, i.e. in-order data and/or an
+ *        ACK, with either no options or only the time-stamps option in the
+ *        layout that prvSetTimeStampOption() also uses.
+ *
+ * @param[in] pxSocket The socket handling the connection.
+ * @param[in] pxNetworkBuffer The network buffer containing the TCP packet.
+ *
+ * @return pdTRUE when the segment was predicted.  Its time-stamps, if any,
+ *         have been handled, prvCheckOptions() must not be called and the
+ *         segment can be passed to prvTCPHandlePredicted().  Otherwise pdFALSE,
+ *         and nothing has been changed.
+ */
+        BaseType_t prvTCPHeaderPrediction( FreeRTOS_Socket_t * pxSocket,
+                                           const NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            size_t uxTCPHeaderOffset = ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer );
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * )
+                                                            &( pxNetworkBuffer->pucEthernetBuffer[ uxTCPHeaderOffset ] ) );
+            const TCPHeader_t * pxTCPHeader = &( pxProtocolHeaders->xTCPHeader );
+            TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+            uint8_t ucOffset = pxTCPHeader->ucTCPOffset & tcpTCP_OFFSET_LENGTH_BITS;
+            BaseType_t xReturn = pdFALSE;
+
+            /* Only ACK and PSH may be set, the segment must start at the next
+             * expected sequence number, and nothing may have been received
+             * beyond it, so there is no out-of-order data waiting.  Closing
+             * connections are left to prvTCPHandleState(). */
+            if( ( pxSocket->u.xTCP.eTCPState == eESTABLISHED ) &&
+                ( ( pxTCPHeader->ucTCPFlags & ( uint8_t ) ~tcpTCP_FLAG_PSH ) == tcpTCP_FLAG_ACK ) &&
+                ( FreeRTOS_ntohl( pxTCPHeader->ulSequenceNumber ) == pxTCPWindow->rx.ulCurrentSequenceNumber ) &&
+                ( pxTCPWindow->rx.ulHighestSequenceNumber == pxTCPWindow->rx.ulCurrentSequenceNumber ) &&
+                ( pxSocket->u.xTCP.bits.bFinSent == pdFALSE_UNSIGNED ) &&
+                ( pxSocket->u.xTCP.bits.bFinRecv == pdFALSE_UNSIGNED ) )
+            {
+                if( ucOffset == tcpTCP_OFFSET_STANDARD_LENGTH )
+                {
+                    /* No options at all. */
+                    xReturn = pdTRUE;
+                }
+
+                #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+                    else if( ( ucOffset == ( tcpTCP_OFFSET_STANDARD_LENGTH + ( tcpTCP_OPT_TIMESTAMP_SPACE << 2 ) ) ) &&
+                             ( pxSocket->u.xTCP.bits.bTimeStamps != pdFALSE_UNSIGNED ) &&
+                             ( pxNetworkBuffer->xDataLength >= ( uxTCPHeaderOffset + ipSIZE_OF_TCP_HEADER + tcpTCP_OPT_TIMESTAMP_SPACE ) ) &&
+                             ( pxTCPHeader->ucOptdata[ 0 ] == tcpTCP_OPT_NOOP ) &&
+                             ( pxTCPHeader->ucOptdata[ 1 ] == tcpTCP_OPT_NOOP ) &&
+                             ( pxTCPHeader->ucOptdata[ 2 ] == ( uint8_t ) tcpTCP_OPT_TIMESTAMP ) &&
+                             ( pxTCPHeader->ucOptdata[ 3 ] == ( uint8_t ) tcpTCP_OPT_TIMESTAMP_LEN ) )
+                    {
+                        uint32_t ulValue = ulChar2u32( &( pxTCPHeader->ucOptdata[ 4 ] ) );
+                        int32_t lAge = ( int32_t ) ( pxSocket->u.xTCP.ulTimeStampRecent - ulValue );
+
+                        /* A segment that fails the PAWS test is left to
+                         * prvCheckOptions(), which will drop it.  Otherwise this
+                         * is what prvCheckTimeStamps() does for a segment at the
+                         * left edge of the reception window. */
+                        if( lAge <= 0 )
+                        {
+                            pxSocket->u.xTCP.ulTimeStampValue = ulValue;
+                            pxSocket->u.xTCP.ulTimeStampEchoReply = ulChar2u32( &( pxTCPHeader->ucOptdata[ 8 ] ) );
+                            pxSocket->u.xTCP.bits.bTimeStampSeen = pdTRUE_UNSIGNED;
+                            pxSocket->u.xTCP.ulTimeStampRecent = ulValue;
+                            pxTCPWindow->ulTimeStampEcho = pxSocket->u.xTCP.ulTimeStampEchoReply;
+                            pxTCPWindow->u.bits.bTimeStampEcho = pdTRUE_UNSIGNED;
+                            xReturn = pdTRUE;
+                        }
+                    }
+                #endif /* ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 */
+                else
+                {
+                    /* Other options, let prvCheckOptions() parse them. */
+                }
+            }
+
+            return xReturn;
+        }
+
+    #endif /* ipconfigUSE_TCP_HEADER_PREDICTION != 0 */
+    /*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+
+/**
+ * @brief Handle the time-stamps option ( RFC 7323 ) of a received segment, after
+ *        prvSingleStepTCPHeaderOptions() has stored its TSval and TSecr.
+ *
+ * @param[in] pxSocket The socket handling the connection.
+ * @param[in] pxTCPHeader The TCP header of the received segment.
+ *
+ * @return pdFAIL when the segment must be dropped because its time-stamp is
+ *         older than the most recent one ( PAWS ), otherwise pdPASS.
+ */
+        static BaseType_t prvCheckTimeStamps( FreeRTOS_Socket_t * pxSocket,
+                                              const TCPHeader_t * pxTCPHeader )
+        {
+            BaseType_t xReturn = pdPASS;
+            TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+            uint32_t ulSequenceNumber = FreeRTOS_ntohl( pxTCPHeader->ulSequenceNumber );
+            int32_t lAge;
+
+            if( pxSocket->u.xTCP.bits.bTimeStampSeen == pdFALSE_UNSIGNED )
+            {
+                /* No time-stamps in this segment. */
+            }
+            else if( ( pxTCPHeader->ucTCPFlags & tcpTCP_FLAG_SYN ) != 0U )
+            {
+                /* Time-stamps were offered in a SYN, or accepted in a SYN+ACK
+                 * of a connection that offered them. */
+                pxSocket->u.xTCP.bits.bTimeStamps = pdTRUE_UNSIGNED;
+                pxSocket->u.xTCP.ulTimeStampRecent = pxSocket->u.xTCP.ulTimeStampValue;
+            }
+            else if( pxSocket->u.xTCP.bits.bTimeStamps != pdFALSE_UNSIGNED )
+            {
+                lAge = ( int32_t ) ( pxSocket->u.xTCP.ulTimeStampRecent - pxSocket->u.xTCP.ulTimeStampValue );
+
+                if( ( lAge > 0 ) && ( ( pxTCPHeader->ucTCPFlags & tcpTCP_FLAG_RST ) == 0U ) )
+                {
+                    /* PAWS: this segment is older than one that was received
+                     * earlier, it may belong to a previous wrap of the sequence
+                     * numbers. */
+                    FreeRTOS_debug_printf( ( "PAWS: drop segment with TSval %u < %u\n",
+                                             ( unsigned ) pxSocket->u.xTCP.ulTimeStampValue,
+                                             ( unsigned ) pxSocket->u.xTCP.ulTimeStampRecent ) );
+                    xReturn = pdFAIL;
+                }
+                else
+                {
+                    /* Only a segment which is not beyond the left edge of the
+                     * reception window updates the time-stamp that will be echoed. */
+                    if( xSequenceGreaterThan( ulSequenceNumber, pxTCPWindow->rx.ulCurrentSequenceNumber ) == pdFALSE )
+                    {
+                        pxSocket->u.xTCP.ulTimeStampRecent = pxSocket->u.xTCP.ulTimeStampValue;
+                    }
+
+                    if( ( pxTCPHeader->ucTCPFlags & tcpTCP_FLAG_ACK ) != 0U )
+                    {
+                        /* Let ulTCPWindowTxAck() measure the RTT from TSecr. */
+                        pxTCPWindow->ulTimeStampEcho = pxSocket->u.xTCP.ulTimeStampEchoReply;
+                        pxTCPWindow->u.bits.bTimeStampEcho = pdTRUE_UNSIGNED;
+                    }
+                }
+            }
+            else
+            {
+                /* Time-stamps were not negotiated for this connection. */
+            }
+
+            return xReturn;
+        }
+
+    #endif /* ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 */
+    /*-----------------------------------------------------------*/
+
 /**
  * @brief Identify and deal with a single TCP header option, advancing the pointer to
  *        the header.
@@ -237,7 +417,9 @@
                     /* Option is only valid in SYN phase. */
                     if( xHasSYNFlag != 0 )
                     {
-                        pxSocket->u.xTCP.ucPeerWinScaleFactor = pucPtr[ 2 ];
+                        /* RFC 7323: a larger shift count must be treated
+                         * as the maximum of 14. */
+                        pxSocket->u.xTCP.ucPeerWinScaleFactor = ( uint8_t ) FreeRTOS_min_uint32( ( uint32_t ) pucPtr[ 2 ], tcpTCP_OPT_WSOPT_MAX_SHIFT );
                         pxSocket->u.xTCP.bits.bWinScaling = pdTRUE_UNSIGNED;
                     }
 
@@ -245,6 +427,60 @@
                 }
             }
         #endif /* ipconfigUSE_TCP_WIN */
+
+        #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+            else if( pucPtr[ 0 ] == tcpTCP_OPT_TIMESTAMP )
+            {
+                /* The TCP Timestamps Option: TSval and TSecr. */
+                /* Confirm that the option fits in the remaining buffer space. */
+                if( ( uxRemainingOptionsBytes < ( size_t ) tcpTCP_OPT_TIMESTAMP_LEN ) || ( pucPtr[ 1 ] != ( uint8_t ) tcpTCP_OPT_TIMESTAMP_LEN ) )
+                {
+                    lIndex = -1;
+                }
+                else
+                {
+                    /* The values will be checked by prvCheckTimeStamps(), once
+                     * all options have been parsed. */
+                    pxSocket->u.xTCP.ulTimeStampValue = ulChar2u32( &( pucPtr[ 2 ] ) );
+                    pxSocket->u.xTCP.ulTimeStampEchoReply = ulChar2u32( &( pucPtr[ 6 ] ) );
+                    pxSocket->u.xTCP.bits.bTimeStampSeen = pdTRUE_UNSIGNED;
+
+                    lIndex = ( int32_t ) tcpTCP_OPT_TIMESTAMP_LEN;
+                }
+            }
+        #endif /* ipconfigUSE_TCP_TIMESTAMP_OPTION */
+
+        #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+            else if( pucPtr[ 0 ] == tcpTCP_OPT_FAST_OPEN )
+            {
+                /* The TCP Fast Open cookie option, empty for a cookie request. */
+                ucLen = pucPtr[ 1 ];
+
+                if( ( ucLen < ( uint8_t ) 2U ) || ( uxRemainingOptionsBytes < ( size_t ) ucLen ) )
+                {
+                    lIndex = -1;
+                }
+                else
+                {
+                    size_t uxCookieLength = ( size_t ) ucLen - 2U;
+
+                    /* Only valid in the SYN phase.  A cookie of an odd or an
+                     * unsupported length is ignored. */
+                    if( ( xHasSYNFlag != 0 ) &&
+                        ( pxSocket->u.xTCP.bits.bFastOpen != pdFALSE_UNSIGNED ) &&
+                        ( ( uxCookieLength & 1U ) == 0U ) &&
+                        ( ( uxCookieLength == 0U ) || ( uxCookieLength >= tcpFAST_OPEN_COOKIE_MIN ) ) &&
+                        ( uxCookieLength <= tcpFAST_OPEN_COOKIE_MAX ) )
+                    {
+                        ( void ) memcpy( pxSocket->u.xTCP.ucFastOpenCookie, &( pucPtr[ 2 ] ), uxCookieLength );
+                        pxSocket->u.xTCP.ucFastOpenCookieLength = ( uint8_t ) uxCookieLength;
+                        pxSocket->u.xTCP.bits.bFastOpenSeen = pdTRUE_UNSIGNED;
+                    }
+
+                    lIndex = ( int32_t ) ucLen;
+                }
+            }
+        #endif /* ipconfigUSE_TCP_FAST_OPEN */
         else if( pucPtr[ 0 ] == tcpTCP_OPT_MSS )
         {
             /* Confirm that the option fits in the remaining buffer space. */
@@ -383,6 +619,12 @@
             if( ( pxSocket->u.xTCP.txStream != NULL ) && ( ulCount > 0U ) )
             {
                 /* Just advancing the tail index, 'ulCount' bytes have been confirmed. */
+                #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+                {
+                    vTCPTxReferenceAcked( pxSocket, ( size_t ) ulCount );
+                }
+                #endif
+
                 ( void ) uxStreamBufferGet( pxSocket->u.xTCP.txStream, 0, NULL, ( size_t ) ulCount, pdFALSE );
                 pxSocket->xEventBits |= ( EventBits_t ) eSOCKET_SEND;
 
@@ -543,6 +785,100 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+
+/**
+ * @brief Called from prvStoreRxData() for in-order data.  In buffer-chain
+ *        mode, the socket keeps the network buffer, so the payload doesn't
+ *        have to be copied.  The headers are copied to a new, small network
+ *        buffer, which replaces '*ppxNetworkBuffer' and which will be used to
+ *        send the reply.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in,out] ppxNetworkBuffer The network buffer descriptor.
+ * @param[in] pucRxBuffer The first byte of the data to be stored.
+ * @param[in] ulRxLength The number of bytes to be stored.
+ *
+ * @return pdTRUE when the socket has become the owner of the network buffer.
+ */
+        static BaseType_t prvStoreRxBuffer( FreeRTOS_Socket_t * pxSocket,
+                                            NetworkBufferDescriptor_t ** ppxNetworkBuffer,
+                                            const uint8_t * pucRxBuffer,
+                                            uint32_t ulRxLength )
+        {
+            NetworkBufferDescriptor_t * pxNetworkBuffer = *( ppxNetworkBuffer );
+            NetworkBufferDescriptor_t * pxReplyBuffer = NULL;
+            /* The length of the headers, possibly followed by some skipped bytes. */
+            size_t uxOffset = ( size_t ) ( pucRxBuffer - pxNetworkBuffer->pucEthernetBuffer );
+            size_t uxNeeded = FreeRTOS_max_size_t( uxOffset, sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket ) );
+            BaseType_t xReturn = pdFALSE;
+
+            if( ( pxSocket->u.xTCP.bits.bRxBufferChain != pdFALSE_UNSIGNED ) &&
+                ( pxSocket->u.xTCP.eTCPState == eESTABLISHED ) &&
+                ( pxSocket->u.xTCP.uxRxBufferCount < ( UBaseType_t ) ipconfigTCP_RX_BUFFER_COUNT ) )
+            {
+                pxReplyBuffer = pxDuplicateNetworkBufferWithDescriptor( pxNetworkBuffer, uxNeeded );
+            }
+
+            if( pxReplyBuffer != NULL )
+            {
+                if( xTCPRxBufferAdd( pxSocket, pxNetworkBuffer, &( pxNetworkBuffer->pucEthernetBuffer[ uxOffset ] ), ulRxLength ) != pdFALSE )
+                {
+                    *( ppxNetworkBuffer ) = pxReplyBuffer;
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    vReleaseNetworkBufferAndDescriptor( pxReplyBuffer );
+                }
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+    #endif /* ipconfigTCP_RX_BUFFER_COUNT != 0 */
+
+    #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+
+/**
+ * @brief Called from prvStoreRxData() before lTCPAddRxdata().  When the data
+ *        will be passed directly from the network buffer to the reception
+ *        handler, the handler may take that buffer.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in] pxNetworkBuffer The network buffer descriptor.
+ * @param[in] pucRxBuffer The first byte of the data to be stored.
+ * @param[in] lOffset The offset of the data in the RX stream.
+ *
+ * @return pdTRUE when the buffer has been offered to the handler.
+ */
+        static BaseType_t prvOfferRxBuffer( FreeRTOS_Socket_t * pxSocket,
+                                            NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                            const uint8_t * pucRxBuffer,
+                                            int32_t lOffset )
+        {
+            const StreamBuffer_t * pxStream = pxSocket->u.xTCP.rxStream;
+            /* The length of the headers, possibly followed by some skipped bytes. */
+            size_t uxOffset = ( size_t ) ( pucRxBuffer - pxNetworkBuffer->pucEthernetBuffer );
+            BaseType_t xReturn = pdFALSE;
+
+            /* lTCPAddRxdata() only passes the network buffer itself to the
+             * handler when the data is in-order and the RX stream is empty. */
+            if( ( lOffset == 0 ) &&
+                ( pxSocket->u.xTCP.eTCPState == eESTABLISHED ) &&
+                ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xTCP.pxHandleReceive ) &&
+                ( ( pxStream == NULL ) ||
+                  ( ( uxStreamBufferGetSize( pxStream ) == 0U ) && ( pxStream->uxFront == pxStream->uxHead ) ) ) )
+            {
+                vSocketRxBufferOffer( pxSocket, pxNetworkBuffer, FreeRTOS_max_size_t( uxOffset, sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket ) ) );
+                xReturn = pdTRUE;
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+    #endif /* ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 */
+
 /**
  * @brief prvStoreRxData(): called from prvTCPHandleState().
  *        The second thing is to do is check if the payload data may
@@ -550,16 +886,20 @@
  *
  * @param[in] pxSocket The socket owning the connection.
  * @param[in] pucRecvData Pointer to received data.
- * @param[in] pxNetworkBuffer The network buffer descriptor.
+ * @param[in,out] ppxNetworkBuffer The network buffer descriptor.  In
+ *                                 buffer-chain mode, the socket may keep the
+ *                                 buffer and replace it with a copy of the
+ *                                 headers.
  * @param[in] ulReceiveLength The length of the received data.
  *
  * @return 0 on success, -1 on failure of storing data.
  */
     BaseType_t prvStoreRxData( FreeRTOS_Socket_t * pxSocket,
                                const uint8_t * pucRecvData,
-                               NetworkBufferDescriptor_t * pxNetworkBuffer,
+                               NetworkBufferDescriptor_t ** ppxNetworkBuffer,
                                uint32_t ulReceiveLength )
     {
+        NetworkBufferDescriptor_t * pxNetworkBuffer = *( ppxNetworkBuffer );
         /* Map the ethernet buffer onto the ProtocolHeader_t struct for easy access to the fields. */
         size_t uxIPOffset = uxIPHeaderSizePacket( pxNetworkBuffer );
         /* MISRA Ref 11.3.1 [Misaligned access] */
@@ -614,7 +954,36 @@
                     pucRxBuffer = &( pucRecvData[ ulSkipCount ] );
                 }
 
-                lStored = lTCPAddRxdata( pxSocket, ( uint32_t ) lOffset, pucRxBuffer, ulRxLength );
+                #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+                    if( ( lOffset == 0 ) && ( prvStoreRxBuffer( pxSocket, ppxNetworkBuffer, pucRxBuffer, ulRxLength ) != pdFALSE ) )
+                    {
+                        /* The network buffer is owned by the socket now. */
+                        pxNetworkBuffer = *( ppxNetworkBuffer );
+                        lStored = ( int32_t ) ulRxLength;
+                    }
+                    else
+                #endif /* ipconfigTCP_RX_BUFFER_COUNT != 0 */
+                {
+                    #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+                        BaseType_t xOffered = prvOfferRxBuffer( pxSocket, pxNetworkBuffer, pucRxBuffer, lOffset );
+                    #endif
+
+                    lStored = lTCPAddRxdata( pxSocket, ( uint32_t ) lOffset, pucRxBuffer, ulRxLength );
+
+                    #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+                    {
+                        NetworkBufferDescriptor_t * pxReplyBuffer = NULL;
+
+                        if( ( xOffered != pdFALSE ) && ( xSocketRxBufferTaken( &( pxReplyBuffer ) ) != pdFALSE ) )
+                        {
+                            /* The reception handler owns the network buffer now,
+                             * the copy of the headers is used to send the reply. */
+                            *( ppxNetworkBuffer ) = pxReplyBuffer;
+                            pxNetworkBuffer = pxReplyBuffer;
+                        }
+                    }
+                    #endif /* ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 */
+                }
 
                 if( lStored != ( int32_t ) ulRxLength )
                 {
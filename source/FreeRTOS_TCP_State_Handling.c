@@ -84,6 +84,22 @@
                                             uint32_t ulReceiveLength,
                                             UBaseType_t uxOptionsLength );
 
+    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+
+/*
+ * Server: check the Fast Open cookie of a SYN and store the data it carries.
+ */
+        static uint32_t prvTCPFastOpenAccept( FreeRTOS_Socket_t * pxSocket,
+                                              const uint8_t * pucRecvData,
+                                              uint32_t ulReceiveLength );
+
+/*
+ * Client: store the cookie of a SYN+ACK and drop the data that it acknowledged.
+ */
+        static void prvTCPFastOpenSynAck( FreeRTOS_Socket_t * pxSocket,
+                                          uint32_t ulAckNumber );
+    #endif
+
 
 /**
  * @brief Check whether the socket is active or not.
@@ -244,6 +260,7 @@
         TCPWindow_t * pxTCPWindow = &pxSocket->u.xTCP.xTCPWindow;
         BaseType_t xSendLength = 0;
         uint32_t ulAckNr = FreeRTOS_ntohl( pxTCPHeader->ulAckNr );
+        UBaseType_t uxOptionsLength = pxTCPWindow->ucOptionLength;
 
         if( ( ucTCPFlags & tcpTCP_FLAG_FIN ) != 0U )
         {
@@ -301,18 +318,37 @@
 
                 /* And wait for the user to close this socket. */
                 vTCPStateChange( pxSocket, eCLOSE_WAIT );
+
+                #if ( ipconfigTCP_TIME_WAIT_COUNT != 0 )
+                {
+                    /* The socket may be closed now, a repeated FIN will still
+                     * be acknowledged. */
+                    vTCPTimeWaitAdd( pxSocket );
+                }
+                #endif
             }
         }
 
         pxTCPWindow->ulOurSequenceNumber = pxTCPWindow->tx.ulCurrentSequenceNumber;
 
+        #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+        {
+            if( pxSocket->u.xTCP.bits.bTimeStamps != pdFALSE_UNSIGNED )
+            {
+                /* The FIN carries time-stamps as well, behind the SACK
+                 * option, if any. */
+                uxOptionsLength = prvSetTimeStampOption( pxSocket, pxTCPHeader, uxOptionsLength );
+            }
+        }
+        #endif
+
         if( pxTCPHeader->ucTCPFlags != 0U )
         {
-            ucIntermediateResult = ( uint8_t ) ( uxIPHeaderSizeSocket( pxSocket ) + ipSIZE_OF_TCP_HEADER + pxTCPWindow->ucOptionLength );
+            ucIntermediateResult = ( uint8_t ) ( uxIPHeaderSizeSocket( pxSocket ) + ipSIZE_OF_TCP_HEADER + uxOptionsLength );
             xSendLength = ( BaseType_t ) ucIntermediateResult;
         }
 
-        pxTCPHeader->ucTCPOffset = ( uint8_t ) ( ( ipSIZE_OF_TCP_HEADER + pxTCPWindow->ucOptionLength ) << 2 );
+        pxTCPHeader->ucTCPOffset = ( uint8_t ) ( ( ipSIZE_OF_TCP_HEADER + uxOptionsLength ) << 2 );
 
         if( xTCPWindowLoggingLevel != 0 )
         {
@@ -435,6 +471,15 @@
              * 1. */
             pxTCPWindow->ulOurSequenceNumber = pxTCPWindow->tx.ulFirstSequenceNumber + 1U;
 
+            #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+            {
+                if( pxSocket->u.xTCP.eTCPState == eCONNECT_SYN )
+                {
+                    prvTCPFastOpenSynAck( pxSocket, FreeRTOS_ntohl( pxTCPHeader->ulAckNr ) );
+                }
+            }
+            #endif
+
             #if ( ipconfigUSE_TCP_WIN == 1 )
             {
                 char pcBuffer[ 40 ]; /* Space to print an IP-address. */
@@ -472,6 +517,19 @@
             }
             #endif /* ipconfigUSE_TCP_WIN */
 
+            #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+            {
+                if( ( pxSocket->u.xTCP.bits.bTimeStamps != pdFALSE_UNSIGNED ) &&
+                    ( pxSocket->u.xTCP.usMSS > ( tcpMINIMUM_SEGMENT_LENGTH + tcpTCP_OPT_TIMESTAMP_SPACE ) ) )
+                {
+                    /* From now on, all segments carry 12 bytes of time-stamps,
+                     * which must be taken from the payload. */
+                    pxSocket->u.xTCP.usMSS = ( uint16_t ) ( pxSocket->u.xTCP.usMSS - tcpTCP_OPT_TIMESTAMP_SPACE );
+                    pxTCPWindow->usMSS = pxSocket->u.xTCP.usMSS;
+                }
+            }
+            #endif /* ipconfigUSE_TCP_TIMESTAMP_OPTION */
+
             /* This was the third step of connecting: SYN, SYN+ACK, ACK so now the
              * connection is established. */
             vTCPStateChange( pxSocket, eESTABLISHED );
@@ -481,6 +539,105 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+
+/**
+ * @brief Called by a server socket that received a SYN: when the SYN carries
+ *        a valid Fast Open cookie, the data in the SYN is stored in the
+ *        rxStream, so that it will be acknowledged by the SYN+ACK.
+ *
+ * @param[in] pxSocket The socket that received the SYN.
+ * @param[in] pucRecvData The data in the SYN.
+ * @param[in] ulReceiveLength The length of that data.
+ *
+ * @return The number of bytes that were accepted.
+ */
+        static uint32_t prvTCPFastOpenAccept( FreeRTOS_Socket_t * pxSocket,
+                                              const uint8_t * pucRecvData,
+                                              uint32_t ulReceiveLength )
+        {
+            uint8_t ucCookie[ tcpFAST_OPEN_COOKIE_LENGTH ];
+            uint32_t ulAccepted = 0U;
+            int32_t lStored;
+
+            pxSocket->u.xTCP.bits.bFastOpenValid = pdFALSE_UNSIGNED;
+
+            if( ( pxSocket->u.xTCP.bits.bFastOpenSeen != pdFALSE_UNSIGNED ) &&
+                ( pxSocket->u.xTCP.ucFastOpenCookieLength == tcpFAST_OPEN_COOKIE_LENGTH ) &&
+                ( prvTCPFastOpenCookieMake( pxSocket, ucCookie ) == pdPASS ) &&
+                ( memcmp( ucCookie, pxSocket->u.xTCP.ucFastOpenCookie, sizeof( ucCookie ) ) == 0 ) )
+            {
+                pxSocket->u.xTCP.bits.bFastOpenValid = pdTRUE_UNSIGNED;
+                ulAccepted = ulReceiveLength;
+
+                if( ulAccepted > ( uint32_t ) pxSocket->u.xTCP.uxRxStreamSize )
+                {
+                    /* Accept what fits, the peer will send the rest again. */
+                    ulAccepted = ( uint32_t ) pxSocket->u.xTCP.uxRxStreamSize;
+                }
+
+                if( ulAccepted > 0U )
+                {
+                    lStored = lTCPAddRxdata( pxSocket, 0U, pucRecvData, ulAccepted );
+                    ulAccepted = ( lStored > 0 ) ? ( uint32_t ) lStored : 0U;
+
+                    FreeRTOS_debug_printf( ( "TCP: Fast Open port %u accepted %u bytes\n",
+                                             pxSocket->usLocalPort,
+                                             ( unsigned ) ulAccepted ) );
+                }
+            }
+
+            return ulAccepted;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by a connecting socket that received a SYN+ACK: remember the
+ *        cookie of the peer, and when the SYN+ACK acknowledges the data that
+ *        was sent along with the SYN, remove that data from the txStream.
+ *
+ * @param[in] pxSocket The connecting socket.
+ * @param[in] ulAckNumber The acknowledgement number of the SYN+ACK.
+ */
+        static void prvTCPFastOpenSynAck( FreeRTOS_Socket_t * pxSocket,
+                                          uint32_t ulAckNumber )
+        {
+            TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+            uint32_t ulCount = ulAckNumber - pxTCPWindow->ulOurSequenceNumber;
+
+            if( ( pxSocket->u.xTCP.bits.bFastOpenSeen != pdFALSE_UNSIGNED ) &&
+                ( pxSocket->u.xTCP.ucFastOpenCookieLength != 0U ) )
+            {
+                prvTCPFastOpenCookieStore( pxSocket, pxSocket->u.xTCP.ucFastOpenCookie, ( size_t ) pxSocket->u.xTCP.ucFastOpenCookieLength );
+            }
+
+            if( ( pxSocket->u.xTCP.usFastOpenLength != 0U ) &&
+                ( ulCount == ( uint32_t ) pxSocket->u.xTCP.usFastOpenLength ) )
+            {
+                /* The data in the SYN has been accepted, it must not be passed
+                 * to the sliding window. */
+                #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+                {
+                    vTCPTxReferenceAcked( pxSocket, ( size_t ) ulCount );
+                }
+                #endif
+
+                vStreamBufferMoveMid( pxSocket->u.xTCP.txStream, ( size_t ) ulCount );
+                ( void ) uxStreamBufferGet( pxSocket->u.xTCP.txStream, 0U, NULL, ( size_t ) ulCount, pdFALSE );
+
+                pxTCPWindow->tx.ulCurrentSequenceNumber += ulCount;
+                pxTCPWindow->ulNextTxSequenceNumber += ulCount;
+                pxTCPWindow->ulOurSequenceNumber += ulCount;
+
+                pxSocket->xEventBits |= ( EventBits_t ) eSOCKET_SEND;
+            }
+
+            pxSocket->u.xTCP.usFastOpenLength = 0U;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_FAST_OPEN != 0 */
+
 /**
  * @brief prvHandleEstablished(): called from prvTCPHandleState()
  *        Called if the status is eESTABLISHED. Data reception has been handled
@@ -545,6 +702,12 @@
                  * confirmed, and because there is new space in the txStream, the
                  * user/owner should be woken up. */
                 /* _HT_ : only in case the socket's waiting? */
+                #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+                {
+                    vTCPTxReferenceAcked( pxSocket, ( size_t ) ulCount );
+                }
+                #endif
+
                 if( uxStreamBufferGet( pxSocket->u.xTCP.txStream, 0U, NULL, ( size_t ) ulCount, pdFALSE ) != 0U )
                 {
                     pxSocket->xEventBits |= ( EventBits_t ) eSOCKET_SEND;
@@ -658,6 +821,18 @@
                  * can not send-out both TCP options and also a full packet. Sending
                  * options (SACK) is always more urgent than sending data, which can be
                  * sent later. */
+                #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+                {
+                    /* The time-stamps are sent along with every segment.  They
+                     * were deducted from the MSS, so they don't hold back data.
+                     * prvTCPPrepareSend() will write them again. */
+                    if( pxSocket->u.xTCP.bits.bTimeStamps != pdFALSE_UNSIGNED )
+                    {
+                        uxOptionsLength -= tcpTCP_OPT_TIMESTAMP_SPACE;
+                    }
+                }
+                #endif
+
                 if( uxOptionsLength == 0U )
                 {
                     /* prvTCPPrepareSend might allocate a bigger network buffer, if
@@ -730,6 +905,10 @@
         UBaseType_t uxIntermediateResult = 0;
         uint32_t ulSum;
 
+        #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+            uint32_t ulFastOpenLength;
+        #endif
+
         /* First get the length and the position of the received data, if any.
          * pucRecvData will point to the first byte of the TCP payload. */
         ulReceiveLength = ( uint32_t ) prvCheckRxData( *ppxNetworkBuffer, &pucRecvData );
@@ -755,7 +934,7 @@
         }
 
         /* Storing data may result in a fatal error if malloc() fails. */
-        if( prvStoreRxData( pxSocket, pucRecvData, *ppxNetworkBuffer, ulReceiveLength ) < 0 )
+        if( prvStoreRxData( pxSocket, pucRecvData, ppxNetworkBuffer, ulReceiveLength ) < 0 )
         {
             xSendLength = -1;
         }
@@ -814,6 +993,14 @@
                     /* A new socket has been created, reply with a SYN+ACK.
                      * Acknowledge with seq+1 because the SYN is seen as pseudo data
                      * with len = 1. */
+                    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+                    {
+                        /* The data of a SYN with a valid cookie must be stored
+                         * before the options of the SYN+ACK overwrite it. */
+                        ulFastOpenLength = prvTCPFastOpenAccept( pxSocket, pucRecvData, ulReceiveLength );
+                    }
+                    #endif
+
                     uxOptionsLength = prvSetSynAckOptions( pxSocket, pxTCPHeader );
                     pxTCPHeader->ucTCPFlags = ( uint8_t ) tcpTCP_FLAG_SYN | ( uint8_t ) tcpTCP_FLAG_ACK;
 
@@ -830,6 +1017,14 @@
                     pxTCPWindow->rx.ulCurrentSequenceNumber = ulSequenceNumber + 1U;
                     pxTCPWindow->ulNextTxSequenceNumber = pxTCPWindow->tx.ulFirstSequenceNumber + 1U;
                     pxTCPWindow->tx.ulCurrentSequenceNumber = pxTCPWindow->tx.ulFirstSequenceNumber + 1U; /* because we send a TCP_SYN. */
+
+                    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+                    {
+                        /* The SYN+ACK acknowledges the data that was accepted. */
+                        pxTCPWindow->rx.ulHighestSequenceNumber += ulFastOpenLength;
+                        pxTCPWindow->rx.ulCurrentSequenceNumber += ulFastOpenLength;
+                    }
+                    #endif
                     break;
 
                 case eCONNECT_SYN:  /* (client) also called SYN_SENT: we've just send a
@@ -897,6 +1092,66 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_HEADER_PREDICTION != 0 )
+
+/**
+ * @brief The fast path of prvTCPHandleState() for a segment that passed
+ *        prvTCPHeaderPrediction(): in-order data and/or an ACK on an established
+ *        connection that is not closing.  There is no keep-alive, FIN or SYN to
+ *        look for and no state to dispatch on, and a pure ACK carries no data
+ *        to store.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in] ppxNetworkBuffer The network buffer descriptor holding the
+ *            packet received from the peer.
+ *
+ * @return The same as prvTCPHandleState().
+ */
+        BaseType_t prvTCPHandlePredicted( FreeRTOS_Socket_t * pxSocket,
+                                          NetworkBufferDescriptor_t ** ppxNetworkBuffer )
+        {
+            TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+            BaseType_t xSendLength = 0;
+            UBaseType_t uxOptionsLength;
+            uint32_t ulReceiveLength;
+            uint8_t * pucRecvData;
+
+            ulReceiveLength = ( uint32_t ) prvCheckRxData( *ppxNetworkBuffer, &pucRecvData );
+
+            if( ulReceiveLength == 0U )
+            {
+                /* A pure ACK: no SACK option will be sent. */
+                pxTCPWindow->ucOptionLength = 0U;
+            }
+            else
+            {
+                /* The segment starts at 'rx.ulCurrentSequenceNumber', which
+                 * was also the highest sequence number seen. */
+                pxTCPWindow->rx.ulHighestSequenceNumber = pxTCPWindow->rx.ulCurrentSequenceNumber + ulReceiveLength;
+
+                if( prvStoreRxData( pxSocket, pucRecvData, ppxNetworkBuffer, ulReceiveLength ) < 0 )
+                {
+                    xSendLength = -1;
+                }
+            }
+
+            if( xSendLength == 0 )
+            {
+                uxOptionsLength = prvSetOptions( pxSocket, *ppxNetworkBuffer );
+                xSendLength = prvHandleEstablished( pxSocket, ppxNetworkBuffer, ulReceiveLength, uxOptionsLength );
+
+                if( xSendLength > 0 )
+                {
+                    xSendLength = prvSendData( pxSocket, ppxNetworkBuffer, ulReceiveLength, xSendLength );
+                }
+            }
+
+            return xSendLength;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_HEADER_PREDICTION != 0 */
+
 /**
  * @brief Handle 'listen' event on the given socket.
  *
@@ -935,6 +1190,135 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_SYN_COOKIES != 0 ) && ( ipconfigTCP_HANG_PROTECTION == 1 )
+
+/**
+ * @brief Close the oldest half-open child of a listening socket, to make room
+ *        for a connection whose SYN cookie has returned.
+ *
+ * @param[in] pxSocket The listening socket.
+ */
+        static void prvTCPSynCookieMakeRoom( const FreeRTOS_Socket_t * pxSocket )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+            const ListItem_t * pxIterator;
+            FreeRTOS_Socket_t * pxChild;
+            FreeRTOS_Socket_t * pxOldest = NULL;
+            TickType_t xNow = xTaskGetTickCount();
+
+            for( pxIterator = listGET_NEXT( pxEnd );
+                 pxIterator != pxEnd;
+                 pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                pxChild = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                /* Only the children that were never passed to the application. */
+                if( ( pxChild->u.xTCP.bits.bPassQueued != pdFALSE_UNSIGNED ) &&
+                    ( pxChild->u.xTCP.pxPeerSocket == pxSocket ) &&
+                    ( pxChild != pxSocket ) &&
+                    ( ( pxChild->u.xTCP.eTCPState == eSYN_FIRST ) || ( pxChild->u.xTCP.eTCPState == eSYN_RECEIVED ) ) )
+                {
+                    if( ( pxOldest == NULL ) ||
+                        ( ( xNow - pxChild->u.xTCP.xLastActTime ) > ( xNow - pxOldest->u.xTCP.xLastActTime ) ) )
+                    {
+                        pxOldest = pxChild;
+                    }
+                }
+            }
+
+            if( pxOldest != NULL )
+            {
+                FreeRTOS_debug_printf( ( "TCP: port %u drops a half-open child for a SYN cookie\n",
+                                         pxSocket->usLocalPort ) );
+                ( void ) vSocketClose( pxOldest );
+            }
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_TCP_SYN_COOKIES != 0 ) && ( ipconfigTCP_HANG_PROTECTION == 1 ) */
+
+    #if ( ipconfigUSE_TCP_SYN_COOKIES != 0 )
+
+/**
+ * @brief A listening socket received an ACK. When it returns a valid SYN
+ *        cookie, create the child socket that the SYN+ACK would have created,
+ *        and bring it in the eSYN_RECEIVED state, so that the ACK will
+ *        connect it.
+ *
+ * @param[in] pxSocket The listening socket.
+ * @param[in] pxNetworkBuffer The network buffer with the ACK.
+ *
+ * @return The new socket, or NULL when the cookie is not valid, or when there
+ *         is no room for a new socket.
+ */
+        FreeRTOS_Socket_t * prvHandleSynCookie( FreeRTOS_Socket_t * pxSocket,
+                                                NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * )
+                                                            &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer ) ] ) );
+            FreeRTOS_Socket_t * pxNewSocket = NULL;
+            uint16_t usMSS = 0U;
+
+            if( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED )
+            {
+                usMSS = prvTCPSynCookieCheck( pxNetworkBuffer );
+            }
+
+            if( usMSS != 0U )
+            {
+                #if ( ipconfigTCP_HANG_PROTECTION == 1 )
+                {
+                    if( pxSocket->u.xTCP.usChildCount >= pxSocket->u.xTCP.usBacklog )
+                    {
+                        /* Half-open children only exist while they are
+                         * protected against hanging. */
+                        prvTCPSynCookieMakeRoom( pxSocket );
+                    }
+                }
+                #endif
+
+                if( pxSocket->u.xTCP.usChildCount < pxSocket->u.xTCP.usBacklog )
+                {
+                    pxNewSocket = prvHandleListen( pxSocket, pxNetworkBuffer );
+                }
+            }
+
+            if( pxNewSocket != NULL )
+            {
+                TCPWindow_t * pxTCPWindow = &( pxNewSocket->u.xTCP.xTCPWindow );
+                uint32_t ulOurSequenceNumber = FreeRTOS_ntohl( pxProtocolHeaders->xTCPHeader.ulAckNr ) - 1U;
+                uint32_t ulPeerSequenceNumber = FreeRTOS_ntohl( pxProtocolHeaders->xTCPHeader.ulSequenceNumber ) - 1U;
+
+                if( usMSS < pxNewSocket->u.xTCP.usMSS )
+                {
+                    pxNewSocket->u.xTCP.usMSS = usMSS;
+                }
+
+                /* The window was created with a new initial sequence number,
+                 * the one of the cookie must be used. */
+                vTCPWindowInit( pxTCPWindow, ulPeerSequenceNumber, ulOurSequenceNumber, ( uint32_t ) pxNewSocket->u.xTCP.usMSS );
+                pxTCPWindow->ulOurSequenceNumber = ulOurSequenceNumber;
+
+                /* Do what eSYN_FIRST would have done when sending the SYN+ACK. */
+                pxTCPWindow->rx.ulHighestSequenceNumber = ulPeerSequenceNumber + 1U;
+                pxTCPWindow->rx.ulCurrentSequenceNumber = ulPeerSequenceNumber + 1U;
+                pxTCPWindow->ulNextTxSequenceNumber = pxTCPWindow->tx.ulFirstSequenceNumber + 1U;
+                pxTCPWindow->tx.ulCurrentSequenceNumber = pxTCPWindow->tx.ulFirstSequenceNumber + 1U;
+                vTCPStateChange( pxNewSocket, eSYN_RECEIVED );
+            }
+
+            return pxNewSocket;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_SYN_COOKIES != 0 */
+
 
 /**
  * @brief Duplicates a socket after a listening socket receives a connection and bind
@@ -961,6 +1345,53 @@
         pxNewSocket->u.xTCP.uxEnoughSpace = pxSocket->u.xTCP.uxEnoughSpace;
         pxNewSocket->u.xTCP.uxRxWinSize = pxSocket->u.xTCP.uxRxWinSize;
         pxNewSocket->u.xTCP.uxTxWinSize = pxSocket->u.xTCP.uxTxWinSize;
+        #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+        {
+            pxNewSocket->u.xTCP.pxCongestionControl = pxSocket->u.xTCP.pxCongestionControl;
+        }
+        #endif
+        #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+        {
+            pxNewSocket->u.xTCP.bits.bRxBufferChain = pxSocket->u.xTCP.bits.bRxBufferChain;
+        }
+        #endif
+        #if ( ipconfigUSE_TCP_PACING != 0 )
+        {
+            pxNewSocket->u.xTCP.ulPacingRate = pxSocket->u.xTCP.ulPacingRate;
+        }
+        #endif
+        #if ( ipconfigUSE_TCP_ACK_POLICY != 0 )
+        {
+            pxNewSocket->u.xTCP.xAckPolicy = pxSocket->u.xTCP.xAckPolicy;
+        }
+        #endif
+        #if ( ipconfigUSE_TCP_RECORD_FRAMING != 0 )
+        {
+            pxNewSocket->u.xTCP.xRecordFraming = pxSocket->u.xTCP.xRecordFraming;
+        }
+        #endif
+        #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+        {
+            pxNewSocket->u.xTCP.bits.bFastOpen = pxSocket->u.xTCP.bits.bFastOpen;
+        }
+        #endif
+        #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+        {
+            pxNewSocket->u.xTCP.bits.bNoAutoTune = pxSocket->u.xTCP.bits.bNoAutoTune;
+        }
+        #endif
+        #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+        {
+            pxNewSocket->u.xTCP.bits.bFixedSizes = pxSocket->u.xTCP.bits.bFixedSizes;
+        }
+        #endif
+        #if ( ipconfigUSE_TCP_REUSEPORT != 0 )
+        {
+            /* The child shares the port, bind() must not refuse the other
+             * listening sockets. */
+            pxNewSocket->u.xTCP.bits.bReusePort = pxSocket->u.xTCP.bits.bReusePort;
+        }
+        #endif
 
         #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
         {
@@ -129,12 +129,28 @@ FreeRTOS_Socket_t * prvHandleListen_IPV6( FreeRTOS_Socket_t * pxSocket,
                                    pxSocket->u.xTCP.usChildCount,
                                    pxSocket->u.xTCP.usBacklog,
                                    ( pxSocket->u.xTCP.usChildCount == 1U ) ? "" : "ren" ) );
-                ( void ) prvTCPSendReset( pxNetworkBuffer );
+
+                #if ( ipconfigUSE_TCP_SYN_COOKIES != 0 )
+                {
+                    /* Answer with a SYN cookie, a socket will be created when
+                     * the peer returns it. */
+                    ( void ) prvTCPSendSynCookie( pxNetworkBuffer );
+                }
+                #else
+                {
+                    ( void ) prvTCPSendReset( pxNetworkBuffer );
+                }
+                #endif
             }
             else
             {
-                FreeRTOS_Socket_t * pxNewSocket = ( FreeRTOS_Socket_t * )
-                                                  FreeRTOS_socket( FREERTOS_AF_INET6, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+                #if ( ipconfigTCP_LISTEN_POOL_SIZE != 0 )
+                    /* Take a socket that was created in advance. */
+                    FreeRTOS_Socket_t * pxNewSocket = pxTCPListenPoolTake( pxSocket, FREERTOS_AF_INET6 );
+                #else
+                    FreeRTOS_Socket_t * pxNewSocket = ( FreeRTOS_Socket_t * )
+                                                      FreeRTOS_socket( FREERTOS_AF_INET6, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+                #endif
 
                 /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
                 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
@@ -209,6 +225,13 @@ FreeRTOS_Socket_t * prvHandleListen_IPV6( FreeRTOS_Socket_t * pxSocket,
 
             vTCPStateChange( pxReturn, eSYN_FIRST );
 
+            #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+            {
+                /* The remote address and port are known now. */
+                vSocketHashUpdate( pxReturn );
+            }
+            #endif
+
             /* Make a copy of the header up to the TCP header.  It is needed later
              * on, whenever data must be sent to the peer. */
             if( pxNetworkBuffer->xDataLength > sizeof( pxReturn->u.xTCP.xPacket.u.ucLastPacket ) )
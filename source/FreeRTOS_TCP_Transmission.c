@@ -76,6 +76,51 @@
         static uint8_t prvWinScaleFactor( const FreeRTOS_Socket_t * pxSocket );
     #endif
 
+    #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+
+/*
+ * Get the link speed of the interface that a connection uses, in Mbit/s.
+ */
+        static uint32_t prvTCPLinkSpeed( const FreeRTOS_Socket_t * pxSocket );
+
+/*
+ * Size the streams and windows of a new connection after its link speed.
+ */
+        static void prvTCPSizeForLinkSpeed( FreeRTOS_Socket_t * pxSocket );
+    #endif
+
+    #if ( ipconfigUSE_TCP_PACING != 0 )
+
+/** @brief The highest rate that prvTCPPacingRate() derives, in bytes per second. */
+        #define tcpPACING_MAX_RATE    ( 0x7FFFFFFFU )
+
+/*
+ * Get the pacing rate of a socket in bytes per second.
+ */
+        static uint32_t prvTCPPacingRate( const FreeRTOS_Socket_t * pxSocket );
+
+/*
+ * Add the bytes that may be sent since the last update to lPacingCredit.
+ */
+        static void prvTCPPacingRefill( FreeRTOS_Socket_t * pxSocket );
+    #endif
+
+    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+
+/*
+ * Write the TCP Fast Open option of a SYN or a SYN+ACK.
+ */
+        static UBaseType_t prvSetFastOpenOption( FreeRTOS_Socket_t * pxSocket,
+                                                 TCPHeader_t * pxTCPHeader,
+                                                 UBaseType_t uxOptionsLength );
+
+/*
+ * Send a SYN along with the data that the application queued already.
+ */
+        static BaseType_t prvTCPFastOpenSendSyn( FreeRTOS_Socket_t * pxSocket,
+                                                 uint32_t ulLen );
+    #endif
+
 /*------------------------------------------------------------------------*/
 
 /**
@@ -175,10 +220,15 @@
                  * of tries. */
                 pxSocket->u.xTCP.ucRepCount++;
 
-                /* Send the SYN message to make a connection.  The messages is
-                 * stored in the socket field 'xPacket'.  It will be wrapped in a
-                 * pseudo network buffer descriptor before it will be sent. */
-                prvTCPReturnPacket( pxSocket, NULL, ( uint32_t ) lResult, pdFALSE );
+                #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+                    if( prvTCPFastOpenSendSyn( pxSocket, ( uint32_t ) lResult ) == pdFALSE )
+                #endif
+                {
+                    /* Send the SYN message to make a connection.  The messages is
+                     * stored in the socket field 'xPacket'.  It will be wrapped in a
+                     * pseudo network buffer descriptor before it will be sent. */
+                    prvTCPReturnPacket( pxSocket, NULL, ( uint32_t ) lResult, pdFALSE );
+                }
             }
             else
             {
@@ -191,6 +241,46 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
+/**
+ * @brief Check if the interface of a socket, or the parent of a VLAN
+ *        interface, returned ipTX_BUSY and has not reported room since.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ *
+ * @return pdTRUE when no segments should be sent now.
+ */
+        static BaseType_t prvTCPInterfaceBusy( const FreeRTOS_Socket_t * pxSocket )
+        {
+            const NetworkInterface_t * pxInterface = NULL;
+            BaseType_t xReturn = pdFALSE;
+
+            if( pxSocket->pxEndPoint != NULL )
+            {
+                pxInterface = pxSocket->pxEndPoint->pxNetworkInterface;
+            }
+
+            #if ( ipconfigUSE_VLAN != 0 )
+            {
+                if( ( pxInterface != NULL ) && ( pxInterface->pxVLANParent != NULL ) )
+                {
+                    pxInterface = pxInterface->pxVLANParent;
+                }
+            }
+            #endif
+
+            if( ( pxInterface != NULL ) && ( pxInterface->xTxBusy != pdFALSE ) )
+            {
+                xReturn = pdTRUE;
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TX_BACKPRESSURE */
+
 /**
  * @brief prvTCPSendRepeated will try to send a series of messages, as
  *        long as there is data to be sent and as long as the transmit
@@ -209,8 +299,40 @@
         UBaseType_t uxOptionsLength = 0U;
         int32_t xSendLength;
 
+        #if ( ipconfigUSE_TCP_PACING != 0 )
+        {
+            if( pxSocket->u.xTCP.ulPacingRate != 0U )
+            {
+                prvTCPPacingRefill( pxSocket );
+            }
+        }
+        #endif
+
         for( uxIndex = 0U; uxIndex < ( UBaseType_t ) SEND_REPEATED_COUNT; uxIndex++ )
         {
+            #if ( ipconfigUSE_TCP_PACING != 0 )
+            {
+                if( ( pxSocket->u.xTCP.ulPacingRate != 0U ) && ( pxSocket->u.xTCP.lPacingCredit <= 0 ) )
+                {
+                    /* The rest will be sent when prvTCPNextTimeout() wakes up
+                     * the socket again. */
+                    break;
+                }
+            }
+            #endif
+
+            #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+            {
+                if( prvTCPInterfaceBusy( pxSocket ) != pdFALSE )
+                {
+                    /* The driver has no room, the segments stay in the window
+                     * until it calls FreeRTOS_NetworkInterfaceTxReady(). */
+                    pxSocket->u.xTCP.bits.bTxPaused = pdTRUE_UNSIGNED;
+                    break;
+                }
+            }
+            #endif
+
             /* prvTCPPrepareSend() might allocate a network buffer if there is data
              * to be sent. */
             xSendLength = prvTCPPrepareSend( pxSocket, ppxNetworkBuffer, uxOptionsLength );
@@ -220,6 +342,15 @@
                 break;
             }
 
+            #if ( ipconfigUSE_TCP_PACING != 0 )
+            {
+                if( pxSocket->u.xTCP.ulPacingRate != 0U )
+                {
+                    pxSocket->u.xTCP.lPacingCredit -= xSendLength;
+                }
+            }
+            #endif
+
             /* And return the packet to the peer. */
             prvTCPReturnPacket( pxSocket, *ppxNetworkBuffer, ( uint32_t ) xSendLength, ipconfigZERO_COPY_TX_DRIVER );
 
@@ -237,6 +368,143 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_PACING != 0 )
+
+/**
+ * @brief Get the pacing rate of a socket.  Unless the application has set a
+ *        fixed rate, the rate is the congestion window ( or the transmission
+ *        window ) per smoothed round-trip time.  It is multiplied by a gain
+ *        so that the window can still grow: 2 during slow start, 5/4
+ *        otherwise.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ *
+ * @return The rate in bytes per second, at least 1.
+ */
+        static uint32_t prvTCPPacingRate( const FreeRTOS_Socket_t * pxSocket )
+        {
+            const TCPWindow_t * pxWindow = &( pxSocket->u.xTCP.xTCPWindow );
+            uint32_t ulRate = pxSocket->u.xTCP.ulPacingRate;
+
+            if( ulRate == FREERTOS_TCP_PACING_AUTO )
+            {
+                uint32_t ulWindow = FreeRTOS_min_uint32( pxWindow->xSize.ulTxWindowLength, pxSocket->u.xTCP.ulWindowSize );
+                uint32_t ulSRTT = FreeRTOS_max_uint32( ( uint32_t ) pxWindow->lSRTT, 1U );
+                uint32_t ulGainNumerator = 5U;
+                uint32_t ulGainDenominator = 4U;
+
+                #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+                {
+                    ulWindow = FreeRTOS_min_uint32( ulWindow, pxWindow->xCongestion.ulWindow );
+
+                    if( pxWindow->xCongestion.ulWindow < pxWindow->xCongestion.ulSlowStartThreshold )
+                    {
+                        ulGainNumerator = 2U;
+                        ulGainDenominator = 1U;
+                    }
+                }
+                #endif
+
+                /* Send at least one segment per round-trip. */
+                ulWindow = FreeRTOS_max_uint32( ulWindow, ( uint32_t ) pxSocket->u.xTCP.usMSS );
+
+                if( ( ulWindow / ulSRTT ) >= ( tcpPACING_MAX_RATE / 2000U ) )
+                {
+                    /* Too fast to be paced. */
+                    ulRate = tcpPACING_MAX_RATE;
+                }
+                else
+                {
+                    /* Bytes per millisecond first, to avoid an overflow. */
+                    ulRate = ( ( ulWindow / ulSRTT ) * 1000U ) + ( ( ( ulWindow % ulSRTT ) * 1000U ) / ulSRTT );
+                    ulRate = ( ulRate / ulGainDenominator ) * ulGainNumerator;
+                    ulRate = FreeRTOS_max_uint32( ulRate, 1U );
+                }
+
+                #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+                {
+                    uint32_t ulSpeed = prvTCPLinkSpeed( pxSocket );
+
+                    /* Do not pace faster than the link can send: 125000 bytes
+                     * per second for every Mbit/s. */
+                    if( ( ulSpeed != 0U ) && ( ulSpeed <= ( tcpPACING_MAX_RATE / 125000U ) ) )
+                    {
+                        ulRate = FreeRTOS_min_uint32( ulRate, ulSpeed * 125000U );
+                    }
+                }
+                #endif
+            }
+
+            return ulRate;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Add the bytes that may be sent since the last update to the credit
+ *        of a paced socket.  The credit is limited to two segments, or to the
+ *        bytes of one clock tick when that is more, so that the segments do
+ *        not leave in a burst after an idle period.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ */
+        static void prvTCPPacingRefill( FreeRTOS_Socket_t * pxSocket )
+        {
+            TickType_t xNow = xTaskGetTickCount();
+            TickType_t xElapsed = xNow - pxSocket->u.xTCP.xPacingTime;
+            uint32_t ulRate = prvTCPPacingRate( pxSocket );
+            uint32_t ulBurst = FreeRTOS_max_uint32( 2U * ( uint32_t ) pxSocket->u.xTCP.usMSS, ulRate / ( uint32_t ) configTICK_RATE_HZ );
+            uint32_t ulAdd;
+
+            pxSocket->u.xTCP.xPacingTime = xNow;
+
+            if( xElapsed > ( TickType_t ) configTICK_RATE_HZ )
+            {
+                /* More than a second, the credit will be full anyway. */
+                xElapsed = ( TickType_t ) configTICK_RATE_HZ;
+            }
+
+            ulAdd = ( ( ulRate / ( uint32_t ) configTICK_RATE_HZ ) * ( uint32_t ) xElapsed ) +
+                    ( ( ( ulRate % ( uint32_t ) configTICK_RATE_HZ ) * ( uint32_t ) xElapsed ) / ( uint32_t ) configTICK_RATE_HZ );
+
+            if( ( ulAdd >= ulBurst ) ||
+                ( ( pxSocket->u.xTCP.lPacingCredit + ( int32_t ) ulAdd ) >= ( int32_t ) ulBurst ) )
+            {
+                pxSocket->u.xTCP.lPacingCredit = ( int32_t ) ulBurst;
+            }
+            else
+            {
+                pxSocket->u.xTCP.lPacingCredit += ( int32_t ) ulAdd;
+            }
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate when a paced socket may send its next segment.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ *
+ * @return The delay in milliseconds, zero when the socket is not paced or
+ *         when it may send now.
+ */
+        uint32_t ulTCPPacingDelay( const FreeRTOS_Socket_t * pxSocket )
+        {
+            uint32_t ulDelayMs = 0U;
+
+            if( ( pxSocket->u.xTCP.ulPacingRate != 0U ) && ( pxSocket->u.xTCP.lPacingCredit <= 0 ) )
+            {
+                uint32_t ulRate = prvTCPPacingRate( pxSocket );
+                uint32_t ulMissing = ( uint32_t ) ( -pxSocket->u.xTCP.lPacingCredit ) + 1U;
+
+                /* Round up, the credit must become positive. */
+                ulDelayMs = ( ( ulMissing / ulRate ) * 1000U ) + ( ( ( ( ulMissing % ulRate ) * 1000U ) + ulRate - 1U ) / ulRate );
+            }
+
+            return ulDelayMs;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_PACING != 0 */
+
 /**
  * @brief  Return (or send) a packet to the peer. The data is stored in pxBuffer,
  *         which may either point to a real network buffer or to a TCP socket field
@@ -256,8 +524,21 @@
     {
         const NetworkBufferDescriptor_t * pxNetworkBuffer = pxDescriptor;
         BaseType_t xIsIPv6 = pdFALSE;
+        BaseType_t xSent = pdFALSE;
 
-        if( pxNetworkBuffer != NULL )
+        #if ( ipconfigUSE_TCP_ACK_TEMPLATE != 0 )
+            if( pxSocket != NULL )
+            {
+                /* A pure ACK can be stamped out of the socket's ACK template. */
+                xSent = prvTCPAckTemplateSend( pxSocket, pxDescriptor, ulLen, xReleaseAfterSend );
+            }
+        #endif
+
+        if( xSent != pdFALSE )
+        {
+            /* The packet has been sent already. */
+        }
+        else if( pxNetworkBuffer != NULL )
         {
             #if ( ipconfigUSE_IPv6 != 0 )
                 if( uxIPHeaderSizePacket( pxNetworkBuffer ) == ipSIZE_OF_IPv6_HEADER )
@@ -282,21 +563,363 @@
         }
 
         #if ( ipconfigUSE_IPv6 != 0 )
-            if( xIsIPv6 == pdTRUE )
+            if( ( xSent == pdFALSE ) && ( xIsIPv6 == pdTRUE ) )
             {
                 prvTCPReturnPacket_IPV6( pxSocket, pxDescriptor, ulLen, xReleaseAfterSend );
             }
         #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
         #if ( ipconfigUSE_IPv4 != 0 )
-            if( xIsIPv6 == pdFALSE )
+            if( ( xSent == pdFALSE ) && ( xIsIPv6 == pdFALSE ) )
             {
                 prvTCPReturnPacket_IPV4( pxSocket, pxDescriptor, ulLen, xReleaseAfterSend );
             }
         #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+            if( pxSocket != NULL )
+            {
+                /* 'ulLen' is the length of the IP packet. */
+                ipACCOUNT_SOCKET_TX( pxSocket, ulLen );
+            }
+        #endif
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_ACK_TEMPLATE != 0 )
+
+/**
+ * @brief Keep a copy of the Ethernet and IP headers of a packet that is about
+ *        to be sent to the peer of an established connection, along with the
+ *        parts of the checksums that do not change from one ACK to the next.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in] pxNetworkBuffer The packet, with the MAC addresses filled in.
+ * @param[in] uxIPHeaderSize The size of the IP header.
+ */
+        void prvTCPAckTemplateStore( FreeRTOS_Socket_t * pxSocket,
+                                     const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                     size_t uxIPHeaderSize )
+        {
+            TCPAckTemplate_t * pxTemplate = &( pxSocket->u.xTCP.xAckTemplate );
+            const ProtocolHeaders_t * pxProtocolHeaders;
+            uint16_t usSum = 0U;
+
+            if( ( pxSocket->u.xTCP.eTCPState == eESTABLISHED ) &&
+                ( ( pxTemplate->xValid == pdFALSE ) || ( pxTemplate->ulGeneration != ulIPHeaderCacheGeneration ) ) )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxProtocolHeaders = ( ( const ProtocolHeaders_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSize ] ) );
+
+                ( void ) memcpy( pxTemplate->ucHeader, pxNetworkBuffer->pucEthernetBuffer, ipSIZE_OF_ETH_HEADER + uxIPHeaderSize );
+
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    if( uxIPHeaderSize == ipSIZE_OF_IPv4_HEADER )
+                    {
+                        IPHeader_t xIPHeader;
+
+                        /* The fields that change with every packet are left zero, so they
+                         * can be added to the header checksum with usIncrementalChecksum(). */
+                        ( void ) memcpy( &( xIPHeader ), &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ), ipSIZE_OF_IPv4_HEADER );
+                        xIPHeader.usLength = 0U;
+                        xIPHeader.usIdentification = 0U;
+                        xIPHeader.usHeaderChecksum = 0U;
+                        ( void ) memcpy( &( pxTemplate->ucHeader[ ipSIZE_OF_ETH_HEADER ] ), &( xIPHeader ), ipSIZE_OF_IPv4_HEADER );
+
+                        usSum = usGenerateChecksum( 0U, ( const uint8_t * ) &( xIPHeader.ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER );
+                        pxTemplate->usIPChecksum = ( uint16_t ) ~FreeRTOS_htons( usSum );
+
+                        usSum = usGenerateChecksum( ( uint16_t ) ipPROTOCOL_TCP, ( const uint8_t * ) &( xIPHeader.ulSourceIPAddress ), 2U * ipSIZE_OF_IPv4_ADDRESS );
+                    }
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    if( uxIPHeaderSize == ipSIZE_OF_IPv6_HEADER )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        const IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                        usSum = usGenerateChecksum( ( uint16_t ) ipPROTOCOL_TCP, pxIPHeader_IPv6->xSourceAddress.ucBytes, 2U * ipSIZE_OF_IPv6_ADDRESS );
+                    }
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                /* The ports are part of the sum as well, only the length of the
+                 * segment is missing. */
+                usSum = usGenerateChecksum( usSum, ( const uint8_t * ) &( pxProtocolHeaders->xTCPHeader.usSourcePort ), 2U * sizeof( uint16_t ) );
+
+                pxTemplate->usPseudoSum = usSum;
+                pxTemplate->usSourcePort = pxProtocolHeaders->xTCPHeader.usSourcePort;
+                pxTemplate->usDestinationPort = pxProtocolHeaders->xTCPHeader.usDestinationPort;
+                pxTemplate->pxEndPoint = pxNetworkBuffer->pxEndPoint;
+                pxTemplate->ulGeneration = ulIPHeaderCacheGeneration;
+                pxTemplate->xValid = pdTRUE;
+            }
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Send a pure ACK or window update of an established connection by
+ *        stamping the headers kept in the socket's ACK template: only the
+ *        sequence and acknowledge numbers, the window, the lengths and the
+ *        checksums are filled in.  The ARP or ND cache is not consulted.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in] pxDescriptor The network buffer descriptor carrying the packet, or NULL
+ *                         when the packet is stored in 'xTCP.xPacket'.
+ * @param[in] ulLen Length of the packet being sent, starting at the IP header.
+ * @param[in] xReleaseAfterSend pdTRUE if the ownership of the descriptor is
+ *                               transferred to the network interface.
+ *
+ * @return pdTRUE when the packet was handled, pdFALSE when the template can not
+ *         be used and the packet must be sent by prvTCPReturnPacket_IPVx().
+ */
+        BaseType_t prvTCPAckTemplateSend( FreeRTOS_Socket_t * pxSocket,
+                                          NetworkBufferDescriptor_t * pxDescriptor,
+                                          uint32_t ulLen,
+                                          BaseType_t xReleaseAfterSend )
+        {
+            const TCPAckTemplate_t * pxTemplate = &( pxSocket->u.xTCP.xAckTemplate );
+            NetworkBufferDescriptor_t * pxNetworkBuffer = pxDescriptor;
+            NetworkBufferDescriptor_t xTempBuffer;
+            BaseType_t xDoRelease = xReleaseAfterSend;
+            BaseType_t xReturn = pdFALSE;
+            const size_t uxIPHeaderSize = uxIPHeaderSizeSocket( pxSocket );
+            const size_t uxHeaderSize = ipSIZE_OF_ETH_HEADER + uxIPHeaderSize;
+            const uint8_t * pucPacket = NULL;
+            ProtocolHeaders_t * pxProtocolHeaders;
+            EthernetHeader_t * pxEthernetHeader;
+            size_t uxTCPHeaderLength = 0U;
+
+            if( ( pxTemplate->xValid != pdFALSE ) &&
+                ( pxTemplate->ulGeneration == ulIPHeaderCacheGeneration ) &&
+                ( pxSocket->u.xTCP.eTCPState == eESTABLISHED ) )
+            {
+                if( pxNetworkBuffer == NULL )
+                {
+                    pucPacket = pxSocket->u.xTCP.xPacket.u.ucLastPacket;
+                }
+                else if( uxIPHeaderSizePacket( pxNetworkBuffer ) == uxIPHeaderSize )
+                {
+                    pucPacket = pxNetworkBuffer->pucEthernetBuffer;
+                }
+                else
+                {
+                    /* A packet of another IP version, use the normal path. */
+                }
+            }
+
+            if( pucPacket != NULL )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxProtocolHeaders = ( ( ProtocolHeaders_t * ) &( pucPacket[ uxHeaderSize ] ) );
+                uxTCPHeaderLength = ( size_t ) ( ( pxProtocolHeaders->xTCPHeader.ucTCPOffset & 0xF0U ) >> 2 );
+
+                /* Only a segment without data and with no other flag than ACK. */
+                if( ( ( size_t ) ulLen == ( uxIPHeaderSize + uxTCPHeaderLength ) ) &&
+                    ( pxProtocolHeaders->xTCPHeader.ucTCPFlags == tcpTCP_FLAG_ACK ) )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+
+            if( xReturn != pdFALSE )
+            {
+                if( pxNetworkBuffer == NULL )
+                {
+                    pxNetworkBuffer = &xTempBuffer;
+
+                    ( void ) memset( &xTempBuffer, 0, sizeof( xTempBuffer ) );
+                    pxNetworkBuffer->pucEthernetBuffer = pxSocket->u.xTCP.xPacket.u.ucLastPacket;
+                    pxNetworkBuffer->xDataLength = sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket );
+                    xDoRelease = pdFALSE;
+                }
+
+                #if ( ipconfigZERO_COPY_TX_DRIVER != 0 )
+                {
+                    if( xDoRelease == pdFALSE )
+                    {
+                        /* A zero-copy network driver wants to pass the packet buffer
+                         * to DMA, so a new buffer must be created. */
+                        pxNetworkBuffer = pxDuplicateNetworkBufferWithDescriptor( pxNetworkBuffer, ( size_t ) ulLen + ipSIZE_OF_ETH_HEADER );
+
+                        if( pxNetworkBuffer != NULL )
+                        {
+                            xDoRelease = pdTRUE;
+                        }
+                        else
+                        {
+                            FreeRTOS_debug_printf( ( "prvTCPAckTemplateSend: duplicate failed\n" ) );
+                        }
+                    }
+                }
+                #endif /* ipconfigZERO_COPY_TX_DRIVER */
+            }
+
+            if( ( xReturn != pdFALSE ) && ( pxNetworkBuffer != NULL ) )
+            {
+                NetworkInterface_t * pxInterface;
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxEthernetHeader = ( ( EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxProtocolHeaders = ( ( ProtocolHeaders_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ uxHeaderSize ] ) );
+
+                ( void ) memcpy( pxNetworkBuffer->pucEthernetBuffer, pxTemplate->ucHeader, uxHeaderSize );
+                pxNetworkBuffer->pxEndPoint = pxTemplate->pxEndPoint;
+
+                prvTCPReturn_CheckTCPWindow( pxSocket, pxNetworkBuffer, uxIPHeaderSize );
+                prvTCPReturn_SetSequenceNumber( pxSocket, pxNetworkBuffer, uxIPHeaderSize, ulLen );
+
+                pxProtocolHeaders->xTCPHeader.usSourcePort = pxTemplate->usSourcePort;
+                pxProtocolHeaders->xTCPHeader.usDestinationPort = pxTemplate->usDestinationPort;
+
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    if( uxIPHeaderSize == ipSIZE_OF_IPv4_HEADER )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        IPHeader_t * pxIPHeader = ( ( IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                        pxIPHeader->usLength = FreeRTOS_htons( ulLen );
+
+                        /* Just an increasing number. */
+                        pxIPHeader->usIdentification = FreeRTOS_htons( usPacketIdentifier );
+                        usPacketIdentifier++;
+
+                        #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+                        {
+                            if( ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) != pdFALSE )
+                            {
+                                /* The template's checksum was calculated with both fields zero. */
+                                pxIPHeader->usHeaderChecksum = usIncrementalChecksum( pxTemplate->usIPChecksum, 0U, pxIPHeader->usLength );
+                                pxIPHeader->usHeaderChecksum = usIncrementalChecksum( pxIPHeader->usHeaderChecksum, 0U, pxIPHeader->usIdentification );
+                            }
+                        }
+                        #endif
+                    }
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    if( uxIPHeaderSize == ipSIZE_OF_IPv6_HEADER )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                        pxIPHeader_IPv6->usPayloadLength = FreeRTOS_htons( ulLen - ( uint32_t ) ipSIZE_OF_IPv6_HEADER );
+                    }
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+                {
+                    if( ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) != pdFALSE )
+                    {
+                        uint32_t ulSum;
+                        uint16_t usChecksum;
+
+                        /* Add the length of the segment to the pre-calculated sum of
+                         * the pseudo-header and the ports, and fold it. */
+                        ulSum = ( uint32_t ) pxTemplate->usPseudoSum + ( uint32_t ) uxTCPHeaderLength;
+                        ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+
+                        pxProtocolHeaders->xTCPHeader.usChecksum = 0U;
+                        usChecksum = usGenerateChecksum( ( uint16_t ) ulSum,
+                                                         ( const uint8_t * ) &( pxProtocolHeaders->xTCPHeader.ulSequenceNumber ),
+                                                         uxTCPHeaderLength - ( 2U * sizeof( uint16_t ) ) );
+                        pxProtocolHeaders->xTCPHeader.usChecksum = ( uint16_t ) ~FreeRTOS_htons( usChecksum );
+                    }
+                }
+                #endif /* if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) */
+
+                /* Important: tell NIC driver how many bytes must be sent. */
+                pxNetworkBuffer->xDataLength = ( size_t ) ulLen;
+                pxNetworkBuffer->xDataLength += ipSIZE_OF_ETH_HEADER;
+
+                #if ( ipconfigUSE_TCP_TSO != 0 )
+                {
+                    pxNetworkBuffer->usTCPSegmentSize = 0U;
+                }
+                #endif
+
+                pxNetworkBuffer->pxNextBuffer = NULL;
+
+                #if ( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 )
+                {
+                    if( pxNetworkBuffer->xDataLength < ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES )
+                    {
+                        BaseType_t xIndex;
+
+                        for( xIndex = ( BaseType_t ) pxNetworkBuffer->xDataLength; xIndex < ( BaseType_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES; xIndex++ )
+                        {
+                            pxNetworkBuffer->pucEthernetBuffer[ xIndex ] = 0U;
+                        }
+
+                        pxNetworkBuffer->xDataLength = ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES;
+                    }
+                }
+                #endif /* if( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 ) */
+
+                /* Send! */
+                iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+
+                configASSERT( pxNetworkBuffer->pxEndPoint->pxNetworkInterface != NULL );
+                configASSERT( pxNetworkBuffer->pxEndPoint->pxNetworkInterface->pfOutput != NULL );
+
+                pxInterface = pxNetworkBuffer->pxEndPoint->pxNetworkInterface;
+                ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, xDoRelease );
+
+                if( xDoRelease == pdFALSE )
+                {
+                    /* Swap-back the fields that prvTCPReturnPacket_IPVx() would have
+                     * swapped back, the packet is probably stored in 'xTCP.xPacket'. */
+                    vFlip_16( pxProtocolHeaders->xTCPHeader.usSourcePort, pxProtocolHeaders->xTCPHeader.usDestinationPort );
+
+                    #if ( ipconfigUSE_IPv4 != 0 )
+                        if( uxIPHeaderSize == ipSIZE_OF_IPv4_HEADER )
+                        {
+                            /* MISRA Ref 11.3.1 [Misaligned access] */
+                            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                            /* coverity[misra_c_2012_rule_11_3_violation] */
+                            IPHeader_t * pxIPHeader = ( ( IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                            pxIPHeader->ulSourceIPAddress = pxIPHeader->ulDestinationIPAddress;
+                        }
+                    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                    #if ( ipconfigUSE_IPv6 != 0 )
+                        if( uxIPHeaderSize == ipSIZE_OF_IPv6_HEADER )
+                        {
+                            /* MISRA Ref 11.3.1 [Misaligned access] */
+                            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                            /* coverity[misra_c_2012_rule_11_3_violation] */
+                            IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                            ( void ) memcpy( pxIPHeader_IPv6->xSourceAddress.ucBytes, pxIPHeader_IPv6->xDestinationAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                        }
+                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                    ( void ) memcpy( pxEthernetHeader->xSourceAddress.ucBytes, pxEthernetHeader->xDestinationAddress.ucBytes, ( size_t ) ipMAC_ADDRESS_LENGTH_BYTES );
+                }
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_ACK_TEMPLATE != 0 */
+
 /**
  * @brief Called by prvTCPReturnPacket(), this function will set the the window
  *        size on this side: 'xTCPHeader.usWindow'.
@@ -345,6 +968,26 @@
             ulSpace = 0U;
         }
 
+        #if ( ipconfigUSE_SOCKET_MEMORY_BUDGET != 0 )
+        {
+            /* Slow down the peers while the sockets hold much memory. */
+            eSocketMemoryPressure_t ePressure = FreeRTOS_GetSocketMemoryPressure();
+
+            if( ePressure == eSocketMemoryHigh )
+            {
+                ulSpace = FreeRTOS_min_uint32( ulSpace, ( uint32_t ) pxSocket->u.xTCP.usMSS );
+            }
+            else if( ePressure == eSocketMemoryModerate )
+            {
+                ulSpace = ulSpace / 2U;
+            }
+            else
+            {
+                /* No pressure. */
+            }
+        }
+        #endif
+
         /* If possible, advertise an RX window size of at least 1 MSS, otherwise
          * the peer might start 'zero window probing', i.e. sending small packets
          * (1, 2, 4, 8... bytes). */
@@ -442,6 +1085,81 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+
+/**
+ * @brief Get the link speed of the interface that a connection uses.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ *
+ * @return The speed in Mbit/s, or zero when it is not known.
+ */
+        static uint32_t prvTCPLinkSpeed( const FreeRTOS_Socket_t * pxSocket )
+        {
+            uint32_t ulSpeed = 0U;
+
+            if( pxSocket->pxEndPoint != NULL )
+            {
+                ulSpeed = ulInterfaceLinkSpeed( pxSocket->pxEndPoint->pxNetworkInterface );
+            }
+
+            return ulSpeed;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Give a new connection stream buffers that hold the bandwidth-delay
+ *        product of its link, for a round-trip of ipconfigTCP_LINK_SPEED_RTT_MS.
+ *        The windows are half of the streams, as in the default configuration.
+ *        Nothing changes when the speed is not known, when the application has
+ *        chosen the sizes, or when a stream exists already.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ */
+        static void prvTCPSizeForLinkSpeed( FreeRTOS_Socket_t * pxSocket )
+        {
+            uint32_t ulSpeed = prvTCPLinkSpeed( pxSocket );
+            size_t uxLength;
+
+            if( ( ulSpeed != 0U ) &&
+                ( pxSocket->u.xTCP.bits.bFixedSizes == pdFALSE_UNSIGNED ) &&
+                ( pxSocket->u.xTCP.rxStream == NULL ) &&
+                ( pxSocket->u.xTCP.txStream == NULL ) )
+            {
+                /* One Mbit/s during one millisecond carries 125 bytes. */
+                if( ulSpeed >= ( ( uint32_t ) ipconfigTCP_LINK_SPEED_MAX_LENGTH / ( ( uint32_t ) ipconfigTCP_LINK_SPEED_RTT_MS * 125U ) ) )
+                {
+                    uxLength = ( size_t ) ipconfigTCP_LINK_SPEED_MAX_LENGTH;
+                }
+                else
+                {
+                    uxLength = ( size_t ) ulSpeed * ( size_t ) ipconfigTCP_LINK_SPEED_RTT_MS * 125U;
+                }
+
+                uxLength = FreeRTOS_max_size_t( uxLength, 2U * ( size_t ) ipconfigTCP_MSS );
+
+                pxSocket->u.xTCP.uxRxStreamSize = uxLength;
+                pxSocket->u.xTCP.uxTxStreamSize = ( size_t ) FreeRTOS_round_up( ( uint32_t ) uxLength, ipconfigTCP_MSS );
+
+                #if ( ipconfigUSE_TCP_WIN == 1 )
+                {
+                    pxSocket->u.xTCP.uxRxWinSize = FreeRTOS_max_size_t( 1U, ( pxSocket->u.xTCP.uxRxStreamSize / 2U ) / ipconfigTCP_MSS );
+                    pxSocket->u.xTCP.uxTxWinSize = FreeRTOS_max_size_t( 1U, ( pxSocket->u.xTCP.uxTxStreamSize / 2U ) / ipconfigTCP_MSS );
+                }
+                #endif
+
+                if( xTCPWindowLoggingLevel != 0 )
+                {
+                    FreeRTOS_debug_printf( ( "prvTCPSizeForLinkSpeed: %u Mbit/s: streams of %u bytes\n",
+                                             ( unsigned ) ulSpeed,
+                                             ( unsigned ) pxSocket->u.xTCP.uxRxStreamSize ) );
+                }
+            }
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 ) */
+
 /**
  * @brief Create the TCP window for the given socket.
  *
@@ -455,8 +1173,18 @@
     BaseType_t prvTCPCreateWindow( FreeRTOS_Socket_t * pxSocket )
     {
         BaseType_t xReturn;
-        uint32_t ulRxWindowSize = ( uint32_t ) pxSocket->u.xTCP.uxRxWinSize;
-        uint32_t ulTxWindowSize = ( uint32_t ) pxSocket->u.xTCP.uxTxWinSize;
+        uint32_t ulRxWindowSize;
+        uint32_t ulTxWindowSize;
+
+        #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+        {
+            /* The end-point, and so the interface, of the connection is known now. */
+            prvTCPSizeForLinkSpeed( pxSocket );
+        }
+        #endif
+
+        ulRxWindowSize = ( uint32_t ) pxSocket->u.xTCP.uxRxWinSize;
+        ulTxWindowSize = ( uint32_t ) pxSocket->u.xTCP.uxTxWinSize;
 
         if( xTCPWindowLoggingLevel != 0 )
         {
@@ -467,6 +1195,13 @@
                                      ( unsigned ) pxSocket->u.xTCP.uxRxStreamSize ) );
         }
 
+        #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+        {
+            /* Will be initialised by vTCPWindowInit(). */
+            pxSocket->u.xTCP.xTCPWindow.xCongestion.pxControl = pxSocket->u.xTCP.pxCongestionControl;
+        }
+        #endif
+
         xReturn = xTCPWindowCreate(
             &pxSocket->u.xTCP.xTCPWindow,
             ulRxWindowSize * ipconfigTCP_MSS,
@@ -498,6 +1233,13 @@
     {
         BaseType_t xReturn = pdTRUE;
 
+        #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+        {
+            /* FreeRTOS_connect() has set the remote address and port. */
+            vSocketHashUpdate( pxSocket );
+        }
+        #endif
+
         switch( pxSocket->bits.bIsIPv6 ) /* LCOV_EXCL_BR_LINE */
         {
             #if ( ipconfigUSE_IPv4 != 0 )
@@ -540,79 +1282,314 @@
             uxWinSize = pxSocket->u.xTCP.uxRxWinSize * ( size_t ) pxSocket->u.xTCP.usMSS;
             ucFactor = 0U;
 
-            while( uxWinSize > 0xffffU )
+            #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+            {
+                /* The window of a tuned socket may grow up to half of the
+                 * largest stream, the factor can not change after the SYN. */
+                if( pxSocket->u.xTCP.bits.bNoAutoTune == pdFALSE_UNSIGNED )
+                {
+                    uxWinSize = FreeRTOS_max_size_t( uxWinSize, ( size_t ) ipconfigTCP_AUTO_TUNING_MAX_LENGTH / 2U );
+                }
+            }
+            #endif
+
+            /* A window of up to 1 GB can be advertised, larger windows will
+             * be limited by prvTCPReturn_CheckTCPWindow(). */
+            while( ( uxWinSize > 0xffffU ) && ( ucFactor < ( uint8_t ) tcpTCP_OPT_WSOPT_MAX_SHIFT ) )
             {
                 /* Divide by two and increase the binary factor by 1. */
                 uxWinSize >>= 1;
                 ucFactor++;
             }
 
-            FreeRTOS_debug_printf( ( "prvWinScaleFactor: uxRxWinSize %u MSS %u Factor %u\n",
-                                     ( unsigned ) pxSocket->u.xTCP.uxRxWinSize,
-                                     pxSocket->u.xTCP.usMSS,
-                                     ucFactor ) );
+            FreeRTOS_debug_printf( ( "prvWinScaleFactor: uxRxWinSize %u MSS %u Factor %u\n",
+                                     ( unsigned ) pxSocket->u.xTCP.uxRxWinSize,
+                                     pxSocket->u.xTCP.usMSS,
+                                     ucFactor ) );
+
+            return ucFactor;
+        }
+
+    #endif /* if ( ipconfigUSE_TCP_WIN != 0 ) */
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief When opening a TCP connection, while SYN's are being sent, the  parties may
+ *        communicate what MSS (Maximum Segment Size) they intend to use, whether Selective
+ *        ACK's ( SACK ) are supported, and the size of the reception window ( WSOPT ).
+ *
+ * @param[in] pxSocket The socket being used for communication. It is used to set
+ *                      the MSS.
+ * @param[in,out] pxTCPHeader The TCP packet header being used in the SYN transmission.
+ *                             The MSS and corresponding options shall be set in this
+ *                             header itself.
+ *
+ * @return The option length after the TCP header was updated.
+ *
+ * @note MSS is the net size of the payload, an is always smaller than MTU.
+ */
+    UBaseType_t prvSetSynAckOptions( FreeRTOS_Socket_t * pxSocket,
+                                     TCPHeader_t * pxTCPHeader )
+    {
+        uint16_t usMSS = pxSocket->u.xTCP.usMSS;
+        UBaseType_t uxOptionsLength;
+
+        /* We send out the TCP Maximum Segment Size option with our SYN[+ACK]. */
+
+        pxTCPHeader->ucOptdata[ 0 ] = ( uint8_t ) tcpTCP_OPT_MSS;
+        pxTCPHeader->ucOptdata[ 1 ] = ( uint8_t ) tcpTCP_OPT_MSS_LEN;
+        pxTCPHeader->ucOptdata[ 2 ] = ( uint8_t ) ( usMSS >> 8 );
+        pxTCPHeader->ucOptdata[ 3 ] = ( uint8_t ) ( usMSS & 0xffU );
+
+        #if ( ipconfigUSE_TCP_WIN != 0 )
+        {
+            pxSocket->u.xTCP.ucMyWinScaleFactor = prvWinScaleFactor( pxSocket );
+
+            pxTCPHeader->ucOptdata[ 4 ] = tcpTCP_OPT_NOOP;
+            pxTCPHeader->ucOptdata[ 5 ] = ( uint8_t ) ( tcpTCP_OPT_WSOPT );
+            pxTCPHeader->ucOptdata[ 6 ] = ( uint8_t ) ( tcpTCP_OPT_WSOPT_LEN );
+            pxTCPHeader->ucOptdata[ 7 ] = ( uint8_t ) pxSocket->u.xTCP.ucMyWinScaleFactor;
+            uxOptionsLength = 8U;
+        }
+        #else
+        {
+            uxOptionsLength = 4U;
+        }
+        #endif /* if ( ipconfigUSE_TCP_WIN != 0 ) */
+
+        #if ( ipconfigUSE_TCP_WIN != 0 )
+        {
+            pxTCPHeader->ucOptdata[ uxOptionsLength ] = tcpTCP_OPT_NOOP;
+            pxTCPHeader->ucOptdata[ uxOptionsLength + 1U ] = tcpTCP_OPT_NOOP;
+            pxTCPHeader->ucOptdata[ uxOptionsLength + 2U ] = tcpTCP_OPT_SACK_P; /* 4: Sack-Permitted Option. */
+            pxTCPHeader->ucOptdata[ uxOptionsLength + 3U ] = 2U;                /* 2: length of this option. */
+            uxOptionsLength += 4U;
+        }
+        #endif /* ipconfigUSE_TCP_WIN == 0 */
+
+        #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+        {
+            if( pxSocket->u.xTCP.eTCPState == eCONNECT_SYN )
+            {
+                /* An active open always offers time-stamps.  The SYN+ACK of
+                 * the peer will tell whether they will be used. */
+                pxSocket->u.xTCP.bits.bTimeStamps = pdFALSE_UNSIGNED;
+                pxSocket->u.xTCP.ulTimeStampRecent = 0U;
+                uxOptionsLength = prvSetTimeStampOption( pxSocket, pxTCPHeader, uxOptionsLength );
+            }
+            else if( pxSocket->u.xTCP.bits.bTimeStamps != pdFALSE_UNSIGNED )
+            {
+                /* The peer offered time-stamps in its SYN, accept them. */
+                uxOptionsLength = prvSetTimeStampOption( pxSocket, pxTCPHeader, uxOptionsLength );
+            }
+            else
+            {
+                /* Nothing. */
+            }
+        }
+        #endif /* ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 */
+
+        #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+        {
+            uxOptionsLength = prvSetFastOpenOption( pxSocket, pxTCPHeader, uxOptionsLength );
+        }
+        #endif
+
+        return uxOptionsLength; /* bytes, not words. */
+    }
+    /*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+
+/**
+ * @brief Write the TCP Fast Open option ( RFC 7413 ) behind the options of a
+ *        SYN or a SYN+ACK.  A client sends the cookie of the peer, or asks for
+ *        one with an empty option.  A server sends a new cookie when the client
+ *        asked for one, or when its cookie was not valid.  The option is
+ *        preceded by NOOP's to keep the length a multiple of 4.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in,out] pxTCPHeader The TCP header of the outgoing SYN or SYN+ACK.
+ * @param[in] uxOptionsLength The length of the options that were already set.
+ *
+ * @return The length of the options, including the Fast Open option.
+ */
+        static UBaseType_t prvSetFastOpenOption( FreeRTOS_Socket_t * pxSocket,
+                                                 TCPHeader_t * pxTCPHeader,
+                                                 UBaseType_t uxOptionsLength )
+        {
+            uint8_t ucCookie[ tcpFAST_OPEN_COOKIE_MAX ];
+            size_t uxCookieLength = 0U;
+            BaseType_t xSendOption = pdFALSE;
+            UBaseType_t uxLength = uxOptionsLength;
+            size_t uxIndex;
+
+            if( pxSocket->u.xTCP.bits.bFastOpen == pdFALSE_UNSIGNED )
+            {
+                /* Fast Open is not used. */
+            }
+            else if( pxSocket->u.xTCP.eTCPState == eCONNECT_SYN )
+            {
+                /* A client always sends the option, with or without a cookie. */
+                uxCookieLength = prvTCPFastOpenCookieGet( pxSocket, ucCookie );
+                xSendOption = pdTRUE;
+            }
+            else if( ( pxSocket->u.xTCP.bits.bFastOpenSeen != pdFALSE_UNSIGNED ) &&
+                     ( pxSocket->u.xTCP.bits.bFastOpenValid == pdFALSE_UNSIGNED ) )
+            {
+                /* The client asked for a cookie, or sent one that is not valid. */
+                if( prvTCPFastOpenCookieMake( pxSocket, ucCookie ) == pdPASS )
+                {
+                    uxCookieLength = tcpFAST_OPEN_COOKIE_LENGTH;
+                    xSendOption = pdTRUE;
+                }
+            }
+            else
+            {
+                /* The client sent a valid cookie, no need to send it back. */
+            }
+
+            if( xSendOption != pdFALSE )
+            {
+                /* Two bytes for the kind and length, and NOOP's up to a
+                 * multiple of 4. */
+                while( ( ( uxLength + 2U + uxCookieLength ) & 3U ) != 0U )
+                {
+                    pxTCPHeader->ucOptdata[ uxLength ] = tcpTCP_OPT_NOOP;
+                    uxLength++;
+                }
+
+                pxTCPHeader->ucOptdata[ uxLength ] = ( uint8_t ) tcpTCP_OPT_FAST_OPEN;
+                pxTCPHeader->ucOptdata[ uxLength + 1U ] = ( uint8_t ) ( 2U + uxCookieLength );
+
+                for( uxIndex = 0U; uxIndex < uxCookieLength; uxIndex++ )
+                {
+                    pxTCPHeader->ucOptdata[ uxLength + 2U + uxIndex ] = ucCookie[ uxIndex ];
+                }
+
+                uxLength += 2U + uxCookieLength;
+            }
 
-            return ucFactor;
+            return uxLength;
         }
-
-    #endif /* if ( ipconfigUSE_TCP_WIN != 0 ) */
-    /*-----------------------------------------------------------*/
+        /*-----------------------------------------------------------*/
 
 /**
- * @brief When opening a TCP connection, while SYN's are being sent, the  parties may
- *        communicate what MSS (Maximum Segment Size) they intend to use, whether Selective
- *        ACK's ( SACK ) are supported, and the size of the reception window ( WSOPT ).
- *
- * @param[in] pxSocket The socket being used for communication. It is used to set
- *                      the MSS.
- * @param[in,out] pxTCPHeader The TCP packet header being used in the SYN transmission.
- *                             The MSS and corresponding options shall be set in this
- *                             header itself.
+ * @brief Send the first SYN of a Fast Open connection along with the data
+ *        that the application passed to FreeRTOS_send() before it called
+ *        FreeRTOS_connect().  This is only done when a cookie of the peer is
+ *        known.  The data stays in the txStream: when the SYN+ACK doesn't
+ *        acknowledge it, it will be sent normally once the connection is
+ *        established.
  *
- * @return The option length after the TCP header was updated.
+ * @param[in] pxSocket The connecting socket.
+ * @param[in] ulLen The length of the SYN in 'xPacket', excluding the Ethernet
+ *                  header.
  *
- * @note MSS is the net size of the payload, an is always smaller than MTU.
+ * @return pdTRUE when the SYN has been sent with data, pdFALSE when the SYN
+ *         must be sent without data.
  */
-    UBaseType_t prvSetSynAckOptions( FreeRTOS_Socket_t * pxSocket,
-                                     TCPHeader_t * pxTCPHeader )
-    {
-        uint16_t usMSS = pxSocket->u.xTCP.usMSS;
-        UBaseType_t uxOptionsLength;
+        static BaseType_t prvTCPFastOpenSendSyn( FreeRTOS_Socket_t * pxSocket,
+                                                 uint32_t ulLen )
+        {
+            uint8_t ucCookie[ tcpFAST_OPEN_COOKIE_MAX ];
+            NetworkBufferDescriptor_t * pxNetworkBuffer;
+            size_t uxHeaderLength = ipSIZE_OF_ETH_HEADER + ( size_t ) ulLen;
+            size_t uxDataLength = 0U;
+            BaseType_t xReturn = pdFALSE;
+
+            pxSocket->u.xTCP.usFastOpenLength = 0U;
+
+            /* Only the first SYN carries data, a repeated SYN is sent without. */
+            if( ( pxSocket->u.xTCP.bits.bFastOpen != pdFALSE_UNSIGNED ) &&
+                ( pxSocket->u.xTCP.ucRepCount == 1U ) &&
+                ( pxSocket->u.xTCP.txStream != NULL ) &&
+                ( prvTCPFastOpenCookieGet( pxSocket, ucCookie ) != 0U ) )
+            {
+                uxDataLength = uxStreamBufferGetSize( pxSocket->u.xTCP.txStream );
 
-        /* We send out the TCP Maximum Segment Size option with our SYN[+ACK]. */
+                if( uxDataLength > ( size_t ) pxSocket->u.xTCP.usMSS )
+                {
+                    uxDataLength = ( size_t ) pxSocket->u.xTCP.usMSS;
+                }
+            }
 
-        pxTCPHeader->ucOptdata[ 0 ] = ( uint8_t ) tcpTCP_OPT_MSS;
-        pxTCPHeader->ucOptdata[ 1 ] = ( uint8_t ) tcpTCP_OPT_MSS_LEN;
-        pxTCPHeader->ucOptdata[ 2 ] = ( uint8_t ) ( usMSS >> 8 );
-        pxTCPHeader->ucOptdata[ 3 ] = ( uint8_t ) ( usMSS & 0xffU );
+            if( uxDataLength > 0U )
+            {
+                pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxHeaderLength + uxDataLength, 0U );
 
-        #if ( ipconfigUSE_TCP_WIN != 0 )
-        {
-            pxSocket->u.xTCP.ucMyWinScaleFactor = prvWinScaleFactor( pxSocket );
+                if( pxNetworkBuffer != NULL )
+                {
+                    uint8_t * pucSendData = &( pxNetworkBuffer->pucEthernetBuffer[ uxHeaderLength ] );
 
-            pxTCPHeader->ucOptdata[ 4 ] = tcpTCP_OPT_NOOP;
-            pxTCPHeader->ucOptdata[ 5 ] = ( uint8_t ) ( tcpTCP_OPT_WSOPT );
-            pxTCPHeader->ucOptdata[ 6 ] = ( uint8_t ) ( tcpTCP_OPT_WSOPT_LEN );
-            pxTCPHeader->ucOptdata[ 7 ] = ( uint8_t ) pxSocket->u.xTCP.ucMyWinScaleFactor;
-            uxOptionsLength = 8U;
-        }
-        #else
-        {
-            uxOptionsLength = 4U;
+                    ( void ) memcpy( pxNetworkBuffer->pucEthernetBuffer, pxSocket->u.xTCP.xPacket.u.ucLastPacket, uxHeaderLength );
+
+                    #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+                        if( pxSocket->u.xTCP.uxTxReferenceCount != 0U )
+                        {
+                            uxDataLength = uxTCPTxReferenceGet( pxSocket, 0U, pucSendData, uxDataLength );
+                        }
+                        else
+                    #endif
+                    {
+                        uxDataLength = uxStreamBufferGet( pxSocket->u.xTCP.txStream, 0U, pucSendData, uxDataLength, pdTRUE );
+                    }
+
+                    pxNetworkBuffer->xDataLength = uxHeaderLength + uxDataLength;
+                    pxNetworkBuffer->pxEndPoint = pxSocket->pxEndPoint;
+                    pxSocket->u.xTCP.usFastOpenLength = ( uint16_t ) uxDataLength;
+
+                    prvTCPReturnPacket( pxSocket, pxNetworkBuffer, ulLen + ( uint32_t ) uxDataLength, pdTRUE );
+                    xReturn = pdTRUE;
+                }
+            }
+
+            return xReturn;
         }
-        #endif /* if ( ipconfigUSE_TCP_WIN != 0 ) */
+        /*-----------------------------------------------------------*/
 
-        #if ( ipconfigUSE_TCP_WIN != 0 )
+    #endif /* ipconfigUSE_TCP_FAST_OPEN != 0 */
+
+    #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+
+/**
+ * @brief Write the TCP time-stamps option ( RFC 7323 ) behind the options that
+ *        were already set.  It is preceded by two NOOP's to keep the 32-bit
+ *        fields aligned.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in,out] pxTCPHeader The TCP header of the outgoing packet.
+ * @param[in] uxOptionsLength The length of the options that were already set.
+ *
+ * @return The length of the options, including the time-stamps.
+ */
+        UBaseType_t prvSetTimeStampOption( const FreeRTOS_Socket_t * pxSocket,
+                                           TCPHeader_t * pxTCPHeader,
+                                           UBaseType_t uxOptionsLength )
         {
-            pxTCPHeader->ucOptdata[ uxOptionsLength ] = tcpTCP_OPT_NOOP;
-            pxTCPHeader->ucOptdata[ uxOptionsLength + 1U ] = tcpTCP_OPT_NOOP;
-            pxTCPHeader->ucOptdata[ uxOptionsLength + 2U ] = tcpTCP_OPT_SACK_P; /* 4: Sack-Permitted Option. */
-            pxTCPHeader->ucOptdata[ uxOptionsLength + 3U ] = 2U;                /* 2: length of this option. */
-            uxOptionsLength += 4U;
+            uint8_t * pucOption = &( pxTCPHeader->ucOptdata[ uxOptionsLength ] );
+            uint32_t ulValue = ulTCPWindowTimeStamp();
+            uint32_t ulEcho = pxSocket->u.xTCP.ulTimeStampRecent;
+
+            pucOption[ 0 ] = tcpTCP_OPT_NOOP;
+            pucOption[ 1 ] = tcpTCP_OPT_NOOP;
+            pucOption[ 2 ] = ( uint8_t ) tcpTCP_OPT_TIMESTAMP;
+            pucOption[ 3 ] = ( uint8_t ) tcpTCP_OPT_TIMESTAMP_LEN;
+            /* TSval: the clock of this host. */
+            pucOption[ 4 ] = ( uint8_t ) ( ulValue >> 24 );
+            pucOption[ 5 ] = ( uint8_t ) ( ( ulValue >> 16 ) & 0xffU );
+            pucOption[ 6 ] = ( uint8_t ) ( ( ulValue >> 8 ) & 0xffU );
+            pucOption[ 7 ] = ( uint8_t ) ( ulValue & 0xffU );
+            /* TSecr: the most recent time-stamp received from the peer. */
+            pucOption[ 8 ] = ( uint8_t ) ( ulEcho >> 24 );
+            pucOption[ 9 ] = ( uint8_t ) ( ( ulEcho >> 16 ) & 0xffU );
+            pucOption[ 10 ] = ( uint8_t ) ( ( ulEcho >> 8 ) & 0xffU );
+            pucOption[ 11 ] = ( uint8_t ) ( ulEcho & 0xffU );
+
+            return uxOptionsLength + tcpTCP_OPT_TIMESTAMP_SPACE;
         }
-        #endif /* ipconfigUSE_TCP_WIN == 0 */
-        return uxOptionsLength; /* bytes, not words. */
-    }
+
+    #endif /* ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 */
 
 /**
  * @brief Check if the size of a network buffer is big enough to hold the outgoing message.
@@ -639,7 +1616,7 @@
         size_t uxNeeded;
         BaseType_t xResize;
 
-        if( xBufferAllocFixedSize != pdFALSE )
+        if( xIsFixedSizeNetworkBuffer( pxNetworkBuffer ) != pdFALSE )
         {
             /* Network buffers are created with a fixed size and can hold the largest
              * MTU. */
@@ -685,7 +1662,16 @@
             /* The caller didn't provide a network buffer or the provided buffer is
              * too small.  As we must send-out a data packet, a buffer will be created
              * here. */
-            pxReturn = pxGetNetworkBufferWithDescriptor( uxNeeded, 0U );
+            if( lDataLen > 0 )
+            {
+                /* A segment with data may not use the buffers that are
+                 * reserved for acknowledgements and other control packets. */
+                pxReturn = pxGetBulkNetworkBufferWithDescriptor( uxNeeded, 0U );
+            }
+            else
+            {
+                pxReturn = pxGetNetworkBufferWithDescriptor( uxNeeded, 0U );
+            }
 
             if( pxReturn != NULL )
             {
@@ -803,6 +1789,126 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigTCP_TX_COPY_CHECKSUM != 0 )
+
+/**
+ * @brief Called by prvTCPReturnPacket(), this function sets the TCP checksum
+ *        from the payload sum that was made by prvTCPPrepareSend() while the
+ *        data was copied from the TX stream.  The sum is used only once, and
+ *        only if the length of the packet matches.
+ * @param[in] pxSocket The socket on which the packet is being sent.
+ * @param[in] pxNetworkBuffer The network buffer carrying the outgoing message.
+ * @param[in] uxIPHeaderSize The size of the IP-header, which depends on the IP-type.
+ * @param[in] uxBufferLength The number of bytes in the packet buffer.
+ * @param[in] ulLen The length of the IP packet: IP-header, TCP-header and payload.
+ *
+ * @return pdTRUE when the checksum has been set, pdFALSE when the caller must
+ *         calculate the full checksum.
+ */
+        BaseType_t prvTCPReturn_SetPayloadChecksum( FreeRTOS_Socket_t * pxSocket,
+                                                    NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                    size_t uxIPHeaderSize,
+                                                    size_t uxBufferLength,
+                                                    uint32_t ulLen )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            if( pxSocket != NULL )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSize ] ) );
+                size_t uxTCPHeaderLength = ( ( size_t ) pxProtocolHeaders->xTCPHeader.ucTCPOffset & 0xF0U ) >> 2;
+                size_t uxPayloadLength = pxSocket->u.xTCP.uxTxPayloadSumLength;
+
+                pxSocket->u.xTCP.uxTxPayloadSumLength = 0U;
+
+                if( ( uxPayloadLength != 0U ) &&
+                    ( ( size_t ) ulLen == ( uxIPHeaderSize + uxTCPHeaderLength + uxPayloadLength ) ) )
+                {
+                    ( void ) usGenerateProtocolChecksumWithPayloadSum( pxNetworkBuffer->pucEthernetBuffer,
+                                                                       uxBufferLength,
+                                                                       uxPayloadLength,
+                                                                       pxSocket->u.xTCP.usTxPayloadSum );
+                    xReturn = pdTRUE;
+                }
+            }
+
+            return xReturn;
+        }
+    #endif /* ipconfigTCP_TX_COPY_CHECKSUM != 0 */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_TSO != 0 )
+
+/**
+ * @brief Called by prvTCPPrepareSend(), when the network interface supports TCP
+ *        segmentation offload, following segments of the TX window will be
+ *        added to the data that is about to be sent.
+ *        The hardware must also insert the checksums of every segment, so an
+ *        interface without TX checksum offloading gets MSS-sized packets,
+ *        segmented by the stack as usual.
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in] ulLength The number of bytes that ulTCPWindowTxGet() returned.
+ *
+ * @return The total number of bytes to be sent in a single packet.
+ */
+        uint32_t prvTCPCoalesceSegments( FreeRTOS_Socket_t * pxSocket,
+                                         uint32_t ulLength )
+        {
+            uint32_t ulTotal = ulLength;
+            const NetworkInterface_t * pxInterface = NULL;
+            BaseType_t xTxChecksumOffload = pdFALSE;
+
+            if( pxSocket->pxEndPoint != NULL )
+            {
+                pxInterface = pxSocket->pxEndPoint->pxNetworkInterface;
+            }
+
+            #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM != 0 )
+            {
+                /* All interfaces insert the checksums. */
+                xTxChecksumOffload = pdTRUE;
+            }
+            #elif ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            {
+                if( ( pxInterface != NULL ) && ( pxInterface->bits.bTxChecksumOffload != pdFALSE_UNSIGNED ) )
+                {
+                    xTxChecksumOffload = pdTRUE;
+                }
+            }
+            #endif
+
+            /* Large packets need network buffers with a variable size. */
+            if( ( pxInterface != NULL ) &&
+                ( pxInterface->bits.bTCPSegmentationOffload != pdFALSE_UNSIGNED ) &&
+                ( xTxChecksumOffload != pdFALSE ) &&
+                ( xBufferAllocFixedSize == pdFALSE ) )
+            {
+                TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+                uint32_t ulMore;
+
+                do
+                {
+                    ulMore = 0U;
+
+                    if( ulTotal < ( uint32_t ) ipconfigTCP_TSO_MAX_SIZE )
+                    {
+                        ulMore = ulTCPWindowTxGetMore( pxTCPWindow,
+                                                       pxSocket->u.xTCP.ulWindowSize,
+                                                       pxTCPWindow->ulOurSequenceNumber + ulTotal,
+                                                       ( uint32_t ) ipconfigTCP_TSO_MAX_SIZE - ulTotal );
+                        ulTotal += ulMore;
+                    }
+                } while( ulMore != 0U );
+            }
+
+            return ulTotal;
+        }
+    #endif /* ipconfigUSE_TCP_TSO != 0 */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Prepare an outgoing message, in case anything has to be sent.
  *
@@ -849,6 +1955,23 @@
         lStreamPos = 0;
         pxProtocolHeaders->xTCPHeader.ucTCPFlags |= tcpTCP_FLAG_ACK;
 
+        #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+        {
+            /* prvSetOptions() has already written the time-stamps when
+             * uxOptionsLength is non-zero. */
+            if( ( uxOptionsLength == 0U ) && ( pxSocket->u.xTCP.bits.bTimeStamps != pdFALSE_UNSIGNED ) )
+            {
+                uxOptionsLength = prvSetTimeStampOption( pxSocket, &( pxProtocolHeaders->xTCPHeader ), uxOptionsLength );
+            }
+        }
+        #endif
+
+        #if ( ipconfigTCP_TX_COPY_CHECKSUM != 0 )
+        {
+            pxSocket->u.xTCP.uxTxPayloadSumLength = 0U;
+        }
+        #endif
+
         if( pxSocket->u.xTCP.txStream != NULL )
         {
             /* ulTCPWindowTxGet will return the amount of data which may be sent
@@ -858,6 +1981,24 @@
             if( pxSocket->u.xTCP.usMSS > 1U )
             {
                 lDataLen = ( int32_t ) ulTCPWindowTxGet( pxTCPWindow, pxSocket->u.xTCP.ulWindowSize, &lStreamPos );
+
+                #if ( ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 ) && ( ipconfigUSE_TCP_WIN == 1 ) )
+                {
+                    if( lDataLen > 0 )
+                    {
+                        prvTCPPathMTUCheckTimeouts( pxSocket, ( uint32_t ) lDataLen );
+                    }
+                }
+                #endif
+
+                #if ( ipconfigUSE_TCP_TSO != 0 )
+                {
+                    if( lDataLen > 0 )
+                    {
+                        lDataLen = ( int32_t ) prvTCPCoalesceSegments( pxSocket, ( uint32_t ) lDataLen );
+                    }
+                }
+                #endif
             }
 
             if( lDataLen > 0 )
@@ -887,7 +2028,28 @@
 
                     /* Here data is copied from the txStream in 'peek' mode.  Only
                      * when the packets are acked, the tail marker will be updated. */
-                    ulDataGot = ( uint32_t ) uxStreamBufferGet( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lDataLen, pdTRUE );
+                    #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+                        if( pxSocket->u.xTCP.uxTxReferenceCount != 0U )
+                        {
+                            /* Some of the data is not stored in txStream, but in
+                             * buffers of the application. */
+                            ulDataGot = ( uint32_t ) uxTCPTxReferenceGet( pxSocket, uxOffset, pucSendData, ( size_t ) lDataLen );
+                        }
+                        else
+                    #endif
+                    #if ( ( ipconfigTCP_TX_COPY_CHECKSUM != 0 ) && ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) )
+                    {
+                        /* Sum the payload while copying it, so that
+                         * prvTCPReturnPacket() doesn't have to read it again. */
+                        ulDataGot = ( uint32_t ) uxStreamBufferGetWithChecksum( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lDataLen, pdTRUE,
+                                                                                &( pxSocket->u.xTCP.usTxPayloadSum ) );
+                        pxSocket->u.xTCP.uxTxPayloadSumLength = ( size_t ) ulDataGot;
+                    }
+                    #else
+                    {
+                        ulDataGot = ( uint32_t ) uxStreamBufferGet( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lDataLen, pdTRUE );
+                    }
+                    #endif
 
                     #if ( ipconfigHAS_DEBUG_PRINTF != 0 )
                     {
@@ -1042,6 +2204,17 @@
          * The oldest data not-yet-confirmed can be found at rxTail. */
         lLength = ( int32_t ) uxStreamBufferMidSpace( pxSocket->u.xTCP.txStream );
 
+        if( ( ( pxSocket->u.xTCP.bits.bCork != pdFALSE_UNSIGNED ) || ( pxSocket->u.xTCP.bits.bMore != pdFALSE_UNSIGNED ) ) &&
+            ( pxSocket->u.xTCP.bits.bCloseRequested == pdFALSE_UNSIGNED ) &&
+            ( pxSocket->u.xTCP.bits.bUserShutdown == pdFALSE_UNSIGNED ) &&
+            ( pxSocket->u.xTCP.xTCPWindow.usMSS != 0U ) )
+        {
+            /* More data will follow: leave the bytes that do not fill a
+             * segment in the stream, they will be sent together with that data,
+             * or when the socket is uncorked. */
+            lLength -= lLength % ( int32_t ) pxSocket->u.xTCP.xTCPWindow.usMSS;
+        }
+
         if( lLength > 0 )
         {
             /* All data between txMid and rxHead will now be passed to the sliding
@@ -1144,6 +2317,18 @@
             /* Nothing. */
         }
 
+        #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+        {
+            if( pxSocket->u.xTCP.bits.bTimeStamps != pdFALSE_UNSIGNED )
+            {
+                /* Once negotiated, time-stamps are sent along with every
+                 * segment. */
+                uxOptionsLength = prvSetTimeStampOption( pxSocket, pxTCPHeader, uxOptionsLength );
+                pxTCPHeader->ucTCPOffset = ( uint8_t ) ( ( ipSIZE_OF_TCP_HEADER + uxOptionsLength ) << 2 );
+            }
+        }
+        #endif /* ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 */
+
         return uxOptionsLength;
     }
     /*-----------------------------------------------------------*/
@@ -1186,6 +2371,7 @@
             BaseType_t xSizeWithoutData = ( BaseType_t ) uxSize;
 
             int32_t lMinLength;
+            BaseType_t xMayDelay = pdFALSE;
         #endif
 
         /* Set the time-out field, so that we'll be called by the IP-task in case no
@@ -1207,6 +2393,19 @@
                 ( xSendLength == xSizeWithoutData ) &&                    /* No Tx data or options to be sent. */
                 ( pxSocket->u.xTCP.eTCPState == eESTABLISHED ) &&         /* Connection established. */
                 ( pxTCPHeader->ucTCPFlags == tcpTCP_FLAG_ACK ) )          /* There are no other flags than an ACK. */
+            {
+                xMayDelay = pdTRUE;
+            }
+
+            #if ( ipconfigUSE_TCP_ACK_POLICY != 0 )
+            {
+                /* The policy chosen with FREERTOS_SO_TCP_ACK_POLICY may want
+                 * the ACK to be sent now. */
+                xMayDelay = prvTCPAckPolicyMayDelay( pxSocket, ulReceiveLength, xMayDelay );
+            }
+            #endif
+
+            if( xMayDelay != pdFALSE )
             {
                 uint32_t ulCurMSS = ( uint32_t ) pxSocket->u.xTCP.usMSS;
 
@@ -1238,6 +2437,23 @@
                     }
                 }
 
+                #if ( ipconfigUSE_TCP_ACK_POLICY != 0 )
+                {
+                    TickType_t xMaxDelay = pdMS_TO_TICKS( ( uint32_t ) pxSocket->u.xTCP.xAckPolicy.usMaxDelayMS );
+
+                    /* The policy may shorten or lengthen the delay. */
+                    if( pxSocket->u.xTCP.xAckPolicy.usMaxDelayMS != 0U )
+                    {
+                        if( xMaxDelay < 1U )
+                        {
+                            xMaxDelay = 1U;
+                        }
+
+                        pxSocket->u.xTCP.usTimeout = ( uint16_t ) FreeRTOS_min_uint32( ( uint32_t ) xMaxDelay, 0xFFFFU );
+                    }
+                }
+                #endif
+
                 if( ( xTCPWindowLoggingLevel > 1 ) && ( ipconfigTCP_MAY_LOG_PORT( pxSocket->usLocalPort ) ) )
                 {
                     FreeRTOS_debug_printf( ( "Send[%u->%u] del ACK %u SEQ %u (len %u) tmout %u d %d\n",
@@ -1305,6 +2521,99 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_ACK_POLICY != 0 )
+
+/**
+ * @brief Apply the ACK policy of a socket, see FREERTOS_SO_TCP_ACK_POLICY.
+ *        FREERTOS_TCP_ACK_QUICK never delays an ACK.  FREERTOS_TCP_ACK_EVERY_N
+ *        sends an ACK for every 'ucSegments' segments.  FREERTOS_TCP_ACK_ADAPTIVE
+ *        sends an ACK immediately for a small segment, or for a segment that
+ *        follows a pause of tcpADAPTIVE_ACK_IDLE_MS, because the peer is
+ *        probably waiting for an answer.  During a bulk transfer, it sends an
+ *        ACK for every second segment.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in] ulReceiveLength The number of bytes of data received.
+ * @param[in] xMayDelay pdTRUE when prvSendData() would delay the ACK.
+ *
+ * @return pdTRUE when the ACK may be delayed, pdFALSE when it must be sent now.
+ */
+        BaseType_t prvTCPAckPolicyMayDelay( FreeRTOS_Socket_t * pxSocket,
+                                            uint32_t ulReceiveLength,
+                                            BaseType_t xMayDelay )
+        {
+            IPTCPSocket_t * pxTCP = &( pxSocket->u.xTCP );
+            BaseType_t xReturn = xMayDelay;
+            TickType_t xNow = xTaskGetTickCount();
+            TickType_t xIdleTime = xNow - pxTCP->xAckRxTime;
+
+            switch( pxTCP->xAckPolicy.ucMode )
+            {
+                case FREERTOS_TCP_ACK_QUICK:
+                    xReturn = pdFALSE;
+                    break;
+
+                case FREERTOS_TCP_ACK_EVERY_N:
+
+                    if( xMayDelay != pdFALSE )
+                    {
+                        pxTCP->ucAckSegments++;
+
+                        if( pxTCP->ucAckSegments >= pxTCP->xAckPolicy.ucSegments )
+                        {
+                            xReturn = pdFALSE;
+                        }
+                    }
+
+                    break;
+
+                case FREERTOS_TCP_ACK_ADAPTIVE:
+
+                    if( xMayDelay != pdFALSE )
+                    {
+                        if( ( ulReceiveLength < ( uint32_t ) pxTCP->usMSS ) ||
+                            ( xIdleTime >= pdMS_TO_TICKS( tcpADAPTIVE_ACK_IDLE_MS ) ) )
+                        {
+                            /* Interactive traffic. */
+                            xReturn = pdFALSE;
+                        }
+                        else
+                        {
+                            /* Bulk traffic, RFC 1122 asks for an ACK for at
+                             * least every second full-size segment. */
+                            pxTCP->ucAckSegments++;
+
+                            if( pxTCP->ucAckSegments >= 2U )
+                            {
+                                xReturn = pdFALSE;
+                            }
+                        }
+                    }
+
+                    break;
+
+                default:
+                    /* FREERTOS_TCP_ACK_DEFAULT: keep the decision of prvSendData(). */
+                    break;
+            }
+
+            if( ulReceiveLength > 0U )
+            {
+                pxTCP->xAckRxTime = xNow;
+            }
+
+            if( xReturn == pdFALSE )
+            {
+                /* An ACK will be sent now. */
+                pxTCP->ucAckSegments = 0U;
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_ACK_POLICY != 0 */
+
 /**
  * @brief Common code for sending a TCP protocol control packet (i.e. no options, no
  *        payload, just flags).
@@ -1380,4 +2689,68 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_SYN_COOKIES != 0 )
+
+/**
+ * @brief Answer a SYN to a listening socket whose backlog is full with a
+ *        SYN+ACK that carries a SYN cookie. The received packet is used to
+ *        send the reply, no socket is created.
+ *
+ * @param[in] pxNetworkBuffer The network buffer with the SYN.
+ *
+ * @return pdFAIL always indicating that the packet was not consumed.
+ */
+        BaseType_t prvTCPSendSynCookie( NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            ProtocolHeaders_t * pxProtocolHeaders = ( ( ProtocolHeaders_t * )
+                                                      &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer ) ] ) );
+            TCPHeader_t * pxTCPHeader = &( pxProtocolHeaders->xTCPHeader );
+            size_t uxIPHeaderSize = uxIPHeaderSizePacket( pxNetworkBuffer );
+            uint32_t ulSendLength = ( uint32_t ) ( uxIPHeaderSize + ipSIZE_OF_TCP_HEADER );
+            uint32_t ulCookie = 0U;
+            uint16_t usMSS = ( uint16_t ) ipconfigTCP_MSS;
+
+            if( prvTCPSynCookieMake( pxNetworkBuffer, &( ulCookie ) ) == pdPASS )
+            {
+                if( uxIPHeaderSize == ipSIZE_OF_IPv6_HEADER )
+                {
+                    /* The IPv6 header is 20 bytes longer than the IPv4 header. */
+                    usMSS -= ( uint16_t ) ( ipSIZE_OF_IPv6_HEADER - ipSIZE_OF_IPv4_HEADER );
+                }
+
+                /* prvTCPReturnPacket() will swap the two numbers: the SYN is
+                 * acknowledged, and the cookie becomes the sequence number. */
+                pxTCPHeader->ulSequenceNumber = FreeRTOS_htonl( FreeRTOS_ntohl( pxTCPHeader->ulSequenceNumber ) + 1U );
+                pxTCPHeader->ulAckNr = FreeRTOS_htonl( ulCookie );
+                pxTCPHeader->ucTCPFlags = ( uint8_t ) tcpTCP_FLAG_SYN | ( uint8_t ) tcpTCP_FLAG_ACK;
+                pxTCPHeader->usWindow = FreeRTOS_htons( usMSS );
+                pxTCPHeader->usUrgent = 0U;
+
+                /* Only the MSS option is sent, the other options would need a
+                 * socket to remember them.  The SYN had room for at least as
+                 * many bytes of options when it had more than a bare header. */
+                if( ( size_t ) ( ( pxTCPHeader->ucTCPOffset >> 4 ) * 4U ) >= ( ipSIZE_OF_TCP_HEADER + tcpTCP_OPT_MSS_LEN ) )
+                {
+                    pxTCPHeader->ucOptdata[ 0 ] = tcpTCP_OPT_MSS;
+                    pxTCPHeader->ucOptdata[ 1 ] = tcpTCP_OPT_MSS_LEN;
+                    pxTCPHeader->ucOptdata[ 2 ] = ( uint8_t ) ( usMSS >> 8 );
+                    pxTCPHeader->ucOptdata[ 3 ] = ( uint8_t ) ( usMSS & 0xffU );
+                    ulSendLength += tcpTCP_OPT_MSS_LEN;
+                }
+
+                pxTCPHeader->ucTCPOffset = ( uint8_t ) ( ( ulSendLength - uxIPHeaderSize ) << 2 );
+
+                prvTCPReturnPacket( NULL, pxNetworkBuffer, ulSendLength, pdFALSE );
+            }
+
+            /* The packet was not consumed. */
+            return pdFAIL;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_SYN_COOKIES != 0 */
+
 #endif /* ipconfigUSE_TCP == 1 */
@@ -111,11 +111,7 @@ void prvTCPReturnPacket_IPV4( FreeRTOS_Socket_t * pxSocket,
             pxNetworkBuffer = &xTempBuffer;
 
             ( void ) memset( &xTempBuffer, 0, sizeof( xTempBuffer ) );
-            #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-            {
-                pxNetworkBuffer->pxNextBuffer = NULL;
-            }
-            #endif
+            pxNetworkBuffer->pxNextBuffer = NULL;
             pxNetworkBuffer->pucEthernetBuffer = pxSocket->u.xTCP.xPacket.u.ucLastPacket;
             pxNetworkBuffer->xDataLength = sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket );
             xDoRelease = pdFALSE;
@@ -181,6 +177,10 @@ void prvTCPReturnPacket_IPV4( FreeRTOS_Socket_t * pxSocket,
                 prvTCPReturn_SetSequenceNumber( pxSocket, pxNetworkBuffer, uxIPHeaderSize, ulLen );
                 pxIPHeader->ulDestinationIPAddress = FreeRTOS_htonl( pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4 );
                 pxIPHeader->ulSourceIPAddress = pxNetworkBuffer->pxEndPoint->ipv4_settings.ulIPAddress;
+
+                #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+                    pxIPHeader->ucDifferentiatedServicesCode = ( uint8_t ) ( pxSocket->ucDSCP << ipDSCP_SHIFT );
+                #endif
             }
             else
             {
@@ -202,19 +202,39 @@ void prvTCPReturnPacket_IPV4( FreeRTOS_Socket_t * pxSocket,
              */
             #if ( ipconfigFORCE_IP_DONT_FRAGMENT != 0 )
                 pxIPHeader->usFragmentOffset = ipFRAGMENT_FLAGS_DONT_FRAGMENT;
+            #elif ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
+                /* Path MTU discovery needs the DF flag. A segment that was
+                 * queued before the MSS was lowered may still be fragmented. */
+                if( ( pxSocket == NULL ) ||
+                    ( ( ulLen - ( uint32_t ) uxIPHeaderSize - ( uint32_t ) ( ( pxProtocolHeaders->xTCPHeader.ucTCPOffset & tcpVALID_BITS_IN_TCP_OFFSET_BYTE ) >> 2 ) ) <= ( uint32_t ) pxSocket->u.xTCP.usMSS ) )
+                {
+                    pxIPHeader->usFragmentOffset = ipFRAGMENT_FLAGS_DONT_FRAGMENT;
+                }
+                else
+                {
+                    pxIPHeader->usFragmentOffset = 0U;
+                }
             #else
                 pxIPHeader->usFragmentOffset = 0U;
             #endif
 
             #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
             {
-                /* calculate the IP header checksum, in case the driver won't do that. */
-                pxIPHeader->usHeaderChecksum = 0x00U;
-                pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderSize );
-                pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
-
-                /* calculate the TCP checksum for an outgoing packet. */
-                ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxTCPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                if( ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) != pdFALSE )
+                {
+                    /* calculate the IP header checksum, in case the driver won't do that. */
+                    pxIPHeader->usHeaderChecksum = 0x00U;
+                    pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderSize );
+                    pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+
+                    /* calculate the TCP checksum for an outgoing packet. */
+                    #if ( ipconfigTCP_TX_COPY_CHECKSUM != 0 )
+                        if( prvTCPReturn_SetPayloadChecksum( pxSocket, pxNetworkBuffer, uxIPHeaderSize, pxNetworkBuffer->xDataLength, ulLen ) == pdFALSE )
+                    #endif
+                    {
+                        ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxTCPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                    }
+                }
             }
             #endif /* if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) */
 
@@ -224,12 +244,23 @@ void prvTCPReturnPacket_IPV4( FreeRTOS_Socket_t * pxSocket,
             pxNetworkBuffer->xDataLength = ( size_t ) ulLen;
             pxNetworkBuffer->xDataLength += ipSIZE_OF_ETH_HEADER;
 
-            #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+            #if ( ipconfigUSE_TCP_TSO != 0 )
             {
-                pxNetworkBuffer->pxNextBuffer = NULL;
+                /* A packet larger than the MTU was built by prvTCPCoalesceSegments(),
+                 * the driver will split it in segments of MSS bytes. */
+                if( ( pxSocket != NULL ) && ( ulLen > ( uint32_t ) uxInterfaceMTU( pxNetworkBuffer->pxEndPoint->pxNetworkInterface ) ) )
+                {
+                    pxNetworkBuffer->usTCPSegmentSize = pxSocket->u.xTCP.usMSS;
+                }
+                else
+                {
+                    pxNetworkBuffer->usTCPSegmentSize = 0U;
+                }
             }
             #endif
 
+            pxNetworkBuffer->pxNextBuffer = NULL;
+
             pvCopySource = &pxEthernetHeader->xSourceAddress;
             ulDestinationIPAddress = pxIPHeader->ulDestinationIPAddress;
 
@@ -263,6 +294,16 @@ void prvTCPReturnPacket_IPV4( FreeRTOS_Socket_t * pxSocket,
             pvCopyDest = &pxEthernetHeader->xSourceAddress;
             ( void ) memcpy( pvCopyDest, pvCopySource, ( size_t ) ipMAC_ADDRESS_LENGTH_BYTES );
 
+            #if ( ipconfigUSE_TCP_ACK_TEMPLATE != 0 )
+            {
+                /* The headers are complete now, keep them for the next pure ACKs. */
+                if( ( pxSocket != NULL ) && ( eResult == eARPCacheHit ) )
+                {
+                    prvTCPAckTemplateStore( pxSocket, pxNetworkBuffer, uxIPHeaderSize );
+                }
+            }
+            #endif
+
             #if ( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 )
             {
                 if( pxNetworkBuffer->xDataLength < ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES )
@@ -286,7 +327,7 @@ void prvTCPReturnPacket_IPV4( FreeRTOS_Socket_t * pxSocket,
             configASSERT( pxNetworkBuffer->pxEndPoint->pxNetworkInterface->pfOutput != NULL );
 
             pxInterface = pxNetworkBuffer->pxEndPoint->pxNetworkInterface;
-            ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, xDoRelease );
+            ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, xDoRelease );
 
             if( xDoRelease == pdFALSE )
             {
@@ -117,11 +117,7 @@ void prvTCPReturnPacket_IPV6( FreeRTOS_Socket_t * pxSocket,
             pxNetworkBuffer = &xTempBuffer;
 
             ( void ) memset( &xTempBuffer, 0, sizeof( xTempBuffer ) );
-            #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-            {
-                pxNetworkBuffer->pxNextBuffer = NULL;
-            }
-            #endif
+            pxNetworkBuffer->pxNextBuffer = NULL;
             pxNetworkBuffer->pucEthernetBuffer = pxSocket->u.xTCP.xPacket.u.ucLastPacket;
             pxNetworkBuffer->xDataLength = sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket );
             xDoRelease = pdFALSE;
@@ -196,6 +192,16 @@ void prvTCPReturnPacket_IPV6( FreeRTOS_Socket_t * pxSocket,
                 prvTCPReturn_SetSequenceNumber( pxSocket, pxNetworkBuffer, uxIPHeaderSize, ulLen );
                 ( void ) memcpy( pxIPHeader->xDestinationAddress.ucBytes, pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
                 ( void ) memcpy( pxIPHeader->xSourceAddress.ucBytes, pxNetworkBuffer->pxEndPoint->ipv6_settings.xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+                #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+                {
+                    /* The traffic class straddles the first two bytes. */
+                    uint8_t ucTrafficClass = ( uint8_t ) ( pxSocket->ucDSCP << ipDSCP_SHIFT );
+
+                    pxIPHeader->ucVersionTrafficClass = ( uint8_t ) ( 0x60U | ( ( uint32_t ) ucTrafficClass >> 4 ) );
+                    pxIPHeader->ucTrafficClassFlow = ( uint8_t ) ( ( pxIPHeader->ucTrafficClassFlow & 0x0FU ) | ( ( uint32_t ) ucTrafficClass << 4 ) );
+                }
+                #endif
             }
             else
             {
@@ -214,9 +220,18 @@ void prvTCPReturnPacket_IPV6( FreeRTOS_Socket_t * pxSocket,
 
             #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
             {
-                /* calculate the TCP checksum for an outgoing packet. */
-                uint32_t ulTotalLength = ulLen + ipSIZE_OF_ETH_HEADER;
-                ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxNetworkBuffer->pucEthernetBuffer, ulTotalLength, pdTRUE );
+                if( ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) != pdFALSE )
+                {
+                    /* calculate the TCP checksum for an outgoing packet. */
+                    uint32_t ulTotalLength = ulLen + ipSIZE_OF_ETH_HEADER;
+
+                    #if ( ipconfigTCP_TX_COPY_CHECKSUM != 0 )
+                        if( prvTCPReturn_SetPayloadChecksum( pxSocket, pxNetworkBuffer, uxIPHeaderSize, ulTotalLength, ulLen ) == pdFALSE )
+                    #endif
+                    {
+                        ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxNetworkBuffer->pucEthernetBuffer, ulTotalLength, pdTRUE );
+                    }
+                }
             }
             #endif /* ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 */
 
@@ -226,12 +241,23 @@ void prvTCPReturnPacket_IPV6( FreeRTOS_Socket_t * pxSocket,
             pxNetworkBuffer->xDataLength = ( size_t ) ulLen;
             pxNetworkBuffer->xDataLength += ipSIZE_OF_ETH_HEADER;
 
-            #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+            #if ( ipconfigUSE_TCP_TSO != 0 )
             {
-                pxNetworkBuffer->pxNextBuffer = NULL;
+                /* A packet larger than the MTU was built by prvTCPCoalesceSegments(),
+                 * the driver will split it in segments of MSS bytes. */
+                if( ( pxSocket != NULL ) && ( ulLen > ( uint32_t ) uxInterfaceMTU( pxNetworkBuffer->pxEndPoint->pxNetworkInterface ) ) )
+                {
+                    pxNetworkBuffer->usTCPSegmentSize = pxSocket->u.xTCP.usMSS;
+                }
+                else
+                {
+                    pxNetworkBuffer->usTCPSegmentSize = 0U;
+                }
             }
             #endif
 
+            pxNetworkBuffer->pxNextBuffer = NULL;
+
             ( void ) memcpy( xDestinationIPAddress.ucBytes, pxIPHeader->xDestinationAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
 
             eResult = eNDGetCacheEntry( &xDestinationIPAddress, &xMACAddress, &( pxNetworkBuffer->pxEndPoint ) );
@@ -258,6 +284,16 @@ void prvTCPReturnPacket_IPV6( FreeRTOS_Socket_t * pxSocket,
             pvCopyDest = &pxEthernetHeader->xSourceAddress;
             ( void ) memcpy( pvCopyDest, pvCopySource, ( size_t ) ipMAC_ADDRESS_LENGTH_BYTES );
 
+            #if ( ipconfigUSE_TCP_ACK_TEMPLATE != 0 )
+            {
+                /* The headers are complete now, keep them for the next pure ACKs. */
+                if( ( pxSocket != NULL ) && ( eResult == eARPCacheHit ) )
+                {
+                    prvTCPAckTemplateStore( pxSocket, pxNetworkBuffer, uxIPHeaderSize );
+                }
+            }
+            #endif
+
             #if ( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 )
             {
                 if( pxNetworkBuffer->xDataLength < ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES )
@@ -281,7 +317,7 @@ void prvTCPReturnPacket_IPV6( FreeRTOS_Socket_t * pxSocket,
             configASSERT( pxNetworkBuffer->pxEndPoint->pxNetworkInterface->pfOutput != NULL );
 
             pxInterface = pxNetworkBuffer->pxEndPoint->pxNetworkInterface;
-            ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, xDoRelease );
+            ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, xDoRelease );
 
             if( xDoRelease == pdFALSE )
             {
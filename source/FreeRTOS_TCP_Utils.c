@@ -36,6 +36,7 @@
 /* Standard includes. */
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
@@ -110,7 +111,833 @@
                 /* MISRA 16.4 Compliance */
                 break; /* LCOV_EXCL_LINE */
         }
+
+        #if ( ipconfigUSE_INTERFACE_MTU != 0 )
+            if( ( pxSocket->pxEndPoint != NULL ) && ( pxSocket->pxEndPoint->pxNetworkInterface != NULL ) )
+            {
+                /* The outgoing interface may have a smaller MTU than the network buffers. */
+                size_t uxHeaders = ( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED ) ? ( ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_TCP_HEADER ) : ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER );
+                size_t uxMTU = uxInterfaceMTU( pxSocket->pxEndPoint->pxNetworkInterface );
+
+                if( ( uxMTU > uxHeaders ) && ( ( uxMTU - uxHeaders ) < ( size_t ) pxSocket->u.xTCP.usMSS ) )
+                {
+                    pxSocket->u.xTCP.usMSS = ( uint16_t ) ( uxMTU - uxHeaders );
+                }
+            }
+        #endif
+
+        #if ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
+        {
+            /* The path to this peer may be narrower than its network. */
+            uint16_t usPathMSS = prvTCPPathMSSGet( pxSocket );
+
+            if( ( usPathMSS != 0U ) && ( usPathMSS < pxSocket->u.xTCP.usMSS ) )
+            {
+                pxSocket->u.xTCP.usMSS = usPathMSS;
+            }
+        }
+        #endif
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 ) || ( ipconfigUSE_TCP_SYN_COOKIES != 0 )
+
+/** @brief The key of the cookies handed out by this host. */
+        static uint64_t ullCookieKey[ 2 ];
+
+/** @brief pdTRUE once ullCookieKey has been set. */
+        static BaseType_t xCookieKeySet = pdFALSE;
+
+        #define tcpSIP_ROTATE( ullValue, uxBits )    ( ( ( ullValue ) << ( uxBits ) ) | ( ( ullValue ) >> ( 64U - ( uxBits ) ) ) )
+
+/**
+ * @brief One SipRound of SipHash.
+ *
+ * @param[in,out] pullState The four state words.
+ */
+        static void prvSipRound( uint64_t * pullState )
+        {
+            pullState[ 0 ] += pullState[ 1 ];
+            pullState[ 1 ] = tcpSIP_ROTATE( pullState[ 1 ], 13U );
+            pullState[ 1 ] ^= pullState[ 0 ];
+            pullState[ 0 ] = tcpSIP_ROTATE( pullState[ 0 ], 32U );
+            pullState[ 2 ] += pullState[ 3 ];
+            pullState[ 3 ] = tcpSIP_ROTATE( pullState[ 3 ], 16U );
+            pullState[ 3 ] ^= pullState[ 2 ];
+            pullState[ 0 ] += pullState[ 3 ];
+            pullState[ 3 ] = tcpSIP_ROTATE( pullState[ 3 ], 21U );
+            pullState[ 3 ] ^= pullState[ 0 ];
+            pullState[ 2 ] += pullState[ 1 ];
+            pullState[ 1 ] = tcpSIP_ROTATE( pullState[ 1 ], 17U );
+            pullState[ 1 ] ^= pullState[ 2 ];
+            pullState[ 2 ] = tcpSIP_ROTATE( pullState[ 2 ], 32U );
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief SipHash-2-4 of a string of bytes. The key is taken from
+ *        xApplicationGetRandomNumber() when it is first needed.
+ *
+ * @param[in] pucData The bytes to be hashed.
+ * @param[in] uxLength The number of bytes.
+ * @param[out] pullHash Where the hash will be written.
+ *
+ * @return pdPASS when the hash was made, pdFAIL when no random key could be
+ *         obtained.
+ */
+        static BaseType_t prvTCPCookieHash( const uint8_t * pucData,
+                                            size_t uxLength,
+                                            uint64_t * pullHash )
+        {
+            uint64_t ullState[ 4 ];
+            uint64_t ullWord;
+            uint32_t ulRandom[ 4 ];
+            size_t uxIndex;
+            size_t uxByte;
+            BaseType_t xReturn = pdPASS;
+
+            if( xCookieKeySet == pdFALSE )
+            {
+                for( uxIndex = 0U; uxIndex < 4U; uxIndex++ )
+                {
+                    if( xApplicationGetRandomNumber( &( ulRandom[ uxIndex ] ) ) == pdFALSE )
+                    {
+                        xReturn = pdFAIL;
+                        break;
+                    }
+                }
+
+                if( xReturn == pdPASS )
+                {
+                    ullCookieKey[ 0 ] = ( ( ( uint64_t ) ulRandom[ 0 ] ) << 32 ) | ( uint64_t ) ulRandom[ 1 ];
+                    ullCookieKey[ 1 ] = ( ( ( uint64_t ) ulRandom[ 2 ] ) << 32 ) | ( uint64_t ) ulRandom[ 3 ];
+                    xCookieKeySet = pdTRUE;
+                }
+            }
+
+            if( xReturn == pdPASS )
+            {
+                ullState[ 0 ] = ullCookieKey[ 0 ] ^ 0x736f6d6570736575ULL;
+                ullState[ 1 ] = ullCookieKey[ 1 ] ^ 0x646f72616e646f6dULL;
+                ullState[ 2 ] = ullCookieKey[ 0 ] ^ 0x6c7967656e657261ULL;
+                ullState[ 3 ] = ullCookieKey[ 1 ] ^ 0x7465646279746573ULL;
+
+                /* Compress the whole 8-byte words, the last word holds the
+                 * length and the remaining bytes. */
+                for( uxIndex = 0U; ( uxIndex + 8U ) <= uxLength; uxIndex += 8U )
+                {
+                    ullWord = 0U;
+
+                    for( uxByte = 0U; uxByte < 8U; uxByte++ )
+                    {
+                        ullWord |= ( ( uint64_t ) pucData[ uxIndex + uxByte ] ) << ( 8U * uxByte );
+                    }
+
+                    ullState[ 3 ] ^= ullWord;
+                    prvSipRound( ullState );
+                    prvSipRound( ullState );
+                    ullState[ 0 ] ^= ullWord;
+                }
+
+                ullWord = ( ( uint64_t ) ( uxLength & 0xffU ) ) << 56;
+
+                for( uxByte = 0U; ( uxIndex + uxByte ) < uxLength; uxByte++ )
+                {
+                    ullWord |= ( ( uint64_t ) pucData[ uxIndex + uxByte ] ) << ( 8U * uxByte );
+                }
+
+                ullState[ 3 ] ^= ullWord;
+                prvSipRound( ullState );
+                prvSipRound( ullState );
+                ullState[ 0 ] ^= ullWord;
+
+                ullState[ 2 ] ^= 0xffU;
+
+                for( uxIndex = 0U; uxIndex < 4U; uxIndex++ )
+                {
+                    prvSipRound( ullState );
+                }
+
+                *pullHash = ullState[ 0 ] ^ ullState[ 1 ] ^ ullState[ 2 ] ^ ullState[ 3 ];
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_TCP_FAST_OPEN != 0 ) || ( ipconfigUSE_TCP_SYN_COOKIES != 0 ) */
+
+    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 ) || ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
+
+/**
+ * @brief Write the IP address of the peer of a socket in network byte order.
+ *
+ * @param[in] pxSocket The socket.
+ * @param[out] pucAddress Where the address will be written, 16 bytes.
+ *
+ * @return The length of the address: 4 or 16 bytes.
+ */
+        static uint8_t prvTCPPeerAddress( const FreeRTOS_Socket_t * pxSocket,
+                                          uint8_t * pucAddress )
+        {
+            uint8_t ucLength;
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED )
+                {
+                    ( void ) memcpy( pucAddress, pxSocket->u.xTCP.xRemoteIP.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                    ucLength = ( uint8_t ) ipSIZE_OF_IPv6_ADDRESS;
+                }
+                else
+            #endif
+            {
+                uint32_t ulAddress = pxSocket->u.xTCP.xRemoteIP.ulIP_IPv4;
+
+                /* The socket keeps the IPv4 address in host byte order. */
+                pucAddress[ 0 ] = ( uint8_t ) ( ulAddress >> 24 );
+                pucAddress[ 1 ] = ( uint8_t ) ( ( ulAddress >> 16 ) & 0xffU );
+                pucAddress[ 2 ] = ( uint8_t ) ( ( ulAddress >> 8 ) & 0xffU );
+                pucAddress[ 3 ] = ( uint8_t ) ( ulAddress & 0xffU );
+                ucLength = ( uint8_t ) ipSIZE_OF_IPv4_ADDRESS;
+            }
+
+            return ucLength;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_TCP_FAST_OPEN != 0 ) || ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 ) */
+
+    #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+
+/** @brief A Fast Open cookie that was received from a server. */
+        typedef struct xTCP_FAST_OPEN_COOKIE
+        {
+            uint8_t ucAddress[ ipSIZE_OF_IPv6_ADDRESS ]; /**< The IP address of the server. */
+            uint8_t ucAddressLength;                     /**< 4 or 16, zero for an unused entry. */
+            uint8_t ucCookieLength;                      /**< The length of the cookie. */
+            uint8_t ucCookie[ tcpFAST_OPEN_COOKIE_MAX ]; /**< The cookie. */
+        } TCPFastOpenCookie_t;
+
+/** @brief The cookies of the servers that were visited, see ipconfigTCP_FAST_OPEN_CACHE_ENTRIES. */
+        static TCPFastOpenCookie_t xFastOpenCache[ ipconfigTCP_FAST_OPEN_CACHE_ENTRIES ];
+
+/** @brief The entry that will be replaced when a new server is stored. */
+        static UBaseType_t uxFastOpenCacheNext = 0U;
+
+/**
+ * @brief Find the cookie entry of the peer of a socket.
+ *
+ * @param[in] pucAddress The IP address of the peer.
+ * @param[in] ucAddressLength The length of that address.
+ *
+ * @return The entry, or NULL when the peer is not in the cache.
+ */
+        static TCPFastOpenCookie_t * prvTCPFastOpenCacheFind( const uint8_t * pucAddress,
+                                                              uint8_t ucAddressLength )
+        {
+            TCPFastOpenCookie_t * pxReturn = NULL;
+            UBaseType_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigTCP_FAST_OPEN_CACHE_ENTRIES; uxIndex++ )
+            {
+                if( ( xFastOpenCache[ uxIndex ].ucAddressLength == ucAddressLength ) &&
+                    ( memcmp( xFastOpenCache[ uxIndex ].ucAddress, pucAddress, ucAddressLength ) == 0 ) )
+                {
+                    pxReturn = &( xFastOpenCache[ uxIndex ] );
+                    break;
+                }
+            }
+
+            return pxReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Look up the cookie that the peer of a socket handed out earlier.
+ *
+ * @param[in] pxSocket The connecting socket.
+ * @param[out] pucCookie Where the cookie will be copied to, tcpFAST_OPEN_COOKIE_MAX bytes.
+ *
+ * @return The length of the cookie, or zero when no cookie is known.
+ */
+        size_t prvTCPFastOpenCookieGet( const FreeRTOS_Socket_t * pxSocket,
+                                        uint8_t * pucCookie )
+        {
+            uint8_t ucAddress[ ipSIZE_OF_IPv6_ADDRESS ];
+            uint8_t ucAddressLength = prvTCPPeerAddress( pxSocket, ucAddress );
+            const TCPFastOpenCookie_t * pxEntry = prvTCPFastOpenCacheFind( ucAddress, ucAddressLength );
+            size_t uxLength = 0U;
+
+            if( pxEntry != NULL )
+            {
+                uxLength = ( size_t ) pxEntry->ucCookieLength;
+                ( void ) memcpy( pucCookie, pxEntry->ucCookie, uxLength );
+            }
+
+            return uxLength;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Store the cookie that the peer of a socket sent in its SYN+ACK.
+ *
+ * @param[in] pxSocket The connecting socket.
+ * @param[in] pucCookie The cookie.
+ * @param[in] uxLength The length of the cookie, at most tcpFAST_OPEN_COOKIE_MAX.
+ */
+        void prvTCPFastOpenCookieStore( const FreeRTOS_Socket_t * pxSocket,
+                                        const uint8_t * pucCookie,
+                                        size_t uxLength )
+        {
+            uint8_t ucAddress[ ipSIZE_OF_IPv6_ADDRESS ];
+            uint8_t ucAddressLength = prvTCPPeerAddress( pxSocket, ucAddress );
+            TCPFastOpenCookie_t * pxEntry = prvTCPFastOpenCacheFind( ucAddress, ucAddressLength );
+
+            if( pxEntry == NULL )
+            {
+                /* Replace the entry that was stored the longest ago. */
+                pxEntry = &( xFastOpenCache[ uxFastOpenCacheNext ] );
+                uxFastOpenCacheNext++;
+
+                if( uxFastOpenCacheNext >= ( UBaseType_t ) ipconfigTCP_FAST_OPEN_CACHE_ENTRIES )
+                {
+                    uxFastOpenCacheNext = 0U;
+                }
+
+                ( void ) memcpy( pxEntry->ucAddress, ucAddress, ucAddressLength );
+                pxEntry->ucAddressLength = ucAddressLength;
+            }
+
+            pxEntry->ucCookieLength = ( uint8_t ) uxLength;
+            ( void ) memcpy( pxEntry->ucCookie, pucCookie, uxLength );
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Make the cookie that this host hands out to the peer of a socket:
+ *        a keyed hash of the peer's IP address.
+ *
+ * @param[in] pxSocket The socket that received a SYN.
+ * @param[out] pucCookie Where the cookie will be written, tcpFAST_OPEN_COOKIE_LENGTH bytes.
+ *
+ * @return pdPASS when the cookie was made, pdFAIL when no random key could be
+ *         obtained.
+ */
+        BaseType_t prvTCPFastOpenCookieMake( const FreeRTOS_Socket_t * pxSocket,
+                                             uint8_t * pucCookie )
+        {
+            uint8_t ucAddress[ ipSIZE_OF_IPv6_ADDRESS ];
+            uint8_t ucAddressLength = prvTCPPeerAddress( pxSocket, ucAddress );
+            uint64_t ullHash;
+            size_t uxByte;
+            BaseType_t xReturn;
+
+            xReturn = prvTCPCookieHash( ucAddress, ( size_t ) ucAddressLength, &( ullHash ) );
+
+            if( xReturn == pdPASS )
+            {
+                for( uxByte = 0U; uxByte < tcpFAST_OPEN_COOKIE_LENGTH; uxByte++ )
+                {
+                    pucCookie[ uxByte ] = ( uint8_t ) ( ( ullHash >> ( 8U * uxByte ) ) & 0xffU );
+                }
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_FAST_OPEN != 0 */
+
+    #if ( ipconfigUSE_TCP_SYN_COOKIES != 0 )
+
+/** @brief The length of the time slot of a SYN cookie, 64 seconds. */
+        #define tcpSYN_COOKIE_SLOT_TICKS    ( ( TickType_t ) 64U * ( TickType_t ) configTICK_RATE_HZ )
+
+/** @brief The MSS values that can be encoded in the lowest 3 bits of a SYN cookie. */
+        static const uint16_t usSynCookieMSS[ 8 ] = { 536U, 1024U, 1220U, 1280U, 1360U, 1400U, 1440U, 1460U };
+
+/**
+ * @brief Get the MSS option from a received SYN packet.
+ *
+ * @param[in] pxNetworkBuffer The network buffer with the SYN.
+ *
+ * @return The MSS of the peer, or tcpMINIMUM_SEGMENT_LENGTH when it sent none.
+ */
+        static uint16_t prvTCPSynCookiePeerMSS( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            size_t uxTCPHeaderOffset = ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer );
+            const uint8_t * pucOptions = &( pxNetworkBuffer->pucEthernetBuffer[ uxTCPHeaderOffset + ipSIZE_OF_TCP_HEADER ] );
+            size_t uxHeaderLength = ( ( size_t ) ( pxNetworkBuffer->pucEthernetBuffer[ uxTCPHeaderOffset + 12U ] >> 4 ) ) * 4U;
+            size_t uxOptionsLength = 0U;
+            size_t uxIndex = 0U;
+            size_t uxLength;
+            uint16_t usMSS = ( uint16_t ) tcpMINIMUM_SEGMENT_LENGTH;
+
+            if( ( uxHeaderLength > ipSIZE_OF_TCP_HEADER ) &&
+                ( ( uxTCPHeaderOffset + uxHeaderLength ) <= pxNetworkBuffer->xDataLength ) )
+            {
+                uxOptionsLength = uxHeaderLength - ipSIZE_OF_TCP_HEADER;
+            }
+
+            while( uxIndex < uxOptionsLength )
+            {
+                if( pucOptions[ uxIndex ] == tcpTCP_OPT_END )
+                {
+                    break;
+                }
+
+                if( pucOptions[ uxIndex ] == tcpTCP_OPT_NOOP )
+                {
+                    uxIndex++;
+                }
+                else
+                {
+                    if( ( uxIndex + 1U ) >= uxOptionsLength )
+                    {
+                        break;
+                    }
+
+                    uxLength = ( size_t ) pucOptions[ uxIndex + 1U ];
+
+                    if( ( uxLength < 2U ) || ( ( uxIndex + uxLength ) > uxOptionsLength ) )
+                    {
+                        break;
+                    }
+
+                    if( ( pucOptions[ uxIndex ] == tcpTCP_OPT_MSS ) && ( uxLength == tcpTCP_OPT_MSS_LEN ) )
+                    {
+                        usMSS = ( uint16_t ) ( ( ( ( uint16_t ) pucOptions[ uxIndex + 2U ] ) << 8 ) | ( uint16_t ) pucOptions[ uxIndex + 3U ] );
+                    }
+
+                    uxIndex += uxLength;
+                }
+            }
+
+            return usMSS;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Hash the connection of a packet, the peer's initial sequence number
+ *        and the time slot of a SYN cookie.
+ *
+ * @param[in] pxNetworkBuffer The network buffer with a SYN or an ACK from the peer.
+ * @param[in] ulPeerSequence The initial sequence number of the peer.
+ * @param[in] ulSlot The time slot, shifted left by 3 bits, plus the MSS index.
+ * @param[out] pulHash Where the hash will be written.
+ *
+ * @return pdPASS when the hash was made, pdFAIL when no random key could be
+ *         obtained.
+ */
+        static BaseType_t prvTCPSynCookieHash( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                               uint32_t ulPeerSequence,
+                                               uint32_t ulSlot,
+                                               uint32_t * pulHash )
+        {
+            uint8_t ucData[ ( 2U * ipSIZE_OF_IPv6_ADDRESS ) + 12U ];
+            size_t uxLength = 0U;
+            uint64_t ullHash = 0U;
+            BaseType_t xReturn;
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * )
+                                                            &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer ) ] ) );
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( uxIPHeaderSizePacket( pxNetworkBuffer ) == ipSIZE_OF_IPv6_HEADER )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    const IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                    ( void ) memcpy( &( ucData[ 0 ] ), pxIPHeader_IPv6->xSourceAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                    ( void ) memcpy( &( ucData[ ipSIZE_OF_IPv6_ADDRESS ] ), pxIPHeader_IPv6->xDestinationAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                    uxLength = 2U * ipSIZE_OF_IPv6_ADDRESS;
+                }
+                else
+            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                    ( void ) memcpy( &( ucData[ 0 ] ), &( pxIPHeader->ulSourceIPAddress ), ipSIZE_OF_IPv4_ADDRESS );
+                    ( void ) memcpy( &( ucData[ ipSIZE_OF_IPv4_ADDRESS ] ), &( pxIPHeader->ulDestinationIPAddress ), ipSIZE_OF_IPv4_ADDRESS );
+                    uxLength = 2U * ipSIZE_OF_IPv4_ADDRESS;
+                }
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+            }
+
+            ( void ) memcpy( &( ucData[ uxLength ] ), &( pxProtocolHeaders->xTCPHeader.usSourcePort ), sizeof( uint16_t ) );
+            uxLength += sizeof( uint16_t );
+            ( void ) memcpy( &( ucData[ uxLength ] ), &( pxProtocolHeaders->xTCPHeader.usDestinationPort ), sizeof( uint16_t ) );
+            uxLength += sizeof( uint16_t );
+            ucData[ uxLength ] = ( uint8_t ) ( ulPeerSequence >> 24 );
+            ucData[ uxLength + 1U ] = ( uint8_t ) ( ( ulPeerSequence >> 16 ) & 0xffU );
+            ucData[ uxLength + 2U ] = ( uint8_t ) ( ( ulPeerSequence >> 8 ) & 0xffU );
+            ucData[ uxLength + 3U ] = ( uint8_t ) ( ulPeerSequence & 0xffU );
+            ucData[ uxLength + 4U ] = ( uint8_t ) ( ulSlot >> 24 );
+            ucData[ uxLength + 5U ] = ( uint8_t ) ( ( ulSlot >> 16 ) & 0xffU );
+            ucData[ uxLength + 6U ] = ( uint8_t ) ( ( ulSlot >> 8 ) & 0xffU );
+            ucData[ uxLength + 7U ] = ( uint8_t ) ( ulSlot & 0xffU );
+            uxLength += 8U;
+
+            xReturn = prvTCPCookieHash( ucData, uxLength, &( ullHash ) );
+            *pulHash = ( uint32_t ) ( ullHash & 0xffffffffU );
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Make a SYN cookie, the initial sequence number of a SYN+ACK that is
+ *        sent without creating a socket. Bits 31-8 hold a hash, bits 7-3 the
+ *        time slot and bits 2-0 the index of the peer's MSS.
+ *
+ * @param[in] pxNetworkBuffer The network buffer with the SYN.
+ * @param[out] pulCookie Where the cookie will be written.
+ *
+ * @return pdPASS when the cookie was made, pdFAIL when no random key could be
+ *         obtained.
+ */
+        BaseType_t prvTCPSynCookieMake( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                        uint32_t * pulCookie )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * )
+                                                            &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer ) ] ) );
+            uint16_t usPeerMSS = prvTCPSynCookiePeerMSS( pxNetworkBuffer );
+            uint32_t ulSlot = ( uint32_t ) ( xTaskGetTickCount() / tcpSYN_COOKIE_SLOT_TICKS );
+            uint32_t ulIndex = 0U;
+            uint32_t ulHash = 0U;
+            BaseType_t xReturn;
+
+            /* Take the largest MSS that the peer can handle. */
+            while( ( ulIndex < 7U ) && ( usSynCookieMSS[ ulIndex + 1U ] <= usPeerMSS ) )
+            {
+                ulIndex++;
+            }
+
+            xReturn = prvTCPSynCookieHash( pxNetworkBuffer,
+                                           FreeRTOS_ntohl( pxProtocolHeaders->xTCPHeader.ulSequenceNumber ),
+                                           ( ulSlot << 3 ) | ulIndex,
+                                           &( ulHash ) );
+
+            *pulCookie = ( ulHash & 0xffffff00U ) | ( ( ulSlot & 0x1fU ) << 3 ) | ulIndex;
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Check whether an ACK to a listening socket carries a valid SYN
+ *        cookie that was made in the current or in the previous time slot.
+ *
+ * @param[in] pxNetworkBuffer The network buffer with the ACK.
+ *
+ * @return The MSS of the peer that was encoded in the cookie, or zero when
+ *         the cookie is not valid.
+ */
+        uint16_t prvTCPSynCookieCheck( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * )
+                                                            &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer ) ] ) );
+            uint32_t ulCookie = FreeRTOS_ntohl( pxProtocolHeaders->xTCPHeader.ulAckNr ) - 1U;
+            uint32_t ulNow = ( uint32_t ) ( xTaskGetTickCount() / tcpSYN_COOKIE_SLOT_TICKS );
+            uint32_t ulAge = ( ulNow - ( ulCookie >> 3 ) ) & 0x1fU;
+            uint32_t ulIndex = ulCookie & 0x07U;
+            uint32_t ulHash = 0U;
+            uint16_t usMSS = 0U;
+
+            if( ulAge <= 1U )
+            {
+                if( ( prvTCPSynCookieHash( pxNetworkBuffer,
+                                           FreeRTOS_ntohl( pxProtocolHeaders->xTCPHeader.ulSequenceNumber ) - 1U,
+                                           ( ( ulNow - ulAge ) << 3 ) | ulIndex,
+                                           &( ulHash ) ) == pdPASS ) &&
+                    ( ( ulHash & 0xffffff00U ) == ( ulCookie & 0xffffff00U ) ) )
+                {
+                    usMSS = usSynCookieMSS[ ulIndex ];
+                }
+            }
+
+            return usMSS;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_TCP_SYN_COOKIES != 0 */
+
+    #if ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
+
+/** @brief The path MTU of a destination, stored as the MSS that fits in it. */
+        typedef struct xTCP_PATH_MTU
+        {
+            uint8_t ucAddress[ ipSIZE_OF_IPv6_ADDRESS ]; /**< The IP address of the peer. */
+            uint8_t ucAddressLength;                     /**< 4 or 16, zero for an unused entry. */
+            uint16_t usMSS;                              /**< The largest TCP payload that passes the path. */
+            TickType_t xTimeLearned;                     /**< The time at which usMSS was learned. */
+        } TCPPathMTU_t;
+
+/** @brief The destinations with a reduced path MTU, see ipconfigPATH_MTU_CACHE_ENTRIES. */
+        static TCPPathMTU_t xPathMTUCache[ ipconfigPATH_MTU_CACHE_ENTRIES ];
+
+/** @brief The entry that will be replaced when a new destination is stored. */
+        static UBaseType_t uxPathMTUCacheNext = 0U;
+
+/**
+ * @brief Find the path MTU entry of a peer. An entry that is older than
+ *        ipconfigPATH_MTU_CACHE_AGE_SEC is forgotten.
+ *
+ * @param[in] pucAddress The IP address of the peer, in network byte order.
+ * @param[in] ucAddressLength The length of that address.
+ *
+ * @return The entry, or NULL when the peer is not in the cache.
+ */
+        static TCPPathMTU_t * prvTCPPathMTUFind( const uint8_t * pucAddress,
+                                                 uint8_t ucAddressLength )
+        {
+            TCPPathMTU_t * pxReturn = NULL;
+            UBaseType_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigPATH_MTU_CACHE_ENTRIES; uxIndex++ )
+            {
+                if( ( xPathMTUCache[ uxIndex ].ucAddressLength == ucAddressLength ) &&
+                    ( memcmp( xPathMTUCache[ uxIndex ].ucAddress, pucAddress, ucAddressLength ) == 0 ) )
+                {
+                    if( ( xTaskGetTickCount() - xPathMTUCache[ uxIndex ].xTimeLearned ) >= pdMS_TO_TICKS( ipconfigPATH_MTU_CACHE_AGE_SEC * 1000U ) )
+                    {
+                        /* The path may have become wider, try the full MSS again. */
+                        xPathMTUCache[ uxIndex ].ucAddressLength = 0U;
+                    }
+                    else
+                    {
+                        pxReturn = &( xPathMTUCache[ uxIndex ] );
+                    }
+
+                    break;
+                }
+            }
+
+            return pxReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Lower the MSS of a connection because its path is too narrow, and
+ *        remember the new value for the peer.
+ *
+ * @param[in] pxSocket The TCP socket.
+ * @param[in] usMSS The MSS that fits in the path.
+ */
+        static void prvTCPPathMSSLower( FreeRTOS_Socket_t * pxSocket,
+                                        uint16_t usMSS )
+        {
+            uint8_t ucAddress[ ipSIZE_OF_IPv6_ADDRESS ];
+            uint8_t ucAddressLength = prvTCPPeerAddress( pxSocket, ucAddress );
+            TCPPathMTU_t * pxEntry = prvTCPPathMTUFind( ucAddress, ucAddressLength );
+
+            FreeRTOS_debug_printf( ( "Path MTU: port %u MSS %u -> %u\n",
+                                     pxSocket->u.xTCP.usRemotePort,
+                                     pxSocket->u.xTCP.usMSS,
+                                     usMSS ) );
+
+            /* Only segments that are created from now on will use the new MSS. */
+            pxSocket->u.xTCP.usMSS = usMSS;
+            pxSocket->u.xTCP.xTCPWindow.usMSS = usMSS;
+
+            if( pxEntry == NULL )
+            {
+                /* Replace the entry that was stored the longest ago. */
+                pxEntry = &( xPathMTUCache[ uxPathMTUCacheNext ] );
+                uxPathMTUCacheNext++;
+
+                if( uxPathMTUCacheNext >= ( UBaseType_t ) ipconfigPATH_MTU_CACHE_ENTRIES )
+                {
+                    uxPathMTUCacheNext = 0U;
+                }
+
+                ( void ) memcpy( pxEntry->ucAddress, ucAddress, ucAddressLength );
+                pxEntry->ucAddressLength = ucAddressLength;
+            }
+
+            pxEntry->usMSS = usMSS;
+            pxEntry->xTimeLearned = xTaskGetTickCount();
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the MSS that fits in the path to the peer of a socket.
+ *
+ * @param[in] pxSocket The TCP socket.
+ *
+ * @return The MSS, or zero when no path MTU is known for the peer.
+ */
+        uint16_t prvTCPPathMSSGet( const FreeRTOS_Socket_t * pxSocket )
+        {
+            uint8_t ucAddress[ ipSIZE_OF_IPv6_ADDRESS ];
+            uint8_t ucAddressLength = prvTCPPeerAddress( pxSocket, ucAddress );
+            const TCPPathMTU_t * pxEntry = prvTCPPathMTUFind( ucAddress, ucAddressLength );
+            uint16_t usMSS = 0U;
+
+            if( pxEntry != NULL )
+            {
+                usMSS = pxEntry->usMSS;
+            }
+
+            return usMSS;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Handle an ICMP "fragmentation needed" or an ICMPv6 "packet too big"
+ *        message. The quoted packet must belong to a connection, and its
+ *        sequence number must be outstanding, before the MSS is lowered.
+ *
+ * @param[in] xIsIPv6 pdTRUE when the quoted packet is IPv6.
+ * @param[in] pucQuoted The IP header of the packet that was too big.
+ * @param[in] uxQuotedLength The number of bytes available at pucQuoted.
+ * @param[in] ulMTU The MTU reported by the router, zero when unknown.
+ */
+        void vTCPPathMTUReport( BaseType_t xIsIPv6,
+                                const uint8_t * pucQuoted,
+                                size_t uxQuotedLength,
+                                uint32_t ulMTU )
+        {
+            IPv46_Address_t xRemoteIP;
+            size_t uxIPHeaderLength = 0U;
+            uint32_t ulMinimumMSS = tcpMINIMUM_SEGMENT_LENGTH;
+            uint32_t ulMSS;
+            uint32_t ulSequenceNumber;
+            uint8_t ucProtocol = 0U;
+            FreeRTOS_Socket_t * pxSocket = NULL;
+
+            ( void ) memset( &( xRemoteIP ), 0, sizeof( xRemoteIP ) );
+
+            /* The quoted packet was sent by this host: its destination is the
+             * peer, and the source port of its TCP header is the local port. */
+            if( xIsIPv6 != pdFALSE )
+            {
+                if( uxQuotedLength >= ipSIZE_OF_IPv6_HEADER )
+                {
+                    uxIPHeaderLength = ipSIZE_OF_IPv6_HEADER;
+                    ulMinimumMSS = tcpMINIMUM_SEGMENT_LENGTH_IPv6;
+                    ucProtocol = pucQuoted[ 6 ];
+                    xRemoteIP.xIs_IPv6 = pdTRUE;
+                    ( void ) memcpy( xRemoteIP.xIPAddress.xIP_IPv6.ucBytes, &( pucQuoted[ 24 ] ), ipSIZE_OF_IPv6_ADDRESS );
+                }
+            }
+            else
+            {
+                if( uxQuotedLength >= ipSIZE_OF_IPv4_HEADER )
+                {
+                    uxIPHeaderLength = ( ( size_t ) pucQuoted[ 0 ] & 0x0FU ) << 2;
+                    ucProtocol = pucQuoted[ 9 ];
+                    xRemoteIP.xIs_IPv6 = pdFALSE;
+
+                    /* The socket keeps the IPv4 address in host byte order. */
+                    xRemoteIP.xIPAddress.ulIP_IPv4 = ulChar2u32( &( pucQuoted[ 16 ] ) );
+                }
+            }
+
+            /* RFC 792 and RFC 4443 quote at least 8 bytes of the TCP header:
+             * both port numbers and the sequence number. */
+            if( ( ucProtocol == ( uint8_t ) ipPROTOCOL_TCP ) &&
+                ( uxIPHeaderLength >= ipSIZE_OF_IPv4_HEADER ) &&
+                ( uxQuotedLength >= ( uxIPHeaderLength + 8U ) ) )
+            {
+                pxSocket = pxTCPSocketLookup( 0U,
+                                              ( UBaseType_t ) usChar2u16( &( pucQuoted[ uxIPHeaderLength ] ) ),
+                                              xRemoteIP,
+                                              ( UBaseType_t ) usChar2u16( &( pucQuoted[ uxIPHeaderLength + 2U ] ) ) );
+            }
+
+            if( ( pxSocket != NULL ) && ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) )
+            {
+                const TCPWindow_t * pxWindow = &( pxSocket->u.xTCP.xTCPWindow );
+
+                ulSequenceNumber = ulChar2u32( &( pucQuoted[ uxIPHeaderLength + 4U ] ) );
+
+                /* Old ICMP routers do not report the MTU, try the minimum. */
+                if( ulMTU == 0U )
+                {
+                    ulMSS = ulMinimumMSS;
+                }
+                else if( ulMTU > ( uxIPHeaderLength + ipSIZE_OF_TCP_HEADER ) )
+                {
+                    ulMSS = FreeRTOS_max_uint32( ulMinimumMSS, ulMTU - ( uint32_t ) ( uxIPHeaderLength + ipSIZE_OF_TCP_HEADER ) );
+                }
+                else
+                {
+                    ulMSS = ulMinimumMSS;
+                }
+
+                /* Ignore messages that do not quote data that is outstanding,
+                 * they may have been forged ( RFC 5927 ). */
+                if( ( ( ulSequenceNumber - pxWindow->tx.ulCurrentSequenceNumber ) < ( pxWindow->ulNextTxSequenceNumber - pxWindow->tx.ulCurrentSequenceNumber ) ) &&
+                    ( ulMSS < ( uint32_t ) pxSocket->u.xTCP.usMSS ) )
+                {
+                    prvTCPPathMSSLower( pxSocket, ( uint16_t ) ulMSS );
+                }
+            }
+        }
+        /*-----------------------------------------------------------*/
+
+        #if ( ipconfigUSE_TCP_WIN == 1 )
+
+/**
+ * @brief Detect a path MTU black hole: when ICMP messages are filtered, a
+ *        full-size segment that keeps timing out makes the connection fall
+ *        back to the minimum MSS ( RFC 4821 ). Called for every segment
+ *        that is sent with data.
+ *
+ * @param[in] pxSocket The TCP socket.
+ * @param[in] ulLength The length of the segment that is being sent.
+ */
+            void prvTCPPathMTUCheckTimeouts( FreeRTOS_Socket_t * pxSocket,
+                                             uint32_t ulLength )
+            {
+                const TCPWindow_t * pxWindow = &( pxSocket->u.xTCP.xTCPWindow );
+                uint32_t ulMinimumMSS = tcpMINIMUM_SEGMENT_LENGTH;
+
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    if( pxSocket->bits.bIsIPv6 != pdFALSE_UNSIGNED )
+                    {
+                        ulMinimumMSS = tcpMINIMUM_SEGMENT_LENGTH_IPv6;
+                    }
+                #endif
+
+                if( pxSocket->u.xTCP.ulPathMTUSequence != pxWindow->tx.ulCurrentSequenceNumber )
+                {
+                    /* The peer has acknowledged new data, start counting again. */
+                    pxSocket->u.xTCP.ulPathMTUSequence = pxWindow->tx.ulCurrentSequenceNumber;
+                    pxSocket->u.xTCP.ulPathMTUTimeouts = pxWindow->ulRetransmitCount;
+                }
+                else if( ( ( pxWindow->ulRetransmitCount - pxSocket->u.xTCP.ulPathMTUTimeouts ) >= tcpPATH_MTU_BLACK_HOLE_TIMEOUTS ) &&
+                         ( ulLength >= ( uint32_t ) pxSocket->u.xTCP.usMSS ) &&
+                         ( ( uint32_t ) pxSocket->u.xTCP.usMSS > ulMinimumMSS ) )
+                {
+                    prvTCPPathMSSLower( pxSocket, ( uint16_t ) ulMinimumMSS );
+                    pxSocket->u.xTCP.ulPathMTUTimeouts = pxWindow->ulRetransmitCount;
+                }
+                else
+                {
+                    /* Keep counting. */
+                }
+            }
+            /*-----------------------------------------------------------*/
+        #endif /* ipconfigUSE_TCP_WIN == 1 */
+
+    #endif /* ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 */
+
 #endif /* ipconfigUSE_TCP == 1 */
@@ -93,12 +93,66 @@
     #endif /* configUSE_TCP_WIN */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS == 0 ) )
         static void vListInsertGeneric( List_t * const pxList,
                                         ListItem_t * const pxNewListItem,
                                         MiniListItem_t * pxWhere );
     #endif
 
+/*
+ * The lists of segment descriptors are accessed through the tcpwinLIST macros.
+ * By default these are FreeRTOS lists.  When ipconfigTCP_WIN_COMPACT_SEGMENTS
+ * is enabled, the descriptors are linked by their index in 'xTCPSegments'.
+ */
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS != 0 ) )
+        #define tcpwinLIST_END_INDEX                        ( ( uint16_t ) 0xFFFFU )
+
+        #define tcpwinLIST_INITIALISE( pxList, xMember )    prvListInitialise( ( pxList ), offsetof( TCPSegment_t, xMember ) )
+        #define tcpwinLIST_IS_INITIALISED( pxList )         ( ( ( pxList )->xListEnd.pxContainer != NULL ) ? pdTRUE : pdFALSE )
+        #define tcpwinLIST_INSERT_FIFO( pxList, pxItem )    prvListInsertFifo( ( pxList ), ( pxItem ) )
+        #define tcpwinLIST_REMOVE( pxItem )                 prvListRemove( pxItem )
+        #define tcpwinLIST_CONTAINER( pxItem )              ( ( pxItem )->pxContainer )
+        #define tcpwinLIST_LENGTH( pxList )                 ( ( pxList )->uxNumberOfItems )
+        #define tcpwinLIST_IS_EMPTY( pxList )               ( ( ( pxList )->uxNumberOfItems == 0U ) ? pdTRUE : pdFALSE )
+        #define tcpwinLIST_END( pxList )                    ( &( ( pxList )->xListEnd ) )
+        #define tcpwinLIST_HEAD( pxList )                   prvListNext( &( ( pxList )->xListEnd ) )
+        #define tcpwinLIST_TAIL( pxList )                   prvListPrevious( &( ( pxList )->xListEnd ) )
+        #define tcpwinLIST_NEXT( pxItem )                   prvListNext( pxItem )
+        #define tcpwinLIST_OWNER( pxItem )                  prvListOwner( pxItem )
+        #define tcpwinLIST_OWNER_OF_HEAD( pxList )          prvListOwner( tcpwinLIST_HEAD( pxList ) )
+
+        static void prvListInitialise( TCPSegmentList_t * pxList,
+                                       size_t uxItemOffset );
+
+        static TCPSegmentItem_t * prvListItem( TCPSegmentList_t * pxList,
+                                               uint16_t usIndex );
+
+        static TCPSegmentItem_t * prvListNext( const TCPSegmentItem_t * pxItem );
+
+        static TCPSegmentItem_t * prvListPrevious( const TCPSegmentItem_t * pxItem );
+
+        static TCPSegment_t * prvListOwner( const TCPSegmentItem_t * pxItem );
+
+        static void prvListInsertFifo( TCPSegmentList_t * pxList,
+                                       TCPSegmentItem_t * pxItem );
+
+        static UBaseType_t prvListRemove( TCPSegmentItem_t * pxItem );
+    #elif ( ipconfigUSE_TCP_WIN == 1 )
+        #define tcpwinLIST_INITIALISE( pxList, xMember )    vListInitialise( pxList )
+        #define tcpwinLIST_IS_INITIALISED( pxList )         listLIST_IS_INITIALISED( pxList )
+        #define tcpwinLIST_INSERT_FIFO( pxList, pxItem )    vListInsertFifo( ( pxList ), ( pxItem ) )
+        #define tcpwinLIST_REMOVE( pxItem )                 uxListRemove( pxItem )
+        #define tcpwinLIST_CONTAINER( pxItem )              listLIST_ITEM_CONTAINER( pxItem )
+        #define tcpwinLIST_LENGTH( pxList )                 listCURRENT_LIST_LENGTH( pxList )
+        #define tcpwinLIST_IS_EMPTY( pxList )               listLIST_IS_EMPTY( pxList )
+        #define tcpwinLIST_END( pxList )                    ( ( const ListItem_t * ) &( ( pxList )->xListEnd ) )
+        #define tcpwinLIST_HEAD( pxList )                   listGET_HEAD_ENTRY( pxList )
+        #define tcpwinLIST_TAIL( pxList )                   ( ( pxList )->xListEnd.pxPrevious )
+        #define tcpwinLIST_NEXT( pxItem )                   listGET_NEXT( pxItem )
+        #define tcpwinLIST_OWNER( pxItem )                  listGET_LIST_ITEM_OWNER( pxItem )
+        #define tcpwinLIST_OWNER_OF_HEAD( pxList )          listGET_OWNER_OF_HEAD_ENTRY( pxList )
+    #endif /* if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS != 0 ) ) */
+
 /*
  * All TCP sockets share a pool of segment descriptors (TCPSegment_t)
  * Available descriptors are stored in the 'xSegmentList'
@@ -111,14 +165,22 @@
         static BaseType_t prvCreateSectors( void );
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 
+/*
+ * All descriptors of a chunk of the segment pool have been returned, see if
+ * the chunk can be given back to the heap.
+ */
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 ) )
+        static void prvReleaseSectors( struct xTCP_SEGMENT_CHUNK * pxChunk );
+    #endif
+
 /*
  * Find a segment with a given sequence number in the list of received
  * segments: 'pxWindow->xRxSegments'.
  */
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) )
         static TCPSegment_t * xTCPWindowRxFind( const TCPWindow_t * pxWindow,
                                                 uint32_t ulSequenceNumber );
-    #endif /* ipconfigUSE_TCP_WIN == 1 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) */
 
 /*
  * Allocate a new segment
@@ -136,14 +198,14 @@
  * Detaches and returns the head of a queue
  */
     #if ( ipconfigUSE_TCP_WIN == 1 )
-        static TCPSegment_t * xTCPWindowGetHead( const List_t * pxList );
+        static TCPSegment_t * xTCPWindowGetHead( const TCPSegmentList_t * pxList );
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 
 /*
  * Returns the head of a queue but it won't be detached
  */
     #if ( ipconfigUSE_TCP_WIN == 1 )
-        static TCPSegment_t * xTCPWindowPeekHead( const List_t * pxList );
+        static TCPSegment_t * xTCPWindowPeekHead( const TCPSegmentList_t * pxList );
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 
 /*
@@ -162,11 +224,20 @@
  * (ulSequenceNumber+xLength).  Normally none will be found, because the next Rx
  * segment should have a sequence number equal to '(ulSequenceNumber+xLength)'.
  */
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) )
         static TCPSegment_t * xTCPWindowRxConfirm( const TCPWindow_t * pxWindow,
                                                    uint32_t ulSequenceNumber,
                                                    uint32_t ulLength );
-    #endif /* ipconfigUSE_TCP_WIN == 1 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) */
+
+/*
+ * Find the first interval of out-of-order data which ends at or after the
+ * given sequence number, using a binary search.
+ */
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT != 0 ) )
+        static UBaseType_t prvTCPWindowRxIntervalSearch( const TCPWindow_t * pxWindow,
+                                                         uint32_t ulSequenceNumber );
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT != 0 ) */
 
 /*
  * FreeRTOS+TCP stores data in circular buffers.  Calculate the next position to
@@ -187,6 +258,25 @@
                                                   uint32_t ulWindowSize );
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 
+/*
+ * Keep pxTxIndex[] in line with xTxSegments: a segment was added at the tail,
+ * or it is about to be freed from the head.
+ */
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 ) )
+        static void prvTCPWindowTxIndexAdd( TCPWindow_t * pxWindow,
+                                            TCPSegment_t * pxSegment );
+
+        static void prvTCPWindowTxIndexRemove( TCPWindow_t * pxWindow,
+                                               const TCPSegment_t * pxSegment );
+
+/*
+ * Find the first outgoing segment which starts at or after the given sequence
+ * number, using a binary search.
+ */
+        static const TCPSegmentItem_t * prvTCPWindowTxIndexSearch( const TCPWindow_t * pxWindow,
+                                                                   uint32_t ulSequenceNumber );
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 ) */
+
 /*
  * An acknowledge was received.  See if some outstanding data may be removed
  * from the transmission queue(s).
@@ -206,16 +296,80 @@
                                                     uint32_t ulFirst );
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) )
+
+/*
+ * New data has been acknowledged: let the congestion control grow its window.
+ */
+        static void prvTCPCongestionAck( TCPWindow_t * pxWindow,
+                                         uint32_t ulAckedBytes );
+
+/*
+ * A segment will be retransmitted: let the congestion control reduce its window.
+ */
+        static void prvTCPCongestionLoss( TCPWindow_t * pxWindow,
+                                          BaseType_t xTimeout );
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) */
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) )
+
+/*
+ * A segment has been delivered: remember it when it is the most recently sent
+ * one that was delivered.
+ */
+        static void prvTCPRackUpdate( TCPWindow_t * pxWindow,
+                                      const TCPSegment_t * pxSegment );
+
+/*
+ * Return the time in ms after which an outstanding segment will be considered
+ * lost, zero if it is lost already.
+ */
+        static uint32_t prvTCPRackTimeLeft( const TCPWindow_t * pxWindow,
+                                            const TCPSegment_t * pxSegment );
+
+/*
+ * Move all outstanding segments that RACK considers lost to the priority
+ * queue.  Returns the number of segments moved.
+ */
+        static uint32_t prvTCPRackDetectLoss( TCPWindow_t * pxWindow );
+
+/*
+ * Return the time in ms after which the retransmission time-out, that was
+ * restarted by a tail loss probe, expires.
+ */
+        static uint32_t prvTCPWindowTxProbeDelay( const TCPWindow_t * pxWindow );
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) */
+
 /*-----------------------------------------------------------*/
 
 /**< TCP segment pool. */
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 ) )
+
+/** @brief A chunk of segment descriptors, the pool grows and shrinks by chunks. */
+        typedef struct xTCP_SEGMENT_CHUNK
+        {
+            struct xTCP_SEGMENT_CHUNK * pxNext;                        /**< The next chunk in the pool */
+            UBaseType_t uxUsed;                                        /**< The number of descriptors borrowed by a socket */
+            TCPSegment_t xSegments[ ipconfigTCP_WIN_SEG_CHUNK_COUNT ]; /**< The descriptors */
+        } TCPSegmentChunk_t;
+
+        static TCPSegmentChunk_t * pxSegmentChunks = NULL;
+        static UBaseType_t uxSegmentChunkCount = 0U;
+    #elif ( ipconfigUSE_TCP_WIN == 1 )
         static TCPSegment_t * xTCPSegments = NULL;
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 
 /**< List of free TCP segments. */
     #if ( ipconfigUSE_TCP_WIN == 1 )
-        _static List_t xSegmentList;
+        _static TCPSegmentList_t xSegmentList;
+    #endif
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_RESOURCE_STATS != 0 ) )
+/** @brief The highest number of segment descriptors borrowed at the same time. */
+        static UBaseType_t uxSegmentsPeak = 0U;
+
+/** @brief The number of segment descriptors that are allocated. */
+        static UBaseType_t prvTCPWindowSegmentsAllocated( void );
     #endif
 
     #if ( ipconfigUSE_TCP_WIN == 1 )
@@ -329,7 +483,7 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS == 0 ) )
         static portINLINE void vListInsertFifo( List_t * const pxList,
                                                 ListItem_t * const pxNewListItem );
 
@@ -347,6 +501,146 @@
     #endif
 /*-----------------------------------------------------------*/
 
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS != 0 ) )
+
+/**
+ * @brief Initialise an empty list of segment descriptors.
+ *
+ * @param[in] pxList The list to be initialised.
+ * @param[in] uxItemOffset The offset of the item in TCPSegment_t that links the list:
+ *                         either xSegmentItem or xQueueItem.
+ */
+        static void prvListInitialise( TCPSegmentList_t * pxList,
+                                       size_t uxItemOffset )
+        {
+            pxList->xListEnd.usNext = tcpwinLIST_END_INDEX;
+            pxList->xListEnd.usPrevious = tcpwinLIST_END_INDEX;
+            pxList->xListEnd.pxContainer = pxList;
+            pxList->uxNumberOfItems = 0U;
+            pxList->uxItemOffset = uxItemOffset;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Translate an index in a list to a list item.
+ *
+ * @param[in] pxList The list.
+ * @param[in] usIndex The index of a segment descriptor, or tcpwinLIST_END_INDEX.
+ *
+ * @return The item of the segment that links the list, or the end marker of the list.
+ */
+        static TCPSegmentItem_t * prvListItem( TCPSegmentList_t * pxList,
+                                               uint16_t usIndex )
+        {
+            TCPSegmentItem_t * pxReturn;
+
+            if( usIndex == tcpwinLIST_END_INDEX )
+            {
+                pxReturn = &( pxList->xListEnd );
+            }
+            else if( pxList->uxItemOffset == offsetof( TCPSegment_t, xQueueItem ) )
+            {
+                pxReturn = &( xTCPSegments[ usIndex ].xQueueItem );
+            }
+            else
+            {
+                pxReturn = &( xTCPSegments[ usIndex ].xSegmentItem );
+            }
+
+            return pxReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the next item in a list.
+ *
+ * @param[in] pxItem An item that is linked in a list, or the end marker of a list.
+ *
+ * @return The next item, the end marker of the list when pxItem is the tail.
+ */
+        static TCPSegmentItem_t * prvListNext( const TCPSegmentItem_t * pxItem )
+        {
+            return prvListItem( pxItem->pxContainer, pxItem->usNext );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the previous item in a list.
+ *
+ * @param[in] pxItem An item that is linked in a list, or the end marker of a list.
+ *
+ * @return The previous item, the end marker of the list when pxItem is the head.
+ */
+        static TCPSegmentItem_t * prvListPrevious( const TCPSegmentItem_t * pxItem )
+        {
+            return prvListItem( pxItem->pxContainer, pxItem->usPrevious );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the segment descriptor that contains a list item.
+ *
+ * @param[in] pxItem Either the xSegmentItem or the xQueueItem of a segment.
+ *
+ * @return The segment descriptor.
+ */
+        static TCPSegment_t * prvListOwner( const TCPSegmentItem_t * pxItem )
+        {
+            /* Both items lie within the descriptor, so the division drops their
+             * offset. */
+            size_t uxIndex = ( size_t ) ( ( const uint8_t * ) pxItem - ( const uint8_t * ) xTCPSegments ) / sizeof( TCPSegment_t );
+
+            return &( xTCPSegments[ uxIndex ] );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add an item to the tail of a list.
+ *
+ * @param[in] pxList The list.
+ * @param[in] pxItem The item, which is not linked in any list.
+ */
+        static void prvListInsertFifo( TCPSegmentList_t * pxList,
+                                       TCPSegmentItem_t * pxItem )
+        {
+            uint16_t usIndex = ( uint16_t ) ( prvListOwner( pxItem ) - xTCPSegments );
+            TCPSegmentItem_t * pxTail = prvListItem( pxList, pxList->xListEnd.usPrevious );
+
+            pxItem->usNext = tcpwinLIST_END_INDEX;
+            pxItem->usPrevious = pxList->xListEnd.usPrevious;
+            pxItem->pxContainer = pxList;
+
+            /* When the list is empty, the tail is the end marker, and this sets
+             * the head of the list. */
+            pxTail->usNext = usIndex;
+            pxList->xListEnd.usPrevious = usIndex;
+
+            ( pxList->uxNumberOfItems )++;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove an item from the list that contains it.
+ *
+ * @param[in] pxItem The item to be removed.
+ *
+ * @return The number of items left in the list.
+ */
+        static UBaseType_t prvListRemove( TCPSegmentItem_t * pxItem )
+        {
+            TCPSegmentList_t * pxList = pxItem->pxContainer;
+
+            prvListItem( pxList, pxItem->usPrevious )->usNext = pxItem->usNext;
+            prvListItem( pxList, pxItem->usNext )->usPrevious = pxItem->usPrevious;
+            pxItem->pxContainer = NULL;
+
+            ( pxList->uxNumberOfItems )--;
+
+            return pxList->uxNumberOfItems;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS != 0 ) */
+/*-----------------------------------------------------------*/
+
     static portINLINE void vTCPTimerSet( TCPTimer_t * pxTimer );
 
 /**
@@ -357,6 +651,12 @@
     static portINLINE void vTCPTimerSet( TCPTimer_t * pxTimer )
     {
         pxTimer->uxBorn = xTaskGetTickCount();
+
+        #if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 )
+        {
+            pxTimer->ulBornUS = ipconfigTCP_HIGH_RES_TIME_US();
+        }
+        #endif
     }
 /*-----------------------------------------------------------*/
 
@@ -369,13 +669,137 @@
  *
  * @return The time in milliseconds since the timer was born.
  */
-    static portINLINE uint32_t ulTimerGetAge( const TCPTimer_t * pxTimer )
-    {
-        TickType_t uxNow = xTaskGetTickCount();
-        TickType_t uxDiff = uxNow - pxTimer->uxBorn;
+    #if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 )
 
-        return ( uint32_t ) ( uxDiff * portTICK_PERIOD_MS );
-    }
+        static portINLINE uint32_t ulTimerGetAgeUS( const TCPTimer_t * pxTimer );
+
+/**
+ * @brief Get the timer age in microseconds.
+ *
+ * @param[in] pxTimer The timer whose age is to be fetched.
+ *
+ * @return The time in microseconds since the timer was born.
+ */
+        static portINLINE uint32_t ulTimerGetAgeUS( const TCPTimer_t * pxTimer )
+        {
+            return ipconfigTCP_HIGH_RES_TIME_US() - pxTimer->ulBornUS;
+        }
+
+/**
+ * @brief Get the timer age in milliseconds.  It is rounded up, so that a
+ *        time-out of N ms expires as soon as more than N ms have passed.
+ *
+ * @param[in] pxTimer The timer whose age is to be fetched.
+ *
+ * @return The time in milliseconds since the timer was born.
+ */
+        static portINLINE uint32_t ulTimerGetAge( const TCPTimer_t * pxTimer )
+        {
+            uint32_t ulAgeUS = ulTimerGetAgeUS( pxTimer );
+
+            return ( ulAgeUS / 1000U ) + ( ( ( ulAgeUS % 1000U ) != 0U ) ? 1U : 0U );
+        }
+
+    #else /* if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 ) */
+
+/**
+ * @brief Get the timer age in milliseconds.
+ *
+ * @param[in] pxTimer The timer whose age is to be fetched.
+ *
+ * @return The time in milliseconds since the timer was born.
+ */
+        static portINLINE uint32_t ulTimerGetAge( const TCPTimer_t * pxTimer )
+        {
+            TickType_t uxNow = xTaskGetTickCount();
+            TickType_t uxDiff = uxNow - pxTimer->uxBorn;
+
+            return ( uint32_t ) ( uxDiff * portTICK_PERIOD_MS );
+        }
+
+    #endif /* if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+
+/**
+ * @brief Get the clock of the TCP time-stamps option ( TSval ).
+ *
+ * @return The time in milliseconds since the scheduler started. It wraps
+ *         around like any TCP time-stamp clock.
+ */
+        uint32_t ulTCPWindowTimeStamp( void )
+        {
+            TickType_t uxNow = xTaskGetTickCount();
+
+            return ( uint32_t ) ( uxNow * portTICK_PERIOD_MS );
+        }
+    #endif /* ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 )
+
+/**
+ * @brief Add an event to the binary log of a window.  The oldest event is
+ *        overwritten when the log is full.
+ *
+ * @param[in] pxWindow The window of the connection.
+ * @param[in] eEvent The event, see eTCPWinEvent_t.
+ * @param[in] ulSequenceNumber An absolute sequence number of the outgoing stream.
+ * @param[in] ulValue Depends on the event.
+ * @param[in] ucCount Depends on the event.
+ */
+        void vTCPWindowLogEvent( TCPWindow_t * pxWindow,
+                                 eTCPWinEvent_t eEvent,
+                                 uint32_t ulSequenceNumber,
+                                 uint32_t ulValue,
+                                 uint8_t ucCount )
+        {
+            TCPWinEvent_t * pxEvent;
+
+            pxEvent = &( pxWindow->xEventLog[ pxWindow->ulEventLogCount & ( ( uint32_t ) ipconfigTCP_WIN_EVENT_LOG_ENTRIES - 1U ) ] );
+            pxWindow->ulEventLogCount++;
+
+            pxEvent->ulTime = ipconfigTCP_WIN_EVENT_LOG_TIME_US();
+            pxEvent->ulSequenceNumber = ulSequenceNumber - pxWindow->tx.ulFirstSequenceNumber;
+            pxEvent->ulValue = ulValue;
+            pxEvent->ucEvent = ( uint8_t ) eEvent;
+            pxEvent->ucCount = ucCount;
+            pxEvent->usOurPortNumber = pxWindow->usOurPortNumber;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Copy the most recent events of a window, the oldest first.  The
+ *        caller must make sure that the IP-task does not change the log
+ *        while it is copied.
+ *
+ * @param[in] pxWindow The window of the connection.
+ * @param[out] pxEvents Where the events are copied to.
+ * @param[in] uxMaxEvents The number of events that fit in pxEvents.
+ *
+ * @return The number of events copied.
+ */
+        size_t uxTCPWindowGetEventLog( const TCPWindow_t * pxWindow,
+                                       TCPWinEvent_t * pxEvents,
+                                       size_t uxMaxEvents )
+        {
+            uint32_t ulCount = FreeRTOS_min_uint32( pxWindow->ulEventLogCount, ( uint32_t ) ipconfigTCP_WIN_EVENT_LOG_ENTRIES );
+            uint32_t ulIndex;
+            size_t uxCopied;
+
+            ulCount = FreeRTOS_min_uint32( ulCount, ( uint32_t ) uxMaxEvents );
+            ulIndex = pxWindow->ulEventLogCount - ulCount;
+
+            for( uxCopied = 0U; uxCopied < ( size_t ) ulCount; uxCopied++ )
+            {
+                pxEvents[ uxCopied ] = pxWindow->xEventLog[ ulIndex & ( ( uint32_t ) ipconfigTCP_WIN_EVENT_LOG_ENTRIES - 1U ) ];
+                ulIndex++;
+            }
+
+            return uxCopied;
+        }
+    #endif /* ipconfigUSE_TCP_WIN_EVENT_LOG != 0 */
 /*-----------------------------------------------------------*/
 
 /**
@@ -385,7 +809,7 @@
  * @param[in] pxNewListItem The item to be inserted.
  * @param[in] pxWhere Where should the item be inserted.
  */
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS == 0 ) )
         static void vListInsertGeneric( List_t * const pxList,
                                         ListItem_t * const pxNewListItem,
                                         MiniListItem_t * pxWhere )
@@ -408,10 +832,10 @@
 
             ( pxList->uxNumberOfItems )++;
         }
-    #endif /* if ( ipconfigUSE_TCP_WIN == 1 ) */
+    #endif /* if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS == 0 ) ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_SEG_CHUNK_COUNT == 0 ) )
 
 /**
  * @brief Creates a pool of 'ipconfigTCP_WIN_SEG_COUNT' sector buffers. Should be called once only.
@@ -425,7 +849,7 @@
 
             /* Allocate space for 'xTCPSegments' and store them in 'xSegmentList'. */
 
-            vListInitialise( &xSegmentList );
+            tcpwinLIST_INITIALISE( &xSegmentList, xSegmentItem );
             xTCPSegments = ( ( TCPSegment_t * ) pvPortMallocLarge( ( size_t ) ipconfigTCP_WIN_SEG_COUNT * sizeof( xTCPSegments[ 0 ] ) ) );
 
             if( xTCPSegments == NULL )
@@ -437,26 +861,32 @@
             }
             else
             {
+                ipRESOURCE_ALLOC( eResourceSegments, ( size_t ) ipconfigTCP_WIN_SEG_COUNT * sizeof( xTCPSegments[ 0 ] ) );
+
                 /* Clear the allocated space. */
                 ( void ) memset( xTCPSegments, 0, ( size_t ) ipconfigTCP_WIN_SEG_COUNT * sizeof( xTCPSegments[ 0 ] ) );
 
                 for( xIndex = 0; xIndex < ipconfigTCP_WIN_SEG_COUNT; xIndex++ )
                 {
-                    /* Could call vListInitialiseItem here but all data has been
-                    * nulled already.  Set the owner to a segment descriptor. */
-
-                    #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
+                    #if ( ipconfigTCP_WIN_COMPACT_SEGMENTS == 0 )
                     {
-                        vListInitialiseItem( &( xTCPSegments[ xIndex ].xSegmentItem ) );
-                        vListInitialiseItem( &( xTCPSegments[ xIndex ].xQueueItem ) );
-                    }
-                    #endif
+                        /* Could call vListInitialiseItem here but all data has been
+                        * nulled already.  Set the owner to a segment descriptor. */
+
+                        #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
+                        {
+                            vListInitialiseItem( &( xTCPSegments[ xIndex ].xSegmentItem ) );
+                            vListInitialiseItem( &( xTCPSegments[ xIndex ].xQueueItem ) );
+                        }
+                        #endif
 
-                    listSET_LIST_ITEM_OWNER( &( xTCPSegments[ xIndex ].xSegmentItem ), ( void * ) &( xTCPSegments[ xIndex ] ) );
-                    listSET_LIST_ITEM_OWNER( &( xTCPSegments[ xIndex ].xQueueItem ), ( void * ) &( xTCPSegments[ xIndex ] ) );
+                        listSET_LIST_ITEM_OWNER( &( xTCPSegments[ xIndex ].xSegmentItem ), ( void * ) &( xTCPSegments[ xIndex ] ) );
+                        listSET_LIST_ITEM_OWNER( &( xTCPSegments[ xIndex ].xQueueItem ), ( void * ) &( xTCPSegments[ xIndex ] ) );
+                    }
+                    #endif /* if ( ipconfigTCP_WIN_COMPACT_SEGMENTS == 0 ) */
 
                     /* And add it to the pool of available segments */
-                    vListInsertFifo( &xSegmentList, &( xTCPSegments[ xIndex ].xSegmentItem ) );
+                    tcpwinLIST_INSERT_FIFO( &xSegmentList, &( xTCPSegments[ xIndex ].xSegmentItem ) );
                 }
 
                 xReturn = pdPASS;
@@ -464,61 +894,178 @@
 
             return xReturn;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 1 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_SEG_CHUNK_COUNT == 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 ) )
 
 /**
- * @brief Find a segment with a given sequence number in the list of received segments.
- *
- * @param[in] pxWindow The descriptor of the TCP sliding windows.
- * @param[in] ulSequenceNumber the sequence number to look-up
+ * @brief Let the pool grow with a chunk of 'ipconfigTCP_WIN_SEG_CHUNK_COUNT'
+ *        sector buffers, as long as the pool holds less than
+ *        'ipconfigTCP_WIN_SEG_COUNT' of them.
  *
- * @return The address of the segment descriptor found, or NULL when not found.
+ * @return When the allocation was successful: pdPASS, otherwise pdFAIL.
  */
-        static TCPSegment_t * xTCPWindowRxFind( const TCPWindow_t * pxWindow,
-                                                uint32_t ulSequenceNumber )
+        static BaseType_t prvCreateSectors( void )
         {
-            const ListItem_t * pxIterator;
-            const ListItem_t * pxEnd;
-            TCPSegment_t * pxSegment, * pxReturn = NULL;
-
-            /* Find a segment with a given sequence number in the list of received
-             * segments. */
+            BaseType_t xIndex;
+            BaseType_t xReturn = pdFAIL;
+            TCPSegmentChunk_t * pxChunk;
+            TCPSegment_t * pxSegment;
 
-            /* MISRA Ref 11.3.1 [Misaligned access] */
-/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-            /* coverity[misra_c_2012_rule_11_3_violation] */
-            pxEnd = ( ( const ListItem_t * ) &( pxWindow->xRxSegments.xListEnd ) );
+            if( tcpwinLIST_IS_INITIALISED( &xSegmentList ) == pdFALSE )
+            {
+                tcpwinLIST_INITIALISE( &xSegmentList, xSegmentItem );
+            }
 
-            for( pxIterator = listGET_NEXT( pxEnd );
-                 pxIterator != pxEnd;
-                 pxIterator = listGET_NEXT( pxIterator ) )
+            if( uxSegmentChunkCount >= ( UBaseType_t ) ( ipconfigTCP_WIN_SEG_COUNT / ipconfigTCP_WIN_SEG_CHUNK_COUNT ) )
+            {
+                /* The pool has reached its maximum size. */
+            }
+            else if( xSocketMemoryCharge( sizeof( *pxChunk ) ) == pdFAIL )
+            {
+                /* The chunk does not fit in the memory budget of the sockets. */
+            }
+            else
             {
-                pxSegment = ( ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                pxChunk = ( ( TCPSegmentChunk_t * ) pvPortMallocLarge( sizeof( *pxChunk ) ) );
 
-                if( pxSegment->ulSequenceNumber == ulSequenceNumber )
+                if( pxChunk == NULL )
                 {
-                    pxReturn = pxSegment;
-                    break;
+                    FreeRTOS_debug_printf( ( "prvCreateSectors: malloc %u failed\n",
+                                             ( unsigned ) sizeof( *pxChunk ) ) );
+                    vSocketMemoryRelease( sizeof( *pxChunk ) );
+                }
+                else
+                {
+                    ipRESOURCE_ALLOC( eResourceSegments, sizeof( *pxChunk ) );
+
+                    /* Clear the allocated space. */
+                    ( void ) memset( pxChunk, 0, sizeof( *pxChunk ) );
+
+                    for( xIndex = 0; xIndex < ipconfigTCP_WIN_SEG_CHUNK_COUNT; xIndex++ )
+                    {
+                        pxSegment = &( pxChunk->xSegments[ xIndex ] );
+
+                        #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
+                        {
+                            vListInitialiseItem( &( pxSegment->xSegmentItem ) );
+                            vListInitialiseItem( &( pxSegment->xQueueItem ) );
+                        }
+                        #endif
+
+                        listSET_LIST_ITEM_OWNER( &( pxSegment->xSegmentItem ), ( void * ) pxSegment );
+                        listSET_LIST_ITEM_OWNER( &( pxSegment->xQueueItem ), ( void * ) pxSegment );
+                        pxSegment->pxChunk = pxChunk;
+
+                        /* And add it to the pool of available segments */
+                        tcpwinLIST_INSERT_FIFO( &xSegmentList, &( pxSegment->xSegmentItem ) );
+                    }
+
+                    pxChunk->pxNext = pxSegmentChunks;
+                    pxSegmentChunks = pxChunk;
+                    uxSegmentChunkCount++;
+
+                    xReturn = pdPASS;
                 }
             }
 
-            return pxReturn;
+            return xReturn;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 1 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 ) )
 
 /**
- * @brief Allocate a new segment object, either for transmission or reception.
+ * @brief None of the descriptors of a chunk are in use.  Return the chunk to
+ *        the heap, unless it is the only chunk, or the other chunks have less
+ *        than half a chunk of free descriptors.
  *
- * @param[in] pxWindow The descriptor of the TCP sliding windows.
- * @param[in] ulSequenceNumber The sequence number.
- * @param[in] lCount The number of bytes stored in this segment.
- * @param[in] xIsForRx True when this is a reception segment.
+ * @param[in] pxChunk The chunk that has become idle.
+ */
+        static void prvReleaseSectors( struct xTCP_SEGMENT_CHUNK * pxChunk )
+        {
+            BaseType_t xIndex;
+            TCPSegmentChunk_t ** ppxLink;
+            UBaseType_t uxOtherFree = tcpwinLIST_LENGTH( &xSegmentList ) - ( UBaseType_t ) ipconfigTCP_WIN_SEG_CHUNK_COUNT;
+
+            if( ( uxSegmentChunkCount > 1U ) && ( uxOtherFree >= ( ( UBaseType_t ) ipconfigTCP_WIN_SEG_CHUNK_COUNT / 2U ) ) )
+            {
+                /* Take all descriptors out of xSegmentList. */
+                for( xIndex = 0; xIndex < ipconfigTCP_WIN_SEG_CHUNK_COUNT; xIndex++ )
+                {
+                    ( void ) tcpwinLIST_REMOVE( &( pxChunk->xSegments[ xIndex ].xSegmentItem ) );
+                }
+
+                /* Unlink the chunk from the pool. */
+                for( ppxLink = &pxSegmentChunks; *ppxLink != pxChunk; ppxLink = &( ( *ppxLink )->pxNext ) )
+                {
+                }
+
+                *ppxLink = pxChunk->pxNext;
+                uxSegmentChunkCount--;
+
+                ipRESOURCE_FREE( eResourceSegments, sizeof( *pxChunk ) );
+                vSocketMemoryRelease( sizeof( *pxChunk ) );
+                vPortFreeLarge( pxChunk );
+            }
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) )
+
+/**
+ * @brief Find a segment with a given sequence number in the list of received segments.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] ulSequenceNumber the sequence number to look-up
+ *
+ * @return The address of the segment descriptor found, or NULL when not found.
+ */
+        static TCPSegment_t * xTCPWindowRxFind( const TCPWindow_t * pxWindow,
+                                                uint32_t ulSequenceNumber )
+        {
+            const TCPSegmentItem_t * pxIterator;
+            const TCPSegmentItem_t * pxEnd;
+            TCPSegment_t * pxSegment, * pxReturn = NULL;
+
+            /* Find a segment with a given sequence number in the list of received
+             * segments. */
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxEnd = tcpwinLIST_END( &( pxWindow->xRxSegments ) );
+
+            for( pxIterator = tcpwinLIST_NEXT( pxEnd );
+                 pxIterator != pxEnd;
+                 pxIterator = tcpwinLIST_NEXT( pxIterator ) )
+            {
+                pxSegment = ( ( TCPSegment_t * ) tcpwinLIST_OWNER( pxIterator ) );
+
+                if( pxSegment->ulSequenceNumber == ulSequenceNumber )
+                {
+                    pxReturn = pxSegment;
+                    break;
+                }
+            }
+
+            return pxReturn;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+
+/**
+ * @brief Allocate a new segment object, either for transmission or reception.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] ulSequenceNumber The sequence number.
+ * @param[in] lCount The number of bytes stored in this segment.
+ * @param[in] xIsForRx True when this is a reception segment.
  *
  * @return Allocate and initialise a segment descriptor, or NULL when none was available.
  */
@@ -528,38 +1075,80 @@
                                              BaseType_t xIsForRx )
         {
             TCPSegment_t * pxSegment;
-            ListItem_t * pxItem;
+            TCPSegmentItem_t * pxItem;
+            BaseType_t xLimitReached = pdFALSE;
+
+            #if ( ipconfigTCP_WIN_SEG_SOCKET_LIMIT != 0 )
+            {
+                /* The number of descriptors that this socket may borrow is limited. */
+                if( ( tcpwinLIST_LENGTH( &( pxWindow->xTxSegments ) ) + tcpwinLIST_LENGTH( &( pxWindow->xRxSegments ) ) ) >=
+                    ( UBaseType_t ) ipconfigTCP_WIN_SEG_SOCKET_LIMIT )
+                {
+                    xLimitReached = pdTRUE;
+                }
+            }
+            #endif
+
+            #if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 )
+            {
+                if( ( xLimitReached == pdFALSE ) && ( tcpwinLIST_IS_EMPTY( &xSegmentList ) != pdFALSE ) )
+                {
+                    /* Let the pool grow. */
+                    ( void ) prvCreateSectors();
+                }
+            }
+            #endif
 
             /* Allocate a new segment.  The socket will borrow all segments from a
              * common pool: 'xSegmentList', which is a list of 'TCPSegment_t' */
-            if( listLIST_IS_EMPTY( &xSegmentList ) != pdFALSE )
+            if( xLimitReached != pdFALSE )
+            {
+                FreeRTOS_debug_printf( ( "xTCPWindow%cxNew: Error: socket has %u segments\n",
+                                         ( xIsForRx != 0 ) ? 'R' : 'T',
+                                         ( unsigned ) ipconfigTCP_WIN_SEG_SOCKET_LIMIT ) );
+                pxSegment = NULL;
+            }
+            else if( tcpwinLIST_IS_EMPTY( &xSegmentList ) != pdFALSE )
             {
                 /* If the TCP-stack runs out of segments, you might consider
                  * increasing 'ipconfigTCP_WIN_SEG_COUNT'. */
                 FreeRTOS_debug_printf( ( "xTCPWindow%cxNew: Error: all segments occupied\n", ( xIsForRx != 0 ) ? 'R' : 'T' ) );
+                ipRESOURCE_SHORTAGE( eShortageTCPSegments );
                 pxSegment = NULL;
             }
             else
             {
                 /* Pop the item at the head of the list.  Semaphore protection is
                 * not required as only the IP task will call these functions.  */
-                pxItem = ( ListItem_t * ) listGET_HEAD_ENTRY( &xSegmentList );
-                pxSegment = ( ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxItem ) );
+                pxItem = ( TCPSegmentItem_t * ) tcpwinLIST_HEAD( &xSegmentList );
+                pxSegment = ( ( TCPSegment_t * ) tcpwinLIST_OWNER( pxItem ) );
 
                 configASSERT( pxItem != NULL );
                 configASSERT( pxSegment != NULL );
 
                 /* Remove the item from xSegmentList. */
-                ( void ) uxListRemove( pxItem );
+                ( void ) tcpwinLIST_REMOVE( pxItem );
+
+                #if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 )
+                {
+                    pxSegment->pxChunk->uxUsed++;
+                }
+                #endif
 
                 /* Add it to either the connections' Rx or Tx queue. */
                 if( xIsForRx != 0 )
                 {
-                    vListInsertFifo( &pxWindow->xRxSegments, pxItem );
+                    tcpwinLIST_INSERT_FIFO( &pxWindow->xRxSegments, pxItem );
                 }
                 else
                 {
-                    vListInsertFifo( &pxWindow->xTxSegments, pxItem );
+                    tcpwinLIST_INSERT_FIFO( &pxWindow->xTxSegments, pxItem );
+
+                    #if ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 )
+                    {
+                        prvTCPWindowTxIndexAdd( pxWindow, pxSegment );
+                    }
+                    #endif
                 }
 
                 /* And set the segment's timer to zero */
@@ -570,10 +1159,21 @@
                 pxSegment->lMaxLength = lCount;
                 pxSegment->lDataLength = lCount;
                 pxSegment->ulSequenceNumber = ulSequenceNumber;
+                #if ( ipconfigUSE_RESOURCE_STATS != 0 )
+                {
+                    UBaseType_t uxInUse = prvTCPWindowSegmentsAllocated() - tcpwinLIST_LENGTH( &xSegmentList );
+
+                    if( uxSegmentsPeak < uxInUse )
+                    {
+                        uxSegmentsPeak = uxInUse;
+                    }
+                }
+                #endif
+
                 #if ( ipconfigHAS_DEBUG_PRINTF != 0 )
                 {
                     static UBaseType_t xLowestLength = ipconfigTCP_WIN_SEG_COUNT;
-                    UBaseType_t xLength = listCURRENT_LIST_LENGTH( &xSegmentList );
+                    UBaseType_t xLength = tcpwinLIST_LENGTH( &xSegmentList );
 
                     if( xLowestLength > xLength )
                     {
@@ -601,12 +1201,18 @@
         {
             BaseType_t xReturn;
 
+            #if ( ipconfigTCP_RX_INTERVAL_COUNT != 0 )
+                BaseType_t xHasStoredData = ( pxWindow->uxRxIntervalCount != 0U ) ? pdTRUE : pdFALSE;
+            #else
+                BaseType_t xHasStoredData = ( tcpwinLIST_IS_EMPTY( ( &pxWindow->xRxSegments ) ) == pdFALSE ) ? pdTRUE : pdFALSE;
+            #endif
+
             /* When the peer has a close request (FIN flag), the driver will check
              * if there are missing packets in the Rx-queue.  It will accept the
              * closure of the connection if both conditions are true:
              * - the Rx-queue is empty
              * - the highest Rx sequence number has been ACK'ed */
-            if( listLIST_IS_EMPTY( ( &pxWindow->xRxSegments ) ) == pdFALSE )
+            if( xHasStoredData != pdFALSE )
             {
                 /* Rx data has been stored while earlier packets were missing. */
                 xReturn = pdFALSE;
@@ -639,22 +1245,22 @@
  *
  * @return The address of the segment descriptor, or NULL when not found.
  */
-        static TCPSegment_t * xTCPWindowGetHead( const List_t * pxList )
+        static TCPSegment_t * xTCPWindowGetHead( const TCPSegmentList_t * pxList )
         {
             TCPSegment_t * pxSegment;
-            ListItem_t * pxItem;
+            TCPSegmentItem_t * pxItem;
 
             /* Detaches and returns the head of a queue. */
-            if( listLIST_IS_EMPTY( pxList ) != pdFALSE )
+            if( tcpwinLIST_IS_EMPTY( pxList ) != pdFALSE )
             {
                 pxSegment = NULL;
             }
             else
             {
-                pxItem = ( ListItem_t * ) listGET_HEAD_ENTRY( pxList );
-                pxSegment = ( ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxItem ) );
+                pxItem = ( TCPSegmentItem_t * ) tcpwinLIST_HEAD( pxList );
+                pxSegment = ( ( TCPSegment_t * ) tcpwinLIST_OWNER( pxItem ) );
 
-                ( void ) uxListRemove( pxItem );
+                ( void ) tcpwinLIST_REMOVE( pxItem );
             }
 
             return pxSegment;
@@ -671,20 +1277,20 @@
  *
  * @return The address of the segment descriptor, or NULL when the list is empty.
  */
-        static TCPSegment_t * xTCPWindowPeekHead( const List_t * pxList )
+        static TCPSegment_t * xTCPWindowPeekHead( const TCPSegmentList_t * pxList )
         {
-            const ListItem_t * pxItem;
+            const TCPSegmentItem_t * pxItem;
             TCPSegment_t * pxReturn;
 
             /* Returns the head of a queue but it won't be detached. */
-            if( listLIST_IS_EMPTY( pxList ) != pdFALSE )
+            if( tcpwinLIST_IS_EMPTY( pxList ) != pdFALSE )
             {
                 pxReturn = NULL;
             }
             else
             {
-                pxItem = ( ListItem_t * ) listGET_HEAD_ENTRY( pxList );
-                pxReturn = ( ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxItem ) );
+                pxItem = ( TCPSegmentItem_t * ) tcpwinLIST_HEAD( pxList );
+                pxReturn = ( ( TCPSegment_t * ) tcpwinLIST_OWNER( pxItem ) );
             }
 
             return pxReturn;
@@ -705,9 +1311,9 @@
              * will be passed back to the segment pool.
              *
              * Unlink it from one of the queues, if any. */
-            if( listLIST_ITEM_CONTAINER( &( pxSegment->xQueueItem ) ) != NULL )
+            if( tcpwinLIST_CONTAINER( &( pxSegment->xQueueItem ) ) != NULL )
             {
-                ( void ) uxListRemove( &( pxSegment->xQueueItem ) );
+                ( void ) tcpwinLIST_REMOVE( &( pxSegment->xQueueItem ) );
             }
 
             pxSegment->ulSequenceNumber = 0U;
@@ -715,13 +1321,24 @@
             pxSegment->u.ulFlags = 0U;
 
             /* Take it out of xRxSegments/xTxSegments */
-            if( listLIST_ITEM_CONTAINER( &( pxSegment->xSegmentItem ) ) != NULL )
+            if( tcpwinLIST_CONTAINER( &( pxSegment->xSegmentItem ) ) != NULL )
             {
-                ( void ) uxListRemove( &( pxSegment->xSegmentItem ) );
+                ( void ) tcpwinLIST_REMOVE( &( pxSegment->xSegmentItem ) );
             }
 
             /* Return it to xSegmentList */
-            vListInsertFifo( &xSegmentList, &( pxSegment->xSegmentItem ) );
+            tcpwinLIST_INSERT_FIFO( &xSegmentList, &( pxSegment->xSegmentItem ) );
+
+            #if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 )
+            {
+                pxSegment->pxChunk->uxUsed--;
+
+                if( pxSegment->pxChunk->uxUsed == 0U )
+                {
+                    prvReleaseSectors( pxSegment->pxChunk );
+                }
+            }
+            #endif
         }
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
@@ -735,7 +1352,7 @@
  */
         void vTCPWindowDestroy( TCPWindow_t const * pxWindow )
         {
-            const List_t * pxSegments;
+            const TCPSegmentList_t * pxSegments;
             BaseType_t xRound;
             TCPSegment_t * pxSegment;
 
@@ -754,11 +1371,11 @@
                     pxSegments = &( pxWindow->xTxSegments );
                 }
 
-                if( listLIST_IS_INITIALISED( pxSegments ) )
+                if( tcpwinLIST_IS_INITIALISED( pxSegments ) )
                 {
-                    while( listCURRENT_LIST_LENGTH( pxSegments ) > 0U )
+                    while( tcpwinLIST_LENGTH( pxSegments ) > 0U )
                     {
-                        pxSegment = ( ( TCPSegment_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSegments ) );
+                        pxSegment = ( ( TCPSegment_t * ) tcpwinLIST_OWNER_OF_HEAD( pxSegments ) );
                         vTCPWindowFree( pxSegment );
                     }
                 }
@@ -790,17 +1407,42 @@
 
         #if ( ipconfigUSE_TCP_WIN == 1 )
         {
-            if( xTCPSegments == NULL )
+            #if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 )
+                if( pxSegmentChunks == NULL )
+            #else
+                if( xTCPSegments == NULL )
+            #endif
             {
                 xReturn = prvCreateSectors();
             }
 
-            vListInitialise( &( pxWindow->xTxSegments ) );
-            vListInitialise( &( pxWindow->xRxSegments ) );
+            tcpwinLIST_INITIALISE( &( pxWindow->xTxSegments ), xSegmentItem );
+            tcpwinLIST_INITIALISE( &( pxWindow->xRxSegments ), xSegmentItem );
+
+            #if ( ipconfigTCP_RX_INTERVAL_COUNT != 0 )
+            {
+                pxWindow->uxRxIntervalCount = 0U;
+            }
+            #endif
+
+            #if ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 )
+            {
+                pxWindow->uxTxIndexHead = 0U;
+                pxWindow->uxTxIndexCount = 0U;
+                pxWindow->xTxIndexOverflow = pdFALSE;
+            }
+            #endif
+
+            tcpwinLIST_INITIALISE( &( pxWindow->xPriorityQueue ), xQueueItem ); /* Priority queue: segments which must be sent immediately */
+            tcpwinLIST_INITIALISE( &( pxWindow->xTxQueue ), xQueueItem );       /* Transmit queue: segments queued for transmission */
+            tcpwinLIST_INITIALISE( &( pxWindow->xWaitQueue ), xQueueItem );     /* Waiting queue:  outstanding segments */
 
-            vListInitialise( &( pxWindow->xPriorityQueue ) ); /* Priority queue: segments which must be sent immediately */
-            vListInitialise( &( pxWindow->xTxQueue ) );       /* Transmit queue: segments queued for transmission */
-            vListInitialise( &( pxWindow->xWaitQueue ) );     /* Waiting queue:  outstanding segments */
+            #if ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 )
+            {
+                /* A new connection starts with an empty log. */
+                pxWindow->ulEventLogCount = 0U;
+            }
+            #endif
         }
         #endif /* ipconfigUSE_TCP_WIN == 1 */
 
@@ -851,7 +1493,16 @@
             }
         }
 
-        #if ( ipconfigUSE_TCP_WIN == 0 )
+        #if ( ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT > 1 ) )
+        {
+            UBaseType_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigTCP_TINY_TX_SEGMENT_COUNT; uxIndex++ )
+            {
+                pxWindow->xTxSegments[ uxIndex ].lMaxLength = ( int32_t ) pxWindow->usMSS;
+            }
+        }
+        #elif ( ipconfigUSE_TCP_WIN == 0 )
         {
             pxWindow->xTxSegment.lMaxLength = ( int32_t ) pxWindow->usMSS;
         }
@@ -860,6 +1511,12 @@
         /*Start with a timeout of 2 * 500 ms (1 sec). */
         pxWindow->lSRTT = l500ms;
 
+        #if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 )
+        {
+            pxWindow->lSRTTus = l500ms * 1000;
+        }
+        #endif
+
         /* Just for logging, to print relative sequence numbers. */
         pxWindow->rx.ulFirstSequenceNumber = ulAckNumber;
 
@@ -881,6 +1538,25 @@
         /* The right-hand side of the transmit window. */
         pxWindow->tx.ulHighestSequenceNumber = ulSequenceNumber;
         pxWindow->ulOurSequenceNumber = ulSequenceNumber;
+
+        #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) )
+        {
+            if( pxWindow->xCongestion.pxControl == NULL )
+            {
+                pxWindow->xCongestion.pxControl = &xTCPCongestionNewReno;
+            }
+
+            pxWindow->xCongestion.ulBytesAcked = 0U;
+            pxWindow->xCongestion.xInRecovery = pdFALSE;
+            pxWindow->xCongestion.pxControl->fnInit( pxWindow );
+        }
+        #endif
+
+        #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) )
+        {
+            ( void ) memset( &( pxWindow->xRack ), 0, sizeof( pxWindow->xRack ) );
+        }
+        #endif
     }
 /*-----------------------------------------------------------*/
 
@@ -894,15 +1570,90 @@
             /* Free and clear the TCP segments pointer. This function should only be called
              * once FreeRTOS+TCP will no longer be used. No thread-safety is provided for this
              * function. */
-            if( xTCPSegments != NULL )
+            #if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 )
+            {
+                TCPSegmentChunk_t * pxChunk;
+
+                while( pxSegmentChunks != NULL )
+                {
+                    pxChunk = pxSegmentChunks;
+                    pxSegmentChunks = pxChunk->pxNext;
+                    ipRESOURCE_FREE( eResourceSegments, sizeof( *pxChunk ) );
+                    vSocketMemoryRelease( sizeof( *pxChunk ) );
+                    vPortFreeLarge( pxChunk );
+                }
+
+                uxSegmentChunkCount = 0U;
+                tcpwinLIST_INITIALISE( &xSegmentList, xSegmentItem );
+            }
+            #else
             {
-                vPortFreeLarge( xTCPSegments );
-                xTCPSegments = NULL;
+                if( xTCPSegments != NULL )
+                {
+                    ipRESOURCE_FREE( eResourceSegments, ( size_t ) ipconfigTCP_WIN_SEG_COUNT * sizeof( xTCPSegments[ 0 ] ) );
+                    vPortFreeLarge( xTCPSegments );
+                    xTCPSegments = NULL;
+                }
             }
+            #endif /* if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 ) */
         }
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
 
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_RESOURCE_STATS != 0 ) )
+
+/**
+ * @brief Get the number of segment descriptors that are allocated.
+ *
+ * @return The size of the pool, free or borrowed.
+ */
+        static UBaseType_t prvTCPWindowSegmentsAllocated( void )
+        {
+            UBaseType_t uxCount;
+
+            #if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 )
+            {
+                uxCount = uxSegmentChunkCount * ( UBaseType_t ) ipconfigTCP_WIN_SEG_CHUNK_COUNT;
+            }
+            #else
+            {
+                uxCount = ( xTCPSegments != NULL ) ? ( UBaseType_t ) ipconfigTCP_WIN_SEG_COUNT : 0U;
+            }
+            #endif
+
+            return uxCount;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the use of the segment descriptors, see ipconfigUSE_RESOURCE_STATS.
+ *
+ * @param[out] pxUsage Where the use will be written.
+ * @param[in] xResetPeak When true, the peak is set to the current use.
+ */
+        void vTCPWindowGetSegmentUsage( IPResourceUsage_t * pxUsage,
+                                        BaseType_t xResetPeak )
+        {
+            UBaseType_t uxAllocated = prvTCPWindowSegmentsAllocated();
+
+            pxUsage->uxTotal = ( size_t ) ipconfigTCP_WIN_SEG_COUNT;
+            pxUsage->uxUsed = 0U;
+
+            if( uxAllocated != 0U )
+            {
+                pxUsage->uxUsed = ( size_t ) ( uxAllocated - tcpwinLIST_LENGTH( &xSegmentList ) );
+            }
+
+            if( xResetPeak != pdFALSE )
+            {
+                uxSegmentsPeak = ( UBaseType_t ) pxUsage->uxUsed;
+            }
+
+            pxUsage->uxPeak = ( size_t ) uxSegmentsPeak;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_RESOURCE_STATS != 0 ) */
+/*-----------------------------------------------------------*/
+
 /*=============================================================================
  *
  *                ######        #    #
@@ -918,7 +1669,7 @@
  *
  *=============================================================================*/
 
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) )
 
 /**
  * @brief A expected segment has been received, see if there is overlap with earlier segments.
@@ -934,13 +1685,13 @@
                                                    uint32_t ulLength )
         {
             TCPSegment_t * pxBest = NULL;
-            const ListItem_t * pxIterator;
+            const TCPSegmentItem_t * pxIterator;
             uint32_t ulNextSequenceNumber = ulSequenceNumber + ulLength;
 
             /* MISRA Ref 11.3.1 [Misaligned access] */
 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
             /* coverity[misra_c_2012_rule_11_3_violation] */
-            const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( pxWindow->xRxSegments.xListEnd ) );
+            const TCPSegmentItem_t * pxEnd = tcpwinLIST_END( &( pxWindow->xRxSegments ) );
             TCPSegment_t * pxSegment;
 
             /* A segment has been received with sequence number 'ulSequenceNumber',
@@ -952,11 +1703,11 @@
              * '(ulSequenceNumber+ulLength)'. */
 
             /* Iterate through all RX segments that are stored: */
-            for( pxIterator = listGET_NEXT( pxEnd );
+            for( pxIterator = tcpwinLIST_NEXT( pxEnd );
                  pxIterator != pxEnd;
-                 pxIterator = listGET_NEXT( pxIterator ) )
+                 pxIterator = tcpwinLIST_NEXT( pxIterator ) )
             {
-                pxSegment = ( ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                pxSegment = ( ( TCPSegment_t * ) tcpwinLIST_OWNER( pxIterator ) );
 
                 /* And see if there is a segment for which:
                  * 'ulSequenceNumber' <= 'pxSegment->ulSequenceNumber' < 'ulNextSequenceNumber'
@@ -987,10 +1738,10 @@
 
             return pxBest;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 1 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) )
 
 /**
  * @brief Data has been received with the correct ( expected  ) sequence number.
@@ -1004,7 +1755,7 @@
             uint32_t ulSequenceNumber = pxWindow->rx.ulCurrentSequenceNumber;
             uint32_t ulCurrentSequenceNumber = ulSequenceNumber + ulLength;
 
-            if( listCURRENT_LIST_LENGTH( &( pxWindow->xRxSegments ) ) != 0U )
+            if( tcpwinLIST_LENGTH( &( pxWindow->xRxSegments ) ) != 0U )
             {
                 uint32_t ulSavedSequenceNumber = ulCurrentSequenceNumber;
                 TCPSegment_t * pxFound;
@@ -1056,17 +1807,17 @@
                                                  ( unsigned ) ( ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
                                                  ( unsigned ) pxWindow->ulUserDataLength,
                                                  ( unsigned ) ( ulSavedSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
-                                                 ( int ) listCURRENT_LIST_LENGTH( &pxWindow->xRxSegments ) ) );
+                                                 ( int ) tcpwinLIST_LENGTH( &pxWindow->xRxSegments ) ) );
                     }
                 }
             }
 
             pxWindow->rx.ulCurrentSequenceNumber = ulCurrentSequenceNumber;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 1 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) )
 
 /**
  * @brief Data has been received with a non-expected sequence number.
@@ -1161,7 +1912,7 @@
                                                  pxWindow->usPeerPortNumber,
                                                  pxWindow->usOurPortNumber,
                                                  ( unsigned ) ( ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
-                                                 ( unsigned ) listCURRENT_LIST_LENGTH( &pxWindow->xRxSegments ) ) );
+                                                 ( unsigned ) tcpwinLIST_LENGTH( &pxWindow->xRxSegments ) ) );
                     }
 
                     /* Return a positive value.  The packet may be accepted
@@ -1173,94 +1924,338 @@
 
             return lReturn;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 1 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT == 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 1 )
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT != 0 ) )
 
 /**
- * @brief Check what to do with a new incoming packet: store or ignore.
+ * @brief Find the first interval of out-of-order data which ends at or after
+ *        a given sequence number.
  *
  * @param[in] pxWindow The descriptor of the TCP sliding windows.
- * @param[in] ulSequenceNumber The sequence number of the packet received.
- * @param[in] ulLength The number of bytes received.
- * @param[in] ulSpace The available space in the RX stream buffer.
- * @param[out] pulSkipCount the number of bytes to skip in the receive buffer.
+ * @param[in] ulSequenceNumber The sequence number to look-up.
  *
- * @return 0 or positive value indicating the offset at which the packet is to
- *         be stored, -1 if the packet is to be ignored.
+ * @return The index of the interval, or uxRxIntervalCount when there is none.
  */
-        int32_t lTCPWindowRxCheck( TCPWindow_t * pxWindow,
-                                   uint32_t ulSequenceNumber,
-                                   uint32_t ulLength,
-                                   uint32_t ulSpace,
-                                   uint32_t * pulSkipCount )
+        static UBaseType_t prvTCPWindowRxIntervalSearch( const TCPWindow_t * pxWindow,
+                                                         uint32_t ulSequenceNumber )
         {
-            uint32_t ulCurrentSequenceNumber;
-            uint32_t ulIntermediateResult;
-            int32_t lReturn = -1;
-            int32_t lStartDistance;
-            int32_t lLastDistance;
-            uint32_t ulLast;
-            uint32_t ulRxSequenceNumber = ulSequenceNumber;
-            uint32_t ulRxLength = ulLength;
-
-            /* If lTCPWindowRxCheck( ) returns == 0, the packet will be passed
-             * directly to user (segment is expected).  If it returns a positive
-             * number, an earlier packet is missing, but this packet may be stored.
-             * If negative, the packet has already been stored, or it is out-of-order,
-             * or there is not enough space.
-             *
-             * As a side-effect, pxWindow->ulUserDataLength will get set to non-zero,
-             * if more Rx data may be passed to the user after this packet. */
-
-            /* Only in an exceptional case, where a packet starts before
-             * ulCurrentSequenceNumber, and ends after it, the skip-count
-             * will be set. See below. */
+            UBaseType_t uxLow = 0U;
+            UBaseType_t uxHigh = pxWindow->uxRxIntervalCount;
+            UBaseType_t uxMiddle;
 
-            *( pulSkipCount ) = 0U;
+            /* The intervals are sorted, and they do not overlap or touch each
+             * other. */
+            while( uxLow < uxHigh )
+            {
+                uxMiddle = uxLow + ( ( uxHigh - uxLow ) / 2U );
 
-            ulCurrentSequenceNumber = pxWindow->rx.ulCurrentSequenceNumber;
+                if( xSequenceLessThan( pxWindow->xRxIntervals[ uxMiddle ].ulLast, ulSequenceNumber ) != pdFALSE )
+                {
+                    uxLow = uxMiddle + 1U;
+                }
+                else
+                {
+                    uxHigh = uxMiddle;
+                }
+            }
 
-            ulLast = ulRxSequenceNumber + ulRxLength;
-            ulIntermediateResult = ulLast - ulCurrentSequenceNumber;
-            /* The cast from unsigned long to signed long is on purpose. */
-            lLastDistance = ( int32_t ) ulIntermediateResult;
+            return uxLow;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
 
-            ulIntermediateResult = ulRxSequenceNumber - ulCurrentSequenceNumber;
-            lStartDistance = ( int32_t ) ulIntermediateResult;
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT != 0 ) )
 
-            if( ( lStartDistance < 0 ) && ( lLastDistance > 0 ) )
+/**
+ * @brief Data has been received with the correct ( expected  ) sequence number.
+ *        It can be added to the RX stream buffer.  Intervals of out-of-order
+ *        data that are now contiguous will be passed to the user as well.
+ * @param[in] pxWindow The TCP sliding window data of the socket.
+ * @param[in] ulLength The number of bytes that can be added.
+ */
+        static void prvTCPWindowRx_ExpectedRX( TCPWindow_t * pxWindow,
+                                               uint32_t ulLength )
+        {
+            uint32_t ulSequenceNumber = pxWindow->rx.ulCurrentSequenceNumber;
+            uint32_t ulCurrentSequenceNumber = ulSequenceNumber + ulLength;
+            uint32_t ulSavedSequenceNumber = ulCurrentSequenceNumber;
+            TCPInterval_t * pxIntervals = pxWindow->xRxIntervals;
+            UBaseType_t uxCount = pxWindow->uxRxIntervalCount;
+            UBaseType_t uxIndex = 0U;
+
+            /* All intervals that start within the data received are either
+             * duplicates or they follow on it directly. */
+            while( ( uxIndex < uxCount ) &&
+                   ( xSequenceLessThanOrEqual( pxIntervals[ uxIndex ].ulFirst, ulCurrentSequenceNumber ) != pdFALSE ) )
             {
-                FreeRTOS_debug_printf( ( "lTCPWindowRxCheck: Received +%u bytes for %u, only using %d\n",
-                                         ( unsigned ) ulRxLength,
-                                         ( unsigned ) ( ulRxSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
-                                         ( int ) lLastDistance ) );
-                /* Increase the sequence number, decrease the length. */
-                ulRxSequenceNumber += ( uint32_t ) ( -lStartDistance );
-                ulRxLength += ( uint32_t ) lStartDistance;
+                if( xSequenceGreaterThan( pxIntervals[ uxIndex ].ulLast, ulCurrentSequenceNumber ) != pdFALSE )
+                {
+                    ulCurrentSequenceNumber = pxIntervals[ uxIndex ].ulLast;
+                }
 
-                /* Tell the caller that the first 'pulSkipCount' bytes don't
-                 * need to be stored. */
-                *( pulSkipCount ) = ( uint32_t ) ( -lStartDistance );
+                uxIndex++;
             }
 
-            /* For Selective Ack (SACK), used when out-of-sequence data come in. */
-            pxWindow->ucOptionLength = 0U;
-
-            /* Non-zero if TCP-windows contains data which must be popped. */
-            pxWindow->ulUserDataLength = 0U;
+            if( uxIndex != 0U )
+            {
+                /* Remove the intervals that have been passed to the user. */
+                uxCount -= uxIndex;
+                ( void ) memmove( pxIntervals, &( pxIntervals[ uxIndex ] ), ( size_t ) uxCount * sizeof( pxIntervals[ 0 ] ) );
+                pxWindow->uxRxIntervalCount = uxCount;
+            }
 
-            if( ulCurrentSequenceNumber == ulRxSequenceNumber )
+            if( ulSavedSequenceNumber != ulCurrentSequenceNumber )
             {
-                /* This is the packet with the lowest sequence number we're waiting
-                 * for.  It can be passed directly to the rx stream. */
-                if( ulRxLength > ulSpace )
+                /*  After the current data-package, there is more data
+                 * to be popped. */
+                pxWindow->ulUserDataLength = ulCurrentSequenceNumber - ulSavedSequenceNumber;
+
+                if( xTCPWindowLoggingLevel >= 1 )
                 {
-                    FreeRTOS_debug_printf( ( "lTCPWindowRxCheck: Refuse %u bytes, due to lack of space (%u)\n", ( unsigned ) ulRxLength, ( unsigned ) ulSpace ) );
+                    FreeRTOS_debug_printf( ( "lTCPWindowRxCheck[%u,%u]: retran %u (Found %u bytes at %u cnt %u)\n",
+                                             pxWindow->usPeerPortNumber,
+                                             pxWindow->usOurPortNumber,
+                                             ( unsigned ) ( ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
+                                             ( unsigned ) pxWindow->ulUserDataLength,
+                                             ( unsigned ) ( ulSavedSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
+                                             ( unsigned ) uxCount ) );
                 }
-                else
-                {
+            }
+
+            pxWindow->rx.ulCurrentSequenceNumber = ulCurrentSequenceNumber;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT != 0 ) )
+
+/**
+ * @brief Data has been received with a non-expected sequence number.
+ *        This function will check if the RX data can be accepted, and merge
+ *        it with the intervals of out-of-order data that it overlaps or
+ *        touches.
+ * @param[in] pxWindow The TCP sliding window data of the socket.
+ * @param[in] ulSequenceNumber The sequence number at which the data should be placed.
+ * @param[in] ulLength The number of bytes that can be added.
+ * @return Return -1 if the data must be refused, otherwise it returns the
+ *         offset ( from the head ) at which the data can be placed.
+ */
+        static int32_t prvTCPWindowRx_UnexpectedRX( TCPWindow_t * pxWindow,
+                                                    uint32_t ulSequenceNumber,
+                                                    uint32_t ulLength )
+        {
+            int32_t lReturn = -1;
+            uint32_t ulFirst = ulSequenceNumber;
+            uint32_t ulLast = ulSequenceNumber + ulLength;
+            uint32_t ulCurrentSequenceNumber = pxWindow->rx.ulCurrentSequenceNumber;
+            TCPInterval_t * pxIntervals = pxWindow->xRxIntervals;
+            UBaseType_t uxCount = pxWindow->uxRxIntervalCount;
+            UBaseType_t uxIndex;
+            UBaseType_t uxEnd;
+            BaseType_t xSendSack = pdTRUE;
+            uint32_t ulIntermediateResult;
+
+            uxIndex = prvTCPWindowRxIntervalSearch( pxWindow, ulFirst );
+
+            if( ( uxIndex < uxCount ) &&
+                ( xSequenceLessThanOrEqual( pxIntervals[ uxIndex ].ulFirst, ulFirst ) != pdFALSE ) &&
+                ( xSequenceGreaterThanOrEqual( pxIntervals[ uxIndex ].ulLast, ulLast ) != pdFALSE ) )
+            {
+                /* This out-of-sequence packet has been received for a
+                 * second time.  It is already stored but do send a SACK
+                 * again.  A negative value will be returned. */
+                ulFirst = pxIntervals[ uxIndex ].ulFirst;
+                ulLast = pxIntervals[ uxIndex ].ulLast;
+            }
+            else
+            {
+                /* Find the intervals that overlap or touch the new data, they
+                 * will be merged into a single interval. */
+                for( uxEnd = uxIndex; uxEnd < uxCount; uxEnd++ )
+                {
+                    if( xSequenceGreaterThan( pxIntervals[ uxEnd ].ulFirst, ulLast ) != pdFALSE )
+                    {
+                        break;
+                    }
+
+                    if( xSequenceLessThan( pxIntervals[ uxEnd ].ulFirst, ulFirst ) != pdFALSE )
+                    {
+                        ulFirst = pxIntervals[ uxEnd ].ulFirst;
+                    }
+
+                    if( xSequenceGreaterThan( pxIntervals[ uxEnd ].ulLast, ulLast ) != pdFALSE )
+                    {
+                        ulLast = pxIntervals[ uxEnd ].ulLast;
+                    }
+                }
+
+                if( uxEnd == uxIndex )
+                {
+                    /* A new hole is created, insert a new interval. */
+                    if( uxCount >= ( UBaseType_t ) ipconfigTCP_RX_INTERVAL_COUNT )
+                    {
+                        /* Can not send a SACK, because the data cannot be
+                         * administrated.  A negative value will be returned. */
+                        FreeRTOS_debug_printf( ( "lTCPWindowRxCheck: Error: all %u intervals occupied\n",
+                                                 ( unsigned ) uxCount ) );
+                        xSendSack = pdFALSE;
+                    }
+                    else
+                    {
+                        ( void ) memmove( &( pxIntervals[ uxIndex + 1U ] ), &( pxIntervals[ uxIndex ] ), ( size_t ) ( uxCount - uxIndex ) * sizeof( pxIntervals[ 0 ] ) );
+                        uxCount++;
+                    }
+                }
+                else if( uxEnd > ( uxIndex + 1U ) )
+                {
+                    /* The new data fills one or more holes. */
+                    ( void ) memmove( &( pxIntervals[ uxIndex + 1U ] ), &( pxIntervals[ uxEnd ] ), ( size_t ) ( uxCount - uxEnd ) * sizeof( pxIntervals[ 0 ] ) );
+                    uxCount -= uxEnd - ( uxIndex + 1U );
+                }
+                else
+                {
+                    /* The new data extends a single interval. */
+                }
+
+                if( xSendSack != pdFALSE )
+                {
+                    pxIntervals[ uxIndex ].ulFirst = ulFirst;
+                    pxIntervals[ uxIndex ].ulLast = ulLast;
+                    pxWindow->uxRxIntervalCount = uxCount;
+
+                    if( xTCPWindowLoggingLevel != 0 )
+                    {
+                        FreeRTOS_debug_printf( ( "lTCPWindowRxCheck[%u,%u]: seqnr %u (cnt %u)\n",
+                                                 pxWindow->usPeerPortNumber,
+                                                 pxWindow->usOurPortNumber,
+                                                 ( unsigned ) ( ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
+                                                 ( unsigned ) uxCount ) );
+                    }
+
+                    /* Return a positive value.  The packet may be accepted
+                    * and stored but an earlier packet is still missing. */
+                    ulIntermediateResult = ulSequenceNumber - ulCurrentSequenceNumber;
+                    lReturn = ( int32_t ) ulIntermediateResult;
+                }
+            }
+
+            if( xSendSack != pdFALSE )
+            {
+                if( xTCPWindowLoggingLevel >= 1 )
+                {
+                    FreeRTOS_debug_printf( ( "lTCPWindowRxCheck[%d,%d]: seqnr %u exp %u (dist %d) SACK %u to %u\n",
+                                             ( int ) pxWindow->usPeerPortNumber,
+                                             ( int ) pxWindow->usOurPortNumber,
+                                             ( unsigned ) ( ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
+                                             ( unsigned ) ( ulCurrentSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
+                                             ( int ) ( ulSequenceNumber - ulCurrentSequenceNumber ), /* want this signed */
+                                             ( unsigned ) ( ulFirst - pxWindow->rx.ulFirstSequenceNumber ),
+                                             ( unsigned ) ( ulLast - pxWindow->rx.ulFirstSequenceNumber ) ) );
+                }
+
+                /* The SACK describes the complete interval that contains the
+                 * data just received.
+                 * Code OPTION_CODE_SINGLE_SACK already in network byte order. */
+                pxWindow->ulOptionsData[ 0 ] = OPTION_CODE_SINGLE_SACK;
+                pxWindow->ulOptionsData[ 1 ] = FreeRTOS_htonl( ulFirst );
+                pxWindow->ulOptionsData[ 2 ] = FreeRTOS_htonl( ulLast );
+
+                /* Which make 12 (3*4) option bytes. */
+                pxWindow->ucOptionLength = ( uint8_t ) ( 3U * sizeof( pxWindow->ulOptionsData[ 0 ] ) );
+            }
+
+            return lReturn;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_RX_INTERVAL_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+
+/**
+ * @brief Check what to do with a new incoming packet: store or ignore.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] ulSequenceNumber The sequence number of the packet received.
+ * @param[in] ulLength The number of bytes received.
+ * @param[in] ulSpace The available space in the RX stream buffer.
+ * @param[out] pulSkipCount the number of bytes to skip in the receive buffer.
+ *
+ * @return 0 or positive value indicating the offset at which the packet is to
+ *         be stored, -1 if the packet is to be ignored.
+ */
+        int32_t lTCPWindowRxCheck( TCPWindow_t * pxWindow,
+                                   uint32_t ulSequenceNumber,
+                                   uint32_t ulLength,
+                                   uint32_t ulSpace,
+                                   uint32_t * pulSkipCount )
+        {
+            uint32_t ulCurrentSequenceNumber;
+            uint32_t ulIntermediateResult;
+            int32_t lReturn = -1;
+            int32_t lStartDistance;
+            int32_t lLastDistance;
+            uint32_t ulLast;
+            uint32_t ulRxSequenceNumber = ulSequenceNumber;
+            uint32_t ulRxLength = ulLength;
+
+            /* If lTCPWindowRxCheck( ) returns == 0, the packet will be passed
+             * directly to user (segment is expected).  If it returns a positive
+             * number, an earlier packet is missing, but this packet may be stored.
+             * If negative, the packet has already been stored, or it is out-of-order,
+             * or there is not enough space.
+             *
+             * As a side-effect, pxWindow->ulUserDataLength will get set to non-zero,
+             * if more Rx data may be passed to the user after this packet. */
+
+            /* Only in an exceptional case, where a packet starts before
+             * ulCurrentSequenceNumber, and ends after it, the skip-count
+             * will be set. See below. */
+
+            *( pulSkipCount ) = 0U;
+
+            ulCurrentSequenceNumber = pxWindow->rx.ulCurrentSequenceNumber;
+
+            ulLast = ulRxSequenceNumber + ulRxLength;
+            ulIntermediateResult = ulLast - ulCurrentSequenceNumber;
+            /* The cast from unsigned long to signed long is on purpose. */
+            lLastDistance = ( int32_t ) ulIntermediateResult;
+
+            ulIntermediateResult = ulRxSequenceNumber - ulCurrentSequenceNumber;
+            lStartDistance = ( int32_t ) ulIntermediateResult;
+
+            if( ( lStartDistance < 0 ) && ( lLastDistance > 0 ) )
+            {
+                FreeRTOS_debug_printf( ( "lTCPWindowRxCheck: Received +%u bytes for %u, only using %d\n",
+                                         ( unsigned ) ulRxLength,
+                                         ( unsigned ) ( ulRxSequenceNumber - pxWindow->rx.ulFirstSequenceNumber ),
+                                         ( int ) lLastDistance ) );
+                /* Increase the sequence number, decrease the length. */
+                ulRxSequenceNumber += ( uint32_t ) ( -lStartDistance );
+                ulRxLength += ( uint32_t ) lStartDistance;
+
+                /* Tell the caller that the first 'pulSkipCount' bytes don't
+                 * need to be stored. */
+                *( pulSkipCount ) = ( uint32_t ) ( -lStartDistance );
+            }
+
+            /* For Selective Ack (SACK), used when out-of-sequence data come in. */
+            pxWindow->ucOptionLength = 0U;
+
+            /* Non-zero if TCP-windows contains data which must be popped. */
+            pxWindow->ulUserDataLength = 0U;
+
+            if( ulCurrentSequenceNumber == ulRxSequenceNumber )
+            {
+                /* This is the packet with the lowest sequence number we're waiting
+                 * for.  It can be passed directly to the rx stream. */
+                if( ulRxLength > ulSpace )
+                {
+                    FreeRTOS_debug_printf( ( "lTCPWindowRxCheck: Refuse %u bytes, due to lack of space (%u)\n", ( unsigned ) ulRxLength, ( unsigned ) ulSpace ) );
+                }
+                else
+                {
                     /* Packet was expected, may be passed directly to the socket
                      * buffer or application.  Store the packet at offset 0. */
                     prvTCPWindowRx_ExpectedRX( pxWindow, ulRxLength );
@@ -1462,7 +2457,7 @@
                     lDone += lToWrite;
 
                     /* Link this segment in the Tx-Queue. */
-                    vListInsertFifo( &( pxWindow->xTxQueue ), &( pxSegment->xQueueItem ) );
+                    tcpwinLIST_INSERT_FIFO( &( pxWindow->xTxQueue ), &( pxSegment->xQueueItem ) );
 
                     /* Let 'pxHeadSegment' point to this segment if there is still
                      * space. */
@@ -1504,7 +2499,32 @@
  */
         BaseType_t xTCPWindowTxDone( const TCPWindow_t * pxWindow )
         {
-            return listLIST_IS_EMPTY( ( &pxWindow->xTxSegments ) );
+            return tcpwinLIST_IS_EMPTY( ( &pxWindow->xTxSegments ) );
+        }
+    #endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+
+/**
+ * @brief Get the time-out after which the oldest outstanding segment will be
+ *        retransmitted, like xTCPWindowTxHasData() calculates it.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ *
+ * @return The time-out in ms, or the SRTT when no segment is outstanding.
+ */
+        uint32_t ulTCPWindowTxTimeout( const TCPWindow_t * pxWindow )
+        {
+            const TCPSegment_t * pxSegment = xTCPWindowPeekHead( &( pxWindow->xWaitQueue ) );
+            uint32_t ulTimeout = ( uint32_t ) pxWindow->lSRTT;
+
+            if( pxSegment != NULL )
+            {
+                ulTimeout *= ( ( uint32_t ) 1U << pxSegment->u.bits.ucTransmitCount );
+            }
+
+            return ulTimeout;
         }
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
@@ -1527,6 +2547,13 @@
             const TCPSegment_t * pxSegment;
             uint32_t ulNettSize;
 
+            #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+                /* Never send more than the congestion window allows. */
+                const uint32_t ulSendWindow = FreeRTOS_min_uint32( ulWindowSize, pxWindow->xCongestion.ulWindow );
+            #else
+                const uint32_t ulSendWindow = ulWindowSize;
+            #endif
+
             /* This function will look if there is new transmission data.  It will
              * return true if there is data to be sent. */
 
@@ -1550,7 +2577,7 @@
                 }
 
                 /* Subtract this from the peer's space. */
-                ulNettSize = ulWindowSize - FreeRTOS_min_uint32( ulWindowSize, ulTxOutstanding );
+                ulNettSize = ulSendWindow - FreeRTOS_min_uint32( ulSendWindow, ulTxOutstanding );
 
                 /* See if the next segment may be sent. */
                 if( ulNettSize >= ( uint32_t ) pxSegment->lDataLength )
@@ -1600,7 +2627,7 @@
 
             *pulDelay = 0U;
 
-            if( listLIST_IS_EMPTY( &pxWindow->xPriorityQueue ) == pdFALSE )
+            if( tcpwinLIST_IS_EMPTY( &pxWindow->xPriorityQueue ) == pdFALSE )
             {
                 /* No need to look at retransmissions or new transmission as long as
                  * there are priority segments.  *pulDelay equals zero, meaning it must
@@ -1631,6 +2658,44 @@
                         *pulDelay = ulMaxAge - ulAge;
                     }
 
+                    #if ( ipconfigUSE_TCP_RACK_TLP != 0 )
+                    {
+                        const TCPSegmentItem_t * pxIterator;
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        const TCPSegmentItem_t * pxEnd = tcpwinLIST_END( &( pxWindow->xWaitQueue ) );
+                        const TCPSegment_t * pxOutstanding;
+                        TickType_t ulLeft;
+
+                        ulLeft = ( TickType_t ) prvTCPWindowTxProbeDelay( pxWindow );
+
+                        if( ulLeft > *pulDelay )
+                        {
+                            /* After a tail loss probe, the retransmission time-out
+                             * was restarted. */
+                            *pulDelay = ulLeft;
+                        }
+
+                        /* An outstanding segment may be declared lost by RACK
+                         * before its time-out. */
+                        for( pxIterator = tcpwinLIST_NEXT( pxEnd ); pxIterator != pxEnd; pxIterator = tcpwinLIST_NEXT( pxIterator ) )
+                        {
+                            pxOutstanding = ( ( const TCPSegment_t * ) tcpwinLIST_OWNER( pxIterator ) );
+
+                            if( pxOutstanding->u.bits.bAcked == pdFALSE_UNSIGNED )
+                            {
+                                ulLeft = ( TickType_t ) prvTCPRackTimeLeft( pxWindow, pxOutstanding );
+
+                                if( ulLeft < *pulDelay )
+                                {
+                                    *pulDelay = ulLeft;
+                                }
+                            }
+                        }
+                    }
+                    #endif /* ipconfigUSE_TCP_RACK_TLP != 0 */
+
                     xReturn = pdTRUE;
                 }
                 else
@@ -1677,7 +2742,7 @@
  *        be sent when their timer has expired.
  * @param[in] pxWindow The descriptor of the TCP sliding windows.
  */
-        static TCPSegment_t * pxTCPWindowTx_GetWaitQueue( const TCPWindow_t * pxWindow )
+        static TCPSegment_t * pxTCPWindowTx_GetWaitQueue( TCPWindow_t * pxWindow )
         {
             TCPSegment_t * pxSegment = xTCPWindowPeekHead( &( pxWindow->xWaitQueue ) );
 
@@ -1685,16 +2750,81 @@
             {
                 /* Do check the timing. */
                 uint32_t ulMaxTime;
+                BaseType_t xExpired;
 
                 ulMaxTime = ( ( uint32_t ) 1U ) << pxSegment->u.bits.ucTransmitCount;
                 ulMaxTime *= ( uint32_t ) pxWindow->lSRTT;
 
-                if( ulTimerGetAge( &pxSegment->xTransmitTimer ) > ulMaxTime )
+                xExpired = ( ulTimerGetAge( &pxSegment->xTransmitTimer ) > ulMaxTime ) ? pdTRUE : pdFALSE;
+
+                #if ( ipconfigUSE_TCP_RACK_TLP != 0 )
+                    if( prvTCPWindowTxProbeDelay( pxWindow ) != 0U )
+                    {
+                        /* A tail loss probe was sent, the retransmission
+                         * time-out was restarted. */
+                        xExpired = pdFALSE;
+                    }
+
+                    if( ( xExpired != pdFALSE ) &&
+                        ( pxSegment->u.bits.ucTransmitCount == 1U ) &&
+                        ( pxWindow->xRack.xProbing == pdFALSE ) )
+                    {
+                        /* Instead of the first time-out, send a tail loss probe:
+                         * retransmit the most recently sent segment.  The ACK or
+                         * SACK of the peer will show which segments are missing. */
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        pxSegment = ( ( TCPSegment_t * ) tcpwinLIST_OWNER( tcpwinLIST_TAIL( &( pxWindow->xWaitQueue ) ) ) );
+                        ( void ) tcpwinLIST_REMOVE( &( pxSegment->xQueueItem ) );
+
+                        pxWindow->xRack.xProbing = pdTRUE;
+                        pxWindow->xRack.ulProbeSequence = pxWindow->tx.ulHighestSequenceNumber;
+                        vTCPTimerSet( &( pxWindow->xRack.xProbeTimer ) );
+
+                        tcpwinLOG_EVENT( pxWindow, eTCPWinEventProbe, pxSegment->ulSequenceNumber, ( uint32_t ) pxSegment->lDataLength, 0U );
+
+                        if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) ) )
+                        {
+                            FreeRTOS_debug_printf( ( "ulTCPWindowTxGet[%u,%u]: Probe %d bytes for sequence number %u\n",
+                                                     pxWindow->usPeerPortNumber,
+                                                     pxWindow->usOurPortNumber,
+                                                     ( int ) pxSegment->lDataLength,
+                                                     ( unsigned ) ( pxSegment->ulSequenceNumber - pxWindow->tx.ulFirstSequenceNumber ) ) );
+                        }
+                    }
+                    else
+                #endif /* if ( ipconfigUSE_TCP_RACK_TLP != 0 ) */
+
+                if( xExpired != pdFALSE )
                 {
                     /* A normal (non-fast) retransmission.  Move it from the
                      * head of the waiting queue. */
                     pxSegment = xTCPWindowGetHead( &( pxWindow->xWaitQueue ) );
                     pxSegment->u.bits.ucDupAckCount = ( uint8_t ) pdFALSE_UNSIGNED;
+                    ( pxWindow->ulRetransmitCount )++;
+
+                    tcpwinLOG_EVENT( pxWindow, eTCPWinEventTimeout, pxSegment->ulSequenceNumber, ulMaxTime, pxSegment->u.bits.ucTransmitCount );
+
+                    #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+                    {
+                        if( pxSegment->u.bits.ucTransmitCount == 1U )
+                        {
+                            /* The first retransmission after a time-out.  Later
+                             * time-outs of the same segment do not reduce the
+                             * window any further. */
+                            prvTCPCongestionLoss( pxWindow, pdTRUE );
+                        }
+                    }
+                    #endif
+
+                    #if ( ipconfigUSE_TCP_RACK_TLP != 0 )
+                    {
+                        /* The probe did not help, a new one may be sent after
+                         * the next successful transmission. */
+                        pxWindow->xRack.xProbing = pdFALSE;
+                    }
+                    #endif
 
                     /* Some detailed logging. */
                     if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) ) )
@@ -1787,6 +2917,62 @@
 
     #if ( ipconfigUSE_TCP_WIN == 1 )
 
+/**
+ * @brief A segment is about to be transmitted: move it to the waiting queue,
+ *        mark it as outstanding and start its transmit timer.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] pxSegment The segment that will be sent.
+ */
+        static void prvTCPWindowTxMarkSent( TCPWindow_t * pxWindow,
+                                            TCPSegment_t * pxSegment )
+        {
+            configASSERT( tcpwinLIST_CONTAINER( &( pxSegment->xQueueItem ) ) == NULL );
+
+            /* Now that the segment will be transmitted, add it to the tail of
+             * the waiting queue. */
+            tcpwinLIST_INSERT_FIFO( &pxWindow->xWaitQueue, &pxSegment->xQueueItem );
+
+            /* And mark it as outstanding. */
+            pxSegment->u.bits.bOutstanding = pdTRUE_UNSIGNED;
+
+            /* Administer the transmit count, needed for fast
+             * retransmissions. */
+            ( pxSegment->u.bits.ucTransmitCount )++;
+
+            tcpwinLOG_EVENT( pxWindow,
+                             ( pxSegment->u.bits.ucTransmitCount == 1U ) ? eTCPWinEventSend : eTCPWinEventRetransmit,
+                             pxSegment->ulSequenceNumber,
+                             ( uint32_t ) pxSegment->lDataLength,
+                             ( uint8_t ) pxSegment->u.bits.ucTransmitCount );
+
+            if( pxSegment->u.bits.ucTransmitCount > 1U )
+            {
+                iptraceTCP_RETRANSMISSION( pxWindow->usOurPortNumber, pxSegment->ulSequenceNumber );
+            }
+
+            /* If there have been several retransmissions (4), decrease the
+             * size of the transmission window to at most 2 times MSS. */
+            if( ( pxSegment->u.bits.ucTransmitCount == MAX_TRANSMIT_COUNT_USING_LARGE_WINDOW ) &&
+                ( pxWindow->xSize.ulTxWindowLength > ( 2U * ( ( uint32_t ) pxWindow->usMSS ) ) ) )
+            {
+                uint16_t usMSS2 = ( uint16_t ) ( pxWindow->usMSS * 2U );
+                FreeRTOS_debug_printf( ( "ulTCPWindowTxGet[%u - %u]: Change Tx window: %u -> %u\n",
+                                         pxWindow->usPeerPortNumber,
+                                         pxWindow->usOurPortNumber,
+                                         ( unsigned ) pxWindow->xSize.ulTxWindowLength,
+                                         usMSS2 ) );
+                pxWindow->xSize.ulTxWindowLength = usMSS2;
+            }
+
+            /* Clear the transmit timer. */
+            vTCPTimerSet( &( pxSegment->xTransmitTimer ) );
+        }
+    #endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+
 /**
  * @brief Get data that can be transmitted right now. There are three types of
  *        outstanding segments: Priority queue, Waiting queue, Normal TX queue.
@@ -1804,9 +2990,24 @@
             TCPSegment_t * pxSegment;
             uint32_t ulReturn = 0U;
 
-            /* Fetches data to be sent-out now.
-             *
-             * Priority messages: segments with a resend need no check current sliding
+            #if ( ipconfigUSE_TCP_RACK_TLP != 0 )
+            {
+                /* Segments may have been declared lost by the passing of time,
+                 * they will be moved to the priority queue. */
+                if( prvTCPRackDetectLoss( pxWindow ) != 0U )
+                {
+                    #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+                    {
+                        prvTCPCongestionLoss( pxWindow, pdFALSE );
+                    }
+                    #endif
+                }
+            }
+            #endif
+
+            /* Fetches data to be sent-out now.
+             *
+             * Priority messages: segments with a resend need no check current sliding
              * window size. */
             pxSegment = xTCPWindowGetHead( &( pxWindow->xPriorityQueue ) );
             pxWindow->ulOurSequenceNumber = pxWindow->tx.ulHighestSequenceNumber;
@@ -1843,35 +3044,7 @@
             /* See if it has already been determined to return 0. */
             if( pxSegment != NULL )
             {
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxSegment->xQueueItem ) ) == NULL );
-
-                /* Now that the segment will be transmitted, add it to the tail of
-                 * the waiting queue. */
-                vListInsertFifo( &pxWindow->xWaitQueue, &pxSegment->xQueueItem );
-
-                /* And mark it as outstanding. */
-                pxSegment->u.bits.bOutstanding = pdTRUE_UNSIGNED;
-
-                /* Administer the transmit count, needed for fast
-                 * retransmissions. */
-                ( pxSegment->u.bits.ucTransmitCount )++;
-
-                /* If there have been several retransmissions (4), decrease the
-                 * size of the transmission window to at most 2 times MSS. */
-                if( ( pxSegment->u.bits.ucTransmitCount == MAX_TRANSMIT_COUNT_USING_LARGE_WINDOW ) &&
-                    ( pxWindow->xSize.ulTxWindowLength > ( 2U * ( ( uint32_t ) pxWindow->usMSS ) ) ) )
-                {
-                    uint16_t usMSS2 = ( uint16_t ) ( pxWindow->usMSS * 2U );
-                    FreeRTOS_debug_printf( ( "ulTCPWindowTxGet[%u - %u]: Change Tx window: %u -> %u\n",
-                                             pxWindow->usPeerPortNumber,
-                                             pxWindow->usOurPortNumber,
-                                             ( unsigned ) pxWindow->xSize.ulTxWindowLength,
-                                             usMSS2 ) );
-                    pxWindow->xSize.ulTxWindowLength = usMSS2;
-                }
-
-                /* Clear the transmit timer. */
-                vTCPTimerSet( &( pxSegment->xTransmitTimer ) );
+                prvTCPWindowTxMarkSent( pxWindow, pxSegment );
 
                 pxWindow->ulOurSequenceNumber = pxSegment->ulSequenceNumber;
 
@@ -1887,6 +3060,49 @@
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
 
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_TSO != 0 ) )
+
+/**
+ * @brief After ulTCPWindowTxGet() has returned data, get the next new segment
+ *        as well, so that both can be sent in a single large packet.  This is
+ *        only done when the segment follows directly on the data already
+ *        obtained.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] ulWindowSize The current size of the sliding RX window of the peer.
+ * @param[in] ulSequenceNumber The sequence number that the segment must start with.
+ * @param[in] ulMaxLength The maximum length of the segment.
+ *
+ * @return The length of the segment, or zero when there is none.
+ */
+        uint32_t ulTCPWindowTxGetMore( TCPWindow_t * pxWindow,
+                                       uint32_t ulWindowSize,
+                                       uint32_t ulSequenceNumber,
+                                       uint32_t ulMaxLength )
+        {
+            TCPSegment_t * pxSegment = xTCPWindowPeekHead( &( pxWindow->xTxQueue ) );
+            uint32_t ulReturn = 0U;
+
+            /* Retransmissions have priority, and they are sent one by one. */
+            if( ( pxSegment != NULL ) &&
+                ( tcpwinLIST_LENGTH( &( pxWindow->xPriorityQueue ) ) == 0U ) &&
+                ( pxSegment->ulSequenceNumber == ulSequenceNumber ) &&
+                ( ( uint32_t ) pxSegment->lDataLength <= ulMaxLength ) )
+            {
+                pxSegment = pxTCPWindowTx_GetTXQueue( pxWindow, ulWindowSize );
+
+                if( pxSegment != NULL )
+                {
+                    prvTCPWindowTxMarkSent( pxWindow, pxSegment );
+                    ulReturn = ( uint32_t ) pxSegment->lDataLength;
+                }
+            }
+
+            return ulReturn;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_TSO != 0 ) */
+/*-----------------------------------------------------------*/
+
     #if ( ipconfigUSE_TCP_WIN == 1 )
 
 /**
@@ -1902,26 +3118,201 @@
         {
             int32_t mS = ( int32_t ) ulTimerGetAge( &( pxSegment->xTransmitTimer ) );
 
-            if( pxWindow->lSRTT >= mS )
+            #if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 )
+                int32_t lUS = ( int32_t ) ulTimerGetAgeUS( &( pxSegment->xTransmitTimer ) );
+            #endif
+
+            #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
             {
-                /* RTT becomes smaller: adapt slowly. */
-                pxWindow->lSRTT = ( ( winSRTT_DECREMENT_NEW * mS ) + ( winSRTT_DECREMENT_CURRENT * pxWindow->lSRTT ) ) / ( winSRTT_DECREMENT_NEW + winSRTT_DECREMENT_CURRENT );
+                if( pxWindow->u.bits.bTimeStampEcho != pdFALSE_UNSIGNED )
+                {
+                    /* The peer echoed the time-stamp of the transmission that
+                     * it acknowledges, also when a segment was retransmitted. */
+                    mS = ( int32_t ) ( ulTCPWindowTimeStamp() - pxWindow->ulTimeStampEcho );
+
+                    #if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 )
+                    {
+                        lUS = mS * 1000;
+                    }
+                    #endif
+                }
             }
-            else
+            #endif
+
+            #if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 )
             {
-                /* RTT becomes larger: adapt quicker */
-                pxWindow->lSRTT = ( ( winSRTT_INCREMENT_NEW * mS ) + ( winSRTT_INCREMENT_CURRENT * pxWindow->lSRTT ) ) / ( winSRTT_INCREMENT_NEW + winSRTT_INCREMENT_CURRENT );
+                /* Smooth the round-trip time in microseconds, and round it up
+                 * to whole milliseconds for the users of lSRTT. */
+                if( pxWindow->lSRTTus >= lUS )
+                {
+                    pxWindow->lSRTTus = ( ( winSRTT_DECREMENT_NEW * lUS ) + ( winSRTT_DECREMENT_CURRENT * pxWindow->lSRTTus ) ) / ( winSRTT_DECREMENT_NEW + winSRTT_DECREMENT_CURRENT );
+                }
+                else
+                {
+                    pxWindow->lSRTTus = ( ( winSRTT_INCREMENT_NEW * lUS ) + ( winSRTT_INCREMENT_CURRENT * pxWindow->lSRTTus ) ) / ( winSRTT_INCREMENT_NEW + winSRTT_INCREMENT_CURRENT );
+                }
+
+                pxWindow->lSRTT = ( pxWindow->lSRTTus + 999 ) / 1000;
+            }
+            #else /* if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 ) */
+            {
+                if( pxWindow->lSRTT >= mS )
+                {
+                    /* RTT becomes smaller: adapt slowly. */
+                    pxWindow->lSRTT = ( ( winSRTT_DECREMENT_NEW * mS ) + ( winSRTT_DECREMENT_CURRENT * pxWindow->lSRTT ) ) / ( winSRTT_DECREMENT_NEW + winSRTT_DECREMENT_CURRENT );
+                }
+                else
+                {
+                    /* RTT becomes larger: adapt quicker */
+                    pxWindow->lSRTT = ( ( winSRTT_INCREMENT_NEW * mS ) + ( winSRTT_INCREMENT_CURRENT * pxWindow->lSRTT ) ) / ( winSRTT_INCREMENT_NEW + winSRTT_INCREMENT_CURRENT );
+                }
             }
+            #endif /* if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 ) */
 
             /* Cap to the minimum of 50ms. */
             if( pxWindow->lSRTT < winSRTT_CAP_mS )
             {
                 pxWindow->lSRTT = winSRTT_CAP_mS;
             }
+
+            tcpwinLOG_EVENT( pxWindow, eTCPWinEventRTT, pxSegment->ulSequenceNumber, ( uint32_t ) mS, 0U );
         }
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
 
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 ) )
+
+/**
+ * @brief A segment has been added to the tail of xTxSegments, add it to the
+ *        index as well.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] pxSegment The new outgoing segment.
+ */
+        static void prvTCPWindowTxIndexAdd( TCPWindow_t * pxWindow,
+                                            TCPSegment_t * pxSegment )
+        {
+            UBaseType_t uxPosition;
+
+            if( ( pxWindow->xTxIndexOverflow == pdFALSE ) &&
+                ( pxWindow->uxTxIndexCount < ( UBaseType_t ) ipconfigTCP_TX_SEGMENT_INDEX_COUNT ) )
+            {
+                uxPosition = ( pxWindow->uxTxIndexHead + pxWindow->uxTxIndexCount ) % ( UBaseType_t ) ipconfigTCP_TX_SEGMENT_INDEX_COUNT;
+                pxWindow->pxTxIndex[ uxPosition ] = pxSegment;
+                pxWindow->uxTxIndexCount++;
+            }
+            else
+            {
+                /* The index is full.  It will only hold the oldest segments
+                 * until xTxSegments has become empty. */
+                pxWindow->xTxIndexOverflow = pdTRUE;
+            }
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 ) )
+
+/**
+ * @brief The segment at the head of xTxSegments has been acknowledged and it
+ *        is about to be freed, remove it from the index.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] pxSegment The segment that will be freed.
+ */
+        static void prvTCPWindowTxIndexRemove( TCPWindow_t * pxWindow,
+                                               const TCPSegment_t * pxSegment )
+        {
+            if( ( pxWindow->uxTxIndexCount != 0U ) &&
+                ( pxWindow->pxTxIndex[ pxWindow->uxTxIndexHead ] == pxSegment ) )
+            {
+                pxWindow->uxTxIndexHead = ( pxWindow->uxTxIndexHead + 1U ) % ( UBaseType_t ) ipconfigTCP_TX_SEGMENT_INDEX_COUNT;
+                pxWindow->uxTxIndexCount--;
+            }
+            else
+            {
+                /* A segment that was added after the index overflowed. */
+                pxWindow->xTxIndexOverflow = pdTRUE;
+            }
+
+            if( tcpwinLIST_LENGTH( &( pxWindow->xTxSegments ) ) <= 1U )
+            {
+                /* The last outgoing segment is being freed, the index covers
+                 * xTxSegments completely again. */
+                pxWindow->uxTxIndexHead = 0U;
+                pxWindow->uxTxIndexCount = 0U;
+                pxWindow->xTxIndexOverflow = pdFALSE;
+            }
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 ) )
+
+/**
+ * @brief Find the first outgoing segment which starts at or after a given
+ *        sequence number.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] ulSequenceNumber The sequence number to look-up.
+ *
+ * @return The list item of the segment in xTxSegments, the end of the list when
+ *         there is none, or the head of the list when the index is not complete.
+ */
+        static const TCPSegmentItem_t * prvTCPWindowTxIndexSearch( const TCPWindow_t * pxWindow,
+                                                                   uint32_t ulSequenceNumber )
+        {
+            UBaseType_t uxLow = 0U;
+            UBaseType_t uxHigh = pxWindow->uxTxIndexCount;
+            UBaseType_t uxMiddle;
+            UBaseType_t uxPosition;
+            const TCPSegmentItem_t * pxReturn;
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const TCPSegmentItem_t * pxEnd = tcpwinLIST_END( &( pxWindow->xTxSegments ) );
+
+            if( pxWindow->xTxIndexOverflow != pdFALSE )
+            {
+                /* Not all segments are indexed, walk the list from its head. */
+                pxReturn = tcpwinLIST_NEXT( pxEnd );
+            }
+            else
+            {
+                /* The segments in xTxSegments are sorted and they do not
+                 * overlap. */
+                while( uxLow < uxHigh )
+                {
+                    uxMiddle = uxLow + ( ( uxHigh - uxLow ) / 2U );
+                    uxPosition = ( pxWindow->uxTxIndexHead + uxMiddle ) % ( UBaseType_t ) ipconfigTCP_TX_SEGMENT_INDEX_COUNT;
+
+                    if( xSequenceLessThan( pxWindow->pxTxIndex[ uxPosition ]->ulSequenceNumber, ulSequenceNumber ) != pdFALSE )
+                    {
+                        uxLow = uxMiddle + 1U;
+                    }
+                    else
+                    {
+                        uxHigh = uxMiddle;
+                    }
+                }
+
+                if( uxLow < pxWindow->uxTxIndexCount )
+                {
+                    uxPosition = ( pxWindow->uxTxIndexHead + uxLow ) % ( UBaseType_t ) ipconfigTCP_TX_SEGMENT_INDEX_COUNT;
+                    pxReturn = &( pxWindow->pxTxIndex[ uxPosition ]->xSegmentItem );
+                }
+                else
+                {
+                    pxReturn = pxEnd;
+                }
+            }
+
+            return pxReturn;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 ) */
+/*-----------------------------------------------------------*/
+
     #if ( ipconfigUSE_TCP_WIN == 1 )
 
 /**
@@ -1943,13 +3334,14 @@
             uint32_t ulBytesConfirmed = 0U;
             uint32_t ulSequenceNumber = ulFirst;
             uint32_t ulDataLength;
-            const ListItem_t * pxIterator;
+            const TCPSegmentItem_t * pxIterator;
 
             /* MISRA Ref 11.3.1 [Misaligned access] */
 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
             /* coverity[misra_c_2012_rule_11_3_violation] */
-            const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( pxWindow->xTxSegments.xListEnd ) );
+            const TCPSegmentItem_t * pxEnd = tcpwinLIST_END( &( pxWindow->xTxSegments ) );
             BaseType_t xDoUnlink;
+            BaseType_t xUnambiguous;
             TCPSegment_t * pxSegment;
 
             /* An acknowledgement or a selective ACK (SACK) was received.  See if some outstanding data
@@ -1973,16 +3365,25 @@
              * A Smoothed RTT will increase quickly, but it is conservative when
              * becoming smaller. */
 
-            pxIterator = listGET_NEXT( pxEnd );
+            #if ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 )
+            {
+                /* Skip the segments below ulFirst without visiting them. */
+                pxIterator = prvTCPWindowTxIndexSearch( pxWindow, ulFirst );
+            }
+            #else
+            {
+                pxIterator = tcpwinLIST_NEXT( pxEnd );
+            }
+            #endif
 
             while( ( pxIterator != pxEnd ) && ( xSequenceLessThan( ulSequenceNumber, ulLast ) != 0 ) )
             {
                 xDoUnlink = pdFALSE;
-                pxSegment = ( ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                pxSegment = ( ( TCPSegment_t * ) tcpwinLIST_OWNER( pxIterator ) );
 
                 /* Move to the next item because the current item might get
                  * removed. */
-                pxIterator = ( const ListItem_t * ) listGET_NEXT( pxIterator );
+                pxIterator = ( const TCPSegmentItem_t * ) tcpwinLIST_NEXT( pxIterator );
 
                 /* Continue if this segment does not fall within the ACK'd range. */
                 if( xSequenceGreaterThan( ulSequenceNumber, pxSegment->ulSequenceNumber ) != pdFALSE )
@@ -2027,9 +3428,28 @@
                     /* This segment is fully ACK'd, set the flag. */
                     pxSegment->u.bits.bAcked = pdTRUE;
 
+                    #if ( ipconfigUSE_TCP_RACK_TLP != 0 )
+                    {
+                        prvTCPRackUpdate( pxWindow, pxSegment );
+                    }
+                    #endif
+
                     /* Calculate the RTT only if the segment was sent-out for the
                      * first time and if this is the last ACK'd segment in a range. */
-                    if( ( pxSegment->u.bits.ucTransmitCount == 1U ) &&
+                    xUnambiguous = ( pxSegment->u.bits.ucTransmitCount == 1U ) ? pdTRUE : pdFALSE;
+
+                    #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+                    {
+                        /* An echoed time-stamp is unambiguous, also after a
+                         * retransmission. */
+                        if( pxWindow->u.bits.bTimeStampEcho != pdFALSE_UNSIGNED )
+                        {
+                            xUnambiguous = pdTRUE;
+                        }
+                    }
+                    #endif
+
+                    if( ( xUnambiguous != pdFALSE ) &&
                         ( ( pxSegment->ulSequenceNumber + ulDataLength ) == ulLast ) )
                     {
                         prvTCPWindowTxCheckAck_CalcSRTT( pxWindow, pxSegment );
@@ -2059,21 +3479,35 @@
                     ulBytesConfirmed += ulDataLength;
 
                     /* All segments below tx.ulCurrentSequenceNumber may be freed. */
+                    #if ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 )
+                    {
+                        prvTCPWindowTxIndexRemove( pxWindow, pxSegment );
+                    }
+                    #endif
                     vTCPWindowFree( pxSegment );
 
                     /* No need to unlink it any more. */
                     xDoUnlink = pdFALSE;
                 }
 
-                if( ( xDoUnlink != pdFALSE ) && ( listLIST_ITEM_CONTAINER( &( pxSegment->xQueueItem ) ) != NULL ) )
+                if( ( xDoUnlink != pdFALSE ) && ( tcpwinLIST_CONTAINER( &( pxSegment->xQueueItem ) ) != NULL ) )
                 {
                     /* Remove item from its queues. */
-                    ( void ) uxListRemove( &pxSegment->xQueueItem );
+                    ( void ) tcpwinLIST_REMOVE( &pxSegment->xQueueItem );
                 }
 
                 ulSequenceNumber += ulDataLength;
             }
 
+            #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+            {
+                if( ulBytesConfirmed != 0U )
+                {
+                    prvTCPCongestionAck( pxWindow, ulBytesConfirmed );
+                }
+            }
+            #endif
+
             return ulBytesConfirmed;
         }
     #endif /* ipconfigUSE_TCP_WIN == 1 */
@@ -2092,8 +3526,8 @@
         static uint32_t prvTCPWindowFastRetransmit( TCPWindow_t * pxWindow,
                                                     uint32_t ulFirst )
         {
-            const ListItem_t * pxIterator;
-            const ListItem_t * pxEnd;
+            const TCPSegmentItem_t * pxIterator;
+            const TCPSegmentItem_t * pxEnd;
             TCPSegment_t * pxSegment;
             uint32_t ulCount = 0U;
 
@@ -2103,17 +3537,17 @@
             /* MISRA Ref 11.3.1 [Misaligned access] */
 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
             /* coverity[misra_c_2012_rule_11_3_violation] */
-            pxEnd = ( ( const ListItem_t * ) &( pxWindow->xWaitQueue.xListEnd ) );
+            pxEnd = tcpwinLIST_END( &( pxWindow->xWaitQueue ) );
 
-            pxIterator = listGET_NEXT( pxEnd );
+            pxIterator = tcpwinLIST_NEXT( pxEnd );
 
             while( pxIterator != pxEnd )
             {
                 /* Get the owner, which is a TCP segment. */
-                pxSegment = ( ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                pxSegment = ( ( TCPSegment_t * ) tcpwinLIST_OWNER( pxIterator ) );
 
                 /* Hop to the next item before the current gets unlinked. */
-                pxIterator = listGET_NEXT( pxIterator );
+                pxIterator = tcpwinLIST_NEXT( pxIterator );
 
                 /* Fast retransmission:
                  * When 3 packets with a higher sequence number have been acknowledged
@@ -2128,6 +3562,7 @@
                         if( pxSegment->u.bits.ucDupAckCount == DUPLICATE_ACKS_BEFORE_FAST_RETRANSMIT )
                         {
                             pxSegment->u.bits.ucTransmitCount = ( uint8_t ) pdFALSE;
+                            ( pxWindow->ulFastRetransmitCount )++;
 
                             /* Not clearing 'ucDupAckCount' yet as more SACK's might come in
                              * which might lead to a second fast rexmit. */
@@ -2139,11 +3574,11 @@
                             }
 
                             /* Remove it from xWaitQueue. */
-                            ( void ) uxListRemove( &pxSegment->xQueueItem );
+                            ( void ) tcpwinLIST_REMOVE( &pxSegment->xQueueItem );
 
                             /* Add this segment to the priority queue so it gets
                              * retransmitted immediately. */
-                            vListInsertFifo( &( pxWindow->xPriorityQueue ), &( pxSegment->xQueueItem ) );
+                            tcpwinLIST_INSERT_FIFO( &( pxWindow->xPriorityQueue ), &( pxSegment->xQueueItem ) );
                             ulCount++;
                         }
                     }
@@ -2182,8 +3617,22 @@
             else
             {
                 ulReturn = prvTCPWindowTxCheckAck( pxWindow, ulFirstSequence, ulSequenceNumber );
+
+                #if ( ipconfigUSE_TCP_RACK_TLP != 0 )
+                {
+                    if( ( pxWindow->xRack.xProbing != pdFALSE ) &&
+                        ( xSequenceGreaterThanOrEqual( ulSequenceNumber, pxWindow->xRack.ulProbeSequence ) != pdFALSE ) )
+                    {
+                        /* All data sent before the probe has been acknowledged. */
+                        pxWindow->xRack.xProbing = pdFALSE;
+                    }
+                }
+                #endif
             }
 
+            /* Also log duplicate ACK's, with a value of zero. */
+            tcpwinLOG_EVENT( pxWindow, eTCPWinEventAck, ulSequenceNumber, ulReturn, 0U );
+
             return ulReturn;
         }
     #endif /* ipconfigUSE_TCP_WIN == 1 */
@@ -2206,11 +3655,36 @@
                                     uint32_t ulLast )
         {
             uint32_t ulAckCount;
+            uint32_t ulLost;
             uint32_t ulCurrentSequenceNumber = pxWindow->tx.ulCurrentSequenceNumber;
 
+            tcpwinLOG_EVENT( pxWindow, eTCPWinEventSack, ulFirst, ulLast - pxWindow->tx.ulFirstSequenceNumber, 0U );
+
             /* Receive a SACK option. */
             ulAckCount = prvTCPWindowTxCheckAck( pxWindow, ulFirst, ulLast );
-            ( void ) prvTCPWindowFastRetransmit( pxWindow, ulFirst );
+
+            ulLost = prvTCPWindowFastRetransmit( pxWindow, ulFirst );
+
+            #if ( ipconfigUSE_TCP_RACK_TLP != 0 )
+            {
+                /* The most recently delivered segment tells which of the older
+                 * segments should have arrived already. */
+                ulLost += prvTCPRackDetectLoss( pxWindow );
+            }
+            #endif
+
+            #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+            {
+                if( ulLost != 0U )
+                {
+                    prvTCPCongestionLoss( pxWindow, pdFALSE );
+                }
+            }
+            #else
+            {
+                ( void ) ulLost;
+            }
+            #endif
 
             if( ( xTCPWindowLoggingLevel >= 1 ) && ( xSequenceGreaterThan( ulFirst, ulCurrentSequenceNumber ) != pdFALSE ) )
             {
@@ -2227,4 +3701,579 @@
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
 
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) )
+
+/**
+ * @brief A segment has been delivered.  RACK remembers the most recently sent
+ *        segment that was delivered, and the RTT of that segment.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] pxSegment The segment that was just acknowledged.
+ */
+        static void prvTCPRackUpdate( TCPWindow_t * pxWindow,
+                                      const TCPSegment_t * pxSegment )
+        {
+            TCPRack_t * pxRack = &( pxWindow->xRack );
+            uint32_t ulAge = ulTimerGetAge( &( pxSegment->xTransmitTimer ) );
+            uint32_t ulEndSequence = pxSegment->ulSequenceNumber + ( uint32_t ) pxSegment->lDataLength;
+            BaseType_t xUnambiguous = ( pxSegment->u.bits.ucTransmitCount == 1U ) ? pdTRUE : pdFALSE;
+
+            #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+            {
+                if( pxWindow->u.bits.bTimeStampEcho != pdFALSE_UNSIGNED )
+                {
+                    xUnambiguous = pdTRUE;
+                }
+            }
+            #endif
+
+            /* An ACK of a retransmitted segment might belong to the original
+             * transmission, which would give a wrong idea of the send time. */
+            if( xUnambiguous != pdFALSE )
+            {
+                if( ( pxRack->xValid == pdFALSE ) ||
+                    ( ulAge < ulTimerGetAge( &( pxRack->xTransmitTime ) ) ) ||
+                    ( ( ulAge == ulTimerGetAge( &( pxRack->xTransmitTime ) ) ) &&
+                      ( xSequenceGreaterThan( ulEndSequence, pxRack->ulEndSequence ) != pdFALSE ) ) )
+                {
+                    pxRack->xTransmitTime = pxSegment->xTransmitTimer;
+                    pxRack->ulEndSequence = ulEndSequence;
+                    pxRack->ulRTT = ulAge;
+                    pxRack->xValid = pdTRUE;
+                }
+            }
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) )
+
+/**
+ * @brief Find out when an outstanding segment will be considered lost.  That
+ *        is when it was sent before the most recently delivered segment, and
+ *        it is older than the RTT of that segment plus a reordering window
+ *        of SRTT / 4.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ * @param[in] pxSegment A segment from the waiting queue.
+ *
+ * @return The time in ms before the segment is lost, zero when it is lost
+ *         already, or ~0 when RACK can not tell.
+ */
+        static uint32_t prvTCPRackTimeLeft( const TCPWindow_t * pxWindow,
+                                            const TCPSegment_t * pxSegment )
+        {
+            const TCPRack_t * pxRack = &( pxWindow->xRack );
+            uint32_t ulReturn = ~( ( uint32_t ) 0U );
+            uint32_t ulAge = ulTimerGetAge( &( pxSegment->xTransmitTimer ) );
+            uint32_t ulEndSequence = pxSegment->ulSequenceNumber + ( uint32_t ) pxSegment->lDataLength;
+            uint32_t ulRackAge;
+            uint32_t ulLimit;
+
+            if( pxRack->xValid != pdFALSE )
+            {
+                ulRackAge = ulTimerGetAge( &( pxRack->xTransmitTime ) );
+
+                if( ( ulAge > ulRackAge ) ||
+                    ( ( ulAge == ulRackAge ) &&
+                      ( xSequenceLessThan( ulEndSequence, pxRack->ulEndSequence ) != pdFALSE ) ) )
+                {
+                    /* The segment was sent before the one that was delivered. */
+                    ulLimit = pxRack->ulRTT + ( ( uint32_t ) pxWindow->lSRTT / 4U );
+
+                    if( ulAge >= ulLimit )
+                    {
+                        ulReturn = 0U;
+                    }
+                    else
+                    {
+                        ulReturn = ulLimit - ulAge;
+                    }
+                }
+            }
+
+            return ulReturn;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) )
+
+/**
+ * @brief Move all segments that RACK considers lost from the waiting queue to
+ *        the priority queue, so they get retransmitted immediately.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ *
+ * @return The number of segments that were moved.
+ */
+        static uint32_t prvTCPRackDetectLoss( TCPWindow_t * pxWindow )
+        {
+            uint32_t ulCount = 0U;
+            const TCPSegmentItem_t * pxIterator;
+            const TCPSegmentItem_t * pxEnd;
+            TCPSegment_t * pxSegment;
+
+            if( pxWindow->xRack.xValid != pdFALSE )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxEnd = tcpwinLIST_END( &( pxWindow->xWaitQueue ) );
+                pxIterator = tcpwinLIST_NEXT( pxEnd );
+
+                while( pxIterator != pxEnd )
+                {
+                    pxSegment = ( ( TCPSegment_t * ) tcpwinLIST_OWNER( pxIterator ) );
+
+                    /* Hop to the next item before the current gets unlinked. */
+                    pxIterator = tcpwinLIST_NEXT( pxIterator );
+
+                    if( ( pxSegment->u.bits.bAcked == pdFALSE_UNSIGNED ) &&
+                        ( prvTCPRackTimeLeft( pxWindow, pxSegment ) == 0U ) )
+                    {
+                        if( ( xTCPWindowLoggingLevel >= 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) ) )
+                        {
+                            FreeRTOS_debug_printf( ( "prvTCPRackDetectLoss: Requeue sequence number %u\n",
+                                                     ( unsigned ) ( pxSegment->ulSequenceNumber - pxWindow->tx.ulFirstSequenceNumber ) ) );
+                        }
+
+                        pxSegment->u.bits.ucTransmitCount = ( uint8_t ) pdFALSE;
+                        pxSegment->u.bits.ucDupAckCount = ( uint8_t ) pdFALSE_UNSIGNED;
+
+                        ( void ) tcpwinLIST_REMOVE( &pxSegment->xQueueItem );
+                        tcpwinLIST_INSERT_FIFO( &( pxWindow->xPriorityQueue ), &( pxSegment->xQueueItem ) );
+                        ulCount++;
+                    }
+                }
+            }
+
+            return ulCount;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) )
+
+/**
+ * @brief After a tail loss probe, the retransmission time-out is restarted
+ *        from the moment the probe was sent.
+ *
+ * @param[in] pxWindow The descriptor of the TCP sliding windows.
+ *
+ * @return The time in ms until the time-out, or zero when no probe is pending
+ *         or when the time-out has passed.
+ */
+        static uint32_t prvTCPWindowTxProbeDelay( const TCPWindow_t * pxWindow )
+        {
+            uint32_t ulReturn = 0U;
+            uint32_t ulMaxTime;
+            uint32_t ulAge;
+
+            if( pxWindow->xRack.xProbing != pdFALSE )
+            {
+                ulMaxTime = 2U * ( uint32_t ) pxWindow->lSRTT;
+                ulAge = ulTimerGetAge( &( pxWindow->xRack.xProbeTimer ) );
+
+                if( ulAge < ulMaxTime )
+                {
+                    ulReturn = ulMaxTime - ulAge;
+                }
+            }
+
+            return ulReturn;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_RACK_TLP != 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) )
+
+/** @brief CUBIC: the multiplicative decrease factor beta = 0.7, scaled by 1024. */
+        #define tcpCUBIC_BETA_SCALED             ( 717U )
+
+/** @brief CUBIC: ( 1 + beta ) / 2 = 0.85, for fast convergence, scaled by 1024. */
+        #define tcpCUBIC_CONVERGENCE_SCALED      ( 870U )
+
+/** @brief CUBIC: the growth of the cubic function is C * t^3 MSS, with C = 0.4
+ *  and t in seconds. With t in ms, C becomes 4 / 1e10. */
+        #define tcpCUBIC_C_NUMERATOR             ( 4U )
+        #define tcpCUBIC_C_DENOMINATOR           ( ( uint64_t ) 10000000000U )
+
+/** @brief CUBIC: limit the time used in the cubic function, so that its third
+ *  power can be calculated in 64 bits. */
+        #define tcpCUBIC_MAX_TIME_MS             ( 60000U )
+
+/** @brief The largest congestion window, kept far from overflowing. */
+        #define tcpCONGESTION_WINDOW_MAX         ( 0x40000000U )
+
+/**
+ * @brief Get the MSS to be used by the congestion control.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ *
+ * @return The MSS of the connection, or ipconfigTCP_MSS when it is not known yet.
+ */
+        static uint32_t prvTCPCongestionMSS( const TCPWindow_t * pxWindow )
+        {
+            uint32_t ulMSS = ( uint32_t ) pxWindow->usMSS;
+
+            if( ulMSS == 0U )
+            {
+                ulMSS = ( uint32_t ) ipconfigTCP_MSS;
+            }
+
+            return ulMSS;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the number of bytes that have been sent but not yet acknowledged.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ *
+ * @return The flight size in bytes.
+ */
+        static uint32_t prvTCPCongestionFlightSize( const TCPWindow_t * pxWindow )
+        {
+            uint32_t ulFlightSize = 0U;
+
+            if( xSequenceGreaterThan( pxWindow->tx.ulHighestSequenceNumber, pxWindow->tx.ulCurrentSequenceNumber ) != pdFALSE )
+            {
+                ulFlightSize = pxWindow->tx.ulHighestSequenceNumber - pxWindow->tx.ulCurrentSequenceNumber;
+            }
+
+            return ulFlightSize;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief New data has been acknowledged. When in fast recovery, check if it has
+ *        ended, otherwise pass the event to the congestion control algorithm.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ * @param[in] ulAckedBytes The number of bytes that the left side of the window moved.
+ */
+        static void prvTCPCongestionAck( TCPWindow_t * pxWindow,
+                                         uint32_t ulAckedBytes )
+        {
+            TCPCongestion_t * pxCongestion = &( pxWindow->xCongestion );
+
+            if( pxCongestion->xInRecovery != pdFALSE )
+            {
+                /* Fast recovery ends when all data, that was outstanding when the
+                 * loss was detected, has been acknowledged. */
+                if( xSequenceGreaterThanOrEqual( pxWindow->tx.ulCurrentSequenceNumber, pxCongestion->ulRecoverSequenceNumber ) != pdFALSE )
+                {
+                    pxCongestion->xInRecovery = pdFALSE;
+                }
+            }
+            else
+            {
+                pxCongestion->pxControl->fnOnAck( pxWindow, ulAckedBytes );
+
+                /* There is no use in a window that is larger than what may be sent. */
+                pxCongestion->ulWindow = FreeRTOS_min_uint32( pxCongestion->ulWindow, tcpCONGESTION_WINDOW_MAX );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A segment will be retransmitted. Let the algorithm reduce the window,
+ *        at most once for all the segments that were outstanding at the time,
+ *        unless a time-out occurred.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ * @param[in] xTimeout pdTRUE for a retransmission after a time-out, pdFALSE for
+ *                     a fast retransmission.
+ */
+        static void prvTCPCongestionLoss( TCPWindow_t * pxWindow,
+                                          BaseType_t xTimeout )
+        {
+            TCPCongestion_t * pxCongestion = &( pxWindow->xCongestion );
+
+            if( ( xTimeout != pdFALSE ) || ( pxCongestion->xInRecovery == pdFALSE ) )
+            {
+                pxCongestion->pxControl->fnOnLoss( pxWindow, xTimeout );
+                pxCongestion->ulBytesAcked = 0U;
+                pxCongestion->ulRecoverSequenceNumber = pxWindow->tx.ulHighestSequenceNumber;
+                pxCongestion->xInRecovery = ( xTimeout == pdFALSE ) ? pdTRUE : pdFALSE;
+
+                if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) ) )
+                {
+                    FreeRTOS_debug_printf( ( "prvTCPCongestionLoss[%u,%u]: %s %s cwnd %u ssthresh %u\n",
+                                             pxWindow->usPeerPortNumber,
+                                             pxWindow->usOurPortNumber,
+                                             pxCongestion->pxControl->pcName,
+                                             ( xTimeout != pdFALSE ) ? "time-out" : "fast",
+                                             ( unsigned ) pxCongestion->ulWindow,
+                                             ( unsigned ) pxCongestion->ulSlowStartThreshold ) );
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Set the initial congestion window of RFC 5681, and an unlimited slow
+ *        start threshold.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ */
+        static void prvTCPNewRenoInit( TCPWindow_t * pxWindow )
+        {
+            const uint32_t ulMSS = prvTCPCongestionMSS( pxWindow );
+
+            /* IW = min( 4 * MSS, max( 2 * MSS, 4380 bytes ) ). */
+            pxWindow->xCongestion.ulWindow = FreeRTOS_min_uint32( 4U * ulMSS, FreeRTOS_max_uint32( 2U * ulMSS, 4380U ) );
+            pxWindow->xCongestion.ulSlowStartThreshold = tcpCONGESTION_WINDOW_MAX;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Grow the window: exponentially during slow start, by one MSS per
+ *        window of acknowledged data during congestion avoidance.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ * @param[in] ulAckedBytes The number of bytes acknowledged.
+ */
+        static void prvTCPNewRenoOnAck( TCPWindow_t * pxWindow,
+                                        uint32_t ulAckedBytes )
+        {
+            TCPCongestion_t * pxCongestion = &( pxWindow->xCongestion );
+            const uint32_t ulMSS = prvTCPCongestionMSS( pxWindow );
+
+            if( pxCongestion->ulWindow < pxCongestion->ulSlowStartThreshold )
+            {
+                /* Slow start, with appropriate byte counting ( RFC 3465, L = 1 ). */
+                pxCongestion->ulWindow += FreeRTOS_min_uint32( ulAckedBytes, ulMSS );
+            }
+            else
+            {
+                pxCongestion->ulBytesAcked += ulAckedBytes;
+
+                if( pxCongestion->ulBytesAcked >= pxCongestion->ulWindow )
+                {
+                    pxCongestion->ulBytesAcked -= pxCongestion->ulWindow;
+                    pxCongestion->ulWindow += ulMSS;
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Halve the window after a fast retransmission, or restart with a window
+ *        of one MSS after a time-out.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ * @param[in] xTimeout pdTRUE when the loss was detected by a time-out.
+ */
+        static void prvTCPNewRenoOnLoss( TCPWindow_t * pxWindow,
+                                         BaseType_t xTimeout )
+        {
+            TCPCongestion_t * pxCongestion = &( pxWindow->xCongestion );
+            const uint32_t ulMSS = prvTCPCongestionMSS( pxWindow );
+
+            pxCongestion->ulSlowStartThreshold = FreeRTOS_max_uint32( prvTCPCongestionFlightSize( pxWindow ) / 2U, 2U * ulMSS );
+            pxCongestion->ulWindow = ( xTimeout != pdFALSE ) ? ulMSS : pxCongestion->ulSlowStartThreshold;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the integer cube root.
+ *
+ * @param[in] ullValue The value.
+ *
+ * @return The largest number whose third power does not exceed ullValue.
+ */
+        static uint32_t prvCubeRoot( uint64_t ullValue )
+        {
+            uint32_t ulLow = 0U;
+            uint32_t ulHigh = 2097152U; /* 2^21, its third power does not fit in 64 bits. */
+            uint32_t ulMiddle;
+
+            while( ( ulHigh - ulLow ) > 1U )
+            {
+                ulMiddle = ( ulLow + ulHigh ) / 2U;
+
+                if( ( ( uint64_t ) ulMiddle * ulMiddle * ulMiddle ) <= ullValue )
+                {
+                    ulLow = ulMiddle;
+                }
+                else
+                {
+                    ulHigh = ulMiddle;
+                }
+            }
+
+            return ulLow;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Initialise CUBIC, it uses the same initial window as NewReno.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ */
+        static void prvTCPCubicInit( TCPWindow_t * pxWindow )
+        {
+            prvTCPNewRenoInit( pxWindow );
+            pxWindow->xCongestion.ulWindowMax = 0U;
+            pxWindow->xCongestion.xEpochValid = pdFALSE;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Grow the window along the cubic function of RFC 9438, but not slower
+ *        than Reno would.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ * @param[in] ulAckedBytes The number of bytes acknowledged.
+ */
+        static void prvTCPCubicOnAck( TCPWindow_t * pxWindow,
+                                      uint32_t ulAckedBytes )
+        {
+            TCPCongestion_t * pxCongestion = &( pxWindow->xCongestion );
+            const uint32_t ulMSS = prvTCPCongestionMSS( pxWindow );
+            uint32_t ulTime;
+            uint32_t ulDelta;
+            uint64_t ullOffset;
+            uint64_t ullTarget;
+
+            if( pxCongestion->ulWindow < pxCongestion->ulSlowStartThreshold )
+            {
+                prvTCPNewRenoOnAck( pxWindow, ulAckedBytes );
+            }
+            else
+            {
+                if( pxCongestion->xEpochValid == pdFALSE )
+                {
+                    /* A new congestion avoidance epoch starts. */
+                    vTCPTimerSet( &( pxCongestion->xEpochTimer ) );
+                    pxCongestion->xEpochValid = pdTRUE;
+                    pxCongestion->ulBytesAcked = 0U;
+                    pxCongestion->ulRenoWindow = pxCongestion->ulWindow;
+
+                    if( pxCongestion->ulWindow < pxCongestion->ulWindowMax )
+                    {
+                        /* K = cubic_root( ( W_max - cwnd ) / C ), in ms. */
+                        ullOffset = ( ( uint64_t ) ( pxCongestion->ulWindowMax - pxCongestion->ulWindow ) * tcpCUBIC_C_DENOMINATOR ) /
+                                    ( ( uint64_t ) tcpCUBIC_C_NUMERATOR * ulMSS );
+                        pxCongestion->ulK = prvCubeRoot( ullOffset );
+                        pxCongestion->ulOriginWindow = pxCongestion->ulWindowMax;
+                    }
+                    else
+                    {
+                        pxCongestion->ulK = 0U;
+                        pxCongestion->ulOriginWindow = pxCongestion->ulWindow;
+                    }
+                }
+
+                /* The target is the value of the cubic function one RTT ahead. */
+                ulTime = ulTimerGetAge( &( pxCongestion->xEpochTimer ) ) + ( uint32_t ) pxWindow->lSRTT;
+
+                if( ulTime >= pxCongestion->ulK )
+                {
+                    ulDelta = FreeRTOS_min_uint32( ulTime - pxCongestion->ulK, tcpCUBIC_MAX_TIME_MS );
+                }
+                else
+                {
+                    ulDelta = FreeRTOS_min_uint32( pxCongestion->ulK - ulTime, tcpCUBIC_MAX_TIME_MS );
+                }
+
+                /* C * ( t - K )^3, in bytes.  The division is done in two steps
+                 * to keep precision without overflowing. */
+                ullOffset = ( ( ( ( uint64_t ) ulDelta * ulDelta * ulDelta ) / 10000U ) * ( ( uint64_t ) tcpCUBIC_C_NUMERATOR * ulMSS ) ) /
+                            ( tcpCUBIC_C_DENOMINATOR / 10000U );
+
+                if( ulTime >= pxCongestion->ulK )
+                {
+                    ullTarget = ( uint64_t ) pxCongestion->ulOriginWindow + ullOffset;
+                }
+                else if( ullOffset < ( uint64_t ) pxCongestion->ulOriginWindow )
+                {
+                    ullTarget = ( uint64_t ) pxCongestion->ulOriginWindow - ullOffset;
+                }
+                else
+                {
+                    ullTarget = 0U;
+                }
+
+                /* Do not grow by more than half of the window per RTT. */
+                if( ullTarget > ( ( uint64_t ) pxCongestion->ulWindow + ( pxCongestion->ulWindow / 2U ) ) )
+                {
+                    ullTarget = ( uint64_t ) pxCongestion->ulWindow + ( pxCongestion->ulWindow / 2U );
+                }
+
+                if( ullTarget > ( uint64_t ) pxCongestion->ulWindow )
+                {
+                    /* Increase by ( target - cwnd ) / cwnd for every MSS acknowledged. */
+                    pxCongestion->ulWindow += ( uint32_t ) ( ( ( ullTarget - pxCongestion->ulWindow ) * ulAckedBytes ) / pxCongestion->ulWindow );
+                }
+
+                /* The Reno-friendly estimate grows by 3 * ( 1 - beta ) / ( 1 + beta ) = 9 / 17
+                 * MSS per window of acknowledged data. */
+                pxCongestion->ulBytesAcked += ulAckedBytes;
+
+                if( pxCongestion->ulBytesAcked >= ( ( pxCongestion->ulRenoWindow / 9U ) * 17U ) )
+                {
+                    pxCongestion->ulBytesAcked -= ( pxCongestion->ulRenoWindow / 9U ) * 17U;
+                    pxCongestion->ulRenoWindow += ulMSS;
+                }
+
+                pxCongestion->ulWindow = FreeRTOS_max_uint32( pxCongestion->ulWindow, pxCongestion->ulRenoWindow );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Reduce the window by beta, and remember the window at the time of the
+ *        loss as W_max. After a time-out, restart with a window of one MSS.
+ *
+ * @param[in] pxWindow The TCP window of the connection.
+ * @param[in] xTimeout pdTRUE when the loss was detected by a time-out.
+ */
+        static void prvTCPCubicOnLoss( TCPWindow_t * pxWindow,
+                                       BaseType_t xTimeout )
+        {
+            TCPCongestion_t * pxCongestion = &( pxWindow->xCongestion );
+            const uint32_t ulMSS = prvTCPCongestionMSS( pxWindow );
+            const uint32_t ulWindow = pxCongestion->ulWindow;
+
+            /* Fast convergence: release bandwidth when the window did not reach
+             * the previous maximum. */
+            if( ulWindow < pxCongestion->ulWindowMax )
+            {
+                pxCongestion->ulWindowMax = ( uint32_t ) ( ( ( uint64_t ) ulWindow * tcpCUBIC_CONVERGENCE_SCALED ) / 1024U );
+            }
+            else
+            {
+                pxCongestion->ulWindowMax = ulWindow;
+            }
+
+            pxCongestion->ulSlowStartThreshold = FreeRTOS_max_uint32( ( uint32_t ) ( ( ( uint64_t ) ulWindow * tcpCUBIC_BETA_SCALED ) / 1024U ), 2U * ulMSS );
+            pxCongestion->ulWindow = ( xTimeout != pdFALSE ) ? ulMSS : pxCongestion->ulSlowStartThreshold;
+            pxCongestion->xEpochValid = pdFALSE;
+        }
+/*-----------------------------------------------------------*/
+
+/** @brief The NewReno congestion control, the default. */
+        const TCPCongestionControl_t xTCPCongestionNewReno =
+        {
+            "newreno",
+            prvTCPNewRenoInit,
+            prvTCPNewRenoOnAck,
+            prvTCPNewRenoOnLoss
+        };
+
+/** @brief The CUBIC congestion control. */
+        const TCPCongestionControl_t xTCPCongestionCubic =
+        {
+            "cubic",
+            prvTCPCubicInit,
+            prvTCPCubicOnAck,
+            prvTCPCubicOnLoss
+        };
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) */
+
 #endif /* ipconfigUSE_TCP == 1 */
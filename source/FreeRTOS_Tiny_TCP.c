@@ -170,7 +170,7 @@
     #endif /* ipconfigUSE_TCP_WIN == 0 */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 0 )
+    #if ( ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) )
 
 /**
  * @brief Add data to the Tx Window.
@@ -236,10 +236,10 @@
 
             return lResult;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 0 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 0 )
+    #if ( ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) )
 
 /**
  * @brief Fetches data to be sent.
@@ -287,10 +287,10 @@
 
             return ulLength;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 0 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 0 )
+    #if ( ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) )
 
 /**
  * @brief Has the transmission completed.
@@ -316,10 +316,10 @@
 
             return xReturn;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 0 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 0 )
+    #if ( ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) )
         static BaseType_t prvTCPWindowTxHasSpace( TCPWindow_t const * pxWindow,
                                                   uint32_t ulWindowSize );
 
@@ -347,10 +347,35 @@
 
             return xReturn;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 0 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 0 )
+    #if ( ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) )
+
+/**
+ * @brief Get the time-out after which the outstanding segment will be
+ *        retransmitted.
+ *
+ * @param[in] pxWindow The window of the connection.
+ *
+ * @return The time-out in ms, or the SRTT when no segment is outstanding.
+ */
+        uint32_t ulTCPWindowTxTimeout( const TCPWindow_t * pxWindow )
+        {
+            const TCPSegment_t * pxSegment = &( pxWindow->xTxSegment );
+            uint32_t ulTimeout = ( uint32_t ) pxWindow->lSRTT;
+
+            if( pxSegment->u.bits.bOutstanding != pdFALSE_UNSIGNED )
+            {
+                ulTimeout *= ( ( uint32_t ) 1U << pxSegment->u.bits.ucTransmitCount );
+            }
+
+            return ulTimeout;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) )
 
 /**
  * @brief Check data to be sent and calculate the time period the process may sleep.
@@ -404,10 +429,10 @@
 
             return xReturn;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 0 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ipconfigUSE_TCP_WIN == 0 )
+    #if ( ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) )
 
 /**
  * @brief Receive a normal ACK.
@@ -457,7 +482,7 @@
 
             return ulDataLength;
         }
-    #endif /* ipconfigUSE_TCP_WIN == 0 */
+    #endif /* ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT == 1 ) */
 /*-----------------------------------------------------------*/
 
     #if ( ipconfigUSE_TCP_WIN == 0 )
@@ -498,4 +523,316 @@
     #endif /* ipconfigUSE_TCP_WIN == 0 */
 /*-----------------------------------------------------------*/
 
+    #if ( ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT > 1 ) )
+
+/*
+ * With ipconfigTCP_TINY_TX_SEGMENT_COUNT > 1, the window has a small circular
+ * array of TX segments.  The segments are kept in order of sequence number,
+ * starting at 'uxTxSegmentFirst', which is the oldest segment not yet
+ * acknowledged.  Each segment has its own retransmission timer.
+ */
+
+/** @brief Get the index of the n-th segment in use, counting from the oldest one. */
+        #define tinyTX_SEGMENT_INDEX( pxWindow, uxNth ) \
+    ( ( ( pxWindow )->uxTxSegmentFirst + ( uxNth ) ) % ( UBaseType_t ) ipconfigTCP_TINY_TX_SEGMENT_COUNT )
+
+/**
+ * @brief Get the time after which an outstanding segment will be re-sent.
+ *
+ * @param[in] pxWindow The window of the connection.
+ * @param[in] pxSegment The outstanding segment.
+ *
+ * @return The maximum age of the segment in ms.
+ */
+        static uint32_t prvTCPWindowTxMaxAge( const TCPWindow_t * pxWindow,
+                                              const TCPSegment_t * pxSegment )
+        {
+            /* As 'ucTransmitCount' has a minimum of 1, take 2 * RTT */
+            return ( ( uint32_t ) 1U << pxSegment->u.bits.ucTransmitCount ) * ( uint32_t ) pxWindow->lSRTT;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add data to the Tx Window.  The data is divided over the free
+ *        segments, each holding at most one MSS.
+ *
+ * @param[in] pxWindow The window to which the data is to be added.
+ * @param[in] ulLength The length of the data to be added.
+ * @param[in] lPosition Position in the stream.
+ * @param[in] lMax Size of the Tx stream.
+ *
+ * @return The data actually added.
+ */
+        int32_t lTCPWindowTxAdd( TCPWindow_t * pxWindow,
+                                 uint32_t ulLength,
+                                 int32_t lPosition,
+                                 int32_t lMax )
+        {
+            uint32_t ulBytesLeft = ulLength;
+            int32_t lPos = lPosition;
+            int32_t lResult = 0;
+
+            while( ( ulBytesLeft > 0U ) && ( pxWindow->uxTxSegmentCount < ( UBaseType_t ) ipconfigTCP_TINY_TX_SEGMENT_COUNT ) )
+            {
+                TCPSegment_t * pxSegment = &( pxWindow->xTxSegments[ tinyTX_SEGMENT_INDEX( pxWindow, pxWindow->uxTxSegmentCount ) ] );
+                uint32_t ulToWrite = FreeRTOS_min_uint32( ulBytesLeft, ( uint32_t ) pxSegment->lMaxLength );
+
+                if( ulToWrite == 0U )
+                {
+                    /* The MSS is not known yet. */
+                    break;
+                }
+
+                if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != pdFALSE ) )
+                {
+                    FreeRTOS_debug_printf( ( "lTCPWindowTxAdd: SeqNr %u (%u) Len %u\n",
+                                             ( unsigned ) ( pxWindow->ulNextTxSequenceNumber - pxWindow->tx.ulFirstSequenceNumber ),
+                                             ( unsigned ) ( pxWindow->tx.ulCurrentSequenceNumber - pxWindow->tx.ulFirstSequenceNumber ),
+                                             ( unsigned ) ulToWrite ) );
+                }
+
+                /* The sequence number of the first byte in this packet. */
+                pxSegment->ulSequenceNumber = pxWindow->ulNextTxSequenceNumber;
+                pxSegment->lDataLength = ( int32_t ) ulToWrite;
+                pxSegment->lStreamPos = lPos;
+                pxSegment->u.ulFlags = 0U;
+                vTCPTimerSet( &( pxSegment->xTransmitTimer ) );
+                pxWindow->uxTxSegmentCount++;
+
+                /* Increase the sequence number of the next data to be stored for
+                 * transmission. */
+                pxWindow->ulNextTxSequenceNumber += ulToWrite;
+                ulBytesLeft -= ulToWrite;
+                lResult += ( int32_t ) ulToWrite;
+
+                lPos += ( int32_t ) ulToWrite;
+
+                if( lPos >= lMax )
+                {
+                    lPos -= lMax;
+                }
+            }
+
+            return lResult;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fetches data to be sent: an outstanding segment that timed out, or
+ *        else the oldest segment that was not sent yet, if the peer's window
+ *        has space for it.
+ *
+ * @param[in] pxWindow The window for the connection.
+ * @param[in] ulWindowSize The size of the peer's window.
+ * @param[out] plPosition plPosition will point to a location with the circular data buffer: txStream.
+ *
+ * @return return the amount of data which may be sent along with the position in the txStream.
+ */
+        uint32_t ulTCPWindowTxGet( TCPWindow_t * pxWindow,
+                                   uint32_t ulWindowSize,
+                                   int32_t * plPosition )
+        {
+            TCPSegment_t * pxSegment = NULL;
+            uint32_t ulInFlight = 0U;
+            uint32_t ulLength = 0U;
+            UBaseType_t uxNth;
+
+            for( uxNth = 0U; uxNth < pxWindow->uxTxSegmentCount; uxNth++ )
+            {
+                TCPSegment_t * pxCurrent = &( pxWindow->xTxSegments[ tinyTX_SEGMENT_INDEX( pxWindow, uxNth ) ] );
+
+                if( pxCurrent->u.bits.bOutstanding != pdFALSE_UNSIGNED )
+                {
+                    if( ulTimerGetAge( &( pxCurrent->xTransmitTimer ) ) >= prvTCPWindowTxMaxAge( pxWindow, pxCurrent ) )
+                    {
+                        /* Not acknowledged in time, send it again. */
+                        pxSegment = pxCurrent;
+                        break;
+                    }
+
+                    ulInFlight += ( uint32_t ) pxCurrent->lDataLength;
+                }
+                else
+                {
+                    /* The first segment is always sent, like with a single segment. */
+                    if( ( ulInFlight == 0U ) ||
+                        ( ( ulInFlight + ( uint32_t ) pxCurrent->lDataLength ) <= ulWindowSize ) )
+                    {
+                        pxSegment = pxCurrent;
+                    }
+
+                    break;
+                }
+            }
+
+            if( pxSegment != NULL )
+            {
+                ulLength = ( uint32_t ) pxSegment->lDataLength;
+                pxSegment->u.bits.bOutstanding = pdTRUE_UNSIGNED;
+                pxSegment->u.bits.ucTransmitCount++;
+                vTCPTimerSet( &pxSegment->xTransmitTimer );
+                pxWindow->ulOurSequenceNumber = pxSegment->ulSequenceNumber;
+                *plPosition = pxSegment->lStreamPos;
+            }
+
+            return ulLength;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Has the transmission completed.
+ *
+ * @param[in] pxWindow The window whose transmission window is to be checked.
+ *
+ * @return If there is no outstanding data then pdTRUE is returned,
+ *         else pdFALSE.
+ */
+        BaseType_t xTCPWindowTxDone( const TCPWindow_t * pxWindow )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            if( pxWindow->uxTxSegmentCount == 0U )
+            {
+                xReturn = pdTRUE;
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the time-out after which the oldest outstanding segment will be
+ *        retransmitted.
+ *
+ * @param[in] pxWindow The window of the connection.
+ *
+ * @return The time-out in ms, or the SRTT when no segment is outstanding.
+ */
+        uint32_t ulTCPWindowTxTimeout( const TCPWindow_t * pxWindow )
+        {
+            uint32_t ulTimeout = ( uint32_t ) pxWindow->lSRTT;
+
+            if( pxWindow->uxTxSegmentCount != 0U )
+            {
+                const TCPSegment_t * pxSegment = &( pxWindow->xTxSegments[ pxWindow->uxTxSegmentFirst ] );
+
+                if( pxSegment->u.bits.bOutstanding != pdFALSE_UNSIGNED )
+                {
+                    ulTimeout = prvTCPWindowTxMaxAge( pxWindow, pxSegment );
+                }
+            }
+
+            return ulTimeout;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check data to be sent and calculate the time period the process may sleep.
+ *
+ * @param[in] pxWindow The window to be checked.
+ * @param[in] ulWindowSize Size of the window.
+ * @param[out] pulDelay The time period (in ticks) that the process may sleep.
+ *
+ * @return pdTRUE if the process should sleep or pdFALSE.
+ */
+        BaseType_t xTCPWindowTxHasData( TCPWindow_t const * pxWindow,
+                                        uint32_t ulWindowSize,
+                                        TickType_t * pulDelay )
+        {
+            BaseType_t xReturn = pdFALSE;
+            BaseType_t xHasOutstanding = pdFALSE;
+            TickType_t ulDelay = ( TickType_t ) 0;
+            uint32_t ulInFlight = 0U;
+            UBaseType_t uxNth;
+
+            for( uxNth = 0U; uxNth < pxWindow->uxTxSegmentCount; uxNth++ )
+            {
+                const TCPSegment_t * pxSegment = &( pxWindow->xTxSegments[ tinyTX_SEGMENT_INDEX( pxWindow, uxNth ) ] );
+
+                if( pxSegment->u.bits.bOutstanding != pdFALSE_UNSIGNED )
+                {
+                    TickType_t ulAge = ulTimerGetAge( &pxSegment->xTransmitTimer );
+                    TickType_t ulMaxAge = prvTCPWindowTxMaxAge( pxWindow, pxSegment );
+                    TickType_t ulLeft = ( ulMaxAge > ulAge ) ? ( ulMaxAge - ulAge ) : ( TickType_t ) 0;
+
+                    if( ( xHasOutstanding == pdFALSE ) || ( ulLeft < ulDelay ) )
+                    {
+                        ulDelay = ulLeft;
+                    }
+
+                    xHasOutstanding = pdTRUE;
+                    ulInFlight += ( uint32_t ) pxSegment->lDataLength;
+                }
+                else
+                {
+                    if( ( ulInFlight == 0U ) ||
+                        ( ( ulInFlight + ( uint32_t ) pxSegment->lDataLength ) <= ulWindowSize ) )
+                    {
+                        /* This segment may be sent now. */
+                        xReturn = pdTRUE;
+                        ulDelay = ( TickType_t ) 0;
+                    }
+
+                    break;
+                }
+            }
+
+            if( xHasOutstanding != pdFALSE )
+            {
+                /* Wake up for a retransmission. */
+                xReturn = pdTRUE;
+            }
+
+            *pulDelay = ulDelay;
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Receive a normal ACK, which may acknowledge several segments.
+ *
+ * @param[in] pxWindow The window for this particular connection.
+ * @param[in] ulSequenceNumber The sequence number of the packet.
+ *
+ * @return Number of bytes acknowledged.
+ */
+        uint32_t ulTCPWindowTxAck( TCPWindow_t * pxWindow,
+                                   uint32_t ulSequenceNumber )
+        {
+            uint32_t ulAcked = 0U;
+
+            while( pxWindow->uxTxSegmentCount > 0U )
+            {
+                TCPSegment_t * pxSegment = &( pxWindow->xTxSegments[ pxWindow->uxTxSegmentFirst ] );
+                uint32_t ulDataLength = ( uint32_t ) pxSegment->lDataLength;
+
+                if( xSequenceGreaterThanOrEqual( ulSequenceNumber, pxSegment->ulSequenceNumber + ulDataLength ) == pdFALSE )
+                {
+                    /* This segment is not (completely) acknowledged. */
+                    break;
+                }
+
+                pxWindow->tx.ulCurrentSequenceNumber += ulDataLength;
+                ulAcked += ulDataLength;
+
+                if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != pdFALSE ) )
+                {
+                    FreeRTOS_debug_printf( ( "win_tx_ack: acked seqnr %u len %u\n",
+                                             ( unsigned ) ( pxSegment->ulSequenceNumber - pxWindow->tx.ulFirstSequenceNumber ),
+                                             ( unsigned ) ulDataLength ) );
+                }
+
+                pxSegment->lDataLength = 0;
+                pxSegment->u.ulFlags = 0U;
+                pxWindow->uxTxSegmentFirst = tinyTX_SEGMENT_INDEX( pxWindow, 1U );
+                pxWindow->uxTxSegmentCount--;
+            }
+
+            return ulAcked;
+        }
+
+    #endif /* ( ipconfigUSE_TCP_WIN == 0 ) && ( ipconfigTCP_TINY_TX_SEGMENT_COUNT > 1 ) */
+/*-----------------------------------------------------------*/
+
 #endif /* ipconfigUSE_TCP == 1 */
@@ -60,6 +60,36 @@
     #include "FreeRTOS_DNS.h"
 #endif
 
+#if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+
+/**
+ * @brief Account a UDP packet that the IP-task has sent to the socket that
+ *        generated it. With FREERTOS_SO_REUSEPORT, the first socket bound to
+ *        the port gets the packet.
+ *
+ * @param[in] usBoundPort The local port of the socket, as in 'usBoundPort'.
+ * @param[in] uxFrameLength The length of the frame, including the Ethernet header.
+ * @param[in] ulStartTime The value of ipconfigSOCKET_ACCOUNTING_TIME() before
+ *                        the packet was processed.
+ */
+    static void prvUDPAccountTransmission( uint16_t usBoundPort,
+                                           size_t uxFrameLength,
+                                           uint32_t ulStartTime )
+    {
+        /* The buffer may have been released already, the socket is looked up
+         * by its port number. */
+        FreeRTOS_Socket_t * pxSocket = pxUDPSocketLookup( ( UBaseType_t ) usBoundPort );
+
+        if( pxSocket != NULL )
+        {
+            ipACCOUNT_SOCKET_TX( pxSocket, uxFrameLength - ipSIZE_OF_ETH_HEADER );
+            ipACCOUNT_SOCKET_TIME( pxSocket, ullTxTime, ulStartTime );
+        }
+    }
+
+#endif /* ( ipconfigUSE_SOCKET_ACCOUNTING != 0 ) */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Process the generated UDP packet and do other checks before sending the
  *        packet such as ARP cache check and address resolution.
@@ -72,6 +102,13 @@ void vProcessGeneratedUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuff
 
     if( pxNetworkBuffer != NULL )
     {
+        #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+            const uint32_t ulAccountingStart = ipconfigSOCKET_ACCOUNTING_TIME();
+            const uint16_t usBoundPort = pxNetworkBuffer->usBoundPort;
+            const size_t uxFrameLength = pxNetworkBuffer->xDataLength;
+            const uint16_t usPort = pxNetworkBuffer->usPort;
+        #endif
+
         /* Map the UDP packet onto the start of the frame. */
 
         /* MISRA Ref 11.3.1 [Misaligned access] */
@@ -95,6 +132,14 @@ void vProcessGeneratedUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuff
                 /* do nothing, coverity happy */
                 break;
         }
+
+        #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+            /* ICMP messages are sent through here as well, they have no socket. */
+            if( usPort != ( uint16_t ) ipPACKET_CONTAINS_ICMP_DATA )
+            {
+                prvUDPAccountTransmission( usBoundPort, uxFrameLength, ulAccountingStart );
+            }
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -149,3 +194,344 @@ BaseType_t xProcessReceivedUDPPacket( NetworkBufferDescriptor_t * pxNetworkBuffe
     return xReturn;
 }
 /*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+
+/**
+ * @brief Called by a driver once a frame that has 'ucTxTimestamp' set has been
+ *        sent. The time is stored in the UDP socket that sent the frame, where
+ *        FreeRTOS_getsockopt( FREERTOS_SO_TIMESTAMP_TX ) will find it. This
+ *        function must be called from a task, not from an interrupt.
+ *
+ * @param[in] pxNetworkBuffer The frame that has been sent.
+ * @param[in] pxTimestamp The time at which it was sent.
+ */
+    void vNetworkBufferTxTimestamp( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                    const NetworkTimestamp_t * pxTimestamp )
+    {
+        FreeRTOS_Socket_t * pxSocket;
+
+        if( pxNetworkBuffer->ucTxTimestamp != pdFALSE_UNSIGNED )
+        {
+            /* The IP-task may close the socket: do not let it run while the
+             * socket is looked up and updated. */
+            vTaskSuspendAll();
+            {
+                pxSocket = pxUDPSocketLookup( ( UBaseType_t ) pxNetworkBuffer->usBoundPort );
+
+                if( ( pxSocket != NULL ) && ( pxSocket->u.xUDP.xTimestamping != pdFALSE ) )
+                {
+                    pxSocket->u.xUDP.xTxTimestamp = *pxTimestamp;
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+
+#endif /* ipconfigUSE_NETWORK_TIMESTAMPS != 0 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_UDP_CONNECT != 0 )
+
+/** @brief The number of UDP sockets that have called FreeRTOS_connect(). While
+ *         it is zero, the IP-task doesn't look for a socket to store the headers. */
+    volatile UBaseType_t uxUDPConnectedSockets = 0U;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a packet is sent to the peer that a UDP socket is connected to.
+ *
+ * @param[in] pxSocket The UDP socket.
+ * @param[in] pxNetworkBuffer The packet, with 'xIPAddress' and 'usPort' filled in.
+ *
+ * @return pdTRUE when the socket is connected and the destination is its peer.
+ */
+    static BaseType_t prvUDPConnectIsPeer( const FreeRTOS_Socket_t * pxSocket,
+                                           const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        const struct freertos_sockaddr * pxAddress = &( pxSocket->u.xUDP.xRemoteAddress );
+
+        if( ( pxSocket->u.xUDP.xConnected != pdFALSE ) &&
+            ( pxAddress->sin_port == pxNetworkBuffer->usPort ) )
+        {
+            if( pxAddress->sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
+            {
+                if( memcmp( pxAddress->sin_address.xIP_IPv6.ucBytes, pxNetworkBuffer->xIPAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            else if( pxAddress->sin_address.ulIP_IPv4 == pxNetworkBuffer->xIPAddress.ulIP_IPv4 )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                /* The packet is sent to another address. */
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Return the number of header bytes that a connected socket keeps.
+ *
+ * @param[in] pxSocket The UDP socket.
+ *
+ * @return The size of the Ethernet, IP and UDP headers.
+ */
+    static size_t prvUDPConnectHeaderSize( const FreeRTOS_Socket_t * pxSocket )
+    {
+        size_t uxSize;
+
+        if( pxSocket->u.xUDP.xRemoteAddress.sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
+        {
+            uxSize = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER;
+        }
+        else
+        {
+            uxSize = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER;
+        }
+
+        return uxSize;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task just before a UDP packet is passed to the
+ *        driver. When the sending socket is connected to the destination,
+ *        it keeps a copy of the headers, along with the end-point.
+ *
+ * @param[in] pxNetworkBuffer The packet with complete headers.
+ */
+    void vUDPConnectStoreHeader( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        FreeRTOS_Socket_t * pxSocket;
+
+        if( uxUDPConnectedSockets != 0U )
+        {
+            pxSocket = pxUDPSocketLookup( ( UBaseType_t ) pxNetworkBuffer->usBoundPort );
+
+            if( ( pxSocket != NULL ) && ( prvUDPConnectIsPeer( pxSocket, pxNetworkBuffer ) != pdFALSE ) )
+            {
+                taskENTER_CRITICAL();
+                {
+                    ( void ) memcpy( pxSocket->u.xUDP.ucHeader, pxNetworkBuffer->pucEthernetBuffer, prvUDPConnectHeaderSize( pxSocket ) );
+                    pxSocket->u.xUDP.pxHeaderEndPoint = pxNetworkBuffer->pxEndPoint;
+                    pxSocket->u.xUDP.ulHeaderGeneration = ulIPHeaderCacheGeneration;
+                    pxSocket->u.xUDP.xHeaderValid = pdTRUE;
+                }
+                taskEXIT_CRITICAL();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by FreeRTOS_sendto() for a packet that is sent to the peer of
+ *        a connected socket. The headers kept in the socket are copied to the
+ *        packet and the lengths and checksums are filled in, so the IP-task
+ *        doesn't have to look up the end-point or the MAC address.
+ *
+ * @param[in] pxSocket The UDP socket.
+ * @param[in] pxNetworkBuffer The packet, as prepared by prvPrepareUDPPacket().
+ *
+ * @return pdTRUE when the packet can be passed to the driver as it is.
+ *         pdFALSE when the IP-task must process it with vProcessGeneratedUDPPacket().
+ */
+    BaseType_t xUDPConnectFillHeader( const struct xSOCKET * pxSocket,
+                                      NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xReturn = pdFALSE;
+        size_t uxHeaderSize;
+
+        #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+            uint8_t ucSocketOptions = pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_OPTIONS_OFFSET ];
+            BaseType_t xChecksumInSoftware;
+        #endif
+
+        if( prvUDPConnectIsPeer( pxSocket, pxNetworkBuffer ) != pdFALSE )
+        {
+            uxHeaderSize = prvUDPConnectHeaderSize( pxSocket );
+
+            taskENTER_CRITICAL();
+            {
+                if( ( pxSocket->u.xUDP.xHeaderValid != pdFALSE ) &&
+                    ( pxSocket->u.xUDP.ulHeaderGeneration == ulIPHeaderCacheGeneration ) )
+                {
+                    ( void ) memcpy( pxNetworkBuffer->pucEthernetBuffer, pxSocket->u.xUDP.ucHeader, uxHeaderSize );
+                    pxNetworkBuffer->pxEndPoint = pxSocket->u.xUDP.pxHeaderEndPoint;
+                    xReturn = pdTRUE;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        #if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+            if( ( xReturn != pdFALSE ) &&
+                ( ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) > uxInterfaceMTU( pxNetworkBuffer->pxEndPoint->pxNetworkInterface ) ) )
+            {
+                /* The datagram must be sent in fragments by the IP-task. */
+                xReturn = pdFALSE;
+            }
+        #endif
+
+        if( xReturn != pdFALSE )
+        {
+            UDPHeader_t * pxUDPHeader;
+
+            #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+            {
+                xChecksumInSoftware = ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer );
+            }
+            #endif
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxUDPHeader = ( ( UDPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ uxHeaderSize - ipSIZE_OF_UDP_HEADER ] ) );
+            pxUDPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( pxNetworkBuffer->xDataLength - ( uxHeaderSize - ipSIZE_OF_UDP_HEADER ) ) );
+            pxUDPHeader->usChecksum = 0U;
+
+            if( pxSocket->u.xUDP.xRemoteAddress.sin_family == ( uint8_t ) FREERTOS_AF_INET6 )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                pxIPHeader_IPv6->usPayloadLength = pxUDPHeader->usLength;
+            }
+            else
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                IPHeader_t * pxIPHeader = ( ( IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) );
+
+                #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+                {
+                    pxIPHeader->usHeaderChecksum = 0U;
+
+                    if( xChecksumInSoftware != pdFALSE )
+                    {
+                        pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER );
+                        pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+                    }
+                }
+                #endif
+            }
+
+            #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+            {
+                if( ( xChecksumInSoftware != pdFALSE ) &&
+                    ( ( ucSocketOptions & ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) != 0U ) )
+                {
+                    ( void ) usGenerateProtocolChecksum( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, pdTRUE );
+                }
+            }
+            #endif
+
+            #if ( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 )
+            {
+                if( pxNetworkBuffer->xDataLength < ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES )
+                {
+                    ( void ) memset( &( pxNetworkBuffer->pucEthernetBuffer[ pxNetworkBuffer->xDataLength ] ), 0, ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES - pxNetworkBuffer->xDataLength );
+                    pxNetworkBuffer->xDataLength = ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES;
+                }
+            }
+            #endif
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task for an eStackTxReadyEvent: the headers of the
+ *        packet were filled in by xUDPConnectFillHeader(), so it can be
+ *        passed to the driver directly.
+ *
+ * @param[in] pxNetworkBuffer The packet to be sent.
+ */
+    void vUDPConnectOutput( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        const NetworkEndPoint_t * pxEndPoint = pxNetworkBuffer->pxEndPoint;
+        NetworkInterface_t * pxInterface = NULL;
+
+        #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+            const uint32_t ulAccountingStart = ipconfigSOCKET_ACCOUNTING_TIME();
+            const uint16_t usBoundPort = pxNetworkBuffer->usBoundPort;
+            const size_t uxFrameLength = pxNetworkBuffer->xDataLength;
+        #endif
+
+        if( ( pxEndPoint != NULL ) && ( pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED ) )
+        {
+            pxInterface = pxEndPoint->pxNetworkInterface;
+        }
+
+        if( ( pxInterface != NULL ) && ( pxInterface->pfOutput != NULL ) )
+        {
+            iptraceSENDING_UDP_PACKET( pxNetworkBuffer->xIPAddress.ulIP_IPv4 );
+            iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+            ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+
+            #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+            {
+                prvUDPAccountTransmission( usBoundPort, uxFrameLength, ulAccountingStart );
+            }
+            #endif
+        }
+        else
+        {
+            /* The end-point went down after the headers were filled in. */
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+
+/**
+ * @brief Pass a packet with headers filled in by xUDPConnectFillHeader() to
+ *        the driver from the calling task, without involving the IP-task.
+ *
+ * @param[in] pxNetworkBuffer The packet to be sent.
+ *
+ * @return pdPASS when the packet was passed to the driver. pdFAIL when the
+ *         interface has no transmit mutex or the end-point is down; the
+ *         caller still owns the packet in that case.
+ */
+        BaseType_t xUDPConnectDirectOutput( NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            const NetworkEndPoint_t * pxEndPoint = pxNetworkBuffer->pxEndPoint;
+            NetworkInterface_t * pxInterface = NULL;
+            BaseType_t xReturn = pdFAIL;
+
+            if( ( pxEndPoint != NULL ) && ( pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED ) )
+            {
+                pxInterface = pxEndPoint->pxNetworkInterface;
+            }
+
+            if( ( pxInterface != NULL ) && ( pxInterface->pfOutput != NULL ) && ( pxInterface->xTxMutex != NULL ) )
+            {
+                iptraceSENDING_UDP_PACKET( pxNetworkBuffer->xIPAddress.ulIP_IPv4 );
+                iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+                ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+                xReturn = pdPASS;
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ipconfigUSE_UDP_DIRECT_TX */
+
+#endif /* ipconfigUSE_UDP_CONNECT */
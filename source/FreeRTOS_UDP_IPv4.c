@@ -54,6 +54,7 @@
 #include "FreeRTOS_IP_Utils.h"
 #include "NetworkInterface.h"
 #include "NetworkBufferManagement.h"
+#include "FreeRTOS_IP_Fragment.h"
 
 #if ( ipconfigUSE_DNS == 1 )
     #include "FreeRTOS_DNS.h"
@@ -75,7 +76,7 @@
 void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer )
 {
     UDPPacket_t * pxUDPPacket;
-    IPHeader_t * pxIPHeader;
+    IPHeaderView_t * pxIPHeader;
     eARPLookupResult_t eReturned;
     uint32_t ulIPAddress = pxNetworkBuffer->xIPAddress.ulIP_IPv4;
     NetworkEndPoint_t * pxEndPoint = pxNetworkBuffer->pxEndPoint;
@@ -110,6 +111,16 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
         pxNetworkBuffer->pxEndPoint = pxEndPoint;
     }
 
+    #if ( ipconfigUSE_INTERFACE_MTU != 0 ) && ( ipconfigUSE_IP_FRAGMENTATION == 0 )
+        if( ( pxEndPoint != NULL ) &&
+            ( ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) > uxInterfaceMTU( pxEndPoint->pxNetworkInterface ) ) )
+        {
+            /* The packet does not fit in the MTU of the outgoing interface. */
+            iptraceSENDTO_DATA_TOO_LONG();
+            eReturned = eCantSendPacket;
+        }
+    #endif
+
     if( eReturned != eCantSendPacket )
     {
         if( eReturned == eARPCacheHit )
@@ -135,10 +146,18 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
             #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
                 uint8_t ucSocketOptions;
             #endif
+            #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+                uint8_t ucDSCP;
+            #endif
             iptraceSENDING_UDP_PACKET( pxNetworkBuffer->xIPAddress.ulIP_IPv4 );
 
             /* Create short cuts to the data within the packet. */
-            pxIPHeader = &( pxUDPPacket->xIPHeader );
+            ipASSERT_IP_HEADER_ALIGNED( pxNetworkBuffer->pucEthernetBuffer );
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxIPHeader = ( ( IPHeaderView_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
 
             #if ( ipconfigSUPPORT_OUTGOING_PINGS == 1 )
 
@@ -147,9 +166,12 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
                 if( pxNetworkBuffer->usPort != ( uint16_t ) ipPACKET_CONTAINS_ICMP_DATA )
             #endif /* ipconfigSUPPORT_OUTGOING_PINGS */
             {
-                UDPHeader_t * pxUDPHeader;
+                UDPHeaderView_t * pxUDPHeader;
 
-                pxUDPHeader = &( pxUDPPacket->xUDPHeader );
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxUDPHeader = ( ( UDPHeaderView_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER ] ) );
 
                 pxUDPHeader->usDestinationPort = pxNetworkBuffer->usPort;
                 pxUDPHeader->usSourcePort = pxNetworkBuffer->usBoundPort;
@@ -179,6 +201,11 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
                 ucSocketOptions = pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_OPTIONS_OFFSET ];
             }
             #endif
+            #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+            {
+                ucDSCP = pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_DSCP_OFFSET ];
+            }
+            #endif
 
             /*
              * Offset the memcpy by the size of a MAC address to start at the packet's
@@ -205,6 +232,10 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
             #endif /* ipconfigSUPPORT_OUTGOING_PINGS */
             {
                 pxIPHeader->usLength = ( uint16_t ) ( uxPayloadSize + sizeof( IPHeader_t ) + sizeof( UDPHeader_t ) );
+
+                #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+                    pxIPHeader->ucDifferentiatedServicesCode = ( uint8_t ) ( ucDSCP << ipDSCP_SHIFT );
+                #endif
             }
 
             pxIPHeader->usLength = FreeRTOS_htons( pxIPHeader->usLength );
@@ -246,17 +277,20 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
 
             #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
             {
-                pxIPHeader->usHeaderChecksum = 0U;
-                pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderSizePacket( pxNetworkBuffer ) );
-                pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
-
-                if( ( ucSocketOptions & ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) != 0U )
+                if( ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) != pdFALSE )
                 {
-                    ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxUDPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
-                }
-                else
-                {
-                    pxUDPPacket->xUDPHeader.usChecksum = 0U;
+                    pxIPHeader->usHeaderChecksum = 0U;
+                    pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderSizePacket( pxNetworkBuffer ) );
+                    pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+
+                    if( ( ucSocketOptions & ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) != 0U )
+                    {
+                        ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxUDPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                    }
+                    else
+                    {
+                        pxUDPPacket->xUDPHeader.usChecksum = 0U;
+                    }
                 }
             }
             #endif /* if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) */
@@ -283,6 +317,14 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
             else
             {
                 pxNetworkBuffer->xIPAddress.ulIP_IPv4 = ulIPAddress;
+
+                #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+                {
+                    /* The buffer becomes an ARP request, its time is of no interest. */
+                    pxNetworkBuffer->ucTxTimestamp = pdFALSE_UNSIGNED;
+                }
+                #endif
+
                 vARPGenerateRequestPacket( pxNetworkBuffer );
             }
         }
@@ -323,11 +365,33 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
                 }
             }
             #endif /* if( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 ) */
+
+            #if ( ipconfigUSE_UDP_CONNECT != 0 )
+            {
+                if( ( eReturned == eARPCacheHit ) && ( pxNetworkBuffer->usPort != ( uint16_t ) ipPACKET_CONTAINS_ICMP_DATA ) )
+                {
+                    /* A connected socket keeps a copy of the headers. */
+                    vUDPConnectStoreHeader( pxNetworkBuffer );
+                }
+            }
+            #endif
+
             iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
 
             if( ( pxInterface != NULL ) && ( pxInterface->pfOutput != NULL ) )
             {
-                ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+                #if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+                    if( ( eReturned == eARPCacheHit ) &&
+                        ( ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) > uxInterfaceMTU( pxInterface ) ) )
+                    {
+                        /* The datagram is sent in fragments. */
+                        vIPFragmentOutput( pxInterface, pxNetworkBuffer, uxInterfaceMTU( pxInterface ) );
+                    }
+                    else
+                #endif
+                {
+                    ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+                }
             }
         }
         else
@@ -363,10 +427,24 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
     FreeRTOS_Socket_t * pxSocket;
     const UDPPacket_t * pxUDPPacket;
     const NetworkEndPoint_t * pxEndpoint;
+    #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+        BaseType_t xBufferTaken = pdFALSE;
+    #endif
+    #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+        const uint32_t ulAccountingStart = ipconfigSOCKET_ACCOUNTING_TIME();
+        size_t uxAccountingLength;
+    #endif
 
     configASSERT( pxNetworkBuffer != NULL );
     configASSERT( pxNetworkBuffer->pucEthernetBuffer != NULL );
 
+    #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+    {
+        /* Once the packet is queued, the buffer belongs to the reader. */
+        uxAccountingLength = pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER;
+    }
+    #endif
+
     /* Map the ethernet buffer to the UDPPacket_t struct for easy access to the fields. */
 
     /* MISRA Ref 11.3.1 [Misaligned access] */
@@ -378,6 +456,21 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
     /* Caller must check for minimum packet size. */
     pxSocket = pxUDPSocketLookup( usPort );
 
+    #if ( ipconfigUSE_UDP_REUSEPORT != 0 )
+        if( ( pxSocket != NULL ) && ( pxSocket->u.xUDP.xReusePort != pdFALSE ) )
+        {
+            pxSocket = pxUDPSocketSelectReusePort( pxSocket, pxNetworkBuffer, pdFALSE );
+        }
+    #endif
+
+    #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+        if( ( pxSocket != NULL ) && ( pxSocket->bits.bV6Only != pdFALSE_UNSIGNED ) )
+        {
+            /* The socket does not want to handle IPv4 traffic. */
+            pxSocket = NULL;
+        }
+    #endif
+
     *pxIsWaitingForARPResolution = pdFALSE;
 
     do
@@ -425,6 +518,11 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
                     destinationAddress.sin_family = ( uint8_t ) FREERTOS_AF_INET4;
                     destinationAddress.sin_len = ( uint8_t ) sizeof( destinationAddress );
 
+                    #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+                        /* The handler may take the network buffer. */
+                        vSocketRxBufferOffer( pxSocket, pxNetworkBuffer, 0U );
+                    #endif
+
                     /* The value of 'xDataLength' was proven to be at least the size of a UDP packet in prvProcessIPPacket(). */
                     if( xHandler( ( Socket_t ) pxSocket,
                                   ( void * ) pcData,
@@ -434,6 +532,15 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
                     {
                         xReturn = pdFAIL; /* xHandler has consumed the data, do not add it to .xWaitingPacketsList'. */
                     }
+
+                    #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+                        if( xSocketRxBufferTaken( NULL ) != pdFALSE )
+                        {
+                            /* The application owns the buffer now. */
+                            xBufferTaken = pdTRUE;
+                            xReturn = pdFAIL;
+                        }
+                    #endif
                 }
             }
             #endif /* ipconfigUSE_CALLBACKS */
@@ -444,16 +551,51 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
                 {
                     if( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) >= pxSocket->u.xUDP.uxMaxPackets )
                     {
-                        FreeRTOS_debug_printf( ( "xProcessReceivedUDPPacket: buffer full %ld >= %ld port %u\n",
-                                                 listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ),
-                                                 pxSocket->u.xUDP.uxMaxPackets, pxSocket->usLocalPort ) );
-                        xReturn = pdFAIL; /* we did not consume or release the buffer */
+                        if( ( pxSocket->u.xUDP.xDropOldest != pdFALSE ) &&
+                            ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
+                        {
+                            NetworkBufferDescriptor_t * pxOldestBuffer;
+
+                            /* Make room by dropping the packet that has been
+                             * waiting the longest. */
+                            vTaskSuspendAll();
+                            {
+                                pxOldestBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) );
+                                ( void ) uxListRemove( &( pxOldestBuffer->xBufferListItem ) );
+                            }
+                            ( void ) xTaskResumeAll();
+
+                            vSocketMemoryRelease( pxOldestBuffer->xDataLength );
+
+                            ipCOUNT_RX_DROP( pxOldestBuffer->pxInterface, eDropSocketQueueFull );
+                            vReleaseNetworkBufferAndDescriptor( pxOldestBuffer );
+                        }
+                        else
+                        {
+                            FreeRTOS_debug_printf( ( "xProcessReceivedUDPPacket: buffer full %ld >= %ld port %u\n",
+                                                     listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ),
+                                                     pxSocket->u.xUDP.uxMaxPackets, pxSocket->usLocalPort ) );
+                            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropSocketQueueFull );
+                            xReturn = pdFAIL; /* we did not consume or release the buffer */
+                        }
                     }
                 }
             }
             #endif /* if ( ipconfigUDP_MAX_RX_PACKETS > 0U ) */
 
-            #if ( ipconfigUSE_CALLBACKS == 1 ) || ( ipconfigUDP_MAX_RX_PACKETS > 0U )
+            #if ( ipconfigUSE_SOCKET_MEMORY_BUDGET != 0 )
+            {
+                /* Drop early when the sockets hold too much memory. */
+                if( ( xReturn == pdPASS ) &&
+                    ( xSocketMemoryAdmitUDP( pxSocket, pxNetworkBuffer->xDataLength ) == pdFAIL ) )
+                {
+                    ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropSocketQueueFull );
+                    xReturn = pdFAIL;
+                }
+            }
+            #endif
+
+            #if ( ipconfigUSE_CALLBACKS == 1 ) || ( ipconfigUDP_MAX_RX_PACKETS > 0U ) || ( ipconfigUSE_SOCKET_MEMORY_BUDGET != 0 )
                 if( xReturn == pdPASS ) /*lint !e774: Boolean within 'if' always evaluates to True, depending on configuration. [MISRA 2012 Rule 14.3, required. */
             #else
                 /* xReturn is still pdPASS. */
@@ -468,9 +610,11 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
                 ( void ) xTaskResumeAll();
 
                 /* Set the socket's receive event */
-                if( pxSocket->xEventGroup != NULL )
+                #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+                    if( pxSocket->xEventGroup != NULL )
+                #endif
                 {
-                    ( void ) xEventGroupSetBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_RECEIVE );
+                    vSocketEventSet( pxSocket, ( EventBits_t ) eSOCKET_RECEIVE );
                 }
 
                 #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
@@ -491,6 +635,16 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
                 }
                 #endif
 
+                #if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+                {
+                    if( pxSocket->pxAsyncRing != NULL )
+                    {
+                        /* A pending eAsyncRecv may complete now. */
+                        vSocketAsyncWakeUp( pxSocket );
+                    }
+                }
+                #endif
+
                 #if ( ipconfigUSE_DHCP == 1 )
                 {
                     if( xIsDHCPSocket( pxSocket ) != 0 )
@@ -500,6 +654,17 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
                 }
                 #endif
             }
+
+            #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+                if( xBufferTaken != pdFALSE )
+                {
+                    /* The buffer must not be released by the caller. */
+                    xReturn = pdPASS;
+                }
+            #endif
+
+            ipACCOUNT_SOCKET_RX( pxSocket, uxAccountingLength );
+            ipACCOUNT_SOCKET_TIME( pxSocket, ullRxTime, ulAccountingStart );
         }
         else
         {
@@ -566,6 +731,7 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
                 else
             #endif /* ipconfigUSE_NBNS */
             {
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropNoSocket );
                 xReturn = pdFAIL;
             }
         }
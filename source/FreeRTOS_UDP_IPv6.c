@@ -55,6 +55,7 @@
 #include "FreeRTOS_IP_Utils.h"
 #include "NetworkInterface.h"
 #include "NetworkBufferManagement.h"
+#include "FreeRTOS_IP_Fragment.h"
 
 #if ( ipconfigUSE_DNS == 1 )
     #include "FreeRTOS_DNS.h"
@@ -141,6 +142,14 @@ static eARPLookupResult_t prvStartLookup( NetworkBufferDescriptor_t * const pxNe
 
     if( pxNetworkBuffer->pxEndPoint != NULL )
     {
+        #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+        {
+            /* The buffer becomes a neighbour solicitation, its time is of no
+             * interest. */
+            pxNetworkBuffer->ucTxTimestamp = pdFALSE_UNSIGNED;
+        }
+        #endif
+
         vNDSendNeighbourSolicitation( pxNetworkBuffer, &( pxNetworkBuffer->xIPAddress.xIP_IPv6 ) );
 
         /* pxNetworkBuffer has been sent and released.
@@ -199,6 +208,16 @@ void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetwor
     eReturned = eNDGetCacheEntry( &( pxNetworkBuffer->xIPAddress.xIP_IPv6 ), &( pxUDPPacket_IPv6->xEthernetHeader.xDestinationAddress ),
                                   &( pxEndPoint ) );
 
+    #if ( ipconfigUSE_INTERFACE_MTU != 0 ) && ( ipconfigUSE_IP_FRAGMENTATION == 0 )
+        if( ( pxEndPoint != NULL ) &&
+            ( ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) > uxInterfaceMTU( pxEndPoint->pxNetworkInterface ) ) )
+        {
+            /* The packet does not fit in the MTU of the outgoing interface. */
+            iptraceSENDTO_DATA_TOO_LONG();
+            eReturned = eCantSendPacket;
+        }
+    #endif
+
     if( eReturned != eCantSendPacket )
     {
         if( eReturned == eARPCacheHit )
@@ -231,6 +250,16 @@ void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetwor
                 pxIPHeader_IPv6->ucTrafficClassFlow = 0;
                 pxIPHeader_IPv6->usFlowLabel = 0;
                 pxIPHeader_IPv6->ucHopLimit = 255;
+
+                #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+                {
+                    /* The traffic class straddles the first two bytes. */
+                    uint8_t ucTrafficClass = ( uint8_t ) ( pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_DSCP_OFFSET ] << ipDSCP_SHIFT );
+
+                    pxIPHeader_IPv6->ucVersionTrafficClass |= ( uint8_t ) ( ucTrafficClass >> 4 );
+                    pxIPHeader_IPv6->ucTrafficClassFlow = ( uint8_t ) ( ucTrafficClass << 4 );
+                }
+                #endif
                 pxUDPHeader->usLength = ( uint16_t ) ( pxNetworkBuffer->xDataLength - ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ) );
 
                 pxIPHeader_IPv6->ucNextHeader = ipPROTOCOL_UDP;
@@ -287,13 +316,16 @@ void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetwor
 
             #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
             {
-                if( ( ucSocketOptions & ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) != 0U )
-                {
-                    ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxUDPPacket_IPv6, pxNetworkBuffer->xDataLength, pdTRUE );
-                }
-                else
+                if( ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer ) != pdFALSE )
                 {
-                    pxUDPPacket_IPv6->xUDPHeader.usChecksum = 0U;
+                    if( ( ucSocketOptions & ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) != 0U )
+                    {
+                        ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxUDPPacket_IPv6, pxNetworkBuffer->xDataLength, pdTRUE );
+                    }
+                    else
+                    {
+                        pxUDPPacket_IPv6->xUDPHeader.usChecksum = 0U;
+                    }
                 }
             }
             #endif /* if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) */
@@ -350,8 +382,30 @@ void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetwor
                 }
             }
             #endif /* if( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 ) */
+
+            #if ( ipconfigUSE_UDP_CONNECT != 0 )
+            {
+                if( ( eReturned == eARPCacheHit ) && ( pxNetworkBuffer->usPort != ( uint16_t ) ipPACKET_CONTAINS_ICMP_DATA ) )
+                {
+                    /* A connected socket keeps a copy of the headers. */
+                    vUDPConnectStoreHeader( pxNetworkBuffer );
+                }
+            }
+            #endif
+
             iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
-            ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+
+            #if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+                if( ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) > uxInterfaceMTU( pxInterface ) )
+                {
+                    /* The datagram is sent in fragments. */
+                    vIPFragmentOutput( pxInterface, pxNetworkBuffer, uxInterfaceMTU( pxInterface ) );
+                }
+                else
+            #endif
+            {
+                ( void ) xIPInterfaceOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+            }
         }
         else
         {
@@ -386,10 +440,24 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
     BaseType_t xReturn = pdPASS;
     FreeRTOS_Socket_t * pxSocket;
     const UDPPacket_IPv6_t * pxUDPPacket_IPv6;
+    #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+        BaseType_t xBufferTaken = pdFALSE;
+    #endif
+    #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+        const uint32_t ulAccountingStart = ipconfigSOCKET_ACCOUNTING_TIME();
+        size_t uxAccountingLength;
+    #endif
 
     configASSERT( pxNetworkBuffer != NULL );
     configASSERT( pxNetworkBuffer->pucEthernetBuffer != NULL );
 
+    #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+    {
+        /* Once the packet is queued, the buffer belongs to the reader. */
+        uxAccountingLength = pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER;
+    }
+    #endif
+
     /* When refreshing the ARP/ND cache with received UDP packets we must be
      * careful;  hundreds of broadcast messages may pass and if we're not
      * handling them, no use to fill the cache with those IP addresses. */
@@ -402,6 +470,13 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
     /* Caller must check for minimum packet size. */
     pxSocket = pxUDPSocketLookup( usPort );
 
+    #if ( ipconfigUSE_UDP_REUSEPORT != 0 )
+        if( ( pxSocket != NULL ) && ( pxSocket->u.xUDP.xReusePort != pdFALSE ) )
+        {
+            pxSocket = pxUDPSocketSelectReusePort( pxSocket, pxNetworkBuffer, pdTRUE );
+        }
+    #endif
+
     *pxIsWaitingForARPResolution = pdFALSE;
 
     do
@@ -413,6 +488,7 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
             FreeRTOS_debug_printf( ( "xProcessReceivedUDPPacket_IPv6: Drop packets with checksum %d\n",
                                      pxUDPPacket_IPv6->xUDPHeader.usChecksum ) );
 
+            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropChecksum );
             xReturn = pdFAIL;
             break;
         }
@@ -456,6 +532,11 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
                     destinationAddress.sin_len = ( uint8_t ) sizeof( destinationAddress );
                     uxPayloadSize = pxNetworkBuffer->xDataLength - ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_UDP_HEADER + ( size_t ) ipSIZE_OF_IPv6_HEADER );
 
+                    #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+                        /* The handler may take the network buffer. */
+                        vSocketRxBufferOffer( pxSocket, pxNetworkBuffer, 0U );
+                    #endif
+
                     /* The value of 'xDataLength' was proven to be at least the size of a UDP packet in prvProcessIPPacket(). */
                     if( xHandler( ( Socket_t ) pxSocket,
                                   ( void * ) pcData,
@@ -465,6 +546,15 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
                     {
                         xReturn = pdFAIL; /* xHandler has consumed the data, do not add it to .xWaitingPacketsList'. */
                     }
+
+                    #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+                        if( xSocketRxBufferTaken( NULL ) != pdFALSE )
+                        {
+                            /* The application owns the buffer now. */
+                            xBufferTaken = pdTRUE;
+                            xReturn = pdFAIL;
+                        }
+                    #endif
                 }
             }
             #endif /* ipconfigUSE_CALLBACKS */
@@ -475,16 +565,51 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
                 {
                     if( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) >= pxSocket->u.xUDP.uxMaxPackets )
                     {
-                        FreeRTOS_debug_printf( ( "xProcessReceivedUDPPacket: buffer full %ld >= %ld port %u\n",
-                                                 listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ),
-                                                 pxSocket->u.xUDP.uxMaxPackets, pxSocket->usLocalPort ) );
-                        xReturn = pdFAIL; /* we did not consume or release the buffer */
+                        if( ( pxSocket->u.xUDP.xDropOldest != pdFALSE ) &&
+                            ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
+                        {
+                            NetworkBufferDescriptor_t * pxOldestBuffer;
+
+                            /* Make room by dropping the packet that has been
+                             * waiting the longest. */
+                            vTaskSuspendAll();
+                            {
+                                pxOldestBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) );
+                                ( void ) uxListRemove( &( pxOldestBuffer->xBufferListItem ) );
+                            }
+                            ( void ) xTaskResumeAll();
+
+                            vSocketMemoryRelease( pxOldestBuffer->xDataLength );
+
+                            ipCOUNT_RX_DROP( pxOldestBuffer->pxInterface, eDropSocketQueueFull );
+                            vReleaseNetworkBufferAndDescriptor( pxOldestBuffer );
+                        }
+                        else
+                        {
+                            FreeRTOS_debug_printf( ( "xProcessReceivedUDPPacket: buffer full %ld >= %ld port %u\n",
+                                                     listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ),
+                                                     pxSocket->u.xUDP.uxMaxPackets, pxSocket->usLocalPort ) );
+                            ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropSocketQueueFull );
+                            xReturn = pdFAIL; /* we did not consume or release the buffer */
+                        }
                     }
                 }
             }
             #endif /* if ( ipconfigUDP_MAX_RX_PACKETS > 0U ) */
 
-            #if ( ipconfigUSE_CALLBACKS == 1 ) || ( ipconfigUDP_MAX_RX_PACKETS > 0U )
+            #if ( ipconfigUSE_SOCKET_MEMORY_BUDGET != 0 )
+            {
+                /* Drop early when the sockets hold too much memory. */
+                if( ( xReturn == pdPASS ) &&
+                    ( xSocketMemoryAdmitUDP( pxSocket, pxNetworkBuffer->xDataLength ) == pdFAIL ) )
+                {
+                    ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropSocketQueueFull );
+                    xReturn = pdFAIL;
+                }
+            }
+            #endif
+
+            #if ( ipconfigUSE_CALLBACKS == 1 ) || ( ipconfigUDP_MAX_RX_PACKETS > 0U ) || ( ipconfigUSE_SOCKET_MEMORY_BUDGET != 0 )
                 if( xReturn == pdPASS ) /*lint !e774: Boolean within 'if' always evaluates to True, depending on configuration. [MISRA 2012 Rule 14.3, required. */
             #else
                 /* xReturn is still pdPASS. */
@@ -499,9 +624,11 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
                 ( void ) xTaskResumeAll();
 
                 /* Set the socket's receive event */
-                if( pxSocket->xEventGroup != NULL )
+                #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+                    if( pxSocket->xEventGroup != NULL )
+                #endif
                 {
-                    ( void ) xEventGroupSetBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_RECEIVE );
+                    vSocketEventSet( pxSocket, ( EventBits_t ) eSOCKET_RECEIVE );
                 }
 
                 #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
@@ -522,6 +649,16 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
                 }
                 #endif
 
+                #if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+                {
+                    if( pxSocket->pxAsyncRing != NULL )
+                    {
+                        /* A pending eAsyncRecv may complete now. */
+                        vSocketAsyncWakeUp( pxSocket );
+                    }
+                }
+                #endif
+
                 #if ( ipconfigUSE_DHCP == 1 )
                 {
                     if( xIsDHCPSocket( pxSocket ) != 0 )
@@ -531,6 +668,17 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
                 }
                 #endif
             }
+
+            #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+                if( xBufferTaken != pdFALSE )
+                {
+                    /* The buffer must not be released by the caller. */
+                    xReturn = pdPASS;
+                }
+            #endif
+
+            ipACCOUNT_SOCKET_RX( pxSocket, uxAccountingLength );
+            ipACCOUNT_SOCKET_TIME( pxSocket, ullRxTime, ulAccountingStart );
         }
         else
         {
@@ -580,6 +728,7 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
                 else
             #endif /* ipconfigUSE_NBNS */
             {
+                ipCOUNT_RX_DROP( pxNetworkBuffer->pxInterface, eDropNoSocket );
                 xReturn = pdFAIL;
             }
         }
@@ -0,0 +1,435 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_VLAN.c
+ * @brief Implements the 802.1Q VLAN interfaces: virtual interfaces that carry
+ *        the tagged traffic of one VLAN over a physical interface.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_VLAN.h"
+#include "NetworkInterface.h"
+#include "NetworkBufferManagement.h"
+
+/* *INDENT-OFF* */
+#if ( ipconfigUSE_VLAN != 0 )
+/* *INDENT-ON* */
+
+/** @brief The 802.1Q tag follows the two MAC addresses. */
+#define ipVLAN_TAG_OFFSET    ( 2U * ipMAC_ADDRESS_LENGTH_BYTES )
+
+/** @brief The size of an 802.1Q tag: the TPID 0x8100 and the tag itself. */
+#define ipVLAN_TAG_SIZE      ( ( size_t ) ipSIZE_OF_ETH_OPTIONAL_802_1Q_TAG_BYTES )
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the VLAN interface of a physical interface with a given VLAN ID.
+ *
+ * @param[in] pxParent The physical interface.
+ * @param[in] usVLANTag The tag, of which only the VLAN ID is compared.
+ *
+ * @return The VLAN interface, or NULL when the VLAN is unknown.
+ */
+static NetworkInterface_t * prvVLANFind( const NetworkInterface_t * pxParent,
+                                         uint16_t usVLANTag )
+{
+    NetworkInterface_t * pxInterface;
+
+    for( pxInterface = FreeRTOS_FirstNetworkInterface();
+         pxInterface != NULL;
+         pxInterface = FreeRTOS_NextNetworkInterface( pxInterface ) )
+    {
+        if( ( pxInterface->pxVLANParent == pxParent ) &&
+            ( ( pxInterface->usVLANTag & ipVLAN_ID_MASK ) == ( usVLANTag & ipVLAN_ID_MASK ) ) )
+        {
+            break;
+        }
+    }
+
+    return pxInterface;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Insert the 802.1Q tag of a VLAN interface into an outgoing frame.
+ *
+ * @param[in] pxInterface The VLAN interface.
+ * @param[in] pxNetworkBuffer The untagged frame.
+ * @param[in] xReleaseAfterSend pdFALSE when the caller keeps the ownership of
+ *                              the frame, in which case it will not be changed.
+ *
+ * @return The tagged frame, which belongs to the caller of the driver, or NULL
+ *         when no network buffer was available.
+ */
+static NetworkBufferDescriptor_t * prvVLANInsertTag( const NetworkInterface_t * pxInterface,
+                                                     NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                     BaseType_t xReleaseAfterSend )
+{
+    NetworkBufferDescriptor_t * pxBuffer = pxNetworkBuffer;
+    size_t uxLength = pxNetworkBuffer->xDataLength;
+    uint8_t * pucTag;
+
+    if( ( xReleaseAfterSend != pdFALSE ) &&
+        ( xIsFixedSizeNetworkBuffer( pxBuffer ) != pdFALSE ) &&
+        ( ( uxLength + ipVLAN_TAG_SIZE ) <= ( size_t ) ipTOTAL_ETHERNET_FRAME_SIZE ) )
+    {
+        /* A fixed size buffer has room for the tag, move the frame up. */
+        ( void ) memmove( &( pxBuffer->pucEthernetBuffer[ ipVLAN_TAG_OFFSET + ipVLAN_TAG_SIZE ] ),
+                          &( pxBuffer->pucEthernetBuffer[ ipVLAN_TAG_OFFSET ] ),
+                          uxLength - ipVLAN_TAG_OFFSET );
+    }
+    else
+    {
+        /* Copy the frame to a larger buffer, leaving a gap for the tag. */
+        pxBuffer = pxGetNetworkBufferWithDescriptor( uxLength + ipVLAN_TAG_SIZE, 0U );
+
+        if( pxBuffer != NULL )
+        {
+            ( void ) memcpy( pxBuffer->pucEthernetBuffer, pxNetworkBuffer->pucEthernetBuffer, ipVLAN_TAG_OFFSET );
+            ( void ) memcpy( &( pxBuffer->pucEthernetBuffer[ ipVLAN_TAG_OFFSET + ipVLAN_TAG_SIZE ] ),
+                             &( pxNetworkBuffer->pucEthernetBuffer[ ipVLAN_TAG_OFFSET ] ),
+                             uxLength - ipVLAN_TAG_OFFSET );
+            pxBuffer->pxInterface = pxNetworkBuffer->pxInterface;
+            pxBuffer->pxEndPoint = pxNetworkBuffer->pxEndPoint;
+        }
+
+        if( xReleaseAfterSend != pdFALSE )
+        {
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+    }
+
+    if( pxBuffer != NULL )
+    {
+        pucTag = &( pxBuffer->pucEthernetBuffer[ ipVLAN_TAG_OFFSET ] );
+        pucTag[ 0 ] = 0x81U;
+        pucTag[ 1 ] = 0x00U;
+        pucTag[ 2 ] = ( uint8_t ) ( pxInterface->usVLANTag >> 8 );
+        pucTag[ 3 ] = ( uint8_t ) ( pxInterface->usVLANTag & 0xffU );
+        pxBuffer->xDataLength = uxLength + ipVLAN_TAG_SIZE;
+    }
+
+    return pxBuffer;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfInitialise() function of a VLAN interface: it is up as soon
+ *        as its physical interface is up.
+ *
+ * @param[in] pxInterface The VLAN interface.
+ *
+ * @return pdPASS when the physical interface is up, otherwise pdFAIL.
+ */
+static BaseType_t prvVLANInitialise( NetworkInterface_t * pxInterface )
+{
+    const NetworkInterface_t * pxParent = pxInterface->pxVLANParent;
+    BaseType_t xReturn = pdFAIL;
+
+    if( pxParent->bits.bInterfaceUp != pdFALSE_UNSIGNED )
+    {
+        if( pxParent->bits.bVLANTagOffload != pdFALSE_UNSIGNED )
+        {
+            /* The hardware knows about the tag, so the other offloads of the
+             * physical interface can be used as well. */
+            pxInterface->bits.bVLANTagOffload = pdTRUE_UNSIGNED;
+            pxInterface->bits.bTCPSegmentationOffload = pxParent->bits.bTCPSegmentationOffload;
+            pxInterface->bits.bRxChecksumOffload = pxParent->bits.bRxChecksumOffload;
+            pxInterface->bits.bTxChecksumOffload = pxParent->bits.bTxChecksumOffload;
+            pxInterface->bits.bScatterGather = pxParent->bits.bScatterGather;
+        }
+
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfOutput() function of a VLAN interface: pass the frame to the
+ *        physical interface, together with the tag.
+ *
+ * @param[in] pxInterface The VLAN interface.
+ * @param[in] pxNetworkBuffer The untagged frame.
+ * @param[in] xReleaseAfterSend pdTRUE when the frame must be released after sending.
+ *
+ * @return The result of the driver of the physical interface.
+ */
+static BaseType_t prvVLANOutput( NetworkInterface_t * pxInterface,
+                                 NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                 BaseType_t xReleaseAfterSend )
+{
+    NetworkInterface_t * pxParent = pxInterface->pxVLANParent;
+    NetworkBufferDescriptor_t * pxBuffer = pxNetworkBuffer;
+    BaseType_t xRelease = xReleaseAfterSend;
+    BaseType_t xReturn = pdFAIL;
+
+    if( pxParent->bits.bVLANTagOffload != pdFALSE_UNSIGNED )
+    {
+        /* The driver inserts the tag, the frame stays where it is. */
+        pxBuffer->usVLANTag = pxInterface->usVLANTag;
+    }
+    else
+    {
+        pxBuffer = prvVLANInsertTag( pxInterface, pxNetworkBuffer, xReleaseAfterSend );
+
+        /* The tagged frame belongs to the driver. */
+        xRelease = pdTRUE;
+    }
+
+    if( pxBuffer != NULL )
+    {
+        xReturn = xIPInterfaceOutput( pxParent, pxBuffer, xRelease );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfGetPhyLinkStatus() function of a VLAN interface.
+ *
+ * @param[in] pxInterface The VLAN interface.
+ *
+ * @return The link status of the physical interface.
+ */
+static BaseType_t prvVLANGetPhyLinkStatus( NetworkInterface_t * pxInterface )
+{
+    NetworkInterface_t * pxParent = pxInterface->pxVLANParent;
+    BaseType_t xReturn = pdFALSE;
+
+    if( pxParent->pfGetPhyLinkStatus != NULL )
+    {
+        xReturn = pxParent->pfGetPhyLinkStatus( pxParent );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfAddAllowedMAC() function of a VLAN interface.
+ *
+ * @param[in] pxInterface The VLAN interface.
+ * @param[in] pucMacAddressBytes The MAC address to be received.
+ */
+static void prvVLANAddAllowedMAC( NetworkInterface_t * pxInterface,
+                                  const uint8_t * pucMacAddressBytes )
+{
+    NetworkInterface_t * pxParent = pxInterface->pxVLANParent;
+
+    if( pxParent->pfAddAllowedMAC != NULL )
+    {
+        pxParent->pfAddAllowedMAC( pxParent, pucMacAddressBytes );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The pfRemoveAllowedMAC() function of a VLAN interface.
+ *
+ * @param[in] pxInterface The VLAN interface.
+ * @param[in] pucMacAddressBytes The MAC address that is no longer needed.
+ */
+static void prvVLANRemoveAllowedMAC( NetworkInterface_t * pxInterface,
+                                     const uint8_t * pucMacAddressBytes )
+{
+    NetworkInterface_t * pxParent = pxInterface->pxVLANParent;
+
+    if( pxParent->pfRemoveAllowedMAC != NULL )
+    {
+        pxParent->pfRemoveAllowedMAC( pxParent, pucMacAddressBytes );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create a virtual interface for a VLAN on top of a physical interface.
+ *
+ * @param[in] pxParent The physical interface, which has been added before.
+ * @param[in] pxInterface The object that will describe the VLAN interface.
+ *                        It must be declared static or global.
+ * @param[in] pcName The name of the interface, just for logging.
+ * @param[in] usVLANTag The 802.1Q tag of outgoing frames, see ipVLAN_TAG().
+ *                      The VLAN ID must be in the range 1..4094.
+ *
+ * @return The VLAN interface, as returned by FreeRTOS_AddNetworkInterface().
+ */
+NetworkInterface_t * FreeRTOS_FillVLANInterface( NetworkInterface_t * pxParent,
+                                                 NetworkInterface_t * pxInterface,
+                                                 const char * pcName,
+                                                 uint16_t usVLANTag )
+{
+    configASSERT( pxParent != NULL );
+    configASSERT( pxParent->pxVLANParent == NULL );
+    configASSERT( ( usVLANTag & ipVLAN_ID_MASK ) != 0U );
+    configASSERT( ( usVLANTag & ipVLAN_ID_MASK ) != ipVLAN_ID_MASK );
+    configASSERT( prvVLANFind( pxParent, usVLANTag ) == NULL );
+
+    ( void ) memset( pxInterface, 0, sizeof( *pxInterface ) );
+    pxInterface->pcName = pcName;
+    pxInterface->pfInitialise = prvVLANInitialise;
+    pxInterface->pfOutput = prvVLANOutput;
+    pxInterface->pfGetPhyLinkStatus = prvVLANGetPhyLinkStatus;
+    pxInterface->pfAddAllowedMAC = prvVLANAddAllowedMAC;
+    pxInterface->pfRemoveAllowedMAC = prvVLANRemoveAllowedMAC;
+    pxInterface->pxVLANParent = pxParent;
+    pxInterface->usVLANTag = usVLANTag;
+
+    #if ( ipconfigUSE_INTERFACE_MTU != 0 )
+    {
+        /* ipTOTAL_ETHERNET_FRAME_SIZE has room for the tag. */
+        pxInterface->uxMTU = pxParent->uxMTU;
+    }
+    #endif
+
+    return FreeRTOS_AddNetworkInterface( pxInterface );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Assign a received frame to the interface of its VLAN. A tag that
+ *        was not stripped by the hardware is removed here.
+ *
+ * @param[in] pxNetworkBuffer The frame, as received by a physical interface.
+ *
+ * @return pdFALSE when the frame belongs to an unknown VLAN, otherwise pdTRUE.
+ */
+BaseType_t xVLANReceive( NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    NetworkInterface_t * pxParent = pxNetworkBuffer->pxInterface;
+    NetworkInterface_t * pxInterface = pxParent;
+    uint8_t * pucEthernetBuffer = pxNetworkBuffer->pucEthernetBuffer;
+    uint16_t usVLANTag = pxNetworkBuffer->usVLANTag;
+    BaseType_t xReturn = pdTRUE;
+
+    /* MISRA Ref 11.3.1 [Misaligned access] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+    /* coverity[misra_c_2012_rule_11_3_violation] */
+    const EthernetHeader_t * pxEthernetHeader = ( ( const EthernetHeader_t * ) pucEthernetBuffer );
+
+    if( pxParent->pxVLANParent == NULL )
+    {
+        if( ( usVLANTag == 0U ) &&
+            ( pxNetworkBuffer->xDataLength >= ( sizeof( EthernetHeader_t ) + ipVLAN_TAG_SIZE ) ) &&
+            ( pxEthernetHeader->usFrameType == ipVLAN_FRAME_TYPE ) )
+        {
+            /* The hardware did not strip the tag: remove it here. */
+            usVLANTag = ( uint16_t ) ( ( ( uint16_t ) pucEthernetBuffer[ ipVLAN_TAG_OFFSET + 2U ] << 8 ) |
+                                       ( uint16_t ) pucEthernetBuffer[ ipVLAN_TAG_OFFSET + 3U ] );
+            ( void ) memmove( &( pucEthernetBuffer[ ipVLAN_TAG_OFFSET ] ),
+                              &( pucEthernetBuffer[ ipVLAN_TAG_OFFSET + ipVLAN_TAG_SIZE ] ),
+                              pxNetworkBuffer->xDataLength - ( ipVLAN_TAG_OFFSET + ipVLAN_TAG_SIZE ) );
+            pxNetworkBuffer->xDataLength -= ipVLAN_TAG_SIZE;
+
+            /* The end-point was found while the frame was still tagged. */
+            pxNetworkBuffer->pxEndPoint = NULL;
+        }
+
+        pxNetworkBuffer->usVLANTag = 0U;
+
+        if( ( usVLANTag & ipVLAN_ID_MASK ) != 0U )
+        {
+            pxInterface = prvVLANFind( pxParent, usVLANTag );
+
+            if( pxInterface == NULL )
+            {
+                ipCOUNT_RX_DROP( pxParent, eDropFiltered );
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                pxNetworkBuffer->pxInterface = pxInterface;
+                pxNetworkBuffer->pxEndPoint = NULL;
+            }
+        }
+
+        if( ( xReturn != pdFALSE ) &&
+            ( ( pxNetworkBuffer->pxEndPoint == NULL ) || ( pxNetworkBuffer->pxEndPoint->pxNetworkInterface != pxInterface ) ) )
+        {
+            /* The driver may have given an end-point of a VLAN interface, see
+             * pxVLANAnyEndPoint(). Look for one of the actual interface. */
+            pxNetworkBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxInterface, pucEthernetBuffer );
+
+            if( ( pxNetworkBuffer->pxEndPoint != NULL ) &&
+                ( pxNetworkBuffer->pxEndPoint->pxNetworkInterface != pxInterface ) )
+            {
+                pxNetworkBuffer->pxEndPoint = NULL;
+            }
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find any end-point of the VLAN interfaces of a physical interface.
+ *
+ * @param[in] pxParent The physical interface.
+ *
+ * @return An end-point, or NULL when the interface has no VLAN end-points.
+ */
+NetworkEndPoint_t * pxVLANAnyEndPoint( const NetworkInterface_t * pxParent )
+{
+    NetworkEndPoint_t * pxEndPoint = NULL;
+    const NetworkInterface_t * pxInterface;
+
+    for( pxInterface = FreeRTOS_FirstNetworkInterface();
+         ( pxInterface != NULL ) && ( pxEndPoint == NULL );
+         pxInterface = FreeRTOS_NextNetworkInterface( pxInterface ) )
+    {
+        if( pxInterface->pxVLANParent == pxParent )
+        {
+            pxEndPoint = FreeRTOS_FirstEndPoint( pxInterface );
+        }
+    }
+
+    return pxEndPoint;
+}
+/*-----------------------------------------------------------*/
+
+/* *INDENT-OFF* */
+#endif /* ( ipconfigUSE_VLAN != 0 ) */
+/* *INDENT-ON* */
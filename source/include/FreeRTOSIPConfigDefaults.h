@@ -254,6 +254,38 @@
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_DUAL_STACK_SOCKETS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, a socket bound to an IPv6 address also handles IPv4 traffic
+ * to the same port, like a BSD socket with IPV6_V6ONLY cleared. IPv4 peers
+ * are reported to the application as IPv4-mapped IPv6 addresses
+ * ( ::ffff:a.b.c.d ) by FreeRTOS_recvfrom(), FreeRTOS_accept() and
+ * FreeRTOS_GetRemoteAddress(). An IPv4-mapped destination passed to
+ * FreeRTOS_sendto() or FreeRTOS_connect() is sent as IPv4.
+ *
+ * A socket can opt out with the FREERTOS_SO_IPV6_V6ONLY socket option, in
+ * which case it will only handle IPv6 traffic.
+ *
+ * Requires both ipconfigUSE_IPv4 and ipconfigUSE_IPv6.
+ */
+
+#ifndef ipconfigUSE_DUAL_STACK_SOCKETS
+    #define ipconfigUSE_DUAL_STACK_SOCKETS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DUAL_STACK_SOCKETS != ipconfigDISABLE ) && ( ipconfigUSE_DUAL_STACK_SOCKETS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DUAL_STACK_SOCKETS configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DUAL_STACK_SOCKETS ) && ( ipconfigIS_DISABLED( ipconfigUSE_IPv4 ) || ipconfigIS_DISABLED( ipconfigUSE_IPv6 ) ) )
+    #error ipconfigUSE_DUAL_STACK_SOCKETS requires both ipconfigUSE_IPv4 and ipconfigUSE_IPv6
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigND_CACHE_ENTRIES
  *
@@ -279,6 +311,90 @@
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_ND_HASH_TABLE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the rows of the Neighbour Discovery cache are indexed by a
+ * hash table on the IPv6 address, so a look-up does not have to compare the
+ * address with all ipconfigND_CACHE_ENTRIES rows. When the cache is full, the
+ * least recently used row is replaced.
+ *
+ * Every row also follows the reachability states of RFC 4861: an entry is
+ * REACHABLE after it was confirmed, becomes STALE after a while, goes to
+ * DELAY and PROBE when a stale entry is used, and is deleted when the unicast
+ * neighbour solicitations are not answered. Unused stale entries are not
+ * probed.
+ *
+ * Useful on IPv6 networks with many peers, e.g. with SLAAC privacy addresses.
+ * The cost is 8 bytes per row plus 2 bytes per bucket, see
+ * ipconfigND_HASH_BUCKET_COUNT.
+ */
+
+#ifndef ipconfigUSE_ND_HASH_TABLE
+    #define ipconfigUSE_ND_HASH_TABLE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_ND_HASH_TABLE != ipconfigDISABLE ) && ( ipconfigUSE_ND_HASH_TABLE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_ND_HASH_TABLE configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_ND_HASH_TABLE ) && ( ipconfigND_CACHE_ENTRIES > 65534 ) )
+    #error ipconfigUSE_ND_HASH_TABLE supports at most 65534 ND cache entries
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigND_HASH_BUCKET_COUNT
+ *
+ * Type: size_t
+ * Unit: count of hash buckets
+ * Minimum: 1
+ *
+ * The number of buckets in the ND hash table. Only used when
+ * ipconfigUSE_ND_HASH_TABLE is enabled. The value must be a power of two.
+ */
+
+#ifndef ipconfigND_HASH_BUCKET_COUNT
+    #define ipconfigND_HASH_BUCKET_COUNT    16U
+#endif
+
+#if ( ipconfigND_HASH_BUCKET_COUNT < 1 )
+    #error ipconfigND_HASH_BUCKET_COUNT must be at least 1
+#endif
+
+#if ( ( ipconfigND_HASH_BUCKET_COUNT & ( ipconfigND_HASH_BUCKET_COUNT - 1 ) ) != 0 )
+    #error ipconfigND_HASH_BUCKET_COUNT must be a power of two
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigND_STATIC_ENTRIES
+ *
+ * Type: size_t
+ * Unit: count of ND static entries
+ * Minimum: 0
+ *
+ * The number of permanent IPv6 to MAC address mappings that can be added with
+ * FreeRTOS_AddStaticNDEntry().  These entries are kept in a separate table
+ * that is searched before the ND cache.  They do not age, they are not
+ * replaced by received advertisements, and they survive FreeRTOS_ClearND().
+ * 0 disables the table.
+ */
+
+#ifndef ipconfigND_STATIC_ENTRIES
+    #define ipconfigND_STATIC_ENTRIES    0
+#endif
+
+#if ( ipconfigND_STATIC_ENTRIES < 0 )
+    #error ipconfigND_STATIC_ENTRIES must be at least 0
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigUSE_RA
  *
@@ -399,6 +515,38 @@ STATIC_ASSERT( ipconfigRA_IP_TEST_TIME_OUT_MSEC <= ( portMAX_DELAY * portTICK_PE
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_RA_OPTIMISTIC_DAD
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, an end-point that uses RA/SLAAC treats its new IPv6 address
+ * as an Optimistic Address ( RFC 4429 ): the end-point goes up as soon as the
+ * first neighbour solicitation for the address has been sent, instead of
+ * after ipconfigRA_IP_TEST_COUNT tests of ipconfigRA_IP_TEST_TIME_OUT_MSEC.
+ * Duplicate Address Detection continues in the background.
+ *
+ * While the address is optimistic, neighbour advertisements for it are sent
+ * without the Override flag, and a neighbour solicitation for it from the
+ * unspecified address ( another device doing DAD ) counts as a duplicate.
+ * When a duplicate is found, the end-point goes down and a new address is
+ * tested.
+ */
+
+#ifndef ipconfigUSE_RA_OPTIMISTIC_DAD
+    #define ipconfigUSE_RA_OPTIMISTIC_DAD    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_RA_OPTIMISTIC_DAD != ipconfigDISABLE ) && ( ipconfigUSE_RA_OPTIMISTIC_DAD != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_RA_OPTIMISTIC_DAD configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_RA_OPTIMISTIC_DAD ) && ipconfigIS_DISABLED( ipconfigUSE_RA ) )
+    #error ipconfigUSE_RA_OPTIMISTIC_DAD requires ipconfigUSE_RA
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigENDPOINT_DNS_ADDRESS_COUNT
  *
@@ -495,6 +643,49 @@ STATIC_ASSERT( ipconfigMAX_IP_TASK_SLEEP_TIME <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_TICKLESS_IP_TASK
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, xCalculateSleepTime() returns the exact time until the next
+ * IP timer expires, including the ARP resolution and network-down timers,
+ * and TCP sockets without a pending timeout no longer wake up the IP task
+ * every ipTCP_TIMER_PERIOD_MS. Timers that expire within
+ * ipconfigIP_TASK_TIMER_SLACK_MS after the first one are handled in the same
+ * wake-up. ipconfigMAX_IP_TASK_SLEEP_TIME remains the upper limit, it may be
+ * raised up to portMAX_DELAY for battery-powered products that use the
+ * tickless idle mode of FreeRTOS.
+ */
+
+#ifndef ipconfigUSE_TICKLESS_IP_TASK
+    #define ipconfigUSE_TICKLESS_IP_TASK    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TICKLESS_IP_TASK != ipconfigDISABLE ) && ( ipconfigUSE_TICKLESS_IP_TASK != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TICKLESS_IP_TASK configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigIP_TASK_TIMER_SLACK_MS
+ *
+ * Type: uint32_t
+ * Unit: milliseconds
+ * Minimum: 0
+ *
+ * The time that the expiry of an IP timer may be delayed, so that it can be
+ * handled together with a timer that expires a bit later. Only used when
+ * ipconfigUSE_TICKLESS_IP_TASK is enabled.
+ */
+
+#ifndef ipconfigIP_TASK_TIMER_SLACK_MS
+    #define ipconfigIP_TASK_TIMER_SLACK_MS    ( 10U )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*===========================================================================*/
 /*                                 IP CONFIG                                 */
 /*===========================================================================*/
@@ -584,6 +775,33 @@ STATIC_ASSERT( ipconfigMAX_IP_TASK_SLEEP_TIME <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_ALIGNED_HEADER_ACCESS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * The protocol headers are declared as packed structs, so on a CPU that
+ * can not load or store a misaligned 16- or 32-bit word, the compiler
+ * accesses every field of them one byte at a time.
+ *
+ * Enable this macro when the network buffers and the driver guarantee that
+ * the IP-header of every packet starts at a 32-bit aligned address, which
+ * is normally the case when ipconfigPACKET_FILLER_SIZE is 2 and the buffers
+ * are 32-bit aligned. The IPv4, UDP and TCP headers on the fast path will
+ * then be accessed through non-packed views of the same layout, and the
+ * alignment of received packets is checked with configASSERT().
+ */
+
+#ifndef ipconfigUSE_ALIGNED_HEADER_ACCESS
+    #define ipconfigUSE_ALIGNED_HEADER_ACCESS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_ALIGNED_HEADER_ACCESS != ipconfigDISABLE ) && ( ipconfigUSE_ALIGNED_HEADER_ACCESS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_ALIGNED_HEADER_ACCESS configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigBYTE_ORDER
  *
@@ -666,6 +884,120 @@ STATIC_ASSERT( ipconfigMAX_IP_TASK_SLEEP_TIME <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_CHECKSUM_KERNEL
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, usGenerateChecksum() passes the 32-bit aligned middle part of
+ * the data to ulChecksumKernel(), and only handles the unaligned head and
+ * tail itself. ulChecksumKernel() is not part of the portable code: link one
+ * of the kernels in source/portable/Checksum/ ( SSE2, NEON or ARM_CM ), or
+ * supply your own. With CMake, set FREERTOS_PLUS_TCP_CHECKSUM_KERNEL to the
+ * name of the directory.
+ *
+ * Leave this disabled when the MAC calculates the checksums, see
+ * ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM and
+ * ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM.
+ */
+
+#ifndef ipconfigUSE_CHECKSUM_KERNEL
+    #define ipconfigUSE_CHECKSUM_KERNEL    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_CHECKSUM_KERNEL != ipconfigDISABLE ) && ( ipconfigUSE_CHECKSUM_KERNEL != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_CHECKSUM_KERNEL configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TX_COPY_CHECKSUM
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, TCP sums the payload of an outgoing segment while copying it
+ * from the socket's transmit stream into the network buffer. The checksum
+ * calculation only has to add the pseudo header and the TCP header, so every
+ * byte of payload is read once instead of twice.
+ *
+ * Has no effect when ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM is enabled.
+ */
+
+#ifndef ipconfigTCP_TX_COPY_CHECKSUM
+    #define ipconfigTCP_TX_COPY_CHECKSUM    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigTCP_TX_COPY_CHECKSUM != ipconfigDISABLE ) && ( ipconfigTCP_TX_COPY_CHECKSUM != ipconfigENABLE ) )
+    #error Invalid ipconfigTCP_TX_COPY_CHECKSUM configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Decide at run-time, per interface and per packet, whether checksums are
+ * calculated in software. Useful when a board has a MAC with checksum
+ * offloading next to a chip that has none, such as the KSZ8851SNL.
+ *
+ * A driver sets 'bits.bRxChecksumOffload' in its NetworkInterface_t when the
+ * hardware verifies all incoming checksums, or it sets
+ * ipBUFFER_CHECKSUM_VERIFIED in 'ucChecksumFlags' of a single received
+ * network buffer. The stack then only checks the length fields of that
+ * packet.
+ *
+ * A driver sets 'bits.bTxChecksumOffload' when the hardware inserts the IP,
+ * TCP, UDP and ICMP checksums of outgoing packets. The stack then leaves the
+ * checksums of UDP, TCP and ICMP packets sent through that interface to the
+ * driver, and sets ipBUFFER_CHECKSUM_NEEDED in 'ucChecksumFlags' of the
+ * network buffer. Other packets always carry a checksum.
+ *
+ * ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM and
+ * ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM apply to all interfaces: when one of
+ * them is enabled, the per-interface flags have no effect in that direction.
+ */
+
+#ifndef ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD
+    #define ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != ipconfigDISABLE ) && ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_PACKET_METADATA
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the headers of a received IP packet are parsed once, when
+ * the IP-task starts processing the packet. The offsets of the IP-header and
+ * of the TCP, UDP or ICMP header, the protocol, and the number of protocol
+ * bytes are stored in 'xMetadata' of the network buffer. IPv6 extension
+ * headers are skipped once.
+ *
+ * Later stages use these fields instead of deriving them again: the check of
+ * the protocol checksum and the TCP input handler. The fields are updated
+ * when IPv4 options or IPv6 extension headers are removed from the packet.
+ *
+ * A network buffer obtained for transmission has no valid metadata.
+ */
+
+#ifndef ipconfigUSE_PACKET_METADATA
+    #define ipconfigUSE_PACKET_METADATA    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_PACKET_METADATA != ipconfigDISABLE ) && ( ipconfigUSE_PACKET_METADATA != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_PACKET_METADATA configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * A MISRA note: The macros 'ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES'
  * and 'ipconfigETHERNET_DRIVER_FILTERS_PACKETS' are too long: the first 32
@@ -767,6 +1099,115 @@ STATIC_ASSERT( ipconfigMAX_IP_TASK_SLEEP_TIME <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_SOFTWARE_MAC_FILTER
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Only used when ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES is disabled.
+ *
+ * When enabled, every NetworkInterface_t keeps a copy of its MAC address
+ * filter, like an EMAC would: a table of the unicast MAC addresses of its
+ * end-points, and a 64-bit hash of all addresses that the stack passed to
+ * pfAddAllowedMAC() and not yet to pfRemoveAllowedMAC().  The all-nodes,
+ * all-hosts, LLMNR and mDNS addresses are always in the hash.  The IP-task
+ * checks the destination address of a received frame against this filter
+ * before eConsiderFrameForProcessing() is called, so unwanted frames are
+ * dropped without walking the list of end-points.
+ *
+ * Multicast frames are only accepted when their group was registered
+ * through the stack, e.g. with FREERTOS_SO_IP_ADD_MEMBERSHIP, or with
+ * vNetworkInterfaceAddAllowedMAC().
+ */
+
+#ifndef ipconfigUSE_SOFTWARE_MAC_FILTER
+    #define ipconfigUSE_SOFTWARE_MAC_FILTER    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_SOFTWARE_MAC_FILTER != ipconfigDISABLE ) && ( ipconfigUSE_SOFTWARE_MAC_FILTER != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_SOFTWARE_MAC_FILTER configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigMAC_FILTER_EXACT_ENTRIES
+ *
+ * Type: UBaseType_t
+ * Unit: count of MAC addresses
+ * Minimum: 1
+ *
+ * The number of different unicast MAC addresses that the end-points of one
+ * interface can have, see ipconfigUSE_SOFTWARE_MAC_FILTER.  When the
+ * end-points have more addresses, the interface accepts all unicast frames,
+ * and eConsiderFrameForProcessing() checks them.
+ */
+
+#ifndef ipconfigMAC_FILTER_EXACT_ENTRIES
+    #define ipconfigMAC_FILTER_EXACT_ENTRIES    4U
+#endif
+
+#if ( ipconfigMAC_FILTER_EXACT_ENTRIES < 1 )
+    #error ipconfigMAC_FILTER_EXACT_ENTRIES must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_PACKET_FILTER
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, FreeRTOS_SetPacketFilter() installs a list of rules that
+ * accept or drop received frames by destination type ( unicast or group ),
+ * Ethernet type, IP protocol and UDP/TCP port.  The rules are compiled to a
+ * short program of loads and compares, which the IP-task runs at the start
+ * of prvProcessEthernetPacket(), before any other check.  This drops the
+ * chatter of e.g. NetBIOS or SSDP at a low cost, also when
+ * ipconfigETHERNET_DRIVER_FILTERS_PACKETS is disabled.
+ *
+ * A driver that can filter in hardware may set pfSetPacketFilter in its
+ * NetworkInterface_t.  It receives the compiled program, and when it
+ * returns pdPASS, the IP-task does not run the program for that interface.
+ */
+
+#ifndef ipconfigUSE_PACKET_FILTER
+    #define ipconfigUSE_PACKET_FILTER    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_PACKET_FILTER != ipconfigDISABLE ) && ( ipconfigUSE_PACKET_FILTER != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_PACKET_FILTER configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigPACKET_FILTER_MAX_INSTRUCTIONS
+ *
+ * Type: size_t
+ * Unit: count of instructions
+ * Minimum: 8
+ * Maximum: 255
+ *
+ * The size of the program that the rules of ipconfigUSE_PACKET_FILTER are
+ * compiled to.  A rule takes between 1 and 10 instructions, and one more is
+ * needed for the default action.  Each instruction takes 8 bytes of RAM.
+ */
+
+#ifndef ipconfigPACKET_FILTER_MAX_INSTRUCTIONS
+    #define ipconfigPACKET_FILTER_MAX_INSTRUCTIONS    64U
+#endif
+
+#if ( ipconfigPACKET_FILTER_MAX_INSTRUCTIONS < 8 )
+    #error ipconfigPACKET_FILTER_MAX_INSTRUCTIONS must be at least 8
+#endif
+
+#if ( ipconfigPACKET_FILTER_MAX_INSTRUCTIONS > 255 )
+    #error ipconfigPACKET_FILTER_MAX_INSTRUCTIONS must be at most 255
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigETHERNET_MINIMUM_PACKET_BYTES
  *
@@ -853,1074 +1294,4041 @@ STATIC_ASSERT( ipconfigMAX_IP_TASK_SLEEP_TIME <= portMAX_DELAY );
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
+ * ipconfigUSE_INTERFACE_MTU
  *
- * Type: size_t
- * Unit: Count of network buffers
- * Minimum: 1
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Defines the total number of network buffers that are available to the TCP/IP
- * stack. The total number of network buffers is limited to ensure the total
- * amount of RAM that can be consumed by the TCP/IP stack is capped to a
- * pre-determinable value. How the storage area is actually allocated to the
- * network buffer structures is not fixed, but part of the portable layer.
- * The simplest scheme simply allocates the exact amount of storage as it is
- * required.
+ * When enabled, every network interface has its own MTU in the field
+ * 'uxMTU' of NetworkInterface_t. The driver or the application sets it
+ * before FreeRTOS_IPInit_Multi() is called, a value of zero means
+ * ipconfigNETWORK_MTU. The MSS of a TCP connection and the maximum size of
+ * an outgoing UDP packet are limited by the MTU of the interface that
+ * carries them.
+ *
+ * ipconfigNETWORK_MTU remains the size of the network buffers and so it
+ * must be set to the largest MTU in use, e.g. 9000 when one of the
+ * interfaces carries jumbo frames. A larger per-interface value is
+ * clipped to ipconfigNETWORK_MTU.
  */
 
-#ifndef ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
-    #define ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS    ( 45 )
-#endif
-
-#if ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS < 1 )
-    #error ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS must be at least 1
+#ifndef ipconfigUSE_INTERFACE_MTU
+    #define ipconfigUSE_INTERFACE_MTU    ipconfigDISABLE
 #endif
 
-#if ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS > SIZE_MAX )
-    #error ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS overflows a size_t
+#if ( ( ipconfigUSE_INTERFACE_MTU != ipconfigDISABLE ) && ( ipconfigUSE_INTERFACE_MTU != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_INTERFACE_MTU configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_LINKED_RX_MESSAGES
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_LINKED_RX_MESSAGES
+ * ipconfigUSE_IP_FRAGMENTATION
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Advanced users only.
+ * When disabled, received IP fragments are dropped and a datagram can not be
+ * larger than the MTU.
  *
- * When enabled it is possible to reduce CPU load during periods of heavy
- * network traffic by linking multiple received packets together, then passing
- * all the linked packets to the IP RTOS task in one go.
+ * When enabled, fragments of IPv4 packets and IPv6 packets that carry a
+ * fragment header directly after the IPv6 header are reassembled. A
+ * complete datagram is passed to the IP-task again and processed like any
+ * other packet. Outgoing UDP and ICMP datagrams that are larger than the MTU
+ * of the interface are sent in fragments, unless the IPv4 "don't fragment"
+ * flag is set, see ipconfigFORCE_IP_DONT_FRAGMENT.
  *
- * By default packets will be sent one-by-one. If 'ipconfigUSE_LINKED_RX_MESSAGES'
- * is non-zero, each message buffer gets a 'pxNextBuffer' field, to that linked
- * packets can be passed to the IP-task in a single call to 'xSendEventStructToIPTask()'.
- * Note that this only works if the Network Interface also supports this
- * option.
+ * Datagrams larger than ipconfigNETWORK_MTU need network buffers of a
+ * variable size, as provided by BufferAllocation_2.c. With fixed size
+ * buffers only datagrams up to ipconfigNETWORK_MTU bytes are handled.
  */
 
-#ifndef ipconfigUSE_LINKED_RX_MESSAGES
-    #define ipconfigUSE_LINKED_RX_MESSAGES    ipconfigDISABLE
+#ifndef ipconfigUSE_IP_FRAGMENTATION
+    #define ipconfigUSE_IP_FRAGMENTATION    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_LINKED_RX_MESSAGES != ipconfigDISABLE ) && ( ipconfigUSE_LINKED_RX_MESSAGES != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_LINKED_RX_MESSAGES configuration
+#if ( ( ipconfigUSE_IP_FRAGMENTATION != ipconfigDISABLE ) && ( ipconfigUSE_IP_FRAGMENTATION != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_IP_FRAGMENTATION configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigZERO_COPY_RX_DRIVER
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigZERO_COPY_RX_DRIVER
+ * ipconfigIP_FRAGMENTATION_MAX_SIZE
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: ipconfigNETWORK_MTU
+ * Maximum: 65535
  *
- * Advanced users only.
- *
- * When enabled the network interface will assign network buffers
- * NetworkBufferDescriptor_t::pucEthernetBuffer to the DMA of the EMAC.
- * When a packet is received, no data is copied. Instead, the
- * buffer is sent directly to the IP-task. If the RX zero-copy option is
- * disabled, every received packet will be copied from the DMA buffer to the
- * network buffer of type NetworkBufferDescriptor_t.
+ * The largest IP datagram, IP header included, that will be reassembled or
+ * sent in fragments, see ipconfigUSE_IP_FRAGMENTATION. Every datagram under
+ * reassembly holds a network buffer of this size, so the memory used for
+ * reassembly is at most ipconfigIP_REASSEMBLY_MAX_DATAGRAMS times this value.
  */
 
-#ifndef ipconfigZERO_COPY_RX_DRIVER
-    #define ipconfigZERO_COPY_RX_DRIVER    ipconfigDISABLE
+#ifndef ipconfigIP_FRAGMENTATION_MAX_SIZE
+    #define ipconfigIP_FRAGMENTATION_MAX_SIZE    ( 16384U )
 #endif
 
-#if ( ( ipconfigZERO_COPY_RX_DRIVER != ipconfigDISABLE ) && ( ipconfigZERO_COPY_RX_DRIVER != ipconfigENABLE ) )
-    #error Invalid ipconfigZERO_COPY_RX_DRIVER configuration
+#if ( ipconfigIP_FRAGMENTATION_MAX_SIZE < ipconfigNETWORK_MTU )
+    #error ipconfigIP_FRAGMENTATION_MAX_SIZE must be at least ipconfigNETWORK_MTU
+#endif
+
+#if ( ipconfigIP_FRAGMENTATION_MAX_SIZE > 65535 )
+    #error ipconfigIP_FRAGMENTATION_MAX_SIZE overflows the length field of an IP header
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigZERO_COPY_TX_DRIVER
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigZERO_COPY_TX_DRIVER
+ * ipconfigIP_REASSEMBLY_MAX_DATAGRAMS
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
- *
- * Advanced users only.
- *
- * When enabled the driver function xNetworkInterfaceOutput() will always be
- * called with its bReleaseAfterSend parameter set to pdTRUE - meaning it is
- * always the driver that is responsible for freeing the network buffer and
- * network buffer descriptor.
+ * Type: size_t
+ * Unit: count of datagrams
+ * Minimum: 1
  *
- * This is useful if the driver implements a zero-copy scheme whereby the
- * packet data is sent directly from within the network buffer (for example by
- * pointing a DMA descriptor at the data within the network buffer), instead of
- * copying the data out of the network buffer before the data is sent (for
- * example by copying the data into a separate pre-allocated DMA descriptor).
- * In such cases the driver needs to take ownership of the network buffer
- * because the network buffer can only be freed after the data has actually
- * been transmitted - which might be some time after the
- * xNetworkInterfaceOutput() function returns. See the examples on the Porting
- * FreeRTOS to a Different Microcontroller documentation page for worked
- * examples.
+ * The number of datagrams that can be reassembled at the same time, see
+ * ipconfigUSE_IP_FRAGMENTATION. Fragments of a new datagram are dropped
+ * while all entries are in use.
  */
 
-#ifndef ipconfigZERO_COPY_TX_DRIVER
-    #define ipconfigZERO_COPY_TX_DRIVER    ipconfigDISABLE
+#ifndef ipconfigIP_REASSEMBLY_MAX_DATAGRAMS
+    #define ipconfigIP_REASSEMBLY_MAX_DATAGRAMS    ( 2U )
 #endif
 
-#if ( ( ipconfigZERO_COPY_TX_DRIVER != ipconfigDISABLE ) && ( ipconfigZERO_COPY_TX_DRIVER != ipconfigENABLE ) )
-    #error Invalid ipconfigZERO_COPY_TX_DRIVER configuration
+#if ( ipconfigIP_REASSEMBLY_MAX_DATAGRAMS < 1 )
+    #error ipconfigIP_REASSEMBLY_MAX_DATAGRAMS must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigSUPPORT_NETWORK_DOWN_EVENT
+ * ipconfigIP_REASSEMBLY_TIMEOUT_MS
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: uint32_t
+ * Unit: milliseconds
+ * Minimum: 1
  *
- * Set to 1 if you want to receive eNetworkDown notification via vApplicationIPNetworkEventHook_Multi() callback.
- * Not all drivers support this feature.
+ * A datagram of which not all fragments have arrived within this time after
+ * the first one is dropped and its network buffer is released, see
+ * ipconfigUSE_IP_FRAGMENTATION.
  */
 
-#ifndef ipconfigSUPPORT_NETWORK_DOWN_EVENT
-    #define ipconfigSUPPORT_NETWORK_DOWN_EVENT    ipconfigDISABLE
+#ifndef ipconfigIP_REASSEMBLY_TIMEOUT_MS
+    #define ipconfigIP_REASSEMBLY_TIMEOUT_MS    ( 5000U )
 #endif
 
-#if ( ( ipconfigSUPPORT_NETWORK_DOWN_EVENT != ipconfigDISABLE ) && ( ipconfigSUPPORT_NETWORK_DOWN_EVENT != ipconfigENABLE ) )
-    #error Invalid ipconfigSUPPORT_NETWORK_DOWN_EVENT configuration
+#if ( ipconfigIP_REASSEMBLY_TIMEOUT_MS < 1 )
+    #error ipconfigIP_REASSEMBLY_TIMEOUT_MS must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigPHY_LS_HIGH_CHECK_TIME_MS
+ * ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
  *
- * Type: uint32_t
- * Unit: milliseconds
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
  *
- * Interval in which to check if the LinkStatus in the PHY is still high after
- * not receiving packets.
+ * Type: size_t
+ * Unit: Count of network buffers
+ * Minimum: 1
+ *
+ * Defines the total number of network buffers that are available to the TCP/IP
+ * stack. The total number of network buffers is limited to ensure the total
+ * amount of RAM that can be consumed by the TCP/IP stack is capped to a
+ * pre-determinable value. How the storage area is actually allocated to the
+ * network buffer structures is not fixed, but part of the portable layer.
+ * The simplest scheme simply allocates the exact amount of storage as it is
+ * required.
  */
 
-#ifndef ipconfigPHY_LS_HIGH_CHECK_TIME_MS
-    #define ipconfigPHY_LS_HIGH_CHECK_TIME_MS    ( 15000 )
+#ifndef ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
+    #define ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS    ( 45 )
 #endif
 
-#if ( ipconfigPHY_LS_HIGH_CHECK_TIME_MS < 0 )
-    #error ipconfigPHY_LS_HIGH_CHECK_TIME_MS must be at least 0
+#if ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS < 1 )
+    #error ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS must be at least 1
 #endif
 
-STATIC_ASSERT( pdMS_TO_TICKS( ipconfigPHY_LS_HIGH_CHECK_TIME_MS ) <= portMAX_DELAY );
+#if ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS > SIZE_MAX )
+    #error ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS overflows a size_t
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigPHY_LS_LOW_CHECK_TIME_MS
+ * ipconfigBUFFER_ALLOC_CACHE_SIZE
  *
- * Type: uint32_t
- * Unit: milliseconds
+ * Type: UBaseType_t
+ * Unit: Count of network buffers per core
+ * Minimum: 0
  *
- * Interval in which to check if the LinkStatus in the PHY is still low.
+ * Only used by BufferAllocation_1.c. When larger than zero, every core gets
+ * a small cache of free network buffers. A released buffer is stored in the
+ * cache of the core that releases it, and the next allocation on that core
+ * takes it from there. A cache hit does not take the counting semaphore. On
+ * a single core it only masks the interrupts, on SMP it briefly enters the
+ * buffer lock because other cores may steal from the cache.
+ *
+ * When a cache is empty, the allocation takes a buffer from the global list
+ * of free buffers and refills the cache with up to half of its size in the
+ * same batch. When a cache is full, half of it is returned to the global
+ * list in one batch. A buffer is never cached while the counting semaphore
+ * is zero, so that a task that waits for a buffer gets it. Before a task
+ * blocks, it takes a buffer from the cache of any other core.
+ *
+ * The cached buffers are counted down from the semaphore, so at most
+ * configNUMBER_OF_CORES * ipconfigBUFFER_ALLOC_CACHE_SIZE buffers are held
+ * in caches. pxNetworkBufferGetFromISR() does not look in the caches and
+ * may fail while they still hold buffers, so keep
+ * ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS well above that number. Zero
+ * disables the caches.
  */
 
-#ifndef ipconfigPHY_LS_LOW_CHECK_TIME_MS
-    #define ipconfigPHY_LS_LOW_CHECK_TIME_MS    ( 1000 )
+#ifndef ipconfigBUFFER_ALLOC_CACHE_SIZE
+    #define ipconfigBUFFER_ALLOC_CACHE_SIZE    0U
 #endif
 
-#if ( ipconfigPHY_LS_LOW_CHECK_TIME_MS < 0 )
-    #error ipconfigPHY_LS_LOW_CHECK_TIME_MS must be at least 0
+#if ( ipconfigBUFFER_ALLOC_CACHE_SIZE < 0 )
+    #error ipconfigBUFFER_ALLOC_CACHE_SIZE must be at least 0
 #endif
 
-STATIC_ASSERT( pdMS_TO_TICKS( ipconfigPHY_LS_LOW_CHECK_TIME_MS ) <= portMAX_DELAY );
+#if ( ipconfigBUFFER_ALLOC_CACHE_SIZE >= ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS )
+    #error ipconfigBUFFER_ALLOC_CACHE_SIZE must be less than ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigHAS_TX_CRC_OFFLOADING
+ * ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Reduces the size of every NetworkBufferDescriptor_t, which matters when
+ * ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS is large and RAM is scarce. In a
+ * build where ipconfigUSE_IPv6 is disabled, the 16-byte 'xIPAddress' union
+ * is replaced by a 4-byte union that only has the 'ulIP_IPv4' member, so
+ * the code that accesses the field does not change. On a 32-bit target a
+ * descriptor shrinks from 56 to 44 bytes.
+ *
+ * The option has no effect when ipconfigUSE_IPv6 is enabled. The list item
+ * and the interface and end-point pointers keep their size, because the
+ * sockets and the network drivers use them directly.
  */
 
-#ifndef ipconfigHAS_TX_CRC_OFFLOADING
-    #define ipconfigHAS_TX_CRC_OFFLOADING    ipconfigDISABLE
+#ifndef ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS
+    #define ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS != ipconfigDISABLE ) && ( ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS != ipconfigENABLE ) )
+    #error Invalid ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigPHY_MAX_PORTS
+ * ipconfigRX_COPY_BREAK
  *
  * Type: size_t
- * Unit: count of ports
- * Minimum: 1
- * Maximum: 32
- *
- * There can be at most 32 PHY ports, but in most cases there are 4 or less.
+ * Unit: bytes
+ * Minimum: 0, otherwise 128
+ *
+ * Used by the BufferAllocation_x.c modules. A zero-copy driver
+ * receives every frame in a buffer of the full size, which stays occupied
+ * until the stack has processed the frame, or until an application has read
+ * a UDP packet from its socket. When ipconfigRX_COPY_BREAK is non-zero, the
+ * driver can call pxNetworkBufferCopyBreak() for a frame of at most this
+ * number of bytes. The frame is copied to a small buffer, and the large
+ * buffer goes back to the reception ring of the driver at once. ACK, ARP
+ * and other small frames no longer take away a full-size buffer.
+ *
+ * BufferAllocation_1.c takes the small buffers from a separate pool of
+ * ipconfigRX_COPY_BREAK_BUFFERS buffers, BufferAllocation_2.c and
+ * BufferAllocation_3.c allocate them like any other buffer. The minimum of 128 bytes leaves room for the
+ * replies that the stack builds in a received buffer, such as a TCP reset.
+ * Zero disables the copy-break.
  */
 
-#ifndef ipconfigPHY_MAX_PORTS
-    #define ipconfigPHY_MAX_PORTS    ( 4 )
+#ifndef ipconfigRX_COPY_BREAK
+    #define ipconfigRX_COPY_BREAK    0U
 #endif
 
-#if ( ipconfigPHY_MAX_PORTS < 1 )
-    #error ipconfigPHY_MAX_PORTS must be at least 1
+#if ( ( ipconfigRX_COPY_BREAK != 0 ) && ( ipconfigRX_COPY_BREAK < 128 ) )
+    #error ipconfigRX_COPY_BREAK must be 0 or at least 128
 #endif
 
-#if ( ipconfigPHY_MAX_PORTS > 32 )
-    #error ipconfigPHY_MAX_PORTS must be at most 32
+#if ( ipconfigRX_COPY_BREAK >= ipconfigNETWORK_MTU )
+    #error ipconfigRX_COPY_BREAK must be less than ipconfigNETWORK_MTU
 #endif
 
 /*---------------------------------------------------------------------------*/
 
-/*===========================================================================*/
-/*                               DRIVER CONFIG                               */
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*                             TCP/IP TASK CONFIG                            */
-/*===========================================================================*/
-
-/*---------------------------------------------------------------------------*/
-
 /*
- * ipconfigEVENT_QUEUE_LENGTH
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigEVENT_QUEUE_LENGTH
+ * ipconfigRX_COPY_BREAK_BUFFERS
  *
- * Type: size_t
- * Unit: count of queue spaces
+ * Type: UBaseType_t
+ * Unit: Count of small network buffers
  * Minimum: 1
  *
- * A FreeRTOS queue is used to send events from application tasks to the IP
- * stack. ipconfigEVENT_QUEUE_LENGTH sets the maximum number of events that can
- * be queued for processing at any one time. The event queue must be a minimum
- * of 5 greater than the total number of network buffers.
- *
- * The actual number of items in the event queue can be monitored.
- * See 'ipconfigCHECK_IP_QUEUE_SPACE' described here below.
- *
- * Tasks should never have to wait for space in the 'xNetworkEventQueue'.
+ * The number of small buffers of ipconfigRX_COPY_BREAK bytes that
+ * BufferAllocation_1.c reserves for pxNetworkBufferCopyBreak(). When they are
+ * all in use, a small frame stays in its large buffer as before. Each one
+ * costs a descriptor plus ipconfigRX_COPY_BREAK bytes of RAM.
  */
 
-#ifndef ipconfigEVENT_QUEUE_LENGTH
-    #define ipconfigEVENT_QUEUE_LENGTH    ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5 )
-#endif
-
-#if ( ipconfigEVENT_QUEUE_LENGTH < ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5 ) )
-    #error ipconfigEVENT_QUEUE_LENGTH must be at least ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5
+#ifndef ipconfigRX_COPY_BREAK_BUFFERS
+    #define ipconfigRX_COPY_BREAK_BUFFERS    16U
 #endif
 
-#if ( ipconfigEVENT_QUEUE_LENGTH > SIZE_MAX )
-    #error ipconfigEVENT_QUEUE_LENGTH overflows a size_t
+#if ( ipconfigRX_COPY_BREAK_BUFFERS < 1 )
+    #error ipconfigRX_COPY_BREAK_BUFFERS must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigIP_TASK_PRIORITY
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigIP_TASK_PRIORITY
+ * ipconfigBUFFER_ALLOC_2_SIZE_CLASS
  *
- * Type: UBaseType_t
- * Unit: task priority
+ * Type: size_t
+ * Unit: bytes
  * Minimum: 0
- * Maximum: configMAX_PRIORITIES - 1
- *
- * The TCP/IP stack executes in its own RTOS task (although any application
- * RTOS task can make use of its services through the published sockets API).
- * ipconfigIP_TASK_PRIORITY sets the priority of the RTOS task that executes
- * the TCP/IP stack.
- *
- * The priority is a standard FreeRTOS task priority so it can take any value
- * from 0 (the lowest priority) to (configMAX_PRIORITIES - 1)
- * (the highest priority). configMAX_PRIORITIES is a standard FreeRTOS
- * configuration parameter defined in FreeRTOSConfig.h, not FreeRTOSIPConfig.h.
- *
- * Consideration needs to be given as to the priority assigned to the RTOS task
- * executing the TCP/IP stack relative to the priority assigned to tasks that
- * use the TCP/IP stack.
  *
- * It is recommended to assign the following task priorities:
+ * Only used by BufferAllocation_2.c. When larger than zero, the storage of
+ * a network buffer is rounded up to a multiple of this number of bytes, and
+ * the size that was actually allocated is remembered with the buffer. When
+ * pxResizeNetworkBufferWithDescriptor() asks for a size that still fits,
+ * the buffer grows in place, without a new allocation and a copy. This
+ * happens often when a TCP segment is built in a buffer that held a small
+ * received packet.
  *
- * Higher : EMAC task "Deferred interrupt handler"
- * Medium : IP-task
- * Lower  : User tasks that make use of the TCP/IP stack
+ * A larger size class saves more copies, but wastes more heap. Zero
+ * allocates the exact size, and resizing always copies.
  */
 
-#ifndef ipconfigIP_TASK_PRIORITY
-    #define ipconfigIP_TASK_PRIORITY    ( configMAX_PRIORITIES - 2 )
-#endif
-
-#if ( ipconfigIP_TASK_PRIORITY < 0 )
-    #error ipconfigIP_TASK_PRIORITY must be at least 0
+#ifndef ipconfigBUFFER_ALLOC_2_SIZE_CLASS
+    #define ipconfigBUFFER_ALLOC_2_SIZE_CLASS    0U
 #endif
 
-#if ( ipconfigIP_TASK_PRIORITY > ( configMAX_PRIORITIES - 1 ) )
-    #error ipconfigIP_TASK_PRIORITY must be at most configMAX_PRIORITIES - 1
+#if ( ipconfigBUFFER_ALLOC_2_SIZE_CLASS < 0 )
+    #error ipconfigBUFFER_ALLOC_2_SIZE_CLASS must be at least 0
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigIP_TASK_STACK_SIZE_WORDS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigIP_TASK_STACK_SIZE_WORDS
+ * ipconfigBUFFER_ALLOC_3_SMALL_SIZE
+ * ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE
  *
  * Type: size_t
- * Unit: words
- * Minimum: configMINIMAL_STACK_SIZE
+ * Unit: bytes
+ * Minimum: 1
  *
- * The size, in words (not bytes), of the stack allocated to the
- * FreeRTOS-Plus-TCP RTOS task. FreeRTOS includes optional stack overflow
- * detection.
+ * Only used by BufferAllocation_3.c, which takes the storage of network
+ * buffers from three static arenas with blocks of a fixed size. These two
+ * macros set the size of the small blocks (for ACKs, ARP and DNS packets)
+ * and of the medium blocks. The large blocks always have room for
+ * ipTOTAL_ETHERNET_FRAME_SIZE bytes, so they follow ipconfigNETWORK_MTU.
+ * A request is served by the smallest class that fits and has a free block.
  */
 
-#ifndef ipconfigIP_TASK_STACK_SIZE_WORDS
-    #define ipconfigIP_TASK_STACK_SIZE_WORDS    configMINIMAL_STACK_SIZE
+#ifndef ipconfigBUFFER_ALLOC_3_SMALL_SIZE
+    #define ipconfigBUFFER_ALLOC_3_SMALL_SIZE    128U
 #endif
 
-STATIC_ASSERT( ipconfigIP_TASK_STACK_SIZE_WORDS >= configMINIMAL_STACK_SIZE );
+#ifndef ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE
+    #define ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE    512U
+#endif
 
-STATIC_ASSERT( ipconfigIP_TASK_STACK_SIZE_WORDS <= SIZE_MAX );
+#if ( ipconfigBUFFER_ALLOC_3_SMALL_SIZE < 1 )
+    #error ipconfigBUFFER_ALLOC_3_SMALL_SIZE must be at least 1
+#endif
+
+#if ( ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE <= ipconfigBUFFER_ALLOC_3_SMALL_SIZE )
+    #error ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE must be larger than ipconfigBUFFER_ALLOC_3_SMALL_SIZE
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES
- *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
- *
- * Enables usage of an application defined hook to process any unknown frame,
- * that is, any frame that expects ARP or IP. If set to 1, the user must define
- * eApplicationProcessCustomFrameHook function which will be called by the stack
- * for any frame with an unsupported EtherType.
+ * ipconfigBUFFER_ALLOC_3_SMALL_COUNT
+ * ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT
+ * ipconfigBUFFER_ALLOC_3_LARGE_COUNT
  *
- * Function prototype:
+ * Type: size_t
+ * Unit: Count of blocks
+ * Minimum: 1
  *
- * eFrameProcessingResult_t eApplicationProcessCustomFrameHook( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+ * Only used by BufferAllocation_3.c. The number of blocks in each of its
+ * three arenas. A block is only taken when a network buffer descriptor is
+ * available as well, so the sum may be larger than
+ * ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS.
  */
 
-#ifndef ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES
-    #define ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES    ipconfigDISABLE
+#ifndef ipconfigBUFFER_ALLOC_3_SMALL_COUNT
+    #define ipconfigBUFFER_ALLOC_3_SMALL_COUNT    ( ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 1 ) / 2 )
 #endif
 
-#if ( ( ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES != ipconfigDISABLE ) && ( ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES != ipconfigENABLE ) )
-    #error Invalid ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES configuration
+#ifndef ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT
+    #define ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT    ( ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 3 ) / 4 )
+#endif
+
+#ifndef ipconfigBUFFER_ALLOC_3_LARGE_COUNT
+    #define ipconfigBUFFER_ALLOC_3_LARGE_COUNT    ( ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 1 ) / 2 )
+#endif
+
+#if ( ipconfigBUFFER_ALLOC_3_SMALL_COUNT < 1 )
+    #error ipconfigBUFFER_ALLOC_3_SMALL_COUNT must be at least 1
+#endif
+
+#if ( ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT < 1 )
+    #error ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT must be at least 1
+#endif
+
+#if ( ipconfigBUFFER_ALLOC_3_LARGE_COUNT < 1 )
+    #error ipconfigBUFFER_ALLOC_3_LARGE_COUNT must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_NETWORK_EVENT_HOOK
+ * ipconfigUSE_LINKED_RX_MESSAGES
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_NETWORK_EVENT_HOOK
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_LINKED_RX_MESSAGES
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enables usage of a hook to process network events. The function will be called when
- * the network goes up and when it goes down.
- *
- * This hook is affected by ipconfigIPv4_BACKWARD_COMPATIBLE.
- *
- * Function prototype if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled:
+ * Advanced users only.
  *
- * void vApplicationIPNetworkEventHook( eIPCallbackEvent_t eNetworkEvent )
+ * When enabled it is possible to reduce CPU load during periods of heavy
+ * network traffic by linking multiple received packets together, then passing
+ * all the linked packets to the IP RTOS task in one go.
  *
- * Function prototype by default:
+ * The IP-task always accepts a chain of packets linked through the
+ * 'pxNextBuffer' field of the network buffers. Drivers that call
+ * xSendRxBurstToIPTask() get the linking for free in every configuration: the
+ * helper chains the buffers itself and posts a single eNetworkRxEvent for the
+ * whole burst.
  *
- * void vApplicationIPNetworkEventHook_Multi( eIPCallbackEvent_t eNetworkEvent,
- *                                            struct xNetworkEndPoint * pxEndPoint )
+ * This option is tested by network interfaces that build such chains
+ * themselves before calling 'xSendEventStructToIPTask()'. By default those
+ * drivers send the packets one-by-one.
  */
 
-#ifndef ipconfigUSE_NETWORK_EVENT_HOOK
-    #define ipconfigUSE_NETWORK_EVENT_HOOK    ipconfigDISABLE
+#ifndef ipconfigUSE_LINKED_RX_MESSAGES
+    #define ipconfigUSE_LINKED_RX_MESSAGES    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_NETWORK_EVENT_HOOK != ipconfigDISABLE ) && ( ipconfigUSE_NETWORK_EVENT_HOOK != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_NETWORK_EVENT_HOOK configuration
+#if ( ( ipconfigUSE_LINKED_RX_MESSAGES != ipconfigDISABLE ) && ( ipconfigUSE_LINKED_RX_MESSAGES != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_LINKED_RX_MESSAGES configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
-/*===========================================================================*/
-/*                             TCP/IP TASK CONFIG                            */
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*                                TCP CONFIG                                 */
-/*===========================================================================*/
-
-/*---------------------------------------------------------------------------*/
-
 /*
- * ipconfigUSE_TCP
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_TCP
+ * ipconfigUSE_SCATTER_GATHER
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Include support for TCP.
+ * When enabled, an outgoing network buffer may carry a chain of segments
+ * ( NetworkBufferSegment_t ) in its field 'pxSegments'. The frame then
+ * consists of the bytes in 'pucEthernetBuffer', normally the headers,
+ * followed by the data of every segment. A segment can point to any memory,
+ * for instance a block owned by the application, which is handed back
+ * through its 'pfRelease' callback when the buffer is released.
+ *
+ * A driver whose DMA can send a frame from several blocks sets
+ * 'bits.bScatterGather' in its NetworkInterface_t, and sends the chain
+ * directly. For other interfaces, xIPInterfaceOutput() copies the frame
+ * into a single network buffer first.
  */
 
-#ifndef ipconfigUSE_TCP
-    #define ipconfigUSE_TCP    ipconfigENABLE
+#ifndef ipconfigUSE_SCATTER_GATHER
+    #define ipconfigUSE_SCATTER_GATHER    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_TCP != ipconfigDISABLE ) && ( ipconfigUSE_TCP != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_TCP configuration
+#if ( ( ipconfigUSE_SCATTER_GATHER != ipconfigDISABLE ) && ( ipconfigUSE_SCATTER_GATHER != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_SCATTER_GATHER configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigIGNORE_UNKNOWN_PACKETS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigIGNORE_UNKNOWN_PACKETS
+ * ipconfigUSE_NETWORK_BUFFER_REFCOUNT
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Advanced users only.
+ * When enabled, a network buffer can have more than one owner. An extra
+ * owner is added with pxNetworkBufferAddReference(), and every owner calls
+ * vReleaseNetworkBufferAndDescriptor() as usual. The buffer only returns
+ * to the pool when the last owner has released it.
  *
- * Prevents sending RESET responses to TCP packets that have a bad or unknown
- * destination. This is an option used for testing.  It is recommended to
- * define it as '0'.
+ * The stack uses this when a received packet is returned to the sender
+ * while the caller still holds it, instead of copying it with
+ * pxDuplicateNetworkBufferWithDescriptor(). A shared buffer is read-only:
+ * it must not be changed or resized as long as there is another owner.
  */
 
-#ifndef ipconfigIGNORE_UNKNOWN_PACKETS
-    #define ipconfigIGNORE_UNKNOWN_PACKETS    ipconfigDISABLE
+#ifndef ipconfigUSE_NETWORK_BUFFER_REFCOUNT
+    #define ipconfigUSE_NETWORK_BUFFER_REFCOUNT    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigIGNORE_UNKNOWN_PACKETS != ipconfigDISABLE ) && ( ipconfigIGNORE_UNKNOWN_PACKETS != ipconfigENABLE ) )
-    #error Invalid ipconfigIGNORE_UNKNOWN_PACKETS configuration
+#if ( ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != ipconfigDISABLE ) && ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NETWORK_BUFFER_REFCOUNT configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_HANG_PROTECTION
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_HANG_PROTECTION
+ * ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: UBaseType_t
+ * Unit: count of network buffers
+ * Minimum: 0
+ * Maximum: ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - 1
  *
- * Enables automatic closure of a TCP socket after a timeout of no status
- * changes. It can help reduce the impact of SYN floods.
- * When a SYN packet comes in, it will first be checked if there is a listening
- * socket for that port number. If not, it will be replied to with a RESET packet.
- * If there is a listing socket for that port number, a new socket will be created.
- * This socket will be owned temporarily by the IP-task.  Only when the SYN/ACK
- * handshake is finished, the new socket will be passed to the application,
- * resulting in a successful call to FreeRTOS_accept().
- * The option 'ipconfigTCP_HANG_PROTECTION' will make sure that the socket will be
- * deleted in case the SYN-handshake doesn't come to a good end.
+ * The number of network buffers that application data can not take.
+ * UDP payloads and TCP segments that carry data are allocated with
+ * pxGetBulkNetworkBufferWithDescriptor(), which may only hold
+ * ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS minus this number of buffers at
+ * the same time. The rest stays available for TCP acknowledgements, ARP,
+ * ND and DHCP packets, so a busy application can not stall the protocols.
  *
- * See ipconfigTCP_HANG_PROTECTION_TIME
+ * When 0, there is no reservation.
  */
 
-#ifndef ipconfigTCP_HANG_PROTECTION
-    #define ipconfigTCP_HANG_PROTECTION    ipconfigENABLE
+#ifndef ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL
+    #define ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL    0
 #endif
 
-#if ( ( ipconfigTCP_HANG_PROTECTION != ipconfigDISABLE ) && ( ipconfigTCP_HANG_PROTECTION != ipconfigENABLE ) )
-    #error Invalid ipconfigTCP_HANG_PROTECTION configuration
+#if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL < 0 )
+    #error ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL must be at least 0
+#endif
+
+#if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL >= ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS )
+    #error ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL must be less than ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_HANG_PROTECTION_TIME
+ * ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_HANG_PROTECTION_TIME
- *
- * Type: TickType_t
- * Unit: seconds
+ * Type: size_t
+ * Unit: bytes
  * Minimum: 0
- * Maximum: portMAX_DELAY / configTICK_RATE_HZ
  *
- * If ipconfigTCP_HANG_PROTECTION is set to 1 then
- * ipconfigTCP_HANG_PROTECTION_TIME sets the interval in seconds
- * between the status of a socket last changing and the anti-hang
- * mechanism marking the socket as closed. It is the maximum time that a socket
- * stays in one of these "in-between" states: eCONNECT_SYN, eSYN_FIRST,
- * eSYN_RECEIVED, eFIN_WAIT_1, eFIN_WAIT_2, eCLOSING, eLAST_ACK, or eTIME_WAIT.
+ * The size of a line of the data cache, a power of 2, or 0 when the network
+ * buffers live in memory that is not cached by the CPU.
+ *
+ * When larger than zero, network buffers may be placed in cached memory,
+ * instead of a slow uncached region. The driver and the stack then share
+ * a contract:
+ *
+ * - Every buffer, counted from 'pucEthernetBuffer - ipBUFFER_PADDING',
+ *   starts on a cache line and occupies a whole number of cache lines, so
+ *   that no two buffers share a line. vNetworkBuffersAssignCacheAligned()
+ *   lays out a pool that way, from vNetworkInterfaceAllocateRAMToBuffers().
+ * - The stack marks a buffer in 'xCacheCleanNeeded' when it passes it to
+ *   the driver. Before the DMA reads it, the driver calls
+ *   vNetworkBufferCacheClean(), which only cleans marked buffers.
+ * - Before the DMA writes a received packet, and before the CPU reads it,
+ *   the driver calls vNetworkBufferCacheInvalidate().
+ *
+ * The helpers call ipconfigDCACHE_CLEAN() and ipconfigDCACHE_INVALIDATE(),
+ * which must then be defined for the CPU.
  */
 
-#ifndef ipconfigTCP_HANG_PROTECTION_TIME
-    #define ipconfigTCP_HANG_PROTECTION_TIME    ( 30 )
+#ifndef ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE
+    #define ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE    0U
 #endif
 
-#if ( ipconfigTCP_HANG_PROTECTION_TIME < 0 )
-    #error ipconfigTCP_HANG_PROTECTION_TIME must be at least 0
+#if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE < 0 )
+    #error ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE must be at least 0
 #endif
 
-STATIC_ASSERT( ipconfigTCP_HANG_PROTECTION_TIME <= ( portMAX_DELAY / configTICK_RATE_HZ ) );
+#if ( ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE & ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE - 1 ) ) != 0 )
+    #error ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE must be a power of 2
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_KEEP_ALIVE
+ * ipconfigDCACHE_CLEAN
+ * ipconfigDCACHE_INVALIDATE
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_KEEP_ALIVE
- *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: Macro Function
  *
- * Sockets that are connected but do not transmit any data for an extended
- * period can be disconnected by routers or firewalls that time out. This
- * can be avoided at the application level by ensuring the application
- * periodically sends a packet. Alternatively FreeRTOS-Plus-TCP can be
- * configured to automatically send keep alive messages when it detects
- * that a connection is dormant. Note that, while having FreeRTOS-Plus-TCP
- * automatically send keep alive messages is the more convenient method, it
- * is also the least reliable method because some routers will discard keep
- * alive messages.
+ * Write back ( clean ) or discard ( invalidate ) the lines of the data cache
+ * that hold the 'uxLength' bytes at 'pvAddress'. The address and the length
+ * are multiples of ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE.
  *
- * Set ipconfigTCP_KEEP_ALIVE to 1 to have FreeRTOS-Plus-TCP periodically
- * send keep alive messages on connected but dormant sockets. Set
- * ipconfigTCP_KEEP_ALIVE to 0 to prevent the automatic transmission of
- * keep alive messages.
+ * Example for a Cortex-M7:
+ * #define ipconfigDCACHE_CLEAN( pvAddress, uxLength ) \
+ *     SCB_CleanDCache_by_Addr( ( uint32_t * ) ( pvAddress ), ( int32_t ) ( uxLength ) )
  *
- * If FreeRTOS-Plus-TCP does not receive a reply to a keep alive message
- * then the connection will be broken and the socket will be marked as
- * closed. Subsequent FreeRTOS_recv() calls on the socket will return
- * -pdFREERTOS_ERRNO_ENOTCONN.
+ * Only used when ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE is larger than zero.
  */
 
-#ifndef ipconfigTCP_KEEP_ALIVE
-    #define ipconfigTCP_KEEP_ALIVE    ipconfigDISABLE
-#endif
+#if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 )
+    #ifndef ipconfigDCACHE_CLEAN
+        #error ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE requires ipconfigDCACHE_CLEAN to be defined
+    #endif
 
-#if ( ( ipconfigTCP_KEEP_ALIVE != ipconfigDISABLE ) && ( ipconfigTCP_KEEP_ALIVE != ipconfigENABLE ) )
-    #error Invalid ipconfigTCP_KEEP_ALIVE configuration
+    #ifndef ipconfigDCACHE_INVALIDATE
+        #error ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE requires ipconfigDCACHE_INVALIDATE to be defined
+    #endif
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_KEEP_ALIVE_INTERVAL
+ * ipconfigUSE_NETWORK_RX_RING
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_KEEP_ALIVE_INTERVAL
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Type: TickType_t
- * Unit: Seconds
- * Minimum: 0
- * Maximum: portMAX_DELAY / configTICK_RATE_HZ
+ * When enabled, every NetworkInterface_t gets a ring of network buffers in
+ * which its driver can store received frames by calling xNetworkRxRingPush().
+ * The frames do not travel through 'xNetworkEventQueue' anymore: only the
+ * first frame of a batch sends an eNetworkRxRingEvent to wake up the IP-task,
+ * which then takes all frames from the ring. The ring has a single producer
+ * (the driver task) and a single consumer (the IP-task), and it does not use
+ * a critical section.
  *
- * If ipconfigTCP_KEEP_ALIVE is set to 1 then
- * ipconfigTCP_KEEP_ALIVE_INTERVAL sets the interval in seconds between
- * successive keep alive messages. Keep alive messages are not sent at
- * all unless ipconfigTCP_KEEP_ALIVE_INTERVAL seconds have passed since
- * the last packet was sent or received.
+ * This prevents a receive storm from filling 'xNetworkEventQueue' and
+ * starving the other events. xSendRxBurstToIPTask() uses the ring as well.
  */
 
-#ifndef ipconfigTCP_KEEP_ALIVE_INTERVAL
-    #define ipconfigTCP_KEEP_ALIVE_INTERVAL    ( 20 )
+#ifndef ipconfigUSE_NETWORK_RX_RING
+    #define ipconfigUSE_NETWORK_RX_RING    ipconfigDISABLE
 #endif
 
-#if ( ipconfigTCP_KEEP_ALIVE_INTERVAL < 0 )
-    #error ipconfigTCP_KEEP_ALIVE_INTERVAL must be at least 0
+#if ( ( ipconfigUSE_NETWORK_RX_RING != ipconfigDISABLE ) && ( ipconfigUSE_NETWORK_RX_RING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NETWORK_RX_RING configuration
 #endif
 
-STATIC_ASSERT( ipconfigTCP_KEEP_ALIVE_INTERVAL <= ( portMAX_DELAY / configTICK_RATE_HZ ) );
-
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_MSS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_MSS
+ * ipconfigNETWORK_RX_RING_LENGTH
  *
  * Type: size_t
- * Unit: bytes
- * Minimum: 536 ( tcpMINIMUM_SEGMENT_LENGTH )
- *
- * Sets the MSS value (in bytes) for all TCP packets.
- *
- * Note that FreeRTOS-Plus-TCP contains checks that the defined
- * ipconfigNETWORK_MTU and ipconfigTCP_MSS values are consistent with each
- * other.
- *
- * The default definition of 'ipconfigTCP_MSS' works well for most projects.
- * Note that IPv6 headers are larger than IPv4 headers, leaving less space for
- * the TCP payload. In prvSocketSetMSS_IPV6(), 20 bytes will be subtracted from
- * 'ipconfigTCP_MSS'.
+ * Unit: count of network buffers
+ * Minimum: 2
  *
- * The default is derived from MTU - ( ipconfigNETWORK_MTU + ipSIZE_OF_TCP_HEADER )
- * Where ipconfigNETWORK_MTU + ipSIZE_OF_TCP_HEADER is 40 bytes.
+ * The number of slots in the receive ring of each network interface, see
+ * ipconfigUSE_NETWORK_RX_RING. The value must be a power of two. When the
+ * ring is full, xNetworkRxRingPush() fails and the driver should release
+ * the buffer.
  */
 
-#ifndef ipconfigTCP_MSS
-    #define ipconfigTCP_MSS    ( ipconfigNETWORK_MTU - 40U )
+#ifndef ipconfigNETWORK_RX_RING_LENGTH
+    #define ipconfigNETWORK_RX_RING_LENGTH    16U
 #endif
 
-#if ( ipconfigTCP_MSS < 536 )
-    #error ipconfigTCP_MSS must be at least 536 ( tcpMINIMUM_SEGMENT_LENGTH )
+#if ( ipconfigNETWORK_RX_RING_LENGTH < 2 )
+    #error ipconfigNETWORK_RX_RING_LENGTH must be at least 2
 #endif
 
-#if ( ipconfigTCP_MSS > SIZE_MAX )
-    #error ipconfigTCP_MSS overflows a size_t
+#if ( ( ipconfigNETWORK_RX_RING_LENGTH & ( ipconfigNETWORK_RX_RING_LENGTH - 1 ) ) != 0 )
+    #error ipconfigNETWORK_RX_RING_LENGTH must be a power of two
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_RX_BUFFER_LENGTH
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_RX_BUFFER_LENGTH
+ * ipconfigNETWORK_BUFFER_RX_RESERVE
  *
  * Type: size_t
- * Unit: size of StreamBuffer_t in bytes
+ * Unit: count of network buffers
  * Minimum: 0
  *
- * Each TCP socket has a circular stream buffer for reception and a separate
- * buffer for transmission.
- *
- * FreeRTOS_setsockopt() can be used with the FREERTOS_SO_RCVBUF and
- * FREERTOS_SO_SNDBUF parameters to set the receive and send buffer sizes
- * respectively - but this must be done between the time that the socket is
- * created and the buffers used by the socket are created. The receive
- * buffer is not created until data is actually received, and the transmit
- * buffer is not created until data is actually sent to the socket for
- * transmission. Once the buffers have been created their sizes cannot be
- * changed.
- *
- * If a listening socket creates a new socket in response to an incoming
- * connect request then the new socket will inherit the buffers sizes of
- * the listening socket.
+ * When non-zero, every NetworkInterface_t keeps a reserve of this many
+ * network buffers of ipTOTAL_ETHERNET_FRAME_SIZE bytes.  An interrupt service
+ * routine can take a buffer from the reserve by calling
+ * pxNetworkBufferGetFromReserveISR(), which does not take a lock and runs in
+ * bounded time.  This allows a driver to refill its DMA receive descriptors
+ * directly from the interrupt handler.  The IP-task tops up the reserves each
+ * time it wakes up, which happens at least for every received frame.
  *
- * The buffer length defaults to 5840 bytes.
+ * The value must be a power of two, 0 disables the reserve.  The buffers in
+ * the reserves are taken from the pool of ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS.
  */
 
-#ifndef ipconfigTCP_RX_BUFFER_LENGTH
-    #define ipconfigTCP_RX_BUFFER_LENGTH    ( 4 * ipconfigTCP_MSS )
+#ifndef ipconfigNETWORK_BUFFER_RX_RESERVE
+    #define ipconfigNETWORK_BUFFER_RX_RESERVE    0U
 #endif
 
-#if ( ipconfigTCP_RX_BUFFER_LENGTH < 0 )
-    #error ipconfigTCP_RX_BUFFER_LENGTH must be at least 0
+#if ( ( ipconfigNETWORK_BUFFER_RX_RESERVE & ( ipconfigNETWORK_BUFFER_RX_RESERVE - 1 ) ) != 0 )
+    #error ipconfigNETWORK_BUFFER_RX_RESERVE must be zero or a power of two
 #endif
 
-#if ( ipconfigTCP_RX_BUFFER_LENGTH > SIZE_MAX )
-    #error ipconfigTCP_RX_BUFFER_LENGTH overflows a size_t
+#if ( ipconfigNETWORK_BUFFER_RX_RESERVE >= ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS )
+    #error ipconfigNETWORK_BUFFER_RX_RESERVE must be less than ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_TX_BUFFER_LENGTH
+ * ipconfigUSE_DRIVER_RESPONDER
  *
- * Type: size_t
- * Unit: size of StreamBuffer_t in bytes
- * Minimum: 0
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Define the size of Tx stream buffer for TCP sockets.
- * See ipconfigTCP_RX_BUFFER_LENGTH
+ * Include xIPDriverRespond().  A driver may call it for each received frame
+ * before sending it to the IP-task.  ARP requests for the address of an
+ * end-point of the interface, and plain ICMP echo requests to it, are then
+ * answered in the context of the driver, without waking up the IP-task.
+ * The sender of an ARP request is not added to the ARP cache.  Frames that
+ * need more work, like ARP probes, address clashes or rate-limited pings,
+ * are still left to the IP-task.
+ *
+ * xIPDriverRespond() must be called from a task, normally the deferred
+ * interrupt handler of the driver, because it calls pfOutput().
  */
-
-#ifndef ipconfigTCP_TX_BUFFER_LENGTH
-    #define ipconfigTCP_TX_BUFFER_LENGTH    ( 4 * ipconfigTCP_MSS )
+#ifndef ipconfigUSE_DRIVER_RESPONDER
+    #define ipconfigUSE_DRIVER_RESPONDER    ipconfigDISABLE
 #endif
 
-#if ( ipconfigTCP_TX_BUFFER_LENGTH < 0 )
-    #error ipconfigTCP_TX_BUFFER_LENGTH must be at least 0
+#if ( ( ipconfigUSE_DRIVER_RESPONDER != ipconfigDISABLE ) && ( ipconfigUSE_DRIVER_RESPONDER != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DRIVER_RESPONDER configuration
 #endif
 
-#if ( ipconfigTCP_TX_BUFFER_LENGTH > SIZE_MAX )
-    #error ipconfigTCP_TX_BUFFER_LENGTH overflows a size_t
+#if ( ( ipconfigUSE_DRIVER_RESPONDER != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_IPv4 ) )
+    #error ipconfigUSE_DRIVER_RESPONDER requires ipconfigUSE_IPv4
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_TIME_TO_LIVE
+ * ipconfigUSE_NETWORK_INTERFACE_POLL
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_TIME_TO_LIVE
- *
- * Type: uint8_t
- * Unit: 'hops'
- * Minimum: 0
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Defines the Time To Live (TTL) values used in outgoing TCP packets.
+ * When enabled, a network interface may provide a pfPoll() function, which
+ * the IP-task calls to fetch received frames itself, in stead of having a
+ * deferred interrupt task in the driver.  The ISR of the driver masks its
+ * RX interrupt and calls FreeRTOS_NetworkInterfacePollFromISR().  pfPoll()
+ * passes at most ipconfigNETWORK_INTERFACE_POLL_BUDGET frames to
+ * vNetworkInterfacePollInput() and returns the number of frames handled.
+ * When that number equals the budget, the IP-task will poll again after
+ * handling its other events.  Otherwise the ring is empty, and pfPoll()
+ * must enable the RX interrupt again before returning.
  */
 
-#ifndef ipconfigTCP_TIME_TO_LIVE
-    #define ipconfigTCP_TIME_TO_LIVE    ( 128 )
+#ifndef ipconfigUSE_NETWORK_INTERFACE_POLL
+    #define ipconfigUSE_NETWORK_INTERFACE_POLL    ipconfigDISABLE
 #endif
 
-#if ( ipconfigTCP_TIME_TO_LIVE < 0 )
-    #error ipconfigTCP_TIME_TO_LIVE must be at least 0
+#if ( ( ipconfigUSE_NETWORK_INTERFACE_POLL != ipconfigDISABLE ) && ( ipconfigUSE_NETWORK_INTERFACE_POLL != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NETWORK_INTERFACE_POLL configuration
 #endif
 
-#if ( ipconfigTCP_TIME_TO_LIVE > UINT8_MAX )
-    #error ipconfigTCP_TIME_TO_LIVE overflows a uint8_t
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigNETWORK_INTERFACE_POLL_BUDGET
+ *
+ * Type: BaseType_t
+ * Unit: count of received frames
+ * Minimum: 1
+ *
+ * The maximum number of frames that one call to pfPoll() may handle, see
+ * ipconfigUSE_NETWORK_INTERFACE_POLL.  A smaller budget lets other events
+ * be handled sooner while a receive storm is going on.
+ */
+
+#ifndef ipconfigNETWORK_INTERFACE_POLL_BUDGET
+    #define ipconfigNETWORK_INTERFACE_POLL_BUDGET    16
+#endif
+
+#if ( ipconfigNETWORK_INTERFACE_POLL_BUDGET < 1 )
+    #error ipconfigNETWORK_INTERFACE_POLL_BUDGET must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_TCP_WIN
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_TCP_WIN
+ * ipconfigUSE_TX_BACKPRESSURE
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Sliding Windows allows messages to arrive out-of-order.
- *
- * Set ipconfigUSE_TCP_WIN to 1 to include sliding window behaviour in TCP
- * sockets. Set ipconfigUSE_TCP_WIN to 0 to exclude sliding window
- * behaviour in TCP sockets.
- *
- * Sliding windows can increase throughput while minimizing network traffic
- * at the expense of consuming more RAM.
- *
- * The size of the sliding window can be changed from its default using the
- * FREERTOS_SO_WIN_PROPERTIES parameter to FreeRTOS_setsockopt(). The
- * sliding window size is specified in units of MSS (so if the MSS is set
- * to 200 bytes then a sliding window size of 2 is equal to 400 bytes) and
- * must always be smaller than or equal to the size of the internal buffers
- * in both directions.
- *
- * If a listening socket creates a new socket in response to an incoming
- * connect request then the new socket will inherit the sliding window
- * sizes of the listening socket.
+ * When enabled, pfOutput() may return ipTX_BUSY when the transmit ring of
+ * the driver is full.  The driver then keeps its hands off the buffer, also
+ * when 'xReleaseAfterSend' is pdTRUE.  The stack holds on to that frame,
+ * stops passing frames to the interface, and TCP sockets stop sending
+ * segments in stead of losing them and waiting for a retransmission
+ * time-out.  As soon as the ring has room again, the driver calls
+ * FreeRTOS_NetworkInterfaceTxReady(), or the FromISR() version from its
+ * transmit interrupt.  The IP-task then sends the held frame and lets the
+ * paused TCP sockets continue.  Other frames that are sent while the
+ * interface is busy are dropped, as before.
  */
 
-#ifndef ipconfigUSE_TCP_WIN
-    #define ipconfigUSE_TCP_WIN    ipconfigENABLE
+#ifndef ipconfigUSE_TX_BACKPRESSURE
+    #define ipconfigUSE_TX_BACKPRESSURE    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_TCP_WIN != ipconfigDISABLE ) && ( ipconfigUSE_TCP_WIN != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_TCP_WIN configuration
+#if ( ( ipconfigUSE_TX_BACKPRESSURE != ipconfigDISABLE ) && ( ipconfigUSE_TX_BACKPRESSURE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TX_BACKPRESSURE configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_SRTT_MINIMUM_VALUE_MS
+ * ipconfigUSE_SOCKET_BUSY_POLL
  *
- * Type: int32_t
- * Unit: milliseconds
- * Minimum: 0
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * When measuring the Smoothed Round Trip Time (SRTT),
- * the result will be rounded up to a minimum value.
- * The default has always been 50, but a value of 1000
- * is recommended ( see RFC6298 ) because hosts often delay the
- * sending of ACK packets with 200 ms.
+ * When enabled, the socket option FREERTOS_SO_BUSY_POLL sets a number of
+ * clock ticks during which FreeRTOS_recv() and FreeRTOS_recvfrom() will
+ * spin in stead of blocking on the event group of the socket, while
+ * waiting for data.  The task yields between its checks, so only tasks of
+ * the same or a higher priority will run while it spins.  When
+ * ipconfigUSE_NETWORK_INTERFACE_POLL is enabled as well, every round also
+ * asks the IP-task to call the pfPoll() function of the interface, so that
+ * a frame is fetched without waiting for the RX interrupt.  The time spent
+ * spinning is part of the receive time-out.
  */
 
-#ifndef ipconfigTCP_SRTT_MINIMUM_VALUE_MS
-    #define ipconfigTCP_SRTT_MINIMUM_VALUE_MS    ( 50 )
-#endif
-
-#if ( ipconfigTCP_SRTT_MINIMUM_VALUE_MS < 0 )
-    #error ipconfigTCP_SRTT_MINIMUM_VALUE_MS must be at least 0
+#ifndef ipconfigUSE_SOCKET_BUSY_POLL
+    #define ipconfigUSE_SOCKET_BUSY_POLL    ipconfigDISABLE
 #endif
 
-#if ( ipconfigTCP_SRTT_MINIMUM_VALUE_MS > UINT32_MAX )
-    #error ipconfigTCP_SRTT_MINIMUM_VALUE_MS overflows a uint32_t
+#if ( ( ipconfigUSE_SOCKET_BUSY_POLL != ipconfigDISABLE ) && ( ipconfigUSE_SOCKET_BUSY_POLL != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_SOCKET_BUSY_POLL configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_WIN_SEG_COUNT
+ * ipconfigUSE_NETWORK_MULTI_QUEUE
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_WIN_SEG_COUNT
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Type: size_t
- * Unit: count of sliding windows
- * Minimum: 1
- *
- * If ipconfigUSE_TCP_WIN is set to 1 then each socket will use a
- * sliding window. Sliding windows allow messages to arrive out-of
- * order, and FreeRTOS-Plus-TCP uses window descriptors to track
- * information about the packets in a window.
- *
- * A pool of descriptors is allocated when the first TCP connection is
- * made. The descriptors are shared between all the sockets.
- * ipconfigTCP_WIN_SEG_COUNT sets the number of descriptors in the
- * pool, and each descriptor is approximately 64 bytes.
- *
- * As an example: If a system will have at most 16 simultaneous TCP
- * connections, and each connection will have an Rx and Tx window of at
- * most 8 segments, then the worst case maximum number of descriptors
- * that will be required is 256 ( 16 * 2 * 8 ). However, the practical
- * worst case is normally much lower than this as most packets will
- * arrive in order.
+ * When enabled, NetworkInterface_t gets an array of queue descriptors, one
+ * for each RX/TX hardware queue pair that the driver uses.  The driver sets
+ * 'uxQueueCount' and fills in its own ring pointers.  When sending, it calls
+ * uxNetworkInterfaceSelectQueue() to find the TX queue of a packet: either
+ * the pfSelectQueue() policy of the interface, or by default a hash of the
+ * addresses and ports, so that all packets of one flow use the same queue
+ * and are not reordered.  The hash is symmetric: both directions of a
+ * connection get the same value, just like with a symmetric RSS key.
  */
 
-#ifndef ipconfigTCP_WIN_SEG_COUNT
-    #define ipconfigTCP_WIN_SEG_COUNT    ( 256 )
-#endif
-
-#if ( ipconfigTCP_WIN_SEG_COUNT < 1 )
-    #error ipconfigTCP_WIN_SEG_COUNT must be at least 1
+#ifndef ipconfigUSE_NETWORK_MULTI_QUEUE
+    #define ipconfigUSE_NETWORK_MULTI_QUEUE    ipconfigDISABLE
 #endif
 
-#if ( ipconfigTCP_WIN_SEG_COUNT > SIZE_MAX )
-    #error ipconfigTCP_WIN_SEG_COUNT overflows a size_t
+#if ( ( ipconfigUSE_NETWORK_MULTI_QUEUE != ipconfigDISABLE ) && ( ipconfigUSE_NETWORK_MULTI_QUEUE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NETWORK_MULTI_QUEUE configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * pvPortMallocLarge / vPortFreeLarge
+ * ipconfigNETWORK_MAX_QUEUES
  *
- * Malloc functions specific to large TCP buffers for Rx/Tx.
+ * Type: UBaseType_t
+ * Unit: count of RX/TX queue pairs
+ * Minimum: 1
+ *
+ * The size of the array of queue descriptors in each NetworkInterface_t,
+ * see ipconfigUSE_NETWORK_MULTI_QUEUE.
  */
 
-#ifndef pvPortMallocLarge
-    #define pvPortMallocLarge( size )    pvPortMalloc( size )
+#ifndef ipconfigNETWORK_MAX_QUEUES
+    #define ipconfigNETWORK_MAX_QUEUES    4U
 #endif
 
-#ifndef vPortFreeLarge
-    #define vPortFreeLarge( ptr )    vPortFree( ptr )
+#if ( ipconfigNETWORK_MAX_QUEUES < 1 )
+    #error ipconfigNETWORK_MAX_QUEUES must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
-/*===========================================================================*/
-/*                                TCP CONFIG                                 */
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*                                UDP CONFIG                                 */
-/*===========================================================================*/
+/*
+ * ipconfigUSE_TX_PRIORITY_QUEUES
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, frames that the IP-task sends are not handed to pfOutput()
+ * in the order in which they were generated.  They are first put in one of
+ * ipconfigTX_PRIORITY_CLASSES queues, and the queues are flushed, highest
+ * class first, when the IP-task has no more events to handle, or after a
+ * burst of ipconfigIP_TASK_EVENT_BURST_LENGTH events.  The class of a frame
+ * is taken from the DSCP field of its IP header, which sockets set with the
+ * FREERTOS_SO_DSCP option.  ARP and other non-IP frames get the highest
+ * class.  Frames of one class are never reordered.
+ *
+ * When ipconfigUSE_NETWORK_MULTI_QUEUE is also enabled and the interface has
+ * no pfSelectQueue() policy, the class also selects the hardware TX queue.
+ */
+
+#ifndef ipconfigUSE_TX_PRIORITY_QUEUES
+    #define ipconfigUSE_TX_PRIORITY_QUEUES    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TX_PRIORITY_QUEUES != ipconfigDISABLE ) && ( ipconfigUSE_TX_PRIORITY_QUEUES != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TX_PRIORITY_QUEUES configuration
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUDP_MAX_RX_PACKETS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUDP_MAX_RX_PACKETS
+ * ipconfigTX_PRIORITY_CLASSES
  *
  * Type: UBaseType_t
- * Unit: rx packets
- * Minimum: 0
+ * Unit: count of priority classes
+ * Minimum: 1
+ * Maximum: 8
  *
- * ipconfigUDP_MAX_RX_PACKETS defines the maximum number of packets that can
- * exist in the Rx queue of a UDP socket. For example, if
- * ipconfigUDP_MAX_RX_PACKETS is set to 5 and there are already 5 packets
- * queued on the UDP socket then subsequent packets received on that socket
- * will be dropped until the queue length is less than 5 again.
- * Can be overridden with the socket option 'FREERTOS_SO_UDP_MAX_RX_PACKETS'.
+ * The number of transmit priority classes, see
+ * ipconfigUSE_TX_PRIORITY_QUEUES.  The 64 DSCP values are divided evenly
+ * over the classes, using the 3 class-selector bits.
  */
 
-#ifndef ipconfigUDP_MAX_RX_PACKETS
-    #define ipconfigUDP_MAX_RX_PACKETS    ( 0 )
+#ifndef ipconfigTX_PRIORITY_CLASSES
+    #define ipconfigTX_PRIORITY_CLASSES    4U
 #endif
 
-#if ( ipconfigUDP_MAX_RX_PACKETS < 0 )
-    #error ipconfigUDP_MAX_RX_PACKETS must be at least 0
+#if ( ipconfigTX_PRIORITY_CLASSES < 1 )
+    #error ipconfigTX_PRIORITY_CLASSES must be at least 1
 #endif
 
-#if ( ipconfigUDP_MAX_RX_PACKETS > UINT_FAST8_MAX )
-    #error ipconfigUDP_MAX_RX_PACKETS overflows a UBaseType_t
+#if ( ipconfigTX_PRIORITY_CLASSES > 8 )
+    #error ipconfigTX_PRIORITY_CLASSES overflows the 3 class-selector bits of DSCP
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS
- *
- * Type: TickType_t
- * Unit: Ticks
- * Minimum: 0
- * Maximum: portMAX_DELAY
- *
- * Sockets have a send block time attribute. If FreeRTOS_sendto() is called but
- * a network buffer cannot be obtained, then the calling RTOS task is held in
- * the Blocked state (so other tasks can continue to executed) until either a
- * network buffer becomes available or the send block time expires. If the send
- * block time expires then the send operation is aborted.
+ * ipconfigTX_PRIORITY_QUEUE_LENGTH
  *
- * The maximum allowable send block time is capped to the value set by
- * ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS. Capping the maximum allowable send
- * block time prevents prevents a deadlock occurring when all the network
- * buffers are in use and the tasks that process (and subsequently free) the
- * network buffers are themselves blocked waiting for a network buffer.
+ * Type: UBaseType_t
+ * Unit: count of network buffers
+ * Minimum: 1
  *
- * ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS is specified in RTOS ticks. A time in
- * milliseconds can be converted to a time in ticks by dividing the time in
- * milliseconds by portTICK_PERIOD_MS.
+ * The number of frames that each priority class can hold before all
+ * classes are flushed, see ipconfigUSE_TX_PRIORITY_QUEUES.
  */
 
-#ifndef ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS
-    #define ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS    pdMS_TO_TICKS( 20 )
+#ifndef ipconfigTX_PRIORITY_QUEUE_LENGTH
+    #define ipconfigTX_PRIORITY_QUEUE_LENGTH    16U
 #endif
 
-STATIC_ASSERT( ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
+#if ( ipconfigTX_PRIORITY_QUEUE_LENGTH < 1 )
+    #error ipconfigTX_PRIORITY_QUEUE_LENGTH must be at least 1
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS
+ * ipconfigZERO_COPY_RX_DRIVER
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigZERO_COPY_RX_DRIVER
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * If enabled then UDP packets that have their checksum value set to 0 will be
- * accepted, which is in compliance with the UDP specification. Otherwise they
- * will be dropped, which deviates from the UDP specification, but is safer.
+ * Advanced users only.
+ *
+ * When enabled the network interface will assign network buffers
+ * NetworkBufferDescriptor_t::pucEthernetBuffer to the DMA of the EMAC.
+ * When a packet is received, no data is copied. Instead, the
+ * buffer is sent directly to the IP-task. If the RX zero-copy option is
+ * disabled, every received packet will be copied from the DMA buffer to the
+ * network buffer of type NetworkBufferDescriptor_t.
  */
 
-#ifndef ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS
-    #define ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS    ipconfigDISABLE
+#ifndef ipconfigZERO_COPY_RX_DRIVER
+    #define ipconfigZERO_COPY_RX_DRIVER    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS != ipconfigDISABLE ) && ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS != ipconfigENABLE ) )
-    #error Invalid ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS configuration
+#if ( ( ipconfigZERO_COPY_RX_DRIVER != ipconfigDISABLE ) && ( ipconfigZERO_COPY_RX_DRIVER != ipconfigENABLE ) )
+    #error Invalid ipconfigZERO_COPY_RX_DRIVER configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUDP_TIME_TO_LIVE
+ * ipconfigZERO_COPY_TX_DRIVER
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUDP_TIME_TO_LIVE
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigZERO_COPY_TX_DRIVER
  *
- * Type: uint8_t
- * Units: 'hops'
- * Minimum: 0
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Defines the Time To Live (TTL) values used in outgoing UDP packets.
+ * Advanced users only.
+ *
+ * When enabled the driver function xNetworkInterfaceOutput() will always be
+ * called with its bReleaseAfterSend parameter set to pdTRUE - meaning it is
+ * always the driver that is responsible for freeing the network buffer and
+ * network buffer descriptor.
+ *
+ * This is useful if the driver implements a zero-copy scheme whereby the
+ * packet data is sent directly from within the network buffer (for example by
+ * pointing a DMA descriptor at the data within the network buffer), instead of
+ * copying the data out of the network buffer before the data is sent (for
+ * example by copying the data into a separate pre-allocated DMA descriptor).
+ * In such cases the driver needs to take ownership of the network buffer
+ * because the network buffer can only be freed after the data has actually
+ * been transmitted - which might be some time after the
+ * xNetworkInterfaceOutput() function returns. See the examples on the Porting
+ * FreeRTOS to a Different Microcontroller documentation page for worked
+ * examples.
  */
 
-#ifndef ipconfigUDP_TIME_TO_LIVE
-    #define ipconfigUDP_TIME_TO_LIVE    ( 128 )
-#endif
-
-#if ( ipconfigUDP_TIME_TO_LIVE < 0 )
-    #error ipconfigUDP_TIME_TO_LIVE must be at least 0
+#ifndef ipconfigZERO_COPY_TX_DRIVER
+    #define ipconfigZERO_COPY_TX_DRIVER    ipconfigDISABLE
 #endif
 
-#if ( ipconfigUDP_TIME_TO_LIVE > UINT8_MAX )
-    #error ipconfigUDP_TIME_TO_LIVE overflows a uint8_t
+#if ( ( ipconfigZERO_COPY_TX_DRIVER != ipconfigDISABLE ) && ( ipconfigZERO_COPY_TX_DRIVER != ipconfigENABLE ) )
+    #error Invalid ipconfigZERO_COPY_TX_DRIVER configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
-/*===========================================================================*/
-/*                                UDP CONFIG                                 */
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*                              SOCKET CONFIG                                */
-/*===========================================================================*/
-
-/*---------------------------------------------------------------------------*/
-
 /*
- * ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND
+ * ipconfigSUPPORT_NETWORK_DOWN_EVENT
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * The address of a socket is the combination of its IP address and its port
- * number. FreeRTOS_bind() is used to manually allocate a port number to a
- * socket (to 'bind' the socket to a port), but manual binding is not normally
- * necessary for client sockets (those sockets that initiate outgoing
- * connections rather than wait for incoming connections on a known port
- * number). If ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND is set to 1 then calling
- * FreeRTOS_sendto() on a socket that has not yet been bound will result in the
- * IP stack automatically binding the socket to a port number from the range
- * socketAUTO_PORT_ALLOCATION_START_NUMBER to 0xffff. If
- * ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND is set to 0 then calling
- * FreeRTOS_sendto() on a socket that has not yet been bound will result
- * in the send operation being aborted.
+ * Set to 1 if you want to receive eNetworkDown notification via vApplicationIPNetworkEventHook_Multi() callback.
+ * Not all drivers support this feature.
  */
 
-#ifndef ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND
-    #define ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND    ipconfigENABLE
+#ifndef ipconfigSUPPORT_NETWORK_DOWN_EVENT
+    #define ipconfigSUPPORT_NETWORK_DOWN_EVENT    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND != ipconfigDISABLE ) && ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND != ipconfigENABLE ) )
-    #error Invalid ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND configuration
+#if ( ( ipconfigSUPPORT_NETWORK_DOWN_EVENT != ipconfigDISABLE ) && ( ipconfigSUPPORT_NETWORK_DOWN_EVENT != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_NETWORK_DOWN_EVENT configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigSUPPORT_SELECT_FUNCTION
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSUPPORT_SELECT_FUNCTION
+ * ipconfigPHY_LS_HIGH_CHECK_TIME_MS
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: uint32_t
+ * Unit: milliseconds
  *
- * Include support for FreeRTOS_select() and associated API functions.
+ * Interval in which to check if the LinkStatus in the PHY is still high after
+ * not receiving packets.
  */
 
-#ifndef ipconfigSUPPORT_SELECT_FUNCTION
-    #define ipconfigSUPPORT_SELECT_FUNCTION    ipconfigDISABLE
+#ifndef ipconfigPHY_LS_HIGH_CHECK_TIME_MS
+    #define ipconfigPHY_LS_HIGH_CHECK_TIME_MS    ( 15000 )
 #endif
 
-#if ( ( ipconfigSUPPORT_SELECT_FUNCTION != ipconfigDISABLE ) && ( ipconfigSUPPORT_SELECT_FUNCTION != ipconfigENABLE ) )
-    #error Invalid ipconfigSUPPORT_SELECT_FUNCTION configuration
+#if ( ipconfigPHY_LS_HIGH_CHECK_TIME_MS < 0 )
+    #error ipconfigPHY_LS_HIGH_CHECK_TIME_MS must be at least 0
 #endif
 
+STATIC_ASSERT( pdMS_TO_TICKS( ipconfigPHY_LS_HIGH_CHECK_TIME_MS ) <= portMAX_DELAY );
+
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigSELECT_USES_NOTIFY
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSELECT_USES_NOTIFY
+ * ipconfigPHY_LS_LOW_CHECK_TIME_MS
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: uint32_t
+ * Unit: milliseconds
  *
- * This option is only used in case the socket-select functions are
- * activated (when ipconfigSUPPORT_SELECT_FUNCTION is non-zero). When
- * calling select() for a given socket from the same task, this macro is
- * not required. Only when there are multiple tasks using select on the
- * same sockets, this option may prevent a dead-lock. The problem is that
- * the event bit eSELECT_CALL_IP is waited for and cleared by multiple
- * tasks.
+ * Interval in which to check if the LinkStatus in the PHY is still low.
  */
 
-#ifndef ipconfigSELECT_USES_NOTIFY
-    #define ipconfigSELECT_USES_NOTIFY    ipconfigDISABLE
+#ifndef ipconfigPHY_LS_LOW_CHECK_TIME_MS
+    #define ipconfigPHY_LS_LOW_CHECK_TIME_MS    ( 1000 )
 #endif
 
-#if ( ( ipconfigSELECT_USES_NOTIFY != ipconfigDISABLE ) && ( ipconfigSELECT_USES_NOTIFY != ipconfigENABLE ) )
-    #error Invalid ipconfigSELECT_USES_NOTIFY configuration
+#if ( ipconfigPHY_LS_LOW_CHECK_TIME_MS < 0 )
+    #error ipconfigPHY_LS_LOW_CHECK_TIME_MS must be at least 0
 #endif
 
-#if ipconfigIS_ENABLED( ipconfigSELECT_USES_NOTIFY )
-    #if ( configUSE_TASK_NOTIFICATIONS == 0 )
-        #error configUSE_TASK_NOTIFICATIONS must be 1 if ipconfigSELECT_USES_NOTIFY is enabled
-    #endif
-#endif
+STATIC_ASSERT( pdMS_TO_TICKS( ipconfigPHY_LS_LOW_CHECK_TIME_MS ) <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+ * ipconfigPHY_LS_ADAPTIVE_POLL
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Type: TickType_t
- * Unit: Ticks
- * Minimum: 0
- * Maximum: portMAX_DELAY
+ * When enabled, a PHY whose link just came up is polled again after
+ * ipconfigPHY_LS_LOW_CHECK_TIME_MS, and the interval doubles with every check
+ * that finds the link unchanged, until it reaches
+ * ipconfigPHY_LS_HIGH_CHECK_TIME_MS.  When disabled, a PHY with a high link
+ * status is always polled after ipconfigPHY_LS_HIGH_CHECK_TIME_MS.
  *
- * API functions used to read data from a socket can block to wait for data to
+ * PHY's that signal link changes through their interrupt pin, see
+ * ulPhyEnableLinkInterrupt(), are only polled after
+ * ipconfigPHY_LS_HIGH_CHECK_TIME_MS, whatever this setting.
+ */
+
+#ifndef ipconfigPHY_LS_ADAPTIVE_POLL
+    #define ipconfigPHY_LS_ADAPTIVE_POLL    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigPHY_LS_ADAPTIVE_POLL != ipconfigDISABLE ) && ( ipconfigPHY_LS_ADAPTIVE_POLL != ipconfigENABLE ) )
+    #error Invalid ipconfigPHY_LS_ADAPTIVE_POLL configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigHAS_TX_CRC_OFFLOADING
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ */
+
+#ifndef ipconfigHAS_TX_CRC_OFFLOADING
+    #define ipconfigHAS_TX_CRC_OFFLOADING    ipconfigDISABLE
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigPHY_MAX_PORTS
+ *
+ * Type: size_t
+ * Unit: count of ports
+ * Minimum: 1
+ * Maximum: 32
+ *
+ * There can be at most 32 PHY ports, but in most cases there are 4 or less.
+ */
+
+#ifndef ipconfigPHY_MAX_PORTS
+    #define ipconfigPHY_MAX_PORTS    ( 4 )
+#endif
+
+#if ( ipconfigPHY_MAX_PORTS < 1 )
+    #error ipconfigPHY_MAX_PORTS must be at least 1
+#endif
+
+#if ( ipconfigPHY_MAX_PORTS > 32 )
+    #error ipconfigPHY_MAX_PORTS must be at most 32
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*===========================================================================*/
+/*                               DRIVER CONFIG                               */
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*                             TCP/IP TASK CONFIG                            */
+/*===========================================================================*/
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigEVENT_QUEUE_LENGTH
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigEVENT_QUEUE_LENGTH
+ *
+ * Type: size_t
+ * Unit: count of queue spaces
+ * Minimum: 1
+ *
+ * A FreeRTOS queue is used to send events from application tasks to the IP
+ * stack. ipconfigEVENT_QUEUE_LENGTH sets the maximum number of events that can
+ * be queued for processing at any one time. The event queue must be a minimum
+ * of 5 greater than the total number of network buffers.
+ *
+ * The actual number of items in the event queue can be monitored.
+ * See 'ipconfigCHECK_IP_QUEUE_SPACE' described here below.
+ *
+ * Tasks should never have to wait for space in the 'xNetworkEventQueue'.
+ */
+
+#ifndef ipconfigEVENT_QUEUE_LENGTH
+    #define ipconfigEVENT_QUEUE_LENGTH    ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5 )
+#endif
+
+#if ( ipconfigEVENT_QUEUE_LENGTH < ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5 ) )
+    #error ipconfigEVENT_QUEUE_LENGTH must be at least ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5
+#endif
+
+#if ( ipconfigEVENT_QUEUE_LENGTH > SIZE_MAX )
+    #error ipconfigEVENT_QUEUE_LENGTH overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigIP_TASK_EVENT_BURST_LENGTH
+ *
+ * Type: size_t
+ * Unit: count of events
+ * Minimum: 1
+ * Maximum: ipconfigEVENT_QUEUE_LENGTH
+ *
+ * The maximum number of events that the IP-task will take from
+ * 'xNetworkEventQueue' in a single wake-up. After the first event has been
+ * received, the IP-task keeps on draining the queue without blocking until
+ * either the queue is empty or this number of events has been handled. Only
+ * then the network timers are checked and a new sleep time is calculated.
+ *
+ * Under heavy traffic, e.g. when a driver delivers a burst of frames through
+ * xSendRxBurstToIPTask(), this saves the cost of checking all timers for
+ * every single frame. A larger value may delay the expiry of a timer by the
+ * time needed to handle that number of events.
+ *
+ * The default of 1 handles exactly one event per wake-up.
+ */
+
+#ifndef ipconfigIP_TASK_EVENT_BURST_LENGTH
+    #define ipconfigIP_TASK_EVENT_BURST_LENGTH    1U
+#endif
+
+#if ( ipconfigIP_TASK_EVENT_BURST_LENGTH < 1 )
+    #error ipconfigIP_TASK_EVENT_BURST_LENGTH must be at least 1
+#endif
+
+#if ( ipconfigIP_TASK_EVENT_BURST_LENGTH > ipconfigEVENT_QUEUE_LENGTH )
+    #error ipconfigIP_TASK_EVENT_BURST_LENGTH must be at most ipconfigEVENT_QUEUE_LENGTH
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_IP_EVENT_PRIORITY
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, control events such as eTCPTimerEvent, eSocketCloseEvent
+ * and eDHCPEvent are not sent to 'xNetworkEventQueue', but to a separate
+ * queue of ipconfigEVENT_CONTROL_QUEUE_LENGTH events.  Only the events that
+ * carry network packets (received frames, polls and packets to transmit)
+ * still use 'xNetworkEventQueue'.  Before every packet event, the IP-task
+ * handles all waiting control events, and a control event ends the current
+ * burst of ipconfigIP_TASK_EVENT_BURST_LENGTH events, so that the timers are
+ * checked again.  Under a receive storm, timers and closes are then handled
+ * after at most one packet, instead of after all packets that were queued
+ * before them.
+ *
+ * A control event may overtake packet events that were sent before it.
+ */
+
+#ifndef ipconfigUSE_IP_EVENT_PRIORITY
+    #define ipconfigUSE_IP_EVENT_PRIORITY    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_IP_EVENT_PRIORITY != ipconfigDISABLE ) && ( ipconfigUSE_IP_EVENT_PRIORITY != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_IP_EVENT_PRIORITY configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigEVENT_CONTROL_QUEUE_LENGTH
+ *
+ * Type: size_t
+ * Unit: count of events
+ * Minimum: 1
+ *
+ * The length of the queue of control events, see
+ * ipconfigUSE_IP_EVENT_PRIORITY.  When this queue is full, a control event
+ * is sent to 'xNetworkEventQueue' as usual.
+ */
+
+#ifndef ipconfigEVENT_CONTROL_QUEUE_LENGTH
+    #define ipconfigEVENT_CONTROL_QUEUE_LENGTH    10U
+#endif
+
+#if ( ipconfigEVENT_CONTROL_QUEUE_LENGTH < 1 )
+    #error ipconfigEVENT_CONTROL_QUEUE_LENGTH must be at least 1
+#endif
+
+#if ( ipconfigEVENT_CONTROL_QUEUE_LENGTH > SIZE_MAX )
+    #error ipconfigEVENT_CONTROL_QUEUE_LENGTH overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigIP_TASK_PRIORITY
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigIP_TASK_PRIORITY
+ *
+ * Type: UBaseType_t
+ * Unit: task priority
+ * Minimum: 0
+ * Maximum: configMAX_PRIORITIES - 1
+ *
+ * The TCP/IP stack executes in its own RTOS task (although any application
+ * RTOS task can make use of its services through the published sockets API).
+ * ipconfigIP_TASK_PRIORITY sets the priority of the RTOS task that executes
+ * the TCP/IP stack.
+ *
+ * The priority is a standard FreeRTOS task priority so it can take any value
+ * from 0 (the lowest priority) to (configMAX_PRIORITIES - 1)
+ * (the highest priority). configMAX_PRIORITIES is a standard FreeRTOS
+ * configuration parameter defined in FreeRTOSConfig.h, not FreeRTOSIPConfig.h.
+ *
+ * Consideration needs to be given as to the priority assigned to the RTOS task
+ * executing the TCP/IP stack relative to the priority assigned to tasks that
+ * use the TCP/IP stack.
+ *
+ * It is recommended to assign the following task priorities:
+ *
+ * Higher : EMAC task "Deferred interrupt handler"
+ * Medium : IP-task
+ * Lower  : User tasks that make use of the TCP/IP stack
+ */
+
+#ifndef ipconfigIP_TASK_PRIORITY
+    #define ipconfigIP_TASK_PRIORITY    ( configMAX_PRIORITIES - 2 )
+#endif
+
+#if ( ipconfigIP_TASK_PRIORITY < 0 )
+    #error ipconfigIP_TASK_PRIORITY must be at least 0
+#endif
+
+#if ( ipconfigIP_TASK_PRIORITY > ( configMAX_PRIORITIES - 1 ) )
+    #error ipconfigIP_TASK_PRIORITY must be at most configMAX_PRIORITIES - 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigIP_TASK_STACK_SIZE_WORDS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigIP_TASK_STACK_SIZE_WORDS
+ *
+ * Type: size_t
+ * Unit: words
+ * Minimum: configMINIMAL_STACK_SIZE
+ *
+ * The size, in words (not bytes), of the stack allocated to the
+ * FreeRTOS-Plus-TCP RTOS task. FreeRTOS includes optional stack overflow
+ * detection.
+ */
+
+#ifndef ipconfigIP_TASK_STACK_SIZE_WORDS
+    #define ipconfigIP_TASK_STACK_SIZE_WORDS    configMINIMAL_STACK_SIZE
+#endif
+
+STATIC_ASSERT( ipconfigIP_TASK_STACK_SIZE_WORDS >= configMINIMAL_STACK_SIZE );
+
+STATIC_ASSERT( ipconfigIP_TASK_STACK_SIZE_WORDS <= SIZE_MAX );
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables usage of an application defined hook to process any unknown frame,
+ * that is, any frame that expects ARP or IP. If set to 1, the user must define
+ * eApplicationProcessCustomFrameHook function which will be called by the stack
+ * for any frame with an unsupported EtherType.
+ *
+ * Function prototype:
+ *
+ * eFrameProcessingResult_t eApplicationProcessCustomFrameHook( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+ */
+
+#ifndef ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES
+    #define ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES != ipconfigDISABLE ) && ( ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES != ipconfigENABLE ) )
+    #error Invalid ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_NETWORK_EVENT_HOOK
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_NETWORK_EVENT_HOOK
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables usage of a hook to process network events. The function will be called when
+ * the network goes up and when it goes down.
+ *
+ * This hook is affected by ipconfigIPv4_BACKWARD_COMPATIBLE.
+ *
+ * Function prototype if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled:
+ *
+ * void vApplicationIPNetworkEventHook( eIPCallbackEvent_t eNetworkEvent )
+ *
+ * Function prototype by default:
+ *
+ * void vApplicationIPNetworkEventHook_Multi( eIPCallbackEvent_t eNetworkEvent,
+ *                                            struct xNetworkEndPoint * pxEndPoint )
+ */
+
+#ifndef ipconfigUSE_NETWORK_EVENT_HOOK
+    #define ipconfigUSE_NETWORK_EVENT_HOOK    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_NETWORK_EVENT_HOOK != ipconfigDISABLE ) && ( ipconfigUSE_NETWORK_EVENT_HOOK != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NETWORK_EVENT_HOOK configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*===========================================================================*/
+/*                             TCP/IP TASK CONFIG                            */
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*                                TCP CONFIG                                 */
+/*===========================================================================*/
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_TCP
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for TCP.
+ */
+
+#ifndef ipconfigUSE_TCP
+    #define ipconfigUSE_TCP    ipconfigENABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP != ipconfigDISABLE ) && ( ipconfigUSE_TCP != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigIGNORE_UNKNOWN_PACKETS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigIGNORE_UNKNOWN_PACKETS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Advanced users only.
+ *
+ * Prevents sending RESET responses to TCP packets that have a bad or unknown
+ * destination. This is an option used for testing.  It is recommended to
+ * define it as '0'.
+ */
+
+#ifndef ipconfigIGNORE_UNKNOWN_PACKETS
+    #define ipconfigIGNORE_UNKNOWN_PACKETS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigIGNORE_UNKNOWN_PACKETS != ipconfigDISABLE ) && ( ipconfigIGNORE_UNKNOWN_PACKETS != ipconfigENABLE ) )
+    #error Invalid ipconfigIGNORE_UNKNOWN_PACKETS configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_HANG_PROTECTION
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_HANG_PROTECTION
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables automatic closure of a TCP socket after a timeout of no status
+ * changes. It can help reduce the impact of SYN floods.
+ * When a SYN packet comes in, it will first be checked if there is a listening
+ * socket for that port number. If not, it will be replied to with a RESET packet.
+ * If there is a listing socket for that port number, a new socket will be created.
+ * This socket will be owned temporarily by the IP-task.  Only when the SYN/ACK
+ * handshake is finished, the new socket will be passed to the application,
+ * resulting in a successful call to FreeRTOS_accept().
+ * The option 'ipconfigTCP_HANG_PROTECTION' will make sure that the socket will be
+ * deleted in case the SYN-handshake doesn't come to a good end.
+ *
+ * See ipconfigTCP_HANG_PROTECTION_TIME
+ */
+
+#ifndef ipconfigTCP_HANG_PROTECTION
+    #define ipconfigTCP_HANG_PROTECTION    ipconfigENABLE
+#endif
+
+#if ( ( ipconfigTCP_HANG_PROTECTION != ipconfigDISABLE ) && ( ipconfigTCP_HANG_PROTECTION != ipconfigENABLE ) )
+    #error Invalid ipconfigTCP_HANG_PROTECTION configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_HANG_PROTECTION_TIME
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_HANG_PROTECTION_TIME
+ *
+ * Type: TickType_t
+ * Unit: seconds
+ * Minimum: 0
+ * Maximum: portMAX_DELAY / configTICK_RATE_HZ
+ *
+ * If ipconfigTCP_HANG_PROTECTION is set to 1 then
+ * ipconfigTCP_HANG_PROTECTION_TIME sets the interval in seconds
+ * between the status of a socket last changing and the anti-hang
+ * mechanism marking the socket as closed. It is the maximum time that a socket
+ * stays in one of these "in-between" states: eCONNECT_SYN, eSYN_FIRST,
+ * eSYN_RECEIVED, eFIN_WAIT_1, eFIN_WAIT_2, eCLOSING, eLAST_ACK, or eTIME_WAIT.
+ */
+
+#ifndef ipconfigTCP_HANG_PROTECTION_TIME
+    #define ipconfigTCP_HANG_PROTECTION_TIME    ( 30 )
+#endif
+
+#if ( ipconfigTCP_HANG_PROTECTION_TIME < 0 )
+    #error ipconfigTCP_HANG_PROTECTION_TIME must be at least 0
+#endif
+
+STATIC_ASSERT( ipconfigTCP_HANG_PROTECTION_TIME <= ( portMAX_DELAY / configTICK_RATE_HZ ) );
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_KEEP_ALIVE
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_KEEP_ALIVE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Sockets that are connected but do not transmit any data for an extended
+ * period can be disconnected by routers or firewalls that time out. This
+ * can be avoided at the application level by ensuring the application
+ * periodically sends a packet. Alternatively FreeRTOS-Plus-TCP can be
+ * configured to automatically send keep alive messages when it detects
+ * that a connection is dormant. Note that, while having FreeRTOS-Plus-TCP
+ * automatically send keep alive messages is the more convenient method, it
+ * is also the least reliable method because some routers will discard keep
+ * alive messages.
+ *
+ * Set ipconfigTCP_KEEP_ALIVE to 1 to have FreeRTOS-Plus-TCP periodically
+ * send keep alive messages on connected but dormant sockets. Set
+ * ipconfigTCP_KEEP_ALIVE to 0 to prevent the automatic transmission of
+ * keep alive messages.
+ *
+ * If FreeRTOS-Plus-TCP does not receive a reply to a keep alive message
+ * then the connection will be broken and the socket will be marked as
+ * closed. Subsequent FreeRTOS_recv() calls on the socket will return
+ * -pdFREERTOS_ERRNO_ENOTCONN.
+ */
+
+#ifndef ipconfigTCP_KEEP_ALIVE
+    #define ipconfigTCP_KEEP_ALIVE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigTCP_KEEP_ALIVE != ipconfigDISABLE ) && ( ipconfigTCP_KEEP_ALIVE != ipconfigENABLE ) )
+    #error Invalid ipconfigTCP_KEEP_ALIVE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_KEEP_ALIVE_INTERVAL
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_KEEP_ALIVE_INTERVAL
+ *
+ * Type: TickType_t
+ * Unit: Seconds
+ * Minimum: 0
+ * Maximum: portMAX_DELAY / configTICK_RATE_HZ
+ *
+ * If ipconfigTCP_KEEP_ALIVE is set to 1 then
+ * ipconfigTCP_KEEP_ALIVE_INTERVAL sets the interval in seconds between
+ * successive keep alive messages. Keep alive messages are not sent at
+ * all unless ipconfigTCP_KEEP_ALIVE_INTERVAL seconds have passed since
+ * the last packet was sent or received.
+ */
+
+#ifndef ipconfigTCP_KEEP_ALIVE_INTERVAL
+    #define ipconfigTCP_KEEP_ALIVE_INTERVAL    ( 20 )
+#endif
+
+#if ( ipconfigTCP_KEEP_ALIVE_INTERVAL < 0 )
+    #error ipconfigTCP_KEEP_ALIVE_INTERVAL must be at least 0
+#endif
+
+STATIC_ASSERT( ipconfigTCP_KEEP_ALIVE_INTERVAL <= ( portMAX_DELAY / configTICK_RATE_HZ ) );
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_MSS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_MSS
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 536 ( tcpMINIMUM_SEGMENT_LENGTH )
+ *
+ * Sets the MSS value (in bytes) for all TCP packets.
+ *
+ * Note that FreeRTOS-Plus-TCP contains checks that the defined
+ * ipconfigNETWORK_MTU and ipconfigTCP_MSS values are consistent with each
+ * other.
+ *
+ * The default definition of 'ipconfigTCP_MSS' works well for most projects.
+ * Note that IPv6 headers are larger than IPv4 headers, leaving less space for
+ * the TCP payload. In prvSocketSetMSS_IPV6(), 20 bytes will be subtracted from
+ * 'ipconfigTCP_MSS'.
+ *
+ * The default is derived from MTU - ( ipconfigNETWORK_MTU + ipSIZE_OF_TCP_HEADER )
+ * Where ipconfigNETWORK_MTU + ipSIZE_OF_TCP_HEADER is 40 bytes.
+ */
+
+#ifndef ipconfigTCP_MSS
+    #define ipconfigTCP_MSS    ( ipconfigNETWORK_MTU - 40U )
+#endif
+
+#if ( ipconfigTCP_MSS < 536 )
+    #error ipconfigTCP_MSS must be at least 536 ( tcpMINIMUM_SEGMENT_LENGTH )
+#endif
+
+#if ( ipconfigTCP_MSS > SIZE_MAX )
+    #error ipconfigTCP_MSS overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_RX_BUFFER_LENGTH
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_RX_BUFFER_LENGTH
+ *
+ * Type: size_t
+ * Unit: size of StreamBuffer_t in bytes
+ * Minimum: 0
+ *
+ * Each TCP socket has a circular stream buffer for reception and a separate
+ * buffer for transmission.
+ *
+ * FreeRTOS_setsockopt() can be used with the FREERTOS_SO_RCVBUF and
+ * FREERTOS_SO_SNDBUF parameters to set the receive and send buffer sizes
+ * respectively - but this must be done between the time that the socket is
+ * created and the buffers used by the socket are created. The receive
+ * buffer is not created until data is actually received, and the transmit
+ * buffer is not created until data is actually sent to the socket for
+ * transmission. Once the buffers have been created their sizes cannot be
+ * changed.
+ *
+ * If a listening socket creates a new socket in response to an incoming
+ * connect request then the new socket will inherit the buffers sizes of
+ * the listening socket.
+ *
+ * The buffer length defaults to 5840 bytes.
+ */
+
+#ifndef ipconfigTCP_RX_BUFFER_LENGTH
+    #define ipconfigTCP_RX_BUFFER_LENGTH    ( 4 * ipconfigTCP_MSS )
+#endif
+
+#if ( ipconfigTCP_RX_BUFFER_LENGTH < 0 )
+    #error ipconfigTCP_RX_BUFFER_LENGTH must be at least 0
+#endif
+
+#if ( ipconfigTCP_RX_BUFFER_LENGTH > SIZE_MAX )
+    #error ipconfigTCP_RX_BUFFER_LENGTH overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TX_BUFFER_LENGTH
+ *
+ * Type: size_t
+ * Unit: size of StreamBuffer_t in bytes
+ * Minimum: 0
+ *
+ * Define the size of Tx stream buffer for TCP sockets.
+ * See ipconfigTCP_RX_BUFFER_LENGTH
+ */
+
+#ifndef ipconfigTCP_TX_BUFFER_LENGTH
+    #define ipconfigTCP_TX_BUFFER_LENGTH    ( 4 * ipconfigTCP_MSS )
+#endif
+
+#if ( ipconfigTCP_TX_BUFFER_LENGTH < 0 )
+    #error ipconfigTCP_TX_BUFFER_LENGTH must be at least 0
+#endif
+
+#if ( ipconfigTCP_TX_BUFFER_LENGTH > SIZE_MAX )
+    #error ipconfigTCP_TX_BUFFER_LENGTH overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSTREAM_BUFFER_LOCK_FREE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * A stream buffer of a TCP socket has one writer and one reader, the IP-task
+ * and a user task. The writer owns 'uxHead' and 'uxFront', the reader owns
+ * 'uxTail' and 'uxMid'. The data is made visible to the other side with a
+ * memory barrier before the index that publishes it is stored, and the index
+ * of the other side is read before the data.
+ *
+ * By default the writer also updates its indexes while the scheduler is
+ * suspended. That does not stop a task on another core. When enabled, the
+ * scheduler is not suspended, and the two sides only rely on the ordering,
+ * so they can run at the same time on different cores of an SMP kernel.
+ * ipconfigSTREAM_BUFFER_MEMORY_BARRIER() must then order the memory
+ * accesses between the cores.
+ */
+
+#ifndef ipconfigSTREAM_BUFFER_LOCK_FREE
+    #define ipconfigSTREAM_BUFFER_LOCK_FREE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSTREAM_BUFFER_LOCK_FREE != ipconfigDISABLE ) && ( ipconfigSTREAM_BUFFER_LOCK_FREE != ipconfigENABLE ) )
+    #error Invalid ipconfigSTREAM_BUFFER_LOCK_FREE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSTREAM_BUFFER_MEMORY_BARRIER
+ *
+ * Type: Macro Function
+ *
+ * A full memory barrier, used between the data and the indexes of a stream
+ * buffer. When not defined, portMEMORY_BARRIER() is used if the port has
+ * one. That is often only a compiler barrier, which is enough on a single
+ * core.
+ *
+ * Example for a GCC build on an SMP Cortex-A:
+ * #define ipconfigSTREAM_BUFFER_MEMORY_BARRIER()    __sync_synchronize()
+ */
+
+#if ( ipconfigIS_ENABLED( ipconfigSTREAM_BUFFER_LOCK_FREE ) && !defined( ipconfigSTREAM_BUFFER_MEMORY_BARRIER ) )
+    #error ipconfigSTREAM_BUFFER_LOCK_FREE requires ipconfigSTREAM_BUFFER_MEMORY_BARRIER to be defined
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSTREAM_BUFFER_POWER_OF_TWO
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the length of every stream buffer is rounded up to a power
+ * of 2, so that its indexes wrap around with a mask instead of a comparison
+ * and a subtraction. That takes a few branches out of every TCP send and
+ * receive, at the cost of up to twice the memory for the TCP streams.
+ * Stream buffers created outside of the library must be sized with
+ * uxStreamBufferLength().
+ */
+
+#ifndef ipconfigSTREAM_BUFFER_POWER_OF_TWO
+    #define ipconfigSTREAM_BUFFER_POWER_OF_TWO    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSTREAM_BUFFER_POWER_OF_TWO != ipconfigDISABLE ) && ( ipconfigSTREAM_BUFFER_POWER_OF_TWO != ipconfigENABLE ) )
+    #error Invalid ipconfigSTREAM_BUFFER_POWER_OF_TWO configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TIME_TO_LIVE
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_TIME_TO_LIVE
+ *
+ * Type: uint8_t
+ * Unit: 'hops'
+ * Minimum: 0
+ *
+ * Defines the Time To Live (TTL) values used in outgoing TCP packets.
+ */
+
+#ifndef ipconfigTCP_TIME_TO_LIVE
+    #define ipconfigTCP_TIME_TO_LIVE    ( 128 )
+#endif
+
+#if ( ipconfigTCP_TIME_TO_LIVE < 0 )
+    #error ipconfigTCP_TIME_TO_LIVE must be at least 0
+#endif
+
+#if ( ipconfigTCP_TIME_TO_LIVE > UINT8_MAX )
+    #error ipconfigTCP_TIME_TO_LIVE overflows a uint8_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_WIN
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_TCP_WIN
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Sliding Windows allows messages to arrive out-of-order.
+ *
+ * Set ipconfigUSE_TCP_WIN to 1 to include sliding window behaviour in TCP
+ * sockets. Set ipconfigUSE_TCP_WIN to 0 to exclude sliding window
+ * behaviour in TCP sockets.
+ *
+ * Sliding windows can increase throughput while minimizing network traffic
+ * at the expense of consuming more RAM.
+ *
+ * The size of the sliding window can be changed from its default using the
+ * FREERTOS_SO_WIN_PROPERTIES parameter to FreeRTOS_setsockopt(). The
+ * sliding window size is specified in units of MSS (so if the MSS is set
+ * to 200 bytes then a sliding window size of 2 is equal to 400 bytes) and
+ * must always be smaller than or equal to the size of the internal buffers
+ * in both directions.
+ *
+ * If a listening socket creates a new socket in response to an incoming
+ * connect request then the new socket will inherit the sliding window
+ * sizes of the listening socket.
+ */
+
+#ifndef ipconfigUSE_TCP_WIN
+    #define ipconfigUSE_TCP_WIN    ipconfigENABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_WIN != ipconfigDISABLE ) && ( ipconfigUSE_TCP_WIN != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_WIN configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TINY_TX_SEGMENT_COUNT
+ *
+ * Type: size_t
+ * Unit: count of segments
+ * Minimum: 1
+ * Maximum: 8
+ *
+ * When ipconfigUSE_TCP_WIN is disabled, Tiny-TCP has one outstanding
+ * segment of at most one MSS, so a connection sends one MSS per round-trip.
+ * A larger value gives each TCP window a small fixed array of this number of
+ * TX segments, which can be in flight at the same time, as far as the peer's
+ * window allows. Each extra segment costs the size of a TCPSegment_t per
+ * socket. Reception is not changed: out-of-order data is still dropped.
+ */
+
+#ifndef ipconfigTCP_TINY_TX_SEGMENT_COUNT
+    #define ipconfigTCP_TINY_TX_SEGMENT_COUNT    1
+#endif
+
+#if ( ipconfigTCP_TINY_TX_SEGMENT_COUNT < 1 )
+    #error ipconfigTCP_TINY_TX_SEGMENT_COUNT must be at least 1
+#endif
+
+#if ( ipconfigTCP_TINY_TX_SEGMENT_COUNT > 8 )
+    #error ipconfigTCP_TINY_TX_SEGMENT_COUNT must be at most 8
+#endif
+
+#if ( ( ipconfigTCP_TINY_TX_SEGMENT_COUNT > 1 ) && ipconfigIS_ENABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigTCP_TINY_TX_SEGMENT_COUNT is only used when ipconfigUSE_TCP_WIN is disabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_SRTT_MINIMUM_VALUE_MS
+ *
+ * Type: int32_t
+ * Unit: milliseconds
+ * Minimum: 0
+ *
+ * When measuring the Smoothed Round Trip Time (SRTT),
+ * the result will be rounded up to a minimum value.
+ * The default has always been 50, but a value of 1000
+ * is recommended ( see RFC6298 ) because hosts often delay the
+ * sending of ACK packets with 200 ms.
+ */
+
+#ifndef ipconfigTCP_SRTT_MINIMUM_VALUE_MS
+    #define ipconfigTCP_SRTT_MINIMUM_VALUE_MS    ( 50 )
+#endif
+
+#if ( ipconfigTCP_SRTT_MINIMUM_VALUE_MS < 0 )
+    #error ipconfigTCP_SRTT_MINIMUM_VALUE_MS must be at least 0
+#endif
+
+#if ( ipconfigTCP_SRTT_MINIMUM_VALUE_MS > UINT32_MAX )
+    #error ipconfigTCP_SRTT_MINIMUM_VALUE_MS overflows a uint32_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_HIGH_RES_TIMER
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the sliding window reads the transmission times of TCP
+ * segments from ipconfigTCP_HIGH_RES_TIME_US() in stead of the tick count.
+ * Round-trip times are measured and smoothed in microseconds, and the
+ * retransmission time-outs are checked with that resolution. With a clock
+ * tick of 10 ms, a round-trip time of 100 us on a LAN is otherwise measured
+ * as either 0 or 10 ms.
+ *
+ * The IP-task still sleeps in clock ticks: a time-out is handled on the first
+ * tick after it expired. Set ipconfigTCP_SRTT_MINIMUM_VALUE_MS to a low value
+ * to let the time-outs follow the measured round-trip times.
+ */
+
+#ifndef ipconfigUSE_TCP_HIGH_RES_TIMER
+    #define ipconfigUSE_TCP_HIGH_RES_TIMER    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_HIGH_RES_TIMER != ipconfigDISABLE ) && ( ipconfigUSE_TCP_HIGH_RES_TIMER != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_HIGH_RES_TIMER configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_HIGH_RES_TIMER ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigUSE_TCP_HIGH_RES_TIMER requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_HIGH_RES_TIME_US
+ *
+ * Type: Macro Function
+ * Unit: microseconds
+ *
+ * Returns a free-running 32-bit time in microseconds for
+ * ipconfigUSE_TCP_HIGH_RES_TIMER, e.g. derived from a cycle counter or a
+ * hardware timer. It must wrap around at 2^32, and it is only called from
+ * the IP-task. The default has the resolution of a clock tick.
+ */
+
+#ifndef ipconfigTCP_HIGH_RES_TIME_US
+    #define ipconfigTCP_HIGH_RES_TIME_US() \
+    ( ( uint32_t ) ( ( ( uint64_t ) xTaskGetTickCount() * 1000000U ) / configTICK_RATE_HZ ) )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_WIN_SEG_COUNT
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_WIN_SEG_COUNT
+ *
+ * Type: size_t
+ * Unit: count of sliding windows
+ * Minimum: 1
+ *
+ * If ipconfigUSE_TCP_WIN is set to 1 then each socket will use a
+ * sliding window. Sliding windows allow messages to arrive out-of
+ * order, and FreeRTOS-Plus-TCP uses window descriptors to track
+ * information about the packets in a window.
+ *
+ * A pool of descriptors is allocated when the first TCP connection is
+ * made. The descriptors are shared between all the sockets.
+ * ipconfigTCP_WIN_SEG_COUNT sets the number of descriptors in the
+ * pool, and each descriptor is approximately 64 bytes.
+ *
+ * As an example: If a system will have at most 16 simultaneous TCP
+ * connections, and each connection will have an Rx and Tx window of at
+ * most 8 segments, then the worst case maximum number of descriptors
+ * that will be required is 256 ( 16 * 2 * 8 ). However, the practical
+ * worst case is normally much lower than this as most packets will
+ * arrive in order.
+ *
+ * Data that arrives in order is stored without using a descriptor, so a
+ * large reception window does not need one descriptor per segment.  For
+ * windows of several megabytes, set ipconfigTCP_RX_INTERVAL_COUNT so that
+ * out-of-order data doesn't take a descriptor per segment either.  The
+ * window scale factor is at most 14, so a window may grow up to 1 GB.
+ */
+
+#ifndef ipconfigTCP_WIN_SEG_COUNT
+    #define ipconfigTCP_WIN_SEG_COUNT    ( 256 )
+#endif
+
+#if ( ipconfigTCP_WIN_SEG_COUNT < 1 )
+    #error ipconfigTCP_WIN_SEG_COUNT must be at least 1
+#endif
+
+#if ( ipconfigTCP_WIN_SEG_COUNT > SIZE_MAX )
+    #error ipconfigTCP_WIN_SEG_COUNT overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_TIMER_WHEEL
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * By default the IP-task checks the time-out of every TCP socket each time
+ * it handles the TCP timer, which is almost every time before it goes to
+ * sleep. When enabled, the time-outs of the TCP sockets are kept in a
+ * hierarchical timer wheel, so that only the sockets whose time-out has
+ * expired are visited. The time until the first time-out is read directly
+ * from the wheel.
+ *
+ * A socket that has nothing to send is scheduled for its next keep-alive
+ * ( ipconfigTCP_KEEP_ALIVE ) or hang-protection ( ipconfigTCP_HANG_PROTECTION )
+ * deadline, instead of every tcpMAXIMUM_TCP_WAKEUP_TIME_MS, so the work for
+ * idle connections depends on the number of deadlines that expire.
+ *
+ * A user task that changes the time-out of a socket, for instance in
+ * FreeRTOS_send(), queues only that socket for the IP-task to reschedule.
+ *
+ * This is useful when many TCP connections are open but mostly idle. It
+ * costs a few hundred bytes of RAM for the wheel, plus three ListItem_t in
+ * every TCP socket. A TickType_t of 32 bits is recommended.
+ */
+
+#ifndef ipconfigUSE_TCP_TIMER_WHEEL
+    #define ipconfigUSE_TCP_TIMER_WHEEL    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_TIMER_WHEEL != ipconfigDISABLE ) && ( ipconfigUSE_TCP_TIMER_WHEEL != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_TIMER_WHEEL configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_TSO
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * TCP Segmentation Offload. When enabled, TCP may combine consecutive
+ * segments of its transmission window into a single large packet, if the
+ * network interface has set 'bits.bTCPSegmentationOffload'. The packet may be
+ * up to ipconfigTCP_TSO_MAX_SIZE bytes of payload, the driver splits it into
+ * segments of 'usTCPSegmentSize' bytes, which is set in the network buffer.
+ * Interfaces without the flag get MSS-sized packets as usual.
+ *
+ * Large packets only can be created when the network buffers have a variable
+ * size, i.e. with BufferAllocation_2.c or BufferAllocation_3.c. The driver
+ * must also calculate the IP and TCP checksums: either all interfaces do,
+ * see ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM, or the interface has set
+ * 'bits.bTxChecksumOffload', see ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD.
+ * Other interfaces get MSS-sized packets.
+ */
+
+#ifndef ipconfigUSE_TCP_TSO
+    #define ipconfigUSE_TCP_TSO    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_TSO != ipconfigDISABLE ) && ( ipconfigUSE_TCP_TSO != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_TSO configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_TSO ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigUSE_TCP_TSO requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TSO_MAX_SIZE
+ *
+ * Type: size_t
+ * Unit: bytes of TCP payload
+ * Minimum: 1
+ * Maximum: 65435
+ *
+ * The maximum amount of payload that TCP puts in a single packet for a network
+ * interface supporting segmentation offload, see ipconfigUSE_TCP_TSO. The IP
+ * length field limits a packet to 64 KB, including the IP and TCP header.
+ */
+
+#ifndef ipconfigTCP_TSO_MAX_SIZE
+    #define ipconfigTCP_TSO_MAX_SIZE    ( 16384U )
+#endif
+
+#if ( ipconfigTCP_TSO_MAX_SIZE < 1 )
+    #error ipconfigTCP_TSO_MAX_SIZE must be at least 1
+#endif
+
+#if ( ipconfigTCP_TSO_MAX_SIZE > 65435 )
+    #error ipconfigTCP_TSO_MAX_SIZE overflows the IP length field
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_RX_COALESCE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Receive coalescing, also known as software GRO/LRO. When enabled, the
+ * IP-task merges consecutive in-order data segments of the same TCP connection
+ * that arrive in one burst of received frames into a single segment, before
+ * passing it to xProcessReceivedTCPPacket(). The socket lookup, the window
+ * processing and the ACK decision are then done once per burst in stead of
+ * once per segment.
+ *
+ * Only segments that carry data with the flags ACK or ACK+PSH, and that have
+ * the same acknowledgement number, window and TCP options are merged.
+ *
+ * A burst is a chain of buffers passed with ipconfigUSE_LINKED_RX_MESSAGES,
+ * e.g. by xSendRxBurstToIPTask(), or the contents of the receive ring of
+ * ipconfigUSE_NETWORK_RX_RING. Merging needs network buffers of a variable
+ * size, i.e. BufferAllocation_2.c or BufferAllocation_3.c.
+ */
+
+#ifndef ipconfigUSE_TCP_RX_COALESCE
+    #define ipconfigUSE_TCP_RX_COALESCE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_RX_COALESCE != ipconfigDISABLE ) && ( ipconfigUSE_TCP_RX_COALESCE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_RX_COALESCE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_RX_COALESCE_MAX_SIZE
+ *
+ * Type: size_t
+ * Unit: bytes of TCP payload
+ * Minimum: 1
+ * Maximum: 65435
+ *
+ * The maximum amount of payload in a segment that was merged by the receive
+ * coalescing, see ipconfigUSE_TCP_RX_COALESCE.
+ */
+
+#ifndef ipconfigTCP_RX_COALESCE_MAX_SIZE
+    #define ipconfigTCP_RX_COALESCE_MAX_SIZE    ( 16384U )
+#endif
+
+#if ( ipconfigTCP_RX_COALESCE_MAX_SIZE < 1 )
+    #error ipconfigTCP_RX_COALESCE_MAX_SIZE must be at least 1
+#endif
+
+#if ( ipconfigTCP_RX_COALESCE_MAX_SIZE > 65435 )
+    #error ipconfigTCP_RX_COALESCE_MAX_SIZE overflows the IP length field
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_CONGESTION_CONTROL
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, every TCP connection keeps a congestion window that limits
+ * the amount of unacknowledged data, next to the window advertised by the
+ * peer. The congestion window is managed by a congestion control algorithm:
+ * NewReno ( RFC 5681 and RFC 6582 ) is used by default, CUBIC ( RFC 9438 ) can
+ * be selected per socket with the socket option FREERTOS_SO_TCP_CONGESTION.
+ * Applications may also supply their own TCPCongestionControl_t.
+ *
+ * When disabled, a connection may send as much data as its transmit window
+ * and the peer's window allow.
+ */
+
+#ifndef ipconfigUSE_TCP_CONGESTION_CONTROL
+    #define ipconfigUSE_TCP_CONGESTION_CONTROL    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_CONGESTION_CONTROL != ipconfigDISABLE ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_CONGESTION_CONTROL configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_CONGESTION_CONTROL ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigUSE_TCP_CONGESTION_CONTROL requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_TIMESTAMP_OPTION
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the TCP Timestamps option ( RFC 7323 ) is offered in every
+ * SYN, and accepted when a peer offers it. Once both parties agreed, every
+ * segment carries a time-stamp, and the time-stamp echoed by the peer is used
+ * to measure the round-trip time for each ACK, also after retransmissions.
+ * Segments carrying a time-stamp older than the most recent one are dropped
+ * ( PAWS: Protection Against Wrapped Sequences ).
+ *
+ * The option takes 12 bytes of every segment, which are deducted from the
+ * MSS of the connection.
+ *
+ * This is not the deprecated macro ipconfigUSE_TCP_TIMESTAMPS, which never
+ * had an implementation.
+ */
+
+#ifndef ipconfigUSE_TCP_TIMESTAMP_OPTION
+    #define ipconfigUSE_TCP_TIMESTAMP_OPTION    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_TIMESTAMP_OPTION != ipconfigDISABLE ) && ( ipconfigUSE_TCP_TIMESTAMP_OPTION != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_TIMESTAMP_OPTION configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_TIMESTAMP_OPTION ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigUSE_TCP_TIMESTAMP_OPTION requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_RACK_TLP
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, TCP uses time-based loss detection ( RACK, RFC 8985 ) next to
+ * the counting of duplicate ACK's. When an ACK or SACK shows that a segment
+ * has been delivered, every outstanding segment that was sent more than a
+ * reordering window earlier is considered lost and retransmitted at once.
+ *
+ * Also, the first retransmission time-out of a segment is replaced by a
+ * Tail Loss Probe ( TLP ): the most recently sent segment is retransmitted,
+ * so that the peer's ACK or SACK reveals which segments at the tail of a
+ * transfer are missing. Such losses are then repaired without waiting for
+ * another time-out, and without collapsing the congestion window.
+ */
+
+#ifndef ipconfigUSE_TCP_RACK_TLP
+    #define ipconfigUSE_TCP_RACK_TLP    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_RACK_TLP != ipconfigDISABLE ) && ( ipconfigUSE_TCP_RACK_TLP != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_RACK_TLP configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_RACK_TLP ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigUSE_TCP_RACK_TLP requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_HEADER_PREDICTION
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, every received TCP segment is first compared with what its
+ * connection expects next ( header prediction, as described by Van
+ * Jacobson ). A segment on an established connection that only has the ACK
+ * and PSH flags, starts at the next expected sequence number, and has either
+ * no options or only the time-stamps option, skips the option parser and the
+ * state machine of prvTCPHandleState(): a pure ACK is handed to the sliding
+ * window, in-order data is stored directly.
+ *
+ * All other segments, including out-of-order data, SACK's and segments of a
+ * connection that is closing, take the normal path.
+ */
+
+#ifndef ipconfigUSE_TCP_HEADER_PREDICTION
+    #define ipconfigUSE_TCP_HEADER_PREDICTION    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_HEADER_PREDICTION != ipconfigDISABLE ) && ( ipconfigUSE_TCP_HEADER_PREDICTION != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_HEADER_PREDICTION configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_ACK_TEMPLATE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, an established TCP connection keeps a copy of the Ethernet
+ * and IP headers of the packets that it sends, along with the end-point and
+ * the partial checksums of the parts that don't change. Pure ACK's and
+ * window updates are then made from that copy: only the sequence and ACK
+ * numbers, the window, the lengths and the checksums are filled in, and the
+ * ARP or ND cache is not looked up.
+ *
+ * The copy is dropped as soon as the ARP or ND cache changes, or when an
+ * end-point goes up or down. It costs 76 bytes per TCP socket.
+ */
+
+#ifndef ipconfigUSE_TCP_ACK_TEMPLATE
+    #define ipconfigUSE_TCP_ACK_TEMPLATE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_ACK_TEMPLATE != ipconfigDISABLE ) && ( ipconfigUSE_TCP_ACK_TEMPLATE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_ACK_TEMPLATE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_ACK_POLICY
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the socket option FREERTOS_SO_TCP_ACK_POLICY selects how a
+ * TCP socket delays its ACK's. By default, an ACK is delayed by
+ * tcpDELAYED_ACK_SHORT_DELAY_MS after a small segment and by
+ * tcpDELAYED_ACK_LONGER_DELAY_MS after a full-size segment. A socket can
+ * also ACK every segment immediately ( request/response traffic ), ACK every
+ * N segments ( bulk receivers ), or adapt: ACK immediately when the traffic
+ * looks interactive, and every second full-size segment during a bulk
+ * transfer. See TCPAckPolicy_t in FreeRTOS_Sockets.h.
+ *
+ * Delayed ACK's are only used when ipconfigUSE_TCP_WIN is enabled.
+ */
+
+#ifndef ipconfigUSE_TCP_ACK_POLICY
+    #define ipconfigUSE_TCP_ACK_POLICY    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_ACK_POLICY != ipconfigDISABLE ) && ( ipconfigUSE_TCP_ACK_POLICY != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_ACK_POLICY configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_ACK_POLICY ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigUSE_TCP_ACK_POLICY requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_FAST_OPEN
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the socket option FREERTOS_SO_TCP_FASTOPEN lets a TCP socket
+ * use TCP Fast Open ( RFC 7413 ). A listening socket hands out a cookie to
+ * the clients that ask for one, and accepts the data in a SYN that carries a
+ * valid cookie. A client socket keeps the cookies it received in a cache of
+ * ipconfigTCP_FAST_OPEN_CACHE_ENTRIES destinations. A client socket that is
+ * bound may call FreeRTOS_send() before FreeRTOS_connect(): the data is sent
+ * along with the SYN when a cookie for the peer is known, saving a
+ * round-trip.
+ *
+ * The server cookie is a keyed hash of the client's IP address. The key is
+ * taken from xApplicationGetRandomNumber() when it is first needed.
+ */
+
+#ifndef ipconfigUSE_TCP_FAST_OPEN
+    #define ipconfigUSE_TCP_FAST_OPEN    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_FAST_OPEN != ipconfigDISABLE ) && ( ipconfigUSE_TCP_FAST_OPEN != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_FAST_OPEN configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_FAST_OPEN ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigUSE_TCP_FAST_OPEN requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_FAST_OPEN_CACHE_ENTRIES
+ *
+ * Type: UBaseType_t
+ * Unit: count of destinations
+ * Minimum: 1
+ *
+ * The number of Fast Open cookies that the client sockets remember, one per
+ * peer IP address. When the cache is full, the oldest entry is replaced.
+ * Only used when ipconfigUSE_TCP_FAST_OPEN is enabled.
+ */
+
+#ifndef ipconfigTCP_FAST_OPEN_CACHE_ENTRIES
+    #define ipconfigTCP_FAST_OPEN_CACHE_ENTRIES    4
+#endif
+
+#if ( ipconfigTCP_FAST_OPEN_CACHE_ENTRIES < 1 )
+    #error ipconfigTCP_FAST_OPEN_CACHE_ENTRIES must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_SYN_COOKIES
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, a listening socket whose backlog ( see FreeRTOS_listen() ) is
+ * full answers a SYN with a SYN cookie in stead of a RST. No socket is
+ * created: the SYN+ACK is sent from the received packet, and its sequence
+ * number is a keyed hash of the addresses, the ports, the client's sequence
+ * number and a 64-second time slot. The client's MSS is encoded in the
+ * lowest 3 bits. When the final ACK of the handshake carries a valid cookie,
+ * the child socket is created and becomes connected at once.
+ *
+ * A flood of SYN packets from spoofed addresses can therefore not exhaust
+ * the sockets and the memory of the device. When the backlog is still full
+ * as a valid cookie returns, the oldest half-open child socket that was
+ * never passed to the application is dropped to make room for it. That
+ * requires ipconfigTCP_HANG_PROTECTION, without it the ACK is ignored.
+ *
+ * A connection that was set up with a cookie does not use window scaling,
+ * selective ACKs or time stamps. The key of the hash is taken from
+ * xApplicationGetRandomNumber() when it is first needed.
+ */
+
+#ifndef ipconfigUSE_TCP_SYN_COOKIES
+    #define ipconfigUSE_TCP_SYN_COOKIES    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_SYN_COOKIES != ipconfigDISABLE ) && ( ipconfigUSE_TCP_SYN_COOKIES != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_SYN_COOKIES configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_PATH_MTU_DISCOVERY
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, TCP uses Path MTU Discovery ( RFC 1191, RFC 8201 ). IPv4
+ * segments are sent with the "don't fragment" flag. An ICMP "fragmentation
+ * needed" or ICMPv6 "packet too big" message that quotes a segment of a
+ * connection lowers the MSS of that connection, and the new path MTU is
+ * remembered in a cache of ipconfigPATH_MTU_CACHE_ENTRIES destinations, so
+ * that new connections to the same peer start with the right MSS.
+ *
+ * When the ICMP messages never arrive, a full-size segment that times out
+ * tcpPATH_MTU_BLACK_HOLE_TIMEOUTS times in a row makes the connection fall
+ * back to the minimum MSS ( 536 bytes for IPv4, 1220 bytes for IPv6 ), as in
+ * the black hole detection of RFC 4821. This detection needs
+ * ipconfigUSE_TCP_WIN.
+ *
+ * Only new segments use the lower MSS. An IPv4 segment that was queued
+ * earlier and that is now too large is sent without the "don't fragment"
+ * flag, so that it can be fragmented on its way.
+ */
+
+#ifndef ipconfigUSE_TCP_PATH_MTU_DISCOVERY
+    #define ipconfigUSE_TCP_PATH_MTU_DISCOVERY    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != ipconfigDISABLE ) && ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_PATH_MTU_DISCOVERY configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_PATH_MTU_DISCOVERY ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigUSE_TCP_PATH_MTU_DISCOVERY requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigPATH_MTU_CACHE_ENTRIES
+ *
+ * Type: UBaseType_t
+ * Unit: count of destinations
+ * Minimum: 1
+ *
+ * The number of destinations for which a path MTU is remembered. When the
+ * cache is full, the oldest entry is replaced. Only used when
+ * ipconfigUSE_TCP_PATH_MTU_DISCOVERY is enabled.
+ */
+
+#ifndef ipconfigPATH_MTU_CACHE_ENTRIES
+    #define ipconfigPATH_MTU_CACHE_ENTRIES    8
+#endif
+
+#if ( ipconfigPATH_MTU_CACHE_ENTRIES < 1 )
+    #error ipconfigPATH_MTU_CACHE_ENTRIES must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigPATH_MTU_CACHE_AGE_SEC
+ *
+ * Type: uint32_t
+ * Unit: seconds
+ * Minimum: 1
+ *
+ * The time after which a path MTU in the cache is forgotten, so that a new
+ * connection tries the full MSS again and finds out if the path has become
+ * wider. RFC 1191 recommends 10 minutes. Only used when
+ * ipconfigUSE_TCP_PATH_MTU_DISCOVERY is enabled.
+ */
+
+#ifndef ipconfigPATH_MTU_CACHE_AGE_SEC
+    #define ipconfigPATH_MTU_CACHE_AGE_SEC    600U
+#endif
+
+#if ( ipconfigPATH_MTU_CACHE_AGE_SEC < 1 )
+    #error ipconfigPATH_MTU_CACHE_AGE_SEC must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_RX_INTERVAL_COUNT
+ *
+ * Type: UBaseType_t
+ * Unit: count of intervals
+ * Minimum: 0
+ * Maximum: 255
+ *
+ * When zero, every segment that arrives out-of-order occupies a descriptor
+ * from the pool of ipconfigTCP_WIN_SEG_COUNT descriptors. The descriptors are
+ * kept in order of arrival and are searched linearly, which becomes slow for
+ * large windows with many holes.
+ *
+ * When non-zero, each TCP window stores the out-of-order data it has received
+ * as an array of at most ipconfigTCP_RX_INTERVAL_COUNT intervals of sequence
+ * numbers, sorted and merged when they touch. Looking up an interval takes a
+ * binary search, and the SACK option describes the complete interval that
+ * contains the last segment received. The reception no longer borrows
+ * descriptors from the pool. Each interval takes 8 bytes in every socket.
+ */
+#ifndef ipconfigTCP_RX_INTERVAL_COUNT
+    #define ipconfigTCP_RX_INTERVAL_COUNT    0
+#endif
+
+#if ( ( ipconfigTCP_RX_INTERVAL_COUNT < 0 ) || ( ipconfigTCP_RX_INTERVAL_COUNT > 255 ) )
+    #error ipconfigTCP_RX_INTERVAL_COUNT must be between 0 and 255
+#endif
+
+#if ( ( ipconfigTCP_RX_INTERVAL_COUNT != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigTCP_RX_INTERVAL_COUNT requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TX_SEGMENT_INDEX_COUNT
+ *
+ * Type: UBaseType_t
+ * Unit: count of segments
+ * Minimum: 0
+ * Maximum: 255
+ *
+ * When zero, an incoming ACK or SACK block is matched against the outgoing
+ * segments by walking xTxSegments from its head, which skips every segment
+ * that lies below the acknowledged range.
+ *
+ * When non-zero, each TCP window also keeps the addresses of its first
+ * ipconfigTCP_TX_SEGMENT_INDEX_COUNT outgoing segments in an array, in order
+ * of sequence number. The first segment of a SACK block is then found with a
+ * binary search. When a window has more outgoing segments than the array can
+ * hold, it falls back to the linear walk until all its data has been
+ * acknowledged. Each entry takes the size of a pointer in every socket.
+ */
+#ifndef ipconfigTCP_TX_SEGMENT_INDEX_COUNT
+    #define ipconfigTCP_TX_SEGMENT_INDEX_COUNT    0
+#endif
+
+#if ( ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT < 0 ) || ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT > 255 ) )
+    #error ipconfigTCP_TX_SEGMENT_INDEX_COUNT must be between 0 and 255
+#endif
+
+#if ( ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigTCP_TX_SEGMENT_INDEX_COUNT requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_WIN_SEG_CHUNK_COUNT
+ *
+ * Type: size_t
+ * Unit: count of segment descriptors
+ * Minimum: 0
+ *
+ * When zero, the pool of ipconfigTCP_WIN_SEG_COUNT segment descriptors is
+ * allocated as a single block when the first TCP connection is made, and it
+ * is never freed.
+ *
+ * When non-zero, the pool grows on demand in chunks of this many descriptors,
+ * up to a total of ipconfigTCP_WIN_SEG_COUNT. A chunk of which none of the
+ * descriptors are in use is returned to the heap, unless the other chunks
+ * would have less than half a chunk of free descriptors left. The first chunk
+ * is kept as long as FreeRTOS+TCP is running.
+ */
+#ifndef ipconfigTCP_WIN_SEG_CHUNK_COUNT
+    #define ipconfigTCP_WIN_SEG_CHUNK_COUNT    0
+#endif
+
+#if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT < 0 )
+    #error ipconfigTCP_WIN_SEG_CHUNK_COUNT must be at least 0
+#endif
+
+#if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT > ipconfigTCP_WIN_SEG_COUNT )
+    #error ipconfigTCP_WIN_SEG_CHUNK_COUNT can not be larger than ipconfigTCP_WIN_SEG_COUNT
+#endif
+
+#if ( ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigTCP_WIN_SEG_CHUNK_COUNT requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_WIN_COMPACT_SEGMENTS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Every segment descriptor is linked in two lists.  By default these are
+ * FreeRTOS lists, each link is a ListItem_t of five words.  When enabled, the
+ * descriptors are linked by the 16-bit index of their neighbours in the pool
+ * of ipconfigTCP_WIN_SEG_COUNT descriptors, plus a pointer to the list.  On a
+ * 32-bit platform a descriptor shrinks from 64 to 40 bytes, so the same
+ * memory holds 60% more segments in flight.
+ *
+ * The pool must be allocated as a single block: ipconfigTCP_WIN_SEG_CHUNK_COUNT
+ * must be 0.
+ */
+#ifndef ipconfigTCP_WIN_COMPACT_SEGMENTS
+    #define ipconfigTCP_WIN_COMPACT_SEGMENTS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigTCP_WIN_COMPACT_SEGMENTS != ipconfigDISABLE ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS != ipconfigENABLE ) )
+    #error Invalid ipconfigTCP_WIN_COMPACT_SEGMENTS configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigTCP_WIN_COMPACT_SEGMENTS ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigTCP_WIN_COMPACT_SEGMENTS requires ipconfigUSE_TCP_WIN
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigTCP_WIN_COMPACT_SEGMENTS ) && ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 ) )
+    #error ipconfigTCP_WIN_COMPACT_SEGMENTS can not be used with ipconfigTCP_WIN_SEG_CHUNK_COUNT
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigTCP_WIN_COMPACT_SEGMENTS ) && ( ipconfigTCP_WIN_SEG_COUNT >= 0xFFFF ) )
+    #error ipconfigTCP_WIN_COMPACT_SEGMENTS requires ipconfigTCP_WIN_SEG_COUNT to be less than 65535
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_WIN_SEG_SOCKET_LIMIT
+ *
+ * Type: size_t
+ * Unit: count of segment descriptors
+ * Minimum: 0
+ *
+ * The maximum number of segment descriptors that a single TCP socket may
+ * borrow from the shared pool, for reception and transmission together. This
+ * prevents a bulk transfer from exhausting the pool, so that descriptors stay
+ * available for other connections. When the limit is reached, the socket
+ * simply queues less data, as if the pool was empty. Zero means no limit.
+ */
+#ifndef ipconfigTCP_WIN_SEG_SOCKET_LIMIT
+    #define ipconfigTCP_WIN_SEG_SOCKET_LIMIT    0
+#endif
+
+#if ( ipconfigTCP_WIN_SEG_SOCKET_LIMIT < 0 )
+    #error ipconfigTCP_WIN_SEG_SOCKET_LIMIT must be at least 0
+#endif
+
+#if ( ( ipconfigTCP_WIN_SEG_SOCKET_LIMIT != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigTCP_WIN_SEG_SOCKET_LIMIT requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TX_REFERENCE_COUNT
+ *
+ * Type: UBaseType_t
+ * Unit: count of buffers
+ * Minimum: 0
+ * Maximum: 255
+ *
+ * When non-zero, FreeRTOS_send_reference() is available. It queues a buffer
+ * owned by the application for transmission, without copying its contents
+ * into the transmit stream: the data is copied directly from the buffer into
+ * the outgoing packets. The buffer must stay valid until a callback reports
+ * that all of its data have been acknowledged, or that the socket was closed.
+ *
+ * This sets the number of such buffers that can be queued per socket at the
+ * same time. The space in the transmit stream is still reserved as usual,
+ * so the stream size limits the number of bytes in flight.
+ */
+#ifndef ipconfigTCP_TX_REFERENCE_COUNT
+    #define ipconfigTCP_TX_REFERENCE_COUNT    0
+#endif
+
+#if ( ( ipconfigTCP_TX_REFERENCE_COUNT < 0 ) || ( ipconfigTCP_TX_REFERENCE_COUNT > 255 ) )
+    #error ipconfigTCP_TX_REFERENCE_COUNT must be between 0 and 255
+#endif
+
+#if ( ( ipconfigTCP_TX_REFERENCE_COUNT != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigTCP_TX_REFERENCE_COUNT requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_RX_BUFFER_COUNT
+ *
+ * Type: UBaseType_t
+ * Unit: count of network buffers
+ * Minimum: 0
+ * Maximum: 255
+ *
+ * When non-zero, a TCP socket can be put in buffer-chain mode with the socket
+ * option FREERTOS_SO_RX_BUFFER_CHAIN. In that mode, a network buffer that
+ * carries in-order data is kept by the socket, and its payload is not copied
+ * into the reception stream. FreeRTOS_recv() with FREERTOS_ZERO_COPY returns
+ * a pointer into the network buffer, which is released when the application
+ * calls FreeRTOS_ReleaseTCPPayloadBuffer() for all of its bytes.
+ *
+ * This sets the number of network buffers that one socket may keep at the
+ * same time. When all are in use, the data is copied as usual. Note that the
+ * buffers are taken from the pool shared with the network drivers.
+ */
+#ifndef ipconfigTCP_RX_BUFFER_COUNT
+    #define ipconfigTCP_RX_BUFFER_COUNT    0
+#endif
+
+#if ( ( ipconfigTCP_RX_BUFFER_COUNT < 0 ) || ( ipconfigTCP_RX_BUFFER_COUNT > 255 ) )
+    #error ipconfigTCP_RX_BUFFER_COUNT must be between 0 and 255
+#endif
+
+#if ( ( ipconfigTCP_RX_BUFFER_COUNT != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigTCP_RX_BUFFER_COUNT requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_LISTEN_POOL_SIZE
+ *
+ * Type: UBaseType_t
+ * Unit: count of sockets
+ * Minimum: 0
+ * Maximum: 255
+ *
+ * When non-zero, a listening TCP socket can keep a pool of child sockets that
+ * were created in advance, see the socket option FREERTOS_SO_LISTEN_POOL.
+ * When a SYN arrives, the IP-task takes a socket from the pool instead of
+ * allocating a new one. The pool is filled again by FreeRTOS_listen() and
+ * FreeRTOS_accept(), so the allocations are done by the application task.
+ *
+ * This sets the maximum number of sockets in the pool of one listening
+ * socket. When the pool is empty, a child socket is allocated as usual.
+ */
+#ifndef ipconfigTCP_LISTEN_POOL_SIZE
+    #define ipconfigTCP_LISTEN_POOL_SIZE    0
+#endif
+
+#if ( ( ipconfigTCP_LISTEN_POOL_SIZE < 0 ) || ( ipconfigTCP_LISTEN_POOL_SIZE > 255 ) )
+    #error ipconfigTCP_LISTEN_POOL_SIZE must be between 0 and 255
+#endif
+
+#if ( ( ipconfigTCP_LISTEN_POOL_SIZE != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigTCP_LISTEN_POOL_SIZE requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_ACCEPT_QUEUE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, a listening TCP socket keeps a FIFO of the child sockets
+ * that got connected but were not yet returned by FreeRTOS_accept(). The
+ * IP-task appends a child when it becomes connected, and FreeRTOS_accept()
+ * takes the oldest one from the head of the queue. When disabled,
+ * FreeRTOS_accept() sends an eTCPAcceptEvent to the IP-task, which searches
+ * the list of bound TCP sockets for the next connected child.
+ */
+
+#ifndef ipconfigTCP_ACCEPT_QUEUE
+    #define ipconfigTCP_ACCEPT_QUEUE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigTCP_ACCEPT_QUEUE != ipconfigDISABLE ) && ( ipconfigTCP_ACCEPT_QUEUE != ipconfigENABLE ) )
+    #error Invalid ipconfigTCP_ACCEPT_QUEUE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TIME_WAIT_COUNT
+ *
+ * Type: UBaseType_t
+ * Unit: count of connections
+ * Minimum: 0
+ * Maximum: 255
+ *
+ * When non-zero, a TCP connection whose FIN exchange is complete is
+ * remembered in a small table: the addresses, the ports and the sequence
+ * numbers. When the peer repeats its FIN because the last ACK got lost, the
+ * ACK is sent again from this record, also when the socket has been closed
+ * already. Without the record, such a FIN would be answered with a RST. This
+ * allows the application to close a socket, and to free its memory, as soon
+ * as it reaches the eCLOSE_WAIT state.
+ *
+ * This sets the number of records. When all are in use, the oldest record is
+ * replaced.
+ */
+#ifndef ipconfigTCP_TIME_WAIT_COUNT
+    #define ipconfigTCP_TIME_WAIT_COUNT    0
+#endif
+
+#if ( ( ipconfigTCP_TIME_WAIT_COUNT < 0 ) || ( ipconfigTCP_TIME_WAIT_COUNT > 255 ) )
+    #error ipconfigTCP_TIME_WAIT_COUNT must be between 0 and 255
+#endif
+
+#if ( ( ipconfigTCP_TIME_WAIT_COUNT != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigTCP_TIME_WAIT_COUNT requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TIME_WAIT_TIME
+ *
+ * Type: TickType_t
+ * Unit: seconds
+ * Minimum: 1
+ * Maximum: portMAX_DELAY / configTICK_RATE_HZ
+ *
+ * The time that a record in the table of ipconfigTCP_TIME_WAIT_COUNT stays
+ * valid.
+ */
+#ifndef ipconfigTCP_TIME_WAIT_TIME
+    #define ipconfigTCP_TIME_WAIT_TIME    ( 30 )
+#endif
+
+#if ( ipconfigTCP_TIME_WAIT_TIME < 1 )
+    #error ipconfigTCP_TIME_WAIT_TIME must be at least 1
+#endif
+
+STATIC_ASSERT( ipconfigTCP_TIME_WAIT_TIME <= ( portMAX_DELAY / configTICK_RATE_HZ ) );
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_PACING
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, a TCP socket can pace its transmissions with the socket
+ * option FREERTOS_SO_TCP_PACING. In stead of sending up to SEND_REPEATED_COUNT
+ * segments back-to-back when the window opens, the segments are released at
+ * a steady rate. The rate is either set by the application, or derived from
+ * the congestion window ( or the transmission window ) and the smoothed
+ * round-trip time. This helps when the path contains devices with shallow
+ * buffers, such as cellular modems.
+ */
+#ifndef ipconfigUSE_TCP_PACING
+    #define ipconfigUSE_TCP_PACING    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_PACING != ipconfigDISABLE ) && ( ipconfigUSE_TCP_PACING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_PACING configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_PACING ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigUSE_TCP_PACING requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_SPLICE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the received data of a TCP socket can be forwarded to another
+ * TCP socket with the socket option FREERTOS_SO_TCP_SPLICE. The IP-task moves
+ * the data from the reception stream of the source to the transmission stream
+ * of the target, in stead of the application calling FreeRTOS_recv() and
+ * FreeRTOS_send(). Data that does not fit in the transmission stream stays in
+ * the reception stream, so the receive window of the source only opens when
+ * the peer of the target acknowledges data.
+ *
+ * The owner of the source socket is not woken up for spliced data. Closing
+ * the connections is left to the application.
+ */
+#ifndef ipconfigUSE_TCP_SPLICE
+    #define ipconfigUSE_TCP_SPLICE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_SPLICE != ipconfigDISABLE ) && ( ipconfigUSE_TCP_SPLICE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_SPLICE configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_SPLICE ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigUSE_TCP_SPLICE requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_RECORD_FRAMING
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, a TCP socket can be told with the socket option
+ * FREERTOS_SO_TCP_RECORD that its data consists of records with a length
+ * prefix. The owner of the socket is then only woken up when a complete
+ * record has been received, and FreeRTOS_recv_record() returns the record
+ * as a view into the reception stream, without copying it.
+ */
+#ifndef ipconfigUSE_TCP_RECORD_FRAMING
+    #define ipconfigUSE_TCP_RECORD_FRAMING    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_RECORD_FRAMING != ipconfigDISABLE ) && ( ipconfigUSE_TCP_RECORD_FRAMING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_RECORD_FRAMING configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_RECORD_FRAMING ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigUSE_TCP_RECORD_FRAMING requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_AUTO_TUNING
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the IP-task measures how many bytes a TCP connection
+ * transfers in each direction during one smoothed round-trip time. When the
+ * reception or transmission window limits the throughput, the stream buffer
+ * and the window are enlarged, up to ipconfigTCP_AUTO_TUNING_MAX_LENGTH. A
+ * transmission stream that has grown will shrink again when it is no longer
+ * needed. The extra memory of all sockets together is limited to
+ * ipconfigTCP_AUTO_TUNING_BUDGET bytes.
+ *
+ * Sockets whose buffer sizes were set with FREERTOS_SO_RCVBUF,
+ * FREERTOS_SO_SNDBUF or FREERTOS_SO_WIN_PROPERTIES are not tuned. Neither are
+ * sockets that use the zero-copy interface to their streams.
+ */
+#ifndef ipconfigUSE_TCP_AUTO_TUNING
+    #define ipconfigUSE_TCP_AUTO_TUNING    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_AUTO_TUNING != ipconfigDISABLE ) && ( ipconfigUSE_TCP_AUTO_TUNING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_AUTO_TUNING configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_AUTO_TUNING ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigUSE_TCP_AUTO_TUNING requires ipconfigUSE_TCP_WIN
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_AUTO_TUNING_MAX_LENGTH
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 2 * ipconfigTCP_MSS
+ *
+ * The largest size that ipconfigUSE_TCP_AUTO_TUNING gives to a stream buffer.
+ * The window is half of the stream size. The SYN of a tuned socket offers a
+ * window scaling factor that is large enough for this size.
+ */
+#ifndef ipconfigTCP_AUTO_TUNING_MAX_LENGTH
+    #define ipconfigTCP_AUTO_TUNING_MAX_LENGTH    ( 64U * 1024U )
+#endif
+
+#if ( ipconfigTCP_AUTO_TUNING_MAX_LENGTH < ( 2 * ipconfigTCP_MSS ) )
+    #error ipconfigTCP_AUTO_TUNING_MAX_LENGTH must be at least 2 * ipconfigTCP_MSS
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_AUTO_TUNING_BUDGET
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 0
+ *
+ * The number of bytes that ipconfigUSE_TCP_AUTO_TUNING may add to the stream
+ * buffers of all TCP sockets together. The memory is given back when a
+ * stream shrinks or when its socket is closed.
+ */
+#ifndef ipconfigTCP_AUTO_TUNING_BUDGET
+    #define ipconfigTCP_AUTO_TUNING_BUDGET    ( 128U * 1024U )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_LINK_SPEED_SIZING
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, every network interface has a field 'ulLinkSpeed' that holds
+ * the speed of its link in Mbit/s, or zero when it is not known. The driver
+ * updates it when the link comes up, e.g. with the value returned by
+ * ulPhyGetLinkSpeed() after xPhyCheckLinkStatus() has seen a change.
+ *
+ * A TCP connection then gets stream buffers that hold the bandwidth-delay
+ * product of the interface that it uses, assuming a round-trip time of
+ * ipconfigTCP_LINK_SPEED_RTT_MS, limited to ipconfigTCP_LINK_SPEED_MAX_LENGTH
+ * bytes and at least 2 * ipconfigTCP_MSS. The windows are half of the
+ * streams. A connection on a 1 Gbit/s link gets more room than the static
+ * configuration offers, and one on a 10 Mbit/s link does not hold on to
+ * buffers that it can not fill. The automatic pacing rate of
+ * ipconfigUSE_TCP_PACING does not exceed the speed of the link.
+ *
+ * Sockets whose buffer sizes were set with FREERTOS_SO_RCVBUF,
+ * FREERTOS_SO_SNDBUF, FREERTOS_SO_WIN_PROPERTIES or FREERTOS_SO_SET_LOW_HIGH_WATER,
+ * and sockets with static stream storage, keep their sizes.
+ */
+#ifndef ipconfigUSE_TCP_LINK_SPEED_SIZING
+    #define ipconfigUSE_TCP_LINK_SPEED_SIZING    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_LINK_SPEED_SIZING != ipconfigDISABLE ) && ( ipconfigUSE_TCP_LINK_SPEED_SIZING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_LINK_SPEED_SIZING configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_LINK_SPEED_SIZING ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigUSE_TCP_LINK_SPEED_SIZING requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_LINK_SPEED_RTT_MS
+ *
+ * Type: uint32_t
+ * Unit: milliseconds
+ * Minimum: 1
+ * Maximum: 1000
+ *
+ * The round-trip time that ipconfigUSE_TCP_LINK_SPEED_SIZING assumes when it
+ * calculates the bandwidth-delay product of a link. The default suits peers
+ * on the local network, use a larger value when most peers are further away.
+ */
+#ifndef ipconfigTCP_LINK_SPEED_RTT_MS
+    #define ipconfigTCP_LINK_SPEED_RTT_MS    2U
+#endif
+
+#if ( ( ipconfigTCP_LINK_SPEED_RTT_MS < 1 ) || ( ipconfigTCP_LINK_SPEED_RTT_MS > 1000 ) )
+    #error ipconfigTCP_LINK_SPEED_RTT_MS must be between 1 and 1000
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_LINK_SPEED_MAX_LENGTH
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 2 * ipconfigTCP_MSS
+ *
+ * The largest size that ipconfigUSE_TCP_LINK_SPEED_SIZING gives to a stream
+ * buffer. The SYN of the connection offers a window scaling factor that is
+ * large enough for half of this size.
+ */
+#ifndef ipconfigTCP_LINK_SPEED_MAX_LENGTH
+    #define ipconfigTCP_LINK_SPEED_MAX_LENGTH    ( 128U * 1024U )
+#endif
+
+#if ( ipconfigTCP_LINK_SPEED_MAX_LENGTH < ( 2 * ipconfigTCP_MSS ) )
+    #error ipconfigTCP_LINK_SPEED_MAX_LENGTH must be at least 2 * ipconfigTCP_MSS
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_STREAM_RELEASE_TIME
+ *
+ * Type: TickType_t
+ * Unit: seconds
+ * Minimum: 0
+ * Maximum: portMAX_DELAY / configTICK_RATE_HZ
+ *
+ * The stream buffers of a TCP socket are created when the first data is sent
+ * or received. When ipconfigTCP_STREAM_RELEASE_TIME is non-zero, the IP-task
+ * also takes away a stream of an established connection that has been empty
+ * for this number of seconds. It is created again when it is needed, so
+ * connections that are idle most of the time do not keep their buffers.
+ *
+ * A released stream is kept in a pool of ipconfigTCP_STREAM_POOL_COUNT
+ * buffers, from which a new stream of the same length is taken. A buffer that
+ * stays in the pool for another ipconfigTCP_STREAM_RELEASE_TIME seconds is
+ * returned to the heap.
+ *
+ * A zero value disables the release of idle streams.
+ */
+#ifndef ipconfigTCP_STREAM_RELEASE_TIME
+    #define ipconfigTCP_STREAM_RELEASE_TIME    0
+#endif
+
+#if ( ipconfigTCP_STREAM_RELEASE_TIME < 0 )
+    #error ipconfigTCP_STREAM_RELEASE_TIME must be at least 0
+#endif
+
+STATIC_ASSERT( ipconfigTCP_STREAM_RELEASE_TIME <= ( portMAX_DELAY / configTICK_RATE_HZ ) );
+
+#if ( ( ipconfigTCP_STREAM_RELEASE_TIME != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigTCP_STREAM_RELEASE_TIME requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_STREAM_POOL_COUNT
+ *
+ * Type: size_t
+ * Unit: count of stream buffers
+ * Minimum: 1
+ * Maximum: 255
+ *
+ * The number of released stream buffers that are kept for reuse, see
+ * ipconfigTCP_STREAM_RELEASE_TIME. The buffers of closed sockets are kept in
+ * the same pool. An idle stream is not released while the pool is full.
+ */
+#ifndef ipconfigTCP_STREAM_POOL_COUNT
+    #define ipconfigTCP_STREAM_POOL_COUNT    4
+#endif
+
+#if ( ipconfigTCP_STREAM_POOL_COUNT < 1 )
+    #error ipconfigTCP_STREAM_POOL_COUNT must be at least 1
+#endif
+
+#if ( ipconfigTCP_STREAM_POOL_COUNT > 255 )
+    #error ipconfigTCP_STREAM_POOL_COUNT overflows a uint8_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_BUFFER_ARENA_SIZE
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 0
+ *
+ * When non-zero, the TCP stream buffers and the segment descriptors of the
+ * sliding window are not allocated from the heap, but from a static arena of
+ * this number of bytes. The arena hands out blocks in a set of fixed size
+ * classes, see ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE, and keeps freed blocks in
+ * a free list per class. An allocation takes a constant time, it fails when
+ * the arena is exhausted, and the application heap is not fragmented by the
+ * networking.
+ *
+ * pvPortMallocLarge() and vPortFreeLarge() are mapped to pvTCPArenaMalloc()
+ * and vTCPArenaFree(), they can not be defined by the application as well.
+ *
+ * A zero value allocates the buffers with pvPortMallocLarge().
+ */
+#ifndef ipconfigTCP_BUFFER_ARENA_SIZE
+    #define ipconfigTCP_BUFFER_ARENA_SIZE    0
+#endif
+
+#if ( ipconfigTCP_BUFFER_ARENA_SIZE < 0 )
+    #error ipconfigTCP_BUFFER_ARENA_SIZE must be at least 0
+#endif
+
+#if ( ( ipconfigTCP_BUFFER_ARENA_SIZE != 0 ) && ( defined( pvPortMallocLarge ) || defined( vPortFreeLarge ) ) )
+    #error pvPortMallocLarge and vPortFreeLarge can not be combined with ipconfigTCP_BUFFER_ARENA_SIZE
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 32
+ *
+ * The size of the smallest block of the arena of ipconfigTCP_BUFFER_ARENA_SIZE,
+ * including a small header. Each next size class is twice as big. Must be a
+ * multiple of 8.
+ */
+#ifndef ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE
+    #define ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE    256
+#endif
+
+#if ( ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE < 32 )
+    #error ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE must be at least 32
+#endif
+
+#if ( ( ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE % 8 ) != 0 )
+    #error ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE must be a multiple of 8
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_BUFFER_ARENA_CLASS_COUNT
+ *
+ * Type: size_t
+ * Unit: count of size classes
+ * Minimum: 1
+ * Maximum: 16
+ *
+ * The number of size classes of the arena of ipconfigTCP_BUFFER_ARENA_SIZE.
+ * The largest block is ipconfigTCP_BUFFER_ARENA_BLOCK_SIZE shifted left by
+ * ( ipconfigTCP_BUFFER_ARENA_CLASS_COUNT - 1 ). It must hold the largest
+ * stream buffer, and the array of ipconfigTCP_WIN_SEG_COUNT segment
+ * descriptors.
+ */
+#ifndef ipconfigTCP_BUFFER_ARENA_CLASS_COUNT
+    #define ipconfigTCP_BUFFER_ARENA_CLASS_COUNT    8
+#endif
+
+#if ( ipconfigTCP_BUFFER_ARENA_CLASS_COUNT < 1 )
+    #error ipconfigTCP_BUFFER_ARENA_CLASS_COUNT must be at least 1
+#endif
+
+#if ( ipconfigTCP_BUFFER_ARENA_CLASS_COUNT > 16 )
+    #error ipconfigTCP_BUFFER_ARENA_CLASS_COUNT must be at most 16
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * pvPortMallocLarge / vPortFreeLarge
+ *
+ * Malloc functions specific to large TCP buffers for Rx/Tx.
+ */
+
+#if ( ipconfigTCP_BUFFER_ARENA_SIZE != 0 )
+    #define pvPortMallocLarge( size )    pvTCPArenaMalloc( size )
+    #define vPortFreeLarge( ptr )        vTCPArenaFree( ptr )
+#endif
+
+#ifndef pvPortMallocLarge
+    #define pvPortMallocLarge( size )    pvPortMalloc( size )
+#endif
+
+#ifndef vPortFreeLarge
+    #define vPortFreeLarge( ptr )    vPortFree( ptr )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*===========================================================================*/
+/*                                TCP CONFIG                                 */
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*                                UDP CONFIG                                 */
+/*===========================================================================*/
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUDP_MAX_RX_PACKETS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUDP_MAX_RX_PACKETS
+ *
+ * Type: UBaseType_t
+ * Unit: rx packets
+ * Minimum: 0
+ *
+ * ipconfigUDP_MAX_RX_PACKETS defines the maximum number of packets that can
+ * exist in the Rx queue of a UDP socket. For example, if
+ * ipconfigUDP_MAX_RX_PACKETS is set to 5 and there are already 5 packets
+ * queued on the UDP socket then subsequent packets received on that socket
+ * will be dropped until the queue length is less than 5 again.
+ * Can be overridden with the socket option 'FREERTOS_SO_UDP_MAX_RX_PACKETS'.
+ */
+
+#ifndef ipconfigUDP_MAX_RX_PACKETS
+    #define ipconfigUDP_MAX_RX_PACKETS    ( 0 )
+#endif
+
+#if ( ipconfigUDP_MAX_RX_PACKETS < 0 )
+    #error ipconfigUDP_MAX_RX_PACKETS must be at least 0
+#endif
+
+#if ( ipconfigUDP_MAX_RX_PACKETS > UINT_FAST8_MAX )
+    #error ipconfigUDP_MAX_RX_PACKETS overflows a UBaseType_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_SOCKET_MEMORY_BUDGET
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the memory that sockets hold is counted against a budget of
+ * ipconfigSOCKET_MEMORY_BUDGET bytes: the TCP stream buffers, the network
+ * buffers waiting in the queues of UDP sockets, and the chunks of TCP
+ * segment descriptors, see ipconfigTCP_WIN_SEG_CHUNK_COUNT.  FreeRTOS_GetSocketMemory() returns the part that one
+ * socket holds.
+ *
+ * A stream buffer or a chunk of descriptors that does not fit in the budget
+ * is not allocated, as if the heap were exhausted.  Above the low watermark,
+ * a UDP packet is only queued when its socket has no packets waiting, and
+ * TCP sockets advertise half of their free space.  Above the high watermark,
+ * all UDP packets are dropped and TCP sockets advertise at most one MSS.
+ * FreeRTOS_GetSocketMemoryStats() returns the use and the current pressure.
+ */
+
+#ifndef ipconfigUSE_SOCKET_MEMORY_BUDGET
+    #define ipconfigUSE_SOCKET_MEMORY_BUDGET    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_SOCKET_MEMORY_BUDGET != ipconfigDISABLE ) && ( ipconfigUSE_SOCKET_MEMORY_BUDGET != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_SOCKET_MEMORY_BUDGET configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_MEMORY_BUDGET
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 1
+ *
+ * The number of bytes that all sockets together may hold, see
+ * ipconfigUSE_SOCKET_MEMORY_BUDGET.
+ */
+
+#ifndef ipconfigSOCKET_MEMORY_BUDGET
+    #define ipconfigSOCKET_MEMORY_BUDGET    ( 64U * 1024U )
+#endif
+
+#if ( ipconfigSOCKET_MEMORY_BUDGET < 1 )
+    #error ipconfigSOCKET_MEMORY_BUDGET must be at least 1
+#endif
+
+#if ( ipconfigSOCKET_MEMORY_BUDGET > SIZE_MAX )
+    #error ipconfigSOCKET_MEMORY_BUDGET overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_MEMORY_LOW_WATERMARK
+ *
+ * Type: size_t
+ * Unit: percent of ipconfigSOCKET_MEMORY_BUDGET
+ * Minimum: 1
+ * Maximum: ipconfigSOCKET_MEMORY_HIGH_WATERMARK - 1
+ *
+ * Above this use of the budget, UDP packets are dropped early and TCP
+ * windows shrink, see ipconfigUSE_SOCKET_MEMORY_BUDGET.
+ */
+
+#ifndef ipconfigSOCKET_MEMORY_LOW_WATERMARK
+    #define ipconfigSOCKET_MEMORY_LOW_WATERMARK    ( 75U )
+#endif
+
+#if ( ipconfigSOCKET_MEMORY_LOW_WATERMARK < 1 )
+    #error ipconfigSOCKET_MEMORY_LOW_WATERMARK must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_MEMORY_HIGH_WATERMARK
+ *
+ * Type: size_t
+ * Unit: percent of ipconfigSOCKET_MEMORY_BUDGET
+ * Minimum: ipconfigSOCKET_MEMORY_LOW_WATERMARK + 1
+ * Maximum: 100
+ *
+ * Above this use of the budget, all UDP packets are dropped and TCP
+ * sockets advertise at most one MSS, see ipconfigUSE_SOCKET_MEMORY_BUDGET.
+ */
+
+#ifndef ipconfigSOCKET_MEMORY_HIGH_WATERMARK
+    #define ipconfigSOCKET_MEMORY_HIGH_WATERMARK    ( 90U )
+#endif
+
+#if ( ipconfigSOCKET_MEMORY_HIGH_WATERMARK <= ipconfigSOCKET_MEMORY_LOW_WATERMARK )
+    #error ipconfigSOCKET_MEMORY_HIGH_WATERMARK must be at least ipconfigSOCKET_MEMORY_LOW_WATERMARK + 1
+#endif
+
+#if ( ipconfigSOCKET_MEMORY_HIGH_WATERMARK > 100 )
+    #error ipconfigSOCKET_MEMORY_HIGH_WATERMARK must be at most 100
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS
+ *
+ * Type: TickType_t
+ * Unit: Ticks
+ * Minimum: 0
+ * Maximum: portMAX_DELAY
+ *
+ * Sockets have a send block time attribute. If FreeRTOS_sendto() is called but
+ * a network buffer cannot be obtained, then the calling RTOS task is held in
+ * the Blocked state (so other tasks can continue to executed) until either a
+ * network buffer becomes available or the send block time expires. If the send
+ * block time expires then the send operation is aborted.
+ *
+ * The maximum allowable send block time is capped to the value set by
+ * ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS. Capping the maximum allowable send
+ * block time prevents prevents a deadlock occurring when all the network
+ * buffers are in use and the tasks that process (and subsequently free) the
+ * network buffers are themselves blocked waiting for a network buffer.
+ *
+ * ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS is specified in RTOS ticks. A time in
+ * milliseconds can be converted to a time in ticks by dividing the time in
+ * milliseconds by portTICK_PERIOD_MS.
+ */
+
+#ifndef ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS
+    #define ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS    pdMS_TO_TICKS( 20 )
+#endif
+
+STATIC_ASSERT( ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * If enabled then UDP packets that have their checksum value set to 0 will be
+ * accepted, which is in compliance with the UDP specification. Otherwise they
+ * will be dropped, which deviates from the UDP specification, but is safer.
+ */
+
+#ifndef ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS
+    #define ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS != ipconfigDISABLE ) && ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS != ipconfigENABLE ) )
+    #error Invalid ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSUPPORT_RECVMMSG
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for FreeRTOS_recvmmsg(), which takes up to a given number
+ * of datagrams from a UDP socket in a single call. The function blocks at
+ * most once, and removes all packets from the socket's waiting list while
+ * the scheduler is suspended only once. This is useful for sockets that
+ * receive many small datagrams.
+ */
+
+#ifndef ipconfigSUPPORT_RECVMMSG
+    #define ipconfigSUPPORT_RECVMMSG    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_RECVMMSG != ipconfigDISABLE ) && ( ipconfigSUPPORT_RECVMMSG != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_RECVMMSG configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSUPPORT_SENDMMSG
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for FreeRTOS_sendmmsg(), which sends several datagrams,
+ * possibly to different destinations, from a UDP socket. The packets are
+ * chained through 'pxNextBuffer' and passed to the IP-task as a single
+ * eStackTxBatchEvent, so there is one queue operation per call instead of
+ * one per datagram.
+ */
+
+#ifndef ipconfigSUPPORT_SENDMMSG
+    #define ipconfigSUPPORT_SENDMMSG    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_SENDMMSG != ipconfigDISABLE ) && ( ipconfigSUPPORT_SENDMMSG != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_SENDMMSG configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_UDP_GSO
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Allow a UDP socket to set a segment size with FREERTOS_SO_UDP_SEGMENT.
+ * FreeRTOS_sendto() will then split a buffer that is longer than the segment
+ * size into datagrams of that size, all sent to the same destination. The
+ * datagrams are passed to the IP-task as one eStackTxBatchEvent, like those
+ * of FreeRTOS_sendmmsg(), so a single call and a single queue operation
+ * replace one per datagram.
+ */
+
+#ifndef ipconfigUSE_UDP_GSO
+    #define ipconfigUSE_UDP_GSO    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_UDP_GSO != ipconfigDISABLE ) && ( ipconfigUSE_UDP_GSO != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_UDP_GSO configuration
+#endif
+
+#if ( ( ipconfigUSE_UDP_GSO != 0 ) && ( ipconfigSUPPORT_SENDMMSG == 0 ) )
+    #error ipconfigUSE_UDP_GSO requires ipconfigSUPPORT_SENDMMSG
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUDP_GSO_MAX_SEGMENTS
+ *
+ * Type: size_t
+ * Unit: count of datagrams
+ * Minimum: 2
+ *
+ * The maximum number of datagrams in which FreeRTOS_sendto() may split a
+ * single buffer when ipconfigUSE_UDP_GSO is enabled. A longer buffer is
+ * refused, as if it did not fit in one datagram. Every datagram occupies a
+ * network buffer until it has been sent.
+ */
+
+#ifndef ipconfigUDP_GSO_MAX_SEGMENTS
+    #define ipconfigUDP_GSO_MAX_SEGMENTS    64U
+#endif
+
+#if ( ipconfigUDP_GSO_MAX_SEGMENTS < 2 )
+    #error ipconfigUDP_GSO_MAX_SEGMENTS must be at least 2
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_UDP_REUSEPORT
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Allow several UDP sockets to be bound to the same port, when all of them
+ * have set the socket option FREERTOS_SO_REUSEPORT before binding. Incoming
+ * datagrams are distributed over those sockets on a hash of the source
+ * address and port, so all datagrams of one flow go to the same socket.
+ * This allows several tasks to service one busy port.
+ */
+
+#ifndef ipconfigUSE_UDP_REUSEPORT
+    #define ipconfigUSE_UDP_REUSEPORT    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_UDP_REUSEPORT != ipconfigDISABLE ) && ( ipconfigUSE_UDP_REUSEPORT != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_UDP_REUSEPORT configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_TCP_REUSEPORT
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Allow several TCP sockets to listen to the same port, when all of them
+ * have set the socket option FREERTOS_SO_REUSEPORT before binding. A new
+ * connection is given to one of those sockets on a hash of the address and
+ * port of the peer. Every listening socket has its own children, so each
+ * worker task can call FreeRTOS_accept() on its own socket.
+ */
+#ifndef ipconfigUSE_TCP_REUSEPORT
+    #define ipconfigUSE_TCP_REUSEPORT    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_REUSEPORT != ipconfigDISABLE ) && ( ipconfigUSE_TCP_REUSEPORT != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_REUSEPORT configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_REUSEPORT ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigUSE_TCP_REUSEPORT requires ipconfigUSE_TCP
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_UDP_CONNECT
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Allow FreeRTOS_connect() on a UDP socket. A connected UDP socket may pass
+ * NULL as the destination to FreeRTOS_sendto(). Once the IP-task has sent a
+ * packet to the peer, the socket keeps a copy of the Ethernet, IP and UDP
+ * headers together with the end-point. Later sends to the same peer use
+ * that copy, so the end-point and the ARP or ND cache are not looked up
+ * again. The copy is dropped as soon as the ARP or ND cache changes, or
+ * when an end-point goes up or down.
+ */
+
+#ifndef ipconfigUSE_UDP_CONNECT
+    #define ipconfigUSE_UDP_CONNECT    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_UDP_CONNECT != ipconfigDISABLE ) && ( ipconfigUSE_UDP_CONNECT != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_UDP_CONNECT configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_UDP_DIRECT_TX
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Allow a connected UDP socket that has set FREERTOS_SO_UDP_DIRECT_TX to
+ * pass its packets to the driver from the calling task, as long as the
+ * headers kept by the socket are valid ( see ipconfigUSE_UDP_CONNECT ). The
+ * packet is not queued to the IP-task, which saves a queue operation and a
+ * context switch per datagram.
+ *
+ * Every call to pfOutput() is then protected by a mutex of the interface,
+ * also when it is made by the IP-task. A driver does not have to be
+ * thread-safe.
+ */
+
+#ifndef ipconfigUSE_UDP_DIRECT_TX
+    #define ipconfigUSE_UDP_DIRECT_TX    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_UDP_DIRECT_TX != ipconfigDISABLE ) && ( ipconfigUSE_UDP_DIRECT_TX != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_UDP_DIRECT_TX configuration
+#endif
+
+#if ( ( ipconfigUSE_UDP_DIRECT_TX != 0 ) && ( ipconfigUSE_UDP_CONNECT == 0 ) )
+    #error ipconfigUSE_UDP_DIRECT_TX requires ipconfigUSE_UDP_CONNECT
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSUPPORT_IP_MULTICAST
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Allow UDP sockets to join multicast groups with the socket options
+ * FREERTOS_SO_IP_ADD_MEMBERSHIP and FREERTOS_SO_IP_DROP_MEMBERSHIP. The stack
+ * keeps a reference count per group, programs the multicast MAC address of
+ * the group into the driver with pfAddAllowedMAC() and pfRemoveAllowedMAC(),
+ * and announces the membership to routers with IGMPv2 ( IPv4 ) or MLDv1
+ * ( IPv6 ) reports. A driver that implements the MAC filter functions does
+ * not have to receive all multicast traffic any more.
+ */
+
+#ifndef ipconfigSUPPORT_IP_MULTICAST
+    #define ipconfigSUPPORT_IP_MULTICAST    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_IP_MULTICAST != ipconfigDISABLE ) && ( ipconfigSUPPORT_IP_MULTICAST != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_IP_MULTICAST configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigMULTICAST_GROUP_COUNT
+ *
+ * Type: size_t
+ * Unit: groups
+ * Minimum: 1
+ * Maximum: 32
+ *
+ * The number of different multicast groups that can be joined at the same
+ * time, counted over all interfaces. Only used when
+ * ipconfigSUPPORT_IP_MULTICAST is enabled.
+ */
+
+#ifndef ipconfigMULTICAST_GROUP_COUNT
+    #define ipconfigMULTICAST_GROUP_COUNT    8
+#endif
+
+#if ( ipconfigMULTICAST_GROUP_COUNT < 1 )
+    #error ipconfigMULTICAST_GROUP_COUNT must be at least 1
+#endif
+
+#if ( ipconfigMULTICAST_GROUP_COUNT > 32 )
+    #error ipconfigMULTICAST_GROUP_COUNT must be at most 32
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUDP_TIME_TO_LIVE
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUDP_TIME_TO_LIVE
+ *
+ * Type: uint8_t
+ * Units: 'hops'
+ * Minimum: 0
+ *
+ * Defines the Time To Live (TTL) values used in outgoing UDP packets.
+ */
+
+#ifndef ipconfigUDP_TIME_TO_LIVE
+    #define ipconfigUDP_TIME_TO_LIVE    ( 128 )
+#endif
+
+#if ( ipconfigUDP_TIME_TO_LIVE < 0 )
+    #error ipconfigUDP_TIME_TO_LIVE must be at least 0
+#endif
+
+#if ( ipconfigUDP_TIME_TO_LIVE > UINT8_MAX )
+    #error ipconfigUDP_TIME_TO_LIVE overflows a uint8_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*===========================================================================*/
+/*                                UDP CONFIG                                 */
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*                              SOCKET CONFIG                                */
+/*===========================================================================*/
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * The address of a socket is the combination of its IP address and its port
+ * number. FreeRTOS_bind() is used to manually allocate a port number to a
+ * socket (to 'bind' the socket to a port), but manual binding is not normally
+ * necessary for client sockets (those sockets that initiate outgoing
+ * connections rather than wait for incoming connections on a known port
+ * number). If ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND is set to 1 then calling
+ * FreeRTOS_sendto() on a socket that has not yet been bound will result in the
+ * IP stack automatically binding the socket to a port number from the range
+ * socketAUTO_PORT_ALLOCATION_START_NUMBER to 0xffff. If
+ * ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND is set to 0 then calling
+ * FreeRTOS_sendto() on a socket that has not yet been bound will result
+ * in the send operation being aborted.
+ */
+
+#ifndef ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND
+    #define ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND    ipconfigENABLE
+#endif
+
+#if ( ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND != ipconfigDISABLE ) && ( ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND != ipconfigENABLE ) )
+    #error Invalid ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_SOCKET_HASH_LOOKUP
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, every bound socket is also stored in a small hash table, so
+ * that a received packet can be matched with its socket without walking the
+ * complete list of bound sockets. UDP sockets are hashed on their local port
+ * number. TCP sockets are hashed on the local port, the remote port and the
+ * remote IP address; a listening socket is hashed on its local port only and
+ * is used when no connected socket matches.
+ *
+ * This is useful when many sockets are open at the same time, e.g. a server
+ * with a large number of TCP child sockets. The cost is one extra ListItem_t
+ * in every socket and the tables described by
+ * ipconfigSOCKET_HASH_BUCKET_COUNT.
+ */
+
+#ifndef ipconfigUSE_SOCKET_HASH_LOOKUP
+    #define ipconfigUSE_SOCKET_HASH_LOOKUP    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_SOCKET_HASH_LOOKUP != ipconfigDISABLE ) && ( ipconfigUSE_SOCKET_HASH_LOOKUP != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_SOCKET_HASH_LOOKUP configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_HASH_BUCKET_COUNT
+ *
+ * Type: size_t
+ * Unit: count of List_t
+ * Minimum: 1
+ *
+ * The number of buckets in each of the socket hash tables, one table for UDP
+ * and one for TCP. Only used when ipconfigUSE_SOCKET_HASH_LOOKUP is enabled.
+ * The value must be a power of two. A good choice is about the number of
+ * sockets that are expected to be bound at the same time.
+ */
+
+#ifndef ipconfigSOCKET_HASH_BUCKET_COUNT
+    #define ipconfigSOCKET_HASH_BUCKET_COUNT    16U
+#endif
+
+#if ( ipconfigSOCKET_HASH_BUCKET_COUNT < 1 )
+    #error ipconfigSOCKET_HASH_BUCKET_COUNT must be at least 1
+#endif
+
+#if ( ( ipconfigSOCKET_HASH_BUCKET_COUNT & ( ipconfigSOCKET_HASH_BUCKET_COUNT - 1 ) ) != 0 )
+    #error ipconfigSOCKET_HASH_BUCKET_COUNT must be a power of two
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSUPPORT_SELECT_FUNCTION
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSUPPORT_SELECT_FUNCTION
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for FreeRTOS_select() and associated API functions.
+ */
+
+#ifndef ipconfigSUPPORT_SELECT_FUNCTION
+    #define ipconfigSUPPORT_SELECT_FUNCTION    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_SELECT_FUNCTION != ipconfigDISABLE ) && ( ipconfigSUPPORT_SELECT_FUNCTION != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_SELECT_FUNCTION configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSELECT_USES_NOTIFY
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSELECT_USES_NOTIFY
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * This option is only used in case the socket-select functions are
+ * activated (when ipconfigSUPPORT_SELECT_FUNCTION is non-zero). When
+ * calling select() for a given socket from the same task, this macro is
+ * not required. Only when there are multiple tasks using select on the
+ * same sockets, this option may prevent a dead-lock. The problem is that
+ * the event bit eSELECT_CALL_IP is waited for and cleared by multiple
+ * tasks.
+ */
+
+#ifndef ipconfigSELECT_USES_NOTIFY
+    #define ipconfigSELECT_USES_NOTIFY    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSELECT_USES_NOTIFY != ipconfigDISABLE ) && ( ipconfigSELECT_USES_NOTIFY != ipconfigENABLE ) )
+    #error Invalid ipconfigSELECT_USES_NOTIFY configuration
+#endif
+
+#if ipconfigIS_ENABLED( ipconfigSELECT_USES_NOTIFY )
+    #if ( configUSE_TASK_NOTIFICATIONS == 0 )
+        #error configUSE_TASK_NOTIFICATIONS must be 1 if ipconfigSELECT_USES_NOTIFY is enabled
+    #endif
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_USES_NOTIFY
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * By default every socket has an event group, on which the API functions
+ * block until the IP-task reports that data arrived, that there is space to
+ * send, or that a connection was accepted, connected or closed. When this
+ * option is enabled, sockets have no event group. The events are kept as
+ * bits in the socket, and the task that is blocked on the socket is woken
+ * up with a direct task notification. This saves the RAM of an event group
+ * per socket, and the IP-task no longer has to walk the tasks that wait
+ * for an event group.
+ *
+ * Only one task at a time may block on a socket, so a socket that is read
+ * by one task while another task writes to it needs the event groups. The
+ * notification at index ipconfigSOCKET_NOTIFY_INDEX of a task that blocks
+ * on a socket is used by the stack.
+ */
+
+#ifndef ipconfigSOCKET_USES_NOTIFY
+    #define ipconfigSOCKET_USES_NOTIFY    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSOCKET_USES_NOTIFY != ipconfigDISABLE ) && ( ipconfigSOCKET_USES_NOTIFY != ipconfigENABLE ) )
+    #error Invalid ipconfigSOCKET_USES_NOTIFY configuration
+#endif
+
+#if ipconfigIS_ENABLED( ipconfigSOCKET_USES_NOTIFY )
+    #if ( configUSE_TASK_NOTIFICATIONS == 0 )
+        #error configUSE_TASK_NOTIFICATIONS must be 1 if ipconfigSOCKET_USES_NOTIFY is enabled
+    #endif
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_NOTIFY_INDEX
+ *
+ * Type: UBaseType_t
+ * Unit: index in the task notification array
+ * Minimum: 0
+ * Maximum: configTASK_NOTIFICATION_ARRAY_ENTRIES - 1
+ *
+ * The task notification index that is used to wake up a task that blocks
+ * on a socket when ipconfigSOCKET_USES_NOTIFY is enabled.  Index 0 is also
+ * used by stream buffers, message buffers and many applications, so by
+ * default the sockets use index 1, which requires that
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES is at least 2.  The stack does not
+ * clear the other notification indexes of a task.
+ */
+
+#ifndef ipconfigSOCKET_NOTIFY_INDEX
+    #define ipconfigSOCKET_NOTIFY_INDEX    1U
+#endif
+
+#if ipconfigIS_ENABLED( ipconfigSOCKET_USES_NOTIFY )
+    #if ( ipconfigSOCKET_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+        #error ipconfigSOCKET_NOTIFY_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+    #endif
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSUPPORT_SELECT_READY_LIST
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, every socket set keeps a list of the sockets that had an
+ * event since the set was last polled. A socket is appended to that list by
+ * the IP-task at the moment an event occurs, so FreeRTOS_select_ready() can
+ * return the ready sockets directly, without scanning all bound sockets and
+ * without calling FreeRTOS_FD_ISSET() for every member of the set.
+ *
+ * The reporting is edge-triggered: a socket is reported once per event, and
+ * its event bits are cleared when it is returned. Requires
+ * ipconfigSUPPORT_SELECT_FUNCTION.
+ */
+
+#ifndef ipconfigSUPPORT_SELECT_READY_LIST
+    #define ipconfigSUPPORT_SELECT_READY_LIST    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_SELECT_READY_LIST != ipconfigDISABLE ) && ( ipconfigSUPPORT_SELECT_READY_LIST != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_SELECT_READY_LIST configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_SELECT_READY_LIST ) && ipconfigIS_DISABLED( ipconfigSUPPORT_SELECT_FUNCTION ) )
+    #error ipconfigSUPPORT_SELECT_READY_LIST requires ipconfigSUPPORT_SELECT_FUNCTION
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSUPPORT_ASYNC_SOCKETS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, a task can drive many sockets through an asynchronous ring
+ * created with FreeRTOS_CreateAsyncRing(). FreeRTOS_AsyncSubmit() posts
+ * connect, accept, send, receive and close requests, which the IP-task
+ * handles in batches: at once when possible, otherwise as soon as the
+ * socket has an event. The results are collected with
+ * FreeRTOS_AsyncComplete(), which is the only call that blocks. One task
+ * switch serves a whole batch of requests, instead of one or two for every
+ * call of the blocking API.
+ */
+
+#ifndef ipconfigSUPPORT_ASYNC_SOCKETS
+    #define ipconfigSUPPORT_ASYNC_SOCKETS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_ASYNC_SOCKETS != ipconfigDISABLE ) && ( ipconfigSUPPORT_ASYNC_SOCKETS != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_ASYNC_SOCKETS configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigASYNC_RING_LENGTH
+ *
+ * Type: size_t
+ * Unit: count of requests
+ * Minimum: 1
+ *
+ * The number of requests that an asynchronous ring can hold, from the
+ * moment they are submitted until their results have been collected, see
+ * ipconfigSUPPORT_ASYNC_SOCKETS. The IP-task looks at all waiting requests
+ * of a ring when one of its sockets has an event.
+ */
+
+#ifndef ipconfigASYNC_RING_LENGTH
+    #define ipconfigASYNC_RING_LENGTH    16U
+#endif
+
+#if ( ipconfigASYNC_RING_LENGTH < 1 )
+    #error ipconfigASYNC_RING_LENGTH must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSELECT_LOCAL_EVALUATION
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * By default, FreeRTOS_select() and FreeRTOS_FD_SET() send an event to the
+ * IP-task and wait until it has checked the sockets of the set, which costs
+ * two task switches per call. When this option is enabled, the calling task
+ * checks the sockets itself while the scheduler is suspended. In exchange,
+ * the IP-task suspends the scheduler while it binds or unbinds a socket.
+ * ipconfigSELECT_USES_NOTIFY has no effect when this option is enabled.
+ */
+
+#ifndef ipconfigSELECT_LOCAL_EVALUATION
+    #define ipconfigSELECT_LOCAL_EVALUATION    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSELECT_LOCAL_EVALUATION != ipconfigDISABLE ) && ( ipconfigSELECT_LOCAL_EVALUATION != ipconfigENABLE ) )
+    #error Invalid ipconfigSELECT_LOCAL_EVALUATION configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigSELECT_LOCAL_EVALUATION ) && ipconfigIS_DISABLED( ipconfigSUPPORT_SELECT_FUNCTION ) )
+    #error ipconfigSELECT_LOCAL_EVALUATION requires ipconfigSUPPORT_SELECT_FUNCTION
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUDP_DIRECT_BIND
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * By default, FreeRTOS_bind() sends an eSocketBindEvent to the IP-task and
+ * waits until the IP-task has bound the socket. When this option is enabled,
+ * UDP sockets are bound in the calling task, while the scheduler is
+ * suspended, which saves two task switches for every short-lived UDP socket.
+ * In exchange, the IP-task suspends the scheduler while it binds or unbinds
+ * a socket. TCP sockets are always bound by the IP-task.
+ */
+
+#ifndef ipconfigUDP_DIRECT_BIND
+    #define ipconfigUDP_DIRECT_BIND    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUDP_DIRECT_BIND != ipconfigDISABLE ) && ( ipconfigUDP_DIRECT_BIND != ipconfigENABLE ) )
+    #error Invalid ipconfigUDP_DIRECT_BIND configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+ *
+ * Type: TickType_t
+ * Unit: Ticks
+ * Minimum: 0
+ * Maximum: portMAX_DELAY
+ *
+ * API functions used to read data from a socket can block to wait for data to
  * become available. ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME sets the default
  * block time defined in RTOS ticks. If ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
  * is not defined then the default block time will be set to portMAX_DELAY -
@@ -1928,1386 +5336,3484 @@ STATIC_ASSERT( ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
  * Blocked state until data is available. Note that tasks in the Blocked state
  * do not consume any CPU time.
  *
- * ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME is specified in ticks. The macros
- * pdMS_TO_TICKS() and portTICK_PERIOD_MS can both be used to convert a time
- * specified in milliseconds to a time specified in ticks, e.g. 2000 ms:
+ * ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME is specified in ticks. The macros
+ * pdMS_TO_TICKS() and portTICK_PERIOD_MS can both be used to convert a time
+ * specified in milliseconds to a time specified in ticks, e.g. 2000 ms:
+ *
+ * #define ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME    pdMS_TO_TICKS( 2000U )
+ *
+ * The timeout time can be changed at any time using the FREERTOS_SO_RCVTIMEO
+ * parameter with FreeRTOS_setsockopt(). Note: Infinite block times should be
+ * used with extreme care in order to avoid a situation where all tasks are
+ * blocked indefinitely to wait for another RTOS task (which is also blocked
+ * indefinitely) to free a network buffer.
+ *
+ * A socket can be set to non-blocking mode by setting both the send and
+ * receive block time to 0. This might be desirable when an RTOS task is using
+ * more than one socket - in which case blocking can instead by performed on
+ * all the sockets at once using FreeRTOS_select(), or the RTOS task can
+ * set ipconfigSOCKET_HAS_USER_SEMAPHORE to one, then block on its own
+ * semaphore.
+ */
+
+#ifndef ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+    #define ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME    portMAX_DELAY
+#endif
+
+STATIC_ASSERT( ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME <= portMAX_DELAY );
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME
+ *
+ * Type: TickType_t
+ * Unit: Ticks
+ * Minimum: 0
+ * Maximum: portMAX_DELAY
+ *
+ * When writing to a socket, the write may not be able to proceed immediately.
+ * For example, depending on the configuration, a write might have to wait for
+ * a network buffer to become available.
+ * It determines the number of clock ticks that FreeRTOS_send() must wait
+ * for space in the transmission buffer. For FreeRTOS_sendto(), it limits
+ * how long the application should wait for a network buffer to become available.
+ *
+ * See ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+ */
+
+#ifndef ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME
+    #define ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME    portMAX_DELAY
+#endif
+
+STATIC_ASSERT( ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME <= portMAX_DELAY );
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_HAS_USER_SEMAPHORE
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSOCKET_HAS_USER_SEMAPHORE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Allows a semaphore to be provided that will be given after important events
+ * to wake up the user.
+ *
+ * Set by calling FreeRTOS_setsockopt() with the FREERTOS_SO_SET_SEMAPHORE
+ * option and a pointer to a semaphore. Once set, the semaphore will be signalled
+ * after every important socket event: READ, WRITE, EXCEPTION.
+ * Note that a READ event is also generated for a TCP socket in listen mode,
+ * and a WRITE event is generated when a call to connect() has succeeded.
+ * Beside that, READ and WRITE are the normal events that occur when
+ * data has been received or delivered.
+ *
+ * Can be used with non-blocking sockets as an alternative to
+ * FreeRTOS_select in order to handle multiple sockets at once.
+ */
+
+#ifndef ipconfigSOCKET_HAS_USER_SEMAPHORE
+    #define ipconfigSOCKET_HAS_USER_SEMAPHORE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSOCKET_HAS_USER_SEMAPHORE != ipconfigDISABLE ) && ( ipconfigSOCKET_HAS_USER_SEMAPHORE != ipconfigENABLE ) )
+    #error Invalid ipconfigSOCKET_HAS_USER_SEMAPHORE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_HAS_USER_WAKE_CALLBACK
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSOCKET_HAS_USER_WAKE_CALLBACK
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables usage of an application defined hook that will be called after
+ * one of the following events:
+ *
+ * eSOCKET_RECEIVE = 0x0001, * Reception of new data. *
+ * eSOCKET_SEND    = 0x0002, * Some data has been sent. *
+ * eSOCKET_ACCEPT  = 0x0004, * A new TCP client was detected, please call accept(). *
+ * eSOCKET_CONNECT = 0x0008, * A TCP connect has succeeded or timed-out. *
+ * eSOCKET_BOUND   = 0x0010, * A socket got bound. *
+ * eSOCKET_CLOSED  = 0x0020, * A TCP connection got closed. *
+ * eSOCKET_INTR    = 0x0040, * A blocking API call got interrupted, because
+ *                           * the function FreeRTOS_SignalSocket() was called. *
+ *
+ * It is not a good idea to do a lot of processing in any of the application
+ * hooks. Normally the hook will only notify the task that owns the socket so
+ * that the socket gets immediate attention.
+ *
+ * Function prototype:
+ *
+ * typedef void (* SocketWakeupCallback_t)( Socket_t pxSocket )
+ */
+
+#ifndef ipconfigSOCKET_HAS_USER_WAKE_CALLBACK
+    #define ipconfigSOCKET_HAS_USER_WAKE_CALLBACK    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK != ipconfigDISABLE ) && ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK != ipconfigENABLE ) )
+    #error Invalid ipconfigSOCKET_HAS_USER_WAKE_CALLBACK configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSUPPORT_SIGNALS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSUPPORT_SIGNALS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Advanced users only.
+ *
+ * Include support for FreeRTOS_SignalSocket().
+ *
+ * Used to interrupt a socket during a blocked read allowing the task proceed.
+ * A signal interruption can be distinguished from a read through the return
+ * value -pdFREERTOS_ERRNO_EINTR.
+ */
+
+#ifndef ipconfigSUPPORT_SIGNALS
+    #define ipconfigSUPPORT_SIGNALS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_SIGNALS != ipconfigDISABLE ) && ( ipconfigSUPPORT_SIGNALS != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_SIGNALS configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_CALLBACKS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_CALLBACKS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Advanced users only.
+ *
+ * Allows usage of application defined hooks for socket events.
+ *
+ * Can be set by calling FreeRTOS_setsockopt() with any of the following
+ * options and a pointer to a F_TCP_UDP_Handler_t.
+ *
+ * FREERTOS_SO_TCP_CONN_HANDLER  * Callback for (dis)connection events. *
+ * FREERTOS_SO_TCP_RECV_HANDLER  * Callback for receiving TCP data. *
+ * FREERTOS_SO_TCP_SENT_HANDLER  * Callback for sending TCP data. *
+ * FREERTOS_SO_UDP_RECV_HANDLER  * Callback for receiving UDP data. *
+ * FREERTOS_SO_UDP_SENT_HANDLER  * Callback for sending UDP data. *
+ *
+ * typedef struct xTCP_UDP_HANDLER
+ * {
+ *      FOnConnected_t pxOnTCPConnected; * FREERTOS_SO_TCP_CONN_HANDLER *
+ *      FOnTCPReceive_t pxOnTCPReceive;  * FREERTOS_SO_TCP_RECV_HANDLER *
+ *      FOnTCPSent_t pxOnTCPSent;        * FREERTOS_SO_TCP_SENT_HANDLER *
+ *      FOnUDPReceive_t pxOnUDPReceive;  * FREERTOS_SO_UDP_RECV_HANDLER *
+ *      FOnUDPSent_t pxOnUDPSent;        * FREERTOS_SO_UDP_SENT_HANDLER *
+ * } F_TCP_UDP_Handler_t
+ *
+ * Function Prototypes:
+ *
+ * typedef void (* FOnConnected_t )( Socket_t xSocket,
+ *                                   BaseType_t ulConnected )
+ *
+ * typedef BaseType_t (* FOnTCPReceive_t )( Socket_t xSocket,
+ *                                          void * pData,
+ *                                          size_t xLength )
+ *
+ * typedef void (* FOnTCPSent_t )( Socket_t xSocket,
+ *                                 size_t xLength )
+ *
+ * typedef BaseType_t (* FOnUDPReceive_t ) ( Socket_t xSocket,
+ *                                           void * pData,
+ *                                           size_t xLength,
+ *                                           const struct freertos_sockaddr * pxFrom,
+ *                                           const struct freertos_sockaddr * pxDest )
+ *
+ * typedef void (* FOnUDPSent_t )( Socket_t xSocket,
+ *                                      size_t xLength );
+ */
+
+#ifndef ipconfigUSE_CALLBACKS
+    #define ipconfigUSE_CALLBACKS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_CALLBACKS != ipconfigDISABLE ) && ( ipconfigUSE_CALLBACKS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_CALLBACKS configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_CALLBACK_BUFFER_TRANSFER
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, a UDP or TCP reception handler may call
+ * FreeRTOS_TakeRxBuffer() to become the owner of the network buffer that
+ * holds the data passed to it.  The stack will neither queue nor release
+ * that buffer, the application releases it later by calling
+ * vReleaseNetworkBufferAndDescriptor().
+ *
+ * A UDP handler can always take the buffer.  A TCP handler can take it when
+ * the connection is established and the data was not stored in the RX
+ * stream; the headers are then copied to a new buffer, which is used to
+ * send the acknowledgement.
+ *
+ * Requires ipconfigUSE_CALLBACKS.
+ */
+
+#ifndef ipconfigUSE_CALLBACK_BUFFER_TRANSFER
+    #define ipconfigUSE_CALLBACK_BUFFER_TRANSFER    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != ipconfigDISABLE ) && ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_CALLBACK_BUFFER_TRANSFER configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_CALLBACK_BUFFER_TRANSFER ) && ipconfigIS_DISABLED( ipconfigUSE_CALLBACKS ) )
+    #error ipconfigUSE_CALLBACK_BUFFER_TRANSFER requires ipconfigUSE_CALLBACKS
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigIS_VALID_PROG_ADDRESS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigIS_VALID_PROG_ADDRESS
+ *
+ * Type: Macro Function
+ * Value: BaseType_t ( pdTRUE | pdFALSE )
+ *
+ * Verifies that a given address refers to valid (instruction) memory.
+ *
+ * Used to check if application defined hooks are valid.
+ *
+ * Example:
+ * if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xTCP.pxHandleSent ) )
+ * {
+ *     pxSocket->u.xTCP.pxHandleSent( pxSocket, ulCount );
+ * }
+ */
+
+#ifndef ipconfigIS_VALID_PROG_ADDRESS
+    #define ipconfigIS_VALID_PROG_ADDRESS( pxAddress )    ( ( pxAddress ) != NULL )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_POOL_UDP_COUNT
+ *
+ * Type: UBaseType_t
+ * Unit: count of sockets
+ * Minimum: 0
+ *
+ * When non-zero, the UDP sockets are not allocated from the heap, but taken
+ * from a static pool of this number of socket objects, each just big enough
+ * for a UDP socket. A closed socket is put back in the pool. Taking and
+ * putting back a socket takes a constant time, so creating many short-lived
+ * sockets ( DNS, NTP ) causes no heap traffic. FreeRTOS_socket() fails when
+ * the pool is empty, which puts a hard bound on the memory of the sockets.
+ *
+ * pvPortMallocSocket() and vPortFreeSocket() are mapped to pvSocketPoolGet()
+ * and vSocketPoolPut(), they can not be defined by the application as well.
+ *
+ * A zero value allocates UDP sockets with pvPortMalloc().
+ */
+#ifndef ipconfigSOCKET_POOL_UDP_COUNT
+    #define ipconfigSOCKET_POOL_UDP_COUNT    0
+#endif
+
+#if ( ipconfigSOCKET_POOL_UDP_COUNT < 0 )
+    #error ipconfigSOCKET_POOL_UDP_COUNT must be at least 0
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSOCKET_POOL_TCP_COUNT
+ *
+ * Type: UBaseType_t
+ * Unit: count of sockets
+ * Minimum: 0
+ *
+ * The same as ipconfigSOCKET_POOL_UDP_COUNT, for a pool of TCP socket
+ * objects. Note that the stream buffers and the window segments of a TCP
+ * socket are still allocated separately, see ipconfigTCP_BUFFER_ARENA_SIZE.
+ *
+ * A zero value allocates TCP sockets with pvPortMalloc().
+ */
+#ifndef ipconfigSOCKET_POOL_TCP_COUNT
+    #define ipconfigSOCKET_POOL_TCP_COUNT    0
+#endif
+
+#if ( ipconfigSOCKET_POOL_TCP_COUNT < 0 )
+    #error ipconfigSOCKET_POOL_TCP_COUNT must be at least 0
+#endif
+
+#if ( ( ipconfigSOCKET_POOL_TCP_COUNT != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_TCP ) )
+    #error ipconfigSOCKET_POOL_TCP_COUNT requires ipconfigUSE_TCP
+#endif
+
+#if ( ( ( ipconfigSOCKET_POOL_UDP_COUNT != 0 ) || ( ipconfigSOCKET_POOL_TCP_COUNT != 0 ) ) && ( defined( pvPortMallocSocket ) || defined( vPortFreeSocket ) ) )
+    #error pvPortMallocSocket and vPortFreeSocket can not be combined with a socket pool
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSUPPORT_STATIC_SOCKETS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include FreeRTOS_socket_static(), which creates a socket in memory that is
+ * provided by the application, in the same way as xTaskCreateStatic().  For a
+ * TCP socket, the application may also provide the storage of the reception
+ * and the transmission stream, so that connecting, sending and receiving do
+ * not allocate memory.  The streams of a child socket that is created by a
+ * listening socket are still allocated from the heap.
+ *
+ * Requires configSUPPORT_STATIC_ALLOCATION, the event group of the socket is
+ * created with xEventGroupCreateStatic().
+ */
+#ifndef ipconfigSUPPORT_STATIC_SOCKETS
+    #define ipconfigSUPPORT_STATIC_SOCKETS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_STATIC_SOCKETS != ipconfigDISABLE ) && ( ipconfigSUPPORT_STATIC_SOCKETS != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_STATIC_SOCKETS configuration
+#endif
+
+#if ( ( ipconfigSUPPORT_STATIC_SOCKETS != 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    #error ipconfigSUPPORT_STATIC_SOCKETS requires configSUPPORT_STATIC_ALLOCATION
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * pvPortMallocSocket/vPortFreeSocket
+ *
+ * Malloc functions specific to sockets.
+ */
+
+#if ( ( ipconfigSOCKET_POOL_UDP_COUNT != 0 ) || ( ipconfigSOCKET_POOL_TCP_COUNT != 0 ) )
+    #define pvPortMallocSocket( size )    pvSocketPoolGet( size )
+    #define vPortFreeSocket( ptr )        vSocketPoolPut( ptr )
+#endif
+
+#ifndef pvPortMallocSocket
+    #define pvPortMallocSocket( size )    pvPortMalloc( size )
+#endif
+
+#ifndef vPortFreeSocket
+    #define vPortFreeSocket( ptr )    vPortFree( ptr )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*===========================================================================*/
+/*                              SOCKET CONFIG                                */
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*                               DHCP CONFIG                                 */
+/*===========================================================================*/
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DHCP
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_DHCP
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Allows DHCP to be enabled by setting by setting `endpoint->bits.bWantDHCP`.
+ *
+ * When successful, DHCP will assign an IP-address, a netmask, a gateway
+ * address, and one or more DNS addresses to the endpoint. DHCP must be able to
+ * receive an options field of 312 bytes, the fixed part of the DHCP packet is
+ * 240 bytes, and the IP/UDP headers take 28 bytes.
+ */
+
+#ifndef ipconfigUSE_DHCP
+    #define ipconfigUSE_DHCP    ipconfigENABLE
+#endif
+
+#if ( ( ipconfigUSE_DHCP != ipconfigDISABLE ) && ( ipconfigUSE_DHCP != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DHCP configuration
+#endif
+
+#if ( ( ipconfigUSE_DHCP != ipconfigDISABLE ) && ( ipconfigNETWORK_MTU < 586 ) )
+    #error ipconfigNETWORK_MTU needs to be at least 586 to use DHCP
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP ) && ipconfigIS_DISABLED( ipconfigUSE_IPv4 ) )
+    #error DHCP Cannot be enabled without IPv4
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DHCPv6
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for DHCPv6.
+ *
+ * The use of DHCP can be enabled per endpoint by setting
+ * `endpoint->bits.bWantDHCP`.
+ *
+ * An alternative way of obtaining an IP-address is Router Advertisement ("RA").
+ * As RA is generally preferred above DHCP, ipconfigUSE_RA is enabled and
+ * ipconfigUSE_DHCPv6 is disabled by default.
+ */
+
+#ifndef ipconfigUSE_DHCPv6
+    #define ipconfigUSE_DHCPv6    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DHCPv6 != ipconfigDISABLE ) && ( ipconfigUSE_DHCPv6 != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DHCPv6 configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DHCPv6 ) && ipconfigIS_DISABLED( ipconfigUSE_IPv6 ) )
+    #error DHCPv6 Cannot be enabled without IPv6
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDHCP_REGISTER_HOSTNAME
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDHCP_REGISTER_HOSTNAME
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables usage of an application defined hook to provide a hostname to a DHCP
+ * server.
+ *
+ * Function prototype:
+ *
+ * const char *pcApplicationHostnameHook( void )
+ */
+
+#ifndef ipconfigDHCP_REGISTER_HOSTNAME
+    #define ipconfigDHCP_REGISTER_HOSTNAME    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigDHCP_REGISTER_HOSTNAME != ipconfigDISABLE ) && ( ipconfigDHCP_REGISTER_HOSTNAME != ipconfigENABLE ) )
+    #error Invalid ipconfigDHCP_REGISTER_HOSTNAME configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DHCP_HOOK
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_DHCP_HOOK
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables usage of an application defined hook during the DHCP process before
+ * the initial discovery packet is sent, and after a DHCP offer has been
+ * received.
+ *
+ * Function Prototype:
+ *
+ * Function prototype if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled:
+ *
+ * eDHCPCallbackAnswer_t xApplicationDHCPHook( eDHCPCallbackPhase_t eDHCPPhase,
+ *                                             uint32_t ulIPAddress )
+ *
+ * Function prototype by default:
+ *
+ * eDHCPCallbackAnswer_t xApplicationDHCPHook_Multi( eDHCPCallbackPhase_t eDHCPPhase,
+ *                                                   struct xNetworkEndPoint * pxEndPoint,
+ *                                                   IP_Address_t * pxIPAddress );
+ */
+
+#ifndef ipconfigUSE_DHCP_HOOK
+    #define ipconfigUSE_DHCP_HOOK    ipconfigENABLE
+#endif
+
+#if ( ( ipconfigUSE_DHCP_HOOK != ipconfigDISABLE ) && ( ipconfigUSE_DHCP_HOOK != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DHCP_HOOK configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDHCP_FALL_BACK_AUTO_IP
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * If no DHCP server responds, allocate a random LinkLayer IP address.
+ *
+ * Requires ipconfigARP_USE_CLASH_DETECTION to be enabled as well in order to
+ * test if it is still available.
+ *
+ * An alternative is to resort to a static IP address.
+ */
+
+#ifndef ipconfigDHCP_FALL_BACK_AUTO_IP
+    #define ipconfigDHCP_FALL_BACK_AUTO_IP    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigDHCP_FALL_BACK_AUTO_IP != ipconfigDISABLE ) && ( ipconfigDHCP_FALL_BACK_AUTO_IP != ipconfigENABLE ) )
+    #error Invalid ipconfigDHCP_FALL_BACK_AUTO_IP configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DHCP_INIT_REBOOT
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Start DHCP in the INIT-REBOOT state ( RFC 2131, section 3.2 ) when a lease
+ * from a previous run is available.  The application must then provide:
+ *
+ * BaseType_t xApplicationDHCPLeaseLoad( const struct xNetworkEndPoint * pxEndPoint,
+ *                                       DHCPLease_t * pxLease );
+ * void vApplicationDHCPLeaseStore( const struct xNetworkEndPoint * pxEndPoint,
+ *                                  const DHCPLease_t * pxLease );
+ *
+ * When xApplicationDHCPLeaseLoad() returns pdTRUE, the stored address is
+ * requested directly, skipping DISCOVER and OFFER.  The lease is stored after
+ * every ACK, and stored as all-zero after a NAK.  A NAK, or a request that is
+ * not answered in time, makes the client fall back to a normal DISCOVER.
+ */
+
+#ifndef ipconfigUSE_DHCP_INIT_REBOOT
+    #define ipconfigUSE_DHCP_INIT_REBOOT    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DHCP_INIT_REBOOT != ipconfigDISABLE ) && ( ipconfigUSE_DHCP_INIT_REBOOT != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DHCP_INIT_REBOOT configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DHCP_RAPID_COMMIT
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include the Rapid Commit option in DHCPv4 DISCOVER messages ( RFC 4039 )
+ * and in DHCPv6 SOLICIT messages ( RFC 8415 ).  A server that supports it
+ * answers with an ACK or a Reply straight away, so an address is obtained in
+ * two messages instead of four.  Servers without support keep on using the
+ * normal exchange.
+ *
+ * With Rapid Commit, the DHCP hook is not consulted with
+ * eDHCPPhasePreRequest, because the server has already committed the lease.
+ */
+
+#ifndef ipconfigUSE_DHCP_RAPID_COMMIT
+    #define ipconfigUSE_DHCP_RAPID_COMMIT    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DHCP_RAPID_COMMIT != ipconfigDISABLE ) && ( ipconfigUSE_DHCP_RAPID_COMMIT != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DHCP_RAPID_COMMIT configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_FAST_BRING_UP
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When an interface comes up, every end-point that uses DHCP or DHCPv6 sends
+ * its first DISCOVER or SOLICIT straight away, instead of one timer period
+ * later.  Router Solicitations are already sent at once.  All end-points of
+ * an interface are then started in the same pass of the IP-task, and share
+ * the DHCP socket that is demultiplexed by transaction ID.
+ *
+ * The time from the interface coming up until all of its end-points are up
+ * is stored in 'xTimeToReady' of the interface, logged, and passed to
+ * iptraceINTERFACE_READY().
+ */
+
+#ifndef ipconfigUSE_FAST_BRING_UP
+    #define ipconfigUSE_FAST_BRING_UP    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_FAST_BRING_UP != ipconfigDISABLE ) && ( ipconfigUSE_FAST_BRING_UP != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_FAST_BRING_UP configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_BRING_UP_TIMELINE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, every interface and end-point records the time at which it
+ * first passed each milestone of the network bring-up: the call to
+ * FreeRTOS_IPInit_Multi(), the calls to pfInitialise(), the link coming up
+ * (reported by the driver), the DHCP or DHCPv6 exchange, the Router
+ * Solicitation and Advertisement, duplicate address detection, the network
+ * coming up and the first neighbour that was resolved with ARP or ND. The
+ * timelines are read with FreeRTOS_GetInterfaceTimeline() and
+ * FreeRTOS_GetEndPointTimeline(), to see where the time to the first packet
+ * goes after power-on.
+ */
+
+#ifndef ipconfigUSE_BRING_UP_TIMELINE
+    #define ipconfigUSE_BRING_UP_TIMELINE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_BRING_UP_TIMELINE != ipconfigDISABLE ) && ( ipconfigUSE_BRING_UP_TIMELINE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_BRING_UP_TIMELINE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigBRING_UP_TIMELINE_TIME
+ *
+ * Type: Macro Function
+ * Unit: any free running 32-bit counter
+ *
+ * The time source of ipconfigUSE_BRING_UP_TIMELINE. It is called from the
+ * IP-task and from the task that calls FreeRTOS_IPInit_Multi(), possibly
+ * before the scheduler has started. The default is the clock tick count;
+ * define it as a microsecond timer for a finer view of short phases.
+ */
+
+#ifndef ipconfigBRING_UP_TIMELINE_TIME
+    #define ipconfigBRING_UP_TIMELINE_TIME()    ( ( uint32_t ) xTaskGetTickCount() )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigMAXIMUM_DISCOVER_TX_PERIOD
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigMAXIMUM_DISCOVER_TX_PERIOD
+ *
+ * Type: TickType_t
+ * Unit: Ticks
+ * Minimum: 0
+ * Maximum: portMAX_DELAY
+ *
+ * Sets the max interval allowed between transmissions of DHCP requests before
+ * the default IP address will be used.
+ *
+ * When 'endpoint->bits.bWantDHCP' is set, DHCP requests will be sent out at
+ * increasing time intervals until either a reply is received from a DHCP
+ * server and accepted, or the interval between transmissions reaches
+ * ipconfigMAXIMUM_DISCOVER_TX_PERIOD. If no reply is received, the TCP/IP
+ * stack will revert to using the default IP address of the endpoint
+ * 'endpoint->ipv4_defaults.ulIPAddress' for IPv4 address or
+ * 'endpoint->ipv6_defaults.xIPAddress' for IPv6 address.
+ */
+
+#ifndef ipconfigMAXIMUM_DISCOVER_TX_PERIOD
+    #ifdef _WINDOWS_
+        #define ipconfigMAXIMUM_DISCOVER_TX_PERIOD    pdMS_TO_TICKS( 999 )
+    #else
+        #define ipconfigMAXIMUM_DISCOVER_TX_PERIOD    pdMS_TO_TICKS( 30000 )
+    #endif
+#endif
+
+STATIC_ASSERT( ipconfigMAXIMUM_DISCOVER_TX_PERIOD <= portMAX_DELAY );
+
+/*---------------------------------------------------------------------------*/
+
+/*===========================================================================*/
+/*                               DHCP CONFIG                                 */
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*                                DNS CONFIG                                 */
+/*===========================================================================*/
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_DNS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enable ipconfigUSE_DNS to include a basic DNS client/resolver. DNS is used
+ * through functions like FreeRTOS_getaddrinfo() and FreeRTOS_gethostbyname().
+ *
+ * Allows name discovery protocols like mDNS, LLMNR and NBNS to be enabled as
+ * well.
+ *
+ * See: ipconfigUSE_MDNS, ipconfigUSE_LLMNR, ipconfigUSE_NBNS
+ */
+
+#ifndef ipconfigUSE_DNS
+    #define ipconfigUSE_DNS    ipconfigENABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS != ipconfigDISABLE ) && ( ipconfigUSE_DNS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS_CACHE
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_DNS_CACHE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables usage of the DNS cache.
+ */
+
+#ifndef ipconfigUSE_DNS_CACHE
+    #define ipconfigUSE_DNS_CACHE    ipconfigENABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS_CACHE != ipconfigDISABLE ) && ( ipconfigUSE_DNS_CACHE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS_CACHE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_ENTRIES
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_CACHE_ENTRIES
+ *
+ * Type: size_t
+ * Unit: count of DNS cache entries
+ * Minimum: 1
+ *
+ * Defines the number of entries in the DNS cache.
+ */
+
+#ifndef ipconfigDNS_CACHE_ENTRIES
+    #define ipconfigDNS_CACHE_ENTRIES    ( 1U )
+#endif
+
+#if ( ipconfigDNS_CACHE_ENTRIES < 1 )
+    #error ipconfigDNS_CACHE_ENTRIES must be at least 1
+#endif
+
+#if ( ipconfigDNS_CACHE_ENTRIES > SIZE_MAX )
+    #error ipconfigDNS_CACHE_ENTRIES overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_NAME_LENGTH
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_CACHE_NAME_LENGTH
+ *
+ * Type: size_t
+ * Unit: count of hostname chars
+ * Minimum: 1
+ *
+ * The maximum number of characters a DNS host name can take, including
+ * the NULL terminator.
+ *
+ * Stack warning: the function DNS_ParseDNSReply() declares a local object
+ * of type 'ParseSet_t', which contains a copy of an URL:
+ *
+ *     char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ];
+ *
+ * plus another 52 bytes.
+ */
+
+#ifndef ipconfigDNS_CACHE_NAME_LENGTH
+    #define ipconfigDNS_CACHE_NAME_LENGTH    ( 254U )
+#endif
+
+#if ( ipconfigDNS_CACHE_NAME_LENGTH < 1 )
+    #error ipconfigDNS_CACHE_NAME_LENGTH must be at least 1
+#endif
+
+#if ( ipconfigDNS_CACHE_NAME_LENGTH > SIZE_MAX )
+    #error ipconfigDNS_CACHE_NAME_LENGTH overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_NAME_POOL_SIZE
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 0
+ *
+ * When zero, every row of the DNS cache reserves ipconfigDNS_CACHE_NAME_LENGTH
+ * bytes for the host name.
+ *
+ * When non-zero, the host names are stored once in a shared pool of this many
+ * bytes, and a row refers to its name with a 16-bit index.  A name takes an
+ * 8-byte header plus its length rounded up to a multiple of 8 bytes.  The rows
+ * of the same name, for instance one with IPv4 and one with IPv6 addresses,
+ * share it.  A name is looked up by its hash before it is compared.  When the
+ * pool is full, a new name is not cached.
+ */
+
+#ifndef ipconfigDNS_CACHE_NAME_POOL_SIZE
+    #define ipconfigDNS_CACHE_NAME_POOL_SIZE    0U
+#endif
+
+#if ( ipconfigDNS_CACHE_NAME_POOL_SIZE < 0 )
+    #error ipconfigDNS_CACHE_NAME_POOL_SIZE must be at least 0
+#endif
+
+#if ( ipconfigDNS_CACHE_NAME_POOL_SIZE > 524272 )
+    #error ipconfigDNS_CACHE_NAME_POOL_SIZE must be at most 524272 ( 65534 units of 8 bytes )
+#endif
+
+#if ( ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 ) && ipconfigIS_DISABLED( ipconfigUSE_DNS_CACHE ) )
+    #error ipconfigDNS_CACHE_NAME_POOL_SIZE requires ipconfigUSE_DNS_CACHE
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY
+ *
+ * Type: size_t
+ * Unit: count of IP addresses
+ * Minimum: 1
+ *
+ * Sets how many IP addresses can be stored when looking up a URL.
+ */
+
+#ifndef ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY
+    #define ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY    ( 1 )
+#endif
+
+#if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY < 1 )
+    #error ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY must be at least 1
+#endif
+
+#if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > SIZE_MAX )
+    #error ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS_CACHE_HASH_TABLE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the rows of the DNS cache are indexed by a hash table on the
+ * host name, so a look-up does not have to compare the name with all
+ * ipconfigDNS_CACHE_ENTRIES rows. The rows are also kept in a heap that is
+ * ordered on the moment their TTL runs out: before a new name is added, the
+ * expired rows are removed. When the cache is still full, the least recently
+ * used row is replaced, in stead of the rows being replaced round-robin.
+ *
+ * Useful when the DNS cache is sized to hundreds of names. The cost is 14 bytes
+ * per row plus 2 bytes per bucket, see ipconfigDNS_CACHE_HASH_BUCKET_COUNT.
+ */
+
+#ifndef ipconfigUSE_DNS_CACHE_HASH_TABLE
+    #define ipconfigUSE_DNS_CACHE_HASH_TABLE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS_CACHE_HASH_TABLE != ipconfigDISABLE ) && ( ipconfigUSE_DNS_CACHE_HASH_TABLE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS_CACHE_HASH_TABLE configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DNS_CACHE_HASH_TABLE ) && ( ipconfigDNS_CACHE_ENTRIES > 65534 ) )
+    #error ipconfigUSE_DNS_CACHE_HASH_TABLE supports at most 65534 DNS cache entries
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_HASH_BUCKET_COUNT
+ *
+ * Type: size_t
+ * Unit: count of hash buckets
+ * Minimum: 1
+ *
+ * The number of buckets in the DNS cache hash table. Only used when
+ * ipconfigUSE_DNS_CACHE_HASH_TABLE is enabled. The value must be a power of
+ * two.
+ */
+
+#ifndef ipconfigDNS_CACHE_HASH_BUCKET_COUNT
+    #define ipconfigDNS_CACHE_HASH_BUCKET_COUNT    32U
+#endif
+
+#if ( ipconfigDNS_CACHE_HASH_BUCKET_COUNT < 1 )
+    #error ipconfigDNS_CACHE_HASH_BUCKET_COUNT must be at least 1
+#endif
+
+#if ( ( ipconfigDNS_CACHE_HASH_BUCKET_COUNT & ( ipconfigDNS_CACHE_HASH_BUCKET_COUNT - 1 ) ) != 0 )
+    #error ipconfigDNS_CACHE_HASH_BUCKET_COUNT must be a power of two
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS_NEGATIVE_CACHE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, names that could not be resolved are remembered for a while,
+ * as described in RFC 2308. Until the entry expires, a look-up of such a name
+ * fails at once: no new question is sent to the DNS server. An entry is made
+ * when the server answers NXDOMAIN, or when it answers without any address of
+ * the requested type. The time-to-live is taken from the SOA record in the
+ * answer, limited to ipconfigDNS_NEGATIVE_CACHE_MAX_TTL. An entry is also made
+ * when a blocking look-up timed out after ipconfigDNS_REQUEST_ATTEMPTS.
+ *
+ * Requires ipconfigUSE_DNS_CACHE.
+ */
+
+#ifndef ipconfigUSE_DNS_NEGATIVE_CACHE
+    #define ipconfigUSE_DNS_NEGATIVE_CACHE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS_NEGATIVE_CACHE != ipconfigDISABLE ) && ( ipconfigUSE_DNS_NEGATIVE_CACHE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS_NEGATIVE_CACHE configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DNS_NEGATIVE_CACHE ) && ipconfigIS_DISABLED( ipconfigUSE_DNS_CACHE ) )
+    #error ipconfigUSE_DNS_NEGATIVE_CACHE requires ipconfigUSE_DNS_CACHE
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_NEGATIVE_CACHE_ENTRIES
+ *
+ * Type: size_t
+ * Unit: count of names
+ * Minimum: 1
+ *
+ * The number of names that can be remembered as "not resolvable". When the
+ * table is full, the entry that expires first is replaced. Only used when
+ * ipconfigUSE_DNS_NEGATIVE_CACHE is enabled.
+ */
+
+#ifndef ipconfigDNS_NEGATIVE_CACHE_ENTRIES
+    #define ipconfigDNS_NEGATIVE_CACHE_ENTRIES    4U
+#endif
+
+#if ( ipconfigDNS_NEGATIVE_CACHE_ENTRIES < 1 )
+    #error ipconfigDNS_NEGATIVE_CACHE_ENTRIES must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_NEGATIVE_CACHE_TTL
+ *
+ * Type: uint32_t
+ * Unit: seconds
+ * Minimum: 1
+ *
+ * The time that a negative entry is kept when the answer has no SOA record,
+ * or when the look-up timed out.
+ */
+
+#ifndef ipconfigDNS_NEGATIVE_CACHE_TTL
+    #define ipconfigDNS_NEGATIVE_CACHE_TTL    30U
+#endif
+
+#if ( ipconfigDNS_NEGATIVE_CACHE_TTL < 1 )
+    #error ipconfigDNS_NEGATIVE_CACHE_TTL must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_NEGATIVE_CACHE_MAX_TTL
+ *
+ * Type: uint32_t
+ * Unit: seconds
+ * Minimum: ipconfigDNS_NEGATIVE_CACHE_TTL
+ *
+ * The upper limit of the time-to-live found in an SOA record. Keeps a badly
+ * configured zone from making a name unreachable for hours.
+ */
+
+#ifndef ipconfigDNS_NEGATIVE_CACHE_MAX_TTL
+    #define ipconfigDNS_NEGATIVE_CACHE_MAX_TTL    300U
+#endif
+
+#if ( ipconfigDNS_NEGATIVE_CACHE_MAX_TTL < ipconfigDNS_NEGATIVE_CACHE_TTL )
+    #error ipconfigDNS_NEGATIVE_CACHE_MAX_TTL must be at least ipconfigDNS_NEGATIVE_CACHE_TTL
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_REQUEST_ATTEMPTS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_REQUEST_ATTEMPTS
+ *
+ * Type: size_t
+ * Unit: count of request attempts
+ * Minimum: 1
+ *
+ * Sets the most amount of times the library can send a DNS result and wait for
+ * a result when looking up a host.
+ *
+ * See ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS & ipconfigDNS_SEND_BLOCK_TIME_TICKS
+ */
+
+#ifndef ipconfigDNS_REQUEST_ATTEMPTS
+    #define ipconfigDNS_REQUEST_ATTEMPTS    ( 5 )
+#endif
+
+#if ( ipconfigDNS_REQUEST_ATTEMPTS < 1 )
+    #error ipconfigDNS_REQUEST_ATTEMPTS must be at least 1
+#endif
+
+#if ( ipconfigDNS_REQUEST_ATTEMPTS > SIZE_MAX )
+    #error ipconfigDNS_REQUEST_ATTEMPTS overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS
+ *
+ * Type: TickType_t
+ * Unit: Ticks
+ * Minimum: 0
+ * Maximum: portMAX_DELAY
+ *
+ * When looking up a host with DNS, this macro determines how long the
+ * call to FreeRTOS_sendto() will wait for a reply. When there is no
+ * reply, the request will be repeated up to 'ipconfigDNS_REQUEST_ATTEMPTS'
+ * attempts.
+ * See ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+ *
+ * Applies to DNS socket only.
+ */
+
+#ifndef ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS
+    #define ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS    pdMS_TO_TICKS( 5000 )
+#endif
+
+STATIC_ASSERT( ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS <= portMAX_DELAY );
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_SEND_BLOCK_TIME_TICKS
+ *
+ * Type: TickType_t
+ * Unit: Ticks
+ * Minimum: 0
+ * Maximum: portMAX_DELAY
+ *
+ * When looking up a host with DNS, this macro determines how long the
+ * call to FreeRTOS_sendto() will block to wait for a free buffer.
+ * See ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME
+ *
+ * Applies to DNS socket only.
+ */
+
+#ifndef ipconfigDNS_SEND_BLOCK_TIME_TICKS
+    #define ipconfigDNS_SEND_BLOCK_TIME_TICKS    pdMS_TO_TICKS( 500 )
+#endif
+
+STATIC_ASSERT( ipconfigDNS_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_USE_CALLBACKS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_USE_CALLBACKS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables callback functionality in the DNS process.
+ *
+ * Application defined callbacks can be provided as parameters in calls
+ * to FreeRTOS_gethostbyname_a() & FreeRTOS_getaddrinfo_a(). These functions
+ * will start a DNS-lookup and call the callback when either the URL has been
+ * found, or when a time-out has been reached. These functions are
+ * non-blocking, the suffix "_a" stands for asynchronous. The callback can be
+ * canceled by using FreeRTOS_gethostbyname_cancel().
+ *
+ * Function Prototype:
+ *
+ * void (* FOnDNSEvent ) ( const char * pcName, void * pvSearchID, struct freertos_addrinfo * pxAddressInfo )
+ */
+
+#ifndef ipconfigDNS_USE_CALLBACKS
+    #define ipconfigDNS_USE_CALLBACKS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigDNS_USE_CALLBACKS != ipconfigDISABLE ) && ( ipconfigDNS_USE_CALLBACKS != ipconfigENABLE ) )
+    #error Invalid ipconfigDNS_USE_CALLBACKS configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS_HAPPY_EYEBALLS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, FreeRTOS_getaddrinfo() accepts FREERTOS_AF_UNSPEC in
+ * pxHints->ai_family. The A and AAAA questions are then sent at the same
+ * time. After the first answer, the other one is awaited for at most the
+ * 50 ms "Resolution Delay" of RFC 8305. Both answers are returned in one list.
+ *
+ * It also adds FreeRTOS_connect_happy_eyeballs(), which races TCP connections
+ * to the addresses in such a list. IPv6 and IPv4 addresses are tried
+ * alternately, starting with IPv6. A new attempt is started every
+ * ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS, or as soon as an earlier attempt
+ * fails. The first connection that succeeds is returned.
+ *
+ * Asynchronous look-ups with a call-back do not support FREERTOS_AF_UNSPEC.
+ * Requires both ipconfigUSE_IPv4 and ipconfigUSE_IPv6.
+ */
+
+#ifndef ipconfigUSE_DNS_HAPPY_EYEBALLS
+    #define ipconfigUSE_DNS_HAPPY_EYEBALLS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS_HAPPY_EYEBALLS != ipconfigDISABLE ) && ( ipconfigUSE_DNS_HAPPY_EYEBALLS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS_HAPPY_EYEBALLS configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DNS_HAPPY_EYEBALLS ) && ( ipconfigIS_DISABLED( ipconfigUSE_IPv4 ) || ipconfigIS_DISABLED( ipconfigUSE_IPv6 ) ) )
+    #error ipconfigUSE_DNS_HAPPY_EYEBALLS requires both ipconfigUSE_IPv4 and ipconfigUSE_IPv6
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS
+ *
+ * Type: uint32_t
+ * Unit: milliseconds
+ * Minimum: 10
+ *
+ * The "Connection Attempt Delay" of RFC 8305: the time that
+ * FreeRTOS_connect_happy_eyeballs() waits for a connection attempt before it
+ * starts the next one in parallel. RFC 8305 recommends 250 ms.
+ */
+
+#ifndef ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS
+    #define ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS    250U
+#endif
+
+#if ( ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS < 10 )
+    #error ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS must be at least 10
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS_ASYNC_MULTIPLEX
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Only used when ipconfigDNS_USE_CALLBACKS is enabled.
+ *
+ * By default, every asynchronous look-up creates, binds and closes a UDP
+ * socket of its own. The reply is then handled as a packet for a closed
+ * port, and the list of outstanding look-ups is searched linearly.
+ *
+ * When enabled, all asynchronous look-ups are sent from one UDP socket. The
+ * socket is created at the first such look-up and stays open. Its replies are
+ * handled in the IP-task by a FREERTOS_SO_UDP_RECV_HANDLER. Outstanding
+ * look-ups are found through a hash table on the DNS transaction ID, see
+ * ipconfigDNS_ASYNC_TABLE_SIZE. This suits applications that have dozens of
+ * look-ups running at the same time.
+ *
+ * Note that all asynchronous questions share one source port. The random
+ * transaction ID is their only protection against forged answers.
+ *
+ * Requires ipconfigUSE_CALLBACKS.
+ */
+
+#ifndef ipconfigUSE_DNS_ASYNC_MULTIPLEX
+    #define ipconfigUSE_DNS_ASYNC_MULTIPLEX    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != ipconfigDISABLE ) && ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS_ASYNC_MULTIPLEX configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DNS_ASYNC_MULTIPLEX ) && ipconfigIS_DISABLED( ipconfigUSE_CALLBACKS ) )
+    #error ipconfigUSE_DNS_ASYNC_MULTIPLEX requires ipconfigUSE_CALLBACKS
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_ASYNC_TABLE_SIZE
+ *
+ * Type: size_t
+ * Unit: count of hash buckets
+ * Minimum: 1
+ *
+ * The number of buckets in the table that finds an outstanding asynchronous
+ * look-up by its transaction ID. Only used when ipconfigUSE_DNS_ASYNC_MULTIPLEX
+ * is enabled. The value must be a power of two. The number of outstanding
+ * look-ups is not limited by this value.
+ */
+
+#ifndef ipconfigDNS_ASYNC_TABLE_SIZE
+    #define ipconfigDNS_ASYNC_TABLE_SIZE    16U
+#endif
+
+#if ( ipconfigDNS_ASYNC_TABLE_SIZE < 1 )
+    #error ipconfigDNS_ASYNC_TABLE_SIZE must be at least 1
+#endif
+
+#if ( ( ipconfigDNS_ASYNC_TABLE_SIZE & ( ipconfigDNS_ASYNC_TABLE_SIZE - 1 ) ) != 0 )
+    #error ipconfigDNS_ASYNC_TABLE_SIZE must be a power of two
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_PARALLEL_SERVERS
+ *
+ * Type: size_t
+ * Unit: count of DNS servers
+ * Minimum: 1
+ *
+ * The number of DNS servers of an end-point that a blocking look-up asks at
+ * the same time. The first valid answer is used. With the default of 1, one
+ * server is asked and the next one is only tried after a time-out.
+ *
+ * When larger than 1, the round-trip time of every server is measured and
+ * smoothed. The servers with the shortest round-trip times are asked first,
+ * a server that has not been measured yet counts as the fastest. Servers that
+ * did not answer a look-up at all are moved to the end. The value is limited
+ * to ipconfigENDPOINT_DNS_ADDRESS_COUNT at run-time.
+ *
+ * mDNS and LLMNR look-ups, and asynchronous look-ups, are not affected.
+ */
+
+#ifndef ipconfigDNS_PARALLEL_SERVERS
+    #define ipconfigDNS_PARALLEL_SERVERS    1U
+#endif
+
+#if ( ipconfigDNS_PARALLEL_SERVERS < 1 )
+    #error ipconfigDNS_PARALLEL_SERVERS must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS_CACHE_PREFETCH
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, a cached name that is used often is refreshed in the
+ * background shortly before its time-to-live runs out, so the next look-up
+ * does not have to wait for the DNS server. A look-up of such a name that has
+ * just expired returns the old address for at most
+ * ipconfigDNS_CACHE_STALE_SECONDS, while a refresh is sent.
+ *
+ * A name is "used often" when it was found in the cache at least
+ * ipconfigDNS_CACHE_PREFETCH_MIN_HITS times since it was last stored.
+ *
+ * Requires ipconfigUSE_DNS_CACHE and ipconfigDNS_USE_CALLBACKS.
+ */
+
+#ifndef ipconfigUSE_DNS_CACHE_PREFETCH
+    #define ipconfigUSE_DNS_CACHE_PREFETCH    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS_CACHE_PREFETCH != ipconfigDISABLE ) && ( ipconfigUSE_DNS_CACHE_PREFETCH != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS_CACHE_PREFETCH configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DNS_CACHE_PREFETCH ) && ( ipconfigIS_DISABLED( ipconfigUSE_DNS_CACHE ) || ipconfigIS_DISABLED( ipconfigDNS_USE_CALLBACKS ) ) )
+    #error ipconfigUSE_DNS_CACHE_PREFETCH requires ipconfigUSE_DNS_CACHE and ipconfigDNS_USE_CALLBACKS
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_PREFETCH_SECONDS
+ *
+ * Type: uint32_t
+ * Unit: seconds
+ * Minimum: 1
+ *
+ * A refresh of a popular cache entry is started when it has less than this
+ * number of seconds left to live.
+ */
+
+#ifndef ipconfigDNS_CACHE_PREFETCH_SECONDS
+    #define ipconfigDNS_CACHE_PREFETCH_SECONDS    10U
+#endif
+
+#if ( ipconfigDNS_CACHE_PREFETCH_SECONDS < 1 )
+    #error ipconfigDNS_CACHE_PREFETCH_SECONDS must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_PREFETCH_MIN_HITS
+ *
+ * Type: uint8_t
+ * Unit: count of look-ups
+ * Minimum: 1
+ * Maximum: 255
+ *
+ * The number of times that a name must be found in the cache before it is
+ * refreshed in the background.
+ */
+
+#ifndef ipconfigDNS_CACHE_PREFETCH_MIN_HITS
+    #define ipconfigDNS_CACHE_PREFETCH_MIN_HITS    2U
+#endif
+
+#if ( ( ipconfigDNS_CACHE_PREFETCH_MIN_HITS < 1 ) || ( ipconfigDNS_CACHE_PREFETCH_MIN_HITS > 255 ) )
+    #error ipconfigDNS_CACHE_PREFETCH_MIN_HITS must be between 1 and 255
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_STALE_SECONDS
+ *
+ * Type: uint32_t
+ * Unit: seconds
+ * Minimum: 0
+ *
+ * The number of seconds that an expired popular entry may still be returned
+ * while it is being refreshed. Use 0 to never return expired addresses.
+ */
+
+#ifndef ipconfigDNS_CACHE_STALE_SECONDS
+    #define ipconfigDNS_CACHE_STALE_SECONDS    30U
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS_CACHE_PERSISTENCE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the DNS cache can be kept in non-volatile storage, so names
+ * resolve without a look-up right after a reboot.
+ *
+ * FreeRTOS_dnsCacheSave() passes the valid entries of the cache to the
+ * application hook xApplicationDNSCacheStore(). Each entry holds the time at
+ * which it expires, in seconds since 1970 as returned by
+ * ulApplicationTimeHook(). When the IP-task starts, the entries returned by
+ * uxApplicationDNSCacheLoad() are put back in the cache with the time that
+ * they have left to live. Entries that have expired are skipped.
+ *
+ * The application supplies the three hook functions, and decides when the
+ * cache is saved, for instance periodically or before a planned reboot.
+ *
+ * Requires ipconfigUSE_DNS_CACHE.
+ */
+
+#ifndef ipconfigUSE_DNS_CACHE_PERSISTENCE
+    #define ipconfigUSE_DNS_CACHE_PERSISTENCE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS_CACHE_PERSISTENCE != ipconfigDISABLE ) && ( ipconfigUSE_DNS_CACHE_PERSISTENCE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS_CACHE_PERSISTENCE configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DNS_CACHE_PERSISTENCE ) && ipconfigIS_DISABLED( ipconfigUSE_DNS_CACHE ) )
+    #error ipconfigUSE_DNS_CACHE_PERSISTENCE requires ipconfigUSE_DNS_CACHE
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS_IN_PLACE_PARSER
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, names in DNS replies are compared where they are in the
+ * message, following compression pointers, instead of being decoded first.
+ * This has two effects:
+ *
+ * - A reply that was not expected, and that no asynchronous look-up is
+ *   waiting for, is dropped before it is decoded. This saves work on the
+ *   IP-task on a LAN with much mDNS or LLMNR traffic.
+ * - Only answer records about the name that was asked for are used. CNAME
+ *   records are followed. Records about other names are skipped without
+ *   looking at their data.
+ */
+
+#ifndef ipconfigUSE_DNS_IN_PLACE_PARSER
+    #define ipconfigUSE_DNS_IN_PLACE_PARSER    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS_IN_PLACE_PARSER != ipconfigDISABLE ) && ( ipconfigUSE_DNS_IN_PLACE_PARSER != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS_IN_PLACE_PARSER configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_LLMNR
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_LLMNR
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for Link Local Multicast Name Resolution (LLMNR).
+ */
+
+#ifndef ipconfigUSE_LLMNR
+    #define ipconfigUSE_LLMNR    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_LLMNR != ipconfigDISABLE ) && ( ipconfigUSE_LLMNR != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_LLMNR configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_LLMNR ) && ipconfigIS_DISABLED( ipconfigUSE_DNS ) )
+    #error When LLMNR is enabled, ipconfigUSE_DNS must also be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_NBNS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_NBNS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for NetBIOS Name Service (NBNS).
+ */
+
+#ifndef ipconfigUSE_NBNS
+    #define ipconfigUSE_NBNS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_NBNS != ipconfigDISABLE ) && ( ipconfigUSE_NBNS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NBNS configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_NBNS ) && ipconfigIS_DISABLED( ipconfigUSE_DNS ) )
+    #error When NBNS is enabled, ipconfigUSE_DNS must also be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_MDNS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for Multicast DNS (MDNS).
+ */
+
+#ifndef ipconfigUSE_MDNS
+    #define ipconfigUSE_MDNS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_MDNS != ipconfigDISABLE ) && ( ipconfigUSE_MDNS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_MDNS configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ipconfigIS_DISABLED( ipconfigUSE_DNS ) )
+    #error When MDNS is enabled, ipconfigUSE_DNS must also be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_DNS_ANSWER_TEMPLATES
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the LLMNR, mDNS and NBNS responders keep the encoded reply to
+ * each question they have answered positively. A later query that carries
+ * exactly the same question, and that arrives on the same end-point, is
+ * answered by copying the stored reply and patching its transaction ID. The
+ * name is not decoded and xApplicationDNSQueryHook_Multi() is not called.
+ *
+ * A template is only used as long as the address of its end-point has not
+ * changed. An application that changes the answer of its query hook, e.g.
+ * when it is renamed, must call FreeRTOS_DNSAnswerTemplatesClear().
+ *
+ * Useful on a LAN where phones and PCs send many discovery queries.
+ */
+
+#ifndef ipconfigUSE_DNS_ANSWER_TEMPLATES
+    #define ipconfigUSE_DNS_ANSWER_TEMPLATES    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DNS_ANSWER_TEMPLATES != ipconfigDISABLE ) && ( ipconfigUSE_DNS_ANSWER_TEMPLATES != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DNS_ANSWER_TEMPLATES configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DNS_ANSWER_TEMPLATES ) && ipconfigIS_DISABLED( ipconfigUSE_LLMNR ) && ipconfigIS_DISABLED( ipconfigUSE_MDNS ) && ipconfigIS_DISABLED( ipconfigUSE_NBNS ) )
+    #error ipconfigUSE_DNS_ANSWER_TEMPLATES requires ipconfigUSE_LLMNR, ipconfigUSE_MDNS or ipconfigUSE_NBNS
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_ANSWER_TEMPLATE_COUNT
+ *
+ * Type: size_t
+ * Unit: count of templates
+ * Minimum: 1
+ *
+ * The number of reply templates kept when ipconfigUSE_DNS_ANSWER_TEMPLATES is
+ * enabled. When all are in use, the oldest one is replaced.
+ */
+
+#ifndef ipconfigDNS_ANSWER_TEMPLATE_COUNT
+    #define ipconfigDNS_ANSWER_TEMPLATE_COUNT    4U
+#endif
+
+#if ( ipconfigDNS_ANSWER_TEMPLATE_COUNT < 1 )
+    #error ipconfigDNS_ANSWER_TEMPLATE_COUNT must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_ANSWER_TEMPLATE_SIZE
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 80
+ *
+ * The maximum length of the UDP payload of a reply template. Replies that are
+ * longer are sent as usual, but are not stored. An NBNS reply takes 62 bytes,
+ * an LLMNR or mDNS reply takes 28 or 40 bytes plus the encoded name.
+ */
+
+#ifndef ipconfigDNS_ANSWER_TEMPLATE_SIZE
+    #define ipconfigDNS_ANSWER_TEMPLATE_SIZE    128U
+#endif
+
+#if ( ipconfigDNS_ANSWER_TEMPLATE_SIZE < 80 )
+    #error ipconfigDNS_ANSWER_TEMPLATE_SIZE must be at least 80
+#endif
+
+#if ( ipconfigDNS_ANSWER_TEMPLATE_SIZE > 65535 )
+    #error ipconfigDNS_ANSWER_TEMPLATE_SIZE overflows a uint16_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*===========================================================================*/
+/*                                DNS CONFIG                                 */
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*                                ARP CONFIG                                 */
+/*===========================================================================*/
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_CACHE_ENTRIES
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigARP_CACHE_ENTRIES
+ *
+ * Type: size_t
+ * Unit: count of arp cache entries
+ * Minimum: 1
+ *
+ * Defines the maximum number of entries that can exist in the ARP table at any
+ * one time.
+ *
+ * The ARP cache is a table that maps IP addresses to MAC addresses. The IP
+ * stack can only send a UDP message to a remove IP address if it knowns
+ * the MAC address associated with the IP address, or the MAC address of the
+ * router used to contact the remote IP address. When a UDP message is received
+ * from a remote IP address, the MAC address and IP address are added to the
+ * ARP cache. When a UDP message is sent to a remote IP address that does not
+ * already appear in the ARP cache, then the UDP message is replaced by a ARP
+ * message that solicits the required MAC address information.
+ */
+
+#ifndef ipconfigARP_CACHE_ENTRIES
+    #define ipconfigARP_CACHE_ENTRIES    ( 10 )
+#endif
+
+#if ( ipconfigARP_CACHE_ENTRIES < 1 )
+    #error ipconfigARP_CACHE_ENTRIES must be at least 1
+#endif
+
+#if ( ipconfigARP_CACHE_ENTRIES > SIZE_MAX )
+    #error ipconfigARP_CACHE_ENTRIES overflows a size_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_ARP_HASH_TABLE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the rows of the ARP cache are indexed by two hash tables, one
+ * on the IP-address and one on the MAC-address, so a look-up does not have to
+ * scan all ipconfigARP_CACHE_ENTRIES rows. When the cache is full, the least
+ * recently used row is replaced, instead of the row with the lowest age.
+ *
+ * Useful when ipconfigARP_CACHE_ENTRIES is large, e.g. on a gateway that talks
+ * to hundreds of hosts. The cost is 8 bytes per row plus 4 bytes per bucket,
+ * see ipconfigARP_HASH_BUCKET_COUNT.
+ */
+
+#ifndef ipconfigUSE_ARP_HASH_TABLE
+    #define ipconfigUSE_ARP_HASH_TABLE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_ARP_HASH_TABLE != ipconfigDISABLE ) && ( ipconfigUSE_ARP_HASH_TABLE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_ARP_HASH_TABLE configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_ARP_HASH_TABLE ) && ( ipconfigARP_CACHE_ENTRIES > 65534 ) )
+    #error ipconfigUSE_ARP_HASH_TABLE supports at most 65534 ARP cache entries
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_HASH_BUCKET_COUNT
+ *
+ * Type: size_t
+ * Unit: count of hash buckets
+ * Minimum: 1
+ *
+ * The number of buckets in each of the ARP hash tables. Only used when
+ * ipconfigUSE_ARP_HASH_TABLE is enabled. The value must be a power of two. A
+ * good choice is about a quarter of ipconfigARP_CACHE_ENTRIES.
+ */
+
+#ifndef ipconfigARP_HASH_BUCKET_COUNT
+    #define ipconfigARP_HASH_BUCKET_COUNT    64U
+#endif
+
+#if ( ipconfigARP_HASH_BUCKET_COUNT < 1 )
+    #error ipconfigARP_HASH_BUCKET_COUNT must be at least 1
+#endif
+
+#if ( ( ipconfigARP_HASH_BUCKET_COUNT & ( ipconfigARP_HASH_BUCKET_COUNT - 1 ) ) != 0 )
+    #error ipconfigARP_HASH_BUCKET_COUNT must be a power of two
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_STATIC_ENTRIES
+ *
+ * Type: size_t
+ * Unit: count of ARP static entries
+ * Minimum: 0
+ *
+ * The number of permanent IPv4 to MAC address mappings that can be added with
+ * FreeRTOS_AddStaticARPEntry(), e.g. for a gateway or a PLC.  These entries
+ * are kept in a separate table that is searched before the ARP cache.  They
+ * do not age, they are not replaced by received ARP packets, and they survive
+ * FreeRTOS_ClearARP(), so the first packet to such a host is sent without
+ * waiting for an ARP reply.  0 disables the table.
+ */
+
+#ifndef ipconfigARP_STATIC_ENTRIES
+    #define ipconfigARP_STATIC_ENTRIES    0
+#endif
+
+#if ( ipconfigARP_STATIC_ENTRIES < 0 )
+    #error ipconfigARP_STATIC_ENTRIES must be at least 0
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_REQUEST_LIMIT_ENTRIES
+ *
+ * Type: size_t
+ * Unit: count of IPv4 addresses
+ * Minimum: 0
+ *
+ * The number of unresolved IPv4 addresses for which the time of the last
+ * broadcast ARP request is remembered.  A new request for the same address
+ * is only sent after ipconfigARP_REQUEST_MIN_INTERVAL_MS, and that interval
+ * doubles with each request up to ipconfigARP_REQUEST_MAX_INTERVAL_MS, until
+ * a reply arrives.  This avoids ARP storms when many packets wait for the
+ * same host, e.g. after FreeRTOS_ClearARP() or during a network scan.  When
+ * the table is full, the address that was asked for the longest time ago is
+ * forgotten.  Gratuitous ARPs and unicast polls of known hosts are never
+ * limited.  0 disables the limit.
+ */
+
+#ifndef ipconfigARP_REQUEST_LIMIT_ENTRIES
+    #define ipconfigARP_REQUEST_LIMIT_ENTRIES    0
+#endif
+
+#if ( ipconfigARP_REQUEST_LIMIT_ENTRIES < 0 )
+    #error ipconfigARP_REQUEST_LIMIT_ENTRIES must be at least 0
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_REQUEST_MIN_INTERVAL_MS
+ *
+ * Type: uint32_t
+ * Unit: milliseconds
+ * Minimum: 1
+ *
+ * The minimum time between two broadcast ARP requests for the same address,
+ * see ipconfigARP_REQUEST_LIMIT_ENTRIES.
+ */
+
+#ifndef ipconfigARP_REQUEST_MIN_INTERVAL_MS
+    #define ipconfigARP_REQUEST_MIN_INTERVAL_MS    ( 1000U )
+#endif
+
+#if ( ipconfigARP_REQUEST_MIN_INTERVAL_MS < 1 )
+    #error ipconfigARP_REQUEST_MIN_INTERVAL_MS must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_REQUEST_MAX_INTERVAL_MS
+ *
+ * Type: uint32_t
+ * Unit: milliseconds
+ * Minimum: ipconfigARP_REQUEST_MIN_INTERVAL_MS
+ *
+ * The upper limit of the exponential backoff between broadcast ARP requests
+ * for the same address, see ipconfigARP_REQUEST_LIMIT_ENTRIES.
+ */
+
+#ifndef ipconfigARP_REQUEST_MAX_INTERVAL_MS
+    #define ipconfigARP_REQUEST_MAX_INTERVAL_MS    ( 16000U )
+#endif
+
+#if ( ipconfigARP_REQUEST_MAX_INTERVAL_MS < ipconfigARP_REQUEST_MIN_INTERVAL_MS )
+    #error ipconfigARP_REQUEST_MAX_INTERVAL_MS must be at least ipconfigARP_REQUEST_MIN_INTERVAL_MS
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_WAITING_BUFFER_COUNT
+ *
+ * Type: size_t
+ * Unit: count of network buffers
+ * Minimum: 1
+ *
+ * A received packet whose sender is not yet in the ARP or ND cache is set
+ * aside until the address has been resolved, and is then processed again.
+ * This defines how many packets can be set aside at the same time, for all
+ * senders together. All packets of a sender are handled in one go when its
+ * ARP reply or neighbour advertisement arrives. Packets that do not fit are
+ * dropped, as are packets that wait longer than two seconds.
+ *
+ * The default of 1 keeps the single buffer 'pxARPWaitingNetworkBuffer'.
+ */
+
+#ifndef ipconfigARP_WAITING_BUFFER_COUNT
+    #define ipconfigARP_WAITING_BUFFER_COUNT    ( 1 )
+#endif
+
+#if ( ipconfigARP_WAITING_BUFFER_COUNT < 1 )
+    #error ipconfigARP_WAITING_BUFFER_COUNT must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_WAITING_BUFFERS_PER_ADDRESS
+ *
+ * Type: size_t
+ * Unit: count of network buffers
+ * Minimum: 1
+ *
+ * The maximum number of packets from a single sender that are set aside while
+ * its address is being resolved, so one busy host can not take all of
+ * ipconfigARP_WAITING_BUFFER_COUNT. Only used when
+ * ipconfigARP_WAITING_BUFFER_COUNT is larger than 1.
+ */
+
+#ifndef ipconfigARP_WAITING_BUFFERS_PER_ADDRESS
+    #define ipconfigARP_WAITING_BUFFERS_PER_ADDRESS    ipconfigARP_WAITING_BUFFER_COUNT
+#endif
+
+#if ( ipconfigARP_WAITING_BUFFERS_PER_ADDRESS < 1 )
+    #error ipconfigARP_WAITING_BUFFERS_PER_ADDRESS must be at least 1
+#endif
+
+#if ( ipconfigARP_WAITING_BUFFERS_PER_ADDRESS > ipconfigARP_WAITING_BUFFER_COUNT )
+    #error ipconfigARP_WAITING_BUFFERS_PER_ADDRESS can not be larger than ipconfigARP_WAITING_BUFFER_COUNT
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_STORES_REMOTE_ADDRESSES
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigARP_STORES_REMOTE_ADDRESSES
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Advanced users only.
+ *
+ * Normally, the ARP table will only store IP-addresses that are located
+ * in the local subnet. This macro enables the storage of remote addresses
+ * in the ARP table along with the associated MAC address from which the
+ * message was received.
+ *
+ * Provided for the case when a message that requires a reply arrives from the
+ * Internet, but from a computer attached to a LAN rather than via the defined
+ * gateway. Before replying to the message, the TCP/IP stack RTOS task will
+ * loop up the message's IP address in the ARP table. If disabled then ARP will
+ * return the MAC address of the defined gateway because the destination
+ * address is outside of the netmask, which might prevent the reply reaching
+ * its intended destination. This macro can allow the message in this scenario
+ * to be routed and delivered correctly.
+ */
+
+#ifndef ipconfigARP_STORES_REMOTE_ADDRESSES
+    #define ipconfigARP_STORES_REMOTE_ADDRESSES    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigARP_STORES_REMOTE_ADDRESSES != ipconfigDISABLE ) && ( ipconfigARP_STORES_REMOTE_ADDRESSES != ipconfigENABLE ) )
+    #error Invalid ipconfigARP_STORES_REMOTE_ADDRESSES configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP ) && ipconfigIS_ENABLED( ipconfigDHCP_FALL_BACK_AUTO_IP ) )
+
+/*-----------------------------------------------------------------------*/
+
+/*
+ * ipconfigARP_USE_CLASH_DETECTION
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigARP_USE_CLASH_DETECTION
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables the driver to test if an assigned link-layer address is already
+ * taken by another device by sending ARP requests.
+ *
+ * ipconfigDHCP_FALL_BACK_AUTO_IP requires this feature to be enabled.
+ */
+
+    #ifndef ipconfigARP_USE_CLASH_DETECTION
+        #define ipconfigARP_USE_CLASH_DETECTION    ipconfigENABLE
+    #endif
+
+    #if ( ( ipconfigARP_USE_CLASH_DETECTION != ipconfigDISABLE ) && ( ipconfigARP_USE_CLASH_DETECTION != ipconfigENABLE ) )
+        #error Invalid ipconfigARP_USE_CLASH_DETECTION configuration
+    #endif
+
+    #if ( ipconfigIS_DISABLED( ipconfigARP_USE_CLASH_DETECTION ) )
+        #error When ipconfigDHCP_FALL_BACK_AUTO_IP is enabled, ipconfigARP_USE_CLASH_DETECTION must also be enabled
+    #endif
+
+/*-----------------------------------------------------------------------*/
+
+#else /* ( ( ipconfigIS_ENABLED( ipconfigUSE_DHCP ) && ipconfigIS_ENABLED( ipconfigDHCP_FALL_BACK_AUTO_IP ) ) */
+
+/*-----------------------------------------------------------------------*/
+
+    #ifndef ipconfigARP_USE_CLASH_DETECTION
+        #define ipconfigARP_USE_CLASH_DETECTION    ipconfigDISABLE
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigARP_USE_CLASH_DETECTION ) )
+        #error ipconfigARP_USE_CLASH_DETECTION is unused when ipconfigDHCP_FALL_BACK_AUTO_IP is disabled
+    #endif
+
+/*-----------------------------------------------------------------------*/
+
+#endif /* ( ipconfigIS_ENABLED( ipconfigUSE_DHCP ) && ipconfigIS_ENABLED( ipconfigDHCP_FALL_BACK_AUTO_IP ) ) */
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigMAX_ARP_AGE
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigMAX_ARP_AGE
  *
- * #define ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME    pdMS_TO_TICKS( 2000U )
+ * Type: uint8_t
+ * Unit: decaseconds
+ * Minimum: 0
  *
- * The timeout time can be changed at any time using the FREERTOS_SO_RCVTIMEO
- * parameter with FreeRTOS_setsockopt(). Note: Infinite block times should be
- * used with extreme care in order to avoid a situation where all tasks are
- * blocked indefinitely to wait for another RTOS task (which is also blocked
- * indefinitely) to free a network buffer.
+ * Defines the maximum time between an entry in the ARP table being created or
+ * refreshed and the entry being removed because it is stale. New ARP requests
+ * are sent for ARP cache entries that are nearing their maximum age.
+ * The maximum age of an entry in the ARP cache table can be
+ * calculated as 'ipARP_TIMER_PERIOD_MS' x 'ipconfigMAX_ARP_AGE'.
  *
- * A socket can be set to non-blocking mode by setting both the send and
- * receive block time to 0. This might be desirable when an RTOS task is using
- * more than one socket - in which case blocking can instead by performed on
- * all the sockets at once using FreeRTOS_select(), or the RTOS task can
- * set ipconfigSOCKET_HAS_USER_SEMAPHORE to one, then block on its own
- * semaphore.
+ * Units are derived from ipARP_TIMER_PERIOD_MS, which is 10000 ms or 10 sec.
+ * So, a value of 150 is equal to 1500 seconds.
  */
 
-#ifndef ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
-    #define ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME    portMAX_DELAY
+#ifndef ipconfigMAX_ARP_AGE
+    #define ipconfigMAX_ARP_AGE    ( 150 )
 #endif
 
-STATIC_ASSERT( ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME <= portMAX_DELAY );
+#if ( ipconfigMAX_ARP_AGE < 0 )
+    #error ipconfigMAX_ARP_AGE must be at least 0
+#endif
+
+#if ( ipconfigMAX_ARP_AGE > UINT8_MAX )
+    #error ipconfigMAX_ARP_AGE overflows a uint8_t
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME
+ * ipconfigARP_REFRESH_AHEAD_PERIODS
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME
+ * Type: uint8_t
+ * Unit: ARP timer periods, normally decaseconds
+ * Minimum: 0
  *
- * Type: TickType_t
- * Unit: Ticks
+ * When zero, an ARP or ND cache entry that is nearing its maximum age gets a
+ * broadcast ARP request, or a multicast neighbour solicitation, during each of
+ * the last 3 periods, whether it is in use or not.
+ *
+ * When non-zero, the refresh starts this many periods before the entry
+ * expires, and only for entries that were looked up to send a packet during
+ * the preceding period. The request or solicitation is sent directly to the
+ * cached MAC-address. Entries that are not used expire silently, so hosts that
+ * are being talked to do not suffer a resolution delay when their entry would
+ * otherwise age out. A value of a few periods more than the interval at which
+ * a host is polled is a good choice.
+ *
+ * Does not apply to the ND cache when ipconfigUSE_ND_HASH_TABLE is enabled,
+ * which probes the neighbours in use according to RFC 4861.
+ */
+
+#ifndef ipconfigARP_REFRESH_AHEAD_PERIODS
+    #define ipconfigARP_REFRESH_AHEAD_PERIODS    ( 0 )
+#endif
+
+#if ( ipconfigARP_REFRESH_AHEAD_PERIODS < 0 )
+    #error ipconfigARP_REFRESH_AHEAD_PERIODS must be at least 0
+#endif
+
+#if ( ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 ) && ( ipconfigARP_REFRESH_AHEAD_PERIODS >= ipconfigMAX_ARP_AGE ) )
+    #error ipconfigARP_REFRESH_AHEAD_PERIODS must be less than ipconfigMAX_ARP_AGE
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigMAX_ARP_RETRANSMISSIONS
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigMAX_ARP_RETRANSMISSIONS
+ *
+ * Type: uint8_t
+ * Unit: count of retransmissions
  * Minimum: 0
- * Maximum: portMAX_DELAY
  *
- * When writing to a socket, the write may not be able to proceed immediately.
- * For example, depending on the configuration, a write might have to wait for
- * a network buffer to become available.
- * It determines the number of clock ticks that FreeRTOS_send() must wait
- * for space in the transmission buffer. For FreeRTOS_sendto(), it limits
- * how long the application should wait for a network buffer to become available.
+ * Sets the number of times an ARP request is sent when looking up an
+ * IP-address. Also referred as the maximum amount of retransmissions
+ * of ARP requests that do not result in an ARP response before the ARP
+ * request is aborted.
+ */
+
+#ifndef ipconfigMAX_ARP_RETRANSMISSIONS
+    #define ipconfigMAX_ARP_RETRANSMISSIONS    ( 5 )
+#endif
+
+#if ( ipconfigMAX_ARP_RETRANSMISSIONS < 0 )
+    #error ipconfigMAX_ARP_RETRANSMISSIONS must be at least 0
+#endif
+
+#if ( ipconfigMAX_ARP_RETRANSMISSIONS > UINT8_MAX )
+    #error ipconfigMAX_ARP_RETRANSMISSIONS overflows a uint8_t
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_ARP_REMOVE_ENTRY
  *
- * See ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_ARP_REMOVE_ENTRY
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Advanced users only.
+ *
+ * Include support for ulARPRemoveCacheEntryByMac() which uses a MAC address to
+ * look up and remove an entry from the ARP cache. If the MAC address is found
+ * in the ARP cache, then the IP address associated with the MAC address is
+ * returned, otherwise 0 is returned.
  */
 
-#ifndef ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME
-    #define ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME    portMAX_DELAY
+#ifndef ipconfigUSE_ARP_REMOVE_ENTRY
+    #define ipconfigUSE_ARP_REMOVE_ENTRY    ipconfigDISABLE
 #endif
 
-STATIC_ASSERT( ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME <= portMAX_DELAY );
+#if ( ( ipconfigUSE_ARP_REMOVE_ENTRY != ipconfigDISABLE ) && ( ipconfigUSE_ARP_REMOVE_ENTRY != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_ARP_REMOVE_ENTRY configuration
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigSOCKET_HAS_USER_SEMAPHORE
+ * ipconfigUSE_ARP_REVERSED_LOOKUP
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSOCKET_HAS_USER_SEMAPHORE
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_ARP_REVERSED_LOOKUP
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Allows a semaphore to be provided that will be given after important events
- * to wake up the user.
+ * Advanced users only.
  *
- * Set by calling FreeRTOS_setsockopt() with the FREERTOS_SO_SET_SEMAPHORE
- * option and a pointer to a semaphore. Once set, the semaphore will be signalled
- * after every important socket event: READ, WRITE, EXCEPTION.
- * Note that a READ event is also generated for a TCP socket in listen mode,
- * and a WRITE event is generated when a call to connect() has succeeded.
- * Beside that, READ and WRITE are the normal events that occur when
- * data has been received or delivered.
+ * Include support for eARPGetCacheEntryByMac() which looks up a MAC address
+ * from an IP address.
  *
- * Can be used with non-blocking sockets as an alternative to
- * FreeRTOS_select in order to handle multiple sockets at once.
+ * ARP normally does the reverse by looking up an IP address from a MAC
+ * address.
  */
 
-#ifndef ipconfigSOCKET_HAS_USER_SEMAPHORE
-    #define ipconfigSOCKET_HAS_USER_SEMAPHORE    ipconfigDISABLE
+#ifndef ipconfigUSE_ARP_REVERSED_LOOKUP
+    #define ipconfigUSE_ARP_REVERSED_LOOKUP    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigSOCKET_HAS_USER_SEMAPHORE != ipconfigDISABLE ) && ( ipconfigSOCKET_HAS_USER_SEMAPHORE != ipconfigENABLE ) )
-    #error Invalid ipconfigSOCKET_HAS_USER_SEMAPHORE configuration
+#if ( ( ipconfigUSE_ARP_REVERSED_LOOKUP != ipconfigDISABLE ) && ( ipconfigUSE_ARP_REVERSED_LOOKUP != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_ARP_REVERSED_LOOKUP configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
+/*===========================================================================*/
+/*                                ARP CONFIG                                 */
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*                               ICMP CONFIG                                 */
+/*===========================================================================*/
+
+/*---------------------------------------------------------------------------*/
+
 /*
- * ipconfigSOCKET_HAS_USER_WAKE_CALLBACK
+ * ipconfigREPLY_TO_INCOMING_PINGS
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSOCKET_HAS_USER_WAKE_CALLBACK
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigREPLY_TO_INCOMING_PINGS
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enables usage of an application defined hook that will be called after
- * one of the following events:
+ * Enables generation of replies to incoming ICMP echo (ping) requests.
  *
- * eSOCKET_RECEIVE = 0x0001, * Reception of new data. *
- * eSOCKET_SEND    = 0x0002, * Some data has been sent. *
- * eSOCKET_ACCEPT  = 0x0004, * A new TCP client was detected, please call accept(). *
- * eSOCKET_CONNECT = 0x0008, * A TCP connect has succeeded or timed-out. *
- * eSOCKET_BOUND   = 0x0010, * A socket got bound. *
- * eSOCKET_CLOSED  = 0x0020, * A TCP connection got closed. *
- * eSOCKET_INTR    = 0x0040, * A blocking API call got interrupted, because
- *                           * the function FreeRTOS_SignalSocket() was called. *
+ * Normally it is quite desirable when embedded devices respond to a ping
+ * request. Endpoints of the type IPv6 will reply to a ping request
+ * unconditionally.
+ */
+
+#ifndef ipconfigREPLY_TO_INCOMING_PINGS
+    #define ipconfigREPLY_TO_INCOMING_PINGS    ipconfigENABLE
+#endif
+
+#if ( ( ipconfigREPLY_TO_INCOMING_PINGS != ipconfigDISABLE ) && ( ipconfigREPLY_TO_INCOMING_PINGS != ipconfigENABLE ) )
+    #error Invalid ipconfigREPLY_TO_INCOMING_PINGS configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigICMP_TIME_TO_LIVE
  *
- * It is not a good idea to do a lot of processing in any of the application
- * hooks. Normally the hook will only notify the task that owns the socket so
- * that the socket gets immediate attention.
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigICMP_TIME_TO_LIVE
  *
- * Function prototype:
+ * Type: uint8_t
+ * Unit: 'hops'
+ * Minimum: 0
  *
- * typedef void (* SocketWakeupCallback_t)( Socket_t pxSocket )
+ * Sets the value of the TTL field when replying to an ICMP packet.
+ *
+ * Only used when replying to an ICMP IPv4 ping request. The default of 64 is
+ * recommended by RFC 1700.
  */
 
-#ifndef ipconfigSOCKET_HAS_USER_WAKE_CALLBACK
-    #define ipconfigSOCKET_HAS_USER_WAKE_CALLBACK    ipconfigDISABLE
+#ifndef ipconfigICMP_TIME_TO_LIVE
+    #define ipconfigICMP_TIME_TO_LIVE    ( 64 )
 #endif
 
-#if ( ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK != ipconfigDISABLE ) && ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK != ipconfigENABLE ) )
-    #error Invalid ipconfigSOCKET_HAS_USER_WAKE_CALLBACK configuration
+#if ( ipconfigICMP_TIME_TO_LIVE < 0 )
+    #error ipconfigICMP_TIME_TO_LIVE must be at least 0
+#endif
+
+#if ( ipconfigICMP_TIME_TO_LIVE > UINT8_MAX )
+    #error ipconfigICMP_TIME_TO_LIVE overflows a uint8_t
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigSUPPORT_SIGNALS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSUPPORT_SIGNALS
+ * ipconfigUSE_ICMP_RATE_LIMIT
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Advanced users only.
+ * When enabled, the ICMP and ICMPv6 messages that the stack sends in reply to
+ * received packets are limited by token buckets, so that a ping flood cannot
+ * use up the time of the IP-task and the network buffers.  Every message
+ * type has one global bucket that allows ipconfigICMP_RATE_LIMIT_PER_SECOND
+ * messages per second, and each source address gets a bucket that allows
+ * ipconfigICMP_RATE_LIMIT_PER_SOURCE messages per second, with bursts of up
+ * to ipconfigICMP_RATE_LIMIT_BURST messages.  Packets that are not answered
+ * are counted as eDropRateLimited.
+ */
+
+#ifndef ipconfigUSE_ICMP_RATE_LIMIT
+    #define ipconfigUSE_ICMP_RATE_LIMIT    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_ICMP_RATE_LIMIT != ipconfigDISABLE ) && ( ipconfigUSE_ICMP_RATE_LIMIT != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_ICMP_RATE_LIMIT configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigICMP_RATE_LIMIT_PER_SECOND
  *
- * Include support for FreeRTOS_SignalSocket().
+ * Type: uint32_t
+ * Unit: messages per second
+ * Minimum: 1
+ *
+ * The number of ICMP messages of one type that may be sent per second to all
+ * hosts together, see ipconfigUSE_ICMP_RATE_LIMIT.  The global bucket can
+ * hold one second worth of messages.
+ */
+
+#ifndef ipconfigICMP_RATE_LIMIT_PER_SECOND
+    #define ipconfigICMP_RATE_LIMIT_PER_SECOND    ( 100U )
+#endif
+
+#if ( ipconfigICMP_RATE_LIMIT_PER_SECOND < 1 )
+    #error ipconfigICMP_RATE_LIMIT_PER_SECOND must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigICMP_RATE_LIMIT_PER_SOURCE
+ *
+ * Type: uint32_t
+ * Unit: messages per second
+ * Minimum: 0
  *
- * Used to interrupt a socket during a blocked read allowing the task proceed.
- * A signal interruption can be distinguished from a read through the return
- * value -pdFREERTOS_ERRNO_EINTR.
+ * The number of ICMP messages of one type that may be sent per second to a
+ * single host, see ipconfigUSE_ICMP_RATE_LIMIT.  0 disables the limit per
+ * source.
  */
 
-#ifndef ipconfigSUPPORT_SIGNALS
-    #define ipconfigSUPPORT_SIGNALS    ipconfigDISABLE
+#ifndef ipconfigICMP_RATE_LIMIT_PER_SOURCE
+    #define ipconfigICMP_RATE_LIMIT_PER_SOURCE    ( 10U )
 #endif
 
-#if ( ( ipconfigSUPPORT_SIGNALS != ipconfigDISABLE ) && ( ipconfigSUPPORT_SIGNALS != ipconfigENABLE ) )
-    #error Invalid ipconfigSUPPORT_SIGNALS configuration
+#if ( ipconfigICMP_RATE_LIMIT_PER_SOURCE < 0 )
+    #error ipconfigICMP_RATE_LIMIT_PER_SOURCE must be at least 0
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_CALLBACKS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_CALLBACKS
- *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
- *
- * Advanced users only.
- *
- * Allows usage of application defined hooks for socket events.
- *
- * Can be set by calling FreeRTOS_setsockopt() with any of the following
- * options and a pointer to a F_TCP_UDP_Handler_t.
- *
- * FREERTOS_SO_TCP_CONN_HANDLER  * Callback for (dis)connection events. *
- * FREERTOS_SO_TCP_RECV_HANDLER  * Callback for receiving TCP data. *
- * FREERTOS_SO_TCP_SENT_HANDLER  * Callback for sending TCP data. *
- * FREERTOS_SO_UDP_RECV_HANDLER  * Callback for receiving UDP data. *
- * FREERTOS_SO_UDP_SENT_HANDLER  * Callback for sending UDP data. *
- *
- * typedef struct xTCP_UDP_HANDLER
- * {
- *      FOnConnected_t pxOnTCPConnected; * FREERTOS_SO_TCP_CONN_HANDLER *
- *      FOnTCPReceive_t pxOnTCPReceive;  * FREERTOS_SO_TCP_RECV_HANDLER *
- *      FOnTCPSent_t pxOnTCPSent;        * FREERTOS_SO_TCP_SENT_HANDLER *
- *      FOnUDPReceive_t pxOnUDPReceive;  * FREERTOS_SO_UDP_RECV_HANDLER *
- *      FOnUDPSent_t pxOnUDPSent;        * FREERTOS_SO_UDP_SENT_HANDLER *
- * } F_TCP_UDP_Handler_t
- *
- * Function Prototypes:
- *
- * typedef void (* FOnConnected_t )( Socket_t xSocket,
- *                                   BaseType_t ulConnected )
+ * ipconfigICMP_RATE_LIMIT_BURST
  *
- * typedef BaseType_t (* FOnTCPReceive_t )( Socket_t xSocket,
- *                                          void * pData,
- *                                          size_t xLength )
- *
- * typedef void (* FOnTCPSent_t )( Socket_t xSocket,
- *                                 size_t xLength )
- *
- * typedef BaseType_t (* FOnUDPReceive_t ) ( Socket_t xSocket,
- *                                           void * pData,
- *                                           size_t xLength,
- *                                           const struct freertos_sockaddr * pxFrom,
- *                                           const struct freertos_sockaddr * pxDest )
+ * Type: uint32_t
+ * Unit: messages
+ * Minimum: 1
  *
- * typedef void (* FOnUDPSent_t )( Socket_t xSocket,
- *                                      size_t xLength );
+ * The number of messages that a single host may get in a burst before
+ * ipconfigICMP_RATE_LIMIT_PER_SOURCE applies.
  */
 
-#ifndef ipconfigUSE_CALLBACKS
-    #define ipconfigUSE_CALLBACKS    ipconfigDISABLE
+#ifndef ipconfigICMP_RATE_LIMIT_BURST
+    #define ipconfigICMP_RATE_LIMIT_BURST    ( 5U )
 #endif
 
-#if ( ( ipconfigUSE_CALLBACKS != ipconfigDISABLE ) && ( ipconfigUSE_CALLBACKS != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_CALLBACKS configuration
+#if ( ipconfigICMP_RATE_LIMIT_BURST < 1 )
+    #error ipconfigICMP_RATE_LIMIT_BURST must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigIS_VALID_PROG_ADDRESS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigIS_VALID_PROG_ADDRESS
- *
- * Type: Macro Function
- * Value: BaseType_t ( pdTRUE | pdFALSE )
- *
- * Verifies that a given address refers to valid (instruction) memory.
+ * ipconfigICMP_RATE_LIMIT_SOURCES
  *
- * Used to check if application defined hooks are valid.
+ * Type: size_t
+ * Unit: count of source addresses
+ * Minimum: 1
  *
- * Example:
- * if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xTCP.pxHandleSent ) )
- * {
- *     pxSocket->u.xTCP.pxHandleSent( pxSocket, ulCount );
- * }
+ * The number of source addresses that have their own bucket, see
+ * ipconfigICMP_RATE_LIMIT_PER_SOURCE.  When all are in use, the bucket that
+ * was used the longest time ago is given to the new source.
  */
 
-#ifndef ipconfigIS_VALID_PROG_ADDRESS
-    #define ipconfigIS_VALID_PROG_ADDRESS( pxAddress )    ( ( pxAddress ) != NULL )
+#ifndef ipconfigICMP_RATE_LIMIT_SOURCES
+    #define ipconfigICMP_RATE_LIMIT_SOURCES    ( 8U )
+#endif
+
+#if ( ipconfigICMP_RATE_LIMIT_SOURCES < 1 )
+    #error ipconfigICMP_RATE_LIMIT_SOURCES must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * pvPortMallocSocket/vPortFreeSocket
+ * ipconfigSUPPORT_OUTGOING_PINGS
  *
- * Malloc functions specific to sockets.
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSUPPORT_OUTGOING_PINGS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for FreeRTOS_SendPingRequest() and
+ * FreeRTOS_SendPingRequestIPv6()
  */
 
-#ifndef pvPortMallocSocket
-    #define pvPortMallocSocket( size )    pvPortMalloc( size )
+#ifndef ipconfigSUPPORT_OUTGOING_PINGS
+    #define ipconfigSUPPORT_OUTGOING_PINGS    ipconfigDISABLE
 #endif
 
-#ifndef vPortFreeSocket
-    #define vPortFreeSocket( ptr )    vPortFree( ptr )
+#if ( ( ipconfigSUPPORT_OUTGOING_PINGS != ipconfigDISABLE ) && ( ipconfigSUPPORT_OUTGOING_PINGS != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_OUTGOING_PINGS configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*===========================================================================*/
-/*                              SOCKET CONFIG                                */
+/*                               ICMP CONFIG                                 */
 /*===========================================================================*/
 /*---------------------------------------------------------------------------*/
 /*===========================================================================*/
 /*---------------------------------------------------------------------------*/
 /*===========================================================================*/
-/*                               DHCP CONFIG                                 */
+/*                              ROUTING CONFIG                               */
 /*===========================================================================*/
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_DHCP
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_DHCP
+ * ipconfigCOMPATIBLE_WITH_SINGLE
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Allows DHCP to be enabled by setting by setting `endpoint->bits.bWantDHCP`.
- *
- * When successful, DHCP will assign an IP-address, a netmask, a gateway
- * address, and one or more DNS addresses to the endpoint. DHCP must be able to
- * receive an options field of 312 bytes, the fixed part of the DHCP packet is
- * 240 bytes, and the IP/UDP headers take 28 bytes.
+ * Retains compatibility with V3.x.x and older versions that only
+ * supported one interface.
  */
 
-#ifndef ipconfigUSE_DHCP
-    #define ipconfigUSE_DHCP    ipconfigENABLE
-#endif
-
-#if ( ( ipconfigUSE_DHCP != ipconfigDISABLE ) && ( ipconfigUSE_DHCP != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_DHCP configuration
+#ifndef ipconfigCOMPATIBLE_WITH_SINGLE
+    #define ipconfigCOMPATIBLE_WITH_SINGLE    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_DHCP != ipconfigDISABLE ) && ( ipconfigNETWORK_MTU < 586 ) )
-    #error ipconfigNETWORK_MTU needs to be at least 586 to use DHCP
+#if ( ( ipconfigCOMPATIBLE_WITH_SINGLE != ipconfigDISABLE ) && ( ipconfigCOMPATIBLE_WITH_SINGLE != ipconfigENABLE ) )
+    #error Invalid ipconfigCOMPATIBLE_WITH_SINGLE configuration
 #endif
 
-#if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP ) && ipconfigIS_DISABLED( ipconfigUSE_IPv4 ) )
-    #error DHCP Cannot be enabled without IPv4
-#endif
+/*---------------------------------------------------------------------------*/
 
+/*===========================================================================*/
+/*                              ROUTING CONFIG                               */
+/*===========================================================================*/
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_DHCPv6
+ * ipconfigUSE_ROUTE_CACHE
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Include support for DHCPv6.
+ * When enabled, the results of FreeRTOS_FindEndPointOnNetMask() and
+ * FreeRTOS_FindGateWay() are remembered, so that sending a packet does not
+ * walk the list of end-points each time. The destination cache has
+ * ipconfigROUTE_CACHE_ENTRIES slots, it also remembers that a destination is
+ * not on any local network, so that the packet must go to the gateway.
+ * FreeRTOS_FindEndPointOnNetMask_IPv6() and FreeRTOS_FindEndPointOnIP_IPv6()
+ * use an IPv6 prefix index of the same size, and received IPv6 packets find
+ * the end-point that owns their destination address through a hashed index
+ * of local addresses.
+ *
+ * The cache is flushed whenever end-points are added, go up or down, or their
+ * addresses are changed by the stack. An application that changes the
+ * ipv4_settings or ipv6_settings of an end-point directly must call
+ * FreeRTOS_RouteCacheInvalidate(). Has no effect when
+ * ipconfigCOMPATIBLE_WITH_SINGLE is enabled.
+ */
+
+#ifndef ipconfigUSE_ROUTE_CACHE
+    #define ipconfigUSE_ROUTE_CACHE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_ROUTE_CACHE != ipconfigDISABLE ) && ( ipconfigUSE_ROUTE_CACHE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_ROUTE_CACHE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigROUTE_CACHE_ENTRIES
  *
- * The use of DHCP can be enabled per endpoint by setting
- * `endpoint->bits.bWantDHCP`.
+ * Type: size_t
+ * Unit: count of destinations
+ * Minimum: 1
  *
- * An alternative way of obtaining an IP-address is Router Advertisement ("RA").
- * As RA is generally preferred above DHCP, ipconfigUSE_RA is enabled and
- * ipconfigUSE_DHCPv6 is disabled by default.
+ * The number of destinations remembered by the route cache, see
+ * ipconfigUSE_ROUTE_CACHE. The cache is direct-mapped, the value must be a
+ * power of two.
  */
 
-#ifndef ipconfigUSE_DHCPv6
-    #define ipconfigUSE_DHCPv6    ipconfigDISABLE
+#ifndef ipconfigROUTE_CACHE_ENTRIES
+    #define ipconfigROUTE_CACHE_ENTRIES    16U
 #endif
 
-#if ( ( ipconfigUSE_DHCPv6 != ipconfigDISABLE ) && ( ipconfigUSE_DHCPv6 != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_DHCPv6 configuration
+#if ( ipconfigROUTE_CACHE_ENTRIES < 1 )
+    #error ipconfigROUTE_CACHE_ENTRIES must be at least 1
 #endif
 
-#if ( ipconfigIS_ENABLED( ipconfigUSE_DHCPv6 ) && ipconfigIS_DISABLED( ipconfigUSE_IPv6 ) )
-    #error DHCPv6 Cannot be enabled without IPv6
+#if ( ( ipconfigROUTE_CACHE_ENTRIES & ( ipconfigROUTE_CACHE_ENTRIES - 1 ) ) != 0 )
+    #error ipconfigROUTE_CACHE_ENTRIES must be a power of two
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigDHCP_REGISTER_HOSTNAME
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDHCP_REGISTER_HOSTNAME
+ * ipconfigUSE_STATIC_ROUTES
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enables usage of an application defined hook to provide a hostname to a DHCP
- * server.
+ * When enabled, FreeRTOS_AddRoute() can be used to add explicit routes: a
+ * network prefix that is reached through a gateway on a given end-point, or
+ * directly on the link when no gateway is given. The same prefix may have
+ * several routes; the one with the lowest metric whose end-point is up is
+ * used.
+ *
+ * Static routes are consulted for destinations that are not on the network
+ * of any end-point, before falling back to the default gateway. The longest
+ * matching prefix wins. The routes are kept in a path-compressed binary trie,
+ * so a lookup visits at most 33 (IPv4) or 129 (IPv6) nodes, however many
+ * routes there are. Has no effect when ipconfigCOMPATIBLE_WITH_SINGLE is
+ * enabled.
+ */
+
+#ifndef ipconfigUSE_STATIC_ROUTES
+    #define ipconfigUSE_STATIC_ROUTES    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_STATIC_ROUTES != ipconfigDISABLE ) && ( ipconfigUSE_STATIC_ROUTES != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_STATIC_ROUTES configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigMAX_STATIC_ROUTES
  *
- * Function prototype:
+ * Type: size_t
+ * Unit: count of routes
+ * Minimum: 1
+ * Maximum: 32767
  *
- * const char *pcApplicationHostnameHook( void )
+ * The maximum number of static routes, IPv4 and IPv6 together, see
+ * ipconfigUSE_STATIC_ROUTES. Memory for the routes and for twice as many
+ * trie nodes is allocated statically.
  */
 
-#ifndef ipconfigDHCP_REGISTER_HOSTNAME
-    #define ipconfigDHCP_REGISTER_HOSTNAME    ipconfigDISABLE
+#ifndef ipconfigMAX_STATIC_ROUTES
+    #define ipconfigMAX_STATIC_ROUTES    8U
 #endif
 
-#if ( ( ipconfigDHCP_REGISTER_HOSTNAME != ipconfigDISABLE ) && ( ipconfigDHCP_REGISTER_HOSTNAME != ipconfigENABLE ) )
-    #error Invalid ipconfigDHCP_REGISTER_HOSTNAME configuration
+#if ( ipconfigMAX_STATIC_ROUTES < 1 )
+    #error ipconfigMAX_STATIC_ROUTES must be at least 1
+#endif
+
+#if ( ipconfigMAX_STATIC_ROUTES > 32767 )
+    #error ipconfigMAX_STATIC_ROUTES overflows a uint16_t node index
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_DHCP_HOOK
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_DHCP_HOOK
+ * ipconfigUSE_ROUTE_ECMP
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enables usage of an application defined hook during the DHCP process before
- * the initial discovery packet is sent, and after a DHCP offer has been
- * received.
- *
- * Function Prototype:
- *
- * Function prototype if ipconfigIPv4_BACKWARD_COMPATIBLE is enabled:
- *
- * eDHCPCallbackAnswer_t xApplicationDHCPHook( eDHCPCallbackPhase_t eDHCPPhase,
- *                                             uint32_t ulIPAddress )
+ * When enabled, traffic to remote destinations is spread over all end-points
+ * that have a gateway and that are up, rather than always using the first
+ * one. The same applies to static routes for the same prefix that have the
+ * lowest metric. A path is chosen by hashing the destination address, so all
+ * packets to one destination, and therefore every TCP connection, stay on the
+ * same uplink. When an uplink goes down, only the destinations that used it
+ * move to another one. Has no effect when ipconfigCOMPATIBLE_WITH_SINGLE is
+ * enabled.
+ */
+
+#ifndef ipconfigUSE_ROUTE_ECMP
+    #define ipconfigUSE_ROUTE_ECMP    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_ROUTE_ECMP != ipconfigDISABLE ) && ( ipconfigUSE_ROUTE_ECMP != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_ROUTE_ECMP configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_IP_FORWARDING
  *
- * Function prototype by default:
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * eDHCPCallbackAnswer_t xApplicationDHCPHook_Multi( eDHCPCallbackPhase_t eDHCPPhase,
- *                                                   struct xNetworkEndPoint * pxEndPoint,
- *                                                   IP_Address_t * pxIPAddress );
+ * When enabled, the IP-task forwards a unicast IPv4 packet that is sent to
+ * the MAC address of an end-point, but not to one of its IP addresses. The
+ * packet is sent through the end-point that leads to its destination, as
+ * found by the ARP cache, the static routes and the gateways. The TTL is
+ * decremented and the IP-header checksum is adjusted incrementally; the
+ * packet does not reach the sockets.
+ *
+ * A packet of which the TTL expires, that has no route, or that is too
+ * large for the MTU of the outgoing interface is dropped and counted as
+ * eDropNoRoute. No ICMP error is sent and packets are never fragmented.
+ * While the next hop is not yet in the ARP cache, the packet is dropped and
+ * an ARP request is sent.
  */
 
-#ifndef ipconfigUSE_DHCP_HOOK
-    #define ipconfigUSE_DHCP_HOOK    ipconfigENABLE
+#ifndef ipconfigUSE_IP_FORWARDING
+    #define ipconfigUSE_IP_FORWARDING    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_DHCP_HOOK != ipconfigDISABLE ) && ( ipconfigUSE_DHCP_HOOK != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_DHCP_HOOK configuration
+#if ( ( ipconfigUSE_IP_FORWARDING != ipconfigDISABLE ) && ( ipconfigUSE_IP_FORWARDING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_IP_FORWARDING configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_IP_FORWARDING ) && ipconfigIS_DISABLED( ipconfigUSE_IPv4 ) )
+    #error ipconfigUSE_IP_FORWARDING requires ipconfigUSE_IPv4
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigDHCP_FALL_BACK_AUTO_IP
+ * ipconfigUSE_NAPT
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * If no DHCP server responds, allocate a random LinkLayer IP address.
+ * When enabled, FreeRTOS_SetNAPTEndPoint() selects an IPv4 end-point whose
+ * address is shared by the hosts behind the other end-points. A TCP or UDP
+ * packet, or an ICMP echo request, that is forwarded through that end-point
+ * gets its address and a port in the range 32768 .. 32768 +
+ * ipconfigNAPT_ENTRIES - 1, which must not be used by local sockets. The
+ * replies are translated back and forwarded to the inside host. Addresses
+ * and ports are replaced in place and the checksums are adjusted
+ * incrementally, so the payload is never copied.
+ *
+ * Fragmented packets and other protocols are not translated and therefore
+ * dropped. ICMP error messages about translated connections are not passed
+ * to the inside host.
+ */
+
+#ifndef ipconfigUSE_NAPT
+    #define ipconfigUSE_NAPT    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_NAPT != ipconfigDISABLE ) && ( ipconfigUSE_NAPT != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NAPT configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_NAPT ) && ipconfigIS_DISABLED( ipconfigUSE_IP_FORWARDING ) )
+    #error ipconfigUSE_NAPT requires ipconfigUSE_IP_FORWARDING
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigNAPT_ENTRIES
  *
- * Requires ipconfigARP_USE_CLASH_DETECTION to be enabled as well in order to
- * test if it is still available.
+ * Type: size_t
+ * Unit: translations
+ * Minimum: 1
+ * Maximum: 16384
  *
- * An alternative is to resort to a static IP address.
+ * The size of the statically allocated translation table of
+ * ipconfigUSE_NAPT. Every TCP connection, UDP flow and ping session between
+ * an inside host and a remote host uses one entry. When the table is full,
+ * new connections are dropped until an entry expires.
  */
 
-#ifndef ipconfigDHCP_FALL_BACK_AUTO_IP
-    #define ipconfigDHCP_FALL_BACK_AUTO_IP    ipconfigDISABLE
+#ifndef ipconfigNAPT_ENTRIES
+    #define ipconfigNAPT_ENTRIES    64U
 #endif
 
-#if ( ( ipconfigDHCP_FALL_BACK_AUTO_IP != ipconfigDISABLE ) && ( ipconfigDHCP_FALL_BACK_AUTO_IP != ipconfigENABLE ) )
-    #error Invalid ipconfigDHCP_FALL_BACK_AUTO_IP configuration
+#if ( ( ipconfigNAPT_ENTRIES < 1 ) || ( ipconfigNAPT_ENTRIES > 16384 ) )
+    #error ipconfigNAPT_ENTRIES must be at least 1 and at most 16384
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigMAXIMUM_DISCOVER_TX_PERIOD
+ * ipconfigNAPT_TCP_TIMEOUT_SECONDS
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigMAXIMUM_DISCOVER_TX_PERIOD
- *
- * Type: TickType_t
- * Unit: Ticks
- * Minimum: 0
- * Maximum: portMAX_DELAY
+ * Type: uint32_t
+ * Unit: seconds
+ * Minimum: 1
  *
- * Sets the max interval allowed between transmissions of DHCP requests before
- * the default IP address will be used.
+ * The time after which an idle TCP translation of ipconfigUSE_NAPT expires.
+ * The default is the 2 hours and 4 minutes of RFC 5382. Once a FIN or RST
+ * has been seen, an entry expires after 4 minutes.
+ */
+
+#ifndef ipconfigNAPT_TCP_TIMEOUT_SECONDS
+    #define ipconfigNAPT_TCP_TIMEOUT_SECONDS    7440U
+#endif
+
+#if ( ipconfigNAPT_TCP_TIMEOUT_SECONDS < 1 )
+    #error ipconfigNAPT_TCP_TIMEOUT_SECONDS must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigNAPT_UDP_TIMEOUT_SECONDS
  *
- * When 'endpoint->bits.bWantDHCP' is set, DHCP requests will be sent out at
- * increasing time intervals until either a reply is received from a DHCP
- * server and accepted, or the interval between transmissions reaches
- * ipconfigMAXIMUM_DISCOVER_TX_PERIOD. If no reply is received, the TCP/IP
- * stack will revert to using the default IP address of the endpoint
- * 'endpoint->ipv4_defaults.ulIPAddress' for IPv4 address or
- * 'endpoint->ipv6_defaults.xIPAddress' for IPv6 address.
+ * Type: uint32_t
+ * Unit: seconds
+ * Minimum: 1
+ *
+ * The time after which an idle UDP or ICMP translation of ipconfigUSE_NAPT
+ * expires. RFC 4787 asks for at least 2 minutes.
  */
 
-#ifndef ipconfigMAXIMUM_DISCOVER_TX_PERIOD
-    #ifdef _WINDOWS_
-        #define ipconfigMAXIMUM_DISCOVER_TX_PERIOD    pdMS_TO_TICKS( 999 )
-    #else
-        #define ipconfigMAXIMUM_DISCOVER_TX_PERIOD    pdMS_TO_TICKS( 30000 )
-    #endif
+#ifndef ipconfigNAPT_UDP_TIMEOUT_SECONDS
+    #define ipconfigNAPT_UDP_TIMEOUT_SECONDS    120U
 #endif
 
-STATIC_ASSERT( ipconfigMAXIMUM_DISCOVER_TX_PERIOD <= portMAX_DELAY );
+#if ( ipconfigNAPT_UDP_TIMEOUT_SECONDS < 1 )
+    #error ipconfigNAPT_UDP_TIMEOUT_SECONDS must be at least 1
+#endif
 
 /*---------------------------------------------------------------------------*/
 
-/*===========================================================================*/
-/*                               DHCP CONFIG                                 */
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*                                DNS CONFIG                                 */
-/*===========================================================================*/
+/*
+ * ipconfigUSE_VLAN
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, FreeRTOS_FillVLANInterface() creates a virtual interface
+ * that carries the 802.1Q-tagged traffic of one VLAN over a physical
+ * interface. End-points are bound to the virtual interface as usual. The
+ * IP-task assigns a received tagged frame to the virtual interface of its
+ * VLAN ID before anything else looks at it; untagged frames remain with the
+ * physical interface. Frames with an unknown VLAN ID are dropped.
+ *
+ * A driver that sets 'bits.bVLANTagOffload' in its interface lets the
+ * hardware insert and strip the tags: it reports a stripped tag in the field
+ * 'usVLANTag' of the network buffer, and inserts the tag found in that field
+ * when it is non-zero. Without offload, the stack inserts and removes the
+ * 4-byte tag in software, which moves the frame within its buffer.
+ *
+ * ipconfigCOMPATIBLE_WITH_SINGLE allows only one interface, which leaves no
+ * room for VLAN interfaces: all tagged frames are dropped then.
+ */
+
+#ifndef ipconfigUSE_VLAN
+    #define ipconfigUSE_VLAN    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_VLAN != ipconfigDISABLE ) && ( ipconfigUSE_VLAN != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_VLAN configuration
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_DNS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_DNS
+ * ipconfigUSE_NETWORK_TIMESTAMPS
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enable ipconfigUSE_DNS to include a basic DNS client/resolver. DNS is used
- * through functions like FreeRTOS_getaddrinfo() and FreeRTOS_gethostbyname().
+ * Add a time-stamp to every network buffer. A driver whose MAC can record
+ * the time at which a frame was received stores it in 'xTimestamp' before
+ * passing the buffer to the IP-task. The time-stamp of a UDP datagram is
+ * returned by FreeRTOS_recvmmsg(), or by FreeRTOS_GetUDPPayloadTimestamp()
+ * for a payload received with FREERTOS_ZERO_COPY.
  *
- * Allows name discovery protocols like mDNS, LLMNR and NBNS to be enabled as
- * well.
+ * When a UDP socket has set FREERTOS_SO_TIMESTAMPING, its outgoing frames
+ * have 'ucTxTimestamp' set. Once such a frame has been sent, the driver
+ * calls vNetworkBufferTxTimestamp(), and the application reads the time
+ * with FreeRTOS_getsockopt( FREERTOS_SO_TIMESTAMP_TX ).
  *
- * See: ipconfigUSE_MDNS, ipconfigUSE_LLMNR, ipconfigUSE_NBNS
+ * The clock and its epoch are those of the driver. A zero time-stamp means
+ * that it is not known.
  */
 
-#ifndef ipconfigUSE_DNS
-    #define ipconfigUSE_DNS    ipconfigENABLE
+#ifndef ipconfigUSE_NETWORK_TIMESTAMPS
+    #define ipconfigUSE_NETWORK_TIMESTAMPS    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_DNS != ipconfigDISABLE ) && ( ipconfigUSE_DNS != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_DNS configuration
+#if ( ( ipconfigUSE_NETWORK_TIMESTAMPS != ipconfigDISABLE ) && ( ipconfigUSE_NETWORK_TIMESTAMPS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NETWORK_TIMESTAMPS configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_DNS_CACHE
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_DNS_CACHE
+ * ipconfigUSE_NETWORK_EMULATION
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enables usage of the DNS cache.
+ * When enabled, FreeRTOS_NetEmAttach() attaches a network emulator to an
+ * interface, e.g. the loopback or the Linux interface. The emulator holds
+ * the outgoing and the incoming frames for a while, to impose a delay,
+ * jitter, a limited bandwidth, loss, duplication and reordering, as set by
+ * FreeRTOS_NetEmSetParameters(). The random decisions depend on a seed only,
+ * so that the behaviour of congestion control, SACK and retransmissions can
+ * be measured under conditions that can be repeated.
+ *
+ * The emulator replaces the pfOutput() and pfPoll() functions of the
+ * interface, and it has a task that lets the IP-task deliver the frames
+ * when they are due. Attach it after the driver has filled in the interface.
+ * It is meant for testing, not for production code.
  */
 
-#ifndef ipconfigUSE_DNS_CACHE
-    #define ipconfigUSE_DNS_CACHE    ipconfigENABLE
+#ifndef ipconfigUSE_NETWORK_EMULATION
+    #define ipconfigUSE_NETWORK_EMULATION    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_DNS_CACHE != ipconfigDISABLE ) && ( ipconfigUSE_DNS_CACHE != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_DNS_CACHE configuration
+#if ( ( ipconfigUSE_NETWORK_EMULATION != ipconfigDISABLE ) && ( ipconfigUSE_NETWORK_EMULATION != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NETWORK_EMULATION configuration
+#endif
+
+#if ( ( ipconfigUSE_NETWORK_EMULATION != 0 ) && ( ipconfigUSE_NETWORK_INTERFACE_POLL == 0 ) )
+    #error ipconfigUSE_NETWORK_EMULATION requires ipconfigUSE_NETWORK_INTERFACE_POLL
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigDNS_CACHE_ENTRIES
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_CACHE_ENTRIES
+ * ipconfigNETWORK_EMULATION_QUEUE_LENGTH
  *
  * Type: size_t
- * Unit: count of DNS cache entries
+ * Unit: count of network buffers
  * Minimum: 1
  *
- * Defines the number of entries in the DNS cache.
+ * The number of frames that a network emulator can hold, in both directions
+ * together, see ipconfigUSE_NETWORK_EMULATION. A frame that does not fit is
+ * dropped, as a router with a full queue would do. Every frame held occupies
+ * a network buffer.
  */
 
-#ifndef ipconfigDNS_CACHE_ENTRIES
-    #define ipconfigDNS_CACHE_ENTRIES    ( 1U )
-#endif
-
-#if ( ipconfigDNS_CACHE_ENTRIES < 1 )
-    #error ipconfigDNS_CACHE_ENTRIES must be at least 1
+#ifndef ipconfigNETWORK_EMULATION_QUEUE_LENGTH
+    #define ipconfigNETWORK_EMULATION_QUEUE_LENGTH    32U
 #endif
 
-#if ( ipconfigDNS_CACHE_ENTRIES > SIZE_MAX )
-    #error ipconfigDNS_CACHE_ENTRIES overflows a size_t
+#if ( ipconfigNETWORK_EMULATION_QUEUE_LENGTH < 1 )
+    #error ipconfigNETWORK_EMULATION_QUEUE_LENGTH must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigDNS_CACHE_NAME_LENGTH
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_CACHE_NAME_LENGTH
- *
- * Type: size_t
- * Unit: count of hostname chars
- * Minimum: 1
+ * ipconfigUSE_LINK_BONDING
  *
- * The maximum number of characters a DNS host name can take, including
- * the NULL terminator.
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Stack warning: the function DNS_ParseDNSReply() declares a local object
- * of type 'ParseSet_t', which contains a copy of an URL:
+ * When enabled, FreeRTOS_FillBondInterface() creates a virtual interface
+ * that combines several physical interfaces, its members, into one link
+ * with a single MAC address. End-points are bound to the bond only. Frames
+ * received by any member are handled as if the bond received them. Every
+ * outgoing frame is sent by one of the members that are up, chosen by a
+ * hash of its addresses and ports, so the packets of one connection are
+ * never reordered. When a member goes down, its connections move to the
+ * remaining members; the bond goes down when the last member goes down.
  *
- *     char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ];
+ * This is a static ( balance-xor ) aggregation: the switch ports must be
+ * configured as a static link aggregation group, LACP is not supported.
  *
- * plus another 52 bytes.
+ * ipconfigCOMPATIBLE_WITH_SINGLE allows only one interface, which leaves no
+ * room for a bond and its members.
  */
 
-#ifndef ipconfigDNS_CACHE_NAME_LENGTH
-    #define ipconfigDNS_CACHE_NAME_LENGTH    ( 254U )
+#ifndef ipconfigUSE_LINK_BONDING
+    #define ipconfigUSE_LINK_BONDING    ipconfigDISABLE
 #endif
 
-#if ( ipconfigDNS_CACHE_NAME_LENGTH < 1 )
-    #error ipconfigDNS_CACHE_NAME_LENGTH must be at least 1
+#if ( ( ipconfigUSE_LINK_BONDING != ipconfigDISABLE ) && ( ipconfigUSE_LINK_BONDING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_LINK_BONDING configuration
 #endif
 
-#if ( ipconfigDNS_CACHE_NAME_LENGTH > SIZE_MAX )
-    #error ipconfigDNS_CACHE_NAME_LENGTH overflows a size_t
-#endif
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*---------------------------------------------------------------------------*/
+/*===========================================================================*/
+/*                        DEBUG/TRACE/LOGGING CONFIG                         */
+/*===========================================================================*/
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY
+ * ipconfigCHECK_IP_QUEUE_SPACE
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigCHECK_IP_QUEUE_SPACE
  *
- * Type: size_t
- * Unit: count of IP addresses
- * Minimum: 1
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Sets how many IP addresses can be stored when looking up a URL.
+ * Enables the IP-Task to track the run-time minimum free space that has
+ * existed in the event queue (uxQueueMinimumSpace). This value can be
+ * retrieved using the function uxGetMinimumIPQueueSpace().
+ *
+ * Enables vPrintResourceStats() to log warnings about shrinking queue space.
+ *
+ * ipconfigUSE_IP_TASK_STATS records the same high-water mark, together with
+ * how long events wait in the queue and how long they take to handle.
+ *
+ * See ipconfigEVENT_QUEUE_LENGTH for setting the length of the event queue.
  */
 
-#ifndef ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY
-    #define ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY    ( 1 )
-#endif
-
-#if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY < 1 )
-    #error ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY must be at least 1
+#ifndef ipconfigCHECK_IP_QUEUE_SPACE
+    #define ipconfigCHECK_IP_QUEUE_SPACE    ipconfigDISABLE
 #endif
 
-#if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > SIZE_MAX )
-    #error ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY overflows a size_t
+#if ( ( ipconfigCHECK_IP_QUEUE_SPACE != ipconfigDISABLE ) && ( ipconfigCHECK_IP_QUEUE_SPACE != ipconfigENABLE ) )
+    #error Invalid ipconfigCHECK_IP_QUEUE_SPACE configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigDNS_REQUEST_ATTEMPTS
+ * ipconfigHAS_DEBUG_PRINTF
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_REQUEST_ATTEMPTS
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigHAS_DEBUG_PRINTF
  *
- * Type: size_t
- * Unit: count of request attempts
- * Minimum: 1
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Sets the most amount of times the library can send a DNS result and wait for
- * a result when looking up a host.
+ * ipconfigHAS_DEBUG_PRINTF enables usage of the macro FreeRTOS_debug_printf to
+ * generate output messages mostly from the TCP/IP stack.
  *
- * See ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS & ipconfigDNS_SEND_BLOCK_TIME_TICKS
+ * Requires a reentrant application defined macro function
+ * FreeRTOS_debug_printf with a return value that is ignored.
+ *
+ * The FreeRTOS_debug_printf() must be thread-safe but does not
+ * have to be interrupt-safe.
+ *
+ * Example:
+ *
+ * void vLoggingPrintf( const char *pcFormatString, ... )
+ *
+ * #define ipconfigHAS_DEBUG_PRINTF    ipconfigENABLE
+ * #define FreeRTOS_debug_printf( X )  if( ipconfigIS_ENABLED( ipconfigHAS_DEBUG_PRINTF ) vLoggingPrintf X
+ *
+ * FreeRTOS_debug_printf( ( "FunctionName: Failed with error code: %u\n", xErrorCode ) )
  */
 
-#ifndef ipconfigDNS_REQUEST_ATTEMPTS
-    #define ipconfigDNS_REQUEST_ATTEMPTS    ( 5 )
+#ifndef ipconfigHAS_DEBUG_PRINTF
+    #define ipconfigHAS_DEBUG_PRINTF    ipconfigDISABLE
 #endif
 
-#if ( ipconfigDNS_REQUEST_ATTEMPTS < 1 )
-    #error ipconfigDNS_REQUEST_ATTEMPTS must be at least 1
+#if ( ( ipconfigHAS_DEBUG_PRINTF != ipconfigDISABLE ) && ( ipconfigHAS_DEBUG_PRINTF != ipconfigENABLE ) )
+    #error Invalid ipconfigHAS_DEBUG_PRINTF configuration
 #endif
 
-#if ( ipconfigDNS_REQUEST_ATTEMPTS > SIZE_MAX )
-    #error ipconfigDNS_REQUEST_ATTEMPTS overflows a size_t
+#ifndef FreeRTOS_debug_printf
+    #if ( ( ipconfigHAS_DEBUG_PRINTF == 1 ) && defined( configPRINTF ) )
+        #define FreeRTOS_debug_printf( MSG )    do { configPRINTF( MSG ); } while( ipFALSE_BOOL )
+    #else
+        #define FreeRTOS_debug_printf( MSG )    do {} while( ipFALSE_BOOL )
+    #endif
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS
+ * ipconfigHAS_PRINTF
  *
- * Type: TickType_t
- * Unit: Ticks
- * Minimum: 0
- * Maximum: portMAX_DELAY
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigHAS_PRINTF
  *
- * When looking up a host with DNS, this macro determines how long the
- * call to FreeRTOS_sendto() will wait for a reply. When there is no
- * reply, the request will be repeated up to 'ipconfigDNS_REQUEST_ATTEMPTS'
- * attempts.
- * See ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Applies to DNS socket only.
+ * ipconfigHAS_PRINTF enables usage of the macro FreeRTOS_printf to
+ * generate output messages mostly from TCP/IP stack demo applications.
+ *
+ * Requires a reentrant application defined macro function FreeRTOS_printf with
+ * a return value that is ignored.
+ *
+ * The FreeRTOS_printf() must be thread-safe but does not have to be interrupt-safe.
+ *
+ * See ipconfigHAS_DEBUG_PRINTF
  */
 
-#ifndef ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS
-    #define ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS    pdMS_TO_TICKS( 5000 )
+#ifndef ipconfigHAS_PRINTF
+    #define ipconfigHAS_PRINTF    ipconfigDISABLE
 #endif
 
-STATIC_ASSERT( ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS <= portMAX_DELAY );
+#if ( ( ipconfigHAS_PRINTF != ipconfigDISABLE ) && ( ipconfigHAS_PRINTF != ipconfigENABLE ) )
+    #error Invalid ipconfigHAS_PRINTF configuration
+#endif
+
+#ifndef FreeRTOS_printf
+    #if ( ( ipconfigHAS_PRINTF == 1 ) && defined( configPRINTF ) )
+        #define FreeRTOS_printf( MSG )    do { configPRINTF( MSG ); } while( ipFALSE_BOOL )
+    #else
+        #define FreeRTOS_printf( MSG )    do {} while( ipFALSE_BOOL )
+    #endif
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigDNS_SEND_BLOCK_TIME_TICKS
+ * ipconfigTCP_IP_SANITY
  *
- * Type: TickType_t
- * Unit: Ticks
- * Minimum: 0
- * Maximum: portMAX_DELAY
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_IP_SANITY
  *
- * When looking up a host with DNS, this macro determines how long the
- * call to FreeRTOS_sendto() will block to wait for a free buffer.
- * See ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Applies to DNS socket only.
+ * Enables warnings when irregularities are detected when using
+ * BufferAllocation_1.c.
  */
 
-#ifndef ipconfigDNS_SEND_BLOCK_TIME_TICKS
-    #define ipconfigDNS_SEND_BLOCK_TIME_TICKS    pdMS_TO_TICKS( 500 )
+#ifndef ipconfigTCP_IP_SANITY
+    #define ipconfigTCP_IP_SANITY    ipconfigDISABLE
 #endif
 
-STATIC_ASSERT( ipconfigDNS_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
+#if ( ( ipconfigTCP_IP_SANITY != ipconfigDISABLE ) && ( ipconfigTCP_IP_SANITY != ipconfigENABLE ) )
+    #error Invalid ipconfigTCP_IP_SANITY configuration
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigDNS_USE_CALLBACKS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigDNS_USE_CALLBACKS
- *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * ipconfigTCP_MAY_LOG_PORT
  *
- * Enables callback functionality in the DNS process.
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_MAY_LOG_PORT
  *
- * Application defined callbacks can be provided as parameters in calls
- * to FreeRTOS_gethostbyname_a() & FreeRTOS_getaddrinfo_a(). These functions
- * will start a DNS-lookup and call the callback when either the URL has been
- * found, or when a time-out has been reached. These functions are
- * non-blocking, the suffix "_a" stands for asynchronous. The callback can be
- * canceled by using FreeRTOS_gethostbyname_cancel().
+ * Type: Macro Function
  *
- * Function Prototype:
+ * Specifies which port numbers should be logged by FreeRTOS_debug_printf().
+ * The return value should be a BaseType_t ( pdFALSE | pdTRUE )
+ * For example, the following definition will not generate log messages for
+ * ports 23 or 2402:
  *
- * void (* FOnDNSEvent ) ( const char * pcName, void * pvSearchID, struct freertos_addrinfo * pxAddressInfo )
+ * #define ipconfigTCP_MAY_LOG_PORT( xPort ) ( ( ( xPort ) != 23 ) && ( ( xPort ) != 2402 ) )
  */
 
-#ifndef ipconfigDNS_USE_CALLBACKS
-    #define ipconfigDNS_USE_CALLBACKS    ipconfigDISABLE
+#ifndef ipconfigTCP_MAY_LOG_PORT
+    #define ipconfigTCP_MAY_LOG_PORT( xPort )    ( ( xPort ) != 23U )
 #endif
 
-#if ( ( ipconfigDNS_USE_CALLBACKS != ipconfigDISABLE ) && ( ipconfigDNS_USE_CALLBACKS != ipconfigENABLE ) )
-    #error Invalid ipconfigDNS_USE_CALLBACKS configuration
+#if ( ( ipconfigTCP_MAY_LOG_PORT( 0 ) != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( 0 ) != 1 ) )
+    #error ipconfigTCP_MAY_LOG_PORT() should equate to pdFALSE or pdTRUE
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_LLMNR
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_LLMNR
+ * ipconfigUSE_TCP_WIN_EVENT_LOG
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Include support for Link Local Multicast Name Resolution (LLMNR).
+ * When enabled, the sliding window of every TCP connection keeps a small
+ * binary log of its most recent events: segments sent and retransmitted,
+ * ACK's and SACK's received, retransmission time-outs, round-trip time samples
+ * and changes of the peer's window, each with a sequence number and a time
+ * stamp. Unlike the logging of xTCPWindowLoggingLevel, writing an event only
+ * costs a few stores, so it can be left enabled while chasing retransmissions.
+ * The log is read with the socket option FREERTOS_SO_TCP_WIN_EVENT_LOG, and
+ * tools/tcp_utilities/tcp_win_event_log_decode.py turns a saved copy into a
+ * time-sequence graph.
  */
 
-#ifndef ipconfigUSE_LLMNR
-    #define ipconfigUSE_LLMNR    ipconfigDISABLE
+#ifndef ipconfigUSE_TCP_WIN_EVENT_LOG
+    #define ipconfigUSE_TCP_WIN_EVENT_LOG    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_LLMNR != ipconfigDISABLE ) && ( ipconfigUSE_LLMNR != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_LLMNR configuration
+#if ( ( ipconfigUSE_TCP_WIN_EVENT_LOG != ipconfigDISABLE ) && ( ipconfigUSE_TCP_WIN_EVENT_LOG != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_WIN_EVENT_LOG configuration
 #endif
 
-#if ( ipconfigIS_ENABLED( ipconfigUSE_LLMNR ) && ipconfigIS_DISABLED( ipconfigUSE_DNS ) )
-    #error When LLMNR is enabled, ipconfigUSE_DNS must also be enabled
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_WIN_EVENT_LOG ) && ipconfigIS_DISABLED( ipconfigUSE_TCP_WIN ) )
+    #error ipconfigUSE_TCP_WIN_EVENT_LOG requires ipconfigUSE_TCP_WIN
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_NBNS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_NBNS
+ * ipconfigTCP_WIN_EVENT_LOG_ENTRIES
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: size_t
+ * Unit: count of 16-byte events per TCP socket
+ * Minimum: 2
  *
- * Include support for NetBIOS Name Service (NBNS).
+ * The size of the event log of ipconfigUSE_TCP_WIN_EVENT_LOG. It must be a
+ * power of two. When the log is full, the oldest events are overwritten.
  */
 
-#ifndef ipconfigUSE_NBNS
-    #define ipconfigUSE_NBNS    ipconfigDISABLE
+#ifndef ipconfigTCP_WIN_EVENT_LOG_ENTRIES
+    #define ipconfigTCP_WIN_EVENT_LOG_ENTRIES    ( 64 )
 #endif
 
-#if ( ( ipconfigUSE_NBNS != ipconfigDISABLE ) && ( ipconfigUSE_NBNS != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_NBNS configuration
+#if ( ipconfigTCP_WIN_EVENT_LOG_ENTRIES < 2 )
+    #error ipconfigTCP_WIN_EVENT_LOG_ENTRIES must be at least 2
 #endif
 
-#if ( ipconfigIS_ENABLED( ipconfigUSE_NBNS ) && ipconfigIS_DISABLED( ipconfigUSE_DNS ) )
-    #error When NBNS is enabled, ipconfigUSE_DNS must also be enabled
+#if ( ( ipconfigTCP_WIN_EVENT_LOG_ENTRIES & ( ipconfigTCP_WIN_EVENT_LOG_ENTRIES - 1 ) ) != 0 )
+    #error ipconfigTCP_WIN_EVENT_LOG_ENTRIES must be a power of two
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_MDNS
+ * ipconfigTCP_WIN_EVENT_LOG_TIME_US
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: Macro Function
+ * Unit: microseconds
  *
- * Include support for Multicast DNS (MDNS).
+ * Returns the 32-bit time stamp of the events of ipconfigUSE_TCP_WIN_EVENT_LOG.
+ * It is only called from the IP-task. The default has the resolution of a
+ * clock tick, a hardware timer gives more detail on fast networks.
  */
 
-#ifndef ipconfigUSE_MDNS
-    #define ipconfigUSE_MDNS    ipconfigDISABLE
-#endif
-
-#if ( ( ipconfigUSE_MDNS != ipconfigDISABLE ) && ( ipconfigUSE_MDNS != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_MDNS configuration
-#endif
-
-#if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ipconfigIS_DISABLED( ipconfigUSE_DNS ) )
-    #error When MDNS is enabled, ipconfigUSE_DNS must also be enabled
+#ifndef ipconfigTCP_WIN_EVENT_LOG_TIME_US
+    #define ipconfigTCP_WIN_EVENT_LOG_TIME_US() \
+    ( ( uint32_t ) ( ( ( uint64_t ) xTaskGetTickCount() * 1000000U ) / configTICK_RATE_HZ ) )
 #endif
 
 /*---------------------------------------------------------------------------*/
 
-/*===========================================================================*/
-/*                                DNS CONFIG                                 */
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*                                ARP CONFIG                                 */
-/*===========================================================================*/
-
-/*---------------------------------------------------------------------------*/
-
 /*
- * ipconfigARP_CACHE_ENTRIES
+ * ipconfigWATCHDOG_TIMER
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigARP_CACHE_ENTRIES
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigWATCHDOG_TIMER
  *
- * Type: size_t
- * Unit: count of arp cache entries
- * Minimum: 1
+ * Type: Macro Function
  *
- * Defines the maximum number of entries that can exist in the ARP table at any
- * one time.
+ * Macro that is called on each iteration of the IP task.
  *
- * The ARP cache is a table that maps IP addresses to MAC addresses. The IP
- * stack can only send a UDP message to a remove IP address if it knowns
- * the MAC address associated with the IP address, or the MAC address of the
- * router used to contact the remote IP address. When a UDP message is received
- * from a remote IP address, the MAC address and IP address are added to the
- * ARP cache. When a UDP message is sent to a remote IP address that does not
- * already appear in the ARP cache, then the UDP message is replaced by a ARP
- * message that solicits the required MAC address information.
+ * May be useful if the application includes watchdog type functionality that
+ * needs to know that the IP task is still cycling (although the fact that the
+ * IP task is cycling does not necessarily indicate it is functioning
+ * correctly). The return value is ignored.
  */
 
-#ifndef ipconfigARP_CACHE_ENTRIES
-    #define ipconfigARP_CACHE_ENTRIES    ( 10 )
-#endif
-
-#if ( ipconfigARP_CACHE_ENTRIES < 1 )
-    #error ipconfigARP_CACHE_ENTRIES must be at least 1
-#endif
-
-#if ( ipconfigARP_CACHE_ENTRIES > SIZE_MAX )
-    #error ipconfigARP_CACHE_ENTRIES overflows a size_t
+#ifndef ipconfigWATCHDOG_TIMER
+    #define ipconfigWATCHDOG_TIMER()    do {} while( ipFALSE_BOOL )
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigARP_STORES_REMOTE_ADDRESSES
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigARP_STORES_REMOTE_ADDRESSES
+ * ipconfigUSE_DUMP_PACKETS
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Advanced users only.
+ * See this utility: tools/tcp_utilities/tcp_dump_packets.md
  *
- * Normally, the ARP table will only store IP-addresses that are located
- * in the local subnet. This macro enables the storage of remote addresses
- * in the ARP table along with the associated MAC address from which the
- * message was received.
+ * Allow inclusion of a utility that writes of network packets to files.
  *
- * Provided for the case when a message that requires a reply arrives from the
- * Internet, but from a computer attached to a LAN rather than via the defined
- * gateway. Before replying to the message, the TCP/IP stack RTOS task will
- * loop up the message's IP address in the ARP table. If disabled then ARP will
- * return the MAC address of the defined gateway because the destination
- * address is outside of the netmask, which might prevent the reply reaching
- * its intended destination. This macro can allow the message in this scenario
- * to be routed and delivered correctly.
+ * Useful for testing and development. Assumes the presence of full stdio
+ * disk access.
  */
 
-#ifndef ipconfigARP_STORES_REMOTE_ADDRESSES
-    #define ipconfigARP_STORES_REMOTE_ADDRESSES    ipconfigDISABLE
+#ifndef ipconfigUSE_DUMP_PACKETS
+    #define ipconfigUSE_DUMP_PACKETS    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigARP_STORES_REMOTE_ADDRESSES != ipconfigDISABLE ) && ( ipconfigARP_STORES_REMOTE_ADDRESSES != ipconfigENABLE ) )
-    #error Invalid ipconfigARP_STORES_REMOTE_ADDRESSES configuration
+#if ( ( ipconfigUSE_DUMP_PACKETS != ipconfigDISABLE ) && ( ipconfigUSE_DUMP_PACKETS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DUMP_PACKETS configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
-#if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP ) && ipconfigIS_ENABLED( ipconfigDHCP_FALL_BACK_AUTO_IP ) )
-
-/*-----------------------------------------------------------------------*/
-
 /*
- * ipconfigARP_USE_CLASH_DETECTION
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigARP_USE_CLASH_DETECTION
+ * ipconfigUSE_TCP_MEM_STATS
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enables the driver to test if an assigned link-layer address is already
- * taken by another device by sending ARP requests.
+ * See this utility: tools/tcp_utilities/tcp_mem_stats.md
  *
- * ipconfigDHCP_FALL_BACK_AUTO_IP requires this feature to be enabled.
+ * Allow inclusion of a utility that monitors all allocation and releases of
+ * network-related resources.
+ *
+ * After running for a while, it will print all data
+ * in a CSV format, which can be analysed in a spreadsheet program.
  */
 
-    #ifndef ipconfigARP_USE_CLASH_DETECTION
-        #define ipconfigARP_USE_CLASH_DETECTION    ipconfigENABLE
-    #endif
-
-    #if ( ( ipconfigARP_USE_CLASH_DETECTION != ipconfigDISABLE ) && ( ipconfigARP_USE_CLASH_DETECTION != ipconfigENABLE ) )
-        #error Invalid ipconfigARP_USE_CLASH_DETECTION configuration
-    #endif
-
-    #if ( ipconfigIS_DISABLED( ipconfigARP_USE_CLASH_DETECTION ) )
-        #error When ipconfigDHCP_FALL_BACK_AUTO_IP is enabled, ipconfigARP_USE_CLASH_DETECTION must also be enabled
-    #endif
-
-/*-----------------------------------------------------------------------*/
-
-#else /* ( ( ipconfigIS_ENABLED( ipconfigUSE_DHCP ) && ipconfigIS_ENABLED( ipconfigDHCP_FALL_BACK_AUTO_IP ) ) */
-
-/*-----------------------------------------------------------------------*/
-
-    #ifndef ipconfigARP_USE_CLASH_DETECTION
-        #define ipconfigARP_USE_CLASH_DETECTION    ipconfigDISABLE
-    #endif
-
-    #if ( ipconfigIS_ENABLED( ipconfigARP_USE_CLASH_DETECTION ) )
-        #error ipconfigARP_USE_CLASH_DETECTION is unused when ipconfigDHCP_FALL_BACK_AUTO_IP is disabled
-    #endif
-
-/*-----------------------------------------------------------------------*/
+#ifndef ipconfigUSE_TCP_MEM_STATS
+    #define ipconfigUSE_TCP_MEM_STATS    ipconfigDISABLE
+#endif
 
-#endif /* ( ipconfigIS_ENABLED( ipconfigUSE_DHCP ) && ipconfigIS_ENABLED( ipconfigDHCP_FALL_BACK_AUTO_IP ) ) */
+#if ( ( ipconfigUSE_TCP_MEM_STATS != ipconfigDISABLE ) && ( ipconfigUSE_TCP_MEM_STATS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_MEM_STATS configuration
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigMAX_ARP_AGE
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigMAX_ARP_AGE
- *
- * Type: uint8_t
- * Unit: decaseconds
- * Minimum: 0
+ * ipconfigTCP_MEM_STATS_MAX_ALLOCATION
  *
- * Defines the maximum time between an entry in the ARP table being created or
- * refreshed and the entry being removed because it is stale. New ARP requests
- * are sent for ARP cache entries that are nearing their maximum age.
- * The maximum age of an entry in the ARP cache table can be
- * calculated as 'ipARP_TIMER_PERIOD_MS' x 'ipconfigMAX_ARP_AGE'.
+ * Type: size_t
+ * Unit: count of TCP_ALLOCATION_t
+ * Minimum: 1
  *
- * Units are derived from ipARP_TIMER_PERIOD_MS, which is 10000 ms or 10 sec.
- * So, a value of 150 is equal to 1500 seconds.
+ * Defines the maximum number of allocations that can be stored/monitored.
  */
 
-#ifndef ipconfigMAX_ARP_AGE
-    #define ipconfigMAX_ARP_AGE    ( 150 )
+#ifndef ipconfigTCP_MEM_STATS_MAX_ALLOCATION
+    #define ipconfigTCP_MEM_STATS_MAX_ALLOCATION    ( 128 )
 #endif
 
-#if ( ipconfigMAX_ARP_AGE < 0 )
-    #error ipconfigMAX_ARP_AGE must be at least 0
+#if ( ipconfigTCP_MEM_STATS_MAX_ALLOCATION < 1 )
+    #error ipconfigTCP_MEM_STATS_MAX_ALLOCATION must be at least 1
 #endif
 
-#if ( ipconfigMAX_ARP_AGE > UINT8_MAX )
-    #error ipconfigMAX_ARP_AGE overflows a uint8_t
+#if ( ipconfigTCP_MEM_STATS_MAX_ALLOCATION > SIZE_MAX )
+    #error ipconfigTCP_MEM_STATS_MAX_ALLOCATION overflows a size_t
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigMAX_ARP_RETRANSMISSIONS
+ * ipconfigUSE_TCP_TRACE_RING
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigMAX_ARP_RETRANSMISSIONS
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Type: uint8_t
- * Unit: count of retransmissions
- * Minimum: 0
+ * See this utility: tools/tcp_utilities/tcp_trace_ring.md
  *
- * Sets the number of times an ARP request is sent when looking up an
- * IP-address. Also referred as the maximum amount of retransmissions
- * of ARP requests that do not result in an ARP response before the ARP
- * request is aborted.
+ * Allow inclusion of a utility that records the hot-path trace macros, such
+ * as iptraceNETWORK_INTERFACE_INPUT() and iptraceNETWORK_BUFFER_RELEASED(),
+ * as small time-stamped binary records in a ring buffer per core. The rings
+ * can be copied out at any time and decoded on a host, to measure the latency
+ * of packets through the stack.
  */
 
-#ifndef ipconfigMAX_ARP_RETRANSMISSIONS
-    #define ipconfigMAX_ARP_RETRANSMISSIONS    ( 5 )
-#endif
-
-#if ( ipconfigMAX_ARP_RETRANSMISSIONS < 0 )
-    #error ipconfigMAX_ARP_RETRANSMISSIONS must be at least 0
+#ifndef ipconfigUSE_TCP_TRACE_RING
+    #define ipconfigUSE_TCP_TRACE_RING    ipconfigDISABLE
 #endif
 
-#if ( ipconfigMAX_ARP_RETRANSMISSIONS > UINT8_MAX )
-    #error ipconfigMAX_ARP_RETRANSMISSIONS overflows a uint8_t
+#if ( ( ipconfigUSE_TCP_TRACE_RING != ipconfigDISABLE ) && ( ipconfigUSE_TCP_TRACE_RING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_TRACE_RING configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_ARP_REMOVE_ENTRY
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_ARP_REMOVE_ENTRY
- *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * ipconfigTCP_TRACE_RING_ENTRIES
  *
- * Advanced users only.
+ * Type: size_t
+ * Unit: count of 16-byte records per core
+ * Minimum: 2
  *
- * Include support for ulARPRemoveCacheEntryByMac() which uses a MAC address to
- * look up and remove an entry from the ARP cache. If the MAC address is found
- * in the ARP cache, then the IP address associated with the MAC address is
- * returned, otherwise 0 is returned.
+ * The size of each trace ring. It must be a power of two. When a ring is
+ * full, the oldest records are overwritten.
  */
 
-#ifndef ipconfigUSE_ARP_REMOVE_ENTRY
-    #define ipconfigUSE_ARP_REMOVE_ENTRY    ipconfigDISABLE
+#ifndef ipconfigTCP_TRACE_RING_ENTRIES
+    #define ipconfigTCP_TRACE_RING_ENTRIES    ( 1024 )
 #endif
 
-#if ( ( ipconfigUSE_ARP_REMOVE_ENTRY != ipconfigDISABLE ) && ( ipconfigUSE_ARP_REMOVE_ENTRY != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_ARP_REMOVE_ENTRY configuration
+#if ( ipconfigTCP_TRACE_RING_ENTRIES < 2 )
+    #error ipconfigTCP_TRACE_RING_ENTRIES must be at least 2
+#endif
+
+#if ( ( ipconfigTCP_TRACE_RING_ENTRIES & ( ipconfigTCP_TRACE_RING_ENTRIES - 1 ) ) != 0 )
+    #error ipconfigTCP_TRACE_RING_ENTRIES must be a power of two
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_ARP_REVERSED_LOOKUP
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigUSE_ARP_REVERSED_LOOKUP
- *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * ipconfigTCP_TRACE_RING_TIMESTAMP
  *
- * Advanced users only.
- *
- * Include support for eARPGetCacheEntryByMac() which looks up a MAC address
- * from an IP address.
+ * Type: Macro Function
  *
- * ARP normally does the reverse by looking up an IP address from a MAC
- * address.
+ * Returns the 32-bit time stamp of a trace record. It is called from tasks
+ * and from interrupts, with interrupts masked. The default, the tick count,
+ * is too coarse to measure latencies; a free-running hardware counter such as
+ * the DWT cycle counter of a Cortex-M is a better choice. Set
+ * ipconfigTCP_TRACE_RING_TIMESTAMP_HZ to its frequency.
  */
 
-#ifndef ipconfigUSE_ARP_REVERSED_LOOKUP
-    #define ipconfigUSE_ARP_REVERSED_LOOKUP    ipconfigDISABLE
+#ifndef ipconfigTCP_TRACE_RING_TIMESTAMP
+    #define ipconfigTCP_TRACE_RING_TIMESTAMP()    ( ( uint32_t ) xTaskGetTickCountFromISR() )
 #endif
 
-#if ( ( ipconfigUSE_ARP_REVERSED_LOOKUP != ipconfigDISABLE ) && ( ipconfigUSE_ARP_REVERSED_LOOKUP != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_ARP_REVERSED_LOOKUP configuration
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigTCP_TRACE_RING_TIMESTAMP_HZ
+ *
+ * Type: uint32_t
+ * Unit: counts per second
+ * Minimum: 1
+ *
+ * The frequency of ipconfigTCP_TRACE_RING_TIMESTAMP(), stored in the header
+ * of the trace so that the decoder can convert time stamps to microseconds.
+ */
+
+#ifndef ipconfigTCP_TRACE_RING_TIMESTAMP_HZ
+    #define ipconfigTCP_TRACE_RING_TIMESTAMP_HZ    ( configTICK_RATE_HZ )
 #endif
 
 /*---------------------------------------------------------------------------*/
 
-/*===========================================================================*/
-/*                                ARP CONFIG                                 */
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*                               ICMP CONFIG                                 */
-/*===========================================================================*/
-
-/*---------------------------------------------------------------------------*/
-
 /*
- * ipconfigREPLY_TO_INCOMING_PINGS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigREPLY_TO_INCOMING_PINGS
+ * ipconfigUSE_TCP_CAPTURE_RING
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enables generation of replies to incoming ICMP echo (ping) requests.
+ * See this utility: tools/tcp_utilities/tcp_capture_ring.md
  *
- * Normally it is quite desirable when embedded devices respond to a ping
- * request. Endpoints of the type IPv6 will reply to a ping request
- * unconditionally.
+ * Allow inclusion of a utility that copies the first bytes of every received
+ * and sent frame, with a time stamp, into a ring buffer in RAM. A trigger,
+ * such as a dropped packet or a TCP retransmission, freezes the ring a number
+ * of packets later, so that the traffic around the problem is kept. The ring
+ * can be read at any time as a pcapng file, without stopping the traffic.
  */
 
-#ifndef ipconfigREPLY_TO_INCOMING_PINGS
-    #define ipconfigREPLY_TO_INCOMING_PINGS    ipconfigENABLE
+#ifndef ipconfigUSE_TCP_CAPTURE_RING
+    #define ipconfigUSE_TCP_CAPTURE_RING    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigREPLY_TO_INCOMING_PINGS != ipconfigDISABLE ) && ( ipconfigREPLY_TO_INCOMING_PINGS != ipconfigENABLE ) )
-    #error Invalid ipconfigREPLY_TO_INCOMING_PINGS configuration
+#if ( ( ipconfigUSE_TCP_CAPTURE_RING != ipconfigDISABLE ) && ( ipconfigUSE_TCP_CAPTURE_RING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_CAPTURE_RING configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigICMP_TIME_TO_LIVE
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigICMP_TIME_TO_LIVE
- *
- * Type: uint8_t
- * Unit: 'hops'
- * Minimum: 0
+ * ipconfigTCP_CAPTURE_RING_ENTRIES
  *
- * Sets the value of the TTL field when replying to an ICMP packet.
+ * Type: size_t
+ * Unit: count of frames
+ * Minimum: 2
  *
- * Only used when replying to an ICMP IPv4 ping request. The default of 64 is
- * recommended by RFC 1700.
+ * The number of frames that the capture ring holds. It must be a power of
+ * two. Each entry takes ipconfigTCP_CAPTURE_RING_SNAPLEN plus 16 bytes.
  */
 
-#ifndef ipconfigICMP_TIME_TO_LIVE
-    #define ipconfigICMP_TIME_TO_LIVE    ( 64 )
+#ifndef ipconfigTCP_CAPTURE_RING_ENTRIES
+    #define ipconfigTCP_CAPTURE_RING_ENTRIES    ( 64 )
 #endif
 
-#if ( ipconfigICMP_TIME_TO_LIVE < 0 )
-    #error ipconfigICMP_TIME_TO_LIVE must be at least 0
+#if ( ipconfigTCP_CAPTURE_RING_ENTRIES < 2 )
+    #error ipconfigTCP_CAPTURE_RING_ENTRIES must be at least 2
 #endif
 
-#if ( ipconfigICMP_TIME_TO_LIVE > UINT8_MAX )
-    #error ipconfigICMP_TIME_TO_LIVE overflows a uint8_t
+#if ( ( ipconfigTCP_CAPTURE_RING_ENTRIES & ( ipconfigTCP_CAPTURE_RING_ENTRIES - 1 ) ) != 0 )
+    #error ipconfigTCP_CAPTURE_RING_ENTRIES must be a power of two
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigSUPPORT_OUTGOING_PINGS
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigSUPPORT_OUTGOING_PINGS
+ * ipconfigTCP_CAPTURE_RING_SNAPLEN
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: size_t
+ * Unit: bytes per frame
+ * Minimum: 14
+ * Maximum: 65535
  *
- * Include support for FreeRTOS_SendPingRequest() and
- * FreeRTOS_SendPingRequestIPv6()
+ * The number of bytes that are kept of each frame. The default holds the
+ * Ethernet, IPv6 and TCP headers including the usual TCP options. It must be
+ * a multiple of 4.
  */
 
-#ifndef ipconfigSUPPORT_OUTGOING_PINGS
-    #define ipconfigSUPPORT_OUTGOING_PINGS    ipconfigDISABLE
+#ifndef ipconfigTCP_CAPTURE_RING_SNAPLEN
+    #define ipconfigTCP_CAPTURE_RING_SNAPLEN    ( 128 )
 #endif
 
-#if ( ( ipconfigSUPPORT_OUTGOING_PINGS != ipconfigDISABLE ) && ( ipconfigSUPPORT_OUTGOING_PINGS != ipconfigENABLE ) )
-    #error Invalid ipconfigSUPPORT_OUTGOING_PINGS configuration
+#if ( ( ipconfigTCP_CAPTURE_RING_SNAPLEN < 14 ) || ( ipconfigTCP_CAPTURE_RING_SNAPLEN > 65535 ) )
+    #error Invalid ipconfigTCP_CAPTURE_RING_SNAPLEN configuration
 #endif
 
-/*---------------------------------------------------------------------------*/
-
-/*===========================================================================*/
-/*                               ICMP CONFIG                                 */
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*                              ROUTING CONFIG                               */
-/*===========================================================================*/
+#if ( ( ipconfigTCP_CAPTURE_RING_SNAPLEN % 4 ) != 0 )
+    #error ipconfigTCP_CAPTURE_RING_SNAPLEN must be a multiple of 4
+#endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigCOMPATIBLE_WITH_SINGLE
+ * ipconfigTCP_CAPTURE_RING_TIME_US
  *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ * Type: Macro Function
+ * Unit: microseconds
  *
- * Retains compatibility with V3.x.x and older versions that only
- * supported one interface.
+ * Returns the 64-bit time stamp of a captured frame. The default has the
+ * resolution of a clock tick. A time since the epoch, e.g. derived from SNTP,
+ * lets Wireshark show the wall clock time of each frame.
  */
 
-#ifndef ipconfigCOMPATIBLE_WITH_SINGLE
-    #define ipconfigCOMPATIBLE_WITH_SINGLE    ipconfigDISABLE
-#endif
-
-#if ( ( ipconfigCOMPATIBLE_WITH_SINGLE != ipconfigDISABLE ) && ( ipconfigCOMPATIBLE_WITH_SINGLE != ipconfigENABLE ) )
-    #error Invalid ipconfigCOMPATIBLE_WITH_SINGLE configuration
+#ifndef ipconfigTCP_CAPTURE_RING_TIME_US
+    #define ipconfigTCP_CAPTURE_RING_TIME_US()    ( ( ( uint64_t ) xTaskGetTickCount() * 1000000U ) / ( uint64_t ) configTICK_RATE_HZ )
 #endif
 
 /*---------------------------------------------------------------------------*/
 
-/*===========================================================================*/
-/*                              ROUTING CONFIG                               */
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*---------------------------------------------------------------------------*/
-/*===========================================================================*/
-/*                        DEBUG/TRACE/LOGGING CONFIG                         */
-/*===========================================================================*/
-
-/*---------------------------------------------------------------------------*/
-
 /*
- * ipconfigCHECK_IP_QUEUE_SPACE
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigCHECK_IP_QUEUE_SPACE
+ * ipconfigUSE_NETWORK_COUNTERS
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enables the IP-Task to track the run-time minimum free space that has
- * existed in the event queue (uxQueueMinimumSpace). This value can be
- * retrieved using the function uxGetMinimumIPQueueSpace().
- *
- * Enables vPrintResourceStats() to log warnings about shrinking queue space.
- *
- * See ipconfigEVENT_QUEUE_LENGTH for setting the length of the event queue.
+ * When enabled, every network interface keeps counters of the packets and
+ * bytes that it received and sent, in total and per protocol (IPv4, IPv6,
+ * ARP, ICMP, UDP and TCP), of the received packets that were dropped, per
+ * reason, and of the times that the IP-task could not be reached because
+ * its queue was full. The counters are plain increments on the hot path,
+ * they can be read with FreeRTOS_GetNetworkCounters(), e.g. to feed an SNMP
+ * agent or a metrics exporter.
  */
 
-#ifndef ipconfigCHECK_IP_QUEUE_SPACE
-    #define ipconfigCHECK_IP_QUEUE_SPACE    ipconfigDISABLE
+#ifndef ipconfigUSE_NETWORK_COUNTERS
+    #define ipconfigUSE_NETWORK_COUNTERS    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigCHECK_IP_QUEUE_SPACE != ipconfigDISABLE ) && ( ipconfigCHECK_IP_QUEUE_SPACE != ipconfigENABLE ) )
-    #error Invalid ipconfigCHECK_IP_QUEUE_SPACE configuration
+#if ( ( ipconfigUSE_NETWORK_COUNTERS != ipconfigDISABLE ) && ( ipconfigUSE_NETWORK_COUNTERS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_NETWORK_COUNTERS configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigHAS_DEBUG_PRINTF
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigHAS_DEBUG_PRINTF
+ * ipconfigUSE_IP_TASK_STATS
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * ipconfigHAS_DEBUG_PRINTF enables usage of the macro FreeRTOS_debug_printf to
- * generate output messages mostly from the TCP/IP stack.
- *
- * Requires a reentrant application defined macro function
- * FreeRTOS_debug_printf with a return value that is ignored.
- *
- * The FreeRTOS_debug_printf() must be thread-safe but does not
- * have to be interrupt-safe.
- *
- * Example:
- *
- * void vLoggingPrintf( const char *pcFormatString, ... )
- *
- * #define ipconfigHAS_DEBUG_PRINTF    ipconfigENABLE
- * #define FreeRTOS_debug_printf( X )  if( ipconfigIS_ENABLED( ipconfigHAS_DEBUG_PRINTF ) vLoggingPrintf X
- *
- * FreeRTOS_debug_printf( ( "FunctionName: Failed with error code: %u\n", xErrorCode ) )
+ * When enabled, the IP-task measures its own load: per event type the number
+ * of events handled and the time spent handling them, the time spent in the
+ * periodic timer checks, the highest number of messages that were waiting in
+ * 'xNetworkEventQueue', and a histogram of the time that events waited in the
+ * queue before the IP-task took them. Every event is stamped with
+ * ipconfigIP_TASK_STATS_TIME() when it is queued. The statistics can be read
+ * with FreeRTOS_GetIPTaskStats(), and help to choose ipconfigEVENT_QUEUE_LENGTH
+ * and ipconfigIP_TASK_PRIORITY.
  */
 
-#ifndef ipconfigHAS_DEBUG_PRINTF
-    #define ipconfigHAS_DEBUG_PRINTF    ipconfigDISABLE
-#endif
-
-#if ( ( ipconfigHAS_DEBUG_PRINTF != ipconfigDISABLE ) && ( ipconfigHAS_DEBUG_PRINTF != ipconfigENABLE ) )
-    #error Invalid ipconfigHAS_DEBUG_PRINTF configuration
+#ifndef ipconfigUSE_IP_TASK_STATS
+    #define ipconfigUSE_IP_TASK_STATS    ipconfigDISABLE
 #endif
 
-#ifndef FreeRTOS_debug_printf
-    #if ( ( ipconfigHAS_DEBUG_PRINTF == 1 ) && defined( configPRINTF ) )
-        #define FreeRTOS_debug_printf( MSG )    do { configPRINTF( MSG ); } while( ipFALSE_BOOL )
-    #else
-        #define FreeRTOS_debug_printf( MSG )    do {} while( ipFALSE_BOOL )
-    #endif
+#if ( ( ipconfigUSE_IP_TASK_STATS != ipconfigDISABLE ) && ( ipconfigUSE_IP_TASK_STATS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_IP_TASK_STATS configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigHAS_PRINTF
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigHAS_PRINTF
- *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
- *
- * ipconfigHAS_PRINTF enables usage of the macro FreeRTOS_printf to
- * generate output messages mostly from TCP/IP stack demo applications.
+ * ipconfigIP_TASK_STATS_TIME
  *
- * Requires a reentrant application defined macro function FreeRTOS_printf with
- * a return value that is ignored.
- *
- * The FreeRTOS_printf() must be thread-safe but does not have to be interrupt-safe.
+ * Type: Macro Function
+ * Unit: any free running 32-bit counter
  *
- * See ipconfigHAS_DEBUG_PRINTF
+ * The time source of ipconfigUSE_IP_TASK_STATS. It is called from tasks and
+ * from interrupts, when events are sent with xQueueSendToBackFromISR(). The
+ * default of a clock tick is too coarse to measure the handling of single
+ * events; define it as a cycle counter, e.g. the DWT->CYCCNT of a Cortex-M,
+ * to get meaningful processing times and latencies.
  */
 
-#ifndef ipconfigHAS_PRINTF
-    #define ipconfigHAS_PRINTF    ipconfigDISABLE
+#ifndef ipconfigIP_TASK_STATS_TIME
+    #define ipconfigIP_TASK_STATS_TIME()    ( ( uint32_t ) xTaskGetTickCountFromISR() )
 #endif
 
-#if ( ( ipconfigHAS_PRINTF != ipconfigDISABLE ) && ( ipconfigHAS_PRINTF != ipconfigENABLE ) )
-    #error Invalid ipconfigHAS_PRINTF configuration
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigIP_TASK_STATS_LATENCY_BUCKETS
+ *
+ * Type: size_t
+ * Unit: count of histogram buckets
+ * Minimum: 2
+ * Maximum: 32
+ *
+ * The number of buckets in the queue latency histogram of
+ * ipconfigUSE_IP_TASK_STATS. Bucket 0 counts the events that were handled
+ * within the same unit of ipconfigIP_TASK_STATS_TIME(), bucket N those that
+ * waited from 2^(N-1) up to 2^N units, and the last bucket all longer waits.
+ */
+
+#ifndef ipconfigIP_TASK_STATS_LATENCY_BUCKETS
+    #define ipconfigIP_TASK_STATS_LATENCY_BUCKETS    16U
 #endif
 
-#ifndef FreeRTOS_printf
-    #if ( ( ipconfigHAS_PRINTF == 1 ) && defined( configPRINTF ) )
-        #define FreeRTOS_printf( MSG )    do { configPRINTF( MSG ); } while( ipFALSE_BOOL )
-    #else
-        #define FreeRTOS_printf( MSG )    do {} while( ipFALSE_BOOL )
-    #endif
+#if ( ( ipconfigIP_TASK_STATS_LATENCY_BUCKETS < 2 ) || ( ipconfigIP_TASK_STATS_LATENCY_BUCKETS > 32 ) )
+    #error Invalid ipconfigIP_TASK_STATS_LATENCY_BUCKETS configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_IP_SANITY
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_IP_SANITY
+ * ipconfigIP_RUN_TO_COMPLETION
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * Enables warnings when irregularities are detected when using
- * BufferAllocation_1.c.
+ * When enabled, FreeRTOS_IPInit_Multi() does not create the IP-task nor
+ * 'xNetworkEventQueue'. Every event is handled to completion in the task
+ * that sends it: a driver that calls xSendEventStructToIPTask() processes
+ * the received frame in its own receive task, and FreeRTOS_sendto() passes
+ * the packet to the driver in the calling task. A mutex makes sure that only
+ * one task at a time runs the stack; xIsCallingFromIPTask() returns pdTRUE
+ * in the task that holds it.
+ *
+ * The network timers are driven by the application, which must call
+ * FreeRTOS_IPProcessTimers() regularly, e.g. from a loop or a timer
+ * callback. The function returns the time until the next timer expires.
+ * The stack is initialised by the first task that runs it, normally in the
+ * first call of FreeRTOS_IPProcessTimers(). Events from interrupts, sent by
+ * FreeRTOS_NetworkDownFromISR() or FreeRTOS_NetworkInterfacePollFromISR(),
+ * are handled by the next task that runs the stack.
+ *
+ * This saves the stack and the queue of the IP-task on tiny devices that
+ * only use UDP. It can not be combined with ipconfigUSE_TCP,
+ * ipconfigUSE_IP_EVENT_PRIORITY or ipconfigUSE_IP_TASK_STATS.
  */
 
-#ifndef ipconfigTCP_IP_SANITY
-    #define ipconfigTCP_IP_SANITY    ipconfigDISABLE
+#ifndef ipconfigIP_RUN_TO_COMPLETION
+    #define ipconfigIP_RUN_TO_COMPLETION    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigTCP_IP_SANITY != ipconfigDISABLE ) && ( ipconfigTCP_IP_SANITY != ipconfigENABLE ) )
-    #error Invalid ipconfigTCP_IP_SANITY configuration
+#if ( ( ipconfigIP_RUN_TO_COMPLETION != ipconfigDISABLE ) && ( ipconfigIP_RUN_TO_COMPLETION != ipconfigENABLE ) )
+    #error Invalid ipconfigIP_RUN_TO_COMPLETION configuration
+#endif
+
+#if ( ipconfigIP_RUN_TO_COMPLETION != 0 )
+    #if ( ipconfigUSE_TCP != 0 )
+        #error ipconfigIP_RUN_TO_COMPLETION can not be used with ipconfigUSE_TCP
+    #endif
+    #if ( ipconfigUSE_IP_EVENT_PRIORITY != 0 )
+        #error ipconfigIP_RUN_TO_COMPLETION can not be used with ipconfigUSE_IP_EVENT_PRIORITY
+    #endif
+    #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+        #error ipconfigIP_RUN_TO_COMPLETION can not be used with ipconfigUSE_IP_TASK_STATS
+    #endif
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_MAY_LOG_PORT
+ * ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigTCP_MAY_LOG_PORT
- *
- * Type: Macro Function
- *
- * Specifies which port numbers should be logged by FreeRTOS_debug_printf().
- * The return value should be a BaseType_t ( pdFALSE | pdTRUE )
- * For example, the following definition will not generate log messages for
- * ports 23 or 2402:
+ * Type: size_t
+ * Unit: count of events
+ * Minimum: 1
  *
- * #define ipconfigTCP_MAY_LOG_PORT( xPort ) ( ( ( xPort ) != 23 ) && ( ( xPort ) != 2402 ) )
+ * With ipconfigIP_RUN_TO_COMPLETION, an event that is sent while the stack
+ * is running, e.g. by a UDP receive handler that calls FreeRTOS_sendto() or
+ * by the DHCP state machine, can not be handled immediately. It is stored
+ * in a list of this length, and handled before the stack is released. When
+ * the list is full, the event is lost as if 'xNetworkEventQueue' was full.
  */
 
-#ifndef ipconfigTCP_MAY_LOG_PORT
-    #define ipconfigTCP_MAY_LOG_PORT( xPort )    ( ( xPort ) != 23U )
+#ifndef ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS
+    #define ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS    8U
 #endif
 
-#if ( ( ipconfigTCP_MAY_LOG_PORT( 0 ) != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( 0 ) != 1 ) )
-    #error ipconfigTCP_MAY_LOG_PORT() should equate to pdFALSE or pdTRUE
+#if ( ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS < 1 )
+    #error ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS must be at least 1
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigWATCHDOG_TIMER
+ * ipconfigUSE_SOCKET_ACCOUNTING
  *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigWATCHDOG_TIMER
- *
- * Type: Macro Function
- *
- * Macro that is called on each iteration of the IP task.
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * May be useful if the application includes watchdog type functionality that
- * needs to know that the IP task is still cycling (although the fact that the
- * IP task is cycling does not necessarily indicate it is functioning
- * correctly). The return value is ignored.
+ * When enabled, every socket counts the packets and bytes that it received
+ * and sent, and the time that the IP-task spent on its behalf: handling
+ * received packets, preparing packets for transmission, and the periodic TCP
+ * timer work. The counters of a single socket can be read and cleared with
+ * the FREERTOS_SO_ACCOUNTING socket option, those of all bound sockets can be
+ * copied at once with FreeRTOS_GetSocketAccounting(). This shows which
+ * connection keeps the IP-task busy.
  */
 
-#ifndef ipconfigWATCHDOG_TIMER
-    #define ipconfigWATCHDOG_TIMER()    do {} while( ipFALSE_BOOL )
+#ifndef ipconfigUSE_SOCKET_ACCOUNTING
+    #define ipconfigUSE_SOCKET_ACCOUNTING    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_SOCKET_ACCOUNTING != ipconfigDISABLE ) && ( ipconfigUSE_SOCKET_ACCOUNTING != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_SOCKET_ACCOUNTING configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_DUMP_PACKETS
- *
- * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
- *
- * See this utility: tools/tcp_utilities/tcp_dump_packets.md
+ * ipconfigSOCKET_ACCOUNTING_TIME
  *
- * Allow inclusion of a utility that writes of network packets to files.
+ * Type: Macro Function
+ * Unit: any free running 32-bit counter
  *
- * Useful for testing and development. Assumes the presence of full stdio
- * disk access.
+ * The time source of ipconfigUSE_SOCKET_ACCOUNTING. It is only called from
+ * the IP-task. By default the time source of ipconfigUSE_IP_TASK_STATS is
+ * used, so that the per-socket times can be compared with the totals of
+ * FreeRTOS_GetIPTaskStats().
  */
 
-#ifndef ipconfigUSE_DUMP_PACKETS
-    #define ipconfigUSE_DUMP_PACKETS    ipconfigDISABLE
-#endif
-
-#if ( ( ipconfigUSE_DUMP_PACKETS != ipconfigDISABLE ) && ( ipconfigUSE_DUMP_PACKETS != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_DUMP_PACKETS configuration
+#ifndef ipconfigSOCKET_ACCOUNTING_TIME
+    #define ipconfigSOCKET_ACCOUNTING_TIME()    ipconfigIP_TASK_STATS_TIME()
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigUSE_TCP_MEM_STATS
+ * ipconfigUSE_RESOURCE_STATS
  *
  * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * See this utility: tools/tcp_utilities/tcp_mem_stats.md
- *
- * Allow inclusion of a utility that monitors all allocation and releases of
- * network-related resources.
- *
- * After running for a while, it will print all data
- * in a CSV format, which can be analysed in a spreadsheet program.
+ * When enabled, FreeRTOS_GetResourceStats() reports the current and the peak
+ * use of the resources that are sized in FreeRTOSIPConfig.h: network buffers,
+ * TCP segment descriptors, sockets, the bytes of the TCP stream buffers, the
+ * rows of the ARP, ND and DNS caches, and the heap held by the stack. Unlike
+ * vPrintResourceStats(), the figures are returned in a structure, so that an
+ * application can send them to a host, or raise an alarm before a resource
+ * runs out. The stack also counts how often the network buffers, the event
+ * queue, the TCP segment descriptors, the ARP cache and the DNS cache ran
+ * out. From these figures FreeRTOS_GetRecommendedConfig() writes a
+ * FreeRTOSIPConfig.h fragment that fits the observed workload.
  */
 
-#ifndef ipconfigUSE_TCP_MEM_STATS
-    #define ipconfigUSE_TCP_MEM_STATS    ipconfigDISABLE
+#ifndef ipconfigUSE_RESOURCE_STATS
+    #define ipconfigUSE_RESOURCE_STATS    ipconfigDISABLE
 #endif
 
-#if ( ( ipconfigUSE_TCP_MEM_STATS != ipconfigDISABLE ) && ( ipconfigUSE_TCP_MEM_STATS != ipconfigENABLE ) )
-    #error Invalid ipconfigUSE_TCP_MEM_STATS configuration
+#if ( ( ipconfigUSE_RESOURCE_STATS != ipconfigDISABLE ) && ( ipconfigUSE_RESOURCE_STATS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_RESOURCE_STATS configuration
 #endif
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigTCP_MEM_STATS_MAX_ALLOCATION
+ * ipconfigRESOURCE_STATS_HEADROOM
  *
  * Type: size_t
- * Unit: count of TCP_ALLOCATION_t
- * Minimum: 1
+ * Unit: percent
+ * Minimum: 0
  *
- * Defines the maximum number of allocations that can be stored/monitored.
+ * The margin that FreeRTOS_GetRecommendedConfig() adds to the peak use of a
+ * resource that never ran out. A resource that did run out is recommended to
+ * grow by half of its current size, as its real demand is not known.
  */
 
-#ifndef ipconfigTCP_MEM_STATS_MAX_ALLOCATION
-    #define ipconfigTCP_MEM_STATS_MAX_ALLOCATION    ( 128 )
-#endif
-
-#if ( ipconfigTCP_MEM_STATS_MAX_ALLOCATION < 1 )
-    #error ipconfigTCP_MEM_STATS_MAX_ALLOCATION must be at least 1
-#endif
-
-#if ( ipconfigTCP_MEM_STATS_MAX_ALLOCATION > SIZE_MAX )
-    #error ipconfigTCP_MEM_STATS_MAX_ALLOCATION overflows a size_t
+#ifndef ipconfigRESOURCE_STATS_HEADROOM
+    #define ipconfigRESOURCE_STATS_HEADROOM    25U
 #endif
 
 /*---------------------------------------------------------------------------*/
@@ -60,6 +60,9 @@ typedef struct xARP_CACHE_TABLE_ROW
     uint8_t ucValid;          /**< pdTRUE: xMACAddress is valid, pdFALSE: waiting for ARP reply */
     struct xNetworkEndPoint
     * pxEndPoint;             /**< The end-point on which the MAC address was last seen. */
+    #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+        uint8_t ucUsed;       /**< Non-zero when the entry was used during the last ageing period. */
+    #endif
 } ARPCacheRow_t;
 
 typedef enum
@@ -174,6 +177,34 @@ void FreeRTOS_OutputARPRequest_Multi( NetworkEndPoint_t * pxEndPoint,
 /* Clear all entries in the ARp cache. */
 void FreeRTOS_ClearARP( const struct xNetworkEndPoint * pxEndPoint );
 
+#if ( ipconfigARP_STATIC_ENTRIES > 0 )
+
+/*
+ * Add, change or remove a permanent IP to MAC address mapping.  These entries
+ * do not age and are not cleared by FreeRTOS_ClearARP().
+ */
+    BaseType_t FreeRTOS_AddStaticARPEntry( uint32_t ulIPAddress,
+                                           const MACAddress_t * pxMACAddress,
+                                           struct xNetworkEndPoint * pxEndPoint );
+
+    BaseType_t FreeRTOS_RemoveStaticARPEntry( uint32_t ulIPAddress );
+#endif
+
+#if ( ( ipconfigUSE_DRIVER_RESPONDER != 0 ) && ( ipconfigUSE_IPv4 != 0 ) )
+
+/*
+ * Turn an ARP request for the address of 'pxEndPoint' into a reply, without
+ * touching the ARP cache.  Used by xIPDriverRespond().
+ */
+    BaseType_t xARPRespondInDriver( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                    const struct xNetworkEndPoint * pxEndPoint );
+#endif
+
+#if ( ipconfigUSE_RESOURCE_STATS != 0 )
+    /* The number of occupied rows of the ARP cache. */
+    UBaseType_t uxARPCacheRowsInUse( void );
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     } /* extern "C" */
@@ -0,0 +1,87 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_Bond.h
+ * @brief Header file for the bond interfaces, which aggregate several links.
+ */
+
+#ifndef FREERTOS_BOND_H
+#define FREERTOS_BOND_H
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Routing.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( ipconfigUSE_LINK_BONDING != 0 )
+
+/*
+ * Create a virtual interface that aggregates the physical interfaces that
+ * are added to it with FreeRTOS_AddBondMember(). The object pointed to by
+ * 'pxInterface' must remain to exist. End-points are added to the returned
+ * interface as to any other interface; their MAC address is used by all
+ * members.
+ */
+    NetworkInterface_t * FreeRTOS_FillBondInterface( NetworkInterface_t * pxInterface,
+                                                     const char * pcName );
+
+/*
+ * Make the physical interface 'pxMember', which must have been added before
+ * and which has no end-points, a member of the bond 'pxBond'. The driver of
+ * a member finds the MAC address in the end-points of 'pxMember->pxBond'.
+ * Returns pdFAIL when 'pxMember' is already a member of a bond.
+ */
+    BaseType_t FreeRTOS_AddBondMember( NetworkInterface_t * pxBond,
+                                       NetworkInterface_t * pxMember );
+
+/*
+ * Called by the IP-task for every received frame, before anything else
+ * looks at it. Assigns a frame received by a member to its bond.
+ */
+    void vBondReceive( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Called by the IP-task when a member goes down. Takes the bond down when
+ * none of its members is up any more.
+ */
+    void vBondMemberDown( const NetworkInterface_t * pxMember );
+
+#endif /* ( ipconfigUSE_LINK_BONDING != 0 ) */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_BOND_H */
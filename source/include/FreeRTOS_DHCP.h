@@ -79,6 +79,7 @@
 #define dhcpIPv4_SERVER_IP_ADDRESS_OPTION_CODE     ( 54U )     /**< Server Identifier. See RFC 2132. */
 #define dhcpIPv4_PARAMETER_REQUEST_OPTION_CODE     ( 55U )     /**< Parameter Request list. See RFC 2132. */
 #define dhcpIPv4_CLIENT_IDENTIFIER_OPTION_CODE     ( 61U )     /**<  Client Identifier. See RFC 2132. */
+#define dhcpIPv4_RAPID_COMMIT_OPTION_CODE          ( 80U )     /**< Rapid Commit. See RFC 4039. */
 
 /* The four DHCP message types of interest. */
 #define dhcpMESSAGE_TYPE_DISCOVER                  ( 1 )     /**< DHCP discover message. */
@@ -175,6 +176,16 @@ typedef struct xDHCPMessage_IPv4 DHCPMessage_IPv4_t;
     } eDHCPCallbackAnswer_t;
 #endif /* #if( ipconfigUSE_DHCP_HOOK != 0 ) */
 
+#if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+/** @brief A lease as persisted by the application across reboots. */
+    typedef struct xDHCP_LEASE
+    {
+        uint32_t ulIPAddress;         /**< The leased IP-address, network byte order. */
+        uint32_t ulDHCPServerAddress; /**< The server that granted the lease, network byte order. */
+        uint32_t ulLeaseTime;         /**< The lease time in seconds. */
+    } DHCPLease_t;
+#endif /* ( ipconfigUSE_DHCP_INIT_REBOOT != 0 ) */
+
 /** @brief DHCP state machine states. */
 typedef enum
 {
@@ -207,6 +218,13 @@ struct xDHCP_DATA
     eDHCPState_t eDHCPState;       /**< The current state of the DHCP state machine. */
     eDHCPState_t eExpectedState;   /**< If the state is not equal the the expected state, no cycle needs to be done. */
     Socket_t xDHCPSocket;
+    #if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+        BaseType_t xInitReboot;      /**< pdTRUE while a REQUEST for a persisted lease is outstanding. */
+        BaseType_t xInitRebootTried; /**< pdTRUE once INIT-REBOOT was attempted since the last reset. */
+    #endif
+    #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+        BaseType_t xRapidCommitAck; /**< pdTRUE when the DISCOVER was answered with a Rapid Commit ACK. */
+    #endif
     /**< Record latest client ID for DHCPv6. */
     uint8_t ucClientDUID[ dhcpIPv6_CLIENT_DUID_LENGTH ];
 };
@@ -223,6 +241,10 @@ typedef struct xProcessSet
     uint32_t ulParameter;       /**< The uint32 value of the answer, if available. */
     uint32_t ulProcessed;       /**< The number of essential options that were parsed. */
     const uint8_t * pucByte;    /**< A pointer to the data to be analysed. */
+    #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+        BaseType_t xRapidAck;    /**< An ACK was received while an OFFER was expected. */
+        BaseType_t xRapidCommit; /**< The Rapid Commit option was present. */
+    #endif
 } ProcessSet_t;
 
 
@@ -261,6 +283,18 @@ BaseType_t xIsDHCPSocket( const ConstSocket_t xSocket );
     #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
 #endif /* ( ipconfigUSE_DHCP_HOOK != 0 ) */
 
+#if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+
+/* Hooks that must be provided by the application if ipconfigUSE_DHCP_INIT_REBOOT
+ * is set to 1.  xApplicationDHCPLeaseLoad() returns pdTRUE when 'pxLease' was
+ * filled with a lease from non-volatile storage.  vApplicationDHCPLeaseStore()
+ * is called after each ACK, and with an all-zero lease after a NAK. */
+    BaseType_t xApplicationDHCPLeaseLoad( const struct xNetworkEndPoint * pxEndPoint,
+                                          DHCPLease_t * pxLease );
+    void vApplicationDHCPLeaseStore( const struct xNetworkEndPoint * pxEndPoint,
+                                     const DHCPLease_t * pxLease );
+#endif /* ( ipconfigUSE_DHCP_INIT_REBOOT != 0 ) */
+
 #if ( ipconfigDHCP_FALL_BACK_AUTO_IP != 0 )
     struct xNetworkEndPoint;
 
@@ -71,6 +71,8 @@
     #define DHCPv6_Option_Elapsed_Time                 8U
 /** @brief IPv6 DHCP option - Status code */
     #define DHCPv6_Option_Status_Code                  13U
+/** @brief IPv6 DHCP option - Rapid commit */
+    #define DHCPv6_Option_Rapid_Commit                 14U
 /** @brief IPv6 DHCP option - Recursive name server */
     #define DHCPv6_Option_DNS_recursive_name_server    23U
 /** @brief IPv6 DHCP option - Search list */
@@ -125,6 +127,9 @@
         uint32_t ulTimeStamp;                                           /**< DUID Time: seconds since 1-1-2000. */
         uint8_t ucprefixLength;                                         /**< The length of the prefix offered. */
         uint8_t ucHasUID;                                               /**< When pdFALSE: a transaction ID must be created. */
+        #if ( ipconfigUSE_DHCP_RAPID_COMMIT != 0 )
+            uint8_t ucRapidCommit;                                      /**< Non-zero when the message carried the Rapid Commit option. */
+        #endif
         IP_Address_t xPrefixAddress;                                    /**< The prefix offered. */
         IP_Address_t xIPAddress;                                        /**< The IP-address offered. */
         ClientServerID_t xClientID;                                     /**< The UUID of the client. */
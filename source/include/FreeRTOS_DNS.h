@@ -97,6 +97,17 @@ uint32_t ulDNSHandlePacket( const NetworkBufferDescriptor_t * pxNetworkBuffer );
 
 #endif /* ipconfigUSE_NBNS */
 
+#if ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 )
+
+/*
+ * Forget the replies that the LLMNR, mDNS and NBNS responders have stored.
+ * Call it when xApplicationDNSQueryHook_Multi() starts to give different
+ * answers, e.g. after the device has been renamed.
+ */
+    void FreeRTOS_DNSAnswerTemplatesClear( void );
+
+#endif /* ipconfigUSE_DNS_ANSWER_TEMPLATES */
+
 #if ( ipconfigDNS_USE_CALLBACKS != 0 )
 
 /*
@@ -136,6 +147,7 @@ struct freertos_addrinfo * pxNew_AddrInfo( const char * pcName,
  * FreeRTOS_getaddrinfo() replaces FreeRTOS_gethostbyname().
  * When 'ipconfigUSE_IPv6' is defined, it can also retrieve IPv6 addresses,
  * in case pxHints->ai_family equals FREERTOS_AF_INET6.
+ * With ipconfigUSE_DNS_HAPPY_EYEBALLS, FREERTOS_AF_UNSPEC asks for both.
  * Otherwise, or when pxHints is NULL, only IPv4 addresses will be returned.
  */
 BaseType_t FreeRTOS_getaddrinfo( const char * pcName,                      /* The name of the node or device */
@@ -149,6 +161,16 @@ BaseType_t FreeRTOS_getaddrinfo( const char * pcName,                      /* Th
  */
 void FreeRTOS_freeaddrinfo( struct freertos_addrinfo * pxInfo );
 
+#if ( ipconfigUSE_DNS_HAPPY_EYEBALLS != 0 ) && ( ipconfigUSE_TCP == 1 )
+
+/* Connect to one of the addresses in a list returned by FreeRTOS_getaddrinfo(),
+ * racing the IPv6 and IPv4 addresses as described in RFC 8305. Returns a
+ * connected socket, or FREERTOS_INVALID_SOCKET. */
+    Socket_t FreeRTOS_connect_happy_eyeballs( const struct freertos_addrinfo * pxAddressList,
+                                              uint16_t usPort,
+                                              TickType_t uxTimeout );
+#endif
+
 /* Sets the DNS IP preference while doing DNS lookup to indicate the preference
  * for a DNS server: either IPv4 or IPv6. Defaults to xPreferenceIPv4 */
 BaseType_t FreeRTOS_SetDNSIPPreference( IPPreference_t eIPPreference );
@@ -44,13 +44,25 @@
     typedef struct xDNS_CACHE_TABLE_ROW
     {
         IPv46_Address_t xAddresses[ ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY ]; /*!< The IP address(es) of an ARP cache entry. */
-        char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ];                        /*!< The name of the host */
+        #if ( ipconfigDNS_CACHE_NAME_POOL_SIZE != 0 )
+            uint16_t usName;                                                 /*!< The name of the host in the name pool, zero for a free row */
+        #else
+            char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ];                    /*!< The name of the host */
+        #endif
         uint32_t ulTTL;                                                      /*!< Time-to-Live (in seconds) from the DNS server. */
         uint32_t ulTimeWhenAddedInSeconds;                                   /*!< time at which the entry was added */
         #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
             uint8_t ucNumIPAddresses;                                        /*!< number of ip addresses for the same entry */
             uint8_t ucCurrentIPAddress;                                      /*!< current ip address index */
         #endif
+        #if ( ipconfigUSE_DNS_CACHE_HASH_TABLE != 0 )
+            uint32_t ulNameHash;                                             /*!< hash of pcName, compared before the name itself */
+        #endif
+        #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+            uint32_t ulRefreshStarted;                                       /*!< time at which the last refresh was sent */
+            uint8_t ucHits;                                                  /*!< number of look-ups since the entry was stored */
+            uint8_t ucRefreshing;                                            /*!< non-zero while a refresh is outstanding */
+        #endif
     } DNSCacheRow_t;
 
 /* Look for the indicated host name in the DNS cache. Returns the IPv4
@@ -59,6 +71,11 @@
 
     void FreeRTOS_dnsclear( void );
 
+    #if ( ipconfigUSE_RESOURCE_STATS != 0 )
+        /* The number of occupied rows of the DNS cache. */
+        UBaseType_t uxDNSCacheRowsInUse( void );
+    #endif
+
 /**
  * @brief For debugging only: prints the contents of the DNS cache table.
  */
@@ -79,6 +96,64 @@
     uint32_t Prepare_CacheLookup( const char * pcHostName,
                                   BaseType_t xFamily,
                                   struct freertos_addrinfo ** ppxAddressInfo );
+
+    #if ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 )
+
+/* Remember for ulTTL seconds that pcName could not be resolved. */
+        void vDNSNegativeCacheAdd( const char * pcName,
+                                   BaseType_t xIsIPv6,
+                                   uint32_t ulTTL );
+
+/* Returns pdTRUE when pcName is known not to resolve. */
+        BaseType_t xDNSNegativeCacheLookup( const char * pcName,
+                                            BaseType_t xIsIPv6 );
+    #endif /* ( ipconfigUSE_DNS_NEGATIVE_CACHE != 0 ) */
+
+    #if ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 )
+
+/* The time that a background refresh is given before another one is sent. */
+        #define dnsCACHE_REFRESH_TIMEOUT_SECONDS    5U
+
+/* Returns pdTRUE when the caller must send a question to refresh pcName. */
+        BaseType_t xDNSCacheClaimRefresh( const char * pcName,
+                                          BaseType_t xIsIPv6 );
+    #endif /* ( ipconfigUSE_DNS_CACHE_PREFETCH != 0 ) */
+
+    #if ( ipconfigUSE_DNS_CACHE_PERSISTENCE != 0 )
+
+/**
+ * @brief A DNS cache entry as it is kept in non-volatile storage.
+ */
+        typedef struct xDNS_CACHE_RECORD
+        {
+            IPv46_Address_t xAddresses[ ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY ]; /*!< The IP address(es) of the host. */
+            char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ];                        /*!< The name of the host */
+            uint32_t ulExpiryTime;                                               /*!< Time at which the entry expires, in seconds since 1970. */
+            uint8_t ucNumIPAddresses;                                            /*!< number of valid entries in xAddresses[] */
+        } DNSCacheRecord_t;
+
+/* Pass the valid entries of the DNS cache to xApplicationDNSCacheStore().
+ * Returns the value returned by the hook, or pdFAIL when out of memory. */
+        BaseType_t FreeRTOS_dnsCacheSave( void );
+
+/* Called by the IP-task at start-up: put the entries returned by
+ * uxApplicationDNSCacheLoad() back in the DNS cache. */
+        void vDNSCacheRestore( void );
+
+/* The application should supply the following hooks.
+ * xApplicationDNSCacheStore() writes uxCount records to non-volatile storage,
+ * replacing what was stored before, and returns pdPASS on success.
+ * uxApplicationDNSCacheLoad() reads at most uxMaxCount records and returns the
+ * number read.  It returns zero when nothing valid was stored. */
+        extern BaseType_t xApplicationDNSCacheStore( const DNSCacheRecord_t * pxRecords,
+                                                     size_t uxCount );
+
+        extern size_t uxApplicationDNSCacheLoad( DNSCacheRecord_t * pxRecords,
+                                                 size_t uxMaxCount );
+
+/* It must return the number of seconds that have passed since 1/1/1970. */
+        extern uint32_t ulApplicationTimeHook( void );
+    #endif /* ( ipconfigUSE_DNS_CACHE_PERSISTENCE != 0 ) */
 #endif /* if ( ipconfigUSE_DNS_CACHE == 1 ) */
 
 #endif /* FREERTOS_DNS_CACHE_H */
@@ -62,6 +62,10 @@
 
     void vDNSCheckCallBack( void * pvSearchID );
 
+    #if ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 )
+        BaseType_t xDNSCallbackIsPending( const ParseSet_t * pxSet );
+    #endif
+
     void vDNSCallbackInitialise( void );
 
 #endif /* ipconfigDNS_USE_CALLBACKS  && ipconfigUSE_DNS */
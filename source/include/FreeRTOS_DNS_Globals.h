@@ -43,12 +43,14 @@
     #define dnsOUTGOING_FLAGS       0x0001U     /**< Little endian representation of standard query. */
     #define dnsRX_FLAGS_MASK        0x0f80U     /**< Little endian:  The bits of interest in the flags field of incoming DNS messages. */
     #define dnsEXPECTED_RX_FLAGS    0x0080U     /**< Little Endian: Should be a response, without any errors. */
+    #define dnsNXDOMAIN_RX_FLAGS    0x0380U     /**< Little Endian: A response with RCODE 3, the name does not exist. */
 #else
     #define dnsDNS_PORT             0x0035U     /**< Big endian: Port used for DNS. */
     #define dnsONE_QUESTION         0x0001U     /**< Big endian representation of a DNS question.*/
     #define dnsOUTGOING_FLAGS       0x0100U     /**< Big endian representation of standard query. */
     #define dnsRX_FLAGS_MASK        0x800fU     /**< Big endian: The bits of interest in the flags field of incoming DNS messages. */
     #define dnsEXPECTED_RX_FLAGS    0x8000U     /**< Big endian: Should be a response, without any errors. */
+    #define dnsNXDOMAIN_RX_FLAGS    0x8003U     /**< Big endian: A response with RCODE 3, the name does not exist. */
 
 #endif /* ipconfigBYTE_ORDER */
 #if ( ipconfigUSE_DNS != 0 )
@@ -68,6 +70,8 @@
     #define dnsTYPE_A_HOST            0x01U /**< DNS type A host. */
     #define dnsTYPE_AAAA_HOST         0x001CU
     #define dnsTYPE_ANY_HOST          0x00FFU
+    #define dnsTYPE_CNAME             0x0005U /**< Canonical name, an alias of another name. */
+    #define dnsTYPE_SOA               0x0006U /**< Start of authority, used for negative caching. */
 
     #define dnsCLASS_IN               0x01U /**< DNS class IN (Internet). */
 
@@ -266,6 +270,9 @@
             void * pvSearchID;             /**< Search ID of the callback function. */
             struct xLIST_ITEM xListItem;   /**< List struct. */
             BaseType_t xIsIPv6;            /**< Remember whether this was a IPv6 lookup. */
+            #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+                struct xDNS_Callback * pxNextInBucket; /**< The next entry with the same hash of the transaction ID. */
+            #endif
             char pcName[ 1 ];              /**< 1 character name. */
         } DNSCallback_t;
     #endif /* if ( ipconfigDNS_USE_CALLBACKS != 0 ) */
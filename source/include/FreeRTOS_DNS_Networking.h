@@ -58,5 +58,14 @@
 
     void DNS_CloseSocket( Socket_t xDNSSocket );
 
+    #if ( ipconfigUSE_DNS_ASYNC_MULTIPLEX != 0 )
+
+/*
+ * Return the socket that is shared by all asynchronous look-ups, or NULL
+ * when it can not be used.  It must not be closed by the caller.
+ */
+        Socket_t DNS_GetSharedSocket( void );
+    #endif
+
 #endif /* if ( ipconfigUSE_DNS != 0 ) */
 #endif /* FREERTOS_DNS_NETWORKING_H */
@@ -62,6 +62,18 @@
     size_t DNS_SkipNameField( const uint8_t * pucByte,
                               size_t uxLength );
 
+    #if ( ipconfigUSE_DNS_IN_PLACE_PARSER != 0 )
+
+/*
+ * Compare a name in a DNS message with a string, without copying it.
+ * Compression pointers are followed.
+ */
+        BaseType_t DNS_NameEquals( const uint8_t * pucBuffer,
+                                   size_t uxBufferLength,
+                                   size_t uxOffset,
+                                   const char * pcName );
+    #endif
+
 /*
  * Process a response packet from a DNS server.
  * The parameter 'xExpected' indicates whether the identifier in the reply
@@ -86,6 +98,24 @@
                             uint32_t ulIPAddress );
     #endif
 
+    #if ( ipconfigUSE_DNS_ANSWER_TEMPLATES != 0 )
+
+/*
+ * Keep an encoded LLMNR, mDNS or NBNS reply, and use it to answer the same
+ * question again. DNS_AnswerFromTemplate() returns pdTRUE when it has sent
+ * a reply.
+ */
+        void DNS_AnswerTemplateStore( const NetworkEndPoint_t * pxEndPoint,
+                                      uint16_t usPort,
+                                      const uint8_t * pucReply,
+                                      size_t uxReplyLength,
+                                      size_t uxQuestionLength );
+
+        BaseType_t DNS_AnswerFromTemplate( uint8_t * pucUDPPayloadBuffer,
+                                           size_t uxBufferLength,
+                                           uint16_t usPort );
+    #endif
+
 /**
  * Parse the DNS answer/response.
  */
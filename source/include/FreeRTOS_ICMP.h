@@ -46,14 +46,26 @@
 /* ICMP protocol definitions. */
 #define ipICMP_ECHO_REQUEST    ( ( uint8_t ) 8 )              /**< ICMP echo request. */
 #define ipICMP_ECHO_REPLY      ( ( uint8_t ) 0 )              /**< ICMP echo reply. */
+#define ipICMP_DEST_UNREACHABLE          ( ( uint8_t ) 3 ) /**< ICMP destination unreachable. */
+#define ipICMP_CODE_FRAGMENTATION_NEEDED ( ( uint8_t ) 4 ) /**< Destination unreachable: fragmentation needed and DF set. */
 
-#if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 )
+#if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) || ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
 
 /*
  * Process incoming ICMP packets.
  */
-    eFrameProcessingResult_t ProcessICMPPacket( const NetworkBufferDescriptor_t * const pxNetworkBuffer );
-#endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) */
+    eFrameProcessingResult_t ProcessICMPPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer );
+#endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) || ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 ) */
+
+#if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) && ( ipconfigUSE_DRIVER_RESPONDER != 0 )
+
+/*
+ * Turn a plain ICMP echo request to 'pxEndPoint' into a reply.  Used by
+ * xIPDriverRespond().
+ */
+    BaseType_t xICMPRespondInDriver( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                     const struct xNetworkEndPoint * pxEndPoint );
+#endif
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
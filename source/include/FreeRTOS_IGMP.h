@@ -0,0 +1,134 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_IGMP.h
+ * @brief Header file for multicast group membership ( IGMP and MLD ) for the FreeRTOS+TCP network stack.
+ */
+
+#ifndef FREERTOS_IGMP_H
+#define FREERTOS_IGMP_H
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Sockets.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+
+/* IGMP message types. */
+    #define igmpMEMBERSHIP_QUERY        ( ( uint8_t ) 0x11U ) /**< IGMP membership query. */
+    #define igmpV1_MEMBERSHIP_REPORT    ( ( uint8_t ) 0x12U ) /**< IGMPv1 membership report. */
+    #define igmpV2_MEMBERSHIP_REPORT    ( ( uint8_t ) 0x16U ) /**< IGMPv2 membership report. */
+    #define igmpV2_LEAVE_GROUP          ( ( uint8_t ) 0x17U ) /**< IGMPv2 leave group. */
+
+    #include "pack_struct_start.h"
+    struct xIGMP_HEADER
+    {
+        uint8_t ucTypeOfMessage;   /**< The IGMP type                      0 + 1 = 1 */
+        uint8_t ucMaxResponseTime; /**< Max response time of a query       1 + 1 = 2 */
+        uint16_t usChecksum;       /**< The checksum of the IGMP message   2 + 2 = 4 */
+        uint32_t ulGroupAddress;   /**< The multicast group address        4 + 4 = 8 */
+    }
+    #include "pack_struct_end.h"
+    typedef struct xIGMP_HEADER IGMPHeader_t;
+
+    #include "pack_struct_start.h"
+    struct xMLD_HEADER
+    {
+        uint8_t ucTypeOfMessage;       /**< The ICMPv6 type                  0 +  1 =  1 */
+        uint8_t ucCode;                /**< Always zero                      1 +  1 =  2 */
+        uint16_t usChecksum;           /**< The ICMPv6 checksum              2 +  2 =  4 */
+        uint16_t usMaxResponseDelay;   /**< Max response delay of a query    4 +  2 =  6 */
+        uint16_t usReserved;           /**< Reserved                         6 +  2 =  8 */
+        IPv6_Address_t xGroupAddress;  /**< The multicast group address      8 + 16 = 24 */
+    }
+    #include "pack_struct_end.h"
+    typedef struct xMLD_HEADER MLDHeader_t;
+
+/*
+ * Join or leave a multicast group on behalf of a UDP socket, called from
+ * FreeRTOS_setsockopt().  Returns 0 or a negative errno value.
+ */
+    BaseType_t xMulticastGroupJoin( FreeRTOS_Socket_t * pxSocket,
+                                    const FreeRTOS_MulticastRequest_t * pxRequest );
+
+    BaseType_t xMulticastGroupLeave( FreeRTOS_Socket_t * pxSocket,
+                                     const FreeRTOS_MulticastRequest_t * pxRequest );
+
+/*
+ * Drop all memberships of a socket that is being closed.
+ */
+    void vMulticastSocketClose( FreeRTOS_Socket_t * pxSocket );
+
+/*
+ * Called by the IP-task to program the MAC filters and to send the reports
+ * that are pending.
+ */
+    void vMulticastHandleEvent( void );
+
+/*
+ * The interface goes down: its MAC filters are lost.
+ */
+    void vMulticastInterfaceDown( struct xNetworkInterface * pxInterface );
+
+/*
+ * An end-point came up: announce the groups of its interface again.
+ */
+    void vMulticastEndPointUp( const struct xNetworkEndPoint * pxEndPoint );
+
+    #if ( ipconfigUSE_IPv4 != 0 )
+
+/*
+ * Process a received IGMP packet.
+ */
+        eFrameProcessingResult_t eProcessIGMPPacket( const NetworkBufferDescriptor_t * const pxNetworkBuffer );
+    #endif
+
+    #if ( ipconfigUSE_IPv6 != 0 )
+
+/*
+ * Process a received MLD query.
+ */
+        void vProcessMLDQuery( const NetworkBufferDescriptor_t * const pxNetworkBuffer );
+    #endif
+
+#endif /* ( ipconfigSUPPORT_IP_MULTICAST != 0 ) */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_IGMP_H */
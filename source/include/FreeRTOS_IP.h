@@ -149,23 +149,101 @@ extern uint32_t ulApplicationGetNextSequenceNumber( uint32_t ulSourceAddress,
     #define DEBUG_SET_TRACE_VARIABLE( var, value )                                 /**< Empty definition since ipconfigHAS_PRINTF != 1. */
 #endif
 
+#if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+    /* Set by the driver in a received buffer when the hardware has verified
+     * the IP and protocol checksums of that packet. */
+    #define ipBUFFER_CHECKSUM_VERIFIED    ( 0x01U )
+    /* Set by the stack in an outgoing buffer when the checksums were left
+     * out, the hardware must insert them. */
+    #define ipBUFFER_CHECKSUM_NEEDED      ( 0x02U )
+#endif
+
 /**
  * The structure used to store buffers and pass them around the network stack.
  * Buffers can be in use by the stack, in use by the network interface hardware
  * driver, or free (not in use).
  */
+#if ( ipconfigUSE_SCATTER_GATHER != 0 )
+
+/**
+ * A block of data that follows the contents of 'pucEthernetBuffer' in an
+ * outgoing frame, see ipconfigUSE_SCATTER_GATHER.
+ */
+    typedef struct xNETWORK_BUFFER_SEGMENT
+    {
+        const uint8_t * pucData;                                            /**< The data of the segment. */
+        size_t uxLength;                                                    /**< The number of bytes in 'pucData'. */
+        struct xNETWORK_BUFFER_SEGMENT * pxNext;                            /**< The next segment of the frame, or NULL. */
+        void ( * pfRelease )( struct xNETWORK_BUFFER_SEGMENT * pxSegment ); /**< Called when the data is not used anymore, may be NULL. */
+    } NetworkBufferSegment_t;
+#endif /* ipconfigUSE_SCATTER_GATHER */
+
+/**
+ * The header offsets of a received packet, see ipconfigUSE_PACKET_METADATA.
+ */
+typedef struct xPACKET_METADATA
+{
+    uint16_t usL3Offset; /**< The offset of the IP-header in 'pucEthernetBuffer'. */
+    uint16_t usL4Offset; /**< The offset of the TCP, UDP or ICMP header, after IPv4 options or IPv6 extension headers. */
+    uint16_t usL4Length; /**< The number of bytes from 'usL4Offset' up to the end of the IP payload. */
+    uint8_t ucProtocol;  /**< The protocol found at 'usL4Offset', e.g. ipPROTOCOL_TCP. */
+    uint8_t ucIsIPv6;    /**< pdTRUE_UNSIGNED for an IPv6 packet. */
+    uint8_t ucValid;     /**< pdTRUE_UNSIGNED when the fields describe the packet in the buffer. */
+} PacketMetadata_t;
+
+#if ( ( ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS != 0 ) && ( ipconfigUSE_IPv6 == 0 ) )
+
+/**
+ * The address field of a compact network buffer in an IPv4-only build, see
+ * ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS. It is accessed like IP_Address_t.
+ */
+    typedef union xNETWORK_BUFFER_ADDRESS
+    {
+        uint32_t ulIP_IPv4; /**< IPv4 address */
+    } NetworkBufferAddress_t;
+#else
+    typedef IP_Address_t NetworkBufferAddress_t;
+#endif
+
 typedef struct xNETWORK_BUFFER
 {
     ListItem_t xBufferListItem;                /**< Used to reference the buffer form the free buffer list or a socket. */
-    IP_Address_t xIPAddress;                   /**< Source or destination IP address, depending on usage scenario. */
+    NetworkBufferAddress_t xIPAddress;         /**< Source or destination IP address, depending on usage scenario. */
     uint8_t * pucEthernetBuffer;               /**< Pointer to the start of the Ethernet frame. */
     size_t xDataLength;                        /**< Starts by holding the total Ethernet frame length, then the UDP/TCP payload length. */
     struct xNetworkInterface * pxInterface;    /**< The interface on which the packet was received. */
     struct xNetworkEndPoint * pxEndPoint;      /**< The end-point through which this packet shall be sent. */
     uint16_t usPort;                           /**< Source or destination port, depending on usage scenario. */
     uint16_t usBoundPort;                      /**< The port to which a transmitting socket is bound. */
-    #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-        struct xNETWORK_BUFFER * pxNextBuffer; /**< Possible optimisation for expert users - requires network driver support. */
+    /* The small members follow the ports, so that they share padding. */
+    #if ( ipconfigUSE_TCP_TSO != 0 )
+        uint16_t usTCPSegmentSize; /**< Non-zero for a large TCP packet that the driver must split in segments of this size. */
+    #endif
+    #if ( ipconfigUSE_VLAN != 0 )
+        uint16_t usVLANTag; /**< The 802.1Q tag that the driver stripped or must insert, zero for none, see ipconfigUSE_VLAN. */
+    #endif
+    #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+        uint8_t ucChecksumFlags; /**< ipBUFFER_CHECKSUM_VERIFIED and/or ipBUFFER_CHECKSUM_NEEDED. */
+    #endif
+    struct xNETWORK_BUFFER * pxNextBuffer; /**< Links received frames in a single eNetworkRxEvent, or datagrams in an eStackTxBatchEvent. */
+    #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+        NetworkBufferSegment_t * pxSegments; /**< Data that follows the 'xDataLength' bytes of 'pucEthernetBuffer', see ipconfigUSE_SCATTER_GATHER. */
+    #endif
+    #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+        UBaseType_t uxExtraReferences; /**< The number of owners besides the first one, see ipconfigUSE_NETWORK_BUFFER_REFCOUNT. */
+    #endif
+    #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+        BaseType_t xBulkQuota; /**< pdTRUE when obtained with pxGetBulkNetworkBufferWithDescriptor(). */
+    #endif
+    #if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 )
+        BaseType_t xCacheCleanNeeded; /**< pdTRUE when the data cache must be cleaned before DMA reads the buffer. */
+    #endif
+    #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+        NetworkTimestamp_t xTimestamp; /**< The time of reception, filled in by the driver, zero when not known. */
+        uint8_t ucTxTimestamp;         /**< pdTRUE_UNSIGNED when the driver shall call vNetworkBufferTxTimestamp() once the frame has been sent. */
+    #endif
+    #if ( ipconfigUSE_PACKET_METADATA != 0 )
+        PacketMetadata_t xMetadata; /**< Filled in by vPacketMetadataParse() for a received packet. */
     #endif
 
 #define ul_IPAddress     xIPAddress.xIP_IPv4
@@ -315,6 +393,13 @@ uint32_t FreeRTOS_round_down( uint32_t a,
  * from FreeRTOS_Routing.h. */
 BaseType_t FreeRTOS_IPInit_Multi( void );
 
+#if ( ipconfigIP_RUN_TO_COMPLETION != 0 )
+
+/* Without an IP-task, the application drives the network timers by calling
+ * this function regularly. It returns the time until the next timer expires. */
+    TickType_t FreeRTOS_IPProcessTimers( void );
+#endif
+
 struct xNetworkInterface;
 
 #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
@@ -381,6 +466,17 @@ BaseType_t FreeRTOS_SendPingRequest( uint32_t ulIPAddress,
                                      TickType_t uxBlockTimeTicks );
 
 void FreeRTOS_ReleaseUDPPayloadBuffer( void const * pvBuffer );
+
+#if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+/* Get the time at which a UDP payload, received with FREERTOS_ZERO_COPY, arrived. */
+    BaseType_t FreeRTOS_GetUDPPayloadTimestamp( void const * pvBuffer,
+                                                NetworkTimestamp_t * pxTimestamp );
+
+/* Called by a driver, from a task, once a frame that has 'ucTxTimestamp' set
+ * has been sent. */
+    void vNetworkBufferTxTimestamp( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                    const NetworkTimestamp_t * pxTimestamp );
+#endif
 const uint8_t * FreeRTOS_GetMACAddress( void );
 void FreeRTOS_UpdateMACAddress( const uint8_t ucMACAddress[ ipMAC_ADDRESS_LENGTH_BYTES ] );
 #if ( ipconfigUSE_NETWORK_EVENT_HOOK == 1 )
@@ -409,6 +505,73 @@ BaseType_t FreeRTOS_IsNetworkUp( void );
     UBaseType_t uxGetMinimumIPQueueSpace( void );
 #endif
 
+#if ( ipconfigUSE_IP_TASK_STATS != 0 )
+
+/* The number of event types of the IP-task, eNoEvent up to eNetworkTxReadyEvent. */
+    #define ipIP_TASK_STATS_EVENT_TYPES    22U
+
+/** @brief The handling of one type of IP-task event, in units of ipconfigIP_TASK_STATS_TIME(). */
+    typedef struct xIPTaskEventStats
+    {
+        uint32_t ulCount;      /**< The number of events handled. */
+        uint32_t ulMaxTime;    /**< The longest time spent handling a single event. */
+        uint64_t ullTotalTime; /**< The total time spent handling these events. */
+    } IPTaskEventStats_t;
+
+/** @brief Load and latency of the IP-task, see ipconfigUSE_IP_TASK_STATS. */
+    typedef struct xIPTaskStats
+    {
+        IPTaskEventStats_t xEvents[ ipIP_TASK_STATS_EVENT_TYPES ];   /**< Indexed by 'eEventType + 1', entry 0 counts the time-outs (eNoEvent). */
+        IPTaskEventStats_t xTimers;                                  /**< The periodic checks of vCheckNetworkTimers(). */
+        uint32_t ulLatency[ ipconfigIP_TASK_STATS_LATENCY_BUCKETS ]; /**< Histogram of the time that events waited in the queue. */
+        uint32_t ulMaxLatency;                                       /**< The longest time that an event waited in the queue. */
+        UBaseType_t uxQueueHighWater;                                /**< The highest number of events waiting in the queue. */
+        uint64_t ullBusyTime;                                        /**< The total time spent handling events and timers. */
+        uint32_t ulStartTime;                                        /**< The time at which the statistics were last cleared. */
+    } IPTaskStats_t;
+
+    void FreeRTOS_GetIPTaskStats( IPTaskStats_t * pxStats );
+
+    void FreeRTOS_ClearIPTaskStats( void );
+#endif /* ( ipconfigUSE_IP_TASK_STATS != 0 ) */
+
+#if ( ipconfigUSE_RESOURCE_STATS != 0 )
+
+/** @brief The use of one kind of resource, see ipconfigUSE_RESOURCE_STATS. */
+    typedef struct xIPResourceUsage
+    {
+        size_t uxTotal;       /**< The number that can be used, or zero when only the heap limits it. */
+        size_t uxUsed;        /**< The number in use now. */
+        size_t uxPeak;        /**< The highest number in use since start-up, or since FreeRTOS_ClearResourceStats(). */
+        uint32_t ulShortages; /**< The number of times that the resource ran out, or zero when it is not counted. */
+    } IPResourceUsage_t;
+
+/** @brief The resources of the stack, as returned by FreeRTOS_GetResourceStats(). */
+    typedef struct xIPResourceStats
+    {
+        IPResourceUsage_t xNetworkBuffers; /**< Network buffer descriptors. */
+        IPResourceUsage_t xEventQueue;     /**< Messages waiting in the event queue of the IP-task. */
+        IPResourceUsage_t xTCPSegments;    /**< Segment descriptors of the TCP sliding windows. */
+        IPResourceUsage_t xSockets;        /**< UDP and TCP sockets. */
+        IPResourceUsage_t xStreamBytes;    /**< Bytes allocated for the streams of TCP sockets, including the stream pool. */
+        IPResourceUsage_t xARPCache;       /**< Occupied rows of the ARP cache. */
+        IPResourceUsage_t xNDCache;        /**< Occupied rows of the ND cache. */
+        IPResourceUsage_t xDNSCache;       /**< Occupied rows of the DNS cache. */
+        IPResourceUsage_t xStackHeap;      /**< Bytes of heap held by sockets, streams and the segment pool. */
+        size_t uxHeapFree;                 /**< The free heap, as returned by xPortGetFreeHeapSize(). */
+        size_t uxHeapMinimumEverFree;      /**< The lowest free heap, as returned by xPortGetMinimumEverFreeHeapSize(). */
+    } IPResourceStats_t;
+
+    void FreeRTOS_GetResourceStats( IPResourceStats_t * pxStats );
+
+    void FreeRTOS_ClearResourceStats( void );
+
+/* Write the sizes of the resources that fit the observed workload as a
+ * FreeRTOSIPConfig.h fragment.  Returns the length of the text. */
+    size_t FreeRTOS_GetRecommendedConfig( char * pcBuffer,
+                                          size_t uxBufferLength );
+#endif /* ( ipconfigUSE_RESOURCE_STATS != 0 ) */
+
 BaseType_t xIsNetworkDownEventPending( void );
 
 /*
@@ -55,6 +55,17 @@ typedef struct xxIPv46_Address
     BaseType_t xIs_IPv6;     /**< pdTRUE if IPv6 address. */
 } IPv46_Address_t;
 
+#if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+
+/** @brief The time at which a frame was received or sent, as reported by the
+ *  driver.  Both fields are zero when the time is not known. */
+    typedef struct xNETWORK_TIMESTAMP
+    {
+        uint32_t ulSeconds;     /**< Seconds, the epoch depends on the clock of the driver. */
+        uint32_t ulNanoseconds; /**< Nanoseconds, 0 to 999999999. */
+    } NetworkTimestamp_t;
+#endif /* ipconfigUSE_NETWORK_TIMESTAMPS != 0 */
+
 struct xNetworkEndPoint;
 struct xNetworkInterface;
 
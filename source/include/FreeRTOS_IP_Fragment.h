@@ -0,0 +1,112 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_IP_Fragment.h
+ * @brief Header file for the reassembly and fragmentation of IP datagrams.
+ */
+
+#ifndef FREERTOS_IP_FRAGMENT_H
+#define FREERTOS_IP_FRAGMENT_H
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+
+/* The offset of a fragment is expressed in units of 8 bytes. */
+    #define ipFRAGMENT_BLOCK_SIZE           ( 8U )
+
+/* The "more fragments" flag in the host-order offset field of an IPv6 fragment header. */
+    #define ipIPv6_FRAGMENT_MORE            ( ( uint16_t ) 0x0001U )
+
+/* The offset bits in the host-order offset field of an IPv6 fragment header. */
+    #define ipIPv6_FRAGMENT_OFFSET_MASK     ( ( uint16_t ) 0xfff8U )
+
+    #if ( ipconfigUSE_IPv6 != 0 )
+        #include "pack_struct_start.h"
+        struct xIPv6_FRAGMENT_HEADER
+        {
+            uint8_t ucNextHeader;       /**< The header that follows the reassembled IPv6 header.   0 + 1 = 1 */
+            uint8_t ucReserved;         /**< Always zero.                                             1 + 1 = 2 */
+            uint16_t usFragmentOffset;  /**< The offset in units of 8 bytes and the M flag.           2 + 2 = 4 */
+            uint32_t ulIdentification;  /**< Shared by all fragments of a datagram.                   4 + 4 = 8 */
+        }
+        #include "pack_struct_end.h"
+        typedef struct xIPv6_FRAGMENT_HEADER IPv6FragmentHeader_t;
+    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+    #if ( ipconfigUSE_IPv4 != 0 )
+
+/*
+ * Store a received IPv4 fragment. When the datagram is complete, it will be
+ * passed to the IP-task as a new packet. The fragment is always copied, the
+ * caller keeps ownership of the network buffer.
+ */
+        eFrameProcessingResult_t eIPv4Reassemble( const NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                  size_t uxIPHeaderLength );
+    #endif
+
+    #if ( ipconfigUSE_IPv6 != 0 )
+
+/*
+ * Store a received IPv6 packet with a fragment header directly after the IPv6
+ * header, see eIPv4Reassemble().
+ */
+        eFrameProcessingResult_t eIPv6Reassemble( const NetworkBufferDescriptor_t * const pxNetworkBuffer );
+    #endif
+
+/*
+ * Release the datagrams that are waiting too long for their missing fragments.
+ * Called by the IP-task.
+ */
+    void vIPReassemblyCheckTimeout( void );
+
+/*
+ * Send a datagram that is larger than the MTU of the interface in fragments.
+ * The network buffer will be released.
+ */
+    void vIPFragmentOutput( struct xNetworkInterface * pxInterface,
+                            NetworkBufferDescriptor_t * pxNetworkBuffer,
+                            size_t uxMTU );
+
+#endif /* ( ipconfigUSE_IP_FRAGMENTATION != 0 ) */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_IP_FRAGMENT_H */
@@ -84,7 +84,14 @@ typedef enum
     eSocketCloseEvent,    /*10: Send a message to the IP-task to close a socket. */
     eSocketSelectEvent,   /*11: Send a message to the IP-task for select(). */
     eSocketSignalEvent,   /*12: A socket must be signalled. */
-    eSocketSetDeleteEvent /*13: A socket set must be deleted. */
+    eSocketSetDeleteEvent,/*13: A socket set must be deleted. */
+    eNetworkRxRingEvent,  /*14: The receive ring of the network interface in pvData has buffers. */
+    eStackTxBatchEvent,   /*15: The software stack has queued a chain of packets to transmit. */
+    eMulticastGroupEvent, /*16: The table of joined multicast groups has changed. */
+    eStackTxReadyEvent,   /*17: A connected UDP socket has queued a packet with complete headers. */
+    eNetworkPollEvent,    /*18: The network interface in pvData wants to be polled by the IP-task. */
+    eSocketAsyncEvent,    /*19: The asynchronous ring in pvData has new requests or socket events. */
+    eNetworkTxReadyEvent  /*20: The transmit ring of the network interface in pvData has room again. */
 } eIPEvent_t;
 
 /**
@@ -190,6 +197,51 @@ struct xTCP_HEADER
 #include "pack_struct_end.h"
 typedef struct xTCP_HEADER TCPHeader_t;
 
+#if ( ipconfigUSE_ALIGNED_HEADER_ACCESS != 0 )
+
+/* Non-packed views of the UDP and TCP headers, with the same layout as the
+ * structs above. Like IPHeaderView_t, they may only be mapped onto a header
+ * that starts at a 32-bit aligned address. */
+    struct xUDP_HEADER_VIEW
+    {
+        uint16_t usSourcePort;      /**< The source port                      0 + 2 = 2 */
+        uint16_t usDestinationPort; /**< The destination port                 2 + 2 = 4 */
+        uint16_t usLength;          /**< The size of the whole UDP packet     4 + 2 = 6 */
+        uint16_t usChecksum;        /**< The checksum of the whole UDP Packet 6 + 2 = 8 */
+    };
+    typedef struct xUDP_HEADER_VIEW UDPHeaderView_t;
+
+    struct xTCP_HEADER_VIEW
+    {
+        uint16_t usSourcePort;                       /**< The Source port                      +  2 =  2 */
+        uint16_t usDestinationPort;                  /**< The destination port                 +  2 =  4 */
+        uint32_t ulSequenceNumber;                   /**< The Sequence number                  +  4 =  8 */
+        uint32_t ulAckNr;                            /**< The acknowledgement number           +  4 = 12 */
+        uint8_t ucTCPOffset;                         /**< The value of TCP offset              +  1 = 13 */
+        uint8_t ucTCPFlags;                          /**< The TCP-flags field                  +  1 = 14 */
+        uint16_t usWindow;                           /**< The size of the receive window       +  2 = 15 */
+        uint16_t usChecksum;                         /**< The checksum of the header           +  2 = 18 */
+        uint16_t usUrgent;                           /**< Pointer to the last urgent data byte +  2 = 20 */
+        #if ipconfigUSE_TCP == 1
+            uint8_t ucOptdata[ ipSIZE_TCP_OPTIONS ]; /**< The options + 12 = 32 */
+        #endif
+    };
+    typedef struct xTCP_HEADER_VIEW TCPHeaderView_t;
+
+    STATIC_ASSERT( sizeof( UDPHeaderView_t ) == sizeof( UDPHeader_t ) );
+    STATIC_ASSERT( sizeof( TCPHeaderView_t ) == sizeof( TCPHeader_t ) );
+
+/* Check that a received or generated packet meets the promise made by
+ * ipconfigUSE_ALIGNED_HEADER_ACCESS. */
+    #define ipASSERT_IP_HEADER_ALIGNED( pucEthernetBuffer ) \
+    configASSERT( ( ( ( uintptr_t ) &( ( pucEthernetBuffer )[ ipSIZE_OF_ETH_HEADER ] ) ) & 0x03U ) == 0U )
+#else
+    typedef UDPHeader_t UDPHeaderView_t;
+    typedef TCPHeader_t TCPHeaderView_t;
+
+    #define ipASSERT_IP_HEADER_ALIGNED( pucEthernetBuffer )    do {} while( ipFALSE_BOOL )
+#endif /* ipconfigUSE_ALIGNED_HEADER_ACCESS */
+
 #include "pack_struct_start.h"
 struct xARP_PACKET
 {
@@ -234,8 +286,18 @@ typedef struct IP_TASK_COMMANDS
 {
     eIPEvent_t eEventType; /**< The event-type enum */
     void * pvData;         /**< The data in the event */
+    #if ( ipconfigUSE_IP_TASK_STATS != 0 )
+        uint32_t ulEnqueueTime; /**< ipconfigIP_TASK_STATS_TIME() at the moment the event was queued. */
+    #endif
 } IPStackEvent_t;
 
+#if ( ipconfigUSE_IP_TASK_STATS != 0 )
+    /* Stamp an event, just before it is sent to 'xNetworkEventQueue'. */
+    #define ipSTAMP_IP_TASK_EVENT( xEvent )    ( ( xEvent ).ulEnqueueTime = ipconfigIP_TASK_STATS_TIME() )
+#else
+    #define ipSTAMP_IP_TASK_EVENT( xEvent )    do {} while( ipFALSE_BOOL )
+#endif
+
 /** @brief This struct describes a packet, it is used by the function
  * usGenerateProtocolChecksum(). */
 struct xPacketSummary
@@ -255,6 +317,8 @@ struct xPacketSummary
     ProtocolHeaders_t * pxProtocolHeaders; /**< Points to first byte after IP-header */
     uint16_t usPayloadLength;              /**< Property of IP-header (for IPv4: length of IP-header included) */
     uint16_t usProtocolBytes;              /**< The total length of the protocol data. */
+    size_t uxPayloadSumLength;             /**< The number of trailing bytes that are already summed in usPayloadSum. */
+    uint16_t usPayloadSum;                 /**< The one's complement sum of those bytes. */
 };
 
 #define ipBROADCAST_IP_ADDRESS               0xffffffffU
@@ -264,6 +328,12 @@ struct xPacketSummary
  * as it is past the location into which the destination address will get placed. */
 #define ipFRAGMENTATION_PARAMETERS_OFFSET    ( 6 )
 #define ipSOCKET_OPTIONS_OFFSET              ( 6 )
+#define ipSOCKET_DSCP_OFFSET                 ( 7 )
+
+/* The DSCP occupies the upper 6 bits of the IPv4 DS field and of the IPv6
+ * traffic class. */
+#define ipDSCP_MAX                           ( 63U )
+#define ipDSCP_SHIFT                         ( 2U )
 
 
 #if ( ipconfigBYTE_ORDER == pdFREERTOS_LITTLE_ENDIAN )
@@ -271,6 +341,7 @@ struct xPacketSummary
 /* Ethernet frame types. */
     #define ipARP_FRAME_TYPE                   ( 0x0608U )
     #define ipIPv4_FRAME_TYPE                  ( 0x0008U )
+    #define ipVLAN_FRAME_TYPE                  ( 0x0081U )
 
 /* ARP related definitions. */
     #define ipARP_PROTOCOL_TYPE                ( 0x0008U )
@@ -295,6 +366,7 @@ struct xPacketSummary
 /* Ethernet frame types. */
     #define ipARP_FRAME_TYPE                   ( 0x0806U )
     #define ipIPv4_FRAME_TYPE                  ( 0x0800U )
+    #define ipVLAN_FRAME_TYPE                  ( 0x8100U )
 
 /* ARP related definitions. */
     #define ipARP_PROTOCOL_TYPE                ( 0x0800U )
@@ -316,6 +388,13 @@ struct xPacketSummary
 
 #endif /* ipconfigBYTE_ORDER */
 
+/* The largest IP packet, IP header included, that the stack will accept. */
+#if ( ipconfigUSE_IP_FRAGMENTATION != 0 )
+    #define ipMAX_IP_PACKET_SIZE    ( ( size_t ) ipconfigIP_FRAGMENTATION_MAX_SIZE )
+#else
+    #define ipMAX_IP_PACKET_SIZE    ( ( size_t ) ipconfigNETWORK_MTU )
+#endif
+
 /* For convenience, a MAC address of all zeros and another of all 0xffs are
  * defined const for quick reference. */
 extern const MACAddress_t xBroadcastMACAddress; /* all 0xff's */
@@ -416,6 +495,14 @@ extern struct xNetworkInterface * pxNetworkInterfaces;
 void FreeRTOS_NetworkDown( struct xNetworkInterface * pxNetworkInterface );
 BaseType_t FreeRTOS_NetworkDownFromISR( struct xNetworkInterface * pxNetworkInterface );
 
+/*
+ * To be called by a driver whose pfInitialise() returned pdFAIL because it was
+ * still waiting for its PHY, as soon as it is ready.  The IP-task will then
+ * call pfInitialise() again straight away, instead of after the retry delay.
+ * Interfaces that are up are not affected.
+ */
+void FreeRTOS_NetworkInterfaceReady( struct xNetworkInterface * pxNetworkInterface );
+
 /*
  * Processes incoming ARP packets.
  */
@@ -435,6 +522,44 @@ uint16_t usGenerateChecksum( uint16_t usSum,
                              const uint8_t * pucNextData,
                              size_t uxByteCount );
 
+/*
+ * Add uxWordCount 32-bit words from the aligned pointer pulData to ulSum,
+ * with end-around carry.  Used by usGenerateChecksum() when
+ * ipconfigUSE_CHECKSUM_KERNEL is enabled, implemented in
+ * source/portable/Checksum.
+ */
+uint32_t ulChecksumKernel( uint32_t ulSum,
+                           const uint32_t * pulData,
+                           size_t uxWordCount );
+
+/*
+ * Update a checksum after one 16-bit word of the data has changed from
+ * usOldWord to usNewWord ( RFC 1624 ).  All values as stored in the packet.
+ */
+uint16_t usIncrementalChecksum( uint16_t usChecksum,
+                                uint16_t usOldWord,
+                                uint16_t usNewWord );
+
+/* Connected UDP sockets and the ACK templates of TCP sockets keep copies of
+ * Ethernet and IP headers, which are only valid as long as the ARP and ND
+ * caches and the end-points don't change. */
+#if ( ( ipconfigUSE_UDP_CONNECT != 0 ) || ( ipconfigUSE_TCP_ACK_TEMPLATE != 0 ) )
+    #define ipHEADER_CACHE    1
+#else
+    #define ipHEADER_CACHE    0
+#endif
+
+#if ( ipHEADER_CACHE != 0 )
+
+/* Incremented each time the ARP or ND cache changes, or an end-point goes up
+ * or down. A copy of the headers is only used while this value has not
+ * changed. */
+    extern volatile uint32_t ulIPHeaderCacheGeneration;
+
+/* Drop all copies of headers. */
+    void vIPHeaderCacheInvalidate( void );
+#endif
+
 /* Socket related private functions. */
 
 /*
@@ -485,6 +610,15 @@ BaseType_t xIPIsNetworkTaskReady( void );
  */
     TickType_t xTCPTimerCheck( BaseType_t xWillSleep );
 
+    #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
+/*
+ * An interface has room to send again: let the sockets that stopped sending
+ * because of ipTX_BUSY continue.
+ */
+        void vTCPResumeTxPaused( void );
+    #endif
+
 /**
  * About the TCP flags 'bPassQueued' and 'bPassAccept':
  *
@@ -520,6 +654,56 @@ BaseType_t xIPIsNetworkTaskReady( void );
         } u; /**< The structure to give an alignment of 4 + 2 */
     } LastTCPPacket_t;
 
+    #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+
+/** @brief A buffer owned by the application, of which the data is sent
+ *  without copying it into txStream.  The space that it occupies in txStream
+ *  is reserved, but not written. */
+        typedef struct xTCP_TX_REFERENCE
+        {
+            const uint8_t * pucData;                /**< The buffer passed to FreeRTOS_send_reference(). */
+            size_t uxLength;                        /**< The length of that buffer. */
+            size_t uxAcked;                         /**< The number of bytes that have been acknowledged already. */
+            size_t uxStreamPos;                     /**< The position in txStream of the first byte of the buffer. */
+            FOnTCPReferenceReleased_t pxOnReleased; /**< Called when the buffer is not used any more. */
+            void * pvArgument;                      /**< Passed to 'pxOnReleased'. */
+        } TCPTxReference_t;
+    #endif /* ipconfigTCP_TX_REFERENCE_COUNT != 0 */
+
+    #if ( ipconfigUSE_TCP_ACK_TEMPLATE != 0 )
+
+/** @brief The headers of the packets that an established connection sends,
+ *  copied from a packet that was sent after a successful ARP or ND look-up.
+ *  Pure ACK's and window updates are made by copying these headers and
+ *  patching the fields that change. */
+        typedef struct xTCP_ACK_TEMPLATE
+        {
+            BaseType_t xValid;                    /**< The members below hold a usable copy of the headers. */
+            uint32_t ulGeneration;                /**< The value of ulIPHeaderCacheGeneration when the headers were copied. */
+            struct xNetworkEndPoint * pxEndPoint; /**< The end-point through which the peer is reached. */
+            uint16_t usSourcePort;                /**< The TCP source port, in network byte order. */
+            uint16_t usDestinationPort;           /**< The TCP destination port, in network byte order. */
+            uint16_t usIPChecksum;                /**< IPv4: the header checksum with zero length and identification. */
+            uint16_t usPseudoSum;                 /**< The sum of the pseudo-header without the length, and the ports. */
+            uint8_t ucHeader[ ipSIZE_OF_ETH_HEADER + 40U ]; /**< The Ethernet and IP headers, room for an IPv6 header. */
+        } TCPAckTemplate_t;
+    #endif /* ipconfigUSE_TCP_ACK_TEMPLATE != 0 */
+
+    #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+
+/** @brief A network buffer that is kept by a socket in buffer-chain mode.
+ *  Its payload occupies space in rxStream, which is reserved, but not
+ *  written. */
+        typedef struct xTCP_RX_BUFFER
+        {
+            NetworkBufferDescriptor_t * pxBuffer; /**< The network buffer that holds the data. */
+            uint8_t * pucData;                    /**< The first byte of the payload within that buffer. */
+            size_t uxLength;                      /**< The number of payload bytes. */
+            size_t uxConsumed;                    /**< The number of bytes that the application has read already. */
+            size_t uxStreamPos;                   /**< The position in rxStream of the first byte of the payload. */
+        } TCPRxBuffer_t;
+    #endif /* ipconfigTCP_RX_BUFFER_COUNT != 0 */
+
 /**
  * Note that the values of all short and long integers in these structs
  * are being stored in the native-endian way
@@ -528,8 +712,22 @@ BaseType_t xIPIsNetworkTaskReady( void );
  */
     typedef struct TCPSOCKET
     {
-        IP_Address_t xRemoteIP; /**< IP address of remote machine */
-        uint16_t usRemotePort;  /**< Port on remote machine */
+        /* The members up to and including 'xTCPWindow' are used for every packet
+         * that is sent or received, keep them together at the start of the
+         * struct so that they share as few cache lines as possible. */
+        IP_Address_t xRemoteIP;           /**< IP address of remote machine */
+        uint16_t usRemotePort;            /**< Port on remote machine */
+        eIPTCPState_t eTCPState;          /**< TCP state: see eTCP_STATE */
+        uint8_t tcpflags;                 /**< TCP flags */
+        uint16_t usMSS;                   /**< Current Maximum Segment Size */
+        uint16_t usTimeout;               /**< Time (in ticks) after which this socket needs attention */
+        uint8_t ucRepCount;               /**< Send repeat count, for retransmissions
+                                           * This counter is separate from the xmitCount in the
+                                           * TCP win segments */
+        #if ( ipconfigUSE_TCP_WIN != 0 )
+            uint8_t ucMyWinScaleFactor;   /**< Scaling factor of this device. */
+            uint8_t ucPeerWinScaleFactor; /**< Scaling factor of the peer. */
+        #endif
         struct
         {
             /* Most compilers do like bit-flags */
@@ -557,40 +755,122 @@ BaseType_t xIPIsNetworkTaskReady( void );
                 bFinLast : 1,          /**< The last ACK (after FIN and FIN+ACK) has been sent or will be sent by the peer */
                 bRxStopped : 1,        /**< Application asked to temporarily stop reception */
                 bMallocError : 1,      /**< There was an error allocating a stream */
-                bWinScaling : 1;       /**< A TCP-Window Scaling option was offered and accepted in the SYN phase. */
-        } bits;                        /**< The bits structure */
-        uint32_t ulHighestRxAllowed;   /**< The highest sequence number that we can receive at any moment */
-        uint16_t usTimeout;            /**< Time (in ticks) after which this socket needs attention */
-        uint16_t usMSS;                /**< Current Maximum Segment Size */
-        uint16_t usChildCount;         /**< In case of a listening socket: number of connections on this port number */
-        uint16_t usBacklog;            /**< In case of a listening socket: maximum number of concurrent connections on this port number */
-        uint8_t ucRepCount;            /**< Send repeat count, for retransmissions
-                                        * This counter is separate from the xmitCount in the
-                                        * TCP win segments */
-        eIPTCPState_t eTCPState;       /**< TCP state: see eTCP_STATE */
-        struct xSOCKET * pxPeerSocket; /**< for server socket: child, for child socket: parent */
-        #if ( ipconfigTCP_KEEP_ALIVE == 1 )
-            uint8_t ucKeepRepCount;
-            TickType_t xLastAliveTime; /**< The last value of keepalive time.*/
-        #endif /* ipconfigTCP_KEEP_ALIVE */
-        #if ( ipconfigTCP_HANG_PROTECTION == 1 )
-            TickType_t xLastActTime;                  /**< The last time when hang-protection was done.*/
-        #endif /* ipconfigTCP_HANG_PROTECTION */
+                bWinScaling : 1,       /**< A TCP-Window Scaling option was offered and accepted in the SYN phase. */
+                bTimeStamps : 1,       /**< The TCP time-stamps option was offered and accepted in the SYN phase. */
+                bTimeStampSeen : 1,    /**< The segment being processed carries a time-stamps option. */
+            #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+                bNoAutoTune : 1,       /**< The stream sizes were set by the application or the streams are accessed directly: do not tune them. */
+                bAutoTuneInit : 1,     /**< A measurement for ipconfigUSE_TCP_AUTO_TUNING has been started. */
+            #endif /* ipconfigUSE_TCP_AUTO_TUNING */
+            #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+                bFixedSizes : 1,       /**< The stream sizes or water marks were set by the application: do not size them after the link speed. */
+            #endif
+            #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+                bTxPaused : 1,         /**< Sending stopped because the interface returned ipTX_BUSY, see ipconfigUSE_TX_BACKPRESSURE. */
+            #endif
+            #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+                bKeepTxStream : 1,     /**< The application uses the TX stream directly, it will not be released. */
+                bRxStreamIdle : 1,     /**< The RX stream has been empty since xRxStreamIdleTime. */
+                bTxStreamIdle : 1,     /**< The TX stream has been empty since xTxStreamIdleTime. */
+            #endif /* ipconfigTCP_STREAM_RELEASE_TIME */
+            #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+                bFastOpen : 1,         /**< TCP Fast Open was enabled with FREERTOS_SO_TCP_FASTOPEN. */
+                bFastOpenSeen : 1,     /**< The SYN or SYN+ACK being processed carries a Fast Open option. */
+                bFastOpenValid : 1,    /**< The SYN being processed carries a valid cookie. */
+            #endif /* ipconfigUSE_TCP_FAST_OPEN */
+            #if ( ipconfigUSE_TCP_REUSEPORT != 0 )
+                bReusePort : 1,        /**< Other listening sockets may share the port, see FREERTOS_SO_REUSEPORT. */
+            #endif
+                bRxBufferChain : 1,    /**< Keep received network buffers instead of copying their payload, see FREERTOS_SO_RX_BUFFER_CHAIN. */
+                bCork : 1,             /**< Hold back data that does not fill a segment, see FREERTOS_SO_TCP_CORK. */
+                bMore : 1;             /**< The last call to FreeRTOS_send() had the flag FREERTOS_MSG_MORE. */
+        } bits;                                       /**< The bits structure */
+        uint32_t ulHighestRxAllowed;                  /**< The highest sequence number that we can receive at any moment */
+        uint32_t ulWindowSize;                        /**< Current Window size advertised by peer */
+        size_t uxRxWinSize;                           /**< Fixed value: size of the TCP reception window */
+        size_t uxTxWinSize;                           /**< Fixed value: size of the TCP transmit window */
         size_t uxLittleSpace;                         /**< The value deemed as low amount of space. */
         size_t uxEnoughSpace;                         /**< The value deemed as enough space. */
         size_t uxRxStreamSize;                        /**< The Receive stream size */
         size_t uxTxStreamSize;                        /**< The transmit stream size */
         StreamBuffer_t * rxStream;                    /**< The pointer to the receive stream buffer. */
         StreamBuffer_t * txStream;                    /**< The pointer to the transmit stream buffer. */
+        #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+            StreamBuffer_t * pxStaticRxStream;        /**< The receive stream in memory provided by the application, or NULL. */
+            StreamBuffer_t * pxStaticTxStream;        /**< The transmit stream in memory provided by the application, or NULL. */
+        #endif
         #if ( ipconfigUSE_TCP_WIN == 1 )
             NetworkBufferDescriptor_t * pxAckMessage; /**< The pointer to the ACK message */
         #endif /* ipconfigUSE_TCP_WIN */
-        LastTCPPacket_t xPacket;                      /**< Buffer space to store the last TCP header received. */
-        uint8_t tcpflags;                             /**< TCP flags */
-        #if ( ipconfigUSE_TCP_WIN != 0 )
-            uint8_t ucMyWinScaleFactor;               /**< Scaling factor of this device. */
-            uint8_t ucPeerWinScaleFactor;             /**< Scaling factor of the peer. */
+        #if ( ( ipconfigUSE_TCP_AUTO_TUNING != 0 ) || ( ipconfigTCP_STREAM_RELEASE_TIME != 0 ) )
+            volatile uint8_t ucRxStreamUsers; /**< Non-zero while FreeRTOS_recv() is accessing the RX stream. */
+            volatile uint8_t ucTxStreamUsers; /**< Non-zero while an API function is accessing the TX stream. */
+        #endif
+        #if ( ipconfigTCP_TX_COPY_CHECKSUM != 0 )
+            size_t uxTxPayloadSumLength;      /**< Length of the payload that was summed while copying it from txStream. */
+            uint16_t usTxPayloadSum;          /**< The sum of that payload. */
+        #endif
+        #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+            uint32_t ulTimeStampRecent;       /**< TS.Recent: the time-stamp of the peer that is echoed in TSecr. */
+            uint32_t ulTimeStampValue;        /**< The TSval of the segment being processed. */
+            uint32_t ulTimeStampEchoReply;    /**< The TSecr of the segment being processed. */
+        #endif
+        #if ( ipconfigUSE_TCP_ACK_POLICY != 0 )
+            TCPAckPolicy_t xAckPolicy; /**< The ACK policy, see FREERTOS_SO_TCP_ACK_POLICY. */
+            uint8_t ucAckSegments;     /**< The number of segments received since the last ACK was sent. */
+            TickType_t xAckRxTime;     /**< The time at which the last segment with data was received. */
+        #endif
+        LastTCPPacket_t xPacket; /**< Buffer space to store the last TCP header received. */
+        TCPWindow_t xTCPWindow;  /**< The TCP window struct*/
+
+        #if ( ipconfigUSE_TCP_ACK_TEMPLATE != 0 )
+            TCPAckTemplate_t xAckTemplate; /**< The headers used to send pure ACK's, see prvTCPAckTemplateSend(). */
+        #endif
+        #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+            TCPTxReference_t xTxReferences[ ipconfigTCP_TX_REFERENCE_COUNT ]; /**< The buffers queued by FreeRTOS_send_reference(), used as a circular buffer. */
+            UBaseType_t uxTxReferenceFirst;                                   /**< The index of the oldest buffer in xTxReferences[]. */
+            UBaseType_t uxTxReferenceCount;                                   /**< The number of buffers in xTxReferences[]. */
+        #endif
+        #if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+            TCPRxBuffer_t xRxBuffers[ ipconfigTCP_RX_BUFFER_COUNT ]; /**< The network buffers kept in buffer-chain mode, used as a circular buffer. */
+            UBaseType_t uxRxBufferFirst;                             /**< The index of the oldest buffer in xRxBuffers[]. */
+            UBaseType_t uxRxBufferCount;                             /**< The number of buffers in xRxBuffers[]. */
+        #endif
+        #if ( ipconfigUSE_TCP_PACING != 0 )
+            uint32_t ulPacingRate;  /**< The pacing rate in bytes per second, zero when not paced, or FREERTOS_TCP_PACING_AUTO. */
+            int32_t lPacingCredit;  /**< The number of bytes that may be sent now, negative when the last segment exceeded it. */
+            TickType_t xPacingTime; /**< The time at which lPacingCredit was last updated. */
         #endif
+        #if ( ipconfigUSE_TCP_SPLICE != 0 )
+            struct xSOCKET * pxSpliceTarget; /**< The socket whose txStream receives the data of this socket, see FREERTOS_SO_TCP_SPLICE. */
+            struct xSOCKET * pxSpliceSource; /**< The socket whose received data is sent by this socket. */
+        #endif
+        #if ( ipconfigUSE_TCP_RECORD_FRAMING != 0 )
+            TCPRecordFraming_t xRecordFraming; /**< The record framing of the received data, see FREERTOS_SO_TCP_RECORD. */
+        #endif
+
+        /* The members below are used for setting up, listening, time-outs, and
+         * the application's call-backs: rarely on the packet path. */
+        struct xSOCKET * pxPeerSocket; /**< for server socket: child, for child socket: parent */
+        uint16_t usChildCount;         /**< In case of a listening socket: number of connections on this port number */
+        uint16_t usBacklog;            /**< In case of a listening socket: maximum number of concurrent connections on this port number */
+        #if ( ipconfigTCP_ACCEPT_QUEUE != 0 )
+            List_t xAcceptQueue;        /**< For a listening socket: the connected child sockets that were not accepted yet, oldest first. */
+            ListItem_t xAcceptListItem; /**< For a child socket: places the socket in the accept queue of its parent. */
+        #endif /* ipconfigTCP_ACCEPT_QUEUE */
+        #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
+            ListItem_t xTimerListItem;      /**< Places the socket in a slot of the TCP timer wheel. The item value holds the time at which 'usTimeout' expires. */
+            ListItem_t xWakeUpListItem;     /**< Places the socket in the list of sockets that have events for their owner. */
+            ListItem_t xRescheduleListItem; /**< Places the socket in the list of sockets whose 'usTimeout' was changed by a user task. */
+            uint16_t usTimeoutScheduled;    /**< The value of 'usTimeout' that was used to calculate the expiry time. */
+        #endif /* ipconfigUSE_TCP_TIMER_WHEEL */
+        #if ( ipconfigTCP_KEEP_ALIVE == 1 )
+            uint8_t ucKeepRepCount;
+            TickType_t xLastAliveTime; /**< The last value of keepalive time.*/
+        #endif /* ipconfigTCP_KEEP_ALIVE */
+        #if ( ipconfigTCP_HANG_PROTECTION == 1 )
+            TickType_t xLastActTime;   /**< The last time when hang-protection was done.*/
+        #endif /* ipconfigTCP_HANG_PROTECTION */
         #if ( ipconfigUSE_CALLBACKS == 1 )
             FOnTCPReceive_t pxHandleReceive;  /**<
                                                * In case of a TCP socket:
@@ -599,11 +879,35 @@ BaseType_t xIPIsNetworkTaskReady( void );
             FOnTCPSent_t pxHandleSent;        /**< Function pointer to handle a successful send event.  */
             FOnConnected_t pxHandleConnected; /**< Actually type: typedef void (* FOnConnected_t) (Socket_t xSocket, BaseType_t ulConnected ); */
         #endif /* ipconfigUSE_CALLBACKS */
-        uint32_t ulWindowSize;                /**< Current Window size advertised by peer */
-        size_t uxRxWinSize;                   /**< Fixed value: size of the TCP reception window */
-        size_t uxTxWinSize;                   /**< Fixed value: size of the TCP transmit window */
-
-        TCPWindow_t xTCPWindow;               /**< The TCP window struct*/
+        #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+            const TCPCongestionControl_t * pxCongestionControl; /**< The congestion control for the next connection, NULL for the default. */
+        #endif
+        #if ( ipconfigTCP_LISTEN_POOL_SIZE != 0 )
+            struct xSOCKET * pxListenPool[ ipconfigTCP_LISTEN_POOL_SIZE ]; /**< Child sockets created in advance by a listening socket, used as a stack. */
+            UBaseType_t uxListenPoolCount;                                 /**< The number of sockets in pxListenPool[]. */
+            UBaseType_t uxListenPoolTarget;                                /**< The number of sockets that the pool should hold, see FREERTOS_SO_LISTEN_POOL. */
+        #endif
+        #if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+            size_t uxRxStreamBase;            /**< The RX stream size before auto-tuning changed it, or zero. */
+            size_t uxTxStreamBase;            /**< The TX stream size before auto-tuning changed it, or zero. */
+            uint32_t ulTuneRxSequence;        /**< rx.ulCurrentSequenceNumber when the measurement started. */
+            uint32_t ulTuneTxSequence;        /**< tx.ulCurrentSequenceNumber when the measurement started. */
+            TickType_t xTuneTime;             /**< The time at which the measurement started. */
+            StreamBuffer_t * pxRetiredStream; /**< A stream that was replaced, it is freed one measurement later. */
+        #endif
+        #if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+            TickType_t xRxStreamIdleTime; /**< The time at which the RX stream was found empty. */
+            TickType_t xTxStreamIdleTime; /**< The time at which the TX stream was found empty. */
+        #endif
+        #if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+            uint8_t ucFastOpenCookie[ tcpFAST_OPEN_COOKIE_MAX ]; /**< The Fast Open cookie in the SYN or SYN+ACK being processed. */
+            uint8_t ucFastOpenCookieLength;                       /**< The length of that cookie, zero for a cookie request. */
+            uint16_t usFastOpenLength;                            /**< The number of bytes that were sent along with the last SYN. */
+        #endif
+        #if ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
+            uint32_t ulPathMTUSequence; /**< tx.ulCurrentSequenceNumber when the time-outs started to be counted. */
+            uint32_t ulPathMTUTimeouts; /**< xTCPWindow.ulRetransmitCount at that moment. */
+        #endif
     } IPTCPSocket_t;
 
 #endif /* ipconfigUSE_TCP */
@@ -616,7 +920,32 @@ typedef struct UDPSOCKET
     List_t xWaitingPacketsList;   /**< Incoming packets */
     #if ( ipconfigUDP_MAX_RX_PACKETS > 0 )
         UBaseType_t uxMaxPackets; /**< Protection: limits the number of packets buffered per socket */
+        BaseType_t xDropOldest;   /**< When the limit is reached, drop the oldest waiting packet in stead of the new one. */
     #endif /* ipconfigUDP_MAX_RX_PACKETS */
+    #if ( ipconfigUSE_UDP_REUSEPORT != 0 )
+        BaseType_t xReusePort; /**< The port may be shared with other sockets that have this option set. */
+    #endif
+    #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+        uint32_t ulMulticastGroups; /**< One bit for every entry of the multicast group table that this socket has joined. */
+    #endif
+    #if ( ipconfigUSE_UDP_CONNECT != 0 )
+        BaseType_t xConnected;                      /**< FreeRTOS_connect() has set a peer address. */
+        struct freertos_sockaddr xRemoteAddress;    /**< The address of the peer. */
+        BaseType_t xHeaderValid;                    /**< The members below hold a usable copy of the headers. */
+        uint32_t ulHeaderGeneration;                /**< The value of ulIPHeaderCacheGeneration when the headers were copied. */
+        struct xNetworkEndPoint * pxHeaderEndPoint; /**< The end-point through which the peer is reached. */
+        uint8_t ucHeader[ sizeof( UDPPacket_IPv6_t ) ]; /**< The Ethernet, IP and UDP headers of the last packet sent to the peer. */
+    #endif
+    #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+        BaseType_t xDirectTx; /**< Packets with valid cached headers are passed to the driver by the calling task. */
+    #endif
+    #if ( ipconfigUSE_UDP_GSO != 0 )
+        uint16_t usSegmentSize; /**< When non-zero, FreeRTOS_sendto() splits longer buffers in datagrams of this size. */
+    #endif
+    #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+        BaseType_t xTimestamping;         /**< The driver is asked for the time at which each datagram was sent. */
+        NetworkTimestamp_t xTxTimestamp;  /**< The time at which the last datagram was sent, zero when not known. */
+    #endif
     #if ( ipconfigUSE_CALLBACKS == 1 )
         FOnUDPReceive_t pxHandleReceive; /**<
                                           * In case of a UDP socket:
@@ -645,27 +974,53 @@ enum eSOCKET_EVENT
  */
 struct xSOCKET
 {
-    EventBits_t xEventBits;         /**< The eventbits to keep track of events. */
-    EventGroupHandle_t xEventGroup; /**< The event group for this socket. */
+    /* The members up to and including 'xBoundSocketListItem' are used to
+     * deliver every packet, they are grouped at the start of the struct.
+     * The TCP or UDP union at the end also starts with its own hot members. */
+    uint8_t ucProtocol;                   /**< choice of FREERTOS_IPPROTO_UDP/TCP */
+    uint8_t ucSocketOptions;              /**< Socket options */
+    #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+        uint8_t ucDSCP;                   /**< Set with FREERTOS_SO_DSCP: the DSCP of outgoing packets, 0..63. */
+    #endif
+    uint16_t usLocalPort;                 /**< Local port on this machine */
+    IP_Address_t xLocalAddress;           /**< Local IP address */
+    struct xNetworkEndPoint * pxEndPoint; /**< The end-point to which the socket is bound. */
+    EventBits_t xEventBits;               /**< The eventbits to keep track of events. */
 
     /* Most compilers do like bit-flags */
     struct
     {
         uint32_t bIsIPv6 : 1; /**< Non-zero in case the connection is using IPv6. */
         uint32_t bSomeFlag : 1;
+        #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+            uint32_t bV6Only : 1;   /**< Set with FREERTOS_SO_IPV6_V6ONLY: the IPv6 socket does not handle IPv4 traffic. */
+            uint32_t bV4Mapped : 1; /**< An IPv4 connection of a dual-stack socket, its addresses are reported as IPv4-mapped IPv6 addresses. */
+        #endif
+        #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+            uint32_t bStaticSocket : 1; /**< The socket was created by FreeRTOS_socket_static(), its memory belongs to the application. */
+        #endif
     }
     bits;
 
-    ListItem_t xBoundSocketListItem;       /**< Used to reference the socket from a bound sockets list. */
-    TickType_t xReceiveBlockTime;          /**< if recv[to] is called while no data is available, wait this amount of time. Unit in clock-ticks */
-    TickType_t xSendBlockTime;             /**< if send[to] is called while there is not enough space to send, wait this amount of time. Unit in clock-ticks */
+    ListItem_t xBoundSocketListItem; /**< Used to reference the socket from a bound sockets list. */
+    #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+        ListItem_t xHashListItem;    /**< Used to reference the socket from a bucket of the socket hash table. */
+    #endif
 
-    IP_Address_t xLocalAddress;            /**< Local IP address */
-    uint16_t usLocalPort;                  /**< Local port on this machine */
-    uint8_t ucSocketOptions;               /**< Socket options */
-    uint8_t ucProtocol;                    /**< choice of FREERTOS_IPPROTO_UDP/TCP */
+    /* The members below are used by the API functions and their callers. */
+    #if ( ipconfigSOCKET_USES_NOTIFY != 0 )
+        EventBits_t xNotifyBits;    /**< The events that were not yet taken by a task, see ipconfigSOCKET_USES_NOTIFY. */
+        TaskHandle_t xNotifyTask;   /**< The task that is blocked on this socket, or NULL. */
+    #else
+        EventGroupHandle_t xEventGroup; /**< The event group for this socket. */
+    #endif
+    TickType_t xReceiveBlockTime;   /**< if recv[to] is called while no data is available, wait this amount of time. Unit in clock-ticks */
+    TickType_t xSendBlockTime;      /**< if send[to] is called while there is not enough space to send, wait this amount of time. Unit in clock-ticks */
+    #if ( ipconfigUSE_SOCKET_BUSY_POLL != 0 )
+        TickType_t xBusyPollTime;   /**< Set with FREERTOS_SO_BUSY_POLL: spin for at most this time before blocking in a receive call. */
+    #endif
     #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
-        SemaphoreHandle_t pxUserSemaphore; /**< The user semaphore */
+        SemaphoreHandle_t pxUserSemaphore;         /**< The user semaphore */
     #endif /* ipconfigSOCKET_HAS_USER_SEMAPHORE */
     #if ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK == 1 )
         SocketWakeupCallback_t pxUserWakeCallback; /**< Pointer to the callback function. */
@@ -677,8 +1032,14 @@ struct xSOCKET
 
         EventBits_t xSocketBits;          /**< These bits indicate the events which have actually occurred.
                                            * They are maintained by the IP-task */
+        #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+            ListItem_t xReadyListItem; /**< Links the socket into the ready list of its socket set. */
+        #endif
     #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
-    struct xNetworkEndPoint * pxEndPoint; /**< The end-point to which the socket is bound. */
+
+    #if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+        struct xASYNC_RING * pxAsyncRing; /**< The asynchronous ring that has requests waiting for this socket, only used by the IP-task. */
+    #endif
 
     /* This field is only only by the user, and can be accessed with
      * vSocketSetSocketID() / vSocketGetSocketID().
@@ -686,6 +1047,10 @@ struct xSOCKET
      */
     void * pvSocketID;
 
+    #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+        SocketAccounting_t xAccounting; /**< The traffic and IP-task time of this socket, only updated by the IP-task. */
+    #endif
+
     /* TCP/UDP specific fields: */
     /* Before accessing any member of this structure, it should be confirmed */
     /* that the protocol corresponds with the type of structure */
@@ -700,6 +1065,48 @@ struct xSOCKET
     u; /**< Union of TCP/UDP socket */
 };
 
+#if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+
+/**
+ * The memory for a socket created by FreeRTOS_socket_static().  The
+ * application declares it, but should not access its members.
+ */
+    struct xSTATIC_SOCKET
+    {
+        FreeRTOS_Socket_t xSocket;       /**< The socket itself. */
+        #if ( ipconfigSOCKET_USES_NOTIFY == 0 )
+            StaticEventGroup_t xEventGroup; /**< The storage of the event group of the socket. */
+        #endif
+    };
+#endif /* ipconfigSUPPORT_STATIC_SOCKETS */
+
+#if ( ipconfigSOCKET_USES_NOTIFY != 0 )
+
+/*
+ * Set event bits of a socket and wake up the task that is blocked on it.
+ */
+    void vSocketEventSet( FreeRTOS_Socket_t * pxSocket,
+                          EventBits_t xBitsToSet );
+
+/*
+ * Block until at least one of 'xBitsToWaitFor' is set, like
+ * xEventGroupWaitBits() with 'xWaitForAllBits' set to pdFALSE.
+ */
+    EventBits_t xSocketEventWait( FreeRTOS_Socket_t * pxSocket,
+                                  EventBits_t xBitsToWaitFor,
+                                  BaseType_t xClearOnExit,
+                                  TickType_t xTicksToWait );
+
+    #define xSocketEventGet( pxSocket )    ( ( pxSocket )->xNotifyBits )
+#else
+
+/* The events of a socket are kept in its event group. */
+    #define vSocketEventSet( pxSocket, xBitsToSet )    ( void ) xEventGroupSetBits( ( pxSocket )->xEventGroup, ( xBitsToSet ) )
+    #define xSocketEventWait( pxSocket, xBitsToWaitFor, xClearOnExit, xTicksToWait ) \
+    xEventGroupWaitBits( ( pxSocket )->xEventGroup, ( xBitsToWaitFor ), ( xClearOnExit ), pdFALSE, ( xTicksToWait ) )
+    #define xSocketEventGet( pxSocket )                xEventGroupGetBits( ( pxSocket )->xEventGroup )
+#endif /* ipconfigSOCKET_USES_NOTIFY */
+
 #if ( ipconfigUSE_TCP == 1 )
 
 /*
@@ -721,6 +1128,45 @@ struct xSOCKET
                                            IPv46_Address_t xRemoteIP,
                                            UBaseType_t uxRemotePort );
 
+    #if ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
+
+/*
+ * Handle an ICMP "fragmentation needed" or ICMPv6 "packet too big" message.
+ * 'pucQuoted' points to the IP header of the packet that was too big.
+ */
+        void vTCPPathMTUReport( BaseType_t xIsIPv6,
+                                const uint8_t * pucQuoted,
+                                size_t uxQuotedLength,
+                                uint32_t ulMTU );
+    #endif
+
+    #if ( ipconfigUSE_SOCKET_HASH_LOOKUP != 0 )
+
+/*
+ * Move a TCP socket to the hash bucket that belongs to its current port
+ * numbers and remote address. Must be called from the IP-task, after the
+ * remote address of the socket has changed.
+ */
+        void vSocketHashUpdate( FreeRTOS_Socket_t * pxSocket );
+    #endif
+
+    #if ( ipconfigUSE_TCP_TIMER_WHEEL != 0 )
+
+/*
+ * The TCP timer wheel, see FreeRTOS_IP_Timers.c. vTCPTimerWheelSchedule()
+ * must be called by the IP-task after it may have changed the 'usTimeout'
+ * or the 'xEventBits' of a TCP socket. Any task that changes 'usTimeout'
+ * before sending an eTCPTimerEvent calls vTCPTimerWheelRequest().
+ */
+        void vTCPTimerWheelInit( void );
+        void vTCPTimerWheelSchedule( FreeRTOS_Socket_t * pxSocket );
+        void vTCPTimerWheelRequest( FreeRTOS_Socket_t * pxSocket );
+        void vTCPTimerWheelRemove( FreeRTOS_Socket_t * pxSocket );
+        TickType_t xTCPTimerWheelCheck( BaseType_t xWillSleep );
+    #else
+        #define vTCPTimerWheelRequest( pxSocket )    do {} while( ipFALSE_BOOL )
+    #endif /* ipconfigUSE_TCP_TIMER_WHEEL */
+
 #endif /* ipconfigUSE_TCP */
 
 
@@ -729,6 +1175,17 @@ struct xSOCKET
  */
 FreeRTOS_Socket_t * pxUDPSocketLookup( UBaseType_t uxLocalPort );
 
+#if ( ipconfigUSE_UDP_REUSEPORT != 0 )
+
+/*
+ * Choose one of the sockets that share the port of 'pxSocket', based on the
+ * source address and port of a received packet.
+ */
+    FreeRTOS_Socket_t * pxUDPSocketSelectReusePort( FreeRTOS_Socket_t * pxSocket,
+                                                    const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                    BaseType_t xIsIPv6 );
+#endif
+
 /*
  * Calculate the upper-layer checksum
  * Works both for UDP, ICMP and TCP packages
@@ -740,6 +1197,37 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
                                      size_t uxBufferLength,
                                      BaseType_t xOutgoingPacket );
 
+#if ( ipconfigUSE_PACKET_METADATA != 0 )
+
+/*
+ * Parse the IP-header of a received packet and store the header offsets in
+ * 'xMetadata' of the network buffer.
+ */
+    void vPacketMetadataParse( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Check the protocol checksum of a received packet, like
+ * usGenerateProtocolChecksum() does, using the header offsets in 'xMetadata'.
+ */
+    uint16_t usGenerateProtocolChecksumPacket( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+    #define ipRX_PROTOCOL_CHECKSUM( pxNetworkBuffer )    usGenerateProtocolChecksumPacket( pxNetworkBuffer )
+#else
+    #define ipRX_PROTOCOL_CHECKSUM( pxNetworkBuffer )    usGenerateProtocolChecksum( ( uint8_t * ) ( ( pxNetworkBuffer )->pucEthernetBuffer ), ( pxNetworkBuffer )->xDataLength, pdFALSE )
+#endif /* ( ipconfigUSE_PACKET_METADATA != 0 ) */
+
+#if ( ipconfigTCP_TX_COPY_CHECKSUM != 0 )
+
+/*
+ * Set the checksum of an outgoing UDP or TCP packet, of which the sum of last
+ * uxPayloadLength bytes is already known, see uxStreamBufferGetWithChecksum().
+ */
+    uint16_t usGenerateProtocolChecksumWithPayloadSum( uint8_t * pucEthernetBuffer,
+                                                       size_t uxBufferLength,
+                                                       size_t uxPayloadLength,
+                                                       uint16_t usPayloadSum );
+#endif
+
 /*
  * An Ethernet frame has been updated (maybe it was an ARP request or a PING
  * request?) and is to be sent back to its source.
@@ -770,11 +1258,134 @@ int32_t lTCPAddRxdata( FreeRTOS_Socket_t * pxSocket,
                        const uint8_t * pcData,
                        uint32_t ulByteCount );
 
+#if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+
+/*
+ * Read data from the txStream of a socket in 'peek' mode, like
+ * uxStreamBufferGet() does.  Data that was queued with FreeRTOS_send_reference()
+ * is copied from the buffer of the application.
+ */
+    size_t uxTCPTxReferenceGet( const FreeRTOS_Socket_t * pxSocket,
+                                size_t uxOffset,
+                                uint8_t * pucData,
+                                size_t uxMaxCount );
+
+/*
+ * 'uxCount' bytes at the tail of txStream have been acknowledged, release the
+ * buffers of which all data have been delivered.  Must be called before the
+ * tail of txStream is advanced.
+ */
+    void vTCPTxReferenceAcked( FreeRTOS_Socket_t * pxSocket,
+                               size_t uxCount );
+
+/*
+ * Release all buffers, their data will not be sent.
+ */
+    void vTCPTxReferenceFlush( FreeRTOS_Socket_t * pxSocket );
+#endif /* ipconfigTCP_TX_REFERENCE_COUNT != 0 */
+
+#if ( ipconfigTCP_RX_BUFFER_COUNT != 0 )
+
+/*
+ * Let a socket in buffer-chain mode keep the network buffer that holds
+ * in-order data, and reserve the space for that data in rxStream.  Returns
+ * pdFALSE when the data must be copied as usual.
+ */
+    BaseType_t xTCPRxBufferAdd( FreeRTOS_Socket_t * pxSocket,
+                                NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                uint8_t * pucData,
+                                uint32_t ulByteCount );
+
+/*
+ * Read data from the tail of rxStream, like uxStreamBufferGet() does.  Data
+ * that is stored in network buffers is copied from those buffers.  When
+ * 'pucData' is NULL, nothing is copied.  Unless 'xPeek' is true, the tail is
+ * advanced and the network buffers that were read completely are released.
+ */
+    size_t uxTCPRxBufferGet( FreeRTOS_Socket_t * pxSocket,
+                             uint8_t * pucData,
+                             size_t uxMaxCount,
+                             BaseType_t xPeek );
+
+/*
+ * Get a pointer to the first block of contiguous data at the tail of
+ * rxStream, which is either in rxStream or in a network buffer, like
+ * uxStreamBufferGetPtr() does.
+ */
+    size_t uxTCPRxBufferGetPtr( const FreeRTOS_Socket_t * pxSocket,
+                                uint8_t ** ppucData );
+
+/*
+ * Release all network buffers kept by a socket.
+ */
+    void vTCPRxBufferFlush( FreeRTOS_Socket_t * pxSocket );
+#endif /* ipconfigTCP_RX_BUFFER_COUNT != 0 */
+
+#if ( ipconfigUSE_TCP_SPLICE != 0 )
+
+/*
+ * Called by the IP-task: move the received data of a spliced socket to the
+ * txStream of its target, as far as the target has space.
+ */
+    void vTCPSpliceTransfer( FreeRTOS_Socket_t * pxSource );
+#endif /* ipconfigUSE_TCP_SPLICE != 0 */
+
+#if ( ipconfigTCP_LISTEN_POOL_SIZE != 0 )
+
+/*
+ * Called by the IP-task when a listening socket needs a new child socket.
+ * Takes a socket from the pool of the listening socket, or creates a new one
+ * when the pool is empty.  Returns NULL or FREERTOS_INVALID_SOCKET when no
+ * socket could be created, like FreeRTOS_socket() does.
+ */
+    FreeRTOS_Socket_t * pxTCPListenPoolTake( FreeRTOS_Socket_t * pxSocket,
+                                             BaseType_t xDomain );
+#endif /* ipconfigTCP_LISTEN_POOL_SIZE != 0 */
+
+#if ( ipconfigUSE_TCP_AUTO_TUNING != 0 )
+
+/*
+ * Called by the IP-task after a TCP packet was processed.  Measures the
+ * throughput of the connection, and resizes its stream buffers when needed.
+ */
+    void vTCPAutoTuneCheck( FreeRTOS_Socket_t * pxSocket );
+#endif /* ipconfigUSE_TCP_AUTO_TUNING != 0 */
+
+#if ( ipconfigTCP_STREAM_RELEASE_TIME != 0 )
+
+/*
+ * Called by the IP-task when it has handled a TCP socket.  Releases the
+ * streams that have been empty for ipconfigTCP_STREAM_RELEASE_TIME seconds.
+ */
+    void vTCPStreamIdleCheck( FreeRTOS_Socket_t * pxSocket );
+#endif /* ipconfigTCP_STREAM_RELEASE_TIME != 0 */
+
 /*
  * Currently called for any important event.
  */
 void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket );
 
+#if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+
+/*
+ * Called by the IP-task just before a reception handler is called: the
+ * handler may take 'pxNetworkBuffer' by calling FreeRTOS_TakeRxBuffer().
+ * For a TCP socket, 'uxReplySize' is the number of bytes of headers that
+ * must be copied to a new buffer that will be used to send the reply.  For
+ * a UDP socket, 'uxReplySize' is zero.
+ */
+    void vSocketRxBufferOffer( FreeRTOS_Socket_t * pxSocket,
+                               NetworkBufferDescriptor_t * pxNetworkBuffer,
+                               size_t uxReplySize );
+
+/*
+ * Called by the IP-task after the reception handler has returned.  Returns
+ * pdTRUE when the handler has taken the buffer that was offered.  In that
+ * case, '*ppxReplyBuffer' is set to the copy of the headers, if any.
+ */
+    BaseType_t xSocketRxBufferTaken( NetworkBufferDescriptor_t ** ppxReplyBuffer );
+#endif /* ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 */
+
 /*
  * Some helping function, their meaning should be clear.
  * Going by MISRA rules, these utility functions should not be defined
@@ -795,6 +1406,41 @@ BaseType_t xTCPCheckNewClient( FreeRTOS_Socket_t * pxSocket );
  */
 void * vSocketClose( FreeRTOS_Socket_t * pxSocket );
 
+#if ( ( ipconfigSOCKET_POOL_UDP_COUNT != 0 ) || ( ipconfigSOCKET_POOL_TCP_COUNT != 0 ) )
+
+/* The allocator behind pvPortMallocSocket() and vPortFreeSocket(). */
+    void * pvSocketPoolGet( size_t uxSize );
+
+    void vSocketPoolPut( void * pvSocket );
+
+/* The number of socket objects in a pool that are not in use. */
+    UBaseType_t uxSocketPoolGetFreeCount( BaseType_t xProtocol );
+#endif
+
+#if ( ipconfigUSE_SOCKET_MEMORY_BUDGET != 0 )
+
+/*
+ * Count 'uxBytes' held by sockets.  Returns pdFAIL, and counts nothing, when
+ * the bytes do not fit in ipconfigSOCKET_MEMORY_BUDGET.  May be called from
+ * any task.
+ */
+    BaseType_t xSocketMemoryCharge( size_t uxBytes );
+
+/* Give back bytes that were counted with xSocketMemoryCharge(). */
+    void vSocketMemoryRelease( size_t uxBytes );
+
+/*
+ * Called by the IP-task before a packet of 'uxBytes' is queued to a UDP
+ * socket.  Returns pdFAIL when the packet must be dropped because of the
+ * pressure on the budget, otherwise the bytes are counted.
+ */
+    BaseType_t xSocketMemoryAdmitUDP( const FreeRTOS_Socket_t * pxSocket,
+                                      size_t uxBytes );
+#else
+    #define xSocketMemoryCharge( uxBytes )     ( pdPASS )
+    #define vSocketMemoryRelease( uxBytes )    do {} while( ipFALSE_BOOL )
+#endif /* ipconfigUSE_SOCKET_MEMORY_BUDGET */
+
 /*
  * Send the event eEvent to the IP task event queue, using a block time of
  * zero.  Return pdPASS if the message was sent successfully, otherwise return
@@ -810,20 +1456,313 @@ BaseType_t xSendEventToIPTask( eIPEvent_t eEvent );
 BaseType_t xSendEventStructToIPTask( const IPStackEvent_t * pxEvent,
                                      TickType_t uxTimeout );
 
+/*
+ * Pass an array of received network buffers to the IP-task.  Buffers that
+ * can not be delivered will be released.  Return pdPASS when all buffers
+ * were delivered, otherwise pdFAIL.
+ */
+BaseType_t xSendRxBurstToIPTask( NetworkBufferDescriptor_t * const * ppxBuffers,
+                                 size_t uxCount,
+                                 TickType_t uxTimeout );
+
+#if ( ipconfigUSE_NETWORK_RX_RING != 0 )
+
+/*
+ * Store a received network buffer in the receive ring of its interface, to
+ * be processed by the IP-task.  Returns pdFAIL when the ring is full, in that
+ * case the caller still owns the buffer.
+ */
+    BaseType_t xNetworkRxRingPush( NetworkInterface_t * pxInterface,
+                                   NetworkBufferDescriptor_t * pxBuffer );
+#endif
+
+#if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+
+/*
+ * Take an empty network buffer of ipTOTAL_ETHERNET_FRAME_SIZE bytes from the
+ * reserve of an interface.  It does not take a lock and may be called from an
+ * interrupt service routine, but only from one context per interface.
+ * Returns NULL when the reserve is empty.
+ */
+    NetworkBufferDescriptor_t * pxNetworkBufferGetFromReserveISR( NetworkInterface_t * pxInterface );
+#endif
+
+#if ( ( ipconfigUSE_DRIVER_RESPONDER != 0 ) && ( ipconfigUSE_IPv4 != 0 ) )
+
+/*
+ * Called by a driver, from a task, for a received frame: answer an ARP
+ * request or an ICMP echo request for an end-point of the interface directly.
+ * Returns pdTRUE when the frame was consumed, otherwise it must be sent to
+ * the IP-task as usual.
+ */
+    BaseType_t xIPDriverRespond( NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif
+
+#if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+
+/*
+ * Ask the IP-task to call the pfPoll() function of an interface.  Use the
+ * FromISR() version from an interrupt service routine, it returns a non-zero
+ * value when a context switch should be performed.
+ */
+    void FreeRTOS_NetworkInterfacePoll( NetworkInterface_t * pxInterface );
+    BaseType_t FreeRTOS_NetworkInterfacePollFromISR( NetworkInterface_t * pxInterface );
+
+/*
+ * Only to be called from within pfPoll(): process a received frame.
+ */
+    void vNetworkInterfacePollInput( NetworkBufferDescriptor_t * pxBuffer );
+#endif
+
+#if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
+/*
+ * The value that pfOutput() returns when its transmit ring is full, see
+ * ipconfigUSE_TX_BACKPRESSURE.  The driver has not released the buffer.
+ */
+    #define ipTX_BUSY    ( 2 )
+
+/*
+ * To be called by a driver that returned ipTX_BUSY, as soon as its transmit
+ * ring has room again.  Use the FromISR() version from an interrupt service
+ * routine, it returns a non-zero value when a context switch should be
+ * performed.
+ */
+    void FreeRTOS_NetworkInterfaceTxReady( NetworkInterface_t * pxInterface );
+    BaseType_t FreeRTOS_NetworkInterfaceTxReadyFromISR( NetworkInterface_t * pxInterface );
+
+/*
+ * Called by the IP-task: send the frame that was held back because the
+ * interface was busy, and let the paused TCP sockets continue.
+ */
+    void vIPInterfaceTxReady( NetworkInterface_t * pxInterface );
+#endif
+
+#if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+
+/*
+ * Update the counters of an interface, see ipconfigUSE_NETWORK_COUNTERS.
+ * 'xField' is either 'xTotal' or an element of 'xProtocols[]'.  The RX
+ * counters are only updated by the IP-task, the TX counters by the task that
+ * holds the interface mutex in xIPInterfaceOutput(), and 'ulRxQueueFull' by
+ * the driver.
+ */
+    #define ipCOUNT_RX( pxInterface, xField, uxLength )                            \
+    do {                                                                           \
+        ( pxInterface )->xCounters.xField.ulRxPackets++;                           \
+        ( pxInterface )->xCounters.xField.ullRxBytes += ( uint64_t ) ( uxLength ); \
+    } while( ipFALSE_BOOL )
+
+    #define ipCOUNT_TX( pxInterface, xField, uxLength )                            \
+    do {                                                                           \
+        ( pxInterface )->xCounters.xField.ulTxPackets++;                           \
+        ( pxInterface )->xCounters.xField.ullTxBytes += ( uint64_t ) ( uxLength ); \
+    } while( ipFALSE_BOOL )
+
+    #define ipCOUNT_RX_DROP( pxInterface, eReason )               \
+    do {                                                          \
+        iptraceRX_PACKET_DROPPED( ( pxInterface ), ( eReason ) ); \
+        ( pxInterface )->xCounters.ulRxDropped[ ( eReason ) ]++;  \
+    } while( ipFALSE_BOOL )
+
+    #define ipCOUNT_RX_QUEUE_FULL( pxInterface )    ( ( pxInterface )->xCounters.ulRxQueueFull++ )
+#else
+    #define ipCOUNT_RX( pxInterface, xField, uxLength )    do {} while( ipFALSE_BOOL )
+    #define ipCOUNT_TX( pxInterface, xField, uxLength )    do {} while( ipFALSE_BOOL )
+    #define ipCOUNT_RX_DROP( pxInterface, eReason )        do { iptraceRX_PACKET_DROPPED( ( pxInterface ), ( eReason ) ); } while( ipFALSE_BOOL )
+    #define ipCOUNT_RX_QUEUE_FULL( pxInterface )           do {} while( ipFALSE_BOOL )
+#endif /* ipconfigUSE_NETWORK_COUNTERS */
+
+#if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+
+/*
+ * Update the counters of a socket, see ipconfigUSE_SOCKET_ACCOUNTING.  Only
+ * to be called from the IP-task.  'xField' is one of 'ullRxTime', 'ullTxTime'
+ * or 'ullTimerTime', 'ulStartTime' a value of ipconfigSOCKET_ACCOUNTING_TIME().
+ */
+    #define ipACCOUNT_SOCKET_TIME( pxSocket, xField, ulStartTime )                                               \
+    do {                                                                                                         \
+        ( pxSocket )->xAccounting.xField += ( uint64_t ) ( ipconfigSOCKET_ACCOUNTING_TIME() - ( ulStartTime ) ); \
+    } while( ipFALSE_BOOL )
+
+    #define ipACCOUNT_SOCKET_RX( pxSocket, uxLength )                       \
+    do {                                                                    \
+        ( pxSocket )->xAccounting.ulRxPackets++;                            \
+        ( pxSocket )->xAccounting.ullRxBytes += ( uint64_t ) ( uxLength ); \
+    } while( ipFALSE_BOOL )
+
+    #define ipACCOUNT_SOCKET_TX( pxSocket, uxLength )                       \
+    do {                                                                    \
+        ( pxSocket )->xAccounting.ulTxPackets++;                            \
+        ( pxSocket )->xAccounting.ullTxBytes += ( uint64_t ) ( uxLength ); \
+    } while( ipFALSE_BOOL )
+#else
+    #define ipACCOUNT_SOCKET_TIME( pxSocket, xField, ulStartTime )    do {} while( ipFALSE_BOOL )
+    #define ipACCOUNT_SOCKET_RX( pxSocket, uxLength )                 do {} while( ipFALSE_BOOL )
+    #define ipACCOUNT_SOCKET_TX( pxSocket, uxLength )                 do {} while( ipFALSE_BOOL )
+#endif /* ipconfigUSE_SOCKET_ACCOUNTING */
+
+/*
+ * To be called by a driver when it drops a received frame, e.g. because no
+ * network buffer was available.  It calls iptraceETHERNET_RX_EVENT_LOST()
+ * and iptraceRX_PACKET_DROPPED(), and counts the drop when
+ * ipconfigUSE_NETWORK_COUNTERS is enabled.
+ */
+void vNetworkInterfaceRxDropped( struct xNetworkInterface * pxInterface,
+                                 eNetworkDropReason_t eReason );
+
+#if ( ipconfigUSE_UDP_DIRECT_TX != 0 ) || ( ipconfigUSE_SCATTER_GATHER != 0 ) || ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 ) || ( ipconfigUSE_NETWORK_COUNTERS != 0 ) || ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 ) || ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+
+/*
+ * Pass a packet to the driver of an interface.  The interface mutex is held
+ * during the call, because connected UDP sockets may call pfOutput() from
+ * another task than the IP-task.  A packet with segments is copied into a
+ * single buffer when the driver can not send segments.
+ */
+    BaseType_t xIPInterfaceOutput( NetworkInterface_t * pxInterface,
+                                   NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                   BaseType_t xReleaseAfterSend );
+#else
+    #define xIPInterfaceOutput( pxInterface, pxNetworkBuffer, xReleaseAfterSend )    ( ( pxInterface )->pfOutput( ( pxInterface ), ( pxNetworkBuffer ), ( xReleaseAfterSend ) ) )
+#endif
+
+#if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+
+/*
+ * The priority class of an outgoing frame, taken from the DSCP in its IP
+ * header.  Non-IP frames get the highest class, ipconfigTX_PRIORITY_CLASSES - 1.
+ */
+    UBaseType_t uxIPTxPriorityClass( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Called by the IP-task when it runs out of work: pass the frames that
+ * xIPInterfaceOutput() queued to the drivers, the highest class first.
+ */
+    void vIPTxQueueFlush( void );
+#endif
+
+#if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+
+/*
+ * Returns pdTRUE when the checksums of a received packet must be verified in
+ * software, i.e. neither the interface nor the driver has checked them.
+ */
+    BaseType_t xIPRxChecksumInSoftware( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Returns pdTRUE when the checksums of an outgoing packet must be calculated
+ * in software.  Otherwise ipBUFFER_CHECKSUM_NEEDED is set in the buffer and
+ * pdFALSE is returned.
+ */
+    BaseType_t xIPTxChecksumInSoftware( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+    #define ipRX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer )    xIPRxChecksumInSoftware( pxNetworkBuffer )
+    #define ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer )    xIPTxChecksumInSoftware( pxNetworkBuffer )
+#else
+    #define ipRX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer )    ( pdTRUE )
+    #define ipTX_CHECKSUM_IN_SOFTWARE( pxNetworkBuffer )    ( pdTRUE )
+#endif
+
+#if ( ipconfigARP_WAITING_BUFFER_COUNT > 1 )
+
+/*
+ * Set a received packet aside until the address of its sender is resolved.
+ * Returns pdFAIL when the queue is full, the caller must release the packet.
+ */
+    BaseType_t xIPWaitingBufferAdd( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * An ARP reply or a neighbour advertisement has been received, pass the
+ * packets that were waiting for it to the IP-task again.
+ */
+    void vIPWaitingBuffersResolved( uint32_t ulIPv4Address,
+                                    const IPv6_Address_t * pxIPv6Address );
+
+/* Drop the waiting packets that have not been resolved in time. */
+    void vIPWaitingBuffersCheckTimeout( void );
+#endif
+
+#if ( ipconfigUSE_RESOURCE_STATS != 0 )
+
+/* The heap allocations that are counted for FreeRTOS_GetResourceStats(). */
+    typedef enum
+    {
+        eResourceSocket,  /* A socket, also counted in 'xSockets'. */
+        eResourceStream,  /* A TCP stream buffer, also counted in 'xStreamBytes'. */
+        eResourceSegments /* Segment descriptors of the TCP sliding windows. */
+    } eIPResource_t;
+
+/* The resources of which the shortages are counted. */
+    typedef enum
+    {
+        eShortageNetworkBuffers, /* No network buffer could be obtained. */
+        eShortageEventQueue,     /* An event could not be sent to the IP-task. */
+        eShortageTCPSegments,    /* The pool of TCP segment descriptors was empty. */
+        eShortageARPCache,       /* A resolved ARP entry was pushed out of a full cache. */
+        eShortageDNSCache,       /* A DNS entry that had not expired was pushed out of a full cache. */
+        eShortageMax             /* The number of resources. */
+    } eIPShortage_t;
+
+/*
+ * Count an allocation ( xAllocated = pdTRUE ) or a release of 'uxBytes' of
+ * heap.  May be called from any task.
+ */
+    void vIPResourceStatsHeap( eIPResource_t eResource,
+                               BaseType_t xAllocated,
+                               size_t uxBytes );
+
+/*
+ * Count that a resource ran out.  May be called from any task, not from an
+ * interrupt.
+ */
+    void vIPResourceStatsShortage( eIPShortage_t eResource );
+
+/*
+ * Called by the IP-task with the number of events that were waiting in the
+ * event queue, including the one just taken.
+ */
+    void vIPResourceStatsEventQueue( size_t uxWaiting );
+
+    #define ipRESOURCE_ALLOC( eResource, uxBytes )    vIPResourceStatsHeap( ( eResource ), pdTRUE, ( uxBytes ) )
+    #define ipRESOURCE_FREE( eResource, uxBytes )     vIPResourceStatsHeap( ( eResource ), pdFALSE, ( uxBytes ) )
+    #define ipRESOURCE_SHORTAGE( eResource )          vIPResourceStatsShortage( eResource )
+#else
+    #define ipRESOURCE_ALLOC( eResource, uxBytes )    do {} while( ipFALSE_BOOL )
+    #define ipRESOURCE_FREE( eResource, uxBytes )     do {} while( ipFALSE_BOOL )
+    #define ipRESOURCE_SHORTAGE( eResource )          do {} while( ipFALSE_BOOL )
+#endif /* ipconfigUSE_RESOURCE_STATS */
+
 /*
  * Returns a pointer to the original NetworkBuffer from a pointer to a UDP
  * payload buffer.
  */
 NetworkBufferDescriptor_t * pxUDPPayloadBuffer_to_NetworkBuffer( const void * pvBuffer );
 
+#if ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 != 0 )
+
+/* With both IPv4 and IPv6 compiled in, the size is looked up at run time for
+ * every call.  Only the single-family builds below fold it to a constant. */
+
 /* Get the size of the IP-header.
  * 'usFrameType' must be filled in if IPv6is to be recognised. */
-size_t uxIPHeaderSizePacket( const NetworkBufferDescriptor_t * pxNetworkBuffer );
-/*-----------------------------------------------------------*/
+    size_t uxIPHeaderSizePacket( const NetworkBufferDescriptor_t * pxNetworkBuffer );
 
 /* Get the size of the IP-header.
  * The socket is checked for its type: IPv4 or IPv6. */
-size_t uxIPHeaderSizeSocket( const FreeRTOS_Socket_t * pxSocket );
+    size_t uxIPHeaderSizeSocket( const FreeRTOS_Socket_t * pxSocket );
+#elif ( ipconfigUSE_IPv6 != 0 )
+
+/* Only IPv6 is compiled in: every packet and every socket carries an IPv6
+ * header, so the size is known at compile time and the check disappears from
+ * the packet path. */
+    #define uxIPHeaderSizePacket( pxNetworkBuffer )    ( ( size_t ) ipSIZE_OF_IPv6_HEADER )
+    #define uxIPHeaderSizeSocket( pxSocket )           ( ( size_t ) ipSIZE_OF_IPv6_HEADER )
+#else
+
+/* Only IPv4 is compiled in, see above. */
+    #define uxIPHeaderSizePacket( pxNetworkBuffer )    ( ( size_t ) ipSIZE_OF_IPv4_HEADER )
+    #define uxIPHeaderSizeSocket( pxSocket )           ( ( size_t ) ipSIZE_OF_IPv4_HEADER )
+#endif /* ( ipconfigUSE_IPv4 != 0 ) && ( ipconfigUSE_IPv6 != 0 ) */
 /*-----------------------------------------------------------*/
 
 /*
@@ -846,6 +1785,9 @@ BaseType_t xIsCallingFromIPTask( void );
         /** @brief Event group for the socket select function.
          */
         EventGroupHandle_t xSelectGroup;
+        #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+            List_t xReadyList; /**< Sockets that had an event which was not yet reported by FreeRTOS_select_ready(). */
+        #endif
     } SocketSelect_t;
 
     extern void vSocketSelect( const SocketSelect_t * pxSocketSet );
@@ -859,6 +1801,43 @@ BaseType_t xIsCallingFromIPTask( void );
 
 #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
 
+#if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+
+/** @brief A request that waits for an event of its socket. */
+    typedef struct xASYNC_IN_FLIGHT
+    {
+        FreeRTOS_AsyncRequest_t xRequest; /**< The request as submitted. */
+        size_t uxDone;                    /**< eAsyncSend on TCP: the bytes queued so far. */
+        BaseType_t xStarted;              /**< eAsyncConnect: the connection has been started. */
+    } AsyncInFlight_t;
+
+/** @brief The state of an asynchronous ring, see ipconfigSUPPORT_ASYNC_SOCKETS.
+ * The submissions are written by the application and read by the IP-task,
+ * the completions the other way round. */
+    typedef struct xASYNC_RING
+    {
+        EventGroupHandle_t xCompletionGroup;                                /**< socketASYNC_COMPLETED is set when completions were added. */
+        FreeRTOS_AsyncRequest_t xSubmissions[ ipconfigASYNC_RING_LENGTH ];  /**< Requests not yet seen by the IP-task. */
+        AsyncInFlight_t xInFlight[ ipconfigASYNC_RING_LENGTH ];             /**< Requests waiting for their socket, oldest first. Only used by the IP-task. */
+        FreeRTOS_AsyncCompletion_t xCompletions[ ipconfigASYNC_RING_LENGTH ]; /**< Results not yet collected. */
+        volatile size_t uxSubmitHead;                                       /**< Incremented by the application for every submission. */
+        volatile size_t uxSubmitTail;                                       /**< Incremented by the IP-task for every submission taken. */
+        volatile size_t uxCompleteHead;                                     /**< Incremented by the IP-task for every completion. */
+        volatile size_t uxCompleteTail;                                     /**< Incremented by the application for every completion collected. */
+        size_t uxInFlightCount;                                             /**< The number of valid entries in xInFlight[]. */
+        size_t uxOutstanding;                                               /**< Submitted but not yet collected. Only used by the application. */
+        UBaseType_t uxEventsQueued;                                         /**< The eSocketAsyncEvent messages waiting for the IP-task. */
+        BaseType_t xDeleteRequested;                                        /**< Set by FreeRTOS_DeleteAsyncRing(). */
+    } SocketAsyncRing_t;
+
+/* Called by the IP-task for an eSocketAsyncEvent. */
+    void vSocketAsyncProcess( SocketAsyncRing_t * pxRing );
+
+/* Let the IP-task look at the requests that wait for this socket. */
+    void vSocketAsyncWakeUp( const FreeRTOS_Socket_t * pxSocket );
+
+#endif /* ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 ) */
+
 /* Send the network-up event and start the ARP timer. */
 void vIPNetworkUpCalls( struct xNetworkEndPoint * pxEndPoint );
 
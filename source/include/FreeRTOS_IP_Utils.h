@@ -97,6 +97,25 @@ struct xNetworkInterface;
     NetworkBufferDescriptor_t * pxPacketBuffer_to_NetworkBuffer( const void * pvBuffer );
 #endif
 
+#if ( ipconfigUSE_ICMP_RATE_LIMIT != 0 )
+
+/** @brief The ICMP messages that are rate-limited separately, see
+ *         ipconfigUSE_ICMP_RATE_LIMIT. */
+    typedef enum eICMPRateType
+    {
+        eICMPRateEchoReply,      /**< ICMP echo replies. */
+        eICMPRateEchoReply_IPv6, /**< ICMPv6 echo replies. */
+        eICMPRateTypeMax         /**< The number of types. */
+    } eICMPRateType_t;
+
+/**
+ * @brief Check whether an ICMP message may be sent in reply to a host.
+ *        Only called from the IP-task.
+ */
+    BaseType_t xICMPRateLimitCheck( eICMPRateType_t eType,
+                                    const IP_Address_t * pxSource );
+#endif
+
 /**
  * @brief Check the values of configuration options and assert on it. Also verify that the IP-task
  *        has not already been initialized.
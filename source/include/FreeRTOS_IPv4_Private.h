@@ -81,6 +81,32 @@ struct xIP_HEADER
 #include "pack_struct_end.h"
 typedef struct xIP_HEADER IPHeader_t;
 
+#if ( ipconfigUSE_ALIGNED_HEADER_ACCESS != 0 )
+
+/* The same layout as 'struct xIP_HEADER', but not packed, so that a 16- or
+ * 32-bit field can be read in one access. It may only be mapped onto an
+ * IP-header that starts at a 32-bit aligned address, see
+ * ipconfigUSE_ALIGNED_HEADER_ACCESS. */
+    struct xIP_HEADER_VIEW
+    {
+        uint8_t ucVersionHeaderLength;        /**< The version field + internet header length 0 + 1 =  1 */
+        uint8_t ucDifferentiatedServicesCode; /**< Differentiated services code point + ECN   1 + 1 =  2 */
+        uint16_t usLength;                    /**< Entire Packet size, ex. Ethernet header.   2 + 2 =  4 */
+        uint16_t usIdentification;            /**< Identification field                       4 + 2 =  6 */
+        uint16_t usFragmentOffset;            /**< Fragment flags and fragment offset         6 + 2 =  8 */
+        uint8_t ucTimeToLive;                 /**< Time to live field                         8 + 1 =  9 */
+        uint8_t ucProtocol;                   /**< Protocol used in the IP-datagram           9 + 1 = 10 */
+        uint16_t usHeaderChecksum;            /**< Checksum of the IP-header                 10 + 2 = 12 */
+        uint32_t ulSourceIPAddress;           /**< IP address of the source                  12 + 4 = 16 */
+        uint32_t ulDestinationIPAddress;      /**< IP address of the destination             16 + 4 = 20 */
+    };
+    typedef struct xIP_HEADER_VIEW IPHeaderView_t;
+
+    STATIC_ASSERT( sizeof( IPHeaderView_t ) == sizeof( IPHeader_t ) );
+#else
+    typedef IPHeader_t IPHeaderView_t;
+#endif /* ipconfigUSE_ALIGNED_HEADER_ACCESS */
+
 /*-----------------------------------------------------------*/
 /* Nested protocol packets.                                  */
 /*-----------------------------------------------------------*/
@@ -134,6 +160,12 @@ enum eFrameProcessingResult prvAllowIPPacketIPv4( const struct xIP_PACKET * cons
 /* Check if the IP-header is carrying options. */
 enum eFrameProcessingResult prvCheckIP4HeaderOptions( struct xNETWORK_BUFFER * const pxNetworkBuffer );
 
+#if ( ipconfigUSE_IP_FORWARDING != 0 )
+    /* Forward a packet that is not addressed to this host. */
+    enum eFrameProcessingResult eIPv4ForwardPacket( struct xNETWORK_BUFFER * const pxNetworkBuffer,
+                                                    UBaseType_t uxHeaderLength );
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     } /* extern "C" */
@@ -54,6 +54,9 @@
 #define ipICMP_PARAMETER_PROBLEM_IPv6            ( ( uint8_t ) 4U )
 #define ipICMP_PING_REQUEST_IPv6                 ( ( uint8_t ) 128U )
 #define ipICMP_PING_REPLY_IPv6                   ( ( uint8_t ) 129U )
+#define ipICMP_MULTICAST_LISTENER_QUERY_IPv6     ( ( uint8_t ) 130U )
+#define ipICMP_MULTICAST_LISTENER_REPORT_IPv6    ( ( uint8_t ) 131U )
+#define ipICMP_MULTICAST_LISTENER_DONE_IPv6      ( ( uint8_t ) 132U )
 #define ipICMP_ROUTER_SOLICITATION_IPv6          ( ( uint8_t ) 133U )
 #define ipICMP_ROUTER_ADVERTISEMENT_IPv6         ( ( uint8_t ) 134U )
 #define ipICMP_NEIGHBOR_SOLICITATION_IPv6        ( ( uint8_t ) 135U )
@@ -69,6 +72,13 @@
 /* Destination options may follow here in case there are no routing options. */
 #define ipIPv6_EXT_HEADER_MOBILITY_HEADER        135U
 
+/* Nearly all packets carry one of these protocols directly after the IPv6
+ * header, test them before looking for extension headers. */
+#define ipIPv6_IS_UPPER_LAYER_PROTOCOL( ucProtocol ) \
+    ( ( ( ucProtocol ) == ipPROTOCOL_TCP ) ||        \
+      ( ( ucProtocol ) == ipPROTOCOL_UDP ) ||        \
+      ( ( ucProtocol ) == ipPROTOCOL_ICMP_IPv6 ) )
+
 extern const struct xIPv6_Address FreeRTOS_in6addr_any;
 extern const struct xIPv6_Address FreeRTOS_in6addr_loopback;
 
@@ -109,6 +119,11 @@ eFrameProcessingResult_t eHandleIPv6ExtensionHeaders( NetworkBufferDescriptor_t
 
 extern void FreeRTOS_ClearND( void );
 
+#if ( ipconfigUSE_RESOURCE_STATS != 0 )
+    /* The number of occupied rows of the ND cache. */
+    UBaseType_t uxNDCacheRowsInUse( void );
+#endif
+
 /* Check whether this IPv6 address is an allowed multicast address or not. */
 BaseType_t xIsIPv6AllowedMulticast( const IPv6_Address_t * pxIPAddress );
 
@@ -0,0 +1,82 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_NAPT.h
+ * @brief Header file for the network address and port translation of
+ *        forwarded IPv4 packets.
+ */
+
+#ifndef FREERTOS_NAPT_H
+#define FREERTOS_NAPT_H
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Routing.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( ipconfigUSE_NAPT != 0 )
+
+/*
+ * Translate the forwarded packets that leave through 'pxEndPoint', so that
+ * the hosts behind the other end-points share its IPv4 address. Passing NULL
+ * stops the translation. Call it before FreeRTOS_IPInit_Multi(), or from
+ * the IP-task.
+ */
+    void FreeRTOS_SetNAPTEndPoint( NetworkEndPoint_t * pxEndPoint );
+
+/*
+ * Called by the IP-task for a received IPv4 packet before it is checked for
+ * forwarding. A reply to a translated connection gets the address and the
+ * port of the inside host.
+ */
+    void vNAPTInbound( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                       UBaseType_t uxHeaderLength );
+
+/*
+ * Called by the IP-task before a packet is forwarded through 'pxEndPoint'.
+ * Gives the packet the public address when needed. Returns pdFALSE when the
+ * packet can not be translated and must be dropped.
+ */
+    BaseType_t xNAPTOutbound( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                              UBaseType_t uxHeaderLength,
+                              const NetworkEndPoint_t * pxEndPoint );
+
+#endif /* ( ipconfigUSE_NAPT != 0 ) */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_NAPT_H */
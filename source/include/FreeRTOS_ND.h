@@ -45,6 +45,22 @@
 /* Miscellaneous structure and definitions. */
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_ND_HASH_TABLE != 0 )
+
+/**
+ * @brief The reachability state of an ND cache entry, see RFC 4861
+ *        section 7.3.2. Entries are only created once the MAC-address is
+ *        known, so there is no INCOMPLETE state.
+ */
+        typedef enum eND_CACHE_STATE
+        {
+            eNDStateReachable = 1, /**< Recently confirmed. */
+            eNDStateStale,         /**< No longer confirmed, but still usable. */
+            eNDStateDelay,         /**< A stale entry was used, wait before probing. */
+            eNDStateProbe          /**< Sending unicast neighbour solicitations. */
+        } eNDCacheState_t;
+    #endif
+
 /**
  * @brief 'NDCacheRow_t' defines one row in the ND address cache.
  * @note About A value that is periodically decremented but can
@@ -59,6 +75,13 @@
                                                * remote device had responded. */
         uint8_t ucAge;                        /**< See here above. */
         uint8_t ucValid;                      /**< pdTRUE: xMACAddress is valid, pdFALSE: waiting for ND reply */
+        #if ( ipconfigUSE_ND_HASH_TABLE != 0 )
+            uint8_t ucState;                  /**< The reachability state, an eNDCacheState_t. */
+            uint8_t ucStateTimer;             /**< Ageing periods left in the current state, or probes left. */
+        #endif
+        #if ( ipconfigARP_REFRESH_AHEAD_PERIODS > 0 )
+            uint8_t ucUsed;                   /**< Non-zero when the entry was used during the last ageing period. */
+        #endif
     } NDCacheRow_t;
 
 /*
@@ -104,6 +127,19 @@
  */
     void vNDAgeCache( void );
 
+    #if ( ipconfigND_STATIC_ENTRIES > 0 )
+
+/**
+ * @brief Add, change or remove a permanent IPv6 to MAC address mapping.
+ *        These entries do not age and are not cleared by FreeRTOS_ClearND().
+ */
+        BaseType_t FreeRTOS_AddStaticNDEntry( const IPv6_Address_t * pxIPAddress,
+                                              const MACAddress_t * pxMACAddress,
+                                              struct xNetworkEndPoint * pxEndPoint );
+
+        BaseType_t FreeRTOS_RemoveStaticNDEntry( const IPv6_Address_t * pxIPAddress );
+    #endif
+
 /**
  * @brief Send a neighbour solicitation.
  * @param[in] pxNetworkBuffer: A network buffer big enough to hold the ICMP packet.
@@ -189,6 +225,15 @@
         void vReceiveNA( const NetworkBufferDescriptor_t * pxNetworkBuffer );
     #endif
 
+    #if ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 )
+
+/** @brief A neighbour solicitation has been received. When it comes from the
+ *         unspecified address, another device is testing the same address.
+ *  @param[in] pxNetworkBuffer The buffer containing the packet.
+ */
+        void vReceiveNS( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+    #endif
+
 /* Receive a Router Advertisement. */
     #if ( ipconfigUSE_RA != 0 )
 
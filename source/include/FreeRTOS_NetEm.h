@@ -0,0 +1,144 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_NetEm.h
+ * @brief Header file for the network emulator, which imposes delay, jitter,
+ *        a limited bandwidth, loss and reordering on an interface.
+ */
+
+#ifndef FREERTOS_NETEM_H
+#define FREERTOS_NETEM_H
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Routing.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( ipconfigUSE_NETWORK_EMULATION != 0 )
+
+/** @brief The impairments of one direction. A direction of which all fields
+ *         are zero passes its frames without delay. */
+    typedef struct xNETEM_PARAMETERS
+    {
+        uint32_t ulDelayMs;        /**< The fixed delay of every frame. */
+        uint32_t ulJitterMs;       /**< A random delay of 0..ulJitterMs that is added, frames may overtake each other. */
+        uint32_t ulBytesPerSecond; /**< The bandwidth of the link, zero means: unlimited. */
+        uint32_t ulLossPPM;        /**< The chance that a frame gets lost, in parts per million. */
+        uint32_t ulDuplicatePPM;   /**< The chance that a frame is delivered twice, in parts per million. */
+        uint32_t ulReorderPPM;     /**< The chance that a frame skips the delay and overtakes the queued frames, in parts per million. */
+    } NetEmParameters_t;
+
+/** @brief The state and the counters of one direction. */
+    typedef struct xNETEM_DIRECTION
+    {
+        NetEmParameters_t xParameters; /**< See FreeRTOS_NetEmSetParameters(). */
+        TickType_t xLinkFreeTime;      /**< The time at which the emulated link has sent all queued bytes. */
+        uint32_t ulRateRemainder;      /**< The part of a clock tick that was not yet added to 'xLinkFreeTime'. */
+        uint32_t ulPassed;             /**< The number of frames delivered. */
+        uint32_t ulLost;               /**< The number of frames dropped by 'ulLossPPM'. */
+        uint32_t ulDuplicated;         /**< The number of extra copies made by 'ulDuplicatePPM'. */
+        uint32_t ulReordered;          /**< The number of frames sent early by 'ulReorderPPM'. */
+        uint32_t ulOverflows;          /**< The number of frames dropped because the queue was full. */
+    } NetEmDirection_t;
+
+/** @brief A frame that waits until its time has come. */
+    typedef struct xNETEM_ENTRY
+    {
+        NetworkBufferDescriptor_t * pxBuffer; /**< The frame. */
+        TickType_t xDueTime;                  /**< The time at which it is delivered. */
+        BaseType_t xOutgoing;                 /**< pdTRUE for a frame to be sent, pdFALSE for a received frame. */
+    } NetEmEntry_t;
+
+/** @brief An emulator attached to one interface, see FreeRTOS_NetEmAttach().
+ *         The fields are owned by the emulator, the counters may be read. */
+    typedef struct xNETEM
+    {
+        NetworkInterface_t * pxInterface;                               /**< The interface of which the traffic is impaired. */
+        NetworkInterfaceOutputFunction_t pfOutput;                      /**< The original output function of the interface. */
+        NetworkInterfacePollFunction_t pfPoll;                          /**< The original poll function of the interface, may be NULL. */
+        NetEmDirection_t xTx;                                           /**< The outgoing direction. */
+        NetEmDirection_t xRx;                                           /**< The incoming direction. */
+        NetEmEntry_t xQueue[ ipconfigNETWORK_EMULATION_QUEUE_LENGTH ];  /**< The waiting frames, sorted by their due time. */
+        UBaseType_t uxCount;                                            /**< The number of entries in xQueue[]. */
+        uint32_t ulRandom;                                              /**< The state of the pseudo-random generator. */
+        BaseType_t xReleasing;                                          /**< pdTRUE while a delayed frame is handed to the IP-task. */
+        TaskHandle_t xTask;                                             /**< The task that waits for the first due time. */
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            StaticTask_t xTaskBuffer;                                   /**< The TCB of 'xTask'. */
+            StackType_t xTaskStack[ configMINIMAL_STACK_SIZE ];         /**< The stack of 'xTask'. */
+        #endif
+        struct xNETEM * pxNext;                                         /**< The next emulator. */
+    } NetEm_t;
+
+/*
+ * Attach the emulator 'pxNetEm' to 'pxInterface', which must have been added
+ * before. The object pointed to by 'pxNetEm' must remain to exist. The same
+ * 'ulSeed' gives the same sequence of random decisions, so that a test run
+ * can be repeated. The emulator starts without impairments. Returns pdFAIL
+ * when the interface already has an emulator, or when its task could not be
+ * created.
+ */
+    BaseType_t FreeRTOS_NetEmAttach( NetEm_t * pxNetEm,
+                                     NetworkInterface_t * pxInterface,
+                                     uint32_t ulSeed );
+
+/*
+ * Change the impairments of the outgoing ( 'pxTx' ) and the incoming ( 'pxRx' )
+ * frames. A NULL pointer removes the impairments of that direction. Frames
+ * that are already queued keep their due time.
+ */
+    void FreeRTOS_NetEmSetParameters( NetEm_t * pxNetEm,
+                                      const NetEmParameters_t * pxTx,
+                                      const NetEmParameters_t * pxRx );
+
+/*
+ * Called by the IP-task for every received frame, before anything else
+ * looks at it. Returns pdFALSE when the emulator has taken the frame, it
+ * will be handed back to the IP-task when it is due.
+ */
+    BaseType_t xNetEmReceive( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Returns pdTRUE when an emulator is attached to the interface.
+ */
+    BaseType_t xNetEmAttached( const NetworkInterface_t * pxInterface );
+
+#endif /* ( ipconfigUSE_NETWORK_EMULATION != 0 ) */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_NETEM_H */
@@ -0,0 +1,135 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_PacketFilter.h
+ * @brief Header file for the rule-based filter of received frames.
+ */
+
+#ifndef FREERTOS_PACKET_FILTER_H
+#define FREERTOS_PACKET_FILTER_H
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Routing.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( ipconfigUSE_PACKET_FILTER != 0 )
+
+/** @brief What to do with a frame that matches a rule. */
+    typedef enum ePacketFilterAction
+    {
+        eFilterAccept, /**< Pass the frame to the stack, which may still drop it. */
+        eFilterDrop    /**< Drop the frame. */
+    } ePacketFilterAction_t;
+
+/** @brief The destination MAC addresses that a rule matches. */
+    typedef enum ePacketFilterDestination
+    {
+        eFilterAnyDestination,    /**< Any destination. */
+        eFilterGroupDestination,  /**< Broadcast and multicast addresses. */
+        eFilterUnicastDestination /**< Unicast addresses. */
+    } ePacketFilterDestination_t;
+
+/** @brief A rule of the packet filter.  Fields that are zero match anything.
+ *         All fields are in host-endian order. */
+    typedef struct xPacketFilterRule
+    {
+        ePacketFilterAction_t eAction;            /**< The action when the frame matches all fields. */
+        ePacketFilterDestination_t eDestination;  /**< The type of destination MAC address. */
+        uint16_t usFrameType;                     /**< The Ethernet type, e.g. 0x0800 for IPv4. */
+        uint8_t ucProtocol;                       /**< The IP protocol, needs an IPv4 or IPv6 usFrameType. */
+        uint16_t usSourcePort;                    /**< The UDP or TCP source port, needs a UDP or TCP ucProtocol. */
+        uint16_t usDestinationPort;               /**< The UDP or TCP destination port, needs a UDP or TCP ucProtocol. */
+    } PacketFilterRule_t;
+
+/** @brief The operations of the packet filter program.  'A' is the
+ *         accumulator, 'X' the index register, 'K' the ulValue field. */
+    typedef enum ePacketFilterOpcode
+    {
+        ePacketFilterLoadByte,        /**< A = frame[ K ]. */
+        ePacketFilterLoadHalf,        /**< A = the 16-bit big-endian word at frame[ K ]. */
+        ePacketFilterLoadHalfIndexed, /**< A = the 16-bit big-endian word at frame[ X + K ]. */
+        ePacketFilterLoadIPv4Length,  /**< X = 4 * ( frame[ K ] & 0x0F ), the size of an IPv4 header. */
+        ePacketFilterJumpEqual,       /**< Skip ucJumpTrue instructions when A == K, else ucJumpFalse. */
+        ePacketFilterJumpSet,         /**< Skip ucJumpTrue instructions when ( A & K ) != 0, else ucJumpFalse. */
+        ePacketFilterReturn           /**< Stop: accept the frame when K is non-zero, else drop it. */
+    } ePacketFilterOpcode_t;
+
+/** @brief One instruction of a compiled packet filter.  Jumps only go
+ *         forward, so every program ends. */
+    typedef struct xPacketFilterInstruction
+    {
+        uint8_t ucOpcode;    /**< An ePacketFilterOpcode_t. */
+        uint8_t ucJumpTrue;  /**< The number of instructions skipped when a jump condition is true. */
+        uint8_t ucJumpFalse; /**< The number of instructions skipped when a jump condition is false. */
+        uint8_t ucReserved;  /**< Keeps ulValue aligned. */
+        uint32_t ulValue;    /**< The offset, constant or return value. */
+    } PacketFilterInstruction_t;
+
+/*
+ * Compile 'uxRuleCount' rules and install them as the packet filter of all
+ * interfaces.  The first rule that matches a frame decides, frames that
+ * match no rule are accepted.  Passing zero rules removes the filter.
+ * The program is passed to pfSetPacketFilter() of the interfaces that have
+ * one.  Returns pdFAIL, and keeps the old filter, when a rule is invalid or
+ * when the program needs more than ipconfigPACKET_FILTER_MAX_INSTRUCTIONS.
+ */
+    BaseType_t FreeRTOS_SetPacketFilter( const PacketFilterRule_t * pxRules,
+                                         size_t uxRuleCount );
+
+/*
+ * Run the packet filter program over a received frame.  Returns pdFALSE when
+ * the frame must be dropped.  Frames that are too short for a load are
+ * accepted, so the normal checks of the stack decide about them.
+ */
+    BaseType_t xPacketFilterRun( const PacketFilterInstruction_t * pxProgram,
+                                 size_t uxLength,
+                                 const uint8_t * pucFrame,
+                                 size_t uxFrameLength );
+
+/*
+ * Called by the IP-task at the start of prvProcessEthernetPacket(): run the
+ * installed program, unless the interface filters in hardware.  Returns
+ * pdFALSE when the frame must be dropped.
+ */
+    BaseType_t xPacketFilterAccepts( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+#endif /* ( ipconfigUSE_PACKET_FILTER != 0 ) */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_PACKET_FILTER_H */
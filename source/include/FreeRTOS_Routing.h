@@ -38,6 +38,10 @@
         #include "FreeRTOS_DHCPv6.h"
     #endif
 
+    #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+        #include "semphr.h"
+    #endif
+
     #ifdef __cplusplus
     extern "C" {
     #endif
@@ -59,6 +63,165 @@
     typedef void ( * NetworkInterfaceMACFilterFunction_t ) ( struct xNetworkInterface * pxInterface,
                                                              const uint8_t * pucMacAddressBytes );
 
+    #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+
+/* Called by the IP-task: handle at most xBudget received frames and return
+ * the number handled, see ipconfigUSE_NETWORK_INTERFACE_POLL. */
+        typedef BaseType_t ( * NetworkInterfacePollFunction_t ) ( struct xNetworkInterface * pxDescriptor,
+                                                                  BaseType_t xBudget );
+    #endif
+
+    #if ( ipconfigUSE_PACKET_FILTER != 0 )
+        struct xPacketFilterInstruction; /* Defined in FreeRTOS_PacketFilter.h. */
+
+/* Offered the compiled packet filter, see FreeRTOS_SetPacketFilter(). Return
+ * pdPASS when the hardware will drop the frames that the program drops. */
+        typedef BaseType_t ( * NetworkInterfacePacketFilterFunction_t ) ( struct xNetworkInterface * pxDescriptor,
+                                                                          const struct xPacketFilterInstruction * pxProgram,
+                                                                          size_t uxLength );
+    #endif
+
+    #if ( ipconfigUSE_NETWORK_RX_RING != 0 )
+
+/** @brief A single-producer/single-consumer ring that carries received
+ *         network buffers from a driver to the IP-task. */
+        typedef struct xNetworkRxRing
+        {
+            NetworkBufferDescriptor_t * pxBuffers[ ipconfigNETWORK_RX_RING_LENGTH ]; /**< The slots of the ring. */
+            volatile size_t uxHead;                                                 /**< Only written by the driver: the number of buffers stored. */
+            volatile size_t uxTail;                                                 /**< Only written by the IP-task: the number of buffers taken. */
+            volatile BaseType_t xEventPending;                                      /**< pdTRUE while the IP-task has been woken up for this ring. */
+        } NetworkRxRing_t;
+    #endif /* ipconfigUSE_NETWORK_RX_RING */
+
+    #if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+
+/** @brief A single-producer/single-consumer reserve of empty network buffers,
+ *         filled by the IP-task and emptied by the interrupt handler of a
+ *         driver. */
+        typedef struct xNetworkBufferReserve
+        {
+            NetworkBufferDescriptor_t * pxBuffers[ ipconfigNETWORK_BUFFER_RX_RESERVE ]; /**< The slots of the reserve. */
+            volatile size_t uxHead;                                                    /**< Only written by the IP-task: the number of buffers stored. */
+            volatile size_t uxTail;                                                    /**< Only written by the driver: the number of buffers taken. */
+        } NetworkBufferReserve_t;
+    #endif /* ipconfigNETWORK_BUFFER_RX_RESERVE */
+
+    #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+
+/** @brief One RX/TX hardware queue pair of a network interface. */
+        typedef struct xNetworkQueue
+        {
+            void * pvRxQueue;  /**< Owned by the driver: its receive ring of this queue. */
+            void * pvTxQueue;  /**< Owned by the driver: its transmit ring of this queue. */
+            uint32_t ulRxCount; /**< The number of frames received through this queue. */
+            uint32_t ulTxCount; /**< The number of frames sent through this queue. */
+        } NetworkQueue_t;
+
+/* Return the index of the TX queue through which a packet will be sent. */
+        typedef UBaseType_t ( * NetworkInterfaceQueueSelectFunction_t ) ( struct xNetworkInterface * pxInterface,
+                                                                          const NetworkBufferDescriptor_t * pxNetworkBuffer );
+    #endif /* ipconfigUSE_NETWORK_MULTI_QUEUE */
+
+    #if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+
+/** @brief The number of buckets of the multicast hash of a MACFilter_t. */
+        #define ipMAC_FILTER_HASH_BUCKETS    64U
+
+/** @brief The stack's copy of the MAC address filter of an interface, see
+ *         ipconfigUSE_SOFTWARE_MAC_FILTER. */
+        typedef struct xMACFilter
+        {
+            MACAddress_t xExact[ ipconfigMAC_FILTER_EXACT_ENTRIES ]; /**< The unicast MAC addresses of the end-points. */
+            UBaseType_t uxExactCount;                                /**< The number of entries used in xExact[]. */
+            BaseType_t xExactOverflow;                               /**< pdTRUE when xExact[] can not hold all addresses: accept all unicast frames. */
+            uint32_t ulHashBits[ ipMAC_FILTER_HASH_BUCKETS / 32U ];  /**< Bit N is set while usHashUsers[ N ] is non-zero. */
+            uint16_t usHashUsers[ ipMAC_FILTER_HASH_BUCKETS ];       /**< The number of allowed addresses in each bucket. */
+        } MACFilter_t;
+    #endif /* ipconfigUSE_SOFTWARE_MAC_FILTER */
+
+/** @brief The reasons why a received packet was dropped, see
+ *         iptraceRX_PACKET_DROPPED() and ipconfigUSE_NETWORK_COUNTERS. */
+    typedef enum eNetworkDropReason
+    {
+        eDropMalformed,       /**< The packet is too short, or a header is invalid. */
+        eDropFiltered,        /**< The packet is not addressed to this host, or it was refused, e.g. a fragment. */
+        eDropChecksum,        /**< The IP-header or the protocol checksum is wrong. */
+        eDropUnsupported,     /**< An Ethernet type or IP protocol that is not handled. */
+        eDropARPPending,      /**< No buffer was left to wait for the address resolution of the sender. */
+        eDropNoSocket,        /**< No socket is bound to the destination port. */
+        eDropSocketQueueFull, /**< The receive queue of the UDP socket is full. */
+        eDropNoBuffer,        /**< The driver had no network buffer to store the frame. */
+        eDropNoRoute,         /**< A packet could not be forwarded, see ipconfigUSE_IP_FORWARDING. */
+        eDropRateLimited,     /**< An ICMP message was not answered, see ipconfigUSE_ICMP_RATE_LIMIT. */
+        eDropReasonMax        /**< The number of reasons. */
+    } eNetworkDropReason_t;
+
+    #if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+
+/** @brief The protocols that are counted separately, see NetworkCounters_t. */
+        typedef enum eNetworkCounterProtocol
+        {
+            eCounterIPv4,       /**< IPv4 packets, including the ICMP, UDP and TCP packets below. */
+            eCounterIPv6,       /**< IPv6 packets, including the ICMPv6, UDP and TCP packets below. */
+            eCounterARP,        /**< ARP packets. */
+            eCounterICMP,       /**< ICMP and ICMPv6 packets. */
+            eCounterUDP,        /**< UDP packets. */
+            eCounterTCP,        /**< TCP packets. */
+            eCounterProtocolMax /**< The number of protocols. */
+        } eNetworkCounterProtocol_t;
+
+/** @brief Packet and byte counts in both directions. */
+        typedef struct xNetworkTrafficCounters
+        {
+            uint32_t ulRxPackets; /**< The number of packets received. */
+            uint32_t ulTxPackets; /**< The number of packets passed to the driver. */
+            uint64_t ullRxBytes;  /**< The number of bytes received, including the Ethernet header. */
+            uint64_t ullTxBytes;  /**< The number of bytes passed to the driver, including the Ethernet header. */
+        } NetworkTrafficCounters_t;
+
+/** @brief The counters of a network interface, see ipconfigUSE_NETWORK_COUNTERS. */
+        typedef struct xNetworkCounters
+        {
+            NetworkTrafficCounters_t xTotal;                            /**< All packets of the interface. */
+            NetworkTrafficCounters_t xProtocols[ eCounterProtocolMax ]; /**< The packets per protocol. */
+            uint32_t ulRxDropped[ eDropReasonMax ];                     /**< The dropped packets per reason. */
+            uint32_t ulRxQueueFull;                                     /**< The times a received frame could not be passed to the IP-task. */
+            uint32_t ulTxErrors;                                        /**< The times that pfOutput() returned pdFAIL. */
+        } NetworkCounters_t;
+    #endif /* ipconfigUSE_NETWORK_COUNTERS */
+
+    #if ( ipconfigUSE_BRING_UP_TIMELINE != 0 )
+
+/** @brief The milestones of the network bring-up, see ipconfigUSE_BRING_UP_TIMELINE.
+ *  The first four are recorded per interface, the others per end-point. */
+        typedef enum eBringUpMilestone
+        {
+            eBringUpIPInit,          /**< FreeRTOS_IPInit_Multi() was called. */
+            eBringUpInitialiseStart, /**< pfInitialise() was called for the first time. */
+            eBringUpInitialiseDone,  /**< pfInitialise() returned pdPASS. */
+            eBringUpLinkUp,          /**< The driver reported that the link is up. */
+            eBringUpDHCPRequest,     /**< The first DHCP DISCOVER or DHCPv6 SOLICIT was sent. */
+            eBringUpDHCPOffer,       /**< A DHCP OFFER or DHCPv6 ADVERTISE was received. */
+            eBringUpDHCPAck,         /**< A DHCP ACK or DHCPv6 REPLY was received. */
+            eBringUpRASolicit,       /**< The first Router Solicitation was sent. */
+            eBringUpRAAdvert,        /**< A Router Advertisement was received. */
+            eBringUpDADStart,        /**< The first Neighbour Solicitation for duplicate address detection was sent. */
+            eBringUpDADDone,         /**< Duplicate address detection found no other user of the address. */
+            eBringUpNetworkUp,       /**< The end-point went up. */
+            eBringUpFirstNeighbour,  /**< The first ARP or ND cache entry was learned. */
+            eBringUpMilestoneMax     /**< The number of milestones. */
+        } eBringUpMilestone_t;
+
+/** @brief The time at which each milestone was passed for the first time. */
+        typedef struct xBringUpTimeline
+        {
+            uint32_t ulPassed;                       /**< A bit for each milestone that was passed. */
+            uint32_t ulTime[ eBringUpMilestoneMax ]; /**< Unit: ipconfigBRING_UP_TIMELINE_TIME(). Valid when the bit in ulPassed is set. */
+            uint32_t ulInitialiseCalls;              /**< Interfaces only: the number of calls to pfInitialise(). */
+        } BringUpTimeline_t;
+    #endif /* ipconfigUSE_BRING_UP_TIMELINE */
+
 /** @brief These NetworkInterface access functions are collected in a struct: */
     typedef struct xNetworkInterface
     {
@@ -107,11 +270,72 @@
         {
             uint32_t
                 bInterfaceUp : 1,             /**< Non-zero as soon as the interface is up. */
-                bCallDownEvent : 1;           /**< The down-event must be called. */
+                bCallDownEvent : 1,           /**< The down-event must be called. */
+                bTCPSegmentationOffload : 1,  /**< Set by the driver when it can split large TCP packets, see ipconfigUSE_TCP_TSO. */
+                bRxChecksumOffload : 1,       /**< Set by the driver when the hardware verifies incoming checksums, see ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD. */
+                bTxChecksumOffload : 1,       /**< Set by the driver when the hardware inserts outgoing checksums, see ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD. */
+                bBringingUp : 1,              /**< Set while not all end-points are up after the interface came up, see ipconfigUSE_FAST_BRING_UP. */
+                bScatterGather : 1,           /**< Set by the driver when it can send a frame with segments, see ipconfigUSE_SCATTER_GATHER. */
+                bVLANTagOffload : 1,          /**< Set by the driver when the hardware inserts and strips 802.1Q tags, see ipconfigUSE_VLAN. */
+                bPacketFilterOffload : 1;     /**< Set by the stack when pfSetPacketFilter() accepted the program, see ipconfigUSE_PACKET_FILTER. */
         } bits;                               /**< A collection of boolean flags. */
+        #if ( ipconfigUSE_FAST_BRING_UP != 0 )
+            TickType_t xBringUpTime;          /**< The time at which the interface came up. */
+            TickType_t xTimeToReady;          /**< The number of ticks it took until all end-points were up. */
+        #endif
 
         struct xNetworkEndPoint * pxEndPoint; /**< A list of end-points bound to this interface. */
         struct xNetworkInterface * pxNext;    /**< The next interface in a linked list. */
+        #if ( ipconfigUSE_NETWORK_RX_RING != 0 )
+            NetworkRxRing_t xRxRing;          /**< Received buffers waiting for the IP-task. */
+        #endif
+        #if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+            NetworkBufferReserve_t xRxReserve; /**< Empty buffers for pxNetworkBufferGetFromReserveISR(). */
+        #endif
+        #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+            SemaphoreHandle_t xTxMutex;       /**< Taken around each call to pfOutput(), see xIPInterfaceOutput(). */
+        #endif
+        #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+            NetworkInterfacePollFunction_t pfPoll; /**< Optional: lets the IP-task fetch received frames, see ipconfigUSE_NETWORK_INTERFACE_POLL. */
+            volatile BaseType_t xPollPending;      /**< pdTRUE while a poll of this interface has been requested. */
+        #endif
+        #if ( ipconfigUSE_TX_BACKPRESSURE != 0 )
+            NetworkBufferDescriptor_t * pxTxHeld; /**< The frame that pfOutput() refused with ipTX_BUSY, it is sent first when the driver has room. */
+            BaseType_t xTxBusy;                   /**< pdTRUE from an ipTX_BUSY until the IP-task handles FreeRTOS_NetworkInterfaceTxReady(). */
+            volatile BaseType_t xTxReadyPending;  /**< pdTRUE while an eNetworkTxReadyEvent for this interface is on its way. */
+        #endif
+        #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+            UBaseType_t uxQueueCount;                            /**< The number of entries of xQueues[] used by the driver. */
+            NetworkQueue_t xQueues[ ipconfigNETWORK_MAX_QUEUES ]; /**< The RX/TX queue pairs of the hardware. */
+            NetworkInterfaceQueueSelectFunction_t pfSelectQueue; /**< Optional TX queue policy, NULL means: use ulNetworkFlowHash(). */
+        #endif
+        #if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+            NetworkCounters_t xCounters; /**< Read them with FreeRTOS_GetNetworkCounters(). */
+        #endif
+        #if ( ipconfigUSE_BRING_UP_TIMELINE != 0 )
+            BringUpTimeline_t xTimeline; /**< Read it with FreeRTOS_GetInterfaceTimeline(). */
+        #endif
+        #if ( ipconfigUSE_INTERFACE_MTU != 0 )
+            size_t uxMTU; /**< The MTU of this interface, zero means ipconfigNETWORK_MTU, see uxInterfaceMTU(). */
+        #endif
+        #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+            uint32_t ulLinkSpeed; /**< The speed of the link in Mbit/s, zero when not known, set by the driver, see ipconfigUSE_TCP_LINK_SPEED_SIZING. */
+        #endif
+        #if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+            MACFilter_t xMACFilter; /**< Checked before eConsiderFrameForProcessing(), see ipconfigUSE_SOFTWARE_MAC_FILTER. */
+        #endif
+        #if ( ipconfigUSE_PACKET_FILTER != 0 )
+            NetworkInterfacePacketFilterFunction_t pfSetPacketFilter; /**< Optional: filter in hardware, see ipconfigUSE_PACKET_FILTER. */
+        #endif
+        #if ( ipconfigUSE_VLAN != 0 )
+            struct xNetworkInterface * pxVLANParent; /**< The physical interface of a VLAN interface, NULL for a physical interface. */
+            uint16_t usVLANTag;                      /**< The 802.1Q tag of a VLAN interface: priority and VLAN ID, see FreeRTOS_FillVLANInterface(). */
+        #endif
+        #if ( ipconfigUSE_LINK_BONDING != 0 )
+            struct xNetworkInterface * pxBond;       /**< The bond of which this physical interface is a member, otherwise NULL, see FreeRTOS_AddBondMember(). */
+            struct xNetworkInterface * pxBondFirst;  /**< The first member of a bond interface. */
+            struct xNetworkInterface * pxBondNext;   /**< The next member of the same bond. */
+        #endif
     } NetworkInterface_t;
 
 /*
@@ -134,6 +358,9 @@
         uint32_t ulDNSServerAddresses[ ipconfigENDPOINT_DNS_ADDRESS_COUNT ]; /**< IP-addresses of DNS servers. */
         uint32_t ulBroadcastAddress;                                         /**< The local broadcast address, e.g. '192.168.1.255'. */
         uint8_t ucDNSIndex;                                                  /**< The index of the next DNS address to be used. */
+        #if ( ipconfigDNS_PARALLEL_SERVERS > 1 )
+            uint32_t ulDNSServerRTT[ ipconfigENDPOINT_DNS_ADDRESS_COUNT ];   /**< Smoothed round-trip times of the DNS servers in ms, 0 when not measured. */
+        #endif
     } IPV4Parameters_t;
 
     #if ( ipconfigUSE_IPv6 != 0 )
@@ -145,6 +372,9 @@
             IPv6_Address_t xGatewayAddress; /* Gateway to the web. */
             IPv6_Address_t xDNSServerAddresses[ ipconfigENDPOINT_DNS_ADDRESS_COUNT ];
             uint8_t ucDNSIndex;             /**< The index of the next DNS address to be used. */
+            #if ( ipconfigDNS_PARALLEL_SERVERS > 1 )
+                uint32_t ulDNSServerRTT[ ipconfigENDPOINT_DNS_ADDRESS_COUNT ]; /**< Smoothed round-trip times of the DNS servers in ms, 0 when not measured. */
+            #endif
         } IPV6Parameters_t;
     #endif
 
@@ -168,6 +398,9 @@
                 uint32_t
                     bRouterReplied : 1,
                     bIPAddressInUse : 1;
+                #if ( ipconfigUSE_RA_OPTIMISTIC_DAD != 0 )
+                    uint32_t bOptimistic : 1; /* The address is in use while DAD is still running. */
+                #endif
             }
             bits;
             TickType_t ulPreferredLifeTime;
@@ -221,6 +454,9 @@
         #if ( ipconfigUSE_RA != 0 )
             RAData_t xRAData;                    /**< A description of the Router Advertisement ( RA ) client state machine. */
         #endif /* ( ipconfigUSE_RA != 0 ) */
+        #if ( ipconfigUSE_BRING_UP_TIMELINE != 0 )
+            BringUpTimeline_t xTimeline;         /**< Read it with FreeRTOS_GetEndPointTimeline(). */
+        #endif
         NetworkInterface_t * pxNetworkInterface; /**< The network interface that owns this end-point. */
         struct xNetworkEndPoint * pxNext;        /**< The next end-point in the chain. */
     } NetworkEndPoint_t;
@@ -319,6 +555,137 @@
  * xIPType should equal ipTYPE_IPv4 or ipTYPE_IPv6. */
     NetworkEndPoint_t * FreeRTOS_FindGateWay( BaseType_t xIPType );
 
+    #if ( ipconfigUSE_ROUTE_ECMP != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 )
+
+/* Find the end-point with a gateway that leads to 'pxDestination'. When
+ * several end-points have a gateway, the destination selects one of them.
+ * xIPType should equal ipTYPE_IPv4 or ipTYPE_IPv6. */
+        NetworkEndPoint_t * FreeRTOS_FindGateWayForDestination( const IP_Address_t * pxDestination,
+                                                                BaseType_t xIPType );
+    #endif
+
+    #if ( ipconfigUSE_ROUTE_CACHE != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 )
+
+/* Forget the cached results of FreeRTOS_FindEndPointOnNetMask() and
+ * FreeRTOS_FindGateWay(). To be called when the addressing of an end-point
+ * changes. */
+        void FreeRTOS_RouteCacheInvalidate( void );
+    #else
+        #define FreeRTOS_RouteCacheInvalidate()    do {} while( ipFALSE_BOOL )
+    #endif
+
+    #if ( ipconfigUSE_NETWORK_COUNTERS != 0 )
+
+/* Copy the counters of 'pxInterface' to 'pxCounters'. When 'pxInterface' is
+ * NULL, the sum of the counters of all interfaces is returned. */
+        void FreeRTOS_GetNetworkCounters( const NetworkInterface_t * pxInterface,
+                                          NetworkCounters_t * pxCounters );
+
+/* Reset the counters of 'pxInterface', or of all interfaces when it is NULL. */
+        void FreeRTOS_ClearNetworkCounters( NetworkInterface_t * pxInterface );
+    #endif
+
+    #if ( ipconfigUSE_BRING_UP_TIMELINE != 0 )
+
+/* Record that an interface or end-point passed a milestone.  Only the first
+ * time is kept.  A driver may call vBringUpInterfaceMilestone() with
+ * eBringUpLinkUp once auto-negotiation has completed. */
+        void vBringUpInterfaceMilestone( NetworkInterface_t * pxInterface,
+                                         eBringUpMilestone_t eMilestone );
+
+        void vBringUpEndPointMilestone( NetworkEndPoint_t * pxEndPoint,
+                                        eBringUpMilestone_t eMilestone );
+
+/* Copy the bring-up timeline of an interface or an end-point. */
+        void FreeRTOS_GetInterfaceTimeline( const NetworkInterface_t * pxInterface,
+                                            BringUpTimeline_t * pxTimeline );
+
+        void FreeRTOS_GetEndPointTimeline( const NetworkEndPoint_t * pxEndPoint,
+                                           BringUpTimeline_t * pxTimeline );
+
+/* Forget all milestones, e.g. to measure the bring-up after a link loss. */
+        void FreeRTOS_ClearBringUpTimelines( void );
+    #else
+        #define vBringUpInterfaceMilestone( pxInterface, eMilestone )    do {} while( ipFALSE_BOOL )
+        #define vBringUpEndPointMilestone( pxEndPoint, eMilestone )      do {} while( ipFALSE_BOOL )
+    #endif /* ipconfigUSE_BRING_UP_TIMELINE */
+
+    #if ( ipconfigUSE_INTERFACE_MTU != 0 )
+
+/* Return the MTU of 'pxInterface', never more than ipconfigNETWORK_MTU. */
+        size_t uxInterfaceMTU( const NetworkInterface_t * pxInterface );
+    #else
+        #define uxInterfaceMTU( pxInterface )    ( ( size_t ) ipconfigNETWORK_MTU )
+    #endif
+
+    #if ( ipconfigUSE_TCP_LINK_SPEED_SIZING != 0 )
+
+/* Return the link speed of 'pxInterface' in Mbit/s, or zero when not known. */
+        uint32_t ulInterfaceLinkSpeed( const NetworkInterface_t * pxInterface );
+    #else
+        #define ulInterfaceLinkSpeed( pxInterface )    ( 0U )
+    #endif
+
+    #if ( ipconfigUSE_SOFTWARE_MAC_FILTER != 0 )
+
+/* Let 'pxInterface' receive frames sent to 'pucMACAddress': update the
+ * software filter and call pfAddAllowedMAC(). */
+        void vNetworkInterfaceAddAllowedMAC( NetworkInterface_t * pxInterface,
+                                             const uint8_t * pucMACAddress );
+
+/* Undo one call to vNetworkInterfaceAddAllowedMAC(). */
+        void vNetworkInterfaceRemoveAllowedMAC( NetworkInterface_t * pxInterface,
+                                                const uint8_t * pucMACAddress );
+
+/* Copy the MAC addresses of the end-points of 'pxInterface' to its filter. */
+        void vMACFilterUpdateEndPoints( NetworkInterface_t * pxInterface );
+
+/* Return pdTRUE when the filter of 'pxInterface' accepts frames that are sent
+ * to 'pxMACAddress'. */
+        BaseType_t xMACFilterAccepts( const NetworkInterface_t * pxInterface,
+                                      const MACAddress_t * pxMACAddress );
+    #else
+        #define vNetworkInterfaceAddAllowedMAC( pxInterface, pucMACAddress )        \
+    do {                                                                            \
+        if( ( pxInterface )->pfAddAllowedMAC != NULL )                              \
+        {                                                                           \
+            ( pxInterface )->pfAddAllowedMAC( ( pxInterface ), ( pucMACAddress ) ); \
+        }                                                                           \
+    } while( ipFALSE_BOOL )
+
+        #define vNetworkInterfaceRemoveAllowedMAC( pxInterface, pucMACAddress )        \
+    do {                                                                               \
+        if( ( pxInterface )->pfRemoveAllowedMAC != NULL )                              \
+        {                                                                              \
+            ( pxInterface )->pfRemoveAllowedMAC( ( pxInterface ), ( pucMACAddress ) ); \
+        }                                                                              \
+    } while( ipFALSE_BOOL )
+    #endif /* ipconfigUSE_SOFTWARE_MAC_FILTER */
+
+    #if ( ipconfigUSE_STATIC_ROUTES != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 )
+
+/* Add a route to the network 'pxPrefix'/'uxPrefixLength' through 'pxGateway',
+ * which is reached by 'pxEndPoint'. A NULL gateway makes an on-link route. */
+        BaseType_t FreeRTOS_AddRoute( const IP_Address_t * pxPrefix,
+                                      size_t uxPrefixLength,
+                                      const IP_Address_t * pxGateway,
+                                      NetworkEndPoint_t * pxEndPoint,
+                                      uint8_t ucMetric );
+
+/* Remove a route that was added by FreeRTOS_AddRoute(). */
+        BaseType_t FreeRTOS_RemoveRoute( const IP_Address_t * pxPrefix,
+                                         size_t uxPrefixLength,
+                                         const IP_Address_t * pxGateway,
+                                         NetworkEndPoint_t * pxEndPoint );
+
+/* Find the longest static route that matches 'pxDestination'. Returns the
+ * end-point to use and sets 'pxNextHop', or returns NULL.
+ * xIPType should equal ipTYPE_IPv4 or ipTYPE_IPv6. */
+        NetworkEndPoint_t * FreeRTOS_FindRoute( const IP_Address_t * pxDestination,
+                                                BaseType_t xIPType,
+                                                IP_Address_t * pxNextHop );
+    #endif /* ( ipconfigUSE_STATIC_ROUTES != 0 ) && ( ipconfigCOMPATIBLE_WITH_SINGLE == 0 ) */
+
 /* Fill-in the end-point structure. */
     void FreeRTOS_FillEndPoint( NetworkInterface_t * pxNetworkInterface,
                                 NetworkEndPoint_t * pxEndPoint,
@@ -350,6 +717,26 @@
                                      size_t uxSize );
     #endif /* ( ( ipconfigHAS_PRINTF != 0 ) || ( ipconfigHAS_DEBUG_PRINTF != 0 ) ) */
 
+    #if ( ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 ) || ( ipconfigUSE_LINK_BONDING != 0 ) )
+
+/*
+ * A hash of the IP addresses, the protocol and the ports of an Ethernet
+ * frame.  Both directions of a connection get the same hash.
+ */
+        uint32_t ulNetworkFlowHash( const uint8_t * pucEthernetBuffer,
+                                    size_t uxLength );
+    #endif
+
+    #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+
+/*
+ * Return the index of the TX queue of 'pxInterface' that should send the
+ * packet, see ipconfigUSE_NETWORK_MULTI_QUEUE.
+ */
+        UBaseType_t uxNetworkInterfaceSelectQueue( NetworkInterface_t * pxInterface,
+                                                   const NetworkBufferDescriptor_t * pxNetworkBuffer );
+    #endif /* ipconfigUSE_NETWORK_MULTI_QUEUE */
+
     typedef enum
     {
         eIPv6_Global,    /* 001           */
@@ -95,6 +95,8 @@
     #define FREERTOS_SOCK_DEPENDENT_PROTO    ( 0 )
 
     #define FREERTOS_AF_INET4                FREERTOS_AF_INET
+/* Only used in the hints of FreeRTOS_getaddrinfo(): ask for both A and AAAA records. */
+    #define FREERTOS_AF_UNSPEC               ( 0 )
 /* Values for xFlags parameter of Receive/Send functions. */
     #define FREERTOS_ZERO_COPY               ( 1 )  /* Can be used with recvfrom(), sendto() and recv(),
                                                      * Indicates that the zero copy interface is being used.
@@ -103,6 +105,7 @@
     #define FREERTOS_MSG_PEEK                ( 4 )  /* Can be used with recvfrom() and recv(). */
     #define FREERTOS_MSG_DONTROUTE           ( 8 )  /* Not used. */
     #define FREERTOS_MSG_DONTWAIT            ( 16 ) /* Can be used with recvfrom(), sendto(), recv() and send(). */
+    #define FREERTOS_MSG_MORE                ( 32 ) /* Can be used with send(). More data follows, do not send a segment that is not full. */
 
 /* Values that can be passed in the option name parameter of calls to
  * FreeRTOS_setsockopt(). */
@@ -141,6 +144,7 @@
 
     #if ( ipconfigUDP_MAX_RX_PACKETS > 0 )
         #define FREERTOS_SO_UDP_MAX_RX_PACKETS    ( 16 ) /* This option helps to limit the maximum number of packets a UDP socket will buffer. */
+        #define FREERTOS_SO_UDP_RX_DROP_OLDEST    ( 25 ) /* When the limit is reached, drop the oldest packet in stead of the new one, parameter is a pointer to a BaseType_t. */
     #endif
 
     #if ( ipconfigSOCKET_HAS_USER_WAKE_CALLBACK == 1 )
@@ -150,6 +154,93 @@
     #if ( ipconfigUSE_TCP == 1 )
         #define FREERTOS_SO_SET_LOW_HIGH_WATER            ( 18 )
     #endif
+
+    #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) )
+        #define FREERTOS_SO_TCP_CONGESTION    ( 19 ) /* Select the congestion control, parameter is a pointer to a TCPCongestionControl_t, e.g. &xTCPCongestionCubic. */
+    #endif
+
+    #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_RX_BUFFER_COUNT != 0 ) )
+        #define FREERTOS_SO_RX_BUFFER_CHAIN    ( 20 ) /* Keep received network buffers instead of copying their payload to the RX stream, parameter is a pointer to a BaseType_t. */
+    #endif
+
+    #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigTCP_LISTEN_POOL_SIZE != 0 ) )
+        #define FREERTOS_SO_LISTEN_POOL    ( 21 ) /* Set the number of child sockets that a listening socket creates in advance, parameter is a pointer to a BaseType_t. */
+    #endif
+
+    #if ( ipconfigUSE_TCP == 1 )
+        #define FREERTOS_SO_TCP_CORK    ( 23 ) /* Hold back data that does not fill a segment until the option is cleared, parameter is a pointer to a BaseType_t. */
+    #endif
+
+    #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_PACING != 0 ) )
+        #define FREERTOS_SO_TCP_PACING      ( 22 )          /* Pace the transmissions, parameter is a pointer to a uint32_t: a rate in bytes per second, 0 to disable, or FREERTOS_TCP_PACING_AUTO. */
+        #define FREERTOS_TCP_PACING_AUTO    ( 0xFFFFFFFFU ) /* Derive the rate from the congestion window and the round-trip time. */
+    #endif
+
+    #if ( ipconfigUSE_TCP == 1 )
+        #define FREERTOS_SO_TCP_INFO    ( 24 ) /* FreeRTOS_getsockopt() only: get the statistics of a TCP connection, parameter is a pointer to a TCPInfo_t. */
+    #endif
+
+    #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 ) )
+        #define FREERTOS_SO_TCP_WIN_EVENT_LOG    ( 30 ) /* FreeRTOS_getsockopt() only: get the recent window events of a TCP connection, oldest first, parameter is an array of TCPWinEvent_t. */
+    #endif
+
+    #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_ACK_POLICY != 0 ) )
+        #define FREERTOS_SO_TCP_ACK_POLICY    ( 31 ) /* Select when ACK's are sent, parameter is a pointer to a TCPAckPolicy_t. */
+        #define FREERTOS_TCP_ACK_DEFAULT      ( 0 )  /* Delay an ACK by tcpDELAYED_ACK_SHORT_DELAY_MS or tcpDELAYED_ACK_LONGER_DELAY_MS. */
+        #define FREERTOS_TCP_ACK_QUICK        ( 1 )  /* Never delay an ACK. */
+        #define FREERTOS_TCP_ACK_EVERY_N      ( 2 )  /* ACK every 'ucSegments' segments, or when the delay expires. */
+        #define FREERTOS_TCP_ACK_ADAPTIVE     ( 3 )  /* ACK immediately when the traffic looks interactive, otherwise every second segment. */
+    #endif
+
+    #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_FAST_OPEN != 0 ) )
+        #define FREERTOS_SO_TCP_FASTOPEN    ( 32 ) /* Use TCP Fast Open, must be set before FreeRTOS_listen() or FreeRTOS_connect(), parameter is a pointer to a BaseType_t. */
+    #endif
+
+    #if ( ipconfigUSE_DUAL_STACK_SOCKETS != 0 )
+        #define FREERTOS_SO_IPV6_V6ONLY    ( 33 ) /* Non-zero: an IPv6 socket will not handle IPv4 traffic, must be set before binding, parameter is a pointer to a BaseType_t. */
+    #endif
+
+    #if ( ipconfigUSE_TX_PRIORITY_QUEUES != 0 )
+        #define FREERTOS_SO_DSCP    ( 34 ) /* The DSCP of outgoing packets, 0..63, also selects the transmit priority class, parameter is a pointer to a BaseType_t. */
+    #endif
+
+    #if ( ipconfigUSE_SOCKET_BUSY_POLL != 0 )
+        #define FREERTOS_SO_BUSY_POLL    ( 35 ) /* Spin for at most this time before blocking in a receive call, parameter is a pointer to a TickType_t, 0 to disable. */
+    #endif
+
+    #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_SPLICE != 0 ) )
+        #define FREERTOS_SO_TCP_SPLICE    ( 36 ) /* Forward the received data to another connected TCP socket, parameter is a pointer to a Socket_t, NULL to stop. */
+    #endif
+
+    #if ( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_RECORD_FRAMING != 0 ) )
+        #define FREERTOS_SO_TCP_RECORD    ( 40 ) /* Only wake up the reader when a complete length-prefixed record has been received, parameter is a pointer to a TCPRecordFraming_t. */
+    #endif
+
+    #if ( ( ipconfigUSE_UDP_REUSEPORT != 0 ) || ( ipconfigUSE_TCP_REUSEPORT != 0 ) )
+        #define FREERTOS_SO_REUSEPORT    ( 26 ) /* Share the port with other sockets of the same protocol that set this option, must be set before binding, parameter is a pointer to a BaseType_t. */
+    #endif
+
+    #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+        #define FREERTOS_SO_UDP_DIRECT_TX    ( 29 ) /* Let the calling task pass packets to a connected peer to the driver, parameter is a pointer to a BaseType_t. */
+    #endif
+
+    #if ( ipconfigUSE_UDP_GSO != 0 )
+        #define FREERTOS_SO_UDP_SEGMENT    ( 37 ) /* FreeRTOS_sendto() splits longer buffers in datagrams of this size, parameter is a pointer to a BaseType_t, 0 to disable. */
+    #endif
+
+    #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+        #define FREERTOS_SO_TIMESTAMPING     ( 38 ) /* Ask the driver for the time at which each UDP datagram was sent, parameter is a pointer to a BaseType_t. */
+        #define FREERTOS_SO_TIMESTAMP_TX     ( 39 ) /* FreeRTOS_getsockopt() only: get the time at which the last UDP datagram was sent, parameter is a pointer to a NetworkTimestamp_t. */
+    #endif
+
+    #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+        #define FREERTOS_SO_ACCOUNTING    ( 41 ) /* FreeRTOS_getsockopt(): get the traffic and IP-task time of the socket, parameter is a pointer to a SocketAccounting_t. FreeRTOS_setsockopt(): clear them, the parameter is not used. */
+    #endif
+
+    #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+        #define FREERTOS_SO_IP_ADD_MEMBERSHIP     ( 27 ) /* Join a multicast group, parameter is a pointer to a FreeRTOS_MulticastRequest_t. */
+        #define FREERTOS_SO_IP_DROP_MEMBERSHIP    ( 28 ) /* Leave a multicast group, parameter is a pointer to a FreeRTOS_MulticastRequest_t. */
+    #endif
     #define FREERTOS_INADDR_ANY                           ( 0U ) /* The 0.0.0.0 IPv4 address. */
 
     #if ( 0 )                                                    /* Not Used */
@@ -209,6 +300,30 @@
                               BaseType_t xType,
                               BaseType_t xProtocol );
 
+/* The memory of a static socket, the type is completed in FreeRTOS_IP_Private.h. */
+    struct xSTATIC_SOCKET;
+    typedef struct xSTATIC_SOCKET StaticSocket_t;
+
+    #if ( ipconfigSUPPORT_STATIC_SOCKETS != 0 )
+
+/* The number of bytes of stream storage that holds at least 'uxBytes' bytes
+ * of data.  With ipconfigSTREAM_BUFFER_POWER_OF_TWO, the part above the
+ * largest power of 2 is not used. */
+        #define FREERTOS_STREAM_STORAGE_SIZE( uxBytes )    ( ( size_t ) ( uxBytes ) + ( 7U * sizeof( size_t ) ) )
+
+/* Create a socket in memory provided by the application.  A TCP socket may
+ * also get the storage of its reception and transmission streams, aligned
+ * to a size_t.  A NULL storage lets that stream be allocated as usual. */
+        Socket_t FreeRTOS_socket_static( BaseType_t xDomain,
+                                         BaseType_t xType,
+                                         BaseType_t xProtocol,
+                                         StaticSocket_t * pxSocketBuffer,
+                                         uint8_t * pucRxStorage,
+                                         size_t uxRxStorageSize,
+                                         uint8_t * pucTxStorage,
+                                         size_t uxTxStorageSize );
+    #endif /* ipconfigSUPPORT_STATIC_SOCKETS */
+
 /* Binds a socket to a local port number. */
     BaseType_t FreeRTOS_bind( Socket_t xSocket,
                               struct freertos_sockaddr const * pxAddress,
@@ -221,6 +336,13 @@
                                     const void * pvOptionValue,
                                     size_t uxOptionLength );
 
+/* Gets a socket option. */
+    BaseType_t FreeRTOS_getsockopt( ConstSocket_t xSocket,
+                                    int32_t lLevel,
+                                    int32_t lOptionName,
+                                    void * pvOptionValue,
+                                    size_t * puxOptionLength );
+
 /* Close a socket. */
     BaseType_t FreeRTOS_closesocket( Socket_t xSocket );
 
@@ -245,6 +367,40 @@
 /* Get the type of IP: either 'ipTYPE_IPv4' or 'ipTYPE_IPv6'. */
     BaseType_t FreeRTOS_GetIPType( ConstSocket_t xSocket );
 
+    #if ( ipconfigUSE_SOCKET_ACCOUNTING != 0 )
+
+/**
+ * Structure to get with the 'FREERTOS_SO_ACCOUNTING' option.  The times are
+ * measured with ipconfigSOCKET_ACCOUNTING_TIME(), the byte counts include the
+ * IP and the transport headers.
+ */
+        typedef struct xSOCKET_ACCOUNTING
+        {
+            uint64_t ullRxTime;    /**< The time that the IP-task spent handling received packets. */
+            uint64_t ullTxTime;    /**< The time that the IP-task spent preparing packets for transmission. */
+            uint64_t ullTimerTime; /**< TCP only: the time spent in the periodic checks, excluding transmissions. */
+            uint64_t ullRxBytes;   /**< Unit: bytes. The length of the packets that were received. */
+            uint64_t ullTxBytes;   /**< Unit: bytes. The length of the packets that were sent. */
+            uint32_t ulRxPackets;  /**< The number of packets that were received. */
+            uint32_t ulTxPackets;  /**< The number of packets that were sent. */
+        } SocketAccounting_t;
+
+/* One entry in the array filled by FreeRTOS_GetSocketAccounting(). */
+        typedef struct xSOCKET_ACCOUNTING_ENTRY
+        {
+            Socket_t xSocket;               /**< The socket, only to be used as an identifier. */
+            uint8_t ucProtocol;             /**< FREERTOS_IPPROTO_TCP or FREERTOS_IPPROTO_UDP. */
+            uint16_t usLocalPort;           /**< The local port number, host-endian. */
+            uint16_t usRemotePort;          /**< TCP only: the remote port number, host-endian. */
+            SocketAccounting_t xAccounting; /**< The counters of the socket. */
+        } SocketAccountingEntry_t;
+
+/* Copy the counters of at most 'uxMaxEntries' bound sockets to 'pxEntries'.
+ * Returns the number of entries written. */
+        UBaseType_t FreeRTOS_GetSocketAccounting( SocketAccountingEntry_t * pxEntries,
+                                                  UBaseType_t uxMaxEntries );
+    #endif /* ( ipconfigUSE_SOCKET_ACCOUNTING != 0 ) */
+
 /* End Common Socket Attributes */
 
 
@@ -266,6 +422,55 @@
                                struct freertos_sockaddr * pxSourceAddress,
                                socklen_t * pxSourceAddressLength );
 
+    #if ( ( ipconfigSUPPORT_RECVMMSG != 0 ) || ( ipconfigSUPPORT_SENDMMSG != 0 ) )
+
+/* One entry in the array passed to FreeRTOS_recvmmsg() or FreeRTOS_sendmmsg(). */
+        typedef struct xFREERTOS_MMSGHDR
+        {
+            void * pvBuffer;                   /**< The payload buffer. With FREERTOS_ZERO_COPY: recvmmsg() sets it to the payload, sendmmsg() expects a UDP payload buffer. */
+            size_t uxBufferLength;             /**< recvmmsg(): the size of pvBuffer. sendmmsg(): the number of bytes to send. */
+            struct freertos_sockaddr xAddress; /**< recvmmsg(): the source address. sendmmsg(): the destination address. */
+            int32_t lLength;                   /**< Out: the number of bytes received or sent. */
+            #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+                NetworkTimestamp_t xTimestamp; /**< recvmmsg(): the time of reception, zero when not known. */
+            #endif
+        } FreeRTOS_MMsgHdr_t;
+    #endif /* ( ( ipconfigSUPPORT_RECVMMSG != 0 ) || ( ipconfigSUPPORT_SENDMMSG != 0 ) ) */
+
+    #if ( ipconfigSUPPORT_IP_MULTICAST != 0 )
+
+/* The parameter of FREERTOS_SO_IP_ADD_MEMBERSHIP and FREERTOS_SO_IP_DROP_MEMBERSHIP. */
+        typedef struct xFREERTOS_MULTICAST_REQUEST
+        {
+            struct freertos_sockaddr xGroup;        /**< The group: sin_family selects IPv4 or IPv6, sin_address holds the multicast address. */
+            struct xNetworkInterface * pxInterface; /**< The interface on which the group is joined, or NULL for the first interface. */
+        } FreeRTOS_MulticastRequest_t;
+    #endif /* ( ipconfigSUPPORT_IP_MULTICAST != 0 ) */
+
+    #if ( ipconfigSUPPORT_RECVMMSG != 0 )
+/* Receive several datagrams from a UDP socket in one call. */
+        int32_t FreeRTOS_recvmmsg( const ConstSocket_t xSocket,
+                                   FreeRTOS_MMsgHdr_t * pxMessages,
+                                   size_t uxMessageCount,
+                                   BaseType_t xFlags );
+    #endif /* ( ipconfigSUPPORT_RECVMMSG != 0 ) */
+
+    #if ( ipconfigSUPPORT_SENDMMSG != 0 )
+/* Send several datagrams from a UDP socket, handed to the IP-task as one event. */
+        int32_t FreeRTOS_sendmmsg( Socket_t xSocket,
+                                   FreeRTOS_MMsgHdr_t * pxMessages,
+                                   size_t uxMessageCount,
+                                   BaseType_t xFlags );
+    #endif /* ( ipconfigSUPPORT_SENDMMSG != 0 ) */
+
+    #if ( ( ipconfigUSE_TCP == 0 ) && ( ipconfigUSE_UDP_CONNECT != 0 ) )
+/* Connect a UDP socket to a peer. When TCP is enabled, the same function is
+ * declared among the TCP socket attributes. */
+        BaseType_t FreeRTOS_connect( Socket_t xClientSocket,
+                                     const struct freertos_sockaddr * pxAddress,
+                                     socklen_t xAddressLength );
+    #endif
+
 
 /* Function to get the local address and IP port. */
     size_t FreeRTOS_GetLocalAddress( ConstSocket_t xSocket,
@@ -306,7 +511,61 @@
             size_t uxEnoughSpace; /**< Send a GO when buffer space grows above X bytes */
         } LowHighWater_t;
 
-/* Connect a TCP socket to a remote socket. */
+/**
+ * Structure filled in by FreeRTOS_getsockopt() for the 'FREERTOS_SO_TCP_INFO'
+ * option.  The values are copied from the socket in one go.
+ */
+        typedef struct xTCP_INFO
+        {
+            uint8_t ucState;              /**< The TCP state, see eIPTCPState_t. */
+            uint16_t usMSS;               /**< The current Maximum Segment Size. */
+            uint32_t ulSRTT;              /**< Unit: ms. The smoothed round-trip time. */
+            uint32_t ulRTO;               /**< Unit: ms. The retransmission time-out of the oldest outstanding segment. */
+            uint32_t ulRetransmits;       /**< Segments retransmitted after a time-out. */
+            uint32_t ulFastRetransmits;   /**< Segments retransmitted after duplicate ACKs. */
+            uint32_t ulBytesInFlight;     /**< Unit: bytes. Sent but not yet acknowledged. */
+            uint32_t ulRxWindow;          /**< Unit: bytes. The size of the reception window. */
+            uint32_t ulTxWindow;          /**< Unit: bytes. The size of the transmission window. */
+            uint32_t ulPeerWindow;        /**< Unit: bytes. The window last advertised by the peer. */
+            uint32_t ulCongestionWindow;  /**< Unit: bytes. The congestion window, or zero when there is none. */
+            size_t uxRxStreamSize;        /**< Unit: bytes. The size of the RX stream. */
+            size_t uxTxStreamSize;        /**< Unit: bytes. The size of the TX stream. */
+            size_t uxRxCount;             /**< Unit: bytes. Received data waiting to be read. */
+            size_t uxTxCount;             /**< Unit: bytes. Data in the TX stream, including unacknowledged data. */
+        } TCPInfo_t;
+
+        #if ( ipconfigUSE_TCP_ACK_POLICY != 0 )
+
+/**
+ * Structure to pass for the 'FREERTOS_SO_TCP_ACK_POLICY' option.  Child
+ * sockets inherit the policy of the listening socket.
+ */
+            typedef struct xTCP_ACK_POLICY
+            {
+                uint8_t ucMode;        /**< One of the FREERTOS_TCP_ACK_xxx values. */
+                uint8_t ucSegments;    /**< FREERTOS_TCP_ACK_EVERY_N only: the number of segments per ACK, at least 1. */
+                uint16_t usMaxDelayMS; /**< Unit: ms. The longest time that an ACK may be delayed, zero for the default delays. */
+            } TCPAckPolicy_t;
+        #endif /* ( ipconfigUSE_TCP_ACK_POLICY != 0 ) */
+
+        #if ( ipconfigUSE_TCP_RECORD_FRAMING != 0 )
+
+/**
+ * Structure to pass for the 'FREERTOS_SO_TCP_RECORD' option.  A record
+ * starts with a header that contains an unsigned length field.  The length of
+ * the whole record, header included, is the value of that field plus
+ * 'lLengthAdjust'.  Child sockets inherit the framing of the listening socket.
+ */
+            typedef struct xTCP_RECORD_FRAMING
+            {
+                uint8_t ucLengthOffset; /**< The offset of the length field within the header. */
+                uint8_t ucLengthSize;   /**< The size of the length field: 1, 2 or 4 bytes, or 0 to disable the framing. */
+                uint8_t ucBigEndian;    /**< Non-zero when the length field is in network byte order. */
+                int32_t lLengthAdjust;  /**< Added to the length field to get the length of the record. */
+            } TCPRecordFraming_t;
+        #endif /* ( ipconfigUSE_TCP_RECORD_FRAMING != 0 ) */
+
+/* Connect a TCP socket to a remote socket, or set the peer of a UDP socket. */
         BaseType_t FreeRTOS_connect( Socket_t xClientSocket,
                                      const struct freertos_sockaddr * pxAddress,
                                      socklen_t xAddressLength );
@@ -386,10 +645,62 @@
         uint8_t * FreeRTOS_get_tx_head( Socket_t xSocket,
                                         BaseType_t * pxLength );
 
+        struct xSTREAM_BUFFER_REGION;
+
+/* For advanced applications only:
+ * Like FreeRTOS_get_tx_head(), but all free space is returned, as at most two
+ * regions in 'pxRegions[ 2 ]', so that a single scatter-gather operation can
+ * fill it.  Queue the data written by calling FreeRTOS_send() with a NULL
+ * buffer.  Returns the total number of bytes that may be written. */
+        BaseType_t FreeRTOS_get_tx_regions( Socket_t xSocket,
+                                            struct xSTREAM_BUFFER_REGION * pxRegions );
+
+        #if ( ipconfigTCP_TX_REFERENCE_COUNT != 0 )
+
+/* Normally called from the IP-task, when a buffer that was passed to
+ * FreeRTOS_send_reference() is not used any more.  'xDelivered' is pdTRUE when
+ * all of its data have been acknowledged, and pdFALSE when the socket was
+ * closed before that. */
+            typedef void (* FOnTCPReferenceReleased_t )( Socket_t xSocket,
+                                                         const void * pvBuffer,
+                                                         size_t uxLength,
+                                                         BaseType_t xDelivered,
+                                                         void * pvArgument );
+
+/* For advanced applications only:
+ * Queue a buffer for transmission without copying it into the transmit stream.
+ * Either the whole buffer is queued, or nothing.  The buffer must stay valid
+ * until 'pxOnReleased' is called. */
+            BaseType_t FreeRTOS_send_reference( Socket_t xSocket,
+                                                const void * pvBuffer,
+                                                size_t uxDataLength,
+                                                FOnTCPReferenceReleased_t pxOnReleased,
+                                                void * pvArgument );
+        #endif /* ipconfigTCP_TX_REFERENCE_COUNT != 0 */
+
 /* For the web server: borrow the circular Rx buffer for inspection
  * HTML driver wants to see if a sequence of 13/10/13/10 is available. */
         const struct xSTREAM_BUFFER * FreeRTOS_get_rx_buf( ConstSocket_t xSocket );
 
+/* For advanced applications only:
+ * Get all data in the circular Rx buffer as at most two regions in
+ * 'pxRegions[ 2 ]'.  Release the data used by calling FreeRTOS_recv() with a
+ * NULL buffer.  Returns the total number of bytes that may be read. */
+        BaseType_t FreeRTOS_get_rx_regions( ConstSocket_t xSocket,
+                                            struct xSTREAM_BUFFER_REGION * pxRegions );
+
+        #if ( ipconfigUSE_TCP_RECORD_FRAMING != 0 )
+
+/* Wait until a complete record is available, see FREERTOS_SO_TCP_RECORD, and
+ * describe it as at most two regions in 'pxRegions[ 2 ]'.  Release the record
+ * by calling FreeRTOS_recv() with a NULL buffer and the returned length.
+ * FREERTOS_MSG_DONTWAIT can be used.  Returns the length of the record, or a
+ * negative error code. */
+            BaseType_t FreeRTOS_recv_record( Socket_t xSocket,
+                                             struct xSTREAM_BUFFER_REGION * pxRegions,
+                                             BaseType_t xFlags );
+        #endif
+
         void FreeRTOS_netstat( void );
 
 /* End TCP Socket Attributes. */
@@ -424,7 +735,8 @@
                                           BaseType_t ulConnected );
 
 /* Received callback handler for a TCP Socket.
- * Return value is not currently used. */
+ * Return value is not currently used.  When ipconfigUSE_CALLBACK_BUFFER_TRANSFER
+ * is enabled, the handler may call FreeRTOS_TakeRxBuffer() to keep the data. */
         typedef BaseType_t (* FOnTCPReceive_t )( Socket_t xSocket,
                                                  void * pData,
                                                  size_t xLength );
@@ -435,7 +747,9 @@
 
 /* Received callback handler for a UDP Socket.
  * If a positive number is returned, the messages will not be stored in
- * xWaitingPacketsList for later processing by recvfrom(). */
+ * xWaitingPacketsList for later processing by recvfrom().  When
+ * ipconfigUSE_CALLBACK_BUFFER_TRANSFER is enabled, the handler may call
+ * FreeRTOS_TakeRxBuffer() to keep the buffer that holds the message. */
         typedef BaseType_t (* FOnUDPReceive_t ) ( Socket_t xSocket,
                                                   void * pData,
                                                   size_t xLength,
@@ -457,6 +771,15 @@
             FOnUDPSent_t pxOnUDPSent;        /* FREERTOS_SO_UDP_SENT_HANDLER */
         } F_TCP_UDP_Handler_t;
 
+        #if ( ipconfigUSE_CALLBACK_BUFFER_TRANSFER != 0 )
+
+/* Only to be called from within a UDP or TCP reception handler: take the
+ * network buffer that holds the data passed to the handler.  Returns NULL
+ * when the buffer can not be handed over.  The caller must release the
+ * buffer with vReleaseNetworkBufferAndDescriptor(). */
+            struct xNETWORK_BUFFER * FreeRTOS_TakeRxBuffer( Socket_t xSocket );
+        #endif
+
     #endif /* ( ipconfigUSE_CALLBACKS == 1 ) */
 
 /* Conversion Functions */
@@ -560,8 +883,105 @@
         EventBits_t FreeRTOS_FD_ISSET( const ConstSocket_t xSocket,
                                        const ConstSocketSet_t xSocketSet );
 
+        #if ( ipconfigSUPPORT_SELECT_READY_LIST == 1 )
+
+/* Wait until one or more sockets of the set had an event, and return
+ * those sockets together with the events that occurred. */
+            BaseType_t FreeRTOS_select_ready( SocketSet_t xSocketSet,
+                                              Socket_t * pxSockets,
+                                              EventBits_t * pxEvents,
+                                              BaseType_t xMaxSockets,
+                                              TickType_t xBlockTimeTicks );
+        #endif /* ( ipconfigSUPPORT_SELECT_READY_LIST == 1 ) */
+
     #endif /* ( ipconfigSUPPORT_SELECT_FUNCTION == 1 ) */
 
+    #if ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 )
+
+/* The requests that can be posted to an asynchronous ring. */
+        typedef enum eASYNC_OPERATION
+        {
+            eAsyncConnect, /* TCP: connect to xAddress. */
+            eAsyncAccept,  /* TCP: take a client from a listening socket. */
+            eAsyncSend,    /* TCP: queue all uxLength bytes. UDP: send a datagram to xAddress. */
+            eAsyncRecv,    /* TCP: receive up to uxLength bytes. UDP: receive a datagram. */
+            eAsyncClose    /* Close the socket, once its earlier requests have completed. */
+        } eAsyncOperation_t;
+
+/* A request, as passed to FreeRTOS_AsyncSubmit(). */
+        typedef struct xASYNC_REQUEST
+        {
+            eAsyncOperation_t eOperation;      /**< The operation. */
+            Socket_t xSocket;                  /**< The socket. */
+            void * pvBuffer;                   /**< eAsyncSend: the data, eAsyncRecv: the space. Must stay valid until completion. */
+            size_t uxLength;                   /**< The length of pvBuffer. */
+            struct freertos_sockaddr xAddress; /**< eAsyncConnect: the peer. eAsyncSend on UDP: the destination. */
+            void * pvUserData;                 /**< Returned unchanged in the completion. */
+        } FreeRTOS_AsyncRequest_t;
+
+/* The result of a request, as returned by FreeRTOS_AsyncComplete(). */
+        typedef struct xASYNC_COMPLETION
+        {
+            void * pvUserData;                 /**< Copied from the request. */
+            eAsyncOperation_t eOperation;      /**< Copied from the request. */
+            Socket_t xSocket;                  /**< The socket of the request, for eAsyncAccept the new client socket. */
+            int32_t lResult;                   /**< The number of bytes sent or received, 0 for the other operations, or a negative error code. */
+            struct freertos_sockaddr xAddress; /**< eAsyncAccept and eAsyncRecv on UDP: the address of the peer. */
+        } FreeRTOS_AsyncCompletion_t;
+
+        struct xASYNC_RING;
+        typedef struct xASYNC_RING * AsyncRing_t;
+
+/* Create a ring of ipconfigASYNC_RING_LENGTH requests. */
+        AsyncRing_t FreeRTOS_CreateAsyncRing( void );
+
+/* Delete a ring. Requests that have not completed are dropped. */
+        void FreeRTOS_DeleteAsyncRing( AsyncRing_t xRing );
+
+/* Post requests to the IP-task, returns the number of requests accepted. */
+        BaseType_t FreeRTOS_AsyncSubmit( AsyncRing_t xRing,
+                                         const FreeRTOS_AsyncRequest_t * pxRequests,
+                                         BaseType_t xCount );
+
+/* Collect the results of completed requests, waiting at most
+ * 'xBlockTimeTicks' for the first one. Returns the number collected. */
+        BaseType_t FreeRTOS_AsyncComplete( AsyncRing_t xRing,
+                                           FreeRTOS_AsyncCompletion_t * pxCompletions,
+                                           BaseType_t xMaxCount,
+                                           TickType_t xBlockTimeTicks );
+    #endif /* ( ipconfigSUPPORT_ASYNC_SOCKETS != 0 ) */
+
+    #if ( ipconfigUSE_SOCKET_MEMORY_BUDGET != 0 )
+
+/* The pressure on the memory budget of the sockets, see
+ * ipconfigUSE_SOCKET_MEMORY_BUDGET. */
+        typedef enum eSocketMemoryPressure
+        {
+            eSocketMemoryNormal,   /* Below the low watermark. */
+            eSocketMemoryModerate, /* Between the low and the high watermark. */
+            eSocketMemoryHigh      /* Above the high watermark. */
+        } eSocketMemoryPressure_t;
+
+/* The use of the memory budget of the sockets. */
+        typedef struct xSocketMemoryStats
+        {
+            size_t uxBudget;                   /* ipconfigSOCKET_MEMORY_BUDGET. */
+            size_t uxUsed;                     /* The bytes held by sockets now. */
+            size_t uxPeak;                     /* The highest value of uxUsed since start-up. */
+            eSocketMemoryPressure_t ePressure; /* The pressure now. */
+            uint32_t ulRefused;                /* The stream buffers and descriptor chunks that did not fit. */
+            uint32_t ulUDPDropped;             /* The UDP packets dropped because of the pressure. */
+        } SocketMemoryStats_t;
+
+/* Return the pressure on the memory budget of the sockets. */
+        eSocketMemoryPressure_t FreeRTOS_GetSocketMemoryPressure( void );
+
+/* Fill in the use of the memory budget of the sockets. */
+        void FreeRTOS_GetSocketMemoryStats( SocketMemoryStats_t * pxStats );
+
+/* Return the number of bytes held by a socket. */
+        size_t FreeRTOS_GetSocketMemory( ConstSocket_t xSocket );
+    #endif /* ( ipconfigUSE_SOCKET_MEMORY_BUDGET != 0 ) */
 
     #if ipconfigUSE_IPv4
         /* Translate from dot-decimal notation (example 192.168.1.1) to a 32-bit number. */
@@ -53,6 +53,14 @@ typedef struct xSTREAM_BUFFER
     uint8_t ucArray[ sizeof( size_t ) ]; /**< array big enough to store any pointer address */
 } StreamBuffer_t;
 
+/* One contiguous part of a stream buffer, see uxStreamBufferGetReadRegions()
+ * and uxStreamBufferGetWriteRegions(). */
+typedef struct xSTREAM_BUFFER_REGION
+{
+    uint8_t * pucData; /**< first byte of the region, or NULL when it is not used */
+    size_t uxLength;   /**< number of bytes in the region */
+} StreamBufferRegion_t;
+
 size_t uxStreamBufferSpace( const StreamBuffer_t * const pxBuffer,
                             size_t uxLower,
                             size_t uxUpper );
@@ -69,6 +77,8 @@ size_t uxStreamBufferGetSize( const StreamBuffer_t * const pxBuffer );
 
 size_t uxStreamBufferMidSpace( const StreamBuffer_t * const pxBuffer );
 
+size_t uxStreamBufferLength( size_t uxCapacity );
+
 void vStreamBufferClear( StreamBuffer_t * const pxBuffer );
 
 void vStreamBufferMoveMid( StreamBuffer_t * const pxBuffer,
@@ -81,6 +91,12 @@ BaseType_t xStreamBufferLessThenEqual( const StreamBuffer_t * const pxBuffer,
 size_t uxStreamBufferGetPtr( StreamBuffer_t * const pxBuffer,
                              uint8_t ** const ppucData );
 
+size_t uxStreamBufferGetReadRegions( StreamBuffer_t * const pxBuffer,
+                                     StreamBufferRegion_t pxRegions[ 2 ] );
+
+size_t uxStreamBufferGetWriteRegions( StreamBuffer_t * const pxBuffer,
+                                      StreamBufferRegion_t pxRegions[ 2 ] );
+
 size_t uxStreamBufferAdd( StreamBuffer_t * const pxBuffer,
                           size_t uxOffset,
                           const uint8_t * const pucData,
@@ -92,6 +108,24 @@ size_t uxStreamBufferGet( StreamBuffer_t * const pxBuffer,
                           size_t uxMaxCount,
                           BaseType_t xPeek );
 
+size_t uxStreamBufferGetWithChecksum( StreamBuffer_t * const pxBuffer,
+                                      size_t uxOffset,
+                                      uint8_t * const pucData,
+                                      size_t uxMaxCount,
+                                      BaseType_t xPeek,
+                                      uint16_t * pusSum );
+
+#if ( ipconfigTCP_BUFFER_ARENA_SIZE != 0 )
+
+/* The allocator behind pvPortMallocLarge() and vPortFreeLarge(). */
+    void * pvTCPArenaMalloc( size_t uxSize );
+
+    void vTCPArenaFree( void * pvBuffer );
+
+/* The number of bytes in the arena that are not allocated. */
+    size_t uxTCPArenaGetFreeSize( void );
+#endif /* ipconfigTCP_BUFFER_ARENA_SIZE != 0 */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     } /* extern "C" */
@@ -50,6 +50,21 @@ BaseType_t xProcessReceivedTCPPacket_IPV4( NetworkBufferDescriptor_t * pxDescrip
  */
 BaseType_t xProcessReceivedTCPPacket_IPV6( NetworkBufferDescriptor_t * pxDescriptor );
 
+#if ( ipconfigUSE_TCP_RX_COALESCE != 0 )
+
+/*
+ * Offer a received TCP packet to the receive coalescing.  Returns pdPASS when
+ * the packet has been taken, it will be processed by vTCPRxCoalesceFlush().
+ */
+    BaseType_t xTCPRxCoalesce( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Pass the segments held by the receive coalescing, merged where possible, to
+ * xProcessReceivedTCPPacket().  Called at the end of a burst of received frames.
+ */
+    void vTCPRxCoalesceFlush( void );
+#endif
+
 typedef enum eTCP_STATE
 {
     /* Comments about the TCP states are borrowed from the very useful
@@ -103,12 +118,19 @@ typedef enum eTCP_STATE
 #define tcpTCP_OPT_SACK_P            4U                  /**< Advertise that SACK is permitted. */
 #define tcpTCP_OPT_SACK_A            5U                  /**< SACK option with first/last. */
 #define tcpTCP_OPT_TIMESTAMP         8U                  /**< Time-stamp option. */
+#define tcpTCP_OPT_FAST_OPEN         34U                 /**< TCP Fast Open cookie option ( RFC 7413 ). */
 
 
 #define tcpTCP_OPT_MSS_LEN           4U                  /**< Length of TCP MSS option. */
 #define tcpTCP_OPT_WSOPT_LEN         3U                  /**< Length of TCP WSOPT option. */
+#define tcpTCP_OPT_WSOPT_MAX_SHIFT   14U                 /**< The largest window scale factor allowed by RFC 7323. */
 
 #define tcpTCP_OPT_TIMESTAMP_LEN     10                  /**< fixed length of the time-stamp option. */
+#define tcpTCP_OPT_TIMESTAMP_SPACE   12U                 /**< Space taken by a time-stamp option, preceded by two NOOP's. */
+
+#define tcpFAST_OPEN_COOKIE_MIN      4U                  /**< The shortest Fast Open cookie that is valid. */
+#define tcpFAST_OPEN_COOKIE_MAX      12U                 /**< The longest cookie that still fits in a SYN along with the other options. */
+#define tcpFAST_OPEN_COOKIE_LENGTH   8U                  /**< The length of the cookies that this host hands out. */
 
 /** @brief
  * Minimum segment length as outlined by RFC 791 section 3.1.
@@ -142,6 +164,12 @@ typedef enum eTCP_STATE
 #define tcpDELAYED_ACK_SHORT_DELAY_MS       ( 2 )           /**< Should not become smaller than 1. */
 #define tcpDELAYED_ACK_LONGER_DELAY_MS      ( 20 )          /**< Longer delay for ACK. */
 
+/*
+ * With FREERTOS_TCP_ACK_ADAPTIVE, a segment that arrives after a pause of at least
+ * this time is considered interactive, and it is acknowledged immediately.
+ */
+#define tcpADAPTIVE_ACK_IDLE_MS             ( 2 * tcpDELAYED_ACK_LONGER_DELAY_MS )
+
 
 /** @brief
  * The MSS (Maximum Segment Size) will be taken as large as possible. However, packets with
@@ -150,6 +178,19 @@ typedef enum eTCP_STATE
  */
 #define tcpREDUCED_MSS_THROUGH_INTERNET    ( 1400 )
 
+/** @brief
+ * Path MTU discovery: the lowest MSS for IPv6, based on the minimum IPv6 MTU
+ * ( 1280 ) - IPv6 header ( 40 ) - TCP header ( 20 ). For IPv4 it is
+ * tcpMINIMUM_SEGMENT_LENGTH.
+ */
+#define tcpMINIMUM_SEGMENT_LENGTH_IPv6     ( 1220U )
+
+/** @brief
+ * Path MTU discovery: the number of consecutive time-outs of a full-size
+ * segment after which the path is considered a black hole for that size.
+ */
+#define tcpPATH_MTU_BLACK_HOLE_TIMEOUTS    ( 3U )
+
 /** @brief
  * When there are no TCP options, the TCP offset equals 20 bytes, which is stored as
  * the number 5 (words) in the higher nibble of the TCP-offset byte.
@@ -175,6 +216,14 @@ typedef enum eTCP_STATE
     #define tcpMAXIMUM_TCP_WAKEUP_TIME_MS    20000U
 #endif
 
+/** @brief
+ * The maximum number of received segments that the receive coalescing will
+ * merge into one, see ipconfigUSE_TCP_RX_COALESCE.
+ */
+#ifndef tcpRX_COALESCE_MAX_SEGMENTS
+    #define tcpRX_COALESCE_MAX_SEGMENTS    ( 16U )
+#endif
+
 struct xSOCKET;
 
 /*
@@ -189,6 +238,15 @@ void prvTCPTouchSocket( struct xSOCKET * pxSocket );
  */
 TickType_t prvTCPNextTimeout( struct xSOCKET * pxSocket );
 
+#if ( ipconfigTCP_TIME_WAIT_COUNT != 0 )
+
+/*
+ * Remember a connection whose FIN exchange has completed, so that a repeated
+ * FIN from the peer can still be acknowledged after the socket is closed.
+ */
+    void vTCPTimeWaitAdd( const struct xSOCKET * pxSocket );
+#endif
+
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
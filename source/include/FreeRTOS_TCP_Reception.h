@@ -41,6 +41,17 @@
 BaseType_t prvCheckOptions( FreeRTOS_Socket_t * pxSocket,
                             const NetworkBufferDescriptor_t * pxNetworkBuffer );
 
+#if ( ipconfigUSE_TCP_HEADER_PREDICTION != 0 )
+
+/*
+ * Called from xProcessReceivedTCPPacket.  Returns pdTRUE when the segment is
+ * the next one expected on an established connection, and has no options
+ * other than time-stamps, which will have been handled.
+ */
+    BaseType_t prvTCPHeaderPrediction( FreeRTOS_Socket_t * pxSocket,
+                                       const NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif
+
 /*
  * Called from prvTCPHandleState().  Find the TCP payload data and check and
  * return its length.
@@ -50,11 +61,13 @@ BaseType_t prvCheckRxData( const NetworkBufferDescriptor_t * pxNetworkBuffer,
 
 /*
  * Called from prvTCPHandleState().  Check if the payload data may be accepted.
- * If so, it will be added to the socket's reception queue.
+ * If so, it will be added to the socket's reception queue.  A socket in
+ * buffer-chain mode may keep the network buffer, and replace '*ppxNetworkBuffer'
+ * with a copy of its headers.
  */
 BaseType_t prvStoreRxData( FreeRTOS_Socket_t * pxSocket,
                            const uint8_t * pucRecvData,
-                           NetworkBufferDescriptor_t * pxNetworkBuffer,
+                           NetworkBufferDescriptor_t ** ppxNetworkBuffer,
                            uint32_t ulReceiveLength );
 
 /* *INDENT-OFF* */
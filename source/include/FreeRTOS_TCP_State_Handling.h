@@ -58,6 +58,16 @@ BaseType_t prvTCPSocketIsActive( eIPTCPState_t eStatus );
 BaseType_t prvTCPHandleState( FreeRTOS_Socket_t * pxSocket,
                               NetworkBufferDescriptor_t ** ppxNetworkBuffer );
 
+#if ( ipconfigUSE_TCP_HEADER_PREDICTION != 0 )
+
+/*
+ * The fast path of prvTCPHandleState(), for a segment that was predicted by
+ * prvTCPHeaderPrediction().
+ */
+    BaseType_t prvTCPHandlePredicted( FreeRTOS_Socket_t * pxSocket,
+                                      NetworkBufferDescriptor_t ** ppxNetworkBuffer );
+#endif
+
 /*
  * Return either a newly created socket, or the current socket in a connected
  * state (depends on the 'bReuseSocket' flag).
@@ -79,6 +89,16 @@ FreeRTOS_Socket_t * prvHandleListen_IPV4( FreeRTOS_Socket_t * pxSocket,
 FreeRTOS_Socket_t * prvHandleListen_IPV6( FreeRTOS_Socket_t * pxSocket,
                                           NetworkBufferDescriptor_t * pxNetworkBuffer );
 
+#if ( ipconfigUSE_TCP_SYN_COOKIES != 0 )
+
+/*
+ * Create the child socket of a listening socket when an ACK returns a valid
+ * SYN cookie.
+ */
+    FreeRTOS_Socket_t * prvHandleSynCookie( FreeRTOS_Socket_t * pxSocket,
+                                            NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif
+
 /*
  * Common code for sending a TCP protocol control packet (i.e. no options, no
  * payload, just flags).
@@ -45,6 +45,15 @@ int32_t prvTCPSendPacket( FreeRTOS_Socket_t * pxSocket );
 int32_t prvTCPSendRepeated( FreeRTOS_Socket_t * pxSocket,
                             NetworkBufferDescriptor_t ** ppxNetworkBuffer );
 
+#if ( ipconfigUSE_TCP_PACING != 0 )
+
+/*
+ * Return the number of milliseconds before a paced socket may send its next
+ * segment, or zero when it may send now.
+ */
+    uint32_t ulTCPPacingDelay( const FreeRTOS_Socket_t * pxSocket );
+#endif
+
 /*
  * Return or send a packet to the other party.
  */
@@ -90,6 +99,39 @@ void prvTCPReturn_SetEndPoint( const FreeRTOS_Socket_t * pxSocket,
                                NetworkBufferDescriptor_t * pxNetworkBuffer,
                                size_t uxIPHeaderSize );
 
+#if ( ipconfigTCP_TX_COPY_CHECKSUM != 0 )
+
+/*
+ * Set the TCP checksum using the payload sum that prvTCPPrepareSend() stored
+ * in the socket.  Returns pdFALSE when the full checksum must be calculated.
+ */
+    BaseType_t prvTCPReturn_SetPayloadChecksum( FreeRTOS_Socket_t * pxSocket,
+                                                NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                size_t uxIPHeaderSize,
+                                                size_t uxBufferLength,
+                                                uint32_t ulLen );
+#endif
+
+#if ( ipconfigUSE_TCP_ACK_TEMPLATE != 0 )
+
+/*
+ * Called by prvTCPReturnPacket_IPVx() just before a packet of an established
+ * connection is passed to the driver: keep a copy of its headers.
+ */
+    void prvTCPAckTemplateStore( FreeRTOS_Socket_t * pxSocket,
+                                 const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                 size_t uxIPHeaderSize );
+
+/*
+ * Called by prvTCPReturnPacket(): send a pure ACK using the headers kept by
+ * the socket.  Returns pdFALSE when the normal path must be taken.
+ */
+    BaseType_t prvTCPAckTemplateSend( FreeRTOS_Socket_t * pxSocket,
+                                      NetworkBufferDescriptor_t * pxDescriptor,
+                                      uint32_t ulLen,
+                                      BaseType_t xReleaseAfterSend );
+#endif
+
 /*
  * Let ARP look-up the MAC-address of the peer and initialise the first SYN
  * packet.
@@ -115,6 +157,17 @@ BaseType_t prvTCPCreateWindow( FreeRTOS_Socket_t * pxSocket );
 UBaseType_t prvSetSynAckOptions( FreeRTOS_Socket_t * pxSocket,
                                  TCPHeader_t * pxTCPHeader );
 
+#if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+
+/*
+ * Write a time-stamps option behind the first 'uxOptionsLength' bytes of
+ * options, and return the new length of the options.
+ */
+    UBaseType_t prvSetTimeStampOption( const FreeRTOS_Socket_t * pxSocket,
+                                       TCPHeader_t * pxTCPHeader,
+                                       UBaseType_t uxOptionsLength );
+#endif
+
 /*
  * Prepare an outgoing message, if anything has to be sent.
  */
@@ -122,6 +175,16 @@ int32_t prvTCPPrepareSend( FreeRTOS_Socket_t * pxSocket,
                            NetworkBufferDescriptor_t ** ppxNetworkBuffer,
                            UBaseType_t uxOptionsLength );
 
+#if ( ipconfigUSE_TCP_TSO != 0 )
+
+/*
+ * Let the TCP window add more segments to the data that will be sent, in case
+ * the network interface can split large packets.
+ */
+    uint32_t prvTCPCoalesceSegments( FreeRTOS_Socket_t * pxSocket,
+                                     uint32_t ulLength );
+#endif
+
 /*
  * The API FreeRTOS_send() adds data to the TX stream.  Add
  * this data to the windowing system to it can be transmitted.
@@ -144,6 +207,17 @@ BaseType_t prvSendData( FreeRTOS_Socket_t * pxSocket,
                         uint32_t ulReceiveLength,
                         BaseType_t xByteCount );
 
+#if ( ipconfigUSE_TCP_ACK_POLICY != 0 )
+
+/*
+ * Called from prvSendData(): apply the socket's ACK policy to decide whether
+ * an ACK that may be delayed must be sent now.
+ */
+    BaseType_t prvTCPAckPolicyMayDelay( FreeRTOS_Socket_t * pxSocket,
+                                        uint32_t ulReceiveLength,
+                                        BaseType_t xMayDelay );
+#endif
+
 /*
  * A "challenge ACK" is as per https://tools.ietf.org/html/rfc5961#section-3.2,
  * case #3. In summary, an RST was received with a sequence number that is
@@ -156,6 +230,15 @@ BaseType_t prvTCPSendChallengeAck( NetworkBufferDescriptor_t * pxNetworkBuffer )
  */
 BaseType_t prvTCPSendReset( NetworkBufferDescriptor_t * pxNetworkBuffer );
 
+#if ( ipconfigUSE_TCP_SYN_COOKIES != 0 )
+
+/*
+ * Answer a SYN with a SYN+ACK that carries a SYN cookie, without creating a
+ * socket.
+ */
+    BaseType_t prvTCPSendSynCookie( NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif
+
 /*
  *  Check if the size of a network buffer is big enough to hold the outgoing message.
  *  Allocate a new bigger network buffer when necessary.
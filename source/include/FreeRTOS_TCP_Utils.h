@@ -57,6 +57,56 @@ void prvSocketSetMSS_IPV4( FreeRTOS_Socket_t * pxSocket );
  */
 void prvSocketSetMSS_IPV6( FreeRTOS_Socket_t * pxSocket );
 
+#if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+
+/*
+ * Look up the Fast Open cookie of the peer of a connecting socket.
+ */
+    size_t prvTCPFastOpenCookieGet( const FreeRTOS_Socket_t * pxSocket,
+                                    uint8_t * pucCookie );
+
+/*
+ * Remember the Fast Open cookie that the peer of a connecting socket sent.
+ */
+    void prvTCPFastOpenCookieStore( const FreeRTOS_Socket_t * pxSocket,
+                                    const uint8_t * pucCookie,
+                                    size_t uxLength );
+
+/*
+ * Make the Fast Open cookie that this host hands out to the peer of a socket.
+ */
+    BaseType_t prvTCPFastOpenCookieMake( const FreeRTOS_Socket_t * pxSocket,
+                                         uint8_t * pucCookie );
+#endif /* ipconfigUSE_TCP_FAST_OPEN != 0 */
+
+#if ( ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 )
+
+/*
+ * Get the MSS that fits in the path to the peer of a socket, or zero.
+ */
+    uint16_t prvTCPPathMSSGet( const FreeRTOS_Socket_t * pxSocket );
+
+/*
+ * Lower the MSS of a connection whose full-size segments keep timing out.
+ */
+    void prvTCPPathMTUCheckTimeouts( FreeRTOS_Socket_t * pxSocket,
+                                     uint32_t ulLength );
+#endif /* ipconfigUSE_TCP_PATH_MTU_DISCOVERY != 0 */
+
+#if ( ipconfigUSE_TCP_SYN_COOKIES != 0 )
+
+/*
+ * Make the SYN cookie for a SYN that arrived while the backlog was full.
+ */
+    BaseType_t prvTCPSynCookieMake( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                    uint32_t * pulCookie );
+
+/*
+ * Check the SYN cookie in an ACK to a listening socket, returns the peer's MSS.
+ */
+    uint16_t prvTCPSynCookieCheck( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif /* ipconfigUSE_TCP_SYN_COOKIES != 0 */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     } /* extern "C" */
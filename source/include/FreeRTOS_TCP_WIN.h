@@ -43,8 +43,36 @@
 typedef struct xTCPTimerStruct
 {
     TickType_t uxBorn; /**< The time at which a packet was sent ( using xTaskGetTickCount() ). */
+    #if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 )
+        uint32_t ulBornUS; /**< The same time, read from ipconfigTCP_HIGH_RES_TIME_US(). */
+    #endif
 } TCPTimer_t;
 
+#if ( ipconfigUSE_TCP_WIN != 0 ) && ( ipconfigTCP_WIN_COMPACT_SEGMENTS != 0 )
+
+    struct xTCP_SEGMENT_LIST;
+
+/** @brief Links a segment descriptor in a list by the index of its neighbours in the
+ *         pool of segment descriptors, see ipconfigTCP_WIN_COMPACT_SEGMENTS. */
+    typedef struct xTCP_SEGMENT_ITEM
+    {
+        uint16_t usNext;                        /**< The index of the next segment, 0xFFFF for the end of the list */
+        uint16_t usPrevious;                    /**< The index of the previous segment, 0xFFFF for the end of the list */
+        struct xTCP_SEGMENT_LIST * pxContainer; /**< The list that contains this item, or NULL */
+    } TCPSegmentItem_t;
+
+/** @brief A list of segment descriptors, linked by their index. */
+    typedef struct xTCP_SEGMENT_LIST
+    {
+        TCPSegmentItem_t xListEnd;   /**< The end marker: usNext is the head and usPrevious is the tail of the list */
+        UBaseType_t uxNumberOfItems; /**< The number of segments in the list */
+        size_t uxItemOffset;         /**< The offset of the item in TCPSegment_t which links this list */
+    } TCPSegmentList_t;
+#elif ( ipconfigUSE_TCP_WIN != 0 )
+    typedef ListItem_t TCPSegmentItem_t;
+    typedef List_t TCPSegmentList_t;
+#endif
+
 /** @brief This struct collects the properties of a TCP segment.  A segment is a chunk of data which
  *         is sent in a single TCP packet, at most 1460 bytes. */
 typedef struct xTCP_SEGMENT
@@ -68,8 +96,11 @@ typedef struct xTCP_SEGMENT
         uint32_t ulFlags;
     } u;                                /**< A collection of boolean flags. */
     #if ( ipconfigUSE_TCP_WIN != 0 )
-        struct xLIST_ITEM xQueueItem;   /**< TX only: segments can be linked in one of three queues: xPriorityQueue, xTxQueue, and xWaitQueue */
-        struct xLIST_ITEM xSegmentItem; /**< With this item the segment can be connected to a list, depending on who is owning it */
+        TCPSegmentItem_t xQueueItem;   /**< TX only: segments can be linked in one of three queues: xPriorityQueue, xTxQueue, and xWaitQueue */
+        TCPSegmentItem_t xSegmentItem; /**< With this item the segment can be connected to a list, depending on who is owning it */
+    #endif
+    #if ( ipconfigTCP_WIN_SEG_CHUNK_COUNT != 0 )
+        struct xTCP_SEGMENT_CHUNK * pxChunk; /**< The chunk of the segment pool that contains this descriptor */
     #endif
 } TCPSegment_t;
 
@@ -83,12 +114,111 @@ typedef struct xTCP_WINSIZE
 /** @brief If TCP time-stamps are being used, they will occupy 12 bytes in
  * each packet, and thus the message space will become smaller.
  * Keep this as a multiple of 4 */
-#if ( ipconfigUSE_TCP_WIN == 1 )
+#if ( ipconfigUSE_TCP_FAST_OPEN != 0 )
+    /* A SYN may carry a Fast Open option of up to 16 bytes along with the
+     * 24 bytes below: the maximum of 40 bytes. */
+    #define ipSIZE_TCP_OPTIONS    40U
+#elif ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+    /* 12 bytes of SACK option and 12 bytes of time-stamps. A SYN uses 4 bytes
+     * of MSS, window scale and SACK-permitted each. */
+    #define ipSIZE_TCP_OPTIONS    24U
+#elif ( ipconfigUSE_TCP_WIN == 1 )
     #define ipSIZE_TCP_OPTIONS    16U
 #else
     #define ipSIZE_TCP_OPTIONS    12U
 #endif
 
+#if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+    struct xTCP_WINDOW;
+
+/** @brief The interface of a congestion control algorithm. The algorithm manages
+ *  the congestion window in TCPCongestion_t. The functions are called from the
+ *  IP-task. */
+    typedef struct xTCP_CONGESTION_CONTROL
+    {
+        const char * pcName;                              /**< The name of the algorithm, for logging. */
+        void ( * fnInit )( struct xTCP_WINDOW * pxWindow ); /**< A connection starts: set the initial window. */
+        void ( * fnOnAck )( struct xTCP_WINDOW * pxWindow,
+                            uint32_t ulAckedBytes );      /**< New data has been acknowledged, not called during fast recovery. */
+        void ( * fnOnLoss )( struct xTCP_WINDOW * pxWindow,
+                             BaseType_t xTimeout );       /**< A loss was detected, either by a fast retransmit or by a time-out. */
+    } TCPCongestionControl_t;
+
+/** @brief The congestion state of a TCP connection. */
+    typedef struct xTCP_CONGESTION
+    {
+        const TCPCongestionControl_t * pxControl; /**< The algorithm in use. */
+        uint32_t ulWindow;                        /**< The congestion window (cwnd) in bytes. */
+        uint32_t ulSlowStartThreshold;            /**< The slow start threshold (ssthresh) in bytes. */
+        uint32_t ulBytesAcked;                    /**< Bytes acknowledged while in congestion avoidance. */
+        uint32_t ulRecoverSequenceNumber;         /**< Fast recovery ends when this sequence number is acknowledged. */
+        BaseType_t xInRecovery;                   /**< pdTRUE during fast recovery. */
+        uint32_t ulWindowMax;                     /**< CUBIC: the window before the last reduction (W_max). */
+        uint32_t ulOriginWindow;                  /**< CUBIC: the window at the origin of the cubic function. */
+        uint32_t ulRenoWindow;                    /**< CUBIC: the estimated window of Reno (W_est). */
+        uint32_t ulK;                             /**< CUBIC: time in ms to reach ulOriginWindow (K). */
+        TCPTimer_t xEpochTimer;                   /**< CUBIC: the start of the current congestion avoidance epoch. */
+        BaseType_t xEpochValid;                   /**< CUBIC: pdTRUE when xEpochTimer has been set. */
+    } TCPCongestion_t;
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL != 0 */
+
+#if ( ipconfigUSE_TCP_RACK_TLP != 0 )
+
+/** @brief The loss detection state of a connection ( RACK-TLP, RFC 8985 ). */
+    typedef struct xTCP_RACK
+    {
+        TCPTimer_t xTransmitTime; /**< RACK.xmit_ts: the transmit time of the most recently sent segment that has been delivered. */
+        uint32_t ulEndSequence;   /**< RACK.end_seq: the sequence number following that segment. */
+        uint32_t ulRTT;           /**< RACK.rtt: the round-trip time in ms, measured with that segment. */
+        BaseType_t xValid;        /**< pdTRUE once a segment has been delivered. */
+        TCPTimer_t xProbeTimer;   /**< TLP: the time at which the probe was sent. */
+        uint32_t ulProbeSequence; /**< TLP.end_seq: the highest sequence number sent when the probe was sent. */
+        BaseType_t xProbing;      /**< pdTRUE while a probe is outstanding. */
+    } TCPRack_t;
+#endif /* ipconfigUSE_TCP_RACK_TLP != 0 */
+
+#if ( ipconfigTCP_RX_INTERVAL_COUNT != 0 )
+
+/** @brief A range of sequence numbers that has been received out-of-order. */
+    typedef struct xTCP_INTERVAL
+    {
+        uint32_t ulFirst; /**< The first sequence number of the range. */
+        uint32_t ulLast;  /**< The sequence number following the range. */
+    } TCPInterval_t;
+#endif /* ipconfigTCP_RX_INTERVAL_COUNT != 0 */
+
+#if ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 )
+
+/** @brief The events of the binary window log.  The values are part of the
+ *  format read by tcp_win_event_log_decode.py: only add new ones at the end.
+ *  Sequence numbers are relative to the initial sequence number of the
+ *  outgoing stream. */
+    typedef enum
+    {
+        eTCPWinEventNone = 0,   /**< An unused entry. */
+        eTCPWinEventSend,       /**< A segment is sent for the first time.  Sequence: its first byte, value: its length. */
+        eTCPWinEventRetransmit, /**< A segment is sent again.  Sequence: its first byte, value: its length, count: the transmission. */
+        eTCPWinEventAck,        /**< An ACK was received.  Sequence: the ACK number, value: the number of bytes newly acknowledged. */
+        eTCPWinEventSack,       /**< A SACK block was received.  Sequence: its first byte, value: the sequence number following it. */
+        eTCPWinEventTimeout,    /**< The retransmission timer of a segment expired.  Sequence: its first byte, value: the time-out in ms. */
+        eTCPWinEventProbe,      /**< A tail loss probe was sent.  Sequence: its first byte, value: its length. */
+        eTCPWinEventRTT,        /**< A round-trip time was measured.  Sequence: the segment, value: the RTT in ms. */
+        eTCPWinEventWindow      /**< The peer advertised a different window.  Sequence: the ACK number, value: the window in bytes. */
+    } eTCPWinEvent_t;
+
+/** @brief One event of the window log, 16 bytes. */
+    typedef struct xTCP_WIN_EVENT
+    {
+        uint32_t ulTime;           /**< ipconfigTCP_WIN_EVENT_LOG_TIME_US() */
+        uint32_t ulSequenceNumber; /**< Depends on the event, see eTCPWinEvent_t. */
+        uint32_t ulValue;          /**< Depends on the event, see eTCPWinEvent_t. */
+        uint8_t ucEvent;           /**< eTCPWinEvent_t */
+        uint8_t ucCount;           /**< Depends on the event, see eTCPWinEvent_t. */
+        uint16_t usOurPortNumber;  /**< The local port of the connection, to tell apart the logs of several sockets. */
+    } TCPWinEvent_t;
+#endif /* ipconfigUSE_TCP_WIN_EVENT_LOG != 0 */
+
 /** @brief Every TCP connection owns a TCP window for the administration of all packets
  *  It owns two sets of segment descriptors, incoming and outgoing
  */
@@ -99,10 +229,11 @@ typedef struct xTCP_WINDOW
         struct
         {
             uint32_t
-                bHasInit : 1,      /**< The window structure has been initialised */
-                bSendFullSize : 1, /**< May only send packets with a size equal to MSS (for optimisation) */
-                bTimeStamps : 1;   /**< Socket is supposed to use TCP time-stamps. This depends on the */
-        } bits;                    /**< party which opens the connection */
+                bHasInit : 1,       /**< The window structure has been initialised */
+                bSendFullSize : 1,  /**< May only send packets with a size equal to MSS (for optimisation) */
+                bTimeStampEcho : 1, /**< ulTimeStampEcho holds the TSecr of the ACK being processed */
+                bTimeStamps : 1;    /**< Socket is supposed to use TCP time-stamps. This depends on the */
+        } bits;                     /**< party which opens the connection */
         uint32_t ulFlags;
     } u;                           /**< A collection of boolean flags. */
     TCPWinSize_t xSize;            /**< The TCP window sizes of the incoming and outgoing streams. */
@@ -121,15 +252,48 @@ typedef struct xTCP_WINDOW
     uint32_t ulUserDataLength;                                             /**< Number of bytes in Rx buffer which may be passed to the user, after having received a 'missing packet' */
     uint32_t ulNextTxSequenceNumber;                                       /**< The sequence number given to the next byte to be added for transmission */
     int32_t lSRTT;                                                         /**< Smoothed Round Trip Time, it may increment quickly and it decrements slower */
+    #if ( ipconfigUSE_TCP_HIGH_RES_TIMER != 0 )
+        int32_t lSRTTus;                                                   /**< The same as lSRTT in microseconds, lSRTT is rounded up from it. */
+    #endif
     uint8_t ucOptionLength;                                                /**< Number of valid bytes in ulOptionsData[] */
     #if ( ipconfigUSE_TCP_WIN == 1 )
-        List_t xPriorityQueue;                                             /**< Priority queue: segments which must be sent immediately */
-        List_t xTxQueue;                                                   /**< Transmit queue: segments queued for transmission */
-        List_t xWaitQueue;                                                 /**< Waiting queue:  outstanding segments */
+        TCPSegmentList_t xPriorityQueue;                                   /**< Priority queue: segments which must be sent immediately */
+        TCPSegmentList_t xTxQueue;                                         /**< Transmit queue: segments queued for transmission */
+        TCPSegmentList_t xWaitQueue;                                       /**< Waiting queue:  outstanding segments */
         TCPSegment_t * pxHeadSegment;                                      /**< points to a segment which has not been transmitted and it's size is still growing (user data being added) */
         uint32_t ulOptionsData[ ipSIZE_TCP_OPTIONS / sizeof( uint32_t ) ]; /**< Contains the options we send out */
-        List_t xTxSegments;                                                /**< A linked list of all transmission segments, sorted on sequence number */
-        List_t xRxSegments;                                                /**< A linked list of reception segments, order depends on sequence of arrival */
+        TCPSegmentList_t xTxSegments;                                      /**< A linked list of all transmission segments, sorted on sequence number */
+        TCPSegmentList_t xRxSegments;                                      /**< A linked list of reception segments, order depends on sequence of arrival */
+        #if ( ipconfigTCP_RX_INTERVAL_COUNT != 0 )
+            TCPInterval_t xRxIntervals[ ipconfigTCP_RX_INTERVAL_COUNT ];   /**< The data received out-of-order, sorted on sequence number, used instead of xRxSegments */
+            UBaseType_t uxRxIntervalCount;                                 /**< Number of valid entries in xRxIntervals[] */
+        #endif
+        #if ( ipconfigTCP_TX_SEGMENT_INDEX_COUNT != 0 )
+            TCPSegment_t * pxTxIndex[ ipconfigTCP_TX_SEGMENT_INDEX_COUNT ]; /**< A ring with the oldest segments of xTxSegments, sorted on sequence number */
+            UBaseType_t uxTxIndexHead;                                     /**< The position of the oldest segment in pxTxIndex[] */
+            UBaseType_t uxTxIndexCount;                                    /**< Number of valid entries in pxTxIndex[] */
+            BaseType_t xTxIndexOverflow;                                   /**< pdTRUE when xTxSegments holds segments that are not in pxTxIndex[] */
+        #endif
+        #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+            TCPCongestion_t xCongestion;                                   /**< The congestion window and the algorithm managing it */
+        #endif
+        #if ( ipconfigUSE_TCP_RACK_TLP != 0 )
+            TCPRack_t xRack;                                               /**< Time-based loss detection and tail loss probes */
+        #endif
+        #if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+            uint32_t ulTimeStampEcho;                                      /**< When u.bits.bTimeStampEcho is set: the TSecr of the ACK being processed, used to measure the RTT */
+        #endif
+        uint32_t ulRetransmitCount;                                        /**< Statistics: segments retransmitted after a time-out */
+        uint32_t ulFastRetransmitCount;                                    /**< Statistics: segments retransmitted after duplicate ACKs */
+        #if ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 )
+            TCPWinEvent_t xEventLog[ ipconfigTCP_WIN_EVENT_LOG_ENTRIES ];  /**< The most recent events of this connection, a ring */
+            uint32_t ulEventLogCount;                                      /**< The number of events logged since the window was created */
+        #endif
+    #elif ( ipconfigTCP_TINY_TX_SEGMENT_COUNT > 1 )
+        /* Tiny TCP with a small fixed number of outstanding TX segments */
+        TCPSegment_t xTxSegments[ ipconfigTCP_TINY_TX_SEGMENT_COUNT ]; /**< The TX segments in order of sequence number, used as a circular buffer */
+        UBaseType_t uxTxSegmentFirst;                                  /**< The index of the oldest segment in xTxSegments[] */
+        UBaseType_t uxTxSegmentCount;                                  /**< The number of segments in xTxSegments[] that hold data */
     #else
         /* For tiny TCP, there is only 1 outstanding TX segment */
         TCPSegment_t xTxSegment; /**< Priority queue */
@@ -168,6 +332,12 @@ void vTCPWindowInit( TCPWindow_t * pxWindow,
 /* Clean up allocated segments. Should only be called when FreeRTOS+TCP will no longer be used. */
 void vTCPSegmentCleanup( void );
 
+#if ( ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_RESOURCE_STATS != 0 ) )
+    /* Get the use of the segment descriptors, see ipconfigUSE_RESOURCE_STATS. */
+    void vTCPWindowGetSegmentUsage( IPResourceUsage_t * pxUsage,
+                                    BaseType_t xResetPeak );
+#endif
+
 /*=============================================================================
  *
  * Rx functions
@@ -214,6 +384,20 @@ uint32_t ulTCPWindowTxGet( TCPWindow_t * pxWindow,
                            uint32_t ulWindowSize,
                            int32_t * plPosition );
 
+#if ( ipconfigUSE_TCP_TSO != 0 )
+
+/* Fetches the next segment, if it directly follows on 'ulSequenceNumber',
+ * so it can be sent in the same packet. */
+    uint32_t ulTCPWindowTxGetMore( TCPWindow_t * pxWindow,
+                                   uint32_t ulWindowSize,
+                                   uint32_t ulSequenceNumber,
+                                   uint32_t ulMaxLength );
+#endif
+
+/* Returns the time-out in ms after which the oldest outstanding segment
+ * will be retransmitted. */
+uint32_t ulTCPWindowTxTimeout( const TCPWindow_t * pxWindow );
+
 /* Receive a normal ACK */
 uint32_t ulTCPWindowTxAck( TCPWindow_t * pxWindow,
                            uint32_t ulSequenceNumber );
@@ -223,6 +407,37 @@ uint32_t ulTCPWindowTxSack( TCPWindow_t * pxWindow,
                             uint32_t ulFirst,
                             uint32_t ulLast );
 
+#if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+/* The congestion control algorithms that can be selected with the socket
+ * option FREERTOS_SO_TCP_CONGESTION. */
+    extern const TCPCongestionControl_t xTCPCongestionNewReno;
+    extern const TCPCongestionControl_t xTCPCongestionCubic;
+#endif
+
+#if ( ipconfigUSE_TCP_TIMESTAMP_OPTION != 0 )
+/* Returns the clock used for the TCP time-stamps option, in milliseconds. */
+    uint32_t ulTCPWindowTimeStamp( void );
+#endif
+
+#if ( ipconfigUSE_TCP_WIN_EVENT_LOG != 0 )
+/* Add an event to the binary log of the window, only called from the IP-task. */
+    void vTCPWindowLogEvent( TCPWindow_t * pxWindow,
+                             eTCPWinEvent_t eEvent,
+                             uint32_t ulSequenceNumber,
+                             uint32_t ulValue,
+                             uint8_t ucCount );
+
+/* Copy the most recent events, oldest first, returns the number copied. */
+    size_t uxTCPWindowGetEventLog( const TCPWindow_t * pxWindow,
+                                   TCPWinEvent_t * pxEvents,
+                                   size_t uxMaxEvents );
+
+    #define tcpwinLOG_EVENT( pxWindow, eEvent, ulSequenceNumber, ulValue, ucCount ) \
+    vTCPWindowLogEvent( ( pxWindow ), ( eEvent ), ( ulSequenceNumber ), ( ulValue ), ( ucCount ) )
+#else
+    #define tcpwinLOG_EVENT( pxWindow, eEvent, ulSequenceNumber, ulValue, ucCount )    do {} while( ipFALSE_BOOL )
+#endif
+
 /**
  * @brief Check if a > b, where a and b are rolling counters.
  *
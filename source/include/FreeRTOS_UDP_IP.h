@@ -49,6 +49,32 @@ void vProcessGeneratedUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuff
 void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer );
 void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+#if ( ipconfigUSE_UDP_CONNECT != 0 )
+
+/* The number of UDP sockets that have called FreeRTOS_connect(). */
+    extern volatile UBaseType_t uxUDPConnectedSockets;
+
+/* Called by the IP-task just before a UDP packet is passed to the driver:
+ * a connected socket keeps a copy of its headers. */
+    void vUDPConnectStoreHeader( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* Called by FreeRTOS_sendto(): fill in all headers from the copy kept in the
+ * socket. Returns pdTRUE when the packet is ready to be passed to the driver. */
+    BaseType_t xUDPConnectFillHeader( const struct xSOCKET * pxSocket,
+                                      NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* Called by the IP-task for an eStackTxReadyEvent. */
+    void vUDPConnectOutput( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+    #if ( ipconfigUSE_UDP_DIRECT_TX != 0 )
+
+/* Called by FreeRTOS_sendto() to pass a packet with complete headers to the
+ * driver from the calling task. */
+        BaseType_t xUDPConnectDirectOutput( NetworkBufferDescriptor_t * pxNetworkBuffer );
+    #endif
+
+#endif /* ipconfigUSE_UDP_CONNECT */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     } /* extern "C" */
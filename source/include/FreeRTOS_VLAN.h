@@ -0,0 +1,91 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_VLAN.h
+ * @brief Header file for the 802.1Q VLAN interfaces.
+ */
+
+#ifndef FREERTOS_VLAN_H
+#define FREERTOS_VLAN_H
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Routing.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( ipconfigUSE_VLAN != 0 )
+
+/* The VLAN ID in the lowest 12 bits of an 802.1Q tag. */
+    #define ipVLAN_ID_MASK            ( ( uint16_t ) 0x0FFFU )
+
+/* The priority ( PCP ) in the highest 3 bits of an 802.1Q tag. */
+    #define ipVLAN_PRIORITY_SHIFT     ( 13U )
+
+/* Make an 802.1Q tag from a VLAN ID and a priority 0..7. */
+    #define ipVLAN_TAG( usVLANID, ucPriority ) \
+    ( ( uint16_t ) ( ( ( ( uint16_t ) ( ucPriority ) & 0x07U ) << ipVLAN_PRIORITY_SHIFT ) | ( ( uint16_t ) ( usVLANID ) & ipVLAN_ID_MASK ) ) )
+
+/*
+ * Create a virtual interface for the VLAN in 'usVLANTag', see ipVLAN_TAG(),
+ * on top of the physical interface 'pxParent', which must have been added
+ * before. The object pointed to by 'pxInterface' must remain to exist.
+ * End-points are added to the returned interface as to any other interface.
+ */
+    NetworkInterface_t * FreeRTOS_FillVLANInterface( NetworkInterface_t * pxParent,
+                                                     NetworkInterface_t * pxInterface,
+                                                     const char * pcName,
+                                                     uint16_t usVLANTag );
+
+/*
+ * Called by the IP-task for every received frame, before anything else
+ * looks at it. Removes an 802.1Q tag and assigns the frame to the VLAN
+ * interface of its VLAN ID. Returns pdFALSE when the frame must be dropped.
+ */
+    BaseType_t xVLANReceive( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Return an end-point of one of the VLAN interfaces of 'pxParent', or NULL
+ * when it has none. Used by FreeRTOS_MatchingEndpoint() to let tagged frames
+ * pass to the IP-task.
+ */
+    NetworkEndPoint_t * pxVLANAnyEndPoint( const NetworkInterface_t * pxParent );
+
+#endif /* ( ipconfigUSE_VLAN != 0 ) */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_VLAN_H */
@@ -205,6 +205,19 @@
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * iptraceRX_PACKET_DROPPED
+ *
+ * Called when a received packet is dropped, with the interface that received
+ * it and the reason, a value of eNetworkDropReason_t. The same drops are
+ * counted per interface when ipconfigUSE_NETWORK_COUNTERS is enabled.
+ */
+#ifndef iptraceRX_PACKET_DROPPED
+    #define iptraceRX_PACKET_DROPPED( pxInterface, eReason )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*===========================================================================*/
 /*                           NETWORK TRACE MACROS                            */
 /*===========================================================================*/
@@ -405,6 +418,32 @@
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * iptraceSOCKET_MEMORY_PRESSURE
+ *
+ * Called when the pressure on the memory budget of the sockets changes, with
+ * the new eSocketMemoryPressure_t and the bytes in use, see
+ * ipconfigUSE_SOCKET_MEMORY_BUDGET.
+ */
+#ifndef iptraceSOCKET_MEMORY_PRESSURE
+    #define iptraceSOCKET_MEMORY_PRESSURE( ePressure, uxUsed )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * iptraceTCP_RETRANSMISSION
+ *
+ * Called when the sliding window of a TCP connection sends a segment again,
+ * with the local port of the connection and the sequence number of the
+ * segment.
+ */
+#ifndef iptraceTCP_RETRANSMISSION
+    #define iptraceTCP_RETRANSMISSION( usOurPortNumber, ulSequenceNumber )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*===========================================================================*/
 /*                           SOCKET TRACE MACROS                             */
 /*===========================================================================*/
@@ -443,6 +482,20 @@
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * iptraceARP_REQUEST_SUPPRESSED
+ *
+ * Called when a broadcast ARP request for ulIPAddress is not sent, because a
+ * request for the same address was sent too recently, see
+ * ipconfigARP_REQUEST_LIMIT_ENTRIES. ulIPAddress is expressed as a 32-bit
+ * number in network byte order.
+ */
+#ifndef iptraceARP_REQUEST_SUPPRESSED
+    #define iptraceARP_REQUEST_SUPPRESSED( ulIPAddress )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * iptraceARP_TABLE_ENTRY_EXPIRED
  *
@@ -626,6 +679,19 @@
 
 /*-----------------------------------------------------------------------*/
 
+/*
+ * iptraceINTERFACE_READY
+ *
+ * Called when all end-points of an interface are up, with the number of
+ * ticks since the interface itself came up.  Only used when
+ * ipconfigUSE_FAST_BRING_UP is enabled.
+ */
+#ifndef iptraceINTERFACE_READY
+    #define iptraceINTERFACE_READY( pxInterface, xTimeToReady )
+#endif
+
+/*-----------------------------------------------------------------------*/
+
 /*
  * iptraceSENDING_DHCP_DISCOVER
  *
@@ -708,6 +774,18 @@
 
 /*-----------------------------------------------------------------------*/
 
+/*
+ * iptraceICMP_RATE_LIMITED
+ *
+ * Called when an ICMP or ICMPv6 message of type eType is not sent, because
+ * the limit of ipconfigUSE_ICMP_RATE_LIMIT was reached.
+ */
+#ifndef iptraceICMP_RATE_LIMITED
+    #define iptraceICMP_RATE_LIMITED( eType )
+#endif
+
+/*-----------------------------------------------------------------------*/
+
 /*===========================================================================*/
 /*                             ICMP TRACE MACROS                             */
 /*===========================================================================*/
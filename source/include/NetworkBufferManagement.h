@@ -50,6 +50,12 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
 NetworkBufferDescriptor_t * pxNetworkBufferGetFromISR( size_t xRequestedSizeBytes );
 void vReleaseNetworkBufferAndDescriptor( NetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+/* Release 'uxCount' network buffers with a single critical section, e.g. the
+ * descriptors of a DMA ring after a transmission interrupt.  NULL entries are
+ * skipped, and all entries are set to NULL. */
+void vReleaseNetworkBuffersAndDescriptors( NetworkBufferDescriptor_t * pxNetworkBuffers[],
+                                           size_t uxCount );
+
 /* The definition of the below function is only available if BufferAllocation_2.c has been linked into the source. */
 BaseType_t vNetworkBufferReleaseFromISR( NetworkBufferDescriptor_t * const pxNetworkBuffer );
 uint8_t * pucGetNetworkBuffer( size_t * pxRequestedSizeBytes );
@@ -61,6 +67,17 @@ UBaseType_t uxGetNumberOfFreeNetworkBuffers( void );
 /* Get the lowest number of free network buffers. */
 UBaseType_t uxGetMinimumFreeNetworkBuffers( void );
 
+#if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+
+/* Get a buffer for application data, which may not use the buffers that are
+ * reserved for control traffic. */
+    NetworkBufferDescriptor_t * pxGetBulkNetworkBufferWithDescriptor( size_t xRequestedSizeBytes,
+                                                                      TickType_t xBlockTimeTicks );
+#else
+    #define pxGetBulkNetworkBufferWithDescriptor( xRequestedSizeBytes, xBlockTimeTicks ) \
+    pxGetNetworkBufferWithDescriptor( ( xRequestedSizeBytes ), ( xBlockTimeTicks ) )
+#endif
+
 /* Copy a network buffer into a bigger buffer. */
 NetworkBufferDescriptor_t * pxDuplicateNetworkBufferWithDescriptor( const NetworkBufferDescriptor_t * const pxNetworkBuffer,
                                                                     size_t uxNewLength );
@@ -70,6 +87,74 @@ NetworkBufferDescriptor_t * pxDuplicateNetworkBufferWithDescriptor( const Networ
 NetworkBufferDescriptor_t * pxResizeNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer,
                                                                  size_t xNewSizeBytes );
 
+#if ( ipconfigUSE_SCATTER_GATHER != 0 )
+
+/* Add a segment to the end of the frame in a network buffer. */
+    void vNetworkBufferAppendSegment( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                      NetworkBufferSegment_t * pxSegment );
+
+/* Return the length of the frame, including all segments. */
+    size_t uxNetworkBufferFrameLength( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* Copy a frame with segments into a new, single network buffer. */
+    NetworkBufferDescriptor_t * pxNetworkBufferLinearise( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* Hand back the segments of a network buffer, called when it is released. */
+    void vNetworkBufferReleaseSegments( NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif /* ipconfigUSE_SCATTER_GATHER */
+
+#if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+
+/* Add an owner to a network buffer, which is shared read-only from now on. */
+    NetworkBufferDescriptor_t * pxNetworkBufferAddReference( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* Remove an owner, returns pdTRUE when it was the last one and the buffer
+ * must be returned to the pool. */
+    BaseType_t xNetworkBufferDropReference( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* The same as xNetworkBufferDropReference(), to be called from an ISR. */
+    BaseType_t xNetworkBufferDropReferenceFromISR( NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif /* ipconfigUSE_NETWORK_BUFFER_REFCOUNT */
+
+#if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 )
+
+/* Round a size up to a whole number of cache lines. */
+    #define ipNETWORK_BUFFER_CACHE_ALIGN( uxSize ) \
+    ( ( ( uxSize ) + ( ( size_t ) ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE - 1U ) ) & ~( ( size_t ) ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE - 1U ) )
+
+/* Give every descriptor a block of 'uxBufferSize' bytes, rounded up to whole
+ * cache lines, from the cache-aligned memory at 'pucRAM'. */
+    void vNetworkBuffersAssignCacheAligned( NetworkBufferDescriptor_t pxNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ],
+                                            uint8_t * pucRAM,
+                                            size_t uxBufferSize );
+
+/* Write the frame back to memory before the DMA reads it, unless that was
+ * done since the stack passed the buffer to the driver. */
+    void vNetworkBufferCacheClean( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* Discard the cached copy of the first 'uxLength' bytes of the frame, around
+ * a DMA transfer that writes to the buffer. */
+    void vNetworkBufferCacheInvalidate( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                        size_t uxLength );
+#else
+    #define ipNETWORK_BUFFER_CACHE_ALIGN( uxSize )    ( uxSize )
+#endif /* ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE */
+
+#if ( ipconfigRX_COPY_BREAK != 0 )
+
+/* Copy a received frame of at most ipconfigRX_COPY_BREAK bytes, whose length
+ * is in 'xDataLength', to a small network buffer.  The driver keeps the large
+ * buffer.  Returns NULL when the frame is too long or no small buffer is free.
+ * Not to be called from an ISR. */
+    NetworkBufferDescriptor_t * pxNetworkBufferCopyBreak( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* pdTRUE when 'pxNetworkBuffer', or a new buffer when it is NULL, can hold a
+ * frame of ipTOTAL_ETHERNET_FRAME_SIZE bytes without being resized. */
+    BaseType_t xIsFixedSizeNetworkBuffer( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+#else
+    #define xIsFixedSizeNetworkBuffer( pxNetworkBuffer )    ( xBufferAllocFixedSize )
+#endif /* ipconfigRX_COPY_BREAK */
+
 #if ipconfigTCP_IP_SANITY
 
 /*
@@ -58,12 +58,37 @@ static List_t xFreeBuffersList;
 /* Some statistics about the use of buffers. */
 static UBaseType_t uxMinimumFreeNetworkBuffers = 0U;
 
+#if ( ipconfigRX_COPY_BREAK != 0 )
+
+/* The small buffers of pxNetworkBufferCopyBreak() follow the large ones in
+ * xNetworkBuffers[]. */
+    #define baSMALL_BUFFER_COUNT     ( ipconfigRX_COPY_BREAK_BUFFERS )
+
+/* The bytes of one small buffer, including the padding, in whole words. */
+    #define baSMALL_BUFFER_WORDS     ( ( ipBUFFER_PADDING + ipconfigRX_COPY_BREAK + sizeof( uint32_t ) - 1U ) / sizeof( uint32_t ) )
+#else
+    #define baSMALL_BUFFER_COUNT     ( 0 )
+#endif
+
 /* Declares the pool of NetworkBufferDescriptor_t structures that are available
  * to the system.  All the network buffers referenced from xFreeBuffersList exist
  * in this array.  The array is not accessed directly except during initialisation,
  * when the xFreeBuffersList is filled (as all the buffers are free when the system
  * is booted). */
-static NetworkBufferDescriptor_t xNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ];
+static NetworkBufferDescriptor_t xNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + baSMALL_BUFFER_COUNT ];
+
+#if ( ipconfigRX_COPY_BREAK != 0 )
+
+/* The free small buffers.  A descriptor is small as long as its
+ * 'pucEthernetBuffer' points into ulSmallBufferRAM[].  The small buffers do
+ * not count in xNetworkBufferSemaphore. */
+    static List_t xFreeSmallBuffersList;
+
+    static uint32_t ulSmallBufferRAM[ baSMALL_BUFFER_COUNT ][ baSMALL_BUFFER_WORDS ];
+
+    static BaseType_t prvIsSmallBuffer( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+    static void prvSmallBufferRelease( NetworkBufferDescriptor_t * const pxNetworkBuffer );
+#endif /* ipconfigRX_COPY_BREAK != 0 */
 
 /* This constant is defined as true to let FreeRTOS_TCP_IP.c know that the
  * network buffers have constant size, large enough to hold the biggest Ethernet
@@ -73,6 +98,12 @@ const BaseType_t xBufferAllocFixedSize = pdTRUE;
 /* The semaphore used to obtain network buffers. */
 static SemaphoreHandle_t xNetworkBufferSemaphore = NULL;
 
+#if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+    /* Counts the buffers that bulk data may still take, so that the reserved
+     * buffers stay available for control traffic. */
+    static SemaphoreHandle_t xBulkBufferSemaphore = NULL;
+#endif
+
 #if ( ipconfigTCP_IP_SANITY != 0 )
     static char cIsLow = pdFALSE;
     UBaseType_t bIsValidNetworkDescriptor( const NetworkBufferDescriptor_t * pxDesc );
@@ -82,6 +113,49 @@ static SemaphoreHandle_t xNetworkBufferSemaphore = NULL;
 
 static void prvShowWarnings( void );
 
+#if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+
+/* One cache of free buffers per core, see ipconfigBUFFER_ALLOC_CACHE_SIZE. */
+    #if defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 )
+        #define baCACHE_COUNT      ( configNUMBER_OF_CORES )
+        #define baCACHE_INDEX()    ( ( UBaseType_t ) portGET_CORE_ID() )
+    #else
+        #define baCACHE_COUNT      ( 1 )
+        #define baCACHE_INDEX()    ( 0U )
+    #endif
+
+/* The number of buffers that move between a cache and xFreeBuffersList at
+ * once: when a cache overflows, and when it is refilled. */
+    #define baCACHE_BATCH_COUNT    ( ( ( UBaseType_t ) ipconfigBUFFER_ALLOC_CACHE_SIZE + 1U ) / 2U )
+
+/* On a single core, masking the interrupts protects the cache and keeps the
+ * task on the core.  With more cores, a cache may be emptied by another core
+ * in prvCacheSteal(), so the buffer lock is used. */
+    #if ( baCACHE_COUNT > 1 )
+        #define baCACHE_LOCK()      ipconfigBUFFER_ALLOC_LOCK()
+        #define baCACHE_UNLOCK()    ipconfigBUFFER_ALLOC_UNLOCK()
+    #else
+        #define baCACHE_LOCK()      ipconfigBUFFER_ALLOC_LOCK_FROM_ISR()
+        #define baCACHE_UNLOCK()    ipconfigBUFFER_ALLOC_UNLOCK_FROM_ISR()
+    #endif
+
+/* The buffers in a cache have already been counted down from
+ * xNetworkBufferSemaphore. */
+    static List_t xBufferCaches[ baCACHE_COUNT ];
+
+    static NetworkBufferDescriptor_t * prvCacheTake( void );
+    static void prvCacheRefill( void );
+    static void prvCacheRelease( NetworkBufferDescriptor_t * const pxNetworkBuffer );
+
+    #if ( baCACHE_COUNT > 1 )
+        static NetworkBufferDescriptor_t * prvCacheSteal( void );
+    #endif
+#endif /* ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 */
+
+#if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 ) || ( ipconfigTCP_IP_SANITY != 0 )
+    static BaseType_t prvIsInFreeList( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif
+
 /* The user can define their own ipconfigBUFFER_ALLOC_LOCK() and
  * ipconfigBUFFER_ALLOC_UNLOCK() macros, especially for use form an ISR.  If these
  * are not defined then default them to call the normal enter/exit critical
@@ -120,7 +194,7 @@ static void prvShowWarnings( void );
     BaseType_t prvIsFreeBuffer( const NetworkBufferDescriptor_t * pxDescr )
     {
         return ( bIsValidNetworkDescriptor( pxDescr ) != 0 ) &&
-               ( listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxDescr->xBufferListItem ) ) != 0 );
+               ( prvIsInFreeList( pxDescr ) != pdFALSE );
     }
     /*-----------------------------------------------------------*/
 
@@ -165,6 +239,425 @@ static void prvShowWarnings( void );
 
 #endif /* ipconfigTCP_IP_SANITY */
 
+#if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 ) || ( ipconfigTCP_IP_SANITY != 0 )
+
+/**
+ * @brief Check if a network buffer is free, i.e. stored in xFreeBuffersList or
+ *        in one of the per-core caches.
+ *
+ * @param[in] pxNetworkBuffer The buffer to be checked.
+ *
+ * @return pdTRUE if the buffer is free, otherwise pdFALSE.
+ */
+    static BaseType_t prvIsInFreeList( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xReturn = listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+
+        #if ( ipconfigRX_COPY_BREAK != 0 )
+        {
+            if( xReturn == pdFALSE )
+            {
+                xReturn = listIS_CONTAINED_WITHIN( &xFreeSmallBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+            }
+        }
+        #endif
+
+        #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+        {
+            UBaseType_t uxCache;
+
+            for( uxCache = 0U; ( uxCache < ( UBaseType_t ) baCACHE_COUNT ) && ( xReturn == pdFALSE ); uxCache++ )
+            {
+                xReturn = listIS_CONTAINED_WITHIN( &( xBufferCaches[ uxCache ] ), &( pxNetworkBuffer->xBufferListItem ) );
+            }
+        }
+        #endif /* ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 */
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 ) || ( ipconfigTCP_IP_SANITY != 0 ) */
+
+#if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+
+/**
+ * @brief Take a free network buffer from the cache of the current core.
+ *
+ * @return A network buffer, or NULL when the cache is empty.
+ */
+    static NetworkBufferDescriptor_t * prvCacheTake( void )
+    {
+        NetworkBufferDescriptor_t * pxReturn = NULL;
+        List_t * pxCache;
+
+        baCACHE_LOCK();
+        {
+            pxCache = &( xBufferCaches[ baCACHE_INDEX() ] );
+
+            if( listLIST_IS_EMPTY( pxCache ) == pdFALSE )
+            {
+                pxReturn = ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCache );
+                ( void ) uxListRemove( &( pxReturn->xBufferListItem ) );
+            }
+        }
+        baCACHE_UNLOCK();
+
+        return pxReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    #if ( baCACHE_COUNT > 1 )
+
+/**
+ * @brief Take a free network buffer from the cache of any core.  This is
+ *        done before a task blocks on xNetworkBufferSemaphore, because the
+ *        cached buffers are not counted by the semaphore.
+ *
+ * @return A network buffer, or NULL when all caches are empty.
+ */
+        static NetworkBufferDescriptor_t * prvCacheSteal( void )
+        {
+            NetworkBufferDescriptor_t * pxReturn = NULL;
+            UBaseType_t uxCache;
+
+            ipconfigBUFFER_ALLOC_LOCK();
+            {
+                for( uxCache = 0U; ( uxCache < ( UBaseType_t ) baCACHE_COUNT ) && ( pxReturn == NULL ); uxCache++ )
+                {
+                    if( listLIST_IS_EMPTY( &( xBufferCaches[ uxCache ] ) ) == pdFALSE )
+                    {
+                        pxReturn = ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xBufferCaches[ uxCache ] ) );
+                        ( void ) uxListRemove( &( pxReturn->xBufferListItem ) );
+                    }
+                }
+            }
+            ipconfigBUFFER_ALLOC_UNLOCK();
+
+            return pxReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* baCACHE_COUNT > 1 */
+
+/**
+ * @brief After a buffer was taken from xFreeBuffersList, move up to
+ *        baCACHE_BATCH_COUNT more free buffers into the cache of the current
+ *        core, so that the next allocations are cache hits.  Only buffers
+ *        that can be counted down from the semaphore without waiting are
+ *        moved.
+ */
+    static void prvCacheRefill( void )
+    {
+        NetworkBufferDescriptor_t * pxRefill[ baCACHE_BATCH_COUNT ];
+        UBaseType_t uxTokens = 0U;
+        UBaseType_t uxCount = 0U;
+        UBaseType_t uxCached = 0U;
+        UBaseType_t uxIndex;
+        List_t * pxCache;
+
+        while( ( uxTokens < baCACHE_BATCH_COUNT ) &&
+               ( xSemaphoreTake( xNetworkBufferSemaphore, 0U ) == pdPASS ) )
+        {
+            uxTokens++;
+        }
+
+        if( uxTokens > 0U )
+        {
+            ipconfigBUFFER_ALLOC_LOCK();
+            {
+                while( ( uxCount < uxTokens ) && ( listLIST_IS_EMPTY( &xFreeBuffersList ) == pdFALSE ) )
+                {
+                    pxRefill[ uxCount ] = ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xFreeBuffersList );
+                    ( void ) uxListRemove( &( pxRefill[ uxCount ]->xBufferListItem ) );
+                    uxCount++;
+                }
+            }
+            ipconfigBUFFER_ALLOC_UNLOCK();
+
+            baCACHE_LOCK();
+            {
+                pxCache = &( xBufferCaches[ baCACHE_INDEX() ] );
+
+                while( ( uxCached < uxCount ) &&
+                       ( listCURRENT_LIST_LENGTH( pxCache ) < ( UBaseType_t ) ipconfigBUFFER_ALLOC_CACHE_SIZE ) )
+                {
+                    vListInsertEnd( pxCache, &( pxRefill[ uxCached ]->xBufferListItem ) );
+                    uxCached++;
+                }
+            }
+            baCACHE_UNLOCK();
+
+            if( uxCached < uxCount )
+            {
+                /* The cache was filled by a release in the meantime. */
+                ipconfigBUFFER_ALLOC_LOCK();
+                {
+                    for( uxIndex = uxCached; uxIndex < uxCount; uxIndex++ )
+                    {
+                        vListInsertEnd( &xFreeBuffersList, &( pxRefill[ uxIndex ]->xBufferListItem ) );
+                    }
+                }
+                ipconfigBUFFER_ALLOC_UNLOCK();
+            }
+
+            /* Give back the tokens of the buffers that were not cached. */
+            for( uxIndex = uxCached; uxIndex < uxTokens; uxIndex++ )
+            {
+                ( void ) xSemaphoreGive( xNetworkBufferSemaphore );
+            }
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a released network buffer in the cache of the current core.
+ *        When the cache is full, its oldest buffers are returned to
+ *        xFreeBuffersList in a single critical section.  When no buffers
+ *        are left in xFreeBuffersList, a task may be waiting for one, so the
+ *        buffer goes straight back to xFreeBuffersList.
+ *
+ * @param[in] pxNetworkBuffer The buffer being released.
+ */
+    static void prvCacheRelease( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        NetworkBufferDescriptor_t * pxFlush[ baCACHE_BATCH_COUNT ];
+        UBaseType_t uxFlushCount = 0U;
+        UBaseType_t uxIndex;
+        BaseType_t xListItemAlreadyInFreeList;
+        BaseType_t xBypass;
+        List_t * pxCache;
+
+        xBypass = ( uxSemaphoreGetCount( xNetworkBufferSemaphore ) == 0U ) ? pdTRUE : pdFALSE;
+
+        baCACHE_LOCK();
+        {
+            xListItemAlreadyInFreeList = prvIsInFreeList( pxNetworkBuffer );
+
+            if( xListItemAlreadyInFreeList != pdFALSE )
+            {
+                /* Reported below. */
+            }
+            else if( xBypass != pdFALSE )
+            {
+                pxFlush[ 0 ] = pxNetworkBuffer;
+                uxFlushCount = 1U;
+            }
+            else
+            {
+                pxCache = &( xBufferCaches[ baCACHE_INDEX() ] );
+
+                if( listCURRENT_LIST_LENGTH( pxCache ) >= ( UBaseType_t ) ipconfigBUFFER_ALLOC_CACHE_SIZE )
+                {
+                    while( uxFlushCount < baCACHE_BATCH_COUNT )
+                    {
+                        pxFlush[ uxFlushCount ] = ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCache );
+                        ( void ) uxListRemove( &( pxFlush[ uxFlushCount ]->xBufferListItem ) );
+                        uxFlushCount++;
+                    }
+                }
+
+                vListInsertEnd( pxCache, &( pxNetworkBuffer->xBufferListItem ) );
+            }
+        }
+        baCACHE_UNLOCK();
+
+        if( xListItemAlreadyInFreeList != pdFALSE )
+        {
+            FreeRTOS_debug_printf( ( "vReleaseNetworkBufferAndDescriptor: %p ALREADY RELEASED (now %lu)\n",
+                                     pxNetworkBuffer, uxGetNumberOfFreeNetworkBuffers() ) );
+        }
+        else if( uxFlushCount > 0U )
+        {
+            ipconfigBUFFER_ALLOC_LOCK();
+            {
+                for( uxIndex = 0U; uxIndex < uxFlushCount; uxIndex++ )
+                {
+                    vListInsertEnd( &xFreeBuffersList, &( pxFlush[ uxIndex ]->xBufferListItem ) );
+                }
+            }
+            ipconfigBUFFER_ALLOC_UNLOCK();
+
+            for( uxIndex = 0U; uxIndex < uxFlushCount; uxIndex++ )
+            {
+                ( void ) xSemaphoreGive( xNetworkBufferSemaphore );
+            }
+
+            prvShowWarnings();
+        }
+        else
+        {
+            /* The buffer was stored in the cache. */
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 */
+
+#if ( ipconfigRX_COPY_BREAK != 0 )
+
+/**
+ * @brief Check if the storage of a network buffer is one of the small buffers.
+ *
+ * @param[in] pxNetworkBuffer The buffer to be checked.
+ *
+ * @return pdTRUE if 'pucEthernetBuffer' points into ulSmallBufferRAM[].
+ */
+    static BaseType_t prvIsSmallBuffer( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        uintptr_t uxStart = ( uintptr_t ) ulSmallBufferRAM;
+        uintptr_t uxBuffer = ( uintptr_t ) pxNetworkBuffer->pucEthernetBuffer;
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( uxBuffer >= uxStart ) && ( uxBuffer < ( uxStart + sizeof( ulSmallBufferRAM ) ) ) )
+        {
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Let the padding in front of the storage of a buffer point back to
+ *        its descriptor, after the storage has changed hands.
+ *
+ * @param[in] pxNetworkBuffer The new owner of 'pucEthernetBuffer'.
+ */
+    static void prvSetBackPointer( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        *( ( NetworkBufferDescriptor_t ** ) &( pxNetworkBuffer->pucEthernetBuffer[ -( ( BaseType_t ) ipBUFFER_PADDING ) ] ) ) = pxNetworkBuffer;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Return a small buffer to xFreeSmallBuffersList.
+ *
+ * @param[in] pxNetworkBuffer The buffer being released.
+ */
+    static void prvSmallBufferRelease( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        BaseType_t xListItemAlreadyInFreeList;
+
+        ipconfigBUFFER_ALLOC_LOCK();
+        {
+            xListItemAlreadyInFreeList = listIS_CONTAINED_WITHIN( &xFreeSmallBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+
+            if( xListItemAlreadyInFreeList == pdFALSE )
+            {
+                vListInsertEnd( &xFreeSmallBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+            }
+        }
+        ipconfigBUFFER_ALLOC_UNLOCK();
+
+        if( xListItemAlreadyInFreeList != pdFALSE )
+        {
+            FreeRTOS_debug_printf( ( "prvSmallBufferRelease: %p ALREADY RELEASED\n", pxNetworkBuffer ) );
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Copy a small received frame to one of the small buffers, so that the
+ *        driver can give its large buffer back to the DMA at once.
+ *
+ * @param[in] pxNetworkBuffer The buffer that received the frame, 'xDataLength'
+ *                            holds the length of the frame.
+ *
+ * @return The copy, or NULL when the frame is longer than ipconfigRX_COPY_BREAK
+ *         or when all small buffers are in use.
+ */
+    NetworkBufferDescriptor_t * pxNetworkBufferCopyBreak( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkBufferDescriptor_t * pxReturn = NULL;
+        size_t uxLength = pxNetworkBuffer->xDataLength;
+
+        if( uxLength <= ( size_t ) ipconfigRX_COPY_BREAK )
+        {
+            ipconfigBUFFER_ALLOC_LOCK();
+            {
+                if( listLIST_IS_EMPTY( &xFreeSmallBuffersList ) == pdFALSE )
+                {
+                    pxReturn = ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xFreeSmallBuffersList );
+                    ( void ) uxListRemove( &( pxReturn->xBufferListItem ) );
+                }
+            }
+            ipconfigBUFFER_ALLOC_UNLOCK();
+        }
+
+        if( pxReturn != NULL )
+        {
+            ( void ) memcpy( pxReturn->pucEthernetBuffer, pxNetworkBuffer->pucEthernetBuffer, uxLength );
+            pxReturn->xDataLength = uxLength;
+            pxReturn->pxInterface = pxNetworkBuffer->pxInterface;
+            pxReturn->pxEndPoint = pxNetworkBuffer->pxEndPoint;
+
+            pxReturn->pxNextBuffer = NULL;
+
+            #if ( ipconfigUSE_TCP_TSO != 0 )
+            {
+                pxReturn->usTCPSegmentSize = 0U;
+            }
+            #endif
+
+            #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            {
+                pxReturn->ucChecksumFlags = pxNetworkBuffer->ucChecksumFlags;
+            }
+            #endif
+
+            #if ( ipconfigUSE_VLAN != 0 )
+            {
+                pxReturn->usVLANTag = pxNetworkBuffer->usVLANTag;
+            }
+            #endif
+
+            #if ( ipconfigUSE_PACKET_METADATA != 0 )
+            {
+                pxReturn->xMetadata.ucValid = pdFALSE_UNSIGNED;
+            }
+            #endif
+
+            #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+            {
+                pxReturn->xTimestamp = pxNetworkBuffer->xTimestamp;
+                pxReturn->ucTxTimestamp = pdFALSE_UNSIGNED;
+            }
+            #endif
+
+            iptraceNETWORK_BUFFER_OBTAINED( pxReturn );
+        }
+
+        return pxReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a network buffer can hold a full frame.
+ *
+ * @param[in] pxNetworkBuffer The buffer, or NULL for a new buffer.
+ *
+ * @return pdFALSE for a small buffer of pxNetworkBufferCopyBreak(), which
+ *         must be resized before it grows, otherwise pdTRUE.
+ */
+    BaseType_t xIsFixedSizeNetworkBuffer( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xReturn = pdTRUE;
+
+        if( ( pxNetworkBuffer != NULL ) && ( prvIsSmallBuffer( pxNetworkBuffer ) != pdFALSE ) )
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ipconfigRX_COPY_BREAK != 0 */
+
 BaseType_t xNetworkBuffersInitialise( void )
 {
     BaseType_t xReturn;
@@ -194,10 +687,40 @@ BaseType_t xNetworkBuffersInitialise( void )
 
         configASSERT( xNetworkBufferSemaphore != NULL );
 
+        #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+        {
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                static StaticSemaphore_t xBulkBufferSemaphoreBuffer;
+                xBulkBufferSemaphore = xSemaphoreCreateCountingStatic(
+                    ( UBaseType_t ) ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ),
+                    ( UBaseType_t ) ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ),
+                    &xBulkBufferSemaphoreBuffer );
+            }
+            #else
+            {
+                xBulkBufferSemaphore = xSemaphoreCreateCounting( ( UBaseType_t ) ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ),
+                                                                 ( UBaseType_t ) ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ) );
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            configASSERT( xBulkBufferSemaphore != NULL );
+        }
+        #endif /* ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL */
+
         if( xNetworkBufferSemaphore != NULL )
         {
             vListInitialise( &xFreeBuffersList );
 
+            #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+            {
+                for( x = 0U; x < ( uint32_t ) baCACHE_COUNT; x++ )
+                {
+                    vListInitialise( &( xBufferCaches[ x ] ) );
+                }
+            }
+            #endif
+
             /* Initialise all the network buffers.  The buffer storage comes
              * from the network interface, and different hardware has different
              * requirements. */
@@ -213,6 +736,31 @@ BaseType_t xNetworkBuffersInitialise( void )
                 vListInsert( &xFreeBuffersList, &( xNetworkBuffers[ x ].xBufferListItem ) );
             }
 
+            #if ( ipconfigRX_COPY_BREAK != 0 )
+            {
+                vListInitialise( &xFreeSmallBuffersList );
+
+                for( x = 0U; x < ( uint32_t ) baSMALL_BUFFER_COUNT; x++ )
+                {
+                    NetworkBufferDescriptor_t * pxSmall = &( xNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + x ] );
+                    uint8_t * pucBlock = ( uint8_t * ) ulSmallBufferRAM[ x ];
+
+                    pxSmall->pucEthernetBuffer = &( pucBlock[ ipBUFFER_PADDING ] );
+                    prvSetBackPointer( pxSmall );
+
+                    #if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 )
+                    {
+                        pxSmall->xCacheCleanNeeded = pdFALSE;
+                    }
+                    #endif
+
+                    vListInitialiseItem( &( pxSmall->xBufferListItem ) );
+                    listSET_LIST_ITEM_OWNER( &( pxSmall->xBufferListItem ), pxSmall );
+                    vListInsertEnd( &xFreeSmallBuffersList, &( pxSmall->xBufferListItem ) );
+                }
+            }
+            #endif /* ipconfigRX_COPY_BREAK != 0 */
+
             uxMinimumFreeNetworkBuffers = ( UBaseType_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS;
         }
     }
@@ -235,6 +783,8 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
 {
     NetworkBufferDescriptor_t * pxReturn = NULL;
     BaseType_t xInvalid = pdFALSE;
+    BaseType_t xObtained = pdFALSE;
+    BaseType_t xHaveToken = pdFALSE;
     UBaseType_t uxCount;
 
     /* The current implementation only has a single size memory block, so
@@ -243,9 +793,44 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
 
     if( xNetworkBufferSemaphore != NULL )
     {
+        #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+        {
+            /* A buffer from the cache of this core has already been
+             * counted down from the semaphore. */
+            pxReturn = prvCacheTake();
+
+            if( pxReturn != NULL )
+            {
+                xObtained = pdTRUE;
+            }
+
+            #if ( baCACHE_COUNT > 1 )
+                else if( xSemaphoreTake( xNetworkBufferSemaphore, 0U ) == pdPASS )
+                {
+                    xHaveToken = pdTRUE;
+                }
+                else
+                {
+                    /* Do not block while other cores hold free buffers. */
+                    pxReturn = prvCacheSteal();
+
+                    if( pxReturn != NULL )
+                    {
+                        xObtained = pdTRUE;
+                    }
+                }
+            #endif /* baCACHE_COUNT > 1 */
+        }
+        #endif /* ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 */
+
         /* If there is a semaphore available, there is a network buffer
          * available. */
-        if( xSemaphoreTake( xNetworkBufferSemaphore, xBlockTimeTicks ) == pdPASS )
+        if( xObtained != pdFALSE )
+        {
+            /* The buffer was found in a cache. */
+        }
+        else if( ( xHaveToken != pdFALSE ) ||
+                 ( xSemaphoreTake( xNetworkBufferSemaphore, xBlockTimeTicks ) == pdPASS ) )
         {
             /* Protect the structure as it is accessed from tasks and
              * interrupts. */
@@ -265,6 +850,27 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
             }
             ipconfigBUFFER_ALLOC_UNLOCK();
 
+            xObtained = pdTRUE;
+
+            #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+            {
+                if( xInvalid == pdFALSE )
+                {
+                    /* The cache of this core was empty, refill it. */
+                    prvCacheRefill();
+                }
+            }
+            #endif
+        }
+        else
+        {
+            /* lint wants to see at least a comment. */
+            iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER();
+            ipRESOURCE_SHORTAGE( eShortageNetworkBuffers );
+        }
+
+        if( xObtained != pdFALSE )
+        {
             if( xInvalid == pdTRUE )
             {
                 /* _RB_ Can printf() be called from an interrupt?  (comment
@@ -279,8 +885,16 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
             }
             else
             {
-                /* Reading UBaseType_t, no critical section needed. */
-                uxCount = listCURRENT_LIST_LENGTH( &xFreeBuffersList );
+                #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+                {
+                    uxCount = uxGetNumberOfFreeNetworkBuffers();
+                }
+                #else
+                {
+                    /* Reading UBaseType_t, no critical section needed. */
+                    uxCount = listCURRENT_LIST_LENGTH( &xFreeBuffersList );
+                }
+                #endif
 
                 /* For stats, latch the lowest number of network buffers since
                  * booting. */
@@ -299,25 +913,89 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
                 }
                 #endif /* ipconfigTCP_IP_SANITY */
 
-                #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+                /* make sure the buffer is not linked */
+                pxReturn->pxNextBuffer = NULL;
+
+                #if ( ipconfigUSE_TCP_TSO != 0 )
+                {
+                    pxReturn->usTCPSegmentSize = 0U;
+                }
+                #endif
+
+                #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+                {
+                    pxReturn->ucChecksumFlags = 0U;
+                }
+                #endif
+
+                #if ( ipconfigUSE_VLAN != 0 )
+                {
+                    pxReturn->usVLANTag = 0U;
+                }
+                #endif
+
+                #if ( ipconfigUSE_PACKET_METADATA != 0 )
                 {
-                    /* make sure the buffer is not linked */
-                    pxReturn->pxNextBuffer = NULL;
+                    pxReturn->xMetadata.ucValid = pdFALSE_UNSIGNED;
                 }
-                #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+                #endif
+
+                #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+                {
+                    pxReturn->xTimestamp.ulSeconds = 0U;
+                    pxReturn->xTimestamp.ulNanoseconds = 0U;
+                    pxReturn->ucTxTimestamp = pdFALSE_UNSIGNED;
+                }
+                #endif
             }
 
             iptraceNETWORK_BUFFER_OBTAINED( pxReturn );
         }
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+
+/* Obtain a network buffer for application data. Such buffers are counted
+ * against xBulkBufferSemaphore first, so that ARP, DHCP and TCP control
+ * packets can always get one of the reserved buffers. */
+    NetworkBufferDescriptor_t * pxGetBulkNetworkBufferWithDescriptor( size_t xRequestedSizeBytes,
+                                                                      TickType_t xBlockTimeTicks )
+    {
+        NetworkBufferDescriptor_t * pxReturn = NULL;
+        TimeOut_t xTimeOut;
+        TickType_t xRemainingTime = xBlockTimeTicks;
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        if( ( xBulkBufferSemaphore != NULL ) &&
+            ( xSemaphoreTake( xBulkBufferSemaphore, xBlockTimeTicks ) == pdPASS ) )
+        {
+            /* Only wait for the time that is left. */
+            ( void ) xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime );
+
+            pxReturn = pxGetNetworkBufferWithDescriptor( xRequestedSizeBytes, xRemainingTime );
+
+            if( pxReturn != NULL )
+            {
+                pxReturn->xBulkQuota = pdTRUE;
+            }
+            else
+            {
+                ( void ) xSemaphoreGive( xBulkBufferSemaphore );
+            }
+        }
         else
         {
-            /* lint wants to see at least a comment. */
             iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER();
         }
-    }
 
-    return pxReturn;
-}
+        return pxReturn;
+    }
+#endif /* ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL */
 /*-----------------------------------------------------------*/
 
 NetworkBufferDescriptor_t * pxNetworkBufferGetFromISR( size_t xRequestedSizeBytes )
@@ -362,16 +1040,58 @@ BaseType_t vNetworkBufferReleaseFromISR( NetworkBufferDescriptor_t * const pxNet
 {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-    /* Ensure the buffer is returned to the list of free buffers before the
-     * counting semaphore is 'given' to say a buffer is available. */
-    ipconfigBUFFER_ALLOC_LOCK_FROM_ISR();
+    #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+        if( xNetworkBufferDropReferenceFromISR( pxNetworkBuffer ) == pdFALSE )
+        {
+            /* Another owner still uses the buffer, the last one releases it. */
+        }
+        else
+    #endif
     {
-        vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
-    }
-    ipconfigBUFFER_ALLOC_UNLOCK_FROM_ISR();
+        #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+        {
+            /* Hand back the memory that was attached to the frame. */
+            vNetworkBufferReleaseSegments( pxNetworkBuffer );
+        }
+        #endif
+
+        #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+        {
+            if( pxNetworkBuffer->xBulkQuota != pdFALSE )
+            {
+                /* Return the quota that was taken for bulk data. */
+                pxNetworkBuffer->xBulkQuota = pdFALSE;
+                ( void ) xSemaphoreGiveFromISR( xBulkBufferSemaphore, &xHigherPriorityTaskWoken );
+            }
+        }
+        #endif
+
+        #if ( ipconfigRX_COPY_BREAK != 0 )
+            if( prvIsSmallBuffer( pxNetworkBuffer ) != pdFALSE )
+            {
+                /* A small buffer is not counted in the semaphore. */
+                ipconfigBUFFER_ALLOC_LOCK_FROM_ISR();
+                {
+                    vListInsertEnd( &xFreeSmallBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+                }
+                ipconfigBUFFER_ALLOC_UNLOCK_FROM_ISR();
+            }
+            else
+        #endif /* ipconfigRX_COPY_BREAK != 0 */
+        {
+            /* Ensure the buffer is returned to the list of free buffers before the
+             * counting semaphore is 'given' to say a buffer is available. */
+            ipconfigBUFFER_ALLOC_LOCK_FROM_ISR();
+            {
+                vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+            }
+            ipconfigBUFFER_ALLOC_UNLOCK_FROM_ISR();
 
-    ( void ) xSemaphoreGiveFromISR( xNetworkBufferSemaphore, &xHigherPriorityTaskWoken );
-    iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+            ( void ) xSemaphoreGiveFromISR( xNetworkBufferSemaphore, &xHigherPriorityTaskWoken );
+        }
+
+        iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+    }
 
     return xHigherPriorityTaskWoken;
 }
@@ -379,42 +1099,236 @@ BaseType_t vNetworkBufferReleaseFromISR( NetworkBufferDescriptor_t * const pxNet
 
 void vReleaseNetworkBufferAndDescriptor( NetworkBufferDescriptor_t * const pxNetworkBuffer )
 {
-    BaseType_t xListItemAlreadyInFreeList;
+    #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE == 0 )
+        BaseType_t xListItemAlreadyInFreeList;
+    #endif
 
     if( bIsValidNetworkDescriptor( pxNetworkBuffer ) == pdFALSE_UNSIGNED )
     {
         FreeRTOS_debug_printf( ( "vReleaseNetworkBufferAndDescriptor: Invalid buffer %p\n", pxNetworkBuffer ) );
     }
+    #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+        else if( xNetworkBufferDropReference( pxNetworkBuffer ) == pdFALSE )
+        {
+            /* Another owner still uses the buffer, the last one releases it. */
+        }
+    #endif
     else
     {
-        /* Ensure the buffer is returned to the list of free buffers before the
-         * counting semaphore is 'given' to say a buffer is available. */
+        #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+        {
+            /* Hand back the memory that was attached to the frame. */
+            vNetworkBufferReleaseSegments( pxNetworkBuffer );
+        }
+        #endif
+
+        #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+        {
+            if( pxNetworkBuffer->xBulkQuota != pdFALSE )
+            {
+                /* Return the quota that was taken for bulk data. */
+                pxNetworkBuffer->xBulkQuota = pdFALSE;
+                ( void ) xSemaphoreGive( xBulkBufferSemaphore );
+            }
+        }
+        #endif
+
+        #if ( ipconfigRX_COPY_BREAK != 0 )
+            if( prvIsSmallBuffer( pxNetworkBuffer ) != pdFALSE )
+            {
+                /* A small buffer is not counted in the semaphore. */
+                prvSmallBufferRelease( pxNetworkBuffer );
+            }
+            else
+        #endif /* ipconfigRX_COPY_BREAK != 0 */
+        {
+            #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+            {
+                /* The cache of this core takes the buffer, and returns buffers
+                 * to xFreeBuffersList in batches. */
+                prvCacheRelease( pxNetworkBuffer );
+            }
+            #else
+            {
+                /* Ensure the buffer is returned to the list of free buffers before the
+                 * counting semaphore is 'given' to say a buffer is available. */
+                ipconfigBUFFER_ALLOC_LOCK();
+                {
+                    {
+                        xListItemAlreadyInFreeList = listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+
+                        if( xListItemAlreadyInFreeList == pdFALSE )
+                        {
+                            vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+                        }
+                    }
+                }
+                ipconfigBUFFER_ALLOC_UNLOCK();
+
+                if( xListItemAlreadyInFreeList )
+                {
+                    FreeRTOS_debug_printf( ( "vReleaseNetworkBufferAndDescriptor: %p ALREADY RELEASED (now %lu)\n",
+                                             pxNetworkBuffer, uxGetNumberOfFreeNetworkBuffers() ) );
+                }
+                else
+                {
+                    ( void ) xSemaphoreGive( xNetworkBufferSemaphore );
+                    prvShowWarnings();
+                }
+            }
+            #endif /* ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 */
+        }
+
+        iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release several network buffers at once.  The buffers are returned
+ *        to xFreeBuffersList in a single critical section, and the counting
+ *        semaphore is given with the scheduler suspended, so that a task that
+ *        waits for a buffer is woken up only once.
+ *
+ * @param[in,out] pxNetworkBuffers The buffers to be released.  NULL entries
+ *                                 are skipped, all entries are set to NULL.
+ * @param[in] uxCount The number of entries in 'pxNetworkBuffers'.
+ */
+void vReleaseNetworkBuffersAndDescriptors( NetworkBufferDescriptor_t * pxNetworkBuffers[],
+                                           size_t uxCount )
+{
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    size_t uxIndex;
+
+    #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE == 0 )
+        UBaseType_t uxReleased = 0U;
+        UBaseType_t uxAlreadyFree = 0U;
+    #endif
+
+    /* First do the work that is needed for every buffer, outside the
+     * critical section. */
+    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+    {
+        pxNetworkBuffer = pxNetworkBuffers[ uxIndex ];
+
+        if( pxNetworkBuffer == NULL )
+        {
+            /* Nothing to release. */
+        }
+        else if( bIsValidNetworkDescriptor( pxNetworkBuffer ) == pdFALSE_UNSIGNED )
+        {
+            FreeRTOS_debug_printf( ( "vReleaseNetworkBuffersAndDescriptors: Invalid buffer %p\n", pxNetworkBuffer ) );
+            pxNetworkBuffers[ uxIndex ] = NULL;
+        }
+        #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+            else if( xNetworkBufferDropReference( pxNetworkBuffer ) == pdFALSE )
+            {
+                /* Another owner still uses the buffer, the last one releases it. */
+                pxNetworkBuffers[ uxIndex ] = NULL;
+            }
+        #endif
+        else
+        {
+            #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+            {
+                /* Hand back the memory that was attached to the frame. */
+                vNetworkBufferReleaseSegments( pxNetworkBuffer );
+            }
+            #endif
+
+            #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+            {
+                if( pxNetworkBuffer->xBulkQuota != pdFALSE )
+                {
+                    /* Return the quota that was taken for bulk data. */
+                    pxNetworkBuffer->xBulkQuota = pdFALSE;
+                    ( void ) xSemaphoreGive( xBulkBufferSemaphore );
+                }
+            }
+            #endif
+
+            #if ( ipconfigRX_COPY_BREAK != 0 )
+            {
+                if( prvIsSmallBuffer( pxNetworkBuffer ) != pdFALSE )
+                {
+                    /* The small buffers have their own list. */
+                    prvSmallBufferRelease( pxNetworkBuffer );
+                    iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+                    pxNetworkBuffers[ uxIndex ] = NULL;
+                }
+            }
+            #endif
+
+            #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+            {
+                if( pxNetworkBuffers[ uxIndex ] != NULL )
+                {
+                    /* The cache already returns buffers to xFreeBuffersList in
+                     * batches. */
+                    prvCacheRelease( pxNetworkBuffer );
+                    iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+                    pxNetworkBuffers[ uxIndex ] = NULL;
+                }
+            }
+            #endif
+        }
+    }
+
+    #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE == 0 )
+    {
         ipconfigBUFFER_ALLOC_LOCK();
         {
+            for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
             {
-                xListItemAlreadyInFreeList = listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+                pxNetworkBuffer = pxNetworkBuffers[ uxIndex ];
 
-                if( xListItemAlreadyInFreeList == pdFALSE )
+                if( pxNetworkBuffer != NULL )
                 {
-                    vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+                    if( listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) ) == pdFALSE )
+                    {
+                        vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+                        uxReleased++;
+                    }
+                    else
+                    {
+                        uxAlreadyFree++;
+                    }
                 }
             }
         }
         ipconfigBUFFER_ALLOC_UNLOCK();
 
-        if( xListItemAlreadyInFreeList )
+        for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
         {
-            FreeRTOS_debug_printf( ( "vReleaseNetworkBufferAndDescriptor: %p ALREADY RELEASED (now %lu)\n",
-                                     pxNetworkBuffer, uxGetNumberOfFreeNetworkBuffers() ) );
+            if( pxNetworkBuffers[ uxIndex ] != NULL )
+            {
+                iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffers[ uxIndex ] );
+                pxNetworkBuffers[ uxIndex ] = NULL;
+            }
         }
-        else
+
+        if( uxAlreadyFree > 0U )
         {
-            ( void ) xSemaphoreGive( xNetworkBufferSemaphore );
-            prvShowWarnings();
+            FreeRTOS_debug_printf( ( "vReleaseNetworkBuffersAndDescriptors: %lu buffers ALREADY RELEASED (now %lu)\n",
+                                     uxAlreadyFree, uxGetNumberOfFreeNetworkBuffers() ) );
         }
 
-        iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+        if( uxReleased > 0U )
+        {
+            vTaskSuspendAll();
+            {
+                while( uxReleased > 0U )
+                {
+                    ( void ) xSemaphoreGive( xNetworkBufferSemaphore );
+                    uxReleased--;
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            prvShowWarnings();
+        }
     }
+    #endif /* ipconfigBUFFER_ALLOC_CACHE_SIZE == 0 */
 }
 /*-----------------------------------------------------------*/
 
@@ -426,17 +1340,76 @@ UBaseType_t uxGetMinimumFreeNetworkBuffers( void )
 
 UBaseType_t uxGetNumberOfFreeNetworkBuffers( void )
 {
-    return listCURRENT_LIST_LENGTH( &xFreeBuffersList );
+    UBaseType_t uxCount = listCURRENT_LIST_LENGTH( &xFreeBuffersList );
+
+    #if ( ipconfigBUFFER_ALLOC_CACHE_SIZE > 0 )
+    {
+        UBaseType_t uxCache;
+
+        /* The cached buffers are free as well. */
+        for( uxCache = 0U; uxCache < ( UBaseType_t ) baCACHE_COUNT; uxCache++ )
+        {
+            uxCount += listCURRENT_LIST_LENGTH( &( xBufferCaches[ uxCache ] ) );
+        }
+    }
+    #endif
+
+    return uxCount;
 }
 
 NetworkBufferDescriptor_t * pxResizeNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer,
                                                                  size_t xNewSizeBytes )
 {
+    NetworkBufferDescriptor_t * pxReturn = pxNetworkBuffer;
+
+    #if ( ipconfigRX_COPY_BREAK != 0 )
+    {
+        if( ( prvIsSmallBuffer( pxNetworkBuffer ) != pdFALSE ) && ( xNewSizeBytes > ( size_t ) ipconfigRX_COPY_BREAK ) )
+        {
+            /* A small buffer of pxNetworkBufferCopyBreak() must grow: it
+             * swaps storage with a full size buffer.  The descriptor itself
+             * stays with the caller. */
+            NetworkBufferDescriptor_t * pxLarge = pxGetNetworkBufferWithDescriptor( xNewSizeBytes, 0U );
+
+            if( pxLarge == NULL )
+            {
+                pxReturn = NULL;
+            }
+            else
+            {
+                uint8_t * pucSmall = pxNetworkBuffer->pucEthernetBuffer;
+
+                ( void ) memcpy( pxLarge->pucEthernetBuffer, pucSmall, pxNetworkBuffer->xDataLength );
+
+                pxNetworkBuffer->pucEthernetBuffer = pxLarge->pucEthernetBuffer;
+                pxLarge->pucEthernetBuffer = pucSmall;
+                prvSetBackPointer( pxNetworkBuffer );
+                prvSetBackPointer( pxLarge );
+
+                #if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 )
+                {
+                    pxNetworkBuffer->xCacheCleanNeeded = pxLarge->xCacheCleanNeeded;
+                    pxLarge->xCacheCleanNeeded = pdFALSE;
+                }
+                #endif
+
+                /* 'pxLarge' now owns the small storage, so it goes back to
+                 * the small list. */
+                vReleaseNetworkBufferAndDescriptor( pxLarge );
+            }
+        }
+    }
+    #endif /* ipconfigRX_COPY_BREAK != 0 */
+
     /* In BufferAllocation_1.c all network buffer are allocated with a
      * maximum size of 'ipTOTAL_ETHERNET_FRAME_SIZE'.No need to resize the
      * network buffer. */
-    pxNetworkBuffer->xDataLength = xNewSizeBytes;
-    return pxNetworkBuffer;
+    if( pxReturn != NULL )
+    {
+        pxReturn->xDataLength = xNewSizeBytes;
+    }
+
+    return pxReturn;
 }
 
 /*#endif */ /* ipconfigINCLUDE_TEST_CODE */
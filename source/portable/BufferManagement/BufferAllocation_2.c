@@ -67,6 +67,13 @@
 #define baALIGNMENT_MASK             ( baALIGNMENT_BYTES - 1U )
 #define baADD_WILL_OVERFLOW( a, b )    ( ( a ) > ( SIZE_MAX - ( b ) ) )
 
+#if ( ipconfigBUFFER_ALLOC_2_SIZE_CLASS > 0 )
+    /* The allocated size is stored in front of the padding. */
+    #define baCAPACITY_BYTES    ( sizeof( size_t ) )
+#else
+    #define baCAPACITY_BYTES    ( 0U )
+#endif
+
 STATIC_ASSERT( ipconfigETHERNET_MINIMUM_PACKET_BYTES <= baMINIMAL_BUFFER_SIZE );
 
 /* A list of free (available) NetworkBufferDescriptor_t structures. */
@@ -82,8 +89,68 @@ const BaseType_t xBufferAllocFixedSize = pdFALSE;
 /* The semaphore used to obtain network buffers. */
 static SemaphoreHandle_t xNetworkBufferSemaphore = NULL;
 
+#if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+    /* Counts the buffers that bulk data may still take, so that the reserved
+     * buffers stay available for control traffic. */
+    static SemaphoreHandle_t xBulkBufferSemaphore = NULL;
+#endif
+
+#if ( ipconfigBUFFER_ALLOC_2_SIZE_CLASS > 0 )
+
+/*
+ * Round a buffer size up to a multiple of ipconfigBUFFER_ALLOC_2_SIZE_CLASS.
+ * Returns pdTRUE if the size would overflow.
+ */
+    static BaseType_t prvRoundUpToSizeClass( size_t * pxSize );
+
+/*
+ * Return the number of bytes that were allocated for an Ethernet buffer.
+ */
+    static size_t prvGetCapacity( const uint8_t * pucEthernetBuffer );
+#endif
+
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigBUFFER_ALLOC_2_SIZE_CLASS > 0 )
+    static BaseType_t prvRoundUpToSizeClass( size_t * pxSize )
+    {
+        BaseType_t xOverflowed = pdFALSE;
+        size_t uxRemainder = *pxSize % ( size_t ) ipconfigBUFFER_ALLOC_2_SIZE_CLASS;
+        size_t uxExtra;
+
+        if( uxRemainder != 0U )
+        {
+            uxExtra = ( size_t ) ipconfigBUFFER_ALLOC_2_SIZE_CLASS - uxRemainder;
+
+            if( baADD_WILL_OVERFLOW( *pxSize, uxExtra ) )
+            {
+                xOverflowed = pdTRUE;
+            }
+            else
+            {
+                *pxSize += uxExtra;
+            }
+        }
+
+        return xOverflowed;
+    }
+    /*-----------------------------------------------------------*/
+
+    static size_t prvGetCapacity( const uint8_t * pucEthernetBuffer )
+    {
+        /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+        /* coverity[misra_c_2012_rule_18_4_violation] */
+        const uint8_t * pucStart = pucEthernetBuffer - ( ipBUFFER_PADDING + baCAPACITY_BYTES );
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        return *( ( const size_t * ) pucStart );
+    }
+    /*-----------------------------------------------------------*/
+#endif /* ipconfigBUFFER_ALLOC_2_SIZE_CLASS > 0 */
+
 BaseType_t xNetworkBuffersInitialise( void )
 {
     /* Declares the pool of NetworkBufferDescriptor_t structures that are available
@@ -115,6 +182,27 @@ BaseType_t xNetworkBuffersInitialise( void )
 
         configASSERT( xNetworkBufferSemaphore != NULL );
 
+        #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+        {
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                static StaticSemaphore_t xBulkBufferSemaphoreBuffer;
+                xBulkBufferSemaphore = xSemaphoreCreateCountingStatic(
+                    ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ),
+                    ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ),
+                    &xBulkBufferSemaphoreBuffer );
+            }
+            #else
+            {
+                xBulkBufferSemaphore = xSemaphoreCreateCounting( ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ),
+                                                                 ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ) );
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            configASSERT( xBulkBufferSemaphore != NULL );
+        }
+        #endif /* ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL */
+
         if( xNetworkBufferSemaphore != NULL )
         {
             #if ( configQUEUE_REGISTRY_SIZE > 0 )
@@ -196,9 +284,19 @@ uint8_t * pucGetNetworkBuffer( size_t * pxRequestedSizeBytes )
         }
     }
 
-    if( baADD_WILL_OVERFLOW( xSize, ipBUFFER_PADDING ) == pdFAIL )
+    #if ( ipconfigBUFFER_ALLOC_2_SIZE_CLASS > 0 )
     {
-        xAllocatedBytes = xSize + ipBUFFER_PADDING;
+        /* Take the whole size class, so the buffer can grow in place. */
+        if( prvRoundUpToSizeClass( &xSize ) != pdFALSE )
+        {
+            xIntegerOverflowed = pdTRUE;
+        }
+    }
+    #endif
+
+    if( baADD_WILL_OVERFLOW( xSize, ipBUFFER_PADDING + baCAPACITY_BYTES ) == pdFAIL )
+    {
+        xAllocatedBytes = xSize + ipBUFFER_PADDING + baCAPACITY_BYTES;
     }
     else
     {
@@ -221,10 +319,19 @@ uint8_t * pucGetNetworkBuffer( size_t * pxRequestedSizeBytes )
              * the network buffer structure that references this Ethernet buffer.
              * Return a pointer to the start of the Ethernet buffer itself. */
 
+            #if ( ipconfigBUFFER_ALLOC_2_SIZE_CLASS > 0 )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                *( ( size_t * ) pucEthernetBuffer ) = xSize;
+            }
+            #endif
+
             /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
             /* coverity[misra_c_2012_rule_18_4_violation] */
-            pucEthernetBuffer += ipBUFFER_PADDING;
+            pucEthernetBuffer += ipBUFFER_PADDING + baCAPACITY_BYTES;
         }
     }
 
@@ -244,7 +351,7 @@ void vReleaseNetworkBuffer( uint8_t * pucEthernetBuffer )
         /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
         /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
         /* coverity[misra_c_2012_rule_18_4_violation] */
-        pucEthernetBufferCopy -= ipBUFFER_PADDING;
+        pucEthernetBufferCopy -= ipBUFFER_PADDING + baCAPACITY_BYTES;
         vPortFree( ( void * ) pucEthernetBufferCopy );
     }
 }
@@ -258,6 +365,7 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
     size_t uxMaxAllowedBytes = ( SIZE_MAX >> 1 );
     size_t xRequestedSizeBytesCopy = xRequestedSizeBytes;
     size_t xBytesRequiredForAlignment, xAllocatedBytes;
+    size_t xCapacity;
     BaseType_t xIntegerOverflowed = pdFALSE;
 
     if( ( xRequestedSizeBytesCopy < ( size_t ) baMINIMAL_BUFFER_SIZE ) )
@@ -292,9 +400,21 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
         }
     }
 
-    if( baADD_WILL_OVERFLOW( xRequestedSizeBytesCopy, ipBUFFER_PADDING ) == pdFAIL )
+    xCapacity = xRequestedSizeBytesCopy;
+
+    #if ( ipconfigBUFFER_ALLOC_2_SIZE_CLASS > 0 )
+    {
+        /* Take the whole size class, so the buffer can grow in place. */
+        if( prvRoundUpToSizeClass( &xCapacity ) != pdFALSE )
+        {
+            xIntegerOverflowed = pdTRUE;
+        }
+    }
+    #endif
+
+    if( baADD_WILL_OVERFLOW( xCapacity, ipBUFFER_PADDING + baCAPACITY_BYTES ) == pdFAIL )
     {
-        xAllocatedBytes = xRequestedSizeBytesCopy + ipBUFFER_PADDING;
+        xAllocatedBytes = xCapacity + ipBUFFER_PADDING + baCAPACITY_BYTES;
     }
     else
     {
@@ -345,6 +465,20 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
                      * buffer storage area, then move the buffer pointer on past the
                      * stored pointer so the pointer value is not overwritten by the
                      * application when the buffer is used. */
+                    #if ( ipconfigBUFFER_ALLOC_2_SIZE_CLASS > 0 )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        *( ( size_t * ) ( pxReturn->pucEthernetBuffer ) ) = xCapacity;
+
+                        /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+                        /* coverity[misra_c_2012_rule_18_4_violation] */
+                        pxReturn->pucEthernetBuffer += baCAPACITY_BYTES;
+                    }
+                    #endif
+
                     /* MISRA Ref 11.3.1 [Misaligned access] */
                     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
                     /* coverity[misra_c_2012_rule_11_3_violation] */
@@ -361,12 +495,40 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
                     pxReturn->pxInterface = NULL;
                     pxReturn->pxEndPoint = NULL;
 
-                    #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+                    /* make sure the buffer is not linked */
+                    pxReturn->pxNextBuffer = NULL;
+
+                    #if ( ipconfigUSE_TCP_TSO != 0 )
+                    {
+                        pxReturn->usTCPSegmentSize = 0U;
+                    }
+                    #endif
+
+                    #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+                    {
+                        pxReturn->ucChecksumFlags = 0U;
+                    }
+                    #endif
+
+                    #if ( ipconfigUSE_VLAN != 0 )
+                    {
+                        pxReturn->usVLANTag = 0U;
+                    }
+                    #endif
+
+                    #if ( ipconfigUSE_PACKET_METADATA != 0 )
+                    {
+                        pxReturn->xMetadata.ucValid = pdFALSE_UNSIGNED;
+                    }
+                    #endif
+
+                    #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
                     {
-                        /* make sure the buffer is not linked */
-                        pxReturn->pxNextBuffer = NULL;
+                        pxReturn->xTimestamp.ulSeconds = 0U;
+                        pxReturn->xTimestamp.ulNanoseconds = 0U;
+                        pxReturn->ucTxTimestamp = pdFALSE_UNSIGNED;
                     }
-                    #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+                    #endif
                 }
             }
             else
@@ -380,6 +542,7 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
     if( pxReturn == NULL )
     {
         iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER();
+        ipRESOURCE_SHORTAGE( eShortageNetworkBuffers );
     }
     else
     {
@@ -391,45 +554,216 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+
+/* Obtain a network buffer for application data. Such buffers are counted
+ * against xBulkBufferSemaphore first, so that ARP, DHCP and TCP control
+ * packets can always get one of the reserved buffers. */
+    NetworkBufferDescriptor_t * pxGetBulkNetworkBufferWithDescriptor( size_t xRequestedSizeBytes,
+                                                                      TickType_t xBlockTimeTicks )
+    {
+        NetworkBufferDescriptor_t * pxReturn = NULL;
+        TimeOut_t xTimeOut;
+        TickType_t xRemainingTime = xBlockTimeTicks;
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        if( ( xBulkBufferSemaphore != NULL ) &&
+            ( xSemaphoreTake( xBulkBufferSemaphore, xBlockTimeTicks ) == pdPASS ) )
+        {
+            /* Only wait for the time that is left. */
+            ( void ) xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime );
+
+            pxReturn = pxGetNetworkBufferWithDescriptor( xRequestedSizeBytes, xRemainingTime );
+
+            if( pxReturn != NULL )
+            {
+                pxReturn->xBulkQuota = pdTRUE;
+            }
+            else
+            {
+                ( void ) xSemaphoreGive( xBulkBufferSemaphore );
+            }
+        }
+        else
+        {
+            iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER();
+        }
+
+        return pxReturn;
+    }
+#endif /* ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL */
+/*-----------------------------------------------------------*/
+
 void vReleaseNetworkBufferAndDescriptor( NetworkBufferDescriptor_t * const pxNetworkBuffer )
 {
     BaseType_t xListItemAlreadyInFreeList;
 
-    /* Ensure the buffer is returned to the list of free buffers before the
-    * counting semaphore is 'given' to say a buffer is available.  Release the
-    * storage allocated to the buffer payload.  THIS FILE SHOULD NOT BE USED
-    * IF THE PROJECT INCLUDES A MEMORY ALLOCATOR THAT WILL FRAGMENT THE HEAP
-    * MEMORY.  For example, heap_2 must not be used, heap_4 can be used. */
-    vReleaseNetworkBuffer( pxNetworkBuffer->pucEthernetBuffer );
-    pxNetworkBuffer->pucEthernetBuffer = NULL;
-    pxNetworkBuffer->xDataLength = 0U;
-
-    taskENTER_CRITICAL();
+    #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+        if( xNetworkBufferDropReference( pxNetworkBuffer ) == pdFALSE )
+        {
+            /* Another owner still uses the buffer, the last one releases it. */
+        }
+        else
+    #endif
     {
-        xListItemAlreadyInFreeList = listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+        #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+        {
+            /* Hand back the memory that was attached to the frame. */
+            vNetworkBufferReleaseSegments( pxNetworkBuffer );
+        }
+        #endif
+
+        #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+        {
+            if( pxNetworkBuffer->xBulkQuota != pdFALSE )
+            {
+                /* Return the quota that was taken for bulk data. */
+                pxNetworkBuffer->xBulkQuota = pdFALSE;
+                ( void ) xSemaphoreGive( xBulkBufferSemaphore );
+            }
+        }
+        #endif
+
+        /* Ensure the buffer is returned to the list of free buffers before the
+        * counting semaphore is 'given' to say a buffer is available.  Release the
+        * storage allocated to the buffer payload.  THIS FILE SHOULD NOT BE USED
+        * IF THE PROJECT INCLUDES A MEMORY ALLOCATOR THAT WILL FRAGMENT THE HEAP
+        * MEMORY.  For example, heap_2 must not be used, heap_4 can be used. */
+        vReleaseNetworkBuffer( pxNetworkBuffer->pucEthernetBuffer );
+        pxNetworkBuffer->pucEthernetBuffer = NULL;
+        pxNetworkBuffer->xDataLength = 0U;
+
+        taskENTER_CRITICAL();
+        {
+            xListItemAlreadyInFreeList = listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
 
+            if( xListItemAlreadyInFreeList == pdFALSE )
+            {
+                vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /*
+         * Update the network state machine, unless the program fails to release its 'xNetworkBufferSemaphore'.
+         * The program should only try to release its semaphore if 'xListItemAlreadyInFreeList' is false.
+         */
         if( xListItemAlreadyInFreeList == pdFALSE )
         {
-            vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+            if( xSemaphoreGive( xNetworkBufferSemaphore ) == pdTRUE )
+            {
+                iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+            }
+        }
+        else
+        {
+            /* No action. */
+            iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release several network buffers at once.  The descriptors are
+ *        returned to xFreeBuffersList in a single critical section, and the
+ *        counting semaphore is given with the scheduler suspended, so that a
+ *        task that waits for a buffer is woken up only once.
+ *
+ * @param[in,out] pxNetworkBuffers The buffers to be released.  NULL entries
+ *                                 are skipped, all entries are set to NULL.
+ * @param[in] uxCount The number of entries in 'pxNetworkBuffers'.
+ */
+void vReleaseNetworkBuffersAndDescriptors( NetworkBufferDescriptor_t * pxNetworkBuffers[],
+                                           size_t uxCount )
+{
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    size_t uxIndex;
+    UBaseType_t uxReleased = 0U;
+
+    /* First do the work that is needed for every buffer, outside the
+     * critical section. */
+    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+    {
+        pxNetworkBuffer = pxNetworkBuffers[ uxIndex ];
+
+        if( pxNetworkBuffer == NULL )
+        {
+            /* Nothing to release. */
+        }
+        #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+            else if( xNetworkBufferDropReference( pxNetworkBuffer ) == pdFALSE )
+            {
+                /* Another owner still uses the buffer, the last one releases it. */
+                pxNetworkBuffers[ uxIndex ] = NULL;
+            }
+        #endif
+        else
+        {
+            #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+            {
+                /* Hand back the memory that was attached to the frame. */
+                vNetworkBufferReleaseSegments( pxNetworkBuffer );
+            }
+            #endif
+
+            #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+            {
+                if( pxNetworkBuffer->xBulkQuota != pdFALSE )
+                {
+                    /* Return the quota that was taken for bulk data. */
+                    pxNetworkBuffer->xBulkQuota = pdFALSE;
+                    ( void ) xSemaphoreGive( xBulkBufferSemaphore );
+                }
+            }
+            #endif
+
+            vReleaseNetworkBuffer( pxNetworkBuffer->pucEthernetBuffer );
+            pxNetworkBuffer->pucEthernetBuffer = NULL;
+            pxNetworkBuffer->xDataLength = 0U;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    {
+        for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+        {
+            pxNetworkBuffer = pxNetworkBuffers[ uxIndex ];
+
+            if( pxNetworkBuffer != NULL )
+            {
+                /* A buffer that was released twice is not counted twice. */
+                if( listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) ) == pdFALSE )
+                {
+                    vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+                    uxReleased++;
+                }
+            }
         }
     }
     taskEXIT_CRITICAL();
 
-    /*
-     * Update the network state machine, unless the program fails to release its 'xNetworkBufferSemaphore'.
-     * The program should only try to release its semaphore if 'xListItemAlreadyInFreeList' is false.
-     */
-    if( xListItemAlreadyInFreeList == pdFALSE )
+    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
     {
-        if( xSemaphoreGive( xNetworkBufferSemaphore ) == pdTRUE )
+        if( pxNetworkBuffers[ uxIndex ] != NULL )
         {
-            iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+            iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffers[ uxIndex ] );
+            pxNetworkBuffers[ uxIndex ] = NULL;
         }
     }
-    else
+
+    if( uxReleased > 0U )
     {
-        /* No action. */
-        iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+        vTaskSuspendAll();
+        {
+            while( uxReleased > 0U )
+            {
+                ( void ) xSemaphoreGive( xNetworkBufferSemaphore );
+                uxReleased--;
+            }
+        }
+        ( void ) xTaskResumeAll();
     }
 }
 /*-----------------------------------------------------------*/
@@ -449,6 +783,47 @@ UBaseType_t uxGetMinimumFreeNetworkBuffers( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigRX_COPY_BREAK != 0 )
+
+/**
+ * @brief Copy a small received frame to a buffer of its own size, so that
+ *        the driver can give its large buffer back to the DMA at once.
+ *
+ * @param[in] pxNetworkBuffer The buffer that received the frame.
+ *
+ * @return The copy, or NULL when the frame is longer than ipconfigRX_COPY_BREAK
+ *         or when no memory is available.
+ */
+    NetworkBufferDescriptor_t * pxNetworkBufferCopyBreak( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkBufferDescriptor_t * pxReturn = NULL;
+
+        if( pxNetworkBuffer->xDataLength <= ( size_t ) ipconfigRX_COPY_BREAK )
+        {
+            pxReturn = pxDuplicateNetworkBufferWithDescriptor( pxNetworkBuffer, pxNetworkBuffer->xDataLength );
+        }
+
+        return pxReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a network buffer can hold a full frame.
+ *
+ * @param[in] pxNetworkBuffer The buffer, or NULL for a new buffer.
+ *
+ * @return Always pdFALSE, the buffers of this module are as large as asked.
+ */
+    BaseType_t xIsFixedSizeNetworkBuffer( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        ( void ) pxNetworkBuffer;
+
+        return pdFALSE;
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ipconfigRX_COPY_BREAK != 0 */
+
 NetworkBufferDescriptor_t * pxResizeNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer,
                                                                  size_t xNewSizeBytes )
 {
@@ -456,10 +831,27 @@ NetworkBufferDescriptor_t * pxResizeNetworkBufferWithDescriptor( NetworkBufferDe
     uint8_t * pucBuffer;
     size_t uxSizeBytes = xNewSizeBytes;
     NetworkBufferDescriptor_t * pxNetworkBufferCopy = pxNetworkBuffer;
+    BaseType_t xGrownInPlace = pdFALSE;
 
     xOriginalLength = pxNetworkBufferCopy->xDataLength + ipBUFFER_PADDING;
 
-    if( baADD_WILL_OVERFLOW( uxSizeBytes, ipBUFFER_PADDING ) == pdFAIL )
+    #if ( ipconfigBUFFER_ALLOC_2_SIZE_CLASS > 0 )
+    {
+        if( ( pxNetworkBufferCopy->pucEthernetBuffer != NULL ) &&
+            ( uxSizeBytes <= prvGetCapacity( pxNetworkBufferCopy->pucEthernetBuffer ) ) )
+        {
+            /* The new size still fits in the size class of the buffer. */
+            pxNetworkBufferCopy->xDataLength = uxSizeBytes;
+            xGrownInPlace = pdTRUE;
+        }
+    }
+    #endif
+
+    if( xGrownInPlace != pdFALSE )
+    {
+        /* No allocation and no copy needed. */
+    }
+    else if( baADD_WILL_OVERFLOW( uxSizeBytes, ipBUFFER_PADDING ) == pdFAIL )
     {
         uxSizeBytes = uxSizeBytes + ipBUFFER_PADDING;
 
@@ -0,0 +1,883 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/******************************************************************************
+*
+* See the following web page for essential buffer allocation scheme usage and
+* configuration details:
+* https://freertos.org/Documentation/03-Libraries/02-FreeRTOS-plus/02-FreeRTOS-plus-TCP/05-Buffer-management
+*
+******************************************************************************/
+
+/* This scheme sits between BufferAllocation_1.c and BufferAllocation_2.c.
+ * Like BufferAllocation_2.c it gives network buffers of a variable size, but
+ * it never calls pvPortMalloc().  The storage comes from three static arenas
+ * ( small, medium and large ) of fixed-size blocks, see
+ * ipconfigBUFFER_ALLOC_3_SMALL_SIZE and friends.  Each arena has a free list,
+ * so obtaining and releasing a block takes a constant time and the heap can
+ * not get fragmented. */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_UDP_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "NetworkInterface.h"
+#include "NetworkBufferManagement.h"
+
+/* The obtained network buffer must be large enough to hold a packet that might
+ * replace the packet that was requested to be sent. */
+#if ipconfigUSE_TCP == 1
+    #define baMINIMAL_BUFFER_SIZE    sizeof( TCPPacket_t )
+#else
+    #define baMINIMAL_BUFFER_SIZE    sizeof( ARPPacket_t )
+#endif /* ipconfigUSE_TCP == 1 */
+
+#define baALIGNMENT_BYTES            ( sizeof( size_t ) )
+#define baALIGNMENT_MASK             ( baALIGNMENT_BYTES - 1U )
+#define baADD_WILL_OVERFLOW( a, b )    ( ( a ) > ( SIZE_MAX - ( b ) ) )
+
+/* The number of bytes that a block of a given payload size occupies: the
+ * padding in front of the Ethernet buffer plus the payload, rounded up so that
+ * every block in an arena stays aligned. */
+#define baBLOCK_STRIDE( xSize ) \
+    ( ( ( size_t ) ipBUFFER_PADDING + ( size_t ) ( xSize ) + baALIGNMENT_MASK ) & ~baALIGNMENT_MASK )
+
+#define baSMALL_STRIDE     baBLOCK_STRIDE( ipconfigBUFFER_ALLOC_3_SMALL_SIZE )
+#define baMEDIUM_STRIDE    baBLOCK_STRIDE( ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE )
+#define baLARGE_STRIDE     baBLOCK_STRIDE( ipTOTAL_ETHERNET_FRAME_SIZE )
+
+#define baCLASS_COUNT      ( 3 )
+
+STATIC_ASSERT( ipconfigETHERNET_MINIMUM_PACKET_BYTES <= baMINIMAL_BUFFER_SIZE );
+STATIC_ASSERT( ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE < ipTOTAL_ETHERNET_FRAME_SIZE );
+
+/** @brief The administration of one arena of fixed-size blocks. */
+typedef struct xBUFFER_SIZE_CLASS
+{
+    uint8_t * pucArena;    /**< The first block of the arena. */
+    size_t uxStride;       /**< The distance between two blocks. */
+    size_t uxCapacity;     /**< The payload size of a block: uxStride minus ipBUFFER_PADDING. */
+    size_t uxBlockCount;   /**< The number of blocks in the arena. */
+    uint8_t * pucFreeList; /**< The first free block, every free block points to the next one. */
+    size_t uxFreeCount;    /**< The number of blocks in the free list. */
+} BufferSizeClass_t;
+
+/* The arenas.  They are declared as arrays of size_t to get the alignment of
+ * baALIGNMENT_BYTES. */
+static size_t uxSmallArena[ ( baSMALL_STRIDE * ( size_t ) ipconfigBUFFER_ALLOC_3_SMALL_COUNT ) / sizeof( size_t ) ];
+static size_t uxMediumArena[ ( baMEDIUM_STRIDE * ( size_t ) ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT ) / sizeof( size_t ) ];
+static size_t uxLargeArena[ ( baLARGE_STRIDE * ( size_t ) ipconfigBUFFER_ALLOC_3_LARGE_COUNT ) / sizeof( size_t ) ];
+
+/* The size classes, from small to large. */
+static BufferSizeClass_t xSizeClasses[ baCLASS_COUNT ];
+
+/* A list of free (available) NetworkBufferDescriptor_t structures. */
+static List_t xFreeBuffersList;
+
+/* Some statistics about the use of buffers. */
+static size_t uxMinimumFreeNetworkBuffers;
+
+/* This constant is defined as false to let FreeRTOS_TCP_IP.c know that the
+ * network buffers have a variable size: resizing may be necessary */
+const BaseType_t xBufferAllocFixedSize = pdFALSE;
+
+/* The semaphore used to obtain network buffers. */
+static SemaphoreHandle_t xNetworkBufferSemaphore = NULL;
+
+#if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+    /* Counts the buffers that bulk data may still take, so that the reserved
+     * buffers stay available for control traffic. */
+    static SemaphoreHandle_t xBulkBufferSemaphore = NULL;
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise the free list of one size class.
+ */
+static void prvInitialiseSizeClass( BufferSizeClass_t * pxClass,
+                                    uint8_t * pucArena,
+                                    size_t uxStride,
+                                    size_t uxBlockCount );
+
+/*
+ * Take a block from the smallest class that fits the size and has a free
+ * block.  Returns a pointer to the start of the block, or NULL.
+ */
+static uint8_t * prvTakeBlock( size_t uxSizeBytes );
+
+/*
+ * Look up the size class that owns a block.  Returns NULL when the pointer
+ * does not point into one of the arenas.
+ */
+static BufferSizeClass_t * prvFindSizeClass( const uint8_t * pucBlock );
+
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseSizeClass( BufferSizeClass_t * pxClass,
+                                    uint8_t * pucArena,
+                                    size_t uxStride,
+                                    size_t uxBlockCount )
+{
+    size_t uxIndex;
+    uint8_t * pucBlock;
+    uint8_t * pucNext;
+
+    pxClass->pucArena = pucArena;
+    pxClass->uxStride = uxStride;
+    pxClass->uxCapacity = uxStride - ( size_t ) ipBUFFER_PADDING;
+    pxClass->uxBlockCount = uxBlockCount;
+    pxClass->uxFreeCount = uxBlockCount;
+    pxClass->pucFreeList = pucArena;
+
+    /* Chain all blocks, the link is stored in the first bytes of a free
+     * block.  The last block has a NULL link. */
+    for( uxIndex = 0U; uxIndex < uxBlockCount; uxIndex++ )
+    {
+        pucBlock = &( pucArena[ uxIndex * uxStride ] );
+        pucNext = ( ( uxIndex + 1U ) < uxBlockCount ) ? &( pucBlock[ uxStride ] ) : NULL;
+        ( void ) memcpy( ( void * ) pucBlock, ( const void * ) &pucNext, sizeof( pucNext ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t * prvTakeBlock( size_t uxSizeBytes )
+{
+    uint8_t * pucReturn = NULL;
+    BufferSizeClass_t * pxClass;
+    BaseType_t xIndex;
+
+    taskENTER_CRITICAL();
+    {
+        /* Try the smallest class that fits first.  When it is exhausted, a
+         * larger block is used rather than failing the request. */
+        for( xIndex = 0; xIndex < baCLASS_COUNT; xIndex++ )
+        {
+            pxClass = &( xSizeClasses[ xIndex ] );
+
+            if( ( pxClass->uxCapacity >= uxSizeBytes ) && ( pxClass->pucFreeList != NULL ) )
+            {
+                pucReturn = pxClass->pucFreeList;
+                ( void ) memcpy( ( void * ) &( pxClass->pucFreeList ), ( const void * ) pucReturn, sizeof( pxClass->pucFreeList ) );
+                pxClass->uxFreeCount--;
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return pucReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BufferSizeClass_t * prvFindSizeClass( const uint8_t * pucBlock )
+{
+    BufferSizeClass_t * pxReturn = NULL;
+    BaseType_t xIndex;
+    uintptr_t uxAddress = ( uintptr_t ) pucBlock;
+    uintptr_t uxStart;
+
+    for( xIndex = 0; xIndex < baCLASS_COUNT; xIndex++ )
+    {
+        uxStart = ( uintptr_t ) xSizeClasses[ xIndex ].pucArena;
+
+        if( ( uxAddress >= uxStart ) &&
+            ( ( uxAddress - uxStart ) < ( xSizeClasses[ xIndex ].uxStride * xSizeClasses[ xIndex ].uxBlockCount ) ) )
+        {
+            /* The pointer must point to the start of a block. */
+            if( ( ( uxAddress - uxStart ) % xSizeClasses[ xIndex ].uxStride ) == 0U )
+            {
+                pxReturn = &( xSizeClasses[ xIndex ] );
+            }
+
+            break;
+        }
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkBuffersInitialise( void )
+{
+    /* Declares the pool of NetworkBufferDescriptor_t structures that are available
+     * to the system.  All the network buffers referenced from xFreeBuffersList exist
+     * in this array.  The array is not accessed directly except during initialisation,
+     * when the xFreeBuffersList is filled (as all the buffers are free when the system
+     * is booted). */
+    static NetworkBufferDescriptor_t xNetworkBufferDescriptors[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ];
+    BaseType_t xReturn;
+    uint32_t x;
+
+    /* Only initialise the buffers and their associated kernel objects if they
+     * have not been initialised before. */
+    if( xNetworkBufferSemaphore == NULL )
+    {
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            static StaticSemaphore_t xNetworkBufferSemaphoreBuffer;
+            xNetworkBufferSemaphore = xSemaphoreCreateCountingStatic(
+                ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS,
+                ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS,
+                &xNetworkBufferSemaphoreBuffer );
+        }
+        #else
+        {
+            xNetworkBufferSemaphore = xSemaphoreCreateCounting( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS, ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS );
+        }
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+        configASSERT( xNetworkBufferSemaphore != NULL );
+
+        #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+        {
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                static StaticSemaphore_t xBulkBufferSemaphoreBuffer;
+                xBulkBufferSemaphore = xSemaphoreCreateCountingStatic(
+                    ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ),
+                    ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ),
+                    &xBulkBufferSemaphoreBuffer );
+            }
+            #else
+            {
+                xBulkBufferSemaphore = xSemaphoreCreateCounting( ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ),
+                                                                 ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL ) );
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            configASSERT( xBulkBufferSemaphore != NULL );
+        }
+        #endif /* ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL */
+
+        if( xNetworkBufferSemaphore != NULL )
+        {
+            #if ( configQUEUE_REGISTRY_SIZE > 0 )
+            {
+                vQueueAddToRegistry( xNetworkBufferSemaphore, "NetBufSem" );
+            }
+            #endif /* configQUEUE_REGISTRY_SIZE */
+
+            /* If the trace recorder code is included name the semaphore for viewing
+             * in FreeRTOS+Trace.  */
+            #if ( ipconfigINCLUDE_EXAMPLE_FREERTOS_PLUS_TRACE_CALLS == 1 )
+            {
+                extern QueueHandle_t xNetworkEventQueue;
+                vTraceSetQueueName( xNetworkEventQueue, "IPStackEvent" );
+                vTraceSetQueueName( xNetworkBufferSemaphore, "NetworkBufferCount" );
+            }
+            #endif /*  ipconfigINCLUDE_EXAMPLE_FREERTOS_PLUS_TRACE_CALLS == 1 */
+
+            prvInitialiseSizeClass( &( xSizeClasses[ 0 ] ), ( uint8_t * ) uxSmallArena,
+                                    baSMALL_STRIDE, ( size_t ) ipconfigBUFFER_ALLOC_3_SMALL_COUNT );
+            prvInitialiseSizeClass( &( xSizeClasses[ 1 ] ), ( uint8_t * ) uxMediumArena,
+                                    baMEDIUM_STRIDE, ( size_t ) ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT );
+            prvInitialiseSizeClass( &( xSizeClasses[ 2 ] ), ( uint8_t * ) uxLargeArena,
+                                    baLARGE_STRIDE, ( size_t ) ipconfigBUFFER_ALLOC_3_LARGE_COUNT );
+
+            vListInitialise( &xFreeBuffersList );
+
+            /* Initialise all the network buffers.  No storage is assigned to
+             * the buffers yet. */
+            for( x = 0U; x < ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS; x++ )
+            {
+                /* Initialise and set the owner of the buffer list items. */
+                xNetworkBufferDescriptors[ x ].pucEthernetBuffer = NULL;
+                vListInitialiseItem( &( xNetworkBufferDescriptors[ x ].xBufferListItem ) );
+                listSET_LIST_ITEM_OWNER( &( xNetworkBufferDescriptors[ x ].xBufferListItem ), &xNetworkBufferDescriptors[ x ] );
+
+                /* Currently, all buffers are available for use. */
+                vListInsert( &xFreeBuffersList, &( xNetworkBufferDescriptors[ x ].xBufferListItem ) );
+            }
+
+            uxMinimumFreeNetworkBuffers = ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS;
+        }
+    }
+
+    if( xNetworkBufferSemaphore == NULL )
+    {
+        xReturn = pdFAIL;
+    }
+    else
+    {
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint8_t * pucGetNetworkBuffer( size_t * pxRequestedSizeBytes )
+{
+    uint8_t * pucEthernetBuffer = NULL;
+    size_t xSize = *pxRequestedSizeBytes;
+
+    if( xSize < baMINIMAL_BUFFER_SIZE )
+    {
+        /* Buffers must be at least large enough to hold a TCP-packet with
+         * headers, or an ARP packet, in case TCP is not included. */
+        xSize = baMINIMAL_BUFFER_SIZE;
+    }
+
+    /* Round up xSize to the nearest multiple of N bytes,
+     * where N equals 'sizeof( size_t )'.  A larger size would not fit in
+     * any block. */
+    if( baADD_WILL_OVERFLOW( xSize, baALIGNMENT_MASK ) == pdFAIL )
+    {
+        xSize = ( xSize + baALIGNMENT_MASK ) & ~baALIGNMENT_MASK;
+        pucEthernetBuffer = prvTakeBlock( xSize );
+    }
+
+    if( pucEthernetBuffer != NULL )
+    {
+        *pxRequestedSizeBytes = xSize;
+
+        /* Enough space is left at the start of the block to place a pointer to
+         * the network buffer structure that references this Ethernet buffer.
+         * Return a pointer to the start of the Ethernet buffer itself. */
+
+        /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+        /* coverity[misra_c_2012_rule_18_4_violation] */
+        pucEthernetBuffer += ipBUFFER_PADDING;
+    }
+
+    return pucEthernetBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vReleaseNetworkBuffer( uint8_t * pucEthernetBuffer )
+{
+    uint8_t * pucBlock = pucEthernetBuffer;
+    BufferSizeClass_t * pxClass;
+
+    if( pucBlock != NULL )
+    {
+        /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+        /* coverity[misra_c_2012_rule_18_4_violation] */
+        pucBlock -= ipBUFFER_PADDING;
+        pxClass = prvFindSizeClass( pucBlock );
+
+        configASSERT( pxClass != NULL );
+
+        if( pxClass != NULL )
+        {
+            taskENTER_CRITICAL();
+            {
+                ( void ) memcpy( ( void * ) pucBlock, ( const void * ) &( pxClass->pucFreeList ), sizeof( pxClass->pucFreeList ) );
+                pxClass->pucFreeList = pucBlock;
+                pxClass->uxFreeCount++;
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedSizeBytes,
+                                                              TickType_t xBlockTimeTicks )
+{
+    NetworkBufferDescriptor_t * pxReturn = NULL;
+    size_t uxCount;
+    size_t xRequestedSizeBytesCopy = xRequestedSizeBytes;
+    BaseType_t xIntegerOverflowed = pdFALSE;
+    uint8_t * pucBuffer;
+
+    /* Add 2 bytes to xRequestedSizeBytesCopy, like BufferAllocation_2.c does.
+     * The minimum size and the alignment are applied by
+     * pucGetNetworkBuffer(). */
+    if( baADD_WILL_OVERFLOW( xRequestedSizeBytesCopy, 2U ) == pdFAIL )
+    {
+        xRequestedSizeBytesCopy += 2U;
+    }
+    else
+    {
+        xIntegerOverflowed = pdTRUE;
+    }
+
+    if( ( xIntegerOverflowed == pdFALSE ) && ( xNetworkBufferSemaphore != NULL ) )
+    {
+        /* If there is a semaphore available, there is a network buffer available. */
+        if( xSemaphoreTake( xNetworkBufferSemaphore, xBlockTimeTicks ) == pdPASS )
+        {
+            /* Protect the structure as it is accessed from tasks and interrupts. */
+            taskENTER_CRITICAL();
+            {
+                pxReturn = ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xFreeBuffersList );
+                ( void ) uxListRemove( &( pxReturn->xBufferListItem ) );
+            }
+            taskEXIT_CRITICAL();
+
+            /* Reading UBaseType_t, no critical section needed. */
+            uxCount = listCURRENT_LIST_LENGTH( &xFreeBuffersList );
+
+            if( uxMinimumFreeNetworkBuffers > uxCount )
+            {
+                uxMinimumFreeNetworkBuffers = uxCount;
+            }
+
+            configASSERT( pxReturn->pucEthernetBuffer == NULL );
+
+            /* Take a block from the smallest size class that fits.  The
+             * arenas do not block: when no block is free, the descriptor
+             * is returned. */
+            pucBuffer = pucGetNetworkBuffer( &( xRequestedSizeBytesCopy ) );
+
+            if( pucBuffer == NULL )
+            {
+                vReleaseNetworkBufferAndDescriptor( pxReturn );
+                pxReturn = NULL;
+            }
+            else
+            {
+                /* Store a pointer to the network buffer structure in the
+                 * padding in front of the buffer. */
+                pxReturn->pucEthernetBuffer = pucBuffer;
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+                /* coverity[misra_c_2012_rule_18_4_violation] */
+                *( ( NetworkBufferDescriptor_t ** ) ( pucBuffer - ipBUFFER_PADDING ) ) = pxReturn;
+
+                /* Store the rounded size, which may be greater than the
+                 * original requested size. */
+                pxReturn->xDataLength = xRequestedSizeBytesCopy;
+                pxReturn->pxInterface = NULL;
+                pxReturn->pxEndPoint = NULL;
+
+                /* make sure the buffer is not linked */
+                pxReturn->pxNextBuffer = NULL;
+
+                #if ( ipconfigUSE_TCP_TSO != 0 )
+                {
+                    pxReturn->usTCPSegmentSize = 0U;
+                }
+                #endif
+
+                #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+                {
+                    pxReturn->ucChecksumFlags = 0U;
+                }
+                #endif
+
+                #if ( ipconfigUSE_VLAN != 0 )
+                {
+                    pxReturn->usVLANTag = 0U;
+                }
+                #endif
+
+                #if ( ipconfigUSE_PACKET_METADATA != 0 )
+                {
+                    pxReturn->xMetadata.ucValid = pdFALSE_UNSIGNED;
+                }
+                #endif
+
+                #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+                {
+                    pxReturn->xTimestamp.ulSeconds = 0U;
+                    pxReturn->xTimestamp.ulNanoseconds = 0U;
+                    pxReturn->ucTxTimestamp = pdFALSE_UNSIGNED;
+                }
+                #endif
+            }
+        }
+    }
+
+    if( pxReturn == NULL )
+    {
+        iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER();
+        ipRESOURCE_SHORTAGE( eShortageNetworkBuffers );
+    }
+    else
+    {
+        /* No action. */
+        iptraceNETWORK_BUFFER_OBTAINED( pxReturn );
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+
+/* Obtain a network buffer for application data. Such buffers are counted
+ * against xBulkBufferSemaphore first, so that ARP, DHCP and TCP control
+ * packets can always get one of the reserved buffers. */
+    NetworkBufferDescriptor_t * pxGetBulkNetworkBufferWithDescriptor( size_t xRequestedSizeBytes,
+                                                                      TickType_t xBlockTimeTicks )
+    {
+        NetworkBufferDescriptor_t * pxReturn = NULL;
+        TimeOut_t xTimeOut;
+        TickType_t xRemainingTime = xBlockTimeTicks;
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        if( ( xBulkBufferSemaphore != NULL ) &&
+            ( xSemaphoreTake( xBulkBufferSemaphore, xBlockTimeTicks ) == pdPASS ) )
+        {
+            /* Only wait for the time that is left. */
+            ( void ) xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime );
+
+            pxReturn = pxGetNetworkBufferWithDescriptor( xRequestedSizeBytes, xRemainingTime );
+
+            if( pxReturn != NULL )
+            {
+                pxReturn->xBulkQuota = pdTRUE;
+            }
+            else
+            {
+                ( void ) xSemaphoreGive( xBulkBufferSemaphore );
+            }
+        }
+        else
+        {
+            iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER();
+        }
+
+        return pxReturn;
+    }
+#endif /* ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL */
+/*-----------------------------------------------------------*/
+
+void vReleaseNetworkBufferAndDescriptor( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+{
+    BaseType_t xListItemAlreadyInFreeList;
+
+    #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+        if( xNetworkBufferDropReference( pxNetworkBuffer ) == pdFALSE )
+        {
+            /* Another owner still uses the buffer, the last one releases it. */
+        }
+        else
+    #endif
+    {
+        #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+        {
+            /* Hand back the memory that was attached to the frame. */
+            vNetworkBufferReleaseSegments( pxNetworkBuffer );
+        }
+        #endif
+
+        #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+        {
+            if( pxNetworkBuffer->xBulkQuota != pdFALSE )
+            {
+                /* Return the quota that was taken for bulk data. */
+                pxNetworkBuffer->xBulkQuota = pdFALSE;
+                ( void ) xSemaphoreGive( xBulkBufferSemaphore );
+            }
+        }
+        #endif
+
+        /* Return the block to its arena before the descriptor is returned to
+         * the list of free descriptors. */
+        vReleaseNetworkBuffer( pxNetworkBuffer->pucEthernetBuffer );
+        pxNetworkBuffer->pucEthernetBuffer = NULL;
+        pxNetworkBuffer->xDataLength = 0U;
+
+        taskENTER_CRITICAL();
+        {
+            xListItemAlreadyInFreeList = listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+
+            if( xListItemAlreadyInFreeList == pdFALSE )
+            {
+                vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /*
+         * Update the network state machine, unless the program fails to release its 'xNetworkBufferSemaphore'.
+         * The program should only try to release its semaphore if 'xListItemAlreadyInFreeList' is false.
+         */
+        if( xListItemAlreadyInFreeList == pdFALSE )
+        {
+            if( xSemaphoreGive( xNetworkBufferSemaphore ) == pdTRUE )
+            {
+                iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+            }
+        }
+        else
+        {
+            /* No action. */
+            iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release several network buffers at once.  The descriptors are
+ *        returned to xFreeBuffersList in a single critical section, and the
+ *        counting semaphore is given with the scheduler suspended, so that a
+ *        task that waits for a buffer is woken up only once.
+ *
+ * @param[in,out] pxNetworkBuffers The buffers to be released.  NULL entries
+ *                                 are skipped, all entries are set to NULL.
+ * @param[in] uxCount The number of entries in 'pxNetworkBuffers'.
+ */
+void vReleaseNetworkBuffersAndDescriptors( NetworkBufferDescriptor_t * pxNetworkBuffers[],
+                                           size_t uxCount )
+{
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    size_t uxIndex;
+    UBaseType_t uxReleased = 0U;
+
+    /* First do the work that is needed for every buffer, outside the
+     * critical section. */
+    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+    {
+        pxNetworkBuffer = pxNetworkBuffers[ uxIndex ];
+
+        if( pxNetworkBuffer == NULL )
+        {
+            /* Nothing to release. */
+        }
+        #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+            else if( xNetworkBufferDropReference( pxNetworkBuffer ) == pdFALSE )
+            {
+                /* Another owner still uses the buffer, the last one releases it. */
+                pxNetworkBuffers[ uxIndex ] = NULL;
+            }
+        #endif
+        else
+        {
+            #if ( ipconfigUSE_SCATTER_GATHER != 0 )
+            {
+                /* Hand back the memory that was attached to the frame. */
+                vNetworkBufferReleaseSegments( pxNetworkBuffer );
+            }
+            #endif
+
+            #if ( ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL > 0 )
+            {
+                if( pxNetworkBuffer->xBulkQuota != pdFALSE )
+                {
+                    /* Return the quota that was taken for bulk data. */
+                    pxNetworkBuffer->xBulkQuota = pdFALSE;
+                    ( void ) xSemaphoreGive( xBulkBufferSemaphore );
+                }
+            }
+            #endif
+
+            vReleaseNetworkBuffer( pxNetworkBuffer->pucEthernetBuffer );
+            pxNetworkBuffer->pucEthernetBuffer = NULL;
+            pxNetworkBuffer->xDataLength = 0U;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    {
+        for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+        {
+            pxNetworkBuffer = pxNetworkBuffers[ uxIndex ];
+
+            if( pxNetworkBuffer != NULL )
+            {
+                /* A buffer that was released twice is not counted twice. */
+                if( listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) ) == pdFALSE )
+                {
+                    vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+                    uxReleased++;
+                }
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+    {
+        if( pxNetworkBuffers[ uxIndex ] != NULL )
+        {
+            iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffers[ uxIndex ] );
+            pxNetworkBuffers[ uxIndex ] = NULL;
+        }
+    }
+
+    if( uxReleased > 0U )
+    {
+        vTaskSuspendAll();
+        {
+            while( uxReleased > 0U )
+            {
+                ( void ) xSemaphoreGive( xNetworkBufferSemaphore );
+                uxReleased--;
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the number of free network buffers
+ */
+UBaseType_t uxGetNumberOfFreeNetworkBuffers( void )
+{
+    return listCURRENT_LIST_LENGTH( &xFreeBuffersList );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxGetMinimumFreeNetworkBuffers( void )
+{
+    return uxMinimumFreeNetworkBuffers;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigRX_COPY_BREAK != 0 )
+
+/**
+ * @brief Copy a small received frame to a buffer of the smallest size class
+ *        that fits, so that the driver can give its large buffer back to the
+ *        DMA at once.
+ *
+ * @param[in] pxNetworkBuffer The buffer that received the frame.
+ *
+ * @return The copy, or NULL when the frame is longer than ipconfigRX_COPY_BREAK
+ *         or when no buffer is available.
+ */
+    NetworkBufferDescriptor_t * pxNetworkBufferCopyBreak( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkBufferDescriptor_t * pxReturn = NULL;
+
+        if( pxNetworkBuffer->xDataLength <= ( size_t ) ipconfigRX_COPY_BREAK )
+        {
+            pxReturn = pxDuplicateNetworkBufferWithDescriptor( pxNetworkBuffer, pxNetworkBuffer->xDataLength );
+        }
+
+        return pxReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a network buffer can hold a full frame.
+ *
+ * @param[in] pxNetworkBuffer The buffer, or NULL for a new buffer.
+ *
+ * @return Always pdFALSE, a buffer of this module is resized when it grows.
+ */
+    BaseType_t xIsFixedSizeNetworkBuffer( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        ( void ) pxNetworkBuffer;
+
+        return pdFALSE;
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ipconfigRX_COPY_BREAK != 0 */
+
+NetworkBufferDescriptor_t * pxResizeNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                                 size_t xNewSizeBytes )
+{
+    size_t xOriginalLength;
+    uint8_t * pucBuffer;
+    size_t uxSizeBytes = xNewSizeBytes;
+    NetworkBufferDescriptor_t * pxNetworkBufferCopy = pxNetworkBuffer;
+    const BufferSizeClass_t * pxClass = NULL;
+
+    if( pxNetworkBufferCopy->pucEthernetBuffer != NULL )
+    {
+        /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+        /* coverity[misra_c_2012_rule_18_4_violation] */
+        pxClass = prvFindSizeClass( pxNetworkBufferCopy->pucEthernetBuffer - ipBUFFER_PADDING );
+    }
+
+    if( ( pxClass != NULL ) && ( uxSizeBytes <= pxClass->uxCapacity ) )
+    {
+        /* The block is large enough, the buffer can grow in place. */
+        pxNetworkBufferCopy->xDataLength = uxSizeBytes;
+    }
+    else
+    {
+        xOriginalLength = pxNetworkBufferCopy->xDataLength + ipBUFFER_PADDING;
+
+        pucBuffer = pucGetNetworkBuffer( &( uxSizeBytes ) );
+
+        if( pucBuffer == NULL )
+        {
+            /* In case the allocation fails, return NULL. */
+            pxNetworkBufferCopy = NULL;
+        }
+        else
+        {
+            pxNetworkBufferCopy->xDataLength = uxSizeBytes;
+
+            if( ( uxSizeBytes + ipBUFFER_PADDING ) < xOriginalLength )
+            {
+                xOriginalLength = uxSizeBytes + ipBUFFER_PADDING;
+            }
+
+            if( pxNetworkBufferCopy->pucEthernetBuffer != NULL )
+            {
+                /* Copy the padding, which holds the pointer to the descriptor,
+                 * together with the contents of the buffer. */
+
+                /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+                /* coverity[misra_c_2012_rule_18_4_violation] */
+                ( void ) memcpy( pucBuffer - ipBUFFER_PADDING,
+                                 /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+                                 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+                                 /* coverity[misra_c_2012_rule_18_4_violation] */
+                                 pxNetworkBufferCopy->pucEthernetBuffer - ipBUFFER_PADDING,
+                                 xOriginalLength );
+                vReleaseNetworkBuffer( pxNetworkBufferCopy->pucEthernetBuffer );
+            }
+            else
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                /* MISRA Ref 18.4.1 [Usage of +, -, += and -= operators on expression of pointer type]. */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-184. */
+                /* coverity[misra_c_2012_rule_18_4_violation] */
+                *( ( NetworkBufferDescriptor_t ** ) ( pucBuffer - ipBUFFER_PADDING ) ) = pxNetworkBufferCopy;
+            }
+
+            pxNetworkBufferCopy->pucEthernetBuffer = pucBuffer;
+        }
+    }
+
+    return pxNetworkBufferCopy;
+}
+/*-----------------------------------------------------------*/
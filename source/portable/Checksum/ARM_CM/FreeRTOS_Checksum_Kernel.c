@@ -0,0 +1,109 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * ulChecksumKernel() for Cortex-M3/M4/M7/M33/M55 and other cores with the
+ * Thumb-2 instruction set, built with GCC, Clang or ARMClang.  Enable
+ * ipconfigUSE_CHECKSUM_KERNEL to use it.
+ *
+ * The SIMD instructions of the DSP extension work on 8 or 16 bits lanes and
+ * lose the carries, so this kernel uses a chain of ADCS instructions instead:
+ * one cycle per 32-bit word, and the carry flag takes care of the
+ * end-around carry.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+/**
+ * @brief Add 32-bit words to a sum, with end-around carry.
+ *
+ * @param[in] ulSum The sum so far.
+ * @param[in] pulData The words to be added, 4-byte aligned.
+ * @param[in] uxWordCount The number of words.
+ *
+ * @return The new sum.  Folded to 16 bits, it equals the one's complement sum
+ *         of all 16-bit words.
+ */
+uint32_t ulChecksumKernel( uint32_t ulSum,
+                           const uint32_t * pulData,
+                           size_t uxWordCount )
+{
+    uint32_t ulResult = ulSum;
+    const uint32_t * pulSource = pulData;
+    size_t uxRemaining = uxWordCount;
+    uint32_t ulWord0, ulWord1, ulWord2, ulWord3;
+
+    /* 16 bytes per iteration. */
+    while( uxRemaining >= 4U )
+    {
+        __asm volatile (
+            "ldr   %[w0], [%[src], #0]      \n"
+            "ldr   %[w1], [%[src], #4]      \n"
+            "ldr   %[w2], [%[src], #8]      \n"
+            "ldr   %[w3], [%[src], #12]     \n"
+            "adds  %[sum], %[sum], %[w0]    \n"
+            "adcs  %[sum], %[sum], %[w1]    \n"
+            "adcs  %[sum], %[sum], %[w2]    \n"
+            "adcs  %[sum], %[sum], %[w3]    \n"
+            "adc   %[sum], %[sum], #0       \n"
+            : [ sum ] "+r" ( ulResult ),
+            [ w0 ] "=&r" ( ulWord0 ),
+            [ w1 ] "=&r" ( ulWord1 ),
+            [ w2 ] "=&r" ( ulWord2 ),
+            [ w3 ] "=&r" ( ulWord3 )
+            : [ src ] "r" ( pulSource )
+            : "cc", "memory"
+            );
+
+        pulSource = &( pulSource[ 4 ] );
+        uxRemaining -= 4U;
+    }
+
+    for( ; uxRemaining > 0U; uxRemaining-- )
+    {
+        ulResult += *pulSource;
+
+        if( ulResult < *pulSource )
+        {
+            /* End-around carry. */
+            ulResult++;
+        }
+
+        pulSource++;
+    }
+
+    return ulResult;
+}
+/*-----------------------------------------------------------*/
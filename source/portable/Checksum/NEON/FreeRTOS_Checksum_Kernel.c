@@ -0,0 +1,87 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * ulChecksumKernel() for ARM CPUs with Advanced SIMD ( NEON ), both AArch32
+ * and AArch64.  Enable ipconfigUSE_CHECKSUM_KERNEL to use it.
+ *
+ * VPADAL adds pairs of 32-bit lanes into 64-bit accumulators, so no carry
+ * gets lost.  The carries are folded back at the end.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <arm_neon.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+/**
+ * @brief Add 32-bit words to a sum, with end-around carry.
+ *
+ * @param[in] ulSum The sum so far.
+ * @param[in] pulData The words to be added, 4-byte aligned.
+ * @param[in] uxWordCount The number of words.
+ *
+ * @return The new sum.  Folded to 16 bits, it equals the one's complement sum
+ *         of all 16-bit words.
+ */
+uint32_t ulChecksumKernel( uint32_t ulSum,
+                           const uint32_t * pulData,
+                           size_t uxWordCount )
+{
+    uint64x2_t xAccumulatorA = vdupq_n_u64( 0U );
+    uint64x2_t xAccumulatorB = vdupq_n_u64( 0U );
+    uint64_t ullSum = ( uint64_t ) ulSum;
+    size_t uxIndex = 0U;
+
+    /* 32 bytes per iteration. */
+    for( ; ( uxIndex + 8U ) <= uxWordCount; uxIndex += 8U )
+    {
+        xAccumulatorA = vpadalq_u32( xAccumulatorA, vld1q_u32( &( pulData[ uxIndex ] ) ) );
+        xAccumulatorB = vpadalq_u32( xAccumulatorB, vld1q_u32( &( pulData[ uxIndex + 4U ] ) ) );
+    }
+
+    xAccumulatorA = vaddq_u64( xAccumulatorA, xAccumulatorB );
+    ullSum += vgetq_lane_u64( xAccumulatorA, 0 ) + vgetq_lane_u64( xAccumulatorA, 1 );
+
+    for( ; uxIndex < uxWordCount; uxIndex++ )
+    {
+        ullSum += pulData[ uxIndex ];
+    }
+
+    /* Fold the 64-bit sum into 32 bits. */
+    ullSum = ( ullSum & 0xFFFFFFFFU ) + ( ullSum >> 32 );
+    ullSum = ( ullSum & 0xFFFFFFFFU ) + ( ullSum >> 32 );
+
+    return ( uint32_t ) ullSum;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,395 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @brief
+ * Management of the DMA descriptor rings of an Ethernet MAC, see dmaRing.h.
+ *
+ * Every descriptor has a slot in 'ppxBuffers'.  A descriptor is armed at
+ * 'uxHead' and completed at 'uxTail', so the descriptors between the two are
+ * owned by the DMA.  An RX slot of which the frame was dropped keeps its
+ * buffer, which will be armed again by uxDMARingRxFill().
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Routing.h"
+#include "NetworkBufferManagement.h"
+
+#include "dmaRing.h"
+
+#if ( ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES == 0 )
+    #define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer )    eProcessBuffer
+#else
+    #define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer )    eConsiderFrameForProcessing( ( pucEthernetBuffer ) )
+#endif
+
+#if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 )
+    #define dmaCACHE_CLEAN( pxBuffer )                   vNetworkBufferCacheClean( pxBuffer )
+    #define dmaCACHE_INVALIDATE( pxBuffer, uxLength )    vNetworkBufferCacheInvalidate( ( pxBuffer ), ( uxLength ) )
+#else
+    #define dmaCACHE_CLEAN( pxBuffer )                   do {} while( ipFALSE_BOOL )
+    #define dmaCACHE_INVALIDATE( pxBuffer, uxLength )    do {} while( ipFALSE_BOOL )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Return the index of the descriptor that follows 'uxIndex'. */
+static size_t prvRingNext( const DMARing_t * pxRing,
+                           size_t uxIndex );
+
+/* Get an empty buffer for an RX descriptor, without blocking. */
+static NetworkBufferDescriptor_t * prvRxBufferGet( DMARing_t * pxRing );
+
+/*-----------------------------------------------------------*/
+
+static size_t prvRingNext( const DMARing_t * pxRing,
+                           size_t uxIndex )
+{
+    size_t uxNext = uxIndex + 1U;
+
+    if( uxNext == pxRing->uxCount )
+    {
+        uxNext = 0U;
+    }
+
+    return uxNext;
+}
+/*-----------------------------------------------------------*/
+
+static NetworkBufferDescriptor_t * prvRxBufferGet( DMARing_t * pxRing )
+{
+    NetworkBufferDescriptor_t * pxBuffer = NULL;
+
+    #if ( ipconfigNETWORK_BUFFER_RX_RESERVE != 0 )
+    {
+        /* The ring is the only consumer of the reserve of its interface. */
+        pxBuffer = pxNetworkBufferGetFromReserveISR( pxRing->pxInterface );
+    }
+    #else
+    {
+        ( void ) pxRing;
+    }
+    #endif
+
+    if( pxBuffer == NULL )
+    {
+        pxBuffer = pxGetNetworkBufferWithDescriptor( ipTOTAL_ETHERNET_FRAME_SIZE, 0U );
+    }
+
+    return pxBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vDMARingInit( DMARing_t * pxRing,
+                   NetworkInterface_t * pxInterface,
+                   const DMARingOps_t * pxOps,
+                   void * pvContext,
+                   NetworkBufferDescriptor_t ** ppxBuffers,
+                   size_t uxCount )
+{
+    configASSERT( ( pxRing != NULL ) && ( pxOps != NULL ) && ( ppxBuffers != NULL ) && ( uxCount > 0U ) );
+
+    ( void ) memset( pxRing, 0, sizeof( *pxRing ) );
+    ( void ) memset( ppxBuffers, 0, uxCount * sizeof( *ppxBuffers ) );
+
+    pxRing->pxOps = pxOps;
+    pxRing->pvContext = pvContext;
+    pxRing->pxInterface = pxInterface;
+    pxRing->ppxBuffers = ppxBuffers;
+    pxRing->uxCount = uxCount;
+}
+/*-----------------------------------------------------------*/
+
+size_t uxDMARingRxFill( DMARing_t * pxRing )
+{
+    size_t uxFilled = 0U;
+
+    while( pxRing->uxPending < pxRing->uxCount )
+    {
+        size_t uxIndex = pxRing->uxHead;
+        NetworkBufferDescriptor_t * pxBuffer = pxRing->ppxBuffers[ uxIndex ];
+
+        if( pxBuffer == NULL )
+        {
+            pxBuffer = prvRxBufferGet( pxRing );
+
+            if( pxBuffer == NULL )
+            {
+                /* Try again the next time that frames are processed. */
+                break;
+            }
+
+            pxRing->ppxBuffers[ uxIndex ] = pxBuffer;
+        }
+
+        /* No dirty cache line may be written back over the received data. */
+        dmaCACHE_INVALIDATE( pxBuffer, ipTOTAL_ETHERNET_FRAME_SIZE );
+
+        pxRing->pxOps->pfRxArm( pxRing->pvContext, uxIndex, pxBuffer->pucEthernetBuffer, ipTOTAL_ETHERNET_FRAME_SIZE );
+
+        pxRing->uxHead = prvRingNext( pxRing, uxIndex );
+        pxRing->uxPending++;
+        uxFilled++;
+    }
+
+    if( ( uxFilled > 0U ) && ( pxRing->pxOps->pfKick != NULL ) )
+    {
+        pxRing->pxOps->pfKick( pxRing->pvContext );
+    }
+
+    return uxFilled;
+}
+/*-----------------------------------------------------------*/
+
+size_t uxDMARingRxProcess( DMARing_t * pxRing,
+                           size_t uxBudget )
+{
+    size_t uxCount = 0U;
+
+    #if ( ipconfigUSE_NETWORK_INTERFACE_POLL == 0 )
+        NetworkBufferDescriptor_t * pxBurst[ dmaRING_RX_BURST_LENGTH ];
+        size_t uxBurstCount = 0U;
+    #endif
+
+    while( ( uxCount < uxBudget ) && ( pxRing->uxPending > 0U ) )
+    {
+        size_t uxIndex = pxRing->uxTail;
+        size_t uxLength = 0U;
+        NetworkBufferDescriptor_t * pxBuffer;
+        NetworkBufferDescriptor_t * pxNewBuffer;
+
+        if( pxRing->pxOps->pfRxDone( pxRing->pvContext, uxIndex, &( uxLength ) ) == pdFALSE )
+        {
+            break;
+        }
+
+        pxRing->uxTail = prvRingNext( pxRing, uxIndex );
+        pxRing->uxPending--;
+        uxCount++;
+
+        pxBuffer = pxRing->ppxBuffers[ uxIndex ];
+        configASSERT( pxBuffer != NULL );
+
+        if( ( uxLength == 0U ) || ( uxLength > ipTOTAL_ETHERNET_FRAME_SIZE ) )
+        {
+            vNetworkInterfaceRxDropped( pxRing->pxInterface, eDropMalformed );
+            continue;
+        }
+
+        /* Lines may have been fetched speculatively while the DMA wrote. */
+        dmaCACHE_INVALIDATE( pxBuffer, uxLength );
+
+        if( ipCONSIDER_FRAME_FOR_PROCESSING( pxBuffer->pucEthernetBuffer ) != eProcessBuffer )
+        {
+            vNetworkInterfaceRxDropped( pxRing->pxInterface, eDropFiltered );
+            continue;
+        }
+
+        /* Replace the buffer before passing it on, when no buffer is
+         * available, the frame is dropped and its buffer reused. */
+        pxNewBuffer = prvRxBufferGet( pxRing );
+
+        if( pxNewBuffer == NULL )
+        {
+            vNetworkInterfaceRxDropped( pxRing->pxInterface, eDropNoBuffer );
+            continue;
+        }
+
+        pxRing->ppxBuffers[ uxIndex ] = pxNewBuffer;
+
+        pxBuffer->xDataLength = uxLength;
+        pxBuffer->pxInterface = pxRing->pxInterface;
+        pxBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxRing->pxInterface, pxBuffer->pucEthernetBuffer );
+
+        iptraceNETWORK_INTERFACE_RECEIVE();
+
+        #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+        {
+            vNetworkInterfacePollInput( pxBuffer );
+        }
+        #else
+        {
+            pxBurst[ uxBurstCount ] = pxBuffer;
+            uxBurstCount++;
+
+            if( uxBurstCount == dmaRING_RX_BURST_LENGTH )
+            {
+                ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, 0U );
+                uxBurstCount = 0U;
+            }
+        }
+        #endif
+    }
+
+    #if ( ipconfigUSE_NETWORK_INTERFACE_POLL == 0 )
+    {
+        if( uxBurstCount > 0U )
+        {
+            ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, 0U );
+        }
+    }
+    #endif
+
+    if( uxCount > 0U )
+    {
+        /* Give the completed descriptors back to the DMA in one go. */
+        ( void ) uxDMARingRxFill( pxRing );
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xDMARingTxSend( DMARing_t * pxRing,
+                           NetworkBufferDescriptor_t * const pxBuffer,
+                           BaseType_t xReleaseAfterSend )
+{
+    BaseType_t xReturn = pdFAIL;
+    NetworkBufferDescriptor_t * pxSend = pxBuffer;
+
+    if( pxRing->uxPending == pxRing->uxCount )
+    {
+        ( void ) uxDMARingTxReclaim( pxRing );
+    }
+
+    if( pxRing->uxPending < pxRing->uxCount )
+    {
+        if( xReleaseAfterSend == pdFALSE )
+        {
+            /* The caller keeps its buffer, the DMA gets a copy. */
+            pxSend = pxDuplicateNetworkBufferWithDescriptor( pxBuffer, pxBuffer->xDataLength );
+
+            #if ( ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE > 0 )
+                if( pxSend != NULL )
+                {
+                    pxSend->xCacheCleanNeeded = pdTRUE;
+                }
+            #endif
+        }
+
+        if( pxSend != NULL )
+        {
+            size_t uxIndex = pxRing->uxHead;
+
+            dmaCACHE_CLEAN( pxSend );
+
+            pxRing->ppxBuffers[ uxIndex ] = pxSend;
+            pxRing->pxOps->pfTxArm( pxRing->pvContext, uxIndex, pxSend->pucEthernetBuffer, pxSend->xDataLength );
+
+            pxRing->uxHead = prvRingNext( pxRing, uxIndex );
+            pxRing->uxPending++;
+
+            if( pxRing->pxOps->pfKick != NULL )
+            {
+                pxRing->pxOps->pfKick( pxRing->pvContext );
+            }
+
+            iptraceNETWORK_INTERFACE_TRANSMIT();
+            xReturn = pdPASS;
+        }
+    }
+    else if( xReleaseAfterSend != pdFALSE )
+    {
+        vReleaseNetworkBufferAndDescriptor( pxBuffer );
+    }
+    else
+    {
+        /* The caller still owns the buffer. */
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t uxDMARingTxReclaim( DMARing_t * pxRing )
+{
+    NetworkBufferDescriptor_t * pxBatch[ dmaRING_TX_RELEASE_BATCH ];
+    size_t uxBatchCount = 0U;
+    size_t uxCount = 0U;
+
+    while( pxRing->uxPending > 0U )
+    {
+        size_t uxIndex = pxRing->uxTail;
+
+        if( pxRing->pxOps->pfTxDone( pxRing->pvContext, uxIndex ) == pdFALSE )
+        {
+            break;
+        }
+
+        pxBatch[ uxBatchCount ] = pxRing->ppxBuffers[ uxIndex ];
+        uxBatchCount++;
+        pxRing->ppxBuffers[ uxIndex ] = NULL;
+
+        pxRing->uxTail = prvRingNext( pxRing, uxIndex );
+        pxRing->uxPending--;
+        uxCount++;
+
+        if( uxBatchCount == dmaRING_TX_RELEASE_BATCH )
+        {
+            /* One lock for the whole batch. */
+            vReleaseNetworkBuffersAndDescriptors( pxBatch, uxBatchCount );
+            uxBatchCount = 0U;
+        }
+    }
+
+    if( uxBatchCount > 0U )
+    {
+        vReleaseNetworkBuffersAndDescriptors( pxBatch, uxBatchCount );
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+void vDMARingFlush( DMARing_t * pxRing )
+{
+    size_t uxIndex;
+
+    for( uxIndex = 0U; uxIndex < pxRing->uxCount; uxIndex++ )
+    {
+        if( pxRing->ppxBuffers[ uxIndex ] != NULL )
+        {
+            vReleaseNetworkBufferAndDescriptor( pxRing->ppxBuffers[ uxIndex ] );
+            pxRing->ppxBuffers[ uxIndex ] = NULL;
+        }
+    }
+
+    pxRing->uxHead = 0U;
+    pxRing->uxTail = 0U;
+    pxRing->uxPending = 0U;
+}
+/*-----------------------------------------------------------*/
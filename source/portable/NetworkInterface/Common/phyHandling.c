@@ -128,6 +128,24 @@
       phyADVERTISE_100HALF | phyADVERTISE_100FULL | \
       phyADVERTISE_CSMA )
 
+/* Registers and bits that make a PHY assert its interrupt pin on link changes.
+ * The status register is cleared by reading it. */
+#define phyREG_11_MICR            0x11U    /* DP83848: MII Interrupt Control Register. */
+#define phyREG_12_MISR            0x12U    /* DP83848: MII Interrupt Status and Misc. Control Register. */
+#define phyMICR_INT_OE            0x0001U  /* Drive the interrupt pin. */
+#define phyMICR_INTEN             0x0002U  /* Enable interrupts. */
+#define phyMISR_ANC_INT_EN        0x0004U  /* Auto-negotiation complete. */
+#define phyMISR_LINK_INT_EN       0x0020U  /* Link status changed. */
+
+#define phyREG_1B_ICSR            0x1BU    /* KSZ80x1: Interrupt Control/Status Register. */
+#define phyICSR_LINK_UP_EN        0x0100U
+#define phyICSR_LINK_DOWN_EN      0x0400U
+
+#define phyREG_1D_ISFR            0x1DU    /* LAN87xx: Interrupt Source Flag Register. */
+#define phyREG_1E_IMR             0x1EU    /* LAN87xx: Interrupt Mask Register. */
+#define phyIMR_LINK_DOWN          0x0010U
+#define phyIMR_AN_COMPLETE        0x0040U
+
 /* Send a reset command to a set of PHY-ports. */
 static uint32_t xPhyReset( EthernetPhy_t * pxPhyObject,
                            uint32_t ulPhyMask );
@@ -188,6 +206,88 @@ static BaseType_t xHas_19_PHYCR( uint32_t ulPhyID )
 }
 /*-----------------------------------------------------------*/
 
+/* Get the register that holds the interrupt status of a PHY, or zero when
+ * the PHY is not known to signal link changes. */
+static uint32_t ulLinkInterruptRegister( uint32_t ulPhyID )
+{
+    uint32_t ulRegister = 0U;
+
+    switch( ulPhyID )
+    {
+        case PHY_ID_LAN8720:
+        case PHY_ID_LAN8742A:
+            ulRegister = phyREG_1D_ISFR;
+            break;
+
+        case PHY_ID_KSZ8041:
+        case PHY_ID_KSZ8081MNXIA:
+            ulRegister = phyREG_1B_ICSR;
+            break;
+
+        case PHY_ID_DP83848I:
+            ulRegister = phyREG_12_MISR;
+            break;
+
+        default:
+            /* Unknown, the link status will be polled. */
+            break;
+    }
+
+    return ulRegister;
+}
+/*-----------------------------------------------------------*/
+
+/* Get the interval after which the link status is checked again. */
+static TickType_t xLinkStatusNextCheck( EthernetPhy_t * pxPhyObject,
+                                        BaseType_t xLinkHigh,
+                                        BaseType_t xChanged )
+{
+    TickType_t xInterval;
+
+    if( ( pxPhyObject->xPortCount > 0 ) && ( pxPhyObject->ulLinkInterruptMask == xPhyGetMask( pxPhyObject ) ) )
+    {
+        /* The PHY's will tell when their link changes, polling is only
+         * done in case an interrupt got lost. */
+        xInterval = pdMS_TO_TICKS( ipconfigPHY_LS_HIGH_CHECK_TIME_MS );
+    }
+    else if( xLinkHigh == pdFALSE )
+    {
+        /* The link status is low, polling may be done more frequently. */
+        xInterval = pdMS_TO_TICKS( ipconfigPHY_LS_LOW_CHECK_TIME_MS );
+    }
+    else
+    {
+        /* The link status is high, so don't poll the PHY too often. */
+        xInterval = pdMS_TO_TICKS( ipconfigPHY_LS_HIGH_CHECK_TIME_MS );
+
+        #if ( ipconfigPHY_LS_ADAPTIVE_POLL == ipconfigENABLE )
+        {
+            /* A link that just came up may well go down again.  Start
+             * with the short interval and back off while it stays up. */
+            if( ( xChanged != pdFALSE ) || ( pxPhyObject->xLinkStatusInterval == 0U ) )
+            {
+                xInterval = pdMS_TO_TICKS( ipconfigPHY_LS_LOW_CHECK_TIME_MS );
+            }
+            else if( pxPhyObject->xLinkStatusInterval < ( xInterval / 2U ) )
+            {
+                xInterval = pxPhyObject->xLinkStatusInterval * 2U;
+            }
+            else
+            {
+                /* Reached the maximum. */
+            }
+        }
+        #else
+            ( void ) xChanged;
+        #endif
+    }
+
+    pxPhyObject->xLinkStatusInterval = xInterval;
+
+    return xInterval;
+}
+/*-----------------------------------------------------------*/
+
 /* Initialise the struct and assign a PHY-read and -write function. */
 void vPhyInitialise( EthernetPhy_t * pxPhyObject,
                      xApplicationPhyReadHook_t fnPhyRead,
@@ -256,6 +356,9 @@ static uint32_t xPhyReset( EthernetPhy_t * pxPhyObject,
     /* A bit-mask of PHY ports that are ready. */
     ulDoneMask = 0U;
 
+    /* The reset also disables the interrupts of the PHY's. */
+    pxPhyObject->ulLinkInterruptMask &= ~ulPhyMask;
+
     /* Set the RESET bits high. */
     for( xPhyIndex = 0; xPhyIndex < pxPhyObject->xPortCount; xPhyIndex++ )
     {
@@ -519,74 +622,13 @@ BaseType_t xPhyFixedValue( EthernetPhy_t * pxPhyObject,
 }
 /*-----------------------------------------------------------*/
 
-/* xPhyStartAutoNegotiation() is the alternative xPhyFixedValue():
- * It sets the BMCR_AN_RESTART bit and waits for the auto-negotiation completion
- * ( phyBMSR_AN_COMPLETE ). */
-BaseType_t xPhyStartAutoNegotiation( EthernetPhy_t * pxPhyObject,
-                                     uint32_t ulPhyMask )
+/* Read the results of the ports in 'ulDoneMask' that completed their
+ * auto-negotiation. */
+static void prvPhyAutoNegotiationResult( EthernetPhy_t * pxPhyObject,
+                                         uint32_t ulDoneMask )
 {
-    uint32_t xPhyIndex, ulDoneMask, ulBitMask;
+    uint32_t xPhyIndex, ulBitMask;
     uint32_t ulRegValue;
-    TickType_t xRemainingTime;
-    TimeOut_t xTimer;
-
-    if( ulPhyMask == ( uint32_t ) 0U )
-    {
-        return 0;
-    }
-
-    for( xPhyIndex = 0; xPhyIndex < ( uint32_t ) pxPhyObject->xPortCount; xPhyIndex++ )
-    {
-        if( ( ulPhyMask & ( 1lu << xPhyIndex ) ) != 0lu )
-        {
-            BaseType_t xPhyAddress = pxPhyObject->ucPhyIndexes[ xPhyIndex ];
-
-            /* Enable Auto-Negotiation. */
-            pxPhyObject->fnPhyWrite( xPhyAddress, phyREG_04_ADVERTISE, pxPhyObject->ulACRValue );
-            pxPhyObject->fnPhyWrite( xPhyAddress, phyREG_00_BMCR, pxPhyObject->ulBCRValue | phyBMCR_AN_RESTART );
-        }
-    }
-
-    xRemainingTime = ( TickType_t ) pdMS_TO_TICKS( phyPHY_MAX_NEGOTIATE_TIME_MS );
-    vTaskSetTimeOutState( &xTimer );
-    ulDoneMask = 0;
-
-    /* Wait until the auto-negotiation will be completed */
-    for( ; ; )
-    {
-        ulBitMask = ( uint32_t ) 1U;
-
-        for( xPhyIndex = 0; xPhyIndex < ( uint32_t ) pxPhyObject->xPortCount; xPhyIndex++, ulBitMask <<= 1 )
-        {
-            if( ( ulPhyMask & ulBitMask ) != 0lu )
-            {
-                if( ( ulDoneMask & ulBitMask ) == 0lu )
-                {
-                    BaseType_t xPhyAddress = pxPhyObject->ucPhyIndexes[ xPhyIndex ];
-
-                    pxPhyObject->fnPhyRead( xPhyAddress, phyREG_01_BMSR, &ulRegValue );
-
-                    if( ( ulRegValue & phyBMSR_AN_COMPLETE ) != 0 )
-                    {
-                        ulDoneMask |= ulBitMask;
-                    }
-                }
-            }
-        }
-
-        if( ulPhyMask == ulDoneMask )
-        {
-            break;
-        }
-
-        if( xTaskCheckForTimeOut( &xTimer, &xRemainingTime ) != pdFALSE )
-        {
-            FreeRTOS_printf( ( "xPhyStartAutoNegotiation: phyBMSR_AN_COMPLETE timed out ( done 0x%02X )\n", ( unsigned int ) ulDoneMask ) );
-            break;
-        }
-
-        vTaskDelay( pdMS_TO_TICKS( phySHORT_DELAY_MS ) );
-    }
 
     if( ulDoneMask != ( uint32_t ) 0U )
     {
@@ -730,24 +772,143 @@ BaseType_t xPhyStartAutoNegotiation( EthernetPhy_t * pxPhyObject,
             }
         }
     } /* if( ulDoneMask != ( uint32_t) 0U ) */
+}
+/*-----------------------------------------------------------*/
+
+/* xPhyStartAutoNegotiation() is the alternative xPhyFixedValue():
+ * It sets the BMCR_AN_RESTART bit and waits for the auto-negotiation completion
+ * ( phyBMSR_AN_COMPLETE ). */
+BaseType_t xPhyStartAutoNegotiation( EthernetPhy_t * pxPhyObject,
+                                     uint32_t ulPhyMask )
+{
+    ( void ) xPhyStartAutoNegotiationAsync( pxPhyObject, ulPhyMask );
+
+    /* Wait until the auto-negotiation will be completed */
+    while( ulPhyCheckAutoNegotiation( pxPhyObject ) != ( uint32_t ) 0U )
+    {
+        vTaskDelay( pdMS_TO_TICKS( phySHORT_DELAY_MS ) );
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPhyStartAutoNegotiationAsync( EthernetPhy_t * pxPhyObject,
+                                          uint32_t ulPhyMask )
+{
+    uint32_t xPhyIndex;
+
+    if( ulPhyMask == ( uint32_t ) 0U )
+    {
+        return 0;
+    }
+
+    for( xPhyIndex = 0; xPhyIndex < ( uint32_t ) pxPhyObject->xPortCount; xPhyIndex++ )
+    {
+        if( ( ulPhyMask & ( 1lu << xPhyIndex ) ) != 0lu )
+        {
+            BaseType_t xPhyAddress = pxPhyObject->ucPhyIndexes[ xPhyIndex ];
+
+            /* Enable Auto-Negotiation. */
+            pxPhyObject->fnPhyWrite( xPhyAddress, phyREG_04_ADVERTISE, pxPhyObject->ulACRValue );
+            pxPhyObject->fnPhyWrite( xPhyAddress, phyREG_00_BMCR, pxPhyObject->ulBCRValue | phyBMCR_AN_RESTART );
+        }
+    }
+
+    pxPhyObject->ulNegotiatingMask = ulPhyMask;
+    pxPhyObject->ulNegotiatedMask = 0U;
+    pxPhyObject->xNegotiateRemaining = ( TickType_t ) pdMS_TO_TICKS( phyPHY_MAX_NEGOTIATE_TIME_MS );
+    vTaskSetTimeOutState( &( pxPhyObject->xNegotiateTimer ) );
 
     return 0;
 }
 /*-----------------------------------------------------------*/
 
+uint32_t ulPhyCheckAutoNegotiation( EthernetPhy_t * pxPhyObject )
+{
+    uint32_t xPhyIndex, ulBitMask;
+    uint32_t ulRegValue;
+    uint32_t ulPhyMask = pxPhyObject->ulNegotiatingMask;
+    BaseType_t xReady = pdFALSE;
+
+    if( ulPhyMask != ( uint32_t ) 0U )
+    {
+        ulBitMask = ( uint32_t ) 1U;
+
+        for( xPhyIndex = 0; xPhyIndex < ( uint32_t ) pxPhyObject->xPortCount; xPhyIndex++, ulBitMask <<= 1 )
+        {
+            if( ( ( ulPhyMask & ulBitMask ) != 0lu ) && ( ( pxPhyObject->ulNegotiatedMask & ulBitMask ) == 0lu ) )
+            {
+                BaseType_t xPhyAddress = pxPhyObject->ucPhyIndexes[ xPhyIndex ];
+
+                pxPhyObject->fnPhyRead( xPhyAddress, phyREG_01_BMSR, &ulRegValue );
+
+                if( ( ulRegValue & phyBMSR_AN_COMPLETE ) != 0 )
+                {
+                    pxPhyObject->ulNegotiatedMask |= ulBitMask;
+                }
+            }
+        }
+
+        if( ulPhyMask == pxPhyObject->ulNegotiatedMask )
+        {
+            xReady = pdTRUE;
+        }
+        else if( xTaskCheckForTimeOut( &( pxPhyObject->xNegotiateTimer ), &( pxPhyObject->xNegotiateRemaining ) ) != pdFALSE )
+        {
+            FreeRTOS_printf( ( "xPhyStartAutoNegotiation: phyBMSR_AN_COMPLETE timed out ( done 0x%02X )\n", ( unsigned int ) pxPhyObject->ulNegotiatedMask ) );
+            xReady = pdTRUE;
+        }
+        else
+        {
+            /* Still negotiating. */
+        }
+
+        if( xReady != pdFALSE )
+        {
+            pxPhyObject->ulNegotiatingMask = 0U;
+            prvPhyAutoNegotiationResult( pxPhyObject, pxPhyObject->ulNegotiatedMask );
+        }
+    }
+
+    return pxPhyObject->ulNegotiatingMask;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xPhyCheckLinkStatus( EthernetPhy_t * pxPhyObject,
                                 BaseType_t xHadReception )
 {
     uint32_t ulStatus, ulBitMask = 1U;
     BaseType_t xPhyIndex;
     BaseType_t xNeedCheck = pdFALSE;
+    BaseType_t xInterrupt = pxPhyObject->xLinkInterruptPending;
+
+    if( pxPhyObject->ulNegotiatingMask != 0U )
+    {
+        /* The link goes down while negotiating, wait for the result
+         * of ulPhyCheckAutoNegotiation(). */
+        xInterrupt = pdFALSE;
+    }
+    else if( xInterrupt != pdFALSE )
+    {
+        pxPhyObject->xLinkInterruptPending = pdFALSE;
+    }
+    else
+    {
+        /* No interrupt from the PHY. */
+    }
 
-    if( xHadReception > 0 )
+    if( pxPhyObject->ulNegotiatingMask != 0U )
+    {
+        /* Nothing to check. */
+    }
+    else if( ( xHadReception > 0 ) && ( xInterrupt == pdFALSE ) )
     {
         /* A packet was received. No need to check for the PHY status now,
          * but set a timer to check it later on. */
         vTaskSetTimeOutState( &( pxPhyObject->xLinkStatusTimer ) );
         pxPhyObject->xLinkStatusRemaining = pdMS_TO_TICKS( ipconfigPHY_LS_HIGH_CHECK_TIME_MS );
+        pxPhyObject->xLinkStatusInterval = pxPhyObject->xLinkStatusRemaining;
 
         for( xPhyIndex = 0; xPhyIndex < pxPhyObject->xPortCount; xPhyIndex++, ulBitMask <<= 1 )
         {
@@ -759,15 +920,23 @@ BaseType_t xPhyCheckLinkStatus( EthernetPhy_t * pxPhyObject,
             }
         }
     }
-    else if( xTaskCheckForTimeOut( &( pxPhyObject->xLinkStatusTimer ), &( pxPhyObject->xLinkStatusRemaining ) ) != pdFALSE )
+    else if( ( xInterrupt != pdFALSE ) ||
+             ( xTaskCheckForTimeOut( &( pxPhyObject->xLinkStatusTimer ), &( pxPhyObject->xLinkStatusRemaining ) ) != pdFALSE ) )
     {
         /* Frequent checking the PHY Link Status can affect for the performance of Ethernet controller.
          * As long as packets are received, no polling is needed.
-         * Otherwise, polling will be done when the 'xLinkStatusTimer' expires. */
+         * Otherwise, polling will be done when the 'xLinkStatusTimer' expires,
+         * or when a PHY signals a change through its interrupt pin. */
         for( xPhyIndex = 0; xPhyIndex < pxPhyObject->xPortCount; xPhyIndex++, ulBitMask <<= 1 )
         {
             BaseType_t xPhyAddress = pxPhyObject->ucPhyIndexes[ xPhyIndex ];
 
+            if( ( xInterrupt != pdFALSE ) && ( ( pxPhyObject->ulLinkInterruptMask & ulBitMask ) != 0U ) )
+            {
+                /* Reading the status clears it, and releases the pin. */
+                pxPhyObject->fnPhyRead( xPhyAddress, ( BaseType_t ) ulLinkInterruptRegister( pxPhyObject->ulPhyIDs[ xPhyIndex ] ), &ulStatus );
+            }
+
             if( pxPhyObject->fnPhyRead( xPhyAddress, phyREG_01_BMSR, &ulStatus ) == 0 )
             {
                 if( !!( pxPhyObject->ulLinkStatusMask & ulBitMask ) != !!( ulStatus & phyBMSR_LINK_STATUS ) )
@@ -788,19 +957,101 @@ BaseType_t xPhyCheckLinkStatus( EthernetPhy_t * pxPhyObject,
         }
 
         vTaskSetTimeOutState( &( pxPhyObject->xLinkStatusTimer ) );
+        pxPhyObject->xLinkStatusRemaining = xLinkStatusNextCheck( pxPhyObject,
+                                                                  ( ( pxPhyObject->ulLinkStatusMask & ( ulBitMask >> 1 ) ) != 0U ) ? pdTRUE : pdFALSE,
+                                                                  xNeedCheck );
+    }
+
+    return xNeedCheck;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPhyEnableLinkInterrupt( EthernetPhy_t * pxPhyObject,
+                                   uint32_t ulPhyMask )
+{
+    BaseType_t xPhyIndex;
+    uint32_t ulBitMask = 1U;
+    uint32_t ulValue;
+
+    for( xPhyIndex = 0; xPhyIndex < pxPhyObject->xPortCount; xPhyIndex++, ulBitMask <<= 1 )
+    {
+        if( ( ulPhyMask & ulBitMask ) != 0U )
+        {
+            BaseType_t xPhyAddress = pxPhyObject->ucPhyIndexes[ xPhyIndex ];
+            uint32_t ulRegister = ulLinkInterruptRegister( pxPhyObject->ulPhyIDs[ xPhyIndex ] );
+
+            switch( ulRegister )
+            {
+                case phyREG_1D_ISFR:
+                    pxPhyObject->fnPhyWrite( xPhyAddress, phyREG_1E_IMR, phyIMR_LINK_DOWN | phyIMR_AN_COMPLETE );
+                    break;
+
+                case phyREG_1B_ICSR:
+                    pxPhyObject->fnPhyWrite( xPhyAddress, phyREG_1B_ICSR, phyICSR_LINK_UP_EN | phyICSR_LINK_DOWN_EN );
+                    break;
+
+                case phyREG_12_MISR:
+                    pxPhyObject->fnPhyWrite( xPhyAddress, phyREG_12_MISR, phyMISR_LINK_INT_EN | phyMISR_ANC_INT_EN );
+                    pxPhyObject->fnPhyWrite( xPhyAddress, phyREG_11_MICR, phyMICR_INTEN | phyMICR_INT_OE );
+                    break;
+
+                default:
+                    /* Not supported, this port stays polled. */
+                    break;
+            }
+
+            if( ulRegister != 0U )
+            {
+                /* Clear what was pending before. */
+                pxPhyObject->fnPhyRead( xPhyAddress, ( BaseType_t ) ulRegister, &ulValue );
+                pxPhyObject->ulLinkInterruptMask |= ulBitMask;
+            }
+        }
+    }
+
+    FreeRTOS_printf( ( "ulPhyEnableLinkInterrupt: mask %02X\n", ( unsigned int ) pxPhyObject->ulLinkInterruptMask ) );
+
+    /* Check the link now, a change may have happened before the interrupt
+     * was enabled. */
+    pxPhyObject->xLinkInterruptPending = pdTRUE;
+
+    return pxPhyObject->ulLinkInterruptMask;
+}
+/*-----------------------------------------------------------*/
+
+void vPhyLinkInterruptFromISR( EthernetPhy_t * pxPhyObject )
+{
+    pxPhyObject->xLinkInterruptPending = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPhyGetLinkSpeed( const EthernetPhy_t * pxPhyObject )
+{
+    uint32_t ulSpeed = 0U;
+    uint8_t ucSpeed = pxPhyObject->xPhyProperties.ucSpeed;
 
-        if( ( pxPhyObject->ulLinkStatusMask & ( ulBitMask >> 1 ) ) != 0 )
+    if( ucSpeed == 0U )
+    {
+        /* No auto-negotiation has completed, xPhyFixedValue() used the preferences. */
+        ucSpeed = pxPhyObject->xPhyPreferences.ucSpeed;
+    }
+
+    if( pxPhyObject->ulLinkStatusMask != 0U )
+    {
+        if( ucSpeed == ( uint8_t ) PHY_SPEED_10 )
         {
-            /* The link status is high, so don't poll the PHY too often. */
-            pxPhyObject->xLinkStatusRemaining = pdMS_TO_TICKS( ipconfigPHY_LS_HIGH_CHECK_TIME_MS );
+            ulSpeed = 10U;
+        }
+        else if( ucSpeed == ( uint8_t ) PHY_SPEED_100 )
+        {
+            ulSpeed = 100U;
         }
         else
         {
-            /* The link status is low, polling may be done more frequently. */
-            pxPhyObject->xLinkStatusRemaining = pdMS_TO_TICKS( ipconfigPHY_LS_LOW_CHECK_TIME_MS );
+            /* The speed has not been determined yet. */
         }
     }
 
-    return xNeedCheck;
+    return ulSpeed;
 }
 /*-----------------------------------------------------------*/
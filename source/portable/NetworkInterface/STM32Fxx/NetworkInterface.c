@@ -104,6 +104,12 @@
     #define niDESCRIPTOR_WAIT_TIME_MS    250uL
 #endif
 
+/* The maximum number of received packets that are passed to the IP-task
+ * in a single burst. */
+#ifndef niRX_BURST_LENGTH
+    #define niRX_BURST_LENGTH    8U
+#endif
+
 /*
  * Most users will want a PHY that negotiates about
  * the connection properties: speed, MDIX and duplex.
@@ -1018,47 +1024,10 @@ static BaseType_t xMayAcceptPacket( uint8_t * pucEthernetBuffer )
 }
 /*-----------------------------------------------------------*/
 
-static void prvPassEthMessages( NetworkBufferDescriptor_t * pxDescriptor )
-{
-    IPStackEvent_t xRxEvent;
-
-    xRxEvent.eEventType = eNetworkRxEvent;
-    xRxEvent.pvData = ( void * ) pxDescriptor;
-
-    if( xSendEventStructToIPTask( &xRxEvent, ( TickType_t ) 1000 ) != pdPASS )
-    {
-        /* The buffer could not be sent to the stack so must be released again.
-         * This is a deferred handler task, not a real interrupt, so it is ok to
-         * use the task level function here. */
-        #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-        {
-            do
-            {
-                NetworkBufferDescriptor_t * pxNext = pxDescriptor->pxNextBuffer;
-                vReleaseNetworkBufferAndDescriptor( pxDescriptor );
-                pxDescriptor = pxNext;
-            } while( pxDescriptor != NULL );
-        }
-        #else
-        {
-            vReleaseNetworkBufferAndDescriptor( pxDescriptor );
-        }
-        #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
-        iptraceETHERNET_RX_EVENT_LOST();
-        FreeRTOS_printf( ( "prvPassEthMessages: Can not queue return packet!\n" ) );
-    }
-    else
-    {
-        iptraceNETWORK_INTERFACE_RECEIVE();
-    }
-}
-
 static BaseType_t prvNetworkInterfaceInput( void )
 {
-    #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-        NetworkBufferDescriptor_t * pxFirstDescriptor = NULL;
-        NetworkBufferDescriptor_t * pxLastDescriptor = NULL;
-    #endif
+    NetworkBufferDescriptor_t * pxBurst[ niRX_BURST_LENGTH ];
+    size_t uxBurstCount = 0U;
     BaseType_t xReceivedLength = 0;
     __IO ETH_DMADescTypeDef * pxDMARxDescriptor;
     const TickType_t xDescriptorWaitTime = pdMS_TO_TICKS( niDESCRIPTOR_WAIT_TIME_MS );
@@ -1139,28 +1108,12 @@ static BaseType_t prvNetworkInterfaceInput( void )
             pxCurDescriptor->pxInterface = pxMyInterface;
             pxCurDescriptor->pxEndPoint = FreeRTOS_MatchingEndpoint( pxMyInterface, pxCurDescriptor->pucEthernetBuffer );
 
-            #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-            {
-                pxCurDescriptor->pxNextBuffer = NULL;
-
-                if( pxFirstDescriptor == NULL )
-                {
-                    /* Becomes the first message */
-                    pxFirstDescriptor = pxCurDescriptor;
-                }
-                else if( pxLastDescriptor != NULL )
-                {
-                    /* Add to the tail */
-                    pxLastDescriptor->pxNextBuffer = pxCurDescriptor;
-                }
+            iptraceNETWORK_INTERFACE_RECEIVE();
 
-                pxLastDescriptor = pxCurDescriptor;
-            }
-            #else /* if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 ) */
-            {
-                prvPassEthMessages( pxCurDescriptor );
-            }
-            #endif /* if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 ) */
+            /* Collect the buffer, the IP-task will be informed once the
+             * burst is complete. */
+            pxBurst[ uxBurstCount ] = pxCurDescriptor;
+            uxBurstCount++;
         }
 
         /* Release descriptors to DMA */
@@ -1198,16 +1151,20 @@ static BaseType_t prvNetworkInterfaceInput( void )
         }
 
         pxDMARxDescriptor = xETH.RxDesc;
-    }
 
-    #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-    {
-        if( pxFirstDescriptor != NULL )
+        if( uxBurstCount == niRX_BURST_LENGTH )
         {
-            prvPassEthMessages( pxFirstDescriptor );
+            /* Pass all collected buffers to the IP-task in one go.  Buffers
+             * that can not be delivered are released by the IP-stack. */
+            ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, ( TickType_t ) 1000 );
+            uxBurstCount = 0U;
         }
     }
-    #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+
+    if( uxBurstCount > 0U )
+    {
+        ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, ( TickType_t ) 1000 );
+    }
 
     return( xReceivedLength > 0 );
 }
@@ -91,6 +91,29 @@
     #define ipconfigEMAC_TASK_HOOK()
 #endif
 
+/* The maximum number of received packets that are passed to the IP-task
+ * in a single burst. */
+#ifndef niRX_BURST_LENGTH
+    #define niRX_BURST_LENGTH    8U
+#endif
+
+/* RX interrupt coalescing.  When niEMAC_RX_WATCHDOG_TIMEOUT is not zero, only
+ * every niEMAC_RX_IOC_INTERVAL-th RX descriptor interrupts when a frame is
+ * received in it.  For the other frames, the DMA RX interrupt watchdog raises
+ * the interrupt after niEMAC_RX_WATCHDOG_TIMEOUT * 256 clock cycles of the
+ * Ethernet bus, unless a later frame did so already. */
+#ifndef niEMAC_RX_WATCHDOG_TIMEOUT
+    #define niEMAC_RX_WATCHDOG_TIMEOUT    0U
+#endif
+
+#ifndef niEMAC_RX_IOC_INTERVAL
+    #define niEMAC_RX_IOC_INTERVAL    ( ETH_RX_DESC_CNT / 2U )
+#endif
+
+#if ( niEMAC_RX_WATCHDOG_TIMEOUT > 0xFFU )
+    #error niEMAC_RX_WATCHDOG_TIMEOUT must fit in the 8-bit RWT field
+#endif
+
 /* Bit map of outstanding ETH interrupt events for processing. */
 static volatile uint32_t ulISREvents;
 
@@ -150,9 +173,13 @@ ETH_DMADescTypeDef DMATxDscrTab[ ETH_TX_DESC_CNT ]    __attribute__( ( section(
 /* This function binds PHY IO functions, then inits and configures */
 static void prvMACBProbePhy( void );
 
-/* Force a negotiation with the Switch or Router and wait for LS. */
+/* Start a negotiation with the Switch or Router, prvEMACHandlerTask() will
+ * see it complete. */
 static void prvEthernetUpdateConfig( BaseType_t xForce );
 
+/* Configure the MAC with the results of the negotiation. */
+static void prvEthernetApplyConfig( void );
+
 /* Holds the handle of the task used as a deferred interrupt processor.  The
  * handle is used so direct notifications can be sent to the task for all EMAC/DMA
  * related interrupts. */
@@ -361,6 +388,16 @@ static BaseType_t xSTM32H_NetworkInterfaceInitialise( NetworkInterface_t * pxInt
             /* Update MAC filter settings */
             xEthHandle.Instance->MACPFR |= ENABLE_HASH_FILTER_SETTINGS;
 
+            #if ( niEMAC_RX_WATCHDOG_TIMEOUT != 0U )
+            {
+                /* Coalesce the RX interrupts, HAL_ETH_Start_IT() and
+                 * HAL_ETH_BuildRxDescriptors() will only set the IOC bit in
+                 * every niEMAC_RX_IOC_INTERVAL-th descriptor. */
+                xEthHandle.RxDescList.IOCInterval = niEMAC_RX_IOC_INTERVAL;
+                xEthHandle.Instance->DMACRIWTR = niEMAC_RX_WATCHDOG_TIMEOUT;
+            }
+            #endif
+
             /* Configuration for HAL_ETH_Transmit(_IT). */
             memset( &( xTxConfig ), 0, sizeof( ETH_TxPacketConfig ) );
             xTxConfig.Attributes = ETH_TX_PACKETS_FEATURES_CRCPAD;
@@ -479,7 +516,9 @@ static BaseType_t xSTM32H_NetworkInterfaceInitialise( NetworkInterface_t * pxInt
             /* Initialize the MACB and set all PHY properties */
             prvMACBProbePhy();
 
-            /* Force a negotiation with the Switch or Router and wait for LS. */
+            /* Force a negotiation with the Switch or Router.  It is not waited
+             * for, prvEMACHandlerTask() will call FreeRTOS_NetworkInterfaceReady()
+             * once the Link Status is high. */
             prvEthernetUpdateConfig( pdTRUE );
 
             /* The deferred interrupt handler task is created at the highest
@@ -694,69 +733,76 @@ static void prvMACBProbePhy( void )
 
 static void prvEthernetUpdateConfig( BaseType_t xForce )
 {
-    ETH_MACConfigTypeDef MACConf;
-    uint32_t speed = 0, duplex = 0;
-
     FreeRTOS_printf( ( "prvEthernetUpdateConfig: LS mask %02lX Force %d\n",
                        xPhyObject.ulLinkStatusMask,
                        ( int ) xForce ) );
 
     if( ( xForce != pdFALSE ) || ( xPhyObject.ulLinkStatusMask != 0 ) )
     {
-        /* Restart the auto-negotiation. */
-        xPhyStartAutoNegotiation( &xPhyObject, xPhyGetMask( &( xPhyObject ) ) );
-
-        /* Configure the MAC with the Duplex Mode fixed by the
-         * auto-negotiation process. */
-        if( xPhyObject.xPhyProperties.ucDuplex == PHY_DUPLEX_FULL )
-        {
-            duplex = ETH_FULLDUPLEX_MODE;
-        }
-        else
-        {
-            duplex = ETH_HALFDUPLEX_MODE;
-        }
+        /* Restart the auto-negotiation, prvEthernetApplyConfig() will be
+         * called when it is ready. */
+        xPhyStartAutoNegotiationAsync( &xPhyObject, xPhyGetMask( &( xPhyObject ) ) );
+    }
+    else
+    {
+        /* Stop MAC interface */
+        HAL_ETH_Stop_IT( &( xEthHandle ) );
+    }
+}
+/*-----------------------------------------------------------*/
 
-        /* Configure the MAC with the speed fixed by the
-         * auto-negotiation process. */
-        if( xPhyObject.xPhyProperties.ucSpeed == PHY_SPEED_10 )
-        {
-            speed = ETH_SPEED_10M;
-        }
-        else
-        {
-            speed = ETH_SPEED_100M;
-        }
+static void prvEthernetApplyConfig( void )
+{
+    ETH_MACConfigTypeDef MACConf;
+    uint32_t speed = 0, duplex = 0;
 
-        /* Get MAC and configure it */
-        HAL_ETH_GetMACConfig( &( xEthHandle ), &( MACConf ) );
-        MACConf.DuplexMode = duplex;
-        MACConf.Speed = speed;
-        HAL_ETH_SetMACConfig( &( xEthHandle ), &( MACConf ) );
-        #if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM != 0 )
-        {
-            MACConf.ChecksumOffload = ENABLE;
-        }
-        #else
-        {
-            MACConf.ChecksumOffload = DISABLE;
-        }
-        #endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM != 0 ) */
+    /* Configure the MAC with the Duplex Mode fixed by the
+     * auto-negotiation process. */
+    if( xPhyObject.xPhyProperties.ucDuplex == PHY_DUPLEX_FULL )
+    {
+        duplex = ETH_FULLDUPLEX_MODE;
+    }
+    else
+    {
+        duplex = ETH_HALFDUPLEX_MODE;
+    }
 
-        /* Restart MAC interface */
-        HAL_ETH_Start_IT( &( xEthHandle ) );
+    /* Configure the MAC with the speed fixed by the
+     * auto-negotiation process. */
+    if( xPhyObject.xPhyProperties.ucSpeed == PHY_SPEED_10 )
+    {
+        speed = ETH_SPEED_10M;
     }
     else
     {
-        /* Stop MAC interface */
-        HAL_ETH_Stop_IT( &( xEthHandle ) );
+        speed = ETH_SPEED_100M;
     }
+
+    /* Get MAC and configure it */
+    HAL_ETH_GetMACConfig( &( xEthHandle ), &( MACConf ) );
+    MACConf.DuplexMode = duplex;
+    MACConf.Speed = speed;
+    HAL_ETH_SetMACConfig( &( xEthHandle ), &( MACConf ) );
+    #if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM != 0 )
+    {
+        MACConf.ChecksumOffload = ENABLE;
+    }
+    #else
+    {
+        MACConf.ChecksumOffload = DISABLE;
+    }
+    #endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM != 0 ) */
+
+    /* Restart MAC interface */
+    HAL_ETH_Start_IT( &( xEthHandle ) );
 }
 /*-----------------------------------------------------------*/
 
 static BaseType_t prvNetworkInterfaceInput( void )
 {
     BaseType_t xReturn = 0;
+    NetworkBufferDescriptor_t * pxBurst[ niRX_BURST_LENGTH ];
+    size_t uxBurstCount = 0U;
 
     /* For as long as a packet is immediately available. */
     for( ; ; )
@@ -863,55 +909,39 @@ static BaseType_t prvNetworkInterfaceInput( void )
 
         if( pxReceivedBuffer != NULL )
         {
-            BaseType_t xDoRelease = pdFALSE;
-
             if( eConsiderFrameForProcessing( pxReceivedBuffer->pucEthernetBuffer ) != eProcessBuffer )
             {
                 /* The Ethernet frame can be dropped, but the Ethernet buffer must be released. */
-                xDoRelease = pdTRUE;
+                vReleaseNetworkBufferAndDescriptor( pxReceivedBuffer );
             }
             else
             {
-                /* The event about to be sent to the TCP/IP is an Rx event.
-                 * pvData is used to point to the network buffer descriptor that
-                 * now references the received data. */
-
-                IPStackEvent_t xRxEvent =
-                {
-                    .eEventType = eNetworkRxEvent,
-                    .pvData     = ( void * ) pxReceivedBuffer
-                };
-
+                /* Collect the buffer, the IP-task will be informed once the
+                 * burst is complete. */
                 pxReceivedBuffer->pxInterface = pxMyInterface;
                 pxReceivedBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxMyInterface, pxReceivedBuffer->pucEthernetBuffer );
 
-                /* Send the data to the TCP/IP stack. */
-                if( xSendEventStructToIPTask( &( xRxEvent ), 0 ) != pdFALSE )
-                {
-                    /* The message was successfully sent to the TCP/IP stack.
-                    * Call the standard trace macro to log the occurrence. */
-                    iptraceNETWORK_INTERFACE_RECEIVE();
-                }
-                else
-                {
-                    xDoRelease = pdTRUE;
+                iptraceNETWORK_INTERFACE_RECEIVE();
 
-                    /* The buffer could not be sent to the IP task so the buffer
-                     * must be released. */
-
-                    /* Make a call to the standard trace macro to log the
-                     * occurrence. */
-                    iptraceETHERNET_RX_EVENT_LOST();
-                }
+                pxBurst[ uxBurstCount ] = pxReceivedBuffer;
+                uxBurstCount++;
             }
+        }
 
-            if( xDoRelease != pdFALSE )
-            {
-                vReleaseNetworkBufferAndDescriptor( pxReceivedBuffer );
-            }
+        if( uxBurstCount == niRX_BURST_LENGTH )
+        {
+            /* Pass all collected buffers to the IP-task in one go.  Buffers
+             * that can not be delivered are released by the IP-stack. */
+            ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, 0U );
+            uxBurstCount = 0U;
         }
     }
 
+    if( uxBurstCount > 0U )
+    {
+        ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, 0U );
+    }
+
     return xReturn;
 }
 /*-----------------------------------------------------------*/
@@ -1169,7 +1199,20 @@ static void prvEMACHandlerTask( void * pvParameters )
             xResult += prvNetworkInterfaceInput();
         }
 
-        if( xPhyCheckLinkStatus( &xPhyObject, xResult ) != pdFALSE )
+        if( xPhyObject.ulNegotiatingMask != 0U )
+        {
+            if( ulPhyCheckAutoNegotiation( &xPhyObject ) == 0U )
+            {
+                prvEthernetApplyConfig();
+
+                if( xPhyObject.ulLinkStatusMask != 0U )
+                {
+                    /* Do not wait for the IP-task to retry the initialisation. */
+                    FreeRTOS_NetworkInterfaceReady( pxMyInterface );
+                }
+            }
+        }
+        else if( xPhyCheckLinkStatus( &xPhyObject, xResult ) != pdFALSE )
         {
             /*
              * The function xPhyCheckLinkStatus() returns pdTRUE if the
@@ -242,6 +242,11 @@ extern SemaphoreHandle_t xTXDescriptorSemaphore;
             ( inx ) = ( ( inx ) - ( uint32_t ) ETH_RX_DESC_CNT ); } \
     } while( 0 )
 
+/* Non-zero when the Rx descriptor 'inx' must generate an interrupt on completion. */
+        #define RX_DESC_WANTS_IOC( list, inx )                                   \
+    ( ( ( list )->ItMode != 0U ) &&                                              \
+      ( ( ( list )->IOCInterval <= 1U ) || ( ( ( ( inx ) + 1U ) % ( list )->IOCInterval ) == 0U ) ) )
+
 /**
  * @}
  */
@@ -865,17 +870,26 @@ extern SemaphoreHandle_t xTXDescriptorSemaphore;
             {
                 heth->gState = HAL_ETH_STATE_BUSY;
 
-                /* Set IOC bit (Interrupt Enabled on Completion) to all Rx descriptors */
+                /* save IT mode to ETH Handle */
+                heth->RxDescList.ItMode = 1U;
+
+                /* Set IOC bit (Interrupt Enabled on Completion) to the Rx descriptors,
+                 * to every IOCInterval-th one when interrupts are coalesced. */
                 for( desc_index = 0; desc_index < ( uint32_t ) ETH_RX_DESC_CNT; desc_index++ )
                 {
                     ETH_DMADescTypeDef * dma_rx_desc;
 
                     dma_rx_desc = ( ETH_DMADescTypeDef * ) heth->RxDescList.RxDesc[ desc_index ];
-                    SET_BIT( dma_rx_desc->DESC3, ETH_DMARXNDESCRF_IOC );
-                }
 
-                /* save IT mode to ETH Handle */
-                heth->RxDescList.ItMode = 1U;
+                    if( RX_DESC_WANTS_IOC( &( heth->RxDescList ), desc_index ) )
+                    {
+                        SET_BIT( dma_rx_desc->DESC3, ETH_DMARXNDESCRF_IOC );
+                    }
+                    else
+                    {
+                        CLEAR_BIT( dma_rx_desc->DESC3, ETH_DMARXNDESCRF_IOC );
+                    }
+                }
 
                 /* Enable the MAC transmission */
                 SET_BIT( heth->Instance->MACCR, ETH_MACCR_TE );
@@ -1499,7 +1513,7 @@ extern SemaphoreHandle_t xTXDescriptorSemaphore;
                 /* Should be the last change. */
 /*		SET_BIT(DESC3, ETH_DMARXNDESCRF_OWN); */
 
-                if( dmarxdesclist->ItMode != 0U )
+                if( RX_DESC_WANTS_IOC( dmarxdesclist, desc_index ) )
                 {
                     /* Interrupt Enabled on Completion */
                     SET_BIT( DESC3, ETH_DMARXNDESCRF_IOC );
@@ -265,6 +265,10 @@
 
             uint32_t ItMode;                    /*<! If 1, DMA will generate the Rx complete interrupt.
                                                  * If 0, DMA will not generate the Rx complete interrupt. */
+
+            uint32_t IOCInterval;               /*<! If larger than 1, only every IOCInterval-th Rx descriptor
+                                                 * generates the Rx complete interrupt.  The Rx interrupt
+                                                 * watchdog (DMACRIWTR) must be set to cover the others. */
         } ETH_RxDescListTypeDef;
 
 /**
@@ -217,20 +217,20 @@ static void prvCreateThreadSafeBuffers( void )
      * the Win32 thread that sends via the WinPCAP library. */
     if( xSendBuffer == NULL )
     {
-        xSendBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) + xSEND_BUFFER_SIZE + 1 );
+        xSendBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) + uxStreamBufferLength( xSEND_BUFFER_SIZE ) );
         configASSERT( xSendBuffer );
         memset( xSendBuffer, '\0', sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) );
-        xSendBuffer->LENGTH = xSEND_BUFFER_SIZE + 1;
+        xSendBuffer->LENGTH = uxStreamBufferLength( xSEND_BUFFER_SIZE );
     }
 
     /* The buffer used to pass received data from the Win32 thread that receives
      * via the WinPCAP library to the FreeRTOS task. */
     if( xRecvBuffer == NULL )
     {
-        xRecvBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) + xRECV_BUFFER_SIZE + 1 );
+        xRecvBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) + uxStreamBufferLength( xRECV_BUFFER_SIZE ) );
         configASSERT( xRecvBuffer );
         memset( xRecvBuffer, '\0', sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) );
-        xRecvBuffer->LENGTH = xRECV_BUFFER_SIZE + 1;
+        xRecvBuffer->LENGTH = uxStreamBufferLength( xRECV_BUFFER_SIZE );
     }
 }
 
@@ -613,11 +613,20 @@ static void prvEMACHandlerTask( void * pvParameters )
             xResult = emacps_check_rx( pxEMAC_PS, pxMyInterfaces[ xEMACIndex ] );
         }
 
-        if( ( pxEMAC_PS->isr_events & EMAC_IF_TX_EVENT ) != 0 )
+        #if ( niEMAC_TX_RECLAIM_THRESHOLD != 0 )
         {
+            /* There is no TX-complete interrupt, take back the buffers that
+             * emacps_send_message() has not reclaimed yet. */
             pxEMAC_PS->isr_events &= ~EMAC_IF_TX_EVENT;
             emacps_check_tx( pxEMAC_PS );
         }
+        #else
+            if( ( pxEMAC_PS->isr_events & EMAC_IF_TX_EVENT ) != 0 )
+            {
+                pxEMAC_PS->isr_events &= ~EMAC_IF_TX_EVENT;
+                emacps_check_tx( pxEMAC_PS );
+            }
+        #endif /* ( niEMAC_TX_RECLAIM_THRESHOLD != 0 ) */
 
         if( ( pxEMAC_PS->isr_events & EMAC_IF_ERR_EVENT ) != 0 )
         {
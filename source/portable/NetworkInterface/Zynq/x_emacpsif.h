@@ -78,6 +78,39 @@
     #define EMAC_IF_ERR_EVENT                      4
     #define EMAC_IF_ALL_EVENT                      7
 
+/* When non-zero, finished TX descriptors are reclaimed lazily by
+ * emacps_send_message() once this many descriptors are in use, and the
+ * TX-complete interrupt is left disabled.  The EMAC task picks up whatever
+ * is left over each time it wakes up.  0 means: reclaim from the
+ * TX-complete interrupt, as before. */
+    #ifndef niEMAC_TX_RECLAIM_THRESHOLD
+        #define niEMAC_TX_RECLAIM_THRESHOLD    0
+    #endif
+
+/* When non-zero, emacps_check_rx() handles at most this many frames per call.
+ * The RX interrupt stays masked while the EMAC task is polling the ring, and
+ * it is only enabled again once the ring has been emptied. */
+    #ifndef niEMAC_RX_BUDGET
+        #define niEMAC_RX_BUDGET    0
+    #endif
+
+/* The GEM interrupt moderation register delays the RX and TX interrupts
+ * by a number of 800 ns units ( at 1 Gbps ), so that several frames are
+ * handled per interrupt.  Both fields are 8 bits wide, 0 disables moderation.
+ * The register is present on the GEM of the Zynq UltraScale+; the GEM of the
+ * Zynq-7000 does not have it, so leave both values at 0 there. */
+    #ifndef niEMAC_RX_INTR_MODERATION
+        #define niEMAC_RX_INTR_MODERATION    0
+    #endif
+
+    #ifndef niEMAC_TX_INTR_MODERATION
+        #define niEMAC_TX_INTR_MODERATION    0
+    #endif
+
+    #ifndef XEMACPS_INTR_MODERATION_OFFSET
+        #define XEMACPS_INTR_MODERATION_OFFSET    0x0000005CU
+    #endif
+
 /* structure within each netif, encapsulating all information required for
  * using a particular temac instance
  */
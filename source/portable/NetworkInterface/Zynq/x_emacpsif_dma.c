@@ -89,8 +89,22 @@
 #endif
 #define TX_OFFSET               ipconfigPACKET_FILLER_SIZE
 
+/* The maximum number of received packets that are passed to the IP-task
+ * in a single burst. */
+#ifndef niRX_BURST_LENGTH
+    #define niRX_BURST_LENGTH    8U
+#endif
+
 #define dmaRX_TX_BUFFER_SIZE    1536
 
+#if ( niEMAC_TX_RECLAIM_THRESHOLD < 0 ) || ( niEMAC_TX_RECLAIM_THRESHOLD > ipconfigNIC_N_TX_DESC )
+    #error niEMAC_TX_RECLAIM_THRESHOLD must be between 0 and ipconfigNIC_N_TX_DESC
+#endif
+
+#if ( niEMAC_RX_INTR_MODERATION > 0xFF ) || ( niEMAC_TX_INTR_MODERATION > 0xFF )
+    #error niEMAC_RX_INTR_MODERATION and niEMAC_TX_INTR_MODERATION must fit in 8 bits
+#endif
+
 /* Defined in NetworkInterface.c */
 extern TaskHandle_t xEMACTaskHandles[ XPAR_XEMACPS_NUM_INSTANCES ];
 
@@ -115,9 +129,15 @@ extern struct xtopology_t xXTopologies[ XPAR_XEMACPS_NUM_INSTANCES ];
 
 static SemaphoreHandle_t xTXDescriptorSemaphores[ XPAR_XEMACPS_NUM_INSTANCES ];
 
-BaseType_t xMayAcceptPacket( uint8_t * pucEthernetBuffer );
+#if ( niEMAC_TX_RECLAIM_THRESHOLD != 0 )
 
-static void prvPassEthMessages( NetworkBufferDescriptor_t * pxDescriptor );
+/* TX descriptors are reclaimed by both the EMAC task and the task that
+ * calls emacps_send_message(), this mutex makes sure only one of them
+ * is walking the TX ring. */
+    static SemaphoreHandle_t xTXReclaimMutexes[ XPAR_XEMACPS_NUM_INSTANCES ];
+#endif
+
+BaseType_t xMayAcceptPacket( uint8_t * pucEthernetBuffer );
 
 /*
  *  The FreeRTOS+TCP port does not make use of "src/xemacps_bdring.c".
@@ -143,7 +163,7 @@ int is_tx_space_available( xemacpsif_s * xemacpsif )
     return uxCount;
 }
 
-void emacps_check_tx( xemacpsif_s * xemacpsif )
+static void prvReclaimTXDescriptors( xemacpsif_s * xemacpsif )
 {
     int tail = xemacpsif->txTail;
     int head = xemacpsif->txHead;
@@ -203,6 +223,68 @@ void emacps_check_tx( xemacpsif_s * xemacpsif )
     }
 }
 
+void emacps_check_tx( xemacpsif_s * xemacpsif )
+{
+    #if ( niEMAC_TX_RECLAIM_THRESHOLD != 0 )
+    {
+        BaseType_t xEMACIndex = xemacpsif->emacps.Config.DeviceId;
+
+        if( xSemaphoreTake( xTXReclaimMutexes[ xEMACIndex ], portMAX_DELAY ) == pdPASS )
+        {
+            prvReclaimTXDescriptors( xemacpsif );
+            ( void ) xSemaphoreGive( xTXReclaimMutexes[ xEMACIndex ] );
+        }
+    }
+    #else
+    {
+        prvReclaimTXDescriptors( xemacpsif );
+    }
+    #endif /* ( niEMAC_TX_RECLAIM_THRESHOLD != 0 ) */
+}
+
+#if ( niEMAC_TX_RECLAIM_THRESHOLD != 0 )
+
+/*
+ * Called from emacps_send_message(): take a TX descriptor, reclaiming the
+ * finished ones first when enough of them are in use.  Because the TX-complete
+ * interrupt is not used, a full ring is polled until the EMAC has sent a frame.
+ */
+    static BaseType_t prvTakeTXDescriptor( xemacpsif_s * xemacpsif,
+                                           TickType_t xBlockTimeTicks )
+    {
+        BaseType_t xEMACIndex = xemacpsif->emacps.Config.DeviceId;
+        BaseType_t xReturn;
+        TimeOut_t xTimeOut;
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            if( is_tx_space_available( xemacpsif ) >= niEMAC_TX_RECLAIM_THRESHOLD )
+            {
+                /* Do not wait for the EMAC task if it is busy reclaiming. */
+                if( xSemaphoreTake( xTXReclaimMutexes[ xEMACIndex ], 0U ) == pdPASS )
+                {
+                    prvReclaimTXDescriptors( xemacpsif );
+                    ( void ) xSemaphoreGive( xTXReclaimMutexes[ xEMACIndex ] );
+                }
+            }
+
+            xReturn = xSemaphoreTake( xTXDescriptorSemaphores[ xEMACIndex ], 0U );
+
+            if( ( xReturn == pdPASS ) || ( xTaskCheckForTimeOut( &xTimeOut, &xBlockTimeTicks ) != pdFALSE ) )
+            {
+                break;
+            }
+
+            /* All descriptors are still owned by the DMA. */
+            vTaskDelay( 1U );
+        }
+
+        return xReturn;
+    }
+#endif /* ( niEMAC_TX_RECLAIM_THRESHOLD != 0 ) */
+
 void emacps_send_handler( void * arg )
 {
     xemacpsif_s * xemacpsif;
@@ -275,7 +357,11 @@ XStatus emacps_send_message( xemacpsif_s * xemacpsif,
             break;
         }
 
-        if( xSemaphoreTake( xTXDescriptorSemaphores[ xEMACIndex ], xBlockTimeTicks ) != pdPASS )
+        #if ( niEMAC_TX_RECLAIM_THRESHOLD != 0 )
+            if( prvTakeTXDescriptor( xemacpsif, xBlockTimeTicks ) != pdPASS )
+        #else
+            if( xSemaphoreTake( xTXDescriptorSemaphores[ xEMACIndex ], xBlockTimeTicks ) != pdPASS )
+        #endif
         {
             FreeRTOS_printf( ( "emacps_send_message: Time-out waiting for TX buffer\n" ) );
             break;
@@ -369,6 +455,13 @@ void emacps_recv_handler( void * arg )
      * But it forgets to do a read-back. Do so now. */
     ( void ) XEmacPs_ReadReg( xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET );
 
+    #if ( niEMAC_RX_BUDGET != 0 )
+    {
+        /* The EMAC task will poll the RX ring, no more interrupts until it is empty. */
+        XEmacPs_WriteReg( xemacpsif->emacps.Config.BaseAddress, XEMACPS_IDR_OFFSET, XEMACPS_IXR_FRAMERX_MASK );
+    }
+    #endif
+
     if( xEMACTaskHandles[ xEMACIndex ] != NULL )
     {
         vTaskNotifyGiveFromISR( xEMACTaskHandles[ xEMACIndex ], &xHigherPriorityTaskWoken );
@@ -378,38 +471,6 @@ void emacps_recv_handler( void * arg )
 }
 /*-----------------------------------------------------------*/
 
-static void prvPassEthMessages( NetworkBufferDescriptor_t * pxDescriptor )
-{
-    IPStackEvent_t xRxEvent;
-
-    xRxEvent.eEventType = eNetworkRxEvent;
-    xRxEvent.pvData = ( void * ) pxDescriptor;
-
-    if( xSendEventStructToIPTask( &xRxEvent, ( TickType_t ) 1000 ) != pdPASS )
-    {
-        /* The buffer could not be sent to the IP-task so it must be released again.
-         * This is a deferred handler taskr, not a real interrupt, so it is ok to
-         * use the task level function here. */
-        #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-        {
-            do
-            {
-                NetworkBufferDescriptor_t * pxNext = pxDescriptor->pxNextBuffer;
-                vReleaseNetworkBufferAndDescriptor( pxDescriptor );
-                pxDescriptor = pxNext;
-            } while( pxDescriptor != NULL );
-        }
-        #else
-        {
-            vReleaseNetworkBufferAndDescriptor( pxDescriptor );
-        }
-        #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
-        iptraceETHERNET_RX_EVENT_LOST();
-        FreeRTOS_printf( ( "prvPassEthMessages: Can not queue return packet!\n" ) );
-    }
-}
-/*-----------------------------------------------------------*/
-
 BaseType_t xMayAcceptPacket( uint8_t * pucEthernetBuffer )
 {
     const ProtocolPacket_t * pxProtPacket = ( const ProtocolPacket_t * ) pucEthernetBuffer;
@@ -494,17 +555,18 @@ int emacps_check_rx( xemacpsif_s * xemacpsif,
     BaseType_t xEMACIndex = xemacpsif->emacps.Config.DeviceId;
     BaseType_t xAccepted;
 
-    #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-        NetworkBufferDescriptor_t * pxFirstDescriptor = NULL;
-        NetworkBufferDescriptor_t * pxLastDescriptor = NULL;
-    #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+    #if ( niEMAC_RX_BUDGET != 0 )
+        int iBudget = niEMAC_RX_BUDGET;
+    #endif
+
+    NetworkBufferDescriptor_t * pxBurst[ niRX_BURST_LENGTH ];
+    size_t uxBurstCount = 0U;
 
     /* There seems to be an issue (SI# 692601), see comments below. */
     resetrx_on_no_rxdata( xemacpsif );
 
-    /* This FreeRTOS+TCP driver shall be compiled with the option
-     * "ipconfigUSE_LINKED_RX_MESSAGES" enabled.  It allows the driver to send a
-     * chain of RX messages within one message to the IP-task. */
+    /* Received packets are passed to the IP-task in bursts of at most
+     * niRX_BURST_LENGTH packets, each burst within one message. */
     for( ; ; )
     {
         if( ( ( xemacpsif->rxSegments[ rxHead ].address & XEMACPS_RXBUF_NEW_MASK ) == 0 ) ||
@@ -513,6 +575,17 @@ int emacps_check_rx( xemacpsif_s * xemacpsif,
             break;
         }
 
+        #if ( niEMAC_RX_BUDGET != 0 )
+        {
+            if( iBudget == 0 )
+            {
+                break;
+            }
+
+            iBudget--;
+        }
+        #endif
+
         pxBuffer = ( NetworkBufferDescriptor_t * ) pxDMA_rx_buffers[ xEMACIndex ][ rxHead ];
         xAccepted = xMayAcceptPacket( pxBuffer->pucEthernetBuffer );
 
@@ -558,28 +631,8 @@ int emacps_check_rx( xemacpsif_s * xemacpsif,
             /* store it in the receive queue, where it'll be processed by a
              * different handler. */
             iptraceNETWORK_INTERFACE_RECEIVE();
-            #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-            {
-                pxBuffer->pxNextBuffer = NULL;
-
-                if( pxFirstDescriptor == NULL )
-                {
-                    /* Becomes the first message */
-                    pxFirstDescriptor = pxBuffer;
-                }
-                else if( pxLastDescriptor != NULL )
-                {
-                    /* Add to the tail */
-                    pxLastDescriptor->pxNextBuffer = pxBuffer;
-                }
-
-                pxLastDescriptor = pxBuffer;
-            }
-            #else /* if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 ) */
-            {
-                prvPassEthMessages( pxBuffer );
-            }
-            #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+            pxBurst[ uxBurstCount ] = pxBuffer;
+            uxBurstCount++;
 
             msgCount++;
         }
@@ -614,16 +667,42 @@ int emacps_check_rx( xemacpsif_s * xemacpsif,
         }
 
         xemacpsif->rxHead = rxHead;
+
+        if( uxBurstCount == niRX_BURST_LENGTH )
+        {
+            /* Pass all collected buffers to the IP-task in one go.  Buffers
+             * that can not be delivered are released by the IP-stack. */
+            ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, ( TickType_t ) 1000 );
+            uxBurstCount = 0U;
+        }
+    }
+
+    if( uxBurstCount > 0U )
+    {
+        ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, ( TickType_t ) 1000 );
     }
 
-    #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+    #if ( niEMAC_RX_BUDGET != 0 )
     {
-        if( pxFirstDescriptor != NULL )
+        uint32_t ulBaseAddress = xemacpsif->emacps.Config.BaseAddress;
+
+        if( iBudget != 0 )
         {
-            prvPassEthMessages( pxFirstDescriptor );
+            /* The ring is empty, enable the RX interrupt again. */
+            XEmacPs_WriteReg( ulBaseAddress, XEMACPS_IER_OFFSET, XEMACPS_IXR_FRAMERX_MASK );
+            ( void ) XEmacPs_ReadReg( ulBaseAddress, XEMACPS_IER_OFFSET );
+            dsb();
+        }
+
+        /* When the budget is used up, or when a frame arrived just before
+         * the interrupt was enabled, let the EMAC task come back without waiting. */
+        if( ( iBudget == 0 ) ||
+            ( ( xemacpsif->rxSegments[ rxHead ].address & XEMACPS_RXBUF_NEW_MASK ) != 0 ) )
+        {
+            xemacpsif->isr_events |= EMAC_IF_RX_EVENT;
         }
     }
-    #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+    #endif /* ( niEMAC_RX_BUDGET != 0 ) */
 
     return msgCount;
 }
@@ -685,6 +764,16 @@ XStatus init_dma( xemacpsif_s * xemacpsif )
         configASSERT( xTXDescriptorSemaphores[ xEMACIndex ] );
     }
 
+    #if ( niEMAC_TX_RECLAIM_THRESHOLD != 0 )
+    {
+        if( xTXReclaimMutexes[ xEMACIndex ] == NULL )
+        {
+            xTXReclaimMutexes[ xEMACIndex ] = xSemaphoreCreateMutex();
+            configASSERT( xTXReclaimMutexes[ xEMACIndex ] );
+        }
+    }
+    #endif
+
     /*
      * Allocate RX descriptors, 1 RxBD at a time.
      */
@@ -763,6 +852,15 @@ XStatus init_dma( xemacpsif_s * xemacpsif )
         XEmacPs_WriteReg( xemacpsif->emacps.Config.BaseAddress, XEMACPS_NWCFG_OFFSET, value );
     }
 
+    #if ( niEMAC_RX_INTR_MODERATION != 0 ) || ( niEMAC_TX_INTR_MODERATION != 0 )
+    {
+        /* Bits 7:0 hold the RX delay, bits 23:16 the TX delay. */
+        uint32_t value = ( ( ( uint32_t ) niEMAC_TX_INTR_MODERATION ) << 16 ) | ( ( uint32_t ) niEMAC_RX_INTR_MODERATION );
+
+        XEmacPs_WriteReg( xemacpsif->emacps.Config.BaseAddress, XEMACPS_INTR_MODERATION_OFFSET, value );
+    }
+    #endif
+
     /*
      * Connect the device driver handler that will be called when an
      * interrupt for the device occurs, the handler defined above performs
@@ -65,6 +65,13 @@ void start_emacps( xemacpsif_s * xemacps )
 {
     /* start the temac */
     XEmacPs_Start( &xemacps->emacps );
+
+    #if ( niEMAC_TX_RECLAIM_THRESHOLD != 0 )
+    {
+        /* Sent buffers are reclaimed lazily, a TX-complete interrupt is not needed. */
+        XEmacPs_IntDisable( &xemacps->emacps, XEMACPS_IXR_TXCOMPL_MASK );
+    }
+    #endif
 }
 
 
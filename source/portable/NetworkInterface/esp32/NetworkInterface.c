@@ -36,6 +36,19 @@
 #include "esp_wifi_internal.h"
 #include "tcpip_adapter.h"
 
+/* When set, frames are passed to the Wi-Fi driver by reference with
+ * esp_wifi_internal_tx_by_ref() instead of being copied by
+ * esp_wifi_internal_tx().  The driver holds an extra reference to the network
+ * buffer until it has sent the frame, which requires
+ * ipconfigUSE_NETWORK_BUFFER_REFCOUNT. */
+#ifndef niESP32_TX_BY_REFERENCE
+    #define niESP32_TX_BY_REFERENCE    0
+#endif
+
+#if ( ( niESP32_TX_BY_REFERENCE != 0 ) && ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT == 0 ) )
+    #error niESP32_TX_BY_REFERENCE requires ipconfigUSE_NETWORK_BUFFER_REFCOUNT
+#endif
+
 enum if_state_t
 {
     INTERFACE_DOWN = 0,
@@ -58,6 +71,11 @@ static BaseType_t xESP32_Eth_GetPhyLinkStatus( NetworkInterface_t * pxInterface
 NetworkInterface_t * pxESP32_Eth_FillInterfaceDescriptor( BaseType_t xEMACIndex,
                                                           NetworkInterface_t * pxInterface );
 
+#if ( niESP32_TX_BY_REFERENCE != 0 )
+    static void prvNetstackBufferRef( void * pvNetstackBuffer );
+    static void prvNetstackBufferFree( void * pvNetstackBuffer );
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if ( ipconfigIPv4_BACKWARD_COMPATIBLE != 0 )
@@ -111,6 +129,15 @@ static BaseType_t xESP32_Eth_NetworkInterfaceInitialise( NetworkInterface_t * px
         {
             esp_wifi_get_mac( ESP_IF_WIFI_STA, ucMACAddress );
             FreeRTOS_UpdateMACAddress( ucMACAddress );
+
+            #if ( niESP32_TX_BY_REFERENCE != 0 )
+            {
+                /* Let the Wi-Fi driver keep network buffers while it
+                 * transmits them. */
+                ( void ) esp_wifi_internal_reg_netstack_buf_cb( prvNetstackBufferRef, prvNetstackBufferFree );
+            }
+            #endif
+
             xMACAdrInitialized = pdTRUE;
         }
 
@@ -132,8 +159,26 @@ static BaseType_t xESP32_Eth_GetPhyLinkStatus( NetworkInterface_t * pxInterface
     return xResult;
 }
 
+#if ( niESP32_TX_BY_REFERENCE != 0 )
+
+/* Called by the Wi-Fi driver when it holds on to a network buffer that was
+ * passed to esp_wifi_internal_tx_by_ref(). */
+    static void prvNetstackBufferRef( void * pvNetstackBuffer )
+    {
+        ( void ) pxNetworkBufferAddReference( ( NetworkBufferDescriptor_t * ) pvNetstackBuffer );
+    }
+
+/* Called by the Wi-Fi driver when it has sent the frame. */
+    static void prvNetstackBufferFree( void * pvNetstackBuffer )
+    {
+        vReleaseNetworkBufferAndDescriptor( ( NetworkBufferDescriptor_t * ) pvNetstackBuffer );
+    }
+
+#endif /* ( niESP32_TX_BY_REFERENCE != 0 ) */
+/*-----------------------------------------------------------*/
+
 static BaseType_t xESP32_Eth_NetworkInterfaceOutput( NetworkInterface_t * pxInterface,
-                                                     NetworkBufferDescriptor_t * const pxDescriptor,
+                                                     NetworkBufferDescriptor_t * const pxNetworkBuffer,
                                                      BaseType_t xReleaseAfterSend )
 {
     if( ( pxNetworkBuffer == NULL ) || ( pxNetworkBuffer->pucEthernetBuffer == NULL ) || ( pxNetworkBuffer->xDataLength == 0 ) )
@@ -151,7 +196,18 @@ static BaseType_t xESP32_Eth_NetworkInterfaceOutput( NetworkInterface_t * pxInte
     }
     else
     {
-        ret = esp_wifi_internal_tx( ESP_IF_WIFI_STA, pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+        #if ( niESP32_TX_BY_REFERENCE != 0 )
+        {
+            /* The driver takes its own reference through
+             * prvNetstackBufferRef() when it needs to keep the buffer, so
+             * the caller can release the buffer as usual. */
+            ret = esp_wifi_internal_tx_by_ref( ESP_IF_WIFI_STA, pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, ( void * ) pxNetworkBuffer );
+        }
+        #else
+        {
+            ret = esp_wifi_internal_tx( ESP_IF_WIFI_STA, pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+        }
+        #endif
 
         if( ret != ESP_OK )
         {
@@ -221,7 +277,7 @@ esp_err_t wlanif_input( void * netif,
         /* Set the packet size, in case a larger buffer was returned. */
         pxNetworkBuffer->xDataLength = len;
         pxNetworkBuffer->pxInterface = pxMyInterface;
-        pxNetworkBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxMyInterface, pcBuffer );
+        pxNetworkBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxMyInterface, buffer );
 
         /* Copy the packet data. */
         memcpy( pxNetworkBuffer->pucEthernetBuffer, buffer, len );
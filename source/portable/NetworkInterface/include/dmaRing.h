@@ -0,0 +1,148 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @brief
+ * Management of the DMA descriptor rings of an Ethernet MAC.
+ *
+ * The library keeps track of which network buffer is attached to which
+ * descriptor, and does the bookkeeping that every ring-based driver repeats:
+ * refilling RX descriptors with buffers from the pool, passing received frames
+ * to the IP-task in bursts, and releasing sent buffers in batches.  The layout
+ * of a descriptor is only known to the driver, which supplies it through a set
+ * of callbacks.
+ *
+ * The functions of one ring must not be called concurrently.  Normally the RX
+ * functions are called from the deferred interrupt handling task of a driver,
+ * and the TX functions from its pfOutput() function.
+ */
+
+#ifndef DMA_RING_H
+
+    #define DMA_RING_H
+
+    #ifdef __cplusplus
+        extern "C" {
+    #endif
+
+/* The maximum number of frames that are passed to the IP-task in one call. */
+    #ifndef dmaRING_RX_BURST_LENGTH
+        #define dmaRING_RX_BURST_LENGTH    8U
+    #endif
+
+/* The maximum number of buffers that are released in one call. */
+    #ifndef dmaRING_TX_RELEASE_BATCH
+        #define dmaRING_TX_RELEASE_BATCH    8U
+    #endif
+
+/* The descriptor format of a driver.  'pvContext' is the pointer that was
+ * passed to vDMARingInit(), 'uxIndex' is the number of a descriptor within the
+ * ring.  The callbacks that hand a descriptor to the DMA must make sure that
+ * the descriptor is written to memory before its ownership bit. */
+    typedef struct xDMA_RING_OPS
+    {
+        /* Attach an empty buffer of 'uxLength' bytes to an RX descriptor and
+         * hand it to the DMA. */
+        void ( * pfRxArm )( void * pvContext,
+                            size_t uxIndex,
+                            uint8_t * pucBuffer,
+                            size_t uxLength );
+
+        /* Return pdFALSE while the DMA owns an RX descriptor.  Otherwise, set
+         * '*puxLength' to the length of the frame received, or to zero when
+         * the frame was received with an error. */
+        BaseType_t ( * pfRxDone )( void * pvContext,
+                                   size_t uxIndex,
+                                   size_t * puxLength );
+
+        /* Attach a frame to a TX descriptor and hand it to the DMA. */
+        void ( * pfTxArm )( void * pvContext,
+                            size_t uxIndex,
+                            const uint8_t * pucData,
+                            size_t uxLength );
+
+        /* Return pdFALSE while the DMA owns a TX descriptor. */
+        BaseType_t ( * pfTxDone )( void * pvContext,
+                                   size_t uxIndex );
+
+        /* Optional: tell the DMA that descriptors were handed to it, e.g. by
+         * writing a poll-demand register.  Called once per batch. */
+        void ( * pfKick )( void * pvContext );
+    } DMARingOps_t;
+
+/* The state of one RX or TX ring. */
+    typedef struct xDMA_RING
+    {
+        const DMARingOps_t * pxOps;
+        void * pvContext;
+        NetworkInterface_t * pxInterface;
+        NetworkBufferDescriptor_t ** ppxBuffers; /* The buffer attached to each descriptor, NULL when none. */
+        size_t uxCount;                          /* The number of descriptors. */
+        size_t uxHead;                           /* The next descriptor to hand to the DMA. */
+        size_t uxTail;                           /* The next descriptor to be completed by the DMA. */
+        size_t uxPending;                        /* The number of descriptors owned by the DMA. */
+    } DMARing_t;
+
+/* Initialise a ring of 'uxCount' descriptors.  'ppxBuffers' must point to an
+ * array of 'uxCount' entries, which is owned by the ring from now on. */
+    void vDMARingInit( DMARing_t * pxRing,
+                       NetworkInterface_t * pxInterface,
+                       const DMARingOps_t * pxOps,
+                       void * pvContext,
+                       NetworkBufferDescriptor_t ** ppxBuffers,
+                       size_t uxCount );
+
+/* Hand an empty network buffer to every RX descriptor that does not have one.
+ * Returns the number of descriptors that were filled. */
+    size_t uxDMARingRxFill( DMARing_t * pxRing );
+
+/* Pass at most 'uxBudget' received frames to the IP-task, and refill their
+ * descriptors.  Returns the number of descriptors that were completed. */
+    size_t uxDMARingRxProcess( DMARing_t * pxRing,
+                               size_t uxBudget );
+
+/* Hand a frame to the DMA.  The buffer is attached to the descriptor without
+ * copying when 'xReleaseAfterSend' is pdTRUE, otherwise the frame is copied
+ * to a new buffer.  Returns pdPASS when the frame was queued, pdFAIL when the
+ * ring is full, in which case the buffer is released if 'xReleaseAfterSend'
+ * is pdTRUE. */
+    BaseType_t xDMARingTxSend( DMARing_t * pxRing,
+                               NetworkBufferDescriptor_t * const pxBuffer,
+                               BaseType_t xReleaseAfterSend );
+
+/* Release the buffers of the TX descriptors that the DMA has completed.
+ * Returns the number of descriptors that were reclaimed. */
+    size_t uxDMARingTxReclaim( DMARing_t * pxRing );
+
+/* Release all buffers attached to a ring, e.g. after the DMA was stopped. */
+    void vDMARingFlush( DMARing_t * pxRing );
+
+    #ifdef __cplusplus
+        } /* extern "C" */
+    #endif
+
+#endif /* DMA_RING_H */
@@ -79,6 +79,13 @@
         uint32_t ulLinkStatusMask;
         PhyProperties_t xPhyPreferences;
         PhyProperties_t xPhyProperties;
+        TickType_t xLinkStatusInterval;            /* The current poll interval, see ipconfigPHY_LS_ADAPTIVE_POLL. */
+        uint32_t ulLinkInterruptMask;              /* The ports that signal link changes through their interrupt pin. */
+        volatile BaseType_t xLinkInterruptPending; /* Set by vPhyLinkInterruptFromISR(). */
+        uint32_t ulNegotiatingMask;                /* The ports of a pending xPhyStartAutoNegotiationAsync(). */
+        uint32_t ulNegotiatedMask;                 /* The ports that completed that negotiation. */
+        TimeOut_t xNegotiateTimer;
+        TickType_t xNegotiateRemaining;
     } EthernetPhy_t;
 
 /* Some defines used internally here to indicate preferences about speed, MDIX
@@ -134,6 +141,18 @@
     BaseType_t xPhyStartAutoNegotiation( EthernetPhy_t * pxPhyObject,
                                          uint32_t ulPhyMask );
 
+/* Give a command to start auto negotiation on a set of PHY port's, without
+ * waiting for its completion.  The driver task shall call
+ * ulPhyCheckAutoNegotiation() until it returns zero. */
+    BaseType_t xPhyStartAutoNegotiationAsync( EthernetPhy_t * pxPhyObject,
+                                              uint32_t ulPhyMask );
+
+/* Check the progress of xPhyStartAutoNegotiationAsync().  Returns the mask of
+ * the ports that are still negotiating.  When it returns zero, 'xPhyProperties'
+ * and 'ulLinkStatusMask' have been updated, as by xPhyStartAutoNegotiation().
+ * xPhyCheckLinkStatus() does not read the PHY's while they negotiate. */
+    uint32_t ulPhyCheckAutoNegotiation( EthernetPhy_t * pxPhyObject );
+
 /* Do not use auto negotiation but use predefined values from 'pxPhyObject->xPhyPreferences'. */
     BaseType_t xPhyFixedValue( EthernetPhy_t * pxPhyObject,
                                uint32_t ulPhyMask );
@@ -144,6 +163,23 @@
     BaseType_t xPhyCheckLinkStatus( EthernetPhy_t * pxPhyObject,
                                     BaseType_t xHadReception );
 
+/* Let the PHY ports in 'ulPhyMask' assert their interrupt pin when the link
+ * goes up or down.  Returns the mask of the ports that support it.  Call it
+ * after xPhyConfigure(), which resets the PHY's.  The ports that have it
+ * enabled are polled only once every ipconfigPHY_LS_HIGH_CHECK_TIME_MS. */
+    uint32_t ulPhyEnableLinkInterrupt( EthernetPhy_t * pxPhyObject,
+                                       uint32_t ulPhyMask );
+
+/* To be called from the interrupt of the PHY pin.  The driver must then wake
+ * up the task that calls xPhyCheckLinkStatus(), which will read the PHY's
+ * immediately, and clear their interrupt. */
+    void vPhyLinkInterruptFromISR( EthernetPhy_t * pxPhyObject );
+
+/* Return the speed in Mbit/s that auto-negotiation or xPhyFixedValue() has
+ * set, or zero when no port has a link.  A driver can store it in the field
+ * 'ulLinkSpeed' of its NetworkInterface_t, see ipconfigUSE_TCP_LINK_SPEED_SIZING. */
+    uint32_t ulPhyGetLinkSpeed( const EthernetPhy_t * pxPhyObject );
+
 /* Get the bitmask of a given 'EthernetPhy_t'. */
     #define xPhyGetMask( pxPhyObject ) \
     ( ( ( ( uint32_t ) 1u ) << ( pxPhyObject )->xPortCount ) - 1u )
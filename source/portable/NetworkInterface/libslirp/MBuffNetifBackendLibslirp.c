@@ -64,6 +64,8 @@
 #define xRECV_BUFFER_SIZE     ( 32U * NETWORK_BUFFER_LEN )
 #define xNUM_TIMERS           ( 10U )
 
+#include "MBuffNetifBatch.h"
+
 #if defined( _WIN32 )
     typedef uintptr_t         Thread_t;
     typedef HANDLE            Mutex_t;
@@ -92,6 +94,15 @@ typedef struct
     uint8_t pucTxBuffer[ xSEND_BUFFER_SIZE ];
     uint8_t pucRxBuffer[ xRECV_BUFFER_SIZE ];
 
+    /* Frames received from libslirp, waiting to be sent to xRecvMsgBuffer
+     * as a single message.  Only accessed while xMutex is held. */
+    uint8_t pucRxBatch[ niMBUFF_BATCH_MAX_LEN ];
+    size_t uxRxBatchLen;
+    size_t uxRxBatchCount;
+
+    /* Frames read from xSendMsgBuffer, waiting to be passed to libslirp. */
+    uint8_t pucTxBatch[ niMBUFF_BATCH_MAX_LEN ];
+
     BaseType_t xExitFlag;
 
     /* libslirp context */
@@ -148,6 +159,7 @@ static void vSlirp_RegisterPollFd( int lFd,
 static void vSlirp_UnRegisterPollFd( int lFd,
                                      void * pvCallbackContext );
 static void vSlirp_Notify( void * pvCallbackContext );
+static void vFlushRxBatch( SlirpBackendContext_t * pxCtx );
 
 #if SLIRP_CHECK_VERSION( 4U, 7U, 0U )
     static void vSlirp_InitCompleted( Slirp * pxSlirp,
@@ -262,6 +274,9 @@ void vMBuffNetifBackendInit( MessageBufferHandle_t * pxSendMsgBuffer,
     {
         pxCtx = ( SlirpBackendContext_t * ) pvContextBuffer;
 
+        pxCtx->uxRxBatchLen = 0U;
+        pxCtx->uxRxBatchCount = 0U;
+
         pxCtx->xSendMsgBuffer = xMessageBufferCreateStatic( xSEND_BUFFER_SIZE,
                                                             pxCtx->pucTxBuffer,
                                                             &( pxCtx->xSendMsgBufferStatic ) );
@@ -403,6 +418,9 @@ void vMBuffNetifBackendDeInit( void * pvBackendContext )
 
 /**
  * @brief Callback called by libslirp when an incoming frame is available.
+ *        The frame is added to the pending batch, which is sent to
+ *        xRecvMsgBuffer when it is full, or by vFlushRxBatch() when libslirp
+ *        has returned.
  *
  * @param [in] pvBuffer Pointer to a buffer containing the incoming frame.
  * @param [in] uxLen Length of the incoming frame.
@@ -414,7 +432,6 @@ static slirp_ssize_t xSlirp_WriteCallback( const void * pvBuffer,
                                            void * pvOpaque )
 {
     SlirpBackendContext_t * pxCtx = ( SlirpBackendContext_t * ) pvOpaque;
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
     if( uxLen > ( NETWORK_BUFFER_LEN ) )
     {
@@ -424,27 +441,56 @@ static slirp_ssize_t xSlirp_WriteCallback( const void * pvBuffer,
     {
         fprintf( stderr, "Dropping RX frame of length: %zu < %zu. Frame received from libslirp is too small.\n", uxLen, sizeof( EthernetHeader_t ) );
     }
-    else if( xMessageBufferSpacesAvailable( pxCtx->xRecvMsgBuffer ) < ( uxLen + 4U ) )
+    else
+    {
+        if( pxCtx->uxRxBatchCount >= niMBUFF_BATCH_MAX_FRAMES )
+        {
+            vFlushRxBatch( pxCtx );
+        }
+
+        pxCtx->uxRxBatchLen = uxMBuffBatchAppend( pxCtx->pucRxBatch, pxCtx->uxRxBatchLen, pvBuffer, uxLen );
+        pxCtx->uxRxBatchCount++;
+    }
+
+    return 0U;
+}
+
+/**
+ * @brief Send the frames collected by xSlirp_WriteCallback() to xRecvMsgBuffer
+ *        as a single message.  Must be called with xMutex held.
+ *
+ * @param [in] pxCtx Pointer to the relevant SlirpBackendContext_t.
+ */
+static void vFlushRxBatch( SlirpBackendContext_t * pxCtx )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if( pxCtx->uxRxBatchCount == 0U )
+    {
+        /* Nothing was received. */
+    }
+    else if( xMessageBufferSpacesAvailable( pxCtx->xRecvMsgBuffer ) < ( pxCtx->uxRxBatchLen + niMBUFF_MESSAGE_OVERHEAD ) )
     {
-        fprintf( stderr, "Dropping RX frame of length: %zu. xRecvMsgBuffer is full\n", uxLen );
+        fprintf( stderr, "Dropping %zu RX frames. xRecvMsgBuffer is full\n", pxCtx->uxRxBatchCount );
     }
     else
     {
         size_t uxBytesSent;
 
         uxBytesSent = xMessageBufferSendFromISR( pxCtx->xRecvMsgBuffer,
-                                                 pvBuffer,
-                                                 uxLen,
+                                                 pxCtx->pucRxBatch,
+                                                 pxCtx->uxRxBatchLen,
                                                  &xHigherPriorityTaskWoken );
 
-        configASSERT( uxBytesSent == uxLen );
-
-        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+        ( void ) uxBytesSent;
+        configASSERT( uxBytesSent == pxCtx->uxRxBatchLen );
     }
 
-    return 0U;
-}
+    pxCtx->uxRxBatchLen = 0U;
+    pxCtx->uxRxBatchCount = 0U;
 
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
 
 /**
  * @brief Checks that pxPollFdArray is large enough to accommodate the specified number of file descriptors.
@@ -635,7 +681,6 @@ static THREAD_RETURN THREAD_FUNC_DEF vTransmitThread( void * pvParameters )
 {
     SlirpBackendContext_t * pxCtx = ( SlirpBackendContext_t * ) pvParameters;
     const time_t xMaxMSToWait = 1000;
-    uint8_t ucFrameSendBuffer[ NETWORK_BUFFER_LEN ];
 
     #if !defined( _WIN32 )
         sigset_t set;
@@ -662,15 +707,58 @@ static THREAD_RETURN THREAD_FUNC_DEF vTransmitThread( void * pvParameters )
         while( xMessageBufferIsEmpty( pxCtx->xSendMsgBuffer ) == pdFALSE )
         {
             BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-            size_t uxFrameLen = xMessageBufferReceiveFromISR( pxCtx->xSendMsgBuffer, ucFrameSendBuffer, sizeof( ucFrameSendBuffer ), &xHigherPriorityTaskWoken );
+            size_t uxBatchLen = 0U;
+            size_t uxBatchCount = 0U;
+            size_t uxOffset = 0U;
+            size_t uxFrameLen = 0U;
+            const uint8_t * pucFrame;
+
+            /* Collect a batch of frames, so that the lock is taken once for
+             * all of them. */
+            while( ( uxBatchCount < niMBUFF_BATCH_MAX_FRAMES ) &&
+                   ( xMessageBufferIsEmpty( pxCtx->xSendMsgBuffer ) == pdFALSE ) )
+            {
+                uint16_t usLength;
+
+                uxFrameLen = xMessageBufferReceiveFromISR( pxCtx->xSendMsgBuffer,
+                                                           &( pxCtx->pucTxBatch[ uxBatchLen + niMBUFF_BATCH_HEADER_LEN ] ),
+                                                           NETWORK_BUFFER_LEN,
+                                                           &xHigherPriorityTaskWoken );
+
+                if( uxFrameLen == 0U )
+                {
+                    break;
+                }
+
+                usLength = ( uint16_t ) uxFrameLen;
+                ( void ) memcpy( &( pxCtx->pucTxBatch[ uxBatchLen ] ), &usLength, niMBUFF_BATCH_HEADER_LEN );
+                uxBatchLen += niMBUFF_BATCH_HEADER_LEN + uxFrameLen;
+                uxBatchCount++;
+            }
 
             vLockSlirpContext( pxCtx );
             {
-                slirp_input( pxCtx->pxSlirp, ucFrameSendBuffer, uxFrameLen );
+                pucFrame = pucMBuffBatchNext( pxCtx->pucTxBatch, uxBatchLen, &uxOffset, &uxFrameLen );
+
+                while( pucFrame != NULL )
+                {
+                    slirp_input( pxCtx->pxSlirp, pucFrame, ( int ) uxFrameLen );
+                    pucFrame = pucMBuffBatchNext( pxCtx->pucTxBatch, uxBatchLen, &uxOffset, &uxFrameLen );
+                }
+
+                /* Deliver the replies that libslirp generated synchronously. */
+                vFlushRxBatch( pxCtx );
             }
             vUnlockSlirpContext( pxCtx );
 
             portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+
+            if( uxBatchCount == 0U )
+            {
+                /* A message that does not fit in a frame buffer, it can not
+                 * be read.  Wait for the next event. */
+                break;
+            }
         }
     }
 
@@ -728,6 +816,9 @@ static THREAD_RETURN THREAD_FUNC_DEF vReceiveThread( void * pvParameters )
         vLockSlirpContext( pxCtx );
         {
             slirp_pollfds_poll( pxCtx->pxSlirp, lPollRslt, lSlirpGetREventsCallback, ( void * ) pxCtx );
+
+            /* Send all frames received during this poll as a single message. */
+            vFlushRxBatch( pxCtx );
         }
         vUnlockSlirpContext( pxCtx );
     }
@@ -0,0 +1,135 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+#ifndef MBUFF_NETIF_BATCH_H
+    #define MBUFF_NETIF_BATCH_H
+
+/*
+ * Frames received by libslirp are passed to the FreeRTOS+TCP task in batches:
+ * a single message in xRecvMsgBuffer holds up to niMBUFF_BATCH_MAX_FRAMES
+ * frames, each preceded by a 16-bit length field in host byte order.  A batch
+ * costs one message buffer operation and at most one wakeup of the receiving
+ * task.
+ *
+ * In the other direction, pfOutput() can not know when the IP-task has sent
+ * the last frame of a burst, so xSendMsgBuffer holds one frame per message.
+ * Only the first frame of a burst wakes up the transmit thread, which reads up
+ * to niMBUFF_BATCH_MAX_FRAMES frames into a batch before passing them all to
+ * libslirp.
+ *
+ * This file must be included after NETWORK_BUFFER_LEN and xSEND_BUFFER_SIZE
+ * are defined.
+ */
+
+    #include <string.h>
+
+/* The maximum number of frames that are packed into a single message. */
+    #ifndef niMBUFF_BATCH_MAX_FRAMES
+        #define niMBUFF_BATCH_MAX_FRAMES    8U
+    #endif
+
+    #if ( niMBUFF_BATCH_MAX_FRAMES < 1U )
+        #error niMBUFF_BATCH_MAX_FRAMES must be at least 1
+    #endif
+
+/* The size of the length field that precedes each frame in a batch. */
+    #define niMBUFF_BATCH_HEADER_LEN    2U
+
+/* The maximum size of a batch message. */
+    #define niMBUFF_BATCH_MAX_LEN       ( niMBUFF_BATCH_MAX_FRAMES * ( NETWORK_BUFFER_LEN + niMBUFF_BATCH_HEADER_LEN ) )
+
+/* A message buffer needs some space to store the length of each message. */
+    #define niMBUFF_MESSAGE_OVERHEAD    ( sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) )
+
+    #if ( NETWORK_BUFFER_LEN > 0xFFFFU )
+        #error NETWORK_BUFFER_LEN does not fit in the length field of a batch
+    #endif
+
+    #if ( ( niMBUFF_BATCH_MAX_LEN + 4U ) >= xSEND_BUFFER_SIZE )
+        #error niMBUFF_BATCH_MAX_FRAMES is too large for the size of the message buffers
+    #endif
+
+/**
+ * @brief Append a frame to a batch.  The caller must make sure that the batch
+ *        has room for another niMBUFF_BATCH_HEADER_LEN + uxFrameLen bytes.
+ *
+ * @param[in] pucBatch The batch to append to.
+ * @param[in] uxBatchLen The number of bytes already stored in the batch.
+ * @param[in] pvFrame The frame to append.
+ * @param[in] uxFrameLen The length of the frame.
+ *
+ * @return The new length of the batch.
+ */
+    static inline size_t uxMBuffBatchAppend( uint8_t * pucBatch,
+                                             size_t uxBatchLen,
+                                             const void * pvFrame,
+                                             size_t uxFrameLen )
+    {
+        uint16_t usLength = ( uint16_t ) uxFrameLen;
+
+        ( void ) memcpy( &( pucBatch[ uxBatchLen ] ), &usLength, niMBUFF_BATCH_HEADER_LEN );
+        ( void ) memcpy( &( pucBatch[ uxBatchLen + niMBUFF_BATCH_HEADER_LEN ] ), pvFrame, uxFrameLen );
+
+        return uxBatchLen + niMBUFF_BATCH_HEADER_LEN + uxFrameLen;
+    }
+
+/**
+ * @brief Find the next frame in a batch.
+ *
+ * @param[in] pucBatch The batch, as read from a message buffer.
+ * @param[in] uxBatchLen The total length of the batch.
+ * @param[in,out] puxOffset The offset of the next length field, it will be
+ *                          advanced past the frame that is returned.
+ * @param[out] puxFrameLen The length of the frame that is returned.
+ *
+ * @return A pointer to the frame, or NULL when the batch has been consumed or
+ *         when it is malformed.
+ */
+    static inline const uint8_t * pucMBuffBatchNext( const uint8_t * pucBatch,
+                                                     size_t uxBatchLen,
+                                                     size_t * puxOffset,
+                                                     size_t * puxFrameLen )
+    {
+        const uint8_t * pucFrame = NULL;
+        uint16_t usLength;
+
+        if( ( *puxOffset + niMBUFF_BATCH_HEADER_LEN ) <= uxBatchLen )
+        {
+            ( void ) memcpy( &usLength, &( pucBatch[ *puxOffset ] ), niMBUFF_BATCH_HEADER_LEN );
+
+            if( ( *puxOffset + niMBUFF_BATCH_HEADER_LEN + usLength ) <= uxBatchLen )
+            {
+                pucFrame = &( pucBatch[ *puxOffset + niMBUFF_BATCH_HEADER_LEN ] );
+                *puxFrameLen = usLength;
+                *puxOffset += niMBUFF_BATCH_HEADER_LEN + usLength;
+            }
+        }
+
+        return pucFrame;
+    }
+
+#endif /* MBUFF_NETIF_BATCH_H */
@@ -58,6 +58,8 @@
 #define xSEND_BUFFER_SIZE     ( 32U * NETWORK_BUFFER_LEN )
 #define xRECV_BUFFER_SIZE     ( 32U * NETWORK_BUFFER_LEN )
 
+#include "MBuffNetifBatch.h"
+
 typedef struct
 {
     BaseType_t xInterfaceState;
@@ -66,6 +68,7 @@ typedef struct
     TaskHandle_t xRecvTask;
     void * pvSendEvent;
     void * pvBackendContext;
+    uint8_t pucRxBatch[ niMBUFF_BATCH_MAX_LEN ];
 } MBuffNetDriverContext_t;
 
 extern void vMBuffNetifBackendInit( MessageBufferHandle_t * pxSendMsgBuffer,
@@ -193,75 +196,73 @@ BaseType_t xNetworkInterfaceDeInitialise( NetworkInterface_t * pxNetif )
 }
 
 /*!
- * @brief FreeRTOS task which reads from xRecvMsgBuffer and passes new frames to FreeRTOS+TCP.
+ * @brief FreeRTOS task which reads batches of frames from xRecvMsgBuffer and passes them to FreeRTOS+TCP.
  * @param [in] pvParameters not used
  */
 static void vNetifReceiveTask( void * pvParameters )
 {
-    NetworkBufferDescriptor_t * pxDescriptor = NULL;
     NetworkInterface_t * pxNetif = ( NetworkInterface_t * ) pvParameters;
 
     MBuffNetDriverContext_t * pxDriverCtx = ( MBuffNetDriverContext_t * ) pxNetif->pvArgument;
 
     for( ; ; )
     {
-        size_t uxMessageLen;
-
-        while( pxDescriptor == NULL )
+        NetworkBufferDescriptor_t * pxBurst[ niMBUFF_BATCH_MAX_FRAMES ];
+        size_t uxBurstCount = 0U;
+        size_t uxBatchLen;
+        size_t uxOffset = 0U;
+        size_t uxFrameLen = 0U;
+        const uint8_t * pucFrame;
+
+        /* Read an incoming batch of frames */
+        uxBatchLen = xMessageBufferReceive( pxDriverCtx->xRecvMsgBuffer,
+                                            pxDriverCtx->pucRxBatch,
+                                            sizeof( pxDriverCtx->pucRxBatch ),
+                                            portMAX_DELAY );
+
+        pucFrame = pucMBuffBatchNext( pxDriverCtx->pucRxBatch, uxBatchLen, &uxOffset, &uxFrameLen );
+
+        while( ( pucFrame != NULL ) && ( uxBurstCount < niMBUFF_BATCH_MAX_FRAMES ) )
         {
-            /* Wait for an MTU + header sized buffer */
-            pxDescriptor = pxGetNetworkBufferWithDescriptor( NETWORK_BUFFER_LEN, portMAX_DELAY );
-            configASSERT( pxDescriptor->xDataLength >= NETWORK_BUFFER_LEN );
-        }
-
-        /* Read an incoming frame */
-        uxMessageLen = xMessageBufferReceive( pxDriverCtx->xRecvMsgBuffer,
-                                              pxDescriptor->pucEthernetBuffer,
-                                              pxDescriptor->xDataLength,
-                                              portMAX_DELAY );
-
-        if( uxMessageLen > 0 )
-        {
-            IPStackEvent_t xRxEvent;
-            eFrameProcessingResult_t xFrameProcess;
-
-            pxDescriptor->xDataLength = uxMessageLen;
+            NetworkBufferDescriptor_t * pxDescriptor;
 
             /* eConsiderFrameForProcessing is interrupt safe */
-            xFrameProcess = ipCONSIDER_FRAME_FOR_PROCESSING( pxDescriptor->pucEthernetBuffer );
+            eFrameProcessingResult_t xFrameProcess = ipCONSIDER_FRAME_FOR_PROCESSING( pucFrame );
 
             if( xFrameProcess != eProcessBuffer )
             {
                 FreeRTOS_debug_printf( ( "Dropping RX frame of length: %lu. eConsiderFrameForProcessing returned %lu.\n",
-                                         uxMessageLen, xFrameProcess ) );
+                                         uxFrameLen, xFrameProcess ) );
             }
+            else
+            {
+                /* Wait for a buffer, frames are not dropped for a lack of
+                 * network buffers. */
+                pxDescriptor = pxGetNetworkBufferWithDescriptor( NETWORK_BUFFER_LEN, portMAX_DELAY );
+                configASSERT( pxDescriptor != NULL );
 
-            pxDescriptor->pxInterface = pxNetif;
-            pxDescriptor->pxEndPoint = FreeRTOS_MatchingEndpoint( pxNetif, pxDescriptor->pucEthernetBuffer );
-
-            xRxEvent.eEventType = eNetworkRxEvent;
-            xRxEvent.pvData = ( void * ) pxDescriptor;
+                ( void ) memcpy( pxDescriptor->pucEthernetBuffer, pucFrame, uxFrameLen );
+                pxDescriptor->xDataLength = uxFrameLen;
+                pxDescriptor->pxInterface = pxNetif;
+                pxDescriptor->pxEndPoint = FreeRTOS_MatchingEndpoint( pxNetif, pxDescriptor->pucEthernetBuffer );
 
-            if( xSendEventStructToIPTask( &xRxEvent, 0U ) == pdTRUE )
-            {
                 iptraceNETWORK_INTERFACE_RECEIVE();
 
-                /* Clear pxDescriptor so that the task requests a new buffer */
-                pxDescriptor = NULL;
-            }
-            else
-            {
-                FreeRTOS_debug_printf( ( "Dropping TX frame of length: %lu. FreeRTOS+TCP event queue is full.\n",
-                                         pxDescriptor->xDataLength ) );
-                /* Drop the frame and reuse the descriptor for the next incoming frame */
-                iptraceETHERNET_RX_EVENT_LOST();
+                pxBurst[ uxBurstCount ] = pxDescriptor;
+                uxBurstCount++;
             }
+
+            pucFrame = pucMBuffBatchNext( pxDriverCtx->pucRxBatch, uxBatchLen, &uxOffset, &uxFrameLen );
         }
-        else
+
+        if( uxBurstCount > 0U )
         {
-            /*
-             * xMessageBufferReceive returned zero.
-             */
+            /* Hand over the whole batch at once, buffers that can not be
+             * delivered are released. */
+            if( xSendRxBurstToIPTask( pxBurst, uxBurstCount, 0U ) != pdPASS )
+            {
+                FreeRTOS_debug_printf( ( "Dropping RX frames. FreeRTOS+TCP event queue is full.\n" ) );
+            }
         }
     }
 }
@@ -276,6 +277,7 @@ static BaseType_t xNetworkInterfaceOutput( NetworkInterface_t * pxNetif,
                                            BaseType_t xReleaseAfterSend )
 {
     BaseType_t xResult = pdFALSE;
+    BaseType_t xWakeUp = pdFALSE;
 
     MBuffNetDriverContext_t * pxDriverCtx = ( MBuffNetDriverContext_t * ) pxNetif->pvArgument;
 
@@ -287,7 +289,12 @@ static BaseType_t xNetworkInterfaceOutput( NetworkInterface_t * pxNetif,
         configASSERT( pxNetworkBuffer->pucEthernetBuffer != NULL );
         configASSERT( pxNetworkBuffer->xDataLength >= sizeof( EthernetHeader_t ) );
 
-        if( xMessageBufferSpacesAvailable( pxDriverCtx->xSendMsgBuffer ) > pxNetworkBuffer->xDataLength + 4U )
+        if( pxNetworkBuffer->xDataLength > NETWORK_BUFFER_LEN )
+        {
+            FreeRTOS_debug_printf( ( "Dropping TX frame of length: %lu. Frame is too large.\n",
+                                     pxNetworkBuffer->xDataLength ) );
+        }
+        else if( xMessageBufferSpacesAvailable( pxDriverCtx->xSendMsgBuffer ) > pxNetworkBuffer->xDataLength + 4U )
         {
             size_t uxBytesSent;
             uxBytesSent = xMessageBufferSend( pxDriverCtx->xSendMsgBuffer,
@@ -296,6 +303,16 @@ static BaseType_t xNetworkInterfaceOutput( NetworkInterface_t * pxNetif,
                                               0U );
             ( void ) uxBytesSent;
             configASSERT( uxBytesSent == pxNetworkBuffer->xDataLength );
+
+            /* Only wake up the transmit thread for the first frame of a
+             * burst.  When there are older messages in the buffer, the thread
+             * has been signalled already, and it will read this frame before
+             * it waits again. */
+            if( xStreamBufferBytesAvailable( pxDriverCtx->xSendMsgBuffer ) <= ( uxBytesSent + niMBUFF_MESSAGE_OVERHEAD ) )
+            {
+                xWakeUp = pdTRUE;
+            }
+
             xResult = pdTRUE;
         }
         else
@@ -311,7 +328,7 @@ static BaseType_t xNetworkInterfaceOutput( NetworkInterface_t * pxNetif,
             vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
         }
 
-        if( xResult == pdTRUE )
+        if( xWakeUp == pdTRUE )
         {
             #if defined( _WIN32 )
                 SetEvent( pxDriverCtx->pvSendEvent );
@@ -25,6 +25,11 @@
  * http://www.FreeRTOS.org
  */
 
+/* sendmmsg() is a GNU extension. */
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
 /* ========================= FreeRTOS includes ============================== */
 #include "FreeRTOS.h"
 #include "event_groups.h"
@@ -41,6 +46,7 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <signal.h>
+#include <time.h>
 #include <pcap.h>
 
 /* ========================= FreeRTOS+TCP includes ========================== */
@@ -61,16 +67,88 @@
 #endif
 
 /* ============================== Definitions =============================== */
+/* The maximum number of received packets that are passed to the IP-task
+ * in a single burst. */
+#ifndef niRX_BURST_LENGTH
+    #define niRX_BURST_LENGTH    8U
+#endif
+
+/* When 1, frames are exchanged with the kernel through the memory-mapped RX
+ * and TX rings of a TPACKET_V3 AF_PACKET socket, instead of through libpcap
+ * and two thread safe copy buffers.  Each frame is then copied once instead
+ * of twice, and a batch of frames costs one system call.  libpcap is still
+ * used to list the interfaces.  The process needs the CAP_NET_RAW capability. */
+#ifndef niUSE_PACKET_MMAP
+    #define niUSE_PACKET_MMAP    0
+#endif
+
+#if ( niUSE_PACKET_MMAP != 0 )
+    #include <errno.h>
+    #include <string.h>
+    #include <sys/mman.h>
+    #include <sys/socket.h>
+    #include <net/if.h>
+    #include <linux/if_ether.h>
+    #include <linux/if_packet.h>
+
+/* The geometry of the rings, see packet_mmap.rst in the Linux documentation.
+ * A block is a multiple of the page size, it holds a whole number of frames.
+ * A frame holds a tpacket3_hdr followed by an Ethernet frame. */
+    #ifndef niPACKET_MMAP_BLOCK_SIZE
+        #define niPACKET_MMAP_BLOCK_SIZE    ( 1U << 16 )
+    #endif
+
+    #ifndef niPACKET_MMAP_FRAME_SIZE
+        #define niPACKET_MMAP_FRAME_SIZE    2048U
+    #endif
+
+    #ifndef niPACKET_MMAP_RX_BLOCKS
+        #define niPACKET_MMAP_RX_BLOCKS    64U
+    #endif
+
+    #ifndef niPACKET_MMAP_TX_BLOCKS
+        #define niPACKET_MMAP_TX_BLOCKS    4U
+    #endif
+
+/* The time in ms after which the kernel hands over an RX block that is only
+ * partly filled. */
+    #ifndef niPACKET_MMAP_RX_RETIRE_MS
+        #define niPACKET_MMAP_RX_RETIRE_MS    2U
+    #endif
+
+    #define niPACKET_MMAP_TX_FRAMES    ( ( niPACKET_MMAP_BLOCK_SIZE / niPACKET_MMAP_FRAME_SIZE ) * niPACKET_MMAP_TX_BLOCKS )
+#else /* niUSE_PACKET_MMAP != 0 */
+    #include <errno.h>
+    #include <string.h>
+    #include <sys/socket.h>
+
+/* The maximum number of frames that the send thread passes to the kernel in
+ * a single sendmmsg() call. */
+    #ifndef niTX_BATCH_LENGTH
+        #define niTX_BATCH_LENGTH    16U
+    #endif
+#endif /* niUSE_PACKET_MMAP != 0 */
+
 #define xSEND_BUFFER_SIZE    32768
 #define xRECV_BUFFER_SIZE    32768
 #define MAX_CAPTURE_LEN      65535
 #define IP_SIZE              100
 
 /* ================== Static Function Prototypes ============================ */
-static int prvConfigureCaptureBehaviour( void );
-static int prvCreateThreadSafeBuffers( void );
-static void * prvLinuxPcapSendThread( void * pvParam );
-static void * prvLinuxPcapRecvThread( void * pvParam );
+#if ( niUSE_PACKET_MMAP == 0 )
+    static int prvConfigureCaptureBehaviour( void );
+    static int prvCreateThreadSafeBuffers( void );
+    static void * prvLinuxPcapSendThread( void * pvParam );
+    static void prvPcapSendBatch( struct mmsghdr * pxMessages,
+                                  size_t uxCount );
+    static void * prvLinuxPcapRecvThread( void * pvParam );
+    static int prvSetDeviceModes( void );
+#else
+    static int prvOpenPacketSocket( const char * pcName );
+    static void prvPacketRingOutput( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+    static size_t prvPacketRingReceive( const uint8_t ** ppucData );
+    static void * prvLinuxPacketSendThread( void * pvParam );
+#endif
 static void prvInterruptSimulatorTask( void * pvParameters );
 static void prvPrintAvailableNetworkInterfaces( pcap_if_t * pxAllNetworkInterfaces );
 static pcap_if_t * prvGetAvailableNetworkInterfaces( void );
@@ -79,25 +157,48 @@ static const char * prvRemoveSpaces( char * pcBuffer,
                                      const char * pcMessage );
 static int prvOpenSelectedNetworkInterface( pcap_if_t * pxAllNetworkInterfaces );
 static int prvCreateWorkerThreads( void );
-static int prvSetDeviceModes( void );
+static void prvSignalSendThread( void );
+static void prvWaitForSendRequests( size_t * puxHandled );
 static void print_hex( unsigned const char * const bin_data,
                        size_t len );
 
 /* ======================== Static Global Variables ========================= */
-static StreamBuffer_t * xSendBuffer = NULL;
-static StreamBuffer_t * xRecvBuffer = NULL;
+#if ( niUSE_PACKET_MMAP == 0 )
+    static StreamBuffer_t * xSendBuffer = NULL;
+    static StreamBuffer_t * xRecvBuffer = NULL;
+    static pcap_t * pxOpenedInterfaceHandle = NULL;
+#else
+    static int xPacketSocket = -1;             /* The AF_PACKET socket. */
+    static uint8_t * pucRxRing = NULL;         /* The RX ring, followed by the TX ring. */
+    static uint8_t * pucTxRing = NULL;
+    static size_t uxRxBlockIndex = 0U;         /* The RX block being read, or to be read next. */
+    static uint32_t ulRxPacketsLeft = 0U;      /* The packets of that block that were not read yet. */
+    static struct tpacket3_hdr * pxRxPacket;   /* The next packet to read from that block. */
+    static BaseType_t xRxBlockOwned = pdFALSE; /* pdTRUE while that block is owned by the driver. */
+    static size_t uxTxFrameIndex = 0U;         /* The TX frame to be filled next. */
+#endif
 static char errbuf[ PCAP_ERRBUF_SIZE ];
-static pcap_t * pxOpenedInterfaceHandle = NULL;
 static struct event * pvSendEvent = NULL;
+static size_t uxSendRequests = 0U;             /* Incremented by the IP-task for every frame that is queued. */
+static BaseType_t xSendThreadWaiting = pdFALSE; /* pdTRUE while the send thread is, or is about to start, waiting for pvSendEvent. */
 static uint32_t ulPCAPSendFailures = 0;
 static BaseType_t xConfigNetworkInterfaceToUse = configNETWORK_INTERFACE_TO_USE;
 static BaseType_t xInvalidInterfaceDetected = pdFALSE;
 
 /* ======================= API Function definitions ========================= */
 
-static size_t prvStreamBufferAdd( StreamBuffer_t * pxBuffer,
-                                  const uint8_t * pucData,
-                                  size_t uxByteCount );
+#if ( niUSE_PACKET_MMAP == 0 )
+    static size_t prvStreamBufferAdd( StreamBuffer_t * pxBuffer,
+                                      const uint8_t * pucData,
+                                      size_t uxByteCount );
+#endif
+
+/*
+ * Check a received frame and copy it to a network buffer.  Returns NULL when
+ * the frame is dropped.
+ */
+static NetworkBufferDescriptor_t * prvFrameToNetworkBuffer( const uint8_t * pucPacketData,
+                                                            size_t uxLength );
 
 /*
  * This function will return pdTRUE if the packet is targeted at
@@ -144,21 +245,23 @@ static BaseType_t xNetworkInterfaceInitialise( NetworkInterface_t * pxInterface
         prvPrintAvailableNetworkInterfaces( pxAllNetworkInterfaces );
         ret = prvOpenSelectedNetworkInterface( pxAllNetworkInterfaces );
 
-        if( ret == pdPASS )
-        {
-            ret = prvCreateThreadSafeBuffers();
-
+        #if ( niUSE_PACKET_MMAP == 0 )
             if( ret == pdPASS )
             {
-                ret = prvCreateWorkerThreads();
+                ret = prvCreateThreadSafeBuffers();
             }
+        #endif
+
+        if( ret == pdPASS )
+        {
+            ret = prvCreateWorkerThreads();
         }
 
         /* The device list is no longer required. */
         pcap_freealldevs( pxAllNetworkInterfaces );
     }
 
-    if( ( pxOpenedInterfaceHandle != NULL ) && ( ret == pdPASS ) )
+    if( ( xGetPhyLinkStatus( pxInterface ) != pdFALSE ) && ( ret == pdPASS ) )
     {
         ret = pdPASS;
     }
@@ -166,6 +269,8 @@ static BaseType_t xNetworkInterfaceInitialise( NetworkInterface_t * pxInterface
     return ret;
 }
 
+#if ( niUSE_PACKET_MMAP == 0 )
+
 static size_t prvStreamBufferAdd( StreamBuffer_t * pxBuffer,
                                   const uint8_t * pucData,
                                   size_t uxByteCount )
@@ -216,6 +321,8 @@ static size_t prvStreamBufferAdd( StreamBuffer_t * pxBuffer,
     return uxCount;
 }
 
+#endif /* niUSE_PACKET_MMAP == 0 */
+
 /*!
  * @brief API call, called from reeRTOS_IP.c to send a network packet over the
  *        selected interface
@@ -225,43 +332,68 @@ static BaseType_t xNetworkInterfaceOutput( NetworkInterface_t * pxInterface,
                                            NetworkBufferDescriptor_t * const pxNetworkBuffer,
                                            BaseType_t bReleaseAfterSend )
 {
-    size_t xSpace;
-
     iptraceNETWORK_INTERFACE_TRANSMIT();
     configASSERT( xIsCallingFromIPTask() == pdTRUE );
     ( void ) pxInterface;
 
-    /* Both the length of the data being sent and the actual data being sent
-     *  are placed in the thread safe buffer used to pass data between the FreeRTOS
-     *  tasks and the pthread that sends data via the pcap library.  Drop
-     *  the packet if there is insufficient space in the buffer to hold both. */
-    xSpace = uxStreamBufferGetSpace( xSendBuffer );
-
-    if( ( pxNetworkBuffer->xDataLength <=
-          ( ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ) ) &&
-        ( xSpace >= ( pxNetworkBuffer->xDataLength +
-                      sizeof( pxNetworkBuffer->xDataLength ) ) ) )
+    #if ( niUSE_PACKET_MMAP != 0 )
     {
-        /* First write in the length of the data, then write in the data
-         * itself. */
-        uxStreamBufferAdd( xSendBuffer,
-                           0,
-                           ( const uint8_t * ) &( pxNetworkBuffer->xDataLength ),
-                           sizeof( pxNetworkBuffer->xDataLength ) );
-        uxStreamBufferAdd( xSendBuffer,
-                           0,
-                           ( const uint8_t * ) pxNetworkBuffer->pucEthernetBuffer,
-                           pxNetworkBuffer->xDataLength );
+        /* The frame is copied into the TX ring.  The send thread will pass
+         * all frames that are queued to the kernel in one call. */
+        prvPacketRingOutput( pxNetworkBuffer );
     }
-    else
+    #else
     {
-        FreeRTOS_printf( ( "xNetworkInterfaceOutput: send buffers full to store %lu\n",
-                           pxNetworkBuffer->xDataLength ) );
+        size_t xSpace;
+
+        /* Both the length of the data being sent and the actual data being sent
+         *  are placed in the thread safe buffer used to pass data between the FreeRTOS
+         *  tasks and the pthread that sends data via the pcap library.  Drop
+         *  the packet if there is insufficient space in the buffer to hold both. */
+        xSpace = uxStreamBufferGetSpace( xSendBuffer );
+
+        if( ( pxNetworkBuffer->xDataLength <=
+              ( ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ) ) &&
+            ( xSpace >= ( pxNetworkBuffer->xDataLength +
+                          sizeof( pxNetworkBuffer->xDataLength ) ) ) )
+        {
+            /* First write in the length of the data, then write in the data
+             * itself. */
+            uxStreamBufferAdd( xSendBuffer,
+                               0,
+                               ( const uint8_t * ) &( pxNetworkBuffer->xDataLength ),
+                               sizeof( pxNetworkBuffer->xDataLength ) );
+            uxStreamBufferAdd( xSendBuffer,
+                               0,
+                               ( const uint8_t * ) pxNetworkBuffer->pucEthernetBuffer,
+                               pxNetworkBuffer->xDataLength );
+        }
+        else
+        {
+            FreeRTOS_printf( ( "xNetworkInterfaceOutput: send buffers full to store %lu\n",
+                               pxNetworkBuffer->xDataLength ) );
+        }
     }
+    #endif /* niUSE_PACKET_MMAP != 0 */
 
-    /* Kick the Tx task in either case in case it doesn't know the buffer is
+    /* Kick the Tx thread in either case in case it doesn't know the buffer is
      * full. */
-    event_signal( pvSendEvent );
+    prvSignalSendThread();
+
+    #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+        if( pxNetworkBuffer->ucTxTimestamp != pdFALSE_UNSIGNED )
+        {
+            struct timespec xNow;
+            NetworkTimestamp_t xTimestamp;
+
+            /* There is no completion event: report the time at which the
+             * frame was handed over, on the clock that pcap uses. */
+            ( void ) clock_gettime( CLOCK_REALTIME, &xNow );
+            xTimestamp.ulSeconds = ( uint32_t ) xNow.tv_sec;
+            xTimestamp.ulNanoseconds = ( uint32_t ) xNow.tv_nsec;
+            vNetworkBufferTxTimestamp( pxNetworkBuffer, &xTimestamp );
+        }
+    #endif /* ipconfigUSE_NETWORK_TIMESTAMPS != 0 */
 
     /* The buffer has been sent so can be released. */
     if( bReleaseAfterSend != pdFALSE )
@@ -274,6 +406,8 @@ static BaseType_t xNetworkInterfaceOutput( NetworkInterface_t * pxInterface,
 
 /* ====================== Static Function definitions ======================= */
 
+#if ( niUSE_PACKET_MMAP == 0 )
+
 /*!
  * @brief create thread safe buffers to send/receive packets between threads
  * @returns
@@ -288,7 +422,7 @@ static int prvCreateThreadSafeBuffers( void )
     {
         if( xSendBuffer == NULL )
         {
-            xSendBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) + xSEND_BUFFER_SIZE + 1 );
+            xSendBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) + uxStreamBufferLength( xSEND_BUFFER_SIZE ) );
 
             if( xSendBuffer == NULL )
             {
@@ -297,14 +431,14 @@ static int prvCreateThreadSafeBuffers( void )
 
             configASSERT( xSendBuffer );
             memset( xSendBuffer, '\0', sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) );
-            xSendBuffer->LENGTH = xSEND_BUFFER_SIZE + 1;
+            xSendBuffer->LENGTH = uxStreamBufferLength( xSEND_BUFFER_SIZE );
         }
 
         /* The buffer used to pass received data from the pthread that receives
          * via the pcap library to the FreeRTOS task. */
         if( xRecvBuffer == NULL )
         {
-            xRecvBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) + xRECV_BUFFER_SIZE + 1 );
+            xRecvBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) + uxStreamBufferLength( xRECV_BUFFER_SIZE ) );
 
             if( xRecvBuffer == NULL )
             {
@@ -313,7 +447,7 @@ static int prvCreateThreadSafeBuffers( void )
 
             configASSERT( xRecvBuffer );
             memset( xRecvBuffer, '\0', sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) );
-            xRecvBuffer->LENGTH = xRECV_BUFFER_SIZE + 1;
+            xRecvBuffer->LENGTH = uxStreamBufferLength( xRECV_BUFFER_SIZE );
         }
 
         ret = pdPASS;
@@ -321,6 +455,8 @@ static int prvCreateThreadSafeBuffers( void )
 
     return ret;
 }
+
+#endif /* niUSE_PACKET_MMAP == 0 */
 /*-----------------------------------------------------------*/
 
 BaseType_t xGetPhyLinkStatus( NetworkInterface_t * pxInterface )
@@ -329,7 +465,11 @@ BaseType_t xGetPhyLinkStatus( NetworkInterface_t * pxInterface )
 
     ( void ) pxInterface;
 
-    if( pxOpenedInterfaceHandle != NULL )
+    #if ( niUSE_PACKET_MMAP != 0 )
+        if( xPacketSocket >= 0 )
+    #else
+        if( pxOpenedInterfaceHandle != NULL )
+    #endif
     {
         xResult = pdTRUE;
     }
@@ -474,6 +614,8 @@ static pcap_if_t * prvGetAvailableNetworkInterfaces( void )
     return pxAllNetworkInterfaces;
 }
 
+#if ( niUSE_PACKET_MMAP == 0 )
+
 /*!
  * @brief  set device operation modes
  * @returns pdPASS on success pdFAIL on failure
@@ -534,6 +676,8 @@ static int prvSetDeviceModes()
     return ret;
 }
 
+#endif /* niUSE_PACKET_MMAP == 0 */
+
 /*!
  * @brief  open selected interface given its name
  * @param [in] pucName interface  name to pen
@@ -551,33 +695,41 @@ static int prvOpenInterface( const char * pucName )
 
         FreeRTOS_debug_printf( ( "opening interface %s\n", pucInterfaceName ) );
 
-        pxOpenedInterfaceHandle = pcap_create( pucInterfaceName, errbuf );
-
-        if( pxOpenedInterfaceHandle != NULL )
+        #if ( niUSE_PACKET_MMAP != 0 )
         {
-            ret = prvSetDeviceModes();
+            ret = prvOpenPacketSocket( pucInterfaceName );
+        }
+        #else
+        {
+            pxOpenedInterfaceHandle = pcap_create( pucInterfaceName, errbuf );
 
-            if( ret == pdPASS )
+            if( pxOpenedInterfaceHandle != NULL )
             {
-                if( pcap_activate( pxOpenedInterfaceHandle ) == 0 )
-                {
-                    /* Configure the capture filter to allow blocking reads, and to filter
-                     * out packets that are not of interest to this demo. */
-                    ret = prvConfigureCaptureBehaviour();
-                }
-                else
+                ret = prvSetDeviceModes();
+
+                if( ret == pdPASS )
                 {
-                    FreeRTOS_debug_printf( ( "pcap activate error %s\n",
-                                             pcap_geterr( pxOpenedInterfaceHandle ) ) );
-                    ret = pdFAIL;
+                    if( pcap_activate( pxOpenedInterfaceHandle ) == 0 )
+                    {
+                        /* Configure the capture filter to allow blocking reads, and to filter
+                         * out packets that are not of interest to this demo. */
+                        ret = prvConfigureCaptureBehaviour();
+                    }
+                    else
+                    {
+                        FreeRTOS_debug_printf( ( "pcap activate error %s\n",
+                                                 pcap_geterr( pxOpenedInterfaceHandle ) ) );
+                        ret = pdFAIL;
+                    }
                 }
             }
+            else
+            {
+                FreeRTOS_printf( ( "\n%s is not supported by pcap and cannot be opened %s\n",
+                                   pucInterfaceName, errbuf ) );
+            }
         }
-        else
-        {
-            FreeRTOS_printf( ( "\n%s is not supported by pcap and cannot be opened %s\n",
-                               pucInterfaceName, errbuf ) );
-        }
+        #endif /* niUSE_PACKET_MMAP != 0 */
     }
     else
     {
@@ -624,6 +776,48 @@ static int prvOpenSelectedNetworkInterface( pcap_if_t * pxAllNetworkInterfaces )
     return ret;
 }
 
+/*!
+ * @brief Tell the send thread that a frame was queued.  The thread is only
+ *        woken up when it is waiting, a thread that is busy sending will
+ *        find the frame before it waits again.
+ * @warning this is called from the IP-task
+ */
+static void prvSignalSendThread( void )
+{
+    ( void ) __atomic_add_fetch( &( uxSendRequests ), 1U, __ATOMIC_SEQ_CST );
+
+    if( __atomic_load_n( &( xSendThreadWaiting ), __ATOMIC_SEQ_CST ) != pdFALSE )
+    {
+        event_signal( pvSendEvent );
+    }
+}
+
+/*!
+ * @brief Wait until frames were queued that the send thread has not seen yet.
+ *        When frames were queued while the previous batch was being sent,
+ *        the function returns without waiting.
+ * @param [in,out] puxHandled the value of uxSendRequests that was seen last
+ * @warning this is called from a Linux thread, do not attempt any FreeRTOS calls
+ */
+static void prvWaitForSendRequests( size_t * puxHandled )
+{
+    const time_t xMaxMSToWait = 1000;
+
+    /* Announce the wait before checking for new frames.  Either the IP-task
+     * sees the flag and signals the event, or this thread sees the frame. */
+    __atomic_store_n( &( xSendThreadWaiting ), pdTRUE, __ATOMIC_SEQ_CST );
+
+    if( __atomic_load_n( &( uxSendRequests ), __ATOMIC_SEQ_CST ) == *puxHandled )
+    {
+        event_wait_timed( pvSendEvent, xMaxMSToWait );
+    }
+
+    __atomic_store_n( &( xSendThreadWaiting ), pdFALSE, __ATOMIC_SEQ_CST );
+
+    /* Frames queued from here on are seen in the next call. */
+    *puxHandled = __atomic_load_n( &( uxSendRequests ), __ATOMIC_SEQ_CST );
+}
+
 /*!
  * @brief launch 2 linux threads, one for Tx and one for Rx
  *        and one FreeRTOS thread that will simulate an interrupt
@@ -645,23 +839,38 @@ static int prvCreateWorkerThreads( void )
 
         do
         {
-            /* Create the thread that handles pcap  Rx. */
-            ret = pthread_create( &vPcapRecvThreadHandle,
-                                  NULL,
-                                  prvLinuxPcapRecvThread,
-                                  NULL );
-
-            if( ret != 0 )
+            #if ( niUSE_PACKET_MMAP != 0 )
             {
-                FreeRTOS_printf( ( "pthread error %d", ret ) );
-                break;
+                /* The RX ring is read directly by prvInterruptSimulatorTask(). */
+                ( void ) vPcapRecvThreadHandle;
+
+                /* Create the thread that passes the TX ring to the kernel. */
+                ret = pthread_create( &vPcapSendThreadHandle,
+                                      NULL,
+                                      prvLinuxPacketSendThread,
+                                      NULL );
             }
+            #else
+            {
+                /* Create the thread that handles pcap  Rx. */
+                ret = pthread_create( &vPcapRecvThreadHandle,
+                                      NULL,
+                                      prvLinuxPcapRecvThread,
+                                      NULL );
+
+                if( ret != 0 )
+                {
+                    FreeRTOS_printf( ( "pthread error %d", ret ) );
+                    break;
+                }
 
-            /* Create the thread that handles pcap  Tx. */
-            ret = pthread_create( &vPcapSendThreadHandle,
-                                  NULL,
-                                  prvLinuxPcapSendThread,
-                                  NULL );
+                /* Create the thread that handles pcap  Tx. */
+                ret = pthread_create( &vPcapSendThreadHandle,
+                                      NULL,
+                                      prvLinuxPcapSendThread,
+                                      NULL );
+            }
+            #endif /* niUSE_PACKET_MMAP != 0 */
 
             if( ret != 0 )
             {
@@ -690,6 +899,8 @@ static int prvCreateWorkerThreads( void )
     return ret;
 }
 
+#if ( niUSE_PACKET_MMAP == 0 )
+
 /*!
  * @brief Create the buffers used to pass packets between the FreeRTOS simulator
  *        and the pthreads that are handling pcap as well as the FreeRTOS task
@@ -834,9 +1045,12 @@ static void * prvLinuxPcapRecvThread( void * pvParam )
  */
 static void * prvLinuxPcapSendThread( void * pvParam )
 {
+    static uint8_t ucBuffers[ niTX_BATCH_LENGTH ][ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+    struct mmsghdr xMessages[ niTX_BATCH_LENGTH ];
+    struct iovec xVectors[ niTX_BATCH_LENGTH ];
     size_t xLength;
-    uint8_t ucBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
-    const time_t xMaxMSToWait = 1000;
+    size_t uxCount;
+    size_t uxHandled = 0U;
 
     /* disable signals to avoid treating this thread as a FreeRTOS task and putting
      * it to sleep by the scheduler */
@@ -847,31 +1061,330 @@ static void * prvLinuxPcapSendThread( void * pvParam )
     sigfillset( &set );
     pthread_sigmask( SIG_SETMASK, &set, NULL );
 
+    memset( xMessages, 0, sizeof( xMessages ) );
+
+    for( uxCount = 0U; uxCount < niTX_BATCH_LENGTH; uxCount++ )
+    {
+        xVectors[ uxCount ].iov_base = ucBuffers[ uxCount ];
+        xMessages[ uxCount ].msg_hdr.msg_iov = &( xVectors[ uxCount ] );
+        xMessages[ uxCount ].msg_hdr.msg_iovlen = 1;
+    }
+
     for( ; ; )
     {
         /* Wait until notified of something to send. */
-        event_wait_timed( pvSendEvent, xMaxMSToWait );
+        prvWaitForSendRequests( &( uxHandled ) );
 
         /* Is there more than the length value stored in the circular buffer
         * used to pass data from the FreeRTOS simulator into this pthread?*/
         while( uxStreamBufferGetSize( xSendBuffer ) > sizeof( xLength ) )
         {
-            uxStreamBufferGet( xSendBuffer, 0, ( uint8_t * ) &xLength, sizeof( xLength ), pdFALSE );
-            uxStreamBufferGet( xSendBuffer, 0, ( uint8_t * ) ucBuffer, xLength, pdFALSE );
-            FreeRTOS_debug_printf( ( "Sending  ========== > data pcap_sendpacket %lu\n", xLength ) );
-            print_hex( ucBuffer, xLength );
+            /* Collect a batch of frames, and pass all of them to the kernel
+             * in one system call. */
+            uxCount = 0U;
 
-            if( pcap_sendpacket( pxOpenedInterfaceHandle, ucBuffer, ( int ) xLength ) != 0 )
+            while( ( uxCount < niTX_BATCH_LENGTH ) &&
+                   ( uxStreamBufferGetSize( xSendBuffer ) > sizeof( xLength ) ) )
             {
-                FreeRTOS_printf( ( "pcap_sendpacket: send failed %d\n", ulPCAPSendFailures ) );
-                ulPCAPSendFailures++;
+                uxStreamBufferGet( xSendBuffer, 0, ( uint8_t * ) &xLength, sizeof( xLength ), pdFALSE );
+                uxStreamBufferGet( xSendBuffer, 0, ucBuffers[ uxCount ], xLength, pdFALSE );
+                FreeRTOS_debug_printf( ( "Sending  ========== > data sendmmsg %lu\n", xLength ) );
+                print_hex( ucBuffers[ uxCount ], xLength );
+
+                xVectors[ uxCount ].iov_len = xLength;
+                uxCount++;
             }
+
+            prvPcapSendBatch( xMessages, uxCount );
         }
     }
 
     return NULL;
 }
 
+/*!
+ * @brief Send a batch of frames through the socket of the pcap handle.  Frames
+ *        that sendmmsg() did not accept are sent one by one with
+ *        pcap_sendpacket().
+ * @param [in] pxMessages the frames
+ * @param [in] uxCount the number of frames
+ * @warning this is called from a Linux thread, do not attempt any FreeRTOS calls
+ */
+static void prvPcapSendBatch( struct mmsghdr * pxMessages,
+                              size_t uxCount )
+{
+    int iSent;
+    size_t uxIndex;
+
+    iSent = sendmmsg( pcap_fileno( pxOpenedInterfaceHandle ), pxMessages, ( unsigned int ) uxCount, 0 );
+
+    if( iSent < 0 )
+    {
+        FreeRTOS_debug_printf( ( "sendmmsg: %s\n", strerror( errno ) ) );
+        iSent = 0;
+    }
+
+    for( uxIndex = ( size_t ) iSent; uxIndex < uxCount; uxIndex++ )
+    {
+        if( pcap_sendpacket( pxOpenedInterfaceHandle,
+                             ( const u_char * ) pxMessages[ uxIndex ].msg_hdr.msg_iov->iov_base,
+                             ( int ) pxMessages[ uxIndex ].msg_hdr.msg_iov->iov_len ) != 0 )
+        {
+            FreeRTOS_printf( ( "pcap_sendpacket: send failed %d\n", ulPCAPSendFailures ) );
+            ulPCAPSendFailures++;
+        }
+    }
+}
+
+#else /* niUSE_PACKET_MMAP == 0 */
+
+/*!
+ * @brief Open an AF_PACKET socket on the given interface, and map its RX and TX
+ *        rings into memory.  Both rings use the TPACKET_V3 format.
+ * @param [in] pcName The name of the interface.
+ * @returns pdPASS on success pdFAIL on failure
+ */
+static int prvOpenPacketSocket( const char * pcName )
+{
+    int ret = pdFAIL;
+    int iVersion = TPACKET_V3;
+    struct tpacket_req3 xRxRequest;
+    struct tpacket_req3 xTxRequest;
+    struct sockaddr_ll xAddress;
+    struct packet_mreq xMembership;
+    size_t uxRxRingSize;
+    size_t uxTxRingSize;
+    void * pvRings;
+    unsigned int uxIndex = if_nametoindex( pcName );
+
+    do
+    {
+        if( uxIndex == 0U )
+        {
+            FreeRTOS_printf( ( "unknown interface %s\n", pcName ) );
+            break;
+        }
+
+        xPacketSocket = socket( AF_PACKET, SOCK_RAW, htons( ETH_P_ALL ) );
+
+        if( xPacketSocket < 0 )
+        {
+            FreeRTOS_printf( ( "could not open a packet socket: %s\n", strerror( errno ) ) );
+            break;
+        }
+
+        if( setsockopt( xPacketSocket, SOL_PACKET, PACKET_VERSION, &iVersion, sizeof( iVersion ) ) != 0 )
+        {
+            FreeRTOS_printf( ( "TPACKET_V3 is not supported: %s\n", strerror( errno ) ) );
+            break;
+        }
+
+        memset( &xRxRequest, 0, sizeof( xRxRequest ) );
+        xRxRequest.tp_block_size = niPACKET_MMAP_BLOCK_SIZE;
+        xRxRequest.tp_block_nr = niPACKET_MMAP_RX_BLOCKS;
+        xRxRequest.tp_frame_size = niPACKET_MMAP_FRAME_SIZE;
+        xRxRequest.tp_frame_nr = ( niPACKET_MMAP_BLOCK_SIZE / niPACKET_MMAP_FRAME_SIZE ) * niPACKET_MMAP_RX_BLOCKS;
+        xRxRequest.tp_retire_blk_tov = niPACKET_MMAP_RX_RETIRE_MS;
+
+        /* The TX ring has fixed-size frames, it must not use the RX options. */
+        memset( &xTxRequest, 0, sizeof( xTxRequest ) );
+        xTxRequest.tp_block_size = niPACKET_MMAP_BLOCK_SIZE;
+        xTxRequest.tp_block_nr = niPACKET_MMAP_TX_BLOCKS;
+        xTxRequest.tp_frame_size = niPACKET_MMAP_FRAME_SIZE;
+        xTxRequest.tp_frame_nr = niPACKET_MMAP_TX_FRAMES;
+
+        if( ( setsockopt( xPacketSocket, SOL_PACKET, PACKET_RX_RING, &xRxRequest, sizeof( xRxRequest ) ) != 0 ) ||
+            ( setsockopt( xPacketSocket, SOL_PACKET, PACKET_TX_RING, &xTxRequest, sizeof( xTxRequest ) ) != 0 ) )
+        {
+            FreeRTOS_printf( ( "could not create the packet rings: %s\n", strerror( errno ) ) );
+            break;
+        }
+
+        /* The TX ring is mapped directly after the RX ring. */
+        uxRxRingSize = ( size_t ) niPACKET_MMAP_BLOCK_SIZE * niPACKET_MMAP_RX_BLOCKS;
+        uxTxRingSize = ( size_t ) niPACKET_MMAP_BLOCK_SIZE * niPACKET_MMAP_TX_BLOCKS;
+        pvRings = mmap( NULL, uxRxRingSize + uxTxRingSize, PROT_READ | PROT_WRITE, MAP_SHARED, xPacketSocket, 0 );
+
+        if( pvRings == MAP_FAILED )
+        {
+            FreeRTOS_printf( ( "could not map the packet rings: %s\n", strerror( errno ) ) );
+            break;
+        }
+
+        pucRxRing = ( uint8_t * ) pvRings;
+        pucTxRing = &( pucRxRing[ uxRxRingSize ] );
+
+        memset( &xAddress, 0, sizeof( xAddress ) );
+        xAddress.sll_family = AF_PACKET;
+        xAddress.sll_protocol = htons( ETH_P_ALL );
+        xAddress.sll_ifindex = ( int ) uxIndex;
+
+        if( bind( xPacketSocket, ( struct sockaddr * ) &xAddress, sizeof( xAddress ) ) != 0 )
+        {
+            FreeRTOS_printf( ( "could not bind to %s: %s\n", pcName, strerror( errno ) ) );
+            break;
+        }
+
+        /* Open in promiscuous mode as the MAC address is going to be
+         * "simulated", see prvSetDeviceModes(). */
+        memset( &xMembership, 0, sizeof( xMembership ) );
+        xMembership.mr_ifindex = ( int ) uxIndex;
+        xMembership.mr_type = PACKET_MR_PROMISC;
+
+        if( setsockopt( xPacketSocket, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &xMembership, sizeof( xMembership ) ) != 0 )
+        {
+            FreeRTOS_printf( ( "could not activate promiscuous mode\n" ) );
+            break;
+        }
+
+        ret = pdPASS;
+    } while( 0 );
+
+    if( ( ret != pdPASS ) && ( xPacketSocket >= 0 ) )
+    {
+        if( pucRxRing != NULL )
+        {
+            ( void ) munmap( pucRxRing, ( size_t ) niPACKET_MMAP_BLOCK_SIZE * ( niPACKET_MMAP_RX_BLOCKS + niPACKET_MMAP_TX_BLOCKS ) );
+            pucRxRing = NULL;
+            pucTxRing = NULL;
+        }
+
+        ( void ) close( xPacketSocket );
+        xPacketSocket = -1;
+    }
+
+    return ret;
+}
+
+/*!
+ * @brief Copy a frame into the next free slot of the TX ring.  The frame is
+ *        dropped when the ring is full.
+ * @param [in] pxNetworkBuffer The frame to send.
+ * @warning this is called from the IP-task, it does not make system calls
+ */
+static void prvPacketRingOutput( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    uint8_t * pucFrame = &( pucTxRing[ uxTxFrameIndex * niPACKET_MMAP_FRAME_SIZE ] );
+    struct tpacket3_hdr * pxHeader = ( struct tpacket3_hdr * ) pucFrame;
+    const size_t uxDataOffset = TPACKET3_HDRLEN - sizeof( struct sockaddr_ll );
+    uint32_t ulStatus = __atomic_load_n( &( pxHeader->tp_status ), __ATOMIC_ACQUIRE );
+
+    if( ( ( ulStatus & ( TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING ) ) != 0U ) ||
+        ( pxNetworkBuffer->xDataLength > ( niPACKET_MMAP_FRAME_SIZE - uxDataOffset ) ) )
+    {
+        FreeRTOS_printf( ( "xNetworkInterfaceOutput: TX ring full to store %lu\n",
+                           pxNetworkBuffer->xDataLength ) );
+    }
+    else
+    {
+        FreeRTOS_debug_printf( ( "Sending  ========== > data TX ring %lu\n", pxNetworkBuffer->xDataLength ) );
+        print_hex( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+
+        ( void ) memcpy( &( pucFrame[ uxDataOffset ] ), pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+        pxHeader->tp_len = ( uint32_t ) pxNetworkBuffer->xDataLength;
+        pxHeader->tp_snaplen = ( uint32_t ) pxNetworkBuffer->xDataLength;
+        pxHeader->tp_next_offset = 0U;
+
+        /* Hand the frame to the kernel after its contents. */
+        __atomic_store_n( &( pxHeader->tp_status ), TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE );
+
+        uxTxFrameIndex++;
+
+        if( uxTxFrameIndex == niPACKET_MMAP_TX_FRAMES )
+        {
+            uxTxFrameIndex = 0U;
+        }
+    }
+}
+
+/*!
+ * @brief Get the next received frame from the RX ring.  The frame stays valid
+ *        until the next call, which returns its block to the kernel once all
+ *        frames of the block have been read.
+ * @param [out] ppucData Will point to the Ethernet frame.
+ * @returns The length of the frame, or zero when no frame is available.
+ * @warning this is called from a FreeRTOS task, it does not make system calls
+ */
+static size_t prvPacketRingReceive( const uint8_t ** ppucData )
+{
+    struct tpacket_block_desc * pxBlock = ( struct tpacket_block_desc * ) &( pucRxRing[ uxRxBlockIndex * niPACKET_MMAP_BLOCK_SIZE ] );
+    size_t uxLength = 0U;
+
+    if( ( ulRxPacketsLeft == 0U ) && ( xRxBlockOwned != pdFALSE ) )
+    {
+        /* All frames have been copied, return the block to the kernel. */
+        __atomic_store_n( &( pxBlock->hdr.bh1.block_status ), TP_STATUS_KERNEL, __ATOMIC_RELEASE );
+        xRxBlockOwned = pdFALSE;
+
+        uxRxBlockIndex++;
+
+        if( uxRxBlockIndex == niPACKET_MMAP_RX_BLOCKS )
+        {
+            uxRxBlockIndex = 0U;
+        }
+
+        pxBlock = ( struct tpacket_block_desc * ) &( pucRxRing[ uxRxBlockIndex * niPACKET_MMAP_BLOCK_SIZE ] );
+    }
+
+    if( ( xRxBlockOwned == pdFALSE ) &&
+        ( ( __atomic_load_n( &( pxBlock->hdr.bh1.block_status ), __ATOMIC_ACQUIRE ) & TP_STATUS_USER ) != 0U ) )
+    {
+        /* The kernel has retired the block, all its frames can be read. */
+        xRxBlockOwned = pdTRUE;
+        ulRxPacketsLeft = pxBlock->hdr.bh1.num_pkts;
+        pxRxPacket = ( struct tpacket3_hdr * ) &( ( ( uint8_t * ) pxBlock )[ pxBlock->hdr.bh1.offset_to_first_pkt ] );
+    }
+
+    if( ulRxPacketsLeft > 0U )
+    {
+        *ppucData = &( ( ( const uint8_t * ) pxRxPacket )[ pxRxPacket->tp_mac ] );
+        uxLength = ( size_t ) pxRxPacket->tp_snaplen;
+
+        ulRxPacketsLeft--;
+        pxRxPacket = ( struct tpacket3_hdr * ) &( ( ( uint8_t * ) pxRxPacket )[ pxRxPacket->tp_next_offset ] );
+    }
+
+    return uxLength;
+}
+
+/*!
+ * @brief Infinite loop thread that waits for events when frames were added to
+ *        the TX ring, then asks the kernel to send all of them
+ * @param [in] pvParam not used
+ * @returns NULL
+ * @warning this is called from a Linux thread, do not attempt any FreeRTOS calls
+ */
+static void * prvLinuxPacketSendThread( void * pvParam )
+{
+    size_t uxHandled = 0U;
+
+    /* disable signals to avoid treating this thread as a FreeRTOS task and putting
+     * it to sleep by the scheduler */
+    sigset_t set;
+
+    ( void ) pvParam;
+
+    sigfillset( &set );
+    pthread_sigmask( SIG_SETMASK, &set, NULL );
+
+    for( ; ; )
+    {
+        /* Wait until notified of something to send. */
+        prvWaitForSendRequests( &( uxHandled ) );
+
+        /* Send all frames that are marked TP_STATUS_SEND_REQUEST. */
+        if( send( xPacketSocket, NULL, 0, 0 ) < 0 )
+        {
+            FreeRTOS_printf( ( "send: TX ring failed %d: %s\n", ulPCAPSendFailures, strerror( errno ) ) );
+            ulPCAPSendFailures++;
+        }
+    }
+
+    return NULL;
+}
+
+#endif /* niUSE_PACKET_MMAP == 0 */
+
 /*-----------------------------------------------------------*/
 
 static BaseType_t xPacketBouncedBack( const uint8_t * pucBuffer )
@@ -912,6 +1425,91 @@ static BaseType_t xPacketBouncedBack( const uint8_t * pucBuffer )
 }
 /*-----------------------------------------------------------*/
 
+/*!
+ * @brief Check a received frame and copy it to a network buffer
+ * @param [in] pucPacketData the Ethernet frame
+ * @param [in] uxLength the length of the frame
+ * @returns the network buffer, or NULL when the frame is dropped
+ */
+static NetworkBufferDescriptor_t * prvFrameToNetworkBuffer( const uint8_t * pucPacketData,
+                                                            size_t uxLength )
+{
+    NetworkBufferDescriptor_t * pxNetworkBuffer = NULL;
+    eFrameProcessingResult_t eResult;
+
+    iptraceNETWORK_INTERFACE_RECEIVE();
+
+    /* Check for minimal size. */
+    if( uxLength >= sizeof( EthernetHeader_t ) )
+    {
+        eResult = ipCONSIDER_FRAME_FOR_PROCESSING( pucPacketData );
+    }
+    else
+    {
+        eResult = eReleaseBuffer;
+    }
+
+    if( eResult == eProcessBuffer )
+    {
+        /* Will the data fit into the frame buffer? */
+        if( uxLength <= ipTOTAL_ETHERNET_FRAME_SIZE )
+        {
+            /* Obtain a buffer into which the data can be placed.  This
+             * is only an interrupt simulator, not a real interrupt, so it
+             * is ok to call the task level function here, but note that
+             * some buffer implementations cannot be called from a real
+             * interrupt. */
+            if( xPacketBouncedBack( pucPacketData ) == pdFALSE )
+            {
+                pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxLength, 0 );
+            }
+            else
+            {
+                pxNetworkBuffer = NULL;
+            }
+
+            if( pxNetworkBuffer != NULL )
+            {
+                memcpy( pxNetworkBuffer->pucEthernetBuffer, pucPacketData, uxLength );
+                pxNetworkBuffer->xDataLength = uxLength;
+
+                #if ( niDISRUPT_PACKETS == 1 )
+                {
+                    pxNetworkBuffer = vRxFaultInjection( pxNetworkBuffer, pucPacketData );
+                }
+                #endif /* niDISRUPT_PACKETS */
+
+                if( pxNetworkBuffer != NULL )
+                {
+                    pxNetworkBuffer->pxInterface = pxMyInterface;
+                    pxNetworkBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxMyInterface, pxNetworkBuffer->pucEthernetBuffer );
+                    pxNetworkBuffer->pxEndPoint = pxNetworkEndPoints; /*temporary change for single end point */
+                }
+                else
+                {
+                    /* The packet was already released or stored inside
+                     * vRxFaultInjection().  Don't release it here. */
+                }
+            }
+            else
+            {
+                iptraceETHERNET_RX_EVENT_LOST();
+            }
+        }
+        else
+        {
+            /* Log that a packet was dropped because it would have
+             * overflowed the buffer, but there may be more buffers to
+             * process. */
+        }
+    }
+
+    return pxNetworkBuffer;
+}
+/*-----------------------------------------------------------*/
+
+#if ( niUSE_PACKET_MMAP == 0 )
+
 /*!
  * @brief FreeRTOS infinite loop thread that simulates a network interrupt to notify the
  *         network stack of the presence of new data
@@ -920,12 +1518,10 @@ static BaseType_t xPacketBouncedBack( const uint8_t * pucBuffer )
 static void prvInterruptSimulatorTask( void * pvParameters )
 {
     struct pcap_pkthdr xHeader;
-    static struct pcap_pkthdr * pxHeader;
-    const uint8_t * pucPacketData;
     uint8_t ucRecvBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
     NetworkBufferDescriptor_t * pxNetworkBuffer;
-    IPStackEvent_t xRxEvent = { eNetworkRxEvent, NULL };
-    eFrameProcessingResult_t eResult;
+    NetworkBufferDescriptor_t * pxBurst[ niRX_BURST_LENGTH ];
+    size_t uxBurstCount = 0U;
 
     /* Remove compiler warnings about unused parameters. */
     ( void ) pvParameters;
@@ -939,102 +1535,119 @@ static void prvInterruptSimulatorTask( void * pvParameters )
             /* Get the next packet. */
             uxStreamBufferGet( xRecvBuffer, 0, ( uint8_t * ) &xHeader, sizeof( xHeader ), pdFALSE );
             uxStreamBufferGet( xRecvBuffer, 0, ( uint8_t * ) ucRecvBuffer, ( size_t ) xHeader.len, pdFALSE );
-            pucPacketData = ucRecvBuffer;
-            pxHeader = &xHeader;
 
-            iptraceNETWORK_INTERFACE_RECEIVE();
+            pxNetworkBuffer = prvFrameToNetworkBuffer( ucRecvBuffer, ( size_t ) xHeader.len );
 
-            /* Check for minimal size. */
-            if( pxHeader->len >= sizeof( EthernetHeader_t ) )
+            if( pxNetworkBuffer != NULL )
             {
-                eResult = ipCONSIDER_FRAME_FOR_PROCESSING( pucPacketData );
-            }
-            else
-            {
-                eResult = eReleaseBuffer;
+                #if ( ipconfigUSE_NETWORK_TIMESTAMPS != 0 )
+                {
+                    /* pcap has recorded the time of reception. */
+                    pxNetworkBuffer->xTimestamp.ulSeconds = ( uint32_t ) xHeader.ts.tv_sec;
+                    pxNetworkBuffer->xTimestamp.ulNanoseconds = ( uint32_t ) xHeader.ts.tv_usec * 1000U;
+                }
+                #endif
+
+                /* Data was received and stored.  Collect it, the
+                 * IP-task will be informed once the burst is
+                 * complete. */
+                pxBurst[ uxBurstCount ] = pxNetworkBuffer;
+                uxBurstCount++;
             }
+        }
+
+        if( ( uxBurstCount == niRX_BURST_LENGTH ) ||
+            ( ( uxBurstCount > 0U ) && ( uxStreamBufferGetSize( xRecvBuffer ) <= sizeof( xHeader ) ) ) )
+        {
+            /* Pass all collected buffers to the IP-task in one go.  Buffers
+             * that can not be delivered are released by the IP-stack.  This
+             * is only an interrupt simulator, not a real interrupt, so it is
+             * ok to use the task level function here. */
+            ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, ( TickType_t ) 0 );
+            uxBurstCount = 0U;
+        }
+        else if( uxBurstCount == 0U )
+        {
+            /* There is no real way of simulating an interrupt.  Make sure
+             * other tasks can run. */
+            vTaskDelay( configWINDOWS_MAC_INTERRUPT_SIMULATOR_DELAY );
+        }
+        else
+        {
+            /* More packets are waiting, continue collecting. */
+        }
+    }
+}
+
+#else /* niUSE_PACKET_MMAP == 0 */
+
+/*!
+ * @brief FreeRTOS infinite loop thread that simulates a network interrupt: it
+ *         reads the frames from the RX ring and passes them to the network
+ *         stack in bursts
+ * @param [in] pvParameters not used
+ */
+static void prvInterruptSimulatorTask( void * pvParameters )
+{
+    const uint8_t * pucPacketData = NULL;
+    size_t uxLength;
+    const EthernetHeader_t * pxEtherHeader;
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    NetworkBufferDescriptor_t * pxBurst[ niRX_BURST_LENGTH ];
+    size_t uxBurstCount = 0U;
 
-            if( eResult == eProcessBuffer )
+    /* Remove compiler warnings about unused parameters. */
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        uxLength = prvPacketRingReceive( &( pucPacketData ) );
+
+        if( uxLength >= sizeof( EthernetHeader_t ) )
+        {
+            FreeRTOS_debug_printf( ( "Receiving < =========== RX ring len: %lu\n", uxLength ) );
+            print_hex( pucPacketData, uxLength );
+
+            /* There is no capture filter: accept broadcast, multicast and
+             * frames sent to this interface, like the pcap filter. */
+            pxEtherHeader = ( const EthernetHeader_t * ) pucPacketData;
+
+            if( ( ( pxEtherHeader->xDestinationAddress.ucBytes[ 0 ] & 0x01U ) != 0U ) ||
+                ( memcmp( pxEtherHeader->xDestinationAddress.ucBytes,
+                          pxMyInterface->pxEndPoint->xMACAddress.ucBytes,
+                          ipMAC_ADDRESS_LENGTH_BYTES ) == 0 ) )
             {
-                /* Will the data fit into the frame buffer? */
-                if( pxHeader->len <= ipTOTAL_ETHERNET_FRAME_SIZE )
-                {
-                    /* Obtain a buffer into which the data can be placed.  This
-                     * is only an interrupt simulator, not a real interrupt, so it
-                     * is ok to call the task level function here, but note that
-                     * some buffer implementations cannot be called from a real
-                     * interrupt. */
-                    if( xPacketBouncedBack( pucPacketData ) == pdFALSE )
-                    {
-                        pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( pxHeader->len, 0 );
-                    }
-                    else
-                    {
-                        pxNetworkBuffer = NULL;
-                    }
+                pxNetworkBuffer = prvFrameToNetworkBuffer( pucPacketData, uxLength );
 
-                    if( pxNetworkBuffer != NULL )
-                    {
-                        memcpy( pxNetworkBuffer->pucEthernetBuffer, pucPacketData, pxHeader->len );
-                        pxNetworkBuffer->xDataLength = ( size_t ) pxHeader->len;
-
-                        #if ( niDISRUPT_PACKETS == 1 )
-                        {
-                            pxNetworkBuffer = vRxFaultInjection( pxNetworkBuffer, pucPacketData );
-                        }
-                        #endif /* niDISRUPT_PACKETS */
-
-                        if( pxNetworkBuffer != NULL )
-                        {
-                            xRxEvent.pvData = ( void * ) pxNetworkBuffer;
-
-                            pxNetworkBuffer->pxInterface = pxMyInterface;
-                            pxNetworkBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxMyInterface, pxNetworkBuffer->pucEthernetBuffer );
-                            pxNetworkBuffer->pxEndPoint = pxNetworkEndPoints; /*temporary change for single end point */
-
-                            /* Data was received and stored.  Send a message to
-                             * the IP task to let it know. */
-                            if( xSendEventStructToIPTask( &xRxEvent, ( TickType_t ) 0 ) == pdFAIL )
-                            {
-                                /* The buffer could not be sent to the stack so
-                                 * must be released again.  This is only an
-                                 * interrupt simulator, not a real interrupt, so it
-                                 * is ok to use the task level function here, but
-                                 * note no all buffer implementations will allow
-                                 * this function to be executed from a real
-                                 * interrupt. */
-                                vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
-                                iptraceETHERNET_RX_EVENT_LOST();
-                            }
-                        }
-                        else
-                        {
-                            /* The packet was already released or stored inside
-                             * vRxFaultInjection().  Don't release it here. */
-                        }
-                    }
-                    else
-                    {
-                        iptraceETHERNET_RX_EVENT_LOST();
-                    }
-                }
-                else
+                if( pxNetworkBuffer != NULL )
                 {
-                    /* Log that a packet was dropped because it would have
-                     * overflowed the buffer, but there may be more buffers to
-                     * process. */
+                    pxBurst[ uxBurstCount ] = pxNetworkBuffer;
+                    uxBurstCount++;
                 }
             }
         }
-        else
+
+        if( ( uxBurstCount == niRX_BURST_LENGTH ) ||
+            ( ( uxBurstCount > 0U ) && ( uxLength == 0U ) ) )
         {
-            /* There is no real way of simulating an interrupt.  Make sure
-             * other tasks can run. */
+            /* Pass all collected buffers to the IP-task in one go. */
+            ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, ( TickType_t ) 0 );
+            uxBurstCount = 0U;
+        }
+        else if( uxLength == 0U )
+        {
+            /* The RX ring is empty.  Make sure other tasks can run. */
             vTaskDelay( configWINDOWS_MAC_INTERRUPT_SIMULATOR_DELAY );
         }
+        else
+        {
+            /* More packets are waiting, continue collecting. */
+        }
     }
 }
 
+#endif /* niUSE_PACKET_MMAP == 0 */
+
 /*!
  * @brief remove spaces from pcMessage into pcBuffer
  * @param [out] pcBuffer buffer to fill up
@@ -0,0 +1,870 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * A network interface for the Linux port that exchanges frames with the kernel
+ * through AF_XDP sockets.
+ *
+ * The network buffers of BufferAllocation_1.c are the UMEM: the memory area
+ * that is shared between the kernel and the XDP sockets.  Every descriptor
+ * owns one UMEM frame, see vNetworkInterfaceAllocateRAMToBuffers().  A
+ * received frame is passed to the IP-task in the network buffer that the
+ * kernel wrote it to, and a network buffer is sent by placing its address
+ * in the TX ring.  Frames are not copied, unless the NIC driver only
+ * supports the XDP copy mode, in which case the kernel does the copy.
+ *
+ * One XDP socket is bound to each of the first niXDP_QUEUE_COUNT queues of
+ * the interface, all sockets share the same UMEM.  Frames are sent through
+ * the socket of queue niXDP_TX_QUEUE, so that TCP segments are not reordered.
+ * When ipconfigUSE_NETWORK_MULTI_QUEUE is enabled, the queues are published
+ * in the NetworkInterface_t, and each frame is sent through the queue that
+ * uxNetworkInterfaceSelectQueue() picks for its flow.
+ *
+ * libxdp loads the XDP program that redirects the frames of each queue to
+ * its socket.  All traffic of those queues is taken from the host's network
+ * stack, so use a dedicated interface, e.g. one end of a veth pair.  The
+ * process needs the CAP_NET_ADMIN and CAP_NET_RAW capabilities.
+ */
+
+/* ========================= FreeRTOS includes ============================== */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* ======================== Standard Library includes ======================== */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <xdp/xsk.h>
+
+/* ========================= FreeRTOS+TCP includes ========================== */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "NetworkBufferManagement.h"
+
+/* ======================== Macro Definitions =============================== */
+#if ( ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES == 0 )
+    #define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer )    eProcessBuffer
+#else
+    #define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer ) \
+    eConsiderFrameForProcessing( ( pucEthernetBuffer ) )
+#endif
+
+/* ============================== Definitions =============================== */
+
+/* The name of the Linux network interface. */
+#ifndef niXDP_INTERFACE_NAME
+    #define niXDP_INTERFACE_NAME    "eth0"
+#endif
+
+/* The number of queues of the interface that get an XDP socket, starting at
+ * queue 0.  Use 'ethtool -L' to set the number of queues of the interface,
+ * and make sure that the RSS hash spreads the traffic over all of them. */
+#ifndef niXDP_QUEUE_COUNT
+    #define niXDP_QUEUE_COUNT    1U
+#endif
+
+/* The queue through which all frames are sent. */
+#ifndef niXDP_TX_QUEUE
+    #define niXDP_TX_QUEUE    0U
+#endif
+
+/* The size of a UMEM frame, a power of 2 between 2048 and the page size. */
+#ifndef niXDP_FRAME_SIZE
+    #define niXDP_FRAME_SIZE    XSK_UMEM__DEFAULT_FRAME_SIZE
+#endif
+
+/* The number of descriptors in each of the four rings of a socket, a power
+ * of 2. */
+#ifndef niXDP_RING_SIZE
+    #define niXDP_RING_SIZE    256U
+#endif
+
+/* The number of network buffers that every queue keeps in its fill ring, they
+ * are owned by the kernel until a frame is received in them.  By default the
+ * fill rings take up to half of the network buffers. */
+#ifndef niXDP_FILL_COUNT
+    #if ( ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS / ( 2U * niXDP_QUEUE_COUNT ) ) < 64U )
+        #define niXDP_FILL_COUNT    ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS / ( 2U * niXDP_QUEUE_COUNT ) )
+    #else
+        #define niXDP_FILL_COUNT    64U
+    #endif
+#endif
+
+/* When not 0, the sockets are read on every pass of the RX task, and the
+ * kernel then polls the NIC from that context instead of waiting for an
+ * interrupt.  The value is given to SO_BUSY_POLL, in us.  To keep the NIC's
+ * interrupts masked while it is polled, also set napi_defer_hard_irqs and
+ * gro_flush_timeout of the interface, see SO_PREFER_BUSY_POLL.  Set to 0 to
+ * use interrupts only. */
+#ifndef niXDP_BUSY_POLL_US
+    #define niXDP_BUSY_POLL_US    20U
+#endif
+
+/* The maximum number of frames that one busy-poll handles. */
+#ifndef niXDP_BUSY_POLL_BUDGET
+    #define niXDP_BUSY_POLL_BUDGET    64U
+#endif
+
+/* The flags used to attach the XDP program, e.g. XDP_FLAGS_DRV_MODE or
+ * XDP_FLAGS_SKB_MODE.  0 lets the kernel choose. */
+#ifndef niXDP_ATTACH_FLAGS
+    #define niXDP_ATTACH_FLAGS    0U
+#endif
+
+/* The flags used to bind the sockets, e.g. XDP_ZEROCOPY to fail when the NIC
+ * driver can not do zero-copy, or XDP_COPY.  0 lets the kernel choose. */
+#ifndef niXDP_BIND_FLAGS
+    #define niXDP_BIND_FLAGS    0U
+#endif
+
+/* The maximum number of received packets that are passed to the IP-task
+ * in a single burst. */
+#ifndef niRX_BURST_LENGTH
+    #define niRX_BURST_LENGTH    8U
+#endif
+
+/* The kernel writes a received frame XDP_PACKET_HEADROOM bytes after the
+ * start of a UMEM frame.  The pucEthernetBuffer of each descriptor is put at
+ * that offset, so that the frame ends up where the IP-stack expects it. */
+#define niXDP_DATA_OFFSET    256U
+
+#if ( niXDP_FILL_COUNT < 1U )
+    #error Not enough network buffers for niXDP_QUEUE_COUNT fill rings
+#endif
+
+#if ( niXDP_TX_QUEUE >= niXDP_QUEUE_COUNT )
+    #error niXDP_TX_QUEUE must be one of the niXDP_QUEUE_COUNT queues
+#endif
+
+#if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 ) && ( niXDP_QUEUE_COUNT > ipconfigNETWORK_MAX_QUEUES )
+    #error niXDP_QUEUE_COUNT is larger than ipconfigNETWORK_MAX_QUEUES
+#endif
+
+#if ( niXDP_FILL_COUNT > niXDP_RING_SIZE )
+    #error niXDP_FILL_COUNT does not fit in the fill ring
+#endif
+
+#if ( ( niXDP_QUEUE_COUNT * niXDP_FILL_COUNT ) >= ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS )
+    #error The fill rings take all network buffers, increase ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
+#endif
+
+/* Not all C libraries define the busy-poll socket options yet. */
+#ifndef SO_PREFER_BUSY_POLL
+    #define SO_PREFER_BUSY_POLL    69
+#endif
+
+#ifndef SO_BUSY_POLL_BUDGET
+    #define SO_BUSY_POLL_BUDGET    70
+#endif
+
+/* The rings of one XDP socket. */
+typedef struct xXDP_QUEUE
+{
+    struct xsk_socket * pxSocket;
+    struct xsk_ring_cons xRxRing;
+    struct xsk_ring_prod xTxRing;
+    struct xsk_ring_prod xFillRing;
+    struct xsk_ring_cons xCompletionRing;
+    size_t uxFillCount; /**< The number of network buffers that are in the fill ring or in the RX ring. */
+} XDPQueue_t;
+
+/* ================== Static Function Prototypes ============================ */
+static BaseType_t xNetworkInterfaceInitialise( NetworkInterface_t * pxInterface );
+static BaseType_t xNetworkInterfaceOutput( NetworkInterface_t * pxInterface,
+                                           NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                           BaseType_t bReleaseAfterSend );
+static BaseType_t prvCreateSockets( void );
+static void prvSetBusyPoll( int iSocket );
+static void prvFillQueue( XDPQueue_t * pxQueue );
+static size_t prvReceiveQueue( XDPQueue_t * pxQueue );
+static void prvReleaseCompleted( XDPQueue_t * pxQueue );
+static void prvInterruptSimulatorTask( void * pvParameters );
+
+NetworkInterface_t * pxLinuxXDP_FillInterfaceDescriptor( BaseType_t xEMACIndex,
+                                                         NetworkInterface_t * pxInterface );
+
+/* ======================== Static Variables ================================ */
+
+/* A pointer to the network interface is needed later when receiving packets. */
+static NetworkInterface_t * pxMyInterface;
+
+/* The memory area that holds the frames of all network buffers. */
+static uint8_t * pucUmemArea;
+
+/* The descriptors, pxUmemDescriptors[ x ] owns UMEM frame x. */
+static NetworkBufferDescriptor_t * pxUmemDescriptors;
+
+static struct xsk_umem * pxUmem;
+
+static XDPQueue_t xQueues[ niXDP_QUEUE_COUNT ];
+
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief Translate a UMEM address to the network buffer that owns it
+ * @param [in] ulAddress an offset in the UMEM, as found in the rings
+ * @returns the network buffer
+ */
+static portINLINE NetworkBufferDescriptor_t * prvAddressToBuffer( uint64_t ulAddress )
+{
+    return &( pxUmemDescriptors[ ulAddress / niXDP_FRAME_SIZE ] );
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief Translate a network buffer to its Ethernet frame's offset in the UMEM
+ * @param [in] pxNetworkBuffer the network buffer
+ * @returns the UMEM address
+ */
+static portINLINE uint64_t prvBufferToAddress( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    return ( uint64_t ) ( pxNetworkBuffer->pucEthernetBuffer - pucUmemArea );
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief API call, called from FreeRTOS_IP.c to create the XDP sockets
+ * @return pdPASS if successful else pdFAIL
+ */
+static BaseType_t xNetworkInterfaceInitialise( NetworkInterface_t * pxInterface )
+{
+    BaseType_t xResult = pdPASS;
+
+    ( void ) pxInterface;
+
+    if( pxUmem == NULL )
+    {
+        xResult = prvCreateSockets();
+
+        if( xResult == pdPASS )
+        {
+
+            /* Create a task that simulates an interrupt in a real system.  It
+             * polls the rings of all queues. */
+            if( xTaskCreate( prvInterruptSimulatorTask,
+                             "MAC_ISR",
+                             configMINIMAL_STACK_SIZE,
+                             NULL,
+                             configMAC_ISR_SIMULATOR_PRIORITY,
+                             NULL ) != pdPASS )
+            {
+                FreeRTOS_printf( ( "xTaskCreate could not create a new task\n" ) );
+                xResult = pdFAIL;
+            }
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief Register the UMEM and bind one XDP socket to each queue
+ * @returns pdPASS when successful and pdFAIL when there is a failure
+ */
+static BaseType_t prvCreateSockets( void )
+{
+    struct xsk_umem_config xUmemConfig;
+    struct xsk_socket_config xSocketConfig;
+    BaseType_t xResult = pdPASS;
+    uint32_t ulQueue;
+    int iResult;
+
+    configASSERT( pucUmemArea != NULL );
+
+    memset( &( xUmemConfig ), 0, sizeof( xUmemConfig ) );
+    xUmemConfig.fill_size = niXDP_RING_SIZE;
+    xUmemConfig.comp_size = niXDP_RING_SIZE;
+    xUmemConfig.frame_size = niXDP_FRAME_SIZE;
+    xUmemConfig.frame_headroom = 0U;
+
+    /* The fill and completion rings of the first queue are created along
+     * with the UMEM. */
+    iResult = xsk_umem__create( &( pxUmem ),
+                                pucUmemArea,
+                                ( uint64_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS * niXDP_FRAME_SIZE,
+                                &( xQueues[ 0 ].xFillRing ),
+                                &( xQueues[ 0 ].xCompletionRing ),
+                                &( xUmemConfig ) );
+
+    if( iResult != 0 )
+    {
+        FreeRTOS_printf( ( "xsk_umem__create: %s\n", strerror( -iResult ) ) );
+        pxUmem = NULL;
+        xResult = pdFAIL;
+    }
+
+    memset( &( xSocketConfig ), 0, sizeof( xSocketConfig ) );
+    xSocketConfig.rx_size = niXDP_RING_SIZE;
+    xSocketConfig.tx_size = niXDP_RING_SIZE;
+    xSocketConfig.xdp_flags = niXDP_ATTACH_FLAGS;
+    xSocketConfig.bind_flags = ( uint16_t ) ( XDP_USE_NEED_WAKEUP | niXDP_BIND_FLAGS );
+
+    for( ulQueue = 0U; ( xResult == pdPASS ) && ( ulQueue < niXDP_QUEUE_COUNT ); ulQueue++ )
+    {
+        XDPQueue_t * pxQueue = &( xQueues[ ulQueue ] );
+
+        iResult = xsk_socket__create_shared( &( pxQueue->pxSocket ),
+                                             niXDP_INTERFACE_NAME,
+                                             ulQueue,
+                                             pxUmem,
+                                             &( pxQueue->xRxRing ),
+                                             &( pxQueue->xTxRing ),
+                                             &( pxQueue->xFillRing ),
+                                             &( pxQueue->xCompletionRing ),
+                                             &( xSocketConfig ) );
+
+        if( iResult != 0 )
+        {
+            FreeRTOS_printf( ( "xsk_socket__create %s queue %u: %s\n",
+                               niXDP_INTERFACE_NAME,
+                               ( unsigned ) ulQueue,
+                               strerror( -iResult ) ) );
+            pxQueue->pxSocket = NULL;
+            xResult = pdFAIL;
+        }
+        else
+        {
+            prvSetBusyPoll( xsk_socket__fd( pxQueue->pxSocket ) );
+        }
+    }
+
+    if( xResult != pdPASS )
+    {
+        for( ulQueue = 0U; ulQueue < niXDP_QUEUE_COUNT; ulQueue++ )
+        {
+            if( xQueues[ ulQueue ].pxSocket != NULL )
+            {
+                xsk_socket__delete( xQueues[ ulQueue ].pxSocket );
+                xQueues[ ulQueue ].pxSocket = NULL;
+            }
+        }
+
+        /* Another attempt is made when the network goes down and up. */
+        if( pxUmem != NULL )
+        {
+            ( void ) xsk_umem__delete( pxUmem );
+            pxUmem = NULL;
+        }
+    }
+    else
+    {
+        /* Give the kernel the frames to receive in. */
+        for( ulQueue = 0U; ulQueue < niXDP_QUEUE_COUNT; ulQueue++ )
+        {
+            prvFillQueue( &( xQueues[ ulQueue ] ) );
+        }
+
+        FreeRTOS_printf( ( "AF_XDP: %s, %u queue(s)\n", niXDP_INTERFACE_NAME, ( unsigned ) niXDP_QUEUE_COUNT ) );
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief Let the kernel busy-poll the NIC when the socket is read, instead of
+ *        waiting for an interrupt
+ * @param [in] iSocket the file descriptor of an XDP socket
+ */
+static void prvSetBusyPoll( int iSocket )
+{
+    #if ( niXDP_BUSY_POLL_US > 0U )
+    {
+        int iValue = 1;
+
+        if( setsockopt( iSocket, SOL_SOCKET, SO_PREFER_BUSY_POLL, &( iValue ), sizeof( iValue ) ) != 0 )
+        {
+            FreeRTOS_printf( ( "SO_PREFER_BUSY_POLL: %s\n", strerror( errno ) ) );
+        }
+
+        iValue = ( int ) niXDP_BUSY_POLL_US;
+
+        if( setsockopt( iSocket, SOL_SOCKET, SO_BUSY_POLL, &( iValue ), sizeof( iValue ) ) != 0 )
+        {
+            FreeRTOS_printf( ( "SO_BUSY_POLL: %s\n", strerror( errno ) ) );
+        }
+
+        iValue = ( int ) niXDP_BUSY_POLL_BUDGET;
+
+        if( setsockopt( iSocket, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &( iValue ), sizeof( iValue ) ) != 0 )
+        {
+            FreeRTOS_printf( ( "SO_BUSY_POLL_BUDGET: %s\n", strerror( errno ) ) );
+        }
+    }
+    #else /* if ( niXDP_BUSY_POLL_US > 0U ) */
+    {
+        ( void ) iSocket;
+    }
+    #endif /* if ( niXDP_BUSY_POLL_US > 0U ) */
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief Hand network buffers to the kernel until the fill ring of a queue
+ *        holds niXDP_FILL_COUNT of them
+ * @param [in] pxQueue the queue
+ */
+static void prvFillQueue( XDPQueue_t * pxQueue )
+{
+    NetworkBufferDescriptor_t * pxBuffers[ niXDP_FILL_COUNT ];
+    size_t uxCount = 0U;
+    size_t uxIndex;
+    uint32_t ulRingIndex;
+
+    while( ( pxQueue->uxFillCount + uxCount ) < niXDP_FILL_COUNT )
+    {
+        pxBuffers[ uxCount ] = pxGetNetworkBufferWithDescriptor( ipTOTAL_ETHERNET_FRAME_SIZE, 0U );
+
+        if( pxBuffers[ uxCount ] == NULL )
+        {
+            /* Try again after the IP-stack has released some buffers. */
+            break;
+        }
+
+        uxCount++;
+    }
+
+    if( uxCount > 0U )
+    {
+        /* The ring has room for all of them, it is never given more than
+         * niXDP_FILL_COUNT buffers. */
+        if( xsk_ring_prod__reserve( &( pxQueue->xFillRing ), ( uint32_t ) uxCount, &( ulRingIndex ) ) == uxCount )
+        {
+            for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+            {
+                *xsk_ring_prod__fill_addr( &( pxQueue->xFillRing ), ulRingIndex ) = prvBufferToAddress( pxBuffers[ uxIndex ] );
+                ulRingIndex++;
+            }
+
+            xsk_ring_prod__submit( &( pxQueue->xFillRing ), ( uint32_t ) uxCount );
+            pxQueue->uxFillCount += uxCount;
+        }
+        else
+        {
+            for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+            {
+                vReleaseNetworkBufferAndDescriptor( pxBuffers[ uxIndex ] );
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief Pass the frames in the RX ring of a queue to the IP-task
+ * @param [in] pxQueue the queue
+ * @returns the number of frames that were taken from the RX ring
+ */
+static size_t prvReceiveQueue( XDPQueue_t * pxQueue )
+{
+    NetworkBufferDescriptor_t * pxBurst[ niRX_BURST_LENGTH ];
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    const struct xdp_desc * pxDescriptor;
+    const EthernetHeader_t * pxEtherHeader;
+    const uint8_t * pucFrame;
+    size_t uxBurstCount = 0U;
+    size_t uxLength;
+    uint32_t ulRingIndex;
+    uint32_t ulCount;
+    uint32_t ulIndex;
+
+    ulCount = xsk_ring_cons__peek( &( pxQueue->xRxRing ), niRX_BURST_LENGTH, &( ulRingIndex ) );
+
+    for( ulIndex = 0U; ulIndex < ulCount; ulIndex++ )
+    {
+        pxDescriptor = xsk_ring_cons__rx_desc( &( pxQueue->xRxRing ), ulRingIndex );
+        ulRingIndex++;
+
+        iptraceNETWORK_INTERFACE_RECEIVE();
+
+        /* The network buffer is owned by the driver again. */
+        pxNetworkBuffer = prvAddressToBuffer( pxDescriptor->addr );
+        pucFrame = &( pucUmemArea[ pxDescriptor->addr ] );
+        uxLength = ( size_t ) pxDescriptor->len;
+
+        if( ( uxLength < sizeof( EthernetHeader_t ) ) || ( uxLength > ipTOTAL_ETHERNET_FRAME_SIZE ) )
+        {
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+            continue;
+        }
+
+        /* The frame is normally already at pucEthernetBuffer, unless the XDP
+         * program moved the start of the frame. */
+        if( pucFrame != pxNetworkBuffer->pucEthernetBuffer )
+        {
+            ( void ) memmove( pxNetworkBuffer->pucEthernetBuffer, pucFrame, uxLength );
+        }
+
+        /* The headroom belongs to the kernel while the frame is in the rings,
+         * restore the pointer that BufferAllocation_1.c stores in front of
+         * the frame. */
+        *( ( NetworkBufferDescriptor_t ** ) ( pxNetworkBuffer->pucEthernetBuffer - ipBUFFER_PADDING ) ) = pxNetworkBuffer;
+
+        /* There is no filter in the XDP program: accept broadcast, multicast
+         * and frames sent to this interface. */
+        pxEtherHeader = ( const EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer;
+
+        if( ( ( ( pxEtherHeader->xDestinationAddress.ucBytes[ 0 ] & 0x01U ) != 0U ) ||
+              ( memcmp( pxEtherHeader->xDestinationAddress.ucBytes,
+                        pxMyInterface->pxEndPoint->xMACAddress.ucBytes,
+                        ipMAC_ADDRESS_LENGTH_BYTES ) == 0 ) ) &&
+            ( ipCONSIDER_FRAME_FOR_PROCESSING( pxNetworkBuffer->pucEthernetBuffer ) == eProcessBuffer ) )
+        {
+            pxNetworkBuffer->xDataLength = uxLength;
+            pxNetworkBuffer->pxInterface = pxMyInterface;
+            pxNetworkBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxMyInterface, pxNetworkBuffer->pucEthernetBuffer );
+
+            pxBurst[ uxBurstCount ] = pxNetworkBuffer;
+            uxBurstCount++;
+        }
+        else
+        {
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+    }
+
+    if( ulCount > 0U )
+    {
+        xsk_ring_cons__release( &( pxQueue->xRxRing ), ulCount );
+        pxQueue->uxFillCount -= ( size_t ) ulCount;
+
+        #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+            pxMyInterface->xQueues[ pxQueue - xQueues ].ulRxCount += ulCount;
+        #endif
+    }
+
+    if( uxBurstCount > 0U )
+    {
+        /* Pass all collected buffers to the IP-task in one go.  Buffers
+         * that can not be delivered are released by the IP-stack.  This
+         * is only an interrupt simulator, not a real interrupt, so it is
+         * ok to use the task level function here. */
+        ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, ( TickType_t ) 0 );
+    }
+
+    return ( size_t ) ulCount;
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief Release the network buffers that the kernel has sent
+ * @param [in] pxQueue the queue
+ */
+static void prvReleaseCompleted( XDPQueue_t * pxQueue )
+{
+    uint32_t ulRingIndex;
+    uint32_t ulCount;
+    uint32_t ulIndex;
+
+    ulCount = xsk_ring_cons__peek( &( pxQueue->xCompletionRing ), niXDP_RING_SIZE, &( ulRingIndex ) );
+
+    for( ulIndex = 0U; ulIndex < ulCount; ulIndex++ )
+    {
+        vReleaseNetworkBufferAndDescriptor( prvAddressToBuffer( *xsk_ring_cons__comp_addr( &( pxQueue->xCompletionRing ), ulRingIndex ) ) );
+        ulRingIndex++;
+    }
+
+    if( ulCount > 0U )
+    {
+        xsk_ring_cons__release( &( pxQueue->xCompletionRing ), ulCount );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief API call, called from FreeRTOS_IP.c to send a network packet over the
+ *        selected interface
+ * @return pdTRUE if successful else pdFALSE
+ */
+static BaseType_t xNetworkInterfaceOutput( NetworkInterface_t * pxInterface,
+                                           NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                           BaseType_t bReleaseAfterSend )
+{
+    XDPQueue_t * pxQueue;
+    NetworkBufferDescriptor_t * pxSendBuffer;
+    struct xdp_desc * pxDescriptor;
+    uint32_t ulRingIndex;
+    BaseType_t xResult = pdFALSE;
+
+    #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+        UBaseType_t uxQueue = uxNetworkInterfaceSelectQueue( pxInterface, pxNetworkBuffer );
+
+        pxQueue = ( XDPQueue_t * ) pxInterface->xQueues[ uxQueue ].pvTxQueue;
+    #else
+        ( void ) pxInterface;
+        pxQueue = &( xQueues[ niXDP_TX_QUEUE ] );
+    #endif
+
+    iptraceNETWORK_INTERFACE_TRANSMIT();
+    configASSERT( xIsCallingFromIPTask() == pdTRUE );
+
+    /* The kernel reads the frame from the network buffer, which is released
+     * when it shows up in the completion ring.  A buffer that the caller
+     * keeps must be shared or copied. */
+    if( bReleaseAfterSend != pdFALSE )
+    {
+        pxSendBuffer = pxNetworkBuffer;
+    }
+    else
+    {
+        #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+            pxSendBuffer = pxNetworkBufferAddReference( pxNetworkBuffer );
+        #else
+            pxSendBuffer = pxDuplicateNetworkBufferWithDescriptor( pxNetworkBuffer, pxNetworkBuffer->xDataLength );
+        #endif
+    }
+
+    if( ( pxSendBuffer != NULL ) && ( pxQueue->pxSocket != NULL ) )
+    {
+        configASSERT( ( pxSendBuffer->pucEthernetBuffer >= pucUmemArea ) &&
+                      ( pxSendBuffer->pucEthernetBuffer < &( pucUmemArea[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS * niXDP_FRAME_SIZE ] ) ) );
+
+        if( xsk_ring_prod__reserve( &( pxQueue->xTxRing ), 1U, &( ulRingIndex ) ) == 1U )
+        {
+            pxDescriptor = xsk_ring_prod__tx_desc( &( pxQueue->xTxRing ), ulRingIndex );
+            pxDescriptor->addr = prvBufferToAddress( pxSendBuffer );
+            pxDescriptor->len = ( uint32_t ) pxSendBuffer->xDataLength;
+            pxDescriptor->options = 0U;
+            xsk_ring_prod__submit( &( pxQueue->xTxRing ), 1U );
+
+            #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+                pxInterface->xQueues[ uxQueue ].ulTxCount++;
+            #endif
+
+            /* The kernel only looks at the TX ring when it is asked to. */
+            if( ( niXDP_BUSY_POLL_US > 0U ) || ( xsk_ring_prod__needs_wakeup( &( pxQueue->xTxRing ) ) != 0 ) )
+            {
+                ( void ) sendto( xsk_socket__fd( pxQueue->pxSocket ), NULL, 0U, MSG_DONTWAIT, NULL, 0U );
+            }
+
+            xResult = pdTRUE;
+        }
+        else
+        {
+            FreeRTOS_printf( ( "xNetworkInterfaceOutput: TX ring full, dropping %lu bytes\n",
+                               ( unsigned long ) pxSendBuffer->xDataLength ) );
+            vReleaseNetworkBufferAndDescriptor( pxSendBuffer );
+        }
+    }
+    else if( pxSendBuffer != NULL )
+    {
+        vReleaseNetworkBufferAndDescriptor( pxSendBuffer );
+    }
+    else
+    {
+        /* No buffer to send from. */
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief FreeRTOS infinite loop thread that simulates a network interrupt: it
+ *         polls the rings of all queues
+ * @param [in] pvParameters not used
+ */
+static void prvInterruptSimulatorTask( void * pvParameters )
+{
+    XDPQueue_t * pxQueue;
+    size_t uxReceived;
+    size_t uxQueue;
+    int iSocket;
+
+    /* Remove compiler warnings about unused parameters. */
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        uxReceived = 0U;
+
+        for( uxQueue = 0U; uxQueue < niXDP_QUEUE_COUNT; uxQueue++ )
+        {
+            pxQueue = &( xQueues[ uxQueue ] );
+            iSocket = xsk_socket__fd( pxQueue->pxSocket );
+
+            /* With busy polling, reading the socket runs the NIC's RX
+             * processing in this context.  Otherwise the socket only needs
+             * to be read when the kernel ran out of fill buffers. */
+            if( ( niXDP_BUSY_POLL_US > 0U ) || ( xsk_ring_prod__needs_wakeup( &( pxQueue->xFillRing ) ) != 0 ) )
+            {
+                ( void ) recvfrom( iSocket, NULL, 0U, MSG_DONTWAIT, NULL, NULL );
+            }
+
+            uxReceived += prvReceiveQueue( pxQueue );
+            prvReleaseCompleted( pxQueue );
+            prvFillQueue( pxQueue );
+
+            if( xsk_ring_prod__needs_wakeup( &( pxQueue->xTxRing ) ) != 0 )
+            {
+                /* Frames may be waiting in the TX ring. */
+                ( void ) sendto( iSocket, NULL, 0U, MSG_DONTWAIT, NULL, 0U );
+            }
+        }
+
+        if( uxReceived == 0U )
+        {
+            /* The RX rings are empty.  Make sure other tasks can run. */
+            vTaskDelay( configWINDOWS_MAC_INTERRUPT_SIMULATOR_DELAY );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xGetPhyLinkStatus( NetworkInterface_t * pxInterface )
+{
+    BaseType_t xResult = pdFALSE;
+
+    ( void ) pxInterface;
+
+    if( pxUmem != NULL )
+    {
+        xResult = pdTRUE;
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
+
+/* Do not call the following function directly. It is there for downward compatibility.
+ * The function FreeRTOS_IPInit() will call it to initialice the interface and end-point
+ * objects.  See the description in FreeRTOS_Routing.h. */
+    NetworkInterface_t * pxFillInterfaceDescriptor( BaseType_t xEMACIndex,
+                                                    NetworkInterface_t * pxInterface )
+    {
+        return pxLinuxXDP_FillInterfaceDescriptor( xEMACIndex, pxInterface );
+    }
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+NetworkInterface_t * pxLinuxXDP_FillInterfaceDescriptor( BaseType_t xEMACIndex,
+                                                         NetworkInterface_t * pxInterface )
+{
+    static char pcName[ 17 ];
+
+    #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+        UBaseType_t uxQueue;
+    #endif
+
+/* This function pxFillInterfaceDescriptor() adds a network-interface.
+ * Make sure that the object pointed to by 'pxInterface'
+ * is declared static or global, and that it will remain to exist. */
+
+    pxMyInterface = pxInterface;
+
+    snprintf( pcName, sizeof( pcName ), "xdp%ld", xEMACIndex );
+
+    memset( pxInterface, '\0', sizeof( *pxInterface ) );
+    pxInterface->pcName = pcName;                    /* Just for logging, debugging. */
+    pxInterface->pvArgument = ( void * ) xEMACIndex; /* Has only meaning for the driver functions. */
+    pxInterface->pfInitialise = xNetworkInterfaceInitialise;
+    pxInterface->pfOutput = xNetworkInterfaceOutput;
+    pxInterface->pfGetPhyLinkStatus = xGetPhyLinkStatus;
+
+    #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+    {
+        /* Each XDP socket is an RX/TX queue pair.  Its rings are only
+         * valid once xNetworkInterfaceInitialise() has created it. */
+        for( uxQueue = 0U; uxQueue < niXDP_QUEUE_COUNT; uxQueue++ )
+        {
+            pxInterface->xQueues[ uxQueue ].pvRxQueue = ( void * ) &( xQueues[ uxQueue ] );
+            pxInterface->xQueues[ uxQueue ].pvTxQueue = ( void * ) &( xQueues[ uxQueue ] );
+        }
+
+        pxInterface->uxQueueCount = niXDP_QUEUE_COUNT;
+    }
+    #endif /* ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 ) */
+
+    FreeRTOS_AddNetworkInterface( pxInterface );
+
+    return pxInterface;
+}
+/*-----------------------------------------------------------*/
+
+/*!
+ * @brief Allocate the UMEM and give each descriptor one of its frames.
+ *        BufferAllocation_1.c must be used.
+ * @param [in,out] pxNetworkBuffers Pointer to an array of NetworkBufferDescriptor_t to populate.
+ */
+void vNetworkInterfaceAllocateRAMToBuffers( NetworkBufferDescriptor_t pxNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ] )
+{
+    const size_t uxSize = ( size_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS * niXDP_FRAME_SIZE;
+    size_t uxIndex;
+    void * pvArea;
+
+    /* The frame must fit behind the headroom. */
+    configASSERT( ( niXDP_DATA_OFFSET + ipTOTAL_ETHERNET_FRAME_SIZE ) <= niXDP_FRAME_SIZE );
+    configASSERT( ipBUFFER_PADDING <= niXDP_DATA_OFFSET );
+
+    if( pucUmemArea == NULL )
+    {
+        /* The UMEM must be page aligned. */
+        pvArea = mmap( NULL, uxSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+        if( pvArea != MAP_FAILED )
+        {
+            pucUmemArea = ( uint8_t * ) pvArea;
+        }
+    }
+
+    if( pucUmemArea == NULL )
+    {
+        FreeRTOS_printf( ( "Failed to allocate the UMEM: %s\n", strerror( errno ) ) );
+        configASSERT( 0 );
+    }
+    else
+    {
+        pxUmemDescriptors = pxNetworkBuffers;
+
+        for( uxIndex = 0; uxIndex < ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS; uxIndex++ )
+        {
+            uint8_t * pucFrame = &( pucUmemArea[ uxIndex * niXDP_FRAME_SIZE ] );
+            NetworkBufferDescriptor_t ** ppDescriptor;
+
+            /* pucEthernetBuffer is where the kernel writes a received frame. */
+            pxNetworkBuffers[ uxIndex ].pucEthernetBuffer = &( pucFrame[ niXDP_DATA_OFFSET ] );
+
+            /* In front of each pucEthernetBuffer is a pointer to the relevant descriptor */
+            ppDescriptor = ( NetworkBufferDescriptor_t ** ) &( pucFrame[ niXDP_DATA_OFFSET - ipBUFFER_PADDING ] );
+
+            /* Set this pointer to the address of the correct descriptor */
+            *ppDescriptor = &( pxNetworkBuffers[ uxIndex ] );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
@@ -51,6 +51,12 @@
 #define ipICMP_ECHO_REQUEST    ( ( uint8_t ) 8 )
 #define ipICMP_ECHO_REPLY      ( ( uint8_t ) 0 )
 
+/* The ARP and ND caches only need to learn the loopback address once in a
+ * while, not for every packet that is looped back. */
+#ifndef niLOOPBACK_CACHE_REFRESH_MS
+    #define niLOOPBACK_CACHE_REFRESH_MS    1000U
+#endif
+
 /*-----------------------------------------------------------*/
 
 NetworkInterface_t * xLoopbackInterface;
@@ -103,6 +109,15 @@ NetworkInterface_t * pxLoopback_FillInterfaceDescriptor( BaseType_t xEMACIndex,
     pxInterface->pfOutput = prvLoopback_Output;
     pxInterface->pfGetPhyLinkStatus = prvLoopback_GetPhyLinkStatus;
 
+    #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+    {
+        /* Looped back packets never leave memory: there is no need to
+         * calculate checksums, nor to verify them. */
+        pxInterface->bits.bTxChecksumOffload = pdTRUE_UNSIGNED;
+        pxInterface->bits.bRxChecksumOffload = pdTRUE_UNSIGNED;
+    }
+    #endif
+
     FreeRTOS_AddNetworkInterface( pxInterface );
     xLoopbackInterface = pxInterface;
 
@@ -123,34 +138,59 @@ static BaseType_t prvLoopback_Output( NetworkInterface_t * pxInterface,
                                       BaseType_t bReleaseAfterSend )
 {
     NetworkBufferDescriptor_t * pxDescriptor = pxGivenDescriptor;
+    TickType_t xNow = xTaskGetTickCount();
+    const TickType_t xRefreshTime = pdMS_TO_TICKS( niLOOPBACK_CACHE_REFRESH_MS );
 
-    ( void ) pxInterface;
-
-    IPPacket_t * a = ( IPPacket_t * ) ( pxDescriptor->pucEthernetBuffer );
-
-    if( a->xEthernetHeader.usFrameType == ipIPv4_FRAME_TYPE )
+    #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD == 0 )
     {
-        usGenerateProtocolChecksum( pxDescriptor->pucEthernetBuffer, pxDescriptor->xDataLength, pdTRUE );
+        IPPacket_t * a = ( IPPacket_t * ) ( pxDescriptor->pucEthernetBuffer );
+
+        if( a->xEthernetHeader.usFrameType == ipIPv4_FRAME_TYPE )
+        {
+            usGenerateProtocolChecksum( pxDescriptor->pucEthernetBuffer, pxDescriptor->xDataLength, pdTRUE );
+        }
     }
+    #endif
 
     {
-        MACAddress_t xMACAddress;
+        /* The MAC address does not matter, the frame is never put on a wire. */
+        const MACAddress_t * pxMACAddress = &( pxDescriptor->pxEndPoint->xMACAddress );
 
         if( pxDescriptor->pxEndPoint->bits.bIPv6 != 0 )
         {
             #if ( ipconfigUSE_IPv6 != 0 )
-                if( xIsIPv6Loopback( &( pxDescriptor->xIPAddress ) ) != pdFALSE )
+                static IPv6_Address_t xLastIPv6Address;
+                static TickType_t xLastIPv6Refresh;
+                static BaseType_t xIPv6Refreshed = pdFALSE;
+
+                if( ( xIsIPv6Loopback( &( pxDescriptor->xIPAddress.xIP_IPv6 ) ) != pdFALSE ) &&
+                    ( ( xIPv6Refreshed == pdFALSE ) ||
+                      ( ( xNow - xLastIPv6Refresh ) >= xRefreshTime ) ||
+                      ( memcmp( xLastIPv6Address.ucBytes, pxDescriptor->xIPAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) != 0 ) ) )
                 {
-                    vNDRefreshCacheEntry( &xMACAddress, &( pxDescriptor->xIPAddress.xIP_IPv6 ), pxDescriptor->pxEndPoint );
+                    vNDRefreshCacheEntry( pxMACAddress, &( pxDescriptor->xIPAddress.xIP_IPv6 ), pxDescriptor->pxEndPoint );
+                    ( void ) memcpy( xLastIPv6Address.ucBytes, pxDescriptor->xIPAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                    xLastIPv6Refresh = xNow;
+                    xIPv6Refreshed = pdTRUE;
                 }
             #endif
         }
         else
         {
             #if ( ipconfigUSE_IPv4 != 0 )
-                if( xIsIPv4Loopback( pxDescriptor->xIPAddress.ulIP_IPv4 ) )
+                static uint32_t ulLastIPv4Address;
+                static TickType_t xLastIPv4Refresh;
+                static BaseType_t xIPv4Refreshed = pdFALSE;
+
+                if( ( xIsIPv4Loopback( pxDescriptor->xIPAddress.ulIP_IPv4 ) != pdFALSE ) &&
+                    ( ( xIPv4Refreshed == pdFALSE ) ||
+                      ( ( xNow - xLastIPv4Refresh ) >= xRefreshTime ) ||
+                      ( ulLastIPv4Address != pxDescriptor->xIPAddress.ulIP_IPv4 ) ) )
                 {
-                    vARPRefreshCacheEntry( &xMACAddress, pxDescriptor->xIPAddress.ulIP_IPv4, pxDescriptor->pxEndPoint );
+                    vARPRefreshCacheEntry( pxMACAddress, pxDescriptor->xIPAddress.ulIP_IPv4, pxDescriptor->pxEndPoint );
+                    ulLastIPv4Address = pxDescriptor->xIPAddress.ulIP_IPv4;
+                    xLastIPv4Refresh = xNow;
+                    xIPv4Refreshed = pdTRUE;
                 }
             #endif
         }
@@ -161,12 +201,25 @@ static BaseType_t prvLoopback_Output( NetworkInterface_t * pxInterface,
         NetworkBufferDescriptor_t * pxNewDescriptor =
             pxDuplicateNetworkBufferWithDescriptor( pxDescriptor, pxDescriptor->xDataLength );
         pxDescriptor = pxNewDescriptor;
+
+        if( pxDescriptor == NULL )
+        {
+            vNetworkInterfaceRxDropped( pxInterface, eDropNoBuffer );
+        }
     }
 
     if( pxDescriptor != NULL )
     {
         IPStackEvent_t xRxEvent;
 
+        #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+        {
+            /* The same descriptor goes straight back to the RX path, tell
+             * it that the checksums are fine. */
+            pxDescriptor->ucChecksumFlags = ( uint8_t ) ipBUFFER_CHECKSUM_VERIFIED;
+        }
+        #endif
+
         xRxEvent.eEventType = eNetworkRxEvent;
         xRxEvent.pvData = ( void * ) pxDescriptor;
 
@@ -494,12 +494,8 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
                  * greater than the original requested size. */
                 pxReturn->xDataLength = xRequestedSizeBytes;
 
-                #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
-                {
-                    /* make sure the buffer is not linked */
-                    pxReturn->pxNextBuffer = NULL;
-                }
-                #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+                /* make sure the buffer is not linked */
+                pxReturn->pxNextBuffer = NULL;
             }
         }
         else
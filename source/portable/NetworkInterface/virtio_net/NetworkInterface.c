@@ -0,0 +1,1267 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * A network interface for a virtio-net device, as emulated by QEMU, Firecracker
+ * and other hypervisors, attached through the virtio-mmio transport (version 2)
+ * with split virtqueues.
+ *
+ * Network buffers are handed to the device directly: every frame occupies two
+ * descriptors, one for its virtio_net_hdr and one for pucEthernetBuffer.  RX
+ * queues are kept filled with network buffers, which are passed to the IP-task
+ * in bursts.  Sent buffers are released lazily, the next time a frame is sent
+ * through the same queue.  The device is only notified when it asks for it.
+ *
+ * Features that are negotiated when the configuration allows it:
+ * - VIRTIO_NET_F_CSUM / GUEST_CSUM: checksum offload, when
+ *   ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD or
+ *   ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM is enabled.
+ * - VIRTIO_NET_F_HOST_TSO4 / HOST_TSO6: TCP segmentation offload, when
+ *   ipconfigUSE_TCP_TSO is enabled.
+ * - VIRTIO_NET_F_MQ: niVIRTIO_QUEUE_PAIRS RX/TX queue pairs.  With
+ *   ipconfigUSE_NETWORK_MULTI_QUEUE, they are published in the
+ *   NetworkInterface_t and frames are spread over the TX queues per flow.
+ *
+ * The application must call vVirtioNet_IRQHandler() from the interrupt of the
+ * virtio-mmio slot.  For QEMU, attach the device with e.g.
+ * "-device virtio-net-device,netdev=net0,mq=on".  The end-point should use
+ * the MAC address of the device.
+ *
+ * Addresses that are given to the device are physical addresses, by default
+ * the CPU address is used, see niVIRTIO_PHYS_ADDR().  The memory is assumed to
+ * be cache coherent with the device, which is true for emulated devices.
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Standard library definitions */
+#include <string.h>
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Routing.h"
+#include "NetworkInterface.h"
+#include "NetworkBufferManagement.h"
+
+#if ( ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES == 0 )
+    #define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer )    eProcessBuffer
+#else
+    #define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer )    eConsiderFrameForProcessing( ( pucEthernetBuffer ) )
+#endif
+
+/* The base address of the virtio-mmio slot of the device. */
+#ifndef niVIRTIO_MMIO_BASE
+    #define niVIRTIO_MMIO_BASE    0x0A000000UL
+#endif
+
+/* The number of RX/TX queue pairs that are requested.  The device may offer
+ * less, only the first pair is used when it does not offer VIRTIO_NET_F_MQ. */
+#ifndef niVIRTIO_QUEUE_PAIRS
+    #define niVIRTIO_QUEUE_PAIRS    1U
+#endif
+
+/* The number of descriptors of each virtqueue, a power of 2.  Each frame
+ * takes two descriptors, so half of this number of frames can be queued. */
+#ifndef niVIRTIO_QUEUE_SIZE
+    #define niVIRTIO_QUEUE_SIZE    64U
+#endif
+
+/* The number of network buffers that every RX queue holds. */
+#ifndef niVIRTIO_RX_BUFFER_COUNT
+    #define niVIRTIO_RX_BUFFER_COUNT    16U
+#endif
+
+/* The maximum number of received packets that are passed to the IP-task
+ * in a single burst. */
+#ifndef niRX_BURST_LENGTH
+    #define niRX_BURST_LENGTH    8U
+#endif
+
+/* Translate a CPU address to the address that the device uses. */
+#ifndef niVIRTIO_PHYS_ADDR
+    #define niVIRTIO_PHYS_ADDR( pvAddress )    ( ( uint64_t ) ( uintptr_t ) ( pvAddress ) )
+#endif
+
+/* A barrier that orders the accesses to the virtqueues and to the device. */
+#ifndef niVIRTIO_MEMORY_BARRIER
+    #define niVIRTIO_MEMORY_BARRIER()    __sync_synchronize()
+#endif
+
+/* Sets the size of the stack (in words, not bytes) of the task that reads bytes
+ * from the network. */
+#ifndef niEMAC_HANDLER_TASK_STACK_SIZE
+    #define niEMAC_HANDLER_TASK_STACK_SIZE    ( configMINIMAL_STACK_SIZE * 2 )
+#endif
+
+#ifndef niEMAC_HANDLER_TASK_PRIORITY
+    #define niEMAC_HANDLER_TASK_PRIORITY    ( configMAX_PRIORITIES - 1 )
+#endif
+
+/* The size of each buffer when BufferAllocation_1 is used. */
+#define niBUFFER_1_PACKET_SIZE    1536U
+
+#if ( ( niVIRTIO_QUEUE_SIZE & ( niVIRTIO_QUEUE_SIZE - 1U ) ) != 0U ) || ( niVIRTIO_QUEUE_SIZE < 4U )
+    #error niVIRTIO_QUEUE_SIZE must be a power of 2, and at least 4
+#endif
+
+#if ( niVIRTIO_RX_BUFFER_COUNT > ( niVIRTIO_QUEUE_SIZE / 2U ) )
+    #error niVIRTIO_RX_BUFFER_COUNT does not fit in the RX queue
+#endif
+
+#if ( ( niVIRTIO_QUEUE_PAIRS * niVIRTIO_RX_BUFFER_COUNT ) >= ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS )
+    #error The RX queues take all network buffers, increase ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
+#endif
+
+#if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 ) && ( niVIRTIO_QUEUE_PAIRS > ipconfigNETWORK_MAX_QUEUES )
+    #error niVIRTIO_QUEUE_PAIRS is larger than ipconfigNETWORK_MAX_QUEUES
+#endif
+
+/* The device uses little-endian fields. */
+#if ( ipconfigBYTE_ORDER != pdFREERTOS_LITTLE_ENDIAN )
+    #error The virtio-net driver only supports little-endian CPUs
+#endif
+
+/* Registers of the virtio-mmio transport. */
+#define VIRTIO_MMIO_MAGIC_VALUE            0x000U
+#define VIRTIO_MMIO_VERSION                0x004U
+#define VIRTIO_MMIO_DEVICE_ID              0x008U
+#define VIRTIO_MMIO_DEVICE_FEATURES        0x010U
+#define VIRTIO_MMIO_DEVICE_FEATURES_SEL    0x014U
+#define VIRTIO_MMIO_DRIVER_FEATURES        0x020U
+#define VIRTIO_MMIO_DRIVER_FEATURES_SEL    0x024U
+#define VIRTIO_MMIO_QUEUE_SEL              0x030U
+#define VIRTIO_MMIO_QUEUE_NUM_MAX          0x034U
+#define VIRTIO_MMIO_QUEUE_NUM              0x038U
+#define VIRTIO_MMIO_QUEUE_READY            0x044U
+#define VIRTIO_MMIO_QUEUE_NOTIFY           0x050U
+#define VIRTIO_MMIO_INTERRUPT_STATUS       0x060U
+#define VIRTIO_MMIO_INTERRUPT_ACK          0x064U
+#define VIRTIO_MMIO_STATUS                 0x070U
+#define VIRTIO_MMIO_QUEUE_DESC_LOW         0x080U
+#define VIRTIO_MMIO_QUEUE_DESC_HIGH        0x084U
+#define VIRTIO_MMIO_QUEUE_DRIVER_LOW       0x090U
+#define VIRTIO_MMIO_QUEUE_DRIVER_HIGH      0x094U
+#define VIRTIO_MMIO_QUEUE_DEVICE_LOW       0x0A0U
+#define VIRTIO_MMIO_QUEUE_DEVICE_HIGH      0x0A4U
+#define VIRTIO_MMIO_CONFIG                 0x100U
+
+#define VIRTIO_MMIO_MAGIC                  0x74726976UL /* "virt" */
+#define VIRTIO_ID_NET                      1U
+
+#define VIRTIO_MMIO_INT_VRING              0x01U
+#define VIRTIO_MMIO_INT_CONFIG             0x02U
+
+/* Device status bits. */
+#define VIRTIO_STATUS_ACKNOWLEDGE          0x01U
+#define VIRTIO_STATUS_DRIVER               0x02U
+#define VIRTIO_STATUS_DRIVER_OK            0x04U
+#define VIRTIO_STATUS_FEATURES_OK          0x08U
+#define VIRTIO_STATUS_FAILED               0x80U
+
+/* Feature bits. */
+#define VIRTIO_NET_F_CSUM                  ( 1ULL << 0 )
+#define VIRTIO_NET_F_GUEST_CSUM            ( 1ULL << 1 )
+#define VIRTIO_NET_F_MAC                   ( 1ULL << 5 )
+#define VIRTIO_NET_F_HOST_TSO4             ( 1ULL << 11 )
+#define VIRTIO_NET_F_HOST_TSO6             ( 1ULL << 12 )
+#define VIRTIO_NET_F_STATUS                ( 1ULL << 16 )
+#define VIRTIO_NET_F_CTRL_VQ               ( 1ULL << 17 )
+#define VIRTIO_NET_F_MQ                    ( 1ULL << 22 )
+#define VIRTIO_F_VERSION_1                 ( 1ULL << 32 )
+
+/* Offsets in the device configuration space. */
+#define VIRTIO_NET_CONFIG_MAC              0x00U
+#define VIRTIO_NET_CONFIG_STATUS           0x06U
+#define VIRTIO_NET_CONFIG_MAX_PAIRS        0x08U
+#define VIRTIO_NET_S_LINK_UP               0x01U
+
+/* Virtqueue flags. */
+#define VIRTQ_DESC_F_NEXT                  0x01U
+#define VIRTQ_DESC_F_WRITE                 0x02U
+#define VIRTQ_AVAIL_F_NO_INTERRUPT         0x01U
+#define VIRTQ_USED_F_NO_NOTIFY             0x01U
+
+/* virtio_net_hdr flags and GSO types. */
+#define VIRTIO_NET_HDR_F_NEEDS_CSUM        0x01U
+#define VIRTIO_NET_HDR_F_DATA_VALID        0x02U
+#define VIRTIO_NET_HDR_GSO_NONE            0x00U
+#define VIRTIO_NET_HDR_GSO_TCPV4           0x01U
+#define VIRTIO_NET_HDR_GSO_TCPV6           0x04U
+
+/* The control queue command that sets the number of queue pairs. */
+#define VIRTIO_NET_CTRL_MQ                 4U
+#define VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET    0U
+#define VIRTIO_NET_OK                      0U
+
+/* The number of descriptors of the control queue. */
+#define niVIRTIO_CTRL_QUEUE_SIZE           4U
+
+/* The number of frames that fit in a queue. */
+#define niVIRTIO_SLOT_COUNT                ( niVIRTIO_QUEUE_SIZE / 2U )
+
+#define niVIRTIO_REG( ulOffset )           ( *( ( volatile uint32_t * ) ( niVIRTIO_MMIO_BASE + ( ulOffset ) ) ) )
+#define niVIRTIO_CONFIG_BYTE( ulOffset )   ( *( ( volatile uint8_t * ) ( niVIRTIO_MMIO_BASE + VIRTIO_MMIO_CONFIG + ( ulOffset ) ) ) )
+#define niVIRTIO_CONFIG_SHORT( ulOffset )  ( *( ( volatile uint16_t * ) ( niVIRTIO_MMIO_BASE + VIRTIO_MMIO_CONFIG + ( ulOffset ) ) ) )
+
+/* The checksums of an outgoing packet must be inserted by the driver. */
+#if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+    #define niVIRTIO_TX_CHECKSUM_NEEDED( pxNetworkBuffer )    ( ( ( pxNetworkBuffer )->ucChecksumFlags & ipBUFFER_CHECKSUM_NEEDED ) != 0U )
+#elif ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM != 0 )
+    #define niVIRTIO_TX_CHECKSUM_NEEDED( pxNetworkBuffer )    ( pdTRUE )
+#else
+    #define niVIRTIO_TX_CHECKSUM_NEEDED( pxNetworkBuffer )    ( pdFALSE )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* A descriptor of a split virtqueue. */
+typedef struct xVIRTQ_DESC
+{
+    uint64_t ullAddress;
+    uint32_t ulLength;
+    uint16_t usFlags;
+    uint16_t usNext;
+} VirtqDesc_t;
+
+/* The driver area of a split virtqueue. */
+typedef struct xVIRTQ_AVAIL
+{
+    uint16_t usFlags;
+    uint16_t usIndex;
+    uint16_t usRing[ niVIRTIO_QUEUE_SIZE ];
+    uint16_t usUsedEvent;
+} VirtqAvail_t;
+
+typedef struct xVIRTQ_USED_ELEM
+{
+    uint32_t ulID;
+    uint32_t ulLength;
+} VirtqUsedElem_t;
+
+/* The device area of a split virtqueue. */
+typedef struct xVIRTQ_USED
+{
+    uint16_t usFlags;
+    uint16_t usIndex;
+    VirtqUsedElem_t xRing[ niVIRTIO_QUEUE_SIZE ];
+    uint16_t usAvailEvent;
+} VirtqUsed_t;
+
+/* The header that precedes every frame, as defined for VIRTIO_F_VERSION_1. */
+typedef struct xVIRTIO_NET_HDR
+{
+    uint8_t ucFlags;
+    uint8_t ucGSOType;
+    uint16_t usHeaderLength;
+    uint16_t usGSOSize;
+    uint16_t usChecksumStart;
+    uint16_t usChecksumOffset;
+    uint16_t usNumBuffers;
+} VirtioNetHeader_t;
+
+/* One virtqueue.  Frame slot 'n' uses the descriptors 2n and 2n+1. */
+typedef struct xVIRTIO_QUEUE
+{
+    VirtqDesc_t xDesc[ niVIRTIO_QUEUE_SIZE ];
+    VirtqAvail_t xAvail;
+    VirtqUsed_t xUsed;
+    VirtioNetHeader_t xHeaders[ niVIRTIO_SLOT_COUNT ];
+    NetworkBufferDescriptor_t * pxBuffers[ niVIRTIO_SLOT_COUNT ];
+    uint16_t usQueueIndex; /**< The index of the queue in the device. */
+    uint16_t usSize;       /**< The number of descriptors that the device was told about. */
+    uint16_t usLastUsed;   /**< The value of xUsed.usIndex that has been handled. */
+    uint16_t usNextSlot;   /**< TX only: the slot for the next frame. */
+} VirtioQueue_t;
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t xVirtioNet_NetworkInterfaceInitialise( NetworkInterface_t * pxInterface );
+static BaseType_t xVirtioNet_NetworkInterfaceOutput( NetworkInterface_t * pxInterface,
+                                                     NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     BaseType_t xReleaseAfterSend );
+static BaseType_t xVirtioNet_GetPhyLinkStatus( NetworkInterface_t * pxInterface );
+
+NetworkInterface_t * pxVirtioNet_FillInterfaceDescriptor( BaseType_t xEMACIndex,
+                                                          NetworkInterface_t * pxInterface );
+
+/* Reset the device and negotiate the features, returns pdFAIL when the device
+ * is not usable. */
+static BaseType_t prvNegotiateFeatures( void );
+
+/* Tell the device where a virtqueue is. */
+static BaseType_t prvSetupQueue( VirtioQueue_t * pxQueue,
+                                 uint16_t usQueueIndex,
+                                 uint16_t usSize );
+
+/* Give a network buffer to an RX queue, in the given slot. */
+static void prvRxQueueAdd( VirtioQueue_t * pxQueue,
+                           uint16_t usSlot,
+                           NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* Notify the device of new buffers in a queue, unless it does not want that. */
+static void prvQueueNotify( const VirtioQueue_t * pxQueue );
+
+/* Handle at most xBudget received frames, returns the number handled. */
+static BaseType_t prvReceiveFrames( BaseType_t xBudget );
+
+/* Release the network buffers that the device has sent. */
+static void prvReclaimTxBuffers( VirtioQueue_t * pxQueue );
+
+/* Fill in the virtio_net_hdr of an outgoing frame, and insert the checksums
+ * that the device will not insert. */
+static void prvPrepareTxHeader( VirtioNetHeader_t * pxHeader,
+                                NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+#if ( niVIRTIO_QUEUE_PAIRS > 1U )
+    /* Ask the device to use more than one queue pair. */
+    static BaseType_t prvSetQueuePairs( uint16_t usPairs );
+#endif
+
+#if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+    static BaseType_t xVirtioNet_Poll( NetworkInterface_t * pxInterface,
+                                       BaseType_t xBudget );
+#else
+    static void prvEMACHandlerTask( void * pvParameters );
+#endif
+
+/*-----------------------------------------------------------*/
+
+static NetworkInterface_t * pxMyInterface;
+
+static VirtioQueue_t xRxQueues[ niVIRTIO_QUEUE_PAIRS ] __attribute__( ( aligned( 16 ) ) );
+static VirtioQueue_t xTxQueues[ niVIRTIO_QUEUE_PAIRS ] __attribute__( ( aligned( 16 ) ) );
+
+#if ( niVIRTIO_QUEUE_PAIRS > 1U )
+    static VirtioQueue_t xCtrlQueue __attribute__( ( aligned( 16 ) ) );
+    static uint8_t ucCtrlCommand[ 2 ];
+    static uint16_t usCtrlPairs;
+    static volatile uint8_t ucCtrlAck;
+#endif
+
+/* The features that both the device and the driver support. */
+static uint64_t ullFeatures = 0U;
+
+/* The number of queue pairs in use. */
+static UBaseType_t uxQueuePairs = 1U;
+
+static BaseType_t xDeviceReady = pdFALSE;
+
+#if ( ipconfigUSE_NETWORK_INTERFACE_POLL == 0 )
+    static TaskHandle_t xEMACTaskHandle = NULL;
+#endif
+
+#ifdef __ICCARM__
+    #pragma data_alignment=4
+    static uint8_t ucNetworkPackets[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS * niBUFFER_1_PACKET_SIZE ]
+#else
+    static uint8_t ucNetworkPackets[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS * niBUFFER_1_PACKET_SIZE ] __attribute__( ( aligned( 4 ) ) );
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIPv4_BACKWARD_COMPATIBLE != 0 )
+
+/* Do not call the following function directly. It is there for downward compatibility.
+ * The function FreeRTOS_IPInit() will call it to initialice the interface and end-point
+ * objects.  See the description in FreeRTOS_Routing.h. */
+    NetworkInterface_t * pxFillInterfaceDescriptor( BaseType_t xEMACIndex,
+                                                    NetworkInterface_t * pxInterface )
+    {
+        return pxVirtioNet_FillInterfaceDescriptor( xEMACIndex, pxInterface );
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+NetworkInterface_t * pxVirtioNet_FillInterfaceDescriptor( BaseType_t xEMACIndex,
+                                                          NetworkInterface_t * pxInterface )
+{
+    static char pcName[ 17 ];
+
+/* This function pxVirtioNet_FillInterfaceDescriptor() adds a network-interface.
+ * Make sure that the object pointed to by 'pxInterface'
+ * is declared static or global, and that it will remain to exist. */
+
+    pxMyInterface = pxInterface;
+
+    snprintf( pcName, sizeof( pcName ), "virtio%ld", xEMACIndex );
+
+    memset( pxInterface, '\0', sizeof( *pxInterface ) );
+    pxInterface->pcName = pcName;                    /* Just for logging, debugging. */
+    pxInterface->pvArgument = ( void * ) xEMACIndex; /* Has only meaning for the driver functions. */
+    pxInterface->pfInitialise = xVirtioNet_NetworkInterfaceInitialise;
+    pxInterface->pfOutput = xVirtioNet_NetworkInterfaceOutput;
+    pxInterface->pfGetPhyLinkStatus = xVirtioNet_GetPhyLinkStatus;
+
+    #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+        pxInterface->pfPoll = xVirtioNet_Poll;
+    #endif
+
+    #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+    {
+        UBaseType_t uxQueue;
+
+        /* The number of queues in use is only known after the features
+         * have been negotiated, see xVirtioNet_NetworkInterfaceInitialise(). */
+        pxInterface->uxQueueCount = 1U;
+
+        for( uxQueue = 0U; uxQueue < niVIRTIO_QUEUE_PAIRS; uxQueue++ )
+        {
+            pxInterface->xQueues[ uxQueue ].pvRxQueue = ( void * ) &( xRxQueues[ uxQueue ] );
+            pxInterface->xQueues[ uxQueue ].pvTxQueue = ( void * ) &( xTxQueues[ uxQueue ] );
+        }
+    }
+    #endif
+
+    FreeRTOS_AddNetworkInterface( pxInterface );
+
+    return pxInterface;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t xVirtioNet_NetworkInterfaceInitialise( NetworkInterface_t * pxInterface )
+{
+    BaseType_t xResult = pdPASS;
+    UBaseType_t uxPair;
+    uint16_t usSlot;
+
+    if( xDeviceReady == pdFALSE )
+    {
+        xResult = prvNegotiateFeatures();
+
+        for( uxPair = 0U; ( xResult == pdPASS ) && ( uxPair < uxQueuePairs ); uxPair++ )
+        {
+            xResult = prvSetupQueue( &( xRxQueues[ uxPair ] ), ( uint16_t ) ( 2U * uxPair ), niVIRTIO_QUEUE_SIZE );
+
+            if( xResult == pdPASS )
+            {
+                xResult = prvSetupQueue( &( xTxQueues[ uxPair ] ), ( uint16_t ) ( ( 2U * uxPair ) + 1U ), niVIRTIO_QUEUE_SIZE );
+            }
+
+            if( xResult == pdPASS )
+            {
+                /* The device only interrupts for TX completions when asked,
+                 * sent buffers are reclaimed in the output function. */
+                xTxQueues[ uxPair ].xAvail.usFlags = VIRTQ_AVAIL_F_NO_INTERRUPT;
+
+                for( usSlot = 0U; usSlot < niVIRTIO_RX_BUFFER_COUNT; usSlot++ )
+                {
+                    NetworkBufferDescriptor_t * pxBuffer = pxGetNetworkBufferWithDescriptor( ipTOTAL_ETHERNET_FRAME_SIZE, 0U );
+
+                    if( pxBuffer == NULL )
+                    {
+                        FreeRTOS_printf( ( "virtio-net: no network buffers for the RX queues\n" ) );
+                        xResult = pdFAIL;
+                        break;
+                    }
+
+                    prvRxQueueAdd( &( xRxQueues[ uxPair ] ), usSlot, pxBuffer );
+                }
+            }
+        }
+
+        #if ( niVIRTIO_QUEUE_PAIRS > 1U )
+            if( ( xResult == pdPASS ) && ( ( ullFeatures & VIRTIO_NET_F_MQ ) != 0U ) )
+            {
+                /* The control queue follows the queue pairs that the device offers. */
+                xResult = prvSetupQueue( &xCtrlQueue, ( uint16_t ) ( 2U * niVIRTIO_CONFIG_SHORT( VIRTIO_NET_CONFIG_MAX_PAIRS ) ), niVIRTIO_CTRL_QUEUE_SIZE );
+            }
+        #endif
+
+        if( xResult == pdPASS )
+        {
+            niVIRTIO_MEMORY_BARRIER();
+            niVIRTIO_REG( VIRTIO_MMIO_STATUS ) |= VIRTIO_STATUS_DRIVER_OK;
+
+            for( uxPair = 0U; uxPair < uxQueuePairs; uxPair++ )
+            {
+                prvQueueNotify( &( xRxQueues[ uxPair ] ) );
+            }
+
+            #if ( niVIRTIO_QUEUE_PAIRS > 1U )
+                if( ( uxQueuePairs > 1U ) && ( prvSetQueuePairs( ( uint16_t ) uxQueuePairs ) != pdPASS ) )
+                {
+                    /* The device keeps sending and receiving through the first
+                     * pair, the other pairs stay unused. */
+                    FreeRTOS_printf( ( "virtio-net: the device refused %u queue pairs\n", ( unsigned ) uxQueuePairs ) );
+                    uxQueuePairs = 1U;
+                }
+            #endif
+
+            #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            {
+                if( ( ullFeatures & VIRTIO_NET_F_CSUM ) != 0U )
+                {
+                    pxInterface->bits.bTxChecksumOffload = pdTRUE_UNSIGNED;
+                }
+            }
+            #endif
+
+            #if ( ipconfigUSE_TCP_TSO != 0 )
+            {
+                if( ( ullFeatures & VIRTIO_NET_F_HOST_TSO4 ) != 0U )
+                {
+                    pxInterface->bits.bTCPSegmentationOffload = pdTRUE_UNSIGNED;
+                }
+            }
+            #endif
+
+            #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+                pxInterface->uxQueueCount = uxQueuePairs;
+            #endif
+
+            #if ( ipconfigUSE_NETWORK_INTERFACE_POLL == 0 )
+                if( xEMACTaskHandle == NULL )
+                {
+                    if( xTaskCreate( prvEMACHandlerTask, "EMAC", niEMAC_HANDLER_TASK_STACK_SIZE, NULL, niEMAC_HANDLER_TASK_PRIORITY, &( xEMACTaskHandle ) ) != pdPASS )
+                    {
+                        xResult = pdFAIL;
+                    }
+                }
+            #endif
+
+            if( xResult == pdPASS )
+            {
+                FreeRTOS_printf( ( "virtio-net: %u queue pair(s), features %08lx%08lx\n",
+                                   ( unsigned ) uxQueuePairs,
+                                   ( unsigned long ) ( ullFeatures >> 32 ),
+                                   ( unsigned long ) ( ullFeatures & 0xFFFFFFFFU ) ) );
+                xDeviceReady = pdTRUE;
+            }
+        }
+
+        if( xResult != pdPASS )
+        {
+            niVIRTIO_REG( VIRTIO_MMIO_STATUS ) |= VIRTIO_STATUS_FAILED;
+        }
+    }
+
+    if( xResult == pdPASS )
+    {
+        xResult = xVirtioNet_GetPhyLinkStatus( pxInterface );
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvNegotiateFeatures( void )
+{
+    BaseType_t xResult = pdFAIL;
+    uint64_t ullDeviceFeatures;
+    uint64_t ullWanted = VIRTIO_F_VERSION_1 | VIRTIO_NET_F_MAC | VIRTIO_NET_F_STATUS;
+
+    #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 ) || ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM != 0 )
+        ullWanted |= VIRTIO_NET_F_CSUM;
+    #endif
+
+    #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+        /* Received packets are marked with ipBUFFER_CHECKSUM_VERIFIED when
+         * the device has checked them. */
+        ullWanted |= VIRTIO_NET_F_GUEST_CSUM;
+    #endif
+
+    #if ( ipconfigUSE_TCP_TSO != 0 )
+        /* TSO is a property of the interface, not of the IP version. */
+        #if ( ipconfigUSE_IPv6 != 0 )
+            ullWanted |= VIRTIO_NET_F_HOST_TSO4 | VIRTIO_NET_F_HOST_TSO6;
+        #else
+            ullWanted |= VIRTIO_NET_F_HOST_TSO4;
+        #endif
+    #endif
+
+    #if ( niVIRTIO_QUEUE_PAIRS > 1U )
+        ullWanted |= VIRTIO_NET_F_CTRL_VQ | VIRTIO_NET_F_MQ;
+    #endif
+
+    if( ( niVIRTIO_REG( VIRTIO_MMIO_MAGIC_VALUE ) != VIRTIO_MMIO_MAGIC ) ||
+        ( niVIRTIO_REG( VIRTIO_MMIO_VERSION ) != 2U ) ||
+        ( niVIRTIO_REG( VIRTIO_MMIO_DEVICE_ID ) != VIRTIO_ID_NET ) )
+    {
+        FreeRTOS_printf( ( "virtio-net: no modern virtio-net device at %08lx\n", ( unsigned long ) niVIRTIO_MMIO_BASE ) );
+    }
+    else
+    {
+        /* Reset the device. */
+        niVIRTIO_REG( VIRTIO_MMIO_STATUS ) = 0U;
+
+        while( niVIRTIO_REG( VIRTIO_MMIO_STATUS ) != 0U )
+        {
+        }
+
+        niVIRTIO_REG( VIRTIO_MMIO_STATUS ) = VIRTIO_STATUS_ACKNOWLEDGE;
+        niVIRTIO_REG( VIRTIO_MMIO_STATUS ) |= VIRTIO_STATUS_DRIVER;
+
+        niVIRTIO_REG( VIRTIO_MMIO_DEVICE_FEATURES_SEL ) = 1U;
+        ullDeviceFeatures = ( ( uint64_t ) niVIRTIO_REG( VIRTIO_MMIO_DEVICE_FEATURES ) ) << 32;
+        niVIRTIO_REG( VIRTIO_MMIO_DEVICE_FEATURES_SEL ) = 0U;
+        ullDeviceFeatures |= ( uint64_t ) niVIRTIO_REG( VIRTIO_MMIO_DEVICE_FEATURES );
+
+        ullFeatures = ullDeviceFeatures & ullWanted;
+
+        /* Segmentation needs the device to insert the checksums. */
+        if( ( ullFeatures & VIRTIO_NET_F_CSUM ) == 0U )
+        {
+            ullFeatures &= ~( VIRTIO_NET_F_HOST_TSO4 | VIRTIO_NET_F_HOST_TSO6 );
+        }
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            if( ( ullFeatures & VIRTIO_NET_F_HOST_TSO6 ) == 0U )
+            {
+                ullFeatures &= ~VIRTIO_NET_F_HOST_TSO4;
+            }
+        #endif
+
+        if( ( ullFeatures & VIRTIO_NET_F_CTRL_VQ ) == 0U )
+        {
+            ullFeatures &= ~VIRTIO_NET_F_MQ;
+        }
+
+        niVIRTIO_REG( VIRTIO_MMIO_DRIVER_FEATURES_SEL ) = 1U;
+        niVIRTIO_REG( VIRTIO_MMIO_DRIVER_FEATURES ) = ( uint32_t ) ( ullFeatures >> 32 );
+        niVIRTIO_REG( VIRTIO_MMIO_DRIVER_FEATURES_SEL ) = 0U;
+        niVIRTIO_REG( VIRTIO_MMIO_DRIVER_FEATURES ) = ( uint32_t ) ( ullFeatures & 0xFFFFFFFFU );
+
+        niVIRTIO_REG( VIRTIO_MMIO_STATUS ) |= VIRTIO_STATUS_FEATURES_OK;
+
+        if( ( ( ullFeatures & VIRTIO_F_VERSION_1 ) == 0U ) ||
+            ( ( niVIRTIO_REG( VIRTIO_MMIO_STATUS ) & VIRTIO_STATUS_FEATURES_OK ) == 0U ) )
+        {
+            FreeRTOS_printf( ( "virtio-net: feature negotiation failed\n" ) );
+        }
+        else
+        {
+            uxQueuePairs = 1U;
+
+            #if ( niVIRTIO_QUEUE_PAIRS > 1U )
+                if( ( ullFeatures & VIRTIO_NET_F_MQ ) != 0U )
+                {
+                    uxQueuePairs = ( UBaseType_t ) niVIRTIO_CONFIG_SHORT( VIRTIO_NET_CONFIG_MAX_PAIRS );
+
+                    if( uxQueuePairs > niVIRTIO_QUEUE_PAIRS )
+                    {
+                        uxQueuePairs = niVIRTIO_QUEUE_PAIRS;
+                    }
+                    else if( uxQueuePairs == 0U )
+                    {
+                        uxQueuePairs = 1U;
+                    }
+                    else
+                    {
+                        /* The device offers less pairs than requested. */
+                    }
+                }
+            #endif
+
+            xResult = pdPASS;
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSetupQueue( VirtioQueue_t * pxQueue,
+                                 uint16_t usQueueIndex,
+                                 uint16_t usSize )
+{
+    BaseType_t xResult = pdFAIL;
+    uint64_t ullAddress;
+
+    ( void ) memset( pxQueue, 0, sizeof( *pxQueue ) );
+    pxQueue->usQueueIndex = usQueueIndex;
+    pxQueue->usSize = usSize;
+
+    niVIRTIO_REG( VIRTIO_MMIO_QUEUE_SEL ) = usQueueIndex;
+
+    if( niVIRTIO_REG( VIRTIO_MMIO_QUEUE_READY ) != 0U )
+    {
+        FreeRTOS_printf( ( "virtio-net: queue %u is already in use\n", ( unsigned ) usQueueIndex ) );
+    }
+    else if( niVIRTIO_REG( VIRTIO_MMIO_QUEUE_NUM_MAX ) < usSize )
+    {
+        FreeRTOS_printf( ( "virtio-net: queue %u has less than %u descriptors\n", ( unsigned ) usQueueIndex, ( unsigned ) usSize ) );
+    }
+    else
+    {
+        niVIRTIO_REG( VIRTIO_MMIO_QUEUE_NUM ) = usSize;
+
+        ullAddress = niVIRTIO_PHYS_ADDR( pxQueue->xDesc );
+        niVIRTIO_REG( VIRTIO_MMIO_QUEUE_DESC_LOW ) = ( uint32_t ) ( ullAddress & 0xFFFFFFFFU );
+        niVIRTIO_REG( VIRTIO_MMIO_QUEUE_DESC_HIGH ) = ( uint32_t ) ( ullAddress >> 32 );
+
+        ullAddress = niVIRTIO_PHYS_ADDR( &( pxQueue->xAvail ) );
+        niVIRTIO_REG( VIRTIO_MMIO_QUEUE_DRIVER_LOW ) = ( uint32_t ) ( ullAddress & 0xFFFFFFFFU );
+        niVIRTIO_REG( VIRTIO_MMIO_QUEUE_DRIVER_HIGH ) = ( uint32_t ) ( ullAddress >> 32 );
+
+        ullAddress = niVIRTIO_PHYS_ADDR( &( pxQueue->xUsed ) );
+        niVIRTIO_REG( VIRTIO_MMIO_QUEUE_DEVICE_LOW ) = ( uint32_t ) ( ullAddress & 0xFFFFFFFFU );
+        niVIRTIO_REG( VIRTIO_MMIO_QUEUE_DEVICE_HIGH ) = ( uint32_t ) ( ullAddress >> 32 );
+
+        niVIRTIO_REG( VIRTIO_MMIO_QUEUE_READY ) = 1U;
+        xResult = pdPASS;
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRxQueueAdd( VirtioQueue_t * pxQueue,
+                           uint16_t usSlot,
+                           NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    uint16_t usHead = ( uint16_t ) ( 2U * usSlot );
+
+    pxQueue->pxBuffers[ usSlot ] = pxNetworkBuffer;
+
+    pxQueue->xDesc[ usHead ].ullAddress = niVIRTIO_PHYS_ADDR( &( pxQueue->xHeaders[ usSlot ] ) );
+    pxQueue->xDesc[ usHead ].ulLength = ( uint32_t ) sizeof( VirtioNetHeader_t );
+    pxQueue->xDesc[ usHead ].usFlags = VIRTQ_DESC_F_NEXT | VIRTQ_DESC_F_WRITE;
+    pxQueue->xDesc[ usHead ].usNext = ( uint16_t ) ( usHead + 1U );
+
+    pxQueue->xDesc[ usHead + 1U ].ullAddress = niVIRTIO_PHYS_ADDR( pxNetworkBuffer->pucEthernetBuffer );
+    pxQueue->xDesc[ usHead + 1U ].ulLength = ( uint32_t ) ipTOTAL_ETHERNET_FRAME_SIZE;
+    pxQueue->xDesc[ usHead + 1U ].usFlags = VIRTQ_DESC_F_WRITE;
+    pxQueue->xDesc[ usHead + 1U ].usNext = 0U;
+
+    pxQueue->xAvail.usRing[ pxQueue->xAvail.usIndex % pxQueue->usSize ] = usHead;
+
+    /* The descriptors must be visible before the index that publishes them. */
+    niVIRTIO_MEMORY_BARRIER();
+    pxQueue->xAvail.usIndex++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueNotify( const VirtioQueue_t * pxQueue )
+{
+    niVIRTIO_MEMORY_BARRIER();
+
+    if( ( ( ( const volatile VirtqUsed_t * ) &( pxQueue->xUsed ) )->usFlags & VIRTQ_USED_F_NO_NOTIFY ) == 0U )
+    {
+        niVIRTIO_REG( VIRTIO_MMIO_QUEUE_NOTIFY ) = pxQueue->usQueueIndex;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReceiveFrames( BaseType_t xBudget )
+{
+    NetworkBufferDescriptor_t * pxBurst[ niRX_BURST_LENGTH ];
+    size_t uxBurstCount = 0U;
+    BaseType_t xCount = 0;
+    UBaseType_t uxPair;
+
+    for( uxPair = 0U; uxPair < uxQueuePairs; uxPair++ )
+    {
+        VirtioQueue_t * pxQueue = &( xRxQueues[ uxPair ] );
+        const volatile VirtqUsed_t * pxUsed = &( pxQueue->xUsed );
+        BaseType_t xRefilled = pdFALSE;
+
+        while( ( xCount < xBudget ) && ( pxUsed->usIndex != pxQueue->usLastUsed ) )
+        {
+            const volatile VirtqUsedElem_t * pxElem;
+            uint16_t usSlot;
+            size_t uxLength;
+            NetworkBufferDescriptor_t * pxBuffer;
+            NetworkBufferDescriptor_t * pxNewBuffer;
+
+            /* Read the used element after its index. */
+            niVIRTIO_MEMORY_BARRIER();
+
+            pxElem = &( pxUsed->xRing[ pxQueue->usLastUsed % pxQueue->usSize ] );
+            usSlot = ( uint16_t ) ( pxElem->ulID / 2U );
+            uxLength = ( size_t ) pxElem->ulLength;
+            pxQueue->usLastUsed++;
+
+            configASSERT( usSlot < niVIRTIO_SLOT_COUNT );
+            pxBuffer = pxQueue->pxBuffers[ usSlot ];
+
+            /* Replace the buffer before passing it on, when no buffer is
+             * available, the frame is dropped and its buffer reused. */
+            pxNewBuffer = pxGetNetworkBufferWithDescriptor( ipTOTAL_ETHERNET_FRAME_SIZE, 0U );
+
+            if( pxNewBuffer == NULL )
+            {
+                vNetworkInterfaceRxDropped( pxMyInterface, eDropNoBuffer );
+                prvRxQueueAdd( pxQueue, usSlot, pxBuffer );
+            }
+            else if( ( uxLength <= sizeof( VirtioNetHeader_t ) ) ||
+                     ( ipCONSIDER_FRAME_FOR_PROCESSING( pxBuffer->pucEthernetBuffer ) != eProcessBuffer ) )
+            {
+                vReleaseNetworkBufferAndDescriptor( pxNewBuffer );
+                iptraceETHERNET_RX_EVENT_LOST();
+                prvRxQueueAdd( pxQueue, usSlot, pxBuffer );
+            }
+            else
+            {
+                pxBuffer->xDataLength = uxLength - sizeof( VirtioNetHeader_t );
+                pxBuffer->pxInterface = pxMyInterface;
+                pxBuffer->pxEndPoint = FreeRTOS_MatchingEndpoint( pxMyInterface, pxBuffer->pucEthernetBuffer );
+
+                #if ( ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+                {
+                    /* A partial checksum means that the packet was never on
+                     * a wire, its contents are valid. */
+                    if( ( pxQueue->xHeaders[ usSlot ].ucFlags & ( VIRTIO_NET_HDR_F_DATA_VALID | VIRTIO_NET_HDR_F_NEEDS_CSUM ) ) != 0U )
+                    {
+                        pxBuffer->ucChecksumFlags = ipBUFFER_CHECKSUM_VERIFIED;
+                    }
+                }
+                #endif
+
+                #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+                    pxMyInterface->xQueues[ uxPair ].ulRxCount++;
+                #endif
+
+                prvRxQueueAdd( pxQueue, usSlot, pxNewBuffer );
+
+                iptraceNETWORK_INTERFACE_RECEIVE();
+
+                #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+                {
+                    vNetworkInterfacePollInput( pxBuffer );
+                }
+                #else
+                {
+                    pxBurst[ uxBurstCount ] = pxBuffer;
+                    uxBurstCount++;
+
+                    if( uxBurstCount == niRX_BURST_LENGTH )
+                    {
+                        ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, 0U );
+                        uxBurstCount = 0U;
+                    }
+                }
+                #endif
+            }
+
+            xRefilled = pdTRUE;
+            xCount++;
+        }
+
+        if( xRefilled != pdFALSE )
+        {
+            /* One notification for all the buffers that were given back. */
+            prvQueueNotify( pxQueue );
+        }
+    }
+
+    if( uxBurstCount > 0U )
+    {
+        ( void ) xSendRxBurstToIPTask( pxBurst, uxBurstCount, 0U );
+    }
+
+    ( void ) pxBurst;
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReclaimTxBuffers( VirtioQueue_t * pxQueue )
+{
+    const volatile VirtqUsed_t * pxUsed = &( pxQueue->xUsed );
+
+    while( pxUsed->usIndex != pxQueue->usLastUsed )
+    {
+        uint16_t usSlot;
+
+        niVIRTIO_MEMORY_BARRIER();
+
+        usSlot = ( uint16_t ) ( pxUsed->xRing[ pxQueue->usLastUsed % pxQueue->usSize ].ulID / 2U );
+        pxQueue->usLastUsed++;
+
+        configASSERT( usSlot < niVIRTIO_SLOT_COUNT );
+
+        if( pxQueue->pxBuffers[ usSlot ] != NULL )
+        {
+            vReleaseNetworkBufferAndDescriptor( pxQueue->pxBuffers[ usSlot ] );
+            pxQueue->pxBuffers[ usSlot ] = NULL;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrepareTxHeader( VirtioNetHeader_t * pxHeader,
+                                NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    uint8_t * pucFrame = pxNetworkBuffer->pucEthernetBuffer;
+    const EthernetHeader_t * pxEthernetHeader = ( const EthernetHeader_t * ) pucFrame;
+    uint8_t ucPseudo[ 40 ];
+    size_t uxPseudoLength = 0U;
+    size_t uxIPHeaderLength = 0U;
+    uint8_t ucProtocol = 0U;
+    uint16_t usProtocolLength = 0U;
+
+    ( void ) memset( pxHeader, 0, sizeof( *pxHeader ) );
+
+    if( niVIRTIO_TX_CHECKSUM_NEEDED( pxNetworkBuffer ) )
+    {
+        if( pxEthernetHeader->usFrameType == ipIPv4_FRAME_TYPE )
+        {
+            IPHeader_t * pxIPHeader = &( ( ( IPPacket_t * ) pucFrame )->xIPHeader );
+
+            uxIPHeaderLength = ( ( size_t ) pxIPHeader->ucVersionHeaderLength & 0x0FU ) << 2;
+            ucProtocol = pxIPHeader->ucProtocol;
+            usProtocolLength = ( uint16_t ) ( FreeRTOS_ntohs( pxIPHeader->usLength ) - uxIPHeaderLength );
+
+            /* The device only inserts the checksum of the protocol. */
+            pxIPHeader->usHeaderChecksum = 0U;
+            pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderLength );
+            pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+
+            /* Source and destination address, zero, protocol, length. */
+            ( void ) memcpy( ucPseudo, &( pxIPHeader->ulSourceIPAddress ), 2U * ipSIZE_OF_IPv4_ADDRESS );
+            uxPseudoLength = 2U * ipSIZE_OF_IPv4_ADDRESS;
+            ucPseudo[ uxPseudoLength ] = 0U;
+            ucPseudo[ uxPseudoLength + 1U ] = ucProtocol;
+            ucPseudo[ uxPseudoLength + 2U ] = ( uint8_t ) ( usProtocolLength >> 8 );
+            ucPseudo[ uxPseudoLength + 3U ] = ( uint8_t ) ( usProtocolLength & 0xFFU );
+            uxPseudoLength += 4U;
+        }
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            else if( pxEthernetHeader->usFrameType == ipIPv6_FRAME_TYPE )
+            {
+                const IPHeader_IPv6_t * pxIPHeader = &( ( ( const IPPacket_IPv6_t * ) pucFrame )->xIPHeader );
+
+                uxIPHeaderLength = ipSIZE_OF_IPv6_HEADER;
+                ucProtocol = pxIPHeader->ucNextHeader;
+                usProtocolLength = FreeRTOS_ntohs( pxIPHeader->usPayloadLength );
+
+                /* Source and destination address, length, zeros, next header. */
+                ( void ) memcpy( ucPseudo, pxIPHeader->xSourceAddress.ucBytes, 2U * ipSIZE_OF_IPv6_ADDRESS );
+                uxPseudoLength = 2U * ipSIZE_OF_IPv6_ADDRESS;
+                ( void ) memset( &( ucPseudo[ uxPseudoLength ] ), 0, 8U );
+                ucPseudo[ uxPseudoLength + 2U ] = ( uint8_t ) ( usProtocolLength >> 8 );
+                ucPseudo[ uxPseudoLength + 3U ] = ( uint8_t ) ( usProtocolLength & 0xFFU );
+                ucPseudo[ uxPseudoLength + 7U ] = ucProtocol;
+                uxPseudoLength += 8U;
+            }
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+        else
+        {
+            /* Not an IP packet, there is nothing to insert. */
+        }
+
+        if( ( ( ullFeatures & VIRTIO_NET_F_CSUM ) != 0U ) &&
+            ( ( ucProtocol == ( uint8_t ) ipPROTOCOL_TCP ) || ( ucProtocol == ( uint8_t ) ipPROTOCOL_UDP ) ) )
+        {
+            size_t uxChecksumStart = ipSIZE_OF_ETH_HEADER + uxIPHeaderLength;
+            size_t uxChecksumOffset = ( ucProtocol == ( uint8_t ) ipPROTOCOL_TCP ) ? 16U : 6U;
+            uint16_t usPseudoSum;
+
+            /* The device adds the sum of the protocol header and data to the
+             * sum of the pseudo header, which is stored in the checksum field. */
+            usPseudoSum = FreeRTOS_htons( usGenerateChecksum( 0U, ucPseudo, uxPseudoLength ) );
+            ( void ) memcpy( &( pucFrame[ uxChecksumStart + uxChecksumOffset ] ), &usPseudoSum, sizeof( usPseudoSum ) );
+
+            pxHeader->ucFlags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+            pxHeader->usChecksumStart = ( uint16_t ) uxChecksumStart;
+            pxHeader->usChecksumOffset = ( uint16_t ) uxChecksumOffset;
+
+            #if ( ipconfigUSE_TCP_TSO != 0 )
+            {
+                if( ( ucProtocol == ( uint8_t ) ipPROTOCOL_TCP ) && ( pxNetworkBuffer->usTCPSegmentSize != 0U ) )
+                {
+                    const TCPHeader_t * pxTCPHeader = ( const TCPHeader_t * ) &( pucFrame[ uxChecksumStart ] );
+                    size_t uxHeaderLength = uxChecksumStart + ( ( ( size_t ) pxTCPHeader->ucTCPOffset >> 4 ) << 2 );
+
+                    if( ( pxNetworkBuffer->xDataLength - uxHeaderLength ) > pxNetworkBuffer->usTCPSegmentSize )
+                    {
+                        pxHeader->ucGSOType = ( pxEthernetHeader->usFrameType == ipIPv4_FRAME_TYPE ) ? VIRTIO_NET_HDR_GSO_TCPV4 : VIRTIO_NET_HDR_GSO_TCPV6;
+                        pxHeader->usHeaderLength = ( uint16_t ) uxHeaderLength;
+                        pxHeader->usGSOSize = pxNetworkBuffer->usTCPSegmentSize;
+                    }
+                }
+            }
+            #endif /* ( ipconfigUSE_TCP_TSO != 0 ) */
+        }
+        else if( ucProtocol != 0U )
+        {
+            ( void ) usGenerateProtocolChecksum( pucFrame, pxNetworkBuffer->xDataLength, pdTRUE );
+        }
+        else
+        {
+            /* Not an IP packet. */
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t xVirtioNet_NetworkInterfaceOutput( NetworkInterface_t * pxInterface,
+                                                     NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     BaseType_t xReleaseAfterSend )
+{
+    BaseType_t xResult = pdFAIL;
+    NetworkBufferDescriptor_t * pxSendBuffer = NULL;
+    VirtioQueue_t * pxQueue;
+    UBaseType_t uxQueue = 0U;
+
+    #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+        uxQueue = uxNetworkInterfaceSelectQueue( pxInterface, pxNetworkBuffer );
+    #else
+        ( void ) pxInterface;
+    #endif
+
+    pxQueue = &( xTxQueues[ uxQueue ] );
+
+    if( ( xDeviceReady != pdFALSE ) && ( xVirtioNet_GetPhyLinkStatus( pxInterface ) != pdFALSE ) )
+    {
+        prvReclaimTxBuffers( pxQueue );
+
+        if( pxQueue->pxBuffers[ pxQueue->usNextSlot ] == NULL )
+        {
+            /* The device reads the frame from the network buffer, which is
+             * released once it shows up in the used ring.  A buffer that the
+             * caller keeps must be shared or copied. */
+            if( xReleaseAfterSend != pdFALSE )
+            {
+                pxSendBuffer = pxNetworkBuffer;
+            }
+            else
+            {
+                #if ( ipconfigUSE_NETWORK_BUFFER_REFCOUNT != 0 )
+                    pxSendBuffer = pxNetworkBufferAddReference( pxNetworkBuffer );
+                #else
+                    pxSendBuffer = pxDuplicateNetworkBufferWithDescriptor( pxNetworkBuffer, pxNetworkBuffer->xDataLength );
+                #endif
+            }
+        }
+    }
+
+    if( pxSendBuffer != NULL )
+    {
+        uint16_t usSlot = pxQueue->usNextSlot;
+        uint16_t usHead = ( uint16_t ) ( 2U * usSlot );
+
+        prvPrepareTxHeader( &( pxQueue->xHeaders[ usSlot ] ), pxSendBuffer );
+
+        pxQueue->pxBuffers[ usSlot ] = pxSendBuffer;
+        pxQueue->usNextSlot = ( uint16_t ) ( ( usSlot + 1U ) % niVIRTIO_SLOT_COUNT );
+
+        pxQueue->xDesc[ usHead ].ullAddress = niVIRTIO_PHYS_ADDR( &( pxQueue->xHeaders[ usSlot ] ) );
+        pxQueue->xDesc[ usHead ].ulLength = ( uint32_t ) sizeof( VirtioNetHeader_t );
+        pxQueue->xDesc[ usHead ].usFlags = VIRTQ_DESC_F_NEXT;
+        pxQueue->xDesc[ usHead ].usNext = ( uint16_t ) ( usHead + 1U );
+
+        pxQueue->xDesc[ usHead + 1U ].ullAddress = niVIRTIO_PHYS_ADDR( pxSendBuffer->pucEthernetBuffer );
+        pxQueue->xDesc[ usHead + 1U ].ulLength = ( uint32_t ) pxSendBuffer->xDataLength;
+        pxQueue->xDesc[ usHead + 1U ].usFlags = 0U;
+        pxQueue->xDesc[ usHead + 1U ].usNext = 0U;
+
+        pxQueue->xAvail.usRing[ pxQueue->xAvail.usIndex % pxQueue->usSize ] = usHead;
+        niVIRTIO_MEMORY_BARRIER();
+        pxQueue->xAvail.usIndex++;
+
+        prvQueueNotify( pxQueue );
+
+        #if ( ipconfigUSE_NETWORK_MULTI_QUEUE != 0 )
+            pxInterface->xQueues[ uxQueue ].ulTxCount++;
+        #endif
+
+        iptraceNETWORK_INTERFACE_TRANSMIT();
+        xResult = pdPASS;
+    }
+
+    if( ( xReleaseAfterSend != pdFALSE ) && ( pxSendBuffer == NULL ) )
+    {
+        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+#if ( niVIRTIO_QUEUE_PAIRS > 1U )
+
+    static BaseType_t prvSetQueuePairs( uint16_t usPairs )
+    {
+        const TickType_t xMaxWait = pdMS_TO_TICKS( 1000U );
+        TimeOut_t xTimeOut;
+        TickType_t xTicksToWait = xMaxWait;
+        const volatile VirtqUsed_t * pxUsed = &( xCtrlQueue.xUsed );
+        BaseType_t xResult = pdFAIL;
+
+        ucCtrlCommand[ 0 ] = VIRTIO_NET_CTRL_MQ;
+        ucCtrlCommand[ 1 ] = VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET;
+        usCtrlPairs = usPairs;
+        ucCtrlAck = 0xFFU;
+
+        /* The command, its argument and the status written by the device. */
+        xCtrlQueue.xDesc[ 0 ].ullAddress = niVIRTIO_PHYS_ADDR( ucCtrlCommand );
+        xCtrlQueue.xDesc[ 0 ].ulLength = ( uint32_t ) sizeof( ucCtrlCommand );
+        xCtrlQueue.xDesc[ 0 ].usFlags = VIRTQ_DESC_F_NEXT;
+        xCtrlQueue.xDesc[ 0 ].usNext = 1U;
+        xCtrlQueue.xDesc[ 1 ].ullAddress = niVIRTIO_PHYS_ADDR( &usCtrlPairs );
+        xCtrlQueue.xDesc[ 1 ].ulLength = ( uint32_t ) sizeof( usCtrlPairs );
+        xCtrlQueue.xDesc[ 1 ].usFlags = VIRTQ_DESC_F_NEXT;
+        xCtrlQueue.xDesc[ 1 ].usNext = 2U;
+        xCtrlQueue.xDesc[ 2 ].ullAddress = niVIRTIO_PHYS_ADDR( &ucCtrlAck );
+        xCtrlQueue.xDesc[ 2 ].ulLength = ( uint32_t ) sizeof( ucCtrlAck );
+        xCtrlQueue.xDesc[ 2 ].usFlags = VIRTQ_DESC_F_WRITE;
+        xCtrlQueue.xDesc[ 2 ].usNext = 0U;
+
+        xCtrlQueue.xAvail.usRing[ xCtrlQueue.xAvail.usIndex % xCtrlQueue.usSize ] = 0U;
+        niVIRTIO_MEMORY_BARRIER();
+        xCtrlQueue.xAvail.usIndex++;
+        prvQueueNotify( &xCtrlQueue );
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        while( pxUsed->usIndex == xCtrlQueue.usLastUsed )
+        {
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                break;
+            }
+
+            vTaskDelay( 1U );
+        }
+
+        if( pxUsed->usIndex != xCtrlQueue.usLastUsed )
+        {
+            niVIRTIO_MEMORY_BARRIER();
+            xCtrlQueue.usLastUsed++;
+
+            if( ucCtrlAck == VIRTIO_NET_OK )
+            {
+                xResult = pdPASS;
+            }
+        }
+
+        return xResult;
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ( niVIRTIO_QUEUE_PAIRS > 1U ) */
+
+static BaseType_t xVirtioNet_GetPhyLinkStatus( NetworkInterface_t * pxInterface )
+{
+    BaseType_t xResult = pdFALSE;
+
+    ( void ) pxInterface;
+
+    if( xDeviceReady != pdFALSE )
+    {
+        if( ( ( ullFeatures & VIRTIO_NET_F_STATUS ) == 0U ) ||
+            ( ( niVIRTIO_CONFIG_SHORT( VIRTIO_NET_CONFIG_STATUS ) & VIRTIO_NET_S_LINK_UP ) != 0U ) )
+        {
+            xResult = pdTRUE;
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The interrupt handler of the virtio-mmio slot, to be called by the
+ *        application from the interrupt vector of the device.
+ */
+void vVirtioNet_IRQHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t ulStatus;
+
+    ulStatus = niVIRTIO_REG( VIRTIO_MMIO_INTERRUPT_STATUS );
+    niVIRTIO_REG( VIRTIO_MMIO_INTERRUPT_ACK ) = ulStatus;
+
+    if( ( pxMyInterface != NULL ) && ( xDeviceReady != pdFALSE ) )
+    {
+        if( ( ( ulStatus & VIRTIO_MMIO_INT_CONFIG ) != 0U ) &&
+            ( xVirtioNet_GetPhyLinkStatus( pxMyInterface ) == pdFALSE ) )
+        {
+            xHigherPriorityTaskWoken |= FreeRTOS_NetworkDownFromISR( pxMyInterface );
+        }
+
+        if( ( ulStatus & VIRTIO_MMIO_INT_VRING ) != 0U )
+        {
+            #if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+            {
+                xHigherPriorityTaskWoken |= FreeRTOS_NetworkInterfacePollFromISR( pxMyInterface );
+            }
+            #else
+            {
+                vTaskNotifyGiveFromISR( xEMACTaskHandle, &( xHigherPriorityTaskWoken ) );
+            }
+            #endif
+        }
+    }
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 )
+
+/* Called by the IP-task after vVirtioNet_IRQHandler() asked for it. */
+    static BaseType_t xVirtioNet_Poll( NetworkInterface_t * pxInterface,
+                                       BaseType_t xBudget )
+    {
+        ( void ) pxInterface;
+
+        return prvReceiveFrames( xBudget );
+    }
+    /*-----------------------------------------------------------*/
+
+#else /* if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 ) */
+
+    static void prvEMACHandlerTask( void * pvParameters )
+    {
+        const TickType_t xBlockTime = pdMS_TO_TICKS( 100U );
+
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, xBlockTime );
+
+            /* Keep reading until all RX queues are empty. */
+            while( prvReceiveFrames( ( BaseType_t ) niVIRTIO_RX_BUFFER_COUNT ) != 0 )
+            {
+            }
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* if ( ipconfigUSE_NETWORK_INTERFACE_POLL != 0 ) */
+
+void vNetworkInterfaceAllocateRAMToBuffers( NetworkBufferDescriptor_t pxNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ] )
+{
+    uint8_t * ucRAMBuffer = ucNetworkPackets;
+    uint32_t ul;
+
+    for( ul = 0; ul < ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS; ul++ )
+    {
+        pxNetworkBuffers[ ul ].pucEthernetBuffer = ucRAMBuffer + ipBUFFER_PADDING;
+        *( ( NetworkBufferDescriptor_t ** ) ucRAMBuffer ) = &( pxNetworkBuffers[ ul ] );
+        ucRAMBuffer += niBUFFER_1_PACKET_SIZE;
+    }
+}
+/*-----------------------------------------------------------*/
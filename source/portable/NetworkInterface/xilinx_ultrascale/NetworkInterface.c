@@ -487,11 +487,20 @@ static void prvEMACHandlerTask( void * pvParameters )
             xResult = emacps_check_rx( &xEMACpsif );
         }
 
-        if( ( xEMACpsif.isr_events & EMAC_IF_TX_EVENT ) != 0 )
+        #if ( niEMAC_TX_RECLAIM_THRESHOLD != 0 )
         {
+            /* There is no TX-complete interrupt, take back the buffers that
+             * emacps_send_message() has not reclaimed yet. */
             xEMACpsif.isr_events &= ~EMAC_IF_TX_EVENT;
             emacps_check_tx( &xEMACpsif );
         }
+        #else
+            if( ( xEMACpsif.isr_events & EMAC_IF_TX_EVENT ) != 0 )
+            {
+                xEMACpsif.isr_events &= ~EMAC_IF_TX_EVENT;
+                emacps_check_tx( &xEMACpsif );
+            }
+        #endif /* ( niEMAC_TX_RECLAIM_THRESHOLD != 0 ) */
 
         if( ( xEMACpsif.isr_events & EMAC_IF_ERR_EVENT ) != 0 )
         {
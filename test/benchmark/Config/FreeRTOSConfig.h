@@ -0,0 +1,154 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * Kernel configuration of the benchmark suite, for the FreeRTOS POSIX port.
+ * See README.md.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION                       1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#define configMAX_PRIORITIES                       ( 7 )
+#define configTICK_RATE_HZ                         ( 1000 )
+#define configMINIMAL_STACK_SIZE                   ( ( unsigned short ) PTHREAD_STACK_MIN )
+#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 16U * 1024U * 1024U ) )
+#define configMAX_TASK_NAME_LEN                    ( 15 )
+#define configUSE_TRACE_FACILITY                   0
+#define configUSE_16_BIT_TICKS                     0
+#define configIDLE_SHOULD_YIELD                    1
+#define configUSE_MUTEXES                          1
+#define configUSE_RECURSIVE_MUTEXES                1
+#define configQUEUE_REGISTRY_SIZE                  0
+#define configUSE_COUNTING_SEMAPHORES              1
+#define configUSE_TICK_HOOK                        0
+#define configUSE_IDLE_HOOK                        0
+#define configUSE_MALLOC_FAILED_HOOK               1
+#define configCHECK_FOR_STACK_OVERFLOW             0
+#define configUSE_TIMERS                           1
+#define configTIMER_TASK_PRIORITY                  ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                   5
+#define configTIMER_TASK_STACK_DEPTH               ( configMINIMAL_STACK_SIZE * 2 )
+#define configUSE_EVENT_GROUPS                     1
+#define configSUPPORT_DYNAMIC_ALLOCATION           1
+#define configSUPPORT_STATIC_ALLOCATION            0
+
+#define INCLUDE_vTaskPrioritySet                   1
+#define INCLUDE_uxTaskPriorityGet                  1
+#define INCLUDE_vTaskDelete                        1
+#define INCLUDE_vTaskSuspend                       1
+#define INCLUDE_vTaskDelayUntil                    1
+#define INCLUDE_vTaskDelay                         1
+#define INCLUDE_xTaskGetSchedulerState             1
+#define INCLUDE_xTaskGetCurrentTaskHandle          1
+#define INCLUDE_xTaskAbortDelay                    1
+#define INCLUDE_xTaskGetIdleTaskHandle             1
+
+/* Run-time statistics, so that the stress harness can tell the CPU time of
+ * the idle task from that of the other tasks.  The POSIX port supplies the
+ * counter. */
+#define configGENERATE_RUN_TIME_STATS              1
+
+/* The POSIX port needs the definition of PTHREAD_STACK_MIN. */
+#include <limits.h>
+
+#define configASSERT( x )                                              \
+    do {                                                               \
+        if( ( x ) == 0 )                                               \
+        {                                                              \
+            vAssertCalled( __FILE__, __LINE__ );                       \
+        }                                                              \
+    } while( 0 )
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine );
+
+/* Defined as 1 by CMakeLists.txt when the loopback interface is used. */
+#ifndef benchUSE_LOOPBACK
+    #define benchUSE_LOOPBACK    0
+#endif
+
+/* The pcap device used by the Linux network interface, see the list that it
+ * prints at start-up. */
+#ifndef configNETWORK_INTERFACE_TO_USE
+    #define configNETWORK_INTERFACE_TO_USE    1L
+#endif
+
+/* The addresses of the end-point.  When both the clients and the servers run
+ * on one end-point, its own address is used as the peer, see
+ * benchPEER_ADDRESS in benchmark.c.  The loopback interface only accepts
+ * addresses in 127.0.0.0/8. */
+#define configMAC_ADDR0    0x02
+#define configMAC_ADDR1    0x00
+#define configMAC_ADDR2    0x00
+#define configMAC_ADDR3    0x00
+#define configMAC_ADDR4    0x00
+#define configMAC_ADDR5    0x10
+
+#if ( benchUSE_LOOPBACK == 1 )
+    #define configIP_ADDR0            127
+    #define configIP_ADDR1            0
+    #define configIP_ADDR2            0
+    #define configIP_ADDR3            1
+
+    #define configGATEWAY_ADDR0       0
+    #define configGATEWAY_ADDR1       0
+    #define configGATEWAY_ADDR2       0
+    #define configGATEWAY_ADDR3       0
+
+    #define configNET_MASK0           255
+    #define configNET_MASK1           0
+    #define configNET_MASK2           0
+    #define configNET_MASK3           0
+
+    #define configDNS_SERVER_ADDR0    127
+    #define configDNS_SERVER_ADDR1    0
+    #define configDNS_SERVER_ADDR2    0
+    #define configDNS_SERVER_ADDR3    1
+#else
+    #define configIP_ADDR0            192
+    #define configIP_ADDR1            168
+    #define configIP_ADDR2            100
+    #define configIP_ADDR3            10
+
+    #define configGATEWAY_ADDR0       192
+    #define configGATEWAY_ADDR1       168
+    #define configGATEWAY_ADDR2       100
+    #define configGATEWAY_ADDR3       1
+
+    #define configNET_MASK0           255
+    #define configNET_MASK1           255
+    #define configNET_MASK2           255
+    #define configNET_MASK3           0
+
+    #define configDNS_SERVER_ADDR0    192
+    #define configDNS_SERVER_ADDR1    168
+    #define configDNS_SERVER_ADDR2    100
+    #define configDNS_SERVER_ADDR3    1
+#endif /* if ( benchUSE_LOOPBACK == 1 ) */
+
+#endif /* FREERTOS_CONFIG_H */
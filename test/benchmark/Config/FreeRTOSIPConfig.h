@@ -0,0 +1,76 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * FreeRTOS+TCP configuration of the benchmark suite.  It keeps the defaults
+ * wherever possible, so that the results follow the code paths that most
+ * applications use.  Options that change the hot paths can be added to the
+ * build with e.g. -DCMAKE_C_FLAGS="-DipconfigUSE_TCP_TSO=1".  See README.md.
+ */
+
+#ifndef FREERTOS_IP_CONFIG_H
+#define FREERTOS_IP_CONFIG_H
+
+#define ipconfigBYTE_ORDER                         pdFREERTOS_LITTLE_ENDIAN
+
+#define ipconfigUSE_IPv4                           ( 1 )
+#ifndef ipconfigUSE_IPv6
+    #define ipconfigUSE_IPv6                       ( 0 )
+#endif
+
+#define ipconfigUSE_DHCP                           ( 0 )
+#define ipconfigUSE_DNS                            ( 1 )
+#define ipconfigUSE_DNS_CACHE                      ( 1 )
+#define ipconfigDNS_CACHE_ENTRIES                  ( 64 )
+#define ipconfigUSE_TCP                            ( 1 )
+#define ipconfigUSE_TCP_WIN                        ( 1 )
+#define ipconfigUSE_NETWORK_EVENT_HOOK             ( 1 )
+#define ipconfigSUPPORT_NETWORK_DOWN_EVENT         ( 1 )
+
+#if ( benchUSE_LOOPBACK == 1 )
+    #define ipconfigUSE_LOOPBACK                   ( 1 )
+#endif
+
+#define ipconfigIP_TASK_PRIORITY                   ( configMAX_PRIORITIES - 2 )
+#define ipconfigIP_TASK_STACK_SIZE_WORDS           ( configMINIMAL_STACK_SIZE * 5 )
+
+#define ipconfigNETWORK_MTU                        ( 1500U )
+#define ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS     ( 256 )
+#define ipconfigEVENT_QUEUE_LENGTH                 ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5 )
+#define ipconfigARP_CACHE_ENTRIES                  ( 64 )
+
+#define ipconfigTCP_RX_BUFFER_LENGTH               ( 64U * 1024U )
+#define ipconfigTCP_TX_BUFFER_LENGTH               ( 64U * 1024U )
+#define ipconfigTCP_WIN_SEG_COUNT                  ( 256 )
+#define ipconfigUDP_MAX_RX_PACKETS                 ( 128U )
+
+#define ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME    ( pdMS_TO_TICKS( 5000U ) )
+#define ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME       ( pdMS_TO_TICKS( 5000U ) )
+
+/* Only the results are printed, as JSON lines on stdout. */
+#define ipconfigHAS_PRINTF                         ( 0 )
+#define ipconfigHAS_DEBUG_PRINTF                   ( 0 )
+
+#endif /* FREERTOS_IP_CONFIG_H */
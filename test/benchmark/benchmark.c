@@ -0,0 +1,819 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file benchmark.c
+ * @brief A throughput and latency benchmark suite for FreeRTOS+TCP.
+ *
+ * The suite has three servers: a TCP sink, a TCP echo server and a UDP
+ * counter.  One client task runs the benchmarks one after the other, either
+ * against the servers on the same end-point, or against the servers of a
+ * second instance, see benchPEER_ADDRESS.  Every result is printed on stdout
+ * as a single line of JSON:
+ *
+ *     {"benchmark":"tcp_bulk","value":912345,"unit":"kbit/s","iterations":16777216,"usec":147101}
+ *
+ * Only integers are printed, so the output does not depend on the float
+ * support of the printf() implementation.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined( __linux__ )
+    #include <time.h>
+#endif
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_ARP.h"
+#include "FreeRTOS_DNS.h"
+#include "FreeRTOS_Routing.h"
+
+#include "benchmark.h"
+
+#if ( ipconfigUSE_TCP == 0 ) || ( ipconfigUSE_IPv4 == 0 )
+    #error The benchmark suite needs ipconfigUSE_TCP and ipconfigUSE_IPv4
+#endif
+
+/* The servers listen on three consecutive ports: the TCP sink, the TCP echo
+ * server and the UDP counter. */
+#ifndef benchPORT_BASE
+    #define benchPORT_BASE         5001U
+#endif
+#define benchPORT_TCP_SINK         ( ( uint16_t ) ( benchPORT_BASE ) )
+#define benchPORT_TCP_ECHO         ( ( uint16_t ) ( benchPORT_BASE + 1U ) )
+#define benchPORT_UDP_COUNT        ( ( uint16_t ) ( benchPORT_BASE + 2U ) )
+
+/* The number of bytes sent by the TCP bulk benchmark. */
+#ifndef benchBULK_BYTES
+    #define benchBULK_BYTES        ( 16U * 1024U * 1024U )
+#endif
+
+/* The number and the size of the TCP request/response transactions. */
+#ifndef benchRR_COUNT
+    #define benchRR_COUNT          2000U
+#endif
+#ifndef benchRR_SIZE
+    #define benchRR_SIZE           64U
+#endif
+
+/* The number and the payload size of the UDP packets. */
+#ifndef benchUDP_COUNT
+    #define benchUDP_COUNT         20000U
+#endif
+#ifndef benchUDP_SIZE
+    #define benchUDP_SIZE          64U
+#endif
+
+/* The number of TCP connections that are set up and closed. */
+#ifndef benchCONNECT_COUNT
+    #define benchCONNECT_COUNT     200U
+#endif
+
+/* The number of ARP and DNS cache lookups. */
+#ifndef benchLOOKUP_COUNT
+    #define benchLOOKUP_COUNT      100000U
+#endif
+
+/* Define as 0 to only start the servers, e.g. in the peer instance. */
+#ifndef benchRUN_CLIENTS
+    #define benchRUN_CLIENTS       1
+#endif
+
+/* The IPv4 address of the servers as a string, e.g. "192.168.100.11".  When
+ * not defined, the clients use the servers of their own end-point. */
+#ifndef benchPEER_ADDRESS
+    #define benchPEER_ADDRESS      NULL
+#endif
+
+#ifndef benchTASK_PRIORITY
+    #define benchTASK_PRIORITY     ( tskIDLE_PRIORITY + 2U )
+#endif
+
+#ifndef benchTASK_STACK_SIZE
+    #define benchTASK_STACK_SIZE   ( configMINIMAL_STACK_SIZE * 4U )
+#endif
+
+/* The time in microseconds.  Outside Linux the resolution is one clock tick,
+ * which is too coarse for the latency benchmarks: in that case a hardware
+ * timer should be used. */
+#ifndef benchGET_TIME_US
+    #define benchGET_TIME_US()     ullGetTimeUS()
+#endif
+
+/* The size of the buffer that is sent and received. */
+#define benchBUFFER_SIZE           ( 8U * 1024U )
+
+/* How long a client waits for the peer, e.g. to close a connection. */
+#define benchTIMEOUT_MS            5000U
+
+/* The first byte of a UDP packet tells the counter what to do with it. */
+#define benchUDP_DATA              ( ( uint8_t ) 'D' )
+#define benchUDP_REPORT            ( ( uint8_t ) 'R' )
+
+/*-----------------------------------------------------------*/
+
+static void prvTCPSinkTask( void * pvParameters );
+static void prvTCPEchoTask( void * pvParameters );
+static void prvUDPCountTask( void * pvParameters );
+
+#if ( benchRUN_CLIENTS != 0 )
+    static void prvBenchmarkTask( void * pvParameters );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The end-point that the servers bind to, and that the clients use. */
+static NetworkEndPoint_t * pxBenchEndPoint;
+
+/*-----------------------------------------------------------*/
+
+#if defined( __linux__ )
+
+    static uint64_t ullGetTimeUS( void )
+    {
+        struct timespec xNow;
+
+        ( void ) clock_gettime( CLOCK_MONOTONIC, &( xNow ) );
+
+        return ( ( uint64_t ) xNow.tv_sec * 1000000U ) + ( ( uint64_t ) xNow.tv_nsec / 1000U );
+    }
+
+#else
+
+    static uint64_t ullGetTimeUS( void )
+    {
+        return ( ( uint64_t ) xTaskGetTickCount() * 1000000U ) / configTICK_RATE_HZ;
+    }
+
+#endif /* if defined( __linux__ ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create a TCP socket that listens on the end-point.
+ *
+ * @param[in] usPort The port number, in host byte order.
+ *
+ * @return The socket, or FREERTOS_INVALID_SOCKET.
+ */
+static Socket_t prvListen( uint16_t usPort )
+{
+    Socket_t xSocket;
+    struct freertos_sockaddr xAddress;
+    const TickType_t xNoTimeout = portMAX_DELAY;
+
+    xSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+
+    if( xSocket != FREERTOS_INVALID_SOCKET )
+    {
+        ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+        xAddress.sin_family = FREERTOS_AF_INET;
+        xAddress.sin_port = FreeRTOS_htons( usPort );
+
+        ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &( xNoTimeout ), sizeof( xNoTimeout ) );
+
+        if( ( FreeRTOS_bind( xSocket, &( xAddress ), sizeof( xAddress ) ) != 0 ) ||
+            ( FreeRTOS_listen( xSocket, 4 ) != 0 ) )
+        {
+            ( void ) FreeRTOS_closesocket( xSocket );
+            xSocket = FREERTOS_INVALID_SOCKET;
+        }
+    }
+
+    return xSocket;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Shut down a TCP connection, wait until the peer has closed it as
+ *        well, and close the socket.
+ *
+ * @param[in] xSocket The connected socket.
+ */
+static void prvCloseGracefully( Socket_t xSocket )
+{
+    static uint8_t ucDiscard[ 64 ];
+    TimeOut_t xTimeOut;
+    TickType_t xRemaining = pdMS_TO_TICKS( benchTIMEOUT_MS );
+
+    ( void ) FreeRTOS_shutdown( xSocket, FREERTOS_SHUT_RDWR );
+
+    vTaskSetTimeOutState( &( xTimeOut ) );
+
+    /* FreeRTOS_recv() returns a negative value once the connection is gone. */
+    while( ( FreeRTOS_recv( xSocket, ucDiscard, sizeof( ucDiscard ), 0 ) >= 0 ) &&
+           ( xTaskCheckForTimeOut( &( xTimeOut ), &( xRemaining ) ) == pdFALSE ) )
+    {
+    }
+
+    ( void ) FreeRTOS_closesocket( xSocket );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The TCP sink: it accepts one connection at a time, and discards
+ *        all that it receives, until the peer closes the connection.
+ */
+static void prvTCPSinkTask( void * pvParameters )
+{
+    static uint8_t ucBuffer[ benchBUFFER_SIZE ];
+    Socket_t xListener = prvListen( benchPORT_TCP_SINK );
+    Socket_t xClient;
+    struct freertos_sockaddr xPeer;
+    socklen_t xSize = sizeof( xPeer );
+
+    ( void ) pvParameters;
+    configASSERT( xListener != FREERTOS_INVALID_SOCKET );
+
+    for( ; ; )
+    {
+        xClient = FreeRTOS_accept( xListener, &( xPeer ), &( xSize ) );
+
+        if( ( xClient != NULL ) && ( xClient != FREERTOS_INVALID_SOCKET ) )
+        {
+            while( FreeRTOS_recv( xClient, ucBuffer, sizeof( ucBuffer ), 0 ) >= 0 )
+            {
+            }
+
+            ( void ) FreeRTOS_closesocket( xClient );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The TCP echo server: it accepts one connection at a time, and sends
+ *        back all that it receives.
+ */
+static void prvTCPEchoTask( void * pvParameters )
+{
+    static uint8_t ucBuffer[ benchBUFFER_SIZE ];
+    Socket_t xListener = prvListen( benchPORT_TCP_ECHO );
+    Socket_t xClient;
+    struct freertos_sockaddr xPeer;
+    socklen_t xSize = sizeof( xPeer );
+    BaseType_t xReceived;
+
+    ( void ) pvParameters;
+    configASSERT( xListener != FREERTOS_INVALID_SOCKET );
+
+    for( ; ; )
+    {
+        xClient = FreeRTOS_accept( xListener, &( xPeer ), &( xSize ) );
+
+        if( ( xClient != NULL ) && ( xClient != FREERTOS_INVALID_SOCKET ) )
+        {
+            for( ; ; )
+            {
+                xReceived = FreeRTOS_recv( xClient, ucBuffer, sizeof( ucBuffer ), 0 );
+
+                if( ( xReceived < 0 ) ||
+                    ( ( xReceived > 0 ) && ( FreeRTOS_send( xClient, ucBuffer, ( size_t ) xReceived, 0 ) < 0 ) ) )
+                {
+                    break;
+                }
+            }
+
+            ( void ) FreeRTOS_closesocket( xClient );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The UDP counter: it counts the data packets that it receives.  A
+ *        report packet is answered with the count, after which the count
+ *        starts again at zero.
+ */
+static void prvUDPCountTask( void * pvParameters )
+{
+    static uint8_t ucBuffer[ benchUDP_SIZE ];
+    Socket_t xSocket;
+    struct freertos_sockaddr xAddress;
+    socklen_t xSize;
+    int32_t lReceived;
+    uint32_t ulCount = 0U;
+    uint32_t ulReport;
+    const TickType_t xNoTimeout = portMAX_DELAY;
+
+    ( void ) pvParameters;
+
+    xSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_DGRAM, FREERTOS_IPPROTO_UDP );
+    configASSERT( xSocket != FREERTOS_INVALID_SOCKET );
+
+    ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+    xAddress.sin_family = FREERTOS_AF_INET;
+    xAddress.sin_port = FreeRTOS_htons( benchPORT_UDP_COUNT );
+    ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &( xNoTimeout ), sizeof( xNoTimeout ) );
+    ( void ) FreeRTOS_bind( xSocket, &( xAddress ), sizeof( xAddress ) );
+
+    for( ; ; )
+    {
+        xSize = sizeof( xAddress );
+        lReceived = FreeRTOS_recvfrom( xSocket, ucBuffer, sizeof( ucBuffer ), 0, &( xAddress ), &( xSize ) );
+
+        if( lReceived > 0 )
+        {
+            if( ucBuffer[ 0 ] == benchUDP_REPORT )
+            {
+                ulReport = FreeRTOS_htonl( ulCount );
+                ulCount = 0U;
+                ( void ) FreeRTOS_sendto( xSocket, &( ulReport ), sizeof( ulReport ), 0, &( xAddress ), xSize );
+            }
+            else
+            {
+                ulCount++;
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( benchRUN_CLIENTS != 0 )
+
+/**
+ * @brief Print one result as a line of JSON.
+ *
+ * @param[in] pcName The name of the benchmark.
+ * @param[in] ullValue The result.
+ * @param[in] pcUnit The unit of the result.
+ * @param[in] ulIterations The number of bytes, packets or operations.
+ * @param[in] ullTimeUS The duration of the benchmark in microseconds.
+ */
+    static void prvReport( const char * pcName,
+                           uint64_t ullValue,
+                           const char * pcUnit,
+                           uint32_t ulIterations,
+                           uint64_t ullTimeUS )
+    {
+        printf( "{\"benchmark\":\"%s\",\"value\":%llu,\"unit\":\"%s\",\"iterations\":%lu,\"usec\":%llu}\n",
+                pcName,
+                ( unsigned long long ) ullValue,
+                pcUnit,
+                ( unsigned long ) ulIterations,
+                ( unsigned long long ) ullTimeUS );
+        ( void ) fflush( stdout );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Connect a TCP client to one of the servers.
+ *
+ * @param[in] ulPeer The IPv4 address of the server, in network byte order.
+ * @param[in] usPort The port number, in host byte order.
+ *
+ * @return The connected socket, or FREERTOS_INVALID_SOCKET.
+ */
+    static Socket_t prvConnect( uint32_t ulPeer,
+                                uint16_t usPort )
+    {
+        Socket_t xSocket;
+        struct freertos_sockaddr xAddress;
+        const TickType_t xTimeout = pdMS_TO_TICKS( benchTIMEOUT_MS );
+
+        xSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+
+        if( xSocket != FREERTOS_INVALID_SOCKET )
+        {
+            ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+            xAddress.sin_family = FREERTOS_AF_INET;
+            xAddress.sin_port = FreeRTOS_htons( usPort );
+            xAddress.sin_address.ulIP_IPv4 = ulPeer;
+
+            ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &( xTimeout ), sizeof( xTimeout ) );
+            ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_SNDTIMEO, &( xTimeout ), sizeof( xTimeout ) );
+
+            if( FreeRTOS_connect( xSocket, &( xAddress ), sizeof( xAddress ) ) != 0 )
+            {
+                ( void ) FreeRTOS_closesocket( xSocket );
+                xSocket = FREERTOS_INVALID_SOCKET;
+            }
+        }
+
+        return xSocket;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief TCP bulk throughput: send benchBULK_BYTES to the sink.  The clock
+ *        stops when the sink has closed the connection, i.e. when it has
+ *        received all data.
+ */
+    static BaseType_t prvBenchTCPBulk( uint32_t ulPeer )
+    {
+        static uint8_t ucBuffer[ benchBUFFER_SIZE ];
+        Socket_t xSocket;
+        uint32_t ulSent = 0U;
+        BaseType_t xResult;
+        uint64_t ullStart;
+        uint64_t ullTime;
+        BaseType_t xReturn = pdFAIL;
+
+        ( void ) memset( ucBuffer, 0x5A, sizeof( ucBuffer ) );
+
+        xSocket = prvConnect( ulPeer, benchPORT_TCP_SINK );
+
+        if( xSocket != FREERTOS_INVALID_SOCKET )
+        {
+            ullStart = benchGET_TIME_US();
+
+            while( ulSent < benchBULK_BYTES )
+            {
+                xResult = FreeRTOS_send( xSocket, ucBuffer, sizeof( ucBuffer ), 0 );
+
+                if( xResult <= 0 )
+                {
+                    break;
+                }
+
+                ulSent += ( uint32_t ) xResult;
+            }
+
+            prvCloseGracefully( xSocket );
+            ullTime = benchGET_TIME_US() - ullStart;
+
+            if( ( ulSent >= benchBULK_BYTES ) && ( ullTime != 0U ) )
+            {
+                prvReport( "tcp_bulk", ( ( uint64_t ) ulSent * 8000U ) / ullTime, "kbit/s", ulSent, ullTime );
+                xReturn = pdPASS;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief TCP request/response latency: send benchRR_SIZE bytes to the echo
+ *        server and wait for all of them to come back, benchRR_COUNT times.
+ */
+    static BaseType_t prvBenchTCPRequestResponse( uint32_t ulPeer )
+    {
+        static uint8_t ucBuffer[ benchRR_SIZE ];
+        Socket_t xSocket;
+        uint32_t ulCount;
+        BaseType_t xReceived = 0;
+        BaseType_t xResult;
+        uint64_t ullStart;
+        uint64_t ullTime;
+        BaseType_t xReturn = pdFAIL;
+
+        xSocket = prvConnect( ulPeer, benchPORT_TCP_ECHO );
+
+        if( xSocket != FREERTOS_INVALID_SOCKET )
+        {
+            ullStart = benchGET_TIME_US();
+
+            for( ulCount = 0U; ulCount < benchRR_COUNT; ulCount++ )
+            {
+                if( FreeRTOS_send( xSocket, ucBuffer, sizeof( ucBuffer ), 0 ) != ( BaseType_t ) sizeof( ucBuffer ) )
+                {
+                    break;
+                }
+
+                for( xReceived = 0; xReceived < ( BaseType_t ) sizeof( ucBuffer ); xReceived += xResult )
+                {
+                    xResult = FreeRTOS_recv( xSocket, &( ucBuffer[ xReceived ] ), sizeof( ucBuffer ) - ( size_t ) xReceived, 0 );
+
+                    if( xResult <= 0 )
+                    {
+                        break;
+                    }
+                }
+
+                if( xReceived < ( BaseType_t ) sizeof( ucBuffer ) )
+                {
+                    break;
+                }
+            }
+
+            ullTime = benchGET_TIME_US() - ullStart;
+            prvCloseGracefully( xSocket );
+
+            if( ( ulCount == benchRR_COUNT ) && ( ullTime != 0U ) )
+            {
+                prvReport( "tcp_rr_latency", ( ullTime * 1000U ) / ulCount, "ns", ulCount, ullTime );
+                prvReport( "tcp_rr_rate", ( ( uint64_t ) ulCount * 1000000U ) / ullTime, "transactions/s", ulCount, ullTime );
+                xReturn = pdPASS;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief UDP packet rate: send benchUDP_COUNT packets to the counter, and ask
+ *        it how many have arrived.
+ */
+    static BaseType_t prvBenchUDP( uint32_t ulPeer )
+    {
+        static uint8_t ucBuffer[ benchUDP_SIZE ];
+        Socket_t xSocket;
+        struct freertos_sockaddr xAddress;
+        struct freertos_sockaddr xFrom;
+        socklen_t xSize;
+        const TickType_t xTimeout = pdMS_TO_TICKS( 500U );
+        uint32_t ulCount;
+        uint32_t ulSent = 0U;
+        uint32_t ulReport = 0U;
+        BaseType_t xAttempt;
+        uint64_t ullStart;
+        uint64_t ullTime = 0U;
+        BaseType_t xReturn = pdFAIL;
+
+        xSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_DGRAM, FREERTOS_IPPROTO_UDP );
+
+        if( xSocket != FREERTOS_INVALID_SOCKET )
+        {
+            ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+            xAddress.sin_family = FREERTOS_AF_INET;
+            xAddress.sin_port = FreeRTOS_htons( benchPORT_UDP_COUNT );
+            xAddress.sin_address.ulIP_IPv4 = ulPeer;
+            ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &( xTimeout ), sizeof( xTimeout ) );
+
+            /* A report request resets the counter.  It is answered after all
+             * packets that were sent before it, so the answer to the second
+             * request only counts the packets of this benchmark. */
+            for( xAttempt = 0; xAttempt < 2 * 5; xAttempt++ )
+            {
+                ucBuffer[ 0 ] = benchUDP_REPORT;
+                ( void ) FreeRTOS_sendto( xSocket, ucBuffer, sizeof( ucBuffer ), 0, &( xAddress ), sizeof( xAddress ) );
+                xSize = sizeof( xFrom );
+
+                if( FreeRTOS_recvfrom( xSocket, &( ulReport ), sizeof( ulReport ), 0, &( xFrom ), &( xSize ) ) == ( int32_t ) sizeof( ulReport ) )
+                {
+                    if( ulSent != 0U )
+                    {
+                        /* The second answer. */
+                        xReturn = pdPASS;
+                        break;
+                    }
+
+                    ucBuffer[ 0 ] = benchUDP_DATA;
+                    ullStart = benchGET_TIME_US();
+
+                    for( ulCount = 0U; ulCount < benchUDP_COUNT; ulCount++ )
+                    {
+                        if( FreeRTOS_sendto( xSocket, ucBuffer, sizeof( ucBuffer ), 0, &( xAddress ), sizeof( xAddress ) ) > 0 )
+                        {
+                            ulSent++;
+                        }
+                    }
+
+                    ullTime = benchGET_TIME_US() - ullStart;
+
+                    if( ulSent == 0U )
+                    {
+                        break;
+                    }
+                }
+            }
+
+            ( void ) FreeRTOS_closesocket( xSocket );
+
+            if( ( xReturn == pdPASS ) && ( ullTime != 0U ) )
+            {
+                ulReport = FreeRTOS_ntohl( ulReport );
+                prvReport( "udp_tx_pps", ( ( uint64_t ) ulSent * 1000000U ) / ullTime, "packets/s", ulSent, ullTime );
+                prvReport( "udp_rx_pps", ( ( uint64_t ) ulReport * 1000000U ) / ullTime, "packets/s", ulReport, ullTime );
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief TCP connection setup rate: connect to the sink and close the
+ *        connection gracefully, benchCONNECT_COUNT times.
+ */
+    static BaseType_t prvBenchTCPConnect( uint32_t ulPeer )
+    {
+        Socket_t xSocket;
+        uint32_t ulCount;
+        uint64_t ullStart;
+        uint64_t ullTime;
+        BaseType_t xReturn = pdFAIL;
+
+        ullStart = benchGET_TIME_US();
+
+        for( ulCount = 0U; ulCount < benchCONNECT_COUNT; ulCount++ )
+        {
+            xSocket = prvConnect( ulPeer, benchPORT_TCP_SINK );
+
+            if( xSocket == FREERTOS_INVALID_SOCKET )
+            {
+                break;
+            }
+
+            prvCloseGracefully( xSocket );
+        }
+
+        ullTime = benchGET_TIME_US() - ullStart;
+
+        if( ( ulCount == benchCONNECT_COUNT ) && ( ullTime != 0U ) )
+        {
+            prvReport( "tcp_connect_rate", ( ( uint64_t ) ulCount * 1000000U ) / ullTime, "connections/s", ulCount, ullTime );
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The cost of an ARP cache hit.  The scheduler is suspended, so that
+ *        the IP-task can not change the cache in the mean time.
+ */
+    static BaseType_t prvBenchARPLookup( void )
+    {
+        const MACAddress_t xNeighbourMAC = { { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 } };
+        const uint32_t ulNeighbour = pxBenchEndPoint->ipv4_settings.ulIPAddress ^ FreeRTOS_htonl( 3U );
+        MACAddress_t xMAC;
+        NetworkEndPoint_t * pxEndPoint;
+        uint32_t ulAddress;
+        uint32_t ulCount;
+        uint32_t ulHits = 0U;
+        uint64_t ullStart;
+        uint64_t ullTime;
+        BaseType_t xReturn = pdFAIL;
+
+        vARPRefreshCacheEntry( &( xNeighbourMAC ), ulNeighbour, pxBenchEndPoint );
+
+        vTaskSuspendAll();
+        {
+            ullStart = benchGET_TIME_US();
+
+            for( ulCount = 0U; ulCount < benchLOOKUP_COUNT; ulCount++ )
+            {
+                /* eARPGetCacheEntry() may replace the address with the one
+                 * of a gateway. */
+                ulAddress = ulNeighbour;
+                pxEndPoint = NULL;
+
+                if( eARPGetCacheEntry( &( ulAddress ), &( xMAC ), &( pxEndPoint ) ) == eARPCacheHit )
+                {
+                    ulHits++;
+                }
+            }
+
+            ullTime = benchGET_TIME_US() - ullStart;
+        }
+        ( void ) xTaskResumeAll();
+
+        if( ( ulHits == benchLOOKUP_COUNT ) && ( ullTime != 0U ) )
+        {
+            prvReport( "arp_lookup", ( ullTime * 1000U ) / ulCount, "ns", ulCount, ullTime );
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_DNS != 0 ) && ( ipconfigUSE_DNS_CACHE != 0 )
+
+/**
+ * @brief The cost of a FreeRTOS_gethostbyname() that is answered from the
+ *        DNS cache.
+ */
+        static BaseType_t prvBenchDNSLookup( void )
+        {
+            const char * pcName = "bench.example";
+            IPv46_Address_t xAddress;
+            uint32_t ulCount;
+            uint32_t ulHits = 0U;
+            uint64_t ullStart;
+            uint64_t ullTime;
+            BaseType_t xReturn = pdFAIL;
+
+            ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+            xAddress.xIPAddress.ulIP_IPv4 = FreeRTOS_inet_addr_quick( 192, 0, 2, 1 );
+            xAddress.xIs_IPv6 = pdFALSE;
+            ( void ) FreeRTOS_dns_update( pcName, &( xAddress ), 3600U, pdFALSE, NULL );
+
+            ullStart = benchGET_TIME_US();
+
+            for( ulCount = 0U; ulCount < benchLOOKUP_COUNT; ulCount++ )
+            {
+                if( FreeRTOS_gethostbyname( pcName ) == xAddress.xIPAddress.ulIP_IPv4 )
+                {
+                    ulHits++;
+                }
+            }
+
+            ullTime = benchGET_TIME_US() - ullStart;
+
+            if( ( ulHits == benchLOOKUP_COUNT ) && ( ullTime != 0U ) )
+            {
+                prvReport( "dns_cache_lookup", ( ullTime * 1000U ) / ulCount, "ns", ulCount, ullTime );
+                xReturn = pdPASS;
+            }
+
+            return xReturn;
+        }
+
+    #endif /* ( ipconfigUSE_DNS != 0 ) && ( ipconfigUSE_DNS_CACHE != 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run all benchmarks, one after the other.
+ */
+    static void prvBenchmarkTask( void * pvParameters )
+    {
+        uint32_t ulPeer;
+        BaseType_t xErrors = 0;
+
+        ( void ) pvParameters;
+
+        if( benchPEER_ADDRESS != NULL )
+        {
+            ulPeer = FreeRTOS_inet_addr( benchPEER_ADDRESS );
+        }
+        else
+        {
+            ulPeer = pxBenchEndPoint->ipv4_settings.ulIPAddress;
+        }
+
+        /* Give the servers some time to start. */
+        vTaskDelay( pdMS_TO_TICKS( 1000U ) );
+
+        printf( "{\"suite\":\"freertos_plus_tcp\",\"version\":\"%s\",\"tick_hz\":%lu,\"mtu\":%lu}\n",
+                ipFR_TCP_VERSION_NUMBER,
+                ( unsigned long ) configTICK_RATE_HZ,
+                ( unsigned long ) ipconfigNETWORK_MTU );
+
+        xErrors += ( prvBenchTCPBulk( ulPeer ) == pdPASS ) ? 0 : 1;
+        xErrors += ( prvBenchTCPRequestResponse( ulPeer ) == pdPASS ) ? 0 : 1;
+        xErrors += ( prvBenchUDP( ulPeer ) == pdPASS ) ? 0 : 1;
+        xErrors += ( prvBenchTCPConnect( ulPeer ) == pdPASS ) ? 0 : 1;
+        xErrors += ( prvBenchARPLookup() == pdPASS ) ? 0 : 1;
+
+        #if ( ipconfigUSE_DNS != 0 ) && ( ipconfigUSE_DNS_CACHE != 0 )
+        {
+            xErrors += ( prvBenchDNSLookup() == pdPASS ) ? 0 : 1;
+        }
+        #endif
+
+        vApplicationBenchmarksDone( xErrors );
+
+        vTaskDelete( NULL );
+    }
+
+#endif /* ( benchRUN_CLIENTS != 0 ) */
+/*-----------------------------------------------------------*/
+
+void vStartBenchmarks( struct xNetworkEndPoint * pxEndPoint )
+{
+    configASSERT( pxEndPoint != NULL );
+
+    pxBenchEndPoint = pxEndPoint;
+
+    ( void ) xTaskCreate( prvTCPSinkTask, "BenchSink", benchTASK_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+    ( void ) xTaskCreate( prvTCPEchoTask, "BenchEcho", benchTASK_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+    ( void ) xTaskCreate( prvUDPCountTask, "BenchUDP", benchTASK_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+
+    #if ( benchRUN_CLIENTS != 0 )
+    {
+        /* The client runs at a lower priority than the servers, so that the
+         * servers keep up with it when they run on the same end-point. */
+        ( void ) xTaskCreate( prvBenchmarkTask, "BenchClient", benchTASK_STACK_SIZE, NULL, benchTASK_PRIORITY - 1U, NULL );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,61 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/*
+ * A benchmark suite for FreeRTOS+TCP.  It measures TCP bulk throughput, TCP
+ * request/response latency, UDP packets per second, the TCP connection setup
+ * rate, and the cost of ARP and DNS cache lookups.  Each result is printed as
+ * one line of JSON, see README.md.
+ *
+ * The code only uses the FreeRTOS+TCP API, so that it can be linked into any
+ * application, e.g. one that runs in QEMU.
+ */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+struct xNetworkEndPoint;
+
+/* Start the servers and the benchmark task.  Call it once, when 'pxEndPoint'
+ * is up, e.g. from vApplicationIPNetworkEventHook_Multi(). */
+void vStartBenchmarks( struct xNetworkEndPoint * pxEndPoint );
+
+/* Supplied by the application: called by the benchmark task when all
+ * benchmarks have run.  'xErrors' counts the benchmarks that failed. */
+void vApplicationBenchmarksDone( BaseType_t xErrors );
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* BENCHMARK_H */
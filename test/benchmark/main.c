@@ -0,0 +1,190 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file main.c
+ * @brief Runs the benchmark suite in the FreeRTOS POSIX simulator.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_Routing.h"
+
+#include "benchmark.h"
+
+/* The function that fills the interface descriptor of the network driver,
+ * e.g. pxLoopback_FillInterfaceDescriptor, as set by CMakeLists.txt. */
+#ifndef benchFILL_INTERFACE_DESCRIPTOR
+    #error Please define benchFILL_INTERFACE_DESCRIPTOR
+#endif
+
+NetworkInterface_t * benchFILL_INTERFACE_DESCRIPTOR( BaseType_t xEMACIndex,
+                                                     NetworkInterface_t * pxInterface );
+
+/*-----------------------------------------------------------*/
+
+static const uint8_t ucMACAddress[ ipMAC_ADDRESS_LENGTH_BYTES ] =
+{
+    configMAC_ADDR0, configMAC_ADDR1, configMAC_ADDR2, configMAC_ADDR3, configMAC_ADDR4, configMAC_ADDR5
+};
+static const uint8_t ucIPAddress[ ipIP_ADDRESS_LENGTH_BYTES ] =
+{
+    configIP_ADDR0, configIP_ADDR1, configIP_ADDR2, configIP_ADDR3
+};
+static const uint8_t ucNetMask[ ipIP_ADDRESS_LENGTH_BYTES ] =
+{
+    configNET_MASK0, configNET_MASK1, configNET_MASK2, configNET_MASK3
+};
+static const uint8_t ucGatewayAddress[ ipIP_ADDRESS_LENGTH_BYTES ] =
+{
+    configGATEWAY_ADDR0, configGATEWAY_ADDR1, configGATEWAY_ADDR2, configGATEWAY_ADDR3
+};
+static const uint8_t ucDNSServerAddress[ ipIP_ADDRESS_LENGTH_BYTES ] =
+{
+    configDNS_SERVER_ADDR0, configDNS_SERVER_ADDR1, configDNS_SERVER_ADDR2, configDNS_SERVER_ADDR3
+};
+
+static NetworkInterface_t xInterface;
+static NetworkEndPoint_t xEndPoint;
+
+/* Used by the pseudo random number generator. */
+static UBaseType_t ulNextRand;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ulNextRand = ( UBaseType_t ) time( NULL );
+
+    ( void ) benchFILL_INTERFACE_DESCRIPTOR( 0, &( xInterface ) );
+    FreeRTOS_FillEndPoint( &( xInterface ), &( xEndPoint ), ucIPAddress, ucNetMask, ucGatewayAddress, ucDNSServerAddress, ucMACAddress );
+    ( void ) FreeRTOS_IPInit_Multi();
+
+    vTaskStartScheduler();
+
+    return EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIPNetworkEventHook_Multi( eIPCallbackEvent_t eNetworkEvent,
+                                           struct xNetworkEndPoint * pxEndPoint )
+{
+    static BaseType_t xTasksAlreadyCreated = pdFALSE;
+
+    if( ( eNetworkEvent == eNetworkUp ) && ( xTasksAlreadyCreated == pdFALSE ) )
+    {
+        vStartBenchmarks( pxEndPoint );
+        xTasksAlreadyCreated = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationBenchmarksDone( BaseType_t xErrors )
+{
+    if( xErrors != 0 )
+    {
+        fprintf( stderr, "%ld benchmark(s) failed\n", ( long ) xErrors );
+    }
+
+    exit( ( xErrors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "ASSERT failed: %s:%lu\n", pcFile, ulLine );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+    fprintf( stderr, "Out of heap\n" );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRand( void )
+{
+    const uint32_t ulMultiplier = 0x015a4e35UL, ulIncrement = 1UL;
+
+    /* Utility function to generate a pseudo random number. */
+
+    ulNextRand = ( ulMultiplier * ulNextRand ) + ulIncrement;
+    return( ( int ) ( ulNextRand ) & 0x7fffUL );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xApplicationGetRandomNumber( uint32_t * pulNumber )
+{
+    *pulNumber = ( ( uint32_t ) uxRand() << 16 ) ^ ( uint32_t ) uxRand();
+
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Callback that provides the inputs necessary to generate a randomized TCP
+ * Initial Sequence Number per RFC 6528.  THIS IS ONLY A DUMMY IMPLEMENTATION
+ * THAT RETURNS A PSEUDO RANDOM NUMBER SO IS NOT INTENDED FOR USE IN PRODUCTION
+ * SYSTEMS.
+ */
+uint32_t ulApplicationGetNextSequenceNumber( uint32_t ulSourceAddress,
+                                             uint16_t usSourcePort,
+                                             uint32_t ulDestinationAddress,
+                                             uint16_t usDestinationPort )
+{
+    uint32_t ulNumber;
+
+    ( void ) ulSourceAddress;
+    ( void ) usSourcePort;
+    ( void ) ulDestinationAddress;
+    ( void ) usDestinationPort;
+
+    ( void ) xApplicationGetRandomNumber( &( ulNumber ) );
+
+    return ulNumber;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationPingReplyHook( ePingReplyStatus_t eStatus,
+                                uint16_t usIdentifier )
+{
+    ( void ) eStatus;
+    ( void ) usIdentifier;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,785 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file microbenchmark.c
+ * @brief Microbenchmarks of the hot-path primitives of FreeRTOS+TCP.
+ *
+ * Each primitive is called in a loop, with the scheduler suspended so that
+ * the IP-task does not run in the mean time.  The loops are repeated for a
+ * number of table sizes or packet sizes, which shows how the cost scales.
+ * Every result is printed on stdout as a single line of JSON:
+ *
+ *     {"benchmark":"checksum","param":"bytes","size":1460,"iterations":100000,"ns_per_op":41.512,"cycles_per_op":124.537}
+ *
+ * "cycles_per_op" is only printed when benchGET_CYCLES() is available.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined( __linux__ )
+    #include <time.h>
+#endif
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_ARP.h"
+#include "FreeRTOS_ND.h"
+#include "FreeRTOS_DNS.h"
+#include "FreeRTOS_DNS_Cache.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_Stream_Buffer.h"
+#include "FreeRTOS_TCP_WIN.h"
+#include "NetworkBufferManagement.h"
+
+#include "benchmark.h"
+
+#if ( ipconfigUSE_TCP == 0 ) || ( ipconfigUSE_IPv4 == 0 )
+    #error The microbenchmarks need ipconfigUSE_TCP and ipconfigUSE_IPv4
+#endif
+
+/* The number of calls per measurement. */
+#ifndef benchMICRO_ITERATIONS
+    #define benchMICRO_ITERATIONS    100000U
+#endif
+
+#ifndef benchTASK_PRIORITY
+    #define benchTASK_PRIORITY       ( tskIDLE_PRIORITY + 2U )
+#endif
+
+#ifndef benchTASK_STACK_SIZE
+    #define benchTASK_STACK_SIZE     ( configMINIMAL_STACK_SIZE * 4U )
+#endif
+
+/* The time in nanoseconds.  Outside Linux the resolution is one clock tick,
+ * in that case a hardware timer should be used. */
+#ifndef benchGET_TIME_NS
+    #define benchGET_TIME_NS()       ullGetTimeNS()
+#endif
+
+/* A cycle counter, e.g. the DWT->CYCCNT of a Cortex-M.  On x86 the time
+ * stamp counter is used, which runs at a constant rate on modern CPUs. */
+#if !defined( benchGET_CYCLES ) && ( defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) )
+    #define benchGET_CYCLES()        ( ( uint64_t ) __builtin_ia32_rdtsc() )
+#endif
+
+/* The model of BufferAllocation_x.c, as set by CMakeLists.txt. */
+#ifndef benchBUFFER_ALLOCATION
+    #define benchBUFFER_ALLOCATION    0
+#endif
+
+/* The largest size that is used in the checksum and stream buffer tests. */
+#define benchMAX_DATA_SIZE           9000U
+
+/* The TCP segment size that is used in the TCP window tests. */
+#define benchMSS                     1460U
+
+#define benchARRAY_SIZE( x )    ( sizeof( x ) / sizeof( ( x )[ 0 ] ) )
+
+/*-----------------------------------------------------------*/
+
+static void prvMicroBenchmarkTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The end-point that was passed to vStartBenchmarks(). */
+static NetworkEndPoint_t * pxBenchEndPoint;
+
+/* The time and the cycle count at the start of a measurement. */
+static uint64_t ullStartNS;
+#ifdef benchGET_CYCLES
+    static uint64_t ullStartCycles;
+#endif
+
+/* Used as the data of the checksum and stream buffer tests. */
+static uint8_t ucData[ benchMAX_DATA_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+#if defined( __linux__ )
+
+    static uint64_t ullGetTimeNS( void )
+    {
+        struct timespec xNow;
+
+        ( void ) clock_gettime( CLOCK_MONOTONIC, &( xNow ) );
+
+        return ( ( uint64_t ) xNow.tv_sec * 1000000000U ) + ( uint64_t ) xNow.tv_nsec;
+    }
+
+#else
+
+    static uint64_t ullGetTimeNS( void )
+    {
+        return ( ( uint64_t ) xTaskGetTickCount() * 1000000000U ) / configTICK_RATE_HZ;
+    }
+
+#endif /* if defined( __linux__ ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start a measurement: suspend the scheduler and take the time.
+ */
+static void prvStart( void )
+{
+    vTaskSuspendAll();
+
+    #ifdef benchGET_CYCLES
+        ullStartCycles = benchGET_CYCLES();
+    #endif
+    ullStartNS = benchGET_TIME_NS();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Print a value with three decimals, without using floating point.
+ *
+ * @param[in] pcName The name of the JSON field.
+ * @param[in] ullTotal The total for all operations.
+ * @param[in] ulOperations The number of operations.
+ */
+static void prvPrintPerOperation( const char * pcName,
+                                  uint64_t ullTotal,
+                                  uint32_t ulOperations )
+{
+    uint64_t ullThousandths = ( ullTotal * 1000U ) / ulOperations;
+
+    printf( ",\"%s\":%llu.%03u",
+            pcName,
+            ( unsigned long long ) ( ullThousandths / 1000U ),
+            ( unsigned ) ( ullThousandths % 1000U ) );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Stop a measurement, resume the scheduler and print the result.
+ *
+ * @param[in] pcName The name of the benchmark.
+ * @param[in] pcParam What the size stands for, e.g. "bytes" or "entries".
+ * @param[in] uxSize The packet size or table size.
+ * @param[in] ulOperations The number of operations that were measured.
+ */
+static void prvStop( const char * pcName,
+                     const char * pcParam,
+                     size_t uxSize,
+                     uint32_t ulOperations )
+{
+    uint64_t ullNS = benchGET_TIME_NS() - ullStartNS;
+
+    #ifdef benchGET_CYCLES
+        uint64_t ullCycles = benchGET_CYCLES() - ullStartCycles;
+    #endif
+
+    ( void ) xTaskResumeAll();
+
+    if( ulOperations != 0U )
+    {
+        printf( "{\"benchmark\":\"%s\",\"param\":\"%s\",\"size\":%lu,\"iterations\":%lu",
+                pcName,
+                pcParam,
+                ( unsigned long ) uxSize,
+                ( unsigned long ) ulOperations );
+        prvPrintPerOperation( "ns_per_op", ullNS, ulOperations );
+        #ifdef benchGET_CYCLES
+            prvPrintPerOperation( "cycles_per_op", ullCycles, ulOperations );
+        #endif
+        printf( "}\n" );
+        ( void ) fflush( stdout );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The internet checksum over a buffer, and over a complete UDP packet.
+ */
+static void prvBenchChecksum( void )
+{
+    static const size_t uxSizes[] = { 20U, 64U, 576U, 1460U, benchMAX_DATA_SIZE };
+    static const size_t uxFrameSizes[] = { 64U, 576U, 1514U };
+    static uint8_t ucFrame[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+    UDPPacket_t * pxPacket = ( UDPPacket_t * ) ucFrame;
+    volatile uint16_t usSum = 0U;
+    size_t uxIndex;
+    uint32_t ulCount;
+
+    for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( uxSizes ); uxIndex++ )
+    {
+        prvStart();
+
+        for( ulCount = 0U; ulCount < benchMICRO_ITERATIONS; ulCount++ )
+        {
+            usSum = usGenerateChecksum( usSum, ucData, uxSizes[ uxIndex ] );
+        }
+
+        prvStop( "checksum", "bytes", uxSizes[ uxIndex ], ulCount );
+    }
+
+    ( void ) memset( ucFrame, 0x5A, sizeof( ucFrame ) );
+    pxPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+    pxPacket->xIPHeader.ucVersionHeaderLength = ipIPV4_VERSION_HEADER_LENGTH_MIN;
+    pxPacket->xIPHeader.ucProtocol = ( uint8_t ) ipPROTOCOL_UDP;
+    pxPacket->xIPHeader.usFragmentOffset = 0U;
+
+    for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( uxFrameSizes ); uxIndex++ )
+    {
+        size_t uxIPLength = uxFrameSizes[ uxIndex ] - ipSIZE_OF_ETH_HEADER;
+
+        pxPacket->xIPHeader.usLength = FreeRTOS_htons( ( uint16_t ) uxIPLength );
+        pxPacket->xUDPHeader.usLength = FreeRTOS_htons( ( uint16_t ) ( uxIPLength - ipSIZE_OF_IPv4_HEADER ) );
+
+        prvStart();
+
+        for( ulCount = 0U; ulCount < benchMICRO_ITERATIONS; ulCount++ )
+        {
+            ( void ) usGenerateProtocolChecksum( ucFrame, uxFrameSizes[ uxIndex ], pdTRUE );
+        }
+
+        prvStop( "protocol_checksum_udp", "bytes", uxFrameSizes[ uxIndex ], ulCount );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief uxStreamBufferAdd() and uxStreamBufferGet() of chunks of several
+ *        sizes: the buffer is filled, and then emptied again.
+ */
+static void prvBenchStreamBuffer( void )
+{
+    static const size_t uxSizes[] = { 64U, 536U, 1460U, benchMAX_DATA_SIZE };
+    static uint8_t ucOutput[ benchMAX_DATA_SIZE ];
+    const size_t uxLength = uxStreamBufferLength( ipconfigTCP_RX_BUFFER_LENGTH );
+    StreamBuffer_t * pxBuffer;
+    size_t uxIndex;
+    uint32_t ulCount;
+    uint32_t ulAdded;
+    uint32_t ulRound;
+    uint32_t ulRounds;
+
+    pxBuffer = ( StreamBuffer_t * ) pvPortMalloc( ( sizeof( *pxBuffer ) + uxLength ) - sizeof( pxBuffer->ucArray ) );
+
+    if( pxBuffer != NULL )
+    {
+        ( void ) memset( pxBuffer, 0, sizeof( *pxBuffer ) - sizeof( pxBuffer->ucArray ) );
+        pxBuffer->LENGTH = uxLength;
+
+        for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( uxSizes ); uxIndex++ )
+        {
+            ulAdded = ( uint32_t ) ( ( uxLength - 1U ) / uxSizes[ uxIndex ] );
+            ulRounds = ( benchMICRO_ITERATIONS + ulAdded - 1U ) / ulAdded;
+
+            /* Both functions are measured in rounds, one round fills the
+             * buffer and the next one empties it.  The measurement of
+             * uxStreamBufferGet() does not include the additions. */
+            prvStart();
+
+            for( ulRound = 0U; ulRound < ulRounds; ulRound++ )
+            {
+                for( ulCount = 0U; ulCount < ulAdded; ulCount++ )
+                {
+                    ( void ) uxStreamBufferAdd( pxBuffer, 0U, ucData, uxSizes[ uxIndex ] );
+                }
+
+                vStreamBufferClear( pxBuffer );
+            }
+
+            prvStop( "stream_buffer_add", "bytes", uxSizes[ uxIndex ], ulRounds * ulAdded );
+
+            ( void ) memset( pxBuffer, 0, sizeof( *pxBuffer ) - sizeof( pxBuffer->ucArray ) );
+            pxBuffer->LENGTH = uxLength;
+
+            for( ulCount = 0U; ulCount < ulAdded; ulCount++ )
+            {
+                ( void ) uxStreamBufferAdd( pxBuffer, 0U, ucData, uxSizes[ uxIndex ] );
+            }
+
+            prvStart();
+
+            for( ulRound = 0U; ulRound < ulRounds; ulRound++ )
+            {
+                /* Peek, so that the buffer stays filled for the next round. */
+                for( ulCount = 0U; ulCount < ulAdded; ulCount++ )
+                {
+                    ( void ) uxStreamBufferGet( pxBuffer, ( size_t ) ulCount * uxSizes[ uxIndex ], ucOutput, uxSizes[ uxIndex ], pdTRUE );
+                }
+            }
+
+            prvStop( "stream_buffer_get", "bytes", uxSizes[ uxIndex ], ulRounds * ulAdded );
+
+            vStreamBufferClear( pxBuffer );
+        }
+
+        vPortFree( pxBuffer );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP_WIN == 1 )
+
+/**
+ * @brief lTCPWindowRxCheck() for segments that arrive in order, and for
+ *        segments that arrive after a number of later segments were stored.
+ *
+ *        ulTCPWindowTxGet() for a number of segments in flight, including
+ *        lTCPWindowTxAdd() and ulTCPWindowTxAck() to fill and empty the
+ *        window.
+ */
+    static void prvBenchTCPWindow( void )
+    {
+        static const uint32_t ulDepths[] = { 1U, 4U, 16U, 64U };
+        static TCPWindow_t xWindow;
+        uint32_t ulSkipCount;
+        uint32_t ulSequence;
+        uint32_t ulRounds;
+        uint32_t ulRound;
+        uint32_t ulCount;
+        size_t uxIndex;
+        int32_t lPosition;
+        const int32_t lStreamSize = ( int32_t ) ( 128U * benchMSS );
+        const uint32_t ulSpace = 128U * benchMSS;
+
+        ( void ) memset( &( xWindow ), 0, sizeof( xWindow ) );
+        ( void ) xTCPWindowCreate( &( xWindow ), ulSpace, ulSpace, 1000U, 5000U, benchMSS );
+
+        prvStart();
+
+        for( ulCount = 0U; ulCount < benchMICRO_ITERATIONS; ulCount++ )
+        {
+            ( void ) lTCPWindowRxCheck( &( xWindow ), xWindow.rx.ulCurrentSequenceNumber, benchMSS, ulSpace, &( ulSkipCount ) );
+        }
+
+        prvStop( "tcp_window_rx_in_order", "segments", 1U, ulCount );
+
+        for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( ulDepths ); uxIndex++ )
+        {
+            ulRounds = benchMICRO_ITERATIONS / ( ulDepths[ uxIndex ] + 1U );
+
+            prvStart();
+
+            for( ulRound = 0U; ulRound < ulRounds; ulRound++ )
+            {
+                ulSequence = xWindow.rx.ulCurrentSequenceNumber;
+
+                /* The first segment is missing, the next ones are stored. */
+                for( ulCount = 1U; ulCount <= ulDepths[ uxIndex ]; ulCount++ )
+                {
+                    ( void ) lTCPWindowRxCheck( &( xWindow ), ulSequence + ( ulCount * benchMSS ), benchMSS, ulSpace, &( ulSkipCount ) );
+                }
+
+                /* The missing segment releases all of them. */
+                ( void ) lTCPWindowRxCheck( &( xWindow ), ulSequence, benchMSS, ulSpace, &( ulSkipCount ) );
+            }
+
+            prvStop( "tcp_window_rx_out_of_order", "segments", ulDepths[ uxIndex ], ulRounds * ( ulDepths[ uxIndex ] + 1U ) );
+        }
+
+        lPosition = 0;
+
+        for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( ulDepths ); uxIndex++ )
+        {
+            ulRounds = benchMICRO_ITERATIONS / ulDepths[ uxIndex ];
+
+            prvStart();
+
+            for( ulRound = 0U; ulRound < ulRounds; ulRound++ )
+            {
+                for( ulCount = 0U; ulCount < ulDepths[ uxIndex ]; ulCount++ )
+                {
+                    ( void ) lTCPWindowTxAdd( &( xWindow ), benchMSS, lPosition, lStreamSize );
+                    lPosition = ( lPosition + ( int32_t ) benchMSS ) % lStreamSize;
+                }
+
+                for( ulCount = 0U; ulCount < ulDepths[ uxIndex ]; ulCount++ )
+                {
+                    int32_t lDataPosition;
+
+                    ( void ) ulTCPWindowTxGet( &( xWindow ), ulSpace, &( lDataPosition ) );
+                }
+
+                ( void ) ulTCPWindowTxAck( &( xWindow ), xWindow.ulNextTxSequenceNumber );
+            }
+
+            prvStop( "tcp_window_tx", "segments", ulDepths[ uxIndex ], ulRounds * ulDepths[ uxIndex ] );
+        }
+
+        vTCPWindowDestroy( &( xWindow ) );
+    }
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief pxTCPSocketLookup() with a number of bound TCP sockets.  The port
+ *        of the socket that was bound first is looked up.
+ */
+static void prvBenchSocketLookup( void )
+{
+    static const size_t uxSizes[] = { 1U, 8U, 32U, 128U };
+    static Socket_t xSockets[ 128 ];
+    struct freertos_sockaddr xAddress;
+    IPv46_Address_t xRemote;
+    size_t uxIndex;
+    size_t uxBound = 0U;
+    uint32_t ulCount;
+    uint32_t ulFound;
+
+    ( void ) memset( &( xRemote ), 0, sizeof( xRemote ) );
+    ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+    xAddress.sin_family = FREERTOS_AF_INET;
+
+    for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( uxSizes ); uxIndex++ )
+    {
+        while( uxBound < uxSizes[ uxIndex ] )
+        {
+            xSockets[ uxBound ] = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+
+            if( xSockets[ uxBound ] == FREERTOS_INVALID_SOCKET )
+            {
+                break;
+            }
+
+            xAddress.sin_port = FreeRTOS_htons( ( uint16_t ) ( 6000U + uxBound ) );
+            ( void ) FreeRTOS_bind( xSockets[ uxBound ], &( xAddress ), sizeof( xAddress ) );
+            ( void ) FreeRTOS_listen( xSockets[ uxBound ], 1 );
+            uxBound++;
+        }
+
+        if( uxBound < uxSizes[ uxIndex ] )
+        {
+            break;
+        }
+
+        ulFound = 0U;
+
+        prvStart();
+
+        for( ulCount = 0U; ulCount < benchMICRO_ITERATIONS; ulCount++ )
+        {
+            if( pxTCPSocketLookup( 0U, 6000U, xRemote, 1234U ) != NULL )
+            {
+                ulFound++;
+            }
+        }
+
+        prvStop( "tcp_socket_lookup", "sockets", uxBound, ( ulFound == ulCount ) ? ulCount : 0U );
+    }
+
+    while( uxBound > 0U )
+    {
+        uxBound--;
+        ( void ) FreeRTOS_closesocket( xSockets[ uxBound ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief eARPGetCacheEntry() with a number of entries in the ARP cache.  The
+ *        lookups go round-robin over the entries that were added.
+ */
+static void prvBenchARPLookup( void )
+{
+    static const size_t uxSizes[] = { 1U, 4U, 16U, 64U };
+    MACAddress_t xMAC = { { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 } };
+    NetworkEndPoint_t * pxEndPoint;
+    const uint32_t ulNetwork = pxBenchEndPoint->ipv4_settings.ulIPAddress & pxBenchEndPoint->ipv4_settings.ulNetMask;
+    uint32_t ulAddress;
+    size_t uxIndex;
+    size_t uxEntry;
+    uint32_t ulCount;
+    uint32_t ulHits;
+
+    for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( uxSizes ); uxIndex++ )
+    {
+        if( uxSizes[ uxIndex ] > ( size_t ) ipconfigARP_CACHE_ENTRIES )
+        {
+            break;
+        }
+
+        FreeRTOS_ClearARP( pxBenchEndPoint );
+
+        for( uxEntry = 0U; uxEntry < uxSizes[ uxIndex ]; uxEntry++ )
+        {
+            xMAC.ucBytes[ 5 ] = ( uint8_t ) uxEntry;
+            vARPRefreshCacheEntry( &( xMAC ), ulNetwork | FreeRTOS_htonl( 100U + uxEntry ), pxBenchEndPoint );
+        }
+
+        ulHits = 0U;
+
+        prvStart();
+
+        for( ulCount = 0U; ulCount < benchMICRO_ITERATIONS; ulCount++ )
+        {
+            ulAddress = ulNetwork | FreeRTOS_htonl( 100U + ( ulCount % uxSizes[ uxIndex ] ) );
+
+            if( eARPGetCacheEntry( &( ulAddress ), &( xMAC ), &( pxEndPoint ) ) == eARPCacheHit )
+            {
+                ulHits++;
+            }
+        }
+
+        prvStop( "arp_cache_lookup", "entries", uxSizes[ uxIndex ], ( ulHits == ulCount ) ? ulCount : 0U );
+    }
+
+    FreeRTOS_ClearARP( pxBenchEndPoint );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_IPv6 != 0 )
+
+/**
+ * @brief eNDGetCacheEntry() with a number of entries in the ND cache.
+ */
+    static void prvBenchNDLookup( void )
+    {
+        static const size_t uxSizes[] = { 1U, 4U, 16U, 64U };
+        MACAddress_t xMAC = { { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 } };
+        NetworkEndPoint_t * pxEndPoint;
+        IPv6_Address_t xAddress;
+        size_t uxIndex;
+        size_t uxEntry;
+        uint32_t ulCount;
+        uint32_t ulHits;
+
+        /* fe80::100 and up. */
+        ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+        xAddress.ucBytes[ 0 ] = 0xfeU;
+        xAddress.ucBytes[ 1 ] = 0x80U;
+        xAddress.ucBytes[ 14 ] = 0x01U;
+
+        for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( uxSizes ); uxIndex++ )
+        {
+            if( uxSizes[ uxIndex ] > ( size_t ) ipconfigND_CACHE_ENTRIES )
+            {
+                break;
+            }
+
+            FreeRTOS_ClearND();
+
+            for( uxEntry = 0U; uxEntry < uxSizes[ uxIndex ]; uxEntry++ )
+            {
+                xMAC.ucBytes[ 5 ] = ( uint8_t ) uxEntry;
+                xAddress.ucBytes[ 15 ] = ( uint8_t ) uxEntry;
+                vNDRefreshCacheEntry( &( xMAC ), &( xAddress ), pxBenchEndPoint );
+            }
+
+            ulHits = 0U;
+
+            prvStart();
+
+            for( ulCount = 0U; ulCount < benchMICRO_ITERATIONS; ulCount++ )
+            {
+                xAddress.ucBytes[ 15 ] = ( uint8_t ) ( ulCount % uxSizes[ uxIndex ] );
+
+                if( eNDGetCacheEntry( &( xAddress ), &( xMAC ), &( pxEndPoint ) ) == eARPCacheHit )
+                {
+                    ulHits++;
+                }
+            }
+
+            prvStop( "nd_cache_lookup", "entries", uxSizes[ uxIndex ], ( ulHits == ulCount ) ? ulCount : 0U );
+        }
+
+        FreeRTOS_ClearND();
+    }
+
+#endif /* ipconfigUSE_IPv6 != 0 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_DNS != 0 ) && ( ipconfigUSE_DNS_CACHE != 0 )
+
+/**
+ * @brief FreeRTOS_ProcessDNSCache() lookups, with a number of names in the
+ *        DNS cache.
+ */
+    static void prvBenchDNSLookup( void )
+    {
+        static const size_t uxSizes[] = { 1U, 4U, 16U, 64U };
+        char pcNames[ 64 ][ 24 ];
+        IPv46_Address_t xAddress;
+        size_t uxIndex;
+        size_t uxEntry;
+        uint32_t ulCount;
+        uint32_t ulHits;
+
+        for( uxEntry = 0U; uxEntry < benchARRAY_SIZE( pcNames ); uxEntry++ )
+        {
+            ( void ) snprintf( pcNames[ uxEntry ], sizeof( pcNames[ uxEntry ] ), "host%u.bench.example", ( unsigned ) uxEntry );
+        }
+
+        for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( uxSizes ); uxIndex++ )
+        {
+            if( uxSizes[ uxIndex ] > ( size_t ) ipconfigDNS_CACHE_ENTRIES )
+            {
+                break;
+            }
+
+            FreeRTOS_dnsclear();
+
+            for( uxEntry = 0U; uxEntry < uxSizes[ uxIndex ]; uxEntry++ )
+            {
+                ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+                xAddress.xIPAddress.ulIP_IPv4 = FreeRTOS_inet_addr_quick( 192, 0, 2, ( uint8_t ) uxEntry );
+                ( void ) FreeRTOS_dns_update( pcNames[ uxEntry ], &( xAddress ), 3600U, pdFALSE, NULL );
+            }
+
+            ulHits = 0U;
+
+            prvStart();
+
+            for( ulCount = 0U; ulCount < benchMICRO_ITERATIONS; ulCount++ )
+            {
+                ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+
+                if( FreeRTOS_ProcessDNSCache( pcNames[ ulCount % uxSizes[ uxIndex ] ], &( xAddress ), 0U, pdTRUE, NULL ) != pdFALSE )
+                {
+                    ulHits++;
+                }
+            }
+
+            prvStop( "dns_cache_lookup", "entries", uxSizes[ uxIndex ], ( ulHits == ulCount ) ? ulCount : 0U );
+        }
+
+        FreeRTOS_dnsclear();
+    }
+
+#endif /* ( ipconfigUSE_DNS != 0 ) && ( ipconfigUSE_DNS_CACHE != 0 ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief pxGetNetworkBufferWithDescriptor() and
+ *        vReleaseNetworkBufferAndDescriptor(), for several sizes, in batches
+ *        of one or more buffers.
+ */
+static void prvBenchNetworkBuffers( void )
+{
+    static const size_t uxSizes[] = { 64U, 576U, ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER };
+    static const uint32_t ulBatches[] = { 1U, 16U };
+    static NetworkBufferDescriptor_t * pxBuffers[ 16 ];
+    char pcName[ 32 ];
+    size_t uxIndex;
+    size_t uxBatch;
+    uint32_t ulRound;
+    uint32_t ulRounds;
+    uint32_t ulCount;
+    uint32_t ulFailed = 0U;
+
+    for( uxIndex = 0U; uxIndex < benchARRAY_SIZE( uxSizes ); uxIndex++ )
+    {
+        for( uxBatch = 0U; uxBatch < benchARRAY_SIZE( ulBatches ); uxBatch++ )
+        {
+            ( void ) snprintf( pcName, sizeof( pcName ), "buffer_allocation_%d_batch_%u", benchBUFFER_ALLOCATION, ( unsigned ) ulBatches[ uxBatch ] );
+            ulRounds = benchMICRO_ITERATIONS / ulBatches[ uxBatch ];
+
+            prvStart();
+
+            for( ulRound = 0U; ulRound < ulRounds; ulRound++ )
+            {
+                for( ulCount = 0U; ulCount < ulBatches[ uxBatch ]; ulCount++ )
+                {
+                    pxBuffers[ ulCount ] = pxGetNetworkBufferWithDescriptor( uxSizes[ uxIndex ], 0U );
+                }
+
+                for( ulCount = 0U; ulCount < ulBatches[ uxBatch ]; ulCount++ )
+                {
+                    if( pxBuffers[ ulCount ] != NULL )
+                    {
+                        vReleaseNetworkBufferAndDescriptor( pxBuffers[ ulCount ] );
+                    }
+                    else
+                    {
+                        ulFailed++;
+                    }
+                }
+            }
+
+            prvStop( pcName, "bytes", uxSizes[ uxIndex ], ( ulFailed == 0U ) ? ( ulRounds * ulBatches[ uxBatch ] ) : 0U );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run all microbenchmarks, one after the other.
+ */
+static void prvMicroBenchmarkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    ( void ) memset( ucData, 0x5A, sizeof( ucData ) );
+
+    printf( "{\"suite\":\"freertos_plus_tcp_micro\",\"version\":\"%s\",\"iterations\":%lu,\"buffer_allocation\":%d}\n",
+            ipFR_TCP_VERSION_NUMBER,
+            ( unsigned long ) benchMICRO_ITERATIONS,
+            benchBUFFER_ALLOCATION );
+
+    prvBenchChecksum();
+    prvBenchStreamBuffer();
+
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+    {
+        prvBenchTCPWindow();
+    }
+    #endif
+
+    prvBenchSocketLookup();
+    prvBenchARPLookup();
+
+    #if ( ipconfigUSE_IPv6 != 0 )
+    {
+        prvBenchNDLookup();
+    }
+    #endif
+
+    #if ( ipconfigUSE_DNS != 0 ) && ( ipconfigUSE_DNS_CACHE != 0 )
+    {
+        prvBenchDNSLookup();
+    }
+    #endif
+
+    prvBenchNetworkBuffers();
+
+    vApplicationBenchmarksDone( 0 );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vStartBenchmarks( struct xNetworkEndPoint * pxEndPoint )
+{
+    configASSERT( pxEndPoint != NULL );
+
+    pxBenchEndPoint = pxEndPoint;
+
+    ( void ) xTaskCreate( prvMicroBenchmarkTask, "BenchMicro", benchTASK_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
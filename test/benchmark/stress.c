@@ -0,0 +1,743 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file stress.c
+ * @brief A connection-scale stress harness for FreeRTOS+TCP.
+ *
+ * For a growing number N of concurrent TCP connections, the harness opens N
+ * connections to its own server, or to the server of a peer instance, and
+ * measures what it costs the stack to hold them: the CPU time and the memory
+ * per connection, the accept latency, the cost of a socket lookup, the CPU
+ * time that the IP-task spends on N idle connections, and the rate at which
+ * connections can be replaced while N are open.  Every result is printed on
+ * stdout as a single line of JSON:
+ *
+ *     {"benchmark":"stress_open_cpu","connections":1024,"value":41235,"unit":"ns/connection"}
+ *
+ * The CPU time is that of the tasks other than the idle task, taken from the
+ * run-time statistics of the kernel.  It includes the harness tasks, whose
+ * cost per connection does not depend on N.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined( __linux__ )
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+#if defined( __GLIBC__ ) && ( ( __GLIBC__ > 2 ) || ( __GLIBC_MINOR__ >= 33 ) )
+    #include <malloc.h>
+#endif
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_Routing.h"
+
+#include "benchmark.h"
+
+#if ( ipconfigUSE_TCP == 0 ) || ( ipconfigUSE_IPv4 == 0 )
+    #error The stress harness needs ipconfigUSE_TCP and ipconfigUSE_IPv4
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS != 1 ) || ( INCLUDE_xTaskGetIdleTaskHandle != 1 )
+    #error The stress harness needs configGENERATE_RUN_TIME_STATS and INCLUDE_xTaskGetIdleTaskHandle
+#endif
+
+/* The largest number of concurrent connections.  The harness starts at 16
+ * and multiplies the number by 4 until it exceeds this maximum. */
+#ifndef benchSTRESS_MAX_CONNECTIONS
+    #define benchSTRESS_MAX_CONNECTIONS    4096U
+#endif
+
+/* The number of connections that may be in the middle of their handshake. */
+#ifndef benchSTRESS_CONNECT_WINDOW
+    #define benchSTRESS_CONNECT_WINDOW     32U
+#endif
+
+/* The number of connections that are closed and opened again while the
+ * others remain open. */
+#ifndef benchSTRESS_CHURN_COUNT
+    #define benchSTRESS_CHURN_COUNT        256U
+#endif
+
+/* How long the connections are left idle to measure the timer sweeps. */
+#ifndef benchSTRESS_IDLE_MS
+    #define benchSTRESS_IDLE_MS            2000U
+#endif
+
+/* The number of socket lookups per measurement. */
+#ifndef benchSTRESS_LOOKUP_COUNT
+    #define benchSTRESS_LOOKUP_COUNT       100000U
+#endif
+
+/* The server listens on this port, the clients bind to consecutive ports
+ * starting at benchSTRESS_CLIENT_PORT, so that the server can tell which
+ * client it accepted. */
+#ifndef benchSTRESS_SERVER_PORT
+    #define benchSTRESS_SERVER_PORT        5010U
+#endif
+#ifndef benchSTRESS_CLIENT_PORT
+    #define benchSTRESS_CLIENT_PORT        20000U
+#endif
+
+/* Define as 0 to only start the server, e.g. in the peer instance. */
+#ifndef benchRUN_CLIENTS
+    #define benchRUN_CLIENTS               1
+#endif
+
+/* The IPv4 address of the server as a string, e.g. "192.168.100.11".  When
+ * not defined, the clients use the server of their own end-point. */
+#ifndef benchPEER_ADDRESS
+    #define benchPEER_ADDRESS              NULL
+#endif
+
+#ifndef benchTASK_PRIORITY
+    #define benchTASK_PRIORITY             ( tskIDLE_PRIORITY + 2U )
+#endif
+
+#ifndef benchTASK_STACK_SIZE
+    #define benchTASK_STACK_SIZE           ( configMINIMAL_STACK_SIZE * 4U )
+#endif
+
+/* The time in microseconds, see benchmark.c. */
+#ifndef benchGET_TIME_US
+    #define benchGET_TIME_US()             ullGetTimeUS()
+#endif
+
+/* The rate of portGET_RUN_TIME_COUNTER_VALUE().  The POSIX port counts the
+ * user CPU time of the process, in clock ticks of times(). */
+#ifndef benchRUN_TIME_COUNTER_HZ
+    #if defined( __linux__ )
+        #define benchRUN_TIME_COUNTER_HZ    ( ( uint64_t ) sysconf( _SC_CLK_TCK ) )
+    #else
+        #define benchRUN_TIME_COUNTER_HZ    ( ( uint64_t ) configTICK_RATE_HZ )
+    #endif
+#endif
+
+/* The number of bytes allocated from the heap.  heap_3.c, as used on Linux,
+ * passes the allocations to malloc(). */
+#ifndef benchGET_HEAP_USED
+    #if defined( __GLIBC__ ) && ( ( __GLIBC__ > 2 ) || ( __GLIBC_MINOR__ >= 33 ) )
+        #define benchGET_HEAP_USED()       ( ( size_t ) mallinfo2().uordblks )
+    #else
+        #define benchGET_HEAP_USED()       ( ( size_t ) configTOTAL_HEAP_SIZE - xPortGetFreeHeapSize() )
+    #endif
+#endif
+
+/* How long the harness waits for progress before it gives up. */
+#define benchTIMEOUT_MS                    5000U
+
+/*-----------------------------------------------------------*/
+
+static void prvStressServerTask( void * pvParameters );
+
+#if ( benchRUN_CLIENTS != 0 )
+    static void prvStressClientTask( void * pvParameters );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The end-point that the server binds to, and that the clients use. */
+static NetworkEndPoint_t * pxBenchEndPoint;
+
+/* The connections accepted by the server, indexed by client. */
+static Socket_t xServerSockets[ benchSTRESS_MAX_CONNECTIONS ];
+
+/* The number of connections that the server has accepted. */
+static volatile uint32_t ulAcceptCount;
+
+#if ( benchRUN_CLIENTS != 0 )
+    /* The client sockets. */
+    static Socket_t xClientSockets[ benchSTRESS_MAX_CONNECTIONS ];
+
+    /* The time at which each client called FreeRTOS_connect(). */
+    static uint64_t ullConnectTime[ benchSTRESS_MAX_CONNECTIONS ];
+#endif
+
+/* The time at which the server accepted each client. */
+static uint64_t ullAcceptTime[ benchSTRESS_MAX_CONNECTIONS ];
+
+/*-----------------------------------------------------------*/
+
+#if defined( __linux__ )
+
+    static uint64_t ullGetTimeUS( void )
+    {
+        struct timespec xNow;
+
+        ( void ) clock_gettime( CLOCK_MONOTONIC, &( xNow ) );
+
+        return ( ( uint64_t ) xNow.tv_sec * 1000000U ) + ( ( uint64_t ) xNow.tv_nsec / 1000U );
+    }
+
+#else
+
+    static uint64_t ullGetTimeUS( void )
+    {
+        return ( ( uint64_t ) xTaskGetTickCount() * 1000000U ) / configTICK_RATE_HZ;
+    }
+
+#endif /* if defined( __linux__ ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The server: it accepts the connections and keeps them open until the
+ *        client closes them.  A client that connects again replaces its old
+ *        connection.
+ */
+static void prvStressServerTask( void * pvParameters )
+{
+    Socket_t xListener;
+    Socket_t xClient;
+    struct freertos_sockaddr xAddress;
+    socklen_t xSize;
+    uint32_t ulIndex;
+    const TickType_t xAcceptTimeout = pdMS_TO_TICKS( 100U );
+
+    ( void ) pvParameters;
+
+    xListener = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+    configASSERT( xListener != FREERTOS_INVALID_SOCKET );
+
+    ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+    xAddress.sin_family = FREERTOS_AF_INET;
+    xAddress.sin_port = FreeRTOS_htons( benchSTRESS_SERVER_PORT );
+    ( void ) FreeRTOS_setsockopt( xListener, 0, FREERTOS_SO_RCVTIMEO, &( xAcceptTimeout ), sizeof( xAcceptTimeout ) );
+    configASSERT( FreeRTOS_bind( xListener, &( xAddress ), sizeof( xAddress ) ) == 0 );
+    configASSERT( FreeRTOS_listen( xListener, ( BaseType_t ) ( 2U * benchSTRESS_CONNECT_WINDOW ) ) == 0 );
+
+    for( ; ; )
+    {
+        xSize = sizeof( xAddress );
+        xClient = FreeRTOS_accept( xListener, &( xAddress ), &( xSize ) );
+
+        if( ( xClient != NULL ) && ( xClient != FREERTOS_INVALID_SOCKET ) )
+        {
+            ulIndex = ( uint32_t ) FreeRTOS_ntohs( xAddress.sin_port ) - benchSTRESS_CLIENT_PORT;
+
+            if( ulIndex < benchSTRESS_MAX_CONNECTIONS )
+            {
+                if( xServerSockets[ ulIndex ] != NULL )
+                {
+                    ( void ) FreeRTOS_closesocket( xServerSockets[ ulIndex ] );
+                }
+
+                xServerSockets[ ulIndex ] = xClient;
+                ullAcceptTime[ ulIndex ] = benchGET_TIME_US();
+                ulAcceptCount++;
+            }
+            else
+            {
+                ( void ) FreeRTOS_closesocket( xClient );
+            }
+        }
+        else
+        {
+            /* Nothing to accept: close the connections that the clients
+             * have closed. */
+            for( ulIndex = 0U; ulIndex < benchSTRESS_MAX_CONNECTIONS; ulIndex++ )
+            {
+                if( ( xServerSockets[ ulIndex ] != NULL ) &&
+                    ( FreeRTOS_issocketconnected( xServerSockets[ ulIndex ] ) == pdFALSE ) )
+                {
+                    ( void ) FreeRTOS_closesocket( xServerSockets[ ulIndex ] );
+                    xServerSockets[ ulIndex ] = NULL;
+                }
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( benchRUN_CLIENTS != 0 )
+
+/**
+ * @brief Print one result as a line of JSON.
+ *
+ * @param[in] pcName The name of the measurement.
+ * @param[in] ulConnections The number of concurrent connections.
+ * @param[in] ullValue The result.
+ * @param[in] pcUnit The unit of the result.
+ */
+    static void prvReport( const char * pcName,
+                           uint32_t ulConnections,
+                           uint64_t ullValue,
+                           const char * pcUnit )
+    {
+        printf( "{\"benchmark\":\"%s\",\"connections\":%lu,\"value\":%llu,\"unit\":\"%s\"}\n",
+                pcName,
+                ( unsigned long ) ulConnections,
+                ( unsigned long long ) ullValue,
+                pcUnit );
+        ( void ) fflush( stdout );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The CPU time in microseconds that tasks other than the idle task
+ *        have used, counted from an arbitrary moment.
+ */
+    static uint64_t prvBusyTimeUS( void )
+    {
+        static uint64_t ullBusy = 0U;
+        static configRUN_TIME_COUNTER_TYPE xLastTotal = 0U;
+        static configRUN_TIME_COUNTER_TYPE xLastIdle = 0U;
+        configRUN_TIME_COUNTER_TYPE xTotal = portGET_RUN_TIME_COUNTER_VALUE();
+        configRUN_TIME_COUNTER_TYPE xIdle = ulTaskGetIdleRunTimeCounter();
+        configRUN_TIME_COUNTER_TYPE xTotalDelta = xTotal - xLastTotal;
+        configRUN_TIME_COUNTER_TYPE xIdleDelta = xIdle - xLastIdle;
+
+        /* The counters may wrap, only their differences are used. */
+        if( xTotalDelta > xIdleDelta )
+        {
+            ullBusy += ( uint64_t ) ( xTotalDelta - xIdleDelta );
+        }
+
+        xLastTotal = xTotal;
+        xLastIdle = xIdle;
+
+        return ( ullBusy * 1000000U ) / benchRUN_TIME_COUNTER_HZ;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create a client socket, bind it to its own port, and start
+ *        connecting without waiting for the result.
+ *
+ * @param[in] ulPeer The IPv4 address of the server, in network byte order.
+ * @param[in] ulIndex The number of the client.
+ *
+ * @return pdPASS when the connection is under way.
+ */
+    static BaseType_t prvStartConnect( uint32_t ulPeer,
+                                       uint32_t ulIndex )
+    {
+        Socket_t xSocket;
+        struct freertos_sockaddr xAddress;
+        const TickType_t xNoTimeout = 0U;
+        BaseType_t xResult;
+        BaseType_t xReturn = pdFAIL;
+
+        xSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+
+        if( xSocket != FREERTOS_INVALID_SOCKET )
+        {
+            ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+            xAddress.sin_family = FREERTOS_AF_INET;
+            xAddress.sin_port = FreeRTOS_htons( ( uint16_t ) ( benchSTRESS_CLIENT_PORT + ulIndex ) );
+
+            /* A receive time-out of zero makes FreeRTOS_connect() return
+             * as soon as the SYN has been scheduled. */
+            ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &( xNoTimeout ), sizeof( xNoTimeout ) );
+
+            if( FreeRTOS_bind( xSocket, &( xAddress ), sizeof( xAddress ) ) == 0 )
+            {
+                xAddress.sin_port = FreeRTOS_htons( benchSTRESS_SERVER_PORT );
+                xAddress.sin_address.ulIP_IPv4 = ulPeer;
+
+                ullConnectTime[ ulIndex ] = benchGET_TIME_US();
+                xResult = FreeRTOS_connect( xSocket, &( xAddress ), sizeof( xAddress ) );
+
+                if( ( xResult == 0 ) || ( xResult == -pdFREERTOS_ERRNO_EWOULDBLOCK ) )
+                {
+                    xReturn = pdPASS;
+                }
+            }
+
+            if( xReturn == pdPASS )
+            {
+                xClientSockets[ ulIndex ] = xSocket;
+            }
+            else
+            {
+                ( void ) FreeRTOS_closesocket( xSocket );
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Open the connections ulFirst..ulLast-1, with at most
+ *        benchSTRESS_CONNECT_WINDOW handshakes going on at the same time.
+ *
+ * @return pdPASS when all are connected.
+ */
+    static BaseType_t prvOpenConnections( uint32_t ulPeer,
+                                          uint32_t ulFirst,
+                                          uint32_t ulLast )
+    {
+        uint32_t ulNext = ulFirst;
+        uint32_t ulPending = ulFirst;
+        TimeOut_t xTimeOut;
+        TickType_t xRemaining = pdMS_TO_TICKS( benchTIMEOUT_MS );
+        BaseType_t xProgress;
+        BaseType_t xReturn = pdPASS;
+
+        vTaskSetTimeOutState( &( xTimeOut ) );
+
+        while( ulPending < ulLast )
+        {
+            xProgress = pdFALSE;
+
+            while( ( ulNext < ulLast ) && ( ( ulNext - ulPending ) < benchSTRESS_CONNECT_WINDOW ) )
+            {
+                if( prvStartConnect( ulPeer, ulNext ) != pdPASS )
+                {
+                    break;
+                }
+
+                ulNext++;
+                xProgress = pdTRUE;
+            }
+
+            /* The handshakes end in about the order in which they started. */
+            while( ( ulPending < ulNext ) && ( FreeRTOS_issocketconnected( xClientSockets[ ulPending ] ) > 0 ) )
+            {
+                ulPending++;
+                xProgress = pdTRUE;
+            }
+
+            if( xProgress != pdFALSE )
+            {
+                vTaskSetTimeOutState( &( xTimeOut ) );
+                xRemaining = pdMS_TO_TICKS( benchTIMEOUT_MS );
+            }
+            else if( xTaskCheckForTimeOut( &( xTimeOut ), &( xRemaining ) ) != pdFALSE )
+            {
+                xReturn = pdFAIL;
+                break;
+            }
+            else
+            {
+                vTaskDelay( 1U );
+            }
+        }
+
+        /* Close what was started but did not connect. */
+        while( ulNext > ulPending )
+        {
+            ulNext--;
+            ( void ) FreeRTOS_closesocket( xClientSockets[ ulNext ] );
+            xClientSockets[ ulNext ] = NULL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Close the client connections 0..ulCount-1.  The server closes its
+ *        side when it notices.
+ */
+    static void prvCloseConnections( uint32_t ulCount )
+    {
+        uint32_t ulIndex;
+
+        for( ulIndex = 0U; ulIndex < ulCount; ulIndex++ )
+        {
+            if( xClientSockets[ ulIndex ] != NULL )
+            {
+                ( void ) FreeRTOS_closesocket( xClientSockets[ ulIndex ] );
+                xClientSockets[ ulIndex ] = NULL;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The latency between FreeRTOS_connect() and the return of
+ *        FreeRTOS_accept() in the server.  Only known when the server runs
+ *        in this instance.
+ */
+    static void prvReportAcceptLatency( uint32_t ulCount )
+    {
+        uint32_t ulIndex;
+        uint64_t ullLatency;
+        uint64_t ullTotal = 0U;
+        uint64_t ullMaximum = 0U;
+        TimeOut_t xTimeOut;
+        TickType_t xRemaining = pdMS_TO_TICKS( benchTIMEOUT_MS );
+
+        /* The server may still be busy accepting the last ones. */
+        vTaskSetTimeOutState( &( xTimeOut ) );
+
+        while( ( ulAcceptCount < ulCount ) &&
+               ( xTaskCheckForTimeOut( &( xTimeOut ), &( xRemaining ) ) == pdFALSE ) )
+        {
+            vTaskDelay( 1U );
+        }
+
+        if( ulAcceptCount >= ulCount )
+        {
+            for( ulIndex = 0U; ulIndex < ulCount; ulIndex++ )
+            {
+                ullLatency = ullAcceptTime[ ulIndex ] - ullConnectTime[ ulIndex ];
+                ullTotal += ullLatency;
+
+                if( ullLatency > ullMaximum )
+                {
+                    ullMaximum = ullLatency;
+                }
+            }
+
+            prvReport( "stress_accept_latency_avg", ulCount, ullTotal / ulCount, "usec" );
+            prvReport( "stress_accept_latency_max", ulCount, ullMaximum, "usec" );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The cost of pxTCPSocketLookup() for the connections of the clients,
+ *        round-robin, with the scheduler suspended.
+ */
+    static void prvReportSocketLookup( uint32_t ulPeer,
+                                       uint32_t ulCount )
+    {
+        IPv46_Address_t xRemote;
+        uint32_t ulIteration;
+        uint32_t ulFound = 0U;
+        uint64_t ullStart;
+        uint64_t ullTime;
+        FreeRTOS_Socket_t * pxSocket;
+
+        ( void ) memset( &( xRemote ), 0, sizeof( xRemote ) );
+        xRemote.xIPAddress.ulIP_IPv4 = ulPeer;
+        xRemote.xIs_IPv6 = pdFALSE;
+
+        vTaskSuspendAll();
+        {
+            ullStart = benchGET_TIME_US();
+
+            for( ulIteration = 0U; ulIteration < benchSTRESS_LOOKUP_COUNT; ulIteration++ )
+            {
+                pxSocket = pxTCPSocketLookup( 0U,
+                                              ( UBaseType_t ) ( benchSTRESS_CLIENT_PORT + ( ulIteration % ulCount ) ),
+                                              xRemote,
+                                              ( UBaseType_t ) benchSTRESS_SERVER_PORT );
+
+                if( pxSocket != NULL )
+                {
+                    ulFound++;
+                }
+            }
+
+            ullTime = benchGET_TIME_US() - ullStart;
+        }
+        ( void ) xTaskResumeAll();
+
+        if( ulFound == benchSTRESS_LOOKUP_COUNT )
+        {
+            prvReport( "stress_socket_lookup", ulCount, ( ullTime * 1000U ) / benchSTRESS_LOOKUP_COUNT, "ns" );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run all measurements with ulCount concurrent connections.
+ *
+ * @return pdPASS when the connections could be opened.
+ */
+    static BaseType_t prvStressLevel( uint32_t ulPeer,
+                                      uint32_t ulCount,
+                                      BaseType_t xLocalServer )
+    {
+        uint64_t ullStart;
+        uint64_t ullBusy;
+        uint64_t ullTime;
+        size_t uxHeapBefore;
+        size_t uxHeapAfter;
+        uint32_t ulIndex;
+        BaseType_t xReturn;
+
+        ulAcceptCount = 0U;
+        uxHeapBefore = benchGET_HEAP_USED();
+        ullStart = benchGET_TIME_US();
+        ullBusy = prvBusyTimeUS();
+
+        xReturn = prvOpenConnections( ulPeer, 0U, ulCount );
+
+        ullBusy = prvBusyTimeUS() - ullBusy;
+        ullTime = benchGET_TIME_US() - ullStart;
+
+        if( xReturn == pdPASS )
+        {
+            if( xLocalServer != pdFALSE )
+            {
+                prvReportAcceptLatency( ulCount );
+            }
+
+            uxHeapAfter = benchGET_HEAP_USED();
+
+            if( ullTime != 0U )
+            {
+                prvReport( "stress_open_rate", ulCount, ( ( uint64_t ) ulCount * 1000000U ) / ullTime, "connections/s" );
+            }
+
+            prvReport( "stress_open_cpu", ulCount, ( ullBusy * 1000U ) / ulCount, "ns/connection" );
+
+            if( uxHeapAfter > uxHeapBefore )
+            {
+                prvReport( "stress_memory", ulCount, ( uint64_t ) ( uxHeapAfter - uxHeapBefore ) / ulCount, "bytes/connection" );
+            }
+
+            prvReportSocketLookup( ulPeer, ulCount );
+
+            /* All connections are idle now: the CPU time is spent in the
+             * timers of the stack. */
+            ullBusy = prvBusyTimeUS();
+            vTaskDelay( pdMS_TO_TICKS( benchSTRESS_IDLE_MS ) );
+            ullBusy = prvBusyTimeUS() - ullBusy;
+            prvReport( "stress_idle_cpu", ulCount, ( ullBusy * 1000U ) / benchSTRESS_IDLE_MS, "usec/s" );
+
+            /* Replace connections while the others remain open. */
+            ullStart = benchGET_TIME_US();
+            ullBusy = prvBusyTimeUS();
+
+            for( ulIndex = 0U; ulIndex < benchSTRESS_CHURN_COUNT; ulIndex++ )
+            {
+                ( void ) FreeRTOS_closesocket( xClientSockets[ ulIndex % ulCount ] );
+                xClientSockets[ ulIndex % ulCount ] = NULL;
+
+                if( prvOpenConnections( ulPeer, ulIndex % ulCount, ( ulIndex % ulCount ) + 1U ) != pdPASS )
+                {
+                    break;
+                }
+            }
+
+            ullBusy = prvBusyTimeUS() - ullBusy;
+            ullTime = benchGET_TIME_US() - ullStart;
+
+            if( ( ulIndex == benchSTRESS_CHURN_COUNT ) && ( ullTime != 0U ) )
+            {
+                prvReport( "stress_churn_rate", ulCount, ( ( uint64_t ) ulIndex * 1000000U ) / ullTime, "connections/s" );
+                prvReport( "stress_churn_cpu", ulCount, ( ullBusy * 1000U ) / ulIndex, "ns/connection" );
+            }
+
+            ullBusy = prvBusyTimeUS();
+            prvCloseConnections( ulCount );
+
+            /* Give the IP-task and the server the time to clean up. */
+            vTaskDelay( pdMS_TO_TICKS( 500U ) );
+            ullBusy = prvBusyTimeUS() - ullBusy;
+            prvReport( "stress_close_cpu", ulCount, ( ullBusy * 1000U ) / ulCount, "ns/connection" );
+        }
+        else
+        {
+            prvCloseConnections( ulCount );
+            vTaskDelay( pdMS_TO_TICKS( 500U ) );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run the measurements for a growing number of connections, until
+ *        benchSTRESS_MAX_CONNECTIONS or until the connections can not be
+ *        opened any more.
+ */
+    static void prvStressClientTask( void * pvParameters )
+    {
+        uint32_t ulPeer;
+        uint32_t ulCount;
+        uint32_t ulReached = 0U;
+        BaseType_t xLocalServer = pdFALSE;
+        BaseType_t xErrors = 0;
+
+        ( void ) pvParameters;
+
+        if( benchPEER_ADDRESS != NULL )
+        {
+            ulPeer = FreeRTOS_inet_addr( benchPEER_ADDRESS );
+        }
+        else
+        {
+            ulPeer = pxBenchEndPoint->ipv4_settings.ulIPAddress;
+            xLocalServer = pdTRUE;
+        }
+
+        /* Give the server some time to start. */
+        vTaskDelay( pdMS_TO_TICKS( 1000U ) );
+
+        printf( "{\"suite\":\"freertos_plus_tcp_stress\",\"version\":\"%s\",\"tick_hz\":%lu,\"max_connections\":%lu}\n",
+                ipFR_TCP_VERSION_NUMBER,
+                ( unsigned long ) configTICK_RATE_HZ,
+                ( unsigned long ) benchSTRESS_MAX_CONNECTIONS );
+
+        for( ulCount = 16U; ulCount <= benchSTRESS_MAX_CONNECTIONS; ulCount *= 4U )
+        {
+            if( prvStressLevel( ulPeer, ulCount, xLocalServer ) != pdPASS )
+            {
+                break;
+            }
+
+            ulReached = ulCount;
+        }
+
+        prvReport( "stress_max_connections", ulReached, ulReached, "connections" );
+
+        if( ulReached == 0U )
+        {
+            xErrors++;
+        }
+
+        vApplicationBenchmarksDone( xErrors );
+
+        vTaskDelete( NULL );
+    }
+
+#endif /* ( benchRUN_CLIENTS != 0 ) */
+/*-----------------------------------------------------------*/
+
+void vStartBenchmarks( struct xNetworkEndPoint * pxEndPoint )
+{
+    configASSERT( pxEndPoint != NULL );
+
+    pxBenchEndPoint = pxEndPoint;
+
+    ( void ) xTaskCreate( prvStressServerTask, "StressServer", benchTASK_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+
+    #if ( benchRUN_CLIENTS != 0 )
+    {
+        /* The client runs at a lower priority than the server, so that the
+         * server accepts the connections as soon as they are made. */
+        ( void ) xTaskCreate( prvStressClientTask, "StressClient", benchTASK_STACK_SIZE, NULL, benchTASK_PRIORITY - 1U, NULL );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
@@ -39,9 +39,35 @@
 #define ipconfigUSE_ARP_REVERSED_LOOKUP            1
 #define ipconfigUSE_ARP_REMOVE_ENTRY               1
 #define ipconfigARP_STORES_REMOTE_ADDRESSES        1
+#define ipconfigUSE_ARP_HASH_TABLE                 1
+#define ipconfigARP_HASH_BUCKET_COUNT              4
+#define ipconfigUSE_ND_HASH_TABLE                  1
+#define ipconfigND_HASH_BUCKET_COUNT               4
+#define ipconfigUSE_ROUTE_CACHE                    1
+#define ipconfigROUTE_CACHE_ENTRIES                8
+#define ipconfigUSE_STATIC_ROUTES                  1
+#define ipconfigMAX_STATIC_ROUTES                  8
+#define ipconfigARP_WAITING_BUFFER_COUNT           8
+#define ipconfigARP_WAITING_BUFFERS_PER_ADDRESS    4
+#define ipconfigARP_REFRESH_AHEAD_PERIODS          6
 #define ipconfigUSE_LINKED_RX_MESSAGES             1
+#define ipconfigUSE_SCATTER_GATHER                 1
+#define ipconfigUSE_NETWORK_BUFFER_REFCOUNT        1
+#define ipconfigNETWORK_BUFFERS_RESERVED_FOR_CONTROL    4
+#define ipconfigNETWORK_BUFFER_CACHE_LINE_SIZE     32
+#define ipconfigDCACHE_CLEAN( pvAddress, uxLength )         ( ( void ) ( pvAddress ), ( void ) ( uxLength ) )
+#define ipconfigDCACHE_INVALIDATE( pvAddress, uxLength )    ( ( void ) ( pvAddress ), ( void ) ( uxLength ) )
+#define ipconfigSTREAM_BUFFER_LOCK_FREE            1
+#define ipconfigSTREAM_BUFFER_MEMORY_BARRIER()    __sync_synchronize()
+#define ipconfigSTREAM_BUFFER_POWER_OF_TWO         1
 #define ipconfigFORCE_IP_DONT_FRAGMENT             1
 #define ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS     1
+#define ipconfigSUPPORT_RECVMMSG                   1
+#define ipconfigSUPPORT_SENDMMSG                   1
+#define ipconfigUSE_UDP_REUSEPORT                  1
+#define ipconfigUSE_UDP_CONNECT                    1
+#define ipconfigUSE_UDP_DIRECT_TX                  1
+#define ipconfigSUPPORT_IP_MULTICAST               1
 #define ipconfigDHCP_FALL_BACK_AUTO_IP             1
 #define ipconfigARP_USE_CLASH_DETECTION            1
 #define ipconfigUSE_LLMNR                          1
@@ -57,6 +83,10 @@
 #define ipconfigSUPPORT_SIGNALS                    1
 #define ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES     1
 #define ipconfigDNS_USE_CALLBACKS                  1
+#define ipconfigUSE_DNS_HAPPY_EYEBALLS             1
+#define ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS    250U
+#define ipconfigUSE_DNS_ASYNC_MULTIPLEX            1
+#define ipconfigDNS_ASYNC_TABLE_SIZE               16U
 #define ipconfigCOMPATIBLE_WITH_SINGLE             1
 #define ipconfigIGNORE_UNKNOWN_PACKETS             1
 #define ipconfigCHECK_IP_QUEUE_SPACE               1
@@ -64,6 +94,98 @@
 #define ipconfigETHERNET_MINIMUM_PACKET_BYTES      1
 #define ipconfigTCP_IP_SANITY                      1
 #define ipconfigSUPPORT_NETWORK_DOWN_EVENT         1
+#define ipconfigIP_TASK_EVENT_BURST_LENGTH         8
+#define ipconfigUSE_SOCKET_HASH_LOOKUP             1
+#define ipconfigSOCKET_HASH_BUCKET_COUNT           32
+#define ipconfigUSE_TCP_TIMER_WHEEL                1
+#define ipconfigUSE_NETWORK_RX_RING                1
+#define ipconfigNETWORK_RX_RING_LENGTH             32
+#define ipconfigUSE_NETWORK_INTERFACE_POLL         1
+#define ipconfigNETWORK_INTERFACE_POLL_BUDGET      16
+#define ipconfigUSE_NETWORK_MULTI_QUEUE            1
+#define ipconfigNETWORK_MAX_QUEUES                 4U
+#define ipconfigBUFFER_ALLOC_CACHE_SIZE            4
+#define ipconfigBUFFER_ALLOC_2_SIZE_CLASS          256U
+#define ipconfigTCP_TX_COPY_CHECKSUM               1
+#define ipconfigUSE_TCP_TSO                        1
+#define ipconfigUSE_TCP_RX_COALESCE                1
+#define ipconfigUSE_TCP_CONGESTION_CONTROL         1
+#define ipconfigUSE_TCP_TIMESTAMP_OPTION           1
+#define ipconfigUSE_TCP_RACK_TLP                   1
+#define ipconfigTCP_RX_INTERVAL_COUNT              8
+#define ipconfigTCP_WIN_SEG_CHUNK_COUNT            32
+#define ipconfigTCP_WIN_SEG_SOCKET_LIMIT           64
+#define ipconfigTCP_TX_REFERENCE_COUNT             4
+#define ipconfigTCP_RX_BUFFER_COUNT                4
+#define ipconfigTCP_LISTEN_POOL_SIZE               4
+#define ipconfigTCP_ACCEPT_QUEUE                   1
+#define ipconfigTCP_TIME_WAIT_COUNT                4
+#define ipconfigUSE_TCP_PACING                     1
+#define ipconfigUSE_TCP_AUTO_TUNING                1
+#define ipconfigTCP_STREAM_RELEASE_TIME            10
+#define ipconfigTCP_BUFFER_ARENA_SIZE              ( 64U * 1024U )
+#define ipconfigPHY_LS_ADAPTIVE_POLL               1
+#define ipconfigUSE_TCP_TRACE_RING                 1
+#define ipconfigTCP_TRACE_RING_ENTRIES             256
+#define ipconfigUSE_NETWORK_COUNTERS               1
+#define ipconfigUSE_IP_TASK_STATS                  1
+#define ipconfigUSE_TCP_WIN_EVENT_LOG              1
+#define ipconfigUSE_RESOURCE_STATS                 1
+#define ipconfigUSE_TCP_CAPTURE_RING               1
+#define ipconfigUSE_TCP_HEADER_PREDICTION          1
+#define ipconfigUSE_TCP_ACK_TEMPLATE               1
+#define ipconfigUSE_TCP_ACK_POLICY                 1
+#define ipconfigUSE_TCP_HIGH_RES_TIMER             1
+#define ipconfigUSE_TCP_FAST_OPEN                  1
+#define ipconfigUSE_TCP_SYN_COOKIES                1
+#define ipconfigSOCKET_POOL_UDP_COUNT              8
+#define ipconfigSOCKET_POOL_TCP_COUNT              8
+#define ipconfigUSE_DUAL_STACK_SOCKETS             1
+#define ipconfigUSE_TCP_PATH_MTU_DISCOVERY         1
+#define ipconfigUSE_INTERFACE_MTU                  1
+#define ipconfigUSE_IP_FRAGMENTATION               1
+#define ipconfigUSE_VLAN                           1
+#define ipconfigUSE_TX_PRIORITY_QUEUES             1
+#define ipconfigUSE_IP_EVENT_PRIORITY              1
+#define ipconfigUSE_SOFTWARE_MAC_FILTER            1
+#define ipconfigUSE_PACKET_FILTER                  1
+#define ipconfigUSE_SOCKET_MEMORY_BUDGET           1
+#define ipconfigUSE_ALIGNED_HEADER_ACCESS          1
+#define ipconfigUSE_SOCKET_BUSY_POLL               1
+#define ipconfigUSE_CALLBACK_BUFFER_TRANSFER       1
+#define ipconfigUSE_ROUTE_ECMP                     1
+#define ipconfigUSE_LINK_BONDING                   1
+#define ipconfigUSE_IP_FORWARDING                  1
+#define ipconfigUSE_NAPT                           1
+#define ipconfigUSE_TCP_SPLICE                     1
+#define ipconfigUSE_TCP_REUSEPORT                  1
+#define ipconfigNETWORK_BUFFER_RX_RESERVE          4U
+#define ipconfigARP_STATIC_ENTRIES                 4
+#define ipconfigND_STATIC_ENTRIES                  4
+#define ipconfigUSE_RA_OPTIMISTIC_DAD              1
+#define ipconfigUSE_TICKLESS_IP_TASK               1
+#define ipconfigARP_REQUEST_LIMIT_ENTRIES          8
+#define ipconfigUSE_ICMP_RATE_LIMIT                1
+#define ipconfigTCP_TX_SEGMENT_INDEX_COUNT         16
+#define ipconfigUSE_UDP_GSO                        1
+#define ipconfigUSE_NETWORK_TIMESTAMPS             1
+#define ipconfigUSE_NETWORK_EMULATION              1
+#define ipconfigSUPPORT_STATIC_SOCKETS             1
+#define ipconfigUSE_DRIVER_RESPONDER               1
+#define ipconfigUSE_TCP_RECORD_FRAMING             1
+#define ipconfigUSE_BRING_UP_TIMELINE              1
+#define ipconfigUSE_DNS_ANSWER_TEMPLATES           1
+#define ipconfigDNS_PARALLEL_SERVERS               2
+#define ipconfigUSE_SOCKET_ACCOUNTING              1
+#define ipconfigSUPPORT_ASYNC_SOCKETS              1
+#define ipconfigUSE_DNS_CACHE_PERSISTENCE          1
+#define ipconfigUSE_PACKET_METADATA                1
+#define ipconfigDNS_CACHE_NAME_POOL_SIZE           1024U
+#define ipconfigCOMPACT_NETWORK_BUFFER_DESCRIPTORS 1
+#define ipconfigUSE_TCP_LINK_SPEED_SIZING          1
+#define ipconfigRX_COPY_BREAK                      128U
+#define ipconfigUSE_TX_BACKPRESSURE                1
+#define ipconfigSOCKET_USES_NOTIFY                 1
 
 /* Set to 1 to print out debug messages.  If ipconfigHAS_DEBUG_PRINTF is set to
  * 1 then FreeRTOS_debug_printf should be defined to the function used to print
@@ -107,6 +229,12 @@
  */
 #define ipconfigUSE_DNS_CACHE                      ( 1 )
 #define ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY      ( 6 )
+#define ipconfigUSE_DNS_CACHE_HASH_TABLE           1
+#define ipconfigDNS_CACHE_HASH_BUCKET_COUNT        8U
+#define ipconfigUSE_DNS_NEGATIVE_CACHE             1
+#define ipconfigDNS_NEGATIVE_CACHE_ENTRIES         4U
+#define ipconfigUSE_DNS_CACHE_PREFETCH             1
+#define ipconfigUSE_DNS_IN_PLACE_PARSER            1
 #define ipconfigDNS_REQUEST_ATTEMPTS               ( 2 )
 
 /* The IP stack executes it its own task (although any application task can make
@@ -163,6 +291,9 @@
  * provide an implementation of the DHCP callback function,
  * xApplicationDHCPUserHook(). */
 #define ipconfigUSE_DHCP_HOOK                      1
+#define ipconfigUSE_DHCP_INIT_REBOOT               1
+#define ipconfigUSE_DHCP_RAPID_COMMIT              1
+#define ipconfigUSE_FAST_BRING_UP                  1
 
 /* When ipconfigUSE_DHCP is set to 1, DHCP requests will be sent out at
  * increasing time intervals until either a reply is received from a DHCP server
@@ -269,6 +400,9 @@
 /* If ipconfigSUPPORT_SELECT_FUNCTION is set to 1 then the FreeRTOS_select()
  * (and associated) API function is available. */
 #define ipconfigSUPPORT_SELECT_FUNCTION                1
+#define ipconfigSUPPORT_SELECT_READY_LIST              1
+#define ipconfigSELECT_LOCAL_EVALUATION                1
+#define ipconfigUDP_DIRECT_BIND                        1
 
 /* If ipconfigFILTER_OUT_NON_ETHERNET_II_FRAMES is set to 1 then Ethernet frames
  * that are not in Ethernet II format will be dropped.  This option is included for
@@ -59,6 +59,7 @@
 #define configUSE_ALTERNATIVE_API                  0
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS    3      /* FreeRTOS+FAT requires 2 pointers if a CWD is supported. */
 #define configRECORD_STACK_HIGH_ADDRESS            1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES      2
 
 /* Hook function related definitions. */
 #define configUSE_TICK_HOOK                        0
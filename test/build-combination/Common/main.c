@@ -336,6 +336,21 @@ struct xNetworkInterface * pxFillInterfaceDescriptor( BaseType_t xEMACIndex,
     }
 #endif /* ( ipconfigUSE_DHCP_HOOK != 0 ) */
 
+#if ( ipconfigUSE_DHCP_INIT_REBOOT != 0 )
+    BaseType_t xApplicationDHCPLeaseLoad( const struct xNetworkEndPoint * pxEndPoint,
+                                          DHCPLease_t * pxLease )
+    {
+        /* Provide a stub for this function. */
+        return pdFALSE;
+    }
+
+    void vApplicationDHCPLeaseStore( const struct xNetworkEndPoint * pxEndPoint,
+                                     const DHCPLease_t * pxLease )
+    {
+        /* Provide a stub for this function. */
+    }
+#endif /* ( ipconfigUSE_DHCP_INIT_REBOOT != 0 ) */
+
 #if ( ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES != 0 )
 
 /*
@@ -361,8 +376,24 @@ void vApplicationPingReplyHook( ePingReplyStatus_t eStatus,
     /* Provide a stub for this function. */
 }
 
-#if ( ipconfigUSE_IPv6 != 0 ) && ( ipconfigUSE_DHCPv6 != 0 )
-    /* DHCPv6 needs a time-stamp, seconds after 1970. */
+#if ( ipconfigUSE_DNS_CACHE_PERSISTENCE != 0 )
+    BaseType_t xApplicationDNSCacheStore( const DNSCacheRecord_t * pxRecords,
+                                          size_t uxCount )
+    {
+        /* Provide a stub for this function. */
+        return pdPASS;
+    }
+
+    size_t uxApplicationDNSCacheLoad( DNSCacheRecord_t * pxRecords,
+                                      size_t uxMaxCount )
+    {
+        /* Provide a stub for this function. */
+        return 0U;
+    }
+#endif /* ( ipconfigUSE_DNS_CACHE_PERSISTENCE != 0 ) */
+
+#if ( ( ipconfigUSE_IPv6 != 0 ) && ( ipconfigUSE_DHCPv6 != 0 ) ) || ( ipconfigUSE_DNS_CACHE_PERSISTENCE != 0 )
+    /* DHCPv6 and the DNS cache persistence need a time-stamp, seconds after 1970. */
     uint32_t ulApplicationTimeHook( void )
     {
         return ( uint32_t ) time( NULL );
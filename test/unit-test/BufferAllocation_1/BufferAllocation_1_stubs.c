@@ -0,0 +1,166 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "list.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "NetworkBufferManagement.h"
+
+/* The counting semaphore of the buffer allocator is simulated here, so that
+ * the tests can follow the tokens that move in and out of the caches. */
+UBaseType_t uxStubSemaphoreCount;
+UBaseType_t uxStubSemaphoreTakes;
+UBaseType_t uxStubSemaphoreGives;
+
+/* The nesting of critical sections and interrupt masks, which must be zero
+ * whenever the allocator returns. */
+BaseType_t xStubLockNesting;
+
+static StaticQueue_t xStubSemaphore;
+
+QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
+                                                   const UBaseType_t uxInitialCount,
+                                                   StaticQueue_t * pxStaticQueue )
+{
+    ( void ) uxMaxCount;
+    ( void ) pxStaticQueue;
+
+    uxStubSemaphoreCount = uxInitialCount;
+
+    return ( QueueHandle_t ) &xStubSemaphore;
+}
+
+QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
+                                             const UBaseType_t uxInitialCount )
+{
+    return xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, NULL );
+}
+
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                TickType_t xTicksToWait )
+{
+    BaseType_t xReturn = pdFAIL;
+
+    ( void ) xQueue;
+    ( void ) xTicksToWait;
+
+    if( uxStubSemaphoreCount > 0U )
+    {
+        uxStubSemaphoreCount--;
+        uxStubSemaphoreTakes++;
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+
+BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
+                                 void * const pvBuffer,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    ( void ) pvBuffer;
+    ( void ) pxHigherPriorityTaskWoken;
+
+    return xQueueSemaphoreTake( xQueue, 0U );
+}
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
+                              const void * const pvItemToQueue,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xCopyPosition )
+{
+    ( void ) xQueue;
+    ( void ) pvItemToQueue;
+    ( void ) xTicksToWait;
+    ( void ) xCopyPosition;
+
+    uxStubSemaphoreCount++;
+    uxStubSemaphoreGives++;
+
+    return pdPASS;
+}
+
+BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
+                              BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    ( void ) pxHigherPriorityTaskWoken;
+
+    return xQueueGenericSend( xQueue, NULL, 0U, queueSEND_TO_BACK );
+}
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    ( void ) xQueue;
+
+    return uxStubSemaphoreCount;
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    ( void ) xQueue;
+
+    return uxStubSemaphoreCount;
+}
+
+void vNetworkInterfaceAllocateRAMToBuffers( NetworkBufferDescriptor_t pxNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ] )
+{
+    ( void ) pxNetworkBuffers;
+}
+
+void vPortEnterCritical( void )
+{
+    xStubLockNesting++;
+}
+
+void vPortExitCritical( void )
+{
+    xStubLockNesting--;
+}
+
+portBASE_TYPE xPortSetInterruptMask( void )
+{
+    xStubLockNesting++;
+
+    return 0;
+}
+
+void vPortClearInterruptMask( portBASE_TYPE xMask )
+{
+    ( void ) xMask;
+
+    xStubLockNesting--;
+}
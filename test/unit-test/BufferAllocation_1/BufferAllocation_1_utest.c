@@ -0,0 +1,342 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "list.h"
+#include "semphr.h"
+
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "NetworkBufferManagement.h"
+
+#include "mock_task.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* The number of buffers that move between a cache and the free list at once. */
+#define TEST_BATCH_COUNT    ( ( ipconfigBUFFER_ALLOC_CACHE_SIZE + 1 ) / 2 )
+
+extern SemaphoreHandle_t xNetworkBufferSemaphore;
+extern List_t xFreeBuffersList;
+extern List_t xBufferCaches[ 1 ];
+extern NetworkBufferDescriptor_t xNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ];
+
+extern UBaseType_t uxStubSemaphoreCount;
+extern UBaseType_t uxStubSemaphoreTakes;
+extern UBaseType_t uxStubSemaphoreGives;
+extern BaseType_t xStubLockNesting;
+
+BaseType_t prvIsInFreeList( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/**
+ * @brief calls at the beginning of each test case
+ */
+void setUp( void )
+{
+    xNetworkBufferSemaphore = NULL;
+    uxStubSemaphoreTakes = 0U;
+    uxStubSemaphoreGives = 0U;
+    xStubLockNesting = 0;
+
+    TEST_ASSERT_EQUAL( pdPASS, xNetworkBuffersInitialise() );
+}
+
+/**
+ * @brief calls at the end of each test case
+ */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL( 0, xStubLockNesting );
+}
+
+/**
+ * @brief Every buffer is either in use, in the free list, or in the cache, and
+ *        the semaphore only counts the ones in the free list.
+ */
+static void prvCheckAccounting( UBaseType_t uxInUse )
+{
+    TEST_ASSERT_EQUAL( listCURRENT_LIST_LENGTH( &xFreeBuffersList ), uxStubSemaphoreCount );
+    TEST_ASSERT_EQUAL( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - uxInUse, uxGetNumberOfFreeNetworkBuffers() );
+    TEST_ASSERT_EQUAL( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS,
+                       uxInUse + listCURRENT_LIST_LENGTH( &xFreeBuffersList ) + listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+}
+
+/**
+ * @brief The caches start empty, all buffers are in the free list.
+ */
+void test_xNetworkBuffersInitialise_CachesEmpty( void )
+{
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS, uxStubSemaphoreCount );
+    prvCheckAccounting( 0U );
+}
+
+/**
+ * @brief An empty cache is refilled in one batch, after the buffer for the
+ *        caller was taken from the free list.
+ */
+void test_pxGetNetworkBufferWithDescriptor_Underflow_RefillsBatch( void )
+{
+    NetworkBufferDescriptor_t * pxBuffer;
+
+    pxBuffer = pxGetNetworkBufferWithDescriptor( 100U, 0U );
+
+    TEST_ASSERT_NOT_NULL( pxBuffer );
+    TEST_ASSERT_EQUAL( 100U, pxBuffer->xDataLength );
+    TEST_ASSERT_EQUAL( pdFALSE, prvIsInFreeList( pxBuffer ) );
+    TEST_ASSERT_EQUAL( 1 + TEST_BATCH_COUNT, uxStubSemaphoreTakes );
+    TEST_ASSERT_EQUAL( TEST_BATCH_COUNT, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+    prvCheckAccounting( 1U );
+}
+
+/**
+ * @brief A cache hit does not touch the semaphore nor the free list.
+ */
+void test_pxGetNetworkBufferWithDescriptor_Hit( void )
+{
+    NetworkBufferDescriptor_t * pxFirst;
+    NetworkBufferDescriptor_t * pxCached;
+    NetworkBufferDescriptor_t * pxBuffer;
+    UBaseType_t uxFreeLength;
+
+    pxFirst = pxGetNetworkBufferWithDescriptor( 100U, 0U );
+    TEST_ASSERT_NOT_NULL( pxFirst );
+
+    pxCached = ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xBufferCaches[ 0 ] ) );
+    uxStubSemaphoreTakes = 0U;
+    uxFreeLength = listCURRENT_LIST_LENGTH( &xFreeBuffersList );
+
+    pxBuffer = pxGetNetworkBufferWithDescriptor( 200U, 0U );
+
+    TEST_ASSERT_EQUAL_PTR( pxCached, pxBuffer );
+    TEST_ASSERT_EQUAL( 200U, pxBuffer->xDataLength );
+    TEST_ASSERT_EQUAL( 0U, uxStubSemaphoreTakes );
+    TEST_ASSERT_EQUAL( uxFreeLength, listCURRENT_LIST_LENGTH( &xFreeBuffersList ) );
+    TEST_ASSERT_EQUAL( TEST_BATCH_COUNT - 1, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+    prvCheckAccounting( 2U );
+}
+
+/**
+ * @brief A refill takes no more tokens than are available without waiting.
+ */
+void test_pxGetNetworkBufferWithDescriptor_Underflow_PartialRefill( void )
+{
+    NetworkBufferDescriptor_t * pxBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ];
+    UBaseType_t uxInUse = 0U;
+
+    /* Take buffers until only 2 are left in the free list. */
+    while( uxStubSemaphoreCount + listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) > 2U )
+    {
+        pxBuffers[ uxInUse ] = pxGetNetworkBufferWithDescriptor( 0U, 0U );
+        TEST_ASSERT_NOT_NULL( pxBuffers[ uxInUse ] );
+        uxInUse++;
+    }
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 2U, uxStubSemaphoreCount );
+
+    pxBuffers[ uxInUse ] = pxGetNetworkBufferWithDescriptor( 0U, 0U );
+    TEST_ASSERT_NOT_NULL( pxBuffers[ uxInUse ] );
+    uxInUse++;
+
+    /* One buffer for the caller, the only one left went into the cache. */
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0U, uxStubSemaphoreCount );
+    prvCheckAccounting( uxInUse );
+}
+
+/**
+ * @brief When all buffers are in use, the allocation fails.
+ */
+void test_pxGetNetworkBufferWithDescriptor_Exhausted( void )
+{
+    NetworkBufferDescriptor_t * pxBuffer;
+    UBaseType_t uxInUse;
+
+    for( uxInUse = 0U; uxInUse < ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS; uxInUse++ )
+    {
+        pxBuffer = pxGetNetworkBufferWithDescriptor( 0U, 0U );
+        TEST_ASSERT_NOT_NULL( pxBuffer );
+    }
+
+    pxBuffer = pxGetNetworkBufferWithDescriptor( 0U, 0U );
+
+    TEST_ASSERT_NULL( pxBuffer );
+    TEST_ASSERT_EQUAL( 0U, uxGetNumberOfFreeNetworkBuffers() );
+    TEST_ASSERT_EQUAL( 0U, uxGetMinimumFreeNetworkBuffers() );
+    prvCheckAccounting( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS );
+}
+
+/**
+ * @brief Released buffers go into the cache until it is full.  The next
+ *        release flushes the oldest half of the cache to the free list.
+ */
+void test_vReleaseNetworkBufferAndDescriptor_Overflow_FlushesBatch( void )
+{
+    /* Two refills of the cache, and the buffers that come with them. */
+    NetworkBufferDescriptor_t * pxBuffers[ 2 * ( 1 + TEST_BATCH_COUNT ) ];
+    UBaseType_t uxIndex;
+
+    for( uxIndex = 0U; uxIndex < 2U * ( 1U + TEST_BATCH_COUNT ); uxIndex++ )
+    {
+        pxBuffers[ uxIndex ] = pxGetNetworkBufferWithDescriptor( 0U, 0U );
+        TEST_ASSERT_NOT_NULL( pxBuffers[ uxIndex ] );
+    }
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+
+    for( uxIndex = 0U; uxIndex < ipconfigBUFFER_ALLOC_CACHE_SIZE; uxIndex++ )
+    {
+        vReleaseNetworkBufferAndDescriptor( pxBuffers[ uxIndex ] );
+    }
+
+    /* The cache is full now, nothing was given to the semaphore. */
+    TEST_ASSERT_EQUAL( ipconfigBUFFER_ALLOC_CACHE_SIZE, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0U, uxStubSemaphoreGives );
+    prvCheckAccounting( 2U );
+
+    vReleaseNetworkBufferAndDescriptor( pxBuffers[ ipconfigBUFFER_ALLOC_CACHE_SIZE ] );
+
+    TEST_ASSERT_EQUAL( TEST_BATCH_COUNT, uxStubSemaphoreGives );
+    TEST_ASSERT_EQUAL( ipconfigBUFFER_ALLOC_CACHE_SIZE - TEST_BATCH_COUNT + 1, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+
+    /* The oldest buffers were flushed, the last one is cached. */
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxBuffers[ 0 ]->xBufferListItem ) ) );
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &( xBufferCaches[ 0 ] ), &( pxBuffers[ ipconfigBUFFER_ALLOC_CACHE_SIZE ]->xBufferListItem ) ) );
+    prvCheckAccounting( 1U );
+}
+
+/**
+ * @brief A buffer that is released while the free list is empty bypasses the
+ *        cache, so that a task that waits for a buffer can get it.
+ */
+void test_vReleaseNetworkBufferAndDescriptor_NoFreeBuffers_Bypass( void )
+{
+    NetworkBufferDescriptor_t * pxBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ];
+    UBaseType_t uxIndex;
+
+    for( uxIndex = 0U; uxIndex < ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS; uxIndex++ )
+    {
+        pxBuffers[ uxIndex ] = pxGetNetworkBufferWithDescriptor( 0U, 0U );
+        TEST_ASSERT_NOT_NULL( pxBuffers[ uxIndex ] );
+    }
+
+    vReleaseNetworkBufferAndDescriptor( pxBuffers[ 0 ] );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxBuffers[ 0 ]->xBufferListItem ) ) );
+    TEST_ASSERT_EQUAL( 1U, uxStubSemaphoreCount );
+    prvCheckAccounting( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - 1U );
+
+    /* Now that the semaphore is non-zero, the next release is cached. */
+    vReleaseNetworkBufferAndDescriptor( pxBuffers[ 1 ] );
+
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &( xBufferCaches[ 0 ] ), &( pxBuffers[ 1 ]->xBufferListItem ) ) );
+    prvCheckAccounting( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - 2U );
+}
+
+/**
+ * @brief prvIsInFreeList() also finds the buffers in a cache, so that a
+ *        second release of a cached buffer is detected.
+ */
+void test_vReleaseNetworkBufferAndDescriptor_DoubleRelease( void )
+{
+    NetworkBufferDescriptor_t * pxBuffers[ 2 ];
+
+    pxBuffers[ 0 ] = pxGetNetworkBufferWithDescriptor( 0U, 0U );
+    pxBuffers[ 1 ] = pxGetNetworkBufferWithDescriptor( 0U, 0U );
+
+    vReleaseNetworkBufferAndDescriptor( pxBuffers[ 0 ] );
+
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &( xBufferCaches[ 0 ] ), &( pxBuffers[ 0 ]->xBufferListItem ) ) );
+    TEST_ASSERT_EQUAL( pdTRUE, prvIsInFreeList( pxBuffers[ 0 ] ) );
+    TEST_ASSERT_EQUAL( pdFALSE, prvIsInFreeList( pxBuffers[ 1 ] ) );
+    prvCheckAccounting( 1U );
+
+    vReleaseNetworkBufferAndDescriptor( pxBuffers[ 0 ] );
+
+    /* Neither the cache nor the semaphore has changed. */
+    TEST_ASSERT_EQUAL( 0U, uxStubSemaphoreGives );
+    prvCheckAccounting( 1U );
+}
+
+/**
+ * @brief A double release of a buffer that was flushed to the free list is
+ *        detected as well.
+ */
+void test_vReleaseNetworkBufferAndDescriptor_DoubleRelease_FreeList( void )
+{
+    NetworkBufferDescriptor_t * pxBuffer = &( xNetworkBuffers[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - 1 ] );
+
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxBuffer->xBufferListItem ) ) );
+
+    vReleaseNetworkBufferAndDescriptor( pxBuffer );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0U, uxStubSemaphoreGives );
+    prvCheckAccounting( 0U );
+}
+
+/**
+ * @brief Releasing several buffers at once goes through the cache as well.
+ */
+void test_vReleaseNetworkBuffersAndDescriptors_UsesCache( void )
+{
+    NetworkBufferDescriptor_t * pxBuffers[ 2 * ( 1 + TEST_BATCH_COUNT ) + 1 ];
+    UBaseType_t uxIndex;
+
+    for( uxIndex = 0U; uxIndex < 2U * ( 1U + TEST_BATCH_COUNT ); uxIndex++ )
+    {
+        pxBuffers[ uxIndex ] = pxGetNetworkBufferWithDescriptor( 0U, 0U );
+        TEST_ASSERT_NOT_NULL( pxBuffers[ uxIndex ] );
+    }
+
+    pxBuffers[ 2 * ( 1 + TEST_BATCH_COUNT ) ] = NULL;
+
+    vReleaseNetworkBuffersAndDescriptors( pxBuffers, 2 * ( 1 + TEST_BATCH_COUNT ) + 1 );
+
+    for( uxIndex = 0U; uxIndex < 2U * ( 1U + TEST_BATCH_COUNT ) + 1U; uxIndex++ )
+    {
+        TEST_ASSERT_NULL( pxBuffers[ uxIndex ] );
+    }
+
+    /* One batch was flushed when the cache overflowed. */
+    TEST_ASSERT_EQUAL( TEST_BATCH_COUNT, uxStubSemaphoreGives );
+    TEST_ASSERT_EQUAL( ipconfigBUFFER_ALLOC_CACHE_SIZE, listCURRENT_LIST_LENGTH( &( xBufferCaches[ 0 ] ) ) );
+    prvCheckAccounting( 0U );
+}
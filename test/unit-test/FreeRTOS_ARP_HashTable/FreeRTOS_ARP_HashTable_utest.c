@@ -0,0 +1,466 @@
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOSIPConfig.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_task.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_ARP_HashTable_list_macros.h"
+#include "FreeRTOS_ARP_HashTable_stubs.c"
+
+#include "FreeRTOS_ARP.h"
+
+#include "catch_assert.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+extern ARPCacheRow_t xARPCache[ ipconfigARP_CACHE_ENTRIES ];
+
+/* The XOR of the bytes of an IP-address selects its bucket, so these
+ * addresses all share one bucket.  The same goes for MAC-addresses that
+ * end in 0x01, 0x05 and 0x09. */
+#define TEST_IP_COLLIDE_1    ( 0x0A000001U )
+#define TEST_IP_COLLIDE_2    ( 0x0A000005U )
+#define TEST_IP_COLLIDE_3    ( 0x0A000009U )
+
+static NetworkEndPoint_t xEndPoint;
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xEndPoint, 0, sizeof( xEndPoint ) );
+
+    FreeRTOS_FindEndPointOnNetMask_IgnoreAndReturn( NULL );
+
+    /* Clears both the cache and its index. */
+    FreeRTOS_ClearARP( NULL );
+}
+
+/* ======================== Helper Functions ========================= */
+
+/**
+ * @brief Fill in a MAC-address that ends in the given byte.
+ */
+static void prvSetMAC( MACAddress_t * pxMACAddress,
+                       uint8_t ucLastByte )
+{
+    pxMACAddress->ucBytes[ 0 ] = 0x02U;
+    pxMACAddress->ucBytes[ 1 ] = 0x11U;
+    pxMACAddress->ucBytes[ 2 ] = 0x22U;
+    pxMACAddress->ucBytes[ 3 ] = 0x33U;
+    pxMACAddress->ucBytes[ 4 ] = 0x00U;
+    pxMACAddress->ucBytes[ 5 ] = ucLastByte;
+}
+
+/**
+ * @brief Store a resolved IP-address with a MAC-address that ends in the
+ *        given byte.
+ */
+static void prvAddEntry( uint32_t ulIPAddress,
+                         uint8_t ucLastByte,
+                         NetworkEndPoint_t * pxEndPoint )
+{
+    MACAddress_t xMACAddress;
+
+    prvSetMAC( &xMACAddress, ucLastByte );
+    vARPRefreshCacheEntry( &xMACAddress, ulIPAddress, pxEndPoint );
+}
+
+/**
+ * @brief Fill all rows of the cache with addresses 0x0A000011 onwards, the
+ *        first one being the least recently used.
+ */
+static void prvFillCache( void )
+{
+    BaseType_t x;
+
+    for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+    {
+        prvAddEntry( 0x0A000011U + ( uint32_t ) x, 0x11U + ( uint8_t ) x, &xEndPoint );
+    }
+}
+
+/**
+ * @brief Find the row that holds an IP-address by scanning the table.
+ *
+ * @return The index of the row, or -1 when there is none.
+ */
+static BaseType_t prvFindRow( uint32_t ulIPAddress )
+{
+    BaseType_t x;
+    BaseType_t xRow = -1;
+
+    for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+    {
+        if( xARPCache[ x ].ulIPAddress == ulIPAddress )
+        {
+            xRow = x;
+            break;
+        }
+    }
+
+    return xRow;
+}
+
+/**
+ * @brief Look up an IP-address by the MAC-address that ends in the given byte.
+ *
+ * @return The IP-address, or zero when the MAC-address is not found.
+ */
+static uint32_t prvLookupMAC( uint8_t ucLastByte )
+{
+    MACAddress_t xMACAddress;
+    uint32_t ulIPAddress = 0U;
+
+    prvSetMAC( &xMACAddress, ucLastByte );
+
+    if( eARPGetCacheEntryByMac( &xMACAddress, &ulIPAddress, NULL ) != eARPCacheHit )
+    {
+        ulIPAddress = 0U;
+    }
+
+    return ulIPAddress;
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief Stored entries are found by IP- and by MAC-address.
+ */
+void test_vARPRefreshCacheEntry_HashTable_AddAndFind( void )
+{
+    prvAddEntry( 0x0A000011U, 0x11U, &xEndPoint );
+    prvAddEntry( 0x0A000012U, 0x12U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000012U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000013U ) );
+
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000011U, prvLookupMAC( 0x11U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000012U, prvLookupMAC( 0x12U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, prvLookupMAC( 0x13U ) );
+
+    /* New entries take the rows that were never used, in order. */
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL( 1, prvFindRow( 0x0A000012U ) );
+}
+
+/**
+ * @brief Entries that share a bucket can each be found, and removing one of
+ *        them from the middle, the head or the tail of the chain leaves the
+ *        others in place.
+ */
+void test_ulARPRemoveCacheEntryByMac_HashTable_Collision( void )
+{
+    MACAddress_t xMACAddress;
+
+    prvAddEntry( TEST_IP_COLLIDE_1, 0x01U, &xEndPoint );
+    prvAddEntry( TEST_IP_COLLIDE_2, 0x05U, &xEndPoint );
+    prvAddEntry( TEST_IP_COLLIDE_3, 0x09U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( TEST_IP_COLLIDE_1 ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( TEST_IP_COLLIDE_2 ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( TEST_IP_COLLIDE_3 ) );
+    TEST_ASSERT_EQUAL_UINT32( TEST_IP_COLLIDE_1, prvLookupMAC( 0x01U ) );
+    TEST_ASSERT_EQUAL_UINT32( TEST_IP_COLLIDE_2, prvLookupMAC( 0x05U ) );
+    TEST_ASSERT_EQUAL_UINT32( TEST_IP_COLLIDE_3, prvLookupMAC( 0x09U ) );
+
+    /* The chains are ordered newest first: 3, 2, 1. */
+    prvSetMAC( &xMACAddress, 0x05U );
+    TEST_ASSERT_EQUAL_UINT32( TEST_IP_COLLIDE_2, ulARPRemoveCacheEntryByMac( &xMACAddress ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( TEST_IP_COLLIDE_2 ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( TEST_IP_COLLIDE_1 ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( TEST_IP_COLLIDE_3 ) );
+    TEST_ASSERT_EQUAL_UINT32( TEST_IP_COLLIDE_1, prvLookupMAC( 0x01U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, prvLookupMAC( 0x05U ) );
+
+    prvSetMAC( &xMACAddress, 0x09U );
+    TEST_ASSERT_EQUAL_UINT32( TEST_IP_COLLIDE_3, ulARPRemoveCacheEntryByMac( &xMACAddress ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( TEST_IP_COLLIDE_3 ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( TEST_IP_COLLIDE_1 ) );
+
+    prvSetMAC( &xMACAddress, 0x01U );
+    TEST_ASSERT_EQUAL_UINT32( TEST_IP_COLLIDE_1, ulARPRemoveCacheEntryByMac( &xMACAddress ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( TEST_IP_COLLIDE_1 ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, ulARPRemoveCacheEntryByMac( &xMACAddress ) );
+}
+
+/**
+ * @brief MAC-addresses that share a bucket are found when their IP-addresses
+ *        are in different buckets.
+ */
+void test_eARPGetCacheEntryByMac_HashTable_Collision( void )
+{
+    prvAddEntry( 0x0A000011U, 0x01U, &xEndPoint );
+    prvAddEntry( 0x0A000012U, 0x05U, &xEndPoint );
+    prvAddEntry( 0x0A000013U, 0x09U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000011U, prvLookupMAC( 0x01U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000012U, prvLookupMAC( 0x05U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000013U, prvLookupMAC( 0x09U ) );
+}
+
+/**
+ * @brief A full cache replaces the least recently used entry, and a refresh
+ *        makes an entry the most recently used one.
+ */
+void test_vARPRefreshCacheEntry_HashTable_EvictLeastRecentlyUsed( void )
+{
+    MACAddress_t xMACAddress;
+
+    prvFillCache();
+
+    /* Use the oldest entry, the second one becomes the least recently used. */
+    prvSetMAC( &xMACAddress, 0x11U );
+    vARPRefreshCacheEntryAge( &xMACAddress, 0x0A000011U );
+
+    prvAddEntry( 0x0A000021U, 0x21U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 1, prvFindRow( 0x0A000021U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000012U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, prvLookupMAC( 0x12U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000011U ) );
+
+    /* A refresh of an entry that is still in use also counts as a use. */
+    prvAddEntry( 0x0A000013U, 0x13U, &xEndPoint );
+
+    prvAddEntry( 0x0A000022U, 0x22U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 3, prvFindRow( 0x0A000022U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000014U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000013U ) );
+}
+
+/**
+ * @brief The entry to be replaced is chosen by its last use, not by its age.
+ */
+void test_vARPRefreshCacheEntry_HashTable_EvictIgnoresAge( void )
+{
+    BaseType_t xRow;
+
+    prvFillCache();
+
+    /* The second entry is about to expire, the first is still fresh. */
+    xRow = prvFindRow( 0x0A000012U );
+    xARPCache[ xRow ].ucAge = 1U;
+
+    prvAddEntry( 0x0A000021U, 0x21U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 0x0A000021U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000012U ) );
+}
+
+/**
+ * @brief A row released by a removal is used before any entry is replaced.
+ */
+void test_ulARPRemoveCacheEntryByMac_HashTable_ReuseReleasedRow( void )
+{
+    MACAddress_t xMACAddress;
+    BaseType_t x;
+
+    prvFillCache();
+
+    prvSetMAC( &xMACAddress, 0x13U );
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000013U, ulARPRemoveCacheEntryByMac( &xMACAddress ) );
+
+    prvAddEntry( 0x0A000021U, 0x21U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 2, prvFindRow( 0x0A000021U ) );
+
+    for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+    {
+        if( x != 2 )
+        {
+            TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000011U + ( uint32_t ) x ) );
+        }
+    }
+
+    /* Now that there is no free row, the least recently used one goes. */
+    prvAddEntry( 0x0A000022U, 0x22U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 0x0A000022U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000011U ) );
+}
+
+/**
+ * @brief Removing the most recently used entry keeps the order of the others.
+ */
+void test_ulARPRemoveCacheEntryByMac_HashTable_RemoveNewest( void )
+{
+    MACAddress_t xMACAddress;
+    BaseType_t x;
+
+    prvFillCache();
+
+    prvSetMAC( &xMACAddress, 0x16U );
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000016U, ulARPRemoveCacheEntryByMac( &xMACAddress ) );
+
+    prvAddEntry( 0x0A000021U, 0x21U, &xEndPoint );
+    TEST_ASSERT_EQUAL( 5, prvFindRow( 0x0A000021U ) );
+
+    /* The rows are replaced in the order in which they were used, ending with
+     * the row that was reused. */
+    for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+    {
+        prvAddEntry( 0x0A000031U + ( uint32_t ) x, 0x31U + ( uint8_t ) x, &xEndPoint );
+        TEST_ASSERT_EQUAL( x, prvFindRow( 0x0A000031U + ( uint32_t ) x ) );
+    }
+
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000021U ) );
+}
+
+/**
+ * @brief Entries that expire leave the index, and their rows are reused.
+ */
+void test_vARPAgeCache_HashTable_Expiry( void )
+{
+    BaseType_t xRow;
+
+    pxNetworkEndPoints = NULL;
+    xTaskGetTickCount_IgnoreAndReturn( 0U );
+
+    prvFillCache();
+
+    xRow = prvFindRow( 0x0A000014U );
+    xARPCache[ xRow ].ucAge = 1U;
+
+    vARPAgeCache();
+
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000014U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, prvLookupMAC( 0x14U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000011U ) );
+
+    prvAddEntry( 0x0A000021U, 0x21U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( xRow, prvFindRow( 0x0A000021U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000011U ) );
+}
+
+/**
+ * @brief Clearing the entries of one end-point releases only those rows.
+ */
+void test_FreeRTOS_ClearARP_HashTable_EndPoint( void )
+{
+    NetworkEndPoint_t xOtherEndPoint;
+    BaseType_t xRow;
+
+    memset( &xOtherEndPoint, 0, sizeof( xOtherEndPoint ) );
+
+    prvAddEntry( 0x0A000011U, 0x11U, &xEndPoint );
+    prvAddEntry( 0x0A000012U, 0x12U, &xOtherEndPoint );
+    prvAddEntry( 0x0A000013U, 0x13U, &xEndPoint );
+
+    xRow = prvFindRow( 0x0A000012U );
+
+    FreeRTOS_ClearARP( &xOtherEndPoint );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000012U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, prvLookupMAC( 0x12U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000013U ) );
+
+    prvAddEntry( 0x0A000021U, 0x21U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( xRow, prvFindRow( 0x0A000021U ) );
+}
+
+/**
+ * @brief Clearing the whole cache empties the index as well.
+ */
+void test_FreeRTOS_ClearARP_HashTable_All( void )
+{
+    prvFillCache();
+
+    FreeRTOS_ClearARP( NULL );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, prvLookupMAC( 0x11U ) );
+
+    prvAddEntry( 0x0A000021U, 0x21U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 0x0A000021U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000021U ) );
+}
+
+/**
+ * @brief A new MAC-address for a known IP-address re-indexes the same row.
+ */
+void test_vARPRefreshCacheEntry_HashTable_MACChanged( void )
+{
+    prvAddEntry( 0x0A000011U, 0x11U, &xEndPoint );
+    prvAddEntry( 0x0A000011U, 0x21U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, prvLookupMAC( 0x11U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000011U, prvLookupMAC( 0x21U ) );
+}
+
+/**
+ * @brief A known MAC-address with a new IP-address re-indexes the same row.
+ */
+void test_vARPRefreshCacheEntry_HashTable_IPChanged( void )
+{
+    prvAddEntry( 0x0A000011U, 0x11U, &xEndPoint );
+    prvAddEntry( 0x0A000021U, 0x11U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 0x0A000021U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000021U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000021U, prvLookupMAC( 0x11U ) );
+}
+
+/**
+ * @brief When the MAC- and the IP-address were found in different rows, the
+ *        row of the IP-address is released.
+ */
+void test_vARPRefreshCacheEntry_HashTable_IPAndMACInDifferentRows( void )
+{
+    prvAddEntry( 0x0A000011U, 0x11U, &xEndPoint );
+    prvAddEntry( 0x0A000012U, 0x12U, &xEndPoint );
+
+    /* The MAC-address of the first row moves to the IP-address of the second. */
+    prvAddEntry( 0x0A000012U, 0x11U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 0x0A000012U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000012U, prvLookupMAC( 0x11U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, prvLookupMAC( 0x12U ) );
+
+    /* The released row is used first. */
+    prvAddEntry( 0x0A000021U, 0x21U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 1, prvFindRow( 0x0A000021U ) );
+}
+
+/**
+ * @brief An outstanding request is indexed, but not valid until the reply
+ *        arrives in the same row.
+ */
+void test_vARPRefreshCacheEntry_HashTable_OutstandingRequest( void )
+{
+    vARPRefreshCacheEntry( NULL, 0x0A000011U, NULL );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xIsIPInARPCache( 0x0A000011U ) );
+
+    prvAddEntry( 0x0A000011U, 0x11U, &xEndPoint );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xIsIPInARPCache( 0x0A000011U ) );
+    TEST_ASSERT_EQUAL_UINT32( 0x0A000011U, prvLookupMAC( 0x11U ) );
+}
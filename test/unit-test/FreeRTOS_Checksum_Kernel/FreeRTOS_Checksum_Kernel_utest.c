@@ -0,0 +1,182 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* The largest number of words that the tests pass to the kernel. */
+#define MAX_WORDS    ( 2300U )
+
+static uint32_t ulBuffer[ MAX_WORDS ];
+
+/*
+ * @brief The reference: add all 16-bit words one by one, and fold the
+ *        carries at the end.
+ */
+static uint16_t prvReferenceSum( uint32_t ulSum,
+                                 const uint32_t * pulData,
+                                 size_t uxWordCount )
+{
+    const uint16_t * pusData = ( const uint16_t * ) pulData;
+    uint64_t ullSum = ( uint64_t ) ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+    size_t uxIndex;
+
+    for( uxIndex = 0U; uxIndex < ( uxWordCount * 2U ); uxIndex++ )
+    {
+        ullSum += pusData[ uxIndex ];
+    }
+
+    while( ( ullSum >> 16 ) != 0U )
+    {
+        ullSum = ( ullSum & 0xFFFFU ) + ( ullSum >> 16 );
+    }
+
+    return ( uint16_t ) ullSum;
+}
+
+/*
+ * @brief Fold the 32-bit result of the kernel into 16 bits.
+ */
+static uint16_t prvFold( uint32_t ulSum )
+{
+    uint32_t ulResult = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+
+    ulResult = ( ulResult & 0xFFFFU ) + ( ulResult >> 16 );
+
+    return ( uint16_t ) ulResult;
+}
+
+/*
+ * @brief In one's complement, 0x0000 and 0xFFFF are both zero.
+ */
+static void prvAssertSameSum( uint16_t usExpected,
+                              uint16_t usActual )
+{
+    if( usExpected == 0xFFFFU )
+    {
+        usExpected = 0U;
+    }
+
+    if( usActual == 0xFFFFU )
+    {
+        usActual = 0U;
+    }
+
+    TEST_ASSERT_EQUAL_HEX16( usExpected, usActual );
+}
+
+/*
+ * @brief An empty block returns the initial sum.
+ */
+void test_ulChecksumKernel_NoWords( void )
+{
+    uint32_t ulResult;
+
+    ulResult = ulChecksumKernel( 0x1234ABCDU, ulBuffer, 0U );
+
+    TEST_ASSERT_EQUAL_HEX32( 0x1234ABCDU, ulResult );
+}
+
+/*
+ * @brief All bits set: every addition produces a carry.
+ */
+void test_ulChecksumKernel_AllOnes( void )
+{
+    size_t uxCount;
+
+    ( void ) memset( ulBuffer, 0xFF, sizeof( ulBuffer ) );
+
+    for( uxCount = 1U; uxCount <= 67U; uxCount++ )
+    {
+        prvAssertSameSum( prvReferenceSum( 0xFFFFFFFFU, ulBuffer, uxCount ),
+                          prvFold( ulChecksumKernel( 0xFFFFFFFFU, ulBuffer, uxCount ) ) );
+    }
+}
+
+/*
+ * @brief Every word count up to a few vector iterations, so that all
+ *        combinations of the vector loop and the scalar tail are used.
+ */
+void test_ulChecksumKernel_AllShortLengths( void )
+{
+    size_t uxCount;
+    size_t uxIndex;
+
+    srand( 1U );
+
+    for( uxIndex = 0U; uxIndex < MAX_WORDS; uxIndex++ )
+    {
+        ulBuffer[ uxIndex ] = ( ( uint32_t ) rand() << 16 ) ^ ( uint32_t ) rand();
+    }
+
+    for( uxCount = 0U; uxCount <= 40U; uxCount++ )
+    {
+        prvAssertSameSum( prvReferenceSum( 0x0000BEEFU, ulBuffer, uxCount ),
+                          prvFold( ulChecksumKernel( 0x0000BEEFU, ulBuffer, uxCount ) ) );
+    }
+}
+
+/*
+ * @brief Random data and lengths up to a jumbo frame.
+ */
+void test_ulChecksumKernel_RandomData( void )
+{
+    size_t uxRound;
+    size_t uxIndex;
+    size_t uxCount;
+    uint32_t ulSum;
+
+    srand( 2U );
+
+    for( uxRound = 0U; uxRound < 500U; uxRound++ )
+    {
+        uxCount = ( size_t ) rand() % MAX_WORDS;
+        ulSum = ( ( uint32_t ) rand() << 16 ) ^ ( uint32_t ) rand();
+
+        for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+        {
+            /* Mix in many large words, to get a lot of carries. */
+            ulBuffer[ uxIndex ] = ( ( rand() & 1 ) != 0 ) ? 0xFFFFFFF0U | ( uint32_t ) ( rand() & 0xF ) :
+                                  ( ( uint32_t ) rand() << 16 ) ^ ( uint32_t ) rand();
+        }
+
+        prvAssertSameSum( prvReferenceSum( ulSum, ulBuffer, uxCount ),
+                          prvFold( ulChecksumKernel( ulSum, ulBuffer, uxCount ) ) );
+    }
+}
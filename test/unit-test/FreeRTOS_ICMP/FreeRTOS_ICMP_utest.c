@@ -123,12 +123,13 @@ void test_ProcessICMPPacket_EchoRequest( void )
 
     usGenerateChecksum_ExpectAnyArgsAndReturn( 0xAA );
 
-    usGenerateProtocolChecksum_ExpectAnyArgsAndReturn( 0 );
+    usIncrementalChecksum_ExpectAnyArgsAndReturn( 0x1234 );
 
     eResult = ProcessICMPPacket( pxNetworkBuffer );
 
     TEST_ASSERT_EQUAL( eReturnEthernetFrame, eResult );
     TEST_ASSERT_EQUAL( ( uint8_t ) ipICMP_ECHO_REPLY, pxICMPHeader->ucTypeOfMessage );
+    TEST_ASSERT_EQUAL( 0x1234, pxICMPHeader->usChecksum );
     TEST_ASSERT_EQUAL( pxIPHeader->ulSourceIPAddress, pxIPHeader->ulDestinationIPAddress );
     TEST_ASSERT_EQUAL( xEndPoint.ipv4_settings.ulIPAddress, pxIPHeader->ulSourceIPAddress );
     TEST_ASSERT_EQUAL( ipconfigICMP_TIME_TO_LIVE, pxIPHeader->ucTimeToLive );
@@ -0,0 +1,214 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_ICMP_ChecksumOffload_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_TCP_IP.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_DHCP.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_DNS.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+
+#include "FreeRTOS_ICMP.h"
+
+#include "FreeRTOS_ICMP_ChecksumOffload_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/* The checksum of the echo request. */
+#define TEST_REQUEST_CHECKSUM    ( 0xBEEFU )
+
+static NetworkBufferDescriptor_t xNetworkBuffer;
+static uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+static NetworkEndPoint_t xEndPoint;
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    ICMPPacket_t * pxICMPPacket = ( ICMPPacket_t * ) ucEthBuffer;
+
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    memset( &xEndPoint, 0, sizeof( xEndPoint ) );
+
+    pxNetworkEndPoints = &xEndPoint;
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthBuffer;
+    xNetworkBuffer.xDataLength = ipconfigTCP_MSS;
+    xNetworkBuffer.pxEndPoint = &xEndPoint;
+
+    pxICMPPacket->xICMPHeader.ucTypeOfMessage = ipICMP_ECHO_REQUEST;
+    pxICMPPacket->xICMPHeader.usChecksum = TEST_REQUEST_CHECKSUM;
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    pxNetworkEndPoints = NULL;
+}
+
+/* ============================== Test Helpers ============================== */
+
+/**
+ * @brief The type and code fields of an ICMP header as a 16-bit word in memory
+ *        order, the way prvProcessICMPEchoRequest() reads them.
+ */
+static uint16_t prvTypeAndCode( uint8_t ucTypeOfMessage )
+{
+    uint8_t ucBytes[ 2 ] = { ucTypeOfMessage, 0U };
+    uint16_t usWord;
+
+    memcpy( &usWord, ucBytes, sizeof( usWord ) );
+
+    return usWord;
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief The checksums of the request were checked by the IP-task, the
+ *        checksum of the reply is derived from the one of the request.
+ */
+void test_ProcessICMPPacket_EchoRequest_CheckedInSoftware( void )
+{
+    eFrameProcessingResult_t eResult;
+    ICMPPacket_t * pxICMPPacket = ( ICMPPacket_t * ) ucEthBuffer;
+
+    xIPTxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdTRUE );
+    uxIPHeaderSizePacket_ExpectAnyArgsAndReturn( ipSIZE_OF_IPv4_HEADER );
+    usGenerateChecksum_ExpectAnyArgsAndReturn( 0xAA );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdTRUE );
+    usIncrementalChecksum_ExpectAndReturn( TEST_REQUEST_CHECKSUM,
+                                           prvTypeAndCode( ipICMP_ECHO_REQUEST ),
+                                           prvTypeAndCode( ipICMP_ECHO_REPLY ),
+                                           0x1234 );
+
+    eResult = ProcessICMPPacket( &xNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( eReturnEthernetFrame, eResult );
+    TEST_ASSERT_EQUAL( ( uint8_t ) ipICMP_ECHO_REPLY, pxICMPPacket->xICMPHeader.ucTypeOfMessage );
+    TEST_ASSERT_EQUAL_HEX16( 0x1234, pxICMPPacket->xICMPHeader.usChecksum );
+}
+
+/**
+ * @brief The driver has marked the request as verified, the checksum of the
+ *        reply is derived from the one of the request.
+ */
+void test_ProcessICMPPacket_EchoRequest_VerifiedByDriver( void )
+{
+    eFrameProcessingResult_t eResult;
+    ICMPPacket_t * pxICMPPacket = ( ICMPPacket_t * ) ucEthBuffer;
+
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_VERIFIED;
+
+    xIPTxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdTRUE );
+    uxIPHeaderSizePacket_ExpectAnyArgsAndReturn( ipSIZE_OF_IPv4_HEADER );
+    usGenerateChecksum_ExpectAnyArgsAndReturn( 0xAA );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdFALSE );
+    usIncrementalChecksum_ExpectAndReturn( TEST_REQUEST_CHECKSUM,
+                                           prvTypeAndCode( ipICMP_ECHO_REQUEST ),
+                                           prvTypeAndCode( ipICMP_ECHO_REPLY ),
+                                           0x1234 );
+
+    eResult = ProcessICMPPacket( &xNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( eReturnEthernetFrame, eResult );
+    TEST_ASSERT_EQUAL_HEX16( 0x1234, pxICMPPacket->xICMPHeader.usChecksum );
+}
+
+/**
+ * @brief A request with a bad checksum, received on an interface that is said
+ *        to check checksums, but the buffer was not marked as verified. The
+ *        checksum of the reply must be calculated over the whole message, an
+ *        incremental update would repeat the error of the request.
+ */
+void test_ProcessICMPPacket_EchoRequest_NotVerifiedBadChecksum( void )
+{
+    eFrameProcessingResult_t eResult;
+    ICMPPacket_t * pxICMPPacket = ( ICMPPacket_t * ) ucEthBuffer;
+
+    xIPTxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdTRUE );
+    uxIPHeaderSizePacket_ExpectAnyArgsAndReturn( ipSIZE_OF_IPv4_HEADER );
+    usGenerateChecksum_ExpectAnyArgsAndReturn( 0xAA );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdFALSE );
+    usGenerateProtocolChecksum_ExpectAndReturn( ucEthBuffer, ipconfigTCP_MSS, pdTRUE, ipCORRECT_CRC );
+
+    eResult = ProcessICMPPacket( &xNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( eReturnEthernetFrame, eResult );
+    TEST_ASSERT_EQUAL( ( uint8_t ) ipICMP_ECHO_REPLY, pxICMPPacket->xICMPHeader.ucTypeOfMessage );
+}
+
+/**
+ * @brief The interface inserts the checksums of the reply, the fields are
+ *        cleared and no checksum is calculated.
+ */
+void test_ProcessICMPPacket_EchoRequest_TxOffload( void )
+{
+    eFrameProcessingResult_t eResult;
+    ICMPPacket_t * pxICMPPacket = ( ICMPPacket_t * ) ucEthBuffer;
+
+    pxICMPPacket->xIPHeader.usHeaderChecksum = 0x5555;
+
+    xIPTxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdFALSE );
+
+    eResult = ProcessICMPPacket( &xNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( eReturnEthernetFrame, eResult );
+    TEST_ASSERT_EQUAL_HEX16( 0U, pxICMPPacket->xIPHeader.usHeaderChecksum );
+    TEST_ASSERT_EQUAL_HEX16( 0U, pxICMPPacket->xICMPHeader.usChecksum );
+}
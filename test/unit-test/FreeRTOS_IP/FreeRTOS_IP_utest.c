@@ -607,6 +607,7 @@ void test_prvProcessIPEventsAndTimers_eNetworkRxEvent( void )
     pxNetworkBuffer->pucEthernetBuffer = ucEthBuffer;
     pxNetworkBuffer->xDataLength = sizeof( EthernetHeader_t ) - 1;
     pxNetworkBuffer->pxInterface = &xInterface;
+    pxNetworkBuffer->pxNextBuffer = NULL;
     pxEthernetHeader = ( EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer;
 
     xReceivedEvent.eEventType = eNetworkRxEvent;
@@ -642,6 +643,7 @@ void test_prvProcessIPEventsAndTimers_eNetworkTxEvent( void )
     pxNetworkBuffer->pucEthernetBuffer = ucEthBuffer;
     pxNetworkBuffer->xDataLength = sizeof( EthernetHeader_t ) - 1;
     pxNetworkBuffer->pxInterface = &xInterface;
+    pxNetworkBuffer->pxNextBuffer = NULL;
 
     NetworkInterfaceOutputFunction_Stub_Called = 0;
     pxNetworkBuffer->pxInterface->pfOutput = &NetworkInterfaceOutputFunction_Stub;
@@ -711,6 +713,7 @@ void test_prvProcessIPEventsAndTimers_eNetworkRxEvent_NullEndPoint( void )
     pxNetworkBuffer->pucEthernetBuffer = ucEthBuffer;
     pxNetworkBuffer->xDataLength = sizeof( EthernetHeader_t ) - 1;
     pxNetworkBuffer->pxInterface = &xInterface;
+    pxNetworkBuffer->pxNextBuffer = NULL;
     pxNetworkBuffer->pxEndPoint = NULL;
 
     NetworkInterfaceOutputFunction_Stub_Called = 0;
@@ -1097,7 +1100,7 @@ void test_prvProcessIPEventsAndTimers_Error( void )
 
     xNetworkDownEventPending = pdFALSE;
 
-    xReceivedEvent.eEventType = eSocketSetDeleteEvent + 1;
+    xReceivedEvent.eEventType = eNetworkPollEvent + 1;
 
     /* prvProcessIPEventsAndTimers */
     vCheckNetworkTimers_Expect();
@@ -1524,6 +1527,109 @@ void test_xSendEventStructToIPTask_IPTaskInit_eTCPTimerEventWithEventInQueue( vo
     TEST_ASSERT_EQUAL( pdPASS, xReturn );
 }
 
+/**
+ * @brief test_xSendRxBurstToIPTask_EmptyBurst
+ * To validate if xSendRxBurstToIPTask() passes without sending anything when
+ * the burst is empty.
+ */
+void test_xSendRxBurstToIPTask_EmptyBurst( void )
+{
+    BaseType_t xReturn;
+    NetworkBufferDescriptor_t * pxBurst[ 1 ] = { NULL };
+
+    xIPTaskInitialised = pdTRUE;
+
+    xReturn = xSendRxBurstToIPTask( pxBurst, 0U, 0U );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+}
+
+/**
+ * @brief test_xSendRxBurstToIPTask_AllDelivered
+ * To validate if xSendRxBurstToIPTask() chains the buffers of the burst and
+ * sends a single eNetworkRxEvent for them.
+ */
+void test_xSendRxBurstToIPTask_AllDelivered( void )
+{
+    BaseType_t xReturn;
+    NetworkBufferDescriptor_t xBuffers[ 3 ];
+    NetworkBufferDescriptor_t * pxBurst[ 3 ] = { &xBuffers[ 0 ], &xBuffers[ 1 ], &xBuffers[ 2 ] };
+
+    xIPTaskInitialised = pdTRUE;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    xQueueGenericSend_ExpectAnyArgsAndReturn( pdPASS );
+
+    xReturn = xSendRxBurstToIPTask( pxBurst, 3U, 0U );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL_PTR( &xBuffers[ 1 ], xBuffers[ 0 ].pxNextBuffer );
+    TEST_ASSERT_EQUAL_PTR( &xBuffers[ 2 ], xBuffers[ 1 ].pxNextBuffer );
+    TEST_ASSERT_NULL( xBuffers[ 2 ].pxNextBuffer );
+}
+
+/**
+ * @brief test_xSendRxBurstToIPTask_Empty
+ * To validate if xSendRxBurstToIPTask() does not send an event for an empty
+ * burst.
+ */
+void test_xSendRxBurstToIPTask_Empty( void )
+{
+    BaseType_t xReturn;
+    NetworkBufferDescriptor_t * pxBurst[ 1 ] = { NULL };
+
+    xIPTaskInitialised = pdTRUE;
+
+    xReturn = xSendRxBurstToIPTask( pxBurst, 0U, 0U );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+}
+
+/**
+ * @brief test_xSendRxBurstToIPTask_QueueFull
+ * To validate if xSendRxBurstToIPTask() releases the whole burst when the
+ * queue is full.
+ */
+void test_xSendRxBurstToIPTask_QueueFull( void )
+{
+    BaseType_t xReturn;
+    NetworkBufferDescriptor_t xBuffers[ 3 ];
+    NetworkBufferDescriptor_t * pxBurst[ 3 ] = { &xBuffers[ 0 ], &xBuffers[ 1 ], &xBuffers[ 2 ] };
+
+    xIPTaskInitialised = pdTRUE;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    xQueueGenericSend_ExpectAnyArgsAndReturn( pdFAIL );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xBuffers[ 0 ] );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xBuffers[ 1 ] );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xBuffers[ 2 ] );
+
+    xReturn = xSendRxBurstToIPTask( pxBurst, 3U, 0U );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xReturn );
+}
+
+/**
+ * @brief test_xSendRxBurstToIPTask_IPTaskNotReady
+ * To validate if xSendRxBurstToIPTask() releases the whole burst when the
+ * IP-task is not ready yet.
+ */
+void test_xSendRxBurstToIPTask_IPTaskNotReady( void )
+{
+    BaseType_t xReturn;
+    NetworkBufferDescriptor_t xBuffers[ 2 ];
+    NetworkBufferDescriptor_t * pxBurst[ 2 ] = { &xBuffers[ 0 ], &xBuffers[ 1 ] };
+
+    xIPTaskInitialised = pdFALSE;
+
+    vReleaseNetworkBufferAndDescriptor_Expect( &xBuffers[ 0 ] );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xBuffers[ 1 ] );
+
+    xReturn = xSendRxBurstToIPTask( pxBurst, 2U, 0U );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xReturn );
+}
+
 /**
  * @brief test_eConsiderFrameForProcessing_NullBufferDescriptor
  * eConsiderFrameForProcessing must return eReleaseBuffer with NULL input.
@@ -3157,7 +3263,6 @@ void test_prvProcessIPPacket_UDP_IPv6_HappyPath( void )
     pxUDPPacket->xUDPHeader.usLength = FreeRTOS_ntohs( FreeRTOS_htons( ipconfigTCP_MSS ) - sizeof( UDPPacket_IPv6_t ) );
 
     prvAllowIPPacketIPv6_ExpectAndReturn( pxIPHeader, pxNetworkBuffer, ipSIZE_OF_IPv6_HEADER, eProcessBuffer );
-    xGetExtensionOrder_ExpectAndReturn( ipPROTOCOL_UDP, 0U, 0 );
     xProcessReceivedUDPPacket_ExpectAnyArgsAndReturn( pdPASS );
 
     eResult = prvProcessIPPacket( ( IPPacket_t * ) pxIPPacket, pxNetworkBuffer );
@@ -3165,6 +3270,24 @@ void test_prvProcessIPPacket_UDP_IPv6_HappyPath( void )
     TEST_ASSERT_EQUAL( eFrameConsumed, eResult );
 }
 
+/**
+ * @brief Callback for eHandleIPv6ExtensionHeaders() that strips the extension
+ *        headers: the next header becomes UDP.
+ */
+static eFrameProcessingResult_t eHandleIPv6ExtensionHeaders_StripToUDP( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                                         BaseType_t xDoRemove,
+                                                                         int NumCalls )
+{
+    IPPacket_IPv6_t * pxIPPacket = ( IPPacket_IPv6_t * ) pxNetworkBuffer->pucEthernetBuffer;
+
+    ( void ) xDoRemove;
+    ( void ) NumCalls;
+
+    pxIPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_UDP;
+
+    return eProcessBuffer;
+}
+
 /**
  * @brief test_prvProcessIPPacket_UDP_IPv6_ExtensionHappyPath
  * To validate the flow to handle a UDPv6 packet with extension header successfully.
@@ -3201,14 +3324,14 @@ void test_prvProcessIPPacket_UDP_IPv6_ExtensionHappyPath( void )
     memcpy( pxIPHeader->xSourceAddress.ucBytes, xIPAddressTen.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
     memcpy( pxIPHeader->xDestinationAddress.ucBytes, xIPAddressFive.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
 
-    /* Set the protocol to be IPv6 UDP. */
-    pxIPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_UDP;
+    /* A hop-by-hop options header precedes the UDP header. */
+    pxIPPacket->xIPHeader.ucNextHeader = ipIPv6_EXT_HEADER_HOP_BY_HOP;
 
     pxUDPPacket->xUDPHeader.usLength = FreeRTOS_ntohs( FreeRTOS_htons( ipconfigTCP_MSS ) - sizeof( UDPPacket_IPv6_t ) );
 
     prvAllowIPPacketIPv6_ExpectAndReturn( pxIPHeader, pxNetworkBuffer, ipSIZE_OF_IPv6_HEADER, eProcessBuffer );
-    xGetExtensionOrder_ExpectAndReturn( ipPROTOCOL_UDP, 0U, 1 );
-    eHandleIPv6ExtensionHeaders_ExpectAndReturn( pxNetworkBuffer, pdTRUE, eProcessBuffer );
+    xGetExtensionOrder_ExpectAndReturn( ipIPv6_EXT_HEADER_HOP_BY_HOP, 0U, 1 );
+    eHandleIPv6ExtensionHeaders_Stub( eHandleIPv6ExtensionHeaders_StripToUDP );
     xProcessReceivedUDPPacket_ExpectAnyArgsAndReturn( pdPASS );
 
     eResult = prvProcessIPPacket( ( IPPacket_t * ) pxIPPacket, pxNetworkBuffer );
@@ -3251,14 +3374,14 @@ void test_prvProcessIPPacket_UDP_IPv6_ExtensionHandleFail( void )
     memcpy( pxIPHeader->xSourceAddress.ucBytes, xIPAddressTen.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
     memcpy( pxIPHeader->xDestinationAddress.ucBytes, xIPAddressFive.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
 
-    /* Set the protocol to be IPv6 UDP. */
+    /* An IPv6 packet with a hop-by-hop options header. */
     pxIPPacket->xEthernetHeader.usFrameType = ipIPv6_FRAME_TYPE;
-    pxIPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_UDP;
+    pxIPPacket->xIPHeader.ucNextHeader = ipIPv6_EXT_HEADER_HOP_BY_HOP;
 
     pxUDPPacket->xUDPHeader.usLength = FreeRTOS_ntohs( FreeRTOS_htons( ipconfigTCP_MSS ) - sizeof( UDPPacket_IPv6_t ) );
 
     prvAllowIPPacketIPv6_ExpectAndReturn( pxIPHeader, pxNetworkBuffer, ipSIZE_OF_IPv6_HEADER, eProcessBuffer );
-    xGetExtensionOrder_ExpectAndReturn( ipPROTOCOL_UDP, 0U, 1 );
+    xGetExtensionOrder_ExpectAndReturn( ipIPv6_EXT_HEADER_HOP_BY_HOP, 0U, 1 );
     eHandleIPv6ExtensionHeaders_ExpectAndReturn( pxNetworkBuffer, pdTRUE, eReleaseBuffer );
 
     eResult = prvProcessIPPacket( ( IPPacket_t * ) pxIPPacket, pxNetworkBuffer );
@@ -3305,7 +3428,6 @@ void test_prvProcessIPPacket_TCP_IPv6_HappyPath( void )
     pxIPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_TCP;
 
     prvAllowIPPacketIPv6_ExpectAndReturn( pxIPHeader, pxNetworkBuffer, ipSIZE_OF_IPv6_HEADER, eProcessBuffer );
-    xGetExtensionOrder_ExpectAndReturn( ipPROTOCOL_TCP, 0U, 0 );
     xCheckRequiresARPResolution_ExpectAndReturn( pxNetworkBuffer, pdFALSE );
     vNDRefreshCacheEntry_Ignore();
     xProcessReceivedTCPPacket_ExpectAnyArgsAndReturn( pdPASS );
@@ -3355,7 +3477,6 @@ void test_prvProcessIPPacket_TCP_IPv6_ARPResolution( void )
     pxIPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_TCP;
 
     prvAllowIPPacketIPv6_ExpectAndReturn( pxIPHeader, pxNetworkBuffer, ipSIZE_OF_IPv6_HEADER, eProcessBuffer );
-    xGetExtensionOrder_ExpectAndReturn( ipPROTOCOL_TCP, 0U, 0 );
     xCheckRequiresARPResolution_ExpectAndReturn( pxNetworkBuffer, pdTRUE );
 
     eResult = prvProcessIPPacket( ( IPPacket_t * ) pxIPPacket, pxNetworkBuffer );
@@ -3402,7 +3523,6 @@ void test_prvProcessIPPacket_ICMP_IPv6_HappyPath( void )
     pxIPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_ICMP_IPv6;
 
     prvAllowIPPacketIPv6_ExpectAndReturn( pxIPHeader, pxNetworkBuffer, ipSIZE_OF_IPv6_HEADER, eProcessBuffer );
-    xGetExtensionOrder_ExpectAndReturn( ipPROTOCOL_ICMP_IPv6, 0U, 0 );
     xCheckRequiresARPResolution_ExpectAndReturn( pxNetworkBuffer, pdFALSE );
     vNDRefreshCacheEntry_Ignore();
     prvProcessICMPMessage_IPv6_ExpectAnyArgsAndReturn( eReleaseBuffer );
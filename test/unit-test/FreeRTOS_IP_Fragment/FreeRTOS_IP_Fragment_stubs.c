@@ -0,0 +1,191 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include <unity.h>
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+/* =========================  EXTERN VARIABLES  ========================= */
+
+BaseType_t xBufferAllocFixedSize = pdFALSE;
+
+/** @brief The number of network buffers that the stubs can hand out. */
+#define STUB_BUFFER_COUNT     ( 6 )
+
+/** @brief The size of the network buffers handed out by the stubs. */
+#define STUB_BUFFER_SIZE      ( ipconfigIP_FRAGMENTATION_MAX_SIZE + ipSIZE_OF_ETH_HEADER )
+
+static uint8_t ucStubBuffers[ STUB_BUFFER_COUNT ][ STUB_BUFFER_SIZE ];
+static NetworkBufferDescriptor_t xStubDescriptors[ STUB_BUFFER_COUNT ];
+
+/** @brief The number of network buffers that were handed out. */
+static BaseType_t xBuffersTaken;
+
+/** @brief The number of network buffers that may still be handed out. */
+static BaseType_t xBuffersAvailable;
+
+/** @brief The number of network buffers that were released. */
+static BaseType_t xBuffersReleased;
+
+/** @brief The size requested for the last network buffer. */
+static size_t uxLastRequestedSize;
+
+/** @brief The datagrams that were passed to the IP-task. */
+static NetworkBufferDescriptor_t * pxDelivered[ STUB_BUFFER_COUNT ];
+static BaseType_t xDeliveredCount;
+
+/** @brief The fragments that were passed to the driver. */
+static NetworkBufferDescriptor_t * pxSent[ STUB_BUFFER_COUNT ];
+static BaseType_t xSentCount;
+
+/** @brief The value returned by xTaskGetTickCount(). */
+static TickType_t xTickCount;
+
+/** @brief The end-point returned by FreeRTOS_FindEndPointOnIP_IPv4(). */
+static NetworkEndPoint_t * pxEndPointOnIP;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static void vStubsReset( void )
+{
+    memset( xStubDescriptors, 0, sizeof( xStubDescriptors ) );
+    xBuffersTaken = 0;
+    xBuffersAvailable = STUB_BUFFER_COUNT;
+    xBuffersReleased = 0;
+    uxLastRequestedSize = 0U;
+    xDeliveredCount = 0;
+    xSentCount = 0;
+    xBufferAllocFixedSize = pdFALSE;
+}
+
+static NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor_Callback( size_t xRequestedSizeBytes,
+                                                                              TickType_t xBlockTimeTicks,
+                                                                              int cmock_num_calls )
+{
+    NetworkBufferDescriptor_t * pxReturn = NULL;
+
+    ( void ) xBlockTimeTicks;
+    ( void ) cmock_num_calls;
+
+    uxLastRequestedSize = xRequestedSizeBytes;
+    TEST_ASSERT_LESS_OR_EQUAL( STUB_BUFFER_SIZE, xRequestedSizeBytes );
+
+    if( xBuffersAvailable > 0 )
+    {
+        TEST_ASSERT_LESS_THAN( STUB_BUFFER_COUNT, xBuffersTaken );
+        pxReturn = &( xStubDescriptors[ xBuffersTaken ] );
+        pxReturn->pucEthernetBuffer = ucStubBuffers[ xBuffersTaken ];
+        pxReturn->xDataLength = xRequestedSizeBytes;
+        memset( pxReturn->pucEthernetBuffer, 0xA5, STUB_BUFFER_SIZE );
+        xBuffersTaken++;
+        xBuffersAvailable--;
+    }
+
+    return pxReturn;
+}
+
+static void vReleaseNetworkBufferAndDescriptor_Callback( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                         int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_NOT_NULL( pxNetworkBuffer );
+    xBuffersReleased++;
+}
+
+static BaseType_t xSendEventStructToIPTask_Callback( const IPStackEvent_t * pxEvent,
+                                                     TickType_t uxTimeout,
+                                                     int cmock_num_calls )
+{
+    ( void ) uxTimeout;
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_EQUAL( eNetworkRxEvent, pxEvent->eEventType );
+    TEST_ASSERT_LESS_THAN( STUB_BUFFER_COUNT, xDeliveredCount );
+    pxDelivered[ xDeliveredCount ] = ( NetworkBufferDescriptor_t * ) pxEvent->pvData;
+    xDeliveredCount++;
+
+    return pdPASS;
+}
+
+static BaseType_t xNetworkInterfaceOutput_Callback( struct xNetworkInterface * pxDescriptor,
+                                                    NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                    BaseType_t xReleaseAfterSend )
+{
+    ( void ) pxDescriptor;
+
+    TEST_ASSERT_EQUAL( pdTRUE, xReleaseAfterSend );
+    TEST_ASSERT_LESS_THAN( STUB_BUFFER_COUNT, xSentCount );
+    pxSent[ xSentCount ] = pxNetworkBuffer;
+    xSentCount++;
+
+    return pdPASS;
+}
+
+static TickType_t xTaskGetTickCount_Callback( int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return xTickCount;
+}
+
+static NetworkEndPoint_t * FreeRTOS_FindEndPointOnIP_IPv4_Callback( uint32_t ulIPAddress,
+                                                                     int cmock_num_calls )
+{
+    ( void ) ulIPAddress;
+    ( void ) cmock_num_calls;
+
+    return pxEndPointOnIP;
+}
+
+static size_t FreeRTOS_min_size_t_Callback( size_t a,
+                                            size_t b,
+                                            int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return ( a <= b ) ? a : b;
+}
+
+static size_t FreeRTOS_max_size_t_Callback( size_t a,
+                                            size_t b,
+                                            int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return ( a >= b ) ? a : b;
+}
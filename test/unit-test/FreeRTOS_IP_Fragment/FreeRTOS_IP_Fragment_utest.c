@@ -0,0 +1,745 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_queue.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IPv4.h"
+#include "mock_FreeRTOS_IPv6.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_IP_Fragment_stubs.c"
+#include "FreeRTOS_IP_Fragment.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/** @brief The sender and the receiver of the test datagrams. */
+#define TEST_SOURCE_ADDRESS         0x0A000001U
+#define TEST_DESTINATION_ADDRESS    0x0A000002U
+
+/** @brief The largest payload that can be reassembled in this configuration. */
+#define TEST_MAX_PAYLOAD            ( ipconfigIP_FRAGMENTATION_MAX_SIZE - ipSIZE_OF_IPv4_HEADER )
+
+/** @brief The size of the Ethernet and the IPv4 header. */
+#define TEST_IPv4_HEADERS           ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER )
+
+/** @brief The size of the Ethernet, the IPv6 and the fragment header. */
+#define TEST_IPv6_HEADERS           ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + sizeof( IPv6FragmentHeader_t ) )
+
+static NetworkInterface_t xInterface;
+static NetworkEndPoint_t xEndPoint;
+static NetworkBufferDescriptor_t xRxBuffer;
+static uint8_t ucRxBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+static NetworkBufferDescriptor_t xTxBuffer;
+static uint8_t ucTxBuffer[ ipconfigIP_FRAGMENTATION_MAX_SIZE + ipSIZE_OF_ETH_HEADER ];
+
+/* ============================ Test Helpers ============================ */
+
+/**
+ * @brief The value of byte 'uxIndex' in the payload of a test datagram.
+ */
+static uint8_t prvPayloadByte( uint16_t usIdentification,
+                               size_t uxIndex )
+{
+    return ( uint8_t ) ( ( uxIndex * 7U ) + usIdentification );
+}
+
+/**
+ * @brief Fill the receive buffer with an IPv4 fragment.
+ *
+ * @param[in] ulSource The source address, in host order.
+ * @param[in] ulDestination The destination address, in host order.
+ * @param[in] usIdentification The identification of the datagram.
+ * @param[in] uxOffset The offset of the fragment in the payload of the datagram.
+ * @param[in] uxLength The number of payload bytes in the fragment.
+ * @param[in] xMoreFragments pdFALSE for the last fragment.
+ */
+static void prvSetIPv4( uint32_t ulSource,
+                        uint32_t ulDestination,
+                        uint16_t usIdentification,
+                        size_t uxOffset,
+                        size_t uxLength,
+                        BaseType_t xMoreFragments )
+{
+    EthernetHeader_t * pxEthernetHeader = ( EthernetHeader_t * ) ucRxBuffer;
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucRxBuffer[ ipSIZE_OF_ETH_HEADER ] );
+    size_t uxIndex;
+
+    TEST_ASSERT_LESS_OR_EQUAL( sizeof( ucRxBuffer ) - TEST_IPv4_HEADERS, uxLength );
+
+    memset( ucRxBuffer, 0, sizeof( ucRxBuffer ) );
+    pxEthernetHeader->usFrameType = ipIPv4_FRAME_TYPE;
+    pxIPHeader->ucVersionHeaderLength = ipIPV4_VERSION_HEADER_LENGTH_MIN;
+    pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( ipSIZE_OF_IPv4_HEADER + uxLength ) );
+    pxIPHeader->usIdentification = FreeRTOS_htons( usIdentification );
+    pxIPHeader->usFragmentOffset = FreeRTOS_htons( ( uint16_t ) ( uxOffset / ipFRAGMENT_BLOCK_SIZE ) );
+
+    if( xMoreFragments != pdFALSE )
+    {
+        pxIPHeader->usFragmentOffset |= ipFRAGMENT_FLAGS_MORE_FRAGMENTS;
+    }
+
+    pxIPHeader->ucTimeToLive = 64U;
+    pxIPHeader->ucProtocol = ipPROTOCOL_UDP;
+    pxIPHeader->ulSourceIPAddress = FreeRTOS_htonl( ulSource );
+    pxIPHeader->ulDestinationIPAddress = FreeRTOS_htonl( ulDestination );
+
+    for( uxIndex = 0U; uxIndex < uxLength; uxIndex++ )
+    {
+        ucRxBuffer[ TEST_IPv4_HEADERS + uxIndex ] = prvPayloadByte( usIdentification, uxOffset + uxIndex );
+    }
+
+    xRxBuffer.pucEthernetBuffer = ucRxBuffer;
+    xRxBuffer.xDataLength = TEST_IPv4_HEADERS + uxLength;
+    xRxBuffer.pxInterface = &( xInterface );
+    xRxBuffer.pxEndPoint = &( xEndPoint );
+}
+
+/**
+ * @brief Let the IP-task receive an IPv4 fragment, see prvSetIPv4().
+ */
+static void prvReceiveIPv4From( uint32_t ulSource,
+                                uint32_t ulDestination,
+                                uint16_t usIdentification,
+                                size_t uxOffset,
+                                size_t uxLength,
+                                BaseType_t xMoreFragments )
+{
+    prvSetIPv4( ulSource, ulDestination, usIdentification, uxOffset, uxLength, xMoreFragments );
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eIPv4Reassemble( &( xRxBuffer ), ipSIZE_OF_IPv4_HEADER ) );
+}
+
+static void prvReceiveIPv4( uint16_t usIdentification,
+                            size_t uxOffset,
+                            size_t uxLength,
+                            BaseType_t xMoreFragments )
+{
+    prvReceiveIPv4From( TEST_SOURCE_ADDRESS, TEST_DESTINATION_ADDRESS, usIdentification, uxOffset, uxLength, xMoreFragments );
+}
+
+/**
+ * @brief Check the one datagram that was passed to the IP-task.
+ */
+static void prvAssertDeliveredIPv4( uint16_t usIdentification,
+                                    size_t uxPayloadLength )
+{
+    NetworkBufferDescriptor_t * pxBuffer;
+    IPHeader_t * pxIPHeader;
+    size_t uxIndex;
+
+    TEST_ASSERT_EQUAL( 1, xDeliveredCount );
+    pxBuffer = pxDelivered[ 0 ];
+    pxIPHeader = ( IPHeader_t * ) &( pxBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] );
+
+    TEST_ASSERT_EQUAL( TEST_IPv4_HEADERS + uxPayloadLength, pxBuffer->xDataLength );
+    TEST_ASSERT_EQUAL_PTR( &( xInterface ), pxBuffer->pxInterface );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoint ), pxBuffer->pxEndPoint );
+    TEST_ASSERT_EQUAL( ipIPV4_VERSION_HEADER_LENGTH_MIN, pxIPHeader->ucVersionHeaderLength );
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + uxPayloadLength, FreeRTOS_ntohs( pxIPHeader->usLength ) );
+    TEST_ASSERT_EQUAL( 0U, pxIPHeader->usFragmentOffset );
+    TEST_ASSERT_EQUAL( ipPROTOCOL_UDP, pxIPHeader->ucProtocol );
+    TEST_ASSERT_EQUAL( FreeRTOS_htonl( TEST_SOURCE_ADDRESS ), pxIPHeader->ulSourceIPAddress );
+    TEST_ASSERT_EQUAL( FreeRTOS_htons( usIdentification ), pxIPHeader->usIdentification );
+
+    for( uxIndex = 0U; uxIndex < uxPayloadLength; uxIndex++ )
+    {
+        TEST_ASSERT_EQUAL_UINT8( prvPayloadByte( usIdentification, uxIndex ), pxBuffer->pucEthernetBuffer[ TEST_IPv4_HEADERS + uxIndex ] );
+    }
+}
+
+/**
+ * @brief Fill the receive buffer with an IPv6 packet with a fragment header,
+ *        sent from fe80::1 to fe80::2.
+ */
+static void prvSetIPv6( uint16_t usIdentification,
+                        size_t uxOffset,
+                        size_t uxLength,
+                        BaseType_t xMoreFragments )
+{
+    EthernetHeader_t * pxEthernetHeader = ( EthernetHeader_t * ) ucRxBuffer;
+    IPHeader_IPv6_t * pxIPHeader_IPv6 = ( IPHeader_IPv6_t * ) &( ucRxBuffer[ ipSIZE_OF_ETH_HEADER ] );
+    IPv6FragmentHeader_t * pxFragmentHeader = ( IPv6FragmentHeader_t * ) &( ucRxBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ] );
+    uint16_t usOffset = ( uint16_t ) uxOffset;
+    size_t uxIndex;
+
+    memset( ucRxBuffer, 0, sizeof( ucRxBuffer ) );
+    pxEthernetHeader->usFrameType = ipIPv6_FRAME_TYPE;
+    pxIPHeader_IPv6->ucVersionTrafficClass = 0x60U;
+    pxIPHeader_IPv6->usPayloadLength = FreeRTOS_htons( ( uint16_t ) ( sizeof( IPv6FragmentHeader_t ) + uxLength ) );
+    pxIPHeader_IPv6->ucNextHeader = ipIPv6_EXT_HEADER_FRAGMENT_HEADER;
+    pxIPHeader_IPv6->ucHopLimit = 64U;
+    pxIPHeader_IPv6->xSourceAddress.ucBytes[ 0 ] = 0xfeU;
+    pxIPHeader_IPv6->xSourceAddress.ucBytes[ 1 ] = 0x80U;
+    pxIPHeader_IPv6->xSourceAddress.ucBytes[ 15 ] = 0x01U;
+    pxIPHeader_IPv6->xDestinationAddress.ucBytes[ 0 ] = 0xfeU;
+    pxIPHeader_IPv6->xDestinationAddress.ucBytes[ 1 ] = 0x80U;
+    pxIPHeader_IPv6->xDestinationAddress.ucBytes[ 15 ] = 0x02U;
+
+    if( xMoreFragments != pdFALSE )
+    {
+        usOffset |= ipIPv6_FRAGMENT_MORE;
+    }
+
+    pxFragmentHeader->ucNextHeader = ipPROTOCOL_UDP;
+    pxFragmentHeader->usFragmentOffset = FreeRTOS_htons( usOffset );
+    /* Stored like the identification of an IPv4 fragment with the same number. */
+    pxFragmentHeader->ulIdentification = ( uint32_t ) FreeRTOS_htons( usIdentification );
+
+    for( uxIndex = 0U; uxIndex < uxLength; uxIndex++ )
+    {
+        ucRxBuffer[ TEST_IPv6_HEADERS + uxIndex ] = prvPayloadByte( usIdentification, uxOffset + uxIndex );
+    }
+
+    xRxBuffer.pucEthernetBuffer = ucRxBuffer;
+    xRxBuffer.xDataLength = TEST_IPv6_HEADERS + uxLength;
+    xRxBuffer.pxInterface = &( xInterface );
+    xRxBuffer.pxEndPoint = &( xEndPoint );
+}
+
+/**
+ * @brief Let the IP-task receive an IPv6 fragment, see prvSetIPv6().
+ */
+static void prvReceiveIPv6( uint16_t usIdentification,
+                            size_t uxOffset,
+                            size_t uxLength,
+                            BaseType_t xMoreFragments )
+{
+    prvSetIPv6( usIdentification, uxOffset, uxLength, xMoreFragments );
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eIPv6Reassemble( &( xRxBuffer ) ) );
+}
+
+/**
+ * @brief Prepare an outgoing IPv4 datagram with a payload of 'uxLength' bytes.
+ */
+static void prvSetDatagramIPv4( size_t uxLength,
+                                uint16_t usFragmentOffset )
+{
+    EthernetHeader_t * pxEthernetHeader = ( EthernetHeader_t * ) ucTxBuffer;
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucTxBuffer[ ipSIZE_OF_ETH_HEADER ] );
+    size_t uxIndex;
+
+    memset( ucTxBuffer, 0, sizeof( ucTxBuffer ) );
+    pxEthernetHeader->usFrameType = ipIPv4_FRAME_TYPE;
+    pxIPHeader->ucVersionHeaderLength = ipIPV4_VERSION_HEADER_LENGTH_MIN;
+    pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( ipSIZE_OF_IPv4_HEADER + uxLength ) );
+    pxIPHeader->usIdentification = FreeRTOS_htons( 0x1234U );
+    pxIPHeader->usFragmentOffset = usFragmentOffset;
+    pxIPHeader->ucProtocol = ipPROTOCOL_UDP;
+
+    for( uxIndex = 0U; uxIndex < uxLength; uxIndex++ )
+    {
+        ucTxBuffer[ TEST_IPv4_HEADERS + uxIndex ] = prvPayloadByte( 0x1234U, uxIndex );
+    }
+
+    xTxBuffer.pucEthernetBuffer = ucTxBuffer;
+    xTxBuffer.xDataLength = TEST_IPv4_HEADERS + uxLength;
+    xTxBuffer.pxInterface = &( xInterface );
+    xTxBuffer.pxEndPoint = &( xEndPoint );
+}
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    vStubsReset();
+
+    memset( &( xInterface ), 0, sizeof( xInterface ) );
+    memset( &( xEndPoint ), 0, sizeof( xEndPoint ) );
+    memset( &( xRxBuffer ), 0, sizeof( xRxBuffer ) );
+    memset( &( xTxBuffer ), 0, sizeof( xTxBuffer ) );
+    xInterface.pfOutput = xNetworkInterfaceOutput_Callback;
+
+    pxGetNetworkBufferWithDescriptor_Stub( pxGetNetworkBufferWithDescriptor_Callback );
+    vReleaseNetworkBufferAndDescriptor_Stub( vReleaseNetworkBufferAndDescriptor_Callback );
+    xSendEventStructToIPTask_Stub( xSendEventStructToIPTask_Callback );
+    xTaskGetTickCount_Stub( xTaskGetTickCount_Callback );
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_size_t_Callback );
+    FreeRTOS_max_size_t_Stub( FreeRTOS_max_size_t_Callback );
+    usGenerateChecksum_IgnoreAndReturn( ipCORRECT_CRC );
+    usGenerateProtocolChecksum_IgnoreAndReturn( ipCORRECT_CRC );
+    xApplicationGetRandomNumber_IgnoreAndReturn( pdTRUE );
+    pxEndPointOnIP = &( xEndPoint );
+    FreeRTOS_FindEndPointOnIP_IPv4_Stub( FreeRTOS_FindEndPointOnIP_IPv4_Callback );
+    FreeRTOS_FindEndPointOnIP_IPv6_IgnoreAndReturn( &( xEndPoint ) );
+    xIsIPv4Multicast_IgnoreAndReturn( pdFALSE );
+    xIsIPv6AllowedMulticast_IgnoreAndReturn( pdFALSE );
+
+    /* Let the datagrams of the previous test expire. */
+    xTickCount += pdMS_TO_TICKS( ipconfigIP_REASSEMBLY_TIMEOUT_MS );
+    vIPReassemblyCheckTimeout();
+    vStubsReset();
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief Fragments that arrive in order are passed to the IP-task as one
+ *        datagram.
+ */
+void test_eIPv4Reassemble_InOrder( void )
+{
+    prvReceiveIPv4( 1U, 0U, 16U, pdTRUE );
+    prvReceiveIPv4( 1U, 16U, 16U, pdTRUE );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+    prvReceiveIPv4( 1U, 32U, 10U, pdFALSE );
+
+    prvAssertDeliveredIPv4( 1U, 42U );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+    TEST_ASSERT_EQUAL( TEST_IPv4_HEADERS + TEST_MAX_PAYLOAD, uxLastRequestedSize );
+    TEST_ASSERT_EQUAL( 0, xBuffersReleased );
+}
+
+/**
+ * @brief The headers of the datagram are taken from the first fragment, also
+ *        when it arrives last.
+ */
+void test_eIPv4Reassemble_OutOfOrder( void )
+{
+    prvReceiveIPv4( 2U, 32U, 10U, pdFALSE );
+    prvReceiveIPv4( 2U, 16U, 16U, pdTRUE );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+    prvReceiveIPv4( 2U, 0U, 16U, pdTRUE );
+
+    prvAssertDeliveredIPv4( 2U, 42U );
+    TEST_ASSERT_EQUAL( 0, xBuffersReleased );
+}
+
+/**
+ * @brief A fragment that is received twice is ignored.
+ */
+void test_eIPv4Reassemble_Duplicate( void )
+{
+    prvReceiveIPv4( 3U, 0U, 16U, pdTRUE );
+    prvReceiveIPv4( 3U, 0U, 16U, pdTRUE );
+    prvReceiveIPv4( 3U, 16U, 8U, pdFALSE );
+
+    prvAssertDeliveredIPv4( 3U, 24U );
+    TEST_ASSERT_EQUAL( 0, xBuffersReleased );
+}
+
+/**
+ * @brief Overlapping fragments drop the whole datagram.
+ */
+void test_eIPv4Reassemble_Overlap( void )
+{
+    prvReceiveIPv4( 4U, 0U, 16U, pdTRUE );
+    prvReceiveIPv4( 4U, 8U, 16U, pdTRUE );
+
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+
+    /* The remaining fragments start a new datagram, which stays incomplete. */
+    prvReceiveIPv4( 4U, 24U, 8U, pdFALSE );
+    TEST_ASSERT_EQUAL( 2, xBuffersTaken );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief A fragment that covers a received fragment and more data is an
+ *        overlap, not a duplicate.
+ */
+void test_eIPv4Reassemble_OverlapLarger( void )
+{
+    prvReceiveIPv4( 5U, 8U, 8U, pdTRUE );
+    prvReceiveIPv4( 5U, 0U, 24U, pdTRUE );
+
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief Data after the end of the last fragment drops the datagram.
+ */
+void test_eIPv4Reassemble_BeyondLastFragment( void )
+{
+    prvReceiveIPv4( 6U, 16U, 8U, pdFALSE );
+    prvReceiveIPv4( 6U, 24U, 8U, pdTRUE );
+
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief A second last fragment drops the datagram.
+ */
+void test_eIPv4Reassemble_TwoLastFragments( void )
+{
+    prvReceiveIPv4( 7U, 16U, 8U, pdFALSE );
+    prvReceiveIPv4( 7U, 32U, 8U, pdFALSE );
+
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief A last fragment that ends before data that was received drops the
+ *        datagram.
+ */
+void test_eIPv4Reassemble_LastFragmentTooShort( void )
+{
+    prvReceiveIPv4( 8U, 32U, 16U, pdTRUE );
+    prvReceiveIPv4( 8U, 16U, 8U, pdFALSE );
+
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief All but the last fragment must carry a non-zero multiple of 8 bytes.
+ */
+void test_eIPv4Reassemble_MisalignedLength( void )
+{
+    prvReceiveIPv4( 9U, 0U, 12U, pdTRUE );
+    prvReceiveIPv4( 9U, 16U, 0U, pdTRUE );
+
+    TEST_ASSERT_EQUAL( 0, xBuffersTaken );
+
+    /* The last fragment may have any length. */
+    prvReceiveIPv4( 9U, 16U, 5U, pdFALSE );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+}
+
+/**
+ * @brief An incomplete datagram is dropped after the reassembly timeout.
+ */
+void test_vIPReassemblyCheckTimeout_Expires( void )
+{
+    TickType_t xStart = xTickCount;
+
+    prvReceiveIPv4( 10U, 0U, 16U, pdTRUE );
+
+    xTickCount = xStart + pdMS_TO_TICKS( ipconfigIP_REASSEMBLY_TIMEOUT_MS ) - 1U;
+    vIPReassemblyCheckTimeout();
+    TEST_ASSERT_EQUAL( 0, xBuffersReleased );
+
+    xTickCount = xStart + pdMS_TO_TICKS( ipconfigIP_REASSEMBLY_TIMEOUT_MS );
+    vIPReassemblyCheckTimeout();
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+
+    /* The last fragment starts a new datagram. */
+    prvReceiveIPv4( 10U, 16U, 8U, pdFALSE );
+    TEST_ASSERT_EQUAL( 2, xBuffersTaken );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief A datagram that completes just before the timeout is delivered.
+ */
+void test_eIPv4Reassemble_CompletesBeforeTimeout( void )
+{
+    TickType_t xStart = xTickCount;
+
+    prvReceiveIPv4( 11U, 0U, 16U, pdTRUE );
+
+    xTickCount = xStart + pdMS_TO_TICKS( ipconfigIP_REASSEMBLY_TIMEOUT_MS ) - 1U;
+    prvReceiveIPv4( 11U, 16U, 8U, pdFALSE );
+
+    prvAssertDeliveredIPv4( 11U, 24U );
+    TEST_ASSERT_EQUAL( 0, xBuffersReleased );
+}
+
+/**
+ * @brief Expired datagrams are also dropped when a fragment is received.
+ */
+void test_eIPv4Reassemble_TimeoutOnReceive( void )
+{
+    TickType_t xStart = xTickCount;
+
+    prvReceiveIPv4( 12U, 0U, 16U, pdTRUE );
+
+    xTickCount = xStart + pdMS_TO_TICKS( ipconfigIP_REASSEMBLY_TIMEOUT_MS );
+    prvReceiveIPv4( 12U, 16U, 8U, pdFALSE );
+
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+    TEST_ASSERT_EQUAL( 2, xBuffersTaken );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief No more than ipconfigIP_REASSEMBLY_MAX_DATAGRAMS datagrams are
+ *        reassembled at the same time.
+ */
+void test_eIPv4Reassemble_TooManyDatagrams( void )
+{
+    prvReceiveIPv4( 13U, 0U, 16U, pdTRUE );
+    prvReceiveIPv4( 14U, 0U, 16U, pdTRUE );
+    prvReceiveIPv4( 15U, 0U, 16U, pdTRUE );
+
+    TEST_ASSERT_EQUAL( ipconfigIP_REASSEMBLY_MAX_DATAGRAMS, xBuffersTaken );
+
+    /* Completing a datagram frees its entry. */
+    prvReceiveIPv4( 13U, 16U, 8U, pdFALSE );
+    prvAssertDeliveredIPv4( 13U, 24U );
+
+    prvReceiveIPv4( 15U, 0U, 16U, pdTRUE );
+    TEST_ASSERT_EQUAL( ipconfigIP_REASSEMBLY_MAX_DATAGRAMS + 1, xBuffersTaken );
+}
+
+/**
+ * @brief Fragments with the same identification from another host belong to
+ *        another datagram.
+ */
+void test_eIPv4Reassemble_OtherSource( void )
+{
+    prvReceiveIPv4( 16U, 0U, 16U, pdTRUE );
+    prvReceiveIPv4From( TEST_SOURCE_ADDRESS + 1U, TEST_DESTINATION_ADDRESS, 16U, 16U, 8U, pdFALSE );
+
+    TEST_ASSERT_EQUAL( 2, xBuffersTaken );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief A datagram may fill the network buffer, but not more.
+ */
+void test_eIPv4Reassemble_MaxSize( void )
+{
+    size_t uxLastOffset = TEST_MAX_PAYLOAD & ~( ( size_t ) ipFRAGMENT_BLOCK_SIZE - 1U );
+
+    prvReceiveIPv4( 17U, uxLastOffset, TEST_MAX_PAYLOAD - uxLastOffset, pdFALSE );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+    TEST_ASSERT_EQUAL( 0, xBuffersReleased );
+
+    prvReceiveIPv4( 18U, uxLastOffset, ( TEST_MAX_PAYLOAD - uxLastOffset ) + 1U, pdFALSE );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+}
+
+/**
+ * @brief A fragment that makes a datagram too large drops it.
+ */
+void test_eIPv4Reassemble_TooLarge( void )
+{
+    prvReceiveIPv4( 19U, 0U, 16U, pdTRUE );
+    prvReceiveIPv4( 19U, TEST_MAX_PAYLOAD & ~( ( size_t ) ipFRAGMENT_BLOCK_SIZE - 1U ), 16U, pdFALSE );
+
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+}
+
+/**
+ * @brief Fixed-size network buffers limit a datagram to the MTU.
+ */
+void test_eIPv4Reassemble_FixedSizeBuffers( void )
+{
+    size_t uxMaxPayload = ipconfigNETWORK_MTU - ipSIZE_OF_IPv4_HEADER;
+
+    xBufferAllocFixedSize = pdTRUE;
+
+    prvReceiveIPv4( 20U, uxMaxPayload - 8U, 8U, pdFALSE );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+    TEST_ASSERT_EQUAL( TEST_IPv4_HEADERS + uxMaxPayload, uxLastRequestedSize );
+
+    prvReceiveIPv4( 21U, uxMaxPayload, 8U, pdFALSE );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+}
+
+/**
+ * @brief A fragment is dropped when no network buffer is available.
+ */
+void test_eIPv4Reassemble_NoBuffer( void )
+{
+    xBuffersAvailable = 0;
+    prvReceiveIPv4( 22U, 0U, 16U, pdTRUE );
+
+    xBuffersAvailable = 1;
+    prvReceiveIPv4( 22U, 16U, 8U, pdFALSE );
+
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief Fragments with a bad header checksum or a bad length are dropped.
+ */
+void test_eIPv4Reassemble_Malformed( void )
+{
+    usGenerateChecksum_StopIgnore();
+    usGenerateChecksum_ExpectAnyArgsAndReturn( 0U );
+    prvReceiveIPv4( 23U, 0U, 16U, pdTRUE );
+    TEST_ASSERT_EQUAL( 0, xBuffersTaken );
+
+    usGenerateChecksum_IgnoreAndReturn( ipCORRECT_CRC );
+    prvReceiveIPv4( 23U, 0U, 16U, pdTRUE );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+
+    /* The IP length is larger than the packet. */
+    prvSetIPv4( TEST_SOURCE_ADDRESS, TEST_DESTINATION_ADDRESS, 24U, 0U, 16U, pdTRUE );
+    xRxBuffer.xDataLength--;
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eIPv4Reassemble( &( xRxBuffer ), ipSIZE_OF_IPv4_HEADER ) );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+}
+
+/**
+ * @brief Fragments of datagrams for another host are not reassembled, those
+ *        sent to a broadcast address are.
+ */
+void test_eIPv4Reassemble_NotForThisHost( void )
+{
+    pxEndPointOnIP = NULL;
+
+    prvReceiveIPv4( 25U, 0U, 16U, pdTRUE );
+    TEST_ASSERT_EQUAL( 0, xBuffersTaken );
+
+    prvReceiveIPv4From( TEST_SOURCE_ADDRESS, 0x0A0000FFU, 25U, 0U, 16U, pdTRUE );
+    TEST_ASSERT_EQUAL( 1, xBuffersTaken );
+}
+
+/**
+ * @brief IPv6 fragments are reassembled, and the fragment header is removed.
+ */
+void test_eIPv6Reassemble_InOrder( void )
+{
+    NetworkBufferDescriptor_t * pxBuffer;
+    IPHeader_IPv6_t * pxIPHeader_IPv6;
+    size_t uxIndex;
+
+    prvReceiveIPv6( 26U, 16U, 6U, pdFALSE );
+    prvReceiveIPv6( 26U, 0U, 16U, pdTRUE );
+
+    TEST_ASSERT_EQUAL( 1, xDeliveredCount );
+    pxBuffer = pxDelivered[ 0 ];
+    pxIPHeader_IPv6 = ( IPHeader_IPv6_t * ) &( pxBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] );
+
+    TEST_ASSERT_EQUAL( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + 22U, pxBuffer->xDataLength );
+    TEST_ASSERT_EQUAL( ipPROTOCOL_UDP, pxIPHeader_IPv6->ucNextHeader );
+    TEST_ASSERT_EQUAL( 22U, FreeRTOS_ntohs( pxIPHeader_IPv6->usPayloadLength ) );
+
+    for( uxIndex = 0U; uxIndex < 22U; uxIndex++ )
+    {
+        TEST_ASSERT_EQUAL_UINT8( prvPayloadByte( 26U, uxIndex ), pxBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + uxIndex ] );
+    }
+}
+
+/**
+ * @brief The next header of the datagram is taken from the first fragment.
+ */
+void test_eIPv6Reassemble_NextHeaderOfFirstFragment( void )
+{
+    IPv6FragmentHeader_t * pxFragmentHeader = ( IPv6FragmentHeader_t * ) &( ucRxBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ] );
+    IPHeader_IPv6_t * pxIPHeader_IPv6;
+
+    prvSetIPv6( 27U, 16U, 6U, pdFALSE );
+    pxFragmentHeader->ucNextHeader = ipPROTOCOL_TCP;
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eIPv6Reassemble( &( xRxBuffer ) ) );
+    prvReceiveIPv6( 27U, 0U, 16U, pdTRUE );
+
+    TEST_ASSERT_EQUAL( 1, xDeliveredCount );
+    pxIPHeader_IPv6 = ( IPHeader_IPv6_t * ) &( pxDelivered[ 0 ]->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] );
+    TEST_ASSERT_EQUAL( ipPROTOCOL_UDP, pxIPHeader_IPv6->ucNextHeader );
+}
+
+/**
+ * @brief An IPv4 fragment does not belong to an IPv6 datagram, even when the
+ *        identification and the first bytes of the addresses are the same.
+ */
+void test_eIPv4Reassemble_NotInIPv6Datagram( void )
+{
+    prvReceiveIPv6( 28U, 0U, 16U, pdTRUE );
+
+    /* fe80::1 and fe80::2 start with the bytes of 254.128.0.0. */
+    prvReceiveIPv4From( 0xFE800000U, 0xFE800000U, 28U, 0U, 16U, pdTRUE );
+
+    TEST_ASSERT_EQUAL( 2, xBuffersTaken );
+}
+
+/**
+ * @brief Overlapping IPv6 fragments drop the datagram.
+ */
+void test_eIPv6Reassemble_Overlap( void )
+{
+    prvReceiveIPv6( 29U, 0U, 16U, pdTRUE );
+    prvReceiveIPv6( 29U, 8U, 16U, pdTRUE );
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+    TEST_ASSERT_EQUAL( 0, xDeliveredCount );
+}
+
+/**
+ * @brief A datagram that is larger than the MTU is sent in fragments of a
+ *        multiple of 8 bytes.
+ */
+void test_vIPFragmentOutput_IPv4( void )
+{
+    size_t uxMTU = 100U;
+    size_t uxExpected[] = { 80U, 80U, 40U };
+    size_t uxOffset = 0U;
+    size_t uxIndex;
+    BaseType_t xFragment;
+    IPHeader_t * pxIPHeader;
+
+    prvSetDatagramIPv4( 200U, 0U );
+
+    vIPFragmentOutput( &( xInterface ), &( xTxBuffer ), uxMTU );
+
+    TEST_ASSERT_EQUAL( 3, xSentCount );
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+
+    for( xFragment = 0; xFragment < 3; xFragment++ )
+    {
+        pxIPHeader = ( IPHeader_t * ) &( pxSent[ xFragment ]->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] );
+
+        TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + uxExpected[ xFragment ], FreeRTOS_ntohs( pxIPHeader->usLength ) );
+        TEST_ASSERT_EQUAL( uxOffset / ipFRAGMENT_BLOCK_SIZE, FreeRTOS_ntohs( pxIPHeader->usFragmentOffset & ipFRAGMENT_OFFSET_BIT_MASK ) );
+        TEST_ASSERT_EQUAL( ( xFragment < 2 ) ? ipFRAGMENT_FLAGS_MORE_FRAGMENTS : 0U, pxIPHeader->usFragmentOffset & ipFRAGMENT_FLAGS_MORE_FRAGMENTS );
+        TEST_ASSERT_EQUAL( FreeRTOS_htons( 0x1234U ), pxIPHeader->usIdentification );
+
+        for( uxIndex = 0U; uxIndex < uxExpected[ xFragment ]; uxIndex++ )
+        {
+            TEST_ASSERT_EQUAL_UINT8( prvPayloadByte( 0x1234U, uxOffset + uxIndex ), pxSent[ xFragment ]->pucEthernetBuffer[ TEST_IPv4_HEADERS + uxIndex ] );
+        }
+
+        uxOffset += uxExpected[ xFragment ];
+    }
+}
+
+/**
+ * @brief A datagram with the DF flag set is dropped instead of fragmented.
+ */
+void test_vIPFragmentOutput_DontFragment( void )
+{
+    prvSetDatagramIPv4( 200U, ipFRAGMENT_FLAGS_DONT_FRAGMENT );
+
+    vIPFragmentOutput( &( xInterface ), &( xTxBuffer ), 100U );
+
+    TEST_ASSERT_EQUAL( 0, xSentCount );
+    TEST_ASSERT_EQUAL( 0, xBuffersTaken );
+    TEST_ASSERT_EQUAL( 1, xBuffersReleased );
+}
@@ -0,0 +1,403 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_IP_RunToCompletion_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IPv4_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IPv6_Utils.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_TCP_IP.h"
+#include "mock_FreeRTOS_ICMP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_DHCP.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_FreeRTOS_DNS.h"
+#include "mock_FreeRTOS_DNS_Cache.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+#include "mock_FreeRTOS_ND.h"
+#include "mock_FreeRTOS_IPv6.h"
+#include "mock_FreeRTOS_IPv4.h"
+
+#include "FreeRTOS_IP.h"
+
+#include "FreeRTOS_IP_RunToCompletion_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+extern BaseType_t xIPTaskInitialised;
+extern BaseType_t xNetworkDownEventPending;
+extern TaskHandle_t xIPTaskHandle;
+extern SemaphoreHandle_t xIPStackMutex;
+extern size_t uxDeferredHead;
+extern size_t uxDeferredCount;
+
+/* Stand-ins for the stack mutex and the tasks that take it. */
+static uint8_t ucMutex[ 8 ];
+static uint8_t ucTask[ 8 ];
+
+#define TEST_MUTEX      ( ( SemaphoreHandle_t ) ucMutex )
+#define TEST_TASK       ( ( TaskHandle_t ) ucTask )
+
+#define TEST_TIMEOUT    ( ( TickType_t ) 10U )
+
+static FreeRTOS_Socket_t xSocket;
+static NetworkBufferDescriptor_t xBuffers[ 3 ];
+
+/* The number of events that the callback of vSocketClose() sends. */
+static BaseType_t xEventsToPost;
+
+/* The results of the xSendEventStructToIPTask() calls in that callback. */
+static BaseType_t xPostResults[ 3 ];
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    pxNetworkEndPoints = NULL;
+    pxNetworkInterfaces = NULL;
+    xNetworkDownEventPending = pdFALSE;
+
+    /* The stack has been initialised by an earlier task. */
+    xIPTaskInitialised = pdTRUE;
+    xIPStackMutex = TEST_MUTEX;
+    xIPTaskHandle = NULL;
+    uxDeferredHead = 0U;
+    uxDeferredCount = 0U;
+
+    xEventsToPost = 0;
+    memset( xPostResults, 0, sizeof( xPostResults ) );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    /* Every path gives the mutex, or did not take it. */
+    TEST_ASSERT_NULL( xIPTaskHandle );
+    TEST_ASSERT_EQUAL( 0U, uxDeferredCount );
+}
+
+/* ======================== Stub Callback Functions ========================= */
+
+/**
+ * @brief Send events while the stack is running in this task, like a UDP
+ *        receive handler that calls FreeRTOS_sendto().
+ */
+static void * vSocketClose_PostEvents( FreeRTOS_Socket_t * pxSocket,
+                                       int cmock_num_calls )
+{
+    IPStackEvent_t xEvent;
+    BaseType_t xIndex;
+
+    /* The calling task owns the stack. */
+    TEST_ASSERT_EQUAL_PTR( TEST_TASK, xIPTaskHandle );
+
+    for( xIndex = 0; xIndex < xEventsToPost; xIndex++ )
+    {
+        xEvent.eEventType = eStackTxEvent;
+        xEvent.pvData = &( xBuffers[ xIndex ] );
+        xPostResults[ xIndex ] = xSendEventStructToIPTask( &xEvent, TEST_TIMEOUT );
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Send an event from the network timers.
+ */
+static void vCheckNetworkTimers_PostEvent( int cmock_num_calls )
+{
+    IPStackEvent_t xEvent;
+
+    xEvent.eEventType = eStackTxEvent;
+    xEvent.pvData = &( xBuffers[ 0 ] );
+    xPostResults[ 0 ] = xSendEventStructToIPTask( &xEvent, TEST_TIMEOUT );
+}
+
+/* ======================== Test Helpers ========================= */
+
+/**
+ * @brief Expect the calling task to take the stack mutex.
+ */
+static void prvExpectTake( TickType_t uxTimeout )
+{
+    xQueueSemaphoreTake_ExpectAndReturn( TEST_MUTEX, uxTimeout, pdPASS );
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( TEST_TASK );
+}
+
+/**
+ * @brief Expect the calling task to give the stack mutex.
+ */
+static void prvExpectGive( void )
+{
+    xQueueGenericSend_ExpectAndReturn( TEST_MUTEX, NULL, semGIVE_BLOCK_TIME, queueSEND_TO_BACK, pdPASS );
+}
+
+/**
+ * @brief Expect an event that is sent by the task that runs the stack: it
+ *        must not block, and it is stored.
+ */
+static void prvExpectDeferred( void )
+{
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief An event is handled in the task that sends it, which takes and
+ *        gives the stack mutex.
+ */
+void test_xSendEventStructToIPTask_RunToCompletion( void )
+{
+    IPStackEvent_t xEvent;
+
+    xEvent.eEventType = eSocketCloseEvent;
+    xEvent.pvData = &xSocket;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    prvExpectTake( TEST_TIMEOUT );
+    vSocketClose_ExpectAndReturn( &xSocket, NULL );
+    prvExpectGive();
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, TEST_TIMEOUT ) );
+}
+
+/**
+ * @brief An event that is sent while the stack mutex is held by the calling
+ *        task is not handled recursively, but after the running event, and
+ *        before the mutex is given.
+ */
+void test_xSendEventStructToIPTask_RunToCompletion_PostedWhileHeld( void )
+{
+    IPStackEvent_t xEvent;
+
+    xEvent.eEventType = eSocketCloseEvent;
+    xEvent.pvData = &xSocket;
+    xEventsToPost = 1;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    prvExpectTake( TEST_TIMEOUT );
+    vSocketClose_ExpectAndReturn( &xSocket, NULL );
+    vSocketClose_AddCallback( vSocketClose_PostEvents );
+    prvExpectDeferred();
+    vProcessGeneratedUDPPacket_Expect( &( xBuffers[ 0 ] ) );
+    prvExpectGive();
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, TEST_TIMEOUT ) );
+    TEST_ASSERT_EQUAL( pdPASS, xPostResults[ 0 ] );
+}
+
+/**
+ * @brief When the list of deferred events is full, a new event is lost, and
+ *        the stored events are still handled before the mutex is given.
+ */
+void test_xSendEventStructToIPTask_RunToCompletion_DeferredListFull( void )
+{
+    IPStackEvent_t xEvent;
+
+    xEvent.eEventType = eSocketCloseEvent;
+    xEvent.pvData = &xSocket;
+    xEventsToPost = 3;
+
+    TEST_ASSERT_EQUAL( 2, ipconfigRUN_TO_COMPLETION_DEFERRED_EVENTS );
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    prvExpectTake( TEST_TIMEOUT );
+    vSocketClose_ExpectAndReturn( &xSocket, NULL );
+    vSocketClose_AddCallback( vSocketClose_PostEvents );
+    prvExpectDeferred();
+    prvExpectDeferred();
+    prvExpectDeferred();
+    vProcessGeneratedUDPPacket_Expect( &( xBuffers[ 0 ] ) );
+    vProcessGeneratedUDPPacket_Expect( &( xBuffers[ 1 ] ) );
+    prvExpectGive();
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, TEST_TIMEOUT ) );
+    TEST_ASSERT_EQUAL( pdPASS, xPostResults[ 0 ] );
+    TEST_ASSERT_EQUAL( pdPASS, xPostResults[ 1 ] );
+    TEST_ASSERT_EQUAL( pdFAIL, xPostResults[ 2 ] );
+}
+
+/**
+ * @brief The deferred events are stored in a ring, which wraps when the
+ *        stack is run again.
+ */
+void test_xSendEventStructToIPTask_RunToCompletion_DeferredListWraps( void )
+{
+    IPStackEvent_t xEvent;
+
+    xEvent.eEventType = eSocketCloseEvent;
+    xEvent.pvData = &xSocket;
+    xEventsToPost = 2;
+    uxDeferredHead = 1U;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    prvExpectTake( TEST_TIMEOUT );
+    vSocketClose_ExpectAndReturn( &xSocket, NULL );
+    vSocketClose_AddCallback( vSocketClose_PostEvents );
+    prvExpectDeferred();
+    prvExpectDeferred();
+    vProcessGeneratedUDPPacket_Expect( &( xBuffers[ 0 ] ) );
+    vProcessGeneratedUDPPacket_Expect( &( xBuffers[ 1 ] ) );
+    prvExpectGive();
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, TEST_TIMEOUT ) );
+    TEST_ASSERT_EQUAL( 1U, uxDeferredHead );
+}
+
+/**
+ * @brief When another task runs the stack for too long, the event fails
+ *        and the mutex is not given.
+ */
+void test_xSendEventStructToIPTask_RunToCompletion_StackBusy( void )
+{
+    IPStackEvent_t xEvent;
+
+    xEvent.eEventType = eSocketCloseEvent;
+    xEvent.pvData = &xSocket;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    xQueueSemaphoreTake_ExpectAndReturn( TEST_MUTEX, TEST_TIMEOUT, pdFAIL );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xSendEventStructToIPTask( &xEvent, TEST_TIMEOUT ) );
+}
+
+/**
+ * @brief Without a stack mutex, FreeRTOS_IPInit_Multi() failed, and the
+ *        event fails without taking anything.
+ */
+void test_xSendEventStructToIPTask_RunToCompletion_NoMutex( void )
+{
+    IPStackEvent_t xEvent;
+
+    xEvent.eEventType = eSocketCloseEvent;
+    xEvent.pvData = &xSocket;
+    xIPStackMutex = NULL;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xSendEventStructToIPTask( &xEvent, TEST_TIMEOUT ) );
+}
+
+/**
+ * @brief The first task that runs the stack initialises it.
+ */
+void test_FreeRTOS_IPProcessTimers_Initialise( void )
+{
+    xIPTaskInitialised = pdFALSE;
+
+    xQueueSemaphoreTake_ExpectAndReturn( TEST_MUTEX, portMAX_DELAY, pdPASS );
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( TEST_TASK );
+    vNetworkTimerReload_Ignore();
+    vIPSetARPResolutionTimerEnableState_Expect( pdFALSE );
+    vDNSInitialise_Ignore();
+    FreeRTOS_dnsclear_Ignore();
+    vCheckNetworkTimers_Expect();
+    xCalculateSleepTime_ExpectAndReturn( 100U );
+    prvExpectGive();
+
+    TEST_ASSERT_EQUAL( 100U, FreeRTOS_IPProcessTimers() );
+    TEST_ASSERT_EQUAL( pdTRUE, xIPTaskInitialised );
+}
+
+/**
+ * @brief The timers run in the calling task, and return the time until
+ *        the next timer expires.
+ */
+void test_FreeRTOS_IPProcessTimers_RunToCompletion( void )
+{
+    prvExpectTake( portMAX_DELAY );
+    vCheckNetworkTimers_Expect();
+    xCalculateSleepTime_ExpectAndReturn( 100U );
+    prvExpectGive();
+
+    TEST_ASSERT_EQUAL( 100U, FreeRTOS_IPProcessTimers() );
+}
+
+/**
+ * @brief An event that is sent by a timer is handled before the sleep
+ *        time is calculated, because it may reload a timer.
+ */
+void test_FreeRTOS_IPProcessTimers_TimerPostsEvent( void )
+{
+    prvExpectTake( portMAX_DELAY );
+    vCheckNetworkTimers_Stub( vCheckNetworkTimers_PostEvent );
+    prvExpectDeferred();
+    vProcessGeneratedUDPPacket_Expect( &( xBuffers[ 0 ] ) );
+    xCalculateSleepTime_ExpectAndReturn( 100U );
+    prvExpectGive();
+
+    TEST_ASSERT_EQUAL( 100U, FreeRTOS_IPProcessTimers() );
+    TEST_ASSERT_EQUAL( pdPASS, xPostResults[ 0 ] );
+}
+
+/**
+ * @brief The timers are not run while the stack mutex can not be taken.
+ */
+void test_FreeRTOS_IPProcessTimers_StackBusy( void )
+{
+    xQueueSemaphoreTake_ExpectAndReturn( TEST_MUTEX, portMAX_DELAY, pdFAIL );
+
+    TEST_ASSERT_EQUAL( ipconfigMAX_IP_TASK_SLEEP_TIME, FreeRTOS_IPProcessTimers() );
+}
+
+/**
+ * @brief Without a stack mutex, the timers are not run.
+ */
+void test_FreeRTOS_IPProcessTimers_NoMutex( void )
+{
+    xIPStackMutex = NULL;
+
+    TEST_ASSERT_EQUAL( ipconfigMAX_IP_TASK_SLEEP_TIME, FreeRTOS_IPProcessTimers() );
+}
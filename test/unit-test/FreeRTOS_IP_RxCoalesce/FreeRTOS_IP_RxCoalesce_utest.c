@@ -0,0 +1,226 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_IP_RxCoalesce_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_IPv4_Private.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_FreeRTOS_TCP_IP.h"
+#include "mock_NetworkBufferManagement.h"
+
+#include "FreeRTOS_IP.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+void prvProcessIPEventsAndTimers( void );
+eFrameProcessingResult_t prvProcessIPPacket( IPPacket_t * pxIPPacket,
+                                             NetworkBufferDescriptor_t * const pxNetworkBuffer );
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    pxNetworkEndPoints = NULL;
+    pxNetworkInterfaces = NULL;
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief Let prvProcessIPEventsAndTimers() take 'pxEvent' from the queue.
+ */
+static void prvExpectEvent( IPStackEvent_t * pxEvent )
+{
+    vCheckNetworkTimers_Expect();
+    xCalculateSleepTime_ExpectAndReturn( 0 );
+    xQueueReceive_ExpectAnyArgsAndReturn( pdTRUE );
+    xQueueReceive_ReturnMemThruPtr_pvBuffer( pxEvent, sizeof( *pxEvent ) );
+}
+
+/**
+ * @brief test_prvProcessIPEventsAndTimers_eNetworkRxEvent_Flush
+ * The TCP segments that were held while handling an eNetworkRxEvent are
+ * flushed once the received packets have been handled.
+ */
+void test_prvProcessIPEventsAndTimers_eNetworkRxEvent_Flush( void )
+{
+    IPStackEvent_t xReceivedEvent;
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ] = { 0 };
+    NetworkInterface_t xInterface;
+
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    xNetworkBuffer.pucEthernetBuffer = ucEthBuffer;
+    xNetworkBuffer.xDataLength = sizeof( ucEthBuffer );
+    xNetworkBuffer.pxInterface = &xInterface;
+
+    xReceivedEvent.eEventType = eNetworkRxEvent;
+    xReceivedEvent.pvData = &xNetworkBuffer;
+
+    prvExpectEvent( &xReceivedEvent );
+
+    /* The buffer has no end-point, it is released. */
+    vReleaseNetworkBufferAndDescriptor_Expect( &xNetworkBuffer );
+    vTCPRxCoalesceFlush_Expect();
+
+    prvProcessIPEventsAndTimers();
+}
+
+/**
+ * @brief test_prvProcessIPEventsAndTimers_eNetworkRxRingEvent_Flush
+ * All buffers in the receive ring are handled before the held TCP segments
+ * are flushed.
+ */
+void test_prvProcessIPEventsAndTimers_eNetworkRxRingEvent_Flush( void )
+{
+    IPStackEvent_t xReceivedEvent;
+    NetworkBufferDescriptor_t xNetworkBuffers[ 2 ];
+    uint8_t ucEthBuffers[ 2 ][ ipconfigTCP_MSS ] = { 0 };
+    NetworkInterface_t xInterface;
+    size_t uxIndex;
+
+    memset( &xInterface, 0, sizeof( xInterface ) );
+    memset( xNetworkBuffers, 0, sizeof( xNetworkBuffers ) );
+
+    for( uxIndex = 0U; uxIndex < 2U; uxIndex++ )
+    {
+        xNetworkBuffers[ uxIndex ].pucEthernetBuffer = ucEthBuffers[ uxIndex ];
+        xNetworkBuffers[ uxIndex ].xDataLength = sizeof( ucEthBuffers[ uxIndex ] );
+        xNetworkBuffers[ uxIndex ].pxInterface = &xInterface;
+    }
+
+    /* The ring has wrapped: the buffers are in the last and in the first slot. */
+    xInterface.xRxRing.uxTail = ipconfigNETWORK_RX_RING_LENGTH - 1U;
+    xInterface.xRxRing.uxHead = ipconfigNETWORK_RX_RING_LENGTH + 1U;
+    xInterface.xRxRing.pxBuffers[ ipconfigNETWORK_RX_RING_LENGTH - 1U ] = &( xNetworkBuffers[ 0 ] );
+    xInterface.xRxRing.pxBuffers[ 0 ] = &( xNetworkBuffers[ 1 ] );
+    xInterface.xRxRing.xEventPending = pdTRUE;
+
+    xReceivedEvent.eEventType = eNetworkRxRingEvent;
+    xReceivedEvent.pvData = &xInterface;
+
+    prvExpectEvent( &xReceivedEvent );
+
+    vReleaseNetworkBufferAndDescriptor_Expect( &( xNetworkBuffers[ 0 ] ) );
+    vReleaseNetworkBufferAndDescriptor_Expect( &( xNetworkBuffers[ 1 ] ) );
+    vTCPRxCoalesceFlush_Expect();
+
+    prvProcessIPEventsAndTimers();
+
+    TEST_ASSERT_EQUAL( ipconfigNETWORK_RX_RING_LENGTH + 1U, xInterface.xRxRing.uxTail );
+    TEST_ASSERT_EQUAL( pdFALSE, xInterface.xRxRing.xEventPending );
+}
+
+/**
+ * @brief Fill in a TCP packet for prvProcessIPPacket() and expect the calls
+ *        that precede the TCP protocol handling.
+ */
+static IPPacket_t * prvTCPPacket( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                  uint8_t * pucEthBuffer,
+                                  NetworkInterface_t * pxInterface )
+{
+    IPPacket_t * pxIPPacket = ( IPPacket_t * ) pucEthBuffer;
+    IPHeader_t * pxIPHeader = &( pxIPPacket->xIPHeader );
+
+    memset( pxNetworkBuffer, 0, sizeof( *pxNetworkBuffer ) );
+    pxNetworkBuffer->pucEthernetBuffer = pucEthBuffer;
+    pxNetworkBuffer->xDataLength = sizeof( TCPPacket_t );
+    pxNetworkBuffer->pxInterface = pxInterface;
+
+    pxIPPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+    pxIPHeader->ucVersionHeaderLength = 0x45;
+    pxIPHeader->usLength = FreeRTOS_htons( ipconfigTCP_MSS );
+    pxIPHeader->ucProtocol = ipPROTOCOL_TCP;
+
+    prvAllowIPPacketIPv4_ExpectAndReturn( pxIPPacket, pxNetworkBuffer, ipSIZE_OF_IPv4_HEADER, eProcessBuffer );
+    xCheckRequiresARPResolution_ExpectAndReturn( pxNetworkBuffer, pdFALSE );
+    vARPRefreshCacheEntryAge_ExpectAnyArgs();
+
+    return pxIPPacket;
+}
+
+/**
+ * @brief test_prvProcessIPPacket_TCP_Held
+ * A TCP segment that is held for merging is consumed, and not processed yet.
+ */
+void test_prvProcessIPPacket_TCP_Held( void )
+{
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    uint8_t ucEthBuffer[ ipIP_TYPE_OFFSET + ipconfigTCP_MSS ] = { 0 };
+    NetworkInterface_t xInterface;
+    IPPacket_t * pxIPPacket;
+
+    pxIPPacket = prvTCPPacket( &xNetworkBuffer, ucEthBuffer + ipIP_TYPE_OFFSET, &xInterface );
+    xTCPRxCoalesce_ExpectAndReturn( &xNetworkBuffer, pdPASS );
+
+    TEST_ASSERT_EQUAL( eFrameConsumed, prvProcessIPPacket( pxIPPacket, &xNetworkBuffer ) );
+}
+
+/**
+ * @brief test_prvProcessIPPacket_TCP_NotHeld
+ * A TCP segment that can not be merged is processed at once.
+ */
+void test_prvProcessIPPacket_TCP_NotHeld( void )
+{
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    uint8_t ucEthBuffer[ ipIP_TYPE_OFFSET + ipconfigTCP_MSS ] = { 0 };
+    NetworkInterface_t xInterface;
+    IPPacket_t * pxIPPacket;
+
+    pxIPPacket = prvTCPPacket( &xNetworkBuffer, ucEthBuffer + ipIP_TYPE_OFFSET, &xInterface );
+    xTCPRxCoalesce_ExpectAndReturn( &xNetworkBuffer, pdFAIL );
+    xProcessReceivedTCPPacket_ExpectAndReturn( &xNetworkBuffer, pdFAIL );
+
+    TEST_ASSERT_EQUAL( eProcessBuffer, prvProcessIPPacket( pxIPPacket, &xNetworkBuffer ) );
+}
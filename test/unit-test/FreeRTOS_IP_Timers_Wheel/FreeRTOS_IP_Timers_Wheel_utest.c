@@ -0,0 +1,353 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_TCP_IP.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_DNS_Callback.h"
+#include "mock_FreeRTOS_ND.h"
+
+#include "FreeRTOS_IP_Timers.h"
+
+#include "FreeRTOS_IP_Timers_Wheel_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/* The geometry of the wheel in FreeRTOS_IP_Timers.c. */
+#define TEST_WHEEL_BITS      ( 4U )
+#define TEST_WHEEL_SLOTS     ( 16U )
+#define TEST_WHEEL_LEVELS    ( 4U )
+
+/* The time at which the wheel is initialised. */
+#define TEST_START_TIME      ( 100U )
+
+extern List_t xTCPTimerWheel[ TEST_WHEEL_LEVELS ][ TEST_WHEEL_SLOTS ];
+extern List_t xTCPWakeUpList;
+extern List_t xTCPRescheduleList;
+extern TickType_t xTCPWheelTime;
+extern UBaseType_t uxTCPWheelCount;
+
+static FreeRTOS_Socket_t xSocket;
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    xTaskGetTickCount_ExpectAndReturn( TEST_START_TIME );
+    vTCPTimerWheelInit();
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    vListInitialiseItem( &( xSocket.u.xTCP.xTimerListItem ) );
+    listSET_LIST_ITEM_OWNER( &( xSocket.u.xTCP.xTimerListItem ), &xSocket );
+    vListInitialiseItem( &( xSocket.u.xTCP.xWakeUpListItem ) );
+    listSET_LIST_ITEM_OWNER( &( xSocket.u.xTCP.xWakeUpListItem ), &xSocket );
+    vListInitialiseItem( &( xSocket.u.xTCP.xRescheduleListItem ) );
+    listSET_LIST_ITEM_OWNER( &( xSocket.u.xTCP.xRescheduleListItem ), &xSocket );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+}
+
+/* ======================== Function Under Test ======================== */
+
+/**
+ * @brief Let the IP-task schedule the test socket at time 'xNow'.
+ */
+static void prvSchedule( uint16_t usTimeout,
+                         TickType_t xNow )
+{
+    xSocket.u.xTCP.usTimeout = usTimeout;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    xTaskGetTickCount_ExpectAndReturn( xNow );
+    vTCPTimerWheelSchedule( &xSocket );
+}
+
+/**
+ * @brief A short timeout goes into a slot of level 0.
+ */
+void test_vTCPTimerWheelSchedule_Insert_Level0( void )
+{
+    prvSchedule( 5U, TEST_START_TIME );
+
+    TEST_ASSERT_EQUAL( TEST_START_TIME + 5U, listGET_LIST_ITEM_VALUE( &( xSocket.u.xTCP.xTimerListItem ) ) );
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &( xTCPTimerWheel[ 0 ][ ( TEST_START_TIME + 5U ) % TEST_WHEEL_SLOTS ] ),
+                                                        &( xSocket.u.xTCP.xTimerListItem ) ) );
+    TEST_ASSERT_EQUAL( 1U, uxTCPWheelCount );
+    TEST_ASSERT_EQUAL( 5U, xSocket.u.xTCP.usTimeoutScheduled );
+}
+
+/**
+ * @brief A timeout of 16 ticks or more goes into a slot of level 1.
+ */
+void test_vTCPTimerWheelSchedule_Insert_Level1( void )
+{
+    TickType_t xExpiry = TEST_START_TIME + 20U;
+
+    prvSchedule( 20U, TEST_START_TIME );
+
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &( xTCPTimerWheel[ 1 ][ ( xExpiry >> TEST_WHEEL_BITS ) % TEST_WHEEL_SLOTS ] ),
+                                                        &( xSocket.u.xTCP.xTimerListItem ) ) );
+}
+
+/**
+ * @brief A timeout of 256 ticks or more goes into a slot of level 2.
+ */
+void test_vTCPTimerWheelSchedule_Insert_Level2( void )
+{
+    TickType_t xExpiry = TEST_START_TIME + 300U;
+
+    prvSchedule( 300U, TEST_START_TIME );
+
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &( xTCPTimerWheel[ 2 ][ ( xExpiry >> ( 2U * TEST_WHEEL_BITS ) ) % TEST_WHEEL_SLOTS ] ),
+                                                        &( xSocket.u.xTCP.xTimerListItem ) ) );
+}
+
+/**
+ * @brief When 'usTimeout' did not change, the expiry time is kept.
+ */
+void test_vTCPTimerWheelSchedule_Unchanged_KeepsExpiry( void )
+{
+    prvSchedule( 5U, TEST_START_TIME );
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    vTCPTimerWheelSchedule( &xSocket );
+
+    TEST_ASSERT_EQUAL( TEST_START_TIME + 5U, listGET_LIST_ITEM_VALUE( &( xSocket.u.xTCP.xTimerListItem ) ) );
+    TEST_ASSERT_EQUAL( 1U, uxTCPWheelCount );
+}
+
+/**
+ * @brief A changed 'usTimeout' moves the socket to a new slot.
+ */
+void test_vTCPTimerWheelSchedule_Changed_Moves( void )
+{
+    prvSchedule( 5U, TEST_START_TIME );
+    prvSchedule( 8U, TEST_START_TIME + 2U );
+
+    TEST_ASSERT_EQUAL( TEST_START_TIME + 10U, listGET_LIST_ITEM_VALUE( &( xSocket.u.xTCP.xTimerListItem ) ) );
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &( xTCPTimerWheel[ 0 ][ ( TEST_START_TIME + 10U ) % TEST_WHEEL_SLOTS ] ),
+                                                        &( xSocket.u.xTCP.xTimerListItem ) ) );
+    TEST_ASSERT_EQUAL( 1U, uxTCPWheelCount );
+}
+
+/**
+ * @brief A 'usTimeout' of zero takes the socket out of the wheel.
+ */
+void test_vTCPTimerWheelSchedule_Zero_Removes( void )
+{
+    prvSchedule( 5U, TEST_START_TIME );
+
+    xSocket.u.xTCP.usTimeout = 0U;
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    vTCPTimerWheelSchedule( &xSocket );
+
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( &( xSocket.u.xTCP.xTimerListItem ) ) );
+    TEST_ASSERT_EQUAL( 0U, uxTCPWheelCount );
+}
+
+/**
+ * @brief Only the IP-task may touch the wheel.
+ */
+void test_vTCPTimerWheelSchedule_NotIPTask( void )
+{
+    xSocket.u.xTCP.usTimeout = 5U;
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    vTCPTimerWheelSchedule( &xSocket );
+
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( &( xSocket.u.xTCP.xTimerListItem ) ) );
+    TEST_ASSERT_EQUAL( 0U, uxTCPWheelCount );
+}
+
+/**
+ * @brief A socket with events for its owner is put in the wake-up list.
+ */
+void test_vTCPTimerWheelSchedule_EventBits_WakeUpList( void )
+{
+    xSocket.xEventBits = ( EventBits_t ) eSOCKET_RECEIVE;
+    prvSchedule( 5U, TEST_START_TIME );
+
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &xTCPWakeUpList, &( xSocket.u.xTCP.xWakeUpListItem ) ) );
+}
+
+/**
+ * @brief A user task only queues the socket, the IP-task places it in the
+ *        wheel the next time it checks the wheel.
+ */
+void test_vTCPTimerWheelRequest_UserTask( void )
+{
+    TickType_t xNext;
+
+    xSocket.u.xTCP.usTimeout = 5U;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    vTCPTimerWheelRequest( &xSocket );
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    vTCPTimerWheelRequest( &xSocket );
+
+    /* Queued once, not scheduled yet. */
+    TEST_ASSERT_EQUAL( 1U, listCURRENT_LIST_LENGTH( &xTCPRescheduleList ) );
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( &( xSocket.u.xTCP.xTimerListItem ) ) );
+
+    xTaskGetTickCount_ExpectAndReturn( TEST_START_TIME );
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    xTaskGetTickCount_ExpectAndReturn( TEST_START_TIME );
+
+    xNext = xTCPTimerWheelCheck( pdFALSE );
+
+    TEST_ASSERT_EQUAL( 0U, listCURRENT_LIST_LENGTH( &xTCPRescheduleList ) );
+    TEST_ASSERT_EQUAL( 1U, uxTCPWheelCount );
+    TEST_ASSERT_EQUAL( 5U, xNext );
+}
+
+/**
+ * @brief The IP-task itself schedules the socket at once.
+ */
+void test_vTCPTimerWheelRequest_IPTask( void )
+{
+    xSocket.u.xTCP.usTimeout = 5U;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    xTaskGetTickCount_ExpectAndReturn( TEST_START_TIME );
+    vTCPTimerWheelRequest( &xSocket );
+
+    TEST_ASSERT_EQUAL( 0U, listCURRENT_LIST_LENGTH( &xTCPRescheduleList ) );
+    TEST_ASSERT_EQUAL( 1U, uxTCPWheelCount );
+}
+
+/**
+ * @brief A closed socket is taken out of all lists of the wheel.
+ */
+void test_vTCPTimerWheelRemove( void )
+{
+    xSocket.xEventBits = ( EventBits_t ) eSOCKET_RECEIVE;
+    prvSchedule( 5U, TEST_START_TIME );
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    vTCPTimerWheelRequest( &xSocket );
+
+    vTCPTimerWheelRemove( &xSocket );
+
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( &( xSocket.u.xTCP.xTimerListItem ) ) );
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( &( xSocket.u.xTCP.xWakeUpListItem ) ) );
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( &( xSocket.u.xTCP.xRescheduleListItem ) ) );
+    TEST_ASSERT_EQUAL( 0U, uxTCPWheelCount );
+}
+
+/**
+ * @brief A socket is checked when its slot is reached, not before.
+ */
+void test_xTCPTimerWheelCheck_Expiry( void )
+{
+    TickType_t xNext;
+
+    prvSchedule( 3U, TEST_START_TIME );
+
+    xTaskGetTickCount_ExpectAndReturn( TEST_START_TIME + 2U );
+    xNext = xTCPTimerWheelCheck( pdFALSE );
+
+    TEST_ASSERT_EQUAL( 1U, xNext );
+    TEST_ASSERT_EQUAL( 1U, uxTCPWheelCount );
+
+    xTaskGetTickCount_ExpectAndReturn( TEST_START_TIME + 3U );
+    xTCPSocketCheck_ExpectAndReturn( &xSocket, 0 );
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    xNext = xTCPTimerWheelCheck( pdFALSE );
+
+    TEST_ASSERT_EQUAL( 0U, uxTCPWheelCount );
+    TEST_ASSERT_EQUAL( 0U, xSocket.u.xTCP.usTimeout );
+    TEST_ASSERT_EQUAL( pdMS_TO_TICKS( 1000U ), xNext );
+}
+
+/**
+ * @brief When the level-0 slots wrap around, the current slot of level 1 is
+ *        redistributed over level 0.
+ */
+void test_xTCPTimerWheelCheck_Cascade( void )
+{
+    TickType_t xExpiry = TEST_START_TIME + 20U;
+    TickType_t xWrap = xExpiry & ~( ( TickType_t ) TEST_WHEEL_SLOTS - 1U );
+    TickType_t xNext;
+
+    prvSchedule( 20U, TEST_START_TIME );
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &( xTCPTimerWheel[ 1 ][ ( xExpiry >> TEST_WHEEL_BITS ) % TEST_WHEEL_SLOTS ] ),
+                                                        &( xSocket.u.xTCP.xTimerListItem ) ) );
+
+    xTaskGetTickCount_ExpectAndReturn( xWrap );
+    xNext = xTCPTimerWheelCheck( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, listIS_CONTAINED_WITHIN( &( xTCPTimerWheel[ 0 ][ xExpiry % TEST_WHEEL_SLOTS ] ),
+                                                        &( xSocket.u.xTCP.xTimerListItem ) ) );
+    TEST_ASSERT_EQUAL( xExpiry - xWrap, xNext );
+
+    xTaskGetTickCount_ExpectAndReturn( xExpiry );
+    xTCPSocketCheck_ExpectAndReturn( &xSocket, 0 );
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    ( void ) xTCPTimerWheelCheck( pdFALSE );
+
+    TEST_ASSERT_EQUAL( 0U, uxTCPWheelCount );
+}
+
+/**
+ * @brief The owners of sockets with events are woken up before the IP-task
+ *        goes to sleep.
+ */
+void test_xTCPTimerWheelCheck_WakeUp( void )
+{
+    xSocket.xEventBits = ( EventBits_t ) eSOCKET_RECEIVE;
+    prvSchedule( 5U, TEST_START_TIME );
+
+    xTaskGetTickCount_ExpectAndReturn( TEST_START_TIME );
+    TEST_ASSERT_EQUAL( 0U, xTCPTimerWheelCheck( pdFALSE ) );
+
+    xTaskGetTickCount_ExpectAndReturn( TEST_START_TIME );
+    vSocketWakeUpUser_Expect( &xSocket );
+    TEST_ASSERT_EQUAL( 5U, xTCPTimerWheelCheck( pdTRUE ) );
+
+    TEST_ASSERT_EQUAL( 0U, listCURRENT_LIST_LENGTH( &xTCPWakeUpList ) );
+}
@@ -2335,6 +2335,55 @@ void test_usGenerateChecksum_FourByteAlignedSumOverflow2( void )
     TEST_ASSERT_EQUAL( 21759, usResult );
 }
 
+/**
+ * @brief test_usIncrementalChecksum_RFC1624Example
+ * To validate usIncrementalChecksum with the example given in RFC 1624.
+ */
+void test_usIncrementalChecksum_RFC1624Example( void )
+{
+    uint16_t usResult;
+
+    usResult = usIncrementalChecksum( 0xDD2FU, 0x5555U, 0x3285U );
+
+    TEST_ASSERT_EQUAL_HEX16( 0x0000U, usResult );
+}
+
+/**
+ * @brief test_usIncrementalChecksum_MatchesFullChecksum
+ * To validate that usIncrementalChecksum gives the same result as
+ * recalculating the checksum over the changed data.
+ */
+void test_usIncrementalChecksum_MatchesFullChecksum( void )
+{
+    uint8_t ucData[ 64 ];
+    uint16_t usChecksum, usOldWord, usNewWord, usResult;
+    size_t uxIndex;
+
+    for( uxIndex = 0; uxIndex < sizeof( ucData ); uxIndex++ )
+    {
+        ucData[ uxIndex ] = ( uint8_t ) ( ( uxIndex * 37U ) + 11U );
+    }
+
+    /* An ICMP echo request, with the checksum field at offset 2. */
+    ucData[ 0 ] = 8U;
+    ucData[ 2 ] = 0U;
+    ucData[ 3 ] = 0U;
+    usChecksum = ( uint16_t ) ~FreeRTOS_htons( usGenerateChecksum( 0U, ucData, sizeof( ucData ) ) );
+    memcpy( &( ucData[ 2 ] ), &usChecksum, sizeof( usChecksum ) );
+
+    memcpy( &usOldWord, &( ucData[ 0 ] ), sizeof( usOldWord ) );
+    ucData[ 0 ] = 0U;
+    memcpy( &usNewWord, &( ucData[ 0 ] ), sizeof( usNewWord ) );
+
+    usResult = usIncrementalChecksum( usChecksum, usOldWord, usNewWord );
+
+    ucData[ 2 ] = 0U;
+    ucData[ 3 ] = 0U;
+    usChecksum = ( uint16_t ) ~FreeRTOS_htons( usGenerateChecksum( 0U, ucData, sizeof( ucData ) ) );
+
+    TEST_ASSERT_EQUAL_HEX16( usChecksum, usResult );
+}
+
 /**
  * @brief test_vPrintResourceStats_BufferCountMore
  * To validate vPrintResourceStats when minimum free network buffer
@@ -0,0 +1,217 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_IP_Utils_ChecksumKernel_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_FreeRTOS_DHCP.h"
+#include "mock_FreeRTOS_DHCPv6.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_FreeRTOS_IPv4_Utils.h"
+#include "mock_FreeRTOS_IPv6_Utils.h"
+#include "mock_NetworkBufferManagement.h"
+
+#include "FreeRTOS_IP_Utils.h"
+
+#include "FreeRTOS_IP_Utils_ChecksumKernel_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/* Room for a jumbo frame, plus the offsets that make the data unaligned. */
+#define TEST_BUFFER_SIZE    ( 9024U )
+
+/* The largest offset from a 32-bit aligned address. */
+#define TEST_MAX_OFFSET     ( 7U )
+
+/* Aligned for the kernel, the tests add an offset. */
+static uint32_t ulBuffer[ TEST_BUFFER_SIZE / sizeof( uint32_t ) ];
+
+/* ======================== Test Helpers ========================= */
+
+/**
+ * @brief The reference: the one's complement sum of the 16-bit words in
+ *        network byte order, as in RFC 1071, added byte by byte.  Like
+ *        usGenerateChecksum(), it takes and returns the sum as a host value.
+ */
+static uint16_t prvReferenceChecksum( uint16_t usSum,
+                                      const uint8_t * pucData,
+                                      size_t uxByteCount )
+{
+    uint32_t ulSum = usSum;
+    size_t uxIndex;
+
+    for( uxIndex = 0U; ( uxIndex + 1U ) < uxByteCount; uxIndex += 2U )
+    {
+        ulSum += ( ( uint32_t ) pucData[ uxIndex ] << 8 ) | pucData[ uxIndex + 1U ];
+    }
+
+    if( ( uxByteCount & 1U ) != 0U )
+    {
+        /* The last byte is padded with a zero. */
+        ulSum += ( uint32_t ) pucData[ uxByteCount - 1U ] << 8;
+    }
+
+    while( ( ulSum >> 16 ) != 0U )
+    {
+        ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+    }
+
+    return ( uint16_t ) ulSum;
+}
+
+/**
+ * @brief In one's complement, 0x0000 and 0xFFFF are both zero.
+ */
+static void prvAssertSameSum( uint16_t usExpected,
+                              uint16_t usActual )
+{
+    if( usExpected == 0xFFFFU )
+    {
+        usExpected = 0U;
+    }
+
+    if( usActual == 0xFFFFU )
+    {
+        usActual = 0U;
+    }
+
+    TEST_ASSERT_EQUAL_HEX16( usExpected, usActual );
+}
+
+/**
+ * @brief Fill the buffer with random bytes, with many 0xFF bytes to get
+ *        a lot of carries.
+ */
+static void prvFillBuffer( unsigned int uxSeed )
+{
+    uint8_t * pucBuffer = ( uint8_t * ) ulBuffer;
+    size_t uxIndex;
+
+    srand( uxSeed );
+
+    for( uxIndex = 0U; uxIndex < sizeof( ulBuffer ); uxIndex++ )
+    {
+        pucBuffer[ uxIndex ] = ( ( rand() & 1 ) != 0 ) ? 0xFFU : ( uint8_t ) rand();
+    }
+}
+
+/**
+ * @brief Compare usGenerateChecksum() with the reference for every offset
+ *        and every length up to uxMaxLength.
+ */
+static void prvCompareAll( size_t uxMaxLength,
+                           uint16_t usSum )
+{
+    const uint8_t * pucBuffer = ( const uint8_t * ) ulBuffer;
+    size_t uxOffset;
+    size_t uxLength;
+
+    for( uxOffset = 0U; uxOffset <= TEST_MAX_OFFSET; uxOffset++ )
+    {
+        for( uxLength = 0U; uxLength <= uxMaxLength; uxLength++ )
+        {
+            prvAssertSameSum( prvReferenceChecksum( usSum, &( pucBuffer[ uxOffset ] ), uxLength ),
+                              usGenerateChecksum( usSum, &( pucBuffer[ uxOffset ] ), uxLength ) );
+        }
+    }
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief test_usGenerateChecksum_Kernel_ShortLengths
+ * Every length up to a few iterations of the kernel, odd ones included, at
+ * every offset from a 32-bit boundary: the head and the tail around the
+ * words that the kernel adds are handled by usGenerateChecksum().
+ */
+void test_usGenerateChecksum_Kernel_ShortLengths( void )
+{
+    prvFillBuffer( 1U );
+
+    prvCompareAll( 100U, 0U );
+    prvCompareAll( 100U, 0xBEEFU );
+}
+
+/**
+ * @brief test_usGenerateChecksum_Kernel_AllOnes
+ * All bits set: every addition produces a carry.
+ */
+void test_usGenerateChecksum_Kernel_AllOnes( void )
+{
+    ( void ) memset( ulBuffer, 0xFF, sizeof( ulBuffer ) );
+
+    prvCompareAll( 70U, 0xFFFFU );
+}
+
+/**
+ * @brief test_usGenerateChecksum_Kernel_FrameLengths
+ * Random data, with the lengths of full Ethernet and jumbo frames, odd and
+ * even, at every offset.
+ */
+void test_usGenerateChecksum_Kernel_FrameLengths( void )
+{
+    const size_t uxLengths[] = { 1499U, 1500U, 1501U, 1514U, 1515U, 8999U, 9000U, 9001U };
+    const uint8_t * pucBuffer = ( const uint8_t * ) ulBuffer;
+    size_t uxIndex;
+    size_t uxOffset;
+    uint16_t usSum;
+
+    prvFillBuffer( 2U );
+
+    for( uxIndex = 0U; uxIndex < ( sizeof( uxLengths ) / sizeof( uxLengths[ 0 ] ) ); uxIndex++ )
+    {
+        for( uxOffset = 0U; uxOffset <= TEST_MAX_OFFSET; uxOffset++ )
+        {
+            usSum = ( uint16_t ) rand();
+
+            prvAssertSameSum( prvReferenceChecksum( usSum, &( pucBuffer[ uxOffset ] ), uxLengths[ uxIndex ] ),
+                              usGenerateChecksum( usSum, &( pucBuffer[ uxOffset ] ), uxLengths[ uxIndex ] ) );
+        }
+    }
+}
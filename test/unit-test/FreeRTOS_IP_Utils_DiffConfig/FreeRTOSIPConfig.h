@@ -334,4 +334,6 @@
 #define ipconfigCHECK_IP_QUEUE_SPACE    ( 1 )
 #define ipconfigZERO_COPY_TX_DRIVER     ( 1 )
 
+#define ipconfigUSE_PER_INTERFACE_CHECKSUM_OFFLOAD    ( 1 )
+
 #endif /* FREERTOS_IP_CONFIG_H */
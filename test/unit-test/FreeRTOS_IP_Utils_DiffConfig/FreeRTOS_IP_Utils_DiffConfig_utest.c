@@ -334,3 +334,133 @@ void test_pxUDPPayloadBuffer_to_NetworkBuffer_IPv6( void )
 
     TEST_ASSERT_EQUAL( pxNetBufferToReturn, pxNetworkBuffer );
 }
+
+/**
+ * @brief test_xIPRxChecksumInSoftware_Verified
+ * To validate that the checksums of a buffer marked as verified by the driver
+ * are not checked in software.
+ */
+void test_xIPRxChecksumInSoftware_Verified( void )
+{
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    BaseType_t xReturn;
+
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_VERIFIED;
+
+    xReturn = xIPRxChecksumInSoftware( &xNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xReturn );
+}
+
+/**
+ * @brief test_xIPRxChecksumInSoftware_InterfaceOffload
+ * To validate that the checksums of a buffer received on an interface that
+ * verifies all checksums are not checked in software.
+ */
+void test_xIPRxChecksumInSoftware_InterfaceOffload( void )
+{
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    NetworkInterface_t xInterface;
+    BaseType_t xReturn;
+
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( &xInterface, 0, sizeof( xInterface ) );
+    xInterface.bits.bRxChecksumOffload = pdTRUE_UNSIGNED;
+    xNetworkBuffer.pxInterface = &xInterface;
+
+    xReturn = xIPRxChecksumInSoftware( &xNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xReturn );
+}
+
+/**
+ * @brief test_xIPRxChecksumInSoftware_NotVerified
+ * To validate that the checksums must be checked in software when neither the
+ * driver nor the interface has verified them. Only the VERIFIED bit counts.
+ */
+void test_xIPRxChecksumInSoftware_NotVerified( void )
+{
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    NetworkInterface_t xInterface;
+    BaseType_t xReturn;
+
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( &xInterface, 0, sizeof( xInterface ) );
+    xInterface.bits.bTxChecksumOffload = pdTRUE_UNSIGNED;
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_NEEDED;
+
+    /* No interface. */
+    xReturn = xIPRxChecksumInSoftware( &xNetworkBuffer );
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+
+    /* An interface that only offloads outgoing checksums. */
+    xNetworkBuffer.pxInterface = &xInterface;
+    xReturn = xIPRxChecksumInSoftware( &xNetworkBuffer );
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+}
+
+/**
+ * @brief test_xIPTxChecksumInSoftware_InterfaceOffload
+ * To validate that ipBUFFER_CHECKSUM_NEEDED is set, and the other flags are
+ * kept, when the interface of the end-point inserts the checksums.
+ */
+void test_xIPTxChecksumInSoftware_InterfaceOffload( void )
+{
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    NetworkEndPoint_t xEndPoint;
+    NetworkInterface_t xInterface;
+    BaseType_t xReturn;
+
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( &xEndPoint, 0, sizeof( xEndPoint ) );
+    memset( &xInterface, 0, sizeof( xInterface ) );
+    xInterface.bits.bTxChecksumOffload = pdTRUE_UNSIGNED;
+    xEndPoint.pxNetworkInterface = &xInterface;
+    xNetworkBuffer.pxEndPoint = &xEndPoint;
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_VERIFIED;
+
+    xReturn = xIPTxChecksumInSoftware( &xNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xReturn );
+    TEST_ASSERT_EQUAL( ipBUFFER_CHECKSUM_VERIFIED | ipBUFFER_CHECKSUM_NEEDED, xNetworkBuffer.ucChecksumFlags );
+}
+
+/**
+ * @brief test_xIPTxChecksumInSoftware_NoOffload
+ * To validate that ipBUFFER_CHECKSUM_NEEDED is cleared, e.g. in a buffer that
+ * is sent again on another interface, when the checksums are calculated in
+ * software.
+ */
+void test_xIPTxChecksumInSoftware_NoOffload( void )
+{
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    NetworkEndPoint_t xEndPoint;
+    NetworkInterface_t xInterface;
+    BaseType_t xReturn;
+
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( &xEndPoint, 0, sizeof( xEndPoint ) );
+    memset( &xInterface, 0, sizeof( xInterface ) );
+    xInterface.bits.bRxChecksumOffload = pdTRUE_UNSIGNED;
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_NEEDED;
+
+    /* No end-point. */
+    xReturn = xIPTxChecksumInSoftware( &xNetworkBuffer );
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+    TEST_ASSERT_EQUAL( 0U, xNetworkBuffer.ucChecksumFlags );
+
+    /* An end-point without an interface. */
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_NEEDED;
+    xNetworkBuffer.pxEndPoint = &xEndPoint;
+    xReturn = xIPTxChecksumInSoftware( &xNetworkBuffer );
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+    TEST_ASSERT_EQUAL( 0U, xNetworkBuffer.ucChecksumFlags );
+
+    /* An interface that only offloads incoming checksums. */
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_NEEDED;
+    xEndPoint.pxNetworkInterface = &xInterface;
+    xReturn = xIPTxChecksumInSoftware( &xNetworkBuffer );
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+    TEST_ASSERT_EQUAL( 0U, xNetworkBuffer.ucChecksumFlags );
+}
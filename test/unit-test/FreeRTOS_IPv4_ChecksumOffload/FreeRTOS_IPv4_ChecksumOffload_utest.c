@@ -0,0 +1,264 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "FreeRTOSIPConfig.h"
+#include "mock_IPv4_ChecksumOffload_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_Routing.h"
+
+#include "FreeRTOS_IPv4.h"
+
+#include "catch_assert.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+const MACAddress_t xBroadcastMACAddress = { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } };
+
+static NetworkInterface_t xInterface;
+static NetworkBufferDescriptor_t xNetworkBuffer;
+static uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xInterface, 0, sizeof( xInterface ) );
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+}
+
+/* ============================== Test Helpers ============================== */
+
+/**
+ * @brief Prepare a broadcast IPv4 packet of the given protocol, carrying a
+ *        payload of 8 bytes and a wrong IP header checksum.
+ */
+static IPPacket_t * prvPreparePacket( uint8_t ucProtocol )
+{
+    IPPacket_t * pxIPPacket = ( IPPacket_t * ) ucEthBuffer;
+    IPHeader_t * pxIPHeader = &( pxIPPacket->xIPHeader );
+    size_t uxProtocolLength = ( ucProtocol == ipPROTOCOL_TCP ) ? ipSIZE_OF_TCP_HEADER : ipSIZE_OF_UDP_HEADER;
+    ProtocolHeaders_t * pxProtocolHeaders = ( ProtocolHeaders_t * ) &( ucEthBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER ] );
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthBuffer;
+    xNetworkBuffer.pxInterface = &xInterface;
+    xNetworkBuffer.xDataLength = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + uxProtocolLength + 8U;
+
+    memcpy( pxIPPacket->xEthernetHeader.xDestinationAddress.ucBytes, xBroadcastMACAddress.ucBytes, sizeof( MACAddress_t ) );
+    pxIPHeader->ucVersionHeaderLength = 0x45;
+    pxIPHeader->usLength = FreeRTOS_htons( ipSIZE_OF_IPv4_HEADER + uxProtocolLength + 8U );
+    pxIPHeader->ucProtocol = ucProtocol;
+    pxIPHeader->usHeaderChecksum = 0xABCD;
+    pxIPHeader->ulDestinationIPAddress = 0xFFFFFFFF;
+    pxIPHeader->ulSourceIPAddress = 0xC0C00101;
+
+    if( ucProtocol == ipPROTOCOL_UDP )
+    {
+        pxProtocolHeaders->xUDPHeader.usChecksum = 0x1234;
+    }
+    else
+    {
+        pxProtocolHeaders->xTCPHeader.usChecksum = 0x1234;
+    }
+
+    return pxIPPacket;
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief test_prvAllowIPPacketIPv4_VerifiedUDP
+ * To validate that the checksums of a UDP packet verified by the interface
+ * are not calculated again, only the length fields are checked.
+ */
+void test_prvAllowIPPacketIPv4_VerifiedUDP( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket = prvPreparePacket( ipPROTOCOL_UDP );
+
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_VERIFIED;
+
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAnyArgsAndReturn( NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( NULL );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdFALSE );
+
+    eResult = prvAllowIPPacketIPv4( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eProcessBuffer, eResult );
+}
+
+/**
+ * @brief test_prvAllowIPPacketIPv4_VerifiedTCP
+ * To validate that the checksums of a TCP packet verified by the interface
+ * are not calculated again.
+ */
+void test_prvAllowIPPacketIPv4_VerifiedTCP( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket = prvPreparePacket( ipPROTOCOL_TCP );
+
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_VERIFIED;
+
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAnyArgsAndReturn( NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( NULL );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdFALSE );
+
+    eResult = prvAllowIPPacketIPv4( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eProcessBuffer, eResult );
+}
+
+/**
+ * @brief test_prvAllowIPPacketIPv4_VerifiedBadLength
+ * To validate that a verified packet is dropped when its IP length field
+ * exceeds the number of bytes received.
+ */
+void test_prvAllowIPPacketIPv4_VerifiedBadLength( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket = prvPreparePacket( ipPROTOCOL_UDP );
+
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_VERIFIED;
+    xNetworkBuffer.xDataLength--;
+
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAnyArgsAndReturn( NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( NULL );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdFALSE );
+
+    eResult = prvAllowIPPacketIPv4( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eResult );
+}
+
+/**
+ * @brief test_prvAllowIPPacketIPv4_VerifiedUDPZeroChecksum
+ * To validate that a verified UDP packet without a checksum is dropped.
+ */
+void test_prvAllowIPPacketIPv4_VerifiedUDPZeroChecksum( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket = prvPreparePacket( ipPROTOCOL_UDP );
+    ProtocolHeaders_t * pxProtocolHeaders = ( ProtocolHeaders_t * ) &( ucEthBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER ] );
+
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_VERIFIED;
+    pxProtocolHeaders->xUDPHeader.usChecksum = 0U;
+
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAnyArgsAndReturn( NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( NULL );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdFALSE );
+
+    eResult = prvAllowIPPacketIPv4( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eResult );
+}
+
+/**
+ * @brief test_prvAllowIPPacketIPv4_NotVerifiedBadChecksum
+ * To validate that a packet that was not verified by the interface has its
+ * IP header checksum checked in software.
+ */
+void test_prvAllowIPPacketIPv4_NotVerifiedBadChecksum( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket = prvPreparePacket( ipPROTOCOL_UDP );
+
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAnyArgsAndReturn( NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( NULL );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdTRUE );
+    usGenerateChecksum_ExpectAndReturn( 0U, &( pxIPPacket->xIPHeader.ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER, ipCORRECT_CRC - 1 );
+
+    eResult = prvAllowIPPacketIPv4( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eResult );
+}
+
+/**
+ * @brief test_prvAllowIPPacketIPv4_NotVerifiedBadProtocolChecksum
+ * To validate that a packet that was not verified by the interface has its
+ * protocol checksum checked in software.
+ */
+void test_prvAllowIPPacketIPv4_NotVerifiedBadProtocolChecksum( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket = prvPreparePacket( ipPROTOCOL_TCP );
+
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAnyArgsAndReturn( NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( NULL );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdTRUE );
+    usGenerateChecksum_ExpectAndReturn( 0U, &( pxIPPacket->xIPHeader.ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER, ipCORRECT_CRC );
+    usGenerateProtocolChecksum_ExpectAndReturn( ucEthBuffer, xNetworkBuffer.xDataLength, pdFALSE, ipCORRECT_CRC + 1 );
+
+    eResult = prvAllowIPPacketIPv4( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eResult );
+}
+
+/**
+ * @brief test_prvAllowIPPacketIPv4_NotVerifiedHappyPath
+ * To validate that a packet that was not verified by the interface is
+ * accepted when both checksums are correct.
+ */
+void test_prvAllowIPPacketIPv4_NotVerifiedHappyPath( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket = prvPreparePacket( ipPROTOCOL_UDP );
+
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAnyArgsAndReturn( NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( NULL );
+    xIPRxChecksumInSoftware_ExpectAndReturn( &xNetworkBuffer, pdTRUE );
+    usGenerateChecksum_ExpectAndReturn( 0U, &( pxIPPacket->xIPHeader.ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER, ipCORRECT_CRC );
+    usGenerateProtocolChecksum_ExpectAndReturn( ucEthBuffer, xNetworkBuffer.xDataLength, pdFALSE, ipCORRECT_CRC );
+
+    eResult = prvAllowIPPacketIPv4( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eProcessBuffer, eResult );
+}
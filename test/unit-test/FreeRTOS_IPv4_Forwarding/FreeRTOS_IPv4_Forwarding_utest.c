@@ -0,0 +1,577 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_FreeRTOS_ARP.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_IPv4_Forwarding_stubs.c"
+#include "FreeRTOS_IPv4.h"
+#include "FreeRTOS_IPv4_Private.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/** @brief The addresses of the end-points and the hosts, host order. */
+#define TEST_INSIDE_ADDRESS      0xC0A80101U /* 192.168.1.1 */
+#define TEST_INSIDE_BROADCAST    0xC0A801FFU /* 192.168.1.255 */
+#define TEST_OUTSIDE_ADDRESS     0x0A000001U /* 10.0.0.1 */
+#define TEST_OUTSIDE_BROADCAST   0x0A0000FFU /* 10.0.0.255 */
+#define TEST_GATEWAY_ADDRESS     0x0A0000FEU /* 10.0.0.254 */
+#define TEST_SOURCE_ADDRESS      0xC0A8010AU /* 192.168.1.10 */
+#define TEST_REMOTE_ADDRESS      0xC6336402U /* 198.51.100.2 */
+
+/** @brief The TTL of the test packets. */
+#define TEST_TTL                 64U
+
+/** @brief The number of padding bytes after the test packets. */
+#define TEST_PADDING             4U
+
+#define TEST_IP_OFFSET           ipSIZE_OF_ETH_HEADER
+
+static const MACAddress_t xInsideMAC = { { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 } };
+static const MACAddress_t xOutsideMAC = { { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 } };
+static const MACAddress_t xSourceMAC = { { 0x02, 0x00, 0x00, 0x00, 0x00, 0x0A } };
+static const MACAddress_t xNextHopMAC = { { 0x02, 0x00, 0x00, 0x00, 0x00, 0xFE } };
+
+static NetworkInterface_t xInsideInterface;
+static NetworkInterface_t xOutsideInterface;
+static NetworkEndPoint_t xInsideEndPoint;
+static NetworkEndPoint_t xOutsideEndPoint;
+static NetworkBufferDescriptor_t xNetworkBuffer;
+
+/* Room for a packet of one byte more than the MTU. */
+static uint8_t ucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipconfigNETWORK_MTU + TEST_PADDING + 1U ];
+
+/** @brief What eARPGetCacheEntry() returns: the result, the next hop and the
+ *         end-point. */
+static eARPLookupResult_t eARPResult;
+static uint32_t ulARPNextHop;
+static NetworkEndPoint_t * pxARPEndPoint;
+
+/* ============================ Test Helpers ============================ */
+
+static eARPLookupResult_t eARPGetCacheEntry_Callback( uint32_t * pulIPAddress,
+                                                      MACAddress_t * const pxMACAddress,
+                                                      struct xNetworkEndPoint ** ppxEndPoint,
+                                                      int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), *pulIPAddress );
+
+    *pulIPAddress = ulARPNextHop;
+    memcpy( pxMACAddress->ucBytes, xNextHopMAC.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+    *ppxEndPoint = pxARPEndPoint;
+
+    return eARPResult;
+}
+
+/**
+ * @brief Fill the network buffer with a UDP packet that was received on the
+ *        inside interface, addressed to the MAC address of the inside end-point.
+ *
+ * @param[in] ulSource The source address, host order.
+ * @param[in] ulDestination The destination address, host order.
+ * @param[in] ucTimeToLive The TTL of the packet.
+ * @param[in] uxLength The length of the IP packet.
+ */
+static void prvSetPacket( uint32_t ulSource,
+                          uint32_t ulDestination,
+                          uint8_t ucTimeToLive,
+                          size_t uxLength )
+{
+    EthernetHeader_t * pxEthernetHeader = ( EthernetHeader_t * ) ucEthernetBuffer;
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+    size_t uxIndex;
+
+    memset( ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+
+    memcpy( pxEthernetHeader->xDestinationAddress.ucBytes, xInsideMAC.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+    memcpy( pxEthernetHeader->xSourceAddress.ucBytes, xSourceMAC.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+    pxEthernetHeader->usFrameType = ipIPv4_FRAME_TYPE;
+
+    pxIPHeader->ucVersionHeaderLength = ipIPV4_VERSION_HEADER_LENGTH_MIN;
+    pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) uxLength );
+    pxIPHeader->ucTimeToLive = ucTimeToLive;
+    pxIPHeader->ucProtocol = ipPROTOCOL_UDP;
+    pxIPHeader->ulSourceIPAddress = FreeRTOS_htonl( ulSource );
+    pxIPHeader->ulDestinationIPAddress = FreeRTOS_htonl( ulDestination );
+    pxIPHeader->usHeaderChecksum = ( uint16_t ) ~usGenerateChecksum_Callback( 0U, ( const uint8_t * ) pxIPHeader, ipSIZE_OF_IPv4_HEADER, 0 );
+
+    for( uxIndex = TEST_IP_OFFSET + ipSIZE_OF_IPv4_HEADER; uxIndex < ( TEST_IP_OFFSET + uxLength ); uxIndex++ )
+    {
+        ucEthernetBuffer[ uxIndex ] = ( uint8_t ) uxIndex;
+    }
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+    xNetworkBuffer.xDataLength = ipSIZE_OF_ETH_HEADER + uxLength + TEST_PADDING;
+    xNetworkBuffer.pxEndPoint = &xInsideEndPoint;
+    xNetworkBuffer.pxInterface = &xInsideInterface;
+}
+
+/**
+ * @brief Expect the lookups that decide that a packet to 'ulDestination'
+ *        is not for this host, and the lookup of its source address.
+ */
+static void prvExpectMustForward( uint32_t ulDestination,
+                                  uint32_t ulSource )
+{
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( ulDestination ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( &xInsideEndPoint );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( ulDestination ), NULL );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( ulSource ), NULL );
+}
+
+/**
+ * @brief Forward the packet in the network buffer, and check that it was
+ *        dropped unchanged.
+ */
+static void prvAssertDropped( void )
+{
+    uint8_t ucCopy[ sizeof( ucEthernetBuffer ) ];
+    size_t uxDataLength = xNetworkBuffer.xDataLength;
+
+    memcpy( ucCopy, ucEthernetBuffer, sizeof( ucEthernetBuffer ) );
+
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eIPv4ForwardPacket( &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER ) );
+
+    TEST_ASSERT_EQUAL( 0U, uxOutputCount );
+    TEST_ASSERT_EQUAL_MEMORY( ucCopy, ucEthernetBuffer, sizeof( ucEthernetBuffer ) );
+    TEST_ASSERT_EQUAL( uxDataLength, xNetworkBuffer.xDataLength );
+    TEST_ASSERT_EQUAL_PTR( &xInsideEndPoint, xNetworkBuffer.pxEndPoint );
+}
+
+/**
+ * @brief Check that a packet for this host is passed on unchanged.
+ */
+static void prvAssertForThisHost( void )
+{
+    uint8_t ucCopy[ sizeof( ucEthernetBuffer ) ];
+
+    memcpy( ucCopy, ucEthernetBuffer, sizeof( ucEthernetBuffer ) );
+
+    TEST_ASSERT_EQUAL( eProcessBuffer, eIPv4ForwardPacket( &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER ) );
+
+    TEST_ASSERT_EQUAL( 0U, uxOutputCount );
+    TEST_ASSERT_EQUAL_MEMORY( ucCopy, ucEthernetBuffer, sizeof( ucEthernetBuffer ) );
+}
+
+/**
+ * @brief Check that a packet of 'uxLength' bytes was sent to the next hop
+ *        through the outside interface, with a lower TTL.
+ */
+static void prvAssertForwarded( size_t uxLength )
+{
+    const EthernetHeader_t * pxEthernetHeader = ( const EthernetHeader_t * ) ucEthernetBuffer;
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+
+    TEST_ASSERT_EQUAL( 1U, uxOutputCount );
+    TEST_ASSERT_EQUAL_PTR( &xOutsideInterface, pxOutputInterface );
+    TEST_ASSERT_EQUAL_PTR( &xNetworkBuffer, pxOutputBuffer );
+    TEST_ASSERT_EQUAL_PTR( &xOutsideEndPoint, xNetworkBuffer.pxEndPoint );
+    TEST_ASSERT_EQUAL_PTR( &xOutsideInterface, xNetworkBuffer.pxInterface );
+
+    /* The padding is removed. */
+    TEST_ASSERT_EQUAL( ipSIZE_OF_ETH_HEADER + uxLength, xNetworkBuffer.xDataLength );
+
+    TEST_ASSERT_EQUAL_MEMORY( xNextHopMAC.ucBytes, pxEthernetHeader->xDestinationAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+    TEST_ASSERT_EQUAL_MEMORY( xOutsideMAC.ucBytes, pxEthernetHeader->xSourceAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+
+    TEST_ASSERT_EQUAL( TEST_TTL - 1U, pxIPHeader->ucTimeToLive );
+    TEST_ASSERT_EQUAL( ipPROTOCOL_UDP, pxIPHeader->ucProtocol );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_SOURCE_ADDRESS ), pxIPHeader->ulSourceIPAddress );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), pxIPHeader->ulDestinationIPAddress );
+    TEST_ASSERT_EQUAL_HEX16( ipCORRECT_CRC, usGenerateChecksum_Callback( 0U, ( const uint8_t * ) pxIPHeader, ipSIZE_OF_IPv4_HEADER, 0 ) );
+}
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xInsideInterface, 0, sizeof( xInsideInterface ) );
+    memset( &xOutsideInterface, 0, sizeof( xOutsideInterface ) );
+    memset( &xInsideEndPoint, 0, sizeof( xInsideEndPoint ) );
+    memset( &xOutsideEndPoint, 0, sizeof( xOutsideEndPoint ) );
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+
+    xInsideEndPoint.ipv4_settings.ulIPAddress = FreeRTOS_htonl( TEST_INSIDE_ADDRESS );
+    xInsideEndPoint.ipv4_settings.ulBroadcastAddress = FreeRTOS_htonl( TEST_INSIDE_BROADCAST );
+    xInsideEndPoint.bits.bEndPointUp = pdTRUE_UNSIGNED;
+    xInsideEndPoint.pxNetworkInterface = &xInsideInterface;
+    memcpy( xInsideEndPoint.xMACAddress.ucBytes, xInsideMAC.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+
+    xOutsideEndPoint.ipv4_settings.ulIPAddress = FreeRTOS_htonl( TEST_OUTSIDE_ADDRESS );
+    xOutsideEndPoint.ipv4_settings.ulBroadcastAddress = FreeRTOS_htonl( TEST_OUTSIDE_BROADCAST );
+    xOutsideEndPoint.bits.bEndPointUp = pdTRUE_UNSIGNED;
+    xOutsideEndPoint.pxNetworkInterface = &xOutsideInterface;
+    memcpy( xOutsideEndPoint.xMACAddress.ucBytes, xOutsideMAC.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+
+    uxOutputCount = 0U;
+    pxOutputInterface = NULL;
+    pxOutputBuffer = NULL;
+
+    eARPResult = eARPCacheHit;
+    ulARPNextHop = FreeRTOS_htonl( TEST_REMOTE_ADDRESS );
+    pxARPEndPoint = &xOutsideEndPoint;
+
+    usGenerateChecksum_Stub( usGenerateChecksum_Callback );
+    usIncrementalChecksum_Stub( usIncrementalChecksum_Callback );
+    xIPInterfaceOutput_Stub( xIPInterfaceOutput_Callback );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief A packet to a remote host gets the MAC addresses of the next hop and
+ *        of the outgoing end-point, a lower TTL and a correct checksum.
+ */
+void test_eIPv4ForwardPacket_Forwarded( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+    eARPGetCacheEntry_Stub( eARPGetCacheEntry_Callback );
+
+    TEST_ASSERT_EQUAL( eFrameConsumed, eIPv4ForwardPacket( &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER ) );
+
+    prvAssertForwarded( 100U );
+}
+
+/**
+ * @brief The checksum stays correct for every TTL, including the ones where
+ *        the incremental update has a carry.
+ */
+void test_eIPv4ForwardPacket_ChecksumAllTTLs( void )
+{
+    uint32_t ulTTL;
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+
+    for( ulTTL = 2U; ulTTL <= 255U; ulTTL++ )
+    {
+        uxOutputCount = 0U;
+        xNetworkBuffer.pxEndPoint = &xInsideEndPoint;
+        prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, ( uint8_t ) ulTTL, 20U + ( size_t ) ulTTL );
+        prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+        eARPGetCacheEntry_Stub( eARPGetCacheEntry_Callback );
+
+        TEST_ASSERT_EQUAL( eFrameConsumed, eIPv4ForwardPacket( &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER ) );
+
+        TEST_ASSERT_EQUAL( 1U, uxOutputCount );
+        TEST_ASSERT_EQUAL( ulTTL - 1U, pxIPHeader->ucTimeToLive );
+        TEST_ASSERT_EQUAL_HEX16( ipCORRECT_CRC, usGenerateChecksum_Callback( 0U, ( const uint8_t * ) pxIPHeader, ipSIZE_OF_IPv4_HEADER, 0 ) );
+    }
+}
+
+/**
+ * @brief A packet with a TTL of 1 would expire at the next hop, it is dropped
+ *        without a route lookup.
+ */
+void test_eIPv4ForwardPacket_TTLExpired( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, 1U, 100U );
+    prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief A packet with a TTL of 0 is dropped as well.
+ */
+void test_eIPv4ForwardPacket_TTLZero( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, 0U, 100U );
+    prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief The next hop is not in the ARP cache, and there is no end-point on
+ *        its network: the packet is dropped and nothing is sent.
+ */
+void test_eIPv4ForwardPacket_NoRoute( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+    eARPResult = eARPCacheMiss;
+    eARPGetCacheEntry_Stub( eARPGetCacheEntry_Callback );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief The ARP lookup can not find a way to send the packet, whatever it
+ *        left in the end-point.
+ */
+void test_eIPv4ForwardPacket_CantSendPacket( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+    eARPResult = eCantSendPacket;
+    eARPGetCacheEntry_Stub( eARPGetCacheEntry_Callback );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief The MAC address of the gateway is not known yet: it is asked for
+ *        through the end-point on its network, and the packet is dropped.
+ */
+void test_eIPv4ForwardPacket_CacheMiss_ARPRequest( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+    eARPResult = eARPCacheMiss;
+    ulARPNextHop = FreeRTOS_htonl( TEST_GATEWAY_ADDRESS );
+    eARPGetCacheEntry_Stub( eARPGetCacheEntry_Callback );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_GATEWAY_ADDRESS ), &xOutsideEndPoint );
+    vARPRefreshCacheEntry_Expect( NULL, FreeRTOS_htonl( TEST_GATEWAY_ADDRESS ), NULL );
+    FreeRTOS_OutputARPRequest_Multi_Expect( &xOutsideEndPoint, FreeRTOS_htonl( TEST_GATEWAY_ADDRESS ) );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief The outgoing end-point is down.
+ */
+void test_eIPv4ForwardPacket_EndPointDown( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+    xOutsideEndPoint.bits.bEndPointUp = pdFALSE_UNSIGNED;
+    eARPGetCacheEntry_Stub( eARPGetCacheEntry_Callback );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief A packet of exactly the MTU of the outgoing interface is forwarded.
+ */
+void test_eIPv4ForwardPacket_MTU( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, ipconfigNETWORK_MTU );
+    prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+    eARPGetCacheEntry_Stub( eARPGetCacheEntry_Callback );
+
+    TEST_ASSERT_EQUAL( eFrameConsumed, eIPv4ForwardPacket( &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER ) );
+
+    prvAssertForwarded( ipconfigNETWORK_MTU );
+}
+
+/**
+ * @brief A packet that is larger than the MTU of the outgoing interface is
+ *        dropped, packets are never fragmented.
+ */
+void test_eIPv4ForwardPacket_MTUExceeded( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, ipconfigNETWORK_MTU + 1U );
+    prvExpectMustForward( TEST_REMOTE_ADDRESS, TEST_SOURCE_ADDRESS );
+    eARPGetCacheEntry_Stub( eARPGetCacheEntry_Callback );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief A packet with a wrong IP header checksum is dropped.
+ */
+void test_eIPv4ForwardPacket_BadChecksum( void )
+{
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    pxIPHeader->usHeaderChecksum ^= 0x0101U;
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( &xInsideEndPoint );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief A packet whose length field is larger than the received data, or
+ *        smaller than its header, is dropped.
+ */
+void test_eIPv4ForwardPacket_BadLength( void )
+{
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    xNetworkBuffer.xDataLength = ipSIZE_OF_ETH_HEADER + 99U;
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( &xInsideEndPoint );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+
+    prvAssertDropped();
+
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    pxIPHeader->usLength = FreeRTOS_htons( ipSIZE_OF_IPv4_HEADER - 1U );
+    pxIPHeader->usHeaderChecksum = 0U;
+    pxIPHeader->usHeaderChecksum = ( uint16_t ) ~usGenerateChecksum_Callback( 0U, ( const uint8_t * ) pxIPHeader, ipSIZE_OF_IPv4_HEADER, 0 );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( &xInsideEndPoint );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief A packet with the source address of one of the end-points, or an
+ *        invalid source address, is dropped.
+ */
+void test_eIPv4ForwardPacket_BadSource( void )
+{
+    prvSetPacket( TEST_OUTSIDE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( &xInsideEndPoint );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_OUTSIDE_ADDRESS ), &xOutsideEndPoint );
+
+    prvAssertDropped();
+
+    prvSetPacket( 0U, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( &xInsideEndPoint );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+
+    prvAssertDropped();
+
+    prvSetPacket( TEST_INSIDE_BROADCAST, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( &xInsideEndPoint );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+
+    prvAssertDropped();
+}
+
+/**
+ * @brief A packet to one of the addresses of this host is not forwarded.
+ */
+void test_eIPv4ForwardPacket_ForThisHost( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_OUTSIDE_ADDRESS, TEST_TTL, 100U );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_OUTSIDE_ADDRESS ), &xOutsideEndPoint );
+
+    prvAssertForThisHost();
+}
+
+/**
+ * @brief A packet that is not addressed to the MAC address of an end-point is
+ *        not forwarded.
+ */
+void test_eIPv4ForwardPacket_OtherMAC( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( NULL );
+
+    prvAssertForThisHost();
+}
+
+/**
+ * @brief Broadcasts, multicasts and the directed broadcast of a connected
+ *        network are not forwarded.
+ */
+void test_eIPv4ForwardPacket_Broadcast( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, 0xFFFFFFFFU, TEST_TTL, 100U );
+    prvAssertForThisHost();
+
+    prvSetPacket( TEST_SOURCE_ADDRESS, 0xE0000001U, TEST_TTL, 100U );
+    prvAssertForThisHost();
+
+    prvSetPacket( TEST_SOURCE_ADDRESS, 0x7F000001U, TEST_TTL, 100U );
+    prvAssertForThisHost();
+
+    prvSetPacket( TEST_SOURCE_ADDRESS, 0U, TEST_TTL, 100U );
+    prvAssertForThisHost();
+
+    /* 10.0.0.128/25 would have 10.0.0.255 as well. */
+    prvSetPacket( TEST_SOURCE_ADDRESS, 0x0A0001FFU, TEST_TTL, 100U );
+    prvAssertForThisHost();
+
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_OUTSIDE_BROADCAST - 1U, TEST_TTL, 100U );
+    xOutsideEndPoint.ipv4_settings.ulBroadcastAddress = FreeRTOS_htonl( TEST_OUTSIDE_BROADCAST - 1U );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_OUTSIDE_BROADCAST - 1U ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( &xInsideEndPoint );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_OUTSIDE_BROADCAST - 1U ), &xOutsideEndPoint );
+    prvAssertForThisHost();
+}
+
+/**
+ * @brief A packet to an address on a connected network is forwarded when it
+ *        is not the broadcast address of that network.
+ */
+void test_eIPv4ForwardPacket_ConnectedNetwork( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), NULL );
+    FreeRTOS_FindEndPointOnMAC_ExpectAnyArgsAndReturn( &xInsideEndPoint );
+    FreeRTOS_FindEndPointOnNetMask_ExpectAndReturn( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), &xOutsideEndPoint );
+    FreeRTOS_FindEndPointOnIP_IPv4_ExpectAndReturn( FreeRTOS_htonl( TEST_SOURCE_ADDRESS ), NULL );
+    eARPGetCacheEntry_Stub( eARPGetCacheEntry_Callback );
+
+    TEST_ASSERT_EQUAL( eFrameConsumed, eIPv4ForwardPacket( &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER ) );
+
+    prvAssertForwarded( 100U );
+}
+
+/**
+ * @brief Packets that arrive on an IPv6 end-point, or on an end-point that is
+ *        down, are not forwarded.
+ */
+void test_eIPv4ForwardPacket_EndPointNotUsable( void )
+{
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    xInsideEndPoint.bits.bIPv6 = pdTRUE_UNSIGNED;
+    prvAssertForThisHost();
+
+    prvSetPacket( TEST_SOURCE_ADDRESS, TEST_REMOTE_ADDRESS, TEST_TTL, 100U );
+    xInsideEndPoint.bits.bIPv6 = pdFALSE_UNSIGNED;
+    xInsideEndPoint.bits.bEndPointUp = pdFALSE_UNSIGNED;
+    prvAssertForThisHost();
+}
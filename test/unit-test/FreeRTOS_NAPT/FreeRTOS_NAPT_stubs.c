@@ -0,0 +1,83 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include <unity.h>
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+/* =========================  EXTERN VARIABLES  ========================= */
+
+/** @brief The value returned by xTaskGetTickCount(). */
+static TickType_t xTickCount;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static TickType_t xTaskGetTickCount_Callback( int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return xTickCount;
+}
+
+static uint32_t FreeRTOS_min_uint32_Callback( uint32_t a,
+                                              uint32_t b,
+                                              int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return ( a <= b ) ? a : b;
+}
+
+/* The same as usIncrementalChecksum() in FreeRTOS_IP_Utils.c. */
+static uint16_t usIncrementalChecksum_Callback( uint16_t usChecksum,
+                                                uint16_t usOldWord,
+                                                uint16_t usNewWord,
+                                                int cmock_num_calls )
+{
+    uint32_t ulSum;
+
+    ( void ) cmock_num_calls;
+
+    ulSum = ( uint32_t ) ( ( uint16_t ) ~usChecksum ) +
+            ( uint32_t ) ( ( uint16_t ) ~usOldWord ) +
+            ( uint32_t ) usNewWord;
+
+    ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+    ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+
+    return ( uint16_t ) ~ulSum;
+}
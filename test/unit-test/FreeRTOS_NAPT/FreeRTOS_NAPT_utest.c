@@ -0,0 +1,770 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_NAPT_stubs.c"
+#include "FreeRTOS_ICMP.h"
+#include "FreeRTOS_NAPT.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+extern BaseType_t xNAPTInitialised;
+
+size_t prvNAPTHash( uint8_t ucProtocol,
+                    uint32_t ulInsideAddress,
+                    uint16_t usInsidePort,
+                    uint32_t ulRemoteAddress,
+                    uint16_t usRemotePort );
+
+/** @brief The first outside port handed out, as in FreeRTOS_NAPT.c. */
+#define TEST_FIRST_PORT         0x8000U
+
+/** @brief The addresses of the test hosts, host order. */
+#define TEST_PUBLIC_ADDRESS     0xCB007101U /* 203.0.113.1 */
+#define TEST_INSIDE_ADDRESS     0xC0A8010AU /* 192.168.1.10 */
+#define TEST_REMOTE_ADDRESS     0xC6336402U /* 198.51.100.2 */
+
+#define TEST_INSIDE_PORT        5000U
+#define TEST_REMOTE_PORT        80U
+
+/** @brief The number of payload bytes in the test packets. */
+#define TEST_PAYLOAD_LENGTH     8U
+
+#define TEST_IP_OFFSET          ipSIZE_OF_ETH_HEADER
+#define TEST_PROTOCOL_OFFSET    ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER )
+
+static NetworkEndPoint_t xOutsideEndPoint;
+static NetworkEndPoint_t xInsideEndPoint;
+static NetworkBufferDescriptor_t xNetworkBuffer;
+static uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU ];
+
+/* ============================ Test Helpers ============================ */
+
+/**
+ * @brief Add bytes to a one's complement sum, in memory order.
+ */
+static uint32_t prvSum( const uint8_t * pucData,
+                        size_t uxLength,
+                        uint32_t ulSum )
+{
+    size_t uxIndex;
+    uint8_t ucWord[ 2 ];
+    uint16_t usWord;
+
+    for( uxIndex = 0U; uxIndex < uxLength; uxIndex += 2U )
+    {
+        ucWord[ 0 ] = pucData[ uxIndex ];
+        ucWord[ 1 ] = ( ( uxIndex + 1U ) < uxLength ) ? pucData[ uxIndex + 1U ] : 0U;
+        memcpy( &usWord, ucWord, sizeof( usWord ) );
+        ulSum += usWord;
+    }
+
+    return ulSum;
+}
+
+static uint16_t prvFold( uint32_t ulSum )
+{
+    while( ( ulSum >> 16 ) != 0U )
+    {
+        ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+    }
+
+    return ( uint16_t ) ulSum;
+}
+
+/**
+ * @brief The sum of the header and the payload of the protocol, with the
+ *        pseudo header for TCP and UDP.
+ */
+static uint16_t prvProtocolSum( void )
+{
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+    size_t uxLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usLength ) - ipSIZE_OF_IPv4_HEADER;
+    uint8_t ucPseudo[ 12 ];
+    uint16_t usLength = FreeRTOS_htons( ( uint16_t ) uxLength );
+    uint32_t ulSum = 0U;
+
+    if( pxIPHeader->ucProtocol != ipPROTOCOL_ICMP )
+    {
+        memcpy( &( ucPseudo[ 0 ] ), &( pxIPHeader->ulSourceIPAddress ), 4U );
+        memcpy( &( ucPseudo[ 4 ] ), &( pxIPHeader->ulDestinationIPAddress ), 4U );
+        ucPseudo[ 8 ] = 0U;
+        ucPseudo[ 9 ] = pxIPHeader->ucProtocol;
+        memcpy( &( ucPseudo[ 10 ] ), &usLength, 2U );
+        ulSum = prvSum( ucPseudo, sizeof( ucPseudo ), ulSum );
+    }
+
+    return prvFold( prvSum( &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] ), uxLength, ulSum ) );
+}
+
+/**
+ * @brief Check that the IP header checksum and the checksum of the protocol
+ *        are correct.
+ */
+static void prvAssertChecksums( void )
+{
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+    const ProtocolHeaders_t * pxProtocolHeaders = ( const ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] );
+
+    TEST_ASSERT_EQUAL_HEX16( 0xFFFFU, prvFold( prvSum( &( ucEthernetBuffer[ TEST_IP_OFFSET ] ), ipSIZE_OF_IPv4_HEADER, 0U ) ) );
+
+    if( ( pxIPHeader->ucProtocol != ipPROTOCOL_UDP ) || ( pxProtocolHeaders->xUDPHeader.usChecksum != 0U ) )
+    {
+        TEST_ASSERT_EQUAL_HEX16( 0xFFFFU, prvProtocolSum() );
+    }
+}
+
+/**
+ * @brief Fill the network buffer with a packet with correct checksums.
+ *
+ * @param[in] ucProtocol ipPROTOCOL_TCP, ipPROTOCOL_UDP or ipPROTOCOL_ICMP.
+ * @param[in] ulSource The source address, host order.
+ * @param[in] usSourcePort The source port, or the ICMP identifier.
+ * @param[in] ulDestination The destination address, host order.
+ * @param[in] usDestinationPort The destination port, or the ICMP type.
+ * @param[in] ucTCPFlags The TCP flags.
+ */
+static void prvSetPacket( uint8_t ucProtocol,
+                          uint32_t ulSource,
+                          uint16_t usSourcePort,
+                          uint32_t ulDestination,
+                          uint16_t usDestinationPort,
+                          uint8_t ucTCPFlags )
+{
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+    ProtocolHeaders_t * pxProtocolHeaders = ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] );
+    size_t uxHeaderLength;
+    size_t uxIndex;
+    uint16_t usChecksum;
+
+    memset( ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+
+    switch( ucProtocol )
+    {
+        case ipPROTOCOL_TCP:
+            uxHeaderLength = ipSIZE_OF_TCP_HEADER;
+            pxProtocolHeaders->xTCPHeader.usSourcePort = FreeRTOS_htons( usSourcePort );
+            pxProtocolHeaders->xTCPHeader.usDestinationPort = FreeRTOS_htons( usDestinationPort );
+            pxProtocolHeaders->xTCPHeader.ucTCPOffset = 0x50U;
+            pxProtocolHeaders->xTCPHeader.ucTCPFlags = ucTCPFlags;
+            break;
+
+        case ipPROTOCOL_UDP:
+            uxHeaderLength = ipSIZE_OF_UDP_HEADER;
+            pxProtocolHeaders->xUDPHeader.usSourcePort = FreeRTOS_htons( usSourcePort );
+            pxProtocolHeaders->xUDPHeader.usDestinationPort = FreeRTOS_htons( usDestinationPort );
+            pxProtocolHeaders->xUDPHeader.usLength = FreeRTOS_htons( ( uint16_t ) ( ipSIZE_OF_UDP_HEADER + TEST_PAYLOAD_LENGTH ) );
+            break;
+
+        default:
+            uxHeaderLength = ipSIZE_OF_ICMPv4_HEADER;
+            pxProtocolHeaders->xICMPHeader.ucTypeOfMessage = ( uint8_t ) usDestinationPort;
+            pxProtocolHeaders->xICMPHeader.usIdentifier = FreeRTOS_htons( usSourcePort );
+            pxProtocolHeaders->xICMPHeader.usSequenceNumber = FreeRTOS_htons( 1U );
+            break;
+    }
+
+    for( uxIndex = 0U; uxIndex < TEST_PAYLOAD_LENGTH; uxIndex++ )
+    {
+        ucEthernetBuffer[ TEST_PROTOCOL_OFFSET + uxHeaderLength + uxIndex ] = ( uint8_t ) ( 0x31U + uxIndex );
+    }
+
+    pxIPHeader->ucVersionHeaderLength = ipIPV4_VERSION_HEADER_LENGTH_MIN;
+    pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( ipSIZE_OF_IPv4_HEADER + uxHeaderLength + TEST_PAYLOAD_LENGTH ) );
+    pxIPHeader->ucTimeToLive = 64U;
+    pxIPHeader->ucProtocol = ucProtocol;
+    pxIPHeader->ulSourceIPAddress = FreeRTOS_htonl( ulSource );
+    pxIPHeader->ulDestinationIPAddress = FreeRTOS_htonl( ulDestination );
+    pxIPHeader->usHeaderChecksum = ( uint16_t ) ~prvFold( prvSum( &( ucEthernetBuffer[ TEST_IP_OFFSET ] ), ipSIZE_OF_IPv4_HEADER, 0U ) );
+
+    usChecksum = ( uint16_t ) ~prvProtocolSum();
+
+    switch( ucProtocol )
+    {
+        case ipPROTOCOL_TCP:
+            pxProtocolHeaders->xTCPHeader.usChecksum = usChecksum;
+            break;
+
+        case ipPROTOCOL_UDP:
+            pxProtocolHeaders->xUDPHeader.usChecksum = usChecksum;
+            break;
+
+        default:
+            pxProtocolHeaders->xICMPHeader.usChecksum = usChecksum;
+            break;
+    }
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+    xNetworkBuffer.xDataLength = TEST_PROTOCOL_OFFSET + uxHeaderLength + TEST_PAYLOAD_LENGTH;
+    xNetworkBuffer.pxEndPoint = &( xInsideEndPoint );
+
+    prvAssertChecksums();
+}
+
+/**
+ * @brief Forward a packet from an inside host to a remote host through the
+ *        outside end-point.
+ *
+ * @return The outside port, host order, or zero when the packet was dropped.
+ */
+static uint16_t prvOutbound( uint8_t ucProtocol,
+                             uint32_t ulInside,
+                             uint16_t usInsidePort,
+                             uint16_t usRemotePort,
+                             uint8_t ucTCPFlags )
+{
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+    const ProtocolHeaders_t * pxProtocolHeaders = ( const ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] );
+    uint16_t usReturn = 0U;
+
+    prvSetPacket( ucProtocol, ulInside, usInsidePort, TEST_REMOTE_ADDRESS, usRemotePort, ucTCPFlags );
+
+    if( xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) != pdFALSE )
+    {
+        TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_PUBLIC_ADDRESS ), pxIPHeader->ulSourceIPAddress );
+        TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), pxIPHeader->ulDestinationIPAddress );
+        prvAssertChecksums();
+
+        switch( ucProtocol )
+        {
+            case ipPROTOCOL_TCP:
+                usReturn = FreeRTOS_ntohs( pxProtocolHeaders->xTCPHeader.usSourcePort );
+                TEST_ASSERT_EQUAL( usRemotePort, FreeRTOS_ntohs( pxProtocolHeaders->xTCPHeader.usDestinationPort ) );
+                break;
+
+            case ipPROTOCOL_UDP:
+                usReturn = FreeRTOS_ntohs( pxProtocolHeaders->xUDPHeader.usSourcePort );
+                TEST_ASSERT_EQUAL( usRemotePort, FreeRTOS_ntohs( pxProtocolHeaders->xUDPHeader.usDestinationPort ) );
+                break;
+
+            default:
+                usReturn = FreeRTOS_ntohs( pxProtocolHeaders->xICMPHeader.usIdentifier );
+                break;
+        }
+    }
+
+    return usReturn;
+}
+
+/**
+ * @brief Let the remote host send a reply to an outside port.
+ *
+ * @return pdTRUE when the reply was translated to the inside host.
+ */
+static BaseType_t prvInbound( uint8_t ucProtocol,
+                              uint16_t usRemotePort,
+                              uint16_t usOutsidePort,
+                              uint8_t ucTCPFlags )
+{
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+    BaseType_t xReturn = pdFALSE;
+
+    prvSetPacket( ucProtocol, TEST_REMOTE_ADDRESS, usRemotePort, TEST_PUBLIC_ADDRESS, usOutsidePort, ucTCPFlags );
+
+    if( ucProtocol == ipPROTOCOL_ICMP )
+    {
+        ProtocolHeaders_t * pxProtocolHeaders = ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] );
+
+        /* An echo reply carries the identifier of the request. */
+        prvSetPacket( ucProtocol, TEST_REMOTE_ADDRESS, usOutsidePort, TEST_PUBLIC_ADDRESS, usRemotePort, 0U );
+        TEST_ASSERT_EQUAL( usRemotePort, pxProtocolHeaders->xICMPHeader.ucTypeOfMessage );
+    }
+
+    xNetworkBuffer.pxEndPoint = &( xOutsideEndPoint );
+
+    vNAPTInbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER );
+    prvAssertChecksums();
+
+    if( pxIPHeader->ulDestinationIPAddress != FreeRTOS_htonl( TEST_PUBLIC_ADDRESS ) )
+    {
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+
+/**
+ * @brief Find another inside address whose UDP connection to the remote host
+ *        uses the same hash bucket as the one of TEST_INSIDE_ADDRESS.
+ */
+static uint32_t prvCollidingAddress( void )
+{
+    size_t uxBucket = prvNAPTHash( ipPROTOCOL_UDP, FreeRTOS_htonl( TEST_INSIDE_ADDRESS ), FreeRTOS_htons( TEST_INSIDE_PORT ),
+                                   FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), FreeRTOS_htons( 53U ) );
+    uint32_t ulAddress = TEST_INSIDE_ADDRESS + 1U;
+
+    while( prvNAPTHash( ipPROTOCOL_UDP, FreeRTOS_htonl( ulAddress ), FreeRTOS_htons( TEST_INSIDE_PORT ),
+                        FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), FreeRTOS_htons( 53U ) ) != uxBucket )
+    {
+        ulAddress++;
+    }
+
+    return ulAddress;
+}
+
+/**
+ * @brief Let the tick count advance by a number of seconds.
+ */
+static void prvAdvanceSeconds( uint32_t ulSeconds )
+{
+    xTickCount += pdMS_TO_TICKS( ulSeconds * 1000U );
+}
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &( xOutsideEndPoint ), 0, sizeof( xOutsideEndPoint ) );
+    memset( &( xInsideEndPoint ), 0, sizeof( xInsideEndPoint ) );
+    memset( &( xNetworkBuffer ), 0, sizeof( xNetworkBuffer ) );
+    xOutsideEndPoint.ipv4_settings.ulIPAddress = FreeRTOS_htonl( TEST_PUBLIC_ADDRESS );
+    xInsideEndPoint.ipv4_settings.ulIPAddress = FreeRTOS_htonl( 0xC0A80101U );
+
+    xTaskGetTickCount_Stub( xTaskGetTickCount_Callback );
+    FreeRTOS_min_uint32_Stub( FreeRTOS_min_uint32_Callback );
+    usIncrementalChecksum_Stub( usIncrementalChecksum_Callback );
+
+    /* Start with an empty table. */
+    xTickCount = 0x10000U;
+    xNAPTInitialised = pdFALSE;
+    FreeRTOS_SetNAPTEndPoint( &( xOutsideEndPoint ) );
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief An outbound TCP packet gets the public address and an outside port,
+ *        and the reply gets the address and port of the inside host.
+ */
+void test_xNAPTOutbound_TCP( void )
+{
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+    const ProtocolHeaders_t * pxProtocolHeaders = ( const ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] );
+    uint16_t usPort = prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN );
+
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, usPort );
+
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_TCP, TEST_REMOTE_PORT, usPort, tcpTCP_FLAG_SYN | tcpTCP_FLAG_ACK ) );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_INSIDE_ADDRESS ), pxIPHeader->ulDestinationIPAddress );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_REMOTE_ADDRESS ), pxIPHeader->ulSourceIPAddress );
+    TEST_ASSERT_EQUAL( TEST_INSIDE_PORT, FreeRTOS_ntohs( pxProtocolHeaders->xTCPHeader.usDestinationPort ) );
+    TEST_ASSERT_EQUAL( TEST_REMOTE_PORT, FreeRTOS_ntohs( pxProtocolHeaders->xTCPHeader.usSourcePort ) );
+}
+
+/**
+ * @brief UDP packets are translated in both directions.
+ */
+void test_xNAPTOutbound_UDP( void )
+{
+    const ProtocolHeaders_t * pxProtocolHeaders = ( const ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] );
+    uint16_t usPort = prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U );
+
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, usPort );
+
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_UDP, 53U, usPort, 0U ) );
+    TEST_ASSERT_EQUAL( TEST_INSIDE_PORT, FreeRTOS_ntohs( pxProtocolHeaders->xUDPHeader.usDestinationPort ) );
+}
+
+/**
+ * @brief A UDP packet without a checksum keeps a zero checksum.
+ */
+void test_xNAPTOutbound_UDPWithoutChecksum( void )
+{
+    ProtocolHeaders_t * pxProtocolHeaders = ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] );
+
+    prvSetPacket( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_ADDRESS, 53U, 0U );
+    pxProtocolHeaders->xUDPHeader.usChecksum = 0U;
+
+    TEST_ASSERT_EQUAL( pdTRUE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, FreeRTOS_ntohs( pxProtocolHeaders->xUDPHeader.usSourcePort ) );
+    TEST_ASSERT_EQUAL( 0U, pxProtocolHeaders->xUDPHeader.usChecksum );
+    prvAssertChecksums();
+}
+
+/**
+ * @brief A translated UDP checksum of zero is sent as 0xFFFF, zero means that
+ *        there is no checksum.
+ */
+void test_xNAPTOutbound_UDPChecksumZero( void )
+{
+    ProtocolHeaders_t * pxProtocolHeaders = ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] );
+    uint16_t usTranslated;
+    uint16_t usWord;
+
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U ) );
+    usTranslated = pxProtocolHeaders->xUDPHeader.usChecksum;
+
+    /* Change the payload so that the translated checksum becomes zero. */
+    prvSetPacket( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_ADDRESS, 53U, 0U );
+    memcpy( &usWord, &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET + ipSIZE_OF_UDP_HEADER ] ), sizeof( usWord ) );
+    usWord = prvFold( ( uint32_t ) usWord + usTranslated );
+    memcpy( &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET + ipSIZE_OF_UDP_HEADER ] ), &usWord, sizeof( usWord ) );
+    pxProtocolHeaders->xUDPHeader.usChecksum = prvFold( ( uint32_t ) pxProtocolHeaders->xUDPHeader.usChecksum + ( uint16_t ) ~usTranslated );
+    prvAssertChecksums();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) );
+    TEST_ASSERT_EQUAL_HEX16( 0xFFFFU, pxProtocolHeaders->xUDPHeader.usChecksum );
+    prvAssertChecksums();
+}
+
+/**
+ * @brief The identifier of an echo request is translated, and the echo
+ *        reply gets the identifier of the inside host.
+ */
+void test_xNAPTOutbound_ICMPEcho( void )
+{
+    const ProtocolHeaders_t * pxProtocolHeaders = ( const ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_PROTOCOL_OFFSET ] );
+    uint16_t usPort = prvOutbound( ipPROTOCOL_ICMP, TEST_INSIDE_ADDRESS, 0x1234U, ipICMP_ECHO_REQUEST, 0U );
+
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, usPort );
+
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_ICMP, ipICMP_ECHO_REPLY, usPort, 0U ) );
+    TEST_ASSERT_EQUAL( 0x1234U, FreeRTOS_ntohs( pxProtocolHeaders->xICMPHeader.usIdentifier ) );
+
+    /* Another echo request to the outside port is not translated. */
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_ICMP, ipICMP_ECHO_REQUEST, usPort, 0U ) );
+}
+
+/**
+ * @brief ICMP messages other than echo requests can not be translated.
+ */
+void test_xNAPTOutbound_ICMPOther( void )
+{
+    TEST_ASSERT_EQUAL( 0U, prvOutbound( ipPROTOCOL_ICMP, TEST_INSIDE_ADDRESS, 0x1234U, ipICMP_ECHO_REPLY, 0U ) );
+}
+
+/**
+ * @brief Packets of the same connection get the same outside port, other
+ *        connections get other ports.
+ */
+void test_xNAPTOutbound_PortAllocation( void )
+{
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 1U, prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT + 1U, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 2U, prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS + 1U, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 3U, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, 0U ) );
+
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 1U, prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT + 1U, TEST_REMOTE_PORT, tcpTCP_FLAG_ACK ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 2U, prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS + 1U, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_ACK ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_ACK ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 3U, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, 0U ) );
+}
+
+/**
+ * @brief Connections that only differ in the inside address get their own
+ *        entries, also when they share a hash bucket.
+ */
+void test_xNAPTOutbound_SameBucket( void )
+{
+    uint32_t ulOther = prvCollidingAddress();
+
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 1U, prvOutbound( ipPROTOCOL_UDP, ulOther, TEST_INSIDE_PORT, 53U, 0U ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U ) );
+}
+
+/**
+ * @brief An expired entry is removed from its hash bucket before it is used
+ *        again.
+ */
+void test_xNAPTOutbound_ReuseInSameBucket( void )
+{
+    uint32_t ulOther = prvCollidingAddress();
+
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U ) );
+    prvAdvanceSeconds( ipconfigNAPT_UDP_TIMEOUT_SECONDS );
+
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, prvOutbound( ipPROTOCOL_UDP, ulOther, TEST_INSIDE_PORT, 53U, 0U ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 1U, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U ) );
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT, prvOutbound( ipPROTOCOL_UDP, ulOther, TEST_INSIDE_PORT, 53U, 0U ) );
+}
+
+/**
+ * @brief A new connection is dropped while all entries are in use.
+ */
+void test_xNAPTOutbound_TableFull( void )
+{
+    uint16_t usIndex;
+
+    for( usIndex = 0U; usIndex < ipconfigNAPT_ENTRIES; usIndex++ )
+    {
+        TEST_ASSERT_EQUAL( TEST_FIRST_PORT + usIndex, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT + usIndex, 53U, 0U ) );
+    }
+
+    TEST_ASSERT_EQUAL( 0U, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT + usIndex, 53U, 0U ) );
+
+    /* The existing connections are still translated. */
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 2U, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT + 2U, 53U, 0U ) );
+}
+
+/**
+ * @brief A reply is only translated when it matches the connection of the
+ *        outside port.
+ */
+void test_vNAPTInbound_NoMatch( void )
+{
+    uint16_t usPort = prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U );
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+
+    /* Another remote port, another protocol, an unused and an invalid port. */
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_UDP, 54U, usPort, 0U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_TCP, 53U, usPort, tcpTCP_FLAG_ACK ) );
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_UDP, 53U, usPort + 1U, 0U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_UDP, 53U, TEST_FIRST_PORT - 1U, 0U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_UDP, 53U, TEST_FIRST_PORT + ipconfigNAPT_ENTRIES, 0U ) );
+
+    /* Another remote host. */
+    prvSetPacket( ipPROTOCOL_UDP, TEST_REMOTE_ADDRESS + 1U, 53U, TEST_PUBLIC_ADDRESS, usPort, 0U );
+    vNAPTInbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_PUBLIC_ADDRESS ), pxIPHeader->ulDestinationIPAddress );
+
+    /* Sent to another address. */
+    prvSetPacket( ipPROTOCOL_UDP, TEST_REMOTE_ADDRESS, 53U, TEST_PUBLIC_ADDRESS + 1U, usPort, 0U );
+    vNAPTInbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_PUBLIC_ADDRESS + 1U ), pxIPHeader->ulDestinationIPAddress );
+
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_UDP, 53U, usPort, 0U ) );
+}
+
+/**
+ * @brief Packets that do not leave through the NAPT end-point, or that were
+ *        received on it, are not translated.
+ */
+void test_xNAPTOutbound_NotTranslated( void )
+{
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+
+    prvSetPacket( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_ADDRESS, 53U, 0U );
+    TEST_ASSERT_EQUAL( pdTRUE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xInsideEndPoint ) ) );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_INSIDE_ADDRESS ), pxIPHeader->ulSourceIPAddress );
+
+    xNetworkBuffer.pxEndPoint = &( xOutsideEndPoint );
+    TEST_ASSERT_EQUAL( pdTRUE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_INSIDE_ADDRESS ), pxIPHeader->ulSourceIPAddress );
+}
+
+/**
+ * @brief Nothing is translated after FreeRTOS_SetNAPTEndPoint( NULL ).
+ */
+void test_FreeRTOS_SetNAPTEndPoint_Disable( void )
+{
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+    uint16_t usPort = prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U );
+
+    FreeRTOS_SetNAPTEndPoint( NULL );
+
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_UDP, 53U, usPort, 0U ) );
+
+    prvSetPacket( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_ADDRESS, 53U, 0U );
+    TEST_ASSERT_EQUAL( pdTRUE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_htonl( TEST_INSIDE_ADDRESS ), pxIPHeader->ulSourceIPAddress );
+}
+
+/**
+ * @brief Only an IPv4 end-point can be the NAPT end-point.
+ */
+void test_FreeRTOS_SetNAPTEndPoint_IPv6( void )
+{
+    xOutsideEndPoint.bits.bIPv6 = pdTRUE_UNSIGNED;
+
+    catch_assert( FreeRTOS_SetNAPTEndPoint( &( xOutsideEndPoint ) ) );
+}
+
+/**
+ * @brief Fragments, short packets and other protocols are dropped.
+ */
+void test_xNAPTOutbound_CanNotTranslate( void )
+{
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucEthernetBuffer[ TEST_IP_OFFSET ] );
+
+    prvSetPacket( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_ADDRESS, 53U, 0U );
+    pxIPHeader->usFragmentOffset = ipFRAGMENT_FLAGS_MORE_FRAGMENTS;
+    TEST_ASSERT_EQUAL( pdFALSE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) );
+
+    pxIPHeader->usFragmentOffset = FreeRTOS_htons( 1U );
+    TEST_ASSERT_EQUAL( pdFALSE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) );
+
+    /* The DF flag is no problem. */
+    pxIPHeader->usFragmentOffset = ipFRAGMENT_FLAGS_DONT_FRAGMENT;
+    TEST_ASSERT_EQUAL( pdTRUE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) );
+
+    prvSetPacket( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_ADDRESS, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN );
+    xNetworkBuffer.xDataLength = TEST_PROTOCOL_OFFSET + ipSIZE_OF_TCP_HEADER - 1U;
+    TEST_ASSERT_EQUAL( pdFALSE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) );
+
+    prvSetPacket( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_ADDRESS, 53U, 0U );
+    pxIPHeader->ucProtocol = 47U; /* GRE */
+    TEST_ASSERT_EQUAL( pdFALSE, xNAPTOutbound( &( xNetworkBuffer ), ipSIZE_OF_IPv4_HEADER, &( xOutsideEndPoint ) ) );
+
+    /* Only the echo request above got an entry. */
+    TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 1U, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT + 1U, 53U, 0U ) );
+}
+
+/**
+ * @brief An idle UDP entry expires after ipconfigNAPT_UDP_TIMEOUT_SECONDS,
+ *        and its port is used again.
+ */
+void test_vNAPTInbound_UDPExpiry( void )
+{
+    uint16_t usPort = prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U );
+
+    prvAdvanceSeconds( ipconfigNAPT_UDP_TIMEOUT_SECONDS - 1U );
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_UDP, 53U, usPort, 0U ) );
+
+    /* The reply refreshed the entry. */
+    prvAdvanceSeconds( ipconfigNAPT_UDP_TIMEOUT_SECONDS - 1U );
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_UDP, 53U, usPort, 0U ) );
+
+    prvAdvanceSeconds( ipconfigNAPT_UDP_TIMEOUT_SECONDS );
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_UDP, 53U, usPort, 0U ) );
+
+    /* A new connection gets the same port. */
+    TEST_ASSERT_EQUAL( usPort, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS + 1U, TEST_INSIDE_PORT, 53U, 0U ) );
+}
+
+/**
+ * @brief An outbound packet refreshes the entry as well.
+ */
+void test_xNAPTOutbound_Refresh( void )
+{
+    uint16_t usPort = prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U );
+
+    prvAdvanceSeconds( ipconfigNAPT_UDP_TIMEOUT_SECONDS - 1U );
+    TEST_ASSERT_EQUAL( usPort, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U ) );
+
+    prvAdvanceSeconds( ipconfigNAPT_UDP_TIMEOUT_SECONDS - 1U );
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_UDP, 53U, usPort, 0U ) );
+}
+
+/**
+ * @brief A TCP entry lives longer than one turn of the timer wheel.
+ */
+void test_vNAPTInbound_TCPExpiry( void )
+{
+    uint16_t usPort = prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN );
+    uint32_t ulSecond;
+
+    /* Check it every 10 seconds without refreshing it. */
+    for( ulSecond = 10U; ulSecond < ipconfigNAPT_TCP_TIMEOUT_SECONDS; ulSecond += 10U )
+    {
+        prvAdvanceSeconds( 10U );
+        TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_TCP, TEST_REMOTE_PORT + 1U, usPort, tcpTCP_FLAG_ACK ) );
+    }
+
+    prvAdvanceSeconds( ( ipconfigNAPT_TCP_TIMEOUT_SECONDS - ulSecond ) + 9U );
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_TCP, TEST_REMOTE_PORT, usPort, tcpTCP_FLAG_ACK ) );
+
+    prvAdvanceSeconds( ipconfigNAPT_TCP_TIMEOUT_SECONDS );
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_TCP, TEST_REMOTE_PORT, usPort, tcpTCP_FLAG_ACK ) );
+}
+
+/**
+ * @brief After a FIN, a TCP entry expires after the transitory timeout of
+ *        4 minutes. A new SYN restores the normal timeout.
+ */
+void test_vNAPTInbound_TCPClosing( void )
+{
+    uint16_t usPort = prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN );
+
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_TCP, TEST_REMOTE_PORT, usPort, tcpTCP_FLAG_FIN | tcpTCP_FLAG_ACK ) );
+
+    /* A SYN+ACK does not change the closing state. */
+    prvAdvanceSeconds( 239U );
+    TEST_ASSERT_EQUAL( usPort, prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN | tcpTCP_FLAG_ACK ) );
+    prvAdvanceSeconds( 240U );
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_TCP, TEST_REMOTE_PORT, usPort, tcpTCP_FLAG_ACK ) );
+
+    usPort = prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN );
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_TCP, TEST_REMOTE_PORT, usPort, tcpTCP_FLAG_RST ) );
+    TEST_ASSERT_EQUAL( usPort, prvOutbound( ipPROTOCOL_TCP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, TEST_REMOTE_PORT, tcpTCP_FLAG_SYN ) );
+
+    prvAdvanceSeconds( ipconfigNAPT_TCP_TIMEOUT_SECONDS - 1U );
+    TEST_ASSERT_EQUAL( pdTRUE, prvInbound( ipPROTOCOL_TCP, TEST_REMOTE_PORT, usPort, tcpTCP_FLAG_ACK ) );
+}
+
+/**
+ * @brief All entries expire after a long idle time, also when it is more
+ *        than a turn of the timer wheel.
+ */
+void test_xNAPTOutbound_LongIdle( void )
+{
+    uint16_t usIndex;
+
+    for( usIndex = 0U; usIndex < ipconfigNAPT_ENTRIES; usIndex++ )
+    {
+        TEST_ASSERT_EQUAL( TEST_FIRST_PORT + usIndex, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT + usIndex, 53U, 0U ) );
+    }
+
+    /* Exactly 20 turns of the wheel of 64 seconds. */
+    prvAdvanceSeconds( 1280U );
+
+    for( usIndex = 0U; usIndex < ipconfigNAPT_ENTRIES; usIndex++ )
+    {
+        TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_UDP, 53U, TEST_FIRST_PORT + usIndex, 0U ) );
+    }
+
+    for( usIndex = 0U; usIndex < ipconfigNAPT_ENTRIES; usIndex++ )
+    {
+        TEST_ASSERT_NOT_EQUAL( 0U, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS + 1U, TEST_INSIDE_PORT + usIndex, 53U, 0U ) );
+    }
+}
+
+/**
+ * @brief The time that is left after the last full second counts for the
+ *        next advance of the timer wheel.
+ */
+void test_xNAPTOutbound_PartialSeconds( void )
+{
+    uint16_t usPort = prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT, 53U, 0U );
+    uint32_t ulStep;
+
+    /* 20 steps of 1.5 seconds, other packets let the wheel advance. */
+    for( ulStep = 0U; ulStep < 20U; ulStep++ )
+    {
+        xTickCount += pdMS_TO_TICKS( 1500U );
+        TEST_ASSERT_EQUAL( TEST_FIRST_PORT + 1U, prvOutbound( ipPROTOCOL_UDP, TEST_INSIDE_ADDRESS, TEST_INSIDE_PORT + 1U, 53U, 0U ) );
+    }
+
+    TEST_ASSERT_EQUAL( pdFALSE, prvInbound( ipPROTOCOL_UDP, 53U, usPort, 0U ) );
+}
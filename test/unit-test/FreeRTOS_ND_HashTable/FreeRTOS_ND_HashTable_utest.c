@@ -0,0 +1,488 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IPv6.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IPv6_Utils.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_NetworkBufferManagement.h"
+
+#include "catch_assert.h"
+#include "FreeRTOS_ND_HashTable_stubs.c"
+#include "FreeRTOS_ND.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+/*  The ND cache. */
+extern NDCacheRow_t xNDCache[ ipconfigND_CACHE_ENTRIES ];
+
+extern eARPLookupResult_t prvNDCacheLookup( const IPv6_Address_t * pxAddressToLookup,
+                                            MACAddress_t * const pxMACAddress,
+                                            NetworkEndPoint_t ** ppxEndPoint );
+
+#define xHeaderSize    ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + sizeof( ICMPHeader_IPv6_t ) )
+
+static NetworkEndPoint_t xEndPoint;
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xEndPoint, 0, sizeof( xEndPoint ) );
+
+    /* Clears both the cache and its index. */
+    FreeRTOS_ClearND();
+}
+
+/* ======================== Helper Functions ========================= */
+
+/**
+ * @brief Fill in the address fe80::<ucLastByte>.  With 2 buckets, all odd
+ *        addresses share one bucket and all even addresses the other.
+ */
+static void prvSetIP( IPv6_Address_t * pxIPAddress,
+                      uint8_t ucLastByte )
+{
+    memset( pxIPAddress, 0, sizeof( *pxIPAddress ) );
+    pxIPAddress->ucBytes[ 0 ] = 0xfeU;
+    pxIPAddress->ucBytes[ 1 ] = 0x80U;
+    pxIPAddress->ucBytes[ 15 ] = ucLastByte;
+}
+
+/**
+ * @brief Store fe80::<ucLastByte> with a MAC-address that ends in ucMACByte.
+ */
+static void prvAddEntry( uint8_t ucLastByte,
+                         uint8_t ucMACByte )
+{
+    IPv6_Address_t xIPAddress;
+    MACAddress_t xMACAddress = { { 0x02U, 0x11U, 0x22U, 0x33U, 0x44U, 0x00U } };
+
+    xMACAddress.ucBytes[ 5 ] = ucMACByte;
+    prvSetIP( &xIPAddress, ucLastByte );
+    vNDRefreshCacheEntry( &xMACAddress, &xIPAddress, &xEndPoint );
+}
+
+/**
+ * @brief Fill all rows of the cache with fe80::1 onwards, the first one
+ *        being the least recently used.
+ */
+static void prvFillCache( void )
+{
+    BaseType_t x;
+
+    for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
+    {
+        prvAddEntry( ( uint8_t ) ( x + 1 ), ( uint8_t ) ( x + 1 ) );
+    }
+}
+
+/**
+ * @brief Look up fe80::<ucLastByte>.
+ *
+ * @return The last byte of the MAC-address, or zero when not found.
+ */
+static uint8_t prvLookup( uint8_t ucLastByte )
+{
+    IPv6_Address_t xIPAddress;
+    MACAddress_t xMACAddress;
+    NetworkEndPoint_t * pxEndPoint = NULL;
+    uint8_t ucReturn = 0U;
+
+    prvSetIP( &xIPAddress, ucLastByte );
+
+    if( prvNDCacheLookup( &xIPAddress, &xMACAddress, &pxEndPoint ) == eARPCacheHit )
+    {
+        TEST_ASSERT_EQUAL_PTR( &xEndPoint, pxEndPoint );
+        ucReturn = xMACAddress.ucBytes[ 5 ];
+    }
+
+    return ucReturn;
+}
+
+/**
+ * @brief Find the row that holds fe80::<ucLastByte> by scanning the table.
+ *
+ * @return The index of the row, or -1 when there is none.
+ */
+static BaseType_t prvFindRow( uint8_t ucLastByte )
+{
+    IPv6_Address_t xIPAddress;
+    BaseType_t x;
+    BaseType_t xRow = -1;
+
+    prvSetIP( &xIPAddress, ucLastByte );
+
+    for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
+    {
+        if( ( xNDCache[ x ].ucValid != ( uint8_t ) pdFALSE ) &&
+            ( memcmp( xNDCache[ x ].xIPAddress.ucBytes, xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) )
+        {
+            xRow = x;
+            break;
+        }
+    }
+
+    return xRow;
+}
+
+/**
+ * @brief Let an entry expire at the next call to vNDAgeCache().
+ */
+static void prvExpire( uint8_t ucLastByte )
+{
+    BaseType_t xRow = prvFindRow( ucLastByte );
+
+    TEST_ASSERT_TRUE( xRow >= 0 );
+    xNDCache[ xRow ].ucAge = 1U;
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief A refreshed entry can be found, and it starts in the REACHABLE state.
+ */
+void test_vNDRefreshCacheEntry_HashTable_AddAndFind( void )
+{
+    BaseType_t xRow;
+
+    prvAddEntry( 1U, 0x21U );
+
+    TEST_ASSERT_EQUAL_UINT8( 0x21U, prvLookup( 1U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 2U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 3U ) );
+
+    xRow = prvFindRow( 1U );
+    TEST_ASSERT_EQUAL( 0, xRow );
+    TEST_ASSERT_EQUAL( eNDStateReachable, xNDCache[ xRow ].ucState );
+    TEST_ASSERT_EQUAL( ipconfigMAX_ARP_AGE, xNDCache[ xRow ].ucAge );
+}
+
+/**
+ * @brief A new MAC-address for a known IPv6 address updates the same row.
+ */
+void test_vNDRefreshCacheEntry_HashTable_Update( void )
+{
+    prvAddEntry( 1U, 0x21U );
+    prvAddEntry( 1U, 0x22U );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 1U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x22U, prvLookup( 1U ) );
+
+    /* The second row was never used. */
+    prvAddEntry( 2U, 0x23U );
+    TEST_ASSERT_EQUAL( 1, prvFindRow( 2U ) );
+}
+
+/**
+ * @brief Entries that share a bucket can each be found, and the expiry of
+ *        one from the middle or the head of the chain leaves the others.
+ */
+void test_vNDAgeCache_HashTable_Collision( void )
+{
+    prvAddEntry( 1U, 0x01U );
+    prvAddEntry( 3U, 0x03U );
+    prvAddEntry( 5U, 0x05U );
+
+    TEST_ASSERT_EQUAL_UINT8( 0x01U, prvLookup( 1U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x03U, prvLookup( 3U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x05U, prvLookup( 5U ) );
+
+    /* The chain is ordered newest first: 5, 3, 1. */
+    prvExpire( 3U );
+    vNDAgeCache();
+
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 3U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x01U, prvLookup( 1U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x05U, prvLookup( 5U ) );
+
+    prvExpire( 5U );
+    vNDAgeCache();
+
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 5U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x01U, prvLookup( 1U ) );
+
+    prvExpire( 1U );
+    vNDAgeCache();
+
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 1U ) );
+}
+
+/**
+ * @brief A full cache replaces the least recently used entry.  Both
+ *        a look-up and a refresh count as a use.
+ */
+void test_vNDRefreshCacheEntry_HashTable_EvictLeastRecentlyUsed( void )
+{
+    prvFillCache();
+
+    TEST_ASSERT_EQUAL_UINT8( 1U, prvLookup( 1U ) );
+
+    prvAddEntry( 6U, 6U );
+
+    TEST_ASSERT_EQUAL( 1, prvFindRow( 6U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 2U ) );
+    TEST_ASSERT_EQUAL_UINT8( 1U, prvLookup( 1U ) );
+
+    prvAddEntry( 3U, 3U );
+    prvAddEntry( 7U, 7U );
+
+    TEST_ASSERT_EQUAL( 3, prvFindRow( 7U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 4U ) );
+    TEST_ASSERT_EQUAL_UINT8( 3U, prvLookup( 3U ) );
+}
+
+/**
+ * @brief The entry to be replaced is chosen by its last use, not by its age.
+ */
+void test_vNDRefreshCacheEntry_HashTable_EvictIgnoresAge( void )
+{
+    prvFillCache();
+
+    xNDCache[ prvFindRow( 2U ) ].ucAge = 1U;
+
+    prvAddEntry( 6U, 6U );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 6U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 1U ) );
+    TEST_ASSERT_EQUAL_UINT8( 2U, prvLookup( 2U ) );
+}
+
+/**
+ * @brief A row released by an expiry is used before any entry is replaced.
+ */
+void test_vNDAgeCache_HashTable_ReuseReleasedRow( void )
+{
+    prvFillCache();
+
+    prvExpire( 3U );
+    vNDAgeCache();
+
+    prvAddEntry( 6U, 6U );
+
+    TEST_ASSERT_EQUAL( 2, prvFindRow( 6U ) );
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 1U ) );
+    TEST_ASSERT_EQUAL( 1, prvFindRow( 2U ) );
+    TEST_ASSERT_EQUAL( 3, prvFindRow( 4U ) );
+
+    /* Now that there is no free row, the least recently used one goes. */
+    prvAddEntry( 7U, 7U );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 7U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 1U ) );
+}
+
+/**
+ * @brief The expiry of the most recently used entry keeps the order of the
+ *        others.
+ */
+void test_vNDAgeCache_HashTable_ExpireNewest( void )
+{
+    BaseType_t x;
+
+    prvFillCache();
+
+    prvExpire( 4U );
+    vNDAgeCache();
+
+    prvAddEntry( 6U, 6U );
+    TEST_ASSERT_EQUAL( 3, prvFindRow( 6U ) );
+
+    /* The rows are replaced in the order in which they were used, ending with
+     * the row that was reused. */
+    for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
+    {
+        prvAddEntry( ( uint8_t ) ( x + 0x11 ), ( uint8_t ) ( x + 0x11 ) );
+        TEST_ASSERT_EQUAL( x, prvFindRow( ( uint8_t ) ( x + 0x11 ) ) );
+    }
+
+    TEST_ASSERT_EQUAL( -1, prvFindRow( 6U ) );
+}
+
+/**
+ * @brief Clearing the cache empties the index as well.
+ */
+void test_FreeRTOS_ClearND_HashTable( void )
+{
+    prvFillCache();
+
+    FreeRTOS_ClearND();
+
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 1U ) );
+
+    prvAddEntry( 6U, 6U );
+
+    TEST_ASSERT_EQUAL( 0, prvFindRow( 6U ) );
+    TEST_ASSERT_EQUAL_UINT8( 6U, prvLookup( 6U ) );
+}
+
+/**
+ * @brief A REACHABLE entry becomes STALE after 3 periods and can still be
+ *        used.
+ */
+void test_vNDAgeCache_HashTable_ReachableToStale( void )
+{
+    BaseType_t xRow;
+
+    prvAddEntry( 1U, 1U );
+    xRow = prvFindRow( 1U );
+
+    vNDAgeCache();
+    vNDAgeCache();
+    TEST_ASSERT_EQUAL( eNDStateReachable, xNDCache[ xRow ].ucState );
+
+    vNDAgeCache();
+    TEST_ASSERT_EQUAL( eNDStateStale, xNDCache[ xRow ].ucState );
+    TEST_ASSERT_EQUAL_UINT8( 1U, prvLookup( 1U ) );
+}
+
+/**
+ * @brief A look-up of a STALE entry moves it to DELAY, and a look-up of
+ *        a REACHABLE entry does not change its state.
+ */
+void test_prvNDCacheLookup_HashTable_StaleToDelay( void )
+{
+    BaseType_t xRow;
+
+    prvAddEntry( 1U, 1U );
+    xRow = prvFindRow( 1U );
+
+    TEST_ASSERT_EQUAL_UINT8( 1U, prvLookup( 1U ) );
+    TEST_ASSERT_EQUAL( eNDStateReachable, xNDCache[ xRow ].ucState );
+
+    xNDCache[ xRow ].ucState = ( uint8_t ) eNDStateStale;
+    xNDCache[ xRow ].ucStateTimer = 0U;
+
+    TEST_ASSERT_EQUAL_UINT8( 1U, prvLookup( 1U ) );
+    TEST_ASSERT_EQUAL( eNDStateDelay, xNDCache[ xRow ].ucState );
+    TEST_ASSERT_EQUAL( 1U, xNDCache[ xRow ].ucStateTimer );
+}
+
+/**
+ * @brief DELAY moves to PROBE after one period, 3 unicast solicitations are
+ *        sent, and an unanswered PROBE deletes the entry.
+ */
+void test_vNDAgeCache_HashTable_ProbeUnanswered( void )
+{
+    BaseType_t xRow;
+
+    prvAddEntry( 1U, 1U );
+    xRow = prvFindRow( 1U );
+    xNDCache[ xRow ].ucState = ( uint8_t ) eNDStateDelay;
+    xNDCache[ xRow ].ucStateTimer = 1U;
+
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( xHeaderSize, 0U, NULL );
+    vNDAgeCache();
+    TEST_ASSERT_EQUAL( eNDStateProbe, xNDCache[ xRow ].ucState );
+
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( xHeaderSize, 0U, NULL );
+    vNDAgeCache();
+
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( xHeaderSize, 0U, NULL );
+    vNDAgeCache();
+    TEST_ASSERT_EQUAL_UINT8( 1U, prvLookup( 1U ) );
+
+    /* No answer to the third probe. */
+    vNDAgeCache();
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 1U ) );
+
+    prvAddEntry( 6U, 6U );
+    TEST_ASSERT_EQUAL( xRow, prvFindRow( 6U ) );
+}
+
+/**
+ * @brief An answer to a probe makes the entry REACHABLE again.
+ */
+void test_vNDRefreshCacheEntry_HashTable_ProbeAnswered( void )
+{
+    BaseType_t xRow;
+
+    prvAddEntry( 1U, 1U );
+    xRow = prvFindRow( 1U );
+    xNDCache[ xRow ].ucState = ( uint8_t ) eNDStateProbe;
+    xNDCache[ xRow ].ucStateTimer = 1U;
+
+    prvAddEntry( 1U, 1U );
+
+    TEST_ASSERT_EQUAL( eNDStateReachable, xNDCache[ xRow ].ucState );
+
+    /* No probe is sent, the entry stays. */
+    vNDAgeCache();
+    TEST_ASSERT_EQUAL_UINT8( 1U, prvLookup( 1U ) );
+}
+
+/**
+ * @brief A STALE entry that is not used is not probed, it expires when its
+ *        age runs out.
+ */
+void test_vNDAgeCache_HashTable_StaleExpires( void )
+{
+    BaseType_t xRow;
+
+    prvAddEntry( 1U, 1U );
+    xRow = prvFindRow( 1U );
+    xNDCache[ xRow ].ucState = ( uint8_t ) eNDStateStale;
+    xNDCache[ xRow ].ucStateTimer = 0U;
+    xNDCache[ xRow ].ucAge = 2U;
+
+    vNDAgeCache();
+    TEST_ASSERT_EQUAL_UINT8( 1U, prvLookup( 1U ) );
+
+    /* The look-up moved the entry to DELAY, put it back. */
+    xNDCache[ xRow ].ucState = ( uint8_t ) eNDStateStale;
+    xNDCache[ xRow ].ucStateTimer = 0U;
+
+    vNDAgeCache();
+    TEST_ASSERT_EQUAL( -1, prvFindRow( 1U ) );
+    TEST_ASSERT_EQUAL_UINT8( 0U, prvLookup( 1U ) );
+}
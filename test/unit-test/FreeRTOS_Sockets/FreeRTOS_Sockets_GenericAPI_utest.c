@@ -48,6 +48,7 @@
 #include "mock_FreeRTOS_IP_Private.h"
 #include "mock_NetworkBufferManagement.h"
 #include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
 #include "mock_FreeRTOS_IPv4_Sockets.h"
 #include "mock_FreeRTOS_IPv6_Sockets.h"
 #include "mock_FreeRTOS_Sockets.h"
@@ -1283,6 +1284,34 @@ void test_FreeRTOS_setsockopt_UDPMaxRxPacketsNonUDPSock( void )
     TEST_ASSERT_EQUAL( 0, xSocket.u.xUDP.uxMaxPackets );
 }
 
+/**
+ * @brief Selecting the drop-oldest policy for the waiting packets of a UDP socket.
+ */
+void test_FreeRTOS_setsockopt_UDPRxDropOldest( void )
+{
+    BaseType_t xReturn;
+    FreeRTOS_Socket_t xSocket;
+    int32_t lLevel;
+    int32_t lOptionName = FREERTOS_SO_UDP_RX_DROP_OLDEST;
+    BaseType_t xOptionValue = 5;
+    size_t uxOptionLength;
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+
+    xReturn = FreeRTOS_setsockopt( &xSocket, lLevel, lOptionName, &xOptionValue, uxOptionLength );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+    TEST_ASSERT_EQUAL( pdTRUE, xSocket.u.xUDP.xDropOldest );
+
+    xSocket.ucProtocol = FREERTOS_IPPROTO_TCP;
+
+    xReturn = FreeRTOS_setsockopt( &xSocket, lLevel, lOptionName, &xOptionValue, uxOptionLength );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+}
+
 /**
  * @brief Set UDP checksum option with NULL value.
  */
@@ -2245,6 +2274,118 @@ void test_FreeRTOS_setsockopt_InvalidOption( void )
     TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOPROTOOPT, xReturn );
 }
 
+/**
+ * @brief Getting an option of a NULL socket.
+ */
+void test_FreeRTOS_getsockopt_NULLSocket( void )
+{
+    BaseType_t xReturn;
+    TCPInfo_t xInfo;
+    size_t uxOptionLength = sizeof( xInfo );
+
+    xReturn = FreeRTOS_getsockopt( NULL, 0, FREERTOS_SO_TCP_INFO, &xInfo, &uxOptionLength );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+}
+
+/**
+ * @brief Getting an invalid option.
+ */
+void test_FreeRTOS_getsockopt_InvalidOption( void )
+{
+    BaseType_t xReturn;
+    FreeRTOS_Socket_t xSocket;
+    TCPInfo_t xInfo;
+    size_t uxOptionLength = sizeof( xInfo );
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+
+    xReturn = FreeRTOS_getsockopt( &xSocket, 0, FREERTOS_SO_RCVTIMEO, &xInfo, &uxOptionLength );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOPROTOOPT, xReturn );
+}
+
+/**
+ * @brief Getting the TCP statistics of a UDP socket, or with a buffer that is too small.
+ */
+void test_FreeRTOS_getsockopt_TCPInfo_Invalid( void )
+{
+    BaseType_t xReturn;
+    FreeRTOS_Socket_t xSocket;
+    TCPInfo_t xInfo;
+    size_t uxOptionLength = sizeof( xInfo );
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+    xReturn = FreeRTOS_getsockopt( &xSocket, 0, FREERTOS_SO_TCP_INFO, &xInfo, &uxOptionLength );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    xSocket.ucProtocol = FREERTOS_IPPROTO_TCP;
+    uxOptionLength = sizeof( xInfo ) - 1U;
+    xReturn = FreeRTOS_getsockopt( &xSocket, 0, FREERTOS_SO_TCP_INFO, &xInfo, &uxOptionLength );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+    TEST_ASSERT_EQUAL( sizeof( xInfo ) - 1U, uxOptionLength );
+}
+
+/**
+ * @brief Getting the TCP statistics of a connection.
+ */
+void test_FreeRTOS_getsockopt_TCPInfo( void )
+{
+    BaseType_t xReturn;
+    FreeRTOS_Socket_t xSocket;
+    TCPInfo_t xInfo;
+    size_t uxOptionLength = sizeof( xInfo ) + 4U;
+    uint8_t ucRxStream[ 64 ];
+    uint8_t ucTxStream[ 64 ];
+    TCPWindow_t * pxWindow = &( xSocket.u.xTCP.xTCPWindow );
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+
+    xSocket.ucProtocol = FREERTOS_IPPROTO_TCP;
+    xSocket.u.xTCP.eTCPState = eESTABLISHED;
+    xSocket.u.xTCP.usMSS = 1460U;
+    xSocket.u.xTCP.ulWindowSize = 5000U;
+    xSocket.u.xTCP.uxRxStreamSize = 2000U;
+    xSocket.u.xTCP.uxTxStreamSize = 3000U;
+    xSocket.u.xTCP.rxStream = ( StreamBuffer_t * ) ucRxStream;
+    xSocket.u.xTCP.txStream = ( StreamBuffer_t * ) ucTxStream;
+    pxWindow->lSRTT = 40;
+    pxWindow->xSize.ulRxWindowLength = 1460U;
+    pxWindow->xSize.ulTxWindowLength = 2920U;
+    pxWindow->ulRetransmitCount = 3U;
+    pxWindow->ulFastRetransmitCount = 2U;
+    pxWindow->tx.ulCurrentSequenceNumber = 1000U;
+    pxWindow->tx.ulHighestSequenceNumber = 1500U;
+
+    vTaskSuspendAll_Expect();
+    ulTCPWindowTxTimeout_ExpectAndReturn( pxWindow, 80U );
+    xSequenceGreaterThan_ExpectAndReturn( 1500U, 1000U, pdTRUE );
+    uxStreamBufferGetSize_ExpectAndReturn( xSocket.u.xTCP.rxStream, 100U );
+    uxStreamBufferGetSize_ExpectAndReturn( xSocket.u.xTCP.txStream, 200U );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    xReturn = FreeRTOS_getsockopt( &xSocket, 0, FREERTOS_SO_TCP_INFO, &xInfo, &uxOptionLength );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+    TEST_ASSERT_EQUAL( sizeof( xInfo ), uxOptionLength );
+    TEST_ASSERT_EQUAL( eESTABLISHED, xInfo.ucState );
+    TEST_ASSERT_EQUAL( 1460U, xInfo.usMSS );
+    TEST_ASSERT_EQUAL( 40U, xInfo.ulSRTT );
+    TEST_ASSERT_EQUAL( 80U, xInfo.ulRTO );
+    TEST_ASSERT_EQUAL( 3U, xInfo.ulRetransmits );
+    TEST_ASSERT_EQUAL( 2U, xInfo.ulFastRetransmits );
+    TEST_ASSERT_EQUAL( 500U, xInfo.ulBytesInFlight );
+    TEST_ASSERT_EQUAL( 1460U, xInfo.ulRxWindow );
+    TEST_ASSERT_EQUAL( 2920U, xInfo.ulTxWindow );
+    TEST_ASSERT_EQUAL( 5000U, xInfo.ulPeerWindow );
+    TEST_ASSERT_EQUAL( 2000U, xInfo.uxRxStreamSize );
+    TEST_ASSERT_EQUAL( 3000U, xInfo.uxTxStreamSize );
+    TEST_ASSERT_EQUAL( 100U, xInfo.uxRxCount );
+    TEST_ASSERT_EQUAL( 200U, xInfo.uxTxCount );
+}
+
 /**
  * @brief Translate 32-bit IP to string.
  */
@@ -840,6 +840,7 @@ void test_FreeRTOS_get_tx_head_NoStream( void )
 
     /* NULL stream. */
     xSocket.ucProtocol = FREERTOS_IPPROTO_TCP;
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAnyArgsAndReturn( ucStream );
     uxStreamBufferGetSpace_ExpectAndReturn( ( StreamBuffer_t * ) ucStream, uxRemainingSize );
     pucReturn = FreeRTOS_get_tx_head( &xSocket, &xLength );
@@ -1885,6 +1886,7 @@ void test_FreeRTOS_get_tx_base_InvalidParams( void )
 
     uxMallocSize = ( sizeof( *pxBuffer ) + uxLength ) - sizeof( pxBuffer->ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( uxMallocSize, NULL );
 
     vTCPStateChange_Expect( &xSocket, eCLOSE_WAIT );
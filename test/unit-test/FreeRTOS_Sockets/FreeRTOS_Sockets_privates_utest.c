@@ -2362,6 +2362,7 @@ void test_prvTCPSendCheck_InvalidValues( void )
     xSocket.u.xTCP.bits.bFinSent = pdFALSE_UNSIGNED;
     uxDataLength = 10;
     listLIST_ITEM_CONTAINER_ExpectAnyArgsAndReturn( &xBoundTCPSocketsList );
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAnyArgsAndReturn( NULL );
     vTCPStateChange_ExpectAnyArgs();
     lReturn = prvTCPSendCheck( &xSocket, uxDataLength );
@@ -2375,6 +2376,7 @@ void test_prvTCPSendCheck_InvalidValues( void )
     uxDataLength = 10;
     listLIST_ITEM_CONTAINER_ExpectAnyArgsAndReturn( &xBoundTCPSocketsList );
     size_t xSizeOfBufferRequested = ( ( sizeof( size_t ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( xLocalStreamBuffer ) ) - sizeof( xLocalStreamBuffer.ucArray );
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ucStream );
     lReturn = prvTCPSendCheck( &xSocket, uxDataLength );
     TEST_ASSERT_EQUAL( 1, lReturn );
@@ -2805,6 +2807,7 @@ void test_prvTCPCreateStream( void )
     xSocket.u.xTCP.usMSS = 2;
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( *pxReturn ) ) - sizeof( pxReturn->ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ( StreamBuffer_t * ) ucStream );
 
     pxReturn = prvTCPCreateStream( &xSocket, xIsInputStream );
@@ -2830,6 +2833,7 @@ void test_prvTCPCreateStream1( void )
     xSocket.u.xTCP.usMSS = 2;
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( *pxReturn ) ) - sizeof( pxReturn->ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ( StreamBuffer_t * ) ucStream );
 
     pxReturn = prvTCPCreateStream( &xSocket, xIsInputStream );
@@ -2858,6 +2862,7 @@ void test_prvTCPCreateStream_LowAndHighFieldsDefined( void )
 
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( *pxReturn ) ) - sizeof( pxReturn->ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ( StreamBuffer_t * ) ucStream );
 
     pxReturn = prvTCPCreateStream( &xSocket, xIsInputStream );
@@ -2888,6 +2893,7 @@ void test_lTCPAddRxdata_StreamCannotBeAllocated( void )
 
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( xStreamBuffer ) ) - sizeof( xStreamBuffer.ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, NULL );
 
     vTCPStateChange_Expect( &xSocket, eCLOSE_WAIT );
@@ -2920,6 +2926,7 @@ void test_lTCPAddRxdata_SteamCreationSuccessful_AllBytesAdded( void )
 
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( xStreamBuffer ) ) - sizeof( xStreamBuffer.ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ( StreamBuffer_t * ) ucStream );
 
     uxStreamBufferAdd_ExpectAndReturn( ( StreamBuffer_t * ) ucStream, uxOffset, pcData, ulByteCount, ulByteCount );
@@ -2955,6 +2962,7 @@ void test_lTCPAddRxdata_SteamCreationSuccessful_AllBytesNotAdded( void )
 
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( xStreamBuffer ) ) - sizeof( xStreamBuffer.ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ucStream );
 
     uxStreamBufferAdd_ExpectAndReturn( ( StreamBuffer_t * ) ucStream, uxOffset, pcData, ulByteCount, ulByteCount - 10 );
@@ -2991,6 +2999,7 @@ void test_lTCPAddRxdata_FrontSpaceLessThanLowMark( void )
 
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( xStreamBuffer ) ) - sizeof( xStreamBuffer.ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ucStream );
 
     uxStreamBufferAdd_ExpectAndReturn( ( StreamBuffer_t * ) ucStream, uxOffset, pcData, ulByteCount, ulByteCount - 10 );
@@ -3067,6 +3076,7 @@ void test_lTCPAddRxdata_HasValidHandler( void )
 
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( xStreamBuffer ) ) - sizeof( xStreamBuffer.ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ucStream );
 
     uxStreamBufferGetSize_ExpectAndReturn( ( StreamBuffer_t * ) ucStream, 0U );
@@ -3113,6 +3123,7 @@ void test_lTCPAddRxdata_HasValidHandler_DataNULL( void )
 
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( xStreamBuffer ) ) - sizeof( xStreamBuffer.ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ucStream );
 
     uxStreamBufferGetSize_ExpectAndReturn( ( StreamBuffer_t * ) ucStream, 0U );
@@ -3158,6 +3169,7 @@ void test_lTCPAddRxdata_HasValidHandler_NonZeroOffset( void )
 
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( xStreamBuffer ) ) - sizeof( xStreamBuffer.ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ucStream );
 
     uxStreamBufferGetSize_ExpectAndReturn( ( StreamBuffer_t * ) ucStream, 0U );
@@ -3201,6 +3213,7 @@ void test_lTCPAddRxdata_HasValidHandlerWithNonZeroSize( void )
 
     size_t xSizeOfBufferRequested = ( ( ( sizeof( size_t ) + xSocket.u.xTCP.uxRxStreamSize ) & ( ~( sizeof( size_t ) - 1U ) ) ) + sizeof( xStreamBuffer ) ) - sizeof( xStreamBuffer.ucArray );
 
+    uxStreamBufferLength_Stub( uxStubStreamBufferLength );
     pvPortMalloc_ExpectAndReturn( xSizeOfBufferRequested, ucStream );
 
     uxStreamBufferGetSize_ExpectAndReturn( ( StreamBuffer_t * ) ucStream, 10U );
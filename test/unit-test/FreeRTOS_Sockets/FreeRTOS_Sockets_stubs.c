@@ -87,6 +87,13 @@ static BaseType_t xStubApplicationGetRandomNumber( uint32_t * xRndNumber,
     return xRNGStatus;
 }
 
+static size_t uxStubStreamBufferLength( size_t uxCapacity,
+                                        int count )
+{
+    ( void ) count;
+    return ( uxCapacity + sizeof( size_t ) ) & ~( sizeof( size_t ) - 1U );
+}
+
 static void vpxListFindListItemWithValue_NotFound( void )
 {
     xIPIsNetworkTaskReady_ExpectAndReturn( pdFALSE );
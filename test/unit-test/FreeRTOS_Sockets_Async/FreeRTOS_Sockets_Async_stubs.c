@@ -0,0 +1,166 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include <unity.h>
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "list.h"
+
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+QueueHandle_t xNetworkEventQueue = NULL;
+
+BaseType_t xTCPWindowLoggingLevel = 0;
+
+/** @brief The number of times vPortFree() was called, and its last argument. */
+static size_t uxFreeCount;
+static void * pvLastFreed;
+
+/** @brief The eSocketAsyncEvent messages sent to the IP-task, and its ring. */
+static size_t uxEventsSent;
+static void * pvEventData;
+
+/** @brief When pdTRUE, xSendEventStructToIPTask() fails. */
+static BaseType_t xEventQueueFull;
+
+/** @brief The number of times xEventGroupSetBits() was called. */
+static size_t uxCompletionSignals;
+
+/* ======================== Stub Callback Functions ========================= */
+
+void vPortEnterCritical( void )
+{
+}
+void vPortExitCritical( void )
+{
+}
+
+/* The address conversions of FreeRTOS_IPv4_Sockets.c and FreeRTOS_IPv6_Sockets.c
+ * are not used by the tests. */
+BaseType_t FreeRTOS_inet_pton4( const char * pcSource,
+                                void * pvDestination )
+{
+    ( void ) pcSource;
+    ( void ) pvDestination;
+
+    return pdFAIL;
+}
+
+const char * FreeRTOS_inet_ntop4( const void * pvSource,
+                                  char * pcDestination,
+                                  socklen_t uxSize )
+{
+    ( void ) pvSource;
+    ( void ) pcDestination;
+    ( void ) uxSize;
+
+    return NULL;
+}
+
+BaseType_t FreeRTOS_inet_pton6( const char * pcSource,
+                                void * pvDestination )
+{
+    ( void ) pcSource;
+    ( void ) pvDestination;
+
+    return pdFAIL;
+}
+
+const char * FreeRTOS_inet_ntop6( const void * pvSource,
+                                  char * pcDestination,
+                                  socklen_t uxSize )
+{
+    ( void ) pvSource;
+    ( void ) pcDestination;
+    ( void ) uxSize;
+
+    return NULL;
+}
+
+void * pvPortMalloc_Callback( size_t xWantedSize,
+                              int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return malloc( xWantedSize );
+}
+
+/* The sockets of the tests are not allocated, only the rings are freed. */
+void vPortFree_Callback( void * pv,
+                         int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    uxFreeCount++;
+    pvLastFreed = pv;
+}
+
+BaseType_t xSendEventStructToIPTask_Callback( const IPStackEvent_t * pxEvent,
+                                              TickType_t uxTimeout,
+                                              int cmock_num_calls )
+{
+    BaseType_t xReturn = pdPASS;
+
+    ( void ) uxTimeout;
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_EQUAL( eSocketAsyncEvent, pxEvent->eEventType );
+
+    if( xEventQueueFull != pdFALSE )
+    {
+        xReturn = pdFAIL;
+    }
+    else
+    {
+        uxEventsSent++;
+        pvEventData = pxEvent->pvData;
+    }
+
+    return xReturn;
+}
+
+EventBits_t xEventGroupSetBits_Callback( EventGroupHandle_t xEventGroup,
+                                         const EventBits_t uxBitsToSet,
+                                         int cmock_num_calls )
+{
+    ( void ) xEventGroup;
+    ( void ) cmock_num_calls;
+
+    uxCompletionSignals++;
+
+    return uxBitsToSet;
+}
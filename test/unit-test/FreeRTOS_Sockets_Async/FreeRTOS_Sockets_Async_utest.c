@@ -0,0 +1,710 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_portable.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IPv4_Sockets.h"
+#include "mock_FreeRTOS_IPv6_Sockets.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_NetworkBufferManagement.h"
+
+#include "FreeRTOS_Sockets.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_Sockets_Async_stubs.c"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/** @brief The number of payload bytes in every datagram. */
+#define TEST_PAYLOAD_LENGTH    4U
+
+/** @brief The number of datagrams that a test can receive. */
+#define TEST_PACKET_COUNT      8U
+
+static FreeRTOS_Socket_t xSocketA;
+static FreeRTOS_Socket_t xSocketB;
+
+/** @brief The list in which the sockets are bound. */
+static List_t xBoundList;
+
+static AsyncRing_t xRing;
+
+static NetworkBufferDescriptor_t xPackets[ TEST_PACKET_COUNT ];
+static uint8_t ucPacketData[ TEST_PACKET_COUNT ][ ipUDP_PAYLOAD_OFFSET_IPv4 + TEST_PAYLOAD_LENGTH ];
+static size_t uxPacketsUsed;
+
+/** @brief The receive buffers of the requests, indexed by their user data. */
+static uint8_t ucReceived[ 8 ][ TEST_PAYLOAD_LENGTH ];
+
+/** @brief The eSocketAsyncEvent messages handled by prvRunIPTask(). */
+static size_t uxEventsHandled;
+
+static uint8_t ucEventGroup;
+
+/* ============================ Test Helpers ============================ */
+
+static size_t xRecv_Update_IPv4_Callback( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                          struct freertos_sockaddr * pxSourceAddress,
+                                          int cmock_num_calls )
+{
+    ( void ) pxNetworkBuffer;
+    ( void ) cmock_num_calls;
+
+    if( pxSourceAddress != NULL )
+    {
+        pxSourceAddress->sin_family = FREERTOS_AF_INET4;
+        pxSourceAddress->sin_port = FreeRTOS_htons( 1234U );
+    }
+
+    return ipUDP_PAYLOAD_OFFSET_IPv4;
+}
+
+/**
+ * @brief Prepare a bound UDP socket that does not block.
+ */
+static void prvInitSocket( FreeRTOS_Socket_t * pxSocket,
+                           uint16_t usPort )
+{
+    memset( pxSocket, 0, sizeof( *pxSocket ) );
+    pxSocket->ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_UDP;
+    pxSocket->usLocalPort = usPort;
+    pxSocket->xReceiveBlockTime = 0U;
+    vListInitialise( &( pxSocket->u.xUDP.xWaitingPacketsList ) );
+    vListInitialiseItem( &( pxSocket->xBoundSocketListItem ) );
+    listSET_LIST_ITEM_OWNER( &( pxSocket->xBoundSocketListItem ), pxSocket );
+    vListInsertEnd( &( xBoundList ), &( pxSocket->xBoundSocketListItem ) );
+}
+
+/**
+ * @brief Let the IP-task handle the eSocketAsyncEvent messages sent so far.
+ */
+static void prvRunIPTask( void )
+{
+    while( uxEventsHandled < uxEventsSent )
+    {
+        uxEventsHandled++;
+        vSocketAsyncProcess( ( SocketAsyncRing_t * ) pvEventData );
+    }
+}
+
+/**
+ * @brief Queue a datagram to a socket, without waking up the IP-task.
+ *
+ * @param[in] pxSocket The socket.
+ * @param[in] ucByte The value of the payload bytes.
+ */
+static void prvQueuePacket( FreeRTOS_Socket_t * pxSocket,
+                            uint8_t ucByte )
+{
+    NetworkBufferDescriptor_t * pxBuffer;
+
+    TEST_ASSERT_LESS_THAN( TEST_PACKET_COUNT, uxPacketsUsed );
+
+    pxBuffer = &( xPackets[ uxPacketsUsed ] );
+    memset( pxBuffer, 0, sizeof( *pxBuffer ) );
+    memset( ucPacketData[ uxPacketsUsed ], ucByte, sizeof( ucPacketData[ 0 ] ) );
+    pxBuffer->pucEthernetBuffer = ucPacketData[ uxPacketsUsed ];
+    pxBuffer->xDataLength = sizeof( ucPacketData[ 0 ] );
+    uxPacketsUsed++;
+
+    vListInitialiseItem( &( pxBuffer->xBufferListItem ) );
+    listSET_LIST_ITEM_OWNER( &( pxBuffer->xBufferListItem ), pxBuffer );
+    vListInsertEnd( &( pxSocket->u.xUDP.xWaitingPacketsList ), &( pxBuffer->xBufferListItem ) );
+}
+
+/**
+ * @brief Let a datagram arrive on a socket, as xProcessReceivedUDPPacket_IPv4()
+ *        would, and let the IP-task handle the event.
+ *
+ * @param[in] pxSocket The socket.
+ * @param[in] ucByte The value of the payload bytes.
+ */
+static void prvReceive( FreeRTOS_Socket_t * pxSocket,
+                        uint8_t ucByte )
+{
+    prvQueuePacket( pxSocket, ucByte );
+
+    if( pxSocket->pxAsyncRing != NULL )
+    {
+        vSocketAsyncWakeUp( pxSocket );
+    }
+
+    prvRunIPTask();
+}
+
+/**
+ * @brief Submit a single request, its user data is an index in ucReceived[].
+ *
+ * @return The number of requests accepted.
+ */
+static BaseType_t prvSubmit( AsyncRing_t xSubmitRing,
+                             eAsyncOperation_t eOperation,
+                             Socket_t xSocket,
+                             size_t uxUserData )
+{
+    FreeRTOS_AsyncRequest_t xRequest;
+
+    memset( &( xRequest ), 0, sizeof( xRequest ) );
+    xRequest.eOperation = eOperation;
+    xRequest.xSocket = xSocket;
+    xRequest.pvBuffer = ucReceived[ uxUserData ];
+    xRequest.uxLength = sizeof( ucReceived[ 0 ] );
+    xRequest.pvUserData = ( void * ) uxUserData;
+
+    return FreeRTOS_AsyncSubmit( xSubmitRing, &( xRequest ), 1 );
+}
+
+/**
+ * @brief Collect the next completion, which must be there.
+ */
+static void prvAssertCompletion( size_t uxUserData,
+                                 eAsyncOperation_t eOperation,
+                                 Socket_t xSocket,
+                                 int32_t lResult )
+{
+    FreeRTOS_AsyncCompletion_t xCompletion;
+
+    TEST_ASSERT_EQUAL( 1, FreeRTOS_AsyncComplete( xRing, &( xCompletion ), 1, 0U ) );
+    TEST_ASSERT_EQUAL( uxUserData, ( size_t ) xCompletion.pvUserData );
+    TEST_ASSERT_EQUAL( eOperation, xCompletion.eOperation );
+    TEST_ASSERT_EQUAL_PTR( xSocket, xCompletion.xSocket );
+    TEST_ASSERT_EQUAL( lResult, xCompletion.lResult );
+}
+
+/**
+ * @brief Check that no completions are waiting.
+ */
+static void prvAssertNoCompletion( void )
+{
+    FreeRTOS_AsyncCompletion_t xCompletion;
+
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncComplete( xRing, &( xCompletion ), 1, 0U ) );
+}
+
+/**
+ * @brief Collect a received datagram, and check its payload.
+ */
+static void prvAssertReceived( size_t uxUserData,
+                               Socket_t xSocket,
+                               uint8_t ucByte )
+{
+    uint8_t ucExpected[ TEST_PAYLOAD_LENGTH ];
+
+    prvAssertCompletion( uxUserData, eAsyncRecv, xSocket, ( int32_t ) TEST_PAYLOAD_LENGTH );
+    memset( ucExpected, ucByte, sizeof( ucExpected ) );
+    TEST_ASSERT_EQUAL_MEMORY( ucExpected, ucReceived[ uxUserData ], sizeof( ucExpected ) );
+}
+
+/**
+ * @brief xEventGroupWaitBits() of FreeRTOS_AsyncComplete(): a datagram arrives
+ *        while the application waits.
+ */
+static EventBits_t xEventGroupWaitBits_Receive( EventGroupHandle_t xEventGroup,
+                                                const EventBits_t uxBitsToWaitFor,
+                                                const BaseType_t xClearOnExit,
+                                                const BaseType_t xWaitForAllBits,
+                                                TickType_t xTicksToWait,
+                                                int cmock_num_calls )
+{
+    ( void ) xEventGroup;
+    ( void ) xClearOnExit;
+    ( void ) xWaitForAllBits;
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    prvReceive( &( xSocketA ), 0x55U );
+
+    return uxBitsToWaitFor;
+}
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    uxFreeCount = 0U;
+    pvLastFreed = NULL;
+    uxEventsSent = 0U;
+    uxEventsHandled = 0U;
+    pvEventData = NULL;
+    xEventQueueFull = pdFALSE;
+    uxCompletionSignals = 0U;
+    uxPacketsUsed = 0U;
+    memset( ucReceived, 0, sizeof( ucReceived ) );
+
+    pvPortMalloc_Stub( pvPortMalloc_Callback );
+    vPortFree_Stub( vPortFree_Callback );
+    xEventGroupCreate_IgnoreAndReturn( ( EventGroupHandle_t ) &( ucEventGroup ) );
+    xEventGroupClearBits_IgnoreAndReturn( 0U );
+    xEventGroupWaitBits_IgnoreAndReturn( 0U );
+    xEventGroupSetBits_Stub( xEventGroupSetBits_Callback );
+    vEventGroupDelete_Ignore();
+    xIsCallingFromIPTask_IgnoreAndReturn( pdFALSE );
+    xSendEventStructToIPTask_Stub( xSendEventStructToIPTask_Callback );
+    vTaskSetTimeOutState_Ignore();
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( NULL );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdFALSE );
+    uxIPHeaderSizePacket_IgnoreAndReturn( ipSIZE_OF_IPv4_HEADER );
+    xRecv_Update_IPv4_Stub( xRecv_Update_IPv4_Callback );
+    vReleaseNetworkBufferAndDescriptor_Ignore();
+
+    vListInitialise( &( xBoundList ) );
+    prvInitSocket( &( xSocketA ), 1000U );
+    prvInitSocket( &( xSocketB ), 1001U );
+
+    xRing = FreeRTOS_CreateAsyncRing();
+    TEST_ASSERT_NOT_NULL( xRing );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    if( xRing != NULL )
+    {
+        free( xRing );
+        xRing = NULL;
+    }
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief No ring is created without memory for it or its event group.
+ */
+void test_FreeRTOS_CreateAsyncRing_NoMemory( void )
+{
+    pvPortMalloc_Stub( NULL );
+    pvPortMalloc_ExpectAnyArgsAndReturn( NULL );
+    TEST_ASSERT_NULL( FreeRTOS_CreateAsyncRing() );
+
+    pvPortMalloc_Stub( pvPortMalloc_Callback );
+    xEventGroupCreate_StopIgnore();
+    xEventGroupCreate_ExpectAndReturn( NULL );
+    TEST_ASSERT_NULL( FreeRTOS_CreateAsyncRing() );
+    TEST_ASSERT_EQUAL( 1U, uxFreeCount );
+    free( pvLastFreed );
+}
+
+/**
+ * @brief Requests that can be carried out at once complete in the order in
+ *        which they were submitted.
+ */
+void test_FreeRTOS_AsyncSubmit_CompleteInOrder( void )
+{
+    FreeRTOS_AsyncRequest_t xRequests[ 3 ];
+    FreeRTOS_AsyncCompletion_t xCompletions[ 4 ];
+    size_t uxIndex;
+
+    prvReceive( &( xSocketA ), 0x11U );
+    prvReceive( &( xSocketB ), 0x22U );
+    prvReceive( &( xSocketA ), 0x33U );
+
+    memset( xRequests, 0, sizeof( xRequests ) );
+
+    for( uxIndex = 0U; uxIndex < 3U; uxIndex++ )
+    {
+        xRequests[ uxIndex ].eOperation = eAsyncRecv;
+        xRequests[ uxIndex ].xSocket = ( uxIndex == 1U ) ? &( xSocketB ) : &( xSocketA );
+        xRequests[ uxIndex ].pvBuffer = ucReceived[ uxIndex ];
+        xRequests[ uxIndex ].uxLength = sizeof( ucReceived[ 0 ] );
+        xRequests[ uxIndex ].pvUserData = ( void * ) uxIndex;
+    }
+
+    TEST_ASSERT_EQUAL( 3, FreeRTOS_AsyncSubmit( xRing, xRequests, 3 ) );
+
+    /* One message for the IP-task serves the whole batch. */
+    TEST_ASSERT_EQUAL( 1U, uxEventsSent );
+    TEST_ASSERT_EQUAL_PTR( xRing, pvEventData );
+
+    /* Nothing is done before the IP-task ran. */
+    prvAssertNoCompletion();
+
+    prvRunIPTask();
+    TEST_ASSERT_EQUAL( 1U, uxCompletionSignals );
+
+    TEST_ASSERT_EQUAL( 3, FreeRTOS_AsyncComplete( xRing, xCompletions, 4, 0U ) );
+
+    for( uxIndex = 0U; uxIndex < 3U; uxIndex++ )
+    {
+        TEST_ASSERT_EQUAL( uxIndex, ( size_t ) xCompletions[ uxIndex ].pvUserData );
+        TEST_ASSERT_EQUAL( eAsyncRecv, xCompletions[ uxIndex ].eOperation );
+        TEST_ASSERT_EQUAL( ( int32_t ) TEST_PAYLOAD_LENGTH, xCompletions[ uxIndex ].lResult );
+        TEST_ASSERT_EQUAL( FREERTOS_AF_INET4, xCompletions[ uxIndex ].xAddress.sin_family );
+        TEST_ASSERT_EQUAL( FreeRTOS_htons( 1234U ), xCompletions[ uxIndex ].xAddress.sin_port );
+    }
+
+    TEST_ASSERT_EACH_EQUAL_UINT8( 0x11U, ucReceived[ 0 ], TEST_PAYLOAD_LENGTH );
+    TEST_ASSERT_EACH_EQUAL_UINT8( 0x22U, ucReceived[ 1 ], TEST_PAYLOAD_LENGTH );
+    TEST_ASSERT_EACH_EQUAL_UINT8( 0x33U, ucReceived[ 2 ], TEST_PAYLOAD_LENGTH );
+
+    /* The sockets are not attached to the ring any more. */
+    TEST_ASSERT_NULL( xSocketA.pxAsyncRing );
+    TEST_ASSERT_NULL( xSocketB.pxAsyncRing );
+}
+
+/**
+ * @brief Waiting requests complete when their socket has an event, requests
+ *        of the same kind on one socket complete in the order of submission.
+ */
+void test_vSocketAsyncProcess_WaitForSocket( void )
+{
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 0U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketB ), 1U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 2U ) );
+    TEST_ASSERT_EQUAL( 1U, uxEventsSent );
+
+    prvRunIPTask();
+    prvAssertNoCompletion();
+    TEST_ASSERT_EQUAL_PTR( xRing, xSocketA.pxAsyncRing );
+    TEST_ASSERT_EQUAL_PTR( xRing, xSocketB.pxAsyncRing );
+    TEST_ASSERT_EQUAL( 0U, uxCompletionSignals );
+
+    prvReceive( &( xSocketB ), 0x22U );
+    prvAssertReceived( 1U, &( xSocketB ), 0x22U );
+    prvAssertNoCompletion();
+    TEST_ASSERT_NULL( xSocketB.pxAsyncRing );
+
+    /* The first request on socket A gets the first datagram. */
+    prvReceive( &( xSocketA ), 0x11U );
+    prvAssertReceived( 0U, &( xSocketA ), 0x11U );
+    prvAssertNoCompletion();
+    TEST_ASSERT_EQUAL_PTR( xRing, xSocketA.pxAsyncRing );
+
+    prvReceive( &( xSocketA ), 0x33U );
+    prvAssertReceived( 2U, &( xSocketA ), 0x33U );
+    TEST_ASSERT_NULL( xSocketA.pxAsyncRing );
+}
+
+/**
+ * @brief A later request on the same socket waits for the earlier one, also
+ *        when data for both is there.
+ */
+void test_vSocketAsyncProcess_SameSocketOrder( void )
+{
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 0U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 1U ) );
+    prvRunIPTask();
+
+    /* Both datagrams arrive before the IP-task looks at the ring again. */
+    prvQueuePacket( &( xSocketA ), 0x11U );
+    prvQueuePacket( &( xSocketA ), 0x22U );
+    vSocketAsyncWakeUp( &( xSocketA ) );
+    vSocketAsyncWakeUp( &( xSocketA ) );
+
+    /* A single message for both wake-ups. */
+    TEST_ASSERT_EQUAL( 2U, uxEventsSent );
+    prvRunIPTask();
+
+    prvAssertReceived( 0U, &( xSocketA ), 0x11U );
+    prvAssertReceived( 1U, &( xSocketA ), 0x22U );
+}
+
+/**
+ * @brief At most ipconfigASYNC_RING_LENGTH requests can be outstanding, a
+ *        request counts until its result has been collected.
+ */
+void test_FreeRTOS_AsyncSubmit_RingFull( void )
+{
+    FreeRTOS_AsyncRequest_t xRequests[ ipconfigASYNC_RING_LENGTH + 2U ];
+    FreeRTOS_AsyncCompletion_t xCompletion;
+    size_t uxIndex;
+
+    memset( xRequests, 0, sizeof( xRequests ) );
+
+    for( uxIndex = 0U; uxIndex < ( ipconfigASYNC_RING_LENGTH + 2U ); uxIndex++ )
+    {
+        xRequests[ uxIndex ].eOperation = eAsyncRecv;
+        xRequests[ uxIndex ].xSocket = &( xSocketA );
+        xRequests[ uxIndex ].pvBuffer = ucReceived[ uxIndex ];
+        xRequests[ uxIndex ].uxLength = sizeof( ucReceived[ 0 ] );
+        xRequests[ uxIndex ].pvUserData = ( void * ) uxIndex;
+    }
+
+    TEST_ASSERT_EQUAL( ipconfigASYNC_RING_LENGTH, FreeRTOS_AsyncSubmit( xRing, xRequests, ipconfigASYNC_RING_LENGTH + 2U ) );
+    TEST_ASSERT_EQUAL( 1U, uxEventsSent );
+
+    /* Nothing is accepted, and the IP-task is not woken up. */
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncSubmit( xRing, &( xRequests[ ipconfigASYNC_RING_LENGTH ] ), 2 ) );
+    TEST_ASSERT_EQUAL( 1U, uxEventsSent );
+
+    prvRunIPTask();
+    prvReceive( &( xSocketA ), 0x11U );
+    prvReceive( &( xSocketA ), 0x22U );
+
+    /* A completed request still counts until it is collected. */
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncSubmit( xRing, &( xRequests[ ipconfigASYNC_RING_LENGTH ] ), 2 ) );
+
+    prvAssertReceived( 0U, &( xSocketA ), 0x11U );
+    TEST_ASSERT_EQUAL( 1, FreeRTOS_AsyncSubmit( xRing, &( xRequests[ ipconfigASYNC_RING_LENGTH ] ), 2 ) );
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncSubmit( xRing, &( xRequests[ ipconfigASYNC_RING_LENGTH + 1U ] ), 1 ) );
+
+    prvAssertReceived( 1U, &( xSocketA ), 0x22U );
+    TEST_ASSERT_EQUAL( 1, FreeRTOS_AsyncSubmit( xRing, &( xRequests[ ipconfigASYNC_RING_LENGTH + 1U ] ), 1 ) );
+    prvRunIPTask();
+
+    /* The ring wraps around, the requests still complete in order. */
+    for( uxIndex = 2U; uxIndex < ( ipconfigASYNC_RING_LENGTH + 2U ); uxIndex++ )
+    {
+        prvReceive( &( xSocketA ), ( uint8_t ) ( 0x11U * ( uxIndex + 1U ) ) );
+        prvAssertReceived( uxIndex, &( xSocketA ), ( uint8_t ) ( 0x11U * ( uxIndex + 1U ) ) );
+    }
+
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncComplete( xRing, &( xCompletion ), 1, 0U ) );
+}
+
+/**
+ * @brief A batch is taken by a single message to the IP-task. When the event
+ *        queue is full, the next submission sends the message.
+ */
+void test_FreeRTOS_AsyncSubmit_EventQueueFull( void )
+{
+    xEventQueueFull = pdTRUE;
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 0U ) );
+    TEST_ASSERT_EQUAL( 0U, uxEventsSent );
+
+    xEventQueueFull = pdFALSE;
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketB ), 1U ) );
+    TEST_ASSERT_EQUAL( 1U, uxEventsSent );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketB ), 2U ) );
+    TEST_ASSERT_EQUAL( 1U, uxEventsSent );
+
+    prvRunIPTask();
+
+    /* Both batches were taken. */
+    prvReceive( &( xSocketA ), 0x11U );
+    prvAssertReceived( 0U, &( xSocketA ), 0x11U );
+
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 3U ) );
+    TEST_ASSERT_EQUAL( 3U, uxEventsSent );
+}
+
+/**
+ * @brief A close completes after the earlier requests on its socket, the
+ *        later requests on the socket are cancelled.
+ */
+void test_vSocketAsyncProcess_Close( void )
+{
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 0U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncClose, &( xSocketA ), 1U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncConnect, &( xSocketA ), 2U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketB ), 3U ) );
+    prvRunIPTask();
+
+    /* The connect would fail at once, but it waits for the close. */
+    prvAssertNoCompletion();
+    TEST_ASSERT_EQUAL( 0U, uxFreeCount );
+
+    prvReceive( &( xSocketA ), 0x11U );
+
+    prvAssertReceived( 0U, &( xSocketA ), 0x11U );
+    prvAssertCompletion( 1U, eAsyncClose, &( xSocketA ), 0 );
+    prvAssertCompletion( 2U, eAsyncConnect, &( xSocketA ), -pdFREERTOS_ERRNO_ECANCELED );
+    prvAssertNoCompletion();
+
+    TEST_ASSERT_EQUAL_PTR( &( xSocketA ), pvLastFreed );
+    TEST_ASSERT_NULL( xSocketA.pxAsyncRing );
+
+    /* The request on the other socket still waits. */
+    TEST_ASSERT_EQUAL_PTR( xRing, xSocketB.pxAsyncRing );
+    prvReceive( &( xSocketB ), 0x22U );
+    prvAssertReceived( 3U, &( xSocketB ), 0x22U );
+}
+
+/**
+ * @brief The requests after a close are still looked at in the same batch.
+ */
+void test_vSocketAsyncProcess_CloseThenOther( void )
+{
+    prvQueuePacket( &( xSocketB ), 0x22U );
+
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncClose, &( xSocketA ), 0U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketB ), 1U ) );
+    prvRunIPTask();
+
+    prvAssertCompletion( 0U, eAsyncClose, &( xSocketA ), 0 );
+    prvAssertReceived( 1U, &( xSocketB ), 0x22U );
+    TEST_ASSERT_EQUAL( 1U, uxCompletionSignals );
+}
+
+/**
+ * @brief The requests of a socket that is closed by the IP-task, e.g. after
+ *        FreeRTOS_closesocket(), complete with -pdFREERTOS_ERRNO_ECANCELED.
+ */
+void test_vSocketClose_CancelsRequests( void )
+{
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 0U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 1U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketB ), 2U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 3U ) );
+    prvRunIPTask();
+
+    ( void ) vSocketClose( &( xSocketA ) );
+
+    TEST_ASSERT_EQUAL( 1U, uxCompletionSignals );
+    TEST_ASSERT_NULL( xSocketA.pxAsyncRing );
+    prvAssertCompletion( 0U, eAsyncRecv, &( xSocketA ), -pdFREERTOS_ERRNO_ECANCELED );
+    prvAssertCompletion( 1U, eAsyncRecv, &( xSocketA ), -pdFREERTOS_ERRNO_ECANCELED );
+    prvAssertCompletion( 3U, eAsyncRecv, &( xSocketA ), -pdFREERTOS_ERRNO_ECANCELED );
+    prvAssertNoCompletion();
+
+    TEST_ASSERT_EQUAL_PTR( xRing, xSocketB.pxAsyncRing );
+    prvReceive( &( xSocketB ), 0x22U );
+    prvAssertReceived( 2U, &( xSocketB ), 0x22U );
+}
+
+/**
+ * @brief Invalid sockets, and sockets used by another ring, are refused.
+ */
+void test_vSocketAsyncProcess_BadSocket( void )
+{
+    AsyncRing_t xOtherRing = FreeRTOS_CreateAsyncRing();
+
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xOtherRing, eAsyncRecv, &( xSocketA ), 0U ) );
+    prvRunIPTask();
+
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, NULL, 1U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, FREERTOS_INVALID_SOCKET, 2U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 3U ) );
+    prvRunIPTask();
+
+    prvAssertCompletion( 1U, eAsyncRecv, NULL, -pdFREERTOS_ERRNO_EBADF );
+    prvAssertCompletion( 2U, eAsyncRecv, FREERTOS_INVALID_SOCKET, -pdFREERTOS_ERRNO_EBADF );
+    prvAssertCompletion( 3U, eAsyncRecv, &( xSocketA ), -pdFREERTOS_ERRNO_EBUSY );
+    TEST_ASSERT_EQUAL_PTR( xOtherRing, xSocketA.pxAsyncRing );
+
+    free( xOtherRing );
+}
+
+/**
+ * @brief Connect and accept are for TCP only.
+ */
+void test_vSocketAsyncProcess_NotSupported( void )
+{
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncConnect, &( xSocketA ), 0U ) );
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncAccept, &( xSocketA ), 1U ) );
+    prvRunIPTask();
+
+    prvAssertCompletion( 0U, eAsyncConnect, &( xSocketA ), -pdFREERTOS_ERRNO_EOPNOTSUPP );
+    prvAssertCompletion( 1U, eAsyncAccept, &( xSocketA ), -pdFREERTOS_ERRNO_EOPNOTSUPP );
+    TEST_ASSERT_NULL( xSocketA.pxAsyncRing );
+}
+
+/**
+ * @brief A deleted ring drops its requests and is freed by the IP-task,
+ *        once no message refers to it any more.
+ */
+void test_FreeRTOS_DeleteAsyncRing( void )
+{
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 0U ) );
+    prvRunIPTask();
+
+    /* Submitted, but not yet seen by the IP-task. */
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketB ), 1U ) );
+    TEST_ASSERT_EQUAL( 2U, uxEventsSent );
+
+    FreeRTOS_DeleteAsyncRing( xRing );
+
+    /* The waiting message will do. */
+    TEST_ASSERT_EQUAL( 2U, uxEventsSent );
+    TEST_ASSERT_EQUAL( 0U, uxFreeCount );
+
+    prvRunIPTask();
+
+    TEST_ASSERT_EQUAL( 1U, uxFreeCount );
+    TEST_ASSERT_EQUAL_PTR( xRing, pvLastFreed );
+    TEST_ASSERT_NULL( xSocketA.pxAsyncRing );
+    TEST_ASSERT_NULL( xSocketB.pxAsyncRing );
+    TEST_ASSERT_EQUAL( 0U, uxCompletionSignals );
+}
+
+/**
+ * @brief FreeRTOS_AsyncComplete() waits for the first result.
+ */
+void test_FreeRTOS_AsyncComplete_Wait( void )
+{
+    FreeRTOS_AsyncCompletion_t xCompletions[ 2 ];
+
+    TEST_ASSERT_EQUAL( 1, prvSubmit( xRing, eAsyncRecv, &( xSocketA ), 0U ) );
+    prvRunIPTask();
+
+    /* Time out. */
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncComplete( xRing, xCompletions, 2, 10U ) );
+
+    xTaskCheckForTimeOut_StopIgnore();
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+    xEventGroupWaitBits_Stub( xEventGroupWaitBits_Receive );
+
+    TEST_ASSERT_EQUAL( 1, FreeRTOS_AsyncComplete( xRing, xCompletions, 2, 10U ) );
+    TEST_ASSERT_EQUAL( 0U, ( size_t ) xCompletions[ 0 ].pvUserData );
+    TEST_ASSERT_EQUAL( ( int32_t ) TEST_PAYLOAD_LENGTH, xCompletions[ 0 ].lResult );
+    TEST_ASSERT_EACH_EQUAL_UINT8( 0x55U, ucReceived[ 0 ], TEST_PAYLOAD_LENGTH );
+}
+
+/**
+ * @brief Invalid arguments.
+ */
+void test_FreeRTOS_AsyncSubmit_InvalidArguments( void )
+{
+    FreeRTOS_AsyncRequest_t xRequest;
+    FreeRTOS_AsyncCompletion_t xCompletion;
+
+    memset( &( xRequest ), 0, sizeof( xRequest ) );
+
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncSubmit( NULL, &( xRequest ), 1 ) );
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncSubmit( xRing, NULL, 1 ) );
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncSubmit( xRing, &( xRequest ), 0 ) );
+    TEST_ASSERT_EQUAL( 0U, uxEventsSent );
+
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncComplete( NULL, &( xCompletion ), 1, 0U ) );
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncComplete( xRing, NULL, 1, 0U ) );
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AsyncComplete( xRing, &( xCompletion ), 0, 0U ) );
+
+    /* The IP-task can not wait for itself. */
+    xIsCallingFromIPTask_StopIgnore();
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    catch_assert( FreeRTOS_AsyncSubmit( xRing, &( xRequest ), 1 ) );
+}
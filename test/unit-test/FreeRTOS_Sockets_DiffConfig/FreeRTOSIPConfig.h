@@ -328,4 +328,6 @@
 
 #define ipconfigTCP_MAY_LOG_PORT( xPort )    ( ( xPort ) != 23U )
 
+#define ipconfigUSE_TCP_CONGESTION_CONTROL       ( 1 )
+
 #endif /* FREERTOS_IP_CONFIG_H */
@@ -60,6 +60,35 @@
 
 BaseType_t xTCPWindowLoggingLevel = 0;
 
+/* ======================== Stub Callback Functions ========================= */
+
+static void prvTestCongestionInit( struct xTCP_WINDOW * pxWindow )
+{
+    ( void ) pxWindow;
+}
+
+static void prvTestCongestionOnAck( struct xTCP_WINDOW * pxWindow,
+                                    uint32_t ulAckedBytes )
+{
+    ( void ) pxWindow;
+    ( void ) ulAckedBytes;
+}
+
+static void prvTestCongestionOnLoss( struct xTCP_WINDOW * pxWindow,
+                                     BaseType_t xTimeout )
+{
+    ( void ) pxWindow;
+    ( void ) xTimeout;
+}
+
+static const TCPCongestionControl_t xTestCongestion =
+{
+    "test",
+    prvTestCongestionInit,
+    prvTestCongestionOnAck,
+    prvTestCongestionOnLoss
+};
+
 /* =============================== Test Cases =============================== */
 
 /**
@@ -113,3 +142,71 @@ void test_vSocketBind_TCP1( void )
 
     TEST_ASSERT_EQUAL( 0, xReturn );
 }
+
+/**
+ * @brief FREERTOS_SO_TCP_CONGESTION selects the congestion control of a TCP socket.
+ */
+void test_FreeRTOS_setsockopt_TCPCongestion( void )
+{
+    BaseType_t xReturn;
+    FreeRTOS_Socket_t xSocket;
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    xSocket.ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_TCP;
+
+    xReturn = FreeRTOS_setsockopt( &xSocket, 0, FREERTOS_SO_TCP_CONGESTION, &xTestCongestion, sizeof( xTestCongestion ) );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+    TEST_ASSERT_EQUAL_PTR( &xTestCongestion, xSocket.u.xTCP.pxCongestionControl );
+}
+
+/**
+ * @brief FREERTOS_SO_TCP_CONGESTION is refused for a UDP socket.
+ */
+void test_FreeRTOS_setsockopt_TCPCongestion_UDP( void )
+{
+    BaseType_t xReturn;
+    FreeRTOS_Socket_t xSocket;
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    xSocket.ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_UDP;
+
+    xReturn = FreeRTOS_setsockopt( &xSocket, 0, FREERTOS_SO_TCP_CONGESTION, &xTestCongestion, sizeof( xTestCongestion ) );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+}
+
+/**
+ * @brief FREERTOS_SO_TCP_CONGESTION refuses an algorithm that misses a function,
+ *        and keeps the algorithm that was selected before.
+ */
+void test_FreeRTOS_setsockopt_TCPCongestion_Incomplete( void )
+{
+    BaseType_t xReturn;
+    FreeRTOS_Socket_t xSocket;
+    TCPCongestionControl_t xIncomplete;
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    xSocket.ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_TCP;
+    xSocket.u.xTCP.pxCongestionControl = &xTestCongestion;
+
+    xReturn = FreeRTOS_setsockopt( &xSocket, 0, FREERTOS_SO_TCP_CONGESTION, NULL, 0 );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    xIncomplete = xTestCongestion;
+    xIncomplete.fnInit = NULL;
+    xReturn = FreeRTOS_setsockopt( &xSocket, 0, FREERTOS_SO_TCP_CONGESTION, &xIncomplete, sizeof( xIncomplete ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    xIncomplete = xTestCongestion;
+    xIncomplete.fnOnAck = NULL;
+    xReturn = FreeRTOS_setsockopt( &xSocket, 0, FREERTOS_SO_TCP_CONGESTION, &xIncomplete, sizeof( xIncomplete ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    xIncomplete = xTestCongestion;
+    xIncomplete.fnOnLoss = NULL;
+    xReturn = FreeRTOS_setsockopt( &xSocket, 0, FREERTOS_SO_TCP_CONGESTION, &xIncomplete, sizeof( xIncomplete ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    TEST_ASSERT_EQUAL_PTR( &xTestCongestion, xSocket.u.xTCP.pxCongestionControl );
+}
@@ -0,0 +1,104 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include <unity.h>
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "list.h"
+
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+QueueHandle_t xNetworkEventQueue = NULL;
+
+BaseType_t xTCPWindowLoggingLevel = 0;
+
+/** @brief The nesting depth of the critical sections. */
+static UBaseType_t uxCriticalNesting;
+
+/* ======================== Stub Callback Functions ========================= */
+
+void vPortEnterCritical( void )
+{
+    uxCriticalNesting++;
+}
+void vPortExitCritical( void )
+{
+    TEST_ASSERT_NOT_EQUAL( 0U, uxCriticalNesting );
+    uxCriticalNesting--;
+}
+
+/* The address conversions of FreeRTOS_IPv4_Sockets.c and FreeRTOS_IPv6_Sockets.c
+ * are not used by the tests. */
+BaseType_t FreeRTOS_inet_pton4( const char * pcSource,
+                                void * pvDestination )
+{
+    ( void ) pcSource;
+    ( void ) pvDestination;
+
+    return pdFAIL;
+}
+
+const char * FreeRTOS_inet_ntop4( const void * pvSource,
+                                  char * pcDestination,
+                                  socklen_t uxSize )
+{
+    ( void ) pvSource;
+    ( void ) pcDestination;
+    ( void ) uxSize;
+
+    return NULL;
+}
+
+BaseType_t FreeRTOS_inet_pton6( const char * pcSource,
+                                void * pvDestination )
+{
+    ( void ) pcSource;
+    ( void ) pvDestination;
+
+    return pdFAIL;
+}
+
+const char * FreeRTOS_inet_ntop6( const void * pvSource,
+                                  char * pcDestination,
+                                  socklen_t uxSize )
+{
+    ( void ) pvSource;
+    ( void ) pcDestination;
+    ( void ) uxSize;
+
+    return NULL;
+}
@@ -0,0 +1,259 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_portable.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IPv4_Sockets.h"
+#include "mock_FreeRTOS_IPv6_Sockets.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_NetworkBufferManagement.h"
+
+#include "FreeRTOS_Sockets.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_Sockets_Notify_stubs.c"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/** @brief The task that blocks on the socket. */
+#define TEST_TASK           ( ( TaskHandle_t ) 0x1234 )
+
+/** @brief Another task. */
+#define TEST_OTHER_TASK     ( ( TaskHandle_t ) 0x5678 )
+
+/** @brief The time that the tests wait. */
+#define TEST_WAIT_TICKS     ( ( TickType_t ) 100U )
+
+static FreeRTOS_Socket_t xSocket;
+
+/* ============================ Unity Fixtures ============================ */
+
+/**
+ * @brief calls at the beginning of each test case
+ */
+void setUp( void )
+{
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    uxCriticalNesting = 0U;
+}
+
+/**
+ * @brief calls at the end of each test case
+ */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL( 0U, uxCriticalNesting );
+}
+
+/* ======================== Stub Callback Functions ======================= */
+
+/**
+ * @brief The first wait returns without a new event, as after a notification
+ *        that was given for an event that an earlier wait already consumed.
+ *        During the second wait, the IP-task reports that data arrived.
+ */
+static uint32_t ulTaskGenericNotifyTake_SpuriousThenReceive( UBaseType_t uxIndexToWaitOn,
+                                                             BaseType_t xClearCountOnExit,
+                                                             TickType_t xTicksToWait,
+                                                             int cmock_num_calls )
+{
+    ( void ) uxIndexToWaitOn;
+    ( void ) xClearCountOnExit;
+    ( void ) xTicksToWait;
+
+    if( cmock_num_calls == 1 )
+    {
+        vSocketEventSet( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE );
+    }
+
+    return 1U;
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief test_vSocketEventSet_NoTaskWaiting
+ * The bits are stored, there is no task to notify.
+ */
+void test_vSocketEventSet_NoTaskWaiting( void )
+{
+    xSocket.xNotifyBits = ( EventBits_t ) eSOCKET_SEND;
+
+    vSocketEventSet( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE );
+
+    TEST_ASSERT_EQUAL( ( EventBits_t ) eSOCKET_SEND | ( EventBits_t ) eSOCKET_RECEIVE, xSocket.xNotifyBits );
+}
+
+/**
+ * @brief test_vSocketEventSet_NotifiesWaitingTask
+ * The task that blocks on the socket is notified on its own notification
+ * index.
+ */
+void test_vSocketEventSet_NotifiesWaitingTask( void )
+{
+    xSocket.xNotifyTask = TEST_TASK;
+
+    xTaskGenericNotify_ExpectAndReturn( TEST_TASK, ipconfigSOCKET_NOTIFY_INDEX, 0U, eIncrement, NULL, pdPASS );
+
+    vSocketEventSet( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE );
+
+    TEST_ASSERT_EQUAL( ( EventBits_t ) eSOCKET_RECEIVE, xSocket.xNotifyBits );
+}
+
+/**
+ * @brief test_xSocketEventWait_SetBeforeWait
+ * The event was set before the wait: it returns without blocking, and the
+ * bits of interest are cleared.
+ */
+void test_xSocketEventWait_SetBeforeWait( void )
+{
+    EventBits_t xBits;
+
+    vSocketEventSet( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE | ( EventBits_t ) eSOCKET_SEND );
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( TEST_TASK );
+    vTaskSetTimeOutState_ExpectAnyArgs();
+
+    xBits = xSocketEventWait( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE | ( EventBits_t ) eSOCKET_INTR, pdTRUE, TEST_WAIT_TICKS );
+
+    TEST_ASSERT_EQUAL( ( EventBits_t ) eSOCKET_RECEIVE | ( EventBits_t ) eSOCKET_SEND, xBits );
+    TEST_ASSERT_EQUAL( ( EventBits_t ) eSOCKET_SEND, xSocket.xNotifyBits );
+    TEST_ASSERT_NULL( xSocket.xNotifyTask );
+}
+
+/**
+ * @brief test_xSocketEventWait_SetBeforeWaitNoClear
+ * Without xClearOnExit, the bits stay set.
+ */
+void test_xSocketEventWait_SetBeforeWaitNoClear( void )
+{
+    EventBits_t xBits;
+
+    vSocketEventSet( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE );
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( TEST_TASK );
+    vTaskSetTimeOutState_ExpectAnyArgs();
+
+    xBits = xSocketEventWait( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE, pdFALSE, TEST_WAIT_TICKS );
+
+    TEST_ASSERT_EQUAL( ( EventBits_t ) eSOCKET_RECEIVE, xBits );
+    TEST_ASSERT_EQUAL( ( EventBits_t ) eSOCKET_RECEIVE, xSocket.xNotifyBits );
+    TEST_ASSERT_NULL( xSocket.xNotifyTask );
+}
+
+/**
+ * @brief test_xSocketEventWait_Timeout
+ * No event arrives: the task blocks on its notification index for the time
+ * that is left, and returns without bits after the time-out.
+ */
+void test_xSocketEventWait_Timeout( void )
+{
+    EventBits_t xBits;
+    TickType_t xRemaining = TEST_WAIT_TICKS / 2U;
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( TEST_TASK );
+    vTaskSetTimeOutState_ExpectAnyArgs();
+
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+    xTaskCheckForTimeOut_ReturnThruPtr_pxTicksToWait( &xRemaining );
+    ulTaskGenericNotifyTake_ExpectAndReturn( ipconfigSOCKET_NOTIFY_INDEX, pdTRUE, TEST_WAIT_TICKS / 2U, 0U );
+
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdTRUE );
+
+    xBits = xSocketEventWait( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE, pdTRUE, TEST_WAIT_TICKS );
+
+    TEST_ASSERT_EQUAL( 0U, xBits );
+    TEST_ASSERT_NULL( xSocket.xNotifyTask );
+}
+
+/**
+ * @brief test_xSocketEventWait_SpuriousWake
+ * The task is woken while none of the bits of interest is set: it blocks
+ * again until the event arrives.  A bit that it does not wait for does not
+ * end the wait, and is not cleared.
+ */
+void test_xSocketEventWait_SpuriousWake( void )
+{
+    EventBits_t xBits;
+
+    xSocket.xNotifyBits = ( EventBits_t ) eSOCKET_SEND;
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( TEST_TASK );
+    vTaskSetTimeOutState_ExpectAnyArgs();
+
+    /* The spurious wake-up. */
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+    ulTaskGenericNotifyTake_ExpectAndReturn( ipconfigSOCKET_NOTIFY_INDEX, pdTRUE, TEST_WAIT_TICKS, 1U );
+
+    /* The wake-up by vSocketEventSet(). */
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+    ulTaskGenericNotifyTake_ExpectAndReturn( ipconfigSOCKET_NOTIFY_INDEX, pdTRUE, TEST_WAIT_TICKS, 1U );
+    xTaskGenericNotify_ExpectAndReturn( TEST_TASK, ipconfigSOCKET_NOTIFY_INDEX, 0U, eIncrement, NULL, pdPASS );
+
+    ulTaskGenericNotifyTake_AddCallback( ulTaskGenericNotifyTake_SpuriousThenReceive );
+
+    xBits = xSocketEventWait( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE, pdTRUE, TEST_WAIT_TICKS );
+
+    TEST_ASSERT_EQUAL( ( EventBits_t ) eSOCKET_RECEIVE | ( EventBits_t ) eSOCKET_SEND, xBits );
+    TEST_ASSERT_EQUAL( ( EventBits_t ) eSOCKET_SEND, xSocket.xNotifyBits );
+    TEST_ASSERT_NULL( xSocket.xNotifyTask );
+}
+
+/**
+ * @brief test_xSocketEventWait_SecondTask
+ * Only one task may block on a socket at a time.
+ */
+void test_xSocketEventWait_SecondTask( void )
+{
+    xSocket.xNotifyTask = TEST_OTHER_TASK;
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( TEST_TASK );
+    vTaskSetTimeOutState_ExpectAnyArgs();
+
+    catch_assert( xSocketEventWait( &xSocket, ( EventBits_t ) eSOCKET_RECEIVE, pdTRUE, TEST_WAIT_TICKS ) );
+
+    /* The assert left the critical section open. */
+    uxCriticalNesting = 0U;
+}
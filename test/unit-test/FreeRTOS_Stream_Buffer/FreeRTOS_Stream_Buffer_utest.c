@@ -33,6 +33,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <pthread.h>
 
 #include "mock_task.h"
 
@@ -452,6 +453,73 @@ void test_uxStreamBufferGetPtr( void )
     TEST_ASSERT_EQUAL_PTR( xLocalBuffer.ucArray + xLocalBuffer.uxTail, pucData );
 }
 
+/*
+ * @brief Test getting the data of a stream buffer that wraps around the end.
+ */
+void test_uxStreamBufferGetReadRegions_WrapAround( void )
+{
+    const size_t uxBufferSize = 10;
+    StreamBuffer_t * pxLocalBuffer = malloc( sizeof( StreamBuffer_t ) - sizeof( pxLocalBuffer->ucArray ) + uxBufferSize );
+    StreamBufferRegion_t xRegions[ 2 ];
+    size_t uxResult;
+
+    pxLocalBuffer->LENGTH = uxBufferSize;
+    pxLocalBuffer->uxTail = 7;
+    pxLocalBuffer->uxHead = 3;
+
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_stub );
+    uxResult = uxStreamBufferGetReadRegions( pxLocalBuffer, xRegions );
+
+    TEST_ASSERT_EQUAL( 6, uxResult );
+    TEST_ASSERT_EQUAL_PTR( &( pxLocalBuffer->ucArray[ 7 ] ), xRegions[ 0 ].pucData );
+    TEST_ASSERT_EQUAL( 3, xRegions[ 0 ].uxLength );
+    TEST_ASSERT_EQUAL_PTR( pxLocalBuffer->ucArray, xRegions[ 1 ].pucData );
+    TEST_ASSERT_EQUAL( 3, xRegions[ 1 ].uxLength );
+
+    free( pxLocalBuffer );
+}
+
+/*
+ * @brief Test getting the free space of a stream buffer, with and without
+ *        wrapping around the end.
+ */
+void test_uxStreamBufferGetWriteRegions( void )
+{
+    const size_t uxBufferSize = 10;
+    StreamBuffer_t * pxLocalBuffer = malloc( sizeof( StreamBuffer_t ) - sizeof( pxLocalBuffer->ucArray ) + uxBufferSize );
+    StreamBufferRegion_t xRegions[ 2 ];
+    size_t uxResult;
+
+    pxLocalBuffer->LENGTH = uxBufferSize;
+    pxLocalBuffer->uxTail = 7;
+    pxLocalBuffer->uxHead = 3;
+
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_stub );
+
+    /* The free space ends in front of the tail. */
+    uxResult = uxStreamBufferGetWriteRegions( pxLocalBuffer, xRegions );
+
+    TEST_ASSERT_EQUAL( 3, uxResult );
+    TEST_ASSERT_EQUAL_PTR( &( pxLocalBuffer->ucArray[ 3 ] ), xRegions[ 0 ].pucData );
+    TEST_ASSERT_EQUAL( 3, xRegions[ 0 ].uxLength );
+    TEST_ASSERT_EQUAL_PTR( NULL, xRegions[ 1 ].pucData );
+    TEST_ASSERT_EQUAL( 0, xRegions[ 1 ].uxLength );
+
+    /* The free space wraps around the end. */
+    pxLocalBuffer->uxTail = 3;
+    pxLocalBuffer->uxHead = 7;
+
+    uxResult = uxStreamBufferGetWriteRegions( pxLocalBuffer, xRegions );
+
+    TEST_ASSERT_EQUAL( 5, uxResult );
+    TEST_ASSERT_EQUAL_PTR( &( pxLocalBuffer->ucArray[ 7 ] ), xRegions[ 0 ].pucData );
+    TEST_ASSERT_EQUAL( 3, xRegions[ 0 ].uxLength );
+    TEST_ASSERT_EQUAL_PTR( pxLocalBuffer->ucArray, xRegions[ 1 ].pucData );
+    TEST_ASSERT_EQUAL( 2, xRegions[ 1 ].uxLength );
+
+    free( pxLocalBuffer );
+}
+
 /*
  * @brief Test adding to the stream buffer when everything is zeroed out.
  */
@@ -1274,3 +1342,212 @@ void test_uxStreamBufferGet_NULLPointer( void )
     /* Free the allocated data. */
     free( pxLocalBuffer );
 }
+
+/*
+ * @brief The one's complement sum of 16-bit big-endian words, to verify the
+ *        sum made by uxStreamBufferGetWithChecksum().
+ */
+static uint16_t prvReferenceSum( const uint8_t * pucData,
+                                 size_t uxLength )
+{
+    uint32_t ulSum = 0;
+    size_t uxIndex;
+
+    for( uxIndex = 0; uxIndex < uxLength; uxIndex++ )
+    {
+        if( ( uxIndex & 1U ) == 0U )
+        {
+            ulSum += ( uint32_t ) pucData[ uxIndex ] << 8;
+        }
+        else
+        {
+            ulSum += pucData[ uxIndex ];
+        }
+    }
+
+    while( ( ulSum >> 16 ) != 0U )
+    {
+        ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+    }
+
+    return ( uint16_t ) ulSum;
+}
+
+/*
+ * @brief Test reading with checksum from a stream buffer where the data
+ *        wraps around after an odd number of bytes.
+ */
+void test_uxStreamBufferGetWithChecksum_RolloverAtOddPosition( void )
+{
+    const uint16_t usBufferSize = 1024;
+    StreamBuffer_t * pxLocalBuffer = malloc( sizeof( StreamBuffer_t ) - sizeof( pxLocalBuffer->ucArray ) + usBufferSize );
+    uint8_t pucData[ 512 ];
+    size_t uxReturn;
+    size_t uxIndex;
+    uint16_t usSum = 0xAAAA;
+
+    memset( pxLocalBuffer, 0, sizeof( StreamBuffer_t ) - sizeof( pxLocalBuffer->ucArray ) + usBufferSize );
+
+    for( uxIndex = 0; uxIndex < usBufferSize; uxIndex++ )
+    {
+        pxLocalBuffer->ucArray[ uxIndex ] = ( uint8_t ) ( ( uxIndex * 7U ) + 0xC3U );
+    }
+
+    pxLocalBuffer->LENGTH = usBufferSize;
+    /* 23 bytes before the end of the buffer, and 477 at the start. */
+    pxLocalBuffer->uxTail = usBufferSize - 23U;
+    pxLocalBuffer->uxHead = 477U;
+
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_stub );
+
+    uxReturn = uxStreamBufferGetWithChecksum( pxLocalBuffer, 0U, pucData, 500U, pdTRUE, &usSum );
+
+    TEST_ASSERT_EQUAL( 500, uxReturn );
+    /* Peeking, the tail should not be moved. */
+    TEST_ASSERT_EQUAL( usBufferSize - 23U, pxLocalBuffer->uxTail );
+    TEST_ASSERT_EQUAL_MEMORY( &( pxLocalBuffer->ucArray[ usBufferSize - 23U ] ), pucData, 23U );
+    TEST_ASSERT_EQUAL_MEMORY( pxLocalBuffer->ucArray, &( pucData[ 23 ] ), 477U );
+    TEST_ASSERT_EQUAL_HEX16( prvReferenceSum( pucData, 500U ), usSum );
+
+    free( pxLocalBuffer );
+}
+
+/*
+ * @brief Test reading with checksum when no data is copied: the sum is zero
+ *        and the tail still moves forward.
+ */
+void test_uxStreamBufferGetWithChecksum_NULLPointer( void )
+{
+    const uint16_t usBufferSize = 1024;
+    StreamBuffer_t * pxLocalBuffer = malloc( sizeof( StreamBuffer_t ) - sizeof( pxLocalBuffer->ucArray ) + usBufferSize );
+    size_t uxReturn;
+    uint16_t usSum = 0xAAAA;
+
+    memset( pxLocalBuffer, 0x11, sizeof( StreamBuffer_t ) - sizeof( pxLocalBuffer->ucArray ) + usBufferSize );
+
+    pxLocalBuffer->LENGTH = usBufferSize;
+    pxLocalBuffer->uxTail = 0U;
+    pxLocalBuffer->uxHead = 100U;
+    pxLocalBuffer->uxMid = 0;
+    pxLocalBuffer->uxFront = 0;
+
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_stub );
+
+    uxReturn = uxStreamBufferGetWithChecksum( pxLocalBuffer, 0U, NULL, 100U, pdFALSE, &usSum );
+
+    TEST_ASSERT_EQUAL( 100, uxReturn );
+    TEST_ASSERT_EQUAL( 100, pxLocalBuffer->uxTail );
+    TEST_ASSERT_EQUAL( 0U, usSum );
+
+    free( pxLocalBuffer );
+}
+
+/* The number of bytes that pass through the buffer in the parallel test. */
+#define PARALLEL_TEST_BYTES    100000U
+
+/* The data of the parallel test: a pattern that does not repeat on a power
+ * of 2, so that a byte at a wrong position is noticed. */
+#define PARALLEL_TEST_BYTE( uxPosition )    ( ( uint8_t ) ( ( uxPosition ) % 251U ) )
+
+static StreamBuffer_t * pxParallelBuffer;
+static volatile size_t uxParallelErrors;
+
+/*
+ * @brief Writer side of the parallel test, adds chunks of varying size.
+ */
+static void * prvParallelWriter( void * pvParameter )
+{
+    uint8_t ucChunk[ 97 ];
+    size_t uxWritten = 0U;
+    size_t uxRound = 0U;
+
+    ( void ) pvParameter;
+
+    while( uxWritten < PARALLEL_TEST_BYTES )
+    {
+        size_t uxChunkSize = 1U + ( ( uxRound * 37U ) % sizeof( ucChunk ) );
+        size_t uxIndex;
+
+        if( uxChunkSize > ( PARALLEL_TEST_BYTES - uxWritten ) )
+        {
+            uxChunkSize = PARALLEL_TEST_BYTES - uxWritten;
+        }
+
+        for( uxIndex = 0U; uxIndex < uxChunkSize; uxIndex++ )
+        {
+            ucChunk[ uxIndex ] = PARALLEL_TEST_BYTE( uxWritten + uxIndex );
+        }
+
+        uxWritten += uxStreamBufferAdd( pxParallelBuffer, 0U, ucChunk, uxChunkSize );
+        uxRound++;
+    }
+
+    return NULL;
+}
+
+/*
+ * @brief Reader side of the parallel test, checks every byte it takes.
+ */
+static void * prvParallelReader( void * pvParameter )
+{
+    uint8_t ucChunk[ 89 ];
+    size_t uxRead = 0U;
+    size_t uxRound = 0U;
+
+    ( void ) pvParameter;
+
+    while( uxRead < PARALLEL_TEST_BYTES )
+    {
+        size_t uxChunkSize = 1U + ( ( uxRound * 53U ) % sizeof( ucChunk ) );
+        size_t uxCount;
+        size_t uxIndex;
+
+        uxCount = uxStreamBufferGet( pxParallelBuffer, 0U, ucChunk, uxChunkSize, pdFALSE );
+
+        for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+        {
+            if( ucChunk[ uxIndex ] != PARALLEL_TEST_BYTE( uxRead + uxIndex ) )
+            {
+                uxParallelErrors++;
+            }
+        }
+
+        uxRead += uxCount;
+        uxRound++;
+    }
+
+    return NULL;
+}
+
+/*
+ * @brief Test a writer and a reader that use the same stream buffer at the
+ *        same time from two threads: all data arrives, in order.
+ */
+void test_uxStreamBuffer_ParallelWriterAndReader( void )
+{
+    const size_t uxBufferSize = 257U;
+    pthread_t xWriter;
+    pthread_t xReader;
+
+    pxParallelBuffer = malloc( sizeof( StreamBuffer_t ) - sizeof( pxParallelBuffer->ucArray ) + uxBufferSize );
+    TEST_ASSERT_NOT_NULL( pxParallelBuffer );
+
+    memset( pxParallelBuffer, 0, sizeof( StreamBuffer_t ) - sizeof( pxParallelBuffer->ucArray ) + uxBufferSize );
+    pxParallelBuffer->LENGTH = uxBufferSize;
+    uxParallelErrors = 0U;
+
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_stub );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    TEST_ASSERT_EQUAL( 0, pthread_create( &xReader, NULL, prvParallelReader, NULL ) );
+    TEST_ASSERT_EQUAL( 0, pthread_create( &xWriter, NULL, prvParallelWriter, NULL ) );
+
+    TEST_ASSERT_EQUAL( 0, pthread_join( xWriter, NULL ) );
+    TEST_ASSERT_EQUAL( 0, pthread_join( xReader, NULL ) );
+
+    TEST_ASSERT_EQUAL( 0U, uxParallelErrors );
+    TEST_ASSERT_EQUAL( pxParallelBuffer->uxHead, pxParallelBuffer->uxTail );
+
+    free( pxParallelBuffer );
+}
@@ -90,6 +90,7 @@ set( utest_link_list "" )
 list(APPEND utest_link_list
             -l${mock_name}
             lib${real_name}.a
+            -lpthread
         )
 
 list(APPEND utest_dep_list
@@ -0,0 +1,526 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_TCP_IP_RxCoalesce_list_macros.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_queue.h"
+#include "mock_task.h"
+#include "mock_event_groups.h"
+#include "mock_list.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_TCP_State_Handling.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+#include "mock_FreeRTOS_TCP_Transmission.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_IP.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+extern BaseType_t xBufferAllocFixedSize;
+
+/* The offsets of the fields that the tests modify. */
+#define TEST_IP_OFFSET          ( ipSIZE_OF_ETH_HEADER )
+#define TEST_TCP_OFFSET         ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER )
+#define TEST_HEADER_LENGTH      ( TEST_TCP_OFFSET + ipSIZE_OF_TCP_HEADER )
+
+#define TEST_SEQUENCE_NUMBER    ( 1000U )
+#define TEST_MAX_PACKETS        ( 8U )
+#define TEST_BUFFER_SIZE        ( TEST_HEADER_LENGTH + 12U + 1500U )
+
+static NetworkBufferDescriptor_t xPackets[ TEST_MAX_PACKETS ];
+static uint8_t ucPacketBuffers[ TEST_MAX_PACKETS ][ TEST_BUFFER_SIZE ];
+
+/* The buffer returned by pxGetNetworkBufferWithDescriptor(). */
+static NetworkBufferDescriptor_t xMerged;
+static uint8_t ucMergedBuffer[ TEST_HEADER_LENGTH + ipconfigTCP_RX_COALESCE_MAX_SIZE ];
+static size_t uxMergedRequested;
+static BaseType_t xMergedAvailable;
+
+/* The network buffers released, in order. */
+static NetworkBufferDescriptor_t * pxReleased[ 2U * TEST_MAX_PACKETS ];
+static size_t uxReleasedCount;
+
+/* The number of packets that were passed to xProcessReceivedTCPPacket(). */
+static size_t uxProcessedCount;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static NetworkBufferDescriptor_t * pxStubGetNetworkBuffer( size_t uxRequestedSizeBytes,
+                                                           TickType_t uxBlockTimeTicks,
+                                                           int cmock_num_calls )
+{
+    NetworkBufferDescriptor_t * pxReturn = NULL;
+
+    ( void ) uxBlockTimeTicks;
+    ( void ) cmock_num_calls;
+
+    uxMergedRequested = uxRequestedSizeBytes;
+
+    if( ( xMergedAvailable != pdFALSE ) && ( uxRequestedSizeBytes <= sizeof( ucMergedBuffer ) ) )
+    {
+        memset( &xMerged, 0, sizeof( xMerged ) );
+        xMerged.pucEthernetBuffer = ucMergedBuffer;
+        xMerged.xDataLength = uxRequestedSizeBytes;
+        pxReturn = &xMerged;
+    }
+
+    return pxReturn;
+}
+
+static void vStubReleaseNetworkBuffer( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                       int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_LESS_THAN( 2U * TEST_MAX_PACKETS, uxReleasedCount );
+    pxReleased[ uxReleasedCount++ ] = pxNetworkBuffer;
+}
+
+static FreeRTOS_Socket_t * pxStubTCPSocketLookup( uint32_t ulLocalIP,
+                                                  UBaseType_t uxLocalPort,
+                                                  IPv46_Address_t xRemoteIP,
+                                                  UBaseType_t uxRemotePort,
+                                                  int cmock_num_calls )
+{
+    ( void ) ulLocalIP;
+    ( void ) uxLocalPort;
+    ( void ) xRemoteIP;
+    ( void ) uxRemotePort;
+    ( void ) cmock_num_calls;
+
+    /* No socket is found, so xProcessReceivedTCPPacket() returns pdFAIL and
+     * the caller releases the packet. */
+    uxProcessedCount++;
+
+    return NULL;
+}
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( xPackets, 0, sizeof( xPackets ) );
+    memset( ucPacketBuffers, 0, sizeof( ucPacketBuffers ) );
+    memset( ucMergedBuffer, 0, sizeof( ucMergedBuffer ) );
+    uxMergedRequested = 0U;
+    xMergedAvailable = pdTRUE;
+    uxReleasedCount = 0U;
+    uxProcessedCount = 0U;
+    xBufferAllocFixedSize = pdFALSE;
+
+    uxIPHeaderSizePacket_IgnoreAndReturn( ipSIZE_OF_IPv4_HEADER );
+    pxGetNetworkBufferWithDescriptor_Stub( pxStubGetNetworkBuffer );
+    vReleaseNetworkBufferAndDescriptor_Stub( vStubReleaseNetworkBuffer );
+    pxTCPSocketLookup_Stub( pxStubTCPSocketLookup );
+    prvTCPSendReset_IgnoreAndReturn( pdFAIL );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    /* Leave nothing behind for the next test. */
+    vTCPRxCoalesceFlush();
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief Fill in an IPv4 TCP packet with 'uxPayloadLength' bytes of payload.
+ *        The payload bytes are equal to the low byte of their sequence number.
+ */
+static NetworkBufferDescriptor_t * prvPacket( size_t uxIndex,
+                                              uint32_t ulSequenceNumber,
+                                              size_t uxPayloadLength,
+                                              uint8_t ucTCPFlags )
+{
+    NetworkBufferDescriptor_t * pxPacket = &( xPackets[ uxIndex ] );
+    uint8_t * pucBuffer = ucPacketBuffers[ uxIndex ];
+    EthernetHeader_t * pxEthernetHeader = ( EthernetHeader_t * ) pucBuffer;
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( pucBuffer[ TEST_IP_OFFSET ] );
+    TCPHeader_t * pxTCPHeader = ( TCPHeader_t * ) &( pucBuffer[ TEST_TCP_OFFSET ] );
+    size_t uxIndex2;
+
+    pxPacket->pucEthernetBuffer = pucBuffer;
+    pxPacket->xDataLength = TEST_HEADER_LENGTH + uxPayloadLength;
+
+    pxEthernetHeader->usFrameType = ipIPv4_FRAME_TYPE;
+    pxIPHeader->ucVersionHeaderLength = 0x45U;
+    pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + uxPayloadLength ) );
+    pxIPHeader->ucProtocol = ipPROTOCOL_TCP;
+    pxIPHeader->ulSourceIPAddress = FreeRTOS_htonl( 0xC0A80002U );
+    pxIPHeader->ulDestinationIPAddress = FreeRTOS_htonl( 0xC0A80001U );
+
+    pxTCPHeader->usSourcePort = FreeRTOS_htons( 5000U );
+    pxTCPHeader->usDestinationPort = FreeRTOS_htons( 80U );
+    pxTCPHeader->ulSequenceNumber = FreeRTOS_htonl( ulSequenceNumber );
+    pxTCPHeader->ulAckNr = FreeRTOS_htonl( 7000U );
+    pxTCPHeader->ucTCPOffset = 0x50U;
+    pxTCPHeader->ucTCPFlags = ucTCPFlags;
+    pxTCPHeader->usWindow = FreeRTOS_htons( 4096U );
+
+    for( uxIndex2 = 0U; uxIndex2 < uxPayloadLength; uxIndex2++ )
+    {
+        pucBuffer[ TEST_HEADER_LENGTH + uxIndex2 ] = ( uint8_t ) ( ulSequenceNumber + uxIndex2 );
+    }
+
+    return pxPacket;
+}
+
+/**
+ * @brief Add a 12-byte time-stamp option to a packet made by prvPacket().
+ */
+static void prvAddTimeStamps( NetworkBufferDescriptor_t * pxPacket,
+                              uint32_t ulTimeStamp )
+{
+    uint8_t * pucBuffer = pxPacket->pucEthernetBuffer;
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( pucBuffer[ TEST_IP_OFFSET ] );
+    TCPHeader_t * pxTCPHeader = ( TCPHeader_t * ) &( pucBuffer[ TEST_TCP_OFFSET ] );
+    size_t uxPayloadLength = pxPacket->xDataLength - TEST_HEADER_LENGTH;
+    uint8_t * pucOptions = &( pucBuffer[ TEST_HEADER_LENGTH ] );
+
+    memmove( &( pucOptions[ 12 ] ), pucOptions, uxPayloadLength );
+    pucOptions[ 0 ] = tcpTCP_OPT_NOOP;
+    pucOptions[ 1 ] = tcpTCP_OPT_NOOP;
+    pucOptions[ 2 ] = tcpTCP_OPT_TIMESTAMP;
+    pucOptions[ 3 ] = tcpTCP_OPT_TIMESTAMP_LEN;
+    pucOptions[ 4 ] = ( uint8_t ) ( ulTimeStamp >> 24 );
+    pucOptions[ 5 ] = ( uint8_t ) ( ulTimeStamp >> 16 );
+    pucOptions[ 6 ] = ( uint8_t ) ( ulTimeStamp >> 8 );
+    pucOptions[ 7 ] = ( uint8_t ) ulTimeStamp;
+    memset( &( pucOptions[ 8 ] ), 0, 4U );
+
+    pxTCPHeader->ucTCPOffset = 0x80U;
+    pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( FreeRTOS_ntohs( pxIPHeader->usLength ) + 12U ) );
+    pxPacket->xDataLength += 12U;
+}
+
+/**
+ * @brief Segments of the same flow that follow on each other are merged into
+ *        a single segment, and the IP length is updated.
+ */
+void test_xTCPRxCoalesce_SameFlow_Merged( void )
+{
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucMergedBuffer[ TEST_IP_OFFSET ] );
+    size_t uxIndex;
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 1U, TEST_SEQUENCE_NUMBER + 100U, 100U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 2U, TEST_SEQUENCE_NUMBER + 200U, 50U, tcpTCP_FLAG_ACK ) ) );
+
+    /* Nothing is processed before the end of the burst. */
+    TEST_ASSERT_EQUAL( 0U, uxProcessedCount );
+
+    vTCPRxCoalesceFlush();
+
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+    TEST_ASSERT_EQUAL( TEST_HEADER_LENGTH + 250U, uxMergedRequested );
+    TEST_ASSERT_EQUAL( TEST_HEADER_LENGTH + 250U, xMerged.xDataLength );
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + 250U, FreeRTOS_ntohs( pxIPHeader->usLength ) );
+    TEST_ASSERT_EQUAL_MEMORY( ucPacketBuffers[ 0 ], ucMergedBuffer, TEST_IP_OFFSET + 2U );
+
+    for( uxIndex = 0U; uxIndex < 250U; uxIndex++ )
+    {
+        TEST_ASSERT_EQUAL_UINT8( ( uint8_t ) ( TEST_SEQUENCE_NUMBER + uxIndex ), ucMergedBuffer[ TEST_HEADER_LENGTH + uxIndex ] );
+    }
+
+    /* The segments are released when merged, the merged segment after it was processed. */
+    TEST_ASSERT_EQUAL( 4U, uxReleasedCount );
+    TEST_ASSERT_EQUAL_PTR( &( xPackets[ 0 ] ), pxReleased[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( xPackets[ 2 ] ), pxReleased[ 2 ] );
+    TEST_ASSERT_EQUAL_PTR( &xMerged, pxReleased[ 3 ] );
+}
+
+/**
+ * @brief A PSH flag of any of the segments is passed on to the merged segment.
+ */
+void test_xTCPRxCoalesce_PSH_PassedOn( void )
+{
+    const TCPHeader_t * pxTCPHeader = ( const TCPHeader_t * ) &( ucMergedBuffer[ TEST_TCP_OFFSET ] );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK | tcpTCP_FLAG_PSH ) ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 1U, TEST_SEQUENCE_NUMBER + 100U, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    vTCPRxCoalesceFlush();
+
+    TEST_ASSERT_EQUAL( tcpTCP_FLAG_ACK | tcpTCP_FLAG_PSH, pxTCPHeader->ucTCPFlags );
+}
+
+/**
+ * @brief A single segment is processed as it is.
+ */
+void test_vTCPRxCoalesceFlush_SingleSegment( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    vTCPRxCoalesceFlush();
+
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+    TEST_ASSERT_EQUAL( 0U, uxMergedRequested );
+    TEST_ASSERT_EQUAL( 1U, uxReleasedCount );
+    TEST_ASSERT_EQUAL_PTR( &( xPackets[ 0 ] ), pxReleased[ 0 ] );
+}
+
+/**
+ * @brief A segment that does not follow on the previous one ends the merge,
+ *        and is held for the next one.
+ */
+void test_xTCPRxCoalesce_OutOfOrder_Breaks( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 1U, TEST_SEQUENCE_NUMBER + 200U, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+    TEST_ASSERT_EQUAL_PTR( &( xPackets[ 0 ] ), pxReleased[ 0 ] );
+
+    /* A retransmission of the first segment. */
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 2U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    TEST_ASSERT_EQUAL( 2U, uxProcessedCount );
+    TEST_ASSERT_EQUAL_PTR( &( xPackets[ 1 ] ), pxReleased[ 1 ] );
+    TEST_ASSERT_EQUAL( 0U, uxMergedRequested );
+}
+
+/**
+ * @brief A segment of another connection ends the merge.
+ */
+void test_xTCPRxCoalesce_OtherFlow_Breaks( void )
+{
+    NetworkBufferDescriptor_t * pxPacket;
+    TCPHeader_t * pxTCPHeader;
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    pxPacket = prvPacket( 1U, TEST_SEQUENCE_NUMBER + 100U, 100U, tcpTCP_FLAG_ACK );
+    pxTCPHeader = ( TCPHeader_t * ) &( pxPacket->pucEthernetBuffer[ TEST_TCP_OFFSET ] );
+    pxTCPHeader->usSourcePort = FreeRTOS_htons( 5001U );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( pxPacket ) );
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+}
+
+/**
+ * @brief A segment from another IP address ends the merge.
+ */
+void test_xTCPRxCoalesce_OtherAddress_Breaks( void )
+{
+    NetworkBufferDescriptor_t * pxPacket;
+    IPHeader_t * pxIPHeader;
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    pxPacket = prvPacket( 1U, TEST_SEQUENCE_NUMBER + 100U, 100U, tcpTCP_FLAG_ACK );
+    pxIPHeader = ( IPHeader_t * ) &( pxPacket->pucEthernetBuffer[ TEST_IP_OFFSET ] );
+    pxIPHeader->ulSourceIPAddress = FreeRTOS_htonl( 0xC0A80003U );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( pxPacket ) );
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+}
+
+/**
+ * @brief A segment with another acknowledgement number or window ends the
+ *        merge, because these must be processed by the window code.
+ */
+void test_xTCPRxCoalesce_AckOrWindowChanged_Breaks( void )
+{
+    NetworkBufferDescriptor_t * pxPacket;
+    TCPHeader_t * pxTCPHeader;
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    pxPacket = prvPacket( 1U, TEST_SEQUENCE_NUMBER + 100U, 100U, tcpTCP_FLAG_ACK );
+    pxTCPHeader = ( TCPHeader_t * ) &( pxPacket->pucEthernetBuffer[ TEST_TCP_OFFSET ] );
+    pxTCPHeader->ulAckNr = FreeRTOS_htonl( 7100U );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( pxPacket ) );
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+
+    pxPacket = prvPacket( 2U, TEST_SEQUENCE_NUMBER + 200U, 100U, tcpTCP_FLAG_ACK );
+    pxTCPHeader = ( TCPHeader_t * ) &( pxPacket->pucEthernetBuffer[ TEST_TCP_OFFSET ] );
+    pxTCPHeader->ulAckNr = FreeRTOS_htonl( 7100U );
+    pxTCPHeader->usWindow = FreeRTOS_htons( 2048U );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( pxPacket ) );
+    TEST_ASSERT_EQUAL( 2U, uxProcessedCount );
+}
+
+/**
+ * @brief Segments with the same TCP options are merged, segments with other
+ *        options are not.
+ */
+void test_xTCPRxCoalesce_Options( void )
+{
+    NetworkBufferDescriptor_t * pxPacket;
+
+    pxPacket = prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK );
+    prvAddTimeStamps( pxPacket, 0x11223344U );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( pxPacket ) );
+
+    pxPacket = prvPacket( 1U, TEST_SEQUENCE_NUMBER + 100U, 100U, tcpTCP_FLAG_ACK );
+    prvAddTimeStamps( pxPacket, 0x11223344U );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( pxPacket ) );
+    TEST_ASSERT_EQUAL( 0U, uxProcessedCount );
+
+    /* Another time-stamp. */
+    pxPacket = prvPacket( 2U, TEST_SEQUENCE_NUMBER + 200U, 100U, tcpTCP_FLAG_ACK );
+    prvAddTimeStamps( pxPacket, 0x11223345U );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( pxPacket ) );
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+
+    /* The first two were merged, the options are kept. */
+    TEST_ASSERT_EQUAL( TEST_HEADER_LENGTH + 12U + 200U, xMerged.xDataLength );
+    TEST_ASSERT_EQUAL_MEMORY( &( ucPacketBuffers[ 0 ][ TEST_HEADER_LENGTH ] ), &( ucMergedBuffer[ TEST_HEADER_LENGTH ] ), 12U + 100U );
+
+    /* No options at all. */
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 3U, TEST_SEQUENCE_NUMBER + 300U, 100U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( 2U, uxProcessedCount );
+}
+
+/**
+ * @brief Packets with other flags than ACK and PSH are not held, and flush
+ *        the segments held before them, so that they are processed in order.
+ */
+void test_xTCPRxCoalesce_Flags_NotHeld( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xTCPRxCoalesce( prvPacket( 1U, TEST_SEQUENCE_NUMBER + 100U, 100U, tcpTCP_FLAG_ACK | tcpTCP_FLAG_FIN ) ) );
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xTCPRxCoalesce( prvPacket( 2U, TEST_SEQUENCE_NUMBER + 100U, 100U, tcpTCP_FLAG_ACK | tcpTCP_FLAG_URG ) ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xTCPRxCoalesce( prvPacket( 3U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_SYN ) ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xTCPRxCoalesce( prvPacket( 4U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_RST | tcpTCP_FLAG_ACK ) ) );
+
+    /* Nothing held, nothing more processed. */
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+}
+
+/**
+ * @brief A packet without payload is not held.
+ */
+void test_xTCPRxCoalesce_NoPayload_NotHeld( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xTCPRxCoalesce( prvPacket( 1U, TEST_SEQUENCE_NUMBER + 100U, 0U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+}
+
+/**
+ * @brief Padding after the IP packet is not taken as payload.
+ */
+void test_xTCPRxCoalesce_Padding( void )
+{
+    NetworkBufferDescriptor_t * pxPacket;
+    const IPHeader_t * pxIPHeader = ( const IPHeader_t * ) &( ucMergedBuffer[ TEST_IP_OFFSET ] );
+
+    /* An Ethernet frame of the minimum size, with 2 bytes of payload. */
+    pxPacket = prvPacket( 0U, TEST_SEQUENCE_NUMBER, 2U, tcpTCP_FLAG_ACK );
+    pxPacket->xDataLength = 60U;
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( pxPacket ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 1U, TEST_SEQUENCE_NUMBER + 2U, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    vTCPRxCoalesceFlush();
+
+    TEST_ASSERT_EQUAL( TEST_HEADER_LENGTH + 102U, xMerged.xDataLength );
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + 102U, FreeRTOS_ntohs( pxIPHeader->usLength ) );
+}
+
+/**
+ * @brief The merged segment does not exceed ipconfigTCP_RX_COALESCE_MAX_SIZE.
+ */
+void test_xTCPRxCoalesce_MaxSize( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 1400U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 1U, TEST_SEQUENCE_NUMBER + 1400U, 1400U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( 0U, uxProcessedCount );
+
+    /* 4200 bytes would be too much. */
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 2U, TEST_SEQUENCE_NUMBER + 2800U, 1400U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( 1U, uxProcessedCount );
+    TEST_ASSERT_EQUAL( TEST_HEADER_LENGTH + 2800U, xMerged.xDataLength );
+}
+
+/**
+ * @brief When no buffer is available for merging, the segments are processed
+ *        one by one.
+ */
+void test_vTCPRxCoalesceFlush_NoBuffer( void )
+{
+    xMergedAvailable = pdFALSE;
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPRxCoalesce( prvPacket( 1U, TEST_SEQUENCE_NUMBER + 100U, 100U, tcpTCP_FLAG_ACK ) ) );
+
+    vTCPRxCoalesceFlush();
+
+    TEST_ASSERT_EQUAL( 2U, uxProcessedCount );
+    TEST_ASSERT_EQUAL( 2U, uxReleasedCount );
+    TEST_ASSERT_EQUAL_PTR( &( xPackets[ 0 ] ), pxReleased[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( xPackets[ 1 ] ), pxReleased[ 1 ] );
+}
+
+/**
+ * @brief Network buffers of a fixed size can not hold a merged segment.
+ */
+void test_xTCPRxCoalesce_FixedSizeBuffers( void )
+{
+    xBufferAllocFixedSize = pdTRUE;
+
+    TEST_ASSERT_EQUAL( pdFAIL, xTCPRxCoalesce( prvPacket( 0U, TEST_SEQUENCE_NUMBER, 100U, tcpTCP_FLAG_ACK ) ) );
+}
+
+/**
+ * @brief A flush without segments held does nothing.
+ */
+void test_vTCPRxCoalesceFlush_Empty( void )
+{
+    vTCPRxCoalesceFlush();
+
+    TEST_ASSERT_EQUAL( 0U, uxProcessedCount );
+    TEST_ASSERT_EQUAL( 0U, uxReleasedCount );
+}
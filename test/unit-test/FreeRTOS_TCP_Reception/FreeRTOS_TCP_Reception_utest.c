@@ -303,8 +303,11 @@ void test_prvCheckOptions_MSS_WSF_SYN_on( void )
     pxSocket->u.xTCP.usMSS = 1400;
     uxIPHeaderSizePacket_ExpectAnyArgsAndReturn( ipSIZE_OF_IPv4_HEADER );
     usChar2u16_ExpectAnyArgsAndReturn( 500 );
+    /* The shift count of 16 is limited to 14. */
+    FreeRTOS_min_uint32_ExpectAndReturn( 0x10, tcpTCP_OPT_WSOPT_MAX_SHIFT, tcpTCP_OPT_WSOPT_MAX_SHIFT );
     xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
     TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL( tcpTCP_OPT_WSOPT_MAX_SHIFT, pxSocket->u.xTCP.ucPeerWinScaleFactor );
 }
 
 /* Test for prvSingleStepTCPHeaderOptions function. */
@@ -821,7 +824,7 @@ void test_prvStoreRxData_Happy_Path( void )
 
     xResult = prvStoreRxData( pxSocket,
                               pData,
-                              pxNetworkBuffer,
+                              &pxNetworkBuffer,
                               14 );
 
     TEST_ASSERT_EQUAL( 0, xResult );
@@ -853,7 +856,7 @@ void test_prvStoreRxData_Wrong_State( void )
 
     xResult = prvStoreRxData( pxSocket,
                               pData,
-                              pxNetworkBuffer,
+                              &pxNetworkBuffer,
                               105 );
 
     TEST_ASSERT_EQUAL( 0, xResult );
@@ -894,7 +897,7 @@ void test_prvStoreRxData_Zero_Length( void )
 
     xResult = prvStoreRxData( pxSocket,
                               pData,
-                              pxNetworkBuffer,
+                              &pxNetworkBuffer,
                               0 );
 
     TEST_ASSERT_EQUAL( 0, xResult );
@@ -932,7 +935,7 @@ void test_prvStoreRxData_Null_RxStream( void )
 
     xResult = prvStoreRxData( pxSocket,
                               pData,
-                              pxNetworkBuffer,
+                              &pxNetworkBuffer,
                               105 );
 
     TEST_ASSERT_EQUAL( -1, xResult );
@@ -969,7 +972,7 @@ void test_prvStoreRxData_Negative_Offset( void )
 
     xResult = prvStoreRxData( pxSocket,
                               pData,
-                              pxNetworkBuffer,
+                              &pxNetworkBuffer,
                               105 );
 
     TEST_ASSERT_EQUAL( 0, xResult );
@@ -1023,7 +1026,7 @@ void test_prvStoreRxData_None_Zero_Skipcount( void )
 
     xResult = prvStoreRxData( pxSocket,
                               pData,
-                              pxNetworkBuffer,
+                              &pxNetworkBuffer,
                               14 );
 
     TEST_ASSERT_EQUAL( 0, xResult );
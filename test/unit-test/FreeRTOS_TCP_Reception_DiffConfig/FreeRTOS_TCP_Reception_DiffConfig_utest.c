@@ -0,0 +1,310 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_TCP_Transmission.h"
+
+#include "FreeRTOS_TCP_IP.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_Reception_DiffConfig_stubs.c"
+#include "FreeRTOS_TCP_Reception.h"
+
+#define TEST_TCP_HEADER_OFFSET    ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER )
+
+/* The sequence number expected by the reception window. */
+#define TEST_SEQUENCE_NUMBER      ( 0x1000U )
+
+/* The most recent time-stamp of the peer, TS.Recent. */
+#define TEST_TS_RECENT            ( 900U )
+
+FreeRTOS_Socket_t xSocket, * pxSocket;
+NetworkBufferDescriptor_t xNetworkBuffer, * pxNetworkBuffer;
+uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU ];
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+
+    pxSocket = &xSocket;
+    pxNetworkBuffer = &xNetworkBuffer;
+    pxNetworkBuffer->pucEthernetBuffer = ucEthernetBuffer;
+
+    /* A connection that negotiated time-stamps. */
+    pxSocket->u.xTCP.bits.bTimeStamps = pdTRUE_UNSIGNED;
+    pxSocket->u.xTCP.ulTimeStampRecent = TEST_TS_RECENT;
+    pxSocket->u.xTCP.xTCPWindow.rx.ulCurrentSequenceNumber = TEST_SEQUENCE_NUMBER;
+
+    uxIPHeaderSizePacket_IgnoreAndReturn( ipSIZE_OF_IPv4_HEADER );
+    ulChar2u32_Stub( ulStubChar2u32 );
+    xSequenceGreaterThan_Stub( xStubSequenceGreaterThan );
+}
+
+/* ======================== Helper Functions ========================= */
+
+/**
+ * @brief Let the received packet carry a time-stamps option, aligned by two
+ *        NOOP's as most peers send it.
+ */
+static void prvSetTimeStamps( uint8_t ucFlags,
+                              uint32_t ulSequenceNumber,
+                              uint32_t ulValue,
+                              uint32_t ulEchoReply )
+{
+    ProtocolHeaders_t * pxProtocolHeader = ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_TCP_HEADER_OFFSET ] );
+    TCPHeader_t * pxTCPHeader = &( pxProtocolHeader->xTCPHeader );
+    uint8_t * pucOption = pxTCPHeader->ucOptdata;
+
+    pxTCPHeader->ucTCPFlags = ucFlags;
+    pxTCPHeader->ulSequenceNumber = FreeRTOS_htonl( ulSequenceNumber );
+    pxTCPHeader->ucTCPOffset = ( uint8_t ) ( ( 5U + 3U ) << 4 );
+
+    pucOption[ 0 ] = tcpTCP_OPT_NOOP;
+    pucOption[ 1 ] = tcpTCP_OPT_NOOP;
+    pucOption[ 2 ] = ( uint8_t ) tcpTCP_OPT_TIMESTAMP;
+    pucOption[ 3 ] = ( uint8_t ) tcpTCP_OPT_TIMESTAMP_LEN;
+    pucOption[ 4 ] = ( uint8_t ) ( ulValue >> 24 );
+    pucOption[ 5 ] = ( uint8_t ) ( ulValue >> 16 );
+    pucOption[ 6 ] = ( uint8_t ) ( ulValue >> 8 );
+    pucOption[ 7 ] = ( uint8_t ) ulValue;
+    pucOption[ 8 ] = ( uint8_t ) ( ulEchoReply >> 24 );
+    pucOption[ 9 ] = ( uint8_t ) ( ulEchoReply >> 16 );
+    pucOption[ 10 ] = ( uint8_t ) ( ulEchoReply >> 8 );
+    pucOption[ 11 ] = ( uint8_t ) ulEchoReply;
+
+    pxNetworkBuffer->xDataLength = TEST_TCP_HEADER_OFFSET + ipSIZE_OF_TCP_HEADER + tcpTCP_OPT_TIMESTAMP_SPACE;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief A newer time-stamp at the left edge of the window becomes TS.Recent,
+ *        and its TSecr is handed to the window for an RTT sample.
+ */
+void test_prvCheckOptions_TimeStamps_Accepted( void )
+{
+    BaseType_t xReturn;
+
+    prvSetTimeStamps( tcpTCP_FLAG_ACK, TEST_SEQUENCE_NUMBER, 1000U, 0x12345678U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL( pdTRUE_UNSIGNED, pxSocket->u.xTCP.bits.bTimeStampSeen );
+    TEST_ASSERT_EQUAL_UINT32( 1000U, pxSocket->u.xTCP.ulTimeStampRecent );
+    TEST_ASSERT_EQUAL( pdTRUE_UNSIGNED, pxSocket->u.xTCP.xTCPWindow.u.bits.bTimeStampEcho );
+    TEST_ASSERT_EQUAL_UINT32( 0x12345678U, pxSocket->u.xTCP.xTCPWindow.ulTimeStampEcho );
+}
+
+/**
+ * @brief A TSecr of zero is a valid echo, e.g. of a clock that just wrapped.
+ */
+void test_prvCheckOptions_TimeStamps_EchoZero( void )
+{
+    BaseType_t xReturn;
+
+    prvSetTimeStamps( tcpTCP_FLAG_ACK, TEST_SEQUENCE_NUMBER, 1000U, 0U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL( pdTRUE_UNSIGNED, pxSocket->u.xTCP.xTCPWindow.u.bits.bTimeStampEcho );
+    TEST_ASSERT_EQUAL_UINT32( 0U, pxSocket->u.xTCP.xTCPWindow.ulTimeStampEcho );
+}
+
+/**
+ * @brief A segment without an ACK has no valid TSecr.
+ */
+void test_prvCheckOptions_TimeStamps_NoAck( void )
+{
+    BaseType_t xReturn;
+
+    prvSetTimeStamps( tcpTCP_FLAG_PSH, TEST_SEQUENCE_NUMBER, 1000U, 0U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL_UINT32( 1000U, pxSocket->u.xTCP.ulTimeStampRecent );
+    TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, pxSocket->u.xTCP.xTCPWindow.u.bits.bTimeStampEcho );
+}
+
+/**
+ * @brief PAWS: a segment with a time-stamp older than TS.Recent is dropped.
+ */
+void test_prvCheckOptions_TimeStamps_PAWS( void )
+{
+    BaseType_t xReturn;
+
+    prvSetTimeStamps( tcpTCP_FLAG_ACK, TEST_SEQUENCE_NUMBER, TEST_TS_RECENT - 1U, 0x12345678U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xReturn );
+    TEST_ASSERT_EQUAL_UINT32( TEST_TS_RECENT, pxSocket->u.xTCP.ulTimeStampRecent );
+    TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, pxSocket->u.xTCP.xTCPWindow.u.bits.bTimeStampEcho );
+}
+
+/**
+ * @brief A time-stamp equal to TS.Recent is not old, e.g. when the peer sends
+ *        several segments within one tick of its clock.
+ */
+void test_prvCheckOptions_TimeStamps_PAWS_SameValue( void )
+{
+    BaseType_t xReturn;
+
+    prvSetTimeStamps( tcpTCP_FLAG_ACK, TEST_SEQUENCE_NUMBER, TEST_TS_RECENT, 0x12345678U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL( pdTRUE_UNSIGNED, pxSocket->u.xTCP.xTCPWindow.u.bits.bTimeStampEcho );
+}
+
+/**
+ * @brief PAWS compares time-stamps modulo 2^32: a TSval just after the wrap
+ *        is newer than a TS.Recent just before it.
+ */
+void test_prvCheckOptions_TimeStamps_PAWS_Wrap( void )
+{
+    BaseType_t xReturn;
+
+    pxSocket->u.xTCP.ulTimeStampRecent = 0xFFFFFF00U;
+    prvSetTimeStamps( tcpTCP_FLAG_ACK, TEST_SEQUENCE_NUMBER, 0x10U, 0x12345678U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL_UINT32( 0x10U, pxSocket->u.xTCP.ulTimeStampRecent );
+}
+
+/**
+ * @brief An old time-stamp does not stop a reset.
+ */
+void test_prvCheckOptions_TimeStamps_PAWS_Reset( void )
+{
+    BaseType_t xReturn;
+
+    prvSetTimeStamps( tcpTCP_FLAG_RST | tcpTCP_FLAG_ACK, TEST_SEQUENCE_NUMBER, TEST_TS_RECENT - 1U, 0x12345678U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+}
+
+/**
+ * @brief A segment beyond the left edge of the window does not update
+ *        TS.Recent, but its TSecr still gives an RTT sample.
+ */
+void test_prvCheckOptions_TimeStamps_OutOfOrder( void )
+{
+    BaseType_t xReturn;
+
+    prvSetTimeStamps( tcpTCP_FLAG_ACK, TEST_SEQUENCE_NUMBER + 1000U, 1000U, 0x12345678U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL_UINT32( TEST_TS_RECENT, pxSocket->u.xTCP.ulTimeStampRecent );
+    TEST_ASSERT_EQUAL( pdTRUE_UNSIGNED, pxSocket->u.xTCP.xTCPWindow.u.bits.bTimeStampEcho );
+}
+
+/**
+ * @brief A SYN with time-stamps negotiates them, its TSval becomes TS.Recent.
+ */
+void test_prvCheckOptions_TimeStamps_SYN( void )
+{
+    BaseType_t xReturn;
+
+    pxSocket->u.xTCP.bits.bTimeStamps = pdFALSE_UNSIGNED;
+    pxSocket->u.xTCP.ulTimeStampRecent = 0U;
+    prvSetTimeStamps( tcpTCP_FLAG_SYN, TEST_SEQUENCE_NUMBER, 0x80000000U, 0U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL( pdTRUE_UNSIGNED, pxSocket->u.xTCP.bits.bTimeStamps );
+    TEST_ASSERT_EQUAL_UINT32( 0x80000000U, pxSocket->u.xTCP.ulTimeStampRecent );
+}
+
+/**
+ * @brief Time-stamps in a connection that did not negotiate them are ignored.
+ */
+void test_prvCheckOptions_TimeStamps_NotNegotiated( void )
+{
+    BaseType_t xReturn;
+
+    pxSocket->u.xTCP.bits.bTimeStamps = pdFALSE_UNSIGNED;
+    prvSetTimeStamps( tcpTCP_FLAG_ACK, TEST_SEQUENCE_NUMBER, TEST_TS_RECENT - 1U, 0x12345678U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+    TEST_ASSERT_EQUAL_UINT32( TEST_TS_RECENT, pxSocket->u.xTCP.ulTimeStampRecent );
+    TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, pxSocket->u.xTCP.xTCPWindow.u.bits.bTimeStampEcho );
+}
+
+/**
+ * @brief A time-stamps option with a wrong length is rejected.
+ */
+void test_prvCheckOptions_TimeStamps_BadLength( void )
+{
+    BaseType_t xReturn;
+    ProtocolHeaders_t * pxProtocolHeader = ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_TCP_HEADER_OFFSET ] );
+
+    prvSetTimeStamps( tcpTCP_FLAG_ACK, TEST_SEQUENCE_NUMBER, 1000U, 0x12345678U );
+    pxProtocolHeader->xTCPHeader.ucOptdata[ 3 ] = ( uint8_t ) ( tcpTCP_OPT_TIMESTAMP_LEN - 1U );
+
+    xReturn = prvCheckOptions( pxSocket, pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xReturn );
+    TEST_ASSERT_EQUAL_UINT32( TEST_TS_RECENT, pxSocket->u.xTCP.ulTimeStampRecent );
+}
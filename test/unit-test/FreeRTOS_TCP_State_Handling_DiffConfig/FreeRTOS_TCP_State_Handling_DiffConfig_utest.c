@@ -0,0 +1,187 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_TCP_Transmission.h"
+#include "mock_FreeRTOS_TCP_Reception.h"
+#include "mock_TCP_State_Handling_DiffConfig_list_macros.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_State_Handling.h"
+#include "FreeRTOS_TCP_State_Handling_DiffConfig_stubs.c"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+BaseType_t prvHandleSynReceived( FreeRTOS_Socket_t * pxSocket,
+                                 const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                 uint32_t ulReceiveLength,
+                                 UBaseType_t uxOptionsLength );
+
+FreeRTOS_Socket_t xSocket, * pxSocket;
+NetworkBufferDescriptor_t xNetworkBuffer, * pxNetworkBuffer;
+
+uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU ];
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( &ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+
+    pxSocket = NULL;
+    pxNetworkBuffer = NULL;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief The child socket inherits the congestion control algorithm of
+ *        the listening socket.
+ */
+void test_prvTCPSocketCopy_CongestionControl( void )
+{
+    BaseType_t Result = pdFALSE;
+    FreeRTOS_Socket_t MockReturnSocket;
+    TCPCongestionControl_t xAlgorithm;
+
+    memset( &MockReturnSocket, 0, sizeof( MockReturnSocket ) );
+    memset( &xAlgorithm, 0, sizeof( xAlgorithm ) );
+
+    pxSocket = &xSocket;
+
+    pxSocket->usLocalPort = 22;
+    pxSocket->pxSocketSet = NULL;
+    pxSocket->u.xTCP.pxCongestionControl = &xAlgorithm;
+
+    FreeRTOS_GetLocalAddress_ExpectAndReturn( pxSocket, NULL, pdTRUE );
+    FreeRTOS_GetLocalAddress_IgnoreArg_pxAddress();
+    vSocketBind_ExpectAnyArgsAndReturn( 0 );
+
+    Result = prvTCPSocketCopy( &MockReturnSocket, pxSocket );
+    TEST_ASSERT_EQUAL( pdTRUE, Result );
+    TEST_ASSERT_EQUAL_PTR( &xAlgorithm, MockReturnSocket.u.xTCP.pxCongestionControl );
+}
+
+/**
+ * @brief Complete a passive open: the ACK of our SYN+ACK is received.
+ */
+static void prvCompleteSynReceived( void )
+{
+    BaseType_t xSendLength;
+    ProtocolHeaders_t * pxProtocolHeaders;
+
+    pxNetworkBuffer = &xNetworkBuffer;
+    pxNetworkBuffer->pucEthernetBuffer = ucEthernetBuffer;
+    pxProtocolHeaders = ( ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER ] ) );
+
+    pxSocket->u.xTCP.eTCPState = eSYN_RECEIVED;
+    pxProtocolHeaders->xTCPHeader.ucTCPFlags = tcpTCP_FLAG_ACK;
+
+    uxIPHeaderSizeSocket_IgnoreAndReturn( ipSIZE_OF_IPv4_HEADER );
+    FreeRTOS_inet_ntop_ExpectAnyArgsAndReturn( ( void * ) 0x1234 );
+    vTCPStateChange_Expect( pxSocket, eESTABLISHED );
+
+    xSendLength = prvHandleSynReceived( pxSocket, pxNetworkBuffer, 0, 0 );
+    TEST_ASSERT_EQUAL( 0, xSendLength );
+}
+
+/**
+ * @brief Once time-stamps are negotiated, every segment carries 12 bytes of
+ *        options, which are taken from the MSS.
+ */
+void test_prvHandleSynReceived_TimeStampsReduceMSS( void )
+{
+    pxSocket = &xSocket;
+    pxSocket->u.xTCP.bits.bTimeStamps = pdTRUE_UNSIGNED;
+    pxSocket->u.xTCP.usMSS = 1460U;
+    pxSocket->u.xTCP.xTCPWindow.usMSS = 1460U;
+
+    prvCompleteSynReceived();
+
+    TEST_ASSERT_EQUAL_UINT16( 1460U - tcpTCP_OPT_TIMESTAMP_SPACE, pxSocket->u.xTCP.usMSS );
+    TEST_ASSERT_EQUAL_UINT16( 1460U - tcpTCP_OPT_TIMESTAMP_SPACE, pxSocket->u.xTCP.xTCPWindow.usMSS );
+}
+
+/**
+ * @brief Without time-stamps, the MSS is left as it is.
+ */
+void test_prvHandleSynReceived_NoTimeStampsKeepMSS( void )
+{
+    pxSocket = &xSocket;
+    pxSocket->u.xTCP.bits.bTimeStamps = pdFALSE_UNSIGNED;
+    pxSocket->u.xTCP.usMSS = 1460U;
+    pxSocket->u.xTCP.xTCPWindow.usMSS = 1460U;
+
+    prvCompleteSynReceived();
+
+    TEST_ASSERT_EQUAL_UINT16( 1460U, pxSocket->u.xTCP.usMSS );
+    TEST_ASSERT_EQUAL_UINT16( 1460U, pxSocket->u.xTCP.xTCPWindow.usMSS );
+}
+
+/**
+ * @brief The MSS is not reduced below the minimum segment length.
+ */
+void test_prvHandleSynReceived_TimeStampsMinimumMSS( void )
+{
+    uint16_t usMSS = ( uint16_t ) ( tcpMINIMUM_SEGMENT_LENGTH + tcpTCP_OPT_TIMESTAMP_SPACE );
+
+    pxSocket = &xSocket;
+    pxSocket->u.xTCP.bits.bTimeStamps = pdTRUE_UNSIGNED;
+    pxSocket->u.xTCP.usMSS = usMSS;
+    pxSocket->u.xTCP.xTCPWindow.usMSS = usMSS;
+
+    prvCompleteSynReceived();
+
+    TEST_ASSERT_EQUAL_UINT16( usMSS, pxSocket->u.xTCP.usMSS );
+
+    /* One byte more leaves exactly the minimum. */
+    pxSocket->u.xTCP.usMSS = usMSS + 1U;
+
+    prvCompleteSynReceived();
+
+    TEST_ASSERT_EQUAL_UINT16( tcpMINIMUM_SEGMENT_LENGTH + 1U, pxSocket->u.xTCP.usMSS );
+}
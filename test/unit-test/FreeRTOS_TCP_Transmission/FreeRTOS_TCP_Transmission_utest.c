@@ -1932,6 +1932,70 @@ void test_prvTCPAddTxData_Normal( void )
     prvTCPAddTxData( pxSocket );
 }
 
+/* test prvTCPAddTxData function: a corked socket only passes full segments
+ * to the sliding window. */
+void test_prvTCPAddTxData_Corked( void )
+{
+    pxSocket = &xSocket;
+    StreamBuffer_t TxStream;
+    pxSocket->u.xTCP.txStream = &TxStream;
+    pxSocket->u.xTCP.xTCPWindow.usMSS = 1000;
+    pxSocket->u.xTCP.bits.bCork = pdTRUE_UNSIGNED;
+    pxSocket->u.xTCP.bits.bCloseRequested = pdFALSE_UNSIGNED;
+    pxSocket->u.xTCP.bits.bUserShutdown = pdFALSE_UNSIGNED;
+
+    uxStreamBufferMidSpace_ExpectAndReturn( pxSocket->u.xTCP.txStream, 2300 );
+    lTCPWindowTxAdd_ExpectAndReturn( &( pxSocket->u.xTCP.xTCPWindow ), 2000, 0, 0, 2000 );
+    lTCPWindowTxAdd_IgnoreArg_lPosition();
+    lTCPWindowTxAdd_IgnoreArg_lMax();
+    vStreamBufferMoveMid_Expect( pxSocket->u.xTCP.txStream, 2000 );
+
+    prvTCPAddTxData( pxSocket );
+
+    pxSocket->u.xTCP.bits.bCork = pdFALSE_UNSIGNED;
+}
+
+/* test prvTCPAddTxData function: less than a segment and more data follows. */
+void test_prvTCPAddTxData_More_Partial( void )
+{
+    pxSocket = &xSocket;
+    StreamBuffer_t TxStream;
+    pxSocket->u.xTCP.txStream = &TxStream;
+    pxSocket->u.xTCP.xTCPWindow.usMSS = 1000;
+    pxSocket->u.xTCP.bits.bMore = pdTRUE_UNSIGNED;
+    pxSocket->u.xTCP.bits.bCloseRequested = pdFALSE_UNSIGNED;
+    pxSocket->u.xTCP.bits.bUserShutdown = pdFALSE_UNSIGNED;
+
+    uxStreamBufferMidSpace_ExpectAndReturn( pxSocket->u.xTCP.txStream, 300 );
+
+    prvTCPAddTxData( pxSocket );
+
+    pxSocket->u.xTCP.bits.bMore = pdFALSE_UNSIGNED;
+}
+
+/* test prvTCPAddTxData function: a shutdown sends the data that was held. */
+void test_prvTCPAddTxData_Corked_Shutdown( void )
+{
+    pxSocket = &xSocket;
+    StreamBuffer_t TxStream;
+    pxSocket->u.xTCP.txStream = &TxStream;
+    pxSocket->u.xTCP.xTCPWindow.usMSS = 1000;
+    pxSocket->u.xTCP.bits.bCork = pdTRUE_UNSIGNED;
+    pxSocket->u.xTCP.bits.bCloseRequested = pdFALSE_UNSIGNED;
+    pxSocket->u.xTCP.bits.bUserShutdown = pdTRUE_UNSIGNED;
+
+    uxStreamBufferMidSpace_ExpectAndReturn( pxSocket->u.xTCP.txStream, 300 );
+    lTCPWindowTxAdd_ExpectAndReturn( &( pxSocket->u.xTCP.xTCPWindow ), 300, 0, 0, 300 );
+    lTCPWindowTxAdd_IgnoreArg_lPosition();
+    lTCPWindowTxAdd_IgnoreArg_lMax();
+    vStreamBufferMoveMid_Expect( pxSocket->u.xTCP.txStream, 300 );
+
+    prvTCPAddTxData( pxSocket );
+
+    pxSocket->u.xTCP.bits.bCork = pdFALSE_UNSIGNED;
+    pxSocket->u.xTCP.bits.bUserShutdown = pdFALSE_UNSIGNED;
+}
+
 /*test prvSetOptions function */
 void test_prvSetOptions_Zero_Option_Syn_State_No_MSS_Change( void )
 {
@@ -0,0 +1,328 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_task.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_FreeRTOS_TCP_State_Handling.h"
+#include "mock_FreeRTOS_TCP_Reception.h"
+#include "mock_FreeRTOS_TCP_Utils.h"
+#include "mock_TCP_Transmission_TSO_list_macros.h"
+
+#include "FreeRTOS_TCP_IP.h"
+#include "FreeRTOS_TCP_WIN.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+#include "FreeRTOSIPConfigDefaults.h"
+
+#include "FreeRTOS_TCP_Transmission_TSO_stubs.c"
+#include "FreeRTOS_TCP_Transmission.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+uint32_t prvTCPCoalesceSegments( FreeRTOS_Socket_t * pxSocket,
+                                 uint32_t ulLength );
+
+#define TEST_SEQUENCE_NUMBER    ( 1000U )
+#define TEST_WINDOW_LENGTH      ( 8000U )
+
+static FreeRTOS_Socket_t xSocket;
+static NetworkEndPoint_t xEndPoint;
+static NetworkInterface_t xInterface;
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    FreeRTOS_min_int32_Stub( lStubMinInt32 );
+    FreeRTOS_min_uint32_Stub( ulStubMinUInt32 );
+    FreeRTOS_max_int32_Stub( lStubMaxInt32 );
+    FreeRTOS_max_uint32_Stub( ulStubMaxUInt32 );
+    xTaskGetTickCount_IgnoreAndReturn( 0U );
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    memset( &xEndPoint, 0, sizeof( xEndPoint ) );
+    memset( &xInterface, 0, sizeof( xInterface ) );
+
+    xEndPoint.pxNetworkInterface = &xInterface;
+    xInterface.bits.bTCPSegmentationOffload = pdTRUE_UNSIGNED;
+    xInterface.bits.bTxChecksumOffload = pdTRUE_UNSIGNED;
+    xSocket.pxEndPoint = &xEndPoint;
+    xSocket.u.xTCP.ulWindowSize = TEST_WINDOW_LENGTH;
+    xBufferAllocFixedSize = pdFALSE;
+    xNetworkInterfaceOutput_Called = 0;
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    vTCPWindowDestroy( &( xSocket.u.xTCP.xTCPWindow ) );
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief Create a window with segments of 'ulMSS' bytes, queue 'ulLength'
+ *        bytes and fetch the first segment, as prvTCPPrepareSend() does.
+ */
+static uint32_t prvQueueAndGetFirst( uint32_t ulMSS,
+                                     uint32_t ulLength )
+{
+    TCPWindow_t * pxWindow = &( xSocket.u.xTCP.xTCPWindow );
+    int32_t lPosition = 0;
+
+    xSocket.u.xTCP.usMSS = ( uint16_t ) ulMSS;
+    ( void ) xTCPWindowCreate( pxWindow, TEST_WINDOW_LENGTH, TEST_WINDOW_LENGTH, 0U, TEST_SEQUENCE_NUMBER, ulMSS );
+    TEST_ASSERT_EQUAL( ( int32_t ) ulLength, lTCPWindowTxAdd( pxWindow, ulLength, 0, ( int32_t ) TEST_WINDOW_LENGTH ) );
+
+    return ulTCPWindowTxGet( pxWindow, xSocket.u.xTCP.ulWindowSize, &lPosition );
+}
+
+/**
+ * @brief Following segments are added until ipconfigTCP_TSO_MAX_SIZE is reached.
+ */
+void test_prvTCPCoalesceSegments_SuperSegment( void )
+{
+    TCPWindow_t * pxWindow = &( xSocket.u.xTCP.xTCPWindow );
+    uint32_t ulLength = prvQueueAndGetFirst( 1000U, 5000U );
+
+    TEST_ASSERT_EQUAL( 1000U, ulLength );
+
+    ulLength = prvTCPCoalesceSegments( &xSocket, ulLength );
+
+    TEST_ASSERT_EQUAL( ipconfigTCP_TSO_MAX_SIZE, ulLength );
+    TEST_ASSERT_EQUAL( 3U, listCURRENT_LIST_LENGTH( &( pxWindow->xWaitQueue ) ) );
+    TEST_ASSERT_EQUAL( 2U, listCURRENT_LIST_LENGTH( &( pxWindow->xTxQueue ) ) );
+}
+
+/**
+ * @brief A segment that does not fit entirely is left for the next packet.
+ */
+void test_prvTCPCoalesceSegments_WholeSegmentsOnly( void )
+{
+    uint32_t ulLength = prvQueueAndGetFirst( 1400U, 5000U );
+
+    ulLength = prvTCPCoalesceSegments( &xSocket, ulLength );
+
+    /* A third segment of 1400 bytes would exceed 3000 bytes. */
+    TEST_ASSERT_EQUAL( 2800U, ulLength );
+}
+
+/**
+ * @brief The super-segment does not exceed the window of the peer.
+ */
+void test_prvTCPCoalesceSegments_PeerWindow( void )
+{
+    uint32_t ulLength;
+
+    xSocket.u.xTCP.ulWindowSize = 2000U;
+    ulLength = prvQueueAndGetFirst( 1000U, 5000U );
+
+    ulLength = prvTCPCoalesceSegments( &xSocket, ulLength );
+
+    TEST_ASSERT_EQUAL( 2000U, ulLength );
+}
+
+/**
+ * @brief When there is only a single segment, nothing is added.
+ */
+void test_prvTCPCoalesceSegments_SingleSegment( void )
+{
+    uint32_t ulLength = prvQueueAndGetFirst( 1000U, 600U );
+
+    TEST_ASSERT_EQUAL( 600U, prvTCPCoalesceSegments( &xSocket, ulLength ) );
+}
+
+/**
+ * @brief The acknowledgement of the super-segment covers all of its segments,
+ *        and the next packet starts where the super-segment ended.
+ */
+void test_prvTCPCoalesceSegments_SequenceAccounting( void )
+{
+    TCPWindow_t * pxWindow = &( xSocket.u.xTCP.xTCPWindow );
+    int32_t lPosition = 0;
+    uint32_t ulLength = prvQueueAndGetFirst( 1000U, 5000U );
+
+    ulLength = prvTCPCoalesceSegments( &xSocket, ulLength );
+
+    /* The header of the packet carries the sequence number of its first segment. */
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE_NUMBER, pxWindow->ulOurSequenceNumber );
+
+    TEST_ASSERT_EQUAL( ulLength, ulTCPWindowTxAck( pxWindow, TEST_SEQUENCE_NUMBER + ulLength ) );
+    TEST_ASSERT_EQUAL( 0U, listCURRENT_LIST_LENGTH( &( pxWindow->xWaitQueue ) ) );
+
+    TEST_ASSERT_EQUAL( 1000U, ulTCPWindowTxGet( pxWindow, xSocket.u.xTCP.ulWindowSize, &lPosition ) );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE_NUMBER + ulLength, pxWindow->ulOurSequenceNumber );
+    TEST_ASSERT_EQUAL( ( int32_t ) ulLength, lPosition );
+}
+
+/**
+ * @brief An interface without segmentation offload gets packets of one MSS.
+ */
+void test_prvTCPCoalesceSegments_NoDriverTSO( void )
+{
+    TCPWindow_t * pxWindow = &( xSocket.u.xTCP.xTCPWindow );
+    uint32_t ulLength;
+
+    xInterface.bits.bTCPSegmentationOffload = pdFALSE_UNSIGNED;
+    ulLength = prvQueueAndGetFirst( 1000U, 5000U );
+
+    TEST_ASSERT_EQUAL( 1000U, prvTCPCoalesceSegments( &xSocket, ulLength ) );
+    TEST_ASSERT_EQUAL( 1U, listCURRENT_LIST_LENGTH( &( pxWindow->xWaitQueue ) ) );
+    TEST_ASSERT_EQUAL( 4U, listCURRENT_LIST_LENGTH( &( pxWindow->xTxQueue ) ) );
+}
+
+/**
+ * @brief An interface that splits large packets, but does not insert the
+ *        checksums, gets packets of one MSS.
+ */
+void test_prvTCPCoalesceSegments_NoTxChecksumOffload( void )
+{
+    TCPWindow_t * pxWindow = &( xSocket.u.xTCP.xTCPWindow );
+    uint32_t ulLength;
+
+    xInterface.bits.bTxChecksumOffload = pdFALSE_UNSIGNED;
+    ulLength = prvQueueAndGetFirst( 1000U, 5000U );
+
+    TEST_ASSERT_EQUAL( 1000U, prvTCPCoalesceSegments( &xSocket, ulLength ) );
+    TEST_ASSERT_EQUAL( 1U, listCURRENT_LIST_LENGTH( &( pxWindow->xWaitQueue ) ) );
+    TEST_ASSERT_EQUAL( 4U, listCURRENT_LIST_LENGTH( &( pxWindow->xTxQueue ) ) );
+}
+
+/**
+ * @brief A socket without an end-point gets packets of one MSS.
+ */
+void test_prvTCPCoalesceSegments_NoEndPoint( void )
+{
+    uint32_t ulLength;
+
+    xSocket.pxEndPoint = NULL;
+    ulLength = prvQueueAndGetFirst( 1000U, 5000U );
+
+    TEST_ASSERT_EQUAL( 1000U, prvTCPCoalesceSegments( &xSocket, ulLength ) );
+}
+
+/**
+ * @brief Network buffers of a fixed size can not hold a super-segment.
+ */
+void test_prvTCPCoalesceSegments_FixedSizeBuffers( void )
+{
+    uint32_t ulLength;
+
+    xBufferAllocFixedSize = pdTRUE;
+    ulLength = prvQueueAndGetFirst( 1000U, 5000U );
+
+    TEST_ASSERT_EQUAL( 1000U, prvTCPCoalesceSegments( &xSocket, ulLength ) );
+}
+
+/**
+ * @brief A segment that does not follow directly on the data already obtained
+ *        is not added.
+ */
+void test_ulTCPWindowTxGetMore_NotContiguous( void )
+{
+    TCPWindow_t * pxWindow = &( xSocket.u.xTCP.xTCPWindow );
+    uint32_t ulLength = prvQueueAndGetFirst( 1000U, 5000U );
+
+    TEST_ASSERT_EQUAL( 0U, ulTCPWindowTxGetMore( pxWindow, xSocket.u.xTCP.ulWindowSize,
+                                                 TEST_SEQUENCE_NUMBER + ulLength + 1U, ipconfigTCP_TSO_MAX_SIZE ) );
+    TEST_ASSERT_EQUAL( 1U, listCURRENT_LIST_LENGTH( &( pxWindow->xWaitQueue ) ) );
+}
+
+/**
+ * @brief Send a packet of 'ulLen' bytes through prvTCPReturnPacket_IPV4() and
+ *        return the segment size that the driver is asked to use.
+ */
+static uint16_t prvReturnPacket( uint32_t ulLen )
+{
+    static uint8_t ucBuffer[ ipSIZE_OF_ETH_HEADER + ipconfigTCP_TSO_MAX_SIZE + 100U ];
+    NetworkBufferDescriptor_t xBuffer;
+
+    memset( &xBuffer, 0, sizeof( xBuffer ) );
+    memset( ucBuffer, 0, sizeof( ucBuffer ) );
+    xBuffer.pucEthernetBuffer = ucBuffer;
+    xBuffer.xDataLength = sizeof( ucBuffer );
+    xBuffer.pxEndPoint = &xEndPoint;
+    xBuffer.usTCPSegmentSize = 0xFFFFU;
+
+    xSocket.u.xTCP.usMSS = 1000U;
+    ( void ) xTCPWindowCreate( &( xSocket.u.xTCP.xTCPWindow ), TEST_WINDOW_LENGTH, TEST_WINDOW_LENGTH, 0U, TEST_SEQUENCE_NUMBER, 1000U );
+
+    xInterface.pfOutput = xNetworkInterfaceOutput_Stub;
+    eARPGetCacheEntry_IgnoreAndReturn( eARPCacheMiss );
+    xIPTxChecksumInSoftware_ExpectAndReturn( &xBuffer, pdFALSE );
+
+    prvTCPReturnPacket_IPV4( &xSocket, &xBuffer, ulLen, pdFALSE );
+
+    TEST_ASSERT_EQUAL( 1, xNetworkInterfaceOutput_Called );
+
+    return xBuffer.usTCPSegmentSize;
+}
+
+/**
+ * @brief A packet larger than the MTU tells the driver to split it in
+ *        segments of one MSS.
+ */
+void test_prvTCPReturnPacket_IPV4_SuperSegment( void )
+{
+    uint32_t ulLen = ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + ipconfigTCP_TSO_MAX_SIZE;
+
+    TEST_ASSERT_EQUAL( 1000U, prvReturnPacket( ulLen ) );
+}
+
+/**
+ * @brief A packet that fits in the MTU is sent as it is.
+ */
+void test_prvTCPReturnPacket_IPV4_NormalSegment( void )
+{
+    uint32_t ulLen = ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + 1000U;
+
+    TEST_ASSERT_EQUAL( 0U, prvReturnPacket( ulLen ) );
+}
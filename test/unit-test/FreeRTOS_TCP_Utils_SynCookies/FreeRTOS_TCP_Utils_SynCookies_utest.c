@@ -0,0 +1,327 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_TCP_IP.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_Utils_SynCookies_stubs.c"
+#include "FreeRTOS_TCP_Utils.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+extern BaseType_t xCookieKeySet;
+
+/** @brief The length of a time slot of a SYN cookie, as in FreeRTOS_TCP_Utils.c. */
+#define TEST_SLOT_TICKS        ( ( TickType_t ) 64U * ( TickType_t ) configTICK_RATE_HZ )
+
+/** @brief The initial sequence number of the peer. */
+#define TEST_PEER_ISN          0x12345678U
+
+/** @brief The offset of the TCP header in the test packets. */
+#define TEST_TCP_OFFSET        ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER )
+
+static uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU ];
+static NetworkBufferDescriptor_t xNetworkBuffer;
+static uint32_t ulRandomCount;
+
+/* ============================ Test Helpers ============================ */
+
+static BaseType_t xStubGetRandomNumber( uint32_t * pulNumber,
+                                        int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    ulRandomCount++;
+    *pulNumber = 0x9E3779B9U * ulRandomCount;
+
+    return pdTRUE;
+}
+
+/**
+ * @brief Fill the network buffer with a TCP packet from 192.168.0.8:1000
+ *        to 172.217.14.234:80.
+ *
+ * @param[in] ucFlags The TCP flags.
+ * @param[in] ulSequence The sequence number.
+ * @param[in] ulAck The acknowledgement number.
+ * @param[in] usMSS The MSS option, or zero to send no options.
+ */
+static void prvSetPacket( uint8_t ucFlags,
+                          uint32_t ulSequence,
+                          uint32_t ulAck,
+                          uint16_t usMSS )
+{
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] );
+    ProtocolHeaders_t * pxProtocolHeaders = ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_TCP_OFFSET ] );
+    uint8_t * pucOptions = &( ucEthernetBuffer[ TEST_TCP_OFFSET + ipSIZE_OF_TCP_HEADER ] );
+    size_t uxOptionsLength = 0U;
+
+    memset( ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+
+    pxIPHeader->ucVersionHeaderLength = 0x45U;
+    pxIPHeader->ucProtocol = ipPROTOCOL_TCP;
+    pxIPHeader->ulSourceIPAddress = FreeRTOS_htonl( 0xC0A80008U );
+    pxIPHeader->ulDestinationIPAddress = FreeRTOS_htonl( 0xACD90EEAU );
+
+    pxProtocolHeaders->xTCPHeader.usSourcePort = FreeRTOS_htons( 1000U );
+    pxProtocolHeaders->xTCPHeader.usDestinationPort = FreeRTOS_htons( 80U );
+    pxProtocolHeaders->xTCPHeader.ulSequenceNumber = FreeRTOS_htonl( ulSequence );
+    pxProtocolHeaders->xTCPHeader.ulAckNr = FreeRTOS_htonl( ulAck );
+    pxProtocolHeaders->xTCPHeader.ucTCPFlags = ucFlags;
+
+    if( usMSS != 0U )
+    {
+        pucOptions[ 0 ] = tcpTCP_OPT_NOOP;
+        pucOptions[ 1 ] = tcpTCP_OPT_NOOP;
+        pucOptions[ 2 ] = tcpTCP_OPT_MSS;
+        pucOptions[ 3 ] = tcpTCP_OPT_MSS_LEN;
+        pucOptions[ 4 ] = ( uint8_t ) ( usMSS >> 8 );
+        pucOptions[ 5 ] = ( uint8_t ) ( usMSS & 0xffU );
+        pucOptions[ 6 ] = tcpTCP_OPT_END;
+        pucOptions[ 7 ] = tcpTCP_OPT_END;
+        uxOptionsLength = 8U;
+    }
+
+    pxProtocolHeaders->xTCPHeader.ucTCPOffset = ( uint8_t ) ( ( ( ipSIZE_OF_TCP_HEADER + uxOptionsLength ) / 4U ) << 4 );
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+    xNetworkBuffer.xDataLength = TEST_TCP_OFFSET + ipSIZE_OF_TCP_HEADER + uxOptionsLength;
+}
+
+/**
+ * @brief Make a SYN cookie at the time xTime for a SYN with the given MSS.
+ */
+static uint32_t prvMakeCookie( TickType_t xTime,
+                               uint16_t usMSS )
+{
+    uint32_t ulCookie = 0U;
+
+    prvSetPacket( tcpTCP_FLAG_SYN, TEST_PEER_ISN, 0U, usMSS );
+    xTaskGetTickCount_ExpectAndReturn( xTime );
+    TEST_ASSERT_EQUAL( pdPASS, prvTCPSynCookieMake( &xNetworkBuffer, &ulCookie ) );
+
+    return ulCookie;
+}
+
+/**
+ * @brief Check the cookie of an ACK that arrives at the time xTime.
+ */
+static uint16_t prvCheckAck( TickType_t xTime,
+                             uint32_t ulSequence,
+                             uint32_t ulAck )
+{
+    prvSetPacket( tcpTCP_FLAG_ACK, ulSequence, ulAck, 0U );
+    xTaskGetTickCount_ExpectAndReturn( xTime );
+
+    return prvTCPSynCookieCheck( &xNetworkBuffer );
+}
+
+/* ============================== Test Cases ============================== */
+
+void setUp( void )
+{
+    xCookieKeySet = pdFALSE;
+    ulRandomCount = 0U;
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+
+    uxIPHeaderSizePacket_IgnoreAndReturn( ipSIZE_OF_IPv4_HEADER );
+    xApplicationGetRandomNumber_Stub( xStubGetRandomNumber );
+}
+
+/**
+ * @brief The cookie of a SYN is accepted in the ACK of the handshake, and
+ *        gives back the peer's MSS.
+ */
+void test_prvTCPSynCookieCheck_Valid( void )
+{
+    uint32_t ulCookie = prvMakeCookie( 1000U, 1460U );
+
+    TEST_ASSERT_EQUAL( 7U, ulCookie & 0x07U );
+    TEST_ASSERT_EQUAL( 1460U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ulCookie + 1U ) );
+}
+
+/**
+ * @brief The MSS is rounded down to the nearest value in the table.
+ */
+void test_prvTCPSynCookieCheck_RoundsMSSDown( void )
+{
+    uint32_t ulCookie = prvMakeCookie( 1000U, 1300U );
+
+    TEST_ASSERT_EQUAL( 1280U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ulCookie + 1U ) );
+
+    ulCookie = prvMakeCookie( 1000U, 9000U );
+    TEST_ASSERT_EQUAL( 1460U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ulCookie + 1U ) );
+}
+
+/**
+ * @brief A SYN without an MSS option gets the minimum segment length.
+ */
+void test_prvTCPSynCookieCheck_NoMSSOption( void )
+{
+    uint32_t ulCookie = prvMakeCookie( 1000U, 0U );
+
+    TEST_ASSERT_EQUAL( 0U, ulCookie & 0x07U );
+    TEST_ASSERT_EQUAL( 536U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ulCookie + 1U ) );
+}
+
+/**
+ * @brief A cookie made in the previous time slot is still accepted.
+ */
+void test_prvTCPSynCookieCheck_PreviousSlot( void )
+{
+    uint32_t ulCookie = prvMakeCookie( TEST_SLOT_TICKS - 1U, 1460U );
+
+    TEST_ASSERT_EQUAL( 1460U, prvCheckAck( ( 2U * TEST_SLOT_TICKS ) - 1U, TEST_PEER_ISN + 1U, ulCookie + 1U ) );
+}
+
+/**
+ * @brief A cookie that is two time slots old is refused.
+ */
+void test_prvTCPSynCookieCheck_Stale( void )
+{
+    uint32_t ulCookie = prvMakeCookie( TEST_SLOT_TICKS - 1U, 1460U );
+
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 2U * TEST_SLOT_TICKS, TEST_PEER_ISN + 1U, ulCookie + 1U ) );
+}
+
+/**
+ * @brief A cookie from 32 slots ago has the same slot bits as a new one,
+ *        but the hash covers the whole slot number.
+ */
+void test_prvTCPSynCookieCheck_SlotWrap( void )
+{
+    uint32_t ulCookie = prvMakeCookie( 1000U, 1460U );
+
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 1000U + ( 32U * TEST_SLOT_TICKS ), TEST_PEER_ISN + 1U, ulCookie + 1U ) );
+}
+
+/**
+ * @brief A cookie of which the slot is in the future is refused.
+ */
+void test_prvTCPSynCookieCheck_FutureSlot( void )
+{
+    uint32_t ulCookie = prvMakeCookie( TEST_SLOT_TICKS, 1460U );
+
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( TEST_SLOT_TICKS - 1U, TEST_PEER_ISN + 1U, ulCookie + 1U ) );
+}
+
+/**
+ * @brief A cookie with a changed hash bit is refused.
+ */
+void test_prvTCPSynCookieCheck_Forged( void )
+{
+    uint32_t ulCookie = prvMakeCookie( 1000U, 1460U );
+
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ( ulCookie ^ 0x00000100U ) + 1U ) );
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ( ulCookie ^ 0x80000000U ) + 1U ) );
+}
+
+/**
+ * @brief A cookie of which the MSS index was raised is refused.
+ */
+void test_prvTCPSynCookieCheck_ForgedMSS( void )
+{
+    uint32_t ulCookie = prvMakeCookie( 1000U, 0U );
+
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ( ulCookie | 0x07U ) + 1U ) );
+}
+
+/**
+ * @brief An ACK number that is one off from the cookie is refused.
+ */
+void test_prvTCPSynCookieCheck_AckOffByOne( void )
+{
+    uint32_t ulCookie = prvMakeCookie( 1000U, 1460U );
+
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ulCookie ) );
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ulCookie + 2U ) );
+}
+
+/**
+ * @brief An ACK with a sequence number that does not follow the ISN of the
+ *        SYN is refused.
+ */
+void test_prvTCPSynCookieCheck_WrongSequence( void )
+{
+    uint32_t ulCookie = prvMakeCookie( 1000U, 1460U );
+
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 1000U, TEST_PEER_ISN, ulCookie + 1U ) );
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 1000U, TEST_PEER_ISN + 2U, ulCookie + 1U ) );
+}
+
+/**
+ * @brief A cookie is only valid for the connection of the SYN.
+ */
+void test_prvTCPSynCookieCheck_OtherConnection( void )
+{
+    uint32_t ulCookie = prvMakeCookie( 1000U, 1460U );
+    ProtocolHeaders_t * pxProtocolHeaders = ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ TEST_TCP_OFFSET ] );
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] );
+
+    prvSetPacket( tcpTCP_FLAG_ACK, TEST_PEER_ISN + 1U, ulCookie + 1U, 0U );
+    pxProtocolHeaders->xTCPHeader.usSourcePort = FreeRTOS_htons( 1001U );
+    xTaskGetTickCount_ExpectAndReturn( 1000U );
+    TEST_ASSERT_EQUAL( 0U, prvTCPSynCookieCheck( &xNetworkBuffer ) );
+
+    prvSetPacket( tcpTCP_FLAG_ACK, TEST_PEER_ISN + 1U, ulCookie + 1U, 0U );
+    pxIPHeader->ulSourceIPAddress = FreeRTOS_htonl( 0xC0A80009U );
+    xTaskGetTickCount_ExpectAndReturn( 1000U );
+    TEST_ASSERT_EQUAL( 0U, prvTCPSynCookieCheck( &xNetworkBuffer ) );
+}
+
+/**
+ * @brief No cookie can be made or checked when no random key is available.
+ */
+void test_prvTCPSynCookieMake_NoRandomNumber( void )
+{
+    uint32_t ulCookie = 0U;
+
+    xApplicationGetRandomNumber_Stub( NULL );
+    xApplicationGetRandomNumber_IgnoreAndReturn( pdFALSE );
+
+    prvSetPacket( tcpTCP_FLAG_SYN, TEST_PEER_ISN, 0U, 1460U );
+    xTaskGetTickCount_ExpectAndReturn( 1000U );
+    TEST_ASSERT_EQUAL( pdFAIL, prvTCPSynCookieMake( &xNetworkBuffer, &ulCookie ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xCookieKeySet );
+
+    TEST_ASSERT_EQUAL( 0U, prvCheckAck( 1000U, TEST_PEER_ISN + 1U, ulCookie + 1U ) );
+}
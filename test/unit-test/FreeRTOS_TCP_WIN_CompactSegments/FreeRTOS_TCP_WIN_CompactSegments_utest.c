@@ -0,0 +1,359 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "mock_task.h"
+#include "mock_FreeRTOS_IP.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_WIN.h"
+
+#include "catch_assert.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+extern TCPSegment_t * xTCPSegments;
+extern TCPSegmentList_t xSegmentList;
+
+void prvListInitialise( TCPSegmentList_t * pxList,
+                        size_t uxItemOffset );
+TCPSegmentItem_t * prvListItem( TCPSegmentList_t * pxList,
+                                uint16_t usIndex );
+TCPSegmentItem_t * prvListNext( const TCPSegmentItem_t * pxItem );
+TCPSegmentItem_t * prvListPrevious( const TCPSegmentItem_t * pxItem );
+TCPSegment_t * prvListOwner( const TCPSegmentItem_t * pxItem );
+void prvListInsertFifo( TCPSegmentList_t * pxList,
+                        TCPSegmentItem_t * pxItem );
+UBaseType_t prvListRemove( TCPSegmentItem_t * pxItem );
+TCPSegment_t * xTCPWindowNew( TCPWindow_t * pxWindow,
+                              uint32_t ulSequenceNumber,
+                              int32_t lCount,
+                              BaseType_t xIsForRx );
+void vTCPWindowFree( TCPSegment_t * pxSegment );
+
+int32_t lStubMinInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMinUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+int32_t lStubMaxInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMaxUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+
+/* The index that links to the end marker of a list. */
+#define TEST_END_INDEX         ( ( uint16_t ) 0xFFFFU )
+
+#define TEST_MSS               ( 1000U )
+
+#define TEST_WINDOW_LENGTH     ( 8000U )
+
+#define TEST_SEQUENCE_NUMBER   ( 10000U )
+
+#define TEST_RX_SEQUENCE       ( 20000U )
+
+static TCPWindow_t xWindow;
+
+/* A list that is linked through the xQueueItem of the segments, like the
+ * queues of a window. */
+static TCPSegmentList_t xQueue;
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xWindow, 0, sizeof( xWindow ) );
+    memset( &xQueue, 0, sizeof( xQueue ) );
+
+    FreeRTOS_min_int32_Stub( lStubMinInt32 );
+    FreeRTOS_min_uint32_Stub( ulStubMinUInt32 );
+    FreeRTOS_max_int32_Stub( lStubMaxInt32 );
+    FreeRTOS_max_uint32_Stub( ulStubMaxUInt32 );
+    xTaskGetTickCount_IgnoreAndReturn( 1000U );
+
+    /* The first window allocates the pool, with all segments in index order. */
+    TEST_ASSERT_EQUAL( pdPASS, xTCPWindowCreate( &xWindow, TEST_WINDOW_LENGTH, TEST_WINDOW_LENGTH,
+                                                 TEST_RX_SEQUENCE, TEST_SEQUENCE_NUMBER, TEST_MSS ) );
+
+    prvListInitialise( &xQueue, offsetof( TCPSegment_t, xQueueItem ) );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    vTCPWindowDestroy( &xWindow );
+
+    /* Let the next test start with a new pool. */
+    vTCPSegmentCleanup();
+}
+
+/* ======================== Helper Functions ========================= */
+
+/**
+ * @brief Walk a list in both directions and check that it holds the segments
+ *        with the given indices, in that order.
+ */
+static void prvAssertList( TCPSegmentList_t * pxList,
+                           const uint16_t * pusIndices,
+                           UBaseType_t uxCount )
+{
+    const TCPSegmentItem_t * pxEnd = &( pxList->xListEnd );
+    const TCPSegmentItem_t * pxItem;
+    UBaseType_t uxIndex;
+
+    TEST_ASSERT_EQUAL( uxCount, pxList->uxNumberOfItems );
+    TEST_ASSERT_EQUAL_PTR( pxList, pxEnd->pxContainer );
+
+    pxItem = pxEnd;
+
+    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+    {
+        pxItem = prvListNext( pxItem );
+
+        TEST_ASSERT_EQUAL_PTR( &( xTCPSegments[ pusIndices[ uxIndex ] ] ), prvListOwner( pxItem ) );
+        TEST_ASSERT_EQUAL_PTR( prvListItem( pxList, pusIndices[ uxIndex ] ), pxItem );
+        TEST_ASSERT_EQUAL_PTR( pxList, pxItem->pxContainer );
+    }
+
+    /* The tail links to the end marker, which links to the head. */
+    TEST_ASSERT_EQUAL_PTR( pxEnd, prvListNext( pxItem ) );
+
+    for( uxIndex = uxCount; uxIndex > 0U; uxIndex-- )
+    {
+        TEST_ASSERT_EQUAL_PTR( prvListItem( pxList, pusIndices[ uxIndex - 1U ] ), pxItem );
+        pxItem = prvListPrevious( pxItem );
+    }
+
+    TEST_ASSERT_EQUAL_PTR( pxEnd, pxItem );
+}
+
+/**
+ * @brief Check that a list is empty: the end marker links to itself.
+ */
+static void prvAssertEmpty( TCPSegmentList_t * pxList )
+{
+    const TCPSegmentItem_t * pxEnd = &( pxList->xListEnd );
+
+    TEST_ASSERT_EQUAL( 0U, pxList->uxNumberOfItems );
+    TEST_ASSERT_EQUAL_UINT16( TEST_END_INDEX, pxEnd->usNext );
+    TEST_ASSERT_EQUAL_UINT16( TEST_END_INDEX, pxEnd->usPrevious );
+    TEST_ASSERT_EQUAL_PTR( pxEnd, prvListNext( pxEnd ) );
+    TEST_ASSERT_EQUAL_PTR( pxEnd, prvListPrevious( pxEnd ) );
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief A new pool holds all segments, linked in index order.
+ */
+void test_CompactSegments_PoolInIndexOrder( void )
+{
+    const uint16_t usExpected[] = { 0U, 1U, 2U, 3U, 4U, 5U };
+
+    TEST_ASSERT_EQUAL( 6, ipconfigTCP_WIN_SEG_COUNT );
+    TEST_ASSERT_EQUAL_UINT16( 0U, xSegmentList.xListEnd.usNext );
+    TEST_ASSERT_EQUAL_UINT16( ipconfigTCP_WIN_SEG_COUNT - 1, xSegmentList.xListEnd.usPrevious );
+    TEST_ASSERT_EQUAL_UINT16( TEST_END_INDEX, xTCPSegments[ 0 ].xSegmentItem.usPrevious );
+    TEST_ASSERT_EQUAL_UINT16( TEST_END_INDEX, xTCPSegments[ ipconfigTCP_WIN_SEG_COUNT - 1 ].xSegmentItem.usNext );
+    prvAssertList( &xSegmentList, usExpected, ipconfigTCP_WIN_SEG_COUNT );
+
+    /* The queue items are not linked yet. */
+    TEST_ASSERT_NULL( xTCPSegments[ 0 ].xQueueItem.pxContainer );
+}
+
+/**
+ * @brief An initialised list only holds the end marker, which links to itself.
+ */
+void test_CompactSegments_EmptyList( void )
+{
+    TEST_ASSERT_EQUAL_PTR( &xQueue, xQueue.xListEnd.pxContainer );
+    TEST_ASSERT_EQUAL( offsetof( TCPSegment_t, xQueueItem ), xQueue.uxItemOffset );
+    prvAssertEmpty( &xQueue );
+
+    /* The end index maps to the end marker of the list. */
+    TEST_ASSERT_EQUAL_PTR( &( xQueue.xListEnd ), prvListItem( &xQueue, TEST_END_INDEX ) );
+
+    prvAssertEmpty( &( xWindow.xTxSegments ) );
+    prvAssertEmpty( &( xWindow.xWaitQueue ) );
+}
+
+/**
+ * @brief Items are added to the tail of a list, in any index order.
+ */
+void test_CompactSegments_InsertFifo( void )
+{
+    const uint16_t usExpected[] = { 4U, 1U, 3U };
+
+    prvListInsertFifo( &xQueue, &( xTCPSegments[ 4 ].xQueueItem ) );
+
+    /* The first item is both the head and the tail. */
+    TEST_ASSERT_EQUAL_UINT16( 4U, xQueue.xListEnd.usNext );
+    TEST_ASSERT_EQUAL_UINT16( 4U, xQueue.xListEnd.usPrevious );
+    TEST_ASSERT_EQUAL_UINT16( TEST_END_INDEX, xTCPSegments[ 4 ].xQueueItem.usNext );
+    TEST_ASSERT_EQUAL_UINT16( TEST_END_INDEX, xTCPSegments[ 4 ].xQueueItem.usPrevious );
+
+    prvListInsertFifo( &xQueue, &( xTCPSegments[ 1 ].xQueueItem ) );
+    prvListInsertFifo( &xQueue, &( xTCPSegments[ 3 ].xQueueItem ) );
+
+    TEST_ASSERT_EQUAL_UINT16( 4U, xQueue.xListEnd.usNext );
+    TEST_ASSERT_EQUAL_UINT16( 3U, xQueue.xListEnd.usPrevious );
+    TEST_ASSERT_EQUAL_UINT16( 1U, xTCPSegments[ 4 ].xQueueItem.usNext );
+    TEST_ASSERT_EQUAL_UINT16( 4U, xTCPSegments[ 1 ].xQueueItem.usPrevious );
+    TEST_ASSERT_EQUAL_UINT16( 3U, xTCPSegments[ 1 ].xQueueItem.usNext );
+    TEST_ASSERT_EQUAL_UINT16( 1U, xTCPSegments[ 3 ].xQueueItem.usPrevious );
+    prvAssertList( &xQueue, usExpected, 3U );
+
+    /* Linking the queue items leaves the pool untouched. */
+    TEST_ASSERT_EQUAL( ipconfigTCP_WIN_SEG_COUNT, xSegmentList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL_PTR( &xSegmentList, xTCPSegments[ 1 ].xSegmentItem.pxContainer );
+}
+
+/**
+ * @brief Removing the head, a middle item or the tail relinks its neighbours.
+ */
+void test_CompactSegments_Remove( void )
+{
+    const uint16_t usAfterMiddle[] = { 0U, 1U, 3U, 4U };
+    const uint16_t usAfterHead[] = { 1U, 3U, 4U };
+    const uint16_t usAfterTail[] = { 1U, 3U };
+    uint16_t usIndex;
+
+    for( usIndex = 0U; usIndex < 5U; usIndex++ )
+    {
+        prvListInsertFifo( &xQueue, &( xTCPSegments[ usIndex ].xQueueItem ) );
+    }
+
+    TEST_ASSERT_EQUAL( 4U, prvListRemove( &( xTCPSegments[ 2 ].xQueueItem ) ) );
+    TEST_ASSERT_NULL( xTCPSegments[ 2 ].xQueueItem.pxContainer );
+    prvAssertList( &xQueue, usAfterMiddle, 4U );
+
+    TEST_ASSERT_EQUAL( 3U, prvListRemove( &( xTCPSegments[ 0 ].xQueueItem ) ) );
+    TEST_ASSERT_EQUAL_UINT16( 1U, xQueue.xListEnd.usNext );
+    TEST_ASSERT_EQUAL_UINT16( TEST_END_INDEX, xTCPSegments[ 1 ].xQueueItem.usPrevious );
+    prvAssertList( &xQueue, usAfterHead, 3U );
+
+    TEST_ASSERT_EQUAL( 2U, prvListRemove( &( xTCPSegments[ 4 ].xQueueItem ) ) );
+    TEST_ASSERT_EQUAL_UINT16( 3U, xQueue.xListEnd.usPrevious );
+    TEST_ASSERT_EQUAL_UINT16( TEST_END_INDEX, xTCPSegments[ 3 ].xQueueItem.usNext );
+    prvAssertList( &xQueue, usAfterTail, 2U );
+}
+
+/**
+ * @brief Removing the last item brings the end marker back to the empty state.
+ */
+void test_CompactSegments_RemoveLast( void )
+{
+    prvListInsertFifo( &xQueue, &( xTCPSegments[ 5 ].xQueueItem ) );
+
+    TEST_ASSERT_EQUAL( 0U, prvListRemove( &( xTCPSegments[ 5 ].xQueueItem ) ) );
+    TEST_ASSERT_NULL( xTCPSegments[ 5 ].xQueueItem.pxContainer );
+    prvAssertEmpty( &xQueue );
+
+    /* And the list can be used again. */
+    prvListInsertFifo( &xQueue, &( xTCPSegments[ 0 ].xQueueItem ) );
+    TEST_ASSERT_EQUAL_UINT16( 0U, xQueue.xListEnd.usNext );
+    TEST_ASSERT_EQUAL_UINT16( 0U, xQueue.xListEnd.usPrevious );
+    ( void ) prvListRemove( &( xTCPSegments[ 0 ].xQueueItem ) );
+}
+
+/**
+ * @brief Borrow every segment of the pool, so that it becomes empty, and
+ *        return some of them: the pool then links its segments out of
+ *        index order.
+ */
+void test_CompactSegments_PoolExhausted( void )
+{
+    const uint16_t usAllTaken[] = { 0U, 1U, 2U, 3U, 4U, 5U };
+    const uint16_t usPoolReturned[] = { 3U, 0U, 5U };
+    const uint16_t usTxLeft[] = { 1U, 2U, 4U };
+    const uint16_t usTxReused[] = { 1U, 2U, 4U, 3U };
+    const uint16_t usPoolLeft[] = { 0U, 5U };
+    UBaseType_t uxIndex;
+    TCPSegment_t * pxSegment;
+
+    for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigTCP_WIN_SEG_COUNT; uxIndex++ )
+    {
+        pxSegment = xTCPWindowNew( &xWindow, TEST_SEQUENCE_NUMBER + ( uxIndex * TEST_MSS ), TEST_MSS, pdFALSE );
+        TEST_ASSERT_EQUAL_PTR( &( xTCPSegments[ uxIndex ] ), pxSegment );
+    }
+
+    prvAssertEmpty( &xSegmentList );
+    prvAssertList( &( xWindow.xTxSegments ), usAllTaken, ipconfigTCP_WIN_SEG_COUNT );
+
+    /* The pool is empty. */
+    TEST_ASSERT_NULL( xTCPWindowNew( &xWindow, TEST_SEQUENCE_NUMBER, TEST_MSS, pdFALSE ) );
+
+    vTCPWindowFree( &( xTCPSegments[ 3 ] ) );
+    vTCPWindowFree( &( xTCPSegments[ 0 ] ) );
+    vTCPWindowFree( &( xTCPSegments[ 5 ] ) );
+
+    prvAssertList( &xSegmentList, usPoolReturned, 3U );
+    prvAssertList( &( xWindow.xTxSegments ), usTxLeft, 3U );
+
+    /* The segment that was returned first is borrowed first. */
+    pxSegment = xTCPWindowNew( &xWindow, TEST_SEQUENCE_NUMBER, TEST_MSS, pdFALSE );
+    TEST_ASSERT_EQUAL_PTR( &( xTCPSegments[ 3 ] ), pxSegment );
+    prvAssertList( &xSegmentList, usPoolLeft, 2U );
+    prvAssertList( &( xWindow.xTxSegments ), usTxReused, 4U );
+}
+
+/**
+ * @brief A segment that is freed is also taken out of the queue that holds it.
+ */
+void test_CompactSegments_FreeQueued( void )
+{
+    const uint16_t usQueue[] = { 1U };
+    TCPSegment_t * pxFirst;
+    TCPSegment_t * pxSecond;
+
+    pxFirst = xTCPWindowNew( &xWindow, TEST_SEQUENCE_NUMBER, TEST_MSS, pdFALSE );
+    pxSecond = xTCPWindowNew( &xWindow, TEST_SEQUENCE_NUMBER + TEST_MSS, TEST_MSS, pdFALSE );
+
+    prvListInsertFifo( &( xWindow.xWaitQueue ), &( pxFirst->xQueueItem ) );
+    prvListInsertFifo( &( xWindow.xWaitQueue ), &( pxSecond->xQueueItem ) );
+
+    vTCPWindowFree( pxFirst );
+
+    TEST_ASSERT_NULL( pxFirst->xQueueItem.pxContainer );
+    TEST_ASSERT_EQUAL_PTR( &xSegmentList, pxFirst->xSegmentItem.pxContainer );
+    TEST_ASSERT_EQUAL_UINT16( 0U, xSegmentList.xListEnd.usPrevious );
+    prvAssertList( &( xWindow.xWaitQueue ), usQueue, 1U );
+}
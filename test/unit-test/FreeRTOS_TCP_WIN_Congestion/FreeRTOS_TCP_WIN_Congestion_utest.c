@@ -0,0 +1,505 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_FreeRTOS_IP.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_WIN.h"
+
+#include "catch_assert.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/* The static functions of FreeRTOS_TCP_WIN.c that are tested here. */
+uint32_t prvCubeRoot( uint64_t ullValue );
+void prvTCPCongestionAck( TCPWindow_t * pxWindow,
+                          uint32_t ulAckedBytes );
+void prvTCPCongestionLoss( TCPWindow_t * pxWindow,
+                           BaseType_t xTimeout );
+
+int32_t lStubMinInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMinUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+int32_t lStubMaxInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMaxUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+
+#define TEST_MSS               ( 1000U )
+
+/* The largest congestion window, see tcpCONGESTION_WINDOW_MAX. */
+#define TEST_WINDOW_MAX        ( 0x40000000U )
+
+#define TEST_SEQUENCE_NUMBER   ( 10000U )
+
+static TCPWindow_t xWindow;
+static TickType_t xTickCount;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static TickType_t xStubGetTickCount( int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return xTickCount;
+}
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xWindow, 0, sizeof( xWindow ) );
+    xWindow.usMSS = ( uint16_t ) TEST_MSS;
+    xWindow.tx.ulCurrentSequenceNumber = TEST_SEQUENCE_NUMBER;
+    xWindow.tx.ulHighestSequenceNumber = TEST_SEQUENCE_NUMBER;
+    xTickCount = 1000U;
+
+    FreeRTOS_min_int32_Stub( lStubMinInt32 );
+    FreeRTOS_min_uint32_Stub( ulStubMinUInt32 );
+    FreeRTOS_max_int32_Stub( lStubMaxInt32 );
+    FreeRTOS_max_uint32_Stub( ulStubMaxUInt32 );
+    xTaskGetTickCount_Stub( xStubGetTickCount );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief Start a connection with the given algorithm, as vTCPWindowInit() does.
+ */
+static void prvStart( const TCPCongestionControl_t * pxControl )
+{
+    xWindow.xCongestion.pxControl = pxControl;
+    pxControl->fnInit( &xWindow );
+}
+
+/**
+ * @brief Let the window be in congestion avoidance, with 'ulWindow' bytes.
+ */
+static void prvAvoidance( uint32_t ulWindow )
+{
+    xWindow.xCongestion.ulWindow = ulWindow;
+    xWindow.xCongestion.ulSlowStartThreshold = ulWindow;
+}
+
+/**
+ * @brief vTCPWindowInit() selects NewReno when no algorithm was chosen, and
+ *        keeps an algorithm that was chosen with FREERTOS_SO_TCP_CONGESTION.
+ */
+void test_vTCPWindowInit_DefaultAlgorithm( void )
+{
+    vTCPWindowInit( &xWindow, 0U, TEST_SEQUENCE_NUMBER, TEST_MSS );
+
+    TEST_ASSERT_EQUAL_PTR( &xTCPCongestionNewReno, xWindow.xCongestion.pxControl );
+    TEST_ASSERT_EQUAL( 4U * TEST_MSS, xWindow.xCongestion.ulWindow );
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xCongestion.xInRecovery );
+
+    memset( &xWindow, 0, sizeof( xWindow ) );
+    xWindow.xCongestion.pxControl = &xTCPCongestionCubic;
+    xWindow.xCongestion.xInRecovery = pdTRUE;
+
+    vTCPWindowInit( &xWindow, 0U, TEST_SEQUENCE_NUMBER, TEST_MSS );
+
+    TEST_ASSERT_EQUAL_PTR( &xTCPCongestionCubic, xWindow.xCongestion.pxControl );
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xCongestion.xInRecovery );
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xCongestion.xEpochValid );
+}
+
+/**
+ * @brief The initial window of RFC 5681: min( 4 * MSS, max( 2 * MSS, 4380 ) ).
+ */
+void test_NewReno_InitialWindow( void )
+{
+    prvStart( &xTCPCongestionNewReno );
+    TEST_ASSERT_EQUAL( 4U * TEST_MSS, xWindow.xCongestion.ulWindow );
+    TEST_ASSERT_EQUAL( TEST_WINDOW_MAX, xWindow.xCongestion.ulSlowStartThreshold );
+
+    xWindow.usMSS = 1460U;
+    prvStart( &xTCPCongestionNewReno );
+    TEST_ASSERT_EQUAL( 4380U, xWindow.xCongestion.ulWindow );
+
+    xWindow.usMSS = 536U;
+    prvStart( &xTCPCongestionNewReno );
+    TEST_ASSERT_EQUAL( 4U * 536U, xWindow.xCongestion.ulWindow );
+
+    xWindow.usMSS = 3000U;
+    prvStart( &xTCPCongestionNewReno );
+    TEST_ASSERT_EQUAL( 2U * 3000U, xWindow.xCongestion.ulWindow );
+
+    /* The MSS is not known yet. */
+    xWindow.usMSS = 0U;
+    prvStart( &xTCPCongestionNewReno );
+    TEST_ASSERT_EQUAL( FreeRTOS_min_uint32( 4U * ipconfigTCP_MSS, FreeRTOS_max_uint32( 2U * ipconfigTCP_MSS, 4380U ) ), xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief During slow start, the window grows by the number of bytes acknowledged,
+ *        but by no more than one MSS per ACK.
+ */
+void test_NewReno_SlowStart( void )
+{
+    prvStart( &xTCPCongestionNewReno );
+
+    prvTCPCongestionAck( &xWindow, 500U );
+    TEST_ASSERT_EQUAL( 4U * TEST_MSS + 500U, xWindow.xCongestion.ulWindow );
+
+    prvTCPCongestionAck( &xWindow, 3U * TEST_MSS );
+    TEST_ASSERT_EQUAL( 5U * TEST_MSS + 500U, xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief During congestion avoidance, the window grows by one MSS per window
+ *        of acknowledged data.
+ */
+void test_NewReno_CongestionAvoidance( void )
+{
+    prvStart( &xTCPCongestionNewReno );
+    prvAvoidance( 10000U );
+
+    prvTCPCongestionAck( &xWindow, 9999U );
+    TEST_ASSERT_EQUAL( 10000U, xWindow.xCongestion.ulWindow );
+
+    prvTCPCongestionAck( &xWindow, 2U );
+    TEST_ASSERT_EQUAL( 10000U + TEST_MSS, xWindow.xCongestion.ulWindow );
+    TEST_ASSERT_EQUAL( 1U, xWindow.xCongestion.ulBytesAcked );
+}
+
+/**
+ * @brief A fast retransmission halves the flight size, a time-out restarts
+ *        with a window of one MSS. The threshold is at least 2 MSS.
+ */
+void test_NewReno_Loss( void )
+{
+    prvStart( &xTCPCongestionNewReno );
+    prvAvoidance( 20000U );
+    xWindow.tx.ulHighestSequenceNumber = TEST_SEQUENCE_NUMBER + 16000U;
+
+    xTCPCongestionNewReno.fnOnLoss( &xWindow, pdFALSE );
+    TEST_ASSERT_EQUAL( 8000U, xWindow.xCongestion.ulSlowStartThreshold );
+    TEST_ASSERT_EQUAL( 8000U, xWindow.xCongestion.ulWindow );
+
+    xTCPCongestionNewReno.fnOnLoss( &xWindow, pdTRUE );
+    TEST_ASSERT_EQUAL( 8000U, xWindow.xCongestion.ulSlowStartThreshold );
+    TEST_ASSERT_EQUAL( TEST_MSS, xWindow.xCongestion.ulWindow );
+
+    xWindow.tx.ulHighestSequenceNumber = TEST_SEQUENCE_NUMBER + 1000U;
+    xTCPCongestionNewReno.fnOnLoss( &xWindow, pdFALSE );
+    TEST_ASSERT_EQUAL( 2U * TEST_MSS, xWindow.xCongestion.ulSlowStartThreshold );
+
+    /* Nothing in flight: the sequence numbers have wrapped around. */
+    xWindow.tx.ulCurrentSequenceNumber = 0xFFFFFF00U;
+    xWindow.tx.ulHighestSequenceNumber = 0x00000100U;
+    xTCPCongestionNewReno.fnOnLoss( &xWindow, pdFALSE );
+    TEST_ASSERT_EQUAL( 2U * TEST_MSS, xWindow.xCongestion.ulSlowStartThreshold );
+
+    xWindow.tx.ulCurrentSequenceNumber = 0xFFFFF000U;
+    xWindow.tx.ulHighestSequenceNumber = 0x00002000U;
+    xTCPCongestionNewReno.fnOnLoss( &xWindow, pdFALSE );
+    TEST_ASSERT_EQUAL( 0x3000U / 2U, xWindow.xCongestion.ulSlowStartThreshold );
+}
+
+/**
+ * @brief Fast recovery: the window is reduced once for all segments that were
+ *        outstanding when the loss was detected. It does not grow until all
+ *        of them have been acknowledged.
+ */
+void test_NewReno_FastRecovery( void )
+{
+    prvStart( &xTCPCongestionNewReno );
+    prvAvoidance( 20000U );
+    xWindow.tx.ulHighestSequenceNumber = TEST_SEQUENCE_NUMBER + 20000U;
+
+    prvTCPCongestionLoss( &xWindow, pdFALSE );
+    TEST_ASSERT_EQUAL( pdTRUE, xWindow.xCongestion.xInRecovery );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE_NUMBER + 20000U, xWindow.xCongestion.ulRecoverSequenceNumber );
+    TEST_ASSERT_EQUAL( 10000U, xWindow.xCongestion.ulWindow );
+
+    /* More data is sent, another segment is lost in the same episode. */
+    xWindow.tx.ulHighestSequenceNumber = TEST_SEQUENCE_NUMBER + 24000U;
+    prvTCPCongestionLoss( &xWindow, pdFALSE );
+    TEST_ASSERT_EQUAL( 10000U, xWindow.xCongestion.ulWindow );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE_NUMBER + 20000U, xWindow.xCongestion.ulRecoverSequenceNumber );
+
+    /* A partial ACK does not end the recovery. */
+    xWindow.tx.ulCurrentSequenceNumber = TEST_SEQUENCE_NUMBER + 19999U;
+    prvTCPCongestionAck( &xWindow, 19999U );
+    TEST_ASSERT_EQUAL( pdTRUE, xWindow.xCongestion.xInRecovery );
+    TEST_ASSERT_EQUAL( 10000U, xWindow.xCongestion.ulWindow );
+
+    xWindow.tx.ulCurrentSequenceNumber = TEST_SEQUENCE_NUMBER + 20000U;
+    prvTCPCongestionAck( &xWindow, 1U );
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xCongestion.xInRecovery );
+    TEST_ASSERT_EQUAL( 10000U, xWindow.xCongestion.ulWindow );
+
+    /* Congestion avoidance again. */
+    prvTCPCongestionAck( &xWindow, 10000U );
+    TEST_ASSERT_EQUAL( 10000U + TEST_MSS, xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief A time-out during fast recovery reduces the window again.
+ */
+void test_NewReno_TimeoutDuringRecovery( void )
+{
+    prvStart( &xTCPCongestionNewReno );
+    prvAvoidance( 20000U );
+    xWindow.tx.ulHighestSequenceNumber = TEST_SEQUENCE_NUMBER + 20000U;
+
+    prvTCPCongestionLoss( &xWindow, pdFALSE );
+    prvTCPCongestionLoss( &xWindow, pdTRUE );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xCongestion.xInRecovery );
+    TEST_ASSERT_EQUAL( TEST_MSS, xWindow.xCongestion.ulWindow );
+
+    /* Slow start. */
+    prvTCPCongestionAck( &xWindow, TEST_MSS );
+    TEST_ASSERT_EQUAL( 2U * TEST_MSS, xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief The window never grows beyond tcpCONGESTION_WINDOW_MAX.
+ */
+void test_Congestion_WindowLimit( void )
+{
+    prvStart( &xTCPCongestionNewReno );
+    xWindow.xCongestion.ulWindow = TEST_WINDOW_MAX - 10U;
+
+    prvTCPCongestionAck( &xWindow, TEST_MSS );
+
+    TEST_ASSERT_EQUAL( TEST_WINDOW_MAX, xWindow.xCongestion.ulWindow );
+
+    prvStart( &xTCPCongestionCubic );
+    prvAvoidance( TEST_WINDOW_MAX );
+    xWindow.xCongestion.ulWindowMax = TEST_WINDOW_MAX;
+
+    prvTCPCongestionAck( &xWindow, 0xFFFFFFFFU );
+
+    TEST_ASSERT_EQUAL( TEST_WINDOW_MAX, xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief The integer cube root.
+ */
+void test_prvCubeRoot( void )
+{
+    TEST_ASSERT_EQUAL( 0U, prvCubeRoot( 0U ) );
+    TEST_ASSERT_EQUAL( 1U, prvCubeRoot( 7U ) );
+    TEST_ASSERT_EQUAL( 2U, prvCubeRoot( 8U ) );
+    TEST_ASSERT_EQUAL( 2U, prvCubeRoot( 26U ) );
+    TEST_ASSERT_EQUAL( 3U, prvCubeRoot( 27U ) );
+    TEST_ASSERT_EQUAL( 4217U, prvCubeRoot( 75000000000ULL ) );
+    TEST_ASSERT_EQUAL( 1000000U, prvCubeRoot( 1000000000000000000ULL ) );
+    TEST_ASSERT_EQUAL( 999999U, prvCubeRoot( 999999999999999999ULL ) );
+
+    /* The largest value that is used: K for the largest window and the
+     * smallest MSS. */
+    TEST_ASSERT_EQUAL( 2097151U, prvCubeRoot( 0x7FFFFFFFFFFFFFFFULL ) );
+}
+
+/**
+ * @brief CUBIC reduces the window by beta = 0.7, and remembers W_max. Fast
+ *        convergence lowers W_max when the window did not reach it again.
+ */
+void test_Cubic_Loss( void )
+{
+    prvStart( &xTCPCongestionCubic );
+    prvAvoidance( 100000U );
+
+    xTCPCongestionCubic.fnOnLoss( &xWindow, pdFALSE );
+    TEST_ASSERT_EQUAL( 100000U, xWindow.xCongestion.ulWindowMax );
+    TEST_ASSERT_EQUAL( ( 100000U * 717U ) / 1024U, xWindow.xCongestion.ulSlowStartThreshold );
+    TEST_ASSERT_EQUAL( ( 100000U * 717U ) / 1024U, xWindow.xCongestion.ulWindow );
+
+    xWindow.xCongestion.ulWindow = 50000U;
+    xTCPCongestionCubic.fnOnLoss( &xWindow, pdTRUE );
+    TEST_ASSERT_EQUAL( ( 50000U * 870U ) / 1024U, xWindow.xCongestion.ulWindowMax );
+    TEST_ASSERT_EQUAL( ( 50000U * 717U ) / 1024U, xWindow.xCongestion.ulSlowStartThreshold );
+    TEST_ASSERT_EQUAL( TEST_MSS, xWindow.xCongestion.ulWindow );
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xCongestion.xEpochValid );
+
+    /* The largest window does not overflow. */
+    xWindow.xCongestion.ulWindow = TEST_WINDOW_MAX;
+    xTCPCongestionCubic.fnOnLoss( &xWindow, pdFALSE );
+    TEST_ASSERT_EQUAL( TEST_WINDOW_MAX, xWindow.xCongestion.ulWindowMax );
+    TEST_ASSERT_EQUAL( ( uint32_t ) ( ( ( uint64_t ) TEST_WINDOW_MAX * 717U ) / 1024U ), xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief W(t) = C * ( t - K )^3 + W_max, with K = cubic_root( ( W_max - cwnd ) / C ):
+ *        the window approaches W_max slowly, and grows beyond it afterwards.
+ */
+void test_Cubic_Function( void )
+{
+    prvStart( &xTCPCongestionCubic );
+    prvAvoidance( 70000U );
+    xWindow.xCongestion.ulWindowMax = 100000U;
+
+    /* t = 0: the epoch starts. K = cubic_root( 30 MSS / 0.4 ) s = 4.217 s. */
+    prvTCPCongestionAck( &xWindow, TEST_MSS );
+    TEST_ASSERT_EQUAL( pdTRUE, xWindow.xCongestion.xEpochValid );
+    TEST_ASSERT_EQUAL( 4217U, xWindow.xCongestion.ulK );
+    TEST_ASSERT_EQUAL( 100000U, xWindow.xCongestion.ulOriginWindow );
+
+    /* W( 0 ) = 100000 - 29996 bytes, one MSS acknowledged adds 4 / 70000. */
+    TEST_ASSERT_EQUAL( 70000U, xWindow.xCongestion.ulWindow );
+
+    /* t = K: W( K ) = W_max, add 30000 / 70000 of the acknowledged bytes. */
+    xTickCount += 4217U;
+    prvTCPCongestionAck( &xWindow, TEST_MSS );
+    TEST_ASSERT_EQUAL( 70000U + 428U, xWindow.xCongestion.ulWindow );
+
+    /* t = K + 1 s: W = W_max + 0.4 MSS. */
+    xTickCount += 1000U;
+    xWindow.xCongestion.ulWindow = 100000U;
+    prvTCPCongestionAck( &xWindow, 100000U );
+    TEST_ASSERT_EQUAL( 100400U, xWindow.xCongestion.ulWindow );
+
+    /* The smoothed RTT is added: the target is one RTT ahead. */
+    xWindow.lSRTT = 1000;
+    xWindow.xCongestion.ulWindow = 100000U;
+    prvTCPCongestionAck( &xWindow, 100000U );
+    TEST_ASSERT_EQUAL( 100000U + 3200U, xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief The window does not grow by more than half of itself per RTT, also
+ *        not when t is very large.
+ */
+void test_Cubic_GrowthLimit( void )
+{
+    prvStart( &xTCPCongestionCubic );
+    prvAvoidance( 10000U );
+    xWindow.xCongestion.ulWindowMax = 10000U;
+
+    prvTCPCongestionAck( &xWindow, 1U );
+    TEST_ASSERT_EQUAL( 0U, xWindow.xCongestion.ulK );
+
+    /* Ten hours later. */
+    xTickCount += 36000000U;
+    prvTCPCongestionAck( &xWindow, 10000U );
+    TEST_ASSERT_EQUAL( 15000U, xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief t - K is limited to 60 seconds, so that its third power can not
+ *        overflow.
+ */
+void test_Cubic_TimeLimit( void )
+{
+    prvStart( &xTCPCongestionCubic );
+    prvAvoidance( 0x10000000U );
+    xWindow.xCongestion.ulWindowMax = 0x10000000U;
+
+    prvTCPCongestionAck( &xWindow, 1U );
+
+    /* One hour later, W = W_max + 0.4 * 60^3 MSS. */
+    xTickCount += 3600000U;
+    prvTCPCongestionAck( &xWindow, 0x10000000U );
+    TEST_ASSERT_EQUAL( 0x10000000U + 86400000U, xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief The largest W_max and the smallest MSS do not overflow K.
+ */
+void test_Cubic_K_Overflow( void )
+{
+    xWindow.usMSS = 536U;
+    prvStart( &xTCPCongestionCubic );
+    prvAvoidance( 2U * 536U );
+    xWindow.xCongestion.ulWindowMax = TEST_WINDOW_MAX;
+
+    prvTCPCongestionAck( &xWindow, 536U );
+
+    /* cubic_root( ( 0x40000000 - 1072 ) / ( 0.4 * 536 ) ) s. */
+    TEST_ASSERT_EQUAL( 171090U, xWindow.xCongestion.ulK );
+
+    /* K - t is limited, so that its third power fits.  W( t ) is still far
+     * above the window, the growth is limited to half of the window. */
+    TEST_ASSERT_EQUAL( 1072U + 268U, xWindow.xCongestion.ulWindow );
+
+    /* Likewise for t - K. */
+    xTickCount += 0x7FFFFFFFU;
+    prvTCPCongestionAck( &xWindow, 536U );
+    TEST_ASSERT_EQUAL( 1340U + 268U, xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief When the cubic function grows slower than Reno would, CUBIC follows
+ *        the Reno-friendly estimate: 9 / 17 MSS per window of acknowledged data.
+ */
+void test_Cubic_RenoFriendly( void )
+{
+    prvStart( &xTCPCongestionCubic );
+    prvAvoidance( 9000U );
+
+    /* No W_max: the origin is the current window, and K = 0. */
+    prvTCPCongestionAck( &xWindow, 1U );
+    TEST_ASSERT_EQUAL( 0U, xWindow.xCongestion.ulK );
+    TEST_ASSERT_EQUAL( 9000U, xWindow.xCongestion.ulOriginWindow );
+    TEST_ASSERT_EQUAL( 9000U, xWindow.xCongestion.ulWindow );
+
+    prvTCPCongestionAck( &xWindow, 16998U );
+    TEST_ASSERT_EQUAL( 9000U, xWindow.xCongestion.ulWindow );
+
+    prvTCPCongestionAck( &xWindow, 1U );
+    TEST_ASSERT_EQUAL( 9000U + TEST_MSS, xWindow.xCongestion.ulRenoWindow );
+    TEST_ASSERT_EQUAL( 9000U + TEST_MSS, xWindow.xCongestion.ulWindow );
+}
+
+/**
+ * @brief CUBIC uses slow start below the threshold.
+ */
+void test_Cubic_SlowStart( void )
+{
+    prvStart( &xTCPCongestionCubic );
+
+    prvTCPCongestionAck( &xWindow, TEST_MSS );
+
+    TEST_ASSERT_EQUAL( 5U * TEST_MSS, xWindow.xCongestion.ulWindow );
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xCongestion.xEpochValid );
+}
@@ -0,0 +1,364 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_FreeRTOS_IP.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_WIN.h"
+
+#include "catch_assert.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+int32_t lStubMinInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMinUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+int32_t lStubMaxInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMaxUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+
+#define TEST_MSS               ( 1000U )
+
+#define TEST_WINDOW_LENGTH     ( 8000U )
+
+#define TEST_SEQUENCE_NUMBER   ( 10000U )
+
+/* The smoothed RTT that vTCPWindowInit() starts with. */
+#define TEST_SRTT              ( 500U )
+
+static TCPWindow_t xWindow;
+static TickType_t xTickCount;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static TickType_t xStubGetTickCount( int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return xTickCount;
+}
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xWindow, 0, sizeof( xWindow ) );
+    xTickCount = 1000U;
+
+    FreeRTOS_min_int32_Stub( lStubMinInt32 );
+    FreeRTOS_min_uint32_Stub( ulStubMinUInt32 );
+    FreeRTOS_max_int32_Stub( lStubMaxInt32 );
+    FreeRTOS_max_uint32_Stub( ulStubMaxUInt32 );
+    xTaskGetTickCount_Stub( xStubGetTickCount );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPWindowCreate( &xWindow, TEST_WINDOW_LENGTH, TEST_WINDOW_LENGTH,
+                                                 0U, TEST_SEQUENCE_NUMBER, TEST_MSS ) );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    vTCPWindowDestroy( &xWindow );
+}
+
+/* ======================== Helper Functions ========================= */
+
+/**
+ * @brief Queue one segment of data and send it at the given time.
+ *
+ * @return The position of the segment in the TX stream.
+ */
+static int32_t prvSendSegment( TickType_t xTime )
+{
+    int32_t lPosition = -1;
+    int32_t lStreamPosition = ( int32_t ) ( xWindow.ulNextTxSequenceNumber - TEST_SEQUENCE_NUMBER );
+
+    TEST_ASSERT_EQUAL( TEST_MSS, lTCPWindowTxAdd( &xWindow, TEST_MSS, lStreamPosition, ( int32_t ) TEST_WINDOW_LENGTH ) );
+
+    xTickCount = xTime;
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+    TEST_ASSERT_EQUAL( lStreamPosition, lPosition );
+
+    return lPosition;
+}
+
+/**
+ * @brief The reordering window of RACK: a quarter of the current SRTT.
+ */
+static uint32_t prvReorderWindow( void )
+{
+    return ( uint32_t ) xWindow.lSRTT / 4U;
+}
+
+/**
+ * @brief The sequence number of the n-th segment.
+ */
+static uint32_t prvSequence( uint32_t ulIndex )
+{
+    return TEST_SEQUENCE_NUMBER + ( ulIndex * TEST_MSS );
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief A segment sent before a SACK'd segment is not lost within the
+ *        reordering window, and the delay to wait for it is returned.
+ */
+void test_Rack_ReorderWindow_NotLostYet( void )
+{
+    TickType_t xDelay = 0U;
+    int32_t lPosition = -1;
+
+    ( void ) prvSendSegment( 1000U );
+    ( void ) prvSendSegment( 1100U );
+
+    /* The second segment arrives after 100 ms, the first does not. */
+    xTickCount = 1200U;
+    ( void ) ulTCPWindowTxSack( &xWindow, prvSequence( 1U ), prvSequence( 2U ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xWindow.xRack.xValid );
+    TEST_ASSERT_EQUAL_UINT32( 100U, xWindow.xRack.ulRTT );
+    TEST_ASSERT_EQUAL_UINT32( prvSequence( 2U ), xWindow.xRack.ulEndSequence );
+
+    /* The first segment is lost when it is older than RACK.rtt + the
+     * reordering window. */
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPWindowTxHasData( &xWindow, TEST_WINDOW_LENGTH, &xDelay ) );
+    TEST_ASSERT_EQUAL( 1000U + 100U + prvReorderWindow() - 1200U, xDelay );
+
+    xTickCount = 1000U + 100U + prvReorderWindow() - 1U;
+    TEST_ASSERT_EQUAL( 0U, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+}
+
+/**
+ * @brief Once the reordering window has passed, the earlier segment is
+ *        retransmitted without waiting for the retransmission time-out.
+ */
+void test_Rack_ReorderWindow_Lost( void )
+{
+    int32_t lPosition = -1;
+
+    ( void ) prvSendSegment( 1000U );
+    ( void ) prvSendSegment( 1100U );
+
+    xTickCount = 1200U;
+    ( void ) ulTCPWindowTxSack( &xWindow, prvSequence( 1U ), prvSequence( 2U ) );
+
+    xTickCount = 1000U + 100U + prvReorderWindow();
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+    TEST_ASSERT_EQUAL( 0, lPosition );
+    TEST_ASSERT_EQUAL_UINT32( 0U, xWindow.ulRetransmitCount );
+}
+
+/**
+ * @brief A SACK that arrives late enough declares the earlier segment lost
+ *        at once.
+ */
+void test_Rack_Sack_DetectsLoss( void )
+{
+    int32_t lPosition = -1;
+
+    ( void ) prvSendSegment( 1000U );
+    ( void ) prvSendSegment( 1010U );
+
+    /* RACK.rtt becomes 10 ms. */
+    xTickCount = 1020U;
+    ( void ) ulTCPWindowTxSack( &xWindow, prvSequence( 1U ), prvSequence( 2U ) );
+    TEST_ASSERT_EQUAL( 0U, listCURRENT_LIST_LENGTH( &( xWindow.xPriorityQueue ) ) );
+
+    /* The same SACK again, when the first segment is older than RACK.rtt plus
+     * the reordering window. */
+    xTickCount = 1000U + 10U + prvReorderWindow() + 1U;
+    ( void ) ulTCPWindowTxSack( &xWindow, prvSequence( 1U ), prvSequence( 2U ) );
+    TEST_ASSERT_EQUAL( 1U, listCURRENT_LIST_LENGTH( &( xWindow.xPriorityQueue ) ) );
+
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+    TEST_ASSERT_EQUAL( 0, lPosition );
+}
+
+/**
+ * @brief Segments sent after the most recently delivered segment are never
+ *        declared lost by RACK, they wait for their own time-out.
+ */
+void test_Rack_SentLater_NotLost( void )
+{
+    TickType_t xDelay = 0U;
+    int32_t lPosition = -1;
+
+    ( void ) prvSendSegment( 1000U );
+    ( void ) prvSendSegment( 1100U );
+    ( void ) prvSendSegment( 1150U );
+
+    xTickCount = 1200U;
+    ( void ) ulTCPWindowTxSack( &xWindow, prvSequence( 1U ), prvSequence( 2U ) );
+
+    /* The first segment is lost, the third is not. */
+    xTickCount = 1300U;
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+    TEST_ASSERT_EQUAL( 0, lPosition );
+    TEST_ASSERT_EQUAL( 0U, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+
+    /* The third segment is only subject to the time-out of 2 * SRTT. */
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPWindowTxHasData( &xWindow, TEST_WINDOW_LENGTH, &xDelay ) );
+    TEST_ASSERT_NOT_EQUAL( 0U, xDelay );
+}
+
+/**
+ * @brief Two segments sent in the same tick: the one with the higher
+ *        sequence number counts as the most recently sent.
+ */
+void test_Rack_SameTime_HigherSequence( void )
+{
+    int32_t lPosition = -1;
+
+    ( void ) prvSendSegment( 1000U );
+    ( void ) prvSendSegment( 1000U );
+    ( void ) prvSendSegment( 1000U );
+
+    xTickCount = 1100U;
+    ( void ) ulTCPWindowTxSack( &xWindow, prvSequence( 2U ), prvSequence( 3U ) );
+    TEST_ASSERT_EQUAL_UINT32( prvSequence( 3U ), xWindow.xRack.ulEndSequence );
+
+    /* A SACK of the middle one, sent at the same time, does not replace it. */
+    ( void ) ulTCPWindowTxSack( &xWindow, prvSequence( 1U ), prvSequence( 2U ) );
+    TEST_ASSERT_EQUAL_UINT32( prvSequence( 3U ), xWindow.xRack.ulEndSequence );
+
+    /* The first one has the same age but a lower sequence number, it is lost
+     * after RACK.rtt + the reordering window. */
+    xTickCount = 1000U + 100U + prvReorderWindow();
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+    TEST_ASSERT_EQUAL( 0, lPosition );
+}
+
+/**
+ * @brief The ACK of a retransmitted segment is ambiguous, it does not update
+ *        RACK.
+ */
+void test_Rack_Retransmission_Ignored( void )
+{
+    int32_t lPosition = -1;
+
+    ( void ) prvSendSegment( 1000U );
+
+    /* The time-out sends the segment for a second time. */
+    xTickCount = 1000U + ( 2U * TEST_SRTT ) + 1U;
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+
+    xTickCount += 10U;
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxAck( &xWindow, prvSequence( 1U ) ) );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xRack.xValid );
+}
+
+/**
+ * @brief Instead of the first time-out, the most recently sent segment is
+ *        sent again as a tail loss probe.
+ */
+void test_Tlp_ProbeTailSegment( void )
+{
+    int32_t lPosition = -1;
+
+    ( void ) prvSendSegment( 1000U );
+    ( void ) prvSendSegment( 1000U );
+
+    /* Nothing before the time-out of 2 * SRTT. */
+    xTickCount = 1000U + ( 2U * TEST_SRTT );
+    TEST_ASSERT_EQUAL( 0U, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+
+    xTickCount++;
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+    TEST_ASSERT_EQUAL( ( int32_t ) TEST_MSS, lPosition );
+    TEST_ASSERT_EQUAL( pdTRUE, xWindow.xRack.xProbing );
+    TEST_ASSERT_EQUAL_UINT32( prvSequence( 2U ), xWindow.xRack.ulProbeSequence );
+    TEST_ASSERT_EQUAL_UINT32( 0U, xWindow.ulRetransmitCount );
+}
+
+/**
+ * @brief After a probe, the retransmission time-out restarts from the probe.
+ *        When it expires, the oldest segment is retransmitted.
+ */
+void test_Tlp_TimeoutAfterProbe( void )
+{
+    TickType_t xDelay = 0U;
+    TickType_t xProbeTime = 1000U + ( 2U * TEST_SRTT ) + 1U;
+    int32_t lPosition = -1;
+
+    ( void ) prvSendSegment( 1000U );
+    ( void ) prvSendSegment( 1000U );
+
+    xTickCount = xProbeTime;
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+
+    xTickCount = xProbeTime + 100U;
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPWindowTxHasData( &xWindow, TEST_WINDOW_LENGTH, &xDelay ) );
+    TEST_ASSERT_EQUAL( ( 2U * TEST_SRTT ) - 100U, xDelay );
+    TEST_ASSERT_EQUAL( 0U, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+
+    xTickCount = xProbeTime + ( 2U * TEST_SRTT );
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+    TEST_ASSERT_EQUAL( 0, lPosition );
+    TEST_ASSERT_EQUAL_UINT32( 1U, xWindow.ulRetransmitCount );
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xRack.xProbing );
+}
+
+/**
+ * @brief An ACK that covers all data sent before the probe ends the probe.
+ */
+void test_Tlp_AckEndsProbe( void )
+{
+    int32_t lPosition = -1;
+
+    ( void ) prvSendSegment( 1000U );
+    ( void ) prvSendSegment( 1000U );
+
+    xTickCount = 1000U + ( 2U * TEST_SRTT ) + 1U;
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+
+    /* A partial ACK leaves the probe pending. */
+    ( void ) ulTCPWindowTxAck( &xWindow, prvSequence( 1U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xWindow.xRack.xProbing );
+
+    ( void ) ulTCPWindowTxAck( &xWindow, prvSequence( 2U ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xWindow.xRack.xProbing );
+}
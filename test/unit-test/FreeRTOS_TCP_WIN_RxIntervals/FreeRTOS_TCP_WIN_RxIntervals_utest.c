@@ -0,0 +1,375 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_FreeRTOS_IP.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_WIN.h"
+
+#include "catch_assert.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+
+int32_t lStubMinInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMinUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+int32_t lStubMaxInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMaxUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+
+#define TEST_MSS               ( 1000U )
+
+#define TEST_WINDOW_LENGTH     ( 8000U )
+
+#define TEST_SEQUENCE_NUMBER   ( 10000U )
+
+/* The first sequence number expected from the peer. */
+#define TEST_RX_SEQUENCE       ( 20000U )
+
+/* NOP, NOP, SACK, length 10: the option code of a single SACK block. */
+#define TEST_SACK_OPTION       ( 0x0101050aU )
+
+static TCPWindow_t xWindow;
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xWindow, 0, sizeof( xWindow ) );
+
+    FreeRTOS_min_int32_Stub( lStubMinInt32 );
+    FreeRTOS_min_uint32_Stub( ulStubMinUInt32 );
+    FreeRTOS_max_int32_Stub( lStubMaxInt32 );
+    FreeRTOS_max_uint32_Stub( ulStubMaxUInt32 );
+    xTaskGetTickCount_IgnoreAndReturn( 1000U );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPWindowCreate( &xWindow, TEST_WINDOW_LENGTH, TEST_WINDOW_LENGTH,
+                                                 TEST_RX_SEQUENCE, TEST_SEQUENCE_NUMBER, TEST_MSS ) );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    vTCPWindowDestroy( &xWindow );
+}
+
+/* ======================== Helper Functions ========================= */
+
+/**
+ * @brief Pass received data to the window, at an offset from the first
+ *        sequence number expected.
+ */
+static int32_t prvReceive( uint32_t ulOffset,
+                           uint32_t ulLength )
+{
+    uint32_t ulSkipCount = 0xFFFFFFFFU;
+    int32_t lReturn;
+
+    lReturn = lTCPWindowRxCheck( &xWindow, xWindow.rx.ulFirstSequenceNumber + ulOffset,
+                                 ulLength, TEST_WINDOW_LENGTH, &ulSkipCount );
+    TEST_ASSERT_EQUAL_UINT32( 0U, ulSkipCount );
+
+    return lReturn;
+}
+
+/**
+ * @brief Check one interval of stored data, as offsets from the first
+ *        sequence number expected.
+ */
+static void prvAssertInterval( UBaseType_t uxIndex,
+                               uint32_t ulFirst,
+                               uint32_t ulLast )
+{
+    TEST_ASSERT_EQUAL_UINT32( xWindow.rx.ulFirstSequenceNumber + ulFirst, xWindow.xRxIntervals[ uxIndex ].ulFirst );
+    TEST_ASSERT_EQUAL_UINT32( xWindow.rx.ulFirstSequenceNumber + ulLast, xWindow.xRxIntervals[ uxIndex ].ulLast );
+}
+
+/**
+ * @brief Check the SACK option that will be sent to the peer.
+ */
+static void prvAssertSack( uint32_t ulFirst,
+                           uint32_t ulLast )
+{
+    TEST_ASSERT_EQUAL( 12U, xWindow.ucOptionLength );
+    TEST_ASSERT_EQUAL_UINT32( FreeRTOS_htonl( TEST_SACK_OPTION ), xWindow.ulOptionsData[ 0 ] );
+    TEST_ASSERT_EQUAL_UINT32( FreeRTOS_htonl( xWindow.rx.ulFirstSequenceNumber + ulFirst ), xWindow.ulOptionsData[ 1 ] );
+    TEST_ASSERT_EQUAL_UINT32( FreeRTOS_htonl( xWindow.rx.ulFirstSequenceNumber + ulLast ), xWindow.ulOptionsData[ 2 ] );
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief Data that arrives in order is passed on without storing an interval.
+ */
+void test_RxIntervals_InOrder( void )
+{
+    TEST_ASSERT_EQUAL( 0, prvReceive( 0U, TEST_MSS ) );
+
+    TEST_ASSERT_EQUAL_UINT32( TEST_RX_SEQUENCE + TEST_MSS, xWindow.rx.ulCurrentSequenceNumber );
+    TEST_ASSERT_EQUAL_UINT32( 0U, xWindow.ulUserDataLength );
+    TEST_ASSERT_EQUAL( 0U, xWindow.ucOptionLength );
+    TEST_ASSERT_EQUAL( 0U, xWindow.uxRxIntervalCount );
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPWindowRxEmpty( &xWindow ) );
+}
+
+/**
+ * @brief Data beyond a hole is stored as a new interval and reported in
+ *        a SACK.
+ */
+void test_RxIntervals_OutOfOrder_Insert( void )
+{
+    TEST_ASSERT_EQUAL( 2000, prvReceive( 2000U, TEST_MSS ) );
+
+    TEST_ASSERT_EQUAL_UINT32( TEST_RX_SEQUENCE, xWindow.rx.ulCurrentSequenceNumber );
+    TEST_ASSERT_EQUAL( 1U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 2000U, 3000U );
+    prvAssertSack( 2000U, 3000U );
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPWindowRxEmpty( &xWindow ) );
+}
+
+/**
+ * @brief New intervals are kept sorted, also when inserted in front of
+ *        existing ones.
+ */
+void test_RxIntervals_SortedInsert( void )
+{
+    TEST_ASSERT_EQUAL( 4000, prvReceive( 4000U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL( 2000, prvReceive( 2000U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL( 6000, prvReceive( 6000U, TEST_MSS ) );
+
+    TEST_ASSERT_EQUAL( 3U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 2000U, 3000U );
+    prvAssertInterval( 1U, 4000U, 5000U );
+    prvAssertInterval( 2U, 6000U, 7000U );
+    prvAssertSack( 6000U, 7000U );
+}
+
+/**
+ * @brief Data that has been stored already is refused, but the SACK of the
+ *        interval that holds it is sent again.
+ */
+void test_RxIntervals_Duplicate( void )
+{
+    ( void ) prvReceive( 2000U, TEST_MSS );
+    ( void ) prvReceive( 4000U, TEST_MSS );
+    ( void ) prvReceive( 6000U, TEST_MSS );
+
+    TEST_ASSERT_EQUAL( -1, prvReceive( 4500U, 500U ) );
+
+    TEST_ASSERT_EQUAL( 3U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 1U, 4000U, 5000U );
+    prvAssertSack( 4000U, 5000U );
+}
+
+/**
+ * @brief Data that touches or overlaps the edges of an interval extends it.
+ */
+void test_RxIntervals_Extend( void )
+{
+    ( void ) prvReceive( 2000U, TEST_MSS );
+
+    /* Touching the end. */
+    TEST_ASSERT_EQUAL( 3000, prvReceive( 3000U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL( 1U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 2000U, 4000U );
+    prvAssertSack( 2000U, 4000U );
+
+    /* Overlapping the start. */
+    TEST_ASSERT_EQUAL( 1500, prvReceive( 1500U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL( 1U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 1500U, 4000U );
+    prvAssertSack( 1500U, 4000U );
+}
+
+/**
+ * @brief Data that fills the hole between two intervals merges them.
+ */
+void test_RxIntervals_FillHole( void )
+{
+    ( void ) prvReceive( 2000U, TEST_MSS );
+    ( void ) prvReceive( 4000U, TEST_MSS );
+    ( void ) prvReceive( 6000U, TEST_MSS );
+
+    TEST_ASSERT_EQUAL( 3000, prvReceive( 3000U, TEST_MSS ) );
+
+    TEST_ASSERT_EQUAL( 2U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 2000U, 5000U );
+    prvAssertInterval( 1U, 6000U, 7000U );
+    prvAssertSack( 2000U, 5000U );
+}
+
+/**
+ * @brief Data that spans several holes merges all intervals it covers.
+ */
+void test_RxIntervals_FillSeveralHoles( void )
+{
+    ( void ) prvReceive( 2000U, TEST_MSS );
+    ( void ) prvReceive( 4000U, TEST_MSS );
+    ( void ) prvReceive( 6000U, TEST_MSS );
+
+    TEST_ASSERT_EQUAL( 1500, prvReceive( 1500U, 5000U ) );
+
+    TEST_ASSERT_EQUAL( 1U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 1500U, 7000U );
+    prvAssertSack( 1500U, 7000U );
+}
+
+/**
+ * @brief When all intervals are in use, a new hole is refused without
+ *        a SACK, while data that extends an interval is still accepted.
+ */
+void test_RxIntervals_Full( void )
+{
+    ( void ) prvReceive( 2000U, TEST_MSS );
+    ( void ) prvReceive( 4000U, TEST_MSS );
+    ( void ) prvReceive( 6000U, 500U );
+
+    TEST_ASSERT_EQUAL( -1, prvReceive( 7000U, 500U ) );
+    TEST_ASSERT_EQUAL( 0U, xWindow.ucOptionLength );
+    TEST_ASSERT_EQUAL( 3U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 2U, 6000U, 6500U );
+
+    TEST_ASSERT_EQUAL( 3000, prvReceive( 3000U, 500U ) );
+    TEST_ASSERT_EQUAL( 3U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 2000U, 3500U );
+    prvAssertSack( 2000U, 3500U );
+}
+
+/**
+ * @brief Expected data releases the intervals that have become contiguous,
+ *        and reports how many stored bytes follow it.
+ */
+void test_RxIntervals_ExpectedReleasesIntervals( void )
+{
+    ( void ) prvReceive( 1000U, TEST_MSS );
+    ( void ) prvReceive( 3000U, TEST_MSS );
+
+    TEST_ASSERT_EQUAL( 0, prvReceive( 0U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL_UINT32( TEST_MSS, xWindow.ulUserDataLength );
+    TEST_ASSERT_EQUAL_UINT32( TEST_RX_SEQUENCE + 2000U, xWindow.rx.ulCurrentSequenceNumber );
+    TEST_ASSERT_EQUAL( 0U, xWindow.ucOptionLength );
+    TEST_ASSERT_EQUAL( 1U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 3000U, 4000U );
+
+    TEST_ASSERT_EQUAL( 0, prvReceive( 2000U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL_UINT32( TEST_MSS, xWindow.ulUserDataLength );
+    TEST_ASSERT_EQUAL_UINT32( TEST_RX_SEQUENCE + 4000U, xWindow.rx.ulCurrentSequenceNumber );
+    TEST_ASSERT_EQUAL( 0U, xWindow.uxRxIntervalCount );
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPWindowRxEmpty( &xWindow ) );
+}
+
+/**
+ * @brief Expected data that overlaps the start of an interval only reports
+ *        the part of the interval that follows it.
+ */
+void test_RxIntervals_ExpectedOverlapsInterval( void )
+{
+    ( void ) prvReceive( 500U, TEST_MSS );
+
+    TEST_ASSERT_EQUAL( 0, prvReceive( 0U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL_UINT32( 500U, xWindow.ulUserDataLength );
+    TEST_ASSERT_EQUAL_UINT32( TEST_RX_SEQUENCE + 1500U, xWindow.rx.ulCurrentSequenceNumber );
+    TEST_ASSERT_EQUAL( 0U, xWindow.uxRxIntervalCount );
+}
+
+/**
+ * @brief An interval that lies completely within the expected data is
+ *        released without adding to the stored bytes.
+ */
+void test_RxIntervals_ExpectedCoversInterval( void )
+{
+    ( void ) prvReceive( 200U, 300U );
+
+    TEST_ASSERT_EQUAL( 0, prvReceive( 0U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, xWindow.ulUserDataLength );
+    TEST_ASSERT_EQUAL_UINT32( TEST_RX_SEQUENCE + TEST_MSS, xWindow.rx.ulCurrentSequenceNumber );
+    TEST_ASSERT_EQUAL( 0U, xWindow.uxRxIntervalCount );
+}
+
+/**
+ * @brief Expected data that leaves a hole before the next interval keeps
+ *        that interval stored.
+ */
+void test_RxIntervals_ExpectedKeepsLaterInterval( void )
+{
+    ( void ) prvReceive( 2000U, TEST_MSS );
+
+    TEST_ASSERT_EQUAL( 0, prvReceive( 0U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, xWindow.ulUserDataLength );
+    TEST_ASSERT_EQUAL_UINT32( TEST_RX_SEQUENCE + TEST_MSS, xWindow.rx.ulCurrentSequenceNumber );
+    TEST_ASSERT_EQUAL( 1U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 2000U, 3000U );
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPWindowRxEmpty( &xWindow ) );
+}
+
+/**
+ * @brief Intervals are ordered correctly when the sequence numbers wrap
+ *        around zero.
+ */
+void test_RxIntervals_SequenceWrap( void )
+{
+    vTCPWindowDestroy( &xWindow );
+    memset( &xWindow, 0, sizeof( xWindow ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTCPWindowCreate( &xWindow, TEST_WINDOW_LENGTH, TEST_WINDOW_LENGTH,
+                                                 0xFFFFFC00U, TEST_SEQUENCE_NUMBER, TEST_MSS ) );
+
+    /* The first interval lies after the wrap, the second one straddles it. */
+    TEST_ASSERT_EQUAL( 2000, prvReceive( 2000U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL( 1000, prvReceive( 1000U, 500U ) );
+
+    TEST_ASSERT_EQUAL( 2U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 1000U, 1500U );
+    prvAssertInterval( 1U, 2000U, 3000U );
+
+    TEST_ASSERT_EQUAL( -1, prvReceive( 2200U, 100U ) );
+    prvAssertSack( 2000U, 3000U );
+
+    TEST_ASSERT_EQUAL( 0, prvReceive( 0U, TEST_MSS ) );
+    TEST_ASSERT_EQUAL_UINT32( 500U, xWindow.ulUserDataLength );
+    TEST_ASSERT_EQUAL_UINT32( 0xFFFFFC00U + 1500U, xWindow.rx.ulCurrentSequenceNumber );
+    TEST_ASSERT_EQUAL( 1U, xWindow.uxRxIntervalCount );
+    prvAssertInterval( 0U, 2000U, 3000U );
+}
@@ -0,0 +1,233 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_FreeRTOS_IP.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_WIN.h"
+
+#include "catch_assert.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/* The static function of FreeRTOS_TCP_WIN.c that is tested here. */
+void prvTCPWindowTxCheckAck_CalcSRTT( TCPWindow_t * pxWindow,
+                                      const TCPSegment_t * pxSegment );
+
+int32_t lStubMinInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMinUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+int32_t lStubMaxInt32( int32_t a,
+                       int32_t b,
+                       int cmock_num_calls );
+uint32_t ulStubMaxUInt32( uint32_t a,
+                          uint32_t b,
+                          int cmock_num_calls );
+
+#define TEST_MSS               ( 1000U )
+
+#define TEST_WINDOW_LENGTH     ( 8000U )
+
+#define TEST_SEQUENCE_NUMBER   ( 10000U )
+
+/* The smoothed RTT that vTCPWindowInit() starts with. */
+#define TEST_INITIAL_SRTT      ( 500 )
+
+static TCPWindow_t xWindow;
+static TCPSegment_t xSegment;
+static TickType_t xTickCount;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static TickType_t xStubGetTickCount( int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return xTickCount;
+}
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    memset( &xWindow, 0, sizeof( xWindow ) );
+    memset( &xSegment, 0, sizeof( xSegment ) );
+    xWindow.lSRTT = TEST_INITIAL_SRTT;
+    xTickCount = 1000U;
+
+    FreeRTOS_min_int32_Stub( lStubMinInt32 );
+    FreeRTOS_min_uint32_Stub( ulStubMinUInt32 );
+    FreeRTOS_max_int32_Stub( lStubMaxInt32 );
+    FreeRTOS_max_uint32_Stub( ulStubMaxUInt32 );
+    xTaskGetTickCount_Stub( xStubGetTickCount );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief The TSval clock runs in milliseconds and wraps like the tick count.
+ */
+void test_ulTCPWindowTimeStamp( void )
+{
+    xTickCount = 1234U;
+    TEST_ASSERT_EQUAL_UINT32( 1234U * portTICK_PERIOD_MS, ulTCPWindowTimeStamp() );
+
+    xTickCount = ( TickType_t ) 0xFFFFFFFFU;
+    TEST_ASSERT_EQUAL_UINT32( ( uint32_t ) ( 0xFFFFFFFFU * portTICK_PERIOD_MS ), ulTCPWindowTimeStamp() );
+}
+
+/**
+ * @brief An echoed time-stamp gives the RTT, not the age of the segment,
+ *        which may have been retransmitted since.
+ */
+void test_CalcSRTT_EchoedTimeStamp( void )
+{
+    xTickCount = 2000U;
+    xSegment.xTransmitTimer.uxBorn = 1100U;
+    xWindow.ulTimeStampEcho = 1700U;
+    xWindow.u.bits.bTimeStampEcho = pdTRUE_UNSIGNED;
+
+    prvTCPWindowTxCheckAck_CalcSRTT( &xWindow, &xSegment );
+
+    /* A sample of 300 ms, the RTT becomes smaller: ( 300 + 7 * 500 ) / 8. */
+    TEST_ASSERT_EQUAL_INT32( 475, xWindow.lSRTT );
+}
+
+/**
+ * @brief Zero is a valid TSecr: the peer echoes a clock that just wrapped.
+ *        It must not be mistaken for "no time-stamp echoed".
+ */
+void test_CalcSRTT_EchoedZero( void )
+{
+    xTickCount = 120U;
+    xSegment.xTransmitTimer.uxBorn = ( TickType_t ) 0xFFFFF000U;
+    xWindow.ulTimeStampEcho = 0U;
+    xWindow.u.bits.bTimeStampEcho = pdTRUE_UNSIGNED;
+
+    prvTCPWindowTxCheckAck_CalcSRTT( &xWindow, &xSegment );
+
+    /* A sample of 120 ms: ( 120 + 7 * 500 ) / 8. */
+    TEST_ASSERT_EQUAL_INT32( 452, xWindow.lSRTT );
+}
+
+/**
+ * @brief Without an echoed time-stamp, the age of the segment is used, even
+ *        when a stale TSecr is still stored.
+ */
+void test_CalcSRTT_NoEcho( void )
+{
+    xTickCount = 2000U;
+    xSegment.xTransmitTimer.uxBorn = 1100U;
+    xWindow.ulTimeStampEcho = 1700U;
+    xWindow.u.bits.bTimeStampEcho = pdFALSE_UNSIGNED;
+
+    prvTCPWindowTxCheckAck_CalcSRTT( &xWindow, &xSegment );
+
+    /* A sample of 900 ms, the RTT becomes larger: ( 2 * 900 + 6 * 500 ) / 8. */
+    TEST_ASSERT_EQUAL_INT32( 600, xWindow.lSRTT );
+}
+
+/**
+ * @brief Send a segment, and retransmit it after its time-out, at the moment
+ *        the clock wraps to zero.
+ */
+static void prvSendAndRetransmit( void )
+{
+    int32_t lPosition = 0;
+
+    TEST_ASSERT_EQUAL( pdPASS, xTCPWindowCreate( &xWindow, TEST_WINDOW_LENGTH, TEST_WINDOW_LENGTH,
+                                                 0U, TEST_SEQUENCE_NUMBER, TEST_MSS ) );
+    TEST_ASSERT_EQUAL( TEST_MSS, lTCPWindowTxAdd( &xWindow, TEST_MSS, 0, ( int32_t ) TEST_WINDOW_LENGTH ) );
+
+    xTickCount = ( TickType_t ) 0xFFFFF000U;
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+
+    xTickCount = 0U;
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_WINDOW_LENGTH, &lPosition ) );
+}
+
+/**
+ * @brief The ACK of a retransmitted segment gives an RTT sample when it
+ *        echoes the time-stamp of the retransmission, also when that is zero.
+ */
+void test_ulTCPWindowTxAck_RetransmissionEchoedZero( void )
+{
+    int32_t lSRTT;
+
+    prvSendAndRetransmit();
+    lSRTT = xWindow.lSRTT;
+
+    xTickCount = 120U;
+    xWindow.ulTimeStampEcho = 0U;
+    xWindow.u.bits.bTimeStampEcho = pdTRUE_UNSIGNED;
+
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxAck( &xWindow, TEST_SEQUENCE_NUMBER + TEST_MSS ) );
+    TEST_ASSERT_EQUAL_INT32( ( 120 + ( 7 * lSRTT ) ) / 8, xWindow.lSRTT );
+
+    vTCPWindowDestroy( &xWindow );
+}
+
+/**
+ * @brief Without an echoed time-stamp, the ACK of a retransmitted segment is
+ *        ambiguous and does not change the RTT.
+ */
+void test_ulTCPWindowTxAck_RetransmissionNoEcho( void )
+{
+    int32_t lSRTT;
+
+    prvSendAndRetransmit();
+    lSRTT = xWindow.lSRTT;
+
+    xTickCount = 120U;
+    xWindow.ulTimeStampEcho = 0U;
+    xWindow.u.bits.bTimeStampEcho = pdFALSE_UNSIGNED;
+
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxAck( &xWindow, TEST_SEQUENCE_NUMBER + TEST_MSS ) );
+    TEST_ASSERT_EQUAL_INT32( lSRTT, xWindow.lSRTT );
+
+    vTCPWindowDestroy( &xWindow );
+}
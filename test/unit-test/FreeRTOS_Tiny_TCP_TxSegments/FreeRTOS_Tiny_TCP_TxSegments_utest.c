@@ -0,0 +1,395 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSConfig.h"
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_WIN.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_task.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/** @brief The MSS of the test connection. */
+#define TEST_MSS             ( 100 )
+
+/** @brief The sequence number of the first byte to send. */
+#define TEST_SEQUENCE        ( 1000U )
+
+/** @brief The smoothed RTT of the test connection, in ms. */
+#define TEST_SRTT            ( 100 )
+
+/** @brief The size of the TX stream. */
+#define TEST_STREAM_SIZE     ( 1000 )
+
+/** @brief A time at which no segment timed out: an outstanding segment that
+ *         was sent once is re-sent after 2 * TEST_SRTT. */
+#define TEST_TICK_NOW        ( 10U )
+
+/** @brief A time at which every segment sent at tick 0 timed out. */
+#define TEST_TICK_EXPIRED    ( 500U )
+
+static TCPWindow_t xWindow;
+
+/* ======================== Stub Callback Functions ======================= */
+
+static uint32_t ulStubMinUInt32( uint32_t a,
+                                 uint32_t b,
+                                 int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return ( a < b ) ? a : b;
+}
+
+/* ============================ Unity Fixtures ============================ */
+
+/**
+ * @brief calls at the beginning of each test case
+ */
+void setUp( void )
+{
+    UBaseType_t uxIndex;
+
+    ( void ) memset( &xWindow, 0, sizeof( xWindow ) );
+
+    for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigTCP_TINY_TX_SEGMENT_COUNT; uxIndex++ )
+    {
+        xWindow.xTxSegments[ uxIndex ].lMaxLength = TEST_MSS;
+    }
+
+    xWindow.lSRTT = TEST_SRTT;
+    xWindow.ulNextTxSequenceNumber = TEST_SEQUENCE;
+    xWindow.tx.ulFirstSequenceNumber = TEST_SEQUENCE;
+    xWindow.tx.ulCurrentSequenceNumber = TEST_SEQUENCE;
+
+    FreeRTOS_min_uint32_Stub( ulStubMinUInt32 );
+}
+
+/**
+ * @brief calls at the end of each test case
+ */
+void tearDown( void )
+{
+}
+
+/* ============================= Test Helpers ============================= */
+
+/**
+ * @brief Add data that uses every TX segment, one full MSS each.
+ */
+static void prvFillAllSegments( void )
+{
+    UBaseType_t uxIndex;
+
+    for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigTCP_TINY_TX_SEGMENT_COUNT; uxIndex++ )
+    {
+        /* ->vTCPTimerSet */
+        xTaskGetTickCount_ExpectAndReturn( 0U );
+    }
+
+    TEST_ASSERT_EQUAL( ipconfigTCP_TINY_TX_SEGMENT_COUNT * TEST_MSS,
+                       lTCPWindowTxAdd( &xWindow, ipconfigTCP_TINY_TX_SEGMENT_COUNT * TEST_MSS, 0, TEST_STREAM_SIZE ) );
+}
+
+/**
+ * @brief Send every TX segment once, at tick 0.
+ */
+static void prvSendAllSegments( void )
+{
+    UBaseType_t uxIndex;
+    UBaseType_t uxOutstanding;
+    int32_t lPosition = -1;
+
+    for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigTCP_TINY_TX_SEGMENT_COUNT; uxIndex++ )
+    {
+        for( uxOutstanding = 0U; uxOutstanding < uxIndex; uxOutstanding++ )
+        {
+            /* ->ulTimerGetAge of the segments in flight. */
+            xTaskGetTickCount_ExpectAndReturn( 0U );
+        }
+
+        /* ->vTCPTimerSet */
+        xTaskGetTickCount_ExpectAndReturn( 0U );
+
+        TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, TEST_STREAM_SIZE, &lPosition ) );
+        TEST_ASSERT_EQUAL( ( int32_t ) uxIndex * TEST_MSS, lPosition );
+    }
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief test_lTCPWindowTxAdd_DividesOverSegments
+ * New data is divided over the free segments, one MSS each, and the stream
+ * position wraps at the end of the TX stream.
+ */
+void test_lTCPWindowTxAdd_DividesOverSegments( void )
+{
+    int32_t lResult;
+
+    xTaskGetTickCount_ExpectAndReturn( 0U );
+    xTaskGetTickCount_ExpectAndReturn( 0U );
+    xTaskGetTickCount_ExpectAndReturn( 0U );
+
+    lResult = lTCPWindowTxAdd( &xWindow, 250U, 180, 200 );
+
+    TEST_ASSERT_EQUAL( 250, lResult );
+    TEST_ASSERT_EQUAL( 3U, xWindow.uxTxSegmentCount );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE + 250U, xWindow.ulNextTxSequenceNumber );
+
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE, xWindow.xTxSegments[ 0 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL( 100, xWindow.xTxSegments[ 0 ].lDataLength );
+    TEST_ASSERT_EQUAL( 180, xWindow.xTxSegments[ 0 ].lStreamPos );
+
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE + 100U, xWindow.xTxSegments[ 1 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL( 100, xWindow.xTxSegments[ 1 ].lDataLength );
+    TEST_ASSERT_EQUAL( 80, xWindow.xTxSegments[ 1 ].lStreamPos );
+
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE + 200U, xWindow.xTxSegments[ 2 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL( 50, xWindow.xTxSegments[ 2 ].lDataLength );
+    TEST_ASSERT_EQUAL( 180, xWindow.xTxSegments[ 2 ].lStreamPos );
+}
+
+/**
+ * @brief test_lTCPWindowTxAdd_PoolExhausted
+ * All segments are in use: no data is added, and the window is not changed.
+ */
+void test_lTCPWindowTxAdd_PoolExhausted( void )
+{
+    int32_t lResult;
+
+    prvFillAllSegments();
+
+    /* No timer is set, xTaskGetTickCount() is not expected. */
+    lResult = lTCPWindowTxAdd( &xWindow, TEST_MSS, 0, TEST_STREAM_SIZE );
+
+    TEST_ASSERT_EQUAL( 0, lResult );
+    TEST_ASSERT_EQUAL( ipconfigTCP_TINY_TX_SEGMENT_COUNT, xWindow.uxTxSegmentCount );
+    TEST_ASSERT_EQUAL( 0U, xWindow.uxTxSegmentFirst );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE + ( ipconfigTCP_TINY_TX_SEGMENT_COUNT * TEST_MSS ), xWindow.ulNextTxSequenceNumber );
+}
+
+/**
+ * @brief test_lTCPWindowTxAdd_PoolExhaustedHalfway
+ * The data needs more segments than are free: only the part that fits in the
+ * free segments is added.
+ */
+void test_lTCPWindowTxAdd_PoolExhaustedHalfway( void )
+{
+    int32_t lResult;
+
+    xTaskGetTickCount_ExpectAndReturn( 0U );
+    xTaskGetTickCount_ExpectAndReturn( 0U );
+    TEST_ASSERT_EQUAL( 2 * TEST_MSS, lTCPWindowTxAdd( &xWindow, 2 * TEST_MSS, 0, TEST_STREAM_SIZE ) );
+
+    xTaskGetTickCount_ExpectAndReturn( 0U );
+    lResult = lTCPWindowTxAdd( &xWindow, 250U, 2 * TEST_MSS, TEST_STREAM_SIZE );
+
+    TEST_ASSERT_EQUAL( TEST_MSS, lResult );
+    TEST_ASSERT_EQUAL( ipconfigTCP_TINY_TX_SEGMENT_COUNT, xWindow.uxTxSegmentCount );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE + ( 3U * TEST_MSS ), xWindow.ulNextTxSequenceNumber );
+}
+
+/**
+ * @brief test_lTCPWindowTxAdd_MSSUnknown
+ * Without an MSS, no data is added.
+ */
+void test_lTCPWindowTxAdd_MSSUnknown( void )
+{
+    int32_t lResult;
+
+    xWindow.xTxSegments[ 0 ].lMaxLength = 0;
+
+    lResult = lTCPWindowTxAdd( &xWindow, TEST_MSS, 0, TEST_STREAM_SIZE );
+
+    TEST_ASSERT_EQUAL( 0, lResult );
+    TEST_ASSERT_EQUAL( 0U, xWindow.uxTxSegmentCount );
+}
+
+/**
+ * @brief test_ulTCPWindowTxAck_FreesSegmentsForNewData
+ * An ACK releases the segments that it covers completely, after which new
+ * data is stored in the released segments, wrapping around the array.
+ */
+void test_ulTCPWindowTxAck_FreesSegmentsForNewData( void )
+{
+    uint32_t ulAcked;
+    int32_t lResult;
+
+    prvFillAllSegments();
+
+    /* The second segment is acknowledged halfway. */
+    ulAcked = ulTCPWindowTxAck( &xWindow, TEST_SEQUENCE + 150U );
+
+    TEST_ASSERT_EQUAL( TEST_MSS, ulAcked );
+    TEST_ASSERT_EQUAL( 2U, xWindow.uxTxSegmentCount );
+    TEST_ASSERT_EQUAL( 1U, xWindow.uxTxSegmentFirst );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE + 100U, xWindow.tx.ulCurrentSequenceNumber );
+
+    ulAcked = ulTCPWindowTxAck( &xWindow, TEST_SEQUENCE + 200U );
+
+    TEST_ASSERT_EQUAL( TEST_MSS, ulAcked );
+    TEST_ASSERT_EQUAL( 1U, xWindow.uxTxSegmentCount );
+    TEST_ASSERT_EQUAL( 2U, xWindow.uxTxSegmentFirst );
+
+    xTaskGetTickCount_ExpectAndReturn( 0U );
+    xTaskGetTickCount_ExpectAndReturn( 0U );
+    lResult = lTCPWindowTxAdd( &xWindow, 3U * TEST_MSS, 3 * TEST_MSS, TEST_STREAM_SIZE );
+
+    TEST_ASSERT_EQUAL( 2 * TEST_MSS, lResult );
+    TEST_ASSERT_EQUAL( ipconfigTCP_TINY_TX_SEGMENT_COUNT, xWindow.uxTxSegmentCount );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE + 300U, xWindow.xTxSegments[ 0 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE + 400U, xWindow.xTxSegments[ 1 ].ulSequenceNumber );
+
+    ulAcked = ulTCPWindowTxAck( &xWindow, TEST_SEQUENCE + 500U );
+
+    TEST_ASSERT_EQUAL( 3 * TEST_MSS, ulAcked );
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPWindowTxDone( &xWindow ) );
+    TEST_ASSERT_EQUAL( 2U, xWindow.uxTxSegmentFirst );
+}
+
+/**
+ * @brief test_ulTCPWindowTxGet_PoolExhausted
+ * Every segment is in flight and none timed out: there is nothing to send.
+ */
+void test_ulTCPWindowTxGet_PoolExhausted( void )
+{
+    uint32_t ulLength;
+    int32_t lPosition = -1;
+
+    prvFillAllSegments();
+    prvSendAllSegments();
+
+    /* ->ulTimerGetAge of each segment. */
+    xTaskGetTickCount_ExpectAndReturn( TEST_TICK_NOW );
+    xTaskGetTickCount_ExpectAndReturn( TEST_TICK_NOW );
+    xTaskGetTickCount_ExpectAndReturn( TEST_TICK_NOW );
+
+    ulLength = ulTCPWindowTxGet( &xWindow, TEST_STREAM_SIZE, &lPosition );
+
+    TEST_ASSERT_EQUAL( 0U, ulLength );
+    TEST_ASSERT_EQUAL( -1, lPosition );
+}
+
+/**
+ * @brief test_ulTCPWindowTxGet_PeerWindowFull
+ * A segment that does not fit in the peer's window next to the data in flight
+ * is not sent.
+ */
+void test_ulTCPWindowTxGet_PeerWindowFull( void )
+{
+    uint32_t ulLength;
+    int32_t lPosition = -1;
+
+    prvFillAllSegments();
+
+    /* The first segment is always sent. */
+    xTaskGetTickCount_ExpectAndReturn( 0U );
+    TEST_ASSERT_EQUAL( TEST_MSS, ulTCPWindowTxGet( &xWindow, 150U, &lPosition ) );
+
+    /* ->ulTimerGetAge of the first segment. */
+    xTaskGetTickCount_ExpectAndReturn( TEST_TICK_NOW );
+    lPosition = -1;
+
+    ulLength = ulTCPWindowTxGet( &xWindow, 150U, &lPosition );
+
+    TEST_ASSERT_EQUAL( 0U, ulLength );
+    TEST_ASSERT_EQUAL( -1, lPosition );
+    TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, xWindow.xTxSegments[ 1 ].u.bits.bOutstanding );
+}
+
+/**
+ * @brief test_ulTCPWindowTxGet_Retransmit
+ * With every segment in flight, the first segment whose timer expired is sent
+ * again.
+ */
+void test_ulTCPWindowTxGet_Retransmit( void )
+{
+    uint32_t ulLength;
+    int32_t lPosition = -1;
+
+    prvFillAllSegments();
+    prvSendAllSegments();
+
+    /* The first segment was re-sent later. */
+    xWindow.xTxSegments[ 0 ].xTransmitTimer.uxBorn = TEST_TICK_EXPIRED;
+
+    xTaskGetTickCount_ExpectAndReturn( TEST_TICK_EXPIRED );
+    xTaskGetTickCount_ExpectAndReturn( TEST_TICK_EXPIRED );
+    /* ->vTCPTimerSet */
+    xTaskGetTickCount_ExpectAndReturn( TEST_TICK_EXPIRED );
+
+    ulLength = ulTCPWindowTxGet( &xWindow, TEST_STREAM_SIZE, &lPosition );
+
+    TEST_ASSERT_EQUAL( TEST_MSS, ulLength );
+    TEST_ASSERT_EQUAL( TEST_MSS, lPosition );
+    TEST_ASSERT_EQUAL( TEST_SEQUENCE + 100U, xWindow.ulOurSequenceNumber );
+    TEST_ASSERT_EQUAL( 2U, xWindow.xTxSegments[ 1 ].u.bits.ucTransmitCount );
+    TEST_ASSERT_EQUAL( TEST_TICK_EXPIRED, xWindow.xTxSegments[ 1 ].xTransmitTimer.uxBorn );
+}
+
+/**
+ * @brief test_xTCPWindowTxHasData_PoolExhausted
+ * Every segment is in flight: wake up at the earliest retransmission.
+ */
+void test_xTCPWindowTxHasData_PoolExhausted( void )
+{
+    BaseType_t xResult;
+    TickType_t uxDelay = 0U;
+
+    prvFillAllSegments();
+    prvSendAllSegments();
+
+    xWindow.xTxSegments[ 0 ].xTransmitTimer.uxBorn = 150U;
+    xWindow.xTxSegments[ 1 ].xTransmitTimer.uxBorn = 0U;
+    xWindow.xTxSegments[ 2 ].xTransmitTimer.uxBorn = 100U;
+
+    /* ->ulTimerGetAge of each segment. */
+    xTaskGetTickCount_ExpectAndReturn( 160U );
+    xTaskGetTickCount_ExpectAndReturn( 160U );
+    xTaskGetTickCount_ExpectAndReturn( 160U );
+
+    xResult = xTCPWindowTxHasData( &xWindow, TEST_STREAM_SIZE, &uxDelay );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xResult );
+    TEST_ASSERT_EQUAL( 40U, uxDelay );
+}
@@ -836,6 +836,71 @@ void test_xProcessReceivedUDPPacket_IPv4_UDPListBufferFull()
     TEST_ASSERT_EQUAL( pdFAIL, xReturn );
 }
 
+/**
+ * @brief To validate the flow that list of the socket is full, and the oldest
+ *        packet is dropped to make room for the new one.
+ */
+void test_xProcessReceivedUDPPacket_IPv4_UDPListBufferFullDropOldest()
+{
+    BaseType_t xReturn;
+    uint16_t usSrcPort = 2048U;
+    uint16_t usDestPort = 1024U;
+    uint16_t usDestPortNetworkEndian = FreeRTOS_htons( usDestPort );
+    BaseType_t xIsWaitingForARPResolution;
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    NetworkBufferDescriptor_t xOldestBuffer;
+    NetworkEndPoint_t xEndPoint;
+    uint8_t pucEthernetBuffer[ ipconfigTCP_MSS ];
+    UDPPacket_t * pxUDPPacket;
+    FreeRTOS_Socket_t xSocket;
+
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( &xOldestBuffer, 0, sizeof( xOldestBuffer ) );
+    memset( pucEthernetBuffer, 0, sizeof( pucEthernetBuffer ) );
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    memset( &xEndPoint, 0, sizeof( xEndPoint ) );
+
+    xNetworkBuffer.pucEthernetBuffer = pucEthernetBuffer;
+    xNetworkBuffer.pxEndPoint = &xEndPoint;
+    xNetworkBuffer.usPort = FreeRTOS_htons( usSrcPort );
+    xNetworkBuffer.xDataLength = ipconfigTCP_MSS;
+
+    xEndPoint.ipv4_settings.ulIPAddress = ulDefaultIPv4Address;
+
+    pxUDPPacket = ( UDPPacket_t * ) pucEthernetBuffer;
+    pxUDPPacket->xIPHeader.usLength = xNetworkBuffer.xDataLength - ipSIZE_OF_ETH_HEADER;
+
+    pxUDPPacket->xUDPHeader.usChecksum = 0x1234U;
+    pxUDPPacket->xUDPHeader.usSourcePort = FreeRTOS_htons( usSrcPort );
+    pxUDPPacket->xUDPHeader.usDestinationPort = usDestPortNetworkEndian;
+
+    xSocket.u.xUDP.pxHandleReceive = NULL;
+    xSocket.xEventGroup = NULL;
+    xSocket.u.xUDP.xDropOldest = pdTRUE;
+
+    pxUDPSocketLookup_ExpectAndReturn( usDestPortNetworkEndian, &xSocket );
+    xCheckRequiresARPResolution_ExpectAndReturn( &xNetworkBuffer, pdFALSE );
+    vARPRefreshCacheEntryAge_Ignore();
+
+    /* One packet is waiting, which is the maximum. */
+    xSocket.u.xUDP.uxMaxPackets = 1U;
+    xSocket.u.xUDP.xWaitingPacketsList.uxNumberOfItems = 1U;
+    xSocket.u.xUDP.xWaitingPacketsList.xListEnd.pxNext = &( xOldestBuffer.xBufferListItem );
+    xOldestBuffer.xBufferListItem.pvOwner = &( xOldestBuffer );
+
+    vTaskSuspendAll_Ignore();
+    uxListRemove_ExpectAndReturn( &( xOldestBuffer.xBufferListItem ), 0U );
+    xTaskResumeAll_IgnoreAndReturn( pdPASS );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xOldestBuffer );
+    vListInsertEnd_Expect( &( xSocket.u.xUDP.xWaitingPacketsList ), &( xNetworkBuffer.xBufferListItem ) );
+
+    xIsDHCPSocket_ExpectAndReturn( &xSocket, pdFALSE );
+
+    xReturn = xProcessReceivedUDPPacket_IPv4( &xNetworkBuffer, usDestPortNetworkEndian, &xIsWaitingForARPResolution );
+
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+}
+
 /**
  * @brief To validate the flow that all flows (list/event group/select/queue/DHCP) are all pass.
  */
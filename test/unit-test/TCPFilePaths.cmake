@@ -6,6 +6,7 @@
 set( TCP_SOURCES
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_ARP.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_BitConfig.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_Bond.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_DHCP.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_DHCPv6.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_DNS.c"
@@ -14,7 +15,9 @@ set( TCP_SOURCES
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_DNS_Networking.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_DNS_Parser.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_ICMP.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IGMP.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IP.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IP_Fragment.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IP_Timers.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IP_Utils.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IPv4.c"
@@ -23,7 +26,10 @@ set( TCP_SOURCES
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IPv6.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IPv6_Sockets.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IPv6_Utils.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_NAPT.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_ND.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_NetEm.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_PacketFilter.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_RA.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_Routing.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_Sockets.c"
@@ -45,7 +51,8 @@ set( TCP_SOURCES
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_Tiny_TCP.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_UDP_IP.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_UDP_IPv4.c"
-     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_UDP_IPv6.c" )
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_UDP_IPv6.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_VLAN.c" )
 
 # TCP library Include directories.
 set( TCP_INCLUDE_DIRS
@@ -0,0 +1,128 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * @file tcp_capture_ring.h
+ * @brief Captures the first bytes of the frames that are received and sent in
+ *        a ring buffer, to be read as a pcapng file.
+ *        See tools/tcp_utilities/tcp_capture_ring.md
+ */
+
+#ifndef TCP_CAPTURE_RING_H
+
+    #define TCP_CAPTURE_RING_H
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+/* The conditions that can freeze the capture ring. */
+    typedef enum xTCP_CAPTURE_TRIGGER
+    {
+        eTCPCaptureTriggerNone = 0,   /* No trigger has fired. */
+        eTCPCaptureTriggerDrop,       /* A received packet was dropped, see iptraceRX_PACKET_DROPPED(). */
+        eTCPCaptureTriggerRetransmit, /* A TCP segment was sent again, see iptraceTCP_RETRANSMISSION(). */
+        eTCPCaptureTriggerUser        /* The application called vTCPCaptureRingTrigger(). */
+    } eTCPCaptureTrigger_t;
+
+/* The bit of a trigger in the mask of vTCPCaptureRingStart(). */
+    #define tcpcaptureTRIGGER( eTrigger )    ( 1UL << ( uint32_t ) ( eTrigger ) )
+
+    typedef enum xTCP_CAPTURE_STATE
+    {
+        eTCPCaptureStopped = 0, /* Not capturing, the ring keeps what it has. */
+        eTCPCaptureRunning,     /* Capturing, waiting for a trigger. */
+        eTCPCaptureTriggered,   /* A trigger fired, capturing the last frames. */
+        eTCPCaptureFrozen       /* The frames around the trigger are kept. */
+    } eTCPCaptureState_t;
+
+    typedef struct xTCP_CAPTURE_STATUS
+    {
+        eTCPCaptureState_t eState;     /**< The state of the ring. */
+        eTCPCaptureTrigger_t eTrigger; /**< The trigger that fired, if any. */
+        uint32_t ulFrames;             /**< The number of frames captured since vTCPCaptureRingStart(). */
+    } TCPCaptureStatus_t;
+
+    #if ( ipconfigUSE_TCP_CAPTURE_RING != 0 )
+
+/* Clear the ring and start capturing.  'ulTriggerMask' is a combination of
+ * tcpcaptureTRIGGER() bits, zero captures until vTCPCaptureRingStop().  The
+ * ring freezes 'ulFramesAfterTrigger' frames after a trigger fired. */
+        void vTCPCaptureRingStart( uint32_t ulTriggerMask,
+                                   uint32_t ulFramesAfterTrigger );
+
+/* Stop capturing, the ring keeps its frames. */
+        void vTCPCaptureRingStop( void );
+
+/* Fire a trigger.  It can be called from tasks and from interrupts. */
+        void vTCPCaptureRingTrigger( eTCPCaptureTrigger_t eTrigger );
+
+/* Store a frame, called by the trace macros here below. */
+        void vTCPCaptureRingFrame( const uint8_t * pucFrame,
+                                   size_t uxLength,
+                                   BaseType_t xIncoming );
+
+        void vTCPCaptureRingStatus( TCPCaptureStatus_t * pxStatus );
+
+/* The number of bytes that uxTCPCaptureRingRead() needs for a full ring. */
+        size_t uxTCPCaptureRingSize( void );
+
+/* Write the frames in the ring, the oldest first, as a pcapng file.  The
+ * capture goes on while reading, unless the ring is stopped or frozen.
+ * Returns the number of bytes written. */
+        size_t uxTCPCaptureRingRead( uint8_t * pucBuffer,
+                                     size_t uxBufferLength );
+
+        #ifndef iptraceNETWORK_INTERFACE_INPUT
+            #define iptraceNETWORK_INTERFACE_INPUT( uxDataLength, pucEthernetBuffer ) \
+    vTCPCaptureRingFrame( ( pucEthernetBuffer ), ( size_t ) ( uxDataLength ), pdTRUE )
+        #endif
+
+        #ifndef iptraceNETWORK_INTERFACE_OUTPUT
+            #define iptraceNETWORK_INTERFACE_OUTPUT( uxDataLength, pucEthernetBuffer ) \
+    vTCPCaptureRingFrame( ( pucEthernetBuffer ), ( size_t ) ( uxDataLength ), pdFALSE )
+        #endif
+
+        #ifndef iptraceRX_PACKET_DROPPED
+            #define iptraceRX_PACKET_DROPPED( pxInterface, eReason ) \
+    vTCPCaptureRingTrigger( eTCPCaptureTriggerDrop )
+        #endif
+
+        #ifndef iptraceTCP_RETRANSMISSION
+            #define iptraceTCP_RETRANSMISSION( usOurPortNumber, ulSequenceNumber ) \
+    vTCPCaptureRingTrigger( eTCPCaptureTriggerRetransmit )
+        #endif
+
+    #else /* if ( ipconfigUSE_TCP_CAPTURE_RING != 0 ) */
+
+/* The header file 'IPTraceMacroDefaults.h' will define the default empty macro's. */
+
+    #endif /* ipconfigUSE_TCP_CAPTURE_RING != 0 */
+
+    #ifdef __cplusplus
+}         /* extern "C" */
+    #endif
+
+#endif /* TCP_CAPTURE_RING_H */
@@ -0,0 +1,228 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * @file tcp_trace_ring.h
+ * @brief Records the hot-path trace macros of FreeRTOS+TCP as binary events
+ *        in a ring buffer per core.  See tools/tcp_utilities/tcp_trace_ring.md
+ */
+
+#ifndef TCP_TRACE_RING_H
+
+    #define TCP_TRACE_RING_H
+
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+
+/* The events, as stored in TCPTraceEvent_t::ucEvent.  The values are part of
+ * the file format: only add new ones at the end.  Applications may record
+ * their own events from tcptraceEVENT_USER onwards. */
+    typedef enum xTCP_TRACE_EVENT
+    {
+        tcptraceEVENT_NONE = 0,
+        tcptraceEVENT_INTERFACE_RECEIVE,         /* ulArg: - */
+        tcptraceEVENT_INTERFACE_INPUT,           /* ulArg: Ethernet buffer, usArg: length */
+        tcptraceEVENT_INTERFACE_OUTPUT,          /* ulArg: Ethernet buffer, usArg: length */
+        tcptraceEVENT_INTERFACE_TRANSMIT,        /* ulArg: - */
+        tcptraceEVENT_NETWORK_EVENT,             /* ulArg: eIPEvent_t */
+        tcptraceEVENT_BUFFER_OBTAINED,           /* ulArg: Ethernet buffer */
+        tcptraceEVENT_BUFFER_OBTAINED_FROM_ISR,  /* ulArg: Ethernet buffer */
+        tcptraceEVENT_BUFFER_RELEASED,           /* ulArg: Ethernet buffer */
+        tcptraceEVENT_BUFFER_FAILED,             /* ulArg: - */
+        tcptraceEVENT_BUFFER_FAILED_FROM_ISR,    /* ulArg: - */
+        tcptraceEVENT_SENDING_UDP_PACKET,        /* ulArg: IPv4 address */
+        tcptraceEVENT_STACK_TX_EVENT_LOST,       /* ulArg: - */
+        tcptraceEVENT_ETHERNET_RX_EVENT_LOST,    /* ulArg: - */
+        tcptraceEVENT_WAITING_FOR_TX_DMA,        /* ulArg: - */
+        tcptraceEVENT_NO_BUFFER_FOR_SENDTO,      /* ulArg: - */
+        tcptraceEVENT_CREATING_ARP_REQUEST,      /* ulArg: IPv4 address */
+        tcptraceEVENT_DROPPED_TO_GENERATE_ARP,   /* ulArg: IPv4 address */
+        tcptraceEVENT_ICMP_PACKET_RECEIVED,      /* ulArg: - */
+        tcptraceEVENT_SENDING_PING_REPLY,        /* ulArg: IPv4 address */
+        tcptraceEVENT_USER = 0x80
+    } TCPTraceEventType_t;
+
+/* One record, 16 bytes.  A record is valid when ulSequence equals its index
+ * in the ring plus one, counting from the start of the trace: that detects
+ * records that were overwritten or were being written while copied. */
+    typedef struct xTCP_TRACE_EVENT_RECORD
+    {
+        uint32_t ulSequence;  /**< The number of this record plus 1, 0 when unused. */
+        uint32_t ulTimestamp; /**< ipconfigTCP_TRACE_RING_TIMESTAMP() */
+        uint32_t ulArg;       /**< Depends on the event, see TCPTraceEventType_t. */
+        uint16_t usArg;       /**< Depends on the event, see TCPTraceEventType_t. */
+        uint8_t ucEvent;      /**< TCPTraceEventType_t */
+        uint8_t ucCore;       /**< The core that recorded the event. */
+    } TCPTraceEvent_t;
+
+    #define tcptraceMAGIC      0x52545246UL /* "FRTR" in little-endian memory. */
+    #define tcptraceVERSION    1U
+
+/* The header in front of the rings, so that a copy of xTCPTraceRing, made by
+ * the application or with a debugger, can be decoded without other
+ * information. */
+    typedef struct xTCP_TRACE_HEADER
+    {
+        uint32_t ulMagic;       /**< tcptraceMAGIC, also tells the byte order. */
+        uint16_t usVersion;     /**< tcptraceVERSION */
+        uint16_t usRecordSize;  /**< sizeof( TCPTraceEvent_t ) */
+        uint32_t ulEntries;     /**< The number of records in each ring. */
+        uint32_t ulCores;       /**< The number of rings. */
+        uint32_t ulTimestampHz; /**< ipconfigTCP_TRACE_RING_TIMESTAMP_HZ */
+        uint32_t ulReserved;
+    } TCPTraceHeader_t;
+
+    #if ( ipconfigUSE_TCP_TRACE_RING != 0 )
+
+        void vTCPTraceRingRecord( uint8_t ucEvent,
+                                  uint32_t ulArg,
+                                  uint16_t usArg );
+
+/* Copy the header and all rings into pucBuffer, which must have room for
+ * uxTCPTraceRingSize() bytes.  Recording goes on while copying: the decoder
+ * drops the records that were overwritten in the mean time. */
+        size_t uxTCPTraceRingSnapshot( uint8_t * pucBuffer,
+                                       size_t uxBufferLength );
+
+        size_t uxTCPTraceRingSize( void );
+
+/* Forget all records. */
+        void vTCPTraceRingClear( void );
+
+        #define tcptraceADDRESS( pvAddress )    ( ( uint32_t ) ( uintptr_t ) ( pvAddress ) )
+
+/* The buffer events record the address of the Ethernet buffer, so that the
+ * decoder can follow a packet from its allocation to its release. */
+        #define tcptraceBUFFER( pxBuffer ) \
+    ( ( ( pxBuffer ) != NULL ) ? tcptraceADDRESS( ( pxBuffer )->pucEthernetBuffer ) : 0U )
+
+        #ifndef iptraceNETWORK_INTERFACE_RECEIVE
+            #define iptraceNETWORK_INTERFACE_RECEIVE() \
+    vTCPTraceRingRecord( tcptraceEVENT_INTERFACE_RECEIVE, 0U, 0U )
+        #endif
+
+        #ifndef iptraceNETWORK_INTERFACE_INPUT
+            #define iptraceNETWORK_INTERFACE_INPUT( uxDataLength, pucEthernetBuffer ) \
+    vTCPTraceRingRecord( tcptraceEVENT_INTERFACE_INPUT, tcptraceADDRESS( pucEthernetBuffer ), ( uint16_t ) ( uxDataLength ) )
+        #endif
+
+        #ifndef iptraceNETWORK_INTERFACE_OUTPUT
+            #define iptraceNETWORK_INTERFACE_OUTPUT( uxDataLength, pucEthernetBuffer ) \
+    vTCPTraceRingRecord( tcptraceEVENT_INTERFACE_OUTPUT, tcptraceADDRESS( pucEthernetBuffer ), ( uint16_t ) ( uxDataLength ) )
+        #endif
+
+        #ifndef iptraceNETWORK_INTERFACE_TRANSMIT
+            #define iptraceNETWORK_INTERFACE_TRANSMIT() \
+    vTCPTraceRingRecord( tcptraceEVENT_INTERFACE_TRANSMIT, 0U, 0U )
+        #endif
+
+        #ifndef iptraceNETWORK_EVENT_RECEIVED
+            #define iptraceNETWORK_EVENT_RECEIVED( eEvent ) \
+    vTCPTraceRingRecord( tcptraceEVENT_NETWORK_EVENT, ( uint32_t ) ( eEvent ), 0U )
+        #endif
+
+        #ifndef iptraceNETWORK_BUFFER_OBTAINED
+            #define iptraceNETWORK_BUFFER_OBTAINED( pxBufferAddress ) \
+    vTCPTraceRingRecord( tcptraceEVENT_BUFFER_OBTAINED, tcptraceBUFFER( pxBufferAddress ), 0U )
+        #endif
+
+        #ifndef iptraceNETWORK_BUFFER_OBTAINED_FROM_ISR
+            #define iptraceNETWORK_BUFFER_OBTAINED_FROM_ISR( pxBufferAddress ) \
+    vTCPTraceRingRecord( tcptraceEVENT_BUFFER_OBTAINED_FROM_ISR, tcptraceBUFFER( pxBufferAddress ), 0U )
+        #endif
+
+        #ifndef iptraceNETWORK_BUFFER_RELEASED
+            #define iptraceNETWORK_BUFFER_RELEASED( pxBufferAddress ) \
+    vTCPTraceRingRecord( tcptraceEVENT_BUFFER_RELEASED, tcptraceBUFFER( pxBufferAddress ), 0U )
+        #endif
+
+        #ifndef iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER
+            #define iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER() \
+    vTCPTraceRingRecord( tcptraceEVENT_BUFFER_FAILED, 0U, 0U )
+        #endif
+
+        #ifndef iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER_FROM_ISR
+            #define iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER_FROM_ISR() \
+    vTCPTraceRingRecord( tcptraceEVENT_BUFFER_FAILED_FROM_ISR, 0U, 0U )
+        #endif
+
+        #ifndef iptraceSENDING_UDP_PACKET
+            #define iptraceSENDING_UDP_PACKET( ulIPAddress ) \
+    vTCPTraceRingRecord( tcptraceEVENT_SENDING_UDP_PACKET, ( uint32_t ) ( ulIPAddress ), 0U )
+        #endif
+
+/* Not all callers pass an expression as xEvent, it is not recorded. */
+        #ifndef iptraceSTACK_TX_EVENT_LOST
+            #define iptraceSTACK_TX_EVENT_LOST( xEvent ) \
+    vTCPTraceRingRecord( tcptraceEVENT_STACK_TX_EVENT_LOST, 0U, 0U )
+        #endif
+
+        #ifndef iptraceETHERNET_RX_EVENT_LOST
+            #define iptraceETHERNET_RX_EVENT_LOST() \
+    vTCPTraceRingRecord( tcptraceEVENT_ETHERNET_RX_EVENT_LOST, 0U, 0U )
+        #endif
+
+        #ifndef iptraceWAITING_FOR_TX_DMA_DESCRIPTOR
+            #define iptraceWAITING_FOR_TX_DMA_DESCRIPTOR() \
+    vTCPTraceRingRecord( tcptraceEVENT_WAITING_FOR_TX_DMA, 0U, 0U )
+        #endif
+
+        #ifndef iptraceNO_BUFFER_FOR_SENDTO
+            #define iptraceNO_BUFFER_FOR_SENDTO() \
+    vTCPTraceRingRecord( tcptraceEVENT_NO_BUFFER_FOR_SENDTO, 0U, 0U )
+        #endif
+
+        #ifndef iptraceCREATING_ARP_REQUEST
+            #define iptraceCREATING_ARP_REQUEST( ulIPAddress ) \
+    vTCPTraceRingRecord( tcptraceEVENT_CREATING_ARP_REQUEST, ( uint32_t ) ( ulIPAddress ), 0U )
+        #endif
+
+        #ifndef iptracePACKET_DROPPED_TO_GENERATE_ARP
+            #define iptracePACKET_DROPPED_TO_GENERATE_ARP( ulIPAddress ) \
+    vTCPTraceRingRecord( tcptraceEVENT_DROPPED_TO_GENERATE_ARP, ( uint32_t ) ( ulIPAddress ), 0U )
+        #endif
+
+        #ifndef iptraceICMP_PACKET_RECEIVED
+            #define iptraceICMP_PACKET_RECEIVED() \
+    vTCPTraceRingRecord( tcptraceEVENT_ICMP_PACKET_RECEIVED, 0U, 0U )
+        #endif
+
+        #ifndef iptraceSENDING_PING_REPLY
+            #define iptraceSENDING_PING_REPLY( ulIPAddress ) \
+    vTCPTraceRingRecord( tcptraceEVENT_SENDING_PING_REPLY, ( uint32_t ) ( ulIPAddress ), 0U )
+        #endif
+
+    #else /* if ( ipconfigUSE_TCP_TRACE_RING != 0 ) */
+
+/* The header file 'IPTraceMacroDefaults.h' will define the default empty macro's. */
+
+    #endif /* ipconfigUSE_TCP_TRACE_RING != 0 */
+
+    #ifdef __cplusplus
+}         /* extern "C" */
+    #endif
+
+#endif /* TCP_TRACE_RING_H */
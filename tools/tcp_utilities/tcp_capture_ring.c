@@ -0,0 +1,468 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * @file tcp_capture_ring.c
+ * @brief Captures the first bytes of the frames that are received and sent in
+ *        a ring buffer, to be read as a pcapng file.
+ *        See tools/tcp_utilities/tcp_capture_ring.md
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+
+#include "tcp_capture_ring.h"
+
+#if ( ipconfigUSE_TCP_CAPTURE_RING != 0 )
+
+    #define tcpcaptureENTRY_MASK            ( ( uint32_t ) ipconfigTCP_CAPTURE_RING_ENTRIES - 1U )
+
+/* The pcapng blocks and options that are written, see
+ * https://www.ietf.org/staging/draft-tuexen-opsawg-pcapng-02.html */
+    #define tcpcapturePCAPNG_SHB            0x0A0D0D0AUL /* Section Header Block */
+    #define tcpcapturePCAPNG_IDB            0x00000001UL /* Interface Description Block */
+    #define tcpcapturePCAPNG_EPB            0x00000006UL /* Enhanced Packet Block */
+    #define tcpcapturePCAPNG_BYTE_ORDER     0x1A2B3C4DUL /* Tells the reader the byte order. */
+    #define tcpcapturePCAPNG_ETHERNET       1UL          /* LINKTYPE_ETHERNET */
+    #define tcpcapturePCAPNG_OPT_END        0U           /* opt_endofopt */
+    #define tcpcapturePCAPNG_OPT_COMMENT    1U           /* opt_comment */
+    #define tcpcapturePCAPNG_OPT_FLAGS      2U           /* epb_flags */
+    #define tcpcapturePCAPNG_INBOUND        1UL          /* epb_flags: direction inbound */
+    #define tcpcapturePCAPNG_OUTBOUND       2UL          /* epb_flags: direction outbound */
+
+    #define tcpcaptureSHB_SIZE              28U
+    #define tcpcaptureIDB_SIZE              20U
+
+/* An EPB without data: 28 bytes of header, the option epb_flags, the end of
+ * the options and the trailing length. */
+    #define tcpcaptureEPB_SIZE              44U
+
+/* The room for the comment that marks the first frame after a trigger. */
+    #define tcpcaptureCOMMENT_SIZE          ( 4U + 48U )
+
+    #define tcpcapturePAD4( uxLength )      ( ( ( uxLength ) + 3U ) & ~( ( size_t ) 3U ) )
+
+/*-----------------------------------------------------------*/
+
+/* One captured frame, 16 bytes plus the snap length. */
+    typedef struct xTCP_CAPTURE_ENTRY
+    {
+        uint64_t ullTimeUs;  /**< ipconfigTCP_CAPTURE_RING_TIME_US() */
+        uint32_t ulSequence; /**< The number of this frame plus 1, 0 when unused. */
+        uint16_t usLength;   /**< The length of the frame, the first ipconfigTCP_CAPTURE_RING_SNAPLEN bytes are kept. */
+        uint8_t ucIncoming;  /**< Non-zero for a received frame. */
+        uint8_t ucTrigger;   /**< The trigger that fired just before this frame, or eTCPCaptureTriggerNone. */
+        uint8_t ucData[ ipconfigTCP_CAPTURE_RING_SNAPLEN ];
+    } TCPCaptureEntry_t;
+
+    typedef struct xTCP_CAPTURE_RING
+    {
+        uint32_t ulHead;                      /**< The number of frames captured since the start. */
+        uint32_t ulTriggerMask;               /**< The tcpcaptureTRIGGER() bits that freeze the ring. */
+        uint32_t ulFramesAfterTrigger;        /**< The number of frames still to capture before the ring freezes. */
+        eTCPCaptureState_t eState;            /**< The state of the ring. */
+        eTCPCaptureTrigger_t eTrigger;        /**< The trigger that fired. */
+        eTCPCaptureTrigger_t ePendingTrigger; /**< Marks the next frame. */
+        TCPCaptureEntry_t xEntries[ ipconfigTCP_CAPTURE_RING_ENTRIES ];
+    } TCPCaptureRing_t;
+
+/*-----------------------------------------------------------*/
+
+/* Global, so that a debugger can look at it. */
+    TCPCaptureRing_t xTCPCaptureRing;
+
+/* The comments that mark the first frame after a trigger. */
+    static const char * const pcTriggerNames[] =
+    {
+        "",
+        "capture triggered by a dropped packet",
+        "capture triggered by a TCP retransmission",
+        "capture triggered by the application"
+    };
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Clear the ring and start capturing.
+ *
+ * @param[in] ulTriggerMask The triggers that freeze the ring, a combination of
+ *                          tcpcaptureTRIGGER() bits, or zero to capture until
+ *                          vTCPCaptureRingStop() is called.
+ * @param[in] ulFramesAfterTrigger The number of frames to capture after a
+ *                                 trigger has fired.
+ */
+    void vTCPCaptureRingStart( uint32_t ulTriggerMask,
+                               uint32_t ulFramesAfterTrigger )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        vTCPCaptureRingStop();
+
+        /* Nothing is written to the ring while it is stopped. */
+        ( void ) memset( xTCPCaptureRing.xEntries, 0, sizeof( xTCPCaptureRing.xEntries ) );
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            xTCPCaptureRing.ulHead = 0U;
+            xTCPCaptureRing.ulTriggerMask = ulTriggerMask;
+            xTCPCaptureRing.ulFramesAfterTrigger = ulFramesAfterTrigger;
+            xTCPCaptureRing.eTrigger = eTCPCaptureTriggerNone;
+            xTCPCaptureRing.ePendingTrigger = eTCPCaptureTriggerNone;
+            xTCPCaptureRing.eState = eTCPCaptureRunning;
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Stop capturing.  The frames in the ring can still be read.
+ */
+    void vTCPCaptureRingStop( void )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( xTCPCaptureRing.eState != eTCPCaptureFrozen )
+            {
+                xTCPCaptureRing.eState = eTCPCaptureStopped;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fire a trigger.  When it is in the mask of vTCPCaptureRingStart(),
+ *        the ring freezes after the configured number of frames.
+ *
+ * @param[in] eTrigger The condition that occurred.
+ */
+    void vTCPCaptureRingTrigger( eTCPCaptureTrigger_t eTrigger )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( ( xTCPCaptureRing.eState == eTCPCaptureRunning ) &&
+                ( ( xTCPCaptureRing.ulTriggerMask & tcpcaptureTRIGGER( eTrigger ) ) != 0U ) )
+            {
+                xTCPCaptureRing.eTrigger = eTrigger;
+                xTCPCaptureRing.ePendingTrigger = eTrigger;
+                xTCPCaptureRing.eState = ( xTCPCaptureRing.ulFramesAfterTrigger != 0U ) ? eTCPCaptureTriggered : eTCPCaptureFrozen;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store the first bytes of a frame in the ring.  The oldest frame is
+ *        overwritten.
+ *
+ * @param[in] pucFrame The Ethernet frame.
+ * @param[in] uxLength The length of the frame.
+ * @param[in] xIncoming pdTRUE for a received frame, pdFALSE for a sent frame.
+ */
+    void vTCPCaptureRingFrame( const uint8_t * pucFrame,
+                               size_t uxLength,
+                               BaseType_t xIncoming )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        TCPCaptureEntry_t * pxEntry;
+        uint64_t ullTimeUs;
+        uint32_t ulIndex;
+        size_t uxCopyLength = uxLength;
+
+        /* A quick look without locking: most of the time the ring is either
+         * running or has been frozen long ago. */
+        if( ( xTCPCaptureRing.eState == eTCPCaptureRunning ) || ( xTCPCaptureRing.eState == eTCPCaptureTriggered ) )
+        {
+            if( uxCopyLength > ( size_t ) ipconfigTCP_CAPTURE_RING_SNAPLEN )
+            {
+                uxCopyLength = ( size_t ) ipconfigTCP_CAPTURE_RING_SNAPLEN;
+            }
+
+            ullTimeUs = ipconfigTCP_CAPTURE_RING_TIME_US();
+
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+            if( ( xTCPCaptureRing.eState == eTCPCaptureRunning ) || ( xTCPCaptureRing.eState == eTCPCaptureTriggered ) )
+            {
+                ulIndex = xTCPCaptureRing.ulHead;
+                xTCPCaptureRing.ulHead = ulIndex + 1U;
+                pxEntry = &( xTCPCaptureRing.xEntries[ ulIndex & tcpcaptureENTRY_MASK ] );
+
+                pxEntry->ullTimeUs = ullTimeUs;
+                pxEntry->usLength = ( uint16_t ) uxLength;
+                pxEntry->ucIncoming = ( xIncoming != pdFALSE ) ? 1U : 0U;
+                pxEntry->ucTrigger = ( uint8_t ) xTCPCaptureRing.ePendingTrigger;
+                ( void ) memcpy( pxEntry->ucData, pucFrame, uxCopyLength );
+                pxEntry->ulSequence = ulIndex + 1U;
+
+                xTCPCaptureRing.ePendingTrigger = eTCPCaptureTriggerNone;
+
+                if( xTCPCaptureRing.eState == eTCPCaptureTriggered )
+                {
+                    xTCPCaptureRing.ulFramesAfterTrigger--;
+
+                    if( xTCPCaptureRing.ulFramesAfterTrigger == 0U )
+                    {
+                        xTCPCaptureRing.eState = eTCPCaptureFrozen;
+                    }
+                }
+            }
+
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the state of the ring.
+ *
+ * @param[out] pxStatus Where the state will be written.
+ */
+    void vTCPCaptureRingStatus( TCPCaptureStatus_t * pxStatus )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            pxStatus->eState = xTCPCaptureRing.eState;
+            pxStatus->eTrigger = xTCPCaptureRing.eTrigger;
+            pxStatus->ulFrames = xTCPCaptureRing.ulHead;
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The number of bytes that uxTCPCaptureRingRead() needs for a full ring.
+ */
+    size_t uxTCPCaptureRingSize( void )
+    {
+        return ( size_t ) tcpcaptureSHB_SIZE + ( size_t ) tcpcaptureIDB_SIZE +
+               ( ( size_t ) ipconfigTCP_CAPTURE_RING_ENTRIES *
+                 ( ( size_t ) tcpcaptureEPB_SIZE + ( size_t ) ipconfigTCP_CAPTURE_RING_SNAPLEN + ( size_t ) tcpcaptureCOMMENT_SIZE ) );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write a 32-bit word in the byte order of the host.
+ */
+    static void prvPut32( uint8_t * pucBuffer,
+                          size_t uxOffset,
+                          uint32_t ulValue )
+    {
+        ( void ) memcpy( &( pucBuffer[ uxOffset ] ), &( ulValue ), sizeof( ulValue ) );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write a pcapng option header: a 16-bit code and a 16-bit length.
+ */
+    static void prvPutOption( uint8_t * pucBuffer,
+                              size_t uxOffset,
+                              uint16_t usCode,
+                              uint16_t usLength )
+    {
+        ( void ) memcpy( &( pucBuffer[ uxOffset ] ), &( usCode ), sizeof( usCode ) );
+        ( void ) memcpy( &( pucBuffer[ uxOffset + 2U ] ), &( usLength ), sizeof( usLength ) );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write the section header and the description of the interface.
+ *
+ * @param[in] pucBuffer Where to write the blocks, with room for both.
+ *
+ * @return The number of bytes written.
+ */
+    static size_t prvWriteHeader( uint8_t * pucBuffer )
+    {
+        /* Section Header Block, version 1.0, unknown section length. */
+        prvPut32( pucBuffer, 0U, tcpcapturePCAPNG_SHB );
+        prvPut32( pucBuffer, 4U, tcpcaptureSHB_SIZE );
+        prvPut32( pucBuffer, 8U, tcpcapturePCAPNG_BYTE_ORDER );
+        prvPutOption( pucBuffer, 12U, 1U, 0U );
+        prvPut32( pucBuffer, 16U, 0xFFFFFFFFUL );
+        prvPut32( pucBuffer, 20U, 0xFFFFFFFFUL );
+        prvPut32( pucBuffer, 24U, tcpcaptureSHB_SIZE );
+
+        /* Interface Description Block.  Without options, the time stamps
+         * have the default resolution of a microsecond. */
+        pucBuffer = &( pucBuffer[ tcpcaptureSHB_SIZE ] );
+        prvPut32( pucBuffer, 0U, tcpcapturePCAPNG_IDB );
+        prvPut32( pucBuffer, 4U, tcpcaptureIDB_SIZE );
+        prvPut32( pucBuffer, 8U, tcpcapturePCAPNG_ETHERNET );
+        prvPut32( pucBuffer, 12U, ( uint32_t ) ipconfigTCP_CAPTURE_RING_SNAPLEN );
+        prvPut32( pucBuffer, 16U, tcpcaptureIDB_SIZE );
+
+        return ( size_t ) tcpcaptureSHB_SIZE + ( size_t ) tcpcaptureIDB_SIZE;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write a frame as an Enhanced Packet Block.
+ *
+ * @param[in] pucBuffer Where to write the block.
+ * @param[in] uxBufferLength The room in pucBuffer.
+ * @param[in] pxEntry The frame.
+ *
+ * @return The number of bytes written, or 0 when the block does not fit.
+ */
+    static size_t prvWriteFrame( uint8_t * pucBuffer,
+                                 size_t uxBufferLength,
+                                 const TCPCaptureEntry_t * pxEntry )
+    {
+        size_t uxCaptured = pxEntry->usLength;
+        size_t uxPadded;
+        size_t uxComment = 0U;
+        size_t uxTotal;
+        size_t uxOffset;
+
+        if( uxCaptured > ( size_t ) ipconfigTCP_CAPTURE_RING_SNAPLEN )
+        {
+            uxCaptured = ( size_t ) ipconfigTCP_CAPTURE_RING_SNAPLEN;
+        }
+
+        uxPadded = tcpcapturePAD4( uxCaptured );
+
+        if( ( pxEntry->ucTrigger != ( uint8_t ) eTCPCaptureTriggerNone ) &&
+            ( pxEntry->ucTrigger < ( uint8_t ) ( sizeof( pcTriggerNames ) / sizeof( pcTriggerNames[ 0 ] ) ) ) )
+        {
+            uxComment = strlen( pcTriggerNames[ pxEntry->ucTrigger ] );
+        }
+
+        uxTotal = ( size_t ) tcpcaptureEPB_SIZE + uxPadded;
+
+        if( uxComment != 0U )
+        {
+            uxTotal += 4U + tcpcapturePAD4( uxComment );
+        }
+
+        if( uxTotal > uxBufferLength )
+        {
+            uxTotal = 0U;
+        }
+        else
+        {
+            ( void ) memset( pucBuffer, 0, uxTotal );
+
+            prvPut32( pucBuffer, 0U, tcpcapturePCAPNG_EPB );
+            prvPut32( pucBuffer, 4U, ( uint32_t ) uxTotal );
+            prvPut32( pucBuffer, 8U, 0U );
+            prvPut32( pucBuffer, 12U, ( uint32_t ) ( pxEntry->ullTimeUs >> 32 ) );
+            prvPut32( pucBuffer, 16U, ( uint32_t ) pxEntry->ullTimeUs );
+            prvPut32( pucBuffer, 20U, ( uint32_t ) uxCaptured );
+            prvPut32( pucBuffer, 24U, ( uint32_t ) pxEntry->usLength );
+            ( void ) memcpy( &( pucBuffer[ 28U ] ), pxEntry->ucData, uxCaptured );
+            uxOffset = 28U + uxPadded;
+
+            prvPutOption( pucBuffer, uxOffset, tcpcapturePCAPNG_OPT_FLAGS, 4U );
+            prvPut32( pucBuffer, uxOffset + 4U, ( pxEntry->ucIncoming != 0U ) ? tcpcapturePCAPNG_INBOUND : tcpcapturePCAPNG_OUTBOUND );
+            uxOffset += 8U;
+
+            if( uxComment != 0U )
+            {
+                prvPutOption( pucBuffer, uxOffset, tcpcapturePCAPNG_OPT_COMMENT, ( uint16_t ) uxComment );
+                ( void ) memcpy( &( pucBuffer[ uxOffset + 4U ] ), pcTriggerNames[ pxEntry->ucTrigger ], uxComment );
+                uxOffset += 4U + tcpcapturePAD4( uxComment );
+            }
+
+            prvPutOption( pucBuffer, uxOffset, tcpcapturePCAPNG_OPT_END, 0U );
+            prvPut32( pucBuffer, uxOffset + 4U, ( uint32_t ) uxTotal );
+        }
+
+        return uxTotal;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write the frames in the ring as a pcapng file, e.g. to store it or
+ *        to send it to a host.  Capturing goes on while the ring is read:
+ *        each frame is copied with the ring locked, frames that were
+ *        overwritten in the mean time are left out.
+ *
+ * @param[in] pucBuffer Where to write the file.
+ * @param[in] uxBufferLength The size of pucBuffer, see uxTCPCaptureRingSize().
+ *
+ * @return The number of bytes written, 0 when not even the headers fit.
+ */
+    size_t uxTCPCaptureRingRead( uint8_t * pucBuffer,
+                                 size_t uxBufferLength )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        const TCPCaptureEntry_t * pxEntry;
+        uint32_t ulIndex;
+        uint32_t ulHead;
+        size_t uxLength;
+        size_t uxWritten = 0U;
+
+        if( ( pucBuffer != NULL ) && ( uxBufferLength >= ( ( size_t ) tcpcaptureSHB_SIZE + ( size_t ) tcpcaptureIDB_SIZE ) ) )
+        {
+            uxWritten = prvWriteHeader( pucBuffer );
+
+            ulHead = xTCPCaptureRing.ulHead;
+            ulIndex = ( ulHead > ( uint32_t ) ipconfigTCP_CAPTURE_RING_ENTRIES ) ? ( ulHead - ( uint32_t ) ipconfigTCP_CAPTURE_RING_ENTRIES ) : 0U;
+
+            for( ; ulIndex != ulHead; ulIndex++ )
+            {
+                uxLength = 0U;
+                pxEntry = &( xTCPCaptureRing.xEntries[ ulIndex & tcpcaptureENTRY_MASK ] );
+
+                uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                {
+                    if( pxEntry->ulSequence == ( ulIndex + 1U ) )
+                    {
+                        uxLength = prvWriteFrame( &( pucBuffer[ uxWritten ] ), uxBufferLength - uxWritten, pxEntry );
+                    }
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+                if( ( uxLength == 0U ) && ( pxEntry->ulSequence == ( ulIndex + 1U ) ) )
+                {
+                    /* The buffer is full. */
+                    break;
+                }
+
+                uxWritten += uxLength;
+            }
+        }
+
+        return uxWritten;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_CAPTURE_RING != 0 */
@@ -0,0 +1,187 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * @file tcp_trace_ring.c
+ * @brief Records the hot-path trace macros of FreeRTOS+TCP as binary events
+ *        in a ring buffer per core.  See tools/tcp_utilities/tcp_trace_ring.md
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+
+#include "tcp_trace_ring.h"
+
+#if ( ipconfigUSE_TCP_TRACE_RING != 0 )
+
+    #if defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 )
+        #define tcptraceCORES            ( ( size_t ) configNUMBER_OF_CORES )
+        #define tcptraceCORE_ID()        ( ( size_t ) portGET_CORE_ID() )
+    #else
+        #define tcptraceCORES            ( ( size_t ) 1U )
+        #define tcptraceCORE_ID()        ( ( size_t ) 0U )
+    #endif
+
+    #define tcptraceENTRY_MASK           ( ( uint32_t ) ipconfigTCP_TRACE_RING_ENTRIES - 1U )
+
+/*-----------------------------------------------------------*/
+
+/* One ring.  Only the core that owns it writes to it. */
+    typedef struct xTCP_TRACE_CORE
+    {
+        uint32_t ulHead;     /**< The number of records written so far. */
+        uint32_t ulReserved; /**< Keeps the records 8-byte aligned. */
+        TCPTraceEvent_t xRecords[ ipconfigTCP_TRACE_RING_ENTRIES ];
+    } TCPTraceCore_t;
+
+/* The complete trace, as it is written to a file. */
+    typedef struct xTCP_TRACE_RING
+    {
+        TCPTraceHeader_t xHeader;
+        TCPTraceCore_t xCores[ tcptraceCORES ];
+    } TCPTraceRing_t;
+
+/*-----------------------------------------------------------*/
+
+/* Global, so that a debugger can save it, e.g. in GDB:
+ *     dump binary value trace.bin xTCPTraceRing */
+    TCPTraceRing_t xTCPTraceRing =
+    {
+        .xHeader =
+        {
+            .ulMagic       = tcptraceMAGIC,
+            .usVersion     = ( uint16_t ) tcptraceVERSION,
+            .usRecordSize  = ( uint16_t ) sizeof( TCPTraceEvent_t ),
+            .ulEntries     = ( uint32_t ) ipconfigTCP_TRACE_RING_ENTRIES,
+            .ulCores       = ( uint32_t ) tcptraceCORES,
+            .ulTimestampHz = ( uint32_t ) ipconfigTCP_TRACE_RING_TIMESTAMP_HZ,
+            .ulReserved    = 0U
+        }
+    };
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Record one event.  It can be called from tasks and from interrupts.
+ *        Only the interrupts of the own core are masked, and only while the
+ *        record is written: the cores never wait for each other.
+ *
+ * @param[in] ucEvent The event, see TCPTraceEventType_t.
+ * @param[in] ulArg The first argument of the event.
+ * @param[in] usArg The second argument of the event.
+ */
+    void vTCPTraceRingRecord( uint8_t ucEvent,
+                              uint32_t ulArg,
+                              uint16_t usArg )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        TCPTraceCore_t * pxCore;
+        TCPTraceEvent_t * pxRecord;
+        uint32_t ulIndex;
+        size_t uxCoreID;
+
+        /* With the interrupts masked, the task can not move to another core
+         * either. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            uxCoreID = tcptraceCORE_ID();
+            pxCore = &( xTCPTraceRing.xCores[ uxCoreID ] );
+            ulIndex = pxCore->ulHead;
+            pxCore->ulHead = ulIndex + 1U;
+            pxRecord = &( pxCore->xRecords[ ulIndex & tcptraceENTRY_MASK ] );
+
+            /* Invalidate the record while it is written, for the sake of a
+             * snapshot taken by another core. */
+            pxRecord->ulSequence = 0U;
+            pxRecord->ulTimestamp = ipconfigTCP_TRACE_RING_TIMESTAMP();
+            pxRecord->ulArg = ulArg;
+            pxRecord->usArg = usArg;
+            pxRecord->ucEvent = ucEvent;
+            pxRecord->ucCore = ( uint8_t ) uxCoreID;
+            pxRecord->ulSequence = ulIndex + 1U;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The number of bytes that uxTCPTraceRingSnapshot() needs.
+ */
+    size_t uxTCPTraceRingSize( void )
+    {
+        return sizeof( xTCPTraceRing );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Copy the trace into a buffer, e.g. to write it to a file or to send
+ *        it to a host.
+ *
+ * @param[in] pucBuffer Where to copy the trace to.
+ * @param[in] uxBufferLength The size of pucBuffer.
+ *
+ * @return The number of bytes copied, or 0 when pucBuffer is too small.
+ */
+    size_t uxTCPTraceRingSnapshot( uint8_t * pucBuffer,
+                                   size_t uxBufferLength )
+    {
+        size_t uxReturn = 0U;
+
+        if( ( pucBuffer != NULL ) && ( uxBufferLength >= sizeof( xTCPTraceRing ) ) )
+        {
+            /* No locking: the records that change while they are copied fail
+             * the sequence check of the decoder. */
+            ( void ) memcpy( pucBuffer, &( xTCPTraceRing ), sizeof( xTCPTraceRing ) );
+            uxReturn = sizeof( xTCPTraceRing );
+        }
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Forget all records.  Events recorded at the same time may be lost.
+ */
+    void vTCPTraceRingClear( void )
+    {
+        size_t uxCore;
+
+        for( uxCore = 0U; uxCore < tcptraceCORES; uxCore++ )
+        {
+            ( void ) memset( xTCPTraceRing.xCores[ uxCore ].xRecords, 0, sizeof( xTCPTraceRing.xCores[ uxCore ].xRecords ) );
+            xTCPTraceRing.xCores[ uxCore ].ulHead = 0U;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_TRACE_RING != 0 */
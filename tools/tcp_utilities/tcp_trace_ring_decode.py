@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+#
+# FreeRTOS+TCP <DEVELOPMENT BRANCH>
+# Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+#
+# SPDX-License-Identifier: MIT
+#
+# Decodes a trace written by tcp_trace_ring.c, see tcp_trace_ring.md.
+#
+#   tcp_trace_ring_decode.py trace.bin            # timeline
+#   tcp_trace_ring_decode.py --latency trace.bin  # packet latencies
+#   tcp_trace_ring_decode.py --csv trace.bin      # timeline as CSV
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x52545246
+VERSION = 1
+HEADER_FORMAT = "IHHIIII"
+RECORD_FORMAT = "IIIHBB"
+CORE_FORMAT = "II"
+
+EVENTS = [
+    "NONE",
+    "INTERFACE_RECEIVE",
+    "INTERFACE_INPUT",
+    "INTERFACE_OUTPUT",
+    "INTERFACE_TRANSMIT",
+    "NETWORK_EVENT",
+    "BUFFER_OBTAINED",
+    "BUFFER_OBTAINED_FROM_ISR",
+    "BUFFER_RELEASED",
+    "BUFFER_FAILED",
+    "BUFFER_FAILED_FROM_ISR",
+    "SENDING_UDP_PACKET",
+    "STACK_TX_EVENT_LOST",
+    "ETHERNET_RX_EVENT_LOST",
+    "WAITING_FOR_TX_DMA",
+    "NO_BUFFER_FOR_SENDTO",
+    "CREATING_ARP_REQUEST",
+    "DROPPED_TO_GENERATE_ARP",
+    "ICMP_PACKET_RECEIVED",
+    "SENDING_PING_REPLY",
+]
+USER_EVENT = 0x80
+
+OBTAINED = (6, 7)
+INPUT = 2
+OUTPUT = 3
+RELEASED = 8
+
+
+def event_name(event):
+    if event < len(EVENTS):
+        return EVENTS[event]
+    if event >= USER_EVENT:
+        return "USER_%d" % (event - USER_EVENT)
+    return "UNKNOWN_%d" % event
+
+
+def read_trace(data):
+    """Returns the header as a dict, and the valid records of all cores,
+    ordered by core and by sequence number."""
+    for order in ("<", ">"):
+        header = struct.unpack_from(order + HEADER_FORMAT, data, 0)
+        if header[0] == MAGIC:
+            break
+    else:
+        sys.exit("Not a FreeRTOS+TCP trace: bad magic number")
+
+    _, version, record_size, entries, cores, hz, _ = header
+    if version != VERSION or record_size != struct.calcsize(RECORD_FORMAT):
+        sys.exit("Unsupported trace version %d, record size %d" % (version, record_size))
+
+    offset = struct.calcsize(HEADER_FORMAT)
+    records = []
+    dropped = 0
+    for _ in range(cores):
+        (head, _) = struct.unpack_from(order + CORE_FORMAT, data, offset)
+        offset += struct.calcsize(CORE_FORMAT)
+        first = max(0, head - entries)
+        for index in range(first, head):
+            slot = offset + (index % entries) * record_size
+            seq, stamp, arg, arg16, event, core = struct.unpack_from(order + RECORD_FORMAT, data, slot)
+            # A record that does not carry its own number was overwritten
+            # or was being written when the trace was copied.
+            if seq != ((index + 1) & 0xFFFFFFFF):
+                dropped += 1
+                continue
+            records.append((seq, stamp, arg, arg16, event, core))
+        offset += entries * record_size
+
+    info = {"entries": entries, "cores": cores, "hz": hz, "dropped": dropped}
+    return info, records
+
+
+def to_usec(ticks, hz):
+    return ticks * 1000000.0 / hz
+
+
+def print_timeline(info, records, csv):
+    # Time stamps are 32 bits and may wrap: sort on the time relative to the
+    # first record of core 0, per core the records are already in order.
+    base = records[0][1] if records else 0
+    ordered = sorted(records, key=lambda r: ((r[1] - base) & 0xFFFFFFFF, r[5], r[0]))
+    if csv:
+        print("usec,core,event,arg,arg16")
+    for seq, stamp, arg, arg16, event, core in ordered:
+        usec = to_usec((stamp - base) & 0xFFFFFFFF, info["hz"])
+        if csv:
+            print("%.3f,%d,%s,0x%08x,%d" % (usec, core, event_name(event), arg, arg16))
+        else:
+            print("%12.3f  core %d  %-24s 0x%08x %5d" % (usec, core, event_name(event), arg, arg16))
+
+
+def print_latency(info, records):
+    """Follows each Ethernet buffer from BUFFER_OBTAINED to BUFFER_RELEASED.
+    A buffer that passes INTERFACE_INPUT is a received packet, one that passes
+    INTERFACE_OUTPUT is a sent packet."""
+    ordered = sorted(records, key=lambda r: (r[5], r[0]))
+    pending = {}
+    spans = {}
+
+    def add(name, ticks):
+        spans.setdefault(name, []).append(to_usec(ticks & 0xFFFFFFFF, info["hz"]))
+
+    for seq, stamp, arg, arg16, event, core in ordered:
+        if event in OBTAINED:
+            pending[arg] = {"obtained": stamp}
+        elif arg in pending and event in (INPUT, OUTPUT):
+            pending[arg]["input" if event == INPUT else "output"] = stamp
+        elif arg in pending and event == RELEASED:
+            packet = pending.pop(arg)
+            if "input" in packet:
+                add("rx: obtained -> input", packet["input"] - packet["obtained"])
+                add("rx: input -> released", stamp - packet["input"])
+            if "output" in packet:
+                add("tx: obtained -> output", packet["output"] - packet["obtained"])
+                add("tx: output -> released", stamp - packet["output"])
+            add("buffer lifetime", stamp - packet["obtained"])
+
+    print("%-26s %8s %10s %10s %10s %10s" % ("span (usec)", "count", "min", "avg", "p99", "max"))
+    for name in sorted(spans):
+        values = sorted(spans[name])
+        p99 = values[min(len(values) - 1, (len(values) * 99) // 100)]
+        print("%-26s %8d %10.3f %10.3f %10.3f %10.3f" %
+              (name, len(values), values[0], sum(values) / len(values), p99, values[-1]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a FreeRTOS+TCP trace ring")
+    parser.add_argument("trace", help="binary trace, a copy of xTCPTraceRing")
+    parser.add_argument("--latency", action="store_true", help="print packet latencies")
+    parser.add_argument("--csv", action="store_true", help="print the timeline as CSV")
+    args = parser.parse_args()
+
+    with open(args.trace, "rb") as f:
+        data = f.read()
+
+    info, records = read_trace(data)
+    sys.stderr.write("%d records, %d core(s), %d Hz, %d dropped\n" %
+                     (len(records), info["cores"], info["hz"], info["dropped"]))
+
+    if args.latency:
+        print_latency(info, records)
+    else:
+        print_timeline(info, records, args.csv)
+
+
+if __name__ == "__main__":
+    main()
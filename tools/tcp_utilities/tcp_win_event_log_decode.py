@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# FreeRTOS+TCP <DEVELOPMENT BRANCH>
+# Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+#
+# SPDX-License-Identifier: MIT
+#
+# Decodes the TCP window events of ipconfigUSE_TCP_WIN_EVENT_LOG, as copied
+# with the socket option FREERTOS_SO_TCP_WIN_EVENT_LOG, see
+# tcp_win_event_log.md.
+#
+#   tcp_win_event_log_decode.py events.bin                   # timeline
+#   tcp_win_event_log_decode.py --csv events.bin             # timeline as CSV
+#   tcp_win_event_log_decode.py --xplot out.xpl events.bin   # time-sequence graph
+
+import argparse
+import struct
+import sys
+
+RECORD_FORMAT = "IIIBBH"
+
+EVENTS = [
+    "NONE",
+    "SEND",
+    "RETRANSMIT",
+    "ACK",
+    "SACK",
+    "TIMEOUT",
+    "PROBE",
+    "RTT",
+    "WINDOW",
+]
+
+SEND = 1
+RETRANSMIT = 2
+ACK = 3
+SACK = 4
+TIMEOUT = 5
+PROBE = 6
+WINDOW = 8
+
+
+def event_name(event):
+    if event < len(EVENTS):
+        return EVENTS[event]
+    return "UNKNOWN_%d" % event
+
+
+def read_events(data, order):
+    """Returns the events as (usec, event, sequence, value, count, port).
+    The time stamps are 32 bits: they are unwrapped, and made relative to the
+    first event."""
+    size = struct.calcsize(RECORD_FORMAT)
+    events = []
+    base = None
+    last = 0
+    wraps = 0
+    for offset in range(0, len(data) - size + 1, size):
+        stamp, seq, value, event, count, port = struct.unpack_from(order + RECORD_FORMAT, data, offset)
+        if event == 0:
+            continue
+        if base is None:
+            base = stamp
+            last = stamp
+        if stamp < last:
+            wraps += 1
+        last = stamp
+        usec = stamp + (wraps << 32) - base
+        events.append((usec, event, seq, value, count, port))
+    return events
+
+
+def print_timeline(events, csv):
+    if csv:
+        print("usec,port,event,sequence,value,count")
+    for usec, event, seq, value, count, port in events:
+        if csv:
+            print("%d,%d,%s,%d,%d,%d" % (usec, port, event_name(event), seq, value, count))
+        else:
+            print("%12d  %5d  %-10s seq %10d  value %10d  count %3d" %
+                  (usec, port, event_name(event), seq, value, count))
+
+
+def write_xplot(events, path):
+    """Writes a time-sequence graph in the format of xplot, as tcptrace
+    produces it: segments as vertical lines, retransmissions in red, the
+    ACK line in green, the advertised window in yellow and SACK blocks in
+    purple."""
+    ack = None
+    window = None
+    last_usec = 0
+
+    def t(usec):
+        return usec / 1000000.0
+
+    with open(path, "w") as f:
+        f.write("double double\ntitle\nFreeRTOS+TCP window events\n")
+        f.write("xlabel\ntime (s)\nylabel\nsequence number\n")
+        for usec, event, seq, value, count, port in events:
+            x = t(usec)
+            if event in (SEND, RETRANSMIT):
+                f.write("%s\n" % ("white" if event == SEND else "red"))
+                f.write("line %.6f %d %.6f %d\n" % (x, seq, x, seq + value))
+                f.write("darrow %.6f %d\nuarrow %.6f %d\n" % (x, seq, x, seq + value))
+                if event == RETRANSMIT:
+                    f.write("atext %.6f %d\nR\n" % (x, seq + value))
+            elif event == ACK:
+                f.write("green\n")
+                if ack is not None:
+                    f.write("line %.6f %d %.6f %d\n" % (t(last_usec), ack, x, ack))
+                    f.write("line %.6f %d %.6f %d\n" % (x, ack, x, seq))
+                    if window is not None:
+                        f.write("yellow\n")
+                        f.write("line %.6f %d %.6f %d\n" % (t(last_usec), ack + window, x, ack + window))
+                        f.write("line %.6f %d %.6f %d\n" % (x, ack + window, x, seq + window))
+                if value == 0:
+                    f.write("green\ndtick %.6f %d\n" % (x, seq))
+                ack = seq
+                last_usec = usec
+            elif event == WINDOW:
+                window = value
+            elif event == SACK:
+                f.write("purple\nline %.6f %d %.6f %d\n" % (x, seq, x, value))
+            elif event in (TIMEOUT, PROBE):
+                f.write("orange\natext %.6f %d\n%s\n" % (x, seq, "T" if event == TIMEOUT else "P"))
+        f.write("go\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the window events of a FreeRTOS+TCP socket")
+    parser.add_argument("events", help="binary events, as copied with FREERTOS_SO_TCP_WIN_EVENT_LOG")
+    parser.add_argument("--big-endian", action="store_true", help="the events come from a big-endian target")
+    parser.add_argument("--csv", action="store_true", help="print the timeline as CSV")
+    parser.add_argument("--xplot", metavar="FILE", help="write a time-sequence graph for xplot")
+    args = parser.parse_args()
+
+    with open(args.events, "rb") as f:
+        data = f.read()
+
+    events = read_events(data, ">" if args.big_endian else "<")
+    sys.stderr.write("%d events\n" % len(events))
+
+    if args.xplot:
+        write_xplot(events, args.xplot)
+    else:
+        print_timeline(events, args.csv)
+
+
+if __name__ == "__main__":
+    main()